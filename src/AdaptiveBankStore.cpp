@@ -0,0 +1,146 @@
+#include "AdaptiveBankStore.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace convo {
+
+namespace {
+
+constexpr std::uint32_t kFileMagic = 0x42415043u;  // "CPAB"
+constexpr std::uint32_t kFormatVersion = 1;
+
+// レイアウトを変えたら kFormatVersion を上げる (古いファイルは捨てて XML から取り込み直す)
+struct DiskHeader
+{
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t bankCount = 0;
+    std::uint32_t recordBytes = 0;
+    std::uint64_t payloadChecksum = 0;
+};
+static_assert(std::is_trivially_copyable_v<DiskHeader>);
+
+// ゼロ埋めしてから詰める (パディングもチェックサムに含まれるため)
+struct DiskBank
+{
+    double coefficients[AdaptiveBankStore::kCoeffCount] = {};
+    NoiseShaperLearnerState state {};
+};
+static_assert(std::is_trivially_copyable_v<DiskBank>);
+
+// FNV-1a
+std::uint64_t checksumOf(const void* data, size_t bytes) noexcept
+{
+    const auto* p = static_cast<const unsigned char*>(data);
+    std::uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace
+
+juce::File AdaptiveBankStore::getStoreFile()
+{
+    auto appDataDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                          .getChildFile("ConvoPeq");
+
+    if (!appDataDir.exists())
+    {
+        auto result = appDataDir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create settings directory");
+    }
+
+    return appDataDir.getChildFile("adaptive_banks.bin");
+}
+
+//==============================================================================
+// 保存
+//==============================================================================
+bool AdaptiveBankStore::save(const juce::File& file, const std::vector<Bank>& banks)
+{
+    // ペイロードを 1 ブロックに組んでからチェックサムを取り、ヘッダ + ペイロードを 2 回の write で書く
+    std::vector<DiskBank> payload(banks.size());
+    std::memset(payload.data(), 0, payload.size() * sizeof(DiskBank));
+    for (size_t i = 0; i < banks.size(); ++i)
+    {
+        std::memcpy(payload[i].coefficients, banks[i].coefficients.data(), sizeof(payload[i].coefficients));
+        payload[i].state = banks[i].state;
+    }
+
+    DiskHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = kFileMagic;
+    header.version = kFormatVersion;
+    header.bankCount = static_cast<std::uint32_t>(banks.size());
+    header.recordBytes = static_cast<std::uint32_t>(sizeof(DiskBank));
+    header.payloadChecksum = checksumOf(payload.data(), payload.size() * sizeof(DiskBank));
+
+    juce::TemporaryFile temp(file);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (out.failedToOpen())
+            return false;
+        if (!out.write(&header, sizeof(header))
+            || !out.write(payload.data(), payload.size() * sizeof(DiskBank)))
+            return false;
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    if (!temp.overwriteTargetFileWithTemporary())
+    {
+        juce::Logger::writeToLog("Warning: Could not write adaptive bank store");
+        return false;
+    }
+    return true;
+}
+
+//==============================================================================
+// 読み込み
+//==============================================================================
+bool AdaptiveBankStore::load(const juce::File& file, int expectedBankCount, std::vector<Bank>& outBanks)
+{
+    if (expectedBankCount <= 0 || !file.existsAsFile())
+        return false;
+
+    juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+    if (mapped.getData() == nullptr || mapped.getSize() < sizeof(DiskHeader))
+        return false;
+
+    const auto* bytes = static_cast<const unsigned char*>(mapped.getData());
+    DiskHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+
+    const size_t payloadBytes = static_cast<size_t>(expectedBankCount) * sizeof(DiskBank);
+    if (header.magic != kFileMagic
+        || header.version != kFormatVersion
+        || header.bankCount != static_cast<std::uint32_t>(expectedBankCount)
+        || header.recordBytes != static_cast<std::uint32_t>(sizeof(DiskBank))
+        || mapped.getSize() != sizeof(DiskHeader) + payloadBytes)
+        return false;
+
+    const unsigned char* payload = bytes + sizeof(DiskHeader);
+    if (checksumOf(payload, payloadBytes) != header.payloadChecksum)
+        return false;
+
+    outBanks.assign(static_cast<size_t>(expectedBankCount), Bank {});
+    for (size_t i = 0; i < outBanks.size(); ++i)
+    {
+        DiskBank d;
+        std::memcpy(&d, payload + i * sizeof(DiskBank), sizeof(d));
+        std::memcpy(outBanks[i].coefficients.data(), d.coefficients, sizeof(d.coefficients));
+        outBanks[i].state = d.state;
+    }
+    return true;
+}
+
+} // namespace convo
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+#include "NoiseShaperLearnerTypes.h"
+
+namespace convo {
+
+/**
+    AdaptiveBankStore: 適応ノイズシェーパー全バンク (係数 + NoiseShaperLearnerState) のバイナリ保存形式。
+
+    %APPDATA%/ConvoPeq/adaptive_banks.bin に「固定長ヘッダ + バンク数 × 固定長レコード」を書く。
+    ヘッダはバージョン・バンク数・レコード長・ペイロード全体のチェックサムを持ち、
+    どれかが合わなければファイル全体を捨てる (呼び出し側は XML から取り込み直す)。
+    読み込みは MemoryMappedFile で写像してレコードをそのままコピーするだけで、文字列の解析はしない。
+    書き込みは一時ファイルへ書いてから置き換えるので、途中で落ちても前回のファイルが残る。
+
+    人が読む / 編集する用途は従来の noise_shaper_learn.xml (DeviceSettings のエクスポート) が担う。
+
+    スレッド: Message Thread (起動時の読み込み・自動保存・終了時の保存)
+*/
+class AdaptiveBankStore
+{
+public:
+    static constexpr int kCoeffCount = 9;
+
+    struct Bank
+    {
+        std::array<double, kCoeffCount> coefficients {};
+        NoiseShaperLearnerState state {};
+    };
+
+    static juce::File getStoreFile();
+
+    /** banks を bankIndex 順に書く。 */
+    static bool save(const juce::File& file, const std::vector<Bank>& banks);
+
+    /** ファイルが有効で、バンク数が expectedBankCount と一致するときだけ outBanks を埋めて true を返す。 */
+    static bool load(const juce::File& file, int expectedBankCount, std::vector<Bank>& outBanks);
+
+private:
+    AdaptiveBankStore() = delete;
+};
+
+} // namespace convo
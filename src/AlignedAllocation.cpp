@@ -0,0 +1,222 @@
+//============================================================================
+// AlignedAllocation.cpp ── RT 常駐メモリ (ラージページ / ロック + 事前フォルト)
+//============================================================================
+#include "AlignedAllocation.h"
+
+#include <atomic>
+#include <mutex>
+
+#include "audioengine/AtomicAccess.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace convo {
+
+namespace {
+
+constexpr size_t kPageBytes = 4096;
+
+std::atomic<uint64_t> g_largePageBytes { 0 };
+std::atomic<uint64_t> g_lockedBytes { 0 };
+std::atomic<uint64_t> g_pageableBytes { 0 };
+std::atomic<uint32_t> g_lockFailures { 0 };
+
+// ワーキングセット最小値の増減は読み取り→書き込みなので、ロック/解除の呼び出し同士を直列化する
+std::mutex g_workingSetMutex;
+
+size_t alignUp(size_t bytes, size_t unit) noexcept
+{
+    return (bytes + unit - 1) / unit * unit;
+}
+
+bool lockPages(void* begin, size_t bytes) noexcept
+{
+#ifdef _WIN32
+    // VirtualLock はワーキングセット最小値の範囲でしか成功しないため、ロックする分だけ先に広げる
+    const std::lock_guard<std::mutex> lock(g_workingSetMutex);
+    HANDLE process = GetCurrentProcess();
+    SIZE_T minimum = 0, maximum = 0;
+    if (!GetProcessWorkingSetSize(process, &minimum, &maximum)
+        || !SetProcessWorkingSetSize(process, minimum + bytes, maximum + bytes))
+        return false;
+    if (VirtualLock(begin, static_cast<SIZE_T>(bytes)))
+        return true;
+    SetProcessWorkingSetSize(process, minimum, maximum);
+    return false;
+#else
+    return mlock(begin, bytes) == 0;
+#endif
+}
+
+void unlockPages(void* begin, size_t bytes) noexcept
+{
+#ifdef _WIN32
+    const std::lock_guard<std::mutex> lock(g_workingSetMutex);
+    VirtualUnlock(begin, static_cast<SIZE_T>(bytes));
+    HANDLE process = GetCurrentProcess();
+    SIZE_T minimum = 0, maximum = 0;
+    if (GetProcessWorkingSetSize(process, &minimum, &maximum) && minimum > bytes && maximum > bytes)
+        SetProcessWorkingSetSize(process, minimum - bytes, maximum - bytes);
+#else
+    munlock(begin, bytes);
+#endif
+}
+
+// 範囲に完全に含まれるページ (隣の確保と共有しうる端のページを除く)
+void innerPages(const void* ptr, size_t bytes, void*& begin, size_t& length) noexcept
+{
+    const uintptr_t first = (reinterpret_cast<uintptr_t>(ptr) + kPageBytes - 1) & ~static_cast<uintptr_t>(kPageBytes - 1);
+    const uintptr_t last = (reinterpret_cast<uintptr_t>(ptr) + bytes) & ~static_cast<uintptr_t>(kPageBytes - 1);
+    begin = reinterpret_cast<void*>(first);
+    length = (last > first) ? static_cast<size_t>(last - first) : 0;
+}
+
+} // namespace
+
+//============================================================================
+// largePageSize  ─ SeLockMemoryPrivilege の有効化は初回に 1 回だけ試す
+//============================================================================
+size_t largePageSize() noexcept
+{
+    static const size_t unit = []() noexcept -> size_t
+    {
+#ifdef _WIN32
+        const SIZE_T minimum = GetLargePageMinimum();
+        if (minimum == 0)
+            return 0;
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+            return 0;
+        TOKEN_PRIVILEGES privileges {};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        // ユーザー権利が割り当てられていなければ AdjustTokenPrivileges 自体は成功し ERROR_NOT_ALL_ASSIGNED を残す
+        const bool enabled = LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid)
+                          && AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr)
+                          && GetLastError() == ERROR_SUCCESS;
+        CloseHandle(token);
+        return enabled ? static_cast<size_t>(minimum) : 0;
+#else
+        // hugetlbfs の事前予約は前提にしない (Linux は mlock のみ)
+        return 0;
+#endif
+    }();
+    return unit;
+}
+
+//============================================================================
+// allocateResident / freeResident  ─ Message Thread / prepare / 退役側
+//============================================================================
+RtResidentBlock allocateResident(size_t bytes) noexcept
+{
+    RtSafetyGuard::noteViolation(RtViolationKind::AlignedMalloc, bytes);
+    if (bytes == 0)
+        return {};
+
+#ifdef _WIN32
+    if (const size_t unit = largePageSize(); unit != 0 && bytes >= unit)
+    {
+        const size_t rounded = alignUp(bytes, unit);
+        // ラージページは確保時点で物理ページが割り当て済み (ゼロ埋め・非ページング)
+        if (void* p = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+        {
+            fetchAddAtomic(g_largePageBytes, static_cast<uint64_t>(rounded), std::memory_order_relaxed); // relaxed: 統計カウンタ
+            return { p, rounded, RtResidency::LargePage };
+        }
+        // 物理メモリの断片化で連続ページが取れなければ通常ページへ落とす
+    }
+#endif
+
+    // ページ境界に揃えてページ単位で確保し、ロック範囲が他の確保と重ならないようにする
+    const size_t rounded = alignUp(bytes, kPageBytes);
+    void* p = nullptr;
+    {
+        const RtSafetyGuard::UncheckedScope unchecked;
+        p = DIAG_MKL_MALLOC(rounded, static_cast<int>(kPageBytes));
+    }
+    if (p == nullptr)
+        return {};
+
+    // 全ページを書いてフォルトさせる (読むだけだと共有ゼロページで済まされ、初回書き込みで再びフォルトする)
+    std::memset(p, 0, rounded);
+    if (lockPages(p, rounded))
+    {
+        fetchAddAtomic(g_lockedBytes, static_cast<uint64_t>(rounded), std::memory_order_relaxed); // relaxed: 統計カウンタ
+        return { p, rounded, RtResidency::Locked };
+    }
+    fetchAddAtomic(g_lockFailures, 1u, std::memory_order_relaxed);                                  // relaxed: 同上
+    fetchAddAtomic(g_pageableBytes, static_cast<uint64_t>(rounded), std::memory_order_relaxed);     // relaxed: 同上
+    return { p, rounded, RtResidency::Pageable };
+}
+
+void freeResident(const RtResidentBlock& block) noexcept
+{
+    if (block.ptr == nullptr)
+        return;
+
+    switch (block.residency)
+    {
+        case RtResidency::LargePage:
+#ifdef _WIN32
+            VirtualFree(block.ptr, 0, MEM_RELEASE);
+#endif
+            fetchSubAtomic(g_largePageBytes, static_cast<uint64_t>(block.bytes), std::memory_order_relaxed); // relaxed: 統計カウンタ
+            return;
+        case RtResidency::Locked:
+            unlockPages(block.ptr, block.bytes);
+            fetchSubAtomic(g_lockedBytes, static_cast<uint64_t>(block.bytes), std::memory_order_relaxed);    // relaxed: 同上
+            break;
+        case RtResidency::Pageable:
+            fetchSubAtomic(g_pageableBytes, static_cast<uint64_t>(block.bytes), std::memory_order_relaxed);  // relaxed: 同上
+            break;
+    }
+    mkl_free(block.ptr);
+}
+
+//============================================================================
+// lockInPlace / unlockInPlace  ─ 既存確保の後付けロック (Message Thread)
+//   呼び出し側が書き終えた直後の領域を想定するため、事前フォルトはしない。
+//============================================================================
+size_t lockInPlace(const void* ptr, size_t bytes) noexcept
+{
+    void* begin = nullptr;
+    size_t length = 0;
+    innerPages(ptr, bytes, begin, length);
+    if (length == 0)
+        return 0;
+    if (!lockPages(begin, length))
+    {
+        fetchAddAtomic(g_lockFailures, 1u, std::memory_order_relaxed); // relaxed: 統計カウンタ
+        return 0;
+    }
+    fetchAddAtomic(g_lockedBytes, static_cast<uint64_t>(length), std::memory_order_relaxed); // relaxed: 同上
+    return length;
+}
+
+void unlockInPlace(const void* ptr, size_t bytes) noexcept
+{
+    void* begin = nullptr;
+    size_t length = 0;
+    innerPages(ptr, bytes, begin, length);
+    if (length == 0)
+        return;
+    unlockPages(begin, length);
+    fetchSubAtomic(g_lockedBytes, static_cast<uint64_t>(length), std::memory_order_relaxed); // relaxed: 統計カウンタ
+}
+
+RtResidencyStats getRtResidencyStats() noexcept
+{
+    RtResidencyStats stats;
+    stats.largePageBytes = consumeAtomic(g_largePageBytes, std::memory_order_relaxed); // relaxed: 表示用のスナップショット
+    stats.lockedBytes    = consumeAtomic(g_lockedBytes, std::memory_order_relaxed);    // relaxed: 同上
+    stats.pageableBytes  = consumeAtomic(g_pageableBytes, std::memory_order_relaxed);  // relaxed: 同上
+    stats.lockFailures   = consumeAtomic(g_lockFailures, std::memory_order_relaxed);   // relaxed: 同上
+    stats.largePagesAvailable = largePageSize() != 0;
+    return stats;
+}
+
+} // namespace convo
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 #include <limits>
 #include <new>
@@ -9,6 +12,7 @@
 
 #include <mkl.h>
 #include "DiagnosticsConfig.h"
+#include "audioengine/RtSafetyGuard.h"
 
 namespace convo {
 
@@ -16,6 +20,9 @@ namespace convo {
 //   CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS=1 時に convo::diag::diagMklMalloc が使用される。
 //   =0 時は従来通り生の mkl_malloc が呼ばれる（オーバーヘッドゼロ）。
 inline void* aligned_malloc(size_t size, size_t alignment) {
+    // ★ --rt-guard: Audio Thread からの確保を記録 (中の mkl_malloc は MKL 側のフックで重ねて数えない)
+    RtSafetyGuard::noteViolation(RtViolationKind::AlignedMalloc, size);
+    const RtSafetyGuard::UncheckedScope unchecked;
     void* ptr = DIAG_MKL_MALLOC(size, (int)alignment);
     if (ptr == nullptr) {
         throw std::bad_alloc();
@@ -27,6 +34,8 @@ inline void* aligned_malloc(size_t size, size_t alignment) {
 //   命名: _nothrow (例外を投げない契約)
 inline void* aligned_malloc_nothrow(size_t size, size_t alignment) noexcept
 {
+    RtSafetyGuard::noteViolation(RtViolationKind::AlignedMalloc, size);
+    const RtSafetyGuard::UncheckedScope unchecked;
     return DIAG_MKL_MALLOC(size, (int)alignment);
 }
 
@@ -206,4 +215,72 @@ inline ScopedAlignedPtr<double> makeAlignedCopy(const double* src, int numSample
     return dst;
 }
 
+//=============================================================================
+// RT 常駐メモリ (定義は AlignedAllocation.cpp)
+//
+//   Audio Thread が毎ブロック触る長寿命バッファ (NUC の IR スペクトル、オーバーサンプラー履歴、
+//   DSPCore の作業領域) を、初回アクセスのページフォルトとページアウトから守るための確保方針。
+//     LargePage : ラージページ (SeLockMemoryPrivilege を有効化できた場合のみ)。非ページングで TLB も節約する。
+//                 ページ 1 枚 (通常 2MB) に満たない確保には使わない。
+//     Locked    : ページ境界に揃えて確保し、全ページを書いてフォルトさせたうえで VirtualLock / mlock。
+//     Pageable  : ロックに失敗した (ワーキングセット / RLIMIT_MEMLOCK の上限)。フォルト済みのまま続行する。
+//   いずれもゼロ初期化済みで返す。確保・解放は Message Thread / prepare / 退役側でのみ行う。
+//=============================================================================
+enum class RtResidency : uint8_t { Pageable, Locked, LargePage };
+
+struct RtResidentBlock
+{
+    void*       ptr       = nullptr;   // 確保失敗時は nullptr
+    size_t      bytes     = 0;         // 解放に必要な実サイズ (ページ単位に切り上げ済み)
+    RtResidency residency = RtResidency::Pageable;
+};
+
+struct RtResidencyStats
+{
+    uint64_t largePageBytes  = 0;
+    uint64_t lockedBytes     = 0;
+    uint64_t pageableBytes   = 0;      // フォルト済みだがロックできなかった分
+    uint32_t lockFailures    = 0;      // 累計
+    bool     largePagesAvailable = false;
+};
+
+// ラージページ 1 枚のバイト数。特権が無い・非対応なら 0
+[[nodiscard]] size_t largePageSize() noexcept;
+
+[[nodiscard]] RtResidentBlock allocateResident(size_t bytes) noexcept;
+void freeResident(const RtResidentBlock& block) noexcept;
+
+// 既存の確保 (mkl_malloc 等) を後からロックする。隣の確保と共有しうる端のページは対象外で、
+// 戻り値はロックできたバイト数 (解放前に同じ範囲で unlockInPlace を呼ぶ)。
+size_t lockInPlace(const void* ptr, size_t bytes) noexcept;
+void unlockInPlace(const void* ptr, size_t bytes) noexcept;
+
+[[nodiscard]] RtResidencyStats getRtResidencyStats() noexcept;
+
+template <typename T>
+struct ResidentArrayDeleter
+{
+    size_t      bytes     = 0;
+    RtResidency residency = RtResidency::Pageable;
+
+    void operator()(T* ptr) const noexcept
+    {
+        if (ptr != nullptr)
+            freeResident({ ptr, bytes, residency });
+    }
+};
+
+template <typename T>
+using ResidentArray = std::unique_ptr<T[], ResidentArrayDeleter<T>>;
+
+// 失敗時は nullptr を内包して返す (makeAlignedArray_nothrow と同じ契約)
+template <typename T>
+inline ResidentArray<T> makeResidentArray_nothrow(size_t count) noexcept
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Resident array only supports trivially copyable types");
+    const RtResidentBlock block = allocateResident(count * sizeof(T));
+    return ResidentArray<T>(static_cast<T*>(block.ptr), ResidentArrayDeleter<T> { block.bytes, block.residency });
+}
+
 } // namespace convo
@@ -6,6 +6,11 @@
 #include <thread>
 #include <chrono>
 #include <random>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <immintrin.h>   // AVX2 / _mm_getcsr / _mm_setcsr
+#include <mkl_vml.h>      // vdSinCos / vdAtan2
 
 namespace convo {
 
@@ -63,14 +68,19 @@ double clampOptimizationFrequency(double sampleRate, double value) noexcept
     return std::clamp(value, 20.0, maxCandidateHz);
 }
 
-double makeRelativeFrequencyStep(double f0) noexcept
-{
-    return std::max(1.0e-3, std::abs(f0) * 1.0e-4);
-}
+using GreedyVector = std::vector<double, convo::MKLAllocator<double>>;
 
-double makeRelativeGainStep(double gain) noexcept
+// 残差との二乗誤差 (Greedy+AdaGrad の目的関数)。errorOut があれば各点の差 τ - residual を書く
+double sumSquaredError(const GreedyVector& tau, const GreedyVector& residual, double* errorOut = nullptr) noexcept
 {
-    return std::clamp(std::max(1.0e-6, std::abs(gain) * 1.0e-4), 1.0e-6, 5.0e-3);
+    double error = 0.0;
+    for (size_t i = 0; i < tau.size(); ++i) {
+        const double diff = tau[i] - residual[i];
+        if (errorOut != nullptr)
+            errorOut[i] = 2.0 * diff;   // d(diff²)/dτ
+        error += diff * diff;
+    }
+    return error;
 }
 
 inline double stableSigmoid01(double x) noexcept
@@ -250,6 +260,188 @@ inline double unconstrainedToTheta(double x) {
 }
 }
 
+//==============================================================================
+// CMA-ES 候補の並列評価
+//==============================================================================
+namespace {
+
+// 目的関数の作業領域 (評価スロット専用、評価中はヒープ確保しない)
+struct CostScratch
+{
+    std::vector<double> rho;
+    std::vector<double> cosTheta;
+    std::vector<double> sinTheta;
+    std::vector<double, convo::MKLAllocator<double>> groupDelay;  // 周波数グリッド分
+};
+
+// ★ 並列評価: NoiseShaperLearner の EvaluationWorkerSlot と同じく、スロットごとに専用スクラッチを持つ
+//   常駐ワーカーが候補インデックスを atomic に取り合い、呼び出し元スレッドはスロット 0 として参加する。
+//   サンプリング (乱数) は呼び出し元で直列に行い、各候補の評価は純関数で結果を候補位置へ書くため、
+//   直列評価とビット単位で一致する (ワーカーの MXCSR も呼び出し元に揃える)。
+class CandidateEvaluationPool
+{
+public:
+    using EvaluateFn = std::function<double(const double*, CostScratch&)>;
+
+    CandidateEvaluationPool(int numSlots, int numSections, int numFreqs, EvaluateFn fn)
+        : slots(static_cast<size_t>(std::max(1, numSlots))),
+          evaluateFn(std::move(fn)),
+          callerCsr(_mm_getcsr())
+    {
+        for (auto& slot : slots)
+        {
+            slot.scratch.rho.resize(static_cast<size_t>(numSections));
+            slot.scratch.cosTheta.resize(static_cast<size_t>(numSections));
+            slot.scratch.sinTheta.resize(static_cast<size_t>(numSections));
+            slot.scratch.groupDelay.resize(static_cast<size_t>(numFreqs));
+        }
+
+        // slots は以降リサイズしない (ワーカーはインデックスで参照する)
+        for (size_t slotIndex = 1; slotIndex < slots.size(); ++slotIndex)
+        {
+            try
+            {
+                slots[slotIndex].thread = std::jthread([this, slotIndex](std::stop_token stopToken)
+                {
+                    workerMain(static_cast<int>(slotIndex), stopToken);
+                });
+                ++activeWorkers;
+            }
+            catch (const std::exception&)
+            {
+                // 起動できた分だけで続行 (0 本なら直列評価)
+                break;
+            }
+        }
+    }
+
+    ~CandidateEvaluationPool()
+    {
+        {
+            const std::scoped_lock<std::mutex> lock(dispatchMutex);
+            shouldExit = true;
+        }
+        dispatchCv.notify_all();
+        for (auto& slot : slots)
+        {
+            if (slot.thread.joinable())
+                slot.thread.join();
+        }
+    }
+
+    int getNumActiveSlots() const noexcept { return activeWorkers + 1; }
+
+    // population: count × dim の行優先配列 (CmaEsOptimizerDynamic::sample の出力そのまま)
+    void evaluate(const double* population, int count, int dim, double* fitness)
+    {
+        pendingPopulation = population;
+        pendingCount = count;
+        pendingDim = dim;
+        pendingFitness = fitness;
+        nextCandidateIndex.store(0, std::memory_order_relaxed);
+
+        if (activeWorkers > 0)
+        {
+            {
+                const std::scoped_lock<std::mutex> lock(dispatchMutex);
+                completedWorkers = 0;
+                ++dispatchSerial;
+            }
+            dispatchCv.notify_all();
+        }
+
+        runJobs(0);
+
+        if (activeWorkers > 0)
+        {
+            std::unique_lock<std::mutex> lock(dispatchMutex);
+            dispatchCv.wait(lock, [this] { return completedWorkers >= activeWorkers; });
+        }
+    }
+
+private:
+    struct Slot
+    {
+        CostScratch scratch;
+        std::jthread thread;
+    };
+
+    void workerMain(int slotIndex, std::stop_token stopToken)
+    {
+        _mm_setcsr(callerCsr);  // FTZ/DAZ・丸めモードを呼び出し元と一致させる (直列評価との一致条件)
+
+        uint32_t observedSerial = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(dispatchMutex);
+                dispatchCv.wait(lock, [&]
+                {
+                    return shouldExit || stopToken.stop_requested() || dispatchSerial != observedSerial;
+                });
+                if (shouldExit || stopToken.stop_requested())
+                    return;
+                observedSerial = dispatchSerial;
+            }
+
+            runJobs(slotIndex);
+
+            {
+                const std::scoped_lock<std::mutex> lock(dispatchMutex);
+                ++completedWorkers;
+            }
+            dispatchCv.notify_all();
+        }
+    }
+
+    void runJobs(int slotIndex)
+    {
+        // pendingPopulation / pendingFitness は dispatchMutex (ワーカー) またはブロック呼び出し (スロット 0) で可視
+        const double* population = pendingPopulation;
+        double* fitness = pendingFitness;
+        auto& scratch = slots[static_cast<size_t>(slotIndex)].scratch;
+        const int count = pendingCount;
+        const size_t dim = static_cast<size_t>(pendingDim);
+
+        for (;;)
+        {
+            const int index = nextCandidateIndex.fetch_add(1, std::memory_order_relaxed);
+            if (index >= count)
+                break;
+            fitness[index] = evaluateFn(population + static_cast<size_t>(index) * dim, scratch);
+        }
+    }
+
+    std::vector<Slot> slots;
+    EvaluateFn evaluateFn;
+    const unsigned int callerCsr;
+    int activeWorkers = 0;
+
+    const double* pendingPopulation = nullptr;
+    int pendingCount = 0;
+    int pendingDim = 0;
+    double* pendingFitness = nullptr;
+    std::atomic<int> nextCandidateIndex { 0 };
+
+    std::mutex dispatchMutex;
+    std::condition_variable dispatchCv;
+    uint32_t dispatchSerial = 0;
+    int completedWorkers = 0;
+    bool shouldExit = false;
+};
+
+int resolveEvaluationSlotCount(int requested, int lambda) noexcept
+{
+    if (requested > 0)
+        return std::clamp(requested, 1, lambda);
+
+    // 0 → 自動: Audio Thread / Loader Thread の余地を残すため論理コアの半分まで
+    const int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(cores / 2, 1, std::min(lambda, AllpassDesignerConfig::kMaxCmaesEvaluationThreads));
+}
+
+} // namespace
+
 //==============================================================================
 // designWithCMAES（修正版：cost関数は全セクション合計、パラメータ変換改善）
 //==============================================================================
@@ -266,24 +458,39 @@ DesignResult AllpassDesigner::designWithCMAES(
 
     const int D = 2 * config.numSections;   // (x_rho, x_theta) のペア
     CmaEsOptimizerDynamic optimizer(D);
-    optimizer.setParams(config.cmaesParams);
-    optimizer.setSeed(config.cmaesSeed != 0 ? config.cmaesSeed : generateRandomSeed());
-    if (config.cmaesInitialSigma > 0.0) {
+    {
         CmaEsOptimizerDynamic::Params p = config.cmaesParams;
-        p.sigmaMin = std::min(p.sigmaMin, config.cmaesInitialSigma);
-        p.sigmaMax = std::max(p.sigmaMax, config.cmaesInitialSigma);
+        p.mirroredSampling = config.cmaesMirroredSampling;
+        p.quasiRandomSampling = config.cmaesQuasiRandomSampling;
+        if (config.cmaesInitialSigma > 0.0) {
+            p.sigmaMin = std::min(p.sigmaMin, config.cmaesInitialSigma);
+            p.sigmaMax = std::max(p.sigmaMax, config.cmaesInitialSigma);
+        }
         optimizer.setParams(p);
     }
+    optimizer.setSeed(config.cmaesSeed != 0 ? config.cmaesSeed : generateRandomSeed());
 
     // 初期平均値（無制約空間）
     // ρ: sigmoid(0) = 0.49 を起点に全セクションで共通
     // θ: 20Hz〜20kHz を対数均等に各セクションへ分散配置
     //    （旧実装では全セクション θ=0 (DC集中) で探索効率が著しく低下していた）
+    // initialSections があるセクションはその (ρ, θ) の逆写像 (logit) から始める
     std::vector<double> initialMean(D, 0.0);
     {
+        const auto logit = [](double p) {
+            const double q = std::clamp(p, 1e-6, 1.0 - 1e-6);
+            return std::log(q / (1.0 - q));
+        };
+        const int numSeeded = std::min(config.numSections, static_cast<int>(config.initialSections.size()));
+        for (int i = 0; i < numSeeded; ++i) {
+            const auto& seed = config.initialSections[static_cast<size_t>(i)];
+            initialMean[2*i]   = logit(seed.rho / 0.98);        // unconstrainedToRho の逆
+            initialMean[2*i+1] = logit(seed.theta / kThetaMax); // unconstrainedToTheta の逆
+        }
+
         const double logMin = std::log(config.minFreqHz);
         const double logMax = std::log(config.maxFreqHz);
-        for (int i = 0; i < config.numSections; ++i) {
+        for (int i = numSeeded; i < config.numSections; ++i) {
             initialMean[2*i] = 0.0;  // unconstrainedToRho(0) = 0.49
 
             // θ = kThetaMax * sigmoid(x) なので x = logit(θ/kThetaMax)
@@ -319,36 +526,25 @@ DesignResult AllpassDesigner::designWithCMAES(
     for (auto& w : weight) w /= weightSum;
 
     // 目的関数：全セクションの群遅延を合計してから誤差を計算
-    auto costFunc = [&](const std::vector<double>& x) -> double {
+    // (共有データは読み取りのみ、作業領域は評価スロットごとの scratch を使う)
+    auto costFunc = [&](const double* x, CostScratch& scratch) -> double {
         // 現在の候補から各セクションの (ρ, θ) を計算
-        std::vector<double> rho_list(config.numSections);
-        std::vector<double> theta_list(config.numSections);
-        std::vector<double> cosTheta(config.numSections);
-        std::vector<double> sinTheta(config.numSections);
+        auto& rho_list = scratch.rho;
+        auto& cosTheta = scratch.cosTheta;
+        auto& sinTheta = scratch.sinTheta;
         for (int s = 0; s < config.numSections; ++s) {
             rho_list[s]   = unconstrainedToRho(x[2*s]);
-            theta_list[s] = unconstrainedToTheta(x[2*s+1]);
-            cosTheta[s]   = std::cos(theta_list[s]);
-            sinTheta[s]   = std::sin(theta_list[s]);
+            const double theta = unconstrainedToTheta(x[2*s+1]);
+            cosTheta[s]   = std::cos(theta);
+            sinTheta[s]   = std::sin(theta);
         }
+        auto& tau_sum = scratch.groupDelay;
+        computeCascadeGroupDelay(rho_list.data(), cosTheta.data(), sinTheta.data(), config.numSections,
+                                 cosOmega.data(), sinOmega.data(), static_cast<int>(freq_hz.size()),
+                                 tau_sum.data());
         double weightedSquaredError = 0.0;
         for (size_t i = 0; i < freq_hz.size(); ++i) {
-            double tau_sum = 0.0;
-            const double cw = cosOmega[i];
-            const double sw = sinOmega[i];
-            for (int s = 0; s < config.numSections; ++s) {
-                const double rho  = rho_list[s];
-                const double rho2 = rho * rho;
-                const double termNum  = 1.0 - rho2;
-                const double cosMinus = cw * cosTheta[s] + sw * sinTheta[s];
-                const double cosPlus  = cw * cosTheta[s] - sw * sinTheta[s];
-                const double denom1   = 1.0 - 2.0 * rho * cosMinus + rho2;
-                const double denom2   = 1.0 - 2.0 * rho * cosPlus  + rho2;
-                const double eps      = 1e-12 * (1.0 + rho2);
-                if (denom1 > eps) tau_sum += termNum / denom1;
-                if (denom2 > eps) tau_sum += termNum / denom2;
-            }
-            const double diff = tau_sum - target_group_delay_samples[i];
+            const double diff = tau_sum[i] - target_group_delay_samples[i];
             weightedSquaredError += weight[i] * diff * diff;
         }
         // weights が sum=1 に正規化済みなので weightedSquaredError は重み付き MSE そのもの
@@ -358,31 +554,57 @@ DesignResult AllpassDesigner::designWithCMAES(
     };
 
     const int lambda = (config.cmaesPopulationSize > 0) ? config.cmaesPopulationSize : 4 * D;
-    std::vector<std::vector<double>> population(lambda, std::vector<double>(D));
+    // 逐次選択: λ/8 個 (mirrored の組を割らない偶数) ずつ評価し、λ/2 個以上評価した後に前世代までの最良を
+    // 更新した候補があれば残りを評価せず、評価済みの先頭 evaluated 個で update する。
+    // 区切りは評価スレッド数によらないため、並列でも直列と同じ結果になる
+    const int sequentialBlock = std::max(2, (lambda / 8) & ~1);
+    const int sequentialMinimum = std::max(4, lambda / 2);
+    const bool sequentialSelection = config.cmaesSequentialSelection && lambda >= 2 * sequentialBlock;
+    long long totalEvaluations = 0;
+    // 集団は lambda × D の連続配列 (行 = 個体)。世代ループ内では確保しない
+    std::vector<double, convo::MKLAllocator<double>> population(static_cast<size_t>(lambda) * static_cast<size_t>(D));
     std::vector<double> fitness(lambda);
+    optimizer.reserve(lambda);
     double bestFitness = std::numeric_limits<double>::max();
     std::vector<double> bestParams(D);
     double prevBestFitness = bestFitness;
     int stagnationCounter = 0;
 
+    CandidateEvaluationPool evaluationPool(resolveEvaluationSlotCount(config.cmaesEvaluationThreads, lambda),
+                                           config.numSections,
+                                           static_cast<int>(freq_hz.size()),
+                                           costFunc);
+
     juce::Logger::writeToLog("CMA-ES optimization started with "
                              + juce::String(config.numSections)
                              + " sections, dim=" + juce::String(D)
                              + ", lambda=" + juce::String(lambda)
-                             + ", maxGen=" + juce::String(config.cmaesMaxGenerations));
+                             + ", maxGen=" + juce::String(config.cmaesMaxGenerations)
+                             + ", evalThreads=" + juce::String(evaluationPool.getNumActiveSlots()));
 
     for (int gen = 0; gen < config.cmaesMaxGenerations; ++gen) {
         if (shouldExit && shouldExit()) return DesignResult::Cancelled;
 
-        optimizer.sample(population);
-        for (int i = 0; i < lambda; ++i) {
-            fitness[i] = costFunc(population[i]);
-            if (fitness[i] < bestFitness) {
-                bestFitness = fitness[i];
-                bestParams = population[i];
+        optimizer.sample(population.data(), lambda);
+        const double bestBeforeGeneration = bestFitness;
+        int evaluated = 0;
+        while (evaluated < lambda) {
+            const int count = sequentialSelection ? std::min(sequentialBlock, lambda - evaluated) : lambda;
+            evaluationPool.evaluate(population.data() + static_cast<size_t>(evaluated) * static_cast<size_t>(D),
+                                    count, D, fitness.data() + evaluated);
+            for (int i = evaluated; i < evaluated + count; ++i) {
+                if (fitness[i] < bestFitness) {
+                    bestFitness = fitness[i];
+                    const double* row = population.data() + static_cast<size_t>(i) * static_cast<size_t>(D);
+                    std::copy(row, row + D, bestParams.begin());
+                }
             }
+            evaluated += count;
+            if (sequentialSelection && evaluated >= sequentialMinimum && bestFitness < bestBeforeGeneration)
+                break;
         }
-        optimizer.update(population, fitness);
+        totalEvaluations += evaluated;
+        optimizer.update(population.data(), evaluated, fitness.data());
 
         // Non-RT worker thread側で協調的にCPUを譲り、再生スレッドへの干渉を抑える。
         if ((gen & 1) == 0)
@@ -442,6 +664,7 @@ DesignResult AllpassDesigner::designWithCMAES(
 
     juce::Logger::writeToLog("CMA-ES optimization finished. Best fitness="
                              + juce::String(bestFitness)
+                             + ", evaluations=" + juce::String(totalEvaluations)
                              + ", sigma=" + juce::String(optimizer.getSigma()));
 
     sections.clear();
@@ -475,9 +698,16 @@ bool AllpassDesigner::design(double sampleRate,
     if (shouldExit && shouldExit()) return false;
 
     // ========== 従来の Greedy+AdaGrad（内部で (ρ, θ) を使用） ==========
+    // 群遅延と勾配はバッチ評価 (computeCascadeGroupDelay / computeCascadeGroupDelayGradient) で計算するため
+    // cosω / sinω を一度だけ作る
     std::vector<double, convo::MKLAllocator<double>> omega(freq_hz.size());
-    for (size_t i = 0; i < freq_hz.size(); ++i)
+    std::vector<double, convo::MKLAllocator<double>> cosOmega(freq_hz.size());
+    std::vector<double, convo::MKLAllocator<double>> sinOmega(freq_hz.size());
+    for (size_t i = 0; i < freq_hz.size(); ++i) {
         omega[i] = 2.0 * juce::MathConstants<double>::pi * freq_hz[i] / sampleRate;
+        cosOmega[i] = std::cos(omega[i]);
+        sinOmega[i] = std::sin(omega[i]);
+    }
 
     std::vector<double, convo::MKLAllocator<double>> residual(target_group_delay_samples.begin(),
                                                                 target_group_delay_samples.end());
@@ -488,9 +718,9 @@ bool AllpassDesigner::design(double sampleRate,
         if (shouldExit && shouldExit()) return false;
 
         double best_f0 = 1000.0, best_gain = 0.5;
-        if (!gridSearch2D(omega, residual, sampleRate, best_f0, best_gain))
+        if (!gridSearch2D(cosOmega, sinOmega, residual, sampleRate, best_f0, best_gain))
             return false;
-        adaptiveGradientDescent(omega, residual, sampleRate, best_f0, best_gain,
+        adaptiveGradientDescent(cosOmega, sinOmega, residual, sampleRate, best_f0, best_gain,
                                 config.learningRate, config.maxIterations);
 
         SecondOrderAllpass section;
@@ -514,28 +744,36 @@ bool AllpassDesigner::design(double sampleRate,
             }
         }
     }
+
+    // 貪欲法は 1 セクションずつ残差に合わせるだけなので、最後に全セクションを同時に詰める
+    if (shouldExit && shouldExit()) return false;
+    const GreedyVector target(target_group_delay_samples.begin(), target_group_delay_samples.end());
+    refineJointly(cosOmega, sinOmega, target, sections, config.learningRate, config.maxIterations, shouldExit);
     return true;
 }
 
 //==============================================================================
 // 従来の補助関数（実装維持、ただし内部で MKLAllocator を使用）
 //==============================================================================
-bool AllpassDesigner::gridSearch2D(const std::vector<double, convo::MKLAllocator<double>>& omega,
+bool AllpassDesigner::gridSearch2D(const std::vector<double, convo::MKLAllocator<double>>& cosOmega,
+                                   const std::vector<double, convo::MKLAllocator<double>>& sinOmega,
                                    const std::vector<double, convo::MKLAllocator<double>>& residual,
                                    double sampleRate,
                                    double& best_f0, double& best_gain) {
     const std::vector<double> f0_candidates = buildFrequencyCandidates(sampleRate);
     const std::vector<double> gain_candidates = { 0.1, 0.3, 0.5, 0.7, 0.9, 0.95, 0.98 };
+    const int numFreqs = static_cast<int>(cosOmega.size());
+    GreedyVector tau(cosOmega.size());
 
     double best_error = std::numeric_limits<double>::max();
     for (double f0 : f0_candidates) {
+        const double theta = 2.0 * juce::MathConstants<double>::pi * f0 / sampleRate;
+        const double cosTheta = std::cos(theta);
+        const double sinTheta = std::sin(theta);
         for (double gain : gain_candidates) {
-            double error = 0.0;
-            for (size_t i = 0; i < omega.size(); ++i) {
-                double tau = sectionGroupDelay(f0, gain, omega[i], sampleRate);
-                double diff = tau - residual[i];
-                error += diff * diff;
-            }
+            computeCascadeGroupDelay(&gain, &cosTheta, &sinTheta, 1,
+                                     cosOmega.data(), sinOmega.data(), numFreqs, tau.data());
+            const double error = sumSquaredError(tau, residual);
             if (error < best_error) {
                 best_error = error;
                 best_f0 = f0;
@@ -546,37 +784,39 @@ bool AllpassDesigner::gridSearch2D(const std::vector<double, convo::MKLAllocator
     return best_error < std::numeric_limits<double>::max();
 }
 
-bool AllpassDesigner::adaptiveGradientDescent(const std::vector<double, convo::MKLAllocator<double>>& omega,
+bool AllpassDesigner::adaptiveGradientDescent(const std::vector<double, convo::MKLAllocator<double>>& cosOmega,
+                                              const std::vector<double, convo::MKLAllocator<double>>& sinOmega,
                                               const std::vector<double, convo::MKLAllocator<double>>& residual,
                                               double sampleRate,
                                               double& f0, double& gain,
                                               double learningRate, int maxIterations) {
+    // 勾配は解析式 (旧実装は f0 / gain それぞれ中心差分で誤差を 4 回評価していた)。
+    // θ = 2π·f0/fs なので ∂/∂f0 = ∂/∂θ · 2π/fs、ρ = gain (0..0.995 にクランプ済み)
+    const int numFreqs = static_cast<int>(cosOmega.size());
+    const double dThetaDf0 = 2.0 * juce::MathConstants<double>::pi / sampleRate;
+    GreedyVector tau(cosOmega.size());
+    GreedyVector errorWeight(cosOmega.size());
+
     double grad_f0_norm = 0.0, grad_gain_norm = 0.0;
     double prev_error = std::numeric_limits<double>::max();
 
     for (int iter = 0; iter < maxIterations; ++iter) {
-        double error = 0.0;
-        for (size_t i = 0; i < omega.size(); ++i) {
-            double tau = sectionGroupDelay(f0, gain, omega[i], sampleRate);
-            double diff = tau - residual[i];
-            error += diff * diff;
-        }
+        const double rho = std::clamp(std::abs(gain), 0.0, 0.995);
+        const double theta = f0 * dThetaDf0;
+        const double cosTheta = std::cos(theta);
+        const double sinTheta = std::sin(theta);
+        computeCascadeGroupDelay(&rho, &cosTheta, &sinTheta, 1,
+                                 cosOmega.data(), sinOmega.data(), numFreqs, tau.data());
+        const double error = sumSquaredError(tau, residual, errorWeight.data());
         if (error >= prev_error) break;
         prev_error = error;
 
-        const double epsF0 = makeRelativeFrequencyStep(f0);
-        const double epsGain = makeRelativeGainStep(gain);
-        double err_f0_plus = 0.0, err_f0_minus = 0.0;
-        double err_gain_plus = 0.0, err_gain_minus = 0.0;
-        for (size_t i = 0; i < omega.size(); ++i) {
-            err_f0_plus += std::pow(sectionGroupDelay(f0 + epsF0, gain, omega[i], sampleRate) - residual[i], 2);
-            err_f0_minus += std::pow(sectionGroupDelay(f0 - epsF0, gain, omega[i], sampleRate) - residual[i], 2);
-            err_gain_plus += std::pow(sectionGroupDelay(f0, gain + epsGain, omega[i], sampleRate) - residual[i], 2);
-            err_gain_minus += std::pow(sectionGroupDelay(f0, gain - epsGain, omega[i], sampleRate) - residual[i], 2);
-        }
+        double grad_gain = 0.0, grad_theta = 0.0;
+        computeCascadeGroupDelayGradient(&rho, &cosTheta, &sinTheta, 1,
+                                         cosOmega.data(), sinOmega.data(), numFreqs,
+                                         errorWeight.data(), &grad_gain, &grad_theta);
 
-        double grad_f0 = (err_f0_plus - err_f0_minus) / (2.0 * epsF0);
-        double grad_gain = (err_gain_plus - err_gain_minus) / (2.0 * epsGain);
+        const double grad_f0 = grad_theta * dThetaDf0;
         grad_f0_norm += grad_f0 * grad_f0;
         grad_gain_norm += grad_gain * grad_gain;
         f0 -= learningRate * grad_f0 / (std::sqrt(grad_f0_norm) + 1e-8);
@@ -587,6 +827,288 @@ bool AllpassDesigner::adaptiveGradientDescent(const std::vector<double, convo::M
     return true;
 }
 
+void AllpassDesigner::refineJointly(const std::vector<double, convo::MKLAllocator<double>>& cosOmega,
+                                    const std::vector<double, convo::MKLAllocator<double>>& sinOmega,
+                                    const std::vector<double, convo::MKLAllocator<double>>& target,
+                                    std::vector<SecondOrderAllpass>& sections,
+                                    double learningRate, int maxIterations,
+                                    const std::function<bool()>& shouldExit) {
+    const int numSections = static_cast<int>(sections.size());
+    const int numFreqs = static_cast<int>(cosOmega.size());
+    if (numSections <= 1 || numFreqs <= 0 || maxIterations <= 0)
+        return;
+
+    std::vector<double> rho(static_cast<size_t>(numSections)), theta(static_cast<size_t>(numSections));
+    std::vector<double> cosTheta(static_cast<size_t>(numSections)), sinTheta(static_cast<size_t>(numSections));
+    std::vector<double> gradRho(static_cast<size_t>(numSections)), gradTheta(static_cast<size_t>(numSections));
+    std::vector<double> normRho(static_cast<size_t>(numSections), 0.0), normTheta(static_cast<size_t>(numSections), 0.0);
+    std::vector<double> thetaStep(static_cast<size_t>(numSections));
+    for (int s = 0; s < numSections; ++s) {
+        rho[s] = sections[s].rho;
+        theta[s] = sections[s].theta;
+        // θ は中心周波数に比例した刻み (f0 の相対変化) で動かす。ρ は learningRate そのまま
+        thetaStep[s] = learningRate * std::max(theta[s], 1e-3);
+    }
+
+    GreedyVector tau(cosOmega.size());
+    GreedyVector errorWeight(cosOmega.size());
+    double bestError = std::numeric_limits<double>::max();
+    std::vector<SecondOrderAllpass> best = sections;
+
+    for (int iter = 0; iter < maxIterations; ++iter) {
+        if (shouldExit && shouldExit()) break;
+
+        for (int s = 0; s < numSections; ++s) {
+            cosTheta[s] = std::cos(theta[s]);
+            sinTheta[s] = std::sin(theta[s]);
+        }
+        computeCascadeGroupDelay(rho.data(), cosTheta.data(), sinTheta.data(), numSections,
+                                 cosOmega.data(), sinOmega.data(), numFreqs, tau.data());
+        const double error = sumSquaredError(tau, target, errorWeight.data());
+        if (!(error < bestError)) break;   // 悪化 (または非有限) したら直前の最良で止める
+        bestError = error;
+        for (int s = 0; s < numSections; ++s)
+            best[s] = { rho[s], theta[s] };
+
+        computeCascadeGroupDelayGradient(rho.data(), cosTheta.data(), sinTheta.data(), numSections,
+                                         cosOmega.data(), sinOmega.data(), numFreqs,
+                                         errorWeight.data(), gradRho.data(), gradTheta.data());
+        for (int s = 0; s < numSections; ++s) {
+            normRho[s] += gradRho[s] * gradRho[s];
+            normTheta[s] += gradTheta[s] * gradTheta[s];
+            rho[s] = std::clamp(rho[s] - learningRate * gradRho[s] / (std::sqrt(normRho[s]) + 1e-8), 0.0, 0.995);
+            theta[s] = std::clamp(theta[s] - thetaStep[s] * gradTheta[s] / (std::sqrt(normTheta[s]) + 1e-8),
+                                  1e-6, kThetaMax);
+        }
+    }
+    sections = std::move(best);
+}
+
+//==============================================================================
+// バッチ評価：カスケード群遅延（AVX2）
+//==============================================================================
+void AllpassDesigner::computeCascadeGroupDelay(const double* rho,
+                                               const double* cosTheta,
+                                               const double* sinTheta,
+                                               int numSections,
+                                               const double* cosOmega,
+                                               const double* sinOmega,
+                                               int numFreqs,
+                                               double* outGroupDelay) noexcept
+{
+    // スカラー版 (sectionGroupDelayRhoTheta の cos 加法定理展開) と同じ演算順序を保つ (FMA は使わない)
+    auto scalarAt = [&](int i) noexcept
+    {
+        double tau = 0.0;
+        const double cw = cosOmega[i];
+        const double sw = sinOmega[i];
+        for (int s = 0; s < numSections; ++s) {
+            const double r        = rho[s];
+            const double r2       = r * r;
+            const double termNum  = 1.0 - r2;
+            const double cosMinus = cw * cosTheta[s] + sw * sinTheta[s];
+            const double cosPlus  = cw * cosTheta[s] - sw * sinTheta[s];
+            const double denom1   = 1.0 - 2.0 * r * cosMinus + r2;
+            const double denom2   = 1.0 - 2.0 * r * cosPlus  + r2;
+            const double eps      = 1e-12 * (1.0 + r2);
+            if (denom1 > eps) tau += termNum / denom1;
+            if (denom2 > eps) tau += termNum / denom2;
+        }
+        outGroupDelay[i] = tau;
+    };
+
+    const __m256d vOne = _mm256_set1_pd(1.0);
+    const __m256d vTwo = _mm256_set1_pd(2.0);
+    const __m256d vEpsScale = _mm256_set1_pd(1e-12);
+
+    int i = 0;
+    for (; i + 4 <= numFreqs; i += 4) {
+        const __m256d cw = _mm256_loadu_pd(cosOmega + i);
+        const __m256d sw = _mm256_loadu_pd(sinOmega + i);
+        __m256d tau = _mm256_setzero_pd();
+        for (int s = 0; s < numSections; ++s) {
+            const __m256d r       = _mm256_set1_pd(rho[s]);
+            const __m256d r2      = _mm256_mul_pd(r, r);
+            const __m256d termNum = _mm256_sub_pd(vOne, r2);
+            const __m256d twoR    = _mm256_mul_pd(vTwo, r);
+            const __m256d cc      = _mm256_mul_pd(cw, _mm256_set1_pd(cosTheta[s]));
+            const __m256d ss      = _mm256_mul_pd(sw, _mm256_set1_pd(sinTheta[s]));
+            const __m256d cosMinus = _mm256_add_pd(cc, ss);
+            const __m256d cosPlus  = _mm256_sub_pd(cc, ss);
+            const __m256d denom1  = _mm256_add_pd(_mm256_sub_pd(vOne, _mm256_mul_pd(twoR, cosMinus)), r2);
+            const __m256d denom2  = _mm256_add_pd(_mm256_sub_pd(vOne, _mm256_mul_pd(twoR, cosPlus)), r2);
+            const __m256d eps     = _mm256_mul_pd(vEpsScale, _mm256_add_pd(vOne, r2));
+            // denom <= eps のレーンは 0 を加算 (スカラー版の分岐と同値。除算結果の inf/NaN はマスクで捨てる)
+            const __m256d q1 = _mm256_and_pd(_mm256_cmp_pd(denom1, eps, _CMP_GT_OQ), _mm256_div_pd(termNum, denom1));
+            const __m256d q2 = _mm256_and_pd(_mm256_cmp_pd(denom2, eps, _CMP_GT_OQ), _mm256_div_pd(termNum, denom2));
+            tau = _mm256_add_pd(_mm256_add_pd(tau, q1), q2);
+        }
+        _mm256_storeu_pd(outGroupDelay + i, tau);
+    }
+    for (; i < numFreqs; ++i)
+        scalarAt(i);
+}
+
+//==============================================================================
+// バッチ評価：カスケード群遅延の (ρ, θ) 勾配（AVX2）
+//==============================================================================
+void AllpassDesigner::computeCascadeGroupDelayGradient(const double* rho,
+                                                       const double* cosTheta,
+                                                       const double* sinTheta,
+                                                       int numSections,
+                                                       const double* cosOmega,
+                                                       const double* sinOmega,
+                                                       int numFreqs,
+                                                       const double* errorWeight,
+                                                       double* outGradRho,
+                                                       double* outGradTheta) noexcept
+{
+    // 1 セクションの群遅延 τ = (1-ρ²)/D₋ + (1-ρ²)/D₊、D∓ = 1 - 2ρ·cos(ω∓θ) + ρ² について
+    //   ∂/∂ρ [(1-ρ²)/D] = (2(1+ρ²)·cos(ω∓θ) - 4ρ) / D²
+    //   ∂/∂θ [(1-ρ²)/D₋] =  2ρ(1-ρ²)·sin(ω-θ) / D₋²
+    //   ∂/∂θ [(1-ρ²)/D₊] = -2ρ(1-ρ²)·sin(ω+θ) / D₊²
+    // D <= eps の項は群遅延側 (computeCascadeGroupDelay) と同じく寄与 0 とする
+    const __m256d vOne = _mm256_set1_pd(1.0);
+    const __m256d vTwo = _mm256_set1_pd(2.0);
+    const __m256d vEpsScale = _mm256_set1_pd(1e-12);
+
+    for (int s = 0; s < numSections; ++s) {
+        const double r = rho[s];
+        const double r2 = r * r;
+        const double ct = cosTheta[s];
+        const double st = sinTheta[s];
+        const double rhoCoef = 2.0 * (1.0 + r2);
+        const double thetaCoef = 2.0 * r * (1.0 - r2);
+        const double eps = 1e-12 * (1.0 + r2);
+
+        const __m256d vR = _mm256_set1_pd(r);
+        const __m256d vR2 = _mm256_set1_pd(r2);
+        const __m256d vTwoR = _mm256_mul_pd(vTwo, vR);
+        const __m256d vFourR = _mm256_mul_pd(vTwo, vTwoR);
+        const __m256d vCt = _mm256_set1_pd(ct);
+        const __m256d vSt = _mm256_set1_pd(st);
+        const __m256d vRhoCoef = _mm256_set1_pd(rhoCoef);
+        const __m256d vThetaCoef = _mm256_set1_pd(thetaCoef);
+        const __m256d vEps = _mm256_mul_pd(vEpsScale, _mm256_add_pd(vOne, vR2));
+
+        __m256d accRho = _mm256_setzero_pd();
+        __m256d accTheta = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 4 <= numFreqs; i += 4) {
+            const __m256d cw = _mm256_loadu_pd(cosOmega + i);
+            const __m256d sw = _mm256_loadu_pd(sinOmega + i);
+            const __m256d e  = _mm256_loadu_pd(errorWeight + i);
+            const __m256d cc = _mm256_mul_pd(cw, vCt);
+            const __m256d ss = _mm256_mul_pd(sw, vSt);
+            const __m256d sc = _mm256_mul_pd(sw, vCt);
+            const __m256d cs = _mm256_mul_pd(cw, vSt);
+            const __m256d cosMinus = _mm256_add_pd(cc, ss);   // cos(ω-θ)
+            const __m256d cosPlus  = _mm256_sub_pd(cc, ss);   // cos(ω+θ)
+            const __m256d sinMinus = _mm256_sub_pd(sc, cs);   // sin(ω-θ)
+            const __m256d sinPlus  = _mm256_add_pd(sc, cs);   // sin(ω+θ)
+            const __m256d d1 = _mm256_add_pd(_mm256_sub_pd(vOne, _mm256_mul_pd(vTwoR, cosMinus)), vR2);
+            const __m256d d2 = _mm256_add_pd(_mm256_sub_pd(vOne, _mm256_mul_pd(vTwoR, cosPlus)), vR2);
+            const __m256d m1 = _mm256_cmp_pd(d1, vEps, _CMP_GT_OQ);
+            const __m256d m2 = _mm256_cmp_pd(d2, vEps, _CMP_GT_OQ);
+            // e / D² (マスク外のレーンの inf/NaN は and で 0 にする)
+            const __m256d w1 = _mm256_and_pd(m1, _mm256_div_pd(e, _mm256_mul_pd(d1, d1)));
+            const __m256d w2 = _mm256_and_pd(m2, _mm256_div_pd(e, _mm256_mul_pd(d2, d2)));
+
+            const __m256d gR1 = _mm256_sub_pd(_mm256_mul_pd(vRhoCoef, cosMinus), vFourR);
+            const __m256d gR2 = _mm256_sub_pd(_mm256_mul_pd(vRhoCoef, cosPlus), vFourR);
+            accRho = _mm256_add_pd(accRho, _mm256_add_pd(_mm256_mul_pd(w1, gR1), _mm256_mul_pd(w2, gR2)));
+            accTheta = _mm256_add_pd(accTheta, _mm256_mul_pd(vThetaCoef,
+                           _mm256_sub_pd(_mm256_mul_pd(w1, sinMinus), _mm256_mul_pd(w2, sinPlus))));
+        }
+
+        alignas(32) double laneRho[4];
+        alignas(32) double laneTheta[4];
+        _mm256_store_pd(laneRho, accRho);
+        _mm256_store_pd(laneTheta, accTheta);
+        double gradRho = (laneRho[0] + laneRho[1]) + (laneRho[2] + laneRho[3]);
+        double gradTheta = (laneTheta[0] + laneTheta[1]) + (laneTheta[2] + laneTheta[3]);
+
+        for (; i < numFreqs; ++i) {
+            const double cw = cosOmega[i];
+            const double sw = sinOmega[i];
+            const double cosMinus = cw * ct + sw * st;
+            const double cosPlus  = cw * ct - sw * st;
+            const double sinMinus = sw * ct - cw * st;
+            const double sinPlus  = sw * ct + cw * st;
+            const double d1 = 1.0 - 2.0 * r * cosMinus + r2;
+            const double d2 = 1.0 - 2.0 * r * cosPlus + r2;
+            const double w1 = (d1 > eps) ? errorWeight[i] / (d1 * d1) : 0.0;
+            const double w2 = (d2 > eps) ? errorWeight[i] / (d2 * d2) : 0.0;
+            gradRho += w1 * (rhoCoef * cosMinus - 4.0 * r) + w2 * (rhoCoef * cosPlus - 4.0 * r);
+            gradTheta += thetaCoef * (w1 * sinMinus - w2 * sinPlus);
+        }
+        outGradRho[s] = gradRho;
+        outGradTheta[s] = gradTheta;
+    }
+}
+
+//==============================================================================
+// バッチ評価：カスケード位相（MKL VML）
+//==============================================================================
+void AllpassDesigner::computeCascadePhase(const std::vector<SecondOrderAllpass>& sections,
+                                          const double* omega,
+                                          int numFreqs,
+                                          double* outPhase)
+{
+    if (numFreqs <= 0)
+        return;
+
+    const size_t n = static_cast<size_t>(numFreqs);
+    std::vector<double, convo::MKLAllocator<double>> sinW(n), cosW(n), sin2W(n), cos2W(n);
+    std::vector<double, convo::MKLAllocator<double>> denRe(n), denIm(n), denArg(n);
+
+    vdSinCos(static_cast<MKL_INT>(numFreqs), omega, sinW.data(), cosW.data());
+    const double numerDelay = 2.0 * static_cast<double>(sections.size());
+    for (size_t i = 0; i < n; ++i) {
+        sin2W[i] = 2.0 * sinW[i] * cosW[i];
+        cos2W[i] = 2.0 * cosW[i] * cosW[i] - 1.0;
+        outPhase[i] = -numerDelay * omega[i];
+    }
+
+    for (const auto& sec : sections) {
+        // D(e^{jω}) = 1 + a1·e^{-jω} + a2·e^{-2jω}
+        const double a1 = -2.0 * sec.rho * std::cos(sec.theta);
+        const double a2 = sec.rho * sec.rho;
+        for (size_t i = 0; i < n; ++i) {
+            denRe[i] = 1.0 + a1 * cosW[i] + a2 * cos2W[i];
+            denIm[i] = -(a1 * sinW[i] + a2 * sin2W[i]);
+        }
+        vdAtan2(static_cast<MKL_INT>(numFreqs), denIm.data(), denRe.data(), denArg.data());
+        for (size_t i = 0; i < n; ++i)
+            outPhase[i] -= 2.0 * denArg[i];
+    }
+}
+
+//==============================================================================
+// rescaleToSampleRate
+//==============================================================================
+std::vector<SecondOrderAllpass> AllpassDesigner::rescaleToSampleRate(const std::vector<SecondOrderAllpass>& sections,
+                                                                     double sourceRate,
+                                                                     double targetRate)
+{
+    std::vector<SecondOrderAllpass> out;
+    if (sourceRate <= 0.0 || targetRate <= 0.0)
+        return out;
+
+    // z' = exp(ln(z)·fsSrc/fsDst): 中心周波数 [Hz] と帯域幅 [Hz] (-fs·ln ρ) がともに保たれる
+    const double ratio = sourceRate / targetRate;
+    out.reserve(sections.size());
+    for (const auto& sec : sections) {
+        if (!(sec.rho > 0.0 && sec.rho < 1.0) || !std::isfinite(sec.theta))
+            continue;
+        SecondOrderAllpass mapped;
+        mapped.rho = std::clamp(std::pow(sec.rho, ratio), 1e-6, 0.98);
+        mapped.theta = std::clamp(sec.theta * ratio, 1e-6, kThetaMax);
+        out.push_back(mapped);
+    }
+    return out;
+}
+
 //==============================================================================
 // computeResponse
 //==============================================================================
@@ -596,12 +1118,19 @@ AllpassDesigner::computeResponse(const std::vector<SecondOrderAllpass>& sections
                                  const std::vector<double>& freq_hz)
 {
     std::vector<std::complex<double>, convo::MKLAllocator<std::complex<double>>> response(freq_hz.size(), 1.0);
-    for (size_t i = 0; i < freq_hz.size(); ++i) {
-        double omega = 2.0 * juce::MathConstants<double>::pi * freq_hz[i] / sampleRate;
-        for (const auto& sec : sections) {
-            response[i] *= sec.response(omega);
-        }
-    }
+    if (freq_hz.empty() || sections.empty())
+        return response;
+
+    // |H| = 1 の全通過なので位相のみをバッチ計算し、単位円上の複素数へ戻す
+    const size_t n = freq_hz.size();
+    std::vector<double, convo::MKLAllocator<double>> omega(n), phase(n), sinP(n), cosP(n);
+    for (size_t i = 0; i < n; ++i)
+        omega[i] = 2.0 * juce::MathConstants<double>::pi * freq_hz[i] / sampleRate;
+
+    computeCascadePhase(sections, omega.data(), static_cast<int>(n), phase.data());
+    vdSinCos(static_cast<MKL_INT>(n), phase.data(), sinP.data(), cosP.data());
+    for (size_t i = 0; i < n; ++i)
+        response[i] = std::complex<double>(cosP[i], sinP[i]);
     return response;
 }
 
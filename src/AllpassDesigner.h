@@ -75,8 +75,19 @@ struct AllpassDesignerConfig {
     int cmaesPopulationSize = 32;          // 0 → 自動 (4 * dim)
     double cmaesInitialSigma = 0.3;
     uint64_t cmaesSeed = 0x434f4e564f4251ull; // 既定で決定的シードを使う
+    int cmaesEvaluationThreads = 0;        // 候補評価スレッド数 (0 → 自動, 1 → 直列)
+    // ★ 評価回数の削減 (目的関数の評価が CMA-ES のコストの大半)
+    bool cmaesMirroredSampling = true;     // z / −z の組で引き、組の良い方だけを選抜 (CmaEsSampling.h)
+    bool cmaesQuasiRandomSampling = false; // 組の元をランダムシフト R_d 列 (準乱数) から引く
+    bool cmaesSequentialSelection = true;  // 世代の半数以上を評価し、前世代の最良を更新した時点で残りを打ち切る
+    static constexpr int kMaxCmaesEvaluationThreads = 8;
     std::function<void(float)> progressCallback;
 
+    // ★ ウォームスタート: CMA-ES の初期平均をこのセクション列から始める (空 = 従来の対数均等配置)。
+    //   numSections より少なければ残りは従来配置で埋め、多ければ先頭 numSections 個だけ使う。
+    //   別レートの設計を rescaleToSampleRate() で写したものを、小さい σ・少ない世代で詰め直す用途
+    std::vector<SecondOrderAllpass> initialSections;
+
     AllpassDesignerConfig() {
         cmaesParams.sigmaMin = 1e-6;
         cmaesParams.sigmaMax = 2.0;
@@ -120,23 +131,74 @@ public:
     // 静的ヘルパー：群遅延計算（(f0, gain) 版、後方互換）
     static double sectionGroupDelay(double f0, double gain, double omega, double sampleRate);
 
-    // 設計された全通過フィルタの複素周波数応答を計算
+    // ★ 別サンプルレートの設計を写す: 極 z = ρe^{jθ} をアナログ極 s = fs·ln z が同じになるよう
+    //   ρ' = ρ^(fsSrc/fsDst), θ' = θ·fsSrc/fsDst へ移す (群遅延の形は周波数軸で保たれる)。
+    //   新しい Nyquist を超えるセクションは θ を Nyquist 手前に寄せて残す。ρ は設計器の範囲 (≤ 0.98) に収め、
+    //   ρ ∉ (0, 1) や θ が非有限のセクションだけ捨てる
+    static std::vector<SecondOrderAllpass> rescaleToSampleRate(const std::vector<SecondOrderAllpass>& sections,
+                                                               double sourceRate,
+                                                               double targetRate);
+
+    // 設計された全通過フィルタの複素周波数応答を計算 (computeCascadePhase 経由のバッチ評価)
     static std::vector<std::complex<double>, convo::MKLAllocator<std::complex<double>>>
         computeResponse(const std::vector<SecondOrderAllpass>& sections,
                         double sampleRate,
                         const std::vector<double>& freq_hz);
 
+    // ★ バッチ評価: カスケード全体の群遅延 [samples] を周波数グリッドで一括計算する (CMA-ES 目的関数の内側ループ)。
+    //   cos/sin は呼び出し側で前計算したテーブルを渡す (セクション側 cosθ/sinθ、周波数側 cosω/sinω)。
+    //   AVX2 で 4 周波数ずつ処理し、各周波数のセクション加算順序は sectionGroupDelayRhoTheta の逐次合計と同じ。
+    static void computeCascadeGroupDelay(const double* rho,
+                                         const double* cosTheta,
+                                         const double* sinTheta,
+                                         int numSections,
+                                         const double* cosOmega,
+                                         const double* sinOmega,
+                                         int numFreqs,
+                                         double* outGroupDelay) noexcept;
+
+    // ★ バッチ評価: 群遅延の解析勾配。outGradRho[s] = Σᵢ errorWeight[i]·∂τᵢ/∂ρₛ、outGradTheta[s] も θₛ について同様。
+    //   errorWeight に 2·(τ - 目標) (重み付きなら 2·w·(τ - 目標)) を渡せば二乗誤差の勾配になる。
+    //   引数の cos/sin テーブルは computeCascadeGroupDelay と共通で、同じ点を分母 <= eps として捨てる。
+    //   セクションごとに AVX2 で 4 周波数ずつ積算する (Greedy+AdaGrad の勾配)
+    static void computeCascadeGroupDelayGradient(const double* rho,
+                                                 const double* cosTheta,
+                                                 const double* sinTheta,
+                                                 int numSections,
+                                                 const double* cosOmega,
+                                                 const double* sinOmega,
+                                                 int numFreqs,
+                                                 const double* errorWeight,
+                                                 double* outGradRho,
+                                                 double* outGradTheta) noexcept;
+
+    // ★ バッチ評価: カスケード全体の位相応答 [rad] (アンラップ済み)。
+    //   全通過 H = e^{-2jω}·conj(D)/D より arg H = -2ω - 2·arg D を MKL VML (vdSinCos / vdAtan2) で一括計算する。
+    static void computeCascadePhase(const std::vector<SecondOrderAllpass>& sections,
+                                    const double* omega,
+                                    int numFreqs,
+                                    double* outPhase);
+
 private:
-    // 従来の補助関数（Greedy+AdaGrad 用、現状維持）
-    static bool gridSearch2D(const std::vector<double, convo::MKLAllocator<double>>& omega,
+    // Greedy+AdaGrad 用の補助関数 (cosω / sinω テーブルを受け取り、群遅延・勾配はバッチ評価)
+    static bool gridSearch2D(const std::vector<double, convo::MKLAllocator<double>>& cosOmega,
+                             const std::vector<double, convo::MKLAllocator<double>>& sinOmega,
                              const std::vector<double, convo::MKLAllocator<double>>& residual,
                              double sampleRate,
                              double& best_f0, double& best_gain);
-    static bool adaptiveGradientDescent(const std::vector<double, convo::MKLAllocator<double>>& omega,
+    static bool adaptiveGradientDescent(const std::vector<double, convo::MKLAllocator<double>>& cosOmega,
+                                        const std::vector<double, convo::MKLAllocator<double>>& sinOmega,
                                         const std::vector<double, convo::MKLAllocator<double>>& residual,
                                         double sampleRate,
                                         double& f0, double& gain,
                                         double learningRate, int maxIterations);
+    // 貪欲に並べた全セクションを目標群遅延へ同時に AdaGrad で詰める (悪化した時点の直前を採用)
+    static void refineJointly(const std::vector<double, convo::MKLAllocator<double>>& cosOmega,
+                              const std::vector<double, convo::MKLAllocator<double>>& sinOmega,
+                              const std::vector<double, convo::MKLAllocator<double>>& target,
+                              std::vector<SecondOrderAllpass>& sections,
+                              double learningRate, int maxIterations,
+                              const std::function<bool()>& shouldExit);
 };
 
 } // namespace convo
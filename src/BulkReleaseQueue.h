@@ -0,0 +1,180 @@
+// src/BulkReleaseQueue.h
+// 大きな退役オブジェクトの解放を DeferredFreeThread へ回すキュー
+//
+// 背景:
+//   長い IR を差し替えると、退役した StereoConvolver (MKLNonUniformConvolver のレイヤー群) は
+//   数百 MB の mkl_free / VirtualFree を伴う。RCU の回収 (tryReclaim) はそれを呼び出したスレッド
+//   ── Message Thread のタイマーや rebuild スレッド ── でそのまま実行するため、ページ解放の
+//   コストが UI の停止や次の rebuild の遅れとして表に出ていた。
+//
+// 方針:
+//   - 回収側 (deleter) は推定解放量が thresholdBytes 以上なら tryDefer でここへ積むだけにして戻る。
+//     閾値未満・受け手なし・満杯のときは false を返し、呼び出し側がその場で解放する。
+//   - 受け手 (DeferredFreeThread) は releaseBatch で先頭から byteBudget に達するまで解放する
+//     (最低 1 件)。間隔は受け手側で空け、OS への返却を小分けにする。
+//   - 最後の受け手が detachDrainer で外れるときは、残りを呼び出し側でまとめて解放する
+//     (DeferredFreeThread の停止後。以後の tryDefer は false)。
+//
+// スレッド安全性:
+//   すべての操作は mutex で守る。解放関数 (Releaser) はロックの外で呼ぶ。Audio Thread からは使わない
+//   (RCU の回収と同じく非 RT スレッド専用)。解放は積んだ順 (FIFO)。
+//   JUCE 非依存 (tests/BulkReleaseQueueTests.cpp から単体で検証する)。
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+namespace convo {
+
+class BulkReleaseQueue
+{
+public:
+    using Releaser = void (*)(void*);
+
+    static constexpr std::uint64_t kDefaultThresholdBytes = 16ull << 20;   // これ未満は回収スレッドでそのまま解放
+    static constexpr std::size_t   kCapacity = 64;
+
+    struct Stats
+    {
+        std::uint64_t deferredCount  = 0;   // tryDefer で受け付けた件数
+        std::uint64_t deferredBytes  = 0;
+        std::uint64_t releasedCount  = 0;   // releaseBatch / detach で解放した件数
+        std::uint64_t releasedBytes  = 0;
+        std::uint64_t batchCount     = 0;   // 1 件以上解放した releaseBatch の回数
+        std::uint64_t fallbackCount  = 0;   // 閾値以上だったが受け手なし・満杯でその場解放に回した件数
+        std::size_t   pendingCount   = 0;
+        std::uint64_t pendingBytes   = 0;
+        int           drainers       = 0;
+    };
+
+    explicit BulkReleaseQueue(std::uint64_t thresholdBytes = kDefaultThresholdBytes) noexcept
+        : thresholdBytes_(thresholdBytes)
+    {
+    }
+
+    ~BulkReleaseQueue()
+    {
+        releaseAll();
+    }
+
+    BulkReleaseQueue(const BulkReleaseQueue&) = delete;
+    BulkReleaseQueue& operator=(const BulkReleaseQueue&) = delete;
+
+    // プロセス共通のキュー (ConvolverProcessor ごとの DeferredFreeThread が受け手として付く)
+    static BulkReleaseQueue& global() noexcept
+    {
+        static BulkReleaseQueue queue;
+        return queue;
+    }
+
+    // 解放を受け手に任せる。false なら呼び出し側がその場で release(ptr) すること
+    [[nodiscard]] bool tryDefer(void* ptr, Releaser release, std::uint64_t bytes) noexcept
+    {
+        if (ptr == nullptr || release == nullptr || bytes < thresholdBytes_)
+            return false;
+
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (drainers_ == 0 || count_ == kCapacity)
+        {
+            ++stats_.fallbackCount;
+            return false;
+        }
+        entries_[(head_ + count_) % kCapacity] = Entry { ptr, release, bytes };
+        ++count_;
+        pendingBytes_ += bytes;
+        ++stats_.deferredCount;
+        stats_.deferredBytes += bytes;
+        return true;
+    }
+
+    void attachDrainer() noexcept
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        ++drainers_;
+    }
+
+    // 受け手のスレッドを止めた後に呼ぶ。最後の受け手なら残りをここで解放する
+    void detachDrainer() noexcept
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            if (drainers_ > 0)
+                --drainers_;
+            if (drainers_ != 0)
+                return;
+        }
+        releaseAll();
+    }
+
+    // 先頭から解放し、合計が byteBudget 以上になった時点で止める (最低 1 件)。戻り値は解放した推定量
+    std::uint64_t releaseBatch(std::uint64_t byteBudget) noexcept
+    {
+        std::uint64_t released = 0;
+        std::uint64_t releasedItems = 0;
+        while (released < byteBudget || releasedItems == 0)
+        {
+            Entry entry;
+            {
+                const std::lock_guard<std::mutex> lock(mutex_);
+                if (count_ == 0)
+                    break;
+                entry = entries_[head_];
+                entries_[head_] = Entry {};
+                head_ = (head_ + 1) % kCapacity;
+                --count_;
+                pendingBytes_ -= entry.bytes;
+            }
+            entry.release(entry.ptr);   // 数十 ms かかり得るのでロックの外
+            released += entry.bytes;
+            ++releasedItems;
+        }
+
+        if (releasedItems > 0)
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            stats_.releasedCount += releasedItems;
+            stats_.releasedBytes += released;
+            ++stats_.batchCount;
+        }
+        return released;
+    }
+
+    void releaseAll() noexcept
+    {
+        (void)releaseBatch(std::numeric_limits<std::uint64_t>::max());
+    }
+
+    [[nodiscard]] Stats snapshotStats() const noexcept
+    {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        Stats s = stats_;
+        s.pendingCount = count_;
+        s.pendingBytes = pendingBytes_;
+        s.drainers = drainers_;
+        return s;
+    }
+
+    [[nodiscard]] std::uint64_t thresholdBytes() const noexcept { return thresholdBytes_; }
+
+private:
+    struct Entry
+    {
+        void* ptr = nullptr;
+        Releaser release = nullptr;
+        std::uint64_t bytes = 0;
+    };
+
+    const std::uint64_t thresholdBytes_;
+    mutable std::mutex mutex_;
+    std::array<Entry, kCapacity> entries_ {};
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    std::uint64_t pendingBytes_ = 0;
+    int drainers_ = 0;
+    Stats stats_ {};
+};
+
+} // namespace convo
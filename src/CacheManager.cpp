@@ -1,13 +1,17 @@
 #include "CacheManager.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstring>
+#include <future>
+#include <thread>
 #include <vector>
 
 #include <mkl.h>
 #include <mkl_cblas.h>
 #include "DiagnosticsConfig.h"
+#include "audioengine/AtomicAccess.h"
 
 namespace
 {
@@ -30,6 +34,209 @@ struct CacheHeaderV1
     uint64_t timeDomainSizeBytes = 0;
 };
 
+struct CacheHeaderV2
+{
+    uint64_t magic = 0x434F4E564F504551ULL;
+    uint64_t version = 2;
+    uint64_t key = 0;
+    uint64_t dataSize = 0;
+    uint64_t checksum = 0;
+    uint64_t timestamp = 0;
+    uint64_t fftSize = 0;
+    uint64_t numPartitions = 0;
+    uint64_t numChannels = 0;
+    double sampleRate = 0.0;
+    uint64_t timeDomainChannels = 0;
+    uint64_t timeDomainNumSamples = 0;
+    uint64_t timeDomainSizeBytes = 0;
+    double scaleFactor = 1.0;
+    uint64_t hasScaleFactor = 0;
+};
+
+struct CacheHeaderV3
+{
+    uint64_t magic = 0x434F4E564F504551ULL;
+    uint64_t version = 3;
+    uint64_t key = 0;
+    uint64_t dataSize = 0;
+    uint64_t checksum = 0;
+    uint64_t timestamp = 0;
+    uint64_t fftSize = 0;
+    uint64_t numPartitions = 0;
+    uint64_t numChannels = 0;
+    double sampleRate = 0.0;
+    uint64_t timeDomainChannels = 0;
+    uint64_t timeDomainNumSamples = 0;
+    uint64_t timeDomainSizeBytes = 0;
+    double scaleFactor = 1.0;
+    uint64_t hasScaleFactor = 0;
+    uint64_t payloadOffset = 0;
+    uint64_t timeDomainOffset = 0;
+};
+
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+//------------------------------------------------------------------------------
+// ★ 圧縮ペイロード (byte-shuffle + deflate)
+//   double の符号/指数バイトはパーティション間で相関が強く、バイトプレーン単位に並べ替えると
+//   zlib でも十分縮む。チャンク独立なので符号化/復号ともチャンク並列で処理する。
+//------------------------------------------------------------------------------
+constexpr size_t kCompressionChunkBytes = static_cast<size_t>(1) << 20;  // 8 の倍数 (double 境界)
+constexpr int kDeflateLevel = 1;  // loadIR 同期経路で save されるため速度優先 (シャッフル後は高レベルとの差が小さい)
+
+void shuffleBytes(const uint8_t* src, uint8_t* dst, size_t size) noexcept
+{
+    const size_t n = size / sizeof(double);
+    for (size_t b = 0; b < sizeof(double); ++b)
+    {
+        uint8_t* plane = dst + b * n;
+        for (size_t i = 0; i < n; ++i)
+            plane[i] = src[i * sizeof(double) + b];
+    }
+    std::memcpy(dst + n * sizeof(double), src + n * sizeof(double), size - n * sizeof(double));
+}
+
+void unshuffleBytes(const uint8_t* src, uint8_t* dst, size_t size) noexcept
+{
+    const size_t n = size / sizeof(double);
+    for (size_t b = 0; b < sizeof(double); ++b)
+    {
+        const uint8_t* plane = src + b * n;
+        for (size_t i = 0; i < n; ++i)
+            dst[i * sizeof(double) + b] = plane[i];
+    }
+    std::memcpy(dst + n * sizeof(double), src + n * sizeof(double), size - n * sizeof(double));
+}
+
+int resolveCodecWorkers(size_t numChunks) noexcept
+{
+    const unsigned hw = std::thread::hardware_concurrency();
+    const size_t workers = (std::max)(1u, hw / 2u);
+    return static_cast<int>((std::min)(workers, numChunks));
+}
+
+// chunks を workers 本の std::async で分担する (atomic index で取り合い)。fn(chunkIndex) が false なら中断
+template <typename Fn>
+bool runChunksParallel(size_t numChunks, Fn&& fn)
+{
+    const int workers = resolveCodecWorkers(numChunks);
+    std::atomic<size_t> next { 0 };
+    std::atomic<bool> failed { false };
+    auto worker = [&]()
+    {
+        for (;;)
+        {
+            const size_t c = next.fetch_add(1, std::memory_order_relaxed);
+            if (c >= numChunks || failed.load(std::memory_order_relaxed))
+                return;
+            if (!fn(c))
+                failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(static_cast<size_t>((std::max)(0, workers - 1)));
+    for (int w = 1; w < workers; ++w)
+        futures.emplace_back(std::async(std::launch::async, worker));
+    worker();  // 呼び出しスレッドも 1 本分担当する
+    for (auto& f : futures)
+        f.get();
+    return !failed.load(std::memory_order_relaxed);
+}
+
+// [uint64 numChunks][uint64 encodedChunkSize × numChunks][chunk data...]
+bool encodeShuffleDeflate(const uint8_t* data, size_t size, juce::MemoryBlock& out)
+{
+    const size_t numChunks = (size + kCompressionChunkBytes - 1) / kCompressionChunkBytes;
+    std::vector<juce::MemoryBlock> encoded(numChunks);
+
+    const bool ok = runChunksParallel(numChunks, [&](size_t c)
+    {
+        const size_t offset = c * kCompressionChunkBytes;
+        const size_t bytes = (std::min)(kCompressionChunkBytes, size - offset);
+        std::vector<uint8_t> shuffled(bytes);
+        shuffleBytes(data + offset, shuffled.data(), bytes);
+
+        juce::MemoryOutputStream sink(encoded[c], false);
+        {
+            juce::GZIPCompressorOutputStream zip(sink, kDeflateLevel);
+            if (!zip.write(shuffled.data(), bytes))
+                return false;
+            zip.flush();
+        }
+        return true;
+    });
+    if (!ok)
+        return false;
+
+    out.reset();
+    const uint64_t count = static_cast<uint64_t>(numChunks);
+    out.append(&count, sizeof(count));
+    for (const auto& chunk : encoded)
+    {
+        const uint64_t chunkSize = static_cast<uint64_t>(chunk.getSize());
+        out.append(&chunkSize, sizeof(chunkSize));
+    }
+    for (const auto& chunk : encoded)
+        out.append(chunk.getData(), chunk.getSize());
+    return true;
+}
+
+// dst (dataSize バイト) へ直接復号する。チャンク表の整合性も検証する
+bool decodeShuffleDeflate(const uint8_t* encoded, size_t encodedSize, uint8_t* dst, size_t dataSize, size_t chunkBytes)
+{
+    if (chunkBytes == 0 || (chunkBytes % sizeof(double)) != 0 || encodedSize < sizeof(uint64_t))
+        return false;
+
+    uint64_t count = 0;
+    std::memcpy(&count, encoded, sizeof(count));
+    const size_t numChunks = (dataSize + chunkBytes - 1) / chunkBytes;
+    const size_t tableBytes = sizeof(uint64_t) * (1 + numChunks);
+    if (count != numChunks || encodedSize < tableBytes)
+        return false;
+
+    std::vector<size_t> chunkOffset(numChunks);
+    std::vector<size_t> chunkSize(numChunks);
+    size_t cursor = tableBytes;
+    for (size_t c = 0; c < numChunks; ++c)
+    {
+        uint64_t sizeBytes = 0;
+        std::memcpy(&sizeBytes, encoded + sizeof(uint64_t) * (1 + c), sizeof(sizeBytes));
+        if (sizeBytes > encodedSize - cursor)
+            return false;
+        chunkOffset[c] = cursor;
+        chunkSize[c] = static_cast<size_t>(sizeBytes);
+        cursor += chunkSize[c];
+    }
+    if (cursor != encodedSize)
+        return false;
+
+    return runChunksParallel(numChunks, [&](size_t c)
+    {
+        const size_t offset = c * chunkBytes;
+        const size_t bytes = (std::min)(chunkBytes, dataSize - offset);
+        std::vector<uint8_t> shuffled(bytes);
+
+        juce::GZIPDecompressorInputStream unzip(new juce::MemoryInputStream(encoded + chunkOffset[c], chunkSize[c], false),
+                                                true,
+                                                juce::GZIPDecompressorInputStream::zlibFormat,
+                                                static_cast<juce::int64>(bytes));
+        size_t got = 0;
+        while (got < bytes)
+        {
+            const int n = unzip.read(shuffled.data() + got, static_cast<int>(bytes - got));
+            if (n <= 0)
+                return false;
+            got += static_cast<size_t>(n);
+        }
+        unshuffleBytes(shuffled.data(), dst + offset, bytes);
+        return true;
+    });
+}
+
 uint64_t crc64Update(uint64_t crc, const uint8_t* data, size_t size)
 {
     for (size_t i = 0; i < size; ++i)
@@ -42,6 +249,17 @@ uint64_t crc64Update(uint64_t crc, const uint8_t* data, size_t size)
 }
 }
 
+size_t CacheManager::headerSizeForVersion(uint64_t version) noexcept
+{
+    switch (version)
+    {
+        case 1:  return sizeof(CacheHeaderV1);
+        case 2:  return sizeof(CacheHeaderV2);
+        case 3:  return sizeof(CacheHeaderV3);
+        default: return sizeof(CacheHeader);
+    }
+}
+
 uint64_t CacheManager::hashCombine(uint64_t seed, uint64_t value)
 {
     return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
@@ -155,11 +373,38 @@ bool CacheManager::validateCacheFile(const juce::File& file, uint64_t expectedKe
         headerOut.timeDomainSizeBytes = headerV1.timeDomainSizeBytes;
         headerOut.scaleFactor = 1.0;
         headerOut.hasScaleFactor = 0;
+        headerOut.payloadOffset = sizeof(CacheHeaderV1);
+        headerOut.timeDomainOffset = sizeof(CacheHeaderV1) + headerV1.dataSize;
     }
     else if (headerV1.version == 2)
     {
+        CacheHeaderV2 headerV2{};
         stream->setPosition(0);
-        if (stream->read(&headerOut, static_cast<int>(sizeof(CacheHeader))) != static_cast<int>(sizeof(CacheHeader)))
+        if (stream->read(&headerV2, static_cast<int>(sizeof(CacheHeaderV2))) != static_cast<int>(sizeof(CacheHeaderV2)))
+            return false;
+        std::memcpy(&headerOut, &headerV2, sizeof(CacheHeaderV2));
+        headerOut.payloadOffset = sizeof(CacheHeaderV2);
+        headerOut.timeDomainOffset = sizeof(CacheHeaderV2) + headerV2.dataSize;
+    }
+    else if (headerV1.version == 3 || headerV1.version == 4)
+    {
+        // v3 は v4 の先頭部分 (圧縮フィールド以前) と同一レイアウト
+        stream->setPosition(0);
+        const int headerBytes = static_cast<int>(headerSizeForVersion(headerV1.version));
+        if (stream->read(&headerOut, headerBytes) != headerBytes)
+            return false;
+        if (headerOut.version == 3)
+        {
+            headerOut.payloadEncoding = CacheHeader::kEncodingRaw;
+            headerOut.encodedSize = 0;
+            headerOut.chunkBytes = 0;
+        }
+        if (headerOut.payloadEncoding != CacheHeader::kEncodingRaw
+            && headerOut.payloadEncoding != CacheHeader::kEncodingShuffleDeflate)
+            return false;
+        if (headerOut.payloadOffset < static_cast<uint64_t>(headerBytes)
+            || (headerOut.payloadOffset % CacheHeader::kPayloadAlignment) != 0
+            || headerOut.timeDomainOffset < headerOut.payloadOffset + headerOut.payloadDiskBytes())
             return false;
     }
     else
@@ -173,24 +418,31 @@ bool CacheManager::validateCacheFile(const juce::File& file, uint64_t expectedKe
     if (static_cast<int>(headerOut.fftSize) != expectedFftSize)
         return false;
 
-    const int64 headerSize = (headerOut.version == 1)
-                           ? static_cast<int64>(sizeof(CacheHeaderV1))
-                           : static_cast<int64>(sizeof(CacheHeader));
-
-    const int64 expectedTotalSize = headerSize
-                                  + static_cast<int64>(headerOut.dataSize)
-                                  + static_cast<int64>(headerOut.timeDomainSizeBytes);
+    int64 expectedTotalSize = 0;
+    if (headerOut.version >= 3)
+    {
+        expectedTotalSize = (headerOut.timeDomainSizeBytes > 0)
+                          ? static_cast<int64>(headerOut.timeDomainOffset + headerOut.timeDomainSizeBytes)
+                          : static_cast<int64>(headerOut.payloadOffset + headerOut.payloadDiskBytes());
+    }
+    else
+    {
+        expectedTotalSize = static_cast<int64>(headerSizeForVersion(headerOut.version))
+                          + static_cast<int64>(headerOut.dataSize)
+                          + static_cast<int64>(headerOut.timeDomainSizeBytes);
+    }
     if (file.getSize() != expectedTotalSize)
         return false;
 
     return true;
 }
 
-double* CacheManager::copyFromMmapToAligned(juce::MemoryMappedFile& mmap, size_t dataSize)
+double* CacheManager::copyFromMmapToAligned(juce::MemoryMappedFile& mmap, size_t offset, size_t dataSize)
 {
-    const auto* src = static_cast<const uint8_t*>(mmap.getData());
-    if (!src)
+    const auto* base = static_cast<const uint8_t*>(mmap.getData());
+    if (!base || mmap.getSize() < offset + dataSize)
         return nullptr;
+    const uint8_t* src = base + offset;
 
     double* dst = static_cast<double*>(DIAG_MKL_MALLOC(dataSize, 64));
     if (!dst)
@@ -211,41 +463,85 @@ double* CacheManager::copyFromMmapToAligned(juce::MemoryMappedFile& mmap, size_t
 
 std::unique_ptr<PreparedIRState> CacheManager::loadPreparedState(uint64_t key, int fftSize, uint64_t generationId)
 {
+    auto miss = [this]() -> std::unique_ptr<PreparedIRState>
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        ++stats.misses;
+        return nullptr;
+    };
+
     CacheHeader header{};
     const auto file = getCacheFile(key, fftSize);
-    if (!validateCacheFile(file, key, fftSize, header))
-        return nullptr;
 
-    juce::MemoryMappedFile mmap(file, juce::MemoryMappedFile::readOnly);
-    const size_t headerSize = (header.version == 1) ? sizeof(CacheHeaderV1) : sizeof(CacheHeader);
-    if (mmap.getSize() <= headerSize)
-        return nullptr;
+    // ★ Prefetch 済みなら検証と CRC を省略 (ページキャッシュも温まっている)
+    auto mmap = findPrefetchedMapping(key, fftSize, file, header);
+    if (mmap == nullptr)
+    {
+        if (!validateCacheFile(file, key, fftSize, header))
+            return miss();
+
+        mmap = std::make_shared<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+        const size_t headerSize = headerSizeForVersion(header.version);
+        if (mmap->getSize() <= headerSize || mmap->getData() == nullptr)
+            return miss();
+
+        // CRC 検証がペイロード全ページに触れるため、以降の初回アクセスのページフォルトも抑制される
+        const auto* mapped = static_cast<const uint8_t*>(mmap->getData());
+        const uint64_t checksum = computeCRC64(mapped + header.payloadOffset, static_cast<size_t>(header.payloadDiskBytes()));
+        if (checksum != header.checksum)
+            return miss();
+    }
 
-    const auto* mapped = static_cast<const uint8_t*>(mmap.getData());
-    if (!mapped)
-        return nullptr;
+    auto prepared = buildPreparedState(header, mmap, key, generationId);
+    if (!prepared)
+        return miss();
 
-    const uint8_t* dataStart = mapped + headerSize;
-    const uint64_t checksum = computeCRC64(dataStart, static_cast<size_t>(header.dataSize));
-    if (checksum != header.checksum)
-        return nullptr;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        ++stats.hits;
+    }
+    touchEntry(key, fftSize, header.rebuildCostMicros > 0 ? static_cast<double>(header.rebuildCostMicros) * 1.0e-3 : -1.0);
+    return prepared;
+}
 
-    double* copied = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(header.dataSize), 64));
-    if (!copied)
-        return nullptr;
+std::unique_ptr<PreparedIRState> CacheManager::buildPreparedState(const CacheHeader& header,
+                                                                  const std::shared_ptr<juce::MemoryMappedFile>& mmap,
+                                                                  uint64_t key,
+                                                                  uint64_t generationId)
+{
+    const auto* mapped = static_cast<const uint8_t*>(mmap->getData());
+    const uint8_t* dataStart = mapped + header.payloadOffset;
 
-    std::memcpy(copied, dataStart, static_cast<size_t>(header.dataSize));
+    auto prepared = std::make_unique<PreparedIRState>();
 
-    // Warm up pages to reduce first-touch faults.
-    constexpr size_t kPage = 4096;
-    volatile uint8_t sink = 0;
-    uint8_t* raw = reinterpret_cast<uint8_t*>(copied);
-    for (size_t i = 0; i < static_cast<size_t>(header.dataSize); i += kPage)
-        sink ^= raw[i];
-    (void)sink;
+    // ★ v3: 64-byte 境界のペイロードは mmap を読み取り専用ビューとして直接参照する (コピーなし)。
+    //   mapping の寿命は PreparedIRState → ConvolverState (RCU) の shared_ptr で保持され、
+    //   旧 state の deferred retire 時に解放される。
+    const bool alignedPayload = (reinterpret_cast<uintptr_t>(dataStart) % CacheHeader::kPayloadAlignment) == 0;
+    if (header.payloadEncoding == CacheHeader::kEncodingShuffleDeflate)
+    {
+        // ★ v4 圧縮: aligned バッファへチャンク並列で直接復号する (mmap は保持しない)
+        const size_t dataSize = static_cast<size_t>(header.dataSize);
+        auto* decoded = static_cast<double*>(DIAG_MKL_MALLOC(dataSize, 64));
+        if (!decoded)
+            return nullptr;
+        prepared->partitionData = decoded;
+        if (!decodeShuffleDeflate(dataStart, static_cast<size_t>(header.encodedSize),
+                                  reinterpret_cast<uint8_t*>(decoded), dataSize, static_cast<size_t>(header.chunkBytes)))
+            return nullptr;
+    }
+    else if (header.version >= 3 && alignedPayload && header.dataSize > 0)
+    {
+        prepared->partitionView = reinterpret_cast<const double*>(dataStart);
+        prepared->mappedStorage = mmap;
+    }
+    else
+    {
+        prepared->partitionData = copyFromMmapToAligned(*mmap, static_cast<size_t>(header.payloadOffset), static_cast<size_t>(header.dataSize));
+        if (!prepared->partitionData)
+            return nullptr;
+    }
 
-    auto prepared = std::make_unique<PreparedIRState>();
-    prepared->partitionData = copied;
     prepared->partitionSizeBytes = static_cast<size_t>(header.dataSize);
     prepared->numPartitions = static_cast<int>(header.numPartitions);
     prepared->fftSize = static_cast<int>(header.fftSize);
@@ -257,9 +553,9 @@ std::unique_ptr<PreparedIRState> CacheManager::loadPreparedState(uint64_t key, i
     // timeDomainIR があれば復元
     if (header.timeDomainSizeBytes > 0 && header.timeDomainChannels > 0 && header.timeDomainNumSamples > 0)
     {
-        const uint8_t* tdStart = dataStart + header.dataSize;
+        const uint8_t* tdStart = mapped + header.timeDomainOffset;
         const size_t expectedTdBytes = static_cast<size_t>(header.timeDomainSizeBytes);
-        if (static_cast<size_t>(mmap.getSize() - headerSize - header.dataSize) >= expectedTdBytes)
+        if (mmap->getSize() >= static_cast<size_t>(header.timeDomainOffset) + expectedTdBytes)
         {
             auto tdBuffer = std::make_unique<juce::AudioBuffer<double>>(
                 static_cast<int>(header.timeDomainChannels),
@@ -323,23 +619,27 @@ std::unique_ptr<PreparedIRState> CacheManager::loadPreparedState(uint64_t key, i
         prepared->hasScaleFactor = (header.hasScaleFactor != 0);
     }
 
-    touch(key, fftSize);
-
     return prepared;
 }
 
-void CacheManager::save(uint64_t key, int fftSize, const PreparedIRState& state)
+void CacheManager::save(uint64_t key, int fftSize, const PreparedIRState& state, double rebuildCostMs)
 {
-    if (!state.partitionData || state.partitionSizeBytes == 0)
+    const double* partitionData = state.getPartitionData();
+    if (!partitionData || state.partitionSizeBytes == 0)
         return;
 
     const auto file = getCacheFile(key, fftSize);
     const auto temp = file.withFileExtension("tmp");
 
+    // 置き換え対象ファイルの mmap を手放す (Windows では mapping 中のファイルを上書きできない)
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        forgetPrefetchedLocked(makeEntryKey(key, fftSize));
+    }
+
     CacheHeader header{};
     header.key = key;
     header.dataSize = static_cast<uint64_t>(state.partitionSizeBytes);
-    header.checksum = computeCRC64(reinterpret_cast<const uint8_t*>(state.partitionData), state.partitionSizeBytes);
     header.timestamp = static_cast<uint64_t>(juce::Time::getCurrentTime().toMilliseconds());
     header.fftSize = static_cast<uint64_t>(fftSize);
     header.numPartitions = static_cast<uint64_t>(state.numPartitions);
@@ -347,7 +647,25 @@ void CacheManager::save(uint64_t key, int fftSize, const PreparedIRState& state)
     header.sampleRate = state.sampleRate;
     header.scaleFactor = state.scaleFactor;
     header.hasScaleFactor = state.hasScaleFactor ? 1ULL : 0ULL;
-    header.version = 2;
+    header.version = 4;
+    header.payloadOffset = alignUp(sizeof(CacheHeader), CacheHeader::kPayloadAlignment);
+    header.rebuildCostMicros = static_cast<uint64_t>(juce::jmax(0.0, rebuildCostMs) * 1000.0);
+
+    // ★ v4: 圧縮有効時はシャッフル + deflate 済みバイト列をペイロードとして書き、CRC もそれに対して取る。
+    //   圧縮が効かない (縮まない) 場合は生ペイロード (kEncodingRaw) で書き、mmap 直接参照を維持する。
+    juce::MemoryBlock encoded;
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(partitionData);
+    if (isPayloadCompressionEnabled()
+        && encodeShuffleDeflate(payload, state.partitionSizeBytes, encoded)
+        && encoded.getSize() < state.partitionSizeBytes)
+    {
+        header.payloadEncoding = CacheHeader::kEncodingShuffleDeflate;
+        header.encodedSize = static_cast<uint64_t>(encoded.getSize());
+        header.chunkBytes = static_cast<uint64_t>(kCompressionChunkBytes);
+        payload = static_cast<const uint8_t*>(encoded.getData());
+    }
+    header.checksum = computeCRC64(payload, static_cast<size_t>(header.payloadDiskBytes()));
+    header.timeDomainOffset = alignUp(header.payloadOffset + header.payloadDiskBytes(), CacheHeader::kPayloadAlignment);
     if (state.timeDomainIR)
     {
         header.timeDomainChannels = static_cast<uint64_t>(state.timeDomainIR->getNumChannels());
@@ -367,10 +685,15 @@ void CacheManager::save(uint64_t key, int fftSize, const PreparedIRState& state)
     if (!out)
         return;
 
-    out->write(&header, static_cast<size_t>(sizeof(CacheHeader)));
-    out->write(state.partitionData, state.partitionSizeBytes);
+    // ★ v3/v4: ヘッダ/ペイロード間をゼロ埋めして各セクションを 64-byte 境界に揃える
+    const uint8_t padding[CacheHeader::kPayloadAlignment] = {};
+    const size_t headerBytes = headerSizeForVersion(header.version);
+    out->write(&header, headerBytes);
+    out->write(padding, static_cast<size_t>(header.payloadOffset - headerBytes));
+    out->write(payload, static_cast<size_t>(header.payloadDiskBytes()));
     if (state.timeDomainIR && header.timeDomainSizeBytes > 0)
     {
+        out->write(padding, static_cast<size_t>(header.timeDomainOffset - header.payloadOffset - header.payloadDiskBytes()));
         const int channels = state.timeDomainIR->getNumChannels();
         const int samples = state.timeDomainIR->getNumSamples();
         for (int ch = 0; ch < channels; ++ch)
@@ -389,37 +712,55 @@ void CacheManager::save(uint64_t key, int fftSize, const PreparedIRState& state)
     if (!temp.moveFileTo(file))
     {
         temp.deleteFile();
+        return;
     }
-    touch(key, fftSize);
+    touchEntry(key, fftSize, juce::jmax(0.0, rebuildCostMs));
 }
 
 void CacheManager::touch(uint64_t key, int fftSize)
+{
+    touchEntry(key, fftSize, -1.0);
+}
+
+void CacheManager::touchEntry(uint64_t key, int fftSize, double rebuildCostMs)
 {
     const uint64_t entryKey = makeEntryKey(key, fftSize);
     const auto file = getCacheFile(key, fftSize);
+    const auto now = juce::Time::getCurrentTime();
+    const uint64_t fileBytes = file.existsAsFile() ? static_cast<uint64_t>(file.getSize()) : 0ULL;
+
+    // 最終アクセス時刻を mtime に残し、次回セッションの索引構築で LRU 順を復元する (失敗しても無害)
+    file.setLastModificationTime(now);
+
     std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureIndexedLocked();
 
     auto it = cacheMap.find(entryKey);
-    const uint64_t nowMs = static_cast<uint64_t>(juce::Time::getCurrentTime().toMilliseconds());
-    if (it != cacheMap.end())
+    if (it == cacheMap.end())
+    {
+        lruList.push_front(entryKey);
+        CacheEntry entry;
+        entry.originalKey = key;
+        entry.fftSize = fftSize;
+        entry.lruPos = lruList.begin();
+        it = cacheMap.emplace(entryKey, std::move(entry)).first;
+    }
+    else
     {
         lruList.erase(it->second.lruPos);
         lruList.push_front(entryKey);
         it->second.lruPos = lruList.begin();
-        it->second.lastAccessTime = nowMs;
-        it->second.file = file;
-        it->second.originalKey = key;
-        return;
     }
 
-    lruList.push_front(entryKey);
-    CacheEntry entry;
+    auto& entry = it->second;
+    diskBytes = diskBytes - (std::min)(diskBytes, entry.fileBytes) + fileBytes;
     entry.file = file;
     entry.originalKey = key;
-    entry.lastAccessTime = nowMs;
-    entry.fftSize = fftSize;
-    entry.lruPos = lruList.begin();
-    cacheMap.emplace(entryKey, std::move(entry));
+    entry.fileBytes = fileBytes;
+    entry.lastAccessTime = static_cast<uint64_t>(now.toMilliseconds());
+    if (rebuildCostMs >= 0.0)
+        entry.rebuildCostMs = rebuildCostMs;
+    entry.priority = computePriorityLocked(entry);
 }
 
 void CacheManager::setSafeDeleteChecker(SafeDeleteFn checker)
@@ -430,6 +771,8 @@ void CacheManager::setSafeDeleteChecker(SafeDeleteFn checker)
 
 void CacheManager::clear()
 {
+    clearPrefetched();
+
     const auto dir = getCacheDirectory();
     if (dir.exists())
         dir.deleteRecursively();
@@ -442,6 +785,9 @@ void CacheManager::clear()
     std::lock_guard<std::mutex> lock(cacheMutex);
     cacheMap.clear();
     lruList.clear();
+    diskBytes = 0;
+    inflation = 0.0;
+    indexed = true;  // ディレクトリは空になったため走査不要
 }
 
 bool CacheManager::isEntrySafeToDelete(uint64_t key, int fftSize)
@@ -455,30 +801,317 @@ bool CacheManager::isEntrySafeToDelete(uint64_t key, int fftSize)
 void CacheManager::evictLRU(size_t maxEntries)
 {
     std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureIndexedLocked();
 
-    while (cacheMap.size() > maxEntries && !lruList.empty())
+    auto overBudget = [this, maxEntries]()
     {
-        bool removed = false;
+        return cacheMap.size() > maxEntries || diskBytes > diskBudget;
+    };
+    if (!overBudget())
+        return;
 
-        for (auto rit = lruList.rbegin(); rit != lruList.rend(); ++rit)
-        {
-            const uint64_t entryKey = *rit;
-            auto it = cacheMap.find(entryKey);
-            if (it == cacheMap.end())
-                continue;
-
-            if (!isEntrySafeToDelete(it->second.originalKey, it->second.fftSize))
-                continue;
-
-            it->second.file.deleteFile();
-            auto erasePos = std::next(rit).base();
-            lruList.erase(erasePos);
-            cacheMap.erase(it);
-            removed = true;
+    // 削除できない (使用中 / mmap 中) エントリは飛ばして次候補へ
+    for (const uint64_t entryKey : buildEvictionOrderLocked())
+    {
+        if (!overBudget())
             break;
+
+        auto it = cacheMap.find(entryKey);
+        if (it == cacheMap.end())
+            continue;
+
+        if (!isEntrySafeToDelete(it->second.originalKey, it->second.fftSize))
+            continue;
+
+        forgetPrefetchedLocked(entryKey);
+
+        // ★ v3: 参照中の mmap があるファイルは OS によって削除できない (Windows) ため次候補へ
+        if (it->second.file.existsAsFile() && !it->second.file.deleteFile())
+            continue;
+
+        if (costWeighted)
+            inflation = (std::max)(inflation, it->second.priority);
+        diskBytes -= (std::min)(diskBytes, it->second.fileBytes);
+        ++stats.evictions;
+        stats.evictedBytes += it->second.fileBytes;
+        lruList.erase(it->second.lruPos);
+        cacheMap.erase(it);
+    }
+}
+
+std::vector<uint64_t> CacheManager::buildEvictionOrderLocked() const
+{
+    // LRU: 末尾 (最古) から。コスト重み付き: 優先度の低い順 (同値は古い順)
+    std::vector<uint64_t> order(lruList.rbegin(), lruList.rend());
+    if (costWeighted)
+    {
+        std::stable_sort(order.begin(), order.end(), [this](uint64_t a, uint64_t b)
+        {
+            return cacheMap.at(a).priority < cacheMap.at(b).priority;
+        });
+    }
+    return order;
+}
+
+double CacheManager::computePriorityLocked(const CacheEntry& entry) const noexcept
+{
+    // 再生成コスト不明 (旧ファイル) はサイズ比例と見なす → 全エントリ同一 H となり LRU と同じ順序
+    constexpr double kMiB = 1024.0 * 1024.0;
+    constexpr double kDefaultCostMsPerMiB = 10.0;
+    const double sizeMiB = (std::max)(static_cast<double>(entry.fileBytes) / kMiB, 1.0 / 1024.0);
+    const double costPerMiB = (entry.rebuildCostMs > 0.0) ? entry.rebuildCostMs / sizeMiB : kDefaultCostMsPerMiB;
+    return inflation + costPerMiB;
+}
+
+void CacheManager::ensureIndexedLocked()
+{
+    if (indexed)
+        return;
+    indexed = true;
+
+    // ファイル名 "<key hex>_<fftSize>.bin" とヘッダ先頭から索引を復元する (mtime 昇順に push_front → front が最新)
+    struct Found
+    {
+        juce::File file;
+        uint64_t key = 0;
+        int fftSize = 0;
+        juce::int64 mtime = 0;
+    };
+    std::vector<Found> found;
+    for (const auto& file : getCacheDirectory().findChildFiles(juce::File::findFiles, false, "*.bin"))
+    {
+        const auto name = file.getFileNameWithoutExtension();
+        const int sep = name.indexOfChar('_');
+        if (sep <= 0)
+            continue;
+        const int fft = name.substring(sep + 1).getIntValue();
+        if (fft <= 0)
+            continue;
+        found.push_back({ file,
+                          static_cast<uint64_t>(name.substring(0, sep).getHexValue64()),
+                          fft,
+                          file.getLastModificationTime().toMilliseconds() });
+    }
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.mtime < b.mtime; });
+
+    for (const auto& f : found)
+    {
+        const uint64_t entryKey = makeEntryKey(f.key, f.fftSize);
+        if (cacheMap.count(entryKey) != 0)
+            continue;
+
+        CacheEntry entry;
+        entry.file = f.file;
+        entry.originalKey = f.key;
+        entry.fftSize = f.fftSize;
+        entry.lastAccessTime = static_cast<uint64_t>(f.mtime);
+        entry.fileBytes = static_cast<uint64_t>(f.file.getSize());
+
+        CacheHeader header{};
+        juce::FileInputStream in(f.file);
+        if (in.openedOk()
+            && in.read(&header, static_cast<int>(sizeof(CacheHeaderV1))) == static_cast<int>(sizeof(CacheHeaderV1))
+            && header.magic == CacheHeader{}.magic
+            && header.version >= 4)
+        {
+            in.setPosition(0);
+            if (in.read(&header, static_cast<int>(sizeof(CacheHeader))) == static_cast<int>(sizeof(CacheHeader)))
+                entry.rebuildCostMs = static_cast<double>(header.rebuildCostMicros) * 1.0e-3;
         }
+        entry.priority = computePriorityLocked(entry);
 
-        if (!removed)
-            break;
+        lruList.push_front(entryKey);
+        entry.lruPos = lruList.begin();
+        diskBytes += entry.fileBytes;
+        cacheMap.emplace(entryKey, std::move(entry));
     }
 }
+
+void CacheManager::setDiskBudgetBytes(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    diskBudget = bytes;
+}
+
+uint64_t CacheManager::getDiskBudgetBytes()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return diskBudget;
+}
+
+void CacheManager::setCostWeightedEviction(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    costWeighted = enabled;
+}
+
+bool CacheManager::isCostWeightedEviction()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return costWeighted;
+}
+
+CacheManager::Stats CacheManager::getStats()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    ensureIndexedLocked();
+    Stats s = stats;
+    s.entries = cacheMap.size();
+    s.diskBytes = diskBytes;
+    s.diskBudgetBytes = diskBudget;
+    s.prefetchedBytes = prefetchBytes;
+    return s;
+}
+
+void CacheManager::resetStats()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+    stats.evictedBytes = 0;
+}
+
+bool CacheManager::prefetch(uint64_t key, int fftSize, const std::function<bool()>& shouldCancel)
+{
+    if (isPrefetched(key, fftSize))
+        return true;
+
+    CacheHeader header{};
+    const auto file = getCacheFile(key, fftSize);
+    if (!validateCacheFile(file, key, fftSize, header))
+        return false;
+
+    const int64 fileSize = file.getSize();
+    if (static_cast<uint64_t>(fileSize) > static_cast<uint64_t>(getPrefetchBudgetBytes()))
+        return false;  // 格納直後に自分自身が追い出されるため
+
+    auto mmap = std::make_shared<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (mmap->getSize() <= headerSizeForVersion(header.version) || mmap->getData() == nullptr)
+        return false;
+
+    // CRC は 1 MiB 単位で計算し、チャンク境界ごとにキャンセルを確認する
+    constexpr size_t kChunkBytes = static_cast<size_t>(1) << 20;
+    const auto* mapped = static_cast<const uint8_t*>(mmap->getData());
+    const uint8_t* dataStart = mapped + header.payloadOffset;
+    const size_t dataSize = static_cast<size_t>(header.payloadDiskBytes());
+    uint64_t checksum = 0ULL;
+    for (size_t offset = 0; offset < dataSize; offset += kChunkBytes)
+    {
+        if (shouldCancel && shouldCancel())
+            return false;
+        checksum = crc64Update(checksum, dataStart + offset, (std::min)(kChunkBytes, dataSize - offset));
+    }
+    if (checksum != header.checksum)
+        return false;
+
+    // 時間領域 IR セクションは CRC 対象外のため、ページ単位で読んでページキャッシュへ載せる
+    const size_t tdOffset = static_cast<size_t>(header.timeDomainOffset);
+    const size_t tdBytes = static_cast<size_t>(header.timeDomainSizeBytes);
+    if (tdBytes > 0 && mmap->getSize() >= tdOffset + tdBytes)
+    {
+        constexpr size_t kPage = 4096;
+        volatile uint8_t sink = 0;
+        for (size_t i = 0; i < tdBytes; i += kPage)
+        {
+            if ((i % kChunkBytes) == 0 && shouldCancel && shouldCancel())
+                return false;
+            sink ^= mapped[tdOffset + i];
+        }
+        (void)sink;
+    }
+
+    const uint64_t entryKey = makeEntryKey(key, fftSize);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    forgetPrefetchedLocked(entryKey);
+
+    prefetchLru.push_front(entryKey);
+    PrefetchedEntry entry;
+    entry.mapping = std::move(mmap);
+    entry.header = header;
+    entry.fileSize = fileSize;
+    entry.lruPos = prefetchLru.begin();
+    prefetchMap.emplace(entryKey, std::move(entry));
+    prefetchBytes += static_cast<size_t>(fileSize);
+    prefetchMemoryCharge.set(prefetchBytes);
+    evictPrefetchedToBudgetLocked();
+    return prefetchMap.find(entryKey) != prefetchMap.end();
+}
+
+bool CacheManager::isPrefetched(uint64_t key, int fftSize)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return prefetchMap.find(makeEntryKey(key, fftSize)) != prefetchMap.end();
+}
+
+void CacheManager::setPrefetchBudgetBytes(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    prefetchBudget = bytes;
+    evictPrefetchedToBudgetLocked();
+}
+
+size_t CacheManager::getPrefetchBudgetBytes()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return prefetchBudget;
+}
+
+void CacheManager::setPayloadCompressionEnabled(bool enabled) noexcept
+{
+    convo::publishAtomic(payloadCompressionEnabled, enabled, std::memory_order_release); // release: save() 側 acquire と HB
+}
+
+bool CacheManager::isPayloadCompressionEnabled() const noexcept
+{
+    return convo::consumeAtomic(payloadCompressionEnabled, std::memory_order_acquire); // acquire: setPayloadCompressionEnabled() の release と HB
+}
+
+void CacheManager::clearPrefetched()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    prefetchMap.clear();
+    prefetchLru.clear();
+    prefetchBytes = 0;
+    prefetchMemoryCharge.set(0);
+}
+
+std::shared_ptr<juce::MemoryMappedFile> CacheManager::findPrefetchedMapping(uint64_t key, int fftSize, const juce::File& file, CacheHeader& headerOut)
+{
+    const uint64_t entryKey = makeEntryKey(key, fftSize);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto it = prefetchMap.find(entryKey);
+    if (it == prefetchMap.end())
+        return nullptr;
+
+    // 事前検証後にファイルが削除・置換されていれば使わない
+    if (!file.existsAsFile() || file.getSize() != it->second.fileSize)
+    {
+        forgetPrefetchedLocked(entryKey);
+        return nullptr;
+    }
+
+    prefetchLru.splice(prefetchLru.begin(), prefetchLru, it->second.lruPos);
+    headerOut = it->second.header;
+    return it->second.mapping;
+}
+
+void CacheManager::forgetPrefetchedLocked(uint64_t entryKey)
+{
+    auto it = prefetchMap.find(entryKey);
+    if (it == prefetchMap.end())
+        return;
+
+    prefetchBytes -= static_cast<size_t>(it->second.fileSize);
+    prefetchMemoryCharge.set(prefetchBytes);
+    prefetchLru.erase(it->second.lruPos);
+    prefetchMap.erase(it);
+}
+
+void CacheManager::evictPrefetchedToBudgetLocked()
+{
+    // 適用中の PreparedIRState が保持する mapping はそのまま有効 (ここでは参照を外すだけ)
+    while (prefetchBytes > prefetchBudget && !prefetchLru.empty())
+        forgetPrefetchedLocked(prefetchLru.back());
+}
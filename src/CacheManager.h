@@ -1,21 +1,24 @@
 #pragma once
 
 #include <memory>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <list>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <functional>
 
 #include <JuceHeader.h>
 
 #include "PreparedIRState.h"
+#include "audioengine/MemoryLedger.h"
 
 struct CacheHeader
 {
     uint64_t magic = 0x434F4E564F504551ULL; // "CONVOPEQ"
-    uint64_t version = 2;
+    uint64_t version = 4;
     uint64_t key = 0;
     uint64_t dataSize = 0;
     uint64_t checksum = 0;
@@ -29,6 +32,28 @@ struct CacheHeader
     uint64_t timeDomainSizeBytes = 0;
     double scaleFactor = 1.0;
     uint64_t hasScaleFactor = 0;
+    // ★ v3: ペイロードはファイル先頭から kPayloadAlignment 境界に配置 (mmap をそのまま参照可能)
+    uint64_t payloadOffset = 0;
+    uint64_t timeDomainOffset = 0;
+    // ★ v4: ペイロード符号化。kEncodingShuffleDeflate では payloadOffset から encodedSize バイトが
+    //   [uint64 チャンク数][uint64 チャンク符号長 × N][符号データ...] で、各チャンクは chunkBytes
+    //   (最終チャンクは端数) の生データを 8 バイトプレーンへシャッフルして zlib 圧縮したもの (可逆)。
+    //   checksum はディスク上のペイロード (符号化時は encodedSize バイト) に対する CRC。
+    uint64_t payloadEncoding = 0;
+    uint64_t encodedSize = 0;
+    uint64_t chunkBytes = 0;
+    // ★ v4: 生成 (IR 変換) に要した時間 [us]。コスト重み付き退避の重みに用いる (0 = 不明)
+    uint64_t rebuildCostMicros = 0;
+
+    static constexpr uint64_t kPayloadAlignment = 64;
+    static constexpr uint64_t kEncodingRaw = 0;
+    static constexpr uint64_t kEncodingShuffleDeflate = 1;
+
+    /** ディスク上のペイロードバイト数 (生データなら dataSize)。 */
+    uint64_t payloadDiskBytes() const noexcept
+    {
+        return (payloadEncoding == kEncodingShuffleDeflate) ? encodedSize : dataSize;
+    }
 };
 
 class CacheManager
@@ -36,6 +61,9 @@ class CacheManager
 public:
     using SafeDeleteFn = std::function<bool(uint64_t, int)>;
 
+    // ファイル内容の CRC64 (computeKey の種。IRLibraryIndex もエントリのキーに使う)
+    static uint64_t computeFileContentCRC(const juce::File& file);
+
     static uint64_t computeKey(const juce::File& file,
                                int fftSize,
                                double sampleRate,
@@ -43,13 +71,56 @@ public:
                                int partitionSize);
 
     std::unique_ptr<PreparedIRState> loadPreparedState(uint64_t key, int fftSize, uint64_t generationId);
-    void save(uint64_t key, int fftSize, const PreparedIRState& state);
+    // rebuildCostMs: state の生成に要した時間 (コスト重み付き退避用。不明なら 0)
+    void save(uint64_t key, int fftSize, const PreparedIRState& state, double rebuildCostMs = 0.0);
     void touch(uint64_t key, int fftSize);
     void setSafeDeleteChecker(SafeDeleteFn checker);
 
     void clear();
+    // ★ エントリ数が maxEntries 以下、かつディスク使用量が setDiskBudgetBytes 以下になるまで退避する。
+    //   索引は初回使用時にキャッシュディレクトリを走査して構築する (前回セッションのファイルも対象)。
     void evictLRU(size_t maxEntries = 10);
 
+    // ★ Byte budget: キャッシュファイル合計サイズの上限。メモリ側 (mmap 保持) は setPrefetchBudgetBytes で別管理
+    static constexpr uint64_t kDefaultDiskBudgetBytes = static_cast<uint64_t>(2) * 1024 * 1024 * 1024;
+    void setDiskBudgetBytes(uint64_t bytes);
+    [[nodiscard]] uint64_t getDiskBudgetBytes();
+    // ★ コスト重み付き退避 (GreedyDual-Size): 優先度 = inflation + 再生成コスト / サイズ。
+    //   最小優先度のエントリから退避し、inflation をその値へ引き上げる (古いエントリも最終的に退避される)。
+    //   false なら純粋な LRU。
+    void setCostWeightedEviction(bool enabled);
+    [[nodiscard]] bool isCostWeightedEviction();
+
+    struct Stats
+    {
+        uint64_t hits = 0;           // loadPreparedState 成功
+        uint64_t misses = 0;         // loadPreparedState 失敗 (無し / 破損)
+        uint64_t evictions = 0;
+        uint64_t evictedBytes = 0;
+        size_t entries = 0;
+        uint64_t diskBytes = 0;
+        uint64_t diskBudgetBytes = 0;
+        size_t prefetchedBytes = 0;  // mmap 保持中のファイルサイズ合計
+    };
+    [[nodiscard]] Stats getStats();
+    void resetStats();
+
+    // ★ 圧縮ペイロード: true なら save() が分割スペクトルを byte-shuffle + deflate で書き出す。
+    //   読み込みは設定に関係なく raw / 圧縮の両形式に対応する。
+    void setPayloadCompressionEnabled(bool enabled) noexcept;
+    [[nodiscard]] bool isPayloadCompressionEnabled() const noexcept;
+
+    // ★ Prefetch: キャッシュファイルを事前検証 (ヘッダ + CRC) して mmap を保持する。
+    //   CRC 計算がペイロード全ページに触れるため OS ページキャッシュも温まる。
+    //   以降の loadPreparedState は検証と CRC を省略して保持中の mmap から構築する。
+    //   保持量はファイルサイズ合計 (setPrefetchBudgetBytes) で上限を設け、超過分は LRU で手放す。
+    static constexpr size_t kDefaultPrefetchBudgetBytes = static_cast<size_t>(512) * 1024 * 1024;
+    bool prefetch(uint64_t key, int fftSize, const std::function<bool()>& shouldCancel);
+    [[nodiscard]] bool isPrefetched(uint64_t key, int fftSize);
+    void setPrefetchBudgetBytes(size_t bytes);
+    [[nodiscard]] size_t getPrefetchBudgetBytes();
+    void clearPrefetched();
+
 private:
     struct CacheEntry
     {
@@ -57,15 +128,18 @@ private:
         uint64_t originalKey = 0;
         uint64_t lastAccessTime = 0;
         int fftSize = 0;
+        uint64_t fileBytes = 0;
+        double rebuildCostMs = 0.0;
+        double priority = 0.0;  // GreedyDual-Size の H 値
         std::list<uint64_t>::iterator lruPos;
     };
 
-    static uint64_t computeFileContentCRC(const juce::File& file);
     static uint64_t computeCRC64(const uint8_t* data, size_t size);
     static uint64_t hashCombine(uint64_t seed, uint64_t value);
     static uint64_t makeEntryKey(uint64_t key, int fftSize);
 
-    double* copyFromMmapToAligned(juce::MemoryMappedFile& mmap, size_t dataSize);
+    double* copyFromMmapToAligned(juce::MemoryMappedFile& mmap, size_t offset, size_t dataSize);
+    static size_t headerSizeForVersion(uint64_t version) noexcept;
 
     juce::File getCacheDirectory() const;
     juce::File getCacheFile(uint64_t key, int fftSize) const;
@@ -73,8 +147,44 @@ private:
 
     bool isEntrySafeToDelete(uint64_t key, int fftSize);
 
+    void touchEntry(uint64_t key, int fftSize, double rebuildCostMs);  // rebuildCostMs < 0: 既存値を維持
+    void ensureIndexedLocked();
+    double computePriorityLocked(const CacheEntry& entry) const noexcept;
+    std::vector<uint64_t> buildEvictionOrderLocked() const;
+
+    struct PrefetchedEntry
+    {
+        std::shared_ptr<juce::MemoryMappedFile> mapping;
+        CacheHeader header{};
+        int64 fileSize = 0;
+        std::list<uint64_t>::iterator lruPos;
+    };
+
+    std::unique_ptr<PreparedIRState> buildPreparedState(const CacheHeader& header,
+                                                        const std::shared_ptr<juce::MemoryMappedFile>& mmap,
+                                                        uint64_t key,
+                                                        uint64_t generationId);
+    std::shared_ptr<juce::MemoryMappedFile> findPrefetchedMapping(uint64_t key, int fftSize, const juce::File& file, CacheHeader& headerOut);
+    void forgetPrefetchedLocked(uint64_t entryKey);
+    void evictPrefetchedToBudgetLocked();
+
     std::unordered_map<uint64_t, CacheEntry> cacheMap;
     std::list<uint64_t> lruList;
     std::mutex cacheMutex;
     SafeDeleteFn safeDeleteChecker;
+
+    std::unordered_map<uint64_t, PrefetchedEntry> prefetchMap;  // cacheMutex で保護
+    std::list<uint64_t> prefetchLru;                            // front = 最近使用
+    size_t prefetchBytes = 0;
+    size_t prefetchBudget = kDefaultPrefetchBudgetBytes;
+    convo::MemoryCharge prefetchMemoryCharge { convo::MemoryCategory::PrefetchedIrFiles };  // = prefetchBytes
+    std::atomic<bool> payloadCompressionEnabled { false };
+
+    // 以下 cacheMutex で保護
+    bool indexed = false;
+    uint64_t diskBytes = 0;
+    uint64_t diskBudget = kDefaultDiskBudgetBytes;
+    bool costWeighted = false;
+    double inflation = 0.0;
+    Stats stats;
 };
@@ -0,0 +1,93 @@
+#include "CachePrefetchThread.h"
+
+#include "CacheManager.h"
+#include "ConvolverProcessor.h"
+#include "core/ThreadAffinityManager.h"
+
+#include "audioengine/AtomicAccess.h"
+
+CachePrefetchThread::CachePrefetchThread(ConvolverProcessor& p,
+                                         CacheManager& cache,
+                                         std::vector<juce::File> files,
+                                         double rate,
+                                         int targetFFT,
+                                         int phase,
+                                         uint64_t baseGeneration,
+                                         ThreadAffinityManager* affinityMgr)
+    : juce::Thread("ConvolverCachePrefetch"),
+      processor(p),
+      cacheManager(cache),
+      recentFiles(std::move(files)),
+      sampleRate(rate),
+      targetFFTSize(targetFFT),
+      phaseMode(phase),
+      taskGeneration(baseGeneration),
+      affinityManager(affinityMgr)
+{
+}
+
+CachePrefetchThread::~CachePrefetchThread()
+{
+    cancel();
+    stopThread(2000);
+}
+
+void CachePrefetchThread::cancel()
+{
+    convo::publishAtomic(cancelled, true, std::memory_order_release); // release: run 側 checkAndCancel の acquire と HB
+    signalThreadShouldExit();
+}
+
+bool CachePrefetchThread::checkAndCancel()
+{
+    // 着手後に IR ロード/リビルドが始まったら譲る (ユーザー操作・デバイス変更を優先)
+    if (threadShouldExit()
+        || convo::consumeAtomic(cancelled, std::memory_order_acquire) // acquire: cancel() の release と HB
+        || !processor.isConvolverGenerationCurrent(taskGeneration)
+        || (started && processor.isLoadingIR()))
+    {
+        convo::publishAtomic(cancelled, true, std::memory_order_release); // release: 以降の checkAndCancel acquire と HB
+        return true;
+    }
+    return false;
+}
+
+void CachePrefetchThread::run()
+{
+    if (affinityManager != nullptr)
+        affinityManager->applyCurrentThreadPolicy(ThreadType::HeavyBackground);
+
+    setPriority(Priority::background);
+
+    // 本ロード (現在 IR) の完了を待ってから着手する
+    while (processor.isLoadingIR())
+    {
+        if (checkAndCancel())
+            return;
+        wait(50);
+    }
+    started = true;
+
+    static constexpr int kLowResFFTSize = 512;  // loadIR の低解像度 FFT と一致
+    const auto shouldCancel = [this]() { return checkAndCancel(); };
+
+    for (const auto& file : recentFiles)
+    {
+        if (checkAndCancel())
+            return;
+        if (!file.existsAsFile())
+            continue;
+
+        const uint64_t targetKey = CacheManager::computeKey(file, targetFFTSize, sampleRate, phaseMode, targetFFTSize);
+        if (cacheManager.prefetch(targetKey, targetFFTSize, shouldCancel))
+            continue;
+        if (checkAndCancel())
+            return;
+
+        if (targetFFTSize != kLowResFFTSize)
+        {
+            const uint64_t lowResKey = CacheManager::computeKey(file, kLowResFFTSize, sampleRate, phaseMode, kLowResFFTSize);
+            cacheManager.prefetch(lowResKey, kLowResFFTSize, shouldCancel);
+        }
+    }
+}
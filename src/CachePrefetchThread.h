@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <JuceHeader.h>
+
+class CacheManager;
+class ConvolverProcessor;
+class ThreadAffinityManager;
+
+/**
+    CachePrefetchThread: 最近使用した IR のキャッシュ事前検証スレッド。
+
+    UI 側 ConvolverProcessor がロード完了後 / レート変更後に起動する。recentFiles の各 IR について
+    loadIR と同じキー (現在レート・目標 FFT サイズ、無ければ低解像度 FFT) を計算し、
+    CacheManager::prefetch で mmap とページキャッシュを温める。変換は行わない (キャッシュ済みのみ)。
+    新しい IR ロード (世代更新)・IR ロード/リビルドの開始・cancel() で直ちに打ち切る。
+*/
+class CachePrefetchThread : public juce::Thread
+{
+public:
+    CachePrefetchThread(ConvolverProcessor& processor,
+                        CacheManager& cacheManager,
+                        std::vector<juce::File> recentFiles,
+                        double sampleRate,
+                        int targetFFTSize,
+                        int phaseMode,
+                        uint64_t baseGeneration,
+                        ThreadAffinityManager* affinityManager);
+
+    ~CachePrefetchThread() override;
+
+    void run() override;
+    void cancel();
+
+private:
+    bool checkAndCancel();
+
+    ConvolverProcessor& processor;
+    CacheManager& cacheManager;
+    std::vector<juce::File> recentFiles;
+    double sampleRate = 0.0;
+    int targetFFTSize = 0;
+    int phaseMode = 0;
+    uint64_t taskGeneration = 0;
+    std::atomic<bool> cancelled { false };
+    bool started = false;  // run() 内のみ
+    ThreadAffinityManager* affinityManager = nullptr;
+};
@@ -7,6 +7,7 @@
 #include <random>
 
 #include "AlignedAllocation.h"
+#include "CmaEsSampling.h"
 
 class CmaEsOptimizer
 {
@@ -14,12 +15,15 @@ public:
     static constexpr int kDim = 9;
     static constexpr int kPopulation = 18;
     static constexpr int kElite = 6;
+    static_assert(kElite <= kPopulation / 2, "mirrored sampling selects elites from pair winners only");
 
     struct Params {
         double sigmaMin     = 0.03;
         double sigmaMax     = 0.30;
         double covRetentionTarget = 0.92;
         double covRetentionStep   = 0.0;
+        bool mirroredSampling     = false;  // z / −z の組。update() は組の勝ち側から kElite を選ぶ
+        bool quasiRandomSampling  = false;  // 組の元をランダムシフト R_d 列から引く
     };
 
     CmaEsOptimizer()
@@ -45,6 +49,8 @@ public:
         params = p;
     }
 
+    [[nodiscard]] const Params& getParams() const noexcept { return params; }
+
     void serializeCovUpperTriangle(double* out45) const noexcept
     {
         int idx = 0;
@@ -99,19 +105,37 @@ public:
         resetIdentityCovariance();
     }
 
+    // 別バンクの学習済み分布から始める (warm start)。inCov45 == nullptr なら共分散は単位行列
+    void initFromDistribution(const double* inMean9, const double* inCov45, double inSigma) noexcept
+    {
+        std::copy(inMean9, inMean9 + kDim, mean);
+        if (inCov45 != nullptr)
+            deserializeCovUpperTriangle(inCov45);
+        else
+            resetIdentityCovariance();
+
+        sigma = std::clamp(inSigma, params.sigmaMin, params.sigmaMax);
+        covRetentionCurrent = params.covRetentionTarget;
+    }
+
     void sample(double candidates[kPopulation][kDim])
     {
         double lowerTriangular[kDim][kDim] = {};
         computeCholesky(lowerTriangular);
 
         std::normal_distribution<double> normalDist(0.0, 1.0);
+        const bool shapedDraw = params.mirroredSampling || params.quasiRandomSampling;
+        double shapedNormals[kPopulation][kDim] = {};
+        if (shapedDraw)
+            convo::cmaes::drawStandardNormals(&shapedNormals[0][0], kPopulation, kDim, params.mirroredSampling,
+                                              params.quasiRandomSampling ? &quasi : nullptr, rng);
 
         for (int populationIndex = 0; populationIndex < kPopulation; ++populationIndex)
         {
             double z[kDim] = {};
 
             for (int dim = 0; dim < kDim; ++dim)
-                z[dim] = normalDist(rng);
+                z[dim] = shapedDraw ? shapedNormals[populationIndex][dim] : normalDist(rng);
 
             for (int dim = 0; dim < kDim; ++dim)
             {
@@ -136,6 +160,11 @@ public:
         std::sort(std::begin(sortedIndices), std::end(sortedIndices),
                   [&fitness](int lhs, int rhs) { return fitness[lhs] < fitness[rhs]; });
 
+        // mirrored: 組の負け側を後ろへ回し、エリートは勝ち側 (kPopulation / 2 ≥ kElite) から選ぶ
+        if (params.mirroredSampling)
+            std::stable_partition(std::begin(sortedIndices), std::end(sortedIndices),
+                                  [&fitness](int index) { return !convo::cmaes::isMirroredPairLoser(fitness, index, kPopulation); });
+
         double oldMean[kDim] = {};
         for (int dim = 0; dim < kDim; ++dim)
             oldMean[dim] = mean[dim];
@@ -241,4 +270,5 @@ private:
     double covRetentionCurrent = 0.92;
     Params params;
     std::mt19937 rng;
+    convo::cmaes::QuasiNormalGenerator quasi { kDim };
 };
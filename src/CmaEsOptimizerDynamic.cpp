@@ -1,4 +1,5 @@
 #include "CmaEsOptimizerDynamic.h"
+#include <mkl_cblas.h>
 #include <cmath>
 #include <numeric>
 #include <random>
@@ -34,6 +35,8 @@ CmaEsOptimizerDynamic::CmaEsOptimizerDynamic(int dimension)
     mean.resize(dim, 0.0);
     const auto dimSquared = squareSize(dim);
     covariance.resize(dimSquared, 0.0);
+    lowerTriangular.resize(dimSquared, 0.0);
+    oldMean.resize(dim, 0.0);
     resetIdentityCovariance();
     std::random_device rd;
     rng.seed(rd());
@@ -45,9 +48,9 @@ void CmaEsOptimizerDynamic::resetIdentityCovariance() {
         covariance[matrixIndex(i, i, dim)] = 1.0;
 }
 
-void CmaEsOptimizerDynamic::computeCholesky(std::vector<double>& lowerTriangular) const {
-    const auto dimSquared = squareSize(dim);
-    lowerTriangular.assign(dimSquared, 0.0);
+void CmaEsOptimizerDynamic::computeCholesky() {
+    // 上三角は 0 のまま残す（sample の dgemm が L 全体を参照するため）
+    std::fill(lowerTriangular.begin(), lowerTriangular.end(), 0.0);
     for (int row = 0; row < dim; ++row) {
         for (int col = 0; col <= row; ++col) {
             double sum = covariance[matrixIndex(row, col, dim)];
@@ -61,6 +64,33 @@ void CmaEsOptimizerDynamic::computeCholesky(std::vector<double>& lowerTriangular
     }
 }
 
+void CmaEsOptimizerDynamic::reserve(int lambda) {
+    if (lambda <= 0)
+        return;
+    const auto populationSize = toSize(lambda) * toSize(dim);
+    if (normals.size() < populationSize) {
+        normals.resize(populationSize);
+        eliteRows.resize(populationSize);
+    }
+    if (weights.size() < toSize(lambda))
+        weights.resize(toSize(lambda));
+    rankIndices.reserve(toSize(lambda));
+}
+
+void CmaEsOptimizerDynamic::prepareWeights(int mu) {
+    if (weightsForMu == mu)
+        return;
+
+    // 重み（対数減少）
+    double sumWeights = 0.0;
+    for (int i = 0; i < mu; ++i) {
+        weights[toSize(i)] = std::log(double(mu) + 0.5) - std::log(double(i) + 1.0);
+        sumWeights += weights[toSize(i)];
+    }
+    for (int i = 0; i < mu; ++i) weights[toSize(i)] /= sumWeights;
+    weightsForMu = mu;
+}
+
 void CmaEsOptimizerDynamic::initFromParcor(const double* initialMean) {
     for (int i = 0; i < dim; ++i)
         mean[i] = initialMean[i];
@@ -69,44 +99,62 @@ void CmaEsOptimizerDynamic::initFromParcor(const double* initialMean) {
     resetIdentityCovariance();
 }
 
-void CmaEsOptimizerDynamic::sample(std::vector<std::vector<double>>& candidates) {
-    std::vector<double> lowerTriangular;
-    computeCholesky(lowerTriangular);
-    std::normal_distribution<double> normalDist(0.0, 1.0);
-
-    for (auto& candidate : candidates) {
-        std::vector<double> z(dim);
-        for (int d = 0; d < dim; ++d) z[d] = normalDist(rng);
-        for (int d = 0; d < dim; ++d) {
-            double correlated = 0.0;
-            for (int j = 0; j <= d; ++j)
-                correlated += lowerTriangular[matrixIndex(d, j, dim)] * z[j];
-            candidate[d] = sanitize(mean[d] + sigma * correlated);
-        }
+void CmaEsOptimizerDynamic::sample(double* population, int lambda) {
+    if (population == nullptr || lambda <= 0)
+        return;
+
+    reserve(lambda);
+    computeCholesky();
+
+    const auto populationSize = toSize(lambda) * toSize(dim);
+    if (params.mirroredSampling || params.quasiRandomSampling) {
+        convo::cmaes::drawStandardNormals(normals.data(), lambda, dim, params.mirroredSampling,
+                                          params.quasiRandomSampling ? &quasi : nullptr, rng);
+    } else {
+        // 乱数は個体順・次元順に引く（旧 vector<vector> 実装と同じ系列）
+        std::normal_distribution<double> normalDist(0.0, 1.0);
+        for (std::size_t i = 0; i < populationSize; ++i)
+            normals[i] = normalDist(rng);
     }
+
+    for (int k = 0; k < lambda; ++k)
+        std::copy(mean.begin(), mean.end(), population + matrixIndex(k, 0, dim));
+
+    // population = mean + sigma · Z · Lᵀ
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans,
+                lambda, dim, dim,
+                sigma, normals.data(), dim,
+                lowerTriangular.data(), dim,
+                1.0, population, dim);
+
+    for (std::size_t i = 0; i < populationSize; ++i)
+        population[i] = sanitize(population[i]);
 }
 
-void CmaEsOptimizerDynamic::update(const std::vector<std::vector<double>>& candidates,
-                                   const std::vector<double>& fitness) {
-    const int lambda = static_cast<int>(candidates.size());
-    const int mu = lambda / 2;
+void CmaEsOptimizerDynamic::update(const double* population, int lambda, const double* fitness) {
+    // mirrored では組の負け側を選抜対象から外す (選べるのは約半数)
+    const int selectable = params.mirroredSampling ? (lambda + 1) / 2 : lambda;
+    const int mu = selectable / 2;
 
-    if (lambda <= 0 || static_cast<int>(fitness.size()) < lambda || mu <= 0)
+    if (population == nullptr || fitness == nullptr || lambda <= 0 || mu <= 0)
         return;
 
+    reserve(lambda);
     covRetentionCurrent = std::min(params.covRetentionTarget,
                                    covRetentionCurrent + params.covRetentionStep);
 
-    // ランキング（非有限値は除外）
-    std::vector<int> indices;
-    indices.reserve(lambda);
+    // ランキング（非有限値と mirrored 組の負け側は除外）
+    rankIndices.clear();
     for (int i = 0; i < lambda; ++i) {
-        if (std::isfinite(fitness[i]))
-            indices.push_back(i);
+        if (!std::isfinite(fitness[i]))
+            continue;
+        if (params.mirroredSampling && convo::cmaes::isMirroredPairLoser(fitness, i, lambda))
+            continue;
+        rankIndices.push_back(i);
     }
 
     // NaN/Inf 汚染時: 共分散とシグマを安全に再初期化して世代更新をスキップ
-    if (static_cast<int>(indices.size()) < mu) {
+    if (static_cast<int>(rankIndices.size()) < mu) {
         resetIdentityCovariance();
         const double sigmaReset = std::clamp(std::max(params.sigmaMin * 4.0, 0.12),
                                              params.sigmaMin,
@@ -116,47 +164,45 @@ void CmaEsOptimizerDynamic::update(const std::vector<std::vector<double>>& candi
         return;
     }
 
-    std::sort(indices.begin(), indices.end(),
+    std::sort(rankIndices.begin(), rankIndices.end(),
               [&](int a, int b) { return fitness[a] < fitness[b]; });
 
-    // 重み（対数減少）
-    std::vector<double> weights(mu);
-    double sumWeights = 0.0;
+    prepareWeights(mu);
+    std::copy(mean.begin(), mean.end(), oldMean.begin());
+
+    // エリートを連続領域へ集め、平均 = Eᵀ · w
     for (int i = 0; i < mu; ++i) {
-        weights[i] = std::log(double(mu) + 0.5) - std::log(double(i) + 1.0);
-        sumWeights += weights[i];
+        const double* candidate = population + matrixIndex(rankIndices[toSize(i)], 0, dim);
+        std::copy(candidate, candidate + dim, eliteRows.data() + matrixIndex(i, 0, dim));
     }
-    for (int i = 0; i < mu; ++i) weights[i] /= sumWeights;
+    cblas_dgemv(CblasRowMajor, CblasTrans, mu, dim,
+                1.0, eliteRows.data(), dim,
+                weights.data(), 1,
+                0.0, mean.data(), 1);
 
-    std::vector<double> oldMean = mean;
-    std::fill(mean.begin(), mean.end(), 0.0);
+    // 共分散更新: C ← r·C + (1 − r)·Σ w_i y_i y_iᵀ,  y_i = (x_i − m_old) / σ
+    //   行 i を √w_i · y_i にしておけば右辺第 2 項は Yᵀ·Y (dsyrk、上三角のみ計算)
+    const double invSigma = 1.0 / sigma;
     for (int i = 0; i < mu; ++i) {
-        const auto& candidate = candidates[indices[i]];
+        const double scale = std::sqrt(weights[toSize(i)]) * invSigma;
+        double* row = eliteRows.data() + matrixIndex(i, 0, dim);
         for (int d = 0; d < dim; ++d)
-            mean[d] += weights[i] * candidate[d];
+            row[d] = (row[d] - oldMean[toSize(d)]) * scale;
     }
+    cblas_dsyrk(CblasRowMajor, CblasUpper, CblasTrans, dim, mu,
+                1.0 - covRetentionCurrent, eliteRows.data(), dim,
+                covRetentionCurrent, covariance.data(), dim);
 
-    // 共分散更新
+    // 上三角を下三角へ写し、正定値性を維持（対角に微小値を加算）
     for (int row = 0; row < dim; ++row) {
-        for (int col = 0; col < dim; ++col) {
-            double eliteCov = 0.0;
-            for (int i = 0; i < mu; ++i) {
-                const auto& candidate = candidates[indices[i]];
-                double yRow = (candidate[row] - oldMean[row]) / sigma;
-                double yCol = (candidate[col] - oldMean[col]) / sigma;
-                eliteCov += weights[i] * yRow * yCol;
-            }
-            covariance[matrixIndex(row, col, dim)] = sanitize(
-                covRetentionCurrent * covariance[matrixIndex(row, col, dim)] +
-                (1.0 - covRetentionCurrent) * eliteCov
-            );
+        for (int col = row; col < dim; ++col) {
+            const double value = sanitize(covariance[matrixIndex(row, col, dim)]);
+            covariance[matrixIndex(row, col, dim)] = value;
+            covariance[matrixIndex(col, row, dim)] = value;
         }
+        covariance[matrixIndex(row, row, dim)] += 1e-9;
     }
 
-    // 共分散の正定値性を維持（対角に微小値を加算）
-    for (int i = 0; i < dim; ++i)
-        covariance[matrixIndex(i, i, dim)] += 1e-9;
-
     // step-size 適応（次元スケーリング対応版）
     // cs は Hansen (2016) 推奨の次元依存値。大きな dim でも安定して機能する。
     double stepNorm = 0.0;
@@ -173,6 +219,31 @@ void CmaEsOptimizerDynamic::update(const std::vector<std::vector<double>>& candi
     sigma = std::clamp(sigma, params.sigmaMin, params.sigmaMax);
 }
 
+void CmaEsOptimizerDynamic::sample(std::vector<std::vector<double>>& candidates) {
+    const int lambda = static_cast<int>(candidates.size());
+    if (lambda <= 0)
+        return;
+
+    flatPopulation.resize(toSize(lambda) * toSize(dim));
+    sample(flatPopulation.data(), lambda);
+    for (int k = 0; k < lambda; ++k) {
+        const double* row = flatPopulation.data() + matrixIndex(k, 0, dim);
+        candidates[toSize(k)].assign(row, row + dim);
+    }
+}
+
+void CmaEsOptimizerDynamic::update(const std::vector<std::vector<double>>& candidates,
+                                   const std::vector<double>& fitness) {
+    const int lambda = static_cast<int>(candidates.size());
+    if (lambda <= 0 || static_cast<int>(fitness.size()) < lambda)
+        return;
+
+    flatPopulation.resize(toSize(lambda) * toSize(dim));
+    for (int k = 0; k < lambda; ++k)
+        std::copy_n(candidates[toSize(k)].begin(), dim, flatPopulation.data() + matrixIndex(k, 0, dim));
+    update(flatPopulation.data(), lambda, fitness.data());
+}
+
 void CmaEsOptimizerDynamic::serializeTo(double* outMean, double* outCov, double& outSigma) const {
     if (outMean) std::copy(mean.begin(), mean.end(), outMean);
     if (outCov) {
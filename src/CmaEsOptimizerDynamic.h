@@ -6,10 +6,21 @@
 #include <cmath>
 #include <numeric>
 
+#include "AlignedAllocation.h"
+#include "CmaEsSampling.h"
+
 //==============================================================================
 /**
     CmaEsOptimizerDynamic: 可変次元対応の簡易 CMA-ES オプティマイザ
     Phase 3 の全通過フィルタ最適化の基盤となる。
+
+    ★ 集団は行優先の連続配列 (lambda × dim, 行ストライド dim) で受け渡す。
+      サンプリングは Z·Lᵀ を dgemm 1 回、共分散のランク μ 更新は重み付きエリート偏差の
+      dsyrk 1 回で行い、作業領域はメンバに保持して世代ごとのヒープ確保をなくす
+      (lambda が増えたときだけ再確保)。vector<vector> 版は互換用の薄いラッパー。
+    ★ Params::mirroredSampling / quasiRandomSampling で z の引き方を切り替える (CmaEsSampling.h)。
+      mirrored では update() が組の負け側を選抜から外し、μ = (勝ち側の数) / 2 で重み付けする。
+      update() の lambda は sample() より少なくてよい (世代途中で評価を打ち切った場合、先頭 lambda 行だけ使う)
 */
 class CmaEsOptimizerDynamic {
 public:
@@ -18,16 +29,29 @@ public:
         double sigmaMax = 0.30;
         double covRetentionTarget = 0.92;
         double covRetentionStep = 0.0;
+        bool mirroredSampling = false;     // z / −z の組で引き、組の良い方だけを選抜する
+        bool quasiRandomSampling = false;  // 組の元をランダムシフト R_d 列から引く
     };
 
     explicit CmaEsOptimizerDynamic(int dimension);
     ~CmaEsOptimizerDynamic() = default;
 
-    void setParams(const Params& p) noexcept { params = p; }
+    void setParams(const Params& p)
+    {
+        params = p;
+        if (p.quasiRandomSampling && quasi.getDimension() != dim)
+            quasi.setDimension(dim);   // α の計算と確保は有効化したときだけ
+    }
     void setSeed(uint64_t seed) { rng.seed(static_cast<std::mt19937::result_type>(seed)); }
     /** 初期σを外部から設定する（initFromParcor() の後に呼ぶこと） */
     void setSigma(double s) noexcept { sigma = s; }
     void initFromParcor(const double* initialMean);
+    int getDimension() const noexcept { return dim; }
+    /** 作業領域を lambda 個体分まで先に確保する（以降の sample/update は確保なし） */
+    void reserve(int lambda);
+    /** population: lambda × dim の行優先配列 */
+    void sample(double* population, int lambda);
+    void update(const double* population, int lambda, const double* fitness);
     void sample(std::vector<std::vector<double>>& candidates);
     void update(const std::vector<std::vector<double>>& candidates,
                 const std::vector<double>& fitness);
@@ -37,15 +61,29 @@ public:
     void deserializeFrom(const double* inMean, const double* inCov, double inSigma);
 
 private:
+    using AlignedVector = std::vector<double, convo::MKLAllocator<double>>;
+
     int dim;
-    std::vector<double> mean;
-    std::vector<double> covariance;  // dim * dim
+    AlignedVector mean;
+    AlignedVector covariance;  // dim * dim（対称、上下三角とも保持）
     double sigma;
     double covRetentionCurrent;
     Params params;
     std::mt19937 rng;
 
+    // 作業領域（sample / update 専用）
+    AlignedVector lowerTriangular;   // dim * dim
+    AlignedVector normals;           // lambda * dim
+    AlignedVector eliteRows;         // mu * dim（重み付き偏差 → dsyrk 入力）
+    AlignedVector oldMean;           // dim
+    AlignedVector weights;           // mu
+    AlignedVector flatPopulation;    // vector<vector> ラッパー用 lambda * dim
+    std::vector<int> rankIndices;    // lambda
+    int weightsForMu = 0;
+    convo::cmaes::QuasiNormalGenerator quasi;
+
     void resetIdentityCovariance();
-    void computeCholesky(std::vector<double>& lowerTriangular) const;
+    void computeCholesky();
+    void prepareWeights(int mu);
     static double sanitize(double x) { return (std::abs(x) < 1e-15) ? 0.0 : x; }
 };
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+//==============================================================================
+// CmaEsSampling — CMA-ES の標準正規ベクトル z の引き方 (CmaEsOptimizer / CmaEsOptimizerDynamic 共通)
+//
+//   ・Mirrored (対称) サンプリング: 行 2k と 2k+1 を z と −z の組にする。平均まわりの偏りが組の中で
+//     打ち消し合い、同じ評価回数でも平均の更新がぶれにくい。組の両方が選ばれると平均への寄与が
+//     相殺され σ が縮みすぎるため、更新側は「組のうち良い方だけを選抜対象にする」(pairwise selection)
+//     — isMirroredPairLoser() で負けた方を除く。
+//   ・準乱数: 各世代ランダムにずらした R_d 列 (Kronecker 列、α_j = φ_d^−(j+1)) を
+//     逆正規 CDF で写す。世代内の点が一様に散るので、少ない個体数でも分布の裾まで満遍なく探れる。
+//     Sobol と違い方向数テーブルが不要で、次元数に上限がない。シフトは毎世代 rng から引くため
+//     各点の周辺分布は正確に N(0, 1) (Cranley–Patterson 回転)。
+//
+//   どちらも無効なら呼び出し側は従来どおり std::normal_distribution で引く (乱数系列を変えない)。
+//==============================================================================
+
+namespace convo::cmaes {
+
+// 標準正規分布の逆 CDF。Acklam の有理近似 (相対誤差 ~1e-9) に Halley 法 1 回で仕上げる
+inline double inverseNormalCdf(double p) noexcept
+{
+    p = std::clamp(p, 1.0e-15, 1.0 - 1.0e-15);
+
+    constexpr double a[] = { -3.969683028665376e+01,  2.209460984245205e+02, -2.759285104469687e+02,
+                              1.383577518672690e+02, -3.066479806614716e+01,  2.506628277459239e+00 };
+    constexpr double b[] = { -5.447609879822406e+01,  1.615858368580409e+02, -1.556989798598866e+02,
+                              6.680131188771972e+01, -1.328068155288572e+01 };
+    constexpr double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                             -2.549732539343734e+00,  4.374664141464968e+00,  2.938163982698783e+00 };
+    constexpr double d[] = {  7.784695709041462e-03,  3.224671290700398e-01,  2.445134137142996e+00,
+                              3.754408661907416e+00 };
+    constexpr double pLow = 0.02425;
+
+    double x = 0.0;
+    if (p < pLow)
+    {
+        const double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+          / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    else if (p <= 1.0 - pLow)
+    {
+        const double q = p - 0.5;
+        const double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+          / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+    else
+    {
+        const double q = std::sqrt(-2.0 * std::log(1.0 - p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+           / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    // Halley: e = Φ(x) − p, u = e / φ(x)
+    constexpr double kSqrt2 = 1.41421356237309504880;
+    constexpr double kSqrt2Pi = 2.50662827463100050242;
+    const double e = 0.5 * std::erfc(-x / kSqrt2) - p;
+    const double u = e * kSqrt2Pi * std::exp(0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+// ランダムシフト付き R_d 列 → 標準正規。dim ごとの α は構築時に一度だけ計算する
+class QuasiNormalGenerator
+{
+public:
+    QuasiNormalGenerator() = default;
+    explicit QuasiNormalGenerator(int dimension) { setDimension(dimension); }
+
+    void setDimension(int dimension)
+    {
+        dim = std::max(0, dimension);
+        // φ_d: x^(d+1) = x + 1 の正の根 (固定点反復で収束する)
+        double phi = 2.0;
+        for (int i = 0; i < 64; ++i)
+            phi = std::pow(1.0 + phi, 1.0 / static_cast<double>(dim + 1));
+        alpha.assign(static_cast<size_t>(dim), 0.0);
+        shift.assign(static_cast<size_t>(dim), 0.0);
+        double power = 1.0;
+        for (int j = 0; j < dim; ++j)
+        {
+            power /= phi;
+            alpha[static_cast<size_t>(j)] = power - std::floor(power);
+        }
+    }
+
+    [[nodiscard]] int getDimension() const noexcept { return dim; }
+
+    // rows 行 × dim 列 (行ストライド stride) を書く。呼び出しごとに新しいシフトを rng から引く
+    template <typename Rng>
+    void generate(double* out, int rows, int stride, Rng& rng)
+    {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (int j = 0; j < dim; ++j)
+            shift[static_cast<size_t>(j)] = uniform(rng);
+
+        for (int k = 0; k < rows; ++k)
+        {
+            double* row = out + static_cast<size_t>(k) * static_cast<size_t>(stride);
+            const double n = static_cast<double>(k + 1);
+            for (int j = 0; j < dim; ++j)
+            {
+                const double x = shift[static_cast<size_t>(j)] + n * alpha[static_cast<size_t>(j)];
+                row[j] = inverseNormalCdf(x - std::floor(x));
+            }
+        }
+    }
+
+private:
+    int dim = 0;
+    std::vector<double> alpha;
+    std::vector<double> shift;
+};
+
+// 標準正規の行列 (lambda 行 × dim 列、行ストライド dim) を引く。
+//   mirrored: 行 2k+1 = −行 2k (lambda が奇数なら最後の行は組を持たない)
+//   quasi != nullptr: 組の元になる行を QuasiNormalGenerator から引く (quasi->getDimension() == dim)
+template <typename Rng>
+void drawStandardNormals(double* out, int lambda, int dim, bool mirrored, QuasiNormalGenerator* quasi, Rng& rng)
+{
+    if (lambda <= 0 || dim <= 0)
+        return;
+
+    const int baseRows = mirrored ? (lambda + 1) / 2 : lambda;
+    const int baseStride = mirrored ? 2 * dim : dim;   // 元の行は偶数行に置く
+    if (quasi != nullptr)
+    {
+        quasi->generate(out, baseRows, baseStride, rng);
+    }
+    else
+    {
+        std::normal_distribution<double> normalDist(0.0, 1.0);
+        for (int k = 0; k < baseRows; ++k)
+        {
+            double* row = out + static_cast<size_t>(k) * static_cast<size_t>(baseStride);
+            for (int j = 0; j < dim; ++j)
+                row[j] = normalDist(rng);
+        }
+    }
+
+    if (!mirrored)
+        return;
+    for (int k = 1; k < lambda; k += 2)
+    {
+        const double* source = out + static_cast<size_t>(k - 1) * static_cast<size_t>(dim);
+        double* row = out + static_cast<size_t>(k) * static_cast<size_t>(dim);
+        for (int j = 0; j < dim; ++j)
+            row[j] = -source[j];
+    }
+}
+
+// Mirrored 組 (2k, 2k+1) の負け側か。非有限は負け、同点は奇数側 (−z) を負けにする。組のない最後の行は負けない
+inline bool isMirroredPairLoser(const double* fitness, int index, int lambda) noexcept
+{
+    const int partner = index ^ 1;
+    if (partner >= lambda)
+        return false;
+    const double self = fitness[index];
+    const double other = fitness[partner];
+    if (!std::isfinite(self))
+        return true;
+    if (!std::isfinite(other))
+        return false;
+    return self > other || (self == other && (index & 1) != 0);
+}
+
+} // namespace convo::cmaes
@@ -6,6 +6,8 @@
 #include "ConvolverControlPanel.h"
 #include "MixedPhaseOptimizationComponent.h"
 #include "ConvolverSettingsComponent.h"
+#include "CpuCostCalibration.h"
+#include <atomic>
 #include <cmath>
 
 #include "audioengine/AtomicAccess.h"
@@ -13,6 +15,10 @@
 namespace
 {
 juce::ThreadPool g_irPreviewThreadPool(1);
+// ★ IR preview: 先頭変換は解析とは別のスレッドで走らせ、解析待ちの列に並ばせない
+juce::ThreadPool g_irHeadPreviewThreadPool(1);
+// 最新の先頭変換リクエスト (古いリクエストの変換はこれを見て打ち切る)
+std::atomic<int> g_latestIrHeadPreview { 0 };
 
 int phaseModeToComboId(ConvolverProcessor::PhaseMode mode)
 {
@@ -396,11 +402,11 @@ ConvolverControlPanel::ConvolverControlPanel(AudioEngine& audioEngine)
     };
     addAndMakeVisible(resamplingPhaseBox);
 
-    experimentalDirectHeadToggle.setButtonText("Exp Direct Head");
-    experimentalDirectHeadToggle.setTooltip("Experimental zero-latency direct head path. Rebuilds the convolver when changed.");
-    experimentalDirectHeadToggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
-    experimentalDirectHeadToggle.addListener(this);
-    addAndMakeVisible(experimentalDirectHeadToggle);
+    zeroLatencyHeadToggle.setButtonText("Zero Latency");
+    zeroLatencyHeadToggle.setTooltip("Zero-latency convolution: the IR head runs as a time-domain FIR, so the convolver adds no latency (higher CPU). Not used with true-stereo IRs. Rebuilds the convolver when changed.");
+    zeroLatencyHeadToggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    zeroLatencyHeadToggle.addListener(this);
+    addAndMakeVisible(zeroLatencyHeadToggle);
 
     // Dry/Wet Mixスライダー
     mixSlider.setSliderStyle(juce::Slider::LinearHorizontal);
@@ -829,9 +835,9 @@ void ConvolverControlPanel::resized()
     controlRow1.removeFromLeft(inlineGap);
     mixSlider.setBounds(controlRow1);
 
-    // --- 2行目: Exp Direct Head + Smoothing ---
+    // --- 2行目: Zero Latency + Smoothing ---
     auto row2Left = controlRow2.removeFromLeft(controlsStartX - leftGap);
-    experimentalDirectHeadToggle.setBounds(row2Left.reduced(0, 2));
+    zeroLatencyHeadToggle.setBounds(row2Left.reduced(0, 2));
 
     // スムージング時間
     auto smoothingRow = controlRow2;
@@ -987,9 +993,9 @@ void ConvolverControlPanel::buttonClicked(juce::Button* button)
                 safeThis->showOptimizationProgressWindow();
         });
     }
-    else if (button == &experimentalDirectHeadToggle)
+    else if (button == &zeroLatencyHeadToggle)
     {
-        engine.getConvolverProcessor().setExperimentalDirectHeadEnabled(experimentalDirectHeadToggle.getToggleState());
+        engine.getConvolverProcessor().setZeroLatencyHeadEnabled(zeroLatencyHeadToggle.getToggleState());
         updateIRInfo();
     }
 }
@@ -1096,13 +1102,44 @@ void ConvolverControlPanel::startAsyncIRLoadPreview(const juce::File& irFile)
     const double analysisSampleRate = engine.getProcessingSampleRate() > 0.0
                                     ? engine.getProcessingSampleRate()
                                     : engine.getSampleRate();
+    const bool farTailPaging = engine.isConvolverFarTailPagingEnabled();
 
     setIRPreviewInProgress(true);
 
     juce::Component::SafePointer<ConvolverControlPanel> safeThis(this);
-    g_irPreviewThreadPool.addJob([safeThis, irFile, requestId, analysisSampleRate]()
+
+    // ★ IR preview: 全長の解析 (読み込み・リサンプル・長さ推定) を待たずに先頭だけを変換して先に鳴らす。
+    //   続けて選択された場合は古い変換を打ち切り、世代の古い結果は applyIRPreview が捨てる
+    const auto ticket = engine.getConvolverProcessor().beginIRPreview();
+    convo::publishAtomic(g_latestIrHeadPreview, requestId, std::memory_order_release); // release: 変換ジョブ側 shouldCancel の acquire と HB
+    g_irHeadPreviewThreadPool.addJob([safeThis, irFile, requestId, ticket]()
+    {
+        const auto isStale = [requestId]()
+        {
+            return requestId != convo::consumeAtomic(g_latestIrHeadPreview, std::memory_order_acquire); // acquire: 新リクエストの publishAtomic release と HB
+        };
+        if (isStale())
+            return;
+
+        auto payload = std::make_shared<std::unique_ptr<ConvolverIRPayload>>(
+            ConvolverProcessor::convertIRPreview(irFile, ticket, isStale));
+        if (*payload == nullptr)
+            return;
+
+        juce::MessageManager::callAsync([safeThis, payload]()
+        {
+            if (safeThis != nullptr)
+                safeThis->engine.getConvolverProcessor().applyIRPreview(std::move(*payload));
+        });
+    });
+
+    g_irPreviewThreadPool.addJob([safeThis, irFile, requestId, analysisSampleRate, farTailPaging]()
     {
-        const auto preview = ConvolverProcessor::analyzeImpulseResponseFile(irFile, analysisSampleRate);
+        // 後続の選択があれば解析しない (その選択の解析が同じ列の後ろに並んでいる)
+        if (requestId != convo::consumeAtomic(g_latestIrHeadPreview, std::memory_order_acquire)) // acquire: 新リクエストの publishAtomic release と HB
+            return;
+
+        const auto preview = ConvolverProcessor::analyzeImpulseResponseFile(irFile, analysisSampleRate, farTailPaging);
 
         const bool queued = juce::MessageManager::callAsync([safeThis, irFile, requestId, preview]()
         {
@@ -1131,6 +1168,7 @@ void ConvolverControlPanel::finishAsyncIRLoadPreview(const juce::File& irFile,
         return;
 
     setIRPreviewInProgress(false);
+    auto& previewConvolver = engine.getConvolverProcessor();
 
     const auto applyPreviewIRLengthAndLoad = [this, irFile](float targetLengthSec)
     {
@@ -1152,6 +1190,7 @@ void ConvolverControlPanel::finishAsyncIRLoadPreview(const juce::File& irFile,
                                                                : "Failed to analyze the selected IR file.")
                 .withButton("OK"),
             nullptr);
+        previewConvolver.cancelIRPreview();
         updateIRInfo();
         return;
     }
@@ -1168,6 +1207,7 @@ void ConvolverControlPanel::finishAsyncIRLoadPreview(const juce::File& irFile,
                              + " s at this sample rate.\n\nPlease use a shorter IR or lower the sample rate.")
                 .withButton("OK"),
             nullptr);
+        previewConvolver.cancelIRPreview();
         updateIRInfo();
         return;
     }
@@ -1203,6 +1243,7 @@ void ConvolverControlPanel::finishAsyncIRLoadPreview(const juce::File& irFile,
                 }
                 else
                 {
+                    safeThis->engine.getConvolverProcessor().cancelIRPreview();
                     safeThis->updateIRInfo();
                 }
             });
@@ -1295,7 +1336,7 @@ void ConvolverControlPanel::updateIRInfo()
     mixSlider.setValue(pendingMixDirty ? pendingMixValue : convolver.getMix(), juce::dontSendNotification);
     phaseChoiceBox.setSelectedId(phaseModeToComboId(convolver.getPhaseMode()), juce::dontSendNotification);
     updateMixedPhaseControlsEnabled();
-    experimentalDirectHeadToggle.setToggleState(convolver.getExperimentalDirectHeadEnabled(), juce::dontSendNotification);
+    zeroLatencyHeadToggle.setToggleState(convolver.getZeroLatencyHeadEnabled(), juce::dontSendNotification);
 
     // リサンプリング位相モードの同期
     {
@@ -1363,9 +1404,16 @@ void ConvolverControlPanel::updateIRInfo()
         else
             info += " Lat A: " + juce::String(algorithmMs) + "ms / T: " + juce::String(totalMs) + "ms";
 
+        // 現在の IR・OS・バッファでの callback 負荷予測。Warning 以上は色で知らせ、提案はツールチップへ
+        const auto costConfig = engine.makeCpuCostConfig();
+        const auto cost = engine.predictCpuCost(costConfig);
+        if (cost.verdict != convo::CpuCostPrediction::Verdict::Unknown)
+            info += " CPU~" + juce::String(juce::roundToInt(cost.load * 100.0)) + "%";
+
         irInfoLabel.setText(info, juce::dontSendNotification);
         irInfoLabel.setColour(juce::Label::textColourId,
-                             juce::Colours::lightgreen);
+                             convo::cpuCostVerdictColour(cost.verdict, juce::Colours::lightgreen));
+        irInfoLabel.setTooltip(convo::formatCpuCostTooltip(cost, engine.suggestCpuCostDowngrade(costConfig)));
     }
     else if (const float progress = convolver.getLoadProgress(); convolver.isLoadingIR() && progress >= 0.0f && progress < 1.0f)
     {
@@ -1380,6 +1428,7 @@ void ConvolverControlPanel::updateIRInfo()
             irInfoLabel.setText("Optimization Progress... " + juce::String(percent) + "%", juce::dontSendNotification);
         }
         irInfoLabel.setColour(juce::Label::textColourId, juce::Colours::orange.withAlpha(0.9f));
+        irInfoLabel.setTooltip("");
         updateWaveformPath();
         return;
     }
@@ -1417,6 +1466,7 @@ void ConvolverControlPanel::updateIRInfo()
             irInfoLabel.setText("No IR loaded", juce::dontSendNotification);
             irInfoLabel.setColour(juce::Label::textColourId,
                                  juce::Colours::orange.withAlpha(0.8f));
+            irInfoLabel.setTooltip("");
         }
     }
 
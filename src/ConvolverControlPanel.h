@@ -50,7 +50,7 @@ private:
     juce::TextButton convolverSettingsButton{"Conv Settings..."};
     juce::TextButton optimizationProgressButton{"Optimization Progress..."};
     juce::ComboBox phaseChoiceBox;
-    juce::ToggleButton experimentalDirectHeadToggle;
+    juce::ToggleButton zeroLatencyHeadToggle;
 
     // リサンプリング位相モード選択
     juce::ComboBox resamplingPhaseBox;
@@ -33,6 +33,7 @@
 #include <map>
 #include <cmath>
 #include <optional>
+#include <utility>
 #include "AlignedAllocation.h"
 #include "MKLNonUniformConvolver.h"
 #include "AllpassDesigner.h"
@@ -41,21 +42,31 @@
 #include "UltraHighRateDCBlocker.h"
 #include "convolver/ConvolverProcessor.Internal.h"
 #include "core/RCUReader.h"
+#include "core/CallbackReaderScope.h"
+#include "core/AdaptiveSliceBudget.h"
 
 // ── Phase 0: Epoch-based RCU 基盤ヘッダー ──
 #include "GenerationManager.h"
 #include "ConvolverState.h"
+#include "BulkReleaseQueue.h"
 #include "DeferredFreeThread.h"
 #include "core/ConvolverRuntimeCompatTypes.h"
 #include "DeferredDeletionQueue.h"
 #include "core/EpochDomain.h"
 #include "DspNumericPolicy.h"
 #include "DftiHandle.h"
+#include "dsp/LatencyDelayLine.h"
+#include "CacheManager.h"
+#include "core/EQParameters.h"
 
 class AudioEngine;
 namespace convo::isr { class RuntimePublicationCoordinator; }
-class CacheManager;
+namespace convo { class ChannelForkJoin; }
 class ProgressiveUpgradeThread;
+class StandbyPrebuildThread;
+class CachePrefetchThread;
+class IRLibraryIndexer;
+struct IRLibraryEntry;
 
 #pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 #pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
@@ -63,6 +74,33 @@ class ConvolverProcessor : public juce::ChangeBroadcaster,
                            private juce::Timer
 {
 public:
+    // ★ IR bus: 主 IR に重ねる追加 IR (早期反射 IR + 別室の残響 IR + スピーカー補正 IR 等)。
+    //   主 IR と同じエンジンで畳み込み、入力 FFT・FDL を共有する (setIrBusEntries 参照)。
+    static constexpr int kMaxIrBusEntries = convo::MKLNonUniformConvolver::kMaxSpectralBusInputs - 1;  // 主 IR を除く
+    struct IrBusEntry
+    {
+        juce::File file;
+        float gainDb = 0.0f;        // 再構築なしで変更可 (setIrBusGainDb)
+        float preDelayMs = 0.0f;
+        float tailSec = 0.0f;       // 0 = 全長 (IR 長の上限は主 IR と共通)
+        float tailFadeMs = 0.0f;    // 使う区間の末尾に掛けるフェードアウト
+    };
+
+    // Loader Thread が整形した追加 IR (L/R, 主 IR と同じ長さ) を StereoConvolver へ渡す入れ物
+    struct IrBusSources
+    {
+        convo::ScopedAlignedArray<double> data[kMaxIrBusEntries][2];
+        double gains[kMaxIrBusEntries] {};
+        int entryIndex[kMaxIrBusEntries] {};    // irBus の添字 (ゲイン変更の対応付け用)
+        int count = 0;
+        convo::ScopedAlignedArray<double> morph[2];     // ★ Spectral morph: モーフ先 IR (なしは nullptr)
+
+        [[nodiscard]] bool hasMorph() const noexcept
+        {
+            return static_cast<bool>(morph[0]) && static_cast<bool>(morph[1]);
+        }
+    };
+
     // BuildSnapshot: 同期/シリアライズ/ハッシュ用の輸送スナップショット。
     // authoritative source-of-truth は pendingOverride store。
     struct BuildSnapshot
@@ -79,7 +117,14 @@ public:
         float mixedTransitionStartHz = MIXED_F1_DEFAULT_HZ;
         float mixedTransitionEndHz = MIXED_F2_DEFAULT_HZ;
         int rebuildDebounceMs = REBUILD_DEBOUNCE_DEFAULT_MS;
-        bool experimentalDirectHeadEnabled = false;
+        bool zeroLatencyHeadEnabled = false;
+        bool tailWorkerOffloadEnabled = false;
+        bool trueStereoEnabled = true;
+        bool compactTailSpectraEnabled = false;
+        bool multirateTailEnabled = false;
+        bool layoutAutoTuneEnabled = false;
+        float partitionCullFloorDb = PARTITION_CULL_FLOOR_DEFAULT_DB;
+        float farTailHorizonSec = FAR_TAIL_HORIZON_DEFAULT_SEC;
         int tailMode = static_cast<int>(TailMode::LayerTailContouring);
         float tailStartSec = TAIL_START_DEFAULT_SEC;
         float tailStrength = TAIL_STRENGTH_DEFAULT;
@@ -89,6 +134,10 @@ public:
         int maxCacheEntries = 0;
 
         // ---- Structural hash 非対象（同期/表示/復元用メタデータ）----
+        bool spectralCrossfadeEnabled = false;  // エンジン交換方式のみに影響 (IR スペクトルは不変)
+        bool streamingIRActivationEnabled = false;  // loadIR の反映順のみに影響 (最終的な IR は不変)
+        bool incrementalRebuildEnabled = false;     // rebuild の進め方のみに影響 (最終的な IR は不変)
+        float spectralMorphAmount = 0.0f;           // spectral morph で再構築なしに反映する
         juce::File irFile;
         juce::String irName;
         int irLength = 0;
@@ -98,6 +147,17 @@ public:
         int nucHCMode = static_cast<int>(convo::HCMode::Natural);
         int nucLCMode = static_cast<int>(convo::LCMode::Natural);
 
+        // ---- Structural hash 対象（EQ fold: 静的 EQ を IR へ焼き込む）----
+        bool eqFoldEnabled = false;
+        convo::EQParameters eqFoldParams {};
+
+        // ---- Structural hash 対象（IR bus。gainDb のみ対象外: spectral bus で再構築なしに反映する）----
+        std::array<IrBusEntry, kMaxIrBusEntries> irBus {};
+        int irBusCount = 0;
+
+        // ---- Structural hash 対象（spectral morph のモーフ先。空 = なし）----
+        juce::File spectralMorphFile;
+
         // capture 時点のスナップショット整合確認用（比較/診断向け）
         std::uint64_t fingerprint = 0;
     };
@@ -170,6 +230,9 @@ public:
     static constexpr float IR_LENGTH_MIN_SEC = 0.5f;
     static constexpr float IR_LENGTH_MAX_SEC = 3.0f;
     static constexpr float IR_LENGTH_DEFAULT_SEC = 1.0f;
+    static constexpr float STREAMING_HEAD_SEC = 0.1f;        // Streaming activation で先に反映する IR 先頭
+    static constexpr float IR_PREVIEW_HEAD_SEC = 0.25f;      // IR preview で読み込む先頭
+    static constexpr float IR_PREVIEW_FADE_SEC = 0.05f;      // IR preview 末尾のフェードアウト
     static constexpr float MIXED_F1_MIN_HZ = 100.0f;
     static constexpr float MIXED_F1_MAX_HZ = 400.0f;
     static constexpr float MIXED_F1_DEFAULT_HZ = 200.0f;
@@ -185,27 +248,40 @@ public:
     static constexpr float TAIL_STRENGTH_MIN = 0.0f;
     static constexpr float TAIL_STRENGTH_MAX = 2.0f;
     static constexpr float TAIL_STRENGTH_DEFAULT = 1.0f;
+    static constexpr float PARTITION_CULL_FLOOR_MIN_DB = -200.0f;  // = 無効 (FilterSpec::kPartitionCullDisabledDb)
+    static constexpr float PARTITION_CULL_FLOOR_MAX_DB = -60.0f;
+    static constexpr float PARTITION_CULL_FLOOR_DEFAULT_DB = -140.0f;
+    static constexpr float FAR_TAIL_HORIZON_MIN_SEC = 0.0f;      // = 無効
+    static constexpr float FAR_TAIL_HORIZON_MAX_SEC = 60.0f;
+    static constexpr float FAR_TAIL_HORIZON_DEFAULT_SEC = 0.0f;
     static constexpr int TAIL_L1L2_MULT_MIN = 2;
     static constexpr int TAIL_L1L2_MULT_MAX = 16;
     static constexpr int TAIL_L1L2_MULT_DEFAULT = 8;
     static constexpr float TAIL_EXTENDED_START_MIN_SEC = 0.12f;
     static constexpr float TAIL_EXTENDED_STRENGTH_MIN = 1.25f;
     static constexpr int TAIL_EXTENDED_L1L2_MULT_MIN = 12;
+    static constexpr float SPECTRAL_CROSSFADE_SEC = 0.05f;          // 50ms (L0 基準。長いレイヤーは 2 パーティション以上)
+    static constexpr int SPECTRAL_CROSSFADE_TIMEOUT_MARGIN_MS = 500; // 完了しない場合に通常交換へ切り替えるまでの余裕
+    static constexpr float IR_BUS_GAIN_MIN_DB = -96.0f;             // = ミュート (convo::kIrBusMuteDb)
+    static constexpr float IR_BUS_GAIN_MAX_DB = 12.0f;
+    static constexpr float IR_BUS_PRE_DELAY_MAX_MS = 500.0f;
+    static constexpr float IR_BUS_TAIL_FADE_MAX_MS = 1000.0f;
+    static constexpr float IR_BUS_GAIN_FADE_SEC = 0.03f;            // ゲイン変更時の spectral crossfade (L0 基準)
+    static constexpr float SPECTRAL_MORPH_RAMP_SEC = 0.03f;         // モーフ量 0→1 の追従時間 (L0 基準)
 
     // DelayLine用定数 (Audio Threadでのメモリ確保防止)
     // IRの最大長(kMaxIRCap)と最大ブロックサイズをカバーする値を設定
     // 3s @ 192kHz = 576000 samples. Next power of 2 is 1048576.
     static constexpr int MAX_IR_LATENCY = 2097152; // 2^21 (3.0s @ 384kHz = ~1.15M samples をカバー)
+    // Far-tail paging 有効時の IR 長上限。地平線より後ろの L2 スペクトルはディスク上に置くため
+    // ヒープは増えないが、FDL (入力履歴) は IR 長に比例して確保される。レイテンシ補正は MAX_IR_LATENCY のまま
+    static constexpr int MAX_PAGED_IR_LENGTH = 8388608; // 2^23 (174s @ 48kHz)
     // 最適なFFTパフォーマンスのために、この値は2の累乗である必要があります。
     // また、MIN_PARTITION_SIZE以上である必要があります。
     // MAX_PARTITION_SIZEもまた、maxBlockSize * oversamplingFactor以上である必要があります。
     static constexpr int MAX_BLOCK_SIZE = 524288;  // 65536 * 8 (Safe for 8x oversampling of max input block)
+    // レイテンシ補正の上限。補正リング (latencyDelay) 自体は実際の遅延に合わせて確保する
     static constexpr int MAX_TOTAL_DELAY = MAX_IR_LATENCY + MAX_BLOCK_SIZE;
-    // リングバッファのラップアラウンドをビットマスクで高速化するため、2の累乗サイズを使用
-    static constexpr int DELAY_BUFFER_SIZE = 4194304; // 2^22 (approx 4M samples > MAX_TOTAL_DELAY)
-    static constexpr int DELAY_BUFFER_MASK = DELAY_BUFFER_SIZE - 1;
-    static_assert((DELAY_BUFFER_SIZE & (DELAY_BUFFER_SIZE - 1)) == 0,
-                  "DELAY_BUFFER_SIZE must be a power of 2 for bitmask optimization");
     static constexpr double CONVOLUTION_HEADROOM_GAIN = 1.0; // 0.0 dB (Unity Gain - Headroom is baked into IR)
 
     ConvolverProcessor();
@@ -225,6 +301,11 @@ public:
     //----------------------------------------------------------
     void prepareToPlay(double sampleRate, int samplesPerBlock);
     void releaseResources();
+    // 終了時用 (Message Thread): ローダー・アップグレード・standby・プリフェッチ・索引の各スレッドへ
+    // 一斉にキャンセルを知らせるだけで待たない。stopBackgroundThreads / デストラクタの join がすぐ戻るようになる
+    void requestBackgroundStop();
+    // アップグレード・standby・プリフェッチ・索引スレッドを止めて破棄する (ローダーはデストラクタが扱う)
+    void stopBackgroundThreads();
 
     //----------------------------------------------------------
     // インパルス応答読み込み（Message Thread）
@@ -235,28 +316,91 @@ public:
     bool loadImpulseResponse(const juce::File& irFile, bool optimizeForRealTime = false);
     void loadIR(const juce::File& irFile);
     void applyComputedIR(std::unique_ptr<ConvolverIRPayload> payload);
+    // ★ IR preview: 選択直後、全長の解析・変換を待たずに IR 先頭 IR_PREVIEW_HEAD_SEC (末尾フェード) を
+    //   現在レートで変換して先に鳴らす。beginIRPreview (Message Thread) で世代を進めて進行中の変換・アップグレードを
+    //   打ち切り、convertIRPreview (任意のスレッド) で変換、applyIRPreview (Message Thread) で反映する。
+    //   以降の beginIRPreview / loadIR で世代が進んだプレビューは変換途中で打ち切られ、反映もされない。
+    //   全長は続く loadIR が通常の差し替えで置き換える。読み込みをやめた場合は cancelIRPreview で現在 IR に戻す
+    struct IRPreviewTicket
+    {
+        uint64_t generation = 0;
+        double sampleRate = 0.0;
+    };
+    [[nodiscard]] IRPreviewTicket beginIRPreview();
+    [[nodiscard]] static std::unique_ptr<ConvolverIRPayload> convertIRPreview(const juce::File& irFile,
+                                                                             const IRPreviewTicket& ticket,
+                                                                             const std::function<bool()>& shouldCancel);
+    void applyIRPreview(std::unique_ptr<ConvolverIRPayload> payload);
+    void cancelIRPreview();
     // acquire: applyComputedIR の release と HB し、IR 適用時刻を取得。
     [[nodiscard]] int64_t getLastPreparedIRApplyTicks() const noexcept { return convo::consumeAtomic(lastPreparedIRApplyTicks, std::memory_order_acquire); } // acquire: applyComputedIR の release と HB
     void stopUpgradeThread();
+    // completeStreamingHead=true: 先頭だけを反映済み。アップグレード無効でも全長を currentFFTSize で変換して差し替える
     void startProgressiveUpgrade(const juce::File& file,
                                  double sampleRate,
                                  int currentFFTSize,
                                  uint64_t generation,
-                                 uint64_t baseKey);
+                                 uint64_t baseKey,
+                                 bool completeStreamingHead = false);
 
     void setTargetUpgradeFFTSize(int fftSize);
     [[nodiscard]] int getTargetUpgradeFFTSize() const;
     void setEnableProgressiveUpgrade(bool enable);
     [[nodiscard]] bool isProgressiveUpgradeEnabled() const;
+    // ★ Streaming activation: キャッシュに無い IR は先頭 STREAMING_HEAD_SEC だけを変換して先に鳴らし、
+    //   全長の変換が終わり次第差し替える (IR 長に依存せず最初の音が出る)。PhaseMode::AsIs のみ
+    void setStreamingIRActivationEnabled(bool enable);
+    [[nodiscard]] bool isStreamingIRActivationEnabled() const;
     void setMaxCacheEntries(size_t maxEntries);
     [[nodiscard]] size_t getMaxCacheEntries() const;
+    // ★ リサンプリング済み IR キャッシュ (ResampledIRCache, プロセス共有) の合計バイト予算
+    void setResampledIRCacheBudgetBytes(size_t bytes);
+    [[nodiscard]] size_t getResampledIRCacheBudgetBytes() const;
+    // ★ Hot standby: 代替サンプルレート向け IR の事前計算 (空 = 無効)。UI 側インスタンスで使用する
+    void setStandbySampleRates(std::vector<double> rates);
+    [[nodiscard]] std::vector<double> getStandbySampleRates() const;
+    void setStandbyBudgetBytes(size_t bytes);
+    [[nodiscard]] size_t getStandbyBudgetBytes() const;
+    void scheduleStandbyPrebuild();
+    void stopStandbyPrebuild();
+    // Standby Prebuild Thread から同期的に呼ばれる (Build 手前まで処理して StandbyIRPool へ格納)
+    bool prebuildStandbyIR(const juce::File& file, double standbyRate, const std::function<bool()>& shouldCancel);
+    // ★ Cache prefetch: 最近使用した IR (現在 IR を除く先頭 N 件) のキャッシュを事前検証する (0 = 無効)。UI 側インスタンスで使用する
+    static constexpr int kMaxRecentIRFiles = 16;
+    void setCachePrefetchCount(int count);
+    [[nodiscard]] int getCachePrefetchCount() const;
+    void setCachePrefetchBudgetBytes(size_t bytes);
+    [[nodiscard]] size_t getCachePrefetchBudgetBytes() const;
+    // ★ Cache compression: 以降に保存するキャッシュのスペクトルを v4 (shuffle + deflate) で書く。既存ファイルはそのまま読める
+    void setCacheCompressionEnabled(bool enabled);
+    [[nodiscard]] bool isCacheCompressionEnabled() const;
+    // ★ Cache byte budget: キャッシュファイル合計の上限と、再生成コストで重み付けした退避 (GreedyDual-Size)
+    void setCacheDiskBudgetBytes(uint64_t bytes);
+    [[nodiscard]] uint64_t getCacheDiskBudgetBytes() const;
+    void setCacheCostWeightedEviction(bool enabled);
+    [[nodiscard]] bool isCacheCostWeightedEviction() const;
+    [[nodiscard]] CacheManager::Stats getCacheStats() const;
+    [[nodiscard]] std::vector<juce::File> getRecentIRFiles() const;
+    void setRecentIRFiles(std::vector<juce::File> files);
+    void scheduleCachePrefetch();
+    void stopCachePrefetch();
+    // ★ IR library index: 指定ディレクトリ (再帰) の IR をバックグラウンドで解析し永続索引へ記録する。
+    //   索引済み IR は内容を読まずに metadata・解析値を引け、初回ロードの周波数応答解析も省かれる。UI 側インスタンスで使用する
+    void setIRLibraryDirectories(std::vector<juce::File> directories);
+    [[nodiscard]] std::vector<juce::File> getIRLibraryDirectories() const;
+    void stopIRLibraryIndexer();
+    [[nodiscard]] static bool lookupIRLibraryEntry(const juce::File& file, IRLibraryEntry& out);
     void clearCache();
     [[nodiscard]] bool isCacheEntrySafeToDelete(uint64_t cacheKey, int fftSize) const;
 
     // メイン処理（Audio Thread）
-    //
+    // split != nullptr なら 2ch の wet 生成で R チャンネルを split の helper で並行に回す
+    // (audioengine/ChannelForkJoin.h。True-stereo はクロスパスが相手の FDL を参照するため対象外)
     //----------------------------------------------------------
-    void process(juce::dsp::AudioBlock<double>& block);
+    void process(juce::dsp::AudioBlock<double>& block, convo::ChannelForkJoin* split = nullptr);
+    // Audio Thread 専用: コールバック入口で runtimeRcuReader を固定する。
+    // パイプライン稼働中 (ワーカーが process() を呼ぶ) は固定しないこと
+    void pinReaderForCallback(convo::CallbackReaderScope& scope) noexcept { (void)scope.pin(runtimeRcuReader, m_rtReaderPinned); }
 
     //----------------------------------------------------------
     // バイパス制御
@@ -304,11 +448,125 @@ public:
     //------------------------------------------------------------------
 
     //----------------------------------------------------------
-    // Experimental Direct Head Flag
-    // 段階導入用の機能フラグ。変更時はIRを再構築する。
+    // Zero-latency Head Flag
+    // IR 先頭を時間領域 FIR で畳み込み、コンボルバーのアルゴリズム遅延を 0 にする
+    // (MKLNonUniformConvolver の enableDirectHead)。True-stereo では無効。変更時はIRを再構築する。
+    //----------------------------------------------------------
+    void setZeroLatencyHeadEnabled(bool enabled);
+    [[nodiscard]] bool getZeroLatencyHeadEnabled() const;
+
+    //----------------------------------------------------------
+    // Tail Worker Offload
+    // NUC の L1/L2 を専用ワーカースレッド (heavyBackground コア) で処理する。
+    // Audio Thread は L0 と入力コピーのみとなる。レイテンシは不変。変更時はIRを再構築する。
+    //----------------------------------------------------------
+    void setTailWorkerOffloadEnabled(bool enabled);
+    [[nodiscard]] bool getTailWorkerOffloadEnabled() const;
+
+    //----------------------------------------------------------
+    // True-Stereo (4ch IR: LL/LR/RL/RR)
+    // 有効時、4ch IR は 4 パス畳み込み (入力 FDL を L/R で共有) として構築する。
+    // 無効時は従来どおり ch0/ch1 を L/R として使う。Direct Head / Tail Worker とは排他
+    // (true-stereo 構築時はこれらを無効化する)。変更時はIRを再構築する。
+    //----------------------------------------------------------
+    void setTrueStereoEnabled(bool enabled);
+    [[nodiscard]] bool getTrueStereoEnabled() const;
+
+    //----------------------------------------------------------
+    // Compact Tail Spectra
+    // 有効時、NUC の L1/L2 の IR スペクトルと FDL を float32 で保持する (L0 と出力は double)。
+    // テール層のメモリと MAC 帯域が半減する。True-Stereo 構築時は無効化する。変更時はIRを再構築する。
+    //----------------------------------------------------------
+    void setCompactTailSpectraEnabled(bool enabled);
+    [[nodiscard]] bool getCompactTailSpectraEnabled() const;
+
+    //----------------------------------------------------------
+    // Multirate Tail
+    // 有効時、NUC の L2 を 1/2〜1/8 のレートで畳み込む (比はサンプルレートから自動決定、20 kHz 以下を保持)。
+    // 88.2 kHz 以上でのみ効果があり、Far-tail paging / True-Stereo 構築時は無効化する。変更時はIRを再構築する。
+    //----------------------------------------------------------
+    void setMultirateTailEnabled(bool enabled);
+    [[nodiscard]] bool getMultirateTailEnabled() const;
+
+    //----------------------------------------------------------
+    // Layout Auto-Tune
+    // 有効時、NUC の L1/L2 partition 倍率 (tailL1L2Multiplier) を NucLayoutWisdom の実測結果で置き換える。
+    // 未計測の (ブロックサイズ, IR 長, SR) は IR ロード時に Loader Thread で一度だけ計測し永続化する。
+    // 変更時はIRを再構築する。
+    //----------------------------------------------------------
+    void setLayoutAutoTuneEnabled(bool enabled);
+    [[nodiscard]] bool getLayoutAutoTuneEnabled() const;
+
+    // ★ Spectral crossfade: IR 切替時、レイヤー構成が一致すれば稼働中エンジンを交換せず
+    //   入力 FDL を共有したまま IR スペクトルのみをフェードで差し替える (MAC のみ 2 倍)。
+    //   構成不一致・True-stereo・Direct Head 時は従来のエンジン交換。rebuild は不要。
+    void setSpectralCrossfadeEnabled(bool enabled);
+    [[nodiscard]] bool getSpectralCrossfadeEnabled() const;
+
+    // ★ EQ fold: 静的・線形な EQ 応答を次回構築時に IR へ焼き込む (nullptr で解除)。
+    //   焼き込み可否は Loader Thread が EQProcessor::isFoldableIntoIR で再判定し、不可なら素の IR で構築する。
+    //   通知・rebuild は行わない。呼び出し側 (AudioEngine) が rebuild を要求すること。
+    void setFoldedEQ(const convo::EQParameters* params);
+    [[nodiscard]] bool hasFoldedEQ() const;
+    // 稼働中エンジンが EQ 焼き込み済み IR で構築されているか (非 RT: DSPCore publish 前の確認用)
+    [[nodiscard]] bool isEQFoldedIntoIR() const noexcept;
+
+    //----------------------------------------------------------
+    // IR bus
+    // 主 IR に最大 kMaxIrBusEntries 本の追加 IR を重ね、1 つのエンジン (入力 FFT・FDL は各レイヤー 1 系統) で
+    // 畳み込む。各 IR は処理レートへリサンプリングし、pre-delay・末尾の打ち切りとフェードアウトを掛けてから
+    // 主 IR と同じ長さ・同じレイヤー構成で NUC のスペクトルにする (位相モード変換・自動トリムは主 IR のみ)。
+    // NUC の spectral bus が使える構成では入力ごとのスペクトルを保持して Σ g·H を合成するため、
+    // MAC・FFT は単一 IR と同じで、ゲインは setIrBusGainDb で再構築なしに変えられる。
+    // Direct Head / True-Stereo / Far-tail paging の構成では時間領域で主 IR へ加算して構築する
+    // (ゲインは焼き込み。変更の反映には再構築が要る)。
+    // setIrBusEntries : 構成 (ファイル・pre-delay・末尾) の変更。rebuild は UI 層から要求すること。
+    // setIrBusGainDb  : Message Thread のみ。@return false=現行エンジンでは反映できない (再構築で反映される)
+    // isIrBusLive     : 現行エンジンが spectral bus で追加 IR を保持しているか
+    //----------------------------------------------------------
+    void setIrBusEntries(const IrBusEntry* entries, int count);
+    [[nodiscard]] int getIrBusEntryCount() const;
+    [[nodiscard]] IrBusEntry getIrBusEntry(int index) const;
+    bool setIrBusGainDb(int index, float gainDb);
+    [[nodiscard]] bool isIrBusLive() const noexcept;
+
+    //----------------------------------------------------------
+    // Spectral morph
+    // 2 本目の IR (モーフ先) を IR bus と同じ手順で主 IR と同じ長さ・レイヤー構成のスペクトルにして NUC へ接続し、
+    // 出力を (1-m)·主 IR + m·モーフ先 で再構築なしに連続的にブレンドする。FFT/IFFT は 1 系統のまま、
+    // m が 0 / 1 の間は MAC も 1 系統 (中間値では 2 倍)。
+    // Direct Head / True-Stereo / Far-tail paging の構成では接続しない。spectral bus と排他のため、
+    // モーフ先がある間は IR bus の追加 IR を主 IR へ焼き込む (ゲイン変更は再構築で反映)。
+    // setSpectralMorphTarget : Message Thread のみ。モーフ先ファイル (空 = 解除)。接続は rebuild で反映する
+    //                          (UI 層から要求すること)。解除は稼働中エンジンから直ちに切り離し、資源は cleanup で返す
+    // setSpectralMorphAmount : Message Thread のみ。m (0..1)。Audio Thread がブロック毎にエンジンへ渡し、
+    //                          NUC が SPECTRAL_MORPH_RAMP_SEC で追従する (オートメーション可)
+    // isSpectralMorphLive    : 現行エンジンがモーフ先を接続しているか
+    //----------------------------------------------------------
+    void setSpectralMorphTarget(const juce::File& file);
+    [[nodiscard]] juce::File getSpectralMorphTarget() const;
+    void setSpectralMorphAmount(float amount);
+    [[nodiscard]] float getSpectralMorphAmount() const;
+    [[nodiscard]] bool isSpectralMorphLive() const noexcept;
+
+    //----------------------------------------------------------
+    // Partition Culling
+    // IR のピークパーティション比でこの閾値 (dB) を下回るパーティションを NUC の積和から除外する。
+    // 末尾の無音区間はレイヤー構成ごと縮め、途中の無音区間はスキップする。
+    // PARTITION_CULL_FLOOR_MIN_DB で無効。True-Stereo 構築時は無効化する。変更時はIRを再構築する。
+    //----------------------------------------------------------
+    void setPartitionCullFloorDb(float floorDb);
+    [[nodiscard]] float getPartitionCullFloorDb() const;
+
+    //----------------------------------------------------------
+    // Far-tail Paging
+    // IR 先頭からこの秒数より後ろの L2 パーティションを一時ファイルのメモリマップから読み、
+    // 先読みスレッドが MAC の少し先だけを常駐させる。有効時は IR 長の上限が MAX_PAGED_IR_LENGTH まで広がる。
+    // 0 で無効。True-Stereo 構築時は無効化する。変更時はIRを再構築する。
     //----------------------------------------------------------
-    void setExperimentalDirectHeadEnabled(bool enabled);
-    [[nodiscard]] bool getExperimentalDirectHeadEnabled() const;
+    void setFarTailHorizonSec(float horizonSec);
+    [[nodiscard]] float getFarTailHorizonSec() const;
+    [[nodiscard]] bool isFarTailPagingEnabled() const { return getFarTailHorizonSec() > 0.0f; }
 
     //----------------------------------------------------------
     // Smoothing Time
@@ -358,9 +616,10 @@ public:
     void setIRLengthManualOverride(bool isManual);
     [[nodiscard]] bool hasManualIRLengthOverride() const;
     [[nodiscard]] float getAutoDetectedIRLength() const;
-    [[nodiscard]] static float getMaximumAllowedIRLengthSecForSampleRate(double sampleRate);
+    [[nodiscard]] static float getMaximumAllowedIRLengthSecForSampleRate(double sampleRate, bool farTailPaging = false);
     [[nodiscard]] float getMaximumAllowedIRLengthSec(double sampleRate = 0.0) const;
-    [[nodiscard]] static IRLoadPreview analyzeImpulseResponseFile(const juce::File& irFile, double processingSampleRate);
+    [[nodiscard]] static IRLoadPreview analyzeImpulseResponseFile(const juce::File& irFile, double processingSampleRate,
+                                                                  bool farTailPaging = false);
 
     //----------------------------------------------------------
     // 状態リセット
@@ -431,6 +690,8 @@ public:
     [[nodiscard]] LatencyBreakdown getLatencyBreakdown() const;
     [[nodiscard]] int getLatencySamples() const;
     [[nodiscard]] int getTotalLatencySamples() const;
+    // レイテンシ補正リングの確保量 (非 RT)
+    [[nodiscard]] size_t getLatencyDelayBytes() const noexcept { return latencyDelay.residentBytes(); }
 
     struct RebuildAutomationDiagnostics
     {
@@ -473,11 +734,15 @@ public:
     //----------------------------------------------------------
     // リビルド (サンプルレート変更時など)
     //----------------------------------------------------------
-    enum class IncrementalRebuildSliceResult
+    using IncrementalRebuildSliceResult = convo::SliceResult;
+
+    // ★ Incremental rebuild の優先度: rebuild worker がスライス周期のうち実行に使う時間予算を決める。
+    //   残りは休止し、その間 Audio Thread や他のワーカーへ CPU を譲る
+    enum class IncrementalRebuildPriority
     {
-        InProgress,
-        Completed,
-        Failed
+        Background,   // 再生中の追従など。CPU を譲り小さく刻む
+        Normal,       // 構造変更 (Heavy lane)
+        Interactive   // ユーザーが結果を待っている操作 (Light lane / オフライン)。大きく刻んで早く終える
     };
 
     void rebuildAllIRs();
@@ -487,6 +752,8 @@ public:
     void resetIncrementalRebuild() noexcept;
     void setUseIncrementalRebuild(bool enable) noexcept;
     [[nodiscard]] bool isIncrementalRebuildEnabled() const noexcept;
+    void setIncrementalRebuildPriority(IncrementalRebuildPriority priority) noexcept;
+    [[nodiscard]] IncrementalRebuildPriority getIncrementalRebuildPriority() const noexcept;
     void invalidatePendingLoads();
 
     // 他のインスタンスから状態を同期 (AudioEngine用)
@@ -519,7 +786,12 @@ public:
                                           const BuildSnapshot& buildSnapshot,
                                           double scaleFactor, // This is for newConv->init
                                           std::unique_ptr<juce::AudioBuffer<double>> loadedIR,
-                                          std::unique_ptr<juce::AudioBuffer<double>> displayIR);
+                                          std::unique_ptr<juce::AudioBuffer<double>> displayIR,
+                                          convo::ScopedAlignedPtr<double> crossRL = convo::ScopedAlignedPtr<double>{},
+                                          convo::ScopedAlignedPtr<double> crossLR = convo::ScopedAlignedPtr<double>{},
+                                          bool eqFoldedIntoIR = false,
+                                          std::shared_ptr<IrBusSources> irBus = nullptr,
+                                          bool irBusBaked = false);
 
     // 可視化データ生成の制御 (DSP用インスタンスでは無効化してメモリを節約)
     void setVisualizationEnabled(bool enabled) { visualizationEnabled = enabled; }
@@ -582,10 +854,12 @@ private:
         Stage stage { Stage::Idle };
         std::unique_ptr<juce::AudioBuffer<double>> preparedIR;
         double preparedSampleRate = 0.0;
+        double preparedHeadEnergyRatio = 1.0;
         std::function<bool()> shouldCancel;
         // LoaderThread ステートマシン (incremental 経路専用)
         std::unique_ptr<LoaderThread> incrementalLoader;
         bool loaderInitialized = false;
+        int nextStepKind = 0;   // 次に走るステップの種類 (IncrementalStepKind, スライス予算の見積りキー)
         StereoConvolver* pendingConv = nullptr;
         juce::AudioBuffer<double> pendingLoadedIR;
         double pendingLoadedSR = 0.0;
@@ -611,6 +885,20 @@ private:
     bool runIncrementalBuildStep(IncrementalRebuildJob& job);
     bool runIncrementalFinalizeStep(IncrementalRebuildJob& job);
 
+    // Incremental rebuild のステップ種類: LoaderThread の 4 段 (LoadIR/Trim/Transform/Build) + 適用
+    static constexpr int kIncrementalStepKinds = 5;
+    static constexpr int kIncrementalFinalizeStepKind = kIncrementalStepKinds - 1;
+    // スライス周期 (実行 + 休止)、休止の上限、休止中に取り消しを確認する間隔
+    static constexpr uint64_t kIncrementalSlicePeriodUs = 16000;
+    static constexpr uint64_t kIncrementalMaxRestUs = 250000;
+    static constexpr uint64_t kIncrementalRestPollUs = 2000;
+
+    // rebuild worker 上で beginIncrementalRebuild → advanceIncrementalRebuild を完了まで回す
+    IncrementalRebuildSliceResult runIncrementalRebuild(std::function<bool()> shouldCancel);
+    // ステップ所要時間の見積り。DSPCore ごとに作り直されるインスタンスをまたいで引き継ぐ (プロセス共有)
+    static convo::AdaptiveSliceBudget<kIncrementalStepKinds>& sharedRebuildSliceEstimates() noexcept;
+    static std::mutex& sharedRebuildSliceEstimatesMutex() noexcept;
+
     void commitNewConvolver(StereoConvolver* newConv,
                             std::unique_ptr<juce::AudioBuffer<double>> loadedIR,
                             double loadedSR, int targetLength, bool isRebuild,
@@ -618,6 +906,13 @@ private:
                             std::unique_ptr<juce::AudioBuffer<double>> displayIR);
 
     void switchEngineOnMessageThread(StereoConvolver* newEngine) noexcept;
+    void swapActiveEngineOnMessageThread(StereoConvolver* newEngine) noexcept;
+    bool tryBeginSpectralCrossfade(StereoConvolver* newEngine) noexcept;
+    void pollSpectralCrossfade() noexcept;
+    bool applyIrBusGains();
+    void pollIrBusFade();
+    void readIrBusGains(const StereoConvolver& engine, double* gains) const;
+    bool replaceEngineForIrBusGains(StereoConvolver* liveEngine);
 
     void applyNewStateBindStep(std::unique_ptr<juce::AudioBuffer<double>> loadedIR,
                                double loadedSR,
@@ -657,6 +952,9 @@ private:
 #endif
 
         double* irData[2] = { nullptr, nullptr };
+        // ★ True-stereo: クロスパス IR (crossIrData[0]=RL: 入力R→出力L, crossIrData[1]=LR: 入力L→出力R)
+        //   clone / 再初期化用に保持。nullptr=通常ステレオ
+        double* crossIrData[2] = { nullptr, nullptr };
 
         std::array<convo::MKLNonUniformConvolver*, 2> nucConvolvers { nullptr, nullptr };
         int irDataLength = 0;
@@ -670,9 +968,27 @@ private:
         int storedKnownBlockSize = 0;
         double storedScale = 1.0;
         bool storedDirectHeadEnabled = false;
+        bool eqFoldedIntoIR = false;            // ★ EQ fold: irData に静的 EQ 応答が焼き込み済み
         convo::FilterSpec storedFilterSpec{};
         bool hasStoredFilterSpec = false;       // filterSpec==nullptr と {} を区別
 
+        // ★ Spectral crossfade: IR スペクトルをフェード中の次世代エンジン (所有, Audio Thread へは未公開)。
+        //   Message Thread のみ。非 nullptr の間は IR メタデータ (clone 元) の権威が spectralFadeTarget 側にある。
+        StereoConvolver* spectralFadeTarget = nullptr;
+        uint32_t spectralFadeDeadlineMs = 0;    // Audio Thread が処理していない場合に通常交換へ切り替える期限
+
+        // ★ IR bus: NUC の spectral bus が保持する追加 IR (clone / 再初期化用, irDataLength 長)。
+        //   irBusBaked=true は追加 IR を irData へ時間領域で加算済み (ゲイン焼き込み, irBusData は空)
+        double* irBusData[kMaxIrBusEntries][2] {};
+        double irBusGains[kMaxIrBusEntries] {};
+        int irBusEntryIndex[kMaxIrBusEntries] {};
+        int irBusCount = 0;
+        bool irBusBaked = false;
+        uint32_t irBusFadeDeadlineMs = 0;       // 0=ゲインフェードなし。pollIrBusFade が期限切れで通常交換へ切り替える
+
+        // ★ Spectral morph: NUC が接続中のモーフ先 IR (clone / 再初期化用, irDataLength 長。未接続は nullptr)
+        double* morphIrData[2] {};
+
         StereoConvolver()
         {
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
@@ -693,15 +1009,50 @@ private:
         // 二重 retire 防止フラグ
         std::atomic<bool> retired { false };
 
+        // 破棄で OS に返る見込みの量 (BulkReleaseQueue の閾値判定用。フェード先を含む)
+        static uint64_t estimateReleaseBytes(const StereoConvolver* sc) noexcept
+        {
+            if (!sc) return 0;
+            uint64_t bytes = estimateReleaseBytes(sc->spectralFadeTarget);
+            for (const auto* nuc : sc->nucConvolvers)
+                if (nuc != nullptr)
+                    bytes += nuc->estimateReleaseBytes();
+            for (const double* ir : { sc->irData[0], sc->irData[1], sc->crossIrData[0], sc->crossIrData[1] })
+                if (ir != nullptr)
+                    bytes += static_cast<uint64_t>(sc->irDataLength) * sizeof(double);
+            for (int i = 0; i < sc->irBusCount; ++i)
+                bytes += 2 * static_cast<uint64_t>(sc->irDataLength) * sizeof(double);
+            if (sc->hasSpectralMorphSource())
+                bytes += 2 * static_cast<uint64_t>(sc->irDataLength) * sizeof(double);
+            return bytes;
+        }
+
         // リソース解放を一括で行う静的関数（retire コールバック用）
+        // ★ 大きなものは BulkReleaseQueue 経由で DeferredFreeThread が小分けに解放する
+        //   (回収を呼んだ Message / rebuild スレッドでページ解放を待たない)。受け手がなければその場で解放。
         static void destroyStereoConvolver(void* p) noexcept
         {
             auto* sc = static_cast<StereoConvolver*>(p);
             if (!sc) return;
-            destroyNUCConvolver(sc->nucConvolvers[0]);
+            if (convo::BulkReleaseQueue::global().tryDefer(sc, releaseStereoConvolverNow, estimateReleaseBytes(sc)))
+                return;
+            releaseStereoConvolverNow(sc);
+        }
+
+        static void releaseStereoConvolverNow(void* p) noexcept
+        {
+            auto* sc = static_cast<StereoConvolver*>(p);
+            if (!sc) return;
+            // 未公開のフェード先は RCU を経由せず同時に破棄してよい
+            releaseStereoConvolverNow(std::exchange(sc->spectralFadeTarget, nullptr));
+            // ★ Stereo: ch1 は ch0 の IR スペクトルを参照し得るため ch1 → ch0 の順で破棄する
             destroyNUCConvolver(sc->nucConvolvers[1]);
+            destroyNUCConvolver(sc->nucConvolvers[0]);
             if (sc->irData[0]) { convo::aligned_free(sc->irData[0]); sc->irData[0] = nullptr; }
             if (sc->irData[1]) { convo::aligned_free(sc->irData[1]); sc->irData[1] = nullptr; }
+            if (sc->crossIrData[0]) { convo::aligned_free(sc->crossIrData[0]); sc->crossIrData[0] = nullptr; }
+            if (sc->crossIrData[1]) { convo::aligned_free(sc->crossIrData[1]); sc->crossIrData[1] = nullptr; }
+            sc->releaseIrBusData();
             sc->~StereoConvolver();
             convo::aligned_free(sc);
         }
@@ -721,6 +1072,9 @@ private:
             #if JUCE_DEBUG
             jassert(nucConvolvers[0] == nullptr && nucConvolvers[1] == nullptr);
             jassert(irData[0] == nullptr && irData[1] == nullptr);
+            jassert(crossIrData[0] == nullptr && crossIrData[1] == nullptr);
+            jassert(irBusCount == 0);
+            jassert(morphIrData[0] == nullptr && morphIrData[1] == nullptr);
             #endif
         }
 
@@ -733,7 +1087,8 @@ private:
         bool init(double* irL, double* irR, int length, double sr, int peakDelay, int knownBlockSize, int preferredCallSize, double scale = 1.0,
               bool enableDirectHead = false,
               const convo::FilterSpec* filterSpec = nullptr,
-              ConvolverProcessor* ownerProcessor = nullptr)
+              ConvolverProcessor* ownerProcessor = nullptr,
+              const StereoConvolver* spectraDonor = nullptr)
         {
             // ============================================================
             // ★ Bug H: Strong Exception Guarantee 実現
@@ -749,17 +1104,41 @@ private:
             auto newNuc0 = convo::aligned_make_unique<convo::MKLNonUniformConvolver>();
             auto newNuc1 = convo::aligned_make_unique<convo::MKLNonUniformConvolver>();
 
-            if (!newNuc0->SetImpulse(newIrL.get(), length, knownBlockSize, scale, enableDirectHead, filterSpec))
+            // ★ Partition culling: 末尾間引き長を L/R の長い方に揃え、レイヤー構成を一致させる
+            //   (チャンネル別に縮むと isStereoPairCompatible が偽になり融合ステレオ経路を失うため)。
+            convo::FilterSpec pairSpec{};
+            if (filterSpec != nullptr
+                && filterSpec->partitionCullFloorDb > convo::FilterSpec::kPartitionCullDisabledDb
+                && filterSpec->partitionCullLength <= 0)
+            {
+                pairSpec = *filterSpec;
+                pairSpec.partitionCullLength = juce::jmax(
+                    convo::MKLNonUniformConvolver::computeCulledIRLength(newIrL.get(), length, knownBlockSize, filterSpec->partitionCullFloorDb),
+                    convo::MKLNonUniformConvolver::computeCulledIRLength(newIrR.get(), length, knownBlockSize, filterSpec->partitionCullFloorDb));
+                filterSpec = &pairSpec;
+            }
+
+            // ★ Shared spectra: 旧世代 (spectraDonor) と入力が一致するチャンネルは IR スペクトルを共有し FFT を省く
+            //   (Message Thread のみ。donor はこの呼び出し中 retire されない)
+            const convo::MKLNonUniformConvolver* donorNuc0 = (spectraDonor != nullptr) ? spectraDonor->nucConvolvers[0] : nullptr;
+            const convo::MKLNonUniformConvolver* donorNuc1 = (spectraDonor != nullptr) ? spectraDonor->nucConvolvers[1] : nullptr;
+
+            if (!newNuc0->SetImpulse(newIrL.get(), length, knownBlockSize, scale, enableDirectHead, filterSpec, donorNuc0))
             {
                 DBG("Convolver: init failed - SetImpulse ch0 failed");
                 return false;
             }
-            if (!newNuc1->SetImpulse(newIrR.get(), length, knownBlockSize, scale, enableDirectHead, filterSpec))
+            if (!newNuc1->SetImpulse(newIrR.get(), length, knownBlockSize, scale, enableDirectHead, filterSpec, donorNuc1))
             {
                 DBG("Convolver: init failed - SetImpulse ch1 failed");
                 return false;
             }
 
+            // ★ Stereo: L/R 同一 IR の場合は ch1 が ch0 の IR スペクトルを共有する (IR メモリ半減)。
+            //   newNuc1 は newNuc0 より後に宣言されているため、失敗時のローカル破棄順も ch1 → ch0 となる。
+            if (std::memcmp(newIrL.get(), newIrR.get(), static_cast<size_t>(length) * sizeof(double)) == 0)
+                newNuc1->shareImpulseSpectraFrom(*newNuc0);
+
             // ============================================================
             // Phase 2: 全成功 — メンバーを一括更新（commit）
             //
@@ -774,11 +1153,14 @@ private:
             // getLatency は commit 前に取得（将来変更への耐性）
             const int newLatency = newNuc0->getLatency();
 
-            // 既存リソースを解放
-            destroyNUCConvolver(nucConvolvers[0]);
+            // 既存リソースを解放 (IR 共有のため ch1 → ch0 の順)
             destroyNUCConvolver(nucConvolvers[1]);
+            destroyNUCConvolver(nucConvolvers[0]);
             if (irData[0]) { convo::aligned_free(irData[0]); irData[0] = nullptr; }
             if (irData[1]) { convo::aligned_free(irData[1]); irData[1] = nullptr; }
+            if (crossIrData[0]) { convo::aligned_free(crossIrData[0]); crossIrData[0] = nullptr; }
+            if (crossIrData[1]) { convo::aligned_free(crossIrData[1]); crossIrData[1] = nullptr; }
+            releaseIrBusData();     // 新しい NUC は bus・モーフ未接続 (attachOrBakeIrBus で付け直す)
 
             // 一括コミット
             irData[0] = newIrL.release();
@@ -805,10 +1187,58 @@ private:
             return true;
         }
 
+        //----------------------------------------------------------
+        // attachTrueStereoCross  ─ Message Thread / Loader Thread (init 成功直後、公開前)
+        // True-stereo 4ch IR のクロスパス (RL, LR) を追加する。所有権は常に引き取る。
+        // クロスパス用 NUC は init と同一パラメータで SetImpulse し、IR スペクトルのみを
+        // 各チャンネルへ移譲する (FDL はチャンネル間で共有されるため追加の FFT は発生しない)。
+        // @return true=4 パス有効, false=2 パスのまま (Direct Head / Tail Worker 有効時、確保失敗時)
+        //----------------------------------------------------------
+        bool attachTrueStereoCross(double* irRL, double* irLR)
+        {
+            convo::ScopedAlignedArray<double> newRL(irRL);
+            convo::ScopedAlignedArray<double> newLR(irLR);
+            if (!newRL || !newLR || !nucConvolvers[0] || !nucConvolvers[1] || irDataLength <= 0 || storedDirectHeadEnabled)
+                return false;
+
+            const convo::FilterSpec* spec = hasStoredFilterSpec ? &storedFilterSpec : nullptr;
+            auto donor0 = convo::aligned_make_unique<convo::MKLNonUniformConvolver>();
+            auto donor1 = convo::aligned_make_unique<convo::MKLNonUniformConvolver>();
+            if (!donor0->SetImpulse(newRL.get(), irDataLength, storedKnownBlockSize, storedScale, false, spec)
+                || !donor1->SetImpulse(newLR.get(), irDataLength, storedKnownBlockSize, storedScale, false, spec))
+            {
+                DBG("Convolver: true-stereo cross SetImpulse failed");
+                return false;
+            }
+
+            if (!nucConvolvers[0]->adoptCrossSpectraFrom(*donor0))
+                return false;
+            if (!nucConvolvers[1]->adoptCrossSpectraFrom(*donor1))
+            {
+                // ch0 のみクロス保持の状態は AddStereo の互換判定でチャンネル別処理 (2 パス) になる
+                DBG("Convolver: true-stereo cross adopt ch1 failed");
+                return false;
+            }
+
+            crossIrData[0] = newRL.release();
+            crossIrData[1] = newLR.release();
+            DBG("Convolver: True-stereo (4-path) active");
+            return true;
+        }
+
+        [[nodiscard]] bool isTrueStereo() const noexcept
+        {
+            return crossIrData[0] != nullptr && crossIrData[1] != nullptr;
+        }
+
         // Deep Copyを作成する。
         // 失敗時 (MKLメモリ確保失敗等) は nullptr を返す。呼び出し元で必ずチェックすること。
         [[nodiscard]] StereoConvolver* clone() const
         {
+            // ★ Spectral crossfade: フェード中は確定予定の IR (フェード先) を複製する
+            if (spectralFadeTarget != nullptr)
+                return spectralFadeTarget->clone();
+
             try
             {
                 auto newConv = convo::aligned_make_unique<StereoConvolver>();
@@ -821,8 +1251,28 @@ private:
                     std::memcpy(l.get(), irData[0], irDataLength * sizeof(double));
                     std::memcpy(r.get(), irData[1], irDataLength * sizeof(double));
 
-                    if (!newConv->init(l.release(), r.release(), irDataLength, storedSampleRate, irLatency, storedKnownBlockSize, callQuantumSamples, storedScale, storedDirectHeadEnabled, hasStoredFilterSpec ? &storedFilterSpec : nullptr))
+                    if (!newConv->init(l.release(), r.release(), irDataLength, storedSampleRate, irLatency, storedKnownBlockSize, callQuantumSamples, storedScale, storedDirectHeadEnabled, hasStoredFilterSpec ? &storedFilterSpec : nullptr, nullptr, this))
                         return nullptr;
+
+                    if (isTrueStereo())
+                    {
+                        auto rl = convo::makeAlignedArray<double>(static_cast<size_t>(irDataLength));
+                        auto lr = convo::makeAlignedArray<double>(static_cast<size_t>(irDataLength));
+                        std::memcpy(rl.get(), crossIrData[0], irDataLength * sizeof(double));
+                        std::memcpy(lr.get(), crossIrData[1], irDataLength * sizeof(double));
+                        newConv->attachTrueStereoCross(rl.release(), lr.release());
+                    }
+                    newConv->eqFoldedIntoIR = eqFoldedIntoIR;
+                    newConv->irBusBaked = irBusBaked;
+                    if (irBusCount > 0 || hasSpectralMorphSource())
+                    {
+                        IrBusSources bus;
+                        if (!copyIrBusSources(bus) || !newConv->attachOrBakeIrBus(bus))
+                        {
+                            releaseStereoConvolverNow(newConv.release());   // init 済みの資源ごと破棄 (未公開)
+                            return nullptr;
+                        }
+                    }
                 }
                 return newConv.release();
             }
@@ -842,8 +1292,353 @@ private:
             return true;
         }
 
+        //----------------------------------------------------------
+        // Spectral crossfade  ─ Message Thread のみ
+        // IR 切替時、稼働中の本エンジンを交換せず両チャンネルの NUC で IR スペクトルのみを target へフェードする
+        // (入力 FDL を共有するため FFT/IFFT は 1 系統、MAC のみ 2 倍)。
+        // canSpectralCrossfadeTo   : レイテンシ・IR ピーク遅延・呼び出し量子・サンプルレート・NUC レイヤー構成が
+        //                            一致するか (True-stereo・モーフ先を持つ target は非対応)
+        // beginSpectralCrossfadeTo : 成功時のみ target の所有権を引き取る。片チャンネルのみ開始して失敗した場合は
+        //                            false を返し、呼び出し元は通常のエンジン交換で本エンジンごと retire すること
+        // commitSpectralCrossfade  : 両チャンネル完了後、IR メタデータを target と入れ替えて target (旧 IR) を破棄する
+        // detachSpectralFadeTarget : フェード先の所有権を呼び出し元へ返す (通常交換へのフォールバック用)
+        //----------------------------------------------------------
+        [[nodiscard]] bool canSpectralCrossfadeTo(const StereoConvolver& target) const noexcept
+        {
+            if (spectralFadeTarget != nullptr || target.spectralFadeTarget != nullptr
+                || isTrueStereo() || target.isTrueStereo()
+                || target.hasSpectralMorphSource()                   // commit はモーフ接続を引き継がない (自側は NUC が拒否)
+                || latency != target.latency || irLatency != target.irLatency
+                || callQuantumSamples != target.callQuantumSamples   // Audio Thread が参照するため入れ替えない
+                || storedSampleRate != target.storedSampleRate
+                || storedKnownBlockSize != target.storedKnownBlockSize)
+                return false;
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                if (nucConvolvers[ch] == nullptr || target.nucConvolvers[ch] == nullptr
+                    || !nucConvolvers[ch]->isSpectralCrossfadeCompatible(*target.nucConvolvers[ch]))
+                    return false;
+            }
+            return true;
+        }
+
+        bool beginSpectralCrossfadeTo(StereoConvolver* target, int fadeSamples) noexcept
+        {
+            if (target == nullptr || !canSpectralCrossfadeTo(*target))
+                return false;
+            if (!nucConvolvers[0]->beginSpectralCrossfade(*target->nucConvolvers[0], fadeSamples))
+                return false;
+            if (!nucConvolvers[1]->beginSpectralCrossfade(*target->nucConvolvers[1], fadeSamples))
+                return false;
+            spectralFadeTarget = target;
+            return true;
+        }
+
+        [[nodiscard]] bool isSpectralCrossfadeComplete() const noexcept
+        {
+            return spectralFadeTarget != nullptr
+                && nucConvolvers[0]->isSpectralCrossfadeComplete()
+                && nucConvolvers[1]->isSpectralCrossfadeComplete();
+        }
+
+        [[nodiscard]] int64_t getSpectralCrossfadeLengthSamples() const noexcept
+        {
+            return juce::jmax(nucConvolvers[0]->getSpectralCrossfadeLengthSamples(),
+                              nucConvolvers[1]->getSpectralCrossfadeLengthSamples());
+        }
+
+        void commitSpectralCrossfade() noexcept
+        {
+            if (!isSpectralCrossfadeComplete())
+                return;
+
+            nucConvolvers[0]->finishSpectralCrossfade();
+            nucConvolvers[1]->finishSpectralCrossfade();
+
+            // NUC は新スペクトルで稼働中。clone / 再初期化用のメタデータを target と入れ替える
+            StereoConvolver* target = std::exchange(spectralFadeTarget, nullptr);
+            std::swap(irData[0], target->irData[0]);
+            std::swap(irData[1], target->irData[1]);
+            std::swap(irDataLength, target->irDataLength);
+            std::swap(storedScale, target->storedScale);
+            std::swap(storedDirectHeadEnabled, target->storedDirectHeadEnabled);
+            std::swap(eqFoldedIntoIR, target->eqFoldedIntoIR);
+            std::swap(storedFilterSpec, target->storedFilterSpec);
+            std::swap(hasStoredFilterSpec, target->hasStoredFilterSpec);
+            std::swap(irBusBaked, target->irBusBaked);  // bus 接続中は canSpectralCrossfadeTo が偽のため irBusData は常に空
+
+            retireStereoConvolver(target, nullptr);  // 未公開のため即時破棄 (旧 IR データを保持)
+        }
+
+        [[nodiscard]] StereoConvolver* detachSpectralFadeTarget() noexcept
+        {
+            return std::exchange(spectralFadeTarget, nullptr);
+        }
+
+        //----------------------------------------------------------
+        // IR bus  ─ Message Thread / Loader Thread (公開前。ゲイン変更のみ公開後の Message Thread)
+        // attachIrBus       : 追加 IR ごとに init と同一パラメータで SetImpulse し、両チャンネルの NUC の
+        //                     spectral bus へ接続する (FDL・FFT・MAC は 1 系統のまま)。成功時のみ所有権を引き取る。
+        //                     Direct Head / True-stereo / 非互換 (Far-tail paging 等) は false
+        // bakeIrBus         : 追加 IR を g 倍して irData へ加算し再初期化する (attachIrBus 不可の構成用)
+        // beginIrBusGains   : 合成し直したスペクトルへ両チャンネルでフェードを開始する。
+        //                     false の場合、片チャンネルのみ開始していることがあるため呼び出し元は clone で交換すること
+        //----------------------------------------------------------
+        [[nodiscard]] bool isIrBusLive() const noexcept
+        {
+            return irBusCount > 0;
+        }
+
+        [[nodiscard]] bool hasSpectralMorphSource() const noexcept
+        {
+            return morphIrData[0] != nullptr;
+        }
+
+        // bus の追加 IR とモーフ先 IR (時間領域の控え) を解放する。NUC 側の接続は NUC と共に破棄される
+        void releaseIrBusData() noexcept
+        {
+            for (int i = 0; i < irBusCount; ++i)
+                for (auto*& ir : irBusData[i])
+                    if (ir) { convo::aligned_free(ir); ir = nullptr; }
+            irBusCount = 0;
+            irBusFadeDeadlineMs = 0;
+            releaseSpectralMorphSource();
+        }
+
+        void releaseSpectralMorphSource() noexcept
+        {
+            for (auto*& ir : morphIrData)
+                if (ir) { convo::aligned_free(ir); ir = nullptr; }
+        }
+
+        [[nodiscard]] bool copyIrBusSources(IrBusSources& out) const noexcept
+        {
+            out.count = 0;
+            for (int i = 0; i < irBusCount; ++i)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    out.data[i][ch] = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(irDataLength));
+                    if (!out.data[i][ch])
+                        return false;
+                    std::memcpy(out.data[i][ch].get(), irBusData[i][ch], static_cast<size_t>(irDataLength) * sizeof(double));
+                }
+                out.gains[i] = irBusGains[i];
+                out.entryIndex[i] = irBusEntryIndex[i];
+                out.count = i + 1;
+            }
+            for (int ch = 0; ch < 2 && hasSpectralMorphSource(); ++ch)
+            {
+                out.morph[ch] = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(irDataLength));
+                if (!out.morph[ch])
+                    return false;
+                std::memcpy(out.morph[ch].get(), morphIrData[ch], static_cast<size_t>(irDataLength) * sizeof(double));
+            }
+            return true;
+        }
+
+        bool attachIrBus(IrBusSources& sources)
+        {
+            if (sources.count <= 0 || sources.count > kMaxIrBusEntries || irBusCount != 0 || irBusBaked
+                || !nucConvolvers[0] || !nucConvolvers[1] || irDataLength <= 0
+                || storedDirectHeadEnabled || isTrueStereo() || spectralFadeTarget != nullptr)
+                return false;
+
+            const convo::FilterSpec* spec = hasStoredFilterSpec ? &storedFilterSpec : nullptr;
+            std::array<std::array<convo::aligned_unique_ptr<convo::MKLNonUniformConvolver>, kMaxIrBusEntries>, 2> inputs;
+            std::array<std::array<const convo::MKLNonUniformConvolver*, kMaxIrBusEntries>, 2> inputPtrs {};
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < sources.count; ++i)
+                {
+                    auto& input = inputs[static_cast<size_t>(ch)][static_cast<size_t>(i)];
+                    input = convo::aligned_make_unique<convo::MKLNonUniformConvolver>();
+                    if (!sources.data[i][ch]
+                        || !input->SetImpulse(sources.data[i][ch].get(), irDataLength, storedKnownBlockSize, storedScale, false, spec)
+                        || !nucConvolvers[static_cast<size_t>(ch)]->isSpectralCrossfadeCompatible(*input))
+                        return false;
+                    inputPtrs[static_cast<size_t>(ch)][static_cast<size_t>(i)] = input.get();
+                }
+            }
+
+            double gains[convo::MKLNonUniformConvolver::kMaxSpectralBusInputs] { 1.0 };
+            std::copy(sources.gains, sources.gains + sources.count, gains + 1);
+            if (!nucConvolvers[0]->attachSpectralBus(inputPtrs[0].data(), sources.count, gains))
+                return false;
+            if (!nucConvolvers[1]->attachSpectralBus(inputPtrs[1].data(), sources.count, gains))
+            {
+                // ch0 のみ接続済み: 呼び出し元の bakeIrBus (再初期化) で NUC ごと作り直される
+                DBG("Convolver: IR bus attach ch1 failed");
+                return false;
+            }
+
+            for (int i = 0; i < sources.count; ++i)
+            {
+                irBusData[i][0] = sources.data[i][0].release();
+                irBusData[i][1] = sources.data[i][1].release();
+                irBusGains[i] = sources.gains[i];
+                irBusEntryIndex[i] = sources.entryIndex[i];
+            }
+            irBusCount = sources.count;
+            DBG("Convolver: IR bus active (" << irBusCount << " extra IRs)");
+            return true;
+        }
+
+        bool bakeIrBus(const IrBusSources& sources)
+        {
+            if (irDataLength <= 0 || !irData[0] || !irData[1] || isTrueStereo())
+                return false;
+
+            auto l = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(irDataLength));
+            auto r = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(irDataLength));
+            if (!l || !r)
+                return false;
+            std::memcpy(l.get(), irData[0], static_cast<size_t>(irDataLength) * sizeof(double));
+            std::memcpy(r.get(), irData[1], static_cast<size_t>(irDataLength) * sizeof(double));
+            for (int i = 0; i < sources.count; ++i)
+            {
+                if (!sources.data[i][0] || !sources.data[i][1] || sources.gains[i] == 0.0)
+                    continue;
+                juce::FloatVectorOperations::addWithMultiply(l.get(), sources.data[i][0].get(), sources.gains[i], irDataLength);
+                juce::FloatVectorOperations::addWithMultiply(r.get(), sources.data[i][1].get(), sources.gains[i], irDataLength);
+            }
+
+            // init は bus・クロスパスを含む旧資源を解放する。irLatency は主 IR のピーク位置を維持する
+            const convo::FilterSpec spec = storedFilterSpec;
+            if (!init(l.release(), r.release(), irDataLength, storedSampleRate, irLatency, storedKnownBlockSize, callQuantumSamples,
+                      storedScale, storedDirectHeadEnabled, hasStoredFilterSpec ? &spec : nullptr))
+                return false;
+            irBusBaked = true;
+            return true;
+        }
+
+        // bus はモーフ先があれば焼き込む (spectral bus 接続中の NUC は morph を受け付けない)。
+        // モーフ先を接続できなくても主 IR (+ bus) で継続する。@return false=bus を反映できなかった
+        bool attachOrBakeIrBus(IrBusSources& sources)
+        {
+            bool busApplied = true;
+            if (sources.count > 0)
+                busApplied = (!sources.hasMorph() && attachIrBus(sources)) || bakeIrBus(sources);
+            if (sources.hasMorph() && !attachSpectralMorph(sources))
+                DBG("Convolver: spectral morph target could not be attached");
+            return busApplied;
+        }
+
+        bool beginIrBusGains(const double* gains, int fadeSamples) noexcept
+        {
+            if (irBusCount <= 0 || irBusFadeDeadlineMs != 0 || spectralFadeTarget != nullptr)
+                return false;
+
+            double mix[convo::MKLNonUniformConvolver::kMaxSpectralBusInputs] { 1.0 };
+            std::copy(gains, gains + irBusCount, mix + 1);
+            std::copy(gains, gains + irBusCount, irBusGains);   // clone は常に最新のゲインで作る
+            return nucConvolvers[0]->setSpectralBusGains(mix, fadeSamples)
+                && nucConvolvers[1]->setSpectralBusGains(mix, fadeSamples);
+        }
+
+        [[nodiscard]] bool isIrBusFadeComplete() const noexcept
+        {
+            return irBusFadeDeadlineMs != 0
+                && nucConvolvers[0]->isSpectralCrossfadeComplete()
+                && nucConvolvers[1]->isSpectralCrossfadeComplete();
+        }
+
+        void commitIrBusFade() noexcept
+        {
+            if (!isIrBusFadeComplete())
+                return;
+            nucConvolvers[0]->finishSpectralCrossfade();
+            nucConvolvers[1]->finishSpectralCrossfade();
+            irBusFadeDeadlineMs = 0;
+        }
+
+        //----------------------------------------------------------
+        // Spectral morph  ─ Message Thread / Loader Thread (公開前。end / finish は公開後の Message Thread)
+        // attachSpectralMorph : モーフ先 IR を init と同一パラメータで SetImpulse し、両チャンネルの NUC へ
+        //                       接続する (スペクトルは NUC が retain し、一時 NUC は破棄)。成功時のみ所有権を引き取り、
+        //                       clone / 再初期化で付け直せるよう morphIrData に控える。
+        //                       Direct Head / True-stereo / bus 接続中 / 非互換 (Far-tail paging 等) は false
+        // setSpectralMorphAmount : 任意スレッド (ConvolverProcessor::process がブロック毎に渡す)
+        // endSpectralMorph    : 解除を要求し控えを解放する (以降の clone はモーフなし)
+        // finishSpectralMorph : 両チャンネルが解除を観測したら NUC の資源を返して true (未接続も true)
+        //----------------------------------------------------------
+        bool attachSpectralMorph(IrBusSources& sources)
+        {
+            if (!sources.hasMorph() || hasSpectralMorphSource() || isIrBusLive()
+                || !nucConvolvers[0] || !nucConvolvers[1] || irDataLength <= 0
+                || storedDirectHeadEnabled || isTrueStereo() || spectralFadeTarget != nullptr)
+                return false;
+
+            const convo::FilterSpec* spec = hasStoredFilterSpec ? &storedFilterSpec : nullptr;
+            std::array<convo::aligned_unique_ptr<convo::MKLNonUniformConvolver>, 2> targets;
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                auto& target = targets[static_cast<size_t>(ch)];
+                target = convo::aligned_make_unique<convo::MKLNonUniformConvolver>();
+                if (!target->SetImpulse(sources.morph[ch].get(), irDataLength, storedKnownBlockSize, storedScale, false, spec))
+                    return false;
+            }
+
+            const int rampSamples = juce::roundToInt(storedSampleRate * SPECTRAL_MORPH_RAMP_SEC);
+            if (!nucConvolvers[0]->beginSpectralMorph(*targets[0], rampSamples))
+                return false;
+            if (!nucConvolvers[1]->beginSpectralMorph(*targets[1], rampSamples))
+            {
+                // ch0 の接続資源は cleanup の finishSpectralMorph か NUC の破棄で返る
+                nucConvolvers[0]->endSpectralMorph();
+                DBG("Convolver: spectral morph attach ch1 failed");
+                return false;
+            }
+
+            morphIrData[0] = sources.morph[0].release();
+            morphIrData[1] = sources.morph[1].release();
+            DBG("Convolver: spectral morph active");
+            return true;
+        }
+
+        [[nodiscard]] bool isSpectralMorphActive() const noexcept
+        {
+            return nucConvolvers[0] != nullptr && nucConvolvers[0]->isSpectralMorphActive();
+        }
+
+        void setSpectralMorphAmount(double amount) noexcept
+        {
+            for (const auto& conv : nucConvolvers)
+                if (conv)
+                    conv->setSpectralMorphAmount(amount);
+        }
+
+        void endSpectralMorph() noexcept
+        {
+            for (const auto& conv : nucConvolvers)
+                if (conv)
+                    conv->endSpectralMorph();
+            releaseSpectralMorphSource();
+        }
+
+        bool finishSpectralMorph() noexcept
+        {
+            bool finished = true;
+            for (const auto& conv : nucConvolvers)
+                if (conv)
+                    finished = conv->finishSpectralMorph() && finished;
+            return finished;
+        }
+
+        using MixGains = convo::MKLNonUniformConvolver::MixGains;
+
         void reset();
-        void process(int channel, const double* in, double* out, int numSamples);
+        // ★ Fused mix: 畳み込み結果を中間 wet バッファへ出さず、MKLNonUniformConvolver::GetMix で
+        //   out = wet * wetGain + dry * dryGain を直接書く。in と out は同一でもよい (Add が先に読み終える)
+        void process(int channel, const double* in, const double* dry, double* out, int numSamples, const MixGains& gains);
+        // ★ Stereo: L/R を MKLNonUniformConvolver::AddStereo で一括処理する
+        void processStereo(const double* inL, const double* inR, const double* dryL, const double* dryR,
+                           double* outL, double* outR, int numSamples, const MixGains& gains);
+        // ★ Channel split: R を split の helper、L を呼び出しスレッドで callLen ごとに process() する。
+        //   AddStereo の融合 MAC は使わない (2 コアで並行に回すほうがクリティカルパスが短い)
+        void processStereoSplit(const double* inL, const double* inR, const double* dryL, const double* dryR,
+                                double* outL, double* outR, int numSamples, int callLen,
+                                const MixGains& gains, convo::ChannelForkJoin& split);
     };
 
     // PendingCommit: applyNewState のコミット段階で保持するデータ。
@@ -877,6 +1672,9 @@ private:
     std::atomic<bool> irFinalized { false };
     std::atomic<bool> useIncrementalRebuild { false };
     std::unique_ptr<IncrementalRebuildJob> rebuildJob;
+    std::atomic<int> incrementalRebuildPriority { static_cast<int>(IncrementalRebuildPriority::Normal) };
+    // ジョブ中の見積り (rebuild worker 専用)。開始時に共有見積りから写し、終了時に書き戻す
+    convo::AdaptiveSliceBudget<kIncrementalStepKinds> rebuildSliceBudget;
     std::unique_ptr<LoaderThread> activeLoader;
     std::deque<std::unique_ptr<LoaderThread>> loaderTrashBin;
     std::atomic<float> loadProgress { 0.0f };
@@ -891,12 +1689,19 @@ private:
     //----------------------------------------------------------
     // レイテンシー補正用ディレイ
     //----------------------------------------------------------
-    // juce::dsp::DelayLine<double> delayLine; // Replaced with custom AVX2 ring buffer
-    convo::ScopedAlignedPtr<double> delayBuffer[2]; // L/R separate buffers
-    int delayBufferCapacity = 0;
+    struct AlignedDelayAllocator
+    {
+        static double* allocate(size_t count) noexcept
+        {
+            return static_cast<double*>(convo::aligned_malloc_nothrow(count * sizeof(double), 64));
+        }
+        static void deallocate(double* ptr) noexcept { convo::aligned_free(ptr); }
+    };
+    // Dry 経路・バイパス経路で共用する補正リング。prepareToPlay で L0 遅延分を確保し、
+    // refreshLatency が IR ピークを含む実際の遅延まで伸ばす (dsp/LatencyDelayLine.h)
     // ★ bug3-6: API 契約: reset() は Audio Thread 停止後にのみ呼び出すこと。
     //   Audio Thread 実行中に reset() を呼び出すとデータレースが発生する。
-    int delayWritePos = 0;
+    convo::dsp::LatencyDelayLine<AlignedDelayAllocator> latencyDelay;
     convo::LinearRamp latencySmoother;
     // [Issue 2 fix] latencySmoother のスレッドセーフティ向上のためのペンディングフラグ。
     // refreshLatency() (Message/Rebuild Thread) は直接 SmoothedValue を触らず、
@@ -939,6 +1744,7 @@ private:
         bool bypassed { false };
         float mixTarget { 1.0f };
         float smoothingTimeSec { SMOOTHING_TIME_DEFAULT_SEC };
+        float spectralMorphAmount { 0.0f };
         double currentSampleRate { 0.0 };
     };
 
@@ -958,7 +1764,16 @@ private:
         float mixedTransitionStartHz = MIXED_F1_DEFAULT_HZ;
         float mixedTransitionEndHz = MIXED_F2_DEFAULT_HZ;
         int rebuildDebounceMs = REBUILD_DEBOUNCE_DEFAULT_MS;
-        bool experimentalDirectHeadEnabled = false;
+        bool zeroLatencyHeadEnabled = false;
+        bool tailWorkerOffloadEnabled = false;
+        bool trueStereoEnabled = true;
+        bool compactTailSpectraEnabled = false;
+        bool multirateTailEnabled = false;
+        bool layoutAutoTuneEnabled = false;
+        bool spectralCrossfadeEnabled = false;
+        bool streamingIRActivationEnabled = false;
+        float partitionCullFloorDb = PARTITION_CULL_FLOOR_DEFAULT_DB;
+        float farTailHorizonSec = FAR_TAIL_HORIZON_DEFAULT_SEC;
         int tailMode = static_cast<int>(TailMode::LayerTailContouring);
         float tailStartSec = TAIL_START_DEFAULT_SEC;
         float tailStrength = TAIL_STRENGTH_DEFAULT;
@@ -968,6 +1783,12 @@ private:
         int maxCacheEntries = 0;
         int nucHCMode = static_cast<int>(convo::HCMode::Natural);
         int nucLCMode = static_cast<int>(convo::LCMode::Natural);
+        bool eqFoldEnabled = false;
+        convo::EQParameters eqFoldParams {};
+        std::array<IrBusEntry, kMaxIrBusEntries> irBus {};
+        int irBusCount = 0;
+        float spectralMorphAmount = 0.0f;
+        juce::File spectralMorphFile;
     };
 
     alignas(64) RuntimeProcessSnapshot runtimeProcessSnapshots[2] {};
@@ -1026,6 +1847,7 @@ private:
             runtimeProcessSnapshots[next].bypassed       = pendingOverride.bypassed;
             runtimeProcessSnapshots[next].mixTarget      = pendingOverride.mix;
             runtimeProcessSnapshots[next].smoothingTimeSec = pendingOverride.smoothingTimeSec;
+            runtimeProcessSnapshots[next].spectralMorphAmount = pendingOverride.spectralMorphAmount;
         }
         // acquire: Message Thread の release と HB し、有効なsample rateを取得してsnapshot更新。
         runtimeProcessSnapshots[next].currentSampleRate = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
@@ -1059,6 +1881,7 @@ private:
     // This pending override is captured by rebuild requests.
     PendingOverrideStore pendingOverride;
     juce::CriticalSection pendingOverrideLock;
+    bool irBusGainsPending = false;     // Message Thread のみ: ゲインフェード中に受けた変更 (pollIrBusFade で再適用)
 
     //----------------------------------------------------------
     // IR情報
@@ -1082,6 +1905,7 @@ private:
         uint64_t generation = 0;
         float additionalAttenuationDb = 0.0f;  // ★ v14.0: IRAnalyzer による追加減衰量 [dB]
         float irFreqPeakGainDb = 0.0f;         // ★ v14.2: IRAnalyzer による周波数ピークゲイン [dB]
+        double headEnergyRatio = 1.0;          // ★ Streaming activation: ir が先頭だけのとき、全長に対するエネルギー比
     };
     std::atomic<IRState*> currentIRState { nullptr };
     // C4: rcuProvider は所有権を持たない。AudioEngine が ConvolverProcessor より必ず長生きする設計が前提
@@ -1091,13 +1915,37 @@ private:
     [[nodiscard]] AudioEngine* getRcuProvider() noexcept { return rcuProvider ? &rcuProvider->get() : nullptr; }
     [[nodiscard]] AudioEngine* getRcuProvider() const noexcept { return rcuProvider ? &rcuProvider->get() : nullptr; }
 
+    // ★ Cache prefetch: loadIR した IR を最近使用リストの先頭へ移す (Message Thread のみ)
+    void noteRecentIRFile(const juce::File& file);
+
+    // ★ Tail Worker / Compact tail: FilterSpec に L1/L2 のオフロード設定・affinity manager・float32 保持設定を反映する
+    void applyTailLayerPolicy(convo::FilterSpec& spec, const BuildSnapshot& snapshot) const noexcept;
+
+    // ★ Layout wisdom: layoutAutoTuneEnabled 時に tailL1L2Multiplier を実測最速値へ置き換える。
+    //   allowCalibration=true (Loader Thread 専用) は未計測なら計測してから適用する。
+    //   FilterSpec の確定後 (True-stereo の上書き後) に呼ぶこと (tail 構成が計測キーに含まれる)。
+    void applyLayoutWisdom(convo::FilterSpec& spec, const BuildSnapshot& snapshot,
+                           int irLength, int blockSize, bool allowCalibration) const;
+
+    // ★ True-stereo: 4ch IR から (RL, LR) クロスパスを切り出す。条件外なら両方 nullptr
+    static void extractTrueStereoCross(const juce::AudioBuffer<double>& ir, int length, const BuildSnapshot& snapshot,
+                                       convo::ScopedAlignedPtr<double>& crossRL,
+                                       convo::ScopedAlignedPtr<double>& crossLR);
+
+    // ★ IR bus: Partition culling の末尾間引き長を主 IR と追加 IR の最長に揃える (init の前に呼ぶ。
+    //   主 IR だけで決めると追加 IR の残響が切れ、spectral bus の入力とレイヤー構成も一致しなくなる)
+    static void applyIrBusCullLength(convo::FilterSpec& spec, const double* irL, const double* irR, int length,
+                                     int knownBlockSize, const IrBusSources& irBus);
+
     [[nodiscard]] const IRState* acquireIRState() const noexcept;
     void releaseIRState(const IRState* state) const noexcept;
-    void updateIRState(const juce::AudioBuffer<double>& newIR, double newSR, float additionalAttenuationDb = 0.0f, float irFreqPeakGainDb = 0.0f);
-    void updateIRState(const std::unique_ptr<juce::AudioBuffer<double>>& newIR, double newSR, float additionalAttenuationDb = 0.0f, float irFreqPeakGainDb = 0.0f)
+    void updateIRState(const juce::AudioBuffer<double>& newIR, double newSR, float additionalAttenuationDb = 0.0f, float irFreqPeakGainDb = 0.0f,
+                       double headEnergyRatio = 1.0);
+    void updateIRState(const std::unique_ptr<juce::AudioBuffer<double>>& newIR, double newSR, float additionalAttenuationDb = 0.0f, float irFreqPeakGainDb = 0.0f,
+                       double headEnergyRatio = 1.0)
     {
         if (newIR)
-            updateIRState(*newIR, newSR, additionalAttenuationDb, irFreqPeakGainDb);
+            updateIRState(*newIR, newSR, additionalAttenuationDb, irFreqPeakGainDb, headEnergyRatio);
     }
 
     // ★ v14.0: IRState から追加減衰量を読み取り
@@ -1126,7 +1974,8 @@ public: // Added for AudioEngine access
         {
             const int channels = srcState->ir->getNumChannels();
             const int length   = srcState->ir->getNumSamples();
-            updateIRState(*srcState->ir, srcState->sampleRate, srcState->additionalAttenuationDb, srcState->irFreqPeakGainDb);
+            updateIRState(*srcState->ir, srcState->sampleRate, srcState->additionalAttenuationDb, srcState->irFreqPeakGainDb,
+                          srcState->headEnergyRatio);
             juce::Logger::writeToLog("[CONV_IR] transferIRStateFrom: IR transferred ch="
                 + juce::String(channels) + " len=" + juce::String(length)
                 + " sr=" + juce::String(srcState->sampleRate, 1));
@@ -1138,6 +1987,11 @@ public: // Added for AudioEngine access
         source.releaseIRState(srcState);
     }
 
+    // ★ Shared spectra (オフライン一括レンダー): 自身に現行エンジンが無いときの共有元。
+    //   rebuildAllIRsSynchronous() の前に設定し、終わったら nullptr に戻すこと (その間 donor は退役しないこと)
+    void setExternalSpectraDonor(const ConvolverProcessor* donor) noexcept { externalSpectraDonor = donor; }
+    const ConvolverProcessor* externalSpectraDonor = nullptr;
+
     [[nodiscard]] double getCurrentIRScale() const noexcept { return convo::consumeAtomic(currentIRScale, std::memory_order_acquire); } // acquire: apply/load 側 release と HB
     std::atomic<double> currentIRScale { 1.0 }; // IRのスケールファクター (Auto Makeup + Safety Margin)
     convo::ScopedAlignedPtr<float> cachedFFTBuffer; // FFT計算用キャッシュ (Message Thread)
@@ -1168,10 +2022,6 @@ public: // Added for AudioEngine access
     convo::ScopedAlignedPtr<double> oldDryBufferStorage[2];
     int oldDryBufferCapacity = 0;
 
-    // Wet信号用一時バッファ (StereoConvolver::process用)
-    convo::ScopedAlignedPtr<double> wetBufferStorage[2];
-    int wetBufferCapacity = 0;
-
     // ★ M-05: レイテンシクロスフェード用ゲインランプバッファ (wetBuf[0]流用の解消)
     convo::ScopedAlignedPtr<double> delayFadeRampBuffer;
     int delayFadeRampCapacity = 0;
@@ -1240,6 +2090,15 @@ public: // Added for AudioEngine access
                                                                  bool* wasCancelled,
                                                                  std::function<void(float)> progressCallback = nullptr);
 
+    // ★ 同じ IR・遷移帯域で別レートの設計 (メモリキャッシュ → ディスクキャッシュの順) を探し、
+    //   sampleRate へ写した allpass セクションを返す。見つからなければ false
+    static bool findMixedPhaseWarmStart(ConvolverProcessor* owner,
+                                        uint64_t fileHash,
+                                        double sampleRate,
+                                        float f1, float f2,
+                                        std::vector<convo::SecondOrderAllpass>& outSections,
+                                        double& outSourceRate);
+
     static juce::AudioBuffer<double> convertToMixedPhaseFallback(const juce::AudioBuffer<double>& linearIR,
                                                                  const juce::AudioBuffer<double>& minimumIR,
                                                                  double sampleRate,
@@ -1252,6 +2111,14 @@ public: // Added for AudioEngine access
     convo::aligned_unique_ptr<IRConverter> irConverter;
     convo::aligned_unique_ptr<CacheManager> cacheManager;
     std::unique_ptr<ProgressiveUpgradeThread> upgradeThread;
+    std::unique_ptr<StandbyPrebuildThread> standbyThread;
+    std::vector<double> standbySampleRates;  // Message Thread のみ
+    std::unique_ptr<CachePrefetchThread> prefetchThread;
+    std::vector<juce::File> recentIrFiles;   // Message Thread のみ (front = 最近使用)
+    int cachePrefetchCount = 4;              // Message Thread のみ
+    std::unique_ptr<IRLibraryIndexer> libraryIndexer;
+    bool irPreviewActive = false;            // Message Thread のみ (プレビューを反映し、まだ loadIR していない)
+    std::vector<juce::File> irLibraryDirectories;  // Message Thread のみ
     std::atomic<bool> writerActive { false };
     std::atomic<uint64_t> activeCacheKey { 0 };
     std::atomic<int> activeCacheFFTSize { 0 };
@@ -1265,6 +2132,7 @@ public: // Added for AudioEngine access
     uint64_t m_latencyChangeRequestedGenSeen { 0 };
     uint64_t m_smoothingTimeChangePendingGenSeen { 0 };
     uint64_t m_mixSmootherResetPendingGenSeen { 0 };
+    bool m_rtReaderPinned = false;  // RT-local: CallbackReaderScope が runtimeRcuReader を固定中
     // [P1-15] 内部 epoch 管理用 (Convolver 独自ドメイン)
     convo::EpochDomain m_epochDomain;
     // DSP_THREAD_STATE: Audio Thread process() で使用するRCU reader。
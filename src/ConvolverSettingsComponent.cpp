@@ -19,6 +19,14 @@ ConvolverSettingsComponent::ConvolverSettingsComponent(AudioEngine& engineRef)
     progressiveToggle.addListener(this);
     addAndMakeVisible(progressiveToggle);
 
+    streamingToggle.setTooltip("Start long IRs from their first 100 ms and switch to the full IR once converted (As-Is phase only)");
+    streamingToggle.addListener(this);
+    addAndMakeVisible(streamingToggle);
+
+    incrementalRebuildToggle.setTooltip("Rebuild IRs in short time slices and yield the CPU between them (slower rebuilds, steadier playback)");
+    incrementalRebuildToggle.addListener(this);
+    addAndMakeVisible(incrementalRebuildToggle);
+
     cacheEntriesLabel.setText("Max Cache Entries", juce::dontSendNotification);
     cacheEntriesLabel.setJustificationType(juce::Justification::centredRight);
     addAndMakeVisible(cacheEntriesLabel);
@@ -29,10 +37,26 @@ ConvolverSettingsComponent::ConvolverSettingsComponent(AudioEngine& engineRef)
     cacheEntriesSlider.addListener(this);
     addAndMakeVisible(cacheEntriesSlider);
 
+    cacheBudgetLabel.setText("Cache Budget (MB)", juce::dontSendNotification);
+    cacheBudgetLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(cacheBudgetLabel);
+
+    cacheBudgetSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    cacheBudgetSlider.setRange(64.0, 16384.0, 64.0);
+    cacheBudgetSlider.setSkewFactorFromMidPoint(2048.0);
+    cacheBudgetSlider.setNumDecimalPlacesToDisplay(0);
+    cacheBudgetSlider.addListener(this);
+    addAndMakeVisible(cacheBudgetSlider);
+
+    costWeightedToggle.addListener(this);
+    addAndMakeVisible(costWeightedToggle);
+
+    addAndMakeVisible(cacheStatsLabel);
+
     clearCacheButton.addListener(this);
     addAndMakeVisible(clearCacheButton);
 
-    setSize(420, 150);
+    setSize(420, 322);
     syncFromProcessor();
     startTimerHz(5);
 }
@@ -41,7 +65,11 @@ ConvolverSettingsComponent::~ConvolverSettingsComponent()
 {
     targetFftBox.removeListener(this);
     progressiveToggle.removeListener(this);
+    streamingToggle.removeListener(this);
+    incrementalRebuildToggle.removeListener(this);
     cacheEntriesSlider.removeListener(this);
+    cacheBudgetSlider.removeListener(this);
+    costWeightedToggle.removeListener(this);
     clearCacheButton.removeListener(this);
 }
 
@@ -64,12 +92,30 @@ void ConvolverSettingsComponent::resized()
     area.removeFromTop(8);
     progressiveToggle.setBounds(area.removeFromTop(rowH));
 
+    area.removeFromTop(8);
+    streamingToggle.setBounds(area.removeFromTop(rowH));
+
+    area.removeFromTop(8);
+    incrementalRebuildToggle.setBounds(area.removeFromTop(rowH));
+
     area.removeFromTop(8);
     auto row3 = area.removeFromTop(rowH);
     cacheEntriesLabel.setBounds(row3.removeFromLeft(labelW));
     row3.removeFromLeft(8);
     cacheEntriesSlider.setBounds(row3.removeFromLeft(200));
 
+    area.removeFromTop(8);
+    auto row4 = area.removeFromTop(rowH);
+    cacheBudgetLabel.setBounds(row4.removeFromLeft(labelW));
+    row4.removeFromLeft(8);
+    cacheBudgetSlider.setBounds(row4.removeFromLeft(200));
+
+    area.removeFromTop(8);
+    costWeightedToggle.setBounds(area.removeFromTop(rowH));
+
+    area.removeFromTop(4);
+    cacheStatsLabel.setBounds(area.removeFromTop(rowH));
+
     area.removeFromTop(8);
     clearCacheButton.setBounds(area.removeFromTop(rowH).removeFromLeft(140));
 }
@@ -91,9 +137,28 @@ void ConvolverSettingsComponent::syncFromProcessor()
         targetFftBox.setSelectedId(selectedId, juce::dontSendNotification);
 
     progressiveToggle.setToggleState(engine.isConvolverProgressiveUpgradeEnabled(), juce::dontSendNotification);
+    streamingToggle.setToggleState(engine.isConvolverStreamingIRActivationEnabled(), juce::dontSendNotification);
+    incrementalRebuildToggle.setToggleState(engine.isConvolverIncrementalRebuildEnabled(), juce::dontSendNotification);
 
     if (!cacheEntriesSlider.isMouseButtonDown())
         cacheEntriesSlider.setValue(static_cast<double>(engine.getConvolverMaxCacheEntries()), juce::dontSendNotification);
+
+    constexpr double kMiB = 1024.0 * 1024.0;
+    if (!cacheBudgetSlider.isMouseButtonDown())
+        cacheBudgetSlider.setValue(static_cast<double>(engine.getConvolverCacheDiskBudgetBytes()) / kMiB, juce::dontSendNotification);
+
+    costWeightedToggle.setToggleState(engine.isConvolverCacheCostWeightedEviction(), juce::dontSendNotification);
+
+    const auto stats = engine.getConvolverCacheStats();
+    const uint64_t lookups = stats.hits + stats.misses;
+    const double hitRate = lookups > 0 ? 100.0 * static_cast<double>(stats.hits) / static_cast<double>(lookups) : 0.0;
+    cacheStatsLabel.setText(juce::String(static_cast<int>(stats.entries)) + " entries, "
+                                + juce::String(static_cast<double>(stats.diskBytes) / kMiB, 0) + " MB  |  hit "
+                                + juce::String(hitRate, 1) + "% ("
+                                + juce::String(static_cast<juce::int64>(stats.hits)) + "/"
+                                + juce::String(static_cast<juce::int64>(lookups)) + "), evicted "
+                                + juce::String(static_cast<juce::int64>(stats.evictions)),
+                            juce::dontSendNotification);
 }
 
 void ConvolverSettingsComponent::comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged)
@@ -123,10 +188,30 @@ void ConvolverSettingsComponent::buttonClicked(juce::Button* button)
     {
         engine.setConvolverEnableProgressiveUpgrade(progressiveToggle.getToggleState());
     }
+    else if (button == &streamingToggle)
+    {
+        engine.setConvolverStreamingIRActivationEnabled(streamingToggle.getToggleState());
+    }
+    else if (button == &incrementalRebuildToggle)
+    {
+        engine.setConvolverIncrementalRebuildEnabled(incrementalRebuildToggle.getToggleState());
+    }
+    else if (button == &costWeightedToggle)
+    {
+        engine.setConvolverCacheCostWeightedEviction(costWeightedToggle.getToggleState());
+    }
 }
 
 void ConvolverSettingsComponent::sliderValueChanged(juce::Slider* slider)
 {
     if (slider == &cacheEntriesSlider)
         engine.setConvolverMaxCacheEntries(static_cast<size_t>(juce::roundToInt(cacheEntriesSlider.getValue())));
+    else if (slider == &cacheBudgetSlider && !cacheBudgetSlider.isMouseButtonDown())  // ドラッグ中に退避しない (確定は sliderDragEnded)
+        engine.setConvolverCacheDiskBudgetBytes(static_cast<uint64_t>(juce::roundToInt(cacheBudgetSlider.getValue())) * 1024ULL * 1024ULL);
+}
+
+void ConvolverSettingsComponent::sliderDragEnded(juce::Slider* slider)
+{
+    if (slider == &cacheBudgetSlider)
+        engine.setConvolverCacheDiskBudgetBytes(static_cast<uint64_t>(juce::roundToInt(cacheBudgetSlider.getValue())) * 1024ULL * 1024ULL);
 }
@@ -22,6 +22,7 @@ private:
     void comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) override;
     void buttonClicked(juce::Button* button) override;
     void sliderValueChanged(juce::Slider* slider) override;
+    void sliderDragEnded(juce::Slider* slider) override;
 
     void syncFromProcessor();
 
@@ -31,10 +32,17 @@ private:
     juce::ComboBox targetFftBox;
 
     juce::ToggleButton progressiveToggle { "Enable Progressive Upgrade" };
+    juce::ToggleButton streamingToggle { "Play IR Head While Converting" };
+    juce::ToggleButton incrementalRebuildToggle { "Pace IR Rebuilds" };
 
     juce::Label cacheEntriesLabel;
     juce::Slider cacheEntriesSlider;
 
+    juce::Label cacheBudgetLabel;
+    juce::Slider cacheBudgetSlider;  // MiB
+    juce::ToggleButton costWeightedToggle { "Keep Expensive IRs Longer" };
+    juce::Label cacheStatsLabel;
+
     juce::TextButton clearCacheButton { "Clear Cache" };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConvolverSettingsComponent)
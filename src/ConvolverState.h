@@ -7,6 +7,7 @@
 #include <JuceHeader.h>
 #include <atomic>
 #include <cstdint>      // uint64_t
+#include <memory>
 
 #include "audioengine/AtomicAccess.h"
 
@@ -27,6 +28,10 @@ struct ConvolverState
     uint64_t generationId       = 0;
     double   sampleRate         = 0.0;
 
+    // ★ v3 キャッシュの mmap (PreparedIRState::partitionView の実体)。
+    //   state が RCU で退役 (deferred retire) するまで mapping を保持する。読み取り専用。
+    std::shared_ptr<const juce::MemoryMappedFile> mappedStorage;
+
     // 冪等クリーンアップ用フラグ
     std::atomic<bool> cleanedUp {false};
 
@@ -81,6 +86,7 @@ private:
         generationId       = o.generationId;
         sampleRate         = o.sampleRate;
         stateId            = o.stateId;
+        mappedStorage      = std::move(o.mappedStorage);
 
         convo::publishAtomic(o.cleanedUp, true, std::memory_order_release);
         convo::publishAtomic(cleanedUp, false, std::memory_order_release);
@@ -101,6 +107,7 @@ private:
             generationId       = o.generationId;
             sampleRate         = o.sampleRate;
             stateId            = o.stateId;
+            mappedStorage      = std::move(o.mappedStorage);
 
             convo::publishAtomic(o.cleanedUp, true, std::memory_order_release);
             convo::publishAtomic(cleanedUp, false, std::memory_order_release);
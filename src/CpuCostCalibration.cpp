@@ -0,0 +1,417 @@
+#include "CpuCostCalibration.h"
+
+#include <JuceHeader.h>
+#include <mkl.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "AlignedAllocation.h"
+#include "CustomInputOversampler.h"
+#include "EQProcessor.h"
+#include "MKLNonUniformConvolver.h"
+#include "OutputFilter.h"
+#include "PsychoacousticDither.h"
+
+namespace convo {
+
+// ═══════════════════════════════════════════════════════════════
+//  インスタンス / パス解決
+// ═══════════════════════════════════════════════════════════════
+
+CpuCostCalibration& CpuCostCalibration::getInstance()
+{
+    static CpuCostCalibration instance;
+    return instance;
+}
+
+juce::File CpuCostCalibration::getModelFile()
+{
+    auto appDataDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                          .getChildFile("ConvoPeq");
+
+    if (!appDataDir.exists())
+    {
+        auto result = appDataDir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create settings directory");
+    }
+
+    return appDataDir.getChildFile("cpu_cost_model.xml");
+}
+
+CpuCostCoefficients CpuCostCalibration::getCoefficients() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    return coefficients;
+}
+
+void CpuCostCalibration::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    coefficients = {};
+    loaded = true;
+    getModelFile().deleteFile();
+}
+
+void CpuCostCalibration::ensureCalibrated()
+{
+    std::lock_guard<std::mutex> calibrationLock(calibrationMutex);
+    if (getCoefficients().valid)
+        return;
+
+    const auto startMs = juce::Time::getMillisecondCounterHiRes();
+    const auto measured = measure();
+    const auto elapsedMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    if (!measured.valid)
+    {
+        juce::Logger::writeToLog("CpuCostCalibration: measurement failed");
+        return;
+    }
+
+    juce::Logger::writeToLog("CpuCostCalibration: NUC 64k=" + juce::String(measured.nucNsPerSample[2], 2)
+                             + " ns/smp, EQ band=" + juce::String(measured.eqBandNsPerSample, 2)
+                             + " ns/smp, OS IIR x8=" + juce::String(measured.oversamplingNsPerSample[0][2], 2)
+                             + " ns/smp, output=" + juce::String(measured.outputNsPerSample, 2)
+                             + " ns/smp (" + juce::String(elapsedMs, 0) + " ms)");
+
+    std::lock_guard<std::mutex> lock(mutex);
+    coefficients = measured;
+    loaded = true;
+    saveLocked();
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  計測
+// ═══════════════════════════════════════════════════════════════
+
+namespace {
+
+// ブロック処理を warmup 回捨ててから measured 回回し、1 サンプル当たりの平均 ns を返す
+template <typename RunBlock>
+double measureNsPerSample(int blockSize, int warmupBlocks, int measuredBlocks, RunBlock&& runBlock)
+{
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < warmupBlocks; ++i)
+        runBlock();
+
+    const auto start = Clock::now();
+    for (int i = 0; i < measuredBlocks; ++i)
+        runBlock();
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / (static_cast<double>(measuredBlocks) * static_cast<double>(blockSize));
+}
+
+void fillNoise(std::vector<double>& buffer, std::mt19937& rng, double amplitude)
+{
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    for (auto& s : buffer)
+        s = dist(rng);
+}
+
+// 実 callback で最も多い処理レート帯 (48 kHz × 4)。NUC の tail 構成判定にだけ効く
+constexpr double kCalibrationProcessingRate = 192000.0;
+constexpr double kCalibrationBaseRate = 48000.0;
+
+// モノラル NUC 1 本。L2 パーティション周期を 2 回以上含めて tail の分散処理も平均に入れる
+double measureNuc(int irLength, int blockSize, std::mt19937& rng)
+{
+    std::vector<double> impulse(static_cast<size_t>(irLength));
+    {
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const double decayPerSample = std::log(1.0e-3) / static_cast<double>(impulse.size());
+        for (size_t i = 0; i < impulse.size(); ++i)
+            impulse[i] = dist(rng) * std::exp(decayPerSample * static_cast<double>(i));
+    }
+
+    FilterSpec spec;
+    spec.sampleRate = kCalibrationProcessingRate;
+    spec.partitionCullFloorDb = FilterSpec::kPartitionCullDisabledDb;  // 最悪ケース (間引きなし) を測る
+    spec.partitionCullLength = 0;
+
+    auto nuc = convo::aligned_make_unique<MKLNonUniformConvolver>();
+    if (!nuc->SetImpulse(impulse.data(), irLength, blockSize, 1.0, false, &spec))
+        return -1.0;
+
+    std::vector<double> input(static_cast<size_t>(blockSize));
+    std::vector<double> output(static_cast<size_t>(blockSize));
+
+    const int l0Part = juce::nextPowerOfTwo(std::max(blockSize, 64));
+    const int mult = MKLNonUniformConvolver::resolveTailL1L2Multiplier(&spec);
+    const int64_t cycleSamples = static_cast<int64_t>(l0Part) * mult * mult * 2;
+    const int numBlocks = static_cast<int>(std::max<int64_t>(64, cycleSamples / blockSize));
+
+    return measureNsPerSample(blockSize, std::max(8, numBlocks / 8), numBlocks, [&]() noexcept
+    {
+        fillNoise(input, rng, 0.5);
+        nuc->Add(input.data(), blockSize);
+        nuc->Get(output.data(), blockSize);
+    });
+}
+
+double measureEq(EQProcessor& eq, juce::AudioBuffer<double>& buffer, std::mt19937& rng)
+{
+    const int blockSize = buffer.getNumSamples();
+    std::vector<double> noise(static_cast<size_t>(blockSize));
+    return measureNsPerSample(blockSize, 32, 512, [&]() noexcept
+    {
+        fillNoise(noise, rng, 0.25);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            std::copy(noise.begin(), noise.end(), buffer.getWritePointer(ch));
+        juce::dsp::AudioBlock<double> block(buffer);
+        eq.process(block);
+    });
+}
+
+} // namespace
+
+CpuCostCoefficients CpuCostCalibration::measure()
+{
+    // Audio Thread と同条件 (FTZ/DAZ, MKL 1 スレッド) で計測する
+    juce::ScopedNoDenormals noDenormals;
+    const int prevMklThreads = mkl_set_num_threads_local(1);
+
+    CpuCostCoefficients c;
+    std::mt19937 rng(0xC057);
+    bool ok = true;
+
+    // ── NUC: IR 長別 (基準ブロック) とブロック長別 (基準 IR) ──
+    for (int i = 0; i < CpuCostCoefficients::kNumIrPoints; ++i)
+    {
+        const int irLength = 1 << (CpuCostCoefficients::kIrLog2Min + i * CpuCostCoefficients::kIrLog2Step);
+        c.nucNsPerSample[static_cast<size_t>(i)] = measureNuc(irLength, CpuCostCoefficients::kReferenceBlockSize, rng);
+        ok = ok && c.nucNsPerSample[static_cast<size_t>(i)] > 0.0;
+    }
+    {
+        std::array<double, CpuCostCoefficients::kNumBlockPoints> perBlock {};
+        double reference = 0.0;
+        for (int i = 0; i < CpuCostCoefficients::kNumBlockPoints; ++i)
+        {
+            const int blockSize = 1 << (CpuCostCoefficients::kBlockLog2Min + i * CpuCostCoefficients::kBlockLog2Step);
+            perBlock[static_cast<size_t>(i)] = measureNuc(CpuCostCoefficients::kReferenceIrLength, blockSize, rng);
+            ok = ok && perBlock[static_cast<size_t>(i)] > 0.0;
+            if (blockSize == CpuCostCoefficients::kReferenceBlockSize)
+                reference = perBlock[static_cast<size_t>(i)];
+        }
+        if (reference > 0.0)
+            for (size_t i = 0; i < perBlock.size(); ++i)
+                c.nucBlockScale[i] = perBlock[i] / reference;
+    }
+
+    // ── EQ: 全バンド無効 → 全バンド有効 (+3 dB、係数が恒等にならないように) ──
+    {
+        constexpr int kEqBlock = 1024;
+        EQProcessor eq;
+        eq.prepareToPlay(kCalibrationProcessingRate, kEqBlock);
+        juce::AudioBuffer<double> buffer(2, kEqBlock);
+
+        for (int band = 0; band < EQProcessor::NUM_BANDS; ++band)
+        {
+            eq.setBandGain(band, 3.0f);
+            eq.setBandEnabled(band, false);
+        }
+        const double base = measureEq(eq, buffer, rng);
+
+        for (int band = 0; band < EQProcessor::NUM_BANDS; ++band)
+            eq.setBandEnabled(band, true);
+        const double full = measureEq(eq, buffer, rng);
+
+        c.eqBaseNsPerSample = base;
+        c.eqBandNsPerSample = std::max(0.0, full - base) / static_cast<double>(EQProcessor::NUM_BANDS);
+        eq.releaseResources();
+    }
+
+    // ── オーバーサンプラ: プリセット × 倍率、up + down 往復 ──
+    {
+        constexpr int kOsBlock = 512;
+        constexpr CustomInputOversampler::Preset kPresets[] = {
+            CustomInputOversampler::Preset::IIRLike,
+            CustomInputOversampler::Preset::LinearPhase,
+            CustomInputOversampler::Preset::MinimumPhase
+        };
+        juce::AudioBuffer<double> buffer(2, kOsBlock);
+        std::vector<double> noise(static_cast<size_t>(kOsBlock));
+
+        for (size_t p = 0; p < std::size(kPresets); ++p)
+        {
+            for (int r = 0; r < CpuCostCoefficients::kNumOversamplingRatios; ++r)
+            {
+                const int ratio = 2 << r;
+                CustomInputOversampler os;
+                os.prepare(kOsBlock, ratio, kPresets[p]);
+                c.oversamplingNsPerSample[p][static_cast<size_t>(r)] =
+                    measureNsPerSample(kOsBlock, 32, 512, [&]() noexcept
+                    {
+                        fillNoise(noise, rng, 0.25);
+                        for (int ch = 0; ch < 2; ++ch)
+                            std::copy(noise.begin(), noise.end(), buffer.getWritePointer(ch));
+                        juce::dsp::AudioBlock<double> block(buffer);
+                        auto up = os.processUp(block, 2);
+                        os.processDown(up, block, 2);
+                    });
+                os.release();
+            }
+        }
+    }
+
+    // ── 出力段: 出力フィルタ (Convolver 最終段) + 24bit ディザ ──
+    {
+        constexpr int kOutBlock = 512;
+        OutputFilter filter;
+        filter.prepare(kCalibrationBaseRate);
+        PsychoacousticDither dither;
+        dither.prepare(kCalibrationBaseRate, 24);
+        juce::AudioBuffer<double> buffer(2, kOutBlock);
+        std::vector<double> noise(static_cast<size_t>(kOutBlock));
+
+        c.outputNsPerSample = measureNsPerSample(kOutBlock, 32, 1024, [&]() noexcept
+        {
+            fillNoise(noise, rng, 0.25);
+            for (int ch = 0; ch < 2; ++ch)
+                std::copy(noise.begin(), noise.end(), buffer.getWritePointer(ch));
+            juce::dsp::AudioBlock<double> block(buffer);
+            filter.process(block, true, HCMode::Natural, LCMode::Natural, HCMode::Natural);
+            dither.processStereoBlock(buffer.getWritePointer(0), buffer.getWritePointer(1), kOutBlock, 1.0);
+        });
+    }
+
+    mkl_set_num_threads_local(prevMklThreads);
+    c.valid = ok;
+    return c;
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  表示
+// ═══════════════════════════════════════════════════════════════
+
+juce::String formatCpuCostTooltip(const CpuCostPrediction& prediction, const CpuCostSuggestion& suggestion)
+{
+    if (prediction.verdict == CpuCostPrediction::Verdict::Unknown)
+        return "CPU cost model is not calibrated yet (measured once at first start).";
+
+    juce::String text;
+    text << "Predicted callback load: " << juce::roundToInt(prediction.load * 100.0) << "% of "
+         << juce::String(prediction.periodUs, 0) << " us\n"
+         << "  Convolver " << juce::String(prediction.convolverUs, 0) << " us, EQ " << juce::String(prediction.eqUs, 0)
+         << " us, Oversampling " << juce::String(prediction.oversamplingUs, 0) << " us, Output "
+         << juce::String(prediction.outputUs, 0) << " us";
+
+    if (!suggestion.needed)
+        return text;
+
+    const auto& lighter = suggestion.config;
+    text << "\n" << (suggestion.achievable ? "Suggested: " : "Lightest option still over budget: ")
+         << lighter.oversamplingFactor << "x oversampling, buffer " << lighter.blockSize
+         << ", IR " << lighter.irLength << " smp (" << juce::roundToInt(suggestion.prediction.load * 100.0) << "%)";
+    return text;
+}
+
+juce::Colour cpuCostVerdictColour(CpuCostPrediction::Verdict verdict, juce::Colour okColour)
+{
+    switch (verdict)
+    {
+        case CpuCostPrediction::Verdict::Warning:  return juce::Colours::orange;
+        case CpuCostPrediction::Verdict::Overload: return juce::Colours::red;
+        case CpuCostPrediction::Verdict::Ok:
+        case CpuCostPrediction::Verdict::Unknown:  break;
+    }
+    return okColour;
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  永続化
+// ═══════════════════════════════════════════════════════════════
+
+namespace {
+
+juce::String currentCpuSignature()
+{
+    return juce::SystemStats::getCpuModel() + "/" + juce::String(juce::SystemStats::getNumCpus());
+}
+
+template <size_t N>
+juce::String joinValues(const std::array<double, N>& values)
+{
+    juce::StringArray parts;
+    for (const double v : values)
+        parts.add(juce::String(v, 6));
+    return parts.joinIntoString(",");
+}
+
+template <size_t N>
+bool parseValues(const juce::String& text, std::array<double, N>& values)
+{
+    juce::StringArray parts;
+    parts.addTokens(text, ",", "");
+    if (parts.size() != static_cast<int>(N))
+        return false;
+    for (size_t i = 0; i < N; ++i)
+        values[i] = parts[static_cast<int>(i)].getDoubleValue();
+    return true;
+}
+
+} // namespace
+
+void CpuCostCalibration::ensureLoadedLocked() const
+{
+    if (loaded)
+        return;
+    loaded = true;
+    coefficients = {};
+
+    const auto file = getModelFile();
+    if (!file.existsAsFile())
+        return;
+
+    auto root = juce::XmlDocument::parse(file);
+    if (root == nullptr || !root->hasTagName("CpuCostModel"))
+        return;
+    if (root->getIntAttribute("version", 0) != kVersion)
+        return;
+    if (root->getStringAttribute("cpu") != currentCpuSignature())
+        return;  // CPU が変わった → 再計測
+
+    CpuCostCoefficients c;
+    bool ok = parseValues(root->getStringAttribute("nucNsPerSample"), c.nucNsPerSample)
+           && parseValues(root->getStringAttribute("nucBlockScale"), c.nucBlockScale);
+    c.eqBaseNsPerSample = root->getDoubleAttribute("eqBaseNsPerSample", 0.0);
+    c.eqBandNsPerSample = root->getDoubleAttribute("eqBandNsPerSample", 0.0);
+    c.outputNsPerSample = root->getDoubleAttribute("outputNsPerSample", 0.0);
+    for (auto* e : root->getChildWithTagNameIterator("Oversampling"))
+    {
+        const int preset = e->getIntAttribute("preset", -1);
+        if (preset < 0 || preset >= static_cast<int>(CpuCostOversamplingPreset::Count))
+            continue;
+        ok = ok && parseValues(e->getStringAttribute("nsPerSample"), c.oversamplingNsPerSample[static_cast<size_t>(preset)]);
+    }
+    c.valid = ok && c.nucNsPerSample.front() > 0.0;
+    if (c.valid)
+        coefficients = c;
+}
+
+void CpuCostCalibration::saveLocked() const
+{
+    juce::XmlElement root("CpuCostModel");
+    root.setAttribute("version", kVersion);
+    root.setAttribute("cpu", currentCpuSignature());
+    root.setAttribute("nucNsPerSample", joinValues(coefficients.nucNsPerSample));
+    root.setAttribute("nucBlockScale", joinValues(coefficients.nucBlockScale));
+    root.setAttribute("eqBaseNsPerSample", coefficients.eqBaseNsPerSample);
+    root.setAttribute("eqBandNsPerSample", coefficients.eqBandNsPerSample);
+    root.setAttribute("outputNsPerSample", coefficients.outputNsPerSample);
+    for (size_t p = 0; p < coefficients.oversamplingNsPerSample.size(); ++p)
+    {
+        auto* e = root.createNewChildElement("Oversampling");
+        e->setAttribute("preset", static_cast<int>(p));
+        e->setAttribute("nsPerSample", joinValues(coefficients.oversamplingNsPerSample[p]));
+    }
+
+    if (!root.writeTo(getModelFile()))
+        juce::Logger::writeToLog("Warning: Could not write CPU cost model file");
+}
+
+} // namespace convo
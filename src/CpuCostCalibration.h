@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <mutex>
+
+#include "audioengine/CpuCostModel.h"
+
+namespace convo {
+
+/**
+    CpuCostCalibration: CpuCostModel の係数 (CpuCostCoefficients) を実測して保存する。
+
+    初回起動時に NUC (IR 長・ブロック長別)、EQ (バンド 0 本 / 全バンド)、オーバーサンプラ
+    (プリセット × 倍率)、出力段 (出力フィルタ + ディザ) を Audio Thread と同条件 (FTZ/DAZ, MKL 1 スレッド) で
+    単体計測し、%APPDATA%/ConvoPeq/cpu_cost_model.xml に保存する。保存時と CPU モデルが異なれば再計測する。
+    計測は合計 1〜2 秒程度で、起動時の StartupWarmup スレッドで 1 回だけ走る。
+
+    スレッド:
+      getCoefficients   : 任意の Non-RT スレッド (mutex)。未計測なら valid == false
+      ensureCalibrated  : StartupWarmup スレッド (未計測なら計測までブロックする)
+*/
+class CpuCostCalibration
+{
+public:
+    static CpuCostCalibration& getInstance();
+    static juce::File getModelFile();
+
+    [[nodiscard]] CpuCostCoefficients getCoefficients() const;
+
+    /** 保存済みの係数を読む。無い・CPU が変わった・版が古い場合は計測して保存する。 */
+    void ensureCalibrated();
+
+    /** 保存済みの係数を捨てる (次の ensureCalibrated で再計測)。 */
+    void clear();
+
+private:
+    CpuCostCalibration() = default;
+
+    static CpuCostCoefficients measure();
+
+    void ensureLoadedLocked() const;
+    void saveLocked() const;
+
+    static constexpr int kVersion = 1;
+
+    mutable std::mutex mutex;
+    mutable CpuCostCoefficients coefficients;
+    mutable bool loaded = false;
+    std::mutex calibrationMutex;  // 計測の二重実行を避ける
+};
+
+/** UI 用: 予測の内訳と、Warning 以上なら軽い構成の提案を複数行にまとめる (ツールチップ向け)。 */
+[[nodiscard]] juce::String formatCpuCostTooltip(const CpuCostPrediction& prediction, const CpuCostSuggestion& suggestion);
+
+/** UI 用: 判定ごとの文字色 (Ok = 既定色、Warning = 橙、Overload = 赤)。 */
+[[nodiscard]] juce::Colour cpuCostVerdictColour(CpuCostPrediction::Verdict verdict, juce::Colour okColour);
+
+} // namespace convo
@@ -20,7 +20,7 @@
 
 namespace convo {
 
-static bool hasAVX2Support() noexcept
+static bool detectAVX2Support() noexcept
 {
 #if defined(_WIN32)
     // Method 1: IsProcessorFeaturePresent (kernel32.dll, Windows 8.1+)
@@ -146,6 +146,46 @@ static bool hasAVX2Support() noexcept
 #endif
 }
 
+bool hasAVX2Support() noexcept
+{
+    static const bool supported = detectAVX2Support();
+    return supported;
+}
+
+static bool detectAVX512Support() noexcept
+{
+    // AVX-512F 判定には AVX2/FMA が前提 (カーネルは FMA3 と併用しないが OS 保存確認の前提を共有)
+    if (!hasAVX2Support())
+        return false;
+
+#if defined(_MSC_VER) || defined(__INTEL_COMPILER)
+    int leaf7[4] = { 0 };
+    __cpuidex(leaf7, 7, 0);
+    const unsigned int ebx7 = static_cast<unsigned int>(leaf7[1]);
+    const unsigned int xcr0 = static_cast<unsigned int>(_xgetbv(0));
+#elif defined(__GNUC__) || defined(__clang__)
+    unsigned int eax7 = 0, ebx7 = 0, ecx7 = 0, edx7 = 0;
+    __get_cpuid_count(7, 0, &eax7, &ebx7, &ecx7, &edx7);
+    unsigned int xcr0_eax = 0, xcr0_edx = 0;
+    __asm__("xgetbv" : "=a"(xcr0_eax), "=d"(xcr0_edx) : "c"(0));
+    const unsigned int xcr0 = xcr0_eax;
+#else
+    return false;
+#endif
+    // bit 16: AVX512F (leaf 7 EBX)
+    if ((ebx7 & (1u << 16)) == 0)
+        return false;
+
+    // XCR0[1]=XMM, [2]=YMM, [5]=opmask, [6]=ZMM_Hi256, [7]=Hi16_ZMM
+    return (xcr0 & 0xE6u) == 0xE6u;
+}
+
+bool hasAVX512Support() noexcept
+{
+    static const bool supported = detectAVX512Support();
+    return supported;
+}
+
 bool checkAVX2SupportAndWarn() noexcept
 {
     if (hasAVX2Support())
@@ -1,6 +1,7 @@
 //==============================================================================
 // CpuFeatureCheck.h
 // ★ [P0-1] AVX2 ランタイム検出 — 非対応 CPU ではエラーダイアログを表示して終了
+// ★ AVX-512 ランタイム検出 — NUC CMAC / KernelDispatch のカーネル選択用 (非対応時は AVX2 にフォールバック)
 //
 // ISR 観点: 起動時に 1 回だけ呼ばれるチェック。ISR とは無関係。
 //==============================================================================
@@ -13,4 +14,12 @@ namespace convo {
 // 対応している場合は true を返す。
 bool checkAVX2SupportAndWarn() noexcept;
 
+// AVX2 + FMA (+ OS の YMM 保存) が利用可能かを返す。ダイアログは出さない。
+// 結果は初回呼び出しでキャッシュされる (KernelDispatch の ISA 選択用)。
+bool hasAVX2Support() noexcept;
+
+// ★ AVX-512F (+ OS の ZMM/opmask 保存) が利用可能かを返す。
+// 結果は初回呼び出しでキャッシュされる。ダイアログは出さない (任意の高速化パス選択用)。
+bool hasAVX512Support() noexcept;
+
 } // namespace convo
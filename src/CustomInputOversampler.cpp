@@ -9,6 +9,8 @@
 #include <immintrin.h>
 
 #include "audioengine/AtomicAccess.h"
+#include "audioengine/ChainSilenceTracker.h"
+#include "audioengine/ChannelForkJoin.h"
 
 namespace
 {
@@ -34,6 +36,74 @@ namespace
 
     constexpr double kDenormThreshold = convo::numeric_policy::kDenormThresholdAudioState;
 
+    /// ステージ出力の後処理: 異常値は 0 へ置換して true を返す。denormal は 0 へ丸める
+    inline bool sanitizeStageOutput(double* data, int numSamples) noexcept
+    {
+        bool bad = false;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double v = data[i];
+            if (isBadSample(v))
+            {
+                data[i] = 0.0;
+                bad = true;
+            }
+            else if (fastAbs(v) < kDenormThreshold)
+            {
+                data[i] = 0.0;
+            }
+        }
+        return bad;
+    }
+
+    // StagePrecision::Float32UpperStages で float32 化する最初のステージ (0 始まり)。
+    // 段 0 は base rate の全帯域を扱うため常に double
+    constexpr int kFirstSinglePrecisionStage = 1;
+
+    inline std::uint32_t nextDitherRandom(std::uint32_t& state) noexcept
+    {
+        // xorshift32 (周期 2^32 − 1)。状態 0 は不動点のため初期値は非 0
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    /// double → float32 ステージ境界変換。
+    /// 丸め誤差を信号と無相関にするため、各サンプルの float ULP 幅の TPDF ディザ (±1 ULP) を加える。
+    /// 0 / 非正規化数 / Inf / NaN はディザなし (異常値はステージ出力の sanitize で検出される)
+    inline void quantizeToFloat(const double* __restrict input, float* __restrict output, int numSamples,
+                                bool dither, std::uint32_t& state) noexcept
+    {
+        if (!dither)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = static_cast<float>(input[i]);
+            return;
+        }
+
+        constexpr double kRandomScale = 1.0 / 4294967296.0;
+        constexpr std::uint32_t kMantissaShift = 23u << 23;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double x = input[i];
+            const std::uint32_t expBits = std::bit_cast<std::uint32_t>(static_cast<float>(x)) & 0x7F800000u;
+            double ulp = 0.0;
+            if (expBits > kMantissaShift && expBits != 0x7F800000u)
+                ulp = static_cast<double>(std::bit_cast<float>(expBits - kMantissaShift));
+
+            const double r0 = static_cast<double>(nextDitherRandom(state));
+            const double r1 = static_cast<double>(nextDitherRandom(state));
+            output[i] = static_cast<float>(x + (r0 - r1) * kRandomScale * ulp);
+        }
+    }
+
+    inline void widenToDouble(const float* __restrict input, double* __restrict output, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = static_cast<double>(input[i]);
+    }
+
 #if defined(__AVX2__)
     /// AVX2 版バッチ isBadSample: 4要素を1SIMD命令でチェック
     /// halfband 非連続インデックスでも set_pd 後に一括チェック可能
@@ -46,26 +116,64 @@ namespace
         const __m256d vInfMask = _mm256_cmp_pd(vAbs, _mm256_set1_pd(1e20), _CMP_GT_OQ);
         return _mm256_movemask_pd(_mm256_or_pd(vNanMask, vInfMask)) != 0;
     }
+#endif
+
+    // ── MinimumPhase: 楕円ハーフバンドの全域通過係数設計 (Valenzuela–Constantinides / hiir 方式) ──
+    // transition は正規化遷移帯域幅 (0 < tbw < 0.5)。通過域端 = (1 - 2·tbw)·(低レート Nyquist)。
+    inline void allpassTransitionParams(double transition, double& k, double& q) noexcept
+    {
+        k = std::tan((1.0 - transition * 2.0) * juce::MathConstants<double>::pi * 0.25);
+        k *= k;
+        const double kkSqrt = std::pow(1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kkSqrt) / (1.0 + kkSqrt);
+        const double e2 = e * e;
+        const double e4 = e2 * e2;
+        q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+    }
 
-    /// @brief Stride-2 で4要素を半帯域履歴バッファからロード
-    /// @param ptr  history のベースアドレス（呼出側: history + (base - convParity)）
-    /// @return     { ptr[0], ptr[-2], ptr[-4], ptr[-6] } の順
-    /// @note       係数 coeffs[r+0..r+3] との FMA で正しい畳み込み順序になる
-    inline __m256d loadStride2(const double* ptr) noexcept
-    {
-        __m128d v0 = _mm_loadu_pd(ptr - 6);    // { ptr[-6], ptr[-5] }
-        __m128d v1 = _mm_loadu_pd(ptr - 4);    // { ptr[-4], ptr[-3] }
-        __m128d v2 = _mm_loadu_pd(ptr - 2);    // { ptr[-2], ptr[-1] }
-        __m128d v3 = _mm_loadu_pd(ptr);        // { ptr[0],  ptr[1]  }
-        // low:  ptr[0], ptr[-2]  ← v3 と v2 の low element
-        __m128d vLow  = _mm_unpacklo_pd(v3, v2);
-        // high: ptr[-4], ptr[-6] ← v1 と v0 の low element
-        __m128d vHigh = _mm_unpacklo_pd(v1, v0);
-        return _mm256_insertf128_pd(
-            _mm256_castpd128_pd256(vLow), vHigh, 1);
-        // = { ptr[0], ptr[-2], ptr[-4], ptr[-6] }
+    inline double allpassAccNum(double q, int order, int c) noexcept
+    {
+        double acc = 0.0;
+        double sign = 1.0;
+        for (int i = 0; i < 64; ++i)
+        {
+            const double term = std::pow(q, static_cast<double>(i * (i + 1)))
+                              * std::sin(static_cast<double>((i * 2 + 1) * c) * juce::MathConstants<double>::pi / static_cast<double>(order))
+                              * sign;
+            acc += term;
+            sign = -sign;
+            if (std::abs(term) <= 1.0e-100)
+                break;
+        }
+        return acc;
+    }
+
+    inline double allpassAccDen(double q, int order, int c) noexcept
+    {
+        double acc = 0.0;
+        double sign = -1.0;
+        for (int i = 1; i < 64; ++i)
+        {
+            const double term = std::pow(q, static_cast<double>(i * i))
+                              * std::cos(static_cast<double>(i * 2 * c) * juce::MathConstants<double>::pi / static_cast<double>(order))
+                              * sign;
+            acc += term;
+            sign = -sign;
+            if (std::abs(term) <= 1.0e-100)
+                break;
+        }
+        return acc;
+    }
+
+    /// 2 経路の 1 次全域通過 (z² 領域) を 1 段進める: y = a·(x − y1) + x1
+    /// lower レーン = A0 経路, upper レーン = A1 経路
+    inline __m128d allpassPairStep(__m128d x, __m128d a, __m128d& x1, __m128d& y1) noexcept
+    {
+        const __m128d y = _mm_add_pd(_mm_mul_pd(a, _mm_sub_pd(x, y1)), x1);
+        x1 = x;
+        y1 = y;
+        return y;
     }
-#endif
 }
 
 CustomInputOversampler::~CustomInputOversampler()
@@ -83,14 +191,7 @@ int CustomInputOversampler::sanitizeRatio(int ratio) noexcept
 
 int CustomInputOversampler::tapsForStage(int stageIndex, Preset preset) noexcept
 {
-    if (preset == Preset::LinearPhase)
-    {
-        static constexpr int taps[3] = { 1023, 255, 63 };
-        return taps[juce::jlimit(0, 2, stageIndex)];
-    }
-
-    static constexpr int taps[3] = { 511, 127, 31 };
-    return taps[juce::jlimit(0, 2, stageIndex)];
+    return firStageTaps(preset, juce::jlimit(0, 2, stageIndex));
 }
 
 double CustomInputOversampler::attenuationForStage(int stageIndex, Preset preset) noexcept
@@ -105,17 +206,127 @@ double CustomInputOversampler::attenuationForStage(int stageIndex, Preset preset
     return attenuation[juce::jlimit(0, 2, stageIndex)];
 }
 
+double CustomInputOversampler::transitionForStage(int stageIndex) noexcept
+{
+    // MinimumPhase 専用。段 0 は 44.1k 基準で約 19.8 kHz まで通過、後段は前段で帯域制限済みのため広い遷移帯で足りる
+    static constexpr double transition[3] = { 0.05, 0.27, 0.38 };
+    return transition[juce::jlimit(0, 2, stageIndex)];
+}
+
+double CustomInputOversampler::getMinimumPhaseLatencyBaseSamples(int ratio) noexcept
+{
+    const int safeRatio = sanitizeRatio(ratio);
+    const int stagesNeeded = convo::dsp::halfBandStagesForRatio(safeRatio);
+
+    double totalLatencyBaseSamples = 0.0;
+    for (int stage = 0; stage < stagesNeeded; ++stage)
+    {
+        double coeffs[kMaxAllpassCoeffs] {};
+        const int numCoeffs = designAllpassCoeffs(coeffs,
+                                                  attenuationForStage(stage, Preset::MinimumPhase),
+                                                  transitionForStage(stage));
+        // up + down の 2 パス分をステージレートから base rate へ換算。
+        // decimate は奇数入力 (時刻 2n+1) で出力 n を確定するため、1 ステージレートサンプル分早く揃う
+        const double groupDelayStageRate = 2.0 * allpassGroupDelay(coeffs, numCoeffs) - 1.0;
+        totalLatencyBaseSamples += groupDelayStageRate / static_cast<double>(2 << stage);
+    }
+    return totalLatencyBaseSamples;
+}
+
 void CustomInputOversampler::clearStage(Stage& stage) noexcept
 {
-    stage.convCoeffs.reset();
-    stage.convCoeffsReversed.reset();
+    stage.fir.release();
+    stage.phaseScratchSize = 0;
+    stage.singlePrecision = false;
     for (int ch = 0; ch < kMaxChannels; ++ch)
     {
+        stage.phaseScratch[ch].reset();
+        stage.phaseScratchF32[ch].reset();
+        stage.outScratchF32[ch].reset();
         stage.upHistory[ch].reset();
         stage.downHistory[ch].reset();
+        stage.upHistoryF32[ch].reset();
+        stage.downHistoryF32[ch].reset();
     }
     stage.upHistorySize = 0;
     stage.downHistorySize = 0;
+    stage.allpassPairs = 0;
+    clearAllpassState(stage);
+}
+
+void CustomInputOversampler::clearStageHistories(Stage& stage) noexcept
+{
+    clearStageUpHistory(stage);
+    clearStageDownHistory(stage);
+}
+
+void CustomInputOversampler::clearStageUpHistory(Stage& stage) noexcept
+{
+    for (int ch = 0; ch < kMaxChannels; ++ch)
+    {
+        if (stage.upHistory[ch])
+            juce::FloatVectorOperations::clear(stage.upHistory[ch].get(), stage.upHistorySize);
+        if (stage.upHistoryF32[ch])
+            juce::FloatVectorOperations::clear(stage.upHistoryF32[ch].get(), stage.upHistorySize);
+    }
+    std::memset(stage.upAllpassState, 0, sizeof(stage.upAllpassState));
+}
+
+void CustomInputOversampler::clearStageDownHistory(Stage& stage) noexcept
+{
+    for (int ch = 0; ch < kMaxChannels; ++ch)
+    {
+        if (stage.downHistory[ch])
+            juce::FloatVectorOperations::clear(stage.downHistory[ch].get(), stage.downHistorySize);
+        if (stage.downHistoryF32[ch])
+            juce::FloatVectorOperations::clear(stage.downHistoryF32[ch].get(), stage.downHistorySize);
+    }
+    std::memset(stage.downAllpassState, 0, sizeof(stage.downAllpassState));
+}
+
+// FIR: 履歴長 (interpolate は入力レート、decimate は入力 = 2 倍レートで数える) がそのまま ring-out。
+// 全域通過 IIR: 1 次区間 y = a·(x − y1) + x1 の極は a (1 ステップ = 補間の入力 / 間引きの出力サンプル)
+void CustomInputOversampler::updateSilenceRingOut() noexcept
+{
+    upRingOutBaseSamples = 0;
+    downRingOutBaseSamples = 0;
+
+    std::int64_t up = 0;
+    std::int64_t down = 0;
+    for (int i = 0; i < numStages; ++i)
+    {
+        const Stage& stage = stages[i];
+        const std::int64_t stageRate = std::int64_t { 1 } << i; // ステージ入力レート / base rate
+        if (stage.allpassPairs > 0)
+        {
+            double maxPole = 0.0;
+            for (int j = 0; j < stage.allpassPairs * 2; ++j)
+                maxPole = std::max(maxPole, std::abs(stage.allpassCoeffs[j]));
+            const int stageRingOut = convo::ringOutSamplesForPoleRadius(maxPole);
+            if (stageRingOut == convo::kSilenceRingOutNever)
+            {
+                upRingOutBaseSamples = convo::kSilenceRingOutNever;
+                downRingOutBaseSamples = convo::kSilenceRingOutNever;
+                return;
+            }
+            up += (stageRingOut + stageRate - 1) / stageRate;
+            down += (stageRingOut + stageRate - 1) / stageRate;
+        }
+        else
+        {
+            up += (stage.historyUpKeep + stageRate - 1) / stageRate;
+            down += (stage.historyDownKeep + 2 * stageRate - 1) / (2 * stageRate);
+        }
+    }
+
+    upRingOutBaseSamples = static_cast<int>(std::min<std::int64_t>(up, convo::kSilenceRingOutNever));
+    downRingOutBaseSamples = static_cast<int>(std::min<std::int64_t>(down, convo::kSilenceRingOutNever));
+}
+
+void CustomInputOversampler::clearAllpassState(Stage& stage) noexcept
+{
+    std::memset(stage.upAllpassState, 0, sizeof(stage.upAllpassState));
+    std::memset(stage.downAllpassState, 0, sizeof(stage.downAllpassState));
 }
 
 void CustomInputOversampler::release() noexcept
@@ -131,256 +342,148 @@ void CustomInputOversampler::release() noexcept
     }
 
     workCapacity = 0;
+    memoryCharge.set(0);
     upsampleRatio = 1;
     activePreset = Preset::IIRLike;
     numStages = 0;
     maxInputBlockSize = 0;
     maxUpsampledBlockSize = 0;
+    singlePrecisionStages = 0;
+    upRingOutBaseSamples = 0;
+    downRingOutBaseSamples = 0;
+    upPipeline = &CustomInputOversampler::runUpStages;
+    downPipeline = &CustomInputOversampler::runDownStages;
     convo::publishAtomic(corruptionDetected, false, std::memory_order_release);
     convo::publishAtomic(consecutiveCorruptionAutoClearCount, static_cast<std::uint32_t>(0), std::memory_order_release);
     convo::publishAtomic(hardFallbackActive, false, std::memory_order_release);
 }
 
-double CustomInputOversampler::besselI0(double x) noexcept
-{
-    double sum = 1.0;
-    double term = 1.0;
-    const double xx = x * x;
-    for (int n = 1; n < 100; ++n)
-    {
-        term *= xx / (4.0 * static_cast<double>(n) * static_cast<double>(n));
-        sum += term;
-        if (term < sum * 1.0e-18)
-            break;
-    }
-    return sum;
-}
-
-double CustomInputOversampler::dotProductAvx2(const double* __restrict x,
-                                              const double* __restrict coeffs,
-                                              int n) noexcept
-{
-    // x: upHistory buffer with offset, not guaranteed to be aligned. Use loadu.
-    // coeffs: convCoeffsReversed buffer, guaranteed to be 64-byte aligned. Use load.
-    __m256d acc0 = _mm256_setzero_pd();
-    __m256d acc1 = _mm256_setzero_pd();
-    __m256d acc2 = _mm256_setzero_pd();
-    __m256d acc3 = _mm256_setzero_pd();
-
-    int i = 0;
-    // Unroll 4x to hide FMA latency (16 elements per main loop)
-    for (; i <= n - 16; i += 16)
-    {
-        // Guard: prefetch only when within buffer bounds (safety fix, not performance optimization)
-        if (i + 64 < n) {
-            _mm_prefetch(reinterpret_cast<const char*>(x + i + 64), _MM_HINT_T0);
-            _mm_prefetch(reinterpret_cast<const char*>(coeffs + i + 64), _MM_HINT_T0);
-        }
-
-        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i),      _mm256_load_pd(coeffs + i),      acc0);
-        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4),  _mm256_load_pd(coeffs + i + 4),  acc1);
-        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8),  _mm256_load_pd(coeffs + i + 8),  acc2);
-        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_load_pd(coeffs + i + 12), acc3);
-    }
-    // Handle remaining blocks of 4
-    for (; i <= n - 4; i += 4)
-        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_load_pd(coeffs + i), acc0);
-
-    // Reduction of the four accumulators
-    acc0 = _mm256_add_pd(acc0, acc1);
-    acc2 = _mm256_add_pd(acc2, acc3);
-    acc0 = _mm256_add_pd(acc0, acc2);
-
-    // SIMD horizontal reduction: vextractf128 + hadd (avoid store-to-stack + scalar adds)
-    __m128d vLo = _mm256_castpd256_pd128(acc0);
-    __m128d vHi = _mm256_extractf128_pd(acc0, 1);
-    __m128d vSum = _mm_add_pd(vLo, vHi);
-    vSum = _mm_hadd_pd(vSum, vSum);
-    double sum = _mm_cvtsd_f64(vSum);
-
-    // Scalar remainder
-    for (; i < n; ++i)
-        sum += x[i] * coeffs[i];
-
-    if (isBadSample(sum))
-        sum = 0.0;
-    else if (fastAbs(sum) < kDenormThreshold)
-        sum = 0.0;
-
-    return sum;
-}
-
-#if defined(__AVX2__) && defined(__FMA__)
-double CustomInputOversampler::dotProductDecimateAvx2(
-    const double* __restrict history,
-    const double* __restrict coeffs,
-    int convCount) noexcept
-{
-    // 8-way unroll (32 elements/iteration) for Skylake+ FMA pipeline saturation
-    // FMA latency=4, throughput=0.5 → need 4/0.5=8 independent accumulators
-    __assume(convCount >= 8);
-    __assume(convCount >= 0);
-
-    __m256d acc0 = _mm256_setzero_pd();
-    __m256d acc1 = _mm256_setzero_pd();
-    __m256d acc2 = _mm256_setzero_pd();
-    __m256d acc3 = _mm256_setzero_pd();
-    __m256d acc4 = _mm256_setzero_pd();
-    __m256d acc5 = _mm256_setzero_pd();
-    __m256d acc6 = _mm256_setzero_pd();
-    __m256d acc7 = _mm256_setzero_pd();
-
-    int r = 0;
-    const int unrollEnd = (convCount / 32) * 32;
-    for (; r < unrollEnd; r += 32)
-    {
-        acc0 = _mm256_fmadd_pd(loadStride2(history - (r << 1)),       _mm256_loadu_pd(coeffs + r),       acc0);
-        acc1 = _mm256_fmadd_pd(loadStride2(history - ((r +  4) << 1)), _mm256_loadu_pd(coeffs + r +  4), acc1);
-        acc2 = _mm256_fmadd_pd(loadStride2(history - ((r +  8) << 1)), _mm256_loadu_pd(coeffs + r +  8), acc2);
-        acc3 = _mm256_fmadd_pd(loadStride2(history - ((r + 12) << 1)), _mm256_loadu_pd(coeffs + r + 12), acc3);
-        acc4 = _mm256_fmadd_pd(loadStride2(history - ((r + 16) << 1)), _mm256_loadu_pd(coeffs + r + 16), acc4);
-        acc5 = _mm256_fmadd_pd(loadStride2(history - ((r + 20) << 1)), _mm256_loadu_pd(coeffs + r + 20), acc5);
-        acc6 = _mm256_fmadd_pd(loadStride2(history - ((r + 24) << 1)), _mm256_loadu_pd(coeffs + r + 24), acc6);
-        acc7 = _mm256_fmadd_pd(loadStride2(history - ((r + 28) << 1)), _mm256_loadu_pd(coeffs + r + 28), acc7);
-    }
-
-    // 4-element blocks remainder (16 elements)
-    const int simdEnd = (convCount / 4) * 4;
-    for (; r < simdEnd; r += 4)
-    {
-        __m256d vS = loadStride2(history - (r << 1));
-        __m256d vC = _mm256_loadu_pd(coeffs + r);
-        acc0 = _mm256_fmadd_pd(vS, vC, acc0);
-    }
-
-    // Tree reduction: acc0+acc1, acc2+acc3, acc4+acc5, acc6+acc7
-    acc0 = _mm256_add_pd(acc0, acc1);
-    acc2 = _mm256_add_pd(acc2, acc3);
-    acc4 = _mm256_add_pd(acc4, acc5);
-    acc6 = _mm256_add_pd(acc6, acc7);
-    // acc0+acc2, acc4+acc6
-    acc0 = _mm256_add_pd(acc0, acc2);
-    acc4 = _mm256_add_pd(acc4, acc6);
-    // acc0+acc4
-    acc0 = _mm256_add_pd(acc0, acc4);
-
-    // SIMD horizontal reduction: vextractf128 + hadd
-    __m128d vLo = _mm256_castpd256_pd128(acc0);
-    __m128d vHi = _mm256_extractf128_pd(acc0, 1);
-    __m128d vSum = _mm_add_pd(vLo, vHi);
-    vSum = _mm_hadd_pd(vSum, vSum);
-    double result = _mm_cvtsd_f64(vSum);
-
-    // Scalar remainder (handles non-4-multiple convCount safely)
-    for (; r < convCount; ++r)
-        result += coeffs[r] * history[-(r << 1)];
-
-    return result;
-}
-#endif
-
-bool CustomInputOversampler::prepareStage(Stage& stage, int taps, double attenuationDb, int stageInputMax)
+bool CustomInputOversampler::prepareStage(Stage& stage, int taps, double attenuationDb, int stageInputMax,
+                                          bool singlePrecision)
 {
     clearStage(stage);
 
-    stage.taps = juce::jmax(3, taps | 1);
-    stage.centerTap = (stage.taps - 1) / 2;
-    stage.centerParity = stage.centerTap & 1;
-    stage.convParity = 1 - stage.centerParity;
     stage.maxInputSamples = stageInputMax;
     stage.maxOutputSamples = stageInputMax * 2;
 
-    auto rawCoeffs = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(stage.taps));
-    if (!rawCoeffs) { clearStage(stage); return false; }
-
-    const double beta = (attenuationDb > 50.0)
-                      ? (0.1102 * (attenuationDb - 8.7))
-                      : ((attenuationDb >= 21.0) ? (0.5842 * std::pow(attenuationDb - 21.0, 0.4) + 0.07886 * (attenuationDb - 21.0))
-                                                  : 0.0);
-    const double i0Beta = besselI0(beta);
-    const int M = stage.centerTap;
-
-    for (int n = 0; n < stage.taps; ++n)
+    if (!stage.fir.design(taps, attenuationDb))
     {
-        const double t = static_cast<double>(n - M);
-        const double sinc = (n == M)
-                          ? 0.5
-                          : (std::sin(juce::MathConstants<double>::pi * 0.5 * t) / (juce::MathConstants<double>::pi * t));
-        const double frac = static_cast<double>(n - M) / static_cast<double>(M);
-        const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - frac * frac))) / i0Beta;
-        rawCoeffs[n] = sinc * window;
+        clearStage(stage);
+        return false;
     }
 
-    for (int n = 0; n < stage.taps; ++n)
-    {
-        if (n != stage.centerTap && ((n & 1) == stage.centerParity))
-            rawCoeffs[n] = 0.0;
-    }
+    stage.historyUpKeep = stage.fir.interpolateHistoryKeep();
+    stage.historyDownKeep = stage.fir.decimateHistoryKeep();
+    stage.upHistorySize = stage.historyUpKeep + stage.maxInputSamples + 16;
+    stage.downHistorySize = stage.historyDownKeep + stage.maxOutputSamples + 16;
+
+    // decimate: (convCount - 1 + 出力数) 個の位相履歴
+    stage.phaseScratchSize = stage.fir.decimateScratchSize(stage.maxInputSamples) + 16;
 
-    double sum = 0.0;
-    for (int i = 0; i < stage.taps; ++i)
-        sum += rawCoeffs[i];
-    if (std::abs(sum) > 1.0e-20)
+    if (singlePrecision)
     {
-        const double inv = 1.0 / sum;
-        for (int i = 0; i < stage.taps; ++i)
-            rawCoeffs[i] *= inv;
+        // 単精度ステージ: float 履歴と float 作業領域のみを持つ (double 履歴は確保しない)
+        if (!stage.fir.enableSinglePrecision())
+        {
+            clearStage(stage);
+            return false;
+        }
+        stage.singlePrecision = true;
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            stage.phaseScratchF32[ch] = convo::makeAlignedArray_nothrow<float>(static_cast<size_t>(stage.phaseScratchSize));
+            stage.outScratchF32[ch] = convo::makeAlignedArray_nothrow<float>(static_cast<size_t>(stage.maxOutputSamples + 16));
+            stage.upHistoryF32[ch] = convo::makeResidentArray_nothrow<float>(static_cast<size_t>(stage.upHistorySize));
+            stage.downHistoryF32[ch] = convo::makeResidentArray_nothrow<float>(static_cast<size_t>(stage.downHistorySize));
+            if (!stage.phaseScratchF32[ch] || !stage.outScratchF32[ch] || !stage.upHistoryF32[ch] || !stage.downHistoryF32[ch])
+            {
+                clearStage(stage);
+                return false;
+            }
+        }
+        clearStageHistories(stage);
+        return true;
     }
 
-    rawCoeffs[stage.centerTap] = 0.5;
-    double nonCenterSum = 0.0;
-    for (int i = 0; i < stage.taps; ++i)
-        if (i != stage.centerTap) nonCenterSum += rawCoeffs[i];
-    if (std::abs(nonCenterSum) > 1.0e-20)
+    for (int ch = 0; ch < kMaxChannels; ++ch)
     {
-        const double scale = 0.5 / nonCenterSum;
-        for (int i = 0; i < stage.taps; ++i)
+        stage.phaseScratch[ch] = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(stage.phaseScratchSize));
+        stage.upHistory[ch] = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(stage.upHistorySize));
+        stage.downHistory[ch] = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(stage.downHistorySize));
+        if (!stage.phaseScratch[ch] || !stage.upHistory[ch] || !stage.downHistory[ch])
         {
-            if (i != stage.centerTap)
-                rawCoeffs[i] *= scale;
+            clearStage(stage);
+            return false;
         }
+        juce::FloatVectorOperations::clear(stage.phaseScratch[ch].get(), stage.phaseScratchSize);
+        juce::FloatVectorOperations::clear(stage.upHistory[ch].get(), stage.upHistorySize);
+        juce::FloatVectorOperations::clear(stage.downHistory[ch].get(), stage.downHistorySize);
     }
-    rawCoeffs[stage.centerTap] = 0.5;
-
-    stage.convCount = (stage.taps - stage.convParity + 1) / 2;
-    stage.convCoeffs = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(stage.convCount));
-    stage.convCoeffsReversed = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(stage.convCount));
+    return true;
+}
 
-    if (!stage.convCoeffs || !stage.convCoeffsReversed)
+int CustomInputOversampler::designAllpassCoeffs(double* coeffs, double attenuationDb, double transitionBandwidth) noexcept
+{
+    const double transition = juce::jlimit(1.0e-3, 0.49, transitionBandwidth);
+    double k = 0.0;
+    double q = 0.0;
+    allpassTransitionParams(transition, k, q);
+
+    // 楕円フィルタ次数推定 → 係数数。2 経路を同段数にそろえるため偶数へ切り上げる
+    const double attnP2 = std::pow(10.0, -attenuationDb / 10.0);
+    const double a = attnP2 / (1.0 - attnP2);
+    int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+    order = juce::jmax(3, order | 1);
+    int numCoeffs = (order - 1) / 2;
+    numCoeffs = juce::jlimit(2, kMaxAllpassCoeffs, (numCoeffs + 1) & ~1);
+    order = numCoeffs * 2 + 1;
+
+    for (int i = 0; i < numCoeffs; ++i)
     {
-        clearStage(stage);
-        return false;
+        const double num = allpassAccNum(q, order, i + 1) * std::pow(q, 0.25);
+        const double den = allpassAccDen(q, order, i + 1) + 0.5;
+        const double ww = num / den;
+        const double wwSq = ww * ww;
+        const double x = std::sqrt((1.0 - wwSq * k) * (1.0 - wwSq / k)) / (1.0 + wwSq);
+        const double coeff = (1.0 - x) / (1.0 + x);
+        if (!std::isfinite(coeff) || fastAbs(coeff) >= 1.0)
+            return 0;
+        coeffs[i] = coeff;
     }
+    return numCoeffs;
+}
 
-    for (int r = 0; r < stage.convCount; ++r)
+double CustomInputOversampler::allpassGroupDelay(const double* coeffs, int numCoeffs) noexcept
+{
+    // 1 次全域通過 (a + z⁻²)/(1 + a·z⁻²) の DC 群遅延 = 2·(1 − a)/(1 + a) [ステージレートサンプル]。
+    // H = 0.5·(A0 + z⁻¹·A1) の DC 群遅延は 2 経路の平均。
+    double delayA0 = 0.0;
+    double delayA1 = 1.0;
+    for (int i = 0; i < numCoeffs; ++i)
     {
-        const int k = stage.convParity + (r << 1);
-        stage.convCoeffs[r] = (k < stage.taps) ? rawCoeffs[k] : 0.0;
-        stage.convCoeffsReversed[stage.convCount - 1 - r] = stage.convCoeffs[r];
+        const double d = 2.0 * (1.0 - coeffs[i]) / (1.0 + coeffs[i]);
+        if ((i & 1) == 0) delayA0 += d;
+        else              delayA1 += d;
     }
+    return (numCoeffs > 0) ? 0.5 * (delayA0 + delayA1) : 0.0;
+}
 
-    stage.centerCoeff = rawCoeffs[stage.centerTap];
-    stage.centerDelayInput = (stage.centerTap - stage.centerParity) / 2;
-    stage.historyUpKeep = juce::jmax(stage.convCount - 1, stage.centerDelayInput);
-    // loadStride2 が ptr[-6] までアクセスするため、historyDownKeep に +6 マージンを追加
-    // ref: doc/work46/bug.md (Bug #1)
-    stage.historyDownKeep = juce::jmax(stage.centerTap, stage.convParity + ((stage.convCount - 1) << 1) + 6);
+bool CustomInputOversampler::prepareAllpassStage(Stage& stage, double attenuationDb, double transitionBandwidth, int stageInputMax) noexcept
+{
+    clearStage(stage);
 
-    stage.upHistorySize = stage.historyUpKeep + stage.maxInputSamples + 16;
-    stage.downHistorySize = stage.historyDownKeep + stage.maxOutputSamples + 16;
+    stage.maxInputSamples = stageInputMax;
+    stage.maxOutputSamples = stageInputMax * 2;
 
-    for (int ch = 0; ch < kMaxChannels; ++ch)
+    const int numCoeffs = designAllpassCoeffs(stage.allpassCoeffs, attenuationDb, transitionBandwidth);
+    if (numCoeffs <= 0)
     {
-        stage.upHistory[ch] = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(stage.upHistorySize));
-        stage.downHistory[ch] = convo::makeAlignedArray_nothrow<double>(static_cast<size_t>(stage.downHistorySize));
-        if (!stage.upHistory[ch] || !stage.downHistory[ch])
-        {
-            clearStage(stage);
-            return false;
-        }
-        juce::FloatVectorOperations::clear(stage.upHistory[ch].get(), stage.upHistorySize);
-        juce::FloatVectorOperations::clear(stage.downHistory[ch].get(), stage.downHistorySize);
+        clearStage(stage);
+        return false;
     }
+
+    stage.allpassPairs = numCoeffs / 2;
+    clearAllpassState(stage);
     return true;
 }
 
@@ -404,27 +507,38 @@ bool CustomInputOversampler::prepareSingleStage(int taps, double attenDb, int st
         if (workB[ch]) juce::FloatVectorOperations::clear(workB[ch].get(), workCapacity);
         blockChannels[ch] = workA[ch].get();
     }
+    updateSilenceRingOut();
+    memoryCharge.set(computeBufferBytes());
     return true;
 }
 
-void CustomInputOversampler::prepare(int newMaxInputBlockSize, int ratio, Preset preset)
+void CustomInputOversampler::prepare(int newMaxInputBlockSize, int ratio, Preset preset, StagePrecision precision)
 {
     release();
 
     maxInputBlockSize = juce::jmax(1, newMaxInputBlockSize);
     upsampleRatio = sanitizeRatio(ratio);
     activePreset = preset;
-    numStages = (upsampleRatio == 8) ? 3 : ((upsampleRatio == 4) ? 2 : ((upsampleRatio == 2) ? 1 : 0));
+    numStages = convo::dsp::halfBandStagesForRatio(upsampleRatio);
     maxUpsampledBlockSize = maxInputBlockSize * upsampleRatio;
 
+    const bool upperStagesF32 = (precision == StagePrecision::Float32UpperStages)
+                             && (activePreset != Preset::MinimumPhase);
+
     int stageInputMax = maxInputBlockSize;
     for (int i = 0; i < numStages; ++i)
     {
-        if (!prepareStage(stages[i], tapsForStage(i, activePreset), attenuationForStage(i, activePreset), stageInputMax))
+        const bool stageF32 = upperStagesF32 && (i >= kFirstSinglePrecisionStage);
+        const bool stageReady = (activePreset == Preset::MinimumPhase)
+            ? prepareAllpassStage(stages[i], attenuationForStage(i, activePreset), transitionForStage(i), stageInputMax)
+            : prepareStage(stages[i], tapsForStage(i, activePreset), attenuationForStage(i, activePreset), stageInputMax, stageF32);
+        if (!stageReady)
         {
             release();
             return;
         }
+        if (stageF32)
+            ++singlePrecisionStages;
         stageInputMax *= 2;
     }
 
@@ -442,19 +556,75 @@ void CustomInputOversampler::prepare(int newMaxInputBlockSize, int ratio, Preset
         juce::FloatVectorOperations::clear(workB[ch].get(), workCapacity);
         blockChannels[ch] = workA[ch].get();
     }
+    selectPipelines();
+    updateSilenceRingOut();
+    memoryCharge.set(computeBufferBytes());
 }
 
-void CustomInputOversampler::reset() noexcept
+void CustomInputOversampler::selectPipelines() noexcept
 {
+    upPipeline = &CustomInputOversampler::runUpStages;
+    downPipeline = &CustomInputOversampler::runDownStages;
+    if (activePreset == Preset::MinimumPhase || singlePrecisionStages > 0 || numStages < 1 || numStages > 3)
+        return;
+
+    // 設計済みステージがテンプレート側の位相分解と一致するときだけ切り替える
+    for (int i = 0; i < numStages; ++i)
+        if (stages[i].fir.taps != firStageTaps(activePreset, i))
+            return;
+
+    using Self = CustomInputOversampler;
+    static constexpr UpPipeline kUp[2][3] = {
+        { &Self::runUpStagesFixed<Preset::IIRLike, 0, 1>,
+          &Self::runUpStagesFixed<Preset::IIRLike, 0, 2>,
+          &Self::runUpStagesFixed<Preset::IIRLike, 0, 3> },
+        { &Self::runUpStagesFixed<Preset::LinearPhase, 0, 1>,
+          &Self::runUpStagesFixed<Preset::LinearPhase, 0, 2>,
+          &Self::runUpStagesFixed<Preset::LinearPhase, 0, 3> }
+    };
+    static constexpr DownPipeline kDown[2][3] = {
+        { &Self::runDownStagesFixed<Preset::IIRLike, 0, 1>,
+          &Self::runDownStagesFixed<Preset::IIRLike, 1, 2>,
+          &Self::runDownStagesFixed<Preset::IIRLike, 2, 3> },
+        { &Self::runDownStagesFixed<Preset::LinearPhase, 0, 1>,
+          &Self::runDownStagesFixed<Preset::LinearPhase, 1, 2>,
+          &Self::runDownStagesFixed<Preset::LinearPhase, 2, 3> }
+    };
+    const int presetIndex = (activePreset == Preset::LinearPhase) ? 1 : 0;
+    upPipeline = kUp[presetIndex][numStages - 1];
+    downPipeline = kDown[presetIndex][numStages - 1];
+}
+
+size_t CustomInputOversampler::computeBufferBytes() const noexcept
+{
+    size_t doubles = 0;
+    size_t floats = 0;
     for (int i = 0; i < numStages; ++i)
     {
-        auto& stage = stages[i];
+        const Stage& stage = stages[i];
         for (int ch = 0; ch < kMaxChannels; ++ch)
         {
-            if (stage.upHistory[ch]) juce::FloatVectorOperations::clear(stage.upHistory[ch].get(), stage.upHistorySize);
-            if (stage.downHistory[ch]) juce::FloatVectorOperations::clear(stage.downHistory[ch].get(), stage.downHistorySize);
+            doubles += stage.upHistory[ch] ? static_cast<size_t>(stage.upHistorySize) : 0;
+            doubles += stage.downHistory[ch] ? static_cast<size_t>(stage.downHistorySize) : 0;
+            doubles += stage.phaseScratch[ch] ? static_cast<size_t>(stage.phaseScratchSize) : 0;
+            floats += stage.upHistoryF32[ch] ? static_cast<size_t>(stage.upHistorySize) : 0;
+            floats += stage.downHistoryF32[ch] ? static_cast<size_t>(stage.downHistorySize) : 0;
+            floats += stage.phaseScratchF32[ch] ? static_cast<size_t>(stage.phaseScratchSize) : 0;
+            floats += stage.outScratchF32[ch] ? static_cast<size_t>(stage.maxOutputSamples + 16) : 0;
         }
     }
+    for (int ch = 0; ch < kMaxChannels; ++ch)
+    {
+        doubles += workA[ch] ? static_cast<size_t>(workCapacity) : 0;
+        doubles += workB[ch] ? static_cast<size_t>(workCapacity) : 0;
+    }
+    return doubles * sizeof(double) + floats * sizeof(float);
+}
+
+void CustomInputOversampler::reset() noexcept
+{
+    for (int i = 0; i < numStages; ++i)
+        clearStageHistories(stages[i]);
 
     convo::publishAtomic(corruptionDetected, false, std::memory_order_release);
     convo::publishAtomic(consecutiveCorruptionAutoClearCount, static_cast<std::uint32_t>(0), std::memory_order_release);
@@ -464,20 +634,49 @@ void CustomInputOversampler::reset() noexcept
 void CustomInputOversampler::clearAllStages() noexcept
 {
     for (int i = 0; i < numStages; ++i)
-    {
-        auto& stage = stages[i];
-        for (int ch = 0; ch < kMaxChannels; ++ch)
-        {
-            if (stage.upHistory[ch])
-                juce::FloatVectorOperations::clear(stage.upHistory[ch].get(), stage.upHistorySize);
-            if (stage.downHistory[ch])
-                juce::FloatVectorOperations::clear(stage.downHistory[ch].get(), stage.downHistorySize);
-        }
-    }
+        clearStageHistories(stages[i]);
 
     convo::publishAtomic(corruptionDetected, false, std::memory_order_release);
 }
 
+void CustomInputOversampler::clearUpHistories() noexcept
+{
+    for (int i = 0; i < numStages; ++i)
+        clearStageUpHistory(stages[i]);
+}
+
+void CustomInputOversampler::clearDownHistories() noexcept
+{
+    for (int i = 0; i < numStages; ++i)
+        clearStageDownHistory(stages[i]);
+}
+
+bool CustomInputOversampler::canSkipSilentBlocks() const noexcept
+{
+    return upsampleRatio > 1 && numStages > 0 && workCapacity > 0
+        && !convo::consumeAtomic(hardFallbackActive, std::memory_order_acquire);
+}
+
+juce::dsp::AudioBlock<double> CustomInputOversampler::processUpSilent(int numInputSamples, int numChannels) noexcept
+{
+    if (!canSkipSilentBlocks() || numInputSamples > maxInputBlockSize)
+        return {};
+
+    // processUp の最終ステージと同じ作業バッファへ書く (processDown の作業領域の使い方を変えない)
+    const int channels = juce::jlimit(1, kMaxChannels, numChannels);
+    const int outSamples = juce::jmax(0, numInputSamples) * upsampleRatio;
+    const bool lastToA = (((numStages - 1) & 1) == 0);
+    for (int ch = 0; ch < kMaxChannels; ++ch)
+    {
+        blockChannels[ch] = lastToA ? workA[ch].get() : workB[ch].get();
+        if (ch < channels)
+            juce::FloatVectorOperations::clear(blockChannels[ch].get(), outSamples);
+    }
+    blockChannelView[0] = blockChannels[0].get();
+    blockChannelView[1] = blockChannels[1].get();
+    return { blockChannelView, static_cast<size_t>(channels), static_cast<size_t>(outSamples) };
+}
+
 void CustomInputOversampler::markCorruptionDetected() noexcept
 {
     convo::fetchAddAtomic(corruptionEventCount, static_cast<std::uint64_t>(1), std::memory_order_acq_rel);
@@ -494,88 +693,209 @@ void CustomInputOversampler::interpolateStage(const Stage& stage,
     if (history == nullptr || input == nullptr || output == nullptr)
         return;
 
+    // 境界はブロック単位で事前検証 (prepareStage の履歴長 = keep + maxInputSamples + 16)
+    if (!stage.fir.isReady() || inputSamples > stage.maxInputSamples)
+    {
+        markCorruptionDetected();
+        juce::FloatVectorOperations::clear(output, inputSamples * 2);
+        return;
+    }
+
     const int keep = stage.historyUpKeep;
-    const int capacity = stage.upHistorySize;
     juce::FloatVectorOperations::copy(history + keep, input, inputSamples);
 
-    for (int n = 0; n < inputSamples; ++n)
+    // ── ポリフェーズ縦方向パス (HalfBandFir): conv 位相をブロック一括で計算 ──
+    stage.fir.interpolate(history, keep, inputSamples, output);
+    if (sanitizeStageOutput(output, inputSamples * 2))
+        markCorruptionDetected();
+
+    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(double));
+}
+
+void CustomInputOversampler::decimateStage(const Stage& stage,
+                                           const double* __restrict input,
+                                           int inputSamples,
+                                           double* __restrict output,
+                                           int channel) noexcept
+{
+    double* __restrict history = stage.downHistory[channel].get();
+    if (history == nullptr || input == nullptr || output == nullptr)
+        return;
+
+    const int keep = stage.historyDownKeep;
+    const int outSamples = inputSamples >> 1;
+
+    // ── [既存] サイレンス最適化パス ──
+    bool inputSilent = true;
+    for (int i = 0; i < inputSamples; ++i)
     {
-        const int idx = keep + n;
-        if (idx < (stage.convCount - 1) || idx >= capacity)
+        if (fastAbs(input[i]) > kDenormThreshold)
         {
-            markCorruptionDetected();
-            output[n * 2 + 0] = 0.0;
-            output[n * 2 + 1] = 0.0;
-            continue;
+            inputSilent = false;
+            break;
         }
+    }
 
-        const double* xWindow = history + idx - (stage.convCount - 1);
-        double convValue = 0.0;
-        bool bad = false;
+    if (inputSilent)
+    {
+        bool historySilent = true;
+        for (int i = 0; i < keep; ++i)
+        {
+            if (fastAbs(history[i]) > kDenormThreshold)
+            {
+                historySilent = false;
+                break;
+            }
+        }
 
-#if defined(__AVX2__)
-        if (stage.convCount >= 4)
+        if (historySilent)
         {
-            convValue = dotProductAvx2(xWindow, stage.convCoeffsReversed.get(), stage.convCount);
-            if (isBadSample(convValue))
-                bad = true;
+            juce::FloatVectorOperations::clear(output, outSamples);
+            juce::FloatVectorOperations::clear(history, keep);
+            return;
         }
-        else
-#endif
+    }
+
+    // [Safety Guard] outSamples == 0 の場合は何もしない
+    if (outSamples <= 0)
+        return;
+
+    // 境界はブロック単位で事前検証 (prepareStage の履歴長 = keep + maxOutputSamples + 16)
+    if (!stage.fir.isReady()
+        || inputSamples > stage.maxOutputSamples
+        || stage.fir.decimateScratchSize(outSamples) > stage.phaseScratchSize)
+    {
+        std::memset(output, 0, static_cast<size_t>(outSamples) * sizeof(double));
+        markCorruptionDetected();
+        return;
+    }
+
+    juce::FloatVectorOperations::copy(history + keep, input, inputSamples);
+
+    // ── ポリフェーズ縦方向パス (HalfBandFir): conv 位相を deinterleave して連続 FIR ──
+    // 出力の NaN/Inf 走査はしない: FIR は再帰を持たず、混入は DSPCore 出力段の検査 (BlockHealthScan.h) が
+    // reportDownstreamCorruption で知らせる
+    stage.fir.decimate(history, keep, outSamples, stage.phaseScratch[channel].get(), output);
+
+    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(double));
+}
+
+// 以下 2 つは比率 × プリセット別パイプライン専用。履歴・作業領域の存在、設計済みであること、
+// 入力長 ≤ ステージ上限は prepare / processUp / processDown が保証するので、段ごとには検査しない
+template <int Taps>
+void CustomInputOversampler::interpolateStageFixed(const Stage& stage,
+                                                   const double* __restrict input,
+                                                   int inputSamples,
+                                                   double* __restrict output,
+                                                   int channel) noexcept
+{
+    constexpr int keep = convo::dsp::HalfBandGeometry<Taps>::interpolateHistoryKeep;
+    double* history = stage.upHistory[channel].get();
+
+    std::memcpy(history + keep, input, static_cast<size_t>(inputSamples) * sizeof(double));
+    stage.fir.interpolateFixed<Taps>(history, inputSamples, output);
+    if (sanitizeStageOutput(output, inputSamples * 2))
+        markCorruptionDetected();
+
+    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(double));
+}
+
+template <int Taps>
+void CustomInputOversampler::decimateStageFixed(const Stage& stage,
+                                                const double* __restrict input,
+                                                int inputSamples,
+                                                double* __restrict output,
+                                                int channel) noexcept
+{
+    constexpr int keep = convo::dsp::HalfBandGeometry<Taps>::decimateHistoryKeep;
+    double* __restrict history = stage.downHistory[channel].get();
+    const int outSamples = inputSamples >> 1;
+
+    // サイレンス最適化 (decimateStage と同じ判定)
+    bool inputSilent = true;
+    for (int i = 0; i < inputSamples; ++i)
+    {
+        if (fastAbs(input[i]) > kDenormThreshold)
         {
-            for (int r = 0; r < stage.convCount; ++r)
+            inputSilent = false;
+            break;
+        }
+    }
+
+    if (inputSilent)
+    {
+        bool historySilent = true;
+        for (int i = 0; i < keep; ++i)
+        {
+            if (fastAbs(history[i]) > kDenormThreshold)
             {
-                const double x = xWindow[r];
-                if (isBadSample(x))
-                {
-                    bad = true;
-                    break;
-                }
-                convValue += stage.convCoeffsReversed[r] * x;
+                historySilent = false;
+                break;
             }
         }
 
-        double centerValue = 0.0;
-        if (idx >= stage.centerDelayInput)
-            centerValue = stage.centerCoeff * history[idx - stage.centerDelayInput];
-        else
-            bad = true;
-
-        if (bad || isBadSample(centerValue))
+        if (historySilent)
         {
-            markCorruptionDetected();
-            output[n * 2 + 0] = 0.0;
-            output[n * 2 + 1] = 0.0;
-            continue;
+            juce::FloatVectorOperations::clear(output, outSamples);
+            juce::FloatVectorOperations::clear(history, keep);
+            return;
         }
+    }
+
+    if (outSamples <= 0)
+        return;
 
-        convValue *= 2.0;
-        if (fastAbs(convValue) < kDenormThreshold) convValue = 0.0;
-        if (fastAbs(centerValue) < kDenormThreshold) centerValue = 0.0;
+    std::memcpy(history + keep, input, static_cast<size_t>(inputSamples) * sizeof(double));
+    stage.fir.decimateFixed<Taps>(history, outSamples, stage.phaseScratch[channel].get(), output);
+    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(double));
+}
 
-        const int outBase = n << 1;
+void CustomInputOversampler::interpolateStageF32(const Stage& stage,
+                                                 const double* input,
+                                                 int inputSamples,
+                                                 double* output,
+                                                 int channel,
+                                                 bool inputIsFloatExact) noexcept
+{
+    float* history = stage.upHistoryF32[channel].get();
+    float* outF32 = stage.outScratchF32[channel].get();
+    if (history == nullptr || outF32 == nullptr || input == nullptr || output == nullptr)
+        return;
 
-        output[outBase + stage.convParity] = convValue;
-        output[outBase + stage.centerParity] = centerValue;
+    if (!stage.fir.isSinglePrecisionReady() || inputSamples > stage.maxInputSamples)
+    {
+        markCorruptionDetected();
+        juce::FloatVectorOperations::clear(output, inputSamples * 2);
+        return;
     }
 
-    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(double));
+    // ステージ境界: double → float (ディザ) → float FIR → double (無損失)
+    const int keep = stage.historyUpKeep;
+    quantizeToFloat(input, history + keep, inputSamples, !inputIsFloatExact, ditherState[channel]);
+    stage.fir.interpolate(history, keep, inputSamples, outF32);
+    widenToDouble(outF32, output, inputSamples * 2);
+    if (sanitizeStageOutput(output, inputSamples * 2))
+        markCorruptionDetected();
+
+    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(float));
 }
 
-void CustomInputOversampler::decimateStage(const Stage& stage,
-                                           const double* __restrict input,
-                                           int inputSamples,
-                                           double* __restrict output,
-                                           int channel) noexcept
+void CustomInputOversampler::decimateStageF32(const Stage& stage,
+                                              const double* __restrict input,
+                                              int inputSamples,
+                                              double* __restrict output,
+                                              int channel,
+                                              bool inputIsFloatExact) noexcept
 {
-    double* __restrict history = stage.downHistory[channel].get();
-    if (history == nullptr || input == nullptr || output == nullptr)
+    float* __restrict history = stage.downHistoryF32[channel].get();
+    float* outF32 = stage.outScratchF32[channel].get();
+    if (history == nullptr || outF32 == nullptr || input == nullptr || output == nullptr)
         return;
 
     const int keep = stage.historyDownKeep;
-    const int capacity = stage.downHistorySize;
+    const int outSamples = inputSamples >> 1;
 
-    // ── [既存] サイレンス最適化パス（変更なし） ──
+    // サイレンス最適化 (double 版と同じ判定)
     bool inputSilent = true;
     for (int i = 0; i < inputSamples; ++i)
     {
@@ -591,7 +911,7 @@ void CustomInputOversampler::decimateStage(const Stage& stage,
         bool historySilent = true;
         for (int i = 0; i < keep; ++i)
         {
-            if (fastAbs(history[i]) > kDenormThreshold)
+            if (std::abs(history[i]) > static_cast<float>(kDenormThreshold))
             {
                 historySilent = false;
                 break;
@@ -600,121 +920,165 @@ void CustomInputOversampler::decimateStage(const Stage& stage,
 
         if (historySilent)
         {
-            const int outSamples = inputSamples >> 1;
             juce::FloatVectorOperations::clear(output, outSamples);
             juce::FloatVectorOperations::clear(history, keep);
             return;
         }
     }
 
-    juce::FloatVectorOperations::copy(history + keep, input, inputSamples);
-
-    const int outSamples = inputSamples >> 1;
-    const double* __restrict coeffs = stage.convCoeffs.get();
-
-    // [Safety Guard] outSamples == 0 の場合、baseMax が不正になるため早期return
     if (outSamples <= 0)
         return;
 
-    // ── P1-1: nループ外部へのバウンドチェック完全外出し ──
-    // base = keep + (n << 1) は n に単調増加 → global min/max を事前計算
-    const int baseMax = keep + ((outSamples - 1) << 1);
+    if (!stage.fir.isSinglePrecisionReady()
+        || inputSamples > stage.maxOutputSamples
+        || stage.fir.decimateScratchSize(outSamples) > stage.phaseScratchSize)
+    {
+        std::memset(output, 0, static_cast<size_t>(outSamples) * sizeof(double));
+        markCorruptionDetected();
+        return;
+    }
+
+    quantizeToFloat(input, history + keep, inputSamples, !inputIsFloatExact, ditherState[channel]);
+    stage.fir.decimate(history, keep, outSamples, stage.phaseScratchF32[channel].get(), outF32);
+    widenToDouble(outF32, output, outSamples); // 走査しない理由は decimateStage と同じ
 
-    // centerTap用: base - centerTap >= 0 → keep >= centerTap; base < capacity → baseMax < capacity
-    const bool centerTapOk = (keep >= stage.centerTap) && (baseMax < capacity);
+    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(float));
+}
 
-    // convタップ範囲: 最小convIndex = n=0,r=convCount-1; 最大convIndex = n=outSamples-1,r=0
-    // 注: globalMinConvIdx は loadStride2 の ptr[-6] を考慮しないスカラー最低位置。
-    //     AVX2 パスの実最低アクセスは index 0 となる（prepareStage の +6 マージン保証）。
-    //     globalMinConvIdx >= 0 はスカラー経路の安全条件として十分であり、
-    //     +6 マージンは prepareStage 側で historyDownKeep に組み込まれている。
-    const int globalMinConvIdx = keep - stage.convParity - ((stage.convCount - 1) << 1);
-    const int globalMaxConvIdx = baseMax - stage.convParity;
-    const bool convTapOk = (globalMinConvIdx >= 0) && (globalMaxConvIdx < capacity);
+void CustomInputOversampler::interpolateStageAllpass(Stage& stage,
+                                                     const double* __restrict input,
+                                                     int inputSamples,
+                                                     double* __restrict output,
+                                                     int channel) noexcept
+{
+    if (input == nullptr || output == nullptr)
+        return;
 
-    if (!centerTapOk || !convTapOk || stage.convCount <= 0)
+    const int pairs = stage.allpassPairs;
+    if (pairs <= 0 || pairs > kMaxAllpassCoeffs / 2 || inputSamples > stage.maxInputSamples)
     {
-        // ブロック全体が境界違反 → 全出力0クリア
-        std::memset(output, 0, static_cast<size_t>(outSamples) * sizeof(double));
         markCorruptionDetected();
+        juce::FloatVectorOperations::clear(output, inputSamples * 2);
         return;
     }
 
-    // ── nループ（境界安全100%保証済み） ──
-    for (int n = 0; n < outSamples; ++n)
+    // 状態はブロック中ローカルに保持し、終了時に 1 回だけ書き戻す
+    double* state = stage.upAllpassState[channel];
+    __m128d a[kMaxAllpassCoeffs / 2];
+    __m128d x1[kMaxAllpassCoeffs / 2];
+    __m128d y1[kMaxAllpassCoeffs / 2];
+    for (int j = 0; j < pairs; ++j)
     {
-        const int base = keep + (n << 1);
+        a[j] = _mm_load_pd(stage.allpassCoeffs + (j << 1));
+        x1[j] = _mm_load_pd(state + (j << 2));
+        y1[j] = _mm_load_pd(state + (j << 2) + 2);
+    }
 
-        // centerCoeffは動的な履歴値に依存 → nループ内でチェック
-        const double centerSample = history[base - stage.centerTap];
-        double acc = stage.centerCoeff * centerSample;
-        if (isBadSample(acc))
+    bool bad = false;
+    for (int n = 0; n < inputSamples; ++n)
+    {
+        // 両経路に同一入力 → lower = 偶数出力 (A0), upper = 奇数出力 (A1)。補間ゲイン 2 は 0.5 と相殺済み
+        __m128d v = _mm_set1_pd(input[n]);
+        for (int j = 0; j < pairs; ++j)
+            v = allpassPairStep(v, a[j], x1[j], y1[j]);
+
+        alignas(16) double lanes[2];
+        _mm_store_pd(lanes, v);
+        if (isBadSample(lanes[0]) || isBadSample(lanes[1]))
         {
-            output[n] = 0.0;
-            markCorruptionDetected();
+            bad = true;
+            output[n * 2 + 0] = 0.0;
+            output[n * 2 + 1] = 0.0;
             continue;
         }
 
-        // ── P1-2: stride-2 dot product（AVX2） ──
-#if defined(__AVX2__) && defined(__FMA__)
-        if (stage.convCount >= 8)
-        {
-            // 8重アンロール dotProductDecimateAvx2（convCount>=8 で効果的）
-            __assume(stage.convCount >= 8);
-            acc += dotProductDecimateAvx2(
-                history + (base - stage.convParity),
-                coeffs,
-                stage.convCount);
-        }
-        else if (stage.convCount >= 4)
-        {
-            // convCount 4〜7: 簡易AVX2（unrollなしのloadStride2）
-            __m256d vAcc = _mm256_setzero_pd();
-            int r = 0;
-            const int simdEnd = (stage.convCount / 4) * 4;
-            for (; r < simdEnd; r += 4)
-            {
-                __m256d vS = loadStride2(
-                    history + (base - stage.convParity) - (r << 1));
-                __m256d vC = _mm256_loadu_pd(coeffs + r);
-                vAcc = _mm256_fmadd_pd(vS, vC, vAcc);
-            }
-            // 水平加算（vextractf128 + hadd）
-            __m128d vLo = _mm256_castpd256_pd128(vAcc);
-            __m128d vHi = _mm256_extractf128_pd(vAcc, 1);
-            __m128d vSum = _mm_add_pd(vLo, vHi);
-            vSum = _mm_hadd_pd(vSum, vSum);
-            acc += _mm_cvtsd_f64(vSum);
-            // スカラー剰余
-            for (; r < stage.convCount; ++r)
-                acc += coeffs[r] * history[base - stage.convParity - (r << 1)];
-        }
-        else
-#endif
-        {
-            // convCount < 4: スカラーパス（バリデーション済み、チェックなし）
-            for (int r = 0; r < stage.convCount; ++r)
-                acc += coeffs[r] * history[base - stage.convParity - (r << 1)];
-        }
+        output[n * 2 + 0] = (fastAbs(lanes[0]) < kDenormThreshold) ? 0.0 : lanes[0];
+        output[n * 2 + 1] = (fastAbs(lanes[1]) < kDenormThreshold) ? 0.0 : lanes[1];
+    }
+
+    if (bad)
+    {
+        markCorruptionDetected();
+        std::memset(state, 0, sizeof(stage.upAllpassState[channel]));
+        return;
+    }
+
+    for (int j = 0; j < pairs; ++j)
+    {
+        _mm_store_pd(state + (j << 2), x1[j]);
+        _mm_store_pd(state + (j << 2) + 2, y1[j]);
+    }
+    // 無音減衰時の再帰状態 denormal を除去
+    for (int i = 0; i < (pairs << 2); ++i)
+        if (fastAbs(state[i]) < kDenormThreshold) state[i] = 0.0;
+}
+
+void CustomInputOversampler::decimateStageAllpass(Stage& stage,
+                                                  const double* __restrict input,
+                                                  int inputSamples,
+                                                  double* __restrict output,
+                                                  int channel) noexcept
+{
+    if (input == nullptr || output == nullptr)
+        return;
 
-        // ── 事後処理（bad sample + denormal） ──
+    const int outSamples = inputSamples >> 1;
+    const int pairs = stage.allpassPairs;
+    if (pairs <= 0 || pairs > kMaxAllpassCoeffs / 2 || inputSamples > stage.maxOutputSamples)
+    {
+        markCorruptionDetected();
+        juce::FloatVectorOperations::clear(output, outSamples);
+        return;
+    }
+
+    double* state = stage.downAllpassState[channel];
+    __m128d a[kMaxAllpassCoeffs / 2];
+    __m128d x1[kMaxAllpassCoeffs / 2];
+    __m128d y1[kMaxAllpassCoeffs / 2];
+    for (int j = 0; j < pairs; ++j)
+    {
+        a[j] = _mm_load_pd(stage.allpassCoeffs + (j << 1));
+        x1[j] = _mm_load_pd(state + (j << 2));
+        y1[j] = _mm_load_pd(state + (j << 2) + 2);
+    }
+
+    bool bad = false;
+    for (int n = 0; n < outSamples; ++n)
+    {
+        // lower (A0) ← 新しい奇数サンプル, upper (A1) ← 1 サンプル古い偶数サンプル (z⁻¹ 経路)
+        __m128d v = _mm_set_pd(input[(n << 1)], input[(n << 1) + 1]);
+        for (int j = 0; j < pairs; ++j)
+            v = allpassPairStep(v, a[j], x1[j], y1[j]);
+
+        const __m128d sum = _mm_add_sd(v, _mm_unpackhi_pd(v, v));
+        const double acc = 0.5 * _mm_cvtsd_f64(sum);
         if (isBadSample(acc))
         {
+            bad = true;
             output[n] = 0.0;
-            markCorruptionDetected();
-        }
-        else
-        {
-            if (fastAbs(acc) < kDenormThreshold) acc = 0.0;
-            output[n] = acc;
+            continue;
         }
+        output[n] = (fastAbs(acc) < kDenormThreshold) ? 0.0 : acc;
     }
 
-    // ── [既存] 履歴シフト（変更なし） ──
-    std::memmove(history, history + inputSamples, static_cast<size_t>(keep) * sizeof(double));
+    if (bad)
+    {
+        markCorruptionDetected();
+        std::memset(state, 0, sizeof(stage.downAllpassState[channel]));
+        return;
+    }
+
+    for (int j = 0; j < pairs; ++j)
+    {
+        _mm_store_pd(state + (j << 2), x1[j]);
+        _mm_store_pd(state + (j << 2) + 2, y1[j]);
+    }
+    for (int i = 0; i < (pairs << 2); ++i)
+        if (fastAbs(state[i]) < kDenormThreshold) state[i] = 0.0;
 }
 
-juce::dsp::AudioBlock<double> CustomInputOversampler::processUp(juce::dsp::AudioBlock<double>& inputBlock, int numChannels) noexcept
+juce::dsp::AudioBlock<double> CustomInputOversampler::processUp(juce::dsp::AudioBlock<double>& inputBlock, int numChannels,
+                                                                convo::ChannelForkJoin* split) noexcept
 {
 
     if (convo::consumeAtomic(hardFallbackActive, std::memory_order_acquire))
@@ -749,34 +1113,74 @@ juce::dsp::AudioBlock<double> CustomInputOversampler::processUp(juce::dsp::Audio
         return { blockChannelView, static_cast<size_t>(channels), static_cast<size_t>(inSamples) };
     }
 
-    double* currIn[2] = { inputBlock.getChannelPointer(0),
-                          (channels > 1) ? inputBlock.getChannelPointer(1) : inputBlock.getChannelPointer(0) };
-    int currSamples = inSamples;
+    double* upOut[2] = { nullptr, nullptr };
+    const UpPipeline pipeline = upPipeline;
+    auto upChannel = [&](int ch) noexcept
+    {
+        upOut[ch] = (this->*pipeline)(ch, inputBlock.getChannelPointer(static_cast<size_t>(ch)), inSamples);
+    };
+
+    if (split != nullptr && channels > 1)
+    {
+        split->fork([](void* context) noexcept { (*static_cast<decltype(upChannel)*>(context))(1); }, &upChannel);
+        upChannel(0);
+        split->join();
+    }
+    else
+    {
+        for (int ch = 0; ch < channels; ++ch)
+            upChannel(ch);
+    }
+
+    blockChannels[0] = upOut[0];
+    blockChannels[1] = (channels > 1) ? upOut[1] : upOut[0];
+    blockChannelView[0] = blockChannels[0].get();
+    blockChannelView[1] = blockChannels[1].get();
+    return { blockChannelView, static_cast<size_t>(channels), static_cast<size_t>(inSamples) << numStages };
+}
+
+double* CustomInputOversampler::runUpStages(int channel, double* input, int inputSamples) noexcept
+{
+    double* currIn = input;
+    int currSamples = inputSamples;
 
     for (int stageIndex = 0; stageIndex < numStages; ++stageIndex)
     {
         const bool writeToA = ((stageIndex & 1) == 0);
-        double* stageOut[2] = { writeToA ? workA[0].get() : workB[0].get(),
-                                writeToA ? workA[1].get() : workB[1].get() };
-
-        for (int ch = 0; ch < channels; ++ch)
-            interpolateStage(stages[stageIndex], currIn[ch], currSamples, stageOut[ch], ch);
+        double* stageOut = writeToA ? workA[channel].get() : workB[channel].get();
+
+        auto& stage = stages[stageIndex];
+        // 直前ステージが単精度なら入力は float で厳密に表現できる (再ディザ不要)
+        const bool inputIsFloatExact = (stageIndex > 0) && stages[stageIndex - 1].singlePrecision;
+        if (stage.allpassPairs > 0)
+            interpolateStageAllpass(stage, currIn, currSamples, stageOut, channel);
+        else if (stage.singlePrecision)
+            interpolateStageF32(stage, currIn, currSamples, stageOut, channel, inputIsFloatExact);
+        else
+            interpolateStage(stage, currIn, currSamples, stageOut, channel);
 
-        currIn[0] = stageOut[0];
-        currIn[1] = stageOut[1];
+        currIn = stageOut;
         currSamples <<= 1;
     }
+    return currIn;
+}
 
-    blockChannels[0] = currIn[0];
-    blockChannels[1] = currIn[1];
-    blockChannelView[0] = blockChannels[0].get();
-    blockChannelView[1] = blockChannels[1].get();
-    return { blockChannelView, static_cast<size_t>(channels), static_cast<size_t>(currSamples) };
+template <CustomInputOversampler::Preset P, int StageIndex, int NumStages>
+double* CustomInputOversampler::runUpStagesFixed(int channel, double* input, int inputSamples) noexcept
+{
+    // 出力先は runUpStages と同じ交互 (段 0 → workA)
+    double* stageOut = ((StageIndex & 1) == 0) ? workA[channel].get() : workB[channel].get();
+    interpolateStageFixed<firStageTaps(P, StageIndex)>(stages[StageIndex], input, inputSamples, stageOut, channel);
+    if constexpr (StageIndex + 1 < NumStages)
+        return runUpStagesFixed<P, StageIndex + 1, NumStages>(channel, stageOut, inputSamples << 1);
+    else
+        return stageOut;
 }
 
 void CustomInputOversampler::processDown(const juce::dsp::AudioBlock<double>& upsampledBlock,
                                          juce::dsp::AudioBlock<double>& outputBlock,
-                                         int numChannels) noexcept
+                                         int numChannels,
+                                         convo::ChannelForkJoin* split) noexcept
 {
     if (convo::consumeAtomic(hardFallbackActive, std::memory_order_acquire))
     {
@@ -834,29 +1238,129 @@ void CustomInputOversampler::processDown(const juce::dsp::AudioBlock<double>& up
         return;
     }
 
-    const double* currIn[2] = { upsampledBlock.getChannelPointer(0),
-                                (channels > 1) ? upsampledBlock.getChannelPointer(1) : upsampledBlock.getChannelPointer(0) };
-    int currSamples = static_cast<int>(upsampledBlock.getNumSamples());
+    const int upSamples = static_cast<int>(upsampledBlock.getNumSamples());
+    const DownPipeline pipeline = downPipeline;
+    auto downChannel = [&](int ch) noexcept
+    {
+        double* dst = outputBlock.getChannelPointer(static_cast<size_t>(ch));
+        const double* src = (this->*pipeline)(ch, upsampledBlock.getChannelPointer(static_cast<size_t>(ch)), upSamples);
+        if (dst != src)
+            std::memcpy(dst, src, static_cast<size_t>(targetSamples) * sizeof(double));
+    };
+
+    if (split != nullptr && channels > 1)
+    {
+        split->fork([](void* context) noexcept { (*static_cast<decltype(downChannel)*>(context))(1); }, &downChannel);
+        downChannel(0);
+        split->join();
+        return;
+    }
+
+    for (int ch = 0; ch < channels; ++ch)
+        downChannel(ch);
+}
+
+const double* CustomInputOversampler::runDownStages(int channel, const double* input, int inputSamples) noexcept
+{
+    const double* currIn = input;
+    int currSamples = inputSamples;
 
     for (int stageIndex = numStages - 1; stageIndex >= 0; --stageIndex)
     {
         const bool writeToA = (((numStages - 1 - stageIndex) & 1) == 0);
-        double* stageOut[2] = { writeToA ? workA[0].get() : workB[0].get(),
-                                writeToA ? workA[1].get() : workB[1].get() };
-
-        for (int ch = 0; ch < channels; ++ch)
-            decimateStage(stages[stageIndex], currIn[ch], currSamples, stageOut[ch], ch);
+        double* stageOut = writeToA ? workA[channel].get() : workB[channel].get();
+
+        auto& stage = stages[stageIndex];
+        const bool inputIsFloatExact = (stageIndex + 1 < numStages) && stages[stageIndex + 1].singlePrecision;
+        if (stage.allpassPairs > 0)
+            decimateStageAllpass(stage, currIn, currSamples, stageOut, channel);
+        else if (stage.singlePrecision)
+            decimateStageF32(stage, currIn, currSamples, stageOut, channel, inputIsFloatExact);
+        else
+            decimateStage(stage, currIn, currSamples, stageOut, channel);
 
-        currIn[0] = stageOut[0];
-        currIn[1] = stageOut[1];
+        currIn = stageOut;
         currSamples >>= 1;
     }
+    return currIn;
+}
 
-    for (int ch = 0; ch < channels; ++ch)
+template <CustomInputOversampler::Preset P, int StageIndex, int NumStages>
+const double* CustomInputOversampler::runDownStagesFixed(int channel, const double* input, int inputSamples) noexcept
+{
+    // 最終段 (NumStages - 1) から段 0 へ。出力先は runDownStages と同じ交互 (最初の段 → workA)
+    double* stageOut = (((NumStages - 1 - StageIndex) & 1) == 0) ? workA[channel].get() : workB[channel].get();
+    decimateStageFixed<firStageTaps(P, StageIndex)>(stages[StageIndex], input, inputSamples, stageOut, channel);
+    if constexpr (StageIndex > 0)
+        return runDownStagesFixed<P, StageIndex - 1, NumStages>(channel, stageOut, inputSamples >> 1);
+    else
+        return stageOut;
+}
+
+CustomInputOversampler::PrecisionErrorReport CustomInputOversampler::measureSinglePrecisionError(int ratio, Preset preset, int blockSize)
+{
+    PrecisionErrorReport report;
+    const int safeBlock = juce::jlimit(16, 4096, blockSize);
+
+    CustomInputOversampler reference;
+    CustomInputOversampler single;
+    reference.prepare(safeBlock, ratio, preset, StagePrecision::Double);
+    single.prepare(safeBlock, ratio, preset, StagePrecision::Float32UpperStages);
+    if (reference.numStages == 0 || !single.isSinglePrecisionActive())
+        return report;
+
+    // L: base rate 0.45·fs の正弦 (−0.2 dBFS、段 0 通過域端)、R: ±0.98 の一様白色雑音。
+    // 試験信号は 2 系統で同一、乱数は固定シードで決定的
+    constexpr int kNumBlocks = 24;
+    constexpr double kAmplitude = 0.98;
+    juce::AudioBuffer<double> inRef(kMaxChannels, safeBlock);
+    juce::AudioBuffer<double> inSingle(kMaxChannels, safeBlock);
+    juce::AudioBuffer<double> outRef(kMaxChannels, safeBlock);
+    juce::AudioBuffer<double> outSingle(kMaxChannels, safeBlock);
+    std::uint32_t noiseState = 0x2545F491u;
+    const double phaseStep = juce::MathConstants<double>::twoPi * 0.45;
+
+    for (int block = 0; block < kNumBlocks; ++block)
     {
-        double* dst = outputBlock.getChannelPointer(ch);
-        const double* src = currIn[ch];
-        if (dst != src)
-            std::memcpy(dst, src, static_cast<size_t>(targetSamples) * sizeof(double));
+        for (int i = 0; i < safeBlock; ++i)
+        {
+            const double n = static_cast<double>(block * safeBlock + i);
+            const double noise = (static_cast<double>(nextDitherRandom(noiseState)) / 2147483648.0) - 1.0;
+            inRef.setSample(0, i, kAmplitude * std::sin(phaseStep * n));
+            inRef.setSample(1, i, kAmplitude * noise);
+        }
+        inSingle.makeCopyOf(inRef, true);
+
+        juce::dsp::AudioBlock<double> inRefBlock(inRef);
+        juce::dsp::AudioBlock<double> inSingleBlock(inSingle);
+        juce::dsp::AudioBlock<double> outRefBlock(outRef);
+        juce::dsp::AudioBlock<double> outSingleBlock(outSingle);
+
+        auto upRef = reference.processUp(inRefBlock, kMaxChannels);
+        auto upSingle = single.processUp(inSingleBlock, kMaxChannels);
+        if (upRef.getNumSamples() != upSingle.getNumSamples() || upRef.getNumSamples() == 0)
+            return report;
+
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            const double* a = upRef.getChannelPointer(static_cast<size_t>(ch));
+            const double* b = upSingle.getChannelPointer(static_cast<size_t>(ch));
+            for (size_t i = 0; i < upRef.getNumSamples(); ++i)
+                report.maxAbsErrorUp = juce::jmax(report.maxAbsErrorUp, std::abs(a[i] - b[i]));
+        }
+
+        reference.processDown(upRef, outRefBlock, kMaxChannels);
+        single.processDown(upSingle, outSingleBlock, kMaxChannels);
+
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            const double* a = outRef.getReadPointer(ch);
+            const double* b = outSingle.getReadPointer(ch);
+            for (int i = 0; i < safeBlock; ++i)
+                report.maxAbsErrorRoundTrip = juce::jmax(report.maxAbsErrorRoundTrip, std::abs(a[i] - b[i]));
+        }
     }
+
+    report.valid = !reference.consumeCorruptionFlag() && !single.consumeCorruptionFlag();
+    return report;
 }
@@ -6,8 +6,12 @@
 #include <cstdint>
 
 #include "AlignedAllocation.h"
+#include "dsp/HalfBandFir.h"
 
 #include "audioengine/AtomicAccess.h"
+#include "audioengine/MemoryLedger.h"
+
+namespace convo { class ChannelForkJoin; }
 
 class CustomInputOversampler
 {
@@ -15,12 +19,34 @@ public:
     enum class Preset
     {
         IIRLike,
-        LinearPhase
+        LinearPhase,
+        MinimumPhase   // ポリフェーズ全域通過 IIR ハーフバンド (群遅延は数サンプル、非線形位相)
+    };
+
+    // ステージ演算精度。Float32UpperStages は FIR プリセットの第 2 段以降 (既に帯域制限済みの
+    // 上位オクターブのみを扱う段) を float32 で実行する。MinimumPhase (再帰 IIR) は常に double
+    enum class StagePrecision
+    {
+        Double,
+        Float32UpperStages
+    };
+
+    // measureSinglePrecisionError() の結果 (double 実行との差、線形振幅)
+    struct PrecisionErrorReport
+    {
+        bool valid = false;
+        double maxAbsErrorUp = 0.0;         // processUp 出力の最大絶対誤差
+        double maxAbsErrorRoundTrip = 0.0;  // processUp → processDown 往復の最大絶対誤差
     };
 
+    // FIR プリセット (IIRLike / LinearPhase) の性質。MinimumPhase は別経路でレイテンシを算出する
     static constexpr bool isLinearPhaseFIR = true;
     static constexpr bool isSymmetricUpDown = true;
     static constexpr int kMaxChannels = 2;
+    static constexpr int kMaxAllpassCoeffs = 16;
+
+    // MinimumPhase プリセットの up+down 合成遅延 (base rate サンプル, DC 群遅延)
+    static double getMinimumPhaseLatencyBaseSamples(int ratio) noexcept;
 
     CustomInputOversampler() = default;
     ~CustomInputOversampler();
@@ -28,18 +54,33 @@ public:
     CustomInputOversampler(const CustomInputOversampler&) = delete;
     CustomInputOversampler& operator=(const CustomInputOversampler&) = delete;
 
-    void prepare(int maxInputBlockSize, int ratio, Preset preset);
+    void prepare(int maxInputBlockSize, int ratio, Preset preset,
+                 StagePrecision precision = StagePrecision::Double);
     void reset() noexcept;
     void release() noexcept;
 
-    juce::dsp::AudioBlock<double> processUp(juce::dsp::AudioBlock<double>& inputBlock, int numChannels) noexcept;
+    // split != nullptr かつ 2ch のとき、R チャンネルの全ステージを split の helper で L と並行に回す
+    // (audioengine/ChannelForkJoin.h。ステージ状態・作業領域はチャンネル別で共有しない)
+    juce::dsp::AudioBlock<double> processUp(juce::dsp::AudioBlock<double>& inputBlock, int numChannels,
+                                            convo::ChannelForkJoin* split = nullptr) noexcept;
     void processDown(const juce::dsp::AudioBlock<double>& upsampledBlock,
                      juce::dsp::AudioBlock<double>& outputBlock,
-                     int numChannels) noexcept;
+                     int numChannels,
+                     convo::ChannelForkJoin* split = nullptr) noexcept;
+
+    // Float32UpperStages と Double を同一の試験信号 (フルスケール近傍の高域正弦 + 白色雑音) で
+    // 実行し、最悪誤差を測る。Message Thread 専用 (一時インスタンスを確保する)
+    static PrecisionErrorReport measureSinglePrecisionError(int ratio, Preset preset, int blockSize = 512);
+
+    bool isSinglePrecisionActive() const noexcept { return singlePrecisionStages > 0; }
 
     // 単一stageの軽量オーバーサンプラを構築（SoftClip専用）
     bool prepareSingleStage(int taps, double attenDb, int stageInputMax) noexcept;
 
+    // 下流 (DSPCore 出力段の健全性検査 audioengine/BlockHealthScan.h) で不正サンプルが見つかったときに呼ぶ。
+    // decimate ステージは出力を自前で走査しないので、次の processDown の自動クリアで履歴を戻す (Audio Thread 安全)
+    void reportDownstreamCorruption() noexcept { markCorruptionDetected(); }
+
     // 異常フラグを取得してリセットする (Audio Thread 安全)
     bool consumeCorruptionFlag() noexcept
     {
@@ -70,38 +111,76 @@ public:
     // 全ステージ履歴をゼロクリアして異常フラグを解除する
     void clearAllStages() noexcept;
 
+    // ★ 無音スキップ (audioengine/ChainSilenceTracker.h) 用。Audio Thread 安全
+    // processUp / processDown の状態が無音入力で消えるまでの base rate サンプル数 (prepare 時に算出)
+    int getUpRingOutBaseSamples() const noexcept { return upRingOutBaseSamples; }
+    int getDownRingOutBaseSamples() const noexcept { return downRingOutBaseSamples; }
+    // 多段ステージが準備済みでハードフォールバック中でなければ true
+    bool canSkipSilentBlocks() const noexcept;
+    // processUp の代わりにゼロで埋めた upsample 済みブロックを返す (ステージ状態は触らない)
+    juce::dsp::AudioBlock<double> processUpSilent(int numInputSamples, int numChannels) noexcept;
+    // up / down 片側の履歴だけをゼロクリアする (異常フラグは触らない)
+    void clearUpHistories() noexcept;
+    void clearDownHistories() noexcept;
+
 private:
     struct Stage
     {
-        int taps = 0;
-        int centerTap = 0;
-        int centerParity = 0;
-        int convParity = 0;
-        int convCount = 0;
-        int centerDelayInput = 0;
-        int historyUpKeep = 0;
-        int historyDownKeep = 0;
         int maxInputSamples = 0;
         int maxOutputSamples = 0;
 
-        double centerCoeff = 0.5;
-        convo::ScopedAlignedPtr<double> convCoeffs;
-        convo::ScopedAlignedPtr<double> convCoeffsReversed;
-        convo::ScopedAlignedPtr<double> upHistory[2];
-        convo::ScopedAlignedPtr<double> downHistory[2];
+        // FIR プリセット: 係数設計とポリフェーズ実行は共通ハーフバンドエンジン、履歴は本クラスが保持する
+        convo::dsp::HalfBandFir fir;
+        int historyUpKeep = 0;
+        int historyDownKeep = 0;
+        // 履歴はブロックごとに必ず読み書きするため RT 常駐で確保する (float 版も同様)
+        convo::ResidentArray<double> upHistory[2];
+        convo::ResidentArray<double> downHistory[2];
+        // decimate の deinterleave 済み conv 位相履歴 (チャンネル別: L/R を別スレッドで回せるように)
+        convo::ScopedAlignedPtr<double> phaseScratch[2];
         int upHistorySize = 0;
         int downHistorySize = 0;
+        int phaseScratchSize = 0;
+
+        // 単精度ステージ (StagePrecision::Float32UpperStages)。double 履歴の代わりに float 履歴を持つ
+        bool singlePrecision = false;
+        convo::ResidentArray<float> upHistoryF32[2];
+        convo::ResidentArray<float> downHistoryF32[2];
+        convo::ScopedAlignedPtr<float> phaseScratchF32[2];
+        convo::ScopedAlignedPtr<float> outScratchF32[2];  // float 出力 → double 変換前の作業領域
+
+        // MinimumPhase: H(z) = 0.5·(A0(z²) + z⁻¹·A1(z²))。A0 = 偶数係数, A1 = 奇数係数の 1 次全域通過縦続。
+        // 2 経路を __m128d の下位/上位レーンに詰めて同時に処理する (lower = A0, upper = A1)。
+        int allpassPairs = 0; // 0 = FIR ステージ
+        alignas(16) double allpassCoeffs[kMaxAllpassCoeffs] {};          // [2j] = A0 第 j 段, [2j+1] = A1 第 j 段
+        alignas(16) double upAllpassState[2][kMaxAllpassCoeffs * 2] {};  // ch × (x1, y1) ペア
+        alignas(16) double downAllpassState[2][kMaxAllpassCoeffs * 2] {};
     };
 
     void clearStage(Stage& stage) noexcept;
-    bool prepareStage(Stage& stage, int taps, double attenuationDb, int stageInputMax);
-
-    static double besselI0(double x) noexcept;
-    static double dotProductAvx2(const double* x, const double* coeffs, int n) noexcept;
-    static double dotProductDecimateAvx2(const double* history, const double* coeffs, int convCount) noexcept;
+    bool prepareStage(Stage& stage, int taps, double attenuationDb, int stageInputMax, bool singlePrecision = false);
+    bool prepareAllpassStage(Stage& stage, double attenuationDb, double transitionBandwidth, int stageInputMax) noexcept;
+    static int designAllpassCoeffs(double* coeffs, double attenuationDb, double transitionBandwidth) noexcept;
+    static double allpassGroupDelay(const double* coeffs, int numCoeffs) noexcept;
+    static double transitionForStage(int stageIndex) noexcept;
+    static void clearAllpassState(Stage& stage) noexcept;
+    static void clearStageHistories(Stage& stage) noexcept;
+    static void clearStageUpHistory(Stage& stage) noexcept;
+    static void clearStageDownHistory(Stage& stage) noexcept;
+    void updateSilenceRingOut() noexcept;
+    // ステージ履歴・作業領域の確保量 (MemoryLedger への申告用)
+    size_t computeBufferBytes() const noexcept;
 
     static int sanitizeRatio(int ratio) noexcept;
     static int tapsForStage(int stageIndex, Preset preset) noexcept;
+
+    // FIR プリセットの段別タップ数 ([0] = IIRLike, [1] = LinearPhase)。比率 × プリセット別パイプラインの
+    // テンプレート引数にもなるので constexpr で持つ
+    static constexpr int kFirStageTaps[2][3] = { { 511, 127, 31 }, { 1023, 255, 63 } };
+    static constexpr int firStageTaps(Preset preset, int stageIndex) noexcept
+    {
+        return kFirStageTaps[(preset == Preset::LinearPhase) ? 1 : 0][stageIndex];
+    }
     static double attenuationForStage(int stageIndex, Preset preset) noexcept;
 
     void interpolateStage(const Stage& stage,
@@ -115,6 +194,47 @@ private:
                        int inputSamples,
                        double* output,
                        int channel) noexcept;
+    // inputIsFloatExact: 入力が直前の単精度ステージ出力 (float で厳密に表現可能) ならディザを省く
+    void interpolateStageF32(const Stage& stage,
+                             const double* input,
+                             int inputSamples,
+                             double* output,
+                             int channel,
+                             bool inputIsFloatExact) noexcept;
+    void decimateStageF32(const Stage& stage,
+                          const double* input,
+                          int inputSamples,
+                          double* output,
+                          int channel,
+                          bool inputIsFloatExact) noexcept;
+    void interpolateStageAllpass(Stage& stage,
+                                 const double* input,
+                                 int inputSamples,
+                                 double* output,
+                                 int channel) noexcept;
+    void decimateStageAllpass(Stage& stage,
+                              const double* input,
+                              int inputSamples,
+                              double* output,
+                              int channel) noexcept;
+    // 1 チャンネル分の全ステージを回し、最終ステージの出力 (workA / workB) を返す
+    double* runUpStages(int channel, double* input, int inputSamples) noexcept;
+    const double* runDownStages(int channel, const double* input, int inputSamples) noexcept;
+
+    // ★ 比率 (2/4/8) × FIR プリセット (IIRLike / LinearPhase) 別にコンパイル時特殊化したステージ列。
+    // 段数・タップ数・履歴長が定数で、段ごとの種別分岐と境界検査を持たない (prepare が保証済み)。
+    // 倍精度の FIR 構成のとき prepare が upPipeline / downPipeline に選び、それ以外は runUpStages / runDownStages
+    using UpPipeline = double* (CustomInputOversampler::*)(int, double*, int) noexcept;
+    using DownPipeline = const double* (CustomInputOversampler::*)(int, const double*, int) noexcept;
+    template <Preset P, int StageIndex, int NumStages>
+    double* runUpStagesFixed(int channel, double* input, int inputSamples) noexcept;
+    template <Preset P, int StageIndex, int NumStages>
+    const double* runDownStagesFixed(int channel, const double* input, int inputSamples) noexcept;
+    template <int Taps>
+    void interpolateStageFixed(const Stage& stage, const double* input, int inputSamples, double* output, int channel) noexcept;
+    template <int Taps>
+    void decimateStageFixed(const Stage& stage, const double* input, int inputSamples, double* output, int channel) noexcept;
+    void selectPipelines() noexcept;
     void markCorruptionDetected() noexcept;
 
     int upsampleRatio = 1;
@@ -122,12 +242,21 @@ private:
     int numStages = 0;
     int maxInputBlockSize = 0;
     int maxUpsampledBlockSize = 0;
+    int singlePrecisionStages = 0;
+    int upRingOutBaseSamples = 0;
+    int downRingOutBaseSamples = 0;
+
+    // double → float32 変換の TPDF ディザ乱数 (Audio Thread 専用、チャンネル別)
+    std::uint32_t ditherState[kMaxChannels] = { 0x9E3779B9u, 0x7F4A7C15u };
 
     Stage stages[3];
+    UpPipeline upPipeline = &CustomInputOversampler::runUpStages;
+    DownPipeline downPipeline = &CustomInputOversampler::runDownStages;
 
     convo::ScopedAlignedPtr<double> workA[2];
     convo::ScopedAlignedPtr<double> workB[2];
     int workCapacity = 0;
+    convo::MemoryCharge memoryCharge { convo::MemoryCategory::Oversampler };
 
     std::array<convo::NonOwningPtr<double>, kMaxChannels> blockChannels {};
     // RT-SAFE: blockChannelView is a member (not thread_local) so the returned AudioBlock's
@@ -8,6 +8,9 @@
 //     安全に解放できるエントリを delete することで、Audio Thread の RT 性を守る。
 //   - Audio Thread が参照中のオブジェクトを誤って解放しないよう、
 //     Epoch-based RCU の判定（getMinReaderEpoch / tryReclaim）に完全に委ねる。
+//   - BulkReleaseQueue の受け手も兼ねる。RCU 回収で退役した大きな StereoConvolver は
+//     回収スレッドで解放せずここへ回り、kBulkReleaseInterval ごとに kBulkReleaseBytesPerBatch
+//     ずつ解放する (数百 MB の mkl_free / VirtualFree を Message / rebuild スレッドから外す)。
 //
 // ライフサイクル:
 //   生成: ConvolverProcessor::prepareToPlay() で作成
@@ -19,6 +22,7 @@
 //   - stop() は std::atomic<bool> への store のみ → RT-safe
 #pragma once
 
+#include "BulkReleaseQueue.h"
 #include "SafeStateSwapper.h"
 #include "core/ThreadAffinityManager.h"
 #include "core/RetireBoundaryTelemetry.h"
@@ -27,6 +31,7 @@
 #include <atomic>
 #include <chrono>
 #include <limits>
+#include <utility>
 
 #include <JuceHeader.h>
 
@@ -45,6 +50,7 @@ public:
     explicit DeferredFreeThread(SafeStateSwapper& swapper, ThreadAffinityManager* affinityMgr = nullptr)
         : swapperRef(swapper), affinityManager(affinityMgr), running(true)
     {
+        bulkQueue.attachDrainer();
         thread = std::thread([this]() { run(); });
     }
 
@@ -55,6 +61,7 @@ public:
     // 2. スレッドの join を待つ（最大でポーリング周期 1 回分 = 数 ms）。
     // 3. スレッド停止後に残っているエントリを強制解放する。
     //    この時点で Audio Thread は停止済みのはずなので、UAF のリスクはない。
+    // 4. BulkReleaseQueue の受け手から外れる (最後の受け手なら残りをここで解放)。
     // -----------------------------------------------------------------------
     ~DeferredFreeThread()
     {
@@ -92,7 +99,7 @@ public:
     //   releaseResources() で先に呼ばれた場合、デストラクタ側の呼び出しは
     //   thread.joinable() == false により join をスキップし、
     //   drainAllRetired() は空キューを即時に完了するため安全。
-    //   余計な状態変数を追加せず、joinable() 判定による冪等性に依存する。
+    //   受け手の登録は 1 回だけ外すため bulkDrainerAttached で冪等にする。
     // -----------------------------------------------------------------------
     void shutdownAndDrain() noexcept
     {
@@ -102,6 +109,9 @@ public:
             thread.join();
 
         drainAllRetired();
+
+        if (std::exchange(bulkDrainerAttached, false))
+            bulkQueue.detachDrainer();
     }
 
     [[nodiscard]] convo::RetireBoundaryTelemetry snapshotBoundaryTelemetry() const noexcept
@@ -125,6 +135,9 @@ private:
     // -----------------------------------------------------------------------
     static constexpr int kMaxReclaimPerLoop = 4;
     static constexpr size_t kPendingRetiredWarnThreshold = 64;
+    // 大きな退役オブジェクトの解放ペース (1 バッチ最低 1 件。続きは間隔を空けて次のバッチへ)
+    static constexpr std::uint64_t kBulkReleaseBytesPerBatch = 64ull << 20;
+    static constexpr std::chrono::milliseconds kBulkReleaseInterval { 10 };
 
     // -----------------------------------------------------------------------
     // drainAllRetired()  ── 全 Retired エントリ強制解放（Shutdown 専用）
@@ -151,6 +164,7 @@ private:
         if (affinityManager != nullptr)
             affinityManager->applyCurrentThreadPolicy(ThreadType::LightBackground);
 
+        auto nextBulkRelease = std::chrono::steady_clock::now();
         while (convo::consumeAtomic(running, std::memory_order_acquire)) // acquire: stop() の publishAtomic release と HB し最新の running 値を観測
         {
             const uint64_t minEpoch = swapperRef.getMinReaderEpoch();
@@ -160,6 +174,14 @@ private:
                 std::unique_ptr<convo::ConvolverState> owned{ptr}; // RAII delete
                 if (++reclaimCount >= kMaxReclaimPerLoop) break;
             }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= nextBulkRelease && bulkQueue.releaseBatch(kBulkReleaseBytesPerBatch) > 0)
+            {
+                nextBulkRelease = std::chrono::steady_clock::now() + kBulkReleaseInterval;
+                ++reclaimCount;
+            }
+
             if (reclaimCount == 0)
             {
                 const size_t pendingRetired = swapperRef.getPendingRetiredCount();
@@ -177,6 +199,8 @@ private:
 
     SafeStateSwapper&     swapperRef;
     ThreadAffinityManager* affinityManager;
+    BulkReleaseQueue&     bulkQueue = BulkReleaseQueue::global();
+    bool                  bulkDrainerAttached = true;   // shutdownAndDrain を呼ぶスレッドだけが触る
     std::atomic<bool>     running;
     std::thread           thread;
 };
@@ -4,6 +4,9 @@
 #include "DeviceSettings.h"
 #include "NoiseShaperLearningComponent.h"
 #include "OversamplingPolicy.h"
+#include "CpuCostCalibration.h"
+#include "NoiseShaperStateJournal.h"
+#include "AdaptiveBankStore.h"
 #include <cmath>
 
 namespace
@@ -237,7 +240,9 @@ DeviceSettings::DeviceSettings (juce::AudioDeviceManager& adm, AudioEngine& engi
     addAndMakeVisible(filterTypeTabs);
     filterTypeTabs.addTab("IIR (Low Latency)", juce::Colours::darkgrey, new juce::Component(), true);
     filterTypeTabs.addTab("Linear Phase (FIR)", juce::Colours::darkgrey, new juce::Component(), true);
-    filterTypeTabs.setCurrentTabIndex(engine.getOversamplingType() == AudioEngine::OversamplingType::LinearPhase ? 1 : 0);
+    filterTypeTabs.addTab("Minimum Phase (Monitor)", juce::Colours::darkgrey, new juce::Component(), true);
+    // タブ順 = OversamplingType の列挙値 (IIR=0, LinearPhase=1, MinimumPhase=2)
+    filterTypeTabs.setCurrentTabIndex(static_cast<int>(engine.getOversamplingType()));
     // TabbedButtonBarの変更を監視
     filterTypeTabs.getTabbedButtonBar().addChangeListener(this);
 
@@ -388,6 +393,22 @@ DeviceSettings::DeviceSettings (juce::AudioDeviceManager& adm, AudioEngine& engi
         audioEngine.setAutoGainStagingEnabled(autoGainToggle.getToggleState());
     };
 
+    addAndMakeVisible(osSinglePrecisionToggle);
+    osSinglePrecisionToggle.setTooltip("Run oversampler stages 2 and up in float32 (FIR presets, 4x/8x). Worst-case error is logged at prepare.");
+    osSinglePrecisionToggle.setToggleState(audioEngine.getOversamplingSinglePrecision(), juce::dontSendNotification);
+    osSinglePrecisionToggle.onClick = [this] {
+        audioEngine.setOversamplingSinglePrecision(osSinglePrecisionToggle.getToggleState());
+    };
+
+    addAndMakeVisible(adaptiveBufferToggle);
+    adaptiveBufferToggle.setTooltip("When deadline misses persist, step the device buffer up to the next supported size; "
+                                    "return to the selected size once headroom is back. Changes are logged.");
+    adaptiveBufferToggle.setToggleState(audioEngine.isAdaptiveBufferSizeEnabled(), juce::dontSendNotification);
+    adaptiveBufferToggle.onClick = [this] {
+        audioEngine.setAdaptiveBufferSizeEnabled(adaptiveBufferToggle.getToggleState());
+        DeviceSettings::saveSettings(audioDeviceManager, audioEngine);
+    };
+
     // ★ v14.0: 手動編集時に Auto Gain を解除する onFocusLost チェーン
     {
         auto oldInputOnFocusLost = std::move(inputHeadroomEditor.onFocusLost);
@@ -492,7 +513,11 @@ DeviceSettings::DeviceSettings (juce::AudioDeviceManager& adm, AudioEngine& engi
             nullptr);
     };
 
+    addAndMakeVisible(cpuCostLabel);
+    cpuCostLabel.setJustificationType(juce::Justification::centredLeft);
+
     updateGainStagingDisplay();
+    updateCpuCostDisplay();
     startTimerHz(5);
 }
 
@@ -526,9 +551,11 @@ void DeviceSettings::resized()
     inputHeadroomEditor.setBounds(row2.removeFromLeft(120).reduced(5));
     autoGainToggle.setBounds(row2.removeFromLeft(160).reduced(5));
 
-    // 3行目: Output Makeup
+    // 3行目: Output Makeup + OS Float32 Toggle
     outputMakeupLabel.setBounds(row3.removeFromLeft(200).reduced(5));
     outputMakeupEditor.setBounds(row3.removeFromLeft(120).reduced(5));
+    osSinglePrecisionToggle.setBounds(row3.removeFromLeft(200).reduced(5));
+    adaptiveBufferToggle.setBounds(row3.removeFromLeft(180).reduced(5));
 
     // 4行目: FilterTypeTabs（ウィンドウ全体幅に変更し、横線が右端まで届くようにする）
     filterTypeTabs.setBounds(row4); // .reduced(2)や幅制限を外す
@@ -544,6 +571,7 @@ void DeviceSettings::resized()
     // 6行目: Audio Thread Priority (Oversamplingの真下) と Adaptive learningボタン
     audioThreadPriorityToggle.setBounds(row6.removeFromLeft(340).reduced(5));
     adaptiveLearningButton.setBounds(nsComboX, row6.getY(), nsComboW, row6.getHeight() - 2);
+    cpuCostLabel.setBounds(row6.withLeft(nsComboX + nsComboW).reduced(5, 0));
 
     fixedNoiseLogIntervalLabel.setBounds(0, 0, 0, 0); // 非表示時のダミー配置
     fixedNoiseLogIntervalComboBox.setBounds(0, 0, 0, 0);
@@ -583,7 +611,8 @@ void DeviceSettings::changeListenerCallback (juce::ChangeBroadcaster* source)
     if (source == &filterTypeTabs.getTabbedButtonBar())
     {
         // タブの変更チェック
-        auto type = (filterTypeTabs.getCurrentTabIndex() == 1) ? AudioEngine::OversamplingType::LinearPhase : AudioEngine::OversamplingType::IIR;
+        const int tabIndex = juce::jlimit(0, static_cast<int>(AudioEngine::OversamplingType::MinimumPhase), filterTypeTabs.getCurrentTabIndex());
+        auto type = static_cast<AudioEngine::OversamplingType>(tabIndex);
         if (type != audioEngine.getOversamplingType())
             audioEngine.setOversamplingType(type);
     }
@@ -599,6 +628,7 @@ void DeviceSettings::changeListenerCallback (juce::ChangeBroadcaster* source)
 void DeviceSettings::timerCallback()
 {
     updateGainStagingDisplay();
+    updateCpuCostDisplay();
 }
 
 void DeviceSettings::showAdaptiveLearningWindow()
@@ -720,6 +750,28 @@ void DeviceSettings::updateGainStagingDisplay()
     autoGainToggle.setToggleState(autoEnabled, juce::dontSendNotification);
     inputHeadroomEditor.setEnabled(!autoEnabled);
     outputMakeupEditor.setEnabled(!autoEnabled);
+
+    osSinglePrecisionToggle.setToggleState(audioEngine.getOversamplingSinglePrecision(), juce::dontSendNotification);
+    adaptiveBufferToggle.setToggleState(audioEngine.isAdaptiveBufferSizeEnabled(), juce::dontSendNotification);
+}
+
+void DeviceSettings::updateCpuCostDisplay()
+{
+    const auto config = audioEngine.makeCpuCostConfig();
+    const auto prediction = audioEngine.predictCpuCost(config);
+
+    const juce::String text = prediction.verdict == convo::CpuCostPrediction::Verdict::Unknown
+        ? juce::String("Predicted CPU: --")
+        : "Predicted CPU: " + juce::String(juce::roundToInt(prediction.load * 100.0)) + "%";
+    const juce::String signature = text + "|" + juce::String(prediction.totalUs, 0) + "|" + juce::String(prediction.periodUs, 0);
+    if (signature == cpuCostDisplaySignature)
+        return;
+    cpuCostDisplaySignature = signature;
+
+    cpuCostLabel.setText(text, juce::dontSendNotification);
+    cpuCostLabel.setColour(juce::Label::textColourId,
+                           convo::cpuCostVerdictColour(prediction.verdict, juce::Colours::lightgrey));
+    cpuCostLabel.setTooltip(convo::formatCpuCostTooltip(prediction, audioEngine.suggestCpuCostDowngrade(config)));
 }
 
 void DeviceSettings::updateBitDepthList()
@@ -840,7 +892,7 @@ void stringToDoubleArray(const juce::String& str, double* arr, int size)
 }
 }
 
-void DeviceSettings::saveNoiseShaperState(const AudioEngine& engine)
+bool DeviceSettings::saveNoiseShaperState(const AudioEngine& engine)
 {
     auto file = getNoiseShaperStateFile();
 
@@ -899,9 +951,61 @@ void DeviceSettings::saveNoiseShaperState(const AudioEngine& engine)
     }
 
     if (root->toString().length() < 10 * 1024 * 1024)
-        root->writeTo(file);
-    else
-        juce::Logger::writeToLog("Noise shaper state file too large, skipping save.");
+        return root->writeTo(file);
+
+    juce::Logger::writeToLog("Noise shaper state file too large, skipping save.");
+    return false;
+}
+
+bool DeviceSettings::saveAdaptiveBanks(const AudioEngine& engine)
+{
+    const int totalBanks = AudioEngine::getAdaptiveSampleRateBankCount() * kAdaptiveBitDepthCount * kLearningModeCount;
+    std::vector<convo::AdaptiveBankStore::Bank> banks(static_cast<size_t>(totalBanks));
+    for (int bankIndex = 0; bankIndex < totalBanks; ++bankIndex)
+    {
+        auto& bank = banks[static_cast<size_t>(bankIndex)];
+        engine.getAdaptiveCoefficientsForBank(bankIndex, bank.coefficients.data(), kAdaptiveNoiseShaperOrder);
+        (void)engine.getAdaptiveNoiseShaperState(bankIndex, bank.state);
+    }
+
+    if (!convo::AdaptiveBankStore::save(convo::AdaptiveBankStore::getStoreFile(), banks))
+        return false;
+
+    // 全バンクが書けたら、それ以前のジャーナルは不要
+    convo::NoiseShaperStateJournal::getInstance().discardAll();
+    return true;
+}
+
+bool DeviceSettings::loadAdaptiveBanks(AudioEngine& engine)
+{
+    const int totalBanks = AudioEngine::getAdaptiveSampleRateBankCount() * kAdaptiveBitDepthCount * kLearningModeCount;
+    std::vector<convo::AdaptiveBankStore::Bank> banks;
+    if (!convo::AdaptiveBankStore::load(convo::AdaptiveBankStore::getStoreFile(), totalBanks, banks))
+        return false;
+
+    for (int bankIndex = 0; bankIndex < totalBanks; ++bankIndex)
+    {
+        auto& bank = banks[static_cast<size_t>(bankIndex)];
+        for (auto& c : bank.coefficients)
+            c = sanitizeFiniteOrDefault(c, 0.0);
+        engine.storeAdaptiveCoeffBank(bankIndex, bank.coefficients.data(), bank.state);
+    }
+    return true;
+}
+
+void DeviceSettings::replayNoiseShaperJournal(AudioEngine& engine)
+{
+    int replayed = 0;
+    convo::NoiseShaperStateJournal::replay([&engine, &replayed](const convo::NoiseShaperStateJournal::Record& record)
+    {
+        if (record.bankIndex >= AudioEngine::getAdaptiveSampleRateBankCount() * kAdaptiveBitDepthCount * kLearningModeCount)
+            return;
+        if (engine.storeAdaptiveCoeffBank(record.bankIndex, record.coefficients.data(), record.state))
+            ++replayed;
+    });
+
+    if (replayed > 0)
+        juce::Logger::writeToLog("Noise shaper journal: restored " + juce::String(replayed) + " bank(s)");
 }
 
 void DeviceSettings::loadNoiseShaperState(AudioEngine& engine)
@@ -1004,6 +1108,9 @@ void DeviceSettings::preloadThreadPriorityMode (AudioEngine& engine)
 
 void DeviceSettings::saveSettings (const juce::AudioDeviceManager& deviceManager, const AudioEngine& engine)
 {
+    // バンクはバイナリが正本。noise_shaper_learn.xml と下の adaptiveCoeff_* 属性は人が読む / 編集する用のエクスポート
+    if (!saveAdaptiveBanks(engine))
+        juce::Logger::writeToLog("Warning: Could not save adaptive bank store");
     saveNoiseShaperState(engine);
 
     if (auto xml = deviceManager.createStateXml())
@@ -1017,11 +1124,15 @@ void DeviceSettings::saveSettings (const juce::AudioDeviceManager& deviceManager
         xml->setAttribute("oversamplingFactor", engine.getOversamplingFactor());
         // フィルタタイプ設定を追加
         xml->setAttribute("oversamplingType", (int)engine.getOversamplingType());
+        xml->setAttribute("oversamplingSinglePrecision", static_cast<int>(engine.getOversamplingSinglePrecision()));
         // 入力ヘッドルーム設定を追加
         xml->setAttribute("outputMakeupDb", engine.getOutputMakeupDb());
         xml->setAttribute("inputHeadroomDb", engine.getInputHeadroomDb());
         // ★ v14.0: Auto Gain Staging 設定
         xml->setAttribute("autoGainStagingEnabled", static_cast<int>(engine.isAutoGainStagingEnabled()));
+        // 適応バッファ長 (一時的に上げた長さは setAudioDeviceSetup(.., false) で適用するため
+        // audioDeviceBufferSize にはユーザーが選んだ長さが残る)
+        xml->setAttribute("adaptiveBufferSize", static_cast<int>(engine.isAdaptiveBufferSizeEnabled()));
         // Audio Thread Priority 設定
         xml->setAttribute("threadPriorityMode", engine.isAudioThreadPriorityMmcss() ? "MMCSS" : "NativeRT");
 
@@ -1057,7 +1168,17 @@ void DeviceSettings::saveSettings (const juce::AudioDeviceManager& deviceManager
 //--------------------------------------------------------------
 void DeviceSettings::loadSettings (juce::AudioDeviceManager& deviceManager, AudioEngine& engine)
 {
-    loadNoiseShaperState(engine);
+    // adaptive_banks.bin が無い / 壊れている / 形式が古いときだけ XML から取り込む
+    const bool adaptiveBanksLoaded = loadAdaptiveBanks(engine);
+    if (!adaptiveBanksLoaded)
+        loadNoiseShaperState(engine);
+
+    // 前回終了時までに保存されなかった世代をジャーナルから戻す (係数の読み込みより後に適用する)
+    struct JournalReplayGuard final
+    {
+        AudioEngine& engineRef;
+        ~JournalReplayGuard() { replayNoiseShaperJournal(engineRef); }
+    } journalReplayGuard { engine };
 
     engine.beginBulkParameterRestore();
     struct BulkRestoreGuard final
@@ -1140,6 +1261,7 @@ void DeviceSettings::loadSettings (juce::AudioDeviceManager& deviceManager, Audi
             int shaperType = xml->getIntAttribute("noiseShaperType", 0);
             engine.setNoiseShaperType((AudioEngine::NoiseShaperType)shaperType);
 
+            if (!adaptiveBanksLoaded)
             {
                 bool hasBankedAdaptiveCoefficients = false;
 
@@ -1227,10 +1349,12 @@ void DeviceSettings::loadSettings (juce::AudioDeviceManager& deviceManager, Audi
 
             // ★ v14.0: Auto Gain Staging 設定の復元 (デフォルト true)
             engine.setAutoGainStagingEnabled(xml->getBoolAttribute("autoGainStagingEnabled", true));
+            engine.setAdaptiveBufferSizeEnabled(xml->getBoolAttribute("adaptiveBufferSize", false));
 
             // フィルタタイプ設定の読み込み (デフォルト0 = IIR)
             int type = xml->getIntAttribute("oversamplingType", 0);
             engine.setOversamplingType((AudioEngine::OversamplingType)type);
+            engine.setOversamplingSinglePrecision(xml->getBoolAttribute("oversamplingSinglePrecision", false));
 
             // Audio Thread Priority 設定の読み込み (デフォルト "MMCSS")
             {
@@ -1288,6 +1412,7 @@ void DeviceSettings::loadSettings (juce::AudioDeviceManager& deviceManager, Audi
     engine.setInputHeadroomDb(-6.0f); // デフォルト -6dB
     engine.setOutputMakeupDb(12.0f); // [Fix] default 15→12 dB (unity gain)
     engine.setOversamplingType(AudioEngine::OversamplingType::IIR); // デフォルトIIR
+    engine.setOversamplingSinglePrecision(false);
 
 }
 void DeviceSettings::applyAsioBlacklist (juce::AudioDeviceManager& deviceManager, const AsioBlacklist& blacklist)
@@ -10,7 +10,7 @@
 //   - 入力デバイス名
 //   - 出力デバイス名
 //   - サンプルレート
-//   - バッファサイズ
+//   - バッファサイズ (適応バッファ長で一時的に上げた長さではなく、ユーザーが選んだ長さ)
 //   - 有効な入力チャンネル (Bitmask)
 //   - 有効な出力チャンネル (Bitmask)
 //
@@ -40,6 +40,9 @@ public:
     static void saveSettings (const juce::AudioDeviceManager& deviceManager, const AudioEngine& engine);
     static void loadSettings (juce::AudioDeviceManager& deviceManager, AudioEngine& engine);
 
+    // 適応ノイズシェーパー全バンクだけを adaptive_banks.bin へ書く (学習中の自動保存用。XML は書かない)
+    static bool saveAdaptiveBanks (const AudioEngine& engine);
+
     // ★ [work63] オーディオスレッド開始前に設定を先読み（デバイス初期化不要）
     static void preloadThreadPriorityMode (AudioEngine& engine);
 
@@ -50,6 +53,7 @@ private:
     void timerCallback() override;
     void updateBitDepthList();
     void updateGainStagingDisplay();
+    void updateCpuCostDisplay();
     void showAdaptiveLearningWindow();
     void showAdaptiveLearningWindowImpl();
     void updateNoiseShaperControls();
@@ -87,14 +91,26 @@ private:
     // ★ v14.0: Auto Gain Staging toggle
     juce::ToggleButton autoGainToggle { "Auto Gain Staging" };
 
+    // OS 段 2 以降の float32 処理 (FIR プリセット・4x 以上で有効)
+    juce::ToggleButton osSinglePrecisionToggle { "OS Float32 (stages 2+)" };
+
+    // 締め切り超過が続いたらバッファ長を上げ、余裕が戻ったら選んだ長さへ戻す (MainWindow の timer が実行)
+    juce::ToggleButton adaptiveBufferToggle { "Adaptive Buffer Size" };
+
+    // 現在の設定での callback 負荷予測 (CpuCostModel)。Warning 以上で色を変え、ツールチップに軽い構成の提案
+    juce::Label cpuCostLabel;
+
     juce::String gainDisplaySignature;
+    juce::String cpuCostDisplaySignature;
     juce::Component::SafePointer<juce::DialogWindow> adaptiveLearningWindow;
 
     static juce::File getSettingsFile();
     static juce::File getNoiseShaperStateFile();
 
-    static void saveNoiseShaperState(const AudioEngine& engine);
+    static bool saveNoiseShaperState(const AudioEngine& engine);
     static void loadNoiseShaperState(AudioEngine& engine);
+    static void replayNoiseShaperJournal(AudioEngine& engine);
+    static bool loadAdaptiveBanks(AudioEngine& engine);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeviceSettings)
 };
@@ -0,0 +1,233 @@
+#include "DeviceTimingProfiles.h"
+
+#include <algorithm>
+
+namespace
+{
+// 0 でないバケットだけを "bucket:count,..." で書く (ジッターも負荷もほとんどのバケットは空)
+template <size_t N>
+juce::String formatSparse(const std::array<uint64_t, N>& counts)
+{
+    juce::String text;
+    for (size_t b = 0; b < N; ++b)
+        if (counts[b] != 0)
+            text << (text.isEmpty() ? "" : ",") << juce::String(static_cast<int>(b)) << ":"
+                 << juce::String(static_cast<juce::int64>(counts[b]));
+    return text;
+}
+
+template <size_t N>
+void parseSparse(const juce::String& text, std::array<uint64_t, N>& counts)
+{
+    for (const auto& item : juce::StringArray::fromTokens(text, ",", {}))
+    {
+        const int bucket = item.upToFirstOccurrenceOf(":", false, false).getIntValue();
+        const auto count = item.fromFirstOccurrenceOf(":", false, false).getLargeIntValue();
+        if (bucket >= 0 && static_cast<size_t>(bucket) < N && count > 0)
+            counts[static_cast<size_t>(bucket)] = static_cast<uint64_t>(count);
+    }
+}
+}
+
+DeviceTimingProfiles::DeviceTimingProfiles()
+{
+    load();
+    lastSaveMs = juce::Time::getMillisecondCounterHiRes();
+}
+
+DeviceTimingProfiles::~DeviceTimingProfiles()
+{
+    if (dirty)
+        save();
+}
+
+juce::File DeviceTimingProfiles::getProfilesFile()
+{
+    auto appDataDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                          .getChildFile("ConvoPeq");
+
+    if (!appDataDir.exists())
+    {
+        auto result = appDataDir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create settings directory");
+    }
+
+    return appDataDir.getChildFile("device_timing_profiles.xml");
+}
+
+DeviceTimingProfiles::Key DeviceTimingProfiles::makeKey(juce::AudioIODevice& device)
+{
+    Key key;
+    key.deviceType = device.getTypeName();
+    key.deviceName = device.getName();
+    key.sampleRate = juce::roundToInt(device.getCurrentSampleRate());
+    key.bufferSize = device.getCurrentBufferSizeSamples();
+    return key;
+}
+
+const DeviceTimingProfiles::Profile* DeviceTimingProfiles::find(const Key& key) const
+{
+    for (const auto& p : profiles)
+        if (p.key == key)
+            return &p;
+    return nullptr;
+}
+
+DeviceTimingProfiles::Profile& DeviceTimingProfiles::findOrInsert(const Key& key)
+{
+    auto it = std::find_if(profiles.begin(), profiles.end(), [&key](const Profile& p) { return p.key == key; });
+    if (it == profiles.end())
+        it = profiles.insert(profiles.end(), Profile { key, {} });
+    return *it;
+}
+
+void DeviceTimingProfiles::update(juce::AudioIODevice* device, const convo::CallbackTimingHistograms::Snapshot& snapshot)
+{
+    const bool playing = device != nullptr && device->isPlaying() && device->getCurrentBufferSizeSamples() > 0
+                      && device->getCurrentSampleRate() > 0.0;
+    if (playing)
+    {
+        const auto key = makeKey(*device);
+        // 設定が変わった tick の差分は新旧どちらの設定のものか分からないので捨てる
+        if (haveBaseline && key == lastKey && snapshot.callbacks > lastSnapshot.callbacks)
+        {
+            findOrInsert(key).stats.accumulate(snapshot, lastSnapshot);
+            dirty = true;
+        }
+        lastKey = key;
+    }
+    lastSnapshot = snapshot;
+    haveBaseline = playing;
+
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    if (dirty && nowMs - lastSaveMs >= kSaveIntervalMs)
+    {
+        save();
+        dirty = false;
+        lastSaveMs = nowMs;
+    }
+}
+
+DeviceTimingProfiles::Summary DeviceTimingProfiles::summarize(juce::AudioIODevice* device) const
+{
+    Summary summary;
+    if (device == nullptr || device->getCurrentSampleRate() <= 0.0)
+        return summary;
+
+    const auto key = makeKey(*device);
+    const double sampleRate = device->getCurrentSampleRate();
+
+    std::vector<convo::BufferSizeObservation> observations;
+    for (const auto& p : profiles)
+        if (p.key.deviceType == key.deviceType && p.key.deviceName == key.deviceName && p.key.sampleRate == key.sampleRate)
+            observations.push_back({ p.key.bufferSize, &p.stats });
+
+    std::vector<int> availableSizes;
+    for (const int size : device->getAvailableBufferSizes())
+        availableSizes.push_back(size);
+    summary.recommendation = convo::recommendBufferSize(observations, sampleRate, availableSizes);
+
+    if (const auto* current = find(key))
+    {
+        summary.valid = true;
+        summary.observedSeconds = current->stats.observedSeconds(key.bufferSize, sampleRate);
+        summary.incidentsPerHour = current->stats.incidentsPerHour(key.bufferSize, sampleRate);
+        summary.jitterP99Us = current->stats.jitterPercentileUs(9900);
+        summary.jitterP999Us = current->stats.jitterPercentileUs(9990);
+        summary.slackP01Us = current->stats.slackPercentileUs(100, key.bufferSize, sampleRate);
+        summary.verdict = current->stats.verdict(key.bufferSize, sampleRate);
+        summary.loopbackMeasuredSamples = current->loopbackMeasuredSamples;
+        summary.loopbackPredictedSamples = current->loopbackPredictedSamples;
+    }
+    return summary;
+}
+
+void DeviceTimingProfiles::noteLoopbackLatency(juce::AudioIODevice& device, int measuredSamples, int predictedSamples)
+{
+    auto& profile = findOrInsert(makeKey(device));
+    profile.loopbackMeasuredSamples = juce::jmax(0, measuredSamples);
+    profile.loopbackPredictedSamples = juce::jmax(0, predictedSamples);
+    save();
+    dirty = false;
+}
+
+void DeviceTimingProfiles::noteBufferSweep(juce::AudioIODevice& device, const convo::BufferSweepStep& step)
+{
+    if (step.bufferSize <= 0)
+        return;
+    auto key = makeKey(device);
+    key.bufferSize = step.bufferSize;
+    findOrInsert(key).sweep = step.glitchFree ? SweepResult::GlitchFree : SweepResult::Glitched;
+    save();
+    dirty = false;
+}
+
+void DeviceTimingProfiles::load()
+{
+    const auto file = getProfilesFile();
+    if (!file.existsAsFile())
+        return;
+
+    auto root = juce::XmlDocument::parse(file);
+    if (root == nullptr || !root->hasTagName("DeviceTimingProfiles"))
+        return;
+    if (root->getIntAttribute("version", 0) != kVersion)
+        return;  // 分布のバケットが変わった → 取り直す
+
+    for (auto* e : root->getChildWithTagNameIterator("Profile"))
+    {
+        Profile profile;
+        profile.key.deviceType = e->getStringAttribute("type");
+        profile.key.deviceName = e->getStringAttribute("device");
+        profile.key.sampleRate = e->getIntAttribute("sampleRate", 0);
+        profile.key.bufferSize = e->getIntAttribute("bufferSize", 0);
+        auto& totals = profile.stats.totals;
+        totals.callbacks = static_cast<uint64_t>(juce::jmax<juce::int64>(0, e->getStringAttribute("callbacks").getLargeIntValue()));
+        totals.overruns = static_cast<uint64_t>(juce::jmax<juce::int64>(0, e->getStringAttribute("overruns").getLargeIntValue()));
+        totals.lateArrivals = static_cast<uint64_t>(juce::jmax<juce::int64>(0, e->getStringAttribute("lateArrivals").getLargeIntValue()));
+        parseSparse(e->getStringAttribute("jitter"), totals.jitter);
+        parseSparse(e->getStringAttribute("load"), totals.load);
+        profile.loopbackMeasuredSamples = juce::jmax(0, e->getIntAttribute("loopbackMeasured", 0));
+        profile.loopbackPredictedSamples = juce::jmax(0, e->getIntAttribute("loopbackPredicted", 0));
+        if (const auto sweep = e->getStringAttribute("sweep"); sweep == "pass")
+            profile.sweep = SweepResult::GlitchFree;
+        else if (sweep == "fail")
+            profile.sweep = SweepResult::Glitched;
+        if (profile.key.deviceName.isNotEmpty() && profile.key.sampleRate > 0 && profile.key.bufferSize > 0
+            && find(profile.key) == nullptr)
+            profiles.push_back(std::move(profile));
+    }
+}
+
+void DeviceTimingProfiles::save() const
+{
+    juce::XmlElement root("DeviceTimingProfiles");
+    root.setAttribute("version", kVersion);
+
+    for (const auto& p : profiles)
+    {
+        auto* e = root.createNewChildElement("Profile");
+        e->setAttribute("type", p.key.deviceType);
+        e->setAttribute("device", p.key.deviceName);
+        e->setAttribute("sampleRate", p.key.sampleRate);
+        e->setAttribute("bufferSize", p.key.bufferSize);
+        const auto& totals = p.stats.totals;
+        e->setAttribute("callbacks", juce::String(static_cast<juce::int64>(totals.callbacks)));
+        e->setAttribute("overruns", juce::String(static_cast<juce::int64>(totals.overruns)));
+        e->setAttribute("lateArrivals", juce::String(static_cast<juce::int64>(totals.lateArrivals)));
+        e->setAttribute("jitter", formatSparse(totals.jitter));
+        e->setAttribute("load", formatSparse(totals.load));
+        // 以下は --cli-latency-test で測ったものだけ (無い属性は未測定として読む)
+        if (p.loopbackMeasuredSamples > 0)
+        {
+            e->setAttribute("loopbackMeasured", p.loopbackMeasuredSamples);
+            e->setAttribute("loopbackPredicted", p.loopbackPredictedSamples);
+        }
+        if (p.sweep != SweepResult::None)
+            e->setAttribute("sweep", p.sweep == SweepResult::GlitchFree ? "pass" : "fail");
+    }
+
+    if (!root.writeTo(getProfilesFile()))
+        juce::Logger::writeToLog("Warning: Could not write device timing profiles file");
+}
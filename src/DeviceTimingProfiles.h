@@ -0,0 +1,101 @@
+#pragma once
+
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "LoopbackProbe.h"
+#include "audioengine/CallbackTimingProfile.h"
+
+/**
+    DeviceTimingProfiles: デバイス設定ごとのコールバック到着ジッター・締め切りまでの余裕の記録。
+
+    (デバイス種別, デバイス名, サンプルレート, バッファ長) ごとに AudioEngine::collectCallbackTiming() の
+    差分を CallbackTimingStats へ積み、%APPDATA%/ConvoPeq/device_timing_profiles.xml
+    (device_settings.xml と同じディレクトリ) に保存する。起動をまたいで積み上がるので、使っていた
+    バッファ長ごとに安定・不安定の判定が残り、convo::recommendBufferSize() がそのデバイス・サンプルレートで
+    安定が確かめられた最小のバッファ長と、次に試せる 1 段下の長さを出す。
+
+    - update() は MainWindow の timer (Message Thread) から呼ぶ。デバイスが再生中でないとき・設定が
+      前回から変わったときはその間の差分を捨てる (オフラインレンダー中も nullptr を渡して捨てる)
+    - 保存は kSaveIntervalMs ごとと破棄時。読み込みはコンストラクタ
+    - --cli-latency-test の結果 (ループバック往復遅延の実測と予測、バッファ長掃引の各段の合否) も
+      同じ記録に残し、その場で保存する。掃引の合否は表示用で、推奨値の判定 (60 s 以上の分布) には使わない
+*/
+class DeviceTimingProfiles
+{
+public:
+    static constexpr int kVersion = 1;
+    static constexpr double kSaveIntervalMs = 60'000.0;
+
+    struct Key
+    {
+        juce::String deviceType;
+        juce::String deviceName;
+        int sampleRate = 0;    // Hz (整数丸め)
+        int bufferSize = 0;
+
+        [[nodiscard]] bool operator==(const Key& other) const noexcept
+        {
+            return sampleRate == other.sampleRate && bufferSize == other.bufferSize
+                && deviceType == other.deviceType && deviceName == other.deviceName;
+        }
+    };
+
+    struct Summary
+    {
+        bool valid = false;              // 現在のデバイス設定に記録がある
+        double observedSeconds = 0.0;
+        double incidentsPerHour = 0.0;
+        uint64_t jitterP99Us = 0;
+        uint64_t jitterP999Us = 0;
+        double slackP01Us = 0.0;         // 余裕の下位 1% (μs)
+        convo::CallbackTimingStats::Verdict verdict = convo::CallbackTimingStats::Verdict::Insufficient;
+        convo::BufferSizeRecommendation recommendation;
+        int loopbackMeasuredSamples = 0;     // 0 = 未測定
+        int loopbackPredictedSamples = 0;
+    };
+
+    enum class SweepResult : uint8_t
+    {
+        None,
+        GlitchFree,
+        Glitched
+    };
+
+    DeviceTimingProfiles();
+    ~DeviceTimingProfiles();
+
+    // Message Thread 専用
+    void update(juce::AudioIODevice* device, const convo::CallbackTimingHistograms::Snapshot& snapshot);
+    [[nodiscard]] Summary summarize(juce::AudioIODevice* device) const;
+    // --cli-latency-test: device の現在の設定に往復遅延 (サンプル) を記録する
+    void noteLoopbackLatency(juce::AudioIODevice& device, int measuredSamples, int predictedSamples);
+    // --cli-latency-test: device の (種別, 名前, サンプルレート) と step.bufferSize の記録に掃引の合否を残す
+    void noteBufferSweep(juce::AudioIODevice& device, const convo::BufferSweepStep& step);
+
+    void save() const;
+    static juce::File getProfilesFile();
+
+private:
+    struct Profile
+    {
+        Key key;
+        convo::CallbackTimingStats stats;
+        int loopbackMeasuredSamples = 0;
+        int loopbackPredictedSamples = 0;
+        SweepResult sweep = SweepResult::None;
+    };
+
+    [[nodiscard]] static Key makeKey(juce::AudioIODevice& device);
+    [[nodiscard]] const Profile* find(const Key& key) const;
+    Profile& findOrInsert(const Key& key);
+    void load();
+
+    std::vector<Profile> profiles;
+    convo::CallbackTimingHistograms::Snapshot lastSnapshot {};
+    Key lastKey;
+    bool haveBaseline = false;
+    bool dirty = false;
+    double lastSaveMs = 0.0;
+};
@@ -208,7 +208,7 @@ inline void freeTracked(T*& p, size_t size) noexcept
 /// ポインタ生存確認付き加算。ptr==nullptr → 0 を返す。
 /// size==0 は allocSizes 保存漏れ（zeroAllocSizeCount 増加）。
 /// lostFreeCount は変更しない（diagMklFree の責務）。
-inline uint64_t addIfAlive(const double* ptr, size_t allocSize, const char* /*name*/) noexcept
+inline uint64_t addIfAlive(const void* ptr, size_t allocSize, const char* /*name*/) noexcept
 {
     if (ptr)
     {
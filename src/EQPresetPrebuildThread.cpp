@@ -0,0 +1,127 @@
+#include "EQPresetPrebuildThread.h"
+
+#include "core/ThreadAffinityManager.h"
+
+#include <cmath>
+
+#include <xmmintrin.h>   // _MM_SET_FLUSH_ZERO_MODE
+#include <pmmintrin.h>   // _MM_SET_DENORMALS_ZERO_MODE
+
+#include "audioengine/AtomicAccess.h"
+
+EQPresetPrebuildThread::EQPresetPrebuildThread(std::vector<juce::File> files,
+                                               int keyframesPerPair,
+                                               BuildEntryFn buildEntryIn,
+                                               ThreadAffinityManager* affinityMgr)
+    : juce::Thread("EQPresetPrebuild"),
+      presetFiles(std::move(files)),
+      morphKeyframesPerPair(juce::jmax(0, keyframesPerPair)),
+      buildEntry(std::move(buildEntryIn)),
+      affinityManager(affinityMgr)
+{
+}
+
+EQPresetPrebuildThread::~EQPresetPrebuildThread()
+{
+    cancel();
+    stopThread(2000);
+}
+
+void EQPresetPrebuildThread::cancel()
+{
+    convo::publishAtomic(cancelled, true, std::memory_order_release); // release: run 側 checkAndCancel の acquire と HB
+    signalThreadShouldExit();
+}
+
+bool EQPresetPrebuildThread::checkAndCancel()
+{
+    return threadShouldExit()
+        || convo::consumeAtomic(cancelled, std::memory_order_acquire); // acquire: cancel() の release と HB
+}
+
+int EQPresetPrebuildThread::getNumBuiltEntries() const noexcept
+{
+    return convo::consumeAtomic(numBuiltEntries, std::memory_order_acquire); // acquire: run の fetchAddAtomic と HB
+}
+
+bool EQPresetPrebuildThread::interpolateParameters(const convo::EQParameters& a,
+                                                   const convo::EQParameters& b,
+                                                   float t,
+                                                   convo::EQParameters& out) noexcept
+{
+    if (a.filterStructure != b.filterStructure || a.agcEnabled != b.agcEnabled)
+        return false;
+
+    out = a;
+    for (int i = 0; i < EQProcessor::NUM_BANDS; ++i)
+    {
+        const auto& ba = a.bands[i];
+        const auto& bb = b.bands[i];
+        if (ba.enabled != bb.enabled || ba.type != bb.type || ba.channelMode != bb.channelMode)
+            return false;
+
+        if (!ba.enabled)
+            continue;
+
+        // 周波数は対数軸、ゲイン/Q は線形で補間 (UI の操作感と一致)
+        auto& bo = out.bands[i];
+        bo.frequency = (ba.frequency > 0.0f && bb.frequency > 0.0f)
+            ? ba.frequency * std::pow(bb.frequency / ba.frequency, t)
+            : ba.frequency + (bb.frequency - ba.frequency) * t;
+        bo.gain = ba.gain + (bb.gain - ba.gain) * t;
+        bo.q = ba.q + (bb.q - ba.q) * t;
+    }
+
+    out.totalGainDb = a.totalGainDb + (b.totalGainDb - a.totalGainDb) * t;
+    out.nonlinearSaturation = a.nonlinearSaturation + (b.nonlinearSaturation - a.nonlinearSaturation) * t;
+    return true;
+}
+
+void EQPresetPrebuildThread::run()
+{
+    // FTZ/DAZ 有効化（専用スレッド: 設定のみ、RAII 保存＋復元は不要）
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+
+    if (affinityManager != nullptr)
+        affinityManager->applyCurrentThreadPolicy(ThreadType::HeavyBackground);
+
+    setPriority(Priority::low);
+
+    std::vector<convo::EQParameters> parsed;
+    parsed.reserve(presetFiles.size());
+
+    for (const auto& file : presetFiles)
+    {
+        if (checkAndCancel())
+            return;
+
+        convo::EQParameters params;
+        if (!EQProcessor::parseTextPresetFile(file, params))
+            continue;
+
+        parsed.push_back(params);
+        if (buildEntry(params))
+            convo::fetchAddAtomic(numBuiltEntries, 1, std::memory_order_acq_rel); // acq_rel: getNumBuiltEntries の acquire と HB
+    }
+
+    if (morphKeyframesPerPair <= 0)
+        return;
+
+    for (size_t p = 0; p + 1 < parsed.size(); ++p)
+    {
+        for (int k = 1; k <= morphKeyframesPerPair; ++k)
+        {
+            if (checkAndCancel())
+                return;
+
+            const float t = static_cast<float>(k) / static_cast<float>(morphKeyframesPerPair + 1);
+            convo::EQParameters keyframe;
+            if (!interpolateParameters(parsed[p], parsed[p + 1], t, keyframe))
+                break;
+
+            if (buildEntry(keyframe))
+                convo::fetchAddAtomic(numBuiltEntries, 1, std::memory_order_acq_rel); // acq_rel: getNumBuiltEntries の acquire と HB
+        }
+    }
+}
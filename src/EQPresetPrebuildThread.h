@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "eqprocessor/EQProcessor.h"
+
+class ThreadAffinityManager;
+
+/**
+    EQPresetPrebuildThread: プリセットバンク向け EQCoeffCache の事前構築スレッド。
+
+    AudioEngine がプリセットバンク (テキストプリセット群) のロード時に起動する。各プリセットを
+    convo::EQParameters へ解析し、buildEntry (EQCacheManager::getOrCreate) で係数キャッシュを
+    先に作っておく。morphKeyframesPerPair > 0 の場合は隣接プリセット (A/B) 間の補間キーフレームも
+    構築する。以後のプリセット切替・モーフィングは snapshot 作成時にキャッシュヒットし、
+    係数再計算を待たずに公開できる。cancel() またはスレッド終了要求で打ち切る。
+*/
+class EQPresetPrebuildThread : public juce::Thread
+{
+public:
+    using BuildEntryFn = std::function<bool(const convo::EQParameters&)>;
+
+    EQPresetPrebuildThread(std::vector<juce::File> presetFiles,
+                           int morphKeyframesPerPair,
+                           BuildEntryFn buildEntry,
+                           ThreadAffinityManager* affinityManager);
+
+    ~EQPresetPrebuildThread() override;
+
+    void run() override;
+    void cancel();
+
+    [[nodiscard]] int getNumBuiltEntries() const noexcept;
+
+    // A/B 間の補間パラメータ (t = 0 → a, t = 1 → b)。バンド構成 (有効/タイプ/チャンネル) が
+    // 一致しない場合は false を返す (形状が不連続なため補間キーフレームを作らない)。
+    static bool interpolateParameters(const convo::EQParameters& a,
+                                      const convo::EQParameters& b,
+                                      float t,
+                                      convo::EQParameters& out) noexcept;
+
+private:
+    bool checkAndCancel();
+
+    std::vector<juce::File> presetFiles;
+    int morphKeyframesPerPair = 0;
+    BuildEntryFn buildEntry;
+    std::atomic<bool> cancelled { false };
+    std::atomic<int> numBuiltEntries { 0 };
+    ThreadAffinityManager* affinityManager = nullptr;
+};
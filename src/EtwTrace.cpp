@@ -0,0 +1,147 @@
+#include "EtwTrace.h"
+
+#include "audioengine/StageLatencyHistogram.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+#endif
+
+namespace convo {
+
+#ifdef _WIN32
+
+// "ConvoPeq" の EventSource 互換名前ハッシュ。WPR プロファイルは "*ConvoPeq" で同じ GUID を引く
+TRACELOGGING_DEFINE_PROVIDER(g_convoPeqProvider, "ConvoPeq",
+    (0xc64b2f96, 0x4d7c, 0x5eb3, 0x7f, 0xaa, 0x3b, 0x0c, 0x45, 0x0f, 0x98, 0x94));
+
+struct EtwTraceAccess
+{
+    // プロバイダ内部の有効状態 (全セッションの合成) はコールバック前に更新済みなので、キーワードごとに引き直す
+    static void refreshEnabledKeywords() noexcept
+    {
+        uint64_t keywords = 0;
+        for (const uint64_t keyword : { EtwTrace::kCallback, EtwTrace::kPublication, EtwTrace::kRetire,
+                                        EtwTrace::kIrLoad, EtwTrace::kLearner })
+        {
+            if (TraceLoggingProviderEnabled(g_convoPeqProvider, WINEVENT_LEVEL_VERBOSE, keyword))
+                keywords |= keyword;
+        }
+        // relaxed: isEnabled() は判定にしか使わず、公開するデータは無い
+        publishAtomic(EtwTrace::enabledKeywords_, keywords, std::memory_order_relaxed);
+    }
+
+    static void NTAPI onEnable(LPCGUID, ULONG, UCHAR, ULONGLONG, ULONGLONG,
+                               PEVENT_FILTER_DESCRIPTOR, PVOID) noexcept
+    {
+        refreshEnabledKeywords();
+    }
+};
+
+void EtwTrace::registerProvider() noexcept
+{
+    // 失敗してもイベントが出ないだけ (TraceLoggingWrite は未登録プロバイダで何もしない)
+    (void)TraceLoggingRegisterEx(g_convoPeqProvider, &EtwTraceAccess::onEnable, nullptr);
+}
+
+void EtwTrace::unregisterProvider() noexcept
+{
+    publishAtomic(enabledKeywords_, uint64_t{0}, std::memory_order_relaxed);
+    TraceLoggingUnregister(g_convoPeqProvider);
+}
+
+void EtwTrace::callbackBegin(uint64_t callbackIndex, int numSamples) noexcept
+{
+    TraceLoggingWrite(g_convoPeqProvider, "Callback",
+                      TraceLoggingKeyword(kCallback),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                      TraceLoggingUInt64(callbackIndex, "CallbackIndex"),
+                      TraceLoggingInt32(numSamples, "Samples"));
+}
+
+void EtwTrace::callbackEnd(uint64_t callbackIndex, uint64_t durationUs) noexcept
+{
+    TraceLoggingWrite(g_convoPeqProvider, "Callback",
+                      TraceLoggingKeyword(kCallback),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                      TraceLoggingUInt64(callbackIndex, "CallbackIndex"),
+                      TraceLoggingUInt64(durationUs, "DurationUs"));
+}
+
+void EtwTrace::dspStage(DspStage stage, uint64_t cycles) noexcept
+{
+    // 段の終わりで出す。タイムスタンプ = 段の終了、Cycles = 段の所要 TSC サイクル
+    TraceLoggingWrite(g_convoPeqProvider, "DspStage",
+                      TraceLoggingKeyword(kCallback),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingString(dspStageName(stage), "Stage"),
+                      TraceLoggingUInt64(cycles, "Cycles"));
+}
+
+void EtwTrace::publicationCommit(uint64_t sequence, uint64_t generation, uint64_t worldId,
+                                 uint64_t durationUs, bool committed) noexcept
+{
+    TraceLoggingWrite(g_convoPeqProvider, "PublicationCommit",
+                      TraceLoggingKeyword(kPublication),
+                      TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                      TraceLoggingUInt64(sequence, "Sequence"),
+                      TraceLoggingUInt64(generation, "Generation"),
+                      TraceLoggingUInt64(worldId, "WorldId"),
+                      TraceLoggingUInt64(durationUs, "DurationUs"),
+                      TraceLoggingBool(committed, "Committed"));
+}
+
+void EtwTrace::reclaimBatch(uint64_t pendingBefore, uint64_t pendingAfter,
+                            uint64_t quarantineResident, uint64_t durationUs) noexcept
+{
+    TraceLoggingWrite(g_convoPeqProvider, "ReclaimBatch",
+                      TraceLoggingKeyword(kRetire),
+                      TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                      TraceLoggingUInt64(pendingBefore, "PendingBefore"),
+                      TraceLoggingUInt64(pendingAfter, "PendingAfter"),
+                      TraceLoggingUInt64(quarantineResident, "QuarantineResident"),
+                      TraceLoggingUInt64(durationUs, "DurationUs"));
+}
+
+void EtwTrace::irLoadPhase(const char* phase, bool succeeded, uint64_t durationUs) noexcept
+{
+    TraceLoggingWrite(g_convoPeqProvider, "IrLoadPhase",
+                      TraceLoggingKeyword(kIrLoad),
+                      TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                      TraceLoggingString(phase, "Phase"),
+                      TraceLoggingBool(succeeded, "Succeeded"),
+                      TraceLoggingUInt64(durationUs, "DurationUs"));
+}
+
+void EtwTrace::learnerGeneration(int generation, int evaluatedCandidates, double candidateScore,
+                                 double bestScore, uint64_t durationUs) noexcept
+{
+    TraceLoggingWrite(g_convoPeqProvider, "LearnerGeneration",
+                      TraceLoggingKeyword(kLearner),
+                      TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                      TraceLoggingInt32(generation, "Generation"),
+                      TraceLoggingInt32(evaluatedCandidates, "EvaluatedCandidates"),
+                      TraceLoggingFloat64(candidateScore, "CandidateScore"),
+                      TraceLoggingFloat64(bestScore, "BestScore"),
+                      TraceLoggingUInt64(durationUs, "DurationUs"));
+}
+
+#else
+
+// ETW の無いプラットフォームでは何もしない (isEnabled() は常に false)
+void EtwTrace::registerProvider() noexcept {}
+void EtwTrace::unregisterProvider() noexcept {}
+void EtwTrace::callbackBegin(uint64_t, int) noexcept {}
+void EtwTrace::callbackEnd(uint64_t, uint64_t) noexcept {}
+void EtwTrace::dspStage(DspStage, uint64_t) noexcept {}
+void EtwTrace::publicationCommit(uint64_t, uint64_t, uint64_t, uint64_t, bool) noexcept {}
+void EtwTrace::reclaimBatch(uint64_t, uint64_t, uint64_t, uint64_t) noexcept {}
+void EtwTrace::irLoadPhase(const char*, bool, uint64_t) noexcept {}
+void EtwTrace::learnerGeneration(int, int, double, double, uint64_t) noexcept {}
+
+#endif
+
+} // namespace convo
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "audioengine/AtomicAccess.h"
+
+namespace convo {
+
+enum class DspStage : uint8_t;
+
+/**
+    EtwTrace: ConvoPeq 独自の ETW TraceLogging プロバイダ ("ConvoPeq")。
+
+    WPA で xrun とエンジン内部の境目 (どの段が溢れたか・直前に publish / reclaim があったか) を
+    同じタイムライン上に並べるためのイベントを出す。tools/convopeq-xrun-etl.wprp が "*ConvoPeq" で有効化する。
+    GUID は名前からの EventSource 互換ハッシュ (c64b2f96-4d7c-5eb3-7faa-3b0c450f9894)。
+
+    キーワード:
+      kCallback    : デバイスコールバックの開始 / 終了、DSP 段ごとの所要サイクル (Audio Thread)
+      kPublication : PublicationExecutor の commit
+      kRetire      : retire / reclaim のバッチ (drainDeferredRetireQueues)
+      kIrLoad      : IR ロードの各ステップ (LoadIR / Trim / Transform / Build)
+      kLearner     : NoiseShaperLearner の世代
+
+    セッションが無いときの費用は isEnabled() の relaxed ロード 1 回。呼び出し側は引数の計算
+    (時刻取得など) の前に isEnabled() で分岐する。有効キーワードは ETW の有効化コールバックが
+    enabledKeywords_ へ写すので、Audio Thread はプロバイダ構造体に触れずに判定できる。
+
+    スレッド:
+      registerProvider / unregisterProvider : Message Thread (MainApplication の initialise / shutdown)
+      イベント書き出し                      : 任意。TraceLoggingWrite はロック・確保をしない
+*/
+class EtwTrace
+{
+public:
+    static constexpr uint64_t kCallback    = 0x1;
+    static constexpr uint64_t kPublication = 0x2;
+    static constexpr uint64_t kRetire      = 0x4;
+    static constexpr uint64_t kIrLoad      = 0x8;
+    static constexpr uint64_t kLearner     = 0x10;
+
+    static void registerProvider() noexcept;
+    static void unregisterProvider() noexcept;
+
+    [[nodiscard]] static bool isEnabled(uint64_t keyword) noexcept
+    {
+        // relaxed: 有効化の反映が数コールバック遅れても構わない (イベントの中身はこのフラグに依存しない)
+        return (consumeAtomic(enabledKeywords_, std::memory_order_relaxed) & keyword) != 0;
+    }
+
+    // StageLatencyProbe へ渡す lap 通知。kCallback が無効なら nullptr
+    [[nodiscard]] static auto stageSink() noexcept -> void (*)(DspStage, uint64_t) noexcept
+    {
+        return isEnabled(kCallback) ? &dspStage : nullptr;
+    }
+
+    static void callbackBegin(uint64_t callbackIndex, int numSamples) noexcept;
+    static void callbackEnd(uint64_t callbackIndex, uint64_t durationUs) noexcept;
+    static void dspStage(DspStage stage, uint64_t cycles) noexcept;
+
+    static void publicationCommit(uint64_t sequence, uint64_t generation, uint64_t worldId,
+                                  uint64_t durationUs, bool committed) noexcept;
+    static void reclaimBatch(uint64_t pendingBefore, uint64_t pendingAfter,
+                             uint64_t quarantineResident, uint64_t durationUs) noexcept;
+    static void irLoadPhase(const char* phase, bool succeeded, uint64_t durationUs) noexcept;
+    static void learnerGeneration(int generation, int evaluatedCandidates, double candidateScore,
+                                  double bestScore, uint64_t durationUs) noexcept;
+
+private:
+    friend struct EtwTraceAccess;
+    static inline std::atomic<uint64_t> enabledKeywords_ { 0 };
+};
+
+} // namespace convo
@@ -0,0 +1,261 @@
+//============================================================================
+#include "FarTailPager.h"
+
+#include <algorithm>
+
+#include "core/FarTailResidencyPlan.h"
+#include "core/ThreadAffinityManager.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace convo {
+
+namespace {
+
+constexpr size_t kPageBytes = 4096;
+
+size_t alignUpToPage(size_t bytes) noexcept
+{
+    return (bytes + kPageBytes - 1) & ~(kPageBytes - 1);
+}
+
+// 1 ページ 1 バイト読んで実際にフォルトさせる (OS の先読み指示は非同期で保証がないため)
+void touchRange(const uint8_t* begin, size_t bytes) noexcept
+{
+    volatile uint8_t sink = 0;
+    for (size_t off = 0; off < bytes; off += kPageBytes)
+        sink = static_cast<uint8_t>(sink ^ begin[off]);
+    if (bytes > 0)
+        sink = static_cast<uint8_t>(sink ^ begin[bytes - 1]);
+    (void)sink;
+}
+
+void adviseWillNeed(const uint8_t* begin, size_t bytes) noexcept
+{
+#ifdef _WIN32
+    WIN32_MEMORY_RANGE_ENTRY range { const_cast<uint8_t*>(begin), bytes };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    const auto addr = reinterpret_cast<uintptr_t>(begin) & ~static_cast<uintptr_t>(kPageBytes - 1);
+    madvise(reinterpret_cast<void*>(addr), bytes + (reinterpret_cast<uintptr_t>(begin) - addr), MADV_WILLNEED);
+#endif
+}
+
+// 範囲内に完全に含まれるページだけを手放す (隣のパーティションと共有する端のページは残す)
+void releaseInnerPages(const uint8_t* begin, size_t bytes) noexcept
+{
+    const uintptr_t first = (reinterpret_cast<uintptr_t>(begin) + kPageBytes - 1) & ~static_cast<uintptr_t>(kPageBytes - 1);
+    const uintptr_t last = (reinterpret_cast<uintptr_t>(begin) + bytes) & ~static_cast<uintptr_t>(kPageBytes - 1);
+    if (last <= first)
+        return;
+#ifdef _WIN32
+    // ロックしていないページへの VirtualUnlock は失敗を返すが、ワーキングセットからは外れる
+    VirtualUnlock(reinterpret_cast<void*>(first), static_cast<SIZE_T>(last - first));
+#else
+    madvise(reinterpret_cast<void*>(first), static_cast<size_t>(last - first), MADV_DONTNEED);
+#endif
+}
+
+void lockRange(const uint8_t* begin, size_t bytes) noexcept
+{
+    if (bytes == 0)
+        return;
+#ifdef _WIN32
+    VirtualLock(const_cast<uint8_t*>(begin), static_cast<SIZE_T>(bytes));
+#else
+    mlock(begin, bytes);
+#endif
+}
+
+} // namespace
+
+//============================================================================
+// create  ─ Message Thread (SetImpulse)
+//============================================================================
+std::unique_ptr<FarTailPager> FarTailPager::create(const void* re, const void* im, size_t partBytes,
+                                                   int numParts, int pagedParts, int windowParts,
+                                                   const ::ThreadAffinityManager* affinity)
+{
+    if (re == nullptr || im == nullptr || partBytes == 0 || numParts <= 0
+        || pagedParts <= 0 || pagedParts > numParts || windowParts <= 0)
+        return nullptr;
+
+    std::unique_ptr<FarTailPager> pager(new FarTailPager());
+    pager->partBytes = partBytes;
+    pager->numParts = numParts;
+    pager->pagedParts = pagedParts;
+    pager->windowParts = windowParts;
+    pager->affinity = affinity;
+
+    const size_t arrayBytes = partBytes * static_cast<size_t>(numParts);
+    pager->imagOffset = alignUpToPage(arrayBytes);
+    const size_t totalBytes = pager->imagOffset + arrayBytes;
+
+    pager->file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                      .getNonexistentChildFile("ConvoPeq-fartail", ".bin", false);
+    {
+        juce::FileOutputStream out(pager->file);
+        if (!out.openedOk())
+            return nullptr;
+        const std::vector<uint8_t> padding(pager->imagOffset - arrayBytes, 0);
+        bool ok = out.write(re, arrayBytes);
+        ok = ok && (padding.empty() || out.write(padding.data(), padding.size()));
+        ok = ok && out.write(im, arrayBytes);
+        out.flush();
+        if (!ok || out.getStatus().failed())
+        {
+            pager->file.deleteFile();
+            return nullptr;
+        }
+    }
+
+    pager->mapping = std::make_unique<juce::MemoryMappedFile>(pager->file, juce::MemoryMappedFile::readOnly);
+    if (pager->mapping->getData() == nullptr || pager->mapping->getSize() < totalBytes)
+    {
+        pager->mapping.reset();
+        pager->file.deleteFile();
+        return nullptr;
+    }
+    pager->mappedBase = static_cast<const uint8_t*>(pager->mapping->getData());
+
+    // 地平線より手前は毎サイクル読むため常駐させる (ロックは失敗しても続行する)
+    const size_t nearOffset = partBytes * static_cast<size_t>(pagedParts);
+    const size_t nearBytes = arrayBytes - nearOffset;
+    for (const size_t base : { size_t { 0 }, pager->imagOffset })
+    {
+        touchRange(pager->mappedBase + base + nearOffset, nearBytes);
+        lockRange(pager->mappedBase + base + nearOffset, nearBytes);
+    }
+
+    pager->resident = std::make_unique<std::atomic<uint8_t>[]>(static_cast<size_t>(pagedParts));
+    for (int p = 0; p < pagedParts; ++p)
+        publishAtomic(pager->resident[static_cast<size_t>(p)], static_cast<uint8_t>(0), std::memory_order_relaxed); // relaxed: スレッド生成前
+    for (auto& cursor : pager->cursors)
+        publishAtomic(cursor, -1, std::memory_order_relaxed); // relaxed: 同上
+
+    try
+    {
+        FarTailPager* raw = pager.get();
+        pager->prefetchThread = std::thread([raw]() { raw->prefetchLoop(); });
+    }
+    catch (...)
+    {
+        pager->mapping.reset();
+        pager->file.deleteFile();
+        return nullptr;
+    }
+    return pager;
+}
+
+FarTailPager::~FarTailPager()
+{
+    publishAtomic(stopRequested, true, std::memory_order_release); // release: prefetchLoop の acquire と HB
+    signalPrefetch();
+    if (prefetchThread.joinable())
+        prefetchThread.join();
+    mapping.reset();
+    file.deleteFile();
+}
+
+//============================================================================
+// registerConsumer / unregisterConsumer  ─ Message Thread
+//============================================================================
+int FarTailPager::registerConsumer() noexcept
+{
+    for (int slot = 0; slot < kMaxConsumers; ++slot)
+    {
+        int expected = -1;
+        // acq_rel: 登録と同時に次サイクル先頭を先読みさせる
+        if (compareExchangeAtomic(cursors[slot], expected, pagedParts))
+        {
+            signalPrefetch();
+            return slot;
+        }
+    }
+    return -1;
+}
+
+void FarTailPager::unregisterConsumer(int slot) noexcept
+{
+    if (slot >= 0 && slot < kMaxConsumers)
+    {
+        publishAtomic(cursors[slot], -1, std::memory_order_release); // release: 以後このスロットの窓は追わない
+        signalPrefetch(); // 窓から外れたパーティションを手放させる
+    }
+}
+
+//============================================================================
+// prefetchLoop  ─ Prefetch スレッド
+//   窓から外れたパーティションは先にフラグを下ろしてから手放し、
+//   窓に入ったものはページインを終えてからフラグを立てる。
+//   窓はカーソルがパーティション境界を越えたときにしか変わらないため、
+//   差分が無くなったら prefetchSignal で次の noteCursor / 登録・解除まで眠る。
+//============================================================================
+void FarTailPager::pageIn(int part) noexcept
+{
+    const size_t offset = partBytes * static_cast<size_t>(part);
+    for (const size_t base : { size_t { 0 }, imagOffset })
+        adviseWillNeed(mappedBase + base + offset, partBytes);
+    for (const size_t base : { size_t { 0 }, imagOffset })
+        touchRange(mappedBase + base + offset, partBytes);
+}
+
+void FarTailPager::pageOut(int part) noexcept
+{
+    const size_t offset = partBytes * static_cast<size_t>(part);
+    for (const size_t base : { size_t { 0 }, imagOffset })
+        releaseInnerPages(mappedBase + base + offset, partBytes);
+}
+
+void FarTailPager::prefetchLoop() noexcept
+{
+    // パーティション境界の締め切りに先行する必要があるため Tail Worker と同じ扱いにする
+    if (affinity != nullptr)
+        affinity->applyCurrentThreadPolicy(ThreadType::ConvolverTail);
+
+    std::vector<uint8_t> wanted;
+    wanted.reserve(static_cast<size_t>(pagedParts));
+    int snapshot[kMaxConsumers];
+
+    for (;;)
+    {
+        const uint32_t seenSignal = consumeAtomic(prefetchSignal, std::memory_order_acquire); // acquire: signalPrefetch の release と HB
+        if (consumeAtomic(stopRequested, std::memory_order_acquire)) // acquire: デストラクタの release と HB
+            break;
+
+        for (int i = 0; i < kMaxConsumers; ++i)
+            snapshot[i] = consumeAtomic(cursors[i], std::memory_order_relaxed); // relaxed: ヒントの読み取り
+        FarTailResidencyPlan::compute(snapshot, kMaxConsumers, pagedParts, windowParts, wanted);
+
+        bool didWork = false;
+        for (int p = 0; p < pagedParts; ++p)
+        {
+            auto& flag = resident[static_cast<size_t>(p)];
+            if (wanted[static_cast<size_t>(p)] == 0 && consumeAtomic(flag, std::memory_order_relaxed) != 0) // relaxed: 書き手はこのスレッドのみ
+            {
+                publishAtomic(flag, static_cast<uint8_t>(0), std::memory_order_release); // release: 以後の MAC はこのパーティションを飛ばす
+                pageOut(p);
+            }
+        }
+        for (int p = 0; p < pagedParts; ++p)
+        {
+            auto& flag = resident[static_cast<size_t>(p)];
+            if (wanted[static_cast<size_t>(p)] != 0 && consumeAtomic(flag, std::memory_order_relaxed) == 0) // relaxed: 同上
+            {
+                pageIn(p);
+                publishAtomic(flag, static_cast<uint8_t>(1), std::memory_order_release); // release: isResident の acquire と HB
+                didWork = true;
+            }
+        }
+
+        // ページイン中にカーソルが動いていれば seenSignal と食い違うので wait は即座に戻る
+        if (!didWork)
+            prefetchSignal.wait(seenSignal, std::memory_order_acquire);
+    }
+}
+
+} // namespace convo
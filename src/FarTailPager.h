@@ -0,0 +1,105 @@
+//============================================================================
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "audioengine/AtomicAccess.h"
+
+class ThreadAffinityManager;
+
+namespace convo {
+
+//============================================================================
+/**
+    FarTailPager ── L2 層の遠い末尾パーティションをメモリマップした一時ファイルから読ませる
+
+    SetImpulse (Message Thread) が L2 の IR スペクトル (Re 配列 → Im 配列) を丸ごと一時ファイルへ
+    書き出し、読み取り専用でマップする。パーティション p = [0, pagedParts) が遠い末尾 (ページ化範囲)、
+    [pagedParts, numParts) は地平線より手前で、マップ上にあるがロックして常駐させる。
+
+    プリフェッチスレッドが消費者 (MAC を回す Audio Thread / Tail Worker) のカーソルから
+    FarTailResidencyPlan の窓を求め、窓に入ったパーティションをページインしてから
+    isResident(p) を立てる。窓から外れたものは先にフラグを下ろしてからページアウトする。
+    プリフェッチスレッドはポーリングせず、カーソルが別パーティションへ動いたとき
+    (= 窓が変わりうる唯一の契機) と消費者の登録・解除時にだけ起きる。
+    Audio Thread は isResident() が立っているパーティションだけに触れる (フォルトしない)。
+
+    ★ 再読み込みは OS のページキャッシュが受けるため、通常はディスク I/O にならない。
+      ページキャッシュからも追い出された場合のみ実際の読み込みが起きる。
+*/
+class FarTailPager
+{
+public:
+    static constexpr int kMaxConsumers = 8;
+
+    // 作成に失敗したら nullptr (呼び出し側はヒープ上のスペクトルのまま続行する)
+    static std::unique_ptr<FarTailPager> create(const void* re, const void* im, size_t partBytes,
+                                                int numParts, int pagedParts, int windowParts,
+                                                const ::ThreadAffinityManager* affinity);
+    ~FarTailPager();
+
+    // マップ上の配列 (Message Thread で Layer に張る)
+    [[nodiscard]] const void* real() const noexcept { return mappedBase; }
+    [[nodiscard]] const void* imag() const noexcept { return mappedBase + imagOffset; }
+    [[nodiscard]] int getPagedParts() const noexcept { return pagedParts; }
+    [[nodiscard]] size_t getPagedBytes() const noexcept { return 2 * partBytes * static_cast<size_t>(pagedParts); }
+
+    // 消費者の登録 (Message Thread)。スロット番号、空きが無ければ -1
+    int registerConsumer() noexcept;
+    void unregisterConsumer(int slot) noexcept;
+
+    // Audio Thread / Tail Worker
+    [[nodiscard]] bool isResident(int part) const noexcept
+    {
+        return consumeAtomic(resident[static_cast<size_t>(part)], std::memory_order_acquire) != 0; // acquire: ページインの後に立てた release と HB
+    }
+    void noteCursor(int slot, int nextPart) noexcept
+    {
+        // relaxed: 先読み位置のヒントにすぎない (起床の HB は signalPrefetch の release が担う)
+        if (slot >= 0 && exchangeAtomic(cursors[slot], nextPart, std::memory_order_relaxed) != nextPart)
+            signalPrefetch();
+    }
+    void noteMiss() noexcept { fetchAddAtomic(missCount, static_cast<uint64_t>(1), std::memory_order_relaxed); } // relaxed: 統計カウンタ
+    [[nodiscard]] uint64_t getMissCount() const noexcept { return consumeAtomic(missCount, std::memory_order_relaxed); } // relaxed: 同上
+
+private:
+    FarTailPager() = default;
+
+    void prefetchLoop() noexcept;
+    void signalPrefetch() noexcept
+    {
+        fetchAddAtomic(prefetchSignal, 1u, std::memory_order_release); // release: prefetchLoop の acquire と HB
+        // notify_one は待機スレッドの起床のみ (Windows: WakeByAddressSingle) でブロックしない
+        prefetchSignal.notify_one();
+    }
+    void pageIn(int part) noexcept;
+    void pageOut(int part) noexcept;
+
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    const uint8_t* mappedBase = nullptr;
+    size_t imagOffset = 0;
+    size_t partBytes = 0;
+    int numParts = 0;
+    int pagedParts = 0;
+    int windowParts = 0;
+    const ::ThreadAffinityManager* affinity = nullptr;
+
+    std::unique_ptr<std::atomic<uint8_t>[]> resident;
+    std::atomic<int> cursors[kMaxConsumers];
+    std::atomic<uint64_t> missCount{ 0 };
+    std::atomic<bool> stopRequested{ false };
+    std::atomic<uint32_t> prefetchSignal{ 0 };
+    std::thread prefetchThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FarTailPager)
+};
+
+} // namespace convo
@@ -0,0 +1,235 @@
+#include "FftBackendWisdom.h"
+
+#include "AlignedAllocation.h"
+
+#include <mkl.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace convo {
+
+// ═══════════════════════════════════════════════════════════════
+//  インスタンス / パス解決
+// ═══════════════════════════════════════════════════════════════
+
+FftBackendWisdom& FftBackendWisdom::getInstance()
+{
+    static FftBackendWisdom instance;
+    return instance;
+}
+
+juce::File FftBackendWisdom::getWisdomFile()
+{
+    auto appDataDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                          .getChildFile("ConvoPeq");
+
+    if (!appDataDir.exists())
+    {
+        auto result = appDataDir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create settings directory");
+    }
+
+    return appDataDir.getChildFile("fft_backend_wisdom.xml");
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  参照
+// ═══════════════════════════════════════════════════════════════
+
+FftBackend FftBackendWisdom::choose(int order) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    const auto it = entries.find(order);
+    return it != entries.end() ? it->second.backend : FftBackend::Ipp;
+}
+
+std::vector<FftBackendWisdom::Entry> FftBackendWisdom::getEntries() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    std::vector<Entry> result;
+    for (const auto& [order, entry] : entries)
+        result.push_back(entry);
+    return result;
+}
+
+void FftBackendWisdom::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    loaded = true;
+    getWisdomFile().deleteFile();
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  計測
+// ═══════════════════════════════════════════════════════════════
+
+FftBackendWisdom::Entry FftBackendWisdom::measure(int order)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Entry entry;
+    entry.order = order;
+
+    // NUC のバッファと同じ 64 byte アライン (アライン有無で IPP / DFTI の内部経路が変わり得る)
+    const size_t n = static_cast<size_t>(1) << order;
+    auto time = makeAlignedArray<double>(n);
+    auto back = makeAlignedArray<double>(n);
+    auto freq = makeAlignedArray<double>(n + 2);
+    std::mt19937 rng(0xFF7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (size_t i = 0; i < n; ++i)
+        time.get()[i] = dist(rng);
+
+    // 1 バッチで約 2^20 サンプルを変換し、3 バッチの最小値を採る (割り込み・周波数変動の外れ値を除く)
+    const int roundTrips = std::max(4, (1 << 20) >> order);
+
+    auto roundTripNanos = [&](FftBackend backend) -> double
+    {
+        const auto plan = RealFftPlan::create(order, FftScaling::InverseByN, backend);
+        if (!plan)
+            return std::numeric_limits<double>::infinity();
+        std::vector<uint8_t> work(plan->getWorkBytes() + 64);
+        uint8_t* workPtr = plan->getWorkBytes() > 0 ? work.data() : nullptr;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            plan->forward(time.get(), freq.get(), workPtr);
+            plan->inverse(freq.get(), back.get(), workPtr);
+        }
+
+        double best = std::numeric_limits<double>::infinity();
+        for (int batch = 0; batch < 3; ++batch)
+        {
+            const auto start = Clock::now();
+            for (int i = 0; i < roundTrips; ++i)
+            {
+                plan->forward(time.get(), freq.get(), workPtr);
+                plan->inverse(freq.get(), back.get(), workPtr);
+            }
+            const double nanos = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            best = std::min(best, nanos / static_cast<double>(roundTrips));
+        }
+        return best;
+    };
+
+    entry.ippNanosPerRoundTrip = roundTripNanos(FftBackend::Ipp);
+    entry.dftiNanosPerRoundTrip = roundTripNanos(FftBackend::MklDfti);
+    // 差が 3% 未満なら従来の IPP を残す (計測誤差で入れ替わり続けないように)
+    entry.backend = (entry.dftiNanosPerRoundTrip < entry.ippNanosPerRoundTrip * 0.97)
+                  ? FftBackend::MklDfti : FftBackend::Ipp;
+    return entry;
+}
+
+void FftBackendWisdom::calibrate(int minOrder, int maxOrder)
+{
+    std::vector<int> missing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ensureLoadedLocked();
+        for (int order = minOrder; order <= maxOrder; ++order)
+            if (entries.count(order) == 0)
+                missing.push_back(order);
+    }
+    if (missing.empty())
+        return;
+
+    // Audio Thread と同条件 (FTZ/DAZ) で計測する
+    juce::ScopedNoDenormals noDenormals;
+
+    std::vector<Entry> measured;
+    for (const int order : missing)
+    {
+        const Entry e = measure(order);
+        if (!std::isfinite(e.ippNanosPerRoundTrip) && !std::isfinite(e.dftiNanosPerRoundTrip))
+            continue;  // どちらのプランも作れない order は記録しない
+        measured.push_back(e);
+        juce::Logger::writeToLog("FftBackendWisdom: order " + juce::String(order)
+                                 + " IPP " + juce::String(e.ippNanosPerRoundTrip / 1000.0, 2) + " us"
+                                 + " / DFTI " + juce::String(e.dftiNanosPerRoundTrip / 1000.0, 2) + " us"
+                                 + " -> " + fftBackendName(e.backend));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& e : measured)
+        entries[e.order] = e;
+    saveLocked();
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  永続化
+// ═══════════════════════════════════════════════════════════════
+
+namespace {
+
+// CPU に加えてライブラリ版も含める (IPP / MKL の更新で CPU 別コードパスが変わり得る)
+juce::String currentSignature()
+{
+    char mklVersion[198] = {};
+    mkl_get_version_string(mklVersion, static_cast<int>(sizeof(mklVersion)));
+    const IppLibraryVersion* ippVersion = ippsGetLibVersion();
+    return juce::SystemStats::getCpuModel() + "/" + juce::String(juce::SystemStats::getNumCpus())
+         + "/" + juce::String(ippVersion != nullptr ? ippVersion->Version : "?")
+         + "/" + juce::String(mklVersion).trim();
+}
+
+} // namespace
+
+void FftBackendWisdom::ensureLoadedLocked() const
+{
+    if (loaded)
+        return;
+    loaded = true;
+    entries.clear();
+
+    const auto file = getWisdomFile();
+    if (!file.existsAsFile())
+        return;
+
+    auto root = juce::XmlDocument::parse(file);
+    if (root == nullptr || !root->hasTagName("FftBackendWisdom"))
+        return;
+    if (root->getIntAttribute("version", 0) != kVersion)
+        return;
+    if (root->getStringAttribute("signature") != currentSignature())
+        return;  // CPU かライブラリが変わった → 再計測
+
+    for (auto* e : root->getChildWithTagNameIterator("Entry"))
+    {
+        Entry entry;
+        entry.order = e->getIntAttribute("order", 0);
+        entry.backend = (e->getIntAttribute("backend", 0) == static_cast<int>(FftBackend::MklDfti))
+                      ? FftBackend::MklDfti : FftBackend::Ipp;
+        entry.ippNanosPerRoundTrip = e->getDoubleAttribute("ippNanos", 0.0);
+        entry.dftiNanosPerRoundTrip = e->getDoubleAttribute("dftiNanos", 0.0);
+        if (entry.order > 0 && entry.order <= 30)
+            entries[entry.order] = entry;
+    }
+}
+
+void FftBackendWisdom::saveLocked() const
+{
+    juce::XmlElement root("FftBackendWisdom");
+    root.setAttribute("version", kVersion);
+    root.setAttribute("signature", currentSignature());
+
+    for (const auto& [order, entry] : entries)
+    {
+        auto* e = root.createNewChildElement("Entry");
+        e->setAttribute("order", order);
+        e->setAttribute("backend", static_cast<int>(entry.backend));
+        e->setAttribute("ippNanos", entry.ippNanosPerRoundTrip);
+        e->setAttribute("dftiNanos", entry.dftiNanosPerRoundTrip);
+    }
+
+    if (!root.writeTo(getWisdomFile()))
+        juce::Logger::writeToLog("Warning: Could not write FFT backend wisdom file");
+}
+
+} // namespace convo
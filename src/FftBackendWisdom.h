@@ -0,0 +1,61 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "RealFft.h"
+
+namespace convo {
+
+/**
+    FftBackendWisdom: FFT サイズごとの実装選択 (IPP / MKL DFTI) の実測結果 ("wisdom")。
+
+    どちらの実数 FFT が速いかはサイズと CPU (キャッシュ容量・各ライブラリの CPU 別コードパス) で入れ替わるため、
+    2^order ごとに順変換＋逆変換の往復時間を両実装で一度だけ計測し、速い方を
+    %APPDATA%/ConvoPeq/fft_backend_wisdom.xml に保存する。CPU モデルかライブラリ版が変わったら捨てて再計測する。
+    未計測の order は IPP (従来の実装) を返す。
+
+    スレッド:
+      choose    : 任意の Non-RT スレッド (mutex)
+      calibrate : 起動時のウォームアップ (StartupWarmup) 専用。未計測の order 数 × 数 ms ブロックする
+*/
+class FftBackendWisdom
+{
+public:
+    struct Entry
+    {
+        int        order = 0;
+        FftBackend backend = FftBackend::Ipp;
+        double     ippNanosPerRoundTrip = 0.0;
+        double     dftiNanosPerRoundTrip = 0.0;
+    };
+
+    static FftBackendWisdom& getInstance();
+    static juce::File getWisdomFile();
+
+    [[nodiscard]] FftBackend choose(int order) const;
+
+    /** [minOrder, maxOrder] のうち未計測の order を計測し、増えた分を保存する。 */
+    void calibrate(int minOrder, int maxOrder);
+
+    [[nodiscard]] std::vector<Entry> getEntries() const;
+    void clear();
+
+private:
+    FftBackendWisdom() = default;
+
+    static Entry measure(int order);
+
+    void ensureLoadedLocked() const;
+    void saveLocked() const;
+
+    static constexpr int kVersion = 1;
+
+    mutable std::mutex mutex;
+    mutable std::map<int, Entry> entries;  // キー = order
+    mutable bool loaded = false;
+};
+
+} // namespace convo
@@ -20,6 +20,7 @@
 #include "DspNumericPolicy.h"
 
 #include "audioengine/AtomicAccess.h"
+#include "dsp/DitherNoisePool.h"
 
 namespace convo
 {
@@ -52,6 +53,12 @@ static constexpr int ORDER = 16;
         return true;
     }
 
+    // ★ DSPCore 所有の共用ディザプール (dsp/DitherNoisePool.h)。nullptr なら自前の xoshiro256++ を使う
+    void setNoisePool(convo::dsp::DitherNoisePool* pool) noexcept
+    {
+        noisePool = pool;
+    }
+
     void setDiagnosticsWindowSamples(uint32_t samples) noexcept
     {
         const uint32_t clamped = std::clamp<uint32_t>(samples, 256u, 262144u);
@@ -168,27 +175,41 @@ static constexpr int ORDER = 16;
         double lastErrorL = 0.0;
         double lastErrorR = 0.0;
 
-        for (int i = 0; i < numSamples; ++i)
-        {
-            double error = 0.0;
-            dataL[i] = processSample(dataL[i] * headroom, 0, error);
-            sumSqL += error * error;
-            const double absErr = absNoLibm(error);
-            if (absErr > peakAbs)
-                peakAbs = absErr;
-            lastErrorL = error;
-        }
+        // ディザは kReadChunk 単位でチャンネルごとにまとめて用意する
+        constexpr int kChunk = convo::dsp::DitherNoisePool::kReadChunk;
+        alignas(64) double tpdf[kChunk];
 
-        if (dataR != nullptr)
-            for (int i = 0; i < numSamples; ++i)
+        for (int offset = 0; offset < numSamples; offset += kChunk)
+        {
+            const int n = std::min(kChunk, numSamples - offset);
+            fillTpdf(0, tpdf, n);
+            for (int i = 0; i < n; ++i)
             {
                 double error = 0.0;
-                dataR[i] = processSample(dataR[i] * headroom, 1, error);
-                sumSqR += error * error;
+                dataL[offset + i] = processSample(dataL[offset + i] * headroom, 0, tpdf[i], error);
+                sumSqL += error * error;
                 const double absErr = absNoLibm(error);
                 if (absErr > peakAbs)
                     peakAbs = absErr;
-                lastErrorR = error;
+                lastErrorL = error;
+            }
+        }
+
+        if (dataR != nullptr)
+            for (int offset = 0; offset < numSamples; offset += kChunk)
+            {
+                const int n = std::min(kChunk, numSamples - offset);
+                fillTpdf(1, tpdf, n);
+                for (int i = 0; i < n; ++i)
+                {
+                    double error = 0.0;
+                    dataR[offset + i] = processSample(dataR[offset + i] * headroom, 1, tpdf[i], error);
+                    sumSqR += error * error;
+                    const double absErr = absNoLibm(error);
+                    if (absErr > peakAbs)
+                        peakAbs = absErr;
+                    lastErrorR = error;
+                }
             }
 
         // ★ M-03: ブロック終了時に一度だけ envelope チェック
@@ -201,7 +222,7 @@ static constexpr int ORDER = 16;
     }
 
 private:
-    inline double processSample(double x, int channel, double& outError) noexcept
+    inline double processSample(double x, int channel, double tpdf, double& outError) noexcept
     {
         auto& channelErrors = errors[static_cast<size_t>(channel)];
         int& idx = writePos[static_cast<size_t>(channel)];
@@ -214,7 +235,7 @@ private:
         fb = killDenormal(fb);
 
         const double y = x - fb;
-        const double yq = quantize(y, rngState[static_cast<size_t>(channel)]);
+        const double yq = quantize(y, tpdf);
         const double error = yq - y;
         outError = error;
 
@@ -315,7 +336,19 @@ private:
         return (xoshiro256plusplus(state) >> 11) * (1.0 / 9007199254740992.0);
     }
 
-    inline double quantize(double v, Xoshiro256State& rng) const noexcept
+    // 単位 TPDF (u1 + u2 - 1) を count 個。noisePool が無ければ自前の乱数をチャンネル順に消費する
+    inline void fillTpdf(int channel, double* dest, int count) noexcept
+    {
+        auto& rng = rngState[static_cast<size_t>(channel)];
+        convo::dsp::fillUnitTpdf(noisePool, channel, dest, count, [this, &rng]() noexcept
+        {
+            const double u1 = uniform(rng);
+            const double u2 = uniform(rng);
+            return u1 + u2 - 1.0;
+        });
+    }
+
+    inline double quantize(double v, double tpdf) const noexcept
     {
         const double minV = -1.0;
         const double maxV = 1.0 - (1.0 / invScale);
@@ -327,9 +360,7 @@ private:
             v = maxV;
 
         // TPDF dither
-        const double u1 = uniform(rng);
-        const double u2 = uniform(rng);
-        v += (u1 + u2 - 1.0) * scale;
+        v += tpdf * scale;
 
         __m128d d = _mm_set_sd(v * invScale);
         d = _mm_round_sd(d, d, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
@@ -468,6 +499,7 @@ private:
     alignas(64) std::array<std::array<double, ORDER>, MAX_CHANNELS> errors {};
     std::array<int, MAX_CHANNELS> writePos {};
     alignas(64) Xoshiro256State rngState[MAX_CHANNELS];
+    convo::dsp::DitherNoisePool* noisePool = nullptr;
     int currentBitDepth = 0;
     double scale = 1.0;
     double invScale = 1.0;
@@ -13,6 +13,7 @@
 #include <immintrin.h>
 
 #include "audioengine/AtomicAccess.h"
+#include "dsp/DitherNoisePool.h"
 
 namespace convo
 {
@@ -42,6 +43,12 @@ public:
         return true;
     }
 
+    // ★ DSPCore 所有の共用ディザプール (dsp/DitherNoisePool.h)。nullptr なら自前の xoshiro256++ を使う
+    void setNoisePool(convo::dsp::DitherNoisePool* pool) noexcept
+    {
+        noisePool = pool;
+    }
+
     void setDiagnosticsWindowSamples(uint32_t samples) noexcept
     {
         const uint32_t clamped = std::clamp<uint32_t>(samples, 256u, 262144u);
@@ -133,32 +140,46 @@ public:
         double sumSqR = 0.0;
         double peakAbs = 0.0;
 
-        for (int i = 0; i < numSamples; ++i)
-        {
-            double error = 0.0;
-            dataL[i] = processSample(dataL[i] * headroom, 0, error);
-            sumSqL += error * error;
-            const double absErr = absNoLibm(error);
-            if (absErr > peakAbs)
-                peakAbs = absErr;
-        }
+        // ディザは kReadChunk 単位でチャンネルごとにまとめて用意する
+        constexpr int kChunk = convo::dsp::DitherNoisePool::kReadChunk;
+        alignas(64) double tpdf[kChunk];
 
-        if (dataR != nullptr)
-            for (int i = 0; i < numSamples; ++i)
+        for (int offset = 0; offset < numSamples; offset += kChunk)
+        {
+            const int n = std::min(kChunk, numSamples - offset);
+            fillTpdf(0, tpdf, n);
+            for (int i = 0; i < n; ++i)
             {
                 double error = 0.0;
-                dataR[i] = processSample(dataR[i] * headroom, 1, error);
-                sumSqR += error * error;
+                dataL[offset + i] = processSample(dataL[offset + i] * headroom, 0, tpdf[i], error);
+                sumSqL += error * error;
                 const double absErr = absNoLibm(error);
                 if (absErr > peakAbs)
                     peakAbs = absErr;
             }
+        }
+
+        if (dataR != nullptr)
+            for (int offset = 0; offset < numSamples; offset += kChunk)
+            {
+                const int n = std::min(kChunk, numSamples - offset);
+                fillTpdf(1, tpdf, n);
+                for (int i = 0; i < n; ++i)
+                {
+                    double error = 0.0;
+                    dataR[offset + i] = processSample(dataR[offset + i] * headroom, 1, tpdf[i], error);
+                    sumSqR += error * error;
+                    const double absErr = absNoLibm(error);
+                    if (absErr > peakAbs)
+                        peakAbs = absErr;
+                }
+            }
 
         publishDiagnostics(sumSqL, sumSqR, peakAbs, static_cast<uint32_t>(numSamples), dataR != nullptr);
     }
 
 private:
-    inline double processSample(double x, int channel, double& outError) noexcept
+    inline double processSample(double x, int channel, double tpdf, double& outError) noexcept
     {
         auto& channelErrors = errors[static_cast<size_t>(channel)];
         int& idx = writePos[static_cast<size_t>(channel)];
@@ -169,7 +190,7 @@ private:
                         + coeffs[3] * get(channelErrors, idx, 3);
 
         const double y = x - fb;
-        const double yq = quantize(y, rngState[static_cast<size_t>(channel)]);
+        const double yq = quantize(y, tpdf);
         const double error = yq - y;
         outError = error;
 
@@ -268,7 +289,19 @@ private:
         return (xoshiro256plusplus(state) >> 11) * (1.0 / 9007199254740992.0);
     }
 
-    inline double quantize(double v, Xoshiro256State& rng) const noexcept
+    // 単位 TPDF (u1 + u2 - 1) を count 個。noisePool が無ければ自前の乱数をチャンネル順に消費する
+    inline void fillTpdf(int channel, double* dest, int count) noexcept
+    {
+        auto& rng = rngState[static_cast<size_t>(channel)];
+        convo::dsp::fillUnitTpdf(noisePool, channel, dest, count, [this, &rng]() noexcept
+        {
+            const double u1 = uniform(rng);
+            const double u2 = uniform(rng);
+            return u1 + u2 - 1.0;
+        });
+    }
+
+    inline double quantize(double v, double tpdf) const noexcept
     {
         // ★ Bug A/B/D: 全ての非有限値（NaN・±Inf）を 0.0 に置換（入口）
         v = replaceNonFiniteWithZero(v);
@@ -283,9 +316,7 @@ private:
             v = maxV;
 
         // TPDF dither
-        const double u1 = uniform(rng);
-        const double u2 = uniform(rng);
-        v += (u1 + u2 - 1.0) * scale;
+        v += tpdf * scale;
 
         __m128d d = _mm_set_sd(v * invScale);
         d = _mm_round_sd(d, d, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
@@ -354,6 +385,7 @@ private:
         {{ 0x2301EFCDAB896745ULL, 0x456789ABCDEF0123ULL, 0x3210FEDCBA987654ULL, 0xCDEF0123456789ABULL }},
         {{ 0x67452301EFCDAB89ULL, 0xABCDEF0123456789ULL, 0x76543210FEDCBA98ULL, 0x89ABCDEF01234567ULL }}
     };
+    convo::dsp::DitherNoisePool* noisePool = nullptr;
     int currentBitDepth = 0;
     double scale = 1.0;
     double invScale = 1.0;
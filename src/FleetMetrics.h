@@ -0,0 +1,394 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "NoiseShaperLearnerTypes.h"
+#include "audioengine/CallbackTimingProfile.h"
+#include "audioengine/DspStage.h"
+#include "audioengine/MemoryLedger.h"
+#include "audioengine/StageLatencyHistogram.h"
+#include "audioengine/XrunIncidentCorrelator.h"
+
+//==============================================================================
+// FleetMetrics — ヘッドレス / キオスク運用向けのメトリクス 1 回分と、その書式化
+//
+//   FleetMetricsExporter (--metrics-udp / --metrics-pipe) が送る中身。値は MainWindow の timer
+//   (Message Thread) が既存の観測 API から集め、書式化と送信はエクスポーターのスレッドが行う。
+//   Audio Thread は何もしない (読むのはすべて既に公開されているカウンタとスナップショット)。
+//
+//   書式:
+//     Prometheus テキスト (0.0.4)。名前は convopeq_ で始め、累積値は _total の counter、それ以外は gauge
+//     JSON 1 行 (末尾に改行)。1 回分が 1 データグラム / パイプへの 1 書き込みになる
+//   パーセンタイルは「前回の送信から今回まで」の窓で計算する (callback 負荷は callbackWindow、
+//   段別処理時間は StageLatencyWindow の 5〜10 秒窓)。
+//
+//   JUCE 非依存 (テストから直接使う)。
+//==============================================================================
+
+namespace convo {
+
+enum class FleetMetricsFormat : uint8_t
+{
+    Prometheus,
+    Json
+};
+
+[[nodiscard]] constexpr const char* noiseShaperLearnerStatusName(NoiseShaperLearnerStatus status) noexcept
+{
+    switch (status)
+    {
+        case NoiseShaperLearnerStatus::Idle:            return "idle";
+        case NoiseShaperLearnerStatus::WaitingForAudio: return "waitingForAudio";
+        case NoiseShaperLearnerStatus::Running:         return "running";
+        case NoiseShaperLearnerStatus::Completed:       return "completed";
+        case NoiseShaperLearnerStatus::Error:           return "error";
+    }
+    return "?";
+}
+
+struct FleetMetricsSample
+{
+    struct IrCache
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t entries = 0;
+        uint64_t diskBytes = 0;
+    };
+
+    uint64_t timestampMs = 0;                            // Unix 時刻 (ms)
+
+    uint16_t callbackLoadPermille = 0;                   // 直近の負荷 (peak-hold)
+    CallbackTimingHistograms::Snapshot callbackTotals {};  // 起動以降の累積 (collectCallbackTiming)
+    CallbackTimingStats callbackWindow {};               // 前回の送信以降の差分 (エクスポーターが積む)
+
+    uint64_t xrunIncidents = 0;
+    uint64_t xrunDropped = 0;
+    std::array<uint32_t, XrunIncident::kNumFlags> xrunRecentFlagCounts {};   // 直近 kHistory 件の原因フラグ別
+
+    StageLatencyReport stages {};
+    MemoryLedger::Snapshot memory {};
+    IrCache irCache {};
+
+    bool learnerActive = false;
+    NoiseShaperLearnerProgressView learner {};
+};
+
+namespace detail {
+
+inline void appendNumber(std::string& out, uint64_t value)
+{
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// 非有限値は 0 にする (JSON に NaN / Inf は書けず、受け手の集計も壊す)
+inline void appendNumber(std::string& out, double value)
+{
+    if (!std::isfinite(value))
+        value = 0.0;
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+class PrometheusWriter
+{
+public:
+    explicit PrometheusWriter(std::string& o) : out(o) {}
+
+    void type(std::string_view name, std::string_view kind)
+    {
+        out += "# TYPE convopeq_";
+        out += name;
+        out += ' ';
+        out += kind;
+        out += '\n';
+    }
+
+    template <typename T>
+    void value(std::string_view name, T v)
+    {
+        out += "convopeq_";
+        out += name;
+        out += ' ';
+        appendNumber(out, v);
+        out += '\n';
+    }
+
+    // ラベル値は固定の識別子だけを渡す (エスケープしない)
+    template <typename T>
+    void labelled(std::string_view name, std::string_view label, std::string_view labelValue, T v,
+                  std::string_view label2 = {}, std::string_view labelValue2 = {})
+    {
+        out += "convopeq_";
+        out += name;
+        out += '{';
+        out += label;
+        out += "=\"";
+        out += labelValue;
+        out += '"';
+        if (!label2.empty())
+        {
+            out += ',';
+            out += label2;
+            out += "=\"";
+            out += labelValue2;
+            out += '"';
+        }
+        out += "} ";
+        appendNumber(out, v);
+        out += '\n';
+    }
+
+private:
+    std::string& out;
+};
+
+class JsonWriter
+{
+public:
+    explicit JsonWriter(std::string& o) : out(o) {}
+
+    void beginObject(std::string_view key = {})
+    {
+        this->key(key);
+        out += '{';
+        first = true;
+    }
+
+    void endObject()
+    {
+        out += '}';
+        first = false;
+    }
+
+    template <typename T>
+    void field(std::string_view k, T v)
+    {
+        key(k);
+        if constexpr (std::is_same_v<T, bool>)
+            out += v ? "true" : "false";
+        else
+            appendNumber(out, v);
+    }
+
+    // 値は固定の識別子だけを渡す (エスケープしない)
+    void field(std::string_view k, const char* v)
+    {
+        key(k);
+        out += '"';
+        out += v;
+        out += '"';
+    }
+
+private:
+    void key(std::string_view k)
+    {
+        if (!first)
+            out += ',';
+        first = false;
+        if (k.empty())
+            return;
+        out += '"';
+        out += k;
+        out += "\":";
+    }
+
+    std::string& out;
+    bool first = true;
+};
+
+} // namespace detail
+
+inline void appendFleetMetricsPrometheus(const FleetMetricsSample& s, std::string& out)
+{
+    detail::PrometheusWriter w(out);
+
+    w.type("callback_load_permille", "gauge");
+    w.value("callback_load_permille", static_cast<uint64_t>(s.callbackLoadPermille));
+    w.type("callback_load_window_permille", "gauge");
+    w.labelled("callback_load_window_permille", "quantile", "0.5", static_cast<uint64_t>(s.callbackWindow.loadPercentilePermille(5000)));
+    w.labelled("callback_load_window_permille", "quantile", "0.99", static_cast<uint64_t>(s.callbackWindow.loadPercentilePermille(9900)));
+    w.labelled("callback_load_window_permille", "quantile", "0.999", static_cast<uint64_t>(s.callbackWindow.loadPercentilePermille(9990)));
+    w.type("callback_jitter_window_us", "gauge");
+    w.labelled("callback_jitter_window_us", "quantile", "0.99", s.callbackWindow.jitterPercentileUs(9900));
+    w.labelled("callback_jitter_window_us", "quantile", "0.999", s.callbackWindow.jitterPercentileUs(9990));
+    w.type("callbacks_total", "counter");
+    w.value("callbacks_total", s.callbackTotals.callbacks);
+    w.type("callback_overruns_total", "counter");
+    w.value("callback_overruns_total", s.callbackTotals.overruns);
+    w.type("callback_late_arrivals_total", "counter");
+    w.value("callback_late_arrivals_total", s.callbackTotals.lateArrivals);
+
+    w.type("xrun_incidents_total", "counter");
+    w.value("xrun_incidents_total", s.xrunIncidents);
+    w.type("xrun_incidents_dropped_total", "counter");
+    w.value("xrun_incidents_dropped_total", s.xrunDropped);
+    w.type("xrun_recent_incidents", "gauge");
+    for (size_t bit = 0; bit < XrunIncident::kNumFlags; ++bit)
+        w.labelled("xrun_recent_incidents", "cause", xrunIncidentFlagName(bit), static_cast<uint64_t>(s.xrunRecentFlagCounts[bit]));
+
+    // TSC 周波数の推定が済むまで段別時間は 0 なので出さない
+    if (s.stages.clockCalibrated)
+    {
+        w.type("stage_time_us", "gauge");
+        for (size_t i = 0; i < kNumDspStages; ++i)
+        {
+            const auto& stage = s.stages.stages[i];
+            if (stage.samples == 0)
+                continue;
+            const char* name = dspStageName(static_cast<DspStage>(i));
+            w.labelled("stage_time_us", "stage", name, stage.p50Us, "quantile", "0.5");
+            w.labelled("stage_time_us", "stage", name, stage.p99Us, "quantile", "0.99");
+            w.labelled("stage_time_us", "stage", name, stage.p999Us, "quantile", "0.999");
+            w.labelled("stage_time_us", "stage", name, stage.maxUs, "quantile", "1");
+        }
+        w.type("stage_window_samples", "gauge");
+        for (size_t i = 0; i < kNumDspStages; ++i)
+            if (s.stages.stages[i].samples > 0)
+                w.labelled("stage_window_samples", "stage", dspStageName(static_cast<DspStage>(i)), s.stages.stages[i].samples);
+    }
+
+    w.type("memory_bytes", "gauge");
+    for (size_t i = 0; i < kNumMemoryCategories; ++i)
+        w.labelled("memory_bytes", "category", memoryCategoryName(static_cast<MemoryCategory>(i)), s.memory.categories[i].bytes);
+    w.type("memory_peak_bytes", "gauge");
+    for (size_t i = 0; i < kNumMemoryCategories; ++i)
+        w.labelled("memory_peak_bytes", "category", memoryCategoryName(static_cast<MemoryCategory>(i)), s.memory.categories[i].peakBytes);
+    w.type("memory_instances", "gauge");
+    for (size_t i = 0; i < kNumMemoryCategories; ++i)
+        w.labelled("memory_instances", "category", memoryCategoryName(static_cast<MemoryCategory>(i)),
+                   static_cast<uint64_t>(s.memory.categories[i].instances));
+    w.type("memory_total_bytes", "gauge");
+    w.value("memory_total_bytes", s.memory.totalBytes());
+
+    w.type("ir_cache_hits_total", "counter");
+    w.value("ir_cache_hits_total", s.irCache.hits);
+    w.type("ir_cache_misses_total", "counter");
+    w.value("ir_cache_misses_total", s.irCache.misses);
+    w.type("ir_cache_evictions_total", "counter");
+    w.value("ir_cache_evictions_total", s.irCache.evictions);
+    w.type("ir_cache_entries", "gauge");
+    w.value("ir_cache_entries", s.irCache.entries);
+    w.type("ir_cache_disk_bytes", "gauge");
+    w.value("ir_cache_disk_bytes", s.irCache.diskBytes);
+
+    w.type("learner_active", "gauge");
+    w.value("learner_active", static_cast<uint64_t>(s.learnerActive ? 1 : 0));
+    w.type("learner_status", "gauge");
+    w.labelled("learner_status", "status", noiseShaperLearnerStatusName(s.learner.status), static_cast<uint64_t>(1));
+    w.type("learner_iteration", "gauge");
+    w.value("learner_iteration", static_cast<uint64_t>(std::max(0, s.learner.iteration)));
+    w.type("learner_generations_total", "counter");
+    w.value("learner_generations_total", s.learner.totalGenerations);
+    w.type("learner_best_score", "gauge");
+    w.value("learner_best_score", s.learner.bestScore);
+    w.type("learner_latest_score", "gauge");
+    w.value("learner_latest_score", s.learner.latestScore);
+    w.type("learner_playback_seconds", "gauge");
+    w.value("learner_playback_seconds", s.learner.elapsedPlaybackSeconds);
+
+    w.type("timestamp_ms", "gauge");
+    w.value("timestamp_ms", s.timestampMs);
+}
+
+inline void appendFleetMetricsJson(const FleetMetricsSample& s, std::string& out)
+{
+    detail::JsonWriter w(out);
+    w.beginObject();
+    w.field("timestampMs", s.timestampMs);
+
+    w.beginObject("callback");
+    w.field("loadPermille", static_cast<uint64_t>(s.callbackLoadPermille));
+    w.field("loadP50Permille", static_cast<uint64_t>(s.callbackWindow.loadPercentilePermille(5000)));
+    w.field("loadP99Permille", static_cast<uint64_t>(s.callbackWindow.loadPercentilePermille(9900)));
+    w.field("loadP999Permille", static_cast<uint64_t>(s.callbackWindow.loadPercentilePermille(9990)));
+    w.field("jitterP99Us", s.callbackWindow.jitterPercentileUs(9900));
+    w.field("jitterP999Us", s.callbackWindow.jitterPercentileUs(9990));
+    w.field("callbacks", s.callbackTotals.callbacks);
+    w.field("overruns", s.callbackTotals.overruns);
+    w.field("lateArrivals", s.callbackTotals.lateArrivals);
+    w.endObject();
+
+    w.beginObject("xrun");
+    w.field("incidents", s.xrunIncidents);
+    w.field("dropped", s.xrunDropped);
+    w.beginObject("recentByCause");
+    for (size_t bit = 0; bit < XrunIncident::kNumFlags; ++bit)
+        w.field(xrunIncidentFlagName(bit), static_cast<uint64_t>(s.xrunRecentFlagCounts[bit]));
+    w.endObject();
+    w.endObject();
+
+    w.beginObject("stages");
+    w.field("calibrated", s.stages.clockCalibrated);
+    w.field("windowSeconds", s.stages.windowSeconds);
+    for (size_t i = 0; s.stages.clockCalibrated && i < kNumDspStages; ++i)
+    {
+        const auto& stage = s.stages.stages[i];
+        if (stage.samples == 0)
+            continue;
+        w.beginObject(dspStageName(static_cast<DspStage>(i)));
+        w.field("samples", stage.samples);
+        w.field("p50Us", stage.p50Us);
+        w.field("p99Us", stage.p99Us);
+        w.field("p999Us", stage.p999Us);
+        w.field("maxUs", stage.maxUs);
+        w.endObject();
+    }
+    w.endObject();
+
+    w.beginObject("memory");
+    w.field("totalBytes", s.memory.totalBytes());
+    for (size_t i = 0; i < kNumMemoryCategories; ++i)
+    {
+        const auto& c = s.memory.categories[i];
+        w.beginObject(memoryCategoryName(static_cast<MemoryCategory>(i)));
+        w.field("bytes", c.bytes);
+        w.field("peakBytes", c.peakBytes);
+        w.field("instances", static_cast<uint64_t>(c.instances));
+        w.endObject();
+    }
+    w.endObject();
+
+    w.beginObject("irCache");
+    w.field("hits", s.irCache.hits);
+    w.field("misses", s.irCache.misses);
+    w.field("evictions", s.irCache.evictions);
+    w.field("entries", s.irCache.entries);
+    w.field("diskBytes", s.irCache.diskBytes);
+    w.endObject();
+
+    w.beginObject("learner");
+    w.field("active", s.learnerActive);
+    w.field("status", noiseShaperLearnerStatusName(s.learner.status));
+    w.field("iteration", static_cast<uint64_t>(std::max(0, s.learner.iteration)));
+    w.field("generations", s.learner.totalGenerations);
+    w.field("bestScore", s.learner.bestScore);
+    w.field("latestScore", s.learner.latestScore);
+    w.field("playbackSeconds", s.learner.elapsedPlaybackSeconds);
+    w.endObject();
+
+    w.endObject();
+    out += '\n';
+}
+
+inline void appendFleetMetrics(const FleetMetricsSample& sample, FleetMetricsFormat format, std::string& out)
+{
+    if (format == FleetMetricsFormat::Json)
+        appendFleetMetricsJson(sample, out);
+    else
+        appendFleetMetricsPrometheus(sample, out);
+}
+
+} // namespace convo
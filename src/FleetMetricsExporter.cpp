@@ -0,0 +1,115 @@
+#include "FleetMetricsExporter.h"
+
+#include <algorithm>
+#include <utility>
+
+FleetMetricsExporter::FleetMetricsExporter(Options o)
+    : juce::Thread("FleetMetricsExporter")
+    , options(std::move(o))
+{
+    options.intervalMs = std::clamp(options.intervalMs, kMinIntervalMs, kMaxIntervalMs);
+}
+
+FleetMetricsExporter::~FleetMetricsExporter()
+{
+    stopThread(2000);
+}
+
+bool FleetMetricsExporter::start()
+{
+    if (options.transport == Transport::Udp)
+    {
+        if (options.udpPort <= 0 || options.udpPort > 65535)
+        {
+            juce::Logger::writeToLog("[METRICS] invalid UDP port: " + juce::String(options.udpPort));
+            return false;
+        }
+        socket = std::make_unique<juce::DatagramSocket>(false);
+    }
+    else
+    {
+        if (options.pipeName.isEmpty())
+            return false;
+        pipe = std::make_unique<juce::NamedPipe>();
+        if (!pipe->createNewPipe(options.pipeName, false))
+        {
+            juce::Logger::writeToLog("[METRICS] cannot create pipe: " + options.pipeName);
+            pipe.reset();
+            return false;
+        }
+    }
+
+    juce::Logger::writeToLog("[METRICS] exporting " + describe());
+    startThread(juce::Thread::Priority::low);
+    return true;
+}
+
+bool FleetMetricsExporter::isDue(double nowMs) const noexcept
+{
+    return nowMs - lastSubmitMs >= static_cast<double>(options.intervalMs);
+}
+
+void FleetMetricsExporter::submit(const convo::FleetMetricsSample& sample, double nowMs)
+{
+    lastSubmitMs = nowMs;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pending = sample;
+        hasPending = true;
+    }
+    notify();
+}
+
+juce::String FleetMetricsExporter::describe() const
+{
+    const juce::String target = options.transport == Transport::Udp
+        ? "udp 127.0.0.1:" + juce::String(options.udpPort)
+        : "pipe " + options.pipeName;
+    return target + " format=" + (options.format == convo::FleetMetricsFormat::Json ? "json" : "prometheus")
+         + " interval=" + juce::String(options.intervalMs) + "ms";
+}
+
+void FleetMetricsExporter::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(-1);
+        if (threadShouldExit())
+            break;
+
+        convo::FleetMetricsSample sample;
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            if (!hasPending)
+                continue;
+            sample = pending;
+            hasPending = false;
+        }
+
+        // 前回の送信からの差分で callback 負荷・ジッターのパーセンタイルを出す (初回は起動以降の全体)
+        sample.callbackWindow = {};
+        sample.callbackWindow.accumulate(sample.callbackTotals,
+                                         hasPreviousCallbackTotals ? previousCallbackTotals
+                                                                   : convo::CallbackTimingHistograms::Snapshot {});
+        previousCallbackTotals = sample.callbackTotals;
+        hasPreviousCallbackTotals = true;
+
+        payload.clear();
+        convo::appendFleetMetrics(sample, options.format, payload);
+        if (!send(payload) && !sendFailureLogged)
+        {
+            sendFailureLogged = true;
+            juce::Logger::writeToLog("[METRICS] send failed (" + describe() + "); later failures are not logged");
+        }
+    }
+}
+
+bool FleetMetricsExporter::send(const std::string& data)
+{
+    const int size = static_cast<int>(data.size());
+    if (socket != nullptr)
+        return socket->write("127.0.0.1", options.udpPort, data.data(), size) == size;
+    if (pipe != nullptr)
+        return pipe->write(data.data(), size, kPipeWriteTimeoutMs) == size;
+    return false;
+}
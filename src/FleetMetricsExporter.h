@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <JuceHeader.h>
+
+#include "FleetMetrics.h"
+
+/**
+    FleetMetricsExporter: ヘッドレス / キオスク運用向けに FleetMetrics を定期的に外へ送るスレッド (既定では無効)。
+
+    --metrics-udp <port> で 127.0.0.1:<port> へ UDP、--metrics-pipe <name> で名前付きパイプへ書く。
+    --metrics-format prometheus|json (既定 prometheus)、--metrics-interval-ms <ms> (既定 1000) で中身と間隔を選ぶ。
+    送り先はローカルだけ (集約は受け手のエージェントに任せる)。
+
+    - MainWindow の timer (Message Thread) が isDue() のときだけ値を集めて submit() し、
+      書式化と送信はこのスレッドが行う。Audio Thread には何も足さない
+    - callback 負荷のパーセンタイルは前回の送信以降の差分 (CallbackTimingStats) から出す
+    - 送り先が無い・受け手がいないときはその回を捨てる (溜めない)。失敗は最初の 1 回だけログに出す
+    - パイプは受け手が繋ぐまで kPipeWriteTimeoutMs 待って諦める
+*/
+class FleetMetricsExporter : private juce::Thread
+{
+public:
+    enum class Transport
+    {
+        Udp,
+        NamedPipe
+    };
+
+    struct Options
+    {
+        Transport transport = Transport::Udp;
+        int udpPort = 0;
+        juce::String pipeName;
+        convo::FleetMetricsFormat format = convo::FleetMetricsFormat::Prometheus;
+        int intervalMs = 1000;
+    };
+
+    // MainWindow の timer (500 ms) より細かくはできない
+    static constexpr int kMinIntervalMs = 500;
+    static constexpr int kMaxIntervalMs = 60'000;
+    static constexpr int kPipeWriteTimeoutMs = 100;
+
+    explicit FleetMetricsExporter(Options options);
+    ~FleetMetricsExporter() override;
+
+    // Message Thread 専用。送り先を開いてスレッドを始める。false = 開けなかった
+    bool start();
+
+    // Message Thread 専用。前回の submit から間隔が経っていれば true
+    [[nodiscard]] bool isDue(double nowMs) const noexcept;
+    // Message Thread 専用。前回の値がまだ送られていなければ置き換える
+    void submit(const convo::FleetMetricsSample& sample, double nowMs);
+
+    [[nodiscard]] juce::String describe() const;
+
+private:
+    void run() override;
+    bool send(const std::string& data);
+
+    Options options;
+    double lastSubmitMs = 0.0;    // Message Thread 専用
+
+    std::mutex pendingMutex;
+    convo::FleetMetricsSample pending;    // pendingMutex 保護
+    bool hasPending = false;              // pendingMutex 保護
+
+    // 以下はエクスポーターのスレッド専用
+    convo::CallbackTimingHistograms::Snapshot previousCallbackTotals {};
+    bool hasPreviousCallbackTotals = false;
+    std::unique_ptr<juce::DatagramSocket> socket;
+    std::unique_ptr<juce::NamedPipe> pipe;
+    std::string payload;
+    bool sendFailureLogged = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FleetMetricsExporter)
+};
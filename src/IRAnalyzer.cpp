@@ -1,77 +1,117 @@
 #include "IRAnalyzer.h"
+#include "core/PartitionedResponseAccumulator.h"
+#include "RealFft.h"
 #include <algorithm>
 #include <cmath>
-#include <complex>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
 namespace IRAnalyzer {
 
 //==============================================================================
-// SimpleRealFFT — 自己完結型 radix-2 DIT Cooley-Tukey 実数→CCS FFT
+// forwardCcs — 実数 N 点 (N は 2 の冪) → CCS [re0, im0, re1, im1, ..., re(N/2), im(N/2)]
+//   RealFftPlanCache の共有プランを使う (IPP / MKL DFTI はサイズ別に FftBackendWisdom が選ぶ)。
+//   プランを作れなければ false。
 //==============================================================================
-static void simpleRealFFT(double* data, int N) noexcept
+static bool forwardCcs(const double* in, double* outCcs, int N) noexcept
 {
-    std::vector<std::complex<double>> buf(static_cast<size_t>(N));
-    for (int i = 0; i < N; ++i)
-        buf[static_cast<size_t>(i)] = std::complex<double>(data[i], 0.0);
-
-    // ビット逆順並べ替え
-    for (int i = 1, j = 0; i < N; ++i)
-    {
-        int bit = N >> 1;
-        while ((j & bit) != 0) { j ^= bit; bit >>= 1; }
-        j ^= bit;
-        if (i < j) std::swap(buf[static_cast<size_t>(i)], buf[static_cast<size_t>(j)]);
-    }
+    int order = 0;
+    while ((1 << order) < N)
+        ++order;
+    const auto* plan = convo::RealFftPlanCache::getOrCreate(order, convo::FftScaling::None);
+    if (plan == nullptr)
+        return false;
+    std::vector<uint8_t> work(plan->getWorkBytes());
+    plan->forward(in, outCcs, work.empty() ? nullptr : work.data());
+    return true;
+}
 
-    // Cooley-Tukey 反復 FFT (DIT)
-    const double pi = juce::MathConstants<double>::pi;
-    for (int len = 2; len <= N; len <<= 1)
+//==============================================================================
+// interpolatedPeak — 振幅列 mags[0..numBins] の 3 点ガウス補間ピーク (極大のみ。無ければ 0.0)
+//==============================================================================
+static double interpolatedPeak(const double* mags, int numBins) noexcept
+{
+    double peak = 0.0;
+    for (int b = 1; b < numBins - 1; ++b)
     {
-        const double angle = -2.0 * pi / static_cast<double>(len);
-        const std::complex<double> w(std::cos(angle), std::sin(angle));
-        for (int i = 0; i < N; i += len)
+        const double ym1 = mags[b - 1], y0 = mags[b], yp1 = mags[b + 1];
+        if (y0 > ym1 && y0 > yp1 && y0 > 1e-18 && ym1 > 1e-18 && yp1 > 1e-18)
         {
-            std::complex<double> twiddle(1.0, 0.0);
-            for (int j = 0; j < len / 2; ++j)
+            const double logYm1 = std::log(ym1), logY0 = std::log(y0), logYp1 = std::log(yp1);
+            const double denom = logYm1 - 2.0 * logY0 + logYp1;
+            if (std::abs(denom) > 1e-18)
             {
-                const size_t i1 = static_cast<size_t>(i + j);
-                const size_t i2 = static_cast<size_t>(i + j + len / 2);
-                const auto t = twiddle * buf[i2];
-                const auto u = buf[i1];
-                buf[i1] = u + t;
-                buf[i2] = u - t;
-                twiddle *= w;
+                const double delta = 0.5 * (logYm1 - logYp1) / denom;
+                peak = std::max(peak, y0 * std::exp(-delta * (logY0 - logYm1)));
             }
         }
     }
+    return peak;
+}
 
-    // 複素結果を CCS 形式にパック
-    const int halfN = N / 2;
-    data[0] = buf[0].real();
-    data[1] = buf[static_cast<size_t>(halfN)].real();
-    for (int k = 1; k < halfN; ++k)
+//==============================================================================
+// streamingChannelPeak — kMaxAnalysisWindow を超える IR の全長応答ピーク
+//   IR を kMaxAnalysisWindow / 2 サンプルのパーティションに分け、各パーティションを
+//   kMaxAnalysisWindow 点 (ゼロ詰め) で変換して周波数領域で overlap-add する
+//   (core/PartitionedResponseAccumulator.h)。格子は従来の先頭窓解析と同じ分解能で、
+//   全長を切り詰めずに扱うため窓もコヒーレントゲイン補正も要らない。
+//==============================================================================
+static double streamingChannelPeak(const juce::AudioBuffer<double>& ir, int ch) noexcept
+{
+    const int grid = kMaxAnalysisWindow;
+    const int partition = grid / 2;
+    const int numSamples = ir.getNumSamples();
+    const int complexSize = grid / 2 + 1;
+
+    convo::PartitionedResponseAccumulator acc(grid);
+    std::vector<double> block(static_cast<size_t>(grid));
+    std::vector<double> ccs(static_cast<size_t>(grid) + 2);
+    std::vector<double> re(static_cast<size_t>(complexSize)), im(static_cast<size_t>(complexSize));
+
+    const double* src = ir.getReadPointer(ch);
+    for (int offset = 0; offset < numSamples; offset += partition)
     {
-        const size_t idx = static_cast<size_t>(2 * k);
-        data[idx]     = buf[static_cast<size_t>(k)].real();
-        data[idx + 1] = buf[static_cast<size_t>(k)].imag();
+        const int n = std::min(partition, numSamples - offset);
+        std::fill(block.begin(), block.end(), 0.0);
+        std::copy(src + offset, src + offset + n, block.begin());
+        if (!forwardCcs(block.data(), ccs.data(), grid))
+            return 0.0;
+
+        // CCS → SoA
+        for (int k = 0; k < complexSize; ++k)
+        {
+            re[static_cast<size_t>(k)] = ccs[static_cast<size_t>(2 * k)];
+            im[static_cast<size_t>(k)] = ccs[static_cast<size_t>(2 * k + 1)];
+        }
+        acc.addPartition(re.data(), im.data(), offset);
     }
+
+    std::vector<double> mags(static_cast<size_t>(complexSize));
+    acc.magnitudes(mags.data());
+    const double gridPeak = *std::max_element(mags.begin(), mags.end());
+    return std::max(gridPeak, interpolatedPeak(mags.data(), grid / 2));
 }
 
 //==============================================================================
-double estimateMaxFrequencyResponseGain(
-    const juce::AudioBuffer<double>& ir) noexcept
+// channelRangePeak — チャンネル [chBegin, chEnd) のコヒーレントゲイン補正済みピーク振幅
+//   (解析不能なら 0.0)。呼び出し元がチャンネル範囲の妥当性を保証する。
+//==============================================================================
+static double channelRangePeak(const juce::AudioBuffer<double>& ir, int chBegin, int chEnd) noexcept
 {
     const int numSamples = ir.getNumSamples();
-    const int numChannels = ir.getNumChannels();
-    if (numSamples <= 0 || numChannels <= 0)
-        return 1.0;
+    if (numSamples > kMaxAnalysisWindow)
+    {
+        double peak = 0.0;
+        for (int ch = chBegin; ch < chEnd; ++ch)
+            peak = std::max(peak, streamingChannelPeak(ir, ch));
+        return peak;
+    }
 
     const int copyLen = std::min(numSamples, kMaxAnalysisWindow);
     const int fftSize = juce::nextPowerOfTwo(copyLen);
     if (fftSize < 2)
-        return 1.0;
+        return 0.0;
 
     // Tukey 窓生成 (α=0.5)
     const double pi = juce::MathConstants<double>::pi;
@@ -97,61 +137,64 @@ double estimateMaxFrequencyResponseGain(
     double windowSum = 0.0;
     for (int i = 0; i < copyLen; ++i) windowSum += tukeyWindow[i];
     const double windowMean = windowSum / static_cast<double>(copyLen);
-    if (windowMean < 1e-18) return 1.0;
+    if (windowMean < 1e-18) return 0.0;
 
     double maxMagnitude = 0.0;
 
-    // 自己完結型 FFT (MKL/IPP 非依存)
-    for (int ch = 0; ch < numChannels; ++ch)
+    std::vector<double> in(static_cast<size_t>(fftSize));
+    std::vector<double> out(static_cast<size_t>(fftSize) + 2);
+    for (int ch = chBegin; ch < chEnd; ++ch)
     {
         const double* src = ir.getReadPointer(ch);
-        std::vector<double> out(static_cast<size_t>(fftSize) + 2, 0.0);
+        std::fill(in.begin(), in.end(), 0.0);
         for (int i = 0; i < copyLen; ++i)
-            out[static_cast<size_t>(i)] = src[i] * tukeyWindow[i];
+            in[static_cast<size_t>(i)] = src[i] * tukeyWindow[i];
 
-        simpleRealFFT(out.data(), fftSize);
+        if (!forwardCcs(in.data(), out.data(), fftSize))
+            return 0.0;
 
         const int numBins = fftSize / 2;
         for (int bin = 0; bin <= numBins; ++bin)
         {
-            double re = 0.0, im = 0.0;
-            if (bin == 0)        { re = out[0]; im = 0.0; }
-            else if (bin == numBins) { re = out[1]; im = 0.0; }
-            else                 { re = out[2 * bin]; im = out[2 * bin + 1]; }
-            const double mag = std::sqrt(re * re + im * im);
-            maxMagnitude = std::max(maxMagnitude, mag);
+            const double re = out[static_cast<size_t>(2 * bin)];
+            const double im = out[static_cast<size_t>(2 * bin + 1)];
+            maxMagnitude = std::max(maxMagnitude, std::sqrt(re * re + im * im));
         }
 
         // 3点ガウス補間
         {
             auto mags = std::make_unique<double[]>(static_cast<size_t>(numBins + 1));
-            mags[0] = std::abs(out[0]);
-            for (int b = 1; b < numBins; ++b)
+            for (int b = 0; b <= numBins; ++b)
             {
-                const int idx = 2 * b;
+                const size_t idx = static_cast<size_t>(2 * b);
                 mags[b] = std::sqrt(out[idx] * out[idx] + out[idx + 1] * out[idx + 1]);
             }
-            mags[numBins] = std::abs(out[1]);
-            for (int b = 1; b < numBins - 1; ++b)
-            {
-                const double ym1 = mags[b - 1], y0 = mags[b], yp1 = mags[b + 1];
-                if (y0 > ym1 && y0 > yp1 && y0 > 1e-18 && ym1 > 1e-18 && yp1 > 1e-18)
-                {
-                    const double logYm1 = std::log(ym1), logY0 = std::log(y0), logYp1 = std::log(yp1);
-                    const double denom = logYm1 - 2.0 * logY0 + logYp1;
-                    if (std::abs(denom) > 1e-18)
-                    {
-                        const double delta = 0.5 * (logYm1 - logYp1) / denom;
-                        maxMagnitude = std::max(maxMagnitude, y0 * std::exp(-delta * (logY0 - logYm1)));
-                    }
-                }
-            }
+            maxMagnitude = std::max(maxMagnitude, interpolatedPeak(mags.get(), numBins));
         }
     }
 
     // コヒーレントゲイン補正
-    maxMagnitude /= windowMean;
+    return maxMagnitude / windowMean;
+}
+
+double estimateMaxFrequencyResponseGain(
+    const juce::AudioBuffer<double>& ir) noexcept
+{
+    const int numSamples = ir.getNumSamples();
+    const int numChannels = ir.getNumChannels();
+    if (numSamples <= 0 || numChannels <= 0)
+        return 1.0;
+
+    const double maxMagnitude = channelRangePeak(ir, 0, numChannels);
     return (maxMagnitude > 1e-18) ? maxMagnitude : 1.0;
 }
 
+double estimateChannelFrequencyPeak(
+    const juce::AudioBuffer<double>& ir, int channel) noexcept
+{
+    if (ir.getNumSamples() <= 0 || channel < 0 || channel >= ir.getNumChannels())
+        return 0.0;
+    return channelRangePeak(ir, channel, channel + 1);
+}
+
 } // namespace IRAnalyzer
@@ -24,9 +24,9 @@ namespace IRAnalyzer
         double rmsDb            = 0.0;
     };
 
-    // ★ kMaxAnalysisWindow = 65536 上限。
-    //   IR長がこれを超える場合、最初の kMaxAnalysisWindow sample のみ解析対象。
-    //   将来 192kHz/384kHz 対応時は Policy 化を検討。
+    // ★ kMaxAnalysisWindow = 65536: 1 回の FFT で解析する上限。
+    //   IR長がこれを超える場合は kMaxAnalysisWindow / 2 サンプルずつのパーティションに分け、
+    //   kMaxAnalysisWindow 点の格子上で全長の応答を周波数領域 overlap-add で組み立てる (窓なし)。
     inline constexpr int kMaxAnalysisWindow = 65536;
 
     // Tukey α=0.5（両端 25% コサインテーパー、中央 50% フラット）
@@ -42,11 +42,25 @@ namespace IRAnalyzer
 
         備考:
         - FFT サイズは nextPowerOfTwo(min(ir長, kMaxAnalysisWindow))
-        - MKL DFTI 前方変換（DFTI_BACKWARD_SCALE = 1/N, 前方無スケール）
+        - ir長 > kMaxAnalysisWindow では全長をパーティション分割して解析する (切り詰めない)
+        - 前方変換は RealFftPlanCache の共有プラン (前方無スケール。IPP / MKL DFTI はサイズ別に実測で選択)
         - コヒーレントゲイン補正（windowMean で除算）
         - 3点ガウス補間で FFT bin 間ピーク誤差を軽減
     */
     [[nodiscard]] double estimateMaxFrequencyResponseGain(
         const juce::AudioBuffer<double>& ir) noexcept;
 
+    //==============================================================================
+    /**
+        1 チャンネル分の周波数応答ピーク (estimateMaxFrequencyResponseGain と同じ解析)。
+        チャンネル並列解析用。全チャンネルの最大値を取れば estimateMaxFrequencyResponseGain と一致する
+        (ただし無音・無効時のフォールバック 1.0 は行わず 0.0 を返す)。
+
+        @param ir       入力 IR
+        @param channel  解析するチャンネル
+        @return 線形振幅値。無効な場合は 0.0
+    */
+    [[nodiscard]] double estimateChannelFrequencyPeak(
+        const juce::AudioBuffer<double>& ir, int channel) noexcept;
+
 } // namespace IRAnalyzer
@@ -1,35 +1,46 @@
 #include "IRConverter.h"
 #include "IRDSP.h"
 #include "IRAnalyzer.h"  // ★ v14.0
+#include "IRLibraryIndex.h"
+#include "MappedIRReader.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstring>
+#include <future>
 #include <limits>
+#include <vector>
 
 #include <mkl.h>
 #include <mkl_cblas.h>
 #include "DiagnosticsConfig.h"
+#include "core/ScopedMXCSR.h"
 
 //==============================================================================
 // ★ v14.0: 第1段 — Energy 補正（基本 scaleFactor + safetyMargin）
 //==============================================================================
-static double computeEnergyScale(const juce::AudioBuffer<double>& ir) noexcept
+static double computeMaxChannelEnergy(const juce::AudioBuffer<double>& ir, int numSamples) noexcept
 {
-    const int numSamples = ir.getNumSamples();
-    const int numChannels = ir.getNumChannels();
-    if (numSamples <= 0 || numChannels <= 0)
-        return 1.0;
-
     double maxChannelEnergy = 0.0;
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
     {
         const double* data = ir.getReadPointer(ch);
         const double energy = cblas_ddot(numSamples, data, 1, data, 1);
         if (std::isfinite(energy) && energy > 1.0e-18)
             maxChannelEnergy = std::max(maxChannelEnergy, energy);
     }
+    return maxChannelEnergy;
+}
+
+static double computeEnergyScale(const juce::AudioBuffer<double>& ir) noexcept
+{
+    const int numSamples = ir.getNumSamples();
+    const int numChannels = ir.getNumChannels();
+    if (numSamples <= 0 || numChannels <= 0)
+        return 1.0;
 
+    const double maxChannelEnergy = computeMaxChannelEnergy(ir, numSamples);
     if (!(maxChannelEnergy > 1.0e-18) || !std::isfinite(maxChannelEnergy))
         return 1.0;
 
@@ -46,7 +57,9 @@ struct IRAnalysisResult {
     double frequencyPeakGain = 1.0;
 };
 
-static IRAnalysisResult analyzeIR(const juce::AudioBuffer<double>& ir, double currentScale) noexcept
+// precomputedFreqPeak: チャンネル並列変換で算出済みの周波数応答ピーク (nullptr なら FFT 解析を行う)
+static IRAnalysisResult analyzeIR(const juce::AudioBuffer<double>& ir, double currentScale,
+                                  const double* precomputedFreqPeak = nullptr) noexcept
 {
     IRAnalysisResult result;
     const int numSamples = ir.getNumSamples();
@@ -73,7 +86,9 @@ static IRAnalysisResult analyzeIR(const juce::AudioBuffer<double>& ir, double cu
     result.rmsValue = (totalSamples > 0) ? std::sqrt(irEnergySum / static_cast<double>(totalSamples)) : 0.0;
 
     // FFT 解析（IRAnalyzer に委譲）
-    result.frequencyPeakGain = IRAnalyzer::estimateMaxFrequencyResponseGain(ir);
+    result.frequencyPeakGain = (precomputedFreqPeak != nullptr)
+        ? *precomputedFreqPeak
+        : IRAnalyzer::estimateMaxFrequencyResponseGain(ir);
 
     return result;
 }
@@ -172,14 +187,19 @@ static void applyClampProtection(IRConverter::ScaleFactorResult& result,
 //==============================================================================
 // computeScaleFactor — 3段階オーケストレーター（★ v14.0）
 //==============================================================================
-IRConverter::ScaleFactorResult IRConverter::computeScaleFactor(const juce::AudioBuffer<double>& ir,
-                                                               const juce::AudioBuffer<double>* currentIr,
-                                                               double currentScale) noexcept
+static IRConverter::ScaleFactorResult computeScaleFactorImpl(const juce::AudioBuffer<double>& ir,
+                                                             const juce::AudioBuffer<double>* currentIr,
+                                                             double currentScale,
+                                                             const double* precomputedFreqPeak,
+                                                             double headEnergyRatio) noexcept
 {
-    ScaleFactorResult result;
+    IRConverter::ScaleFactorResult result;
 
     // 第1段: Energy 補正
+    //   ir が全長の先頭だけのときは全長のエネルギーで正規化した値に揃える (差し替え時にレベルが跳ねない)
     double scale = computeEnergyScale(ir);
+    if (headEnergyRatio > 0.0 && headEnergyRatio < 1.0)
+        scale *= std::sqrt(headEnergyRatio);
     if (scale <= 0.0 || !std::isfinite(scale))
         return result;
 
@@ -187,7 +207,7 @@ IRConverter::ScaleFactorResult IRConverter::computeScaleFactor(const juce::Audio
     result.hasScaleFactor = true;
 
     // 第2段: IR 解析（Peak/RMS/FFT）
-    const auto analysis = analyzeIR(ir, scale);
+    const auto analysis = analyzeIR(ir, scale, precomputedFreqPeak);
 
     // 第3段: 保護クランプ
     applyClampProtection(result, scale, analysis, currentIr, currentScale, ir);
@@ -195,13 +215,55 @@ IRConverter::ScaleFactorResult IRConverter::computeScaleFactor(const juce::Audio
     return result;
 }
 
+IRConverter::ScaleFactorResult IRConverter::computeScaleFactor(const juce::AudioBuffer<double>& ir,
+                                                               const juce::AudioBuffer<double>* currentIr,
+                                                               double currentScale,
+                                                               double headEnergyRatio) noexcept
+{
+    return computeScaleFactorImpl(ir, currentIr, currentScale, nullptr, headEnergyRatio);
+}
+
+//==============================================================================
+// ★ チャンネル並列変換: fn(ch) をチャンネル毎に std::async ワーカーで実行し、全ワーカーを join する。
+//   fn はキャンセルを検出したら false を返す。1 チャンネルでも false なら false。
+//   1 チャンネルの場合は呼び出しスレッドで直接実行する。
+//==============================================================================
+template <typename Fn>
+static bool forEachChannelParallel(int numChannels, Fn&& fn)
+{
+    if (numChannels <= 1)
+        return numChannels <= 0 || fn(0);
+
+    std::atomic<bool> anyCancelled { false };
+    std::vector<std::future<void>> futures;
+    futures.reserve(static_cast<size_t>(numChannels));
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        futures.emplace_back(std::async(std::launch::async, [&fn, &anyCancelled, ch]()
+        {
+            // ★ Bug#4: std::async ワーカー — ThreadPool 実装依存のため RAII で保存＋復元
+            const convo::cpu::ScopedMXCSR mxcsr;
+            if (anyCancelled.load(std::memory_order_relaxed) || !fn(ch))
+                anyCancelled.store(true, std::memory_order_relaxed);
+        }));
+    }
+
+    for (auto& f : futures) f.get();  // get(): 例外を確実に伝播 (全ワーカー join 後に判定)
+    return !anyCancelled.load(std::memory_order_relaxed);
+}
+
 bool IRConverter::loadAudioFile(const juce::File& file,
                                 juce::AudioBuffer<double>& out,
-                                double& sampleRateOut)
+                                double& sampleRateOut,
+                                double maxSeconds)
 {
     if (!file.existsAsFile())
         return false;
 
+    // ★ 非圧縮 WAV / AIFF はマップから直接 double へ展開する (float 中間バッファを経由しない)
+    if (convo::readMappedIR(file, out, sampleRateOut, maxSeconds))
+        return true;
+
     juce::AudioFormatManager fm;
     fm.registerBasicFormats();
 
@@ -209,7 +271,9 @@ bool IRConverter::loadAudioFile(const juce::File& file,
     if (!reader)
         return false;
 
-    const int64 n = reader->lengthInSamples;
+    const int64 n = (maxSeconds > 0.0 && reader->sampleRate > 0.0)
+        ? std::min<int64>(reader->lengthInSamples, static_cast<int64>(std::ceil(maxSeconds * reader->sampleRate)))
+        : reader->lengthInSamples;
     if (n <= 0 || n > static_cast<int64>(std::numeric_limits<int>::max()))
         return false;
 
@@ -240,7 +304,7 @@ std::unique_ptr<PreparedIRState> IRConverter::convertFile(const juce::File& irFi
 {
     juce::AudioBuffer<double> ir;
     double sourceRate = 0.0;
-    if (!loadAudioFile(irFile, ir, sourceRate))
+    if (!loadAudioFile(irFile, ir, sourceRate, config.previewHeadSeconds))
     {
         juce::Logger::writeToLog("[DIAG_IR] convertFile: loadAudioFile failed for "
             + irFile.getFullPathName());
@@ -253,11 +317,51 @@ std::unique_ptr<PreparedIRState> IRConverter::convertFile(const juce::File& irFi
         return nullptr;
     }
 
+    // ★ IR preview: 先頭で切った端をコサインでフェードアウトする (打ち切りによるクリックと高域の漏れを抑える)
+    if (config.previewHeadSeconds > 0.0 && sourceRate > 0.0
+        && ir.getNumSamples() >= static_cast<int>(std::ceil(config.previewHeadSeconds * sourceRate)))
+    {
+        const int numSamples = ir.getNumSamples();
+        const int fade = std::min(numSamples, static_cast<int>(std::ceil(config.previewFadeSeconds * sourceRate)));
+        for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+        {
+            double* data = ir.getWritePointer(ch) + (numSamples - fade);
+            for (int i = 0; i < fade; ++i)
+                data[i] *= 0.5 * (1.0 + std::cos(juce::MathConstants<double>::pi * static_cast<double>(i + 1) / fade));
+        }
+    }
+
+    // ★ Streaming activation: 先頭だけを残し、全長 (エンジンが使う区間) とのエネルギー比を記録する。
+    //   リサンプル・解析は先頭だけに掛かるので、IR が長いほど初回の変換時間が縮む
+    bool streamingHead = false;
+    double headEnergyRatio = 1.0;
+    if (config.streamingHeadSeconds > 0.0 && sourceRate > 0.0)
+    {
+        const int total = ir.getNumSamples();
+        const int headSamples = static_cast<int>(std::min<double>(total, std::ceil(config.streamingHeadSeconds * sourceRate)));
+        const int referenceSamples = (config.streamingReferenceSeconds > 0.0)
+            ? static_cast<int>(std::min<double>(total, std::ceil(config.streamingReferenceSeconds * sourceRate)))
+            : total;
+        if (headSamples > 0 && headSamples < referenceSamples)
+        {
+            const double headEnergy = computeMaxChannelEnergy(ir, headSamples);
+            const double referenceEnergy = computeMaxChannelEnergy(ir, referenceSamples);
+            if (headEnergy > 1.0e-18 && referenceEnergy > 1.0e-18)
+            {
+                headEnergyRatio = std::min(1.0, headEnergy / referenceEnergy);
+                ir.setSize(ir.getNumChannels(), headSamples, true);
+                streamingHead = true;
+            }
+        }
+    }
+
     juce::AudioBuffer<double> converted = ir;
     double actualSampleRate = sourceRate;
+    bool resampled = false;
     if (config.targetSampleRate > 0.0 && sourceRate > 0.0 && std::abs(sourceRate - config.targetSampleRate) > 1.0e-6)
     {
         converted = IRDSP::resampleIR(ir, sourceRate, config.targetSampleRate, shouldCancel);
+        resampled = converted.getNumSamples() > 0;
         if (converted.getNumSamples() <= 0)
         {
             // ★ Workaround: r8brain resampling failed (e.g., 48000→192000 Hz).
@@ -303,23 +407,51 @@ std::unique_ptr<PreparedIRState> IRConverter::convertFile(const juce::File& irFi
 
     std::memset(data, 0, bytes);
 
-    for (int ch = 0; ch < usableChannels; ++ch)
+    // ★ IR ライブラリ索引: リサンプルも先頭切り出しもしていなければ、変換対象は索引時に解析した IR と同一。
+    //   索引済みの周波数応答ピークを使い、チャンネルごとの FFT 解析を省く (stat のみで照合、内容は読まない)
+    IRLibraryEntry indexed;
+    const bool reuseIndexedPeak = !resampled && !streamingHead
+        && IRLibraryIndex::getInstance().lookup(irFile, indexed)
+        && indexed.numChannels == converted.getNumChannels()
+        && indexed.numSamples == converted.getNumSamples()
+        && indexed.sampleRate == sourceRate;
+
+    // ★ チャンネル並列変換: パーティション配置と周波数応答解析 (Tukey 窓 + FFT) はチャンネル毎に独立。
+    //   各ワーカーがチャンネル領域へ直接書き込み、全ワーカーの join 後に PreparedIRState を組み立てる。
+    //   変換済み IR にチャンネルが無い場合 (usableChannels=1 の保険) は配置をスキップする。
+    std::vector<double> channelFreqPeak(static_cast<size_t>(usableChannels), 0.0);
+    const int sourceChannels = converted.getNumChannels();
+    const bool completed = forEachChannelParallel(std::min(usableChannels, sourceChannels), [&](int ch)
     {
+        constexpr int kCancelCheckChunk = 16384;
         const double* src = converted.getReadPointer(ch);
-        for (int i = 0; i < samples; ++i)
+        double* dst = data + static_cast<size_t>(ch) * static_cast<size_t>(numPartitions) * static_cast<size_t>(fftSize);
+        for (int i = 0; i < samples; i += kCancelCheckChunk)
         {
-            if ((i & 0xF) == 0 && shouldCancel && shouldCancel())
-            {
-                mkl_free(data);
-                return nullptr;
-            }
-
-            const size_t idx = static_cast<size_t>(ch) * static_cast<size_t>(numPartitions) * static_cast<size_t>(fftSize)
-                             + static_cast<size_t>(i);
-            data[idx] = src[i];
+            if (shouldCancel && shouldCancel())
+                return false;
+            const int n = std::min(kCancelCheckChunk, samples - i);
+            std::memcpy(dst + i, src + i, static_cast<size_t>(n) * sizeof(double));
         }
+
+        if (shouldCancel && shouldCancel())
+            return false;
+        channelFreqPeak[static_cast<size_t>(ch)] = reuseIndexedPeak
+            ? indexed.rawFreqPeak
+            : IRAnalyzer::estimateChannelFrequencyPeak(converted, ch);
+        return true;
+    });
+
+    if (!completed)
+    {
+        mkl_free(data);
+        return nullptr;
     }
 
+    // estimateMaxFrequencyResponseGain と同じ規則 (全チャンネル最大、無効時 1.0)
+    const double rawFreqPeak = *std::max_element(channelFreqPeak.begin(), channelFreqPeak.end());
+    const double analysisFreqPeak = (rawFreqPeak > 1e-18) ? rawFreqPeak : 1.0;
+
     auto prepared = std::make_unique<PreparedIRState>();
     prepared->partitionData = data;
     prepared->partitionSizeBytes = bytes;
@@ -329,6 +461,8 @@ std::unique_ptr<PreparedIRState> IRConverter::convertFile(const juce::File& irFi
     prepared->sampleRate = actualSampleRate;
     prepared->generationId = config.generationId;
     prepared->cacheKey = config.cacheKey;
+    prepared->streamingHead = streamingHead;
+    prepared->headEnergyRatio = headEnergyRatio;
 
     // 時間領域 IR を保持（UI 表示用）
     // converted はリサンプリング済みの加工済み IR
@@ -336,30 +470,30 @@ std::unique_ptr<PreparedIRState> IRConverter::convertFile(const juce::File& irFi
 
     if (prepared->timeDomainIR && prepared->timeDomainIR->getNumSamples() > 0)
     {
-        const auto scaleInfo = computeScaleFactor(*prepared->timeDomainIR);
+        const auto scaleInfo = computeScaleFactorImpl(*prepared->timeDomainIR, nullptr, 1.0, &analysisFreqPeak, headEnergyRatio);
         prepared->scaleFactor = scaleInfo.scaleFactor;
         prepared->hasScaleFactor = scaleInfo.hasScaleFactor;
         prepared->additionalAttenuationDb = scaleInfo.additionalAttenuationDb;
 
         // ★ v14.2: IRAnalyzer による周波数ピークゲイン推定
-        //   scaledIR = timeDomainIR × scaleFactor を解析
-        juce::AudioBuffer<double> scaledIR(*prepared->timeDomainIR);
-        scaledIR.applyGain(prepared->scaleFactor);
+        //   scaledIR = timeDomainIR × scaleFactor の解析結果は、FFT の線形性により
+        //   並列解析済みの rawFreqPeak × scaleFactor と一致する (複製・再 FFT を省く)
+        const double scaledFreqPeak = rawFreqPeak * prepared->scaleFactor;
 
         // Diagnostic: check if scaled IR has any data
         {
             double peak = 0.0;
-            for (int ch = 0; ch < scaledIR.getNumChannels(); ++ch) {
-                const double* d = scaledIR.getReadPointer(ch);
-                for (int i = 0; i < std::min(100, scaledIR.getNumSamples()); ++i)
-                    peak = std::max(peak, std::abs(d[i]));
+            for (int ch = 0; ch < prepared->timeDomainIR->getNumChannels(); ++ch) {
+                const double* d = prepared->timeDomainIR->getReadPointer(ch);
+                for (int i = 0; i < std::min(100, prepared->timeDomainIR->getNumSamples()); ++i)
+                    peak = std::max(peak, std::abs(d[i] * prepared->scaleFactor));
             }
             juce::Logger::writeToLog("[DIAG_SCALE] scaleFactor=" + juce::String(prepared->scaleFactor, 6)
                 + " scaledPeak=" + juce::String(peak, 8)
                 + " timeDomainSamples=" + juce::String(prepared->timeDomainIR->getNumSamples()));
         }
 
-        const double freqPeakLin = IRAnalyzer::estimateMaxFrequencyResponseGain(scaledIR);
+        const double freqPeakLin = (scaledFreqPeak > 1e-18) ? scaledFreqPeak : 1.0;
         prepared->irFreqPeakGainDb = (freqPeakLin > 1e-18)
             ? static_cast<float>(20.0 * std::log10(freqPeakLin))
             : 0.0f;
@@ -388,6 +522,62 @@ std::unique_ptr<PreparedIRState> IRConverter::convertToHighRes(const juce::File&
     return convertFile(irFile, cfg, shouldCancel);
 }
 
+bool IRConverter::analyzeFile(const juce::File& irFile,
+                              uint64_t contentCrc,
+                              IRLibraryEntry& out,
+                              const std::function<bool()>& shouldCancel)
+{
+    juce::AudioBuffer<double> ir;
+    double sourceRate = 0.0;
+    if (!loadAudioFile(irFile, ir, sourceRate) || ir.getNumChannels() <= 0 || ir.getNumSamples() <= 0)
+        return false;
+
+    // バックグラウンド索引なのでチャンネル並列にはしない (ロード中の変換とコアを奪い合わない)
+    double rawFreqPeak = 0.0;
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+    {
+        if (shouldCancel && shouldCancel())
+            return false;
+        rawFreqPeak = std::max(rawFreqPeak, IRAnalyzer::estimateChannelFrequencyPeak(ir, ch));
+    }
+    const double analysisFreqPeak = (rawFreqPeak > 1e-18) ? rawFreqPeak : 1.0;
+    const auto scaleInfo = computeScaleFactorImpl(ir, nullptr, 1.0, &analysisFreqPeak, 1.0);
+
+    // scaleFactor 適用後の peak / RMS / L1 (チャンネル最大)
+    const double scale = scaleInfo.scaleFactor;
+    double peak = 0.0, energy = 0.0, maxL1 = 0.0;
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+    {
+        const double* data = ir.getReadPointer(ch);
+        double l1 = 0.0;
+        for (int i = 0; i < ir.getNumSamples(); ++i)
+        {
+            const double v = std::abs(data[i] * scale);
+            peak = std::max(peak, v);
+            energy += v * v;
+            l1 += v;
+        }
+        maxL1 = std::max(maxL1, l1);
+    }
+    const double rms = std::sqrt(energy / (static_cast<double>(ir.getNumChannels()) * ir.getNumSamples()));
+    const auto toDb = [](double lin) { return 20.0 * std::log10(std::max(lin, 1.0e-12)); };
+
+    out.contentCrc = contentCrc;
+    out.numChannels = ir.getNumChannels();
+    out.numSamples = ir.getNumSamples();
+    out.sampleRate = sourceRate;
+    out.rawFreqPeak = rawFreqPeak;
+    out.scaleFactor = scaleInfo.scaleFactor;
+    out.hasScaleFactor = scaleInfo.hasScaleFactor;
+    out.additionalAttenuationDb = scaleInfo.additionalAttenuationDb;
+    out.analysis.freqPeakGainLin = analysisFreqPeak * scale;
+    out.analysis.freqPeakGainDb = toDb(out.analysis.freqPeakGainLin);
+    out.analysis.l1NormDb = toDb(maxL1);
+    out.analysis.peakDb = toDb(peak);
+    out.analysis.rmsDb = toDb(rms);
+    return true;
+}
+
 //==============================================================================
 // ★ v14.0: 後方互換用デリゲート — IRAnalyzer に委譲
 //==============================================================================
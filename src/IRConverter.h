@@ -7,6 +7,8 @@
 
 #include "PreparedIRState.h"
 
+struct IRLibraryEntry;
+
 class IRConverter
 {
 public:
@@ -25,6 +27,14 @@ public:
         double targetSampleRate = 0.0;
         uint64_t generationId = 0;
         uint64_t cacheKey = 0;
+        // ★ Streaming activation: > 0 なら IR 先頭のこの秒数だけを変換する (streamingHead = true)。
+        //   scaleFactor は先頭 streamingReferenceSeconds (<= 0 は全長) の全体エネルギーで正規化した値に合わせる
+        double streamingHeadSeconds = 0.0;
+        double streamingReferenceSeconds = 0.0;
+        // ★ IR preview: > 0 ならファイルの先頭この秒数だけを読み込んで変換し、切り詰めた場合は末尾
+        //   previewFadeSeconds をフェードアウトする。全長を読まないので scaleFactor は先頭のエネルギーで決まる
+        double previewHeadSeconds = 0.0;
+        double previewFadeSeconds = 0.0;
     };
 
     std::unique_ptr<PreparedIRState> convertFile(const juce::File& irFile,
@@ -40,14 +50,24 @@ public:
 
     static ScaleFactorResult computeScaleFactor(const juce::AudioBuffer<double>& ir,
                                                 const juce::AudioBuffer<double>* currentIr = nullptr,
-                                                double currentScale = 1.0) noexcept;
+                                                double currentScale = 1.0,
+                                                double headEnergyRatio = 1.0) noexcept;
+
+    // ★ IR ライブラリ索引用: ファイルを読んだままの IR を解析する (リサンプル・トリムなし、currentIr なし)。
+    //   metadata・周波数応答ピーク・scaleFactor・最終解析を out に書き、contentCrc はそのまま記録する
+    static bool analyzeFile(const juce::File& irFile,
+                            uint64_t contentCrc,
+                            IRLibraryEntry& out,
+                            const std::function<bool()>& shouldCancel);
 
     // ★ v14.0: IRAnalyzer へのデリゲート（後方互換性維持）
     static double estimateMaxFrequencyResponseGain(const juce::AudioBuffer<double>& ir,
                                                    double sampleRate) noexcept;
 
 private:
+    // maxSeconds > 0 なら先頭のその秒数だけを読む
     static bool loadAudioFile(const juce::File& file,
                               juce::AudioBuffer<double>& out,
-                              double& sampleRateOut);
+                              double& sampleRateOut,
+                              double maxSeconds = 0.0);
 };
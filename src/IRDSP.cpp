@@ -1,10 +1,12 @@
 #include "IRDSP.h"
+#include "IRResampleSegmented.h"
 #include "core/ScopedMXCSR.h"
 #include <algorithm>
 #include <future>
 #include <cstring>
 #include <vector>
 #include <atomic>
+#include <thread>
 
 namespace IRDSP {
 
@@ -42,6 +44,19 @@ juce::AudioBuffer<double> resampleIR(
     const int numCh = inputIR.getNumChannels();
     const int chunkSize = std::clamp(cfg.chunkSizeBase, 1024, 8192);
 
+    // ★ 長尺 IR (例: 10 s @ 48k → 384k) はチャンネル並列だけではコア数を使い切れないため、
+    //    1ch を整数比周期に揃えた区間に分割して並列化する (IRResampleSegmented.h)。
+    //    区間数はチャンネル数 × 区間数 ≒ ハードウェアスレッド数に収める。
+    int segments = 1;
+    if (cfg.phase == r8b::fprLinearPhase && cfg.maxParallelSegments > 1 && cfg.minSegmentSamples > 0)
+    {
+        const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        segments = std::min({ cfg.maxParallelSegments,
+                              inLength / cfg.minSegmentSamples,
+                              std::max(1, hw / std::max(1, numCh)) });
+    }
+    const ChannelResampleParams segmentParams { inputSR, targetSR, cfg.transBand, cfg.stopBandAtten, chunkSize };
+
     // チャンネル並列処理（Loader Thread のみ）
     std::vector<std::future<void>> futures;
     std::vector<int> channelDone(numCh, -1);  // -1初期化: 例外・未完了を識別
@@ -52,6 +67,22 @@ juce::AudioBuffer<double> resampleIR(
             // ★ Bug#4: std::async ワーカー — ThreadPool 実装依存のため RAII で保存＋復元
             const convo::cpu::ScopedMXCSR mxcsr;
             try {
+                if (segments > 1)
+                {
+                    const int segDone = resampleChannelSegmented(inputIR.getReadPointer(ch), inLength,
+                                                                 resampled.getWritePointer(ch), maxOutLen,
+                                                                 segmentParams, segments, shouldExit);
+                    if (segDone == kResampleCancelled) {
+                        anyChannelCancelled.store(true, std::memory_order_relaxed);
+                        return;
+                    }
+                    if (segDone >= 0) {
+                        channelDone[ch] = segDone;
+                        return;
+                    }
+                    // kResampleUnsupported: 単一ストリームへフォールバック
+                }
+
                 auto resampler = std::make_unique<r8b::CDSPResampler>(
                     inputSR, targetSR, inLength,
                     cfg.transBand, cfg.stopBandAtten, cfg.phase);
@@ -135,7 +166,7 @@ juce::AudioBuffer<double> resampleIR(
     // maxDone == maxOutLen の場合はバッファサイズを維持
 
     juce::Logger::writeToLog("[DIAG_IR] resampleIR: success ch=" + juce::String(numCh)
-        + " outLen=" + juce::String(maxDone));
+        + " outLen=" + juce::String(maxDone) + " segments=" + juce::String(segments));
     return resampled;
 }
 
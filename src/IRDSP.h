@@ -9,6 +9,8 @@ struct ResampleConfig {
     double stopBandAtten = 140.0;          // 減衰量（dB）
     r8b::EDSPFilterPhaseResponse phase = r8b::fprLinearPhase;
     int chunkSizeBase = 2048;              // チャンクサイズ（1024〜8192推奨）
+    int maxParallelSegments = 8;           // 長尺 IR の 1ch あたり最大区間並列数（1=無効、線形位相のみ）
+    int minSegmentSamples = 65536;         // 区間分割する最小入力長／区間
 };
 
 namespace IRDSP {
@@ -0,0 +1,345 @@
+#include "IRLibraryIndex.h"
+
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+constexpr uint64_t kIndexMagic = 0x434F4E564F495258ULL; // "CONVOIRX"
+constexpr uint32_t kIndexVersion = 1;
+
+#pragma pack(push, 1)
+struct IndexFileHeader
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t numEntries;
+    uint32_t numFiles;
+    uint32_t reserved;
+    uint64_t checksum;  // ヘッダ以降の全バイトの FNV-1a
+};
+
+struct DiskEntry
+{
+    uint64_t contentCrc;
+    int32_t numChannels;
+    int32_t numSamples;
+    double sampleRate;
+    double rawFreqPeak;
+    double scaleFactor;
+    int32_t hasScaleFactor;
+    float additionalAttenuationDb;
+    double freqPeakGainLin;
+    double freqPeakGainDb;
+    double l1NormDb;
+    double peakDb;
+    double rmsDb;
+};
+
+// 直後に UTF-8 のパス (pathBytes バイト、終端なし) が続く
+struct DiskFileRecord
+{
+    uint64_t contentCrc;
+    int64_t sizeBytes;
+    int64_t modifiedMs;
+    uint32_t pathBytes;
+};
+#pragma pack(pop)
+
+uint64_t fnv1a(const void* data, size_t size) noexcept
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    const auto* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i)
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    return h;
+}
+
+DiskEntry toDisk(const IRLibraryEntry& e) noexcept
+{
+    DiskEntry d {};
+    d.contentCrc = e.contentCrc;
+    d.numChannels = e.numChannels;
+    d.numSamples = e.numSamples;
+    d.sampleRate = e.sampleRate;
+    d.rawFreqPeak = e.rawFreqPeak;
+    d.scaleFactor = e.scaleFactor;
+    d.hasScaleFactor = e.hasScaleFactor ? 1 : 0;
+    d.additionalAttenuationDb = e.additionalAttenuationDb;
+    d.freqPeakGainLin = e.analysis.freqPeakGainLin;
+    d.freqPeakGainDb = e.analysis.freqPeakGainDb;
+    d.l1NormDb = e.analysis.l1NormDb;
+    d.peakDb = e.analysis.peakDb;
+    d.rmsDb = e.analysis.rmsDb;
+    return d;
+}
+
+IRLibraryEntry fromDisk(const DiskEntry& d) noexcept
+{
+    IRLibraryEntry e;
+    e.contentCrc = d.contentCrc;
+    e.numChannels = d.numChannels;
+    e.numSamples = d.numSamples;
+    e.sampleRate = d.sampleRate;
+    e.rawFreqPeak = d.rawFreqPeak;
+    e.scaleFactor = d.scaleFactor;
+    e.hasScaleFactor = d.hasScaleFactor != 0;
+    e.additionalAttenuationDb = d.additionalAttenuationDb;
+    e.analysis.freqPeakGainLin = d.freqPeakGainLin;
+    e.analysis.freqPeakGainDb = d.freqPeakGainDb;
+    e.analysis.l1NormDb = d.l1NormDb;
+    e.analysis.peakDb = d.peakDb;
+    e.analysis.rmsDb = d.rmsDb;
+    return e;
+}
+}
+
+IRLibraryIndex& IRLibraryIndex::getInstance()
+{
+    static IRLibraryIndex instance;
+    return instance;
+}
+
+juce::File IRLibraryIndex::getIndexFile() const
+{
+    auto dir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                   .getChildFile("ConvoPeq")
+                   .getChildFile("IRIndex");
+    if (!dir.exists())
+    {
+        auto result = dir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create IR index directory");
+    }
+    return dir.getChildFile("index.bin");
+}
+
+bool IRLibraryIndex::matchesOnDisk(const juce::File& file, const FileRecord& record)
+{
+    return file.existsAsFile()
+        && file.getSize() == record.sizeBytes
+        && file.getLastModificationTime().toMilliseconds() == record.modifiedMs;
+}
+
+bool IRLibraryIndex::lookup(const juce::File& file, IRLibraryEntry& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+
+    const auto fileIt = files.find(file.getFullPathName());
+    if (fileIt == files.end() || !matchesOnDisk(file, fileIt->second))
+        return false;
+    const auto entryIt = entries.find(fileIt->second.contentCrc);
+    if (entryIt == entries.end())
+        return false;
+    out = entryIt->second;
+    return true;
+}
+
+bool IRLibraryIndex::lookupByCrc(uint64_t contentCrc, IRLibraryEntry& out)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+
+    const auto it = entries.find(contentCrc);
+    if (it == entries.end())
+        return false;
+    out = it->second;
+    return true;
+}
+
+bool IRLibraryIndex::isUpToDate(const juce::File& file)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+
+    const auto it = files.find(file.getFullPathName());
+    return it != files.end()
+        && entries.count(it->second.contentCrc) != 0
+        && matchesOnDisk(file, it->second);
+}
+
+void IRLibraryIndex::store(const juce::File& file, const IRLibraryEntry& entry)
+{
+    if (entry.contentCrc == 0)
+        return;
+
+    FileRecord record;
+    record.sizeBytes = file.getSize();
+    record.modifiedMs = file.getLastModificationTime().toMilliseconds();
+    record.contentCrc = entry.contentCrc;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    entries[entry.contentCrc] = entry;
+    files[file.getFullPathName()] = record;
+    dirty = true;
+}
+
+void IRLibraryIndex::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!loaded || !dirty)
+        return;
+    writeIndexFileLocked();
+}
+
+void IRLibraryIndex::pruneMissingFiles()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+
+    std::unordered_set<uint64_t> referenced;
+    for (auto it = files.begin(); it != files.end();)
+    {
+        if (!juce::File(it->first).existsAsFile())
+        {
+            it = files.erase(it);
+            dirty = true;
+        }
+        else
+        {
+            referenced.insert(it->second.contentCrc);
+            ++it;
+        }
+    }
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (referenced.count(it->first) == 0)
+        {
+            it = entries.erase(it);
+            dirty = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void IRLibraryIndex::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    files.clear();
+    loaded = true;
+    dirty = false;
+    getIndexFile().deleteFile();
+}
+
+size_t IRLibraryIndex::getEntryCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    return entries.size();
+}
+
+size_t IRLibraryIndex::getFileCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    return files.size();
+}
+
+void IRLibraryIndex::ensureLoadedLocked()
+{
+    if (loaded)
+        return;
+    loaded = true;
+    if (!readIndexFileLocked())
+    {
+        entries.clear();
+        files.clear();
+    }
+}
+
+bool IRLibraryIndex::readIndexFileLocked()
+{
+    const auto file = getIndexFile();
+    if (!file.existsAsFile())
+        return false;
+
+    juce::MemoryBlock block;
+    if (!file.loadFileAsData(block) || block.getSize() < sizeof(IndexFileHeader))
+        return false;
+
+    const auto* bytes = static_cast<const uint8_t*>(block.getData());
+    const size_t size = block.getSize();
+    IndexFileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != kIndexMagic || header.version != kIndexVersion
+        || header.checksum != fnv1a(bytes + sizeof(header), size - sizeof(header)))
+    {
+        juce::Logger::writeToLog("[IRLibraryIndex] Discarding unreadable index " + file.getFullPathName());
+        return false;
+    }
+
+    size_t pos = sizeof(header);
+    if (size - pos < static_cast<size_t>(header.numEntries) * sizeof(DiskEntry))
+        return false;
+    for (uint32_t i = 0; i < header.numEntries; ++i, pos += sizeof(DiskEntry))
+    {
+        DiskEntry d;
+        std::memcpy(&d, bytes + pos, sizeof(d));
+        entries[d.contentCrc] = fromDisk(d);
+    }
+
+    for (uint32_t i = 0; i < header.numFiles; ++i)
+    {
+        if (size - pos < sizeof(DiskFileRecord))
+            return false;
+        DiskFileRecord d;
+        std::memcpy(&d, bytes + pos, sizeof(d));
+        pos += sizeof(d);
+        if (size - pos < d.pathBytes)
+            return false;
+        const auto path = juce::String::fromUTF8(reinterpret_cast<const char*>(bytes + pos), static_cast<int>(d.pathBytes));
+        pos += d.pathBytes;
+        files[path] = FileRecord { d.sizeBytes, d.modifiedMs, d.contentCrc };
+    }
+    return true;
+}
+
+void IRLibraryIndex::writeIndexFileLocked()
+{
+    juce::MemoryOutputStream body;
+    for (const auto& [crc, entry] : entries)
+    {
+        const DiskEntry d = toDisk(entry);
+        body.write(&d, sizeof(d));
+    }
+    for (const auto& [path, record] : files)
+    {
+        const auto utf8 = path.toRawUTF8();
+        const auto pathBytes = static_cast<uint32_t>(std::strlen(utf8));
+        const DiskFileRecord d { record.contentCrc, record.sizeBytes, record.modifiedMs, pathBytes };
+        body.write(&d, sizeof(d));
+        body.write(utf8, pathBytes);
+    }
+
+    IndexFileHeader header {};
+    header.magic = kIndexMagic;
+    header.version = kIndexVersion;
+    header.numEntries = static_cast<uint32_t>(entries.size());
+    header.numFiles = static_cast<uint32_t>(files.size());
+    header.checksum = fnv1a(body.getData(), body.getDataSize());
+
+    const auto file = getIndexFile();
+    juce::TemporaryFile tempFile(file);
+    {
+        juce::FileOutputStream stream(tempFile.getFile());
+        if (!stream.openedOk())
+            return;
+        if (!stream.write(&header, sizeof(header)) || !stream.write(body.getData(), body.getDataSize()))
+            return;
+        stream.flush();
+        if (stream.getStatus().failed())
+            return;
+    }
+
+    if (tempFile.overwriteTargetFileWithTemporary())
+        dirty = false;
+    else
+        juce::Logger::writeToLog("Warning: Could not update IR library index");
+}
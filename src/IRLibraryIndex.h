@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <JuceHeader.h>
+
+#include "IRAnalyzer.h"
+
+/**
+    IRLibraryEntry: 1 つの IR ファイル内容 (内容 CRC) の解析結果。
+    値はファイルを読んだままの (リサンプル・トリム前の) IR に対するもの。
+*/
+struct IRLibraryEntry
+{
+    uint64_t contentCrc = 0;        // CacheManager::computeFileContentCRC
+    int numChannels = 0;
+    int numSamples = 0;
+    double sampleRate = 0.0;
+
+    // 未スケール IR の周波数応答ピーク (全チャンネル最大、無音なら 0.0)。IRConverter::convertFile が再利用する
+    double rawFreqPeak = 0.0;
+
+    // IRConverter::computeScaleFactor (currentIr なし) の結果
+    double scaleFactor = 1.0;
+    bool hasScaleFactor = false;
+    float additionalAttenuationDb = 0.0f;
+
+    // scaleFactor 適用後の最終解析
+    IRAnalyzer::IRFinalAnalysis analysis;
+
+    [[nodiscard]] double getLengthSeconds() const noexcept
+    {
+        return (sampleRate > 0.0) ? static_cast<double>(numSamples) / sampleRate : 0.0;
+    }
+};
+
+/**
+    IRLibraryIndex: IR ライブラリの解析結果の永続索引。
+
+    エントリはファイル内容 CRC をキーに持ち、別名・移動したファイルも同じエントリを共有する。
+    パスごとに (サイズ, 更新時刻, CRC) も記録し、lookup はファイルの stat だけで済ませる
+    (内容を読まないので IR 一覧の表示に使える)。サイズか更新時刻が変わったパスは未索引と見なす。
+
+    保存先は %APPDATA%/ConvoPeq/IRIndex/index.bin (tmp→置換)。起動後最初のアクセスで読み込み、
+    破損・版違いのファイルは捨てて空から作り直す (IRLibraryIndexer が再走査で埋める)。
+
+    スレッド: IRLibraryIndexer (書き込み) と Loader / Message Thread (読み出し) から並行に呼ばれる (mutex)。
+*/
+class IRLibraryIndex
+{
+public:
+    static IRLibraryIndex& getInstance();
+
+    /** file の現在の内容に対するエントリがあれば out に写して true。 */
+    bool lookup(const juce::File& file, IRLibraryEntry& out);
+    bool lookupByCrc(uint64_t contentCrc, IRLibraryEntry& out);
+    [[nodiscard]] bool isUpToDate(const juce::File& file);
+
+    /** file (現在のサイズ・更新時刻) を entry に結び付ける。ディスクへは flush() で書く。 */
+    void store(const juce::File& file, const IRLibraryEntry& entry);
+    void flush();
+
+    /** 存在しなくなったパスと、どのパスからも参照されないエントリを捨てる。 */
+    void pruneMissingFiles();
+    void clear();
+
+    [[nodiscard]] size_t getEntryCount();
+    [[nodiscard]] size_t getFileCount();
+
+private:
+    IRLibraryIndex() = default;
+
+    struct FileRecord
+    {
+        int64_t sizeBytes = 0;
+        int64_t modifiedMs = 0;
+        uint64_t contentCrc = 0;
+    };
+
+    juce::File getIndexFile() const;
+    static bool matchesOnDisk(const juce::File& file, const FileRecord& record);
+
+    void ensureLoadedLocked();
+    bool readIndexFileLocked();
+    void writeIndexFileLocked();
+
+    std::unordered_map<uint64_t, IRLibraryEntry> entries;
+    std::unordered_map<juce::String, FileRecord> files;  // キー = フルパス
+    bool loaded = false;
+    bool dirty = false;
+    std::mutex mutex;
+};
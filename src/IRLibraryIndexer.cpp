@@ -0,0 +1,124 @@
+#include "IRLibraryIndexer.h"
+
+#include "CacheManager.h"
+#include "ConvolverProcessor.h"
+#include "IRConverter.h"
+#include "IRLibraryIndex.h"
+#include "core/ThreadAffinityManager.h"
+
+#include "audioengine/AtomicAccess.h"
+
+IRLibraryIndexer::IRLibraryIndexer(ConvolverProcessor& p,
+                                   std::vector<juce::File> dirs,
+                                   ThreadAffinityManager* affinityMgr)
+    : juce::Thread("ConvolverIRLibraryIndexer"),
+      processor(p),
+      directories(std::move(dirs)),
+      affinityManager(affinityMgr)
+{
+}
+
+IRLibraryIndexer::~IRLibraryIndexer()
+{
+    cancel();
+    stopThread(5000);
+}
+
+void IRLibraryIndexer::cancel()
+{
+    convo::publishAtomic(cancelled, true, std::memory_order_release); // release: run 側 checkAndCancel の acquire と HB
+    signalThreadShouldExit();
+}
+
+int IRLibraryIndexer::getFilesIndexed() const noexcept
+{
+    return convo::consumeAtomic(filesIndexed, std::memory_order_relaxed); // relaxed: 進捗表示用の単独カウンタ
+}
+
+bool IRLibraryIndexer::checkAndCancel()
+{
+    return threadShouldExit()
+        || convo::consumeAtomic(cancelled, std::memory_order_acquire); // acquire: cancel() の release と HB
+}
+
+bool IRLibraryIndexer::waitWhileLoading()
+{
+    while (processor.isLoadingIR())
+    {
+        if (checkAndCancel())
+            return false;
+        wait(100);
+    }
+    return !checkAndCancel();
+}
+
+void IRLibraryIndexer::run()
+{
+    if (affinityManager != nullptr)
+        affinityManager->applyCurrentThreadPolicy(ThreadType::HeavyBackground);
+
+    setPriority(Priority::background);
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    const auto wildcard = formats.getWildcardForAllFormats();
+
+    auto& index = IRLibraryIndex::getInstance();
+    const auto shouldCancel = [this]() { return checkAndCancel() || processor.isLoadingIR(); };
+    int sinceFlush = 0;
+
+    for (const auto& dir : directories)
+    {
+        if (!dir.isDirectory())
+            continue;
+
+        for (const auto& item : juce::RangedDirectoryIterator(dir, true, wildcard, juce::File::findFiles))
+        {
+            if (!waitWhileLoading())
+            {
+                index.flush();
+                return;
+            }
+
+            const auto file = item.getFile();
+            if (index.isUpToDate(file))
+                continue;
+
+            const uint64_t crc = CacheManager::computeFileContentCRC(file);
+            if (crc == 0)
+                continue;
+
+            IRLibraryEntry entry;
+            if (!index.lookupByCrc(crc, entry))
+            {
+                // 解析中にロードが始まったら打ち切り、ロード完了後に同じファイルをやり直す
+                bool analysed = false;
+                do
+                {
+                    if (!waitWhileLoading())
+                    {
+                        index.flush();
+                        return;
+                    }
+                    analysed = IRConverter::analyzeFile(file, crc, entry, shouldCancel);
+                } while (!analysed && processor.isLoadingIR());
+
+                if (!analysed)
+                    continue;  // 読めない / 対象外の形式 (キャンセルは次の waitWhileLoading で抜ける)
+            }
+
+            index.store(file, entry);
+            convo::fetchAddAtomic(filesIndexed, 1, std::memory_order_relaxed); // relaxed: 進捗表示用の単独カウンタ
+            if (++sinceFlush >= kFlushInterval)
+            {
+                index.flush();
+                sinceFlush = 0;
+            }
+        }
+    }
+
+    index.pruneMissingFiles();
+    index.flush();
+    juce::Logger::writeToLog("[IRLibraryIndexer] Indexed " + juce::String(getFilesIndexed())
+        + " file(s); index holds " + juce::String(static_cast<int>(index.getEntryCount())) + " IR(s)");
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <JuceHeader.h>
+
+class ConvolverProcessor;
+class ThreadAffinityManager;
+
+/**
+    IRLibraryIndexer: 設定された IR ディレクトリを走査して IRLibraryIndex を埋めるスレッド。
+
+    UI 側 ConvolverProcessor が setIRLibraryDirectories で起動する。各ディレクトリを再帰的に走査し、
+    索引が古い (パス未登録・サイズ/更新時刻の変化) 音声ファイルだけを処理する:
+    内容 CRC が既知なら解析を省いてパスを結び付け、未知なら IRConverter::analyzeFile で解析する。
+    IR ロード中は着手を待ち (ユーザー操作を優先)、一定件数ごとと終了時に索引をディスクへ書く。
+    走査が終わったら、存在しなくなったファイルの記録を捨てる。
+*/
+class IRLibraryIndexer : public juce::Thread
+{
+public:
+    IRLibraryIndexer(ConvolverProcessor& processor,
+                     std::vector<juce::File> directories,
+                     ThreadAffinityManager* affinityManager);
+
+    ~IRLibraryIndexer() override;
+
+    void run() override;
+    void cancel();
+
+    [[nodiscard]] int getFilesIndexed() const noexcept;
+
+private:
+    static constexpr int kFlushInterval = 32;  // 解析件数がこの数に達するごとに索引を書き出す
+
+    bool checkAndCancel();
+    bool waitWhileLoading();
+
+    ConvolverProcessor& processor;
+    std::vector<juce::File> directories;
+    std::atomic<bool> cancelled { false };
+    std::atomic<int> filesIndexed { 0 };
+    ThreadAffinityManager* affinityManager = nullptr;
+};
@@ -0,0 +1,170 @@
+#include "IRResampleSegmented.h"
+#include "core/ScopedMXCSR.h"
+#include "CDSPResampler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace IRDSP {
+
+int resampleChannelSerial(const double* in, int inLength, double* out, int outCapacity,
+                          const ChannelResampleParams& params,
+                          const std::function<bool()>& shouldExit)
+{
+    const int chunkSize = std::max(1, std::min(params.chunkSize, std::max(1, inLength)));
+    auto resampler = std::make_unique<r8b::CDSPResampler>(
+        params.inputSR, params.targetSR, chunkSize,
+        params.transBand, params.stopBandAtten, r8b::fprLinearPhase);
+
+    std::vector<double> tempIn(static_cast<size_t>(chunkSize));
+    int inputProcessed = 0;
+    int done = 0;
+    int iterations = 0;
+    constexpr int maxIterations = 1000000;
+
+    while (inputProcessed < inLength && done < outCapacity && ++iterations < maxIterations)
+    {
+        if (shouldExit && shouldExit())
+            return kResampleCancelled;
+
+        // r8brain は入力バッファを作業領域として書き換え得るためコピーして渡す
+        const int chunk = std::min(chunkSize, inLength - inputProcessed);
+        std::memcpy(tempIn.data(), in + inputProcessed, static_cast<size_t>(chunk) * sizeof(double));
+
+        double* r8bOutput = nullptr;
+        const int generated = resampler->process(tempIn.data(), chunk, r8bOutput);
+        inputProcessed += chunk;
+
+        if (generated > 0)
+        {
+            const int toCopy = std::min(generated, outCapacity - done);
+            std::memcpy(out + done, r8bOutput, static_cast<size_t>(toCopy) * sizeof(double));
+            done += toCopy;
+        }
+    }
+
+    while (done < outCapacity && ++iterations < maxIterations)
+    {
+        if (shouldExit && shouldExit())
+            return kResampleCancelled;
+        double* r8bOutput = nullptr;
+        const int generated = resampler->process(nullptr, 0, r8bOutput);
+        if (generated <= 0) break;
+        const int toCopy = std::min(generated, outCapacity - done);
+        std::memcpy(out + done, r8bOutput, static_cast<size_t>(toCopy) * sizeof(double));
+        done += toCopy;
+    }
+
+    return done;
+}
+
+int resampleChannelSegmented(const double* in, int inLength, double* out, int outCapacity,
+                             const ChannelResampleParams& params, int segments,
+                             const std::function<bool()>& shouldExit)
+{
+    if (segments <= 1 || inLength <= 0)
+        return kResampleUnsupported;
+
+    // 区間境界は「inPeriod 入力 ↔ outPeriod 出力」の整数比周期に揃える
+    // (境界 s の出力位置 s / inPeriod * outPeriod が整数になり、単一ストリームと位相が一致する)
+    const double inRounded = std::round(params.inputSR);
+    const double outRounded = std::round(params.targetSR);
+    if (inRounded <= 0.0 || outRounded <= 0.0
+        || std::abs(params.inputSR - inRounded) > 1.0e-9 || std::abs(params.targetSR - outRounded) > 1.0e-9)
+        return kResampleUnsupported;
+
+    const int64_t inRate = static_cast<int64_t>(inRounded);
+    const int64_t outRate = static_cast<int64_t>(outRounded);
+    const int64_t g = std::gcd(inRate, outRate);
+    const int64_t inPeriod = inRate / g;
+    const int64_t outPeriod = outRate / g;
+    auto outPosOf = [inPeriod, outPeriod](int64_t inPos) noexcept { return inPos / inPeriod * outPeriod; };
+
+    // ガード: 最初の出力までに必要な入力長 (線形位相フィルターの片側長 + 段間遅延) + 余裕
+    int guard = 0;
+    {
+        r8b::CDSPResampler probe(params.inputSR, params.targetSR, std::max(1, params.chunkSize),
+                                 params.transBand, params.stopBandAtten, r8b::fprLinearPhase);
+        guard = probe.getInLenBeforeOutPos(0) + 64;
+    }
+
+    // 区間長がガードに比べて短い場合は分割の利得が無い
+    const int64_t minSegment = std::max<int64_t>(static_cast<int64_t>(guard) * 4, inPeriod);
+    segments = static_cast<int>(std::min<int64_t>(segments, inLength / minSegment));
+    if (segments <= 1)
+        return kResampleUnsupported;
+
+    std::vector<int64_t> bounds(static_cast<size_t>(segments) + 1);
+    bounds.front() = 0;
+    bounds.back() = inLength;
+    for (int j = 1; j < segments; ++j)
+    {
+        const int64_t raw = static_cast<int64_t>(inLength) * j / segments;
+        bounds[static_cast<size_t>(j)] = raw / inPeriod * inPeriod;
+        if (bounds[static_cast<size_t>(j)] <= bounds[static_cast<size_t>(j - 1)])
+            return kResampleUnsupported;
+    }
+
+    std::atomic<bool> anyCancelled { false };
+    std::atomic<bool> anyUnsupported { false };
+    std::vector<int64_t> segmentEnd(static_cast<size_t>(segments), 0);
+    std::vector<std::future<void>> futures;
+    futures.reserve(static_cast<size_t>(segments));
+
+    for (int j = 0; j < segments; ++j)
+    {
+        futures.emplace_back(std::async(std::launch::async, [&, j]()
+        {
+            // ★ Bug#4: std::async ワーカー — ThreadPool 実装依存のため RAII で保存＋復元
+            const convo::cpu::ScopedMXCSR mxcsr;
+            const bool isLast = (j == segments - 1);
+            const int64_t segBegin = bounds[static_cast<size_t>(j)];
+            const int64_t segEnd   = bounds[static_cast<size_t>(j) + 1];
+            const int64_t sliceBegin = (j == 0) ? 0 : std::max<int64_t>(0, segBegin - guard) / inPeriod * inPeriod;
+            const int64_t sliceEnd   = isLast ? inLength : std::min<int64_t>(inLength, segEnd + guard);
+            const int64_t sliceOut   = outPosOf(sliceBegin);
+
+            const int sliceLen = static_cast<int>(sliceEnd - sliceBegin);
+            const int64_t localCapacity = (static_cast<int64_t>(sliceLen) * outRate + inRate - 1) / inRate + 16;
+            std::vector<double> local(static_cast<size_t>(localCapacity));
+            const int produced = resampleChannelSerial(in + sliceBegin, sliceLen, local.data(),
+                                                       static_cast<int>(localCapacity), params, shouldExit);
+            if (produced == kResampleCancelled)
+            {
+                anyCancelled.store(true, std::memory_order_relaxed);
+                return;
+            }
+
+            const int64_t outBegin = outPosOf(segBegin);
+            const int64_t outEnd   = isLast ? sliceOut + produced : outPosOf(segEnd);
+            if (sliceOut + produced < outEnd || outBegin < sliceOut)
+            {
+                anyUnsupported.store(true, std::memory_order_relaxed);  // ガード不足 (想定外)
+                return;
+            }
+
+            const int64_t copyEnd = std::min<int64_t>(outEnd, outCapacity);
+            if (copyEnd > outBegin)
+                std::memcpy(out + outBegin, local.data() + (outBegin - sliceOut),
+                            static_cast<size_t>(copyEnd - outBegin) * sizeof(double));
+            segmentEnd[static_cast<size_t>(j)] = copyEnd;
+        }));
+    }
+
+    for (auto& f : futures) f.get();  // get(): 例外を確実に伝播
+
+    if (anyCancelled.load(std::memory_order_relaxed))
+        return kResampleCancelled;
+    if (anyUnsupported.load(std::memory_order_relaxed))
+        return kResampleUnsupported;
+    return static_cast<int>(std::max<int64_t>(0, segmentEnd.back()));
+}
+
+} // namespace IRDSP
@@ -0,0 +1,47 @@
+// src/IRResampleSegmented.h
+// IR リサンプリングの 1ch コア (r8brain のみに依存、JUCE 非依存)
+//
+// 設計:
+//   - resampleChannelSerial   : 1 本の CDSPResampler に chunk 単位で流す従来経路。
+//   - resampleChannelSegmented: 長尺 IR を整数比周期に揃えた区間へ分割し、前後に
+//     フィルター長ぶんのガードを付けて独立に並列リサンプリングし、出力を連結する。
+//     r8brain の出力は呼び出し chunk 長に依存しないが、ストリーム開始位置が異なると
+//     内部ブロック畳み込みの丸め順が変わるため、単一ストリームとの差は 1 ulp 程度残る
+//     (長さは完全一致)。IRDSP::resampleIR と単体テストから使用する。
+#pragma once
+
+#include <functional>
+
+namespace IRDSP {
+
+struct ChannelResampleParams
+{
+    double inputSR = 0.0;
+    double targetSR = 0.0;
+    double transBand = 2.0;
+    double stopBandAtten = 140.0;
+    int    chunkSize = 2048;
+};
+
+inline constexpr int kResampleCancelled   = -1;  ///< shouldExit により中断
+inline constexpr int kResampleUnsupported = -2;  ///< 区間分割不可 (呼び出し元は Serial へフォールバック)
+
+/**
+    1ch を線形位相 r8brain で単一ストリームとしてリサンプリングし out へ書き込む。
+    @return 出力サンプル数 (outCapacity で打ち切り)、または kResampleCancelled
+*/
+int resampleChannelSerial(const double* in, int inLength, double* out, int outCapacity,
+                          const ChannelResampleParams& params,
+                          const std::function<bool()>& shouldExit);
+
+/**
+    区間分割版。segments 個の区間を std::async で並列に処理する。
+    サンプルレートが整数でない場合・区間が短すぎる場合は kResampleUnsupported を返す。
+    shouldExit は全ワーカーから並行に呼ばれる。
+    @return 出力サンプル数、kResampleCancelled、または kResampleUnsupported
+*/
+int resampleChannelSegmented(const double* in, int inLength, double* out, int outCapacity,
+                             const ChannelResampleParams& params, int segments,
+                             const std::function<bool()>& shouldExit);
+
+} // namespace IRDSP
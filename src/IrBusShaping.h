@@ -0,0 +1,97 @@
+// src/IrBusShaping.h
+// IR bus (ConvolverProcessor の多 IR バス) の入力整形: pre-delay・末尾の打ち切り・フェードアウト・ゲイン
+//
+// 背景:
+//   早期反射 IR・別室の残響 IR・スピーカー補正 IR を重ねる場合、従来はオフラインで 1 本に混ぜるか
+//   コンボルバーを直列/並列に並べていた (エンジンごとに FDL と FFT/IFFT を持つ)。IR bus は主 IR と
+//   追加 IR を 1 つのエンジンで畳み込む。入力ごとのスペクトルを NUC の spectral bus で合成する経路と、
+//   構成上それができないとき時間領域で主 IR へ加算する経路があり、どちらもこの整形を共有する。
+//
+// 整形の規則 (src は処理レートへリサンプリング済みの 1 チャンネル):
+//   - 先頭に preDelaySamples の無音を置く
+//   - src の先頭 keepSamples だけを使う (0 = 全長)。末尾 fadeSamples に raised-cosine のフェードアウトを掛ける
+//   - dst の長さを超える分は捨てる (dst への加算のみ。dst の既存内容は保持する)
+//
+// Loader Thread / Message Thread 専用 (Audio Thread からは使わない)。
+// JUCE 非依存 (tests/IrBusShapingTests.cpp から単体で検証する)。
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace convo {
+
+struct IrBusShape
+{
+    int preDelaySamples = 0;
+    int keepSamples = 0;     // 0 = src 全長
+    int fadeSamples = 0;     // 使う区間の末尾に掛けるフェードアウト長
+};
+
+// これ以下のゲイン (dB) は 0 (ミュート) として扱う
+inline constexpr double kIrBusMuteDb = -96.0;
+
+[[nodiscard]] inline double irBusGainFromDb(double gainDb) noexcept
+{
+    return (gainDb <= kIrBusMuteDb) ? 0.0 : std::pow(10.0, gainDb / 20.0);
+}
+
+// ms / 秒の設定値をサンプル数へ換算する。負値は 0、fade は使う区間の長さで頭打ち (keep=0 のときは src 長が決まってから)
+[[nodiscard]] inline IrBusShape makeIrBusShape(double preDelayMs, double tailSec, double fadeMs, double sampleRate) noexcept
+{
+    IrBusShape shape;
+    if (!(sampleRate > 0.0))
+        return shape;
+    shape.preDelaySamples = static_cast<int>(std::lround(std::max(0.0, preDelayMs) * 1.0e-3 * sampleRate));
+    shape.keepSamples     = static_cast<int>(std::lround(std::max(0.0, tailSec) * sampleRate));
+    shape.fadeSamples     = static_cast<int>(std::lround(std::max(0.0, fadeMs) * 1.0e-3 * sampleRate));
+    if (shape.keepSamples > 0)
+        shape.fadeSamples = std::min(shape.fadeSamples, shape.keepSamples);
+    return shape;
+}
+
+// src のうち実際に使うサンプル数
+[[nodiscard]] inline int irBusKeptLength(const IrBusShape& shape, int srcLength) noexcept
+{
+    const int length = std::max(0, srcLength);
+    return (shape.keepSamples > 0) ? std::min(shape.keepSamples, length) : length;
+}
+
+// 整形後の長さ (pre-delay を含む)。使うサンプルがなければ 0
+[[nodiscard]] inline int irBusShapedLength(const IrBusShape& shape, int srcLength) noexcept
+{
+    const int kept = irBusKeptLength(shape, srcLength);
+    return (kept > 0) ? std::max(0, shape.preDelaySamples) + kept : 0;
+}
+
+// dst[preDelay + n] += gain · w(n) · src[n]  (n < kept、dst の範囲内のみ)
+inline void accumulateIrBus(double* dst, int dstLength, const double* src, int srcLength,
+                            const IrBusShape& shape, double gain) noexcept
+{
+    if (dst == nullptr || src == nullptr || dstLength <= 0 || gain == 0.0)
+        return;
+
+    const int kept = irBusKeptLength(shape, srcLength);
+    const int preDelay = std::max(0, shape.preDelaySamples);
+    if (kept <= 0 || preDelay >= dstLength)
+        return;
+
+    const int count = std::min(kept, dstLength - preDelay);
+    const int fade = std::clamp(shape.fadeSamples, 0, kept);
+    const int fadeStart = kept - fade;
+    double* out = dst + preDelay;
+
+    const int plain = std::min(count, fadeStart);
+    for (int n = 0; n < plain; ++n)
+        out[n] += gain * src[n];
+
+    // (0, 1) を単調に下る raised-cosine。端点 1 / 0 を含めないので fade=1 でも半分で残る
+    constexpr double kPi = 3.14159265358979323846;
+    for (int n = plain; n < count; ++n)
+    {
+        const double t = static_cast<double>(n - fadeStart + 1) / static_cast<double>(fade + 1);
+        out[n] += gain * 0.5 * (1.0 + std::cos(kPi * t)) * src[n];
+    }
+}
+
+} // namespace convo
@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <immintrin.h>
 #include "DspNumericPolicy.h"
+#include "dsp/DitherNoisePool.h"
+#include "dsp/StereoLaneNoiseShaper.h"
 
 #if defined(_MSC_VER)
 #pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
@@ -70,6 +72,12 @@ public:
         return coeffs.data();
     }
 
+    // ★ DSPCore 所有の共用ディザプール (dsp/DitherNoisePool.h)。nullptr なら自前の xoshiro256++ を使う
+    void setNoisePool(convo::dsp::DitherNoisePool* pool) noexcept
+    {
+        noisePool = pool;
+    }
+
     void processStereoBlock(double* dataL, double* dataR, int numSamples, double headroom) noexcept
     {
         if (dataL == nullptr || numSamples <= 0)
@@ -88,20 +96,44 @@ public:
         }
 
         const double* activeCoeffs = coeffs.data();
-        int i = 0;
+        // ディザは kReadChunk 単位でチャンネルごとにまとめて用意する
+        constexpr int kChunk = convo::dsp::DitherNoisePool::kReadChunk;
+        alignas(64) double tpdfL[kChunk];
+        alignas(64) double tpdfR[kChunk];
+
         if (dataR != nullptr)
         {
-            for (; i < numSamples; ++i)
+            // ★ L/R を __m128d の 2 レーンに載せて 1 本の格子再帰で回す (dsp/StereoLaneNoiseShaper.h)
+            convo::dsp::LatticeLaneQuantizer quantizer;
+            quantizer.scale = scale;
+            quantizer.invScale = invScale;
+            quantizer.maxValue = 1.0 - (1.0 / invScale);
+            quantizer.minQ = -invScale;
+            quantizer.maxQ = invScale - 1.0;
+            quantizer.errorLimit = 2.0 * scale;
+            for (int offset = 0; offset < numSamples; offset += kChunk)
             {
-                dataL[i] = processSample(0, dataL[i], states[0], activeCoeffs, headroom);
-                dataR[i] = processSample(1, dataR[i], states[1], activeCoeffs, headroom);
+                const int n = std::min(kChunk, numSamples - offset);
+                fillTpdf(0, tpdfL, n);
+                fillTpdf(1, tpdfR, n);
+                const double* tpdf[kNumChannels] = { tpdfL, tpdfR };
+                int tpdfIndex[kNumChannels] = { 0, 0 };
+                convo::dsp::processLatticeStereoLanes(activeCoeffs, states[0].data(), states[1].data(),
+                                                      dataL + offset, dataR + offset, n, headroom, quantizer,
+                                                      [&](int channel) noexcept
+                                                      {
+                                                          return tpdf[channel][tpdfIndex[channel]++] * scale;
+                                                      });
             }
         }
         else
         {
-            for (; i < numSamples; ++i)
+            for (int offset = 0; offset < numSamples; offset += kChunk)
             {
-                dataL[i] = processSample(0, dataL[i], states[0], activeCoeffs, headroom);
+                const int n = std::min(kChunk, numSamples - offset);
+                fillTpdf(0, tpdfL, n);
+                for (int i = 0; i < n; ++i)
+                    dataL[offset + i] = processSample(dataL[offset + i], states[0], activeCoeffs, headroom, tpdfL[i]);
             }
         }
 
@@ -200,7 +232,18 @@ private:
         return (xoshiro256plusplus(state) >> 11) * (1.0 / 9007199254740992.0);
     }
 
-    inline double quantize(double value, Xoshiro256State& rng) const noexcept
+    // 単位 TPDF (u1 + u2 - 1) を count 個。noisePool が無ければ自前の乱数をチャンネル順に消費する
+    inline void fillTpdf(int channel, double* dest, int count) noexcept
+    {
+        convo::dsp::fillUnitTpdf(noisePool, channel, dest, count, [this, channel]() noexcept
+        {
+            const double u1 = uniform(rngState[channel]);
+            const double u2 = uniform(rngState[channel]);
+            return u1 + u2 - 1.0;
+        });
+    }
+
+    inline double quantize(double value, double tpdf) const noexcept
     {
         const double minValue = -1.0;
         const double maxValue = 1.0 - (1.0 / invScale);
@@ -212,9 +255,7 @@ private:
             value = maxValue;
 
         // TPDF dither
-        const double u1 = uniform(rng);
-        const double u2 = uniform(rng);
-        value += (u1 + u2 - 1.0) * scale;
+        value += tpdf * scale;
 
         __m128d rounded = _mm_set_sd(value * invScale);
         rounded = _mm_round_sd(rounded, rounded, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
@@ -275,15 +316,15 @@ private:
         }
     }
 
-    inline double processSample(int channel,
-                                double inputSample,
+    inline double processSample(double inputSample,
                                 std::array<double, kOrder>& channelState,
                                 const double* activeCoeffs,
-                                double headroom) noexcept
+                                double headroom,
+                                double tpdf) noexcept
     {
         const double feedback = computeFeedback(channelState, activeCoeffs);
         const double shapedInputClean = (inputSample * headroom) + feedback;
-        const double quantized = quantize(shapedInputClean, rngState[channel]);
+        const double quantized = quantize(shapedInputClean, tpdf);
         const double error = quantized - shapedInputClean;
         // ★ NaN 伝播防止: error が NaN の場合、clampedError も NaN になるため
         //   advanceState に渡す前にサニタイズが必要
@@ -298,6 +339,7 @@ private:
         {{ 0x123456789ABCDEF0ULL, 0xFEDCBA9876543210ULL, 0x0123456789ABCDEFULL, 0xEFCDAB8967452301ULL }},
         {{ 0x89ABCDEF01234567ULL, 0x76543210FEDCBA98ULL, 0xABCDEF0123456789ULL, 0x67452301EFCDAB89ULL }}
     };
+    convo::dsp::DitherNoisePool* noisePool = nullptr;
     int currentBitDepth = 0;
     double scale = 1.0;
     double invScale = 1.0;
@@ -5,38 +5,49 @@
 #include <cstdint>
 
 #include "audioengine/AtomicAccess.h"
+#include "audioengine/MemoryLedger.h"
 
 #ifdef _MSC_VER
 #pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 #pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 #endif
 
+// ★ 出力タップ用 SPSC FIFO (Audio Thread → 解析スレッド)。push 時に double → float へ変換する。
+//   - MonoDownmix (analyzerFifo): Analyzer は L/R の平均しか見ないので、変換とモノラル化を 1 パスで行い
+//     float 1 チャンネルだけを保持する (旧: float 2 チャンネル保持 + pop 時に平均)
+//   - Stereo (meteringFifo): LUFS / TruePeak はチャンネル別に測るので L/R を分けて保持する。
+//     モノラル入力は R にも L を写す (メーターからは両耳で同じ信号を聴く扱いになる)
 class LockFreeAudioRingBuffer
 {
 public:
-    void prepare(int channels, int size)
+    enum class Layout { MonoDownmix, Stereo };
+
+    explicit LockFreeAudioRingBuffer(Layout bufferLayout = Layout::MonoDownmix) noexcept
+        : layout(bufferLayout) {}
+
+    void prepare(int size)
     {
-        jassert(channels > 0);
         jassert(size > 0);
 
-        storage.setSize(channels, size, false, true, true);
+        const int numStorageChannels = (layout == Layout::Stereo) ? 2 : 1;
+        storage.setSize(numStorageChannels, size, false, true, true);
         storage.clear();
         capacity = size;
-        numChannels = channels;
-        convo::publishAtomic(writeIndex, 0, std::memory_order_release); // release: push/popMixToMono の acquire と HB (初期化後の初回観測を保証)
-        convo::publishAtomic(readIndex, 0, std::memory_order_release);  // release: push/popMixToMono の acquire と HB (初期化後の初回観測を保証)
+        memoryCharge.set(static_cast<uint64_t>(size) * static_cast<uint64_t>(numStorageChannels) * sizeof(float));
+        convo::publishAtomic(writeIndex, 0, std::memory_order_release); // release: push/pop の acquire と HB (初期化後の初回観測を保証)
+        convo::publishAtomic(readIndex, 0, std::memory_order_release);  // release: push/pop の acquire と HB (初期化後の初回観測を保証)
     }
 
     void reset() noexcept
     {
-        convo::publishAtomic(readIndex, 0, std::memory_order_release);  // release: push/popMixToMono の acquire と HB (リセット後の初回観測を保証)
-        convo::publishAtomic(writeIndex, 0, std::memory_order_release); // release: push/popMixToMono の acquire と HB (リセット後の初回観測を保証)
+        convo::publishAtomic(readIndex, 0, std::memory_order_release);  // release: push/pop の acquire と HB (リセット後の初回観測を保証)
+        convo::publishAtomic(writeIndex, 0, std::memory_order_release); // release: push/pop の acquire と HB (リセット後の初回観測を保証)
     }
 
     int getAvailableSamples() const noexcept
     {
         const auto written = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: push の writeIndex release と HB
-        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);     // acquire: popMixToMono/skip の readIndex release と HB
+        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);     // acquire: pop/skip の readIndex release と HB
         return static_cast<int>(written - read);
     }
 
@@ -47,16 +58,16 @@ public:
 
     void push(const juce::dsp::AudioBlock<const double>& block) noexcept
     {
-        if (capacity <= 0 || numChannels <= 0)
+        if (capacity <= 0)
             return;
 
         const int samplesToWriteRequested = static_cast<int>(block.getNumSamples());
-        const int channelsToWrite = juce::jmin(numChannels, static_cast<int>(block.getNumChannels()));
-        if (samplesToWriteRequested <= 0 || channelsToWrite <= 0)
+        const int numChannels = static_cast<int>(block.getNumChannels());
+        if (samplesToWriteRequested <= 0 || numChannels <= 0)
             return;
 
         const auto write = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: 前回 push の writeIndex release と HB (ラップアラウンド安全確認)
-        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);   // acquire: popMixToMono/skip の readIndex release と HB (空きスロット数計算)
+        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);   // acquire: pop/skip の readIndex release と HB (空きスロット数計算)
         const int free = capacity - static_cast<int>(write - read);
         if (free <= 0)
             return;
@@ -66,40 +77,40 @@ public:
         const int firstChunk = juce::jmin(samplesToWrite, capacity - start);
         const int secondChunk = samplesToWrite - firstChunk;
 
-        for (int channel = 0; channel < channelsToWrite; ++channel)
-        {
-            float* destination = storage.getWritePointer(channel);
-            const double* source = block.getChannelPointer(static_cast<size_t>(channel));
-
-            for (int i = 0; i < firstChunk; ++i)
-                destination[start + i] = static_cast<float>(source[i]);
+        const double* left = block.getChannelPointer(0);
+        const double* right = (numChannels > 1) ? block.getChannelPointer(1) : nullptr;
 
-            for (int i = 0; i < secondChunk; ++i)
-                destination[i] = static_cast<float>(source[firstChunk + i]);
+        if (layout == Layout::Stereo)
+        {
+            const double* sources[2] = { left, (right != nullptr) ? right : left };
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                float* destination = storage.getWritePointer(ch);
+                convertChunk(sources[ch], destination + start, firstChunk);
+                if (secondChunk > 0)
+                    convertChunk(sources[ch] + firstChunk, destination, secondChunk);
+            }
         }
-
-        if (channelsToWrite == 1 && numChannels > 1)
+        else
         {
-            float* destination = storage.getWritePointer(1);
-            const double* source = block.getChannelPointer(0);
-
-            for (int i = 0; i < firstChunk; ++i)
-                destination[start + i] = static_cast<float>(source[i]);
-
-            for (int i = 0; i < secondChunk; ++i)
-                destination[i] = static_cast<float>(source[firstChunk + i]);
+            float* destination = storage.getWritePointer(0);
+            downmixChunk(left, right, destination + start, firstChunk);
+            if (secondChunk > 0)
+                downmixChunk(left + firstChunk, right != nullptr ? right + firstChunk : nullptr, destination, secondChunk);
         }
 
-        convo::publishAtomic(writeIndex, write + static_cast<uint64_t>(samplesToWrite), std::memory_order_release); // release: popMixToMono/getAvailableSamples の acquire と HB し書き込み完了を公開
+        convo::publishAtomic(writeIndex, write + static_cast<uint64_t>(samplesToWrite), std::memory_order_release); // release: pop/getAvailableSamples の acquire と HB し書き込み完了を公開
     }
 
-    int popMixToMono(float* destination, int requestedSamples) noexcept
+    // MonoDownmix 用
+    int pop(float* destination, int requestedSamples) noexcept
     {
-        if (destination == nullptr || requestedSamples <= 0 || capacity <= 0 || numChannels <= 0)
+        jassert(layout == Layout::MonoDownmix);
+        if (destination == nullptr || requestedSamples <= 0 || capacity <= 0)
             return 0;
 
         const auto write = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: push の writeIndex release と HB し書き込み済みサンプル数を観測
-        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);   // acquire: 前回 popMixToMono/skip の readIndex release と HB
+        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);   // acquire: 前回 pop/skip の readIndex release と HB
         const int available = static_cast<int>(write - read);
         if (available <= 0)
             return 0;
@@ -109,24 +120,90 @@ public:
         const int firstChunk = juce::jmin(samplesToRead, capacity - start);
         const int secondChunk = samplesToRead - firstChunk;
 
-        const float* left = storage.getReadPointer(0);
-        const float* right = (numChannels > 1) ? storage.getReadPointer(1) : left;
-
-        mixChunk(left + start, right + start, destination, firstChunk);
+        const float* source = storage.getReadPointer(0);
+        juce::FloatVectorOperations::copy(destination, source + start, firstChunk);
         if (secondChunk > 0)
-            mixChunk(left, right, destination + firstChunk, secondChunk);
+            juce::FloatVectorOperations::copy(destination + firstChunk, source, secondChunk);
 
         convo::publishAtomic(readIndex, read + static_cast<uint64_t>(samplesToRead), std::memory_order_release); // release: push の readIndex acquire と HB し読み取り済み位置を公開
         return samplesToRead;
     }
 
+    // Stereo 用。読めた分だけ left / right の両方へ書き、そのサンプル数を返す
+    int pop(float* left, float* right, int requestedSamples) noexcept
+    {
+        jassert(layout == Layout::Stereo);
+        if (left == nullptr || right == nullptr || requestedSamples <= 0 || capacity <= 0)
+            return 0;
+
+        const auto write = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: push の writeIndex release と HB し両チャンネルの書き込みを観測
+        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);   // acquire: 前回 pop/skip の readIndex release と HB
+        const int available = static_cast<int>(write - read);
+        if (available <= 0)
+            return 0;
+
+        const int samplesToRead = juce::jmin(requestedSamples, available);
+        const int start = static_cast<int>(read % static_cast<uint64_t>(capacity));
+        const int firstChunk = juce::jmin(samplesToRead, capacity - start);
+        const int secondChunk = samplesToRead - firstChunk;
+
+        float* destinations[2] = { left, right };
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float* source = storage.getReadPointer(ch);
+            juce::FloatVectorOperations::copy(destinations[ch], source + start, firstChunk);
+            if (secondChunk > 0)
+                juce::FloatVectorOperations::copy(destinations[ch] + firstChunk, source, secondChunk);
+        }
+
+        convo::publishAtomic(readIndex, read + static_cast<uint64_t>(samplesToRead), std::memory_order_release); // release: push の readIndex acquire と HB し両チャンネルの読み終わりを公開
+        return samplesToRead;
+    }
+
+    // ★ 一括読み出し (単一リーダ): 折り返し位置までの連続区間を storage 上で直接読ませる。
+    //   pop のように float バッファへコピーせず、読み終えた分を commitRead の 1 回の release で解放する。
+    //   MonoDownmix は channels[1] == channels[0]
+    struct ReadSpan
+    {
+        const float* channels[2] = { nullptr, nullptr };
+        int numSamples = 0;
+    };
+
+    [[nodiscard]] ReadSpan peekReadable(int maxSamples) const noexcept
+    {
+        ReadSpan span;
+        if (maxSamples <= 0 || capacity <= 0)
+            return span;
+
+        const auto write = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: push の writeIndex release と HB し書き込み済み区間を観測
+        const auto read = convo::consumeAtomic(readIndex, std::memory_order_relaxed);   // relaxed: readIndex の書き手はこのリーダ自身
+        const int available = static_cast<int>(write - read);
+        if (available <= 0)
+            return span;
+
+        const int start = static_cast<int>(read % static_cast<uint64_t>(capacity));
+        span.numSamples = juce::jmin(maxSamples, available, capacity - start);
+        span.channels[0] = storage.getReadPointer(0) + start;
+        span.channels[1] = (layout == Layout::Stereo) ? storage.getReadPointer(1) + start : span.channels[0];
+        return span;
+    }
+
+    void commitRead(int samples) noexcept
+    {
+        jassert(samples >= 0 && samples <= getAvailableSamples());
+        if (samples <= 0)
+            return;
+        const auto read = convo::consumeAtomic(readIndex, std::memory_order_relaxed); // relaxed: 書き手はこのリーダ自身
+        convo::publishAtomic(readIndex, read + static_cast<uint64_t>(samples), std::memory_order_release); // release: 読み終えた区間を push の readIndex acquire と HB し上書きを許可
+    }
+
     void skip(int requestedSamples) noexcept
     {
         if (requestedSamples <= 0 || capacity <= 0)
             return;
 
         const auto write = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: push の writeIndex release と HB し利用可能サンプル数を観測
-        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);   // acquire: 前回 popMixToMono/skip の readIndex release と HB
+        const auto read = convo::consumeAtomic(readIndex, std::memory_order_acquire);   // acquire: 前回 pop/skip の readIndex release と HB
         const int available = static_cast<int>(write - read);
         if (available <= 0)
             return;
@@ -136,24 +213,29 @@ public:
     }
 
 private:
-    static void mixChunk(const float* left, const float* right, float* destination, int samples) noexcept
+    // right == nullptr ならモノラル入力をそのまま変換する
+    static void downmixChunk(const double* left, const double* right, float* destination, int samples) noexcept
     {
-        if (samples <= 0)
-            return;
-
-        if (left == right)
+        if (right == nullptr)
         {
-            juce::FloatVectorOperations::copy(destination, left, samples);
+            convertChunk(left, destination, samples);
             return;
         }
 
         for (int i = 0; i < samples; ++i)
-            destination[i] = 0.5f * (left[i] + right[i]);
+            destination[i] = static_cast<float>(0.5 * (left[i] + right[i]));
+    }
+
+    static void convertChunk(const double* source, float* destination, int samples) noexcept
+    {
+        for (int i = 0; i < samples; ++i)
+            destination[i] = static_cast<float>(source[i]);
     }
 
+    const Layout layout;
     juce::AudioBuffer<float> storage;
     int capacity = 0;
-    int numChannels = 0;
+    convo::MemoryCharge memoryCharge { convo::MemoryCategory::AnalyzerFifo };
 
     alignas(64) std::atomic<uint64_t> writeIndex { 0 };
     alignas(64) std::atomic<uint64_t> readIndex { 0 };
@@ -1,6 +1,7 @@
 // LockFreeRingBuffer.h
 // SPSCロックフリーリングバッファ（RT安全・64byteアライン）
 #pragma once
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -73,6 +74,76 @@ public:
         convo::publishAtomic(readIndex, r + 1, std::memory_order_release);
         return true;
     }
+
+    // ── 一括 API (SPSC) ─────────────────────────────────────────
+    // 折り返し位置までの連続領域をその場で読み書きし、index の公開を 1 回の release にまとめる。
+    // reserveWrite / commitWrite は Producer、peekRead / commitRead / drain は Consumer だけが呼ぶ。
+
+    // 空き領域の先頭を返し、連続して書ける要素数 (<= maxCount、折り返しで打ち切り) を count に入れる。
+    // 満杯なら nullptr。埋めた分だけ commitWrite で公開する (予約だけなら何もしなくてよい)
+    T* reserveWrite(size_t maxCount, size_t& count) noexcept {
+        const size_t w = convo::consumeAtomic(writeIndex, std::memory_order_relaxed); // relaxed: writeIndex の書き手は Producer 自身
+        const size_t r = convo::consumeAtomic(readIndex, std::memory_order_acquire);  // acquire: commitRead/pop の release と HB (解放済みスロットだけを再利用)
+        const size_t free = Capacity - (w - r);
+        const size_t toWrap = Capacity - (w & MASK);
+        count = std::min(std::min(maxCount, free), toWrap);
+        return (count > 0) ? &buffer[w & MASK] : nullptr;
+    }
+    void commitWrite(size_t count) noexcept {
+        assert(count <= Capacity - size());
+        const size_t w = convo::consumeAtomic(writeIndex, std::memory_order_relaxed); // relaxed: 書き手は Producer 自身
+        convo::publishAtomic(writeIndex, w + count, std::memory_order_release); // release: 埋めた count 要素を peekRead/pop の acquire と HB
+    }
+    // items を折り返しをまたいで最大 count 要素書き込み、書けた数を返す。公開は 1 回
+    size_t pushBulk(const T* items, size_t count) noexcept {
+        size_t pushed = 0;
+        const size_t w = convo::consumeAtomic(writeIndex, std::memory_order_relaxed); // relaxed: 書き手は Producer 自身
+        const size_t r = convo::consumeAtomic(readIndex, std::memory_order_acquire);  // acquire: commitRead/pop の release と HB
+        const size_t toWrite = std::min(count, Capacity - (w - r));
+        while (pushed < toWrite) {
+            const size_t at = (w + pushed) & MASK;
+            const size_t chunk = std::min(toWrite - pushed, Capacity - at);
+            std::memcpy(static_cast<void*>(&buffer[at]), items + pushed, chunk * sizeof(T));
+            pushed += chunk;
+        }
+        if (pushed > 0)
+            convo::publishAtomic(writeIndex, w + pushed, std::memory_order_release); // release: 書き込んだ全要素を Consumer の acquire と HB
+        return pushed;
+    }
+
+    // 読める領域の先頭を返し、連続して読める要素数 (<= maxCount、折り返しで打ち切り) を count に入れる。
+    // 空なら nullptr。読み終えた分を commitRead で解放するまで Producer はそのスロットを上書きしない
+    const T* peekRead(size_t maxCount, size_t& count) noexcept {
+        const size_t r = convo::consumeAtomic(readIndex, std::memory_order_relaxed);  // relaxed: readIndex の書き手は Consumer 自身
+        const size_t w = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: commitWrite/push の release と HB (スロット内容が見える)
+        const size_t toWrap = Capacity - (r & MASK);
+        count = std::min(std::min(maxCount, w - r), toWrap);
+        return (count > 0) ? &buffer[r & MASK] : nullptr;
+    }
+    void commitRead(size_t count) noexcept {
+        assert(count <= size());
+        const size_t r = convo::consumeAtomic(readIndex, std::memory_order_relaxed); // relaxed: 書き手は Consumer 自身
+        convo::publishAtomic(readIndex, r + count, std::memory_order_release); // release: 読み終えたスロットを reserveWrite/push の acquire と HB
+    }
+    // 呼び出し時点で溜まっている最大 maxCount 要素を、連続区間ごとに consumer(const T* items, size_t count) へ
+    // その場で渡し (最大 2 回)、まとめて 1 回の release で解放する。渡した要素数を返す
+    template<typename Consumer>
+    size_t drain(Consumer&& consumer, size_t maxCount = Capacity) noexcept {
+        const size_t r = convo::consumeAtomic(readIndex, std::memory_order_relaxed);  // relaxed: 書き手は Consumer 自身
+        const size_t w = convo::consumeAtomic(writeIndex, std::memory_order_acquire); // acquire: commitWrite/push の release と HB
+        const size_t total = std::min(maxCount, w - r);
+        size_t consumed = 0;
+        while (consumed < total) {
+            const size_t at = (r + consumed) & MASK;
+            const size_t chunk = std::min(total - consumed, Capacity - at);
+            consumer(static_cast<const T*>(&buffer[at]), chunk);
+            consumed += chunk;
+        }
+        if (consumed > 0)
+            convo::publishAtomic(readIndex, r + consumed, std::memory_order_release); // release: 読み終えた全スロットを Producer の acquire と HB
+        return consumed;
+    }
+
     size_t size() const noexcept {
         // acquire × 2: push/pop の release と HB し、一貫した（ベストエフォート）占有数を算出。
         size_t w = convo::consumeAtomic(writeIndex, std::memory_order_acquire);
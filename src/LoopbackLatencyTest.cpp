@@ -0,0 +1,449 @@
+#include "LoopbackLatencyTest.h"
+
+#include "AudioEngine.h"
+#include "audioengine/AtomicAccess.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+LoopbackLatencyTest::LoopbackLatencyTest(AudioEngine& engineRef,
+                                         juce::AudioDeviceManager& deviceManagerRef,
+                                         Options testOptions,
+                                         FinishedCallback finishedCallback)
+    : engine(engineRef),
+      deviceManager(deviceManagerRef),
+      options(std::move(testOptions)),
+      onFinished(std::move(finishedCallback))
+{
+    options.repeats = juce::jlimit(1, 16, options.repeats);
+    options.mlsOrder = juce::jlimit(convo::kMinMlsOrder, convo::kMaxMlsOrder, options.mlsOrder);
+}
+
+LoopbackLatencyTest::~LoopbackLatencyTest()
+{
+    stopTimer();
+    deviceManager.removeAudioCallback(this);
+}
+
+bool LoopbackLatencyTest::start()
+{
+    if (deviceManager.getCurrentAudioDevice() == nullptr)
+    {
+        juce::Logger::writeToLog("[LatencyTest] No audio device");
+        return false;
+    }
+    if (options.inputChannel < 0)
+        return false;
+
+    // 測る入力チャンネルが閉じていれば開く (終了時に元の設定へ戻す)
+    deviceManager.getAudioDeviceSetup(originalSetup);
+    if (!originalSetup.inputChannels[options.inputChannel])
+    {
+        auto setup = originalSetup;
+        setup.useDefaultInputChannels = false;
+        setup.inputChannels.setBit(options.inputChannel);
+        if (const auto error = deviceManager.setAudioDeviceSetup(setup, false); error.isNotEmpty())
+        {
+            juce::Logger::writeToLog("[LatencyTest] Cannot open input channel " + juce::String(options.inputChannel) + ": " + error);
+            return false;
+        }
+        setupChanged = true;
+    }
+
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr || !device->getActiveInputChannels()[options.inputChannel])
+    {
+        juce::Logger::writeToLog("[LatencyTest] Input channel " + juce::String(options.inputChannel) + " is not available");
+        if (setupChanged)
+            deviceManager.setAudioDeviceSetup(originalSetup, false);
+        return false;
+    }
+
+    result.sampleRateHz = device->getCurrentSampleRate();
+    result.bufferSize = device->getCurrentBufferSizeSamples();
+    maxDelaySamples = static_cast<size_t>(options.maxDelaySeconds * result.sampleRateHz);
+    probe = convo::makeMaximumLengthSequence(options.mlsOrder);
+    capture.assign(probe.size() + maxDelaySamples, 0.0f);
+
+    juce::Logger::writeToLog("[LatencyTest] Start: device=" + device->getName()
+                             + " sr=" + juce::String(result.sampleRateHz)
+                             + " buffer=" + juce::String(result.bufferSize)
+                             + " inputChannel=" + juce::String(options.inputChannel)
+                             + " mlsLength=" + juce::String(static_cast<int>(probe.size()))
+                             + " repeats=" + juce::String(options.repeats)
+                             + " sweep=" + juce::String(static_cast<int>(options.sweep)));
+
+    setMode(Mode::Silence);
+    deviceManager.addAudioCallback(this);
+    phase = Phase::Settling;
+    phaseStartMs = juce::Time::getMillisecondCounterHiRes();
+    startTimer(kTickMs);
+    return true;
+}
+
+//==============================================================================
+// Audio Thread
+//==============================================================================
+void LoopbackLatencyTest::audioDeviceIOCallbackWithContext(const float* const* inputChannelData,
+                                                           int numInputChannels,
+                                                           float* const* outputChannelData,
+                                                           int numOutputChannels,
+                                                           int numSamples,
+                                                           const juce::AudioIODeviceCallbackContext&)
+{
+    // acquire: setMode の release と HB (その前に進めた requestedPass も見える)
+    const auto currentMode = static_cast<Mode>(convo::consumeAtomic(mode, std::memory_order_acquire));
+    const uint32_t pass = convo::consumeAtomic(requestedPass, std::memory_order_relaxed);
+    if (pass != servedPass)
+    {
+        servedPass = pass;
+        passPosition = 0;
+    }
+
+    const bool probing = currentMode == Mode::ProbeDirect || currentMode == Mode::ProbeEngine;
+    const int frames = juce::jmin(numSamples, scratch.getNumSamples());
+    auto* left = scratch.getWritePointer(0);
+    auto* right = scratch.getWritePointer(1);
+    for (int i = 0; i < frames; ++i)
+    {
+        double value = 0.0;
+        if (probing)
+        {
+            const size_t position = passPosition + static_cast<size_t>(i);
+            value = position < probe.size() ? kProbeLevel * probe[position] : 0.0;
+        }
+        else if (currentMode == Mode::Noise)
+        {
+            noiseState ^= noiseState << 13;
+            noiseState ^= noiseState >> 17;
+            noiseState ^= noiseState << 5;
+            value = kNoiseLevel * (static_cast<double>(noiseState) / 2147483648.0 - 1.0);
+        }
+        left[i] = value;
+        right[i] = value;
+    }
+
+    if (currentMode != Mode::ProbeDirect && frames > 0)
+    {
+        // 参照用の AudioBuffer (チャンネル表は内部の固定領域なので確保しない)
+        juce::AudioBuffer<double> block(scratch.getArrayOfWritePointers(), 2, frames);
+        engine.processBlockDouble(block);
+    }
+
+    for (int ch = 0; ch < numOutputChannels; ++ch)
+    {
+        auto* out = outputChannelData[ch];
+        if (out == nullptr)
+            continue;
+        int written = 0;
+        if (ch < 2)
+        {
+            const auto* source = scratch.getReadPointer(ch);
+            for (; written < frames; ++written)
+                out[written] = static_cast<float>(source[written]);
+        }
+        std::fill(out + written, out + numSamples, 0.0f);
+    }
+
+    if (!probing)
+        return;
+
+    if (passPosition < capture.size())
+    {
+        const size_t count = std::min(static_cast<size_t>(numSamples), capture.size() - passPosition);
+        const float* in = (activeInputIndex >= 0 && activeInputIndex < numInputChannels) ? inputChannelData[activeInputIndex] : nullptr;
+        if (in != nullptr)
+            std::copy(in, in + count, capture.begin() + static_cast<std::ptrdiff_t>(passPosition));
+        else
+            std::fill_n(capture.begin() + static_cast<std::ptrdiff_t>(passPosition), count, 0.0f);
+    }
+    passPosition += static_cast<size_t>(numSamples);
+
+    const uint64_t recorded = std::min(passPosition, capture.size());
+    // release: capture への書き込みを timerCallback の acquire へ渡す
+    convo::publishAtomic(capturedProgress, (static_cast<uint64_t>(pass) << 32) | recorded, std::memory_order_release);
+}
+
+void LoopbackLatencyTest::audioDeviceAboutToStart(juce::AudioIODevice* device)
+{
+    const int bufferSize = device->getCurrentBufferSizeSamples();
+    scratch.setSize(2, juce::jmax(1, bufferSize), false, true, false);
+
+    // inputChannelData には開いているチャンネルだけが詰めて並ぶ
+    const auto activeInputs = device->getActiveInputChannels();
+    activeInputIndex = -1;
+    if (activeInputs[options.inputChannel])
+    {
+        activeInputIndex = 0;
+        for (int ch = 0; ch < options.inputChannel; ++ch)
+            activeInputIndex += activeInputs[ch] ? 1 : 0;
+    }
+    passPosition = 0;
+
+    engine.prepareToPlay(bufferSize, device->getCurrentSampleRate());
+}
+
+void LoopbackLatencyTest::audioDeviceStopped()
+{
+    if (engine.isEnginePrepared())
+        engine.releaseResources();
+}
+
+//==============================================================================
+// Message Thread
+//==============================================================================
+void LoopbackLatencyTest::setMode(Mode newMode) noexcept
+{
+    // release: 先に進めた requestedPass と確保済みの capture を Audio Thread の acquire へ渡す
+    convo::publishAtomic(mode, static_cast<int>(newMode), std::memory_order_release);
+}
+
+double LoopbackLatencyTest::elapsedSeconds() const noexcept
+{
+    return (juce::Time::getMillisecondCounterHiRes() - phaseStartMs) / 1000.0;
+}
+
+void LoopbackLatencyTest::timerCallback()
+{
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    switch (phase)
+    {
+        case Phase::Settling:
+            if (engine.isRuntimeSettled())
+            {
+                if (settledSinceMs < 0.0)
+                    settledSinceMs = nowMs;
+                if ((nowMs - settledSinceMs) / 1000.0 >= kSettleHoldSeconds)
+                {
+                    phase = Phase::Gap;
+                    phaseStartMs = nowMs;
+                }
+            }
+            else
+            {
+                settledSinceMs = -1.0;
+            }
+            if (phase == Phase::Settling && elapsedSeconds() > options.settleTimeoutSeconds)
+                finish("runtime did not settle within " + juce::String(options.settleTimeoutSeconds, 1) + " s");
+            break;
+
+        case Phase::Gap:
+            if (elapsedSeconds() >= kGapSeconds)
+                beginCapture();
+            break;
+
+        case Phase::Capturing:
+        {
+            // acquire: Audio Thread の capture への書き込みと HB
+            const uint64_t progress = convo::consumeAtomic(capturedProgress, std::memory_order_acquire);
+            const uint32_t pass = convo::consumeAtomic(requestedPass, std::memory_order_relaxed);
+            if (static_cast<uint32_t>(progress >> 32) == pass && (progress & 0xffffffffu) >= capture.size())
+                finishCapture();
+            else if (elapsedSeconds() > static_cast<double>(capture.size()) / result.sampleRateHz + 5.0)
+                finish("capture stalled (device stopped delivering callbacks)");
+            break;
+        }
+
+        case Phase::SweepOpening:
+        {
+            auto* device = deviceManager.getCurrentAudioDevice();
+            const int size = sweepSizes[sweepIndex];
+            if (device != nullptr && device->getCurrentBufferSizeSamples() == size
+                && engine.isRuntimeSettled() && elapsedSeconds() >= kSweepDiscardSeconds)
+            {
+                engine.collectCallbackTiming(sweepBefore);
+                phase = Phase::SweepDwelling;
+                phaseStartMs = nowMs;
+            }
+            else if (elapsedSeconds() > kSweepOpenTimeoutSeconds)
+            {
+                juce::Logger::writeToLog("[LatencyTest] Sweep buffer=" + juce::String(size) + " did not open / settle");
+                convo::BufferSweepStep failed;
+                failed.bufferSize = size;
+                result.sweepSteps.push_back(failed);
+                ++sweepIndex;
+                beginSweepStep();
+            }
+            break;
+        }
+
+        case Phase::SweepDwelling:
+            if (elapsedSeconds() >= options.sweepSecondsPerStep)
+                finishSweepStep();
+            break;
+
+        case Phase::Idle:
+        case Phase::Done:
+            break;
+    }
+}
+
+void LoopbackLatencyTest::beginCapture()
+{
+    // Audio Thread は mode を acquire してから requestedPass を読むので、番号を先に進める
+    const uint32_t pass = convo::consumeAtomic(requestedPass, std::memory_order_relaxed) + 1;
+    convo::publishAtomic(requestedPass, pass, std::memory_order_relaxed);
+    setMode((captureIndex % 2) == 0 ? Mode::ProbeDirect : Mode::ProbeEngine);
+    phase = Phase::Capturing;
+    phaseStartMs = juce::Time::getMillisecondCounterHiRes();
+}
+
+void LoopbackLatencyTest::finishCapture()
+{
+    setMode(Mode::Silence);
+
+    const bool direct = (captureIndex % 2) == 0;
+    const auto estimate = convo::estimateLoopbackDelay(probe, capture.data(), capture.size(), maxDelaySamples);
+    (direct ? directEstimates : engineEstimates).push_back(estimate);
+    juce::Logger::writeToLog("[LatencyTest] Pass " + juce::String(captureIndex / 2 + 1)
+                             + " path=" + (direct ? "direct" : "engine")
+                             + " delaySamples=" + juce::String(estimate.delaySamples)
+                             + " peakToMedian=" + juce::String(estimate.peakToMedian, 1)
+                             + " gain=" + juce::String(estimate.peakGain, 3)
+                             + " valid=" + juce::String(static_cast<int>(estimate.valid)));
+
+    ++captureIndex;
+    if (captureIndex < options.repeats * 2)
+    {
+        phase = Phase::Gap;
+        phaseStartMs = juce::Time::getMillisecondCounterHiRes();
+        return;
+    }
+
+    result.hardware = convo::summarizeLoopbackDelays(directEstimates);
+    result.total = convo::summarizeLoopbackDelays(engineEstimates);
+    result.predictedEngineLatencySamples = juce::jmax(0, engine.getTotalLatencySamples());
+    if (auto* device = deviceManager.getCurrentAudioDevice())
+        result.reportedDeviceLatencySamples = device->getInputLatencyInSamples() + device->getOutputLatencyInSamples();
+    result.succeeded = result.hardware.validCount > 0 && result.total.validCount > 0;
+
+    if (!result.succeeded)
+    {
+        finish("no correlation peak (is output looped back to input channel " + juce::String(options.inputChannel) + "?)");
+        return;
+    }
+    if (!options.sweep)
+    {
+        finish({});
+        return;
+    }
+
+    if (auto* device = deviceManager.getCurrentAudioDevice())
+        for (const int size : device->getAvailableBufferSizes())
+            if (size > 0 && size <= options.maxSweepBufferSize)
+                sweepSizes.push_back(size);
+    std::sort(sweepSizes.begin(), sweepSizes.end());
+    sweepIndex = 0;
+    beginSweepStep();
+}
+
+void LoopbackLatencyTest::beginSweepStep()
+{
+    while (sweepIndex < sweepSizes.size())
+    {
+        const int size = sweepSizes[sweepIndex];
+        setMode(Mode::Noise);
+
+        juce::AudioDeviceManager::AudioDeviceSetup setup;
+        deviceManager.getAudioDeviceSetup(setup);
+        setup.bufferSize = size;
+        setupChanged = true;
+        const auto error = deviceManager.setAudioDeviceSetup(setup, false);
+        if (error.isEmpty())
+        {
+            phase = Phase::SweepOpening;
+            phaseStartMs = juce::Time::getMillisecondCounterHiRes();
+            return;
+        }
+
+        juce::Logger::writeToLog("[LatencyTest] Sweep buffer=" + juce::String(size) + " rejected: " + error);
+        convo::BufferSweepStep failed;
+        failed.bufferSize = size;
+        result.sweepSteps.push_back(failed);
+        ++sweepIndex;
+    }
+
+    finish({});
+}
+
+void LoopbackLatencyTest::finishSweepStep()
+{
+    convo::CallbackTimingHistograms::Snapshot after;
+    engine.collectCallbackTiming(after);
+    convo::CallbackTimingStats window;
+    window.accumulate(after, sweepBefore);
+
+    const auto step = convo::judgeBufferSweepStep(sweepSizes[sweepIndex], window);
+    result.sweepSteps.push_back(step);
+    juce::Logger::writeToLog("[LatencyTest] Sweep buffer=" + juce::String(step.bufferSize)
+                             + " callbacks=" + juce::String(static_cast<juce::int64>(step.callbacks))
+                             + " glitches=" + juce::String(static_cast<juce::int64>(step.glitches))
+                             + " loadP999=" + juce::String(static_cast<int>(step.loadP999Permille)) + "permille"
+                             + " glitchFree=" + juce::String(static_cast<int>(step.glitchFree)));
+
+    if (step.glitchFree)
+    {
+        finish({});
+        return;
+    }
+    ++sweepIndex;
+    beginSweepStep();
+}
+
+void LoopbackLatencyTest::finish(const juce::String& error)
+{
+    stopTimer();
+    setMode(Mode::Silence);
+    phase = Phase::Done;
+
+    if (error.isNotEmpty())
+    {
+        result.succeeded = false;
+        result.error = error;
+    }
+    result.lowestGlitchFreeBufferSize = convo::lowestGlitchFreeBufferSize(result.sweepSteps);
+
+    // 外すと audioDeviceStopped が呼ばれてエンジンを解放する
+    deviceManager.removeAudioCallback(this);
+    if (setupChanged)
+    {
+        if (const auto restoreError = deviceManager.setAudioDeviceSetup(originalSetup, false); restoreError.isNotEmpty())
+            juce::Logger::writeToLog("[LatencyTest] Cannot restore the device setup: " + restoreError);
+        setupChanged = false;
+    }
+
+    reportResult();
+
+    // コールバックの中でこのオブジェクトが破棄されてもよいように、先に取り出しておく
+    const auto callback = onFinished;
+    const auto finalResult = result;
+    if (callback)
+        callback(finalResult);
+}
+
+void LoopbackLatencyTest::reportResult() const
+{
+    juce::String line = "[LatencyTest] Finished: succeeded=" + juce::String(static_cast<int>(result.succeeded))
+                      + " sr=" + juce::String(result.sampleRateHz)
+                      + " buffer=" + juce::String(result.bufferSize);
+    if (result.error.isNotEmpty())
+        line << " error=\"" << result.error << "\"";
+    if (result.succeeded)
+    {
+        line << " hardwareMeasured=" << result.hardware.medianSamples
+             << " (" << result.hardware.minSamples << ".." << result.hardware.maxSamples << ")"
+             << " hardwareReported=" << result.reportedDeviceLatencySamples
+             << " engineMeasured=" << result.measuredEngineLatencySamples()
+             << " enginePredicted=" << result.predictedEngineLatencySamples
+             << " totalMeasured=" << result.total.medianSamples
+             << " (" << result.total.minSamples << ".." << result.total.maxSamples << ")"
+             << " totalPredicted=" << (result.reportedDeviceLatencySamples + result.predictedEngineLatencySamples);
+    }
+    if (!result.sweepSteps.empty())
+        line << " lowestGlitchFreeBuffer=" << result.lowestGlitchFreeBufferSize;
+
+    juce::Logger::writeToLog(line);
+    std::fputs((line + "\n").toRawUTF8(), stdout);
+    std::fflush(stdout);
+}
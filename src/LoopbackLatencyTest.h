@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "LoopbackProbe.h"
+
+class AudioEngine;
+
+/**
+    LoopbackLatencyTest: 出力を入力へ物理的にループバックした状態で往復遅延と安定なバッファ長を実測する。
+
+    --cli-latency-test から起動する。MainWindow がデバイスから audioProcessorPlayer を外して
+    このオブジェクトをコールバックにし、Message Thread の timer (kTickMs) が手順を進める。
+
+    1. 無音を流して isRuntimeSettled() が kSettleHoldSeconds 続くまで待つ
+    2. MLS (LoopbackProbe.h) を「エンジンを通さずに」「エンジンを通して」の順で Options::repeats 回ずつ流し、
+       入力の録音との相互相関で往復遅延を測る。前者がハードウェア (ドライバ・変換器) の往復、
+       後者から前者を引いたものがエンジン分で、getTotalLatencySamples() (PDC に出している値) と比べる
+    3. Options::sweep なら、小さいバッファ長から順に開き直して -40 dBFS のノイズをエンジンに流し、
+       CallbackTimingStats の差分で glitch-free かを判定する (最初に通った長さで止める)
+    4. デバイス設定を元に戻し、Result を FinishedCallback へ渡す
+
+    - Audio Thread は mode / 測定番号を acquire で読み、録音済みのサンプル数を (測定番号, 数) の組で publish する。
+      録音バッファと MLS は測定の開始前に Message Thread が確保し、測定中は触らない
+    - 入力チャンネルが開いていなければ開いてから始める (終了時に戻す)
+    - ループバックが無い・信号が弱いと相関のピークが立たず、その測定は無効になる (Result::succeeded = false)
+*/
+class LoopbackLatencyTest : public juce::AudioIODeviceCallback,
+                            private juce::Timer
+{
+public:
+    struct Options
+    {
+        int inputChannel = 0;
+        int repeats = 3;
+        int mlsOrder = 15;                      // 2^15 - 1 サンプル (48 kHz で約 0.7 s)
+        double maxDelaySeconds = 1.0;           // これより長い往復は測らない
+        bool sweep = false;
+        double sweepSecondsPerStep = 10.0;
+        int maxSweepBufferSize = 4096;
+        double settleTimeoutSeconds = 60.0;     // IR 読み込みを含めて待つ上限
+    };
+
+    struct Result
+    {
+        bool succeeded = false;                 // 両方の経路で 1 回以上ピークが立った
+        juce::String error;
+        double sampleRateHz = 0.0;
+        int bufferSize = 0;
+        convo::LoopbackDelaySummary hardware;   // エンジンを通さない往復
+        convo::LoopbackDelaySummary total;      // エンジンを通した往復
+        int reportedDeviceLatencySamples = 0;   // ドライバの申告 (入力 + 出力)
+        int predictedEngineLatencySamples = 0;  // getTotalLatencySamples()
+        std::vector<convo::BufferSweepStep> sweepSteps;
+        int lowestGlitchFreeBufferSize = 0;     // 0 = 掃引していない、または全段で glitch
+
+        [[nodiscard]] int measuredEngineLatencySamples() const noexcept
+        {
+            return total.medianSamples - hardware.medianSamples;
+        }
+    };
+
+    static constexpr int kTickMs = 20;
+    static constexpr double kSettleHoldSeconds = 0.5;
+    static constexpr double kGapSeconds = 1.0;          // 測定の間の無音 (前の MLS の残響を抜く)
+    static constexpr double kSweepDiscardSeconds = 1.0; // 開き直し直後は統計に入れない
+    static constexpr double kSweepOpenTimeoutSeconds = 30.0;
+    static constexpr double kProbeLevel = 0.25;         // -12 dBFS
+    static constexpr double kNoiseLevel = 0.01;         // -40 dBFS (無音スキップに当たらない程度)
+
+    // Message Thread で呼ばれる。呼ばれた時点でこのオブジェクトはデバイスから外れている
+    using FinishedCallback = std::function<void(const Result&)>;
+
+    LoopbackLatencyTest(AudioEngine& engine, juce::AudioDeviceManager& deviceManager, Options options, FinishedCallback onFinished);
+    ~LoopbackLatencyTest() override;
+
+    // Message Thread 専用。デバイスから audioProcessorPlayer を外した後に呼ぶ。false = デバイスが無い・入力が開けない
+    bool start();
+    [[nodiscard]] bool isRunning() const noexcept { return phase != Phase::Idle && phase != Phase::Done; }
+
+    void audioDeviceIOCallbackWithContext(const float* const* inputChannelData,
+                                          int numInputChannels,
+                                          float* const* outputChannelData,
+                                          int numOutputChannels,
+                                          int numSamples,
+                                          const juce::AudioIODeviceCallbackContext& context) override;
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+    void audioDeviceStopped() override;
+
+private:
+    enum class Mode : int
+    {
+        Silence,        // 無音をエンジンに通す
+        ProbeDirect,    // MLS をエンジンを通さずに出す
+        ProbeEngine,    // MLS をエンジンに通す
+        Noise           // 低レベルのノイズをエンジンに通す (掃引の負荷)
+    };
+
+    enum class Phase
+    {
+        Idle,
+        Settling,
+        Gap,
+        Capturing,
+        SweepOpening,
+        SweepDwelling,
+        Done
+    };
+
+    void timerCallback() override;
+    void beginCapture();
+    void finishCapture();
+    void beginSweepStep();
+    void finishSweepStep();
+    void finish(const juce::String& error);
+    void reportResult() const;
+    void setMode(Mode mode) noexcept;
+    [[nodiscard]] double elapsedSeconds() const noexcept;
+
+    AudioEngine& engine;
+    juce::AudioDeviceManager& deviceManager;
+    Options options;
+    FinishedCallback onFinished;
+
+    // 以下は Message Thread 専用
+    Phase phase = Phase::Idle;
+    double phaseStartMs = 0.0;
+    double settledSinceMs = -1.0;
+    juce::AudioDeviceManager::AudioDeviceSetup originalSetup;
+    bool setupChanged = false;
+    std::vector<convo::LoopbackDelayEstimate> directEstimates;
+    std::vector<convo::LoopbackDelayEstimate> engineEstimates;
+    size_t maxDelaySamples = 0;
+    int captureIndex = 0;                       // 偶数 = direct、奇数 = engine
+    std::vector<int> sweepSizes;
+    size_t sweepIndex = 0;
+    convo::CallbackTimingHistograms::Snapshot sweepBefore {};
+    Result result;
+
+    // 測定中は Audio Thread だけが触る (確保・解放は測定の外で Message Thread が行う)
+    std::vector<float> probe;
+    std::vector<float> capture;
+    juce::AudioBuffer<double> scratch;
+
+    std::atomic<int> mode { static_cast<int>(Mode::Silence) };
+    std::atomic<uint32_t> requestedPass { 0 };
+    std::atomic<uint64_t> capturedProgress { 0 };  // 上位 32 bit = 測定番号、下位 = 録音済みサンプル数
+
+    // 以下は Audio Thread 専用 (activeInputIndex は audioDeviceAboutToStart が書く)
+    int activeInputIndex = -1;                  // inputChannelData 上の位置。-1 = 入力が開いていない
+    uint32_t servedPass = 0;
+    size_t passPosition = 0;
+    uint32_t noiseState = 0x9e3779b9u;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoopbackLatencyTest)
+};
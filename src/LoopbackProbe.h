@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "audioengine/CallbackTimingProfile.h"
+
+//==============================================================================
+// LoopbackProbe — ループバック往復遅延の測定信号と解析 (LoopbackLatencyTest が使う)
+//
+//   出力から入力へ物理的にループバックした状態で MLS (最大長系列) を 1 回流し、録った入力と
+//   元の MLS の相互相関のピーク位置を往復遅延とする。MLS の自己相関は 0 以外でほぼ平坦なので、
+//   EQ・畳み込みで形が変わってもピーク (直接音) は鋭く残り、整数サンプル単位で決まる。
+//   ピークが相関の中央値より kMinPeakToMedian 倍以上大きくなければ「ループバックが無い」とみなす。
+//
+//   バッファ長の掃引は 1 段ごとの CallbackTimingStats の差分から、超過・遅着が 0 で
+//   p99.9 負荷が CallbackTimingStats::kMaxStableLoadPermille 以下なら glitch-free とする。
+//
+//   JUCE 非依存 (テストから直接使う)。
+//==============================================================================
+
+namespace convo {
+
+// Galois LFSR の帰還マスク (いずれも周期 2^order - 1 を確認済み)
+inline constexpr int kMinMlsOrder = 10;
+inline constexpr int kMaxMlsOrder = 18;
+
+[[nodiscard]] constexpr uint32_t mlsFeedbackMask(int order) noexcept
+{
+    switch (order)
+    {
+        case 10: return 0x240u;
+        case 11: return 0x500u;
+        case 12: return 0x829u;
+        case 13: return 0x100du;
+        case 14: return 0x2015u;
+        case 15: return 0x6000u;
+        case 16: return 0xd008u;
+        case 17: return 0x12000u;
+        case 18: return 0x20400u;
+        default: break;
+    }
+    return 0;
+}
+
+// ±1 の MLS (長さ 2^order - 1)。order が範囲外なら空
+[[nodiscard]] inline std::vector<float> makeMaximumLengthSequence(int order)
+{
+    const uint32_t mask = mlsFeedbackMask(order);
+    if (mask == 0)
+        return {};
+
+    const size_t length = (static_cast<size_t>(1) << order) - 1;
+    std::vector<float> sequence(length);
+    uint32_t state = 1;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const uint32_t bit = state & 1u;
+        sequence[i] = bit != 0 ? 1.0f : -1.0f;
+        state >>= 1;
+        if (bit != 0)
+            state ^= mask;
+    }
+    return sequence;
+}
+
+struct LoopbackDelayEstimate
+{
+    bool valid = false;          // ピークが十分に鋭い (ループバックの信号が届いている)
+    int delaySamples = 0;
+    double peakToMedian = 0.0;   // |相関| のピーク / 中央値
+    double peakGain = 0.0;       // ピークの相関 / 参照のエネルギー (ループバック経路の利得の目安、符号付き)
+};
+
+namespace detail {
+
+// 反復型 radix-2 FFT (size は 2 の累乗)。inverse は 1/size の正規化をしない
+inline void fftInPlace(std::vector<std::complex<double>>& data, bool inverse)
+{
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; ++i)
+    {
+        size_t bit = n >> 1;
+        for (; (j & bit) != 0; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+
+    constexpr double kPi = 3.14159265358979323846;
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const double angle = (inverse ? 2.0 : -2.0) * kPi / static_cast<double>(len);
+        const std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += len)
+        {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; ++k)
+            {
+                const auto even = data[start + k];
+                const auto odd = data[start + k + len / 2] * w;
+                data[start + k] = even + odd;
+                data[start + k + len / 2] = even - odd;
+                w *= step;
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+inline constexpr double kMinPeakToMedian = 20.0;
+
+// captured[d + n] と reference[n] の相関を d = 0..maxDelay で求め、|相関| が最大の d を返す。
+// 非 RT (FFT 長 = 2 の累乗 ≥ capturedLength + reference.size() の作業領域を確保する)
+[[nodiscard]] inline LoopbackDelayEstimate estimateLoopbackDelay(const std::vector<float>& reference,
+                                                                 const float* captured,
+                                                                 size_t capturedLength,
+                                                                 size_t maxDelay)
+{
+    LoopbackDelayEstimate estimate;
+    if (reference.empty() || captured == nullptr || capturedLength == 0)
+        return estimate;
+
+    size_t fftSize = 1;
+    while (fftSize < capturedLength + reference.size())
+        fftSize <<= 1;
+
+    std::vector<std::complex<double>> x(fftSize);
+    std::vector<std::complex<double>> r(fftSize);
+    for (size_t i = 0; i < capturedLength; ++i)
+        x[i] = captured[i];
+    for (size_t i = 0; i < reference.size(); ++i)
+        r[i] = reference[i];
+    detail::fftInPlace(x, false);
+    detail::fftInPlace(r, false);
+    for (size_t i = 0; i < fftSize; ++i)
+        x[i] *= std::conj(r[i]);
+    detail::fftInPlace(x, true);
+
+    // 相関の添字 d はそのまま遅延 (負の遅延は末尾に折り返るので見ない)
+    const size_t lags = std::min(maxDelay + 1, capturedLength);
+    std::vector<double> magnitude(lags);
+    size_t peakIndex = 0;
+    for (size_t d = 0; d < lags; ++d)
+    {
+        magnitude[d] = std::abs(x[d].real());
+        if (magnitude[d] > magnitude[peakIndex])
+            peakIndex = d;
+    }
+    const double peak = magnitude[peakIndex];
+
+    std::vector<double> sorted = magnitude;
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(sorted.size() / 2), sorted.end());
+    const double median = sorted[sorted.size() / 2];
+
+    double referenceEnergy = 0.0;
+    for (float v : reference)
+        referenceEnergy += static_cast<double>(v) * v;
+
+    estimate.delaySamples = static_cast<int>(peakIndex);
+    estimate.peakToMedian = median > 0.0 ? peak / median : (peak > 0.0 ? kMinPeakToMedian * 1000.0 : 0.0);
+    estimate.peakGain = referenceEnergy > 0.0 ? x[peakIndex].real() / static_cast<double>(fftSize) / referenceEnergy : 0.0;
+    estimate.valid = peak > 0.0 && estimate.peakToMedian >= kMinPeakToMedian;
+    return estimate;
+}
+
+// 複数回の測定の要約 (valid なものだけ)
+struct LoopbackDelaySummary
+{
+    int validCount = 0;
+    int medianSamples = 0;
+    int minSamples = 0;
+    int maxSamples = 0;
+
+    [[nodiscard]] int spreadSamples() const noexcept { return maxSamples - minSamples; }
+};
+
+[[nodiscard]] inline LoopbackDelaySummary summarizeLoopbackDelays(const std::vector<LoopbackDelayEstimate>& estimates)
+{
+    std::vector<int> delays;
+    for (const auto& e : estimates)
+        if (e.valid)
+            delays.push_back(e.delaySamples);
+
+    LoopbackDelaySummary summary;
+    if (delays.empty())
+        return summary;
+    std::sort(delays.begin(), delays.end());
+    summary.validCount = static_cast<int>(delays.size());
+    summary.medianSamples = delays[delays.size() / 2];
+    summary.minSamples = delays.front();
+    summary.maxSamples = delays.back();
+    return summary;
+}
+
+// バッファ長掃引の 1 段
+struct BufferSweepStep
+{
+    int bufferSize = 0;
+    uint64_t callbacks = 0;
+    uint64_t glitches = 0;           // 超過 + 遅着
+    uint32_t loadP999Permille = 0;
+    bool glitchFree = false;
+};
+
+[[nodiscard]] inline BufferSweepStep judgeBufferSweepStep(int bufferSize, const CallbackTimingStats& window) noexcept
+{
+    BufferSweepStep step;
+    step.bufferSize = bufferSize;
+    step.callbacks = window.totals.callbacks;
+    step.glitches = window.totals.overruns + window.totals.lateArrivals;
+    step.loadP999Permille = window.loadPercentilePermille(9990);
+    step.glitchFree = step.callbacks > 0 && step.glitches == 0
+                   && step.loadP999Permille <= CallbackTimingStats::kMaxStableLoadPermille;
+    return step;
+}
+
+// glitch-free だった最小のバッファ長。無ければ 0
+[[nodiscard]] inline int lowestGlitchFreeBufferSize(const std::vector<BufferSweepStep>& steps) noexcept
+{
+    int best = 0;
+    for (const auto& s : steps)
+        if (s.glitchFree && (best == 0 || s.bufferSize < best))
+            best = s.bufferSize;
+    return best;
+}
+
+} // namespace convo
@@ -0,0 +1,221 @@
+//============================================================================
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+//============================================================================
+/**
+    LoudnessIntegrator ── EBU R128 の Momentary / Short-term / Integrated / LRA (ヒストグラム法)
+
+    LoudnessMeter のブロック電力 (チャンネル重み済みの平均二乗とサンプル数) を 100ms のサブブロックへ
+    詰め直し、サブブロックが 1 つ埋まるごとに
+      - 400ms (4 サブブロック) のゲーティングブロックを Integrated 用ヒストグラムへ
+      - 3s (30 サブブロック) の Short-term 値を LRA 用ヒストグラムへ
+    加える。ヒストグラムは -70 LUFS から 0.1 LU 刻みの固定ビン (各ビンに個数とエネルギー和) なので、
+    番組が何時間続いても追加も集計もビン数ぶんの定数時間で済む (ブロック履歴を持たない)。
+
+    - Integrated: 絶対ゲート (-70 LUFS) を通ったブロックの平均から相対ゲート (-10 LU) を引き、
+      それ以上のビンのエネルギー和で求める。相対ゲートの境界ビンはビン中心で含否を決める (±0.05 LU)
+    - LRA (EBU Tech 3342): Short-term 値に絶対ゲートと相対ゲート (-20 LU) を掛け、10% 点と 95% 点の差
+
+    スレッド: 単一スレッド (ブロック電力の RingBuffer を読むワーカー) 専用。JUCE 非依存。
+*/
+class LoudnessIntegrator
+{
+public:
+    static constexpr double kAbsoluteGateLufs = -70.0;
+    static constexpr double kBinWidthLu = 0.1;
+    static constexpr double kHistogramTopLufs = 10.0;      // これより上は最上位ビンへ (エネルギーは正確に足す)
+    static constexpr int kNumBins = static_cast<int>((kHistogramTopLufs - kAbsoluteGateLufs) / kBinWidthLu);
+    static constexpr int kMomentarySubBlocks = 4;          // 400ms
+    static constexpr int kShortTermSubBlocks = 30;         // 3s
+
+    void prepare(double sampleRate) noexcept
+    {
+        hopSamples = std::max<int64_t>(1, static_cast<int64_t>(std::llround(sampleRate * 0.1)));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        subBlockEnergy.fill(0.0);
+        subBlocksWritten = 0;
+        currentEnergy = 0.0;
+        currentSamples = 0;
+        integratedHistogram.clear();
+        rangeHistogram.clear();
+    }
+
+    // meanSquare: チャンネル重み済みの平均二乗 (L+R)、numSamples: そのブロックのサンプル数
+    void addBlock(double meanSquare, int numSamples) noexcept
+    {
+        if (numSamples <= 0 || !std::isfinite(meanSquare))
+            return;
+
+        // ブロック内の電力は一様とみなし、100ms の境界で按分する
+        int64_t remaining = numSamples;
+        while (remaining > 0)
+        {
+            const int64_t take = std::min(remaining, hopSamples - currentSamples);
+            currentEnergy += meanSquare * static_cast<double>(take);
+            currentSamples += take;
+            remaining -= take;
+            if (currentSamples == hopSamples)
+                completeSubBlock();
+        }
+    }
+
+    //--- 直近の値 (データ不足や無音なら -inf) ---
+    double momentaryLufs() const noexcept { return windowLufs(kMomentarySubBlocks); }
+    double shortTermLufs() const noexcept { return windowLufs(kShortTermSubBlocks); }
+
+    double integratedLufs() const noexcept
+    {
+        return integratedHistogram.gatedLufs(-10.0);
+    }
+
+    double loudnessRangeLu() const noexcept
+    {
+        const int first = rangeHistogram.relativeGateBin(-20.0);
+        if (first < 0)
+            return 0.0;
+
+        uint64_t gatedCount = 0;
+        for (int b = first; b < kNumBins; ++b)
+            gatedCount += rangeHistogram.counts[static_cast<size_t>(b)];
+        if (gatedCount == 0)
+            return 0.0;
+
+        const double low = rangeHistogram.percentileLufs(first, gatedCount, 0.10);
+        const double high = rangeHistogram.percentileLufs(first, gatedCount, 0.95);
+        return std::max(0.0, high - low);
+    }
+
+    uint64_t gatingBlockCount() const noexcept { return integratedHistogram.total; }
+
+    static double energyToLufs(double meanSquare) noexcept
+    {
+        return (meanSquare > 0.0) ? -0.691 + 10.0 * std::log10(meanSquare)
+                                  : -std::numeric_limits<double>::infinity();
+    }
+
+private:
+    struct Histogram
+    {
+        std::array<uint64_t, kNumBins> counts {};
+        std::array<double, kNumBins> energy {};   // ビンに入ったブロックの平均二乗の和
+        uint64_t total = 0;
+        double totalEnergy = 0.0;
+
+        void clear() noexcept
+        {
+            counts.fill(0);
+            energy.fill(0.0);
+            total = 0;
+            totalEnergy = 0.0;
+        }
+
+        // 絶対ゲート未満は呼ばない
+        void add(double lufs, double meanSquare) noexcept
+        {
+            const auto bin = static_cast<size_t>(std::clamp(static_cast<int>((lufs - kAbsoluteGateLufs) / kBinWidthLu), 0, kNumBins - 1));
+            ++counts[bin];
+            energy[bin] += meanSquare;
+            ++total;
+            totalEnergy += meanSquare;
+        }
+
+        // 絶対ゲート済みの平均から offsetLu 下を相対ゲートとし、それを中心が下回らない最初のビン (なければ -1)
+        int relativeGateBin(double offsetLu) const noexcept
+        {
+            if (total == 0)
+                return -1;
+            const double gate = energyToLufs(totalEnergy / static_cast<double>(total)) + offsetLu;
+            const int bin = static_cast<int>(std::ceil((gate - kAbsoluteGateLufs) / kBinWidthLu - 0.5));
+            return std::clamp(bin, 0, kNumBins - 1);
+        }
+
+        double gatedLufs(double offsetLu) const noexcept
+        {
+            const int first = relativeGateBin(offsetLu);
+            if (first < 0)
+                return -std::numeric_limits<double>::infinity();
+
+            uint64_t count = 0;
+            double sum = 0.0;
+            for (int b = first; b < kNumBins; ++b)
+            {
+                count += counts[static_cast<size_t>(b)];
+                sum += energy[static_cast<size_t>(b)];
+            }
+            return (count > 0) ? energyToLufs(sum / static_cast<double>(count))
+                               : -std::numeric_limits<double>::infinity();
+        }
+
+        // first 以上のビンの累積個数が fraction に達するビンの中心
+        double percentileLufs(int first, uint64_t gatedCount, double fraction) const noexcept
+        {
+            const auto target = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(gatedCount)));
+            uint64_t cumulative = 0;
+            for (int b = first; b < kNumBins; ++b)
+            {
+                cumulative += counts[static_cast<size_t>(b)];
+                if (cumulative >= std::max<uint64_t>(target, 1))
+                    return kAbsoluteGateLufs + (static_cast<double>(b) + 0.5) * kBinWidthLu;
+            }
+            return kHistogramTopLufs;
+        }
+    };
+
+    void completeSubBlock() noexcept
+    {
+        subBlockEnergy[static_cast<size_t>(subBlocksWritten % kShortTermSubBlocks)] = currentEnergy / static_cast<double>(hopSamples);
+        ++subBlocksWritten;
+        currentEnergy = 0.0;
+        currentSamples = 0;
+
+        // 100ms ごと (75% オーバーラップ) に 400ms ブロックと 3s ブロックを 1 つずつ評価する
+        if (subBlocksWritten >= kMomentarySubBlocks)
+        {
+            const double meanSquare = windowMeanSquare(kMomentarySubBlocks);
+            const double lufs = energyToLufs(meanSquare);
+            if (lufs > kAbsoluteGateLufs)
+                integratedHistogram.add(lufs, meanSquare);
+        }
+        if (subBlocksWritten >= kShortTermSubBlocks)
+        {
+            const double meanSquare = windowMeanSquare(kShortTermSubBlocks);
+            const double lufs = energyToLufs(meanSquare);
+            if (lufs > kAbsoluteGateLufs)
+                rangeHistogram.add(lufs, meanSquare);
+        }
+    }
+
+    double windowMeanSquare(int numSubBlocks) const noexcept
+    {
+        double sum = 0.0;
+        for (int k = 1; k <= numSubBlocks; ++k)
+            sum += subBlockEnergy[static_cast<size_t>((subBlocksWritten - k) % kShortTermSubBlocks)];
+        return sum / static_cast<double>(numSubBlocks);
+    }
+
+    double windowLufs(int numSubBlocks) const noexcept
+    {
+        return (subBlocksWritten >= static_cast<uint64_t>(numSubBlocks))
+            ? energyToLufs(windowMeanSquare(numSubBlocks))
+            : -std::numeric_limits<double>::infinity();
+    }
+
+    int64_t hopSamples = 4800;
+    std::array<double, kShortTermSubBlocks> subBlockEnergy {};   // 直近 30 個の 100ms サブブロックの平均二乗 (リング)
+    uint64_t subBlocksWritten = 0;
+    double currentEnergy = 0.0;
+    int64_t currentSamples = 0;
+
+    Histogram integratedHistogram;   // 400ms ゲーティングブロック
+    Histogram rangeHistogram;        // 3s Short-term (LRA)
+};
@@ -35,11 +35,8 @@ void LoudnessMeter::prepare(double sr, int maxBlockSize)
 
 void LoudnessMeter::reset() noexcept
 {
-    for (int ch = 0; ch < kMaxChannels; ++ch)
-    {
-        std::memset(&preFilterState[ch], 0, sizeof(KWeightingState));
-        std::memset(&rlbFilterState[ch], 0, sizeof(KWeightingState));
-    }
+    preFilterState = {};
+    rlbFilterState = {};
     blockCounter = 0;
     if (ringBufferStorage) ringBufferStorage->ringBuffer.clear();
 }
@@ -52,20 +49,53 @@ void LoudnessMeter::processBlock(const double* dataL, const double* dataR, int n
     double* fr = fl + numSamples;
     if (!fl) return;
 
-    // Stage 1: Pre-filter per channel
-    for (int n = 0; n < numSamples; ++n)
-    {
-        fl[n] = processKWeightingStage(preFilterCoeffs, preFilterState[0], dataL[n]);
-        fr[n] = (dataR != nullptr)
-            ? processKWeightingStage(preFilterCoeffs, preFilterState[1], dataR[n])
-            : processKWeightingStage(preFilterCoeffs, preFilterState[1], dataL[n]);
-    }
-
-    // Stage 2: RLB filter per channel
-    for (int n = 0; n < numSamples; ++n)
+    // K-weighting: L/R を __m128d の 2 レーンに載せ、Stage 1 (Pre-filter) → Stage 2 (RLB) を 1 パスで通す。
+    // Direct Form I (a0=1 正規化, coeffs = {b0, b1, b2, a1, a2})。演算順はスカラー版と同じなので結果も一致する
+    // (モノラル入力は R レーンにも L を入れる)
     {
-        fl[n] = processKWeightingStage(rlbFilterCoeffs, rlbFilterState[0], fl[n]);
-        fr[n] = processKWeightingStage(rlbFilterCoeffs, rlbFilterState[1], fr[n]);
+        const double* srcR = (dataR != nullptr) ? dataR : dataL;
+
+        const __m128d pb0 = _mm_set1_pd(preFilterCoeffs[0]), pb1 = _mm_set1_pd(preFilterCoeffs[1]), pb2 = _mm_set1_pd(preFilterCoeffs[2]);
+        const __m128d pa1 = _mm_set1_pd(preFilterCoeffs[3]), pa2 = _mm_set1_pd(preFilterCoeffs[4]);
+        const __m128d rb0 = _mm_set1_pd(rlbFilterCoeffs[0]), rb1 = _mm_set1_pd(rlbFilterCoeffs[1]), rb2 = _mm_set1_pd(rlbFilterCoeffs[2]);
+        const __m128d ra1 = _mm_set1_pd(rlbFilterCoeffs[3]), ra2 = _mm_set1_pd(rlbFilterCoeffs[4]);
+
+        __m128d px1 = _mm_load_pd(preFilterState.x1), px2 = _mm_load_pd(preFilterState.x2);
+        __m128d py1 = _mm_load_pd(preFilterState.y1), py2 = _mm_load_pd(preFilterState.y2);
+        __m128d ry1 = _mm_load_pd(rlbFilterState.y1), ry2 = _mm_load_pd(rlbFilterState.y2);
+        // RLB の入力遅延は Pre-filter の出力遅延と同じ値 (py1/py2) なので別に持たない
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const __m128d x = _mm_set_pd(srcR[n], dataL[n]);   // [L, R]
+
+            __m128d p = _mm_mul_pd(pb0, x);
+            p = _mm_add_pd(p, _mm_mul_pd(pb1, px1));
+            p = _mm_add_pd(p, _mm_mul_pd(pb2, px2));
+            p = _mm_sub_pd(p, _mm_mul_pd(pa1, py1));
+            p = _mm_sub_pd(p, _mm_mul_pd(pa2, py2));
+
+            __m128d r = _mm_mul_pd(rb0, p);
+            r = _mm_add_pd(r, _mm_mul_pd(rb1, py1));
+            r = _mm_add_pd(r, _mm_mul_pd(rb2, py2));
+            r = _mm_sub_pd(r, _mm_mul_pd(ra1, ry1));
+            r = _mm_sub_pd(r, _mm_mul_pd(ra2, ry2));
+
+            px2 = px1;  px1 = x;
+            py2 = py1;  py1 = p;
+            ry2 = ry1;  ry1 = r;
+
+            _mm_storel_pd(fl + n, r);
+            _mm_storeh_pd(fr + n, r);
+        }
+
+        _mm_store_pd(preFilterState.x1, px1);
+        _mm_store_pd(preFilterState.x2, px2);
+        _mm_store_pd(preFilterState.y1, py1);
+        _mm_store_pd(preFilterState.y2, py2);
+        _mm_store_pd(rlbFilterState.x1, py1);
+        _mm_store_pd(rlbFilterState.x2, py2);
+        _mm_store_pd(rlbFilterState.y1, ry1);
+        _mm_store_pd(rlbFilterState.y2, ry2);
     }
 
     // Compute mean square + peak (processed signal)
@@ -133,6 +163,7 @@ void LoudnessMeter::processBlock(const double* dataL, const double* dataR, int n
     bp.meanSquare = meanSquare;
     bp.peakLinear = peakLinear;
     bp.blockIndex = blockCounter++;
+    bp.numSamples = numSamples;
     if (ringBufferStorage) ringBufferStorage->ringBuffer.push(bp);
 }
 
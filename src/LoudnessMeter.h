@@ -8,15 +8,19 @@
 #include "AlignedAllocation.h"
 #include "audioengine/AtomicAccess.h"
 #include "LockFreeRingBuffer.h"
+#include "LoudnessIntegrator.h"
 
 //============================================================================
 /**
     LoudnessMeter ── ITU-R BS.1770-4/5 + EBU R128 準拠ラウドネスメーター
 
     K-weighting フィルタ処理 → ブロック平均電力 → RingBuffer publish
-    集計（Momentary/Short-term/Integrated）は専用ワーカースレッド。
+    集計（Momentary/Short-term/Integrated/LRA）は専用ワーカースレッドが drainInto() で
+    LoudnessIntegrator (ヒストグラム法、番組長に依らず定数時間) へ流し込む。
+    K-weighting は L/R を SSE2 の 2 レーンに載せ、Pre-filter と RLB を 1 パスで通す。
 
-    Audio Thread: processBlock() のみ呼び出し（lock-free, 非メモリ確保）
+    processBlock() は lock-free・非メモリ確保。
+    エンジンでは MeteringWorker が出力タップ (meteringFifo) の中身で processBlock() と drainInto() を同じスレッドから回す。
 */
 class LoudnessMeter
 {
@@ -33,11 +37,13 @@ public:
     /** prepare: (Message Thread) */
     void prepare(double sampleRate, int maxBlockSize);
 
-    /** Audio Thread: ブロックの平均電力を計算しRingBufferにpublish */
+    /** ブロックの平均電力を計算しRingBufferにpublish */
     void processBlock(const double* dataL, const double* dataR, int numSamples) noexcept;
 
     void reset() noexcept;
 
+    double getSampleRate() const noexcept { return sampleRate; }
+
     /** サンプルレートに応じてK-weightingフィルタ係数を再計算（prepare内部で自動呼出） */
     void updateCoefficients(double sampleRate);
 
@@ -46,23 +52,38 @@ public:
         double meanSquare = 0.0; // チャンネル重み適用済み M/S
         double peakLinear = 0.0;
         uint64_t blockIndex = 0;
+        int numSamples = 0;      // 100ms サブブロックへの按分用
     };
 
     LockFreeRingBuffer<BlockPower, 4096>& getRingBuffer() noexcept { return ringBufferStorage->ringBuffer; }
 
+    /** Worker Thread (RingBuffer の単一コンシューマ): 溜まったブロックを integrator へ流し込み、その数を返す */
+    int drainInto(LoudnessIntegrator& integrator) noexcept
+    {
+        if (!ringBufferStorage) return 0;
+        // 一括 drain: スロット上でそのまま読み、readIndex の解放は 1 回にまとめる
+        const size_t drained = ringBufferStorage->ringBuffer.drain([&integrator](const BlockPower* blocks, size_t count) noexcept
+        {
+            for (size_t i = 0; i < count; ++i)
+                integrator.addBlock(blocks[i].meanSquare, blocks[i].numSamples);
+        });
+        return static_cast<int>(drained);
+    }
+
 private:
     // K-weighting filter (2-stage biquad, BS.1770-4 Table 1)
     // Stage 1: Pre-filter (High-shelf)
     // Stage 2: RLB filter (High-pass)
+    // 各遅延は [L, R] の 2 レーン (processBlock で __m128d として読み書きする)
     struct KWeightingState {
-        double x1[2] = {}; // 入力遅延
-        double x2[2] = {};
-        double y1[2] = {};
-        double y2[2] = {};
+        alignas(16) double x1[2] = {}; // 入力遅延
+        alignas(16) double x2[2] = {};
+        alignas(16) double y1[2] = {};
+        alignas(16) double y2[2] = {};
     };
 
-    KWeightingState preFilterState[2];  // [channel]
-    KWeightingState rlbFilterState[2];
+    KWeightingState preFilterState;
+    KWeightingState rlbFilterState;
 
     // ★ [work74 FIX-02] サンプルレート依存係数（updateCoefficients で設定）
     //   48kHz固定値 kPreBiquad / kRlbBiquad に代わり、インスタンスごとに保持する。
@@ -82,19 +103,6 @@ private:
         alignas(64) LockFreeRingBuffer<BlockPower, 4096> ringBuffer;
     };
     convo::ScopedAlignedPtr<RingBufferStorage> ringBufferStorage;
-
-    inline double processKWeightingStage(const double coeffs[5], KWeightingState& state, double x) noexcept
-    {
-        // Direct Form I: a0=1 normalized
-        // coeffs = {b0, b1, b2, a1, a2}
-        const double y = coeffs[0] * x + coeffs[1] * state.x1[0] + coeffs[2] * state.x2[0]
-                       - coeffs[3] * state.y1[0] - coeffs[4] * state.y2[0];
-        state.x2[0] = state.x1[0];
-        state.x1[0] = x;
-        state.y2[0] = state.y1[0];
-        state.y1[0] = y;
-        return y;
-    }
 };
 
     //--- K-weighting coefficients (48kHz, ITU-R BS.1770-4 Table 1) ---
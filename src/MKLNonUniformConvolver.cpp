@@ -24,6 +24,11 @@
 //   sizeWork == 0 の場合のみ fftWorkBuf = nullptr (IPP が外部バッファ不要)。
 //   Audio Thread (processLayerBlock / Add の分散ループ) でのメモリ確保はゼロ。
 //
+// ■ サイズ別の FFT 実装選択 (RealFft.h / FftBackendWisdom.h):
+//   FFT 呼び出しは RealFftPlan 経由。既定は上記の IPP だが、起動時の実測で
+//   MKL DFTI (DFTI_THREAD_LIMIT=1, 非 in-place, CCE 形式) の方が速かったサイズはそちらを使う。
+//   上記のスレッド同期コストがあるサイズでは計測で IPP が勝つため、選択に自然に織り込まれる。
+//
 // ■ 継続使用する MKL 機能 (VML/BLAS: Message Thread のみ):
 //   mkl_malloc / mkl_free   : オーディオデータバッファ確保
 //   vdMul (MKL VML)         : applySpectrumFilter での周波数ゲイン適用
@@ -37,11 +42,17 @@
 
 #include <JuceHeader.h>
 #include "MKLNonUniformConvolver.h"
+#include "FarTailPager.h"
 #include "DiagnosticsConfig.h"  // ★ work70: DIAG_MKL_MALLOC, convo::diag, getProcessMemoryInfo
 
 #include "AlignedAllocation.h"
 #include "DspNumericPolicy.h"
 #include "AtomicAccess.h"  // convo::consumeAtomic
+#include "core/ThreadAffinityManager.h"  // ThreadType::ConvolverTail (Tail Worker)
+#include "core/BinTileLayout.h"  // Bin-major FDL のタイル配置
+#include "CpuFeatureCheck.h"  // hasAVX512Support (CMAC カーネル選択)
+#include "RealFft.h"          // RealFftPlanCache (IPP / MKL DFTI をサイズ別に選択)
+#include "dsp/IsaTarget.h"    // CONVO_TARGET_AVX512
 
 // absNoLibm — 標準ライブラリ abs を経由せずビット操作で |x| を求める (RT-safe)
 [[nodiscard]] constexpr inline double absNoLibm(double x) noexcept
@@ -53,18 +64,21 @@
 #include <mkl.h>        // mkl_malloc, mkl_free, mkl_set_num_threads
 #include <mkl_vml.h>    // vdMul
 #include <mkl_cblas.h>  // cblas_dscal
-#include <ipp.h>       // ippsFFTFwd_RToCCS_64f, ippsFFTInv_CCSToR_64f (MKL DFTI 代替)
+#include <ipp.h>       // ippsMalloc_8u (FFT ワークバッファ)
 #include <cstring>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <unordered_map>
+#include <utility>
 
 #pragma comment(lib, "psapi.lib")  // ★ work70: getProcessMemoryInfo
 
-#include <immintrin.h>  // AVX2
+#include <immintrin.h>  // AVX2 / AVX-512F
 
 #include "audioengine/AtomicAccess.h"
 
@@ -86,91 +100,6 @@ std::atomic<uint32_t> MKLNonUniformConvolver::liveCount { 0 };
 std::atomic<uint64_t> MKLNonUniformConvolver::globalDiagSeq { 0 };
 #endif
 
-struct IppFFTPlan
-{
-    int order = 0;
-    int fftSize = 0;
-    int sizeWork = 0;
-    IppsFFTSpec_R_64f* fftSpec = nullptr;
-    Ipp8u* fftSpecBuf = nullptr;
-
-    ~IppFFTPlan()
-    {
-        if (fftSpecBuf)
-            ippsFree(fftSpecBuf);
-    }
-};
-
-class IppFFTPlanCache
-{
-public:
-    static const IppFFTPlan* getOrCreate(int order)
-    {
-        ASSERT_NON_RT_THREAD();
-        std::lock_guard<std::mutex> lock(getMutex());
-        auto& cache = getCache();
-        const auto it = cache.find(order);
-        if (it != cache.end())
-            return it->second.get();
-
-        auto plan = createPlan(order);
-        if (!plan)
-            return nullptr;
-
-        auto* ptr = plan.get();
-        cache.emplace(order, std::move(plan));
-        return ptr;
-    }
-
-private:
-    static std::unordered_map<int, std::unique_ptr<IppFFTPlan>> cacheStorage_;
-    static std::mutex cacheMutex_;
-
-    static std::unordered_map<int, std::unique_ptr<IppFFTPlan>>& getCache()
-    {
-        return cacheStorage_;
-    }
-
-    static std::mutex& getMutex()
-    {
-        return cacheMutex_;
-    }
-
-    static std::unique_ptr<IppFFTPlan> createPlan(int order)
-    {
-        int sizeSpec = 0, sizeInit = 0, sizeWork = 0;
-        const IppStatus getSt = ippsFFTGetSize_R_64f(
-            order, IPP_FFT_DIV_INV_BY_N, ippAlgHintFast,
-            &sizeSpec, &sizeInit, &sizeWork);
-        if (getSt != ippStsNoErr)
-            return nullptr;
-
-        std::unique_ptr<IppFFTPlan> plan = std::make_unique<IppFFTPlan>();
-        plan->order = order;
-        plan->fftSize = 1 << order;
-        plan->sizeWork = sizeWork;
-
-        plan->fftSpecBuf = ippsMalloc_8u(sizeSpec);
-        if (!plan->fftSpecBuf)
-            return nullptr;
-
-        Ipp8u* initBuf = (sizeInit > 0) ? ippsMalloc_8u(sizeInit) : nullptr;
-        const IppStatus initSt = ippsFFTInit_R_64f(
-            &plan->fftSpec, order, IPP_FFT_DIV_INV_BY_N, ippAlgHintFast,
-            plan->fftSpecBuf, initBuf);
-
-        if (initBuf)
-            ippsFree(initBuf);
-
-        if (initSt != ippStsNoErr || plan->fftSpec == nullptr)
-            return nullptr;
-
-        return plan;
-    }
-};
-
-std::unordered_map<int, std::unique_ptr<IppFFTPlan>> IppFFTPlanCache::cacheStorage_{};
-std::mutex IppFFTPlanCache::cacheMutex_{};
 
 namespace
 {
@@ -181,15 +110,6 @@ namespace
 #error "MKLNonUniformConvolver requires AVX2 (see coding standard: CPU must support AVX2)."
 #endif
 
-inline double hsum256_pd(__m256d v) noexcept
-{
-    const __m128d hi = _mm256_extractf128_pd(v, 1);
-    const __m128d lo = _mm256_castpd256_pd128(v);
-    const __m128d sum = _mm_add_pd(lo, hi);
-    const __m128d shuf = _mm_shuffle_pd(sum, sum, 0x1);
-    return _mm_cvtsd_f64(_mm_add_sd(sum, shuf));
-}
-
 inline bool isFiniteAndAboveThresholdMask(double value, double threshold) noexcept
 {
     const __m128d v = _mm_set1_pd(value);
@@ -205,6 +125,22 @@ inline bool isFiniteAndAboveThresholdMask(double value, double threshold) noexce
     return _mm_movemask_pd(validMask) == 0x3;
 }
 
+// ★ Input sparsity: n サンプルがすべて ±0.0 か (NaN/デノーマルは非ゼロ扱い)
+inline bool isAllZeroBlock(const double* src, int n) noexcept
+{
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    __m256d acc = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm256_or_pd(acc, _mm256_and_pd(_mm256_loadu_pd(src + i), absMask));
+    if (!_mm256_testz_si256(_mm256_castpd_si256(acc), _mm256_castpd_si256(acc)))
+        return false;
+    for (; i < n; ++i)
+        if (src[i] != 0.0)
+            return false;
+    return true;
+}
+
 inline void deinterleaveComplex(const double* srcInterleaved, double* dstReal, double* dstImag, int complexSize) noexcept
 {
     for (int k = 0; k < complexSize; ++k)
@@ -223,13 +159,13 @@ inline void interleaveComplex(const double* srcReal, const double* srcImag, doub
     }
 }
 
-inline void accumulateSplitComplex(const double* srcAReal,
-                                   const double* srcAImag,
-                                   const double* srcBReal,
-                                   const double* srcBImag,
-                                   double* dstReal,
-                                   double* dstImag,
-                                   int complexSize) noexcept
+inline void accumulateSplitComplexAvx2(const double* srcAReal,
+                                       const double* srcAImag,
+                                       const double* srcBReal,
+                                       const double* srcBImag,
+                                       double* dstReal,
+                                       double* dstImag,
+                                       int complexSize) noexcept
 {
 #if defined(__AVX2__)
     int k = 0;
@@ -268,6 +204,334 @@ inline void accumulateSplitComplex(const double* srcAReal,
     }
 #endif
 }
+
+// ★ Compact tail: CCS 出力 (double interleaved) を float32 SoA へ deinterleave する
+inline void deinterleaveComplexToFloat(const double* srcInterleaved, float* dstReal, float* dstImag, int complexSize) noexcept
+{
+    for (int k = 0; k < complexSize; ++k)
+    {
+        dstReal[k] = static_cast<float>(srcInterleaved[2 * k]);
+        dstImag[k] = static_cast<float>(srcInterleaved[2 * k + 1]);
+    }
+}
+
+// ★ Compact tail: float32 FDL × float32 IR を double 累積バッファへ積和する。
+//    load 帯域は double 版の半分。積和自体は double へ昇格して行うため累積誤差は増えない。
+inline void accumulateSplitComplexF32(const float* srcAReal,
+                                      const float* srcAImag,
+                                      const float* srcBReal,
+                                      const float* srcBImag,
+                                      double* dstReal,
+                                      double* dstImag,
+                                      int complexSize) noexcept
+{
+    int k = 0;
+    const int vEnd = (complexSize / 4) * 4;
+    for (; k < vEnd; k += 4)
+    {
+        const __m256d ar = _mm256_cvtps_pd(_mm_loadu_ps(srcAReal + k));
+        const __m256d ai = _mm256_cvtps_pd(_mm_loadu_ps(srcAImag + k));
+        const __m256d br = _mm256_cvtps_pd(_mm_loadu_ps(srcBReal + k));
+        const __m256d bi = _mm256_cvtps_pd(_mm_loadu_ps(srcBImag + k));
+
+        __m256d dr = _mm256_loadu_pd(dstReal + k);
+        __m256d di = _mm256_loadu_pd(dstImag + k);
+
+        dr = _mm256_add_pd(dr, _mm256_sub_pd(_mm256_mul_pd(ar, br), _mm256_mul_pd(ai, bi)));
+        di = _mm256_add_pd(di, _mm256_add_pd(_mm256_mul_pd(ar, bi), _mm256_mul_pd(ai, br)));
+
+        _mm256_storeu_pd(dstReal + k, dr);
+        _mm256_storeu_pd(dstImag + k, di);
+    }
+
+    for (; k < complexSize; ++k)
+    {
+        const double ar = srcAReal[k], ai = srcAImag[k];
+        const double br = srcBReal[k], bi = srcBImag[k];
+        dstReal[k] += ar * br - ai * bi;
+        dstImag[k] += ar * bi + ai * br;
+    }
+}
+
+// ★ AVX-512: ビルド全体は /arch:AVX2 のため、関数単位で AVX-512F を有効化する (CONVO_TARGET_AVX512)。
+
+// ★ AVX-512F CMAC: 8 複素数/iter を FMA で積和し、端数は opmask load/store で処理する (スカラー tail なし)。
+//    FMA 縮約のため AVX2 版 (mul + sub/add) とは最下位ビットで差が出るが、精度はむしろ高い。
+CONVO_TARGET_AVX512 static void accumulateSplitComplexAvx512(const double* srcAReal,
+                                                             const double* srcAImag,
+                                                             const double* srcBReal,
+                                                             const double* srcBImag,
+                                                             double* dstReal,
+                                                             double* dstImag,
+                                                             int complexSize) noexcept
+{
+    int k = 0;
+    const int vEnd = (complexSize / 8) * 8;
+    for (; k < vEnd; k += 8)
+    {
+        // AVX2 版と同じく SoA 行オフセットが 64 バイト境界に乗らないため全ポインタ unaligned
+        const __m512d ar = _mm512_loadu_pd(srcAReal + k);
+        const __m512d ai = _mm512_loadu_pd(srcAImag + k);
+        const __m512d br = _mm512_loadu_pd(srcBReal + k);
+        const __m512d bi = _mm512_loadu_pd(srcBImag + k);
+
+        __m512d dr = _mm512_loadu_pd(dstReal + k);
+        __m512d di = _mm512_loadu_pd(dstImag + k);
+
+        dr = _mm512_fnmadd_pd(ai, bi, _mm512_fmadd_pd(ar, br, dr));
+        di = _mm512_fmadd_pd(ai, br, _mm512_fmadd_pd(ar, bi, di));
+
+        _mm512_storeu_pd(dstReal + k, dr);
+        _mm512_storeu_pd(dstImag + k, di);
+    }
+
+    if (k < complexSize)
+    {
+        const __mmask8 m = static_cast<__mmask8>((1u << (complexSize - k)) - 1u);
+        const __m512d ar = _mm512_maskz_loadu_pd(m, srcAReal + k);
+        const __m512d ai = _mm512_maskz_loadu_pd(m, srcAImag + k);
+        const __m512d br = _mm512_maskz_loadu_pd(m, srcBReal + k);
+        const __m512d bi = _mm512_maskz_loadu_pd(m, srcBImag + k);
+
+        __m512d dr = _mm512_maskz_loadu_pd(m, dstReal + k);
+        __m512d di = _mm512_maskz_loadu_pd(m, dstImag + k);
+
+        dr = _mm512_fnmadd_pd(ai, bi, _mm512_fmadd_pd(ar, br, dr));
+        di = _mm512_fmadd_pd(ai, br, _mm512_fmadd_pd(ar, bi, di));
+
+        _mm512_mask_storeu_pd(dstReal + k, m, dr);
+        _mm512_mask_storeu_pd(dstImag + k, m, di);
+    }
+}
+
+// ★ Stereo 版 AVX-512F: IR を 1 回 load し L/R 両 FDL と積和する。
+CONVO_TARGET_AVX512 static void accumulateSplitComplexStereoAvx512(const double* srcLReal,
+                                                                   const double* srcLImag,
+                                                                   const double* srcRReal,
+                                                                   const double* srcRImag,
+                                                                   const double* irReal,
+                                                                   const double* irImag,
+                                                                   double* dstLReal,
+                                                                   double* dstLImag,
+                                                                   double* dstRReal,
+                                                                   double* dstRImag,
+                                                                   int complexSize) noexcept
+{
+    int k = 0;
+    const int vEnd = (complexSize / 8) * 8;
+    for (; k < vEnd; k += 8)
+    {
+        const __m512d br = _mm512_loadu_pd(irReal + k);
+        const __m512d bi = _mm512_loadu_pd(irImag + k);
+
+        const __m512d lr = _mm512_loadu_pd(srcLReal + k);
+        const __m512d li = _mm512_loadu_pd(srcLImag + k);
+        __m512d dlr = _mm512_loadu_pd(dstLReal + k);
+        __m512d dli = _mm512_loadu_pd(dstLImag + k);
+        dlr = _mm512_fnmadd_pd(li, bi, _mm512_fmadd_pd(lr, br, dlr));
+        dli = _mm512_fmadd_pd(li, br, _mm512_fmadd_pd(lr, bi, dli));
+        _mm512_storeu_pd(dstLReal + k, dlr);
+        _mm512_storeu_pd(dstLImag + k, dli);
+
+        const __m512d rr = _mm512_loadu_pd(srcRReal + k);
+        const __m512d ri = _mm512_loadu_pd(srcRImag + k);
+        __m512d drr = _mm512_loadu_pd(dstRReal + k);
+        __m512d dri = _mm512_loadu_pd(dstRImag + k);
+        drr = _mm512_fnmadd_pd(ri, bi, _mm512_fmadd_pd(rr, br, drr));
+        dri = _mm512_fmadd_pd(ri, br, _mm512_fmadd_pd(rr, bi, dri));
+        _mm512_storeu_pd(dstRReal + k, drr);
+        _mm512_storeu_pd(dstRImag + k, dri);
+    }
+
+    for (; k < complexSize; ++k)
+    {
+        dstLReal[k] += srcLReal[k] * irReal[k] - srcLImag[k] * irImag[k];
+        dstLImag[k] += srcLReal[k] * irImag[k] + srcLImag[k] * irReal[k];
+        dstRReal[k] += srcRReal[k] * irReal[k] - srcRImag[k] * irImag[k];
+        dstRImag[k] += srcRReal[k] * irImag[k] + srcRImag[k] * irReal[k];
+    }
+}
+
+// ★ CMAC カーネル選択状態。静的初期化時に CPU 検出結果で決定し、以降はベンチマークのみが書き換える。
+//    Audio Thread からは relaxed load のみ (カーネル切替は結果の数値のみに影響し、同期不要)。
+static std::atomic<uint8_t> gCmacKernel {
+    static_cast<uint8_t>(hasAVX512Support() ? MKLNonUniformConvolver::CmacKernel::Avx512
+                                            : MKLNonUniformConvolver::CmacKernel::Avx2)
+};
+
+inline bool useAvx512Cmac() noexcept
+{
+    return convo::consumeAtomic(gCmacKernel, std::memory_order_relaxed)  // relaxed: カーネル選択フラグのみ (データ公開なし)
+        == static_cast<uint8_t>(MKLNonUniformConvolver::CmacKernel::Avx512);
+}
+
+inline void accumulateSplitComplex(const double* srcAReal,
+                                   const double* srcAImag,
+                                   const double* srcBReal,
+                                   const double* srcBImag,
+                                   double* dstReal,
+                                   double* dstImag,
+                                   int complexSize) noexcept
+{
+    if (useAvx512Cmac())
+        accumulateSplitComplexAvx512(srcAReal, srcAImag, srcBReal, srcBImag, dstReal, dstImag, complexSize);
+    else
+        accumulateSplitComplexAvx2(srcAReal, srcAImag, srcBReal, srcBImag, dstReal, dstImag, complexSize);
+}
+
+// ★ Stereo: 同一 IR パーティション (irRe/irIm) を L/R 2 本の FDL に対して 1 回の load で積算する。
+inline void accumulateSplitComplexStereo(const double* srcLReal,
+                                         const double* srcLImag,
+                                         const double* srcRReal,
+                                         const double* srcRImag,
+                                         const double* irReal,
+                                         const double* irImag,
+                                         double* dstLReal,
+                                         double* dstLImag,
+                                         double* dstRReal,
+                                         double* dstRImag,
+                                         int complexSize) noexcept
+{
+    if (useAvx512Cmac())
+    {
+        accumulateSplitComplexStereoAvx512(srcLReal, srcLImag, srcRReal, srcRImag, irReal, irImag,
+                                           dstLReal, dstLImag, dstRReal, dstRImag, complexSize);
+        return;
+    }
+
+    int k = 0;
+    const int vEnd = (complexSize / 4) * 4;
+    for (; k < vEnd; k += 4)
+    {
+        // accumulateSplitComplex と同じく全ポインタ unaligned アクセス
+        const __m256d br = _mm256_loadu_pd(irReal + k);
+        const __m256d bi = _mm256_loadu_pd(irImag + k);
+
+        const __m256d lr = _mm256_loadu_pd(srcLReal + k);
+        const __m256d li = _mm256_loadu_pd(srcLImag + k);
+        __m256d dlr = _mm256_loadu_pd(dstLReal + k);
+        __m256d dli = _mm256_loadu_pd(dstLImag + k);
+        dlr = _mm256_add_pd(dlr, _mm256_sub_pd(_mm256_mul_pd(lr, br), _mm256_mul_pd(li, bi)));
+        dli = _mm256_add_pd(dli, _mm256_add_pd(_mm256_mul_pd(lr, bi), _mm256_mul_pd(li, br)));
+        _mm256_storeu_pd(dstLReal + k, dlr);
+        _mm256_storeu_pd(dstLImag + k, dli);
+
+        const __m256d rr = _mm256_loadu_pd(srcRReal + k);
+        const __m256d ri = _mm256_loadu_pd(srcRImag + k);
+        __m256d drr = _mm256_loadu_pd(dstRReal + k);
+        __m256d dri = _mm256_loadu_pd(dstRImag + k);
+        drr = _mm256_add_pd(drr, _mm256_sub_pd(_mm256_mul_pd(rr, br), _mm256_mul_pd(ri, bi)));
+        dri = _mm256_add_pd(dri, _mm256_add_pd(_mm256_mul_pd(rr, bi), _mm256_mul_pd(ri, br)));
+        _mm256_storeu_pd(dstRReal + k, drr);
+        _mm256_storeu_pd(dstRImag + k, dri);
+    }
+
+    for (; k < complexSize; ++k)
+    {
+        dstLReal[k] += srcLReal[k] * irReal[k] - srcLImag[k] * irImag[k];
+        dstLImag[k] += srcLReal[k] * irImag[k] + srcLImag[k] * irReal[k];
+        dstRReal[k] += srcRReal[k] * irReal[k] - srcRImag[k] * irImag[k];
+        dstRImag[k] += srcRReal[k] * irImag[k] + srcRImag[k] * irReal[k];
+    }
+}
+
+// ★ True-stereo: L/R の FDL を 1 回ずつ load し、4 本の IR (LL/RL → 出力 L, RR/LR → 出力 R) と積算する。
+inline void accumulateSplitComplexTrueStereo(const double* srcLReal, const double* srcLImag,
+                                             const double* srcRReal, const double* srcRImag,
+                                             const double* llReal, const double* llImag,
+                                             const double* rlReal, const double* rlImag,
+                                             const double* rrReal, const double* rrImag,
+                                             const double* lrReal, const double* lrImag,
+                                             double* dstLReal, double* dstLImag,
+                                             double* dstRReal, double* dstRImag,
+                                             int complexSize) noexcept
+{
+    auto cmacV = [](__m256d& dr, __m256d& di, __m256d ar, __m256d ai, __m256d br, __m256d bi) noexcept
+    {
+        dr = _mm256_add_pd(dr, _mm256_sub_pd(_mm256_mul_pd(ar, br), _mm256_mul_pd(ai, bi)));
+        di = _mm256_add_pd(di, _mm256_add_pd(_mm256_mul_pd(ar, bi), _mm256_mul_pd(ai, br)));
+    };
+
+    int k = 0;
+    const int vEnd = (complexSize / 4) * 4;
+    for (; k < vEnd; k += 4)
+    {
+        const __m256d xlr = _mm256_loadu_pd(srcLReal + k);
+        const __m256d xli = _mm256_loadu_pd(srcLImag + k);
+        const __m256d xrr = _mm256_loadu_pd(srcRReal + k);
+        const __m256d xri = _mm256_loadu_pd(srcRImag + k);
+
+        __m256d dlr = _mm256_loadu_pd(dstLReal + k);
+        __m256d dli = _mm256_loadu_pd(dstLImag + k);
+        cmacV(dlr, dli, xlr, xli, _mm256_loadu_pd(llReal + k), _mm256_loadu_pd(llImag + k));
+        cmacV(dlr, dli, xrr, xri, _mm256_loadu_pd(rlReal + k), _mm256_loadu_pd(rlImag + k));
+        _mm256_storeu_pd(dstLReal + k, dlr);
+        _mm256_storeu_pd(dstLImag + k, dli);
+
+        __m256d drr = _mm256_loadu_pd(dstRReal + k);
+        __m256d dri = _mm256_loadu_pd(dstRImag + k);
+        cmacV(drr, dri, xrr, xri, _mm256_loadu_pd(rrReal + k), _mm256_loadu_pd(rrImag + k));
+        cmacV(drr, dri, xlr, xli, _mm256_loadu_pd(lrReal + k), _mm256_loadu_pd(lrImag + k));
+        _mm256_storeu_pd(dstRReal + k, drr);
+        _mm256_storeu_pd(dstRImag + k, dri);
+    }
+
+    for (; k < complexSize; ++k)
+    {
+        dstLReal[k] += srcLReal[k] * llReal[k] - srcLImag[k] * llImag[k]
+                     + srcRReal[k] * rlReal[k] - srcRImag[k] * rlImag[k];
+        dstLImag[k] += srcLReal[k] * llImag[k] + srcLImag[k] * llReal[k]
+                     + srcRReal[k] * rlImag[k] + srcRImag[k] * rlReal[k];
+        dstRReal[k] += srcRReal[k] * rrReal[k] - srcRImag[k] * rrImag[k]
+                     + srcLReal[k] * lrReal[k] - srcLImag[k] * lrImag[k];
+        dstRImag[k] += srcRReal[k] * rrImag[k] + srcRImag[k] * rrReal[k]
+                     + srcLReal[k] * lrImag[k] + srcLImag[k] * lrReal[k];
+    }
+}
+
+// ★ GetMix: 連続区間で wet ソースを合算し、有限チェックと dry/wet ミックスまでを 1 パスで書く。
+//   合算順 (L0 → direct → L1 → L2) と乗算・加算の並びは Get() + 旧ミックスパスと同一で、結果はビット一致する。
+//   src[k] は区間内で連続していること (リング折り返しは呼び出し側で区間を切る)。dst == dry 可
+template <bool PerSampleWet, bool PerSampleDry>
+inline void mixWetSourcesAvx2(double* dst, const double* dry,
+                              const double* const* src, const double* srcGain, int numSrc,
+                              const double* wetGain, const double* dryGain,
+                              double wetConst, double dryConst, int n) noexcept
+{
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d limit = _mm256_set1_pd(1.0e300);
+    const __m256d vWetConst = _mm256_set1_pd(wetConst);
+    const __m256d vDryConst = _mm256_set1_pd(dryConst);
+
+    int i = 0;
+    const int vEnd = n / 4 * 4;
+    for (; i < vEnd; i += 4)
+    {
+        __m256d wet = _mm256_setzero_pd();
+        for (int k = 0; k < numSrc; ++k)
+            wet = _mm256_add_pd(wet, _mm256_mul_pd(_mm256_loadu_pd(src[k] + i), _mm256_set1_pd(srcGain[k])));
+
+        // NaN は順序比較で偽になるため Inf / NaN / 過大値がまとめて 0 になる
+        const __m256d valid = _mm256_cmp_pd(_mm256_andnot_pd(signMask, wet), limit, _CMP_LT_OQ);
+        wet = _mm256_and_pd(wet, valid);
+
+        const __m256d wg = PerSampleWet ? _mm256_loadu_pd(wetGain + i) : vWetConst;
+        const __m256d dg = PerSampleDry ? _mm256_loadu_pd(dryGain + i) : vDryConst;
+        _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_mul_pd(wet, wg), _mm256_mul_pd(_mm256_loadu_pd(dry + i), dg)));
+    }
+    for (; i < n; ++i)
+    {
+        double wet = 0.0;
+        for (int k = 0; k < numSrc; ++k)
+            wet += src[k][i] * srcGain[k];
+        if (!(absNoLibm(wet) < 1.0e300))
+            wet = 0.0;
+
+        const double wg = PerSampleWet ? wetGain[i] : wetConst;
+        const double dg = PerSampleDry ? dryGain[i] : dryConst;
+        dst[i] = wet * wg + dry[i] * dg;
+    }
+}
 } // namespace
 
 //==============================================================================
@@ -326,9 +590,8 @@ void logIrRelease(
 void MKLNonUniformConvolver::Layer::freeAll() noexcept
 {
     // [v2.2] FFT plan はサイズ単位の共有キャッシュ管理。
-    // レイヤー側は所有権のみ解放し、スペック実体はキャッシュ側で保持する。
-    fftPlanOwner.reset();
-    fftSpec = nullptr;
+    // レイヤー側は参照のみ外し、プラン実体はキャッシュ側で保持する。
+    fftPlan = nullptr;
     if (fftWorkBuf)
     {
         ippsFree(fftWorkBuf);
@@ -339,6 +602,14 @@ void MKLNonUniformConvolver::Layer::freeAll() noexcept
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
     // ★ work70: freeTracked を使用（allocSizes からサイズ取得）
     freeTracked(irFreqDomain,  allocSizes.irFreqDomain);
+    if (irSpectraShared)  // ★ Shared spectra: IR スペクトル・無音マスクは SharedSpectra 側で解放
+    {
+        irFreqReal = nullptr;  irFreqImag = nullptr;
+        irFreqRealF = nullptr; irFreqImagF = nullptr;
+        partSilent = nullptr;
+    }
+    crossIrFreqReal = nullptr;  // ★ True-stereo: クロスパスは m_crossSpectra の所有物
+    crossIrFreqImag = nullptr;
     freeTracked(irFreqReal,    allocSizes.irFreqReal);
     freeTracked(irFreqImag,    allocSizes.irFreqImag);
     freeTracked(fdlBuf,        allocSizes.fdlBuf);
@@ -353,9 +624,30 @@ void MKLNonUniformConvolver::Layer::freeAll() noexcept
     freeTracked(inputAccBuf,   allocSizes.inputAccBuf);
     freeTracked(tailOutputBuf, allocSizes.tailOutputBuf);
     freeTracked(delayLineBuf,  allocSizes.delayLineBuf);   // ★ Bug#1 B13 delayLineBuf 追跡
+    freeTracked(jobInputBuf,   allocSizes.jobInputBuf);
+    freeTracked(jobOutputBuf,  allocSizes.jobOutputBuf);
+    freeTracked(irFreqRealF,   allocSizes.irFreqRealF);
+    freeTracked(irFreqImagF,   allocSizes.irFreqImagF);
+    freeTracked(fdlRealF,      allocSizes.fdlRealF);
+    freeTracked(fdlImagF,      allocSizes.fdlImagF);
+    freeTracked(partSilent,    allocSizes.partSilent);
+    freeTracked(fadeAccumReal, allocSizes.fadeAccum);
+    freeTracked(fadeAccumImag, allocSizes.fadeAccum);
+    freeTracked(morphAccumReal, allocSizes.morphAccum);
+    freeTracked(morphAccumImag, allocSizes.morphAccum);
+    freeTracked(rateInputBuf,  allocSizes.rateInputBuf);
+    freeTracked(rateOutputBuf, allocSizes.rateOutputBuf);
     allocSizes = {};
 #else
     if (irFreqDomain)  { mkl_free(irFreqDomain);  irFreqDomain  = nullptr; }
+    if (irSpectraShared)  // ★ Shared spectra: IR スペクトル・無音マスクは SharedSpectra 側で解放
+    {
+        irFreqReal = nullptr;  irFreqImag = nullptr;
+        irFreqRealF = nullptr; irFreqImagF = nullptr;
+        partSilent = nullptr;
+    }
+    crossIrFreqReal = nullptr;  // ★ True-stereo: クロスパスは m_crossSpectra の所有物
+    crossIrFreqImag = nullptr;
     if (irFreqReal)    { mkl_free(irFreqReal);    irFreqReal    = nullptr; }
     if (irFreqImag)    { mkl_free(irFreqImag);    irFreqImag    = nullptr; }
     if (fdlBuf)        { mkl_free(fdlBuf);         fdlBuf        = nullptr; }
@@ -370,7 +662,37 @@ void MKLNonUniformConvolver::Layer::freeAll() noexcept
     if (inputAccBuf)   { mkl_free(inputAccBuf);    inputAccBuf   = nullptr; }
     if (tailOutputBuf) { mkl_free(tailOutputBuf);  tailOutputBuf = nullptr; }
     if (delayLineBuf)  { mkl_free(delayLineBuf);   delayLineBuf  = nullptr; }
+    if (jobInputBuf)   { mkl_free(jobInputBuf);    jobInputBuf   = nullptr; }
+    if (jobOutputBuf)  { mkl_free(jobOutputBuf);   jobOutputBuf  = nullptr; }
+    if (irFreqRealF)   { mkl_free(irFreqRealF);    irFreqRealF   = nullptr; }
+    if (irFreqImagF)   { mkl_free(irFreqImagF);    irFreqImagF   = nullptr; }
+    if (fdlRealF)      { mkl_free(fdlRealF);       fdlRealF      = nullptr; }
+    if (fdlImagF)      { mkl_free(fdlImagF);       fdlImagF      = nullptr; }
+    if (partSilent)    { mkl_free(partSilent);     partSilent    = nullptr; }
+    if (fadeAccumReal) { mkl_free(fadeAccumReal);  fadeAccumReal = nullptr; }
+    if (fadeAccumImag) { mkl_free(fadeAccumImag);  fadeAccumImag = nullptr; }
+    if (morphAccumReal) { mkl_free(morphAccumReal); morphAccumReal = nullptr; }
+    if (morphAccumImag) { mkl_free(morphAccumImag); morphAccumImag = nullptr; }
+    if (rateInputBuf)  { mkl_free(rateInputBuf);   rateInputBuf  = nullptr; }
+    if (rateOutputBuf) { mkl_free(rateOutputBuf);  rateOutputBuf = nullptr; }
 #endif
+    numSilentParts = 0;
+
+    // ★ Spectral crossfade: フェード先スペクトルは m_fadeSpectra の所有物
+    fadeIrFreqReal = fadeIrFreqImag = nullptr;
+    fadeIrFreqRealF = fadeIrFreqImagF = nullptr;
+    fadePartSilent = nullptr;
+    fadeNumSilentParts = 0;
+    fadeSteps = fadeStep = 0;
+    fadeActive = false;
+
+    // ★ Spectral morph: モーフ先スペクトルは m_morphSpectra の所有物
+    morphIrFreqReal = morphIrFreqImag = nullptr;
+    morphIrFreqRealF = morphIrFreqImagF = nullptr;
+    morphPartSilent = nullptr;
+    morphStep = 1.0;
+    morphAmount = 0.0;
+    morphActive = false;
 
     outputDelaySamples = 0;
     delayLineCapacity  = 0;
@@ -383,7 +705,23 @@ void MKLNonUniformConvolver::Layer::freeAll() noexcept
     tailOutputPos    = 0;
     baseFdlIdxSaved  = 0;
     distributing     = false;
+    silentFdlRun     = 0;
+    prevInputSilent  = false;
     isImmediate      = false;
+    irSpectraShared  = false;
+    compactSpectra   = false;
+    binMajor         = false;
+    pager            = nullptr;   // SharedSpectra の所有物
+    pagerSlot        = -1;
+    pagedParts       = 0;
+    pagerMayFault    = false;
+    decimation       = 1;
+    rateDown.release();
+    rateUp.release();
+
+    convo::publishAtomic(jobSubmitted, uint64_t { 0 }, std::memory_order_relaxed); // relaxed: ワーカー停止後のみ呼ばれる
+    convo::publishAtomic(jobCompleted, uint64_t { 0 }, std::memory_order_relaxed); // relaxed: 同上
+    jobCollected = 0;
 }
 
 //==============================================================================
@@ -414,45 +752,29 @@ MKLNonUniformConvolver::~MKLNonUniformConvolver()
 }
 
 //==============================================================================
-// applySpectrumFilter  ─ Message Thread のみ
+// fillSpectrumGain  ─ 任意スレッド (純関数)
+//   SetImpulse が layerIndex 番目のレイヤーの IR スペクトルに掛ける実数ゲインを gain[0..complexSize) へ書き込む。
+//   HC/LC (hasFilter) と Air Absorption の HF ダンピング (airTilt, L1/L2 のみ) の積。
 //==============================================================================
-void MKLNonUniformConvolver::applySpectrumFilter(const FilterSpec& spec) noexcept
+void MKLNonUniformConvolver::fillSpectrumGain(const SpectrumGainParams& p, int layerIndex, int fftSize, int complexSize,
+                                              double* gain) noexcept
 {
-    const double fs      = spec.sampleRate;
-    const double nyquist = fs * 0.5;
-
-    const double hcFcStart = (fs <= 48000.0) ? 18000.0 : 22000.0;
-    const double hcFcEnd   = nyquist;
-
-    const double lcFcEnd   = (spec.lcMode == LCMode::Soft) ?  6.0 :  8.0;
-    const double lcFcStart = (spec.lcMode == LCMode::Soft) ? 15.0 : 18.0;
+    const int N      = fftSize;
+    const int halfN  = N / 2;
+    const int cSize  = complexSize;
 
-    convo::ScopedAlignedPtr<double> reusableGain;
-    int reusableGainCapacity = 0;
+    std::fill_n(gain, cSize, 1.0);
 
-    for (int li = 0; li < m_numActiveLayers; ++li)
+    if (p.hasFilter)
     {
-        Layer& l = m_layers[li];
-        if (!l.irFreqReal || !l.irFreqImag) continue;
+        const double fs      = p.sampleRate;
+        const double nyquist = fs * 0.5;
 
-        const int N      = l.fftSize;
-        const int halfN  = N / 2;
-        const int cSize  = l.complexSize;
+        const double hcFcStart = (fs <= 48000.0) ? 18000.0 : 22000.0;
+        const double hcFcEnd   = nyquist;
 
-        if (reusableGainCapacity < cSize || reusableGain.get() == nullptr)
-        {
-            reusableGain.reset(static_cast<double*>(mkl_malloc(static_cast<size_t>(cSize) * sizeof(double), 64)));
-            reusableGainCapacity = (reusableGain.get() != nullptr) ? cSize : 0;
-        }
-        if (!reusableGain.get())
-        {
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-            juce::Logger::writeToLog("MKLNonUniformConvolver: OOM in applySpectrumFilter for layer " + juce::String(li));
-#endif
-            continue;
-        }
-        double* gain = reusableGain.get();
-        std::fill_n(gain, cSize, 1.0);
+        const double lcFcEnd   = (p.lcMode == LCMode::Soft) ?  6.0 :  8.0;
+        const double lcFcStart = (p.lcMode == LCMode::Soft) ? 15.0 : 18.0;
 
         // ── HC ゲイン ──
         {
@@ -471,7 +793,7 @@ void MKLNonUniformConvolver::applySpectrumFilter(const FilterSpec& spec) noexcep
                     const double denom = static_cast<double>(kEnd - kStart);
                     const double x     = static_cast<double>(k - kStart) / denom;
 
-                    switch (spec.hcMode)
+                    switch (p.hcMode)
                     {
                     case HCMode::Sharp:
                         gain[k] = 1.0 / std::sqrt(1.0 + std::pow(x, 8.0));
@@ -512,6 +834,58 @@ void MKLNonUniformConvolver::applySpectrumFilter(const FilterSpec& spec) noexcep
                 }
             }
         }
+    }
+
+    // ── Air Absorption: L1/L2 の HF ダンピング ──
+    if (p.airTilt && layerIndex > 0)
+    {
+        const double layerWeight = (layerIndex == 1) ? 1.0 : 1.6;
+        const double dampingCoeff = p.airDampingBase * layerWeight;
+        // フルレートの Nyquist で正規化する (Multirate tail のレイヤーは cSize - 1 < halfN)
+        const double denom = static_cast<double>(std::max(1, halfN));
+        for (int k = 0; k < cSize; ++k)
+        {
+            const double fNorm = static_cast<double>(k) / denom;
+            gain[k] *= std::exp(-dampingCoeff * fNorm * fNorm);
+        }
+    }
+}
+
+//==============================================================================
+// applySpectrumFilter  ─ Message Thread のみ
+//==============================================================================
+void MKLNonUniformConvolver::applySpectrumFilter(const FilterSpec& spec) noexcept
+{
+    SpectrumGainParams params;
+    params.hasFilter  = true;
+    params.sampleRate = spec.sampleRate;
+    params.hcMode     = spec.hcMode;
+    params.lcMode     = spec.lcMode;
+
+    convo::ScopedAlignedPtr<double> reusableGain;
+    int reusableGainCapacity = 0;
+
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        if (!l.irFreqReal || !l.irFreqImag) continue;
+
+        const int cSize  = l.complexSize;
+
+        if (reusableGainCapacity < cSize || reusableGain.get() == nullptr)
+        {
+            reusableGain.reset(static_cast<double*>(mkl_malloc(static_cast<size_t>(cSize) * sizeof(double), 64)));
+            reusableGainCapacity = (reusableGain.get() != nullptr) ? cSize : 0;
+        }
+        if (!reusableGain.get())
+        {
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+            juce::Logger::writeToLog("MKLNonUniformConvolver: OOM in applySpectrumFilter for layer " + juce::String(li));
+#endif
+            continue;
+        }
+        double* gain = reusableGain.get();
+        fillSpectrumGain(params, li, l.fftSize * l.decimation, cSize, gain);
 
         // [Mem-Fix] gain[] は実数値(振幅のみ)のフィルタなので、実部・虚部それぞれに
         // 同一ゲインを掛けるだけでよい。interleave/deinterleaveもAoS経由も不要。
@@ -526,1127 +900,4075 @@ void MKLNonUniformConvolver::applySpectrumFilter(const FilterSpec& spec) noexcep
 }
 
 //==============================================================================
-void MKLNonUniformConvolver::releaseAllLayers() noexcept
+// applyAirAbsorptionTilt  ─ Message Thread のみ (tailMode 0、applySpectrumFilter の後)
+//==============================================================================
+void MKLNonUniformConvolver::applyAirAbsorptionTilt(double dampingBase) noexcept
 {
-    #ifdef NUC_DEBUG_GUARDS
-        checkGuards();
-        // ... 既存の checkPtr 群（変更なし）...
-        auto checkPtr = [](double *&ptr){
-            if (ptr != nullptr){
-                auto addr = reinterpret_cast<uintptr_t>(ptr);
-                if (addr == 0xFFFFFFFFFFFFFFFFULL ||
-                    (addr & 0xFFFFFFFF00000000) == 0xCDCDCDCD00000000ULL ||
-                     addr < 0x10000)
-            {
-                __debugbreak();
-            }
-        }
-    };
-    checkPtr(m_ringBuf);
-    checkPtr(m_directIRRev);
-    checkPtr(m_directHistory);
-    checkPtr(m_directWindow);
-    checkPtr(m_directOutBuf);
-    #endif
+    SpectrumGainParams params;
+    params.airTilt        = true;
+    params.airDampingBase = dampingBase;
 
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-    // ★ work70: 解放前にスナップショットとサイズを取得
-    const uint64_t beforeMkl = convo::diag::allocatedBytes();
-    const uint32_t beforeLost = convo::diag::lostFreeCount();
-    const auto beforeOs = getProcessMemoryInfo();
+    for (int li = 1; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        if (!l.irFreqReal || !l.irFreqImag || l.complexSize <= 0)
+            continue;
 
-    // 解放前の NUC 状態を取得（TotalBefore / LayersBefore 用）
-    // ★ freeAll で Layer が初期化される前に呼ぶこと
-    NucDiagnosticsSnapshot beforeSnap;
-    beforeSnap.numActiveLayers = m_numActiveLayers;
-    beforeSnap.isReady = convo::consumeAtomic(m_ready, std::memory_order_acquire);
-    for (int li = 0; li < kNumLayers; ++li) {
-        const Layer& l = m_layers[li];
-        uint64_t irF = 0, fdl = 0, acc = 0, tail = 0;
-        irF += addIfAlive(l.irFreqDomain, l.allocSizes.irFreqDomain, "irFreqDomain");
-        irF += addIfAlive(l.irFreqReal,   l.allocSizes.irFreqReal,   "irFreqReal");
-        irF += addIfAlive(l.irFreqImag,   l.allocSizes.irFreqImag,   "irFreqImag");
-        fdl += addIfAlive(l.fdlBuf,       l.allocSizes.fdlBuf,       "fdlBuf");
-        fdl += addIfAlive(l.fdlReal,      l.allocSizes.fdlReal,      "fdlReal");
-        fdl += addIfAlive(l.fdlImag,      l.allocSizes.fdlImag,      "fdlImag");
-        acc += addIfAlive(l.fftTimeBuf,   l.allocSizes.fftTimeBuf,   "fftTimeBuf");
-        acc += addIfAlive(l.fftOutBuf,    l.allocSizes.fftOutBuf,    "fftOutBuf");
-        acc += addIfAlive(l.prevInputBuf, l.allocSizes.prevInputBuf, "prevInputBuf");
-        acc += addIfAlive(l.accumBuf,     l.allocSizes.accumBuf,     "accumBuf");
-        acc += addIfAlive(l.accumReal,    l.allocSizes.accumReal,    "accumReal");
-        acc += addIfAlive(l.accumImag,    l.allocSizes.accumImag,    "accumImag");
-        acc += addIfAlive(l.inputAccBuf,  l.allocSizes.inputAccBuf,  "inputAccBuf");
-        tail += addIfAlive(l.tailOutputBuf,l.allocSizes.tailOutputBuf,"tailOutputBuf");
-        beforeSnap.layerBufs[li] = irF + fdl + acc + tail;
-        beforeSnap.irFreqBytes   += irF;
-        beforeSnap.fdlBytes      += fdl;
-        beforeSnap.accumBytes    += acc;
-        beforeSnap.tailBytes     += tail;
-    }
-    const uint32_t liveBefore = liveCount.load(std::memory_order_relaxed);
-
-    // NUC レベルバッファの解放サイズを事前退避（ガード後、解放前に）
-    const size_t ringBufBytes    = static_cast<size_t>(m_ringSize) * sizeof(double);
-    const size_t directIRBytes   = static_cast<size_t>(m_directTapCount) * sizeof(double);
-    const size_t directHistBytes = static_cast<size_t>(m_directHistLen) * sizeof(double);
-    const size_t directWinBytes  = static_cast<size_t>(m_directHistLen + m_directMaxBlock) * sizeof(double);
-    const size_t directOutBytes  = static_cast<size_t>(m_directMaxBlock) * sizeof(double);
-#endif
+        // [Mem-Fix] gain は実数値(振幅のみ)のためinterleaved配列は不要。
+        convo::ScopedAlignedPtr<double> gainReal(
+            static_cast<double*>(mkl_malloc(static_cast<size_t>(l.complexSize) * sizeof(double), 64)));
+        if (!gainReal.get())
+            continue;
 
-    for (int i = 0; i < kNumLayers; ++i)
-        m_layers[i].freeAll();
-    m_numActiveLayers = 0;
-    m_latency         = 0;
+        fillSpectrumGain(params, li, l.fftSize * l.decimation, l.complexSize, gainReal.get());
 
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-    // ★ work70: NUC レベルバッファも freeTracked で解放
-    freeTracked(m_ringBuf,       ringBufBytes);
-    freeTracked(m_directIRRev,   directIRBytes);
-    freeTracked(m_directHistory, directHistBytes);
-    freeTracked(m_directWindow,  directWinBytes);
-    freeTracked(m_directOutBuf,  directOutBytes);
-#else
-    if (m_ringBuf) { mkl_free(m_ringBuf); m_ringBuf = nullptr; }
-    if (m_directIRRev)   { mkl_free(m_directIRRev);   m_directIRRev = nullptr; }
-    if (m_directHistory) { mkl_free(m_directHistory); m_directHistory = nullptr; }
-    if (m_directWindow)  { mkl_free(m_directWindow);  m_directWindow = nullptr; }
-    if (m_directOutBuf)  { mkl_free(m_directOutBuf);  m_directOutBuf = nullptr; }
-#endif
+        // [Mem-Fix] SoA (irFreqReal/irFreqImag) に直接ゲインを適用する。
+        for (int p = 0; p < l.numParts; ++p)
+        {
+            double* re = l.irFreqReal + static_cast<size_t>(p) * l.complexSize;
+            double* im = l.irFreqImag + static_cast<size_t>(p) * l.complexSize;
+            vdMul(l.complexSize, re, gainReal.get(), re);
+            vdMul(l.complexSize, im, gainReal.get(), im);
+        }
+    }
+}
 
-    m_ringSize = m_ringMask = m_ringWrite = m_ringRead = m_ringAvail = 0;
+//==============================================================================
+// buildRetuneRatio  ─ 任意スレッド (純関数)
+//   from で焼き込まれたスペクトルを to のゲインへ移す比 ratio[k] = g_to / g_from を求める。
+//   g_from がほぼ 0 で g_to が非 0 のビンは比で戻せないため ratio[k] = -g_to (直接 DFT で再計算) とし、
+//   その本数を返す。scratch は complexSize 分の作業領域。
+//==============================================================================
+int MKLNonUniformConvolver::buildRetuneRatio(const SpectrumGainParams& from, const SpectrumGainParams& to, int layerIndex,
+                                             int fftSize, int complexSize, double* ratio, double* scratch) noexcept
+{
+    constexpr double kMinInvertibleGain = 1.0e-12;
 
-    m_directTapCount = 0;
-    m_directHistLen  = 0;
-    m_directMaxBlock = 0;
-    m_directPendingSamples = 0;
-    m_directEnabled  = false;
+    fillSpectrumGain(from, layerIndex, fftSize, complexSize, scratch);
+    fillSpectrumGain(to,   layerIndex, fftSize, complexSize, ratio);
 
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-    const auto afterReleaseOs = getProcessMemoryInfo();
-    logIrRelease(this, kDiagSeqReserved,
-                 beforeMkl, beforeLost, beforeOs,
-                 beforeSnap, afterReleaseOs, liveBefore);
-#endif
-    m_tailEnabled = true;
-    m_tailStrength = 1.0;
-    for (int i = 0; i < kNumLayers; ++i)
-        m_tailLayerGain[i] = 1.0;
+    int recompute = 0;
+    for (int k = 0; k < complexSize; ++k)
+    {
+        if (scratch[k] > kMinInvertibleGain)
+            ratio[k] /= scratch[k];
+        else if (ratio[k] > kMinInvertibleGain)
+        {
+            ratio[k] = -ratio[k];
+            ++recompute;
+        }
+        else
+            ratio[k] = 0.0;
+    }
+    return recompute;
 }
 
 //==============================================================================
-// ★ work70: getDiagnostics  ─ Message Thread のみ
+// retuneLayerSpectra  ─ Message Thread のみ (SetImpulse、FFT の代替)
+//   donor スペクトル (double または float32) を l.irFreqReal/Imag へ写し ratio を掛ける。
+//   出力は常にパーティション優先 (ビンタイル化は SetImpulse 末尾で行う)。donor がタイル配置なら並べ直して読む。
+//   ratio[k] < 0 のビンは irSrc (Direct Head 除去済み IR) から直接 DFT で求め直し、-ratio[k] (新ゲイン) を掛ける。
+//   IPP 順方向 FFT (無正規化, e^{-i2πkn/N}) と同じ定義。
 //==============================================================================
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-NucDiagnosticsSnapshot MKLNonUniformConvolver::getDiagnostics() const noexcept
+void MKLNonUniformConvolver::retuneLayerSpectra(Layer& l, const double* donorRe, const double* donorIm,
+                                                const float* donorReF, const float* donorImF, bool donorBinMajor,
+                                                const double* ratio, const double* irSrc, int irRemain, double scale) noexcept
 {
-    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
-
-    NucDiagnosticsSnapshot snap{};
-    snap.numActiveLayers = m_numActiveLayers;
-    snap.isReady = convo::consumeAtomic(m_ready, std::memory_order_acquire);
-
-    for (int li = 0; li < kNumLayers; ++li)
+    for (int p = 0; p < l.numParts; ++p)
     {
-        const Layer& l = m_layers[li];
-        uint64_t irFreq = 0, fdl = 0, accum = 0, tail = 0;
+        const size_t off = static_cast<size_t>(p) * l.complexSize;
+        double* re = l.irFreqReal + off;
+        double* im = l.irFreqImag + off;
 
-        irFreq += addIfAlive(l.irFreqDomain, l.allocSizes.irFreqDomain, "irFreqDomain");
-        irFreq += addIfAlive(l.irFreqReal,   l.allocSizes.irFreqReal,   "irFreqReal");
-        irFreq += addIfAlive(l.irFreqImag,   l.allocSizes.irFreqImag,   "irFreqImag");
-        fdl    += addIfAlive(l.fdlBuf,       l.allocSizes.fdlBuf,       "fdlBuf");
-        fdl    += addIfAlive(l.fdlReal,      l.allocSizes.fdlReal,      "fdlReal");
-        fdl    += addIfAlive(l.fdlImag,      l.allocSizes.fdlImag,      "fdlImag");
-        accum  += addIfAlive(l.fftTimeBuf,   l.allocSizes.fftTimeBuf,   "fftTimeBuf");
-        accum  += addIfAlive(l.fftOutBuf,    l.allocSizes.fftOutBuf,    "fftOutBuf");
-        accum  += addIfAlive(l.prevInputBuf, l.allocSizes.prevInputBuf, "prevInputBuf");
-        accum  += addIfAlive(l.accumBuf,     l.allocSizes.accumBuf,     "accumBuf");
-        accum  += addIfAlive(l.accumReal,    l.allocSizes.accumReal,    "accumReal");
-        accum  += addIfAlive(l.accumImag,    l.allocSizes.accumImag,    "accumImag");
-        accum  += addIfAlive(l.inputAccBuf,  l.allocSizes.inputAccBuf,  "inputAccBuf");
-        tail   += addIfAlive(l.tailOutputBuf,l.allocSizes.tailOutputBuf,"tailOutputBuf");
+        if (donorBinMajor)
+        {
+            jassert(donorRe != nullptr);  // ビンタイル配置は double レイヤーのみ
+            for (int k = 0; k < l.complexSize; ++k)
+            {
+                const size_t src = convo::BinTileLayout::index(l.numParts, p, k, l.complexSize);
+                re[k] = donorRe[src];
+                im[k] = donorIm[src];
+            }
+        }
+        else if (donorRe != nullptr)
+        {
+            memcpy(re, donorRe + off, static_cast<size_t>(l.complexSize) * sizeof(double));
+            memcpy(im, donorIm + off, static_cast<size_t>(l.complexSize) * sizeof(double));
+        }
+        else
+        {
+            for (int k = 0; k < l.complexSize; ++k)
+            {
+                re[k] = static_cast<double>(donorReF[off + k]);
+                im[k] = static_cast<double>(donorImF[off + k]);
+            }
+        }
 
-        snap.layerBufs[li]  = irFreq + fdl + accum + tail;
-        snap.irFreqBytes   += irFreq;
-        snap.fdlBytes      += fdl;
-        snap.accumBytes    += accum;
-        snap.tailBytes     += tail;
-    }
+        for (int k = 0; k < l.complexSize; ++k)
+        {
+            if (ratio[k] >= 0.0)
+            {
+                re[k] *= ratio[k];
+                im[k] *= ratio[k];
+                continue;
+            }
 
-    snap.directBytes = addIfAlive(m_directIRRev,
-        static_cast<size_t>(m_directTapCount) * sizeof(double), "directIRRev");
-    snap.ringBytes   = addIfAlive(m_ringBuf,
-        static_cast<size_t>(m_ringSize) * sizeof(double), "ringBuf");
-    return snap;
+            double sumRe = 0.0, sumIm = 0.0;
+            const int copyStart = p * l.partSize;
+            const int copyLen   = (p < l.numPartsIR) ? std::min(l.partSize, irRemain - copyStart) : 0;
+            if (copyLen > 0)
+            {
+                // 回転因子は漸化式で進め、パーティション毎に初期化する (誤差 ~ partSize * eps)
+                const double w = -2.0 * juce::MathConstants<double>::pi * static_cast<double>(k) / static_cast<double>(l.fftSize);
+                const double stepRe = std::cos(w), stepIm = std::sin(w);
+                double twRe = 1.0, twIm = 0.0;
+                for (int n = 0; n < copyLen; ++n)
+                {
+                    const double x = irSrc[copyStart + n];
+                    sumRe += x * twRe;
+                    sumIm += x * twIm;
+                    const double nextRe = twRe * stepRe - twIm * stepIm;
+                    twIm = twRe * stepIm + twIm * stepRe;
+                    twRe = nextRe;
+                }
+            }
+            const double g = -ratio[k] * scale;
+            re[k] = sumRe * g;
+            im[k] = sumIm * g;
+        }
+    }
 }
-#endif
 
 //==============================================================================
-// SetImpulse  ─ Message Thread のみ
+// buildDirectHeadTaps  ─ Message Thread のみ (SetImpulse)
+//   Zero-latency head の係数を時間反転して irRev[0..taps) へ書き込む (taps = min(irLen, headTaps))。
+//   HC/LC は L0 と同じく 2·headTaps 点のビンゲインで掛ける (直接 DFT → ゲイン → 逆 DFT)。
+//   逆変換のうち後半 headTaps への回り込みは捨てる (L0 の各パーティションと同じ分解能での近似)。
+//   Air Absorption は L1/L2 のみなのでここでは掛からない。
 //==============================================================================
-bool MKLNonUniformConvolver::SetImpulse(const double* impulse, int irLen, int blockSize, double scale,
-                                        bool enableDirectHead,
-                                        const FilterSpec* filterSpec)
+bool MKLNonUniformConvolver::buildDirectHeadTaps(const double* impulse, int taps, int headTaps, double scale,
+                                                 const SpectrumGainParams& gains, double* irRev) noexcept
 {
-    convo::publishAtomic(m_ready, false, std::memory_order_release);
+    if (!gains.hasFilter)
+    {
+        for (int i = 0; i < taps; ++i)
+            irRev[i] = impulse[taps - 1 - i] * scale;
+        return true;
+    }
 
-    if (impulse == nullptr || irLen <= 0 || blockSize <= 0)
+    const int fftSize = headTaps * 2;
+    const int complexSize = headTaps + 1;
+    convo::ScopedAlignedPtr<double> specRe(static_cast<double*>(mkl_malloc(static_cast<size_t>(complexSize) * sizeof(double), 64)));
+    convo::ScopedAlignedPtr<double> specIm(static_cast<double*>(mkl_malloc(static_cast<size_t>(complexSize) * sizeof(double), 64)));
+    convo::ScopedAlignedPtr<double> gain(static_cast<double*>(mkl_malloc(static_cast<size_t>(complexSize) * sizeof(double), 64)));
+    if (!specRe.get() || !specIm.get() || !gain.get())
         return false;
 
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-    const uint64_t diagSeq   = globalDiagSeq.fetch_add(1, std::memory_order_relaxed) + kDiagSeqFirstRuntime;
-    const uint64_t beforeMkl = convo::diag::allocatedBytes();
-    const uint32_t beforeLost = convo::diag::lostFreeCount();
-#endif
-    releaseAllLayers();
-
-    // tailMode: 0=Air Absorption, 1=Layer Tail Contouring, 2=Bypass
-    const int tailMode = (filterSpec != nullptr) ? juce::jlimit(0, 2, filterSpec->tailMode) : 1;
-    const bool tailEnabled = (tailMode != 2) && ((filterSpec != nullptr) ? filterSpec->tailEnabled : true);
-    const double sampleRateForTail = (filterSpec != nullptr) ? filterSpec->sampleRate : 48000.0;
-    double tailStartSec = (filterSpec != nullptr) ? juce::jlimit(0.01, 0.80, filterSpec->tailStartSeconds) : 0.085;
-    const double userTailStrength = (filterSpec != nullptr) ? juce::jlimit(0.0, 2.0, filterSpec->tailStrength) : 1.0;
-    double tailStrength = userTailStrength;
-    int tailL1L2Mult = (filterSpec != nullptr) ? juce::jlimit(2, 16, filterSpec->tailL1L2Multiplier) : 8;
-
-    double layer1Gain = 1.0;
-    double layer2Gain = 1.0;
-
-    const double strength01 = juce::jlimit(0.0, 1.0, userTailStrength * 0.5);
+    fillSpectrumGain(gains, 0, fftSize, complexSize, gain.get());
 
-    // Tail profile redesign:
-    // - Air Absorption: tail gain is reduced by layer and HF damping is applied to L1/L2 spectra.
-    // - Layer Tail Contouring: enforce robust lower bounds and shape layer gains for contour clarity.
-    if (!tailEnabled)
+    // 回転因子は retuneLayerSpectra と同じ漸化式 (誤差 ~ headTaps * eps)
+    const double twoPiOverN = 2.0 * juce::MathConstants<double>::pi / static_cast<double>(fftSize);
+    for (int k = 0; k < complexSize; ++k)
     {
-        tailStrength = 0.0;
-        layer1Gain = 0.0;
-        layer2Gain = 0.0;
+        const double stepRe = std::cos(twoPiOverN * k), stepIm = -std::sin(twoPiOverN * k);
+        double twRe = 1.0, twIm = 0.0, sumRe = 0.0, sumIm = 0.0;
+        for (int n = 0; n < taps; ++n)
+        {
+            sumRe += impulse[n] * twRe;
+            sumIm += impulse[n] * twIm;
+            const double nextRe = twRe * stepRe - twIm * stepIm;
+            twIm = twRe * stepIm + twIm * stepRe;
+            twRe = nextRe;
+        }
+        specRe.get()[k] = sumRe * gain.get()[k];
+        specIm.get()[k] = sumIm * gain.get()[k];
     }
-    else if (tailMode == 0)
-    {
-        // Air Absorption mode: preserve early reflections while progressively damping late layers.
-        tailStartSec = juce::jlimit(0.01, 0.80, std::max(tailStartSec, 0.055));
-        tailL1L2Mult = juce::jlimit(2, 16, std::max(tailL1L2Mult, 6));
-        tailStrength = juce::jlimit(0.0, 2.0, userTailStrength);
 
-        layer1Gain = juce::jlimit(0.0, 2.0, tailStrength * (0.95 - 0.25 * strength01));
-        layer2Gain = juce::jlimit(0.0, 2.0, tailStrength * (0.80 - 0.45 * strength01));
+    // 実数信号の逆 DFT: x[n] = (X0 + (-1)^n X_{N/2} + 2 Σ Re(X_k e^{+i2πkn/N})) / N
+    for (int n = 0; n < taps; ++n)
+    {
+        const double stepRe = std::cos(twoPiOverN * n), stepIm = std::sin(twoPiOverN * n);
+        double twRe = stepRe, twIm = stepIm;
+        double sum = specRe.get()[0] + ((n & 1) ? -specRe.get()[headTaps] : specRe.get()[headTaps]);
+        for (int k = 1; k < headTaps; ++k)
+        {
+            sum += 2.0 * (specRe.get()[k] * twRe - specIm.get()[k] * twIm);
+            const double nextRe = twRe * stepRe - twIm * stepIm;
+            twIm = twRe * stepIm + twIm * stepRe;
+            twRe = nextRe;
+        }
+        irRev[taps - 1 - n] = sum / static_cast<double>(fftSize) * scale;
     }
-    else if (tailMode == 1)
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+// SharedSpectra  ─ 不変 IR スペクトルの参照カウント共有体
+//   L/R 同一 IR (shareImpulseSpectraFrom)、True-stereo クロスパス (adoptCrossSpectraFrom)、
+//   世代間の再構築 (SetImpulse の spectraDonor)、プロセス内索引 (SpectraRegistry) 経由の
+//   別エンジンからの SetImpulse で複数インスタンスから参照される。
+//   解放は最後の releaseSpectra (Message Thread または NonRT の deferred delete) で行う。
+//==============================================================================
+struct MKLNonUniformConvolver::SharedSpectra
+{
+    struct LayerData
     {
-        tailStartSec = juce::jlimit(0.01, 0.80, std::max(tailStartSec, 0.12));
-        tailStrength = juce::jlimit(0.0, 2.0, std::max(tailStrength, 1.25));
-        // tailL1L2Mult 最小値を 12→8 に緩和（案A）。数学的に出力は同一であり、
-        // L2 small buffers (fftTimeBuf/fftOutBuf 等) が 12.4MB → 5.5MB (56%減)。
-        // 83ms IR 環境では L1/L2 が生成されないため影響ゼロ。
-        tailL1L2Mult = juce::jlimit(2, 16, std::max(tailL1L2Mult, 8));
+        int      numParts       = 0;
+        int      numPartsIR     = 0;
+        int      complexSize    = 0;
+        bool     compact        = false;
+        double*  re             = nullptr;
+        double*  im             = nullptr;
+        float*   reF            = nullptr;
+        float*   imF            = nullptr;
+        uint8_t* partSilent     = nullptr;
+        int      numSilentParts = 0;
+        size_t   arrayBytes     = 0;   // re/im (または reF/imF) 1 本あたり
+        size_t   silentBytes    = 0;
+        int      pagedParts     = 0;   // ★ Far-tail paging: >0 なら re/im (reF/imF) は pager のマップ上
+        bool     binMajor       = false;  // ★ Bin-major FDL: re/im は BinTileLayout 配置
+        bool     inResidentBlock = false; // ★ RT residency: re/im (reF/imF) は resident ブロック上
+        bool     lockedInPlace  = false;  // ★ RT residency: re/im (reF/imF) をヒープ上のままロック済み
+    };
 
-        layer1Gain = juce::jlimit(0.0, 2.0, tailStrength * (1.05 + 0.20 * strength01));
-        layer2Gain = juce::jlimit(0.0, 2.0, tailStrength * (0.82 + 0.12 * strength01));
-    }
-    else
+    LayerData layers[kNumLayers];
+    int       numLayers   = 0;
+    bool      compactTail = false;
+    uint64_t  fingerprint = 0;
+    // ★ Retune: fingerprint からスペクトルゲイン系 (HC/LC/tailStrength) を除いたキーと、焼き込み済みゲイン
+    uint64_t  layoutFingerprint = 0;
+    SpectrumGainParams gains;
+    std::atomic<int> refCount { 1 };
+    convo::MemoryCharge charge { convo::MemoryCategory::ConvolverSpectra };   // publishLayerSpectra で設定
+    std::unique_ptr<convo::FarTailPager> pager;   // ★ Far-tail paging: 最終レイヤーのみ (pageFarTail で設定)
+    convo::RtResidentBlock resident;              // ★ RT residency: ラージページへ移した配列の器 (makeSpectraResident で設定)
+    // ★ NUMA replicas: numaNode は publish したスレッドのノード (不明なら -1)。
+    //   replicas[n] はノード n 用の複製で、この共有体が 1 参照ずつ保持する (spectraForCurrentNode で生成)
+    static constexpr int kMaxNumaReplicas = 8;
+    int numaNode = -1;
+    std::mutex replicaMutex;
+    std::array<SharedSpectra*, kMaxNumaReplicas> replicas {};
+
+    [[nodiscard]] uint64_t layerBytes(int li) const noexcept
     {
-        // Bypass mode (defensive path)
-        tailStrength = 0.0;
-        layer1Gain = 0.0;
-        layer2Gain = 0.0;
+        return static_cast<uint64_t>(layers[li].arrayBytes) * 2 + layers[li].silentBytes;
     }
 
-    m_tailEnabled = tailEnabled;
-    m_tailStrength = tailEnabled ? tailStrength : 0.0;
-    m_maxBlockSize = blockSize;
-    m_tailLayerGain[0] = 1.0;
-    m_tailLayerGain[1] = layer1Gain;
-    m_tailLayerGain[2] = layer2Gain;
-
-    // ────────────────────────────────────────────────
-    // 先頭 Direct Form 設定
-    // ────────────────────────────────────────────────
-    constexpr int kMaxDirectTaps = 32;
-    const int directPart = juce::nextPowerOfTwo(std::max(blockSize, 64));
-    m_directTapCount = (enableDirectHead ? std::min(irLen, std::min(directPart, kMaxDirectTaps)) : 0);
-    m_directHistLen  = std::max(0, m_directTapCount - 1);
-    m_directMaxBlock = std::max(blockSize, 1);
-    m_directPendingSamples = 0;
-    m_directEnabled  = (m_directTapCount > 0);
-
-    if (m_directEnabled)
+    ~SharedSpectra()
     {
-        m_directIRRev   = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directTapCount) * sizeof(double), 64));
-        m_directHistory = (m_directHistLen > 0)
-            ? static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directHistLen) * sizeof(double), 64))
-            : nullptr;
-        m_directWindow  = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directHistLen + m_directMaxBlock) * sizeof(double), 64));
-        m_directOutBuf  = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directMaxBlock) * sizeof(double), 64));
-
-        if (!m_directIRRev || !m_directWindow || !m_directOutBuf || (m_directHistLen > 0 && !m_directHistory))
+        for (auto& d : layers)
         {
-            releaseAllLayers();
-            return false;
+            if (d.lockedInPlace)
+            {
+                convo::unlockInPlace(d.compact ? static_cast<const void*>(d.reF) : d.re, d.arrayBytes);
+                convo::unlockInPlace(d.compact ? static_cast<const void*>(d.imF) : d.im, d.arrayBytes);
+            }
+            if (d.pagedParts > 0 || d.inResidentBlock)
+            {
+                // マップ上 / resident ブロック上の配列は pager / ブロックの破棄で解放される
+                d.re  = nullptr;
+                d.im  = nullptr;
+                d.reF = nullptr;
+                d.imF = nullptr;
+            }
+            if (d.inResidentBlock)
+                d.partSilent = nullptr;
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+            freeTracked(d.re,  d.arrayBytes);
+            freeTracked(d.im,  d.arrayBytes);
+            freeTracked(d.reF, d.arrayBytes);
+            freeTracked(d.imF, d.arrayBytes);
+            freeTracked(d.partSilent, d.silentBytes);
+#else
+            if (d.re)  { mkl_free(d.re);  d.re  = nullptr; }
+            if (d.im)  { mkl_free(d.im);  d.im  = nullptr; }
+            if (d.reF) { mkl_free(d.reF); d.reF = nullptr; }
+            if (d.imF) { mkl_free(d.imF); d.imF = nullptr; }
+            if (d.partSilent) { mkl_free(d.partSilent); d.partSilent = nullptr; }
+#endif
         }
+        convo::freeResident(resident);
+        for (auto*& replica : replicas)
+            releaseSpectra(replica);
+    }
+};
 
-        if (m_directHistLen > 0)
-            memset(m_directHistory, 0, static_cast<size_t>(m_directHistLen) * sizeof(double));
-        memset(m_directOutBuf, 0, static_cast<size_t>(m_directMaxBlock) * sizeof(double));
+//==============================================================================
+// SpectraRegistry  ─ プロセス内の fingerprint → SharedSpectra 索引
+//   複数の AudioEngine (ゾーン別出力・バッチレンダー) がそれぞれの ConvolverProcessor で同じ IR を
+//   同じレート・構成で読み込むと、SetImpulse の入力 (fingerprint) が一致する。最初に構築した
+//   インスタンスの共有体を索引に載せ、以後の SetImpulse は donor が無くてもそれを参照 +1 で使う。
+//   メモリは一意な IR (構成) の数に比例し、インスタンス数に比例しない。
+//
+//   索引は参照を持たない (弱参照)。寿命は各インスタンスの参照のみで決まり、最後の releaseSpectra
+//   (epoch retire 後の deferred delete / Message Thread) が索引から外してから解放する。
+//   参照が 0 に落ちてから外されるまでの間に lookup した側は tryRetain で拾わない。
+//   mutex で守るため Audio Thread からは触らない (SetImpulse / releaseSpectra は NonRT)。
+//   プロセス終了時の静的破棄順に依存しないよう、索引本体は意図的に解放しない。
+//==============================================================================
+struct MKLNonUniformConvolver::SpectraRegistry
+{
+    std::mutex mutex;
+    std::unordered_map<uint64_t, SharedSpectra*> entries;
+    uint64_t hits = 0;
 
-        for (int i = 0; i < m_directTapCount; ++i)
-            m_directIRRev[i] = impulse[m_directTapCount - 1 - i] * scale;
+    static SpectraRegistry& instance() noexcept
+    {
+        static SpectraRegistry* registry = new SpectraRegistry();
+        return *registry;
     }
 
-    convo::ScopedAlignedPtr<double> impulseForFft(
-        static_cast<double*>(mkl_malloc(static_cast<size_t>(irLen) * sizeof(double), 64)));
-    if (!impulseForFft.get())
+    // 参照が残っている場合のみ +1 する (0 → 1 の復活はしない)
+    static bool tryRetain(SharedSpectra* s) noexcept
     {
-        releaseAllLayers();
+        int count = convo::consumeAtomic(s->refCount, std::memory_order_relaxed); // relaxed: CAS の失敗側で再読込する
+        while (count > 0)
+        {
+            if (convo::compareExchangeAtomic(s->refCount, count, count + 1,
+                                             std::memory_order_acq_rel, // acq_rel: 公開元の構築完了と HB
+                                             std::memory_order_relaxed)) // relaxed: 再試行のみ
+                return true;
+        }
         return false;
     }
 
-    memcpy(impulseForFft.get(), impulse, static_cast<size_t>(irLen) * sizeof(double));
+    void forget(const SharedSpectra* s) noexcept
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto it = entries.find(s->fingerprint);
+        if (it != entries.end() && it->second == s)
+            entries.erase(it);
+    }
+};
 
-    if (m_directEnabled)
-        memset(impulseForFft.get(), 0, static_cast<size_t>(m_directTapCount) * sizeof(double));
+MKLNonUniformConvolver::SharedSpectra* MKLNonUniformConvolver::acquireRegisteredSpectra(uint64_t fingerprint) noexcept
+{
+    if (fingerprint == 0)
+        return nullptr;
+    auto& registry = SpectraRegistry::instance();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    const auto it = registry.entries.find(fingerprint);
+    if (it == registry.entries.end() || !SpectraRegistry::tryRetain(it->second))
+        return nullptr;
+    ++registry.hits;
+    return it->second;
+}
 
-    // NOTE: vmlSetMode はここでは呼ばない (MainApplication::initialise() 設定済み)。
+void MKLNonUniformConvolver::registerSpectra(SharedSpectra* s) noexcept
+{
+    if (s == nullptr || s->fingerprint == 0)
+        return;
+    auto& registry = SpectraRegistry::instance();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    try
+    {
+        // 既存の登録が生きていればそちらを残す (解放待ちの共有体だけ置き換える)
+        auto [it, inserted] = registry.entries.try_emplace(s->fingerprint, s);
+        if (!inserted && convo::consumeAtomic(it->second->refCount, std::memory_order_acquire) == 0) // acquire: 解放側の fetchSub と HB
+            it->second = s;
+    }
+    catch (...)
+    {
+        // 索引に載らないだけで、このインスタンスの動作には影響しない
+    }
+}
 
-    // ────────────────────────────────────────────────
-    // レイヤー構成決定 (Non-Uniform Partitioned Convolution)
-    // ────────────────────────────────────────────────
-    const int l0Part = juce::nextPowerOfTwo(std::max(blockSize, 64));
-    const int l1Part = l0Part * tailL1L2Mult;
-    const int l2Part = l1Part * tailL1L2Mult;
+MKLNonUniformConvolver::SpectraRegistryStats MKLNonUniformConvolver::getSpectraRegistryStats() noexcept
+{
+    auto& registry = SpectraRegistry::instance();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    SpectraRegistryStats stats;
+    stats.entries = registry.entries.size();
+    stats.hits = registry.hits;
+    for (const auto& [fingerprint, spectra] : registry.entries)
+    {
+        for (int li = 0; li < spectra->numLayers; ++li)
+            stats.bytes += spectra->layerBytes(li);
+    }
+    return stats;
+}
 
-    const int l0MaxLen = kL0MaxParts * l0Part;
-    const int l0LenByTailStart = static_cast<int>(std::llround(tailStartSec * sampleRateForTail));
-    const int l0LenTarget = juce::jlimit(l0Part, l0MaxLen, l0LenByTailStart);
-    const int l0Len = std::min(irLen, tailEnabled ? l0LenTarget : l0MaxLen);
+MKLNonUniformConvolver::SharedSpectra* MKLNonUniformConvolver::retainSpectra(SharedSpectra* s) noexcept
+{
+    if (s != nullptr)
+        convo::fetchAddAtomic(s->refCount, 1, std::memory_order_relaxed); // relaxed: 呼び出し元が既に有効な参照を保持している (新規公開の HB は不要)
+    return s;
+}
 
-    const int l1Offset = l0Len;
-    const int l1Len    = tailEnabled ? std::max(0, std::min(irLen - l0Len, kL1MaxParts * l1Part)) : 0;
+void MKLNonUniformConvolver::releaseSpectra(SharedSpectra*& s) noexcept
+{
+    if (s == nullptr)
+        return;
+    if (convo::fetchSubAtomic(s->refCount, 1, std::memory_order_acq_rel) == 1) // acq_rel: 他インスタンスの最終読み取りと HB した上で解放
+    {
+        SpectraRegistry::instance().forget(s);
+        delete s;
+    }
+    s = nullptr;
+}
 
-    const int l2Offset = l0Len + l1Len;
-    const int l2Len    = tailEnabled ? std::max(0, irLen - l0Len - l1Len) : 0;
+//==============================================================================
+// computeSpectraFingerprint  ─ SetImpulse 入力から IR スペクトルの同一性キーを作る
+//   スペクトルに影響しない設定 (Tail Worker オフロード等) は含めない。0 は「未構築」に予約。
+//   layoutFingerprint には per-bin ゲインのみに効く設定 (HC/LC/tailStrength) を除いた途中値を返す
+//   (一致すればレイヤー構成・IR 分割は同一で、スペクトルはゲイン比の再スケールで求まる)。
+//==============================================================================
+uint64_t MKLNonUniformConvolver::computeSpectraFingerprint(const double* impulse, int irLen, int blockSize, double scale,
+                                                           bool enableDirectHead, const FilterSpec* filterSpec,
+                                                           uint64_t* layoutFingerprint) noexcept
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto mix = [&h](uint64_t v) noexcept { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+    auto mixDouble = [&mix](double v) noexcept { uint64_t bits; std::memcpy(&bits, &v, sizeof(bits)); mix(bits); };
 
-    struct LayerCfg { int offset; int len; int partSize; bool immediate; };
-    const LayerCfg cfgs[kNumLayers] = {
-        { 0,        l0Len, l0Part, true  },
-        { l1Offset, l1Len, l1Part, false },
-        { l2Offset, l2Len, l2Part, false },
-    };
+    mix(static_cast<uint64_t>(irLen));
+    mix(static_cast<uint64_t>(blockSize));
+    mixDouble(scale);
+    mix(enableDirectHead ? 1ULL : 0ULL);
+    for (int i = 0; i < irLen; ++i)
+        mixDouble(impulse[i]);
 
-    m_numActiveLayers = 0;
+    if (filterSpec != nullptr)
+    {
+        mixDouble(filterSpec->sampleRate);
+        mix(static_cast<uint64_t>(filterSpec->tailMode));
+        mix(filterSpec->tailEnabled ? 1ULL : 0ULL);
+        mixDouble(filterSpec->tailStartSeconds);
+        mix(static_cast<uint64_t>(filterSpec->tailL1L2Multiplier));
+        mix(filterSpec->compactTailSpectra ? 1ULL : 0ULL);
+        mixDouble(filterSpec->partitionCullFloorDb);
+        mix(static_cast<uint64_t>(filterSpec->partitionCullLength));
+        mixDouble(filterSpec->farTailHorizonSeconds);
+        mix(static_cast<uint64_t>(static_cast<uint32_t>(filterSpec->tailDecimation)));
+        if (layoutFingerprint != nullptr)
+            *layoutFingerprint = (h != 0) ? h : 1;
+
+        mix(static_cast<uint64_t>(filterSpec->hcMode));
+        mix(static_cast<uint64_t>(filterSpec->lcMode));
+        mixDouble(filterSpec->tailStrength);
+    }
+    else
+    {
+        mix(0x5EC7ULL);
+        if (layoutFingerprint != nullptr)
+            *layoutFingerprint = (h != 0) ? h : 1;
+    }
+    return (h != 0) ? h : 1;
+}
 
-    // ────────────────────────────────────────────────
-    // 各レイヤーの遅延補償用エントリを保持
-    int prevLayerTotalSamples = 0;  // ★ B13: 先行レイヤーの IR 総長
+//==============================================================================
+// publishLayerSpectra  ─ Message Thread (SetImpulse 末尾、公開前)
+//   全レイヤーの IR スペクトル・無音マスクの所有権を新しい SharedSpectra へ移す。
+//   確保失敗時は false (レイヤーは従来どおり自前所有のまま動作し、共有のみ不可)。
+//==============================================================================
+bool MKLNonUniformConvolver::publishLayerSpectra(uint64_t fingerprint, uint64_t layoutFingerprint,
+                                                 const SpectrumGainParams& gains) noexcept
+{
+    auto* s = new (std::nothrow) SharedSpectra();
+    if (s == nullptr)
+        return false;
 
-    // ────────────────────────────────────────────────
-    // 各レイヤーを初期化
-    // ────────────────────────────────────────────────
-    for (int li = 0; li < kNumLayers; ++li)
+    s->fingerprint = fingerprint;
+    s->layoutFingerprint = layoutFingerprint;
+    s->gains = gains;
+    s->numLayers   = m_numActiveLayers;
+    s->compactTail = m_compactTail;
+    s->numaNode    = ::ThreadAffinityManager::currentThreadNumaNode();
+    for (int li = 0; li < m_numActiveLayers; ++li)
     {
-        if (cfgs[li].len <= 0)
-            continue;
-
-        Layer& l = m_layers[m_numActiveLayers];
-        l.descriptorCommitted = false;
-        convo::publishAtomic(l.warmupCompleted, false, std::memory_order_release);
+        Layer& l = m_layers[li];
+        auto& d = s->layers[li];
+        const size_t elemBytes = l.compactSpectra ? sizeof(float) : sizeof(double);
+        d.numParts       = l.numParts;
+        d.numPartsIR     = l.numPartsIR;
+        d.complexSize    = l.complexSize;
+        d.compact        = l.compactSpectra;
+        d.binMajor       = l.binMajor;
+        d.re             = l.irFreqReal;
+        d.im             = l.irFreqImag;
+        d.reF            = l.irFreqRealF;
+        d.imF            = l.irFreqImagF;
+        d.partSilent     = l.partSilent;
+        d.numSilentParts = l.numSilentParts;
+        d.arrayBytes     = static_cast<size_t>(l.numParts) * static_cast<size_t>(l.complexSize) * elemBytes;
+        d.silentBytes    = (l.partSilent != nullptr) ? static_cast<size_t>(l.numParts) : 0;
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+        l.allocSizes.irFreqReal  = l.allocSizes.irFreqImag  = 0;
+        l.allocSizes.irFreqRealF = l.allocSizes.irFreqImagF = 0;
+        l.allocSizes.partSilent  = 0;
+#endif
+        l.irSpectraShared = true;
+    }
+    uint64_t spectraBytes = 0;
+    for (int li = 0; li < s->numLayers; ++li)
+        spectraBytes += s->layerBytes(li);
+    s->charge.set(spectraBytes);
+    m_spectra = s;
+    registerSpectra(s);
+    return true;
+}
 
-        l.partSize    = cfgs[li].partSize;
-        l.fftSize     = l.partSize * 2;
-        l.isImmediate = cfgs[li].immediate;
+uint64_t MKLNonUniformConvolver::getSpectraFingerprint() const noexcept
+{
+    return (m_spectra != nullptr) ? m_spectra->fingerprint : 0;
+}
 
-        l.complexSize = l.fftSize / 2 + 1;
-        l.partStride  = (l.complexSize * 2 + 7) & ~7;
+bool MKLNonUniformConvolver::sharesSpectraWith(const MKLNonUniformConvolver& other) const noexcept
+{
+    return m_spectra != nullptr && m_spectra == other.m_spectra;
+}
 
-        l.numPartsIR = (cfgs[li].len + l.partSize - 1) / l.partSize;
-        l.numParts   = juce::nextPowerOfTwo(l.numPartsIR);
-        l.fdlMask    = l.numParts - 1;
+//==============================================================================
+// spectraForCurrentNode  ─ SetImpulse (NonRT。固定済みのオフラインワーカー)
+//   donor のスペクトルが別 NUMA ノードにあれば、呼び出しスレッドのノードに置いた複製を返す。
+//   複製は呼び出しスレッドがコピーして最初に書くため、そのノードに載る (first touch)。
+//   ファイルマップを含むスペクトル (Far-tail paging) と複製に失敗した場合は donor をそのまま返す。
+//==============================================================================
+const MKLNonUniformConvolver::SharedSpectra*
+MKLNonUniformConvolver::spectraForCurrentNode(const SharedSpectra* donor) noexcept
+{
+    const int node = ::ThreadAffinityManager::currentThreadNumaNode();
+    if (donor == nullptr || node < 0 || node >= SharedSpectra::kMaxNumaReplicas
+        || donor->numaNode < 0 || donor->numaNode == node || donor->pager != nullptr)
+        return donor;
+
+    // replicas は共有体の中で唯一の可変部分 (不変なスペクトル本体とは独立)
+    auto* owner = const_cast<SharedSpectra*>(donor);
+    const std::lock_guard<std::mutex> lock(owner->replicaMutex);
+    if (owner->replicas[static_cast<size_t>(node)] != nullptr)
+        return owner->replicas[static_cast<size_t>(node)];
+
+    auto* r = new (std::nothrow) SharedSpectra();
+    if (r == nullptr)
+        return donor;
+    r->numLayers         = donor->numLayers;
+    r->compactTail       = donor->compactTail;
+    r->fingerprint       = donor->fingerprint;
+    r->layoutFingerprint = donor->layoutFingerprint;
+    r->gains             = donor->gains;
+    r->numaNode          = node;
+
+    const auto slotBytes = [](size_t bytes) { return (bytes + 63) & ~static_cast<size_t>(63); };
+    size_t totalBytes = 0;
+    for (int li = 0; li < donor->numLayers; ++li)
+        totalBytes += 2 * slotBytes(donor->layers[li].arrayBytes) + slotBytes(donor->layers[li].silentBytes);
+    r->resident = convo::allocateResident(totalBytes);
+    if (r->resident.ptr == nullptr)
+    {
+        delete r;
+        return donor;
+    }
 
-        // ── IPP FFT スペック初期化 (Message Thread で事前確保) ──
-        //
-        // [v2.1] MKL DFTI_DESCRIPTOR_HANDLE の代替。
-        // fftSize = 2 * partSize は常に 2 の冪なので FFT (DFT より高速) を使用可能。
-        // IPP_FFT_DIV_INV_BY_N: IFFT 時に 1/N 正規化を自動適用
-        //   (旧: DftiSetValue(DFTI_BACKWARD_SCALE, 1.0/fftSize) と等価)
-        // ippAlgHintFast: 速度優先 (精度を一切犠牲にしない範囲でのヒント)
-        {
-            // fftSize = 2^order を求める (fftSize は必ず 2 の冪)
-            int order = 0;
-            {
-                int tmp = l.fftSize;
-                while (tmp > 1) { tmp >>= 1; ++order; }
-            }
+    auto* cursor = static_cast<uint8_t*>(r->resident.ptr);
+    const auto copy = [&cursor, &slotBytes](auto* from, size_t bytes) noexcept
+    {
+        using Elem = std::remove_const_t<std::remove_pointer_t<decltype(from)>>;
+        if (from == nullptr)
+            return static_cast<Elem*>(nullptr);
+        auto* to = reinterpret_cast<Elem*>(cursor);
+        std::memcpy(to, from, bytes);
+        cursor += slotBytes(bytes);
+        return to;
+    };
+    for (int li = 0; li < donor->numLayers; ++li)
+    {
+        const auto& src = donor->layers[li];
+        auto& d = r->layers[li];
+        d = src;
+        d.re              = copy(src.re, src.arrayBytes);
+        d.im              = copy(src.im, src.arrayBytes);
+        d.reF             = copy(src.reF, src.arrayBytes);
+        d.imF             = copy(src.imF, src.arrayBytes);
+        d.partSilent      = copy(src.partSilent, src.silentBytes);
+        d.inResidentBlock = true;
+        d.lockedInPlace   = false;
+    }
+    uint64_t spectraBytes = 0;
+    for (int li = 0; li < r->numLayers; ++li)
+        spectraBytes += r->layerBytes(li);
+    r->charge.set(spectraBytes);
 
-            if (const IppFFTPlan* plan = IppFFTPlanCache::getOrCreate(order); plan != nullptr)
-                l.fftPlanOwner = std::cref(*plan);
-            else
-                l.fftPlanOwner.reset();
+    owner->replicas[static_cast<size_t>(node)] = r;   // donor が保持する 1 参照 (donor の破棄で解放)
+    return r;
+}
 
-            if (!l.fftPlanOwner.has_value() || l.fftPlanOwner->get().fftSpec == nullptr)
-            {
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-                juce::Logger::writeToLog("MKLNonUniformConvolver: FFT plan cache creation failed for layer "
-                                         + juce::String(li) + " (order=" + juce::String(order) + ")");
-#endif
-                releaseAllLayers();
-                return false;
-            }
+//==============================================================================
+// makeSpectraResident  ─ Message Thread (SetImpulse 末尾、m_ready の公開前)
+//   MAC は毎サイクル IR スペクトル全域を読むため、ページアウトされると Audio Thread がフォルトする。
+//   ラージページが使えれば全レイヤーを 1 ブロックへ移し (TLB ミスも減らす)、使えなければ
+//   コピーせずヒープ上の配列をロックする。ページ化したレイヤーは pager が常駐を管理するので対象外。
+//==============================================================================
+void MKLNonUniformConvolver::makeSpectraResident() noexcept
+{
+    SharedSpectra* s = m_spectra;
+    if (s == nullptr || s->resident.ptr != nullptr)
+        return;
 
-            l.fftSpec = l.fftPlanOwner->get().fftSpec;
+    const auto slotBytes = [](size_t bytes) { return (bytes + 63) & ~static_cast<size_t>(63); };
+    size_t totalBytes = 0;
+    for (int li = 0; li < s->numLayers; ++li)
+        if (s->layers[li].pagedParts == 0 && !s->layers[li].lockedInPlace)
+            totalBytes += 2 * slotBytes(s->layers[li].arrayBytes) + slotBytes(s->layers[li].silentBytes);
+    if (totalBytes == 0)
+        return;
 
-            // ワークバッファ確保 (Audio Thread での動的確保を防ぐため事前確保)
-            // sizeWork == 0 の場合 nullptr のまま (IPP が外部バッファ不要)
-            // sizeWork > 0 かつ確保失敗 → リアルタイム安全でないため初期化失敗とする
-            if (l.fftPlanOwner->get().sizeWork > 0)
+    const size_t largePage = convo::largePageSize();
+    if (largePage != 0 && totalBytes >= largePage)
+    {
+        convo::RtResidentBlock block = convo::allocateResident(totalBytes);
+        if (block.residency == convo::RtResidency::LargePage)
+        {
+            auto* cursor = static_cast<uint8_t*>(block.ptr);
+            // 1 本ずつ移しては旧配列を解放し、一時的な二重確保をレイヤー 1 本分に抑える
+            const auto relocate = [&cursor, &slotBytes](auto*& array, size_t bytes) noexcept
             {
-                l.fftWorkBuf = ippsMalloc_8u(l.fftPlanOwner->get().sizeWork);
-                if (!l.fftWorkBuf)
-                {
+                if (array == nullptr)
+                    return;
+                using Elem = std::remove_reference_t<decltype(*array)>;
+                auto* dst = reinterpret_cast<Elem*>(cursor);
+                std::memcpy(dst, array, bytes);
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-                    juce::Logger::writeToLog("MKLNonUniformConvolver: ippsMalloc_8u(sizeWork=" + juce::String(l.fftPlanOwner->get().sizeWork)
-                                             + ") failed for layer " + juce::String(li));
+                freeTracked(array, bytes);
+#else
+                mkl_free(array);
 #endif
-                    releaseAllLayers();
-                    return false;
-                }
+                array = dst;
+                cursor += slotBytes(bytes);
+            };
+            for (int li = 0; li < s->numLayers; ++li)
+            {
+                auto& d = s->layers[li];
+                if (d.pagedParts > 0 || d.lockedInPlace)
+                    continue;
+                relocate(d.re, d.arrayBytes);
+                relocate(d.im, d.arrayBytes);
+                relocate(d.reF, d.arrayBytes);
+                relocate(d.imF, d.arrayBytes);
+                relocate(d.partSilent, d.silentBytes);
+                d.inResidentBlock = true;
+                Layer& l = m_layers[li];
+                l.irFreqReal  = d.re;
+                l.irFreqImag  = d.im;
+                l.irFreqRealF = d.reF;
+                l.irFreqImagF = d.imF;
+                l.partSilent  = d.partSilent;
             }
-            // else: sizeWork == 0 → l.fftWorkBuf は nullptr のまま (正常)
+            s->resident = block;
+            return;
+        }
+        convo::freeResident(block);
+    }
 
-            l.descriptorCommitted = true;
+    for (int li = 0; li < s->numLayers; ++li)
+    {
+        auto& d = s->layers[li];
+        if (d.pagedParts > 0 || d.inResidentBlock || d.lockedInPlace)
+            continue;
+        const void* re = d.compact ? static_cast<const void*>(d.reF) : d.re;
+        const void* im = d.compact ? static_cast<const void*>(d.imF) : d.im;
+        if (re == nullptr || im == nullptr)
+            continue;
+        // 片方だけロックできた場合は戻す (解放時は両方ロック済みとして扱うため)
+        if (convo::lockInPlace(re, d.arrayBytes) == 0)
+            continue;
+        if (convo::lockInPlace(im, d.arrayBytes) == 0)
+        {
+            convo::unlockInPlace(re, d.arrayBytes);
+            continue;
         }
+        d.lockedInPlace = true;
+    }
+}
 
-        // ── バッファ確保 (すべて mkl_malloc 64byte アライン) ──
-        // [Mem-Fix] irFreqDomain/fdlBuf は永続履歴ではなく使い捨てスクラッチ。
-        // irFreqDomain: 1パーティション分、fdlBuf: current+mirrorの2スロット分のみ。
-        const size_t irBufSize  = static_cast<size_t>(l.partStride);
-        const size_t fdlBufSize = static_cast<size_t>(l.partStride) * 2;
-        const size_t irSoaSize  = static_cast<size_t>(l.numParts) * static_cast<size_t>(l.complexSize);
-        const size_t fdlSoaSize = static_cast<size_t>(l.numParts) * 2 * static_cast<size_t>(l.complexSize);
+//==============================================================================
+// Far-tail paging  ─ Message Thread (SetImpulse 末尾 / shareImpulseSpectraFrom / releaseAllLayers)
+//   最終レイヤー (L2) のうち IR 先頭から horizon 以降にあたるパーティション (逆順格納の [0, pagedParts))
+//   を FarTailPager のマップから読む。配列全体をファイルへ移し、地平線より手前は pager がロックで常駐させる。
+//   共有先のインスタンスもそれぞれ消費者スロットを登録し、カーソルを先読み窓へ反映する。
+//==============================================================================
+bool MKLNonUniformConvolver::pageFarTail(const FilterSpec& spec, int layerOffset) noexcept
+{
+    const int li = m_numActiveLayers - 1;
+    if (m_spectra == nullptr || li < 1 || m_spectra->pager != nullptr)
+        return false;
+    Layer& l = m_layers[li];
+    auto& d = m_spectra->layers[li];
+    // ページ単位の常駐管理はパーティション優先配置が前提 (SetImpulse はページ化対象をタイル化しない)
+    if (l.isImmediate || !l.irSpectraShared || d.binMajor)
+        return false;
+
+    const int horizonSamples = static_cast<int>(std::llround(spec.farTailHorizonSeconds * spec.sampleRate));
+    const int nearParts = (std::max(0, horizonSamples - layerOffset) + l.partSize - 1) / l.partSize;
+    const int pagedParts = l.numPartsIR - nearParts;
+    if (pagedParts <= 0)
+        return false;
+
+    const void* re = d.compact ? static_cast<const void*>(d.reF) : static_cast<const void*>(d.re);
+    const void* im = d.compact ? static_cast<const void*>(d.imF) : static_cast<const void*>(d.im);
+    const size_t elemBytes = d.compact ? sizeof(float) : sizeof(double);
+    // 先読み窓: 分散 MAC 3 コールバック分 (Tail Worker は 1 サイクルを一度に回すが常駐を待たない)
+    const int windowParts = std::max(4, 3 * l.partsPerCallback);
+    std::unique_ptr<convo::FarTailPager> pager;
+    try
+    {
+        pager = convo::FarTailPager::create(re, im, static_cast<size_t>(d.complexSize) * elemBytes,
+                                            d.numParts, pagedParts, windowParts, spec.tailWorkerAffinity);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    if (pager == nullptr)
+        return false;
 
-        l.irFreqDomain = static_cast<double*>(DIAG_MKL_MALLOC(irBufSize  * sizeof(double), 64));
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.irFreqDomain = irBufSize * sizeof(double);
-#endif
-        l.irFreqReal   = static_cast<double*>(DIAG_MKL_MALLOC(irSoaSize  * sizeof(double), 64));
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.irFreqReal = irSoaSize * sizeof(double);
-#endif
-        l.irFreqImag   = static_cast<double*>(DIAG_MKL_MALLOC(irSoaSize  * sizeof(double), 64));
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.irFreqImag = irSoaSize * sizeof(double);
+    freeTracked(d.re,  d.arrayBytes);
+    freeTracked(d.im,  d.arrayBytes);
+    freeTracked(d.reF, d.arrayBytes);
+    freeTracked(d.imF, d.arrayBytes);
+#else
+    if (d.re)  { mkl_free(d.re);  d.re  = nullptr; }
+    if (d.im)  { mkl_free(d.im);  d.im  = nullptr; }
+    if (d.reF) { mkl_free(d.reF); d.reF = nullptr; }
+    if (d.imF) { mkl_free(d.imF); d.imF = nullptr; }
 #endif
-        l.fdlBuf       = static_cast<double*>(DIAG_MKL_MALLOC(fdlBufSize * sizeof(double), 64));
+    // マップは読み取り専用。Audio Thread / Tail Worker は IR スペクトルを読むだけなので const を外して張る
+    if (d.compact)
+    {
+        d.reF = const_cast<float*>(static_cast<const float*>(pager->real()));
+        d.imF = const_cast<float*>(static_cast<const float*>(pager->imag()));
+    }
+    else
+    {
+        d.re = const_cast<double*>(static_cast<const double*>(pager->real()));
+        d.im = const_cast<double*>(static_cast<const double*>(pager->imag()));
+    }
+    l.irFreqReal  = d.re;
+    l.irFreqImag  = d.im;
+    l.irFreqRealF = d.reF;
+    l.irFreqImagF = d.imF;
+    d.pagedParts = pagedParts;
+
+    uint64_t spectraBytes = 0;
+    for (int i = 0; i < m_spectra->numLayers; ++i)
+        spectraBytes += m_spectra->layerBytes(i);
+    m_spectra->charge.set(spectraBytes - pager->getPagedBytes());
+    m_spectra->pager = std::move(pager);
+    return true;
+}
+
+void MKLNonUniformConvolver::bindFarTailPager() noexcept
+{
+    if (m_spectra == nullptr || m_spectra->pager == nullptr)
+        return;
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        const auto& d = m_spectra->layers[li];
+        if (d.pagedParts <= 0)
+            continue;
+        Layer& l = m_layers[li];
+        l.pager = m_spectra->pager.get();
+        l.pagedParts = d.pagedParts;
+        l.pagerMayFault = m_tailOffload;   // Tail Worker は RT ではないためフォルトを許容して全パーティションを読む
+        l.pagerSlot = l.pager->registerConsumer();
+    }
+}
+
+void MKLNonUniformConvolver::unbindFarTailPager() noexcept
+{
+    for (auto& l : m_layers)
+    {
+        if (l.pager != nullptr)
+            l.pager->unregisterConsumer(l.pagerSlot);
+        l.pager = nullptr;
+        l.pagerSlot = -1;
+        l.pagedParts = 0;
+        l.pagerMayFault = false;
+    }
+}
+
+bool MKLNonUniformConvolver::isPartReadable(const Layer& l, int p) noexcept
+{
+    if (p >= l.pagedParts || l.pagerMayFault || l.pager->isResident(p))
+        return true;
+    l.pager->noteMiss();
+    return false;
+}
+
+uint64_t MKLNonUniformConvolver::getFarTailPagedBytes() const noexcept
+{
+    return (m_spectra != nullptr && m_spectra->pager != nullptr) ? m_spectra->pager->getPagedBytes() : 0;
+}
+
+uint64_t MKLNonUniformConvolver::getFarTailMissCount() const noexcept
+{
+    return (m_spectra != nullptr && m_spectra->pager != nullptr) ? m_spectra->pager->getMissCount() : 0;
+}
+
+uint64_t MKLNonUniformConvolver::estimateReleaseBytes() const noexcept
+{
+    uint64_t total = computeOwnedBytes();
+    const SharedSpectra* const held[] = { m_spectra, m_crossSpectra, m_fadeSpectra, m_morphSpectra,
+                                          m_busSpectra[0], m_busSpectra[1], m_busSpectra[2], m_busSpectra[3] };
+    for (const SharedSpectra* s : held)
+    {
+        // 他のインスタンスが参照中なら破棄しても解放されない
+        if (s == nullptr || convo::consumeAtomic(s->refCount, std::memory_order_acquire) != 1) // acquire: releaseSpectra の acq_rel と HB
+            continue;
+        for (int li = 0; li < s->numLayers; ++li)
+            total += s->layerBytes(li);
+    }
+    return total;
+}
+
+int MKLNonUniformConvolver::getBinMajorLayerCount() const noexcept
+{
+    int count = 0;
+    for (int li = 0; li < m_numActiveLayers; ++li)
+        count += m_layers[li].binMajor ? 1 : 0;
+    return count;
+}
+
+int MKLNonUniformConvolver::getTailDecimation() const noexcept
+{
+    return (m_numActiveLayers > 0) ? m_layers[m_numActiveLayers - 1].decimation : 1;
+}
+
+//==============================================================================
+// Spectral crossfade  ─ Message Thread (begin / finish)
+//   旧 IR スペクトル (m_spectra) を保持したまま target の SharedSpectra を retain し、
+//   Audio Thread がレイヤー毎に旧→新へ合成しながら移行する。FDL・FFT は 1 系統のまま。
+//==============================================================================
+bool MKLNonUniformConvolver::isSpectralCrossfadeCompatible(const MKLNonUniformConvolver& target) const noexcept
+{
+    if (!isReady() || !target.isReady())
+        return false;
+    if (m_fadeSpectra != nullptr || m_morphSpectra != nullptr
+        || m_spectra == nullptr || target.m_spectra == nullptr || m_spectra == target.m_spectra)
+        return false;
+    // Direct Head は時間領域ヘッドを、True-stereo はクロスパスを別途保持するため対象外
+    if (m_directEnabled || target.m_directEnabled || m_trueStereo || target.m_trueStereo)
+        return false;
+    // Spectral bus: 合成スペクトルは入力ゲインの変更で差し替わるため、別 IR へのフェード・モーフとは併用しない
+    if (m_numBusInputs != 0 || target.m_numBusInputs != 0)
+        return false;
+    // Far-tail paging: フェード先の MAC は常駐判定を持たないため、どちらかがページ化されていれば対象外
+    if (m_spectra->pager != nullptr || target.m_spectra->pager != nullptr)
+        return false;
+    if (m_numActiveLayers != target.m_numActiveLayers || m_numActiveLayers <= 0
+        || m_latency != target.m_latency || m_compactTail != target.m_compactTail
+        || m_tailEnabled != target.m_tailEnabled || m_tailStrength != target.m_tailStrength)
+        return false;
+
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        const Layer& a = m_layers[li];
+        const Layer& b = target.m_layers[li];
+        if (a.partSize != b.partSize || a.numParts != b.numParts || a.numPartsIR != b.numPartsIR
+            || a.complexSize != b.complexSize || a.isImmediate != b.isImmediate
+            || a.compactSpectra != b.compactSpectra || a.binMajor != b.binMajor
+            || a.decimation != b.decimation || a.outputDelaySamples != b.outputDelaySamples
+            || m_tailLayerGain[li] != target.m_tailLayerGain[li])
+            return false;
+        if (!a.irSpectraShared || !b.irSpectraShared)
+            return false;
+        const auto& d = target.m_spectra->layers[li];
+        const bool hasSpectra = d.compact ? (d.reF && d.imF) : (d.re && d.im);
+        if (!hasSpectra || d.compact != a.compactSpectra || d.binMajor != a.binMajor)
+            return false;
+    }
+    return true;
+}
+
+bool MKLNonUniformConvolver::beginSpectralCrossfade(const MKLNonUniformConvolver& target, int fadeSamples) noexcept
+{
+    if (!isSpectralCrossfadeCompatible(target))
+        return false;
+
+    SharedSpectra* src = retainSpectra(target.m_spectra);
+    if (beginSpectralCrossfadeTo(src, fadeSamples))
+        return true;
+    releaseSpectra(src);
+    return false;
+}
+
+// src は retain 済み。成功時のみ所有権を m_fadeSpectra へ移す
+bool MKLNonUniformConvolver::beginSpectralCrossfadeTo(SharedSpectra* src, int fadeSamples) noexcept
+{
+    // フェード先アキュムレータを先に全レイヤー分確保する (失敗時は状態を変更しない)
+    double* accRe[kNumLayers] {};
+    double* accIm[kNumLayers] {};
+    bool allocated = true;
+    for (int li = 0; li < m_numActiveLayers && allocated; ++li)
+    {
+        const size_t bytes = static_cast<size_t>(m_layers[li].complexSize) * sizeof(double);
+        accRe[li] = static_cast<double*>(DIAG_MKL_MALLOC(bytes, 64));
+        accIm[li] = static_cast<double*>(DIAG_MKL_MALLOC(bytes, 64));
+        allocated = (accRe[li] != nullptr && accIm[li] != nullptr);
+    }
+    if (!allocated)
+    {
+        for (int li = 0; li < m_numActiveLayers; ++li)
+        {
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.fdlBuf = fdlBufSize * sizeof(double);
+            const size_t bytes = static_cast<size_t>(m_layers[li].complexSize) * sizeof(double);
+            freeTracked(accRe[li], bytes);
+            freeTracked(accIm[li], bytes);
+#else
+            if (accRe[li]) mkl_free(accRe[li]);
+            if (accIm[li]) mkl_free(accIm[li]);
 #endif
-        l.fdlReal      = static_cast<double*>(DIAG_MKL_MALLOC(fdlSoaSize * sizeof(double), 64));
+        }
+        return false;
+    }
+
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        const auto& d = src->layers[li];
+        l.fadeIrFreqReal     = d.re;
+        l.fadeIrFreqImag     = d.im;
+        l.fadeIrFreqRealF    = d.reF;
+        l.fadeIrFreqImagF    = d.imF;
+        l.fadePartSilent     = d.partSilent;
+        l.fadeNumSilentParts = d.numSilentParts;
+        l.fadeAccumReal      = accRe[li];
+        l.fadeAccumImag      = accIm[li];
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.fdlReal = fdlSoaSize * sizeof(double);
+        l.allocSizes.fadeAccum = static_cast<size_t>(l.complexSize) * sizeof(double);
 #endif
-        l.fdlImag      = static_cast<double*>(DIAG_MKL_MALLOC(fdlSoaSize * sizeof(double), 64));
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.fdlImag = fdlSoaSize * sizeof(double);
-#endif
-        l.fftTimeBuf   = static_cast<double*>(DIAG_MKL_MALLOC(l.fftSize   * sizeof(double), 64));
+        // パーティション単位で合成するため、長いレイヤーほど実フェード時間は fadeSamples を上回る
+        l.fadeSteps = std::max(2, (std::max(0, fadeSamples) + l.partSize - 1) / l.partSize);
+        l.fadeStep  = 0;
+    }
+    m_fadeSpectra = src;
+    m_memoryCharge.set(computeOwnedBytes());
+
+    convo::publishAtomic(m_fadeLayersDone, 0, std::memory_order_relaxed); // relaxed: 直後の m_fadeGeneration release で公開
+    convo::fetchAddAtomic(m_fadeGeneration, 1u, std::memory_order_release); // release: fade* 書き込みを beginSpectralFadeBlock の acquire と HB
+    return true;
+}
+
+bool MKLNonUniformConvolver::isSpectralCrossfadeComplete() const noexcept
+{
+    return m_fadeSpectra != nullptr
+        && convo::consumeAtomic(m_fadeLayersDone, std::memory_order_acquire) >= m_numActiveLayers; // acquire: completeSpectralFadeLayer の release と HB
+}
+
+int64_t MKLNonUniformConvolver::getSpectralCrossfadeLengthSamples() const noexcept
+{
+    int64_t longest = 0;
+    if (m_fadeSpectra == nullptr)
+        return longest;
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        const Layer& l = m_layers[li];
+        longest = std::max(longest, static_cast<int64_t>(l.fadeSteps + 1) * static_cast<int64_t>(l.partSize));
+    }
+    return longest;
+}
+
+void MKLNonUniformConvolver::finishSpectralCrossfade() noexcept
+{
+    if (!isSpectralCrossfadeComplete())
+        return;
+
+    // 全レイヤーが入れ替え済み: fadeIrFreq* は旧スペクトルを指しており Audio Thread からは参照されない
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.fftTimeBuf = l.fftSize * sizeof(double);
+        freeTracked(l.fadeAccumReal, l.allocSizes.fadeAccum);
+        freeTracked(l.fadeAccumImag, l.allocSizes.fadeAccum);
+        l.allocSizes.fadeAccum = 0;
+#else
+        if (l.fadeAccumReal) { mkl_free(l.fadeAccumReal); l.fadeAccumReal = nullptr; }
+        if (l.fadeAccumImag) { mkl_free(l.fadeAccumImag); l.fadeAccumImag = nullptr; }
 #endif
-        l.fftOutBuf    = static_cast<double*>(DIAG_MKL_MALLOC(l.fftSize   * sizeof(double), 64));
+        l.fadeIrFreqReal = l.fadeIrFreqImag = nullptr;
+        l.fadeIrFreqRealF = l.fadeIrFreqImagF = nullptr;
+        l.fadePartSilent = nullptr;
+        l.fadeNumSilentParts = 0;
+        l.fadeSteps = 0;
+    }
+
+    std::swap(m_spectra, m_fadeSpectra);
+    releaseSpectra(m_fadeSpectra);  // 旧スペクトル (他インスタンスが共有していれば実体は残る)
+    m_spectraReused = false;
+    m_spectraRetuned = false;
+    m_memoryCharge.set(computeOwnedBytes());
+    convo::publishAtomic(m_fadeLayersDone, 0, std::memory_order_relaxed); // relaxed: 次の begin まで Audio Thread は参照しない
+}
+
+//==============================================================================
+// Spectral bus  ─ Message Thread
+//   入力ごとの SharedSpectra を保持し、Σ g·H を 1 つの SharedSpectra に合成して m_spectra とする。
+//   FDL・FFT/IFFT・MAC は単一 IR と同じ 1 系統。ゲイン変更は合成し直して spectral crossfade で移行する。
+//==============================================================================
+MKLNonUniformConvolver::SharedSpectra* MKLNonUniformConvolver::mixBusSpectra(const double* gains) const noexcept
+{
+    if (m_numBusInputs <= 0 || gains == nullptr)
+        return nullptr;
+
+    auto* s = new (std::nothrow) SharedSpectra();
+    if (s == nullptr)
+        return nullptr;
+
+    const SharedSpectra& base = *m_busSpectra[0];
+    s->numLayers   = base.numLayers;
+    s->compactTail = base.compactTail;
+    s->gains       = base.gains;
+    s->numaNode    = ::ThreadAffinityManager::currentThreadNumaNode();
+    // fingerprint / layoutFingerprint は 0 のまま: 索引へ登録せず、SetImpulse の再利用・再スケール元にもならない
+
+    bool ok = true;
+    uint64_t spectraBytes = 0;
+    for (int li = 0; li < base.numLayers && ok; ++li)
+    {
+        const auto& b = base.layers[li];
+        auto& d = s->layers[li];
+        d.numParts    = b.numParts;
+        d.numPartsIR  = b.numPartsIR;
+        d.complexSize = b.complexSize;
+        d.compact     = b.compact;
+        d.binMajor    = b.binMajor;
+        d.arrayBytes  = b.arrayBytes;
+
+        bool anySilentMask = false;
+        for (int in = 0; in < m_numBusInputs; ++in)
+            anySilentMask = anySilentMask || (m_busSpectra[in]->layers[li].partSilent != nullptr);
+        d.silentBytes = anySilentMask ? static_cast<size_t>(d.numParts) : 0;
+
+        if (d.compact)
+        {
+            d.reF = static_cast<float*>(DIAG_MKL_MALLOC(d.arrayBytes, 64));
+            d.imF = static_cast<float*>(DIAG_MKL_MALLOC(d.arrayBytes, 64));
+            ok = (d.reF != nullptr && d.imF != nullptr);
+        }
+        else
+        {
+            d.re = static_cast<double*>(DIAG_MKL_MALLOC(d.arrayBytes, 64));
+            d.im = static_cast<double*>(DIAG_MKL_MALLOC(d.arrayBytes, 64));
+            ok = (d.re != nullptr && d.im != nullptr);
+        }
+        if (ok && d.silentBytes > 0)
+        {
+            d.partSilent = static_cast<uint8_t*>(DIAG_MKL_MALLOC(d.silentBytes, 64));
+            ok = (d.partSilent != nullptr);
+        }
+        if (!ok)
+            break;
+
+        // 全入力が同一レイヤー構成 (attach 時に検証済み) のため、配置 (bin-major を含む) によらず要素ごとに加算できる
+        const size_t count = d.arrayBytes / (d.compact ? sizeof(float) : sizeof(double));
+        if (d.compact)
+        {
+            std::fill(d.reF, d.reF + count, 0.0f);
+            std::fill(d.imF, d.imF + count, 0.0f);
+        }
+        else
+        {
+            std::fill(d.re, d.re + count, 0.0);
+            std::fill(d.im, d.im + count, 0.0);
+        }
+        if (d.partSilent != nullptr)
+            std::fill(d.partSilent, d.partSilent + d.numParts, uint8_t { 1 });
+
+        for (int in = 0; in < m_numBusInputs; ++in)
+        {
+            const double g = gains[in];
+            if (g == 0.0)
+                continue;
+            const auto& src = m_busSpectra[in]->layers[li];
+            if (d.compact)
+            {
+                const float gf = static_cast<float>(g);
+                for (size_t k = 0; k < count; ++k)
+                {
+                    d.reF[k] += gf * src.reF[k];
+                    d.imF[k] += gf * src.imF[k];
+                }
+            }
+            else
+            {
+                for (size_t k = 0; k < count; ++k)
+                {
+                    d.re[k] += g * src.re[k];
+                    d.im[k] += g * src.im[k];
+                }
+            }
+            // 無音パーティションは「ゲインが 0 でない全入力で無音」のときだけ残す
+            if (d.partSilent != nullptr)
+            {
+                for (int p = 0; p < d.numParts; ++p)
+                    d.partSilent[p] = static_cast<uint8_t>(d.partSilent[p] & ((src.partSilent != nullptr) ? src.partSilent[p] : 0));
+            }
+        }
+        if (d.partSilent != nullptr)
+            d.numSilentParts = static_cast<int>(std::count(d.partSilent, d.partSilent + d.numParts, uint8_t { 1 }));
+        spectraBytes += s->layerBytes(li);
+    }
+
+    if (!ok)
+    {
+        SharedSpectra* failed = s;
+        releaseSpectra(failed);
+        return nullptr;
+    }
+    s->charge.set(spectraBytes);
+    return s;
+}
+
+bool MKLNonUniformConvolver::attachSpectralBus(const MKLNonUniformConvolver* const* inputs, int numInputs, const double* gains) noexcept
+{
+    if (inputs == nullptr || gains == nullptr || numInputs <= 0 || numInputs + 1 > kMaxSpectralBusInputs
+        || m_numBusInputs != 0 || m_spectra == nullptr)
+        return false;
+    for (int i = 0; i < numInputs; ++i)
+    {
+        if (inputs[i] == nullptr || !isSpectralCrossfadeCompatible(*inputs[i]))
+            return false;
+    }
+
+    m_busSpectra[0] = retainSpectra(m_spectra);
+    for (int i = 0; i < numInputs; ++i)
+        m_busSpectra[i + 1] = retainSpectra(inputs[i]->m_spectra);
+    m_numBusInputs = numInputs + 1;
+
+    SharedSpectra* mixed = mixBusSpectra(gains);
+    if (mixed == nullptr)
+    {
+        for (auto*& s : m_busSpectra)
+            releaseSpectra(s);
+        m_numBusInputs = 0;
+        return false;
+    }
+
+    // 公開前のため Audio Thread を介さずにレイヤーの参照先を合成スペクトルへ切り替える
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        const auto& d = mixed->layers[li];
+        l.irFreqReal     = d.re;
+        l.irFreqImag     = d.im;
+        l.irFreqRealF    = d.reF;
+        l.irFreqImagF    = d.imF;
+        l.partSilent     = d.partSilent;
+        l.numSilentParts = d.numSilentParts;
+    }
+    std::swap(m_spectra, mixed);
+    releaseSpectra(mixed);   // 入力 0 として m_busSpectra[0] が保持している
+    m_spectraReused = false;
+    m_spectraRetuned = false;
+    m_memoryCharge.set(computeOwnedBytes());
+    return true;
+}
+
+bool MKLNonUniformConvolver::setSpectralBusGains(const double* gains, int fadeSamples) noexcept
+{
+    if (m_numBusInputs == 0 || !isReady() || m_fadeSpectra != nullptr || m_morphSpectra != nullptr)
+        return false;
+
+    SharedSpectra* mixed = mixBusSpectra(gains);
+    if (mixed == nullptr)
+        return false;
+    if (beginSpectralCrossfadeTo(mixed, fadeSamples))
+        return true;
+    releaseSpectra(mixed);
+    return false;
+}
+
+//==============================================================================
+// Spectral morph  ─ Message Thread (begin / end / finish)
+//   crossfade と異なり target スペクトルへは移行せず、接続したまま m に従って合成し続ける。
+//   接続・解除は m_morphGeneration (奇数=接続) で公開し、各レイヤーは次のパーティション境界で観測する。
+//==============================================================================
+bool MKLNonUniformConvolver::isSpectralMorphCompatible(const MKLNonUniformConvolver& target) const noexcept
+{
+    // 条件は crossfade と同一 (フェード中・モーフ接続中・同一スペクトルは向こうが拒否する)
+    return isSpectralCrossfadeCompatible(target);
+}
+
+bool MKLNonUniformConvolver::beginSpectralMorph(const MKLNonUniformConvolver& target, int rampSamples) noexcept
+{
+    if (!isSpectralMorphCompatible(target))
+        return false;
+
+    double* accRe[kNumLayers] {};
+    double* accIm[kNumLayers] {};
+    bool allocated = true;
+    for (int li = 0; li < m_numActiveLayers && allocated; ++li)
+    {
+        const size_t bytes = static_cast<size_t>(m_layers[li].complexSize) * sizeof(double);
+        accRe[li] = static_cast<double*>(DIAG_MKL_MALLOC(bytes, 64));
+        accIm[li] = static_cast<double*>(DIAG_MKL_MALLOC(bytes, 64));
+        allocated = (accRe[li] != nullptr && accIm[li] != nullptr);
+    }
+    if (!allocated)
+    {
+        for (int li = 0; li < m_numActiveLayers; ++li)
+        {
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.fftOutBuf = l.fftSize * sizeof(double);
+            const size_t bytes = static_cast<size_t>(m_layers[li].complexSize) * sizeof(double);
+            freeTracked(accRe[li], bytes);
+            freeTracked(accIm[li], bytes);
+#else
+            if (accRe[li]) mkl_free(accRe[li]);
+            if (accIm[li]) mkl_free(accIm[li]);
 #endif
-        l.prevInputBuf = static_cast<double*>(DIAG_MKL_MALLOC(l.partSize  * sizeof(double), 64));
+        }
+        return false;
+    }
+
+    SharedSpectra* const src = retainSpectra(target.m_spectra);
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        const auto& d = src->layers[li];
+        l.morphIrFreqReal  = d.re;
+        l.morphIrFreqImag  = d.im;
+        l.morphIrFreqRealF = d.reF;
+        l.morphIrFreqImagF = d.imF;
+        l.morphPartSilent  = d.partSilent;
+        l.morphAccumReal   = accRe[li];
+        l.morphAccumImag   = accIm[li];
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.prevInputBuf = l.partSize * sizeof(double);
+        l.allocSizes.morphAccum = static_cast<size_t>(l.complexSize) * sizeof(double);
 #endif
-        l.accumBuf     = static_cast<double*>(DIAG_MKL_MALLOC(l.partStride * sizeof(double), 64));
+        // パーティション単位で追従するため、partSize が rampSamples 以上のレイヤーは 1 ステップで目標へ達する
+        l.morphStep = (rampSamples > l.partSize)
+                    ? static_cast<double>(l.partSize) / static_cast<double>(rampSamples)
+                    : 1.0;
+    }
+    m_morphSpectra = src;
+    m_memoryCharge.set(computeOwnedBytes());
+
+    convo::publishAtomic(m_morphTarget, 0.0, std::memory_order_relaxed); // relaxed: 単独の目標値 (接続は直後の release で公開)
+    convo::fetchAddAtomic(m_morphGeneration, 1u, std::memory_order_release); // release: morph* 書き込みを beginSpectralMorphBlock の acquire と HB
+    return true;
+}
+
+void MKLNonUniformConvolver::setSpectralMorphAmount(double amount) noexcept
+{
+    convo::publishAtomic(m_morphTarget, juce::jlimit(0.0, 1.0, amount), std::memory_order_relaxed); // relaxed: 単独の目標値 (各レイヤーが次パーティションで読む)
+}
+
+double MKLNonUniformConvolver::getSpectralMorphAmount() const noexcept
+{
+    return convo::consumeAtomic(m_morphTarget, std::memory_order_relaxed); // relaxed: 単独の目標値
+}
+
+void MKLNonUniformConvolver::endSpectralMorph() noexcept
+{
+    if (m_morphSpectra == nullptr
+        || (convo::consumeAtomic(m_morphGeneration, std::memory_order_relaxed) & 1u) == 0) // relaxed: 書き手は Message Thread のみ
+        return;
+
+    convo::publishAtomic(m_morphLayersDetached, 0, std::memory_order_relaxed); // relaxed: 直後の m_morphGeneration release で公開
+    convo::fetchAddAtomic(m_morphGeneration, 1u, std::memory_order_release); // release: 解除要求を beginSpectralMorphBlock の acquire へ
+}
+
+bool MKLNonUniformConvolver::finishSpectralMorph() noexcept
+{
+    if (m_morphSpectra == nullptr)
+        return true;
+    if ((convo::consumeAtomic(m_morphGeneration, std::memory_order_relaxed) & 1u) != 0 // relaxed: 書き手は Message Thread のみ
+        || convo::consumeAtomic(m_morphLayersDetached, std::memory_order_acquire) < m_numActiveLayers) // acquire: 解除後は morph* を読まないことと HB
+        return false;
+
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.accumBuf = l.partStride * sizeof(double);
+        freeTracked(l.morphAccumReal, l.allocSizes.morphAccum);
+        freeTracked(l.morphAccumImag, l.allocSizes.morphAccum);
+        l.allocSizes.morphAccum = 0;
+#else
+        if (l.morphAccumReal) { mkl_free(l.morphAccumReal); l.morphAccumReal = nullptr; }
+        if (l.morphAccumImag) { mkl_free(l.morphAccumImag); l.morphAccumImag = nullptr; }
 #endif
-        l.accumReal    = static_cast<double*>(DIAG_MKL_MALLOC(l.complexSize * sizeof(double), 64));
+        l.morphIrFreqReal = l.morphIrFreqImag = nullptr;
+        l.morphIrFreqRealF = l.morphIrFreqImagF = nullptr;
+        l.morphPartSilent = nullptr;
+    }
+
+    releaseSpectra(m_morphSpectra);
+    m_memoryCharge.set(computeOwnedBytes());
+    return true;
+}
+
+void MKLNonUniformConvolver::releaseAllLayers() noexcept
+{
+    #ifdef NUC_DEBUG_GUARDS
+        checkGuards();
+        // ... 既存の checkPtr 群（変更なし）...
+        auto checkPtr = [](double *&ptr){
+            if (ptr != nullptr){
+                auto addr = reinterpret_cast<uintptr_t>(ptr);
+                if (addr == 0xFFFFFFFFFFFFFFFFULL ||
+                    (addr & 0xFFFFFFFF00000000) == 0xCDCDCDCD00000000ULL ||
+                     addr < 0x10000)
+            {
+                __debugbreak();
+            }
+        }
+    };
+    checkPtr(m_ringBuf);
+    checkPtr(m_directIRRev);
+    checkPtr(m_directHistory);
+    checkPtr(m_directWindow);
+    checkPtr(m_directOutBuf);
+    #endif
+
+    // ★ Tail Worker: レイヤーバッファ解放前に必ず停止・join する (ワーカーは FDL/scratch を参照中)
+    stopTailWorker();
+    m_tailOffload = false;
+    m_tailWorkerAffinity = nullptr;
+    m_trueStereo = false;
+    m_compactTail = false;
+    m_totalPartsIR = 0;
+    m_culledTrailingParts = 0;
+    m_culledBytes = 0;
+
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.accumReal = l.complexSize * sizeof(double);
+    // ★ work70: 解放前にスナップショットとサイズを取得
+    const uint64_t beforeMkl = convo::diag::allocatedBytes();
+    const uint32_t beforeLost = convo::diag::lostFreeCount();
+    const auto beforeOs = getProcessMemoryInfo();
+
+    // 解放前の NUC 状態を取得（TotalBefore / LayersBefore 用）
+    // ★ freeAll で Layer が初期化される前に呼ぶこと
+    NucDiagnosticsSnapshot beforeSnap;
+    beforeSnap.numActiveLayers = m_numActiveLayers;
+    beforeSnap.isReady = convo::consumeAtomic(m_ready, std::memory_order_acquire);
+    for (int li = 0; li < kNumLayers; ++li) {
+        const Layer& l = m_layers[li];
+        uint64_t irF = 0, fdl = 0, acc = 0, tail = 0;
+        irF += addIfAlive(l.irFreqDomain, l.allocSizes.irFreqDomain, "irFreqDomain");
+        if (!l.irSpectraShared)
+        {
+            irF += addIfAlive(l.irFreqReal,   l.allocSizes.irFreqReal,   "irFreqReal");
+            irF += addIfAlive(l.irFreqImag,   l.allocSizes.irFreqImag,   "irFreqImag");
+            irF += addIfAlive(l.irFreqRealF,  l.allocSizes.irFreqRealF,  "irFreqRealF");
+            irF += addIfAlive(l.irFreqImagF,  l.allocSizes.irFreqImagF,  "irFreqImagF");
+        }
+        if (m_spectra != nullptr && li < m_spectra->numLayers)
+            irF += m_spectra->layerBytes(li);              // ★ Shared spectra: 共有分 (他インスタンスと重複計上)
+        if (m_crossSpectra != nullptr && li < m_crossSpectra->numLayers)
+            irF += m_crossSpectra->layerBytes(li);
+        fdl += addIfAlive(l.fdlBuf,       l.allocSizes.fdlBuf,       "fdlBuf");
+        fdl += addIfAlive(l.fdlReal,      l.allocSizes.fdlReal,      "fdlReal");
+        fdl += addIfAlive(l.fdlImag,      l.allocSizes.fdlImag,      "fdlImag");
+        fdl += addIfAlive(l.fdlRealF,     l.allocSizes.fdlRealF,     "fdlRealF");
+        fdl += addIfAlive(l.fdlImagF,     l.allocSizes.fdlImagF,     "fdlImagF");
+        acc += addIfAlive(l.fftTimeBuf,   l.allocSizes.fftTimeBuf,   "fftTimeBuf");
+        acc += addIfAlive(l.fftOutBuf,    l.allocSizes.fftOutBuf,    "fftOutBuf");
+        acc += addIfAlive(l.prevInputBuf, l.allocSizes.prevInputBuf, "prevInputBuf");
+        acc += addIfAlive(l.accumBuf,     l.allocSizes.accumBuf,     "accumBuf");
+        acc += addIfAlive(l.accumReal,    l.allocSizes.accumReal,    "accumReal");
+        acc += addIfAlive(l.accumImag,    l.allocSizes.accumImag,    "accumImag");
+        acc += addIfAlive(l.inputAccBuf,  l.allocSizes.inputAccBuf,  "inputAccBuf");
+        tail += addIfAlive(l.tailOutputBuf,l.allocSizes.tailOutputBuf,"tailOutputBuf");
+        beforeSnap.layerBufs[li] = irF + fdl + acc + tail;
+        beforeSnap.irFreqBytes   += irF;
+        beforeSnap.fdlBytes      += fdl;
+        beforeSnap.accumBytes    += acc;
+        beforeSnap.tailBytes     += tail;
+    }
+    const uint32_t liveBefore = liveCount.load(std::memory_order_relaxed);
+
+    // NUC レベルバッファの解放サイズを事前退避（ガード後、解放前に）
+    const size_t ringBufBytes    = static_cast<size_t>(m_ringSize) * sizeof(double);
+    const size_t directIRBytes   = static_cast<size_t>(m_directTapCount) * sizeof(double);
+    const size_t directHistBytes = static_cast<size_t>(m_directHistLen) * sizeof(double);
+    const size_t directWinBytes  = static_cast<size_t>(m_directHistLen + m_directMaxBlock) * sizeof(double);
+    const size_t directOutBytes  = static_cast<size_t>(m_directMaxBlock) * sizeof(double);
 #endif
-        l.accumImag    = static_cast<double*>(DIAG_MKL_MALLOC(l.complexSize * sizeof(double), 64));
+
+    unbindFarTailPager();
+    for (int i = 0; i < kNumLayers; ++i)
+        m_layers[i].freeAll();
+    m_numActiveLayers = 0;
+    m_latency         = 0;
+
+    // ★ Shared spectra: 最後の参照であれば IR スペクトル実体もここで解放される
+    releaseSpectra(m_spectra);
+    releaseSpectra(m_crossSpectra);
+    releaseSpectra(m_fadeSpectra);
+    releaseSpectra(m_morphSpectra);
+    for (auto*& s : m_busSpectra)
+        releaseSpectra(s);
+    m_numBusInputs = 0;
+    m_spectraReused = false;
+    m_spectraRetuned = false;
+    convo::publishAtomic(m_fadeLayersDone, 0, std::memory_order_relaxed); // relaxed: Audio Thread は m_ready=false 後のみ
+    // ★ Spectral morph: 接続中の世代 (奇数) を残すと、次の SetImpulse 後のレイヤーが解放済みの morph* を観測し得る
+    if ((convo::consumeAtomic(m_morphGeneration, std::memory_order_relaxed) & 1u) != 0) // relaxed: 書き手は Message Thread のみ
+        convo::fetchAddAtomic(m_morphGeneration, 1u, std::memory_order_relaxed); // relaxed: 同上 (m_ready=false 中)
+    convo::publishAtomic(m_morphTarget, 0.0, std::memory_order_relaxed); // relaxed: 単独の目標値
+
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.accumImag = l.complexSize * sizeof(double);
+    // ★ work70: NUC レベルバッファも freeTracked で解放
+    freeTracked(m_ringBuf,       ringBufBytes);
+    freeTracked(m_directIRRev,   directIRBytes);
+    freeTracked(m_directHistory, directHistBytes);
+    freeTracked(m_directWindow,  directWinBytes);
+    freeTracked(m_directOutBuf,  directOutBytes);
+#else
+    if (m_ringBuf) { mkl_free(m_ringBuf); m_ringBuf = nullptr; }
+    if (m_directIRRev)   { mkl_free(m_directIRRev);   m_directIRRev = nullptr; }
+    if (m_directHistory) { mkl_free(m_directHistory); m_directHistory = nullptr; }
+    if (m_directWindow)  { mkl_free(m_directWindow);  m_directWindow = nullptr; }
+    if (m_directOutBuf)  { mkl_free(m_directOutBuf);  m_directOutBuf = nullptr; }
 #endif
-        l.inputAccBuf  = static_cast<double*>(DIAG_MKL_MALLOC(l.partSize  * sizeof(double), 64));
+
+    m_ringSize = m_ringMask = m_ringWrite = m_ringRead = m_ringAvail = 0;
+
+    m_directTapCount = 0;
+    m_directHistLen  = 0;
+    m_directMaxBlock = 0;
+    m_directPendingSamples = 0;
+    m_directEnabled  = false;
+
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-l.allocSizes.inputAccBuf = l.partSize * sizeof(double);
+    const auto afterReleaseOs = getProcessMemoryInfo();
+    logIrRelease(this, kDiagSeqReserved,
+                 beforeMkl, beforeLost, beforeOs,
+                 beforeSnap, afterReleaseOs, liveBefore);
+#endif
+    m_tailEnabled = true;
+    m_tailStrength = 1.0;
+    for (int i = 0; i < kNumLayers; ++i)
+        m_tailLayerGain[i] = 1.0;
+    m_memoryCharge.set(0);
+}
+
+//==============================================================================
+// computeOwnedBytes  ─ MemoryLedger 用。確保済みのポインタだけを SetImpulse と同じサイズ式で数える
+//   irSpectraShared のレイヤーの IR スペクトル・無音マスクは SharedSpectra の申告に含まれる。
+//==============================================================================
+uint64_t MKLNonUniformConvolver::computeOwnedBytes() const noexcept
+{
+    auto bytesIf = [](const void* p, int64_t count, size_t elemBytes) noexcept -> uint64_t
+    {
+        return (p != nullptr && count > 0) ? static_cast<uint64_t>(count) * elemBytes : 0;
+    };
+
+    uint64_t total = 0;
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        const Layer& l = m_layers[li];
+        const int64_t spectrum = static_cast<int64_t>(l.numParts) * l.complexSize;
+        total += bytesIf(l.irFreqDomain, l.partStride, sizeof(double));
+        if (!l.irSpectraShared)
+        {
+            total += bytesIf(l.irFreqReal,  spectrum, sizeof(double)) + bytesIf(l.irFreqImag,  spectrum, sizeof(double));
+            total += bytesIf(l.irFreqRealF, spectrum, sizeof(float))  + bytesIf(l.irFreqImagF, spectrum, sizeof(float));
+            total += bytesIf(l.partSilent,  l.numParts, 1);
+        }
+        total += bytesIf(l.fdlBuf, static_cast<int64_t>(l.partStride) * 2, sizeof(double));
+        total += bytesIf(l.fdlReal,  spectrum * 2, sizeof(double)) + bytesIf(l.fdlImag,  spectrum * 2, sizeof(double));
+        total += bytesIf(l.fdlRealF, spectrum * 2, sizeof(float))  + bytesIf(l.fdlImagF, spectrum * 2, sizeof(float));
+        total += bytesIf(l.fftTimeBuf, l.fftSize, sizeof(double)) + bytesIf(l.fftOutBuf, l.fftSize, sizeof(double));
+        total += bytesIf(l.prevInputBuf, l.partSize, sizeof(double)) + bytesIf(l.inputAccBuf, l.partSize, sizeof(double));
+        total += bytesIf(l.accumBuf, l.partStride, sizeof(double));
+        total += bytesIf(l.accumReal, l.complexSize, sizeof(double)) + bytesIf(l.accumImag, l.complexSize, sizeof(double));
+        total += bytesIf(l.tailOutputBuf, l.partSize, sizeof(double));
+        total += bytesIf(l.delayLineBuf, l.delayLineCapacity, sizeof(double));
+        total += bytesIf(l.jobInputBuf,  static_cast<int64_t>(kTailJobSlots) * l.partSize, sizeof(double));
+        total += bytesIf(l.jobOutputBuf, static_cast<int64_t>(kTailJobSlots) * l.partSize, sizeof(double));
+        total += bytesIf(l.fadeAccumReal, l.complexSize, sizeof(double)) + bytesIf(l.fadeAccumImag, l.complexSize, sizeof(double));
+        total += bytesIf(l.morphAccumReal, l.complexSize, sizeof(double)) + bytesIf(l.morphAccumImag, l.complexSize, sizeof(double));
+        total += bytesIf(l.rateInputBuf, static_cast<int64_t>(m_maxBlockSize) / l.decimation + 2, sizeof(double));
+        total += bytesIf(l.rateOutputBuf, static_cast<int64_t>(l.partSize) * l.decimation, sizeof(double));
+    }
+
+    total += bytesIf(m_ringBuf, m_ringSize, sizeof(double));
+    total += bytesIf(m_directIRRev,   m_directTapCount, sizeof(double));
+    total += bytesIf(m_directHistory, m_directHistLen, sizeof(double));
+    total += bytesIf(m_directWindow,  static_cast<int64_t>(m_directHistLen) + m_directMaxBlock, sizeof(double));
+    total += bytesIf(m_directOutBuf,  m_directMaxBlock, sizeof(double));
+    return total;
+}
+
+//==============================================================================
+// compactLayerSpectra  ─ Message Thread のみ (SetImpulse 末尾、公開前)
+//   L1/L2 の irFreqReal/irFreqImag を float32 へ変換し、double 版と fdlReal/fdlImag を解放する。
+//   FDL は SetImpulse 直後でゼロのため変換不要 (float32 版をゼロ確保する)。
+//   @return true=変換成功, false=確保失敗 (レイヤーは double のまま変更しない)
+//==============================================================================
+bool MKLNonUniformConvolver::compactLayerSpectra(Layer& l) noexcept
+{
+    if (l.isImmediate || l.compactSpectra || l.irSpectraShared || !l.irFreqReal || !l.irFreqImag
+        || l.numParts <= 0 || l.complexSize <= 0)
+        return l.compactSpectra;
+
+    const size_t irSoaBytes  = static_cast<size_t>(l.numParts) * static_cast<size_t>(l.complexSize) * sizeof(float);
+    const size_t fdlSoaBytes = irSoaBytes * 2;
+
+    float* irRe  = static_cast<float*>(DIAG_MKL_MALLOC(irSoaBytes,  64));
+    float* irIm  = static_cast<float*>(DIAG_MKL_MALLOC(irSoaBytes,  64));
+    float* fdlRe = static_cast<float*>(DIAG_MKL_MALLOC(fdlSoaBytes, 64));
+    float* fdlIm = static_cast<float*>(DIAG_MKL_MALLOC(fdlSoaBytes, 64));
+    if (!irRe || !irIm || !fdlRe || !fdlIm)
+    {
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+        freeTracked(irRe,  irSoaBytes);
+        freeTracked(irIm,  irSoaBytes);
+        freeTracked(fdlRe, fdlSoaBytes);
+        freeTracked(fdlIm, fdlSoaBytes);
+#else
+        if (irRe)  mkl_free(irRe);
+        if (irIm)  mkl_free(irIm);
+        if (fdlRe) mkl_free(fdlRe);
+        if (fdlIm) mkl_free(fdlIm);
+#endif
+        juce::Logger::writeToLog("MKLNonUniformConvolver: OOM in compactLayerSpectra (layer stays double)");
+        return false;
+    }
+
+    const size_t irSoaSize = static_cast<size_t>(l.numParts) * static_cast<size_t>(l.complexSize);
+    for (size_t i = 0; i < irSoaSize; ++i)
+    {
+        irRe[i] = static_cast<float>(l.irFreqReal[i]);
+        irIm[i] = static_cast<float>(l.irFreqImag[i]);
+    }
+    juce::FloatVectorOperations::clear(fdlRe, static_cast<int>(irSoaSize * 2));
+    juce::FloatVectorOperations::clear(fdlIm, static_cast<int>(irSoaSize * 2));
+
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+    freeTracked(l.irFreqReal, l.allocSizes.irFreqReal);
+    freeTracked(l.irFreqImag, l.allocSizes.irFreqImag);
+    freeTracked(l.fdlReal,    l.allocSizes.fdlReal);
+    freeTracked(l.fdlImag,    l.allocSizes.fdlImag);
+    l.allocSizes.irFreqReal  = l.allocSizes.irFreqImag  = 0;
+    l.allocSizes.fdlReal     = l.allocSizes.fdlImag     = 0;
+    l.allocSizes.irFreqRealF = l.allocSizes.irFreqImagF = irSoaBytes;
+    l.allocSizes.fdlRealF    = l.allocSizes.fdlImagF    = fdlSoaBytes;
+#else
+    mkl_free(l.irFreqReal); l.irFreqReal = nullptr;
+    mkl_free(l.irFreqImag); l.irFreqImag = nullptr;
+    if (l.fdlReal) { mkl_free(l.fdlReal); l.fdlReal = nullptr; }
+    if (l.fdlImag) { mkl_free(l.fdlImag); l.fdlImag = nullptr; }
+#endif
+
+    l.irFreqRealF = irRe;
+    l.irFreqImagF = irIm;
+    l.fdlRealF    = fdlRe;
+    l.fdlImagF    = fdlIm;
+    l.compactSpectra = true;
+    return true;
+}
+
+//==============================================================================
+// adoptCompactSpectra  ─ Message Thread のみ (SetImpulse 末尾、公開前)
+//   共有 float32 IR スペクトルを参照するレイヤーの FDL を float32 へ切り替える
+//   (Shared spectra 再利用時。IR の変換は donor 側で済んでいる)。
+//   @return true=成功, false=確保失敗 (レイヤーは変更しない)
+//==============================================================================
+bool MKLNonUniformConvolver::adoptCompactSpectra(Layer& l, float* irRe, float* irIm) noexcept
+{
+    if (l.isImmediate || irRe == nullptr || irIm == nullptr || l.numParts <= 0 || l.complexSize <= 0)
+        return false;
+
+    const size_t fdlSoaSize  = static_cast<size_t>(l.numParts) * 2 * static_cast<size_t>(l.complexSize);
+    const size_t fdlSoaBytes = fdlSoaSize * sizeof(float);
+    float* fdlRe = static_cast<float*>(DIAG_MKL_MALLOC(fdlSoaBytes, 64));
+    float* fdlIm = static_cast<float*>(DIAG_MKL_MALLOC(fdlSoaBytes, 64));
+    if (!fdlRe || !fdlIm)
+    {
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+        freeTracked(fdlRe, fdlSoaBytes);
+        freeTracked(fdlIm, fdlSoaBytes);
+#else
+        if (fdlRe) mkl_free(fdlRe);
+        if (fdlIm) mkl_free(fdlIm);
+#endif
+        return false;
+    }
+    juce::FloatVectorOperations::clear(fdlRe, static_cast<int>(fdlSoaSize));
+    juce::FloatVectorOperations::clear(fdlIm, static_cast<int>(fdlSoaSize));
+
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+    freeTracked(l.fdlReal, l.allocSizes.fdlReal);
+    freeTracked(l.fdlImag, l.allocSizes.fdlImag);
+    l.allocSizes.fdlReal  = l.allocSizes.fdlImag  = 0;
+    l.allocSizes.fdlRealF = l.allocSizes.fdlImagF = fdlSoaBytes;
+#else
+    if (l.fdlReal) { mkl_free(l.fdlReal); l.fdlReal = nullptr; }
+    if (l.fdlImag) { mkl_free(l.fdlImag); l.fdlImag = nullptr; }
+#endif
+
+    l.irFreqRealF = irRe;
+    l.irFreqImagF = irIm;
+    l.fdlRealF    = fdlRe;
+    l.fdlImagF    = fdlIm;
+    l.compactSpectra = true;
+    return true;
+}
+
+//==============================================================================
+// tileLayerSpectra  ─ Message Thread のみ (SetImpulse 末尾、公開前)
+//   フィルター/テール処理・無音判定済みの irFreqReal/irFreqImag を BinTileLayout 配置へ並べ替え、
+//   FDL もタイル配置として扱うよう切り替える。FDL は SetImpulse 直後でゼロのため変換不要。
+//   @return true=タイル化した, false=一時バッファの確保失敗 (レイヤーはパーティション優先のまま)
+//==============================================================================
+bool MKLNonUniformConvolver::tileLayerSpectra(Layer& l) noexcept
+{
+    if (l.binMajor || l.compactSpectra || l.irSpectraShared || !l.irFreqReal || !l.irFreqImag || !l.fdlReal
+        || l.numParts <= 0 || l.complexSize <= 0)
+        return l.binMajor;
+
+    const size_t irSoaSize = static_cast<size_t>(l.numParts) * static_cast<size_t>(l.complexSize);
+    convo::ScopedAlignedPtr<double> scratch(static_cast<double*>(mkl_malloc(irSoaSize * sizeof(double), 64)));
+    if (!scratch.get())
+    {
+        juce::Logger::writeToLog("MKLNonUniformConvolver: OOM in tileLayerSpectra (layer stays partition-major)");
+        return false;
+    }
+
+    for (double* spectrum : { l.irFreqReal, l.irFreqImag })
+    {
+        convo::BinTileLayout::toBinMajor(spectrum, scratch.get(), l.numParts, l.complexSize);
+        std::memcpy(spectrum, scratch.get(), irSoaSize * sizeof(double));
+    }
+    l.binMajor = true;
+    return true;
+}
+
+//==============================================================================
+// computeCulledIRLength  ─ 純関数 (SetImpulse / StereoConvolver から使用)
+//==============================================================================
+int MKLNonUniformConvolver::resolveTailL1L2Multiplier(const FilterSpec* filterSpec) noexcept
+{
+    const int requested = (filterSpec != nullptr) ? juce::jlimit(2, 16, filterSpec->tailL1L2Multiplier) : 8;
+    const int tailMode = (filterSpec != nullptr) ? juce::jlimit(0, 2, filterSpec->tailMode) : 1;
+    const bool tailEnabled = (tailMode != 2) && ((filterSpec != nullptr) ? filterSpec->tailEnabled : true);
+    if (!tailEnabled)
+        return requested;
+
+    if (tailMode == 0)
+        return juce::jlimit(2, 16, std::max(requested, 6));  // Air Absorption: 下限 6
+
+    // Layer Tail Contouring: tailL1L2Mult 最小値を 12→8 に緩和（案A）。数学的に出力は同一であり、
+    // L2 small buffers (fftTimeBuf/fftOutBuf 等) が 12.4MB → 5.5MB (56%減)。
+    // 83ms IR 環境では L1/L2 が生成されないため影響ゼロ。
+    return juce::jlimit(2, 16, std::max(requested, 8));
+}
+
+int MKLNonUniformConvolver::resolveTailDecimation(const FilterSpec* filterSpec) noexcept
+{
+    if (filterSpec == nullptr || filterSpec->tailDecimation == 1 || !filterSpec->tailEnabled
+        || filterSpec->tailMode == 2 || filterSpec->farTailHorizonSeconds > 0.0)
+        return 1;
+
+    // 0 (自動) は 8 から、明示指定はその値から下げていき、20 kHz を保てる最大の比を選ぶ。
+    // L2 のスペクトルフィルターは 20 kHz 以下を大きく削らないため、比はレートだけで決まる
+    // (88.2k/96k → 2, 176.4k/192k → 4, 384k → 8, 44.1k/48k → 無効)
+    const int requested = filterSpec->tailDecimation;
+    const int cap = (requested <= 0 || requested >= 8) ? 8 : (requested >= 4 ? 4 : 2);
+    const double fs = filterSpec->sampleRate;
+    for (int d = cap; d >= 2; d /= 2)
+    {
+        const int taps = convo::dsp::HalfBandCascade::estimateTaps(2.0 * fs / d, kTailDecimationPassbandHz,
+                                                                   kTailDecimationAttenuationDb);
+        if (taps > 0 && taps <= convo::dsp::HalfBandCascade::kMaxTaps)
+            return d;
+    }
+    return 1;
+}
+
+//==============================================================================
+// resolveDirectHeadTaps  ─ 任意スレッド (純関数)
+//==============================================================================
+int MKLNonUniformConvolver::resolveDirectHeadTaps(int blockSize) noexcept
+{
+    // L0 を N で割るため、1 コールバックの L0 FFT 回数は blockSize / N (≒ 4 回) に収まり、
+    // 時間領域 FIR は 1 サンプル N 回の積和 (上限 256) で止まる
+    return juce::jlimit(kMinDirectHeadTaps, kMaxDirectHeadTaps, juce::nextPowerOfTwo(std::max(blockSize, 1)) / 4);
+}
+
+int MKLNonUniformConvolver::computeCulledIRLength(const double* impulse, int irLen, int blockSize, double floorDb) noexcept
+{
+    if (impulse == nullptr || irLen <= 0 || blockSize <= 0 || !(floorDb > FilterSpec::kPartitionCullDisabledDb))
+        return irLen;
+
+    // SetImpulse の L0 パーティションサイズと同一の粒度
+    const int chunk = juce::nextPowerOfTwo(std::max(blockSize, 64));
+    const int numChunks = (irLen + chunk - 1) / chunk;
+    auto chunkEnergy = [&](int c)
+    {
+        const int begin = c * chunk;
+        const int end = std::min(irLen, begin + chunk);
+        double e = 0.0;
+        for (int i = begin; i < end; ++i)
+            e += impulse[i] * impulse[i];
+        return e;
+    };
+
+    double peak = 0.0;
+    for (int c = 0; c < numChunks; ++c)
+        peak = std::max(peak, chunkEnergy(c));
+    if (!(peak > 0.0))
+        return irLen;
+
+    const double threshold = peak * std::pow(10.0, floorDb / 10.0);
+    int lastActive = numChunks - 1;
+    while (lastActive > 0 && chunkEnergy(lastActive) <= threshold)
+        --lastActive;
+    return std::min(irLen, (lastActive + 1) * chunk);
+}
+
+//==============================================================================
+// markSilentPartitions  ─ Message Thread のみ (SetImpulse 末尾、Compact tail 変換前)
+//   各パーティションの時間領域エネルギー (Parseval: (2Σ|X_k|^2 - |X_0|^2 - |X_N/2|^2) / N) を
+//   全レイヤー共通のピークと比較し、floor 以下のパーティションを partSilent に記録する。
+//   確保失敗時はそのレイヤーの MAC スキップを行わないだけで動作は変わらない。
+//==============================================================================
+void MKLNonUniformConvolver::markSilentPartitions(double floorDb) noexcept
+{
+    auto partEnergy = [](const Layer& l, int p)
+    {
+        const double* re = l.irFreqReal + static_cast<size_t>(p) * l.complexSize;
+        const double* im = l.irFreqImag + static_cast<size_t>(p) * l.complexSize;
+        double sum = 0.0;
+        for (int k = 0; k < l.complexSize; ++k)
+            sum += re[k] * re[k] + im[k] * im[k];
+        const int last = l.complexSize - 1;
+        const double edge = re[0] * re[0] + im[0] * im[0] + re[last] * re[last] + im[last] * im[last];
+        return (2.0 * sum - edge) / static_cast<double>(l.fftSize);
+    };
+
+    double peak = 0.0;
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        const Layer& l = m_layers[li];
+        if (!l.irFreqReal || !l.irFreqImag)
+            return;  // 想定外 (共有/変換済み): 判定しない
+        for (int p = 0; p < l.numPartsIR; ++p)
+            peak = std::max(peak, partEnergy(l, p));
+    }
+    if (!(peak > 0.0))
+        return;
+
+    const double threshold = peak * std::pow(10.0, floorDb / 10.0);
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        int silent = 0;
+        for (int p = 0; p < l.numPartsIR; ++p)
+            silent += (partEnergy(l, p) <= threshold) ? 1 : 0;
+        if (silent == 0)
+            continue;
+
+        l.partSilent = static_cast<uint8_t*>(DIAG_MKL_MALLOC(static_cast<size_t>(l.numParts), 64));
+        if (!l.partSilent)
+            continue;
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+        l.allocSizes.partSilent = static_cast<size_t>(l.numParts);
+#endif
+        memset(l.partSilent, 0, static_cast<size_t>(l.numParts));
+        for (int p = 0; p < l.numPartsIR; ++p)
+            l.partSilent[p] = (partEnergy(l, p) <= threshold) ? 1 : 0;
+        l.numSilentParts = silent;
+    }
+}
+
+//==============================================================================
+// ★ work70: getDiagnostics  ─ Message Thread のみ
+//==============================================================================
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+NucDiagnosticsSnapshot MKLNonUniformConvolver::getDiagnostics() const noexcept
+{
+    jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    NucDiagnosticsSnapshot snap{};
+    snap.numActiveLayers = m_numActiveLayers;
+    snap.isReady = convo::consumeAtomic(m_ready, std::memory_order_acquire);
+    snap.totalPartsIR = m_totalPartsIR;
+    snap.culledTrailingParts = m_culledTrailingParts;
+    snap.culledBytes = m_culledBytes;
+    snap.spectraRefCount = (m_spectra != nullptr) ? convo::consumeAtomic(m_spectra->refCount, std::memory_order_relaxed) : 0; // relaxed: 診断表示のみ
+    snap.spectraReused = m_spectraReused;
+    snap.spectraRetuned = m_spectraRetuned;
+
+    for (int li = 0; li < kNumLayers; ++li)
+    {
+        const Layer& l = m_layers[li];
+        uint64_t irFreq = 0, fdl = 0, accum = 0, tail = 0;
+
+        irFreq += addIfAlive(l.irFreqDomain, l.allocSizes.irFreqDomain, "irFreqDomain");
+        if (!l.irSpectraShared)
+        {
+            irFreq += addIfAlive(l.irFreqReal, l.allocSizes.irFreqReal, "irFreqReal");
+            irFreq += addIfAlive(l.irFreqImag, l.allocSizes.irFreqImag, "irFreqImag");
+        }
+
+        // ★ Shared spectra: 共有 IR スペクトル (+ 無音マスク) は SharedSpectra 側のサイズで計上する
+        uint64_t shared = 0;
+        uint64_t sharedCompact = 0;
+        if (m_spectra != nullptr && li < m_spectra->numLayers)
+        {
+            shared += m_spectra->layerBytes(li);
+            if (m_spectra->layers[li].compact)
+                sharedCompact = static_cast<uint64_t>(m_spectra->layers[li].arrayBytes) * 2;
+        }
+        if (m_crossSpectra != nullptr && li < m_crossSpectra->numLayers)
+            shared += m_crossSpectra->layerBytes(li);
+        irFreq += shared;
+        snap.sharedSpectraBytes += shared;
+        fdl    += addIfAlive(l.fdlBuf,       l.allocSizes.fdlBuf,       "fdlBuf");
+        fdl    += addIfAlive(l.fdlReal,      l.allocSizes.fdlReal,      "fdlReal");
+        fdl    += addIfAlive(l.fdlImag,      l.allocSizes.fdlImag,      "fdlImag");
+
+        // ★ Compact tail: float32 バッファは double 版の半分。差分 (= float32 版と同サイズ) を節約量として報告
+        uint64_t compact = sharedCompact;
+        if (!l.irSpectraShared)
+        {
+            const uint64_t ownCompact = addIfAlive(l.irFreqRealF, l.allocSizes.irFreqRealF, "irFreqRealF")
+                                      + addIfAlive(l.irFreqImagF, l.allocSizes.irFreqImagF, "irFreqImagF");
+            irFreq  += ownCompact;
+            compact += ownCompact;
+        }
+        const uint64_t compactFdl = addIfAlive(l.fdlRealF, l.allocSizes.fdlRealF, "fdlRealF")
+                                  + addIfAlive(l.fdlImagF, l.allocSizes.fdlImagF, "fdlImagF");
+        fdl     += compactFdl;
+        compact += compactFdl;
+        if (l.compactSpectra)
+        {
+            ++snap.compactLayers;
+            snap.compactSavedBytes += compact;
+        }
+        accum  += addIfAlive(l.fftTimeBuf,   l.allocSizes.fftTimeBuf,   "fftTimeBuf");
+        accum  += addIfAlive(l.fftOutBuf,    l.allocSizes.fftOutBuf,    "fftOutBuf");
+        accum  += addIfAlive(l.prevInputBuf, l.allocSizes.prevInputBuf, "prevInputBuf");
+        accum  += addIfAlive(l.accumBuf,     l.allocSizes.accumBuf,     "accumBuf");
+        accum  += addIfAlive(l.accumReal,    l.allocSizes.accumReal,    "accumReal");
+        accum  += addIfAlive(l.accumImag,    l.allocSizes.accumImag,    "accumImag");
+        accum  += addIfAlive(l.inputAccBuf,  l.allocSizes.inputAccBuf,  "inputAccBuf");
+        tail   += addIfAlive(l.tailOutputBuf,l.allocSizes.tailOutputBuf,"tailOutputBuf");
+
+        snap.culledSilentParts += l.numSilentParts;
+
+        snap.layerBufs[li]  = irFreq + fdl + accum + tail;
+        snap.irFreqBytes   += irFreq;
+        snap.fdlBytes      += fdl;
+        snap.accumBytes    += accum;
+        snap.tailBytes     += tail;
+    }
+
+    snap.directBytes = addIfAlive(m_directIRRev,
+        static_cast<size_t>(m_directTapCount) * sizeof(double), "directIRRev");
+    snap.ringBytes   = addIfAlive(m_ringBuf,
+        static_cast<size_t>(m_ringSize) * sizeof(double), "ringBuf");
+    return snap;
+}
+#endif
+
+//==============================================================================
+// SetImpulse  ─ Message Thread のみ
+//==============================================================================
+bool MKLNonUniformConvolver::SetImpulse(const double* impulse, int irLen, int blockSize, double scale,
+                                        bool enableDirectHead,
+                                        const FilterSpec* filterSpec,
+                                        const MKLNonUniformConvolver* spectraDonor)
+{
+    convo::publishAtomic(m_ready, false, std::memory_order_release);
+
+    if (impulse == nullptr || irLen <= 0 || blockSize <= 0)
+        return false;
+
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+    const uint64_t diagSeq   = globalDiagSeq.fetch_add(1, std::memory_order_relaxed) + kDiagSeqFirstRuntime;
+    const uint64_t beforeMkl = convo::diag::allocatedBytes();
+    const uint32_t beforeLost = convo::diag::lostFreeCount();
+#endif
+    releaseAllLayers();
+
+    // ★ Shared spectra: 入力が一致する donor があれば、FFT・フィルター・テール整形・無音判定済みの
+    //   IR スペクトルを再利用する (FDL/アキュムレータ等の可変状態のみ新規確保)。
+    uint64_t layoutFingerprint = 0;
+    const uint64_t spectraFingerprint = computeSpectraFingerprint(impulse, irLen, blockSize, scale, enableDirectHead, filterSpec,
+                                                                  &layoutFingerprint);
+    const SharedSpectra* reuse = (spectraDonor != nullptr && spectraDonor != this && spectraDonor->m_spectra != nullptr
+                                  && spectraDonor->m_spectra->fingerprint == spectraFingerprint)
+                               ? spectraDonor->m_spectra : nullptr;
+    // ★ Process-wide registry: donor と一致しなければ、プロセス内の別インスタンスが構築済みのスペクトルを探す。
+    //   索引から得た参照は SetImpulse の終わりまで保持し (採用時は m_spectra が別に +1 する)、どの経路でも返す
+    struct RegistryReference
+    {
+        SharedSpectra* spectra = nullptr;
+        ~RegistryReference() { releaseSpectra(spectra); }
+    } registryReference;
+    if (reuse == nullptr)
+    {
+        registryReference.spectra = acquireRegisteredSpectra(spectraFingerprint);
+        reuse = registryReference.spectra;
+    }
+    // ★ Retune: HC/LC/tailStrength のみ異なる donor は、スペクトルを複製しゲイン比で再スケールする (FFT 省略)
+    const SharedSpectra* retune = (reuse == nullptr && spectraDonor != nullptr && spectraDonor != this
+                                   && spectraDonor->m_spectra != nullptr
+                                   && spectraDonor->m_spectra->layoutFingerprint == layoutFingerprint)
+                                ? spectraDonor->m_spectra : nullptr;
+
+    // tailMode: 0=Air Absorption, 1=Layer Tail Contouring, 2=Bypass
+    const int tailMode = (filterSpec != nullptr) ? juce::jlimit(0, 2, filterSpec->tailMode) : 1;
+    const bool tailEnabled = (tailMode != 2) && ((filterSpec != nullptr) ? filterSpec->tailEnabled : true);
+    const double sampleRateForTail = (filterSpec != nullptr) ? filterSpec->sampleRate : 48000.0;
+    double tailStartSec = (filterSpec != nullptr) ? juce::jlimit(0.01, 0.80, filterSpec->tailStartSeconds) : 0.085;
+    const double userTailStrength = (filterSpec != nullptr) ? juce::jlimit(0.0, 2.0, filterSpec->tailStrength) : 1.0;
+    double tailStrength = userTailStrength;
+    const int tailL1L2Mult = resolveTailL1L2Multiplier(filterSpec);
+
+    double layer1Gain = 1.0;
+    double layer2Gain = 1.0;
+
+    const double strength01 = juce::jlimit(0.0, 1.0, userTailStrength * 0.5);
+
+    // Tail profile redesign:
+    // - Air Absorption: tail gain is reduced by layer and HF damping is applied to L1/L2 spectra.
+    // - Layer Tail Contouring: enforce robust lower bounds and shape layer gains for contour clarity.
+    if (!tailEnabled)
+    {
+        tailStrength = 0.0;
+        layer1Gain = 0.0;
+        layer2Gain = 0.0;
+    }
+    else if (tailMode == 0)
+    {
+        // Air Absorption mode: preserve early reflections while progressively damping late layers.
+        tailStartSec = juce::jlimit(0.01, 0.80, std::max(tailStartSec, 0.055));
+        tailStrength = juce::jlimit(0.0, 2.0, userTailStrength);
+
+        layer1Gain = juce::jlimit(0.0, 2.0, tailStrength * (0.95 - 0.25 * strength01));
+        layer2Gain = juce::jlimit(0.0, 2.0, tailStrength * (0.80 - 0.45 * strength01));
+    }
+    else if (tailMode == 1)
+    {
+        tailStartSec = juce::jlimit(0.01, 0.80, std::max(tailStartSec, 0.12));
+        tailStrength = juce::jlimit(0.0, 2.0, std::max(tailStrength, 1.25));
+        layer1Gain = juce::jlimit(0.0, 2.0, tailStrength * (1.05 + 0.20 * strength01));
+        layer2Gain = juce::jlimit(0.0, 2.0, tailStrength * (0.82 + 0.12 * strength01));
+    }
+    else
+    {
+        // Bypass mode (defensive path)
+        tailStrength = 0.0;
+        layer1Gain = 0.0;
+        layer2Gain = 0.0;
+    }
+
+    m_tailEnabled = tailEnabled;
+    m_tailStrength = tailEnabled ? tailStrength : 0.0;
+    m_maxBlockSize = blockSize;
+    m_tailLayerGain[0] = 1.0;
+    m_tailLayerGain[1] = layer1Gain;
+    m_tailLayerGain[2] = layer2Gain;
+
+    // ★ Retune: この構築で IR スペクトルに焼き込む per-bin ゲイン (applySpectrumFilter + Air Absorption)
+    SpectrumGainParams gainParams;
+    if (filterSpec != nullptr)
+    {
+        gainParams.hasFilter  = true;
+        gainParams.sampleRate = filterSpec->sampleRate;
+        gainParams.hcMode     = filterSpec->hcMode;
+        gainParams.lcMode     = filterSpec->lcMode;
+    }
+    if (tailEnabled && tailMode == 0)
+    {
+        const double startNorm = juce::jlimit(0.65, 1.55, tailStartSec / 0.085);
+        gainParams.airTilt        = true;
+        gainParams.airDampingBase = (0.35 + 1.10 * strength01) * startNorm;
+    }
+
+    // ────────────────────────────────────────────────
+    // ★ Zero-latency head: IR 先頭 N タップを時間領域 FIR で畳み込み、L0 のパーティションを N にする。
+    //   L0 は h[N..) を N サンプル遅れで出すため (出力リングに N 個のゼロを先詰め)、
+    //   先頭 N タップと合わせて呼び出しサイズによらず遅延 0 で厳密に一致する。
+    // ────────────────────────────────────────────────
+    const int headTaps = enableDirectHead ? resolveDirectHeadTaps(blockSize) : 0;
+    m_directTapCount = std::min(irLen, headTaps);
+    m_directHistLen  = std::max(0, m_directTapCount - 1);
+    m_directMaxBlock = std::max(blockSize, 1);
+    m_directPendingSamples = 0;
+    m_directEnabled  = (m_directTapCount > 0);
+    m_directFir      = convo::dsp::activeKernels().firVertical;
+
+    if (m_directEnabled)
+    {
+        m_directIRRev   = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directTapCount) * sizeof(double), 64));
+        m_directHistory = (m_directHistLen > 0)
+            ? static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directHistLen) * sizeof(double), 64))
+            : nullptr;
+        m_directWindow  = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directHistLen + m_directMaxBlock) * sizeof(double), 64));
+        m_directOutBuf  = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(m_directMaxBlock) * sizeof(double), 64));
+
+        if (!m_directIRRev || !m_directWindow || !m_directOutBuf || (m_directHistLen > 0 && !m_directHistory))
+        {
+            releaseAllLayers();
+            return false;
+        }
+
+        if (m_directHistLen > 0)
+            memset(m_directHistory, 0, static_cast<size_t>(m_directHistLen) * sizeof(double));
+        memset(m_directOutBuf, 0, static_cast<size_t>(m_directMaxBlock) * sizeof(double));
+
+        if (!buildDirectHeadTaps(impulse, m_directTapCount, headTaps, scale, gainParams, m_directIRRev))
+        {
+            releaseAllLayers();
+            return false;
+        }
+    }
+
+    // Zero-latency head 時は L0 が h[N..) を読むため、IR が N 以下でも L0 の 1 パーティション分を読めるようゼロで延ばす
+    const int fftIrLen = irLen + headTaps;
+    convo::ScopedAlignedPtr<double> impulseForFft(
+        static_cast<double*>(mkl_malloc(static_cast<size_t>(fftIrLen) * sizeof(double), 64)));
+    if (!impulseForFft.get())
+    {
+        releaseAllLayers();
+        return false;
+    }
+
+    memcpy(impulseForFft.get(), impulse, static_cast<size_t>(irLen) * sizeof(double));
+    if (headTaps > 0)
+        memset(impulseForFft.get() + irLen, 0, static_cast<size_t>(headTaps) * sizeof(double));
+
+    // NOTE: vmlSetMode はここでは呼ばない (MainApplication::initialise() 設定済み)。
+
+    // ────────────────────────────────────────────────
+    // レイヤー構成決定 (Non-Uniform Partitioned Convolution)
+    // ────────────────────────────────────────────────
+    // Zero-latency head 時も L0 の長さと L1/L2 の構成は通常時の L0 パーティション基準のまま (L0 を N で細かく割るだけ)
+    const int l0BasePart = juce::nextPowerOfTwo(std::max(blockSize, 64));
+    const int l0Part = (headTaps > 0) ? headTaps : l0BasePart;
+    const int l1Part = l0BasePart * tailL1L2Mult;
+    const int l2Part = l1Part * tailL1L2Mult;
+
+    const int l0MaxLen = kL0MaxParts * l0BasePart;
+    const int l0LenByTailStart = static_cast<int>(std::llround(tailStartSec * sampleRateForTail));
+    const int l0LenTarget = juce::jlimit(l0BasePart, l0MaxLen, l0LenByTailStart);
+
+    auto computeLayerLengths = [&](int len, int (&out)[kNumLayers])
+    {
+        out[0] = std::min(len, tailEnabled ? l0LenTarget : l0MaxLen);
+        out[1] = tailEnabled ? std::max(0, std::min(len - out[0], kL1MaxParts * l1Part)) : 0;
+        out[2] = tailEnabled ? std::max(0, len - out[0] - out[1]) : 0;
+    };
+
+    // ────────────────────────────────────────────────
+    // ★ Partition culling (末尾): L0 パーティション単位でエネルギーを測り、
+    //   ピーク比 floor 以下が末尾まで続く区間をレイヤー構成から除外する。
+    //   L1/L2 のパーティション数・FDL 長がその分だけ縮む (IR 先頭の遅延構造は不変)。
+    // ────────────────────────────────────────────────
+    const double cullFloorDb = (filterSpec != nullptr) ? filterSpec->partitionCullFloorDb
+                                                       : FilterSpec::kPartitionCullDisabledDb;
+    int irLenEff = irLen;
+    if (cullFloorDb > FilterSpec::kPartitionCullDisabledDb)
+    {
+        irLenEff = (filterSpec->partitionCullLength > 0)
+            ? std::min(irLen, filterSpec->partitionCullLength)
+            : computeCulledIRLength(impulse, irLen, blockSize, cullFloorDb);
+    }
+
+    int fullLens[kNumLayers] = {};
+    int effLens[kNumLayers] = {};
+    computeLayerLengths(irLen, fullLens);
+    computeLayerLengths(irLenEff, effLens);
+
+    m_totalPartsIR = 0;
+    m_culledTrailingParts = 0;
+    m_culledBytes = 0;
+    {
+        const int partSizes[kNumLayers] = { l0Part, l1Part, l2Part };
+        for (int li = 0; li < kNumLayers; ++li)
+        {
+            const int fullParts = (fullLens[li] + partSizes[li] - 1) / partSizes[li];
+            const int effParts  = (effLens[li]  + partSizes[li] - 1) / partSizes[li];
+            m_totalPartsIR        += fullParts;
+            m_culledTrailingParts += fullParts - effParts;
+
+            // IR スペクトル (Re/Im) + ミラー FDL (Re/Im × 2) の double 換算
+            const uint64_t slotBytes = static_cast<uint64_t>(partSizes[li] + 1) * sizeof(double) * 6;
+            const int fullSlots = (fullParts > 0) ? juce::nextPowerOfTwo(fullParts) : 0;
+            const int effSlots  = (effParts  > 0) ? juce::nextPowerOfTwo(effParts)  : 0;
+            m_culledBytes += static_cast<uint64_t>(fullSlots - effSlots) * slotBytes;
+        }
+    }
+
+    const int l0Len = effLens[0];
+
+    const int l1Offset = l0Len;
+    const int l1Len    = effLens[1];
+
+    const int l2Offset = l0Len + l1Len;
+    const int l2Len    = effLens[2];
+
+    // ────────────────────────────────────────────────
+    // ★ Multirate tail: L2 を 1/D のレートで畳み込む。
+    //   入力間引き・IR 間引き・出力補間のカスケード遅延 (各 Lat) の合計 3·Lat を B13 遅延から差し引くため、
+    //   差し引いても 1 パーティション + 1 ブロック以上の余裕が残る場合のみ有効にする。
+    //   間引き IR はフルレート時刻 D·k − Lat の帯域制限値なので、末尾まで出すよう Lat 分のゼロを追加で流す。
+    // ────────────────────────────────────────────────
+    int l2Decimation = 1;
+    int l2RateLen = l2Len;
+    convo::ScopedAlignedPtr<double> l2DecimatedIr;
+    if (const int decim = (l2Len > 0) ? resolveTailDecimation(filterSpec) : 1; decim > 1 && (l2Part % decim) == 0)
+    {
+        constexpr int kIrDecimateChunk = 16384;
+        convo::dsp::HalfBandCascade irDecimator;
+        const int lat = irDecimator.prepare(convo::dsp::HalfBandCascade::Mode::Decimate, decim, sampleRateForTail,
+                                            kTailDecimationPassbandHz, kTailDecimationAttenuationDb, kIrDecimateChunk)
+                      ? irDecimator.getLatencySamples() : -1;
+        const int rateLen = (l2Len + std::max(lat, 0) + decim - 1) / decim;
+        convo::ScopedAlignedPtr<double> chunkOut;
+        if (lat >= 0 && l2Offset - 3 * lat >= l2Part + blockSize)
+        {
+            l2DecimatedIr.reset(static_cast<double*>(mkl_malloc(static_cast<size_t>(rateLen) * sizeof(double), 64)));
+            chunkOut.reset(static_cast<double*>(mkl_malloc(static_cast<size_t>(kIrDecimateChunk / 2 + 2) * sizeof(double), 64)));
+        }
+        if (l2DecimatedIr.get() != nullptr && chunkOut.get() != nullptr)
+        {
+            const double* segment = impulseForFft.get() + l2Offset;
+            const int fullRateInput = rateLen * decim;
+            int produced = 0;
+            for (int pos = 0; pos < fullRateInput && produced < rateLen; pos += kIrDecimateChunk)
+            {
+                const int n = std::min(kIrDecimateChunk, fullRateInput - pos);
+                const int irPart = std::clamp(l2Len - pos, 0, n);
+                // IR 区間 + ゼロ埋め。出力が rateLen を超える分は捨てる
+                int got = 0;
+                if (irPart > 0)
+                    got += irDecimator.decimate(segment + pos, irPart, chunkOut.get());
+                if (n - irPart > 0)
+                    got += irDecimator.decimate(nullptr, n - irPart, chunkOut.get() + got);
+                const int take = std::min(got, rateLen - produced);
+                std::memcpy(l2DecimatedIr.get() + produced, chunkOut.get(), static_cast<size_t>(take) * sizeof(double));
+                produced += take;
+            }
+            jassert(produced == rateLen);
+            // 間引き後の畳み込みは 1/D のタップ数で和を取るため D 倍して利得を保つ
+            cblas_dscal(rateLen, static_cast<double>(decim), l2DecimatedIr.get(), 1);
+            l2Decimation = decim;
+            l2RateLen = rateLen;
+        }
+    }
+
+    // len / partSize はフルレート、rateLen はレイヤーのレート (1/decimation) での IR 長。
+    // offset は FFT 側が読む IR の先頭 (L0 は Zero-latency head の N タップを飛ばす)
+    struct LayerCfg { int offset; int len; int partSize; bool immediate; int decimation; int rateLen; };
+    const LayerCfg cfgs[kNumLayers] = {
+        { headTaps, l0Len, l0Part, true,  1,            std::max(1, l0Len - headTaps) },
+        { l1Offset, l1Len, l1Part, false, 1,            l1Len     },
+        { l2Offset, l2Len, l2Part, false, l2Decimation, l2RateLen },
+    };
+
+    m_numActiveLayers = 0;
+
+    // ★ Shared spectra / Retune: 念のためレイヤー構成の一致を確認し、不一致なら通常構築する
+    auto layoutMatches = [&cfgs](const SharedSpectra& s) noexcept
+    {
+        int n = 0;
+        for (int li = 0; li < kNumLayers; ++li)
+        {
+            if (cfgs[li].len <= 0)
+                continue;
+            if (n >= s.numLayers)
+                return false;
+            const int ratePart = cfgs[li].partSize / cfgs[li].decimation;
+            const int partsIR = (cfgs[li].rateLen + ratePart - 1) / ratePart;
+            const auto& d = s.layers[n];
+            if (d.numPartsIR != partsIR || d.numParts != juce::nextPowerOfTwo(partsIR)
+                || d.complexSize != ratePart + 1)
+                return false;
+            ++n;
+        }
+        return n == s.numLayers;
+    };
+    if (reuse != nullptr && !layoutMatches(*reuse))
+        reuse = nullptr;
+    if (reuse != nullptr && filterSpec != nullptr && filterSpec->replicateSpectraPerNode)
+        reuse = spectraForCurrentNode(reuse);
+    if (retune != nullptr && !layoutMatches(*retune))
+        retune = nullptr;
+
+    // ★ Retune: レイヤー毎のゲイン比を先に求める。比で戻せないビン (旧ゲイン 0 → 新ゲイン非 0、
+    //   例: LC Natural→Soft の 6–8 Hz、HC Natural→他 の Nyquist) は直接 DFT で再計算するが、
+    //   本数が多い場合は FFT の方が速いため通常構築に戻す。
+    constexpr int kMaxRetuneRecomputeBins = 64;
+    convo::ScopedAlignedPtr<double> retuneRatio[kNumLayers];
+    if (retune != nullptr)
+    {
+        int n = 0;
+        for (int li = 0; li < kNumLayers && retune != nullptr; ++li)
+        {
+            if (cfgs[li].len <= 0)
+                continue;
+            const auto& d = retune->layers[n];
+            const int cSize = d.complexSize;
+            const bool hasDonorData = d.compact ? (d.reF && d.imF) : (d.re && d.im);
+            retuneRatio[n].reset(static_cast<double*>(mkl_malloc(static_cast<size_t>(cSize) * sizeof(double), 64)));
+            convo::ScopedAlignedPtr<double> scratch(static_cast<double*>(mkl_malloc(static_cast<size_t>(cSize) * sizeof(double), 64)));
+            if (!hasDonorData || !retuneRatio[n].get() || !scratch.get()
+                || buildRetuneRatio(retune->gains, gainParams, n, cfgs[li].partSize * 2, cSize,
+                                    retuneRatio[n].get(), scratch.get()) > kMaxRetuneRecomputeBins)
+                retune = nullptr;
+            ++n;
+        }
+    }
+
+    // ────────────────────────────────────────────────
+    // 各レイヤーの遅延補償用エントリを保持
+    int prevLayerTotalSamples = 0;  // ★ B13: 先行レイヤーの IR 総長
+
+    // ────────────────────────────────────────────────
+    // 各レイヤーを初期化
+    // ────────────────────────────────────────────────
+    for (int li = 0; li < kNumLayers; ++li)
+    {
+        if (cfgs[li].len <= 0)
+            continue;
+
+        Layer& l = m_layers[m_numActiveLayers];
+        l.descriptorCommitted = false;
+        convo::publishAtomic(l.warmupCompleted, false, std::memory_order_release);
+
+        l.decimation  = cfgs[li].decimation;
+        l.partSize    = cfgs[li].partSize / l.decimation;
+        l.fftSize     = l.partSize * 2;
+        l.isImmediate = cfgs[li].immediate;
+
+        l.complexSize = l.fftSize / 2 + 1;
+        l.partStride  = (l.complexSize * 2 + 7) & ~7;
+
+        l.numPartsIR = (cfgs[li].rateLen + l.partSize - 1) / l.partSize;
+        l.numParts   = juce::nextPowerOfTwo(l.numPartsIR);
+        l.fdlMask    = l.numParts - 1;
+
+        // ── IPP FFT スペック初期化 (Message Thread で事前確保) ──
+        //
+        // [v2.1] MKL DFTI_DESCRIPTOR_HANDLE の代替。
+        // fftSize = 2 * partSize は常に 2 の冪なので FFT (DFT より高速) を使用可能。
+        // IPP_FFT_DIV_INV_BY_N: IFFT 時に 1/N 正規化を自動適用
+        //   (旧: DftiSetValue(DFTI_BACKWARD_SCALE, 1.0/fftSize) と等価)
+        // ippAlgHintFast: 速度優先 (精度を一切犠牲にしない範囲でのヒント)
+        {
+            // fftSize = 2^order を求める (fftSize は必ず 2 の冪)
+            int order = 0;
+            {
+                int tmp = l.fftSize;
+                while (tmp > 1) { tmp >>= 1; ++order; }
+            }
+
+            // 実装 (IPP / MKL DFTI) は FftBackendWisdom の実測結果に従う
+            l.fftPlan = RealFftPlanCache::getOrCreate(order, FftScaling::InverseByN);
+            if (l.fftPlan == nullptr)
+            {
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+                juce::Logger::writeToLog("MKLNonUniformConvolver: FFT plan cache creation failed for layer "
+                                         + juce::String(li) + " (order=" + juce::String(order) + ")");
+#endif
+                releaseAllLayers();
+                return false;
+            }
+
+            // ワークバッファ確保 (Audio Thread での動的確保を防ぐため事前確保)
+            // getWorkBytes() == 0 の場合 nullptr のまま (DFTI / 外部バッファ不要の IPP)
+            // getWorkBytes() > 0 かつ確保失敗 → リアルタイム安全でないため初期化失敗とする
+            if (const size_t workBytes = l.fftPlan->getWorkBytes(); workBytes > 0)
+            {
+                l.fftWorkBuf = ippsMalloc_8u(static_cast<int>(workBytes));
+                if (!l.fftWorkBuf)
+                {
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+                    juce::Logger::writeToLog("MKLNonUniformConvolver: ippsMalloc_8u(workBytes=" + juce::String(static_cast<int>(workBytes))
+                                             + ") failed for layer " + juce::String(li));
+#endif
+                    releaseAllLayers();
+                    return false;
+                }
+            }
+
+            l.descriptorCommitted = true;
+        }
+
+        // ── バッファ確保 (すべて mkl_malloc 64byte アライン) ──
+        // [Mem-Fix] irFreqDomain/fdlBuf は永続履歴ではなく使い捨てスクラッチ。
+        // irFreqDomain: 1パーティション分、fdlBuf: current+mirrorの2スロット分のみ。
+        const size_t irBufSize  = static_cast<size_t>(l.partStride);
+        const size_t fdlBufSize = static_cast<size_t>(l.partStride) * 2;
+        const size_t irSoaSize  = static_cast<size_t>(l.numParts) * static_cast<size_t>(l.complexSize);
+        const size_t fdlSoaSize = static_cast<size_t>(l.numParts) * 2 * static_cast<size_t>(l.complexSize);
+        const SharedSpectra::LayerData* shared = (reuse != nullptr) ? &reuse->layers[m_numActiveLayers] : nullptr;
+        const SharedSpectra::LayerData* retuneSrc = (retune != nullptr) ? &retune->layers[m_numActiveLayers] : nullptr;
+
+        l.irFreqDomain = static_cast<double*>(DIAG_MKL_MALLOC(irBufSize  * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.irFreqDomain = irBufSize * sizeof(double);
+#endif
+        if (shared != nullptr)
+        {
+            // ★ Shared spectra: 不変データは参照のみ (float32 レイヤーの FDL 切替は末尾で行う)
+            l.irFreqReal     = shared->re;
+            l.irFreqImag     = shared->im;
+            l.irFreqRealF    = shared->reF;
+            l.irFreqImagF    = shared->imF;
+            l.partSilent     = shared->partSilent;
+            l.numSilentParts = shared->numSilentParts;
+            l.binMajor       = shared->binMajor;  // ★ Bin-major FDL: 配置は donor に従う (FDL はまだゼロ)
+            l.irSpectraShared = true;
+        }
+        else
+        {
+        l.irFreqReal   = static_cast<double*>(DIAG_MKL_MALLOC(irSoaSize  * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.irFreqReal = irSoaSize * sizeof(double);
+#endif
+        l.irFreqImag   = static_cast<double*>(DIAG_MKL_MALLOC(irSoaSize  * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.irFreqImag = irSoaSize * sizeof(double);
+#endif
+        }
+        const bool hasIrSpectra = (shared != nullptr)
+            ? (shared->compact ? (shared->reF && shared->imF) : (shared->re && shared->im))
+            : (l.irFreqReal && l.irFreqImag);
+        l.fdlBuf       = static_cast<double*>(DIAG_MKL_MALLOC(fdlBufSize * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.fdlBuf = fdlBufSize * sizeof(double);
+#endif
+        l.fdlReal      = static_cast<double*>(DIAG_MKL_MALLOC(fdlSoaSize * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.fdlReal = fdlSoaSize * sizeof(double);
+#endif
+        l.fdlImag      = static_cast<double*>(DIAG_MKL_MALLOC(fdlSoaSize * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.fdlImag = fdlSoaSize * sizeof(double);
+#endif
+        l.fftTimeBuf   = static_cast<double*>(DIAG_MKL_MALLOC(l.fftSize   * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.fftTimeBuf = l.fftSize * sizeof(double);
+#endif
+        l.fftOutBuf    = static_cast<double*>(DIAG_MKL_MALLOC(l.fftSize   * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.fftOutBuf = l.fftSize * sizeof(double);
+#endif
+        l.prevInputBuf = static_cast<double*>(DIAG_MKL_MALLOC(l.partSize  * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.prevInputBuf = l.partSize * sizeof(double);
+#endif
+        l.accumBuf     = static_cast<double*>(DIAG_MKL_MALLOC(l.partStride * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.accumBuf = l.partStride * sizeof(double);
+#endif
+        l.accumReal    = static_cast<double*>(DIAG_MKL_MALLOC(l.complexSize * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.accumReal = l.complexSize * sizeof(double);
+#endif
+        l.accumImag    = static_cast<double*>(DIAG_MKL_MALLOC(l.complexSize * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.accumImag = l.complexSize * sizeof(double);
+#endif
+        l.inputAccBuf  = static_cast<double*>(DIAG_MKL_MALLOC(l.partSize  * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+l.allocSizes.inputAccBuf = l.partSize * sizeof(double);
+#endif
+
+        if (!l.isImmediate)
+        {
+            l.tailOutputBuf = static_cast<double*>(DIAG_MKL_MALLOC(l.partSize * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+            l.allocSizes.tailOutputBuf = l.partSize * sizeof(double);   // ★ Bug#7: isImmediate ガード内に移動
+#endif
+        }
+
+        // ★ Multirate tail: 入力間引き / 出力補間のカスケードと受け渡しバッファ
+        if (l.decimation > 1)
+        {
+            const int rateInputSize  = m_maxBlockSize / l.decimation + 2;
+            const int rateOutputSize = l.partSize * l.decimation;
+            l.rateInputBuf  = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(rateInputSize)  * sizeof(double), 64));
+            l.rateOutputBuf = static_cast<double*>(DIAG_MKL_MALLOC(static_cast<size_t>(rateOutputSize) * sizeof(double), 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+            l.allocSizes.rateInputBuf  = static_cast<size_t>(rateInputSize)  * sizeof(double);
+            l.allocSizes.rateOutputBuf = static_cast<size_t>(rateOutputSize) * sizeof(double);
+#endif
+            if (!l.rateInputBuf || !l.rateOutputBuf
+                || !l.rateDown.prepare(convo::dsp::HalfBandCascade::Mode::Decimate, l.decimation, sampleRateForTail,
+                                       kTailDecimationPassbandHz, kTailDecimationAttenuationDb, m_maxBlockSize)
+                || !l.rateUp.prepare(convo::dsp::HalfBandCascade::Mode::Interpolate, l.decimation, sampleRateForTail,
+                                     kTailDecimationPassbandHz, kTailDecimationAttenuationDb, l.partSize))
+            {
+                releaseAllLayers();
+                return false;
+            }
+        }
+
+        if (!l.irFreqDomain || !hasIrSpectra || !l.fdlBuf || !l.fdlReal || !l.fdlImag || !l.fftTimeBuf ||
+            !l.fftOutBuf || !l.prevInputBuf || !l.accumBuf || !l.accumReal || !l.accumImag || !l.inputAccBuf ||
+            (!l.isImmediate && !l.tailOutputBuf))
+        {
+            releaseAllLayers();
+            return false;
+        }
+
+        // ゼロ初期化
+        juce::FloatVectorOperations::clear(l.irFreqDomain, irBufSize);
+        if (shared == nullptr)
+        {
+            juce::FloatVectorOperations::clear(l.irFreqReal, irSoaSize);
+            juce::FloatVectorOperations::clear(l.irFreqImag, irSoaSize);
+        }
+        juce::FloatVectorOperations::clear(l.fdlBuf,       fdlBufSize);
+        juce::FloatVectorOperations::clear(l.fdlReal,      fdlSoaSize);
+        juce::FloatVectorOperations::clear(l.fdlImag,      fdlSoaSize);
+        juce::FloatVectorOperations::clear(l.fftTimeBuf,   l.fftSize);
+        juce::FloatVectorOperations::clear(l.fftOutBuf,    l.fftSize);
+        juce::FloatVectorOperations::clear(l.prevInputBuf, l.partSize);
+        juce::FloatVectorOperations::clear(l.accumBuf,     l.partStride);
+        juce::FloatVectorOperations::clear(l.accumReal,    l.complexSize);
+        juce::FloatVectorOperations::clear(l.accumImag,    l.complexSize);
+        juce::FloatVectorOperations::clear(l.inputAccBuf,  l.partSize);
+        if (l.tailOutputBuf)
+            juce::FloatVectorOperations::clear(l.tailOutputBuf, l.partSize);
+
+        // ── IR プリコンピュート ──
+        // tempFreq は CCS 出力用に (fftSize + 2) 分確保
+        // (IPP CCS 形式: (N/2+1)*2 = N+2 doubles)
+        double* tempTime = static_cast<double*>(mkl_malloc(l.fftSize          * sizeof(double), 64));
+        double* tempFreq = static_cast<double*>(mkl_malloc((l.fftSize + 2)    * sizeof(double), 64));
+        if (!tempTime || !tempFreq)
+        {
+            if (tempTime) mkl_free(tempTime);
+            if (tempFreq) mkl_free(tempFreq);
+            releaseAllLayers();
+            return false;
+        }
+
+        const double* irSrc    = (l.decimation > 1) ? l2DecimatedIr.get() : impulseForFft.get() + cfgs[li].offset;
+        const int     irRemain = cfgs[li].rateLen;
+
+        if (retuneSrc != nullptr)
+        {
+            retuneLayerSpectra(l, retuneSrc->compact ? nullptr : retuneSrc->re, retuneSrc->compact ? nullptr : retuneSrc->im,
+                               retuneSrc->reF, retuneSrc->imF, retuneSrc->binMajor,
+                               retuneRatio[m_numActiveLayers].get(), irSrc, irRemain, scale);
+        }
+
+        for (int p = 0; shared == nullptr && retuneSrc == nullptr && p < l.numParts; ++p)
+        {
+            memset(tempTime, 0, l.fftSize * sizeof(double));
+
+            if (p < l.numPartsIR)
+            {
+                const int copyStart = p * l.partSize;
+                const int copyLen   = std::min(l.partSize, irRemain - copyStart);
+                if (copyLen > 0)
+                    memcpy(tempTime, irSrc + copyStart, copyLen * sizeof(double));
+            }
+
+            // [v2.1] Forward FFT: real → CCS [re0,im0,re1,im1,...] (IPP / DFTI とも同一レイアウト)
+            l.fftPlan->forward(tempTime, tempFreq, l.fftWorkBuf);
+
+            // [Mem-Fix] irFreqDomain は 1 パーティション分のスクラッチのため、オフセット0(先頭)へ書き込む。
+            memcpy(l.irFreqDomain, tempFreq, l.complexSize * 2 * sizeof(double));
+
+            if (scale != 1.0)
+                cblas_dscal(l.complexSize * 2, scale, l.irFreqDomain, 1);
+
+            deinterleaveComplex(l.irFreqDomain,
+                        l.irFreqReal + static_cast<size_t>(p) * l.complexSize,
+                        l.irFreqImag + static_cast<size_t>(p) * l.complexSize,
+                        l.complexSize);
+        }
+
+        // Backward FFT のウォームアップ
+        // Audio Thread での初回実行時の遅延 (IPP テーブル生成等) を事前消化する。
+        // [v2.1] IFFT: CCS → real (FftScaling::InverseByN により 1/N 正規化済み)
+        l.fftPlan->inverse(tempFreq, tempTime, l.fftWorkBuf);
+        convo::publishAtomic(l.warmupCompleted, true, std::memory_order_release);
+
+        mkl_free(tempTime);
+        mkl_free(tempFreq);
+
+        // [Mem-Fix] IR パーティションを逆順に並び替える (forward アクセス最適化)
+        // irFreqDomain はスクラッチ化されたため、swap対象は SoA (irFreqReal/irFreqImag) のみでよい。
+        if (shared == nullptr && l.numPartsIR > 1)
+        {
+            double* swapSoA = static_cast<double*>(mkl_malloc(
+                static_cast<size_t>(l.complexSize) * sizeof(double), 64));
+            if (swapSoA)
+            {
+                for (int pf = 0; pf < l.numPartsIR / 2; ++pf)
+                {
+                    const int pb = l.numPartsIR - 1 - pf;
+
+                    // irFreqReal swap (SoA)
+                    double* realF = l.irFreqReal + static_cast<size_t>(pf) * l.complexSize;
+                    double* realB = l.irFreqReal + static_cast<size_t>(pb) * l.complexSize;
+                    memcpy(swapSoA, realF, l.complexSize * sizeof(double));
+                    memcpy(realF,   realB, l.complexSize * sizeof(double));
+                    memcpy(realB,   swapSoA, l.complexSize * sizeof(double));
+
+                    // irFreqImag swap (SoA)
+                    double* imagF = l.irFreqImag + static_cast<size_t>(pf) * l.complexSize;
+                    double* imagB = l.irFreqImag + static_cast<size_t>(pb) * l.complexSize;
+                    memcpy(swapSoA, imagF, l.complexSize * sizeof(double));
+                    memcpy(imagF,   imagB, l.complexSize * sizeof(double));
+                    memcpy(imagB,   swapSoA, l.complexSize * sizeof(double));
+                }
+            }
+            if (swapSoA) mkl_free(swapSoA);
+        }
+
+        // ── 非 Immediate レイヤーのコールバックあたりパーティション数 ──
+        if (!l.isImmediate)
+        {
+            // パーティション 1 つ分の入力が揃うまでのコールバック数 (Multirate tail もフルレートで数える)
+            const int blocksPerPart = (l.partSize * l.decimation + std::max(blockSize, 1) - 1) / std::max(blockSize, 1);
+            l.partsPerCallback = std::max(1,
+                (l.numPartsIR + blocksPerPart - 1) / blocksPerPart);
+            l.partsPerCallback = std::min(l.partsPerCallback, l.numPartsIR);
+        }
+
+        l.fdlIndex       = 0;
+        l.inputPos       = 0;
+        l.nextPart       = 0;
+        l.tailOutputPos  = 0;
+        l.baseFdlIdxSaved = 0;
+        l.distributing   = false;
+        l.silentFdlRun   = 0;
+        l.prevInputSilent = false;
+        l.outputDelaySamples = 0;
+
+        // ★ B13: 遅延補償リングバッファ設定 (L1/L2)
+        if (prevLayerTotalSamples > 0) {
+            // Multirate tail はカスケード遅延 3·Lat (入力間引き + IR 間引き + 出力補間) を差し引く
+            l.outputDelaySamples = prevLayerTotalSamples - 3 * l.rateDown.getLatencySamples();
+            l.delayLineCapacity = ((prevLayerTotalSamples + l.partSize * l.decimation + m_maxBlockSize + 15) / 16) * 16;
+            const size_t delayLineBytes = static_cast<size_t>(l.delayLineCapacity) * sizeof(double);
+            l.delayLineBuf = static_cast<double*>(DIAG_MKL_MALLOC(delayLineBytes, 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+            l.allocSizes.delayLineBuf = delayLineBytes;
+#endif
+            if (l.delayLineBuf == nullptr) {
+                releaseAllLayers();
+                return false;
+            }
+            juce::FloatVectorOperations::clear(l.delayLineBuf, l.delayLineCapacity);
+            jassert(l.outputDelaySamples > 0);
+        }
+
+        ++m_numActiveLayers;
+
+        // ★ B13: 先行レイヤーの IR 総長を累積 (次レイヤーの outputDelaySamples 用)
+        prevLayerTotalSamples += cfgs[li].len;
+    }
+
+    if (m_numActiveLayers == 0)
+        return false;
+
+    // ────────────────────────────────────────────────
+    // 出力リングバッファ確保 (L0 専用)
+    // ────────────────────────────────────────────────
+    const int l0PartSize  = m_layers[0].partSize;
+    const int numPartsIR  = (irLen + blockSize - 1) / blockSize;
+    const int numParts    = juce::nextPowerOfTwo(numPartsIR);
+    const int baseSize    = numParts * 2;
+    const int margin      = juce::nextPowerOfTwo(blockSize);
+    const int rSize       = juce::nextPowerOfTwo(baseSize + margin);
+    const int minSize     = juce::nextPowerOfTwo(l0PartSize * 4 + blockSize * 4);
+    const int finalSize   = std::max(rSize, minSize);
+    m_ringBuf = static_cast<double*>(DIAG_MKL_MALLOC(finalSize * sizeof(double), 64));
+    if (!m_ringBuf)
+    {
+        releaseAllLayers();
+        return false;
+    }
+
+    memset(m_ringBuf, 0, finalSize * sizeof(double));
+    m_ringSize  = finalSize;
+    m_ringMask  = finalSize - 1;
+    // ★ Zero-latency head: L0 (h[N..)) を N サンプル遅らせる分のゼロを先詰めする
+    m_ringWrite = m_directEnabled ? l0PartSize : 0;
+    m_ringRead  = 0;
+    m_ringAvail = m_ringWrite;
+
+    m_latency = m_directEnabled ? 0 : l0PartSize;
+
+    if (filterSpec != nullptr && reuse == nullptr && retune == nullptr)
+        applySpectrumFilter(*filterSpec);
+
+    // ────────────────────────────────────────────────
+    // ★ Tail Worker: L1/L2 をワーカースレッドへオフロード
+    //   ジョブ slot 確保またはスレッド起動に失敗した場合は従来の分散処理で動作する。
+    //   m_latency は L0 のみで決まるためオフロード有無で変化しない。
+    // ────────────────────────────────────────────────
+    if (filterSpec != nullptr && filterSpec->tailWorkerOffload && m_numActiveLayers > 1)
+    {
+        bool jobBufsOk = true;
+        for (int li = 1; li < m_numActiveLayers; ++li)
+        {
+            Layer& l = m_layers[li];
+            const size_t jobBytes = static_cast<size_t>(kTailJobSlots) * static_cast<size_t>(l.partSize) * sizeof(double);
+            l.jobInputBuf  = static_cast<double*>(DIAG_MKL_MALLOC(jobBytes, 64));
+            l.jobOutputBuf = static_cast<double*>(DIAG_MKL_MALLOC(jobBytes, 64));
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+            l.allocSizes.jobInputBuf  = l.jobInputBuf  ? jobBytes : 0;
+            l.allocSizes.jobOutputBuf = l.jobOutputBuf ? jobBytes : 0;
+#endif
+            if (!l.jobInputBuf || !l.jobOutputBuf)
+            {
+                jobBufsOk = false;   // 確保済み slot は freeAll で解放される
+                break;
+            }
+            juce::FloatVectorOperations::clear(l.jobInputBuf,  kTailJobSlots * l.partSize);
+            juce::FloatVectorOperations::clear(l.jobOutputBuf, kTailJobSlots * l.partSize);
+        }
+
+        if (jobBufsOk)
+        {
+            m_tailWorkerAffinity = filterSpec->tailWorkerAffinity;
+            m_tailOffload = startTailWorker();
+        }
+    }
+
+    if (gainParams.airTilt && reuse == nullptr && retune == nullptr)
+        applyAirAbsorptionTilt(gainParams.airDampingBase);
+
+    // ★ Partition culling (中間): フィルター/テール処理適用後のスペクトルで無音パーティションを判定する
+    if (cullFloorDb > FilterSpec::kPartitionCullDisabledDb && reuse == nullptr)
+        markSilentPartitions(cullFloorDb);
+
+    // ────────────────────────────────────────────────
+    // ★ Compact tail: フィルター/テール処理適用済みの L1/L2 スペクトルを float32 へ変換する
+    //   1 レイヤーでも確保に失敗した場合、そのレイヤーは double のまま動作する (混在可)。
+    //   m_compactTail は全 L1/L2 が float32 化された場合のみ true (ステレオペア整合判定用)。
+    // ────────────────────────────────────────────────
+    if (reuse != nullptr)
+    {
+        for (int li = 1; li < m_numActiveLayers; ++li)
+        {
+            const auto& d = reuse->layers[li];
+            if (d.compact && !adoptCompactSpectra(m_layers[li], d.reF, d.imF))
+            {
+                // 共有 float32 スペクトルに対応する FDL が無いと処理できないため構築失敗とする
+                juce::Logger::writeToLog("MKLNonUniformConvolver: OOM in adoptCompactSpectra");
+                releaseAllLayers();
+                return false;
+            }
+        }
+        m_compactTail = reuse->compactTail;
+        m_spectra = retainSpectra(const_cast<SharedSpectra*>(reuse));
+        m_spectraReused = true;
+        bindFarTailPager();
+    }
+    else
+    {
+        if (filterSpec != nullptr && filterSpec->compactTailSpectra && m_numActiveLayers > 1)
+        {
+            bool allCompact = true;
+            for (int li = 1; li < m_numActiveLayers; ++li)
+                allCompact &= compactLayerSpectra(m_layers[li]);
+            m_compactTail = allCompact;
+        }
+
+        // ★ Bin-major FDL: double のまま残ったレイヤーを配置選択に従ってタイル化する。
+        //   ページ化対象 (最終 L1/L2) はパーティション単位で常駐管理するため対象外。確保失敗時は従来配置。
+        const auto layout = (filterSpec != nullptr) ? filterSpec->spectrumLayout : FilterSpec::SpectrumLayout::Auto;
+        const bool pagingRequested = filterSpec != nullptr && filterSpec->farTailHorizonSeconds > 0.0 && l2Len > 0;
+        for (int li = 0; li < m_numActiveLayers && layout != FilterSpec::SpectrumLayout::PartitionMajor; ++li)
+        {
+            Layer& l = m_layers[li];
+            if (l.compactSpectra || l.numPartsIR < 2 || (pagingRequested && li == m_numActiveLayers - 1))
+                continue;
+            if (layout == FilterSpec::SpectrumLayout::BinMajor
+                || convo::BinTileLayout::preferBinMajor(l.numPartsIR, l.complexSize))
+                tileLayerSpectra(l);
+        }
+
+        // ★ Shared spectra: 確定した IR スペクトルを参照カウント共有体へ移す (失敗時は自前所有のまま)
+        publishLayerSpectra(spectraFingerprint, layoutFingerprint, gainParams);
+        m_spectraRetuned = (retune != nullptr);
+
+        // ★ Far-tail paging: 地平線より後ろの L2 パーティションをマップへ移す (失敗時はヒープのまま)
+        if (filterSpec != nullptr && filterSpec->farTailHorizonSeconds > 0.0 && l2Len > 0
+            && pageFarTail(*filterSpec, l2Offset))
+            bindFarTailPager();
+
+        // ★ RT residency: ページ化しなかったスペクトルをラージページへ移す / その場でロックする
+        makeSpectraResident();
+    }
+
+    m_memoryCharge.set(computeOwnedBytes());
+    convo::publishAtomic(m_ready, true, std::memory_order_release);
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+    const uint64_t afterMkl = convo::diag::allocatedBytes();
+    const uint32_t afterLost = convo::diag::lostFreeCount();
+
+    const int l0p = m_numActiveLayers >= 1 ? m_layers[0].partSize : 0;
+    const int l1p = m_numActiveLayers >= 2 ? m_layers[1].partSize : 0;
+    const int l2p = m_numActiveLayers >= 3 ? m_layers[2].partSize : 0;
+
+    // IR_LOAD
+    diagLogNonRt(juce::String::formatted(
+        "[IR_LOAD] NUC#%p seq=%llu irLen=%d blockSize=%d "
+        "Layers=%d L0Part=%d L1Part=%d L2Part=%d "
+        "directTaps=%d ringSize=%d "
+        "MKL: before=%lluMB after=%lluMB delta=%lldMB "
+        "lostFree=%u(+%d) live=%u",
+        (void*)this,
+        (unsigned long long)diagSeq,
+        irLen, blockSize,
+        m_numActiveLayers, l0p, l1p, l2p,
+        m_directTapCount, m_ringSize,
+        (unsigned long long)(beforeMkl / (1024*1024)),
+        (unsigned long long)(afterMkl / (1024*1024)),
+        (long long)((int64_t)(afterMkl) - (int64_t)(beforeMkl)) / (1024*1024),
+        (unsigned)afterLost, (int)((int32_t)(afterLost) - (int32_t)(beforeLost)),
+        (unsigned)liveCount.load(std::memory_order_relaxed)));
+
+    // IR_LAYOUT (1 回の getDiagnostics で Layer 情報 + 種別内訳を取得)
+    const auto __snap = getDiagnostics();
+    diagLogNonRt(juce::String::formatted(
+        "[IR_LAYOUT] NUC#%p seq=%llu "
+        "IRFreq=%.0fMB FDL=%.0fMB Accum=%.0fMB Tail=%.0fMB "
+        "Direct=%.0fMB Ring=%.0fMB Total=%.0fMB(persistent data buffers only) | "
+        "L0=%.0fMB L1=%.0fMB L2=%.0fMB | CompactLayers=%d Saved=%.0fMB | "
+        "Parts=%d CulledTrailing=%d SkippedSilent=%d CulledSaved=%.1fMB",
+        (void*)this,
+        (unsigned long long)diagSeq,
+        __snap.irFreqBytes / (1024.0*1024.0),
+        __snap.fdlBytes    / (1024.0*1024.0),
+        __snap.accumBytes  / (1024.0*1024.0),
+        __snap.tailBytes   / (1024.0*1024.0),
+        __snap.directBytes / (1024.0*1024.0),
+        __snap.ringBytes   / (1024.0*1024.0),
+        __snap.totalBytes() / (1024.0*1024.0),
+        __snap.layerBufs[0] / (1024.0*1024.0),
+        __snap.layerBufs[1] / (1024.0*1024.0),
+        __snap.layerBufs[2] / (1024.0*1024.0),
+        __snap.compactLayers,
+        __snap.compactSavedBytes / (1024.0*1024.0),
+        __snap.totalPartsIR,
+        __snap.culledTrailingParts,
+        __snap.culledSilentParts,
+        __snap.culledBytes / (1024.0*1024.0)));
+#endif
+
+
+    return true;
+}
+
+bool MKLNonUniformConvolver::areFftDescriptorsCommitted() const noexcept
+{
+    if (!convo::consumeAtomic(m_ready, std::memory_order_acquire) || m_numActiveLayers <= 0)
+        return false;
+
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        const Layer& l = m_layers[li];
+        if (l.fftPlan == nullptr || !l.descriptorCommitted)
+            return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// processDirectBlock  ─ Audio Thread
+//==============================================================================
+void MKLNonUniformConvolver::processDirectBlock(const double* input, int numSamples) noexcept
+{
+    if (!m_directEnabled || numSamples <= 0 || m_directOutBuf == nullptr || m_directWindow == nullptr || m_directIRRev == nullptr)
+        return;
+
+    if (numSamples > m_directMaxBlock)
+    {
+        jassertfalse;
+        m_directPendingSamples = 0;
+        return;
+    }
+
+    constexpr double kDenormalThreshold = convo::numeric_policy::kDenormThresholdAudioState;
+
+    int processed = 0;
+    while (processed < numSamples)
+    {
+        const int chunk = std::min(numSamples - processed, m_directMaxBlock);
+
+        if (m_directHistLen > 0)
+            juce::FloatVectorOperations::copy(m_directWindow, m_directHistory, m_directHistLen);
+
+        if (input)
+            juce::FloatVectorOperations::copy(m_directWindow + m_directHistLen, input + processed, chunk);
+        else
+            memset(m_directWindow + m_directHistLen, 0, static_cast<size_t>(chunk) * sizeof(double));
+
+        // window = [過去 N-1 | chunk] 上の縦方向 FIR (AVX2 / AVX-512 は SetImpulse 時に解決済み)
+        double* out = m_directOutBuf + processed;
+        m_directFir(m_directWindow, m_directIRRev, m_directTapCount, out, chunk);
+        for (int n = 0; n < chunk; ++n)
+        {
+            if (!isFiniteAndAboveThresholdMask(out[n], kDenormalThreshold))
+                out[n] = 0.0;
+        }
+
+        if (m_directHistLen > 0)
+            juce::FloatVectorOperations::copy(m_directHistory, m_directWindow + chunk, m_directHistLen);
+
+        processed += chunk;
+    }
+
+    m_directPendingSamples = numSamples;
+}
+
+//==============================================================================
+// processLayerBlock  ─ Audio Thread (L0 専用)
+//
+// 処理:
+//   1. Overlap-Save 形式で fftTimeBuf を組み立てる [prevInput | currentInput]
+//   2. Forward FFT → FDL の現在スロットへ格納
+//   3. FDL × IR の複素乗算積算 (AVX2 FMA)
+//   4. Backward FFT
+//   5. 有効出力 (後半 partSize サンプル) をリングバッファへ書き込み (ringWrite)
+//   6. FDL インデックスを進める
+//==============================================================================
+void MKLNonUniformConvolver::processLayerBlock(Layer& l) noexcept
+{
+#ifdef NUC_DEBUG_GUARDS
+    checkGuards();
+#endif
+#if JUCE_DEBUG
+    if (!convo::consumeAtomic(l.warmupCompleted, std::memory_order_acquire))
+    convo::fetchAddAtomic(debugWarmupGuardCount(), 1, std::memory_order_acq_rel);
+#endif
+
+    // ── 1. Forward FFT → FDL push (L1/L2 と共通。全ゼロ入力窓は FFT を省く) ──
+    pushFdlBlock(l, l.inputAccBuf);
+
+    // ── 2. 複素乗算積算 (FDL × IR) → accumReal/Imag ──
+    memset(l.accumReal, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+    memset(l.accumImag, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+    beginSpectralFadeBlock(l);
+    beginSpectralMorphBlock(l);
+    accumulateParts(l, 0, l.numPartsIR);
+
+    // ── 3. Backward FFT → Overlap-Save: 有効出力をリングへ書き込み ──
+    finishImmediateBlock(l);
+}
+
+//==============================================================================
+// ringWrite  ─ Audio Thread (L0 専用)
+//==============================================================================
+void MKLNonUniformConvolver::ringWrite(const double* src, int n) noexcept
+{
+#ifdef NUC_DEBUG_GUARDS
+    checkGuards();
+#endif
+    if (n <= 0 || m_ringBuf == nullptr || src == nullptr) return;
+
+    const int first = std::min(n, m_ringSize - m_ringWrite);
+    juce::FloatVectorOperations::copy(m_ringBuf + m_ringWrite, src, first);
+    if (n > first)
+        juce::FloatVectorOperations::copy(m_ringBuf, src + first, n - first);
+
+    m_ringWrite = (m_ringWrite + n) & m_ringMask;
+
+    const int nextAvail = m_ringAvail + n;
+    if (nextAvail > m_ringSize)
+    {
+        const int overflow = nextAvail - m_ringSize;
+        m_ringRead = (m_ringRead + overflow) & m_ringMask;
+        m_ringAvail = m_ringSize;
+        // [BUG-02] m_ringWrite は直前の更新で既に正しい位置にある。overflow 時の追加更新は不要。
+        // m_ringWrite = (m_ringWrite + overflow) & m_ringMask;
+        convo::fetchAddAtomic(m_ringOverflowCount, 1, std::memory_order_acq_rel);
+        if (overflowCallback)
+            overflowCallback(overflowUserData);
+    }
+    else
+    {
+        m_ringAvail = nextAvail;
+    }
+}
+
+//==============================================================================
+// ringRead  ─ Audio Thread (L0 専用)
+//==============================================================================
+int MKLNonUniformConvolver::ringRead(double* dst, int n) noexcept
+{
+    if (n <= 0 || m_ringBuf == nullptr) return 0;
+
+    const int toRead = std::min(n, m_ringAvail);
+    if (toRead == 0)
+    {
+        if (dst) memset(dst, 0, n * sizeof(double));
+        return 0;
+    }
+
+    const int first = std::min(toRead, m_ringSize - m_ringRead);
+
+    if (dst)
+    {
+        juce::FloatVectorOperations::copy(dst, m_ringBuf + m_ringRead, first);
+        if (toRead > first)
+            juce::FloatVectorOperations::copy(dst + first, m_ringBuf, toRead - first);
+
+        if (toRead < n)
+            memset(dst + toRead, 0, (n - toRead) * sizeof(double));
+    }
+
+    m_ringRead  = (m_ringRead + toRead) & m_ringMask;
+    m_ringAvail -= toRead;
+    return toRead;
+}
+
+//==============================================================================
+// Add  ─ Audio Thread
+//==============================================================================
+void MKLNonUniformConvolver::Add(const double* input, int numSamples)
+{
+    #ifdef NUC_DEBUG_GUARDS
+        checkGuards();
+        // 内部バッファの簡単な健全性チェック
+        if (m_ringBuf && reinterpret_cast<uintptr_t>(m_ringBuf) % 64 != 0) __debugbreak();
+    #endif
+    if (!convo::consumeAtomic(m_ready, std::memory_order_acquire) || numSamples <= 0)
+        return;
+
+    processDirectBlock(input, numSamples);
+
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+
+#if JUCE_DEBUG
+        if (!convo::consumeAtomic(l.warmupCompleted, std::memory_order_acquire))
+            convo::fetchAddAtomic(debugWarmupGuardCount(), 1, std::memory_order_acq_rel);
 #endif
 
-        if (!l.isImmediate)
+        // ★ Multirate tail: FDL には間引いた入力を積む (ratio に満たない端数はカスケード内で持ち越す)
+        const double* layerInput = input;
+        int layerSamples = numSamples;
+        if (l.decimation > 1)
         {
-            l.tailOutputBuf = static_cast<double*>(DIAG_MKL_MALLOC(l.partSize * sizeof(double), 64));
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-            l.allocSizes.tailOutputBuf = l.partSize * sizeof(double);   // ★ Bug#7: isImmediate ガード内に移動
-#endif
+            layerSamples = l.rateDown.decimate(input, numSamples, l.rateInputBuf);
+            layerInput = l.rateInputBuf;
         }
 
-        if (!l.irFreqDomain || !l.irFreqReal || !l.irFreqImag || !l.fdlBuf || !l.fdlReal || !l.fdlImag || !l.fftTimeBuf ||
-            !l.fftOutBuf || !l.prevInputBuf || !l.accumBuf || !l.accumReal || !l.accumImag || !l.inputAccBuf ||
-            (!l.isImmediate && !l.tailOutputBuf))
+        int consumed = 0;
+        while (consumed < layerSamples)
         {
-            releaseAllLayers();
-            return false;
-        }
+            const int toFill = std::min(layerSamples - consumed, l.partSize - l.inputPos);
+            if (layerInput)
+                memcpy(l.inputAccBuf + l.inputPos, layerInput + consumed, toFill * sizeof(double));
+            else
+                memset(l.inputAccBuf + l.inputPos, 0, toFill * sizeof(double));
+            l.inputPos += toFill;
+            consumed   += toFill;
 
-        // ゼロ初期化
-        juce::FloatVectorOperations::clear(l.irFreqDomain, irBufSize);
-        juce::FloatVectorOperations::clear(l.irFreqReal,   irSoaSize);
-        juce::FloatVectorOperations::clear(l.irFreqImag,   irSoaSize);
-        juce::FloatVectorOperations::clear(l.fdlBuf,       fdlBufSize);
-        juce::FloatVectorOperations::clear(l.fdlReal,      fdlSoaSize);
-        juce::FloatVectorOperations::clear(l.fdlImag,      fdlSoaSize);
-        juce::FloatVectorOperations::clear(l.fftTimeBuf,   l.fftSize);
-        juce::FloatVectorOperations::clear(l.fftOutBuf,    l.fftSize);
-        juce::FloatVectorOperations::clear(l.prevInputBuf, l.partSize);
-        juce::FloatVectorOperations::clear(l.accumBuf,     l.partStride);
-        juce::FloatVectorOperations::clear(l.accumReal,    l.complexSize);
-        juce::FloatVectorOperations::clear(l.accumImag,    l.complexSize);
-        juce::FloatVectorOperations::clear(l.inputAccBuf,  l.partSize);
-        if (l.tailOutputBuf)
-            juce::FloatVectorOperations::clear(l.tailOutputBuf, l.partSize);
+            if (l.inputPos >= l.partSize)
+            {
+                l.inputPos = 0;
 
-        // ── IR プリコンピュート ──
-        // tempFreq は CCS 出力用に (fftSize + 2) 分確保
-        // (IPP CCS 形式: (N/2+1)*2 = N+2 doubles)
-        double* tempTime = static_cast<double*>(mkl_malloc(l.fftSize          * sizeof(double), 64));
-        double* tempFreq = static_cast<double*>(mkl_malloc((l.fftSize + 2)    * sizeof(double), 64));
-        if (!tempTime || !tempFreq)
+                if (l.isImmediate)
+                {
+                    processLayerBlock(l);
+                }
+                else
+                {
+                    jassert(consumed <= layerSamples);
+                    // ★ [P0-3] Release 安全ガード: 超過時は clamp
+                    if (consumed > layerSamples) [[unlikely]]
+                    {
+                        consumed = layerSamples;
+                    }
+
+                    beginTailBlock(l);
+                }
+            }
+        } // while consumed < layerSamples
+
+        // ★ Tail Worker: 完了済みジョブを順序どおり B13 遅延ラインへ回収 (デッドライン前)
+        if (!l.isImmediate && m_tailOffload)
         {
-            if (tempTime) mkl_free(tempTime);
-            if (tempFreq) mkl_free(tempFreq);
-            releaseAllLayers();
-            return false;
+            collectTailJobs(l, false);
+            continue;
         }
 
-        const double* irSrc    = impulseForFft.get() + cfgs[li].offset;
-        const int     irRemain = cfgs[li].len;
-
-        for (int p = 0; p < l.numParts; ++p)
+        // ────────────────────────────────────────────────────────────────────
+        // [Bug3 fix] 分散計算ループ: 毎コールバック実行
+        // ────────────────────────────────────────────────────────────────────
+        if (!l.isImmediate && l.distributing)
         {
-            memset(tempTime, 0, l.fftSize * sizeof(double));
+            const int endPart  = std::min(l.nextPart + l.partsPerCallback, l.numPartsIR);
+            accumulateParts(l, l.nextPart, endPart);
+            l.nextPart = endPart;
 
-            if (p < l.numPartsIR)
-            {
-                const int copyStart = p * l.partSize;
-                const int copyLen   = std::min(l.partSize, irRemain - copyStart);
-                if (copyLen > 0)
-                    memcpy(tempTime, irSrc + copyStart, copyLen * sizeof(double));
-            }
+            // ── 全パーティション累積完了 → IFFT → tailOutputBuf へコピー ──
+            if (l.nextPart >= l.numPartsIR)
+                completeTailBlock(l);
+        }
 
-            // [v2.1] Forward FFT: real → CCS
-            // IPP CCS 出力: [re0,im0,re1,im1,...] ← MKL DFTI_COMPLEX_COMPLEX と同一レイアウト
-            ippsFFTFwd_RToCCS_64f(tempTime, tempFreq, l.fftSpec, l.fftWorkBuf);
+    } // for each layer
+}
 
-            // [Mem-Fix] irFreqDomain は 1 パーティション分のスクラッチのため、オフセット0(先頭)へ書き込む。
-            memcpy(l.irFreqDomain, tempFreq, l.complexSize * 2 * sizeof(double));
+//==============================================================================
+// AddStereo  ─ Audio Thread
+//   L/R 2 インスタンスを同一パーティション境界で一括処理する。
+//   FDL MAC を 1 ループに融合し、IR スペクトルを共有している場合
+//   (shareImpulseSpectraFrom) は各 IR パーティションの load 1 回で両チャンネルを積算する。
+//   構成が一致しない場合は従来どおりチャンネル別 Add にフォールバックする。
+//==============================================================================
+void MKLNonUniformConvolver::AddStereo(MKLNonUniformConvolver& left, MKLNonUniformConvolver& right,
+                                       const double* inputL, const double* inputR, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
 
-            if (scale != 1.0)
-                cblas_dscal(l.complexSize * 2, scale, l.irFreqDomain, 1);
+    if (!left.isStereoPairCompatible(right))
+    {
+        left.Add(inputL, numSamples);
+        right.Add(inputR, numSamples);
+        return;
+    }
 
-            deinterleaveComplex(l.irFreqDomain,
-                        l.irFreqReal + static_cast<size_t>(p) * l.complexSize,
-                        l.irFreqImag + static_cast<size_t>(p) * l.complexSize,
-                        l.complexSize);
-        }
+    #ifdef NUC_DEBUG_GUARDS
+        left.checkGuards();
+        right.checkGuards();
+    #endif
 
-        // Backward FFT のウォームアップ
-        // Audio Thread での初回実行時の遅延 (IPP テーブル生成等) を事前消化する。
-        // [v2.1] IFFT: CCS → real (IPP_FFT_DIV_INV_BY_N により 1/N 正規化済み)
-        ippsFFTInv_CCSToR_64f(tempFreq, tempTime, l.fftSpec, l.fftWorkBuf);
-        convo::publishAtomic(l.warmupCompleted, true, std::memory_order_release);
+    left.processDirectBlock(inputL, numSamples);
+    right.processDirectBlock(inputR, numSamples);
 
-        mkl_free(tempTime);
-        mkl_free(tempFreq);
+    for (int li = 0; li < left.m_numActiveLayers; ++li)
+    {
+        Layer& a = left.m_layers[li];
+        Layer& b = right.m_layers[li];
+
+        // ★ Multirate tail: L/R のカスケードは同じ長さを流すので持ち越し量も常に一致する
+        const double* layerInputL = inputL;
+        const double* layerInputR = inputR;
+        int layerSamples = numSamples;
+        if (a.decimation > 1)
+        {
+            layerSamples = a.rateDown.decimate(inputL, numSamples, a.rateInputBuf);
+            [[maybe_unused]] const int samplesR = b.rateDown.decimate(inputR, numSamples, b.rateInputBuf);
+            jassert(samplesR == layerSamples);
+            layerInputL = a.rateInputBuf;
+            layerInputR = b.rateInputBuf;
+        }
 
-        // [Mem-Fix] IR パーティションを逆順に並び替える (forward アクセス最適化)
-        // irFreqDomain はスクラッチ化されたため、swap対象は SoA (irFreqReal/irFreqImag) のみでよい。
-        if (l.numPartsIR > 1)
+        int consumed = 0;
+        while (consumed < layerSamples)
         {
-            double* swapSoA = static_cast<double*>(mkl_malloc(
-                static_cast<size_t>(l.complexSize) * sizeof(double), 64));
-            if (swapSoA)
-            {
-                for (int pf = 0; pf < l.numPartsIR / 2; ++pf)
-                {
-                    const int pb = l.numPartsIR - 1 - pf;
+            // isStereoPairCompatible により a.inputPos == b.inputPos, a.partSize == b.partSize
+            const int toFill = std::min(layerSamples - consumed, a.partSize - a.inputPos);
+            if (layerInputL)
+                memcpy(a.inputAccBuf + a.inputPos, layerInputL + consumed, toFill * sizeof(double));
+            else
+                memset(a.inputAccBuf + a.inputPos, 0, toFill * sizeof(double));
+            if (layerInputR)
+                memcpy(b.inputAccBuf + b.inputPos, layerInputR + consumed, toFill * sizeof(double));
+            else
+                memset(b.inputAccBuf + b.inputPos, 0, toFill * sizeof(double));
+            a.inputPos += toFill;
+            b.inputPos += toFill;
+            consumed   += toFill;
 
-                    // irFreqReal swap (SoA)
-                    double* realF = l.irFreqReal + static_cast<size_t>(pf) * l.complexSize;
-                    double* realB = l.irFreqReal + static_cast<size_t>(pb) * l.complexSize;
-                    memcpy(swapSoA, realF, l.complexSize * sizeof(double));
-                    memcpy(realF,   realB, l.complexSize * sizeof(double));
-                    memcpy(realB,   swapSoA, l.complexSize * sizeof(double));
+            if (a.inputPos >= a.partSize)
+            {
+                a.inputPos = 0;
+                b.inputPos = 0;
 
-                    // irFreqImag swap (SoA)
-                    double* imagF = l.irFreqImag + static_cast<size_t>(pf) * l.complexSize;
-                    double* imagB = l.irFreqImag + static_cast<size_t>(pb) * l.complexSize;
-                    memcpy(swapSoA, imagF, l.complexSize * sizeof(double));
-                    memcpy(imagF,   imagB, l.complexSize * sizeof(double));
-                    memcpy(imagB,   swapSoA, l.complexSize * sizeof(double));
+                if (a.isImmediate)
+                {
+                    // ── L0: FFT はチャンネル別、MAC は融合ループ ──
+                    pushFdlBlock(a, a.inputAccBuf);
+                    pushFdlBlock(b, b.inputAccBuf);
+                    memset(a.accumReal, 0, static_cast<size_t>(a.complexSize) * sizeof(double));
+                    memset(a.accumImag, 0, static_cast<size_t>(a.complexSize) * sizeof(double));
+                    memset(b.accumReal, 0, static_cast<size_t>(b.complexSize) * sizeof(double));
+                    memset(b.accumImag, 0, static_cast<size_t>(b.complexSize) * sizeof(double));
+                    left.beginSpectralFadeBlock(a);
+                    right.beginSpectralFadeBlock(b);
+                    left.beginSpectralMorphBlock(a);
+                    right.beginSpectralMorphBlock(b);
+                    if (left.m_trueStereo)
+                        accumulatePartsTrueStereo(a, b, 0, a.numPartsIR);
+                    else
+                        accumulatePartsStereo(a, b, 0, a.numPartsIR);
+                    left.finishImmediateBlock(a);
+                    right.finishImmediateBlock(b);
+                }
+                else
+                {
+                    left.beginTailBlock(a);
+                    right.beginTailBlock(b);
                 }
             }
-            if (swapSoA) mkl_free(swapSoA);
-        }
+        } // while consumed < layerSamples
 
-        // ── 非 Immediate レイヤーのコールバックあたりパーティション数 ──
-        if (!l.isImmediate)
+        if (a.isImmediate)
+            continue;
+
+        if (left.m_tailOffload)
         {
-            const int blocksPerPart = (l.partSize + std::max(blockSize, 1) - 1) / std::max(blockSize, 1);
-            l.partsPerCallback = std::max(1,
-                (l.numPartsIR + blocksPerPart - 1) / blocksPerPart);
-            l.partsPerCallback = std::min(l.partsPerCallback, l.numPartsIR);
+            left.collectTailJobs(a, false);
+            right.collectTailJobs(b, false);
+            continue;
         }
 
-        l.fdlIndex       = 0;
-        l.inputPos       = 0;
-        l.nextPart       = 0;
-        l.tailOutputPos  = 0;
-        l.baseFdlIdxSaved = 0;
-        l.distributing   = false;
-        l.outputDelaySamples = 0;
+        if (a.distributing && b.distributing)
+        {
+            const int endPart = std::min(a.nextPart + a.partsPerCallback, a.numPartsIR);
+            if (left.m_trueStereo)
+                accumulatePartsTrueStereo(a, b, a.nextPart, endPart);
+            else
+                accumulatePartsStereo(a, b, a.nextPart, endPart);
+            a.nextPart = endPart;
+            b.nextPart = endPart;
 
-        // ★ B13: 遅延補償リングバッファ設定 (L1/L2)
-        if (prevLayerTotalSamples > 0) {
-            l.outputDelaySamples = prevLayerTotalSamples;
-            l.delayLineCapacity = ((prevLayerTotalSamples + l.partSize + m_maxBlockSize + 15) / 16) * 16;
-            const size_t delayLineBytes = static_cast<size_t>(l.delayLineCapacity) * sizeof(double);
-            l.delayLineBuf = static_cast<double*>(DIAG_MKL_MALLOC(delayLineBytes, 64));
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-            l.allocSizes.delayLineBuf = delayLineBytes;
-#endif
-            if (l.delayLineBuf == nullptr) {
-                releaseAllLayers();
-                return false;
+            if (a.nextPart >= a.numPartsIR)
+            {
+                left.completeTailBlock(a);
+                right.completeTailBlock(b);
             }
-            juce::FloatVectorOperations::clear(l.delayLineBuf, l.delayLineCapacity);
-            jassert(l.outputDelaySamples > 0);
         }
+    } // for each layer
+}
 
-        ++m_numActiveLayers;
+//==============================================================================
+// CMAC カーネル選択 / ベンチマーク用エントリ
+//==============================================================================
+bool MKLNonUniformConvolver::isCmacKernelSupported(CmacKernel kernel) noexcept
+{
+    return kernel == CmacKernel::Avx2 || hasAVX512Support();
+}
 
-        // ★ B13: 先行レイヤーの IR 総長を累積 (次レイヤーの outputDelaySamples 用)
-        prevLayerTotalSamples += cfgs[li].len;
-    }
+MKLNonUniformConvolver::CmacKernel MKLNonUniformConvolver::getCmacKernel() noexcept
+{
+    return static_cast<CmacKernel>(convo::consumeAtomic(gCmacKernel, std::memory_order_relaxed)); // relaxed: 選択フラグのみ
+}
 
-    if (m_numActiveLayers == 0)
+bool MKLNonUniformConvolver::setCmacKernel(CmacKernel kernel) noexcept
+{
+    if (!isCmacKernelSupported(kernel))
         return false;
+    convo::publishAtomic(gCmacKernel, static_cast<uint8_t>(kernel), std::memory_order_relaxed); // relaxed: 選択フラグのみ (データ公開なし)
+    return true;
+}
 
-    // ────────────────────────────────────────────────
-    // 出力リングバッファ確保 (L0 専用)
-    // ────────────────────────────────────────────────
-    const int l0PartSize  = m_layers[0].partSize;
-    const int numPartsIR  = (irLen + blockSize - 1) / blockSize;
-    const int numParts    = juce::nextPowerOfTwo(numPartsIR);
-    const int baseSize    = numParts * 2;
-    const int margin      = juce::nextPowerOfTwo(blockSize);
-    const int rSize       = juce::nextPowerOfTwo(baseSize + margin);
-    const int minSize     = juce::nextPowerOfTwo(l0PartSize * 4 + blockSize * 4);
-    const int finalSize   = std::max(rSize, minSize);
-    m_ringBuf = static_cast<double*>(DIAG_MKL_MALLOC(finalSize * sizeof(double), 64));
-    if (!m_ringBuf)
-    {
-        releaseAllLayers();
-        return false;
-    }
+void MKLNonUniformConvolver::runCmacKernel(CmacKernel kernel,
+                                           const double* aReal, const double* aImag,
+                                           const double* bReal, const double* bImag,
+                                           double* dstReal, double* dstImag,
+                                           int complexSize) noexcept
+{
+    if (kernel == CmacKernel::Avx512 && hasAVX512Support())
+        accumulateSplitComplexAvx512(aReal, aImag, bReal, bImag, dstReal, dstImag, complexSize);
+    else
+        accumulateSplitComplexAvx2(aReal, aImag, bReal, bImag, dstReal, dstImag, complexSize);
+}
 
-    memset(m_ringBuf, 0, finalSize * sizeof(double));
-    m_ringSize  = finalSize;
-    m_ringMask  = finalSize - 1;
-    m_ringWrite = 0;
-    m_ringRead  = 0;
-    m_ringAvail = 0;
+void MKLNonUniformConvolver::prewarmFftPlans(int minOrder, int maxOrder)
+{
+    for (int order = minOrder; order <= maxOrder; ++order)
+        juce::ignoreUnused(RealFftPlanCache::getOrCreate(order, FftScaling::InverseByN));
+}
 
-    m_latency = m_layers[0].partSize;
+//==============================================================================
+// isStereoPairCompatible  ─ Audio Thread
+//   AddStereo の融合パスが使えるか (レイヤー構成と進行状態が L/R で一致しているか)。
+//==============================================================================
+bool MKLNonUniformConvolver::isStereoPairCompatible(const MKLNonUniformConvolver& other) const noexcept
+{
+    if (!convo::consumeAtomic(m_ready, std::memory_order_acquire)
+        || !convo::consumeAtomic(other.m_ready, std::memory_order_acquire))
+        return false;
 
-    if (filterSpec != nullptr)
-        applySpectrumFilter(*filterSpec);
+    if (m_numActiveLayers != other.m_numActiveLayers || m_numActiveLayers <= 0
+        || m_tailOffload != other.m_tailOffload || m_trueStereo != other.m_trueStereo
+        || m_compactTail != other.m_compactTail)
+        return false;
 
-    if (tailEnabled && tailMode == 0)
+    for (int li = 0; li < m_numActiveLayers; ++li)
     {
-        const double startNorm = juce::jlimit(0.65, 1.55, tailStartSec / 0.085);
-        const double dampingBase = (0.35 + 1.10 * strength01) * startNorm;
-
-        for (int li = 1; li < m_numActiveLayers; ++li)
-        {
-            Layer& l = m_layers[li];
-            if (!l.irFreqReal || !l.irFreqImag || l.complexSize <= 0)
-                continue;
-
-            const double layerWeight = (li == 1) ? 1.0 : 1.6;
-            const double dampingCoeff = dampingBase * layerWeight;
-
-            // [Mem-Fix] gain は実数値(振幅のみ)のためinterleaved配列は不要。
-            convo::ScopedAlignedPtr<double> gainReal(
-                static_cast<double*>(mkl_malloc(static_cast<size_t>(l.complexSize) * sizeof(double), 64)));
-            if (!gainReal.get())
-                continue;
+        const Layer& a = m_layers[li];
+        const Layer& b = other.m_layers[li];
+        if (a.partSize != b.partSize || a.numPartsIR != b.numPartsIR || a.complexSize != b.complexSize
+            || a.isImmediate != b.isImmediate || a.compactSpectra != b.compactSpectra || a.binMajor != b.binMajor
+            || a.decimation != b.decimation || a.inputPos != b.inputPos
+            || a.distributing != b.distributing || a.nextPart != b.nextPart
+            || a.partsPerCallback != b.partsPerCallback)
+            return false;
+    }
+    return true;
+}
 
-            const double denom = static_cast<double>(std::max(1, l.complexSize - 1));
-            for (int k = 0; k < l.complexSize; ++k)
-            {
-                const double fNorm = static_cast<double>(k) / denom;
-                const double hfTilt = std::exp(-dampingCoeff * fNorm * fNorm);
-                gainReal.get()[k] = hfTilt;
-            }
+//==============================================================================
+// shareImpulseSpectraFrom  ─ Message Thread (SetImpulse 直後、公開前)
+//   L/R が同一 IR の場合、自身の IR スペクトル (irFreqReal/irFreqImag) を手放して
+//   source の SharedSpectra を参照する。参照カウントで保持するため source の寿命に依存しない。
+//==============================================================================
+bool MKLNonUniformConvolver::shareImpulseSpectraFrom(const MKLNonUniformConvolver& source) noexcept
+{
+    SharedSpectra* const src = source.m_spectra;
+    if (src == nullptr || m_numActiveLayers != source.m_numActiveLayers || m_numActiveLayers <= 0)
+        return false;
+    if (src == m_spectra)
+        return true;
 
-            // [Mem-Fix] SoA (irFreqReal/irFreqImag) に直接ゲインを適用する。
-            for (int p = 0; p < l.numParts; ++p)
-            {
-                double* re = l.irFreqReal + static_cast<size_t>(p) * l.complexSize;
-                double* im = l.irFreqImag + static_cast<size_t>(p) * l.complexSize;
-                vdMul(l.complexSize, re, gainReal.get(), re);
-                vdMul(l.complexSize, im, gainReal.get(), im);
-            }
-        }
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        const Layer& a = m_layers[li];
+        const Layer& b = source.m_layers[li];
+        if (a.partSize != b.partSize || a.numParts != b.numParts || a.numPartsIR != b.numPartsIR
+            || a.complexSize != b.complexSize || a.compactSpectra != b.compactSpectra || a.decimation != b.decimation)
+            return false;
+        const auto& d = src->layers[li];
+        const bool hasSpectra = d.compact ? (d.reF && d.imF) : (d.re && d.im);
+        if (!hasSpectra || d.binMajor != a.binMajor)  // FDL の配置は自レイヤーの設定のまま
+            return false;
     }
 
-    convo::publishAtomic(m_ready, true, std::memory_order_release);
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        if (!l.irSpectraShared)  // publishLayerSpectra が確保失敗した場合のみ自前所有
+        {
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-    const uint64_t afterMkl = convo::diag::allocatedBytes();
-    const uint32_t afterLost = convo::diag::lostFreeCount();
-
-    const int l0p = m_numActiveLayers >= 1 ? m_layers[0].partSize : 0;
-    const int l1p = m_numActiveLayers >= 2 ? m_layers[1].partSize : 0;
-    const int l2p = m_numActiveLayers >= 3 ? m_layers[2].partSize : 0;
-
-    // IR_LOAD
-    diagLogNonRt(juce::String::formatted(
-        "[IR_LOAD] NUC#%p seq=%llu irLen=%d blockSize=%d "
-        "Layers=%d L0Part=%d L1Part=%d L2Part=%d "
-        "directTaps=%d ringSize=%d "
-        "MKL: before=%lluMB after=%lluMB delta=%lldMB "
-        "lostFree=%u(+%d) live=%u",
-        (void*)this,
-        (unsigned long long)diagSeq,
-        irLen, blockSize,
-        m_numActiveLayers, l0p, l1p, l2p,
-        m_directTapCount, m_ringSize,
-        (unsigned long long)(beforeMkl / (1024*1024)),
-        (unsigned long long)(afterMkl / (1024*1024)),
-        (long long)((int64_t)(afterMkl) - (int64_t)(beforeMkl)) / (1024*1024),
-        (unsigned)afterLost, (int)((int32_t)(afterLost) - (int32_t)(beforeLost)),
-        (unsigned)liveCount.load(std::memory_order_relaxed)));
-
-    // IR_LAYOUT (1 回の getDiagnostics で Layer 情報 + 種別内訳を取得)
-    const auto __snap = getDiagnostics();
-    diagLogNonRt(juce::String::formatted(
-        "[IR_LAYOUT] NUC#%p seq=%llu "
-        "IRFreq=%.0fMB FDL=%.0fMB Accum=%.0fMB Tail=%.0fMB "
-        "Direct=%.0fMB Ring=%.0fMB Total=%.0fMB(persistent data buffers only) | "
-        "L0=%.0fMB L1=%.0fMB L2=%.0fMB",
-        (void*)this,
-        (unsigned long long)diagSeq,
-        __snap.irFreqBytes / (1024.0*1024.0),
-        __snap.fdlBytes    / (1024.0*1024.0),
-        __snap.accumBytes  / (1024.0*1024.0),
-        __snap.tailBytes   / (1024.0*1024.0),
-        __snap.directBytes / (1024.0*1024.0),
-        __snap.ringBytes   / (1024.0*1024.0),
-        __snap.totalBytes() / (1024.0*1024.0),
-        __snap.layerBufs[0] / (1024.0*1024.0),
-        __snap.layerBufs[1] / (1024.0*1024.0),
-        __snap.layerBufs[2] / (1024.0*1024.0)));
+            freeTracked(l.irFreqReal,  l.allocSizes.irFreqReal);
+            freeTracked(l.irFreqImag,  l.allocSizes.irFreqImag);
+            freeTracked(l.irFreqRealF, l.allocSizes.irFreqRealF);
+            freeTracked(l.irFreqImagF, l.allocSizes.irFreqImagF);
+            freeTracked(l.partSilent,  l.allocSizes.partSilent);
+            l.allocSizes.irFreqReal  = l.allocSizes.irFreqImag  = 0;
+            l.allocSizes.irFreqRealF = l.allocSizes.irFreqImagF = 0;
+            l.allocSizes.partSilent  = 0;
+#else
+            if (l.irFreqReal)  { mkl_free(l.irFreqReal);  l.irFreqReal  = nullptr; }
+            if (l.irFreqImag)  { mkl_free(l.irFreqImag);  l.irFreqImag  = nullptr; }
+            if (l.irFreqRealF) { mkl_free(l.irFreqRealF); l.irFreqRealF = nullptr; }
+            if (l.irFreqImagF) { mkl_free(l.irFreqImagF); l.irFreqImagF = nullptr; }
+            if (l.partSilent)  { mkl_free(l.partSilent);  l.partSilent  = nullptr; }
 #endif
+        }
+        const auto& d = src->layers[li];
+        l.irFreqReal     = d.re;
+        l.irFreqImag     = d.im;
+        l.irFreqRealF    = d.reF;
+        l.irFreqImagF    = d.imF;
+        l.partSilent     = d.partSilent;
+        l.numSilentParts = d.numSilentParts;
+        l.irSpectraShared = true;
+    }
 
-
+    // 旧スペクトル (自身が最後の参照なら実体) を解放してから source 側を保持する
+    unbindFarTailPager();
+    releaseSpectra(m_spectra);
+    m_spectra = retainSpectra(src);
+    bindFarTailPager();
+    m_memoryCharge.set(computeOwnedBytes());
     return true;
 }
 
-bool MKLNonUniformConvolver::areFftDescriptorsCommitted() const noexcept
+//==============================================================================
+// adoptCrossSpectraFrom  ─ Message Thread (SetImpulse 直後、公開前)
+//   donor の SharedSpectra をクロスパスとして retain する (donor は直後に破棄してよい)。
+//==============================================================================
+bool MKLNonUniformConvolver::adoptCrossSpectraFrom(MKLNonUniformConvolver& donor) noexcept
 {
-    if (!convo::consumeAtomic(m_ready, std::memory_order_acquire) || m_numActiveLayers <= 0)
+    // Direct Head は時間領域ヘッドを単一 IR 前提で持ち、Tail Worker は自 FDL しか参照できないため非対応。
+    // Compact tail (float32) のクロスパスカーネルは未実装のため同様に非対応。
+    if (m_directEnabled || donor.m_directEnabled || m_tailOffload || m_compactTail)
+        return false;
+    SharedSpectra* const src = donor.m_spectra;
+    if (src == nullptr || m_numActiveLayers != donor.m_numActiveLayers || m_numActiveLayers <= 0)
+        return false;
+    // Far-tail paging: 4 項融合カーネルは常駐判定を持たない
+    if (src->pager != nullptr || (m_spectra != nullptr && m_spectra->pager != nullptr))
         return false;
 
     for (int li = 0; li < m_numActiveLayers; ++li)
     {
-        const Layer& l = m_layers[li];
-        // [v2.1] fftHandle → fftSpec
-        if (l.fftSpec == nullptr || !l.descriptorCommitted)
+        const Layer& a = m_layers[li];
+        const auto& d = src->layers[li];
+        if (a.numParts != d.numParts || a.numPartsIR != d.numPartsIR || a.complexSize != d.complexSize
+            || a.decimation != donor.m_layers[li].decimation
+            || d.compact || d.binMajor || a.binMajor || !d.re || !d.im)  // 4 項融合カーネルはパーティション優先のみ
             return false;
     }
 
+    for (int li = 0; li < m_numActiveLayers; ++li)
+    {
+        Layer& l = m_layers[li];
+        l.crossIrFreqReal = src->layers[li].re;
+        l.crossIrFreqImag = src->layers[li].im;
+    }
+    releaseSpectra(m_crossSpectra);
+    m_crossSpectra = retainSpectra(src);
+    m_trueStereo = true;
     return true;
 }
 
 //==============================================================================
-// processDirectBlock  ─ Audio Thread
+// beginTailBlock  ─ Audio Thread (L1/L2 パーティション境界)
 //==============================================================================
-void MKLNonUniformConvolver::processDirectBlock(const double* input, int numSamples) noexcept
+void MKLNonUniformConvolver::beginTailBlock(Layer& l) noexcept
 {
-    if (!m_directEnabled || numSamples <= 0 || m_directOutBuf == nullptr || m_directWindow == nullptr || m_directIRRev == nullptr)
+    if (m_tailOffload)
+    {
+        // ★ Tail Worker: 前ブロックのデッドライン判定 → 入力コピーのみ
+        collectTailJobs(l, true);
+        submitTailJob(l);
         return;
+    }
 
-    if (numSamples > m_directMaxBlock)
+    pushFdlBlock(l, l.inputAccBuf);
+
+    memset(l.accumReal, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+    memset(l.accumImag, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+    beginSpectralFadeBlock(l);
+    beginSpectralMorphBlock(l);
+    l.nextPart    = 0;
+    l.distributing = true;
+}
+
+//==============================================================================
+// completeTailBlock  ─ Audio Thread (L1/L2 分散累積完了)
+//==============================================================================
+void MKLNonUniformConvolver::completeTailBlock(Layer& l) noexcept
+{
+    blendSpectralFade(l);
+    blendSpectralMorph(l);
+    finishTailBlock(l, l.tailOutputBuf);
+    l.tailOutputPos = 0;
+
+    // ★ B13: 遅延補償リングバッファに書き込み
+    if (l.delayLineBuf != nullptr)
+        delayLineWrite(l, l.tailOutputBuf, l.partSize);
+
+    l.distributing = false;
+    l.nextPart     = 0;
+}
+
+//==============================================================================
+// finishImmediateBlock  ─ Audio Thread (L0: デノーマル除去 → IFFT → ringWrite)
+//==============================================================================
+void MKLNonUniformConvolver::finishImmediateBlock(Layer& l) noexcept
+{
+    blendSpectralFade(l);
+    blendSpectralMorph(l);
+
+    // ★ Input sparsity: FDL 窓全体がゼロ → 累積スペクトルも IFFT 出力も厳密にゼロ
+    if (isFdlWindowSilent(l))
     {
-        jassertfalse;
-        m_directPendingSamples = 0;
+        juce::FloatVectorOperations::clear(l.fftOutBuf + l.partSize, l.partSize);
+        ringWrite(l.fftOutBuf + l.partSize, l.partSize);
         return;
     }
 
-    constexpr double kDenormalThreshold = convo::numeric_policy::kDenormThresholdAudioState;
-    juce::FloatVectorOperations::clear(m_directOutBuf, numSamples);
+    memset(l.accumBuf, 0, l.partStride * sizeof(double));
+    interleaveComplex(l.accumReal, l.accumImag, l.accumBuf, l.complexSize);
 
-    int processed = 0;
-    while (processed < numSamples)
-    {
-        const int chunk = std::min(numSamples - processed, m_directMaxBlock);
+    // IFFT 前にデノーマル対策 (accumBuf の複素データに適用)
+#if defined(__AVX2__)
+    for (int k = 0; k < l.partStride; k += 4) {
+        __m256d v = _mm256_load_pd(&l.accumBuf[k]);
+        v = killDenormalV(v);
+        _mm256_store_pd(&l.accumBuf[k], v);
+    }
+#else
+    for (int k = 0; k < l.partStride; ++k)
+        l.accumBuf[k] = killDenormal(l.accumBuf[k]);
+#endif
+    // [v2.1] CCS → real。FftScaling::InverseByN により 1/N 正規化自動適用
+    l.fftPlan->inverse(l.accumBuf, l.fftOutBuf, l.fftWorkBuf);
 
-        if (m_directHistLen > 0)
-            juce::FloatVectorOperations::copy(m_directWindow, m_directHistory, m_directHistLen);
+    ringWrite(l.fftOutBuf + l.partSize, l.partSize);
+}
 
-        if (input)
-            juce::FloatVectorOperations::copy(m_directWindow + m_directHistLen, input + processed, chunk);
-        else
-            memset(m_directWindow + m_directHistLen, 0, static_cast<size_t>(chunk) * sizeof(double));
+//==============================================================================
+// accumulatePartsTrueStereo  ─ True-stereo 4 パス MAC (パーティション [beginPart, endPart))
+//   outL += FDL_L × LL + FDL_R × RL,  outR += FDL_R × RR + FDL_L × LR
+//   各 FDL パーティションは 1 回の load で直接パス・クロスパスの両方に使う。
+//==============================================================================
+void MKLNonUniformConvolver::accumulatePartsTrueStereo(Layer& a, Layer& b, int beginPart, int endPart) noexcept
+{
+    jassert(!a.compactSpectra && !b.compactSpectra);  // adoptCrossSpectraFrom が Compact tail を拒否する
+    jassert(!a.binMajor && !b.binMajor);              // 同 Bin-major FDL も拒否する
+    jassert(!a.fadeActive && !b.fadeActive);            // isSpectralCrossfadeCompatible が True-stereo を拒否する
+    jassert(!a.morphActive && !b.morphActive);          // isSpectralMorphCompatible も同様
+    // ★ Input sparsity: L/R 両方の FDL がゼロの区間のみ省く (片側ゼロの項はゼロを加算するだけで結果は不変)
+    endPart = std::max(activePartEnd(a, endPart), activePartEnd(b, endPart));
+    const int linStartA = a.baseFdlIdxSaved - a.numPartsIR + 1 + a.numParts;
+    const int linStartB = b.baseFdlIdxSaved - b.numPartsIR + 1 + b.numParts;
+    const size_t cs = static_cast<size_t>(a.complexSize);
+
+    for (int p = beginPart; p < endPart; ++p)
+    {
+        const size_t irOff = static_cast<size_t>(p) * cs;
+        const double* fdlARe = a.fdlReal + static_cast<size_t>(linStartA + p) * cs;
+        const double* fdlAIm = a.fdlImag + static_cast<size_t>(linStartA + p) * cs;
+        const double* fdlBRe = b.fdlReal + static_cast<size_t>(linStartB + p) * cs;
+        const double* fdlBIm = b.fdlImag + static_cast<size_t>(linStartB + p) * cs;
 
-        for (int n = 0; n < chunk; ++n)
+        if (p + 1 < endPart)
         {
-            const double* x = m_directWindow + n;
-            __m256d sum0 = _mm256_setzero_pd();
-            __m256d sum1 = _mm256_setzero_pd();
-            int k = 0;
-            const int vEnd8 = (m_directTapCount / 8) * 8;
+            _mm_prefetch((const char*)(fdlARe + cs), _MM_HINT_T1);
+            _mm_prefetch((const char*)(fdlBRe + cs), _MM_HINT_T1);
+            _mm_prefetch((const char*)(a.irFreqReal + irOff + cs), _MM_HINT_T1);
+            _mm_prefetch((const char*)(b.irFreqReal + irOff + cs), _MM_HINT_T1);
+        }
 
-            for (; k < vEnd8; k += 8)
-            {
-                const __m256d h0 = _mm256_load_pd(m_directIRRev + k);
-                const __m256d x0 = _mm256_loadu_pd(x + k);
-                const __m256d h1 = _mm256_load_pd(m_directIRRev + k + 4);
-                const __m256d x1 = _mm256_loadu_pd(x + k + 4);
-                sum0 = _mm256_fmadd_pd(h0, x0, sum0);
-                sum1 = _mm256_fmadd_pd(h1, x1, sum1);
-            }
+        accumulateSplitComplexTrueStereo(fdlARe, fdlAIm, fdlBRe, fdlBIm,
+                                         a.irFreqReal + irOff, a.irFreqImag + irOff,          // LL
+                                         a.crossIrFreqReal + irOff, a.crossIrFreqImag + irOff, // RL
+                                         b.irFreqReal + irOff, b.irFreqImag + irOff,          // RR
+                                         b.crossIrFreqReal + irOff, b.crossIrFreqImag + irOff, // LR
+                                         a.accumReal, a.accumImag, b.accumReal, b.accumImag,
+                                         a.complexSize);
+    }
+}
+
+//==============================================================================
+// accumulatePartsStereo  ─ L/R 融合 MAC (パーティション [beginPart, endPart))
+//==============================================================================
+void MKLNonUniformConvolver::accumulatePartsStereo(Layer& a, Layer& b, int beginPart, int endPart) noexcept
+{
+    // ★ Compact tail: float32 レイヤーはチャンネル別 MAC (帯域は既に半減しており融合の利得は小さい)
+    // ★ Spectral crossfade / morph: 2 つ目のスペクトルの MAC を含めチャンネル別に処理する
+    // ★ Far-tail paging: 常駐判定はチャンネル別の accumulateParts が行う
+    // ★ Bin-major FDL: タイル MAC はアキュムレータをレジスタに保持するため 1 チャンネルずつ回す
+    if (a.compactSpectra || a.binMajor || a.fadeActive || b.fadeActive || a.morphActive || b.morphActive
+        || a.pager != nullptr || b.pager != nullptr)
+    {
+        accumulateParts(a, beginPart, endPart);
+        accumulateParts(b, beginPart, endPart);
+        return;
+    }
 
-            double y = hsum256_pd(_mm256_add_pd(sum0, sum1));
-            for (; k < m_directTapCount; ++k)
-                y += m_directIRRev[k] * x[k];
+    const int linStartA = a.baseFdlIdxSaved - a.numPartsIR + 1 + a.numParts;
+    const int linStartB = b.baseFdlIdxSaved - b.numPartsIR + 1 + b.numParts;
+    const bool sharedIR = (a.irFreqReal == b.irFreqReal) && (a.irFreqImag == b.irFreqImag);
+    const size_t cs = static_cast<size_t>(a.complexSize);
 
-            if (!isFiniteAndAboveThresholdMask(y, kDenormalThreshold))
-                y = 0.0;
+    // ★ Input sparsity: チャンネル別にゼロ FDL 区間を除外し、両方有効な項のみ融合する
+    const int endA = activePartEnd(a, endPart);
+    const int endB = activePartEnd(b, endPart);
+    endPart = std::max(endA, endB);
 
-            m_directOutBuf[processed + n] = y;
+    for (int p = beginPart; p < endPart; ++p)
+    {
+        const double* fdlARe = a.fdlReal    + static_cast<size_t>(linStartA + p) * cs;
+        const double* fdlAIm = a.fdlImag    + static_cast<size_t>(linStartA + p) * cs;
+        const double* fdlBRe = b.fdlReal    + static_cast<size_t>(linStartB + p) * cs;
+        const double* fdlBIm = b.fdlImag    + static_cast<size_t>(linStartB + p) * cs;
+        const double* irARe  = a.irFreqReal + static_cast<size_t>(p) * cs;
+        const double* irAIm  = a.irFreqImag + static_cast<size_t>(p) * cs;
+
+        if (p + 1 < endPart)
+        {
+            _mm_prefetch((const char*)(fdlARe + cs), _MM_HINT_T1);
+            _mm_prefetch((const char*)(fdlBRe + cs), _MM_HINT_T1);
+            _mm_prefetch((const char*)(irARe  + cs), _MM_HINT_T1);
         }
 
-        if (m_directHistLen > 0)
-            juce::FloatVectorOperations::copy(m_directHistory, m_directWindow + chunk, m_directHistLen);
-
-        processed += chunk;
+        const bool silentA = p >= endA || isPartSilent(a, p);
+        const bool silentB = p >= endB || isPartSilent(b, p);
+        if (sharedIR && !silentA && !silentB)
+        {
+            accumulateSplitComplexStereo(fdlARe, fdlAIm, fdlBRe, fdlBIm, irARe, irAIm,
+                                         a.accumReal, a.accumImag, b.accumReal, b.accumImag, a.complexSize);
+        }
+        else
+        {
+            const double* irBRe = b.irFreqReal + static_cast<size_t>(p) * cs;
+            const double* irBIm = b.irFreqImag + static_cast<size_t>(p) * cs;
+            if (!silentA)
+                accumulateSplitComplex(fdlARe, fdlAIm, irARe, irAIm, a.accumReal, a.accumImag, a.complexSize);
+            if (!silentB)
+                accumulateSplitComplex(fdlBRe, fdlBIm, irBRe, irBIm, b.accumReal, b.accumImag, b.complexSize);
+        }
     }
-
-    m_directPendingSamples = numSamples;
 }
 
 //==============================================================================
-// processLayerBlock  ─ Audio Thread (L0 専用)
-//
-// 処理:
-//   1. Overlap-Save 形式で fftTimeBuf を組み立てる [prevInput | currentInput]
-//   2. Forward FFT → FDL の現在スロットへ格納
-//   3. FDL × IR の複素乗算積算 (AVX2 FMA)
-//   4. Backward FFT
-//   5. 有効出力 (後半 partSize サンプル) をリングバッファへ書き込み (ringWrite)
-//   6. FDL インデックスを進める
+// pushFdlBlock  ─ L1/L2: 1 パーティション分の入力を FFT して FDL へ push
+//   分散処理時は Audio Thread、Tail Worker 時はワーカースレッドから呼ばれる。
 //==============================================================================
-void MKLNonUniformConvolver::processLayerBlock(Layer& l) noexcept
+void MKLNonUniformConvolver::pushFdlBlock(Layer& l, const double* block) noexcept
 {
-#ifdef NUC_DEBUG_GUARDS
-    checkGuards();
-#endif
-#if JUCE_DEBUG
-    if (!convo::consumeAtomic(l.warmupCompleted, std::memory_order_acquire))
-    convo::fetchAddAtomic(debugWarmupGuardCount(), 1, std::memory_order_acq_rel);
-#endif
+    const int mirrorIndex = l.fdlIndex + l.numParts;
+    const bool blockSilent = isAllZeroBlock(block, l.partSize);
+
+    if (blockSilent && l.prevInputSilent)
+    {
+        // ★ Input sparsity: 窓 [prev|cur] が全ゼロ → FFT 結果は厳密にゼロ。FFT を省きスロットをゼロ埋めする。
+        //   FDL 全体が既にゼロ (silentFdlRun == numParts) なら書き込みも不要。prevInputBuf は既にゼロ。
+        if (l.silentFdlRun < l.numParts)
+        {
+            const size_t cur = static_cast<size_t>(l.fdlIndex) * l.complexSize;
+            const size_t mir = static_cast<size_t>(mirrorIndex) * l.complexSize;
+            if (l.compactSpectra)
+            {
+                juce::FloatVectorOperations::clear(l.fdlRealF + cur, l.complexSize);
+                juce::FloatVectorOperations::clear(l.fdlImagF + cur, l.complexSize);
+                juce::FloatVectorOperations::clear(l.fdlRealF + mir, l.complexSize);
+                juce::FloatVectorOperations::clear(l.fdlImagF + mir, l.complexSize);
+            }
+            else if (l.binMajor)
+            {
+                const int slots = l.numParts * 2;
+                for (int t = 0, n = convo::BinTileLayout::numTiles(l.complexSize); t < n; ++t)
+                {
+                    const int w = convo::BinTileLayout::tileWidth(t, l.complexSize);
+                    const size_t base = convo::BinTileLayout::tileOffset(slots, t);
+                    for (const int slot : { l.fdlIndex, mirrorIndex })
+                    {
+                        juce::FloatVectorOperations::clear(l.fdlReal + base + static_cast<size_t>(slot) * w, w);
+                        juce::FloatVectorOperations::clear(l.fdlImag + base + static_cast<size_t>(slot) * w, w);
+                    }
+                }
+            }
+            else
+            {
+                juce::FloatVectorOperations::clear(l.fdlReal + cur, l.complexSize);
+                juce::FloatVectorOperations::clear(l.fdlImag + cur, l.complexSize);
+                juce::FloatVectorOperations::clear(l.fdlReal + mir, l.complexSize);
+                juce::FloatVectorOperations::clear(l.fdlImag + mir, l.complexSize);
+            }
+            ++l.silentFdlRun;
+        }
+        convo::fetchAddAtomic(m_silentInputSkipCount, 1, std::memory_order_relaxed); // relaxed: 診断カウンタのみ
+
+        l.fdlIndex = (l.fdlIndex + 1) & l.fdlMask;
+        l.baseFdlIdxSaved = (l.fdlIndex - 1 + l.numParts) & l.fdlMask;
+        return;
+    }
 
-    // ── 1. [prevInput | currentInput] を fftTimeBuf に配置 (Overlap-Save) ──
     juce::FloatVectorOperations::copy(l.fftTimeBuf,              l.prevInputBuf, l.partSize);
-    juce::FloatVectorOperations::copy(l.fftTimeBuf + l.partSize, l.inputAccBuf,  l.partSize);
-    juce::FloatVectorOperations::copy(l.prevInputBuf, l.inputAccBuf, l.partSize);
+    juce::FloatVectorOperations::copy(l.fftTimeBuf + l.partSize, block,          l.partSize);
+    juce::FloatVectorOperations::copy(l.prevInputBuf, block, l.partSize);
+    l.prevInputSilent = blockSilent;
+    l.silentFdlRun    = 0;
 
-    // ── 2. Forward FFT ──
-    // [v2.1] ippsFFTFwd_RToCCS_64f: real → CCS interleaved complex
-    // CCS 出力形式: [re0,im0,re1,im1,...] ← 既存 AVX2 複素乗算と完全互換
+    // [v2.1] L1/L2 Forward FFT: real → CCS
     // [Mem-Fix] fdlBuf は使い捨てスクラッチ (current=offset0 / mirror=offset partStride)。
-    // 永続履歴は fdlReal/fdlImag (SoA) 側にのみ保持する。
     double* currentFDLSlot = l.fdlBuf;
-    ippsFFTFwd_RToCCS_64f(l.fftTimeBuf, currentFDLSlot, l.fftSpec, l.fftWorkBuf);
+    l.fftPlan->forward(l.fftTimeBuf, currentFDLSlot, l.fftWorkBuf);
 
-    deinterleaveComplex(currentFDLSlot,
-                        l.fdlReal + static_cast<size_t>(l.fdlIndex) * l.complexSize,
-                        l.fdlImag + static_cast<size_t>(l.fdlIndex) * l.complexSize,
-                        l.complexSize);
+    if (l.compactSpectra)
+    {
+        // ★ Compact tail: float32 FDL。mirror も同じ CCS スロットから変換する (AoS コピー不要)
+        const size_t cur = static_cast<size_t>(l.fdlIndex) * l.complexSize;
+        const size_t mir = static_cast<size_t>(mirrorIndex) * l.complexSize;
+        deinterleaveComplexToFloat(currentFDLSlot, l.fdlRealF + cur, l.fdlImagF + cur, l.complexSize);
+        std::memcpy(l.fdlRealF + mir, l.fdlRealF + cur, static_cast<size_t>(l.complexSize) * sizeof(float));
+        std::memcpy(l.fdlImagF + mir, l.fdlImagF + cur, static_cast<size_t>(l.complexSize) * sizeof(float));
+    }
+    else if (l.binMajor)
+    {
+        // ★ Bin-major FDL: mirror 用スクラッチ (fdlBuf 後半) に SoA で展開し、各タイルの当該 slot と mirror へ散らす
+        double* re = l.fdlBuf + l.partStride;
+        double* im = re + l.complexSize;
+        deinterleaveComplex(currentFDLSlot, re, im, l.complexSize);
+        const int slots = l.numParts * 2;
+        for (const int slot : { l.fdlIndex, mirrorIndex })
+        {
+            convo::BinTileLayout::scatterSlot(re, l.fdlReal, slots, slot, l.complexSize);
+            convo::BinTileLayout::scatterSlot(im, l.fdlImag, slots, slot, l.complexSize);
+        }
+    }
+    else
+    {
+        deinterleaveComplex(currentFDLSlot,
+                            l.fdlReal + static_cast<size_t>(l.fdlIndex) * l.complexSize,
+                            l.fdlImag + static_cast<size_t>(l.fdlIndex) * l.complexSize,
+                            l.complexSize);
+
+        // [最適化2] mirror write
+        double* mirrorFDLSlot = l.fdlBuf + l.partStride;
+        juce::FloatVectorOperations::copy(mirrorFDLSlot, currentFDLSlot, l.partStride);
+
+        deinterleaveComplex(mirrorFDLSlot,
+                            l.fdlReal + static_cast<size_t>(mirrorIndex) * l.complexSize,
+                            l.fdlImag + static_cast<size_t>(mirrorIndex) * l.complexSize,
+                            l.complexSize);
+    }
 
-    // [最適化2] Linearized ring buffer: mirror write
-    double* mirrorFDLSlot = l.fdlBuf + l.partStride;
-    memcpy(mirrorFDLSlot, currentFDLSlot, l.partStride * sizeof(double));
+    l.fdlIndex = (l.fdlIndex + 1) & l.fdlMask;
 
-    const int mirrorIndex = l.fdlIndex + l.numParts;
-    deinterleaveComplex(mirrorFDLSlot,
-                        l.fdlReal + static_cast<size_t>(mirrorIndex) * l.complexSize,
-                        l.fdlImag + static_cast<size_t>(mirrorIndex) * l.complexSize,
-                        l.complexSize);
+    // [Bug2 fix] FDL スナップショット保存
+    l.baseFdlIdxSaved = (l.fdlIndex - 1 + l.numParts) & l.fdlMask;
+}
 
-    // ── 3. 複素乗算積算 (FDL × IR) → accumBuf ──
-    memset(l.accumReal, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
-    memset(l.accumImag, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+//==============================================================================
+// accumulateParts  ─ L1/L2: パーティション [beginPart, endPart) を accumReal/Imag へ MAC
+//   Spectral crossfade 中はフェード先スペクトルでも同じ FDL 区間を fadeAccumReal/Imag へ MAC する。
+//   Spectral morph 接続中は m に応じてモーフ先スペクトルを accum (m=1) または morphAccum (0<m<1) へ MAC する。
+//==============================================================================
+void MKLNonUniformConvolver::accumulateParts(Layer& l, int beginPart, int endPart) noexcept
+{
+    if (l.pager != nullptr)
+        l.pager->noteCursor(l.pagerSlot, endPart);  // ★ Far-tail paging: 次に読む位置から先読みさせる
+    endPart = activePartEnd(l, endPart);  // ★ Input sparsity: 全ゼロ FDL スロットとの積和を省く
+
+    const bool morphOnly = l.morphActive && l.morphAmount >= 1.0;
+    if (morphOnly)
+        accumulatePartsInto(l, beginPart, endPart, l.morphIrFreqReal, l.morphIrFreqImag,
+                            l.morphIrFreqRealF, l.morphIrFreqImagF, l.morphPartSilent,
+                            l.accumReal, l.accumImag);
+    else
+        accumulatePartsInto(l, beginPart, endPart, l.irFreqReal, l.irFreqImag, l.irFreqRealF, l.irFreqImagF,
+                            l.partSilent, l.accumReal, l.accumImag);
+
+    if (l.morphActive && !morphOnly && l.morphAmount > 0.0)
+        accumulatePartsInto(l, beginPart, endPart, l.morphIrFreqReal, l.morphIrFreqImag,
+                            l.morphIrFreqRealF, l.morphIrFreqImagF, l.morphPartSilent,
+                            l.morphAccumReal, l.morphAccumImag);
+
+    if (l.fadeActive)
+        accumulatePartsInto(l, beginPart, endPart, l.fadeIrFreqReal, l.fadeIrFreqImag,
+                            l.fadeIrFreqRealF, l.fadeIrFreqImagF, l.fadePartSilent,
+                            l.fadeAccumReal, l.fadeAccumImag);
+}
 
-    // [Mem-Fix] AoS(fdlBuf/irFreqDomain) 経由の読み出しとダミーprefetchを廃止し、
-    // SoA (fdlReal/fdlImag, irFreqReal/irFreqImag) のみを読む一本化されたパスにする。
-    const int linStart = l.fdlIndex - l.numPartsIR + 1 + l.numParts;
+//==============================================================================
+// accumulatePartsInto  ─ accumulateParts の本体 (IR スペクトル・無音マスク・積算先を指定)
+//   endPart は呼び出し側で activePartEnd 適用済み。レイアウトは l と同一 (逆順格納・compact 一致) であること。
+//==============================================================================
+void MKLNonUniformConvolver::accumulatePartsInto(const Layer& l, int beginPart, int endPart,
+                                                 const double* irRe, const double* irIm,
+                                                 const float* irReF, const float* irImF, const uint8_t* silentMask,
+                                                 double* accRe, double* accIm) noexcept
+{
+    if (l.binMajor)
+    {
+        accumulateTilesInto(l, beginPart, endPart, irRe, irIm, silentMask, accRe, accIm);
+        return;
+    }
+
+    const int baseFdlIdx = l.baseFdlIdxSaved;
+    const int linStart   = baseFdlIdx - l.numPartsIR + 1 + l.numParts;
+
+    if (l.compactSpectra)
+    {
+        // ★ Compact tail: float32 SoA を読み、double の accumReal/accumImag へ積算する
+        for (int p = beginPart; p < endPart; ++p)
+        {
+            if (silentMask != nullptr && silentMask[p] != 0)
+                continue;  // ★ Partition culling
+            if (!isPartReadable(l, p))
+                continue;  // ★ Far-tail paging: 先読み未完了 (このサイクルの寄与を落とす)
+
+            const size_t fdlOff = static_cast<size_t>(linStart + p) * l.complexSize;
+            const size_t irOff  = static_cast<size_t>(p) * l.complexSize;
+
+            if (p + 1 < endPart)
+            {
+                _mm_prefetch((const char*)(l.fdlRealF + fdlOff + l.complexSize), _MM_HINT_T1);
+                _mm_prefetch((const char*)(irReF      + irOff  + l.complexSize), _MM_HINT_T1);
+            }
 
-    for (int p = 0; p < l.numPartsIR; ++p)
+            accumulateSplitComplexF32(l.fdlRealF + fdlOff, l.fdlImagF + fdlOff,
+                                      irReF + irOff, irImF + irOff,
+                                      accRe, accIm, l.complexSize);
+        }
+        return;
+    }
+
+    // [Mem-Fix] AoS(fdlBuf/irFreqDomain)経由の読み出しを廃止し、
+    // SoA (fdlReal/fdlImag, irFreqReal/irFreqImag) のみを読む一本化されたパスにする。
+    for (int p = beginPart; p < endPart; ++p)
     {
+        if (silentMask != nullptr && silentMask[p] != 0)
+            continue;  // ★ Partition culling: 中間無音パーティション
+        if (!isPartReadable(l, p))
+            continue;  // ★ Far-tail paging: 先読み未完了
+
         const int index = linStart + p;
-        const double* srcARe = l.fdlReal    + static_cast<size_t>(index) * l.complexSize;
-        const double* srcAIm = l.fdlImag    + static_cast<size_t>(index) * l.complexSize;
-        const double* srcBRe = l.irFreqReal + static_cast<size_t>(p)     * l.complexSize;
-        const double* srcBIm = l.irFreqImag + static_cast<size_t>(p)     * l.complexSize;
+        const double* srcARe = l.fdlReal + static_cast<size_t>(index) * l.complexSize;
+        const double* srcAIm = l.fdlImag + static_cast<size_t>(index) * l.complexSize;
+        const double* srcBRe = irRe      + static_cast<size_t>(p)     * l.complexSize;
+        const double* srcBIm = irIm      + static_cast<size_t>(p)     * l.complexSize;
+
+        if (p + 1 < endPart)
+        {
+            _mm_prefetch((const char*)(l.fdlReal + static_cast<size_t>(index + 1) * l.complexSize), _MM_HINT_T1);
+            _mm_prefetch((const char*)(irRe      + static_cast<size_t>(p + 1)     * l.complexSize), _MM_HINT_T1);
+        }
+
+        accumulateSplitComplex(srcARe, srcAIm, srcBRe, srcBIm, accRe, accIm, l.complexSize);
+    }
+}
+
+//==============================================================================
+// accumulateTilesInto  ─ accumulatePartsInto の Bin-major FDL 版
+//   タイル毎に FDL slot [linStart + beginPart, linStart + endPart) と IR slot [beginPart, endPart) が
+//   それぞれ連続するため、16 ビン分のアキュムレータをレジスタに置いたまま全パーティションを積算できる。
+//   ビン毎の演算順序 (p 昇順、mul/sub/add) は AVX2 のパーティション優先カーネルと同じ。
+//==============================================================================
+void MKLNonUniformConvolver::accumulateTilesInto(const Layer& l, int beginPart, int endPart,
+                                                 const double* irRe, const double* irIm, const uint8_t* silentMask,
+                                                 double* accRe, double* accIm) noexcept
+{
+    using convo::BinTileLayout;
+    jassert(!l.compactSpectra && l.pager == nullptr);  // SetImpulse がタイル化を double・非ページ化レイヤーに限る
 
-        if (p + 1 < l.numPartsIR)
+    constexpr int kTile = BinTileLayout::kTileBins;
+    static_assert(kTile == 16, "AVX2 タイルカーネルは Re/Im 各 4 レジスタ前提");
+    const int linStart = l.baseFdlIdxSaved - l.numPartsIR + 1 + l.numParts;
+    const int fdlSlots = l.numParts * 2;
+    const int numTiles = BinTileLayout::numTiles(l.complexSize);
+
+    for (int t = 0; t < numTiles; ++t)
+    {
+        const int k0 = BinTileLayout::tileBegin(t);
+        const int w  = BinTileLayout::tileWidth(t, l.complexSize);
+        const size_t fdlBase = BinTileLayout::tileOffset(fdlSlots, t) + static_cast<size_t>(linStart) * w;
+        const size_t irBase  = BinTileLayout::tileOffset(l.numParts, t);
+        const double* fRe = l.fdlReal + fdlBase;
+        const double* fIm = l.fdlImag + fdlBase;
+        const double* hRe = irRe + irBase;
+        const double* hIm = irIm + irBase;
+
+        if (w == kTile)
         {
-            _mm_prefetch((const char*)(l.fdlReal    + static_cast<size_t>(index + 1) * l.complexSize), _MM_HINT_T1);
-            _mm_prefetch((const char*)(l.irFreqReal + static_cast<size_t>(p + 1)     * l.complexSize), _MM_HINT_T1);
+            __m256d dr[4], di[4];
+            for (int j = 0; j < 4; ++j)
+            {
+                dr[j] = _mm256_loadu_pd(accRe + k0 + 4 * j);
+                di[j] = _mm256_loadu_pd(accIm + k0 + 4 * j);
+            }
+            for (int p = beginPart; p < endPart; ++p)
+            {
+                if (silentMask != nullptr && silentMask[p] != 0)
+                    continue;  // ★ Partition culling
+                const size_t off = static_cast<size_t>(p) * kTile;
+                for (int j = 0; j < 4; ++j)
+                {
+                    const __m256d ar = _mm256_loadu_pd(fRe + off + 4 * j);
+                    const __m256d ai = _mm256_loadu_pd(fIm + off + 4 * j);
+                    const __m256d br = _mm256_loadu_pd(hRe + off + 4 * j);
+                    const __m256d bi = _mm256_loadu_pd(hIm + off + 4 * j);
+                    dr[j] = _mm256_add_pd(dr[j], _mm256_sub_pd(_mm256_mul_pd(ar, br), _mm256_mul_pd(ai, bi)));
+                    di[j] = _mm256_add_pd(di[j], _mm256_add_pd(_mm256_mul_pd(ar, bi), _mm256_mul_pd(ai, br)));
+                }
+            }
+            for (int j = 0; j < 4; ++j)
+            {
+                _mm256_storeu_pd(accRe + k0 + 4 * j, dr[j]);
+                _mm256_storeu_pd(accIm + k0 + 4 * j, di[j]);
+            }
+            continue;
         }
 
-        accumulateSplitComplex(srcARe, srcAIm, srcBRe, srcBIm, l.accumReal, l.accumImag, l.complexSize);
+        // 末尾の端数タイル (complexSize = 2^n + 1 では Nyquist の 1 ビン)
+        for (int p = beginPart; p < endPart; ++p)
+        {
+            if (silentMask != nullptr && silentMask[p] != 0)
+                continue;
+            const size_t off = static_cast<size_t>(p) * w;
+            for (int k = 0; k < w; ++k)
+            {
+                accRe[k0 + k] += fRe[off + k] * hRe[off + k] - fIm[off + k] * hIm[off + k];
+                accIm[k0 + k] += fRe[off + k] * hIm[off + k] + fIm[off + k] * hRe[off + k];
+            }
+        }
     }
+}
 
-    memset(l.accumBuf, 0, l.partStride * sizeof(double));
-    interleaveComplex(l.accumReal, l.accumImag, l.accumBuf, l.complexSize);
-
-    // ── 4. Backward FFT ──
-    // IFFT 前にデノーマル対策 (accumBuf の複素データに適用)
-#if defined(__AVX2__)
-    for (int k = 0; k < l.partStride; k += 4) {
-        __m256d v = _mm256_load_pd(&l.accumBuf[k]);
-        v = killDenormalV(v);
-        _mm256_store_pd(&l.accumBuf[k], v);
+//==============================================================================
+// beginSpectralFadeBlock  ─ Audio Thread / Tail Worker (パーティション開始、accum クリア直後)
+//   新しいフェード世代を観測したらこのパーティションからフェードを開始する。
+//==============================================================================
+void MKLNonUniformConvolver::beginSpectralFadeBlock(Layer& l) noexcept
+{
+    if (!l.fadeActive)
+    {
+        const uint32_t generation = convo::consumeAtomic(m_fadeGeneration, std::memory_order_acquire); // acquire: beginSpectralCrossfade の fade* 書き込みと HB
+        if (generation == l.fadeGenerationSeen)
+            return;
+        l.fadeGenerationSeen = generation;
+        if (l.fadeSteps <= 0 || l.fadeAccumReal == nullptr || l.fadeAccumImag == nullptr)
+            return;
+        l.fadeActive = true;
+        l.fadeStep   = 0;
     }
-#else
-    for (int k = 0; k < l.partStride; ++k)
-        l.accumBuf[k] = killDenormal(l.accumBuf[k]);
-#endif
-    // [v2.1] ippsFFTInv_CCSToR_64f: CCS → real
-    // IPP_FFT_DIV_INV_BY_N により 1/N 正規化自動適用 (旧 DFTI_BACKWARD_SCALE と等価)
-    ippsFFTInv_CCSToR_64f(l.accumBuf, l.fftOutBuf, l.fftSpec, l.fftWorkBuf);
 
-    // ── 5. Overlap-Save: 有効出力をリングへ書き込み ──
-    ringWrite(l.fftOutBuf + l.partSize, l.partSize);
-
-    // ── 6. FDL インデックスを進める ──
-    l.fdlIndex = (l.fdlIndex + 1) & l.fdlMask;
+    memset(l.fadeAccumReal, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+    memset(l.fadeAccumImag, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
 }
 
 //==============================================================================
-// ringWrite  ─ Audio Thread (L0 専用)
+// blendSpectralFade  ─ Audio Thread / Tail Worker (全パーティション積算後、IFFT 前)
+//   accum = (1-g)·accum + g·fadeAccum,  g = (fadeStep+1) / fadeSteps
+//   最終ステップ (g=1) で IR スペクトルを入れ替え、以降は新スペクトルのみで MAC する。
 //==============================================================================
-void MKLNonUniformConvolver::ringWrite(const double* src, int n) noexcept
+void MKLNonUniformConvolver::blendSpectralFade(Layer& l) noexcept
 {
-#ifdef NUC_DEBUG_GUARDS
-    checkGuards();
-#endif
-    if (n <= 0 || m_ringBuf == nullptr || src == nullptr) return;
-
-    const int first = std::min(n, m_ringSize - m_ringWrite);
-    juce::FloatVectorOperations::copy(m_ringBuf + m_ringWrite, src, first);
-    if (n > first)
-        juce::FloatVectorOperations::copy(m_ringBuf, src + first, n - first);
-
-    m_ringWrite = (m_ringWrite + n) & m_ringMask;
+    if (!l.fadeActive)
+        return;
 
-    const int nextAvail = m_ringAvail + n;
-    if (nextAvail > m_ringSize)
-    {
-        const int overflow = nextAvail - m_ringSize;
-        m_ringRead = (m_ringRead + overflow) & m_ringMask;
-        m_ringAvail = m_ringSize;
-        // [BUG-02] m_ringWrite は直前の更新で既に正しい位置にある。overflow 時の追加更新は不要。
-        // m_ringWrite = (m_ringWrite + overflow) & m_ringMask;
-        convo::fetchAddAtomic(m_ringOverflowCount, 1, std::memory_order_acq_rel);
-        if (overflowCallback)
-            overflowCallback(overflowUserData);
-    }
-    else
+    const double g = static_cast<double>(l.fadeStep + 1) / static_cast<double>(l.fadeSteps);
+    if (!isFdlWindowSilent(l))
     {
-        m_ringAvail = nextAvail;
+        juce::FloatVectorOperations::multiply(l.accumReal, 1.0 - g, l.complexSize);
+        juce::FloatVectorOperations::multiply(l.accumImag, 1.0 - g, l.complexSize);
+        juce::FloatVectorOperations::addWithMultiply(l.accumReal, l.fadeAccumReal, g, l.complexSize);
+        juce::FloatVectorOperations::addWithMultiply(l.accumImag, l.fadeAccumImag, g, l.complexSize);
     }
+
+    if (++l.fadeStep >= l.fadeSteps)
+        completeSpectralFadeLayer(l);
 }
 
 //==============================================================================
-// ringRead  ─ Audio Thread (L0 専用)
+// completeSpectralFadeLayer  ─ Audio Thread / Tail Worker (フェード終端) / Message Thread (Reset)
+//   irFreq* と fadeIrFreq* を入れ替える。旧スペクトルは finishSpectralCrossfade まで生存する。
 //==============================================================================
-int MKLNonUniformConvolver::ringRead(double* dst, int n) noexcept
+void MKLNonUniformConvolver::completeSpectralFadeLayer(Layer& l) noexcept
 {
-    if (n <= 0 || m_ringBuf == nullptr) return 0;
+    std::swap(l.irFreqReal,     l.fadeIrFreqReal);
+    std::swap(l.irFreqImag,     l.fadeIrFreqImag);
+    std::swap(l.irFreqRealF,    l.fadeIrFreqRealF);
+    std::swap(l.irFreqImagF,    l.fadeIrFreqImagF);
+    std::swap(l.partSilent,     l.fadePartSilent);
+    std::swap(l.numSilentParts, l.fadeNumSilentParts);
+    l.fadeActive = false;
+
+    convo::fetchAddAtomic(m_fadeLayersDone, 1, std::memory_order_release); // release: 入れ替え後のポインタを finishSpectralCrossfade の acquire と HB
+}
 
-    const int toRead = std::min(n, m_ringAvail);
-    if (toRead == 0)
+//==============================================================================
+// beginSpectralMorphBlock  ─ Audio Thread / Tail Worker (パーティション開始、accum クリア直後)
+//   接続・解除の世代変化を観測し、接続中は m を目標へ morphStep だけ近づけてこのパーティションで固定する。
+//==============================================================================
+void MKLNonUniformConvolver::beginSpectralMorphBlock(Layer& l) noexcept
+{
+    const uint32_t generation = convo::consumeAtomic(m_morphGeneration, std::memory_order_acquire); // acquire: beginSpectralMorph の morph* 書き込みと HB
+    if (generation != l.morphGenerationSeen)
     {
-        if (dst) memset(dst, 0, n * sizeof(double));
-        return 0;
+        l.morphGenerationSeen = generation;
+        l.morphAmount = 0.0;
+        if ((generation & 1u) != 0)
+        {
+            l.morphActive = (l.morphAccumReal != nullptr && l.morphAccumImag != nullptr);
+        }
+        else
+        {
+            l.morphActive = false;
+            convo::fetchAddAtomic(m_morphLayersDetached, 1, std::memory_order_release); // release: 以後 morph* を読まないことを finishSpectralMorph の acquire へ
+        }
     }
+    if (!l.morphActive)
+        return;
 
-    const int first = std::min(toRead, m_ringSize - m_ringRead);
+    const double target = convo::consumeAtomic(m_morphTarget, std::memory_order_relaxed); // relaxed: 単独の目標値
+    l.morphAmount = (target > l.morphAmount) ? std::min(target, l.morphAmount + l.morphStep)
+                                             : std::max(target, l.morphAmount - l.morphStep);
 
-    if (dst)
+    if (l.morphAmount > 0.0 && l.morphAmount < 1.0)
     {
-        juce::FloatVectorOperations::copy(dst, m_ringBuf + m_ringRead, first);
-        if (toRead > first)
-            juce::FloatVectorOperations::copy(dst + first, m_ringBuf, toRead - first);
-
-        if (toRead < n)
-            memset(dst + toRead, 0, (n - toRead) * sizeof(double));
+        memset(l.morphAccumReal, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+        memset(l.morphAccumImag, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
     }
-
-    m_ringRead  = (m_ringRead + toRead) & m_ringMask;
-    m_ringAvail -= toRead;
-    return toRead;
 }
 
 //==============================================================================
-// Add  ─ Audio Thread
+// blendSpectralMorph  ─ Audio Thread / Tail Worker (全パーティション積算後、IFFT 前)
+//   accum = (1-m)·accum + m·morphAccum。m = 0 / 1 は accumulateParts が片側のみ MAC 済み。
 //==============================================================================
-void MKLNonUniformConvolver::Add(const double* input, int numSamples)
+void MKLNonUniformConvolver::blendSpectralMorph(Layer& l) noexcept
 {
-    #ifdef NUC_DEBUG_GUARDS
-        checkGuards();
-        // 内部バッファの簡単な健全性チェック
-        if (m_ringBuf && reinterpret_cast<uintptr_t>(m_ringBuf) % 64 != 0) __debugbreak();
-    #endif
-    if (!convo::consumeAtomic(m_ready, std::memory_order_acquire) || numSamples <= 0)
+    if (!l.morphActive || l.morphAmount <= 0.0 || l.morphAmount >= 1.0 || isFdlWindowSilent(l))
         return;
 
-    processDirectBlock(input, numSamples);
+    const double m = l.morphAmount;
+    juce::FloatVectorOperations::multiply(l.accumReal, 1.0 - m, l.complexSize);
+    juce::FloatVectorOperations::multiply(l.accumImag, 1.0 - m, l.complexSize);
+    juce::FloatVectorOperations::addWithMultiply(l.accumReal, l.morphAccumReal, m, l.complexSize);
+    juce::FloatVectorOperations::addWithMultiply(l.accumImag, l.morphAccumImag, m, l.complexSize);
+}
 
-    for (int li = 0; li < m_numActiveLayers; ++li)
+//==============================================================================
+// finishTailBlock  ─ L1/L2: 累積スペクトル → IFFT → 後半 partSize を dst へ
+//==============================================================================
+void MKLNonUniformConvolver::finishTailBlock(Layer& l, double* dst) noexcept
+{
+    // ★ Input sparsity: FDL 窓全体がゼロ → IFFT を省きゼロを出力 (遅延ラインの整合は呼び出し側で維持)
+    if (isFdlWindowSilent(l))
     {
-        Layer& l = m_layers[li];
+        memset(dst, 0, static_cast<size_t>(l.partSize) * sizeof(double));
+        return;
+    }
 
-#if JUCE_DEBUG
-        if (!convo::consumeAtomic(l.warmupCompleted, std::memory_order_acquire))
-            convo::fetchAddAtomic(debugWarmupGuardCount(), 1, std::memory_order_acq_rel);
-#endif
+    memset(l.accumBuf, 0, l.partStride * sizeof(double));
+    interleaveComplex(l.accumReal, l.accumImag, l.accumBuf, l.complexSize);
 
-        int consumed = 0;
-        while (consumed < numSamples)
-        {
-            const int toFill = std::min(numSamples - consumed, l.partSize - l.inputPos);
-            if (input)
-                memcpy(l.inputAccBuf + l.inputPos, input + consumed, toFill * sizeof(double));
-            else
-                memset(l.inputAccBuf + l.inputPos, 0, toFill * sizeof(double));
-            l.inputPos += toFill;
-            consumed   += toFill;
+    // [v2.1] Backward FFT: CCS → real (プランの再初期化は Audio Thread 内で行わない)
+    l.fftPlan->inverse(l.accumBuf, l.fftOutBuf, l.fftWorkBuf);
 
-            if (l.inputPos >= l.partSize)
-            {
-                l.inputPos = 0;
+    memcpy(dst, l.fftOutBuf + l.partSize, l.partSize * sizeof(double));
+}
 
-                if (l.isImmediate)
-                {
-                    processLayerBlock(l);
-                }
-                else
-                {
-                    jassert(consumed <= numSamples);
-                    // ★ [P0-3] Release 安全ガード: 超過時は clamp
-                    if (consumed > numSamples) [[unlikely]]
-                    {
-                        consumed = numSamples;
-                    }
+//==============================================================================
+// submitTailJob  ─ Audio Thread (Tail Worker 有効時)
+//   inputAccBuf を空き slot へコピーしてワーカーを起床させる。
+//   slot が満杯 (ワーカーが kTailJobSlots ブロック遅延) の場合はブロックを破棄し、
+//   遅延ラインへ無音を書いてサンプル位置の整合を保つ。
+//==============================================================================
+void MKLNonUniformConvolver::submitTailJob(Layer& l) noexcept
+{
+    const uint64_t submitted = convo::consumeAtomic(l.jobSubmitted, std::memory_order_relaxed); // relaxed: 書き手は Audio Thread のみ
+    const uint64_t completed = convo::consumeAtomic(l.jobCompleted, std::memory_order_acquire); // acquire: ワーカーの slot 読み出し完了と HB
 
-                    juce::FloatVectorOperations::copy(l.fftTimeBuf,              l.prevInputBuf, l.partSize);
-                    juce::FloatVectorOperations::copy(l.fftTimeBuf + l.partSize, l.inputAccBuf,  l.partSize);
-                    juce::FloatVectorOperations::copy(l.prevInputBuf, l.inputAccBuf, l.partSize);
+    if (submitted - completed >= static_cast<uint64_t>(kTailJobSlots)) [[unlikely]]
+    {
+        convo::fetchAddAtomic(m_tailSlotOverflowCount, 1, std::memory_order_relaxed);
+        juce::FloatVectorOperations::clear(l.tailOutputBuf, l.partSize);
+        if (l.delayLineBuf != nullptr)
+            delayLineWrite(l, l.tailOutputBuf, l.partSize);
+        return;
+    }
 
-                    // [v2.1] L1/L2 Forward FFT: real → CCS
-                    // [Mem-Fix] fdlBuf は使い捨てスクラッチ (current=offset0 / mirror=offset partStride)。
-                    double* currentFDLSlot = l.fdlBuf;
-                    ippsFFTFwd_RToCCS_64f(l.fftTimeBuf, currentFDLSlot, l.fftSpec, l.fftWorkBuf);
+    const size_t slotOffset = static_cast<size_t>(submitted % static_cast<uint64_t>(kTailJobSlots))
+                            * static_cast<size_t>(l.partSize);
+    memcpy(l.jobInputBuf + slotOffset, l.inputAccBuf, static_cast<size_t>(l.partSize) * sizeof(double));
 
-                    deinterleaveComplex(currentFDLSlot,
-                                        l.fdlReal + static_cast<size_t>(l.fdlIndex) * l.complexSize,
-                                        l.fdlImag + static_cast<size_t>(l.fdlIndex) * l.complexSize,
-                                        l.complexSize);
+    convo::publishAtomic(l.jobSubmitted, submitted + 1, std::memory_order_release); // release: slot 書き込みをワーカーの acquire と HB
+    convo::fetchAddAtomic(m_tailWorkSignal, 1u, std::memory_order_release);          // release: tailWorkerLoop の wait 解除と HB
+    // notify_one は待機スレッドの起床のみ (Windows: WakeByAddressSingle) でブロックしない。
+    m_tailWorkSignal.notify_one();
+}
 
-                    // [最適化2] mirror write
-                    double* mirrorFDLSlot = l.fdlBuf + l.partStride;
-                    juce::FloatVectorOperations::copy(mirrorFDLSlot, currentFDLSlot, l.partStride);
+//==============================================================================
+// collectTailJobs  ─ Audio Thread (Tail Worker 有効時)
+//   完了済みジョブの出力を発行順に B13 遅延ラインへ書き込む。
+//   atDeadline=true (パーティション境界) では未完了ジョブを期限切れとして無音で代替し、
+//   遅れて完了した結果は破棄する (jobCollected を先に進めることで読み飛ばす)。
+//==============================================================================
+void MKLNonUniformConvolver::collectTailJobs(Layer& l, bool atDeadline) noexcept
+{
+    const uint64_t completed = convo::consumeAtomic(l.jobCompleted, std::memory_order_acquire); // acquire: ワーカーの出力 slot 書き込みと HB
+    while (l.jobCollected < completed)
+    {
+        const size_t slotOffset = static_cast<size_t>(l.jobCollected % static_cast<uint64_t>(kTailJobSlots))
+                                * static_cast<size_t>(l.partSize);
+        if (l.delayLineBuf != nullptr)
+            delayLineWrite(l, l.jobOutputBuf + slotOffset, l.partSize);
+        ++l.jobCollected;
+    }
 
-                    const int mirrorIndex = l.fdlIndex + l.numParts;
-                    deinterleaveComplex(mirrorFDLSlot,
-                                        l.fdlReal + static_cast<size_t>(mirrorIndex) * l.complexSize,
-                                        l.fdlImag + static_cast<size_t>(mirrorIndex) * l.complexSize,
-                                        l.complexSize);
+    if (!atDeadline)
+        return;
 
-                    l.fdlIndex = (l.fdlIndex + 1) & l.fdlMask;
+    const uint64_t submitted = convo::consumeAtomic(l.jobSubmitted, std::memory_order_relaxed); // relaxed: 書き手は Audio Thread のみ
+    if (l.jobCollected < submitted) [[unlikely]]
+    {
+        juce::FloatVectorOperations::clear(l.tailOutputBuf, l.partSize);
+        while (l.jobCollected < submitted)
+        {
+            convo::fetchAddAtomic(m_tailDeadlineMissCount, 1, std::memory_order_relaxed);
+            if (l.delayLineBuf != nullptr)
+                delayLineWrite(l, l.tailOutputBuf, l.partSize);
+            ++l.jobCollected;
+        }
+    }
+}
 
-                    // [Bug2 fix] FDL スナップショット保存
-                    l.baseFdlIdxSaved = (l.fdlIndex - 1 + l.numParts) & l.fdlMask;
+//==============================================================================
+// startTailWorker / stopTailWorker  ─ Message Thread (SetImpulse / Reset / releaseAllLayers)
+//==============================================================================
+bool MKLNonUniformConvolver::startTailWorker() noexcept
+{
+    if (m_tailWorker.joinable())
+        return true;
 
-                    memset(l.accumReal, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
-                    memset(l.accumImag, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
-                    l.nextPart    = 0;
-                    l.distributing = true;
-                }
-            }
-        } // while consumed < numSamples
+    convo::publishAtomic(m_tailWorkerStopRequested, false, std::memory_order_relaxed); // relaxed: スレッド生成が HB を提供
+    try
+    {
+        m_tailWorker = std::thread([this]() { tailWorkerLoop(); });
+    }
+    catch (...)
+    {
+        return false;
+    }
 
-        // ────────────────────────────────────────────────────────────────────
-        // [Bug3 fix] 分散計算ループ: 毎コールバック実行
-        // ────────────────────────────────────────────────────────────────────
-        if (!l.isImmediate && l.distributing)
-        {
-            const int endPart  = std::min(l.nextPart + l.partsPerCallback, l.numPartsIR);
-            const int baseFdlIdx = l.baseFdlIdxSaved;
-            const int linStart   = baseFdlIdx - l.numPartsIR + 1 + l.numParts;
+    convo::publishAtomic(m_tailWorkerRunning, true, std::memory_order_release); // release: isTailWorkerActive の acquire と HB
+    return true;
+}
 
-            // [Mem-Fix] AoS(fdlBuf/irFreqDomain)経由の読み出しを廃止し、
-            // SoA (fdlReal/fdlImag, irFreqReal/irFreqImag) のみを読む一本化されたパスにする。
-            for (int p = l.nextPart; p < endPart; ++p)
-            {
-                const int index = linStart + p;
-                const double* srcARe = l.fdlReal    + static_cast<size_t>(index) * l.complexSize;
-                const double* srcAIm = l.fdlImag    + static_cast<size_t>(index) * l.complexSize;
-                const double* srcBRe = l.irFreqReal + static_cast<size_t>(p)     * l.complexSize;
-                const double* srcBIm = l.irFreqImag + static_cast<size_t>(p)     * l.complexSize;
+void MKLNonUniformConvolver::stopTailWorker() noexcept
+{
+    if (!m_tailWorker.joinable())
+        return;
 
-                if (p + 1 < endPart)
-                {
-                    _mm_prefetch((const char*)(l.fdlReal    + static_cast<size_t>(index + 1) * l.complexSize), _MM_HINT_T1);
-                    _mm_prefetch((const char*)(l.irFreqReal + static_cast<size_t>(p + 1)     * l.complexSize), _MM_HINT_T1);
-                }
+    convo::publishAtomic(m_tailWorkerStopRequested, true, std::memory_order_release); // release: tailWorkerLoop の acquire と HB
+    convo::fetchAddAtomic(m_tailWorkSignal, 1u, std::memory_order_release);         // release: wait 解除
+    m_tailWorkSignal.notify_one();
+    m_tailWorker.join();
 
-                accumulateSplitComplex(srcARe, srcAIm, srcBRe, srcBIm, l.accumReal, l.accumImag, l.complexSize);
-            }
+    convo::publishAtomic(m_tailWorkerRunning, false, std::memory_order_release); // release: isTailWorkerActive の acquire と HB
+}
 
-            l.nextPart = endPart;
+//==============================================================================
+// tailWorkerLoop  ─ Tail Worker スレッド
+//   オフロード中は L1/L2 の FDL / accum / FFT scratch をワーカーが専有する。
+//   ジョブは必ず発行順に全件処理する (期限切れでも FDL の連続性を保つため)。
+//==============================================================================
+void MKLNonUniformConvolver::tailWorkerLoop() noexcept
+{
+    if (m_tailWorkerAffinity != nullptr)
+        m_tailWorkerAffinity->applyCurrentThreadPolicy(ThreadType::ConvolverTail);
 
-            memset(l.accumBuf, 0, l.partStride * sizeof(double));
-            interleaveComplex(l.accumReal, l.accumImag, l.accumBuf, l.complexSize);
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+    mkl_set_num_threads_local(1);
 
-            // ── 全パーティション累積完了 → IFFT → tailOutputBuf へコピー ──
-            if (l.nextPart >= l.numPartsIR)
-            {
-                // [v2.1] Backward FFT: CCS → real (Audio Thread 内で再初期化禁止の制約はIPPも同様)
-                ippsFFTInv_CCSToR_64f(l.accumBuf, l.fftOutBuf, l.fftSpec, l.fftWorkBuf);
+    for (;;)
+    {
+        const uint32_t seenSignal = convo::consumeAtomic(m_tailWorkSignal, std::memory_order_acquire); // acquire: submitTailJob の release と HB
+        if (convo::consumeAtomic(m_tailWorkerStopRequested, std::memory_order_acquire)) // acquire: stopTailWorker の release と HB
+            break;
 
-                memcpy(l.tailOutputBuf, l.fftOutBuf + l.partSize, l.partSize * sizeof(double));
-                l.tailOutputPos = 0;
+        bool didWork = false;
+        for (int li = 1; li < m_numActiveLayers; ++li)
+        {
+            Layer& l = m_layers[li];
+            if (l.isImmediate || l.jobInputBuf == nullptr || l.jobOutputBuf == nullptr)
+                continue;
 
-                // ★ B13: 遅延補償リングバッファに書き込み
-                if (l.delayLineBuf != nullptr)
-                    delayLineWrite(l, l.tailOutputBuf, l.partSize);
+            uint64_t completed = convo::consumeAtomic(l.jobCompleted, std::memory_order_relaxed); // relaxed: 書き手はワーカーのみ
+            const uint64_t submitted = convo::consumeAtomic(l.jobSubmitted, std::memory_order_acquire); // acquire: 入力 slot 書き込みと HB
 
-                l.distributing = false;
-                l.nextPart     = 0;
+            while (completed < submitted)
+            {
+                const size_t slotOffset = static_cast<size_t>(completed % static_cast<uint64_t>(kTailJobSlots))
+                                        * static_cast<size_t>(l.partSize);
+
+                pushFdlBlock(l, l.jobInputBuf + slotOffset);
+                memset(l.accumReal, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+                memset(l.accumImag, 0, static_cast<size_t>(l.complexSize) * sizeof(double));
+                beginSpectralFadeBlock(l);
+                beginSpectralMorphBlock(l);
+                accumulateParts(l, 0, l.numPartsIR);
+                blendSpectralFade(l);
+                blendSpectralMorph(l);
+                finishTailBlock(l, l.jobOutputBuf + slotOffset);
+
+                ++completed;
+                convo::publishAtomic(l.jobCompleted, completed, std::memory_order_release); // release: 出力 slot を Audio Thread の acquire と HB
+                didWork = true;
             }
         }
 
-    } // for each layer
+        if (!didWork)
+            m_tailWorkSignal.wait(seenSignal, std::memory_order_acquire);
+    }
 }
 
 //==============================================================================
@@ -1734,11 +5056,136 @@ int MKLNonUniformConvolver::Get(double* output, int numSamples)
     return got;
 }
 
+//==============================================================================
+// GetMix  ─ Audio Thread
+// Get() と同じソース群の読み出し位置を先に確定し、折り返しのない区間ごとに
+// mixWetSourcesAvx2 で最終出力を書く。カーソル更新は Get() / delayLineReadAdd と同一
+//==============================================================================
+int MKLNonUniformConvolver::GetMix(const double* dry, double* output, int numSamples, const MixGains& gains) noexcept
+{
+    #ifdef NUC_DEBUG_GUARDS
+        checkGuards();
+    #endif
+    if (output == nullptr || dry == nullptr || numSamples <= 0)
+        return 0;
+
+    // 区間 [0, len) のソース。[0, firstLen) は first、[firstLen, len) は wrap から読む
+    struct Source
+    {
+        const double* first;
+        const double* wrap;
+        int firstLen;
+        int len;
+        double gain;
+    };
+    Source sources[kNumLayers + 1];
+    int numSources = 0;
+    int got = 0;
+    int directSamples = 0;
+
+    if (convo::consumeAtomic(m_ready, std::memory_order_acquire)) // acquire: SetImpulse の release と HB
+    {
+        // ── L0 リング ──
+        got = (m_ringBuf != nullptr) ? std::min(numSamples, m_ringAvail) : 0;
+        if (got > 0)
+        {
+            const int first = std::min(got, m_ringSize - m_ringRead);
+            sources[numSources++] = { m_ringBuf + m_ringRead, m_ringBuf, first, got, 1.0 };
+            m_ringRead  = (m_ringRead + got) & m_ringMask;
+            m_ringAvail -= got;
+        }
+
+        // ── Direct 出力 ── (読み終えた分はパス後にクリアする)
+        //   リング不足分 [got, numSamples) は Get() + 不足分のゼロ埋めと同じく wet=0 とし、
+        //   direct / L1/L2 の該当区間は読み捨てる (カーソルは Get() と同じだけ進める)
+        if (m_directEnabled && m_directOutBuf != nullptr)
+        {
+            directSamples = std::min(numSamples, m_directPendingSamples);
+            const int len = std::min(directSamples, got);
+            if (len > 0)
+                sources[numSources++] = { m_directOutBuf, nullptr, len, len, 1.0 };
+        }
+
+        // ── L1/L2 遅延出力 ── (delayLineReadAdd と同じ読み出し位置・スキップ条件)
+        for (int li = 1; li < m_numActiveLayers; ++li)
+        {
+            Layer& l = m_layers[li];
+            if (l.delayLineBuf == nullptr || l.delayLineCapacity <= 0)
+                continue;
+
+            const uint64_t maxRead = (l.delayWriteCursor >= static_cast<uint64_t>(l.outputDelaySamples))
+                ? (l.delayWriteCursor - static_cast<uint64_t>(l.outputDelaySamples))
+                : 0;
+            const uint64_t actualReadStart = std::max(l.delayReadCursor, maxRead);
+            if (actualReadStart + static_cast<uint64_t>(numSamples) > l.delayWriteCursor)
+                continue;
+
+            double layerGain = m_tailEnabled ? m_tailLayerGain[juce::jlimit(0, kNumLayers - 1, li)] : 0.0;
+            if (absNoLibm(layerGain - 1.0) < 1.0e-12)
+                layerGain = 1.0;    // delayLineReadAdd の単位ゲイン判定と揃える
+            if (layerGain != 0.0 && got > 0)
+            {
+                const size_t readOffset = static_cast<size_t>(actualReadStart % static_cast<uint64_t>(l.delayLineCapacity));
+                const int first = std::min(got, l.delayLineCapacity - static_cast<int>(readOffset));
+                sources[numSources++] = { l.delayLineBuf + readOffset, l.delayLineBuf, first, got, layerGain };
+            }
+            l.delayReadCursor = actualReadStart + static_cast<uint64_t>(numSamples);
+        }
+    }
+
+    // ── 融合パス ── どのソースも折り返さない区間ごとに 1 回ずつ書く。未準備・リング不足分は wet=0
+    const double* src[kNumLayers + 1] {};
+    double srcGain[kNumLayers + 1] {};
+    int pos = 0;
+    while (pos < numSamples)
+    {
+        int end = numSamples;
+        int numActive = 0;
+        for (int k = 0; k < numSources; ++k)
+        {
+            const Source& s = sources[k];
+            if (pos >= s.len)
+                continue;
+            end = std::min(end, (pos < s.firstLen) ? s.firstLen : s.len);
+            src[numActive] = (pos < s.firstLen) ? (s.first + pos) : (s.wrap + (pos - s.firstLen));
+            srcGain[numActive] = s.gain;
+            ++numActive;
+        }
+
+        const int n = end - pos;
+        const double* wetGain = (gains.wet != nullptr) ? gains.wet + pos : nullptr;
+        const double* dryGain = (gains.dry != nullptr) ? gains.dry + pos : nullptr;
+        if (wetGain != nullptr && dryGain != nullptr)
+            mixWetSourcesAvx2<true, true>(output + pos, dry + pos, src, srcGain, numActive, wetGain, dryGain, gains.wetConst, gains.dryConst, n);
+        else if (wetGain != nullptr)
+            mixWetSourcesAvx2<true, false>(output + pos, dry + pos, src, srcGain, numActive, wetGain, dryGain, gains.wetConst, gains.dryConst, n);
+        else if (dryGain != nullptr)
+            mixWetSourcesAvx2<false, true>(output + pos, dry + pos, src, srcGain, numActive, wetGain, dryGain, gains.wetConst, gains.dryConst, n);
+        else
+            mixWetSourcesAvx2<false, false>(output + pos, dry + pos, src, srcGain, numActive, wetGain, dryGain, gains.wetConst, gains.dryConst, n);
+        pos = end;
+    }
+
+    if (directSamples > 0)
+    {
+        memset(m_directOutBuf, 0, static_cast<size_t>(directSamples) * sizeof(double));
+        m_directPendingSamples = 0;
+    }
+    return got;
+}
+
 //==============================================================================
 // ★ B13: delayLineWrite — 遅延補償リングバッファ書き込み (Add / IFFT完了時)
 //==============================================================================
 void MKLNonUniformConvolver::delayLineWrite(Layer& l, const double* src, int n) noexcept
 {
+    // ★ Multirate tail: 低レートのブロック出力をフルレートへ戻してから書く
+    if (l.decimation > 1)
+    {
+        n = l.rateUp.interpolate(src, n, l.rateOutputBuf);
+        src = l.rateOutputBuf;
+    }
+
     const size_t writeOffset = static_cast<size_t>(l.delayWriteCursor % static_cast<uint64_t>(l.delayLineCapacity));
     const int remain = l.delayLineCapacity - static_cast<int>(writeOffset);
     const int first = std::min(n, remain);
@@ -1793,6 +5240,42 @@ void MKLNonUniformConvolver::delayLineReadAdd(Layer& l, double* dst, int numSamp
 //==============================================================================
 void MKLNonUniformConvolver::Reset()
 {
+    // ★ Tail Worker: FDL クリア中にワーカーが触れないよう一旦停止し、最後に再起動する
+    const bool restartTailWorker = m_tailOffload;
+    stopTailWorker();
+
+    // ★ Spectral crossfade: FDL をクリアするため合成を続ける意味がない。未完了レイヤーは即座に新スペクトルへ移行する
+    if (m_fadeSpectra != nullptr)
+    {
+        const uint32_t generation = convo::consumeAtomic(m_fadeGeneration, std::memory_order_relaxed); // relaxed: 書き手は Message Thread のみ
+        for (int li = 0; li < m_numActiveLayers; ++li)
+        {
+            Layer& l = m_layers[li];
+            if (l.fadeSteps > 0 && (l.fadeActive || l.fadeGenerationSeen != generation))
+            {
+                l.fadeGenerationSeen = generation;
+                completeSpectralFadeLayer(l);
+            }
+        }
+    }
+
+    // ★ Spectral morph: 解除要求済みなら Audio Thread を待たずに解除を確定する (m は 0 から再開)
+    if (m_morphSpectra != nullptr)
+    {
+        const uint32_t generation = convo::consumeAtomic(m_morphGeneration, std::memory_order_relaxed); // relaxed: 書き手は Message Thread のみ
+        for (int li = 0; li < m_numActiveLayers; ++li)
+        {
+            Layer& l = m_layers[li];
+            l.morphAmount = 0.0;
+            if ((generation & 1u) == 0 && l.morphGenerationSeen != generation)
+            {
+                l.morphGenerationSeen = generation;
+                l.morphActive = false;
+                convo::fetchAddAtomic(m_morphLayersDetached, 1, std::memory_order_relaxed); // relaxed: 読み手も Message Thread
+            }
+        }
+    }
+
     for (int li = 0; li < m_numActiveLayers; ++li)
     {
         Layer& l = m_layers[li];
@@ -1803,8 +5286,16 @@ void MKLNonUniformConvolver::Reset()
         const size_t fdlBufSize = static_cast<size_t>(l.partStride) * 2;
         const size_t fdlSoaSize = static_cast<size_t>(l.numParts) * 2 * static_cast<size_t>(l.complexSize);
         juce::FloatVectorOperations::clear(l.fdlBuf,       fdlBufSize);
-        juce::FloatVectorOperations::clear(l.fdlReal,      fdlSoaSize);
-        juce::FloatVectorOperations::clear(l.fdlImag,      fdlSoaSize);
+        if (l.compactSpectra)
+        {
+            juce::FloatVectorOperations::clear(l.fdlRealF, fdlSoaSize);
+            juce::FloatVectorOperations::clear(l.fdlImagF, fdlSoaSize);
+        }
+        else
+        {
+            juce::FloatVectorOperations::clear(l.fdlReal,  fdlSoaSize);
+            juce::FloatVectorOperations::clear(l.fdlImag,  fdlSoaSize);
+        }
         juce::FloatVectorOperations::clear(l.fftTimeBuf,   l.fftSize);
         juce::FloatVectorOperations::clear(l.fftOutBuf,    l.fftSize);
         juce::FloatVectorOperations::clear(l.prevInputBuf, l.partSize);
@@ -1822,6 +5313,16 @@ void MKLNonUniformConvolver::Reset()
         l.tailOutputPos   = 0;
         l.baseFdlIdxSaved = 0;
         l.distributing    = false;
+        l.silentFdlRun    = l.numParts;  // FDL / prevInputBuf はクリア済み
+        l.prevInputSilent = true;
+
+        convo::publishAtomic(l.jobSubmitted, uint64_t { 0 }, std::memory_order_relaxed); // relaxed: ワーカー停止中
+        convo::publishAtomic(l.jobCompleted, uint64_t { 0 }, std::memory_order_relaxed); // relaxed: 同上
+        l.jobCollected = 0;
+
+        // Multirate tail: カスケードの履歴と持ち越しを捨てる (未準備なら何もしない)
+        l.rateDown.reset();
+        l.rateUp.reset();
 
         // ★ B13: 遅延補償リセット (状態のみ、構成情報は保持)
         l.resetDelayAlignment();
@@ -1829,15 +5330,18 @@ void MKLNonUniformConvolver::Reset()
 
     if (m_ringBuf)
         juce::FloatVectorOperations::clear(m_ringBuf, m_ringSize);
-    m_ringWrite = 0;
+    m_ringWrite = (m_directEnabled && m_numActiveLayers > 0) ? m_layers[0].partSize : 0;
     m_ringRead  = 0;
-    m_ringAvail = 0;
+    m_ringAvail = m_ringWrite;
 
     if (m_directHistLen > 0 && m_directHistory)
         memset(m_directHistory, 0, static_cast<size_t>(m_directHistLen) * sizeof(double));
     if (m_directOutBuf && m_directMaxBlock > 0)
         memset(m_directOutBuf, 0, static_cast<size_t>(m_directMaxBlock) * sizeof(double));
     m_directPendingSamples = 0;
+
+    if (restartTailWorker)
+        m_tailOffload = startTailWorker();
 }
 
 } // namespace convo
@@ -18,6 +18,7 @@
 //   Layer 0 (即時): partSize = nextPowerOfTwo(max(blockSize,64))
 //                   最大 kL0MaxParts 個のパーティション (=IRの先頭約85ms@48kHz)
 //                   毎コールバックで全パーティションを即時処理 → 低レイテンシー
+//                   Zero-latency head 時は先頭 N タップを時間領域 FIR、L0 は h[N..) を partSize = N で処理
 //   Layer 1 (遅延): partSize = L0.partSize * 8
 //                   最大 kL1MaxParts 個のパーティション (=約1365ms@48kHz)
 //                   partsPerCallback ずつ分散処理 → CPUスパイク抑制
@@ -29,10 +30,11 @@
 //   L0  → 出力リングバッファ (ringBuf) に即時書き込み
 //   L1/L2 → tailOutputBuf にIFFT完了時コピー
 //   Get() = ringRead(L0) + vdAdd(L1.tailOutputBuf) + vdAdd(L2.tailOutputBuf)
+//   GetMix() は同じ合算を 1 パスで dry とミックスして書く (中間 wet バッファなし)
 //
 // ■ スレッド安全設計:
 //   SetImpulse()  : Message Thread (prepareToPlay 相当) からのみ呼び出す
-//   Add() / Get() : Audio Thread から呼び出す（メモリ確保なし）
+//   Add() / Get() / GetMix() : Audio Thread から呼び出す（メモリ確保なし）
 //   Reset()       : Message Thread または releaseResources() から呼び出す
 //
 // ■ 規約遵守:
@@ -50,19 +52,26 @@
 #include <memory>
 #include <optional>
 #include <functional>
+#include <thread>
 #include <JuceHeader.h>  // juce::nextPowerOfTwo, JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR
 #include "OutputFilter.h" // convo::HCMode, convo::LCMode
 
 #include "audioengine/AtomicAccess.h"
+#include "audioengine/MemoryLedger.h"
+#include "dsp/HalfBandCascade.h"
+#include "dsp/KernelDispatch.h"
 
 #ifdef _DEBUG
 #define NUC_DEBUG_GUARDS 1
 #endif
 
+class ThreadAffinityManager;
+
 namespace convo
 {
 
-struct IppFFTPlan;
+class RealFftPlan;
+class FarTailPager;
 
 //==============================================================================
 // ★ work70: LayerAllocSizes — レイヤーの全 MKL バッファサイズ
@@ -85,6 +94,17 @@ struct LayerAllocSizes {
     size_t inputAccBuf  = 0;
     size_t tailOutputBuf= 0;
     size_t delayLineBuf = 0;   // ★ Bug#1 B13遅延補償リングバッファのサイズ追跡
+    size_t jobInputBuf  = 0;   // ★ Tail Worker ジョブ入力 slot
+    size_t jobOutputBuf = 0;   // ★ Tail Worker ジョブ出力 slot
+    size_t irFreqRealF  = 0;   // ★ Compact tail: float32 IR スペクトル
+    size_t irFreqImagF  = 0;
+    size_t fdlRealF     = 0;   // ★ Compact tail: float32 FDL
+    size_t fdlImagF     = 0;
+    size_t partSilent   = 0;   // ★ Partition culling: 無音パーティションマスク
+    size_t fadeAccum    = 0;   // ★ Spectral crossfade: フェード先アキュムレータ (Real/Imag 各)
+    size_t morphAccum   = 0;   // ★ Spectral morph: モーフ先アキュムレータ (Real/Imag 各)
+    size_t rateInputBuf  = 0;  // ★ Multirate tail: 間引き後のコールバック入力
+    size_t rateOutputBuf = 0;  // ★ Multirate tail: 補間後のフルレート出力
 };
 
 /// NUC インスタンス単位の診断スナップショット（グローバル統計は含まない）。
@@ -98,6 +118,16 @@ struct NucDiagnosticsSnapshot {
     uint64_t ringBytes    = 0;
     int      numActiveLayers = 0;
     bool     isReady         = false;
+    int      compactLayers   = 0;   ///< ★ Compact tail: float32 化されたレイヤー数
+    uint64_t compactSavedBytes = 0; ///< ★ Compact tail: double 保持時との差分 (IR スペクトル + FDL)
+    int      totalPartsIR      = 0; ///< ★ Partition culling: 間引き前の IR パーティション総数 (全レイヤー)
+    int      culledTrailingParts = 0; ///< ★ Partition culling: 末尾無音として生成しなかったパーティション数
+    int      culledSilentParts = 0; ///< ★ Partition culling: MAC をスキップする中間無音パーティション数
+    uint64_t culledBytes       = 0; ///< ★ Partition culling: 末尾間引きで確保しなかった IR スペクトル + FDL の推定量
+    int      spectraRefCount   = 0; ///< ★ Shared spectra: IR スペクトルを参照中のインスタンス数 (自身を含む)
+    uint64_t sharedSpectraBytes = 0; ///< ★ Shared spectra: 共有 IR スペクトル (+ 無音マスク) の総量 (irFreqBytes に含む)
+    bool     spectraReused     = false; ///< ★ Shared spectra: SetImpulse が donor のスペクトルを再利用した (FFT 省略)
+    bool     spectraRetuned    = false; ///< ★ Retune: donor のスペクトルをゲイン比で再スケールした (FFT 省略)
     [[nodiscard]] uint64_t totalBytes() const noexcept {
         return layerBufs[0] + layerBufs[1] + layerBufs[2] + directBytes + ringBytes;
     }
@@ -110,7 +140,9 @@ struct NucDiagnosticsSnapshot {
 // NUC は SetImpulse() 内で SoA (irFreqReal/irFreqImag) に周波数ゲインを直接適用する。
 // AoS (irFreqDomain) は FFT出力→deinterleave の中継スクラッチのみ。
 // Audio Thread の追加コストはゼロ。モード変更時は SetImpulse() を再実行する
-// (rebuildAllIRs() トリガー)。
+// (rebuildAllIRs() トリガー)。旧世代を spectraDonor に渡せば HC/LC/tailStrength の変更は
+// FFT を伴わない再スケール (Retune) で済む。tailMode/tailStartSeconds/tailEnabled は
+// レイヤー構成を変えるため常に全再構築となる。
 //
 // hcMode = HCMode を参照 (OutputFilter.h):
 //   Sharp   : Butterworth 4次相当の急峻ロールオフ
@@ -132,6 +164,42 @@ struct FilterSpec
     double tailStartSeconds = 0.085; ///< Tail開始目安（秒）
     double tailStrength = 1.0; ///< L1/L2 出力の加算ゲイン
     int tailL1L2Multiplier = 8; ///< L1/L2 の partition 倍率
+
+    // ★ Tail Worker: L1/L2 を専用ワーカースレッドへオフロードする。
+    //   false の場合は従来どおり partsPerCallback による Audio Thread 内分散処理。
+    bool tailWorkerOffload = false; ///< true=L1/L2 をワーカースレッドで処理
+    const ::ThreadAffinityManager* tailWorkerAffinity = nullptr; ///< heavyBackground マスク適用用 (非所有, nullptr 可)
+
+    // ★ Compact tail: L1/L2 の IR スペクトルと FDL を float32 で保持する (L0 と時間領域出力は double のまま)。
+    //   テールは直接音より 60dB 以上低いため float 精度で十分。メモリと MAC の帯域が半減する。
+    bool compactTailSpectra = false; ///< true=L1/L2 スペクトルを float32 で保持
+
+    // ★ Partition culling: パーティションエネルギーがピークパーティション比でこの値以下なら無音とみなす。
+    //   末尾の無音パーティションは生成せず、中間の無音パーティションは FDL MAC をスキップする。
+    //   kPartitionCullDisabledDb 以下で無効。
+    static constexpr double kPartitionCullDisabledDb = -200.0;
+    double partitionCullFloorDb = -140.0; ///< ピーク比 (dB, エネルギー)
+    int partitionCullLength = 0; ///< >0: 末尾間引き後の IR 長を呼び出し元が指定 (ステレオペアの構成一致用)
+
+    // ★ Far-tail paging: IR 先頭からこの秒数より後ろにある L2 パーティションを一時ファイルのマップから読む
+    //   (FarTailPager)。先読みが間に合わないパーティションはそのサイクルの積算から外れる。0 で無効。
+    double farTailHorizonSeconds = 0.0; ///< 地平線 (秒)
+
+    // ★ Bin-major FDL: FDL と IR スペクトルをビンタイル単位 (core/BinTileLayout.h) で保持し、
+    //   タイルのアキュムレータをレジスタに置いたまま全パーティションを MAC する。double レイヤーのみ。
+    //   Auto はパーティション数が多く 1 パーティションが短いレイヤー (典型は L0) だけをタイル化する。
+    enum class SpectrumLayout : uint8_t { Auto, PartitionMajor, BinMajor };
+    SpectrumLayout spectrumLayout = SpectrumLayout::Auto; ///< レイヤー毎の配置選択
+
+    // ★ NUMA replicas: donor のスペクトルが呼び出しスレッドと別ノードにあれば、共有せず自ノードの複製を使う。
+    //   複製はノードごとに 1 つで同じノードのインスタンス間では共有する (オフラインのバッチワーカー用)。
+    bool replicateSpectraPerNode = false; ///< true=ノード別の複製を共有
+
+    // ★ Multirate tail: L2 の入力をハーフバンド多段 (dsp/HalfBandCascade.h) で 1/2〜1/8 に間引き、
+    //   同じく間引いた IR で畳み込んでから補間して戻す。可聴帯域 (20 kHz まで) は保ち、それより上だけを
+    //   L2 から落とすため、間引き後のレートが 44 kHz 台を下回る比は選ばない (48 kHz 以下では常に無効)。
+    //   tailMode が Air Absorption / Layer Tail Contouring のときのみ。Far-tail paging とは排他。
+    int tailDecimation = 1; ///< 1=無効, 0=自動 (条件を満たす最大の比), 2/4/8=上限を指定
 };
 
 //==============================================================================
@@ -192,14 +260,21 @@ public:
     // @param irLen         IR サンプル数 (> 0)
     // @param blockSize     Audio Thread の呼び出しブロックサイズ
     // @param scale         IRの振幅スケール (ヘッドルーム確保用, デフォルト=1.0)
+    // @param enableDirectHead  Zero-latency head。先頭 resolveDirectHeadTaps(blockSize) タップを時間領域 FIR で、
+    //                      残りを L0 (パーティション = 同タップ数) 以降で畳み込み、getLatency() = 0 にする。
+    //                      Add/Get は同じ呼び出しで同数ずつ (numSamples <= blockSize、任意の長さ可)。
     // @param filterSpec    出力周波数フィルター仕様。nullptr の場合フィルターなし。
     //                      SoA (irFreqReal/irFreqImag) に周波数ゲインを直接適用する (Audio Thread コストゼロ)。
+    // @param spectraDonor  旧世代の NUC (任意)。入力が完全一致すれば IR スペクトルを共有し、
+    //                      HC/LC モード・tailStrength のみ異なる場合はスペクトルを複製してゲイン比で
+    //                      再スケールする (★ Retune: 再分割・FFT なし)。それ以外は通常構築。
     // @return true=成功, false=パラメータ不正またはIPP初期化失敗
     //----------------------------------------------------------
     bool SetImpulse(const double* impulse, int irLen, int blockSize,
                     double scale = 1.0,
                     bool enableDirectHead = false,
-                    const FilterSpec* filterSpec = nullptr);
+                    const FilterSpec* filterSpec = nullptr,
+                    const MKLNonUniformConvolver* spectraDonor = nullptr);
 
     //----------------------------------------------------------
     // Add  ─ Audio Thread のみ
@@ -209,6 +284,128 @@ public:
     //----------------------------------------------------------
     void Add(const double* input, int numSamples);
 
+    //----------------------------------------------------------
+    // AddStereo  ─ Audio Thread のみ
+    // L/R 2 インスタンスへ同時に入力を投入する。パーティション境界が一致するため
+    // FDL × IR の MAC を 1 ループに融合し、IR 共有時は IR スペクトルを両チャンネルで使い回す。
+    // FFT/IFFT はチャンネル別 (IPP 実数 FFT)。構成不一致時は left.Add / right.Add と等価。
+    //----------------------------------------------------------
+    static void AddStereo(MKLNonUniformConvolver& left, MKLNonUniformConvolver& right,
+                          const double* inputL, const double* inputR, int numSamples);
+
+    //----------------------------------------------------------
+    // shareImpulseSpectraFrom  ─ Message Thread のみ (SetImpulse 直後、公開前)
+    // 同一 IR・同一パラメータで SetImpulse 済みの source と IR スペクトルを共有し、
+    // 自身の irFreqReal/irFreqImag を解放する。スペクトルは参照カウントで保持されるため
+    // source が先に破棄されてもよい。
+    // @return true=共有成功, false=レイヤー構成不一致 (状態は変更しない)
+    //----------------------------------------------------------
+    bool shareImpulseSpectraFrom(const MKLNonUniformConvolver& source) noexcept;
+    bool isStereoPairCompatible(const MKLNonUniformConvolver& other) const noexcept;
+
+    //----------------------------------------------------------
+    // adoptCrossSpectraFrom  ─ Message Thread のみ (SetImpulse 直後、公開前)
+    // True-stereo (LL/LR/RL/RR) 用。クロスパス IR で SetImpulse 済みの donor の
+    // IR スペクトルを参照カウントで保持し、クロスパスとして使う (donor の FDL 等は使わない)。
+    // Direct Head / Tail Worker 有効時は構成が合わないため拒否する。
+    // @return true=成功, false=構成不一致 (状態は変更しない)
+    //----------------------------------------------------------
+    bool adoptCrossSpectraFrom(MKLNonUniformConvolver& donor) noexcept;
+    bool hasCrossSpectra() const noexcept { return m_trueStereo; }
+
+    //----------------------------------------------------------
+    // Shared spectra 照会  ─ Message Thread のみ
+    // getSpectraFingerprint: SetImpulse 入力 (IR 内容・blockSize・scale・FilterSpec) のハッシュ。0=未構築
+    // sharesSpectraWith: other と同一の IR スペクトル実体を参照しているか
+    //----------------------------------------------------------
+    [[nodiscard]] uint64_t getSpectraFingerprint() const noexcept;
+    [[nodiscard]] bool sharesSpectraWith(const MKLNonUniformConvolver& other) const noexcept;
+
+    //----------------------------------------------------------
+    // Process-wide spectra registry 照会  ─ 任意の NonRT スレッド
+    // SetImpulse が構築した IR スペクトルはプロセス内の索引 (fingerprint → 共有体、参照は持たない) に載り、
+    // 同じ入力の SetImpulse は donor が無くても (別の AudioEngine / ConvolverProcessor からでも) それを共有する。
+    // entries / bytes は索引に載っている一意なスペクトルの数と総量、hits は索引経由で共有した SetImpulse の累計
+    //----------------------------------------------------------
+    struct SpectraRegistryStats
+    {
+        size_t   entries = 0;
+        uint64_t bytes   = 0;
+        uint64_t hits    = 0;
+    };
+    [[nodiscard]] static SpectraRegistryStats getSpectraRegistryStats() noexcept;
+
+    //----------------------------------------------------------
+    // Spectral crossfade  ─ IR 切替時に入力 FDL を共有したまま IR スペクトルを旧→新へフェードする
+    //   旧/新エンジンを並走させる時間領域クロスフェードと異なり、FFT/IFFT と FDL は 1 系統のまま
+    //   MAC のみが 2 倍になる。各レイヤーは次のパーティション境界から独立にフェードし、
+    //   IFFT 前に累積スペクトルを (1-g)·旧 + g·新 で合成する (g はパーティション単位で線形増加)。
+    //
+    // isSpectralCrossfadeCompatible : Message Thread のみ。target と同一レイヤー構成 (partSize/numParts/
+    //                                 numPartsIR/complexSize/compact)・同一レイテンシ・同一テールゲインか。
+    //                                 Direct Head / True-stereo は非対応。
+    // beginSpectralCrossfade        : Message Thread のみ。target の SharedSpectra を retain してフェードを開始する。
+    //                                 fadeSamples はレイヤー毎にパーティション数へ切り上げる (下限 2)。
+    //                                 @return false=非互換 / フェード中 / 確保失敗 (状態は変更しない)
+    // isSpectralCrossfadeComplete   : Message Thread のみ。全レイヤーが新スペクトルへ移行済みか (acquire)
+    // getSpectralCrossfadeLengthSamples : Message Thread のみ。begin 済みフェードが全レイヤーで完了するまでの
+    //                                 最大入力サンプル数 (開始待ちの 1 パーティションを含む)。フェード無しは 0
+    // finishSpectralCrossfade       : Message Thread のみ。完了後に旧スペクトルを解放しフェード資源を返す。
+    //                                 以後 getSpectraFingerprint / sharesSpectraWith は新スペクトルを指す。
+    //----------------------------------------------------------
+    [[nodiscard]] bool isSpectralCrossfadeCompatible(const MKLNonUniformConvolver& target) const noexcept;
+    bool beginSpectralCrossfade(const MKLNonUniformConvolver& target, int fadeSamples) noexcept;
+    [[nodiscard]] bool isSpectralCrossfadeActive() const noexcept { return m_fadeSpectra != nullptr; }
+    [[nodiscard]] bool isSpectralCrossfadeComplete() const noexcept;
+    [[nodiscard]] int64_t getSpectralCrossfadeLengthSamples() const noexcept;
+    void finishSpectralCrossfade() noexcept;
+
+    //----------------------------------------------------------
+    // Spectral morph  ─ 同一パーティション構成の 2 つの IR を、再構築なしで連続的にブレンドする
+    //   crossfade と同じく FDL・FFT/IFFT は 1 系統のまま target の SharedSpectra を retain し、
+    //   各レイヤーは IFFT 前に累積スペクトルを (1-m)·自 IR + m·target で合成する。
+    //   m は 0 / 1 に達している間は片側の MAC のみ (追加コストなし)、中間値では MAC が 2 倍になる。
+    //
+    // isSpectralMorphCompatible : Message Thread のみ。isSpectralCrossfadeCompatible と同じ条件 + モーフ未接続
+    // beginSpectralMorph        : Message Thread のみ。target のスペクトルを接続する (m は 0 から開始)。
+    //                             rampSamples: setSpectralMorphAmount の目標値へ追従する速さ
+    //                             (0→1 に要する入力サンプル数。レイヤー毎にパーティション単位で進む)
+    //                             @return false=非互換 / フェード・モーフ中 / 確保失敗 (状態は変更しない)
+    // setSpectralMorphAmount    : 任意スレッド。目標 m (0..1) を設定する (Audio Thread がランプで追従)
+    // endSpectralMorph          : Message Thread のみ。接続解除を要求する (以降は自 IR のみ。m は即座に 0)。
+    //                             解除前に m を 0 へ戻しておけばクリックは生じない
+    // finishSpectralMorph       : Message Thread のみ。全レイヤーが解除を観測した後に target スペクトルと
+    //                             アキュムレータを解放する。@return true=解放済み (未接続を含む)
+    //----------------------------------------------------------
+    [[nodiscard]] bool isSpectralMorphCompatible(const MKLNonUniformConvolver& target) const noexcept;
+    bool beginSpectralMorph(const MKLNonUniformConvolver& target, int rampSamples) noexcept;
+    [[nodiscard]] bool isSpectralMorphActive() const noexcept { return m_morphSpectra != nullptr; }
+    void setSpectralMorphAmount(double amount) noexcept;
+    [[nodiscard]] double getSpectralMorphAmount() const noexcept;
+    void endSpectralMorph() noexcept;
+    bool finishSpectralMorph() noexcept;
+
+    //----------------------------------------------------------
+    // Spectral bus  ─ 複数の IR を 1 系統の FDL・FFT/IFFT・MAC で畳み込む (多 IR バス)
+    //   入力 0 = 自 IR、入力 i = inputs[i-1] の SharedSpectra を retain し、Σ gains[i]·H_i を合成した
+    //   スペクトルを自 IR として使う。コストは単一 IR と同じ (合成は Message Thread で行う)。
+    //   ゲイン変更は合成し直したスペクトルへ spectral crossfade で移行する (再構築なし)。
+    //   接続中は別 IR への spectral crossfade / morph の対象外 (isSpectralCrossfadeCompatible が偽)。
+    //
+    // attachSpectralBus   : Message Thread のみ。SetImpulse 直後・公開前に呼ぶ。inputs は全て
+    //                       isSpectralCrossfadeCompatible を満たすこと (直後に破棄してよい)。
+    //                       gains は numInputs + 1 個 (gains[0] = 自 IR)。合成スペクトルへ即座に入れ替える。
+    //                       @return false=非互換 / 入力数超過 / 接続済み / 確保失敗 (状態は変更しない)
+    // setSpectralBusGains : Message Thread のみ。合成し直してフェードを開始する。完了は
+    //                       isSpectralCrossfadeComplete で待ち、finishSpectralCrossfade で確定する。
+    //                       @return false=未接続 / フェード・モーフ中 / 確保失敗 (呼び出し側が後で再試行)
+    // getSpectralBusInputCount : 接続中の入力数 (自 IR を含む)。未接続は 0
+    //----------------------------------------------------------
+    static constexpr int kMaxSpectralBusInputs = 4;
+    bool attachSpectralBus(const MKLNonUniformConvolver* const* inputs, int numInputs, const double* gains) noexcept;
+    bool setSpectralBusGains(const double* gains, int fadeSamples) noexcept;
+    [[nodiscard]] int getSpectralBusInputCount() const noexcept { return m_numBusInputs; }
+
     //----------------------------------------------------------
     // Get  ─ Audio Thread のみ
     // 畳み込み結果を output へ書き出す。
@@ -219,6 +416,33 @@ public:
     //----------------------------------------------------------
     int Get(double* output, int numSamples);
 
+    //----------------------------------------------------------
+    // GetMix  ─ Audio Thread のみ
+    // Get() と dry/wet ミックスを 1 パスに融合し、最終出力を直接書く:
+    //   output[i] = wet[i] * wetGain[i] + dry[i] * dryGain[i]
+    // wet は Get() と同じ合算 (L0 リング + direct + L1/L2 遅延出力) をレジスタ上で作り、
+    // 中間バッファを経由しない。非有限・過大 (|x| >= 1e300) な wet は 0 とみなす。
+    // リング不足分・未準備時は wet=0 (dry のみ) を書く。output と dry は同一バッファでもよい。
+    // @return 実際に読み出した L0 サンプル数 (Get() と同じ)
+    //----------------------------------------------------------
+    struct MixGains
+    {
+        const double* wet = nullptr;   // サンプル毎の wet ゲイン (平滑化中)。nullptr=wetConst
+        const double* dry = nullptr;   // サンプル毎の dry ゲイン。nullptr=dryConst
+        double wetConst = 1.0;
+        double dryConst = 0.0;
+
+        // 先頭 offset サンプルを消費した後のゲイン (callLen 分割用)
+        [[nodiscard]] MixGains advanced(int offset) const noexcept
+        {
+            MixGains g = *this;
+            if (g.wet != nullptr) g.wet += offset;
+            if (g.dry != nullptr) g.dry += offset;
+            return g;
+        }
+    };
+    int GetMix(const double* dry, double* output, int numSamples, const MixGains& gains) noexcept;
+
     //----------------------------------------------------------
     // Reset  ─ Message Thread / releaseResources() から
     // すべての内部バッファをゼロクリアし、位置変数を初期化する。
@@ -239,7 +463,7 @@ public:
 
     //----------------------------------------------------------
     // getLatency  ─ 出力の先頭レイテンシー (サンプル数)
-    // = Layer0 の partitionSize
+    // = Layer0 の partitionSize。Zero-latency head 有効時は 0
     //----------------------------------------------------------
     int getLatency() const noexcept { return m_latency; }
 
@@ -274,6 +498,92 @@ public:
         overflowUserData = userData;
     }
 
+    //----------------------------------------------------------
+    // Tail Worker 診断  ─ いつでも呼び出し可 (atomic load)
+    // isTailWorkerActive      : L1/L2 がワーカースレッドで処理されているか
+    // getTailDeadlineMissCount: パーティション境界までにワーカー結果が
+    //                           間に合わず無音で代替した回数
+    // getTailSlotOverflowCount: ジョブ slot 満杯でブロックを投入できなかった回数
+    //----------------------------------------------------------
+    bool isTailWorkerActive() const noexcept
+    {
+        return convo::consumeAtomic(m_tailWorkerRunning, std::memory_order_acquire);
+    }
+
+    int getTailDeadlineMissCount() const noexcept
+    {
+        return convo::consumeAtomic(m_tailDeadlineMissCount, std::memory_order_relaxed);
+    }
+
+    int getTailSlotOverflowCount() const noexcept
+    {
+        return convo::consumeAtomic(m_tailSlotOverflowCount, std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------
+    // Input sparsity 診断  ─ いつでも呼び出し可 (atomic load)
+    // getSilentInputSkipCount: 入力窓 [prev|cur] が全ゼロのため Forward FFT を省いたパーティション数 (全レイヤー合計)
+    //----------------------------------------------------------
+    int getSilentInputSkipCount() const noexcept
+    {
+        return convo::consumeAtomic(m_silentInputSkipCount, std::memory_order_relaxed);
+    }
+
+    //----------------------------------------------------------
+    // Far-tail paging 診断  ─ Message Thread のみ
+    // getFarTailPagedBytes: ヒープから外してマップへ移した IR スペクトル量 (0=ページング無効)
+    // getFarTailMissCount : 先読みが間に合わず積算から外したパーティション数 (共有相手の分を含む)
+    //----------------------------------------------------------
+    [[nodiscard]] uint64_t getFarTailPagedBytes() const noexcept;
+    [[nodiscard]] uint64_t getFarTailMissCount() const noexcept;
+
+    //----------------------------------------------------------
+    // 解放量の見積り  ─ 退役後の回収スレッド (BulkReleaseQueue の閾値判定)
+    // estimateReleaseBytes: 破棄で解放される量 = 自前バッファ + 最後の参照となる共有スペクトル
+    //----------------------------------------------------------
+    [[nodiscard]] uint64_t estimateReleaseBytes() const noexcept;
+
+    //----------------------------------------------------------
+    // Bin-major FDL 診断  ─ Message Thread のみ
+    // getBinMajorLayerCount: ビンタイル配置で動作しているレイヤー数
+    //----------------------------------------------------------
+    [[nodiscard]] int getBinMajorLayerCount() const noexcept;
+
+    //----------------------------------------------------------
+    // Multirate tail 診断  ─ Message Thread のみ
+    // getTailDecimation: L2 の間引き比 (1=フルレート、L2 が無い場合も 1)
+    //----------------------------------------------------------
+    [[nodiscard]] int getTailDecimation() const noexcept;
+
+    //----------------------------------------------------------
+    // CMAC カーネル選択 (FDL × IR 複素積和)
+    //
+    // 既定値はプロセス起動時に CpuFeatureCheck (hasAVX512Support) で決定する。
+    // AVX-512 非対応 CPU では常に Avx2。setCmacKernel はベンチマーク/検証用で、
+    // 非対応カーネルを指定した場合は false を返し状態を変更しない。
+    // runCmacKernel は dst += a × b (split complex, complexSize 要素) を指定カーネルで 1 回実行する。
+    //----------------------------------------------------------
+    enum class CmacKernel : uint8_t { Avx2 = 0, Avx512 = 1 };
+
+    static bool isCmacKernelSupported(CmacKernel kernel) noexcept;
+    static CmacKernel getCmacKernel() noexcept;
+    static bool setCmacKernel(CmacKernel kernel) noexcept;
+    static void runCmacKernel(CmacKernel kernel,
+                              const double* aReal, const double* aImag,
+                              const double* bReal, const double* bImag,
+                              double* dstReal, double* dstImag,
+                              int complexSize) noexcept;
+
+    //----------------------------------------------------------
+    // FFT プランの事前作成 (起動時のウォームアップ用)
+    //
+    // SetImpulse はレイヤーの fftSize ごとのプランをプロセス共有のキャッシュから取り、
+    // 無ければその場で作る。起動直後の最初の NUC 構築にプラン作成が直列に乗らないよう、
+    // 2^minOrder 〜 2^maxOrder をまとめて作っておく。作成済みの order は何もしない。
+    // 任意の Non-RT スレッド。
+    //----------------------------------------------------------
+    static void prewarmFftPlans(int minOrder, int maxOrder);
+
 private:
 #if JUCE_DEBUG
     static std::atomic<int> debugWarmupGuardCountStorage_;
@@ -299,21 +609,16 @@ private:
         int partStride    = 0;   // double 換算 complexSize*2 を 8-double アライン
         bool isImmediate  = false; // true = L0 (Add() 内で即時処理, リングを使用)
 
-        // ── IPP FFT ──
-        // [v2.1] MKL DFTI_DESCRIPTOR_HANDLE から Intel IPP へ換装。
-        //
-        // fftSpec    : ippsFFTInit_R_64f が管理する共有プラン内スペック。
+        // ── 実数 FFT (RealFft.h) ──
+        // fftPlan    : RealFftPlanCache が管理するサイズ単位の共有プラン (非所有)。実装 (IPP / MKL DFTI) は
+        //              FftBackendWisdom の実測で決まり、入出力はどちらも CCS 形式。
         //              Audio Thread からは Read-Only で参照 (スレッドセーフ)。
-        // fftPlanOwner: サイズ単位キャッシュへの非所有参照。
         // fftWorkBuf : 各 FFT 計算呼び出しが使用するスクラッチバッファ。
-        //              ippsFFTGetSize_R_64f が sizeWork > 0 を返した場合のみ確保。
-        //              sizeWork == 0 の場合 nullptr のまま (IPP が外部バッファ不要)。
+        //              fftPlan->getWorkBytes() > 0 の場合のみ確保 (0 なら nullptr のまま)。
         //              ★ Audio Thread での確保を防ぐため SetImpulse() で事前確保済み。
-        //                 nullptr かつ sizeWork==0 の場合のみ IPP に nullptr を渡してよい。
-        std::optional<std::reference_wrapper<const IppFFTPlan>> fftPlanOwner; ///< FFT plan 参照 (サイズ単位キャッシュ)
-        IppsFFTSpec_R_64f* fftSpec    = nullptr; ///< IPP FFT スペック (共有 plan 内を指す)
-        Ipp8u*             fftWorkBuf = nullptr; ///< FFT スクラッチ (sizeWork==0なら nullptr)
-        bool               descriptorCommitted = false; ///< IPP 初期化成功フラグ
+        const RealFftPlan* fftPlan    = nullptr;
+        Ipp8u*             fftWorkBuf = nullptr; ///< FFT スクラッチ (getWorkBytes()==0 なら nullptr)
+        bool               descriptorCommitted = false; ///< FFT プラン取得成功フラグ
 
         // ── IR 周波数領域 (Message Thread で確保・プリコンピュート) ──
         // [Mem-Fix] irFreqDomain は 1 パーティション分の使い捨てスクラッチ（FFT出力→deinterleave中継のみ）。
@@ -366,6 +671,97 @@ private:
         // 分散計算進行中フラグ (トリガ → true, IFFT 完了 → false)
         bool distributing      = false;
 
+        // ★ Input sparsity: 直近に push した FDL スロットのうち連続して全ゼロのスロット数 (numParts で飽和)。
+        //   逆順格納の IR パーティション p は numPartsIR-1-p ブロック前のスロットと積算されるため、
+        //   p >= numPartsIR - silentFdlRun の項は厳密にゼロとなり MAC を省ける。
+        int  silentFdlRun      = 0;
+        bool prevInputSilent   = false;  // prevInputBuf (Overlap-Save 窓の前半) が全ゼロ
+
+        // ★ Shared spectra: irFreqReal/Imag(F)・partSilent は SharedSpectra の所有物 (freeAll で解放しない)
+        bool irSpectraShared   = false;
+
+        // ★ Spectral crossfade: フェード先 IR スペクトル (m_fadeSpectra の所有物) と専用アキュムレータ。
+        //   fadeActive 中は accumulateParts が旧/新の両スペクトルで MAC し、IFFT 前に合成する。
+        //   フェード完了時は Audio Thread (Tail Worker) が irFreq* と fadeIrFreq* を入れ替える。
+        //   fade* の設定値は Message Thread が m_fadeGeneration の release 前に書き、
+        //   Audio Thread は世代の変化を acquire で観測した後にのみ読む。
+        double*  fadeIrFreqReal  = nullptr;
+        double*  fadeIrFreqImag  = nullptr;
+        float*   fadeIrFreqRealF = nullptr;
+        float*   fadeIrFreqImagF = nullptr;
+        uint8_t* fadePartSilent  = nullptr;
+        int      fadeNumSilentParts = 0;
+        double*  fadeAccumReal   = nullptr;  // mkl_malloc(complexSize * sizeof(double), 64)
+        double*  fadeAccumImag   = nullptr;
+        int      fadeSteps       = 0;        // フェード長 (パーティション数, 0=フェードなし)
+        int      fadeStep        = 0;        // 完了済みステップ (Audio Thread / Tail Worker)
+        bool     fadeActive      = false;    // 現パーティションで両スペクトルを積算中
+        uint32_t fadeGenerationSeen = 0;     // 最後に観測した m_fadeGeneration (Audio Thread / Tail Worker)
+
+        // ★ Spectral morph: モーフ先 IR スペクトル (m_morphSpectra の所有物) と専用アキュムレータ。
+        //   morph* の設定値は Message Thread が m_morphGeneration (奇数=接続) の release 前に書き、
+        //   Audio Thread / Tail Worker は世代の変化を acquire で観測した後にのみ読む。
+        double*  morphIrFreqReal  = nullptr;
+        double*  morphIrFreqImag  = nullptr;
+        float*   morphIrFreqRealF = nullptr;
+        float*   morphIrFreqImagF = nullptr;
+        uint8_t* morphPartSilent  = nullptr;
+        double*  morphAccumReal   = nullptr;  // mkl_malloc(complexSize * sizeof(double), 64)
+        double*  morphAccumImag   = nullptr;
+        double   morphStep        = 1.0;      // 1 パーティションあたりの m の最大変化量
+        double   morphAmount      = 0.0;      // 現パーティションの m (Audio Thread / Tail Worker)
+        bool     morphActive      = false;    // モーフ先スペクトルを接続中
+        uint32_t morphGenerationSeen = 0;     // 最後に観測した m_morphGeneration (Audio Thread / Tail Worker)
+
+        // ★ True-stereo: 相手チャンネル入力 → 本チャンネル出力のクロスパス IR スペクトル (SoA, 逆順格納)
+        //   AddStereo でペア相手の FDL と積算する。nullptr=2 パス (通常ステレオ)。実体は m_crossSpectra の所有
+        double* crossIrFreqReal = nullptr;
+        double* crossIrFreqImag = nullptr;
+
+        // ★ Compact tail: compactSpectra=true の場合 irFreqReal/Imag・fdlReal/Imag は nullptr となり、
+        //   代わりに下記 float32 版 (同一レイアウト) を使う。L1/L2 のみ。
+        bool   compactSpectra = false;
+        float* irFreqRealF = nullptr;   // mkl_malloc(numParts * complexSize * sizeof(float), 64)
+        float* irFreqImagF = nullptr;
+        float* fdlRealF    = nullptr;   // mkl_malloc((numParts*2) * complexSize * sizeof(float), 64)
+        float* fdlImagF    = nullptr;
+
+        // ★ Bin-major FDL: binMajor=true の場合 irFreqReal/Imag (fadeIrFreq*・共有先も同じ) と
+        //   fdlReal/fdlImag は BinTileLayout 配置 (slots = numParts / numParts*2)。compactSpectra とは排他。
+        bool   binMajor = false;
+
+        // ★ Partition culling: partSilent[p] != 0 のパーティション p (逆順格納インデックス) は MAC をスキップする。
+        //   無音パーティションが 1 つも無いレイヤーは nullptr (判定コストなし)。
+        uint8_t* partSilent = nullptr;  // mkl_malloc(numParts, 64)
+        int      numSilentParts = 0;
+
+        // ★ Far-tail paging: irFreq* (または irFreq*F) はマップ上を指し、p < pagedParts は pager が
+        //   常駐と報告したときだけ読む。pagerMayFault=true (Tail Worker が MAC する) なら常駐を待たず読む。
+        FarTailPager* pager = nullptr;   // SharedSpectra の所有物
+        int  pagerSlot      = -1;
+        int  pagedParts     = 0;
+        bool pagerMayFault  = false;
+
+        // ── Tail Worker (L1/L2 オフロード時のみ使用) ──
+        // Audio Thread は入力ブロックを jobInputBuf の slot へコピーして jobSubmitted を進め、
+        // ワーカーは FFT→FDL→MAC→IFFT を実行して jobOutputBuf の同 slot へ書き、jobCompleted を進める。
+        // FDL / accum / fftTimeBuf 等の作業バッファはオフロード中はワーカー専有となる。
+        double* jobInputBuf  = nullptr;   // mkl_malloc(kTailJobSlots * partSize * sizeof(double), 64)
+        double* jobOutputBuf = nullptr;   // mkl_malloc(kTailJobSlots * partSize * sizeof(double), 64)
+        alignas(64) std::atomic<uint64_t> jobSubmitted { 0 };  // Audio Thread が発行したジョブ数
+        alignas(64) std::atomic<uint64_t> jobCompleted { 0 };  // ワーカーが完了したジョブ数
+        uint64_t jobCollected = 0;        // Audio Thread が delayLine へ回収済み (または期限切れ破棄) のジョブ数
+
+        // ★ Multirate tail: decimation > 1 のレイヤーは partSize 以下の設定値・FDL・ジョブ slot がすべて
+        //   1/decimation のレートの値になる。Add は入力を rateDown で間引いてから蓄積し、
+        //   delayLineWrite は rateUp で補間したフルレート partSize·decimation サンプルを書く。
+        //   outputDelaySamples はフルレートのまま (3 つのフィルター遅延を差し引いた値)。
+        int     decimation    = 1;
+        convo::dsp::HalfBandCascade rateDown;  // Audio Thread (Add / AddStereo)
+        convo::dsp::HalfBandCascade rateUp;    // Audio Thread (delayLineWrite)
+        double* rateInputBuf  = nullptr;  // mkl_malloc((maxBlockSize / decimation + 2) * sizeof(double), 64)
+        double* rateOutputBuf = nullptr;  // mkl_malloc(partSize * decimation * sizeof(double), 64)
+
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
         LayerAllocSizes allocSizes;
 #endif
@@ -393,11 +789,134 @@ private:
     // 内部ヘルパー
     //----------------------------------------------------------
     void processLayerBlock(Layer& l) noexcept;
+    static void pushFdlBlock(Layer& l, const double* block) noexcept;
+    static void accumulateParts(Layer& l, int beginPart, int endPart) noexcept;
+    static void accumulatePartsInto(const Layer& l, int beginPart, int endPart,
+                                    const double* irRe, const double* irIm,
+                                    const float* irReF, const float* irImF, const uint8_t* silentMask,
+                                    double* accRe, double* accIm) noexcept;
+    static void accumulateTilesInto(const Layer& l, int beginPart, int endPart,
+                                    const double* irRe, const double* irIm, const uint8_t* silentMask,
+                                    double* accRe, double* accIm) noexcept;
+    void beginSpectralFadeBlock(Layer& l) noexcept;
+    void blendSpectralFade(Layer& l) noexcept;
+    void completeSpectralFadeLayer(Layer& l) noexcept;
+    void beginSpectralMorphBlock(Layer& l) noexcept;
+    static void blendSpectralMorph(Layer& l) noexcept;
+    static void accumulatePartsStereo(Layer& a, Layer& b, int beginPart, int endPart) noexcept;
+    static void accumulatePartsTrueStereo(Layer& a, Layer& b, int beginPart, int endPart) noexcept;
+    static void finishTailBlock(Layer& l, double* dst) noexcept;
+    void finishImmediateBlock(Layer& l) noexcept;
+    void beginTailBlock(Layer& l) noexcept;
+    void completeTailBlock(Layer& l) noexcept;
+    void submitTailJob(Layer& l) noexcept;
+    void collectTailJobs(Layer& l, bool atDeadline) noexcept;
+    bool startTailWorker() noexcept;
+    void stopTailWorker() noexcept;
+    void tailWorkerLoop() noexcept;
     void ringWrite(const double* src, int n) noexcept;
     int  ringRead(double* dst, int n) noexcept;
     void processDirectBlock(const double* input, int numSamples) noexcept;
     void releaseAllLayers() noexcept;
+    bool pageFarTail(const FilterSpec& spec, int layerOffset) noexcept;
+    void bindFarTailPager() noexcept;
+    // ★ RT residency: 公開済みスペクトルをラージページへ移す / その場でロックする (Message Thread)
+    void makeSpectraResident() noexcept;
+    void unbindFarTailPager() noexcept;
+    // ★ MemoryLedger: 自前で所有するバッファの合計 (共有スペクトルは SharedSpectra 側で申告)
+    [[nodiscard]] uint64_t computeOwnedBytes() const noexcept;
+    //----------------------------------------------------------
+    // SpectrumGainParams  ─ SetImpulse が IR スペクトルに焼き込む per-bin 実数ゲインの決定要素
+    //   HC/LC (applySpectrumFilter) と Air Absorption の L1/L2 HF ダンピング。
+    //   レイヤー構成に影響しないため、これだけが異なる再構築は donor スペクトルの再スケールで済む (Retune)。
+    //----------------------------------------------------------
+    struct SpectrumGainParams
+    {
+        bool   hasFilter = false;          // false: HC/LC なし (filterSpec == nullptr)
+        double sampleRate = 48000.0;
+        HCMode hcMode = HCMode::Natural;
+        LCMode lcMode = LCMode::Natural;
+        bool   airTilt = false;            // tailMode 0 の L1/L2 HF ダンピング
+        double airDampingBase = 0.0;
+    };
+    // fftSize はフルレート換算 (Multirate tail のレイヤーは l.fftSize * l.decimation)。
+    // complexSize が fftSize / 2 + 1 より小さい場合は低い方のビンだけを書く
+    static void fillSpectrumGain(const SpectrumGainParams& p, int layerIndex, int fftSize, int complexSize,
+                                 double* gain) noexcept;
+    static int buildRetuneRatio(const SpectrumGainParams& from, const SpectrumGainParams& to, int layerIndex,
+                                int fftSize, int complexSize, double* ratio, double* scratch) noexcept;
+    static void retuneLayerSpectra(Layer& l, const double* donorRe, const double* donorIm,
+                                   const float* donorReF, const float* donorImF, bool donorBinMajor,
+                                   const double* ratio, const double* irSrc, int irRemain, double scale) noexcept;
+    static bool buildDirectHeadTaps(const double* impulse, int taps, int headTaps, double scale,
+                                    const SpectrumGainParams& gains, double* irRev) noexcept;
     void applySpectrumFilter(const FilterSpec& spec) noexcept;
+    void applyAirAbsorptionTilt(double dampingBase) noexcept;
+    static bool compactLayerSpectra(Layer& l) noexcept;
+    static bool adoptCompactSpectra(Layer& l, float* irRe, float* irIm) noexcept;
+    static bool tileLayerSpectra(Layer& l) noexcept;
+
+    //----------------------------------------------------------
+    // SharedSpectra  ─ 不変 IR スペクトルの参照カウント共有体 (定義は .cpp)
+    //   SetImpulse 末尾で全レイヤーの irFreqReal/Imag(F)・partSilent の所有権をここへ移し、
+    //   以後 Layer は irSpectraShared=true で参照のみ保持する。FDL/アキュムレータ等の可変状態は
+    //   インスタンス毎。retain/release は Message Thread または NonRT の deferred delete のみ
+    //   (Audio Thread は参照カウントに触れない)。
+    //----------------------------------------------------------
+    struct SharedSpectra;
+    struct SpectraRegistry;
+    // 索引から fingerprint の共有体を参照 +1 して返す (解放中・未登録なら nullptr)
+    static SharedSpectra* acquireRegisteredSpectra(uint64_t fingerprint) noexcept;
+    static void registerSpectra(SharedSpectra* s) noexcept;
+    static uint64_t computeSpectraFingerprint(const double* impulse, int irLen, int blockSize, double scale,
+                                              bool enableDirectHead, const FilterSpec* filterSpec,
+                                              uint64_t* layoutFingerprint = nullptr) noexcept;
+    static SharedSpectra* retainSpectra(SharedSpectra* s) noexcept;
+    static void releaseSpectra(SharedSpectra*& s) noexcept;
+    bool publishLayerSpectra(uint64_t fingerprint, uint64_t layoutFingerprint, const SpectrumGainParams& gains) noexcept;
+    bool beginSpectralCrossfadeTo(SharedSpectra* src, int fadeSamples) noexcept;
+    [[nodiscard]] SharedSpectra* mixBusSpectra(const double* gains) const noexcept;
+    static const SharedSpectra* spectraForCurrentNode(const SharedSpectra* donor) noexcept;
+public:
+    //----------------------------------------------------------
+    // computeCulledIRLength  ─ 任意スレッド (純関数)
+    // SetImpulse と同じ規則 (L0 パーティション単位、ピーク比 floorDb) で末尾無音を除いた IR 長を返す。
+    // ステレオペアで共通の partitionCullLength を決めるために使う。
+    //----------------------------------------------------------
+    [[nodiscard]] static int computeCulledIRLength(const double* impulse, int irLen, int blockSize, double floorDb) noexcept;
+
+    //----------------------------------------------------------
+    // resolveTailL1L2Multiplier  ─ 任意スレッド (純関数)
+    // SetImpulse が実際に使う L1/L2 partition 倍率 (tailMode 別の下限適用後) を返す。
+    // NucLayoutWisdom が候補倍率の重複計測を避けるために使う。
+    //----------------------------------------------------------
+    [[nodiscard]] static int resolveTailL1L2Multiplier(const FilterSpec* filterSpec) noexcept;
+
+    //----------------------------------------------------------
+    // resolveTailDecimation  ─ 任意スレッド (純関数)
+    // FilterSpec の tailMode / サンプルレート / tailDecimation / farTailHorizonSeconds から L2 の間引き比を返す。
+    // 20 kHz までを kTailDecimationAttenuationDb で保てる最大の 2 / 4 / 8 (該当なしは 1)。
+    //----------------------------------------------------------
+    static constexpr double kTailDecimationPassbandHz = 20000.0;
+    static constexpr double kTailDecimationAttenuationDb = 100.0;
+    [[nodiscard]] static int resolveTailDecimation(const FilterSpec* filterSpec) noexcept;
+
+    //----------------------------------------------------------
+    // resolveDirectHeadTaps  ─ 任意スレッド (純関数)
+    // Zero-latency head (SetImpulse の enableDirectHead) の時間領域タップ数 N を blockSize から決める。
+    // L0 のパーティションも N になる。nextPowerOfTwo(blockSize) / 4 を [64, 256] に丸めた 2 の冪。
+    //----------------------------------------------------------
+    static constexpr int kMinDirectHeadTaps = 64;
+    static constexpr int kMaxDirectHeadTaps = 256;
+    [[nodiscard]] static int resolveDirectHeadTaps(int blockSize) noexcept;
+private:
+    void markSilentPartitions(double floorDb) noexcept;
+    [[nodiscard]] static bool isPartSilent(const Layer& l, int p) noexcept { return l.partSilent != nullptr && l.partSilent[p] != 0; }
+    // ★ Far-tail paging: ページ化範囲で未常駐なら読まない (ミスとして数える)
+    [[nodiscard]] static bool isPartReadable(const Layer& l, int p) noexcept;
+    // ★ Input sparsity: FDL が全ゼロの区間を除いた MAC 終端 / 窓全体がゼロか
+    [[nodiscard]] static int activePartEnd(const Layer& l, int endPart) noexcept { return std::min(endPart, l.numPartsIR - l.silentFdlRun); }
+    [[nodiscard]] static bool isFdlWindowSilent(const Layer& l) noexcept { return l.silentFdlRun >= l.numPartsIR; }
 
     // ★ B13: 遅延補償 内部ヘルパー
     void delayLineWrite(Layer& l, const double* src, int n) noexcept;
@@ -409,6 +928,7 @@ private:
     static constexpr int kNumLayers = 3;
     static constexpr int kL0MaxParts = 32;
     static constexpr int kL1MaxParts = 64;
+    static constexpr int kTailJobSlots = 4;  // Tail Worker のジョブ slot 数 (パーティション単位)
 
     Layer m_layers[kNumLayers];
     int   m_numActiveLayers = 0;
@@ -434,6 +954,7 @@ private:
     double* m_directHistory  = nullptr;
     double* m_directWindow   = nullptr;
     double* m_directOutBuf   = nullptr;
+    convo::dsp::FirVerticalKernel m_directFir = nullptr;  // SetImpulse で activeKernels() から写す
 
     std::atomic<bool> m_ready { false };
     bool    m_tailEnabled = true;
@@ -441,6 +962,48 @@ private:
     double  m_tailStrength = 1.0;
     double  m_tailLayerGain[kNumLayers] { 1.0, 1.0, 1.0 };
 
+    // ── True-stereo ──
+    bool    m_trueStereo = false;   // adoptCrossSpectraFrom 成功時 true (全レイヤーがクロスパスを保持)
+    bool    m_compactTail = false;  // SetImpulse で確定 (FilterSpec::compactTailSpectra && L1/L2 の float32 化成功)
+    int     m_totalPartsIR = 0;          // ★ Partition culling: 間引き前の IR パーティション総数
+    int     m_culledTrailingParts = 0;   // ★ Partition culling: 末尾間引きしたパーティション数
+    uint64_t m_culledBytes = 0;          // ★ Partition culling: 末尾間引きによる確保削減量 (推定)
+
+    // ── Shared spectra ──
+    SharedSpectra* m_spectra = nullptr;       // 直接パス IR スペクトル (参照カウント共有)
+    SharedSpectra* m_crossSpectra = nullptr;  // True-stereo クロスパス IR スペクトル (donor から retain)
+    bool           m_spectraReused = false;   // SetImpulse で donor のスペクトルを再利用した
+    bool           m_spectraRetuned = false;  // SetImpulse で donor のスペクトルをゲイン比で再スケールした
+
+    // ── Spectral crossfade ──
+    SharedSpectra* m_fadeSpectra = nullptr;   // フェード先 (begin で retain、finish で旧スペクトルと入替えて解放)
+    alignas(64) std::atomic<uint32_t> m_fadeGeneration { 0 };  // begin 毎に +1 (Layer::fade* 公開用)
+    std::atomic<int> m_fadeLayersDone { 0 };  // 新スペクトルへ移行済みのレイヤー数
+
+    // ── Spectral morph ──
+    SharedSpectra* m_morphSpectra = nullptr;  // モーフ先 (begin で retain、finish で解放)
+    alignas(64) std::atomic<uint32_t> m_morphGeneration { 0 };  // begin / end 毎に +1 (奇数=接続中)
+    std::atomic<double> m_morphTarget { 0.0 };      // setSpectralMorphAmount の目標 m
+    std::atomic<int> m_morphLayersDetached { 0 };   // end 後に解除を観測したレイヤー数
+
+    // ── Spectral bus ──
+    SharedSpectra* m_busSpectra[kMaxSpectralBusInputs] {};   // 入力ごとの IR スペクトル (attach で retain)
+    int m_numBusInputs = 0;
+
+    // ── Tail Worker ──
+    bool    m_tailOffload = false;  // SetImpulse で確定 (FilterSpec::tailWorkerOffload && L1/L2 が存在)
+    const ::ThreadAffinityManager* m_tailWorkerAffinity = nullptr;
+    std::thread m_tailWorker;
+    std::atomic<bool> m_tailWorkerRunning { false };
+    std::atomic<bool> m_tailWorkerStopRequested { false };
+    alignas(64) std::atomic<uint32_t> m_tailWorkSignal { 0 };  // atomic::wait/notify 用の起床カウンタ
+    std::atomic<int> m_tailDeadlineMissCount { 0 };
+    std::atomic<int> m_tailSlotOverflowCount { 0 };
+    std::atomic<int> m_silentInputSkipCount { 0 };  // ★ Input sparsity (Audio Thread / Tail Worker が加算)
+
+    // ★ MemoryLedger: SetImpulse 完了・スペクトルフェード・モーフの開始/完了・releaseAllLayers で更新
+    convo::MemoryCharge m_memoryCharge { convo::MemoryCategory::ConvolverLayers };
+
     #ifdef NUC_DEBUG_GUARDS
     alignas(64) uint64_t guardAfter[4] = {
         0xCAFEBABEDEADBEEF, 0xCAFEBABEDEADBEEF,
@@ -20,6 +20,16 @@
 #include "MainWindow.h"
 #include "MKLRealTimeSetup.h"
 #include "CpuFeatureCheck.h" // ★ [P0-1] AVX2 ランタイム検出
+#include "MKLNonUniformConvolver.h"
+#include "NucLayoutWisdom.h"
+#include "FftBackendWisdom.h"
+#include "CpuCostCalibration.h"
+#include "ResampledIRCache.h"
+#include "StartupProfiler.h"
+#include "EtwTrace.h"
+#include "DftiHandle.h"
+#include "dsp/KernelDispatch.h"
+#include "audioengine/RtSafetyGuard.h"
 
 #include <xmmintrin.h>
 #include <pmmintrin.h>
@@ -51,8 +61,32 @@
 #endif
 #endif
 
+namespace
+{
+    // ★ 起動時に実装を選んで前もって作る FFT プランの範囲 (fftSize 128 〜 65536)。
+    //   L0 はブロック長 64 〜 4096 の 2 倍、L1/L2 は既定の tail 倍率でその 8 倍 / 64 倍までを覆う。
+    constexpr int kPrewarmFftMinOrder = 7;
+    constexpr int kPrewarmFftMaxOrder = 16;
+
+    // MKL DFTI の初回コミットは CPU 別コードパスの選択と内部メモリ管理の初期化を伴う。
+    // IR 変換 (最小位相化・混合位相) の初回に乗らないよう、同じ種類の記述子を一度コミットして捨てる
+    void warmUpMklDfti() noexcept
+    {
+        convo::ScopedDftiDescriptor dfti;
+        if (DftiCreateDescriptor(dfti.put(), DFTI_DOUBLE, DFTI_COMPLEX, 1, 4096) == DFTI_NO_ERROR)
+            juce::ignoreUnused(DftiCommitDescriptor(dfti.get()));
+    }
+}
+
 void MainApplication::initialise(const juce::String& commandLine)
 {
+    // ★ --cli-startup-profile: 起動から最初の音出しまでのタイムラインを記録する (出力は MainWindow)
+    if (juce::StringArray::fromTokens(commandLine, true).contains("--cli-startup-profile", true))
+        convo::StartupProfiler::enable();
+
+    // ★ ETW プロバイダ "ConvoPeq" (セッションが無ければイベントは出ない)
+    convo::EtwTrace::registerProvider();
+
     // ★ [P0-1] AVX2 ランタイムチェック（非対応 CPU はここで終了）
     if (!convo::checkAVX2SupportAndWarn())
     {
@@ -67,6 +101,68 @@ void MainApplication::initialise(const juce::String& commandLine)
         juce::Logger::setCurrentLogger(fileLogger.get());
         juce::Logger::writeToLog("Logger initialized: " + logFile.getFullPathName());
     }
+    convo::StartupProfiler::mark("logger ready");
+
+    // ★ --rt-guard / --rt-guard-abort: Audio Thread の確保・ロックを記録 (abort は最初の違反で中断)。
+    //   MKL の確保関数を差し替えるため、最初の MKL 呼び出し (MKLRealTime::setup) より前に入れる
+    {
+        const auto tokens = juce::StringArray::fromTokens(commandLine, true);
+        const bool abortOnViolation = tokens.contains("--rt-guard-abort", true);
+        if (abortOnViolation || tokens.contains("--rt-guard", true))
+            convo::RtSafetyGuard::install(abortOnViolation);
+    }
+
+    // ────────────────────────────────────────────────────────────
+    // Intel MKL リアルタイム設定（B7 対応）
+    //   シングルスレッド固定、動的調整無効、環境変数による強制
+    //   (MKL を使うウォームアップタスクより先に呼ぶ)
+    // ────────────────────────────────────────────────────────────
+    MKLRealTime::setup();
+
+    // ★ 起動の並列化: 互いに独立な初期化をバックグラウンドで走らせ、以下のプロセス設定と重ねる。
+    //   ライブラリ系 (libraryWarmup) は Rebuild Thread / Audio Thread が使い始める前、
+    //   つまり MainWindow の生成前に join する。キャッシュ系 (cacheWarmup) は mutex 付きの
+    //   プロセス単一オブジェクトしか触らないため、MainWindow の生成 (デバイス列挙・設定読み込み) とも
+    //   重ねたまま走らせ、shutdown で join する。
+    convo::StartupWarmup libraryWarmup;
+
+    // [v2.1] Intel IPP 初期化 + FFT プランの事前作成
+    // CPU ディスパッチテーブル (SSE2/AVX2/AVX-512 等) を確定させ、
+    // ippsFFTFwd_RToCCS_64f / ippsFFTInv_CCSToR_64f の初回呼び出しによる
+    // 遅延初期化が Audio Thread コールバックに乗ることを防ぐ。
+    //
+    // ■ 安全性:
+    //   - スレッドセーフ（複数回呼び出し可、2回目以降は即時リターン）
+    //   - ippStsNoErr 以外は実機上ほぼ発生しないが、ログで診断可能にする
+    //   - SetImpulse() 内の ippsFFTGetSize_R_64f でも暗黙初期化されるが、
+    //     ここで先に完了させることで SetImpulse() の初回コストも削減される
+    //   - 続けて FFT サイズごとの実装 (IPP / MKL DFTI) を選び (未計測のサイズのみ実測し保存)、
+    //     NUC が使う FFT プランをその実装でプロセス共有キャッシュへ作っておく
+    libraryWarmup.launch("ippInit + FFT backend wisdom + FFT plans", []
+    {
+        const IppStatus ippSt = ippInit();
+        if (ippSt != ippStsNoErr)
+            juce::Logger::writeToLog("[MainApplication] ippInit() returned status="
+                                     + juce::String(static_cast<int>(ippSt)));
+        else
+            juce::Logger::writeToLog("[MainApplication] ippInit() succeeded.");
+
+        convo::FftBackendWisdom::getInstance().calibrate(kPrewarmFftMinOrder, kPrewarmFftMaxOrder);
+        convo::MKLNonUniformConvolver::prewarmFftPlans(kPrewarmFftMinOrder, kPrewarmFftMaxOrder);
+    });
+    libraryWarmup.launch("MKL DFTI", [] { warmUpMklDfti(); });
+
+    cacheWarmup.launch("NUC layout wisdom", [] { convo::NucLayoutWisdom::getInstance().preload(); });
+    cacheWarmup.launch("resampled IR cache index", [] { ResampledIRCache::getInstance().warmIndex(); });
+
+    // ★ DSP カーネルの ISA 解決 (Audio 開始前に 1 回だけ)。NUC の CMAC 選択も同じ結果に揃える
+    {
+        const auto isa = convo::dsp::initialiseKernelDispatch();
+        convo::MKLNonUniformConvolver::setCmacKernel(isa == convo::dsp::KernelIsa::Avx512
+                                                         ? convo::MKLNonUniformConvolver::CmacKernel::Avx512
+                                                         : convo::MKLNonUniformConvolver::CmacKernel::Avx2);
+        juce::Logger::writeToLog("DSP kernel ISA: " + juce::String(convo::dsp::kernelIsaName(isa)));
+    }
 
 #ifdef _WIN32
     // システム全体のタイマー精度を 1ms に上げる
@@ -108,35 +204,6 @@ void MainApplication::initialise(const juce::String& commandLine)
 #endif
 
 
-    // ────────────────────────────────────────────────────────────
-    // Intel MKL リアルタイム設定（B7 対応）
-    //   シングルスレッド固定、動的調整無効、環境変数による強制
-    // ────────────────────────────────────────────────────────────
-    MKLRealTime::setup();
-
-    // [v2.1] Intel IPP 初期化
-    // CPU ディスパッチテーブル (SSE2/AVX2/AVX-512 等) を確定させ、
-    // ippsFFTFwd_RToCCS_64f / ippsFFTInv_CCSToR_64f の初回呼び出しによる
-    // 遅延初期化が Audio Thread コールバックに乗ることを防ぐ。
-    //
-    // ■ 呼び出しタイミングの根拠:
-    //   MKL 設定ブロック直後に配置することで「Audio Thread に触れる前の
-    //   すべてのライブラリ初期化をここに集約する」という既存のコード規約に従う。
-    //
-    // ■ 安全性:
-    //   - スレッドセーフ（複数回呼び出し可、2回目以降は即時リターン）
-    //   - ippStsNoErr 以外は実機上ほぼ発生しないが、ログで診断可能にする
-    //   - SetImpulse() 内の ippsFFTGetSize_R_64f でも暗黙初期化されるが、
-    //     ここで先に完了させることで SetImpulse() の初回コストも削減される
-    {
-        const IppStatus ippSt = ippInit();
-        if (ippSt != ippStsNoErr)
-            juce::Logger::writeToLog("[MainApplication] ippInit() returned status="
-                                     + juce::String(static_cast<int>(ippSt)));
-        else
-            juce::Logger::writeToLog("[MainApplication] ippInit() succeeded.");
-    }
-
     // メインスレッドでも Denormal 対策を有効化
     // UIスレッドで実行されるEQ応答曲線計算 (AVX2) 等のパフォーマンスを向上させる
     _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
@@ -145,8 +212,17 @@ void MainApplication::initialise(const juce::String& commandLine)
     // VMLモード設定（Audio Thread 用、setup() では設定しない）
     vmlSetMode(VML_FTZDAZ_ON | VML_ERRMODE_IGNORE);
 
+    libraryWarmup.waitForAll();
+
+    // CPU 負荷予測の係数。初回起動 (または CPU 交換後) だけ DSP 段の単体計測が走る (1〜2 秒)。
+    // FFT プランと CMAC カーネル選択が実運用と揃うよう libraryWarmup の後で始める。以降は XML を読むだけ
+    cacheWarmup.launch("CPU cost model", [] { convo::CpuCostCalibration::getInstance().ensureCalibrated(); });
+
     // メインウィンドウを生成する
-    mainWindow = std::make_unique<MainWindow>(getApplicationName());
+    {
+        const convo::StartupProfiler::ScopedSpan span("MainWindow construction");
+        mainWindow = std::make_unique<MainWindow>(getApplicationName());
+    }
     mainWindow->showMainWindowAsync();
     mainWindow->runCommandLineAutomation(commandLine);
 
@@ -157,6 +233,7 @@ void MainApplication::initialise(const juce::String& commandLine)
 void MainApplication::shutdown()
 {
     juce::Logger::writeToLog("[DIAG] MainApplication::shutdown() enter");
+    cacheWarmup.waitForAll();
     // unique_ptr のデストラクタで MainWindow が閉じられる
     // MainWindow デストラクタ内で:
     //   1) オーディオコールバック停止
@@ -168,6 +245,7 @@ void MainApplication::shutdown()
     juce::Logger::writeToLog("MainApplication shutting down.");
     juce::Logger::setCurrentLogger(nullptr);
     fileLogger.reset();
+    convo::EtwTrace::unregisterProvider();
 
 #ifdef _WIN32
     timeEndPeriod(1);
@@ -9,6 +9,8 @@
 
 #include <JuceHeader.h>
 
+#include "StartupWarmup.h"
+
 class MainWindow; // フォワード宣言
 
 class MainApplication : public juce::JUCEApplication
@@ -39,4 +41,5 @@ public:
 private:
     std::unique_ptr<MainWindow> mainWindow;
     std::unique_ptr<juce::FileLogger> fileLogger;
+    convo::StartupWarmup cacheWarmup;  // 起動時のキャッシュ索引・wisdom 読み込み (shutdown で join)
 };
@@ -7,6 +7,22 @@
 #include "MainWindow.h"
 #include <cmath>
 #include "audioengine/AtomicAccess.h"
+#include "AlignedAllocation.h"
+#include "DeviceTimingProfiles.h"
+#include "DspNumericPolicy.h"
+#include "FleetMetricsExporter.h"
+#include "LoopbackLatencyTest.h"
+#include "NativeWasapiExclusive.h"
+#include "NoiseShaperLearnerBenchmark.h"
+#include "NoiseShaperOfflineTrainer.h"
+#include "NoiseShaperStateJournal.h"
+#include "OfflineBatchRenderer.h"
+#include "OfflineRenderer.h"
+#include "ScenarioRecorder.h"
+#include "ScenarioReplayer.h"
+#include "StartupProfiler.h"
+#include "audioengine/MemoryLedger.h"
+#include "audioengine/RtSafetyGuard.h"
 
 namespace
 {
@@ -33,6 +49,20 @@ namespace
         return value.trim().toLowerCase().replace(" ", "").replace("_", "").replace("-", "").replace(">", "");
     }
 
+    juce::String formatXrunIncidentFlags(uint32_t flags)
+    {
+        juce::StringArray names;
+        for (size_t bit = 0; bit < convo::XrunIncident::kNumFlags; ++bit)
+            if ((flags & (1u << bit)) != 0)
+                names.add(convo::xrunIncidentFlagName(bit));
+        return names.joinIntoString("|");
+    }
+
+    juce::String formatMegabytes(uint64_t bytes)
+    {
+        return juce::String(static_cast<double>(bytes) / (1024.0 * 1024.0), 1) + " MB";
+    }
+
     bool parseCliPhaseMode(const juce::String& value, ConvolverProcessor::PhaseMode& outMode)
     {
         const auto normalized = normalizeCliValue(value);
@@ -272,16 +302,31 @@ MainWindow::MainWindow (const juce::String& name)
                                        "ASIO4ALL\n");
     }
 
-    asioBlacklist.loadFromFile (blacklistFile);
-    DeviceSettings::applyAsioBlacklist (audioDeviceManager, asioBlacklist);
+    {
+        const convo::StartupProfiler::ScopedSpan span("ASIO blacklist + device types");
+        asioBlacklist.loadFromFile (blacklistFile);
+        DeviceSettings::applyAsioBlacklist (audioDeviceManager, asioBlacklist);
+        // ★ 自前の WASAPI 排他バックエンド。RT スレッドはエンジンと同じ audioRealtime マスクへ固定する
+        audioDeviceManager.addAudioDeviceType (std::make_unique<NativeWasapiExclusiveDeviceType> (&audioEngine.getAffinityManager()));
+    }
 
     // エンジンを先に初期化してデフォルトのサンプルレート(48kHz)を設定
-    audioEngine.initialize();
+    {
+        const convo::StartupProfiler::ScopedSpan span("AudioEngine::initialize");
+        audioEngine.initialize();
+    }
+
+    // ★ 起動の並列化: 分割スペクトルのキャッシュ索引 (前回セッションのファイルの走査とヘッダ読み) を
+    //   デバイスを開いている間に作っておく。索引は CacheManager の mutex の内側で作られ、
+    //   loadSettings から始まる IR 読み込みが先に触れた場合はそちらが待つだけ (二重には走査しない)
+    startupWarmup.launch("convolver cache index", [this] { juce::ignoreUnused(audioEngine.getConvolverCacheStats()); });
 
     audioEngineProcessor = std::make_unique<AudioEngineProcessor>(audioEngine);
     audioProcessorPlayer.setDoublePrecisionProcessing(true);
     audioProcessorPlayer.setProcessor(audioEngineProcessor.get());
     audioEngine.addChangeListener (this);
+    // ★ デバイスの出力フォーマット (整数 ASIO のビット数) をエンジンへ伝える
+    audioDeviceManager.addChangeListener (this);
 
     // ★ [work63] オーディオスレッドが開始される前に、前回の優先度設定を読み込む
     DeviceSettings::preloadThreadPriorityMode(audioEngine);
@@ -296,20 +341,48 @@ MainWindow::MainWindow (const juce::String& name)
             if (safeThis == nullptr)
                 return;
 
-            DeviceSettings::saveSettings(safeThis->audioDeviceManager, safeThis->audioEngine);
+            // 学習中の自動保存はバンクのバイナリだけ (XML の組み立て・書き出しは設定変更時と終了時)
+            DeviceSettings::saveAdaptiveBanks(safeThis->audioEngine);
         });
     });
 
     // 設定読み込み（ブラックリスト適用後に実行することで、除外されたデバイスの自動ロードを防ぐ）
     // この時点でrebuildが呼ばれても、有効なサンプルレートが設定されている
-    loadSettings();
+    {
+        const convo::StartupProfiler::ScopedSpan span("loadSettings (device enumeration + open)");
+        loadSettings();
+    }
 
     // UIコンポーネントの作成
-    createUIComponents();
+    {
+        const convo::StartupProfiler::ScopedSpan span("createUIComponents");
+        createUIComponents();
+    }
 
+    deviceTimingProfiles = std::make_unique<DeviceTimingProfiles>();
     startTimer (500); // CPU使用率の更新頻度を上げる (500ms)
 }
 
+void MainWindow::pollStartupProfile()
+{
+    // IR 読み込みが長い場合でも打ち切って出力する (settledMs=-1)
+    constexpr double kStartupProfileTimeoutMs = 60000.0;
+    constexpr int kStartupProfilePollMs = 5;
+
+    const bool settled = convo::StartupProfiler::hasFirstAudioCallback() && audioEngine.isRuntimeSettled();
+    if (settled || convo::StartupProfiler::getElapsedMs() > kStartupProfileTimeoutMs)
+    {
+        convo::StartupProfiler::report(settled);
+        return;
+    }
+
+    juce::Timer::callAfterDelay(kStartupProfilePollMs, [safeThis = juce::Component::SafePointer<MainWindow>(this)]
+    {
+        if (safeThis != nullptr)
+            safeThis->pollStartupProfile();
+    });
+}
+
 void MainWindow::showMainWindowAsync()
 {
     juce::Component::SafePointer<MainWindow> safeThis(this);
@@ -319,6 +392,7 @@ void MainWindow::showMainWindowAsync()
             return;
 
         safeThis->setVisible(true);
+        convo::StartupProfiler::mark("main window visible");
 
        #if JUCE_WINDOWS && JUCE_DEBUG
         forceSoftwareRendererIfAvailable(*safeThis);
@@ -397,7 +471,13 @@ void MainWindow::runCommandLineAutomation(const juce::String& commandLine)
         || !findValue("--cli-learning-action").isEmpty()
         || !findValue("--cli-learning-mode").isEmpty()
         || !findValue("--cli-exit-ms").isEmpty()
-        || !findValue("--cli-log-file").isEmpty();
+        || !findValue("--cli-log-file").isEmpty()
+        || !findValue("--cli-learn-offline").isEmpty()
+        || !findValue("--cli-learn-benchmark").isEmpty()
+        || !findValue("--cli-render").isEmpty()
+        || !findValue("--cli-render-batch").isEmpty()
+        || !findValue("--cli-replay").isEmpty()
+        || hasFlag("--cli-latency-test");
 
     // ★ v14.47: --cli-log-file <path> — 診断ログをファイルに出力
     if (const auto logFileValue = findValue("--cli-log-file"); !logFileValue.isEmpty())
@@ -408,6 +488,74 @@ void MainWindow::runCommandLineAutomation(const juce::String& commandLine)
         juce::Logger::writeToLog("[CLI] Log file: " + logFile.getFullPathName());
     }
 
+    // ★ --cli-startup-profile — 最初のデバイスコールバックとランタイムの安定を待って起動タイムラインを出す。
+    //   記録は MainApplication::initialise の先頭で始まっている。通常起動をそのまま測るため、
+    //   このフラグだけでは自動化モード (テレメトリ・Progressive Upgrade 無効化) に入らない
+    if (hasFlag("--cli-startup-profile") && convo::StartupProfiler::isEnabled())
+        pollStartupProfile();
+
+    // ★ --cli-record-scenario <file> — 通常の操作を --cli-replay で再生できるシナリオとして記録する (終了時に閉じる)。
+    //   操作をそのまま記録するため、このフラグだけでは自動化モードに入らない
+    if (const auto scenarioValue = findValue("--cli-record-scenario"); !scenarioValue.isEmpty())
+    {
+        const auto scenarioFile = juce::File::isAbsolutePath(scenarioValue)
+            ? juce::File(scenarioValue)
+            : juce::File::getCurrentWorkingDirectory().getChildFile(scenarioValue);
+        scenarioRecorder = std::make_unique<ScenarioRecorder>(audioEngine);
+        if (!scenarioRecorder->start(scenarioFile))
+            scenarioRecorder.reset();
+    }
+
+    // ★ --metrics-udp <port> / --metrics-pipe <name> — 無人運用の監視用に観測値を定期的にローカルへ送る。
+    //   送るだけなので、このフラグだけでは自動化モードに入らない
+    {
+        FleetMetricsExporter::Options metricsOptions;
+        const auto udpValue = findValue("--metrics-udp");
+        const auto pipeValue = findValue("--metrics-pipe");
+        if (udpValue.isNotEmpty())
+        {
+            metricsOptions.udpPort = udpValue.getIntValue();
+        }
+        else
+        {
+            metricsOptions.transport = FleetMetricsExporter::Transport::NamedPipe;
+            metricsOptions.pipeName = pipeValue;
+        }
+        if (findValue("--metrics-format").equalsIgnoreCase("json"))
+            metricsOptions.format = convo::FleetMetricsFormat::Json;
+        if (const auto intervalValue = findValue("--metrics-interval-ms"); intervalValue.isNotEmpty())
+            metricsOptions.intervalMs = intervalValue.getIntValue();
+
+        if (udpValue.isNotEmpty() || pipeValue.isNotEmpty())
+        {
+            metricsExporter = std::make_unique<FleetMetricsExporter>(std::move(metricsOptions));
+            if (!metricsExporter->start())
+                metricsExporter.reset();
+        }
+    }
+
+    // ★ --internal-rate <hz> [--internal-rate-linear-phase] — DSP を hz 固定で回し、デバイスとの間を SRC でつなぐ
+    //   (0 で無効)。設定として保存され、開いているデバイスは開き直して反映する。自動化モードには入らない
+    if (const auto internalRateValue = findValue("--internal-rate"); internalRateValue.isNotEmpty())
+    {
+        int internalRateHz = 0;
+        if (tryParseIntOption(internalRateValue, internalRateHz) && internalRateHz >= 0)
+        {
+            audioEngine.setFixedInternalSampleRate(internalRateHz, !hasFlag("--internal-rate-linear-phase"));
+            juce::Logger::writeToLog("[CLI] internal rate=" + juce::String(audioEngine.getFixedInternalSampleRate())
+                                     + (audioEngine.isFixedInternalRateMinimumPhase() ? " minPhase" : " linearPhase"));
+            if (audioDeviceManager.getCurrentAudioDevice() != nullptr)
+            {
+                audioDeviceManager.closeAudioDevice();
+                audioDeviceManager.restartLastAudioDevice();
+            }
+        }
+        else
+        {
+            juce::Logger::writeToLog("[CLI] --internal-rate: invalid value '" + internalRateValue + "'");
+        }
+    }
+
     if (!hasAutomationFlags)
     {
         cliAutomationTelemetryLoggingEnabled = false;
@@ -774,6 +922,354 @@ void MainWindow::runCommandLineAutomation(const juce::String& commandLine)
         }
     }
 
+    // --cli-learn-offline <dir> — dir 以下の音声で全 180 バンクを実時間より速く学習し、完了後に終了する
+    if (const auto offlineValue = findValue("--cli-learn-offline"); !offlineValue.isEmpty())
+    {
+        const auto corpusDirectory = juce::File::isAbsolutePath(offlineValue)
+            ? juce::File(offlineValue)
+            : juce::File::getCurrentWorkingDirectory().getChildFile(offlineValue);
+
+        if (!corpusDirectory.isDirectory())
+        {
+            juce::Logger::writeToLog("[CLI] Invalid --cli-learn-offline directory: " + corpusDirectory.getFullPathName());
+        }
+        else if (offlineTrainer != nullptr && offlineTrainer->isThreadRunning())
+        {
+            juce::Logger::writeToLog("[CLI] Offline learning already running");
+        }
+        else
+        {
+            juce::Logger::writeToLog("[CLI] Offline learning: " + corpusDirectory.getFullPathName());
+            offlineTrainer = std::make_unique<NoiseShaperOfflineTrainer>(
+                audioEngine,
+                corpusDirectory,
+                [safeThis = juce::Component::SafePointer<MainWindow>(this)](bool allBanksCompleted)
+                {
+                    juce::Logger::writeToLog("[CLI] Offline learning finished: allBanksCompleted="
+                                             + juce::String(static_cast<int>(allBanksCompleted)));
+                    juce::Logger::setCurrentLogger(nullptr);
+
+                    if (safeThis != nullptr)
+                    {
+                        convo::publishAtomic(safeThis->cliAutomationCallbacksEnabled, false, std::memory_order_release);
+                        safeThis->cliAutomationTelemetryLoggingEnabled = false;
+                        safeThis->audioEngine.setCliProcessingTelemetryEnabled(false);
+                    }
+
+                    if (auto* app = juce::JUCEApplication::getInstance())
+                        app->systemRequestedQuit();
+                });
+            offlineTrainer->startThread(juce::Thread::Priority::normal);
+        }
+    }
+
+    // --cli-learn-benchmark <dir|synthetic> — 固定コーパス・固定シード・固定ワーカー数で学習器の収束速度を測り、
+    // JSON (--cli-learn-benchmark-out <path>、省略時は標準出力) を書いて終了する
+    if (const auto benchmarkValue = findValue("--cli-learn-benchmark"); !benchmarkValue.isEmpty())
+    {
+        NoiseShaperLearnerBenchmark::Options benchmarkOptions;
+        if (normalizeCliValue(benchmarkValue) != "synthetic")
+            benchmarkOptions.corpusDirectory = juce::File::isAbsolutePath(benchmarkValue)
+                ? juce::File(benchmarkValue)
+                : juce::File::getCurrentWorkingDirectory().getChildFile(benchmarkValue);
+
+        if (const auto value = findValue("--cli-learn-benchmark-workers"); !value.isEmpty())
+            benchmarkOptions.evaluationWorkerCount = value.getIntValue();
+        if (const auto value = findValue("--cli-learn-benchmark-repeats"); !value.isEmpty())
+            benchmarkOptions.repeats = value.getIntValue();
+        if (const auto value = findValue("--cli-learn-benchmark-sample-rate-hz"); !value.isEmpty())
+            benchmarkOptions.sampleRateHz = value.getDoubleValue();
+        if (const auto value = findValue("--cli-learn-benchmark-bit-depth"); !value.isEmpty())
+            benchmarkOptions.bitDepth = value.getIntValue();
+        if (const auto value = findValue("--cli-learn-benchmark-seed"); !value.isEmpty())
+            benchmarkOptions.seed = value.startsWithIgnoreCase("0x")
+                ? static_cast<std::uint64_t>(value.substring(2).getHexValue64())
+                : static_cast<std::uint64_t>(value.getLargeIntValue());
+        if (const auto value = findValue("--cli-learn-benchmark-mode"); !value.isEmpty()
+            && !parseCliLearningMode(value, benchmarkOptions.mode))
+            juce::Logger::writeToLog("[CLI] Unknown --cli-learn-benchmark-mode value: " + value);
+        if (const auto value = findValue("--cli-learn-benchmark-target-scores"); !value.isEmpty())
+        {
+            for (const auto& token : juce::StringArray::fromTokens(value, ",", ""))
+                if (token.trim().isNotEmpty())
+                    benchmarkOptions.targetScores.push_back(token.trim().getDoubleValue());
+        }
+        if (const auto value = findValue("--cli-learn-benchmark-out"); !value.isEmpty())
+            benchmarkOptions.outputFile = juce::File::isAbsolutePath(value)
+                ? juce::File(value)
+                : juce::File::getCurrentWorkingDirectory().getChildFile(value);
+
+        const bool validSampleRate = benchmarkOptions.sampleRateHz > 0.0
+            && convo::numeric_policy::isFinite(benchmarkOptions.sampleRateHz);
+        if (benchmarkOptions.corpusDirectory != juce::File() && !benchmarkOptions.corpusDirectory.isDirectory())
+        {
+            juce::Logger::writeToLog("[CLI] Invalid --cli-learn-benchmark directory: " + benchmarkOptions.corpusDirectory.getFullPathName());
+        }
+        else if (!validSampleRate)
+        {
+            juce::Logger::writeToLog("[CLI] Invalid --cli-learn-benchmark-sample-rate-hz");
+        }
+        else if ((learnerBenchmark != nullptr && learnerBenchmark->isThreadRunning())
+                 || (offlineTrainer != nullptr && offlineTrainer->isThreadRunning()))
+        {
+            juce::Logger::writeToLog("[CLI] Offline learning or benchmark already running");
+        }
+        else
+        {
+            juce::Logger::writeToLog("[CLI] Learner benchmark: "
+                                     + (benchmarkOptions.corpusDirectory == juce::File() ? juce::String("synthetic")
+                                                                                         : benchmarkOptions.corpusDirectory.getFullPathName()));
+            learnerBenchmark = std::make_unique<NoiseShaperLearnerBenchmark>(
+                audioEngine,
+                std::move(benchmarkOptions),
+                [safeThis = juce::Component::SafePointer<MainWindow>(this)](bool succeeded)
+                {
+                    juce::Logger::writeToLog("[CLI] Learner benchmark finished: succeeded="
+                                             + juce::String(static_cast<int>(succeeded)));
+                    juce::Logger::setCurrentLogger(nullptr);
+
+                    if (safeThis != nullptr)
+                    {
+                        convo::publishAtomic(safeThis->cliAutomationCallbacksEnabled, false, std::memory_order_release);
+                        safeThis->cliAutomationTelemetryLoggingEnabled = false;
+                        safeThis->audioEngine.setCliProcessingTelemetryEnabled(false);
+                    }
+
+                    if (auto* app = juce::JUCEApplication::getInstance())
+                        app->systemRequestedQuit();
+                });
+            learnerBenchmark->startThread(juce::Thread::Priority::normal);
+        }
+    }
+
+    // --cli-render <in> <out> — デバイスを外し、in を現在の設定と IR で処理して out へ書き出して終了する
+    //   (デバイス待ち無しで回すので実時間より速い。--cli-render-block <samples> / --cli-render-bit-depth <bits>)
+    // --cli-render-batch <listfile> — リストの全ファイルを物理コアごとのワーカーで並列に書き出して終了する
+    //   (ブロック長・ビット深度は --cli-render と共通。--cli-render-batch-workers <n> で並列数を指定)
+    bool offlineRenderRequested = false;
+    const auto resolveRenderFile = [](const juce::String& value)
+    {
+        return juce::File::isAbsolutePath(value) ? juce::File(value)
+                                                 : juce::File::getCurrentWorkingDirectory().getChildFile(value);
+    };
+    int renderBlockSize = OfflineRenderer::Options{}.blockSize;
+    int renderBitDepth = 0;
+    if (const auto value = findValue("--cli-render-block"); !value.isEmpty())
+    {
+        int parsedBlock = 0;
+        if (tryParseIntOption(value, parsedBlock))
+            renderBlockSize = parsedBlock;
+    }
+    if (const auto value = findValue("--cli-render-bit-depth"); !value.isEmpty())
+    {
+        int parsedBits = 0;
+        if (tryParseIntOption(value, parsedBits))
+            renderBitDepth = parsedBits;
+    }
+
+    const auto finishOfflineRender = [safeThis = juce::Component::SafePointer<MainWindow>(this)](bool succeeded)
+    {
+        juce::Logger::writeToLog("[CLI] Offline render finished: succeeded="
+                                 + juce::String(static_cast<int>(succeeded)));
+        juce::Logger::setCurrentLogger(nullptr);
+
+        if (safeThis != nullptr)
+        {
+            convo::publishAtomic(safeThis->cliAutomationCallbacksEnabled, false, std::memory_order_release);
+            safeThis->cliAutomationTelemetryLoggingEnabled = false;
+            safeThis->audioEngine.setCliProcessingTelemetryEnabled(false);
+            if (safeThis->audioEngine.isEnginePrepared())
+                safeThis->audioEngine.releaseResources();
+        }
+
+        if (auto* app = juce::JUCEApplication::getInstance())
+            app->systemRequestedQuit();
+    };
+
+    if (const int renderIndex = tokens.indexOf("--cli-render", true); renderIndex >= 0)
+    {
+        OfflineRenderer::Options renderOptions;
+        if (renderIndex + 2 < tokens.size())
+        {
+            renderOptions.inputFile = resolveRenderFile(tokens[renderIndex + 1]);
+            renderOptions.outputFile = resolveRenderFile(tokens[renderIndex + 2]);
+        }
+        renderOptions.blockSize = renderBlockSize;
+        renderOptions.bitDepth = renderBitDepth;
+
+        if (renderOptions.inputFile == juce::File() || renderOptions.outputFile == juce::File())
+        {
+            juce::Logger::writeToLog("[CLI] --cli-render requires <in> <out>");
+        }
+        else if (!renderOptions.inputFile.existsAsFile())
+        {
+            juce::Logger::writeToLog("[CLI] --cli-render input not found: " + renderOptions.inputFile.getFullPathName());
+        }
+        else if (offlineRenderer != nullptr && offlineRenderer->isThreadRunning())
+        {
+            juce::Logger::writeToLog("[CLI] Offline render already running");
+        }
+        else
+        {
+            juce::Logger::writeToLog("[CLI] Offline render: " + renderOptions.inputFile.getFullPathName()
+                                     + " -> " + renderOptions.outputFile.getFullPathName());
+
+            // レンダースレッドが Audio Thread の代わりになるので、デバイスからは処理を呼ばせない
+            audioDeviceManager.removeAudioCallback(&audioProcessorPlayer);
+            offlineRenderer = std::make_unique<OfflineRenderer>(audioEngine, std::move(renderOptions), finishOfflineRender);
+            if (offlineRenderer->prepare())
+            {
+                offlineRenderRequested = true;
+                offlineRenderer->startThread(juce::Thread::Priority::high);
+            }
+            else
+            {
+                offlineRenderer.reset();
+                finishOfflineRender(false);
+            }
+        }
+    }
+
+    if (const auto listValue = findValue("--cli-render-batch"); !listValue.isEmpty())
+    {
+        OfflineBatchRenderer::Options batchOptions;
+        batchOptions.listFile = resolveRenderFile(listValue);
+        batchOptions.blockSize = renderBlockSize;
+        batchOptions.bitDepth = renderBitDepth;
+        if (const auto value = findValue("--cli-render-batch-workers"); !value.isEmpty())
+        {
+            int parsedWorkers = 0;
+            if (tryParseIntOption(value, parsedWorkers))
+                batchOptions.numWorkers = parsedWorkers;
+        }
+
+        if (offlineRenderRequested)
+        {
+            juce::Logger::writeToLog("[CLI] --cli-render-batch ignored: --cli-render is already running");
+        }
+        else if (offlineBatchRenderer != nullptr && offlineBatchRenderer->isThreadRunning())
+        {
+            juce::Logger::writeToLog("[CLI] Offline batch render already running");
+        }
+        else
+        {
+            juce::Logger::writeToLog("[CLI] Offline batch render: " + batchOptions.listFile.getFullPathName());
+
+            audioDeviceManager.removeAudioCallback(&audioProcessorPlayer);
+            offlineBatchRenderer = std::make_unique<OfflineBatchRenderer>(audioEngine, std::move(batchOptions), finishOfflineRender);
+            if (offlineBatchRenderer->prepare())
+            {
+                offlineRenderRequested = true;
+                offlineBatchRenderer->startThread(juce::Thread::Priority::high);
+            }
+            else
+            {
+                offlineBatchRenderer.reset();
+                finishOfflineRender(false);
+            }
+        }
+    }
+
+    // --cli-replay <scenario> <in> — デバイスを外し、in を繰り返し流しながらシナリオの操作を時刻どおりに適用して終了する
+    //   (PGO の学習用負荷・ベンチマークの再現負荷。既定は実時間、--cli-replay-fast で待ち無し。ブロック長は --cli-render-block)
+    if (const int replayIndex = tokens.indexOf("--cli-replay", true); replayIndex >= 0)
+    {
+        ScenarioReplayer::Options replayOptions;
+        if (replayIndex + 2 < tokens.size())
+        {
+            replayOptions.scenarioFile = resolveRenderFile(tokens[replayIndex + 1]);
+            replayOptions.inputFile = resolveRenderFile(tokens[replayIndex + 2]);
+        }
+        replayOptions.blockSize = renderBlockSize;
+        replayOptions.realtime = !hasFlag("--cli-replay-fast");
+
+        if (offlineRenderRequested)
+        {
+            juce::Logger::writeToLog("[CLI] --cli-replay ignored: an offline render is already running");
+        }
+        else if (!replayOptions.scenarioFile.existsAsFile() || !replayOptions.inputFile.existsAsFile())
+        {
+            juce::Logger::writeToLog("[CLI] --cli-replay requires <scenario> <in> (existing files)");
+        }
+        else
+        {
+            juce::Logger::writeToLog("[CLI] Scenario replay: " + replayOptions.scenarioFile.getFullPathName()
+                                     + " with " + replayOptions.inputFile.getFullPathName());
+
+            audioDeviceManager.removeAudioCallback(&audioProcessorPlayer);
+            scenarioReplayer = std::make_unique<ScenarioReplayer>(audioEngine, std::move(replayOptions), finishOfflineRender);
+            if (scenarioReplayer->prepare())
+            {
+                offlineRenderRequested = true;
+                scenarioReplayer->startThread(juce::Thread::Priority::high);
+            }
+            else
+            {
+                scenarioReplayer.reset();
+                finishOfflineRender(false);
+            }
+        }
+    }
+
+    // --cli-latency-test — 出力を入力へループバックした状態で往復遅延 (ハードウェア分・エンジン分) を実測して終了する
+    //   (--cli-latency-input-channel <n> で録る入力、--cli-latency-sweep で glitch-free な最小バッファ長も探す。
+    //    1 段の時間は --cli-latency-sweep-seconds <s>。結果はデバイス設定ごとの記録にも残る)
+    if (hasFlag("--cli-latency-test"))
+    {
+        LoopbackLatencyTest::Options latencyOptions;
+        if (const auto value = findValue("--cli-latency-input-channel"); !value.isEmpty())
+        {
+            int parsedChannel = 0;
+            if (tryParseIntOption(value, parsedChannel))
+                latencyOptions.inputChannel = parsedChannel;
+        }
+        latencyOptions.sweep = hasFlag("--cli-latency-sweep");
+        if (const auto value = findValue("--cli-latency-sweep-seconds"); !value.isEmpty())
+        {
+            int parsedSeconds = 0;
+            if (tryParseIntOption(value, parsedSeconds) && parsedSeconds > 0)
+                latencyOptions.sweepSecondsPerStep = static_cast<double>(parsedSeconds);
+        }
+
+        if (offlineRenderRequested)
+        {
+            juce::Logger::writeToLog("[CLI] --cli-latency-test ignored: an offline render is already running");
+        }
+        else
+        {
+            const auto finishLatencyTest = [safeThis = juce::Component::SafePointer<MainWindow>(this), finishOfflineRender]
+                                           (const LoopbackLatencyTest::Result& result)
+            {
+                if (safeThis != nullptr)
+                {
+                    if (auto* device = safeThis->audioDeviceManager.getCurrentAudioDevice())
+                    {
+                        if (result.succeeded)
+                            safeThis->deviceTimingProfiles->noteLoopbackLatency(*device, result.total.medianSamples,
+                                                                                result.reportedDeviceLatencySamples
+                                                                                    + result.predictedEngineLatencySamples);
+                        for (const auto& step : result.sweepSteps)
+                            safeThis->deviceTimingProfiles->noteBufferSweep(*device, step);
+                    }
+                }
+                finishOfflineRender(result.succeeded);
+            };
+
+            // テストがデバイスのコールバックになり、信号の生成とエンジンの呼び出しを自分で行う
+            audioDeviceManager.removeAudioCallback(&audioProcessorPlayer);
+            latencyTest = std::make_unique<LoopbackLatencyTest>(audioEngine, audioDeviceManager, latencyOptions, finishLatencyTest);
+            if (latencyTest->start())
+            {
+                offlineRenderRequested = true;
+            }
+            else
+            {
+                latencyTest.reset();
+                finishOfflineRender(false);
+            }
+        }
+    }
+
     if (const auto irValue = findValue("--cli-ir"); !irValue.isEmpty())
     {
         juce::File irFile;
@@ -784,8 +1280,8 @@ void MainWindow::runCommandLineAutomation(const juce::String& commandLine)
 
         if (irFile.existsAsFile())
         {
-            // Defer IR load to allow audio device to stabilize first
-            const int irLoadDelayMs = 200;
+            // Defer IR load to allow audio device to stabilize first (no device to wait for when rendering offline)
+            const int irLoadDelayMs = offlineRenderRequested ? 0 : 200;
             juce::Logger::writeToLog("[CLI] Deferred IR load: " + irFile.getFullPathName()
                                      + " (delayMs=" + juce::String(irLoadDelayMs) + ")");
             juce::Timer::callAfterDelay(irLoadDelayMs, [safeThis = juce::Component::SafePointer<MainWindow>(this), irFile]
@@ -1123,8 +1619,20 @@ MainWindow::~MainWindow()
     //       UIコンポーネント (specAnalyzer / eqPanel 等) にアクセスする
     //       Use-After-Free が発生する。最初に removeChangeListener することで
     //       このウィンドウへの通知を即座に遮断し、安全にシャットダウンできる。
+    // オフライン学習 / ベンチマークスレッドは audioEngine のバンクと学習器を使うため最初に止める
+    offlineTrainer.reset();
+    learnerBenchmark.reset();
+    offlineRenderer.reset();
+    offlineBatchRenderer.reset();
+    scenarioReplayer.reset();
+    latencyTest.reset();
+    scenarioRecorder.reset();
+    deviceTimingProfiles.reset();  // 最後の差分を保存する
+    metricsExporter.reset();
+
     juce::Logger::writeToLog("[DIAG] ~MainWindow: step 1 removeChangeListener");
     audioEngine.removeChangeListener (this);
+    audioDeviceManager.removeChangeListener (this);
     juce::Logger::writeToLog("[DIAG] ~MainWindow: step 2 setAdaptiveAutosaveCallback");
     audioEngine.setAdaptiveAutosaveCallback({});
     juce::Logger::writeToLog("[DIAG] ~MainWindow: step 3 setCliProcessingTelemetryEnabled");
@@ -1138,6 +1646,8 @@ MainWindow::~MainWindow()
 
     juce::Logger::writeToLog("[DIAG] ~MainWindow: step 6 saveSettings");
     DeviceSettings::saveSettings (audioDeviceManager, audioEngine);
+    // 学習状態ジャーナルの未書き込み分 (保存成功時は破棄要求) を書き切ってからスレッドを止める
+    convo::NoiseShaperStateJournal::getInstance().shutdown();
 
     juce::Logger::writeToLog("[DIAG] ~MainWindow: step 7 removeAudioCallback");
     // 破棄される前にコールバックとしてAudioEngineの登録を解除
@@ -1209,6 +1719,14 @@ void MainWindow::changeListenerCallback (juce::ChangeBroadcaster* source)
         DBG("[DIAG] MainWindow::changeListenerCallback leave (audioEngine)");
         juce::Logger::writeToLog("[DIAG] MainWindow::changeListenerCallback leave (audioEngine)");
     }
+    else if (source == &audioDeviceManager)
+    {
+        // 整数 ASIO ドライバはディザの LSB 位置を保つために出力段のゲイン補正が要る (DeviceOutputCodec.h)
+        auto* device = audioDeviceManager.getCurrentAudioDevice();
+        const bool isAsio = (device != nullptr && device->getTypeName() == "ASIO");
+        audioEngine.setDeviceIntegerOutputBits(
+            convo::output::deviceIntegerBitsFor(isAsio, device != nullptr ? device->getCurrentBitDepth() : 0));
+    }
 }
 
 void MainWindow::labelTextChanged(juce::Label* label)
@@ -1297,12 +1815,34 @@ void MainWindow::createUIComponents()
     };
     juce::Component::addAndMakeVisible (loadButton);
 
+    // A/B 比較ボタン: 2 つの設定を構築済みのまま常駐させ、rebuild なしで切り替える
+    abSlotAButton.setButtonText ("A");
+    abSlotAButton.setTooltip ("Compare: switch to setting A (kept resident, no rebuild)");
+    abSlotAButton.onClick = [this] { selectABSlot (convo::ABSlot::A); };
+    juce::Component::addAndMakeVisible (abSlotAButton);
+
+    abSlotBButton.setButtonText ("B");
+    abSlotBButton.setTooltip ("Compare: switch to setting B (kept resident, no rebuild)");
+    abSlotBButton.onClick = [this] { selectABSlot (convo::ABSlot::B); };
+    juce::Component::addAndMakeVisible (abSlotBButton);
+
+    abResidentLabel.setText ("A/B: --", juce::dontSendNotification);
+    abResidentLabel.setJustificationType (juce::Justification::centredLeft);
+    abResidentLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+    abResidentLabel.setTooltip ("Memory held by the standby A/B setting");
+    juce::Component::addAndMakeVisible (abResidentLabel);
+
     // CPU使用率ラベル
     cpuUsageLabel.setText ("CPU: --%", juce::dontSendNotification);
     cpuUsageLabel.setJustificationType (juce::Justification::centredRight);
     cpuUsageLabel.setColour (juce::Label::textColourId, juce::Colours::white);
     juce::Component::addAndMakeVisible (cpuUsageLabel);
 
+    memoryLabel.setText ("Mem: --", juce::dontSendNotification);
+    memoryLabel.setJustificationType (juce::Justification::centredRight);
+    memoryLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+    juce::Component::addAndMakeVisible (memoryLabel);
+
     latencyLabel.setText ("Lat: -- ms", juce::dontSendNotification);
     latencyLabel.setJustificationType (juce::Justification::centredRight);
     latencyLabel.setColour (juce::Label::textColourId, juce::Colours::white);
@@ -1467,6 +2007,7 @@ void MainWindow::resized()
     // 状態表示
     cpuUsageLabel.setBounds (buttonRow.removeFromRight (95).reduced (2, 2));
     latencyLabel.setBounds (buttonRow.removeFromRight (170).reduced (2, 2));
+    memoryLabel.setBounds (buttonRow.removeFromRight (100).reduced (2, 2));
 
     // クリップ制御 (左→右: Soft Clip, Sat, 数値入力)
     saturationValueLabel.setBounds(buttonRow.removeFromRight(58).reduced(2, 2));
@@ -1478,6 +2019,11 @@ void MainWindow::resized()
     loadButton.setBounds (buttonRow.removeFromRight (46).reduced (2, 2));
     saveButton.setBounds (buttonRow.removeFromRight (46).reduced (2, 2));
 
+    // A/B 比較
+    abResidentLabel.setBounds (buttonRow.removeFromRight (110).reduced (2, 2));
+    abSlotBButton.setBounds (buttonRow.removeFromRight (28).reduced (2, 2));
+    abSlotAButton.setBounds (buttonRow.removeFromRight (28).reduced (2, 2));
+
     if (convolverPanel)
         convolverPanel->setBounds (bounds.removeFromTop (320));
 
@@ -1497,6 +2043,141 @@ void MainWindow::timerCallback()
     double cpu = audioDeviceManager.getCpuUsage() * 100.0;
     cpuUsageLabel.setText ("CPU: " + juce::String (cpu, 1) + "%", juce::dontSendNotification);
 
+    // ★ 段別処理時間: CPU 平均では見えない段ごとのテール (p99 / p99.9) をツールチップと CLI ログに出す
+    const auto stageLatency = audioEngine.consumeStageLatencyReport();
+    juce::String stageTooltip;
+    if (stageLatency.clockCalibrated)
+    {
+        for (size_t i = 0; i < convo::kNumDspStages; ++i)
+        {
+            const auto& s = stageLatency.stages[i];
+            if (s.samples == 0)
+                continue;
+            stageTooltip << convo::dspStageName (static_cast<convo::DspStage> (i))
+                         << ": p50 " << juce::String (s.p50Us, 1) << " / p99 " << juce::String (s.p99Us, 1)
+                         << " / p99.9 " << juce::String (s.p999Us, 1) << " / max " << juce::String (s.maxUs, 1) << " us\n";
+        }
+    }
+
+    // ★ xrun 原因相関: 直近 incident のフラグ別件数と最後の 1 件をツールチップへ
+    const auto xrunReport = audioEngine.getXrunIncidentReport();
+    if (xrunReport.count > 0)
+    {
+        stageTooltip << "xruns: " << juce::String (static_cast<juce::int64> (xrunReport.totalIncidents))
+                     << " (last " << juce::String (static_cast<int> (xrunReport.count)) << ":";
+        for (size_t bit = 0; bit < convo::XrunIncident::kNumFlags; ++bit)
+            if (xrunReport.flagCounts[bit] > 0)
+                stageTooltip << " " << convo::xrunIncidentFlagName (bit) << " " << juce::String (xrunReport.flagCounts[bit]);
+        stageTooltip << ")\n";
+
+        const auto& last = xrunReport.incidents[xrunReport.count - 1];
+        const auto dominant = last.dominantStage();
+        stageTooltip << "last xrun: " << juce::String (last.callbackUs) << " / " << juce::String (last.expectedUs) << " us"
+                     << " [" << formatXrunIncidentFlags (last.flags) << "]"
+                     << (dominant != convo::DspStage::Count ? juce::String (" dominant ") + convo::dspStageName (dominant)
+                                                           : juce::String())
+                     << "\n";
+    }
+
+    // ★ --rt-guard: Audio Thread で起きた確保・ロックを 1 件 1 行で出し、件数をツールチップへ
+    if (convo::RtSafetyGuard::isEnabled())
+    {
+        convo::RtViolation violation;
+        while (convo::RtSafetyGuard::pop (violation))
+        {
+            juce::Logger::writeToLog (
+                juce::String ("[RT_GUARD] kind=") + convo::rtViolationKindName (violation.kind)
+                + " stage=" + (violation.stage != convo::DspStage::Count ? convo::dspStageName (violation.stage) : "outside")
+                + " bytes=" + juce::String (static_cast<juce::int64> (violation.bytes))
+                + " stack=0x" + juce::String::toHexString (static_cast<juce::int64> (violation.stackHash))
+                + " cb=" + juce::String (static_cast<juce::int64> (violation.callbackIndex)));
+        }
+
+        const auto rtGuard = convo::RtSafetyGuard::counters();
+        stageTooltip << "rt-guard violations: " << juce::String (static_cast<juce::int64> (rtGuard.total));
+        for (size_t k = 0; k < convo::kNumRtViolationKinds; ++k)
+            if (rtGuard.byKind[k] > 0)
+                stageTooltip << " " << convo::rtViolationKindName (static_cast<convo::RtViolationKind> (k))
+                             << " " << juce::String (static_cast<juce::int64> (rtGuard.byKind[k]));
+        if (rtGuard.dropped > 0)
+            stageTooltip << " (dropped " << juce::String (static_cast<juce::int64> (rtGuard.dropped)) << ")";
+        stageTooltip << "\n";
+    }
+
+    // ★ デバイス設定ごとの到着ジッター・締め切りまでの余裕を積み、安定が確かめられた最小のバッファ長を出す。
+    //   オフラインレンダー中の processBlockDouble はデバイスのコールバックではないので差分を捨てる
+    auto* currentDevice = audioDeviceManager.getCurrentAudioDevice();
+    convo::CallbackTimingHistograms::Snapshot callbackTiming;
+    {
+        const bool offlineActive = (offlineRenderer != nullptr && offlineRenderer->isThreadRunning())
+                                || (offlineBatchRenderer != nullptr && offlineBatchRenderer->isThreadRunning())
+                                || (scenarioReplayer != nullptr && scenarioReplayer->isThreadRunning());
+        // --cli-latency-test はデバイスのコールバックなので記録は続けるが、バッファ長はテスト側が動かす
+        const bool latencyTestActive = latencyTest != nullptr && latencyTest->isRunning();
+        audioEngine.collectCallbackTiming (callbackTiming);
+        deviceTimingProfiles->update (offlineActive ? nullptr : currentDevice, callbackTiming);
+        serviceAdaptiveBufferSize ((offlineActive || latencyTestActive || cliAudioSetupRequested) ? nullptr : currentDevice,
+                                   callbackTiming);
+    }
+    const auto deviceTiming = deviceTimingProfiles->summarize (currentDevice);
+    if (deviceTiming.valid)
+        stageTooltip << "arrival jitter: p99 " << juce::String (static_cast<juce::int64> (deviceTiming.jitterP99Us))
+                     << " / p99.9 " << juce::String (static_cast<juce::int64> (deviceTiming.jitterP999Us))
+                     << " us, slack p1 " << juce::String (deviceTiming.slackP01Us, 0) << " us ("
+                     << convo::callbackTimingVerdictName (deviceTiming.verdict) << ", "
+                     << juce::String (deviceTiming.observedSeconds / 60.0, 1) << " min)\n";
+    if (deviceTiming.recommendation.verifiedSamples > 0)
+    {
+        stageTooltip << "buffer: stable at " << juce::String (deviceTiming.recommendation.verifiedSamples) << " samples";
+        if (deviceTiming.recommendation.suggestedSamples > 0)
+            stageTooltip << ", try " << juce::String (deviceTiming.recommendation.suggestedSamples);
+        stageTooltip << "\n";
+    }
+    if (deviceTiming.loopbackMeasuredSamples > 0)
+        stageTooltip << "loopback: measured " << juce::String (deviceTiming.loopbackMeasuredSamples)
+                     << " / predicted " << juce::String (deviceTiming.loopbackPredictedSamples) << " samples\n";
+    if (adaptiveBufferAppliedSize > 0)
+        stageTooltip << "buffer: adaptive " << juce::String (adaptiveBufferAppliedSize) << " samples (selected "
+                     << juce::String (bufferSizeGovernor.getBaseSize()) << ")\n";
+    cpuUsageLabel.setTooltip (stageTooltip.trimEnd());
+
+    const bool abEngaged = audioEngine.isABCompareEngaged();
+    const size_t abStandbyBytes = abEngaged ? audioEngine.getABStandbyResidentBytes() : 0;
+    if (abEngaged)
+        abResidentLabel.setText ("A/B: " + formatMegabytes (abStandbyBytes), juce::dontSendNotification);
+
+    // ★ MemoryLedger: サブシステム別の常駐量。退役待ちと A/B 待機は内数なので合計とは別に出す
+    const auto memory = convo::MemoryLedger::snapshot();
+    memoryLabel.setText ("Mem: " + formatMegabytes (memory.totalBytes()), juce::dontSendNotification);
+    {
+        juce::String memoryTooltip;
+        for (size_t i = 0; i < convo::kNumMemoryCategories; ++i)
+        {
+            const auto category = static_cast<convo::MemoryCategory> (i);
+            const auto& c = memory[category];
+            if (category == convo::MemoryCategory::RetirePending || c.peakBytes == 0)
+                continue;
+            memoryTooltip << convo::memoryCategoryName (category) << ": " << formatMegabytes (c.bytes)
+                          << " (x" << juce::String (c.instances) << ", peak " << formatMegabytes (c.peakBytes) << ")\n";
+        }
+        const auto& retire = memory[convo::MemoryCategory::RetirePending];
+        memoryTooltip << "of which retire pending: " << formatMegabytes (retire.bytes)
+                      << " (" << juce::String (retire.instances) << " DSP cores, peak " << formatMegabytes (retire.peakBytes) << ")";
+        if (abEngaged)
+            memoryTooltip << "\nof which A/B standby: " << formatMegabytes (abStandbyBytes);
+        // ★ RT residency: Audio Thread が触るバッファのうち、フォルトしない状態にできた量
+        const auto residency = convo::getRtResidencyStats();
+        memoryTooltip << "\nRT resident: large pages " << formatMegabytes (residency.largePageBytes)
+                      << (residency.largePagesAvailable ? "" : " (no privilege)")
+                      << ", locked " << formatMegabytes (residency.lockedBytes)
+                      << ", unlocked " << formatMegabytes (residency.pageableBytes)
+                      << " (" << juce::String (residency.lockFailures) << " lock failures)";
+        memoryLabel.setTooltip (memoryTooltip);
+    }
+
+    if (metricsExporter != nullptr && metricsExporter->isDue (juce::Time::getMillisecondCounterHiRes()))
+        submitFleetMetrics (stageLatency, xrunReport, callbackTiming, memory);
+
     if (cliAutomationTelemetryLoggingEnabled && audioEngine.isCliProcessingTelemetryEnabled())
     {
         const auto cliPerf = audioEngine.consumeCliProcessingTelemetrySnapshot();
@@ -1508,6 +2189,81 @@ void MainWindow::timerCallback()
             + " blockSamples=" + juce::String(cliPerf.lastBlockSamples)
             + " sampleRateHz=" + juce::String(cliPerf.sampleRateHz, 1));
 
+        for (size_t i = 0; stageLatency.clockCalibrated && i < convo::kNumDspStages; ++i)
+        {
+            const auto& s = stageLatency.stages[i];
+            juce::Logger::writeToLog(
+                juce::String("[CLI_PERF_STAGE] stage=") + convo::dspStageName(static_cast<convo::DspStage>(i))
+                + " samples=" + juce::String(static_cast<juce::int64>(s.samples))
+                + " p50Us=" + juce::String(s.p50Us, 3)
+                + " p99Us=" + juce::String(s.p99Us, 3)
+                + " p999Us=" + juce::String(s.p999Us, 3)
+                + " maxUs=" + juce::String(s.maxUs, 3)
+                + " windowSec=" + juce::String(stageLatency.windowSeconds, 1));
+        }
+
+        // ★ 前回の tick 以降に取り込まれた xrun incident を 1 件 1 行で出す (段別は μs 換算、未校正なら cycles)
+        const uint64_t newIncidents = std::min<uint64_t>(xrunReport.totalIncidents - cliLoggedXrunIncidents,
+                                                         xrunReport.count);
+        for (size_t i = xrunReport.count - static_cast<size_t>(newIncidents); i < xrunReport.count; ++i)
+        {
+            const auto& incident = xrunReport.incidents[i];
+            juce::String stages;
+            for (size_t s = 0; s < convo::kNumDspStages; ++s)
+            {
+                if (incident.stageCycles[s] == 0)
+                    continue;
+                const double value = stageLatency.cyclesPerUs > 0.0
+                    ? static_cast<double>(incident.stageCycles[s]) / stageLatency.cyclesPerUs
+                    : static_cast<double>(incident.stageCycles[s]);
+                stages << (stages.isEmpty() ? "" : ",") << convo::dspStageName(static_cast<convo::DspStage>(s))
+                       << ":" << juce::String(value, 1);
+            }
+            const auto dominant = incident.dominantStage();
+            juce::Logger::writeToLog(
+                "[CLI_XRUN_INCIDENT] cb=" + juce::String(static_cast<juce::int64>(incident.callbackIndex))
+                + " callbackUs=" + juce::String(incident.callbackUs)
+                + " intervalUs=" + juce::String(incident.intervalUs)
+                + " expectedUs=" + juce::String(incident.expectedUs)
+                + " cpu=" + juce::String(static_cast<juce::int64>(incident.cpu))
+                + " prevCpu=" + juce::String(static_cast<juce::int64>(incident.prevCpu))
+                + " flags=" + formatXrunIncidentFlags(incident.flags)
+                + " dominant=" + (dominant != convo::DspStage::Count ? convo::dspStageName(dominant) : "none")
+                + (stageLatency.cyclesPerUs > 0.0 ? " stageUs=" : " stageCycles=") + stages
+                + " dropped=" + juce::String(static_cast<juce::int64>(xrunReport.droppedIncidents)));
+        }
+        cliLoggedXrunIncidents = xrunReport.totalIncidents;
+
+        {
+            juce::String memoryLine = "[CLI_MEM] totalBytes=" + juce::String(static_cast<juce::int64>(memory.totalBytes()));
+            for (size_t i = 0; i < convo::kNumMemoryCategories; ++i)
+            {
+                const auto category = static_cast<convo::MemoryCategory>(i);
+                const auto& c = memory[category];
+                memoryLine << " " << convo::memoryCategoryName(category) << "=" << juce::String(static_cast<juce::int64>(c.bytes))
+                           << "/" << juce::String(static_cast<juce::int64>(c.peakBytes)) << "/" << juce::String(c.instances);
+            }
+            memoryLine << " abStandbyBytes=" << juce::String(static_cast<juce::int64>(abStandbyBytes));
+            juce::Logger::writeToLog(memoryLine);
+        }
+
+        if (deviceTiming.valid && currentDevice != nullptr)
+        {
+            juce::Logger::writeToLog(
+                "[CLI_DEVICE_TIMING] type=" + currentDevice->getTypeName().quoted()
+                + " device=" + currentDevice->getName().quoted()
+                + " sampleRateHz=" + juce::String(currentDevice->getCurrentSampleRate(), 1)
+                + " bufferSamples=" + juce::String(currentDevice->getCurrentBufferSizeSamples())
+                + " observedSec=" + juce::String(deviceTiming.observedSeconds, 1)
+                + " jitterP99Us=" + juce::String(static_cast<juce::int64>(deviceTiming.jitterP99Us))
+                + " jitterP999Us=" + juce::String(static_cast<juce::int64>(deviceTiming.jitterP999Us))
+                + " slackP01Us=" + juce::String(deviceTiming.slackP01Us, 1)
+                + " incidentsPerHour=" + juce::String(deviceTiming.incidentsPerHour, 2)
+                + " verdict=" + convo::callbackTimingVerdictName(deviceTiming.verdict)
+                + " verifiedBuffer=" + juce::String(deviceTiming.recommendation.verifiedSamples)
+                + " suggestedBuffer=" + juce::String(deviceTiming.recommendation.suggestedSamples));
+        }
+
         if (cliAudioSetupRequested && !cliAudioSetupMismatchLogged)
         {
             const bool bufferRequested = (cliRequestedBufferSamples > 0);
@@ -1534,8 +2290,9 @@ void MainWindow::timerCallback()
         return;
 
     const auto breakdown = audioEngine.getCurrentLatencyBreakdown();
-    const int latencySamples = breakdown.totalLatencyBaseRateSamples;
-    const double sr = audioEngine.getSampleRate();
+    // 固定内部レート中もデバイスのレートのサンプル・ms で出す (SRC の遅延を含む)
+    const int latencySamples = breakdown.totalLatencyDeviceSamples;
+    const double sr = audioEngine.getDeviceSampleRate();
     const bool latencySrValid = (sr > 0.0);
     const int latencyMsX10 = latencySrValid
         ? static_cast<int>(std::lround((static_cast<double>(latencySamples) * 10000.0) / sr))
@@ -1570,6 +2327,106 @@ void MainWindow::timerCallback()
 
 }
 
+//--------------------------------------------------------------
+// 適応バッファ長
+//   締め切り超過 (overrun + 遅着) が続いたらデバイスのバッファ長を 1 段上げ、余裕が戻ったら
+//   ユーザーが選んだ長さまで戻す。setAudioDeviceSetup (..., false) で開き直すので
+//   保存される設定はユーザーの選択のまま
+//--------------------------------------------------------------
+void MainWindow::serviceAdaptiveBufferSize (juce::AudioIODevice* device, const convo::CallbackTimingHistograms::Snapshot& timing)
+{
+    const uint64_t misses = timing.overruns + timing.lateArrivals;
+    const uint64_t newMisses = (misses >= adaptiveBufferLastMisses) ? misses - adaptiveBufferLastMisses : 0;
+    adaptiveBufferLastMisses = misses;
+    if (device == nullptr)
+        return;
+
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const int currentSize = device->getCurrentBufferSizeSamples();
+    if (currentSize != adaptiveBufferObservedSize)
+    {
+        // ここで適用した長さ以外への変化はユーザー (DeviceSettings) の選択。基準長を取り直す
+        if (currentSize != adaptiveBufferAppliedSize)
+        {
+            bufferSizeGovernor.setBaseSize (currentSize, nowMs);
+            adaptiveBufferAppliedSize = 0;
+        }
+        adaptiveBufferObservedSize = currentSize;
+    }
+
+    int target = 0;
+    if (! audioEngine.isAdaptiveBufferSizeEnabled())
+    {
+        if (adaptiveBufferAppliedSize == 0)
+            return;
+        target = bufferSizeGovernor.getBaseSize();    // 無効化されたら選択された長さへ戻す
+    }
+    else
+    {
+        const auto available = device->getAvailableBufferSizes();
+        const std::vector<int> sizes (available.begin(), available.end());
+        target = bufferSizeGovernor.update (nowMs, currentSize, sizes, newMisses, audioEngine.getCallbackLoadPermille());
+        if (target == 0)
+            return;
+    }
+
+    juce::AudioDeviceManager::AudioDeviceSetup setup;
+    audioDeviceManager.getAudioDeviceSetup (setup);
+    setup.bufferSize = target;
+    if (const auto err = audioDeviceManager.setAudioDeviceSetup (setup, false); err.isNotEmpty())
+    {
+        juce::Logger::writeToLog ("[BUFFER] adaptive change to " + juce::String (target) + " failed: " + err);
+        bufferSizeGovernor.notifyApplied (nowMs);
+        return;
+    }
+
+    auto* reopened = audioDeviceManager.getCurrentAudioDevice();
+    const int appliedSize = (reopened != nullptr) ? reopened->getCurrentBufferSizeSamples() : target;
+    adaptiveBufferObservedSize = appliedSize;
+    adaptiveBufferAppliedSize = (appliedSize == bufferSizeGovernor.getBaseSize()) ? 0 : appliedSize;
+    bufferSizeGovernor.notifyApplied (nowMs);
+    juce::Logger::writeToLog ("[BUFFER] adaptive " + juce::String (currentSize) + " -> " + juce::String (appliedSize)
+                              + " samples (selected " + juce::String (bufferSizeGovernor.getBaseSize())
+                              + ", misses " + juce::String (static_cast<juce::int64> (newMisses))
+                              + ", load " + juce::String (audioEngine.getCallbackLoadPermille()) + " permille"
+                              + ", backoff x" + juce::String (1 << bufferSizeGovernor.getBackoffShift()) + ")");
+}
+
+//--------------------------------------------------------------
+// フリート監視用メトリクス (--metrics-udp / --metrics-pipe)
+//   段別処理時間・xrun・到着ジッター・メモリは timer が表示用に集めたものをそのまま使い、
+//   IR キャッシュと学習の進捗だけここで読む。書式化と送信はエクスポーターのスレッドが行う
+//--------------------------------------------------------------
+void MainWindow::submitFleetMetrics (const convo::StageLatencyReport& stageLatency,
+                                     const convo::XrunIncidentCorrelator::Report& xrunReport,
+                                     const convo::CallbackTimingHistograms::Snapshot& callbackTiming,
+                                     const convo::MemoryLedger::Snapshot& memory)
+{
+    convo::FleetMetricsSample sample;
+    sample.timestampMs = static_cast<uint64_t> (juce::Time::currentTimeMillis());
+    sample.callbackLoadPermille = audioEngine.getCallbackLoadPermille();
+    sample.callbackTotals = callbackTiming;
+
+    sample.xrunIncidents = xrunReport.totalIncidents;
+    sample.xrunDropped = xrunReport.droppedIncidents;
+    sample.xrunRecentFlagCounts = xrunReport.flagCounts;
+
+    sample.stages = stageLatency;
+    sample.memory = memory;
+
+    const auto cache = audioEngine.getConvolverCacheStats();
+    sample.irCache.hits = cache.hits;
+    sample.irCache.misses = cache.misses;
+    sample.irCache.evictions = cache.evictions;
+    sample.irCache.entries = static_cast<uint64_t> (cache.entries);
+    sample.irCache.diskBytes = cache.diskBytes;
+
+    sample.learnerActive = audioEngine.isNoiseShaperLearning();
+    sample.learner = audioEngine.getNoiseShaperLearningProgress();
+
+    metricsExporter->submit (sample, juce::Time::getMillisecondCounterHiRes());
+}
+
 //--------------------------------------------------------------
 // プリセット保存
 //--------------------------------------------------------------
@@ -1586,6 +2443,18 @@ void MainWindow::loadPreset()
     launchFileChooser(false);
 }
 
+//--------------------------------------------------------------
+// A/B 比較スロット切替
+//--------------------------------------------------------------
+void MainWindow::selectABSlot(convo::ABSlot slot)
+{
+    audioEngine.selectABSlot(slot);
+
+    const auto active = audioEngine.getActiveABSlot();
+    abSlotAButton.setToggleState(active == convo::ABSlot::A, juce::dontSendNotification);
+    abSlotBButton.setToggleState(active == convo::ABSlot::B, juce::dontSendNotification);
+}
+
 //--------------------------------------------------------------
 // ファイル選択ダイアログ
 //--------------------------------------------------------------
@@ -1647,6 +2516,9 @@ void MainWindow::launchFileChooserImpl(bool isSaving)
                 {
                     safeThis->audioEngine.requestEqPresetFromText(file);
                 }
+
+                if (safeThis->scenarioRecorder != nullptr)
+                    safeThis->scenarioRecorder->notePresetLoaded(file);
             }
         }
     });
@@ -15,8 +15,20 @@
 #include "SpectrumAnalyzerComponent.h"
 #include "DeviceSettings.h"
 #include "AsioBlacklist.h"
+#include "StartupWarmup.h"
+#include "audioengine/BufferSizeGovernor.h"
 #include <atomic>
 
+class DeviceTimingProfiles;
+class FleetMetricsExporter;
+class LoopbackLatencyTest;
+class NoiseShaperLearnerBenchmark;
+class NoiseShaperOfflineTrainer;
+class OfflineBatchRenderer;
+class OfflineRenderer;
+class ScenarioRecorder;
+class ScenarioReplayer;
+
 class MainWindow : public juce::DocumentWindow,
                    private juce::Timer,
                    private juce::ChangeListener,
@@ -49,6 +61,13 @@ private:
     void editorShown(juce::Label* label, juce::TextEditor& editor) override;
     std::unique_ptr<juce::AccessibilityHandler> createAccessibilityHandler() override;
     void orderModeBoxChanged();
+    // 適応バッファ長: 締め切り超過の差分を BufferSizeGovernor に渡し、返った長さでデバイスを開き直す
+    void serviceAdaptiveBufferSize (juce::AudioIODevice* device, const convo::CallbackTimingHistograms::Snapshot& timing);
+    // --metrics-udp / --metrics-pipe: timer で集めた観測値に残りを足してエクスポーターへ渡す
+    void submitFleetMetrics (const convo::StageLatencyReport& stageLatency,
+                             const convo::XrunIncidentCorrelator::Report& xrunReport,
+                             const convo::CallbackTimingHistograms::Snapshot& callbackTiming,
+                             const convo::MemoryLedger::Snapshot& memory);
 
     void createUIComponents();
     void loadSettings();
@@ -56,13 +75,16 @@ private:
     void toggleDeviceSelectorImpl();
     void savePreset();
     void loadPreset();
+    void selectABSlot(convo::ABSlot slot);
     void launchFileChooser(bool isSaving);
     void launchFileChooserImpl(bool isSaving);
     void showAboutDialog();
     void showAboutDialogImpl();
+    void pollStartupProfile();
 
     AsioBlacklist asioBlacklist;
     AudioEngine audioEngine;
+    convo::StartupWarmup startupWarmup;  // audioEngine を参照するタスクがあるため、audioEngine より後に宣言する (先に join)
     std::unique_ptr<AudioEngineProcessor> audioEngineProcessor;
     juce::AudioDeviceManager audioDeviceManager;
     juce::AudioProcessorPlayer audioProcessorPlayer;
@@ -78,10 +100,14 @@ private:
     juce::TextButton saveButton;
     juce::TextButton loadButton;
     juce::TextButton aboutButton;
+    juce::TextButton abSlotAButton;
+    juce::TextButton abSlotBButton;
+    juce::Label abResidentLabel;
     juce::ToggleButton softClipButton;
     juce::Label saturationValueLabel;
     juce::Label saturationLabel;
     juce::Label latencyLabel;
+    juce::Label memoryLabel;
     juce::Label cpuUsageLabel;
     bool hasLastLatencyLabelState { false };
     int lastLatencySamples { 0 };
@@ -91,9 +117,23 @@ private:
     std::atomic<bool> cliAutomationCallbacksEnabled { false };
     bool cliAudioSetupRequested { false };
     bool cliAudioSetupMismatchLogged { false };
+    uint64_t cliLoggedXrunIncidents { 0 };
     int cliRequestedBufferSamples { 0 };
     double cliRequestedSampleRateHz { 0.0 };
     std::unique_ptr<juce::DocumentWindow> settingsWindow;
+    std::unique_ptr<NoiseShaperOfflineTrainer> offlineTrainer;  // --cli-learn-offline
+    std::unique_ptr<NoiseShaperLearnerBenchmark> learnerBenchmark;  // --cli-learn-benchmark
+    std::unique_ptr<OfflineRenderer> offlineRenderer;  // --cli-render
+    std::unique_ptr<OfflineBatchRenderer> offlineBatchRenderer;  // --cli-render-batch
+    std::unique_ptr<ScenarioRecorder> scenarioRecorder;  // --cli-record-scenario
+    std::unique_ptr<ScenarioReplayer> scenarioReplayer;  // --cli-replay
+    std::unique_ptr<LoopbackLatencyTest> latencyTest;  // --cli-latency-test
+    std::unique_ptr<DeviceTimingProfiles> deviceTimingProfiles;
+    std::unique_ptr<FleetMetricsExporter> metricsExporter;  // --metrics-udp / --metrics-pipe
+    convo::BufferSizeGovernor bufferSizeGovernor;
+    int adaptiveBufferAppliedSize { 0 };     // 0 = 基準長で動作中 (上げ下げしていない)
+    int adaptiveBufferObservedSize { 0 };    // 前回 timer で見たデバイスのバッファ長 (ユーザー変更の検出用)
+    uint64_t adaptiveBufferLastMisses { 0 };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainWindow)
 };
@@ -0,0 +1,24 @@
+//============================================================================
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace convo {
+
+//============================================================================
+/**
+    readMappedIR ── 非圧縮 WAV / AIFF の IR をメモリマップから直接 double へ展開する
+
+    ファイルを読み取り専用でマップし、データチャンクを core/PcmDecode.h で
+    チャンネルごとの double 配列へ変換する (float 中間バッファと 1 サンプルずつの変換を経由しない)。
+    大きなファイルはチャンネル × フレーム区間に分けて複数スレッドで展開する。
+    各スレッドは連続区間を受け持つため、マップのページフォルトも並列に進む。
+
+    対象外の形式 (8bit・圧縮・RF64・FLAC など) やマップ失敗では false を返す。
+    呼び出し側は従来の AudioFormatReader 経路へ落とす。
+    maxSeconds > 0 なら先頭のその秒数だけを展開する (IR プレビュー)。
+*/
+bool readMappedIR(const juce::File& file, juce::AudioBuffer<double>& out, double& sampleRateOut,
+                  double maxSeconds = 0.0);
+
+} // namespace convo
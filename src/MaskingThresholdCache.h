@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+//==============================================================================
+// MaskingThresholdCache — 学習セグメントのマスキング閾値を内容ハッシュで引くキャッシュ
+//
+//   NoiseShaperLearner::buildTrainingSegments は世代ごと・再開ごとにセグメント集合を
+//   作り直すが、再生が止まっている間やモード切替直後はセグメントの音声がほとんど変わらない。
+//   閾値 (FFT + 全ビンの Bark 拡散 / ATH 計算) はセグメント内容とサンプルレートだけで決まるので、
+//   (内容ハッシュ, サンプルレート) をキーに Capacity 件まで保持し、溢れたら最も古く使った
+//   エントリを捨てる (LRU)。セグメント集合の再構築やセッション再開をまたいで生き残る。
+//
+//   ハッシュはゲイン適用後の L/R を 64bit 語として混ぜるだけの非暗号ハッシュ。
+//   衝突時は閾値が別セグメントのものになるだけで、評価が不安定になることはない。
+//   学習ワーカースレッド専用 (同期なし)。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+namespace convo {
+
+inline std::uint64_t hashSegmentContent(const double* left, const double* right, int length) noexcept
+{
+    // L / R を独立な 2 系列で混ぜて依存チェーンを短くし、最後に合成する
+    constexpr std::uint64_t kMulA = 0xff51afd7ed558ccdull;
+    constexpr std::uint64_t kMulB = 0xc4ceb9fe1a85ec53ull;
+    std::uint64_t hashLeft = 0x9e3779b97f4a7c15ull ^ static_cast<std::uint64_t>(length);
+    std::uint64_t hashRight = 0x632be59bd9b4e019ull;
+    for (int i = 0; i < length; ++i)
+    {
+        hashLeft = std::rotl(hashLeft ^ (std::bit_cast<std::uint64_t>(left[i]) * kMulA), 31) * kMulB;
+        hashRight = std::rotl(hashRight ^ (std::bit_cast<std::uint64_t>(right[i]) * kMulA), 31) * kMulB;
+    }
+
+    std::uint64_t hash = hashLeft ^ std::rotl(hashRight, 17);
+    hash ^= hash >> 33;
+    hash *= kMulA;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+template <int Bins, int Capacity>
+class MaskingThresholdCache
+{
+public:
+    using Thresholds = std::array<double, Bins>;
+
+    // 見つかれば閾値を返し、最終使用を更新する。なければ nullptr
+    const Thresholds* find(std::uint64_t contentHash, double sampleRate) noexcept
+    {
+        for (auto& entry : entries)
+        {
+            if (entry.valid && entry.contentHash == contentHash && entry.sampleRate == sampleRate)
+            {
+                entry.lastUse = ++useCounter;
+                ++hits;
+                return &entry.thresholds;
+            }
+        }
+        ++misses;
+        return nullptr;
+    }
+
+    void store(std::uint64_t contentHash, double sampleRate, const Thresholds& thresholds) noexcept
+    {
+        Entry* victim = &entries[0];
+        for (auto& entry : entries)
+        {
+            if (!entry.valid)
+            {
+                victim = &entry;
+                break;
+            }
+            if (entry.lastUse < victim->lastUse)
+                victim = &entry;
+        }
+
+        victim->valid = true;
+        victim->contentHash = contentHash;
+        victim->sampleRate = sampleRate;
+        victim->lastUse = ++useCounter;
+        victim->thresholds = thresholds;
+    }
+
+    void clear() noexcept
+    {
+        for (auto& entry : entries)
+            entry.valid = false;
+        hits = 0;
+        misses = 0;
+    }
+
+    std::uint64_t getHitCount() const noexcept { return hits; }
+    std::uint64_t getMissCount() const noexcept { return misses; }
+
+private:
+    struct Entry
+    {
+        bool valid = false;
+        std::uint64_t contentHash = 0;
+        double sampleRate = 0.0;
+        std::uint64_t lastUse = 0;
+        Thresholds thresholds {};
+    };
+
+    std::array<Entry, Capacity> entries {};
+    std::uint64_t useCounter = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+};
+
+} // namespace convo
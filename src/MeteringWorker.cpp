@@ -0,0 +1,143 @@
+#include "MeteringWorker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "audioengine/AtomicAccess.h"
+
+namespace
+{
+constexpr double kSilentDb = -std::numeric_limits<double>::infinity();
+
+double linearToDb(double linear) noexcept
+{
+    return (linear > 0.0) ? 20.0 * std::log10(linear) : kSilentDb;
+}
+}
+
+MeteringWorker::MeteringWorker(AudioEngine& audioEngine)
+    : juce::Thread("MeteringWorker"),
+      engine(audioEngine),
+      blockL(convo::makeAlignedArray<double>(kChunkSamples)),
+      blockR(convo::makeAlignedArray<double>(kChunkSamples)),
+      momentaryLufs(kSilentDb),
+      shortTermLufs(kSilentDb),
+      integratedLufs(kSilentDb),
+      loudnessRangeLu(0.0),
+      truePeakDbtp(kSilentDb),
+      truePeakMaxDbtp(kSilentDb)
+{
+}
+
+MeteringWorker::~MeteringWorker()
+{
+    stopThread(1000);
+}
+
+void MeteringWorker::run()
+{
+    engine.getAffinityManager().applyCurrentThreadPolicy(ThreadType::LightBackground);
+
+    constexpr int intervalMs = 1000 / kPollHz;
+    while (!threadShouldExit())
+    {
+        wait(intervalMs);
+        if (threadShouldExit())
+            break;
+        drain();
+    }
+}
+
+MeteringWorker::Readings MeteringWorker::getReadings() const noexcept
+{
+    // relaxed: 各フィールドは独立した表示値 (フィールド間の整合は求めない)
+    Readings readings;
+    readings.momentaryLufs = convo::consumeAtomic(momentaryLufs, std::memory_order_relaxed);
+    readings.shortTermLufs = convo::consumeAtomic(shortTermLufs, std::memory_order_relaxed);
+    readings.integratedLufs = convo::consumeAtomic(integratedLufs, std::memory_order_relaxed);
+    readings.loudnessRangeLu = convo::consumeAtomic(loudnessRangeLu, std::memory_order_relaxed);
+    readings.truePeakDbtp = convo::consumeAtomic(truePeakDbtp, std::memory_order_relaxed);
+    readings.truePeakMaxDbtp = convo::consumeAtomic(truePeakMaxDbtp, std::memory_order_relaxed);
+    return readings;
+}
+
+bool MeteringWorker::prepareMeters(double sampleRate)
+{
+    if (!blockL || !blockR)
+        return false;
+
+    // K-weighting 係数・補間位相・100ms のサブブロック長はレートで決まる
+    loudnessMeter.prepare(sampleRate, kChunkSamples);
+    truePeakDetector.prepare(sampleRate, kChunkSamples);
+    integrator.prepare(sampleRate);
+    truePeakHold = 0.0;
+    truePeakMax = 0.0;
+    preparedRate = sampleRate;
+    return true;
+}
+
+void MeteringWorker::resetMeters() noexcept
+{
+    loudnessMeter.reset();
+    truePeakDetector.reset();
+    integrator.reset();
+    truePeakHold = 0.0;
+    truePeakMax = 0.0;
+}
+
+//--------------------------------------------------------------
+// drain  ──  FIFO の中身を全部計測器へ流し、結果を公開する
+//--------------------------------------------------------------
+void MeteringWorker::drain()
+{
+    // タップはベースレート (オーバーサンプリング時も processDown 後) を push している
+    const double sampleRate = engine.getAnalyzerSampleRate();
+    if (sampleRate <= 0.0)
+        return;
+    if (sampleRate != preparedRate)
+    {
+        if (!prepareMeters(sampleRate))
+            return;
+        // 残っているのは旧レートのブロック。新しいレートの計測に混ぜない
+        engine.skipMeteringTap(engine.getMeteringTapNumReady());
+    }
+    if (convo::exchangeAtomic(resetRequested, false, std::memory_order_relaxed)) // relaxed: 単独のフラグ
+        resetMeters();
+
+    for (;;)
+    {
+        // FIFO の storage から直接 double へ変換する (中間の float コピーなし)
+        const auto span = engine.peekMeteringTap(kChunkSamples);
+        const int n = span.numSamples;
+        if (n <= 0)
+            break;
+
+        double* left = blockL.get();
+        double* right = blockR.get();
+        for (int i = 0; i < n; ++i)
+        {
+            left[i] = static_cast<double>(span.channels[0][i]);
+            right[i] = static_cast<double>(span.channels[1][i]);
+        }
+        engine.commitMeteringTap(n);
+
+        loudnessMeter.processBlock(left, right, n);
+        loudnessMeter.drainInto(integrator);
+        truePeakHold = truePeakDetector.processBlock(left, right, n);
+        truePeakMax = std::max(truePeakMax, truePeakHold);
+    }
+
+    publish();
+}
+
+void MeteringWorker::publish() noexcept
+{
+    // relaxed: 表示値。getReadings() はフィールドごとに最新を読めればよい
+    convo::publishAtomic(momentaryLufs, integrator.momentaryLufs(), std::memory_order_relaxed);
+    convo::publishAtomic(shortTermLufs, integrator.shortTermLufs(), std::memory_order_relaxed);
+    convo::publishAtomic(integratedLufs, integrator.integratedLufs(), std::memory_order_relaxed);
+    convo::publishAtomic(loudnessRangeLu, integrator.loudnessRangeLu(), std::memory_order_relaxed);
+    convo::publishAtomic(truePeakDbtp, linearToDb(truePeakHold), std::memory_order_relaxed);
+    convo::publishAtomic(truePeakMaxDbtp, linearToDb(truePeakMax), std::memory_order_relaxed);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+
+#include <JuceHeader.h>
+
+#include "AlignedAllocation.h"
+#include "AudioEngine.h"
+#include "LoudnessIntegrator.h"
+#include "LoudnessMeter.h"
+#include "TruePeakDetector.h"
+
+/**
+    MeteringWorker: 出力ラウドネス (EBU R128) と TruePeak (BS.1770) を計算するスレッド (LightBackground に固定)。
+
+    Audio Thread は出力段 (ディザ・ヘッドルーム後、リミッタ前) のブロックを meteringFifo (ステレオ float) へ
+    写すだけで、K-weighting・4 倍補間・ゲーティング集計はすべてこのスレッドが kPollHz で行う。
+    FIFO の中身は LoudnessMeter → LoudnessIntegrator と TruePeakDetector へ同じ順で流し、
+    結果をフィールドごとの atomic で公開する (表示用なので、読む側でフィールド間が 1 周期ずれることはある)。
+
+    - AudioEngine::initWorkerThread で作って開始し、shutdownWorkerThread で止めて破棄する
+    - レート (getAnalyzerSampleRate) が変わったら検出器を準備し直し、積算もやり直す。
+      FIFO に残った旧レートの分は捨てる
+    - 計測器の確保はこのスレッドの準備時だけ。meteringFifo のリーダはこのスレッドだけ
+*/
+class MeteringWorker : public juce::Thread
+{
+public:
+    using Readings = AudioEngine::MeterReadings;
+
+    static constexpr int kPollHz = 10;
+    // meteringFifo の容量は METERING_MIN_PULL_HZ 間隔の取り出しを前提に決まる
+    static_assert(kPollHz >= AudioEngine::METERING_MIN_PULL_HZ);
+    static constexpr int kChunkSamples = 4096;   // FIFO から一度に読む長さ (= 計測器の maxBlockSize)
+
+    explicit MeteringWorker(AudioEngine& engine);
+    ~MeteringWorker() override;
+
+    void run() override;
+
+    // 任意のスレッド。直近に公開した値 (未計測・無音は -inf)
+    [[nodiscard]] Readings getReadings() const noexcept;
+
+    // 任意のスレッド。Integrated / LRA / 最大 TruePeak の積算を次の周期に捨てて数え直す
+    void requestReset() noexcept
+    {
+        convo::publishAtomic(resetRequested, true, std::memory_order_relaxed); // relaxed: 単独のフラグ (次の周期で拾えればよい)
+    }
+
+private:
+    void drain();
+    bool prepareMeters(double sampleRate);
+    void resetMeters() noexcept;
+    void publish() noexcept;
+
+    AudioEngine& engine;
+    std::atomic<bool> resetRequested { false };
+
+    // ── 計測状態 (このスレッドのみ) ──
+    LoudnessMeter loudnessMeter;
+    LoudnessIntegrator integrator;
+    TruePeakDetector truePeakDetector;
+    convo::ScopedAlignedPtr<double> blockL;  // FIFO から直接変換して計測器へ渡す double
+    convo::ScopedAlignedPtr<double> blockR;
+    double preparedRate = 0.0;
+    double truePeakHold = 0.0;               // TruePeakDetector のピークホールド (線形)
+    double truePeakMax = 0.0;                // requestReset() 以降の最大 (線形)
+
+    // ── 公開値 (書くのはこのスレッドのみ) ──
+    std::atomic<double> momentaryLufs;
+    std::atomic<double> shortTermLufs;
+    std::atomic<double> integratedLufs;
+    std::atomic<double> loudnessRangeLu;
+    std::atomic<double> truePeakDbtp;
+    std::atomic<double> truePeakMaxDbtp;
+};
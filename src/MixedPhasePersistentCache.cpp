@@ -2,8 +2,12 @@
 
 #include <JuceHeader.h>
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace convo {
@@ -17,6 +21,74 @@ static uint64_t hashCombine(uint64_t seed, uint64_t value)
     return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
 }
 
+namespace {
+
+constexpr uint64_t kIndexMagic = 0x434F4E564F4D5049ULL; // "CONVOMPI"
+constexpr uint32_t kIndexVersion = 2;  // v2: 系列ハッシュとレートを追加 (v1 はヘッダから再構築)
+
+#pragma pack(push, 1)
+struct IndexFileHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t numRecords;
+    uint64_t checksum;
+};
+
+struct IndexRecord {
+    uint64_t keyHash;
+    int64_t sizeBytes;
+    uint64_t lastUsedTime;
+    uint64_t familyHash;   // レートと targetLength を除いたキー (別レートの設計を探す)
+    double sampleRate;
+};
+#pragma pack(pop)
+
+// プロセス内の索引 (Loader Thread 群から並行に呼ばれるため mutex で保護)
+struct CacheIndex {
+    struct Entry {
+        int64_t sizeBytes = 0;
+        uint64_t lastUsedTime = 0;
+        uint64_t familyHash = 0;
+        double sampleRate = 0.0;
+        std::list<uint64_t>::iterator lruPos;
+    };
+
+    std::mutex mutex;
+    bool loaded = false;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::list<uint64_t> lruList;  // front = 最近使用
+};
+
+CacheIndex& cacheIndex()
+{
+    static CacheIndex index;
+    return index;
+}
+
+// 再起動をまたいで順序が保たれる壁時計 (旧 getMillisecondCounter は起動ごとにリセットされる)
+uint64_t currentUsageTime() noexcept
+{
+    return static_cast<uint64_t>(juce::Time::currentTimeMillis());
+}
+
+uint64_t computeIndexChecksum(const std::vector<IndexRecord>& records) noexcept
+{
+    uint64_t h = kIndexMagic;
+    for (const auto& r : records)
+    {
+        h = hashCombine(h, r.keyHash);
+        h = hashCombine(h, static_cast<uint64_t>(r.sizeBytes));
+        h = hashCombine(h, r.lastUsedTime);
+        h = hashCombine(h, r.familyHash);
+        uint64_t srBits = 0;
+        std::memcpy(&srBits, &r.sampleRate, sizeof(double));
+        h = hashCombine(h, srBits);
+    }
+    return h;
+}
+
+} // namespace
+
 uint64_t MixedPhasePersistentCache::computeKeyHash(uint64_t fileHash,
                                                     double sampleRate,
                                                     int phaseMode,
@@ -39,6 +111,23 @@ uint64_t MixedPhasePersistentCache::computeKeyHash(uint64_t fileHash,
     return h;
 }
 
+uint64_t MixedPhasePersistentCache::computeFamilyHash(uint64_t fileHash,
+                                                       int phaseMode,
+                                                       float freqStartHz, float freqEndHz)
+{
+    // targetLength はレートに比例して変わるので系列には含めない
+    uint64_t h = hashCombine(fileHash, 0x46414D494C59ULL); // "FAMILY" (キーハッシュと空間を分ける)
+    h = hashCombine(h, static_cast<uint64_t>(phaseMode));
+
+    uint32_t f1Bits = 0;
+    uint32_t f2Bits = 0;
+    std::memcpy(&f1Bits, &freqStartHz, sizeof(float));
+    std::memcpy(&f2Bits, &freqEndHz, sizeof(float));
+    h = hashCombine(h, static_cast<uint64_t>(f1Bits));
+    h = hashCombine(h, static_cast<uint64_t>(f2Bits));
+    return h;
+}
+
 // ═══════════════════════════════════════════════════════════════
 //  パス解決
 // ═══════════════════════════════════════════════════════════════
@@ -63,12 +152,193 @@ juce::File MixedPhasePersistentCache::getCacheFile(uint64_t fileHash,
                                                     float freqStartHz, float freqEndHz,
                                                     int targetLength)
 {
-    const auto hash = computeKeyHash(fileHash, sampleRate, phaseMode,
-                                     freqStartHz, freqEndHz, targetLength);
-    const auto filename = juce::String::toHexString(static_cast<int64_t>(hash)) + ".mph";
+    return getCacheFileForKey(computeKeyHash(fileHash, sampleRate, phaseMode,
+                                             freqStartHz, freqEndHz, targetLength));
+}
+
+juce::File MixedPhasePersistentCache::getCacheFileForKey(uint64_t keyHash)
+{
+    const auto filename = juce::String::toHexString(static_cast<int64_t>(keyHash)) + ".mph";
     return getCacheDirectory().getChildFile(filename);
 }
 
+juce::File MixedPhasePersistentCache::getIndexFile()
+{
+    return getCacheDirectory().getChildFile("index.mpi");
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  索引
+// ═══════════════════════════════════════════════════════════════
+
+void MixedPhasePersistentCache::ensureIndexLoadedLocked()
+{
+    auto& index = cacheIndex();
+    if (index.loaded)
+        return;
+
+    index.loaded = true;
+    if (!readIndexFileLocked())
+    {
+        rebuildIndexFromHeadersLocked();
+        writeIndexFileLocked();
+    }
+}
+
+bool MixedPhasePersistentCache::readIndexFileLocked()
+{
+    auto& index = cacheIndex();
+    const auto file = getIndexFile();
+    if (!file.existsAsFile())
+        return false;
+
+    juce::FileInputStream stream(file);
+    if (!stream.openedOk())
+        return false;
+
+    IndexFileHeader header;
+    if (stream.read(&header, sizeof(header)) != static_cast<int>(sizeof(header)))
+        return false;
+    if (header.magic != kIndexMagic || header.version != kIndexVersion)
+        return false;
+    if (file.getSize() != static_cast<int64>(sizeof(header) + static_cast<size_t>(header.numRecords) * sizeof(IndexRecord)))
+        return false;
+
+    std::vector<IndexRecord> records(header.numRecords);
+    if (!records.empty())
+    {
+        const size_t bytes = records.size() * sizeof(IndexRecord);
+        if (stream.read(records.data(), bytes) != static_cast<int>(bytes))
+            return false;
+    }
+    if (computeIndexChecksum(records) != header.checksum)
+        return false;
+
+    // 古い順に push_front して front = 最近使用 とする
+    std::sort(records.begin(), records.end(),
+              [](const IndexRecord& a, const IndexRecord& b) { return a.lastUsedTime < b.lastUsedTime; });
+
+    index.entries.clear();
+    index.lruList.clear();
+    for (const auto& r : records)
+        touchKeyLocked(r.keyHash, r.familyHash, r.sampleRate, r.sizeBytes, r.lastUsedTime);
+    return true;
+}
+
+void MixedPhasePersistentCache::rebuildIndexFromHeadersLocked()
+{
+    auto& index = cacheIndex();
+    index.entries.clear();
+    index.lruList.clear();
+
+    juce::Array<juce::File> files;
+    getCacheDirectory().findChildFiles(files, juce::File::findFiles, false, "*.mph");
+
+    std::vector<IndexRecord> records;
+    records.reserve(static_cast<size_t>(files.size()));
+    for (const auto& f : files)
+    {
+        juce::FileInputStream stream(f);
+        if (!stream.openedOk())
+            continue;
+
+        DiskHeader header;
+        if (stream.read(&header, sizeof(DiskHeader)) != static_cast<int64>(sizeof(DiskHeader)))
+            continue;
+        if (header.magic != kMagic || header.version != kVersion)
+            continue;
+
+        const uint64_t keyHash = computeKeyHash(header.fileHash, header.sampleRate, header.phaseMode,
+                                                header.freqStartHz, header.freqEndHz, header.targetLength);
+        if (getCacheFileForKey(keyHash) != f)
+            continue;  // ファイル名とヘッダが一致しないものは索引に載せない
+
+        const uint64_t familyHash = computeFamilyHash(header.fileHash, header.phaseMode,
+                                                      header.freqStartHz, header.freqEndHz);
+        records.push_back({ keyHash, f.getSize(), header.lastUsedTime, familyHash, header.sampleRate });
+    }
+
+    std::sort(records.begin(), records.end(),
+              [](const IndexRecord& a, const IndexRecord& b) { return a.lastUsedTime < b.lastUsedTime; });
+    for (const auto& r : records)
+        touchKeyLocked(r.keyHash, r.familyHash, r.sampleRate, r.sizeBytes, r.lastUsedTime);
+
+    juce::Logger::writeToLog("MixedPhasePersistentCache: index rebuilt from "
+                             + juce::String(static_cast<int>(records.size())) + " headers");
+}
+
+void MixedPhasePersistentCache::writeIndexFileLocked()
+{
+    auto& index = cacheIndex();
+
+    // 古い順 (lruList の末尾から) に書き出す
+    std::vector<IndexRecord> records;
+    records.reserve(index.entries.size());
+    for (auto it = index.lruList.rbegin(); it != index.lruList.rend(); ++it)
+    {
+        const auto& e = index.entries.at(*it);
+        records.push_back({ *it, e.sizeBytes, e.lastUsedTime, e.familyHash, e.sampleRate });
+    }
+
+    IndexFileHeader header;
+    header.magic = kIndexMagic;
+    header.version = kIndexVersion;
+    header.numRecords = static_cast<uint32_t>(records.size());
+    header.checksum = computeIndexChecksum(records);
+
+    const auto file = getIndexFile();
+    juce::TemporaryFile tempFile(file);
+    {
+        juce::FileOutputStream stream(tempFile.getFile());
+        if (!stream.openedOk())
+            return;
+        if (!stream.write(&header, sizeof(header)))
+            return;
+        if (!records.empty() && !stream.write(records.data(), records.size() * sizeof(IndexRecord)))
+            return;
+        stream.flush();
+        if (stream.getStatus().failed())
+            return;
+    }
+
+    if (!tempFile.overwriteTargetFileWithTemporary())
+        juce::Logger::writeToLog("Warning: Could not update mixed-phase cache index");
+}
+
+void MixedPhasePersistentCache::touchKeyLocked(uint64_t keyHash, uint64_t familyHash, double sampleRate,
+                                               int64_t sizeBytes, uint64_t lastUsedTime)
+{
+    auto& index = cacheIndex();
+    auto it = index.entries.find(keyHash);
+    if (it != index.entries.end())
+    {
+        index.lruList.splice(index.lruList.begin(), index.lruList, it->second.lruPos);
+        if (sizeBytes >= 0)
+            it->second.sizeBytes = sizeBytes;
+        it->second.lastUsedTime = lastUsedTime;
+        return;
+    }
+
+    index.lruList.push_front(keyHash);
+    CacheIndex::Entry entry;
+    entry.sizeBytes = juce::jmax<int64_t>(0, sizeBytes);
+    entry.lastUsedTime = lastUsedTime;
+    entry.familyHash = familyHash;
+    entry.sampleRate = sampleRate;
+    entry.lruPos = index.lruList.begin();
+    index.entries.emplace(keyHash, entry);
+}
+
+void MixedPhasePersistentCache::forgetKeyLocked(uint64_t keyHash)
+{
+    auto& index = cacheIndex();
+    auto it = index.entries.find(keyHash);
+    if (it == index.entries.end())
+        return;
+    index.lruList.erase(it->second.lruPos);
+    index.entries.erase(it);
+}
+
 // ═══════════════════════════════════════════════════════════════
 //  読み込み
 // ═══════════════════════════════════════════════════════════════
@@ -82,10 +352,20 @@ bool MixedPhasePersistentCache::load(uint64_t fileHash,
                                      std::vector<double>& outRho,
                                      std::vector<double>& outTheta)
 {
-    const auto file = getCacheFile(fileHash, sampleRate, phaseMode,
-                                   freqStartHz, freqEndHz, targetLength);
+    const uint64_t keyHash = computeKeyHash(fileHash, sampleRate, phaseMode,
+                                            freqStartHz, freqEndHz, targetLength);
+    const auto file = getCacheFileForKey(keyHash);
     if (!file.existsAsFile())
+    {
+        // 外部で削除されたファイルを索引から外す
+        const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+        if (cacheIndex().loaded && cacheIndex().entries.count(keyHash) != 0)
+        {
+            forgetKeyLocked(keyHash);
+            writeIndexFileLocked();
+        }
         return false;
+    }
 
     juce::FileInputStream stream(file);
     if (!stream.openedOk())
@@ -143,6 +423,77 @@ bool MixedPhasePersistentCache::load(uint64_t fileHash,
     return true;
 }
 
+bool MixedPhasePersistentCache::loadDesignForOtherRate(uint64_t fileHash,
+                                                       double sampleRate,
+                                                       int phaseMode,
+                                                       float freqStartHz, float freqEndHz,
+                                                       double& outSourceRate,
+                                                       std::vector<double>& outRho,
+                                                       std::vector<double>& outTheta)
+{
+    if (sampleRate <= 0.0)
+        return false;
+
+    // 同じ系列の別レートを索引から拾う。レート比 (対数) が近い順、同じなら最近使用順
+    struct Candidate { uint64_t keyHash; double sampleRate; uint64_t lastUsedTime; };
+    std::vector<Candidate> candidates;
+    {
+        const uint64_t familyHash = computeFamilyHash(fileHash, phaseMode, freqStartHz, freqEndHz);
+        const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+        ensureIndexLoadedLocked();
+        for (const auto& [keyHash, e] : cacheIndex().entries)
+            if (e.familyHash == familyHash && e.sampleRate > 0.0 && std::abs(e.sampleRate - sampleRate) > 1.0e-6)
+                candidates.push_back({ keyHash, e.sampleRate, e.lastUsedTime });
+    }
+    const auto distance = [sampleRate](double rate) { return std::abs(std::log(rate / sampleRate)); };
+    std::sort(candidates.begin(), candidates.end(), [&](const Candidate& a, const Candidate& b) {
+        const double da = distance(a.sampleRate);
+        const double db = distance(b.sampleRate);
+        return (da != db) ? (da < db) : (a.lastUsedTime > b.lastUsedTime);
+    });
+
+    // ファイルからはセクションだけ読む (IR 本体は読み飛ばす)
+    for (const auto& c : candidates)
+    {
+        juce::FileInputStream stream(getCacheFileForKey(c.keyHash));
+        if (!stream.openedOk())
+            continue;
+
+        DiskHeader header;
+        if (stream.read(&header, sizeof(DiskHeader)) != static_cast<int64>(sizeof(DiskHeader)))
+            continue;
+        if (header.magic != kMagic || header.version != kVersion
+            || header.fileHash != fileHash
+            || header.phaseMode != static_cast<int32_t>(phaseMode)
+            || std::abs(header.freqStartHz - freqStartHz) > 1.0e-6f
+            || std::abs(header.freqEndHz - freqEndHz) > 1.0e-6f
+            || header.sampleRate != c.sampleRate)
+            continue;
+
+        const int numSec = static_cast<int>(header.numAllpassSections);
+        if (numSec <= 0 || header.numChannels <= 0 || header.numSamples <= 0)
+            continue;
+
+        const int64 irBytes = static_cast<int64>(header.numChannels) * header.numSamples
+                              * static_cast<int64>(sizeof(double));
+        if (!stream.setPosition(static_cast<int64>(sizeof(DiskHeader)) + irBytes))
+            continue;
+
+        std::vector<double> rho(static_cast<size_t>(numSec));
+        std::vector<double> theta(static_cast<size_t>(numSec));
+        const auto secBytes = static_cast<int64>(static_cast<size_t>(numSec) * sizeof(double));
+        if (stream.read(rho.data(), static_cast<size_t>(numSec) * sizeof(double)) != secBytes
+            || stream.read(theta.data(), static_cast<size_t>(numSec) * sizeof(double)) != secBytes)
+            continue;
+
+        outSourceRate = header.sampleRate;
+        outRho = std::move(rho);
+        outTheta = std::move(theta);
+        return true;
+    }
+    return false;
+}
+
 // ═══════════════════════════════════════════════════════════════
 //  保存
 // ═══════════════════════════════════════════════════════════════
@@ -187,7 +538,7 @@ bool MixedPhasePersistentCache::save(uint64_t fileHash,
         header.freqStartHz = freqStartHz;
         header.freqEndHz = freqEndHz;
         header.targetLength = static_cast<int32_t>(targetLength);
-        header.lastUsedTime = static_cast<uint64_t>(juce::Time::getMillisecondCounter());
+        header.lastUsedTime = currentUsageTime();
         header.numChannels = static_cast<int32_t>(numChannels);
         header.numSamples = static_cast<int32_t>(numSamples);
         header.numAllpassSections = static_cast<int32_t>(numSec);
@@ -221,7 +572,16 @@ bool MixedPhasePersistentCache::save(uint64_t fileHash,
         stream.flush();
     }
 
-    return tempFile.overwriteTargetFileWithTemporary();
+    if (!tempFile.overwriteTargetFileWithTemporary())
+        return false;
+
+    const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+    ensureIndexLoadedLocked();
+    touchKeyLocked(computeKeyHash(fileHash, sampleRate, phaseMode, freqStartHz, freqEndHz, targetLength),
+                   computeFamilyHash(fileHash, phaseMode, freqStartHz, freqEndHz), sampleRate,
+                   file.getSize(), currentUsageTime());
+    writeIndexFileLocked();
+    return true;
 }
 
 // ═══════════════════════════════════════════════════════════════
@@ -234,40 +594,28 @@ void MixedPhasePersistentCache::touch(uint64_t fileHash,
                                       float freqStartHz, float freqEndHz,
                                       int targetLength)
 {
-    const auto file = getCacheFile(fileHash, sampleRate, phaseMode,
-                                   freqStartHz, freqEndHz, targetLength);
-    if (!file.existsAsFile())
-        return;
-
-    // read-modify-write: ファイル全体を読み込み、ヘッダのタイムスタンプのみ更新して書き戻す
-    // (FileOutputStream で開くとファイルが切り詰められるため、read-modify-write で行う)
-    std::vector<uint8_t> buffer;
-    {
-        juce::FileInputStream inStream(file);
-        if (!inStream.openedOk())
-            return;
+    // 索引の最終使用時刻のみ更新する (キャッシュファイル本体は書き換えない)
+    const uint64_t keyHash = computeKeyHash(fileHash, sampleRate, phaseMode,
+                                            freqStartHz, freqEndHz, targetLength);
 
-        const auto fileSize = file.getSize();
-        if (fileSize <= 0)
-            return;
+    const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+    ensureIndexLoadedLocked();
 
-        buffer.resize(static_cast<size_t>(fileSize));
-        if (inStream.read(buffer.data(), static_cast<int>(buffer.size())) != static_cast<int64>(buffer.size()))
+    auto& index = cacheIndex();
+    if (index.entries.count(keyHash) == 0)
+    {
+        const auto file = getCacheFileForKey(keyHash);
+        if (!file.existsAsFile())
             return;
-    } // inStream はここで破棄され、ファイルも閉じられる
-
-    // DiskHeader 内 lastUsedTime のオフセットをコンパイル時に計算
-    const size_t lastUsedTimeOffset = offsetof(DiskHeader, lastUsedTime);
-    if (lastUsedTimeOffset + sizeof(uint64_t) > buffer.size())
-        return;
-
-    const uint64_t now = static_cast<uint64_t>(juce::Time::getMillisecondCounter());
-    std::memcpy(&buffer[lastUsedTimeOffset], &now, sizeof(now));
-
-    juce::FileOutputStream outStream(file);
-    if (!outStream.openedOk())
-        return;
-    outStream.write(buffer.data(), buffer.size());
+        touchKeyLocked(keyHash, computeFamilyHash(fileHash, phaseMode, freqStartHz, freqEndHz), sampleRate,
+                       file.getSize(), currentUsageTime());
+    }
+    else
+    {
+        touchKeyLocked(keyHash, computeFamilyHash(fileHash, phaseMode, freqStartHz, freqEndHz), sampleRate,
+                       -1, currentUsageTime());
+    }
+    writeIndexFileLocked();
 }
 
 void MixedPhasePersistentCache::evictLRU(size_t maxCount)
@@ -278,39 +626,20 @@ void MixedPhasePersistentCache::evictLRU(size_t maxCount)
         return;
     }
 
-    auto dir = getCacheDirectory();
-    juce::Array<juce::File> files;
-    dir.findChildFiles(files, juce::File::findFiles, false, "*.mph");
+    const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+    ensureIndexLoadedLocked();
 
-    if (static_cast<size_t>(files.size()) <= maxCount)
+    auto& index = cacheIndex();
+    if (index.entries.size() <= maxCount)
         return;
 
-    // 各ファイルのヘッダから lastUsedTime を読み、古い順にソート
-    // (OSのファイルアクセス時刻は無効化されている可能性があるためヘッダの値を使用する)
-    std::vector<std::pair<uint64_t, juce::File>> timedFiles;
-    timedFiles.reserve(static_cast<size_t>(files.size()));
-
-    for (const auto& f : files)
+    while (index.entries.size() > maxCount)
     {
-        juce::FileInputStream stream(f);
-        if (!stream.openedOk())
-            continue;
-
-        DiskHeader header;
-        if (stream.read(&header, sizeof(DiskHeader)) != static_cast<int64>(sizeof(DiskHeader)))
-            continue;
-        if (header.magic != kMagic)
-            continue;
-
-        timedFiles.emplace_back(header.lastUsedTime, f);
+        const uint64_t oldest = index.lruList.back();
+        getCacheFileForKey(oldest).deleteFile();
+        forgetKeyLocked(oldest);
     }
-
-    std::sort(timedFiles.begin(), timedFiles.end(),
-              [](const auto& a, const auto& b) { return a.first < b.first; });
-
-    const int toRemove = static_cast<int>(timedFiles.size()) - static_cast<int>(maxCount);
-    for (int i = 0; i < toRemove; ++i)
-        timedFiles[static_cast<size_t>(i)].second.deleteFile();
+    writeIndexFileLocked();
 }
 
 void MixedPhasePersistentCache::remove(uint64_t fileHash,
@@ -319,10 +648,16 @@ void MixedPhasePersistentCache::remove(uint64_t fileHash,
                                        float freqStartHz, float freqEndHz,
                                        int targetLength)
 {
-    const auto file = getCacheFile(fileHash, sampleRate, phaseMode,
-                                   freqStartHz, freqEndHz, targetLength);
+    const uint64_t keyHash = computeKeyHash(fileHash, sampleRate, phaseMode,
+                                            freqStartHz, freqEndHz, targetLength);
+    const auto file = getCacheFileForKey(keyHash);
     if (file.existsAsFile())
         file.deleteFile();
+
+    const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+    ensureIndexLoadedLocked();
+    forgetKeyLocked(keyHash);
+    writeIndexFileLocked();
 }
 
 void MixedPhasePersistentCache::clear()
@@ -331,21 +666,25 @@ void MixedPhasePersistentCache::clear()
     if (!dir.exists())
         return;
 
+    const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+
     juce::Array<juce::File> files;
     dir.findChildFiles(files, juce::File::findFiles, false, "*.mph");
     for (auto& f : files)
         f.deleteFile();
+
+    auto& index = cacheIndex();
+    index.entries.clear();
+    index.lruList.clear();
+    index.loaded = true;
+    writeIndexFileLocked();
 }
 
 size_t MixedPhasePersistentCache::getEntryCount()
 {
-    auto dir = getCacheDirectory();
-    if (!dir.exists())
-        return 0;
-
-    juce::Array<juce::File> files;
-    dir.findChildFiles(files, juce::File::findFiles, false, "*.mph");
-    return static_cast<size_t>(files.size());
+    const std::lock_guard<std::mutex> lock(cacheIndex().mutex);
+    ensureIndexLoadedLocked();
+    return cacheIndex().entries.size();
 }
 
 } // namespace convo
@@ -13,6 +13,10 @@ struct SecondOrderAllpass;
     MixedPhasePersistentCache: 最適化済み MixedPhase IR のディスク永続化キャッシュ。
     CMA-ES/GreedyAdaGrad による位相最適化結果を %APPDATA%/ConvoPeq/MixedPhaseCache/ に保存し、
     次回起動時の再最適化をスキップする。
+
+    LRU 管理 (touch / evictLRU / getEntryCount) は同ディレクトリの索引ファイル (index.mpi:
+    キー・サイズ・最終使用時刻・系列ハッシュ・レート) をメモリに保持して行い、キャッシュファイルを走査・再書き込みしない。
+    索引は tmp→置換で更新し、欠落・破損時のみ各ファイルの DiskHeader から再構築する。
 */
 class MixedPhasePersistentCache
 {
@@ -34,6 +38,17 @@ public:
                      std::vector<double>& outRho,
                      std::vector<double>& outTheta);
 
+    // ★ 同じ IR・位相モード・遷移帯域で別レートに保存された設計 (allpass セクション) を探す。
+    //   レート比が最も近いもの (同率なら最近使用) を 1 つ返し、outSourceRate にそのレートを入れる。
+    //   IR 本体は読まない。ウォームスタート (AllpassDesigner::rescaleToSampleRate) の種に使う
+    static bool loadDesignForOtherRate(uint64_t fileHash,
+                                       double sampleRate,
+                                       int phaseMode,
+                                       float freqStartHz, float freqEndHz,
+                                       double& outSourceRate,
+                                       std::vector<double>& outRho,
+                                       std::vector<double>& outTheta);
+
     static bool save(uint64_t fileHash,
                      double sampleRate,
                      int phaseMode,
@@ -91,6 +106,23 @@ private:
                                    int phaseMode,
                                    float freqStartHz, float freqEndHz,
                                    int targetLength);
+
+    // レートと targetLength を除いたキー (索引で別レートの設計を引く)
+    static uint64_t computeFamilyHash(uint64_t fileHash,
+                                      int phaseMode,
+                                      float freqStartHz, float freqEndHz);
+
+    static juce::File getCacheFileForKey(uint64_t keyHash);
+    static juce::File getIndexFile();
+
+    // 索引 (呼び出し側が索引 mutex を保持)
+    static void ensureIndexLoadedLocked();
+    static bool readIndexFileLocked();
+    static void rebuildIndexFromHeadersLocked();
+    static void writeIndexFileLocked();
+    static void touchKeyLocked(uint64_t keyHash, uint64_t familyHash, double sampleRate,
+                               int64_t sizeBytes, uint64_t lastUsedTime);
+    static void forgetKeyLocked(uint64_t keyHash);
 };
 
 } // namespace convo
@@ -8,11 +8,12 @@
 #include <limits>
 
 #include "AlignedAllocation.h"
+#include "RealFft.h"
 
-// [v2.1] MKL DFTI を Intel IPP に換装。
+// [v2.1] MKL DFTI を Intel IPP に換装。以後 FFT は RealFft.h 経由 (サイズ別に IPP / DFTI を実測で選ぶ)。
 // 64 byte アラインの確保は convo::aligned_malloc / aligned_free に統一する。
 #include <mkl.h>
-#include <ipp.h>  // ippsFFTFwd_RToCCS_64f, IppsFFTSpec_R_64f
+#include <ipp.h>  // ippsMalloc_8u (FFT スクラッチ)
 
 class MklFftEvaluator
 {
@@ -21,6 +22,15 @@ public:
     static constexpr int kSpectrumBins = (kFftLength / 2) + 1;  // = 2049
     static constexpr double kDefaultSampleRateHz = 48000.0;
     static constexpr int kBarkBandCount = 24;
+    // evaluateBatch() が 1 回の呼び出しで保持するパワースペクトル数 (超過分は分割して処理)
+    static constexpr int kMaxBatchSegments = 8;
+
+    // ★ 予備選別 (evaluateScreeningBatch) の忠実度: 誤差の先頭 kScreeningFftLength 点だけを float で FFT し、
+    //   ビン k は本評価のビン k * kScreeningBinStride と同じ周波数になる
+    static constexpr int kScreeningFftLength = 1024;
+    static constexpr int kScreeningSpectrumBins = (kScreeningFftLength / 2) + 1;  // = 513
+    static constexpr int kScreeningBinStride = kFftLength / kScreeningFftLength;   // = 4
+    static constexpr int kScreeningBarkBandCount = 12;
 
     // [v2.1] MKL_Complex16 の代替。標準レイアウト構造体。
     // メモリ配置: { double real; double im; } = 16バイト。
@@ -56,72 +66,42 @@ public:
         spectrumLeft  = convo::makeAlignedArray<CcsComplex>(kSpectrumBins).release();
         spectrumRight = convo::makeAlignedArray<CcsComplex>(kSpectrumBins).release();
 
-        // [v2.1] IPP FFT スペック初期化
-        // kFftLength = 4096 = 2^12 → order = 12
-        // IPP_FFT_NODIV_BY_ANY: forward に正規化なし (evaluate は forward のみ使用)
-        // ippAlgHintFast: 速度優先ヒント
+        // evaluateBatch 用: セグメント別パワースペクトルとその dB 値 ([segment][bin] 連続配置)
+        batchPower   = convo::makeAlignedArray<double>(static_cast<size_t>(kMaxBatchSegments) * kSpectrumBins).release();
+        batchPowerDb = convo::makeAlignedArray<double>(static_cast<size_t>(kMaxBatchSegments) * kSpectrumBins).release();
+
+        // FFT プラン: kFftLength = 4096 = 2^12。プロセス共有キャッシュから取る (実装は FftBackendWisdom の実測で
+        // IPP / MKL DFTI を選ぶ)。FftScaling::None: forward に正規化なし (evaluate は forward のみ使用)
         constexpr int kOrder = 12; // log2(4096)
         static_assert((1 << kOrder) == kFftLength, "kOrder must be log2(kFftLength)");
 
-        int sizeSpec = 0, sizeInit = 0, sizeWork = 0;
-        const IppStatus getSt = ippsFFTGetSize_R_64f(
-            kOrder, IPP_FFT_NODIV_BY_ANY, ippAlgHintFast,
-            &sizeSpec, &sizeInit, &sizeWork);
-
-        if (getSt == ippStsNoErr)
+        fftPlan = convo::RealFftPlanCache::getOrCreate(kOrder, convo::FftScaling::None);
+        if (fftPlan == nullptr)
+        {
+            DBG("MklFftEvaluator: RealFftPlanCache::getOrCreate failed");
+        }
+        else if (const size_t workBytes = fftPlan->getWorkBytes(); workBytes > 0)
         {
-            fftSpecBuf = ippsMalloc_8u(sizeSpec);
-
-            Ipp8u* initBuf = (sizeInit > 0) ? ippsMalloc_8u(sizeInit) : nullptr;
-
-            // [Bug 2 fix] ippsFFTInit_R_64f の戻り値と fftSpec の null を明示チェック。
-            // 失敗時は fftSpec を nullptr のまま残し、evaluate()/computeFft() 冒頭の
-            // ガードで早期リターンさせる。
-            if (fftSpecBuf)
-            {
-                const IppStatus initSt = ippsFFTInit_R_64f(
-                    &fftSpec, kOrder, IPP_FFT_NODIV_BY_ANY, ippAlgHintFast,
-                    fftSpecBuf, initBuf);
-
-                if (initSt != ippStsNoErr || fftSpec == nullptr)
-                {
-                    // 初期化失敗 → fftSpec を安全に nullptr にリセット
-                    // fftSpecBuf はデストラクタで解放
-                    fftSpec = nullptr;
-                    DBG("MklFftEvaluator: ippsFFTInit_R_64f failed (status="
-                        + juce::String(static_cast<int>(initSt)) + ")");
-                }
-            }
-            if (initBuf) { ippsFree(initBuf); }
-
             // [Bug 3 fix] fftWorkBuf 確保失敗時のガード。
-            // sizeWork > 0 かつ ippsMalloc が nullptr を返した場合、
-            // nullptr を IPP に渡すと未定義動作になるため、fftSpec を無効化して
+            // 必要なスクラッチを渡せないと未定義動作になるため、fftPlan を無効化して
             // evaluate()/computeFft() 冒頭のガードで早期リターンさせる。
-            if (sizeWork > 0)
+            fftWorkBuf = ippsMalloc_8u(static_cast<int>(workBytes));
+            if (!fftWorkBuf)
             {
-                fftWorkBuf = ippsMalloc_8u(sizeWork);
-                if (!fftWorkBuf)
-                {
-                    fftSpec = nullptr;  // FFT 不使用状態に落とす
-                    DBG("MklFftEvaluator: ippsMalloc_8u(sizeWork="
-                        + juce::String(sizeWork) + ") failed");
-                }
+                fftPlan = nullptr;  // FFT 不使用状態に落とす
+                DBG("MklFftEvaluator: ippsMalloc_8u(workBytes="
+                    + juce::String(static_cast<int>(workBytes)) + ") failed");
             }
         }
 
+        initScreeningFft();
         configureForSampleRate(kDefaultSampleRateHz);
     }
 
     ~MklFftEvaluator()
     {
-        // [v2.1] IPP FFT リソース解放
-        if (fftSpecBuf)
-        {
-            ippsFree(fftSpecBuf);
-            fftSpecBuf = nullptr;
-            fftSpec    = nullptr;
-        }
+        // プラン本体はキャッシュの所有物。スクラッチのみ解放する
+        fftPlan = nullptr;
         if (fftWorkBuf)
         {
             ippsFree(fftWorkBuf);
@@ -132,6 +112,14 @@ public:
         if (inputRight  != nullptr) convo::aligned_free(inputRight);
         if (spectrumLeft  != nullptr) convo::aligned_free(spectrumLeft);
         if (spectrumRight != nullptr) convo::aligned_free(spectrumRight);
+        if (batchPower    != nullptr) convo::aligned_free(batchPower);
+        if (batchPowerDb  != nullptr) convo::aligned_free(batchPowerDb);
+
+        screeningSpec = nullptr;
+        if (screeningSpecBuf) ippsFree(screeningSpecBuf);
+        if (screeningWorkBuf) ippsFree(screeningWorkBuf);
+        if (screeningInput    != nullptr) convo::aligned_free(screeningInput);
+        if (screeningSpectrum != nullptr) convo::aligned_free(screeningSpectrum);
     }
 
     void configureForSampleRate(double sampleRateHz) noexcept
@@ -225,6 +213,7 @@ public:
             barkHz[static_cast<size_t>(bin)] = bark;
             athThresholdDb[static_cast<size_t>(bin)] = athDb;
             athThresholdPower[static_cast<size_t>(bin)] = dbToPower(athDb);
+            jndWeights[static_cast<size_t>(bin)] = computeJndWeight(computeJndDb(frequencyHz));
             neighborRangeBins[static_cast<size_t>(bin)] = computeNeighborRangeHz(frequencyHz, binWidthHz);
 
             int band = static_cast<int>(bark / barkStep);
@@ -233,160 +222,119 @@ public:
         }
 
         windowCorrection = 1.0;
+        configureScreening(binWidthHz * static_cast<double>(kScreeningBinStride));
     }
 
     Result evaluate(const double* errorLeft,
                     const double* errorRight,
                     const std::array<double, kSpectrumBins>* maskingThresholds = nullptr) noexcept
     {
-        // [v2.1] IPP は完全シングルスレッド設計のため、
+        Result result;
+        evaluateBatch(&errorLeft, &errorRight, 1, &maskingThresholds, &result);
+        return result;
+    }
+
+    // ★ count 個の誤差セグメント (L/R 各 kFftLength) をまとめて評価し results[0, count) に書く。
+    //   maskingThresholds は nullptr (全セグメントなし) またはセグメント別ポインタ配列 (要素 nullptr 可)。
+    //   結果は evaluate() を count 回呼んだ場合とビット一致する。
+    //
+    //   1) FFT (IPP、スペックとワークバッファを共有) → 直後に L/R 平均パワーへ縮約し、
+    //      [segment][bin] 連続のパワースペクトル配列へ置く (複素スペクトルは 1 組だけ使い回す)
+    //   2) 全セグメント分のパワー → dB をまとめて変換 (連続配列上の単純ループ)
+    //   3) セグメントごとにマスカー検出・Bark 帯域集計 (1 パス)・心理音響スコア
+    //   同じ閾値ポインタが続く場合は閾値の dB 変換を使い回す (NoiseShaperLearner の候補バッチ)。
+    void evaluateBatch(const double* const* errorLeft,
+                       const double* const* errorRight,
+                       int count,
+                       const std::array<double, kSpectrumBins>* const* maskingThresholds,
+                       Result* results) noexcept
+    {
+        // FFT は IPP / DFTI (DFTI_THREAD_LIMIT=1) のどちらでも呼び出しスレッドのみで計算するため、
         // mkl_set_num_threads_local(1) の呼び出しは不要。
 
-        // [Bug 2/3 fix] IPP 初期化失敗時の安全フォールバック。
-        // fftSpec == nullptr は constructor でのエラー (OOM等) を示す。
+        // [Bug 2/3 fix] FFT 初期化失敗時の安全フォールバック。
+        // fftPlan == nullptr は constructor でのエラー (OOM等) を示す。
         // クラッシュを防ぐため、ゼロ結果を返す。
-        if (fftSpec == nullptr || inputLeft == nullptr || inputRight == nullptr
-            || spectrumLeft == nullptr || spectrumRight == nullptr)
-            return Result{};
-
-        double sumSq = 0.0;
-        for (int i = 0; i < kFftLength; ++i)
+        if (fftPlan == nullptr || inputLeft == nullptr || inputRight == nullptr
+            || spectrumLeft == nullptr || spectrumRight == nullptr
+            || batchPower == nullptr || batchPowerDb == nullptr)
         {
-            sumSq += 0.5 * (errorLeft[i] * errorLeft[i] + errorRight[i] * errorRight[i]);
+            for (int k = 0; k < count; ++k)
+                results[k] = Result{};
+            return;
         }
-        const double timeRms = std::sqrt(sumSq / kFftLength);
-
-        juce::FloatVectorOperations::copy(inputLeft,  errorLeft,  kFftLength);
-        juce::FloatVectorOperations::copy(inputRight, errorRight, kFftLength);
 
-        // [v2.1] Forward FFT: real → CCS
-        // 出力は CcsComplex 配列に直接書き込む (reinterpret_cast 安全: 同一メモリレイアウト)
-        ippsFFTFwd_RToCCS_64f(inputLeft,  reinterpret_cast<Ipp64f*>(spectrumLeft),  fftSpec, fftWorkBuf);
-        ippsFFTFwd_RToCCS_64f(inputRight, reinterpret_cast<Ipp64f*>(spectrumRight), fftSpec, fftWorkBuf);
+        const std::array<double, kSpectrumBins>* cachedThresholds = nullptr;
+        std::array<double, kSpectrumBins> thresholdFloorDb {};
 
-        std::array<double, kSpectrumBins> averagePower {};
-
-        double flatnessLogSum = 0.0;
-        double flatnessPowerSum = 0.0;
-        double highBandEnergy = 0.0;
-        double ultraHighEnergy = 0.0;
-        double peakEnergy = 0.0;
-        double totalEnergy = 0.0;
-        int flatnessBins = 0;
-
-        for (int bin = 0; bin < kSpectrumBins; ++bin)
+        for (int first = 0; first < count; first += kMaxBatchSegments)
         {
-            // [v2.1] MKL_Complex16 の .real/.imag → CcsComplex の .real/.imag
-            // CcsComplex は同名メンバを持つため、元のコードとの差分なし。
-            const double magSqLeft  = spectrumLeft[bin].real  * spectrumLeft[bin].real
-                                    + spectrumLeft[bin].imag  * spectrumLeft[bin].imag;
-            const double magSqRight = spectrumRight[bin].real * spectrumRight[bin].real
-                                    + spectrumRight[bin].imag * spectrumRight[bin].imag;
-            const double averageMagSq = std::max(kMinPower, 0.5 * (magSqLeft + magSqRight) * windowCorrection);
-            const double safeMagSq = averageMagSq + kMinPower;
-
-            averagePower[static_cast<size_t>(bin)] = averageMagSq;
-            totalEnergy += averageMagSq;
-
-            if (bin >= flatnessStartBin && bin <= flatnessEndBin)
-            {
-                flatnessLogSum += std::log(safeMagSq);
-                flatnessPowerSum += safeMagSq;
-                ++flatnessBins;
-            }
+            const int chunk = std::min(kMaxBatchSegments, count - first);
 
-            if (bin >= highBandStartBin)
-                highBandEnergy += averageMagSq;
+            SpectrumStats stats[kMaxBatchSegments];
+            for (int k = 0; k < chunk; ++k)
+                stats[k] = computePowerSpectrum(errorLeft[first + k], errorRight[first + k],
+                                                batchPower + static_cast<size_t>(k) * kSpectrumBins);
 
-            if (bin >= ultraHighStartBin)
-                ultraHighEnergy += averageMagSq;
+            const int totalBins = chunk * kSpectrumBins;
+            for (int i = 0; i < totalBins; ++i)
+                batchPowerDb[i] = powerToDb(batchPower[i]);
 
-            if (bin > 0 && bin < kSpectrumBins - 1)
+            for (int k = 0; k < chunk; ++k)
             {
-                const double prevMagSq = 0.5 * (
-                    (spectrumLeft[bin-1].real  * spectrumLeft[bin-1].real  + spectrumLeft[bin-1].imag  * spectrumLeft[bin-1].imag) +
-                    (spectrumRight[bin-1].real * spectrumRight[bin-1].real + spectrumRight[bin-1].imag * spectrumRight[bin-1].imag));
-                const double nextMagSq = 0.5 * (
-                    (spectrumLeft[bin+1].real  * spectrumLeft[bin+1].real  + spectrumLeft[bin+1].imag  * spectrumLeft[bin+1].imag) +
-                    (spectrumRight[bin+1].real * spectrumRight[bin+1].real + spectrumRight[bin+1].imag * spectrumRight[bin+1].imag));
-
-                const double localAvg = 0.5 * (prevMagSq + nextMagSq) + kMinPower;
-                if (averageMagSq > 6.0 * localAvg)
-                    peakEnergy = std::max(peakEnergy, averageMagSq);
-            }
-        }
-
-        MaskerBuffer tonalMaskers;
-        std::array<bool, kSpectrumBins> tonalConsumed {};
-        detectTonalMaskersFixed(averagePower, tonalMaskers, tonalConsumed);
-
-        MaskerBuffer noiseMaskers;
-        buildNoiseMaskersFixed(averagePower, tonalConsumed, noiseMaskers);
-
-        MaskerBuffer allMaskers;
-        for (int i = 0; i < tonalMaskers.size; ++i)
-            allMaskers.push(tonalMaskers.data[static_cast<size_t>(i)]);
-        for (int i = 0; i < noiseMaskers.size; ++i)
-            allMaskers.push(noiseMaskers.data[static_cast<size_t>(i)]);
-
-        std::array<double, kSpectrumBins> maskingEnergy {};
-        computeMaskingEnergyStable(allMaskers, maskingEnergy);
+                const auto* thresholds = (maskingThresholds != nullptr) ? maskingThresholds[first + k] : nullptr;
+                if (thresholds != nullptr && thresholds != cachedThresholds)
+                {
+                    for (int bin = 0; bin < kSpectrumBins; ++bin)
+                        thresholdFloorDb[static_cast<size_t>(bin)] = powerToDb(std::max((*thresholds)[static_cast<size_t>(bin)], kMinPower));
+                    cachedThresholds = thresholds;
+                }
 
-        std::array<double, kSpectrumBins> thresholdDb {};
-        for (int bin = 0; bin < kSpectrumBins; ++bin)
-        {
-            const size_t idx = static_cast<size_t>(bin);
-            double threshold = std::max(powerToDb(maskingEnergy[idx]), athThresholdDb[idx]);
-            if (maskingThresholds != nullptr)
-                threshold = std::max(threshold, powerToDb(std::max((*maskingThresholds)[idx], kMinPower)));
-            thresholdDb[idx] = threshold;
+                results[first + k] = scorePowerSpectrum(batchPower + static_cast<size_t>(k) * kSpectrumBins,
+                                                        batchPowerDb + static_cast<size_t>(k) * kSpectrumBins,
+                                                        stats[k],
+                                                        (thresholds != nullptr) ? thresholdFloorDb.data() : nullptr);
+            }
         }
+    }
 
-        double psychoWeighted = 0.0;
-        double psychoWeightSum = 0.0;
-        for (int bin = 0; bin < kSpectrumBins; ++bin)
+    // ★ 予備選別: evaluateBatch と同じ引数で、同じ Result の尺度の安い近似スコアを返す (順位付け専用)。
+    //   - 誤差は先頭 kScreeningFftLength 点だけを使う (時間 RMS も同じ範囲)。FFT と採点は float
+    //   - L/R 平均パワーを kScreeningBinStride 倍し、本評価のビンあたりパワーに揃える (ATH・外部閾値をそのまま比べられる)
+    //   - マスカーは kScreeningBarkBandCount 帯域の雑音マスカーだけ (トーン性マスカーの検出と帯域 SFM を省く)。
+    //     帯域中心からの拡散利得は configureForSampleRate が [band][bin] の表にしておく
+    //   - 外部マスキング閾値は同じ周波数の本評価ビン (k * kScreeningBinStride) を下限に使う
+    //   NoiseShaperLearner は上位の候補だけを evaluateBatch へ進める (ScreeningFidelityGate.h)。
+    //   予備選別の FFT を用意できなかった場合 (hasScreeningFidelity() == false) はゼロ結果を返す
+    void evaluateScreeningBatch(const double* const* errorLeft,
+                                const double* const* errorRight,
+                                int count,
+                                const std::array<double, kSpectrumBins>* const* maskingThresholds,
+                                Result* results) noexcept
+    {
+        for (int k = 0; k < count; ++k)
         {
-            const size_t idx = static_cast<size_t>(bin);
-            const double signalDb = powerToDb(averagePower[idx]);
-            const double deltaDb = signalDb - thresholdDb[idx];
-            const double jndWeight = computeJndWeight(computeJndDb(freqHz[idx]));
-            const double effectiveDb = smoothCap(softplus(deltaDb), kEffectiveCapDb);
-            const double effectivePower = std::max(0.0, dbToPower(effectiveDb) - 1.0);
-            const double weight = weights[idx] * jndWeight;
-
-            psychoWeighted += weight * effectivePower;
-            psychoWeightSum += weight;
+            results[k] = hasScreeningFidelity()
+                ? scoreScreeningSegment(errorLeft[k], errorRight[k],
+                                        (maskingThresholds != nullptr) ? maskingThresholds[k] : nullptr)
+                : Result{};
         }
+    }
 
+    Result evaluateScreening(const double* errorLeft,
+                             const double* errorRight,
+                             const std::array<double, kSpectrumBins>* maskingThresholds = nullptr) noexcept
+    {
         Result result;
-        result.noisePower = (psychoWeightSum > kMinPower)
-                          ? ((psychoWeighted / psychoWeightSum) * static_cast<double>(kFftLength))
-                          : 0.0;
-
-        if (flatnessBins > 0)
-        {
-            const double arithmeticMean = flatnessPowerSum / static_cast<double>(flatnessBins);
-            const double geometricMean = std::exp(flatnessLogSum / static_cast<double>(flatnessBins));
-            const double flatness = std::clamp(geometricMean / std::max(arithmeticMean, kMinPower), 0.0, 1.0);
-            result.spectralFlatnessPenalty = 1.0 - flatness;
-        }
-
-        const double observedUltraHighShare = ultraHighEnergy / std::max(highBandEnergy + kMinPower, kMinPower);
-        const double excessUltraHighShare = std::max(0.0, observedUltraHighShare - expectedUltraHighShare);
-        result.hfPenalty = excessUltraHighShare / std::max(1.0 - expectedUltraHighShare, kMinPower);
-        result.timeDomainRms = timeRms;
-
-        const double tonalRatio = peakEnergy / (totalEnergy + kMinPower);
-        const double tonalPenalty = std::max(0.0, tonalRatio - 0.05) * 10.0;
-
-        result.compositeScore = result.noisePower
-                              * (1.0
-                                 + (flatnessPenaltyWeight * result.spectralFlatnessPenalty)
-                                 + (hfPenaltyWeight * result.hfPenalty)
-                                 + tonalPenalty);
+        evaluateScreeningBatch(&errorLeft, &errorRight, 1, &maskingThresholds, &result);
         return result;
     }
 
+    [[nodiscard]] bool hasScreeningFidelity() const noexcept
+    {
+        return screeningSpec != nullptr && screeningInput != nullptr && screeningSpectrum != nullptr;
+    }
+
     double computeMaskingThreshold(double energy, double freq) const noexcept
     {
         const double safeEnergy = std::max(energy, kMinPower);
@@ -404,8 +352,8 @@ public:
     void computeFft(const double* dataL, const double* dataR,
                     CcsComplex* outL, CcsComplex* outR) noexcept
     {
-        // [Bug 2/3 fix] IPP 初期化失敗時のガード。出力をゼロクリアして返す。
-        if (fftSpec == nullptr || inputLeft == nullptr || inputRight == nullptr)
+        // [Bug 2/3 fix] FFT 初期化失敗時のガード。出力をゼロクリアして返す。
+        if (fftPlan == nullptr || inputLeft == nullptr || inputRight == nullptr)
         {
             if (outL) std::memset(outL, 0, sizeof(CcsComplex) * kSpectrumBins);
             if (outR) std::memset(outR, 0, sizeof(CcsComplex) * kSpectrumBins);
@@ -415,9 +363,9 @@ public:
         juce::FloatVectorOperations::copy(inputLeft,  dataL, kFftLength);
         juce::FloatVectorOperations::copy(inputRight, dataR, kFftLength);
         // CcsComplex は [double real, double im] の標準レイアウト構造体。
-        // IPP CCS 出力 [re0,im0,...] と同一メモリ配置のため reinterpret_cast 安全。
-        ippsFFTFwd_RToCCS_64f(inputLeft,  reinterpret_cast<Ipp64f*>(outL), fftSpec, fftWorkBuf);
-        ippsFFTFwd_RToCCS_64f(inputRight, reinterpret_cast<Ipp64f*>(outR), fftSpec, fftWorkBuf);
+        // CCS 出力 [re0,im0,...] と同一メモリ配置のため reinterpret_cast 安全。
+        fftPlan->forward(inputLeft,  reinterpret_cast<double*>(outL), fftWorkBuf);
+        fftPlan->forward(inputRight, reinterpret_cast<double*>(outR), fftWorkBuf);
     }
 
 private:
@@ -477,6 +425,8 @@ private:
         return table;
     }();
 
+    static constexpr int kScreeningSpreadTaps = 8;   // configureScreening: 帯域内で拡散を平均する点数
+
     static constexpr int kMaxMaskers = 128;
     static constexpr int kMaxContributions = 256;
 
@@ -612,6 +562,357 @@ private:
         return std::clamp(range, 1, 24);
     }
 
+    // パワースペクトル 1 本分の集計値 (scorePowerSpectrum へ渡す)
+    struct SpectrumStats
+    {
+        double timeRms = 0.0;
+        double flatnessLogSum = 0.0;
+        double flatnessPowerSum = 0.0;
+        double highBandEnergy = 0.0;
+        double ultraHighEnergy = 0.0;
+        double peakEnergy = 0.0;
+        double totalEnergy = 0.0;
+        int flatnessBins = 0;
+    };
+
+    // L/R を FFT し、平均パワー (kMinPower 下限) を power[0, kSpectrumBins) に書く
+    SpectrumStats computePowerSpectrum(const double* errorLeft, const double* errorRight, double* power) noexcept
+    {
+        SpectrumStats stats;
+
+        double sumSq = 0.0;
+        for (int i = 0; i < kFftLength; ++i)
+        {
+            sumSq += 0.5 * (errorLeft[i] * errorLeft[i] + errorRight[i] * errorRight[i]);
+        }
+        stats.timeRms = std::sqrt(sumSq / kFftLength);
+
+        juce::FloatVectorOperations::copy(inputLeft,  errorLeft,  kFftLength);
+        juce::FloatVectorOperations::copy(inputRight, errorRight, kFftLength);
+
+        // [v2.1] Forward FFT: real → CCS
+        // 出力は CcsComplex 配列に直接書き込む (reinterpret_cast 安全: 同一メモリレイアウト)
+        fftPlan->forward(inputLeft,  reinterpret_cast<double*>(spectrumLeft),  fftWorkBuf);
+        fftPlan->forward(inputRight, reinterpret_cast<double*>(spectrumRight), fftWorkBuf);
+
+        // L/R 平均 |X|² (下限なし)。ピーク判定の近傍平均はこちらを使う
+        alignas(64) double rawPower[kSpectrumBins];
+        for (int bin = 0; bin < kSpectrumBins; ++bin)
+        {
+            const double magSqLeft  = spectrumLeft[bin].real  * spectrumLeft[bin].real
+                                    + spectrumLeft[bin].imag  * spectrumLeft[bin].imag;
+            const double magSqRight = spectrumRight[bin].real * spectrumRight[bin].real
+                                    + spectrumRight[bin].imag * spectrumRight[bin].imag;
+            rawPower[bin] = 0.5 * (magSqLeft + magSqRight);
+        }
+
+        for (int bin = 0; bin < kSpectrumBins; ++bin)
+        {
+            const double averageMagSq = std::max(kMinPower, rawPower[bin] * windowCorrection);
+            const double safeMagSq = averageMagSq + kMinPower;
+
+            power[bin] = averageMagSq;
+            stats.totalEnergy += averageMagSq;
+
+            if (bin >= flatnessStartBin && bin <= flatnessEndBin)
+            {
+                stats.flatnessLogSum += std::log(safeMagSq);
+                stats.flatnessPowerSum += safeMagSq;
+                ++stats.flatnessBins;
+            }
+
+            if (bin >= highBandStartBin)
+                stats.highBandEnergy += averageMagSq;
+
+            if (bin >= ultraHighStartBin)
+                stats.ultraHighEnergy += averageMagSq;
+
+            if (bin > 0 && bin < kSpectrumBins - 1)
+            {
+                const double localAvg = 0.5 * (rawPower[bin - 1] + rawPower[bin + 1]) + kMinPower;
+                if (averageMagSq > 6.0 * localAvg)
+                    stats.peakEnergy = std::max(stats.peakEnergy, averageMagSq);
+            }
+        }
+
+        return stats;
+    }
+
+    // power / powerDb: 1 セグメント分 (kSpectrumBins)。thresholdFloorDb: 外部マスキング閾値の dB (nullptr 可)
+    Result scorePowerSpectrum(const double* power,
+                              const double* powerDb,
+                              const SpectrumStats& stats,
+                              const double* thresholdFloorDb) const noexcept
+    {
+        MaskerBuffer tonalMaskers;
+        std::array<bool, kSpectrumBins> tonalConsumed {};
+        detectTonalMaskersFixed(power, powerDb, tonalMaskers, tonalConsumed);
+
+        MaskerBuffer noiseMaskers;
+        buildNoiseMaskersFixed(power, tonalConsumed, noiseMaskers);
+
+        MaskerBuffer allMaskers;
+        for (int i = 0; i < tonalMaskers.size; ++i)
+            allMaskers.push(tonalMaskers.data[static_cast<size_t>(i)]);
+        for (int i = 0; i < noiseMaskers.size; ++i)
+            allMaskers.push(noiseMaskers.data[static_cast<size_t>(i)]);
+
+        std::array<double, kSpectrumBins> maskingEnergy {};
+        computeMaskingEnergyStable(allMaskers, maskingEnergy);
+
+        double psychoWeighted = 0.0;
+        double psychoWeightSum = 0.0;
+        for (int bin = 0; bin < kSpectrumBins; ++bin)
+        {
+            const size_t idx = static_cast<size_t>(bin);
+            double thresholdDb = std::max(powerToDb(maskingEnergy[idx]), athThresholdDb[idx]);
+            if (thresholdFloorDb != nullptr)
+                thresholdDb = std::max(thresholdDb, thresholdFloorDb[idx]);
+
+            const double deltaDb = powerDb[idx] - thresholdDb;
+            const double effectiveDb = smoothCap(softplus(deltaDb), kEffectiveCapDb);
+            const double effectivePower = std::max(0.0, dbToPower(effectiveDb) - 1.0);
+            const double weight = weights[idx] * jndWeights[idx];
+
+            psychoWeighted += weight * effectivePower;
+            psychoWeightSum += weight;
+        }
+
+        Result result;
+        result.noisePower = (psychoWeightSum > kMinPower)
+                          ? ((psychoWeighted / psychoWeightSum) * static_cast<double>(kFftLength))
+                          : 0.0;
+
+        if (stats.flatnessBins > 0)
+        {
+            const double arithmeticMean = stats.flatnessPowerSum / static_cast<double>(stats.flatnessBins);
+            const double geometricMean = std::exp(stats.flatnessLogSum / static_cast<double>(stats.flatnessBins));
+            const double flatness = std::clamp(geometricMean / std::max(arithmeticMean, kMinPower), 0.0, 1.0);
+            result.spectralFlatnessPenalty = 1.0 - flatness;
+        }
+
+        const double observedUltraHighShare = stats.ultraHighEnergy / std::max(stats.highBandEnergy + kMinPower, kMinPower);
+        const double excessUltraHighShare = std::max(0.0, observedUltraHighShare - expectedUltraHighShare);
+        result.hfPenalty = excessUltraHighShare / std::max(1.0 - expectedUltraHighShare, kMinPower);
+        result.timeDomainRms = stats.timeRms;
+
+        const double tonalRatio = stats.peakEnergy / (stats.totalEnergy + kMinPower);
+        const double tonalPenalty = std::max(0.0, tonalRatio - 0.05) * 10.0;
+
+        result.compositeScore = result.noisePower
+                              * (1.0
+                                 + (flatnessPenaltyWeight * result.spectralFlatnessPenalty)
+                                 + (hfPenaltyWeight * result.hfPenalty)
+                                 + tonalPenalty);
+        return result;
+    }
+
+    // 予備選別用の float FFT (IPP, 2^10 点)。失敗時は screeningSpec == nullptr のまま (hasScreeningFidelity() == false)
+    void initScreeningFft() noexcept
+    {
+        constexpr int kScreeningOrder = 10;
+        static_assert((1 << kScreeningOrder) == kScreeningFftLength, "kScreeningOrder must be log2(kScreeningFftLength)");
+
+        screeningInput    = convo::makeAlignedArray_nothrow<float>(kScreeningFftLength).release();
+        screeningSpectrum = convo::makeAlignedArray_nothrow<float>(kScreeningFftLength + 2).release();
+
+        int sizeSpec = 0, sizeInit = 0, sizeWork = 0;
+        if (screeningInput == nullptr || screeningSpectrum == nullptr
+            || ippsFFTGetSize_R_32f(kScreeningOrder, IPP_FFT_NODIV_BY_ANY, ippAlgHintFast,
+                                    &sizeSpec, &sizeInit, &sizeWork) != ippStsNoErr)
+        {
+            DBG("MklFftEvaluator: screening FFT unavailable");
+            return;
+        }
+
+        screeningSpecBuf = ippsMalloc_8u(sizeSpec);
+        screeningWorkBuf = (sizeWork > 0) ? ippsMalloc_8u(sizeWork) : nullptr;
+        Ipp8u* initBuf = (sizeInit > 0) ? ippsMalloc_8u(sizeInit) : nullptr;
+
+        IppsFFTSpec_R_32f* spec = nullptr;
+        const bool buffersReady = screeningSpecBuf != nullptr
+                               && (sizeWork == 0 || screeningWorkBuf != nullptr)
+                               && (sizeInit == 0 || initBuf != nullptr);
+        const IppStatus status = buffersReady
+            ? ippsFFTInit_R_32f(&spec, kScreeningOrder, IPP_FFT_NODIV_BY_ANY, ippAlgHintFast, screeningSpecBuf, initBuf)
+            : ippStsMemAllocErr;
+        if (initBuf)
+            ippsFree(initBuf);
+
+        if (status == ippStsNoErr && spec != nullptr)
+            screeningSpec = spec;
+        else
+            DBG("MklFftEvaluator: ippsFFTInit_R_32f failed");
+    }
+
+    // 本評価の表 (weights / jndWeights / barkHz / athThresholdPower と帯域境界) を引いて予備選別の表を作る。
+    // configureForSampleRate の最後に呼ぶ
+    void configureScreening(double screeningBinWidth) noexcept
+    {
+        screeningBinWidthHz = static_cast<float>(screeningBinWidth);
+
+        const double maxBark = freqToBark(0.5 * configuredSampleRateHz);
+        const double barkStep = std::max(1.0e-9, maxBark / static_cast<double>(kScreeningBarkBandCount));
+
+        screeningWeightSum = 0.0f;
+        for (int bin = 0; bin < kScreeningSpectrumBins; ++bin)
+        {
+            const size_t full = static_cast<size_t>(bin * kScreeningBinStride);
+            const size_t idx = static_cast<size_t>(bin);
+            screeningWeights[idx] = static_cast<float>(weights[full] * jndWeights[full]);
+            screeningWeightSum += screeningWeights[idx];
+            screeningAthPower[idx] = static_cast<float>(athThresholdPower[full]);
+            screeningBinToBand[idx] = std::clamp(static_cast<int>(barkHz[full] / barkStep), 0, kScreeningBarkBandCount - 1);
+
+            // 帯域のエネルギーは帯域幅 (約 2 Bark) に一様に広がっているとみなし、帯域内の
+            // kScreeningSpreadTaps 点からの拡散の平均を利得にする (中心 1 点だと帯域端のビンが 1 Bark 離れ、
+            // 上向き -27 dB/Bark でマスキングを大きく取りこぼす)
+            for (int band = 0; band < kScreeningBarkBandCount; ++band)
+            {
+                double gain = 0.0;
+                for (int tap = 0; tap < kScreeningSpreadTaps; ++tap)
+                {
+                    const double maskerBark = (static_cast<double>(band) + (static_cast<double>(tap) + 0.5) / kScreeningSpreadTaps) * barkStep;
+                    const double deltaBark = barkHz[full] - maskerBark;
+                    if (std::abs(deltaBark) <= kSpreadMaxDeltaBark)
+                        gain += dbToPower(kNoiseMaskerCorrectionBaseDb + spreadingFunctionAnnexD(deltaBark, Noise));
+                }
+                screeningSpreadGain[static_cast<size_t>(band * kScreeningSpectrumBins + bin)]
+                    = static_cast<float>(gain / kScreeningSpreadTaps);
+            }
+        }
+
+        screeningFlatnessStartBin = flatnessStartBin / kScreeningBinStride;
+        screeningFlatnessEndBin = std::max(screeningFlatnessStartBin + 1, flatnessEndBin / kScreeningBinStride);
+        screeningHighBandStartBin = highBandStartBin / kScreeningBinStride;
+        screeningUltraHighStartBin = std::max(screeningHighBandStartBin + 1, ultraHighStartBin / kScreeningBinStride);
+
+        const int highBandBins = std::max(1, kScreeningSpectrumBins - screeningHighBandStartBin);
+        const int ultraHighBins = std::max(1, kScreeningSpectrumBins - screeningUltraHighStartBin);
+        screeningExpectedUltraHighShare = static_cast<double>(ultraHighBins) / static_cast<double>(highBandBins);
+    }
+
+    // scorePowerSpectrum の近似 (float)。加重・ペナルティの式は同じで、マスキングだけ帯域単位に粗くする
+    Result scoreScreeningSegment(const double* errorLeft,
+                                 const double* errorRight,
+                                 const std::array<double, kSpectrumBins>* thresholds) noexcept
+    {
+        constexpr float kMinPowerF = static_cast<float>(kMinPower);
+        constexpr float kLog10FactorF = static_cast<float>(10.0 * 0.43429448190325182765);
+        constexpr float kDbToLogF = static_cast<float>(0.2302585092994046);  // ln(10) / 10
+        constexpr float kPowerScale = 0.5f * static_cast<float>(kScreeningBinStride);
+        constexpr float kCapF = static_cast<float>(kEffectiveCapDb);
+        constexpr float kSoftplusKF = static_cast<float>(kSoftplusK);
+
+        double sumSq = 0.0;
+        for (int i = 0; i < kScreeningFftLength; ++i)
+            sumSq += 0.5 * (errorLeft[i] * errorLeft[i] + errorRight[i] * errorRight[i]);
+
+        // L/R の |X|² を足し込み、平均して本評価のビンあたりパワーへ揃える
+        alignas(64) float rawPower[kScreeningSpectrumBins];
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const double* source = (channel == 0) ? errorLeft : errorRight;
+            for (int i = 0; i < kScreeningFftLength; ++i)
+                screeningInput[i] = static_cast<float>(source[i]);
+            ippsFFTFwd_RToCCS_32f(screeningInput, screeningSpectrum, screeningSpec, screeningWorkBuf);
+
+            for (int bin = 0; bin < kScreeningSpectrumBins; ++bin)
+            {
+                const float re = screeningSpectrum[2 * bin];
+                const float im = screeningSpectrum[2 * bin + 1];
+                rawPower[bin] = (channel == 0) ? (re * re + im * im) : (rawPower[bin] + re * re + im * im);
+            }
+        }
+
+        alignas(64) float power[kScreeningSpectrumBins];
+        std::array<float, kScreeningBarkBandCount> bandEnergy {};
+        float flatnessLogSum = 0.0f, flatnessPowerSum = 0.0f;
+        float highBandEnergy = 0.0f, ultraHighEnergy = 0.0f, totalEnergy = 0.0f;
+        for (int bin = 0; bin < kScreeningSpectrumBins; ++bin)
+        {
+            rawPower[bin] *= kPowerScale;
+            const float p = std::max(kMinPowerF, rawPower[bin]);
+            power[bin] = p;
+            totalEnergy += p;
+            bandEnergy[static_cast<size_t>(screeningBinToBand[static_cast<size_t>(bin)])] += p * screeningBinWidthHz;
+
+            if (bin >= screeningFlatnessStartBin && bin <= screeningFlatnessEndBin)
+            {
+                flatnessLogSum += std::log(p + kMinPowerF);
+                flatnessPowerSum += p + kMinPowerF;
+            }
+            if (bin >= screeningHighBandStartBin)
+                highBandEnergy += p;
+            if (bin >= screeningUltraHighStartBin)
+                ultraHighEnergy += p;
+        }
+
+        float peakEnergy = 0.0f;
+        for (int bin = 1; bin < kScreeningSpectrumBins - 1; ++bin)
+        {
+            const float localAvg = 0.5f * (rawPower[bin - 1] + rawPower[bin + 1]) + kMinPowerF;
+            if (power[bin] > 6.0f * localAvg)
+                peakEnergy = std::max(peakEnergy, power[bin]);
+        }
+
+        // 帯域マスカー → ビンのマスキングパワー (帯域ごとに全ビンへ積和。内側ループは連続アクセス)
+        alignas(64) float masking[kScreeningSpectrumBins];
+        std::fill(masking, masking + kScreeningSpectrumBins, 0.0f);
+        for (int band = 0; band < kScreeningBarkBandCount; ++band)
+        {
+            const float energy = bandEnergy[static_cast<size_t>(band)];
+            const float* gain = screeningSpreadGain.data() + static_cast<size_t>(band * kScreeningSpectrumBins);
+            for (int bin = 0; bin < kScreeningSpectrumBins; ++bin)
+                masking[bin] += energy * gain[bin];
+        }
+
+        float psychoWeighted = 0.0f;
+        for (int bin = 0; bin < kScreeningSpectrumBins; ++bin)
+        {
+            const size_t idx = static_cast<size_t>(bin);
+            float threshold = std::max(masking[bin], screeningAthPower[idx]);
+            if (thresholds != nullptr)
+                threshold = std::max(threshold, static_cast<float>(std::max((*thresholds)[idx * kScreeningBinStride], kMinPower)));
+
+            const float deltaDb = std::log(power[bin] / std::max(threshold, kMinPowerF)) * kLog10FactorF;
+            const float z = kSoftplusKF * deltaDb;
+            const float soft = (z > 50.0f) ? deltaDb
+                             : (z < -50.0f) ? std::exp(z) / kSoftplusKF
+                             : std::log1p(std::exp(z)) / kSoftplusKF;
+            const float effectiveDb = kCapF * std::tanh(soft / kCapF);
+            psychoWeighted += screeningWeights[idx] * std::max(0.0f, std::exp(effectiveDb * kDbToLogF) - 1.0f);
+        }
+
+        Result result;
+        result.noisePower = (screeningWeightSum > kMinPowerF)
+                          ? (static_cast<double>(psychoWeighted / screeningWeightSum) * static_cast<double>(kFftLength))
+                          : 0.0;
+
+        const int flatnessBins = screeningFlatnessEndBin - screeningFlatnessStartBin + 1;
+        if (flatnessBins > 0)
+        {
+            const double arithmeticMean = static_cast<double>(flatnessPowerSum) / static_cast<double>(flatnessBins);
+            const double geometricMean = std::exp(static_cast<double>(flatnessLogSum) / static_cast<double>(flatnessBins));
+            result.spectralFlatnessPenalty = 1.0 - std::clamp(geometricMean / std::max(arithmeticMean, kMinPower), 0.0, 1.0);
+        }
+
+        const double observedUltraHighShare = static_cast<double>(ultraHighEnergy) / std::max(static_cast<double>(highBandEnergy) + kMinPower, kMinPower);
+        const double excessUltraHighShare = std::max(0.0, observedUltraHighShare - screeningExpectedUltraHighShare);
+        result.hfPenalty = excessUltraHighShare / std::max(1.0 - screeningExpectedUltraHighShare, kMinPower);
+        result.timeDomainRms = std::sqrt(sumSq / kScreeningFftLength);
+
+        const double tonalRatio = static_cast<double>(peakEnergy) / (static_cast<double>(totalEnergy) + kMinPower);
+        const double tonalPenalty = std::max(0.0, tonalRatio - 0.05) * 10.0;
+
+        result.compositeScore = result.noisePower
+                              * (1.0
+                                 + (flatnessPenaltyWeight * result.spectralFlatnessPenalty)
+                                 + (hfPenaltyWeight * result.hfPenalty)
+                                 + tonalPenalty);
+        return result;
+    }
+
     double getBinWidth(int bin) const noexcept
     {
         if (bin <= 0)
@@ -621,7 +922,8 @@ private:
         return 0.5 * (freqHz[static_cast<size_t>(bin + 1)] - freqHz[static_cast<size_t>(bin - 1)]);
     }
 
-    void detectTonalMaskersFixed(const std::array<double, kSpectrumBins>& power,
+    void detectTonalMaskersFixed(const double* power,
+                                 const double* powerDb,
                                  MaskerBuffer& maskers,
                                  std::array<bool, kSpectrumBins>& consumed) const noexcept
     {
@@ -631,19 +933,19 @@ private:
         for (int i = 3; i < kSpectrumBins - 3; ++i)
         {
             const int range = neighborRangeBins[static_cast<size_t>(i)];
-            const double centerDb = powerToDb(power[static_cast<size_t>(i)]);
+            const double centerDb = powerDb[i];
             bool isPeak = true;
 
             for (int k = 1; k <= range; ++k)
             {
                 if ((i - k) >= 0)
                 {
-                    const double leftDelta = centerDb - powerToDb(power[static_cast<size_t>(i - k)]);
+                    const double leftDelta = centerDb - powerDb[i - k];
                     if (leftDelta < kTonalPeakThresholdDb) { isPeak = false; break; }
                 }
                 if ((i + k) < kSpectrumBins)
                 {
-                    const double rightDelta = centerDb - powerToDb(power[static_cast<size_t>(i + k)]);
+                    const double rightDelta = centerDb - powerDb[i + k];
                     if (rightDelta < kTonalPeakThresholdDb) { isPeak = false; break; }
                 }
             }
@@ -660,7 +962,7 @@ private:
             {
                 if (std::abs(barkHz[static_cast<size_t>(j)] - centerBark) > kTonalAbsorbRadiusBark)
                     continue;
-                const double e = power[static_cast<size_t>(j)] * getBinWidth(j);
+                const double e = power[j] * getBinWidth(j);
                 sumEnergy += e;
                 sumBarkWeighted += barkHz[static_cast<size_t>(j)] * e;
                 consumed[static_cast<size_t>(j)] = true;
@@ -678,61 +980,49 @@ private:
         }
     }
 
-    double computeSfm(const std::array<double, kSpectrumBins>& power,
-                      const std::array<bool, kSpectrumBins>& tonalConsumed,
-                      int targetBand) const noexcept
+    // ★ Bark 帯域ごとのエネルギー・Bark 重心・SFM を 1 パスで集計する
+    //   (帯域ごとに全 bin を走査していた旧実装と、帯域内の加算順序は同じ = ビット一致)
+    void buildNoiseMaskersFixed(const double* power,
+                                const std::array<bool, kSpectrumBins>& tonalConsumed,
+                                MaskerBuffer& maskers) const noexcept
     {
-        double logSum = 0.0;
-        double linearSum = 0.0;
-        int count = 0;
+        maskers.clear();
+
+        std::array<double, kBarkBandCount> sumEnergy {};
+        std::array<double, kBarkBandCount> sumBarkWeighted {};
+        std::array<double, kBarkBandCount> logSum {};
+        std::array<double, kBarkBandCount> linearSum {};
+        std::array<int, kBarkBandCount> count {};
 
         for (int i = 0; i < kSpectrumBins; ++i)
         {
-            if (binToBand[static_cast<size_t>(i)] != targetBand || tonalConsumed[static_cast<size_t>(i)])
+            if (tonalConsumed[static_cast<size_t>(i)])
                 continue;
-            const double p = std::max(power[static_cast<size_t>(i)], 1.0e-15);
-            logSum += std::log(p);
-            linearSum += p;
-            ++count;
-        }
 
-        if (count <= 0) return 1.0;
+            const size_t band = static_cast<size_t>(binToBand[static_cast<size_t>(i)]);
+            const double e = power[i] * getBinWidth(i);
+            sumEnergy[band] += e;
+            sumBarkWeighted[band] += barkHz[static_cast<size_t>(i)] * e;
 
-        const double geometric = std::exp(logSum / static_cast<double>(count));
-        const double arithmetic = linearSum / static_cast<double>(count);
-        return geometric / std::max(arithmetic, 1.0e-15);
-    }
-
-    void buildNoiseMaskersFixed(const std::array<double, kSpectrumBins>& power,
-                                const std::array<bool, kSpectrumBins>& tonalConsumed,
-                                MaskerBuffer& maskers) const noexcept
-    {
-        maskers.clear();
+            const double p = std::max(power[i], 1.0e-15);
+            logSum[band] += std::log(p);
+            linearSum[band] += p;
+            ++count[band];
+        }
 
         for (int band = 0; band < kBarkBandCount; ++band)
         {
-            double sumEnergy = 0.0;
-            double sumBarkWeighted = 0.0;
-            int count = 0;
+            const size_t b = static_cast<size_t>(band);
+            if (count[b] <= 0 || sumEnergy[b] <= kMinPower) continue;
 
-            for (int i = 0; i < kSpectrumBins; ++i)
-            {
-                if (binToBand[static_cast<size_t>(i)] != band || tonalConsumed[static_cast<size_t>(i)])
-                    continue;
-                const double e = power[static_cast<size_t>(i)] * getBinWidth(i);
-                sumEnergy += e;
-                sumBarkWeighted += barkHz[static_cast<size_t>(i)] * e;
-                ++count;
-            }
-
-            if (count <= 0 || sumEnergy <= kMinPower) continue;
-
-            const double sfm = computeSfm(power, tonalConsumed, band);
+            const double geometric = std::exp(logSum[b] / static_cast<double>(count[b]));
+            const double arithmetic = linearSum[b] / static_cast<double>(count[b]);
+            const double sfm = geometric / std::max(arithmetic, 1.0e-15);
 
             Masker masker;
-            masker.energy = sumEnergy;
-            masker.bark = sumBarkWeighted / sumEnergy;
-            masker.levelDb = powerToDb(sumEnergy);
+            masker.energy = sumEnergy[b];
+            masker.bark = sumBarkWeighted[b] / sumEnergy[b];
+            masker.levelDb = powerToDb(sumEnergy[b]);
             masker.type = Noise;
             masker.tonality = computeTonalityFromSfm(sfm);
             maskers.push(masker);
@@ -797,11 +1087,12 @@ private:
     double*     inputRight    = nullptr;  ///< FFT 入力 R ch (kFftLength doubles)
     CcsComplex* spectrumLeft  = nullptr;  ///< FFT 出力 L ch (kSpectrumBins CcsComplex)
     CcsComplex* spectrumRight = nullptr;  ///< FFT 出力 R ch (kSpectrumBins CcsComplex)
+    double*     batchPower    = nullptr;  ///< evaluateBatch: パワー [kMaxBatchSegments][kSpectrumBins]
+    double*     batchPowerDb  = nullptr;  ///< evaluateBatch: batchPower の dB
 
-    // ── IPP FFT リソース ──
-    IppsFFTSpec_R_64f* fftSpec    = nullptr; ///< IPP FFT スペック (fftSpecBuf 内を指す)
-    Ipp8u*             fftSpecBuf = nullptr; ///< fftSpec のメモリオーナー
-    Ipp8u*             fftWorkBuf = nullptr; ///< FFT スクラッチ (sizeWork==0 なら nullptr)
+    // ── FFT リソース ──
+    const convo::RealFftPlan* fftPlan = nullptr; ///< 共有 FFT プラン (RealFftPlanCache の所有物)
+    Ipp8u*             fftWorkBuf = nullptr; ///< FFT スクラッチ (getWorkBytes()==0 なら nullptr)
 
     // ── 分析パラメータ ──
     std::array<double, kSpectrumBins> weights {};
@@ -811,6 +1102,7 @@ private:
     std::array<int,    kSpectrumBins> neighborRangeBins {};
     std::array<double, kSpectrumBins> athThresholdDb {};
     std::array<double, kSpectrumBins> athThresholdPower {};
+    std::array<double, kSpectrumBins> jndWeights {};   ///< computeJndWeight(computeJndDb(freqHz))
     std::array<double, kBarkBandCount> bandCenterBark {};
     std::array<double, kBarkBandCount> bandCenterFreqHz {};
 
@@ -826,4 +1118,23 @@ private:
     double configuredWeightSum     = 1.0;
     double flatnessPenaltyWeight   = 0.35;
     double hfPenaltyWeight         = 0.20;
+
+    // ── 予備選別 (evaluateScreeningBatch) ──
+    float*              screeningInput    = nullptr;  ///< float FFT 入力 (kScreeningFftLength)
+    float*              screeningSpectrum = nullptr;  ///< float FFT 出力 CCS (kScreeningFftLength + 2)
+    IppsFFTSpec_R_32f*  screeningSpec     = nullptr;  ///< screeningSpecBuf 内のスペック
+    Ipp8u*              screeningSpecBuf  = nullptr;
+    Ipp8u*              screeningWorkBuf  = nullptr;
+
+    std::array<float, kScreeningSpectrumBins> screeningWeights {};    ///< weights × jndWeights (同じ周波数の本評価ビン)
+    std::array<float, kScreeningSpectrumBins> screeningAthPower {};
+    std::array<int,   kScreeningSpectrumBins> screeningBinToBand {};
+    std::array<float, kScreeningBarkBandCount * kScreeningSpectrumBins> screeningSpreadGain {};  ///< [band][bin] 線形パワー利得
+    float screeningWeightSum  = 1.0f;
+    float screeningBinWidthHz = 0.0f;
+    int screeningFlatnessStartBin  = 0;
+    int screeningFlatnessEndBin    = kScreeningSpectrumBins - 1;
+    int screeningHighBandStartBin  = 0;
+    int screeningUltraHighStartBin = kScreeningSpectrumBins - 1;
+    double screeningExpectedUltraHighShare = 0.0;
 };
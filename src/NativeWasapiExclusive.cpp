@@ -0,0 +1,878 @@
+#include "NativeWasapiExclusive.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <windows.h>
+#include <mmreg.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <avrt.h>
+#include <wrl/client.h>
+#pragma comment(lib, "avrt.lib")
+
+#include "audioengine/AtomicAccess.h"
+#include "audioengine/DeviceOutputCodec.h"
+#include "core/ThreadAffinityManager.h"
+
+using Microsoft::WRL::ComPtr;
+using convo::output::PcmSampleFormat;
+
+namespace {
+
+void diagLog(const juce::String& message)
+{
+    DBG(message);
+    juce::Logger::writeToLog(message);
+}
+
+// SDK のヘッダで定義済みでも、ライブラリ側の実体に頼らないよう値をここに持つ
+const PROPERTYKEY kPkeyDeviceFriendlyName      { { 0xa45c254e, 0xdf1c, 0x4efd, { 0x80, 0x20, 0x67, 0xd1, 0x46, 0xa8, 0x50, 0xe0 } }, 14 };
+const PROPERTYKEY kPkeyAudioEngineDeviceFormat { { 0xf19f064d, 0x082c, 0x4e27, { 0xbc, 0x73, 0x68, 0x82, 0xa1, 0xbb, 0x8e, 0x4c } }, 0 };
+const GUID kSubtypePcm   { 0x00000001, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 } };
+const GUID kSubtypeFloat { 0x00000003, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 } };
+
+constexpr double kHundredNsPerSecond = 1.0e7;
+constexpr double kProbeSampleRates[] = { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0, 352800.0, 384000.0 };
+constexpr int kStandardBufferSizes[] = { 16, 32, 48, 64, 96, 128, 160, 192, 256, 384, 480, 512, 768, 1024, 1536, 2048 };
+// ネイティブ形式が交渉できないときに試す順 (整数はディザ済みコードをそのまま載せられるものから)
+constexpr PcmSampleFormat kFallbackFormats[] = { PcmSampleFormat::Int32, PcmSampleFormat::Int24In32,
+                                                 PcmSampleFormat::Int24Packed, PcmSampleFormat::Int16,
+                                                 PcmSampleFormat::Float32 };
+
+juce::String hresultText(HRESULT hr)
+{
+    return "0x" + juce::String::toHexString(static_cast<int>(hr));
+}
+
+ComPtr<IMMDeviceEnumerator> makeEnumerator()
+{
+    ComPtr<IMMDeviceEnumerator> enumerator;
+    ::CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, IID_PPV_ARGS(&enumerator));
+    return enumerator;
+}
+
+juce::String endpointIdOf(IMMDevice* device)
+{
+    LPWSTR id = nullptr;
+    if (FAILED(device->GetId(&id)) || id == nullptr)
+        return {};
+    juce::String result(id);
+    ::CoTaskMemFree(id);
+    return result;
+}
+
+juce::String friendlyNameOf(IMMDevice* device)
+{
+    ComPtr<IPropertyStore> store;
+    if (FAILED(device->OpenPropertyStore(STGM_READ, &store)))
+        return {};
+    PROPVARIANT value;
+    ::PropVariantInit(&value);
+    juce::String name;
+    if (SUCCEEDED(store->GetValue(kPkeyDeviceFriendlyName, &value)) && value.vt == VT_LPWSTR)
+        name = juce::String(value.pwszVal);
+    ::PropVariantClear(&value);
+    return name;
+}
+
+// コントロールパネルの「既定の形式」(排他時にドライバが最も素直に受ける形式)
+bool readNativeFormat(IMMDevice* device, WAVEFORMATEXTENSIBLE& out)
+{
+    ComPtr<IPropertyStore> store;
+    if (FAILED(device->OpenPropertyStore(STGM_READ, &store)))
+        return false;
+    PROPVARIANT value;
+    ::PropVariantInit(&value);
+    bool ok = false;
+    if (SUCCEEDED(store->GetValue(kPkeyAudioEngineDeviceFormat, &value)) && value.vt == VT_BLOB
+        && value.blob.cbSize >= sizeof(WAVEFORMATEX))
+    {
+        out = {};
+        std::memcpy(&out, value.blob.pBlobData, std::min<size_t>(value.blob.cbSize, sizeof(out)));
+        ok = true;
+    }
+    ::PropVariantClear(&value);
+    return ok;
+}
+
+bool classifyFormat(const WAVEFORMATEXTENSIBLE& f, PcmSampleFormat& out)
+{
+    const WORD tag = f.Format.wFormatTag;
+    const bool extensible = (tag == WAVE_FORMAT_EXTENSIBLE && f.Format.cbSize >= 22);
+    const bool isFloat = (tag == WAVE_FORMAT_IEEE_FLOAT) || (extensible && f.SubFormat == kSubtypeFloat);
+    const bool isPcm = (tag == WAVE_FORMAT_PCM) || (extensible && f.SubFormat == kSubtypePcm);
+    const int container = f.Format.wBitsPerSample;
+    const int valid = extensible ? f.Samples.wValidBitsPerSample : container;
+
+    if (isFloat && container == 32)                     { out = PcmSampleFormat::Float32;     return true; }
+    if (!isPcm)                                         return false;
+    if (container == 16)                                { out = PcmSampleFormat::Int16;       return true; }
+    if (container == 24)                                { out = PcmSampleFormat::Int24Packed; return true; }
+    if (container == 32 && valid == 24)                 { out = PcmSampleFormat::Int24In32;   return true; }
+    if (container == 32)                                { out = PcmSampleFormat::Int32;       return true; }
+    return false;
+}
+
+DWORD defaultChannelMask(int channels)
+{
+    if (channels == 1) return SPEAKER_FRONT_CENTER;
+    if (channels == 2) return SPEAKER_FRONT_LEFT | SPEAKER_FRONT_RIGHT;
+    return 0;   // それ以上はスピーカー配置なし (DIRECTOUT)
+}
+
+WAVEFORMATEXTENSIBLE makeFormat(PcmSampleFormat sample, int channels, DWORD channelMask, double sampleRate)
+{
+    const int bytes = convo::output::pcmBytesPerSample(sample);
+    WAVEFORMATEXTENSIBLE f {};
+    f.Format.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+    f.Format.nChannels = static_cast<WORD>(channels);
+    f.Format.nSamplesPerSec = static_cast<DWORD>(sampleRate);
+    f.Format.wBitsPerSample = static_cast<WORD>(bytes * 8);
+    f.Format.nBlockAlign = static_cast<WORD>(channels * bytes);
+    f.Format.nAvgBytesPerSec = f.Format.nSamplesPerSec * f.Format.nBlockAlign;
+    f.Format.cbSize = sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX);
+    f.Samples.wValidBitsPerSample = static_cast<WORD>(sample == PcmSampleFormat::Float32 ? 32 : convo::output::pcmValidBits(sample));
+    f.dwChannelMask = channelMask;
+    f.SubFormat = (sample == PcmSampleFormat::Float32) ? kSubtypeFloat : kSubtypePcm;
+    return f;
+}
+
+//==============================================================================
+// エンドポイントの静的な性質 (チャンネル数・ネイティブ形式・最小周期)。デバイス生成時に 1 回調べる
+struct EndpointCaps
+{
+    juce::String id;
+    int channels = 0;
+    DWORD channelMask = 0;
+    bool hasNative = false;
+    PcmSampleFormat native = PcmSampleFormat::Float32;
+    REFERENCE_TIME minPeriod = 0;
+
+    bool isValid() const noexcept { return channels > 0; }
+};
+
+ComPtr<IAudioClient> activateClient(const juce::String& id)
+{
+    ComPtr<IAudioClient> client;
+    auto enumerator = makeEnumerator();
+    ComPtr<IMMDevice> device;
+    if (enumerator == nullptr || FAILED(enumerator->GetDevice(id.toWideCharPointer(), &device)))
+        return client;
+    device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, reinterpret_cast<void**>(client.GetAddressOf()));
+    return client;
+}
+
+EndpointCaps probeEndpoint(const juce::String& id)
+{
+    EndpointCaps caps;
+    caps.id = id;
+    auto enumerator = makeEnumerator();
+    ComPtr<IMMDevice> device;
+    if (id.isEmpty() || enumerator == nullptr || FAILED(enumerator->GetDevice(id.toWideCharPointer(), &device)))
+        return caps;
+
+    WAVEFORMATEXTENSIBLE native {};
+    if (readNativeFormat(device.Get(), native))
+    {
+        caps.channels = native.Format.nChannels;
+        caps.channelMask = (native.Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE) ? native.dwChannelMask
+                                                                               : defaultChannelMask(caps.channels);
+        caps.hasNative = classifyFormat(native, caps.native);
+    }
+
+    auto client = activateClient(id);
+    if (client == nullptr)
+        return caps;
+    if (caps.channels == 0)
+    {
+        WAVEFORMATEX* mix = nullptr;
+        if (SUCCEEDED(client->GetMixFormat(&mix)) && mix != nullptr)
+        {
+            caps.channels = mix->nChannels;
+            caps.channelMask = defaultChannelMask(caps.channels);
+            ::CoTaskMemFree(mix);
+        }
+    }
+    REFERENCE_TIME defaultPeriod = 0;
+    client->GetDevicePeriod(&defaultPeriod, &caps.minPeriod);
+    return caps;
+}
+
+// sampleRate で排他モードが受ける形式 (ネイティブ → 代替の順)。見つからなければ false
+bool negotiateFormat(IAudioClient* client, const EndpointCaps& caps, double sampleRate,
+                     WAVEFORMATEXTENSIBLE& format, PcmSampleFormat& sample)
+{
+    auto tryFormat = [&](PcmSampleFormat candidate)
+    {
+        const auto f = makeFormat(candidate, caps.channels, caps.channelMask, sampleRate);
+        if (client->IsFormatSupported(AUDCLNT_SHAREMODE_EXCLUSIVE, &f.Format, nullptr) != S_OK)
+            return false;
+        format = f;
+        sample = candidate;
+        return true;
+    };
+    if (caps.hasNative && tryFormat(caps.native))
+        return true;
+    for (PcmSampleFormat candidate : kFallbackFormats)
+        if (candidate != caps.native && tryFormat(candidate))
+            return true;
+    return false;
+}
+
+int framesForPeriod(REFERENCE_TIME period, double sampleRate)
+{
+    return static_cast<int>(std::ceil(static_cast<double>(period) * sampleRate / kHundredNsPerSecond));
+}
+
+//==============================================================================
+class NativeWasapiExclusiveDevice final : public juce::AudioIODevice,
+                                          private juce::Thread
+{
+public:
+    NativeWasapiExclusiveDevice(const NativeWasapiExclusiveDeviceType::Endpoint& outputEndpoint,
+                                const NativeWasapiExclusiveDeviceType::Endpoint& inputEndpoint,
+                                ThreadAffinityManager* affinityMgr)
+        : juce::AudioIODevice(outputEndpoint.name, NativeWasapiExclusiveDeviceType::kTypeName),
+          juce::Thread("WASAPI Exclusive RT"),
+          outputId(outputEndpoint.id),
+          inputId(inputEndpoint.id),
+          affinityManager(affinityMgr)
+    {
+        outputCaps = probeEndpoint(outputId);
+        inputCaps = probeEndpoint(inputId);
+
+        for (double rate : kProbeSampleRates)
+        {
+            if (supportsRate(outputCaps, rate) && (!inputCaps.isValid() || supportsRate(inputCaps, rate)))
+                sampleRates.add(rate);
+        }
+    }
+
+    ~NativeWasapiExclusiveDevice() override
+    {
+        close();
+    }
+
+    const juce::String& getOutputEndpointId() const noexcept { return outputId; }
+    const juce::String& getInputEndpointId() const noexcept { return inputId; }
+
+    juce::StringArray getOutputChannelNames() override { return channelNames(outputCaps.channels, "Output"); }
+    juce::StringArray getInputChannelNames() override  { return channelNames(inputCaps.channels, "Input"); }
+
+    juce::Array<double> getAvailableSampleRates() override { return sampleRates; }
+
+    juce::Array<int> getAvailableBufferSizes() override
+    {
+        const double rate = (currentSampleRate > 0.0) ? currentSampleRate : 48000.0;
+        REFERENCE_TIME minPeriod = outputCaps.minPeriod;
+        if (inputCaps.isValid())
+            minPeriod = std::max(minPeriod, inputCaps.minPeriod);
+        const int minFrames = std::max(1, framesForPeriod(minPeriod, rate));
+
+        juce::Array<int> sizes;
+        sizes.add(minFrames);
+        for (int size : kStandardBufferSizes)
+            if (size > minFrames)
+                sizes.add(size);
+        return sizes;
+    }
+
+    int getDefaultBufferSize() override
+    {
+        const auto sizes = getAvailableBufferSizes();
+        for (int size : sizes)
+            if (size >= 128)
+                return size;
+        return sizes.getLast();
+    }
+
+    juce::String open(const juce::BigInteger& inputChannels, const juce::BigInteger& outputChannels,
+                      double sampleRate, int bufferSizeSamples) override
+    {
+        close();
+        lastError.clear();
+
+        if (!outputCaps.isValid())
+            return lastError = "The native exclusive backend needs an output device";
+
+        currentSampleRate = (sampleRate > 0.0) ? sampleRate : 48000.0;
+        const int requestedFrames = (bufferSizeSamples > 0) ? bufferSizeSamples : getDefaultBufferSize();
+
+        activeOutputs.clear();
+        for (int c = 0; c < outputCaps.channels; ++c)
+            if (outputChannels[c])
+                activeOutputs.setBit(c);
+        activeInputs.clear();
+        for (int c = 0; c < inputCaps.channels; ++c)
+            if (inputChannels[c])
+                activeInputs.setBit(c);
+
+        REFERENCE_TIME period = std::max(outputCaps.minPeriod,
+                                         static_cast<REFERENCE_TIME>(std::llround(kHundredNsPerSecond * requestedFrames / currentSampleRate)));
+        if (inputCaps.isValid() && !activeInputs.isZero())
+            period = std::max(period, inputCaps.minPeriod);
+
+        if (auto error = initStream(render, outputCaps, period); error.isNotEmpty())
+            return failOpen("output: " + error);
+        if (inputCaps.isValid() && !activeInputs.isZero())
+        {
+            if (auto error = initStream(capture, inputCaps, period); error.isNotEmpty())
+                return failOpen("input: " + error);
+        }
+
+        const int frames = static_cast<int>(render.bufferFrames);
+        const int numOut = activeOutputs.countNumberOfSetBits();
+        const int numIn = capture.isOpen() ? activeInputs.countNumberOfSetBits() : 0;
+        outputScratch.setSize(std::max(1, numOut), frames);
+        inputScratch.setSize(std::max(1, numIn), frames);
+        captureFifo.setSize(std::max(1, numIn), 4 * std::max(frames, static_cast<int>(capture.bufferFrames)));
+        fifoRead = 0;
+        fifoCount = 0;
+
+        sourceForDeviceChannel.assign(static_cast<size_t>(render.deviceChannels), -1);
+        for (int c = 0, s = 0; c < render.deviceChannels; ++c)
+            if (activeOutputs[c])
+                sourceForDeviceChannel[static_cast<size_t>(c)] = s++;
+        deviceChannelForInput.clear();
+        for (int c = 0; c < capture.deviceChannels; ++c)
+            if (activeInputs[c])
+                deviceChannelForInput.push_back(c);
+        if (!capture.isOpen())
+            activeInputs.clear();
+
+        outputPtrs.assign(static_cast<size_t>(numOut), nullptr);
+        for (int s = 0; s < numOut; ++s)
+            outputPtrs[static_cast<size_t>(s)] = outputScratch.getWritePointer(s);
+        inputPtrs.assign(static_cast<size_t>(numIn), nullptr);
+        for (int s = 0; s < numIn; ++s)
+            inputPtrs[static_cast<size_t>(s)] = inputScratch.getWritePointer(s);
+        fifoPtrs.assign(static_cast<size_t>(numIn), nullptr);
+
+        periodMs = std::max(1, static_cast<int>(std::ceil(frames * 1000.0 / currentSampleRate)));
+        convo::publishAtomic(xrunCount, 0, std::memory_order_relaxed); // relaxed: 単独の診断カウンタ
+        deviceOpen = true;
+        startThread(juce::Thread::Priority::highest);
+
+        diagLog("[WASAPI-EXCL] opened \"" + getName() + "\" rate=" + juce::String(currentSampleRate)
+                + " frames=" + juce::String(frames)
+                + " bits=" + juce::String(convo::output::pcmValidBits(render.sample))
+                + " float=" + juce::String(render.sample == PcmSampleFormat::Float32 ? "yes" : "no")
+                + " outLatency=" + juce::String(getOutputLatencyInSamples())
+                + " inLatency=" + juce::String(getInputLatencyInSamples()));
+        return {};
+    }
+
+    void close() override
+    {
+        stop();
+        if (isThreadRunning())
+        {
+            signalThreadShouldExit();
+            if (render.event != nullptr)
+                ::SetEvent(render.event);   // 待機中の WaitForSingleObject を起こす
+            stopThread(2000);
+        }
+        render.release();
+        capture.release();
+        deviceOpen = false;
+    }
+
+    bool isOpen() override { return deviceOpen; }
+
+    void start(juce::AudioIODeviceCallback* newCallback) override
+    {
+        if (!deviceOpen || newCallback == nullptr || newCallback == callback)
+            return;
+        newCallback->audioDeviceAboutToStart(this);
+        const juce::ScopedLock sl(callbackLock);
+        callback = newCallback;
+    }
+
+    void stop() override
+    {
+        juce::AudioIODeviceCallback* previous = nullptr;
+        {
+            const juce::ScopedLock sl(callbackLock);
+            previous = std::exchange(callback, nullptr);
+        }
+        if (previous != nullptr)
+            previous->audioDeviceStopped();
+    }
+
+    bool isPlaying() override { return callback != nullptr; }
+    juce::String getLastError() override { return lastError; }
+
+    int getCurrentBufferSizeSamples() override { return static_cast<int>(render.bufferFrames); }
+    double getCurrentSampleRate() override { return currentSampleRate; }
+    int getCurrentBitDepth() override { return convo::output::pcmValidBits(render.sample); }
+    juce::BigInteger getActiveOutputChannels() const override { return activeOutputs; }
+    juce::BigInteger getActiveInputChannels() const override { return activeInputs; }
+    int getOutputLatencyInSamples() override { return static_cast<int>(render.bufferFrames) + render.latencyFrames; }
+    int getInputLatencyInSamples() override
+    {
+        return capture.isOpen() ? static_cast<int>(capture.bufferFrames) + capture.latencyFrames : 0;
+    }
+    int getXRunCount() const noexcept override
+    {
+        return convo::consumeAtomic(xrunCount, std::memory_order_relaxed); // relaxed: 単独の診断カウンタ
+    }
+
+private:
+    struct Stream
+    {
+        ComPtr<IAudioClient> client;
+        HANDLE event = nullptr;
+        PcmSampleFormat sample = PcmSampleFormat::Float32;
+        int deviceChannels = 0;
+        int blockAlign = 0;
+        UINT32 bufferFrames = 0;
+        int latencyFrames = 0;
+
+        bool isOpen() const noexcept { return client != nullptr; }
+        void release()
+        {
+            client.Reset();
+            if (event != nullptr)
+            {
+                ::CloseHandle(event);
+                event = nullptr;
+            }
+            bufferFrames = 0;
+            latencyFrames = 0;
+            deviceChannels = 0;
+        }
+    };
+
+    static juce::StringArray channelNames(int count, const char* prefix)
+    {
+        juce::StringArray names;
+        for (int c = 0; c < count; ++c)
+            names.add(juce::String(prefix) + " " + juce::String(c + 1));
+        return names;
+    }
+
+    static bool supportsRate(const EndpointCaps& caps, double rate)
+    {
+        auto client = activateClient(caps.id);
+        WAVEFORMATEXTENSIBLE format {};
+        PcmSampleFormat sample {};
+        return client != nullptr && negotiateFormat(client.Get(), caps, rate, format, sample);
+    }
+
+    juce::String failOpen(const juce::String& error)
+    {
+        render.release();
+        capture.release();
+        lastError = error;
+        diagLog("[WASAPI-EXCL] open failed: " + error);
+        return lastError;
+    }
+
+    // 排他・イベント駆動で初期化する。period は render の確定値を capture にも使うため入出力
+    juce::String initStream(Stream& s, const EndpointCaps& caps, REFERENCE_TIME& period)
+    {
+        s.client = activateClient(caps.id);
+        if (s.client == nullptr)
+            return "cannot activate the endpoint";
+
+        WAVEFORMATEXTENSIBLE format {};
+        if (!negotiateFormat(s.client.Get(), caps, currentSampleRate, format, s.sample))
+            return "no exclusive-mode format at " + juce::String(currentSampleRate) + " Hz";
+
+        constexpr DWORD kStreamFlags = AUDCLNT_STREAMFLAGS_EVENTCALLBACK | AUDCLNT_STREAMFLAGS_NOPERSIST;
+        HRESULT hr = s.client->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, kStreamFlags, period, period, &format.Format, nullptr);
+        if (hr == AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED)
+        {
+            // デバイスの境界に揃ったフレーム数から周期を計算し直し、クライアントを作り直して再初期化
+            UINT32 alignedFrames = 0;
+            s.client->GetBufferSize(&alignedFrames);
+            period = static_cast<REFERENCE_TIME>(std::llround(kHundredNsPerSecond * alignedFrames / currentSampleRate));
+            s.client = activateClient(caps.id);
+            if (s.client == nullptr)
+                return "cannot re-activate the endpoint";
+            hr = s.client->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, kStreamFlags, period, period, &format.Format, nullptr);
+        }
+        if (FAILED(hr))
+            return "Initialize failed (" + hresultText(hr) + ")";
+
+        s.event = ::CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        if (s.event == nullptr || FAILED(s.client->SetEventHandle(s.event)))
+            return "cannot set the event handle";
+        if (FAILED(s.client->GetBufferSize(&s.bufferFrames)) || s.bufferFrames == 0)
+            return "cannot read the buffer size";
+
+        REFERENCE_TIME streamLatency = 0;
+        if (SUCCEEDED(s.client->GetStreamLatency(&streamLatency)))
+            s.latencyFrames = static_cast<int>(std::llround(static_cast<double>(streamLatency) * currentSampleRate / kHundredNsPerSecond));
+        s.deviceChannels = caps.channels;
+        s.blockAlign = format.Format.nBlockAlign;
+        return {};
+    }
+
+    // RT スレッドから呼ぶ。lastError は Message Thread 側の値なので触らない
+    void reportError(const juce::String& message)
+    {
+        diagLog("[WASAPI-EXCL] " + message);
+        const juce::ScopedLock sl(callbackLock);
+        if (callback != nullptr)
+            callback->audioDeviceError(message);
+    }
+
+    void countXrun() noexcept
+    {
+        convo::fetchAddAtomic(xrunCount, 1, std::memory_order_relaxed); // relaxed: 単独の診断カウンタ
+    }
+
+    // ── capture FIFO (RT スレッド専用) ─────────────────────────────
+    void pushCapture(const BYTE* data, int frames, bool silent)
+    {
+        const int capacity = captureFifo.getNumSamples();
+        const int numIn = static_cast<int>(deviceChannelForInput.size());
+        if (frames > capacity - fifoCount)
+        {
+            // 溢れた分は古い方から捨てる (render が止まっていた後など)
+            const int drop = std::min(fifoCount, frames - (capacity - fifoCount));
+            fifoRead = (fifoRead + drop) % capacity;
+            fifoCount -= drop;
+            countXrun();
+            if (frames > capacity)
+            {
+                data += static_cast<size_t>(frames - capacity) * static_cast<size_t>(capture.blockAlign);
+                frames = capacity;
+            }
+        }
+
+        int written = 0;
+        while (written < frames)
+        {
+            const int writePos = (fifoRead + fifoCount) % capacity;
+            const int chunk = std::min(frames - written, capacity - writePos);
+            for (int d = 0; d < numIn; ++d)
+                fifoPtrs[static_cast<size_t>(d)] = captureFifo.getWritePointer(d, writePos);
+            if (silent)
+            {
+                for (int d = 0; d < numIn; ++d)
+                    std::fill_n(fifoPtrs[static_cast<size_t>(d)], chunk, 0.0f);
+            }
+            else
+            {
+                convo::output::readInterleavedPcm(data + static_cast<size_t>(written) * static_cast<size_t>(capture.blockAlign),
+                                                  capture.sample, capture.deviceChannels, chunk,
+                                                  fifoPtrs.data(), deviceChannelForInput.data(), numIn);
+            }
+            written += chunk;
+            fifoCount += chunk;
+        }
+    }
+
+    void popCapture(int frames)
+    {
+        const int capacity = captureFifo.getNumSamples();
+        const int numIn = static_cast<int>(inputPtrs.size());
+        const int available = std::min(frames, fifoCount);
+        int read = 0;
+        while (read < available)
+        {
+            const int chunk = std::min(available - read, capacity - fifoRead);
+            for (int d = 0; d < numIn; ++d)
+                std::copy_n(captureFifo.getReadPointer(d, fifoRead), chunk, inputPtrs[static_cast<size_t>(d)] + read);
+            fifoRead = (fifoRead + chunk) % capacity;
+            fifoCount -= chunk;
+            read += chunk;
+        }
+        for (int d = 0; d < numIn; ++d)
+            std::fill(inputPtrs[static_cast<size_t>(d)] + available, inputPtrs[static_cast<size_t>(d)] + frames, 0.0f);
+        if (available < frames && capturePrimed)
+            countXrun();
+        capturePrimed = capturePrimed || available == frames;
+    }
+
+    // capture に溜まったパケットをすべて FIFO へ。デバイスが消えたら false
+    bool pullCapture(IAudioCaptureClient* client)
+    {
+        UINT32 packetFrames = 0;
+        HRESULT hr = S_OK;
+        while (SUCCEEDED(hr = client->GetNextPacketSize(&packetFrames)) && packetFrames > 0)
+        {
+            BYTE* data = nullptr;
+            UINT32 frames = 0;
+            DWORD flags = 0;
+            hr = client->GetBuffer(&data, &frames, &flags, nullptr, nullptr);
+            if (FAILED(hr))
+                break;
+            if ((flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) != 0 && capturePrimed)
+                countXrun();
+            pushCapture(data, static_cast<int>(frames), (flags & AUDCLNT_BUFFERFLAGS_SILENT) != 0);
+            client->ReleaseBuffer(frames);
+        }
+        return hr != AUDCLNT_E_DEVICE_INVALIDATED;
+    }
+
+    // ── RT スレッド ────────────────────────────────────────────────
+    void run() override
+    {
+        const HRESULT coInit = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        // audioRealtime マスクへ固定し、MMCSS Pro Audio に自分で登録する (JUCE の WASAPI スレッドに頼らない)
+        if (affinityManager != nullptr)
+            affinityManager->applyCurrentThreadPolicy(ThreadType::AudioRealtime);
+        DWORD taskIndex = 0;
+        HANDLE mmcss = ::AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+        if (mmcss != nullptr)
+            ::AvSetMmThreadPriority(mmcss, AVRT_PRIORITY_CRITICAL);
+        else
+            diagLog("[WASAPI-EXCL] MMCSS Pro Audio registration failed err=" + juce::String(static_cast<int>(::GetLastError())));
+
+        ComPtr<IAudioRenderClient> renderClient;
+        ComPtr<IAudioCaptureClient> captureClient;
+        render.client->GetService(IID_PPV_ARGS(&renderClient));
+        if (capture.isOpen())
+            capture.client->GetService(IID_PPV_ARGS(&captureClient));
+
+        const UINT32 frames = render.bufferFrames;
+        const int numOut = static_cast<int>(outputPtrs.size());
+        const int numIn = static_cast<int>(inputPtrs.size());
+        const DWORD timeoutMs = static_cast<DWORD>(std::max(20, 4 * periodMs));
+        constexpr int kMaxConsecutiveTimeouts = 50;
+        capturePrimed = false;
+
+        if (renderClient != nullptr)
+        {
+            // 開始前に 1 周期分の無音を入れておく (最初のイベントまでの間を埋める)
+            BYTE* prefill = nullptr;
+            if (SUCCEEDED(renderClient->GetBuffer(frames, &prefill)))
+                renderClient->ReleaseBuffer(frames, AUDCLNT_BUFFERFLAGS_SILENT);
+            render.client->Start();
+            if (captureClient != nullptr)
+                capture.client->Start();
+        }
+        else
+        {
+            reportError("cannot get the render client");
+        }
+
+        int consecutiveTimeouts = 0;
+        while (renderClient != nullptr && !threadShouldExit())
+        {
+            const DWORD wait = ::WaitForSingleObject(render.event, timeoutMs);
+            if (threadShouldExit())
+                break;
+            if (wait != WAIT_OBJECT_0)
+            {
+                countXrun();
+                if (++consecutiveTimeouts > kMaxConsecutiveTimeouts)
+                {
+                    reportError("the device stopped delivering render events");
+                    break;
+                }
+                continue;
+            }
+            consecutiveTimeouts = 0;
+
+            if (captureClient != nullptr)
+            {
+                if (!pullCapture(captureClient.Get()))
+                {
+                    reportError("the input device was removed");
+                    break;
+                }
+                popCapture(static_cast<int>(frames));
+            }
+
+            BYTE* data = nullptr;
+            const HRESULT hr = renderClient->GetBuffer(frames, &data);
+            if (FAILED(hr))
+            {
+                if (hr == AUDCLNT_E_DEVICE_INVALIDATED)
+                {
+                    reportError("the output device was removed");
+                    break;
+                }
+                countXrun();
+                continue;
+            }
+
+            {
+                const juce::ScopedLock sl(callbackLock);
+                if (callback != nullptr)
+                {
+                    const juce::AudioIODeviceCallbackContext context {};
+                    callback->audioDeviceIOCallbackWithContext(inputPtrs.data(), numIn,
+                                                               outputPtrs.data(), numOut,
+                                                               static_cast<int>(frames), context);
+                }
+                else
+                {
+                    outputScratch.clear();
+                }
+            }
+
+            // コールバックの出力をネイティブ形式で render バッファへ直接書く (中間のリングを挟まない)
+            convo::output::writeInterleavedPcm(outputPtrs.data(), sourceForDeviceChannel.data(),
+                                               render.deviceChannels, static_cast<int>(frames), render.sample, data);
+            renderClient->ReleaseBuffer(frames, 0);
+        }
+
+        if (render.isOpen())
+            render.client->Stop();
+        if (capture.isOpen())
+            capture.client->Stop();
+        if (mmcss != nullptr)
+            ::AvRevertMmThreadCharacteristics(mmcss);
+        if (SUCCEEDED(coInit))
+            ::CoUninitialize();
+    }
+
+    const juce::String outputId;
+    const juce::String inputId;
+    ThreadAffinityManager* const affinityManager;
+    EndpointCaps outputCaps;
+    EndpointCaps inputCaps;
+    juce::Array<double> sampleRates;
+
+    Stream render;
+    Stream capture;
+    double currentSampleRate = 0.0;
+    int periodMs = 10;
+    bool deviceOpen = false;
+    juce::String lastError;
+    juce::BigInteger activeOutputs;
+    juce::BigInteger activeInputs;
+
+    juce::CriticalSection callbackLock;
+    juce::AudioIODeviceCallback* callback = nullptr;   // callbackLock 保護 (isPlaying の読みは表示用)
+
+    // 以下は open で確保し、RT スレッドだけが触る
+    juce::AudioBuffer<float> outputScratch;
+    juce::AudioBuffer<float> inputScratch;
+    juce::AudioBuffer<float> captureFifo;
+    int fifoRead = 0;
+    int fifoCount = 0;
+    bool capturePrimed = false;   // 最初に 1 周期ぶん揃うまでは入力の不足を xrun に数えない
+    std::vector<float*> outputPtrs;
+    std::vector<float*> inputPtrs;
+    std::vector<float*> fifoPtrs;
+    std::vector<int> sourceForDeviceChannel;
+    std::vector<int> deviceChannelForInput;
+
+    std::atomic<int> xrunCount { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NativeWasapiExclusiveDevice)
+};
+
+} // namespace
+
+//==============================================================================
+NativeWasapiExclusiveDeviceType::NativeWasapiExclusiveDeviceType(ThreadAffinityManager* affinityMgr)
+    : juce::AudioIODeviceType(kTypeName),
+      affinityManager(affinityMgr)
+{
+}
+
+NativeWasapiExclusiveDeviceType::~NativeWasapiExclusiveDeviceType() = default;
+
+void NativeWasapiExclusiveDeviceType::scanForDevices()
+{
+    scanned = true;
+    outputs.clear();
+    inputs.clear();
+    defaultOutput = -1;
+    defaultInput = -1;
+
+    auto enumerator = makeEnumerator();
+    if (enumerator == nullptr)
+        return;
+
+    auto scanFlow = [&](EDataFlow flow, std::vector<Endpoint>& list, int& defaultIndex)
+    {
+        juce::String defaultId;
+        {
+            ComPtr<IMMDevice> defaultDevice;
+            if (SUCCEEDED(enumerator->GetDefaultAudioEndpoint(flow, eConsole, &defaultDevice)))
+                defaultId = endpointIdOf(defaultDevice.Get());
+        }
+
+        ComPtr<IMMDeviceCollection> collection;
+        if (FAILED(enumerator->EnumAudioEndpoints(flow, DEVICE_STATE_ACTIVE, &collection)))
+            return;
+        UINT count = 0;
+        collection->GetCount(&count);
+        juce::StringArray seen;
+        for (UINT i = 0; i < count; ++i)
+        {
+            ComPtr<IMMDevice> device;
+            if (FAILED(collection->Item(i, &device)))
+                continue;
+            Endpoint endpoint { friendlyNameOf(device.Get()), endpointIdOf(device.Get()) };
+            if (endpoint.id.isEmpty())
+                continue;
+            if (endpoint.name.isEmpty())
+                endpoint.name = "Device " + juce::String(static_cast<int>(i) + 1);
+            // 同名のエンドポイントは番号で区別する (名前がデバイスの識別子になるため)
+            const juce::String baseName = endpoint.name;
+            for (int n = 2; seen.contains(endpoint.name); ++n)
+                endpoint.name = baseName + " (" + juce::String(n) + ")";
+            seen.add(endpoint.name);
+            if (endpoint.id == defaultId)
+                defaultIndex = static_cast<int>(list.size());
+            list.push_back(std::move(endpoint));
+        }
+    };
+    scanFlow(eRender, outputs, defaultOutput);
+    scanFlow(eCapture, inputs, defaultInput);
+}
+
+juce::StringArray NativeWasapiExclusiveDeviceType::getDeviceNames(bool wantInputNames) const
+{
+    jassert(scanned);
+    juce::StringArray names;
+    for (const auto& endpoint : (wantInputNames ? inputs : outputs))
+        names.add(endpoint.name);
+    return names;
+}
+
+int NativeWasapiExclusiveDeviceType::getDefaultDeviceIndex(bool forInput) const
+{
+    jassert(scanned);
+    const int defaultIndex = forInput ? defaultInput : defaultOutput;
+    if (defaultIndex >= 0)
+        return defaultIndex;
+    return (forInput ? inputs : outputs).empty() ? -1 : 0;
+}
+
+int NativeWasapiExclusiveDeviceType::getIndexOfDevice(juce::AudioIODevice* device, bool asInput) const
+{
+    jassert(scanned);
+    auto* native = dynamic_cast<NativeWasapiExclusiveDevice*>(device);
+    if (native == nullptr)
+        return -1;
+    const auto& id = asInput ? native->getInputEndpointId() : native->getOutputEndpointId();
+    const auto& list = asInput ? inputs : outputs;
+    for (size_t i = 0; i < list.size(); ++i)
+        if (list[i].id == id)
+            return static_cast<int>(i);
+    return -1;
+}
+
+juce::AudioIODevice* NativeWasapiExclusiveDeviceType::createDevice(const juce::String& outputDeviceName,
+                                                                   const juce::String& inputDeviceName)
+{
+    jassert(scanned);
+    auto find = [](const std::vector<Endpoint>& list, const juce::String& name) -> Endpoint
+    {
+        for (const auto& endpoint : list)
+            if (endpoint.name == name)
+                return endpoint;
+        return {};
+    };
+    const Endpoint output = find(outputs, outputDeviceName);
+    if (output.id.isEmpty())
+        return nullptr;   // render イベントが時計になるため出力は必須
+    const Endpoint input = inputDeviceName.isNotEmpty() ? find(inputs, inputDeviceName) : Endpoint {};
+    return new NativeWasapiExclusiveDevice(output, input, affinityManager);
+}
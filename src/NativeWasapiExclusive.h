@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+
+#include <JuceHeader.h>
+
+class ThreadAffinityManager;
+
+/**
+    NativeWasapiExclusiveDeviceType: WASAPI 排他モード・イベント駆動の自前バックエンド ("WASAPI Exclusive (Native)")。
+
+    JUCE の WASAPI 実装はデバイススレッドと MMCSS を JUCE 側が持ち (MmcssPolicy::JuceManaged)、
+    ブロックごとに中間バッファを介した変換が入るため、10 ms 前後より下が安定しなかった。この種別では
+    デバイスごとに専用の RT スレッドを立て、次のように回す:
+
+    - 開始時に ThreadType::AudioRealtime のアフィニティ (audioRealtime マスク) へ固定し、
+      MMCSS "Pro Audio" / CRITICAL に自分で登録する (エンジン側は SelfManagedProAudio として扱う)
+    - IAudioClient を AUDCLNT_SHAREMODE_EXCLUSIVE + AUDCLNT_STREAMFLAGS_EVENTCALLBACK で初期化し、
+      周期はデバイスの最小周期まで詰められる (要求バッファ長 → 100 ns 単位。境界合わせが要る
+      デバイスは AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED の返すフレーム数で初期化し直す)
+    - 形式はエンドポイントのネイティブ形式 (PKEY_AudioEngine_DeviceFormat) を最優先で交渉し、
+      合わなければ int32 → int24-in-32 → int24 → int16 → float32 の順に試す
+    - render イベントごとに AudioIODeviceCallback を 1 回呼び、その出力を GetBuffer の領域へ
+      convo::output::writeInterleavedPcm で直接書く (ディザの LSB は補正なしで保たれる。DeviceOutputCodec.h)
+    - 入力 (任意) は同じ周期の排他 capture クライアントから毎周期読み、専用スレッド内の FIFO で
+      render 周期に合わせる。出力デバイスは必須 (render イベントが時計になる)
+
+    デバイスの生成・open・close は Message Thread。RT スレッドはロックを持たない
+    (コールバックの差し替えだけ CriticalSection で守る。JUCE のデバイス実装と同じ)。
+    Windows 専用。種別の一覧へは MainWindow が ASIO の差し替えの後で追加する。
+*/
+class NativeWasapiExclusiveDeviceType : public juce::AudioIODeviceType
+{
+public:
+    static constexpr const char* kTypeName = "WASAPI Exclusive (Native)";
+
+    // affinityMgr: RT スレッドのアフィニティ (AudioRealtime) に使う。nullptr なら固定しない
+    explicit NativeWasapiExclusiveDeviceType(ThreadAffinityManager* affinityMgr);
+    ~NativeWasapiExclusiveDeviceType() override;
+
+    void scanForDevices() override;
+    juce::StringArray getDeviceNames(bool wantInputNames) const override;
+    int getDefaultDeviceIndex(bool forInput) const override;
+    int getIndexOfDevice(juce::AudioIODevice* device, bool asInput) const override;
+    bool hasSeparateInputsAndOutputs() const override { return true; }
+    juce::AudioIODevice* createDevice(const juce::String& outputDeviceName,
+                                      const juce::String& inputDeviceName) override;
+
+    struct Endpoint
+    {
+        juce::String name;   // 表示名 (重複は " (2)" などで区別)
+        juce::String id;     // IMMDevice::GetId
+    };
+
+private:
+    std::vector<Endpoint> outputs;
+    std::vector<Endpoint> inputs;
+    int defaultOutput = -1;
+    int defaultInput = -1;
+    bool scanned = false;
+    ThreadAffinityManager* affinityManager;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NativeWasapiExclusiveDeviceType)
+};
@@ -1,6 +1,10 @@
 #include "NoiseShaperLearner.h"
+#include "NoiseShaperWarmStart.h"
+#include "NoiseShaperStateJournal.h"
 #include "AudioEngine.h"
 #include "core/ThreadAffinityManager.h"
+#include "core/TimeUtils.h"
+#include "EtwTrace.h"
 #include <JuceHeader.h>
 
 #include <algorithm>
@@ -16,10 +20,34 @@
 namespace
 {
     constexpr double kOutputHeadroom = 0.8912509381337456;
+    constexpr double kUnstablePenalty = 1e18;   // 安定性チェック不合格候補の fitness
     constexpr int kSegmentHop = AudioSegment::kLength / 2;
     constexpr int kRecentSampleRequest = AudioSegment::kLength + (kSegmentHop * (NoiseShaperLearner::kMaxTrainingSegments - 1));
+    static_assert(convo::warmstart::kSampleRateBanks == kAdaptiveNoiseShaperSampleRateBankCount
+                  && convo::warmstart::kBitDepths == kAdaptiveBitDepthCount
+                  && convo::warmstart::kModes == kLearningModeCount,
+                  "warm-start bank layout must match AudioEngine::getAdaptiveCoeffBankIndex");
+    static_assert(NoiseShaperLearner::kMaxLearningTargets == kAdaptiveBitDepthCount,
+                  "one learning target per bit depth of a (sample rate, mode) pair");
+    static_assert(kAdaptiveCaptureBurstBlocks * AudioBlock::kMaxSamples >= kRecentSampleRequest,
+                  "capture burst must cover one generation's training window");
     juce::ThreadPool g_saveThreadPool(1);
 
+    // Hybrid score: 時間領域 RMS と周波数領域 composite score のブレンド
+    //   低レベル (-40/-30dBFS) → 時間領域寄り、高レベル (-20/-10dBFS) → 周波数領域寄り
+    double blendSegmentScore(double targetLevelDb, const MklFftEvaluator::Result& result) noexcept
+    {
+        double alpha = 0.5;
+        if (targetLevelDb < -30.0) alpha = 0.3;
+        else if (targetLevelDb > -15.0) alpha = 0.7;
+
+        // result.timeDomainRms は sigma、result.compositeScore はおおよそ N * sigma^2 * penalties。
+        // 経験的スケーリングで両者を同程度のレンジ (典型ノイズで ~0.0–1.0) に揃える
+        const double timeScore = result.timeDomainRms * 1000.0;
+        const double freqScore = std::sqrt(result.compositeScore / MklFftEvaluator::kFftLength) * 1000.0;
+        return alpha * freqScore + (1.0 - alpha) * timeScore;
+    }
+
     uint64_t hashLearningSeed(uint64_t seed, uint64_t value) noexcept
     {
         seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
@@ -40,17 +68,31 @@ namespace
         seed = hashLearningSeed(seed, static_cast<uint64_t>(restartIndex));
         return seed;
     }
+
+    // 世代ごとの保存はジャーナルへの追記のみ (書き込みスレッドで行い、Message Thread はディスクを待たない)
+    void appendJournalRecord(int bankIndex,
+                             const convo::NoiseShaperLearnerState& state,
+                             const std::array<double, NoiseShaperLearner::kOrder>& coefficients)
+    {
+        static_assert(NoiseShaperLearner::kOrder == convo::NoiseShaperStateJournal::kCoeffCount);
+        convo::NoiseShaperStateJournal::Record record;
+        record.bankIndex = bankIndex;
+        record.state = state;
+        std::copy(coefficients.begin(), coefficients.end(), record.coefficients.begin());
+        convo::NoiseShaperStateJournal::getInstance().append(record);
+    }
 }
 
 NoiseShaperLearner::NoiseShaperLearner(AudioEngine& engineRef,
-                                       LockFreeRingBuffer<AudioBlock, 4096>& captureQueueRef)
+                                       AdaptiveCaptureQueue& captureQueueRef)
     : engine(engineRef),
     // lastSaveTime の初期化（コンストラクタ本体で行う）
       captureQueue(captureQueueRef),
       rcuReader(engineRef.getRetireRouter())
 {
-    const size_t populationCount = static_cast<size_t>(CmaEsOptimizer::kPopulation * CmaEsOptimizer::kDim);
-    const size_t fitnessCount = static_cast<size_t>(CmaEsOptimizer::kPopulation);
+    // 副 target の候補も同じバッファに並べる (target 0 の領域は従来どおり先頭 kPopulation 行)
+    const size_t populationCount = static_cast<size_t>(kCandidateSlots * CmaEsOptimizer::kDim);
+    const size_t fitnessCount = static_cast<size_t>(kCandidateSlots);
 
     auto populationBuffer = convo::makeAlignedArray<double>(populationCount);
     auto fitnessBuffer = convo::makeAlignedArray<double>(fitnessCount);
@@ -64,6 +106,8 @@ NoiseShaperLearner::NoiseShaperLearner(AudioEngine& engineRef,
     }
     candidatePopulation = std::move(populationBuffer);
     candidateFitness = std::move(fitnessBuffer);
+    // 評価コンテキスト・セグメントバッファはインラインなので sizeof に含まれる
+    memoryCharge.set(sizeof(NoiseShaperLearner) + (populationCount + fitnessCount) * sizeof(double));
 
     for (auto& c : bestCoefficients)
         convo::publishAtomic(c, 0.0, std::memory_order_release);
@@ -95,6 +139,7 @@ void NoiseShaperLearner::startLearning(bool resume)
             + juce::String(" fit=") + juce::String(candidateFitnessData() == nullptr ? "null" : "ok"));
         convo::publishAtomic(errorMessage, "Candidate buffers unavailable", std::memory_order_release);
         convo::publishAtomic(progress.status, Status::Error, std::memory_order_release);
+        publishProgressView();
         return;
     }
 
@@ -145,6 +190,7 @@ void NoiseShaperLearner::startLearning(bool resume)
     convo::publishAtomic(progress.learningMode, static_cast<int>(activeMode), std::memory_order_release);
     lastGenerationStart = std::chrono::steady_clock::time_point{};
     applyPhaseParams(activeMode, currentPhase);
+    publishProgressView();
 
     try
     {
@@ -170,6 +216,8 @@ void NoiseShaperLearner::startLearning(bool resume)
         convo::publishAtomic(progress.status, Status::Error, std::memory_order_release);
         convo::publishAtomic(workerState, WorkerState::Idle, std::memory_order_release);
     }
+    if (convo::consumeAtomic(progress.status, std::memory_order_acquire) == Status::Error)
+        publishProgressView();
 }
 
 void NoiseShaperLearner::stopLearning()
@@ -183,6 +231,7 @@ void NoiseShaperLearner::stopLearning()
     convo::publishAtomic(pendingResume, false, std::memory_order_release);
     convo::publishAtomic(progress.status, Status::Idle, std::memory_order_release);
     convo::publishAtomic(errorMessage, nullptr, std::memory_order_release);
+    publishProgressView();
 }
 
 // ★ Bug#8: 停止シーケンス共通化ヘルパー
@@ -194,12 +243,19 @@ void NoiseShaperLearner::shutdownWorkerThread() noexcept
     jassert(std::this_thread::get_id() != workerThread.get_id());
     if (std::this_thread::get_id() == workerThread.get_id())
         std::terminate();
-    convo::publishAtomic(stopRequested, true, std::memory_order_release);
+    requestStop();
+    workerThread.join();
+}
+
+void NoiseShaperLearner::requestStop() noexcept
+{
+    if (!workerThread.joinable())
+        return;
+    convo::publishAtomic(stopRequested, true, std::memory_order_release); // release: worker 側 stopRequested acquire と HB
     workerThread.request_stop();
     // 全 Condition Variable を通知
     evaluationDispatchCv.notify_all();
     intervalCv_.notify_all();
-    workerThread.join();
 }
 
 void NoiseShaperLearner::setLearningMode(LearningMode mode) noexcept
@@ -211,6 +267,7 @@ void NoiseShaperLearner::setLearningMode(LearningMode mode) noexcept
     {
         activeMode = mode;
         convo::publishAtomic(progress.learningMode, static_cast<int>(activeMode), std::memory_order_release);
+        publishProgressView();
     }
 }
 
@@ -303,7 +360,13 @@ void NoiseShaperLearner::applyPhaseParams(LearningMode mode, int phase) noexcept
         currentLevelWeights = { 0.5, 0.3, 0.1, 0.1 };
     }
 
+    // z / −z の組で引く: 組の勝ち側だけがエリート候補になり、同じ評価数で平均の更新がぶれにくい
+    optParams.mirroredSampling = true;
+
     optimizer.setParams(optParams);
+    phaseOptimizerParams = optParams;
+    for (int t = 1; t < activeTargetCount; ++t)
+        auxTargets[static_cast<size_t>(t - 1)].optimizer.setParams(optParams);
 }
 
 void NoiseShaperLearner::handleModeSwitch() noexcept
@@ -318,6 +381,7 @@ void NoiseShaperLearner::handleModeSwitch() noexcept
     const int bd = engine.getDitherBitDepth();
     int bankIndex = AudioEngine::getAdaptiveCoeffBankIndex(sr, bd, activeMode);
     engine.setAdaptiveNoiseShaperState(bankIndex, currentState);
+    storeAuxTargetStates();
 
     activeMode = pendingMode;
     convo::publishAtomic(progress.learningMode, static_cast<int>(activeMode), std::memory_order_release);
@@ -347,6 +411,9 @@ void NoiseShaperLearner::handleModeSwitch() noexcept
         convo::publishAtomic(progress.totalGenerations, 0, std::memory_order_release);
     }
 
+    // 副 target も新しいモードのバンクへ切り替える
+    setupAuxTargets();
+
     // 現在の再生時間に基づいてフェーズを再計算し、パラメータを適用
     currentPhase = computePhase(activeMode, accumulatedPlaybackSeconds);
     convo::publishAtomic(progress.currentPhase, currentPhase, std::memory_order_release);
@@ -366,6 +433,29 @@ const NoiseShaperLearner::Progress& NoiseShaperLearner::getProgress() const noex
     return progress;
 }
 
+convo::NoiseShaperLearnerProgressView NoiseShaperLearner::getProgressView() const noexcept
+{
+    return progressView.read();
+}
+
+void NoiseShaperLearner::publishProgressView() noexcept
+{
+    std::lock_guard<std::mutex> lock(progressViewWriteMutex);
+    convo::NoiseShaperLearnerProgressView view;
+    // relaxed: 項目ごとの最新値を集めるだけ。UI への受け渡しは progressView の seqlock が担う
+    view.status = convo::consumeAtomic(progress.status, std::memory_order_relaxed);
+    view.iteration = convo::consumeAtomic(progress.iteration, std::memory_order_relaxed);
+    view.totalGenerations = convo::consumeAtomic(progress.totalGenerations, std::memory_order_relaxed);
+    view.processCount = convo::consumeAtomic(progress.processCount, std::memory_order_relaxed);
+    view.segmentCount = convo::consumeAtomic(progress.segmentCount, std::memory_order_relaxed);
+    view.bestScore = convo::consumeAtomic(progress.bestScore, std::memory_order_relaxed);
+    view.latestScore = convo::consumeAtomic(progress.latestScore, std::memory_order_relaxed);
+    view.elapsedPlaybackSeconds = convo::consumeAtomic(progress.elapsedPlaybackSeconds, std::memory_order_relaxed);
+    view.currentPhase = convo::consumeAtomic(progress.currentPhase, std::memory_order_relaxed);
+    view.learningMode = convo::consumeAtomic(progress.learningMode, std::memory_order_relaxed);
+    progressView.publish(view); // ライタはロックで 1 本なので必ず成功する
+}
+
 void NoiseShaperLearner::getState(State& outState) const noexcept
 {
     optimizer.serializeTo(outState.mean, outState.covarianceUpperTriangle, outState.sigma);
@@ -392,6 +482,7 @@ void NoiseShaperLearner::setState(const State& inState) noexcept
     convo::publishAtomic(progress.currentPhase, currentPhase, std::memory_order_release);
     convo::publishAtomic(progress.processCount, inState.processCount, std::memory_order_release);
     convo::publishAtomic(progress.totalGenerations, inState.totalGenerations, std::memory_order_release);
+    publishProgressView();
 }
 
 int NoiseShaperLearner::copyBestScoreHistory(double* destination, int maxPoints) noexcept
@@ -503,7 +594,6 @@ void NoiseShaperLearner::stopEvaluationWorkers() noexcept
         evaluationWorkersShouldExit = false;
         completedAuxEvaluationWorkers = 0;
         pendingEvaluationSegmentCount = 0;
-        pendingEvaluationBitDepth = 24;
     }
 }
 
@@ -515,7 +605,9 @@ void NoiseShaperLearner::configureEvaluationContexts(double sampleRateHz) noexce
 
 void NoiseShaperLearner::evaluationWorkerMain(int workerIndex, std::stop_token stopToken) noexcept
 {
-    engine.getAffinityManager().applyCurrentThreadPolicy(ThreadType::LearnerEval, workerIndex);
+    auto& affinity = engine.getAffinityManager();
+    uint32_t appliedAffinityGeneration = affinity.getLearnerEvalPolicyGeneration();
+    affinity.applyCurrentThreadPolicy(ThreadType::LearnerEval, workerIndex);
 
     // FTZ/DAZ をスレッド開始時に設定する（スレッドローカルフラグ）。
     // 評価ワーカーは MKL DFTI および LatticeNoiseShaper を使用するため、
@@ -530,7 +622,6 @@ void NoiseShaperLearner::evaluationWorkerMain(int workerIndex, std::stop_token s
         try
         {
             int segmentCount = 0;
-            int evaluationBitDepth = 24;
 
             {
                 std::unique_lock<std::mutex> lock(evaluationDispatchMutex);
@@ -545,14 +636,23 @@ void NoiseShaperLearner::evaluationWorkerMain(int workerIndex, std::stop_token s
                     return;
 
                 ++observedDispatchSerial;
-                segmentCount = pendingEvaluationSegmentCount;
-                evaluationBitDepth = pendingEvaluationBitDepth;
+                // スロットリングで今回の参加数から外れたワーカーは評価せず完了だけ報告する
+                segmentCount = (workerIndex < pendingEvaluationWorkerCount) ? pendingEvaluationSegmentCount : 0;
+            }
+
+            // ★ Audio 負荷による退避/返却 (AudioEngine::updateAffinityRebalance) はここで反映する
+            if (const uint32_t generation = affinity.getLearnerEvalPolicyGeneration();
+                generation != appliedAffinityGeneration)
+            {
+                appliedAffinityGeneration = generation;
+                affinity.applyCurrentThreadPolicy(ThreadType::LearnerEval, workerIndex);
             }
 
+            const uint64_t cpuTimeBefore = ThreadAffinityManager::currentThreadCpuTime();
             runEvaluationJobsForWorker(workerIndex,
                                        segmentCount,
-                                       evaluationBitDepth,
                                        &stopToken);
+            affinity.addLearnerEvalCpuTime(ThreadAffinityManager::currentThreadCpuTime() - cpuTimeBefore);
 
             {
                 const std::scoped_lock<std::mutex> lock(evaluationDispatchMutex);
@@ -588,137 +688,629 @@ void NoiseShaperLearner::evaluationWorkerMain(int workerIndex, std::stop_token s
 
 void NoiseShaperLearner::runEvaluationJobsForWorker(int workerIndex,
                                                     int numSegments,
-                                                    int evaluationBitDepth,
                                                     const std::stop_token* stopToken) noexcept
 {
-    if (numSegments <= 0)
+    if (numSegments <= 0 || passSegmentCount <= 0)
         return;
 
-    auto& context = evaluationWorkers[static_cast<size_t>(workerIndex)].context;
+    auto& slot = evaluationWorkers[static_cast<size_t>(workerIndex)];
+    auto& context = slot.context;
+    const auto busyStart = std::chrono::steady_clock::now();
+
+    // バッチの量子化パラメータはビット深度ごとなので、別 target のグループへ移ったら prepare し直す
+    // (作業領域は再確保しない)。確保できない場合はスカラー格子で 1 候補ずつ評価する
+    int preparedBitDepth = 0;
+    bool batchReady = false;
+    context.loadedGroup = -1;
+    const EvaluationFidelity fidelity = pendingEvaluationFidelity;
+    std::uint64_t& evaluationCounter = (fidelity == EvaluationFidelity::Screening)
+        ? slot.stats.screeningEvaluations
+        : slot.stats.segmentEvaluations;
+
+    // ★ work-stealing: 自分の連続範囲 (同一グループの連続セグメント) を先に消化し、
+    //    空になったら他ワーカーの残りの後半を奪う。E コアやプリエンプトされたワーカーの
+    //    残りは速いワーカーが引き取るため、世代時間が最も遅いワーカーに律速されない。
+    int task = 0;
+    while (!convo::consumeAtomic(stopRequested, std::memory_order_acquire)
+        && (stopToken == nullptr || !stopToken->stop_requested())
+        && evaluationTasks.pop(workerIndex, task))
+    {
+        const int group = task / passSegmentCount;
+        const int evaluationBitDepth = targetBitDepths[static_cast<size_t>(evaluationGroups[static_cast<size_t>(group)].target)];
+        if (evaluationBitDepth != preparedBitDepth)
+        {
+            batchReady = context.batchShaper.prepare(evaluationBitDepth, AudioSegment::kLength)
+                      && context.batchShaper.laneCount() >= evaluationGroupLanes;
+            preparedBitDepth = evaluationBitDepth;
+            context.loadedGroup = -1;
+        }
+        evaluationCounter += static_cast<std::uint64_t>(
+            runEvaluationTask(context, group, passSegments[static_cast<size_t>(task % passSegmentCount)],
+                              evaluationBitDepth, batchReady, fidelity));
+        ++slot.stats.tasks;
+
+        // acq_rel: 最後の 1 タスクを終えたワーカーが他ワーカーのセグメントスコアを観測できる
+        if (convo::fetchSubAtomic(groupRemainingTasks[static_cast<size_t>(group)], 1, std::memory_order_acq_rel) == 1)
+            finishEvaluationGroup(group);
+    }
+
+    slot.stats.busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - busyStart).count();
+}
+
+int NoiseShaperLearner::runEvaluationTask(EvaluationContext& context,
+                                           int group,
+                                           const SegmentRef& ref,
+                                           int evaluationBitDepth,
+                                           bool batchReady,
+                                           EvaluationFidelity fidelity) noexcept
+{
+    juce::ScopedNoDenormals noDenormals;
 
     // ★ B03: sharedMappedPopulation は evaluatePopulation() が Generation ごとに1回計算済み
     //    Worker はここで再計算せず、共有バッファを読み取り専用で使用する。
     const double(*mappedPopulation)[CmaEsOptimizer::kDim] =
         reinterpret_cast<double(*)[CmaEsOptimizer::kDim]>(sharedMappedPopulation.get());
 
-    while (!convo::consumeAtomic(stopRequested, std::memory_order_acquire)
-        && (stopToken == nullptr || !stopToken->stop_requested()))
+    const auto& evaluationGroup = evaluationGroups[static_cast<size_t>(group)];
+    const int firstJob = evaluationGroup.firstJob;
+    const int count = evaluationGroup.count;
+    const auto& leveled = levelBuckets[ref.level][ref.segment];
+    const bool screening = fidelity == EvaluationFidelity::Screening;
+    auto& segmentScores = screening ? candidateScreeningScores : candidateSegmentScores;
+
+    if (!batchReady)
     {
-        const int populationIndex = convo::fetchAddAtomic(nextEvaluationCandidateIndex, 1, std::memory_order_acq_rel);
-        if (populationIndex >= CmaEsOptimizer::kPopulation)
-            break;
+        int evaluated = 0;
+        for (int lane = 0; lane < count; ++lane)
+        {
+            const int candidate = evaluationJobIndices[static_cast<size_t>(firstJob + lane)];
+            if (candidateStable[static_cast<size_t>(candidate)])
+            {
+                segmentScores[static_cast<size_t>(candidate)][static_cast<size_t>(ref.level)][static_cast<size_t>(ref.segment)]
+                    = scoreSegmentScalar(context, mappedPopulation[candidate], evaluationBitDepth, ref, fidelity);
+                ++evaluated;
+            }
+        }
+        return evaluated;
+    }
 
-        const double score = evaluateCandidateMapped(context,
-                                                     mappedPopulation[populationIndex],
-                                                     numSegments,
-                                                     evaluationBitDepth);
-        candidateFitnessData()[populationIndex] = score;
-        convo::fetchAddAtomic(progress.processCount, 1, std::memory_order_release);
+    auto& batch = context.batchShaper;
+    if (context.loadedGroup != group)
+    {
+        // レーンへ係数を配置 (LatticeNoiseShaper::setCoefficients と同じ clampCoeff)。
+        // 不安定候補・空きレーンは係数 0 で回し、結果は使わない
+        for (int lane = 0; lane < batch.laneCount(); ++lane)
+        {
+            const int candidate = (lane < count) ? evaluationJobIndices[static_cast<size_t>(firstJob + lane)] : -1;
+            if (candidate < 0 || !candidateStable[static_cast<size_t>(candidate)])
+            {
+                batch.clearLaneCoefficients(lane);
+                continue;
+            }
+
+            std::array<double, kOrder> clamped {};
+            for (int k = 0; k < kOrder; ++k)
+                clamped[static_cast<size_t>(k)] = LatticeNoiseShaper::clampCoeff(mappedPopulation[candidate][k]);
+            batch.setLaneCoefficients(lane, clamped.data());
+        }
+        context.loadedGroup = group;
+    }
+
+    // 予備選別は格子も評価器が読む先頭 kScreeningFftLength 点だけ回す
+    const int length = screening ? MklFftEvaluator::kScreeningFftLength : AudioSegment::kLength;
+    batch.reset();
+    batch.processChannel(0, leveled.segment.left, length, kOutputHeadroom);
+    batch.processChannel(1, leveled.segment.right, length, kOutputHeadroom);
+
+    // 安定レーンの誤差をまとめて 1 回の evaluateBatch へ渡す (閾値は全レーン共通)
+    static_assert(convo::dsp::LatticeNoiseShaperBatch::kMaxLanes <= MklFftEvaluator::kMaxBatchSegments,
+                  "one lane group must fit in a single evaluateBatch chunk");
+    const double* errorLeft[MklFftEvaluator::kMaxBatchSegments];
+    const double* errorRight[MklFftEvaluator::kMaxBatchSegments];
+    const std::array<double, MklFftEvaluator::kSpectrumBins>* thresholds[MklFftEvaluator::kMaxBatchSegments];
+    int laneCandidates[MklFftEvaluator::kMaxBatchSegments];
+    int stableLanes = 0;
+    for (int lane = 0; lane < count; ++lane)
+    {
+        const int candidate = evaluationJobIndices[static_cast<size_t>(firstJob + lane)];
+        if (!candidateStable[static_cast<size_t>(candidate)])
+            continue;
+
+        errorLeft[stableLanes] = batch.laneError(0, lane);
+        errorRight[stableLanes] = batch.laneError(1, lane);
+        thresholds[stableLanes] = &leveled.segment.maskingThresholds;
+        laneCandidates[stableLanes] = candidate;
+        ++stableLanes;
     }
+
+    MklFftEvaluator::Result results[MklFftEvaluator::kMaxBatchSegments];
+    if (screening)
+        context.fftEvaluator.evaluateScreeningBatch(errorLeft, errorRight, stableLanes, thresholds, results);
+    else
+        context.fftEvaluator.evaluateBatch(errorLeft, errorRight, stableLanes, thresholds, results);
+
+    for (int i = 0; i < stableLanes; ++i)
+        segmentScores[static_cast<size_t>(laneCandidates[i])][static_cast<size_t>(ref.level)][static_cast<size_t>(ref.segment)]
+            = blendSegmentScore(kTargetLevelsDB[ref.level], results[i]);
+    return stableLanes;
+}
+
+void NoiseShaperLearner::finishEvaluationGroup(int group) noexcept
+{
+    const auto& evaluationGroup = evaluationGroups[static_cast<size_t>(group)];
+    const int firstJob = evaluationGroup.firstJob;
+    const int count = evaluationGroup.count;
+
+    // 予選ではセグメント [0, segmentEnd) の部分スコア、本選 / Racing 無効時は全セグメントのスコア。
+    // 予備選別のパスは fitness ではなく candidateScreeningFitness に書く
+    const bool screening = pendingEvaluationFidelity == EvaluationFidelity::Screening;
+    for (int lane = 0; lane < count; ++lane)
+    {
+        const int candidate = evaluationJobIndices[static_cast<size_t>(firstJob + lane)];
+        const auto& scores = screening ? candidateScreeningScores : candidateSegmentScores;
+        const double score = candidateStable[static_cast<size_t>(candidate)]
+            ? combineSegmentScores(scores[static_cast<size_t>(candidate)], pendingEvaluationSegmentEnd)
+            : kUnstablePenalty;
+        if (screening)
+            candidateScreeningFitness[static_cast<size_t>(candidate)] = score;
+        else
+            candidateFitnessData()[candidate] = score;
+    }
+
+    // 本選は予選で数えた候補の続き、予備選別した target の本評価は予備選別で数えた候補の一部なので
+    // processCount に加えない。副 target は updateAuxTargets で数える
+    const bool firstVisit = screening
+        || (pendingEvaluationSegmentBegin == 0 && !targetScreened[static_cast<size_t>(evaluationGroup.target)]);
+    if (firstVisit && evaluationGroup.target == 0)
+        convo::fetchAddAtomic(progress.processCount, count, std::memory_order_release);
+    convo::fetchAddAtomic(completedEvaluationCandidates[static_cast<size_t>(evaluationGroup.target)], count, std::memory_order_acq_rel);
+}
+
+int NoiseShaperLearner::dispatchEvaluationJobs(int jobCount,
+                                               int numSegments,
+                                               int segmentBegin,
+                                               int segmentEnd,
+                                               const std::stop_token& stopToken,
+                                               EvaluationFidelity fidelity)
+{
+    const double(*mappedPopulation)[CmaEsOptimizer::kDim] =
+        reinterpret_cast<double(*)[CmaEsOptimizer::kDim]>(sharedMappedPopulation.get());
+
+    // ワーカーは前回のディスパッチを終えて待機中なので、ここで書いてよい (passSegments と同じ)
+    pendingEvaluationFidelity = fidelity;
+
+    // このパスで評価する (level, segment) の一覧
+    passSegmentCount = 0;
+    for (int i = 0; i < kNumLevels; ++i)
+        for (int j = segmentBegin; j < std::min(levelBucketCounts[i], segmentEnd); ++j)
+            passSegments[static_cast<size_t>(passSegmentCount++)] = SegmentRef { i, j };
+
+    // 候補はレーン数 (AVX2: 4 / AVX-512: 8) ずつグループにまとめ、1 本の格子再帰で評価する。
+    // グループは target をまたがない (レーンの量子化ビット深度が揃う)
+    evaluationGroupLanes = convo::dsp::LatticeNoiseShaperBatch::lanesFor(convo::dsp::activeKernels().isa);
+    int groupCount = 0;
+    for (int job = 0; job < jobCount; ++job)
+    {
+        const int target = evaluationJobIndices[static_cast<size_t>(job)] / CmaEsOptimizer::kPopulation;
+        if (groupCount == 0
+            || evaluationGroups[static_cast<size_t>(groupCount - 1)].target != target
+            || evaluationGroups[static_cast<size_t>(groupCount - 1)].count == evaluationGroupLanes)
+            evaluationGroups[static_cast<size_t>(groupCount++)] = EvaluationGroup { job, 0, target };
+        ++evaluationGroups[static_cast<size_t>(groupCount - 1)].count;
+    }
+
+    // 安定性判定はここで 1 回だけ行い、全ワーカーが同じ結果を読む
+    const bool stabilityCheck = convo::consumeAtomic(settings.enableStabilityCheck, std::memory_order_acquire);
+    for (int job = 0; job < jobCount; ++job)
+    {
+        const int candidate = evaluationJobIndices[static_cast<size_t>(job)];
+        candidateStable[static_cast<size_t>(candidate)] = !stabilityCheck
+            || LatticeNoiseShaper::isStable(mappedPopulation[candidate], kOrder);
+        if (fidelity == EvaluationFidelity::Screening)
+            candidateScreeningFitness[static_cast<size_t>(candidate)] = std::numeric_limits<double>::max();
+        else
+            candidateFitnessData()[candidate] = std::numeric_limits<double>::max();
+    }
+    for (int group = 0; group < groupCount; ++group)
+        convo::publishAtomic(groupRemainingTasks[static_cast<size_t>(group)], passSegmentCount, std::memory_order_relaxed);
+    for (auto& completed : completedEvaluationCandidates)
+        convo::publishAtomic(completed, 0, std::memory_order_relaxed);
+
+    if (passSegmentCount == 0)
+    {
+        for (int group = 0; group < groupCount; ++group)
+            finishEvaluationGroup(group);
+        return jobCount;
+    }
+
+    // ★ 締切余裕が少ない間は参加ワーカーを絞る。外れたワーカーのスロットは空にして盗みの対象からも外す
+    const int participatingWorkers = (evaluationWorkerLimit > 0)
+        ? std::min(activeEvaluationWorkerCount, evaluationWorkerLimit)
+        : activeEvaluationWorkerCount;
+    evaluationTasks.reset(groupCount * passSegmentCount, participatingWorkers);
+
+    {
+        const std::scoped_lock<std::mutex> lock(evaluationDispatchMutex);
+        pendingEvaluationWorkerCount = participatingWorkers;
+        pendingEvaluationSegmentCount = numSegments;
+        pendingEvaluationSegmentBegin = segmentBegin;
+        pendingEvaluationSegmentEnd = segmentEnd;
+        convo::publishAtomic(completedAuxEvaluationWorkers, 0, std::memory_order_release);
+        convo::fetchAddAtomic(evaluationDispatchSerial, static_cast<uint32_t>(1), std::memory_order_release);
+    }
+
+    if (activeAuxEvaluationWorkerCount > 0)
+        evaluationDispatchCv.notify_all();
+
+    runEvaluationJobsForWorker(0, numSegments, &stopToken);
+
+    if (activeAuxEvaluationWorkerCount > 0)
+    {
+        std::unique_lock<std::mutex> lock(evaluationDispatchMutex);
+        evaluationDispatchCv.wait(lock, [this]
+        {
+            return convo::consumeAtomic(completedAuxEvaluationWorkers, std::memory_order_acquire) >= activeAuxEvaluationWorkerCount
+                || convo::consumeAtomic(stopRequested, std::memory_order_acquire);
+        });
+    }
+
+    int completedCandidates = 0;
+    for (const auto& completed : completedEvaluationCandidates)
+        completedCandidates += convo::consumeAtomic(completed, std::memory_order_acquire);
+    return completedCandidates;
+}
+
+int NoiseShaperLearner::selectRaceSurvivors(const int* candidates, int candidateCount, bool* survived, int firstSlot) noexcept
+{
+    const double* fitness = candidateFitnessData();
+
+    // order は候補バッファ全体でのインデックス (1 target 分)。candidates は evaluationJobIndices を指してもよい
+    // (先に写してから書き戻す)
+    const int evaluatedCandidates = std::min(candidateCount, CmaEsOptimizer::kPopulation);
+    int order[CmaEsOptimizer::kPopulation] = {};
+    std::copy(candidates, candidates + evaluatedCandidates, order);
+    std::sort(order, order + evaluatedCandidates, [fitness](int a, int b) { return fitness[a] < fitness[b]; });
+
+    // CmaEsOptimizer::update() が使うのは上位 kElite のみ。kElite 位の候補を基準に、
+    // それより確実に悪い候補だけを打ち切る (上位 kElite は必ず本選へ進む)
+    const int reference = order[std::min(CmaEsOptimizer::kElite, evaluatedCandidates) - 1];
+    const auto& referenceScores = candidateSegmentScores[static_cast<size_t>(reference)];
+
+    // 予選セグメントごとの重み (combineSegmentScores と同じ加重平均を対差にも適用する)
+    double levelSegmentWeight[kNumLevels] = {};
+    double totalWeight = 0.0;
+    for (int i = 0; i < kNumLevels; ++i)
+    {
+        if (levelBucketCounts[i] == 0) continue;
+        totalWeight += currentLevelWeights[static_cast<size_t>(i)];
+    }
+    int raceSegments = 0;
+    double sumSquaredWeights = 0.0;
+    for (int i = 0; i < kNumLevels; ++i)
+    {
+        const int n = std::min(levelBucketCounts[i], kRaceSegmentsPerLevel);
+        if (n == 0 || totalWeight <= 0.0) continue;
+        levelSegmentWeight[i] = currentLevelWeights[static_cast<size_t>(i)] / (totalWeight * n);
+        raceSegments += n;
+        sumSquaredWeights += levelSegmentWeight[i] * levelSegmentWeight[i] * n;
+    }
+
+    int survivorCount = 0;
+    for (int rank = 0; rank < evaluatedCandidates; ++rank)
+    {
+        const int index = order[rank];
+        bool keep = rank < CmaEsOptimizer::kElite;
+
+        if (!keep && fitness[index] < kUnstablePenalty && raceSegments >= 2)
+        {
+            // 同じセグメント上の対差 d = x_c − x_ref で比較する (セグメント間の難易度差が相殺される)
+            const auto& scores = candidateSegmentScores[static_cast<size_t>(index)];
+            double differences[kMaxTrainingSegments] = {};
+            int n = 0;
+            for (int i = 0; i < kNumLevels; ++i)
+                for (int j = 0; j < std::min(levelBucketCounts[i], kRaceSegmentsPerLevel); ++j)
+                    differences[n++] = scores[static_cast<size_t>(i)][static_cast<size_t>(j)]
+                                     - referenceScores[static_cast<size_t>(i)][static_cast<size_t>(j)];
+
+            const double meanDifference = fitness[index] - fitness[reference];
+            const double plainMean = std::accumulate(differences, differences + n, 0.0) / n;
+            double variance = 0.0;
+            for (int k = 0; k < n; ++k)
+                variance += (differences[k] - plainMean) * (differences[k] - plainMean);
+            variance /= (n - 1);
+
+            // 加重平均の標準誤差 ≈ sqrt(Σw²) · sd(d)
+            const double standardError = std::sqrt(sumSquaredWeights * variance);
+            keep = !(meanDifference > 0.0 && meanDifference > kRaceConfidenceZ * standardError);
+        }
+        else if (!keep)
+        {
+            // 不安定ペナルティ候補は本選不要、予選セグメントが 1 個以下なら判定できないので残す
+            keep = fitness[index] < kUnstablePenalty;
+        }
+
+        survived[index] = keep;
+        if (keep)
+            evaluationJobIndices[static_cast<size_t>(firstSlot + survivorCount++)] = index;
+    }
+    return survivorCount;
+}
+
+int NoiseShaperLearner::selectScreeningPromotions(int target, bool promoteAll, int firstSlot) noexcept
+{
+    const int first = target * CmaEsOptimizer::kPopulation;
+    int order[CmaEsOptimizer::kPopulation] = {};
+    std::iota(order, order + CmaEsOptimizer::kPopulation, first);
+    std::stable_sort(order, order + CmaEsOptimizer::kPopulation, [this](int a, int b)
+    {
+        return candidateScreeningFitness[static_cast<size_t>(a)] < candidateScreeningFitness[static_cast<size_t>(b)];
+    });
+
+    // 通過枠は kElite 以上 (予選・本選と update() が上位 kElite を必要とする)
+    const int promote = promoteAll
+        ? CmaEsOptimizer::kPopulation
+        : screeningGates[static_cast<size_t>(target)].promoteCount(CmaEsOptimizer::kPopulation, CmaEsOptimizer::kElite);
+    std::copy(order, order + promote, evaluationJobIndices.begin() + firstSlot);
+    return promote;
 }
 
 int NoiseShaperLearner::evaluatePopulation(int numSegments,
                                            int evaluationBitDepth,
                                            int& bestCandidateIndex,
                                            double& bestCandidateScore,
-                                           const std::stop_token& stopToken)
+                                           const std::stop_token& stopToken,
+                                           int targetCount)
 {
     if (convo::consumeAtomic(stopRequested, std::memory_order_acquire)
         || stopToken.stop_requested())
         return 0;
 
-    convo::publishAtomic(nextEvaluationCandidateIndex, 0, std::memory_order_release);
+    targetCount = std::clamp(targetCount, 1, kMaxLearningTargets);
+    targetBitDepths[0] = evaluationBitDepth;
+    for (int t = 1; t < targetCount; ++t)
+        targetBitDepths[static_cast<size_t>(t)] = auxTargets[static_cast<size_t>(t - 1)].bitDepth;
 
     // ★ B03: Generation 開始時に vdTanh を1回だけ計算し、全 Worker で共有
     //    sharedMappedPopulation は evaluatePopulation 終了時まで有効。
     {
-        constexpr int totalCoeffs = CmaEsOptimizer::kPopulation * CmaEsOptimizer::kDim;
+        constexpr int totalCoeffs = kCandidateSlots * CmaEsOptimizer::kDim;
         const size_t requiredSize = static_cast<size_t>(totalCoeffs);
         if (!sharedMappedPopulation)
         {
             auto newBuf = convo::makeAlignedArray<double>(requiredSize);
             sharedMappedPopulation = std::move(newBuf);
+            if (sharedMappedPopulation)
+                memoryCharge.set(memoryCharge.bytes() + requiredSize * sizeof(double));
         }
 
+        // 使う target の領域だけ写像する
+        const int activeCoeffs = targetCount * CmaEsOptimizer::kPopulation * CmaEsOptimizer::kDim;
         alignas(64) double tanhBuffer[totalCoeffs] = {};
         const auto* population = candidatePopulationMatrix();
-        vdTanh(totalCoeffs,
+        vdTanh(activeCoeffs,
                reinterpret_cast<const double*>(population),
                tanhBuffer);
 
         const double safetyMargin = convo::consumeAtomic(settings.coeffSafetyMargin, std::memory_order_acquire);
-        for (int i = 0; i < totalCoeffs; ++i)
+        for (int i = 0; i < activeCoeffs; ++i)
             sharedMappedPopulation[i] = LatticeNoiseShaper::clampCoeff(tanhBuffer[i], safetyMargin);
     }
 
+    // ★ 予備選別: target ごとのゲートが今世代に予備選別するか・照合世代かを決める。
+    //   どれかのワーカーの評価器が予備選別の FFT を持たなければ使わない
+    const bool screeningEnabled = convo::consumeAtomic(settings.enableScreening, std::memory_order_acquire)
+        && std::all_of(evaluationWorkers.begin(), evaluationWorkers.begin() + activeEvaluationWorkerCount,
+                       [](const EvaluationWorkerSlot& slot) { return slot.context.fftEvaluator.hasScreeningFidelity(); });
+    using ScreeningPlan = convo::ScreeningFidelityGate<CmaEsOptimizer::kPopulation>::Plan;
+    std::array<ScreeningPlan, kMaxLearningTargets> screeningPlans {};
+    int jobCount = 0;
+    for (int t = 0; t < kMaxLearningTargets; ++t)
     {
-        const std::scoped_lock<std::mutex> lock(evaluationDispatchMutex);
-        pendingEvaluationSegmentCount = numSegments;
-        pendingEvaluationBitDepth = evaluationBitDepth;
-        convo::publishAtomic(completedAuxEvaluationWorkers, 0, std::memory_order_release);
-        convo::fetchAddAtomic(evaluationDispatchSerial, static_cast<uint32_t>(1), std::memory_order_release);
+        if (screeningEnabled && t < targetCount)
+            screeningPlans[static_cast<size_t>(t)] = screeningGates[static_cast<size_t>(t)].beginGeneration();
+        targetScreened[static_cast<size_t>(t)] = screeningPlans[static_cast<size_t>(t)].screen;
+        if (targetScreened[static_cast<size_t>(t)])
+        {
+            std::iota(evaluationJobIndices.begin() + jobCount,
+                      evaluationJobIndices.begin() + jobCount + CmaEsOptimizer::kPopulation,
+                      t * CmaEsOptimizer::kPopulation);
+            jobCount += CmaEsOptimizer::kPopulation;
+        }
     }
 
-    if (activeAuxEvaluationWorkerCount > 0)
-        evaluationDispatchCv.notify_all();
-
-    runEvaluationJobsForWorker(0, numSegments, evaluationBitDepth, &stopToken);
+    if (jobCount > 0)
+    {
+        dispatchEvaluationJobs(jobCount, numSegments, 0, kScreeningSegmentsPerLevel, stopToken, EvaluationFidelity::Screening);
+        if (convo::consumeAtomic(stopRequested, std::memory_order_acquire) || stopToken.stop_requested())
+            return 0;
+    }
 
-    if (activeAuxEvaluationWorkerCount > 0)
+    // 本評価の候補: 予備選別した target は通過枠 (照合世代は全候補)、他は全候補。
+    // 予選・本選が evaluationJobIndices を書き換えるので target ごとの一覧を写しておく
+    std::array<int, kCandidateSlots> fullJobs {};
+    std::array<int, kMaxLearningTargets> fullJobBegin {};
+    std::array<int, kMaxLearningTargets> fullJobCount {};
+    jobCount = 0;
+    for (int t = 0; t < targetCount; ++t)
     {
-        std::unique_lock<std::mutex> lock(evaluationDispatchMutex);
-        evaluationDispatchCv.wait(lock, [this]
+        const size_t target = static_cast<size_t>(t);
+        fullJobBegin[target] = jobCount;
+        if (targetScreened[target])
         {
-            return convo::consumeAtomic(completedAuxEvaluationWorkers, std::memory_order_acquire) >= activeAuxEvaluationWorkerCount
-                || convo::consumeAtomic(stopRequested, std::memory_order_acquire);
-        });
+            fullJobCount[target] = selectScreeningPromotions(t, screeningPlans[target].check, jobCount);
+        }
+        else
+        {
+            std::iota(evaluationJobIndices.begin() + jobCount,
+                      evaluationJobIndices.begin() + jobCount + CmaEsOptimizer::kPopulation,
+                      t * CmaEsOptimizer::kPopulation);
+            fullJobCount[target] = CmaEsOptimizer::kPopulation;
+        }
+        jobCount += fullJobCount[target];
     }
+    std::copy(evaluationJobIndices.begin(), evaluationJobIndices.begin() + jobCount, fullJobs.begin());
 
-    const int evaluatedCandidates = std::min(convo::consumeAtomic(nextEvaluationCandidateIndex, std::memory_order_acquire),
-                                             CmaEsOptimizer::kPopulation);
+    // Racing: 予選 (各レベル先頭 kRaceSegmentsPerLevel 個) で打ち切れるセグメントが残る場合のみ有効
+    bool racing = convo::consumeAtomic(settings.enableRacing, std::memory_order_acquire);
+    if (racing)
+    {
+        bool hasRemainingSegments = false;
+        for (int i = 0; i < kNumLevels; ++i)
+            hasRemainingSegments = hasRemainingSegments || levelBucketCounts[i] > kRaceSegmentsPerLevel;
+        racing = hasRemainingSegments;
+    }
+    const int firstPassEnd = racing ? kRaceSegmentsPerLevel : kMaxSegmentsPerLevel;
 
-    bestCandidateIndex = 0;
-    bestCandidateScore = std::numeric_limits<double>::max();
+    // 全 target の候補を 1 回のディスパッチに並べ、ワーカーは target をまたいでタスクを取る
+    dispatchEvaluationJobs(jobCount, numSegments, 0, firstPassEnd, stopToken);
 
-    // First pass: find top candidates
-    std::vector<int> sortedIndices(evaluatedCandidates);
-    std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
-    std::sort(sortedIndices.begin(), sortedIndices.end(), [this](int a, int b) {
-        return candidateFitnessData()[a] < candidateFitnessData()[b];
-    });
+    std::array<int, kMaxLearningTargets> evaluatedCandidates {};
+    bool allTargetsRaceable = true;
+    for (int t = 0; t < targetCount; ++t)
+    {
+        evaluatedCandidates[static_cast<size_t>(t)] =
+            convo::consumeAtomic(completedEvaluationCandidates[static_cast<size_t>(t)], std::memory_order_acquire);
+        allTargetsRaceable = allTargetsRaceable && evaluatedCandidates[static_cast<size_t>(t)] >= CmaEsOptimizer::kElite;
+    }
 
-    // Elite Re-evaluation: Re-evaluate top 3 candidates to reduce noise/variance
-    const int numElitesToReevaluate = std::min(3, evaluatedCandidates);
-    for (int i = 0; i < numElitesToReevaluate; ++i)
+    if (racing && allTargetsRaceable
+        && !convo::consumeAtomic(stopRequested, std::memory_order_acquire) && !stopToken.stop_requested())
     {
-        if (convo::consumeAtomic(stopRequested, std::memory_order_acquire)
-            || stopToken.stop_requested())
-            break;
+        bool survived[kCandidateSlots] = {};
+        int survivorCount = 0;
+        for (int t = 0; t < targetCount; ++t)
+            survivorCount += selectRaceSurvivors(fullJobs.data() + fullJobBegin[static_cast<size_t>(t)],
+                                                 fullJobCount[static_cast<size_t>(t)], survived, survivorCount);
+
+        // 本選: 生存候補だけ残りのセグメントを評価し、全セグメントのスコアで fitness を置き換える
+        dispatchEvaluationJobs(survivorCount, numSegments,
+                               kRaceSegmentsPerLevel, kMaxSegmentsPerLevel, stopToken);
+
+        // 打ち切った候補 (fitness は予選スコアのまま) は最下位の生存候補の後ろへ予選順に並べる。
+        // update() が使うのは上位 kElite のみなので、値そのものは順位付けにしか使われない
+        for (int t = 0; t < targetCount; ++t)
+        {
+            const int* first = fullJobs.data() + fullJobBegin[static_cast<size_t>(t)];
+            const int* last = first + fullJobCount[static_cast<size_t>(t)];
+            double worstSurvivor = 0.0;
+            for (const int* c = first; c != last; ++c)
+                if (survived[*c] && candidateFitnessData()[*c] < kUnstablePenalty)
+                    worstSurvivor = std::max(worstSurvivor, candidateFitnessData()[*c]);
+            for (const int* c = first; c != last; ++c)
+                if (!survived[*c] && candidateFitnessData()[*c] < kUnstablePenalty)
+                    candidateFitnessData()[*c] += worstSurvivor;
+        }
+    }
 
-        const int idx = sortedIndices[i];
-        // Use a different context or just re-run (if segments were randomized, this would be more effective)
-        // For now, we just re-run to ensure stability.
-        const auto* population = candidatePopulationMatrix();
-        const double secondScore = evaluateCandidate(evaluationWorkers[0].context, population[idx], numSegments, evaluationBitDepth);
-        candidateFitnessData()[idx] = (candidateFitnessData()[idx] + secondScore) * 0.5;
+    // 予備選別で落とした候補は本評価した候補の最下位の後ろへ予備選別順に並べる (打ち切りと同じ扱い)。
+    // 照合世代は全候補を本評価したので、両スコアの順位をゲートへ渡す (エリート再評価の前の順位)
+    for (int t = 0; t < targetCount; ++t)
+    {
+        const size_t target = static_cast<size_t>(t);
+        if (!targetScreened[target])
+            continue;
+        if (evaluatedCandidates[target] < fullJobCount[target])
+        {
+            evaluatedCandidates[target] = 0;   // 停止要求で本評価が途中まで
+            continue;
+        }
+
+        const int first = t * CmaEsOptimizer::kPopulation;
+        bool promoted[CmaEsOptimizer::kPopulation] = {};
+        double worstPromoted = 0.0;
+        for (int k = 0; k < fullJobCount[target]; ++k)
+        {
+            const int candidate = fullJobs[static_cast<size_t>(fullJobBegin[target] + k)];
+            promoted[candidate - first] = true;
+            if (candidateFitnessData()[candidate] < kUnstablePenalty)
+                worstPromoted = std::max(worstPromoted, candidateFitnessData()[candidate]);
+        }
+        for (int c = first; c < first + CmaEsOptimizer::kPopulation; ++c)
+        {
+            const double screeningScore = candidateScreeningFitness[static_cast<size_t>(c)];
+            if (!promoted[c - first])
+                candidateFitnessData()[c] = (screeningScore < kUnstablePenalty) ? worstPromoted + screeningScore : kUnstablePenalty;
+        }
+
+        if (screeningPlans[target].check)
+        {
+            double screeningScores[CmaEsOptimizer::kPopulation] = {};
+            double fullScores[CmaEsOptimizer::kPopulation] = {};
+            int n = 0;
+            for (int c = first; c < first + CmaEsOptimizer::kPopulation; ++c)
+            {
+                if (candidateScreeningFitness[static_cast<size_t>(c)] >= kUnstablePenalty || candidateFitnessData()[c] >= kUnstablePenalty)
+                    continue;
+                screeningScores[n] = candidateScreeningFitness[static_cast<size_t>(c)];
+                fullScores[n] = candidateFitnessData()[c];
+                ++n;
+            }
+            screeningGates[target].recordCheck(screeningScores, fullScores, n, CmaEsOptimizer::kElite, CmaEsOptimizer::kElite);
+        }
+        evaluatedCandidates[target] = CmaEsOptimizer::kPopulation;
     }
 
-    // Final pass to find the best
-    for (int populationIndex = 0; populationIndex < evaluatedCandidates; ++populationIndex)
+    for (int t = 0; t < targetCount; ++t)
     {
-        if (convo::consumeAtomic(stopRequested, std::memory_order_acquire)
-            || stopToken.stop_requested())
-            break;
+        const int evaluated = evaluatedCandidates[static_cast<size_t>(t)];
+        const auto* population = candidatePopulationMatrix() + t * CmaEsOptimizer::kPopulation;
+        double* fitness = candidateFitnessData() + t * CmaEsOptimizer::kPopulation;
+        int targetBestIndex = 0;
+        double targetBestScore = std::numeric_limits<double>::max();
+
+        // First pass: find top candidates
+        std::vector<int> sortedIndices(evaluated);
+        std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
+        std::sort(sortedIndices.begin(), sortedIndices.end(), [fitness](int a, int b) {
+            return fitness[a] < fitness[b];
+        });
 
-        const double score = candidateFitnessData()[populationIndex];
-        if (score < bestCandidateScore)
+        // Elite Re-evaluation: Re-evaluate top 3 candidates to reduce noise/variance
+        const int numElitesToReevaluate = std::min(3, evaluated);
+        for (int i = 0; i < numElitesToReevaluate; ++i)
         {
-            bestCandidateScore = score;
-            bestCandidateIndex = populationIndex;
+            if (convo::consumeAtomic(stopRequested, std::memory_order_acquire)
+                || stopToken.stop_requested())
+                break;
+
+            const int idx = sortedIndices[i];
+            // Use a different context or just re-run (if segments were randomized, this would be more effective)
+            // For now, we just re-run to ensure stability.
+            const double secondScore = evaluateCandidate(evaluationWorkers[0].context, population[idx], numSegments,
+                                                         targetBitDepths[static_cast<size_t>(t)]);
+            fitness[idx] = (fitness[idx] + secondScore) * 0.5;
+        }
+
+        // Final pass to find the best
+        for (int populationIndex = 0; populationIndex < evaluated; ++populationIndex)
+        {
+            if (convo::consumeAtomic(stopRequested, std::memory_order_acquire)
+                || stopToken.stop_requested())
+                break;
+
+            const double score = fitness[populationIndex];
+            if (score < targetBestScore)
+            {
+                targetBestScore = score;
+                targetBestIndex = populationIndex;
+            }
+        }
+
+        if (t == 0)
+        {
+            bestCandidateIndex = targetBestIndex;
+            bestCandidateScore = targetBestScore;
+        }
+        else
+        {
+            auto& aux = auxTargets[static_cast<size_t>(t - 1)];
+            aux.evaluatedCandidates = evaluated;
+            aux.bestCandidateIndex = targetBestIndex;
+            aux.bestCandidateScore = targetBestScore;
         }
     }
 
-    return evaluatedCandidates;
+    return evaluatedCandidates[0];
 }
 
 void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
@@ -769,6 +1361,7 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
                    && !stopToken.stop_requested())
             {
                 drainCaptureQueue(activeSession);
+                publishProgressView();
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
             }
 
@@ -855,6 +1448,8 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
                 break;
             }
             ++mainLoopIter;
+            // 待機で continue する周回もここを通るので、セグメント数・フェーズ・状態の変化はここで UI に出る
+            publishProgressView();
             const auto thisGenerationStart = std::chrono::steady_clock::now();
 
             // インターバル待機（start-to-start、condition_variable 使用）
@@ -868,6 +1463,23 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
             }
             lastGenerationStart = thisGenerationStart;
 
+            // ★ 学習スロットリング: Audio callback の締切余裕に応じて参加ワーカー数と世代間休止を決める
+            {
+                const auto throttle = engine.getLearnerThrottle();
+                evaluationWorkerLimit = throttle.workerLimit;
+                // 共有スケジューラに上位の仕事 (rebuild / IR 読み込み / アップグレード) があれば 1 ワーカーまで絞る
+                if (engine.getBackgroundScheduler().hasWorkAbove(convo::BackgroundPriority::Learning))
+                    evaluationWorkerLimit = 1;
+                if (throttle.pauseMs > 0)
+                {
+                    std::unique_lock<std::mutex> lock(intervalMutex_);
+                    intervalCv_.wait_for(lock, std::chrono::milliseconds(throttle.pauseMs), [this, &stopToken]() -> bool {
+                        return convo::consumeAtomic(stopRequested, std::memory_order_acquire)
+                            || stopToken.stop_requested();
+                    });
+                }
+            }
+
             handleModeSwitch();
 
             // 実再生時間ベースフェーズ判定
@@ -882,6 +1494,7 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
             if (activeSession.sampleRateHz != currentSession.sampleRateHz
                 || activeSession.adaptiveCoeffBankIndex != currentSession.adaptiveCoeffBankIndex)
             {
+                storeAuxTargetStates();
                 activeSession = currentSession;
                 resetLearningSession(activeSession, true);
                 bestScore = std::numeric_limits<double>::max();
@@ -894,6 +1507,8 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
             if (activeSession.sessionId != currentSession.sessionId)
                 activeSession.sessionId = 0;
 
+            publishCaptureStride();
+
             const DrainStats latestDrainStats = drainCaptureQueue(activeSession);
             cumulativeDrainStats.acceptedBlocks += latestDrainStats.acceptedBlocks;
             cumulativeDrainStats.droppedBySession += latestDrainStats.droppedBySession;
@@ -931,7 +1546,11 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
             }
 
             convo::publishAtomic(progress.status, Status::Running, std::memory_order_release);
+            const bool etwLearner = convo::EtwTrace::isEnabled(convo::EtwTrace::kLearner);
+            const uint64_t generationStartUs = etwLearner ? convo::getCurrentTimeUs() : 0;
             optimizer.sample(candidatePopulationMatrix());
+            for (int t = 1; t < activeTargetCount; ++t)
+                auxTargets[static_cast<size_t>(t - 1)].optimizer.sample(candidatePopulationMatrix() + t * CmaEsOptimizer::kPopulation);
 
             int bestCandidateIndex = 0;
             double bestCandidateScore = std::numeric_limits<double>::max();
@@ -940,7 +1559,8 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
                                                                evaluationBitDepth,
                                                                bestCandidateIndex,
                                                                bestCandidateScore,
-                                                               stopToken);
+                                                               stopToken,
+                                                               activeTargetCount);
 
             if (convo::consumeAtomic(stopRequested, std::memory_order_acquire) || stopToken.stop_requested())
                 break;
@@ -961,6 +1581,7 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
             }
 
             optimizer.update(candidatePopulationMatrix(), candidateFitnessData());
+            updateAuxTargets(true);
 
             CmaEsOptimizer::toParcor(candidatePopulationMatrix()[bestCandidateIndex], parcor);
             if (bestCandidateScore < bestScore && bestCandidateScore < std::numeric_limits<double>::max())
@@ -977,19 +1598,15 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
 
             convo::publishAtomic(progress.iteration, generation + 1, std::memory_order_release);
             convo::fetchAddAtomic(progress.totalGenerations, 1, std::memory_order_acq_rel);
+            publishProgressView();
             ++generation;
+            // ★ ETW: 世代の評価区間 (sample → update) を Audio Thread の xrun と並べて見る
+            if (etwLearner)
+                convo::EtwTrace::learnerGeneration(generation, evaluatedCandidates, bestCandidateScore, bestScore,
+                                                   convo::getCurrentTimeUs() - generationStartUs);
 
             // 終了条件の判定
-            double targetSeconds = 0.0;
-            switch (activeMode)
-            {
-                case LearningMode::Shortest:   targetSeconds = 10.0; break;
-                case LearningMode::Short:      targetSeconds = 30.0; break;
-                case LearningMode::Middle:     targetSeconds = 60.0; break;
-                case LearningMode::Long:       targetSeconds = 120.0; break;
-                case LearningMode::Ultra:      targetSeconds = 300.0; break;
-                case LearningMode::Continuous: targetSeconds = std::numeric_limits<double>::max(); break;
-            }
+            const double targetSeconds = getTargetPlaybackSeconds(activeMode);
 
             if (accumulatedPlaybackSeconds >= targetSeconds)
             {
@@ -1029,12 +1646,296 @@ void NoiseShaperLearner::workerThreadMain(std::stop_token stopToken)
         convo::publishAtomic(progress.status, Status::Error, std::memory_order_release);
     }
 
+    // 次の live セッションはフェーズ 1 (間引きなし) から始める
+    publishedCaptureStride = 1;
+    convo::publishAtomic(engine.adaptiveCaptureStrideRt, 1, std::memory_order_relaxed);
+
     stopEvaluationWorkers();
+    publishProgressView();
     // Transition:
     // Running/Stopping -> Idle
     convo::publishAtomic(workerState, WorkerState::Idle, std::memory_order_release);
 }
 
+double NoiseShaperLearner::getTargetPlaybackSeconds(LearningMode mode) noexcept
+{
+    switch (mode)
+    {
+        case LearningMode::Shortest:   return 10.0;
+        case LearningMode::Short:      return 30.0;
+        case LearningMode::Middle:     return 60.0;
+        case LearningMode::Long:       return 120.0;
+        case LearningMode::Ultra:      return 300.0;
+        case LearningMode::Continuous: return std::numeric_limits<double>::max();
+    }
+    return std::numeric_limits<double>::max();
+}
+
+bool NoiseShaperLearner::runOfflineSession(const OfflineSession& session,
+                                           OfflineResult& result,
+                                           std::stop_token stopToken)
+{
+    result = OfflineResult {};
+    result.coefficients = session.initialCoefficients;
+
+    if (candidatePopulationMatrix() == nullptr || candidateFitnessData() == nullptr
+        || !session.readAudio || session.sampleRateHz <= 0.0)
+        return false;
+
+    std::vector<double> feedLeft(static_cast<size_t>(AudioSegment::kLength));
+    std::vector<double> feedRight(static_cast<size_t>(AudioSegment::kLength));
+
+    // live セッションと同じ Idle -> Running 遷移で startLearning() と排他する
+    WorkerState expectedState = WorkerState::Idle;
+    if (workerThread.joinable()
+        || !convo::compareExchangeAtomic(workerState,
+                                         expectedState,
+                                         WorkerState::Running,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire))
+        return false;
+
+    // workerThreadMain と同じく呼び出しスレッドで FTZ/DAZ を有効化する
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+
+    // ベンチマーク用に評価ワーカー数を固定できる (セッション終了時に既定値へ戻す)
+    const int defaultEvaluationWorkerCount = activeEvaluationWorkerCount;
+    evaluationWorkerLimit = 0;   // オフライン実行はスロットリングしない
+    if (session.evaluationWorkerCount > 0)
+    {
+        activeEvaluationWorkerCount = std::clamp(session.evaluationWorkerCount, 1, kMaxParallelEvaluators);
+        activeAuxEvaluationWorkerCount = activeEvaluationWorkerCount - 1;
+    }
+    for (auto& slot : evaluationWorkers)
+        slot.stats = EvaluationWorkerStats {};
+
+    convo::publishAtomic(stopRequested, false, std::memory_order_release);
+    convo::publishAtomic(errorMessage, nullptr, std::memory_order_release);
+
+    activeMode = session.mode;
+    convo::publishAtomic(progress.learningMode, static_cast<int>(activeMode), std::memory_order_release);
+    sessionSampleRate = session.sampleRateHz;
+    sessionBitDepth = session.bitDepth;
+    currentSessionId = 0;
+    accumulatedPlaybackSeconds = 0.0;
+    currentPhase = 1;
+    segmentBuffer.clear();
+
+    convo::publishAtomic(progress.iteration, 0, std::memory_order_release);
+    convo::publishAtomic(progress.segmentCount, 0, std::memory_order_release);
+    convo::publishAtomic(progress.bestScore, 0.0, std::memory_order_release);
+    convo::publishAtomic(progress.latestScore, 0.0, std::memory_order_release);
+    convo::publishAtomic(progress.elapsedPlaybackSeconds, 0.0, std::memory_order_release);
+    convo::publishAtomic(progress.currentPhase, currentPhase, std::memory_order_release);
+    convo::publishAtomic(progress.processCount, 0, std::memory_order_release);
+    convo::publishAtomic(progress.totalGenerations, 0, std::memory_order_release);
+    convo::publishAtomic(historyCount, 0, std::memory_order_release);
+    {
+        const std::scoped_lock<std::mutex> lock(historyMutex);
+        bestScoreHistory.fill(0.0);
+        historyHead = 0;
+    }
+
+    configureEvaluationContexts(sessionSampleRate);
+    applyPhaseParams(activeMode, currentPhase);
+    optimizer.initFromParcor(session.initialCoefficients.data());
+    // 同じコーパスからは同じ係数が得られるよう、バンクごとに固定シードを使う
+    optimizer.setSeed(session.seed != 0
+                          ? session.seed
+                          : makeDeterministicRestartSeed(static_cast<int>(sessionSampleRate + 0.5),
+                                                         sessionBitDepth,
+                                                         session.bankIndex,
+                                                         0,
+                                                         0));
+    for (int i = 0; i < kOrder; ++i)
+        convo::publishAtomic(bestCoefficients[static_cast<size_t>(i)],
+                             session.initialCoefficients[static_cast<size_t>(i)],
+                             std::memory_order_release);
+
+    // 副バンクは同じ音声・セグメント集合・フェーズ進行で学習し、評価タスクだけ主バンクと混ぜて分配する
+    activeTargetCount = 1 + std::clamp(session.extraTargetCount, 0, kMaxLearningTargets - 1);
+    for (auto& gate : screeningGates)
+        gate.reset();
+    for (int t = 1; t < activeTargetCount; ++t)
+    {
+        const auto& extra = session.extraTargets[static_cast<size_t>(t - 1)];
+        auto& aux = auxTargets[static_cast<size_t>(t - 1)];
+        aux.bitDepth = extra.bitDepth;
+        aux.bankIndex = extra.bankIndex;
+        aux.bestCoefficients = extra.initialCoefficients;
+        aux.optimizer.initFromParcor(extra.initialCoefficients.data());
+        aux.optimizer.setSeed(extra.seed != 0
+                                  ? extra.seed
+                                  : makeDeterministicRestartSeed(static_cast<int>(sessionSampleRate + 0.5),
+                                                                 extra.bitDepth,
+                                                                 extra.bankIndex,
+                                                                 0,
+                                                                 0));
+        aux.optimizer.setParams(phaseOptimizerParams);
+        aux.bestScore = std::numeric_limits<double>::max();
+        aux.storedBestScore = 0.0;
+        aux.playbackOffsetSeconds = 0.0;
+        aux.iteration = 0;
+        aux.processCount = 0;
+        aux.totalGenerations = 0;
+        aux.evaluatedCandidates = 0;
+    }
+
+    double targetSeconds = getTargetPlaybackSeconds(activeMode);
+    if (targetSeconds >= std::numeric_limits<double>::max())
+        targetSeconds = kOfflineContinuousPlaybackSeconds;
+
+    startEvaluationWorkers();
+    convo::publishAtomic(progress.status, Status::Running, std::memory_order_release);
+    publishProgressView();
+
+    double parcor[CmaEsOptimizer::kDim] = {};
+    double bestScore = std::numeric_limits<double>::max();
+    bool sourceExhausted = false;
+
+    while (!stopToken.stop_requested())
+    {
+        const int newPhase = computePhase(activeMode, accumulatedPlaybackSeconds);
+        if (newPhase != currentPhase)
+        {
+            currentPhase = newPhase;
+            convo::publishAtomic(progress.currentPhase, currentPhase, std::memory_order_release);
+            applyPhaseParams(activeMode, newPhase);
+        }
+
+        // live では 1 世代の間隔 (generationIntervalSeconds) に届く分の音声をまとめて読む
+        int remaining = std::max(1, static_cast<int>(std::lround(generationIntervalSeconds * sessionSampleRate)));
+        while (remaining > 0)
+        {
+            const int read = session.readAudio(feedLeft.data(), feedRight.data(),
+                                               std::min(remaining, AudioSegment::kLength));
+            if (read <= 0)
+            {
+                sourceExhausted = true;
+                break;
+            }
+            segmentBuffer.pushBlock(feedLeft.data(), feedRight.data(), read);
+            accumulatedPlaybackSeconds += static_cast<double>(read) / sessionSampleRate;
+            remaining -= read;
+        }
+        convo::publishAtomic(progress.elapsedPlaybackSeconds, accumulatedPlaybackSeconds, std::memory_order_release);
+
+        const int segmentCount = buildTrainingSegments();
+        convo::publishAtomic(progress.segmentCount, segmentCount, std::memory_order_release);
+        if (segmentCount < 2)
+        {
+            if (sourceExhausted)
+                break;
+            continue;
+        }
+
+        optimizer.sample(candidatePopulationMatrix());
+        for (int t = 1; t < activeTargetCount; ++t)
+            auxTargets[static_cast<size_t>(t - 1)].optimizer.sample(candidatePopulationMatrix() + t * CmaEsOptimizer::kPopulation);
+
+        int bestCandidateIndex = 0;
+        double bestCandidateScore = std::numeric_limits<double>::max();
+        const int evaluatedCandidates = evaluatePopulation(segmentCount,
+                                                           sessionBitDepth,
+                                                           bestCandidateIndex,
+                                                           bestCandidateScore,
+                                                           stopToken,
+                                                           activeTargetCount);
+        if (stopToken.stop_requested())
+            break;
+
+        updateAuxTargets(false);
+
+        if (evaluatedCandidates >= CmaEsOptimizer::kElite)
+        {
+            for (int fi = evaluatedCandidates; fi < CmaEsOptimizer::kPopulation; ++fi)
+                candidateFitnessData()[fi] = std::numeric_limits<double>::max();
+
+            optimizer.update(candidatePopulationMatrix(), candidateFitnessData());
+
+            // publishGenerationResult と同じ写像 (tanh) で反射係数にする
+            CmaEsOptimizer::toParcor(candidatePopulationMatrix()[bestCandidateIndex], parcor);
+            if (bestCandidateScore < bestScore && bestCandidateScore < std::numeric_limits<double>::max())
+            {
+                bestScore = bestCandidateScore;
+                for (int i = 0; i < kOrder; ++i)
+                {
+                    const double k = std::tanh(parcor[i]);
+                    result.coefficients[static_cast<size_t>(i)] = k;
+                    convo::publishAtomic(bestCoefficients[static_cast<size_t>(i)], k, std::memory_order_release);
+                }
+                convo::publishAtomic(progress.bestScore, bestScore, std::memory_order_release);
+            }
+
+            if (bestCandidateScore < std::numeric_limits<double>::max())
+            {
+                convo::publishAtomic(progress.latestScore, bestCandidateScore, std::memory_order_release);
+                appendHistoryPoint(bestCandidateScore);
+            }
+
+            ++result.generations;
+            convo::publishAtomic(progress.iteration, result.generations, std::memory_order_release);
+            convo::fetchAddAtomic(progress.totalGenerations, 1, std::memory_order_acq_rel);
+            publishProgressView();
+
+            if (session.onGeneration)
+            {
+                // evaluatePopulation は全ワーカーの完了を待って戻るので、各スロットの統計はここで読める
+                OfflineGenerationReport report;
+                report.generation = result.generations;
+                report.playbackSeconds = accumulatedPlaybackSeconds;
+                report.bestScore = bestScore;
+                report.latestScore = bestCandidateScore;
+                report.evaluatedCandidates = evaluatedCandidates;
+                for (int workerIndex = 0; workerIndex < activeEvaluationWorkerCount; ++workerIndex)
+                {
+                    report.segmentEvaluations += evaluationWorkers[static_cast<size_t>(workerIndex)].stats.segmentEvaluations;
+                    report.screeningEvaluations += evaluationWorkers[static_cast<size_t>(workerIndex)].stats.screeningEvaluations;
+                }
+                session.onGeneration(report);
+            }
+        }
+
+        if (accumulatedPlaybackSeconds >= targetSeconds)
+        {
+            result.completed = true;
+            break;
+        }
+        if (sourceExhausted)
+            break;
+    }
+
+    stopEvaluationWorkers();
+
+    result.evaluationWorkerCount = activeEvaluationWorkerCount;
+    for (int workerIndex = 0; workerIndex < activeEvaluationWorkerCount; ++workerIndex)
+        result.workerStats[static_cast<size_t>(workerIndex)] = evaluationWorkers[static_cast<size_t>(workerIndex)].stats;
+    activeEvaluationWorkerCount = defaultEvaluationWorkerCount;
+    activeAuxEvaluationWorkerCount = std::max(0, activeEvaluationWorkerCount - 1);
+
+    result.bestScore = (bestScore < std::numeric_limits<double>::max()) ? bestScore : 0.0;
+    result.playbackSeconds = accumulatedPlaybackSeconds;
+    getState(result.state);
+    result.state.learningMode = static_cast<int>(activeMode);
+    for (int t = 1; t < activeTargetCount; ++t)
+    {
+        const auto& aux = auxTargets[static_cast<size_t>(t - 1)];
+        auto& extraResult = result.extraResults[static_cast<size_t>(t - 1)];
+        extraResult.coefficients = aux.bestCoefficients;
+        getAuxTargetState(aux, extraResult.state);
+        extraResult.state.learningMode = static_cast<int>(activeMode);
+        extraResult.bestScore = (aux.bestScore < std::numeric_limits<double>::max()) ? aux.bestScore : 0.0;
+        extraResult.generations = aux.iteration;
+    }
+    activeTargetCount = 1;
+
+    convo::publishAtomic(progress.status, result.completed ? Status::Completed : Status::Idle, std::memory_order_release);
+    publishProgressView();
+    convo::publishAtomic(workerState, WorkerState::Idle, std::memory_order_release);
+    return true;
+}
+
 NoiseShaperLearner::SessionSignature NoiseShaperLearner::captureSessionSignature() noexcept
 {
     SessionSignature session;
@@ -1104,7 +2005,7 @@ void NoiseShaperLearner::resetLearningSession(const SessionSignature& session, b
         {
             setState(savedState);
         }
-        else
+        else if (!tryWarmStartFromNeighbourBank(session.adaptiveCoeffBankIndex))
         {
             double initialCoefficients[kOrder] = {};
             engine.getAdaptiveCoefficientsForSampleRateAndBitDepth(this->sessionSampleRate, this->sessionBitDepth, initialCoefficients, kOrder);
@@ -1114,60 +2015,152 @@ void NoiseShaperLearner::resetLearningSession(const SessionSignature& session, b
                 convo::publishAtomic(bestCoefficients[static_cast<size_t>(i)], initialCoefficients[i], std::memory_order_release);
         }
     }
+
+    setupAuxTargets();
+    publishProgressView();
+}
+
+bool NoiseShaperLearner::tryWarmStartFromNeighbourBank(int bankIndex) noexcept
+{
+    // 学習済みバンクのやり直し (resume なし) は従来どおり自分の係数から始める
+    State ownState;
+    if (engine.getAdaptiveNoiseShaperState(bankIndex, ownState) && ownState.iteration > 0)
+        return false;
+
+    const auto isUsableState = [](const State& state) noexcept
+    {
+        if (state.iteration < convo::warmstart::kMinConvergedGenerations
+            || !convo::numeric_policy::isFinite(state.sigma) || state.sigma <= 0.0)
+            return false;
+        for (double v : state.mean)
+            if (!convo::numeric_policy::isFinite(v))
+                return false;
+        for (double v : state.covarianceUpperTriangle)
+            if (!convo::numeric_policy::isFinite(v))
+                return false;
+        return true;
+    };
+
+    double bankRatesHz[convo::warmstart::kSampleRateBanks] = {};
+    for (int i = 0; i < convo::warmstart::kSampleRateBanks; ++i)
+        bankRatesHz[i] = AudioEngine::getAdaptiveSampleRateBankHz(i);
+
+    const auto choice = convo::warmstart::selectSourceBank(bankIndex, bankRatesHz, [&](int candidateBank)
+    {
+        State candidateState;
+        return engine.getAdaptiveNoiseShaperState(candidateBank, candidateState) && isUsableState(candidateState);
+    });
+
+    State sourceState;
+    if (choice.bankIndex < 0
+        || !engine.getAdaptiveNoiseShaperState(choice.bankIndex, sourceState)
+        || !isUsableState(sourceState))
+        return false;
+
+    // レートが違うバンクの共分散は別の帯域での形なので引き継がない
+    const double sigma = convo::warmstart::warmStartSigma(sourceState.sigma, choice.distance);
+    optimizer.initFromDistribution(sourceState.mean,
+                                   choice.sameSampleRate ? sourceState.covarianceUpperTriangle : nullptr,
+                                   sigma);
+
+    for (int i = 0; i < kOrder; ++i)
+        convo::publishAtomic(bestCoefficients[static_cast<size_t>(i)], sourceState.bestCoefficients[i], std::memory_order_release);
+
+    juce::Logger::writeToLog("[NoiseShaperLearner] warm start: bank=" + juce::String(bankIndex)
+        + " from=" + juce::String(choice.bankIndex)
+        + " distance=" + juce::String(choice.distance, 3)
+        + " sigma=" + juce::String(sigma, 4)
+        + " covariance=" + juce::String(choice.sameSampleRate ? "kept" : "identity"));
+    return true;
+}
+
+void NoiseShaperLearner::publishCaptureStride() noexcept
+{
+    // フェーズ 1 は全ブロックを使う。以降は 1 世代間隔に少なくとも 2 バースト届く範囲で間引く
+    //   (Shortest の短い世代間隔や 44.1 kHz では 1 のまま、Ultra フェーズ 3 では上限まで)
+    int stride = 1;
+    if (currentPhase >= 2 && sessionSampleRate > 0.0
+        && convo::consumeAtomic(settings.enableCaptureDecimation, std::memory_order_acquire))
+    {
+        constexpr double kBurstSamples = static_cast<double>(kAdaptiveCaptureBurstBlocks * AudioBlock::kMaxSamples);
+        const double intervalSamples = generationIntervalSeconds * sessionSampleRate;
+        stride = std::clamp(static_cast<int>(intervalSamples / (2.0 * kBurstSamples)), 1, kAdaptiveCaptureMaxStride);
+    }
+
+    if (stride == publishedCaptureStride)
+        return;
+    publishedCaptureStride = stride;
+    convo::publishAtomic(engine.adaptiveCaptureStrideRt, stride, std::memory_order_relaxed);
 }
 
 NoiseShaperLearner::DrainStats NoiseShaperLearner::drainCaptureQueue(const SessionSignature& session) noexcept
 {
     DrainStats stats {};
-    AudioBlock block {};
-    while (captureQueue.pop(block))
+    double blockLeft[AudioBlock::kMaxSamples];
+    double blockRight[AudioBlock::kMaxSamples];
+    // ★ 一括 drain: 溜まっているブロックをスロット上でそのまま読み (AudioBlock のコピーなし)、
+    //   readIndex の解放は 1 回にまとめる。drain 中に届いたブロックは次回に回す
+    captureQueue.drain([&](const AudioBlock* blocks, size_t count) noexcept
     {
-        if (block.numSamples <= 0)
-            continue;
-
-        const bool sessionIdCompatible = (session.sessionId == 0u)
-            || (block.sessionId == 0u)
-            || (block.sessionId == session.sessionId);
-        if (!sessionIdCompatible)
+        for (size_t blockIndex = 0; blockIndex < count; ++blockIndex)
         {
-            ++stats.droppedBySession;
-            ++stats.dropReasonCounts[static_cast<size_t>(DropReason::Session)];
-            continue;
-        }
+            const AudioBlock& block = blocks[blockIndex];
+            if (block.numSamples <= 0)
+                continue;
 
-        const bool sampleRateCompatible = (session.sampleRateHz <= 0)
-            || (block.sampleRateHz <= 0)
-            || (block.sampleRateHz == session.sampleRateHz);
+            const bool sessionIdCompatible = (session.sessionId == 0u)
+                || (block.sessionId == 0u)
+                || (block.sessionId == session.sessionId);
+            if (!sessionIdCompatible)
+            {
+                ++stats.droppedBySession;
+                ++stats.dropReasonCounts[static_cast<size_t>(DropReason::Session)];
+                continue;
+            }
 
-        if (!sampleRateCompatible)
-        {
-            ++stats.droppedBySampleRate;
-            ++stats.dropReasonCounts[static_cast<size_t>(DropReason::SampleRate)];
-            // ★ v8.3 DIAG: block.sampleRateHz と session.sampleRateHz の実値
-            #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-            juce::Logger::writeToLog(juce::String::formatted(
-                "[NoiseShaperLearner] dropBySampleRate: block.sr=%d session.sr=%d sessionId=%llu",
-                block.sampleRateHz, session.sampleRateHz,
-                (unsigned long long)session.sessionId));
-            #endif
-            continue;
-        }
+            const bool sampleRateCompatible = (session.sampleRateHz <= 0)
+                || (block.sampleRateHz <= 0)
+                || (block.sampleRateHz == session.sampleRateHz);
 
-        if (block.adaptiveCoeffBankIndex != session.adaptiveCoeffBankIndex)
-        {
-            ++stats.droppedByBank;
-            ++stats.dropReasonCounts[static_cast<size_t>(DropReason::Unknown)];
-            continue;
-        }
+            if (!sampleRateCompatible)
+            {
+                ++stats.droppedBySampleRate;
+                ++stats.dropReasonCounts[static_cast<size_t>(DropReason::SampleRate)];
+                // ★ v8.3 DIAG: block.sampleRateHz と session.sampleRateHz の実値
+                #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+                juce::Logger::writeToLog(juce::String::formatted(
+                    "[NoiseShaperLearner] dropBySampleRate: block.sr=%d session.sr=%d sessionId=%llu",
+                    block.sampleRateHz, session.sampleRateHz,
+                    (unsigned long long)session.sessionId));
+                #endif
+                continue;
+            }
 
-        segmentBuffer.pushBlock(block.L, block.R, block.numSamples);
-        const int playbackSampleRateHz = (session.sampleRateHz > 0)
-            ? session.sampleRateHz
-            : ((block.sampleRateHz > 0) ? block.sampleRateHz : 1);
-        accumulatedPlaybackSeconds += static_cast<double>(block.numSamples)
-            / static_cast<double>(playbackSampleRateHz);
-        ++stats.acceptedBlocks;
-    }
+            if (block.adaptiveCoeffBankIndex != session.adaptiveCoeffBankIndex)
+            {
+                ++stats.droppedByBank;
+                ++stats.dropReasonCounts[static_cast<size_t>(DropReason::Unknown)];
+                continue;
+            }
+
+            // 間引き / キュー満杯で書かれなかった区間はつなぎ目になるが、バーストは 1 世代分の窓より
+            // 長いので、最新窓がつなぎ目をまたぐのは次のバーストの書き始めの直後だけ
+            const int numSamples = std::min(block.numSamples, AudioBlock::kMaxSamples);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                blockLeft[i] = static_cast<double>(block.L[i]);
+                blockRight[i] = static_cast<double>(block.R[i]);
+            }
+            segmentBuffer.pushBlock(blockLeft, blockRight, numSamples);
+
+            const int playbackSampleRateHz = (session.sampleRateHz > 0)
+                ? session.sampleRateHz
+                : ((block.sampleRateHz > 0) ? block.sampleRateHz : 1);
+            accumulatedPlaybackSeconds += static_cast<double>(std::max(block.representedSamples, numSamples))
+                / static_cast<double>(playbackSampleRateHz);
+            ++stats.acceptedBlocks;
+        }
+    });
     convo::publishAtomic(progress.elapsedPlaybackSeconds, accumulatedPlaybackSeconds, std::memory_order_release);
     return stats;
 }
@@ -1273,75 +2266,102 @@ double NoiseShaperLearner::evaluateCandidateMapped(EvaluationContext& context,
                                                    int evaluationBitDepth) noexcept
 {
     juce::ScopedNoDenormals noDenormals;
+    juce::ignoreUnused(numSegments);
+
+    SegmentScoreTable scores {};
+    if (!scoreCandidateSegmentsMapped(context, mappedCoefficients, evaluationBitDepth, 0, kMaxSegmentsPerLevel, scores))
+        return kUnstablePenalty; // 不安定な場合は巨大なペナルティを返す
+
+    return combineSegmentScores(scores, kMaxSegmentsPerLevel);
+}
+
+bool NoiseShaperLearner::scoreCandidateSegmentsMapped(EvaluationContext& context,
+                                                      const double* mappedCoefficients,
+                                                      int evaluationBitDepth,
+                                                      int segmentBegin,
+                                                      int segmentEnd,
+                                                      SegmentScoreTable& scores) noexcept
+{
+    juce::ScopedNoDenormals noDenormals;
 
     // 【追加】安定性チェック（有効な場合）
     if (convo::consumeAtomic(settings.enableStabilityCheck, std::memory_order_acquire))
     {
         if (!LatticeNoiseShaper::isStable(mappedCoefficients, kOrder))
-            return 1e18; // 不安定な場合は巨大なペナルティを返す
+            return false;
     }
 
+    for (int i = 0; i < kNumLevels; ++i)
+    {
+        const int count = std::min(levelBucketCounts[i], segmentEnd);
+        for (int j = segmentBegin; j < count; ++j)
+        {
+            if (convo::consumeAtomic(stopRequested, std::memory_order_acquire))
+                break;
+
+            scores[static_cast<size_t>(i)][static_cast<size_t>(j)]
+                = scoreSegmentScalar(context, mappedCoefficients, evaluationBitDepth, SegmentRef { i, j });
+        }
+    }
+
+    return true;
+}
+
+double NoiseShaperLearner::scoreSegmentScalar(EvaluationContext& context,
+                                              const double* mappedCoefficients,
+                                              int evaluationBitDepth,
+                                              const SegmentRef& ref,
+                                              EvaluationFidelity fidelity) noexcept
+{
+    const auto& leveled = levelBuckets[ref.level][ref.segment];
+    const bool screening = fidelity == EvaluationFidelity::Screening;
+    const int length = screening ? MklFftEvaluator::kScreeningFftLength : AudioSegment::kLength;
+
     context.shaper.prepare(evaluationBitDepth);
     context.shaper.setCoefficients(mappedCoefficients, kOrder);
+    context.shaper.reset();
+    juce::FloatVectorOperations::copy(context.shapedLeft, leveled.segment.left, length);
+    juce::FloatVectorOperations::copy(context.shapedRight, leveled.segment.right, length);
+
+    context.shaper.processStereoBlock(context.shapedLeft,
+                                      context.shapedRight,
+                                      length,
+                                      kOutputHeadroom);
+
+    // Calculate error relative to headroom-scaled input
+    // ローカル__restrictポインタでエイリアスなしを明示（コンパイラの自動ベクトル化促進）
+    {   double* __restrict dstL = context.errorLeft;
+        double* __restrict dstR = context.errorRight;
+        const double* __restrict srcL = context.shapedLeft;
+        const double* __restrict srcR = context.shapedRight;
+        const double* __restrict refL = leveled.segment.left;
+        const double* __restrict refR = leveled.segment.right;
+        for (int k = 0; k < length; ++k)
+        {
+            dstL[k]  = srcL[k] - (refL[k] * kOutputHeadroom);
+            dstR[k]  = srcR[k] - (refR[k] * kOutputHeadroom);
+        }
+    }
+
+    const auto result = screening
+        ? context.fftEvaluator.evaluateScreening(context.errorLeft, context.errorRight, &leveled.segment.maskingThresholds)
+        : context.fftEvaluator.evaluate(context.errorLeft, context.errorRight, &leveled.segment.maskingThresholds);
+    return blendSegmentScore(kTargetLevelsDB[ref.level], result);
+}
 
+double NoiseShaperLearner::combineSegmentScores(const SegmentScoreTable& scores, int segmentEnd) const noexcept
+{
     double totalWeightedScore = 0.0;
     double totalWeight = 0.0;
 
     for (int i = 0; i < kNumLevels; ++i)
     {
-        const int count = levelBucketCounts[i];
+        const int count = std::min(levelBucketCounts[i], segmentEnd);
         if (count == 0) continue;
 
         double levelScoreSum = 0.0;
         for (int j = 0; j < count; ++j)
-        {
-            if (convo::consumeAtomic(stopRequested, std::memory_order_acquire))
-                break;
-
-            const auto& leveled = levelBuckets[i][j];
-
-            context.shaper.reset();
-            juce::FloatVectorOperations::copy(context.shapedLeft, leveled.segment.left, AudioSegment::kLength);
-            juce::FloatVectorOperations::copy(context.shapedRight, leveled.segment.right, AudioSegment::kLength);
-
-            context.shaper.processStereoBlock(context.shapedLeft,
-                                              context.shapedRight,
-                                              AudioSegment::kLength,
-                                              kOutputHeadroom);
-
-            // Calculate error relative to headroom-scaled input
-            // ローカル__restrictポインタでエイリアスなしを明示（コンパイラの自動ベクトル化促進）
-            {   double* __restrict dstL = context.errorLeft;
-                double* __restrict dstR = context.errorRight;
-                const double* __restrict srcL = context.shapedLeft;
-                const double* __restrict srcR = context.shapedRight;
-                const double* __restrict refL = leveled.segment.left;
-                const double* __restrict refR = leveled.segment.right;
-                for (int k = 0; k < AudioSegment::kLength; ++k)
-                {
-                    dstL[k]  = srcL[k] - (refL[k] * kOutputHeadroom);
-                    dstR[k]  = srcR[k] - (refR[k] * kOutputHeadroom);
-                }
-            }
-
-            const auto result = context.fftEvaluator.evaluate(context.errorLeft, context.errorRight, &leveled.segment.maskingThresholds);
-
-    // Hybrid score: blend time domain RMS and frequency domain composite score
-            // Low level (-40/-30dBFS) -> more time domain weight (smaller alpha for freqScore)
-            // High level (-20/-10dBFS) -> more freq domain weight (larger alpha for freqScore)
-            double alpha = 0.5;
-            if (kTargetLevelsDB[i] < -30.0) alpha = 0.3;
-            else if (kTargetLevelsDB[i] > -15.0) alpha = 0.7;
-
-            // Normalize scores to a similar scale for blending
-            // result.timeDomainRms is sigma.
-            // result.compositeScore is roughly N * sigma^2 * penalties.
-            // We use a heuristic scaling to bring them into a comparable range (~0.0 to 1.0 for typical noise).
-            const double timeScore = result.timeDomainRms * 1000.0;
-            const double freqScore = std::sqrt(result.compositeScore / MklFftEvaluator::kFftLength) * 1000.0;
-
-            levelScoreSum += (alpha * freqScore + (1.0 - alpha) * timeScore);
-        }
+            levelScoreSum += scores[static_cast<size_t>(i)][static_cast<size_t>(j)];
 
         const double levelAverageScore = levelScoreSum / count;
         const double weight = currentLevelWeights[static_cast<size_t>(i)];
@@ -1357,6 +2377,14 @@ double NoiseShaperLearner::evaluateCandidateMapped(EvaluationContext& context,
 
 void NoiseShaperLearner::precomputeMaskingThresholds(LeveledSegment& leveled, double sampleRate) noexcept
 {
+    // 同じ音声 (ゲイン適用後) なら閾値も同じ。停止中の再構築や再開・モード切替で FFT と閾値計算を省く
+    const std::uint64_t contentHash = convo::hashSegmentContent(leveled.segment.left, leveled.segment.right, AudioSegment::kLength);
+    if (const auto* cached = maskingThresholdCache.find(contentHash, sampleRate))
+    {
+        leveled.segment.maskingThresholds = *cached;
+        return;
+    }
+
     auto& evaluator = evaluationWorkers[0].context.fftEvaluator;
 
     MklFftEvaluator::CcsComplex spectrumL[MklFftEvaluator::kSpectrumBins];  // ← 変更後
@@ -1376,6 +2404,8 @@ void NoiseShaperLearner::precomputeMaskingThresholds(LeveledSegment& leveled, do
 
         leveled.segment.maskingThresholds[k] = evaluator.computeMaskingThreshold(avgMagSq, freq);
     }
+
+    maskingThresholdCache.store(contentHash, sampleRate, leveled.segment.maskingThresholds);
 }
 
 bool NoiseShaperLearner::saveLearnedState(const juce::File& file) const
@@ -1507,12 +2537,143 @@ void NoiseShaperLearner::publishGenerationResult(const double* coeffs, double sc
             //                                  AudioEngine::RebuildTelemetryPolicy::Replaceable);
             self->engine.storeLearnedCoeffs(mappedCoeffs.data());
             self->engine.setAdaptiveNoiseShaperState(bankIndex, currentState);
-            self->engine.requestAdaptiveAutosave();
+            appendJournalRecord(bankIndex, currentState, mappedCoeffs);
         }
     });
 
 }
 
+void NoiseShaperLearner::setupAuxTargets() noexcept
+{
+    activeTargetCount = 1;
+    for (auto& gate : screeningGates)
+        gate.reset();
+    if (!convo::consumeAtomic(settings.learnAllBitDepths, std::memory_order_acquire))
+        return;
+
+    // 主バンクは publishGenerationResult と同じ (現在のディザビット深度) で決まる。
+    // 同じレート・モードの残りのビット深度を副 target にし、同じセグメント集合で評価する
+    const int primaryBankIndex = AudioEngine::getAdaptiveCoeffBankIndex(sessionSampleRate, engine.getDitherBitDepth(), activeMode);
+    for (int depthIndex = 0; depthIndex < kAdaptiveBitDepthCount && activeTargetCount < kMaxLearningTargets; ++depthIndex)
+    {
+        const int bitDepth = kAdaptiveBitDepthValues[depthIndex];
+        const int bankIndex = AudioEngine::getAdaptiveCoeffBankIndex(sessionSampleRate, bitDepth, activeMode);
+        if (bankIndex == primaryBankIndex)
+            continue;
+
+        auto& aux = auxTargets[static_cast<size_t>(activeTargetCount - 1)];
+        aux.bitDepth = bitDepth;
+        aux.bankIndex = bankIndex;
+
+        State stored;
+        if (engine.getAdaptiveNoiseShaperState(bankIndex, stored) && stored.iteration > 0)
+        {
+            aux.optimizer.deserializeFrom(stored.mean, stored.covarianceUpperTriangle, stored.sigma);
+            std::copy(std::begin(stored.bestCoefficients), std::end(stored.bestCoefficients), aux.bestCoefficients.begin());
+            aux.storedBestScore = stored.bestScore;
+            aux.playbackOffsetSeconds = stored.elapsedPlaybackSeconds - accumulatedPlaybackSeconds;
+            aux.iteration = stored.iteration;
+            aux.processCount = stored.processCount;
+            aux.totalGenerations = stored.totalGenerations;
+        }
+        else
+        {
+            engine.getAdaptiveCoefficientsForBank(bankIndex, aux.bestCoefficients.data(), kOrder);
+            aux.optimizer.initFromParcor(aux.bestCoefficients.data());
+            aux.storedBestScore = 0.0;
+            aux.playbackOffsetSeconds = -accumulatedPlaybackSeconds;  // このバンクの再生時間は今から数える
+            aux.iteration = 0;
+            aux.processCount = 0;
+            aux.totalGenerations = 0;
+        }
+
+        aux.optimizer.setSeed(makeDeterministicRestartSeed(static_cast<int>(sessionSampleRate + 0.5),
+                                                           bitDepth, bankIndex, currentSessionId, 0));
+        aux.optimizer.setParams(phaseOptimizerParams);
+        aux.bestScore = std::numeric_limits<double>::max();
+        aux.evaluatedCandidates = 0;
+        ++activeTargetCount;
+    }
+
+    juce::Logger::writeToLog("[NoiseShaperLearner] learning targets=" + juce::String(activeTargetCount)
+                             + " primaryBank=" + juce::String(primaryBankIndex));
+}
+
+void NoiseShaperLearner::storeAuxTargetStates() noexcept
+{
+    for (int t = 1; t < activeTargetCount; ++t)
+    {
+        const auto& aux = auxTargets[static_cast<size_t>(t - 1)];
+        State state;
+        getAuxTargetState(aux, state);
+        engine.setAdaptiveNoiseShaperState(aux.bankIndex, state);
+    }
+}
+
+void NoiseShaperLearner::updateAuxTargets(bool publish) noexcept
+{
+    for (int t = 1; t < activeTargetCount; ++t)
+    {
+        auto& aux = auxTargets[static_cast<size_t>(t - 1)];
+        if (aux.evaluatedCandidates < CmaEsOptimizer::kElite)
+            continue;
+
+        auto* population = candidatePopulationMatrix() + t * CmaEsOptimizer::kPopulation;
+        double* fitness = candidateFitnessData() + t * CmaEsOptimizer::kPopulation;
+        for (int fi = aux.evaluatedCandidates; fi < CmaEsOptimizer::kPopulation; ++fi)
+            fitness[fi] = std::numeric_limits<double>::max();
+
+        aux.optimizer.update(population, fitness);
+        aux.processCount += aux.evaluatedCandidates;
+        ++aux.iteration;
+        ++aux.totalGenerations;
+
+        if (aux.bestCandidateScore < aux.bestScore && aux.bestCandidateScore < std::numeric_limits<double>::max())
+        {
+            aux.bestScore = aux.bestCandidateScore;
+            double parcor[CmaEsOptimizer::kDim] = {};
+            CmaEsOptimizer::toParcor(population[aux.bestCandidateIndex], parcor);
+            for (int i = 0; i < kOrder; ++i)
+                aux.bestCoefficients[static_cast<size_t>(i)] = std::tanh(parcor[i]);
+            if (publish)
+                publishAuxTargetResult(aux);
+        }
+    }
+}
+
+void NoiseShaperLearner::getAuxTargetState(const AuxLearningTarget& target, State& outState) const noexcept
+{
+    target.optimizer.serializeTo(outState.mean, outState.covarianceUpperTriangle, outState.sigma);
+    std::copy(target.bestCoefficients.begin(), target.bestCoefficients.end(), std::begin(outState.bestCoefficients));
+    outState.elapsedPlaybackSeconds = std::max(0.0, accumulatedPlaybackSeconds + target.playbackOffsetSeconds);
+    outState.currentPhase = currentPhase;
+    outState.iteration = target.iteration;
+    outState.bestScore = (target.bestScore < std::numeric_limits<double>::max()) ? target.bestScore : target.storedBestScore;
+    outState.processCount = target.processCount;
+    outState.totalGenerations = target.totalGenerations;
+}
+
+void NoiseShaperLearner::publishAuxTargetResult(const AuxLearningTarget& target) noexcept
+{
+    State state;
+    getAuxTargetState(target, state);
+    const int bankIndex = target.bankIndex;
+    const auto coefficients = target.bestCoefficients;
+
+    // 副バンクは Audio Thread が使っていないバンクなので、live 学習中でもバンクへ直接書いてよい
+    // (storeAdaptiveCoeffBank は学習中の書き込みを拒否する)
+    juce::WeakReference<NoiseShaperLearner> weakSelf(this);
+    juce::MessageManager::callAsync([weakSelf, bankIndex, coefficients, state]()
+    {
+        if (auto* self = weakSelf.get())
+        {
+            self->engine.storeLearnedCoeffsToBank(bankIndex, coefficients.data());
+            self->engine.setAdaptiveNoiseShaperState(bankIndex, state);
+            appendJournalRecord(bankIndex, state, coefficients);
+        }
+    });
+}
+
 void NoiseShaperLearner::appendHistoryPoint(double score) noexcept
 {
     const std::scoped_lock<std::mutex> lock(historyMutex);
@@ -6,23 +6,30 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <mutex>
+#include <stop_token>
 #include <thread>
 
 #include "AlignedAllocation.h"
 #include "AudioSegmentBuffer.h"
 #include "CmaEsOptimizer.h"
 #include "LatticeNoiseShaper.h"
+#include "MaskingThresholdCache.h"
+#include "dsp/LatticeNoiseShaperBatch.h"
 #include "MklFftEvaluator.h"
 #include "NoiseShaperLearnerTypes.h"
+#include "ScreeningFidelityGate.h"
 
+#include "audioengine/AdaptiveCaptureBlock.h"
 #include "audioengine/AtomicAccess.h"
+#include "audioengine/MemoryLedger.h"
 #include "core/RCUReader.h"
+#include "core/SeqlockSnapshot.h"
+#include "core/WorkStealingRanges.h"
 
 class AudioEngine;
-struct AudioBlock;
-template <typename T, size_t Capacity>
-class LockFreeRingBuffer;
 
 struct AudioSegment
 {
@@ -46,6 +53,10 @@ struct LeveledSegment
     SpectralType type = SpectralType::Broadband;
 };
 
+#ifdef _MSC_VER
+#pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#endif
 class NoiseShaperLearner
 {
 public:
@@ -82,12 +93,21 @@ public:
         s.cmaesRestarts = convo::consumeAtomic(settings.cmaesRestarts, std::memory_order_acquire);
         s.coeffSafetyMargin = convo::consumeAtomic(settings.coeffSafetyMargin, std::memory_order_acquire);
         s.enableStabilityCheck = convo::consumeAtomic(settings.enableStabilityCheck, std::memory_order_acquire);
+        s.enableRacing = convo::consumeAtomic(settings.enableRacing, std::memory_order_acquire);
+        s.enableScreening = convo::consumeAtomic(settings.enableScreening, std::memory_order_acquire);
+        s.enableCaptureDecimation = convo::consumeAtomic(settings.enableCaptureDecimation, std::memory_order_acquire);
+        s.learnAllBitDepths = convo::consumeAtomic(settings.learnAllBitDepths, std::memory_order_acquire);
         return s;
     }
 
     static constexpr int kMaxHistoryPoints = 256;
     static constexpr int kMaxParallelEvaluators = 6;
 
+    // 1 つのセグメント集合で同時に回す CMA-ES の上限 (主バンク + 同じレート・モードの他ビット深度)。
+    // 候補バッファは target t の候補を [t * kPopulation, (t + 1) * kPopulation) に置く
+    static constexpr int kMaxLearningTargets = 3;
+    static constexpr int kCandidateSlots = kMaxLearningTargets * CmaEsOptimizer::kPopulation;
+
     // Multi-level normalization constants
     static constexpr int kNumLevels = 4;
     static constexpr double kTargetLevelsDB[kNumLevels] = { -40.0, -30.0, -20.0, -10.0 };
@@ -96,18 +116,33 @@ public:
     static constexpr int kMaxSegmentsPerLevel = 4;
     static constexpr int kMaxTrainingSegments = kNumLevels * kMaxSegmentsPerLevel;
 
+    // Racing: 各レベル先頭 kRaceSegmentsPerLevel 個で全候補を予選し、
+    // kElite 位の候補より統計的に劣る (対差の平均 > kRaceConfidenceZ × 標準誤差) 候補を打ち切る
+    static constexpr int kRaceSegmentsPerLevel = 2;
+    static constexpr double kRaceConfidenceZ = 2.5;
+
+    // 予備選別: 全候補を各レベル先頭 kScreeningSegmentsPerLevel 個のセグメント・安い忠実度
+    // (MklFftEvaluator::evaluateScreeningBatch) で採点し、上位だけを本評価 (予選・本選) へ進める。
+    // 通過枠と照合世代は target ごとの ScreeningFidelityGate が決める
+    static constexpr int kScreeningSegmentsPerLevel = 1;
+
     std::array<double, kNumLevels> currentLevelWeights = { 0.4, 0.3, 0.2, 0.1 };
 
     NoiseShaperLearner(AudioEngine& engineRef,
-                       LockFreeRingBuffer<AudioBlock, 4096>& captureQueueRef);
+                       AdaptiveCaptureQueue& captureQueueRef);
     ~NoiseShaperLearner();
 
     void startLearning(bool resume = false);
     void stopLearning();
+    // 終了時用: ワーカーへ停止を求めるだけで join しない (join はデストラクタ / stopLearning が行う)。
+    // workerState は変えない
+    void requestStop() noexcept;
     bool isRunning() const noexcept;
     void setLearningMode(LearningMode mode) noexcept;
 
     const Progress& getProgress() const noexcept;
+    // UI 用。進捗の全項目を 1 回の seqlock 読み取りで返す
+    [[nodiscard]] convo::NoiseShaperLearnerProgressView getProgressView() const noexcept;
     void getState(State& outState) const noexcept;
     void setState(const State& inState) noexcept;
     int copyBestScoreHistory(double* destination, int maxPoints) noexcept;
@@ -148,7 +183,98 @@ public:
         convo::publishAtomic(errorMessage, msg, std::memory_order_release);
     }
 
+    // ============================================================================
+    // オフライン学習 (--cli-learn-offline): キャプチャキューを通さず音声を直接流し込む
+    // ============================================================================
+    // sampleRateHz の音声を left/right に最大 maxSamples 書き、書いた数を返す (0 = 終端)
+    using OfflineAudioReader = std::function<int(double* left, double* right, int maxSamples)>;
+
+    // Continuous は終了条件がないため、オフラインでは Ultra と同じ再生時間で打ち切る
+    static constexpr double kOfflineContinuousPlaybackSeconds = 300.0;
+
+    // 1 世代ごとの経過 (ベンチマークの time-to-score 曲線用)。呼び出しスレッドで呼ばれる
+    struct OfflineGenerationReport
+    {
+        int generation = 0;
+        double playbackSeconds = 0.0;
+        double bestScore = 0.0;
+        double latestScore = 0.0;
+        int evaluatedCandidates = 0;
+        std::uint64_t segmentEvaluations = 0;    // セッション開始からの (候補, セグメント) 本評価数の累計
+        std::uint64_t screeningEvaluations = 0;  // 同じく予備選別の評価数の累計
+    };
+    using OfflineGenerationCallback = std::function<void(const OfflineGenerationReport&)>;
+
+    // 評価ワーカー 1 本分の稼働統計 (runEvaluationJobsForWorker 内の時間と処理量)
+    struct EvaluationWorkerStats
+    {
+        double busySeconds = 0.0;
+        std::uint64_t tasks = 0;
+        std::uint64_t segmentEvaluations = 0;
+        std::uint64_t screeningEvaluations = 0;
+    };
+
+    // 主バンクと同じ音声・モードで並行に学習する副バンク
+    struct OfflineTarget
+    {
+        int bitDepth = 24;
+        int bankIndex = 0;
+        std::array<double, kOrder> initialCoefficients {};
+        std::uint64_t seed = 0;                             // 0 = bankIndex などから決める
+    };
+
+    struct OfflineTargetResult
+    {
+        std::array<double, kOrder> coefficients {};
+        State state;
+        double bestScore = 0.0;
+        int generations = 0;
+    };
+
+    struct OfflineSession
+    {
+        double sampleRateHz = 48000.0;
+        int bitDepth = 24;
+        LearningMode mode = LearningMode::Short;
+        int bankIndex = 0;                                  // 乱数シードの決定に使う
+        std::array<double, kOrder> initialCoefficients {};  // 反射係数 (バンクの現在値)
+        OfflineAudioReader readAudio;
+        std::uint64_t seed = 0;                             // 0 = bankIndex などから決める
+        int evaluationWorkerCount = 0;                      // 0 = 既定 (論理コア数 - 1, 最大 kMaxParallelEvaluators)
+        OfflineGenerationCallback onGeneration;
+        // 同じセグメント集合で同時に学習する副バンク。評価タスクは主バンクと同じディスパッチに混ぜる
+        std::array<OfflineTarget, kMaxLearningTargets - 1> extraTargets {};
+        int extraTargetCount = 0;
+    };
+
+    struct OfflineResult
+    {
+        std::array<double, kOrder> coefficients {};  // バンクへ書く反射係数
+        State state;
+        double bestScore = 0.0;
+        double playbackSeconds = 0.0;
+        int generations = 0;
+        bool completed = false;                       // モードの目標再生時間に到達した
+        int evaluationWorkerCount = 0;
+        std::array<EvaluationWorkerStats, kMaxParallelEvaluators> workerStats {};
+        std::array<OfflineTargetResult, kMaxLearningTargets - 1> extraResults {};  // extraTargets と同じ並び
+    };
+
+    // 呼び出しスレッドで 1 セッション (1 バンク + 副バンク) を回す。live 学習と同じ世代処理だが、
+    // 1 世代ごとに generationIntervalSeconds 分の音声を即座に読み込み、待機しない。
+    // live 学習中 (startLearning 済み) のインスタンスでは false を返す
+    bool runOfflineSession(const OfflineSession& session, OfflineResult& result, std::stop_token stopToken);
+
+    // モードの終了条件となる累積再生時間 (Continuous は無限大)
+    static double getTargetPlaybackSeconds(LearningMode mode) noexcept;
+
 private:
+    enum class EvaluationFidelity : uint8_t
+    {
+        Full = 0,     // MklFftEvaluator::evaluateBatch (セグメント全長)
+        Screening     // MklFftEvaluator::evaluateScreeningBatch (先頭 kScreeningFftLength 点)
+    };
+
     enum class WorkerState : uint8_t
     {
         Idle = 0,
@@ -189,16 +315,55 @@ private:
     {
         MklFftEvaluator fftEvaluator;
         LatticeNoiseShaper shaper;
+        convo::dsp::LatticeNoiseShaperBatch batchShaper;  // 候補を SIMD レーンに並べた一括評価用
+        int loadedGroup = -1;                              // batchShaper に係数を載せている候補グループ
         double shapedLeft[AudioSegment::kLength] = {};
         double shapedRight[AudioSegment::kLength] = {};
         double errorLeft[AudioSegment::kLength] = {};
         double errorRight[AudioSegment::kLength] = {};
     };
 
+    // 候補 1 つ分のセグメント別スコア [level][segment] (blendSegmentScore の値)
+    using SegmentScoreTable = std::array<std::array<double, kMaxSegmentsPerLevel>, kNumLevels>;
+
+    struct SegmentRef
+    {
+        int level = 0;
+        int segment = 0;
+    };
+
+    // 評価の 1 グループ = 同じ target の連続ジョブ (≤ evaluationGroupLanes 個)。量子化ビット深度がグループ内で揃う
+    struct EvaluationGroup
+    {
+        int firstJob = 0;
+        int count = 0;
+        int target = 0;
+    };
+
+    // 主バンク (target 0 = optimizer / progress / bestCoefficients) と並行に学習する副バンク (target 1..)
+    struct AuxLearningTarget
+    {
+        CmaEsOptimizer optimizer;
+        int bitDepth = 0;
+        int bankIndex = -1;
+        std::array<double, kOrder> bestCoefficients {};
+        double bestScore = std::numeric_limits<double>::max();  // このセッションで公開した最良スコア
+        double storedBestScore = 0.0;        // 再開元の State::bestScore (このセッションで改善するまで保存値に使う)
+        double playbackOffsetSeconds = 0.0;  // バンクの累積再生時間 − 主バンクの累積再生時間 (再開時)
+        int iteration = 0;
+        int processCount = 0;
+        std::uint64_t totalGenerations = 0;
+        // 直近世代の評価結果 (evaluatePopulation が書く)
+        int evaluatedCandidates = 0;
+        int bestCandidateIndex = 0;
+        double bestCandidateScore = std::numeric_limits<double>::max();
+    };
+
     struct EvaluationWorkerSlot
     {
         EvaluationContext context;
         std::jthread thread;
+        EvaluationWorkerStats stats;  // このスロットのワーカーだけが書く (読むのはワーカー停止後)
     };
 
     void workerThreadMain(std::stop_token stopToken);
@@ -211,15 +376,37 @@ private:
     void evaluationWorkerMain(int workerIndex, std::stop_token stopToken) noexcept;
     void runEvaluationJobsForWorker(int workerIndex,
                                     int numSegments,
-                                    int evaluationBitDepth,
                                     const std::stop_token* stopToken = nullptr) noexcept;
+    // evaluationJobIndices[0, jobCount) の候補 (target 順に並んでいること) を各レベルのセグメント
+    // [segmentBegin, segmentEnd) で評価する。(候補グループ, セグメント) 単位のタスクを work-stealing で
+    // 全ワーカーに分配する。量子化ビット深度は候補の target の targetBitDepths を使う。
+    // 戻り値は評価を終えた候補数 (停止要求時は jobCount 未満、未完了候補の fitness は max)。
+    // target ごとの内訳は completedEvaluationCandidates に残る。
+    // Screening のパスはスコアを candidateScreeningScores / candidateScreeningFitness に書き、fitness は触らない
+    int dispatchEvaluationJobs(int jobCount,
+                               int numSegments,
+                               int segmentBegin,
+                               int segmentEnd,
+                               const std::stop_token& stopToken,
+                               EvaluationFidelity fidelity = EvaluationFidelity::Full);
+    // target [0, targetCount) の候補をまとめて評価する。target 0 (主バンク) を evaluationBitDepth で評価し、
+    // その結果を戻り値 / 参照引数に、副バンクの結果は auxTargets[t - 1] の直近世代欄に書く
     int evaluatePopulation(int numSegments,
                            int evaluationBitDepth,
                            int& bestCandidateIndex,
                            double& bestCandidateScore,
-                           const std::stop_token& stopToken);
+                           const std::stop_token& stopToken,
+                           int targetCount = 1);
+    // 1 target の候補 candidates[0, candidateCount) の予選スコアから本選へ進む候補を
+    // evaluationJobIndices[firstSlot..] に並べ、その数を返す。
+    // 打ち切った候補の fitness は最下位の本選候補より後ろに並ぶよう後で確定する
+    int selectRaceSurvivors(const int* candidates, int candidateCount, bool* survived, int firstSlot) noexcept;
+    // 予備選別の結果から本評価へ進める target の候補を evaluationJobIndices[firstSlot..] に並べ、その数を返す
+    int selectScreeningPromotions(int target, bool promoteAll, int firstSlot) noexcept;
     SessionSignature captureSessionSignature() noexcept;
     void resetLearningSession(const SessionSignature& session, bool resume) noexcept;
+    // 未学習バンクの初期分布を最も近い学習済みバンク (NoiseShaperWarmStart.h) から取る。使えなければ false
+    bool tryWarmStartFromNeighbourBank(int bankIndex) noexcept;
     DrainStats drainCaptureQueue(const SessionSignature& session) noexcept;
     int buildTrainingSegments() noexcept;
     double evaluateCandidate(EvaluationContext& context,
@@ -230,16 +417,55 @@ private:
                                    const double* mappedCoefficients,
                                    int numSegments,
                                    int evaluationBitDepth) noexcept;
+    // 各レベルのセグメント [segmentBegin, segmentEnd) を評価して scores に書く。不安定候補は false
+    bool scoreCandidateSegmentsMapped(EvaluationContext& context,
+                                      const double* mappedCoefficients,
+                                      int evaluationBitDepth,
+                                      int segmentBegin,
+                                      int segmentEnd,
+                                      SegmentScoreTable& scores) noexcept;
+    // 1 候補 × 1 セグメントをスカラー格子 (LatticeNoiseShaper) で評価する
+    double scoreSegmentScalar(EvaluationContext& context,
+                              const double* mappedCoefficients,
+                              int evaluationBitDepth,
+                              const SegmentRef& ref,
+                              EvaluationFidelity fidelity = EvaluationFidelity::Full) noexcept;
+    // 1 タスク = 候補グループ (≤ evaluationGroupLanes 候補) × 1 セグメント。
+    // batchReady なら batchShaper のレーンで一括、そうでなければ 1 候補ずつ評価する。
+    // 戻り値は評価した (候補, セグメント) の数 (不安定候補は数えない)
+    int runEvaluationTask(EvaluationContext& context,
+                           int group,
+                           const SegmentRef& ref,
+                           int evaluationBitDepth,
+                           bool batchReady,
+                           EvaluationFidelity fidelity) noexcept;
+    // グループの最後のタスクを終えたワーカーが呼び、候補の fitness を確定する
+    void finishEvaluationGroup(int group) noexcept;
+    // 各レベルのセグメント [0, segmentEnd) の平均を currentLevelWeights で加重平均する
+    double combineSegmentScores(const SegmentScoreTable& scores, int segmentEnd) const noexcept;
     void precomputeMaskingThresholds(LeveledSegment& seg, double sampleRate) noexcept;
     void publishGenerationResult(const double* coeffs, double score, int evaluatedCandidates) noexcept;
+
+    // live: 設定が有効なら主バンクと同じレート・モードの他ビット深度バンクを副 target に積む (無効なら 0 個)
+    void setupAuxTargets() noexcept;
+    // 副 target の最適化状態をバンクの State へ書き戻す (モード / セッション切り替え前)
+    void storeAuxTargetStates() noexcept;
+    // evaluatePopulation の後に副 target の CMA-ES を更新する。publish なら改善した target を Message Thread へ公開する
+    void updateAuxTargets(bool publish) noexcept;
+    void getAuxTargetState(const AuxLearningTarget& target, State& outState) const noexcept;
+    void publishAuxTargetResult(const AuxLearningTarget& target) noexcept;
     void appendHistoryPoint(double score) noexcept;
+    // progress の現在値を progressView へ写す。progress を書いた区切り (世代の終わり・状態遷移) で呼ぶ
+    void publishProgressView() noexcept;
 
     int computePhase(LearningMode mode, double playbackSeconds) const noexcept;
     void applyPhaseParams(LearningMode mode, int phase) noexcept;
     void handleModeSwitch() noexcept;
+    // live 学習のフェーズ / 世代間隔 / レートからキャプチャ間引き率を決め、変化したら AudioEngine へ公開する
+    void publishCaptureStride() noexcept;
 
     AudioEngine& engine;
-    LockFreeRingBuffer<AudioBlock, 4096>& captureQueue;
+    AdaptiveCaptureQueue& captureQueue;
     convo::RCUReader rcuReader;
 
     std::jthread workerThread;
@@ -248,6 +474,10 @@ private:
     std::atomic<bool> pendingResume { false };
 
     Progress progress;
+    // progress を写した UI 用スナップショット。ライタは Message Thread / Worker / オフライン呼び出し元と
+    // 複数あるため publishProgressView() が progressViewWriteMutex で直列化する (取りこぼさない)
+    convo::SeqlockSnapshot<convo::NoiseShaperLearnerProgressView> progressView;
+    std::mutex progressViewWriteMutex;
     Settings settings;
     std::atomic<const char*> errorMessage { nullptr };
 
@@ -263,11 +493,16 @@ private:
     LearningMode pendingMode {LearningMode::Short};
     LearningMode activeMode {LearningMode::Short};
     int currentPhase = 1;
+    int publishedCaptureStride = 1;
 
     std::array<State, 6> savedStates {};
 
     AudioSegmentBuffer segmentBuffer;
     CmaEsOptimizer optimizer;
+    CmaEsOptimizer::Params phaseOptimizerParams;   // applyPhaseParams が最後に設定した値 (副 target にも適用する)
+    std::array<AuxLearningTarget, kMaxLearningTargets - 1> auxTargets {};
+    int activeTargetCount = 1;                      // 学習スレッドのみ。1 = 主バンクだけ
+    std::array<int, kMaxLearningTargets> targetBitDepths {};  // ディスパッチ前に学習スレッドが書き、ワーカーが読む
     std::array<EvaluationWorkerSlot, kMaxParallelEvaluators> evaluationWorkers {};
     int activeEvaluationWorkerCount = 1;
     int activeAuxEvaluationWorkerCount = 0;
@@ -276,19 +511,43 @@ private:
     std::mutex intervalMutex_;
     std::condition_variable intervalCv_;
     int pendingEvaluationSegmentCount = 0;
-    int pendingEvaluationBitDepth = 24;
+    int pendingEvaluationSegmentBegin = 0;
+    int pendingEvaluationSegmentEnd = kMaxSegmentsPerLevel;
+    EvaluationFidelity pendingEvaluationFidelity = EvaluationFidelity::Full;
+    int pendingEvaluationWorkerCount = 1;   // 今回のディスパッチに参加するワーカー数 (主スレッドを含む)
+    int evaluationWorkerLimit = 0;          // 学習スレッドのみ。0 = 制限なし (AudioEngine::getLearnerThrottle)
     std::atomic<int> completedAuxEvaluationWorkers{0};
     std::atomic<uint32_t> evaluationDispatchSerial{0};
     bool evaluationWorkersShouldExit = false;
-    std::atomic<int> nextEvaluationCandidateIndex { 0 };
+    // ★ work-stealing 分配: タスク t = (グループ t / passSegmentCount, passSegments[t % passSegmentCount])
+    convo::WorkStealingRanges<kMaxParallelEvaluators> evaluationTasks;
+    std::array<EvaluationGroup, kCandidateSlots> evaluationGroups {};
+    std::array<std::atomic<int>, kCandidateSlots> groupRemainingTasks {};
+    std::array<std::atomic<int>, kMaxLearningTargets> completedEvaluationCandidates {};
+    std::array<SegmentRef, kMaxTrainingSegments> passSegments {};
+    int passSegmentCount = 0;
+    int evaluationGroupLanes = 1;
     convo::ScopedAlignedPtr<double> candidatePopulation;
     convo::ScopedAlignedPtr<double> candidateFitness;
+    // Racing: 評価対象の候補インデックス (予選は全候補、本選は生存候補) とセグメント別スコア
+    std::array<int, kCandidateSlots> evaluationJobIndices {};
+    std::array<SegmentScoreTable, kCandidateSlots> candidateSegmentScores {};
+    std::array<bool, kCandidateSlots> candidateStable {};
+    // 予備選別: 候補ごとのセグメント別スコア・合成スコアと、今世代に予備選別した target
+    // (その target の本評価は processCount に数えない)。ゲートは学習スレッドのみが触る
+    std::array<SegmentScoreTable, kCandidateSlots> candidateScreeningScores {};
+    std::array<double, kCandidateSlots> candidateScreeningFitness {};
+    std::array<bool, kMaxLearningTargets> targetScreened {};
+    std::array<convo::ScreeningFidelityGate<CmaEsOptimizer::kPopulation>, kMaxLearningTargets> screeningGates {};
 
     // ★ B03: Generation 単位で共有する vdTanh 結果 (64バイトアライメント)
     convo::ScopedAlignedPtr<double> sharedMappedPopulation;
+    convo::MemoryCharge memoryCharge { convo::MemoryCategory::Learner };   // 本体 + 候補バッファ
 
     std::array<LeveledSegment, kMaxSegmentsPerLevel> levelBuckets[kNumLevels] = {};
     int levelBucketCounts[kNumLevels] = {};
+    // セグメント内容ハッシュ → マスキング閾値 (セグメント集合の再構築・セッション再開をまたいで保持)
+    convo::MaskingThresholdCache<MklFftEvaluator::kSpectrumBins, 2 * kMaxTrainingSegments> maskingThresholdCache;
 
     std::array<std::atomic<double>, kOrder> bestCoefficients {};
     std::array<double, kMaxHistoryPoints> bestScoreHistory {};
@@ -303,3 +562,6 @@ private:
     JUCE_DECLARE_WEAK_REFERENCEABLE(NoiseShaperLearner)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NoiseShaperLearner)
 };
+#ifdef _MSC_VER
+#pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#endif
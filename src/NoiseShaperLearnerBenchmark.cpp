@@ -0,0 +1,356 @@
+#include "NoiseShaperLearnerBenchmark.h"
+
+#include "AudioEngine.h"
+#include "core/ThreadAffinityManager.h"
+#include "dsp/KernelDispatch.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace
+{
+    // AudioEngine の既定係数と同じ値 (AudioEngine.Learning.cpp / AudioEngine.Processing.DSPCoreLifecycle.cpp と同期)。
+    // 学習済みバンクから始めると計測がマシンの学習履歴に依存するため、常にここから始める
+    constexpr std::array<double, NoiseShaperLearner::kOrder> kBenchmarkInitialCoefficients
+    {
+        -0.003796, -0.006752, 0.008418, -0.010546, 0.004716, -0.007624, -0.020750, -0.002049, -0.003632
+    };
+
+    // 総改善量 (初回世代のスコア → 最終スコア) に対する到達率
+    constexpr std::array<double, 3> kImprovementFractions { 0.5, 0.9, 0.99 };
+
+    // std::uniform_real_distribution は標準ライブラリ実装ごとに系列が変わるため、mt19937 の出力を直接写像する
+    double uniformSigned(std::mt19937& rng) noexcept
+    {
+        return ((static_cast<double>(rng()) + 0.5) / 4294967296.0) * 2.0 - 1.0;
+    }
+
+    juce::String modeName(convo::NoiseShaperLearningMode mode)
+    {
+        switch (mode)
+        {
+            case convo::NoiseShaperLearningMode::Shortest:   return "shortest";
+            case convo::NoiseShaperLearningMode::Short:      return "short";
+            case convo::NoiseShaperLearningMode::Middle:     return "middle";
+            case convo::NoiseShaperLearningMode::Long:       return "long";
+            case convo::NoiseShaperLearningMode::Ultra:      return "ultra";
+            case convo::NoiseShaperLearningMode::Continuous: return "continuous";
+        }
+        return "unknown";
+    }
+}
+
+NoiseShaperLearnerBenchmark::NoiseShaperLearnerBenchmark(AudioEngine& engineRef,
+                                                         Options benchmarkOptions,
+                                                         FinishedCallback finishedCallback)
+    : juce::Thread("NoiseShaperLearnerBenchmark"),
+      engine(engineRef),
+      options(std::move(benchmarkOptions)),
+      onFinished(std::move(finishedCallback)),
+      unusedCaptureQueue(std::make_unique<AdaptiveCaptureQueue>())
+{
+    options.repeats = std::max(1, options.repeats);
+    options.evaluationWorkerCount = std::clamp(options.evaluationWorkerCount, 1, NoiseShaperLearner::kMaxParallelEvaluators);
+}
+
+NoiseShaperLearnerBenchmark::~NoiseShaperLearnerBenchmark()
+{
+    cancel();
+    stopThread(10000);
+}
+
+void NoiseShaperLearnerBenchmark::cancel()
+{
+    stopSource.request_stop();
+    signalThreadShouldExit();
+}
+
+std::vector<NoiseShaperOfflineTrainer::CorpusClip> NoiseShaperLearnerBenchmark::makeSyntheticCorpus(double sampleRateHz,
+                                                                                                   double seconds)
+{
+    NoiseShaperOfflineTrainer::CorpusClip clip;
+    clip.sampleRateHz = sampleRateHz;
+    const int numSamples = std::max(1, static_cast<int>(seconds * sampleRateHz));
+    clip.audio.setSize(2, numSamples);
+
+    std::mt19937 rng(0x434f5250u);
+    float* left = clip.audio.getWritePointer(0);
+    float* right = clip.audio.getWritePointer(1);
+
+    // 1/f 寄りのノイズ (Paul Kellet の簡易ピンクノイズフィルタ)、チャンネル独立
+    std::array<std::array<double, 3>, 2> pinkState {};
+    const auto pink = [&rng](std::array<double, 3>& state)
+    {
+        const double white = uniformSigned(rng);
+        state[0] = 0.99765 * state[0] + white * 0.0990460;
+        state[1] = 0.96300 * state[1] + white * 0.2965164;
+        state[2] = 0.57000 * state[2] + white * 1.0526913;
+        return 0.2 * (state[0] + state[1] + state[2] + white * 0.1848);
+    };
+
+    const int sectionLength = std::max(1, static_cast<int>(4.0 * sampleRateHz));
+    const int burstPeriod = std::max(1, static_cast<int>(0.25 * sampleRateHz));
+    const double burstDecay = std::exp(-1.0 / (0.03 * sampleRateHz));
+    const double twoPi = juce::MathConstants<double>::twoPi;
+    double burstEnvelope = 0.0;
+    double chordRoot = 220.0;
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const int section = n / sectionLength;
+        const int positionInSection = n % sectionLength;
+        const double t = static_cast<double>(n) / sampleRateHz;
+        double l = 0.0;
+        double r = 0.0;
+
+        switch (section % 3)
+        {
+            case 0:
+            {
+                // 広帯域: ゆっくり揺れる包絡のピンクノイズ
+                const double envelope = 0.15 + 0.1 * std::sin(twoPi * 0.3 * t);
+                l = envelope * pink(pinkState[0]);
+                r = envelope * pink(pinkState[1]);
+                break;
+            }
+            case 1:
+            {
+                // 持続音: 区間ごとに根音を変える長三和音 (右はわずかにデチューン)
+                if (positionInSection == 0)
+                    chordRoot = 110.0 * std::pow(2.0, static_cast<double>(rng() % 24u) / 12.0);
+                for (const double ratio : { 1.0, 1.2599, 1.4983 })
+                {
+                    l += 0.08 * std::sin(twoPi * chordRoot * ratio * t);
+                    r += 0.08 * std::sin(twoPi * chordRoot * ratio * 1.001 * t);
+                }
+                break;
+            }
+            default:
+            {
+                // 打撃: 250 ms ごとに 30 ms 減衰のノイズバースト + 微小な背景ノイズ
+                if (positionInSection % burstPeriod == 0)
+                    burstEnvelope = 0.5 + 0.3 * uniformSigned(rng);
+                else
+                    burstEnvelope *= burstDecay;
+                l = burstEnvelope * uniformSigned(rng) + 0.002 * uniformSigned(rng);
+                r = burstEnvelope * uniformSigned(rng) + 0.002 * uniformSigned(rng);
+                break;
+            }
+        }
+
+        left[n] = static_cast<float>(std::clamp(l, -0.95, 0.95));
+        right[n] = static_cast<float>(std::clamp(r, -0.95, 0.95));
+    }
+
+    std::vector<NoiseShaperOfflineTrainer::CorpusClip> clips;
+    clips.push_back(std::move(clip));
+    return clips;
+}
+
+bool NoiseShaperLearnerBenchmark::runOnce(RunResult& outRun)
+{
+    // 実行ごとに学習器を作り直す (マスキング閾値キャッシュ等を前の実行から持ち越さない)
+    learner = std::make_unique<NoiseShaperLearner>(engine, *unusedCaptureQueue);
+
+    NoiseShaperLearner::OfflineSession session;
+    session.sampleRateHz = options.sampleRateHz;
+    session.bitDepth = options.bitDepth;
+    session.mode = options.mode;
+    session.bankIndex = AudioEngine::getAdaptiveCoeffBankIndex(options.sampleRateHz, options.bitDepth, options.mode);
+    session.initialCoefficients = kBenchmarkInitialCoefficients;
+    session.readAudio = NoiseShaperOfflineTrainer::makeCorpusReader(corpus, options.sampleRateHz);
+    session.seed = options.seed;
+    session.evaluationWorkerCount = options.evaluationWorkerCount;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    session.onGeneration = [&outRun, startTime](const NoiseShaperLearner::OfflineGenerationReport& report)
+    {
+        CurvePoint point;
+        point.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        point.report = report;
+        outRun.curve.push_back(point);
+    };
+
+    const bool ran = learner->runOfflineSession(session, outRun.offline, stopSource.get_token());
+    outRun.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    learner.reset();
+    return ran && !threadShouldExit();
+}
+
+juce::var NoiseShaperLearnerBenchmark::describeRun(const RunResult& run) const
+{
+    auto* runObject = new juce::DynamicObject();
+    const auto& offline = run.offline;
+
+    int evaluatedCandidates = 0;
+    for (const auto& point : run.curve)
+        evaluatedCandidates += point.report.evaluatedCandidates;
+    const std::uint64_t segmentEvaluations = run.curve.empty() ? 0 : run.curve.back().report.segmentEvaluations;
+    const std::uint64_t screeningEvaluations = run.curve.empty() ? 0 : run.curve.back().report.screeningEvaluations;
+    const double wall = std::max(run.wallSeconds, 1.0e-9);
+
+    runObject->setProperty("wallSeconds", run.wallSeconds);
+    runObject->setProperty("generations", offline.generations);
+    runObject->setProperty("completed", offline.completed);
+    runObject->setProperty("playbackSeconds", offline.playbackSeconds);
+    runObject->setProperty("realtimeFactor", offline.playbackSeconds / wall);
+    runObject->setProperty("bestScore", offline.bestScore);
+    runObject->setProperty("candidateEvaluations", evaluatedCandidates);
+    runObject->setProperty("candidateEvaluationsPerSecond", static_cast<double>(evaluatedCandidates) / wall);
+    runObject->setProperty("segmentEvaluations", static_cast<juce::int64>(segmentEvaluations));
+    runObject->setProperty("segmentEvaluationsPerSecond", static_cast<double>(segmentEvaluations) / wall);
+    runObject->setProperty("screeningEvaluations", static_cast<juce::int64>(screeningEvaluations));
+
+    // time-to-score: スコアは小さいほど良い。各目標に最初に届いた世代の壁時計時間
+    const auto timeToReach = [&run](double targetScore) -> juce::var
+    {
+        for (const auto& point : run.curve)
+            if (point.report.bestScore <= targetScore)
+            {
+                auto* hit = new juce::DynamicObject();
+                hit->setProperty("targetScore", targetScore);
+                hit->setProperty("wallSeconds", point.wallSeconds);
+                hit->setProperty("playbackSeconds", point.report.playbackSeconds);
+                hit->setProperty("generation", point.report.generation);
+                return juce::var(hit);
+            }
+
+        auto* miss = new juce::DynamicObject();
+        miss->setProperty("targetScore", targetScore);
+        miss->setProperty("reached", false);
+        return juce::var(miss);
+    };
+
+    juce::Array<juce::var> timeToScore;
+    if (!run.curve.empty())
+    {
+        const double firstScore = run.curve.front().report.bestScore;
+        const double finalScore = run.curve.back().report.bestScore;
+        for (const double fraction : kImprovementFractions)
+        {
+            auto entry = timeToReach(firstScore - fraction * (firstScore - finalScore));
+            entry.getDynamicObject()->setProperty("improvementFraction", fraction);
+            timeToScore.add(entry);
+        }
+    }
+    for (const double target : options.targetScores)
+        timeToScore.add(timeToReach(target));
+    runObject->setProperty("timeToScore", timeToScore);
+
+    juce::Array<juce::var> curve;
+    for (const auto& point : run.curve)
+    {
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("generation", point.report.generation);
+        entry->setProperty("wallSeconds", point.wallSeconds);
+        entry->setProperty("playbackSeconds", point.report.playbackSeconds);
+        entry->setProperty("bestScore", point.report.bestScore);
+        entry->setProperty("latestScore", point.report.latestScore);
+        entry->setProperty("evaluatedCandidates", point.report.evaluatedCandidates);
+        curve.add(juce::var(entry));
+    }
+    runObject->setProperty("curve", curve);
+
+    juce::Array<juce::var> workers;
+    for (int workerIndex = 0; workerIndex < offline.evaluationWorkerCount; ++workerIndex)
+    {
+        const auto& stats = offline.workerStats[static_cast<size_t>(workerIndex)];
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("index", workerIndex);
+        entry->setProperty("busySeconds", stats.busySeconds);
+        entry->setProperty("utilization", stats.busySeconds / wall);
+        entry->setProperty("tasks", static_cast<juce::int64>(stats.tasks));
+        entry->setProperty("segmentEvaluations", static_cast<juce::int64>(stats.segmentEvaluations));
+        entry->setProperty("screeningEvaluations", static_cast<juce::int64>(stats.screeningEvaluations));
+        workers.add(juce::var(entry));
+    }
+    runObject->setProperty("workers", workers);
+
+    return juce::var(runObject);
+}
+
+bool NoiseShaperLearnerBenchmark::writeReport(const std::vector<RunResult>& runs, double corpusSeconds) const
+{
+    auto* root = new juce::DynamicObject();
+    root->setProperty("benchmark", "NoiseShaperLearner");
+    root->setProperty("corpus", options.corpusDirectory.isDirectory() ? options.corpusDirectory.getFullPathName() : juce::String("synthetic"));
+    root->setProperty("corpusSeconds", corpusSeconds);
+    root->setProperty("sampleRateHz", options.sampleRateHz);
+    root->setProperty("bitDepth", options.bitDepth);
+    root->setProperty("mode", modeName(options.mode));
+    root->setProperty("seed", juce::String::toHexString(static_cast<juce::int64>(options.seed)));
+    root->setProperty("evaluationWorkers", options.evaluationWorkerCount);
+    root->setProperty("hardwareThreads", static_cast<int>(std::thread::hardware_concurrency()));
+    root->setProperty("kernelIsa", juce::String(convo::dsp::kernelIsaName(convo::dsp::activeKernels().isa)));
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+
+    juce::Array<juce::var> runArray;
+    for (const auto& run : runs)
+        runArray.add(describeRun(run));
+    root->setProperty("runs", runArray);
+
+    const auto json = juce::JSON::toString(juce::var(root));
+    if (options.outputFile == juce::File())
+    {
+        std::fputs(json.toRawUTF8(), stdout);
+        std::fputs("\n", stdout);
+        std::fflush(stdout);
+        return true;
+    }
+    return options.outputFile.replaceWithText(json);
+}
+
+void NoiseShaperLearnerBenchmark::run()
+{
+    engine.getAffinityManager().applyCurrentThreadPolicy(ThreadType::LearnerMain);
+
+    bool succeeded = false;
+    if (options.corpusDirectory.isDirectory())
+        corpus = NoiseShaperOfflineTrainer::loadCorpus(options.corpusDirectory,
+                                                       NoiseShaperOfflineTrainer::kMaxCorpusSeconds,
+                                                       [this] { return threadShouldExit(); });
+    else
+        corpus = makeSyntheticCorpus(options.sampleRateHz, kSyntheticCorpusSeconds);
+
+    double corpusSeconds = 0.0;
+    for (const auto& clip : corpus)
+        corpusSeconds += static_cast<double>(clip.audio.getNumSamples()) / clip.sampleRateHz;
+
+    if (corpus.empty())
+    {
+        juce::Logger::writeToLog("[LearnerBenchmark] No decodable audio in " + options.corpusDirectory.getFullPathName());
+    }
+    else
+    {
+        std::vector<RunResult> runs;
+        for (int repeat = 0; repeat < options.repeats && !threadShouldExit(); ++repeat)
+        {
+            RunResult result;
+            if (!runOnce(result))
+                break;
+
+            juce::Logger::writeToLog("[LearnerBenchmark] run=" + juce::String(repeat)
+                                     + " wallSec=" + juce::String(result.wallSeconds, 3)
+                                     + " generations=" + juce::String(result.offline.generations)
+                                     + " bestScore=" + juce::String(result.offline.bestScore, 6));
+            runs.push_back(std::move(result));
+        }
+
+        if (static_cast<int>(runs.size()) == options.repeats)
+            succeeded = writeReport(runs, corpusSeconds);
+        if (!succeeded)
+            juce::Logger::writeToLog("[LearnerBenchmark] Benchmark did not complete");
+    }
+
+    juce::MessageManager::callAsync([callback = onFinished, succeeded]
+    {
+        if (callback)
+            callback(succeeded);
+    });
+}
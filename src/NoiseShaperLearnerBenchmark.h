@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "NoiseShaperLearner.h"
+#include "NoiseShaperOfflineTrainer.h"
+
+class AudioEngine;
+
+/**
+    NoiseShaperLearnerBenchmark: 学習器の収束速度を再現可能な条件で測るスレッド。
+
+    --cli-learn-benchmark <dir|synthetic> から起動する。固定コーパス (dir 以下の音声、または
+    シード固定の合成音源)・固定シード・固定評価ワーカー数で NoiseShaperLearner::runOfflineSession を
+    repeats 回まわし、世代ごとの壁時計時間とスコアから
+      - time-to-score 曲線 (総改善量の 50 / 90 / 99 % と指定スコアへの到達時間)
+      - 候補評価 / 秒、(候補, セグメント) 評価 / 秒、実時間比
+      - 評価ワーカーごとの稼働率 (runEvaluationJobsForWorker 内の時間 / 壁時計時間)
+    を JSON で出力する。初期係数は AudioEngine の既定係数を使い、学習済みバンクには依存しない。
+    結果はバンクへ書き込まない。
+*/
+class NoiseShaperLearnerBenchmark : public juce::Thread
+{
+public:
+    struct Options
+    {
+        juce::File corpusDirectory;             // 存在しなければ合成コーパス
+        double sampleRateHz = 48000.0;
+        int bitDepth = 24;
+        convo::NoiseShaperLearningMode mode = convo::NoiseShaperLearningMode::Short;
+        std::uint64_t seed = 0x4e53424e43484d31ull;
+        int evaluationWorkerCount = 4;          // 機種間で比較できるよう既定でも固定
+        int repeats = 1;
+        std::vector<double> targetScores;       // 絶対スコアでの到達時間も出す (任意)
+        juce::File outputFile;                  // 空なら標準出力
+    };
+
+    // Message Thread で呼ばれる。succeeded = 全回の計測を終えて JSON を書けた
+    using FinishedCallback = std::function<void(bool succeeded)>;
+
+    NoiseShaperLearnerBenchmark(AudioEngine& engine, Options options, FinishedCallback onFinished);
+    ~NoiseShaperLearnerBenchmark() override;
+
+    void run() override;
+    void cancel();
+
+    // 合成コーパスの長さ (ループ再生されるので Ultra の目標再生時間より短くてよい)
+    static constexpr double kSyntheticCorpusSeconds = 60.0;
+
+    // シード固定の合成コーパス: 広帯域 (1/f 寄り) ノイズ、和音の持続音、打撃的なバーストを
+    // 数秒ごとに切り替え、Broadband / Tonal / Transient の全分類のセグメントを含める
+    static std::vector<NoiseShaperOfflineTrainer::CorpusClip> makeSyntheticCorpus(double sampleRateHz, double seconds);
+
+private:
+    struct CurvePoint
+    {
+        double wallSeconds = 0.0;
+        NoiseShaperLearner::OfflineGenerationReport report;
+    };
+
+    struct RunResult
+    {
+        double wallSeconds = 0.0;
+        NoiseShaperLearner::OfflineResult offline;
+        std::vector<CurvePoint> curve;
+    };
+
+    bool runOnce(RunResult& outRun);
+    juce::var describeRun(const RunResult& run) const;
+    bool writeReport(const std::vector<RunResult>& runs, double corpusSeconds) const;
+
+    AudioEngine& engine;
+    Options options;
+    FinishedCallback onFinished;
+    std::vector<NoiseShaperOfflineTrainer::CorpusClip> corpus;
+    // NoiseShaperLearner のコンストラクタが要求するキャプチャキュー。誰も push しない
+    std::unique_ptr<AdaptiveCaptureQueue> unusedCaptureQueue;
+    std::unique_ptr<NoiseShaperLearner> learner;
+    std::stop_source stopSource;
+};
@@ -41,6 +41,22 @@ struct NoiseShaperLearnerProgress
     std::atomic<int> learningMode { 0 };
 };
 
+// UI 向けの進捗スナップショット。NoiseShaperLearner が NoiseShaperLearnerProgress の各 atomic を
+// 1 枚にまとめて seqlock で公開し、UI は getProgressView() の 1 回の読み取りで全項目を同じ時点の組として得る
+struct NoiseShaperLearnerProgressView
+{
+    std::uint64_t totalGenerations = 0;
+    double bestScore = 0.0;
+    double latestScore = 0.0;
+    double elapsedPlaybackSeconds = 0.0;
+    int iteration = 0;
+    int processCount = 0;
+    int segmentCount = 0;
+    int currentPhase = 1;
+    int learningMode = 0;
+    NoiseShaperLearnerStatus status = NoiseShaperLearnerStatus::Idle;
+};
+
 struct NoiseShaperLearnerState
 {
     double mean[9] = {};
@@ -61,13 +77,21 @@ struct NoiseShaperLearnerSettings
     std::atomic<int> cmaesRestarts { 5 };
     std::atomic<double> coeffSafetyMargin { 0.85 };
     std::atomic<bool> enableStabilityCheck { true };
+    std::atomic<bool> enableRacing { true };   // 予選で劣る候補の本評価を打ち切る
+    std::atomic<bool> enableScreening { true };  // 安い忠実度で全候補を予備選別し、上位だけを本評価する
+    std::atomic<bool> enableCaptureDecimation { true };  // フェーズ 2 以降はキャプチャをバースト単位で間引く
+    std::atomic<bool> learnAllBitDepths { false };  // 同じレート・モードの他ビット深度バンクも同じキャプチャで並行に学習する
 
     NoiseShaperLearnerSettings() = default;
 
     NoiseShaperLearnerSettings(const NoiseShaperLearnerSettings& other)
                 : cmaesRestarts(convo::consumeAtomic(other.cmaesRestarts, std::memory_order_acquire)),
                     coeffSafetyMargin(convo::consumeAtomic(other.coeffSafetyMargin, std::memory_order_acquire)),
-                    enableStabilityCheck(convo::consumeAtomic(other.enableStabilityCheck, std::memory_order_acquire))
+                    enableStabilityCheck(convo::consumeAtomic(other.enableStabilityCheck, std::memory_order_acquire)),
+                    enableRacing(convo::consumeAtomic(other.enableRacing, std::memory_order_acquire)),
+                    enableScreening(convo::consumeAtomic(other.enableScreening, std::memory_order_acquire)),
+                    enableCaptureDecimation(convo::consumeAtomic(other.enableCaptureDecimation, std::memory_order_acquire)),
+                    learnAllBitDepths(convo::consumeAtomic(other.learnAllBitDepths, std::memory_order_acquire))
     {
     }
 
@@ -76,6 +100,10 @@ struct NoiseShaperLearnerSettings
         cmaesRestarts = convo::consumeAtomic(other.cmaesRestarts, std::memory_order_acquire);
         coeffSafetyMargin = convo::consumeAtomic(other.coeffSafetyMargin, std::memory_order_acquire);
         enableStabilityCheck = convo::consumeAtomic(other.enableStabilityCheck, std::memory_order_acquire);
+        enableRacing = convo::consumeAtomic(other.enableRacing, std::memory_order_acquire);
+        enableScreening = convo::consumeAtomic(other.enableScreening, std::memory_order_acquire);
+        enableCaptureDecimation = convo::consumeAtomic(other.enableCaptureDecimation, std::memory_order_acquire);
+        learnAllBitDepths = convo::consumeAtomic(other.learnAllBitDepths, std::memory_order_acquire);
         return *this;
     }
 };
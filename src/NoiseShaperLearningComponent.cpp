@@ -152,6 +152,50 @@ NoiseShaperLearningComponent::NoiseShaperLearningComponent(AudioEngine& engine)
     enableStabilityCheckButton.setToggleState(true, juce::dontSendNotification);
     addAndMakeVisible(enableStabilityCheckButton);
 
+    enableRacingButton.onClick = [this] {
+        if (audioEngine.isNoiseShaperLearning())
+            return;
+
+        auto s = audioEngine.getNoiseShaperLearnerSettings();
+        s.enableRacing = enableRacingButton.getToggleState();
+        audioEngine.setNoiseShaperLearnerSettings(s);
+    };
+    enableRacingButton.setToggleState(true, juce::dontSendNotification);
+    addAndMakeVisible(enableRacingButton);
+
+    enableScreeningButton.onClick = [this] {
+        if (audioEngine.isNoiseShaperLearning())
+            return;
+
+        auto s = audioEngine.getNoiseShaperLearnerSettings();
+        s.enableScreening = enableScreeningButton.getToggleState();
+        audioEngine.setNoiseShaperLearnerSettings(s);
+    };
+    enableScreeningButton.setToggleState(true, juce::dontSendNotification);
+    addAndMakeVisible(enableScreeningButton);
+
+    enableCaptureDecimationButton.onClick = [this] {
+        if (audioEngine.isNoiseShaperLearning())
+            return;
+
+        auto s = audioEngine.getNoiseShaperLearnerSettings();
+        s.enableCaptureDecimation = enableCaptureDecimationButton.getToggleState();
+        audioEngine.setNoiseShaperLearnerSettings(s);
+    };
+    enableCaptureDecimationButton.setToggleState(true, juce::dontSendNotification);
+    addAndMakeVisible(enableCaptureDecimationButton);
+
+    learnAllBitDepthsButton.onClick = [this] {
+        if (audioEngine.isNoiseShaperLearning())
+            return;
+
+        auto s = audioEngine.getNoiseShaperLearnerSettings();
+        s.learnAllBitDepths = learnAllBitDepthsButton.getToggleState();
+        audioEngine.setNoiseShaperLearnerSettings(s);
+    };
+    learnAllBitDepthsButton.setToggleState(false, juce::dontSendNotification);
+    addAndMakeVisible(learnAllBitDepthsButton);
+
     refreshFromEngine();
     startTimerHz(8);
     periodicSaver.startTimer(300000); // 5 minutes
@@ -231,7 +275,12 @@ void NoiseShaperLearningComponent::resized()
 
     area.removeFromTop(4);
     auto stabilityRow = area.removeFromTop(24);
-    enableStabilityCheckButton.setBounds(stabilityRow.reduced(2, 0));
+    const int toggleWidth = stabilityRow.getWidth() / 5;
+    enableStabilityCheckButton.setBounds(stabilityRow.removeFromLeft(toggleWidth).reduced(2, 0));
+    enableRacingButton.setBounds(stabilityRow.removeFromLeft(toggleWidth).reduced(2, 0));
+    enableScreeningButton.setBounds(stabilityRow.removeFromLeft(toggleWidth).reduced(2, 0));
+    enableCaptureDecimationButton.setBounds(stabilityRow.removeFromLeft(toggleWidth).reduced(2, 0));
+    learnAllBitDepthsButton.setBounds(stabilityRow.reduced(2, 0));
 
     area.removeFromTop(4);
     messageLabel.setBounds(area.removeFromTop(22));
@@ -364,17 +413,18 @@ void NoiseShaperLearningComponent::timerCallback()
 
 void NoiseShaperLearningComponent::refreshFromEngine()
 {
-    const auto& progress = audioEngine.getNoiseShaperLearningProgress();
-    const auto status = convo::consumeAtomic(progress.status, std::memory_order_acquire);
-    int iteration = convo::consumeAtomic(progress.iteration, std::memory_order_acquire);
-    uint64_t totalGenerations = convo::consumeAtomic(progress.totalGenerations, std::memory_order_acquire);
-    int processCount = convo::consumeAtomic(progress.processCount, std::memory_order_acquire);
-    const int segmentCount = convo::consumeAtomic(progress.segmentCount, std::memory_order_acquire);
-    double bestScore = convo::consumeAtomic(progress.bestScore, std::memory_order_acquire);
-    const double latestScore = convo::consumeAtomic(progress.latestScore, std::memory_order_acquire);
-    double elapsedSec = convo::consumeAtomic(progress.elapsedPlaybackSeconds, std::memory_order_acquire);
-    int currentPhase = convo::consumeAtomic(progress.currentPhase, std::memory_order_acquire);
-    const auto learningMode = static_cast<NoiseShaperLearner::LearningMode>(convo::consumeAtomic(progress.learningMode, std::memory_order_acquire));
+    // 全項目を同じ時点の組として 1 回で読む (項目ごとに別世代の値が混ざらない)
+    const auto progress = audioEngine.getNoiseShaperLearningProgress();
+    const auto status = progress.status;
+    int iteration = progress.iteration;
+    uint64_t totalGenerations = progress.totalGenerations;
+    int processCount = progress.processCount;
+    const int segmentCount = progress.segmentCount;
+    double bestScore = progress.bestScore;
+    const double latestScore = progress.latestScore;
+    double elapsedSec = progress.elapsedPlaybackSeconds;
+    int currentPhase = progress.currentPhase;
+    const auto learningMode = static_cast<NoiseShaperLearner::LearningMode>(progress.learningMode);
 
     const double sr = audioEngine.getSampleRate();
     const int bd = audioEngine.getDitherBitDepth();
@@ -443,6 +493,10 @@ void NoiseShaperLearningComponent::refreshFromEngine()
         coeffSafetyMarginSlider.setValue(audioEngine.getNoiseShaperLearnerSettings().coeffSafetyMargin, juce::dontSendNotification);
 
     enableStabilityCheckButton.setToggleState(audioEngine.getNoiseShaperLearnerSettings().enableStabilityCheck, juce::dontSendNotification);
+    enableRacingButton.setToggleState(audioEngine.getNoiseShaperLearnerSettings().enableRacing, juce::dontSendNotification);
+    enableScreeningButton.setToggleState(audioEngine.getNoiseShaperLearnerSettings().enableScreening, juce::dontSendNotification);
+    enableCaptureDecimationButton.setToggleState(audioEngine.getNoiseShaperLearnerSettings().enableCaptureDecimation, juce::dontSendNotification);
+    learnAllBitDepthsButton.setToggleState(audioEngine.getNoiseShaperLearnerSettings().learnAllBitDepths, juce::dontSendNotification);
 
     juce::String message = "Press Start learning to begin adaptive optimization.";
 
@@ -486,6 +540,10 @@ void NoiseShaperLearningComponent::refreshFromEngine()
     cmaesRestartsSlider.setEnabled(canEditLearnerSettings);
     coeffSafetyMarginSlider.setEnabled(canEditLearnerSettings);
     enableStabilityCheckButton.setEnabled(canEditLearnerSettings);
+    enableRacingButton.setEnabled(canEditLearnerSettings);
+    enableScreeningButton.setEnabled(canEditLearnerSettings);
+    enableCaptureDecimationButton.setEnabled(canEditLearnerSettings);
+    learnAllBitDepthsButton.setEnabled(canEditLearnerSettings);
 
     const int points = audioEngine.copyNoiseShaperLearningHistory(historyBuffer.data(),
                                                                   static_cast<int>(historyBuffer.size()));
@@ -6,6 +6,7 @@
 
 #include "AudioEngine.h"
 #include "NoiseShaperLearner.h"
+#include "NoiseShaperStateJournal.h"
 
 class NoiseShaperLearningComponent : public juce::Component,
                                      private juce::Timer
@@ -59,6 +60,10 @@ private:
     juce::Slider coeffSafetyMarginSlider;
     juce::Label  coeffSafetyMarginLabel { "Margin", "Coeff Safety Margin:" };
     juce::ToggleButton enableStabilityCheckButton { "Enable Stability Check" };
+    juce::ToggleButton enableRacingButton { "Racing (early termination)" };
+    juce::ToggleButton enableScreeningButton { "Screening (multi-fidelity)" };
+    juce::ToggleButton enableCaptureDecimationButton { "Decimate capture" };
+    juce::ToggleButton learnAllBitDepthsButton { "All bit depths" };
 
     std::array<double, NoiseShaperLearner::kMaxHistoryPoints> historyBuffer {};
 
@@ -68,8 +73,9 @@ private:
         PeriodicSaver(AudioEngine& engine) : audioEngine(engine) {}
         void timerCallback() override
         {
+            // 各世代はジャーナルへ追記済み。ここでは溜まったレコードの圧縮だけを書き込みスレッドへ頼む
             if (audioEngine.isNoiseShaperLearning())
-                audioEngine.requestAdaptiveAutosave();
+                convo::NoiseShaperStateJournal::getInstance().requestCompaction();
         }
     private:
         AudioEngine& audioEngine;
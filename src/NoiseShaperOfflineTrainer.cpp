@@ -0,0 +1,316 @@
+#include "NoiseShaperOfflineTrainer.h"
+
+#include "AudioEngine.h"
+#include "core/ThreadAffinityManager.h"
+
+#include "CDSPResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    // コーパスを指定レートの連続ストリームとして読む (末尾に達したら先頭へ戻る)。
+    // レートが異なるクリップは r8brain でクリップ単位にストリーミング変換する
+    class OfflineCorpusStream
+    {
+    public:
+        OfflineCorpusStream(const std::vector<NoiseShaperOfflineTrainer::CorpusClip>& clipsRef, double targetRateHz)
+            : clips(clipsRef),
+              targetSampleRate(targetRateHz),
+              inputLeft(static_cast<size_t>(kInputChunk)),
+              inputRight(static_cast<size_t>(kInputChunk))
+        {
+            openClip(0);
+        }
+
+        int read(double* left, double* right, int maxSamples)
+        {
+            int written = 0;
+            while (written < maxSamples)
+            {
+                if (pendingPosition < pendingCount)
+                {
+                    const int count = std::min(maxSamples - written, pendingCount - pendingPosition);
+                    std::memcpy(left + written, pendingLeft + pendingPosition, static_cast<size_t>(count) * sizeof(double));
+                    std::memcpy(right + written, pendingRight + pendingPosition, static_cast<size_t>(count) * sizeof(double));
+                    pendingPosition += count;
+                    written += count;
+                    continue;
+                }
+
+                if (!refill())
+                    break;
+            }
+            return written;
+        }
+
+    private:
+        static constexpr int kInputChunk = 4096;
+
+        void openClip(int index)
+        {
+            clipIndex = index;
+            clipPosition = 0;
+            resamplerLeft.reset();
+            resamplerRight.reset();
+
+            const auto& clip = clips[static_cast<size_t>(clipIndex)];
+            if (std::abs(clip.sampleRateHz - targetSampleRate) > 0.5)
+            {
+                resamplerLeft = std::make_unique<r8b::CDSPResampler24>(clip.sampleRateHz, targetSampleRate, kInputChunk);
+                resamplerRight = std::make_unique<r8b::CDSPResampler24>(clip.sampleRateHz, targetSampleRate, kInputChunk);
+            }
+        }
+
+        // 次の入力チャンクを変換して pending に置く。コーパスが空なら false
+        bool refill()
+        {
+            for (int attempts = 0; attempts <= static_cast<int>(clips.size()); ++attempts)
+            {
+                const auto& clip = clips[static_cast<size_t>(clipIndex)];
+                const int available = clip.audio.getNumSamples() - clipPosition;
+                if (available <= 0)
+                {
+                    openClip((clipIndex + 1) % static_cast<int>(clips.size()));
+                    continue;
+                }
+
+                const int count = std::min(kInputChunk, available);
+                const float* srcLeft = clip.audio.getReadPointer(0, clipPosition);
+                const float* srcRight = clip.audio.getReadPointer(1, clipPosition);
+                for (int i = 0; i < count; ++i)
+                {
+                    inputLeft[static_cast<size_t>(i)] = static_cast<double>(srcLeft[i]);
+                    inputRight[static_cast<size_t>(i)] = static_cast<double>(srcRight[i]);
+                }
+                clipPosition += count;
+
+                pendingPosition = 0;
+                if (resamplerLeft == nullptr)
+                {
+                    pendingLeft = inputLeft.data();
+                    pendingRight = inputRight.data();
+                    pendingCount = count;
+                }
+                else
+                {
+                    // 出力バッファは各 resampler の内部領域 (次の process 呼び出しまで有効)
+                    const int producedLeft = resamplerLeft->process(inputLeft.data(), count, pendingLeft);
+                    const int producedRight = resamplerRight->process(inputRight.data(), count, pendingRight);
+                    pendingCount = std::min(producedLeft, producedRight);
+                }
+
+                if (pendingCount > 0)
+                    return true;
+            }
+            return false;
+        }
+
+        const std::vector<NoiseShaperOfflineTrainer::CorpusClip>& clips;
+        double targetSampleRate = 0.0;
+        int clipIndex = 0;
+        int clipPosition = 0;
+        std::unique_ptr<r8b::CDSPResampler24> resamplerLeft;
+        std::unique_ptr<r8b::CDSPResampler24> resamplerRight;
+        std::vector<double> inputLeft;
+        std::vector<double> inputRight;
+        double* pendingLeft = nullptr;
+        double* pendingRight = nullptr;
+        int pendingCount = 0;
+        int pendingPosition = 0;
+    };
+}
+
+NoiseShaperOfflineTrainer::NoiseShaperOfflineTrainer(AudioEngine& engineRef,
+                                                     juce::File directory,
+                                                     FinishedCallback finishedCallback)
+    : juce::Thread("NoiseShaperOfflineTrainer"),
+      engine(engineRef),
+      corpusDirectory(std::move(directory)),
+      onFinished(std::move(finishedCallback)),
+      unusedCaptureQueue(std::make_unique<AdaptiveCaptureQueue>()),
+      learner(std::make_unique<NoiseShaperLearner>(engineRef, *unusedCaptureQueue))
+{
+}
+
+NoiseShaperOfflineTrainer::~NoiseShaperOfflineTrainer()
+{
+    cancel();
+    stopThread(10000);
+}
+
+void NoiseShaperOfflineTrainer::cancel()
+{
+    stopSource.request_stop();
+    signalThreadShouldExit();
+}
+
+std::vector<NoiseShaperOfflineTrainer::CorpusClip> NoiseShaperOfflineTrainer::loadCorpus(const juce::File& directory,
+                                                                                        double maxSeconds,
+                                                                                        const std::function<bool()>& shouldExit)
+{
+    std::vector<CorpusClip> corpus;
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    auto files = directory.findChildFiles(juce::File::findFiles, true, formatManager.getWildcardForAllFormats());
+    // 同じディレクトリからは常に同じコーパス (= 同じ係数) になるよう名前順に並べる
+    std::sort(files.begin(), files.end(), [](const juce::File& a, const juce::File& b)
+    {
+        return a.getFullPathName().compareNatural(b.getFullPathName()) < 0;
+    });
+
+    double totalSeconds = 0.0;
+    for (const auto& file : files)
+    {
+        if ((shouldExit && shouldExit()) || totalSeconds >= maxSeconds)
+            break;
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0 || reader->numChannels <= 0)
+        {
+            juce::Logger::writeToLog("[OfflineTrainer] Skipped unreadable file: " + file.getFullPathName());
+            continue;
+        }
+
+        const auto remainingSamples = static_cast<juce::int64>(std::ceil((maxSeconds - totalSeconds) * reader->sampleRate));
+        const int numSamples = static_cast<int>(std::min({ reader->lengthInSamples,
+                                                           remainingSamples,
+                                                           static_cast<juce::int64>(std::numeric_limits<int>::max()) }));
+
+        CorpusClip clip;
+        clip.sampleRateHz = reader->sampleRate;
+        clip.audio.setSize(2, numSamples);
+        reader->read(&clip.audio, 0, numSamples, 0, true, true);
+        if (reader->numChannels == 1)
+            clip.audio.copyFrom(1, 0, clip.audio, 0, 0, numSamples);
+
+        totalSeconds += static_cast<double>(numSamples) / reader->sampleRate;
+        juce::Logger::writeToLog("[OfflineTrainer] Corpus file: " + file.getFileName()
+                                 + " sr=" + juce::String(reader->sampleRate)
+                                 + " seconds=" + juce::String(static_cast<double>(numSamples) / reader->sampleRate, 1));
+        corpus.push_back(std::move(clip));
+    }
+
+    juce::Logger::writeToLog("[OfflineTrainer] Corpus loaded: files=" + juce::String(static_cast<int>(corpus.size()))
+                             + " seconds=" + juce::String(totalSeconds, 1));
+    return corpus;
+}
+
+NoiseShaperLearner::OfflineAudioReader NoiseShaperOfflineTrainer::makeCorpusReader(const std::vector<CorpusClip>& corpus,
+                                                                                    double sampleRateHz)
+{
+    auto stream = std::make_shared<OfflineCorpusStream>(corpus, sampleRateHz);
+    return [stream](double* left, double* right, int maxSamples)
+    {
+        return stream->read(left, right, maxSamples);
+    };
+}
+
+void NoiseShaperOfflineTrainer::run()
+{
+    engine.getAffinityManager().applyCurrentThreadPolicy(ThreadType::LearnerMain);
+
+    bool allBanksCompleted = false;
+    corpus = loadCorpus(corpusDirectory, kMaxCorpusSeconds, [this] { return threadShouldExit(); });
+    if (corpus.empty())
+    {
+        juce::Logger::writeToLog("[OfflineTrainer] No decodable audio in " + corpusDirectory.getFullPathName());
+    }
+    else
+    {
+        const auto stopToken = stopSource.get_token();
+        const juce::WeakReference<AudioEngine> weakEngine(&engine);
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+        int completedBanks = 0;
+        int totalBanks = 0;
+
+        for (int rateBank = 0; rateBank < kAdaptiveNoiseShaperSampleRateBankCount && !threadShouldExit(); ++rateBank)
+        {
+            const double sampleRateHz = AudioEngine::getAdaptiveSampleRateBankHz(rateBank);
+            for (int modeIndex = 0; modeIndex < kLearningModeCount && !threadShouldExit(); ++modeIndex)
+            {
+                // 同じレート・モードのビット深度 3 バンクは 1 セッションで並行に学習する
+                // (コーパスの変換・セグメント構築・マスキング閾値を共有し、評価タスクだけ混ぜて分配する)
+                const auto mode = static_cast<convo::NoiseShaperLearningMode>(modeIndex);
+                NoiseShaperLearner::OfflineSession session;
+                session.sampleRateHz = sampleRateHz;
+                session.bitDepth = kAdaptiveBitDepthValues[0];
+                session.mode = mode;
+                session.bankIndex = AudioEngine::getAdaptiveCoeffBankIndex(sampleRateHz, session.bitDepth, mode);
+                engine.getAdaptiveCoefficientsForBank(session.bankIndex,
+                                                      session.initialCoefficients.data(),
+                                                      NoiseShaperLearner::kOrder);
+                for (int depthIndex = 1; depthIndex < kAdaptiveBitDepthCount; ++depthIndex)
+                {
+                    auto& extra = session.extraTargets[static_cast<size_t>(session.extraTargetCount++)];
+                    extra.bitDepth = kAdaptiveBitDepthValues[depthIndex];
+                    extra.bankIndex = AudioEngine::getAdaptiveCoeffBankIndex(sampleRateHz, extra.bitDepth, mode);
+                    engine.getAdaptiveCoefficientsForBank(extra.bankIndex,
+                                                          extra.initialCoefficients.data(),
+                                                          NoiseShaperLearner::kOrder);
+                }
+
+                session.readAudio = makeCorpusReader(corpus, sampleRateHz);
+
+                NoiseShaperLearner::OfflineResult result;
+                totalBanks += 1 + session.extraTargetCount;
+                if (!learner->runOfflineSession(session, result, stopToken) || stopToken.stop_requested())
+                    break;
+
+                // 副バンクは主バンクと同じ再生時間を消費するので、完了判定も共通
+                if (result.completed)
+                    completedBanks += 1 + session.extraTargetCount;
+
+                const auto storeBank = [&](int bankIndex, int bitDepth, const std::array<double, NoiseShaperLearner::kOrder>& coefficients,
+                                           const convo::NoiseShaperLearnerState& state, int generations, double bestScore)
+                {
+                    juce::Logger::writeToLog("[OfflineTrainer] bank=" + juce::String(bankIndex)
+                                             + " sr=" + juce::String(sampleRateHz)
+                                             + " bits=" + juce::String(bitDepth)
+                                             + " mode=" + juce::String(modeIndex)
+                                             + " generations=" + juce::String(generations)
+                                             + " playbackSec=" + juce::String(result.playbackSeconds, 1)
+                                             + " bestScore=" + juce::String(bestScore, 6)
+                                             + " completed=" + juce::String(static_cast<int>(result.completed)));
+
+                    juce::MessageManager::callAsync([weakEngine, bankIndex, coefficients, state]
+                    {
+                        if (auto* target = weakEngine.get())
+                            if (!target->storeAdaptiveCoeffBank(bankIndex, coefficients.data(), state))
+                                juce::Logger::writeToLog("[OfflineTrainer] bank=" + juce::String(bankIndex) + " store rejected");
+                    });
+                };
+
+                storeBank(session.bankIndex, session.bitDepth, result.coefficients, result.state,
+                          result.generations, result.bestScore);
+                for (int i = 0; i < session.extraTargetCount; ++i)
+                {
+                    const auto& extra = session.extraTargets[static_cast<size_t>(i)];
+                    const auto& extraResult = result.extraResults[static_cast<size_t>(i)];
+                    storeBank(extra.bankIndex, extra.bitDepth, extraResult.coefficients, extraResult.state,
+                              extraResult.generations, extraResult.bestScore);
+                }
+            }
+        }
+
+        allBanksCompleted = !threadShouldExit() && completedBanks == totalBanks
+            && totalBanks == kAdaptiveNoiseShaperSampleRateBankCount * kAdaptiveBitDepthCount * kLearningModeCount;
+        juce::Logger::writeToLog("[OfflineTrainer] Finished: completedBanks=" + juce::String(completedBanks)
+                                 + "/" + juce::String(totalBanks)
+                                 + " elapsedSec=" + juce::String((juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0, 1));
+    }
+
+    // バンク書き込み (上で積んだ callAsync) の後に自動保存と完了通知を流す
+    const juce::WeakReference<AudioEngine> weakEngine(&engine);
+    juce::MessageManager::callAsync([weakEngine, callback = onFinished, allBanksCompleted]
+    {
+        if (auto* target = weakEngine.get())
+            target->requestAdaptiveAutosave();
+        if (callback)
+            callback(allBanksCompleted);
+    });
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "NoiseShaperLearner.h"
+
+class AudioEngine;
+
+/**
+    NoiseShaperOfflineTrainer: 音声ファイルのコーパスから全適応係数バンクを実時間より速く学習するスレッド。
+
+    --cli-learn-offline <dir> から起動する。dir 以下の音声ファイルを先頭から kMaxCorpusSeconds まで
+    デコードし、(サンプルレート 10 × ビット深度 3 × 学習モード 6) = 180 バンクを学習する。
+    (レート, モード) ごとに 1 回の NoiseShaperLearner::runOfflineSession でビット深度 3 バンクを並行に学習し、
+    コーパスを (バンクのレートへ r8brain でストリーミング変換しながら) 直接流し込む。
+    キャプチャキューも世代間の待機も通さない。
+    結果は Message Thread で AudioEngine::storeAdaptiveCoeffBank に書き、最後に自動保存を要求する。
+    live 学習とは別インスタンスの学習器を使うが、バンク書き込みは live 学習中には拒否される。
+*/
+class NoiseShaperOfflineTrainer : public juce::Thread
+{
+public:
+    // 1 セッションが消費する再生時間の上限 (Ultra / オフライン Continuous の目標値)。
+    // 各セッションはコーパス先頭から読むため、これより後ろはデコードしない
+    static constexpr double kMaxCorpusSeconds = 300.0;
+
+    // Message Thread で呼ばれる。allBanksCompleted = 全バンクが目標再生時間まで学習できた
+    using FinishedCallback = std::function<void(bool allBanksCompleted)>;
+
+    NoiseShaperOfflineTrainer(AudioEngine& engine,
+                              juce::File corpusDirectory,
+                              FinishedCallback onFinished);
+
+    ~NoiseShaperOfflineTrainer() override;
+
+    void run() override;
+    void cancel();
+
+    struct CorpusClip
+    {
+        double sampleRateHz = 0.0;
+        juce::AudioBuffer<float> audio;  // 2ch (モノラル音源は複製)
+    };
+
+    // directory 以下の音声ファイルを名前順に合計 maxSeconds までデコードする (読めないファイルは飛ばす)。
+    // NoiseShaperLearnerBenchmark と共用
+    static std::vector<CorpusClip> loadCorpus(const juce::File& directory,
+                                              double maxSeconds,
+                                              const std::function<bool()>& shouldExit);
+
+    // corpus を sampleRateHz の連続ストリーム (末尾に達したら先頭へ戻る) として読むリーダーを作る。
+    // レートが異なるクリップは r8brain でクリップ単位にストリーミング変換する。
+    // corpus はリーダーを使い終わるまで生存させること
+    static NoiseShaperLearner::OfflineAudioReader makeCorpusReader(const std::vector<CorpusClip>& corpus,
+                                                                   double sampleRateHz);
+
+private:
+
+    AudioEngine& engine;
+    juce::File corpusDirectory;
+    FinishedCallback onFinished;
+    std::vector<CorpusClip> corpus;
+    // NoiseShaperLearner のコンストラクタが要求するキャプチャキュー。オフラインでは誰も push しない
+    std::unique_ptr<AdaptiveCaptureQueue> unusedCaptureQueue;
+    std::unique_ptr<NoiseShaperLearner> learner;
+    std::stop_source stopSource;
+};
@@ -0,0 +1,299 @@
+#include "NoiseShaperStateJournal.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace convo {
+
+namespace {
+
+constexpr std::uint32_t kRecordMagic = 0x314A534Eu;  // "NSJ1"
+
+// ディスク上の 1 レコード。ゼロ埋めしてから詰めるのでパディングもチェックサムに含めてよい
+struct DiskRecord
+{
+    std::uint32_t magic = 0;
+    std::int32_t bankIndex = -1;
+    NoiseShaperLearnerState state {};
+    double coefficients[NoiseShaperStateJournal::kCoeffCount] = {};
+    std::uint64_t checksum = 0;
+};
+static_assert(std::is_trivially_copyable_v<DiskRecord>);
+
+// FNV-1a (checksum フィールド直前まで)
+std::uint64_t checksumOf(const DiskRecord& r) noexcept
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&r);
+    std::uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < offsetof(DiskRecord, checksum); ++i)
+    {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+DiskRecord toDisk(const NoiseShaperStateJournal::Record& record) noexcept
+{
+    DiskRecord d;
+    std::memset(&d, 0, sizeof(d));
+    d.magic = kRecordMagic;
+    d.bankIndex = record.bankIndex;
+    d.state = record.state;
+    std::memcpy(d.coefficients, record.coefficients.data(), sizeof(d.coefficients));
+    d.checksum = checksumOf(d);
+    return d;
+}
+
+bool writeRecord(juce::OutputStream& out, const NoiseShaperStateJournal::Record& record)
+{
+    const DiskRecord d = toDisk(record);
+    return out.write(&d, sizeof(d));
+}
+
+} // namespace
+
+//==============================================================================
+NoiseShaperStateJournal& NoiseShaperStateJournal::getInstance()
+{
+    static NoiseShaperStateJournal instance;
+    return instance;
+}
+
+juce::File NoiseShaperStateJournal::getJournalFile()
+{
+    auto appDataDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                          .getChildFile("ConvoPeq");
+
+    if (!appDataDir.exists())
+    {
+        auto result = appDataDir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create settings directory");
+    }
+
+    return appDataDir.getChildFile("noise_shaper_state.journal");
+}
+
+NoiseShaperStateJournal::~NoiseShaperStateJournal()
+{
+    shutdown();
+}
+
+//==============================================================================
+// 投入 (Message Thread)
+//==============================================================================
+void NoiseShaperStateJournal::append(const Record& record)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopRequested)
+        return;
+
+    // 直近の Discard より後に同じバンクの未書き込みレコードがあれば置き換える (最新世代だけ書けばよい)
+    for (auto it = pending.rbegin(); it != pending.rend() && it->kind == OpKind::Append; ++it)
+    {
+        if (it->record.bankIndex == record.bankIndex)
+        {
+            it->record = record;
+            cv.notify_one();
+            return;
+        }
+    }
+
+    pending.push_back({ OpKind::Append, record });
+    ensureThreadLocked();
+    cv.notify_one();
+}
+
+void NoiseShaperStateJournal::requestCompaction()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopRequested)
+        return;
+    compactionRequested = true;
+    ensureThreadLocked();
+    cv.notify_one();
+}
+
+void NoiseShaperStateJournal::discardAll()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stopRequested)
+        return;
+    pending.clear();  // 未書き込み分も保存済みの状態に含まれている
+    pending.push_back({ OpKind::Discard, {} });
+    ensureThreadLocked();
+    cv.notify_one();
+}
+
+void NoiseShaperStateJournal::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    cv.notify_one();
+    if (writer.joinable())
+        writer.join();
+}
+
+void NoiseShaperStateJournal::ensureThreadLocked()
+{
+    if (!writer.joinable())
+        writer = std::thread([this] { writerLoop(); });
+}
+
+//==============================================================================
+// 書き込みスレッド
+//==============================================================================
+void NoiseShaperStateJournal::writerLoop()
+{
+    // 前回セッションの未保存レコードも圧縮対象に含める。末尾に壊れたレコードが残っていると
+    // その後ろへの追記が読めなくなるため、有効分だけに書き直してから追記を始める
+    const auto file = getJournalFile();
+    latestByBank = readLatest(file, &recordsSinceCompaction);
+    if (file.existsAsFile()
+        && file.getSize() != static_cast<juce::int64>(recordsSinceCompaction) * static_cast<juce::int64>(sizeof(DiskRecord)))
+        compact();
+
+    for (;;)
+    {
+        std::vector<Op> ops;
+        bool compactNow = false;
+        bool stopping = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return !pending.empty() || compactionRequested || stopRequested; });
+            ops.swap(pending);
+            compactNow = std::exchange(compactionRequested, false);
+            stopping = stopRequested;
+        }
+
+        if (!ops.empty())
+            writeRecords(ops);
+        if (compactNow || recordsSinceCompaction >= kCompactionRecords)
+            compact();
+
+        if (stopping)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pending.empty())
+                return;
+        }
+    }
+}
+
+void NoiseShaperStateJournal::writeRecords(const std::vector<Op>& ops)
+{
+    const auto file = getJournalFile();
+    std::unique_ptr<juce::FileOutputStream> out;
+
+    for (const auto& op : ops)
+    {
+        if (op.kind == OpKind::Discard)
+        {
+            out.reset();
+            latestByBank.clear();
+            recordsSinceCompaction = 0;
+            if (file.existsAsFile() && !file.deleteFile())
+                juce::Logger::writeToLog("Warning: Could not delete noise shaper journal");
+            continue;
+        }
+
+        if (out == nullptr)
+        {
+            out = std::make_unique<juce::FileOutputStream>(file);  // 既存ファイルの末尾から追記
+            if (out->failedToOpen())
+            {
+                juce::Logger::writeToLog("Warning: Could not open noise shaper journal");
+                return;
+            }
+        }
+
+        if (!writeRecord(*out, op.record))
+        {
+            juce::Logger::writeToLog("Warning: Could not append to noise shaper journal");
+            return;
+        }
+        latestByBank[op.record.bankIndex] = op.record;
+        ++recordsSinceCompaction;
+    }
+
+    // 1 バッチ (通常 1 世代) ごとにディスクへ落とす
+    if (out != nullptr)
+        out->flush();
+}
+
+void NoiseShaperStateJournal::compact()
+{
+    const auto file = getJournalFile();
+    if (latestByBank.empty())
+    {
+        file.deleteFile();
+        recordsSinceCompaction = 0;
+        return;
+    }
+
+    // 一時ファイルへ書いてから置き換える (途中で落ちても元のジャーナルは残る)
+    juce::TemporaryFile temp(file);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (out.failedToOpen())
+            return;
+        for (const auto& [bank, record] : latestByBank)
+            if (!writeRecord(out, record))
+                return;
+        out.flush();
+    }
+
+    if (temp.overwriteTargetFileWithTemporary())
+        recordsSinceCompaction = static_cast<int>(latestByBank.size());
+    else
+        juce::Logger::writeToLog("Warning: Could not compact noise shaper journal");
+}
+
+//==============================================================================
+// 読み込み
+//==============================================================================
+std::map<int, NoiseShaperStateJournal::Record> NoiseShaperStateJournal::readLatest(const juce::File& file,
+                                                                                   int* validRecordCount)
+{
+    std::map<int, Record> latest;
+    int count = 0;
+
+    juce::MemoryBlock data;
+    if (file.existsAsFile() && file.loadFileAsData(data))
+    {
+        const size_t numRecords = data.getSize() / sizeof(DiskRecord);
+        for (size_t i = 0; i < numRecords; ++i)
+        {
+            DiskRecord d;
+            std::memcpy(&d, static_cast<const char*>(data.getData()) + i * sizeof(DiskRecord), sizeof(d));
+            // 電源断で途中まで書かれたレコード以降は捨てる
+            if (d.magic != kRecordMagic || d.checksum != checksumOf(d) || d.bankIndex < 0)
+                break;
+
+            Record r;
+            r.bankIndex = d.bankIndex;
+            r.state = d.state;
+            std::memcpy(r.coefficients.data(), d.coefficients, sizeof(d.coefficients));
+            latest[r.bankIndex] = r;
+            ++count;
+        }
+    }
+
+    if (validRecordCount != nullptr)
+        *validRecordCount = count;
+    return latest;
+}
+
+void NoiseShaperStateJournal::replay(const std::function<void(const Record&)>& apply)
+{
+    for (const auto& [bank, record] : readLatest(getJournalFile(), nullptr))
+        apply(record);
+}
+
+} // namespace convo
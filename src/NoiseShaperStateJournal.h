@@ -0,0 +1,98 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "NoiseShaperLearnerTypes.h"
+
+namespace convo {
+
+/**
+    NoiseShaperStateJournal: 適応ノイズシェーパー学習状態の追記型チェックポイント。
+
+    学習の 1 世代ごとに「バンク番号 + NoiseShaperLearnerState + 係数」を 1 レコードとして
+    %APPDATA%/ConvoPeq/noise_shaper_state.journal へ追記する。書き込みは専用スレッドで行い、
+    呼び出し側はメモリ上のスナップショットを渡すだけ (ディスクを待たない)。
+    レコードは固定長 + チェックサム付きで、電源断で途中まで書かれた末尾レコードは読み込み時に捨てる。
+
+    - 圧縮: kCompactionRecords 件ごと (および requestCompaction) に、バンクごとの最新レコードだけを
+            一時ファイルへ書き直して置き換える
+    - 破棄: 全バンクを adaptive_banks.bin (AdaptiveBankStore) へ保存し終えたら discardAll で
+            それまでのレコードを捨てる (以後の追記分は残る)
+    - 復元: 起動時に replay でバンクごとの最新レコードを適用する (保存ファイルより新しい分のみ残っている)
+
+    スレッド:
+      append / requestCompaction / discardAll : Message Thread (キューへの投入のみ)
+      replay / shutdown                       : Message Thread (ファイル I/O を待つ。起動時・終了時のみ)
+*/
+class NoiseShaperStateJournal
+{
+public:
+    static constexpr int kCoeffCount = 9;
+
+    struct Record
+    {
+        int bankIndex = -1;
+        NoiseShaperLearnerState state {};
+        std::array<double, kCoeffCount> coefficients {};
+    };
+
+    static NoiseShaperStateJournal& getInstance();
+    static juce::File getJournalFile();
+
+    /** 1 世代分の状態を追記キューへ積む。同じバンクの未書き込みレコードは置き換える。 */
+    void append(const Record& record);
+
+    /** 次の書き込み機会にバンクごとの最新レコードだけへ書き直す。 */
+    void requestCompaction();
+
+    /** これまでに積んだレコードを全て捨てる (呼び出し時点の状態が他の保存ファイルへ書かれた後に呼ぶ)。 */
+    void discardAll();
+
+    /** ジャーナル内のバンクごとの最新レコードを bankIndex 昇順で渡す。書き込みスレッド起動前に呼ぶ。 */
+    static void replay(const std::function<void(const Record&)>& apply);
+
+    /** キューを書き切ってから書き込みスレッドを止める。 */
+    void shutdown();
+
+    ~NoiseShaperStateJournal();
+
+private:
+    NoiseShaperStateJournal() = default;
+
+    enum class OpKind { Append, Discard };
+    struct Op
+    {
+        OpKind kind = OpKind::Append;
+        Record record {};
+    };
+
+    void ensureThreadLocked();
+    void writerLoop();
+    void writeRecords(const std::vector<Op>& ops);
+    void compact();
+
+    static std::map<int, Record> readLatest(const juce::File& file, int* validRecordCount);
+
+    static constexpr int kCompactionRecords = 256;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Op> pending;             // mutex 保護
+    bool compactionRequested = false;    // mutex 保護
+    bool stopRequested = false;          // mutex 保護
+    std::thread writer;
+
+    // 以下は書き込みスレッド専用
+    std::map<int, Record> latestByBank;
+    int recordsSinceCompaction = 0;
+};
+
+} // namespace convo
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+// NoiseShaperWarmStart — 未学習バンクの CMA-ES 初期分布を近傍の学習済みバンクから選ぶ
+//
+//   バンク番号は AudioEngine::getAdaptiveCoeffBankIndex と同じ
+//     (sampleRateBank * kBitDepths + bitDepthIndex) * kModes + mode
+//   で並ぶ。距離は
+//     |log2(サンプルレート比)|  +  0.5 × ビット深度段差  +  (モードが違えば 0.25)
+//   とし、最も近い学習済みバンクを返す (同距離ならバンク番号が小さい方)。
+//   モードは学習予算の違いだけで目的関数は同じなので最も軽く、レートは
+//   シェイピングすべき帯域そのものが動くので最も重い。
+//
+//   係数そのものの周波数ワーピングは行わない。この格子は後方状態と係数の内積を
+//   帰還する構造で、全極格子のような PARCOR の閉形式ワーピングがないため。
+//   代わりに距離に応じて sigma を広げ、CMA-ES 自身に差分を探させる。
+//   JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+namespace convo::warmstart {
+
+inline constexpr int kSampleRateBanks = 10;
+inline constexpr int kBitDepths = 3;
+inline constexpr int kModes = 6;
+inline constexpr int kBankCount = kSampleRateBanks * kBitDepths * kModes;
+
+// これより遠いバンクは既定係数から始めるのと変わらないので使わない (1 オクターブ + 1 段程度)
+inline constexpr double kMaxDistance = 1.5;
+// 学習済みとみなす最小世代数
+inline constexpr int kMinConvergedGenerations = 20;
+// CmaEsOptimizer::initFromParcor と同じ既定 sigma。warm start はこれを超えない
+inline constexpr double kDefaultSigma = 0.12;
+
+struct BankKey
+{
+    int sampleRateBank = 0;
+    int bitDepthIndex = 0;
+    int mode = 0;
+};
+
+inline BankKey decomposeBankIndex(int bankIndex) noexcept
+{
+    const int clamped = std::clamp(bankIndex, 0, kBankCount - 1);
+    BankKey key;
+    key.mode = clamped % kModes;
+    key.bitDepthIndex = (clamped / kModes) % kBitDepths;
+    key.sampleRateBank = clamped / (kModes * kBitDepths);
+    return key;
+}
+
+// bankSampleRatesHz: kSampleRateBanks 個のバンク中心レート
+inline double bankDistance(const BankKey& a, const BankKey& b, const double* bankSampleRatesHz) noexcept
+{
+    const double rateA = bankSampleRatesHz[a.sampleRateBank];
+    const double rateB = bankSampleRatesHz[b.sampleRateBank];
+    const double rateTerm = (rateA > 0.0 && rateB > 0.0) ? std::abs(std::log2(rateA / rateB)) : kMaxDistance;
+    const double bitDepthTerm = 0.5 * static_cast<double>(std::abs(a.bitDepthIndex - b.bitDepthIndex));
+    const double modeTerm = (a.mode != b.mode) ? 0.25 : 0.0;
+    return rateTerm + bitDepthTerm + modeTerm;
+}
+
+struct Choice
+{
+    int bankIndex = -1;         // -1 = 近傍なし (既定係数から始める)
+    double distance = 0.0;
+    bool sameSampleRate = false; // 同じレートなら共分散の形もそのまま使える
+};
+
+// isConverged(bankIndex) -> bool。targetBank 自身は候補にしない
+template <typename IsConverged>
+Choice selectSourceBank(int targetBank, const double* bankSampleRatesHz, IsConverged&& isConverged)
+{
+    const BankKey target = decomposeBankIndex(targetBank);
+    Choice best;
+    double bestDistance = kMaxDistance;
+    for (int bank = 0; bank < kBankCount; ++bank)
+    {
+        if (bank == targetBank)
+            continue;
+
+        const BankKey candidate = decomposeBankIndex(bank);
+        const double distance = bankDistance(target, candidate, bankSampleRatesHz);
+        if (distance > bestDistance || (best.bankIndex >= 0 && distance == bestDistance))
+            continue;
+        if (!isConverged(bank))
+            continue;
+
+        best.bankIndex = bank;
+        best.distance = distance;
+        best.sameSampleRate = (candidate.sampleRateBank == target.sampleRateBank);
+        bestDistance = distance;
+    }
+    return best;
+}
+
+// 収束済みの小さな sigma を距離に応じて広げる。最小 0.03 (CmaEsOptimizer::Params::sigmaMin)。
+// sourceSigma の有限性は呼び出し側で確認済みであること (/fp:fast では isfinite が当てにならない)
+inline double warmStartSigma(double sourceSigma, double distance) noexcept
+{
+    const double base = std::max(sourceSigma, 0.03);
+    return std::min(kDefaultSigma, base + 0.06 * std::max(0.0, distance));
+}
+
+} // namespace convo::warmstart
@@ -0,0 +1,328 @@
+#include "NucLayoutWisdom.h"
+
+#include <JuceHeader.h>
+#include <mkl.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "AlignedAllocation.h"
+
+namespace convo {
+
+// ═══════════════════════════════════════════════════════════════
+//  インスタンス / パス解決
+// ═══════════════════════════════════════════════════════════════
+
+NucLayoutWisdom& NucLayoutWisdom::getInstance()
+{
+    static NucLayoutWisdom instance;
+    return instance;
+}
+
+juce::File NucLayoutWisdom::getWisdomFile()
+{
+    auto appDataDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                          .getChildFile("ConvoPeq");
+
+    if (!appDataDir.exists())
+    {
+        auto result = appDataDir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create settings directory");
+    }
+
+    return appDataDir.getChildFile("nuc_layout_wisdom.xml");
+}
+
+NucLayoutWisdom::Key NucLayoutWisdom::makeKey(int blockSize, int irLength, const FilterSpec& spec) noexcept
+{
+    Key key;
+    key.blockSize = std::max(1, blockSize);
+    key.irLengthBucket = juce::nextPowerOfTwo(std::max(1, irLength));
+    key.sampleRate = static_cast<int>(std::lround(spec.sampleRate));
+    key.tailMode = juce::jlimit(0, 2, spec.tailMode);
+    key.tailWorkerOffload = spec.tailWorkerOffload;
+    key.compactTailSpectra = spec.compactTailSpectra;
+    return key;
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  参照
+// ═══════════════════════════════════════════════════════════════
+
+void NucLayoutWisdom::preload() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+}
+
+std::optional<NucLayoutWisdom::Entry> NucLayoutWisdom::lookup(const Key& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    for (const auto& e : entries)
+        if (e.key == key)
+            return e;
+    return std::nullopt;
+}
+
+std::vector<NucLayoutWisdom::Entry> NucLayoutWisdom::getEntries() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureLoadedLocked();
+    return entries;
+}
+
+void NucLayoutWisdom::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    loaded = true;
+    getWisdomFile().deleteFile();
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  計測
+// ═══════════════════════════════════════════════════════════════
+
+NucLayoutWisdom::Measurement NucLayoutWisdom::measureLayout(const Key& key, const FilterSpec& spec,
+                                                            const std::vector<double>& impulse)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Measurement m;
+    auto nuc = convo::aligned_make_unique<MKLNonUniformConvolver>();
+    if (!nuc->SetImpulse(impulse.data(), static_cast<int>(impulse.size()), key.blockSize, 1.0, false, &spec))
+        return m;
+
+    m.latency = nuc->getLatency();
+
+    std::vector<double> input(static_cast<size_t>(key.blockSize));
+    std::vector<double> output(static_cast<size_t>(key.blockSize));
+    std::mt19937 rng(0x5EED);
+    std::uniform_real_distribution<double> dist(-0.5, 0.5);
+
+    // L2 の 1 パーティション周期を 2 回以上含めて分散処理の偏りも平均に入れる
+    const int l0Part = juce::nextPowerOfTwo(std::max(key.blockSize, 64));
+    const int mult = MKLNonUniformConvolver::resolveTailL1L2Multiplier(&spec);
+    const int64_t cycleSamples = static_cast<int64_t>(l0Part) * mult * mult * 2;
+    const int numBlocks = static_cast<int>(std::max<int64_t>(256, cycleSamples / key.blockSize));
+    const int warmupBlocks = std::max(16, numBlocks / 8);
+
+    auto runBlock = [&]() noexcept
+    {
+        for (auto& s : input)
+            s = dist(rng);
+        nuc->Add(input.data(), key.blockSize);
+        nuc->Get(output.data(), key.blockSize);
+    };
+
+    for (int i = 0; i < warmupBlocks; ++i)
+        runBlock();
+
+    double totalMicros = 0.0;
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        const auto start = Clock::now();
+        runBlock();
+        const double micros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        totalMicros += micros;
+        m.worstMicros = std::max(m.worstMicros, micros);
+    }
+
+    m.meanMicros = totalMicros / static_cast<double>(numBlocks);
+    m.ok = true;
+    return m;
+}
+
+std::optional<NucLayoutWisdom::Entry> NucLayoutWisdom::calibrate(const Key& key, const FilterSpec& baseSpec)
+{
+    std::lock_guard<std::mutex> calibrationLock(calibrationMutex);
+    if (auto known = lookup(key))
+        return known;
+
+    // Audio Thread と同条件 (FTZ/DAZ, MKL 1 スレッド) で計測する
+    juce::ScopedNoDenormals noDenormals;
+    const int prevMklThreads = mkl_set_num_threads_local(1);
+
+    // 合成 IR: IR 長バケット全体で -60 dB まで指数減衰するノイズ
+    std::vector<double> impulse(static_cast<size_t>(key.irLengthBucket));
+    {
+        std::mt19937 rng(0x1A5EED);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        const double decayPerSample = std::log(1.0e-3) / static_cast<double>(impulse.size());
+        for (size_t i = 0; i < impulse.size(); ++i)
+            impulse[i] = dist(rng) * std::exp(decayPerSample * static_cast<double>(i));
+    }
+
+    FilterSpec spec = baseSpec;
+    spec.partitionCullFloorDb = FilterSpec::kPartitionCullDisabledDb;  // 構成比較のため間引きなし
+    spec.partitionCullLength = 0;
+
+    const Measurement baseline = measureLayout(key, spec, impulse);
+    if (!baseline.ok)
+    {
+        mkl_set_num_threads_local(prevMklThreads);
+        return std::nullopt;
+    }
+
+    const double budgetMicros = 1.0e6 * static_cast<double>(key.blockSize) / static_cast<double>(std::max(1, key.sampleRate));
+    const int baselineMult = MKLNonUniformConvolver::resolveTailL1L2Multiplier(&spec);
+
+    Entry best;
+    best.key = key;
+    best.multiplier = baselineMult;
+    best.meanMicrosPerBlock = baseline.meanMicros;
+    best.worstMicrosPerBlock = baseline.worstMicros;
+
+    best.spectrumLayout = baseSpec.spectrumLayout;
+    bool bestInBudget = baseline.worstMicros <= budgetMicros;
+
+    // 予算内を優先し、同条件なら予算内は平均、予算外は最悪値で比べる
+    auto isBetter = [&](const Measurement& m) noexcept
+    {
+        const bool inBudget = m.worstMicros <= budgetMicros;
+        return (inBudget && !bestInBudget)
+            || (inBudget == bestInBudget
+                && (inBudget ? m.meanMicros < best.meanMicrosPerBlock
+                             : m.worstMicros < best.worstMicrosPerBlock));
+    };
+    auto adopt = [&](const Measurement& m) noexcept
+    {
+        best.meanMicrosPerBlock = m.meanMicros;
+        best.worstMicrosPerBlock = m.worstMicros;
+        bestInBudget = m.worstMicros <= budgetMicros;
+    };
+
+    std::vector<int> tried { baselineMult };
+    for (const int candidate : kCandidateMultipliers)
+    {
+        spec.tailL1L2Multiplier = candidate;
+        const int effective = MKLNonUniformConvolver::resolveTailL1L2Multiplier(&spec);
+        if (std::find(tried.begin(), tried.end(), effective) != tried.end())
+            continue;  // tailMode 下限で同一構成になる候補は計測しない
+        tried.push_back(effective);
+
+        const Measurement m = measureLayout(key, spec, impulse);
+        if (!m.ok || m.latency > baseline.latency)
+            continue;
+
+        if (isBetter(m))
+        {
+            best.multiplier = effective;
+            adopt(m);
+        }
+    }
+
+    // ★ Bin-major FDL: 倍率を決めた後、同じ構成で固定配置と自動選択を比べる
+    if (baseSpec.spectrumLayout == FilterSpec::SpectrumLayout::Auto)
+    {
+        spec.tailL1L2Multiplier = best.multiplier;
+        for (const auto layout : { FilterSpec::SpectrumLayout::PartitionMajor, FilterSpec::SpectrumLayout::BinMajor })
+        {
+            spec.spectrumLayout = layout;
+            const Measurement m = measureLayout(key, spec, impulse);
+            if (m.ok && m.latency <= baseline.latency && isBetter(m))
+            {
+                best.spectrumLayout = layout;
+                adopt(m);
+            }
+        }
+    }
+
+    mkl_set_num_threads_local(prevMklThreads);
+
+    juce::Logger::writeToLog("NucLayoutWisdom: block=" + juce::String(key.blockSize)
+                             + " ir=" + juce::String(key.irLengthBucket)
+                             + " sr=" + juce::String(key.sampleRate)
+                             + " -> multiplier " + juce::String(best.multiplier)
+                             + " layout " + juce::String(static_cast<int>(best.spectrumLayout))
+                             + " (" + juce::String(best.meanMicrosPerBlock, 1) + " us/block)");
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ensureLoadedLocked();
+        entries.push_back(best);
+        saveLocked();
+    }
+    return best;
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  永続化
+// ═══════════════════════════════════════════════════════════════
+
+namespace {
+
+juce::String currentCpuSignature()
+{
+    return juce::SystemStats::getCpuModel() + "/" + juce::String(juce::SystemStats::getNumCpus());
+}
+
+} // namespace
+
+void NucLayoutWisdom::ensureLoadedLocked() const
+{
+    if (loaded)
+        return;
+    loaded = true;
+    entries.clear();
+
+    const auto file = getWisdomFile();
+    if (!file.existsAsFile())
+        return;
+
+    auto root = juce::XmlDocument::parse(file);
+    if (root == nullptr || !root->hasTagName("NucLayoutWisdom"))
+        return;
+    if (root->getIntAttribute("version", 0) != kVersion)
+        return;
+    if (root->getStringAttribute("cpu") != currentCpuSignature())
+        return;  // CPU が変わった → 再計測
+
+    for (auto* e : root->getChildWithTagNameIterator("Entry"))
+    {
+        Entry entry;
+        entry.key.blockSize = e->getIntAttribute("blockSize", 0);
+        entry.key.irLengthBucket = e->getIntAttribute("irLengthBucket", 0);
+        entry.key.sampleRate = e->getIntAttribute("sampleRate", 0);
+        entry.key.tailMode = e->getIntAttribute("tailMode", 1);
+        entry.key.tailWorkerOffload = e->getBoolAttribute("tailWorkerOffload", false);
+        entry.key.compactTailSpectra = e->getBoolAttribute("compactTailSpectra", false);
+        entry.multiplier = juce::jlimit(2, 16, e->getIntAttribute("multiplier", 8));
+        entry.spectrumLayout = static_cast<FilterSpec::SpectrumLayout>(juce::jlimit(0, 2, e->getIntAttribute("spectrumLayout", 0)));
+        entry.meanMicrosPerBlock = e->getDoubleAttribute("meanMicrosPerBlock", 0.0);
+        entry.worstMicrosPerBlock = e->getDoubleAttribute("worstMicrosPerBlock", 0.0);
+        if (entry.key.blockSize > 0 && entry.key.irLengthBucket > 0 && entry.key.sampleRate > 0)
+            entries.push_back(entry);
+    }
+}
+
+void NucLayoutWisdom::saveLocked() const
+{
+    juce::XmlElement root("NucLayoutWisdom");
+    root.setAttribute("version", kVersion);
+    root.setAttribute("cpu", currentCpuSignature());
+
+    for (const auto& entry : entries)
+    {
+        auto* e = root.createNewChildElement("Entry");
+        e->setAttribute("blockSize", entry.key.blockSize);
+        e->setAttribute("irLengthBucket", entry.key.irLengthBucket);
+        e->setAttribute("sampleRate", entry.key.sampleRate);
+        e->setAttribute("tailMode", entry.key.tailMode);
+        e->setAttribute("tailWorkerOffload", entry.key.tailWorkerOffload);
+        e->setAttribute("compactTailSpectra", entry.key.compactTailSpectra);
+        e->setAttribute("multiplier", entry.multiplier);
+        e->setAttribute("spectrumLayout", static_cast<int>(entry.spectrumLayout));
+        e->setAttribute("meanMicrosPerBlock", entry.meanMicrosPerBlock);
+        e->setAttribute("worstMicrosPerBlock", entry.worstMicrosPerBlock);
+    }
+
+    if (!root.writeTo(getWisdomFile()))
+        juce::Logger::writeToLog("Warning: Could not write NUC layout wisdom file");
+}
+
+} // namespace convo
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "MKLNonUniformConvolver.h"
+
+namespace convo {
+
+/**
+    NucLayoutWisdom: NUC レイヤー構成 (L1/L2 partition 倍率とスペクトル配置) の実測チューニング結果 ("wisdom")。
+
+    最適な L0/L1/L2 分割は CPU のキャッシュ容量と FFT スループットに強く依存するため、
+    (ブロックサイズ, IR 長バケット, サンプルレート, tail 構成) ごとに候補倍率を一度だけ実測し、
+    最速の構成を %APPDATA%/ConvoPeq/nuc_layout_wisdom.xml (device_settings.xml と同じディレクトリ) に保存する。
+    保存時の CPU モデルと現在の CPU モデルが異なる場合は wisdom 全体を破棄して再計測する。
+
+    スレッド:
+      lookup    : 任意の Non-RT スレッド (mutex)
+      calibrate : Loader Thread 専用 (候補ごとに NUC を構築・実行するため数百 ms ブロックする)
+*/
+class NucLayoutWisdom
+{
+public:
+    struct Key
+    {
+        int  blockSize = 0;        ///< SetImpulse に渡すブロックサイズ
+        int  irLengthBucket = 0;   ///< IR 長 (nextPowerOfTwo に丸める)
+        int  sampleRate = 0;       ///< Hz (整数丸め)
+        int  tailMode = 1;         ///< FilterSpec::tailMode
+        bool tailWorkerOffload = false;
+        bool compactTailSpectra = false;
+
+        [[nodiscard]] bool operator==(const Key& other) const noexcept
+        {
+            return blockSize == other.blockSize && irLengthBucket == other.irLengthBucket
+                && sampleRate == other.sampleRate && tailMode == other.tailMode
+                && tailWorkerOffload == other.tailWorkerOffload && compactTailSpectra == other.compactTailSpectra;
+        }
+    };
+
+    struct Entry
+    {
+        Key    key;
+        int    multiplier = 8;          ///< 計測で選ばれた tailL1L2Multiplier
+        FilterSpec::SpectrumLayout spectrumLayout = FilterSpec::SpectrumLayout::Auto; ///< 同倍率で最速だった配置
+        double meanMicrosPerBlock = 0.0; ///< 選ばれた構成の 1 コールバック平均処理時間 (us)
+        double worstMicrosPerBlock = 0.0; ///< 同 最悪値 (us)
+    };
+
+    static NucLayoutWisdom& getInstance();
+    static juce::File getWisdomFile();
+
+    [[nodiscard]] static Key makeKey(int blockSize, int irLength, const FilterSpec& spec) noexcept;
+
+    /** 計測済みならその結果を返す。未計測なら std::nullopt。 */
+    [[nodiscard]] std::optional<Entry> lookup(const Key& key) const;
+
+    /**
+        未計測の key について候補倍率を実測し、結果を記録・保存して返す (計測済みなら即座に返す)。
+        baseSpec の tailL1L2Multiplier をベースライン構成とし、
+          - レイテンシ (getLatency) がベースラインを超えない
+          - 最悪コールバック処理時間がブロック周期 (blockSize / sampleRate) に収まる
+        候補の中で平均処理時間が最小のものを選ぶ。予算内の候補が無ければ最悪値が最小の候補を選ぶ。
+        baseSpec の spectrumLayout が Auto なら、選んだ倍率でパーティション優先 / ビン優先の固定配置も
+        同じ規則で比較する (どちらも勝たなければ Auto のまま)。
+        NUC 構築に失敗した場合は std::nullopt (記録しない)。
+    */
+    std::optional<Entry> calibrate(const Key& key, const FilterSpec& baseSpec);
+
+    [[nodiscard]] std::vector<Entry> getEntries() const;
+    void clear();
+
+    /** 起動時のウォームアップ (StartupWarmup) 用。wisdom ファイルを先に読んでおき、最初の lookup の XML 解析を省く。 */
+    void preload() const;
+
+private:
+    NucLayoutWisdom() = default;
+
+    struct Measurement
+    {
+        bool   ok = false;
+        int    latency = 0;
+        double meanMicros = 0.0;
+        double worstMicros = 0.0;
+    };
+
+    static Measurement measureLayout(const Key& key, const FilterSpec& spec, const std::vector<double>& impulse);
+
+    void ensureLoadedLocked() const;
+    void saveLocked() const;
+
+    static constexpr int kVersion = 2;  // 2: spectrumLayout を追加 (旧 wisdom は再計測)
+    static constexpr int kCandidateMultipliers[] = { 4, 6, 8, 12, 16 };
+
+    mutable std::mutex mutex;
+    mutable std::vector<Entry> entries;
+    mutable bool loaded = false;
+    std::mutex calibrationMutex;  // 同一 key の二重計測を避けるため計測を直列化する
+};
+
+} // namespace convo
@@ -0,0 +1,294 @@
+#include "OfflineBatchRenderer.h"
+
+#include "AudioEngine.h"
+#include "OfflineRenderer.h"
+#include "audioengine/AtomicAccess.h"
+#include "core/ThreadAffinityManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+//==============================================================================
+// Worker: 1 本が 1 つの OfflineRuntime を専有し、共有カウンタから次のジョブを取る
+//==============================================================================
+class OfflineBatchRenderer::Worker : public juce::Thread
+{
+public:
+    Worker(OfflineBatchRenderer& ownerRef, int index)
+        : juce::Thread("OfflineBatchWorker" + juce::String(index)),
+          owner(ownerRef),
+          workerIndex(index)
+    {
+        formats.registerBasicFormats();
+    }
+
+    ~Worker() override
+    {
+        stopThread(10000);
+    }
+
+    void run() override
+    {
+        owner.engine.getAffinityManager().applyCurrentThreadPolicy(ThreadType::OfflineRender, workerIndex);
+
+        // 固定したコアの上で確保する (DSPCore の可変バッファがこのワーカーのノードに載る)
+        const auto runtime = owner.engine.createOfflineRuntime();
+        if (runtime == nullptr)
+        {
+            juce::Logger::writeToLog("[OfflineRenderBatch] Worker " + juce::String(workerIndex)
+                                     + " could not create a runtime; leaving its jobs to the other workers");
+            return;
+        }
+
+        while (!threadShouldExit())
+        {
+            // relaxed: ジョブ番号の払い出しのみ (jobs は起動前に確定済み、結果は run() の join で HB)
+            const size_t index = convo::fetchAddAtomic(owner.nextJob, 1, std::memory_order_relaxed);
+            if (index >= owner.jobs.size())
+                break;
+            renderJob(owner.jobs[index], *runtime);
+        }
+    }
+
+private:
+    void renderJob(Job& job, AudioEngine::OfflineRuntime& runtime)
+    {
+        job.workerIndex = workerIndex;
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(job.inputFile));
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->numChannels <= 0)
+        {
+            juce::Logger::writeToLog("[OfflineRenderBatch] Unreadable input: " + job.inputFile.getFullPathName());
+            return;
+        }
+
+        // ランタイムはバッチ共通のレートで組んであるため、レート変換はしない
+        if (std::abs(reader->sampleRate - runtime.getSampleRate()) > 1.0e-6)
+        {
+            juce::Logger::writeToLog("[OfflineRenderBatch] Sample rate mismatch: " + job.inputFile.getFullPathName()
+                                     + " sr=" + juce::String(reader->sampleRate)
+                                     + " batchSr=" + juce::String(runtime.getSampleRate()));
+            return;
+        }
+
+        const auto writer = OfflineRenderer::createWriter(formats, job.outputFile, owner.sampleRateHz, owner.bitsPerSample);
+        if (writer == nullptr)
+        {
+            juce::Logger::writeToLog("[OfflineRenderBatch] Cannot create output: " + job.outputFile.getFullPathName());
+            return;
+        }
+
+        // 前のファイルの残響・ディザ状態を持ち越さない
+        runtime.reset();
+        job.inputSamples = reader->lengthInSamples;
+
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+        job.succeeded = OfflineRenderer::renderStream(*reader, *writer, runtime.getBlockSize(), runtime.getLatencySamples(), *this,
+                                                      [&runtime](juce::AudioBuffer<double>& block) { runtime.process(block); });
+        job.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+        if (!job.succeeded && !threadShouldExit())
+            juce::Logger::writeToLog("[OfflineRenderBatch] Write failed: " + job.outputFile.getFullPathName());
+    }
+
+    OfflineBatchRenderer& owner;
+    const int workerIndex;
+    juce::AudioFormatManager formats;
+};
+
+//==============================================================================
+OfflineBatchRenderer::OfflineBatchRenderer(AudioEngine& engineRef, Options renderOptions, FinishedCallback finishedCallback)
+    : juce::Thread("OfflineBatchRenderer"),
+      engine(engineRef),
+      options(std::move(renderOptions)),
+      onFinished(std::move(finishedCallback))
+{
+}
+
+OfflineBatchRenderer::~OfflineBatchRenderer()
+{
+    cancel();
+    stopThread(20000);
+}
+
+void OfflineBatchRenderer::cancel()
+{
+    signalThreadShouldExit();
+}
+
+bool OfflineBatchRenderer::parseListFile()
+{
+    if (!options.listFile.existsAsFile())
+    {
+        juce::Logger::writeToLog("[OfflineRenderBatch] List file not found: " + options.listFile.getFullPathName());
+        return false;
+    }
+
+    const auto baseDirectory = options.listFile.getParentDirectory();
+    juce::StringArray lines;
+    options.listFile.readLines(lines);
+
+    jobs.clear();
+    for (const auto& rawLine : lines)
+    {
+        const auto line = rawLine.trim();
+        if (line.isEmpty() || line.startsWithChar('#'))
+            continue;
+
+        Job job;
+        const auto inputPath = line.upToFirstOccurrenceOf("\t", false, false).trim().unquoted();
+        const auto outputPath = line.fromFirstOccurrenceOf("\t", false, false).trim().unquoted();
+        job.inputFile = baseDirectory.getChildFile(inputPath);
+        job.outputFile = outputPath.isNotEmpty()
+            ? baseDirectory.getChildFile(outputPath)
+            : job.inputFile.getSiblingFile(job.inputFile.getFileNameWithoutExtension() + "_rendered.wav");
+        jobs.push_back(std::move(job));
+    }
+
+    if (jobs.empty())
+    {
+        juce::Logger::writeToLog("[OfflineRenderBatch] No jobs in " + options.listFile.getFullPathName());
+        return false;
+    }
+    return true;
+}
+
+bool OfflineBatchRenderer::prepare()
+{
+    if (!parseListFile())
+        return false;
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    for (const auto& job : jobs)
+    {
+        if (formats.findFormatForFileExtension(job.outputFile.getFileExtension()) == nullptr)
+        {
+            juce::Logger::writeToLog("[OfflineRenderBatch] Unsupported output format: " + job.outputFile.getFullPathName());
+            return false;
+        }
+    }
+
+    // バッチのレートは先頭の入力で決める (異なるレートの入力はそのジョブだけ失敗にする)
+    const std::unique_ptr<juce::AudioFormatReader> firstReader(formats.createReaderFor(jobs.front().inputFile));
+    if (firstReader == nullptr || firstReader->sampleRate <= 0.0)
+    {
+        juce::Logger::writeToLog("[OfflineRenderBatch] Unreadable input: " + jobs.front().inputFile.getFullPathName());
+        return false;
+    }
+
+    options.blockSize = juce::jlimit(16, 16384, options.blockSize);
+    sampleRateHz = firstReader->sampleRate;
+    // 出力はエンジンのディザ後の値なので、同じビット深度で書けば再量子化しない
+    bitsPerSample = (options.bitDepth > 0) ? options.bitDepth : engine.getDitherBitDepth();
+
+    // デバイスは外してあるので整数デバイス向けの出力スケーリングは使わない
+    engine.setDeviceIntegerOutputBits(0);
+    engine.prepareToPlay(options.blockSize, sampleRateHz);
+
+    juce::Logger::writeToLog("[OfflineRenderBatch] Prepared: list=" + options.listFile.getFullPathName()
+                             + " jobs=" + juce::String(static_cast<int>(jobs.size()))
+                             + " sr=" + juce::String(sampleRateHz)
+                             + " block=" + juce::String(options.blockSize)
+                             + " workers=" + juce::String(resolveWorkerCount()));
+    return true;
+}
+
+int OfflineBatchRenderer::resolveWorkerCount() const
+{
+    int count = options.numWorkers;
+    if (count <= 0)
+    {
+        // 1 ワーカー 1 物理コア。アフィニティ無効 (P/E 混在等) なら OS の物理コア数
+        count = engine.getAffinityManager().getOfflineRenderCoreCount();
+        if (count <= 0)
+            count = juce::SystemStats::getNumPhysicalCpus();
+    }
+    return juce::jlimit(1, juce::jmax(1, static_cast<int>(jobs.size())), count);
+}
+
+void OfflineBatchRenderer::run()
+{
+    bool succeeded = false;
+    const double settleSeconds = OfflineRenderer::waitForSettledRuntime(engine, *this, options.blockSize, options.settleTimeoutSeconds);
+    if (settleSeconds >= 0.0)
+    {
+        const int numWorkers = resolveWorkerCount();
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        workers.reserve(static_cast<size_t>(numWorkers));
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>(*this, i));
+            workers.back()->startThread(juce::Thread::Priority::high);
+        }
+
+        for (auto& worker : workers)
+        {
+            while (!worker->waitForThreadToExit(50))
+            {
+                if (threadShouldExit())
+                    for (auto& other : workers)
+                        other->signalThreadShouldExit();
+            }
+        }
+        workers.clear();
+
+        const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+        succeeded = !threadShouldExit()
+                 && std::all_of(jobs.begin(), jobs.end(), [](const Job& job) { return job.succeeded; });
+        reportStats(settleSeconds, wallSeconds, numWorkers);
+    }
+
+    juce::MessageManager::callAsync([callback = onFinished, succeeded]
+    {
+        if (callback)
+            callback(succeeded);
+    });
+}
+
+void OfflineBatchRenderer::reportStats(double settleSeconds, double wallSeconds, int numWorkers) const
+{
+    const auto emit = [](const juce::String& line)
+    {
+        juce::Logger::writeToLog(line);
+        std::fputs((line + "\n").toRawUTF8(), stdout);
+    };
+
+    int succeededJobs = 0;
+    juce::int64 totalInputSamples = 0;
+    for (const auto& job : jobs)
+    {
+        if (!job.succeeded)
+        {
+            emit("[OfflineRenderBatch] Failed: in=" + job.inputFile.getFullPathName()
+                 + " worker=" + juce::String(job.workerIndex));
+            continue;
+        }
+
+        ++succeededJobs;
+        totalInputSamples += job.inputSamples;
+        const double inputSeconds = static_cast<double>(job.inputSamples) / sampleRateHz;
+        emit("[OfflineRenderBatch] File: out=" + job.outputFile.getFullPathName()
+             + " worker=" + juce::String(job.workerIndex)
+             + " inputSec=" + juce::String(inputSeconds, 3)
+             + " renderSec=" + juce::String(job.renderSeconds, 3)
+             + " realtimeFactor=" + juce::String((job.renderSeconds > 0.0) ? inputSeconds / job.renderSeconds : 0.0, 2));
+    }
+
+    // 全体の実時間比は壁時計基準 (ワーカー起動・ランタイム構築を含む)
+    const double totalInputSeconds = static_cast<double>(totalInputSamples) / sampleRateHz;
+    emit("[OfflineRenderBatch] Finished: files=" + juce::String(static_cast<int>(jobs.size()))
+         + " succeeded=" + juce::String(succeededJobs)
+         + " failed=" + juce::String(static_cast<int>(jobs.size()) - succeededJobs)
+         + " workers=" + juce::String(numWorkers)
+         + " sr=" + juce::String(sampleRateHz)
+         + " block=" + juce::String(options.blockSize)
+         + " inputSec=" + juce::String(totalInputSeconds, 3)
+         + " settleSec=" + juce::String(settleSeconds, 3)
+         + " wallSec=" + juce::String(wallSeconds, 3)
+         + " realtimeFactor=" + juce::String((wallSeconds > 0.0) ? totalInputSeconds / wallSeconds : 0.0, 2));
+    std::fflush(stdout);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <JuceHeader.h>
+
+class AudioEngine;
+
+/**
+    OfflineBatchRenderer: リストファイルの音声ファイル群を複数コアで並列に AudioEngine へ通して書き出すスレッド。
+
+    --cli-render-batch <listfile> から起動する。リストファイルは 1 行 1 ジョブで
+    "入力<TAB>出力"、または "入力" のみ (出力は入力と同じフォルダの <名前>_rendered.wav)。
+    空行と # で始まる行は無視し、相対パスはリストファイルのフォルダ基準で解決する。
+
+    - prepare() (Message Thread) でリストを読み、エンジンを先頭の入力のサンプルレートで prepare する。
+      サンプルレートが異なる入力は変換せずに失敗として報告する
+    - run() は OfflineRenderer と同じ手順で isRuntimeSettled() を待ち、その後ワーカーを起動する
+    - ワーカーは 1 本ごとに AudioEngine::createOfflineRuntime() の独立した DSPCore を専有し、
+      共有カウンタから次のファイルを取る。IR スペクトルは公開中の Convolver と共有する
+    - ワーカーは ThreadType::OfflineRender で物理コアへ 1 本ずつ固定し、DSPCore を
+      そのスレッド上で確保する (確保したメモリがワーカーのコアに近いノードへ載る)
+    - ファイルの区切りで DSPCore をリセットするため、出力はワーカーの割り当てに依らない
+    - ファイルごとと全体の実時間比 (入力の長さの合計 / 壁時計時間) をログと標準出力へ出す
+*/
+class OfflineBatchRenderer : public juce::Thread
+{
+public:
+    struct Options
+    {
+        juce::File listFile;
+        int blockSize = 512;
+        int bitDepth = 0;                       // 0 = エンジンのディザのビット深度 (16 / 24 / 32)
+        int numWorkers = 0;                     // 0 = 物理コア数 (ジョブ数が少なければジョブ数)
+        double settleTimeoutSeconds = 60.0;     // IR 読み込みを含めて待つ上限
+    };
+
+    // Message Thread で呼ばれる。succeeded = すべてのファイルを書き終えた
+    using FinishedCallback = std::function<void(bool succeeded)>;
+
+    OfflineBatchRenderer(AudioEngine& engine, Options options, FinishedCallback onFinished);
+    ~OfflineBatchRenderer() override;
+
+    // Message Thread 専用。デバイスのコールバックを外した後に呼ぶこと。
+    // リストを読み、エンジンを (blockSize, 先頭の入力のサンプルレート) で prepare する
+    bool prepare();
+
+    void run() override;
+    void cancel();
+
+private:
+    struct Job
+    {
+        juce::File inputFile;
+        juce::File outputFile;
+        juce::int64 inputSamples = 0;
+        double renderSeconds = 0.0;
+        int workerIndex = -1;
+        bool succeeded = false;
+    };
+
+    class Worker;
+
+    bool parseListFile();
+    int resolveWorkerCount() const;
+    void reportStats(double settleSeconds, double wallSeconds, int numWorkers) const;
+
+    AudioEngine& engine;
+    Options options;
+    FinishedCallback onFinished;
+    std::vector<Job> jobs;
+    std::atomic<size_t> nextJob { 0 };
+    double sampleRateHz = 0.0;
+    int bitsPerSample = 24;
+};
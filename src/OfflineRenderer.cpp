@@ -0,0 +1,239 @@
+#include "OfflineRenderer.h"
+
+#include "AudioEngine.h"
+
+#include <algorithm>
+#include <cstdio>
+
+OfflineRenderer::OfflineRenderer(AudioEngine& engineRef, Options renderOptions, FinishedCallback finishedCallback)
+    : juce::Thread("OfflineRenderer"),
+      engine(engineRef),
+      options(std::move(renderOptions)),
+      onFinished(std::move(finishedCallback))
+{
+    formatManager.registerBasicFormats();
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    cancel();
+    stopThread(10000);
+}
+
+void OfflineRenderer::cancel()
+{
+    signalThreadShouldExit();
+}
+
+bool OfflineRenderer::prepare()
+{
+    reader.reset(formatManager.createReaderFor(options.inputFile));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0 || reader->numChannels <= 0)
+    {
+        juce::Logger::writeToLog("[OfflineRender] Unreadable input: " + options.inputFile.getFullPathName());
+        reader.reset();
+        return false;
+    }
+
+    if (formatManager.findFormatForFileExtension(options.outputFile.getFileExtension()) == nullptr)
+    {
+        juce::Logger::writeToLog("[OfflineRender] Unsupported output format: " + options.outputFile.getFullPathName());
+        reader.reset();
+        return false;
+    }
+
+    options.blockSize = juce::jlimit(16, 16384, options.blockSize);
+    sampleRateHz = reader->sampleRate;
+
+    // デバイスは外してあるので整数デバイス向けの出力スケーリングは使わない
+    engine.setDeviceIntegerOutputBits(0);
+    engine.prepareToPlay(options.blockSize, sampleRateHz);
+
+    juce::Logger::writeToLog("[OfflineRender] Prepared: in=" + options.inputFile.getFullPathName()
+                             + " sr=" + juce::String(sampleRateHz)
+                             + " channels=" + juce::String(static_cast<int>(reader->numChannels))
+                             + " samples=" + juce::String(reader->lengthInSamples)
+                             + " block=" + juce::String(options.blockSize));
+    return true;
+}
+
+void OfflineRenderer::run()
+{
+    bool succeeded = false;
+    if (reader != nullptr)
+    {
+        RenderStats stats;
+        stats.settleSeconds = waitForSettledRuntime(engine, *this, options.blockSize, options.settleTimeoutSeconds);
+        succeeded = stats.settleSeconds >= 0.0 && render(stats);
+        if (succeeded)
+            reportStats(stats);
+    }
+
+    juce::MessageManager::callAsync([callback = onFinished, succeeded]
+    {
+        if (callback)
+            callback(succeeded);
+    });
+}
+
+double OfflineRenderer::waitForSettledRuntime(AudioEngine& targetEngine, juce::Thread& thread, int blockSize, double timeoutSeconds)
+{
+    juce::AudioBuffer<double> scratch(2, blockSize);
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    double settledSince = -1.0;
+
+    while (!thread.threadShouldExit())
+    {
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        if ((now - startTime) / 1000.0 > timeoutSeconds)
+        {
+            juce::Logger::writeToLog("[OfflineRender] Runtime did not settle within "
+                                     + juce::String(timeoutSeconds, 1) + " s");
+            return -1.0;
+        }
+
+        // クロスフェードの進行と退役は Audio Thread 側で進むため、待機中も無音を流し続ける (出力は捨てる)
+        scratch.clear();
+        targetEngine.processBlockDouble(scratch);
+
+        if (targetEngine.isRuntimeSettled())
+        {
+            if (settledSince < 0.0)
+                settledSince = now;
+            if ((now - settledSince) / 1000.0 >= kSettleHoldSeconds)
+                return (now - startTime) / 1000.0;
+        }
+        else
+        {
+            settledSince = -1.0;
+        }
+
+        // IR 読み込み・リビルドのスレッドに CPU を譲る
+        thread.wait(1);
+    }
+
+    return -1.0;
+}
+
+bool OfflineRenderer::render(RenderStats& stats)
+{
+    // 出力はエンジンのディザ後の値なので、同じビット深度で書けば再量子化しない
+    const int bitsPerSample = (options.bitDepth > 0) ? options.bitDepth : engine.getDitherBitDepth();
+    const auto writer = createWriter(formatManager, options.outputFile, sampleRateHz, bitsPerSample);
+    if (writer == nullptr)
+    {
+        juce::Logger::writeToLog("[OfflineRender] Cannot create output: " + options.outputFile.getFullPathName());
+        return false;
+    }
+
+    stats.inputSamples = reader->lengthInSamples;
+    stats.latencySamples = juce::jmax(0, engine.getTotalLatencySamples());
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    const bool completed = renderStream(*reader, *writer, options.blockSize, stats.latencySamples, *this,
+                                        [this](juce::AudioBuffer<double>& block) { engine.processBlockDouble(block); });
+    stats.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    if (!completed && !threadShouldExit())
+        juce::Logger::writeToLog("[OfflineRender] Write failed: " + options.outputFile.getFullPathName());
+    return completed;
+}
+
+bool OfflineRenderer::renderStream(juce::AudioFormatReader& source,
+                                   juce::AudioFormatWriter& destination,
+                                   int blockSize,
+                                   int latencySamples,
+                                   juce::Thread& thread,
+                                   const std::function<void(juce::AudioBuffer<double>&)>& processBlock)
+{
+    // 入力 + レイテンシぶんを処理し、先頭のレイテンシを捨てて入力と同じ長さだけ書く
+    const juce::int64 inputSamples = source.lengthInSamples;
+    const juce::int64 samplesToProcess = inputSamples + latencySamples;
+    juce::AudioBuffer<float> io(2, blockSize);
+    juce::AudioBuffer<double> scratch(2, blockSize);
+    juce::int64 processed = 0;
+    juce::int64 written = 0;
+
+    while (processed < samplesToProcess)
+    {
+        if (thread.threadShouldExit())
+            return false;
+
+        io.clear();
+        const int samplesToRead = static_cast<int>(juce::jlimit<juce::int64>(0, blockSize, inputSamples - processed));
+        if (samplesToRead > 0)
+        {
+            source.read(&io, 0, samplesToRead, processed, true, true);
+            if (source.numChannels == 1)
+                io.copyFrom(1, 0, io, 0, 0, samplesToRead);
+        }
+
+        // 末尾の押し出しも含めて常に blockSize で回す (prepare したブロック長のまま)
+        scratch.makeCopyOf(io, true);
+        processBlock(scratch);
+        io.makeCopyOf(scratch, true);
+
+        const int skip = static_cast<int>(juce::jlimit<juce::int64>(0, blockSize, latencySamples - processed));
+        const int samplesToWrite = static_cast<int>(std::min<juce::int64>(blockSize - skip, inputSamples - written));
+        if (samplesToWrite > 0)
+        {
+            if (!destination.writeFromAudioSampleBuffer(io, skip, samplesToWrite))
+                return false;
+            written += samplesToWrite;
+        }
+        processed += blockSize;
+    }
+
+    return written == inputSamples;
+}
+
+std::unique_ptr<juce::AudioFormatWriter> OfflineRenderer::createWriter(const juce::AudioFormatManager& formats,
+                                                                       const juce::File& outputFile,
+                                                                       double outputSampleRateHz,
+                                                                       int bitsPerSample)
+{
+    auto* format = formats.findFormatForFileExtension(outputFile.getFileExtension());
+    if (format == nullptr)
+        return nullptr;
+
+    const auto possibleBitDepths = format->getPossibleBitDepths();
+    if (!possibleBitDepths.contains(bitsPerSample))
+    {
+        const int fallbackBits = possibleBitDepths.contains(24) ? 24 : possibleBitDepths.getLast();
+        juce::Logger::writeToLog("[OfflineRender] " + format->getFormatName() + " cannot store "
+                                 + juce::String(bitsPerSample) + " bit; writing " + juce::String(fallbackBits) + " bit");
+        bitsPerSample = fallbackBits;
+    }
+
+    outputFile.deleteFile();
+    auto fileStream = std::make_unique<juce::FileOutputStream>(outputFile);
+    if (!fileStream->openedOk())
+        return nullptr;
+
+    std::unique_ptr<juce::OutputStream> stream = std::move(fileStream);
+    const auto writerOptions = juce::AudioFormatWriterOptions{}
+        .withSampleRate(outputSampleRateHz)
+        .withNumChannels(2)
+        .withBitsPerSample(bitsPerSample)
+        .withSampleFormat(bitsPerSample == 32 ? juce::AudioFormatWriterOptions::SampleFormat::floatingPoint
+                                              : juce::AudioFormatWriterOptions::SampleFormat::automatic);
+    return format->createWriterFor(stream, writerOptions);
+}
+
+void OfflineRenderer::reportStats(const RenderStats& stats) const
+{
+    const double inputSeconds = static_cast<double>(stats.inputSamples) / sampleRateHz;
+    const double realtimeFactor = (stats.renderSeconds > 0.0) ? inputSeconds / stats.renderSeconds : 0.0;
+    const auto line = "[OfflineRender] Finished: out=" + options.outputFile.getFullPathName()
+                    + " sr=" + juce::String(sampleRateHz)
+                    + " block=" + juce::String(options.blockSize)
+                    + " latencySamples=" + juce::String(stats.latencySamples)
+                    + " inputSec=" + juce::String(inputSeconds, 3)
+                    + " settleSec=" + juce::String(stats.settleSeconds, 3)
+                    + " renderSec=" + juce::String(stats.renderSeconds, 3)
+                    + " realtimeFactor=" + juce::String(realtimeFactor, 2);
+
+    juce::Logger::writeToLog(line);
+    std::fputs((line + "\n").toRawUTF8(), stdout);
+    std::fflush(stdout);
+}
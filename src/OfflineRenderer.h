@@ -0,0 +1,90 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <JuceHeader.h>
+
+class AudioEngine;
+
+/**
+    OfflineRenderer: 音声ファイルを AudioEngine に通して別ファイルへ書き出すスレッド (実時間より速い)。
+
+    --cli-render <in> <out> から起動する。MainWindow がデバイスのコールバックを外した後、
+    prepare() (Message Thread) で入力を開いてエンジンを入力のサンプルレートで prepare し、
+    run() が Audio Thread の代わりに AudioEngine::processBlockDouble をデバイス待ち無しで回す。
+    設定 (settings XML) と IR は通常起動と同じものがそのまま使われる。
+
+    - 開始前に無音を流して isRuntimeSettled() が kSettleHoldSeconds 続くまで待つ
+      (IR 読み込み・リビルド・DSP 交換のクロスフェードを出力へ混ぜないため)
+    - 出力は getTotalLatencySamples() ぶん先頭を捨て、末尾を無音で押し出して入力と同じ長さに揃える
+    - 出力は常にステレオ (モノラル入力は複製)。形式は出力ファイルの拡張子、ビット深度は
+      Options::bitDepth (0 ならエンジンのディザのビット深度)
+    - 実時間比 (入力の長さ / 処理の壁時計時間) をログと標準出力へ出す
+*/
+class OfflineRenderer : public juce::Thread
+{
+public:
+    struct Options
+    {
+        juce::File inputFile;
+        juce::File outputFile;
+        int blockSize = 512;
+        int bitDepth = 0;                       // 0 = エンジンのディザのビット深度 (16 / 24 / 32)
+        double settleTimeoutSeconds = 60.0;     // IR 読み込みを含めて待つ上限
+    };
+
+    // 無音の pre-roll 中、この時間 settled が続いたら本処理へ進む
+    // (--cli-ir の遅延読み込みが始まる前に settled と判定しないため)
+    static constexpr double kSettleHoldSeconds = 0.5;
+
+    // Message Thread で呼ばれる。succeeded = 入力を最後まで処理して出力を書き終えた
+    using FinishedCallback = std::function<void(bool succeeded)>;
+
+    OfflineRenderer(AudioEngine& engine, Options options, FinishedCallback onFinished);
+    ~OfflineRenderer() override;
+
+    // Message Thread 専用。デバイスのコールバックを外した後に呼ぶこと。
+    // 入力を開き、エンジンを (blockSize, 入力のサンプルレート) で prepare する
+    bool prepare();
+
+    void run() override;
+    void cancel();
+
+    // OfflineBatchRenderer と共用する手順 (どちらも呼び出し元のレンダースレッドで使う)
+    // デバイスの代わりに無音を流し、isRuntimeSettled() が kSettleHoldSeconds 続くまで待つ。
+    // 戻り値: 待った秒数。タイムアウト・中断なら負
+    static double waitForSettledRuntime(AudioEngine& targetEngine, juce::Thread& thread, int blockSize, double timeoutSeconds);
+    // source を blockSize ずつ processBlock (2ch) に通し、先頭の latencySamples を捨てて source と同じ長さだけ書く。
+    // モノラル入力は両チャンネルへ複製する。false = 書き込み失敗または thread の中断
+    static bool renderStream(juce::AudioFormatReader& source,
+                             juce::AudioFormatWriter& destination,
+                             int blockSize,
+                             int latencySamples,
+                             juce::Thread& thread,
+                             const std::function<void(juce::AudioBuffer<double>&)>& processBlock);
+    // 出力ファイルを作り直して writer を返す。bitsPerSample を形式が持てなければ 24 (無ければ最後の候補) で書く
+    static std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::AudioFormatManager& formats,
+                                                                 const juce::File& outputFile,
+                                                                 double outputSampleRateHz,
+                                                                 int bitsPerSample);
+
+private:
+    struct RenderStats
+    {
+        juce::int64 inputSamples = 0;
+        int latencySamples = 0;
+        double settleSeconds = 0.0;
+        double renderSeconds = 0.0;
+    };
+
+    bool render(RenderStats& stats);
+    void reportStats(const RenderStats& stats) const;
+
+    AudioEngine& engine;
+    Options options;
+    FinishedCallback onFinished;
+    juce::AudioFormatManager formatManager;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    double sampleRateHz = 0.0;
+};
@@ -20,12 +20,19 @@
 //   - process()   : Audio Thread から呼ぶ (libm呼び出しなし・メモリ確保なし)
 //   - reset()     : Audio Thread から呼ぶ (フィルター状態クリア)
 //   - 全モード分の係数を prepare() で事前計算し、process() はテーブル参照のみ
+//
+// ■ 演算:
+//   どちらの系統も 3 段の TDF-II カスケード。ステレオは dsp/BiquadCascade.h で
+//   L/R を __m128d の 2 レーンに載せて回す (デノーマルフラッシュはブロック末尾のみ)。
+//   状態・係数は [stage][channel] の SoA で持ち、係数は L/R 複製済みの形で prepare() に作る。
 //============================================================================
 
 #include <JuceHeader.h>
 #include <cmath>
 #include <array>
+#include <limits>
 #include "DspNumericPolicy.h"
+#include "dsp/BiquadCascade.h"
 
 namespace convo {
 
@@ -44,30 +51,6 @@ struct BiquadCoeff
     double a1 = 0.0, a2 = 0.0;
 };
 
-//──────────────────────────────────────────────────────────────────────────
-// Biquad 状態変数 (チャンネル/ステージごとに保持)
-//──────────────────────────────────────────────────────────────────────────
-struct BiquadState
-{
-    double w1 = 0.0, w2 = 0.0;
-
-    void reset() noexcept { w1 = w2 = 0.0; }
-
-    // Audio Thread 安全: libm 呼び出しなし
-    // FTZ/DAZ フラグがスレッドに設定済みであることを前提とするが、
-    // 念のため閾値判定によるデノーマル対策も行う
-    inline double process(double x, const BiquadCoeff& c) noexcept
-    {
-        const double y = c.b0 * x + w1;
-        w1 = c.b1 * x - c.a1 * y + w2;
-        w2 = c.b2 * x - c.a2 * y;
-        // デノーマル対策
-        w1 = killDenormal(w1);
-        w2 = killDenormal(w2);
-        return y;
-    }
-};
-
 //──────────────────────────────────────────────────────────────────────────
 // ハイカット / EQ ローパスフィルターモード
 // ① ハイカット と ② EQ ローパスの両方で使用
@@ -127,31 +110,33 @@ public:
                  LCMode lcMode,
                  HCMode lpMode) noexcept;
 
+    //------------------------------------------------------------------
+    // getRingOutSamples() ── Audio Thread 安全
+    // 無音入力で全モードの状態が無音閾値未満へ減衰するまでのサンプル数 (prepare() で算出)
+    // DSPCore の無音スキップ (audioengine/ChainSilenceTracker.h) が参照する
+    //------------------------------------------------------------------
+    int getRingOutSamples() const noexcept { return ringOutSamples; }
+
 private:
     //──── 事前計算済み係数 (prepare()で設定、process()で参照) ────────
 
-    // ① ハイカット: 3モード × 2カスケード段
-    // Sharp  : Butterworth 4次 (Q1=0.5412, Q2=1.3066 を各段に設定)
-    // Natural: Linkwitz-Riley 4次 (Q=0.7071 を両段に設定)
-    // Soft   : 2次 Q=0.5 (stage[1]=identity)
-    BiquadCoeff hcCoeff[3][2]; // [HCMode][stage 0/1]
+    // ① コンボルバー最終段: [HCMode][LCMode] ごとに LC → HC0 → HC1 の 3 段
+    // ハイカット Sharp  : Butterworth 4次 (Q1=0.5412, Q2=1.3066 を各段に設定)
+    //            Natural: Linkwitz-Riley 4次 (Q=0.7071 を両段に設定)
+    //            Soft   : 2次 Q=0.5 (HC1=identity)
+    // ローカット: 単一2次HPF (Natural 18Hz / Soft 15Hz)
+    dsp::StereoBiquadCascade3Coeffs convCascade[3][2];
 
-    // ① ローカット: 2モード × 1段 (単一2次HPF)
-    BiquadCoeff lcCoeff[2];    // [LCMode]
+    // ② EQ最終段: [HCMode] ごとに HPF (固定 Butterworth 2次, 20Hz) → LP0 → LP1 の 3 段
+    dsp::StereoBiquadCascade3Coeffs eqCascade[3];
 
-    // ② ハイパス: 固定 (Butterworth 2次, 20Hz)
-    BiquadCoeff hpfCoeff;
+    //──── フィルター状態変数 (系統ごとに [stage][ch]) ─────────────────
+    // MAX_CHANNELS=2 (ステレオ固定)。モノラルは ch 0 を使う
 
-    // ② ローパス: 3モード × 2カスケード段
-    BiquadCoeff lpCoeff[3][2]; // [HCMode][stage 0/1]
+    dsp::StereoBiquadCascade3State convState; // ① LC → HC0 → HC1
+    dsp::StereoBiquadCascade3State eqState;   // ② HPF → LP0 → LP1
 
-    //──── フィルター状態変数 (チャンネル/ステージごと) ────────────────
-    // MAX_CHANNELS=2 (ステレオ固定)
-
-    BiquadState hcState[2][2]; // [ch][stage]  ① ハイカット
-    BiquadState lcState[2];    // [ch]          ① ローカット
-    BiquadState hpfState[2];   // [ch]          ② ハイパス
-    BiquadState lpState[2][2]; // [ch][stage]  ② ローパス
+    int ringOutSamples = std::numeric_limits<int>::max(); // prepare() 前はスキップさせない
 
     //──── 係数計算ヘルパー (Message Thread 専用、std::sin/cos 使用) ──
 
@@ -165,6 +150,10 @@ private:
     // 恒等変換係数 (b0=1, 他=0)
     static BiquadCoeff makeIdentity() noexcept;
 
+    // 3 段分の係数を L/R 複製済みの SoA テーブルへ詰める
+    static void setCascade(dsp::StereoBiquadCascade3Coeffs& dst,
+                           const BiquadCoeff& s0, const BiquadCoeff& s1, const BiquadCoeff& s2) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE(OutputFilter)
 };
 
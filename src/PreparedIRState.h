@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <juce_core/juce_core.h>
 
@@ -9,7 +10,9 @@
 
 struct PreparedIRState
 {
-    double* partitionData = nullptr;
+    double* partitionData = nullptr;           // 所有データ (aligned_free で解放)
+    const double* partitionView = nullptr;     // ★ v3 キャッシュ: mmap 上の読み取り専用ビュー (partitionData と排他)
+    std::shared_ptr<const juce::MemoryMappedFile> mappedStorage; // partitionView の寿命を保持
     size_t partitionSizeBytes = 0;
     int numPartitions = 0;
     int fftSize = 0;
@@ -23,11 +26,17 @@ struct PreparedIRState
     bool hasScaleFactor = false;
     float additionalAttenuationDb = 0.0f;  // ★ v14.0: IRConverter clamp による追加減衰量 [dB]
     float irFreqPeakGainDb = 0.0f;         // ★ v14.2: IRAnalyzer による周波数ピークゲイン [dB]
+    // ★ Streaming activation: IR 先頭のみを変換した暫定ペイロード (キャッシュへ保存しない)。
+    //   headEnergyRatio = 先頭区間のエネルギー / エンジンが使う区間全体のエネルギー (通常ペイロードは 1)
+    bool streamingHead = false;
+    double headEnergyRatio = 1.0;
 
     PreparedIRState() = default;
 
     PreparedIRState(PreparedIRState&& other) noexcept
         : partitionData(other.partitionData),
+          partitionView(other.partitionView),
+          mappedStorage(std::move(other.mappedStorage)),
           partitionSizeBytes(other.partitionSizeBytes),
           numPartitions(other.numPartitions),
           fftSize(other.fftSize),
@@ -40,9 +49,12 @@ struct PreparedIRState
                     scaleFactor(other.scaleFactor),
                     hasScaleFactor(other.hasScaleFactor),
                     additionalAttenuationDb(other.additionalAttenuationDb),
-                    irFreqPeakGainDb(other.irFreqPeakGainDb)
+                    irFreqPeakGainDb(other.irFreqPeakGainDb),
+                    streamingHead(other.streamingHead),
+                    headEnergyRatio(other.headEnergyRatio)
     {
         other.partitionData = nullptr;
+        other.partitionView = nullptr;
         other.partitionSizeBytes = 0;
                 other.scaleFactor = 1.0;
                 other.hasScaleFactor = false;
@@ -58,6 +70,8 @@ struct PreparedIRState
                 convo::aligned_free(partitionData);
 
             partitionData = other.partitionData;
+            partitionView = other.partitionView;
+            mappedStorage = std::move(other.mappedStorage);
             partitionSizeBytes = other.partitionSizeBytes;
             numPartitions = other.numPartitions;
             fftSize = other.fftSize;
@@ -71,8 +85,11 @@ struct PreparedIRState
             hasScaleFactor = other.hasScaleFactor;
             additionalAttenuationDb = other.additionalAttenuationDb;
             irFreqPeakGainDb = other.irFreqPeakGainDb;
+            streamingHead = other.streamingHead;
+            headEnergyRatio = other.headEnergyRatio;
 
             other.partitionData = nullptr;
+            other.partitionView = nullptr;
             other.partitionSizeBytes = 0;
             other.scaleFactor = 1.0;
             other.hasScaleFactor = false;
@@ -89,6 +106,32 @@ struct PreparedIRState
             convo::aligned_free(partitionData);
     }
 
+    // 読み取り用: 所有データまたは mmap ビューのどちらか
+    const double* getPartitionData() const noexcept
+    {
+        return (partitionData != nullptr) ? partitionData : partitionView;
+    }
+
+    bool isMappedView() const noexcept { return partitionData == nullptr && partitionView != nullptr; }
+
+    // 書き込みが必要な場合のみ mmap ビューを aligned メモリへ複製する (copy-on-write)。
+    // 成功後は mappedStorage を手放す。失敗時は false (ビューはそのまま)。
+    bool materializePartitionData() noexcept
+    {
+        if (!isMappedView())
+            return partitionData != nullptr;
+
+        auto* copied = static_cast<double*>(convo::aligned_malloc_nothrow(partitionSizeBytes, 64));
+        if (copied == nullptr)
+            return false;
+
+        std::memcpy(copied, partitionView, partitionSizeBytes);
+        partitionData = copied;
+        partitionView = nullptr;
+        mappedStorage.reset();
+        return true;
+    }
+
     PreparedIRState(const PreparedIRState&) = delete;
     PreparedIRState& operator=(const PreparedIRState&) = delete;
 };
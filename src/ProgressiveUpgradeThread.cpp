@@ -5,6 +5,7 @@
 #include "CacheManager.h"
 #include "PreparedIRState.h"
 #include "core/ThreadAffinityManager.h"
+#include "core/ScopedMXCSR.h"
 
 #include <cmath>
 #include <xmmintrin.h>   // _MM_SET_FLUSH_ZERO_MODE
@@ -22,7 +23,9 @@ ProgressiveUpgradeThread::ProgressiveUpgradeThread(ConvolverProcessor& p,
                                                    uint64_t key,
                                                    IRConverter& conv,
                                                    CacheManager& cache,
-                                                   ThreadAffinityManager* affinityMgr)
+                                                   ThreadAffinityManager* affinityMgr,
+                                                   convo::BackgroundScheduler* sched,
+                                                   bool completeHead)
     : juce::Thread("ConvolverProgressiveUpgrade"),
       processor(p),
       irFile(file),
@@ -30,12 +33,16 @@ ProgressiveUpgradeThread::ProgressiveUpgradeThread(ConvolverProcessor& p,
             currentFFTSize(currentFft),
             targetFFTSize(targetFft),
             phaseMode(phase),
+      completeStreamingHead(completeHead),
       taskGeneration(baseGeneration),
             baseCacheKey(key),
       converter(conv),
     cacheManager(cache),
-    affinityManager(affinityMgr)
+    affinityManager(affinityMgr),
+    scheduler(sched)
 {
+        if (completeStreamingHead)
+                upgradeSteps.push_back(currentFFTSize);
         static constexpr int kStepTable[] = { 1024, 2048, 4096 };
         for (int step : kStepTable)
         {
@@ -84,24 +91,102 @@ void ProgressiveUpgradeThread::run()
     // JUCE のクロスプラットフォーム優先度設定
     setPriority(Priority::low);
 
-    if (checkAndCancel())
+    if (checkAndCancel() || upgradeSteps.empty())
         return;
 
-    for (int step : upgradeSteps)
+    // ★ 並列アップグレード: 各ステップは IR ファイルから独立に変換されるため、
+    //   AudioEngine の共有スケジューラ (Upgrade クラス) で同時に計算し、キャッシュ保存と publish はこのスレッドが昇順に行う。
+    //   同時実行数はスケジューラが決め、IR 読み込みや rebuild が進行中の間は取り出されない。
+    std::vector<std::unique_ptr<StepResult>> results;
+    results.reserve(upgradeSteps.size());
+    for (size_t i = 0; i < upgradeSteps.size(); ++i)
+        results.push_back(std::make_unique<StepResult>());
+    std::vector<convo::BackgroundScheduler::TaskHandle> handles(upgradeSteps.size());
+
+    // results と this を参照するタスクが残らないよう、戻る前に必ず全ハンドルの終了を待つ
+    const auto drainSteps = [this, &handles](bool cancelPending)
     {
-        if (!isGenerationValid())
-            return;
+        if (cancelPending)
+        {
+            convo::publishAtomic(cancelled, true, std::memory_order_release); // release: 実行中の変換の shouldCancel (acquire) へ
+            for (auto& handle : handles)
+                handle.cancel();
+        }
+        for (auto& handle : handles)
+            while (!handle.wait(std::chrono::milliseconds(2000))) {}
+    };
+
+    // FFT サイズが大きいステップほど時間がかかるため最終ステップから投入する (完了までの最長経路を短縮)。
+    // Streaming activation の全長変換だけは先頭で投入する (鳴っている先頭だけの IR を最短で置き換える)
+    std::vector<size_t> submitOrder;
+    submitOrder.reserve(upgradeSteps.size());
+    if (completeStreamingHead)
+        submitOrder.push_back(0);
+    for (size_t i = upgradeSteps.size(); i-- > (completeStreamingHead ? 1u : 0u);)
+        submitOrder.push_back(i);
+
+    if (scheduler != nullptr)
+    {
+        for (const size_t i : submitOrder)
+        {
+            StepResult* slot = results[i].get();
+            const int step = upgradeSteps[i];
+            handles[i] = scheduler->submit(convo::BackgroundPriority::Upgrade,
+                                           [this, slot, step](const convo::BackgroundScheduler::CancelToken& token)
+            {
+                // ★ Bug#4: 共有ワーカー — RAII で保存＋復元 (アフィニティはスケジューラが起動時に設定済み)
+                const convo::cpu::ScopedMXCSR mxcsr;
+
+                if (!token.isCancelled() && isGenerationValid())
+                    slot->prepared = prepareStep(step, slot->loadedFromCache, slot->buildMs, &token);
+
+                convo::publishAtomic(slot->finished, true, std::memory_order_release); // release: prepared/loadedFromCache を run 側の acquire へ公開
+                stepFinished.signal();
+            });
+        }
+    }
+
+    for (size_t i = 0; i < upgradeSteps.size(); ++i)
+    {
+        StepResult& slot = *results[i];
+
+        if (!handles[i])
+        {
+            // 投入できなかった (スケジューラ無し・停止中) ステップはこのスレッドで変換する
+            if (isGenerationValid())
+                slot.prepared = prepareStep(upgradeSteps[i], slot.loadedFromCache, slot.buildMs, nullptr);
+        }
+        else
+        {
+            while (!convo::consumeAtomic(slot.finished, std::memory_order_acquire)) // acquire: ワーカーの release と HB
+            {
+                // 新しい世代が現れたら実行中の変換も shouldCancel 経由で打ち切られる。
+                // スケジューラ停止で未開始のまま終わったタスクは finished を立てないため、ハンドル側の終了も見る
+                if (checkAndCancel() || threadShouldExit() || handles[i].isFinished())
+                {
+                    if (convo::consumeAtomic(slot.finished, std::memory_order_acquire)) // acquire: ワーカーの release と HB
+                        break;
+                    drainSteps(true);
+                    return;
+                }
+                stepFinished.wait(50);
+            }
+        }
 
-        if (!upgradeStep(step))
+        if (!publishStep(upgradeSteps[i], std::move(slot.prepared), slot.loadedFromCache, slot.buildMs))
+        {
+            // 従来どおり失敗したステップ以降は行わない (未完了の変換を打ち切る)
+            drainSteps(true);
             return;
+        }
     }
+
+    drainSteps(false);
 }
 
-bool ProgressiveUpgradeThread::upgradeStep(int nextFFTSize)
+std::unique_ptr<PreparedIRState> ProgressiveUpgradeThread::prepareStep(int nextFFTSize, bool& loadedFromCache, double& buildMs,
+                                                                       const convo::BackgroundScheduler::CancelToken* token)
 {
-    if (!isGenerationValid())
-        return false;
-
     const uint64_t stepKey = CacheManager::computeKey(irFile,
                                                       nextFFTSize,
                                                       sampleRate,
@@ -109,48 +194,61 @@ bool ProgressiveUpgradeThread::upgradeStep(int nextFFTSize)
                                                       nextFFTSize);
 
     auto prepared = cacheManager.loadPreparedState(stepKey, nextFFTSize, taskGeneration);
-    if (!prepared)
-    {
-        juce::WeakReference<ConvolverProcessor> weakOwner(&processor);
-        // cancelled へのローカル参照。convertToHighRes は同期的に実行されるため、
-        // upgradeStep のスタックフレーム生存期間内で完結する。
-        // cancel() が他スレッドから cancelled を true に設定すると、
-        // ラムダ内の cancelledRef がそれを観測し、早期復帰する。
-        std::atomic<bool>& cancelledRef = cancelled;
-        const uint64_t expectedGeneration = taskGeneration;
+    loadedFromCache = (prepared != nullptr);
+    if (prepared)
+        return prepared;
 
-        prepared = converter.convertToHighRes(irFile,
-                                              sampleRate,
-                                              nextFFTSize,
-                                              taskGeneration,
-                                              stepKey,
-                                              [weakOwner, &cancelledRef, expectedGeneration]()
-                                              {
-                                                  auto* owner = weakOwner.get();
-                                                  if (owner == nullptr)
-                                                      return true;
-
-                                                  return juce::Thread::currentThreadShouldExit()
-                                                      || convo::consumeAtomic(cancelledRef, std::memory_order_acquire)
-                                                      || !owner->isConvolverGenerationCurrent(expectedGeneration);
-                                              });
-        if (!prepared)
-            return false;
+    juce::WeakReference<ConvolverProcessor> weakOwner(&processor);
+    // cancelled へのローカル参照。convertToHighRes は同期的に実行されるため、
+    // prepareStep のスタックフレーム生存期間内で完結する。
+    // cancel() や run() が cancelled を true に設定すると、
+    // ラムダ内の cancelledRef がそれを観測し、早期復帰する。
+    std::atomic<bool>& cancelledRef = cancelled;
+    const uint64_t expectedGeneration = taskGeneration;
 
-        if (!isGenerationValid())
-            return false;
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    auto converted = converter.convertToHighRes(irFile,
+                                                sampleRate,
+                                                nextFFTSize,
+                                                taskGeneration,
+                                                stepKey,
+                                                [weakOwner, &cancelledRef, expectedGeneration, token]()
+                                                {
+                                                    auto* owner = weakOwner.get();
+                                                    if (owner == nullptr)
+                                                        return true;
+
+                                                    return juce::Thread::currentThreadShouldExit()
+                                                        || (token != nullptr && token->isCancelled())
+                                                        || convo::consumeAtomic(cancelledRef, std::memory_order_acquire)
+                                                        || !owner->isConvolverGenerationCurrent(expectedGeneration);
+                                                });
+    buildMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    return converted;
+}
 
-        cacheManager.save(stepKey, nextFFTSize, *prepared);
+bool ProgressiveUpgradeThread::publishStep(int nextFFTSize, std::unique_ptr<PreparedIRState> prepared, bool loadedFromCache, double buildMs)
+{
+    if (!prepared || !isGenerationValid())
+        return false;
+
+    if (!loadedFromCache)
+    {
+        const uint64_t stepKey = CacheManager::computeKey(irFile,
+                                                          nextFFTSize,
+                                                          sampleRate,
+                                                          phaseMode,
+                                                          nextFFTSize);
+        cacheManager.save(stepKey, nextFFTSize, *prepared, buildMs);
         cacheManager.evictLRU(processor.getMaxCacheEntries());
     }
 
-    if (prepared)
-        prepared->originalFileName = irFile.getFileNameWithoutExtension();
+    prepared->originalFileName = irFile.getFileNameWithoutExtension();
 
     if (!isGenerationValid())
         return false;
 
-    if (prepared && prepared->timeDomainIR)
+    if (prepared->timeDomainIR)
     {
         double peak = 0.0;
         const int channels = prepared->timeDomainIR->getNumChannels();
@@ -178,8 +276,10 @@ bool ProgressiveUpgradeThread::upgradeStep(int nextFFTSize)
     // 中間ステップの engine swap は音切れ・CPU スパイクの原因となるため、
     // 最終 FFT サイズ到達時のみ publish する。
     // 中間ステップの結果はキャッシュに保存済みなので処理は無駄にならない。
+    // 先頭だけの IR を置き換える全長変換 (Streaming activation) は中間でも publish する。
     const bool isFinalStep = (nextFFTSize >= targetFFTSize);
-    if (isFinalStep)
+    const bool completesHead = completeStreamingHead && nextFFTSize == currentFFTSize;
+    if (isFinalStep || completesHead)
     {
         juce::WeakReference<ConvolverProcessor> weakProcessor(&processor);
         const uint64_t expectedGeneration = taskGeneration;
@@ -6,7 +6,10 @@
 
 #include <JuceHeader.h>
 
+#include "core/BackgroundScheduler.h"
+
 class ConvolverProcessor;
+struct PreparedIRState;
 class IRConverter;
 class CacheManager;
 class ThreadAffinityManager;
@@ -24,17 +27,32 @@ public:
                              uint64_t baseCacheKey,
                              IRConverter& converter,
                              CacheManager& cacheManager,
-                             ThreadAffinityManager* affinityManager);
+                             ThreadAffinityManager* affinityManager,
+                             convo::BackgroundScheduler* scheduler,
+                             bool completeStreamingHead = false);
 
     ~ProgressiveUpgradeThread() override;
 
     void run() override;
     void cancel();
+    [[nodiscard]] bool isCompletingStreamingHead() const noexcept { return completeStreamingHead; }
 
 private:
+    // ★ 並列アップグレード: 各ステップの変換結果 (スケジューラのワーカーが書き、finished を release で公開)
+    struct StepResult
+    {
+        std::unique_ptr<PreparedIRState> prepared;
+        bool loadedFromCache = false;
+        double buildMs = 0.0;  // 変換に要した時間 (キャッシュのコスト重み付き退避用)
+        std::atomic<bool> finished { false };
+    };
+
     bool isGenerationValid() const;
     bool checkAndCancel();
-    bool upgradeStep(int nextFFTSize);
+    // token は共有スケジューラ上で実行するときのみ非 null (stop / cancel も変換の打ち切り条件に加える)
+    std::unique_ptr<PreparedIRState> prepareStep(int nextFFTSize, bool& loadedFromCache, double& buildMs,
+                                                 const convo::BackgroundScheduler::CancelToken* token);
+    bool publishStep(int nextFFTSize, std::unique_ptr<PreparedIRState> prepared, bool loadedFromCache, double buildMs);
 
     ConvolverProcessor& processor;
     juce::File irFile;
@@ -42,12 +60,15 @@ private:
     int currentFFTSize = 0;
     int targetFFTSize = 0;
     int phaseMode = 0;
+    bool completeStreamingHead = false;   // 先頭だけの IR が鳴っている: currentFFTSize の全長変換を最初に行い publish する
     uint64_t taskGeneration = 0;
     [[maybe_unused]] uint64_t baseCacheKey = 0;
     std::vector<int> upgradeSteps;
     std::atomic<bool> cancelled{false};
+    juce::WaitableEvent stepFinished;   // ワーカー完了通知 (run は順番待ちでこれを待つ)
 
     IRConverter& converter;
     CacheManager& cacheManager;
     ThreadAffinityManager* affinityManager = nullptr;
+    convo::BackgroundScheduler* scheduler = nullptr;   // null または停止中ならステップをこのスレッドで順に変換する
 };
@@ -28,6 +28,8 @@
 
 #include "audioengine/AtomicAccess.h"
 #include "DspNumericPolicy.h"
+#include "dsp/DitherNoisePool.h"
+#include "dsp/StereoLaneNoiseShaper.h"
 
 namespace convo
 {
@@ -278,6 +280,13 @@ public:
             juce::FloatVectorOperations::clear(shaperStateBuffer, MAX_CHANNELS * STATE_STRIDE);
     }
 
+    // ★ DSPCore 所有の共用ディザプール (dsp/DitherNoisePool.h)。ブロック処理 (processStereoBlock) のディザを
+    //   ここから取る。nullptr なら従来どおり自前の VSL リングを使う。process() (単サンプル API) は常に自前のリング
+    void setNoisePool(convo::dsp::DitherNoisePool* pool) noexcept
+    {
+        noisePool = pool;
+    }
+
     inline double process(double input, int channel) noexcept
     {
         if (channel < 0 || channel >= MAX_CHANNELS) return input;
@@ -286,70 +295,32 @@ public:
 
     // 【最適化】ステレオ/モノラルブロック処理
     // ループをインライン化し、関数呼び出しオーバーヘッドを削減。
-    // ステレオ時は L/R を並列処理し、CPU パイプライン効率 (ILP) を向上させる。
-    // 量子化ステップでは SSE4.1 を使用して L/R を同時に丸める。
+    // ★ ステレオ時は L/R を __m128d の 2 レーンに載せて 1 本の誤差フィードバック再帰で回す
+    //   (dsp/StereoLaneNoiseShaper.h)。状態はブロック中レジスタに置き、末尾で zL / zR へ書き戻す。
     inline void processStereoBlock(double* dataL, double* dataR, int numSamples, double headroom) noexcept
     {
         double* zL = shaperStateBuffer + (0 * STATE_STRIDE);
 
+        // ディザは kReadChunk 単位でチャンネルごとにまとめて用意する
+        constexpr int kChunk = convo::dsp::DitherNoisePool::kReadChunk;
+        alignas(64) double tpdfL[kChunk];
+        alignas(64) double tpdfR[kChunk];
+
         if (dataR != nullptr)
         {
             // --- Stereo Path ---
             double* zR = shaperStateBuffer + (1 * STATE_STRIDE);
-            const __m128d v_scale    = _mm_set1_pd(scale);
-            const __m128d v_invScale = _mm_set1_pd(invScale);
-
-            // 係数をローカルにキャッシュ (ループ内での繰り返しロードを防ぐ)
-            const double c0 = coeffs[0], c1 = coeffs[1], c2 = coeffs[2],
-                         c3 = coeffs[3], c4 = coeffs[4], c5 = coeffs[5],
-                         c6 = coeffs[6], c7 = coeffs[7], c8  = coeffs[8],
-                         c9 = coeffs[9], c10 = coeffs[10], c11 = coeffs[11];
-
-            for (int i = 0; i < numSamples; ++i)
+            for (int offset = 0; offset < numSamples; offset += kChunk)
             {
-                // 12 次 Shaped Error (コンパイラが FMA に最適化)
-                const double shapedErrorL = c0*zL[0] + c1*zL[1] + c2*zL[2]
-                                           + c3*zL[3] + c4*zL[4] + c5*zL[5]
-                                          + c6*zL[6] + c7*zL[7] + c8*zL[8]
-                                          + c9*zL[9] + c10*zL[10] + c11*zL[11];
-                const double shapedErrorR = c0*zR[0] + c1*zR[1] + c2*zR[2]
-                                          + c3*zR[3] + c4*zR[4] + c5*zR[5]
-                                           + c6*zR[6] + c7*zR[7] + c8*zR[8]
-                                          + c9*zR[9] + c10*zR[10] + c11*zR[11];
-
-                // Dither (MKL)
-                const double dL = nextTPDF_MKL(0) * scale;
-                const double dR = nextTPDF_MKL(1) * scale;
-
-                // Combine
-                const double tmpL = (dataL[i] * headroom) + dL + shapedErrorL;
-                const double tmpR = (dataR[i] * headroom) + dR + shapedErrorR;
-
-                // Quantize (SSE4.1 でステレオ同時演算)
-                const __m128d v_tmp       = _mm_set_pd(tmpR, tmpL);
-                const __m128d v_scaled    = _mm_mul_pd(v_tmp, v_invScale);
-                const __m128d v_rounded   = _mm_round_pd(v_scaled, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
-                const __m128d v_quantized = _mm_mul_pd(v_rounded, v_scale);
-
-                alignas(16) double quantized[2];
-                _mm_store_pd(quantized, v_quantized); // [quantizedL, quantizedR]
-
-                // Error and State Update (12 タップ シフトレジスタ)
-                const double errorL = tmpL - quantized[0];
-                {
-                    for (int t = NS_ORDER - 1; t > 0; --t)
-                        zL[t] = zL[t - 1];
-                    zL[0] = killDenormal(errorL);
-                }
-                dataL[i] = quantized[0];
-
-                const double errorR = tmpR - quantized[1];
-                {
-                    for (int t = NS_ORDER - 1; t > 0; --t)
-                        zR[t] = zR[t - 1];
-                    zR[0] = killDenormal(errorR);
-                }
-                dataR[i] = quantized[1];
+                const int n = std::min(kChunk, numSamples - offset);
+                fillTpdf(0, tpdfL, n);
+                fillTpdf(1, tpdfR, n);
+                const double* tpdf[2] = { tpdfL, tpdfR };
+                int tpdfIndex[2] = { 0, 0 };
+                convo::dsp::processErrorFeedbackStereoLanes<NS_ORDER>(
+                    coeffs.data(), zL, zR, dataL + offset, dataR + offset, n, headroom, scale, invScale,
+                    convo::numeric_policy::kDenormThresholdAudioState,
+                    [&](int channel) noexcept { return tpdf[channel][tpdfIndex[channel]++] * scale; });
             }
         }
         else
@@ -362,11 +333,14 @@ public:
 
             for (int i = 0; i < numSamples; ++i)
             {
+                if ((i % kChunk) == 0)
+                    fillTpdf(0, tpdfL, std::min(kChunk, numSamples - i));
+
                 const double shapedError = c0*zL[0] + c1*zL[1] + c2*zL[2]
                                          + c3*zL[3] + c4*zL[4] + c5*zL[5]
                                           + c6*zL[6] + c7*zL[7] + c8*zL[8]
                                          + c9*zL[9] + c10*zL[10] + c11*zL[11];
-                const double d   = nextTPDF_MKL(0)  * scale;
+                const double d   = tpdfL[i % kChunk] * scale;
                 const double tmp = (dataL[i] * headroom) + d + shapedError;
 
                 // Quantize (SSE4.1)
@@ -569,6 +543,13 @@ private:
         return (u1 - 0.5) + (u2 - 0.5);
     }
 
+    // 単位 TPDF を count 個。noisePool が無ければ自前のリング (nextTPDF_MKL) をチャンネル順に消費する
+    inline void fillTpdf(int channel, double* dest, int count) noexcept
+    {
+        convo::dsp::fillUnitTpdf(noisePool, channel, dest, count,
+                                 [this, channel]() noexcept { return nextTPDF_MKL(channel); });
+    }
+
     inline double killDenormal(double x) const noexcept
     {
         const double absX = (x < 0.0) ? -x : x;
@@ -578,6 +559,7 @@ private:
     VSLStream rng[MAX_CHANNELS];
 
     double* shaperStateBuffer = nullptr;
+    convo::dsp::DitherNoisePool* noisePool = nullptr;
     double scale    = 1.0 / 8388608.0;  // 2^23（24 bit signed PCM デフォルト）
     double invScale = 8388608.0;         // 2^23（24bit signed PCM デフォルト）
 
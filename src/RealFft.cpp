@@ -0,0 +1,143 @@
+#include "RealFft.h"
+
+#include <JuceHeader.h>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include "DspNumericPolicy.h"  // ASSERT_NON_RT_THREAD
+#include "FftBackendWisdom.h"
+
+namespace convo {
+
+const char* fftBackendName(FftBackend backend) noexcept
+{
+    return backend == FftBackend::MklDfti ? "MKL DFTI" : "IPP";
+}
+
+//==============================================================================
+// RealFftPlan
+//==============================================================================
+std::unique_ptr<RealFftPlan> RealFftPlan::create(int order, FftScaling scaling, FftBackend backend)
+{
+    if (order < 1 || order > 30)
+        return nullptr;
+
+    std::unique_ptr<RealFftPlan> plan(new RealFftPlan());
+    plan->backend = backend;
+    plan->order = order;
+
+    if (backend == FftBackend::Ipp)
+    {
+        const int flag = (scaling == FftScaling::InverseByN) ? IPP_FFT_DIV_INV_BY_N : IPP_FFT_NODIV_BY_ANY;
+        int sizeSpec = 0, sizeInit = 0, sizeWork = 0;
+        if (ippsFFTGetSize_R_64f(order, flag, ippAlgHintFast, &sizeSpec, &sizeInit, &sizeWork) != ippStsNoErr)
+            return nullptr;
+
+        plan->ippSpecBuf = ippsMalloc_8u(sizeSpec);
+        if (plan->ippSpecBuf == nullptr)
+            return nullptr;
+
+        Ipp8u* initBuf = (sizeInit > 0) ? ippsMalloc_8u(sizeInit) : nullptr;
+        const IppStatus initSt = ippsFFTInit_R_64f(&plan->ippSpec, order, flag, ippAlgHintFast,
+                                                   plan->ippSpecBuf, initBuf);
+        if (initBuf)
+            ippsFree(initBuf);
+        if (initSt != ippStsNoErr || plan->ippSpec == nullptr)
+            return nullptr;
+
+        plan->workBytes = static_cast<size_t>(sizeWork);
+        return plan;
+    }
+
+    // MKL DFTI: 出力を IPP と同じ CCS 配置 (CCE + COMPLEX_COMPLEX) にし、計算は呼び出しスレッドのみで行う
+    const MKL_LONG n = static_cast<MKL_LONG>(1) << order;
+    if (DftiCreateDescriptor(&plan->dfti, DFTI_DOUBLE, DFTI_REAL, 1, n) != DFTI_NO_ERROR)
+        return nullptr;
+    bool ok = DftiSetValue(plan->dfti, DFTI_PLACEMENT, DFTI_NOT_INPLACE) == DFTI_NO_ERROR
+           && DftiSetValue(plan->dfti, DFTI_CONJUGATE_EVEN_STORAGE, DFTI_COMPLEX_COMPLEX) == DFTI_NO_ERROR
+           && DftiSetValue(plan->dfti, DFTI_PACKED_FORMAT, DFTI_CCE_FORMAT) == DFTI_NO_ERROR
+           && DftiSetValue(plan->dfti, DFTI_THREAD_LIMIT, 1) == DFTI_NO_ERROR;
+    if (ok && scaling == FftScaling::InverseByN)
+        ok = DftiSetValue(plan->dfti, DFTI_BACKWARD_SCALE, 1.0 / static_cast<double>(n)) == DFTI_NO_ERROR;
+    if (!ok || DftiCommitDescriptor(plan->dfti) != DFTI_NO_ERROR)
+        return nullptr;  // 記述子はデストラクタで解放
+    return plan;
+}
+
+RealFftPlan::~RealFftPlan()
+{
+    if (ippSpecBuf)
+        ippsFree(ippSpecBuf);
+    if (dfti != nullptr)
+        DftiFreeDescriptor(&dfti);
+}
+
+void RealFftPlan::forward(const double* in, double* outCcs, uint8_t* work) const noexcept
+{
+    if (backend == FftBackend::Ipp)
+        ippsFFTFwd_RToCCS_64f(in, outCcs, ippSpec, work);
+    else
+        DftiComputeForward(dfti, const_cast<double*>(in), outCcs);  // 非 in-place: 入力は書き換えない
+}
+
+void RealFftPlan::inverse(const double* inCcs, double* out, uint8_t* work) const noexcept
+{
+    if (backend == FftBackend::Ipp)
+        ippsFFTInv_CCSToR_64f(inCcs, out, ippSpec, work);
+    else
+        DftiComputeBackward(dfti, const_cast<double*>(inCcs), out);
+}
+
+//==============================================================================
+// RealFftPlanCache
+//==============================================================================
+namespace {
+
+using PlanKey = std::tuple<int, FftScaling, FftBackend>;
+
+std::mutex& planCacheMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<PlanKey, std::unique_ptr<RealFftPlan>>& planCache()
+{
+    static std::map<PlanKey, std::unique_ptr<RealFftPlan>> cache;
+    return cache;
+}
+
+} // namespace
+
+const RealFftPlan* RealFftPlanCache::getOrCreate(int order, FftScaling scaling)
+{
+    return getOrCreate(order, scaling, FftBackendWisdom::getInstance().choose(order));
+}
+
+const RealFftPlan* RealFftPlanCache::getOrCreate(int order, FftScaling scaling, FftBackend backend)
+{
+    ASSERT_NON_RT_THREAD();
+    std::lock_guard<std::mutex> lock(planCacheMutex());
+    auto& cache = planCache();
+    const PlanKey key { order, scaling, backend };
+    if (const auto it = cache.find(key); it != cache.end())
+        return it->second.get();
+
+    auto plan = RealFftPlan::create(order, scaling, backend);
+    if (!plan && backend != FftBackend::Ipp)
+    {
+        // DFTI の記述子作成に失敗した場合は従来の IPP に落とす
+        juce::Logger::writeToLog("RealFftPlanCache: " + juce::String(fftBackendName(backend))
+                                 + " plan failed for order " + juce::String(order) + ", using IPP");
+        plan = RealFftPlan::create(order, scaling, FftBackend::Ipp);
+    }
+    if (!plan)
+        return nullptr;
+
+    auto* ptr = plan.get();
+    cache.emplace(key, std::move(plan));
+    return ptr;
+}
+
+} // namespace convo
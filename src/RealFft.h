@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <ipp.h>       // IppsFFTSpec_R_64f
+#include <mkl_dfti.h>  // DFTI_DESCRIPTOR_HANDLE
+
+namespace convo {
+
+/** 実数 FFT の実装ライブラリ。どちらが速いかはサイズと CPU に依存する (FftBackendWisdom が実測で選ぶ)。 */
+enum class FftBackend : int
+{
+    Ipp = 0,      ///< ippsFFTFwd_RToCCS_64f / ippsFFTInv_CCSToR_64f
+    MklDfti = 1,  ///< DftiComputeForward / Backward (DFTI_REAL, CCE 形式, 非 in-place)
+};
+
+enum class FftScaling : int
+{
+    None = 0,         ///< 正規化なし (IPP_FFT_NODIV_BY_ANY)
+    InverseByN = 1,   ///< 逆変換に 1/N (IPP_FFT_DIV_INV_BY_N / DFTI_BACKWARD_SCALE)
+};
+
+[[nodiscard]] const char* fftBackendName(FftBackend backend) noexcept;
+
+/**
+    RealFftPlan: 2^order 点・倍精度の実数 FFT プラン。
+
+    入出力の周波数側はどちらの実装でも CCS 形式 [re0, im0, re1, im1, ..., re(N/2), im(N/2)]
+    (N + 2 double) に揃えるため、呼び出し側は実装を意識しない。
+    プラン本体 (IPP スペック / コミット済み DFTI 記述子) は読み取り専用で複数スレッドから共有でき、
+    呼び出しごとのスクラッチは呼び出し側が getWorkBytes() 分を事前確保して渡す (0 なら nullptr 可)。
+
+    スレッド:
+      create            : Non-RT スレッド (確保を伴う)
+      forward / inverse : 任意スレッド (Audio Thread 可。確保なし)
+*/
+class RealFftPlan
+{
+public:
+    /** 失敗時は nullptr。 */
+    [[nodiscard]] static std::unique_ptr<RealFftPlan> create(int order, FftScaling scaling, FftBackend backend);
+
+    ~RealFftPlan();
+
+    RealFftPlan(const RealFftPlan&) = delete;
+    RealFftPlan& operator=(const RealFftPlan&) = delete;
+
+    [[nodiscard]] FftBackend getBackend() const noexcept { return backend; }
+    [[nodiscard]] int getOrder() const noexcept { return order; }
+    [[nodiscard]] int getSize() const noexcept { return 1 << order; }
+    [[nodiscard]] size_t getWorkBytes() const noexcept { return workBytes; }
+
+    /** in: N 実数 → out: CCS (N + 2 double)。in と out は重ならないこと。 */
+    void forward(const double* in, double* outCcs, uint8_t* work) const noexcept;
+    /** in: CCS (N + 2 double) → out: N 実数。in と out は重ならないこと。 */
+    void inverse(const double* inCcs, double* out, uint8_t* work) const noexcept;
+
+private:
+    RealFftPlan() = default;
+
+    FftBackend backend = FftBackend::Ipp;
+    int order = 0;
+    size_t workBytes = 0;
+
+    IppsFFTSpec_R_64f* ippSpec = nullptr;
+    Ipp8u* ippSpecBuf = nullptr;
+    DFTI_DESCRIPTOR_HANDLE dfti = nullptr;
+};
+
+/**
+    RealFftPlanCache: (order, scaling) ごとのプロセス共有プラン。
+    実装は作成時点の FftBackendWisdom::choose(order) で決まり、以後そのプランは変わらない
+    (計測前に作られたプランは既定の IPP のまま。別実装のプランは別エントリとして並存する)。
+    プランはプロセス終了まで解放しないため、返したポインタは常に有効。
+
+    スレッド: getOrCreate は Non-RT スレッド (mutex)
+*/
+class RealFftPlanCache
+{
+public:
+    [[nodiscard]] static const RealFftPlan* getOrCreate(int order, FftScaling scaling);
+    [[nodiscard]] static const RealFftPlan* getOrCreate(int order, FftScaling scaling, FftBackend backend);
+};
+
+} // namespace convo
@@ -12,7 +12,6 @@
 #include <atomic>
 #include <memory>
 #include "core/IRetireRouter.h"
-#include "DspNumericPolicy.h"
 #include "audioengine/AtomicAccess.h"
 
 template <typename T>
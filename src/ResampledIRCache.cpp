@@ -0,0 +1,402 @@
+#include "ResampledIRCache.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+constexpr uint64_t kCRC64Poly = 0x42F0E1EBA9EA3693ULL;  // CacheManager と同一多項式 (MSB-first)
+
+// テーブル駆動版。数十 MB の IR バッファを毎回 CRC するためビット逐次版は使わない
+const std::array<uint64_t, 256>& crc64Table()
+{
+    static const std::array<uint64_t, 256> table = []
+    {
+        std::array<uint64_t, 256> t {};
+        for (uint64_t i = 0; i < 256; ++i)
+        {
+            uint64_t crc = i << 56;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 0x8000000000000000ULL) ? ((crc << 1) ^ kCRC64Poly) : (crc << 1);
+            t[static_cast<size_t>(i)] = crc;
+        }
+        return t;
+    }();
+    return table;
+}
+
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t doubleBits(double value) noexcept
+{
+    uint64_t bits = 0;
+    static_assert(sizeof(double) == sizeof(uint64_t), "unexpected double size");
+    std::memcpy(&bits, &value, sizeof(double));
+    return bits;
+}
+
+const juce::String kFileExtension = ".rsm";
+}
+
+ResampledIRCache& ResampledIRCache::getInstance()
+{
+    static ResampledIRCache instance;
+    return instance;
+}
+
+uint64_t ResampledIRCache::computeCRC64(uint64_t crc, const uint8_t* data, size_t size) noexcept
+{
+    const auto& table = crc64Table();
+    for (size_t i = 0; i < size; ++i)
+        crc = (crc << 8) ^ table[static_cast<size_t>((crc >> 56) ^ data[i])];
+    return crc;
+}
+
+uint64_t ResampledIRCache::hashCombine(uint64_t seed, uint64_t value) noexcept
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+uint64_t ResampledIRCache::computeFileSourceCRC(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return 0;
+
+    std::unique_ptr<juce::FileInputStream> stream(file.createInputStream());
+    if (!stream)
+        return 0;
+
+    constexpr int kChunkSize = 64 * 1024;
+    std::vector<uint8_t> buffer(static_cast<size_t>(kChunkSize));
+
+    uint64_t crc = 0ULL;
+    while (!stream->isExhausted())
+    {
+        const int readBytes = stream->read(buffer.data(), kChunkSize);
+        if (readBytes <= 0)
+            break;
+        crc = computeCRC64(crc, buffer.data(), static_cast<size_t>(readBytes));
+    }
+
+    // ファイル経路とバッファ経路のキー空間を分ける
+    return hashCombine(crc, 0x46494C45ULL); // "FILE"
+}
+
+uint64_t ResampledIRCache::computeBufferSourceCRC(const juce::AudioBuffer<double>& ir, double sourceSampleRate)
+{
+    const int numCh = ir.getNumChannels();
+    const int numSamples = ir.getNumSamples();
+    if (numCh <= 0 || numSamples <= 0)
+        return 0;
+
+    uint64_t crc = 0ULL;
+    for (int ch = 0; ch < numCh; ++ch)
+        crc = computeCRC64(crc, reinterpret_cast<const uint8_t*>(ir.getReadPointer(ch)),
+                           static_cast<size_t>(numSamples) * sizeof(double));
+
+    crc = hashCombine(crc, static_cast<uint64_t>(numCh));
+    crc = hashCombine(crc, static_cast<uint64_t>(numSamples));
+    crc = hashCombine(crc, doubleBits(sourceSampleRate));
+    return hashCombine(crc, 0x42554646ULL); // "BUFF"
+}
+
+uint64_t ResampledIRCache::computeKey(uint64_t sourceCRC, double targetSampleRate, const ResampleConfig& cfg)
+{
+    uint64_t seed = sourceCRC;
+    seed = hashCombine(seed, doubleBits(targetSampleRate));
+    seed = hashCombine(seed, doubleBits(cfg.transBand));
+    seed = hashCombine(seed, doubleBits(cfg.stopBandAtten));
+    seed = hashCombine(seed, static_cast<uint64_t>(cfg.phase));
+    return seed;
+}
+
+juce::File ResampledIRCache::getCacheDirectory() const
+{
+    auto dir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                   .getChildFile("ConvoPeq")
+                   .getChildFile("IRCache")
+                   .getChildFile("Resampled");
+    if (!dir.exists())
+    {
+        auto result = dir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not create resampled IR cache directory");
+    }
+    return dir;
+}
+
+juce::File ResampledIRCache::getCacheFile(uint64_t key) const
+{
+    return getCacheDirectory().getChildFile(juce::String::toHexString(static_cast<int64>(key)) + kFileExtension);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  読み込み / 保存
+// ═══════════════════════════════════════════════════════════════
+
+bool ResampledIRCache::load(uint64_t key, double targetSampleRate, juce::AudioBuffer<double>& out)
+{
+    const auto file = getCacheFile(key);
+    if (!file.existsAsFile())
+        return false;
+
+    auto reject = [this, key, &file]()
+    {
+        file.deleteFile();
+        std::lock_guard<std::mutex> lock(mutex);
+        forgetLocked(key);
+        return false;
+    };
+
+    std::unique_ptr<juce::FileInputStream> stream(file.createInputStream());
+    if (!stream)
+        return false;
+
+    ResampledIRCacheHeader header {};
+    if (stream->read(&header, static_cast<int>(sizeof(header))) != static_cast<int>(sizeof(header)))
+        return reject();
+
+    const ResampledIRCacheHeader expected {};
+    if (header.magic != expected.magic || header.version != expected.version || header.key != key
+        || header.targetSampleRate != targetSampleRate
+        || header.numChannels == 0 || header.numSamples == 0
+        || header.numSamples * sizeof(double) > static_cast<uint64_t>(std::numeric_limits<int>::max())
+        || header.dataSize != header.numChannels * header.numSamples * sizeof(double)
+        || header.payloadOffset < sizeof(header)
+        || file.getSize() != static_cast<int64>(header.payloadOffset + header.dataSize))
+        return reject();
+
+    juce::AudioBuffer<double> ir(static_cast<int>(header.numChannels), static_cast<int>(header.numSamples));
+    if (!stream->setPosition(static_cast<int64>(header.payloadOffset)))
+        return reject();
+
+    const size_t channelBytes = static_cast<size_t>(header.numSamples) * sizeof(double);
+    uint64_t crc = 0ULL;
+    for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+    {
+        auto* dst = ir.getWritePointer(ch);
+        if (stream->read(dst, channelBytes) != static_cast<int>(channelBytes))
+            return reject();
+        crc = computeCRC64(crc, reinterpret_cast<const uint8_t*>(dst), channelBytes);
+    }
+    if (crc != header.checksum)
+        return reject();
+
+    out = std::move(ir);
+    file.setLastModificationTime(juce::Time::getCurrentTime());  // 次回起動時の索引順を LRU に合わせる
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureIndexedLocked();
+    touchLocked(key, file);
+    return true;
+}
+
+void ResampledIRCache::save(uint64_t key, double targetSampleRate, const juce::AudioBuffer<double>& ir)
+{
+    const int numCh = ir.getNumChannels();
+    const int numSamples = ir.getNumSamples();
+    if (numCh <= 0 || numSamples <= 0)
+        return;
+
+    const size_t channelBytes = static_cast<size_t>(numSamples) * sizeof(double);
+    if (channelBytes > static_cast<size_t>(std::numeric_limits<int>::max()))
+        return;  // load() の 1ch 一括読み込み上限
+
+    ResampledIRCacheHeader header {};
+    header.key = key;
+    header.numChannels = static_cast<uint64_t>(numCh);
+    header.numSamples = static_cast<uint64_t>(numSamples);
+    header.dataSize = static_cast<uint64_t>(numCh) * channelBytes;
+    header.targetSampleRate = targetSampleRate;
+    header.timestamp = static_cast<uint64_t>(juce::Time::getCurrentTime().toMilliseconds());
+    header.payloadOffset = alignUp(sizeof(ResampledIRCacheHeader), ResampledIRCacheHeader::kPayloadAlignment);
+
+    // 予算を単独で超える IR は保存しない (保存直後に自分自身が追い出されるため)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (header.payloadOffset + header.dataSize > byteBudget)
+            return;
+    }
+
+    uint64_t crc = 0ULL;
+    for (int ch = 0; ch < numCh; ++ch)
+        crc = computeCRC64(crc, reinterpret_cast<const uint8_t*>(ir.getReadPointer(ch)), channelBytes);
+    header.checksum = crc;
+
+    const auto file = getCacheFile(key);
+    const auto temp = file.withFileExtension("tmp");
+    temp.deleteFile();  // FileOutputStream は既存ファイルに追記するため
+
+    std::unique_ptr<juce::FileOutputStream> out(temp.createOutputStream());
+    if (!out)
+        return;
+
+    const uint8_t padding[ResampledIRCacheHeader::kPayloadAlignment] = {};
+    out->write(&header, sizeof(header));
+    out->write(padding, static_cast<size_t>(header.payloadOffset - sizeof(header)));
+    for (int ch = 0; ch < numCh; ++ch)
+        out->write(ir.getReadPointer(ch), channelBytes);
+    out->flush();
+    if (out->getStatus().failed())
+    {
+        out.reset();
+        temp.deleteFile();
+        return;
+    }
+    out.reset();
+
+    if (!temp.moveFileTo(file))
+    {
+        temp.deleteFile();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ensureIndexedLocked();
+    touchLocked(key, file);
+    evictToBudgetLocked(key);
+}
+
+// ═══════════════════════════════════════════════════════════════
+//  LRU (バイト予算)
+// ═══════════════════════════════════════════════════════════════
+
+void ResampledIRCache::warmIndex()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    scanDirectoryLocked();
+}
+
+void ResampledIRCache::ensureIndexedLocked()
+{
+    if (indexed)
+        return;
+    scanDirectoryLocked();
+    evictToBudgetLocked(0);
+}
+
+void ResampledIRCache::scanDirectoryLocked()
+{
+    if (indexed)
+        return;
+    indexed = true;
+
+    // 既存ファイルを古い順に push_front し、最終更新が新しいものほど LRU 先頭に来るようにする
+    auto files = getCacheDirectory().findChildFiles(juce::File::findFiles, false, "*" + kFileExtension);
+    std::sort(files.begin(), files.end(), [](const juce::File& a, const juce::File& b)
+    {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for (const auto& f : files)
+    {
+        const uint64_t key = static_cast<uint64_t>(f.getFileNameWithoutExtension().getHexValue64());
+        if (entries.find(key) == entries.end())
+            touchLocked(key, f);
+    }
+}
+
+void ResampledIRCache::touchLocked(uint64_t key, const juce::File& file)
+{
+    const uint64_t sizeBytes = static_cast<uint64_t>(juce::jmax<int64>(0, file.getSize()));
+
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        lruList.erase(it->second.lruPos);
+        lruList.push_front(key);
+        it->second.lruPos = lruList.begin();
+        totalBytes = totalBytes - it->second.sizeBytes + sizeBytes;
+        it->second.sizeBytes = sizeBytes;
+        it->second.file = file;
+        return;
+    }
+
+    lruList.push_front(key);
+    Entry entry;
+    entry.file = file;
+    entry.sizeBytes = sizeBytes;
+    entry.lruPos = lruList.begin();
+    entries.emplace(key, std::move(entry));
+    totalBytes += sizeBytes;
+}
+
+void ResampledIRCache::forgetLocked(uint64_t key)
+{
+    auto it = entries.find(key);
+    if (it == entries.end())
+        return;
+    totalBytes -= std::min(totalBytes, it->second.sizeBytes);
+    lruList.erase(it->second.lruPos);
+    entries.erase(it);
+}
+
+void ResampledIRCache::evictToBudgetLocked(uint64_t protectedKey)
+{
+    auto rit = lruList.rbegin();
+    while (totalBytes > byteBudget && rit != lruList.rend())
+    {
+        const uint64_t key = *rit;
+        auto it = entries.find(key);
+        if (key == protectedKey || it == entries.end())
+        {
+            ++rit;
+            continue;
+        }
+
+        // 読み込み中の別スレッドがファイルを開いている場合は削除できない (Windows) ため次候補へ
+        if (it->second.file.existsAsFile() && !it->second.file.deleteFile())
+        {
+            ++rit;
+            continue;
+        }
+
+        totalBytes -= std::min(totalBytes, it->second.sizeBytes);
+        entries.erase(it);
+        rit = std::make_reverse_iterator(lruList.erase(std::next(rit).base()));
+    }
+}
+
+void ResampledIRCache::setByteBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    byteBudget = bytes;
+    ensureIndexedLocked();
+    evictToBudgetLocked(0);
+}
+
+size_t ResampledIRCache::getByteBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return byteBudget;
+}
+
+size_t ResampledIRCache::getTotalBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<size_t>(totalBytes);
+}
+
+void ResampledIRCache::clear()
+{
+    const auto dir = getCacheDirectory();
+    if (dir.exists())
+        dir.deleteRecursively();
+    {
+        auto result = dir.createDirectory();
+        if (!result.wasOk())
+            juce::Logger::writeToLog("Warning: Could not recreate resampled IR cache directory");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    lruList.clear();
+    totalBytes = 0;
+    indexed = true;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <JuceHeader.h>
+
+#include "IRDSP.h"
+
+struct ResampledIRCacheHeader
+{
+    uint64_t magic = 0x434F4E564F52534DULL; // "CONVORSM"
+    uint64_t version = 1;
+    uint64_t key = 0;
+    uint64_t dataSize = 0;
+    uint64_t checksum = 0;
+    uint64_t timestamp = 0;
+    uint64_t numChannels = 0;
+    uint64_t numSamples = 0;
+    double targetSampleRate = 0.0;
+    uint64_t payloadOffset = 0;
+
+    static constexpr uint64_t kPayloadAlignment = 64;
+};
+
+/**
+    ResampledIRCache: リサンプリング済み時間領域 IR の永続キャッシュ。
+
+    CacheManager (FFT サイズごとの分割スペクトル) の手前段に位置し、デバイスのサンプルレート切替
+    (44.1 ↔ 48 ↔ 96 kHz) のたびに同じ IR を r8brain で再変換するのを避ける。
+    キーは (ソース内容 CRC, 目標レート, ResampleConfig(transBand/stopBandAtten/phase))。
+    ソース内容 CRC はファイル読み込み時はファイルバイト列、リビルド時は IRState のサンプル列と
+    ソースレートから計算する。
+
+    保存先は %APPDATA%/ConvoPeq/IRCache/Resampled。LRU はエントリ数ではなく合計バイト数
+    (setByteBudget) で制限し、起動後最初のアクセスで既存ファイルを最終更新時刻順に索引化する。
+
+    スレッド: 複数の Loader Thread / Rebuild Thread から並行に呼ばれる (索引は mutex、ファイルは tmp→rename)。
+*/
+class ResampledIRCache
+{
+public:
+    static constexpr size_t kDefaultByteBudget = static_cast<size_t>(512) * 1024 * 1024;
+
+    /** UI 側 / DSP 側の ConvolverProcessor で同じディレクトリと予算を共有するためプロセス単一。 */
+    static ResampledIRCache& getInstance();
+
+    static uint64_t computeFileSourceCRC(const juce::File& file);
+    static uint64_t computeBufferSourceCRC(const juce::AudioBuffer<double>& ir, double sourceSampleRate);
+    static uint64_t computeKey(uint64_t sourceCRC, double targetSampleRate, const ResampleConfig& cfg);
+
+    /** キャッシュ済みなら out に復元して true。ヘッダ/CRC 不一致のファイルは削除する。 */
+    bool load(uint64_t key, double targetSampleRate, juce::AudioBuffer<double>& out);
+    void save(uint64_t key, double targetSampleRate, const juce::AudioBuffer<double>& ir);
+
+    void setByteBudget(size_t bytes);
+    [[nodiscard]] size_t getByteBudget() const;
+    [[nodiscard]] size_t getTotalBytes() const;
+
+    void clear();
+
+    /** 起動時のウォームアップ (StartupWarmup) 用。既存ファイルの索引だけを作り、退避はしない
+        (設定の予算が setByteBudget で反映される前に走るため。退避は次の setByteBudget / save で行う)。 */
+    void warmIndex();
+
+private:
+    ResampledIRCache() = default;
+
+    struct Entry
+    {
+        juce::File file;
+        uint64_t sizeBytes = 0;
+        std::list<uint64_t>::iterator lruPos;
+    };
+
+    static uint64_t computeCRC64(uint64_t crc, const uint8_t* data, size_t size) noexcept;
+    static uint64_t hashCombine(uint64_t seed, uint64_t value) noexcept;
+
+    juce::File getCacheDirectory() const;
+    juce::File getCacheFile(uint64_t key) const;
+
+    void ensureIndexedLocked();
+    void scanDirectoryLocked();
+    void touchLocked(uint64_t key, const juce::File& file);
+    void forgetLocked(uint64_t key);
+    void evictToBudgetLocked(uint64_t protectedKey);
+
+    std::unordered_map<uint64_t, Entry> entries;
+    std::list<uint64_t> lruList;  // front = 最近使用
+    uint64_t totalBytes = 0;
+    size_t byteBudget = kDefaultByteBudget;
+    bool indexed = false;
+    mutable std::mutex mutex;
+};
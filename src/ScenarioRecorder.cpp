@@ -0,0 +1,173 @@
+#include "ScenarioRecorder.h"
+
+#include "AudioEngine.h"
+
+namespace
+{
+// 操作ではなく結果として変わる値 (再生で同じ操作をすれば同じに決まる)
+bool isDerivedProperty(const juce::ValueTree& section, const juce::Identifier& name)
+{
+    if (name.toString().startsWith("adaptiveCoeff_"))
+        return true;
+    if (section.hasType("Convolver"))
+    {
+        if (name == juce::Identifier("autoDetectedIRLength") || name == juce::Identifier("recentIRPaths"))
+            return true;
+        // 手動指定でない IR 長は IR から自動で決まる
+        if (name == juce::Identifier("irLength") && !static_cast<bool>(section.getProperty("irLengthManualOverride")))
+            return true;
+    }
+    return false;
+}
+}
+
+ScenarioRecorder::ScenarioRecorder(AudioEngine& engineRef)
+    : engine(engineRef)
+{
+}
+
+ScenarioRecorder::~ScenarioRecorder()
+{
+    stop();
+}
+
+bool ScenarioRecorder::start(const juce::File& file)
+{
+    stop();
+
+    const auto initialStateFile = file.getSiblingFile(file.getFileNameWithoutExtension() + ".initial.xml");
+    lastState = engine.getCurrentState();
+    const auto xml = lastState.createXml();
+    if (xml == nullptr || !xml->writeTo(initialStateFile))
+    {
+        juce::Logger::writeToLog("[ScenarioRecorder] Cannot write initial state: " + initialStateFile.getFullPathName());
+        return false;
+    }
+
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+    {
+        juce::Logger::writeToLog("[ScenarioRecorder] Cannot open: " + file.getFullPathName());
+        return false;
+    }
+
+    scenarioFile = file;
+    output = std::move(stream);
+    *output << juce::String(convo::kScenarioHeader.data(), convo::kScenarioHeader.size()) << "\n"
+            << "# recorded " << juce::Time::getCurrentTime().toISO8601(true) << "\n";
+    startTimeMs = juce::Time::getMillisecondCounterHiRes();
+    eventCount = 0;
+
+    // 再生側はシナリオのディレクトリからの相対パスで探す
+    write(convo::ScenarioEventKind::Preset, initialStateFile.getFileName());
+
+    startTimer(kPollIntervalMs);
+    juce::Logger::writeToLog("[ScenarioRecorder] Recording: " + file.getFullPathName());
+    return true;
+}
+
+void ScenarioRecorder::stop()
+{
+    if (output == nullptr)
+        return;
+
+    stopTimer();
+    recordDifferences(engine.getCurrentState());
+    write(convo::ScenarioEventKind::End, {});
+    output->flush();
+    output.reset();
+    juce::Logger::writeToLog("[ScenarioRecorder] Stopped: events=" + juce::String(eventCount)
+                             + " durationMs=" + juce::String(elapsedMs())
+                             + " file=" + scenarioFile.getFullPathName());
+}
+
+void ScenarioRecorder::notePresetLoaded(const juce::File& presetFile)
+{
+    if (output == nullptr)
+        return;
+
+    // プリセットより前の操作を先に書き、プリセットによる差分は記録しない
+    recordDifferences(engine.getCurrentState());
+    write(convo::ScenarioEventKind::Preset, presetFile.getFullPathName());
+    lastState = engine.getCurrentState();
+}
+
+void ScenarioRecorder::timerCallback()
+{
+    recordDifferences(engine.getCurrentState());
+}
+
+void ScenarioRecorder::recordDifferences(const juce::ValueTree& current)
+{
+    if (output == nullptr)
+        return;
+
+    const auto recordSection = [this](const juce::ValueTree& now, const juce::ValueTree& before, const juce::String& section)
+    {
+        for (int i = 0; i < now.getNumProperties(); ++i)
+        {
+            const auto name = now.getPropertyName(i);
+            if (isDerivedProperty(now, name))
+                continue;
+            if (before.isValid() && before.hasProperty(name) && before.getProperty(name) == now.getProperty(name))
+                continue;
+
+            if (section == "Convolver" && name == juce::Identifier("irPath"))
+            {
+                if (now.getProperty(name).toString().isNotEmpty())
+                    write(convo::ScenarioEventKind::Ir, now.getProperty(name).toString());
+                continue;
+            }
+            write(convo::ScenarioEventKind::Set, now.getProperty(name).toString(), -1, section, name.toString());
+        }
+    };
+
+    recordSection(current, lastState, "Preset");
+
+    const auto eq = current.getChildWithName("EQ");
+    const auto lastEq = lastState.getChildWithName("EQ");
+    recordSection(eq, lastEq, "EQ");
+    for (const auto& band : eq)
+    {
+        if (!band.hasType("Band"))
+            continue;
+        const int index = band.getProperty("index");
+        const auto lastBand = lastEq.getChildWithProperty("index", index);
+        for (int i = 0; i < band.getNumProperties(); ++i)
+        {
+            const auto name = band.getPropertyName(i);
+            if (name == juce::Identifier("index"))
+                continue;
+            if (lastBand.isValid() && lastBand.getProperty(name) == band.getProperty(name))
+                continue;
+            write(convo::ScenarioEventKind::EqBand, band.getProperty(name).toString(), index, {}, name.toString());
+        }
+    }
+
+    recordSection(current.getChildWithName("Convolver"), lastState.getChildWithName("Convolver"), "Convolver");
+
+    lastState = current;
+}
+
+void ScenarioRecorder::write(convo::ScenarioEventKind kind, const juce::String& value,
+                             int band, const juce::String& section, const juce::String& property)
+{
+    convo::ScenarioEvent e;
+    e.timeMs = elapsedMs();
+    e.kind = kind;
+    e.band = band;
+    e.section = section.toStdString();
+    e.property = property.toStdString();
+    e.value = value.toStdString();
+
+    *output << juce::String(convo::formatScenarioEvent(e)) << "\n";
+    // 異常終了しても途中までのシナリオが残るように毎回書き出す (記録の頻度は低い)
+    output->flush();
+    ++eventCount;
+}
+
+juce::int64 ScenarioRecorder::elapsedMs() const
+{
+    return static_cast<juce::int64>(juce::Time::getMillisecondCounterHiRes() - startTimeMs);
+}
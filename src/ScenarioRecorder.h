@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+
+#include <JuceHeader.h>
+
+#include "ScenarioScript.h"
+
+class AudioEngine;
+
+/**
+    ScenarioRecorder: 通常起動中の操作を ScenarioScript 形式で記録する (--cli-record-scenario <file>)。
+
+    - start() で開始時点の全設定を <file 名>.initial.xml に書き、シナリオの先頭を「0 ms にそのプリセット」にする
+      (再生はその状態から始まるので、記録時の設定に依存しない)
+    - kPollIntervalMs ごとに AudioEngine::getCurrentState() を前回と比べ、変わったプロパティを
+      eq / set / ir イベントとして追記する。スライダーのドラッグは間隔ごとの値に間引かれる
+    - 学習結果 (adaptiveCoeff_*)・IR から自動で決まる値・最近使った IR の一覧など、
+      操作ではなく結果として変わる値は記録しない
+    - メニューからのプリセット読み込みは notePresetLoaded() で preset イベントにし、
+      それによる差分は記録しない
+    - stop() (またはデストラクタ) で end を書いて閉じる
+
+    Message Thread 専用。
+*/
+class ScenarioRecorder : private juce::Timer
+{
+public:
+    static constexpr int kPollIntervalMs = 50;
+
+    explicit ScenarioRecorder(AudioEngine& engine);
+    ~ScenarioRecorder() override;
+
+    bool start(const juce::File& scenarioFile);
+    void stop();
+    [[nodiscard]] bool isRecording() const noexcept { return output != nullptr; }
+
+    void notePresetLoaded(const juce::File& presetFile);
+
+private:
+    void timerCallback() override;
+    void recordDifferences(const juce::ValueTree& current);
+    void write(convo::ScenarioEventKind kind, const juce::String& value,
+               int band = -1, const juce::String& section = {}, const juce::String& property = {});
+    [[nodiscard]] juce::int64 elapsedMs() const;
+
+    AudioEngine& engine;
+    juce::File scenarioFile;
+    std::unique_ptr<juce::FileOutputStream> output;
+    juce::ValueTree lastState;
+    double startTimeMs = 0.0;
+    int eventCount = 0;
+};
@@ -0,0 +1,324 @@
+#include "ScenarioReplayer.h"
+
+#include "AudioEngine.h"
+#include "OfflineRenderer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+// 記録時の型 (getCurrentState の var) に合わせて文字列を戻す
+juce::var convertLike(const juce::var& existing, const juce::String& text)
+{
+    if (existing.isBool())
+        return text.getIntValue() != 0 || text.equalsIgnoreCase("true");
+    if (existing.isInt())
+        return text.getIntValue();
+    if (existing.isInt64())
+        return text.getLargeIntValue();
+    if (existing.isDouble())
+        return text.getDoubleValue();
+    return text;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+    if (sorted.empty())
+        return 0.0;
+    const auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+}
+
+ScenarioReplayer::ScenarioReplayer(AudioEngine& engineRef, Options replayOptions, FinishedCallback finishedCallback)
+    : juce::Thread("ScenarioReplayer"),
+      engine(engineRef),
+      options(std::move(replayOptions)),
+      onFinished(std::move(finishedCallback))
+{
+    formatManager.registerBasicFormats();
+}
+
+ScenarioReplayer::~ScenarioReplayer()
+{
+    cancel();
+    stopThread(10000);
+}
+
+void ScenarioReplayer::cancel()
+{
+    signalThreadShouldExit();
+}
+
+bool ScenarioReplayer::prepare()
+{
+    scenario = convo::parseScenario(options.scenarioFile.loadFileAsString().toStdString());
+    for (const auto& error : scenario.errors)
+        juce::Logger::writeToLog("[ScenarioReplay] " + options.scenarioFile.getFileName() + " " + juce::String(error));
+    if (scenario.events.empty())
+    {
+        juce::Logger::writeToLog("[ScenarioReplay] No events: " + options.scenarioFile.getFullPathName());
+        return false;
+    }
+
+    reader.reset(formatManager.createReaderFor(options.inputFile));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0 || reader->numChannels <= 0)
+    {
+        juce::Logger::writeToLog("[ScenarioReplay] Unreadable input: " + options.inputFile.getFullPathName());
+        reader.reset();
+        return false;
+    }
+
+    options.blockSize = juce::jlimit(16, 16384, options.blockSize);
+    sampleRateHz = reader->sampleRate;
+
+    const bool hasEnd = scenario.events.back().kind == convo::ScenarioEventKind::End;
+    const double durationSeconds = static_cast<double>(scenario.durationMs()) / 1000.0 + (hasEnd ? 0.0 : kTailSeconds);
+    blockMicros.clear();
+    blockMicros.reserve(static_cast<size_t>(durationSeconds * sampleRateHz / options.blockSize) + 16);
+
+    engine.setDeviceIntegerOutputBits(0);
+    engine.prepareToPlay(options.blockSize, sampleRateHz);
+
+    juce::Logger::writeToLog("[ScenarioReplay] Prepared: scenario=" + options.scenarioFile.getFullPathName()
+                             + " events=" + juce::String(static_cast<int>(scenario.events.size()))
+                             + " durationSec=" + juce::String(durationSeconds, 3)
+                             + " in=" + options.inputFile.getFullPathName()
+                             + " sr=" + juce::String(sampleRateHz)
+                             + " block=" + juce::String(options.blockSize)
+                             + " realtime=" + juce::String(static_cast<int>(options.realtime)));
+    return true;
+}
+
+void ScenarioReplayer::run()
+{
+    bool succeeded = false;
+    if (reader != nullptr)
+    {
+        ReplayStats stats;
+        stats.settleSeconds = OfflineRenderer::waitForSettledRuntime(engine, *this, options.blockSize, options.settleTimeoutSeconds);
+        succeeded = stats.settleSeconds >= 0.0 && replay(stats);
+        if (succeeded)
+            reportStats(stats);
+    }
+
+    juce::MessageManager::callAsync([callback = onFinished, succeeded]
+    {
+        if (callback)
+            callback(succeeded);
+    });
+}
+
+bool ScenarioReplayer::replay(ReplayStats& stats)
+{
+    const bool hasEnd = scenario.events.back().kind == convo::ScenarioEventKind::End;
+    const double durationSeconds = static_cast<double>(scenario.durationMs()) / 1000.0 + (hasEnd ? 0.0 : kTailSeconds);
+    const auto endSample = static_cast<juce::int64>(durationSeconds * sampleRateHz);
+
+    juce::AudioBuffer<float> io(2, options.blockSize);
+    juce::AudioBuffer<double> block(2, options.blockSize);
+    const double ticksPerMicro = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / 1.0e6;
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    size_t nextEvent = 0;
+    juce::int64 position = 0;
+
+    while (position < endSample)
+    {
+        if (threadShouldExit())
+            return false;
+
+        const double positionMs = static_cast<double>(position) * 1000.0 / sampleRateHz;
+        while (nextEvent < scenario.events.size() && static_cast<double>(scenario.events[nextEvent].timeMs) <= positionMs)
+        {
+            if (applyOnMessageThread(scenario.events[nextEvent]))
+                ++stats.eventsApplied;
+            else
+                ++stats.eventsFailed;
+            ++nextEvent;
+        }
+
+        readLooped(io, position);
+        block.makeCopyOf(io, true);
+
+        const auto before = juce::Time::getHighResolutionTicks();
+        engine.processBlockDouble(block);
+        const auto after = juce::Time::getHighResolutionTicks();
+        if (blockMicros.size() < blockMicros.capacity())
+            blockMicros.push_back(static_cast<double>(after - before) / ticksPerMicro);
+
+        position += options.blockSize;
+        ++stats.blocks;
+
+        if (options.realtime)
+        {
+            // 入力の経過時間に壁時計を合わせる (先行しているぶんだけ待つ)
+            const double aheadMs = static_cast<double>(position) * 1000.0 / sampleRateHz
+                                 - (juce::Time::getMillisecondCounterHiRes() - startTime);
+            if (aheadMs >= 1.0)
+                wait(static_cast<int>(aheadMs));
+        }
+    }
+
+    stats.audioSeconds = static_cast<double>(position) / sampleRateHz;
+    stats.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return true;
+}
+
+void ScenarioReplayer::readLooped(juce::AudioBuffer<float>& io, juce::int64 position)
+{
+    io.clear();
+    const juce::int64 length = reader->lengthInSamples;
+    int filled = 0;
+    while (filled < options.blockSize)
+    {
+        const juce::int64 offset = (position + filled) % length;
+        const int count = static_cast<int>(std::min<juce::int64>(options.blockSize - filled, length - offset));
+        reader->read(&io, filled, count, offset, true, true);
+        filled += count;
+    }
+    if (reader->numChannels == 1)
+        io.copyFrom(1, 0, io, 0, 0, options.blockSize);
+}
+
+bool ScenarioReplayer::applyOnMessageThread(const convo::ScenarioEvent& event)
+{
+    // タイムアウトで先に戻っても callAsync 側が触れるように共有で持つ
+    struct Pending
+    {
+        juce::WaitableEvent done;
+        bool applied = false;
+    };
+    auto pending = std::make_shared<Pending>();
+    const auto baseDirectory = options.scenarioFile.getParentDirectory();
+
+    juce::MessageManager::callAsync([pending, target = &engine, event, baseDirectory]
+    {
+        pending->applied = applyEvent(*target, event, baseDirectory);
+        pending->done.signal();
+    });
+
+    if (!pending->done.wait(kApplyTimeoutMs))
+    {
+        juce::Logger::writeToLog("[ScenarioReplay] Event not applied within " + juce::String(kApplyTimeoutMs)
+                                 + " ms: " + juce::String(convo::formatScenarioEvent(event)));
+        return false;
+    }
+    // signal() の前の書き込みは wait() が返った後に見える
+    return pending->applied;
+}
+
+bool ScenarioReplayer::applyEvent(AudioEngine& targetEngine, const convo::ScenarioEvent& event, const juce::File& baseDirectory)
+{
+    const juce::String value(event.value);
+    const auto resolveFile = [&baseDirectory](const juce::String& path)
+    {
+        return juce::File::isAbsolutePath(path) ? juce::File(path) : baseDirectory.getChildFile(path);
+    };
+
+    bool applied = false;
+    switch (event.kind)
+    {
+        case convo::ScenarioEventKind::EqBand:
+        {
+            const int band = event.band;
+            if (band >= EQProcessor::NUM_BANDS)
+                break;
+            applied = true;
+            if (event.property == "enabled")
+                targetEngine.setEQBandEnabled(band, value.getIntValue() != 0 || value.equalsIgnoreCase("true"));
+            else if (event.property == "freq")
+                targetEngine.setEQBandFrequency(band, value.getFloatValue());
+            else if (event.property == "gain")
+                targetEngine.setEQBandGain(band, value.getFloatValue());
+            else if (event.property == "q")
+                targetEngine.setEQBandQ(band, value.getFloatValue());
+            else if (event.property == "type")
+                targetEngine.setEQBandType(band, static_cast<EQBandType>(value.getIntValue()));
+            else if (event.property == "channel")
+                targetEngine.setEQBandChannelMode(band, static_cast<EQChannelMode>(value.getIntValue()));
+            else
+                applied = false;
+            break;
+        }
+
+        case convo::ScenarioEventKind::Set:
+        {
+            // 個別の setter が無い設定もあるので、現在の全設定の 1 プロパティだけ変えて読み込み直す
+            // (IR は同じパスなら読み直されない)
+            auto state = targetEngine.getCurrentState();
+            auto target = (event.section == "Preset") ? state : state.getChildWithName(juce::Identifier(juce::String(event.section)));
+            const juce::Identifier name(juce::String(event.property));
+            if (!target.isValid() || !target.hasProperty(name))
+                break;
+            target.setProperty(name, convertLike(target.getProperty(name), value), nullptr);
+            targetEngine.requestLoadState(state);
+            applied = true;
+            break;
+        }
+
+        case convo::ScenarioEventKind::Ir:
+        {
+            const auto file = resolveFile(value);
+            if (!file.existsAsFile())
+                break;
+            targetEngine.requestConvolverPreset(file);
+            applied = true;
+            break;
+        }
+
+        case convo::ScenarioEventKind::Preset:
+        {
+            const auto file = resolveFile(value);
+            if (file.hasFileExtension(".xml"))
+            {
+                if (auto xml = juce::XmlDocument::parse(file))
+                {
+                    const auto state = juce::ValueTree::fromXml(*xml);
+                    if (state.isValid())
+                    {
+                        targetEngine.requestLoadState(state);
+                        applied = true;
+                    }
+                }
+            }
+            else if (file.hasFileExtension(".txt") && file.existsAsFile())
+            {
+                targetEngine.requestEqPresetFromText(file);
+                applied = true;
+            }
+            break;
+        }
+
+        case convo::ScenarioEventKind::End:
+            applied = true;
+            break;
+    }
+
+    if (!applied)
+        juce::Logger::writeToLog("[ScenarioReplay] Cannot apply: " + juce::String(convo::formatScenarioEvent(event)));
+    return applied;
+}
+
+void ScenarioReplayer::reportStats(const ReplayStats& stats)
+{
+    std::sort(blockMicros.begin(), blockMicros.end());
+    const double blockBudgetUs = static_cast<double>(options.blockSize) * 1.0e6 / sampleRateHz;
+    const double realtimeFactor = (stats.wallSeconds > 0.0) ? stats.audioSeconds / stats.wallSeconds : 0.0;
+    const auto line = "[ScenarioReplay] Finished: scenario=" + options.scenarioFile.getFileName()
+                    + " events=" + juce::String(stats.eventsApplied)
+                    + " failed=" + juce::String(stats.eventsFailed)
+                    + " blocks=" + juce::String(stats.blocks)
+                    + " audioSec=" + juce::String(stats.audioSeconds, 3)
+                    + " wallSec=" + juce::String(stats.wallSeconds, 3)
+                    + " settleSec=" + juce::String(stats.settleSeconds, 3)
+                    + " realtimeFactor=" + juce::String(realtimeFactor, 2)
+                    + " blockBudgetUs=" + juce::String(blockBudgetUs, 1)
+                    + " blockP50Us=" + juce::String(percentile(blockMicros, 0.50), 1)
+                    + " blockP99Us=" + juce::String(percentile(blockMicros, 0.99), 1)
+                    + " blockMaxUs=" + juce::String(blockMicros.empty() ? 0.0 : blockMicros.back(), 1);
+
+    juce::Logger::writeToLog(line);
+    std::fputs((line + "\n").toRawUTF8(), stdout);
+    std::fflush(stdout);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "ScenarioScript.h"
+
+class AudioEngine;
+
+/**
+    ScenarioReplayer: ScenarioScript のシナリオをヘッドレスで再生するスレッド (--cli-replay <scenario> <in>)。
+
+    PGO の学習用負荷と、ベンチマーク用の再現できる負荷に使う。OfflineRenderer と同じくデバイスの
+    コールバックを外した後に prepare() し、run() が Audio Thread の代わりに processBlockDouble を回す。
+
+    - 入力ファイルを繰り返し流し、入力の経過時間がイベントの時刻に達したら Message Thread で適用する
+      (適用が終わるまで次のブロックへ進まないので、イベントとブロックの前後関係は毎回同じ)
+    - 既定では実時間に合わせて回す (リビルド・クロスフェード・IR 読み込みがブロックと並行して進む割合を
+      実機と揃える)。Options::realtime = false (--cli-replay-fast) はデバイス待ち無しで回す
+    - end イベント (無ければ最後のイベント + kTailSeconds) まで回して終わる。出力は捨てる
+    - 終了時にブロック処理時間の p50 / p99 / max と実時間比を [ScenarioReplay] としてログと標準出力へ出す
+*/
+class ScenarioReplayer : public juce::Thread
+{
+public:
+    struct Options
+    {
+        juce::File scenarioFile;
+        juce::File inputFile;
+        int blockSize = 512;
+        bool realtime = true;
+        double settleTimeoutSeconds = 60.0;
+    };
+
+    // end イベントが無いとき、最後のイベントの後に回す時間
+    static constexpr double kTailSeconds = 2.0;
+    // 1 イベントの適用を Message Thread に待つ上限
+    static constexpr int kApplyTimeoutMs = 10000;
+
+    using FinishedCallback = std::function<void(bool succeeded)>;
+
+    ScenarioReplayer(AudioEngine& engine, Options options, FinishedCallback onFinished);
+    ~ScenarioReplayer() override;
+
+    // Message Thread 専用。デバイスのコールバックを外した後に呼ぶこと
+    bool prepare();
+
+    void run() override;
+    void cancel();
+
+    // Message Thread: 1 イベントを AudioEngine に適用する。相対パスは baseDirectory から解決する
+    static bool applyEvent(AudioEngine& engine, const convo::ScenarioEvent& event, const juce::File& baseDirectory);
+
+private:
+    struct ReplayStats
+    {
+        int eventsApplied = 0;
+        int eventsFailed = 0;
+        juce::int64 blocks = 0;
+        double audioSeconds = 0.0;
+        double wallSeconds = 0.0;
+        double settleSeconds = 0.0;
+    };
+
+    bool replay(ReplayStats& stats);
+    bool applyOnMessageThread(const convo::ScenarioEvent& event);
+    void readLooped(juce::AudioBuffer<float>& io, juce::int64 position);
+    void reportStats(const ReplayStats& stats);
+
+    AudioEngine& engine;
+    Options options;
+    FinishedCallback onFinished;
+    juce::AudioFormatManager formatManager;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    convo::ScenarioParseResult scenario;
+    double sampleRateHz = 0.0;
+    std::vector<double> blockMicros;    // run() の前に確保しておく
+};
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//==============================================================================
+// ScenarioScript — 操作シナリオのテキスト形式 (ScenarioRecorder が書き、ScenarioReplayer が読む)
+//
+//   1 行 1 イベント、タブ区切り。# で始まる行と空行は無視する。
+//     <timeMs>  eq      <band> <property> <value>     EQ バンド (enabled / freq / gain / q / type / channel)
+//     <timeMs>  set     <section> <property> <value>  それ以外の設定 (section = Preset / EQ / Convolver)
+//     <timeMs>  ir      <path>                        IR の読み込み
+//     <timeMs>  preset  <path>                        プリセット (.xml = 全設定、.txt = EQ プリセット)
+//     <timeMs>  end                                   シナリオの終わり (最後のイベント以降も回し続ける長さ)
+//   timeMs は記録開始からのミリ秒。値・パスは行末までで、タブ・改行・\ は \t \n \\ でエスケープする。
+//   相対パスはシナリオファイルのディレクトリから解決する (再生側)。
+//
+//   JUCE 非依存 (テストから直接使う)。
+//==============================================================================
+
+namespace convo {
+
+enum class ScenarioEventKind : uint8_t
+{
+    EqBand,
+    Set,
+    Ir,
+    Preset,
+    End
+};
+
+[[nodiscard]] constexpr const char* scenarioEventKindName(ScenarioEventKind kind) noexcept
+{
+    switch (kind)
+    {
+        case ScenarioEventKind::EqBand: return "eq";
+        case ScenarioEventKind::Set:    return "set";
+        case ScenarioEventKind::Ir:     return "ir";
+        case ScenarioEventKind::Preset: return "preset";
+        case ScenarioEventKind::End:    return "end";
+    }
+    return "?";
+}
+
+struct ScenarioEvent
+{
+    int64_t timeMs = 0;
+    ScenarioEventKind kind = ScenarioEventKind::End;
+    int band = -1;              // EqBand のみ
+    std::string section;        // Set のみ
+    std::string property;       // EqBand / Set
+    std::string value;          // EqBand / Set の値、Ir / Preset のパス
+
+    bool operator==(const ScenarioEvent&) const = default;
+};
+
+struct ScenarioParseResult
+{
+    std::vector<ScenarioEvent> events;    // 時刻順 (同時刻はファイル順)
+    std::vector<std::string> errors;      // "line N: ..." (読めない行は飛ばして続ける)
+
+    // 最後のイベント (End を含む) の時刻
+    [[nodiscard]] int64_t durationMs() const noexcept
+    {
+        return events.empty() ? 0 : events.back().timeMs;
+    }
+};
+
+inline constexpr std::string_view kScenarioHeader = "# ConvoPeq scenario v1";
+
+namespace detail {
+
+inline std::string escapeScenarioField(std::string_view text)
+{
+    std::string out;
+    out.reserve(text.size());
+    for (const char c : text)
+    {
+        switch (c)
+        {
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\\': out += "\\\\"; break;
+            default:   out += c; break;
+        }
+    }
+    return out;
+}
+
+inline std::string unescapeScenarioField(std::string_view text)
+{
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] != '\\' || i + 1 == text.size())
+        {
+            out += text[i];
+            continue;
+        }
+        switch (text[++i])
+        {
+            case 't':  out += '\t'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            default:   out += text[i]; break;
+        }
+    }
+    return out;
+}
+
+// 先頭から区切り (タブ) までを取り出して text を進める。区切りが無ければ残り全部
+inline std::string_view takeScenarioField(std::string_view& text)
+{
+    const size_t tab = text.find('\t');
+    const std::string_view field = text.substr(0, tab);
+    text = (tab == std::string_view::npos) ? std::string_view {} : text.substr(tab + 1);
+    return field;
+}
+
+template <typename T>
+bool parseScenarioInt(std::string_view text, T& out)
+{
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc {} && ptr == text.data() + text.size();
+}
+
+} // namespace detail
+
+[[nodiscard]] inline std::string formatScenarioEvent(const ScenarioEvent& e)
+{
+    std::string line = std::to_string(e.timeMs);
+    line += '\t';
+    line += scenarioEventKindName(e.kind);
+    switch (e.kind)
+    {
+        case ScenarioEventKind::EqBand:
+            line += '\t' + std::to_string(e.band) + '\t' + detail::escapeScenarioField(e.property)
+                  + '\t' + detail::escapeScenarioField(e.value);
+            break;
+        case ScenarioEventKind::Set:
+            line += '\t' + detail::escapeScenarioField(e.section) + '\t' + detail::escapeScenarioField(e.property)
+                  + '\t' + detail::escapeScenarioField(e.value);
+            break;
+        case ScenarioEventKind::Ir:
+        case ScenarioEventKind::Preset:
+            line += '\t' + detail::escapeScenarioField(e.value);
+            break;
+        case ScenarioEventKind::End:
+            break;
+    }
+    return line;
+}
+
+// 1 行を読む。コメント・空行は nullopt で error も空。読めない行は nullopt で error に理由
+[[nodiscard]] inline std::optional<ScenarioEvent> parseScenarioLine(std::string_view line, std::string& error)
+{
+    error.clear();
+    while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+        line.remove_suffix(1);
+    if (line.empty() || line.front() == '#')
+        return std::nullopt;
+
+    ScenarioEvent e;
+    if (!detail::parseScenarioInt(detail::takeScenarioField(line), e.timeMs) || e.timeMs < 0)
+    {
+        error = "bad time";
+        return std::nullopt;
+    }
+
+    const std::string_view kind = detail::takeScenarioField(line);
+    if (kind == "eq")
+    {
+        e.kind = ScenarioEventKind::EqBand;
+        if (!detail::parseScenarioInt(detail::takeScenarioField(line), e.band) || e.band < 0)
+        {
+            error = "bad band";
+            return std::nullopt;
+        }
+        e.property = detail::unescapeScenarioField(detail::takeScenarioField(line));
+        e.value = detail::unescapeScenarioField(line);
+        if (e.property.empty())
+        {
+            error = "missing property";
+            return std::nullopt;
+        }
+    }
+    else if (kind == "set")
+    {
+        e.kind = ScenarioEventKind::Set;
+        e.section = detail::unescapeScenarioField(detail::takeScenarioField(line));
+        e.property = detail::unescapeScenarioField(detail::takeScenarioField(line));
+        e.value = detail::unescapeScenarioField(line);
+        if (e.section.empty() || e.property.empty())
+        {
+            error = "missing section or property";
+            return std::nullopt;
+        }
+    }
+    else if (kind == "ir" || kind == "preset")
+    {
+        e.kind = (kind == "ir") ? ScenarioEventKind::Ir : ScenarioEventKind::Preset;
+        e.value = detail::unescapeScenarioField(line);
+        if (e.value.empty())
+        {
+            error = "missing path";
+            return std::nullopt;
+        }
+    }
+    else if (kind == "end")
+    {
+        e.kind = ScenarioEventKind::End;
+    }
+    else
+    {
+        error = "unknown event '" + std::string(kind) + "'";
+        return std::nullopt;
+    }
+    return e;
+}
+
+[[nodiscard]] inline ScenarioParseResult parseScenario(std::string_view text)
+{
+    ScenarioParseResult result;
+    std::string error;
+    int lineNumber = 0;
+    while (!text.empty())
+    {
+        ++lineNumber;
+        const size_t newline = text.find('\n');
+        const std::string_view line = text.substr(0, newline);
+        text = (newline == std::string_view::npos) ? std::string_view {} : text.substr(newline + 1);
+
+        if (auto e = parseScenarioLine(line, error))
+            result.events.push_back(std::move(*e));
+        else if (!error.empty())
+            result.errors.push_back("line " + std::to_string(lineNumber) + ": " + error);
+    }
+
+    std::stable_sort(result.events.begin(), result.events.end(),
+                     [](const ScenarioEvent& a, const ScenarioEvent& b) { return a.timeMs < b.timeMs; });
+    return result;
+}
+
+} // namespace convo
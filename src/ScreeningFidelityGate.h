@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+//==============================================================================
+// ScreeningFidelityGate — 学習の多段忠実度評価 (予備選別 → 本評価) の打ち切り幅を決める
+//
+//   NoiseShaperLearner は全候補をまず安い予備選別 (MklFftEvaluator::evaluateScreeningBatch:
+//   短い FFT・float・少ない Bark 帯域・各レベル先頭セグメントのみ) で採点し、上位
+//   promoteFraction の候補だけを本評価 (4096 点・倍精度・全 Bark モデル) へ進める。
+//   予備選別の順位が本評価の順位とずれると CMA-ES のエリートを取りこぼすため、このクラスが
+//   kCheckInterval 世代ごとに「照合世代」を挟む。照合世代では全候補を本評価し、
+//   両スコアの順位相関 (Spearman) と、本評価の上位 eliteCount が予備選別の通過枠に
+//   入っていた割合 (エリート再現率) を recordCheck で受け取って次の照合までの方針を決める:
+//
+//     - 再現率 < 1          → 通過枠を kWidenFactor 倍に広げる (上限 1 = 全候補)
+//     - 相関 < kMinRankCorrelation → 次の照合まで予備選別を使わない (全候補を本評価)
+//     - 再現率 = 1 かつ相関 ≥ kNarrowRankCorrelation → 通過枠を kNarrowFactor 倍に狭める
+//
+//   最初の世代は必ず照合世代 (信頼できるまで打ち切らない)。target (ビット深度) ごとに 1 つ持つ。
+//   学習スレッド専用 (同期なし)。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+namespace convo {
+
+// 平均順位 (同値は順位の平均) による Spearman の順位相関。n < 3 または片方が定数なら 0
+template <int MaxCount>
+double spearmanRankCorrelation(const double* a, const double* b, int n) noexcept
+{
+    if (n < 3 || n > MaxCount)
+        return 0.0;
+
+    const auto rank = [n](const double* values, double* ranks) noexcept
+    {
+        std::array<int, MaxCount> order {};
+        std::iota(order.begin(), order.begin() + n, 0);
+        std::sort(order.begin(), order.begin() + n, [values](int x, int y) { return values[x] < values[y]; });
+        for (int i = 0; i < n;)
+        {
+            int j = i + 1;
+            while (j < n && values[order[static_cast<size_t>(j)]] == values[order[static_cast<size_t>(i)]])
+                ++j;
+            const double averageRank = 0.5 * static_cast<double>(i + j - 1);
+            for (int k = i; k < j; ++k)
+                ranks[order[static_cast<size_t>(k)]] = averageRank;
+            i = j;
+        }
+    };
+
+    std::array<double, MaxCount> rankA {};
+    std::array<double, MaxCount> rankB {};
+    rank(a, rankA.data());
+    rank(b, rankB.data());
+
+    const double mean = 0.5 * static_cast<double>(n - 1);
+    double covariance = 0.0;
+    double varianceA = 0.0;
+    double varianceB = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        const double da = rankA[static_cast<size_t>(i)] - mean;
+        const double db = rankB[static_cast<size_t>(i)] - mean;
+        covariance += da * db;
+        varianceA += da * da;
+        varianceB += db * db;
+    }
+    if (varianceA <= 0.0 || varianceB <= 0.0)
+        return 0.0;
+    return covariance / std::sqrt(varianceA * varianceB);
+}
+
+template <int MaxCandidates>
+class ScreeningFidelityGate
+{
+public:
+    static constexpr int kCheckInterval = 8;
+    static constexpr double kMinRankCorrelation = 0.6;
+    static constexpr double kNarrowRankCorrelation = 0.85;
+    static constexpr double kInitialPromoteFraction = 0.5;
+    static constexpr double kMinPromoteFraction = 0.34;
+    static constexpr double kWidenFactor = 1.5;
+    static constexpr double kNarrowFactor = 0.85;
+
+    struct Plan
+    {
+        bool screen = false;   // 予備選別を回す
+        bool check = false;    // 照合世代 (予備選別も回すが全候補を本評価する)
+    };
+
+    struct Stats
+    {
+        std::uint64_t screenedGenerations = 0;
+        std::uint64_t checkGenerations = 0;
+        std::uint64_t missedElites = 0;       // 照合世代で通過枠から漏れた本評価エリートの累計
+        double lastRankCorrelation = 0.0;
+        double promoteFraction = kInitialPromoteFraction;
+        bool trusted = false;
+    };
+
+    void reset() noexcept
+    {
+        generationsSinceCheck = kCheckInterval;
+        trusted = false;
+        promoteFraction = kInitialPromoteFraction;
+        stats = Stats {};
+    }
+
+    // 世代の先頭で 1 回呼ぶ
+    Plan beginGeneration() noexcept
+    {
+        Plan plan;
+        plan.check = generationsSinceCheck >= kCheckInterval;
+        plan.screen = plan.check || trusted;
+        if (plan.check)
+            generationsSinceCheck = 0;   // 照合が中断されて recordCheck が来なくても次は kCheckInterval 世代後
+        ++generationsSinceCheck;
+        if (plan.screen)
+            ++stats.screenedGenerations;
+        return plan;
+    }
+
+    // 予備選別から本評価へ進める候補数 (minimum 以上 candidates 以下)
+    [[nodiscard]] int promoteCount(int candidates, int minimum) const noexcept
+    {
+        const int fraction = static_cast<int>(std::ceil(promoteFraction * static_cast<double>(candidates)));
+        return std::clamp(std::max(fraction, minimum), 0, candidates);
+    }
+
+    // 照合世代の結果。screening[i] / full[i] は同じ候補の予備選別スコアと本評価スコア (小さいほど良い)。
+    // minimumPromote は promoteCount に渡す値 (通過枠の判定を実運用と揃える)
+    void recordCheck(const double* screening, const double* full, int n, int eliteCount, int minimumPromote) noexcept
+    {
+        ++stats.checkGenerations;
+        if (n < 3 || n > MaxCandidates)
+        {
+            trusted = false;
+            return;
+        }
+
+        const double correlation = spearmanRankCorrelation<MaxCandidates>(screening, full, n);
+
+        // 予備選別の順位で promoteCount 位以内に入った候補の集合に、本評価の上位 eliteCount が含まれるか
+        std::array<int, MaxCandidates> byScreening {};
+        std::array<int, MaxCandidates> byFull {};
+        std::iota(byScreening.begin(), byScreening.begin() + n, 0);
+        std::iota(byFull.begin(), byFull.begin() + n, 0);
+        std::sort(byScreening.begin(), byScreening.begin() + n, [screening](int x, int y) { return screening[x] < screening[y]; });
+        std::sort(byFull.begin(), byFull.begin() + n, [full](int x, int y) { return full[x] < full[y]; });
+
+        std::array<bool, MaxCandidates> promoted {};
+        const int promote = promoteCount(n, minimumPromote);
+        for (int i = 0; i < promote; ++i)
+            promoted[static_cast<size_t>(byScreening[static_cast<size_t>(i)])] = true;
+
+        int missed = 0;
+        for (int i = 0; i < std::min(eliteCount, n); ++i)
+            missed += promoted[static_cast<size_t>(byFull[static_cast<size_t>(i)])] ? 0 : 1;
+
+        if (missed > 0)
+            promoteFraction = std::min(1.0, promoteFraction * kWidenFactor);
+        else if (correlation >= kNarrowRankCorrelation)
+            promoteFraction = std::max(kMinPromoteFraction, promoteFraction * kNarrowFactor);
+
+        trusted = correlation >= kMinRankCorrelation;
+        stats.missedElites += static_cast<std::uint64_t>(missed);
+        stats.lastRankCorrelation = correlation;
+    }
+
+    [[nodiscard]] Stats snapshotStats() const noexcept
+    {
+        Stats s = stats;
+        s.promoteFraction = promoteFraction;
+        s.trusted = trusted;
+        return s;
+    }
+
+private:
+    int generationsSinceCheck = kCheckInterval;
+    bool trusted = false;
+    double promoteFraction = kInitialPromoteFraction;
+    Stats stats {};
+};
+
+} // namespace convo
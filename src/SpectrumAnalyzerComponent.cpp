@@ -4,15 +4,9 @@
 // スペクトラムアナライザー＋EQ応答曲線＋レベルメーター・ピーク保持
 //============================================================================
 #include "SpectrumAnalyzerComponent.h"
-#include "DftiHandle.h"
 #include <cmath>
 #include <algorithm>
 #include <complex>
-#if defined(__AVX2__)
-#include <immintrin.h>
-
-#include "audioengine/AtomicAccess.h"
-#endif
 
 namespace
 {
@@ -49,31 +43,14 @@ namespace
 //--------------------------------------------------------------
 SpectrumAnalyzerComponent::SpectrumAnalyzerComponent(AudioEngine& audioEngine)
     : engine(audioEngine),
-      rcuReader(audioEngine.getRetireRouter()),
-    fftTimeDomainBuffer(convo::makeAlignedArray<float>(NUM_FFT_POINTS)),
-    fftWorkBuffer(convo::makeAlignedArray<float>(NUM_FFT_POINTS * 2))
+      rcuReader(audioEngine.getRetireRouter())
 {
-    // ScopedAlignedPtr handles memory management and exception safety automatically.
-    juce::FloatVectorOperations::clear(fftTimeDomainBuffer.get(), NUM_FFT_POINTS);
-    juce::FloatVectorOperations::clear(fftWorkBuffer.get(), NUM_FFT_POINTS * 2);
-    rawBuffer.fill(MIN_DB);
-    smoothedBuffer.fill(MIN_DB);
-    peakBuffer.fill(MIN_DB);
-    peakHoldTime.fill(0.0);
+    spectrumFrame.barDb.fill(MIN_DB);
+    spectrumFrame.peakDb.fill(MIN_DB);
     eqResponseBufferL.fill(0.0f);
     eqResponseBufferR.fill(0.0f);
-
-    for (auto& band : individualBandCurvesL) band.fill(MIN_DB);
-    for (auto& band : individualBandCurvesR) band.fill(MIN_DB);
-    for (auto& band : individualBandCurvesMid) band.fill(MIN_DB);
-    for (auto& band : individualBandCurvesSide) band.fill(MIN_DB);
     // displayFrequencies and zCache are std::array, so no resize needed.
 
-    individualCurvePathsL.resize(EQProcessor::NUM_BANDS);
-    individualCurvePathsR.resize(EQProcessor::NUM_BANDS);
-    individualCurvePathsMid.resize(EQProcessor::NUM_BANDS);
-    individualCurvePathsSide.resize(EQProcessor::NUM_BANDS);
-
     // 表示用の周波数ポイントを事前に計算
     logMinFreq = std::log10(MIN_FREQ_HZ);
     logMaxFreq = std::log10(MAX_FREQ_HZ);
@@ -111,6 +88,9 @@ SpectrumAnalyzerComponent::SpectrumAnalyzerComponent(AudioEngine& audioEngine)
 
     lastTime = juce::Time::getMillisecondCounterHiRes() * 0.001;
     updateTimerRate();
+
+    // バーと曲線は OpenGL で描く。コンテキストができるまで (できない環境ではずっと) ソフトウェア描画
+    glRenderer = std::make_unique<SpectrumGLRenderer>(*this);
 }
 
 //--------------------------------------------------------------
@@ -119,6 +99,7 @@ SpectrumAnalyzerComponent::SpectrumAnalyzerComponent(AudioEngine& audioEngine)
 SpectrumAnalyzerComponent::~SpectrumAnalyzerComponent()
 {
     stopTimer();
+    glRenderer.reset();   // GL スレッドの paint() を止めてから他のメンバを壊す
     disableAnalyzer();
     engine.removeChangeListener(this);
 }
@@ -148,18 +129,24 @@ void SpectrumAnalyzerComponent::setAnalyzerEnabled(bool enabled)
 
 void SpectrumAnalyzerComponent::enableAnalyzer()
 {
+    if (analyzerWorker != nullptr)
+        return;
+
     convo::publishAtomic(analyzerState, AnalyzerState::Initializing, std::memory_order_release);
     engine.setAnalyzerEnabled(false);
 
-    prepareFFT();
-
-    if (fftHandle.get() == nullptr || fftTimeDomainBuffer.get() == nullptr || fftWorkBuffer.get() == nullptr)
+    auto worker = std::make_unique<SpectrumAnalyzerWorker>(engine, displayFrequencies);
+    if (!worker->prepare())
     {
         convo::publishAtomic(analyzerState, AnalyzerState::Disabled, std::memory_order_release);
         engine.setAnalyzerEnabled(false);
         return;
     }
 
+    worker->setPaused(!isShowing());
+    worker->startThread(juce::Thread::Priority::low);
+    analyzerWorker = std::move(worker);
+
     convo::publishAtomic(analyzerState, AnalyzerState::Ready, std::memory_order_release);
     engine.setAnalyzerEnabled(true);
 }
@@ -168,7 +155,7 @@ void SpectrumAnalyzerComponent::disableAnalyzer()
 {
     convo::publishAtomic(analyzerState, AnalyzerState::Disabled, std::memory_order_release);
     engine.setAnalyzerEnabled(false);
-    releaseFFT();
+    analyzerWorker.reset();   // スレッドを止めてから FFT と解析状態を捨てる
 }
 
 bool SpectrumAnalyzerComponent::updateLevelPeaks(double dt) noexcept
@@ -178,8 +165,10 @@ bool SpectrumAnalyzerComponent::updateLevelPeaks(double dt) noexcept
     const double prevInputPeakHoldTimer = inputPeakHoldTimer;
     const double prevOutputPeakHoldTimer = outputPeakHoldTimer;
 
-    const float inDb  = engine.getInputLevel();
-    const float outDb = engine.getOutputLevel();
+    // 入出力を同じコールバック時点の組として 1 回で読む
+    const auto levels = engine.getAudioObservation();
+    const float inDb  = AudioEngine::levelToDecibels(levels.inputLevelLinear);
+    const float outDb = AudioEngine::levelToDecibels(levels.outputLevelLinear);
 
     if (inDb > inputPeakDb)
     {
@@ -238,44 +227,27 @@ void SpectrumAnalyzerComponent::updateTimerRate()
         stopTimer();
 }
 
-void SpectrumAnalyzerComponent::prepareFFT()
-{
-    if (fftHandle.get() != nullptr)
-        return;
-
-    // Complex 1D FFT, Single Precision
-    // リアルタイム性を考慮し、事前にDescriptorを作成・コミットしておく
-    convo::ScopedDftiDescriptor localDfti;
-    if (DftiCreateDescriptor(localDfti.put(), DFTI_SINGLE, DFTI_COMPLEX, 1, NUM_FFT_POINTS) != DFTI_NO_ERROR) {
-        return;
-    }
-    if (DftiSetValue(localDfti.handle, DFTI_PLACEMENT, DFTI_INPLACE) != DFTI_NO_ERROR) {
-        return;
-    }
-    if (DftiCommitDescriptor(localDfti.handle) != DFTI_NO_ERROR) {
-        return;
-    }
-
-    fftHandle.reset(localDfti.release());
-
-    jassert(fftHandle.get() != nullptr);
-    // ★ [P0-3] Release 安全ガード: nullptr なら何もしない
-    if (fftHandle.get() == nullptr) [[unlikely]]
-        return;
-}
-
-void SpectrumAnalyzerComponent::releaseFFT()
-{
-    fftHandle.reset();
-}
-
 //--------------------------------------------------------------
-// timerCallback  ──  ~60fps で呼ばれる (UI Thread)
+// timerCallback  ──  ~60fps で呼ばれる (UI Thread)。解析は SpectrumAnalyzerWorker
 //--------------------------------------------------------------
 void SpectrumAnalyzerComponent::timerCallback()
 {
     updateTimerRate();
 
+    // OpenGL の開始・終了に合わせて描画経路を切り替える (開始時はメッシュを一式渡してから任せる)
+    if (const bool gpu = isGpuRendering(); gpu != gpuMeshesValid)
+    {
+        if (gpu)
+        {
+            publishSpectrumMesh();
+            publishCurveMesh();
+        }
+        gpuMeshesValid = gpu;
+        eqPathsDirty = !gpu;
+        if (isShowing())
+            repaint();
+    }
+
     // 時間計測 (フレームレート非依存化)
     const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
     const double dt = std::max(0.0, now - lastTime);
@@ -313,225 +285,55 @@ void SpectrumAnalyzerComponent::timerCallback()
         lastEqUpdateTime = now;
     }
 
-    // ピークホールド用の指数関数的減衰係数。時定数から導出する。
-    // これにより、減衰がフレームレートに依存しなくなり、かつ直線的な減衰よりも滑らかなカーブを描く。
-    const float peakDecayTimeConstant = 0.4f; // 秒単位。値が大きいほどゆっくり減衰する。
-    const float peakDecayFactor = std::exp(-static_cast<float>(dt) / peakDecayTimeConstant);
-
     // スペアナがOFFの場合、スペアナグラフを一度だけクリア
     if (!analyzerEnableButton.getToggleState())
     {
         bool needsRepaint = meterVisualChanged || eqPathsDirty;
+        const bool clearing = !analyzerVisualsCleared;
 
-        if (!analyzerVisualsCleared)
+        if (clearing)
         {
-            smoothedBuffer.fill(MIN_DB);
-            peakBuffer.fill(MIN_DB);
+            spectrumFrame.barDb.fill(MIN_DB);
+            spectrumFrame.peakDb.fill(MIN_DB);
             analyzerVisualsCleared = true;
             needsRepaint = true;
         }
 
         if (needsRepaint && isShowing())
-            repaint();
+            repaintPlot(clearing);
         return;
     }
     analyzerVisualsCleared = false;
 
-    if (!isShowing() || !analyzerEnableButton.getToggleState()) return;
+    if (analyzerWorker == nullptr) return;
     if (convo::consumeAtomic(analyzerState, std::memory_order_acquire) != AnalyzerState::Ready) return;
-    if (fftHandle.get() == nullptr) return;
-
-
-    // ── FFTデータの取得とスムーシング ──
-
-    // FIFOの利用可能データ数をチェック
-    const int available = engine.getFifoNumReady();
-    // 十分なデータがあるか確認 (FFTサイズ分のデータが揃うまで待つことでアンダーラングリッチを防ぐ)
-    const int required = OVERLAP_SAMPLES;
-
-    // データ不足 → スキップ (データ不足の場合は何もしない)
-    if (available < required)
-    {
-        underflowCount++;
-
-        // 60フレーム連続でアンダーランした場合 (60fpsで1.0秒)、
-        // エンジンが停止したとみなす。
-        // 以前はタイマーを停止していたが、オーディオ再開時の自動復帰を保証するため
-        // タイマーは継続し、カウンタの上限のみ制限する。
-        if (underflowCount > 60)
-        {
-            underflowCount = 61;
-        }
-
-        // 短期間のデータ不足（バッファ待ちなど）では減衰させず、表示を維持する (Flicker防止)
-        if (underflowCount > 3)
-        {
-            bool needsRepaint = false;
-            // アンダーラン時は「減衰保持」 (Decay Hold)
-            // 視覚的に自然にフェードアウトさせる
-            for (size_t i = 0; i < smoothedBuffer.size(); ++i)
-            {
-                if (smoothedBuffer[i] > MIN_DB || peakBuffer[i] > MIN_DB)
-                {
-                    smoothedBuffer[i] -= UNDERRUN_DECAY_DB;
-                    if (smoothedBuffer[i] < MIN_DB) smoothedBuffer[i] = MIN_DB;
-
-                    // ピーク保持の更新 (減衰時もピークロジックを継続)
-                    if (peakHoldTime[i] > 0.0)
-                    {
-                        peakHoldTime[i] = std::max(0.0, peakHoldTime[i] - dt);
-                    }
-                    else
-                    {
-                        // 指数関数的に現在のスムージング値に向かって減衰
-                        peakBuffer[i] = smoothedBuffer[i] + (peakBuffer[i] - smoothedBuffer[i]) * peakDecayFactor;
-                    }
-                    if (peakBuffer[i] < MIN_DB) peakBuffer[i] = MIN_DB;
-                    needsRepaint = true;
-                }
-            }
-            if (needsRepaint) repaint();
-        }
 
+    // 非表示の間は解析を止める。表示中は出来上がったフレームがあれば取り込んで描き直す
+    const bool showing = isShowing();
+    analyzerWorker->setPaused(!showing);
+    if (!showing)
         return;
-    }
-
-    // FIFOオーバーフロー防止 / レイテンシー削減
-    // データが過剰に溜まっている場合、最新のデータのみを取得するために古いデータをスキップする
-    if (available > required * 4)
-    {
-        engine.skipFifo(available - required);
-    }
-
-    underflowCount = 0;
-
-    // 1. 既存データを左にシフト (古いデータを破棄)
-    std::memmove(fftTimeDomainBuffer.get(),
-                 fftTimeDomainBuffer.get() + OVERLAP_SAMPLES,
-                 (NUM_FFT_POINTS - OVERLAP_SAMPLES) * sizeof(float));
-
-        //アンダーフローカウンタをリセット
-        // 2. FIFOから新しいデータを読み込み
-
-    // 2. FIFOから新しいデータを読み込み
-
-    engine.readFromFifo(fftTimeDomainBuffer.get() + (NUM_FFT_POINTS - OVERLAP_SAMPLES), OVERLAP_SAMPLES);
-
-      // 安全対策: NaN/Infチェック
-    // 万が一DSP処理で不正な値が発生しても、アナライザーでクラッシュさせない
-    for (int i = 0; i < NUM_FFT_POINTS; ++i)
-    {
-        if (!std::isfinite(fftTimeDomainBuffer.get()[i]))
-            fftTimeDomainBuffer.get()[i] = 0.0f;
-    }
-
-
-    // 3. 窓関数適用とFFT実行
-    // MKL: Real -> Complex conversion + Windowing
-    // fftWorkBuffer is float array of size NUM_FFT_POINTS * 2
-    // We treat it as interleaved complex: re, im, re, im...
-    if (fftHandle.get() == nullptr) return;
-
-   { const float* src = fftTimeDomainBuffer.get();
-        float* dst = fftWorkBuffer.get();
-
-        // Step 3a: Copy and Window (Real)
-        std::memcpy(dst, src, NUM_FFT_POINTS * sizeof(float));
-        window.multiplyWithWindowingTable(dst, NUM_FFT_POINTS);
-
-        // Step 3b: Expand to Complex (Interleaved)
-        // Expand in-place backwards to avoid overwriting
-        for (int i = NUM_FFT_POINTS - 1; i >= 0; --i)
-        {
-            dst[2 * i] = dst[i];     // Real
-            dst[2 * i + 1] = 0.0f;   // Imag
-        }
-
-        // Step 3c: FFT (Forward)
-        if (DftiComputeForward(fftHandle.get(), dst) != DFTI_NO_ERROR)
-            return;
-
-        // Step 4: Magnitude (dB)
-        const int numBins = std::min(static_cast<int>(rawBuffer.size()), NUM_FFT_BINS);
-#if defined(__AVX2__)
-        int i = 0;
-        const int vEnd = numBins / 8 * 8;
-        const __m256 vScale = _mm256_set1_ps(FFT_MAGNITUDE_SCALE);
-
-        for (; i < vEnd; i += 8)
-        {
-            const float* binPtr = dst + (2 * i);
-
-            __m256 c0 = _mm256_loadu_ps(binPtr + 0);   // re0 im0 re1 im1 ... re3 im3
-            __m256 c1 = _mm256_loadu_ps(binPtr + 8);   // re4 im4 re5 im5 ... re7 im7
-
-            __m256 re = _mm256_shuffle_ps(c0, c1, _MM_SHUFFLE(2, 0, 2, 0));
-            __m256 im = _mm256_shuffle_ps(c0, c1, _MM_SHUFFLE(3, 1, 3, 1));
-
-            __m256 mag2 = _mm256_add_ps(_mm256_mul_ps(re, re), _mm256_mul_ps(im, im));
-            __m256 mag = _mm256_mul_ps(_mm256_sqrt_ps(mag2), vScale);
-
-            alignas(64) float mags[8];
-            _mm256_store_ps(mags, mag);
-
-            for (int k = 0; k < 8; ++k)
-                rawBuffer[i + k] = (mags[k] > FFT_DISPLAY_MIN_MAG)
-                    ? juce::Decibels::gainToDecibels(mags[k])
-                    : FFT_DISPLAY_MIN_DB;
-        }
-
-        for (; i < numBins; ++i)
-        {
-            const float re = dst[2 * i];
-            const float im = dst[2 * i + 1];
-            const float magnitude = std::sqrt(re * re + im * im) * FFT_MAGNITUDE_SCALE;
-            rawBuffer[i] = (magnitude > FFT_DISPLAY_MIN_MAG)
-                ? juce::Decibels::gainToDecibels(magnitude)
-                : FFT_DISPLAY_MIN_DB;
-        }
-#else
-        for (int i = 0; i < numBins; ++i)
-        {
-            float re = dst[2 * i];
-            float im = dst[2 * i + 1];
-            float magnitude = std::sqrt(re * re + im * im) * FFT_MAGNITUDE_SCALE;
-
-            rawBuffer[i] = (magnitude > FFT_DISPLAY_MIN_MAG) ? juce::Decibels::gainToDecibels(magnitude) : FFT_DISPLAY_MIN_DB;
-        }
-#endif
-    }
-
 
+    const bool newFrame = analyzerWorker->takeFrame(spectrumFrame);
+    if (newFrame || meterVisualChanged)
+        repaintPlot(newFrame);
+}
 
-    for (size_t i = 0; i < smoothedBuffer.size(); ++i)
+//--------------------------------------------------------------
+// repaintPlot  ──  OpenGL 描画中は変わったメッシュだけを渡してから repaint する
+//--------------------------------------------------------------
+void SpectrumAnalyzerComponent::repaintPlot(bool spectrumChanged)
+{
+    if (gpuMeshesValid)
     {
-        smoothedBuffer[i] = SMOOTHING_ALPHA * smoothedBuffer[i]
-                            + (1.0f - SMOOTHING_ALPHA) * rawBuffer[i];
-
-        // ── ピーク保持の更新 ──
-        if (smoothedBuffer[i] >= peakBuffer[i])
+        if (spectrumChanged)
+            publishSpectrumMesh();
+        if (eqPathsDirty)
         {
-            // 現在値がピーク以上なら更新し、保持カウンタをリセット
-            peakBuffer[i]      = smoothedBuffer[i];
-            peakHoldTime[i]    = PEAK_HOLD_SEC;
-        }
-        else
-        {
-            // カウンタを減らし、0になったらピークを現在値に落とす
-            if (peakHoldTime[i] > 0.0)
-            {
-                peakHoldTime[i] = std::max(0.0, peakHoldTime[i] - dt);
-            }
-            else
-            {
-                // 指数関数的に現在のスムージング値に向かって減衰させる
-                // これにより、直線的な減衰よりも滑らかなカーブを描き、
-                // スムージング値に近づいた際の「カクン」という不自然な停止を防ぐ
-                peakBuffer[i] = smoothedBuffer[i] + (peakBuffer[i] - smoothedBuffer[i]) * peakDecayFactor;
-            }
+            publishCurveMesh();
+            eqPathsDirty = false;
         }
     }
-
     repaint();
 }
 
@@ -561,14 +363,12 @@ void SpectrumAnalyzerComponent::changeListenerCallback (juce::ChangeBroadcaster*
 //--------------------------------------------------------------
 void SpectrumAnalyzerComponent::paint(juce::Graphics& g)
 {
-    // Note: Direct2D (Windows) / CoreGraphics (macOS) によりハードウェアアクセラレーションが効きます。
-    //----------------------------------------------------------
-
-
-
+    // OpenGL 描画中はバーと EQ 曲線を SpectrumGLRenderer が下に描いており、ここではその上に重ねる
+    // グリッド・文字・レベルメーターだけを描く (paint 自体も GL スレッドで OpenGL の Graphics に描かれる)
+    const bool gpu = gpuMeshesValid;
 
+    //----------------------------------------------------------
     // レイアウト分割:
-
     //   [左側: スペクトラム + EQ曲線 + グリッド]
     //   [右側: レベルメーター (入/出 2バー)]
     //----------------------------------------------------------
@@ -581,14 +381,16 @@ void SpectrumAnalyzerComponent::paint(juce::Graphics& g)
     //----------------------------------------------------------
     // 背景とプロットエリア
     //----------------------------------------------------------
-    g.setColour(juce::Colours::black.withAlpha(0.9f));
-    g.fillRoundedRectangle(getLocalBounds().toFloat(), 5.0f);
-
+    if (!gpu)
+    {
+        g.setColour(juce::Colours::black.withAlpha(0.9f));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 5.0f);
+    }
 
     if (plotArea.getWidth() <= 0 || plotArea.getHeight() <= 0) return;
 
     // 描画負荷軽減: パスの再生成が必要な場合のみ実行
-    if (eqPathsDirty)
+    if (!gpu && eqPathsDirty)
     {
         updateEQPaths();
         eqPathsDirty = false;
@@ -597,11 +399,17 @@ void SpectrumAnalyzerComponent::paint(juce::Graphics& g)
     // ── グリッド描画 ──
     paintGrid(g, plotArea);
 
-    // ── スペクトラム棒グラフ + ピーク保持描画 ──
-    paintSpectrum(g, plotArea);
+    if (!gpu)
+    {
+        // ── スペクトラム棒グラフ + ピーク保持描画 ──
+        paintSpectrum(g, plotArea);
+
+        // ── EQ応答曲線描画 ──
+        paintEQCurve(g, plotArea);
+    }
 
-    // ── EQ応答曲線描画 ──
-    paintEQCurve(g, plotArea);
+    // ── 各バンドの位置 ──
+    paintEQPoints(g, plotArea);
 
     // ── プロットエリアの枠線 ──
     g.setColour(juce::Colours::white.withAlpha(0.35f));
@@ -661,6 +469,14 @@ void SpectrumAnalyzerComponent::resized()
         // 最後のバーの終端はプロットエリアの右端
         barXCoords[NUM_DISPLAY_BARS] = plotW;
     }
+
+    // OpenGL 描画中はレイアウトに合わせてメッシュを作り直す (paint の重ね描きとずれないよう即時)
+    if (gpuMeshesValid)
+    {
+        publishSpectrumMesh();
+        publishCurveMesh();
+        eqPathsDirty = false;
+    }
 }
 
 //--------------------------------------------------------------
@@ -765,31 +581,10 @@ void SpectrumAnalyzerComponent::paintSpectrum(juce::Graphics& g, const juce::Rec
     [[maybe_unused]] const float plotW = static_cast<float>(area.getWidth());
     const float plotH = static_cast<float>(area.getHeight());
 
-    // FIFOに書き込まれるデータはオーバーサンプリング後のレート（処理サンプルレート）で
-    const double sampleRate = engine.getProcessingSampleRate();
-    if (sampleRate <= 0.0) return;
-
-    const float binFactor = NUM_FFT_POINTS / static_cast<float>(sampleRate);
-    const float nyquist = static_cast<float>(sampleRate) / 2.0f;
-
+    // バーごとの dB は SpectrumAnalyzerWorker が FFT ビンから補間し、[MIN_DB, MAX_DB] に clamp 済み
     for (int bar = 0; bar < NUM_DISPLAY_BARS; ++bar)
     {
-        // 事前計算された周波数を使用 (pow/log計算を回避)
-        const float freq = std::min(displayFrequencies[bar], nyquist);
-
-        // 周波数 → FFTビンインデックス (補間用にfloatで計算)
-        float binIdx = freq * binFactor;
-
-        // 範囲外アクセスを防ぐため、binIdxを先に有効な範囲にクランプする
-        binIdx = std::max(0.0f, std::min(binIdx, static_cast<float>(NUM_FFT_BINS - 1)));
-
-        int idx0 = static_cast<int>(binIdx);
-        int idx1 = std::min(idx0 + 1, NUM_FFT_BINS - 1); // idx0がNUM_FFT_BINS-1の場合、idx1も同じ値になる
-        float frac = binIdx - idx0;
-
-        // スムーシング済みのdB値 (線形補間)
-        float db = smoothedBuffer[idx0] * (1.0f - frac) + smoothedBuffer[idx1] * frac;
-        db = std::max(MIN_DB, std::min(MAX_DB, db));
+        const float db = spectrumFrame.barDb[static_cast<size_t>(bar)];
 
         // 棒の高さ
         const float normalizedLevel = (db - MIN_DB) / (MAX_DB - MIN_DB);
@@ -808,9 +603,7 @@ void SpectrumAnalyzerComponent::paintSpectrum(juce::Graphics& g, const juce::Rec
         g.fillRect(barX, barY, barWidth, barH);
 
         // ── ピーク保持の描画 ──
-        // ピーク値も同様に補間
-        float peakDb = peakBuffer[idx0] * (1.0f - frac) + peakBuffer[idx1] * frac;
-        peakDb = std::max(MIN_DB, std::min(MAX_DB, peakDb));
+        const float peakDb = spectrumFrame.peakDb[static_cast<size_t>(bar)];
         const float peakNorm = (peakDb - MIN_DB) / (MAX_DB - MIN_DB);
         const float peakY = plotY + plotH - peakNorm * plotH;
 
@@ -821,11 +614,14 @@ void SpectrumAnalyzerComponent::paintSpectrum(juce::Graphics& g, const juce::Rec
 }
 
 //--------------------------------------------------------------
-// updateEQData  ──  EQ応答曲線とパスを再計算 (パラメータ変更時)
+// updateEQData  ──  EQ応答曲線を再計算 (パラメータ変更時・定期)
+// 変わったバンドと総合曲線だけに印を付け、何か変わったときだけ eqPathsDirty を立てる
 //--------------------------------------------------------------
 void SpectrumAnalyzerComponent::updateEQData()
 {
+    bool changed = false;
     const double sr = engine.getProcessingSampleRate();
+    std::array<float, NUM_DISPLAY_BARS> totalL, totalR;
     if (sr > 0.0)
     {
         // サンプルレートが変更された場合のみ zCache (z = e^jw) を再計算
@@ -841,166 +637,216 @@ void SpectrumAnalyzerComponent::updateEQData()
         }
 
         // ── 総合EQ応答曲線の計算 ──
-        // キャッシュされた zCache (複素平面上の単位円) を使用して高速化
-        engine.calcEQResponseCurve(eqResponseBufferL.data(), eqResponseBufferR.data(), zCache.data(), NUM_DISPLAY_BARS, sr);
+        // キャッシュされた zCache (複素平面上の単位円) を使用して高速化。バンドごとの応答はエンジン側でもキャッシュ済み
+        engine.calcEQResponseCurve(totalL.data(), totalR.data(), zCache.data(), NUM_DISPLAY_BARS, sr);
 
         // 線形マグニチュードをdBに変換
         for (int i = 0; i < NUM_DISPLAY_BARS; ++i)
         {
-            eqResponseBufferL[i] = juce::Decibels::gainToDecibels(std::max(eqResponseBufferL[i], 1.0e-9f));
-            eqResponseBufferR[i] = juce::Decibels::gainToDecibels(std::max(eqResponseBufferR[i], 1.0e-9f));
+            totalL[i] = juce::Decibels::gainToDecibels(std::max(totalL[i], 1.0e-9f));
+            totalR[i] = juce::Decibels::gainToDecibels(std::max(totalR[i], 1.0e-9f));
         }
 
         for (int b = 0; b < EQProcessor::NUM_BANDS; ++b)
         {
+            auto& curve = bandCurves[static_cast<size_t>(b)];
             const auto params = engine.getEQBandParams(b);
-            if (!params.enabled)
+            const EQBandType type = engine.getEQBandType(b);
+            const EQChannelMode mode = engine.getEQBandChannelMode(b);
+
+            // 描かないバンド (無効、または LP/HP 以外でゲインがほぼ 0) はキー 0
+            const bool visible = params.enabled
+                              && (type == EQBandType::LowPass || type == EQBandType::HighPass || std::abs(params.gain) >= 0.01f);
+            uint64_t key = 0;
+            if (visible)
             {
-                individualBandCurvesL[b].fill(0.0f);
-                individualBandCurvesR[b].fill(0.0f);
-                continue;
+                key = EQProcessor::computeBandResponseHash(params, type, sr)
+                    ^ ((static_cast<uint64_t>(mode) + 1) * 0x9e3779b97f4a7c15ULL);
+                key = (key != 0) ? key : 1;
             }
+            if (key == curve.key)
+                continue;
+
+            curve.key = key;
+            curve.mode = mode;
+            curve.pointsDirty = true;
+            changed = true;
+            if (!visible)
+                continue;
 
-            EQBandType type = engine.getEQBandType(b);
             // グラフ描画用にBiquad係数を計算
             // 音声処理にはSVFを使用しているが、周波数応答の計算には
             // 等価な特性を持つBiquad係数を使用することで、標準的な計算式(getMagnitudeSquared)を流用している。
-           EQCoeffsSVF svf = EQProcessor::calcSVFCoeffs(type, params.frequency, params.gain, params.q, sr);
+            EQCoeffsSVF svf = EQProcessor::calcSVFCoeffs(type, params.frequency, params.gain, params.q, sr);
             EQCoeffsBiquad c = EQProcessor::svfToDisplayBiquad(svf);
-           EQChannelMode mode = engine.getEQBandChannelMode(b);
 
             std::array<float, NUM_DISPLAY_BARS> bandMagSq{};
             calcBandMagnitudeSq(c, zCache.data(), bandMagSq.data(), NUM_DISPLAY_BARS);
 
             for (int i = 0; i < NUM_DISPLAY_BARS; ++i)
-            {
-                float mag = std::sqrt(bandMagSq[i]);
-                float db = juce::Decibels::gainToDecibels(mag);
-                if (mode == EQChannelMode::Stereo || mode == EQChannelMode::Left)  individualBandCurvesL[b][i] = db; else individualBandCurvesL[b][i] = 0.0f;
-                if (mode == EQChannelMode::Stereo || mode == EQChannelMode::Right) individualBandCurvesR[b][i] = db; else individualBandCurvesR[b][i] = 0.0f;
-                if (mode == EQChannelMode::Mid)  individualBandCurvesMid[b][i] = db; else individualBandCurvesMid[b][i] = 0.0f;
-                if (mode == EQChannelMode::Side) individualBandCurvesSide[b][i] = db; else individualBandCurvesSide[b][i] = 0.0f;
-            }
+                curve.db[static_cast<size_t>(i)] = juce::Decibels::gainToDecibels(std::sqrt(bandMagSq[i]));
         }
-
     }
     else
     {
         // サンプルレートが無効な場合はクリア
-        eqResponseBufferL.fill(0.0f);
-        eqResponseBufferR.fill(0.0f);
+        totalL.fill(0.0f);
+        totalR.fill(0.0f);
     }
 
-    eqPathsDirty = true;
+    if (totalL != eqResponseBufferL || totalR != eqResponseBufferR)
+    {
+        eqResponseBufferL = totalL;
+        eqResponseBufferR = totalR;
+        totalPointsDirty = true;
+        changed = true;
+    }
+
+    if (changed)
+        eqPathsDirty = true;
     // repaint() は timerCallback で行われるので、ここでは不要
 }
 
 //--------------------------------------------------------------
-// updateEQPaths  ──  EQ曲線のパスを生成 (Timer Callback内)
+// updateEQGeometry  ──  印の付いた曲線 (レイアウトが変わったら全部) の点列を画面座標で作り直す
 //--------------------------------------------------------------
-void SpectrumAnalyzerComponent::updateEQPaths()
+void SpectrumAnalyzerComponent::updateEQGeometry()
 {
     if (plotArea.isEmpty()) return;
 
-    const float plotX = static_cast<float>(plotArea.getX());
     const float plotY = static_cast<float>(plotArea.getY());
-    const float plotW = static_cast<float>(plotArea.getWidth());
     const float plotH = static_cast<float>(plotArea.getHeight());
 
-    auto createPath = [&](juce::Path& path, const auto& buffer)
-{
-    path.clear();
-
-    for (int i = 0; i < NUM_DISPLAY_BARS; ++i)
+    const bool layoutChanged = plotArea != curveGeometryArea;
+    if (layoutChanged)
     {
-        // displayFrequenciesは対数配置済み
-        const float freq = displayFrequencies[i];
-
-        // freqToX() を使用して正しい対数＋Low-end補正マッピングを適用
-        const float x = plotX + freqToX(freq, plotW);
+        curveGeometryArea = plotArea;
+        const float plotX = static_cast<float>(plotArea.getX());
+        const float plotW = static_cast<float>(plotArea.getWidth());
+        // displayFrequenciesは対数配置済み。freqToX() で対数＋Low-end補正マッピングを適用
+        for (int i = 0; i < NUM_DISPLAY_BARS; ++i)
+            curveXCoords[static_cast<size_t>(i)] = plotX + freqToX(displayFrequencies[i], plotW);
+    }
 
-        float db = buffer[i];
-        db = std::max(MIN_DB, std::min(MAX_DB, db));
-        const float y = plotY + dbToY(db, plotH);
+    auto toPoints = [&](CurvePoints& points, const std::array<float, NUM_DISPLAY_BARS>& buffer) {
+        for (size_t i = 0; i < points.size(); ++i)
+            points[i] = { curveXCoords[i], plotY + dbToY(std::max(MIN_DB, std::min(MAX_DB, buffer[i])), plotH) };
+    };
 
-        if (i == 0)
-            path.startNewSubPath(x, y);
-        else
-            path.lineTo(x, y);
+    for (auto& curve : bandCurves)
+    {
+        if (!layoutChanged && !curve.pointsDirty)
+            continue;
+        curve.pointsDirty = false;
+        curve.pathDirty = true;
+        if (curve.key != 0)
+            toPoints(curve.points, curve.db);
     }
-};
-
-    createPath(totalCurvePathL, eqResponseBufferL);
-    createPath(totalCurvePathR, eqResponseBufferR);
 
-    for (int b = 0; b < EQProcessor::NUM_BANDS; ++b)
+    if (layoutChanged || totalPointsDirty)
     {
-        createPath(individualCurvePathsL[b], individualBandCurvesL[b]);
-        createPath(individualCurvePathsR[b], individualBandCurvesR[b]);
-        createPath(individualCurvePathsMid[b], individualBandCurvesMid[b]);
-        createPath(individualCurvePathsSide[b], individualBandCurvesSide[b]);
+        toPoints(totalPointsL, eqResponseBufferL);
+        toPoints(totalPointsR, eqResponseBufferR);
+        totalPointsDirty = false;
+        totalPathsDirty = true;
     }
 }
 
 //--------------------------------------------------------------
-// paintEQCurve  ──  EQ応答曲線（白の折れ線）
+// updateEQPaths  ──  点列が変わった曲線だけパスを作り直す (ソフトウェア描画の paint 内)
 //--------------------------------------------------------------
-void SpectrumAnalyzerComponent::paintEQCurve(juce::Graphics& g, const juce::Rectangle<int>& area)
+void SpectrumAnalyzerComponent::updateEQPaths()
 {
-    // デバイス未接続時や初期化中はサンプルレートが0になるため、
-    // 周波数応答計算（除算）が不正になるのを防ぐ
-    if (engine.getProcessingSampleRate() <= 0.0) return;
+    updateEQGeometry();
+
+    auto createPath = [](juce::Path& path, const CurvePoints& points) {
+        path.clear();
+        path.preallocateSpace(static_cast<int>(points.size()) * 3);
+        path.startNewSubPath(points[0]);
+        for (size_t i = 1; i < points.size(); ++i)
+            path.lineTo(points[i]);
+    };
 
-    const float plotX = static_cast<float>(area.getX());
-    const float plotY = static_cast<float>(area.getY());
-    const float plotW = static_cast<float>(area.getWidth());
-    const float plotH = static_cast<float>(area.getHeight());
+    for (auto& curve : bandCurves)
+    {
+        if (!curve.pathDirty)
+            continue;
+        curve.pathDirty = false;
+        if (curve.key != 0)
+            createPath(curve.path, curve.points);
+        else
+            curve.path.clear();
+    }
 
-    // ── 各バンドの個別応答曲線を描画 ──
-    for (int b = 0; b < EQProcessor::NUM_BANDS; ++b)
+    if (totalPathsDirty)
     {
-        const auto params = engine.getEQBandParams(b);
-        if (!params.enabled) continue;
+        createPath(totalCurvePathL, totalPointsL);
+        createPath(totalCurvePathR, totalPointsR);
+        totalPathsDirty = false;
+    }
+}
 
-        EQBandType type = engine.getEQBandType(b);
-        if (type != EQBandType::LowPass && type != EQBandType::HighPass && std::abs(params.gain) < 0.01f) continue;
+//--------------------------------------------------------------
+// forEachVisibleEQCurve  ──  描く EQ 曲線を描画順に列挙する (ソフトウェア描画と OpenGL メッシュで共通)
+// fn(画面座標の点列, パス, 色, 線幅)。点列とパスは updateEQGeometry / updateEQPaths 済みであること
+//--------------------------------------------------------------
+template <typename Fn>
+void SpectrumAnalyzerComponent::forEachVisibleEQCurve(Fn&& fn) const
+{
+    // ── 各バンドの個別応答曲線 (Stereo は L/R の 2 色で同じ曲線を重ねる) ──
+    for (const auto& curve : bandCurves)
+    {
+        if (curve.key == 0) continue;
 
-        EQChannelMode mode = engine.getEQBandChannelMode(b);
+        const EQChannelMode mode = curve.mode;
 
         if (mode == EQChannelMode::Stereo || mode == EQChannelMode::Left)
-        {
-            g.setColour(juce::Colours::white.withAlpha(0.15f));
-            g.strokePath(individualCurvePathsL[b], juce::PathStrokeType(1.0f));
-        }
+            fn(curve.points, curve.path, juce::Colours::white.withAlpha(0.15f), 1.0f);
 
         if (mode == EQChannelMode::Stereo || mode == EQChannelMode::Right)
-        {
-            g.setColour(juce::Colours::red.withAlpha(0.15f));
-            g.strokePath(individualCurvePathsR[b], juce::PathStrokeType(1.0f));
-        }
+            fn(curve.points, curve.path, juce::Colours::red.withAlpha(0.15f), 1.0f);
 
         if (mode == EQChannelMode::Mid)
-        {
-            g.setColour(juce::Colours::cyan.withAlpha(0.15f));
-            g.strokePath(individualCurvePathsMid[b], juce::PathStrokeType(1.0f));
-        }
+            fn(curve.points, curve.path, juce::Colours::cyan.withAlpha(0.15f), 1.0f);
 
         if (mode == EQChannelMode::Side)
-        {
-            g.setColour(juce::Colours::magenta.withAlpha(0.15f));
-            g.strokePath(individualCurvePathsSide[b], juce::PathStrokeType(1.0f));
-        }
+            fn(curve.points, curve.path, juce::Colours::magenta.withAlpha(0.15f), 1.0f);
     }
 
-    // ── 総合EQ応答曲線を描画 (L/R) ──
+    // ── 総合EQ応答曲線 (L/R) ──
     // Right (Red)
-    g.setColour(juce::Colours::red.withAlpha(0.85f));
-    g.strokePath(totalCurvePathR, juce::PathStrokeType(1.5f));
+    fn(totalPointsR, totalCurvePathR, juce::Colours::red.withAlpha(0.85f), 1.5f);
     // Left (White)
-    g.setColour(juce::Colours::white.withAlpha(0.85f));
-    g.strokePath(totalCurvePathL, juce::PathStrokeType(1.5f));
+    fn(totalPointsL, totalCurvePathL, juce::Colours::white.withAlpha(0.85f), 1.5f);
+}
+
+//--------------------------------------------------------------
+// paintEQCurve  ──  EQ応答曲線（白の折れ線）
+//--------------------------------------------------------------
+void SpectrumAnalyzerComponent::paintEQCurve(juce::Graphics& g, [[maybe_unused]] const juce::Rectangle<int>& area)
+{
+    // デバイス未接続時や初期化中はサンプルレートが0になるため、
+    // 周波数応答計算（除算）が不正になるのを防ぐ
+    if (engine.getProcessingSampleRate() <= 0.0) return;
+
+    forEachVisibleEQCurve([&g](const CurvePoints&, const juce::Path& path, juce::Colour colour, float thickness) {
+        g.setColour(colour);
+        g.strokePath(path, juce::PathStrokeType(thickness));
+    });
+}
+
+//--------------------------------------------------------------
+// paintEQPoints  ──  各バンドの現在の周波数位置に丸を描画
+//--------------------------------------------------------------
+void SpectrumAnalyzerComponent::paintEQPoints(juce::Graphics& g, const juce::Rectangle<int>& area)
+{
+    if (engine.getProcessingSampleRate() <= 0.0) return;
+
+    const float plotX = static_cast<float>(area.getX());
+    const float plotY = static_cast<float>(area.getY());
+    const float plotW = static_cast<float>(area.getWidth());
+    const float plotH = static_cast<float>(area.getHeight());
 
-    // ── EQ曲線のポイント（各バンドの現在の周波数位置に丸を描画） ──
     // getBandParams で現在の周波数を動的に読む（パラメータ変更後も正確に移動）
     {
         for (int b = 0; b < EQProcessor::NUM_BANDS; ++b)
@@ -1052,6 +898,58 @@ void SpectrumAnalyzerComponent::paintEQCurve(juce::Graphics& g, const juce::Rect
     }
 }
 
+//--------------------------------------------------------------
+// publishSpectrumMesh  ──  バーとピーク線を OpenGL 用の三角形列にする (新しいフレームごと)
+//--------------------------------------------------------------
+void SpectrumAnalyzerComponent::publishSpectrumMesh()
+{
+    auto& mesh = glRenderer->spectrumMesh();
+    mesh.clear(getLocalBounds().getBottomRight().toFloat());
+
+    if (!plotArea.isEmpty())
+    {
+        const float plotX = static_cast<float>(plotArea.getX());
+        const float plotY = static_cast<float>(plotArea.getY());
+        const float plotH = static_cast<float>(plotArea.getHeight());
+
+        // 色と寸法は paintSpectrum と同じ
+        for (int bar = 0; bar < NUM_DISPLAY_BARS; ++bar)
+        {
+            const float normalizedLevel = (spectrumFrame.barDb[static_cast<size_t>(bar)] - MIN_DB) / (MAX_DB - MIN_DB);
+            const float barH = std::max(0.0f, std::min(plotH, normalizedLevel * plotH));
+            const float barX = plotX + barXCoords[bar];
+            const float barWidth = barXCoords[bar + 1] - barXCoords[bar];
+            const juce::Colour barColour = getLevelColour(normalizedLevel);
+            mesh.addRect({ barX, plotY + plotH - barH, barWidth, barH }, barColour);
+
+            const float peakNorm = (spectrumFrame.peakDb[static_cast<size_t>(bar)] - MIN_DB) / (MAX_DB - MIN_DB);
+            mesh.addRect({ barX, plotY + plotH - peakNorm * plotH, barWidth, 2.0f },
+                         barColour.brighter(0.6f).withAlpha(0.9f));
+        }
+    }
+
+    glRenderer->publishSpectrum();
+}
+
+//--------------------------------------------------------------
+// publishCurveMesh  ──  EQ 曲線を OpenGL 用の帯にする (EQ かレイアウトが変わったときだけ)
+//--------------------------------------------------------------
+void SpectrumAnalyzerComponent::publishCurveMesh()
+{
+    auto& mesh = glRenderer->curveMesh();
+    mesh.clear(getLocalBounds().getBottomRight().toFloat());
+
+    if (!plotArea.isEmpty() && engine.getProcessingSampleRate() > 0.0)
+    {
+        updateEQGeometry();   // 変わった曲線の点列だけ作り直す (パスは作らない)
+        forEachVisibleEQCurve([&mesh](const CurvePoints& points, const juce::Path&, juce::Colour colour, float thickness) {
+            mesh.addPolyline(points.data(), static_cast<int>(points.size()), thickness, colour);
+        });
+    }
+
+    glRenderer->publishCurves();
+}
+
 //--------------------------------------------------------------
 // paintLevelMeter  ──  入出力レベルメーター
 //
@@ -1073,9 +971,10 @@ void SpectrumAnalyzerComponent::paintLevelMeter(juce::Graphics& g, const juce::R
 
     if (area.getWidth() <= 0 || area.getHeight() <= 0) return;
 
-    // 入力・出力レベルの取得
-    const float inDb  = engine.getInputLevel();
-    const float outDb = engine.getOutputLevel();
+    // 入力・出力レベルの取得 (観測スナップショット 1 回)
+    const auto levels = engine.getAudioObservation();
+    const float inDb  = AudioEngine::levelToDecibels(levels.inputLevelLinear);
+    const float outDb = AudioEngine::levelToDecibels(levels.outputLevelLinear);
 
     // 各バーの幅
     const int barW = (meterBounds.getWidth() - gap) / 2;
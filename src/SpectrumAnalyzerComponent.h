@@ -4,17 +4,18 @@
 // スペクトラムアナライザー＋EQ応答曲線＋レベルメーター
 //
 // ■ 描画パイプライン設計:
-//   - Timer で定期的に (~60fps) FFTデータを取得し、表示を更新する
-//   - スムーシング（指数移動平均）で急激な変化を緩和
+//   - FFT・スムーシング・ピーク保持・表示バーへの写像は SpectrumAnalyzerWorker (LightBackground) が行い、
+//     出来上がったバー列を TripleBuffer で渡す。Timer (~60fps) は最新のフレームを取り込んで repaint するだけ
+//   - OpenGL が使えるときはバーと EQ 曲線を SpectrumGLRenderer の頂点バッファで描き、paint() は
+//     グリッド・文字・バンド位置の丸・レベルメーターだけを描く。頂点列はデータが変わったときだけ作り直す
 //   - 対数スケールの周波数軸で、人間の聴覚特性に合わせた表示
-//   - ピーク保持: 最大値を記録し、PEAK_HOLD_FRAMES フレーム間保持
 //   - EQ応答曲線: 128点で計算し、スペクトラム上に白の折れ線で描画
 //   - レベルメーター: 画面右側に入出力レベルの縦バーを配置
 //
 // ■ スレッド安全性:
 //   - timerCallback(), paint() は UI Thread のみ
-//   - engine.readFromFifo() は UI Thread から呼んで OK
-//   - engine.getInputLevel(), getOutputLevel(), calcEQResponseCurve()
+//   - engine.readFromFifo() / skipFifo() は SpectrumAnalyzerWorker だけが呼ぶ (analyzerFifo の単一リーダ)
+//   - engine.getAudioObservation() (入出力レベル), calcEQResponseCurve()
 //     も UI Thread から呼んで OK
 //
 // ■ 安定性ポイント:
@@ -26,8 +27,10 @@
 #include <JuceHeader.h>
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include "AudioEngine.h"
-#include "DftiHandle.h"
+#include "SpectrumAnalyzerWorker.h"
+#include "SpectrumGLRenderer.h"
 
 #include "audioengine/AtomicAccess.h"
 #include "core/RCUReader.h"
@@ -63,41 +66,38 @@ private:
 
     // ── 定数定義 (バッファサイズ決定のために先頭に配置) ──
     static constexpr int NUM_DISPLAY_BARS = AudioEngine::NUM_DISPLAY_BARS;
-    static constexpr int NUM_FFT_POINTS  = 4096;
-    static constexpr int NUM_FFT_BINS    = NUM_FFT_POINTS / 2 + 1;
-    static constexpr int OVERLAP_SAMPLES = NUM_FFT_POINTS / 4;
 
     // ── 表示範囲 ──
-    static constexpr float MIN_DB       = -80.0f;
-
-    // ── FFT設定 ──
-    static constexpr float FFT_MAGNITUDE_SCALE = 4.0f / NUM_FFT_POINTS;
-    static constexpr float FFT_DISPLAY_MIN_DB = -100.0f;
-    static constexpr float FFT_DISPLAY_MIN_MAG = 1e-9f;
-
-    convo::ScopedDftiDescriptor fftHandle;
-    juce::dsp::WindowingFunction<float> window { NUM_FFT_POINTS, juce::dsp::WindowingFunction<float>::hann };
-    // MKL/AVX-512用に64byteアライメントを保証するアロケータを使用
-    convo::ScopedAlignedPtr<float> fftTimeDomainBuffer;
-    convo::ScopedAlignedPtr<float> fftWorkBuffer;
-
-    // ── 表示用データバッファ ──
-    std::array<float, NUM_FFT_BINS> rawBuffer;        // readFromFifo で取得したデータから計算
-    std::array<float, NUM_FFT_BINS> smoothedBuffer;   // 指数移動平均で更新
-    std::array<float, NUM_FFT_BINS> peakBuffer;       // ピーク保持バッファ
-    std::array<double, NUM_FFT_BINS> peakHoldTime;    // 各バンドのピーク保持残り時間 (秒)
+    static constexpr float MIN_DB       = SpectrumAnalyzerWorker::MIN_DB;
+
+    // ── 表示用データバッファ (SpectrumAnalyzerWorker のフレームを取り込む) ──
+    std::unique_ptr<SpectrumAnalyzerWorker> analyzerWorker;   // アナライザー ON の間だけ存在する
+    SpectrumAnalyzerWorker::Frame spectrumFrame;               // バーごとの dB とピーク保持 (clamp 済み)
     std::array<float, NUM_DISPLAY_BARS + 1> barXCoords; // 各バーのX座標をキャッシュ
 
+    // ── OpenGL 描画 (使えない環境では isActive() が false のままでソフトウェア描画) ──
+    std::unique_ptr<SpectrumGLRenderer> glRenderer;
+    bool gpuMeshesValid = false;   // 現在のレイアウトでバーと曲線のメッシュを渡し済みか
+
     // ── EQ応答曲線データ ──
     std::array<float, NUM_DISPLAY_BARS> eqResponseBufferL;
     std::array<float, NUM_DISPLAY_BARS> eqResponseBufferR;
 
-    // 個別バンドの応答曲線データ (timerで計算、paintで描画)
-
-    std::array<std::array<float, NUM_DISPLAY_BARS>, EQProcessor::NUM_BANDS> individualBandCurvesL;
-    std::array<std::array<float, NUM_DISPLAY_BARS>, EQProcessor::NUM_BANDS> individualBandCurvesR;
-    std::array<std::array<float, NUM_DISPLAY_BARS>, EQProcessor::NUM_BANDS> individualBandCurvesMid{};
-    std::array<std::array<float, NUM_DISPLAY_BARS>, EQProcessor::NUM_BANDS> individualBandCurvesSide{};
+    // ── 個別バンドの応答曲線 (timer で計算、paint / GL メッシュで描画) ──
+    // バンドのパラメータ・チャンネルモード・サンプルレートのキーが変わったバンドだけ dB 列を計算し直し、
+    // 画面座標の点列とパスもそのバンドだけ作り直す (1 バンドのドラッグで 20 本を組み直さない)
+    using CurvePoints = std::array<juce::Point<float>, NUM_DISPLAY_BARS>;
+    struct BandCurve
+    {
+        uint64_t key = 0;               // 0 = 描かない (無効・ゲイン 0 のピーキング等)
+        EQChannelMode mode = EQChannelMode::Stereo;
+        std::array<float, NUM_DISPLAY_BARS> db {};
+        CurvePoints points {};          // curveGeometryArea 上の座標
+        juce::Path path;
+        bool pointsDirty = true;
+        bool pathDirty = true;
+    };
+    std::array<BandCurve, EQProcessor::NUM_BANDS> bandCurves;
     // 表示バーの中心周波数と、EQカーブ計算用の周波数ポイントを兼ねる
     std::array<float, NUM_DISPLAY_BARS> displayFrequencies;
 
@@ -105,22 +105,17 @@ private:
     std::array<std::complex<double>, NUM_DISPLAY_BARS> zCache; // 周波数応答計算用の複素数キャッシュ (z = e^jw)
     double cachedSampleRate = 0.0;            // zCache計算時のサンプルレート
 
-    // ── 描画用パスキャッシュ ──
+    // ── 総合曲線の点列とパス ──
+    CurvePoints totalPointsL {}, totalPointsR {};
     juce::Path totalCurvePathL, totalCurvePathR;
-    std::vector<juce::Path> individualCurvePathsL;
-    std::vector<juce::Path> individualCurvePathsR;
-    std::vector<juce::Path> individualCurvePathsMid;
-    std::vector<juce::Path> individualCurvePathsSide;
-
-    // ── スムーシング係数 ──
-    static constexpr float SMOOTHING_ALPHA = 0.85f; // 60fpsに合わせて調整 (0.75 -> 0.85)
+    bool totalPointsDirty = true;
+    bool totalPathsDirty = true;
+    juce::Rectangle<int> curveGeometryArea;                  // 点列を計算したときの plotArea
+    std::array<float, NUM_DISPLAY_BARS> curveXCoords {};     // その plotArea での各点の X 座標
 
     static constexpr float MIN_FREQ_HZ = 20.0f;
     static constexpr float MAX_FREQ_HZ = 20000.0f;
-    static constexpr float MAX_DB       = 20.0f;
-
-    // ── ピーク保持設定 ──
-    static constexpr double PEAK_HOLD_SEC = 1.0;
+    static constexpr float MAX_DB       = SpectrumAnalyzerWorker::MAX_DB;
 
     // ── レベルメーターのピークホールド設定 ──
     static constexpr double LEVEL_PEAK_HOLD_SEC          = 3.0;   // ピーク保持時間 (秒)
@@ -171,26 +166,29 @@ private:
     // ── サブ描画メソッド ──
     void paintSpectrum   (juce::Graphics& g, const juce::Rectangle<int>& area);
     void paintEQCurve    (juce::Graphics& g, const juce::Rectangle<int>& area);
+    void paintEQPoints   (juce::Graphics& g, const juce::Rectangle<int>& area);
     void paintLevelMeter (juce::Graphics& g, const juce::Rectangle<int>& area);
     void paintGrid       (juce::Graphics& g, const juce::Rectangle<int>& area);
 
-    void prepareFFT();
-    void releaseFFT();
     void enableAnalyzer();
     void disableAnalyzer();
 
     // ── パス生成ヘルパー ──
     void updateEQData();
+    void updateEQGeometry();
     void updateEQPaths();
+    template <typename Fn> void forEachVisibleEQCurve(Fn&& fn) const;
+
+    // ── OpenGL メッシュ ──
+    bool isGpuRendering() const noexcept { return glRenderer != nullptr && glRenderer->isActive(); }
+    void publishSpectrumMesh();
+    void publishCurveMesh();
+    void repaintPlot(bool spectrumChanged);
 
     juce::TextButton sourceButton;
     void updateSourceButtonText();
     juce::ToggleButton analyzerEnableButton;
 
-    // ── アンダーラン対策 ──
-    int underflowCount = 0;
-    static constexpr float UNDERRUN_DECAY_DB = 1.5f; // データ不足時の減衰量 (dB/frame) @ 60fps -> 90dB/s
-
     bool eqPathsDirty = true;
     bool eqDataDirty = false;
     bool analyzerVisualsCleared = false;
@@ -199,7 +197,7 @@ private:
     int currentTimerHz = 0;
     double lastEqUpdateTime = 0.0;
 
-    static constexpr int TIMER_HZ_ACTIVE = 60;
+    static constexpr int TIMER_HZ_ACTIVE = SpectrumAnalyzerWorker::kFrameHz;
     static constexpr int TIMER_HZ_IDLE_VISIBLE = 15;
     static constexpr int TIMER_HZ_HIDDEN = 5;
     static constexpr double EQ_UPDATE_INTERVAL_SEC = 0.10;
@@ -0,0 +1,239 @@
+#include "SpectrumAnalyzerWorker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "audioengine/AtomicAccess.h"
+
+SpectrumAnalyzerWorker::SpectrumAnalyzerWorker(AudioEngine& audioEngine,
+                                               const std::array<float, NUM_DISPLAY_BARS>& frequencies)
+    : juce::Thread("SpectrumAnalyzerWorker"),
+      engine(audioEngine),
+      displayFrequencies(frequencies),
+      readBuffer(convo::makeAlignedArray<float>(READ_CHUNK_SAMPLES))
+{
+    rawBuffer.fill(MIN_DB);
+    smoothedBuffer.fill(MIN_DB);
+    peakBuffer.fill(MIN_DB);
+    peakHoldTime.fill(0.0);
+}
+
+SpectrumAnalyzerWorker::~SpectrumAnalyzerWorker()
+{
+    stopThread(1000);
+}
+
+bool SpectrumAnalyzerWorker::prepare()
+{
+    if (readBuffer.get() == nullptr)
+        return false;
+
+    const double sampleRate = engine.getAnalyzerSampleRate();
+    return sampleRate <= 0.0 || prepareSpectrum(sampleRate);
+}
+
+bool SpectrumAnalyzerWorker::prepareSpectrum(double sampleRate)
+{
+    // 帯域数・間引き段・バーの割り当てはレートで決まる。新しい窓は無音から始まる
+    if (!spectrum.prepare(sampleRate, displayFrequencies.data(), NUM_DISPLAY_BARS))
+        return false;
+    silentSamples = spectrum.getLongestWindowSamples();
+    return true;
+}
+
+void SpectrumAnalyzerWorker::run()
+{
+    engine.getAffinityManager().applyCurrentThreadPolicy(ThreadType::LightBackground);
+
+    constexpr double frameIntervalMs = 1000.0 / kFrameHz;
+    double lastMs = juce::Time::getMillisecondCounterHiRes();
+    double nextMs = lastMs + frameIntervalMs;
+
+    while (!threadShouldExit())
+    {
+        const double waitMs = nextMs - juce::Time::getMillisecondCounterHiRes();
+        if (waitMs >= 1.0)
+            wait(static_cast<int>(waitMs));
+        if (threadShouldExit())
+            break;
+
+        const double nowMs = juce::Time::getMillisecondCounterHiRes();
+        // 大きく遅れたら追いつこうとせず、次の周期から数え直す
+        nextMs = (nowMs - nextMs > frameIntervalMs) ? nowMs + frameIntervalMs : nextMs + frameIntervalMs;
+        const double dt = std::max(0.0, (nowMs - lastMs) * 0.001);
+        lastMs = nowMs;
+
+        if (convo::consumeAtomic(paused, std::memory_order_relaxed)) // relaxed: 単独のフラグ
+        {
+            // 非表示の間は setPaused(false) か stopThread の notify() まで眠り、再開後は周期を数え直す
+            wait(-1);
+            lastMs = juce::Time::getMillisecondCounterHiRes();
+            nextMs = lastMs;
+            continue;
+        }
+        if (analyze(dt))
+            publishFrame();
+    }
+}
+
+bool SpectrumAnalyzerWorker::takeFrame(Frame& out) noexcept
+{
+    if (!frames.consume())
+        return false;
+    out = frames.readBuffer();
+    return true;
+}
+
+//--------------------------------------------------------------
+// analyze  ──  FIFO 取り出し・多重解像度 FFT・スムーシング。表示が変わったら true
+//--------------------------------------------------------------
+bool SpectrumAnalyzerWorker::analyze(double dt)
+{
+    // ピークホールド用の指数関数的減衰係数。時定数から導出する。
+    // これにより、減衰がフレームレートに依存しなくなり、かつ直線的な減衰よりも滑らかなカーブを描く。
+    const float peakDecayFactor = std::exp(-static_cast<float>(dt) / PEAK_DECAY_TIME_CONSTANT);
+
+    // FIFOに書き込まれるデータはベースレート (オーバーサンプリング時も processDown 後)。
+    // レートが変わったら帯域構成から作り直す (確保はこのスレッドで行う)
+    const double sampleRate = engine.getAnalyzerSampleRate();
+    if (sampleRate > 0.0 && sampleRate != spectrum.getSampleRate() && !prepareSpectrum(sampleRate))
+        return false;
+    if (!spectrum.isReady())
+        return false;
+
+    // FIFOの利用可能データ数をチェック
+    int available = engine.getFifoNumReady();
+    // 最も高い帯域で FFT をやり直せるだけの新しいデータが来るまで待つ (アンダーラングリッチ防止)
+    const int required = Spectrum::kHopSamples;
+
+    if (available < required)
+    {
+        // 60フレーム連続でアンダーランした場合 (1.0秒) はエンジン停止とみなし、カウンタの上限のみ制限する。
+        // オーディオ再開時に自動で復帰させるためスレッドは回し続ける。
+        underflowCount = std::min(underflowCount + 1, 61);
+
+        // 短期間のデータ不足（バッファ待ちなど）では減衰させず、表示を維持する (Flicker防止)
+        if (underflowCount <= 3)
+            return false;
+
+        // アンダーラン時は「減衰保持」 (Decay Hold): 視覚的に自然にフェードアウトさせる
+        bool changed = false;
+        for (size_t i = 0; i < smoothedBuffer.size(); ++i)
+        {
+            if (smoothedBuffer[i] > MIN_DB || peakBuffer[i] > MIN_DB)
+            {
+                smoothedBuffer[i] = std::max(MIN_DB, smoothedBuffer[i] - UNDERRUN_DECAY_DB);
+
+                // ピーク保持の更新 (減衰時もピークロジックを継続)
+                if (peakHoldTime[i] > 0.0)
+                    peakHoldTime[i] = std::max(0.0, peakHoldTime[i] - dt);
+                else
+                    peakBuffer[i] = smoothedBuffer[i] + (peakBuffer[i] - smoothedBuffer[i]) * peakDecayFactor;
+                if (peakBuffer[i] < MIN_DB) peakBuffer[i] = MIN_DB;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    // FIFOオーバーフロー防止 / レイテンシー削減
+    // 間引きは連続したストリームを前提にするので普段は全部読む。最も遅い取り出し間隔ぶんを超えて
+    // 溜まっている (一時停止明けなど) ときだけ古いデータを捨てる (その継ぎ目は一度だけ表示に混ざる)
+    const int maxBacklog = std::max(required, static_cast<int>(sampleRate) / AudioEngine::ANALYZER_MIN_PULL_HZ);
+    if (available > maxBacklog)
+    {
+        engine.skipFifo(available - maxBacklog);
+        available = maxBacklog;
+    }
+
+    underflowCount = 0;
+
+    // 1. FIFO から読み、帯域ごとの履歴へ積む (不正な値は MultiResolutionSpectrum が 0 として扱う)
+    float* chunk = readBuffer.get();
+    bool quietBlock = true;
+    for (int remaining = available; remaining > 0;)
+    {
+        const int n = std::min(remaining, READ_CHUNK_SAMPLES);
+        engine.readFromFifo(chunk, n);
+        const auto range = juce::FloatVectorOperations::findMinAndMax(chunk, n);
+        quietBlock = quietBlock && std::max(-range.getStart(), range.getEnd()) < SILENCE_PEAK;
+        spectrum.push(chunk, n);
+        remaining -= n;
+    }
+
+    // 最長の窓全体が無音なら FFT を省く (どのバーも表示下限に届かない)。スムーシングとピーク減衰は続ける
+    const int longestWindow = spectrum.getLongestWindowSamples();
+    silentSamples = quietBlock ? std::min(silentSamples + available, longestWindow) : 0;
+    if (silentSamples >= longestWindow)
+    {
+        rawBuffer.fill(Spectrum::kFloorDb);
+        smoothAndHoldPeaks(dt, peakDecayFactor);
+        return true;
+    }
+
+    // 2. 新しいデータが溜まった帯域だけ FFT をやり直し、表示バーへ合成
+    if (!spectrum.analyze(rawBuffer.data()))
+        return false;
+
+    // 3. スムーシングとピーク保持
+    smoothAndHoldPeaks(dt, peakDecayFactor);
+    return true;
+}
+
+void SpectrumAnalyzerWorker::smoothAndHoldPeaks(double dt, float peakDecayFactor) noexcept
+{
+    for (size_t b = 0; b < smoothedBuffer.size(); ++b)
+    {
+        smoothedBuffer[b] = SMOOTHING_ALPHA * smoothedBuffer[b] + (1.0f - SMOOTHING_ALPHA) * rawBuffer[b];
+
+        if (smoothedBuffer[b] >= peakBuffer[b])
+        {
+            // 現在値がピーク以上なら更新し、保持カウンタをリセット
+            peakBuffer[b]   = smoothedBuffer[b];
+            peakHoldTime[b] = PEAK_HOLD_SEC;
+        }
+        else if (peakHoldTime[b] > 0.0)
+        {
+            peakHoldTime[b] = std::max(0.0, peakHoldTime[b] - dt);
+        }
+        else
+        {
+            // 指数関数的に現在のスムージング値に向かって減衰させる
+            // (直線的な減衰で近づいた際の「カクン」という不自然な停止を防ぐ)
+            peakBuffer[b] = smoothedBuffer[b] + (peakBuffer[b] - smoothedBuffer[b]) * peakDecayFactor;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+// publishFrame  ──  バー列をフレームへ写し、前回から見て変わっていれば Message Thread へ渡す
+//--------------------------------------------------------------
+void SpectrumAnalyzerWorker::publishFrame()
+{
+    auto& frame = frames.writeBuffer();
+    mapToBars(frame);
+
+    if (publishedOnce)
+    {
+        float maxDelta = 0.0f;
+        for (size_t bar = 0; bar < static_cast<size_t>(NUM_DISPLAY_BARS); ++bar)
+            maxDelta = std::max({ maxDelta, std::abs(frame.barDb[bar] - lastPublished.barDb[bar]),
+                                  std::abs(frame.peakDb[bar] - lastPublished.peakDb[bar]) });
+        if (maxDelta < PUBLISH_DELTA_DB)
+            return;   // 書き込み用スロットは次のフレームでそのまま上書きする
+    }
+
+    lastPublished = frame;
+    publishedOnce = true;
+    frames.publish();
+}
+
+void SpectrumAnalyzerWorker::mapToBars(Frame& frame) const
+{
+    // 帯域の選択とビンの合成は MultiResolutionSpectrum が済ませている (スムーシングもバー単位)
+    for (size_t bar = 0; bar < static_cast<size_t>(NUM_DISPLAY_BARS); ++bar)
+    {
+        frame.barDb[bar] = std::clamp(smoothedBuffer[bar], MIN_DB, MAX_DB);
+        frame.peakDb[bar] = std::clamp(peakBuffer[bar], MIN_DB, MAX_DB);
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <JuceHeader.h>
+
+#include "AlignedAllocation.h"
+#include "AudioEngine.h"
+#include "core/TripleBuffer.h"
+#include "dsp/MultiResolutionSpectrum.h"
+
+/**
+    SpectrumAnalyzerWorker: SpectrumAnalyzerComponent の解析スレッド (LightBackground に固定)。
+
+    analyzerFifo の取り出し・多重解像度スペクトル (dsp/MultiResolutionSpectrum: オクターブ間引き + 帯域ごとの
+    1024 点 FFT を表示バーへ合成)・バー単位のスムーシングとピーク保持までを kFrameHz で行い、
+    出来上がったバー列を TripleBuffer で Message Thread へ渡す。FIFO は毎フレーム溜まった分をすべて読む
+    (間引きの連続性のため。溜まりすぎた古い分だけ捨てる)。
+    Message Thread は timerCallback で最新のフレームを取り込んで repaint するだけなので、UI が
+    詰まっても解析は遅れない (analyzerFifo のリーダはこのスレッドだけ)。
+
+    - コンポーネントがアナライザーを ON にしたときに作って prepare() → startThread、OFF で破棄する
+    - 非表示の間は setPaused(true) で解析を止め、スレッドは再開まで眠る (FIFO は溢れた分が捨てられるだけ)
+    - 最も長い帯域の窓全体が無音の間は FFT を省き、表示が 1 画素未満しか変わらないフレームは渡さない。
+      無音や定常状態では Message Thread の repaint も起きない (信号が来れば次のフレームで再開する)
+*/
+class SpectrumAnalyzerWorker : public juce::Thread
+{
+public:
+    static constexpr int NUM_DISPLAY_BARS = AudioEngine::NUM_DISPLAY_BARS;
+    using Spectrum = convo::dsp::MultiResolutionSpectrum;
+    static_assert(Spectrum::kFftPoints == AudioEngine::ANALYZER_FFT_POINTS);
+    static_assert(NUM_DISPLAY_BARS <= Spectrum::kMaxBars);
+
+    // ── 表示範囲 (バーはこの範囲に clamp して渡す) ──
+    static constexpr float MIN_DB = -80.0f;
+    static constexpr float MAX_DB = 20.0f;
+
+    static constexpr int kFrameHz = 60;
+    // analyzerFifo の容量は ANALYZER_MIN_PULL_HZ 間隔の取り出しを前提に決まる
+    static_assert(kFrameHz >= AudioEngine::ANALYZER_MIN_PULL_HZ);
+
+    struct Frame
+    {
+        std::array<float, NUM_DISPLAY_BARS> barDb {};
+        std::array<float, NUM_DISPLAY_BARS> peakDb {};
+    };
+
+    // displayFrequencies: 各表示バーの中心周波数 (コンポーネントの周波数軸)
+    SpectrumAnalyzerWorker(AudioEngine& engine, const std::array<float, NUM_DISPLAY_BARS>& displayFrequencies);
+    ~SpectrumAnalyzerWorker() override;
+
+    // Message Thread。FFT の準備に失敗したら false (スレッドは開始しない)。
+    // レートが未定 (デバイス停止中) なら準備は最初の解析まで遅らせる
+    bool prepare();
+
+    void run() override;
+
+    // Message Thread。再開したときだけ run() の待ちを起こす (毎 tick 起こすと周期が崩れる)
+    void setPaused(bool shouldPause)
+    {
+        const bool wasPaused = convo::exchangeAtomic(paused, shouldPause, std::memory_order_relaxed); // relaxed: 単独のフラグ
+        if (wasPaused && !shouldPause)
+            notify();
+    }
+
+    // Message Thread: 新しいフレームがあれば out へ写して true
+    bool takeFrame(Frame& out) noexcept;
+
+private:
+    bool analyze(double dt);
+    bool prepareSpectrum(double sampleRate);
+    void smoothAndHoldPeaks(double dt, float peakDecayFactor) noexcept;
+    void publishFrame();
+    void mapToBars(Frame& frame) const;
+
+    // ── FIFO の読み出し ──
+    static constexpr int READ_CHUNK_SAMPLES = Spectrum::kMaxInputSamples;
+
+    // ── スムーシング・ピーク保持 ──
+    static constexpr float SMOOTHING_ALPHA = 0.85f; // 60fpsに合わせて調整 (0.75 -> 0.85)
+    static constexpr double PEAK_HOLD_SEC = 1.0;
+    static constexpr float PEAK_DECAY_TIME_CONSTANT = 0.4f; // 秒。値が大きいほどゆっくり減衰する
+    static constexpr float UNDERRUN_DECAY_DB = 1.5f; // データ不足時の減衰量 (dB/frame) @ 60fps -> 90dB/s
+
+    // ── 変化のないフレームの抑止 ──
+    // どのビンも 2·peak にしかならない (帯域制限後の間引き帯域も同じ) ので、-90 dBFS 未満の入力は MIN_DB (-80) に届かない
+    static constexpr float SILENCE_PEAK = 3.0e-5f;
+    // 4K のプロット高 (~2000px / 100dB) で 1 画素未満の変化は描き直さない
+    static constexpr float PUBLISH_DELTA_DB = 0.05f;
+
+    AudioEngine& engine;
+    const std::array<float, NUM_DISPLAY_BARS> displayFrequencies;
+    std::atomic<bool> paused { false };
+
+    // ── 解析状態 (このスレッドのみ) ──
+    Spectrum spectrum;                                  // レートが変わったら解析スレッドで準備し直す
+    convo::ScopedAlignedPtr<float> readBuffer;          // FIFO から READ_CHUNK_SAMPLES ずつ読む
+    std::array<float, NUM_DISPLAY_BARS> rawBuffer {};   // 今回の解析結果 (バー単位の dB)
+    std::array<float, NUM_DISPLAY_BARS> smoothedBuffer {};
+    std::array<float, NUM_DISPLAY_BARS> peakBuffer {};
+    std::array<double, NUM_DISPLAY_BARS> peakHoldTime {};
+    int underflowCount = 0;
+    int silentSamples = 0;                // 直近で SILENCE_PEAK 未満が続いたサンプル数 (準備時に最長窓で始める)
+    Frame lastPublished;                  // 直近に渡したフレーム (変化量の判定用)
+    bool publishedOnce = false;
+
+    convo::TripleBuffer<Frame> frames;
+};
@@ -0,0 +1,217 @@
+#include "SpectrumGLRenderer.h"
+
+#include <cmath>
+#include <cstddef>
+
+namespace
+{
+// 論理ピクセル → NDC (y 下向き) の写像だけを行う単色シェーダ
+constexpr const char* kVertexShader = R"(
+    attribute vec2 position;
+    attribute vec4 colour;
+    uniform vec2 viewSize;
+    varying vec4 vertexColour;
+
+    void main()
+    {
+        vertexColour = colour;
+        gl_Position = vec4(position.x * 2.0 / viewSize.x - 1.0, 1.0 - position.y * 2.0 / viewSize.y, 0.0, 1.0);
+    }
+)";
+
+constexpr const char* kFragmentShader = R"(
+    varying vec4 vertexColour;
+
+    void main()
+    {
+        gl_FragColor = vertexColour;
+    }
+)";
+
+SpectrumGLRenderer::Vertex makeVertex(float x, float y, juce::Colour colour) noexcept
+{
+    return { x, y, colour.getFloatRed(), colour.getFloatGreen(), colour.getFloatBlue(), colour.getFloatAlpha() };
+}
+}
+
+//--------------------------------------------------------------
+// メッシュの組み立て (Message Thread)
+//--------------------------------------------------------------
+void SpectrumGLRenderer::Mesh::addRect(juce::Rectangle<float> r, juce::Colour colour)
+{
+    if (r.isEmpty())
+        return;
+
+    const auto tl = makeVertex(r.getX(), r.getY(), colour);
+    const auto tr = makeVertex(r.getRight(), r.getY(), colour);
+    const auto bl = makeVertex(r.getX(), r.getBottom(), colour);
+    const auto br = makeVertex(r.getRight(), r.getBottom(), colour);
+    vertices.insert(vertices.end(), { tl, tr, bl, tr, br, bl });
+}
+
+void SpectrumGLRenderer::Mesh::addPolyline(const juce::Point<float>* points, int numPoints, float thickness, juce::Colour colour)
+{
+    if (numPoints < 2)
+        return;
+
+    const Strip strip { static_cast<int>(vertices.size()), numPoints * 2 };
+    const float halfWidth = thickness * 0.5f;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        // 前後の点を結ぶ向きの法線で両側へ広げる (両端は片側の線分)
+        const auto& prev = points[juce::jmax(0, i - 1)];
+        const auto& next = points[juce::jmin(numPoints - 1, i + 1)];
+        auto dx = next.x - prev.x;
+        auto dy = next.y - prev.y;
+        const float length = std::sqrt(dx * dx + dy * dy);
+        if (length > 1.0e-6f)
+        {
+            dx /= length;
+            dy /= length;
+        }
+        else
+        {
+            dx = 1.0f;
+            dy = 0.0f;
+        }
+
+        const float nx = -dy * halfWidth;
+        const float ny = dx * halfWidth;
+        vertices.push_back(makeVertex(points[i].x + nx, points[i].y + ny, colour));
+        vertices.push_back(makeVertex(points[i].x - nx, points[i].y - ny, colour));
+    }
+
+    strips.push_back(strip);
+}
+
+//--------------------------------------------------------------
+// コンテキスト
+//--------------------------------------------------------------
+SpectrumGLRenderer::SpectrumGLRenderer(juce::Component& target)
+{
+    context.setRenderer(this);
+    context.setComponentPaintingEnabled(true);
+    context.setContinuousRepainting(false);   // コンポーネントの repaint() でだけフレームを描く
+    context.attachTo(target);
+}
+
+SpectrumGLRenderer::~SpectrumGLRenderer()
+{
+    context.detach();   // openGLContextClosing() で GL 資源を解放してから戻る
+}
+
+void SpectrumGLRenderer::newOpenGLContextCreated()
+{
+    auto program = std::make_unique<juce::OpenGLShaderProgram>(context);
+    if (!program->addVertexShader(juce::OpenGLHelpers::translateVertexShaderToV3(kVertexShader))
+        || !program->addFragmentShader(juce::OpenGLHelpers::translateFragmentShaderToV3(kFragmentShader))
+        || !program->link())
+    {
+        juce::Logger::writeToLog("SpectrumGLRenderer: shader build failed, using software rendering: "
+                                 + program->getLastError());
+        return;
+    }
+
+    shader = std::move(program);
+    positionAttribute = std::make_unique<juce::OpenGLShaderProgram::Attribute>(*shader, "position");
+    colourAttribute = std::make_unique<juce::OpenGLShaderProgram::Attribute>(*shader, "colour");
+    viewSizeUniform = std::make_unique<juce::OpenGLShaderProgram::Uniform>(*shader, "viewSize");
+
+    convo::publishAtomic(active, true, std::memory_order_release); // release: シェーダの準備を Message Thread の isActive() へ
+}
+
+void SpectrumGLRenderer::openGLContextClosing()
+{
+    using namespace ::juce::gl;
+
+    convo::publishAtomic(active, false, std::memory_order_release); // release: 以降は Message Thread がソフトウェア描画に戻る
+
+    for (auto* buffer : { &spectrumBuffer, &curveBuffer })
+    {
+        if (buffer->id != 0)
+            glDeleteBuffers(1, &buffer->id);
+        *buffer = {};
+    }
+
+    viewSizeUniform.reset();
+    colourAttribute.reset();
+    positionAttribute.reset();
+    shader.reset();
+}
+
+void SpectrumGLRenderer::renderOpenGL()
+{
+    using namespace ::juce::gl;
+
+    // 新しいメッシュが届いたとき (とコンテキスト再生成直後) だけ VBO を更新する
+    if (spectrum.consume() || spectrumBuffer.id == 0)
+        upload(spectrumBuffer, spectrum.readBuffer(), GL_DYNAMIC_DRAW);
+    if (curves.consume() || curveBuffer.id == 0)
+        upload(curveBuffer, curves.readBuffer(), GL_STATIC_DRAW);
+
+    juce::OpenGLHelpers::clear(juce::Colours::black);
+    if (shader == nullptr)
+        return;
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    shader->use();
+
+    draw(spectrumBuffer, spectrum.readBuffer());
+    draw(curveBuffer, curves.readBuffer());
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SpectrumGLRenderer::upload(GpuBuffer& buffer, const Mesh& mesh, GLenum usage)
+{
+    using namespace ::juce::gl;
+
+    if (buffer.id == 0)
+        glGenBuffers(1, &buffer.id);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.id);
+    const size_t bytes = mesh.vertices.size() * sizeof(Vertex);
+    if (bytes > buffer.capacityBytes)
+    {
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), mesh.vertices.data(), usage);
+        buffer.capacityBytes = bytes;
+    }
+    else if (bytes > 0)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), mesh.vertices.data());
+    }
+}
+
+void SpectrumGLRenderer::draw(const GpuBuffer& buffer, const Mesh& mesh)
+{
+    using namespace ::juce::gl;
+
+    if (buffer.id == 0 || mesh.vertices.empty() || mesh.viewSize.x <= 0.0f || mesh.viewSize.y <= 0.0f)
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer.id);
+    viewSizeUniform->set(mesh.viewSize.x, mesh.viewSize.y);
+
+    const auto position = static_cast<GLuint>(positionAttribute->attributeID);
+    const auto colour = static_cast<GLuint>(colourAttribute->attributeID);
+    glVertexAttribPointer(position, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+    glEnableVertexAttribArray(position);
+    glVertexAttribPointer(colour, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<const GLvoid*>(offsetof(Vertex, r)));
+    glEnableVertexAttribArray(colour);
+
+    if (mesh.strips.empty())
+    {
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(mesh.vertices.size()));
+    }
+    else
+    {
+        for (const auto& strip : mesh.strips)
+            glDrawArrays(GL_TRIANGLE_STRIP, strip.first, strip.count);
+    }
+
+    glDisableVertexAttribArray(position);
+    glDisableVertexAttribArray(colour);
+}
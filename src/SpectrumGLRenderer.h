@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <JuceHeader.h>
+
+#include "core/TripleBuffer.h"
+
+/**
+    SpectrumGLRenderer: SpectrumAnalyzerComponent のスペクトラムバーと EQ 曲線を OpenGL で描く。
+
+    コンポーネントに OpenGLContext を付け、バー (三角形列) と曲線 (太さ付きの三角形ストリップ) を
+    頂点バッファに置いて描く。頂点列は Message Thread が組み立てて TripleBuffer で渡し、GL スレッドは
+    新しいメッシュが届いたときだけ VBO へ転送する (曲線は EQ かレイアウトが変わったときだけ)。
+    グリッド・文字・レベルメーターはコンポーネントの paint() が引き続き描き、JUCE がその結果を
+    GL の描画の上に重ねる (paint も OpenGL の Graphics コンテキストで実行される)。
+
+    - isActive() が false の間 (コンテキスト未生成・シェーダ失敗) はコンポーネントがソフトウェア描画する
+    - 座標はコンポーネントの論理ピクセル。メッシュごとに組み立て時のサイズを持ち、シェーダで NDC へ写す
+*/
+class SpectrumGLRenderer : private juce::OpenGLRenderer
+{
+public:
+    struct Vertex
+    {
+        float x, y;
+        float r, g, b, a;
+    };
+
+    struct Strip
+    {
+        int first = 0;
+        int count = 0;
+    };
+
+    struct Mesh
+    {
+        juce::Point<float> viewSize;
+        std::vector<Vertex> vertices;
+        std::vector<Strip> strips;      // 空なら vertices 全体を GL_TRIANGLES で描く
+
+        void clear(juce::Point<float> size)
+        {
+            viewSize = size;
+            vertices.clear();
+            strips.clear();
+        }
+
+        void addRect(juce::Rectangle<float> r, juce::Colour colour);
+        // 折れ線を thickness の帯 (三角形ストリップ 1 本) にする
+        void addPolyline(const juce::Point<float>* points, int numPoints, float thickness, juce::Colour colour);
+    };
+
+    explicit SpectrumGLRenderer(juce::Component& target);
+    ~SpectrumGLRenderer() override;
+
+    // Message Thread: GL で描ける状態か (false ならソフトウェア描画に戻す)
+    bool isActive() const noexcept
+    {
+        return convo::consumeAtomic(active, std::memory_order_acquire); // acquire: シェーダとバッファの準備完了を見てから描画を任せる
+    }
+
+    // Message Thread: 書き込み用メッシュを埋めて publish*() する。描画は呼び出し側の repaint() で走る
+    Mesh& spectrumMesh() noexcept { return spectrum.writeBuffer(); }
+    void publishSpectrum() noexcept { spectrum.publish(); }
+    Mesh& curveMesh() noexcept { return curves.writeBuffer(); }
+    void publishCurves() noexcept { curves.publish(); }
+
+private:
+    struct GpuBuffer
+    {
+        GLuint id = 0;
+        size_t capacityBytes = 0;
+    };
+
+    void newOpenGLContextCreated() override;
+    void renderOpenGL() override;
+    void openGLContextClosing() override;
+
+    void upload(GpuBuffer& buffer, const Mesh& mesh, GLenum usage);
+    void draw(const GpuBuffer& buffer, const Mesh& mesh);
+
+    juce::OpenGLContext context;
+    std::atomic<bool> active { false };
+
+    convo::TripleBuffer<Mesh> spectrum;
+    convo::TripleBuffer<Mesh> curves;
+
+    // ── GL スレッドのみ ──
+    std::unique_ptr<juce::OpenGLShaderProgram> shader;
+    std::unique_ptr<juce::OpenGLShaderProgram::Attribute> positionAttribute;
+    std::unique_ptr<juce::OpenGLShaderProgram::Attribute> colourAttribute;
+    std::unique_ptr<juce::OpenGLShaderProgram::Uniform> viewSizeUniform;
+    GpuBuffer spectrumBuffer;
+    GpuBuffer curveBuffer;
+};
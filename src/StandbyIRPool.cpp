@@ -0,0 +1,123 @@
+#include "StandbyIRPool.h"
+
+#include <cstring>
+
+namespace
+{
+uint64_t hashCombine(uint64_t seed, uint64_t value) noexcept
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+size_t bufferBytes(const juce::AudioBuffer<double>& buffer) noexcept
+{
+    return static_cast<size_t>(buffer.getNumChannels()) * static_cast<size_t>(buffer.getNumSamples()) * sizeof(double);
+}
+}
+
+StandbyIRPool& StandbyIRPool::getInstance()
+{
+    static StandbyIRPool instance;
+    return instance;
+}
+
+uint64_t StandbyIRPool::makeKey(uint64_t sourceCRC, double sampleRate, uint64_t settingsHash) noexcept
+{
+    uint64_t rateBits = 0;
+    static_assert(sizeof(double) == sizeof(uint64_t), "unexpected double size");
+    std::memcpy(&rateBits, &sampleRate, sizeof(double));
+
+    uint64_t seed = sourceCRC;
+    seed = hashCombine(seed, rateBits);
+    seed = hashCombine(seed, settingsHash);
+    return seed;
+}
+
+std::shared_ptr<const StandbyIR> StandbyIRPool::find(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if ((*it)->key == key)
+        {
+            entries.splice(entries.begin(), entries, it);
+            return entries.front();
+        }
+    }
+    return nullptr;
+}
+
+bool StandbyIRPool::contains(uint64_t key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : entries)
+    {
+        if (entry->key == key)
+            return true;
+    }
+    return false;
+}
+
+void StandbyIRPool::store(std::unique_ptr<StandbyIR> entry)
+{
+    if (entry == nullptr || entry->trimmed.getNumSamples() <= 0 || entry->trimmed.getNumChannels() <= 0)
+        return;
+
+    entry->bytes = bufferBytes(entry->loadedIR) + bufferBytes(entry->trimmed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entry->bytes > byteBudget)
+        return;  // 格納直後に自分自身が追い出されるため
+
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if ((*it)->key == entry->key)
+        {
+            totalBytes -= (*it)->bytes;
+            entries.erase(it);
+            break;
+        }
+    }
+
+    totalBytes += entry->bytes;
+    entries.push_front(std::shared_ptr<const StandbyIR>(std::move(entry)));
+    evictToBudgetLocked();
+}
+
+void StandbyIRPool::setByteBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    byteBudget = bytes;
+    evictToBudgetLocked();
+}
+
+size_t StandbyIRPool::getByteBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return byteBudget;
+}
+
+size_t StandbyIRPool::getTotalBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalBytes;
+}
+
+void StandbyIRPool::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    totalBytes = 0;
+    memoryCharge.set(0);
+}
+
+void StandbyIRPool::evictToBudgetLocked()
+{
+    // 消費側が保持中の shared_ptr はそのまま有効 (プールからの参照だけ外す)
+    while (totalBytes > byteBudget && !entries.empty())
+    {
+        totalBytes -= entries.back()->bytes;
+        entries.pop_back();
+    }
+    memoryCharge.set(totalBytes);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <JuceHeader.h>
+
+#include "audioengine/MemoryLedger.h"
+
+/**
+    StandbyIR: 代替サンプルレート向けに事前計算済みの IR 一式。
+
+    LoaderThread の LoadIR → Trim → Transform (リサンプリング / DC 除去 / Tukey / 目標長フェード /
+    位相変換) を終えた時点のバッファを保持する。分割スペクトルや NUC エンジンは所有プロセッサと
+    ブロックサイズに依存するため保持せず、消費側の Build ステップで構築する。
+*/
+struct StandbyIR
+{
+    uint64_t key = 0;
+    double sampleRate = 0.0;
+    juce::AudioBuffer<double> loadedIR;  // IRState に載る処理済み IR (フェード前)
+    juce::AudioBuffer<double> trimmed;   // Build ステップへ渡す IR (フェード・位相変換後)
+    int targetLength = 0;
+    size_t bytes = 0;
+};
+
+/**
+    StandbyIRPool: ホットスタンバイ IR のメモリ常駐プール。
+
+    UI 側 ConvolverProcessor が「次に来そうな」サンプルレート (setStandbySampleRates) 向けに
+    バックグラウンドで StandbyIR を作って store() し、レート変更時のリビルド (DSP 側
+    ConvolverProcessor の LoaderThread) が find() で拾ってリサンプリングと位相変換を省略する。
+    キーは (ソースファイル CRC, 目標レート, 前処理設定ハッシュ)。
+
+    メモリは合計バイト数 (setByteBudget) で上限を設け、超過分は LRU で追い出す。
+    エントリは shared_ptr<const StandbyIR> で共有し、消費側はコピーして使う (往復切替でも再利用できる)。
+
+    スレッド: Standby Prebuild Thread / Rebuild Thread / Message Thread から並行に呼ばれる (mutex)。
+*/
+class StandbyIRPool
+{
+public:
+    static constexpr size_t kDefaultByteBudget = static_cast<size_t>(256) * 1024 * 1024;
+
+    /** UI 側と DSP 側の ConvolverProcessor で同じプールを共有するためプロセス単一。 */
+    static StandbyIRPool& getInstance();
+
+    static uint64_t makeKey(uint64_t sourceCRC, double sampleRate, uint64_t settingsHash) noexcept;
+
+    [[nodiscard]] std::shared_ptr<const StandbyIR> find(uint64_t key);
+    [[nodiscard]] bool contains(uint64_t key) const;
+
+    /** entry->bytes を計算して格納する。単独で予算を超えるエントリは格納しない。 */
+    void store(std::unique_ptr<StandbyIR> entry);
+
+    void setByteBudget(size_t bytes);
+    [[nodiscard]] size_t getByteBudget() const;
+    [[nodiscard]] size_t getTotalBytes() const;
+
+    void clear();
+
+private:
+    StandbyIRPool() = default;
+
+    void evictToBudgetLocked();
+
+    std::list<std::shared_ptr<const StandbyIR>> entries;  // front = 最近使用
+    size_t totalBytes = 0;
+    size_t byteBudget = kDefaultByteBudget;
+    convo::MemoryCharge memoryCharge { convo::MemoryCategory::StandbyIrPool };  // = totalBytes (mutex 内で更新)
+    mutable std::mutex mutex;
+};
@@ -0,0 +1,77 @@
+#include "StandbyPrebuildThread.h"
+
+#include "ConvolverProcessor.h"
+#include "core/ThreadAffinityManager.h"
+
+#include <xmmintrin.h>   // _MM_SET_FLUSH_ZERO_MODE
+#include <pmmintrin.h>   // _MM_SET_DENORMALS_ZERO_MODE
+
+#include "audioengine/AtomicAccess.h"
+
+StandbyPrebuildThread::StandbyPrebuildThread(ConvolverProcessor& p,
+                                             const juce::File& file,
+                                             std::vector<double> rates,
+                                             uint64_t baseGeneration,
+                                             ThreadAffinityManager* affinityMgr)
+    : juce::Thread("ConvolverStandbyPrebuild"),
+      processor(p),
+      irFile(file),
+      standbyRates(std::move(rates)),
+      taskGeneration(baseGeneration),
+      affinityManager(affinityMgr)
+{
+}
+
+StandbyPrebuildThread::~StandbyPrebuildThread()
+{
+    cancel();
+    stopThread(2000);
+}
+
+void StandbyPrebuildThread::cancel()
+{
+    convo::publishAtomic(cancelled, true, std::memory_order_release); // release: run/loader 側 checkAndCancel の acquire と HB
+    signalThreadShouldExit();
+}
+
+bool StandbyPrebuildThread::checkAndCancel()
+{
+    if (threadShouldExit()
+        || convo::consumeAtomic(cancelled, std::memory_order_acquire) // acquire: cancel() の release と HB
+        || !processor.isConvolverGenerationCurrent(taskGeneration))
+    {
+        convo::publishAtomic(cancelled, true, std::memory_order_release); // release: 以降の checkAndCancel acquire と HB
+        return true;
+    }
+    return false;
+}
+
+void StandbyPrebuildThread::run()
+{
+    // ★ Bug#4: FTZ/DAZ 有効化（専用スレッド: 設定のみ、RAII 保存＋復元は不要）
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+
+    if (affinityManager != nullptr)
+        affinityManager->applyCurrentThreadPolicy(ThreadType::HeavyBackground);
+
+    setPriority(Priority::low);
+
+    // 本ロード (現在レート) の完了を待ってから着手する (CPU を奪い合わない)
+    while (processor.isLoadingIR())
+    {
+        if (checkAndCancel())
+            return;
+        wait(50);
+    }
+
+    for (const double rate : standbyRates)
+    {
+        if (checkAndCancel())
+            return;
+
+        const bool built = processor.prebuildStandbyIR(irFile, rate, [this]() { return checkAndCancel(); });
+        if (!built && checkAndCancel())
+            return;
+    }
+}
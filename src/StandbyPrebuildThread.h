@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <JuceHeader.h>
+
+class ConvolverProcessor;
+class ThreadAffinityManager;
+
+/**
+    StandbyPrebuildThread: 代替サンプルレート向けホットスタンバイ IR の事前計算スレッド。
+
+    UI 側 ConvolverProcessor がロード完了後 / レート変更後に起動する。現在の IR ファイルを
+    standbyRates の各レートへ LoaderThread の Build 手前まで処理し、StandbyIRPool に格納する。
+    新しい IR ロード (世代更新) または cancel() で打ち切る。
+*/
+class StandbyPrebuildThread : public juce::Thread
+{
+public:
+    StandbyPrebuildThread(ConvolverProcessor& processor,
+                          const juce::File& irFile,
+                          std::vector<double> standbyRates,
+                          uint64_t baseGeneration,
+                          ThreadAffinityManager* affinityManager);
+
+    ~StandbyPrebuildThread() override;
+
+    void run() override;
+    void cancel();
+
+private:
+    bool checkAndCancel();
+
+    ConvolverProcessor& processor;
+    juce::File irFile;
+    std::vector<double> standbyRates;
+    uint64_t taskGeneration = 0;
+    std::atomic<bool> cancelled { false };
+    ThreadAffinityManager* affinityManager = nullptr;
+};
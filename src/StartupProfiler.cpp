@@ -0,0 +1,145 @@
+#include "StartupProfiler.h"
+
+#include "audioengine/AtomicAccess.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace convo {
+
+namespace {
+
+struct TimelineEntry
+{
+    double beginMs = 0.0;
+    double endMs = -1.0;   // 負 = 時点 (区間ではない)
+    juce::String label;
+    juce::String thread;
+};
+
+std::atomic<bool> g_enabled { false };
+std::atomic<bool> g_firstAudioPending { false };
+std::atomic<double> g_firstAudioMs { -1.0 };
+double g_originMs = 0.0;   // enable() で g_enabled / g_firstAudioPending の release より前に書き、以降は読むだけ
+
+std::mutex g_entriesMutex;
+std::vector<TimelineEntry> g_entries;
+
+juce::String currentThreadLabel()
+{
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        return "message";
+    if (auto* thread = juce::Thread::getCurrentThread())
+        return thread->getThreadName();
+    return "worker";
+}
+
+} // namespace
+
+void StartupProfiler::enable()
+{
+    g_originMs = juce::Time::getMillisecondCounterHiRes();
+    // release: g_originMs を mark 側 / Audio Thread 側の acquire へ公開する
+    publishAtomic(g_firstAudioPending, true, std::memory_order_release);
+    publishAtomic(g_enabled, true, std::memory_order_release);
+    mark("profile enabled (MainApplication::initialise)");
+}
+
+bool StartupProfiler::isEnabled() noexcept
+{
+    return consumeAtomic(g_enabled, std::memory_order_acquire);
+}
+
+double StartupProfiler::getElapsedMs() noexcept
+{
+    return isEnabled() ? juce::Time::getMillisecondCounterHiRes() - g_originMs : 0.0;
+}
+
+void StartupProfiler::mark(const juce::String& label)
+{
+    if (isEnabled())
+        addEntry(label, getElapsedMs(), -1.0);
+}
+
+void StartupProfiler::addEntry(const juce::String& label, double beginMs, double endMs)
+{
+    const std::lock_guard<std::mutex> lock(g_entriesMutex);
+    g_entries.push_back({ beginMs, endMs, label, currentThreadLabel() });
+}
+
+StartupProfiler::ScopedSpan::ScopedSpan(juce::String spanLabel)
+    : label(std::move(spanLabel)),
+      beginMs(StartupProfiler::getElapsedMs())
+{
+}
+
+StartupProfiler::ScopedSpan::~ScopedSpan()
+{
+    if (StartupProfiler::isEnabled())
+        StartupProfiler::addEntry(label, beginMs, StartupProfiler::getElapsedMs());
+}
+
+void StartupProfiler::noteAudioCallback() noexcept
+{
+    // relaxed: 無効時と 2 回目以降はこのロードだけで戻る (確定は下の exchange が担う)
+    if (!consumeAtomic(g_firstAudioPending, std::memory_order_relaxed))
+        return;
+    // acq_rel: enable() の release と HB し g_originMs を読む / 2 本目のコールバックとの競合は 1 本だけが勝つ
+    if (exchangeAtomic(g_firstAudioPending, false, std::memory_order_acq_rel))
+        publishAtomic(g_firstAudioMs, juce::Time::getMillisecondCounterHiRes() - g_originMs, std::memory_order_release);
+}
+
+bool StartupProfiler::hasFirstAudioCallback() noexcept
+{
+    return consumeAtomic(g_firstAudioMs, std::memory_order_acquire) >= 0.0;
+}
+
+void StartupProfiler::report(bool runtimeSettled)
+{
+    if (!isEnabled())
+        return;
+
+    const double finishedMs = getElapsedMs();
+    const double firstAudioMs = consumeAtomic(g_firstAudioMs, std::memory_order_acquire);
+    // 以降の mark は捨てる (Audio Thread 側も二度と記録しない)
+    publishAtomic(g_enabled, false, std::memory_order_release);
+    publishAtomic(g_firstAudioPending, false, std::memory_order_release);
+
+    std::vector<TimelineEntry> entries;
+    {
+        const std::lock_guard<std::mutex> lock(g_entriesMutex);
+        entries.swap(g_entries);
+    }
+    if (firstAudioMs >= 0.0)
+        entries.push_back({ firstAudioMs, -1.0, "first audio callback", "audio" });
+    entries.push_back({ finishedMs, -1.0, runtimeSettled ? "runtime settled" : "gave up waiting for settled runtime", "message" });
+    std::stable_sort(entries.begin(), entries.end(), [](const TimelineEntry& a, const TimelineEntry& b)
+    {
+        return a.beginMs < b.beginMs;
+    });
+
+    const auto emit = [](const juce::String& line)
+    {
+        juce::Logger::writeToLog(line);
+        std::fputs((line + "\n").toRawUTF8(), stdout);
+    };
+
+    for (const auto& entry : entries)
+    {
+        juce::String line = "[StartupProfile] " + juce::String(entry.beginMs, 1).paddedLeft(' ', 8) + " ms";
+        line << " [" << entry.thread << "] " << entry.label;
+        if (entry.endMs >= 0.0)
+            line << " (" << juce::String(entry.endMs - entry.beginMs, 1) << " ms, until " << juce::String(entry.endMs, 1) << ")";
+        emit(line);
+    }
+
+    emit("[StartupProfile] Finished: firstAudioMs=" + juce::String(firstAudioMs, 1)
+         + " settledMs=" + (runtimeSettled ? juce::String(finishedMs, 1) : juce::String("-1"))
+         + " entries=" + juce::String(static_cast<int>(entries.size())));
+    std::fflush(stdout);
+}
+
+} // namespace convo
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace convo {
+
+/**
+    StartupProfiler: 起動から最初の音出しまでのタイムライン (--cli-startup-profile)。
+
+    MainApplication::initialise の先頭で enable() すると、以降の mark() / ScopedSpan を
+    initialise 開始からの経過時間とスレッド名つきで記録する。無効時はどれも何もしない。
+    MainWindow が最初のデバイスコールバックとランタイムの安定 (AudioEngine::isRuntimeSettled) を
+    待って report() し、時刻順のタイムラインをログと標準出力へ出す (以降の記録は止める)。
+
+    スレッド:
+      enable / report     : Message Thread
+      mark / ScopedSpan   : 任意の Non-RT スレッド (mutex)。StartupWarmup の並列タスクは区間で並ぶ
+      noteAudioCallback   : Audio Thread。最初の 1 回だけ時刻を記録する (ロック無し、無効時は relaxed ロード 1 回)
+*/
+class StartupProfiler
+{
+public:
+    static void enable();
+    [[nodiscard]] static bool isEnabled() noexcept;
+    // enable() からの経過時間 (ms)。無効時は 0
+    [[nodiscard]] static double getElapsedMs() noexcept;
+
+    static void mark(const juce::String& label);
+
+    // 生存期間を 1 つの区間 (開始〜終了) として記録する
+    class ScopedSpan
+    {
+    public:
+        explicit ScopedSpan(juce::String spanLabel);
+        ~ScopedSpan();
+
+    private:
+        juce::String label;
+        double beginMs = 0.0;
+        JUCE_DECLARE_NON_COPYABLE (ScopedSpan)
+    };
+
+    static void noteAudioCallback() noexcept;
+    [[nodiscard]] static bool hasFirstAudioCallback() noexcept;
+
+    // runtimeSettled = false はタイムアウトで打ち切った場合
+    static void report(bool runtimeSettled);
+
+private:
+    static void addEntry(const juce::String& label, double beginMs, double endMs);
+};
+
+} // namespace convo
@@ -0,0 +1,33 @@
+#include "StartupWarmup.h"
+
+#include "StartupProfiler.h"
+
+namespace convo {
+
+StartupWarmup::~StartupWarmup()
+{
+    waitForAll();
+}
+
+void StartupWarmup::launch(const juce::String& name, std::function<void()> task)
+{
+    threads.emplace_back([name, task = std::move(task)]() noexcept
+    {
+        const StartupProfiler::ScopedSpan span("warmup: " + name);
+        task();
+    });
+}
+
+void StartupWarmup::waitForAll()
+{
+    if (threads.empty())
+        return;
+
+    const StartupProfiler::ScopedSpan span("warmup join (" + juce::String(static_cast<int>(threads.size())) + " tasks)");
+    for (auto& thread : threads)
+        if (thread.joinable())
+            thread.join();
+    threads.clear();
+}
+
+} // namespace convo
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <JuceHeader.h>
+
+namespace convo {
+
+/**
+    StartupWarmup: 起動時の互いに独立な初期化 (ライブラリのウォームアップ・キャッシュ索引の走査など) を
+    バックグラウンドで並列に走らせるタスク群。
+
+    launch() ごとに短命なスレッドを 1 本起こし、タスクを StartupProfiler の区間として記録する。
+    waitForAll() かデストラクタで全タスクを join する。タスクが参照するオブジェクトより
+    先に join されるよう、所有者はメンバの宣言順 (または明示的な waitForAll) で保証すること。
+
+    スレッド: launch / waitForAll は Message Thread 専用。タスクは例外を外へ出さないこと
+    (noexcept のスレッド関数から呼ぶため、投げると std::terminate)。
+*/
+class StartupWarmup
+{
+public:
+    StartupWarmup() = default;
+    ~StartupWarmup();
+
+    void launch(const juce::String& name, std::function<void()> task);
+    void waitForAll();
+
+private:
+    std::vector<std::thread> threads;
+
+    JUCE_DECLARE_NON_COPYABLE (StartupWarmup)
+};
+
+} // namespace convo
@@ -1,307 +1,228 @@
 //============================================================================
-#include <JuceHeader.h>
+#include <algorithm>
 #include <cmath>
 #include <cstring>
-#include <immintrin.h>
+#include <vector>
 
 #include "TruePeakDetector.h"
 
 //============================================================================
 TruePeakDetector::~TruePeakDetector()
 {
-    for (auto& stage : stages)
-    {
-        stage.convCoeffs.reset();
-        stage.convCoeffsReversed.reset();
-        for (int ch = 0; ch < kMaxChannels; ++ch)
-            stage.upHistory[ch].reset();
-    }
-    upsampleBuffer.reset();
+    for (auto& phase : phases)
+        phase.coeffsReversed.reset();
+    for (auto& channel : history)
+        channel.reset();
+    phaseOutput.reset();
 }
 
 void TruePeakDetector::prepare(double sampleRate, int maxBlockSize, int taps)
 {
     convo::publishAtomic(currentSampleRate, sampleRate, std::memory_order_release);
 
-    // ★ レイアウト [Stage0L | Stage0R | Stage1L | Stage1R] = 2N+2N+4N+4N = 12N
-    //    constexpr 導出: Stage0Channels(2)*UpsampleFactor1(2) + Stage1Channels(2)*UpsampleFactor2(4) = 12
-    constexpr int kStage0Channels = 2;
-    constexpr int kStage1Channels = 2;
-    constexpr int kUpsampleFactor1 = 2;
-    constexpr int kUpsampleFactor2 = 4;
-    constexpr int kWorkBufferMultiplier =
-        kStage0Channels * kUpsampleFactor1 +
-        kStage1Channels * kUpsampleFactor2;
+    const auto& kernels = convo::dsp::activeKernels();
+    peakAbsKernel = kernels.peakAbs;
+    firKernel = kernels.firVertical;
 
-    const int upBufferSize = maxBlockSize * kWorkBufferMultiplier;
-    if (upBufferSize > bufferCapacity || !upsampleBuffer)
-    {
-        upsampleBuffer = convo::makeAlignedArray<double>(static_cast<size_t>(upBufferSize));
-        bufferCapacity = upBufferSize;
-    }
+    for (auto& channel : history)
+        channel.reset();
+    maxInputSamples = 0;
 
-    // 2段の2倍OSで4倍を構成
-    int stageInputMax = maxBlockSize;
-    for (int i = 0; i < 2; ++i)
-    {
-        const int stageTaps = (i == 0) ? taps : std::max(15, taps / 2);
-        prepareStage(stages[i], stageTaps, kDefaultAttenuationDb, stageInputMax);
-        stageInputMax *= 2;
-    }
-    upsampledCapacity = maxBlockSize * kWorkBufferMultiplier;
+    if (!designPhases(taps, kDefaultAttenuationDb))
+        return;
+
+    maxInputSamples = std::max(1, maxBlockSize);
+    for (auto& channel : history)
+        channel = convo::makeAlignedArray<double>(static_cast<size_t>(historyKeep + maxInputSamples));
+    if (!phaseOutput)
+        phaseOutput = convo::makeAlignedArray<double>(static_cast<size_t>(kChunkSamples));
     reset();
 }
 
 void TruePeakDetector::reset() noexcept
 {
     peakHold = 0.0;
-    for (auto& stage : stages)
-    {
-        for (int ch = 0; ch < kMaxChannels; ++ch)
-        {
-            if (stage.upHistory[ch])
-                juce::FloatVectorOperations::clear(stage.upHistory[ch].get(), stage.upHistorySize);
-        }
-    }
+    clearHistories();
 }
 
-// ★ scanPeak: |buf[i]| の最大値を求めるヘルパー (匿名名前空間、static linkage)
-//    RT 初回初期化 (guard variable) を避けるため static local は使用しない。
-namespace {
-
-double scanPeak(const double* buf, int n) noexcept
+void TruePeakDetector::clearHistories() noexcept
 {
-    double peak = 0.0;
-#if defined(__AVX2__)
-    // ローカル変数 _mm256_set1_pd は 1 命令 (vsetpd) で実質ゼロコスト
-    const __m256d signMask = _mm256_set1_pd(-0.0);
-    __m256d vPeak = _mm256_setzero_pd();
-    int i = 0;
-    for (; i <= n - 4; i += 4) {
-        __m256d v = _mm256_andnot_pd(signMask, _mm256_loadu_pd(buf + i));
-        vPeak = _mm256_max_pd(vPeak, v);
+    for (auto& channel : history)
+    {
+        if (channel)
+            std::fill(channel.get(), channel.get() + historyKeep + maxInputSamples, 0.0);
     }
-    alignas(32) double tmp[4];
-    _mm256_store_pd(tmp, vPeak);
-    for (int j = 0; j < 4; ++j) if (tmp[j] > peak) peak = tmp[j];
-    for (; i < n; ++i) { double v = std::abs(buf[i]); if (v > peak) peak = v; }
-#else
-    for (int i = 0; i < n; ++i) { double v = std::abs(buf[i]); if (v > peak) peak = v; }
-#endif
-    return peak;
 }
 
-} // anonymous namespace
-
 double TruePeakDetector::processBlock(const double* dataL, const double* dataR, int numSamples) noexcept
 {
-    if (numSamples <= 0 || !upsampleBuffer)
+    if (numSamples <= 0 || !history[0] || !history[1])
         return 0.0;
 
-    double* work = upsampleBuffer.get();
-    const int up1Samples = numSamples * 2;
-    const int up2Samples = numSamples * 4;
-
-    // オフセット: work 領域のレイアウト
-    //   [ Stage0 L | Stage0 R | Stage1 L | Stage1 R ]
-    //   Stage0 は zero-offset、それ以外は up1Samples/up2Samples に依存する runtime 値
-    constexpr int kStage0LOffset = 0;
-    const int   kStage0ROffset = up1Samples;
-    const int   kStage1LOffset = up1Samples * 2;
-    const int   kStage1ROffset = up1Samples * 2 + up2Samples;
+    skippedChunks = 0;
+    totalChunks = 0;
 
-    // Stage 0: 1x -> 2x (L)
-    interpolateStage(stages[0], dataL, numSamples, work + kStage0LOffset, 0);
-    // Stage 0: 1x -> 2x (R)
-    if (dataR != nullptr)
-        interpolateStage(stages[0], dataR, numSamples, work + kStage0ROffset, 1);
-    else
-        interpolateStage(stages[0], dataL, numSamples, work + kStage0ROffset, 1);
+    double peak = 0.0;
+    for (int offset = 0; offset < numSamples; offset += maxInputSamples)
+    {
+        const int n = std::min(maxInputSamples, numSamples - offset);
+        double* histL = history[0].get();
+        double* histR = history[1].get();
 
-    // Stage 1: 2x -> 4x (L + R)
-    interpolateStage(stages[1], work + kStage0LOffset, up1Samples, work + kStage1LOffset, 0);  // L
-    interpolateStage(stages[1], work + kStage0ROffset, up1Samples, work + kStage1ROffset, 1);  // R
+        // モノラルは R 履歴にも L を積む (以後ステレオになっても履歴が連続する)。ピークは L と同じなので走査しない
+        std::memcpy(histL + historyKeep, dataL + offset, static_cast<size_t>(n) * sizeof(double));
+        std::memcpy(histR + historyKeep, (dataR != nullptr ? dataR : dataL) + offset, static_cast<size_t>(n) * sizeof(double));
 
-    // Peak scan: L/R 別領域で独立実行
-    double peakL = scanPeak(work + kStage1LOffset, up2Samples);
-    double peakR = scanPeak(work + kStage1ROffset, up2Samples);
-    double peak = std::max(peakL, peakR);
+        peak = std::max(peak, scanChannel(histL, n, std::max(peakHold, peak)));
+        if (dataR != nullptr)
+            peak = std::max(peak, scanChannel(histR, n, std::max(peakHold, peak)));
 
-    // ピークホールド（指数平滑）
-    if (peak > peakHold)
-        peakHold = peak;
-    else
-        peakHold *= 0.999; // 減衰時定数: 約1000サンプル
+        std::memmove(histL, histL + n, static_cast<size_t>(historyKeep) * sizeof(double));
+        std::memmove(histR, histR + n, static_cast<size_t>(historyKeep) * sizeof(double));
+    }
 
+    updatePeakHold(peak);
     return peakHold;
 }
 
-//==============================================================================
-// 内部実装: Kaiser窓 FIR halfband フィルタ
-//==============================================================================
-double TruePeakDetector::besselI0(double x) noexcept
+double TruePeakDetector::scanChannel(const double* hist, int numSamples, double runningMax) noexcept
 {
-    double sum = 1.0;
-    double term = 1.0;
-    const double xx = x * x;
-    for (int n = 1; n < 100; ++n)
+    const int lastTap = firstTap + phaseTaps - 1;
+    const double* input = hist + historyKeep;
+    double peak = 0.0;
+
+    for (int start = 0; start < numSamples; start += kChunkSamples)
     {
-        term *= xx / (4.0 * static_cast<double>(n) * static_cast<double>(n));
-        sum += term;
-        if (term < sum * 1.0e-18)
-            break;
+        const int n = std::min(kChunkSamples, numSamples - start);
+        ++totalChunks;
+
+        // 位相 0 (原サンプルの遅延) は FIR を通さず、そのまま走査する
+        for (const auto& phase : phases)
+        {
+            if (phase.isDelay)
+                peak = std::max(peak, peakAbsKernel(input + start - phase.delay, n));
+        }
+
+        // 補間位相の上界: 参照する入力 x[n − lastTap .. n − firstTap] の最大 × 係数の絶対値和
+        const double* window = input + start - lastTap;
+        const double bound = peakAbsKernel(window, n + phaseTaps - 1) * maxPhaseGain;
+        if (bound <= std::max(runningMax, peak) || bound < kFloor)
+        {
+            ++skippedChunks;
+            continue;
+        }
+
+        for (const auto& phase : phases)
+        {
+            if (phase.isDelay)
+                continue;
+            firKernel(window, phase.coeffsReversed.get(), phaseTaps, phaseOutput.get(), n);
+            peak = std::max(peak, peakAbsKernel(phaseOutput.get(), n));
+        }
     }
-    return sum;
+    return peak;
 }
 
-double TruePeakDetector::dotProductAvx2(const double* __restrict x,
-                                        const double* __restrict coeffs,
-                                        int n) noexcept
+void TruePeakDetector::updatePeakHold(double peak) noexcept
 {
-    __m256d acc0 = _mm256_setzero_pd();
-    __m256d acc1 = _mm256_setzero_pd();
-    __m256d acc2 = _mm256_setzero_pd();
-    __m256d acc3 = _mm256_setzero_pd();
-    int i = 0;
-    for (; i <= n - 16; i += 16)
-    {
-        _mm_prefetch(reinterpret_cast<const char*>(x + i + 64), _MM_HINT_T0);
-        _mm_prefetch(reinterpret_cast<const char*>(coeffs + i + 64), _MM_HINT_T0);
-        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i),      _mm256_load_pd(coeffs + i),      acc0);
-        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4),  _mm256_load_pd(coeffs + i + 4),  acc1);
-        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8),  _mm256_load_pd(coeffs + i + 8),  acc2);
-        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_load_pd(coeffs + i + 12), acc3);
-    }
-    for (; i <= n - 4; i += 4)
-        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_load_pd(coeffs + i), acc0);
-    acc0 = _mm256_add_pd(acc0, acc1);
-    acc2 = _mm256_add_pd(acc2, acc3);
-    acc0 = _mm256_add_pd(acc0, acc2);
-    __m128d vLo = _mm256_castpd256_pd128(acc0);
-    __m128d vHi = _mm256_extractf128_pd(acc0, 1);
-    __m128d vSum = _mm_add_pd(vLo, vHi);
-    vSum = _mm_hadd_pd(vSum, vSum);
-    double sum = _mm_cvtsd_f64(vSum);
-    for (; i < n; ++i)
-        sum += x[i] * coeffs[i];
-    return sum;
+    // ピークホールド（指数平滑）
+    if (peak > peakHold)
+        peakHold = peak;
+    else
+        peakHold *= 0.999; // 減衰時定数: 約1000サンプル
 }
 
-void TruePeakDetector::prepareStage(Stage& stage, int taps, double attenuationDb, int stageInputMax)
+//==============================================================================
+// 位相係数の設計: Kaiser窓 FIR halfband (convo::dsp::HalfBandFir) 2 段のインパルス応答を
+// 4 位相へ分解する。カスケードと同じ係数・同じ補間ゲインになる。
+//==============================================================================
+bool TruePeakDetector::designPhases(int taps, double attenuationDb)
 {
-    stage.convCoeffs.reset();
-    stage.convCoeffsReversed.reset();
-    for (int ch = 0; ch < kMaxChannels; ++ch)
-        stage.upHistory[ch].reset();
-
-    stage.taps = juce::jmax(3, taps | 1);
-    stage.centerTap = (stage.taps - 1) / 2;
-    stage.centerParity = stage.centerTap & 1;
-    stage.convParity = 1 - stage.centerParity;
-    stage.maxInputSamples = stageInputMax;
-    stage.maxOutputSamples = stageInputMax * 2;
-
-    auto rawCoeffs = convo::makeAlignedArray<double>(static_cast<size_t>(stage.taps));
-    if (!rawCoeffs) return;
-
-    const double beta = (attenuationDb > 50.0)
-        ? (0.1102 * (attenuationDb - 8.7))
-        : ((attenuationDb >= 21.0)
-            ? (0.5842 * std::pow(attenuationDb - 21.0, 0.4) + 0.07886 * (attenuationDb - 21.0))
-            : 0.0);
-    const double i0Beta = besselI0(beta);
-    const int M = stage.centerTap;
-
-    for (int n = 0; n < stage.taps; ++n)
+    for (auto& phase : phases)
     {
-        const double t = static_cast<double>(n - M);
-        const double sinc = (n == M)
-            ? 0.5
-            : (std::sin(juce::MathConstants<double>::pi * 0.5 * t) / (juce::MathConstants<double>::pi * t));
-        const double frac = static_cast<double>(n - M) / static_cast<double>(M);
-        const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - frac * frac))) / i0Beta;
-        rawCoeffs[n] = sinc * window;
+        phase.coeffsReversed.reset();
+        phase.isDelay = false;
+        phase.delay = 0;
     }
-
-    for (int n = 0; n < stage.taps; ++n)
+    firstTap = 0;
+    phaseTaps = 0;
+    historyKeep = 0;
+    maxPhaseGain = 0.0;
+
+    convo::dsp::HalfBandFir stages[kNumStages];
+    int impulseLength = 1;
+    for (int i = 0; i < kNumStages; ++i)
     {
-        if (n != stage.centerTap && ((n & 1) == stage.centerParity))
-            rawCoeffs[n] = 0.0;
+        const int stageTaps = (i == 0) ? taps : std::max(15, taps / 2);
+        if (!stages[i].design(stageTaps, attenuationDb))
+            return false;
+        impulseLength += stages[i].taps;
     }
 
-    double sum = 0.0;
-    for (int i = 0; i < stage.taps; ++i)
-        sum += rawCoeffs[i];
-    if (std::abs(sum) > 1.0e-20)
+    // インパルスをカスケードに通す (段ごとに零の履歴 + 入力)
+    std::vector<double> signal(static_cast<size_t>(impulseLength), 0.0);
+    signal[0] = 1.0;
+    for (const auto& stage : stages)
     {
-        const double inv = 1.0 / sum;
-        for (int i = 0; i < stage.taps; ++i)
-            rawCoeffs[i] *= inv;
+        const int keep = stage.interpolateHistoryKeep();
+        const int numIn = static_cast<int>(signal.size());
+        std::vector<double> stageHistory(static_cast<size_t>(keep + numIn), 0.0);
+        std::copy(signal.begin(), signal.end(), stageHistory.begin() + keep);
+        std::vector<double> output(static_cast<size_t>(numIn) * 2);
+        stage.interpolate(stageHistory.data(), keep, numIn, output.data());
+        signal = std::move(output);
     }
 
-    rawCoeffs[stage.centerTap] = 0.5;
-    double nonCenterSum = 0.0;
-    for (int i = 0; i < stage.taps; ++i)
-        if (i != stage.centerTap) nonCenterSum += rawCoeffs[i];
-    if (std::abs(nonCenterSum) > 1.0e-20)
+    // h[4k + p] = g_p[k]。全位相で共通のサポート [firstTap, lastTap] に揃える
+    const int numTaps = static_cast<int>(signal.size()) / kOversamplingRatio;
+    int lastTap = -1;
+    firstTap = numTaps;
+    for (int k = 0; k < numTaps; ++k)
     {
-        const double scale = 0.5 / nonCenterSum;
-        for (int i = 0; i < stage.taps; ++i)
+        for (int p = 0; p < kOversamplingRatio; ++p)
         {
-            if (i != stage.centerTap)
-                rawCoeffs[i] *= scale;
+            if (signal[static_cast<size_t>(k * kOversamplingRatio + p)] != 0.0)
+            {
+                firstTap = std::min(firstTap, k);
+                lastTap = std::max(lastTap, k);
+            }
         }
     }
-    rawCoeffs[stage.centerTap] = 0.5;
+    if (lastTap < firstTap)
+        return false;
 
-    stage.convCount = (stage.taps - stage.convParity + 1) / 2;
-    stage.convCoeffs = convo::makeAlignedArray<double>(static_cast<size_t>(stage.convCount));
-    stage.convCoeffsReversed = convo::makeAlignedArray<double>(static_cast<size_t>(stage.convCount));
-    if (!stage.convCoeffs || !stage.convCoeffsReversed) return;
+    phaseTaps = lastTap - firstTap + 1;
+    historyKeep = lastTap;
 
-    for (int r = 0; r < stage.convCount; ++r)
+    for (int p = 0; p < kOversamplingRatio; ++p)
     {
-        const int k = stage.convParity + (r << 1);
-        stage.convCoeffs[r] = (k < stage.taps) ? rawCoeffs[k] : 0.0;
-        stage.convCoeffsReversed[stage.convCount - 1 - r] = stage.convCoeffs[r];
-    }
-
-    stage.centerCoeff = rawCoeffs[stage.centerTap];
-    stage.centerDelayInput = (stage.centerTap - stage.centerParity) / 2;
-    stage.historyUpKeep = juce::jmax(stage.convCount - 1, stage.centerDelayInput);
-    stage.upHistorySize = stage.historyUpKeep + stage.maxInputSamples + 16;
-
-    for (int ch = 0; ch < kMaxChannels; ++ch)
-    {
-        stage.upHistory[ch] = convo::makeAlignedArray<double>(static_cast<size_t>(stage.upHistorySize));
-        if (stage.upHistory[ch])
-            juce::FloatVectorOperations::clear(stage.upHistory[ch].get(), stage.upHistorySize);
-    }
-}
-
-void TruePeakDetector::interpolateStage(const Stage& stage,
-                                        const double* input, int inputSamples,
-                                        double* output, int channel) noexcept
-{
-    auto* history = stage.upHistory[channel].get();
-    if (!history || !stage.convCoeffs) return;
-
-    const int histLen = stage.historyUpKeep;
-    const int convCnt = stage.convCount;
-    const int centerDelay = stage.centerDelayInput;
-    const double cCoeff = stage.centerCoeff;
-    const int convParity = stage.convParity;
+        auto& phase = phases[p];
+        int nonZero = 0;
+        int lastNonZero = 0;
+        double absSum = 0.0;
+        for (int k = firstTap; k <= lastTap; ++k)
+        {
+            const double g = signal[static_cast<size_t>(k * kOversamplingRatio + p)];
+            if (g != 0.0)
+            {
+                ++nonZero;
+                lastNonZero = k;
+                absSum += std::abs(g);
+            }
+        }
 
-    // 履歴シフト
-    std::memmove(history, history + inputSamples, static_cast<size_t>(histLen) * sizeof(double));
-    std::memcpy(history + histLen, input, static_cast<size_t>(inputSamples) * sizeof(double));
+        const double single = signal[static_cast<size_t>(lastNonZero * kOversamplingRatio + p)];
+        if (nonZero == 1 && std::abs(single - 1.0) < 1.0e-12)
+        {
+            phase.isDelay = true;
+            phase.delay = lastNonZero;
+            continue;
+        }
 
-    for (int n = 0; n < inputSamples; ++n)
-    {
-        const double* base = history + histLen + n - centerDelay;
-        const double even = base[0] * cCoeff + dotProductAvx2(base - convParity, stage.convCoeffsReversed.get(), convCnt);
-        const double odd  = base[1] * cCoeff + dotProductAvx2(base - 1 + convParity, stage.convCoeffsReversed.get(), convCnt);
-        output[n * 2]     = even;
-        output[n * 2 + 1] = odd;
+        phase.coeffsReversed = convo::makeAlignedArray<double>(static_cast<size_t>(phaseTaps));
+        for (int r = 0; r < phaseTaps; ++r)
+            phase.coeffsReversed[r] = signal[static_cast<size_t>((lastTap - r) * kOversamplingRatio + p)];
+        maxPhaseGain = std::max(maxPhaseGain, absSum);
     }
+    return true;
 }
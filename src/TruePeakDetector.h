@@ -1,11 +1,11 @@
 //============================================================================
 #pragma once
 
-#include <JuceHeader.h>
 #include <atomic>
 #include <cstdint>
 
 #include "AlignedAllocation.h"
+#include "dsp/HalfBandFir.h"
 #include "audioengine/AtomicAccess.h"
 
 //============================================================================
@@ -13,7 +13,15 @@
     TruePeakDetector ── ITU-R BS.1770-4/5 準拠 True Peak 検出器
 
     4倍オーバーサンプリングによるインターサンプルピーク検出。
-    計測専用（ゲイン演算なし）。Audio Thread 安全。
+    計測専用（ゲイン演算なし）。processBlock は確保なし。JUCE 非依存。
+    エンジンでは MeteringWorker が出力タップ (meteringFifo) の中身に対して呼ぶ。
+
+    ★ ポリフェーズ形式: 2x ハーフバンド 2 段のカスケードを prepare() で 4 位相の FIR に畳み込み、
+      補間信号は作らずに各位相の出力の最大値だけを求める。位相 0 は原サンプルそのもの (遅延のみ)
+      なので FIR を通さない。さらに kChunkSamples ごとに
+        入力窓の最大|x| × 位相係数の絶対値和 (補間値の上界)
+      が、そのブロックのここまでの最大値とホールド値、または kFloor を超えない区間は FIR を省く。
+      上界がホールド値以下ならホールドの更新結果は省かない場合と同じになる。
 */
 class TruePeakDetector
 {
@@ -24,6 +32,9 @@ public:
     // 確定tap数: 63 （ITU-R BS.1770-3 Example 48tapを上回る。Hansen 2012文献確定）
     static constexpr int kDefaultTaps = 63;
     static constexpr double kDefaultAttenuationDb = 100.0;
+    // 早期打ち切りの単位 (入力サンプル) と、これ未満の補間ピークは計算しない表示下限 (-120 dBFS)
+    static constexpr int kChunkSamples = 64;
+    static constexpr double kFloor = 1.0e-6;
 
     TruePeakDetector() = default;
     ~TruePeakDetector();
@@ -31,47 +42,51 @@ public:
     TruePeakDetector(const TruePeakDetector&) = delete;
     TruePeakDetector& operator=(const TruePeakDetector&) = delete;
 
-    /** 4倍オーバーサンプラを準備 (Message Thread) */
+    /** 4倍補間の位相係数を準備 (確保あり。processBlock と同じスレッドから) */
     void prepare(double sampleRate, int maxBlockSize, int taps = kDefaultTaps);
 
-    /** Audio Thread: ブロックのTruePeakを検出 */
+    /** ブロックのTruePeakを検出 (dataR == nullptr はモノラル) */
     double processBlock(const double* dataL, const double* dataR, int numSamples) noexcept;
 
     void reset() noexcept;
 
+    /** テスト/ベンチ用: 直近の processBlock で FIR を省いた区間数と全区間数 */
+    int lastSkippedChunks() const noexcept { return skippedChunks; }
+    int lastTotalChunks() const noexcept { return totalChunks; }
+
 private:
-    convo::ScopedAlignedPtr<double> upsampleBuffer;
-    int bufferCapacity = 0;
-    int upsampledCapacity = 0;
+    // 4x 出力 y[4n + p] = Σ_k g_p[k] · x[n − k]。g_p はサポート [firstTap, firstTap + phaseTaps) のみ持つ
+    struct Phase {
+        convo::ScopedAlignedPtr<double> coeffsReversed;   // FirVerticalKernel 用 (時間逆順、phaseTaps 個)
+        bool isDelay = false;                              // 係数 1 のタップ 1 本だけ (原サンプル)
+        int delay = 0;                                     // isDelay のときの k
+    };
+
+    Phase phases[kOversamplingRatio];
+    int firstTap = 0;
+    int phaseTaps = 0;
+    double maxPhaseGain = 0.0;     // max_p Σ_k |g_p[k]| (補間値の上界係数)
+
+    // チャンネルごとの入力履歴 [historyKeep 個の過去 | 新入力 maxBlockSize 個]
+    convo::ScopedAlignedPtr<double> history[kMaxChannels];
+    int historyKeep = 0;
+    int maxInputSamples = 0;
+    convo::ScopedAlignedPtr<double> phaseOutput;       // 1 区間ぶんの位相出力
     double peakHold = 0.0;
+    int skippedChunks = 0;
+    int totalChunks = 0;
     std::atomic<double> currentSampleRate{ 0.0 };
 
-    // 内部4倍オーバーサンプラ
-    struct Stage {
-        int taps = 0;
-        int centerTap = 0;
-        int centerParity = 0;
-        int convParity = 0;
-        int convCount = 0;
-        int centerDelayInput = 0;
-        int historyUpKeep = 0;
-        int historyDownKeep = 0;
-        int maxInputSamples = 0;
-        int maxOutputSamples = 0;
-        double centerCoeff = 0.5;
-        convo::ScopedAlignedPtr<double> convCoeffs;
-        convo::ScopedAlignedPtr<double> convCoeffsReversed;
-        convo::ScopedAlignedPtr<double> upHistory[2];
-        int upHistorySize = 0;
-    };
-
-    Stage stages[2]; // 4x = 2 stages (2x + 2x)
+    // 2 段の 2x ハーフバンドで 4x を構成する (HalfBandFir は係数設計にだけ使う)
+    static constexpr int kNumStages = convo::dsp::halfBandStagesForRatio(kOversamplingRatio);
+    static_assert((1 << kNumStages) == kOversamplingRatio, "kOversamplingRatio must be a power of two");
 
-    void prepareStage(Stage& stage, int taps, double attenuationDb, int stageInputMax);
-    static double besselI0(double x) noexcept;
-    static double dotProductAvx2(const double* x, const double* coeffs, int n) noexcept;
+    // prepare() で KernelDispatch から解決 (prepare 前は履歴未確保のため未使用)
+    convo::dsp::PeakAbsKernel peakAbsKernel = nullptr;
+    convo::dsp::FirVerticalKernel firKernel = nullptr;
 
-    void interpolateStage(const Stage& stage,
-                          const double* input, int inputSamples,
-                          double* output, int channel) noexcept;
+    bool designPhases(int taps, double attenuationDb);
+    double scanChannel(const double* history, int numSamples, double runningMax) noexcept;
+    void updatePeakHold(double peak) noexcept;
+    void clearHistories() noexcept;
 };
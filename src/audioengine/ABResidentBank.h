@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "RuntimeBuildTypes.h"
+
+namespace convo {
+
+// ★ A/B 比較スロット
+enum class ABSlot : std::uint8_t
+{
+    A = 0,
+    B = 1
+};
+
+[[nodiscard]] constexpr const char* abSlotName(ABSlot slot) noexcept
+{
+    return slot == ABSlot::A ? "A" : "B";
+}
+
+[[nodiscard]] constexpr ABSlot otherABSlot(ABSlot slot) noexcept
+{
+    return slot == ABSlot::A ? ABSlot::B : ABSlot::A;
+}
+
+// 常駐 DSP の構築入力がいまのデバイス条件 (レート・ブロック長) でそのまま使えるか
+[[nodiscard]] inline bool isResidentBuildRateCompatible(const BuildInput& resident,
+                                                        double sampleRate,
+                                                        int blockSize) noexcept
+{
+    return std::abs(resident.sampleRate - sampleRate) <= 1.0e-6 && resident.blockSize == blockSize;
+}
+
+// 要求された rebuild が常駐 DSP と同じ構築入力か。A/B 切替直後、状態復元が発火する
+// rebuild は再公開済みの常駐 DSP と同じものを組み直すだけなので捨てる
+[[nodiscard]] inline bool isSameResidentBuild(const BuildInput& resident,
+                                              std::uint64_t residentConvolverFingerprint,
+                                              const BuildInput& requested,
+                                              std::uint64_t requestedConvolverFingerprint) noexcept
+{
+    return isResidentBuildRateCompatible(resident, requested.sampleRate, requested.blockSize)
+        && residentConvolverFingerprint == requestedConvolverFingerprint
+        && resident.ditherBitDepth == requested.ditherBitDepth
+        && resident.oversamplingFactor == requested.oversamplingFactor
+        && resident.oversamplingType == requested.oversamplingType
+        && resident.oversamplingSinglePrecision == requested.oversamplingSinglePrecision
+        && resident.noiseShaperType == requested.noiseShaperType
+        && resident.processingOrder == requested.processingOrder
+        && resident.eqBypassed == requested.eqBypassed
+        && resident.convBypassed == requested.convBypassed
+        && resident.softClipEnabled == requested.softClipEnabled
+        && resident.saturationAmount == requested.saturationAmount
+        && resident.inputHeadroomGain == requested.inputHeadroomGain
+        && resident.outputMakeupGain == requested.outputMakeupGain
+        && resident.convolverInputTrimGain == requested.convolverInputTrimGain
+        && resident.autoGainStagingEnabled == requested.autoGainStagingEnabled;
+}
+
+//==============================================================================
+// ABResidentBank: A/B 比較用に構築済み DSP を常駐させる 2 スロットの台帳。
+//
+//   - capture(): 公開中の DSP をスロットに常駐登録する。登録された DSP は retire 経路で
+//     破棄されず「park」される (parkIfResident)。
+//   - acquireForPublish(): park 中の DSP を再公開用に取り出す。park 時点の epoch が
+//     全 reader の最小 epoch より古い (= Audio Thread から到達不能になった) ものだけを返す。
+//   - どのスロットからも参照されなくなった park 中 DSP は呼び出し側へ返却し、
+//     呼び出し側が EBR 経由で破棄する。
+//
+//   同一 DSP を A/B 両方が参照することがある (B を空のまま選んで何も編集しなかった場合)。
+//   park 状態は DSP 単位で両スロットに揃えて持つ。
+//   Message Thread (capture/flip) と rebuild/publish 経路 (retire) の双方から呼ばれるため
+//   全操作を mutex で直列化する。RT からは呼ばない。
+//==============================================================================
+template <typename Core>
+class ABResidentBank
+{
+public:
+    struct Released
+    {
+        Core* core = nullptr;   // 呼び出し側が破棄すべき park 済み DSP (なければ nullptr)
+    };
+
+    // slot に core を常駐登録する。押し出した DSP が park 済みで他スロットからも
+    // 参照されていなければ返す。
+    [[nodiscard]] Released capture(ABSlot slot, Core* core) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry& entry = entries_[index(slot)];
+        if (entry.core == core)
+            return {};
+        Released released = detachLocked(slot);
+        entry.core = core;
+        entry.parked = false;
+        entry.parkEpoch = 0;
+        return released;
+    }
+
+    // slot の常駐を解除する。
+    [[nodiscard]] Released release(ABSlot slot) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return detachLocked(slot);
+    }
+
+    // retire 経路: core が常駐中なら park して true。呼び出し側は破棄を見送る。
+    [[nodiscard]] bool parkIfResident(Core* core, std::uint64_t epoch) noexcept
+    {
+        if (core == nullptr)
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool resident = false;
+        for (auto& entry : entries_)
+        {
+            if (entry.core != core)
+                continue;
+            entry.parked = true;
+            entry.parkEpoch = epoch;
+            resident = true;
+        }
+        return resident;
+    }
+
+    // 再公開用に park 中の DSP を取り出す。取り出した DSP は park 解除され、
+    // 次の retire で再び park される。条件を満たさなければ nullptr。
+    [[nodiscard]] Core* acquireForPublish(ABSlot slot, std::uint64_t minReaderEpoch) noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry& entry = entries_[index(slot)];
+        if (entry.core == nullptr || !entry.parked || entry.parkEpoch >= minReaderEpoch)
+            return nullptr;
+
+        for (auto& other : entries_)
+        {
+            if (other.core == entry.core)
+                other.parked = false;
+        }
+        return entry.core;
+    }
+
+    [[nodiscard]] Core* residentCore(ABSlot slot) const noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_[index(slot)].core;
+    }
+
+    [[nodiscard]] bool isParked(ABSlot slot) const noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_[index(slot)].parked;
+    }
+
+    // park 中 (= 公開されておらず待機中) の DSP を重複なしで列挙する。
+    template <typename Fn>
+    void forEachParkedCore(Fn&& fn) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Entry& a = entries_[0];
+        const Entry& b = entries_[1];
+        if (a.core != nullptr && a.parked)
+            fn(*a.core);
+        if (b.core != nullptr && b.parked && b.core != a.core)
+            fn(*b.core);
+    }
+
+private:
+    struct Entry
+    {
+        Core* core = nullptr;
+        bool parked = false;
+        std::uint64_t parkEpoch = 0;
+    };
+
+    [[nodiscard]] static constexpr std::size_t index(ABSlot slot) noexcept
+    {
+        return static_cast<std::size_t>(slot);
+    }
+
+    [[nodiscard]] Released detachLocked(ABSlot slot) noexcept
+    {
+        Entry& entry = entries_[index(slot)];
+        Released released;
+        const Entry& other = entries_[index(otherABSlot(slot))];
+        if (entry.core != nullptr && entry.parked && other.core != entry.core)
+            released.core = entry.core;
+        entry = Entry {};
+        return released;
+    }
+
+    mutable std::mutex mutex_;
+    std::array<Entry, 2> entries_ {};
+};
+
+} // namespace convo
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "LockFreeRingBuffer.h"
+
+// ストリーミング信号キャプチャ用 AudioBlock（2ch, 256サンプル, float 格納）
+//   学習器は 4096 点 FFT 評価の入力にしか使わないため float で十分。
+//   double 格納時の半分 (約 2 KB/ブロック) になり、Audio Thread のストア帯域も半減する。
+struct AudioBlock {
+    static constexpr int kMaxSamples = 256;
+    float L[kMaxSamples];
+    float R[kMaxSamples];
+    int numSamples = 0;
+    // このブロックが代表する再生サンプル数 = numSamples + 直前に書き込まなかったサンプル数
+    // (間引き区間 / キュー満杯)。学習器の再生時間カウントはこちらを使う
+    int representedSamples = 0;
+    int sampleRateHz = 0;
+    int bitDepth = 0;
+    int adaptiveCoeffBankIndex = 0;
+    std::uint64_t sessionId = 0;
+};
+
+// 1 世代が使う音声は最新 kRecentSampleRequest (= 34816) サンプルだけで、それ以外のブロックは
+// 再生時間カウントにしか使われない。書き込めなかった分は representedSamples で持ち越すので
+// キュー満杯は鮮度の低下にしかならず、容量は 1 世代分の窓の数倍あれば足りる (約 2 MB)
+inline constexpr std::size_t kAdaptiveCaptureQueueCapacity = 1024;
+using AdaptiveCaptureQueue = LockFreeRingBuffer<AudioBlock, kAdaptiveCaptureQueueCapacity>;
+
+// 間引き時に連続して書き込むブロック数 (36864 サンプル)。学習器の 1 世代分の窓より長く、
+// 窓がバースト境界 (不連続点) をまたがないようにする
+inline constexpr int kAdaptiveCaptureBurstBlocks = 144;
+// 間引き率の上限: stride = N のとき (N × バースト) ごとに 1 バーストだけ書き込む
+inline constexpr int kAdaptiveCaptureMaxStride = 8;
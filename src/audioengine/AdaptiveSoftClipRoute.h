@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+//==============================================================================
+// AdaptiveSoftClipRoute — OS = 1 の SoftClip 局所 2 倍 OS を必要なブロックだけ回す経路選択
+//
+//   SoftClip の曲線は |x| <= threshold − knee (clipStart) で恒等なので、信号がそこから十分下にある間は
+//   局所 OS (processUp → SoftClip → processDown) の出力は「帯域制限された x の D サンプル遅れ」にすぎない。
+//   その間は OS を止め、D サンプルの遅延線 (1x 経路) で置き換える。D は prepare 時に局所 OS の
+//   インパルス応答から実測した整数遅延で、報告レイテンシ (softClipLatencyBaseRateSamples) と一致する。
+//   線形位相 FIR の局所 OS (非 MinimumPhase) だけが対象。全域通過 IIR は位相が周波数依存で遅延線と揃わない。
+//
+//   判定はブロック単位で、処理前のブロック全体のピークを見る (= 1 ブロック分の先読み)。
+//     - 1x → OS: ピークが clipStart·kEngageRatio を超えたブロックで即座に戻す。戻る前に、直前の
+//       primeSamples 個 (up + down の履歴長) の入力を OS に流して出力を捨て、履歴を作り直す
+//       (PrimeAndOversample)。1x の間 SoftClip は恒等だったので、FIR の履歴は OS を回し続けた場合と一致し、
+//       そのブロックから clip が効いても継ぎ目は出ない。クロスフェードすると未 clip の 1x 出力が
+//       混ざるため、この向きはフェードしない。
+//     - OS → 1x: ピークが clipStart·kReleaseRatio 以下のブロックが holdSamples 続いたら、次の静かな
+//       ブロックで両経路を回し、ブロック内で OS 出力から遅延線へ線形にクロスフェードする (FadeToBypass)。
+//       両者の差は局所 OS の通過帯域外 (base rate の Nyquist 近傍) の成分だけ。
+//   kEngageRatio と kReleaseRatio の間はヒステリシス帯で、1x なら 1x、OS なら OS のまま (hold は数え直す)。
+//
+//   履歴は経路に関係なく毎ブロック pushBlock() で積む (1x 経路の遅延線と再始動用の入力を兼ねる)。
+//   prepare() は Message Thread 用 (確保あり)。decide() / pushBlock() / reset() は Audio Thread 用。JUCE 非依存。
+//==============================================================================
+
+namespace convo {
+
+class AdaptiveSoftClipRoute
+{
+public:
+    enum class Action : std::uint8_t
+    {
+        Oversample,          // OS 経路のみ
+        PrimeAndOversample,  // 1x → OS: 履歴で OS を作り直してから OS 経路
+        FadeToBypass,        // OS → 1x: 両経路を回し、ブロック内で OS → 遅延線へクロスフェード
+        Bypass               // 遅延線のみ (OS を回さない)
+    };
+
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kMaxHistory = 128;        // 遅延 D と再始動長の上限 (base rate サンプル)
+    static constexpr double kEngageRatio = 0.5;    // clipStart の -6 dB を超えたら OS へ戻す
+    static constexpr double kReleaseRatio = 0.25;  // clipStart の -12 dB 以下が続いたら 1x へ落とす
+
+    // latencySamples: 局所 OS の整数遅延 D。primeSamples: 再始動に流す入力長 (up + down の ring-out)。
+    // holdSamples: 1x へ落とすまでに必要な静かな区間。範囲外・確保失敗時は false (常に Oversample を返す)
+    bool prepare(int maxBlockSize, int latencySamples, int primeSamples, int holdSamples)
+    {
+        ready = false;
+        if (maxBlockSize <= 0 || latencySamples < 0 || latencySamples > kMaxHistory
+            || primeSamples <= 0 || primeSamples > kMaxHistory || primeSamples > maxBlockSize || holdSamples < 0)
+            return false;
+
+        try
+        {
+            for (int ch = 0; ch < kMaxChannels; ++ch)
+            {
+                lines[ch].assign(static_cast<size_t>(kMaxHistory + maxBlockSize), 0.0);
+                fadeBuffers[ch].assign(static_cast<size_t>(maxBlockSize), 0.0);
+            }
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        maxBlock = maxBlockSize;
+        delay = latencySamples;
+        prime = primeSamples;
+        hold = holdSamples;
+        ready = true;
+        reset();
+        return true;
+    }
+
+    // 適用しない構成 (MinimumPhase など) で呼ぶ。以後 decide() は常に Oversample
+    void release() noexcept
+    {
+        ready = false;
+        bypassed = false;
+        quietSamples = 0;
+    }
+
+    // 局所 OS の履歴クリア (prepare / 無音スキップ突入) と揃えて呼ぶ: 履歴ゼロ・OS 経路から再開
+    void reset() noexcept
+    {
+        for (auto& line : lines)
+            std::fill(line.begin(), line.end(), 0.0);
+        bypassed = false;
+        quietSamples = 0;
+    }
+
+    [[nodiscard]] bool isReady() const noexcept { return ready; }
+    [[nodiscard]] bool isBypassed() const noexcept { return bypassed; }
+    [[nodiscard]] int getLatencySamples() const noexcept { return delay; }
+    [[nodiscard]] int getPrimeSamples() const noexcept { return prime; }
+
+    // blockPeak: 処理前のブロックの |x| 最大 (全チャンネル)。NaN は「大きい」扱いで OS に残す
+    Action decide(double blockPeak, double clipStart, int numSamples) noexcept
+    {
+        if (!ready || numSamples > maxBlock)
+            return Action::Oversample;
+
+        const bool loud = !(blockPeak <= clipStart * kEngageRatio);
+        if (bypassed)
+        {
+            if (!loud)
+                return Action::Bypass;
+            bypassed = false;
+            quietSamples = 0;
+            return Action::PrimeAndOversample;
+        }
+
+        if (!(blockPeak <= clipStart * kReleaseRatio))
+        {
+            quietSamples = 0;
+            return Action::Oversample;
+        }
+        if (quietSamples < hold)
+        {
+            quietSamples += numSamples;
+            return Action::Oversample;
+        }
+        bypassed = true;
+        return Action::FadeToBypass;
+    }
+
+    // FadeToBypass で遅延線側の出力を置く / 再始動の出力を捨てる作業領域 (maxBlockSize)
+    [[nodiscard]] double* fadeBuffer(int channel) noexcept { return fadeBuffers[channel].data(); }
+
+    // 現ブロック直前の primeSamples 個の入力 (pushBlock の前に読むこと)
+    [[nodiscard]] double* primeInput(int channel) noexcept
+    {
+        return lines[channel].data() + (kMaxHistory - prime);
+    }
+
+    // ブロックの入力を履歴へ積み、delayedOut != nullptr なら D サンプル遅らせた入力を書く
+    // (delayedOut == input の in-place 可)。numSamples は prepare の maxBlockSize 以下
+    void pushBlock(int channel, const double* input, int numSamples, double* delayedOut) noexcept
+    {
+        double* line = lines[channel].data();
+        std::memcpy(line + kMaxHistory, input, static_cast<size_t>(numSamples) * sizeof(double));
+        if (delayedOut != nullptr)
+            std::memcpy(delayedOut, line + kMaxHistory - delay, static_cast<size_t>(numSamples) * sizeof(double));
+        std::memmove(line, line + numSamples, static_cast<size_t>(kMaxHistory) * sizeof(double));
+    }
+
+    // oversampled を (1 − g)·oversampled + g·delayed へ置き換える。g はブロック末尾で 1
+    static void crossfadeToDelayed(double* oversampled, const double* delayed, int numSamples) noexcept
+    {
+        const double step = 1.0 / static_cast<double>(std::max(1, numSamples));
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double g = static_cast<double>(i + 1) * step;
+            oversampled[i] += g * (delayed[i] - oversampled[i]);
+        }
+    }
+
+private:
+    std::vector<double> lines[kMaxChannels];  // [kMaxHistory 履歴][現ブロック]
+    std::vector<double> fadeBuffers[kMaxChannels];
+    int maxBlock = 0;
+    int delay = 0;
+    int prime = 0;
+    int hold = 0;
+    int quietSamples = 0;
+    bool bypassed = false;
+    bool ready = false;
+};
+
+} // namespace convo
@@ -0,0 +1,196 @@
+#include <JuceHeader.h>
+#include "AudioEngine.h"
+#include "DSPLifetimeManager.h"
+
+// ★ A/B 比較: 2 つの設定を構築済み DSPCore ごと常駐させ、切替を「公開済み DSPCore の再公開 +
+//   通常のクロスフェード」だけで行う。切替時に rebuild は走らない。
+//   - 切替元: 設定 (getCurrentState) と公開中の DSPCore をスロットへ記録する。DSPCore は次の
+//     retire で破棄されず park される (DSPLifetimeManager::retire → ABResidentBank::parkIfResident)
+//   - 切替先: park 中の DSPCore を reset して再公開し、その後で UI/パラメータへ設定を復元する。
+//     復元が発火する rebuild は常駐 DSPCore と同じ構築入力なら requestRebuild で捨てる
+
+namespace
+{
+void diagLog(const juce::String& message)
+{
+    DBG(message);
+    juce::Logger::writeToLog(message);
+}
+
+[[nodiscard]] constexpr size_t abSlotIndex(convo::ABSlot slot) noexcept
+{
+    return static_cast<size_t>(slot);
+}
+}
+
+void AudioEngine::selectABSlot(convo::ABSlot slot)
+{
+    jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    if (isShutdownInProgress())
+        return;
+    if (abCompareEngaged_ && slot == activeABSlot_)
+        return;
+
+    const auto outgoing = activeABSlot_;
+    captureActiveIntoABSlot(outgoing);
+    abCompareEngaged_ = true;
+    activeABSlot_ = slot;
+
+    auto& targetState = abSlotStates_[abSlotIndex(slot)];
+    if (!targetState.isValid())
+    {
+        // 空スロット: いまの設定を初期値にするだけで音は変えない。以降の編集がこのスロットの設定になる
+        targetState = abSlotStates_[abSlotIndex(outgoing)].createCopy();
+        abSettlingActive_ = false;
+        diagLog("[AB] slot " + juce::String(convo::abSlotName(slot))
+            + " initialised from slot " + juce::String(convo::abSlotName(outgoing)));
+        sendChangeMessage();
+        return;
+    }
+
+    // 公開中の DSPCore がそのまま切替先の常駐なら (切替先で何も編集していない) 再公開は不要
+    DSPCore* const resident = abResidentBank_.residentCore(slot);
+    bool residentLive = false;
+    if (resident != nullptr && resident == getActiveRuntimeDSP())
+    {
+        abSettlingSnapshot_ = resident->publishedBuild.snapshot;
+        residentLive = true;
+    }
+    else
+    {
+        residentLive = republishABResident(slot);
+    }
+    abSettlingActive_ = residentLive;
+
+    diagLog("[AB] select slot=" + juce::String(convo::abSlotName(slot))
+        + " from=" + juce::String(convo::abSlotName(outgoing))
+        + " resident=" + juce::String(residentLive ? "live" : "rebuild"));
+
+    // 常駐 DSPCore を使えなかった場合は通常の状態復元 (rebuild) と同じ経路になる
+    requestLoadState(targetState);
+}
+
+void AudioEngine::clearABSlots()
+{
+    DSPLifetimeManager lifetimeMgr(*this);
+    lifetimeMgr.retireParked(abResidentBank_.release(convo::ABSlot::A).core);
+    lifetimeMgr.retireParked(abResidentBank_.release(convo::ABSlot::B).core);
+    abSlotStates_ = {};
+    activeABSlot_ = convo::ABSlot::A;
+    abCompareEngaged_ = false;
+    abSettlingActive_ = false;
+}
+
+size_t AudioEngine::getABStandbyResidentBytes() const noexcept
+{
+    size_t totalBytes = 0;
+    abResidentBank_.forEachParkedCore([&totalBytes](const DSPCore& dsp)
+    {
+        totalBytes += dsp.estimateResidentBytes();
+    });
+    return totalBytes;
+}
+
+void AudioEngine::captureActiveIntoABSlot(convo::ABSlot slot)
+{
+    abSlotStates_[abSlotIndex(slot)] = getCurrentState();
+
+    DSPLifetimeManager lifetimeMgr(*this);
+    DSPCore* const active = getActiveRuntimeDSP();
+    if (active == nullptr)
+    {
+        lifetimeMgr.retireParked(abResidentBank_.release(slot).core);
+        return;
+    }
+
+    lifetimeMgr.retireParked(abResidentBank_.capture(slot, active).core);
+
+    // publish/retire は rebuild thread でも走る。登録より先に active から外れていた場合は
+    // retire が park を見ずに破棄へ進んでいるので登録を取り消す (登録後に park されていれば破棄する)
+    if (active != getActiveRuntimeDSP() && active != fadingRuntimeDSPSlot.get())
+        lifetimeMgr.retireParked(abResidentBank_.release(slot).core);
+}
+
+bool AudioEngine::republishABResident(convo::ABSlot slot)
+{
+    DSPCore* const resident = abResidentBank_.residentCore(slot);
+    if (resident == nullptr)
+        return false;
+
+    DSPLifetimeManager lifetimeMgr(*this);
+    const double sampleRate = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
+    const int blockSize = convo::consumeAtomic(maxSamplesPerBlock, std::memory_order_acquire);
+    if (abResidentBank_.isParked(slot)
+        && !convo::isResidentBuildRateCompatible(resident->publishedBuild.snapshot.buildInput, sampleRate, blockSize))
+    {
+        // デバイス条件が変わった常駐は使えない。手放して状態復元の rebuild に任せる
+        lifetimeMgr.retireParked(abResidentBank_.release(slot).core);
+        return false;
+    }
+
+    // park 直後 (Audio Thread がまだ参照しうる) やフェードアウト中の常駐は取り出せない
+    DSPCore* const dsp = abResidentBank_.acquireForPublish(slot, m_retireRouter->getMinReaderEpoch());
+    if (dsp == nullptr)
+        return false;
+
+    // park 前の Convolver FDL・EQ 履歴を捨て、新規構築と同じくフェードインから始める
+    dsp->reset();
+    dsp->ramps().fadeInSamplesLeft = DSPCore::FADE_IN_SAMPLES;
+
+    const DSPCore::PublishedBuildRecord record = dsp->publishedBuild;
+    int generation = 0;
+    DSPCore* overtakenHeavy = nullptr;
+    DSPCore* overtakenLight = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex);
+        generation = ++rebuildRequestGeneration;
+        // release: Heavy レーンの isRebuildObsolete (acquire) と HB。切替前の設定で組んでいる rebuild は不要
+        convo::publishAtomic(heavyRebuildGeneration_, generation, std::memory_order_release);
+        overtakenHeavy = takePendingRebuildTaskLocked(RebuildLane::Heavy);
+        overtakenLight = takePendingRebuildTaskLocked(RebuildLane::Light);
+    }
+    if (overtakenHeavy)
+        lifetimeMgr.retire(overtakenHeavy);
+    if (overtakenLight)
+        lifetimeMgr.retire(overtakenLight);
+
+    convo::RuntimeBuildSnapshot snapshot = record.snapshot;
+    snapshot.generation = generation;
+    convo::BuildAnalysis analysis = record.buildAnalysis;
+    if (analysis.sealed)
+    {
+        analysis.generation = generation;
+        analysis = convo::sealBuildAnalysis(analysis, &snapshot);
+    }
+    abSettlingSnapshot_ = snapshot;
+
+    {
+        std::lock_guard<std::mutex> commitLock(rebuildCommitMutex);
+        // 差し戻された場合は retire / destroyRolledBackDSP が park に戻す
+        enqueuePublicationIntentForRuntimeCommit(dsp, generation, snapshot, analysis,
+                                                 record.oversamplingResult, record.buildDiagnostics);
+        // release: isRebuildGenerationPublishable (acquire) と HB。commitLock 下で単調増加
+        convo::publishAtomic(lastSubmittedRebuildGeneration_, generation, std::memory_order_release);
+    }
+    return true;
+}
+
+bool AudioEngine::shouldSuppressRebuildForABResident(const convo::BuildInput& buildInput,
+                                                     std::uint64_t convolverFingerprint) noexcept
+{
+    if (!abSettlingActive_)
+        return false;
+
+    if (convo::isSameResidentBuild(abSettlingSnapshot_.buildInput, abSettlingSnapshot_.convolverFingerprint,
+                                   buildInput, convolverFingerprint))
+        return true;
+
+    // 復元中の IR 読込は常駐と比べられない中間状態。読込完了で届く rebuild で改めて判定する
+    if (uiConvolverProcessor.isLoadingIR())
+        return true;
+
+    // 常駐と異なる設定に編集された: 以後は通常の rebuild
+    abSettlingActive_ = false;
+    return false;
+}
@@ -1,5 +1,6 @@
 #include <JuceHeader.h>
 #include "AudioEngine.h"
+#include "EQPresetPrebuildThread.h"
 
 namespace {
 void retireEQCache(AudioEngine& owner, EQCoeffCache* cache)
@@ -50,6 +51,18 @@ void AudioEngine::EQCacheManager::storeNewMap(CacheMap* newMap) noexcept
     owner.enqueueDeferredDeleteNonRt(old, [](void* p) { delete static_cast<CacheMap*>(p); });
 }
 
+void AudioEngine::EQCacheManager::releasePinnedBase(EQCoeffCache* base) noexcept
+{
+    if (base == nullptr)
+        return;
+
+    // map 側が先に手放していれば、ここで最後の参照が retire される
+    if (convo::consumeAtomic(owner.shutdownPhase, std::memory_order_acquire) >= AudioEngine::ShutdownPhase::Destroy) // acquire: shutdown 遷移の acq_rel と HB
+        static_cast<void>(base->releaseDirect());
+    else
+        base->release(*owner.m_retireRouter);
+}
+
 EQCoeffCache* AudioEngine::EQCacheManager::getOrCreate(const convo::EQParameters& params,
                                                        double sampleRate,
                                                        int maxBlockSize,
@@ -64,7 +77,18 @@ EQCoeffCache* AudioEngine::EQCacheManager::getOrCreate(const convo::EQParameters
     if (it != currentMap->map.end())
         return it->second;
 
-    EQCoeffCache* cache = EQProcessor::createCoeffCache(params, sampleRate, maxBlockSize, generation);
+    // 直前のキャッシュを流用元にする。map の世代交代で回収されないよう構築中は参照を保持する
+    EQCoeffCache* base = nullptr;
+    const uint64_t baseHash = convo::consumeAtomic(lastCreatedHash, std::memory_order_acquire); // acquire: 後述の publishAtomic release と HB
+    if (baseHash != 0)
+    {
+        const auto baseIt = currentMap->map.find(baseHash);
+        if (baseIt != currentMap->map.end() && baseIt->second != nullptr && baseIt->second->tryAddRef())
+            base = baseIt->second;
+    }
+
+    EQCoeffCache* cache = EQProcessor::createCoeffCache(params, sampleRate, maxBlockSize, generation, base);
+    releasePinnedBase(base);
     if (cache == nullptr)
         return nullptr;
 
@@ -110,6 +134,7 @@ EQCoeffCache* AudioEngine::EQCacheManager::getOrCreate(const convo::EQParameters
     }
 
     storeNewMap(newMap.release());
+    convo::publishAtomic(lastCreatedHash, hash, std::memory_order_release); // release: 次の getOrCreate の consumeAtomic acquire と HB
 
     return cacheHolder.release();
 }
@@ -154,3 +179,70 @@ AudioEngine::EQCacheManager::~EQCacheManager()
 
     enqueueFallbackMaps.clear();
 }
+
+void AudioEngine::prebuildEQPresetBank(const juce::File& presetDirectory, int morphKeyframesPerPair)
+{
+    debugAssertNotAudioThread();
+
+    if (isShutdownInProgress() || !presetDirectory.isDirectory())
+        return;
+
+    const double sampleRate = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
+    const int maxBlockSize = convo::consumeAtomic(maxSamplesPerBlock, std::memory_order_acquire);
+    if (sampleRate <= 0.0 || maxBlockSize <= 0)
+        return;
+
+    // 同一バンク・同一レートで構築済み/構築中なら再走査しない
+    if (eqPresetPrebuildThread != nullptr
+        && presetDirectory == eqPresetBankDirectory
+        && sampleRate == eqPresetBankSampleRate
+        && morphKeyframesPerPair == 0)
+        return;
+
+    cancelEQPresetPrebuild();
+
+    auto files = presetDirectory.findChildFiles(juce::File::findFiles, false, "*.txt");
+    files.sort();
+    std::vector<juce::File> presetFiles;
+    presetFiles.reserve(static_cast<size_t>(juce::jmin(files.size(), kMaxEQPresetBankFiles)));
+    for (const auto& f : files)
+    {
+        if (static_cast<int>(presetFiles.size()) >= kMaxEQPresetBankFiles)
+            break;
+        presetFiles.push_back(f);
+    }
+
+    if (presetFiles.empty())
+        return;
+
+    const uint64_t generation = convo::consumeAtomic(lastCommittedRuntimeGeneration_, std::memory_order_acquire);
+    auto buildEntry = [this, sampleRate, maxBlockSize, generation](const convo::EQParameters& params)
+    {
+        // レート変更後に旧レートの係数を登録しない (キャッシュキーはレートを含まないため)
+        if (isShutdownInProgress()
+            || convo::consumeAtomic(currentSampleRate, std::memory_order_acquire) != sampleRate)
+            return false;
+
+        return eqCacheManager.getOrCreate(params, sampleRate, maxBlockSize, generation) != nullptr;
+    };
+
+    eqPresetBankDirectory = presetDirectory;
+    eqPresetBankSampleRate = sampleRate;
+    eqPresetPrebuildThread = std::make_unique<EQPresetPrebuildThread>(std::move(presetFiles),
+                                                                      morphKeyframesPerPair,
+                                                                      std::move(buildEntry),
+                                                                      &affinityManager);
+    eqPresetPrebuildThread->startThread();
+}
+
+void AudioEngine::cancelEQPresetPrebuild()
+{
+    if (eqPresetPrebuildThread == nullptr)
+        return;
+
+    eqPresetPrebuildThread->cancel();
+    eqPresetPrebuildThread->stopThread(2000);
+    eqPresetPrebuildThread.reset();
+    eqPresetBankDirectory = juce::File();
+    eqPresetBankSampleRate = 0.0;
+}
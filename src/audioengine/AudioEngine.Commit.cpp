@@ -2,6 +2,7 @@
 #include "AudioEngine.h"
 #include "DiagnosticsConfig.h"
 #include "RuntimePublicationOrchestrator.h"
+#include "ISRStaticPublicationSchema.h"
 
 #include <filesystem>
 #include <fstream>  // ★ A-7: epoch_reclaim_audit.json 出力用
@@ -24,6 +25,17 @@ void diagLog(const juce::String& message)
 #endif
 }
 
+// ★ 静的スキーマ契約: descriptor / authority inventory 表は constexpr のため、
+//   構成に関わらずコンパイル時に検証する (CONVOPEQ_STATIC_PUBLICATION_SCHEMA=1 では
+//   これが唯一の検証になり、publication ごとの表走査は行わない)。
+static_assert(RuntimeState::validateDescriptorSet(),
+              "RuntimeState field descriptors / authority inventories are inconsistent");
+static_assert(convo::isr::PublicationSemantic::validateDescriptorSet(),
+              "PublicationSemantic field descriptors are inconsistent");
+static_assert(convo::RuntimeGraph::validateDescriptorSet()
+                  && convo::RuntimeGraph::validateDecisionCoverageContract(),
+              "RuntimeGraph descriptors do not cover its decision-relevant fields");
+
 [[nodiscard]] inline bool validateSemanticCompleteness(const RuntimePublishWorld& world) noexcept
 {
     if (world.schemaVersion != convo::isr::kRuntimeSemanticSchemaVersion)
@@ -35,9 +47,13 @@ void diagLog(const juce::String& message)
     if (world.metadata.publicationSequence != world.publication.sequenceId)
         return false;
 
-    if (!RuntimeState::validateDescriptorSet()
-        || !convo::isr::PublicationSemantic::validateDescriptorSet())
-        return false;
+    // 静的スキーマ構成では上の static_assert で確定済みのため表走査を省く
+    if constexpr (!convo::isr::kStaticPublicationSchema)
+    {
+        if (!RuntimeState::validateDescriptorSet()
+            || !convo::isr::PublicationSemantic::validateDescriptorSet())
+            return false;
+    }
 
     if (world.generation == 0
         || world.generationSemantic.runtimeGeneration == 0
@@ -65,11 +81,14 @@ void diagLog(const juce::String& message)
     // 3.2.9: RuntimeGraph の Authoritative フィールドは RuntimeWorld の
     // Semantic 構造体に移管されたため、graph との一致検証は不要。
     // RuntimeGraph は Projection + Diagnostic のみを保持する。
-    if (!convo::RuntimeGraph::validateDescriptorSet())
-        return false;
+    if constexpr (!convo::isr::kStaticPublicationSchema)
+    {
+        if (!convo::RuntimeGraph::validateDescriptorSet())
+            return false;
 
-    if (!convo::RuntimeGraph::validateDecisionCoverageContract())
-        return false;
+        if (!convo::RuntimeGraph::validateDecisionCoverageContract())
+            return false;
+    }
 
     const bool hasGraphActiveNode = (world.graph.activeNode != nullptr);
     const bool hasGraphFadingNode = (world.graph.fadingNode != nullptr);
@@ -257,67 +276,35 @@ inline void forceSemanticTransactionState(std::atomic<std::uint8_t>& state,
     if (!hasActive && !hasFading && !hasTransitionNext)
         return true;
 
-    convo::isr::PayloadClosureDescriptor closure{};
-    closure.closureId = static_cast<uint32_t>((world.generation != 0)
-        ? world.generation
-        : 1u);
-
-    std::uint32_t nextNodeId = 1;
-    std::uint32_t activeNodeId = 0;
-    std::uint32_t fadingNodeId = 0;
-    std::uint32_t transitionNodeId = 0;
-
-    const auto makeClosureNode = [](std::uint32_t nodeId, convo::isr::PayloadTier tier) {
-        convo::isr::ClosureNodeRef ref{};
-        ref.nodeId = nodeId;
-        ref.payloadTier = static_cast<std::uint32_t>(tier);
-        ref.kind = 1u;        // DSP node
-        ref.ownership = 2u;   // Engine-owned shared runtime object
-        ref.mutability = 1u;  // immutable payload
-        ref.lifetime = 2u;    // runtime publication lifetime
-        ref.hbDomain = 1u;    // publication HB domain
-        ref.authority = 1u;   // NonRT publication authority
-        ref.allocator = 1u;   // engine allocator domain
-        return ref;
-    };
+    const convo::isr::PublicationClosureShape shape {
+        hasActive,
+        hasFading && world.topology.fadingRuntimeUuid != world.topology.runtimeUuid,
+        hasTransitionNext };
 
-    if (hasActive) {
-        activeNodeId = nextNodeId++;
-        closure.nodes.push_back(makeClosureNode(activeNodeId, convo::isr::PayloadTier::InlineImmutable));
-    }
-
-    if (hasFading && world.topology.fadingRuntimeUuid != world.topology.runtimeUuid) {
-        fadingNodeId = nextNodeId++;
-        closure.nodes.push_back(makeClosureNode(fadingNodeId, convo::isr::PayloadTier::ImmutableShared));
-    }
-
-    if (hasTransitionNext) {
-        transitionNodeId = nextNodeId++;
-        closure.nodes.push_back(makeClosureNode(transitionNodeId, convo::isr::PayloadTier::ImmutableShared));
-    }
-
-    if (activeNodeId != 0 && transitionNodeId != 0) {
-        closure.edges.push_back(activeNodeId);
-        closure.edges.push_back(transitionNodeId);
-    }
-
-    if (activeNodeId != 0 && fadingNodeId != 0) {
-        closure.edges.push_back(activeNodeId);
-        closure.edges.push_back(fadingNodeId);
+    if constexpr (convo::isr::kStaticPublicationSchema)
+    {
+        // ★ 静的スキーマ構成: closure の形は 3 フラグで決まり、全 8 通りが
+        //   ISRStaticPublicationSchema.h の static_assert で publish 可能と確定している。
+        //   closure graph の構築・走査と closure_graph.json の書き出しは行わない。
+        juce::ignoreUnused(shape);
     }
-
-    convo::isr::TieredPayloadDescriptor descriptor{};
-    descriptor.tier = hasTransitionNext
-        ? convo::isr::PayloadTier::ImmutableShared
-        : convo::isr::PayloadTier::InlineImmutable;
-    descriptor.requiresRT = false;
-    descriptor.hasExternalResource = false;
-    descriptor.pinnedLifetime = true;
-
-    const bool closureValid = closureGraphWalker_.validateGraph(closure);
-    const bool precheckValid = precheckRuntimePublication(closure, descriptor);
-    if (!closureValid || !precheckValid) {
-        return rejectWithEvidence("closure_or_precheck_invalid");
+    else if ((world.metadata.dirtyFieldMask & RuntimeState::fieldBit("topology")) != 0)
+    {
+        // ★ 増分検証: closure の形は topology だけで決まるため、topology が前回 World から
+        //   変わっていなければ closure graph は再走査しない
+        convo::isr::PayloadClosureDescriptor closure{};
+        convo::isr::copyPublicationClosure(convo::isr::buildPublicationClosure(shape),
+                                           static_cast<uint32_t>((world.generation != 0)
+                                               ? world.generation
+                                               : 1u),
+                                           closure);
+        const auto descriptor = convo::isr::makePublicationPayloadDescriptor(shape);
+
+        const bool closureValid = closureGraphWalker_.validateGraph(closure);
+        const bool precheckValid = precheckRuntimePublication(closure, descriptor);
+        if (!closureValid || !precheckValid) {
+            return rejectWithEvidence("closure_or_precheck_invalid");
+        }
     }
 
     if (!transitionSemanticTransactionState(semanticTransactionState_, convo::isr::SemanticTransactionState::Committed))
@@ -696,6 +683,10 @@ void AudioEngine::enqueuePublicationIntentForRuntimeCommit(DSPCore* newDSP,
     if (newDSP == nullptr)
         return;
 
+    // A/B 常駐で park 後に再公開するとき、rebuild せずに同じ構築ペイロードを出せるよう残す
+    //   (publish 前なので他スレッドからは未到達)
+    newDSP->publishedBuild = { sealedSnapshot, buildAnalysis, oversamplingResult, buildDiagnostics };
+
     // Phase2: commit 時に DSPHandle を事前登録する
     auto handle = registerDSPHandleForRuntime(newDSP);
 
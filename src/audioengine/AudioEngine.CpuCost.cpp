@@ -0,0 +1,118 @@
+#include <JuceHeader.h>
+#include "AudioEngine.h"
+#include "CpuCostCalibration.h"
+
+//==============================================================================
+// CPU 負荷予測 (CpuCostModel.h) の入口。
+//   UI 用: 要求中の設定から構成を組んで予測する (Message Thread)
+//   publish 用: 構築済み DSPCore の実構成で予測し、結果を記録する (Rebuild Thread)
+//==============================================================================
+
+namespace {
+
+convo::CpuCostOversamplingPreset toCostPreset(convo::OversamplingType type) noexcept
+{
+    switch (type)
+    {
+        case convo::OversamplingType::LinearPhase:  return convo::CpuCostOversamplingPreset::LinearPhase;
+        case convo::OversamplingType::MinimumPhase: return convo::CpuCostOversamplingPreset::MinimumPhase;
+        case convo::OversamplingType::IIR:          break;
+    }
+    return convo::CpuCostOversamplingPreset::IIRLike;
+}
+
+juce::String describeCpuCostConfig(const convo::CpuCostConfig& config)
+{
+    return juce::String(config.oversamplingFactor) + "x block=" + juce::String(config.blockSize)
+         + " ir=" + juce::String(config.irLength);
+}
+
+} // namespace
+
+convo::CpuCostConfig AudioEngine::makeCpuCostConfig() const
+{
+    convo::CpuCostConfig config;
+    config.sampleRate = getSampleRate();
+    const int deviceBlock = convo::consumeAtomic(deviceSamplesPerBlock, std::memory_order_acquire);
+    config.blockSize = deviceBlock > 0 ? deviceBlock : convo::consumeAtomic(maxSamplesPerBlock, std::memory_order_acquire);
+    const double processingRate = getProcessingSampleRate();
+    config.oversamplingFactor = config.sampleRate > 0.0
+        ? std::max(1, juce::roundToInt(processingRate / config.sampleRate))
+        : 1;
+    config.oversamplingPreset = toCostPreset(getOversamplingType());
+
+    const auto& convolver = getConvolverProcessor();
+    config.convolverActive = convolver.isIRLoaded() && !isConvolverBypassRequested();
+    config.irLength = convolver.getIRLength();
+    config.trueStereo = convolver.getTrueStereoEnabled();
+
+    config.eqActive = !isEqBypassRequested();
+    for (int band = 0; band < EQProcessor::NUM_BANDS; ++band)
+        if (getEQBandParams(band).enabled)
+            ++config.eqActiveBands;
+    config.eqAtBaseRate = isEQSplitRateEnabled();
+    return config;
+}
+
+convo::CpuCostConfig AudioEngine::makeCpuCostConfig(const DSPCore& dsp) const
+{
+    convo::CpuCostConfig config;
+    config.sampleRate = dsp.sampleRate;
+    config.blockSize = dsp.preparedHostBlockSize;
+    config.oversamplingFactor = static_cast<int>(std::max<size_t>(1, dsp.oversamplingFactor));
+    config.oversamplingPreset = toCostPreset(dsp.activeOversamplingType);
+
+    config.convolverActive = dsp.convolver.isIRLoaded() && !isConvolverBypassRequested();
+    config.irLength = dsp.convolver.getIRLength();
+    config.trueStereo = dsp.convolver.getTrueStereoEnabled();
+
+    // IR へ焼き込まれた EQ は段として走らない
+    config.eqActive = !dsp.eqFoldedIntoIR && !isEqBypassRequested();
+    for (int band = 0; band < EQProcessor::NUM_BANDS; ++band)
+        if (dsp.eq.getBandParams(band).enabled)
+            ++config.eqActiveBands;
+    config.eqAtBaseRate = dsp.eqSplitRate;
+    return config;
+}
+
+convo::CpuCostPrediction AudioEngine::predictCpuCost(const convo::CpuCostConfig& config) const
+{
+    return convo::predictCallbackCost(convo::CpuCostCalibration::getInstance().getCoefficients(), config);
+}
+
+convo::CpuCostSuggestion AudioEngine::suggestCpuCostDowngrade(const convo::CpuCostConfig& config) const
+{
+    return convo::suggestCpuCostDowngrade(convo::CpuCostCalibration::getInstance().getCoefficients(), config);
+}
+
+void AudioEngine::evaluateCpuCostBeforePublish(const DSPCore& dsp, int generation) noexcept
+{
+    const auto coefficients = convo::CpuCostCalibration::getInstance().getCoefficients();
+    const auto config = makeCpuCostConfig(dsp);
+    const auto prediction = convo::predictCallbackCost(coefficients, config);
+
+    // relaxed: 表示用の独立した 2 値。組が一瞬ずれても次の publish か UI 更新で揃う
+    convo::publishAtomic(publishedCpuCostPermille_, prediction.loadPermille(), std::memory_order_relaxed);
+    convo::publishAtomic(publishedCpuCostVerdict_, prediction.verdict, std::memory_order_relaxed);
+
+    if (prediction.verdict != convo::CpuCostPrediction::Verdict::Warning
+        && prediction.verdict != convo::CpuCostPrediction::Verdict::Overload)
+        return;
+
+    const auto suggestion = convo::suggestCpuCostDowngrade(coefficients, config);
+
+    juce::String message = "[COST] gen=" + juce::String(generation)
+        + " predicted load " + juce::String(juce::roundToInt(prediction.load * 100.0)) + "%"
+        + " (" + convo::cpuCostVerdictName(prediction.verdict) + ")"
+        + " conv=" + juce::String(prediction.convolverUs, 0) + "us"
+        + " eq=" + juce::String(prediction.eqUs, 0) + "us"
+        + " os=" + juce::String(prediction.oversamplingUs, 0) + "us"
+        + " out=" + juce::String(prediction.outputUs, 0) + "us"
+        + " period=" + juce::String(prediction.periodUs, 0) + "us"
+        + " config=" + describeCpuCostConfig(config);
+    message += suggestion.achievable
+        ? " suggest=" + describeCpuCostConfig(suggestion.config)
+              + " (" + juce::String(juce::roundToInt(suggestion.prediction.load * 100.0)) + "%)"
+        : juce::String(" no lighter configuration fits the budget");
+    juce::Logger::writeToLog(message);
+}
@@ -3,8 +3,11 @@
 #include "core/RuntimeReaderContext.h"
 #include "RuntimePublicationOrchestrator.h"
 #include "NoiseShaperLearner.h"
+#include "EQPresetPrebuildThread.h"
+#include "MeteringWorker.h"
 #include "ISRRetireRouter.h"
 #include "DSPLifetimeManager.h"
+#include "ShutdownOrchestrator.h"
 
 namespace {
 void diagLog(const juce::String& message)
@@ -24,11 +27,15 @@ AudioEngine::AudioEngine()
 #pragma warning(disable : 4996) // [[deprecated]] — transitional, SnapshotCoordinator EpochDomain (P1-7)
     , m_coordinator(m_epochDomain)
 #pragma warning(pop)
-    , m_workerThread(m_commandBuffer, m_generationManager, &affinityManager)
+    , m_workerThread([this] { triggerAsyncUpdate(); },
+                     [this] { affinityManager.applyCurrentThreadPolicy(ThreadType::Worker); })
 {
     // ★ engineInstanceId 初期化 (全局一意)
     engineInstanceId_ = s_nextEngineInstanceId_.fetch_add(1, std::memory_order_relaxed) + 1; // NOLINT(atomic-dot-call): relaxed counter
 
+    // 出力メータのタップは一度だけ確保する (MeteringWorker が読んでいる間に作り直さない)
+    meteringFifo.prepare(getMeteringFifoSize());
+
     // [work21] ISRRetireRouter初期化
     m_retireRouter = std::make_unique<convo::isr::ISRRetireRouter>(m_epochDomain);
     // [PR-1.5] RuntimePublicationOrchestrator 初期化 (engineInstanceId を注入)
@@ -52,6 +59,7 @@ AudioEngine::AudioEngine()
     // ★ Practical-4: Reader Slot 使用率監視用参照
     //   activeReaderCount は ISRRetireRouter 経由で取得（HealthMonitor が直接読む）
     m_healthMonitor.setOverflowCountRef(m_retireRouter->getOverflowCountRef());
+    m_healthMonitor.setCallbackLoadRef(&rtLocalState_.callbackLoadPermille);
     m_healthMonitor.setEventCallback(
         [this](const convo::HealthEvent& ev) { onHealthEvent(ev); });
 
@@ -81,6 +89,27 @@ AudioEngine::AudioEngine()
     // ★ P1-B: Admission に HealthState 参照を設定
     runtimeOrchestrator_->setAdmissionHealthStateRef(m_healthMonitor.getHealthStateRef());
 
+    // ★ フライトレコーダー: 最初のエンジンだけが持つ (2 つ目以降が前回分を上書きしないように)
+    if (engineInstanceId_ == 1)
+    {
+        const auto dir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("ConvoPeq");
+        if (!dir.exists())
+            (void)dir.createDirectory();
+        flightRecorder_ = convo::FlightRecorder::create(
+            std::filesystem::path(dir.getChildFile("flight_recorder.bin").getFullPathName().toWideCharPointer()),
+            std::filesystem::path(dir.getChildFile("flight_recorder.prev.bin").getFullPathName().toWideCharPointer()));
+        if (flightRecorder_ != nullptr)
+        {
+            runtimeOrchestrator_->telemetryRecorder().setFlightRecorder(flightRecorder_.get());
+            m_healthMonitor.getXrunCorrelator().setFlightRecorder(flightRecorder_.get());
+        }
+        else
+        {
+            diagLog("[FLIGHT] flight recorder unavailable (could not map "
+                + dir.getChildFile("flight_recorder.bin").getFullPathName() + ")");
+        }
+    }
+
     // ★ B14: Vyukov MPSC Retire Queue 初期化
     retireRuntime_.initQueue();
 }
@@ -97,13 +126,44 @@ AudioEngine::~AudioEngine()
     cancelPendingUpdate();
     runtimePublicationBridge_.requestShutdown();
 
+    // ★ バックグラウンド停止の一斉通知: rebuild レーン / EQ プリビルド / Convolver の各スレッド /
+    //   学習器 / スケジューラ・Worker・MeteringWorker へ先にまとめてキャンセルを知らせ、
+    //   以下の join (StopWorkers と shutdownWorkerThread、メンバ破棄) で待つ時間を重ねる。
+    //   解放の順序 (reader / コールバック停止 → retire → epoch drain → 解放) は変えない
+    constexpr int kStopWorkersBudgetMs = 3000;
+    convo::ShutdownOrchestrator stopOrchestrator { std::chrono::milliseconds(kStopWorkersBudgetMs) };
+    stopOrchestrator.addStage("rebuildLanes",
+                              [this] { requestRebuildThreadStop(); },
+                              [this](const convo::ShutdownOrchestrator&) { stopRebuildThread(); });
+    stopOrchestrator.addStage("eqPresetPrebuild",
+                              [this] { if (eqPresetPrebuildThread != nullptr) eqPresetPrebuildThread->cancel(); },
+                              [this](const convo::ShutdownOrchestrator&) { cancelEQPresetPrebuild(); });
+    stopOrchestrator.addStage("convolverBackground",
+                              [this] { uiConvolverProcessor.requestBackgroundStop(); },
+                              [this](const convo::ShutdownOrchestrator&) { uiConvolverProcessor.stopBackgroundThreads(); });
+    stopOrchestrator.addStage("noiseShaperLearner",
+                              [this] { if (noiseShaperLearner) noiseShaperLearner->requestStop(); },
+                              [this](const convo::ShutdownOrchestrator&) { if (noiseShaperLearner) noiseShaperLearner->stopLearning(); });
+    // join は retire 後の shutdownWorkerThread (retire 経路がまだ submit しうるため位置を変えない)
+    stopOrchestrator.addStage("workerThreads", [this] { requestWorkerThreadStop(); }, {});
+    stopOrchestrator.signalAll();
+
     // 終了順序を固定化して、終了時フリーズを防ぐ。
     setShutdownPhase(ShutdownPhase::StopAudio, "~AudioEngine");
     stopTimer();
 
     setShutdownPhase(ShutdownPhase::StopWorkers, "~AudioEngine");
     // releaseResources が未実行の異常系でも worker 終了を保証する。
-    stopRebuildThread();
+    if (!stopOrchestrator.joinAll())
+    {
+        for (const auto& report : stopOrchestrator.reports())
+        {
+            if (report.overran)
+                diagLog("[AUDIT] ~AudioEngine: stop stage '" + juce::String(report.name)
+                    + "' finished past the " + juce::String(kStopWorkersBudgetMs) + "ms budget (waited "
+                    + juce::String(report.waitedMs, 1) + "ms)");
+        }
+    }
 
     // まず rebuild thread 側へ終了を通知し、pending task を破棄して
     // 終了時に重い再構築へ入る経路を閉じる。
@@ -141,22 +201,25 @@ AudioEngine::~AudioEngine()
 
         // pendingTask.currentDSP は worker 側の未コミット生成物なので、
         // ここで回収して以後の commit 経路に残さない。
-        if (hasPendingTask)
+        for (size_t i = 0; i < kRebuildLaneCount; ++i)
         {
-            if (pendingTask.currentDSP)
+            if (DSPCore* pendingDSP = takePendingRebuildTaskLocked(static_cast<RebuildLane>(i)))
             {
                 DSPLifetimeManager lifetimeMgr(*this);
-                lifetimeMgr.retire(pendingTask.currentDSP);
-                pendingTask.currentDSP = nullptr;
+                lifetimeMgr.retire(pendingDSP);
             }
-
-            hasPendingTask = false;
         }
     }
 
     // [P1 Phase1-B] drainPublicationLogForShutdown removed
 
+    // A/B 常駐を先に外す (外さないと active/fading の retire が park で止まる)
+    clearABSlots();
+    // releaseResources が預けたままの DSPCore (再開されずに終了した場合)
+    releaseDeviceRestartResident();
+
     {
+        convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*m_retireRouter, convo::isr::RetireProducer::Lifetime);
         DSPLifetimeManager lifetimeMgr(*this);
         if (activeToRelease) lifetimeMgr.retire(activeToRelease);
         if (fadingToRelease) lifetimeMgr.retire(fadingToRelease);
@@ -178,23 +241,33 @@ AudioEngine::~AudioEngine()
 
     // ★ Practical-7: Graceful Drain Phase — pendingRetireCount が 0 になるまでポーリング待機
     //   最大 5 秒間のみ待機し、タイムアウト時は強制 drain にフォールバック。
+    //   reader はこの時点でほぼ抜けているので、先に reclaim を回してから 0.25ms → 10ms の倍々で待つ
+    //   (固定 10ms 刻みだと 1 tick で済む drain にも 10ms 掛かっていた)
     setShutdownPhase(ShutdownPhase::DrainRetire, "~AudioEngine");
     {
         constexpr int kGracefulDrainMaxMs = 5000;
-        constexpr int kGracefulDrainPollMs = 10;
-        int waitedMs = 0;
-        while (waitedMs < kGracefulDrainMaxMs)
+        constexpr auto kGracefulDrainMinPoll = std::chrono::microseconds(250);
+        constexpr auto kGracefulDrainMaxPoll = std::chrono::microseconds(10000);
+        const auto drainDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kGracefulDrainMaxMs);
+        auto poll = kGracefulDrainMinPoll;
+        bool drained = false;
+        for (;;)
         {
-            if (m_retireRouter->pendingRetireCount() == 0
-                && m_retireRouter->activeReaderCount() == 0)
-                break;
-            std::this_thread::sleep_for(std::chrono::milliseconds(kGracefulDrainPollMs));
-            waitedMs += kGracefulDrainPollMs;
             // tick: reclaim を進めて pendingRetire の消化を促進
             m_retireRouter->publishEpoch();
             m_retireRouter->tryReclaim();
+            if (m_retireRouter->pendingRetireCount() == 0
+                && m_retireRouter->activeReaderCount() == 0)
+            {
+                drained = true;
+                break;
+            }
+            if (std::chrono::steady_clock::now() >= drainDeadline)
+                break;
+            std::this_thread::sleep_for(poll);
+            poll = std::min(poll * 2, kGracefulDrainMaxPoll);
         }
-        if (waitedMs >= kGracefulDrainMaxMs)
+        if (!drained)
         {
             diagLog("[AUDIT] Graceful drain timeout after " + juce::String(kGracefulDrainMaxMs)
                 + "ms, pendingRetireCount="
@@ -207,7 +280,7 @@ AudioEngine::~AudioEngine()
     runtimePublicationCoordinator.requestShutdownClearNonRt();
     runtimePublicationCoordinator.clearPublishedRuntimeSnapshotsNonRt();
     drainDeferredRetireQueues(true);
-    m_epochDomain.drainAll();
+    m_retireRouter->drainAll();   // 共有キュー + バッチレーンの封印済みバッチ
     runtimePublicationBridge_.markShutdownComplete();
 
     // ...既存の解放処理...
@@ -218,6 +291,14 @@ AudioEngine::~AudioEngine()
     latencyBufSize = 0;
     setShutdownPhase(ShutdownPhase::Destroy, "~AudioEngine");
     convo::publishAtomic(lifecycleState, EngineLifecycleState::Destroyed, std::memory_order_release); // release: isShuttingDown の acquire と HB
+
+    // ワーカー・コールバックは止まっている。外してから閉じる (state = Closed が正常終了の印)
+    if (flightRecorder_ != nullptr)
+    {
+        runtimeOrchestrator_->telemetryRecorder().setFlightRecorder(nullptr);
+        m_healthMonitor.getXrunCorrelator().setFlightRecorder(nullptr);
+        flightRecorder_.reset();
+    }
     diagLog("[DIAG] ~AudioEngine: shutdown sequence complete exit");
 }
 
@@ -1,5 +1,7 @@
 #include <JuceHeader.h>
 #include <immintrin.h>
+#include <cstdint>
+#include <cstring>
 #include "AudioEngine.h"
 #include "EQProcessor.h"
 
@@ -55,6 +57,55 @@ void calcMagnitudesForBand(const EQCoeffsBiquad& c,
     for (; i < numPoints; ++i)
         outMagSq[i] = EQProcessor::getMagnitudeSquared(c, zArr[i]);
 }
+
+// Parallel 合成用: 複素応答 H(z) = N(z) / D(z)。変更されたバンドのみで呼ばれるためスカラー実装
+void calcComplexResponseForBand(const EQCoeffsBiquad& c,
+                                const std::complex<double>* zArr,
+                                double* outRe,
+                                double* outIm,
+                                int numPoints) noexcept
+{
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const std::complex<double> z = zArr[i];
+        const std::complex<double> z2 = z * z;
+        const std::complex<double> num = c.b0 * z2 + c.b1 * z + c.b2;
+        const std::complex<double> den = c.a0 * z2 + c.a1 * z + c.a2;
+        const double denNorm = std::max(std::norm(den), 1.0e-36);
+        const std::complex<double> h = num * std::conj(den) / denNorm;
+        const bool finite = std::isfinite(h.real()) && std::isfinite(h.imag());
+        outRe[i] = finite ? h.real() : 1.0;
+        outIm[i] = finite ? h.imag() : 0.0;
+    }
+}
+
+// 表示グリッドの識別キー。zArray は UI 側キャッシュ (レート変更時に同一領域へ再計算される) のため
+// ポインタに加えて端点・中点の値も混ぜる
+uint64_t computeResponseGridKey(const std::complex<double>* zArr, int numPoints) noexcept
+{
+    auto mix = [](uint64_t seed, uint64_t v) noexcept
+    {
+        return seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    };
+    auto bitsOf = [](double d) noexcept
+    {
+        uint64_t b;
+        std::memcpy(&b, &d, sizeof(double));
+        return b;
+    };
+
+    uint64_t key = mix(0, static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(zArr)));
+    key = mix(key, static_cast<uint64_t>(numPoints));
+    if (numPoints > 0)
+    {
+        for (const int idx : { 0, numPoints / 2, numPoints - 1 })
+        {
+            key = mix(key, bitsOf(zArr[idx].real()));
+            key = mix(key, bitsOf(zArr[idx].imag()));
+        }
+    }
+    return key != 0 ? key : 1;
+}
 }
 
 void AudioEngine::calcEQResponseCurve(float* outMagnitudesL,
@@ -77,10 +128,13 @@ void AudioEngine::calcEQResponseCurve(float* outMagnitudesL,
         return;
     }
 
-    // ── 最適化: 有効なバンドの係数をスタック上で事前に計算 ──
-    // UIスレッドでの計算負荷を下げるため、無効なバンドやゲイン0のバンドは除外する
+    // ── バンド別キャッシュ: パラメータが変わったバンドのみ再計算し、合成だけを毎回行う ──
+    // 有効なバンドやゲイン0のバンドは合成から除外する (キャッシュ自体は保持)
+    jassert(numPoints <= NUM_DISPLAY_BARS);
+    numPoints = std::min(numPoints, static_cast<int>(NUM_DISPLAY_BARS));
+
     struct ActiveBand {
-        EQCoeffsBiquad coeffs;
+        const EQResponseBandCacheEntry* entry;
         EQChannelMode mode;
     };
     ActiveBand activeBands[EQProcessor::NUM_BANDS];
@@ -96,6 +150,16 @@ void AudioEngine::calcEQResponseCurve(float* outMagnitudesL,
         return;
     }
 
+    const uint64_t gridKey = computeResponseGridKey(zArray, numPoints);
+    if (gridKey != eqResponseGridKey)
+    {
+        for (auto& entry : eqResponseBandCache)
+            entry.key = 0;
+        eqResponseGridKey = gridKey;
+    }
+
+    const bool parallel = (eqState->filterStructure == 1);
+
     for (int band = 0; band < EQProcessor::NUM_BANDS; ++band)
     {
         const auto& params = eqState->bands[band];
@@ -108,28 +172,35 @@ void AudioEngine::calcEQResponseCurve(float* outMagnitudesL,
             std::abs(params.gain) < kEQGainEpsilon)
             continue;
 
-        // 【Fix Bug #EQ-Display】 Audio EQ Cookbook (calcBiquadCoeffs) の代わりに
-        // calcSVFCoeffs → svfToDisplayBiquad を使用する。
-        //
-        // 背景:
-        //   実際の音声処理は TPT SVF (calcSVFCoeffs) を使用しており、
-        //   Peaking の場合 k = 1/(Q·A)、LowShelf は g = tan()/√A 等、
-        //   Cookbook とは異なるパラメータ化を採用している。
-        //   その結果、以前の calcBiquadCoeffs (RBJ Cookbook: alpha = sin(w0)/(2Q))
-        //   は実際の SVF フィルタとバンド幅が微妙に異なり、
-        //   総合応答曲線が個別バンド曲線の積と一致しないという表示上の誤りが
-        //   生じていた。
-        //
-        // 修正:
-        //   calcSVFCoeffs → svfToDisplayBiquad のパスは SVF の z 域伝達関数を
-        //   厳密に等価 biquad へ変換する（updateEQData の個別バンド曲線と同一）。
-        //   これにより「総合曲線 = 個別バンド曲線の積 = 実際の DSP 処理」が
-        //   三者完全一致する。
-        activeBands[numActiveBands++] = {
-            EQProcessor::svfToDisplayBiquad(
-                EQProcessor::calcSVFCoeffs(type, params.frequency, params.gain, params.q, sr)),
-            eqState->bandChannelModes[band]
-        };
+        auto& entry = eqResponseBandCache[static_cast<size_t>(band)];
+        const uint64_t key = EQProcessor::computeBandResponseHash(params, type, sr);
+        if (entry.key != key)
+        {
+            // 【Fix Bug #EQ-Display】 Audio EQ Cookbook (calcBiquadCoeffs) の代わりに
+            // calcSVFCoeffs → svfToDisplayBiquad を使用する。
+            //
+            // 背景:
+            //   実際の音声処理は TPT SVF (calcSVFCoeffs) を使用しており、
+            //   Peaking の場合 k = 1/(Q·A)、LowShelf は g = tan()/√A 等、
+            //   Cookbook とは異なるパラメータ化を採用している。
+            //   その結果、以前の calcBiquadCoeffs (RBJ Cookbook: alpha = sin(w0)/(2Q))
+            //   は実際の SVF フィルタとバンド幅が微妙に異なり、
+            //   総合応答曲線が個別バンド曲線の積と一致しないという表示上の誤りが
+            //   生じていた。
+            //
+            // 修正:
+            //   calcSVFCoeffs → svfToDisplayBiquad のパスは SVF の z 域伝達関数を
+            //   厳密に等価 biquad へ変換する（updateEQData の個別バンド曲線と同一）。
+            //   これにより「総合曲線 = 個別バンド曲線の積 = 実際の DSP 処理」が
+            //   三者完全一致する。
+            const EQCoeffsBiquad coeffs = EQProcessor::svfToDisplayBiquad(
+                EQProcessor::calcSVFCoeffs(type, params.frequency, params.gain, params.q, sr));
+            calcMagnitudesForBand(coeffs, zArray, entry.magSq.data(), numPoints);
+            calcComplexResponseForBand(coeffs, zArray, entry.re.data(), entry.im.data(), numPoints);
+            entry.key = key;
+        }
+
+        activeBands[numActiveBands++] = { &entry, eqState->bandChannelModes[band] };
     }
 
     float totalGainLinear = 1.0f;
@@ -150,70 +221,113 @@ void AudioEngine::calcEQResponseCurve(float* outMagnitudesL,
 
     float* totalMagSqL = eqTotalMagSqLBuffer.data();
     float* totalMagSqR = eqTotalMagSqRBuffer.data();
-    float* bandMagSq = eqBandMagSqBuffer.data();
 
-    const __m256 vTotalGainSq = _mm256_set1_ps(totalGainSq);
-    int i = 0;
-    const int vEnd = numPoints / 8 * 8;
-    for (; i < vEnd; i += 8)
-    {
-        _mm256_storeu_ps(totalMagSqL + i, vTotalGainSq);
-        _mm256_storeu_ps(totalMagSqR + i, vTotalGainSq);
-    }
-    for (; i < numPoints; ++i)
-    {
-        totalMagSqL[i] = totalGainSq;
-        totalMagSqR[i] = totalGainSq;
-    }
+    auto affectsL = [](EQChannelMode mode) noexcept { return mode != EQChannelMode::Right; };
+    auto affectsR = [](EQChannelMode mode) noexcept { return mode != EQChannelMode::Left; };
 
-    for (int b = 0; b < numActiveBands; ++b)
+    if (parallel)
     {
-        const auto& band = activeBands[b];
-        calcMagnitudesForBand(band.coeffs, zArray, bandMagSq, numPoints);
+        // ── Parallel: y = x + Σ (H_b(x) - x) → H_total = 1 + Σ (H_b - 1) (複素和) ──
+        // Mid/Side バンドは Serial 表示と同様に両チャンネルへ作用するものとして扱う
+        std::array<double, NUM_DISPLAY_BARS> sumReL, sumImL, sumReR, sumImR;
+        std::fill_n(sumReL.begin(), numPoints, 1.0);
+        std::fill_n(sumImL.begin(), numPoints, 0.0);
+        std::fill_n(sumReR.begin(), numPoints, 1.0);
+        std::fill_n(sumImR.begin(), numPoints, 0.0);
 
-        i = 0;
-        if (band.mode == EQChannelMode::Stereo ||
-            band.mode == EQChannelMode::Mid ||
-            band.mode == EQChannelMode::Side)
+        for (int b = 0; b < numActiveBands; ++b)
         {
-            for (; i < vEnd; i += 8)
+            const auto& band = activeBands[b];
+            const double* re = band.entry->re.data();
+            const double* im = band.entry->im.data();
+            if (affectsL(band.mode))
             {
-                __m256 vBand = _mm256_loadu_ps(bandMagSq + i);
-                __m256 vL = _mm256_loadu_ps(totalMagSqL + i);
-                __m256 vR = _mm256_loadu_ps(totalMagSqR + i);
-                _mm256_storeu_ps(totalMagSqL + i, _mm256_mul_ps(vL, vBand));
-                _mm256_storeu_ps(totalMagSqR + i, _mm256_mul_ps(vR, vBand));
+                for (int k = 0; k < numPoints; ++k)
+                {
+                    sumReL[k] += re[k] - 1.0;
+                    sumImL[k] += im[k];
+                }
             }
-        }
-        else if (band.mode == EQChannelMode::Left)
-        {
-            for (; i < vEnd; i += 8)
+            if (affectsR(band.mode))
             {
-                __m256 vBand = _mm256_loadu_ps(bandMagSq + i);
-                __m256 vL = _mm256_loadu_ps(totalMagSqL + i);
-                _mm256_storeu_ps(totalMagSqL + i, _mm256_mul_ps(vL, vBand));
+                for (int k = 0; k < numPoints; ++k)
+                {
+                    sumReR[k] += re[k] - 1.0;
+                    sumImR[k] += im[k];
+                }
             }
         }
-        else // Right
+
+        for (int k = 0; k < numPoints; ++k)
+        {
+            totalMagSqL[k] = static_cast<float>(sumReL[k] * sumReL[k] + sumImL[k] * sumImL[k]) * totalGainSq;
+            totalMagSqR[k] = static_cast<float>(sumReR[k] * sumReR[k] + sumImR[k] * sumImR[k]) * totalGainSq;
+        }
+    }
+    else
+    {
+        // ── Serial: |H_total|^2 = Π |H_b|^2 ──
+        const __m256 vTotalGainSq = _mm256_set1_ps(totalGainSq);
+        int i = 0;
+        const int vEnd = numPoints / 8 * 8;
+        for (; i < vEnd; i += 8)
         {
-            for (; i < vEnd; i += 8)
-            {
-                __m256 vBand = _mm256_loadu_ps(bandMagSq + i);
-                __m256 vR = _mm256_loadu_ps(totalMagSqR + i);
-                _mm256_storeu_ps(totalMagSqR + i, _mm256_mul_ps(vR, vBand));
-            }
+            _mm256_storeu_ps(totalMagSqL + i, vTotalGainSq);
+            _mm256_storeu_ps(totalMagSqR + i, vTotalGainSq);
         }
-
         for (; i < numPoints; ++i)
         {
-            float magSq = bandMagSq[i];
-            if (!std::isfinite(magSq)) magSq = 1.0f;
-            if (band.mode == EQChannelMode::Stereo || band.mode == EQChannelMode::Left
-                || band.mode == EQChannelMode::Mid || band.mode == EQChannelMode::Side)
-                totalMagSqL[i] *= magSq;
-            if (band.mode == EQChannelMode::Stereo || band.mode == EQChannelMode::Right
-                || band.mode == EQChannelMode::Mid || band.mode == EQChannelMode::Side)
-                totalMagSqR[i] *= magSq;
+            totalMagSqL[i] = totalGainSq;
+            totalMagSqR[i] = totalGainSq;
+        }
+
+        for (int b = 0; b < numActiveBands; ++b)
+        {
+            const auto& band = activeBands[b];
+            const float* bandMagSq = band.entry->magSq.data();
+
+            i = 0;
+            if (band.mode == EQChannelMode::Stereo ||
+                band.mode == EQChannelMode::Mid ||
+                band.mode == EQChannelMode::Side)
+            {
+                for (; i < vEnd; i += 8)
+                {
+                    __m256 vBand = _mm256_loadu_ps(bandMagSq + i);
+                    __m256 vL = _mm256_loadu_ps(totalMagSqL + i);
+                    __m256 vR = _mm256_loadu_ps(totalMagSqR + i);
+                    _mm256_storeu_ps(totalMagSqL + i, _mm256_mul_ps(vL, vBand));
+                    _mm256_storeu_ps(totalMagSqR + i, _mm256_mul_ps(vR, vBand));
+                }
+            }
+            else if (band.mode == EQChannelMode::Left)
+            {
+                for (; i < vEnd; i += 8)
+                {
+                    __m256 vBand = _mm256_loadu_ps(bandMagSq + i);
+                    __m256 vL = _mm256_loadu_ps(totalMagSqL + i);
+                    _mm256_storeu_ps(totalMagSqL + i, _mm256_mul_ps(vL, vBand));
+                }
+            }
+            else // Right
+            {
+                for (; i < vEnd; i += 8)
+                {
+                    __m256 vBand = _mm256_loadu_ps(bandMagSq + i);
+                    __m256 vR = _mm256_loadu_ps(totalMagSqR + i);
+                    _mm256_storeu_ps(totalMagSqR + i, _mm256_mul_ps(vR, vBand));
+                }
+            }
+
+            for (; i < numPoints; ++i)
+            {
+                float magSq = bandMagSq[i];
+                if (!std::isfinite(magSq)) magSq = 1.0f;
+                if (affectsL(band.mode))
+                    totalMagSqL[i] *= magSq;
+                if (affectsR(band.mode))
+                    totalMagSqR[i] *= magSq;
+            }
         }
     }
 
@@ -1,12 +1,14 @@
 #include <JuceHeader.h>
+#include <limits>
 #include "AudioEngine.h"
+#include "MeteringWorker.h"
 
 //--------------------------------------------------------------
 // FIFOからデータ読み出し (UI Thread)
 //--------------------------------------------------------------
 void AudioEngine::readFromFifo(float* dest, int numSamples)
 {
-    const int actualRead = analyzerFifo.popMixToMono(dest, numSamples);
+    const int actualRead = analyzerFifo.pop(dest, numSamples);
     if (actualRead < numSamples)
         juce::FloatVectorOperations::clear(dest + actualRead, numSamples - actualRead);
 }
@@ -18,3 +20,21 @@ void AudioEngine::skipFifo(int numSamples)
 {
     analyzerFifo.skip(numSamples);
 }
+
+//--------------------------------------------------------------
+// 出力メータの値 (Message Thread。MeteringWorker の生成・破棄と同じスレッド)
+//--------------------------------------------------------------
+AudioEngine::MeterReadings AudioEngine::getMeterReadings() const
+{
+    if (meteringWorker_ != nullptr)
+        return meteringWorker_->getReadings();
+
+    constexpr double silent = -std::numeric_limits<double>::infinity();
+    return { silent, silent, silent, 0.0, silent, silent };
+}
+
+void AudioEngine::resetLoudnessIntegration()
+{
+    if (meteringWorker_ != nullptr)
+        meteringWorker_->requestReset();
+}
@@ -1,6 +1,10 @@
 #include <JuceHeader.h>
 #include "AudioEngine.h"
 #include "RuntimeBuilder.h"
+#include "MeteringWorker.h"
+#include <mkl.h>
+#include <xmmintrin.h>   // _MM_SET_FLUSH_ZERO_MODE
+#include <pmmintrin.h>   // _MM_SET_DENORMALS_ZERO_MODE
 
 namespace {
 [[maybe_unused]] void diagLog(const juce::String& message)
@@ -29,8 +33,8 @@ void AudioEngine::initialize()
     //      deferred reclaim は EpochDomain 配下で初期化済み。
     // readerEpochs と globalEpoch は静的初期化で 0
 
-    // Start worker thread
-    rebuildThread = std::thread(&AudioEngine::rebuildThreadLoop, this);
+    // Start worker threads (Light / Heavy レーン)
+    startRebuildThreads();
 
     // 初期DSP構築 (デフォルト設定)
     // 安全対策: バッファサイズを余裕を持って確保 (kInitialPrepareMaxBlock)
@@ -78,9 +82,9 @@ void AudioEngine::initialize()
     uiConvolverProcessor.addChangeListener(this);
     uiEqEditor.addChangeListener(this);
 
-    // タイマー開始 (100ms間隔)
-    // - DSP再構築リクエストのポーリング (Audio Threadからの依頼を処理)
-    // - ガベージコレクション
+    // タイマー開始 (100ms間隔) — 本当に周期的な処理のみ
+    // - フェード完了 / ガベージコレクション / ディザプール補充 / 診断
+    // - DSP再構築は期限駆動 (triggerAsyncUpdate + m_workerThread) で、ここではポーリングしない
     startTimer(100);
     timerPeriodMs_ = 100;
 
@@ -123,7 +127,8 @@ void AudioEngine::initialize()
 
             diagLog("[AFFINITY] coreTopology: physical=" + juce::String(topo.physicalCoreCount)
                 + " logical=" + juce::String(::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS))
-                + " heterogeneous=" + juce::String(hasHeterogeneousCores_ ? "true" : "false"));
+                + " heterogeneous=" + juce::String(hasHeterogeneousCores_ ? "true" : "false")
+                + " numaNodes=" + juce::String(static_cast<int>(topo.numaNodes.size())));
             diagLog("[AFFINITY] audioMask=0x" + juce::String::toHexString(static_cast<uint64_t>(affinityMasks.audioRealtime))
                 + " nonAudio=0x" + juce::String::toHexString(static_cast<uint64_t>(nonAudioMask))
                 + " worker=0x" + juce::String::toHexString(static_cast<uint64_t>(affinityMasks.worker))
@@ -143,11 +148,48 @@ void AudioEngine::initWorkerThread()
     jassert(juce::MessageManager::getInstance()->isThisTheMessageThread());
     m_workerThread.start();
     affinityManager.applyCurrentThreadPolicy(ThreadType::Worker);
+
+    // ★ 共有バックグラウンドスケジューラ: 旧アップグレード専用プールと同じく論理コアの 1/4 (最低 1)。
+    //   ワーカーは起動時に 1 回だけ HeavyBackground ポリシーと FTZ/DAZ を設定する (専用スレッドなので復元不要)
+    const int schedulerWorkers = std::max(1, juce::SystemStats::getNumCpus() / 4);
+    backgroundScheduler_.start(schedulerWorkers, [this](int)
+    {
+        affinityManager.applyCurrentThreadPolicy(ThreadType::HeavyBackground);
+        vmlSetMode(VML_FTZDAZ_ON | VML_ERRMODE_IGNORE);
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+    });
+
+    // ★ 出力メータ (LUFS / TruePeak) の計算スレッド。meteringFifo は構築時に確保済み
+    meteringWorker_ = std::make_unique<MeteringWorker>(*this);
+    meteringWorker_->startThread();
+
+    // 起動前に立った遅延 rebuild はワーカー停止中に予約できていないため、ここで判定させる
+    if (hasRebuildReason(RebuildReason::DeferredStructural)
+        || hasRebuildReason(RebuildReason::DeferredFinalizeAware))
+        scheduleDeferredRebuildService();
 }
 
 void AudioEngine::shutdownWorkerThread()
 {
+    // 未開始のアップグレード変換は捨て、実行中のものには CancelToken で打ち切りを求めてから止める。
+    // 以降の submit は空のハンドルを返し、呼び出し側が自スレッドで処理する
+    backgroundScheduler_.stop();
     m_workerThread.stop();
+    meteringWorker_.reset();   // デストラクタが stopThread で止める
+}
+
+void AudioEngine::requestWorkerThreadStop()
+{
+    // 終了時に rebuild / 学習器などの停止待ちと重ねるため、ここでは知らせるだけにする。
+    // スケジューラは以後の submit を拒むので、呼び出し側は自スレッドで処理する経路へ落ちる
+    backgroundScheduler_.requestStop();
+    m_workerThread.requestStop();
+    if (meteringWorker_ != nullptr)
+    {
+        meteringWorker_->signalThreadShouldExit();
+        meteringWorker_->notify();   // wait(intervalMs) から起こす
+    }
 }
 
 void AudioEngine::debugAssertNotAudioThread() const
@@ -311,10 +311,10 @@ void AudioEngine::setNoiseShaperLearningMode(convo::NoiseShaperLearningMode mode
     return noiseShaperLearner && noiseShaperLearner->isRunning();
 }
 
-[[nodiscard]] const convo::NoiseShaperLearnerProgress& AudioEngine::getNoiseShaperLearningProgress() const
+[[nodiscard]] convo::NoiseShaperLearnerProgressView AudioEngine::getNoiseShaperLearningProgress() const
 {
     jassert(noiseShaperLearner);
-    return noiseShaperLearner->getProgress();
+    return noiseShaperLearner->getProgressView();
 }
 
 [[nodiscard]] convo::NoiseShaperLearnerSettings AudioEngine::getNoiseShaperLearnerSettings() const
@@ -497,13 +497,17 @@ void AudioEngine::setAdaptiveCoefficientsForSampleRate(double sampleRate, const
 }
 
 void AudioEngine::getAdaptiveCoefficientsForSampleRateAndBitDepth(double sampleRate, int bitDepth, double* outCoeffs, int maxCoefficients) const noexcept
+{
+    const auto mode = convo::consumeAtomic(pendingLearningMode, std::memory_order_acquire); // acquire: setNoiseShaperLearningMode publishAtomic release と HB
+    getAdaptiveCoefficientsForBank(getAdaptiveCoeffBankIndex(sampleRate, bitDepth, mode), outCoeffs, maxCoefficients);
+}
+
+void AudioEngine::getAdaptiveCoefficientsForBank(int bankIndex, double* outCoeffs, int maxCoefficients) const noexcept
 {
     if (outCoeffs == nullptr || maxCoefficients <= 0)
         return;
 
-    const auto mode = convo::consumeAtomic(pendingLearningMode, std::memory_order_acquire); // acquire: setNoiseShaperLearningMode publishAtomic release と HB
-    const int bank = getAdaptiveCoeffBankIndex(sampleRate, bitDepth, mode);
-    const auto& slot = getAdaptiveCoeffBankForIndex(bank);
+    const auto& slot = getAdaptiveCoeffBankForIndex(bankIndex);
 
     for (int retry = 0; retry < 3; ++retry)
     {
@@ -551,6 +555,22 @@ void AudioEngine::setAdaptiveCoefficientsForSampleRateAndBitDepth(double sampleR
     storeLearnedCoeffsToBank(bankIndex, stagedCoefficients);
 }
 
+bool AudioEngine::storeAdaptiveCoeffBank(int bankIndex, const double* coeffs, const convo::NoiseShaperLearnerState& state)
+{
+    if (coeffs == nullptr)
+        return false;
+
+    if (isNoiseShaperLearning())
+    {
+        DBG_LOG("[AudioEngine] Coefficient update rejected during learning");
+        return false;
+    }
+
+    storeLearnedCoeffsToBank(bankIndex, coeffs);
+    setAdaptiveNoiseShaperState(bankIndex, state);
+    return true;
+}
+
 void AudioEngine::setAdaptiveAutosaveCallback(std::function<void()> callback)
 {
     const std::scoped_lock lock(adaptiveAutosaveCallbackMutex);
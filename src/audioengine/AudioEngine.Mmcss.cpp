@@ -13,9 +13,14 @@
 // Shutdown:
 //   - Message Thread sets mmcssShutdownRequested flag ONLY
 //   - Audio Thread performs actual AvRevert in next callback (MSDN: same-thread requirement)
+//
+// DSP helper threads:
+//   - DSPCore's pipelined convolver worker and channel-split helper register themselves via
+//     applyMmcssForDspHelperThread() and revert on their own thread before exiting (same thread_local handle).
 
 #include "AudioEngine.h"
 #include "DiagnosticsConfig.h"
+#include "../NativeWasapiExclusive.h"
 #include <windows.h>
 #include <avrt.h>
 #pragma comment(lib, "avrt.lib")
@@ -43,79 +48,12 @@ HANDLE tryTask(LPCWSTR taskName, DWORD& idx) noexcept
     return ::AvSetMmThreadCharacteristicsW(taskName, &idx);
 }
 
-} // anonymous namespace
-
-// ── Public ──
-
-// Determine MMCSS policy based on current audio backend device type.
-// Uses the cached currentDeviceTypeName_ (set via setAudioDeviceTypeName from Message Thread).
-// Called from both Message Thread (prepareToPlay) and Audio Thread (callback).
-// Device type is immutable during a session → safe to call from either thread.
-[[nodiscard]] AudioEngine::MmcssPolicy AudioEngine::getCurrentMmcssPolicy() const noexcept
+// Register the calling thread with MMCSS: primary task, then fallback1 / fallback2 on ERROR_INVALID_TASK_NAME.
+// Shared by the audio thread (tryApplyMmcssForSelfManagedThread) and the DSP helper threads
+// (applyMmcssForDspHelperThread). Result is stored in the thread_local handle.
+bool registerMmcssTask(LPCWSTR primaryTask, LPCWSTR fallback1, LPCWSTR fallback2,
+                       int avrtPriority, [[maybe_unused]] const char* policyTag) noexcept
 {
-    const auto& type = currentDeviceTypeName_;
-    if (type.containsIgnoreCase("WASAPI") || type.containsIgnoreCase("Windows Audio"))
-        return MmcssPolicy::JuceManaged;
-    if (type.containsIgnoreCase("ASIO"))
-        return MmcssPolicy::SelfManagedProAudio;
-    if (type.containsIgnoreCase("DirectSound"))
-        return MmcssPolicy::SelfManagedPlayback;
-    return MmcssPolicy::None;
-}
-
-// Try to register the calling (audio) thread with MMCSS once.
-// - WASAPI (JuceManaged / None): skip, return true (JUCE manages or unknown backend).
-// - ASIO  (SelfManagedProAudio): AvSetMmThreadCharacteristicsW(L"Pro Audio") + AVRT_PRIORITY_CRITICAL.
-// - DS    (SelfManagedPlayback):  AvSetMmThreadCharacteristicsW(L"Playback") + AVRT_PRIORITY_HIGH.
-//
-// Logs success/failure via CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS guard (zero cost in Release).
-//
-// Return value:
-//   true  = MMCSS is active (by JUCE, driver, or our registration).
-//   false = MMCSS registration failed entirely (fallback to NativeRT or no special priority).
-//
-// RT impact: first call only (~50-200μs for LPC call to MMCSS service). Subsequent calls: O(1) TLS read.
-[[nodiscard]] bool AudioEngine::tryApplyMmcssForSelfManagedThread() noexcept
-{
-    if (t_mmcssTried)
-        return (t_mmcssHandle != nullptr);
-    t_mmcssTried = true;
-
-    // ★ CPU affinity + NativeRT: always set on first callback, regardless of policy.
-    //    applyMmcssPriority() handles SetThreadAffinityMask (all backends)
-    //    and SetPriorityClass/SetThreadPriority (NativeRT mode only).
-    applyMmcssPriority();
-
-    if (!convo::consumeAtomic(useMmcssPriority, std::memory_order_acquire))
-        return false; // NativeRT mode selected by user
-
-    const auto policy = getCurrentMmcssPolicy();
-
-    // WASAPI or unknown → JUCE manages or nothing to do
-    if (policy == MmcssPolicy::JuceManaged || policy == MmcssPolicy::None)
-        return true;
-
-    // ── Determine task name and priority ──
-    LPCWSTR primaryTask = nullptr;
-    LPCWSTR fallback1   = nullptr;
-    LPCWSTR fallback2   = nullptr;
-    int avrtPriority    = AVRT_PRIORITY_CRITICAL;
-    [[maybe_unused]] const char* policyTag = nullptr;
-
-    if (policy == MmcssPolicy::SelfManagedProAudio) {
-        primaryTask  = L"Pro Audio";
-        fallback1    = L"Audio";
-        fallback2    = nullptr;
-        avrtPriority = AVRT_PRIORITY_CRITICAL;
-        policyTag    = "ASIO";
-    } else { // SelfManagedPlayback
-        primaryTask  = L"Playback";
-        fallback1    = L"Audio";
-        fallback2    = L"Pro Audio";
-        avrtPriority = AVRT_PRIORITY_HIGH;
-        policyTag    = "DS";
-    }
-
     // ── Attempt primary task registration ──
     DWORD idx = 0;
     HANDLE h = tryTask(primaryTask, idx);
@@ -196,6 +134,86 @@ HANDLE tryTask(LPCWSTR taskName, DWORD& idx) noexcept
     return false;
 }
 
+} // anonymous namespace
+
+// ── Public ──
+
+// Determine MMCSS policy based on current audio backend device type.
+// Uses the cached currentDeviceTypeName_ (set via setAudioDeviceTypeName from Message Thread).
+// Called from both Message Thread (prepareToPlay) and Audio Thread (callback).
+// Device type is immutable during a session → safe to call from either thread.
+[[nodiscard]] AudioEngine::MmcssPolicy AudioEngine::getCurrentMmcssPolicy() const noexcept
+{
+    const auto& type = currentDeviceTypeName_;
+    // 自前の WASAPI 排他種別は RT スレッドが自分で Pro Audio に登録する (名前に "WASAPI" を含むので先に判定)
+    if (type == NativeWasapiExclusiveDeviceType::kTypeName)
+        return MmcssPolicy::SelfManagedProAudio;
+    if (type.containsIgnoreCase("WASAPI") || type.containsIgnoreCase("Windows Audio"))
+        return MmcssPolicy::JuceManaged;
+    if (type.containsIgnoreCase("ASIO"))
+        return MmcssPolicy::SelfManagedProAudio;
+    if (type.containsIgnoreCase("DirectSound"))
+        return MmcssPolicy::SelfManagedPlayback;
+    return MmcssPolicy::None;
+}
+
+// Try to register the calling (audio) thread with MMCSS once.
+// - WASAPI (JuceManaged / None): skip, return true (JUCE manages or unknown backend).
+// - ASIO  (SelfManagedProAudio): AvSetMmThreadCharacteristicsW(L"Pro Audio") + AVRT_PRIORITY_CRITICAL.
+//   WASAPI Exclusive (Native) も同じ扱い。RT スレッドが登録済みなので 183 (already) で成功になる。
+// - DS    (SelfManagedPlayback):  AvSetMmThreadCharacteristicsW(L"Playback") + AVRT_PRIORITY_HIGH.
+//
+// Logs success/failure via CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS guard (zero cost in Release).
+//
+// Return value:
+//   true  = MMCSS is active (by JUCE, driver, or our registration).
+//   false = MMCSS registration failed entirely (fallback to NativeRT or no special priority).
+//
+// RT impact: first call only (~50-200μs for LPC call to MMCSS service). Subsequent calls: O(1) TLS read.
+[[nodiscard]] bool AudioEngine::tryApplyMmcssForSelfManagedThread() noexcept
+{
+    if (t_mmcssTried)
+        return (t_mmcssHandle != nullptr);
+    t_mmcssTried = true;
+
+    // ★ CPU affinity + NativeRT: always set on first callback, regardless of policy.
+    //    applyMmcssPriority() handles SetThreadAffinityMask (all backends)
+    //    and SetPriorityClass/SetThreadPriority (NativeRT mode only).
+    applyMmcssPriority();
+
+    if (!convo::consumeAtomic(useMmcssPriority, std::memory_order_acquire))
+        return false; // NativeRT mode selected by user
+
+    const auto policy = getCurrentMmcssPolicy();
+
+    // WASAPI or unknown → JUCE manages or nothing to do
+    if (policy == MmcssPolicy::JuceManaged || policy == MmcssPolicy::None)
+        return true;
+
+    // ── Determine task name and priority ──
+    LPCWSTR primaryTask = nullptr;
+    LPCWSTR fallback1   = nullptr;
+    LPCWSTR fallback2   = nullptr;
+    int avrtPriority    = AVRT_PRIORITY_CRITICAL;
+    [[maybe_unused]] const char* policyTag = nullptr;
+
+    if (policy == MmcssPolicy::SelfManagedProAudio) {
+        primaryTask  = L"Pro Audio";
+        fallback1    = L"Audio";
+        fallback2    = nullptr;
+        avrtPriority = AVRT_PRIORITY_CRITICAL;
+        policyTag    = (currentDeviceTypeName_ == NativeWasapiExclusiveDeviceType::kTypeName) ? "WASAPI-Excl" : "ASIO";
+    } else { // SelfManagedPlayback
+        primaryTask  = L"Playback";
+        fallback1    = L"Audio";
+        fallback2    = L"Pro Audio";
+        avrtPriority = AVRT_PRIORITY_HIGH;
+        policyTag    = "DS";
+    }
+
+    return registerMmcssTask(primaryTask, fallback1, fallback2, avrtPriority, policyTag);
+}
+
 // Revert MMCSS on the audio thread (MUST be called from same thread that registered).
 // Called when mmcssShutdownRequested flag is detected in the callback.
 void AudioEngine::revertMmcssOnAudioThread() noexcept
@@ -210,3 +228,24 @@ void AudioEngine::revertMmcssOnAudioThread() noexcept
     }
     t_mmcssTried = false; // Allow retry on next device open / thread creation
 }
+
+// Register a DSP helper thread (DSPCore::convolverPipeline worker, DSPCore::channelSplit helper) with MMCSS.
+// Called once at the top of the helper thread. Unlike the device callback, nobody else manages this
+// thread, so it is registered for every backend:
+// - DS (SelfManagedPlayback): Playback/HIGH, same task as the audio thread.
+// - otherwise:                Pro Audio/CRITICAL (what JUCE uses for WASAPI and drivers for ASIO).
+// - NativeRT mode:            THREAD_PRIORITY_TIME_CRITICAL only (the process class is set by the audio thread).
+// Revert with revertMmcssOnAudioThread() from the same helper thread before it exits.
+bool AudioEngine::applyMmcssForDspHelperThread() noexcept
+{
+    if (t_mmcssTried)
+        return (t_mmcssHandle != nullptr);
+    t_mmcssTried = true;
+
+    if (!convo::consumeAtomic(useMmcssPriority, std::memory_order_acquire))
+        return ::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+
+    if (getCurrentMmcssPolicy() == MmcssPolicy::SelfManagedPlayback)
+        return registerMmcssTask(L"Playback", L"Audio", L"Pro Audio", AVRT_PRIORITY_HIGH, "DspHelper-DS");
+    return registerMmcssTask(L"Pro Audio", L"Audio", nullptr, AVRT_PRIORITY_CRITICAL, "DspHelper");
+}
@@ -58,6 +58,7 @@ void diagLog(const juce::String& message)
     if (!hasFiniteDouble("tailStartSec", ConvolverProcessor::TAIL_START_MIN_SEC, ConvolverProcessor::TAIL_START_MAX_SEC)) return false;
     if (!hasFiniteDouble("tailStrength", ConvolverProcessor::TAIL_STRENGTH_MIN, ConvolverProcessor::TAIL_STRENGTH_MAX)) return false;
     if (!hasIntRange("tailL1L2Multiplier", ConvolverProcessor::TAIL_L1L2_MULT_MIN, ConvolverProcessor::TAIL_L1L2_MULT_MAX)) return false;
+    if (!hasFiniteDouble("farTailHorizonSec", ConvolverProcessor::FAR_TAIL_HORIZON_MIN_SEC, ConvolverProcessor::FAR_TAIL_HORIZON_MAX_SEC)) return false;
 
     if (state.hasProperty("mixedF1Hz") && state.hasProperty("mixedF2Hz"))
     {
@@ -114,7 +115,7 @@ void diagLog(const juce::String& message)
     if (!hasFiniteDouble("convolverInputTrimDb", -12.0, 0.0)) return false;
     if (!hasIntRange("analyzerSource", static_cast<int>(AudioEngine::AnalyzerSource::Input), static_cast<int>(AudioEngine::AnalyzerSource::Output))) return false;
     if (!hasIntRange("noiseShaperType", static_cast<int>(convo::NoiseShaperType::Psychoacoustic), static_cast<int>(convo::NoiseShaperType::Fixed15Tap))) return false;
-    if (!hasIntRange("oversamplingType", static_cast<int>(convo::OversamplingType::IIR), static_cast<int>(convo::OversamplingType::LinearPhase))) return false;
+    if (!hasIntRange("oversamplingType", static_cast<int>(convo::OversamplingType::IIR), static_cast<int>(convo::OversamplingType::MinimumPhase))) return false;
     if (!hasIntRange("convHCFilterMode", static_cast<int>(convo::HCMode::Sharp), static_cast<int>(convo::HCMode::Soft))) return false;
     if (!hasIntRange("convLCFilterMode", static_cast<int>(convo::LCMode::Natural), static_cast<int>(convo::LCMode::Soft))) return false;
     if (!hasIntRange("eqLPFFilterMode", static_cast<int>(convo::HCMode::Sharp), static_cast<int>(convo::HCMode::Soft))) return false;
@@ -156,8 +157,9 @@ void AudioEngine::setEqBypassRequested (bool shouldBypass)
     convo::publishAtomic(eqBypassRequested, shouldBypass, std::memory_order_release);
     convo::publishAtomic(m_currentEqBypass, shouldBypass, std::memory_order_release);
     uiEqEditor.setBypass(shouldBypass);
+    cancelEQFoldIntoIR();
     applyDefaultsForCurrentMode();
-    submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+    postParameterIntentEvent(ParameterIntentSlot::EqBypass);
     sendChangeMessage();
 }
 
@@ -167,11 +169,172 @@ void AudioEngine::setConvolverBypassRequested (bool shouldBypass)
     convo::publishAtomic(convBypassRequested, shouldBypass, std::memory_order_release);
     convo::publishAtomic(m_currentConvBypass, shouldBypass, std::memory_order_release);
     uiConvolverProcessor.setBypass(shouldBypass);
+    cancelEQFoldIntoIR();
     applyDefaultsForCurrentMode();
-    submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+    postParameterIntentEvent(ParameterIntentSlot::ConvolverBypass);
     sendChangeMessage();
 }
 
+//--------------------------------------------------------------
+// ★ EQ fold: 静的な EQ を Convolver IR に焼き込み、ライブ EQ 段を省略する
+//
+// EQ 編集が kEQFoldSettleMs 静止し、かつ線形・時不変 (AGC/飽和なし, Serial, M/S なし) で
+// Convolver が wet 100% のときのみ arm する。arm / 解除はいずれも Structural rebuild を発行し、
+// 既存の DSPCore 差し替えクロスフェードで切り替える。EQ 編集時は rebuild 前に解除するため、
+// 新しい DSPCore は必ずライブ EQ 段で編集内容を反映する。
+//--------------------------------------------------------------
+void AudioEngine::setEQFoldIntoIREnabled(bool enabled)
+{
+    ASSERT_NON_RT_THREAD();
+    convo::publishAtomic(eqFoldIntoIREnabled, enabled, std::memory_order_release); // release: timer 側 consumeAtomic(acquire) と HB
+
+    const bool wasArmed = (eqFoldParamsHash != 0);
+    cancelEQFoldIntoIR();
+    if (wasArmed)
+        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EqFoldIntoIRChanged, RebuildTelemetryClass::Structural, RebuildTelemetryPolicy::Replaceable);
+    sendChangeMessage();
+}
+
+void AudioEngine::cancelEQFoldIntoIR()
+{
+    ASSERT_NON_RT_THREAD();
+    eqFoldLastEditMs = juce::Time::getMillisecondCounterHiRes();
+    if (eqFoldParamsHash != 0 || uiConvolverProcessor.hasFoldedEQ())
+    {
+        uiConvolverProcessor.setFoldedEQ(nullptr);
+        eqFoldParamsHash = 0;
+    }
+}
+
+bool AudioEngine::captureFoldableEQ(convo::EQParameters& out) const
+{
+    if (!convo::consumeAtomic(eqFoldIntoIREnabled, std::memory_order_acquire)) // acquire: setEQFoldIntoIREnabled の release と HB
+        return false;
+    if (convo::consumeAtomic(eqBypassRequested, std::memory_order_acquire)   // acquire: setEqBypassRequested の release と HB
+        || convo::consumeAtomic(convBypassRequested, std::memory_order_acquire)) // acquire: setConvolverBypassRequested の release と HB
+        return false;
+    if (!uiConvolverProcessor.isIRLoaded())
+        return false;
+
+    const auto buildSnapshot = uiConvolverProcessor.captureBuildSnapshot();
+    if (buildSnapshot.bypassed || buildSnapshot.mix < 1.0f - 1.0e-5f)
+        return false;
+
+    const auto* eqState = uiEqEditor.getEQStateSnapshot();
+    if (eqState == nullptr)
+        return false;
+
+    out = eqState->toEQParameters();
+    return EQProcessor::isFoldableIntoIR(out, false);
+}
+
+void AudioEngine::serviceEQFoldIntoIR()
+{
+    ASSERT_NON_RT_THREAD();
+    const bool armed = (eqFoldParamsHash != 0);
+
+    convo::EQParameters params;
+    const bool foldable = captureFoldableEQ(params);
+
+    if (armed)
+    {
+        // 条件が崩れた (モード OFF 以外の経路で mix / bypass 等が変化) 場合は解除してライブ EQ へ戻す
+        if (!foldable || EQProcessor::computeParamsHash(params) != eqFoldParamsHash)
+        {
+            cancelEQFoldIntoIR();
+            submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EqFoldIntoIRChanged, RebuildTelemetryClass::Structural, RebuildTelemetryPolicy::Replaceable);
+        }
+        return;
+    }
+
+    if (!foldable)
+        return;
+    if (juce::Time::getMillisecondCounterHiRes() - eqFoldLastEditMs < kEQFoldSettleMs)
+        return;
+
+    const uint64_t hash = EQProcessor::computeParamsHash(params);
+    uiConvolverProcessor.setFoldedEQ(&params);
+    eqFoldParamsHash = (hash != 0) ? hash : 1ULL; // 0 は「未 arm」を表すため避ける
+    submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EqFoldIntoIRChanged, RebuildTelemetryClass::Structural, RebuildTelemetryPolicy::Replaceable);
+}
+
+void AudioEngine::setEQSplitRateEnabled(bool enabled)
+{
+    ASSERT_NON_RT_THREAD();
+    if (convo::exchangeAtomic(eqSplitRateEnabled, enabled, std::memory_order_acq_rel) == enabled) // acq_rel: rebuild thread の acquire と HB
+        return;
+    // EQ の処理レートが変わるためフィルタ状態は引き継がず、DSPCore 交換のクロスフェードで切り替える
+    postParameterIntent(ParameterIntentSlot::EqSplitRate, enabled ? 1u : 0u);
+    sendChangeMessage();
+}
+
+void AudioEngine::setPipelinedConvolverEnabled(bool enabled)
+{
+    ASSERT_NON_RT_THREAD();
+    if (convo::exchangeAtomic(pipelinedConvolverEnabled, enabled, std::memory_order_acq_rel) == enabled) // acq_rel: rebuild thread の acquire と HB
+        return;
+    // ワーカーの起動 / 停止と遅延の増減は新しい DSPCore で行い、DSPCore 交換のクロスフェードで切り替える
+    postParameterIntent(ParameterIntentSlot::PipelinedConvolver, enabled ? 1u : 0u);
+    sendChangeMessage();
+}
+
+void AudioEngine::setChannelSplitEnabled(bool enabled)
+{
+    ASSERT_NON_RT_THREAD();
+    if (convo::exchangeAtomic(channelSplitEnabled, enabled, std::memory_order_acq_rel) == enabled) // acq_rel: rebuild thread の acquire と HB
+        return;
+    // helper の起動 / 停止は新しい DSPCore で行う (処理結果は変わらないが、helper の寿命を DSPCore に揃える)
+    postParameterIntent(ParameterIntentSlot::ChannelSplit, enabled ? 1u : 0u);
+    sendChangeMessage();
+}
+
+void AudioEngine::setAdaptiveSoftClipOSEnabled(bool enabled)
+{
+    ASSERT_NON_RT_THREAD();
+    if (convo::exchangeAtomic(adaptiveSoftClipOSEnabled, enabled, std::memory_order_acq_rel) == enabled) // acq_rel: rebuild thread の acquire と HB
+        return;
+    // 経路の判定状態 (1x / OS・遅延線) は新しい DSPCore で 0 から始め、DSPCore 交換のクロスフェードで切り替える
+    postParameterIntent(ParameterIntentSlot::AdaptiveSoftClipOS, enabled ? 1u : 0u);
+    sendChangeMessage();
+}
+
+void AudioEngine::setFixedBlockReblockEnabled(bool enabled)
+{
+    ASSERT_NON_RT_THREAD();
+    if (convo::exchangeAtomic(fixedBlockReblockEnabled, enabled, std::memory_order_acq_rel) == enabled) // acq_rel: Audio Thread / prepareToPlay の acquire と HB
+        return;
+    if (syncMaxSamplesPerBlockToFixedReblock())
+        postParameterIntent(ParameterIntentSlot::FixedBlockReblock, enabled ? 1u : 0u);
+    sendChangeMessage();
+}
+
+bool AudioEngine::syncMaxSamplesPerBlockToFixedReblock()
+{
+    // DSPCore のブロック上限を内部ブロック (無効時はデバイス長) へ揃え直す。
+    // Audio Thread は上限が内部ブロックに届いた DSPCore が公開されてからリブロックを始める
+    const int deviceBlockSize = convo::consumeAtomic(deviceSamplesPerBlock, std::memory_order_acquire); // acquire: prepareToPlay の release と HB
+    if (deviceBlockSize <= 0)
+        return false; // 未準備: 次の prepareToPlay が反映する
+
+    const int dspBlockSize = convo::consumeAtomic(fixedBlockReblockEnabled, std::memory_order_acquire)
+        ? getFixedReblockSize(deviceBlockSize)
+        : deviceBlockSize;
+    return convo::exchangeAtomic(maxSamplesPerBlock, dspBlockSize, std::memory_order_acq_rel) != dspBlockSize; // acq_rel: rebuild thread の acquire と HB
+}
+
+void AudioEngine::setFixedInternalSampleRate(int sampleRateHz, bool minimumPhase)
+{
+    ASSERT_NON_RT_THREAD();
+    const int clamped = (sampleRateHz <= 0)
+        ? 0
+        : juce::jlimit(kMinFixedInternalSampleRate, static_cast<int>(SAFE_MAX_SAMPLE_RATE), sampleRateHz);
+    const bool rateChanged = convo::exchangeAtomic(fixedInternalSampleRateHz, clamped, std::memory_order_acq_rel) != clamped; // acq_rel: prepareToPlay の acquire と HB
+    const bool phaseChanged = convo::exchangeAtomic(fixedInternalRateMinimumPhase, minimumPhase, std::memory_order_acq_rel) != minimumPhase; // acq_rel: prepareToPlay の acquire と HB
+    // SRC の組み直しと DSPCore のレート変更は prepareToPlay が行う (呼び出し側がデバイスを開き直す)
+    if (rateChanged || phaseChanged)
+        sendChangeMessage();
+}
+
 void AudioEngine::setConvolverPhaseMode(ConvolverProcessor::PhaseMode mode)
 {
     uiConvolverProcessor.setPhaseMode(mode);
@@ -191,7 +354,11 @@ void AudioEngine::requestEqPreset (int presetIndex)
 void AudioEngine::requestEqPresetFromText(const juce::File& file)
 {
     if (uiEqEditor.loadFromTextFile(file))
+    {
         sendChangeMessage();
+        // 同じディレクトリのプリセットをバンクとみなし、切替時の係数再計算を先回りする
+        prebuildEQPresetBank(file.getParentDirectory());
+    }
 }
 
 void AudioEngine::requestConvolverPreset(const juce::File& irFile)
@@ -237,7 +404,7 @@ void AudioEngine::setInputHeadroomDb(float db)
         convo::publishAtomic(inputHeadroomDb, clampedDb, std::memory_order_release);
         convo::publishAtomic(inputHeadroomGain, juce::Decibels::decibelsToGain((double)clampedDb), std::memory_order_release);
         convo::publishAtomic(m_currentInputHeadroomDb, clampedDb, std::memory_order_release);
-        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::InputHeadroom, std::bit_cast<uint32_t>(clampedDb));
     }
 }
 
@@ -256,7 +423,7 @@ void AudioEngine::setOutputMakeupDb(float db)
         convo::publishAtomic(outputMakeupDb, clampedDb, std::memory_order_release);
         convo::publishAtomic(outputMakeupGain, juce::Decibels::decibelsToGain((double)clampedDb), std::memory_order_release);
         convo::publishAtomic(m_currentOutputMakeupDb, clampedDb, std::memory_order_release);
-        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::OutputMakeup, std::bit_cast<uint32_t>(clampedDb));
     }
 }
 
@@ -270,7 +437,7 @@ void AudioEngine::setProcessingOrder(ProcessingOrder order)
     ASSERT_NON_RT_THREAD();
     convo::publishAtomic(currentProcessingOrder, order, std::memory_order_release);
     convo::publishAtomic(m_currentProcessingOrder, order, std::memory_order_release);
-    submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+    postParameterIntent(ParameterIntentSlot::ProcessingOrder, static_cast<uint64_t>(order));
     sendChangeMessage();
 }
 
@@ -284,7 +451,7 @@ void AudioEngine::setConvolverInputTrimDb(float db)
         convo::publishAtomic(convolverInputTrimDb, clampedDb, std::memory_order_release);
         convo::publishAtomic(convolverInputTrimGain, juce::Decibels::decibelsToGain((double)clampedDb), std::memory_order_release);
         convo::publishAtomic(m_currentConvInputTrimDb, clampedDb, std::memory_order_release);
-        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::ConvolverInputTrim, std::bit_cast<uint32_t>(clampedDb));
     }
 }
 
@@ -340,7 +507,7 @@ void AudioEngine::applyDefaultsForCurrentMode()
     convo::publishAtomic(m_currentInputHeadroomDb, newInputHeadroomDb, std::memory_order_release);
     convo::publishAtomic(m_currentOutputMakeupDb, newOutputMakeupDb, std::memory_order_release);
     convo::publishAtomic(m_currentConvInputTrimDb, newConvTrimDb, std::memory_order_release);
-    submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+    postParameterIntentEvent(ParameterIntentSlot::ModeDefaults);
 }
 
 void AudioEngine::setDitherBitDepth(int bitDepth)
@@ -360,7 +527,7 @@ void AudioEngine::setDitherBitDepth(int bitDepth)
         convo::publishAtomic(ditherBitDepth, bitDepth, std::memory_order_release);
         convo::publishAtomic(m_currentDitherBitDepth, bitDepth, std::memory_order_release);
         DBG_LOG("Dither Bit Depth changed: " + juce::String(bitDepth));
-        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::DitherBitDepth, static_cast<uint32_t>(bitDepth));
 
         selectAdaptiveCoeffBankForCurrentSettings();
 
@@ -384,6 +551,7 @@ void AudioEngine::setDitherBitDepth(int bitDepth)
             if (shouldDeferRebuild)
             {
                 setRebuildReason(RebuildReason::DeferredFinalizeAware);
+                scheduleDeferredRebuildService();
                 diagLog("[DIAG] setDitherBitDepth: deferred rebuild until IR finalized");
             }
             else
@@ -402,6 +570,17 @@ void AudioEngine::setDitherBitDepth(int bitDepth)
     return convo::consumeAtomic(ditherBitDepth, std::memory_order_acquire);
 }
 
+void AudioEngine::setDeviceIntegerOutputBits(int bits)
+{
+    // 出力段のゲインだけに効く (DSP 再構築不要)。Audio Thread はブロックごとに ProcessingState へ読み込む
+    convo::publishAtomic(deviceIntegerOutputBits, bits, std::memory_order_relaxed);
+}
+
+[[nodiscard]] int AudioEngine::getDeviceIntegerOutputBits() const
+{
+    return convo::consumeAtomic(deviceIntegerOutputBits, std::memory_order_relaxed);
+}
+
 void AudioEngine::setNoiseShaperType(NoiseShaperType type)
 {
     if (convo::consumeAtomic(noiseShaperType, std::memory_order_acquire) != type)
@@ -437,7 +616,7 @@ void AudioEngine::setNoiseShaperType(NoiseShaperType type)
             typeName = "Adaptive9thOrder";
 
         DBG_LOG("Noise Shaper changed: " + typeName);
-        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::NoiseShaper, static_cast<uint64_t>(type));
         const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
         if (!m_isRestoringState && sr > 0.0)
         {
@@ -455,6 +634,7 @@ void AudioEngine::setNoiseShaperType(NoiseShaperType type)
             if (shouldDeferRebuild)
             {
                 setRebuildReason(RebuildReason::DeferredFinalizeAware);
+                scheduleDeferredRebuildService();
                 diagLog("[DIAG] setNoiseShaperType: deferred rebuild until IR finalized");
             }
             else
@@ -497,7 +677,7 @@ void AudioEngine::setSoftClipEnabled(bool enabled)
 {
     convo::publishAtomic(softClipEnabled, enabled, std::memory_order_release);
     convo::publishAtomic(m_currentSoftClipEnabled, enabled, std::memory_order_release);
-    submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+    postParameterIntent(ParameterIntentSlot::SoftClip, enabled ? 1u : 0u);
 }
 
 [[nodiscard]] bool AudioEngine::isSoftClipEnabled() const
@@ -522,7 +702,7 @@ void AudioEngine::setSaturationAmount(float amount)
     {
         convo::publishAtomic(saturationAmount, clamped, std::memory_order_release);
         convo::publishAtomic(m_currentSaturationAmount, clamped, std::memory_order_release);
-        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::Saturation, std::bit_cast<uint32_t>(clamped));
     }
 }
 
@@ -544,7 +724,7 @@ void AudioEngine::setOversamplingFactor(int factor)
     {
         convo::publishAtomic(manualOversamplingFactor, newFactor, std::memory_order_release);
         convo::publishAtomic(m_currentOversamplingFactor, newFactor, std::memory_order_release);
-        submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::OversamplingFactor, static_cast<uint32_t>(newFactor));
         const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
         if (!m_isRestoringState && sr > 0.0)
         {
@@ -615,7 +795,7 @@ void AudioEngine::setOversamplingType(OversamplingType type)
 {
     convo::publishAtomic(oversamplingType, type, std::memory_order_release);
     convo::publishAtomic(m_currentOversamplingType, type, std::memory_order_release);
-    submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+    postParameterIntent(ParameterIntentSlot::OversamplingType, static_cast<uint64_t>(type));
     const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
     if (!m_isRestoringState && sr > 0.0)
     {
@@ -631,6 +811,26 @@ void AudioEngine::setOversamplingType(OversamplingType type)
     return convo::consumeAtomic(oversamplingType, std::memory_order_acquire);
 }
 
+void AudioEngine::setOversamplingSinglePrecision(bool enabled)
+{
+    if (convo::exchangeAtomic(oversamplingSinglePrecision, enabled, std::memory_order_acq_rel) == enabled)
+        return;
+
+    const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
+    if (!m_isRestoringState && sr > 0.0)
+    {
+        submitRebuildIntent(convo::RebuildKind::Structural,
+                            RebuildTelemetryReason::RequestRebuildKindEntry,
+                            RebuildTelemetryClass::Structural,
+                            RebuildTelemetryPolicy::Replaceable);
+    }
+}
+
+[[nodiscard]] bool AudioEngine::getOversamplingSinglePrecision() const
+{
+    return convo::consumeAtomic(oversamplingSinglePrecision, std::memory_order_acquire);
+}
+
 //====================================================================
 // 出力周波数フィルターモード Setter / Getter (Message Thread)
 //====================================================================
@@ -718,6 +918,31 @@ void AudioEngine::setConvolverEnableProgressiveUpgrade(bool enabled)
     uiConvolverProcessor.setEnableProgressiveUpgrade(enabled);
 }
 
+[[nodiscard]] bool AudioEngine::isConvolverStreamingIRActivationEnabled() const
+{
+    return uiConvolverProcessor.isStreamingIRActivationEnabled();
+}
+
+void AudioEngine::setConvolverStreamingIRActivationEnabled(bool enabled)
+{
+    uiConvolverProcessor.setStreamingIRActivationEnabled(enabled);
+}
+
+[[nodiscard]] bool AudioEngine::isConvolverIncrementalRebuildEnabled() const
+{
+    return uiConvolverProcessor.isIncrementalRebuildEnabled();
+}
+
+void AudioEngine::setConvolverIncrementalRebuildEnabled(bool enabled)
+{
+    uiConvolverProcessor.setUseIncrementalRebuild(enabled);
+}
+
+[[nodiscard]] bool AudioEngine::isConvolverFarTailPagingEnabled() const
+{
+    return uiConvolverProcessor.isFarTailPagingEnabled();
+}
+
 [[nodiscard]] int AudioEngine::getConvolverMaxCacheEntries() const
 {
     return static_cast<int>(uiConvolverProcessor.getMaxCacheEntries());
@@ -728,6 +953,91 @@ void AudioEngine::setConvolverMaxCacheEntries(int maxEntries)
     uiConvolverProcessor.setMaxCacheEntries(static_cast<size_t>(maxEntries));
 }
 
+[[nodiscard]] size_t AudioEngine::getConvolverResampledCacheBudgetBytes() const
+{
+    return uiConvolverProcessor.getResampledIRCacheBudgetBytes();
+}
+
+void AudioEngine::setConvolverResampledCacheBudgetBytes(size_t bytes)
+{
+    uiConvolverProcessor.setResampledIRCacheBudgetBytes(bytes);
+}
+
+[[nodiscard]] std::vector<double> AudioEngine::getConvolverStandbySampleRates() const
+{
+    return uiConvolverProcessor.getStandbySampleRates();
+}
+
+void AudioEngine::setConvolverStandbySampleRates(std::vector<double> rates)
+{
+    uiConvolverProcessor.setStandbySampleRates(std::move(rates));
+}
+
+[[nodiscard]] size_t AudioEngine::getConvolverStandbyBudgetBytes() const
+{
+    return uiConvolverProcessor.getStandbyBudgetBytes();
+}
+
+void AudioEngine::setConvolverStandbyBudgetBytes(size_t bytes)
+{
+    uiConvolverProcessor.setStandbyBudgetBytes(bytes);
+}
+
+[[nodiscard]] int AudioEngine::getConvolverCachePrefetchCount() const
+{
+    return uiConvolverProcessor.getCachePrefetchCount();
+}
+
+void AudioEngine::setConvolverCachePrefetchCount(int count)
+{
+    uiConvolverProcessor.setCachePrefetchCount(count);
+}
+
+[[nodiscard]] size_t AudioEngine::getConvolverCachePrefetchBudgetBytes() const
+{
+    return uiConvolverProcessor.getCachePrefetchBudgetBytes();
+}
+
+void AudioEngine::setConvolverCachePrefetchBudgetBytes(size_t bytes)
+{
+    uiConvolverProcessor.setCachePrefetchBudgetBytes(bytes);
+}
+
+[[nodiscard]] bool AudioEngine::isConvolverCacheCompressionEnabled() const
+{
+    return uiConvolverProcessor.isCacheCompressionEnabled();
+}
+
+void AudioEngine::setConvolverCacheCompressionEnabled(bool enabled)
+{
+    uiConvolverProcessor.setCacheCompressionEnabled(enabled);
+}
+
+[[nodiscard]] uint64_t AudioEngine::getConvolverCacheDiskBudgetBytes() const
+{
+    return uiConvolverProcessor.getCacheDiskBudgetBytes();
+}
+
+void AudioEngine::setConvolverCacheDiskBudgetBytes(uint64_t bytes)
+{
+    uiConvolverProcessor.setCacheDiskBudgetBytes(bytes);
+}
+
+[[nodiscard]] bool AudioEngine::isConvolverCacheCostWeightedEviction() const
+{
+    return uiConvolverProcessor.isCacheCostWeightedEviction();
+}
+
+void AudioEngine::setConvolverCacheCostWeightedEviction(bool enabled)
+{
+    uiConvolverProcessor.setCacheCostWeightedEviction(enabled);
+}
+
+[[nodiscard]] CacheManager::Stats AudioEngine::getConvolverCacheStats() const
+{
+    return uiConvolverProcessor.getCacheStats();
+}
+
 void AudioEngine::clearConvolverCache()
 {
     uiConvolverProcessor.clearCache();
@@ -3,6 +3,7 @@
 #include "DiagnosticsConfig.h"
 #include "NoiseShaperLearner.h"
 #include "core/TimeUtils.h"
+#include "EtwTrace.h"
 
 // windows.h: SetThreadAffinityMask 用（applyMmcssPriority 経由）
 #include <windows.h>
@@ -15,7 +16,7 @@ namespace
     }
 }
 
-void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+void AudioEngine::getNextAudioBlockAtEngineRate (const juce::AudioSourceChannelInfo& bufferToFill)
 {
     const auto lifecycle = convo::consumeAtomic(lifecycleState, std::memory_order_acquire);
     if (lifecycle != EngineLifecycleState::Prepared)
@@ -67,11 +68,13 @@ void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferT
         AudioEngine& engine;
         convo::isr::LifecycleToken lifecycleToken;
         convo::isr::FirewallToken firewallToken;
+        convo::RtSafetyGuard::CallbackScope rtGuard;   // --rt-guard: このスコープの間の確保・ロックを記録
 
-        explicit AudioCallbackRuntimeScope(AudioEngine& owner) noexcept
+        AudioCallbackRuntimeScope(AudioEngine& owner, uint64_t callbackIndex) noexcept
             : engine(owner)
             , lifecycleToken(owner.lifecycleRuntime_.enterAudioCallback())
             , firewallToken(owner.rtCapabilityFirewall_.enter())
+            , rtGuard(callbackIndex)
         {
             convo::isr::RTAllocatorFirewall::markRTContext(true);
             (void)convo::fetchAddAtomic(engine.rtLocalState_.audioCallbackActiveCount, uint32_t{1}, std::memory_order_acq_rel);
@@ -84,7 +87,7 @@ void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferT
             engine.rtCapabilityFirewall_.leave(firewallToken);
             engine.lifecycleRuntime_.leaveAudioCallback(lifecycleToken);
         }
-    } runtimeScope(*this);
+    } runtimeScope(*this, thisCallbackIndex);
 
     const juce::ScopedNoDenormals noDenormals;
     const convo::numeric_policy::ScopedThreadRole audioThreadScope(convo::numeric_policy::ThreadRole::AudioRealtime);
@@ -107,28 +110,45 @@ void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferT
         int samples;
         bool enabled;
         uint64_t startUs;
+        uint64_t loadStartUs;
+        uint64_t callbackIndex;
+        bool etwEnabled;
+        convo::XrunIncidentCorrelator::CallbackMark xrunMark;
 
         CallbackTelemetryScope(AudioEngine& owner, int numSamplesIn,
-                                uint64_t cbStartUs) noexcept
+                                uint64_t cbStartUs, uint64_t cbIndex) noexcept
             : engine(owner)
             , samples(numSamplesIn)
             , enabled(owner.isCliProcessingTelemetryEnabled())
             , startUs(enabled ? cbStartUs : 0)
+            , loadStartUs(cbStartUs)
+            , callbackIndex(cbIndex)
+            , etwEnabled(convo::EtwTrace::isEnabled(convo::EtwTrace::kCallback))
+            , xrunMark(owner.beginXrunCorrelation(cbStartUs))
         {
+            if (etwEnabled)
+                convo::EtwTrace::callbackBegin(callbackIndex, samples);
         }
 
         ~CallbackTelemetryScope() noexcept
         {
+            const uint64_t endUs = convo::getCurrentTimeUs();
+            // ★ callback 負荷は telemetry 設定に関わらず常に記録（負荷適応クロスフェードの入力）
+            engine.recordCallbackLoad(loadStartUs, endUs);
+            engine.endXrunCorrelation(xrunMark, callbackIndex, endUs);
+            // ★ UI 観測スナップショットは早期 return を含むすべての出口で 1 回だけ publish
+            engine.publishAudioObservation(callbackIndex);
+            if (etwEnabled)
+                convo::EtwTrace::callbackEnd(callbackIndex, endUs > loadStartUs ? endUs - loadStartUs : 0);
             if (!enabled)
                 return;
 
-            const uint64_t endUs = convo::getCurrentTimeUs();
             const uint64_t processTime = (endUs > startUs) ? (endUs - startUs) : 0;
 
             const double processTimeUs = static_cast<double>(processTime);
             engine.recordAudioCallbackProcessingStats(samples, processTimeUs);
         }
-    } callbackTelemetry(*this, numSamples, cbStartUs);
+    } callbackTelemetry(*this, numSamples, cbStartUs, thisCallbackIndex);
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
     // ★ work60: DSP_STAGE計測用タイムスタンプ。dsp->process()前後で設定。
@@ -292,6 +312,8 @@ void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferT
     rtTraceRelay_.enqueue({ rtFrame.sampleCursor, 0xA001u, static_cast<std::uint32_t>(numSamples) });
 
     DSPCore* dsp = resolveActiveRuntimeDSPFromRuntimeWorldOnly(runtimeReadHandleRef);
+    // 実際に DSPCore を通したサンプル数 (固定長リブロック中は内部ブロックの倍数)
+    int dspSamplesProcessed = numSamples;
     if (dsp == nullptr)
     {
         bufferToFill.clearActiveBufferRegion();
@@ -300,10 +322,20 @@ void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferT
 
     if (dsp != nullptr)
     {
+        DSPCore* fading = resolveFadingRuntimeDSPFromRuntimeWorldOnly(runtimeReadHandleRef);
+
+        // double 経路と同じく EQ / Convolver の RCU reader をコールバック単位で固定する
+        convo::CallbackReaderScope callbackReaders(convo::makeAudioReaderContext(audioThreadRcuReader));
+        dsp->pinReadersForCallback(callbackReaders);
+        if (fading != nullptr && fading != dsp)
+            fading->pinReadersForCallback(callbackReaders);
+
+        const bool reblock = updateFixedBlockReblockState(fixedBlockReblockerFloat, numSamples, dsp, fading);
+
         // DSPCore 固有の上限チェック
         // DSPCore::prepare() でホスト指定の samplesPerBlock を反映した maxSamplesPerBlock が設定される。
         // dsp は RCU で公開済みのため maxSamplesPerBlock は Audio Thread から安全に読み出せる。
-        if (numSamples > dsp->maxSamplesPerBlock)
+        if (!reblock && numSamples > dsp->maxSamplesPerBlock)
         {
             bufferToFill.clearActiveBufferRegion();
             return;
@@ -324,141 +356,187 @@ void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferT
             return;
         }
 
-        // パラメータのロード
-        // 【Parameter安全設計】
-        // Audio ThreadではAtomic変数の読み取りのみを行い、ロックやメモリ確保を伴う処理は行わない。
-        // 構造変更が必要な場合は、別途フラグやUIスレッド経由で再構築を行う。
-        // ── Audio Thread authority: RuntimeWorld 由来のスナップショットを使用 ──
-        const EngineParameterSnapshot parameterSnapshot = captureAudioThreadParameterSnapshot(runtimeWorld);
-
-        DSPCore::ProcessingState procState = buildAudioThreadProcessingState(dsp, parameterSnapshot);
-
-        DSPCore* fading = resolveFadingRuntimeDSPFromRuntimeWorldOnly(runtimeReadHandleRef);
-        const auto& preparedCrossfade = authority.preparedCrossfade;
-        bool useDryAsOld = preparedCrossfade.useDryAsOld || preparedCrossfade.firstIrDryCrossfadePending;
-
-        if (processCrossfadeDelayGateIfPending(fading,
-                                               useDryAsOld,
-                                               preparedCrossfade,
-                                               [&]()
-        {
-            auto fadingState = procState;
-            fadingState.analyzerEnabled = false;
-            fadingState.adaptiveCaptureQueue = nullptr;
-
-            fading->process(bufferToFill,
-                            analyzerFifo,
-                            nullptr,
-                            nullptr,
-                            fadingState);
-        }))
+        // 1 ブロック分の DSP 処理 (リブロック中は内部ブロックごとに呼ぶ)。
+        // クロスフェード開始待ちゲートがブロックを消費したら false
+        const auto processDspBlock = [&](const juce::AudioSourceChannelInfo& blockInfo) -> bool
         {
-            return;
-        }
+            auto* blockBuffer = blockInfo.buffer;
+            const int blockStart = blockInfo.startSample;
+            const int blockSamples = blockInfo.numSamples;
+
+            // パラメータのロード
+            // 【Parameter安全設計】
+            // Audio ThreadではAtomic変数の読み取りのみを行い、ロックやメモリ確保を伴う処理は行わない。
+            // 構造変更が必要な場合は、別途フラグやUIスレッド経由で再構築を行う。
+            // ── Audio Thread authority: RuntimeWorld 由来のスナップショットを使用 ──
+            const EngineParameterSnapshot parameterSnapshot = captureAudioThreadParameterSnapshot(runtimeWorld);
+
+            DSPCore::ProcessingState procState = buildAudioThreadProcessingState(dsp, parameterSnapshot);
+
+            const auto& preparedCrossfade = authority.preparedCrossfade;
+            bool useDryAsOld = preparedCrossfade.useDryAsOld || preparedCrossfade.firstIrDryCrossfadePending;
+
+            if (processCrossfadeDelayGateIfPending(fading,
+                                                   useDryAsOld,
+                                                   preparedCrossfade,
+                                                   [&]()
+            {
+                auto fadingState = procState;
+                fadingState.analyzerEnabled = false;
+                fadingState.adaptiveCaptureQueue = nullptr;
+                fadingState.stageLatency = nullptr;
+                fadingState.meteringTap = nullptr;
+
+                fading->process(blockInfo,
+                                analyzerFifo,
+                                nullptr,
+                                nullptr,
+                                fadingState);
+            }))
+            {
+                return false;
+            }
 
-        armCrossfadeIfPending(fading != nullptr, useDryAsOld, preparedCrossfade);
+            armCrossfadeIfPending(fading != nullptr, useDryAsOld, preparedCrossfade);
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-    // work60: dsp->process()直前にcallbackSeq/cpuをDSPCoreとConvolverProcessorへ伝達
-    dsp->currentCallbackSeq = convo::consumeAtomic(rtLocalState_.audioCallbackEpochCounter, std::memory_order_relaxed);
-    dsp->currentCpu = convo::consumeAtomic(rtLocalState_.lastCallbackProcessor, std::memory_order_relaxed);
-    dsp->convolver.currentCallbackSeq.store(dsp->currentCallbackSeq, std::memory_order_relaxed);
-    dsp->convolver.currentCpu.store(dsp->currentCpu, std::memory_order_relaxed);
-    // work60: DSP_STAGE開始時刻。armCrossfade後、dsp->process()直前。
-    t1_dspStartUs = convo::getCurrentTimeUs();
+        // work60: dsp->process()直前にcallbackSeq/cpuをDSPCoreとConvolverProcessorへ伝達
+        dsp->currentCallbackSeq = convo::consumeAtomic(rtLocalState_.audioCallbackEpochCounter, std::memory_order_relaxed);
+        dsp->currentCpu = convo::consumeAtomic(rtLocalState_.lastCallbackProcessor, std::memory_order_relaxed);
+        dsp->convolver.currentCallbackSeq.store(dsp->currentCallbackSeq, std::memory_order_relaxed);
+        dsp->convolver.currentCpu.store(dsp->currentCpu, std::memory_order_relaxed);
+        // work60: DSP_STAGE開始時刻。armCrossfade後、dsp->process()直前。
+        t1_dspStartUs = convo::getCurrentTimeUs();
 #endif
 
-        const bool canCrossfade = (fading != nullptr || useDryAsOld)
-            && crossfadeRuntime_.getGain().isSmoothing()
-            && dspCrossfadeFloatBuffer.getNumChannels() >= 2
-            && dspCrossfadeFloatBuffer.getNumSamples() >= numSamples;
-
-        if (canCrossfade)
-        {
-            juce::AudioSourceChannelInfo fadeInfo(&dspCrossfadeFloatBuffer, 0, numSamples);
-            dspCrossfadeFloatBuffer.clear(0, 0, numSamples);
-            dspCrossfadeFloatBuffer.clear(1, 0, numSamples);
-
-            auto fadingState = procState;
-            fadingState.analyzerEnabled = false;
-            fadingState.adaptiveCaptureQueue = nullptr;
+            const bool canCrossfade = (fading != nullptr || useDryAsOld)
+                && crossfadeRuntime_.getGain().isSmoothing()
+                && dspCrossfadeFloatBuffer.getNumChannels() >= 2
+                && dspCrossfadeFloatBuffer.getNumSamples() >= blockSamples;
 
-            if (useDryAsOld)
+            if (canCrossfade
+                && prepareConvolverStageCrossfadeRT(dsp, fading, useDryAsOld, preparedCrossfade, blockSamples, procState))
             {
-                const int outChannels = std::min(2, buffer->getNumChannels());
-                if (outChannels > 0)
-                    juce::FloatVectorOperations::copy(dspCrossfadeFloatBuffer.getWritePointer(0, 0), buffer->getReadPointer(0, startSample), numSamples);
-                if (outChannels > 1)
-                    juce::FloatVectorOperations::copy(dspCrossfadeFloatBuffer.getWritePointer(1, 0), buffer->getReadPointer(1, startSample), numSamples);
+                // 旧 DSPCore は Convolver 段のみ並走し、ミックスも段内で済む
+                dsp->process(blockInfo,
+                             analyzerFifo,
+                             &inputLevelLinear,
+                             &outputLevelLinear,
+                             procState);
+                finalizeCrossfadeMixPath(dsp, fading, false);
             }
-            else
+            else if (canCrossfade)
             {
-                // EBR: lifetime managed by RCUReader
-                fading->processToBuffer(bufferToFill, dspCrossfadeFloatBuffer, analyzerFifo,
-                                       nullptr, nullptr, fadingState);
+                juce::AudioSourceChannelInfo fadeInfo(&dspCrossfadeFloatBuffer, 0, blockSamples);
+                dspCrossfadeFloatBuffer.clear(0, 0, blockSamples);
+                dspCrossfadeFloatBuffer.clear(1, 0, blockSamples);
+
+                auto fadingState = procState;
+                fadingState.analyzerEnabled = false;
+                fadingState.adaptiveCaptureQueue = nullptr;
+                fadingState.stageLatency = nullptr;
+                fadingState.meteringTap = nullptr;
+
+                if (useDryAsOld)
+                {
+                    const int outChannels = std::min(2, blockBuffer->getNumChannels());
+                    if (outChannels > 0)
+                        juce::FloatVectorOperations::copy(dspCrossfadeFloatBuffer.getWritePointer(0, 0), blockBuffer->getReadPointer(0, blockStart), blockSamples);
+                    if (outChannels > 1)
+                        juce::FloatVectorOperations::copy(dspCrossfadeFloatBuffer.getWritePointer(1, 0), blockBuffer->getReadPointer(1, blockStart), blockSamples);
+                }
+                else
+                {
+                    // EBR: lifetime managed by RCUReader
+                    fading->processToBuffer(blockInfo, dspCrossfadeFloatBuffer, analyzerFifo,
+                                           nullptr, nullptr, fadingState);
+                }
+                dsp->process(blockInfo,
+                             analyzerFifo,
+                             &inputLevelLinear,
+                             &outputLevelLinear,
+                             procState);
+
+                const int outChannels = std::min(2, blockBuffer->getNumChannels());
+                float* dstL = (outChannels > 0) ? blockBuffer->getWritePointer(0, blockStart) : nullptr;
+                float* dstR = (outChannels > 1) ? blockBuffer->getWritePointer(1, blockStart) : nullptr;
+                const float* oldL = (outChannels > 0) ? dspCrossfadeFloatBuffer.getReadPointer(0, 0) : nullptr;
+                const float* oldR = (outChannels > 1) ? dspCrossfadeFloatBuffer.getReadPointer(1, 0) : nullptr;
+
+                runLatencyAlignedCrossfadeMixLoop<float>(dstL,
+                                                         dstR,
+                                                         oldL,
+                                                         oldR,
+                                                         blockSamples,
+                                                         preparedCrossfade.latencyDelayOld,
+                                                         preparedCrossfade.latencyDelayNew,
+                                                         preparedCrossfade.latencyResetPending,
+                                                         [this, useDryAsOld](float* outL,
+                                                                             float* outR,
+                                                                             int i,
+                                                                             double gNew,
+                                                                             double alignedOldL,
+                                                                             double alignedOldR,
+                                                                             double alignedNewL,
+                                                                             double alignedNewR)
+                                                         {
+                                                             const double dryScale = useDryAsOld ? crossfadeRuntime_.getDryScaleGain().getNextValue() : 1.0;
+                                                             const double gOld = 1.0 - gNew;
+                                                             const double dryScaledL = alignedOldL * dryScale;
+                                                             const double dryScaledR = alignedOldR * dryScale;
+                                                             if (outL != nullptr)
+                                                                 outL[i] = static_cast<float>(alignedNewL * gNew + dryScaledL * gOld);
+                                                             if (outR != nullptr)
+                                                                 outR[i] = static_cast<float>(alignedNewR * gNew + dryScaledR * gOld);
+                                                         });
+
+                if (!useDryAsOld)
+                {
+                    // EBR: fading lifetime managed by RCUReaderGuard
+                }
+
+                finalizeCrossfadeMixPath(dsp, fading, true);
             }
-            dsp->process(bufferToFill,
-                         analyzerFifo,
-                         &inputLevelLinear,
-                         &outputLevelLinear,
-                         procState);
-
-            const int outChannels = std::min(2, buffer->getNumChannels());
-            float* dstL = (outChannels > 0) ? buffer->getWritePointer(0, startSample) : nullptr;
-            float* dstR = (outChannels > 1) ? buffer->getWritePointer(1, startSample) : nullptr;
-            const float* oldL = (outChannels > 0) ? dspCrossfadeFloatBuffer.getReadPointer(0, 0) : nullptr;
-            const float* oldR = (outChannels > 1) ? dspCrossfadeFloatBuffer.getReadPointer(1, 0) : nullptr;
-
-            runLatencyAlignedCrossfadeMixLoop<float>(dstL,
-                                                     dstR,
-                                                     oldL,
-                                                     oldR,
-                                                     numSamples,
-                                                     preparedCrossfade.latencyDelayOld,
-                                                     preparedCrossfade.latencyDelayNew,
-                                                     preparedCrossfade.latencyResetPending,
-                                                     [this, useDryAsOld](float* outL,
-                                                                         float* outR,
-                                                                         int i,
-                                                                         double gNew,
-                                                                         double alignedOldL,
-                                                                         double alignedOldR,
-                                                                         double alignedNewL,
-                                                                         double alignedNewR)
-                                                     {
-                                                         const double dryScale = useDryAsOld ? crossfadeRuntime_.getDryScaleGain().getNextValue() : 1.0;
-                                                         const double gOld = 1.0 - gNew;
-                                                         const double dryScaledL = alignedOldL * dryScale;
-                                                         const double dryScaledR = alignedOldR * dryScale;
-                                                         if (outL != nullptr)
-                                                             outL[i] = static_cast<float>(alignedNewL * gNew + dryScaledL * gOld);
-                                                         if (outR != nullptr)
-                                                             outR[i] = static_cast<float>(alignedNewR * gNew + dryScaledR * gOld);
-                                                     });
-
-            if (!useDryAsOld)
+            else
             {
-                // EBR: fading lifetime managed by RCUReaderGuard
+                // 通常パス（クロスフェードなし）：RCU で dsp の生存が保証されるため addRef/release 不要
+                dsp->process(blockInfo,
+                             analyzerFifo,
+                             &inputLevelLinear,
+                             &outputLevelLinear,
+                             procState);
+                cleanupCrossfadeDirectPath(dsp, fading);
             }
 
-            finalizeCrossfadeMixPath(dsp, fading, true);
+            return true;
+        };
+
+        if (!reblock)
+        {
+            if (!processDspBlock(bufferToFill))
+                return;
         }
         else
         {
-            // 通常パス（クロスフェードなし）：RCU で dsp の生存が保証されるため addRef/release 不要
-            dsp->process(bufferToFill,
-                         analyzerFifo,
-                         &inputLevelLinear,
-                         &outputLevelLinear,
-                         procState);
-            cleanupCrossfadeDirectPath(dsp, fading);
+            float* deviceChannels[convo::FixedBlockReblocker<float>::kMaxChannels] = {};
+            const int deviceChannelCount = std::min(convo::FixedBlockReblocker<float>::kMaxChannels, buffer->getNumChannels());
+            for (int ch = 0; ch < deviceChannelCount; ++ch)
+                deviceChannels[ch] = buffer->getWritePointer(ch, startSample);
+
+            dspSamplesProcessed = std::max(0, fixedBlockReblockerFloat.process(deviceChannels, deviceChannelCount, numSamples,
+                [&](float* const* blockChannels, int blockSamples)
+                {
+                    // 外部メモリ参照の AudioBuffer はチャンネルポインタを内部に持つため確保しない
+                    juce::AudioBuffer<float> blockBuffer(blockChannels, fixedBlockReblockerFloat.getNumChannels(), blockSamples);
+                    static_cast<void>(processDspBlock(juce::AudioSourceChannelInfo(&blockBuffer, 0, blockSamples)));
+                }));
         }
     }
 
     // ★ work70 P1-b: SnapshotCoordinator の fade 進行。remaining を処理済みサンプル数だけ進める。
     //   DSP 処理完了直後（Audio callback 終了直前）。advanceFade はカウンタ減算のみ。
     //   Timer 側の tryCompleteFade() は別途動作。
-    m_coordinator.advanceFade(numSamples);
+    m_coordinator.advanceFade(dspSamplesProcessed);
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
     // ★ work60: DSP_STAGE終了時刻（t2）。dsp->process() 完了直後。
@@ -6,6 +6,7 @@
 #include "NoiseShaperLearner.h"
 #include "core/RCUReader.h"
 #include "core/TimeUtils.h"
+#include "EtwTrace.h"
 
 namespace
 {
@@ -15,7 +16,7 @@ namespace
     }
 }
 
-void AudioEngine::processBlockDouble (juce::AudioBuffer<double>& buffer)
+void AudioEngine::processBlockDoubleAtEngineRate (juce::AudioBuffer<double>& buffer)
 {
     const auto lifecycle = convo::consumeAtomic(lifecycleState, std::memory_order_acquire);
     if (lifecycle != EngineLifecycleState::Prepared)
@@ -69,11 +70,13 @@ void AudioEngine::processBlockDouble (juce::AudioBuffer<double>& buffer)
         AudioEngine& engine;
         convo::isr::LifecycleToken lifecycleToken;
         convo::isr::FirewallToken firewallToken;
+        convo::RtSafetyGuard::CallbackScope rtGuard;   // --rt-guard: このスコープの間の確保・ロックを記録
 
-        explicit AudioCallbackRuntimeScope(AudioEngine& owner) noexcept
+        AudioCallbackRuntimeScope(AudioEngine& owner, uint64_t callbackIndex) noexcept
             : engine(owner)
             , lifecycleToken(owner.lifecycleRuntime_.enterAudioCallback())
             , firewallToken(owner.rtCapabilityFirewall_.enter())
+            , rtGuard(callbackIndex)
         {
             convo::isr::RTAllocatorFirewall::markRTContext(true);
             (void)convo::fetchAddAtomic(engine.rtLocalState_.audioCallbackActiveCount, uint32_t{1}, std::memory_order_acq_rel);
@@ -86,7 +89,7 @@ void AudioEngine::processBlockDouble (juce::AudioBuffer<double>& buffer)
             engine.rtCapabilityFirewall_.leave(firewallToken);
             engine.lifecycleRuntime_.leaveAudioCallback(lifecycleToken);
         }
-    } runtimeScope(*this);
+    } runtimeScope(*this, thisCallbackIndex);
 
     const juce::ScopedNoDenormals noDenormals;
     const convo::numeric_policy::ScopedThreadRole audioThreadScope(convo::numeric_policy::ThreadRole::AudioRealtime);
@@ -101,27 +104,44 @@ void AudioEngine::processBlockDouble (juce::AudioBuffer<double>& buffer)
         int samples;
         bool enabled;
         uint64_t startUs;
+        uint64_t loadStartUs;
+        uint64_t callbackIndex;
+        bool etwEnabled;
+        convo::XrunIncidentCorrelator::CallbackMark xrunMark;
 
         CallbackTelemetryScope(AudioEngine& owner, int numSamplesIn,
-                                uint64_t cbStartUs) noexcept
+                                uint64_t cbStartUs, uint64_t cbIndex) noexcept
             : engine(owner)
             , samples(numSamplesIn)
             , enabled(owner.isCliProcessingTelemetryEnabled())
             , startUs(enabled ? cbStartUs : 0)
+            , loadStartUs(cbStartUs)
+            , callbackIndex(cbIndex)
+            , etwEnabled(convo::EtwTrace::isEnabled(convo::EtwTrace::kCallback))
+            , xrunMark(owner.beginXrunCorrelation(cbStartUs))
         {
+            if (etwEnabled)
+                convo::EtwTrace::callbackBegin(callbackIndex, samples);
         }
 
         ~CallbackTelemetryScope() noexcept
         {
+            const uint64_t endUs = convo::getCurrentTimeUs();
+            // ★ callback 負荷は telemetry 設定に関わらず常に記録（負荷適応クロスフェードの入力）
+            engine.recordCallbackLoad(loadStartUs, endUs);
+            engine.endXrunCorrelation(xrunMark, callbackIndex, endUs);
+            // ★ UI 観測スナップショットは早期 return を含むすべての出口で 1 回だけ publish
+            engine.publishAudioObservation(callbackIndex);
+            if (etwEnabled)
+                convo::EtwTrace::callbackEnd(callbackIndex, endUs > loadStartUs ? endUs - loadStartUs : 0);
             if (!enabled)
                 return;
 
-            const uint64_t endUs = convo::getCurrentTimeUs();
             const uint64_t processTime = (endUs > startUs) ? (endUs - startUs) : 0;
             const double processTimeUs = static_cast<double>(processTime);
             engine.recordAudioCallbackProcessingStats(samples, processTimeUs);
         }
-    } callbackTelemetry(*this, numSamples, cbStartUs);
+    } callbackTelemetry(*this, numSamples, cbStartUs, thisCallbackIndex);
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
     // ★ work60: DSP_STAGE計測用タイムスタンプ
@@ -280,13 +300,28 @@ void AudioEngine::processBlockDouble (juce::AudioBuffer<double>& buffer)
         }
     #endif
 
-    // --- ProcessingStateを現行設計で初期化 ---
-    const EngineParameterSnapshot parameterSnapshot = captureAudioThreadParameterSnapshot(runtimeWorld);
+    // --- クロスフェード開始時: スナップショット取得・RT競合ゼロ設計 ---
+    DSPCore* fading = resolveFadingRuntimeDSPFromRuntimeWorldOnly(runtimeReadHandleRef);
+    const auto& preparedCrossfade = authority.preparedCrossfade;
+    bool useDryAsOld = preparedCrossfade.useDryAsOld || preparedCrossfade.firstIrDryCrossfadePending;
+    if (fading != nullptr && fading == dsp)
+    {
+        jassertfalse; // ★ [P0-3] Release: フォールバックで安全
+        fading = nullptr;
+        useDryAsOld = true;
+    }
+
+    // EQ / Convolver の RCU reader はここで 1 回だけ固定する (リブロックの内部ブロック・旧 DSPCore の処理も
+    // この区間に入る)。runtimeReadHandle より後に構築するので先に外れる
+    convo::CallbackReaderScope callbackReaders(audioCtx);
+    dsp->pinReadersForCallback(callbackReaders);
+    if (fading != nullptr)
+        fading->pinReadersForCallback(callbackReaders);
 
-    DSPCore::ProcessingState procState = buildAudioThreadProcessingState(dsp, parameterSnapshot);
+    const bool reblock = updateFixedBlockReblockState(fixedBlockReblockerDouble, numSamples, dsp, fading);
 
-    // DSPCore 固有の上限チェック (getNextAudioBlock と同様)
-    if (numSamples > dsp->maxSamplesPerBlock)
+    // DSPCore 固有の上限チェック (getNextAudioBlock と同様。リブロック中は内部ブロックで判定済み)
+    if (!reblock && numSamples > dsp->maxSamplesPerBlock)
     {
         buffer.clear();
         return;
@@ -304,126 +339,166 @@ void AudioEngine::processBlockDouble (juce::AudioBuffer<double>& buffer)
         return;
     }
 
-    // --- クロスフェード開始時: スナップショット取得・RT競合ゼロ設計 ---
-    DSPCore* fading = resolveFadingRuntimeDSPFromRuntimeWorldOnly(runtimeReadHandleRef);
-    const auto& preparedCrossfade = authority.preparedCrossfade;
-    bool useDryAsOld = preparedCrossfade.useDryAsOld || preparedCrossfade.firstIrDryCrossfadePending;
-    if (fading != nullptr && fading == dsp)
+    // 1 ブロック分の DSP 処理 (リブロック中は内部ブロックごとに呼ぶ)。
+    // クロスフェード開始待ちゲートがブロックを消費したら false
+    const auto processDspBlock = [&](juce::AudioBuffer<double>& blockBuffer) -> bool
     {
-        jassertfalse; // ★ [P0-3] Release: フォールバックで安全
-        fading = nullptr;
-        useDryAsOld = true;
-    }
-    if (processCrossfadeDelayGateIfPending(fading,
-                                           useDryAsOld,
-                                           preparedCrossfade,
-                                           [&]()
-    {
-        auto fadingState = procState;
-        fadingState.analyzerEnabled = false;
-        fadingState.adaptiveCaptureQueue = nullptr;
-
-        fading->processDouble(buffer,
-                      analyzerFifo,
-                      nullptr,
-                      nullptr,
-                      fadingState);
-    }))
-    {
-        return;
-    }
+        const int blockSamples = blockBuffer.getNumSamples();
 
-    armCrossfadeIfPending(fading != nullptr, useDryAsOld, preparedCrossfade);
+        // --- ProcessingStateを現行設計で初期化 ---
+        const EngineParameterSnapshot parameterSnapshot = captureAudioThreadParameterSnapshot(runtimeWorld);
 
-#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-    // work60: dsp->process()直前にcallbackSeq/cpuをDSPCoreとConvolverProcessorへ伝達
-    dsp->currentCallbackSeq = convo::consumeAtomic(rtLocalState_.audioCallbackEpochCounter, std::memory_order_relaxed);
-    dsp->currentCpu = convo::consumeAtomic(rtLocalState_.lastCallbackProcessor, std::memory_order_relaxed);
-    dsp->convolver.currentCallbackSeq.store(dsp->currentCallbackSeq, std::memory_order_relaxed);
-    dsp->convolver.currentCpu.store(dsp->currentCpu, std::memory_order_relaxed);
-    // work60: DSP_STAGE開始時刻
-    t1_dspStartUs = convo::getCurrentTimeUs();
-#endif
+        DSPCore::ProcessingState procState = buildAudioThreadProcessingState(dsp, parameterSnapshot);
 
-    const bool canCrossfade = (fading != nullptr || useDryAsOld)
-        && crossfadeRuntime_.getGain().isSmoothing()
-        && dspCrossfadeDoubleBuffer.getNumChannels() >= 2
-        && dspCrossfadeDoubleBuffer.getNumSamples() >= numSamples;
+        if (processCrossfadeDelayGateIfPending(fading,
+                                               useDryAsOld,
+                                               preparedCrossfade,
+                                               [&]()
+        {
+            auto fadingState = procState;
+            fadingState.analyzerEnabled = false;
+            fadingState.adaptiveCaptureQueue = nullptr;
+            fadingState.stageLatency = nullptr;
+            fadingState.meteringTap = nullptr;
+
+            fading->processDouble(blockBuffer,
+                          analyzerFifo,
+                          nullptr,
+                          nullptr,
+                          fadingState);
+        }))
+        {
+            return false;
+        }
 
-    if (canCrossfade)
-    {
-        // --- wrap安全・スナップショット設計 ---
-        dspCrossfadeDoubleBuffer.clear(0, 0, numSamples);
-        dspCrossfadeDoubleBuffer.clear(1, 0, numSamples);
+        armCrossfadeIfPending(fading != nullptr, useDryAsOld, preparedCrossfade);
 
-        auto fadingState = procState;
-        fadingState.analyzerEnabled = false;
-        fadingState.adaptiveCaptureQueue = nullptr;
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+        // work60: dsp->process()直前にcallbackSeq/cpuをDSPCoreとConvolverProcessorへ伝達
+        dsp->currentCallbackSeq = convo::consumeAtomic(rtLocalState_.audioCallbackEpochCounter, std::memory_order_relaxed);
+        dsp->currentCpu = convo::consumeAtomic(rtLocalState_.lastCallbackProcessor, std::memory_order_relaxed);
+        dsp->convolver.currentCallbackSeq.store(dsp->currentCallbackSeq, std::memory_order_relaxed);
+        dsp->convolver.currentCpu.store(dsp->currentCpu, std::memory_order_relaxed);
+        // work60: DSP_STAGE開始時刻
+        t1_dspStartUs = convo::getCurrentTimeUs();
+#endif
+
+        const bool canCrossfade = (fading != nullptr || useDryAsOld)
+            && crossfadeRuntime_.getGain().isSmoothing()
+            && dspCrossfadeDoubleBuffer.getNumChannels() >= 2
+            && dspCrossfadeDoubleBuffer.getNumSamples() >= blockSamples;
 
-        if (useDryAsOld)
+        if (canCrossfade
+            && prepareConvolverStageCrossfadeRT(dsp, fading, useDryAsOld, preparedCrossfade, blockSamples, procState))
         {
-            const int outChannels = std::min(2, buffer.getNumChannels());
-            if (outChannels > 0)
-                juce::FloatVectorOperations::copy(dspCrossfadeDoubleBuffer.getWritePointer(0, 0), buffer.getReadPointer(0, 0), numSamples);
-            if (outChannels > 1)
-                juce::FloatVectorOperations::copy(dspCrossfadeDoubleBuffer.getWritePointer(1, 0), buffer.getReadPointer(1, 0), numSamples);
+            // 旧 DSPCore は Convolver 段のみ並走し、ミックスも段内で済む
+            dsp->processDouble(blockBuffer,
+                               analyzerFifo,
+                               &inputLevelLinear,
+                               &outputLevelLinear,
+                               procState);
+            finalizeCrossfadeMixPath(dsp, fading, false);
         }
-        else
+        else if (canCrossfade)
         {
-            // EBR: managed by RCUReader
-            fading->processDoubleToBuffer(buffer, dspCrossfadeDoubleBuffer, analyzerFifo,
-                                          nullptr, nullptr, fadingState);
+            // --- wrap安全・スナップショット設計 ---
+            dspCrossfadeDoubleBuffer.clear(0, 0, blockSamples);
+            dspCrossfadeDoubleBuffer.clear(1, 0, blockSamples);
+
+            auto fadingState = procState;
+            fadingState.analyzerEnabled = false;
+            fadingState.adaptiveCaptureQueue = nullptr;
+            fadingState.stageLatency = nullptr;
+            fadingState.meteringTap = nullptr;
+
+            if (useDryAsOld)
+            {
+                const int outChannels = std::min(2, blockBuffer.getNumChannels());
+                if (outChannels > 0)
+                    juce::FloatVectorOperations::copy(dspCrossfadeDoubleBuffer.getWritePointer(0, 0), blockBuffer.getReadPointer(0, 0), blockSamples);
+                if (outChannels > 1)
+                    juce::FloatVectorOperations::copy(dspCrossfadeDoubleBuffer.getWritePointer(1, 0), blockBuffer.getReadPointer(1, 0), blockSamples);
+            }
+            else
+            {
+                // EBR: managed by RCUReader
+                fading->processDoubleToBuffer(blockBuffer, dspCrossfadeDoubleBuffer, analyzerFifo,
+                                              nullptr, nullptr, fadingState);
+            }
+            dsp->processDouble(blockBuffer,
+                       analyzerFifo,
+                       &inputLevelLinear,
+                       &outputLevelLinear,
+                       procState);
+
+            // スナップショット（commitNewDSPでセット済み、ここでは読み取り専用）
+            const int outChannels = std::min(2, blockBuffer.getNumChannels());
+            double* dstL = (outChannels > 0) ? blockBuffer.getWritePointer(0, 0) : nullptr;
+            double* dstR = (outChannels > 1) ? blockBuffer.getWritePointer(1, 0) : nullptr;
+            const double* oldL = (outChannels > 0) ? dspCrossfadeDoubleBuffer.getReadPointer(0, 0) : nullptr;
+            const double* oldR = (outChannels > 1) ? dspCrossfadeDoubleBuffer.getReadPointer(1, 0) : nullptr;
+
+            runLatencyAlignedCrossfadeMixLoop<double>(dstL,
+                                                      dstR,
+                                                      oldL,
+                                                      oldR,
+                                                      blockSamples,
+                                                                      preparedCrossfade.latencyDelayOld,
+                                                                      preparedCrossfade.latencyDelayNew,
+                                                                      preparedCrossfade.latencyResetPending,
+                                                      [](double* outL,
+                                                         double* outR,
+                                                         int i,
+                                                         double gNew,
+                                                         double alignedOldL,
+                                                         double alignedOldR,
+                                                         double alignedNewL,
+                                                         double alignedNewR)
+                                                      {
+                                                          const double gOld = 1.0 - gNew;
+                                                          if (outL != nullptr) outL[i] = alignedNewL * gNew + alignedOldL * gOld;
+                                                          if (outR != nullptr) outR[i] = alignedNewR * gNew + alignedOldR * gOld;
+                                                      });
+            if (!useDryAsOld)
+            {
+                // EBR: managed by RCUReader
+            }
+
+            finalizeCrossfadeMixPath(dsp, fading, false);
         }
-        dsp->processDouble(buffer,
-                   analyzerFifo,
-                   &inputLevelLinear,
-                   &outputLevelLinear,
-                   procState);
-
-        // スナップショット（commitNewDSPでセット済み、ここでは読み取り専用）
-        const int outChannels = std::min(2, buffer.getNumChannels());
-        double* dstL = (outChannels > 0) ? buffer.getWritePointer(0, 0) : nullptr;
-        double* dstR = (outChannels > 1) ? buffer.getWritePointer(1, 0) : nullptr;
-        const double* oldL = (outChannels > 0) ? dspCrossfadeDoubleBuffer.getReadPointer(0, 0) : nullptr;
-        const double* oldR = (outChannels > 1) ? dspCrossfadeDoubleBuffer.getReadPointer(1, 0) : nullptr;
-
-        runLatencyAlignedCrossfadeMixLoop<double>(dstL,
-                                                  dstR,
-                                                  oldL,
-                                                  oldR,
-                                                  numSamples,
-                                                                  preparedCrossfade.latencyDelayOld,
-                                                                  preparedCrossfade.latencyDelayNew,
-                                                                  preparedCrossfade.latencyResetPending,
-                                                  [](double* outL,
-                                                     double* outR,
-                                                     int i,
-                                                     double gNew,
-                                                     double alignedOldL,
-                                                     double alignedOldR,
-                                                     double alignedNewL,
-                                                     double alignedNewR)
-                                                  {
-                                                      const double gOld = 1.0 - gNew;
-                                                      if (outL != nullptr) outL[i] = alignedNewL * gNew + alignedOldL * gOld;
-                                                      if (outR != nullptr) outR[i] = alignedNewR * gNew + alignedOldR * gOld;
-                                                  });
-        if (!useDryAsOld)
+        else
         {
-            // EBR: managed by RCUReader
+            dsp->processDouble(blockBuffer,
+                               analyzerFifo,
+                               &inputLevelLinear,
+                               &outputLevelLinear,
+                               procState);
+
+            cleanupCrossfadeDirectPath(dsp, fading);
         }
 
-        finalizeCrossfadeMixPath(dsp, fading, false);
+        return true;
+    };
+
+    if (!reblock)
+    {
+        if (!processDspBlock(buffer))
+            return;
     }
     else
     {
-        dsp->processDouble(buffer,
-                           analyzerFifo,
-                           &inputLevelLinear,
-                           &outputLevelLinear,
-                           procState);
+        double* deviceChannels[convo::FixedBlockReblocker<double>::kMaxChannels] = {};
+        const int deviceChannelCount = std::min(convo::FixedBlockReblocker<double>::kMaxChannels, buffer.getNumChannels());
+        for (int ch = 0; ch < deviceChannelCount; ++ch)
+            deviceChannels[ch] = buffer.getWritePointer(ch);
 
-        cleanupCrossfadeDirectPath(dsp, fading);
+        static_cast<void>(fixedBlockReblockerDouble.process(deviceChannels, deviceChannelCount, numSamples,
+            [&](double* const* blockChannels, int blockSamples)
+            {
+                // 外部メモリ参照の AudioBuffer はチャンネルポインタを内部に持つため確保しない
+                juce::AudioBuffer<double> blockBuffer(blockChannels, fixedBlockReblockerDouble.getNumChannels(), blockSamples);
+                static_cast<void>(processDspBlock(blockBuffer));
+            }));
     }
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
@@ -3,7 +3,9 @@
 #include "AudioEngine.h"
 #include "DiagnosticsConfig.h"
 #include "core/TimeUtils.h"
-#include "dsp/math/FastTanhApprox.h"
+#include "EtwTrace.h"
+#include "dsp/KernelDispatch.h"
+#include "ChainSilenceTracker.h"
 
 #include <cstdint>
 #include <atomic>
@@ -57,16 +59,8 @@ void logEqTime(uint64_t eqStartUs, int numSamples, int /*numChannels*/,
 
 namespace
 {
-inline bool isFiniteNoLibm(double x) noexcept
-{
-    union { double d; uint64_t u; } v { x };
-    return ((v.u >> 52) & 0x7FFu) != 0x7FFu;
-}
-
-inline bool isFiniteAndAbsBelowNoLibm(double x, double threshold) noexcept
-{
-    return isFiniteNoLibm(x) && (absNoLibm(x) < threshold);
-}
+// 出力ヘッドルーム -1.0 dBFS (processOutputDouble と出力メータの割り戻しで共有)
+constexpr double kOutputHeadroom = 0.8912509381337456;
 
 inline void applyGainRamp(double* __restrict data, int numSamples,
                           double startGain, double increment) noexcept
@@ -104,177 +98,33 @@ inline void scaleBlockFallback(double* data, int numSamples, double gain) noexce
         data[i] *= gain;
 }
 
-inline double musicalSoftClipScalar(double x, double threshold, double knee, double asymmetry) noexcept
+// ★ 無音スキップの入力判定 (ChainSilenceTracker.h の isSilentBlock、L/R の先頭 2ch)
+inline bool isSilentProcessBlock(const juce::dsp::AudioBlock<double>& block) noexcept
 {
-    const double abs_x = absNoLibm(x);
-    const double clip_start = threshold - knee;
-
-    if (knee < 1.0e-9) return (x > threshold) ? threshold : ((x < -threshold) ? -threshold : x);
-
-    if (abs_x < clip_start)
-        return x;
-
-    const double sign = (x > 0.0) ? 1.0 : -1.0;
-
-    double knee_shape = 1.0;
-    if (abs_x < threshold + knee)
-    {
-        const double t = (abs_x - clip_start) / (2.0 * knee);
-        knee_shape = t * t * (3.0 - 2.0 * t);
-    }
-
-    const double linear = abs_x;
-    const double clipped = threshold + knee * convo::dsp::fastTanh<convo::dsp::SoftClipPadéPolicy>((abs_x - threshold) / knee);
-
-    const double asymmetric_gain = 1.0 - asymmetry * (1.0 - sign) * 0.5 * knee_shape;
-    return sign * (linear * (1.0 - knee_shape) + clipped * knee_shape) * asymmetric_gain;
+    const size_t numChannels = block.getNumChannels();
+    if (numChannels == 0)
+        return true;
+    return convo::isSilentBlock(block.getChannelPointer(0),
+                                numChannels > 1 ? block.getChannelPointer(1) : nullptr,
+                                static_cast<int>(block.getNumSamples()));
 }
 
-void softClipBlockAVX2(double* __restrict data, int numSamples,
-                       double threshold, double knee, double asymmetry,
-                       double& prevSampleInOut) noexcept
+// ★ SoftClip 本体は KernelDispatch (Scalar / AVX2 / AVX-512) に移動。
+//    kernel は DSPCore::prepare で解決済みのものを受け取る (Audio Thread でテーブルを引かない)。
+void softClipBlock(convo::dsp::SoftClipKernel kernel, double* __restrict data, int numSamples,
+                   double threshold, double knee, double asymmetry,
+                   double& prevSampleInOut) noexcept
 {
-    const double clip_start = threshold - knee;
     jassert(knee > 1.0e-9);
-    // ★ [P0-3] Release 安全ガード: knee が小さすぎる場合は hard clip と等価に fallback
-    if (knee <= 1.0e-9) [[unlikely]]
-    {
-        for (int i = 0; i < numSamples; ++i)
-            data[i] = juce::jlimit(-threshold, threshold, data[i]);
+    if (numSamples <= 0)
         return;
-    }
-
-    const __m256d vClipStart   = _mm256_set1_pd(clip_start);
-    const __m256d vThreshold   = _mm256_set1_pd(threshold);
-    const __m256d vKnee        = _mm256_set1_pd(knee);
-    const __m256d vAsym        = _mm256_set1_pd(asymmetry);
-
-    const __m256d vRecipKnee   = _mm256_set1_pd(1.0 / knee);
-    const __m256d vRecipKnee2  = _mm256_set1_pd(1.0 / (2.0 * knee));
-
-    const __m256d vOne         = _mm256_set1_pd(1.0);
-    const __m256d vMinusOne    = _mm256_set1_pd(-1.0);
-    const __m256d vTwo         = _mm256_set1_pd(2.0);
-    const __m256d vThree       = _mm256_set1_pd(3.0);
-    const __m256d vHalf        = _mm256_set1_pd(0.5);
-
-    const __m256d vZero        = _mm256_setzero_pd();
-    const __m256d vSignMask    = _mm256_set1_pd(-0.0);
-
-    double prevScalar = prevSampleInOut;
-
-    int i = 0;
-    const int vEnd = numSamples / 4 * 4;
-    for (; i < vEnd; i += 4)
-    {
-            __m256d x    = _mm256_loadu_pd(data + i);
-
-        // [P3] midVec事前平均化ブロックを完全削除
-        // このブロックは threshold レベルでのハードリミッティングを引き起こし、
-        // SoftClip本来の滑らかなKnee特性を損なっていた。
-        // x はそのまま後続のSoftClip（fastTanh近似）へ流れる。
-        // 削除によりAVX2パスとスカラーフォールバックパスの動作が一致する。
-
-        __m256d absX = _mm256_andnot_pd(vSignMask, x);
-
-        __m256d needClip = _mm256_cmp_pd(absX, vClipStart, _CMP_GT_OQ);
-
-        __m256d maskSignPos = _mm256_cmp_pd(x, vZero, _CMP_GT_OQ);
-        __m256d sign = _mm256_blendv_pd(vMinusOne, vOne, maskSignPos);
-
-        __m256d t = _mm256_mul_pd(_mm256_sub_pd(absX, vClipStart), vRecipKnee2);
-        t = _mm256_min_pd(_mm256_max_pd(t, vZero), vOne);
-        __m256d t2 = _mm256_mul_pd(t, t);
-        __m256d ks = _mm256_mul_pd(t2, _mm256_fnmadd_pd(vTwo, t, vThree));
-
-        __m256d arg = _mm256_mul_pd(_mm256_sub_pd(absX, vThreshold), vRecipKnee);
-        __m256d tanhVal = convo::dsp::fastTanhV256<convo::dsp::SoftClipPadéPolicy>(arg);
-
-        __m256d clipped = _mm256_fmadd_pd(vKnee, tanhVal, vThreshold);
-
-        __m256d linear  = absX;
-        __m256d mixed   = _mm256_fmadd_pd(_mm256_sub_pd(clipped, linear), ks, linear);
-
-        __m256d factor = _mm256_mul_pd(vAsym, _mm256_sub_pd(vOne, sign));
-        factor = _mm256_mul_pd(factor, vHalf);
-        factor = _mm256_mul_pd(factor, ks);
-        __m256d asymmetric_gain = _mm256_sub_pd(vOne, factor);
-
-        __m256d result = _mm256_mul_pd(sign, _mm256_mul_pd(mixed, asymmetric_gain));
-
-        result = _mm256_blendv_pd(x, result, needClip);
-        const double nextPrev = data[i + 3]; // [BUG-04] store前に元の入力値を退避
-            _mm256_storeu_pd(data + i, result);
-
-        prevScalar = nextPrev;
-    }
-
-    for (; i < numSamples; ++i)
-    {
-        const double inputVal = data[i]; // 元の入力を退避
-        double x = inputVal;
-        if (absNoLibm(x) > clip_start)
-            x = musicalSoftClipScalar(x, threshold, knee, asymmetry);
-
-        data[i] = x;
-        prevScalar = inputVal; // 修正: 処理前の生入力値を保存
-    }
-
-    prevSampleInOut = prevScalar;
-}
-
-inline void pushAdaptiveCaptureBlocks(LockFreeRingBuffer<AudioBlock, 4096>* captureQueue,
-                                      const double* left,
-                                      const double* right,
-                                      int numSamples,
-                                      int sampleRateHz,
-                                      int bitDepth,
-                                      int adaptiveCoeffBankIndex,
-                                      uint64_t captureSessionId) noexcept
-{
-    if (captureQueue == nullptr || left == nullptr || numSamples <= 0)
-        return;
-
-    static constexpr int kBlockSize = 256;
-    for (int offset = 0; offset < numSamples; offset += kBlockSize)
-    {
-        const int currentBlockSize = std::min(kBlockSize, numSamples - offset);
-        const double* srcL = left + offset;
-        const double* srcR = (right != nullptr) ? (right + offset) : srcL;
-
-        if (!captureQueue->pushWithWriter([&](AudioBlock& block) noexcept
-        {
-            block.numSamples = currentBlockSize;
-            block.sampleRateHz = sampleRateHz;
-            block.bitDepth = bitDepth;
-            block.adaptiveCoeffBankIndex = adaptiveCoeffBankIndex;
-            block.sessionId = captureSessionId;
+    if (kernel == nullptr) [[unlikely]] // prepare 前の呼び出し保険
+        kernel = convo::dsp::activeKernels().softClip;
 
-            const int simdCount = currentBlockSize & ~3;
-            int i = 0;
-
-            for (; i < simdCount; i += 4)
-            {
-                __m256d v = _mm256_loadu_pd(srcL + i);
-                _mm256_storeu_pd(block.L + i, v);
-            }
-            for (; i < currentBlockSize; ++i)
-                block.L[i] = srcL[i];
-
-            i = 0;
-            for (; i < simdCount; i += 4)
-            {
-                __m256d v = _mm256_loadu_pd(srcR + i);
-                _mm256_storeu_pd(block.R + i, v);
-            }
-            for (; i < currentBlockSize; ++i)
-                block.R[i] = srcR[i];
-        }))
-        {
-            // Audio Thread では side-channel atomic 書き込みを行わない。
-            // キュー満杯時は静かにドロップする（従来挙動維持）。
-        }
-    }
+    // [BUG-04] prevSample は処理前の生入力値
+    const double lastInput = data[numSamples - 1];
+    kernel(data, numSamples, threshold, knee, asymmetry);
+    prevSampleInOut = lastInput;
 }
 }
 
@@ -330,6 +180,9 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
         }
     }
 
+    // ★ 段別処理時間: float 経路と同じ境目で lap する (finishProcessDouble までを Output 段に数える)
+    convo::StageLatencyProbe stageProbe(state.stageLatency, convo::EtwTrace::stageSink());
+
     const bool inputTapD = state.analyzerEnabled && (state.analyzerSource == AnalyzerSource::Input);
     const float rawInputLinearD = processInputDouble(buffer, numSamples, state.inputHeadroomGain,
                                                      inputTapD, analyzerFifo);
@@ -348,17 +201,66 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
     juce::dsp::AudioBlock<double> processBlock(channels, 2, numSamples);
     juce::dsp::AudioBlock<double> originalBlock = processBlock;
 
+    // ★ 透過状態 (ハードバイパス): EQ / Convolver とも完全バイパスでフェードも終わっていれば、
+    //   bypass blend の結果は wet·0 + dry·1 = 入力そのもの。OS・EQ・SoftClip・ブレンドを飛ばし、
+    //   出力段 (DC ブロッカ・ディザ・リミッタ・メータ) だけ回す。抜けるときは bypassFadeGainDouble が
+    //   0 → 1 へ進み、ゼロ状態から始めた wet 経路を既存のフェードで戻す
+    eqRt().setBypassFromRT(state.eqBypassed); // RT-local shadow に書き込み（publishAtomic の RT 使用禁止のため）
+    const bool transparent = requestedFullBypass
+        && !ramp.bypassFadeGainDouble.isSmoothing()
+        && (state.eqFoldedIntoIR || eqRt().isBypassSettledFromRT());
+    if (transparent && !ramp.transparentDouble)
+        enterTransparentDouble();
+    ramp.transparentDouble = transparent;
+    if (transparent)
+    {
+        stageProbe.lap(convo::DspStage::Input);
+        finishProcessDouble(buffer, originalBlock, analyzerFifo, outputLevelLinear, state);
+        stageProbe.lap(convo::DspStage::Output);
+        return;
+    }
+
     if (dryBypassBufferDoubleL && dryBypassBufferDoubleR && dryBypassCapacityDouble >= numSamples)
     {
         juce::FloatVectorOperations::copy(dryBypassBufferDoubleL.get(), alignedL.get(), numSamples);
         juce::FloatVectorOperations::copy(dryBypassBufferDoubleR.get(), alignedR.get(), numSamples);
     }
+    stageProbe.lap(convo::DspStage::Input);
 
     // [DIAG] テストトーン注入は削除（work52調査終了）
 
+    // ★ Split-rate EQ: EQ→Convolver 順では EQ を processUp 前のベースレートで処理する
+    if (state.eqAtBaseRate && !state.eqFoldedIntoIR)
+    {
+        eqRt().setBypassFromRT(state.eqBypassed); // RT-local shadow に書き込み（publishAtomic の RT 使用禁止のため）
+        eqRt().process(originalBlock, *state.eqParams, state.eqCache);
+        stageProbe.lap(convo::DspStage::Eq);
+    }
+
+    // ★ 段ごとの無音スキップ (ChainSilenceTracker): 入力が無音で、直前まで ring-out 以上の無音が続いた段は
+    //   処理せず出力をゼロにする。blockIsZero = processBlock が厳密にゼロと分かっている (再走査不要)。
+    //   Convolver / EQ は対象外 (Convolver は無音パーティションを内部で省き、平滑化は時間で進む)。
+    //   出力段 (DC ブロッカ・ディザ / ノイズシェーパー・リミッタ) はスキップしない。
+    using SilenceStage = convo::ChainSilenceTracker::Stage;
+    using SilenceAction = convo::ChainSilenceTracker::GateAction;
+    bool blockIsZero = false;
+
     if (oversamplingFactor > 1)
     {
-        processBlock = oversampling.processUp(originalBlock, static_cast<int>(originalBlock.getNumChannels()));
+        const bool osSkippable = oversampling.canSkipSilentBlocks();
+        const SilenceAction upAction = silenceTracker.advance(SilenceStage::OversampleUp,
+                                                              osSkippable && isSilentProcessBlock(originalBlock), numSamples);
+        if (upAction == SilenceAction::Process)
+        {
+            processBlock = oversampling.processUp(originalBlock, static_cast<int>(originalBlock.getNumChannels()), channelSplitForBlock());
+        }
+        else
+        {
+            if (upAction == SilenceAction::EnterSkip)
+                oversampling.clearUpHistories();
+            processBlock = oversampling.processUpSilent(numSamples, static_cast<int>(originalBlock.getNumChannels()));
+            blockIsZero = true;
+        }
 
         if (processBlock.getNumSamples() == 0 || processBlock.getNumSamples() > static_cast<size_t>(maxInternalBlockSize))
         {
@@ -369,10 +271,29 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
 
         const int numOSSamples = static_cast<int>(processBlock.getNumSamples());
         auto& dc = dcBlockers();
-        if (processBlock.getNumChannels() > 0)
-            dc.oversampledL.process(processBlock.getChannelPointer(0), numOSSamples);
-        if (processBlock.getNumChannels() > 1)
-            dc.oversampledR.process(processBlock.getChannelPointer(1), numOSSamples);
+        const SilenceAction dcAction = silenceTracker.advance(SilenceStage::OversampledDcBlock,
+                                                              blockIsZero || isSilentProcessBlock(processBlock), numOSSamples);
+        if (dcAction == SilenceAction::Process)
+        {
+            // ★ L/R を 1 本の SIMD 再帰で処理 (UltraHighRateDCBlocker::processStereo)
+            const size_t numOSChannels = processBlock.getNumChannels();
+            dc.oversampledL.processStereo(numOSChannels > 0 ? processBlock.getChannelPointer(0) : nullptr,
+                                          numOSChannels > 1 ? processBlock.getChannelPointer(1) : nullptr,
+                                          numOSSamples, dc.oversampledR);
+            blockIsZero = false;
+        }
+        else
+        {
+            if (dcAction == SilenceAction::EnterSkip)
+            {
+                dc.oversampledL.reset();
+                dc.oversampledR.reset();
+            }
+            if (!blockIsZero)
+                processBlock.clear();
+            blockIsZero = true;
+        }
+        stageProbe.lap(convo::DspStage::OversampleUp);
     }
 
     const int numProcSamples = static_cast<int>(processBlock.getNumSamples());
@@ -383,14 +304,23 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
 
     eqRt().setBypassFromRT(state.eqBypassed); // RT-local shadow に書き込み（publishAtomic の RT 使用禁止のため）
 
+    // ★ パイプライン化 Convolver: バイパス中は遅延リングを無音に戻し、復帰時に古い結果を鳴らさない
+    if (state.convBypassed)
+        convolverPipeline.restart();
+
     if (state.order == ProcessingOrder::ConvolverThenEQ)
     {
         if (!state.convBypassed)
         {
-            convolverRt().process(processBlock);
+            processConvolverStageForState(processBlock, state);
+            stageProbe.lap(convo::DspStage::Convolver);
             // ★ [work65] work52キャプチャコード削除
         }
-        if (!state.eqBypassed)
+        if (state.eqFoldedIntoIR)
+        {
+            // ★ EQ fold: EQ 応答は IR に焼き込み済み (Convolver 段で適用される)
+        }
+        else if (!state.eqBypassed)
         {
             if (eqParamsToUse != nullptr)
             {
@@ -411,10 +341,20 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
         {
             eqRt().process(processBlock);
         }
+        if (!state.eqFoldedIntoIR)
+            stageProbe.lap(convo::DspStage::Eq);
     }
     else
     {
-        if (!state.eqBypassed)
+        if (state.eqFoldedIntoIR)
+        {
+            // ★ EQ fold: EQ 応答は IR に焼き込み済み (Convolver 段で適用される)
+        }
+        else if (state.eqAtBaseRate)
+        {
+            // ★ Split-rate EQ: processUp 前に処理済み
+        }
+        else if (!state.eqBypassed)
         {
             if (eqParamsToUse != nullptr)
             {
@@ -435,6 +375,8 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
         {
             eqRt().process(processBlock);
         }
+        if (!state.eqFoldedIntoIR && !state.eqAtBaseRate)
+            stageProbe.lap(convo::DspStage::Eq);
         if (!state.convBypassed)
         {
             if (state.convolverInputTrimGain != 1.0)
@@ -445,36 +387,78 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
                     scaleBlockFallback(ptr, (int)processBlock.getNumSamples(), state.convolverInputTrimGain);
                 }
             }
-            convolverRt().process(processBlock);
+            processConvolverStageForState(processBlock, state);
+            stageProbe.lap(convo::DspStage::Convolver);
             // ★ [work65] work52キャプチャコード削除
         }
     }
 
+    // EQ / Convolver は無音入力でも平滑化や残響の尾を出し得る
+    blockIsZero = false;
+
     {
         const bool convActive = !state.convBypassed;
         const bool eqActive   = !state.eqBypassed;
         if (convActive || eqActive)
         {
-            const bool convIsLast = convActive &&
-                (!eqActive || state.order == ProcessingOrder::EQThenConvolver);
-            outputFilter.process(processBlock, convIsLast,
-                                 state.convHCMode, state.convLCMode, state.eqLPFMode);
+            const SilenceAction filterAction = silenceTracker.advance(SilenceStage::OutputFilter,
+                                                                      isSilentProcessBlock(processBlock), numProcSamples);
+            if (filterAction == SilenceAction::Process)
+            {
+                const bool convIsLast = convActive &&
+                    (!eqActive || state.order == ProcessingOrder::EQThenConvolver);
+                outputFilter.process(processBlock, convIsLast,
+                                     state.convHCMode, state.convLCMode, state.eqLPFMode);
+            }
+            else
+            {
+                if (filterAction == SilenceAction::EnterSkip)
+                    outputFilter.reset();
+                processBlock.clear();
+                blockIsZero = true;
+            }
         }
     }
 
-    for (size_t ch = 0; ch < processBlock.getNumChannels(); ++ch)
+    if (!blockIsZero)
     {
-        double* ptr = processBlock.getChannelPointer(ch);
-        scaleBlockFallback(ptr, (int)processBlock.getNumSamples(), state.outputMakeupGain);
+        for (size_t ch = 0; ch < processBlock.getNumChannels(); ++ch)
+        {
+            double* ptr = processBlock.getChannelPointer(ch);
+            scaleBlockFallback(ptr, (int)processBlock.getNumSamples(), state.outputMakeupGain);
+        }
     }
 
-    if (state.softClipEnabled)
+    const SilenceAction softClipAction = state.softClipEnabled
+        ? silenceTracker.advance(SilenceStage::SoftClip, blockIsZero || isSilentProcessBlock(processBlock), numProcSamples)
+        : SilenceAction::Process;
+    if (state.softClipEnabled && softClipAction != SilenceAction::Process)
+    {
+        // 0 → 0 の曲線なので、状態 (OS = 1 の局所 OS 履歴) が消えていれば出力はゼロ
+        if (softClipAction == SilenceAction::EnterSkip)
+        {
+            auto& history = histories();
+            history.softClipPrevSample[0] = 0.0;
+            history.softClipPrevSample[1] = 0.0;
+            if (oversamplingFactor <= 1)
+            {
+                softClipOS.clearUpHistories();
+                softClipOS.clearDownHistories();
+                softClipRoute.reset();
+            }
+        }
+        if (!blockIsZero)
+            processBlock.clear();
+        blockIsZero = true;
+    }
+    else if (state.softClipEnabled)
     {
         auto& history = histories();
         const double sat = static_cast<double>(state.saturationAmount);
         const double clipThreshold = 0.95 - 0.45 * sat;
         const double clipKnee      = 0.05 + 0.35 * sat;
         const double clipAsymmetry = 0.10 * sat;
+        blockIsZero = false;
 
         if (oversamplingFactor > 1)
         {
@@ -482,23 +466,13 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
             for (int ch = 0; ch < numProcChannels; ++ch)
             {
                 double* data = processBlock.getChannelPointer(ch);
-                softClipBlockAVX2(data, numProcSamples, clipThreshold, clipKnee, clipAsymmetry,
-                                   history.softClipPrevSample[ch < 2 ? ch : 1]);
+                softClipBlock(softClipKernel, data, numProcSamples, clipThreshold, clipKnee, clipAsymmetry,
+                              history.softClipPrevSample[ch < 2 ? ch : 1]);
             }
         }
         else
         {
-            // 局所2倍OS: processUp → SoftClip → processDown
-            const int nChOS = static_cast<int>(originalBlock.getNumChannels());
-            auto osBlock = softClipOS.processUp(originalBlock, nChOS);
-            const int osSamples = static_cast<int>(osBlock.getNumSamples());
-            for (int ch = 0; ch < nChOS; ++ch)
-            {
-                double* osData = osBlock.getChannelPointer(ch);
-                softClipBlockAVX2(osData, osSamples, clipThreshold, clipKnee, clipAsymmetry,
-                                   history.softClipPrevSample[ch < 2 ? ch : 1]);
-            }
-            softClipOS.processDown(osBlock, originalBlock, nChOS);
+            processSoftClipLocalOS(originalBlock, clipThreshold, clipKnee, clipAsymmetry);
         }
     }
 
@@ -509,6 +483,7 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
         && dryBypassCapacityDouble >= numSamples
         && bypassBlendRequested)
     {
+        blockIsZero = false;
         double* wetL = (numProcChannels > 0) ? processBlock.getChannelPointer(0) : nullptr;
         double* wetR = (numProcChannels > 1) ? processBlock.getChannelPointer(1) : nullptr;
         const double* dryL = dryBypassBufferDoubleL.get();
@@ -524,9 +499,24 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
         }
     }
 
+    stageProbe.lap(convo::DspStage::Output);
+
     if (oversamplingFactor > 1)
     {
-        oversampling.processDown(processBlock, originalBlock, static_cast<int>(originalBlock.getNumChannels()));
+        const SilenceAction downAction = silenceTracker.advance(SilenceStage::OversampleDown,
+                                                                oversampling.canSkipSilentBlocks()
+                                                                    && (blockIsZero || isSilentProcessBlock(processBlock)),
+                                                                numSamples);
+        if (downAction == SilenceAction::Process)
+        {
+            oversampling.processDown(processBlock, originalBlock, static_cast<int>(originalBlock.getNumChannels()), channelSplitForBlock());
+        }
+        else
+        {
+            if (downAction == SilenceAction::EnterSkip)
+                oversampling.clearDownHistories();
+            originalBlock.clear();
+        }
         processBlock = originalBlock;
 
         if (bypassBlendRequested)
@@ -548,17 +538,182 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
                     wetR[i] = canUseDry ? (wetR[i] * gWet + dryR[i] * gDry) : (wetR[i] * gWet);
             }
         }
+        stageProbe.lap(convo::DspStage::OversampleDown);
     }
 
+    finishProcessDouble(buffer, originalBlock, analyzerFifo, outputLevelLinear, state);
+    stageProbe.lap(convo::DspStage::Output);
+}
+
+void AudioEngine::DSPCore::enterTransparentDouble() noexcept
+{
+    // フェード完了後なので wet は出力に寄与していない。再開時に古い履歴を鳴らさないよう消しておく
+    // (Convolver / EQ はバイパス中も処理されず、従来どおり自身の復帰処理に任せる)
+    oversampling.clearUpHistories();
+    oversampling.clearDownHistories();
+    softClipOS.clearUpHistories();
+    softClipOS.clearDownHistories();
+    softClipRoute.reset();
+    auto& dc = dcBlockers();
+    dc.oversampledL.reset();
+    dc.oversampledR.reset();
+    outputFilter.reset();
+    histories().clearSoftClipHistory();
+    silenceTracker.reset();
+    convolverPipeline.restart();
+}
+
+// 局所2倍OS: processUp → SoftClip → processDown。Adaptive のときは処理前のブロックのピークで経路を選ぶ
+// (AdaptiveSoftClipRoute.h)。1x のブロックは up / down を回さず、履歴に積んだ入力を D サンプル遅らせて返す
+void AudioEngine::DSPCore::processSoftClipLocalOS(juce::dsp::AudioBlock<double>& block,
+                                                  double threshold, double knee, double asymmetry) noexcept
+{
+    using Action = convo::AdaptiveSoftClipRoute::Action;
+    const int nChOS = static_cast<int>(block.getNumChannels());
+    const int numSamples = static_cast<int>(block.getNumSamples());
+
+    Action action = Action::Oversample;
+    if (adaptiveSoftClipOS && softClipRoute.isReady() && nChOS <= convo::AdaptiveSoftClipRoute::kMaxChannels)
+    {
+        double peak = 0.0;
+        for (int ch = 0; ch < nChOS; ++ch)
+        {
+            const double channelPeak = peakAbsKernel(block.getChannelPointer(ch), numSamples);
+            if (!(channelPeak <= peak)) // NaN も拾って OS 側に残す
+                peak = channelPeak;
+        }
+        action = softClipRoute.decide(peak, threshold - knee, numSamples);
+
+        if (action == Action::PrimeAndOversample)
+        {
+            // 1x の間は SoftClip が恒等だったので、直前の入力を up → down に流せば OS の履歴は連続稼働時と一致する
+            const int prime = softClipRoute.getPrimeSamples();
+            double* primeIn[convo::AdaptiveSoftClipRoute::kMaxChannels] {};
+            double* primeOut[convo::AdaptiveSoftClipRoute::kMaxChannels] {};
+            for (int ch = 0; ch < nChOS; ++ch)
+            {
+                primeIn[ch] = softClipRoute.primeInput(ch);
+                primeOut[ch] = softClipRoute.fadeBuffer(ch);
+            }
+            juce::dsp::AudioBlock<double> primeBlock(primeIn, static_cast<size_t>(nChOS), static_cast<size_t>(prime));
+            juce::dsp::AudioBlock<double> discardBlock(primeOut, static_cast<size_t>(nChOS), static_cast<size_t>(prime));
+            softClipOS.clearUpHistories();
+            softClipOS.clearDownHistories();
+            auto primeOsBlock = softClipOS.processUp(primeBlock, nChOS);
+            softClipOS.processDown(primeOsBlock, discardBlock, nChOS);
+        }
+
+        for (int ch = 0; ch < nChOS; ++ch)
+        {
+            double* data = block.getChannelPointer(ch);
+            double* delayedOut = (action == Action::Bypass) ? data
+                               : (action == Action::FadeToBypass) ? softClipRoute.fadeBuffer(ch)
+                               : nullptr;
+            softClipRoute.pushBlock(ch, data, numSamples, delayedOut);
+        }
+        if (action == Action::Bypass)
+            return;
+    }
+
+    auto& history = histories();
+    auto osBlock = softClipOS.processUp(block, nChOS);
+    const int osSamples = static_cast<int>(osBlock.getNumSamples());
+    for (int ch = 0; ch < nChOS; ++ch)
+    {
+        double* osData = osBlock.getChannelPointer(ch);
+        softClipBlock(softClipKernel, osData, osSamples, threshold, knee, asymmetry,
+                      history.softClipPrevSample[ch < 2 ? ch : 1]);
+    }
+    softClipOS.processDown(osBlock, block, nChOS);
+
+    if (action == Action::FadeToBypass)
+    {
+        for (int ch = 0; ch < nChOS; ++ch)
+            convo::AdaptiveSoftClipRoute::crossfadeToDelayed(block.getChannelPointer(ch), softClipRoute.fadeBuffer(ch), numSamples);
+    }
+}
+
+void AudioEngine::DSPCore::pinReadersForCallback(convo::CallbackReaderScope& scope) noexcept
+{
+    eqRt().pinReaderForCallback(scope);
+    // パイプライン稼働中はワーカーが runtimeRcuReader の所有者になるため、Audio Thread からは固定しない
+    if (!convolverPipeline.isRunning())
+        convolverRt().pinReaderForCallback(scope);
+}
+
+void AudioEngine::DSPCore::processConvolverStage(juce::dsp::AudioBlock<double>& block) noexcept
+{
+    if (!convolverPipeline.isRunning())
+    {
+        convolverRt().process(block, channelSplitForBlock());
+        return;
+    }
+
+    // ワーカーが convolver を専有しているため、ここでは同期処理に戻さない。
+    // ホストが準備時より長いブロックを渡した場合は blockSamples ごとに分けて投入する (遅延は変わらない)
+    jassert(block.getNumChannels() == 2);
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int chunk = convolverPipeline.getBlockSamples();
+    for (int offset = 0; offset < numSamples; offset += chunk)
+    {
+        double* channels[2] = { block.getChannelPointer(0) + offset, block.getChannelPointer(1) + offset };
+        convolverPipeline.process(channels, 2, std::min(chunk, numSamples - offset));
+    }
+}
+
+void AudioEngine::DSPCore::processConvolverStageForState(juce::dsp::AudioBlock<double>& block,
+                                                         const ProcessingState& state) noexcept
+{
+    DSPCore* const peer = state.stageFadePeer;
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = std::min(2, static_cast<int>(block.getNumChannels()));
+    if (peer == nullptr || numSamples <= 0 || numSamples > stageFadeScratchCapacity)
+    {
+        processConvolverStage(block);
+        return;
+    }
+
+    // ★ Convolver 段スコープ遷移: 上流 (入力段・EQ・OS) の出力を共有し、旧 Convolver へも同じ入力を渡す
+    double* peerChannels[2] = { stageFadeScratchL.get(), stageFadeScratchR.get() };
+    for (int ch = 0; ch < numChannels; ++ch)
+        juce::FloatVectorOperations::copy(peerChannels[ch], block.getChannelPointer(static_cast<size_t>(ch)), numSamples);
+    juce::dsp::AudioBlock<double> peerBlock(peerChannels, static_cast<size_t>(numChannels), static_cast<size_t>(numSamples));
+    peer->processConvolverStage(peerBlock);
+    processConvolverStage(block);
+
+    // 新旧の段遅延は一致している (selectCrossfadeScope) ので、同じ位置のサンプル同士を混ぜれば整列は厳密。
+    // ゲインはベースレートのブロック境界値を処理レートの各サンプルへ線形補間する
+    const double gainStart = state.stageFadeGainStart;
+    const double gainStep = (state.stageFadeGainEnd - gainStart) / static_cast<double>(numSamples);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        double* out = block.getChannelPointer(static_cast<size_t>(ch));
+        const double* old = peerChannels[ch];
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double g = gainStart + gainStep * static_cast<double>(i + 1);
+            out[i] = old[i] + (out[i] - old[i]) * g;
+        }
+    }
+}
+
+void AudioEngine::DSPCore::finishProcessDouble(juce::AudioBuffer<double>& buffer,
+                                               const juce::dsp::AudioBlock<double>& outputBlock,
+                                               LockFreeAudioRingBuffer& analyzerFifo,
+                                               std::atomic<float>* outputLevelLinear,
+                                               const ProcessingState& state) noexcept
+{
+    const int numSamples = static_cast<int>(outputBlock.getNumSamples());
+
     if (state.analyzerEnabled && state.analyzerSource == AnalyzerSource::Output)
-        pushToFifo(processBlock, analyzerFifo);
+        pushToFifo(outputBlock, analyzerFifo);
 
-    const float outputLinear = measureLevel(originalBlock);
+    // 出力メータは processOutputDouble の健全性検査と同じパスで求めたピーク
+    const float outputLinear = processOutputDouble(buffer, numSamples, state);
     if (outputLevelLinear != nullptr)
         convo::publishAtomic(*outputLevelLinear, outputLinear, std::memory_order_release);
 
-    processOutputDouble(buffer, numSamples, state);
-
+    auto& ramp = ramps();
     int fadeLeft = ramp.fadeInSamplesLeft;
     if (fadeLeft > 0)
     {
@@ -574,11 +729,10 @@ void AudioEngine::DSPCore::processDouble(juce::AudioBuffer<double>& buffer,
     }
 }
 
-void AudioEngine::DSPCore::processOutputDouble(juce::AudioBuffer<double>& buffer,
-                                               int numSamples,
-                                               const ProcessingState& state) noexcept
+float AudioEngine::DSPCore::processOutputDouble(juce::AudioBuffer<double>& buffer,
+                                                int numSamples,
+                                                const ProcessingState& state) noexcept
 {
-    constexpr double kOutputHeadroom = 0.8912509381337456;
     const bool applyDither = (ditherBitDepth > 0);
     const int numChannels = std::min(2, buffer.getNumChannels());
 
@@ -586,7 +740,7 @@ void AudioEngine::DSPCore::processOutputDouble(juce::AudioBuffer<double>& buffer
     {
         if (numSamples > 0)
             buffer.clear();
-        return;
+        return 0.0f;
     }
 
     double* dataL = (numChannels > 0) ? alignedL.get() : nullptr;
@@ -595,7 +749,7 @@ void AudioEngine::DSPCore::processOutputDouble(juce::AudioBuffer<double>& buffer
     if (dataL == nullptr)
     {
         buffer.clear();
-        return;
+        return 0.0f;
     }
 
     auto& dc = dcBlockers();
@@ -605,14 +759,7 @@ void AudioEngine::DSPCore::processOutputDouble(juce::AudioBuffer<double>& buffer
     //   全フィードバック構造（SVF/Lattice/FFT/Dither/DCB）が個別ガードを持ち、
     //   ScopedNoDenormals (FTZ/DAZ) も全 RT エントリで有効。R-2 解析にて安全性確認済み。
 
-    pushAdaptiveCaptureBlocks(state.adaptiveCaptureQueue,
-                              dataL,
-                              dataR,
-                              numSamples,
-                              state.adaptiveCaptureSampleRateHz,
-                              state.adaptiveCaptureBitDepth,
-                              state.adaptiveCoeffBankIndex,
-                              state.captureSessionId);
+    pushAdaptiveCapture(state, dataL, dataR, numSamples);
 
     if (noiseShaperType == NoiseShaperType::Adaptive9thOrder
         && state.adaptiveCoeffSet != nullptr
@@ -652,96 +799,53 @@ void AudioEngine::DSPCore::processOutputDouble(juce::AudioBuffer<double>& buffer
         else
             dither.processStereoBlock(dataL, dataR, numSamples, kOutputHeadroom);
     }
-    else
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            dataL[i] *= kOutputHeadroom;
-            if (dataR != nullptr)
-                dataR[i] *= kOutputHeadroom;
-        }
-    }
-
-    {
-        const __m256d vInf = _mm256_set1_pd(1.0e300);
-        int i = 0;
-        const int vEnd = numSamples / 4 * 4;
-        for (; i < vEnd; i += 4)
-        {
-            __m256d vL = _mm256_loadu_pd(dataL + i);
-            __m256d nanMaskL = _mm256_cmp_pd(vL, vL, _CMP_ORD_Q);
-            __m256d infMaskL = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), vL), vInf, _CMP_LT_OQ);
-            _mm256_storeu_pd(dataL + i, _mm256_and_pd(vL, _mm256_and_pd(nanMaskL, infMaskL)));
 
-            if (dataR != nullptr)
-            {
-                __m256d vR = _mm256_loadu_pd(dataR + i);
-                __m256d nanMaskR = _mm256_cmp_pd(vR, vR, _CMP_ORD_Q);
-                __m256d infMaskR = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), vR), vInf, _CMP_LT_OQ);
-                _mm256_storeu_pd(dataR + i, _mm256_and_pd(vR, _mm256_and_pd(nanMaskR, infMaskR)));
-            }
-        }
-
-        for (; i < numSamples; ++i)
-        {
-            if (!isFiniteAndAbsBelowNoLibm(dataL[i], 1.0e300))
-                dataL[i] = 0.0;
+    // ★ 健全性検査 (NaN/Inf・発散の除去) と出力メータのピークを 1 パスで求める (BlockHealthScan.h)。
+    //   ディザなしならヘッドルームも同じ走査で掛ける。メータのタップがこの結果を読むので融合出力段とは分ける。
+    //   ディザ時はシェーパーがヘッドルームを掛け済みなので、どちらの場合もメータ値はヘッドルームで割り戻す
+    const auto health = applyDither
+        ? convo::health::scanAndScrubStereo<false>(dataL, dataR, numSamples)
+        : convo::health::scanAndScrubStereo<true>(dataL, dataR, numSamples, kOutputHeadroom);
+    if (health.isCorrupted()) [[unlikely]]
+        recoverFromCorruptedOutput();
 
-            if (dataR != nullptr && !isFiniteAndAbsBelowNoLibm(dataR[i], 1.0e300))
-                dataR[i] = 0.0;
-        }
+    // ★ [P1-2] TruePeak/LUFS 計測は kOutputHeadroom + ディザ後の信号に対して行う (計測は実際の出力信号で)。
+    //   Audio Thread はブロックを float で FIFO へ写すだけで、K-weighting・4 倍補間・ゲーティングは
+    //   MeteringWorker が行う (FIFO が満杯なら溢れた分を捨てる)
+    if (state.meteringTap != nullptr)
+    {
+        const double* meterChannels[2] = { dataL, (dataR != nullptr) ? dataR : dataL };
+        state.meteringTap->push(juce::dsp::AudioBlock<const double>(meterChannels, 2, static_cast<size_t>(numSamples)));
     }
 
-    // ★ [P1-2] TruePeak/LUFS 計測を kOutputHeadroom + ディザ後に移動
-    //   （計測は実際の出力信号に対して行うべき）
-    // TruePeak検出（BS.1770-4/5準拠）
-    truePeakDetector.processBlock(dataL, dataR, numSamples);
-
-    // LUFSブロック平均電力（BS.1770-4/5 + EBU R128）
-    loudnessMeter.processBlock(dataL, dataR, numSamples);
-
-    // ★ [P1-1] Simple Peak Limiter: Hard Clamp (Safety Net) の前段で動作
+    // ★ [P1-1] Peak Limiter: Hard Clamp (Safety Net) の前段で動作
     //   threshold = kOutputHeadroom - 0.5dB, knee = 1.0dB (constexpr で libm 呼び出し回避)
     //   kOutputHeadroom = -1.0dBFS = 0.8912509381337456
     //   0.5dB down: 0.8912509381337456 * 10^(-0.5/20) = 0.8413951287507587
     //   1.0dB knee width: 0.8912509381337456 * (10^(1.0/20) - 1) = 0.108748
+    //   LookAheadPeakLimiter は 16 サンプル周期の制御点 + AVX2 のランプ乗算。先読み分 (getLatencySamples) 遅れる
     constexpr double kPLThreshold = 0.8413951287507587;
     constexpr double kPLKnee = 0.108748;
-    peakLimiter.processBlock(dataL, dataR, numSamples, kPLThreshold, kPLKnee);
-
-    {
-        const __m256d vLimit = _mm256_set1_pd(kOutputHeadroom);
-        const __m256d vNegLimit = _mm256_set1_pd(-kOutputHeadroom);
-        int i = 0;
-        const int vEnd = (numSamples / 4) * 4;
-        for (; i < vEnd; i += 4)
-        {
-            __m256d vL = _mm256_loadu_pd(dataL + i);
-            vL = _mm256_min_pd(_mm256_max_pd(vL, vNegLimit), vLimit);
-            _mm256_storeu_pd(dataL + i, vL);
-
-            if (dataR != nullptr)
-            {
-                __m256d vR = _mm256_loadu_pd(dataR + i);
-                vR = _mm256_min_pd(_mm256_max_pd(vR, vNegLimit), vLimit);
-                _mm256_storeu_pd(dataR + i, vR);
-            }
-        }
-
-        for (; i < numSamples; ++i)
-        {
-            dataL[i] = juce::jlimit(-kOutputHeadroom, kOutputHeadroom, dataL[i]);
-            if (dataR != nullptr)
-                dataR[i] = juce::jlimit(-kOutputHeadroom, kOutputHeadroom, dataR[i]);
-        }
-    }
-
-    applyFixedLatencyDelay(dataL, dataR, numSamples);
-
-    juce::FloatVectorOperations::copy(buffer.getWritePointer(0, 0), dataL, numSamples);
-    if (numChannels > 1 && dataR != nullptr)
-        juce::FloatVectorOperations::copy(buffer.getWritePointer(1, 0), dataR, numSamples);
+    peakLimiter.processBlock(dataL, dataR, numSamples, 1.0, kPLThreshold, kPLKnee);
+
+    // ★ Hard Clamp (Safety Net) → 固定レイテンシ遅延 → 出力バッファ書き込みを 1 パスで回す (FusedOutputStage.h)
+    //   整数 ASIO デバイスではディザの LSB がドライバ変換後も保たれるよう deviceCodeGain を同じパスで掛ける
+    //   (DeviceOutputCodec.h)。クランプ上限も同じ比率で広げ、補正後の値を削らない
+    auto& history = histories();
+    auto delay = history.fixedLatencyDelay();
+    convo::output::FusedOutputParams outputParams;
+    outputParams.gain = state.deviceCodeGain;
+    outputParams.limit = kOutputHeadroom * state.deviceCodeGain;
+    double* outL = buffer.getWritePointer(0, 0);
+    double* outR = numChannels > 1 && dataR != nullptr ? buffer.getWritePointer(1, 0) : nullptr;
+    if (state.deviceCodeGain != 1.0)
+        convo::output::runFusedOutputStage<true, false>(dataL, dataR, outL, outR, numSamples, outputParams, delay);
+    else
+        convo::output::runFusedOutputStage<false, false>(dataL, dataR, outL, outR, numSamples, outputParams, delay);
+    history.fixedLatencyWritePos = delay.writePos;
 
     for (int channel = numChannels; channel < buffer.getNumChannels(); ++channel)
         buffer.clear(channel, 0, numSamples);
+
+    return static_cast<float>(health.peak / kOutputHeadroom);
 }
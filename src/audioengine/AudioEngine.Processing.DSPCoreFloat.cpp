@@ -3,6 +3,8 @@
 #include "AudioEngine.h"
 #include "DiagnosticsConfig.h"
 #include "core/TimeUtils.h"
+#include "EtwTrace.h"
+#include "dsp/KernelDispatch.h"
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
 // ★ [P2-5] diagLog 削除: 呼び出し箇所ゼロのデッドコード。
@@ -135,67 +137,33 @@ inline void scaleBlockFallback(double* data, int numSamples, double gain) noexce
         data[i] *= gain;
 }
 
-inline double fastTanh(double x) noexcept
+// ★ SoftClip 本体は KernelDispatch (Scalar / AVX2 / AVX-512、SoftClipBlock.h) で processOutputDouble と共通。
+//    float 経路は入力が未検査なので、先に NaN/Inf を 0 にしてからブロックごとカーネルへ渡す。
+void softClipBlock(convo::dsp::SoftClipKernel kernel, double* __restrict data, int numSamples,
+                   double threshold, double knee, double asymmetry,
+                   double& prevSampleInOut) noexcept
 {
-    constexpr double numA = 10395.0;
-    constexpr double numB = 1260.0;
-    constexpr double numC = 21.0;
-    constexpr double denA = 10395.0;
-    constexpr double denB = 4725.0;
-    constexpr double denC = 210.0;
-    constexpr double clipThreshold = 4.5;
-
-    if (x >= clipThreshold) return 1.0;
-    if (x <= -clipThreshold) return -1.0;
-    const double x2 = x * x;
-
-    const double num = x * (numA + x2 * (numB + x2 * numC));
-    const double den = denA + x2 * (denB + x2 * (denC + x2));
-    return num / den;
-}
-
-inline double musicalSoftClipScalar(double x, double threshold, double knee, double asymmetry) noexcept
-{
-    const double abs_x = absNoLibm(x);
-    const double clip_start = threshold - knee;
-
-    if (knee < 1.0e-9)
-        return (x > threshold) ? threshold : ((x < -threshold) ? -threshold : x);
-
-    if (abs_x < clip_start)
-        return x;
-
-    const double sign = (x > 0.0) ? 1.0 : -1.0;
+    if (numSamples <= 0)
+        return;
+    if (kernel == nullptr) [[unlikely]] // prepare 前の呼び出し保険
+        kernel = convo::dsp::activeKernels().softClip;
 
-    double knee_shape = 1.0;
-    if (abs_x < threshold + knee)
+    const __m256d vInf = _mm256_set1_pd(1.0e300);
+    int i = 0;
+    const int vEnd = numSamples / 4 * 4;
+    for (; i < vEnd; i += 4)
     {
-        const double t = (abs_x - clip_start) / (2.0 * knee);
-        knee_shape = t * t * (3.0 - 2.0 * t);
+        const __m256d v = _mm256_loadu_pd(data + i);
+        const __m256d nanMask = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+        const __m256d infMask = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), v), vInf, _CMP_LT_OQ);
+        _mm256_storeu_pd(data + i, _mm256_and_pd(v, _mm256_and_pd(nanMask, infMask)));
     }
-
-    const double linear = abs_x;
-    const double clipped = threshold + knee * fastTanh((abs_x - threshold) / knee);
-
-    const double asymmetric_gain = 1.0 - asymmetry * (1.0 - sign) * 0.5 * knee_shape;
-    return sign * (linear * (1.0 - knee_shape) + clipped * knee_shape) * asymmetric_gain;
-}
-
-void softClipBlockAVX2(double* __restrict data, int numSamples,
-                       double threshold, double knee,
-                       double asymmetry, double& prevSample) noexcept
-{
-    int i = 0;
     for (; i < numSamples; ++i)
-    {
-        double x = data[i];
-
-        if (!isFiniteAndAbsBelowNoLibm(x, 1.0e300))
-            x = 0.0;
+        if (!isFiniteAndAbsBelowNoLibm(data[i], 1.0e300))
+            data[i] = 0.0;
 
-        prevSample = x; // 状態更新のみ（ADAA用にフィールド残す）
-        data[i] = musicalSoftClipScalar(x, threshold, knee, asymmetry);
-    }
+    prevSampleInOut = data[numSamples - 1]; // 状態更新のみ（ADAA用にフィールド残す）
+    kernel(data, numSamples, threshold, knee, asymmetry);
 }
 }
 
@@ -223,6 +191,9 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
         }
     }
 
+    // ★ 段別処理時間: 段の境目で lap し、スコープ終了で 1 件として記録する
+    convo::StageLatencyProbe stageProbe(state.stageLatency, convo::EtwTrace::stageSink());
+
     const bool inputTap = state.analyzerEnabled && (state.analyzerSource == AnalyzerSource::Input);
     const float rawInputLinear = processInput(bufferToFill, numSamples, state.inputHeadroomGain,
                                               inputTap, analyzerFifo);
@@ -249,10 +220,19 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
         juce::FloatVectorOperations::copy(dryBypassBufferDoubleL.get(), alignedL.get(), numSamples);
         juce::FloatVectorOperations::copy(dryBypassBufferDoubleR.get(), alignedR.get(), numSamples);
     }
+    stageProbe.lap(convo::DspStage::Input);
+
+    // ★ Split-rate EQ: EQ→Convolver 順では EQ を processUp 前のベースレートで処理する
+    if (state.eqAtBaseRate && !state.eqFoldedIntoIR)
+    {
+        eqRt().setBypassFromRT(state.eqBypassed); // RT-local shadow に書き込み（publishAtomic の RT 使用禁止のため）
+        eqRt().process(originalBlock, *state.eqParams, state.eqCache);
+        stageProbe.lap(convo::DspStage::Eq);
+    }
 
     if (oversamplingFactor > 1)
     {
-        processBlock = oversampling.processUp(originalBlock, static_cast<int>(originalBlock.getNumChannels()));
+        processBlock = oversampling.processUp(originalBlock, static_cast<int>(originalBlock.getNumChannels()), channelSplitForBlock());
 
         if (processBlock.getNumSamples() == 0 || processBlock.getNumSamples() > static_cast<size_t>(maxInternalBlockSize))
         {
@@ -263,10 +243,12 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
 
         const int numOSSamples = (int)processBlock.getNumSamples();
         auto& dc = dcBlockers();
-        if (processBlock.getNumChannels() > 0)
-            dc.oversampledL.process(processBlock.getChannelPointer(0), numOSSamples);
-        if (processBlock.getNumChannels() > 1)
-            dc.oversampledR.process(processBlock.getChannelPointer(1), numOSSamples);
+        // ★ L/R を 1 本の SIMD 再帰で処理 (UltraHighRateDCBlocker::processStereo)
+        const size_t numOSChannels = processBlock.getNumChannels();
+        dc.oversampledL.processStereo(numOSChannels > 0 ? processBlock.getChannelPointer(0) : nullptr,
+                                      numOSChannels > 1 ? processBlock.getChannelPointer(1) : nullptr,
+                                      numOSSamples, dc.oversampledR);
+        stageProbe.lap(convo::DspStage::OversampleUp);
     }
 
     int numProcSamples = (int)processBlock.getNumSamples();
@@ -277,12 +259,23 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
 
     eqRt().setBypassFromRT(state.eqBypassed); // RT-local shadow に書き込み（publishAtomic の RT 使用禁止のため）
 
+    // ★ パイプライン化 Convolver: バイパス中は遅延リングを無音に戻す (processDouble と同じ)
+    if (state.convBypassed)
+        convolverPipeline.restart();
+
     if (state.order == ProcessingOrder::ConvolverThenEQ)
     {
         if (!state.convBypassed)
-            convolverRt().process(processBlock);
+        {
+            processConvolverStageForState(processBlock, state);
+            stageProbe.lap(convo::DspStage::Convolver);
+        }
 
-        if (!state.eqBypassed)
+        if (state.eqFoldedIntoIR)
+        {
+            // ★ EQ fold: EQ 応答は IR に焼き込み済み (Convolver 段で適用される)
+        }
+        else if (!state.eqBypassed)
         {
             if (eqParamsToUse != nullptr)
             {
@@ -303,10 +296,20 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
         {
             eqRt().process(processBlock);
         }
+        if (!state.eqFoldedIntoIR)
+            stageProbe.lap(convo::DspStage::Eq);
     }
     else
     {
-        if (!state.eqBypassed)
+        if (state.eqFoldedIntoIR)
+        {
+            // ★ EQ fold: EQ 応答は IR に焼き込み済み (Convolver 段で適用される)
+        }
+        else if (state.eqAtBaseRate)
+        {
+            // ★ Split-rate EQ: processUp 前に処理済み
+        }
+        else if (!state.eqBypassed)
         {
             if (eqParamsToUse != nullptr)
             {
@@ -327,6 +330,8 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
         {
             eqRt().process(processBlock);
         }
+        if (!state.eqFoldedIntoIR && !state.eqAtBaseRate)
+            stageProbe.lap(convo::DspStage::Eq);
 
         if (!state.convBypassed)
         {
@@ -338,7 +343,8 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
                     scaleBlockFallback(ptr, (int)processBlock.getNumSamples(), state.convolverInputTrimGain);
                 }
             }
-            convolverRt().process(processBlock);
+            processConvolverStageForState(processBlock, state);
+            stageProbe.lap(convo::DspStage::Convolver);
         }
     }
 
@@ -373,29 +379,23 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
             for (int ch = 0; ch < numProcChannels; ++ch)
             {
                 double* data = processBlock.getChannelPointer(ch);
-                softClipBlockAVX2(data, numProcSamples, clipThreshold, clipKnee, clipAsymmetry,
-                                  history.softClipPrevSample[ch < 2 ? ch : 1]);
+                softClipBlock(softClipKernel, data, numProcSamples, clipThreshold, clipKnee, clipAsymmetry,
+                              history.softClipPrevSample[ch < 2 ? ch : 1]);
             }
         }
         else
         {
-            const int nChOS = static_cast<int>(originalBlock.getNumChannels());
-            auto osBlock = softClipOS.processUp(originalBlock, nChOS);
-            const int osSamples = static_cast<int>(osBlock.getNumSamples());
-            for (int ch = 0; ch < nChOS; ++ch)
-            {
-                double* osData = osBlock.getChannelPointer(ch);
-                softClipBlockAVX2(osData, osSamples, clipThreshold, clipKnee, clipAsymmetry,
-                                  history.softClipPrevSample[ch < 2 ? ch : 1]);
-            }
-            softClipOS.processDown(osBlock, originalBlock, nChOS);
+            processSoftClipLocalOS(originalBlock, clipThreshold, clipKnee, clipAsymmetry);
         }
     }
 
+    stageProbe.lap(convo::DspStage::Output);
+
     if (oversamplingFactor > 1)
     {
-        oversampling.processDown(processBlock, originalBlock, static_cast<int>(originalBlock.getNumChannels()));
+        oversampling.processDown(processBlock, originalBlock, static_cast<int>(originalBlock.getNumChannels()), channelSplitForBlock());
         processBlock = originalBlock;
+        stageProbe.lap(convo::DspStage::OversampleDown);
     }
 
     // ★ B01: Float 版 bypass blend (Double 版と同じ dryBypassBufferDouble を使用)
@@ -446,12 +446,11 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
     if (state.analyzerEnabled && state.analyzerSource == AnalyzerSource::Output)
         pushToFifo(processBlock, analyzerFifo);
 
-    const float outputLinear = measureLevel(originalBlock);
+    // 出力メータは processOutput の健全性検査と同じパスで求めたピーク
+    const float outputLinear = processOutput(bufferToFill, numSamples, state);
     if (outputLevelLinear != nullptr)
         convo::publishAtomic(*outputLevelLinear, outputLinear, std::memory_order_release);
 
-    processOutput(bufferToFill, numSamples, state);
-
     int fadeLeft = ramp.fadeInSamplesLeft;
     if (fadeLeft > 0)
     {
@@ -467,4 +466,5 @@ void AudioEngine::DSPCore::process(const juce::AudioSourceChannelInfo& bufferToF
 
         ramp.fadeInSamplesLeft = fadeLeft - rampThisBlock;
     }
+    stageProbe.lap(convo::DspStage::Output);
 }
@@ -2,21 +2,12 @@
 #include <immintrin.h>
 #include "AudioEngine.h"
 #include "DiagnosticsConfig.h"
+#include "FusedInputStage.h"
 #include "InputBitDepthTransform.h"
+#include "dsp/math/SoftClipBlock.h"
 
 namespace
 {
-inline bool isFiniteNoLibm(double x) noexcept
-{
-    union { double d; uint64_t u; } v { x };
-    return ((v.u >> 52) & 0x7FFu) != 0x7FFu;
-}
-
-inline bool isFiniteAndAbsBelowNoLibm(double x, double threshold) noexcept
-{
-    return isFiniteNoLibm(x) && (absNoLibm(x) < threshold);
-}
-
 inline double absDiffNoLibm(double a, double b) noexcept
 {
     return absNoLibm(a - b);
@@ -36,164 +27,122 @@ inline void scaleBlockFallback(double* data, int numSamples, double gain) noexce
         data[i] *= gain;
 }
 
-inline void sanitizeFiniteChunk(double* data, int count) noexcept
+// ★ 入力段の前半 (変換・除去・クランプ・ピーク計測・ヘッドルーム) を FusedInputStage の 1 パスで回す。
+//   Analyzer タップはヘッドルーム前の波形を見るので、タップ有効かつゲイン ≠ 1 のときだけゲインを後掛けにする
+template <typename Src, typename PushTap>
+double runInputFrontEnd(const Src* srcL, const Src* srcR, double* dstL, double* dstR, int numSamples,
+                        double headroomGain, bool analyzerInputTap, PushTap&& pushTap) noexcept
 {
-    if (data == nullptr || count <= 0)
-        return;
+    convo::input::FusedInputParams params;
+    params.gain = headroomGain;
+    params.denormThreshold = convo::input_transform::kDenormThreshold;
 
-#if defined(__AVX2__)
-    const __m256d vLimit = _mm256_set1_pd(1.0e300);
-    const __m256d vSignMask = _mm256_set1_pd(-0.0);
+    const bool applyGain = absDiffNoLibm(headroomGain, 1.0) > 1e-9;
+    if (applyGain && !analyzerInputTap)
+        return convo::input::runFusedInputStage<true>(srcL, srcR, dstL, dstR, numSamples, params);
 
-    int i = 0;
-    const int simdEnd = (count / 4) * 4;
-    for (; i < simdEnd; i += 4)
-    {
-        __m256d vData = _mm256_loadu_pd(data + i);
-        // |x| < limit かつ NaNでない をマスク
-        __m256d vAbs = _mm256_andnot_pd(vSignMask, vData);
-        __m256d vCmp = _mm256_cmp_pd(vAbs, vLimit, _CMP_LT_OQ);
-        __m256d vNanCmp = _mm256_cmp_pd(vData, vData, _CMP_EQ_OQ);  // NaN→false
-        __m256d vMask = _mm256_and_pd(vCmp, vNanCmp);
-        // マスクが0の位置を0.0に（条件満たさない要素をゼロクリア）
-        __m256d vResult = _mm256_and_pd(vData, vMask);
-        _mm256_storeu_pd(data + i, vResult);
-    }
-    for (; i < count; ++i)
-    {
-        if (!isFiniteAndAbsBelowNoLibm(data[i], 1.0e300))
-            data[i] = 0.0;
-    }
-#else
-    for (int i = 0; i < count; ++i)
+    const double peak = convo::input::runFusedInputStage<false>(srcL, srcR, dstL, dstR, numSamples, params);
+    if (analyzerInputTap)
+        pushTap();
+    if (applyGain)
     {
-        if (!isFiniteAndAbsBelowNoLibm(data[i], 1.0e300))
-            data[i] = 0.0;
+        scaleBlockFallback(dstL, numSamples, headroomGain);
+        scaleBlockFallback(dstR, numSamples, headroomGain);
     }
-#endif
+    return peak;
 }
 
-inline double fastTanh(double x) noexcept
-{
-    constexpr double numA = 10395.0;
-    constexpr double numB = 1260.0;
-    constexpr double numC = 21.0;
-    constexpr double denA = 10395.0;
-    constexpr double denB = 4725.0;
-    constexpr double denC = 210.0;
-    constexpr double clipThreshold = 4.5;
-
-    if (x >= clipThreshold) return 1.0;
-    if (x <= -clipThreshold) return -1.0;
-    const double x2 = x * x;
-
-    const double num = x * (numA + x2 * (numB + x2 * numC));
-    const double den = denA + x2 * (denB + x2 * (denC + x2));
-    return num / den;
 }
 
-inline double musicalSoftClipScalar(double x, double threshold, double knee, double asymmetry) noexcept
+void AudioEngine::DSPCore::pushToFifo(const juce::dsp::AudioBlock<const double>& block,
+                                      LockFreeAudioRingBuffer& analyzerFifo) const noexcept
 {
-    const double abs_x = absNoLibm(x);
-    const double clip_start = threshold - knee;
+    analyzerFifo.push(block);
+}
 
-    if (knee < 1.0e-9)
-        return (x > threshold) ? threshold : ((x < -threshold) ? -threshold : x);
+void AudioEngine::DSPCore::pushAdaptiveCapture(const ProcessingState& state,
+                                               const double* left,
+                                               const double* right,
+                                               int numSamples) noexcept
+{
+    auto* captureQueue = state.adaptiveCaptureQueue;
+    if (captureQueue == nullptr || left == nullptr || numSamples <= 0)
+    {
+        // キャプチャ停止中の持ち越しを次のセッションへ混ぜない
+        captureCyclePosition = 0;
+        captureCarriedSamples = 0;
+        return;
+    }
 
-    if (abs_x < clip_start)
-        return x;
+    // 持ち越しは学習器が長時間 drain しない場合でも int を溢れさせない
+    static constexpr int kMaxCarriedSamples = 1 << 30;
+    const int stride = std::clamp(state.adaptiveCaptureStride, 1, kAdaptiveCaptureMaxStride);
+    const int cycleBlocks = kAdaptiveCaptureBurstBlocks * stride;
 
-    const double sign = (x > 0.0) ? 1.0 : -1.0;
+    // ★ 一括書き込み: 折り返しまでの空きスロットを予約してその場で埋め、コールバックあたり 1〜2 回の
+    //   release で公開する (ブロック毎の acquire/release をやめる)
+    AudioBlock* slots = nullptr;
+    size_t reservedSlots = 0;
+    size_t filledSlots = 0;
 
-    double knee_shape = 1.0;
-    if (abs_x < threshold + knee)
+    for (int offset = 0; offset < numSamples; offset += AudioBlock::kMaxSamples)
     {
-        const double t = (abs_x - clip_start) / (2.0 * knee);
-        knee_shape = t * t * (3.0 - 2.0 * t);
-    }
+        const int currentBlockSize = std::min(AudioBlock::kMaxSamples, numSamples - offset);
+        const bool inBurst = captureCyclePosition < kAdaptiveCaptureBurstBlocks;
+        if (++captureCyclePosition >= cycleBlocks)
+            captureCyclePosition = 0;
 
-    const double linear = abs_x;
-    const double clipped = threshold + knee * fastTanh((abs_x - threshold) / knee);
+        if (!inBurst)
+        {
+            captureCarriedSamples = std::min(captureCarriedSamples + currentBlockSize, kMaxCarriedSamples);
+            continue;
+        }
 
-    const double asymmetric_gain = 1.0 - asymmetry * (1.0 - sign) * 0.5 * knee_shape;
-    return sign * (linear * (1.0 - knee_shape) + clipped * knee_shape) * asymmetric_gain;
-}
+        if (filledSlots == reservedSlots)
+        {
+            if (filledSlots > 0)
+                captureQueue->commitWrite(filledSlots);
+            const int remainingBlocks = (numSamples - offset + AudioBlock::kMaxSamples - 1) / AudioBlock::kMaxSamples;
+            slots = captureQueue->reserveWrite(static_cast<size_t>(remainingBlocks), reservedSlots);
+            filledSlots = 0;
+        }
 
-inline void pushAdaptiveCaptureBlocks(LockFreeRingBuffer<AudioBlock, 4096>* captureQueue,
-                                      const double* left,
-                                      const double* right,
-                                      int numSamples,
-                                      int sampleRateHz,
-                                      int bitDepth,
-                                      int adaptiveCoeffBankIndex,
-                                      uint64_t captureSessionId) noexcept
-{
-    if (captureQueue == nullptr || left == nullptr || numSamples <= 0)
-        return;
+        if (slots == nullptr)
+        {
+            // Audio Thread では side-channel atomic 書き込みを行わない。
+            // キュー満杯時は音声だけ捨て、再生時間は次に書けたブロックへ持ち越す
+            captureCarriedSamples = std::min(captureCarriedSamples + currentBlockSize, kMaxCarriedSamples);
+            continue;
+        }
 
-    static constexpr int kBlockSize = 256;
-    for (int offset = 0; offset < numSamples; offset += kBlockSize)
-    {
-        const int currentBlockSize = std::min(kBlockSize, numSamples - offset);
         const double* srcL = left + offset;
         const double* srcR = (right != nullptr) ? (right + offset) : srcL;
 
-        if (!captureQueue->pushWithWriter([&](AudioBlock& block) noexcept
+        AudioBlock& block = slots[filledSlots++];
+        block.numSamples = currentBlockSize;
+        block.representedSamples = currentBlockSize + captureCarriedSamples;
+        block.sampleRateHz = state.adaptiveCaptureSampleRateHz;
+        block.bitDepth = state.adaptiveCaptureBitDepth;
+        block.adaptiveCoeffBankIndex = state.adaptiveCoeffBankIndex;
+        block.sessionId = state.captureSessionId;
+
+        const int simdCount = currentBlockSize & ~3;
+        int i = 0;
+        for (; i < simdCount; i += 4)
         {
-            block.numSamples = currentBlockSize;
-            block.sampleRateHz = sampleRateHz;
-            block.bitDepth = bitDepth;
-            block.adaptiveCoeffBankIndex = adaptiveCoeffBankIndex;
-            block.sessionId = captureSessionId;
-
-            const int simdCount = currentBlockSize & ~3;
-            int i = 0;
-
-            for (; i < simdCount; i += 4)
-            {
-                __m256d v = _mm256_loadu_pd(srcL + i);
-                _mm256_storeu_pd(block.L + i, v);
-            }
-            for (; i < currentBlockSize; ++i)
-                block.L[i] = srcL[i];
-
-            i = 0;
-            for (; i < simdCount; i += 4)
-            {
-                __m256d v = _mm256_loadu_pd(srcR + i);
-                _mm256_storeu_pd(block.R + i, v);
-            }
-            for (; i < currentBlockSize; ++i)
-                block.R[i] = srcR[i];
-        }))
+            _mm_storeu_ps(block.L + i, _mm256_cvtpd_ps(_mm256_loadu_pd(srcL + i)));
+            _mm_storeu_ps(block.R + i, _mm256_cvtpd_ps(_mm256_loadu_pd(srcR + i)));
+        }
+        for (; i < currentBlockSize; ++i)
         {
-            // Audio Thread では side-channel atomic 書き込みを行わない。
-            // キュー満杯時は静かにドロップする（従来挙動維持）。
+            block.L[i] = static_cast<float>(srcL[i]);
+            block.R[i] = static_cast<float>(srcR[i]);
         }
+        captureCarriedSamples = 0;
     }
-}
-}
-
-float AudioEngine::DSPCore::measureLevel (const juce::dsp::AudioBlock<const double>& block) const noexcept
-{
-    double maxLevel = 0.0;
-    const int numChannels = (int)block.getNumChannels();
-    const int numSamples = (int)block.getNumSamples();
-
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(ch), numSamples);
-        const double level = std::max(absNoLibm(range.getStart()), absNoLibm(range.getEnd()));
-        if (level > maxLevel) maxLevel = level;
-    }
-
-    return static_cast<float>(maxLevel);
-}
 
-void AudioEngine::DSPCore::pushToFifo(const juce::dsp::AudioBlock<const double>& block,
-                                      LockFreeAudioRingBuffer& analyzerFifo) const noexcept
-{
-    analyzerFifo.push(block);
+    if (filledSlots > 0)
+        captureQueue->commitWrite(filledSlots);
 }
 
 float AudioEngine::DSPCore::processInput(const juce::AudioSourceChannelInfo& bufferToFill, int numSamples,
@@ -204,49 +153,23 @@ float AudioEngine::DSPCore::processInput(const juce::AudioSourceChannelInfo& buf
     auto* buffer = bufferToFill.buffer;
     const int startSample = bufferToFill.startSample;
     const int effectiveInputChannels = std::min(buffer->getNumChannels(), 2);
-
-    for (int ch = 0; ch < effectiveInputChannels; ++ch)
-    {
-        const float* src = buffer->getReadPointer(ch, startSample);
-        double* dst = (ch == 0) ? alignedL.get() : alignedR.get();
-        convo::input_transform::convertFloatToDoubleHighQuality(src, dst, numSamples, 1.0);
-    }
-
-    const bool expandMono = (effectiveInputChannels == 1);
-    const int clearStartCh = expandMono ? 2 : effectiveInputChannels;
-
-    for (int ch = clearStartCh; ch < 2; ++ch)
-    {
-        double* dst = (ch == 0) ? alignedL.get() : alignedR.get();
-        juce::FloatVectorOperations::clear(dst, numSamples);
-    }
-
-    if (expandMono)
-        juce::FloatVectorOperations::copy(alignedR.get(), alignedL.get(), numSamples);
-
-    sanitizeFiniteChunk(alignedL.get(), numSamples);
-    sanitizeFiniteChunk(alignedR.get(), numSamples);
-
-    double* channels[2] = { alignedL.get(), alignedR.get() };
-    juce::dsp::AudioBlock<double> block(channels, 2, numSamples);
-    const float inputLevel = measureLevel(block);
-
-    if (analyzerInputTap)
-        pushToFifo(block, analyzerFifo);
-
-    if (absDiffNoLibm(headroomGain, 1.0) > 1e-9)
-    {
-        for (int ch = 0; ch < 2; ++ch)
-            scaleBlockFallback(block.getChannelPointer(ch), numSamples, headroomGain);
-    }
+    const float* srcL = (effectiveInputChannels > 0) ? buffer->getReadPointer(0, startSample) : nullptr;
+    const float* srcR = (effectiveInputChannels > 1) ? buffer->getReadPointer(1, startSample) : nullptr;
 
     double* lPtr = alignedL.get();
     double* rPtr = alignedR.get();
+    const auto pushInputTap = [&]
+    {
+        double* channels[2] = { lPtr, rPtr };
+        pushToFifo(juce::dsp::AudioBlock<double>(channels, 2, numSamples), analyzerFifo);
+    };
+    const double inputLevel = runInputFrontEnd(srcL, srcR, lPtr, rPtr, numSamples,
+                                               headroomGain, analyzerInputTap, pushInputTap);
+
     auto& dc = dcBlockers();
-    dc.inputL.process(lPtr, numSamples);
-    dc.inputR.process(rPtr, numSamples);
+    dc.inputL.processStereo(lPtr, rPtr, numSamples, dc.inputR);
 
-    return inputLevel;
+    return static_cast<float>(inputLevel);
 }
 
 float AudioEngine::DSPCore::processInputDouble(const juce::AudioBuffer<double>& buffer, int numSamples,
@@ -255,93 +178,36 @@ float AudioEngine::DSPCore::processInputDouble(const juce::AudioBuffer<double>&
                                                LockFreeAudioRingBuffer& analyzerFifo) noexcept
 {
     const int effectiveInputChannels = std::min(buffer.getNumChannels(), 2);
-
-    for (int ch = 0; ch < effectiveInputChannels; ++ch)
-    {
-        const double* src = buffer.getReadPointer(ch);
-        double* dst = (ch == 0) ? alignedL.get() : alignedR.get();
-        convo::input_transform::convertDoubleToDoubleHighQuality(src, dst, numSamples, 1.0);
-    }
-
-    const bool expandMono = (effectiveInputChannels == 1);
-    const int clearStartCh = expandMono ? 2 : effectiveInputChannels;
-
-    for (int ch = clearStartCh; ch < 2; ++ch)
-    {
-        double* dst = (ch == 0) ? alignedL.get() : alignedR.get();
-        juce::FloatVectorOperations::clear(dst, numSamples);
-    }
-
-    if (expandMono)
-        std::memcpy(alignedR.get(), alignedL.get(), numSamples * sizeof(double));
-
-    sanitizeFiniteChunk(alignedL.get(), numSamples);
-    sanitizeFiniteChunk(alignedR.get(), numSamples);
-
-    double* channels[2] = { alignedL.get(), alignedR.get() };
-    juce::dsp::AudioBlock<double> block(channels, 2, numSamples);
-    const float inputLevel = measureLevel(block);
-
-    if (analyzerInputTap)
-        pushToFifo(block, analyzerFifo);
-
-    if (absDiffNoLibm(headroomGain, 1.0) > 1e-9)
-    {
-        for (int ch = 0; ch < 2; ++ch)
-            scaleBlockFallback(block.getChannelPointer(ch), numSamples, headroomGain);
-    }
+    const double* srcL = (effectiveInputChannels > 0) ? buffer.getReadPointer(0) : nullptr;
+    const double* srcR = (effectiveInputChannels > 1) ? buffer.getReadPointer(1) : nullptr;
 
     double* lPtr = alignedL.get();
     double* rPtr = alignedR.get();
-    auto& dc = dcBlockers();
-    dc.inputL.process(lPtr, numSamples);
-    dc.inputR.process(rPtr, numSamples);
-
-    return inputLevel;
-}
-
-void AudioEngine::DSPCore::applyFixedLatencyDelay(double* dataL, double* dataR, int numSamples) noexcept
-{
-    auto& history = histories();
-    if (history.fixedLatencySamples <= 0 || history.fixedLatencyBufferSize <= 0 || dataL == nullptr)
-        return;
-
-    const int delay = std::min(history.fixedLatencySamples, history.fixedLatencyBufferSize - 1);
-    int writePos = history.fixedLatencyWritePos;
-    const int bufferSize = history.fixedLatencyBufferSize;
-    double* delayL = history.fixedLatencyBufferL.get();
-    double* delayR = history.fixedLatencyBufferR.get();
-
-    for (int i = 0; i < numSamples; ++i)
+    const auto pushInputTap = [&]
     {
-        delayL[writePos] = dataL[i];
-        if (dataR != nullptr)
-            delayR[writePos] = dataR[i];
+        double* channels[2] = { lPtr, rPtr };
+        pushToFifo(juce::dsp::AudioBlock<double>(channels, 2, numSamples), analyzerFifo);
+    };
+    const double inputLevel = runInputFrontEnd(srcL, srcR, lPtr, rPtr, numSamples,
+                                               headroomGain, analyzerInputTap, pushInputTap);
 
-        int readPos = writePos - delay;
-        while (readPos < 0)
-            readPos += bufferSize;
-
-        dataL[i] = delayL[readPos];
-        if (dataR != nullptr)
-            dataR[i] = delayR[readPos];
-
-        ++writePos;
-        if (writePos >= bufferSize)
-            writePos = 0;
-    }
+    auto& dc = dcBlockers();
+    dc.inputL.processStereo(lPtr, rPtr, numSamples, dc.inputR);
 
-    history.fixedLatencyWritePos = writePos;
+    return static_cast<float>(inputLevel);
 }
 
 double AudioEngine::DSPCore::musicalSoftClip(double x, double threshold, double knee, double asymmetry) noexcept
 {
-    return musicalSoftClipScalar(x, threshold, knee, asymmetry);
+    // 1 サンプル版もブロック API (SoftClipBlock.h) のスカラー参照を使い、KernelDispatch と同じ値を返す
+    double y = x;
+    convo::dsp::softClipBlockScalar<convo::dsp::SoftClipPadéPolicy>(&y, 1, threshold, knee, asymmetry);
+    return y;
 }
 
-void AudioEngine::DSPCore::processOutput(const juce::AudioSourceChannelInfo& bufferToFill,
-                                         int numSamples,
-                                         const ProcessingState& state) noexcept
+float AudioEngine::DSPCore::processOutput(const juce::AudioSourceChannelInfo& bufferToFill,
+                                          int numSamples,
+                                          const ProcessingState& state) noexcept
 {
     auto* buffer = bufferToFill.buffer;
     const int startSample = bufferToFill.startSample;
@@ -354,7 +220,7 @@ void AudioEngine::DSPCore::processOutput(const juce::AudioSourceChannelInfo& buf
     {
         if (numSamples > 0)
             bufferToFill.clearActiveBufferRegion();
-        return;
+        return 0.0f;
     }
 
     double* dataL = (numChannels > 0) ? alignedL.get() : nullptr;
@@ -365,58 +231,19 @@ void AudioEngine::DSPCore::processOutput(const juce::AudioSourceChannelInfo& buf
     if (dataL == nullptr || dstL == nullptr)
     {
         bufferToFill.clearActiveBufferRegion();
-        return;
+        return 0.0f;
     }
 
     auto& dc = dcBlockers();
-    dc.outputL.process(dataL, numSamples);
-    if (dataR) dc.outputR.process(dataR, numSamples);
+    dc.outputL.processStereo(dataL, dataR, numSamples, dc.outputR);
 
-    {
-        const __m256d vInf = _mm256_set1_pd(1.0e300);
-        int i = 0;
-        const int vEnd = numSamples / 4 * 4;
-        for (; i < vEnd; i += 4)
-        {
-            __m256d vL = _mm256_loadu_pd(dataL + i);
-            __m256d nanMaskL = _mm256_cmp_pd(vL, vL, _CMP_ORD_Q);
-            __m256d infMaskL = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), vL), vInf, _CMP_LT_OQ);
-            __m256d maskL = _mm256_and_pd(nanMaskL, infMaskL);
-            vL = _mm256_and_pd(vL, maskL);
-            _mm256_storeu_pd(dataL + i, vL);
-
-            if (dataR)
-            {
-                __m256d vR = _mm256_loadu_pd(dataR + i);
-                __m256d nanMaskR = _mm256_cmp_pd(vR, vR, _CMP_ORD_Q);
-                __m256d infMaskR = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), vR), vInf, _CMP_LT_OQ);
-                __m256d maskR = _mm256_and_pd(nanMaskR, infMaskR);
-                vR = _mm256_and_pd(vR, maskR);
-                _mm256_storeu_pd(dataR + i, vR);
-            }
-        }
-        for (; i < numSamples; ++i)
-        {
-            double v = dataL[i];
-            if (!isFiniteAndAbsBelowNoLibm(v, 1.0e300)) v = 0.0;
-            dataL[i] = v;
-            if (dataR)
-            {
-                v = dataR[i];
-                if (!isFiniteAndAbsBelowNoLibm(v, 1.0e300)) v = 0.0;
-                dataR[i] = v;
-            }
-        }
-    }
+    // ★ 健全性検査 (NaN/Inf・発散の除去) と出力メータのピークを 1 パスで求める (BlockHealthScan.h)。
+    //   チェーン内の検査点はここだけで、不正サンプルがあれば上流の状態を持つ段を戻す
+    const auto health = convo::health::scanAndScrubStereo<false>(dataL, dataR, numSamples);
+    if (health.isCorrupted()) [[unlikely]]
+        recoverFromCorruptedOutput();
 
-    pushAdaptiveCaptureBlocks(state.adaptiveCaptureQueue,
-                              dataL,
-                              dataR,
-                              numSamples,
-                              state.adaptiveCaptureSampleRateHz,
-                              state.adaptiveCaptureBitDepth,
-                              state.adaptiveCoeffBankIndex,
-                              state.captureSessionId);
+    pushAdaptiveCapture(state, dataL, dataR, numSamples);
 
     if (noiseShaperType == NoiseShaperType::Adaptive9thOrder
         && state.adaptiveCoeffSet != nullptr
@@ -456,59 +283,44 @@ void AudioEngine::DSPCore::processOutput(const juce::AudioSourceChannelInfo& buf
         else
             dither.processStereoBlock(dataL, dataR, numSamples, kOutputHeadroom);
     }
-    else
-    {
-        for (int i = 0; i < numSamples; ++i) dataL[i] *= kOutputHeadroom;
-        if (dataR)
-            for (int i = 0; i < numSamples; ++i) dataR[i] *= kOutputHeadroom;
-    }
 
-    {
-        const __m256d vInf = _mm256_set1_pd(1.0e300);
-        int i = 0;
-        const int vEnd = numSamples / 4 * 4;
-        for (; i < vEnd; i += 4)
-        {
-            __m256d vL = _mm256_loadu_pd(dataL + i);
-            __m256d nanMaskL = _mm256_cmp_pd(vL, vL, _CMP_ORD_Q);
-            __m256d infMaskL = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), vL), vInf, _CMP_LT_OQ);
-            __m256d maskL = _mm256_and_pd(nanMaskL, infMaskL);
-            vL = _mm256_and_pd(vL, maskL);
-            _mm256_storeu_pd(dataL + i, vL);
-
-            if (dataR)
-            {
-                __m256d vR = _mm256_loadu_pd(dataR + i);
-                __m256d nanMaskR = _mm256_cmp_pd(vR, vR, _CMP_ORD_Q);
-                __m256d infMaskR = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), vR), vInf, _CMP_LT_OQ);
-                __m256d maskR = _mm256_and_pd(nanMaskR, infMaskR);
-                vR = _mm256_and_pd(vR, maskR);
-                _mm256_storeu_pd(dataR + i, vR);
-            }
-        }
-        for (; i < numSamples; ++i)
-        {
-            double v = dataL[i];
-            if (!isFiniteAndAbsBelowNoLibm(v, 1.0e300)) v = 0.0;
-            dataL[i] = v;
-            if (dataR)
-            {
-                v = dataR[i];
-                if (!isFiniteAndAbsBelowNoLibm(v, 1.0e300)) v = 0.0;
-                dataR[i] = v;
-            }
-        }
-    }
-
-    applyFixedLatencyDelay(dataL, dataR, numSamples);
+    // ★ Peak Limiter (processOutputDouble と同じ threshold / knee)。ディザなしならヘッドルームと NaN/Inf 除去も
+    //   遅延線への書き込み時に済ませる。ディザ時のヘッドルームはシェーパーが適用済み
+    constexpr double kPLThreshold = 0.8413951287507587;
+    constexpr double kPLKnee = 0.108748;
+    peakLimiter.processBlock(dataL, dataR, numSamples, applyDither ? 1.0 : kOutputHeadroom, kPLThreshold, kPLKnee);
 
-    for (int i = 0; i < numSamples; ++i)
-        dstL[i] = static_cast<float>(juce::jlimit(-kOutputHeadroom, kOutputHeadroom, dataL[i]));
-
-    if (dstR)
-        for (int i = 0; i < numSamples; ++i)
-            dstR[i] = static_cast<float>(juce::jlimit(-kOutputHeadroom, kOutputHeadroom, dataR[i]));
+    // ★ リミッタ以降 (クランプ → 固定レイテンシ遅延 → float 変換) を 1 パスで回し、デバイスバッファへ直接書く (FusedOutputStage.h)
+    //   整数 ASIO デバイスでは deviceCodeGain も同じパスで掛ける (processOutputDouble と同じ、DeviceOutputCodec.h)
+    auto& history = histories();
+    auto delay = history.fixedLatencyDelay();
+    convo::output::FusedOutputParams outputParams;
+    outputParams.gain = state.deviceCodeGain;
+    outputParams.limit = kOutputHeadroom * state.deviceCodeGain;
+    if (state.deviceCodeGain != 1.0)
+        convo::output::runFusedOutputStage<true, false>(dataL, dataR, dstL, dstR, numSamples, outputParams, delay);
+    else
+        convo::output::runFusedOutputStage<false, false>(dataL, dataR, dstL, dstR, numSamples, outputParams, delay);
+    history.fixedLatencyWritePos = delay.writePos;
 
     for (int ch = numChannels; ch < buffer->getNumChannels(); ++ch)
         buffer->clear(ch, startSample, numSamples);
+
+    return static_cast<float>(health.peak);
+}
+
+void AudioEngine::DSPCore::recoverFromCorruptedOutput() noexcept
+{
+    // OS (入力 OS / SoftClip 局所 2 倍 OS) の decimate 履歴: 次の processDown 冒頭の自動クリア
+    // (連続時はハードフォールバック) に任せる。SoftClip OS は未使用ならフラグが残るだけ
+    if (oversamplingFactor > 1)
+        oversampling.reportDownstreamCorruption();
+    softClipOS.reportDownstreamCorruption();
+
+    // DC ブロッカと誤差帰還を持つ段は状態を捨てるだけで戻る (いずれも Audio Thread 可)
+    dcBlockers().reset();
+    dither.reset();
+    fixedNoiseShaper.reset();
+    fixed15TapNoiseShaper.reset();
+    adaptiveNoiseShaper.reset();
 }
@@ -2,6 +2,7 @@
 #include "AudioEngine.h"
 #include "DiagnosticsConfig.h"
 #include "OversamplingPolicy.h"
+#include <bit>
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
 namespace {
@@ -33,6 +34,74 @@ namespace
     {
         -0.003796, -0.006752, 0.008418, -0.010546, 0.004716, -0.007624, -0.020750, -0.002049, -0.003632
     };
+
+    CustomInputOversampler::Preset toOversamplerPreset(convo::OversamplingType type) noexcept
+    {
+        switch (type)
+        {
+            case convo::OversamplingType::LinearPhase:  return CustomInputOversampler::Preset::LinearPhase;
+            case convo::OversamplingType::MinimumPhase: return CustomInputOversampler::Preset::MinimumPhase;
+            case convo::OversamplingType::IIR:
+            default:                                    return CustomInputOversampler::Preset::IIRLike;
+        }
+    }
+
+    CustomInputOversampler::StagePrecision toStagePrecision(bool singlePrecision) noexcept
+    {
+        return singlePrecision ? CustomInputOversampler::StagePrecision::Float32UpperStages
+                               : CustomInputOversampler::StagePrecision::Double;
+    }
+
+    // float32 段が有効なとき、同条件の double 構成との最大誤差 (dBFS) をログに残す
+    void logSinglePrecisionError(const CustomInputOversampler& os, int ratio, CustomInputOversampler::Preset preset)
+    {
+        if (!os.isSinglePrecisionActive())
+            return;
+
+        const auto report = CustomInputOversampler::measureSinglePrecisionError(ratio, preset);
+        const auto toDb = [](double v) { return juce::Decibels::gainToDecibels(v, -300.0); };
+        juce::Logger::writeToLog("[DSPCORE_PREPARE] oversampling float32 stages: valid=" + juce::String(report.valid ? 1 : 0)
+                                 + " maxErrUp=" + juce::String(toDb(report.maxAbsErrorUp), 1) + "dBFS"
+                                 + " maxErrRoundTrip=" + juce::String(toDb(report.maxAbsErrorRoundTrip), 1) + "dBFS");
+    }
+
+    // SoftClip 局所2倍OS: MinimumPhase ではモニタリング遅延を抑えるため全域通過ハーフバンド 1 段を使う
+    void prepareSoftClipOversampler(CustomInputOversampler& os, convo::OversamplingType type, int maxBlock)
+    {
+        if (type == convo::OversamplingType::MinimumPhase)
+            os.prepare(maxBlock, 2, CustomInputOversampler::Preset::MinimumPhase);
+        else
+            os.prepareSingleStage(31, 90.0, maxBlock);
+    }
+
+    // ★ Adaptive SoftClip OS: 1x 経路の遅延は局所 OS にインパルスを通して山の位置で実測する
+    //   (up / down とも対称 FIR なので合成応答の山は整数位置に立つ)。全域通過 IIR (MinimumPhase) は
+    //   位相が周波数依存で遅延線と揃わないため使わない。1x へ落とすまでの静かな区間は 100 ms
+    void prepareSoftClipRoute(convo::AdaptiveSoftClipRoute& route, CustomInputOversampler& os,
+                              convo::OversamplingType type, double sampleRate, int maxBlock)
+    {
+        route.release();
+        if (type == convo::OversamplingType::MinimumPhase || maxBlock <= 0)
+            return;
+
+        const int n = std::min(maxBlock, convo::AdaptiveSoftClipRoute::kMaxHistory);
+        std::vector<double> response(static_cast<size_t>(n), 0.0);
+        response[0] = 1.0;
+        double* channels[1] = { response.data() };
+        juce::dsp::AudioBlock<double> block(channels, 1, static_cast<size_t>(n));
+        auto upBlock = os.processUp(block, 1);
+        os.processDown(upBlock, block, 1);
+        os.clearUpHistories();
+        os.clearDownHistories();
+
+        const auto peak = std::max_element(response.begin(), response.end(),
+                                           [](double a, double b) { return std::abs(a) < std::abs(b); });
+        if (!(std::abs(*peak) > 0.5))
+            return;
+        const int latency = static_cast<int>(peak - response.begin());
+        const int prime = os.getUpRingOutBaseSamples() + os.getDownRingOutBaseSamples();
+        route.prepare(maxBlock, latency, prime, static_cast<int>(sampleRate * 0.1));
+    }
 }
 
 std::atomic<std::uint64_t> AudioEngine::DSPCore::runtimeUuidCounterStorage_{ 1 };
@@ -67,9 +136,15 @@ AudioEngine::DSPCore::DSPCore()
 #endif
     convolverState->bind(convolver);
     eqState->bind(eq);
+
+    // 全ノイズシェーパーのディザを共用プールから供給する (補充は AudioEngine::timerCallback)
+    dither.setNoisePool(&ditherNoise);
+    fixedNoiseShaper.setNoisePool(&ditherNoise);
+    fixed15TapNoiseShaper.setNoisePool(&ditherNoise);
+    adaptiveNoiseShaper.setNoisePool(&ditherNoise);
 }
 
-void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, int bitDepth, int manualOversamplingFactor, OversamplingType oversamplingType, NoiseShaperType selectedNoiseShaperType, AudioEngine* owner)
+void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, int bitDepth, int manualOversamplingFactor, OversamplingType oversamplingType, bool oversamplingSinglePrecision, NoiseShaperType selectedNoiseShaperType, AudioEngine* owner)
 {
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
     const double prepareStartMs = juce::Time::getMillisecondCounterHiRes();
@@ -81,6 +156,9 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     juce::Logger::writeToLog("[DSPCORE_PREPARE] enter");
 #endif
 
+    // 再 prepare: ワーカーが旧バッファ・旧 convolver 状態を触らないよう先に止める (再起動は rebuild thread)
+    convolverPipeline.stop();
+
     // Route EQ and Convolver retirement through AudioEngine's coordinator
     if (owner != nullptr)
     {
@@ -130,12 +208,13 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     oversamplingFactor = (size_t)1 << factorLog2;
     activeOversamplingType = oversamplingType;
 
-    constexpr int MAX_OS_FACTOR = 8;
     // ★ v8.3: PrepareBlockSizingPolicy を使用（SAFE_MAX_BLOCK_SIZE floor を廃止）
+    // 内部ブロックは解決済みの係数ぶんだけ (processDouble/Float は × oversamplingFactor を超える入力を捨てる)
     const int inputMaxBlock     = AudioEngine::PrepareBlockSizingPolicy::apply(samplesPerBlock);
-    const int internalMaxBlock  = inputMaxBlock * MAX_OS_FACTOR;
+    const int internalMaxBlock  = inputMaxBlock * static_cast<int>(oversamplingFactor);
     maxSamplesPerBlock   = inputMaxBlock;
     maxInternalBlockSize = internalMaxBlock;
+    preparedHostBlockSize = samplesPerBlock;
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
     diagLog("[DSPCORE_PREPARE] blockCalc: inputMaxBlock=" + juce::String(inputMaxBlock) + " internalMaxBlock=" + juce::String(internalMaxBlock));
@@ -147,12 +226,13 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     juce::Logger::writeToLog("[DSPCORE_PREPARE] allocating aligned buffers: required=" + juce::String(internalMaxBlock));
 #endif
 
+    // ★ RT 常駐: ロック (またはラージページ) 済み・ゼロ初期化済みで返るため clear は不要
     if (newRequired > alignedCapacity || !alignedL || !alignedR)
     {
-        auto newL = convo::makeAlignedArray<double>(static_cast<size_t>(newRequired));
-        auto newR = convo::makeAlignedArray<double>(static_cast<size_t>(newRequired));
-        juce::FloatVectorOperations::clear(newL.get(), newRequired);
-        juce::FloatVectorOperations::clear(newR.get(), newRequired);
+        auto newL = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(newRequired));
+        auto newR = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(newRequired));
+        if (!newL || !newR)
+            throw std::bad_alloc();
         alignedL = std::move(newL);
         alignedR = std::move(newR);
         alignedCapacity = newRequired;
@@ -160,15 +240,30 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
 
     if (newRequired > dryBypassCapacityDouble || !dryBypassBufferDoubleL || !dryBypassBufferDoubleR)
     {
-        auto newDryL = convo::makeAlignedArray<double>(static_cast<size_t>(newRequired));
-        auto newDryR = convo::makeAlignedArray<double>(static_cast<size_t>(newRequired));
-        juce::FloatVectorOperations::clear(newDryL.get(), newRequired);
-        juce::FloatVectorOperations::clear(newDryR.get(), newRequired);
+        auto newDryL = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(newRequired));
+        auto newDryR = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(newRequired));
+        if (!newDryL || !newDryR)
+            throw std::bad_alloc();
         dryBypassBufferDoubleL = std::move(newDryL);
         dryBypassBufferDoubleR = std::move(newDryR);
         dryBypassCapacityDouble = newRequired;
     }
 
+    if (newRequired > stageFadeScratchCapacity || !stageFadeScratchL || !stageFadeScratchR)
+    {
+        auto newScratchL = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(newRequired));
+        auto newScratchR = convo::makeResidentArray_nothrow<double>(static_cast<size_t>(newRequired));
+        if (!newScratchL || !newScratchR)
+            throw std::bad_alloc();
+        stageFadeScratchL = std::move(newScratchL);
+        stageFadeScratchR = std::move(newScratchR);
+        stageFadeScratchCapacity = newRequired;
+    }
+
+    // Audio Thread が参照する SoftClip / ピーク検出カーネルを確定 (以後テーブルは引かない)
+    softClipKernel = convo::dsp::activeKernels().softClip;
+    peakAbsKernel = convo::dsp::activeKernels().peakAbs;
+
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
     diagLog("[DSPCORE_PREPARE] aligned buffers done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
 
@@ -180,12 +275,14 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     diagLog("[DSPCORE_PREPARE] ramp.prepare done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
 
     { double t0 = juce::Time::getMillisecondCounterHiRes(); diagLog("[DSPCORE_PREPARE] calling oversampling.prepare");
-    oversampling.prepare(inputMaxBlock, static_cast<int>(oversamplingFactor),
-        (oversamplingType == OversamplingType::LinearPhase) ? CustomInputOversampler::Preset::LinearPhase : CustomInputOversampler::Preset::IIRLike);
-    diagLog("[DSPCORE_PREPARE] oversampling.prepare done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
+    oversampling.prepare(inputMaxBlock, static_cast<int>(oversamplingFactor), toOversamplerPreset(oversamplingType),
+                         toStagePrecision(oversamplingSinglePrecision));
+    diagLog("[DSPCORE_PREPARE] oversampling.prepare done: " + juce::String(elapsedSince(t0), 2) + "ms");
+    logSinglePrecisionError(oversampling, static_cast<int>(oversamplingFactor), toOversamplerPreset(oversamplingType)); }
 
     { double t0 = juce::Time::getMillisecondCounterHiRes(); diagLog("[DSPCORE_PREPARE] calling softClipOS.prepareSingleStage");
-    softClipOS.prepareSingleStage(31, 90.0, internalMaxBlock);
+    prepareSoftClipOversampler(softClipOS, oversamplingType, internalMaxBlock);
+    prepareSoftClipRoute(softClipRoute, softClipOS, oversamplingType, newSampleRate, internalMaxBlock);
     diagLog("[DSPCORE_PREPARE] softClipOS.prepareSingleStage done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
 
     const double processingRate = newSampleRate * static_cast<double>(oversamplingFactor);
@@ -205,6 +302,7 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     diagLog("[DSPCORE_PREPARE] dcBlockers().init done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
 
     { double t0 = juce::Time::getMillisecondCounterHiRes(); diagLog("[DSPCORE_PREPARE] calling noise shaper prepare: type=" + juce::String(static_cast<int>(selectedNoiseShaperType)));
+    ditherNoise.prepare();
     if (selectedNoiseShaperType == NoiseShaperType::Psychoacoustic) dither.prepare(newSampleRate, bitDepth);
     else if (selectedNoiseShaperType == NoiseShaperType::Fixed4Tap) { fixedNoiseShaper.setCoefficients(kFixedNoiseShaperTunedCoeffs); fixedNoiseShaper.prepare(newSampleRate, bitDepth); }
     else if (selectedNoiseShaperType == NoiseShaperType::Fixed15Tap) { fixed15TapNoiseShaper.setCoefficients(kFixed15TapNoiseShaperTunedCoeffs); fixed15TapNoiseShaper.prepare(newSampleRate, bitDepth); }
@@ -216,16 +314,10 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     outputFilter.prepare(processingRate);
     diagLog("[DSPCORE_PREPARE] outputFilter.prepare done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
 
-    { double t0 = juce::Time::getMillisecondCounterHiRes(); diagLog("[DSPCORE_PREPARE] calling truePeakDetector.prepare");
-    truePeakDetector.prepare(newSampleRate, maxInternalBlockSize);
-    diagLog("[DSPCORE_PREPARE] truePeakDetector.prepare done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
-
-    { double t0 = juce::Time::getMillisecondCounterHiRes(); diagLog("[DSPCORE_PREPARE] calling loudnessMeter.prepare");
-    loudnessMeter.prepare(newSampleRate, maxInternalBlockSize);
-    diagLog("[DSPCORE_PREPARE] loudnessMeter.prepare done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
+    configureSilenceTracker();
 
     { double t0 = juce::Time::getMillisecondCounterHiRes(); diagLog("[DSPCORE_PREPARE] calling peakLimiter.prepare");
-    peakLimiter.prepare(newSampleRate, 100.0); // Release 100ms
+    peakLimiter.prepare(newSampleRate, LookAheadPeakLimiter::kDefaultLookAheadMs, 100.0); // Look-ahead 1ms / Release 100ms
     diagLog("[DSPCORE_PREPARE] peakLimiter.prepare done: " + juce::String(elapsedSince(t0), 2) + "ms"); }
 
     { double t0 = juce::Time::getMillisecondCounterHiRes(); diagLog("[DSPCORE_PREPARE] calling setFixedLatencySamples");
@@ -238,12 +330,15 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     juce::Logger::writeToLog("[DSPCORE_PREPARE] calling ramp.prepare");
     ramp.prepare(newSampleRate);
     juce::Logger::writeToLog("[DSPCORE_PREPARE] ramp.prepare done");
-    const auto osPreset = (oversamplingType == OversamplingType::LinearPhase) ? CustomInputOversampler::Preset::LinearPhase : CustomInputOversampler::Preset::IIRLike;
+    const auto osPreset = toOversamplerPreset(oversamplingType);
     juce::Logger::writeToLog("[DSPCORE_PREPARE] calling oversampling.prepare");
-    oversampling.prepare(inputMaxBlock, static_cast<int>(oversamplingFactor), osPreset);
+    oversampling.prepare(inputMaxBlock, static_cast<int>(oversamplingFactor), osPreset,
+                         toStagePrecision(oversamplingSinglePrecision));
     juce::Logger::writeToLog("[DSPCORE_PREPARE] oversampling.prepare done");
+    logSinglePrecisionError(oversampling, static_cast<int>(oversamplingFactor), osPreset);
     juce::Logger::writeToLog("[DSPCORE_PREPARE] calling softClipOS.prepareSingleStage");
-    softClipOS.prepareSingleStage(31, 90.0, internalMaxBlock);
+    prepareSoftClipOversampler(softClipOS, oversamplingType, internalMaxBlock);
+    prepareSoftClipRoute(softClipRoute, softClipOS, oversamplingType, newSampleRate, internalMaxBlock);
     juce::Logger::writeToLog("[DSPCORE_PREPARE] softClipOS.prepareSingleStage done");
     const double processingRate = newSampleRate * static_cast<double>(oversamplingFactor);
     const int processingBlockSize = samplesPerBlock * static_cast<int>(oversamplingFactor);
@@ -258,6 +353,7 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     dcBlockers().init(newSampleRate, processingRate);
     juce::Logger::writeToLog("[DSPCORE_PREPARE] dcBlockers().init done");
     juce::Logger::writeToLog("[DSPCORE_PREPARE] calling noise shaper prepare: type=" + juce::String(static_cast<int>(selectedNoiseShaperType)));
+    ditherNoise.prepare();
     if (selectedNoiseShaperType == NoiseShaperType::Psychoacoustic) dither.prepare(newSampleRate, bitDepth);
     else if (selectedNoiseShaperType == NoiseShaperType::Fixed4Tap) { fixedNoiseShaper.setCoefficients(kFixedNoiseShaperTunedCoeffs); fixedNoiseShaper.prepare(newSampleRate, bitDepth); }
     else if (selectedNoiseShaperType == NoiseShaperType::Fixed15Tap) { fixed15TapNoiseShaper.setCoefficients(kFixed15TapNoiseShaperTunedCoeffs); fixed15TapNoiseShaper.prepare(newSampleRate, bitDepth); }
@@ -267,14 +363,9 @@ void AudioEngine::DSPCore::prepare(double newSampleRate, int samplesPerBlock, in
     juce::Logger::writeToLog("[DSPCORE_PREPARE] calling outputFilter.prepare");
     outputFilter.prepare(processingRate);
     juce::Logger::writeToLog("[DSPCORE_PREPARE] outputFilter.prepare done");
-    juce::Logger::writeToLog("[DSPCORE_PREPARE] calling truePeakDetector.prepare");
-    truePeakDetector.prepare(newSampleRate, maxInternalBlockSize);
-    juce::Logger::writeToLog("[DSPCORE_PREPARE] truePeakDetector.prepare done");
-    juce::Logger::writeToLog("[DSPCORE_PREPARE] calling loudnessMeter.prepare");
-    loudnessMeter.prepare(newSampleRate, maxInternalBlockSize);
-    juce::Logger::writeToLog("[DSPCORE_PREPARE] loudnessMeter.prepare done");
+    configureSilenceTracker();
     juce::Logger::writeToLog("[DSPCORE_PREPARE] calling peakLimiter.prepare");
-    peakLimiter.prepare(newSampleRate, 100.0); // Release 100ms
+    peakLimiter.prepare(newSampleRate, LookAheadPeakLimiter::kDefaultLookAheadMs, 100.0); // Look-ahead 1ms / Release 100ms
     juce::Logger::writeToLog("[DSPCORE_PREPARE] peakLimiter.prepare done");
     juce::Logger::writeToLog("[DSPCORE_PREPARE] calling setFixedLatencySamples");
     setFixedLatencySamples(0);
@@ -287,6 +378,120 @@ void AudioEngine::DSPCore::setFixedLatencySamples(int samples)
     histories().configureFixedLatencySamples(samples, maxInternalBlockSize);
 }
 
+// ★ 無音スキップ: 各段の ring-out を ChainSilenceTracker へ申告する (oversampling / softClipOS /
+//   dcBlockers / outputFilter の prepare 後に呼ぶこと)
+void AudioEngine::DSPCore::configureSilenceTracker()
+{
+    using Stage = convo::ChainSilenceTracker::Stage;
+
+    // 1 次 DC ブロッカ 2 段: 極は 1 − α (α の小さい方が支配的)
+    const auto dcRingOut = [](const convo::UltraHighRateDCBlocker& blocker)
+    {
+        return convo::ringOutSamplesForPoleRadius(1.0 - std::min(blocker.getAlpha(0), blocker.getAlpha(1)));
+    };
+    const auto& dc = dcBlockers();
+
+    // SoftClip: OS > 1 では無状態 (0 → 0)。OS = 1 では局所 2 倍 OS の up + down 履歴
+    int softClipRingOut = 0;
+    if (oversamplingFactor <= 1)
+    {
+        const std::int64_t osRingOut = static_cast<std::int64_t>(softClipOS.getUpRingOutBaseSamples())
+                                     + softClipOS.getDownRingOutBaseSamples();
+        softClipRingOut = static_cast<int>(std::min<std::int64_t>(osRingOut, convo::kSilenceRingOutNever));
+    }
+
+    silenceTracker.configure(Stage::OversampleUp, oversampling.getUpRingOutBaseSamples());
+    silenceTracker.configure(Stage::OversampledDcBlock, std::max(dcRingOut(dc.oversampledL), dcRingOut(dc.oversampledR)));
+    silenceTracker.configure(Stage::OutputFilter, outputFilter.getRingOutSamples());
+    silenceTracker.configure(Stage::SoftClip, softClipRingOut);
+    silenceTracker.configure(Stage::OversampleDown, oversampling.getDownRingOutBaseSamples());
+}
+
+// ★ パイプライン化 Convolver: Convolver 段を MMCSS 登録した専用ワーカーで 1 ブロック遅れて処理する。
+//   遅延 = デバイスのブロック長 (processing rate では × oversamplingFactor)。PrepareBlockSizingPolicy の
+//   256 下限を使うと 64 サンプルバッファでは 4 ブロック遅れになるため、prepare() に渡された値を使う
+void AudioEngine::DSPCore::configureConvolverPipeline(bool enabled, AudioEngine* owner)
+{
+    convolverPipeline.stop();
+    helperThreadOwner = owner;
+    if (!enabled || owner == nullptr || preparedHostBlockSize <= 0 || sampleRate <= 0.0)
+        return;
+
+    convo::PipelinedStage::Callbacks callbacks;
+    callbacks.process = [](void* context, double* const* channels, int numChannels, int numSamples) noexcept
+    {
+        juce::dsp::AudioBlock<double> block(channels, static_cast<size_t>(numChannels), static_cast<size_t>(numSamples));
+        static_cast<DSPCore*>(context)->convolverRt().process(block);
+    };
+    callbacks.onThreadStart = [](void* context) noexcept
+    {
+        // Tail Worker と同じく MKL はワーカー内で単一スレッド
+        mkl_set_num_threads_local(1);
+        (void)static_cast<DSPCore*>(context)->helperThreadOwner->applyMmcssForDspHelperThread();
+    };
+    callbacks.onThreadExit = [](void* context) noexcept
+    {
+        static_cast<DSPCore*>(context)->helperThreadOwner->revertMmcssOnAudioThread();
+    };
+    callbacks.context = this;
+
+    const int blockSamples = preparedHostBlockSize * static_cast<int>(oversamplingFactor);
+    const double processingRate = sampleRate * static_cast<double>(oversamplingFactor);
+    const bool started = convolverPipeline.start(callbacks, 2, blockSamples, processingRate);
+    juce::Logger::writeToLog("[DSPCORE_PIPELINE] convolver pipeline " + juce::String(started ? "started" : "FAILED")
+                             + ": blockSamples=" + juce::String(blockSamples));
+}
+
+// ★ Channel split: R チャンネルを audioRealtime コア上の helper で回す。helper は Audio Thread と同じ物理コアの
+//   もう一方の論理プロセッサ (SMT) へ載せ、同じ MMCSS タスクで登録する。論理プロセッサが 1 つしか無いマスク・
+//   異種コア環境 (Audio Thread 自体を固定しない) では固定しない。spin 期間はデバイスのブロック周期の 2 倍
+void AudioEngine::DSPCore::configureChannelSplit(bool enabled, AudioEngine* owner)
+{
+    channelSplit.stop();
+    helperThreadOwner = owner;
+    if (!enabled || owner == nullptr || preparedHostBlockSize <= 0 || sampleRate <= 0.0)
+        return;
+
+    convo::ChannelForkJoin::ThreadHooks hooks;
+    hooks.onThreadStart = [](void* context) noexcept
+    {
+        AudioEngine* engine = static_cast<DSPCore*>(context)->helperThreadOwner;
+        mkl_set_num_threads_local(1);
+        if (!engine->hasHeterogeneousCores_
+            && std::popcount(static_cast<std::uint64_t>(engine->affinityManager.getAudioRealtimeMask())) >= 2)
+            engine->affinityManager.applyCurrentThreadPolicy(ThreadType::AudioRealtime);
+        (void)engine->applyMmcssForDspHelperThread();
+    };
+    hooks.onThreadExit = [](void* context) noexcept
+    {
+        static_cast<DSPCore*>(context)->helperThreadOwner->revertMmcssOnAudioThread();
+    };
+    hooks.context = this;
+
+    constexpr double kSpinBlockPeriods = 2.0;
+    const double spinWindowSeconds = kSpinBlockPeriods * static_cast<double>(preparedHostBlockSize) / sampleRate;
+    const bool started = channelSplit.start(hooks, spinWindowSeconds);
+    juce::Logger::writeToLog("[DSPCORE_SPLIT] channel split helper " + juce::String(started ? "started" : "FAILED")
+                             + ": spinWindowMs=" + juce::String(spinWindowSeconds * 1000.0, 2));
+}
+
+// ★ Convolver 段スコープ遷移: 処理レート・ブロック上限・EQ の位置 (IR 焼き込み / ベースレート処理) が
+//   同じなら、this の Convolver 段の入力は other の Convolver 段へそのまま渡せる
+bool AudioEngine::DSPCore::hasSameConvolverStageLayout(const DSPCore& other) const noexcept
+{
+    return sampleRate == other.sampleRate
+        && oversamplingFactor == other.oversamplingFactor
+        && activeOversamplingType == other.activeOversamplingType
+        && maxInternalBlockSize == other.maxInternalBlockSize
+        && eqFoldedIntoIR == other.eqFoldedIntoIR
+        && eqSplitRate == other.eqSplitRate;
+}
+
+int AudioEngine::DSPCore::getConvolverStageLatencySamples() const noexcept
+{
+    return convolver.getLatencyBreakdown().totalLatencySamples + convolverPipeline.getLatencySamples();
+}
+
 // ★ v8.3: TrackedMemoryStatistics 収集 — NonRT 専用
 AudioEngine::DSPCore::TrackedMemoryStatistics
 AudioEngine::DSPCore::collectTrackedMemoryStatistics() const noexcept
@@ -307,23 +512,21 @@ AudioEngine::DSPCore::collectTrackedMemoryStatistics() const noexcept
     // EQ scratch/dry/parallel buffers (estimated from internalBlockSize × 2ch)
     stats.eqProcessor = static_cast<size_t>(maxInternalBlockSize) * sizeof(double) * 4;
 
-    // alignedL/R + dryBypassDoubleL/R
+    // alignedL/R + dryBypassDoubleL/R + stageFadeScratchL/R
     stats.alignedBuffers = static_cast<size_t>(alignedCapacity) * sizeof(double) * 2
-                         + static_cast<size_t>(dryBypassCapacityDouble) * sizeof(double) * 2;
+                         + static_cast<size_t>(dryBypassCapacityDouble) * sizeof(double) * 2
+                         + static_cast<size_t>(stageFadeScratchCapacity) * sizeof(double) * 2;
 
     // fixedLatency × 2 (old + new) × 2ch
     stats.latencyBuffers = static_cast<size_t>(histories().fixedLatencyBufferSize) * sizeof(double) * 4;
 
-    // TruePeakDetector internal (estimated: internalBlockSize × 2ch × filter order)
-    stats.truePeakDetector = static_cast<size_t>(maxInternalBlockSize) * sizeof(double) * 4;
-
     // Convolver internal (no IR = minimal — IR itself is not tracked here)
     stats.convolver = 0;  // ConvolverProcessor manages its own memory separately
 
     // Crossfade buffers (owned by AudioEngine, not DSPCore — report 0 here)
     stats.crossfade = 0;
 
-    // DCBlocker/LoudnessMeter/PeakLimiter/NoiseShaper (fixed-size state, ~few KB each)
+    // DCBlocker/PeakLimiter/NoiseShaper (fixed-size state, ~few KB each)
     stats.misc = 4096 * 4;  // Conservative estimate for all fixed-size DSP states
 
     // otherTracked: captured by summing prepare() allocated buffers not in above
@@ -332,8 +535,23 @@ AudioEngine::DSPCore::collectTrackedMemoryStatistics() const noexcept
     return stats;
 }
 
+size_t AudioEngine::DSPCore::estimateResidentBytes() const noexcept
+{
+    ASSERT_NON_RT_THREAD();
+
+    // Convolver は追跡統計の外なので IR 長から概算する:
+    // 2ch × (IR スペクトル + FDL) × ゼロ詰め 2 倍長の double。共有スペクトルの重複は区別しない。
+    // レイテンシ補正リングは実確保量を足す
+    const size_t irLength = static_cast<size_t>(std::max(0, convolverRt().getIRLength()));
+    const size_t convolverBytes = irLength * 2 * 2 * 2 * sizeof(double) + convolverRt().getLatencyDelayBytes();
+    return collectTrackedMemoryStatistics().totalTracked() + convolverBytes;
+}
+
 void AudioEngine::DSPCore::reset()
 {
+    // 投入済みのジョブを終わらせてから convolver を触る
+    convolverPipeline.drain();
+    convolverPipeline.restart();
     convolverState->resetForRuntime();
     eqState->resetForRuntime();
     dcBlockers().reset();
@@ -342,6 +560,7 @@ void AudioEngine::DSPCore::reset()
     adaptiveNoiseShaper.reset();
     oversampling.reset();
     outputFilter.reset();
+    silenceTracker.reset();
     activeAdaptiveCoeffGeneration = 0;
     activeAdaptiveCoeffBankIndex = -1;
 
@@ -0,0 +1,142 @@
+#include <JuceHeader.h>
+#include "AudioEngine.h"
+
+//==============================================================================
+// 固定内部レート: デバイスとエンジン本体 (…AtEngineRate) の間に FixedRateBridge を挟む入口
+//==============================================================================
+
+namespace
+{
+    void diagLog(const juce::String& message)
+    {
+        DBG(message);
+        juce::Logger::writeToLog(message);
+    }
+
+    // 通知されたブロック長の何倍までのコールバックを受けるか (WASAPI 等はコールバック長が揺れる)。
+    // 内部ブロックの上限 (= DSPCore のブロック長) もこの倍率で決まる
+    constexpr int kFixedRateMaxCallbackFactor = 2;
+}
+
+void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    ASSERT_NON_RT_THREAD();
+    // JUCE AudioSource 仕様上 Audio Thread は止まっているので、SRC の確保・解放はここで行える
+    fixedRateBridgeFloat.release();
+    fixedRateBridgeDouble.release();
+    fixedRateBridgeLatency_RT = 0;
+    convo::publishAtomic(fixedRateBridgeLatency, 0, std::memory_order_release); // release: getCurrentLatencyBreakdown の acquire と HB
+    convo::publishAtomic(deviceSampleRate, sampleRate, std::memory_order_release); // release: getDeviceSampleRate の acquire と HB
+
+    const int internalRate = convo::consumeAtomic(fixedInternalSampleRateHz, std::memory_order_acquire); // acquire: setFixedInternalSampleRate の release と HB
+    const bool bridged = internalRate > 0
+        && std::isfinite(sampleRate) && sampleRate > 0.0 && sampleRate <= SAFE_MAX_SAMPLE_RATE
+        && samplesPerBlockExpected > 0
+        && std::abs(sampleRate - static_cast<double>(internalRate)) > 1e-6;
+    if (!bridged)
+    {
+        prepareToPlayAtEngineRate(samplesPerBlockExpected, sampleRate);
+        return;
+    }
+
+    const double innerRate = static_cast<double>(internalRate);
+    const bool minimumPhase = convo::consumeAtomic(fixedInternalRateMinimumPhase, std::memory_order_acquire); // acquire: setFixedInternalSampleRate の release と HB
+    const int maxCallback = samplesPerBlockExpected * kFixedRateMaxCallbackFactor;
+    if (!fixedRateBridgeFloat.prepare(2, sampleRate, innerRate, samplesPerBlockExpected, maxCallback, minimumPhase)
+        || !fixedRateBridgeDouble.prepare(2, sampleRate, innerRate, samplesPerBlockExpected, maxCallback, minimumPhase))
+    {
+        fixedRateBridgeFloat.release();
+        fixedRateBridgeDouble.release();
+        diagLog("[FixedRate] SRC prepare failed; processing at device rate " + juce::String(sampleRate, 1));
+        prepareToPlayAtEngineRate(samplesPerBlockExpected, sampleRate);
+        return;
+    }
+
+    // 内部ブロック長: 前回の長さが今回の必要量〜その 2 倍に収まるなら据え置く。内部レートも同じなら
+    // prepareToPlayAtEngineRate は rebuild を出さず、デバイスのレート・ブロック長の変更は SRC の作り直しだけで済む
+    const int neededBlock = fixedRateBridgeDouble.getMaxInnerBlockSamples();
+    const int previousBlock = convo::consumeAtomic(deviceSamplesPerBlock, std::memory_order_acquire); // acquire: 前回の prepareToPlay の release と HB
+    const bool sameInnerRate = std::abs(convo::consumeAtomic(currentSampleRate, std::memory_order_acquire) - innerRate) <= 1e-6;
+    const int engineBlock = (sameInnerRate && previousBlock >= neededBlock && previousBlock <= neededBlock * 2)
+        ? previousBlock
+        : neededBlock;
+
+    prepareToPlayAtEngineRate(engineBlock, innerRate);
+
+    // xrun 判定はデバイスのコールバック間隔で行う (engineBlock は上限から求めた長さで、実際の内部ブロックより長い)
+    rtLocalState_.expectedCallbackIntervalUs =
+        static_cast<uint64_t>(static_cast<double>(samplesPerBlockExpected) / sampleRate * 1e6);
+
+    fixedRateBridgeLatency_RT = fixedRateBridgeDouble.getLatencySamples();
+    convo::publishAtomic(fixedRateBridgeLatency, fixedRateBridgeLatency_RT, std::memory_order_release); // release: getCurrentLatencyBreakdown の acquire と HB
+
+    diagLog("[FixedRate] device sr=" + juce::String(sampleRate, 1) + " spb=" + juce::String(samplesPerBlockExpected)
+            + " -> internal sr=" + juce::String(internalRate) + " block=" + juce::String(engineBlock)
+            + (minimumPhase ? " minPhase" : " linearPhase")
+            + " srcLatency=" + juce::String(fixedRateBridgeLatency_RT));
+}
+
+void AudioEngine::processBlockDouble (juce::AudioBuffer<double>& buffer)
+{
+    if (!fixedRateBridgeDouble.isPrepared())
+    {
+        processBlockDoubleAtEngineRate(buffer);
+        return;
+    }
+
+    const juce::ScopedNoDenormals noDenormals;
+    double* deviceChannels[convo::FixedRateBridge<double>::kMaxChannels] = {};
+    const int deviceChannelCount = std::min(convo::FixedRateBridge<double>::kMaxChannels, buffer.getNumChannels());
+    for (int ch = 0; ch < deviceChannelCount; ++ch)
+        deviceChannels[ch] = buffer.getWritePointer(ch);
+
+    const bool processed = processThroughFixedRateBridge(fixedRateBridgeDouble, deviceChannels, deviceChannelCount, buffer.getNumSamples(),
+        [&](double* const* blockChannels, int blockSamples)
+        {
+            // 外部メモリ参照の AudioBuffer はチャンネルポインタを内部に持つため確保しない
+            juce::AudioBuffer<double> blockBuffer(blockChannels, fixedRateBridgeDouble.getNumChannels(), blockSamples);
+            processBlockDoubleAtEngineRate(blockBuffer);
+        });
+    if (!processed)
+    {
+        buffer.clear();
+        return;
+    }
+    // SRC が扱わないチャンネル (3ch 以降) は入力が残っているので消す
+    for (int ch = fixedRateBridgeDouble.getNumChannels(); ch < buffer.getNumChannels(); ++ch)
+        buffer.clear(ch, 0, buffer.getNumSamples());
+}
+
+void AudioEngine::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
+{
+    if (!fixedRateBridgeFloat.isPrepared())
+    {
+        getNextAudioBlockAtEngineRate(bufferToFill);
+        return;
+    }
+
+    auto* const buffer = bufferToFill.buffer;
+    if (buffer == nullptr || bufferToFill.numSamples <= 0)
+        return;
+
+    const juce::ScopedNoDenormals noDenormals;
+    float* deviceChannels[convo::FixedRateBridge<float>::kMaxChannels] = {};
+    const int deviceChannelCount = std::min(convo::FixedRateBridge<float>::kMaxChannels, buffer->getNumChannels());
+    for (int ch = 0; ch < deviceChannelCount; ++ch)
+        deviceChannels[ch] = buffer->getWritePointer(ch, bufferToFill.startSample);
+
+    const bool processed = processThroughFixedRateBridge(fixedRateBridgeFloat, deviceChannels, deviceChannelCount, bufferToFill.numSamples,
+        [&](float* const* blockChannels, int blockSamples)
+        {
+            // 外部メモリ参照の AudioBuffer はチャンネルポインタを内部に持つため確保しない
+            juce::AudioBuffer<float> blockBuffer(blockChannels, fixedRateBridgeFloat.getNumChannels(), blockSamples);
+            getNextAudioBlockAtEngineRate(juce::AudioSourceChannelInfo(&blockBuffer, 0, blockSamples));
+        });
+    if (!processed)
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+    for (int ch = fixedRateBridgeFloat.getNumChannels(); ch < buffer->getNumChannels(); ++ch)
+        buffer->clear(ch, bufferToFill.startSample, bufferToFill.numSamples);
+}
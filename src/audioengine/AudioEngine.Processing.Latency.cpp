@@ -18,6 +18,10 @@ namespace
         if (numStages <= 0)
             return 0.0;
 
+        // MinimumPhase は全域通過 IIR ハーフバンド: 設計係数から DC 群遅延を求める
+        if (oversamplingType == AudioEngine::OversamplingType::MinimumPhase)
+            return CustomInputOversampler::getMinimumPhaseLatencyBaseSamples(oversamplingFactor);
+
         const int* taps = nullptr;
         static constexpr int iirLikeTaps[3] = { 511, 127, 31 };
         static constexpr int linearPhaseTaps[3] = { 1023, 255, 63 };
@@ -36,6 +40,13 @@ namespace
     }
 }
 
+[[nodiscard]] double AudioEngine::getAnalyzerSampleRate() const
+{
+    // 入力・出力タップともオーバーサンプリング前後のベースレート区間で push している
+    const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
+    return (sr > 0.0) ? sr : 0.0;
+}
+
 [[nodiscard]] double AudioEngine::getProcessingSampleRate() const
 {
     const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
@@ -69,12 +80,12 @@ namespace
 
 [[nodiscard]] int AudioEngine::getCurrentLatencySamples() const
 {
-    return getCurrentLatencyBreakdown().totalLatencyBaseRateSamples;
+    return getCurrentLatencyBreakdown().totalLatencyDeviceSamples;
 }
 
 [[nodiscard]] int AudioEngine::getTotalLatencySamples() const
 {
-    return getCurrentLatencyBreakdown().totalLatencyBaseRateSamples;
+    return getCurrentLatencyBreakdown().totalLatencyDeviceSamples;
 }
 
 [[nodiscard]] AudioEngine::LatencyBreakdown AudioEngine::getCurrentLatencyBreakdown() const
@@ -105,8 +116,15 @@ namespace
     // 理論式: (taps-1)/2 per pass × 2 passes = taps-1 = 30 @2x → 15 @base rate
     // 【注意】要実測確認: processUp→processDownの合成遅延を単位インパルスで測定し補正
     constexpr int kSoftClipLatencyBaseRateSamples = 15;
+    // MinimumPhase 選択時の SoftClip 局所OSは全域通過ハーフバンド 1 段 (DSPCore::prepare 参照)
+    const int softClipLatency = (dsp->activeOversamplingType == OversamplingType::MinimumPhase)
+        ? static_cast<int>(std::lround(CustomInputOversampler::getMinimumPhaseLatencyBaseSamples(2)))
+        : kSoftClipLatencyBaseRateSamples;
     breakdown.softClipLatencyBaseRateSamples = (safeOsFactor == 1)
-        ? kSoftClipLatencyBaseRateSamples : 0;
+        ? softClipLatency : 0;
+
+    // 出力段のピークリミッタは base rate で動くので変換不要
+    breakdown.outputLimiterLatencyBaseRateSamples = dsp->peakLimiter.getLatencySamples();
 
     if (!convo::consumeAtomic(convBypassActive, std::memory_order_acquire))
     {
@@ -122,12 +140,35 @@ namespace
         breakdown.convolverAlgorithmLatencyBaseRateSamples = toBaseRateSamples(convBreakdown.algorithmLatencySamples);
         breakdown.convolverIRPeakLatencyBaseRateSamples = toBaseRateSamples(convBreakdown.irPeakLatencySamples);
         breakdown.convolverTotalLatencyBaseRateSamples = toBaseRateSamples(convBreakdown.totalLatencySamples);
+        // パイプライン化 Convolver: ワーカーの結果を 1 ブロック後に受け取るぶん
+        breakdown.convolverPipelineLatencyBaseRateSamples = toBaseRateSamples(dsp->convolverPipeline.getLatencySamples());
     }
 
+    // 固定長リブロックの FIFO は DSPCore の外 (base rate) にあり、バイパス状態に依らない
+    breakdown.fixedBlockReblockLatencyBaseRateSamples =
+        convo::consumeAtomic(fixedBlockReblockLatency, std::memory_order_acquire); // acquire: Audio Thread の release と HB
+
     breakdown.totalLatencyBaseRateSamples = juce::jmax(0,
         breakdown.oversamplingLatencyBaseRateSamples
       + breakdown.convolverTotalLatencyBaseRateSamples
-      + breakdown.softClipLatencyBaseRateSamples);
+      + breakdown.convolverPipelineLatencyBaseRateSamples
+      + breakdown.fixedBlockReblockLatencyBaseRateSamples
+      + breakdown.softClipLatencyBaseRateSamples
+      + breakdown.outputLimiterLatencyBaseRateSamples);
+
+    // 固定内部レート: 上の値は内部レートなのでデバイスのレートへ換算し、SRC の遅延を足す
+    breakdown.fixedRateBridgeLatencyDeviceSamples =
+        convo::consumeAtomic(fixedRateBridgeLatency, std::memory_order_acquire); // acquire: Audio Thread / prepareToPlay の release と HB
+    breakdown.totalLatencyDeviceSamples = breakdown.totalLatencyBaseRateSamples;
+    if (breakdown.fixedRateBridgeLatencyDeviceSamples > 0)
+    {
+        const double internalRate = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
+        const double deviceRate = convo::consumeAtomic(deviceSampleRate, std::memory_order_acquire);
+        if (internalRate > 0.0 && deviceRate > 0.0)
+            breakdown.totalLatencyDeviceSamples = static_cast<int>(std::lround(
+                static_cast<double>(breakdown.totalLatencyBaseRateSamples) * deviceRate / internalRate))
+                + breakdown.fixedRateBridgeLatencyDeviceSamples;
+    }
 
     return breakdown;
 }
@@ -1,6 +1,7 @@
 #include <JuceHeader.h>
 #include "AudioEngine.h"
 #include "core/RuntimeReaderContext.h"
+#include "DSPLifetimeManager.h"
 #include "RuntimeBuilder.h"
 #include "RuntimePublicationOrchestrator.h"
 
@@ -12,7 +13,7 @@ void diagLog(const juce::String& message)
 }
 }
 
-void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+void AudioEngine::prepareToPlayAtEngineRate (int samplesPerBlockExpected, double sampleRate)
 {
     ASSERT_NON_RT_THREAD();
     // P0-A0: LifecycleIsolationRuntime integration
@@ -73,16 +74,20 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
     diagLog("[DIAG] prepareToPlay: shutdownPhase set to Running");
 
     // releaseResources() で停止済みの場合に備えて、必要なら rebuild thread を再起動する。
-    if (!rebuildThread.joinable())
+    if (!rebuildLane(RebuildLane::Heavy).thread.joinable())
     {
         {
             std::lock_guard<std::mutex> lock(rebuildMutex);
             convo::publishAtomic(rebuildThreadShouldExit, false, std::memory_order_release);
-            hasPendingTask = false;
-            pendingTask = RebuildTask{};
+            for (auto& laneSlot : rebuildLanes_)
+            {
+                laneSlot.hasPendingTask = false;
+                laneSlot.pendingTask = RebuildTask{};
+            }
+            publishRebuildBacklogLocked();
         }
-        rebuildThread = std::thread(&AudioEngine::rebuildThreadLoop, this);
-        diagLog("[DIAG] prepareToPlay: rebuild thread started");
+        startRebuildThreads();
+        diagLog("[DIAG] prepareToPlay: rebuild threads started");
     }
 
     // ★ Release-only crash fix #2: rebuildRequestGeneration をリセットして、新規 rebuild の
@@ -92,6 +97,9 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
     //   古い世代番号を持ち、admission の staleness check で常に RejectedStaleGeneration と
     //   なってしまう問題を修正する。
     convo::publishAtomic(rebuildRequestGeneration, 0, std::memory_order_release);
+    // レーン別の世代 (Heavy の最新 / 投入済み最新) も同じ基準へ戻す
+    convo::publishAtomic(heavyRebuildGeneration_, 0, std::memory_order_release);
+    convo::publishAtomic(lastSubmittedRebuildGeneration_, 0, std::memory_order_release);
     diagLog("[DIAG] prepareToPlay: rebuild request generation reset to 0");
 
     // ★ P1-6: 出版停滞監視のタイムスタンプを再初期化
@@ -113,12 +121,17 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
         jassertfalse;
         samplesPerBlockExpected = 512;
     }
-    const int bufferSize = samplesPerBlockExpected;
+    // ★ 固定長リブロック中は DSPCore を内部ブロック (2 の冪) で準備し、デバイス長は FIFO で吸収する
+    const int deviceBufferSize = samplesPerBlockExpected;
+    const int bufferSize = convo::consumeAtomic(fixedBlockReblockEnabled, std::memory_order_acquire)
+        ? getFixedReblockSize(deviceBufferSize)
+        : deviceBufferSize;
 
     // サンプルレート・ブロックサイズ変更検知
     const bool rateChanged = (std::abs(convo::consumeAtomic(currentSampleRate, std::memory_order_acquire) - safeSampleRate) > 1e-6);
     const bool blockSizeChanged = (convo::consumeAtomic(maxSamplesPerBlock, std::memory_order_acquire) != bufferSize);
 
+    convo::publishAtomic(deviceSamplesPerBlock, deviceBufferSize, std::memory_order_release);
     convo::publishAtomic(maxSamplesPerBlock, bufferSize, std::memory_order_release);
     convo::publishAtomic(currentSampleRate, safeSampleRate, std::memory_order_release);
     {
@@ -161,9 +174,22 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
     dspCrossfadeFloatBuffer.setSize(2, std::max(SAFE_MAX_BLOCK_SIZE, bufferSize), false, false, true);
     dspCrossfadeDoubleBuffer.setSize(2, std::max(SAFE_MAX_BLOCK_SIZE, bufferSize), false, false, true);
 
-    analyzerFifo.prepare(2, FIFO_SIZE);
+    analyzerFifo.prepare(getAnalyzerFifoSize(sampleRate, std::max(bufferSize, deviceBufferSize)));
+
+    // 固定長リブロックの FIFO は有効/無効に依らず確保しておく (Audio Thread が切替時に reset のみ行う)
+    const int reblockSize = getFixedReblockSize(deviceBufferSize);
+    const int reblockMaxCallback = std::max(SAFE_MAX_BLOCK_SIZE, deviceBufferSize);
+    if (!fixedBlockReblockerFloat.prepare(2, reblockSize, reblockMaxCallback)
+        || !fixedBlockReblockerDouble.prepare(2, reblockSize, reblockMaxCallback))
+    {
+        rollbackPrepareFailure();
+        return;
+    }
+    fixedBlockReblockActive_RT = false;
+    convo::publishAtomic(fixedBlockReblockLatency, 0, std::memory_order_release);
     convo::publishAtomic(inputLevelLinear, 0.0f, std::memory_order_release);
     convo::publishAtomic(outputLevelLinear, 0.0f, std::memory_order_release);
+    publishAudioObservation(0);
 
     convo::publishAtomic(eqBypassActive, convo::consumeAtomic(eqBypassRequested, std::memory_order_acquire), std::memory_order_release);
     convo::publishAtomic(convBypassActive, convo::consumeAtomic(convBypassRequested, std::memory_order_acquire), std::memory_order_release);
@@ -222,6 +248,9 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
         (sampleRate > 0.0 && samplesPerBlockExpected > 0)
         ? static_cast<uint64_t>(static_cast<double>(samplesPerBlockExpected) / sampleRate * 1e6)
         : 0;
+    // 前のデバイス設定の最終 callback からの間隔を xrun と誤判定しない
+    m_healthMonitor.getXrunCorrelator().resetCallbackTiming();
+    callbackTiming_.resetArrival();
     // ★ work61: Audio Thread ThreadID をキャッシュ（以降はAPI呼び出し不要）
     rtLocalState_.cachedThreadId = ::GetCurrentThreadId();
     convo::publishAtomic(lifecycleState, EngineLifecycleState::Prepared, std::memory_order_release);
@@ -230,7 +259,17 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
     // 初回IRロード前でも currentDSP を常に有効にし、DSP->DSP クロスフェードへ統一する。
     const bool hasPublishedCurrent = (resolveActiveRuntimeDSPFromRuntimeWorldOnly(runtimeReadHandle) != nullptr);
     diagLog("[DIAG] prepareToPlay: hasPublishedCurrent=" + juce::String(static_cast<int>(hasPublishedCurrent)));
+
+    // ★ デバイス再起動 (ASIO リセット・同レートでの開き直し): releaseResources が預けた DSPCore が使えるなら
+    //   確保済みのバッファ・OS 段・Convolver をそのまま reset して再公開する。ブロック長が一致すれば rebuild も出さない
+    bool restartResidentReused = false;
+    bool restartResidentExactBlock = false;
     if (!hasPublishedCurrent && !hasActiveRuntimeDSP())
+        restartResidentReused = republishDeviceRestartResident(safeSampleRate, bufferSize, restartResidentExactBlock);
+    else
+        releaseDeviceRestartResident();
+
+    if (!restartResidentReused && !hasPublishedCurrent && !hasActiveRuntimeDSP())
     {
         diagLog("[DIAG] prepareToPlay: creating placeholderDSP");
         convo::aligned_unique_ptr<DSPCore> placeholderDSP;
@@ -245,6 +284,7 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
                                     convo::consumeAtomic(ditherBitDepth, std::memory_order_acquire),
                                     convo::consumeAtomic(manualOversamplingFactor, std::memory_order_acquire),
                                     convo::consumeAtomic(oversamplingType, std::memory_order_acquire),
+                                    convo::consumeAtomic(oversamplingSinglePrecision, std::memory_order_acquire),
                                     convo::consumeAtomic(noiseShaperType, std::memory_order_acquire),
                                     this);
             placeholderDSP->convolverRt().setBypass(true);
@@ -281,9 +321,17 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
     // --- DSP再ビルド判定・同期 ---
     uiConvolverProcessor.prepareToPlay(safeSampleRate, bufferSize);
     if (rateChanged)
+    {
         uiConvolverProcessor.invalidatePendingLoads();
+        uiConvolverProcessor.scheduleStandbyPrebuild();  // ★ Hot standby: 直前のレートを含む代替レートを事前計算
+        uiConvolverProcessor.scheduleCachePrefetch();    // ★ Cache prefetch: 新レートのキーで最近使用 IR を事前検証
+    }
     const bool hasCurrentRuntime = (resolveActiveRuntimeDSPFromRuntimeWorldOnly(runtimeReadHandle) != nullptr);
-    if (rateChanged || blockSizeChanged || !hasCurrentRuntime) {
+    // 再公開した常駐はブロック長が短くなった場合だけ組み直す (それまでは常駐のまま鳴らし、完成後にクロスフェード)
+    const bool needsStructuralRebuild = restartResidentReused
+        ? !restartResidentExactBlock
+        : (rateChanged || blockSizeChanged || !hasCurrentRuntime);
+    if (needsStructuralRebuild) {
         if (juce::MessageManager::getInstance()->isThisTheMessageThread()) {
             submitRebuildIntent(convo::RebuildKind::Structural,
                                 RebuildTelemetryReason::RequestRebuildKindEntry,
@@ -301,3 +349,105 @@ void AudioEngine::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
     // P0-A0: LifecycleIsolationRuntime integration - leave prepare phase
     lifecycleRuntime_.leavePrepare(lifecycleToken);
 }
+
+// releaseResources から: Audio Thread 停止・Reader 退出後の DSPCore を破棄せず預ける。
+// 公開されたことのある (構築ペイロードが残っている) DSPCore だけが対象で、A/B 常駐は A/B 側が park する
+bool AudioEngine::parkForDeviceRestart(DSPCore* dsp) noexcept
+{
+    if (dsp == nullptr || !dsp->publishedBuild.snapshot.sealed)
+        return false;
+    if (abResidentBank_.residentCore(convo::ABSlot::A) == dsp || abResidentBank_.residentCore(convo::ABSlot::B) == dsp)
+        return false;
+    if (!retireDSPHandleForRuntime(dsp))
+        return false;
+
+    releaseDeviceRestartResident();
+    // 預けている間は MMCSS 登録したワーカーを残さない (再公開時に今の設定で起こし直す)
+    dsp->configureConvolverPipeline(false, this);
+    dsp->configureChannelSplit(false, this);
+    deviceRestartResident_ = dsp;
+    deviceRestartParkEpoch_ = m_retireRouter->currentEpoch();
+    return true;
+}
+
+void AudioEngine::releaseDeviceRestartResident() noexcept
+{
+    // handle は park 時に解放済み
+    if (DSPCore* const dsp = std::exchange(deviceRestartResident_, nullptr))
+        DSPLifetimeManager(*this).retireParked(dsp);
+}
+
+bool AudioEngine::republishDeviceRestartResident(double sampleRate, int blockSize, bool& exactBlock)
+{
+    exactBlock = false;
+    DSPCore* const resident = deviceRestartResident_;
+    if (resident == nullptr)
+        return false;
+
+    // Convolver の reset は Message Thread 前提。ブロック長が変わるとパイプライン段の遅延 (= ブロック長) が合わない
+    const auto& record = resident->publishedBuild;
+    const bool helperStages = convo::consumeAtomic(pipelinedConvolverEnabled, std::memory_order_acquire) // acquire: setPipelinedConvolverEnabled の acq_rel と HB
+        || convo::consumeAtomic(channelSplitEnabled, std::memory_order_acquire);                         // acquire: setChannelSplitEnabled の acq_rel と HB
+    const bool blockFits = blockSize == resident->preparedHostBlockSize
+        || (blockSize < resident->preparedHostBlockSize && !helperStages);
+    // 停止中に IR・OS・ディザ等が変わっていないか (A/B 常駐と同じ比較。ブロック長は上で見た)
+    const bool sameBuild = convo::isSameResidentBuild(record.snapshot.buildInput,
+                                                      record.snapshot.convolverFingerprint,
+                                                      captureBuildInputForRebuild(sampleRate, record.snapshot.buildInput.blockSize),
+                                                      uiConvolverProcessor.captureBuildSnapshot().fingerprint);
+    // 預けた時点の epoch を全 Reader が越えていること (Audio Thread から到達不能)
+    m_retireRouter->publishEpoch();
+    const bool unreachable = deviceRestartParkEpoch_ < m_retireRouter->getMinReaderEpoch();
+    const bool messageThread = juce::MessageManager::existsAndIsCurrentThread();
+    if (!blockFits || !sameBuild || !unreachable || !messageThread)
+    {
+        diagLog("[DIAG] prepareToPlay: device-restart resident not reusable blockFits=" + juce::String(static_cast<int>(blockFits))
+            + " sameBuild=" + juce::String(static_cast<int>(sameBuild))
+            + " unreachable=" + juce::String(static_cast<int>(unreachable))
+            + " messageThread=" + juce::String(static_cast<int>(messageThread)));
+        releaseDeviceRestartResident();
+        return false;
+    }
+    deviceRestartResident_ = nullptr;
+    const int residentBlockSize = resident->preparedHostBlockSize;
+
+    // 停止前の FDL・EQ / OS 履歴を捨て、新規構築と同じくフェードインから始める。段の設定は rebuild の手順 4 と同じく今の値で
+    resident->reset();
+    resident->eqSplitRate = convo::consumeAtomic(eqSplitRateEnabled, std::memory_order_acquire); // acquire: setEQSplitRateEnabled の acq_rel と HB
+    resident->adaptiveSoftClipOS = convo::consumeAtomic(adaptiveSoftClipOSEnabled, std::memory_order_acquire); // acquire: setAdaptiveSoftClipOSEnabled の acq_rel と HB
+    resident->configureConvolverPipeline(convo::consumeAtomic(pipelinedConvolverEnabled, std::memory_order_acquire), this); // acquire: setPipelinedConvolverEnabled の acq_rel と HB
+    resident->configureChannelSplit(convo::consumeAtomic(channelSplitEnabled, std::memory_order_acquire), this); // acquire: setChannelSplitEnabled の acq_rel と HB
+    resident->ramps().fadeInSamplesLeft = DSPCore::FADE_IN_SAMPLES;
+
+    int generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(rebuildMutex);
+        generation = ++rebuildRequestGeneration;
+        // release: Heavy レーンの isRebuildObsolete (acquire) と HB
+        convo::publishAtomic(heavyRebuildGeneration_, generation, std::memory_order_release);
+    }
+
+    convo::RuntimeBuildSnapshot snapshot = record.snapshot;
+    snapshot.generation = generation;
+    convo::BuildAnalysis analysis = record.buildAnalysis;
+    if (analysis.sealed)
+    {
+        analysis.generation = generation;
+        analysis = convo::sealBuildAnalysis(analysis, &snapshot);
+    }
+    {
+        std::lock_guard<std::mutex> commitLock(rebuildCommitMutex);
+        enqueuePublicationIntentForRuntimeCommit(resident, generation, snapshot, analysis,
+                                                 record.oversamplingResult, record.buildDiagnostics);
+        // release: isRebuildGenerationPublishable (acquire) と HB。commitLock 下で単調増加
+        convo::publishAtomic(lastSubmittedRebuildGeneration_, generation, std::memory_order_release);
+    }
+
+    // Admission を通れば同期で commit される。差し戻されたら placeholder + rebuild の通常経路へ戻る
+    const bool published = (getActiveRuntimeDSP() == resident);
+    exactBlock = published && blockSize == residentBlockSize;
+    diagLog("[DIAG] prepareToPlay: device-restart resident " + juce::String(published ? "republished" : "rejected")
+        + " sr=" + juce::String(sampleRate, 1)
+        + " block=" + juce::String(blockSize) + "/" + juce::String(residentBlockSize));
+    return published;
+}
@@ -104,6 +104,7 @@ void AudioEngine::releaseResources()
 
     convo::publishAtomic(inputLevelLinear, 0.0f, std::memory_order_release);
     convo::publishAtomic(outputLevelLinear, 0.0f, std::memory_order_release);
+    publishAudioObservation(0);
 
     if (noiseShaperLearner)
     {
@@ -117,7 +118,7 @@ void AudioEngine::releaseResources()
     DSPCore* activeToRelease = nullptr;
     DSPCore* fadingToRelease = nullptr;
     DSPCore* pendingNewToRelease = nullptr;
-    DSPCore* pendingCurrentToRelease = nullptr;
+    std::array<DSPCore*, kRebuildLaneCount> pendingCurrentToRelease {};
 
     // ★ [PR-A2] DSPLifetimeManager 経由で retire (lifetime は lock 外でも参照可能にする)
     DSPLifetimeManager lifetimeForShutdown(*this);
@@ -145,12 +146,10 @@ void AudioEngine::releaseResources()
         crossfadeRuntime_.reset();
         refreshCrossfadePreparedSnapshotFromAtomics();
 
-        if (hasPendingTask)
+        for (size_t i = 0; i < kRebuildLaneCount; ++i)
         {
-            auto* const pendingRaw = pendingTask.currentDSP;
-            pendingCurrentToRelease = (reinterpret_cast<uintptr_t>(pendingRaw) == (~static_cast<uintptr_t>(0))) ? nullptr : pendingRaw;
-            pendingTask.currentDSP = nullptr;
-            hasPendingTask = false;
+            auto* const pendingRaw = takePendingRebuildTaskLocked(static_cast<RebuildLane>(i));
+            pendingCurrentToRelease[i] = (reinterpret_cast<uintptr_t>(pendingRaw) == (~static_cast<uintptr_t>(0))) ? nullptr : pendingRaw;
         }
 
         // Migrated to publishWorld() with pre-built RuntimePublishWorld (Sprint-2 P1-A)
@@ -281,14 +280,28 @@ void AudioEngine::releaseResources()
 
     // [P1 Phase1-B] drainPublicationLogForShutdown removed
 
-    if (activeToRelease)
-        lifetimeForShutdown.retire(activeToRelease);
-    if (fadingToRelease)
-        lifetimeForShutdown.retire(fadingToRelease);
-    if (pendingNewToRelease)
-        lifetimeForShutdown.retire(pendingNewToRelease);
-    if (pendingCurrentToRelease)
-        lifetimeForShutdown.retire(pendingCurrentToRelease);
+    // 同じ構成で開き直すデバイス再起動に備え、公開中の DSPCore は破棄せず預ける (再公開は prepareToPlay)
+    if (activeToRelease != nullptr && parkForDeviceRestart(activeToRelease))
+    {
+        diagLog("[DIAG] releaseResources: active DSPCore parked for device restart");
+        activeToRelease = nullptr;
+    }
+
+    {
+        // active / fading / pending をまとめて 1 バッチで渡す
+        convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*m_retireRouter, convo::isr::RetireProducer::Lifetime);
+        if (activeToRelease)
+            lifetimeForShutdown.retire(activeToRelease);
+        if (fadingToRelease)
+            lifetimeForShutdown.retire(fadingToRelease);
+        if (pendingNewToRelease)
+            lifetimeForShutdown.retire(pendingNewToRelease);
+        for (auto* const pendingDSP : pendingCurrentToRelease)
+        {
+            if (pendingDSP)
+                lifetimeForShutdown.retire(pendingDSP);
+        }
+    }
 
     // shutdown/release シーケンスでは明示的に deferred retire queue をドレインする。
     // 通常タイマー経路は Releasing 中に early-return するため、ここで最終回収を保証する。
@@ -316,7 +329,7 @@ void AudioEngine::releaseResources()
         // 安全な tryReclaim（drainAll 禁止）
         {
             const auto preReclaimPending = m_retireRouter->pendingRetireCount();
-            m_epochDomain.tryReclaim();
+            m_retireRouter->tryReclaim();   // バッチレーン分も含めて回収する
             const auto postReclaimPending = m_retireRouter->pendingRetireCount();
             diagLog("[DIAG] releaseResources: EmergencyDrain -- tryReclaim done (pending "
                 + juce::String(static_cast<int>(preReclaimPending)) + " → "
@@ -453,7 +466,7 @@ void AudioEngine::releaseResources()
 
         // [P1 Phase1-B] drainPublicationLogForShutdown removed
         drainDeferredRetireQueues(true);
-        m_epochDomain.tryReclaim();  // ★ P1-2: drainAll 禁止 → 安全な tryReclaim
+        m_retireRouter->tryReclaim();  // ★ P1-2: drainAll 禁止 → 安全な tryReclaim (バッチレーン分を含む)
     }
 
     m_coordinator.finalizeShutdown(timedOut);  // ★ P1-2: 二段構えの正常系
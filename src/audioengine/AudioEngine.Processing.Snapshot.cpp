@@ -53,6 +53,11 @@ void AudioEngine::processWithSnapshot(const juce::AudioSourceChannelInfo& buffer
     const EngineParameterSnapshot parameterSnapshot = captureAudioThreadParameterSnapshot(snap, isFadingTarget);
 
     DSPCore::ProcessingState procState = buildAudioThreadProcessingState(dsp, parameterSnapshot);
+    if (isFadingTarget)
+    {
+        procState.stageLatency = nullptr;
+        procState.meteringTap = nullptr;
+    }
 
     auto* inMeter = isFadingTarget ? nullptr : &inputLevelLinear;
     auto* outMeter = isFadingTarget ? nullptr : &outputLevelLinear;
@@ -25,6 +25,7 @@ struct BuildParameterSnapshot
     int ditherDepth = 0;
     int oversamplingFactor = 0;
     AudioEngine::OversamplingType oversamplingType = AudioEngine::OversamplingType::IIR;
+    bool oversamplingSinglePrecision = false;
     AudioEngine::NoiseShaperType noiseShaperType = AudioEngine::NoiseShaperType::Psychoacoustic;
     convo::ProcessingOrder processingOrder = convo::ProcessingOrder::ConvolverThenEQ;
     bool eqBypassed = false;
@@ -43,6 +44,7 @@ BuildParameterSnapshot captureBuildParameterSnapshot(const AudioEngine& engine)
     snapshot.ditherDepth = convo::consumeAtomic(engine.ditherBitDepth, std::memory_order_acquire);
     snapshot.oversamplingFactor = convo::consumeAtomic(engine.manualOversamplingFactor, std::memory_order_acquire);
     snapshot.oversamplingType = convo::consumeAtomic(engine.oversamplingType, std::memory_order_acquire);
+    snapshot.oversamplingSinglePrecision = convo::consumeAtomic(engine.oversamplingSinglePrecision, std::memory_order_acquire);
     snapshot.noiseShaperType = convo::consumeAtomic(engine.noiseShaperType, std::memory_order_acquire);
     snapshot.processingOrder = convo::consumeAtomic(engine.currentProcessingOrder, std::memory_order_acquire);
     snapshot.eqBypassed = convo::consumeAtomic(engine.eqBypassRequested, std::memory_order_acquire);
@@ -56,12 +58,35 @@ BuildParameterSnapshot captureBuildParameterSnapshot(const AudioEngine& engine)
     return snapshot;
 }
 
+convo::BuildInput makeBuildInput(double sampleRate, int blockSize, const BuildParameterSnapshot& snapshot) noexcept
+{
+    convo::BuildInput input;
+    input.sampleRate = sampleRate;
+    input.blockSize = blockSize;
+    input.ditherBitDepth = snapshot.ditherDepth;
+    input.oversamplingFactor = snapshot.oversamplingFactor;
+    input.oversamplingType = static_cast<int>(snapshot.oversamplingType);
+    input.oversamplingSinglePrecision = snapshot.oversamplingSinglePrecision;
+    input.noiseShaperType = static_cast<int>(snapshot.noiseShaperType);
+    input.processingOrder = static_cast<int>(snapshot.processingOrder);
+    input.eqBypassed = snapshot.eqBypassed;
+    input.convBypassed = snapshot.convBypassed;
+    input.softClipEnabled = snapshot.softClipEnabled;
+    input.saturationAmount = snapshot.saturationAmount;
+    input.inputHeadroomGain = snapshot.inputHeadroomGain;
+    input.outputMakeupGain = snapshot.outputMakeupGain;
+    input.convolverInputTrimGain = snapshot.convolverInputTrimGain;
+    input.autoGainStagingEnabled = snapshot.autoGainStagingEnabled;
+    return input;
+}
+
 bool equalsBuildParameterSnapshot(const BuildParameterSnapshot& lhs,
                                   const BuildParameterSnapshot& rhs) noexcept
 {
     return lhs.ditherDepth == rhs.ditherDepth
         && lhs.oversamplingFactor == rhs.oversamplingFactor
         && lhs.oversamplingType == rhs.oversamplingType
+        && lhs.oversamplingSinglePrecision == rhs.oversamplingSinglePrecision
         && lhs.noiseShaperType == rhs.noiseShaperType
         && lhs.processingOrder == rhs.processingOrder
         && lhs.eqBypassed == rhs.eqBypassed
@@ -122,6 +147,7 @@ convo::RuntimeBuildSnapshot finalizeRuntimeBuildSnapshot(convo::RuntimeBuildSnap
     mixHash(static_cast<std::uint64_t>(snapshot.buildInput.ditherBitDepth));
     mixHash(static_cast<std::uint64_t>(snapshot.buildInput.oversamplingFactor));
     mixHash(static_cast<std::uint64_t>(snapshot.buildInput.oversamplingType));
+    mixHash(static_cast<std::uint64_t>(snapshot.buildInput.oversamplingSinglePrecision));
     mixHash(static_cast<std::uint64_t>(snapshot.buildInput.noiseShaperType));
     mixHash(static_cast<std::uint64_t>(snapshot.buildInput.processingOrder));
     mixHash(static_cast<std::uint64_t>(snapshot.buildInput.eqBypassed));
@@ -333,6 +359,7 @@ void AudioEngine::submitRebuildIntent(convo::RebuildKind kind,
             }
 
             setRebuildReason(RebuildReason::DeferredFinalizeAware);
+            scheduleDeferredRebuildService();
             emitRebuildTelemetry(RebuildTelemetryEvent::Deferred,
                                  intentId,
                                  RebuildTelemetryReason::MissingSrBs,
@@ -372,6 +399,195 @@ void AudioEngine::submitRebuildIntent(convo::RebuildKind kind,
     }
 }
 
+void AudioEngine::postParameterIntent(ParameterIntentSlot slot, uint64_t value) noexcept
+{
+    // dirty が空から立ったときだけ Message Thread を起こす (以降の post は同じ drain に合流する)
+    if (parameterIntentBus_.post(static_cast<size_t>(slot), value))
+        triggerAsyncUpdate();
+}
+
+void AudioEngine::postParameterIntentEvent(ParameterIntentSlot slot) noexcept
+{
+    if (parameterIntentBus_.postEvent(static_cast<size_t>(slot)))
+        triggerAsyncUpdate();
+}
+
+void AudioEngine::drainParameterIntents() noexcept
+{
+    const auto changed = parameterIntentBus_.drain();
+    if (!changed.any())
+        return;
+
+    // スロット数に関わらず publication は 1 回。rebuild は setter が更新済みの atomic から組み立てる
+    submitRebuildIntent(convo::RebuildKind::Structural,
+                        RebuildTelemetryReason::EnqueueSnapshotCommand,
+                        RebuildTelemetryClass::Snapshot,
+                        RebuildTelemetryPolicy::Replaceable);
+}
+
+void AudioEngine::scheduleDeferredRebuildService(int64_t dueTicks)
+{
+    if (dueTicks <= 0)
+    {
+        m_workerThread.wake();
+        return;
+    }
+
+    const int64_t nowTicks = juce::Time::getHighResolutionTicks();
+    const int64_t ticksPerSecond = juce::Time::getHighResolutionTicksPerSecond();
+    const int64_t remainingTicks = (dueTicks > nowTicks) ? (dueTicks - nowTicks) : 0;
+    // 切り上げ: 期限より前に起きると再予約が 1 回余分に走る
+    const int64_t delayMs = (ticksPerSecond > 0)
+        ? (remainingTicks * 1000 + ticksPerSecond - 1) / ticksPerSecond
+        : 0;
+    m_workerThread.scheduleAfter(std::chrono::milliseconds(delayMs));
+}
+
+void AudioEngine::serviceDeferredRebuilds()
+{
+    if (isShutdownInProgress())
+        return;
+
+    if (hasRebuildReason(RebuildReason::DeferredStructural))
+    {
+        const uint64_t intentId = nextRebuildTelemetryIntentId();
+        const int64_t dueTicks = convo::consumeAtomic(deferredStructuralRebuildDueTicks_, std::memory_order_acquire);
+        const int64_t nowTicks = juce::Time::getHighResolutionTicks();
+
+        if (dueTicks > 0 && nowTicks >= dueTicks)
+        {
+            clearRebuildReason(RebuildReason::DeferredStructural);
+            convo::publishAtomic(deferredStructuralRebuildDueTicks_, 0, std::memory_order_release);
+
+            if (uiConvolverProcessor.isIRLoaded())
+            {
+                diagLog("[DIAG] serviceDeferredRebuilds: issuing deferred Structural rebuild after prepared IR apply");
+                emitRebuildTelemetry(RebuildTelemetryEvent::Deferred,
+                                     intentId,
+                                     RebuildTelemetryReason::DeferredStructuralDue,
+                                     RebuildTelemetryDecision::Released,
+                                     0,
+                                     0,
+                                     RebuildTelemetryClass::Structural,
+                                     RebuildTelemetryPolicy::NA,
+                                     "deferred_structural");
+                submitRebuildIntent(convo::RebuildKind::Structural,
+                                    RebuildTelemetryReason::DeferredStructuralRebuildRequested,
+                                    RebuildTelemetryClass::Structural,
+                                    RebuildTelemetryPolicy::Replaceable);
+
+                ++pendingIRGeneration;
+                setIRChangeFlag();
+
+                const LearningCommand cmd {
+                    LearningCommand::Type::IRChanged,
+                    false,
+                    convo::consumeAtomic(pendingLearningMode, std::memory_order_acquire),
+                    pendingIRGeneration
+                };
+
+                if (!enqueueLearningCommand(cmd))
+                {
+                    DBG("[AudioEngine] serviceDeferredRebuilds: deferred command queue overflow");
+                }
+            }
+        }
+        else if (dueTicks > 0)
+        {
+            // 期限未到来: 期限ちょうどに起き直す
+            scheduleDeferredRebuildService(dueTicks);
+        }
+    }
+
+    if (hasRebuildReason(RebuildReason::DeferredFinalizeAware))
+    {
+        const uint64_t intentId = nextRebuildTelemetryIntentId();
+        static constexpr int kFinalizeDeferMaxDurationMs = 2000;
+        const int64_t nowTicks = juce::Time::getHighResolutionTicks();
+        const int64_t ticksPerSecond = juce::Time::getHighResolutionTicksPerSecond();
+        const int64_t maxDeferTicks = (ticksPerSecond * kFinalizeDeferMaxDurationMs) / 1000;
+
+        int64_t firstSeenTicks = convo::consumeAtomic(deferredFinalizeFirstSeenTicks_, std::memory_order_acquire);
+        if (firstSeenTicks <= 0)
+        {
+            convo::publishAtomic(deferredFinalizeFirstSeenTicks_, nowTicks, std::memory_order_release);
+            firstSeenTicks = nowTicks;
+        }
+
+        const int64_t elapsedTicks = (nowTicks >= firstSeenTicks) ? (nowTicks - firstSeenTicks) : 0;
+        const bool timedOut = (maxDeferTicks > 0) && (elapsedTicks >= maxDeferTicks);
+        const double elapsedMs = (ticksPerSecond > 0)
+            ? (static_cast<double>(elapsedTicks) * 1000.0 / static_cast<double>(ticksPerSecond))
+            : 0.0;
+
+        const int queuedGeneration = convo::consumeAtomic(rebuildRequestGeneration, std::memory_order_acquire);
+        const int committedGeneration = convo::consumeAtomic(lastCommittedRebuildGeneration, std::memory_order_acquire);
+        const bool outstandingRebuild = queuedGeneration > committedGeneration;
+        const bool irLoaded = uiConvolverProcessor.isIRLoaded();
+        const bool irFinalized = uiConvolverProcessor.isIRFinalized();
+        const bool irLoading = uiConvolverProcessor.isLoadingIR();
+        const bool structuralDeferred = hasRebuildReason(RebuildReason::DeferredStructural);
+        const bool pendingIrChange = convo::consumeAtomic(m_pendingIRChange, std::memory_order_acquire);
+
+        // IR 遷移が完全に落ち着いてから 1 回だけ再構築を発火する。
+        const bool finalizeReady = (!irLoaded || irFinalized)
+            && !irLoading
+            && !structuralDeferred
+            && !pendingIrChange
+            && !outstandingRebuild;
+
+        if (finalizeReady || timedOut)
+        {
+            clearRebuildReason(RebuildReason::DeferredFinalizeAware);
+            convo::publishAtomic(deferredFinalizeFirstSeenTicks_, 0, std::memory_order_release);
+
+            const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
+            if (!m_isRestoringState && sr > 0.0)
+            {
+                if (timedOut && !finalizeReady)
+                {
+                    diagLog("[DIAG] serviceDeferredRebuilds: finalize defer timeout reached, forcing rebuild dispatch");
+                    emitRebuildTelemetry(RebuildTelemetryEvent::ForcedDispatch,
+                                         intentId,
+                                         RebuildTelemetryReason::DeferredFinalizeRebuildRequested,
+                                         RebuildTelemetryDecision::Dispatched,
+                                         0,
+                                         0,
+                                         RebuildTelemetryClass::FinalizeAware,
+                                         RebuildTelemetryPolicy::MustExecute,
+                                         "deferred_finalize_timeout",
+                                         elapsedMs);
+                }
+                else
+                {
+                    diagLog("[DIAG] serviceDeferredRebuilds: issuing deferred finalize-aware rebuild");
+                    emitRebuildTelemetry(RebuildTelemetryEvent::Deferred,
+                                         intentId,
+                                         RebuildTelemetryReason::DeferredFinalizeReady,
+                                         RebuildTelemetryDecision::Released,
+                                         0,
+                                         0,
+                                         RebuildTelemetryClass::FinalizeAware,
+                                         RebuildTelemetryPolicy::NA,
+                                         "deferred_finalize_aware");
+                }
+
+                submitRebuildIntent(convo::RebuildKind::Structural,
+                                    RebuildTelemetryReason::DeferredFinalizeRebuildRequested,
+                                    RebuildTelemetryClass::FinalizeAware,
+                                    RebuildTelemetryPolicy::MustExecute);
+            }
+        }
+        else
+        {
+            // IR 遷移 / 未コミット rebuild の完了は通知されないため、タイムアウトまで短い間隔で判定し直す
+            static constexpr int64_t kFinalizeDeferPollMs = 20;
+            const int64_t remainingMs = static_cast<int64_t>(kFinalizeDeferMaxDurationMs) - static_cast<int64_t>(elapsedMs);
+            m_workerThread.scheduleAfter(std::chrono::milliseconds(juce::jlimit<int64_t>(1, kFinalizeDeferPollMs, remainingMs)));
+        }
+    }
+}
+
 void AudioEngine::handleAsyncUpdate()
 {
     if (isShutdownInProgress())
@@ -379,6 +595,12 @@ void AudioEngine::handleAsyncUpdate()
 
     // [PR-3] Old pending commit path removed. Orchestrator handles deferred commits.
 
+    // パラメータ合流バスを先に消化する (Structural の非MT要求と重なっても requestRebuild 側で重複判定される)
+    drainParameterIntents();
+
+    // 期限駆動ワーカーに起こされた遅延 rebuild (期限未到来なら再予約のみ)
+    serviceDeferredRebuilds();
+
     // 非MT起点の Structural rebuild 要求を消費して実行する
     if (clearRebuildReason(RebuildReason::StructuralFromNonMT))
     {
@@ -417,6 +639,7 @@ void AudioEngine::handleAsyncUpdate()
         else
         {
             setRebuildReason(RebuildReason::DeferredFinalizeAware);
+            scheduleDeferredRebuildService();
             emitRebuildTelemetry(RebuildTelemetryEvent::Deferred,
                                  intentId,
                                  RebuildTelemetryReason::AsyncBridgeMissingSrBs,
@@ -570,32 +793,53 @@ void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool fo
 
     RebuildTask task;
     task.currentDSP = nullptr;
-    task.buildInput.sampleRate = sampleRate;
-    task.buildInput.blockSize = samplesPerBlock;
-    task.buildInput.ditherBitDepth = paramSnapshot.ditherDepth;
-    task.buildInput.oversamplingFactor = paramSnapshot.oversamplingFactor;
-    task.buildInput.oversamplingType = static_cast<int>(paramSnapshot.oversamplingType);
-    task.buildInput.noiseShaperType = static_cast<int>(paramSnapshot.noiseShaperType);
-    task.buildInput.processingOrder = static_cast<int>(paramSnapshot.processingOrder);
-    task.buildInput.eqBypassed = paramSnapshot.eqBypassed;
-    task.buildInput.convBypassed = paramSnapshot.convBypassed;
-    task.buildInput.softClipEnabled = paramSnapshot.softClipEnabled;
-    task.buildInput.saturationAmount = paramSnapshot.saturationAmount;
-    task.buildInput.inputHeadroomGain = paramSnapshot.inputHeadroomGain;
-    task.buildInput.outputMakeupGain = paramSnapshot.outputMakeupGain;
-    task.buildInput.convolverInputTrimGain = paramSnapshot.convolverInputTrimGain;
-    task.buildInput.autoGainStagingEnabled = paramSnapshot.autoGainStagingEnabled;
+    task.buildInput = makeBuildInput(sampleRate, samplesPerBlock, paramSnapshot);
     task.convolverBuildSnapshot = uiConvolverProcessor.captureBuildSnapshot();
     const uint64_t structuralHash = uiConvolverProcessor.isIRLoaded() ? uiConvolverProcessor.getStructuralHash() : 0;
 
+    // ★ A/B 切替直後: 状態復元が発火した rebuild が再公開済みの常駐 DSPCore と同じなら組み直さない
+    if (!forceMustExecute
+        && shouldSuppressRebuildForABResident(task.buildInput, task.convolverBuildSnapshot.fingerprint))
+    {
+        diagLog("[DIAG] requestRebuild(sr,bs): SUPPRESSED by republished A/B resident slot="
+            + juce::String(convo::abSlotName(activeABSlot_)));
+        emitRebuildTelemetry(RebuildTelemetryEvent::Suppressed,
+                             intentId,
+                             RebuildTelemetryReason::ABResidentRepublished,
+                             RebuildTelemetryDecision::Suppressed,
+                             structuralHash,
+                             task.convolverBuildSnapshot.fingerprint,
+                             RebuildTelemetryClass::Structural,
+                             collapsePolicy);
+        return;
+    }
+
     DSPCore* currentToRelease = nullptr;
+    DSPCore* overtakenLightToRelease = nullptr;
+    RebuildLane lane = RebuildLane::Heavy;
     bool queued = false;
     bool blockedAsDuplicate = false;
     const bool allowDuplicateSuppression = !forceMustExecute;
     {
         std::lock_guard<std::mutex> lock(rebuildMutex);
 
-        if (hasPendingTask)
+        // ★ レーン判定: 構造入力が直近に queue したタスクと同じなら Light。
+        //   Heavy が未着手で pending の間は、その Heavy へ合流させる (latest wins)。
+        const auto& lastQueued = lastQueuedTaskSignature;
+        const bool sameStructureAsLastQueued = lastQueued.generation > 0
+            && std::abs(lastQueued.buildInput.sampleRate - task.buildInput.sampleRate) <= 1.0e-6
+            && lastQueued.buildInput.blockSize == task.buildInput.blockSize
+            && lastQueued.buildInput.oversamplingFactor == task.buildInput.oversamplingFactor
+            && lastQueued.buildInput.oversamplingType == task.buildInput.oversamplingType
+            && lastQueued.buildInput.oversamplingSinglePrecision == task.buildInput.oversamplingSinglePrecision
+            && lastQueued.convolverBuildSnapshot.fingerprint == task.convolverBuildSnapshot.fingerprint;
+        lane = (sameStructureAsLastQueued && !rebuildLane(RebuildLane::Heavy).hasPendingTask)
+            ? RebuildLane::Light
+            : RebuildLane::Heavy;
+        auto& laneSlot = rebuildLane(lane);
+        auto& pendingTask = laneSlot.pendingTask;
+
+        if (laneSlot.hasPendingTask)
         {
             if (allowDuplicateSuppression)
             {
@@ -603,6 +847,7 @@ void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool fo
                 pendingSnapshot.ditherDepth = pendingTask.buildInput.ditherBitDepth;
                 pendingSnapshot.oversamplingFactor = pendingTask.buildInput.oversamplingFactor;
                 pendingSnapshot.oversamplingType = static_cast<OversamplingType>(pendingTask.buildInput.oversamplingType);
+                pendingSnapshot.oversamplingSinglePrecision = pendingTask.buildInput.oversamplingSinglePrecision;
                 pendingSnapshot.noiseShaperType = static_cast<NoiseShaperType>(pendingTask.buildInput.noiseShaperType);
                 pendingSnapshot.processingOrder = static_cast<ProcessingOrder>(pendingTask.buildInput.processingOrder);
                 pendingSnapshot.eqBypassed = pendingTask.buildInput.eqBypassed;
@@ -641,6 +886,13 @@ void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool fo
         {
             generation = ++rebuildRequestGeneration;
             task.generation = generation;
+            if (lane == RebuildLane::Heavy)
+            {
+                // release: Heavy レーンの isRebuildObsolete (acquire) と HB
+                convo::publishAtomic(heavyRebuildGeneration_, generation, std::memory_order_release);
+                // 未着手の Light はこの Heavy に追い越されるため、着手させずに捨てる
+                overtakenLightToRelease = takePendingRebuildTaskLocked(RebuildLane::Light);
+            }
             task.runtimeBuildSnapshot = sealRuntimeBuildSnapshot(finalizeRuntimeBuildSnapshot(
                 captureRuntimeBuildSnapshot(task.buildInput,
                                             task.convolverBuildSnapshot,
@@ -663,7 +915,7 @@ void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool fo
                     if (eqState)
                     {
                         const auto eqResult = getEQProcessor().computeEstimatedMaxGainComplex(
-                            *eqState, processingRate);
+                            *eqState, processingRate, &eqResponseCache_);
 
                         // ★ v14.42: Builder collapse — max(measured, upperBound)
                         convo::BuildDiagnostics diag;
@@ -709,8 +961,8 @@ void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool fo
                 task.buildAnalysis = convo::sealBuildAnalysis(analysis, &task.runtimeBuildSnapshot);
             }
             pendingTask = task;
-            hasPendingTask = true;
-            convo::publishAtomic(rebuildBacklog_, static_cast<std::uint64_t>(1), std::memory_order_release);
+            laneSlot.hasPendingTask = true;
+            publishRebuildBacklogLocked();
             lastQueuedTaskSignature = task;
             rtAuxMutable_.lastQueuedTaskTicks = juce::Time::getHighResolutionTicks();
             queued = true;
@@ -722,6 +974,7 @@ void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool fo
         convo::fetchAddAtomic(rtAuxMutable_.debugRebuildDispatchQueuedCount, 1, std::memory_order_acq_rel);
         rebuildCV.notify_all();
         diagLog("[DIAG] requestRebuild(sr,bs): task queued generation=" + juce::String(generation)
+            + " lane=" + juce::String(rebuildLaneToString(lane))
             + " SR=" + juce::String(sampleRate, 2));
         const double latencyMs = juce::Time::getMillisecondCounterHiRes() - requestStartMs;
         emitRebuildTelemetry(RebuildTelemetryEvent::Dispatched,
@@ -756,10 +1009,13 @@ void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool fo
     }
 
     // Destroy orphaned DSP objects outside the lock.
-    if (currentToRelease)
+    if (currentToRelease || overtakenLightToRelease)
     {
         DSPLifetimeManager lifetimeMgr(*this);
-        lifetimeMgr.retire(currentToRelease);
+        if (currentToRelease)
+            lifetimeMgr.retire(currentToRelease);
+        if (overtakenLightToRelease)
+            lifetimeMgr.retire(overtakenLightToRelease);
     }
 
     juce::ignoreUnused(queued);
@@ -771,21 +1027,60 @@ void AudioEngine::stopRebuildThread()
 {
     setShutdownPhase(ShutdownPhase::StopWorkers, "stopRebuildThread");
 
+    requestRebuildThreadStop();
+
+    for (auto& laneSlot : rebuildLanes_)
+    {
+        if (laneSlot.thread.joinable())
+            laneSlot.thread.join();
+    }
+}
+
+void AudioEngine::requestRebuildThreadStop() noexcept
+{
     // exit フラグを立てる（predicate が次に評価された時に break する）
-    convo::publishAtomic(rebuildThreadShouldExit, true, std::memory_order_release);
+    convo::publishAtomic(rebuildThreadShouldExit, true, std::memory_order_release); // release: rebuildThreadLoop の acquire と HB
 
     // 待機中のスレッドを確実に起こす
     rebuildCV.notify_all();
+}
+
+void AudioEngine::startRebuildThreads()
+{
+    for (size_t i = 0; i < kRebuildLaneCount; ++i)
+    {
+        auto& laneSlot = rebuildLanes_[i];
+        if (!laneSlot.thread.joinable())
+            laneSlot.thread = std::thread(&AudioEngine::rebuildThreadLoop, this, static_cast<RebuildLane>(i));
+    }
+}
 
-    if (rebuildThread.joinable())
-        rebuildThread.join();
+AudioEngine::DSPCore* AudioEngine::takePendingRebuildTaskLocked(RebuildLane lane) noexcept
+{
+    auto& laneSlot = rebuildLane(lane);
+    if (!laneSlot.hasPendingTask)
+        return nullptr;
+
+    DSPCore* const currentDSP = laneSlot.pendingTask.currentDSP;
+    laneSlot.pendingTask.currentDSP = nullptr;
+    laneSlot.hasPendingTask = false;
+    publishRebuildBacklogLocked();
+    return currentDSP;
+}
 
+void AudioEngine::publishRebuildBacklogLocked() noexcept
+{
+    std::uint64_t backlog = 0;
+    for (const auto& laneSlot : rebuildLanes_)
+        backlog += laneSlot.hasPendingTask ? 1u : 0u;
+    convo::publishAtomic(rebuildBacklog_, backlog, std::memory_order_release);
 }
 
 
 
-void AudioEngine::rebuildThreadLoop()
+void AudioEngine::rebuildThreadLoop(RebuildLane lane)
 {
+    // 両レーンとも DSPCore 構築 (IR 変換を含みうる) を行うため同じ背景ポリシーで走らせる
     affinityManager.applyCurrentThreadPolicy(ThreadType::HeavyBackground);
 
     // Set denormal handling modes for this thread. This is crucial for performance
@@ -795,7 +1090,8 @@ void AudioEngine::rebuildThreadLoop()
     _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
     _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 
-    convo::publishAtomic(rebuildThreadIsRunning, true, std::memory_order_release);
+    convo::fetchAddAtomic(rebuildThreadRunningCount, 1, std::memory_order_acq_rel); // acq_rel: 稼働数の観測と HB
+    auto& laneSlot = rebuildLane(lane);
 
     while (true)
     {
@@ -804,24 +1100,29 @@ void AudioEngine::rebuildThreadLoop()
             RebuildTask task;
             {
                 std::unique_lock<std::mutex> lock(rebuildMutex);
-                rebuildCV.wait(lock, [this] { return hasPendingTask || convo::consumeAtomic(rebuildThreadShouldExit, std::memory_order_acquire); });
+                rebuildCV.wait(lock, [this, &laneSlot] { return laneSlot.hasPendingTask || convo::consumeAtomic(rebuildThreadShouldExit, std::memory_order_acquire); });
 
                 if (convo::consumeAtomic(rebuildThreadShouldExit, std::memory_order_acquire)) break;
                 if (isShutdownInProgress())
                 {
-                    hasPendingTask = false;
-                    pendingTask.currentDSP = nullptr;
+                    laneSlot.hasPendingTask = false;
+                    laneSlot.pendingTask.currentDSP = nullptr;
+                    publishRebuildBacklogLocked();
                     break;
                 }
 
                 // Copy task and clear pendingTask pointers to transfer ownership
-                task = pendingTask;
-                pendingTask.currentDSP = nullptr;
+                task = laneSlot.pendingTask;
+                laneSlot.pendingTask.currentDSP = nullptr;
 
-                hasPendingTask = false;
-                convo::publishAtomic(rebuildBacklog_, static_cast<std::uint64_t>(0), std::memory_order_release);
+                laneSlot.hasPendingTask = false;
+                publishRebuildBacklogLocked();
             }
 
+            // 再構築中は共有スケジューラに申告し、アップグレード変換・学習をせき止める (タスク 1 件分)
+            const convo::BackgroundScheduler::ActivityScope rebuildActivity(&backgroundScheduler_,
+                                                                            convo::BackgroundPriority::InteractiveRebuild);
+
             struct DSPGuard
             {
                 AudioEngine* owner;
@@ -861,7 +1162,7 @@ void AudioEngine::rebuildThreadLoop()
 
             // Helper to check obsolescence
             const auto isObsolete = [&] {
-                return isRebuildObsolete(task.generation) || convo::consumeAtomic(rebuildThreadShouldExit, std::memory_order_acquire);
+                return isRebuildObsolete(task.generation, lane) || convo::consumeAtomic(rebuildThreadShouldExit, std::memory_order_acquire);
             };
 
             if (isObsolete()) {
@@ -923,10 +1224,16 @@ void AudioEngine::rebuildThreadLoop()
                     continue;
                 }
                 const double rebuildIrStartMs = juce::Time::getMillisecondCounterHiRes();
+                // Incremental rebuild 有効時のスライス予算: Light はユーザーが結果を待つ操作、Heavy は構造変更
+                newDSP->convolverRt().setIncrementalRebuildPriority(lane == RebuildLane::Light
+                    ? ConvolverProcessor::IncrementalRebuildPriority::Interactive
+                    : ConvolverProcessor::IncrementalRebuildPriority::Normal);
                 newDSP->convolverRt().rebuildAllIRsSynchronous(isObsolete);
                 rebuildIrElapsedMs = juce::Time::getMillisecondCounterHiRes() - rebuildIrStartMs;
+                newDSP->eqFoldedIntoIR = newDSP->convolverRt().isEQFoldedIntoIR();
             }
             diagLog("[DIAG] rebuildThreadLoop: generation=" + juce::String(task.generation)
+                + " lane=" + juce::String(rebuildLaneToString(lane))
                 + " build=" + juce::String(buildElapsedMs, 1) + "ms"
                 + " rebuildIR=" + juce::String(rebuildIrElapsedMs, 1) + "ms");
 
@@ -970,6 +1277,10 @@ void AudioEngine::rebuildThreadLoop()
 
             // 4. Refresh Latency (Prevent pitch slide during fade-in)
             newDSP->convolverRt().refreshLatency();
+            newDSP->eqSplitRate = convo::consumeAtomic(eqSplitRateEnabled, std::memory_order_acquire); // acquire: setEQSplitRateEnabled の acq_rel と HB
+            newDSP->adaptiveSoftClipOS = convo::consumeAtomic(adaptiveSoftClipOSEnabled, std::memory_order_acquire); // acquire: setAdaptiveSoftClipOSEnabled の acq_rel と HB
+            newDSP->configureConvolverPipeline(convo::consumeAtomic(pipelinedConvolverEnabled, std::memory_order_acquire), this); // acquire: setPipelinedConvolverEnabled の acq_rel と HB
+            newDSP->configureChannelSplit(convo::consumeAtomic(channelSplitEnabled, std::memory_order_acquire), this); // acquire: setChannelSplitEnabled の acq_rel と HB
 
             // 5. Fade In
             newDSP->ramps().fadeInSamplesLeft = DSPCore::FADE_IN_SAMPLES;
@@ -1002,6 +1313,17 @@ void AudioEngine::rebuildThreadLoop()
             task.runtimeBuildSnapshot.oversamplingFactor = static_cast<int>(newDSP->oversamplingFactor);
 
             // 6. Commit on Message Thread
+            // ★ レーン間の publication 投入は 1 本ずつ、世代順に行う。
+            //   Light が先に新しい世代を出版していれば、遅れて完成した Heavy は出さずに破棄する。
+            std::lock_guard<std::mutex> commitLock(rebuildCommitMutex);
+            if (task.generation <= convo::consumeAtomic(lastSubmittedRebuildGeneration_, std::memory_order_acquire))
+            {
+                diagLog("[DIAG] rebuildThreadLoop: overtaken by a newer publication gen="
+                    + juce::String(task.generation)
+                    + " lane=" + juce::String(rebuildLaneToString(lane)));
+                continue;
+            }
+
             // Release ownership from guard, pass to commitNewDSP
             DSPCore* dspToCommit = dspGuard.ptr;
             dspGuard.ptr = nullptr;
@@ -1023,6 +1345,8 @@ void AudioEngine::rebuildThreadLoop()
             }
 #endif
             enqueuePublicationIntentForRuntimeCommit(dspToCommit, task.generation, task.runtimeBuildSnapshot, task.buildAnalysis, task.oversamplingResult, task.buildDiagnostics);
+            // release: isRebuildGenerationPublishable (acquire) と HB。commitLock 下で単調増加
+            convo::publishAtomic(lastSubmittedRebuildGeneration_, task.generation, std::memory_order_release);
         }
         catch (const std::exception& e)
         {
@@ -1035,5 +1359,186 @@ void AudioEngine::rebuildThreadLoop()
         }
     }
 
-    convo::publishAtomic(rebuildThreadIsRunning, false, std::memory_order_release);
+    convo::fetchAddAtomic(rebuildThreadRunningCount, -1, std::memory_order_acq_rel); // acq_rel: 稼働数の観測と HB
+}
+
+//==============================================================================
+// オフライン一括レンダー用の独立ランタイム
+//==============================================================================
+AudioEngine::OfflineRuntime::OfflineRuntime(AudioEngine& ownerRef,
+                                            DSPCore* runtime,
+                                            const DSPCore::ProcessingState& processingState,
+                                            int latency) noexcept
+    : owner(ownerRef),
+      dsp(runtime),
+      state(processingState),
+      latencySamples(latency)
+{
+}
+
+AudioEngine::OfflineRuntime::~OfflineRuntime()
+{
+    // World へ公開していないので retire を経由せず直接破棄する
+    destroyDSPCoreNode(dsp);
+}
+
+int AudioEngine::OfflineRuntime::getBlockSize() const noexcept
+{
+    return bridge != nullptr ? outerBlockSize : dsp->preparedHostBlockSize;
+}
+
+double AudioEngine::OfflineRuntime::getSampleRate() const noexcept
+{
+    return bridge != nullptr ? bridge->getOuterRate() : dsp->sampleRate;
+}
+
+int AudioEngine::OfflineRuntime::getLatencySamples() const noexcept
+{
+    if (bridge == nullptr)
+        return latencySamples;
+    return static_cast<int>(std::lround(static_cast<double>(latencySamples) * bridge->getOuterRate() / bridge->getInnerRate()))
+         + bridge->getLatencySamples();
+}
+
+void AudioEngine::OfflineRuntime::reset()
+{
+    dsp->reset();
+    dsp->ramps().fadeInSamplesLeft = 0;
+    if (bridge != nullptr)
+        bridge->reset();
+}
+
+convo::BuildInput AudioEngine::captureBuildInputForRebuild(double sampleRate, int blockSize) const noexcept
+{
+    return makeBuildInput(sampleRate, blockSize, captureBuildParameterSnapshot(*this));
+}
+
+void AudioEngine::OfflineRuntime::process(juce::AudioBuffer<double>& buffer) noexcept
+{
+    const juce::ScopedNoDenormals noDenormals;
+    // DSPCore 内の RT 表明は processBlockDouble と同じ役割で判定させる
+    const convo::numeric_policy::ScopedThreadRole renderScope(convo::numeric_policy::ThreadRole::AudioRealtime);
+    // analyzerEnabled = false のため analyzerFifo へは書かない
+    if (bridge == nullptr)
+    {
+        dsp->processDouble(buffer, owner.analyzerFifo, nullptr, nullptr, state);
+        return;
+    }
+
+    double* channels[convo::FixedRateBridge<double>::kMaxChannels] = {};
+    const int numChannels = std::min(convo::FixedRateBridge<double>::kMaxChannels, buffer.getNumChannels());
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch] = buffer.getWritePointer(ch);
+    if (bridge->process(channels, numChannels, buffer.getNumSamples(),
+            [this](double* const* blockChannels, int blockSamples)
+            {
+                juce::AudioBuffer<double> blockBuffer(blockChannels, bridge->getNumChannels(), blockSamples);
+                dsp->processDouble(blockBuffer, owner.analyzerFifo, nullptr, nullptr, state);
+            }) < 0)
+        buffer.clear();
+}
+
+std::unique_ptr<AudioEngine::OfflineRuntime> AudioEngine::createOfflineRuntime()
+{
+    ASSERT_NON_RT_THREAD();
+    const std::lock_guard<std::mutex> lock(offlineRuntimeBuildMutex);
+
+    if (!isRuntimeSettled())
+        return nullptr;
+
+    const auto readToken = RuntimePublicationCoordinator::acquireReadToken(runtimeStore);
+    const auto* world = RuntimePublicationCoordinator::consumeWorldHandle(runtimeStore, readToken);
+    auto* live = (world != nullptr) ? static_cast<DSPCore*>(world->engine.current) : nullptr;
+    if (live == nullptr)
+        return nullptr;
+
+    // rebuild thread と同じ入力・手順で組む。レートとブロック長は公開中の DSP に揃える
+    const convo::BuildInput buildInput = makeBuildInput(live->sampleRate,
+                                                        live->preparedHostBlockSize,
+                                                        captureBuildParameterSnapshot(*this));
+    convo::RuntimeBuilder runtimeBuilder(*this);
+    const convo::BuildResult buildResult = runtimeBuilder.build(buildInput, uiConvolverProcessor.captureBuildSnapshot());
+    if (buildResult.runtime == nullptr)
+    {
+        diagLog("[OfflineRuntime] build failed error=" + juce::String(convo::toString(buildResult.error)));
+        return nullptr;
+    }
+
+    struct DSPGuard
+    {
+        DSPCore* ptr;
+        ~DSPGuard() { if (ptr != nullptr) destroyDSPCoreNode(ptr); }
+    } dspGuard { buildResult.runtime };
+    auto* dsp = dspGuard.ptr;
+
+    if (dsp->convolverRt().getIRLength() > 0)
+    {
+        // 公開中の Convolver と入力が一致するので、IR スペクトルは FFT せずに参照を共有する
+        dsp->convolverRt().setExternalSpectraDonor(&live->convolverRt());
+        dsp->convolverRt().setIncrementalRebuildPriority(ConvolverProcessor::IncrementalRebuildPriority::Interactive);
+        dsp->convolverRt().rebuildAllIRsSynchronous();
+        dsp->convolverRt().setExternalSpectraDonor(nullptr);
+        dsp->eqFoldedIntoIR = dsp->convolverRt().isEQFoldedIntoIR();
+    }
+
+    const auto warmupError = runtimeBuilder.validateWarmup(*dsp);
+    if (warmupError != convo::BuildError::None)
+    {
+        diagLog("[OfflineRuntime] warmup failed error=" + juce::String(convo::toString(warmupError)));
+        return nullptr;
+    }
+
+    dsp->convolverRt().refreshLatency();
+    dsp->eqSplitRate = convo::consumeAtomic(eqSplitRateEnabled, std::memory_order_acquire); // acquire: setEQSplitRateEnabled の acq_rel と HB
+    dsp->adaptiveSoftClipOS = convo::consumeAtomic(adaptiveSoftClipOSEnabled, std::memory_order_acquire); // acquire: setAdaptiveSoftClipOSEnabled の acq_rel と HB
+    // ワーカーが 1 コアを専有するので、2 本目の RT スレッドを使う段は組まない
+    dsp->configureConvolverPipeline(false, this);
+    dsp->configureChannelSplit(false, this);
+    // 公開中の DSP はフェードインを終えているため、定常状態から始めて同じ出力にする
+    dsp->ramps().fadeInSamplesLeft = 0;
+
+    auto state = buildAudioThreadProcessingState(dsp, captureAudioThreadParameterSnapshot(world));
+    state.analyzerEnabled = false;
+    state.adaptiveCaptureQueue = nullptr;
+    state.deviceCodeGain = 1.0;
+    state.stageLatency = nullptr;   // Audio Thread 以外から書かない
+    state.meteringTap = nullptr;
+
+    const auto latency = getCurrentLatencyBreakdown();
+    const int latencySamples = juce::jmax(0, latency.totalLatencyBaseRateSamples
+                                             - latency.convolverPipelineLatencyBaseRateSamples
+                                             - latency.fixedBlockReblockLatencyBaseRateSamples);
+
+    // 固定内部レート: 公開中の DSP と同じくデバイスのレート (= 入力ファイルのレート) との間に SRC を挟む。
+    // 読み書きは 1 ワーカーが直列に行うので、FIFO が枯れないよう空運転もそのブロック長で行う
+    std::unique_ptr<convo::FixedRateBridge<double>> bridge;
+    int outerBlockSize = 0;
+    const double outerRate = convo::consumeAtomic(deviceSampleRate, std::memory_order_acquire); // acquire: prepareToPlay の release と HB
+    if (convo::consumeAtomic(fixedInternalSampleRateHz, std::memory_order_acquire) > 0 // acquire: setFixedInternalSampleRate の release と HB
+        && outerRate > 0.0 && std::abs(outerRate - dsp->sampleRate) > 1e-6)
+    {
+        outerBlockSize = std::max(1, static_cast<int>(std::floor(
+            static_cast<double>(dsp->preparedHostBlockSize - 1) * outerRate / dsp->sampleRate)) - 1);
+        bridge = std::make_unique<convo::FixedRateBridge<double>>();
+        if (!bridge->prepare(2, outerRate, dsp->sampleRate, outerBlockSize, outerBlockSize,
+                             convo::consumeAtomic(fixedInternalRateMinimumPhase, std::memory_order_acquire))) // acquire: setFixedInternalSampleRate の release と HB
+        {
+            diagLog("[OfflineRuntime] SRC prepare failed");
+            return nullptr;
+        }
+    }
+
+    diagLog("[OfflineRuntime] created sr=" + juce::String(dsp->sampleRate, 1)
+            + " block=" + juce::String(dsp->preparedHostBlockSize)
+            + " latencySamples=" + juce::String(latencySamples)
+            + (bridge != nullptr ? " outerSr=" + juce::String(bridge->getOuterRate(), 1)
+                                   + " outerBlock=" + juce::String(outerBlockSize)
+                                   + " srcLatency=" + juce::String(bridge->getLatencySamples())
+                                 : juce::String()));
+
+    auto* runtime = std::exchange(dspGuard.ptr, nullptr);
+    auto offline = std::unique_ptr<OfflineRuntime>(new OfflineRuntime(*this, runtime, state, latencySamples));
+    offline->bridge = std::move(bridge);
+    offline->outerBlockSize = outerBlockSize;
+    return offline;
 }
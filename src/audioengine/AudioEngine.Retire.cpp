@@ -2,6 +2,8 @@
 #include "AudioEngine.h"
 #include "RuntimePublicationOrchestrator.h"
 #include "ISRRetireRouter.h"
+#include "EtwTrace.h"
+#include "core/TimeUtils.h"
 
 //==============================================================================
 // [P0-15] Retire PR: Retire / reclaim operations
@@ -44,12 +46,20 @@ void AudioEngine::drainDeferredRetireQueues(bool allowDuringShutdown) noexcept
         return;
 
     const double startMs = juce::Time::getMillisecondCounterHiRes();
+    const bool etwRetire = convo::EtwTrace::isEnabled(convo::EtwTrace::kRetire);
+    const std::uint64_t etwStartUs = etwRetire ? convo::getCurrentTimeUs() : 0;
+    const std::uint64_t etwPendingBefore = etwRetire
+        ? static_cast<std::uint64_t>(m_retireRouter->pendingRetireCount()) : 0;
 
-    runtimePublicationBridge_.setReclaimInFlightCount(1);
-    m_retireRouter->tryReclaim();
-    // [P1-21] epoch-free API: minReaderEpoch を直接渡す
-    m_coordinator.reclaim(m_retireRouter->getMinReaderEpoch());
-    runtimePublicationBridge_.setReclaimInFlightCount(0);
+    {
+        // ★ xrun 原因相関: reclaim バッチと重なった callback に retire フラグを立てる
+        convo::ActivityWindow::Scope reclaimActivity(m_healthMonitor.getXrunCorrelator().retireActivity());
+        runtimePublicationBridge_.setReclaimInFlightCount(1);
+        m_retireRouter->tryReclaim();
+        // [P1-21] epoch-free API: minReaderEpoch を直接渡す
+        m_coordinator.reclaim(m_retireRouter->getMinReaderEpoch());
+        runtimePublicationBridge_.setReclaimInFlightCount(0);
+    }
 
     const std::uint64_t fallbackDepth = 0;
     const std::uint64_t retireDepth = static_cast<std::uint64_t>(m_retireRouter->pendingRetireCount());
@@ -72,6 +82,9 @@ void AudioEngine::drainDeferredRetireQueues(bool allowDuringShutdown) noexcept
 
     const std::uint64_t quarantineResident = retireRuntimeEx_.getQuarantineResidentCount();
     convo::publishAtomic(quarantineResident_, quarantineResident, std::memory_order_release);
+    if (etwRetire)
+        convo::EtwTrace::reclaimBatch(etwPendingBefore, retireDepth, quarantineResident,
+                                      convo::getCurrentTimeUs() - etwStartUs);
 
     const auto computeBackpressureScales = [this, retireDepth, quarantineResident]() noexcept
     {
@@ -50,6 +50,42 @@ void AudioEngine::requestLoadState (const juce::ValueTree& state)
         uiEqEditor.setBypass(bypassed);
     }
 
+    if (state.hasProperty("eqSplitRateEnabled"))
+        convo::publishAtomic(eqSplitRateEnabled, (bool)state.getProperty("eqSplitRateEnabled"), std::memory_order_release); // release: rebuild thread の acquire と HB
+
+    if (state.hasProperty("pipelinedConvolverEnabled"))
+        convo::publishAtomic(pipelinedConvolverEnabled, (bool)state.getProperty("pipelinedConvolverEnabled"), std::memory_order_release); // release: rebuild thread の acquire と HB
+
+    if (state.hasProperty("channelSplitEnabled"))
+        convo::publishAtomic(channelSplitEnabled, (bool)state.getProperty("channelSplitEnabled"), std::memory_order_release); // release: rebuild thread の acquire と HB
+
+    if (state.hasProperty("adaptiveSoftClipOSEnabled"))
+        convo::publishAtomic(adaptiveSoftClipOSEnabled, (bool)state.getProperty("adaptiveSoftClipOSEnabled"), std::memory_order_release); // release: rebuild thread の acquire と HB
+
+    // 固定長リブロック: ブロック上限の変更は Step 4 の rebuild が反映する
+    if (state.hasProperty("fixedBlockReblockEnabled"))
+    {
+        convo::publishAtomic(fixedBlockReblockEnabled, (bool)state.getProperty("fixedBlockReblockEnabled"), std::memory_order_release); // release: Audio Thread / prepareToPlay の acquire と HB
+        static_cast<void>(syncMaxSamplesPerBlockToFixedReblock());
+    }
+
+    // 固定内部レート: 次の prepareToPlay (デバイスの開き直し) で反映する
+    if (state.hasProperty("fixedInternalSampleRate"))
+    {
+        const int rate = juce::jmax(0, (int)state.getProperty("fixedInternalSampleRate"));
+        convo::publishAtomic(fixedInternalSampleRateHz,
+                             rate > 0 ? juce::jlimit(kMinFixedInternalSampleRate, static_cast<int>(SAFE_MAX_SAMPLE_RATE), rate) : 0,
+                             std::memory_order_release); // release: prepareToPlay の acquire と HB
+        convo::publishAtomic(fixedInternalRateMinimumPhase, (bool)state.getProperty("fixedInternalRateMinimumPhase", true), std::memory_order_release); // release: prepareToPlay の acquire と HB
+    }
+
+    // ★ EQ fold: モードのみ復元する (arm は timer が静止判定後に行う)
+    if (state.hasProperty("eqFoldIntoIREnabled"))
+    {
+        cancelEQFoldIntoIR();
+        convo::publishAtomic(eqFoldIntoIREnabled, (bool)state.getProperty("eqFoldIntoIREnabled"), std::memory_order_release); // release: timer 側 acquire と HB
+    }
+
     if (state.hasProperty("convBypassed"))
     {
         bool bypassed = state.getProperty("convBypassed");
@@ -120,7 +156,9 @@ void AudioEngine::requestLoadState (const juce::ValueTree& state)
         setOversamplingType((OversamplingType)(int)state.getProperty("oversamplingType"));
 
     // --- NoiseShaperLearner Settings ---
-    if (state.hasProperty("cmaesRestarts") || state.hasProperty("coeffSafetyMargin") || state.hasProperty("enableStabilityCheck"))
+    if (state.hasProperty("cmaesRestarts") || state.hasProperty("coeffSafetyMargin") || state.hasProperty("enableStabilityCheck")
+        || state.hasProperty("enableRacing") || state.hasProperty("enableScreening") || state.hasProperty("enableCaptureDecimation")
+        || state.hasProperty("learnAllBitDepths"))
     {
         auto s = getNoiseShaperLearnerSettings();
         if (state.hasProperty("cmaesRestarts"))
@@ -129,6 +167,14 @@ void AudioEngine::requestLoadState (const juce::ValueTree& state)
             s.coeffSafetyMargin = static_cast<double>(state.getProperty("coeffSafetyMargin"));
         if (state.hasProperty("enableStabilityCheck"))
             s.enableStabilityCheck = static_cast<bool>(state.getProperty("enableStabilityCheck"));
+        if (state.hasProperty("enableRacing"))
+            s.enableRacing = static_cast<bool>(state.getProperty("enableRacing"));
+        if (state.hasProperty("enableScreening"))
+            s.enableScreening = static_cast<bool>(state.getProperty("enableScreening"));
+        if (state.hasProperty("enableCaptureDecimation"))
+            s.enableCaptureDecimation = static_cast<bool>(state.getProperty("enableCaptureDecimation"));
+        if (state.hasProperty("learnAllBitDepths"))
+            s.learnAllBitDepths = static_cast<bool>(state.getProperty("learnAllBitDepths"));
         setNoiseShaperLearnerSettings(s);
     }
 
@@ -195,9 +241,21 @@ void AudioEngine::requestLoadState (const juce::ValueTree& state)
         state.setProperty("cmaesRestarts", convo::consumeAtomic(s.cmaesRestarts, std::memory_order_acquire), nullptr);
         state.setProperty("coeffSafetyMargin", convo::consumeAtomic(s.coeffSafetyMargin, std::memory_order_acquire), nullptr);
         state.setProperty("enableStabilityCheck", convo::consumeAtomic(s.enableStabilityCheck, std::memory_order_acquire), nullptr);
+        state.setProperty("enableRacing", convo::consumeAtomic(s.enableRacing, std::memory_order_acquire), nullptr);
+        state.setProperty("enableScreening", convo::consumeAtomic(s.enableScreening, std::memory_order_acquire), nullptr);
+        state.setProperty("enableCaptureDecimation", convo::consumeAtomic(s.enableCaptureDecimation, std::memory_order_acquire), nullptr);
+        state.setProperty("learnAllBitDepths", convo::consumeAtomic(s.learnAllBitDepths, std::memory_order_acquire), nullptr);
     }
 
     state.setProperty("eqBypassed", convo::consumeAtomic(eqBypassRequested, std::memory_order_acquire), nullptr);
+    state.setProperty("eqSplitRateEnabled", convo::consumeAtomic(eqSplitRateEnabled, std::memory_order_acquire), nullptr);
+    state.setProperty("pipelinedConvolverEnabled", convo::consumeAtomic(pipelinedConvolverEnabled, std::memory_order_acquire), nullptr);
+    state.setProperty("channelSplitEnabled", convo::consumeAtomic(channelSplitEnabled, std::memory_order_acquire), nullptr);
+    state.setProperty("adaptiveSoftClipOSEnabled", convo::consumeAtomic(adaptiveSoftClipOSEnabled, std::memory_order_acquire), nullptr);
+    state.setProperty("fixedBlockReblockEnabled", convo::consumeAtomic(fixedBlockReblockEnabled, std::memory_order_acquire), nullptr);
+    state.setProperty("fixedInternalSampleRate", convo::consumeAtomic(fixedInternalSampleRateHz, std::memory_order_acquire), nullptr);
+    state.setProperty("fixedInternalRateMinimumPhase", convo::consumeAtomic(fixedInternalRateMinimumPhase, std::memory_order_acquire), nullptr);
+    state.setProperty("eqFoldIntoIREnabled", convo::consumeAtomic(eqFoldIntoIREnabled, std::memory_order_acquire), nullptr);
     state.setProperty("convBypassed", convo::consumeAtomic(convBypassRequested, std::memory_order_acquire), nullptr);
     // 出力周波数フィルターモードの保存
     state.setProperty("convHCFilterMode", (int)convo::consumeAtomic(convHCFilterMode, std::memory_order_acquire), nullptr);
@@ -367,6 +367,44 @@ void AudioEngine::finalizeMmcssShutdown() noexcept
     }
 }
 
+//--------------------------------------------------------------
+// 評価ワーカーの Audio クラスタ退避 (Message Thread / timerCallback から毎 tick)
+//   Audio callback 負荷と評価ワーカーの CPU 時間を AffinityRebalancer に渡し、
+//   判定が変わったときだけ ThreadAffinityManager の退避状態を切り替えて診断ログに残す。
+//--------------------------------------------------------------
+void AudioEngine::updateAffinityRebalance()
+{
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const uint64_t cpuTime = affinityManager.getLearnerEvalCpuTime();
+    const double elapsedMs = nowMs - affinityRebalanceLastTickMs_;
+    const uint64_t cpuDelta = cpuTime - affinityRebalanceLastCpuTime_;
+    const bool firstTick = affinityRebalanceLastTickMs_ <= 0.0;
+    affinityRebalanceLastTickMs_ = nowMs;
+    affinityRebalanceLastCpuTime_ = cpuTime;
+
+    if (firstTick || elapsedMs <= 0.0 || !affinityManager.canRestrictLearnerEval())
+        return;
+
+    // CPU 時間は 100 ns 単位 → 経過時間 (ms) 比の permille (1 コア占有 = 1000)
+    const double cpuMs = static_cast<double>(cpuDelta) * 1.0e-4;
+    const auto evalCpuPermille = static_cast<uint32_t>(std::min(cpuMs / elapsedMs * 1000.0, 64000.0));
+    const uint16_t loadPermille = getCallbackLoadPermille();
+
+    const auto decision = affinityRebalancer_.update(loadPermille, evalCpuPermille);
+    if (decision == convo::AffinityRebalanceDecision::Hold)
+        return;
+
+    const bool restrict = (decision == convo::AffinityRebalanceDecision::Restrict);
+    affinityManager.setLearnerEvalRestricted(restrict);
+    affinityRebalanceLastLoad_ = loadPermille;
+    affinityRebalanceLastEvalCpu_ = evalCpuPermille;
+    diagLog(juce::String("[AFFINITY] learner eval ") + (restrict ? "moved off" : "returned to")
+        + " the audio L2 cluster: load=" + juce::String(static_cast<int>(loadPermille)) + "permille"
+        + " evalCpu=" + juce::String(static_cast<juce::int64>(evalCpuPermille)) + "permille"
+        + " restricts=" + juce::String(static_cast<juce::int64>(affinityRebalancer_.getRestrictCount()))
+        + " releases=" + juce::String(static_cast<juce::int64>(affinityRebalancer_.getReleaseCount())));
+}
+
 void AudioEngine::timerCallback()
 {
     const convo::RuntimeReaderContext messageCtx{ messageThreadRcuReader, convo::ObserveChannel::Message };
@@ -417,6 +455,11 @@ void AudioEngine::timerCallback()
     const auto* currentSnapshot = getRuntimeSnapshotFromReadHandle(runtimeReadHandle);
 
     emitEvidenceTickNonRt(false);
+    serviceEQFoldIntoIR();
+    updateAffinityRebalance();
+    // 合流バスの取りこぼし防止 (通常は handleAsyncUpdate で消化済み)
+    if (!isShutdownInProgress())
+        drainParameterIntents();
 
     {
         const int active = transitionActive ? 1 : 0;
@@ -688,138 +731,11 @@ void AudioEngine::timerCallback()
         }
     }
 
-    if (!isShutdownInProgress()
-        && hasRebuildReason(RebuildReason::DeferredStructural))
-    {
-        const uint64_t intentId = nextRebuildTelemetryIntentId();
-        const int64_t dueTicks = convo::consumeAtomic(deferredStructuralRebuildDueTicks_, std::memory_order_acquire);
-        const int64_t nowTicks = juce::Time::getHighResolutionTicks();
-
-        if (dueTicks > 0 && nowTicks >= dueTicks)
-        {
-            clearRebuildReason(RebuildReason::DeferredStructural);
-            convo::publishAtomic(deferredStructuralRebuildDueTicks_, 0, std::memory_order_release);
-
-            if (uiConvolverProcessor.isIRLoaded())
-            {
-                diagLog("[DIAG] timerCallback: issuing deferred Structural rebuild after prepared IR apply");
-                emitRebuildTelemetry(RebuildTelemetryEvent::Deferred,
-                                     intentId,
-                                     RebuildTelemetryReason::DeferredStructuralDue,
-                                     RebuildTelemetryDecision::Released,
-                                     0,
-                                     0,
-                                     RebuildTelemetryClass::Structural,
-                                     RebuildTelemetryPolicy::NA,
-                                     "deferred_structural");
-                submitRebuildIntent(convo::RebuildKind::Structural,
-                                    RebuildTelemetryReason::DeferredStructuralRebuildRequested,
-                                    RebuildTelemetryClass::Structural,
-                                    RebuildTelemetryPolicy::Replaceable);
-
-                ++pendingIRGeneration;
-                setIRChangeFlag();
-
-                const LearningCommand cmd {
-                    LearningCommand::Type::IRChanged,
-                    false,
-                    convo::consumeAtomic(pendingLearningMode, std::memory_order_acquire),
-                    pendingIRGeneration
-                };
-
-                if (!enqueueLearningCommand(cmd))
-                {
-                    DBG("[AudioEngine] timerCallback: deferred command queue overflow");
-                }
-            }
-        }
-    }
-
+    // ★ 遅延 rebuild (DeferredStructural / DeferredFinalizeAware) は期限駆動ワーカー経由で
+    //   handleAsyncUpdate → serviceDeferredRebuilds() が処理する (タイマーでポーリングしない)
     if (isShutdownInProgress())
         emitEvidenceTickNonRt(true);
 
-    if (!isShutdownInProgress()
-        && hasRebuildReason(RebuildReason::DeferredFinalizeAware))
-    {
-        const uint64_t intentId = nextRebuildTelemetryIntentId();
-        static constexpr int kFinalizeDeferMaxDurationMs = 2000;
-        const int64_t nowTicks = juce::Time::getHighResolutionTicks();
-        const int64_t ticksPerSecond = juce::Time::getHighResolutionTicksPerSecond();
-        const int64_t maxDeferTicks = (ticksPerSecond * kFinalizeDeferMaxDurationMs) / 1000;
-
-        int64_t firstSeenTicks = convo::consumeAtomic(deferredFinalizeFirstSeenTicks_, std::memory_order_acquire);
-        if (firstSeenTicks <= 0)
-        {
-            convo::publishAtomic(deferredFinalizeFirstSeenTicks_, nowTicks, std::memory_order_release);
-            firstSeenTicks = nowTicks;
-        }
-
-        const int64_t elapsedTicks = (nowTicks >= firstSeenTicks) ? (nowTicks - firstSeenTicks) : 0;
-        const bool timedOut = (maxDeferTicks > 0) && (elapsedTicks >= maxDeferTicks);
-        const double elapsedMs = (ticksPerSecond > 0)
-            ? (static_cast<double>(elapsedTicks) * 1000.0 / static_cast<double>(ticksPerSecond))
-            : 0.0;
-
-        const int queuedGeneration = convo::consumeAtomic(rebuildRequestGeneration, std::memory_order_acquire);
-        const int committedGeneration = convo::consumeAtomic(lastCommittedRebuildGeneration, std::memory_order_acquire);
-        const bool outstandingRebuild = queuedGeneration > committedGeneration;
-        const bool irLoaded = uiConvolverProcessor.isIRLoaded();
-        const bool irFinalized = uiConvolverProcessor.isIRFinalized();
-        const bool irLoading = uiConvolverProcessor.isLoadingIR();
-                const bool structuralDeferred = hasRebuildReason(RebuildReason::DeferredStructural);
-        const bool pendingIrChange = convo::consumeAtomic(m_pendingIRChange, std::memory_order_acquire);
-
-        // IR 遷移が完全に落ち着いてから 1 回だけ再構築を発火する。
-        const bool finalizeReady = (!irLoaded || irFinalized)
-            && !irLoading
-            && !structuralDeferred
-            && !pendingIrChange
-            && !outstandingRebuild;
-
-        if (finalizeReady || timedOut)
-        {
-            clearRebuildReason(RebuildReason::DeferredFinalizeAware);
-            convo::publishAtomic(deferredFinalizeFirstSeenTicks_, 0, std::memory_order_release);
-
-            const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
-            if (!m_isRestoringState && sr > 0.0)
-            {
-                if (timedOut && !finalizeReady)
-                {
-                    diagLog("[DIAG] timerCallback: finalize defer timeout reached, forcing rebuild dispatch");
-                    emitRebuildTelemetry(RebuildTelemetryEvent::ForcedDispatch,
-                                         intentId,
-                                         RebuildTelemetryReason::DeferredFinalizeRebuildRequested,
-                                         RebuildTelemetryDecision::Dispatched,
-                                         0,
-                                         0,
-                                         RebuildTelemetryClass::FinalizeAware,
-                                         RebuildTelemetryPolicy::MustExecute,
-                                         "deferred_finalize_timeout",
-                                         elapsedMs);
-                }
-                else
-                {
-                    diagLog("[DIAG] timerCallback: issuing deferred finalize-aware rebuild");
-                    emitRebuildTelemetry(RebuildTelemetryEvent::Deferred,
-                                         intentId,
-                                         RebuildTelemetryReason::DeferredFinalizeReady,
-                                         RebuildTelemetryDecision::Released,
-                                         0,
-                                         0,
-                                         RebuildTelemetryClass::FinalizeAware,
-                                         RebuildTelemetryPolicy::NA,
-                                         "deferred_finalize_aware");
-                }
-
-                submitRebuildIntent(convo::RebuildKind::Structural,
-                                    RebuildTelemetryReason::DeferredFinalizeRebuildRequested,
-                                    RebuildTelemetryClass::FinalizeAware,
-                                    RebuildTelemetryPolicy::MustExecute);
-            }
-        }
-    }
-
     processLearningCommands();
     processDeferredLearningActions();
 
@@ -880,6 +796,7 @@ void AudioEngine::timerCallback()
         auto* const doneRaw1 = exchangeFadingRuntimeDSP(nullptr);
         if (auto* done = (reinterpret_cast<uintptr_t>(doneRaw1) == (~static_cast<uintptr_t>(0))) ? nullptr : doneRaw1)
         {
+            convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*m_retireRouter, convo::isr::RetireProducer::Crossfade);
             DSPLifetimeManager lifetimeMgr(*this);
             lifetimeMgr.retire(done);
         }
@@ -1002,6 +919,7 @@ void AudioEngine::timerCallback()
         auto* const doneRaw2 = exchangeFadingRuntimeDSP(nullptr);
         if (auto* done = (reinterpret_cast<uintptr_t>(doneRaw2) == (~static_cast<uintptr_t>(0))) ? nullptr : doneRaw2)
         {
+            convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*m_retireRouter, convo::isr::RetireProducer::Crossfade);
             DSPLifetimeManager lifetimeMgr(*this);
             lifetimeMgr.retire(done);
         }
@@ -1022,11 +940,10 @@ void AudioEngine::timerCallback()
         dsp->eqState->cleanupForRuntime();
         dsp->convolverState->cleanupForRuntime();
 
-        // M2: PsychoacousticDither の RNG リングは Audio Thread 外で補充する。
+        // M2: ノイズシェーパー共用のディザプールは Audio Thread 外で補充する。
         // timerCallback は Message Thread で実行されるため、RT 制約に抵触しない。
-        const bool activePsychoacoustic = (dsp->noiseShaperType == NoiseShaperType::Psychoacoustic);
-        if (activePsychoacoustic && dsp->ditherBitDepth > 0)
-            dsp->dither.refillRandomRingNonRt();
+        if (dsp->ditherBitDepth > 0)
+            dsp->ditherNoise.refillNonRt();
 
         const bool activeFixed4Tap = (dsp->noiseShaperType == NoiseShaperType::Fixed4Tap);
         const bool activeFixed15Tap = (dsp->noiseShaperType == NoiseShaperType::Fixed15Tap);
@@ -1101,6 +1018,10 @@ void AudioEngine::timerCallback()
         m_healthMonitor.tick();
     }
 
+    // ★ フライトレコーダーの生存印: 時刻が止まれば Message Thread、コールバック番号だけ止まれば Audio 側
+    if (flightRecorder_ != nullptr)
+        flightRecorder_->heartbeat(convo::getCurrentTimeUs(), currentCallbackSeq(rtLocalState_));
+
     // ★ Phase1: OverflowRing 定期 drain — Coordinator 経由で一元管理
     //   50ms周期のtimerCallbackごとにdrainOverflowRingを呼出
     //   Coordinator が retry/age/deferred を管理
@@ -1262,7 +1183,14 @@ void AudioEngine::timerCallback()
                     + " callbackMax=" + juce::String(static_cast<double>(cbMaxUs) / 1000.0, 3) + "ms"
                     + " (expected=" + juce::String(static_cast<juce::int64>(expectedCbCount))
                     + " actual=" + juce::String(static_cast<juce::int64>(cbCount))
-                    + " loss=" + juce::String(static_cast<juce::int64>(lossCount)) + ")");
+                    + " loss=" + juce::String(static_cast<juce::int64>(lossCount)) + ")"
+                    + " load=" + juce::String(static_cast<int>(getCallbackLoadPermille())) + "permille"
+                    + " xfadeShortened=" + juce::String(static_cast<juce::int64>(
+                        crossfadeRuntime_.loadModeCount(convo::CrossfadeLoadMode::Shortened)))
+                    + " xfadeFadeInOnly=" + juce::String(static_cast<juce::int64>(
+                        crossfadeRuntime_.loadModeCount(convo::CrossfadeLoadMode::FadeInOnly)))
+                    + " xfadeConvStage=" + juce::String(static_cast<juce::int64>(
+                        crossfadeRuntime_.convolverStageScopedCount())));
             }
         }
     }
@@ -1432,6 +1360,10 @@ void AudioEngine::timerCallback()
             rtAuxMutable_.diagTickPopped.value.fetch_add(1, std::memory_order_relaxed);
             rtAuxMutable_.diagTotalPopped.fetch_add(1, std::memory_order_relaxed);
             diagLog(formatDiagEvent(event, gen));
+            // 時刻は drain 時点 (イベント自身の時刻は中身の各フィールドにある)
+            if (flightRecorder_ != nullptr)
+                flightRecorder_->writePod(convo::FlightChannel::Diag, convo::FlightRecordKind::DiagEvent,
+                                          event, drainStartUs);
         }
         const uint64_t drainUs = convo::getCurrentTimeUs() - drainStartUs;
 
@@ -1480,6 +1412,33 @@ void AudioEngine::timerCallback()
 #endif // CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
 }
 
+[[nodiscard]] bool AudioEngine::isRuntimeSettled() const
+{
+    // acquire: prepareToPlay の release と HB し、World と比べるレートを取得
+    const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire);
+    if (sr <= 0.0)
+        return false;
+
+    // timerCallback の finalize 判定と同じ条件 (IR 遷移と未コミットのリビルドが無いこと)
+    const int queuedGeneration = convo::consumeAtomic(rebuildRequestGeneration, std::memory_order_acquire);
+    const int committedGeneration = convo::consumeAtomic(lastCommittedRebuildGeneration, std::memory_order_acquire);
+    if (queuedGeneration > committedGeneration
+        || uiConvolverProcessor.isLoadingIR()
+        || (uiConvolverProcessor.isIRLoaded() && !uiConvolverProcessor.isIRFinalized())
+        || convo::consumeAtomic(m_pendingIRChange, std::memory_order_acquire)
+        || hasRebuildReason(RebuildReason::DeferredStructural)
+        || hasRebuildReason(RebuildReason::DeferredFinalizeAware))
+        return false;
+
+    const auto readToken = RuntimePublicationCoordinator::acquireReadToken(runtimeStore);
+    const auto* world = RuntimePublicationCoordinator::consumeWorldHandle(runtimeStore, readToken);
+    return world != nullptr
+        && world->engine.current != nullptr
+        && world->topology.fadingRuntimeUuid == 0
+        && !world->engine.dspCrossfadePending
+        && absNoLibm(world->timing.sampleRateHz - sr) < 1.0e-6;
+}
+
 // ★ P1-8: HealthMonitor コールバック実装
 void AudioEngine::onHealthEvent(const convo::HealthEvent& event) noexcept
 {
@@ -1552,6 +1511,7 @@ void AudioEngine::onHealthEvent(const convo::HealthEvent& event) noexcept
         if (doneRaw != nullptr
             && reinterpret_cast<uintptr_t>(doneRaw) != (~static_cast<uintptr_t>(0)))
         {
+            convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*m_retireRouter, convo::isr::RetireProducer::Crossfade);
             DSPLifetimeManager lifetime(*this);
             lifetime.retire(doneRaw);
         }
@@ -16,6 +16,7 @@ void AudioEngine::changeListenerCallback(juce::ChangeBroadcaster* source)
         // UI (SpectrumAnalyzerComponent など) が EQ 編集を即時反映できるよう通知する。
         // 実 DSP 反映は submitRebuildIntent() 経由で行う。
         sendChangeMessage();
+        cancelEQFoldIntoIR(); // ★ EQ fold: 編集はライブ EQ 段で即時反映し、静止後に再 fold する
         submitRebuildIntent(convo::RebuildKind::Structural,
                             RebuildTelemetryReason::UiEqEditorChangeListener,
                             RebuildTelemetryClass::Structural,
@@ -139,6 +140,7 @@ void AudioEngine::convolverParamsChanged(ConvolverProcessor* processor)
             {
                 setRebuildReason(RebuildReason::DeferredStructural);
                 convo::publishAtomic(deferredStructuralRebuildDueTicks_, appliedTicks + minDeltaTicks, std::memory_order_release);
+                scheduleDeferredRebuildService(appliedTicks + minDeltaTicks);
                 clearRebuildReason(RebuildReason::StructuralFromNonMT);
                 needsStructuralRebuild = false;
 
@@ -158,8 +160,8 @@ void AudioEngine::convolverParamsChanged(ConvolverProcessor* processor)
         if (needsStructuralRebuild)
         {
             // H5: listener callback から直接 rebuild を発火せず、
-            // snapshot command 経由で worker に反映を委譲する。
-            submitRebuildIntent(convo::RebuildKind::Structural, RebuildTelemetryReason::EnqueueSnapshotCommand, RebuildTelemetryClass::Snapshot, RebuildTelemetryPolicy::Replaceable);
+            // 合流バス経由で drain 時にまとめて反映する。
+            postParameterIntentEvent(ParameterIntentSlot::ConvolverParams);
             emitRebuildTelemetry(RebuildTelemetryEvent::Dispatched,
                                  intentId,
                                  RebuildTelemetryReason::SnapshotEnqueued,
@@ -20,16 +20,7 @@ static constexpr int kNumAdaptiveCoeffBanks =
     * kAdaptiveBitDepthCount
     * kLearningModeCount;
 
-// ストリーミング信号キャプチャ用 AudioBlock（2ch, 256サンプル）
-struct AudioBlock {
-    double L[256];
-    double R[256];
-    int numSamples = 0;
-    int sampleRateHz = 0;
-    int bitDepth = 0;
-    int adaptiveCoeffBankIndex = 0;
-    std::uint64_t sessionId = 0;
-};
+#include "AdaptiveCaptureBlock.h"
 
 // RT/Worker間ダブルバッファ係数連携（RCU）
 struct CoeffSet {
@@ -42,6 +33,7 @@ struct CoeffSet {
 #include <cstdint>
 #include <cstring>
 #include <array>
+#include <bit>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -57,10 +49,14 @@ struct CoeffSet {
 
 #include "AlignedAllocation.h"
 #include "CustomInputOversampler.h"
+#include "dsp/KernelDispatch.h"
 #include "ConvolverProcessor.h"
 #include "EQProcessor.h"
+#include "EQResponseCache.h"
 #include "core/RCUReader.h"
 #include "core/RuntimeReaderContext.h"
+#include "core/CallbackReaderScope.h"
+#include "core/SeqlockSnapshot.h"
 #include "EQEditProcessor.h"
 #include "PsychoacousticDither.h"
 #include "FixedNoiseShaper.h"
@@ -81,13 +77,28 @@ struct CoeffSet {
 #include "core/SnapshotCoordinator.h"
 #include "core/EpochDomain.h"
 #include "core/RuntimePublicationCoordinator.h"
-#include "core/CommandBuffer.h"
+#include "core/CoalescingCommandBus.h"
 #include "core/ThreadAffinityManager.h"
+#include "core/AffinityRebalancer.h"
 #include "core/WorkerThread.h"
+#include "core/BackgroundScheduler.h"
 #include "core/RebuildTypes.h"
-#include "TruePeakDetector.h"
-#include "LoudnessMeter.h"
-#include "SimplePeakLimiter.h" // ★ [P1-1] Simple Peak Limiter
+#include "LookAheadPeakLimiter.h" // ★ [P1-1] Peak Limiter (Look-ahead)
+#include "FusedOutputStage.h"
+#include "BlockHealthScan.h"
+#include "DeviceOutputCodec.h"
+#include "ChainSilenceTracker.h"
+#include "AdaptiveSoftClipRoute.h"
+#include "PipelinedStage.h"
+#include "ChannelForkJoin.h"
+#include "ABResidentBank.h"
+#include "FixedBlockReblocker.h"
+#include "FixedRateBridge.h"
+#include "StageLatencyHistogram.h"
+#include "CallbackTimingProfile.h"
+#include "RtSafetyGuard.h"
+#include "MemoryLedger.h"
+#include "CpuCostModel.h"
 #include "ISRLifecycle.h"
 #include "ISRRTExecution.h"
 #include "ISRDSPHandle.h"
@@ -110,10 +121,13 @@ namespace convo::isr { class ISRRetireRouter; }
 // ISRRetireRouter forward-declared below (reduce include chain for C1060)
 #include "ISREvidenceExporter.h"
 #include "RuntimeHealthMonitor.h"
+#include "FlightRecorder.h"
 #include "RuntimePublicationValidator.h"
 #include "WorldLifecycleAudit.h"
 
 class NoiseShaperLearner;
+class EQPresetPrebuildThread;
+class MeteringWorker;
 class AudioEngine;
 namespace convo { class RuntimeBuilder; }
 
@@ -298,6 +312,12 @@ struct RuntimeState : convo::isr::SealedObject<RuntimeState>
             && convo::isr::validateReadAuthorityInventoryAgainstDescriptors(kRuntimeReadAuthorityInventory, kFieldDescriptors)
             && convo::isr::PublicationSemantic::validateDescriptorSet();
     }
+
+    // ★ 増分検証: フィールド名 → metadata.dirtyFieldMask のビット (kFieldDescriptors の添字)
+    [[nodiscard]] static constexpr convo::isr::RuntimeFieldMask fieldBit(std::string_view fieldName) noexcept
+    {
+        return convo::isr::runtimeFieldBit(kFieldDescriptors, fieldName);
+    }
 };
 
 // ★ Phase4 (ALTERNATIVE DESIGN — Builder/Runtime 二段階モデル):
@@ -561,7 +581,8 @@ namespace convo::isr {
 //     - リアルタイム制約があります（ブロック不可、ロック不可、メモリ割り当て不可、IR再ロード不可）。
 //   - prepareToPlay / releaseResources: Audio Thread の開始前/終了後に Message Thread から呼ばれます。
 //   - パラメータ設定: Message Thread から呼ばれます。std::atomic を使用して Audio Thread と安全に同期します (RCUパターン)。
-//   - readFromFifo: Message Thread (Timer) から呼ばれます。FIFOバッファからデータを取得します。
+//   - readFromFifo / skipFifo: SpectrumAnalyzerWorker のスレッドだけが呼びます (analyzerFifo の単一リーダ)。
+//   - peekMeteringTap / commitMeteringTap / skipMeteringTap: MeteringWorker のスレッドだけが呼びます (meteringFifo の単一リーダ)。
 //============================================================================
 
 
@@ -730,6 +751,8 @@ public:
             int fadeInSamplesLeft = 0;
             convo::LinearRamp bypassFadeGainDouble;
             bool bypassedDouble = false;
+            // ★ 透過状態 (EQ / Convolver 完全バイパスでフェード完了): processDouble は出力段だけ回す
+            bool transparentDouble = false;
             // ★ B01: Float 版 bypass blend 用メンバ (Double 版と同一構造)
             convo::LinearRamp bypassFadeGainFloat;
             bool bypassedFloat = false;
@@ -739,6 +762,7 @@ public:
                 bypassFadeGainDouble.reset(sampleRate, 0.005);
                 bypassFadeGainDouble.setCurrentAndTargetValue(1.0);
                 bypassedDouble = false;
+                transparentDouble = false;
                 // ★ B01: Float 版も同じフェード時間で初期化
                 bypassFadeGainFloat.reset(sampleRate, 0.005);
                 bypassFadeGainFloat.setCurrentAndTargetValue(1.0);
@@ -750,6 +774,7 @@ public:
             {
                 bypassFadeGainDouble.setCurrentAndTargetValue(1.0);
                 bypassedDouble = false;
+                transparentDouble = false;
                 // ★ B01: Float 版もリセット
                 bypassFadeGainFloat.setCurrentAndTargetValue(1.0);
                 bypassedFloat = false;
@@ -798,6 +823,13 @@ public:
                 }
             }
 
+            // 出力段の融合カーネル (FusedOutputStage.h) に渡す遅延線。処理後に writePos を書き戻すこと
+            convo::output::FusedOutputDelay fixedLatencyDelay() noexcept
+            {
+                return { fixedLatencyBufferL.get(), fixedLatencyBufferR.get(),
+                         fixedLatencyBufferSize, fixedLatencySamples, fixedLatencyWritePos };
+            }
+
             void resetForRuntime() noexcept
             {
                 fixedLatencyWritePos = 0;
@@ -831,10 +863,23 @@ public:
             int adaptiveCaptureSampleRateHz;
             int adaptiveCaptureBitDepth;
             uint64_t captureSessionId;
-            LockFreeRingBuffer<AudioBlock, 4096>* adaptiveCaptureQueue;
+            AdaptiveCaptureQueue* adaptiveCaptureQueue;
+            int adaptiveCaptureStride;  // 1 = 全ブロック, N = (N × バースト) ごとに 1 バースト
             const convo::EQParameters* eqParams;
             const EQCoeffCache* eqCache;
             uint64_t eqCoeffHash;
+            bool eqFoldedIntoIR;       // ★ EQ fold: EQ 応答は IR 焼き込み済み → EQ 段をスキップ
+            bool eqAtBaseRate;         // ★ Split-rate EQ: EQ を processUp 前 (ベースレート) で処理する
+            double deviceCodeGain;     // ★ 整数 ASIO デバイスでディザの LSB をドライバ変換後も保つゲイン (1.0 = 補正なし)
+            // ★ Convolver 段スコープ遷移: 非 null のブロックは Convolver 段で peer (旧 DSPCore) の Convolver を
+            //   同じ入力で並走させ、ゲイン stageFadeGainStart → stageFadeGainEnd で新旧をミックスする
+            DSPCore* stageFadePeer = nullptr;
+            double stageFadeGainStart = 1.0;
+            double stageFadeGainEnd = 1.0;
+            // ★ 段別処理時間ヒストグラム (常時計測)。単一ライタなので Audio Thread の公開中 DSPCore だけが書く
+            convo::StageLatencyHistograms* stageLatency = nullptr;
+            // ★ 出力メータのタップ (MeteringWorker が LUFS / TruePeak を計算する)。出力に出る DSPCore だけが書く
+            LockFreeAudioRingBuffer* meteringTap = nullptr;
         };
 
         DSPCore();
@@ -848,13 +893,21 @@ public:
         (void)oldLive;
         jassert(oldLive > 0);
 #endif
+        // ワーカー / helper が convolver を触らなくなってから後始末する
+        convolverPipeline.stop();
+        channelSplit.stop();
         // Explicitly clean up convolver resources to ensure no WDL memory is leaked,
         // especially for instances that are destroyed from the trash bin.
         convolver.forceCleanup();
     }
 
-    void prepare(double sampleRate, int samplesPerBlock, int bitDepth, int manualOversamplingFactor, OversamplingType oversamplingType, NoiseShaperType selectedNoiseShaperType, AudioEngine* owner);
+    void prepare(double sampleRate, int samplesPerBlock, int bitDepth, int manualOversamplingFactor, OversamplingType oversamplingType, bool oversamplingSinglePrecision, NoiseShaperType selectedNoiseShaperType, AudioEngine* owner);
     void setFixedLatencySamples(int samples);
+    void configureSilenceTracker();
+    // パイプライン化 Convolver の起動 / 停止 (rebuild thread。prepare() 後に呼ぶ)
+    void configureConvolverPipeline(bool enabled, AudioEngine* owner);
+    // Channel split helper の起動 / 停止 (rebuild thread。prepare() 後に呼ぶ)
+    void configureChannelSplit(bool enabled, AudioEngine* owner);
     void reset();
         void process(const juce::AudioSourceChannelInfo& bufferToFill, LockFreeAudioRingBuffer& analyzerFifo,
              std::atomic<float>* inputLevelLinear,
@@ -945,6 +998,8 @@ public:
             return *historyState;
         }
 
+        // ★ 全ノイズシェーパー共用の TPDF ディザプール (prepare で満杯にし、timerCallback で補充)
+        ::convo::dsp::DitherNoisePool ditherNoise;
         ::convo::PsychoacousticDither dither;
         ::convo::FixedNoiseShaper fixedNoiseShaper;
         ::convo::Fixed15TapNoiseShaper fixed15TapNoiseShaper;
@@ -953,11 +1008,25 @@ public:
         convo::OutputFilter outputFilter;
 
         CustomInputOversampler oversampling;
-        CustomInputOversampler softClipOS; // 局所2倍OS（SoftClip用、prepareSingleStageで構築）
+        CustomInputOversampler softClipOS; // 局所2倍OS（SoftClip用、prepareSingleStage / MinimumPhase 時は全域通過1段で構築）
+        convo::dsp::SoftClipKernel softClipKernel = nullptr; // prepare() で KernelDispatch から解決
+        // ★ Adaptive SoftClip OS: 線形域のブロックは softClipOS を止めて遅延線で通す (adaptiveSoftClipOS のときだけ使う)
+        convo::AdaptiveSoftClipRoute softClipRoute;
+        convo::dsp::PeakAbsKernel peakAbsKernel = nullptr; // prepare() で KernelDispatch から解決
+        // ★ 段ごとの無音スキップ (processDouble のみ。ring-out は prepare() で各段から設定)
+        convo::ChainSilenceTracker silenceTracker;
+        // ★ パイプライン化 Convolver (opt-in。processDouble / float 経路共通): Convolver 段を専用 RT ワーカーで
+        //   1 ブロック遅れて処理する。rebuild thread が configureConvolverPipeline() で起動し、~DSPCore で停止
+        convo::PipelinedStage convolverPipeline;
+        // ★ Channel split (opt-in): オーバーサンプラ / Convolver の R チャンネルを audioRealtime コア上の helper で
+        //   L と並行に回し、リンク段の前で join する。rebuild thread が configureChannelSplit() で起動し、~DSPCore で停止
+        convo::ChannelForkJoin channelSplit;
+        AudioEngine* helperThreadOwner = nullptr; // ワーカー / helper の MMCSS 登録用 (非所有)
+        int preparedHostBlockSize = 0;                 // prepare() に渡されたデバイスのブロック長 (PrepareBlockSizingPolicy 適用前)
         size_t oversamplingFactor = 1;
         OversamplingType activeOversamplingType = OversamplingType::IIR;
-        // ★ [P1-1] Simple Peak Limiter (Release-only, LookAhead なし)
-        ::SimplePeakLimiter peakLimiter;
+        // ★ [P1-1] Peak Limiter (Look-ahead 1ms、16 サンプル周期の制御点。遅延は LatencyBreakdown に計上)
+        ::LookAheadPeakLimiter peakLimiter;
 
         int ditherBitDepth = 0; // DSPCore内でディザリング判定に使用
         NoiseShaperType noiseShaperType = NoiseShaperType::Psychoacoustic;
@@ -966,17 +1035,22 @@ public:
         // ISR-safe switch counter (atom, RT-path). Read by Message Thread for diagnostics.
         std::atomic<uint64_t> adaptiveBankSwitchCount { 0 };
         uint64_t currentCaptureSessionId = 0;
+        // Adaptive capture の間引き状態 (Audio Thread 専用)
+        int captureCyclePosition = 0;    // バースト周期内の位置 (ブロック単位)
+        int captureCarriedSamples = 0;   // 書き込まずに次のブロックへ持ち越す再生サンプル数
+        // ★ EQ fold: convolver の IR に静的 EQ が焼き込まれている (rebuild 時に確定し、publish 後は不変)
+        bool eqFoldedIntoIR = false;
+        // ★ Split-rate EQ: ベースレートでの EQ 処理を許可 (rebuild 時に確定し、publish 後は不変)
+        bool eqSplitRate = false;
+        // ★ Adaptive SoftClip OS: OS = 1 の局所 OS を線形域で止める (rebuild 時に確定し、publish 後は不変)
+        bool adaptiveSoftClipOS = false;
         std::uint64_t runtimeUuid = 0;
         double sampleRate = 0.0;
 
-        // TruePeak検出器（BS.1770-4/5準拠）
-        ::TruePeakDetector truePeakDetector;
-        // LUFSラウドネスメーター（BS.1770-4/5 + EBU R128）
-        ::LoudnessMeter loudnessMeter;
-
     // 【パッチ3】MKL用rawアライメントバッファ（vector完全排除・ガイドライン厳守）
-        convo::ScopedAlignedPtr<double> alignedL;
-        convo::ScopedAlignedPtr<double> alignedR;
+        // ★ 毎ブロック触るため RT 常駐で確保する (dryBypass / stageFadeScratch も同様)
+        convo::ResidentArray<double> alignedL;
+        convo::ResidentArray<double> alignedR;
         int alignedCapacity = 0;                  // 現在確保済み容量（再確保判定用）
 
         int maxSamplesPerBlock = 0;               // ホスト指定の入力ブロック上限（DSPCore::prepare() で設定）
@@ -986,26 +1060,46 @@ public:
 
         // ─────────────────────────────────────────────────────────────
         // 【Issue 3 修正】内部処理用最大バッファサイズ
-        // 理由: Oversampling有効時（最大8x）、processSamplesUp() 後の
-        //      ブロックサイズが PrepareBlockSizingPolicy::apply() の値 × 8
-        //      まで拡大しうるため。固定で ×8 確保することで RCU 再構築時の
-        //      resize を回避する。
+        // 理由: Oversampling有効時、processSamplesUp() 後のブロックサイズが
+        //      PrepareBlockSizingPolicy::apply() の値 × oversamplingFactor まで拡大する。
+        //      ★ OversamplingPolicy::resolve() が決めたこの DSPCore の係数ぶんだけ確保する
+        //        (以前は常に × 8。1x/2x では大半が触られないままキャッシュを汚していた)。
+        //        係数が上がる変更は構造変更として rebuild されるため、拡張は rebuild スレッドの
+        //        prepare() で行われ (バッファは拡張のみ)、完成した DSPCore が publish される。
         //      ★ v8.3: SAFE_MAX_BLOCK_SIZE(65536) floor は廃止。
         //        prepare() 時は kMinimumPrepareBlock(256) または actual
         //        samplesPerBlock が使用される。
         // ─────────────────────────────────────────────────────────────
-        int maxInternalBlockSize = 0;             // OS考慮後の最大サイズ（prepare samplesPerBlock × 8）
+        int maxInternalBlockSize = 0;             // OS考慮後の最大サイズ（prepare samplesPerBlock × oversamplingFactor）
         static constexpr int FADE_IN_SAMPLES = 2048; // 42ms @ 48kHz
         // B2: processDouble 用のバイパスフェード状態
-        convo::ScopedAlignedPtr<double> dryBypassBufferDoubleL;
-        convo::ScopedAlignedPtr<double> dryBypassBufferDoubleR;
+        convo::ResidentArray<double> dryBypassBufferDoubleL;
+        convo::ResidentArray<double> dryBypassBufferDoubleR;
         int dryBypassCapacityDouble = 0;
+        // Convolver 段スコープ遷移で peer の Convolver へ渡す共有入力のコピー (maxInternalBlockSize)
+        convo::ResidentArray<double> stageFadeScratchL;
+        convo::ResidentArray<double> stageFadeScratchR;
+        int stageFadeScratchCapacity = 0;
+        // ★ A/B 常駐: 直近に publish へ投入した構築ペイロード (enqueuePublicationIntentForRuntimeCommit が記録)。
+        //   A/B 切替で park 中の DSPCore を rebuild せずに再公開するときに使う
+        struct PublishedBuildRecord
+        {
+            convo::RuntimeBuildSnapshot snapshot {};
+            convo::BuildAnalysis buildAnalysis {};
+            convo::OversamplingResult oversamplingResult {};
+            convo::BuildDiagnostics buildDiagnostics {};
+        };
+        PublishedBuildRecord publishedBuild {};
 
         // Helpers
-        float measureLevel (const juce::dsp::AudioBlock<const double>& block) const noexcept;
-        void applyFixedLatencyDelay(double* dataL, double* dataR, int numSamples) noexcept;
         void pushToFifo(const juce::dsp::AudioBlock<const double>& block,
                         LockFreeAudioRingBuffer& analyzerFifo) const noexcept;
+        // 出力段の信号を学習器のキャプチャキューへ 256 サンプル単位で float 化して積む。
+        // state.adaptiveCaptureStride に従ってバースト単位で間引く
+        void pushAdaptiveCapture(const ProcessingState& state,
+                                 const double* left,
+                                 const double* right,
+                                 int numSamples) noexcept;
         // analyzerInputTap=true の場合、ヘッドルームゲイン適用前の raw 入力を
         // analyzerFifo にプッシュする。
         // これにより、インプットスペアナ/レベルメーターがヘッドルーム非適用の
@@ -1014,16 +1108,46 @@ public:
                            double headroomGain,
                            bool analyzerInputTap,
                        LockFreeAudioRingBuffer& analyzerFifo) noexcept;
-        void processOutput(const juce::AudioSourceChannelInfo& bufferToFill,
-                           int numSamples,
-                           const ProcessingState& state) noexcept;
+        // 戻り値は出力メータ値 (ヘッドルーム前の出力ピーク)。BlockHealthScan の検査と同じパスで求める
+        float processOutput(const juce::AudioSourceChannelInfo& bufferToFill,
+                            int numSamples,
+                            const ProcessingState& state) noexcept;
         float processInputDouble(const juce::AudioBuffer<double>& buffer, int numSamples,
                                  double headroomGain,
                                  bool analyzerInputTap,
                            LockFreeAudioRingBuffer& analyzerFifo) noexcept;
-        void processOutputDouble(juce::AudioBuffer<double>& buffer,
-                                 int numSamples,
+        float processOutputDouble(juce::AudioBuffer<double>& buffer,
+                                  int numSamples,
+                                  const ProcessingState& state) noexcept;
+        // 出力段の健全性検査で不正サンプルが見つかったブロックの後始末。検査より上流で状態を持つ段
+        // (OS の decimate 履歴・DC ブロッカ・ディザ / ノイズシェーパーの誤差帰還) をそれぞれの既存の復旧経路で戻す
+        void recoverFromCorruptedOutput() noexcept;
+        // processDouble の末尾 (Output アナライザ・出力メータ・processOutputDouble・起動フェードイン)。
+        // 通常経路と透過状態 (ハードバイパス) で共有する
+        void finishProcessDouble(juce::AudioBuffer<double>& buffer,
+                                 const juce::dsp::AudioBlock<double>& outputBlock,
+                                 LockFreeAudioRingBuffer& analyzerFifo,
+                                 std::atomic<float>* outputLevelLinear,
                                  const ProcessingState& state) noexcept;
+        // 透過状態に入るブロックで wet 経路 (OS・OS 域 DC ブロッカ・OutputFilter・SoftClip) の状態を捨てる
+        void enterTransparentDouble() noexcept;
+        // OS = 1 の SoftClip (局所 2 倍 OS)。processDouble / float 経路共通。
+        // adaptiveSoftClipOS のときは softClipRoute が線形域のブロックを遅延線へ回す
+        void processSoftClipLocalOS(juce::dsp::AudioBlock<double>& block,
+                                    double threshold, double knee, double asymmetry) noexcept;
+        // Convolver 段。パイプライン稼働中はワーカーへ投入し、1 ブロック前の結果で block を上書きする
+        void processConvolverStage(juce::dsp::AudioBlock<double>& block) noexcept;
+        // Audio Thread: この DSPCore の EQ / Convolver の RCU reader をコールバックの終わりまで固定する
+        void pinReadersForCallback(convo::CallbackReaderScope& scope) noexcept;
+        // state.stageFadePeer があれば peer の Convolver を同じ入力で並走させ、段出力でクロスフェードする
+        void processConvolverStageForState(juce::dsp::AudioBlock<double>& block, const ProcessingState& state) noexcept;
+        // ★ Convolver 段スコープ遷移の前提 (rebuild / Message Thread。publish 前の DSPCore に対して呼ぶ)
+        //   上流 (入力段・EQ・OS) の出力をそのまま other の Convolver へ渡せる構成か
+        [[nodiscard]] bool hasSameConvolverStageLayout(const DSPCore& other) const noexcept;
+        // Convolver 段の遅延 (処理レート。アルゴリズム + パイプライン)
+        [[nodiscard]] int getConvolverStageLatencySamples() const noexcept;
+        // Channel split helper が稼働中ならそれを返す (オーバーサンプラ / Convolver へ渡す)
+        convo::ChannelForkJoin* channelSplitForBlock() noexcept { return channelSplit.isRunning() ? &channelSplit : nullptr; }
         // ★ v8.3: TrackedMemoryStatistics — 診断用メモリ追跡統計
         //   「正確な物理メモリ使用量」ではなく「診断目的の追跡対象アロケーション統計」
         //   ASSERT_NON_RT_THREAD() 必須 — RT スレッドからの呼び出しは禁止
@@ -1031,18 +1155,17 @@ public:
             size_t oversampling = 0;       // Oversampling work buffers
             size_t softClip = 0;           // SoftClip OS work buffers
             size_t eqProcessor = 0;        // EQ scratch/dry/parallel/structure/msWorkBuffer
-            size_t alignedBuffers = 0;     // alignedL/R + dryBypassL/R
+            size_t alignedBuffers = 0;     // alignedL/R + dryBypassL/R + stageFadeScratchL/R
             size_t latencyBuffers = 0;     // fixedLatency × 4
-            size_t truePeakDetector = 0;   // TruePeakDetector internal
             size_t convolver = 0;          // Convolver internal (no IR = minimal)
             size_t crossfade = 0;          // JUCE crossfade buffers
-            size_t misc = 0;               // DCBlocker/LoudnessMeter/PeakLimiter/NoiseShaper
+            size_t misc = 0;               // DCBlocker/PeakLimiter/NoiseShaper
             size_t otherTracked = 0;       // tracked だが特定カテゴリに分類されないもの
             // totalTracked はメンバとして保持せず、SUM(categories) で算出
 
             [[nodiscard]] size_t totalTracked() const noexcept {
                 return oversampling + softClip + eqProcessor + alignedBuffers
-                     + latencyBuffers + truePeakDetector + convolver + crossfade
+                     + latencyBuffers + convolver + crossfade
                      + misc + otherTracked;
             }
         };
@@ -1050,6 +1173,12 @@ public:
         // ★ v8.3: NonRT 専用 — 診断メモリ統計収集
         //   ASSERT_NON_RT_THREAD() 必須
         [[nodiscard]] TrackedMemoryStatistics collectTrackedMemoryStatistics() const noexcept;
+        // ★ A/B 常駐表示用: 追跡統計 + Convolver (IR スペクトル/FDL) の概算。NonRT 専用
+        [[nodiscard]] size_t estimateResidentBytes() const noexcept;
+
+        // ★ MemoryLedger: DSPLifetimeManager が退役キューへ渡すときに estimateResidentBytes() で設定し、
+        //   destroyDSPCoreNode での破棄とともに消える (回収待ちの量と数を見るため)
+        convo::MemoryCharge retirePendingCharge { convo::MemoryCategory::RetirePending };
 
     private:
         static std::atomic<std::uint64_t> runtimeUuidCounterStorage_;
@@ -1065,8 +1194,35 @@ public:
         virtual void eqSettingsChanged() = 0;
     };
 
-    // FIFO設定
-    static constexpr int FIFO_SIZE = 1048576;  // Lock-free FIFO サイズ (2^20, SAFE_MAX_BLOCK_SIZE * 8x OS をカバー)
+    // Analyzer FIFO 設定 (SpectrumAnalyzerWorker の帯域ごとの FFT 長・描画レートと共有)
+    static constexpr int ANALYZER_FFT_POINTS = 1024;
+    static constexpr int ANALYZER_MIN_PULL_HZ = 15;   // 60 Hz 描画が 3 フレーム続けて遅れても溢れない
+    // タップはベースレート (オーバーサンプリング時は processDown 後) を push するので、
+    // 最も遅い取り出し間隔ぶん + 1 ブロックを入れられる 2 の累乗にする (旧: 固定 2^20 × 2ch)
+    [[nodiscard]] static int getAnalyzerFifoSize(double sampleRate, int maxBlockSize) noexcept
+    {
+        const int perPull = static_cast<int>(sampleRate) / ANALYZER_MIN_PULL_HZ + 1;
+        return juce::nextPowerOfTwo(std::max(perPull, ANALYZER_FFT_POINTS) + std::max(maxBlockSize, 1));
+    }
+
+    // 出力メータのタップ (meteringFifo → MeteringWorker)。MeteringWorker が読んでいる間に作り直さないよう、
+    // 容量はデバイスのレートに依らず SAFE_MAX_SAMPLE_RATE と SAFE_MAX_BLOCK_SIZE から構築時に一度だけ決める
+    static constexpr int METERING_MIN_PULL_HZ = 5;   // 10 Hz の取り出しが 1 周期遅れても溢れない
+    [[nodiscard]] static int getMeteringFifoSize() noexcept
+    {
+        return juce::nextPowerOfTwo(static_cast<int>(SAFE_MAX_SAMPLE_RATE) / METERING_MIN_PULL_HZ + SAFE_MAX_BLOCK_SIZE);
+    }
+
+    // MeteringWorker が公開する出力メータの値 (未計測・無音の LUFS / dBTP は -inf)
+    struct MeterReadings
+    {
+        double momentaryLufs = 0.0;
+        double shortTermLufs = 0.0;
+        double integratedLufs = 0.0;
+        double loudnessRangeLu = 0.0;
+        double truePeakDbtp = 0.0;      // ピークホールド (減衰あり)
+        double truePeakMaxDbtp = 0.0;   // resetLoudnessIntegration() 以降の最大
+    };
 
     // EQ応答曲線計算用の定数
     static constexpr int   NUM_DISPLAY_BARS = 128;
@@ -1157,6 +1313,7 @@ public:
     EQEditProcessor& getEQProcessor() { return uiEqEditor; }
     ThreadAffinityManager& getAffinityManager() noexcept { return affinityManager; }
     [[nodiscard]] const ThreadAffinityManager& getAffinityManager() const noexcept { return affinityManager; }
+    convo::BackgroundScheduler& getBackgroundScheduler() noexcept { return backgroundScheduler_; }
 
     // ========================================================
     // EQ Parameter Wrappers (Thread-safe delegation to uiEqEditor)
@@ -1185,6 +1342,7 @@ public:
     // acquire: prepareToPlay/releaseResources の release と HB し、有効なサンプルレートを取得。
     [[nodiscard]] double getSampleRate() const { return consumeAtomic(currentSampleRate, std::memory_order_acquire); }
     [[nodiscard]] double getProcessingSampleRate() const;
+    [[nodiscard]] double getAnalyzerSampleRate() const;   // analyzerFifo の中身のレート (ベースレート)
     struct LatencyBreakdown
     {
         int oversamplingLatencyBaseRateSamples = 0;
@@ -1192,32 +1350,85 @@ public:
         int convolverIRPeakLatencyBaseRateSamples = 0;
         int convolverTotalLatencyBaseRateSamples = 0;
         int softClipLatencyBaseRateSamples = 0; // 局所2倍OS (SoftClip用)
+        int outputLimiterLatencyBaseRateSamples = 0; // 出力段 LookAheadPeakLimiter の先読み
+        int convolverPipelineLatencyBaseRateSamples = 0; // パイプライン化 Convolver の 1 ブロック遅れ
+        int fixedBlockReblockLatencyBaseRateSamples = 0; // 固定長リブロックの FIFO 遅延
         int totalLatencyBaseRateSamples = 0;
+        // 以下はデバイスのレートのサンプル (固定内部レートが無効なら total は totalLatencyBaseRateSamples と同値)
+        int fixedRateBridgeLatencyDeviceSamples = 0;     // 固定内部レートの SRC + FIFO 遅延
+        int totalLatencyDeviceSamples = 0;               // PDC・オフラインレンダーの頭出しに使う値
     };
 
     [[nodiscard]] LatencyBreakdown getCurrentLatencyBreakdown() const;
     [[nodiscard]] int getCurrentLatencySamples() const;
     [[nodiscard]] int getTotalLatencySamples() const;  // PDC 用エイリアス (getCurrentLatencySamples と同値)
+    // いずれもデバイスのレートのサンプル (totalLatencyDeviceSamples)
 
-    // 【Fix Bug #8】gainToDecibels (std::log10 / libm) を Audio Thread から排除。
-    // Audio Thread は linear gain を inputLevelLinear / outputLevelLinear に格納し、
-    // getter (UI Thread) で dB 変換する。
-    // acquire: Audio Thread の release publishAtomic (inputLevelLinear/outputLevelLinear) と HB
-    //          し、最新のレベル値を UI Thread から安全に取得する。
-    [[nodiscard]] float getInputLevel() const
+    // ★ オフラインレンダー (--cli-render) 用: IR 読み込み・未コミットのリビルド・保留中の再構築理由・
+    //   DSP 交換のクロスフェードがすべて無く、現在のサンプルレートで組んだ DSP が公開済みなら true。
+    //   atomic と公開済み World の読み取りのみ (どのスレッドからも呼べる)
+    [[nodiscard]] bool isRuntimeSettled() const;
+
+    // ★ オフライン一括レンダー (--cli-render-batch) 用の独立ランタイム。
+    //   公開中の DSP と同じ設定で組んだ DSPCore を 1 ワーカーが専有する (World へは公開しない)。
+    //   IR スペクトルは公開中の Convolver と共有するため、ワーカー数ぶん FFT・メモリが増えない。
+    //   ProcessingState は作成時に固定する (アナライザ・学習キャプチャ・整数デバイス補正は無し)。
+    class OfflineRuntime
     {
-        const float linear = consumeAtomic(inputLevelLinear, std::memory_order_acquire);
-        return (linear > LEVEL_METER_MIN_MAG)
-               ? juce::Decibels::gainToDecibels(linear)
-               : LEVEL_METER_MIN_DB;
-    }
-    [[nodiscard]] float getOutputLevel() const
+    public:
+        ~OfflineRuntime();
+        OfflineRuntime(const OfflineRuntime&) = delete;
+        OfflineRuntime& operator=(const OfflineRuntime&) = delete;
+
+        // 所有ワーカー専用。buffer は 2ch・getBlockSize() 以下
+        void process(juce::AudioBuffer<double>& buffer) noexcept;
+        // 所有ワーカー専用。内部状態 (Convolver の残響・ディザ等) を消し、定常状態から始め直す (ファイルの区切り)
+        void reset();
+
+        // 固定内部レート中はデバイス側 (SRC の外側) のブロック長・レート
+        [[nodiscard]] int getBlockSize() const noexcept;
+        [[nodiscard]] double getSampleRate() const noexcept;
+        // パイプライン化 Convolver・固定長リブロックを含まない (オフラインでは使わないため)。固定内部レートの SRC は含む
+        [[nodiscard]] int getLatencySamples() const noexcept;
+
+    private:
+        friend class AudioEngine;
+        OfflineRuntime(AudioEngine& owner, DSPCore* dsp, const DSPCore::ProcessingState& state, int latencySamples) noexcept;
+
+        AudioEngine& owner;
+        DSPCore* dsp;
+        DSPCore::ProcessingState state;
+        int latencySamples;   // DSPCore 分 (内部レート)
+        // 固定内部レート中のみ確保する (公開中の DSP と同じく SRC を挟む)
+        std::unique_ptr<convo::FixedRateBridge<double>> bridge;
+        int outerBlockSize = 0;
+    };
+
+    // isRuntimeSettled() の間に呼ぶこと。非 RT の任意スレッド (呼び出したワーカーの NUMA ノードで確保される)。
+    // 構築は内部で直列化する。ランタイムが生きている間は IR・設定を変えないこと (共有元の退役を避けるため)。
+    // 失敗時 nullptr
+    [[nodiscard]] std::unique_ptr<OfflineRuntime> createOfflineRuntime();
+
+    // UI 観測用スナップショット。Audio Thread がコールバック末尾で 1 回だけ publish し、
+    // UI は getAudioObservation() の 1 回の read で入出力レベルを同じコールバック時点の組として得る。
+    struct AudioObservation
+    {
+        float inputLevelLinear = 0.0f;
+        float outputLevelLinear = 0.0f;
+        uint64_t callbackIndex = 0;
+    };
+    [[nodiscard]] AudioObservation getAudioObservation() const noexcept { return audioObservation.read(); }
+
+    // 【Fix Bug #8】gainToDecibels (std::log10 / libm) を Audio Thread から排除。
+    // Audio Thread は linear gain を格納し、getter (UI Thread) で dB 変換する。
+    [[nodiscard]] static float levelToDecibels(float linear)
     {
-        const float linear = consumeAtomic(outputLevelLinear, std::memory_order_acquire);
         return (linear > LEVEL_METER_MIN_MAG)
                ? juce::Decibels::gainToDecibels(linear)
                : LEVEL_METER_MIN_DB;
     }
+    [[nodiscard]] float getInputLevel() const { return levelToDecibels(getAudioObservation().inputLevelLinear); }
+    [[nodiscard]] float getOutputLevel() const { return levelToDecibels(getAudioObservation().outputLevelLinear); }
 
 
 
@@ -1226,8 +1437,77 @@ public:
     void readFromFifo(float* dest, int numSamples);
     void skipFifo(int numSamples);
 
+    // 出力メータ (LUFS / LRA / TruePeak)。MeteringWorker が止まっている間は全フィールド -inf (LRA は 0)
+    [[nodiscard]] MeterReadings getMeterReadings() const;
+    // Integrated / LRA / 最大 TruePeak の積算をやり直す (ワーカーの次の周期で反映)
+    void resetLoudnessIntegration();
+    // meteringFifo の単一リーダ (MeteringWorker) 専用
+    [[nodiscard]] int getMeteringTapNumReady() const { return meteringFifo.getAvailableSamples(); }
+    // コピーなしで読む: peek で得た区間 (折り返しまで) を読み終えたら commit で解放する
+    [[nodiscard]] LockFreeAudioRingBuffer::ReadSpan peekMeteringTap(int maxSamples) const { return meteringFifo.peekReadable(maxSamples); }
+    void commitMeteringTap(int numSamples) { meteringFifo.commitRead(numSamples); }
+    void skipMeteringTap(int numSamples) { meteringFifo.skip(numSamples); }
+
     void calcEQResponseCurve(float* outMagnitudesL, float* outMagnitudesR, const std::complex<double>* zArray, int numPoints, double sampleRate);
 
+    // ★ EQ fold: 静的・線形な EQ (AGC 無効・非線形飽和 0・Serial・Mid/Side なし) を IR へ焼き込み、
+    //   Audio Thread の EQ 段を省くモード。EQ が kEQFoldSettleMs 変化しなければ焼き込み rebuild を要求し、
+    //   EQ 編集・EQ バイパス・Mix 変更では即座に素の IR + ライブ EQ へ戻す (切替は DSPCore 交換のクロスフェード)。
+    void setEQFoldIntoIREnabled(bool enabled);
+    [[nodiscard]] bool isEQFoldIntoIREnabled() const noexcept { return consumeAtomic(eqFoldIntoIREnabled, std::memory_order_acquire); }
+    // 焼き込みを要求中か (Loader 側で不可判定された場合はライブ EQ のまま)
+    [[nodiscard]] bool isEQFoldIntoIRArmed() const { return uiConvolverProcessor.hasFoldedEQ(); }
+
+    // ★ Split-rate EQ: オーバーサンプリング有効時、EQ を processUp 前のベースレートで処理するモード。
+    //   EQ→Convolver 順かつ AGC 無効の場合のみ適用し、それ以外は従来どおり内部レートで処理する。
+    //   非線形飽和もベースレートで処理されるため、飽和由来の高調波は折り返しを含み得る (CPU とのトレードオフ)。
+    //   切替は DSPCore 交換 (rebuild) で反映する。
+    void setEQSplitRateEnabled(bool enabled);
+    [[nodiscard]] bool isEQSplitRateEnabled() const noexcept { return consumeAtomic(eqSplitRateEnabled, std::memory_order_acquire); }
+
+    // ★ パイプライン化 Convolver: Convolver 段を MMCSS 登録した 2 本目の RT スレッドで 1 ブロック遅れて処理するモード。
+    //   デバイスコールバックには Convolver 以外の段だけが残るため、長い IR でも短いバッファで回せる。
+    //   代償として 1 ブロック (デバイスのバッファ長) の遅延が増え、LatencyBreakdown に計上される。
+    //   ワーカーが期限に間に合わないブロックは無音になる。切替は DSPCore 交換 (rebuild) で反映する。
+    void setPipelinedConvolverEnabled(bool enabled);
+    [[nodiscard]] bool isPipelinedConvolverEnabled() const noexcept { return consumeAtomic(pipelinedConvolverEnabled, std::memory_order_acquire); }
+
+    // ★ Channel split: オーバーサンプラ (up / down) と Convolver の R チャンネルを、audioRealtime マスク上で
+    //   spin 待機する helper スレッドへ毎コールバック fork し、L と並行に処理するモード。
+    //   リンク段 (リミッタ等) の前で join するため遅延は増えない。True-stereo IR の Convolver と
+    //   パイプライン化 Convolver 稼働中の Convolver は対象外。切替は DSPCore 交換 (rebuild) で反映する。
+    void setChannelSplitEnabled(bool enabled);
+    [[nodiscard]] bool isChannelSplitEnabled() const noexcept { return consumeAtomic(channelSplitEnabled, std::memory_order_acquire); }
+
+    // ★ Adaptive SoftClip OS: OS 倍率 1 で SoftClip が使う局所 2 倍 OS を、信号が clip の手前
+    //   (clipStart の -12 dB 以下が 100 ms 続く) にある間は止め、同じ遅延の遅延線で通すモード。
+    //   clipStart の -6 dB を超えるブロックの手前で OS へ戻る。遅延は変わらない。OS 倍率 > 1 の
+    //   全段 OS (EQ / Convolver が内部レートで準備済み) と MinimumPhase の局所 OS は対象外。
+    //   切替は DSPCore 交換 (rebuild) で反映する。
+    void setAdaptiveSoftClipOSEnabled(bool enabled);
+    [[nodiscard]] bool isAdaptiveSoftClipOSEnabled() const noexcept { return consumeAtomic(adaptiveSoftClipOSEnabled, std::memory_order_acquire); }
+
+    // ★ 固定長リブロック: getNextAudioBlock が入出力 FIFO を挟み、DSPCore を常に 2 の冪の内部ブロック
+    //   (NUC L0 partSize と一致) で回すモード。コールバック長が揺れるデバイスでも処理負荷が一定になる。
+    //   代償として内部ブロック - 1 サンプルの遅延が増え、LatencyBreakdown に計上される。
+    //   DSPCore のブロック上限を内部ブロックへ揃えるため、切替は DSPCore 交換 (rebuild) 後に反映する。
+    void setFixedBlockReblockEnabled(bool enabled);
+    [[nodiscard]] bool isFixedBlockReblockEnabled() const noexcept { return consumeAtomic(fixedBlockReblockEnabled, std::memory_order_acquire); }
+    // デバイスのブロック長から内部ブロック長を求める (L0 partSize = nextPowerOfTwo(max(blockSize, 64)) に揃える)
+    [[nodiscard]] static int getFixedReblockSize(int deviceBlockSize) noexcept { return juce::nextPowerOfTwo(std::max(deviceBlockSize, 64)); }
+
+    // ★ 固定内部レート: DSPCore を常に sampleRateHz で回し、デバイスとの間を FixedRateBridge (r8brain SRC) で
+    //   つなぐモード (0 = 無効、デバイスのレートで処理)。IR キャッシュ・EQ 係数・学習バンクは内部レートの
+    //   1 組だけで済み、デバイスのレート変更は SRC の作り直しだけになる (DSPCore の rebuild は起きない)。
+    //   代償として SRC の遅延が増え、LatencyBreakdown に計上される。minimumPhase = false で線形位相の SRC。
+    //   次の prepareToPlay (デバイスの開き直し) で反映する。getSampleRate() は内部レートを返す
+    void setFixedInternalSampleRate(int sampleRateHz, bool minimumPhase);
+    [[nodiscard]] int getFixedInternalSampleRate() const noexcept { return consumeAtomic(fixedInternalSampleRateHz, std::memory_order_acquire); }
+    [[nodiscard]] bool isFixedInternalRateMinimumPhase() const noexcept { return consumeAtomic(fixedInternalRateMinimumPhase, std::memory_order_acquire); }
+    // prepareToPlay が受け取ったデバイスのレート (固定内部レートが無効なら getSampleRate() と同値)
+    [[nodiscard]] double getDeviceSampleRate() const noexcept { return consumeAtomic(deviceSampleRate, std::memory_order_acquire); }
+    static constexpr int kMinFixedInternalSampleRate = 8000;
+
     // パラメータ設定 (Thread-safe)
     void setEqBypassRequested (bool shouldBypass);
     void setConvolverBypassRequested (bool shouldBypass);
@@ -1243,10 +1523,24 @@ public:
 
     void requestEqPreset (int presetIndex);
     void requestEqPresetFromText(const juce::File& file);
+    // ★ プリセットバンク (ディレクトリ内のテキストプリセット群) の EQCoeffCache を
+    //    バックグラウンドで事前構築する。morphKeyframesPerPair > 0 で隣接プリセット間の補間も構築。
+    void prebuildEQPresetBank(const juce::File& presetDirectory, int morphKeyframesPerPair = 0);
+    void cancelEQPresetPrebuild();
     void requestConvolverPreset (const juce::File& irFile);
 
     void requestLoadState (const juce::ValueTree& state);
     [[nodiscard]] juce::ValueTree getCurrentState() const;
+
+    // ★ A/B 比較: 2 つの設定 (IR + EQ + OS) を構築済み DSPCore ごと常駐させ、rebuild なしで切り替える。
+    //   selectABSlot は現在の設定と公開中の DSPCore を選択中スロットへ記録してから slot へ移る。
+    //   slot が空なら現在の設定を初期値にするだけで音は変えない。Message Thread 専用
+    void selectABSlot(convo::ABSlot slot);
+    void clearABSlots();
+    [[nodiscard]] bool isABCompareEngaged() const noexcept { return abCompareEngaged_; }
+    [[nodiscard]] convo::ABSlot getActiveABSlot() const noexcept { return activeABSlot_; }
+    // 待機中 (park) の常駐 DSPCore が保持しているメモリの概算 (bytes)。Message Thread 専用
+    [[nodiscard]] size_t getABStandbyResidentBytes() const noexcept;
     void beginBulkParameterRestore() noexcept;
     void endBulkParameterRestore(bool requestRebuildNow = true) noexcept;
 
@@ -1290,36 +1584,55 @@ public:
         getEQProcessor().setAGCEnabled(!enabled);
         // ★ BUG-10: Auto OFF 時も rebuild が必要。ON/OFF 切り替えで ProcessingPart の
         //   手動値と AutoGainPlanner 計算値の選択が変わるため。
-        submitRebuildIntent(convo::RebuildKind::Structural,
-                            RebuildTelemetryReason::EnqueueSnapshotCommand,
-                            RebuildTelemetryClass::Snapshot,
-                            RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::AutoGainStaging, enabled ? 1u : 0u);
     }
     [[nodiscard]] bool isAutoGainStagingEnabled() const noexcept
     {
         return convo::consumeAtomic(autoGainStagingEnabled, std::memory_order_acquire);
     }
 
+    // ★ 適応バッファ長 (BufferSizeGovernor)。デバイスの開き直しは MainWindow の timer が行う。
+    //   エンジンは設定値を保持するだけ (DeviceSettings が保存・復元する)
+    void setAdaptiveBufferSizeEnabled(bool enabled) noexcept
+    {
+        convo::publishAtomic(adaptiveBufferSizeEnabled, enabled, std::memory_order_relaxed); // relaxed: 単独の設定フラグ
+    }
+    [[nodiscard]] bool isAdaptiveBufferSizeEnabled() const noexcept
+    {
+        return convo::consumeAtomic(adaptiveBufferSizeEnabled, std::memory_order_relaxed); // relaxed: 単独の設定フラグ
+    }
+
     // Audio Thread command queue 経路を廃止し、
     // Message Thread 上の UI staging -> snapshot/rebuild 経路に統一する。
     void setConvolverMix(float value) noexcept
     {
         ASSERT_NON_RT_THREAD();
         uiConvolverProcessor.setMix(value);
-        submitRebuildIntent(convo::RebuildKind::Structural,
-                            RebuildTelemetryReason::EnqueueSnapshotCommand,
-                            RebuildTelemetryClass::Snapshot,
-                            RebuildTelemetryPolicy::Replaceable);
+        cancelEQFoldIntoIR();
+        // EQ fold の解除を伴うため値比較はせず、必ず publication 対象にする
+        postParameterIntentEvent(ParameterIntentSlot::ConvolverMix);
     }
 
     void setConvolverSmoothingTime(float timeSec) noexcept
     {
         ASSERT_NON_RT_THREAD();
         uiConvolverProcessor.setSmoothingTime(timeSec);
-        submitRebuildIntent(convo::RebuildKind::Structural,
-                            RebuildTelemetryReason::EnqueueSnapshotCommand,
-                            RebuildTelemetryClass::Snapshot,
-                            RebuildTelemetryPolicy::Replaceable);
+        postParameterIntent(ParameterIntentSlot::ConvolverSmoothing, std::bit_cast<uint32_t>(timeSec));
+    }
+
+    // ★ Spectral morph: モーフ先の変更は structural hash の変化として changeListener が rebuild を発行する。
+    //   モーフ量は rebuild なしに runtime snapshot で反映する (オートメーション用)
+    void setConvolverSpectralMorphTarget(const juce::File& file) noexcept
+    {
+        ASSERT_NON_RT_THREAD();
+        uiConvolverProcessor.setSpectralMorphTarget(file);
+    }
+
+    void setConvolverSpectralMorphAmount(float amount) noexcept
+    {
+        ASSERT_NON_RT_THREAD();
+        uiConvolverProcessor.setSpectralMorphAmount(amount);
+        postParameterIntent(ParameterIntentSlot::ConvolverMorph, std::bit_cast<uint32_t>(amount));
     }
 
     void setConvolverTargetIRLength(float timeSec, bool manualOverride = false) noexcept;
@@ -1338,12 +1651,38 @@ public:
     void setConvolverTargetUpgradeFFTSize(int fftSize);
     [[nodiscard]] bool isConvolverProgressiveUpgradeEnabled() const;
     void setConvolverEnableProgressiveUpgrade(bool enabled);
+    [[nodiscard]] bool isConvolverStreamingIRActivationEnabled() const;
+    void setConvolverStreamingIRActivationEnabled(bool enabled);
+    // ★ IR リビルドを rebuild worker 上で時間予算つきスライスに分け、スライス間で CPU を譲る (次回リビルドから有効)
+    [[nodiscard]] bool isConvolverIncrementalRebuildEnabled() const;
+    void setConvolverIncrementalRebuildEnabled(bool enabled);
+    [[nodiscard]] bool isConvolverFarTailPagingEnabled() const;
     [[nodiscard]] int getConvolverMaxCacheEntries() const;
     void setConvolverMaxCacheEntries(int maxEntries);
+    [[nodiscard]] size_t getConvolverResampledCacheBudgetBytes() const;
+    void setConvolverResampledCacheBudgetBytes(size_t bytes);
+    [[nodiscard]] std::vector<double> getConvolverStandbySampleRates() const;
+    void setConvolverStandbySampleRates(std::vector<double> rates);
+    [[nodiscard]] size_t getConvolverStandbyBudgetBytes() const;
+    void setConvolverStandbyBudgetBytes(size_t bytes);
+    [[nodiscard]] int getConvolverCachePrefetchCount() const;
+    void setConvolverCachePrefetchCount(int count);
+    [[nodiscard]] size_t getConvolverCachePrefetchBudgetBytes() const;
+    void setConvolverCachePrefetchBudgetBytes(size_t bytes);
+    [[nodiscard]] bool isConvolverCacheCompressionEnabled() const;
+    void setConvolverCacheCompressionEnabled(bool enabled);
+    [[nodiscard]] uint64_t getConvolverCacheDiskBudgetBytes() const;
+    void setConvolverCacheDiskBudgetBytes(uint64_t bytes);
+    [[nodiscard]] bool isConvolverCacheCostWeightedEviction() const;
+    void setConvolverCacheCostWeightedEviction(bool enabled);
+    [[nodiscard]] CacheManager::Stats getConvolverCacheStats() const;
     void clearConvolverCache();
 
     void setDitherBitDepth(int bitDepth);
     [[nodiscard]] int getDitherBitDepth() const;
+    // デバイスの整数出力ビット数 (DeviceOutputCodec::deviceIntegerBitsFor の結果、0 = float / 不明)
+    void setDeviceIntegerOutputBits(int bits);
+    [[nodiscard]] int getDeviceIntegerOutputBits() const;
 
     void setNoiseShaperType(NoiseShaperType type);
     [[nodiscard]] NoiseShaperType getNoiseShaperType() const;
@@ -1427,6 +1766,10 @@ public:
     void setOversamplingType(OversamplingType type);
     [[nodiscard]] OversamplingType getOversamplingType() const;
 
+    // OS 段 2 以降を float32 で処理する (FIR プリセットのみ。変更は構造 rebuild)
+    void setOversamplingSinglePrecision(bool enabled);
+    [[nodiscard]] bool getOversamplingSinglePrecision() const;
+
     // ────────────────────────────────────────────────────────────────
     // 出力周波数フィルター設定 (Thread-safe)
     //
@@ -1456,7 +1799,8 @@ public:
     // acquire: setNoiseShaperLearningMode の release と HB し、最新の LearningMode を取得。
     [[nodiscard]] convo::NoiseShaperLearningMode getNoiseShaperLearningMode() const { return consumeAtomic(pendingLearningMode, std::memory_order_acquire); }
     [[nodiscard]] bool isNoiseShaperLearning() const;
-    [[nodiscard]] const convo::NoiseShaperLearnerProgress& getNoiseShaperLearningProgress() const;
+    // UI 用の進捗スナップショット (seqlock 1 回の読み取り)
+    [[nodiscard]] convo::NoiseShaperLearnerProgressView getNoiseShaperLearningProgress() const;
     [[nodiscard]] int copyNoiseShaperLearningHistory(double* outScores, int maxPoints) const noexcept;
     // 学習ワーカーが記録したエラーメッセージを返す（UI 表示用）。エラーなしは nullptr。
     [[nodiscard]] const char* getNoiseShaperLearningError() const noexcept;
@@ -1552,6 +1896,73 @@ public:
         };
     }
 
+    // ★ 直近の callback 負荷（budget 比 permille, peak-hold）。負荷適応クロスフェードの入力
+    [[nodiscard]] uint16_t getCallbackLoadPermille() const noexcept
+    {
+        return consumeAtomic(rtLocalState_.callbackLoadPermille, std::memory_order_relaxed); // relaxed: 単独の観測値
+    }
+
+    // ★ 学習評価の絞り込み (RuntimeHealthMonitor の LearnerThrottleGovernor。任意スレッド)
+    [[nodiscard]] convo::LearnerThrottle getLearnerThrottle() const noexcept
+    {
+        return m_healthMonitor.getLearnerThrottle();
+    }
+
+    // ★ 段別処理時間の p50 / p99 / p99.9 / max (Message Thread 専用。呼ぶたびに window を進める)
+    [[nodiscard]] convo::StageLatencyReport consumeStageLatencyReport() noexcept
+    {
+        return stageLatencyWindow_.update(stageLatencyHistograms_, convo::getCurrentTimeUs(), convo::readStageClock());
+    }
+
+    // ★ コールバック到着ジッター・負荷の累積分布 (Message Thread。差分は DeviceTimingProfiles が取る)
+    void collectCallbackTiming(convo::CallbackTimingHistograms::Snapshot& out) const noexcept
+    {
+        callbackTiming_.collect(out);
+    }
+
+    // ★ 直近の xrun incident と原因フラグ別の件数 (Message Thread 専用。HealthMonitor の tick が取り込んだ分まで)
+    [[nodiscard]] convo::XrunIncidentCorrelator::Report getXrunIncidentReport() const noexcept
+    {
+        return m_healthMonitor.getXrunIncidentReport();
+    }
+
+    // ★ 評価ワーカーの Audio クラスタ退避の状態と判定回数 (Message Thread 専用)
+    struct AffinityRebalanceTelemetry
+    {
+        bool available = false;             // 退避先があり、判定を行っている
+        bool restricted = false;
+        std::uint64_t restrictCount = 0;
+        std::uint64_t releaseCount = 0;
+        uint16_t lastDecisionLoadPermille = 0;
+        uint32_t lastDecisionEvalCpuPermille = 0;
+    };
+
+    [[nodiscard]] AffinityRebalanceTelemetry getAffinityRebalanceTelemetry() const noexcept
+    {
+        return { affinityManager.canRestrictLearnerEval(),
+                 affinityRebalancer_.isRestricted(),
+                 affinityRebalancer_.getRestrictCount(),
+                 affinityRebalancer_.getReleaseCount(),
+                 affinityRebalanceLastLoad_,
+                 affinityRebalanceLastEvalCpu_ };
+    }
+
+    // ★ CPU 負荷予測 (CpuCostModel.h)。係数は CpuCostCalibration が初回起動時に実測する。未計測なら verdict == Unknown
+    //   makeCpuCostConfig() は UI で要求中の設定から組む (Message Thread)
+    [[nodiscard]] convo::CpuCostConfig makeCpuCostConfig() const;
+    [[nodiscard]] convo::CpuCostPrediction predictCpuCost(const convo::CpuCostConfig& config) const;
+    [[nodiscard]] convo::CpuCostSuggestion suggestCpuCostDowngrade(const convo::CpuCostConfig& config) const;
+
+    // 直近に publish された DSP の予測負荷 (budget 比 permille) と判定 (publish 直前に記録)
+    [[nodiscard]] uint16_t getPublishedCpuCostPermille() const noexcept
+    {
+        return consumeAtomic(publishedCpuCostPermille_, std::memory_order_relaxed); // relaxed: 表示用の単独値
+    }
+    [[nodiscard]] convo::CpuCostPrediction::Verdict getPublishedCpuCostVerdict() const noexcept
+    {
+        return consumeAtomic(publishedCpuCostVerdict_, std::memory_order_relaxed); // relaxed: 表示用の単独値
+    }
+
     struct CliProcessingTelemetrySnapshot
     {
         bool enabled = false;
@@ -1580,6 +1991,9 @@ public:
         std::atomic<uint64_t> audioSampleCursorCounter { 0 };
         std::atomic<uint32_t> audioCallbackActiveCount { 0 };
         std::atomic<uint64_t> audioThreadRetireEnqueueDropped { 0 };
+        // ★ callback 負荷（budget 比 permille）。診断構成に依存せず毎 callback 更新。
+        //   上昇は即時、下降は 1/64 ずつ追従する peak-hold（writer=Audio Thread のみ）
+        std::atomic<uint16_t> callbackLoadPermille { 0 };
         // ★ 計測ログ追加: XRUN/ACTIVATE 追跡用（RT-safe, atomic）
         std::atomic<uint64_t> lastCallbackEndTicks { 0 };       // 前回コールバック終了の HighResolutionTicks
         std::atomic<uint64_t> xrunSequenceCounter { 0 };        // XRUN連番カウンタ
@@ -1838,6 +2252,10 @@ public:
     void setAdaptiveCoefficientsForSampleRate(double sampleRate, const double* coeffs, int numCoefficients);
     void getAdaptiveCoefficientsForSampleRateAndBitDepth(double sampleRate, int bitDepth, double* outCoeffs, int maxCoefficients) const noexcept;
     void setAdaptiveCoefficientsForSampleRateAndBitDepth(double sampleRate, int bitDepth, const double* coeffs, int numCoefficients);
+    // バンクインデックス (getAdaptiveCoeffBankIndex) を直接指定する版。オフライン学習が全バンクを巡回するのに使う
+    void getAdaptiveCoefficientsForBank(int bankIndex, double* outCoeffs, int maxCoefficients) const noexcept;
+    // 係数と学習状態をまとめてバンクへ書く (Message Thread)。live 学習中は拒否して false
+    bool storeAdaptiveCoeffBank(int bankIndex, const double* coeffs, const convo::NoiseShaperLearnerState& state);
     void setAdaptiveAutosaveCallback(std::function<void()> callback);
     void requestAdaptiveAutosave();
     // NoiseShaperLearner から学習済み係数を受け取るコールバック (Worker Thread)
@@ -1850,6 +2268,63 @@ public:
     void setAdaptiveNoiseShaperState(int bankIndex, const convo::NoiseShaperLearnerState& inState) noexcept;
 
 private:
+    void recordCallbackLoad(uint64_t startUs, uint64_t endUs) noexcept
+    {
+        const uint64_t expectedUs = rtLocalState_.expectedCallbackIntervalUs;
+        if (expectedUs == 0 || endUs <= startUs)
+            return;
+
+        const uint64_t sample = std::min<uint64_t>((endUs - startUs) * 1000 / expectedUs, 0xFFFFu);
+        // relaxed: writer は Audio Thread のみ。読み手は単独のスカラー観測値として扱う
+        const uint16_t prev = convo::consumeAtomic(rtLocalState_.callbackLoadPermille, std::memory_order_relaxed);
+        const uint16_t next = (sample >= prev)
+            ? static_cast<uint16_t>(sample)
+            : static_cast<uint16_t>(prev - ((prev - sample + 63) >> 6));
+        convo::publishAtomic(rtLocalState_.callbackLoadPermille, next, std::memory_order_relaxed);
+    }
+
+    // コールバック末尾 (CallbackTelemetryScope の破棄時) に 1 回。DSPCore が書いたレベルを 1 枚にまとめる。
+    // prepareToPlay / releaseResources もメーターを 0 に戻すために呼ぶ。書き込みが重なった側は publish を
+    // 見送るだけなので、Audio Thread はここで待たない
+    void publishAudioObservation(uint64_t callbackIndex) noexcept
+    {
+        AudioObservation observation;
+        // relaxed: 同じ Audio Thread が直前に書いた値。UI への受け渡しは audioObservation の seqlock が担う
+        observation.inputLevelLinear = convo::consumeAtomic(inputLevelLinear, std::memory_order_relaxed);
+        observation.outputLevelLinear = convo::consumeAtomic(outputLevelLinear, std::memory_order_relaxed);
+        observation.callbackIndex = callbackIndex;
+        audioObservation.publish(observation);
+    }
+
+    // ★ xrun 原因相関（Audio Thread）。先頭で publish / reclaim の区間カウンタを控え、
+    //   末尾で期待周期を超えていればその callback の状況を RuntimeHealthMonitor の相関器へ積む
+    [[nodiscard]] convo::XrunIncidentCorrelator::CallbackMark beginXrunCorrelation(uint64_t startUs) noexcept
+    {
+        return m_healthMonitor.getXrunCorrelator().beginCallback(
+            startUs, static_cast<uint32_t>(::GetCurrentProcessorNumber()));
+    }
+
+    void endXrunCorrelation(const convo::XrunIncidentCorrelator::CallbackMark& mark,
+                            uint64_t callbackIndex, uint64_t endUs) noexcept
+    {
+        convo::XrunCallbackContext context;
+        context.cpu = static_cast<uint32_t>(::GetCurrentProcessorNumber());
+        context.crossfadeActive = crossfadeRuntime_.getGain().isSmoothing();
+        // relaxed: 状況フラグとしてのみ読む
+        context.learnerRunning = convo::consumeAtomic(adaptiveCaptureActiveRt, std::memory_order_relaxed);
+        context.rebuildActive = convo::consumeAtomic(rebuildBacklog_, std::memory_order_relaxed) > 0; // relaxed: 同上
+        // 超過の有無に関わらず取り出して次の callback 用に空にする
+        const auto stageCycles = stageLatencyHistograms_.takeCallbackCycles();
+        (void)m_healthMonitor.getXrunCorrelator().endCallback(
+            mark, callbackIndex, endUs, rtLocalState_.expectedCallbackIntervalUs, context, stageCycles);
+        callbackTiming_.record(mark.startUs, endUs, rtLocalState_.expectedCallbackIntervalUs);
+    }
+
+    // ★ publish 直前の負荷予測 (RuntimePublicationOrchestrator::trySubmit、Rebuild Thread)。
+    //   公開は止めない。予測を記録し、Warning 以上なら軽い構成の提案をログへ出す
+    void evaluateCpuCostBeforePublish(const DSPCore& dsp, int generation) noexcept;
+    [[nodiscard]] convo::CpuCostConfig makeCpuCostConfig(const DSPCore& dsp) const;
+
     void recordAudioCallbackProcessingStats(int numSamples, double processTimeUs) noexcept
     {
         if (!consumeAtomic(rtAuxMutable_.cliProcessingTelemetryEnabled, std::memory_order_relaxed))
@@ -1890,6 +2365,18 @@ private:
     int latencyBufSize = 0;
     // AudioThread専用（atomic不要）
     int latencyWritePos = 0;
+    // ★ 固定長リブロック (FIFO は prepareToPlay で確保、以降 AudioThread 専用)
+    convo::FixedBlockReblocker<float> fixedBlockReblockerFloat;    // getNextAudioBlock
+    convo::FixedBlockReblocker<double> fixedBlockReblockerDouble;  // processBlockDouble
+    bool fixedBlockReblockActive_RT = false;
+    // AudioThread → MessageThread: 現在の固定長リブロック遅延 (LatencyBreakdown 用)
+    std::atomic<int> fixedBlockReblockLatency { 0 };
+    // ★ 固定内部レート (SRC・FIFO は prepareToPlay で確保、以降 AudioThread 専用。未準備ならそのまま通す)
+    convo::FixedRateBridge<float> fixedRateBridgeFloat;     // getNextAudioBlock
+    convo::FixedRateBridge<double> fixedRateBridgeDouble;   // processBlockDouble
+    int fixedRateBridgeLatency_RT = 0;                      // 最後に publish した値
+    // AudioThread → MessageThread: 現在の SRC 遅延 (デバイスのレート、FIFO が枯れると増える)
+    std::atomic<int> fixedRateBridgeLatency { 0 };
     // 遅延値はatomicで管理（MessageThread→AudioThread）
     std::atomic<int> latencyDelayOld { 0 };
     std::atomic<int> latencyDelayNew { 0 };
@@ -1967,11 +2454,15 @@ private:
         void storeNewMap(CacheMap* newMap) noexcept;
         void drainDeferredMapsUnderLock() noexcept;
         [[nodiscard]] bool tryEnqueueDeferredMap(CacheMap* map) noexcept;
+        // 流用元として tryAddRef したキャッシュの参照を返す
+        void releasePinnedBase(EQCoeffCache* base) noexcept;
 
         AudioEngine& owner;
         std::mutex writeMutex;
         std::atomic<CacheMap*> cacheMapPtr { nullptr };
         std::vector<CacheMap*> enqueueFallbackMaps;
+        // 直前に map へ追加したキャッシュのハッシュ。次の構築はこのキャッシュからバンド単位で係数を流用する
+        std::atomic<uint64_t> lastCreatedHash { 0 };
     };
 
     static double estimateOversamplingLatencySamples(int oversamplingFactor,
@@ -1982,11 +2473,25 @@ public:
     //----------------------------------------------------------
     // 処理チェーンコンポーネント
     //----------------------------------------------------------
+    // ★ 共有バックグラウンドスケジューラ (段階アップグレードの変換を実行し、rebuild / IR 読み込み / 学習が活動を申告する)。
+    //   uiConvolverProcessor の upgrade スレッドが submit するため、それより前に宣言して後に破棄する
+    convo::BackgroundScheduler backgroundScheduler_;
+
      // UI/State管理用のインスタンス (Audio Threadでは使用しない)
     ConvolverProcessor  uiConvolverProcessor;
     EQEditProcessor uiEqEditor;
 
     LockFreeAudioRingBuffer analyzerFifo;
+    // ★ 出力メータのタップ (ProcessingState::meteringTap)。容量は構築時に getMeteringFifoSize() で確保し、
+    //   prepareToPlay でも作り直さない (旧レートの残りは MeteringWorker がレート変化を見て捨てる)
+    LockFreeAudioRingBuffer meteringFifo { LockFreeAudioRingBuffer::Layout::Stereo };
+    std::unique_ptr<MeteringWorker> meteringWorker_;   // initWorkerThread で開始、shutdownWorkerThread で破棄
+
+    // ★ 段別処理時間: Audio Thread が書き (ProcessingState::stageLatency)、Message Thread の window が集計する
+    convo::StageLatencyHistograms stageLatencyHistograms_;
+    convo::StageLatencyWindow stageLatencyWindow_;
+    // ★ 到着ジッター・締め切りまでの余裕: endXrunCorrelation が書き、collectCallbackTiming が読む
+    convo::CallbackTimingHistograms callbackTiming_;
 
     //----------------------------------------------------------
     // 状態管理
@@ -2140,10 +2645,17 @@ public:
     }
 
     std::atomic<double> currentSampleRate{48000.0};
+    // 固定内部レート中は currentSampleRate (内部レート) と異なる
+    std::atomic<double> deviceSampleRate{48000.0};
     // 【Fix Bug #8】linear gain を格納 (dB変換はgetInputLevel/getOutputLevelで行う)
+    //   UI は直接読まず、publishAudioObservation() が audioObservation へ写したものを読む
     std::atomic<float> inputLevelLinear{0.0f};
     std::atomic<float> outputLevelLinear{0.0f};
+    convo::SeqlockSnapshot<AudioObservation> audioObservation;
     std::atomic<int>   maxSamplesPerBlock{4096};
+    // デバイスが prepareToPlay で通知したブロック長 (固定長リブロック中は maxSamplesPerBlock と異なる)。
+    // 固定内部レート中は SRC の内側から見たブロック長 (内部レート)
+    std::atomic<int>   deviceSamplesPerBlock{0};
 
     // ---- Audio callback 1秒サマリ用（CBSUMMARY） ----
     // CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS に依存しない（常時定義、未使用時は最適化で除去）
@@ -2189,10 +2701,16 @@ public:
     std::atomic<uint64_t> lastCommittedConvolverStructuralHash_{ 0 };
     std::atomic<bool> lastCommittedConvolverHasIr_{ false };
     EQCacheManager eqCacheManager;
+    // プリセットバンク事前構築ワーカー (Message Thread で起動/停止。eqCacheManager より先に破棄される)
+    std::unique_ptr<EQPresetPrebuildThread> eqPresetPrebuildThread;
+    juce::File eqPresetBankDirectory;
+    double eqPresetBankSampleRate = 0.0;
+    static constexpr int kMaxEQPresetBankFiles = 64;
     std::atomic<ProcessingOrder> currentProcessingOrder{ProcessingOrder::ConvolverThenEQ};
     std::atomic<AnalyzerSource> currentAnalyzerSource { AnalyzerSource::Output };
     std::atomic<bool> analyzerEnabled { false };
     std::atomic<int> ditherBitDepth { 0 }; // 0 = 未初期化 (DeviceSettingsで最大値に設定される)
+    std::atomic<int> deviceIntegerOutputBits { 0 }; // 0 = float / 不明 (MainWindow がデバイス変更時に設定)
     std::atomic<NoiseShaperType> noiseShaperType { NoiseShaperType::Psychoacoustic };
 
     // 【False Sharing 防止】頻繁な UI 更新変数を独立キャッシュラインへ配置
@@ -2226,6 +2744,8 @@ public:
     #pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
     alignas(64) std::atomic<convo::NoiseShaperLearningMode> pendingLearningMode { convo::NoiseShaperLearningMode::Short };
     alignas(64) std::atomic<bool> adaptiveCaptureActiveRt { false };
+    // NoiseShaperLearner がモード / フェーズ / レートから決める間引き率 (単独の int なので relaxed で足りる)
+    alignas(64) std::atomic<int> adaptiveCaptureStrideRt { 1 };
     alignas(64) std::atomic<uint64_t> globalCaptureSessionId { 1 };
     #pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 
@@ -2289,6 +2809,7 @@ public:
 
     std::atomic<int> manualOversamplingFactor { 0 }; // 0=Auto, 1=1x, 2=2x, 4=4x, 8=8x
     std::atomic<OversamplingType> oversamplingType { OversamplingType::IIR };
+    std::atomic<bool> oversamplingSinglePrecision { false }; // OS 段 2 以降 float32 (既定 OFF)
 
     #pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
     #pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
@@ -2299,8 +2820,40 @@ public:
 
     // ★ v14.0: Auto Gain Staging フラグ
     std::atomic<bool> autoGainStagingEnabled { true };
+    std::atomic<bool> adaptiveBufferSizeEnabled { false };
     #pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 
+    // ★ EQ fold (Message Thread 管理。eqFoldIntoIREnabled のみ UI 参照用に atomic)
+    static constexpr double kEQFoldSettleMs = 1500.0;
+    std::atomic<bool> eqFoldIntoIREnabled { false };
+    double eqFoldLastEditMs = 0.0;
+    uint64_t eqFoldParamsHash = 0;       // 焼き込み要求中の EQ パラメータハッシュ (0 = 未要求)
+    // EQ 編集等で焼き込みを解除する。rebuild 要求は呼び出し側が行う
+    void cancelEQFoldIntoIR();
+    // timerCallback から呼ぶ: 静止した EQ の焼き込み要求 / 条件外になった焼き込みの解除
+    void serviceEQFoldIntoIR();
+    void updateAffinityRebalance();
+    [[nodiscard]] bool captureFoldableEQ(convo::EQParameters& out) const;
+
+    // ★ Split-rate EQ (rebuild thread が DSPCore::eqSplitRate へ転写)
+    std::atomic<bool> eqSplitRateEnabled { false };
+    // publish 直前の負荷予測 (writer: Rebuild Thread の trySubmit、reader: UI)
+    std::atomic<uint16_t> publishedCpuCostPermille_ { 0 };
+    std::atomic<convo::CpuCostPrediction::Verdict> publishedCpuCostVerdict_ { convo::CpuCostPrediction::Verdict::Unknown };
+    // ★ パイプライン化 Convolver (rebuild thread が DSPCore::configureConvolverPipeline へ渡す)
+    std::atomic<bool> pipelinedConvolverEnabled { false };
+    // ★ Channel split (rebuild thread が DSPCore::configureChannelSplit へ渡す)
+    std::atomic<bool> channelSplitEnabled { false };
+    // ★ Adaptive SoftClip OS (rebuild thread が DSPCore::adaptiveSoftClipOS へ転写)
+    std::atomic<bool> adaptiveSoftClipOSEnabled { false };
+    // ★ 固定長リブロック (prepareToPlay / setter が maxSamplesPerBlock を内部ブロックへ揃える)
+    std::atomic<bool> fixedBlockReblockEnabled { false };
+    // fixedBlockReblockEnabled とデバイス長から maxSamplesPerBlock を更新する。変わったら true (rebuild は呼び出し側)
+    bool syncMaxSamplesPerBlockToFixedReblock();
+    // ★ 固定内部レート (prepareToPlay が読む)
+    std::atomic<int> fixedInternalSampleRateHz { 0 };
+    std::atomic<bool> fixedInternalRateMinimumPhase { true };
+
     std::atomic<int> rebuildRequestGeneration { 0 }; // 非同期リビルドの競合防止用
     std::atomic<int> lastCommittedRebuildGeneration { 0 }; // commit 完了済み世代
 
@@ -2311,6 +2864,31 @@ public:
     #pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 
     bool m_isRestoringState { false }; // requestLoadState 中はデフォルトリセットを抑制 (Message Thread のみ)
+
+    // ★ A/B 常駐スロット。DSPLifetimeManager の retire 経路が常駐中の DSPCore を park する
+    convo::ABResidentBank<DSPCore> abResidentBank_;
+    std::array<juce::ValueTree, 2> abSlotStates_;            // Message Thread のみ
+    convo::ABSlot activeABSlot_ { convo::ABSlot::A };         // Message Thread のみ
+    bool abCompareEngaged_ { false };                         // Message Thread のみ
+    // 切替直後の rebuild 抑止: 再公開した常駐 DSPCore の構築入力 (Message Thread のみ)
+    bool abSettlingActive_ { false };
+    convo::RuntimeBuildSnapshot abSettlingSnapshot_ {};
+    void captureActiveIntoABSlot(convo::ABSlot slot);
+    [[nodiscard]] bool republishABResident(convo::ABSlot slot);
+    void retireParkedABResident(DSPCore* dsp) noexcept;
+    [[nodiscard]] bool shouldSuppressRebuildForABResident(const convo::BuildInput& buildInput,
+                                                          std::uint64_t convolverFingerprint) noexcept;
+
+    // ★ デバイス再起動の常駐: releaseResources は公開中の DSPCore を破棄せずここへ預け、次の prepareToPlay が
+    //   同じレート・同じ構築入力・ブロック長が prepare 済みの長さ以下なら reset して再公開する (rebuild しない)。
+    //   releaseResources / prepareToPlay / dtor からのみ触る (lifecycleState の Releasing / Preparing で直列化)
+    DSPCore* deviceRestartResident_ { nullptr };
+    std::uint64_t deviceRestartParkEpoch_ { 0 };
+    [[nodiscard]] bool parkForDeviceRestart(DSPCore* dsp) noexcept;
+    [[nodiscard]] bool republishDeviceRestartResident(double sampleRate, int blockSize, bool& exactBlock);
+    void releaseDeviceRestartResident() noexcept;
+    // rebuild 要求と同じ手順で、いまのパラメータから構築入力を作る
+    [[nodiscard]] convo::BuildInput captureBuildInputForRebuild(double sampleRate, int blockSize) const noexcept;
     // 出力周波数フィルターモード (Thread-safe)
     std::atomic<convo::HCMode> convHCFilterMode { convo::HCMode::Natural }; // ① ハイカット
     std::atomic<convo::LCMode> convLCFilterMode { convo::LCMode::Natural }; // ① ローカット
@@ -2323,7 +2901,19 @@ public:
     // EQ応答曲線計算用ワークバッファ (Message Thread/UI Threadで再利用)
     std::array<float, NUM_DISPLAY_BARS> eqTotalMagSqLBuffer;
     std::array<float, NUM_DISPLAY_BARS> eqTotalMagSqRBuffer;
-    std::array<float, NUM_DISPLAY_BARS> eqBandMagSqBuffer;
+
+    // ★ EQ応答曲線のバンド別キャッシュ (Message Thread/UI Thread のみ)
+    //    key = EQProcessor::computeBandResponseHash。一致するバンドは再計算せず再合成のみ行う。
+    //    gridKey は表示グリッド (zArray の内容/点数) が変わったとき全エントリを無効化するためのもの。
+    struct EQResponseBandCacheEntry
+    {
+        uint64_t key = 0;                                 // 0 = 未構築
+        std::array<float,  NUM_DISPLAY_BARS> magSq {};    // |H|^2 (Serial 合成用)
+        std::array<double, NUM_DISPLAY_BARS> re {};       // H の実部 (Parallel 合成用)
+        std::array<double, NUM_DISPLAY_BARS> im {};       // H の虚部
+    };
+    std::array<EQResponseBandCacheEntry, EQProcessor::NUM_BANDS> eqResponseBandCache;
+    uint64_t eqResponseGridKey = 0;
 
     //----------------------------------------------------------
     // プライベートヘルパー (Message Thread のみ)
@@ -2340,9 +2930,35 @@ public:
     // [P1 Phase1-B] PublicationIntent/PublicationLog 完全削除。
     // 直接 commitNewDSP を呼び出す単一スロットの pending commit を使用。
     void enqueuePublicationIntentForRuntimeCommit(DSPCore* newDSP, int generation, const convo::RuntimeBuildSnapshot& sealedSnapshot, const convo::BuildAnalysis& buildAnalysis = {}, const convo::OversamplingResult& oversamplingResult = {}, const convo::BuildDiagnostics& buildDiagnostics = {});
+    // ★ rebuild レーン
+    //   Light: 構造入力 (SR / ブロック長 / OS / Convolver fingerprint) が直近に queue したタスクと同じ、
+    //          パラメータ・EQ だけの変更。Heavy: 構造入力が変わる rebuild (IR / SR / OS)。
+    //   レーンごとに pending 1 枠 (latest wins) と専用スレッドを持つため、
+    //   EQ の微調整が長い IR rebuild の後ろで待たされず、進行中の Heavy を打ち切りもしない。
+    enum class RebuildLane : uint8_t { Light = 0, Heavy = 1 };
+    static constexpr size_t kRebuildLaneCount = 2;
+    static constexpr const char* rebuildLaneToString(RebuildLane lane) noexcept
+    {
+        return lane == RebuildLane::Light ? "light" : "heavy";
+    }
     // acquire: requestRebuild の rebuildRequestGeneration 更新 release と HB し、
     //          リビルド世代が古いか否かを各スレッドから安全に判定。
-    [[nodiscard]] bool isRebuildObsolete(int generation) const { return generation != consumeAtomic(rebuildRequestGeneration, std::memory_order_acquire); }
+    // Light は後続のどの世代にも追い越される。Heavy は後続の Heavy にだけ追い越される
+    //   (後続の Light は同じ構造を含むため、先に完成した方が出版され、遅れた方は世代順で落ちる)
+    [[nodiscard]] bool isRebuildObsolete(int generation, RebuildLane lane) const
+    {
+        if (lane == RebuildLane::Light)
+            return generation != consumeAtomic(rebuildRequestGeneration, std::memory_order_acquire);
+        return generation != consumeAtomic(heavyRebuildGeneration_, std::memory_order_acquire) || isShutdownInProgress();
+    }
+    // PublicationAdmission の世代判定: 最新世代、または最新の Heavy でまだ新しい世代が出版されていないもの
+    [[nodiscard]] bool isRebuildGenerationPublishable(int generation) const noexcept
+    {
+        if (generation == consumeAtomic(rebuildRequestGeneration, std::memory_order_acquire))
+            return true;
+        return generation == consumeAtomic(heavyRebuildGeneration_, std::memory_order_acquire)
+            && generation > consumeAtomic(lastSubmittedRebuildGeneration_, std::memory_order_acquire);
+    }
     bool enqueueLearningCommand(const LearningCommand& cmd) noexcept;
     [[nodiscard]] bool dequeueLearningCommand(LearningCommand& cmd) noexcept;
     bool enqueueLearnerDispatch(const LearnerDispatchAction& action) noexcept;
@@ -2371,6 +2987,9 @@ public:
     [[nodiscard]] MmcssPolicy getCurrentMmcssPolicy() const noexcept;
     [[nodiscard]] bool tryApplyMmcssForSelfManagedThread() noexcept;
     void revertMmcssOnAudioThread() noexcept;
+    // ★ DSP helper (パイプライン化 Convolver のワーカー / Channel split の helper) を MMCSS 登録
+    //   (スレッド先頭で 1 回。バックエンドによらず自前登録)
+    [[nodiscard]] bool applyMmcssForDspHelperThread() noexcept;
     // ★ [work62/work70 v9.11] CPU affinity + NativeRT priority setting (always called once).
     //    MMCSS registration is handled by tryApplyMmcssForSelfManagedThread() separately.
     bool applyMmcssPriority() noexcept;
@@ -2379,6 +2998,8 @@ public:
     // ★ [work63] シャットダウン完了処理（releaseResources から呼ばれる安全網）— legacy alias
     void finalizeMmcssShutdown() noexcept;
     void shutdownWorkerThread();
+    // shutdownWorkerThread の前半 (スケジューラ・Worker・MeteringWorker へ停止要求のみ、join しない)
+    void requestWorkerThreadStop();
 
     // ★ [work63] Audio Thread 優先度モード設定／解除
     void setAudioThreadPriorityMode(bool useMmcss);
@@ -2436,19 +3057,29 @@ public:
             + juce::String(origin != nullptr ? origin : "unknown");
         DBG(log);
         juce::Logger::writeToLog(log);
+        // 終了時のハングは最後に通ったフェーズで切り分ける (ログが flush される前に止まることがある)
+        if (flightRecorder_ != nullptr)
+            flightRecorder_->writeLifecycle(static_cast<uint32_t>(nextPhase), shutdownPhaseToString(nextPhase),
+                                            origin, convo::getCurrentTimeUs());
     }
 
-    // Worker thread for rebuilds
-    void rebuildThreadLoop();
+    // Worker threads for rebuilds (レーン別、RebuildLane 参照)
+    void rebuildThreadLoop(RebuildLane lane);
+    void startRebuildThreads();
     void stopRebuildThread();
-    std::thread rebuildThread;
+    // exit フラグを立てて待機中のレーンを起こすだけ (join は stopRebuildThread)
+    void requestRebuildThreadStop() noexcept;
     std::mutex rebuildMutex;
     std::condition_variable rebuildCV;
     std::atomic<bool> rebuildThreadShouldExit { false };
-    std::atomic<bool> rebuildThreadIsRunning { false };
+    std::atomic<int> rebuildThreadRunningCount { 0 };
+    // レーン間で publication 投入を直列化し、世代順 (新しい世代の後に古い世代を出さない) を保つ
+    std::mutex rebuildCommitMutex;
+    std::atomic<int> heavyRebuildGeneration_ { 0 };          // 直近に queue した Heavy タスクの世代
+    std::atomic<int> lastSubmittedRebuildGeneration_ { 0 };  // publication へ投入した最新世代 (rebuildCommitMutex 下で更新)
+    std::mutex offlineRuntimeBuildMutex;  // createOfflineRuntime の構築を rebuild thread 同様 1 本ずつにする
     std::atomic<ShutdownPhase> shutdownPhase { ShutdownPhase::Running };
     std::atomic<EngineLifecycleState> lifecycleState { EngineLifecycleState::Unprepared };
-    bool hasPendingTask = false;
 
     struct RebuildTask {
         DSPCore* currentDSP = nullptr;
@@ -2460,8 +3091,21 @@ public:
         convo::BuildDiagnostics buildDiagnostics {};     // ★ v14.37
         int generation = 0;
     };
-    RebuildTask pendingTask;
+    struct RebuildLaneSlot {
+        RebuildTask pendingTask;
+        bool hasPendingTask = false;
+        std::thread thread;
+    };
+    std::array<RebuildLaneSlot, kRebuildLaneCount> rebuildLanes_;  // pendingTask / hasPendingTask は rebuildMutex 保護
     RebuildTask lastQueuedTaskSignature;
+    // Auto Gain 用 EQ 解析の Band 別応答キャッシュ (rebuildMutex 保護)。EQ を 1 Band 動かすたびの
+    // requestRebuild では、その Band の応答だけを再評価する
+    EQResponseCache eqResponseCache_;
+
+    RebuildLaneSlot& rebuildLane(RebuildLane lane) noexcept { return rebuildLanes_[static_cast<size_t>(lane)]; }
+    // rebuildMutex 保持中に呼ぶ。pending タスクの currentDSP を取り外して返す (解放はロック外で)
+    DSPCore* takePendingRebuildTaskLocked(RebuildLane lane) noexcept;
+    void publishRebuildBacklogLocked() noexcept;
 
     // --- Adaptiveノイズシェイパー学習用メンバー ---
     struct AdaptiveCoeffBankSlot
@@ -2476,7 +3120,8 @@ public:
         std::atomic<bool> writeLock { false };  // CAS用書き込みロック
     };
 
-    LockFreeRingBuffer<AudioBlock, 4096> audioCaptureQueue;
+    AdaptiveCaptureQueue audioCaptureQueue;
+    convo::MemoryCharge audioCaptureQueueCharge { convo::MemoryCategory::Learner, sizeof(AdaptiveCaptureQueue) };
     // ★ 計測ログ追加: XRUN リングバッファ（Audio Thread write, Timer Thread read）
     static constexpr size_t kXRunBufferCapacity = 64;
     LockFreeRingBuffer<XRunEvent, kXRunBufferCapacity> xRunBuffer;
@@ -2493,6 +3138,12 @@ public:
     LearnerStateSnapshot lastKnownGoodNoiseShaper_;
     ThreadAffinityManager affinityManager;
     bool hasHeterogeneousCores_ = false; // ★ [work64] P/E混在フラグ（initialize時に設定）
+    // 評価ワーカー退避の判定 (updateAffinityRebalance。いずれも Message Thread のみ読み書き)
+    convo::AffinityRebalancer affinityRebalancer_;
+    uint64_t affinityRebalanceLastCpuTime_ = 0;
+    double affinityRebalanceLastTickMs_ = 0.0;
+    uint16_t affinityRebalanceLastLoad_ = 0;
+    uint32_t affinityRebalanceLastEvalCpu_ = 0;
     std::array<AdaptiveCoeffBankSlot, kAdaptiveNoiseShaperSampleRateBankCount * kAdaptiveBitDepthCount * kLearningModeCount> adaptiveCoeffBanks {};
     std::atomic<int> currentAdaptiveCoeffBankIndex { 1 };
     std::mutex adaptiveAutosaveCallbackMutex;
@@ -2587,7 +3238,9 @@ public:
         SnapshotCommandBufferFullNonMt,
         SnapshotCommandQueuedNonMt,
         RetirePressureSevere,
-        SameAsPendingWouldMerge
+        SameAsPendingWouldMerge,
+        EqFoldIntoIRChanged,
+        ABResidentRepublished
     };
 
     enum class RebuildTelemetryClass : uint8_t
@@ -2669,6 +3322,8 @@ public:
             case RebuildTelemetryReason::SnapshotCommandQueuedNonMt: return "snapshot_command_queued_non_mt";
             case RebuildTelemetryReason::RetirePressureSevere: return "retire_pressure_severe";
             case RebuildTelemetryReason::SameAsPendingWouldMerge: return "same_as_pending_would_merge";
+            case RebuildTelemetryReason::EqFoldIntoIRChanged: return "eq_fold_into_ir_changed";
+            case RebuildTelemetryReason::ABResidentRepublished: return "ab_resident_republished";
         }
         return "unknown_reason";
     }
@@ -2744,6 +3399,51 @@ public:
                              RebuildTelemetryClass rebuildClass = RebuildTelemetryClass::NA,
                              RebuildTelemetryPolicy collapsePolicy = RebuildTelemetryPolicy::NA) noexcept;
 
+    // ★ パラメータ変更の合流バス: Snapshot クラスの Replaceable intent はパラメータごとのスロットへ
+    //   last-value-wins で積み、Message Thread の handleAsyncUpdate / timerCallback で 1 回にまとめて
+    //   submitRebuildIntent する。オートメーションのバーストでも publication は 1 drain につき 1 回。
+    enum class ParameterIntentSlot : uint8_t
+    {
+        EqBypass = 0,
+        ConvolverBypass,
+        EqSplitRate,
+        PipelinedConvolver,
+        ChannelSplit,
+        AdaptiveSoftClipOS,
+        FixedBlockReblock,
+        InputHeadroom,
+        OutputMakeup,
+        ProcessingOrder,
+        ConvolverInputTrim,
+        ModeDefaults,
+        DitherBitDepth,
+        NoiseShaper,
+        SoftClip,
+        Saturation,
+        OversamplingFactor,
+        OversamplingType,
+        AutoGainStaging,
+        ConvolverMix,
+        ConvolverSmoothing,
+        ConvolverParams,
+        ConvolverMorph,
+        Count
+    };
+    using ParameterIntentBus = convo::CoalescingCommandBus<static_cast<size_t>(ParameterIntentSlot::Count)>;
+
+    // value: パラメータ値のビット列 (net で元に戻ったバーストは drain で落ちる)
+    void postParameterIntent(ParameterIntentSlot slot, uint64_t value) noexcept;
+    // 値で比較できない変更 (副作用を伴う setter) 用。drain で必ず publication 対象になる
+    void postParameterIntentEvent(ParameterIntentSlot slot) noexcept;
+    // Message Thread 専用。正味で変化したスロットがあれば submitRebuildIntent を 1 回だけ発行する
+    void drainParameterIntents() noexcept;
+
+    // 遅延 rebuild (DeferredStructural / DeferredFinalizeAware) の判定を期限駆動ワーカーへ予約する。
+    // dueTicks: 発火予定の HighResolutionTicks (0 以下なら直ちに判定)。任意の Non-RT スレッドから呼べる
+    void scheduleDeferredRebuildService(int64_t dueTicks = 0);
+    // Message Thread 専用 (handleAsyncUpdate から)。期限到来分を発行し、未到来分はワーカーを再予約する
+    void serviceDeferredRebuilds();
+
     struct RebuildAdmissionIntentState
     {
         bool valid = false;
@@ -3321,7 +4021,8 @@ public:
         [[nodiscard]] bool validatePublicationNonRt(const RuntimePublishWorld& world) noexcept
         {
             // Delegation to independent validator (#21 Sprint-4)
-            const auto result = validator_->validatePublication(world);
+            // ★ 増分検証: Builder が載せた dirty フィールドに依存する検査だけを実行
+            const auto result = validator_->validatePublication(world, world.metadata.dirtyFieldMask);
             if (!result.isValid) {
                 // ★ P0-3: Validator 失敗理由を HealthMonitor 経由で非同期通知
                 //   （runPublicationPrecheckNonRt の重複 Validator を削除したため、
@@ -3688,9 +4389,22 @@ public:
             .adaptiveCaptureBitDepth = dsp->ditherBitDepth,
             .captureSessionId = dsp->currentCaptureSessionId,
             .adaptiveCaptureQueue = snapshot.adaptiveCaptureEnabled ? &audioCaptureQueue : nullptr,
+            .adaptiveCaptureStride = consumeAtomic(adaptiveCaptureStrideRt, std::memory_order_relaxed),
             .eqParams = eqParams,
             .eqCache = eqCache,
-            .eqCoeffHash = eqCoeffHash
+            .eqCoeffHash = eqCoeffHash,
+            // Convolver バイパス中は焼き込み済み EQ も通らないため、ライブ EQ へ戻す
+            .eqFoldedIntoIR = dsp->eqFoldedIntoIR && !snapshot.convBypassed,
+            // 係数キャッシュはベースレートで生成済み。AGC は時定数が内部レート依存のため対象外
+            .eqAtBaseRate = dsp->eqSplitRate
+                && dsp->oversamplingFactor > 1
+                && snapshot.order == ProcessingOrder::EQThenConvolver
+                && !eqBypassedFailClosed
+                && !eqParams->agcEnabled,
+            .deviceCodeGain = convo::output::deviceIntegerCodeGain(
+                consumeAtomic(deviceIntegerOutputBits, std::memory_order_relaxed), dsp->ditherBitDepth),
+            .stageLatency = &stageLatencyHistograms_,
+            .meteringTap = &meteringFifo
         };
     }
 
@@ -3761,6 +4475,86 @@ public:
         return false;
     }
 
+    // ★ Convolver 段スコープ遷移: 新 DSPCore の fade-in (warm-up) が済んだブロックからは旧 DSPCore の全段処理をやめ、
+    //   Convolver 段だけを並走させる (state.stageFadePeer)。適用したブロックぶんのクロスフェードゲインはここで進める。
+    //   出力段の遅延整列バッファを通らないので、整列遅延が 0 のときに限る
+    inline bool prepareConvolverStageCrossfadeRT(DSPCore* current,
+                                                 DSPCore* fading,
+                                                 bool useDryAsOld,
+                                                 const CrossfadePreparedSnapshot& prepared,
+                                                 int blockSamples,
+                                                 DSPCore::ProcessingState& state) noexcept
+    {
+        auto& gain = crossfadeRuntime_.getGain();
+        if (fading == nullptr
+            || useDryAsOld
+            || state.convBypassed
+            || !gain.isSmoothing()
+            || !crossfadeRuntime_.isConvolverStageScoped()
+            || prepared.latencyDelayOld != 0
+            || prepared.latencyDelayNew != 0
+            || current->ramps().fadeInSamplesLeft > 0
+            || blockSamples * static_cast<int>(current->oversamplingFactor) > current->stageFadeScratchCapacity)
+            return false;
+
+        state.stageFadePeer = fading;
+        state.stageFadeGainStart = gain.getCurrentValue();
+        gain.skip(blockSamples);
+        state.stageFadeGainEnd = gain.getCurrentValue();
+        return true;
+    }
+
+    // ★ 固定長リブロック: このコールバックで FIFO を挟むかを決める。DSPCore (フェード中は両方) の
+    //   ブロック上限が内部ブロックに届いている (rebuild 済み) ときだけ挟む。切替時は FIFO を空にして
+    //   遅延ぶんの無音から始め (DSPCore 交換と同じく 1 回だけ不連続)、遅延を LatencyBreakdown へ公開する
+    template <typename SampleType>
+    inline bool updateFixedBlockReblockState(convo::FixedBlockReblocker<SampleType>& reblocker,
+                                             int numSamples,
+                                             const DSPCore* current,
+                                             const DSPCore* fading) noexcept
+    {
+        const int reblockSize = reblocker.getBlockSize();
+        const bool reblock = consumeAtomic(fixedBlockReblockEnabled, std::memory_order_acquire) // acquire: setFixedBlockReblockEnabled の acq_rel と HB
+            && reblocker.isPrepared()
+            && numSamples <= reblocker.getMaxCallbackSamples()
+            && reblockSize <= current->maxSamplesPerBlock
+            && (fading == nullptr || reblockSize <= fading->maxSamplesPerBlock);
+        if (reblock != fixedBlockReblockActive_RT)
+        {
+            reblocker.reset();
+            fixedBlockReblockActive_RT = reblock;
+            publishAtomic(fixedBlockReblockLatency, reblock ? reblocker.getLatencySamples() : 0,
+                          std::memory_order_release); // release: getCurrentLatencyBreakdown の acquire と HB
+        }
+        return reblock;
+    }
+
+    // ★ 固定内部レート: 公開している prepareToPlay / processBlockDouble / getNextAudioBlock は SRC を挟むだけで、
+    //   エンジン本体は以下の内部レート版 (固定内部レートが無効ならデバイスのレートのまま) が担う
+    void prepareToPlayAtEngineRate (int samplesPerBlockExpected, double sampleRate);
+    void processBlockDoubleAtEngineRate (juce::AudioBuffer<double>& buffer);
+    void getNextAudioBlockAtEngineRate (const juce::AudioSourceChannelInfo& bufferToFill);
+
+    // channels (デバイスのレート) を SRC で挟み、blockFn を内部レートの 1 ブロックで呼ぶ。SRC の遅延が
+    // 変わったら (FIFO が枯れて無音を埋めたとき) LatencyBreakdown へ公開する。false = 上限超過 (呼び出し側で無音)
+    template <typename SampleType, typename BlockFn>
+    inline bool processThroughFixedRateBridge(convo::FixedRateBridge<SampleType>& bridge,
+                                              SampleType* const* channels,
+                                              int numChannels,
+                                              int numSamples,
+                                              BlockFn&& blockFn) noexcept
+    {
+        if (bridge.process(channels, numChannels, numSamples, std::forward<BlockFn>(blockFn)) < 0)
+            return false;
+        const int latency = bridge.getLatencySamples();
+        if (latency != fixedRateBridgeLatency_RT)
+        {
+            fixedRateBridgeLatency_RT = latency;
+            publishAtomic(fixedRateBridgeLatency, latency, std::memory_order_release); // release: getCurrentLatencyBreakdown の acquire と HB
+        }
+        return true;
+    }
+
     inline void finalizeCrossfadeMixPath(DSPCore* current,
                                          DSPCore* fading,
                                          bool resetDryScaleGain) noexcept
@@ -3920,13 +4714,17 @@ static inline bool reserveInactiveCoeffSet(AdaptiveCoeffBankSlot& slot) noexcept
     return (active == 0) ? &slot.coeffSetB : &slot.coeffSetA;
 }
 
-inline bool enqueueDeferredDeleteNonRt(void* ptr, void (*deleter)(void*)) noexcept
+// producer: 退役バッチレーンの区分 (呼び出し元が RetireBatchScope を開いていればそちらに合流する)
+inline bool enqueueDeferredDeleteNonRt(void* ptr, void (*deleter)(void*),
+                                       convo::isr::RetireProducer producer = convo::isr::RetireProducer::Lifetime) noexcept
 {
-    const auto result = enqueueDeferredDeleteNonRtWithResult(ptr, deleter);
+    const auto result = enqueueDeferredDeleteNonRtWithResult(ptr, deleter, producer);
     return result != convo::isr::RetireEnqueueResult::Shutdown;
 }
 
-inline convo::isr::RetireEnqueueResult enqueueDeferredDeleteNonRtWithResult(void* ptr, void (*deleter)(void*)) noexcept
+inline convo::isr::RetireEnqueueResult enqueueDeferredDeleteNonRtWithResult(
+    void* ptr, void (*deleter)(void*),
+    convo::isr::RetireProducer producer = convo::isr::RetireProducer::Lifetime) noexcept
 {
     if (ptr == nullptr || deleter == nullptr)
         return convo::isr::RetireEnqueueResult::Success;
@@ -3935,6 +4733,7 @@ inline convo::isr::RetireEnqueueResult enqueueDeferredDeleteNonRtWithResult(void
         return convo::isr::RetireEnqueueResult::Shutdown;
 
     const uint64_t epoch = markRetireEpoch();
+    convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*m_retireRouter, producer);
 
     // [Bug2 Phase1] Router の enqueueWithRetry に委譲（リトライロジックは Router に集約）
     auto result = m_retireRouter->enqueueWithRetry(ptr, deleter, epoch, DeletionEntryType::Generic);
@@ -4196,12 +4995,12 @@ public:
     GenerationManager m_generationManager;
 
     // ==================================================================
-    // Phase 3: コマンドバッファ + ワーカースレッド
+    // Phase 3: 期限駆動ワーカースレッド（遅延 rebuild の起床）
     // ==================================================================
-    convo::CommandBuffer m_commandBuffer;
     convo::WorkerThread m_workerThread;
     std::mutex rebuildAdmissionIntentMutex_;
     RebuildAdmissionIntentState rebuildAdmissionPendingIntent_ {};
+    ParameterIntentBus parameterIntentBus_;
 
     std::atomic<float> m_currentInputHeadroomDb { -6.0f };
     std::atomic<float> m_currentOutputMakeupDb { 12.0f };
@@ -4308,6 +5107,10 @@ public:
     convo::isr::FailureHandler failureHandler_;
     convo::isr::IntrospectionConsole introspectionConsole_;
     convo::RuntimeHealthMonitor m_healthMonitor;  // ★ P1-8: Pull型監視エンジン
+    // ★ フライトレコーダー (%APPDATA%/ConvoPeq/flight_recorder.bin、前回分は flight_recorder.prev.bin)。
+    //   Telemetry / xrun incident / shutdown フェーズ / (診断ビルドでは) DiagEvent をクラッシュ後も残す。
+    //   作成に失敗したら nullptr のまま (記録なしで動く)。デストラクタの最後で外してから閉じる
+    std::unique_ptr<convo::FlightRecorder> flightRecorder_;
 
     std::array<std::atomic<std::uint64_t>, convo::kObserveChannelCount> observeLastSeenGeneration_ {};
     std::array<std::atomic<std::uint64_t>, convo::kObserveChannelCount> observeLastSeenSequenceId_ {};
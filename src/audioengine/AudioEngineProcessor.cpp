@@ -1,5 +1,6 @@
 //============================================================================
 #include "AudioEngineProcessor.h"
+#include "StartupProfiler.h"
 #include <cmath>
 
 AudioEngineProcessor::AudioEngineProcessor(AudioEngine& engineRef)
@@ -84,6 +85,7 @@ bool AudioEngineProcessor::isBusesLayoutSupported(const BusesLayout& layouts) co
 #ifndef CONVOPEQ_STANDALONE_ONLY
 void AudioEngineProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
+    convo::StartupProfiler::noteAudioCallback();
     juce::AudioSourceChannelInfo info(&buffer, 0, buffer.getNumSamples());
     audioEngine.getNextAudioBlock(info);
 }
@@ -99,6 +101,7 @@ void AudioEngineProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
 
 void AudioEngineProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
 {
+    convo::StartupProfiler::noteAudioCallback();
     audioEngine.processBlockDouble(buffer);
 }
 
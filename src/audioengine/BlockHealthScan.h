@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+//==============================================================================
+// BlockHealthScan — 出力段の健全性検査とメータ用ピークを 1 パスで求める融合カーネル
+//
+//   DSPCore は 1 コールバックの中で
+//     出力メータ (measureLevel: チャンネルごとの min/max 走査) → 出力段の NaN/Inf 除去 →
+//     (OS 時) 各 decimate ステージ出力の走査
+//   と、同じ信号を何度も読み直していた。ここでは 4 サンプル単位の AVX2 比較
+//   (|x| < bound の順序付き比較 1 回で NaN・Inf・発散をまとめて弾く) で不正サンプルを 0 に置き換えながら、
+//   置換後の |x| 最大 (ピーク) と不正サンプル数を同じレジスタ上で求める。
+//
+//   検査はチェーン出力の 1 箇所だけで行う。不正サンプルが見つかったときに「どの段の状態を戻すか」は
+//   呼び出し側 (DSPCore::recoverFromCorruptedOutput) が各段の既存の復旧経路へ振り分ける。
+//==============================================================================
+
+namespace convo::health {
+
+// 出力段の除去しきい値 (従来の NaN/Inf 除去と同じ)
+constexpr double kSampleBound = 1.0e300;
+
+struct BlockHealth
+{
+    double peak = 0.0;   // 置換・ゲイン適用後の |x| 最大 (L/R 通し)
+    int badSamples = 0;  // NaN / Inf / |x| >= bound だったサンプル数 (L/R 合計)
+
+    bool isCorrupted() const noexcept { return badSamples > 0; }
+};
+
+namespace detail {
+
+inline bool isHealthy(double x, double bound) noexcept
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    if (((bits >> 52) & 0x7FFu) == 0x7FFu)
+        return false;
+    bits &= 0x7FFFFFFFFFFFFFFFull;
+    double absValue = 0.0;
+    std::memcpy(&absValue, &bits, sizeof(absValue));
+    return absValue < bound;
+}
+
+inline double absValue(double x) noexcept
+{
+    return x < 0.0 ? -x : x;
+}
+
+template <bool ApplyGain>
+inline void scanChannel(double* data, int numSamples, double gain, double bound,
+                        double& peak, int& badSamples) noexcept
+{
+    const __m256d vGain = _mm256_set1_pd(gain);
+    const __m256d vBound = _mm256_set1_pd(bound);
+    const __m256d vSignMask = _mm256_set1_pd(-0.0);
+    __m256d vPeak = _mm256_setzero_pd();
+    // 不正レーンの比較結果 (全ビット 1 = -1) を引き算で数える
+    __m256i vBad = _mm256_setzero_si256();
+
+    int i = 0;
+    const int vEnd = numSamples / 4 * 4;
+    for (; i < vEnd; i += 4)
+    {
+        __m256d v = _mm256_loadu_pd(data + i);
+        if constexpr (ApplyGain)
+            v = _mm256_mul_pd(v, vGain);
+        // NaN の |x| も NaN なので、順序付き比較 (LT_OQ) が偽になり不正側へ落ちる
+        const __m256d absV = _mm256_andnot_pd(vSignMask, v);
+        const __m256d healthy = _mm256_cmp_pd(absV, vBound, _CMP_LT_OQ);
+        _mm256_storeu_pd(data + i, _mm256_and_pd(v, healthy));
+        vPeak = _mm256_max_pd(vPeak, _mm256_and_pd(absV, healthy));
+        vBad = _mm256_sub_epi64(vBad, _mm256_castpd_si256(_mm256_cmp_pd(absV, vBound, _CMP_NLT_UQ)));
+    }
+
+    alignas(32) double peakLanes[4];
+    alignas(32) std::int64_t badLanes[4];
+    _mm256_store_pd(peakLanes, vPeak);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(badLanes), vBad);
+    for (int lane = 0; lane < 4; ++lane)
+    {
+        if (peakLanes[lane] > peak)
+            peak = peakLanes[lane];
+        badSamples += static_cast<int>(badLanes[lane]);
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        double v = data[i];
+        if constexpr (ApplyGain)
+            v *= gain;
+        if (!isHealthy(v, bound))
+        {
+            v = 0.0;
+            ++badSamples;
+        }
+        data[i] = v;
+        const double a = absValue(v);
+        if (a > peak)
+            peak = a;
+    }
+}
+
+} // namespace detail
+
+// left / right (right == nullptr でモノラル) をその場で検査する。ApplyGain なら先に gain を掛け、
+// 掛けた後の値で判定・ピークを求める (従来の「ヘッドルーム → 除去」と同じ順)。
+template <bool ApplyGain>
+inline BlockHealth scanAndScrubStereo(double* left, double* right, int numSamples,
+                                      double gain = 1.0, double bound = kSampleBound) noexcept
+{
+    BlockHealth health;
+    if (numSamples <= 0)
+        return health;
+    if (left != nullptr)
+        detail::scanChannel<ApplyGain>(left, numSamples, gain, bound, health.peak, health.badSamples);
+    if (right != nullptr)
+        detail::scanChannel<ApplyGain>(right, numSamples, gain, bound, health.peak, health.badSamples);
+    return health;
+}
+
+} // namespace convo::health
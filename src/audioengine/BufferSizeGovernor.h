@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace convo {
+
+//==============================================================================
+// BufferSizeGovernor — 締め切り超過が続くときにデバイスのバッファ長を 1 段上げ、余裕が戻ったら下げる
+//
+//   MainWindow の timer (Message Thread) が CallbackTimingHistograms の差分 (overrun + 遅着) と
+//   callback 負荷を update() に渡し、0 以外が返ったらそのバッファ長でデバイスを開き直す
+//   (prepareToPlay → レイテンシ補償の通常経路)。
+//     - 上げ: kMissWindowMs 内に kMissesToStepUp 回以上の超過 → デバイスが受け付ける次の長さ
+//     - 下げ: 基準長より上にいて、最後の超過・変更から holdoff 経過し、その間の最大負荷を
+//             1 段下の長さへ換算しても kStepDownLoadPermille 以下 → 1 段下 (基準長より下へは行かない)
+//     - 下げた先でまた上げることになったら holdoff を倍にする (上げ下げの往復で音切れを繰り返さない)
+//   基準長はユーザーが選んだ長さ。変更直後 kSettleMs はデバイス再起動の乱れとして超過を数えない。
+//   JUCE 非依存。
+//==============================================================================
+
+class BufferSizeGovernor
+{
+public:
+    static constexpr int kMissesToStepUp = 3;
+    static constexpr double kMissWindowMs = 10'000.0;
+    static constexpr double kSettleMs = 3'000.0;
+    static constexpr double kHeadroomMs = 60'000.0;
+    static constexpr uint32_t kStepDownLoadPermille = 400;
+    static constexpr int kMaxBackoffShift = 3;         // holdoff は最大 8 倍 (8 分)
+
+    // ユーザーが選んだ長さを基準にして状態を初期化する
+    void setBaseSize(int size, double nowMs) noexcept
+    {
+        baseSize = size;
+        backoffShift = 0;
+        lastStepDownTarget = 0;
+        beginPeriod(nowMs);
+    }
+
+    // 新しいバッファ長を返す (0 = 現状維持)
+    [[nodiscard]] int update(double nowMs, int currentSize, const std::vector<int>& availableSizes,
+                             uint64_t newMisses, uint32_t loadPermille) noexcept
+    {
+        if (baseSize <= 0 || currentSize <= 0)
+            return 0;
+        if (nowMs < settleUntilMs)
+            return 0;
+
+        if (nowMs - missWindowStartMs > kMissWindowMs)
+        {
+            missWindowStartMs = nowMs;
+            missesInWindow = 0;
+        }
+        if (newMisses > 0)
+        {
+            missesInWindow += newMisses;
+            lastQuietStartMs = nowMs;
+        }
+        maxLoadPermille = std::max(maxLoadPermille, loadPermille);
+
+        if (missesInWindow >= static_cast<uint64_t>(kMissesToStepUp))
+        {
+            const int larger = nextLarger(availableSizes, currentSize);
+            if (larger == 0)
+                return 0;
+            if (currentSize == lastStepDownTarget)
+                backoffShift = std::min(backoffShift + 1, kMaxBackoffShift);
+            return larger;
+        }
+
+        const double holdoffMs = kHeadroomMs * static_cast<double>(1 << backoffShift);
+        if (currentSize > baseSize && nowMs - lastQuietStartMs >= holdoffMs)
+        {
+            const int smaller = nextSmaller(availableSizes, currentSize);
+            if (smaller < baseSize || smaller == 0)
+                return 0;
+            // 固定コストが支配的な最悪ケースとして、1 コールバックの処理時間は変わらず予算だけ縮むとみなす
+            const uint64_t predicted = static_cast<uint64_t>(maxLoadPermille) * static_cast<uint64_t>(currentSize)
+                                     / static_cast<uint64_t>(smaller);
+            if (predicted > kStepDownLoadPermille)
+                return 0;
+            lastStepDownTarget = smaller;
+            return smaller;
+        }
+        return 0;
+    }
+
+    // update() の返した長さ (または基準長への復帰) を適用した直後に呼ぶ
+    void notifyApplied(double nowMs) noexcept { beginPeriod(nowMs); }
+
+    [[nodiscard]] int getBaseSize() const noexcept { return baseSize; }
+    [[nodiscard]] int getBackoffShift() const noexcept { return backoffShift; }
+
+private:
+    void beginPeriod(double nowMs) noexcept
+    {
+        settleUntilMs = nowMs + kSettleMs;
+        missWindowStartMs = settleUntilMs;
+        missesInWindow = 0;
+        lastQuietStartMs = settleUntilMs;   // 余裕の holdoff は安定待ちの後から数える
+        maxLoadPermille = 0;
+    }
+
+    static int nextLarger(const std::vector<int>& sizes, int current) noexcept
+    {
+        int best = 0;
+        for (const int s : sizes)
+            if (s > current && (best == 0 || s < best))
+                best = s;
+        return best;
+    }
+
+    static int nextSmaller(const std::vector<int>& sizes, int current) noexcept
+    {
+        int best = 0;
+        for (const int s : sizes)
+            if (s < current && s > best)
+                best = s;
+        return best;
+    }
+
+    int baseSize = 0;
+    int backoffShift = 0;
+    int lastStepDownTarget = 0;
+    double settleUntilMs = 0.0;
+    double missWindowStartMs = 0.0;
+    double lastQuietStartMs = 0.0;
+    uint64_t missesInWindow = 0;
+    uint32_t maxLoadPermille = 0;
+};
+
+} // namespace convo
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AtomicAccess.h"
+#include "StageLatencyHistogram.h"
+#include "XrunIncidentCorrelator.h"
+
+//==============================================================================
+// CallbackTimingProfile — デバイスのコールバック到着ジッターと締め切りまでの余裕 (リリースビルドでも常時有効)
+//
+//   Audio Thread はコールバックの終わりに CallbackTimingHistograms::record() で
+//     - 到着ジッター |到着間隔 - 期待周期| (μs、StageLatencyHistograms と同じ対数バケット)
+//     - 負荷 = 処理時間 / 期待周期 (permille、10 permille 刻み。余裕 = 1000 - 負荷)
+//     - 超過 (処理時間 > 期待周期) と遅着 (XrunIncidentCorrelator と同じ閾値) の件数
+//   を数える。単一ライタで RMW なし。
+//
+//   Message Thread は collect() の差分を (デバイス種別, デバイス名, サンプルレート, バッファ長) ごとの
+//   CallbackTimingStats に積み (DeviceTimingProfiles が device_settings.xml の隣へ保存)、
+//   recommendBufferSize() が同じデバイス・サンプルレートの記録から
+//     verified  : kMinVerdictSeconds 以上回して安定だった最小のバッファ長
+//     suggested : verified の 1 段下の長さ。verified の実測から収まると予測でき、不安定と判定された長さより大きいときだけ
+//   を返す。診断ビルドの CallbackArrivalData / CallbackStageData は 1 コールバックずつの生記録。
+//==============================================================================
+
+namespace convo {
+
+class CallbackTimingHistograms
+{
+public:
+    static constexpr int kJitterBuckets = StageLatencyHistograms::kNumBuckets;
+    static constexpr uint32_t kLoadStepPermille = 10;
+    static constexpr int kLoadBuckets = 201;    // [0, 2000) permille を 10 刻み + それ以上
+
+    struct Snapshot
+    {
+        uint64_t callbacks = 0;
+        uint64_t overruns = 0;
+        uint64_t lateArrivals = 0;
+        std::array<uint64_t, kJitterBuckets> jitter {};    // 到着間隔の無い最初のコールバックは数えない
+        std::array<uint64_t, kLoadBuckets> load {};
+    };
+
+    [[nodiscard]] static constexpr int loadBucketFor(uint64_t permille) noexcept
+    {
+        return static_cast<int>(std::min<uint64_t>(permille / kLoadStepPermille, kLoadBuckets - 1));
+    }
+
+    // Audio Thread 専用 (単一ライタ)。expectedUs == 0 (未 prepare) なら何もしない
+    void record(uint64_t startUs, uint64_t endUs, uint64_t expectedUs) noexcept
+    {
+        const uint64_t intervalUs = (lastStartUs_ != 0 && startUs > lastStartUs_) ? startUs - lastStartUs_ : 0;
+        lastStartUs_ = startUs;
+        if (expectedUs == 0)
+            return;
+
+        const uint64_t callbackUs = endUs > startUs ? endUs - startUs : 0;
+        bump(callbacks_);
+        bump(load_[static_cast<size_t>(loadBucketFor(callbackUs * 1000 / expectedUs))]);
+        if (callbackUs > expectedUs)
+            bump(overruns_);
+        if (intervalUs != 0)
+        {
+            const uint64_t jitterUs = intervalUs > expectedUs ? intervalUs - expectedUs : expectedUs - intervalUs;
+            bump(jitter_[static_cast<size_t>(StageLatencyHistograms::bucketFor(jitterUs))]);
+            const uint64_t lateThresholdUs = std::max(expectedUs * XrunIncidentCorrelator::kLateRatioNum
+                                                          / XrunIncidentCorrelator::kLateRatioDen,
+                                                      XrunIncidentCorrelator::kLateMinimumUs);
+            if (intervalUs > lateThresholdUs)
+                bump(lateArrivals_);
+        }
+    }
+
+    // 前の設定の最後のコールバックからの間隔を数えない。Audio Thread が止まっている間 (prepareToPlay) のみ呼ぶ
+    void resetArrival() noexcept
+    {
+        lastStartUs_ = 0;
+    }
+
+    // Message Thread: 累積カウント (単調増加) を読む
+    void collect(Snapshot& out) const noexcept
+    {
+        // relaxed: 統計値のみ
+        out.callbacks = convo::consumeAtomic(callbacks_, std::memory_order_relaxed);
+        out.overruns = convo::consumeAtomic(overruns_, std::memory_order_relaxed);
+        out.lateArrivals = convo::consumeAtomic(lateArrivals_, std::memory_order_relaxed);
+        for (size_t b = 0; b < out.jitter.size(); ++b)
+            out.jitter[b] = convo::consumeAtomic(jitter_[b], std::memory_order_relaxed);
+        for (size_t b = 0; b < out.load.size(); ++b)
+            out.load[b] = convo::consumeAtomic(load_[b], std::memory_order_relaxed);
+    }
+
+private:
+    static void bump(std::atomic<uint64_t>& counter) noexcept
+    {
+        // relaxed: 書き込みはこのスレッドだけ。読み手は単調増加するカウンタの近似値を見ればよい
+        convo::publishAtomic(counter, convo::consumeAtomic(counter, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t lastStartUs_ = 0;   // Audio Thread 専用
+    std::atomic<uint64_t> callbacks_ { 0 };
+    std::atomic<uint64_t> overruns_ { 0 };
+    std::atomic<uint64_t> lateArrivals_ { 0 };
+    std::array<std::atomic<uint64_t>, kJitterBuckets> jitter_ {};
+    std::array<std::atomic<uint64_t>, kLoadBuckets> load_ {};
+};
+
+// 1 つの (デバイス, サンプルレート, バッファ長) に積んだ分布。Message Thread 専用
+struct CallbackTimingStats
+{
+    using Snapshot = CallbackTimingHistograms::Snapshot;
+
+    static constexpr double kMinVerdictSeconds = 60.0;          // これ未満は安定とも不安定とも言わない
+    static constexpr double kMaxIncidentsPerHour = 1.0;
+    static constexpr uint32_t kMaxStableLoadPermille = 800;     // p99.9 の負荷がこれ以下 (余裕 20% 以上)
+
+    Snapshot totals {};
+
+    // now - before を足す (collect() の累積値の差分)
+    void accumulate(const Snapshot& now, const Snapshot& before) noexcept
+    {
+        const auto delta = [](uint64_t a, uint64_t b) noexcept { return a >= b ? a - b : 0; };
+        totals.callbacks += delta(now.callbacks, before.callbacks);
+        totals.overruns += delta(now.overruns, before.overruns);
+        totals.lateArrivals += delta(now.lateArrivals, before.lateArrivals);
+        for (size_t b = 0; b < totals.jitter.size(); ++b)
+            totals.jitter[b] += delta(now.jitter[b], before.jitter[b]);
+        for (size_t b = 0; b < totals.load.size(); ++b)
+            totals.load[b] += delta(now.load[b], before.load[b]);
+    }
+
+    [[nodiscard]] double observedSeconds(int bufferSize, double sampleRate) const noexcept
+    {
+        return sampleRate > 0.0 ? static_cast<double>(totals.callbacks) * bufferSize / sampleRate : 0.0;
+    }
+
+    [[nodiscard]] double incidentsPerHour(int bufferSize, double sampleRate) const noexcept
+    {
+        const double seconds = observedSeconds(bufferSize, sampleRate);
+        return seconds > 0.0 ? static_cast<double>(totals.overruns + totals.lateArrivals) * 3600.0 / seconds : 0.0;
+    }
+
+    // バケット上限を返す (過大側に丸める)。記録が無ければ 0
+    [[nodiscard]] uint64_t jitterPercentileUs(uint64_t permyriad) const noexcept
+    {
+        const int bucket = percentileBucket(totals.jitter, permyriad);
+        return bucket < 0 ? 0 : StageLatencyHistograms::bucketUpperBound(bucket);
+    }
+
+    [[nodiscard]] uint32_t loadPercentilePermille(uint64_t permyriad) const noexcept
+    {
+        const int bucket = percentileBucket(totals.load, permyriad);
+        return bucket < 0 ? 0 : static_cast<uint32_t>(bucket + 1) * CallbackTimingHistograms::kLoadStepPermille;
+    }
+
+    // 締め切りまでの余裕の下位パーセンタイル (μs)。負 = 超過
+    [[nodiscard]] double slackPercentileUs(uint64_t lowerPermyriad, int bufferSize, double sampleRate) const noexcept
+    {
+        const double periodUs = sampleRate > 0.0 ? bufferSize * 1.0e6 / sampleRate : 0.0;
+        return periodUs * (1000.0 - loadPercentilePermille(10000 - lowerPermyriad)) / 1000.0;
+    }
+
+    enum class Verdict : uint8_t { Insufficient, Stable, Unstable };
+
+    [[nodiscard]] Verdict verdict(int bufferSize, double sampleRate) const noexcept
+    {
+        if (observedSeconds(bufferSize, sampleRate) < kMinVerdictSeconds)
+            return Verdict::Insufficient;
+        if (incidentsPerHour(bufferSize, sampleRate) > kMaxIncidentsPerHour)
+            return Verdict::Unstable;
+        // p99.9 の負荷が上限以下で、p99.9 のジッターがその余裕に収まること
+        const uint32_t loadP999 = loadPercentilePermille(9990);
+        const double periodUs = bufferSize * 1.0e6 / sampleRate;
+        const double slackUs = periodUs * (1000.0 - loadP999) / 1000.0;
+        if (loadP999 > kMaxStableLoadPermille || static_cast<double>(jitterPercentileUs(9990)) > slackUs)
+            return Verdict::Unstable;
+        return Verdict::Stable;
+    }
+
+private:
+    template <size_t N>
+    [[nodiscard]] static int percentileBucket(const std::array<uint64_t, N>& counts, uint64_t permyriad) noexcept
+    {
+        uint64_t total = 0;
+        for (uint64_t c : counts)
+            total += c;
+        if (total == 0)
+            return -1;
+        // rank = ceil(total * q)
+        const uint64_t rank = std::max<uint64_t>(1, (total * permyriad + 9999) / 10000);
+        uint64_t seen = 0;
+        for (size_t b = 0; b < N; ++b)
+        {
+            seen += counts[b];
+            if (seen >= rank)
+                return static_cast<int>(b);
+        }
+        return static_cast<int>(N) - 1;
+    }
+};
+
+[[nodiscard]] constexpr const char* callbackTimingVerdictName(CallbackTimingStats::Verdict verdict) noexcept
+{
+    switch (verdict)
+    {
+        case CallbackTimingStats::Verdict::Stable:   return "stable";
+        case CallbackTimingStats::Verdict::Unstable: return "unstable";
+        default:                                     return "measuring";
+    }
+}
+
+struct BufferSizeObservation
+{
+    int bufferSize = 0;
+    const CallbackTimingStats* stats = nullptr;
+};
+
+struct BufferSizeRecommendation
+{
+    int verifiedSamples = 0;     // 0 = まだ無い
+    int suggestedSamples = 0;    // 0 = 提案なし (1 段下が無い・予測で収まらない・既に不安定と判定済み)
+};
+
+// 同じデバイス・サンプルレートの記録と、デバイスが受け付けるバッファ長から推奨値を出す
+[[nodiscard]] inline BufferSizeRecommendation recommendBufferSize(const std::vector<BufferSizeObservation>& observations,
+                                                                  double sampleRate,
+                                                                  const std::vector<int>& availableSizes)
+{
+    BufferSizeRecommendation out;
+    if (sampleRate <= 0.0)
+        return out;
+
+    const CallbackTimingStats* verifiedStats = nullptr;
+    int largestUnstable = 0;
+    for (const auto& o : observations)
+    {
+        if (o.stats == nullptr || o.bufferSize <= 0)
+            continue;
+        const auto v = o.stats->verdict(o.bufferSize, sampleRate);
+        if (v == CallbackTimingStats::Verdict::Stable && (out.verifiedSamples == 0 || o.bufferSize < out.verifiedSamples))
+        {
+            out.verifiedSamples = o.bufferSize;
+            verifiedStats = o.stats;
+        }
+        else if (v == CallbackTimingStats::Verdict::Unstable)
+        {
+            largestUnstable = std::max(largestUnstable, o.bufferSize);
+        }
+    }
+    if (verifiedStats == nullptr)
+        return out;
+
+    // 処理時間の半分はバッファ長に比例し、半分はコールバックごとの固定分とみなす (小さい側へは控えめに外挿)。
+    // ジッターは絶対時間のまま持ち越す
+    const double baseSamples = out.verifiedSamples;
+    const double baseCallbackUs = verifiedStats->loadPercentilePermille(9990) / 1000.0 * baseSamples * 1.0e6 / sampleRate;
+    const double jitterUs = static_cast<double>(verifiedStats->jitterPercentileUs(9990));
+
+    // 外挿は 1 段だけ (その長さで実際に回した結果で次の段を決める)
+    int nextSmaller = 0;
+    for (const int size : availableSizes)
+        if (size < out.verifiedSamples && size > nextSmaller)
+            nextSmaller = size;
+    if (nextSmaller <= largestUnstable)
+        return out;
+
+    const double periodUs = nextSmaller * 1.0e6 / sampleRate;
+    const double callbackUs = baseCallbackUs * (0.5 + 0.5 * nextSmaller / baseSamples);
+    if (callbackUs <= periodUs * CallbackTimingStats::kMaxStableLoadPermille / 1000.0
+        && callbackUs + jitterUs <= periodUs)
+        out.suggestedSamples = nextSmaller;
+    return out;
+}
+
+} // namespace convo
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <immintrin.h>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+//==============================================================================
+// ChainSilenceTracker — DSPCore::processDouble の段ごとの無音スキップ判定
+//
+//   常時稼働の設置では 1 日の大半がデジタル無音になる。オーバーサンプラ・OS 域 DC ブロッカ・
+//   OutputFilter・SoftClip は無音でも毎ブロック全量を回していたため、段ごとに
+//     「入力ブロックが無音」かつ「直前まで ring-out 以上の無音を入力され続けた (= 内部状態も無音)」
+//   を満たしたときだけ処理を飛ばし、出力をゼロで埋める。
+//
+//   ring-out は各段が prepare 時に申告する「インパルス応答が 1.0 から kSilenceFloor 未満へ
+//   減衰するまでのサンプル数」。FIR は履歴長そのもの、再帰型は極半径から
+//   ringOutSamplesForPoleRadius() で求める。スキップに入る最初のブロック (GateAction::EnterSkip)
+//   で呼び出し側が段の状態をクリアし、再開時はゼロ状態から始める (残っていたのは floor 未満の残差)。
+//
+//   無音の閾値は CustomInputOversampler のデシメータ無音判定と同じ kDenormThresholdAudioState
+//   (1e-20, -400 dBFS)。NaN は無音扱いしない。
+//
+//   Convolver (MKLNonUniformConvolver が無音パーティションの FFT / MAC を自前で省く) と
+//   EQ (パラメータ平滑化・バイパス遷移が時間で進む) は対象外で、常に処理する。
+//   出力段 (ディザ・ノイズシェーパー・リミッタ・メータ) も従来どおり毎ブロック回す。
+//
+//   configure() / ringOutSamplesForPoleRadius() は Message Thread (prepare) 用。
+//   advance() / isSilentBlock() は Audio Thread 用 (libm なし・確保なし)。JUCE 非依存。
+//==============================================================================
+
+namespace convo {
+
+// CustomInputOversampler のデシメータ無音判定 / numeric_policy::kDenormThresholdAudioState と同値
+inline constexpr double kSilenceFloor = 1.0e-20;
+
+// ring-out が定義できない段 (極が単位円上・未準備) はスキップしない
+inline constexpr int kSilenceRingOutNever = std::numeric_limits<int>::max();
+
+// 極半径 radius の再帰が 1.0 から floor 未満へ減衰するまでのサンプル数 + firLength。
+// 縦続・重根による n·r^n の立ち上がりと低域共振の 1/sinθ 倍率の分として、対数減衰量を 2 倍にとる。
+// Message Thread 用 (std::log 使用)
+inline int ringOutSamplesForPoleRadius(double radius, int firLength = 0, double floor = kSilenceFloor) noexcept
+{
+    if (!(radius >= 0.0) || radius >= 1.0 || !(floor > 0.0) || firLength < 0)
+        return kSilenceRingOutNever;
+    if (radius == 0.0)
+        return firLength;
+    const double samples = 2.0 * std::log(floor) / std::log(radius);
+    if (!(samples < static_cast<double>(kSilenceRingOutNever - firLength - 1)))
+        return kSilenceRingOutNever;
+    return static_cast<int>(std::ceil(samples)) + firLength;
+}
+
+// 正規化済み Biquad (1 + a1·z⁻¹ + a2·z⁻²) の極半径の最大値。Message Thread 用 (std::sqrt 使用)
+inline double biquadPoleRadius(double a1, double a2) noexcept
+{
+    const double disc = a1 * a1 - 4.0 * a2;
+    if (disc < 0.0)
+        return std::sqrt(a2);
+    const double root = std::sqrt(disc);
+    return std::fmax(std::fabs(-a1 + root), std::fabs(-a1 - root)) * 0.5;
+}
+
+// |x| <= kSilenceFloor のみのブロックか (NaN は非無音)。channelR == nullptr でモノラル
+inline bool isSilentBlock(const double* channelL, const double* channelR, int numSamples) noexcept
+{
+    const __m256d vAbsMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+    const __m256d vFloor = _mm256_set1_pd(kSilenceFloor);
+    const double* const channels[2] = { channelL, channelR };
+    for (const double* data : channels)
+    {
+        if (data == nullptr)
+            continue;
+        int i = 0;
+        const int vEnd = numSamples / 4 * 4;
+        for (; i < vEnd; i += 4)
+        {
+            // !(|x| <= floor): NaN もここで立つ
+            const __m256d loud = _mm256_cmp_pd(_mm256_and_pd(_mm256_loadu_pd(data + i), vAbsMask), vFloor, _CMP_NLE_UQ);
+            if (_mm256_movemask_pd(loud) != 0)
+                return false;
+        }
+        // 端数は |x| のビット列を整数比較 (非負 double の順序と一致し、NaN は floor より大きい。/fp:fast でも崩れない)
+        for (; i < numSamples; ++i)
+            if ((std::bit_cast<std::uint64_t>(data[i]) & 0x7FFFFFFFFFFFFFFFull) > std::bit_cast<std::uint64_t>(kSilenceFloor))
+                return false;
+    }
+    return true;
+}
+
+class ChainSilenceTracker
+{
+public:
+    // processDouble の処理順
+    enum class Stage : int
+    {
+        OversampleUp = 0,   // CustomInputOversampler::processUp (base rate で数える)
+        OversampledDcBlock, // OS 域 UltraHighRateDCBlocker (processing rate)
+        OutputFilter,       // OutputFilter (processing rate)
+        SoftClip,           // SoftClip (+ OS = 1 のときの局所 2 倍 OS) (processing rate)
+        OversampleDown,     // CustomInputOversampler::processDown (base rate で数える)
+        Count
+    };
+
+    enum class GateAction
+    {
+        Process,   // 通常どおり処理する
+        EnterSkip, // 今回からスキップ: 段の状態をクリアし、出力をゼロにする
+        Skip       // スキップ継続: 出力をゼロにする
+    };
+
+    static constexpr int kNumStages = static_cast<int>(Stage::Count);
+
+    // ring-out (Stage ごとの単位のサンプル数) を設定し、無音カウントを初期化する
+    void configure(Stage stage, int ringOutSamples) noexcept
+    {
+        Gate& gate = gates[index(stage)];
+        gate.ringOutSamples = (ringOutSamples < 0) ? kSilenceRingOutNever : ringOutSamples;
+        gate.silentRun = 0;
+        gate.skipping = false;
+    }
+
+    void reset() noexcept
+    {
+        for (Gate& gate : gates)
+        {
+            gate.silentRun = 0;
+            gate.skipping = false;
+        }
+    }
+
+    // このブロックの入力が無音か (inputSilent) を渡し、段を処理するかを返す。
+    // スキップは「このブロックより前に ring-out 以上の無音が続いていた」場合だけ
+    GateAction advance(Stage stage, bool inputSilent, int numSamples) noexcept
+    {
+        Gate& gate = gates[index(stage)];
+        if (!inputSilent || numSamples <= 0)
+        {
+            if (!inputSilent)
+            {
+                gate.silentRun = 0;
+                gate.skipping = false;
+            }
+            return GateAction::Process;
+        }
+
+        const bool stateSilent = gate.ringOutSamples != kSilenceRingOutNever
+                              && gate.silentRun >= static_cast<std::int64_t>(gate.ringOutSamples);
+        if (gate.silentRun < kMaxSilentRun)
+            gate.silentRun += numSamples;
+        if (!stateSilent)
+            return GateAction::Process;
+
+        ++gate.skippedBlocks;
+        if (gate.skipping)
+            return GateAction::Skip;
+        gate.skipping = true;
+        return GateAction::EnterSkip;
+    }
+
+    bool isSkipping(Stage stage) const noexcept { return gates[index(stage)].skipping; }
+    int getRingOutSamples(Stage stage) const noexcept { return gates[index(stage)].ringOutSamples; }
+    std::uint64_t getSkippedBlocks(Stage stage) const noexcept { return gates[index(stage)].skippedBlocks; }
+
+private:
+    static constexpr std::int64_t kMaxSilentRun = std::numeric_limits<std::int64_t>::max() / 2;
+
+    struct Gate
+    {
+        int ringOutSamples = kSilenceRingOutNever;
+        std::int64_t silentRun = 0;
+        bool skipping = false;
+        std::uint64_t skippedBlocks = 0; // 診断用 (Audio Thread 専用カウンタ)
+    };
+
+    static constexpr int index(Stage stage) noexcept { return static_cast<int>(stage); }
+
+    Gate gates[kNumStages];
+};
+
+} // namespace convo
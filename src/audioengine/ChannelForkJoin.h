@@ -0,0 +1,218 @@
+#pragma once
+
+#include <immintrin.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "AtomicAccess.h"
+
+//==============================================================================
+// ChannelForkJoin — 1 コールバック内で片チャンネルの処理を相方スレッドへ fork / join する
+//
+//   DSPCore::processDouble はオーバーサンプラ・Convolver を L → R の順に直列で回す。
+//   両チャンネルの状態は独立しているため、R を相方 (helper) スレッドへ渡して L と同時に
+//   回せば、192 kHz・長い IR のように重い構成でクリティカルパスがほぼ半分になる。
+//   リミッタ等のリンク段の前で必ず join するため、遅延は増えない (PipelinedStage との違い)。
+//
+//   受け渡し (lock-free・1 ジョブ):
+//     - state を Idle → Posted (fork) → Running (helper) → Done → Idle (join) と進める。
+//       ジョブの関数ポインタと context は Posted の CAS (release) で公開する。
+//     - join 時点で helper がまだ取っていなければ (Posted のまま)、呼び出し側が CAS で
+//       取り戻して自分で実行する。helper が眠っている・同じコアで待たされている場合でも
+//       待ち時間は発生せず、結果は常に同じ (どちらのスレッドで回っても同じ処理)。
+//     - 停止中 (Stopped) の fork は受け付けず、join が呼び出し側で実行する。
+//
+//   helper はジョブ完了後 spinWindow の間 _mm_pause で次のジョブを待ち (起床遅延を避ける)、
+//   それを過ぎたら atomic::wait で眠る。spinWindow はデバイスのブロック周期より長くとり、
+//   再生中は眠らせない。
+//
+//   start() / stop() は Message Thread (rebuild thread) 用。
+//   fork() / join() は Audio Thread 用 (確保なし・ロックなし)。JUCE 非依存。
+//==============================================================================
+
+namespace convo {
+
+class ChannelForkJoin
+{
+public:
+    using JobFn = void (*)(void* context) noexcept;
+    using ThreadHookFn = void (*)(void* context) noexcept;
+
+    struct ThreadHooks
+    {
+        ThreadHookFn onThreadStart = nullptr; // helper 先頭で 1 回 (affinity・MMCSS 登録など)。nullptr 可
+        ThreadHookFn onThreadExit = nullptr;  // helper 終了直前に 1 回 (MMCSS 解除など)。nullptr 可
+        void* context = nullptr;
+    };
+
+    ChannelForkJoin() = default;
+    ~ChannelForkJoin() { stop(); }
+
+    ChannelForkJoin(const ChannelForkJoin&) = delete;
+    ChannelForkJoin& operator=(const ChannelForkJoin&) = delete;
+
+    // helper を起動する。spinWindowSeconds = ジョブ完了後に眠らず待つ時間
+    bool start(const ThreadHooks& newHooks, double spinWindowSeconds) noexcept
+    {
+        stop();
+        if (!(spinWindowSeconds >= 0.0))
+            return false;
+
+        hooks = newHooks;
+        spinWindow = std::chrono::nanoseconds(static_cast<std::int64_t>(spinWindowSeconds * 1.0e9));
+        // 起動直後から fork を受け付ける (helper が走り出す前のジョブは join が取り戻す)
+        convo::publishAtomic(state, kIdle, std::memory_order_relaxed); // relaxed: スレッド生成が HB を提供
+
+        try
+        {
+            helper = std::thread([this]() { helperLoop(); });
+        }
+        catch (...)
+        {
+            convo::publishAtomic(state, kStopped, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    void stop() noexcept
+    {
+        if (!helper.joinable())
+            return;
+
+        // Idle のときだけ Stopped にできる (fork 済みのジョブは helper か join が必ず実行する)
+        for (;;)
+        {
+            std::uint32_t expected = kIdle;
+            if (convo::compareExchangeAtomic(state, expected, kStopped)) // acq_rel: fork の CAS と排他
+                break;
+            std::this_thread::yield();
+        }
+        state.notify_one();
+        helper.join();
+    }
+
+    // helper が稼働中か (停止中の fork は join で呼び出し側が実行する)
+    bool isRunning() const noexcept
+    {
+        return convo::consumeAtomic(state, std::memory_order_acquire) != kStopped;
+    }
+
+    // job(context) を helper へ渡す。必ず同じスレッドで join() と対にする
+    void fork(JobFn job, void* context) noexcept
+    {
+        pendingJob = job;
+        pendingContext = context;
+        std::uint32_t expected = kIdle;
+        // seq_cst: helperSleeping の読み出しと helperLoop の (sleeping 書き込み → state 読み出し) を全順序に載せ、起床漏れを防ぐ
+        forked = convo::compareExchangeAtomic(state, expected, kPosted, std::memory_order_seq_cst, std::memory_order_acquire);
+        if (forked && convo::consumeAtomic(helperSleeping, std::memory_order_seq_cst))
+            state.notify_one(); // 待機スレッドの起床のみ (Windows: WakeByAddressSingle) でブロックしない
+    }
+
+    // fork したジョブの完了を待つ。helper が取る前なら呼び出し側で実行する
+    void join() noexcept
+    {
+        if (!forked)
+        {
+            ++inlineJobs;
+            pendingJob(pendingContext);
+            return;
+        }
+        forked = false;
+
+        std::uint32_t expected = kPosted;
+        if (convo::compareExchangeAtomic(state, expected, kIdle)) // acq_rel: helper の Posted → Running CAS と排他
+        {
+            ++inlineJobs;
+            pendingJob(pendingContext);
+            return;
+        }
+
+        for (int spin = 0; convo::consumeAtomic(state, std::memory_order_acquire) != kDone; ++spin) // acquire: helper の出力書き込みと HB
+        {
+            if (spin < kSpinsBeforeYield)
+                _mm_pause();
+            else
+                std::this_thread::yield(); // helper と同じ論理コアに載っている場合に備えて CPU を譲る
+        }
+        convo::publishAtomic(state, kIdle, std::memory_order_release); // release: helper の次の Posted 観測と HB
+        ++helperJobs;
+    }
+
+    // 診断用 (Audio Thread 専用カウンタ)
+    std::uint64_t getHelperJobs() const noexcept { return helperJobs; }
+    std::uint64_t getInlineJobs() const noexcept { return inlineJobs; }
+
+private:
+    static constexpr std::uint32_t kStopped = 0;
+    static constexpr std::uint32_t kIdle = 1;
+    static constexpr std::uint32_t kPosted = 2;
+    static constexpr std::uint32_t kRunning = 3;
+    static constexpr std::uint32_t kDone = 4;
+    static constexpr int kSpinsBeforeYield = 4096;
+    static constexpr std::uint32_t kSpinsPerClockRead = 64;
+
+    void helperLoop() noexcept
+    {
+        if (hooks.onThreadStart != nullptr)
+            hooks.onThreadStart(hooks.context);
+
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+
+        auto spinUntil = std::chrono::steady_clock::now() + spinWindow;
+        for (std::uint32_t spin = 0;; ++spin)
+        {
+            const std::uint32_t current = convo::consumeAtomic(state, std::memory_order_acquire);
+            if (current == kStopped)
+                break;
+
+            if (current == kPosted)
+            {
+                std::uint32_t posted = kPosted;
+                if (convo::compareExchangeAtomic(state, posted, kRunning)) // acq_rel: fork の release と HB (pendingJob 読み出し)
+                {
+                    pendingJob(pendingContext);
+                    convo::publishAtomic(state, kDone, std::memory_order_release); // release: join の acquire と HB
+                    spinUntil = std::chrono::steady_clock::now() + spinWindow;
+                }
+                continue;
+            }
+
+            _mm_pause();
+            if (spin % kSpinsPerClockRead != 0 || std::chrono::steady_clock::now() < spinUntil)
+                continue;
+
+            // spinWindow を過ぎた: Idle のまま次の fork まで眠る
+            convo::publishAtomic(helperSleeping, true, std::memory_order_seq_cst); // seq_cst: fork の state CAS と全順序
+            if (convo::consumeAtomic(state, std::memory_order_seq_cst) == kIdle)
+                state.wait(kIdle, std::memory_order_acquire);
+            convo::publishAtomic(helperSleeping, false, std::memory_order_relaxed); // relaxed: 起床後の余分な notify は無害
+            spinUntil = std::chrono::steady_clock::now() + spinWindow;
+        }
+
+        if (hooks.onThreadExit != nullptr)
+            hooks.onThreadExit(hooks.context);
+    }
+
+    ThreadHooks hooks;
+    std::chrono::nanoseconds spinWindow { 0 };
+
+    // Audio Thread が書き、Posted の CAS (release) で helper へ公開する
+    JobFn pendingJob = nullptr;
+    void* pendingContext = nullptr;
+
+    // Audio Thread 専用
+    bool forked = false;
+    std::uint64_t helperJobs = 0;
+    std::uint64_t inlineJobs = 0;
+
+    std::thread helper;
+    alignas(64) std::atomic<std::uint32_t> state { kStopped };
+    alignas(64) std::atomic<bool> helperSleeping { false };
+};
+
+} // namespace convo
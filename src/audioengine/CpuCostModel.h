@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace convo {
+
+//==============================================================================
+// ★ CpuCostModel — 構成を適用する前に callback 負荷を見積もる
+//
+//   CpuCostCalibration (src/CpuCostCalibration.h) が初回起動時に各 DSP 段を単体で回して
+//   CpuCostCoefficients を実測し、ここで構成 (CpuCostConfig) と掛け合わせて
+//   1 callback の処理時間と budget (ブロック周期) 比を出す。
+//
+//   モデル (すべてステレオ、ns/sample は各段が実際に処理するレートのサンプル当たり):
+//     Convolver    : nucNsPerSample(IR 長) × nucBlockScale(処理ブロック長) × 処理レートのサンプル数
+//                    × NUC 本数 (2、True Stereo は交差分を足して 4)
+//     EQ           : (eqBase + eqBand × 有効バンド数) × EQ を回すレートのサンプル数
+//     Oversampling : 倍率・プリセット別の up + down 往復 × ベースレートのサンプル数
+//     Output       : 出力フィルタ + ディザ × ベースレートのサンプル数
+//   計測は単体・キャッシュが温まった状態なので、メータ・リミッタ・DC blocker 等の未計測分と
+//   実 callback でのキャッシュ競合を kCallbackOverheadFactor でまとめて上乗せする。
+//
+//   位相モード (As-Is / Mixed / Minimum) は IR のロード時変換だけを変え、処理時の費用は
+//   IR 長で決まるため入力に含めない。
+//
+//   JUCE / MKL 非依存 (テストから直接使う)。
+//==============================================================================
+
+enum class CpuCostOversamplingPreset : uint8_t { IIRLike, LinearPhase, MinimumPhase, Count };
+
+struct CpuCostCoefficients
+{
+    // NUC: IR 長 2^12, 2^14, ..., 2^20 を基準ブロック長 (256) で計測
+    static constexpr int kNumIrPoints = 5;
+    static constexpr int kIrLog2Min = 12;
+    static constexpr int kIrLog2Step = 2;
+    // NUC ブロック長補正: 64, 256, 1024, 4096 (基準 256 = 1.0)
+    static constexpr int kNumBlockPoints = 4;
+    static constexpr int kBlockLog2Min = 6;
+    static constexpr int kBlockLog2Step = 2;
+    static constexpr int kReferenceBlockSize = 256;
+    static constexpr int kReferenceIrLength = 1 << 16;  // ブロック長補正を測る IR 長
+    // オーバーサンプリング倍率 2, 4, 8
+    static constexpr int kNumOversamplingRatios = 3;
+
+    std::array<double, kNumIrPoints> nucNsPerSample {};       ///< モノラル NUC 1 本、処理レートのサンプル当たり
+    std::array<double, kNumBlockPoints> nucBlockScale { 1.0, 1.0, 1.0, 1.0 };
+    double eqBaseNsPerSample = 0.0;                           ///< 全バンド無効 (ステレオ)
+    double eqBandNsPerSample = 0.0;                           ///< 有効バンド 1 本当たりの追加分 (ステレオ)
+    std::array<std::array<double, kNumOversamplingRatios>, static_cast<size_t>(CpuCostOversamplingPreset::Count)>
+        oversamplingNsPerSample {};                           ///< up + down (ステレオ)、ベースレートのサンプル当たり
+    double outputNsPerSample = 0.0;                           ///< 出力フィルタ + ディザ (ステレオ)
+    bool valid = false;
+
+    [[nodiscard]] static int oversamplingRatioIndex(int factor) noexcept
+    {
+        return factor >= 8 ? 2 : (factor >= 4 ? 1 : 0);
+    }
+};
+
+struct CpuCostConfig
+{
+    double sampleRate = 48000.0;   ///< デバイス (ベース) レート
+    int blockSize = 512;           ///< デバイス callback のサンプル数
+    int oversamplingFactor = 1;    ///< 解決済みの倍率 (1 / 2 / 4 / 8)
+    CpuCostOversamplingPreset oversamplingPreset = CpuCostOversamplingPreset::IIRLike;
+    bool convolverActive = true;   ///< IR ロード済みかつバイパスでない
+    int irLength = 0;              ///< 処理レートでの IR 長 (サンプル)
+    bool trueStereo = false;
+    bool eqActive = true;          ///< バイパスでなく、IR へ焼き込まれてもいない
+    int eqActiveBands = 0;
+    bool eqAtBaseRate = false;     ///< Split-rate EQ (processUp 前のベースレートで回す)
+};
+
+struct CpuCostPrediction
+{
+    enum class Verdict : uint8_t
+    {
+        Unknown,   ///< 係数が未計測
+        Ok,
+        Warning,   ///< kWarningLoad 以上: 遷移中のクロスフェードや OS の揺らぎで溢れうる
+        Overload   ///< kOverloadLoad 以上: 定常でも xrun が見込まれる
+    };
+
+    double convolverUs = 0.0;
+    double eqUs = 0.0;
+    double oversamplingUs = 0.0;
+    double outputUs = 0.0;
+    double totalUs = 0.0;
+    double periodUs = 0.0;
+    double load = 0.0;             ///< totalUs / periodUs
+    Verdict verdict = Verdict::Unknown;
+
+    [[nodiscard]] uint16_t loadPermille() const noexcept
+    {
+        return static_cast<uint16_t>(std::clamp(load * 1000.0, 0.0, 65535.0));
+    }
+};
+
+inline constexpr double kCpuCostWarningLoad = 0.7;
+inline constexpr double kCpuCostOverloadLoad = 0.9;
+inline constexpr double kCallbackOverheadFactor = 1.2;
+
+[[nodiscard]] inline const char* cpuCostVerdictName(CpuCostPrediction::Verdict verdict) noexcept
+{
+    switch (verdict)
+    {
+        case CpuCostPrediction::Verdict::Ok:       return "ok";
+        case CpuCostPrediction::Verdict::Warning:  return "warning";
+        case CpuCostPrediction::Verdict::Overload: return "overload";
+        case CpuCostPrediction::Verdict::Unknown:  break;
+    }
+    return "unknown";
+}
+
+namespace cpu_cost_detail {
+
+// 2 を底とする対数軸上の等間隔点 (log2Min, log2Min + step, ...) を線形補間する。
+// 範囲外は端の区間の傾きで外挿し (extrapolate = true)、または端の値に留める
+template <size_t N>
+[[nodiscard]] inline double interpolateLog2(const std::array<double, N>& points, int log2Min, int log2Step,
+                                            double x, bool extrapolate) noexcept
+{
+    static_assert(N >= 2);
+    const double pos = (std::log2(std::max(x, 1.0)) - static_cast<double>(log2Min)) / static_cast<double>(log2Step);
+    if (!extrapolate && pos <= 0.0)
+        return points.front();
+    if (!extrapolate && pos >= static_cast<double>(N - 1))
+        return points.back();
+    const size_t segment = static_cast<size_t>(std::clamp(std::floor(pos), 0.0, static_cast<double>(N - 2)));
+    const double t = pos - static_cast<double>(segment);
+    const double value = points[segment] + (points[segment + 1] - points[segment]) * t;
+    return std::max(value, 0.0);
+}
+
+} // namespace cpu_cost_detail
+
+[[nodiscard]] inline CpuCostPrediction predictCallbackCost(const CpuCostCoefficients& coeffs,
+                                                          const CpuCostConfig& config) noexcept
+{
+    CpuCostPrediction p;
+    if (config.sampleRate <= 0.0 || config.blockSize <= 0)
+        return p;
+
+    const int osFactor = std::max(1, config.oversamplingFactor);
+    const double baseSamples = static_cast<double>(config.blockSize);
+    const double processingSamples = baseSamples * static_cast<double>(osFactor);
+    p.periodUs = 1.0e6 * baseSamples / config.sampleRate;
+    if (!coeffs.valid)
+        return p;
+
+    constexpr double kNsToUs = 1.0e-3;
+
+    if (config.convolverActive && config.irLength > 0)
+    {
+        // IR 長は上側へ外挿する (2^20 を超える IR は tail パーティションが増える分だけ伸びる)
+        const double perSample = cpu_cost_detail::interpolateLog2(coeffs.nucNsPerSample, CpuCostCoefficients::kIrLog2Min,
+                                                                  CpuCostCoefficients::kIrLog2Step,
+                                                                  static_cast<double>(config.irLength), true);
+        const double blockScale = cpu_cost_detail::interpolateLog2(coeffs.nucBlockScale, CpuCostCoefficients::kBlockLog2Min,
+                                                                   CpuCostCoefficients::kBlockLog2Step,
+                                                                   processingSamples, false);
+        const double numConvolvers = config.trueStereo ? 4.0 : 2.0;
+        p.convolverUs = perSample * blockScale * processingSamples * numConvolvers * kNsToUs;
+    }
+
+    if (config.eqActive)
+    {
+        const double eqSamples = config.eqAtBaseRate ? baseSamples : processingSamples;
+        const double perSample = coeffs.eqBaseNsPerSample
+                               + coeffs.eqBandNsPerSample * static_cast<double>(std::max(0, config.eqActiveBands));
+        p.eqUs = perSample * eqSamples * kNsToUs;
+    }
+
+    if (osFactor > 1)
+    {
+        const auto preset = static_cast<size_t>(std::min(config.oversamplingPreset, CpuCostOversamplingPreset::MinimumPhase));
+        const auto ratio = static_cast<size_t>(CpuCostCoefficients::oversamplingRatioIndex(osFactor));
+        p.oversamplingUs = coeffs.oversamplingNsPerSample[preset][ratio] * baseSamples * kNsToUs;
+    }
+
+    p.outputUs = coeffs.outputNsPerSample * baseSamples * kNsToUs;
+
+    p.totalUs = (p.convolverUs + p.eqUs + p.oversamplingUs + p.outputUs) * kCallbackOverheadFactor;
+    p.load = p.totalUs / p.periodUs;
+    p.verdict = p.load >= kCpuCostOverloadLoad ? CpuCostPrediction::Verdict::Overload
+              : p.load >= kCpuCostWarningLoad  ? CpuCostPrediction::Verdict::Warning
+                                               : CpuCostPrediction::Verdict::Ok;
+    return p;
+}
+
+//==============================================================================
+// ★ suggestCpuCostDowngrade — 負荷が kCpuCostWarningLoad 未満に収まる軽い構成を探す
+//
+//   音質への影響が小さい順に 1 段ずつ下げる: オーバーサンプリング倍率を半分 (1x まで) →
+//   バッファ長を倍 (kMaxSuggestedBlockSize まで、レイテンシと引き換え) → IR 長を半分 (kMinSuggestedIrLength まで)。
+//   どこまで下げても収まらなければ achievable = false で最も軽い構成を返す。
+//==============================================================================
+struct CpuCostSuggestion
+{
+    bool needed = false;       ///< 元の構成が Warning 以上
+    bool achievable = false;   ///< 提案構成が Ok に収まる
+    CpuCostConfig config {};
+    CpuCostPrediction prediction {};
+};
+
+inline constexpr int kMaxSuggestedBlockSize = 4096;
+inline constexpr int kMinSuggestedIrLength = 1 << 14;
+
+[[nodiscard]] inline CpuCostSuggestion suggestCpuCostDowngrade(const CpuCostCoefficients& coeffs,
+                                                               const CpuCostConfig& config) noexcept
+{
+    CpuCostSuggestion s;
+    s.config = config;
+    s.prediction = predictCallbackCost(coeffs, config);
+    if (s.prediction.verdict == CpuCostPrediction::Verdict::Unknown)
+        return s;
+    if (s.prediction.verdict == CpuCostPrediction::Verdict::Ok)
+    {
+        s.achievable = true;
+        return s;
+    }
+    s.needed = true;
+
+    const auto fits = [&] { return s.prediction.verdict == CpuCostPrediction::Verdict::Ok; };
+    const auto step = [&](auto&& mutate)
+    {
+        while (!fits() && mutate(s.config))
+            s.prediction = predictCallbackCost(coeffs, s.config);
+    };
+
+    step([](CpuCostConfig& c)
+    {
+        if (c.oversamplingFactor <= 1)
+            return false;
+        c.oversamplingFactor /= 2;
+        // 処理レートが下がるので同じ秒数の IR は短くなる
+        c.irLength = std::max(1, c.irLength / 2);
+        return true;
+    });
+    step([](CpuCostConfig& c)
+    {
+        if (c.blockSize * 2 > kMaxSuggestedBlockSize)
+            return false;
+        c.blockSize *= 2;
+        return true;
+    });
+    step([](CpuCostConfig& c)
+    {
+        if (!c.convolverActive || c.irLength / 2 < kMinSuggestedIrLength)
+            return false;
+        c.irLength /= 2;
+        return true;
+    });
+
+    s.achievable = fits();
+    return s;
+}
+
+} // namespace convo
@@ -35,6 +35,9 @@ CrossfadeAuthority::Decision CrossfadeAuthority::evaluate(
                 if (clamped > 0.010) clamped = 0.010;
                 ctx.fadeTimeSec = std::max(ctx.fadeTimeSec, clamped);
             } else {
+                // 新旧とも IR あり・OS 倍率不変: 変わったのは Convolver 段だけ
+                if (newWorld.dspProjection.oversamplingFactor == oldWorld.dspProjection.oversamplingFactor)
+                    ctx.scope = convo::CrossfadeScope::ConvolverStage;
                 ctx.fadeTimeSec = std::max(ctx.fadeTimeSec, policy.irFadeTimeSec);
                 ctx.fadeTimeSec = std::max(ctx.fadeTimeSec, policy.irLengthFadeTimeSec);
                 ctx.fadeTimeSec = std::max(ctx.fadeTimeSec, policy.phaseFadeTimeSec);
@@ -27,6 +27,9 @@ public:
         bool oldHasIR = false;
         bool newHasIR = false;
         double fadeTimeSec = 0.0;
+        // IR だけが変わる遷移なら ConvolverStage を要求する。実際に段スコープで走れるかは
+        // 新旧 DSPCore の構成を見て Orchestrator が selectCrossfadeScope() で確定する
+        convo::CrossfadeScope scope = convo::CrossfadeScope::WholeDsp;
     };
 
     explicit CrossfadeAuthority() noexcept = default;
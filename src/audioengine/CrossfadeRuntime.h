@@ -1,10 +1,12 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <algorithm>
 #include "AtomicAccess.h"
 #include "DspNumericPolicy.h"
 #include "ISRDSPHandle.h"          // ★ P1-C: CrossfadeId
+#include "RuntimePolicyEngine.h"   // CrossfadeLoadMode / CrossfadeScope
 #include "core/CommandBuffer.h"    // ★ P1-C: SPSCRingBuffer
 #include "core/TimeUtils.h"        // ★ P1-C: getCurrentTimeUs
 
@@ -35,7 +37,8 @@ public:
     CrossfadeRuntime() noexcept = default;
 
     // start: DSPTransition::onPublishCompleted() から呼ばれる
-    void start(double fadeTimeSec, double sampleRate) noexcept
+    void start(double fadeTimeSec, double sampleRate,
+               convo::CrossfadeScope scope = convo::CrossfadeScope::WholeDsp) noexcept
     {
         gain_.reset(sampleRate, std::max(0.001, fadeTimeSec));
         gain_.setCurrentAndTargetValue(0.0);
@@ -45,6 +48,10 @@ public:
         convo::publishAtomic(firstIrDryPending_, false, std::memory_order_release);
         convo::publishAtomic(startDelayBlocks_, 0, std::memory_order_release);
         convo::publishAtomic(dryHoldSamples_, 0, std::memory_order_release);
+        const bool stageScoped = (scope == convo::CrossfadeScope::ConvolverStage);
+        convo::publishAtomic(convolverStageScoped_, stageScoped, std::memory_order_release);
+        if (stageScoped)
+            convo::fetchAddAtomic(convolverStageScopedCount_, uint64_t{1}, std::memory_order_relaxed); // relaxed: 統計カウンタのみ
         // ★ P1-C: 開始タイムスタンプ記録（Practical-2 Timeout監視用）
         convo::publishAtomic(fadeStartTimestampUs_, getCurrentTimeUs(), std::memory_order_release);
         // activeCrossfadeId_ は触らない — CrossfadeAuthorityRuntime の権威
@@ -93,6 +100,7 @@ public:
     void complete() noexcept
     {
         convo::publishAtomic(pending_, false, std::memory_order_release);
+        convo::publishAtomic(convolverStageScoped_, false, std::memory_order_release);
         convo::publishAtomic(queuedFadeTimeSec_, 0.030, std::memory_order_release);
         convo::publishAtomic(fadeStartTimestampUs_, 0, std::memory_order_release);
     }
@@ -102,6 +110,7 @@ public:
     {
         convo::publishAtomic(pending_, false, std::memory_order_release);
         convo::publishAtomic(useDryAsOld_, false, std::memory_order_release);
+        convo::publishAtomic(convolverStageScoped_, false, std::memory_order_release);
         convo::publishAtomic(firstIrDryPending_, false, std::memory_order_release);
         convo::publishAtomic(firstIrDryDone_, false, std::memory_order_release);
         convo::publishAtomic(startDelayBlocks_, 0, std::memory_order_release);
@@ -121,6 +130,9 @@ public:
         { return convo::consumeAtomic(pending_, std::memory_order_acquire); }
     [[nodiscard]] bool useDryAsOld() const noexcept
         { return convo::consumeAtomic(useDryAsOld_, std::memory_order_acquire); }
+    // 旧 DSPCore を Convolver 段だけ並走させてよい遷移か (CrossfadeScope::ConvolverStage で start)
+    [[nodiscard]] bool isConvolverStageScoped() const noexcept
+        { return convo::consumeAtomic(convolverStageScoped_, std::memory_order_acquire); }
     [[nodiscard]] bool isFirstIrDryPending() const noexcept
         { return convo::consumeAtomic(firstIrDryPending_, std::memory_order_acquire); }
     [[nodiscard]] bool isFirstIrDryDone() const noexcept
@@ -155,9 +167,30 @@ public:
     uint64_t incrementEmergencyAbortCount() noexcept
         { return convo::fetchAddAtomic(m_emergencyAbortCount_, 1u, std::memory_order_acq_rel) + 1; }
 
+    // ★ 負荷適応フェード: 遷移方式ごとの選択回数と直近の判断負荷（Orchestrator が記録）
+    void recordLoadDecision(const convo::CrossfadeLoadDecision& decision) noexcept
+    {
+        const auto idx = static_cast<size_t>(decision.mode);
+        if (idx < loadModeCounts_.size())
+            convo::fetchAddAtomic(loadModeCounts_[idx], uint64_t{1}, std::memory_order_relaxed); // relaxed: 統計カウンタのみ
+        convo::publishAtomic(lastLoadDecisionPermille_, decision.loadPermille, std::memory_order_relaxed); // relaxed: 診断表示のみ
+    }
+    [[nodiscard]] uint64_t loadModeCount(convo::CrossfadeLoadMode mode) const noexcept
+    {
+        const auto idx = static_cast<size_t>(mode);
+        return idx < loadModeCounts_.size()
+            ? convo::consumeAtomic(loadModeCounts_[idx], std::memory_order_relaxed) // relaxed: 統計カウンタのみ
+            : 0;
+    }
+    [[nodiscard]] uint16_t lastLoadDecisionPermille() const noexcept
+        { return convo::consumeAtomic(lastLoadDecisionPermille_, std::memory_order_relaxed); } // relaxed: 診断表示のみ
+    [[nodiscard]] uint64_t convolverStageScopedCount() const noexcept
+        { return convo::consumeAtomic(convolverStageScopedCount_, std::memory_order_relaxed); } // relaxed: 統計カウンタのみ
+
 private:
     std::atomic<bool> pending_{ false };
     std::atomic<bool> useDryAsOld_{ false };
+    std::atomic<bool> convolverStageScoped_{ false };
     std::atomic<bool> firstIrDryPending_{ false };
     std::atomic<bool> firstIrDryDone_{ false };
     std::atomic<int> startDelayBlocks_{ 0 };
@@ -172,6 +205,10 @@ private:
     std::atomic<uint64_t> fadeStartTimestampUs_{0};
     // ★ Phase-2.5: Emergency Override カウンター
     std::atomic<uint64_t> m_emergencyAbortCount_{0};
+    // ★ 負荷適応フェード統計
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(convo::CrossfadeLoadMode::_Count)> loadModeCounts_{};
+    std::atomic<uint16_t> lastLoadDecisionPermille_{0};
+    std::atomic<uint64_t> convolverStageScopedCount_{0};
     // activeCrossfadeId_ は CrossfadeRuntime に持たせない
     // CrossfadeAuthorityRuntime が唯一権威
 };
@@ -44,8 +44,15 @@ public:
         if (!engine_.retireDSPHandleForRuntime(dsp))
             return;
 
+        // A/B 常駐中の DSPCore は破棄せず park する。再公開は AudioEngine::selectABSlot
+        if (engine_.abResidentBank_.parkIfResident(dsp, router_->currentEpoch()))
+            return;
+
         // 2. Route through ISRRetireRouter（enqueueWithRetry が tryReclaim + 再試行を内包）
+        //    Lifetime レーンへ入る。Crossfade 完了・Shutdown など外側でスコープを開いていればそちらに合流する
+        dsp->retirePendingCharge.set(dsp->estimateResidentBytes());
         const uint64_t epoch = router_->currentEpoch();
+        convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*router_, convo::isr::RetireProducer::Lifetime);
         router_->enqueueWithRetry(static_cast<void*>(dsp),
                                    &AudioEngine::destroyDSPCoreNode,
                                    epoch,
@@ -61,6 +68,21 @@ public:
         convo::publishAtomic(currentRetiringGeneration_, committedGen, std::memory_order_release);
     }
 
+    // A/B 常駐から外れた park 済み DSPCore の破棄。handle は park 時に解放済みなので Router へ直接渡す
+    void retireParked(AudioEngine::DSPCore* dsp) noexcept
+    {
+        if (dsp == nullptr) return;
+        dsp->retirePendingCharge.set(dsp->estimateResidentBytes());
+        convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(*router_, convo::isr::RetireProducer::Lifetime);
+        router_->enqueueWithRetry(static_cast<void*>(dsp),
+                                   &AudioEngine::destroyDSPCoreNode,
+                                   router_->currentEpoch(),
+                                   DeletionEntryType::Generic);
+        convo::fetchAddAtomic(engine_.rtAuxMutable_.runtimeRetireCount,
+                              static_cast<std::uint64_t>(1),
+                              std::memory_order_acq_rel);
+    }
+
     void retireDeferred() noexcept
     {
         // deferred queue drain: handled by AudioEngine threading
@@ -77,6 +99,9 @@ public:
     void destroyRolledBackDSP(AudioEngine::DSPCore* dsp) noexcept
     {
         if (dsp == nullptr) return;
+        // A/B 常駐 DSPCore の再公開が差し戻された場合は park に戻す (一度公開済みなので epoch も記録)
+        if (engine_.abResidentBank_.parkIfResident(dsp, router_->currentEpoch()))
+            return;
         engine_.destroyDSPCoreNode(dsp);
     }
 
@@ -103,7 +103,7 @@ public:
             const double rampSampleRate = std::max(1.0,
                 (newDSP != nullptr) ? newDSP->sampleRate
                     : convo::consumeAtomic(engine_.currentSampleRate, std::memory_order_acquire));
-            engine_.crossfadeRuntime_.start(decision.fadeTimeSec, rampSampleRate);
+            engine_.crossfadeRuntime_.start(decision.fadeTimeSec, rampSampleRate, decision.scope);
             engine_.setIRChangeFlag();
         } else if (oldDSP != nullptr) {
             // Crossfade 不要: 即時 retire
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+//==============================================================================
+// DeviceOutputCodec — ディザ済み出力をデバイスの整数コードへ LSB 単位で一致させる
+//
+//   ノイズシェーパー / PsychoacousticDither は b bit 指定で値を k / 2^(b-1) の格子に量子化する。
+//   一方 JUCE の ASIO ドライバ層 (juce_ASIO_windows.cpp の ASIOSampleFormat::convertFromFloat) は
+//   整数フォーマットへ roundToInt(v * (2^(D-1) - 1)) で変換するため、|k| >= 2^(b-2) (-6 dBFS 以上)
+//   のコードが 1 LSB 小さい側へずれ、ディザの LSB 位置が崩れる。
+//
+//   ASIO のネイティブバッファは AudioIODeviceCallback から見えない (JUCE が float で受け取って変換する)
+//   ため、直接 int24 / int32 を書く代わりに、融合出力段 (FusedOutputStage) のゲインとして
+//   2^(D-1) / (2^(D-1) - 1) を掛けておく。v = k / 2^(b-1) は k·2^(D-b) / (2^(D-1) - 1) になり、
+//   float 化の相対誤差 2^-24 を含めてもドライバの丸め後に k·2^(D-b) へ正確に戻る (D <= 24)。
+//   double 経路 (AudioProcessorPlayer が float へ変換) でも同じ。
+//
+//   float の仮数は 24 bit なので D = 32 の整数フォーマットはこの方法でも正確にならず、補正しない。
+//   ASIO 以外 (WASAPI 等) は AudioData の 2^(D-1) スケールで変換するため補正不要。
+//
+//   自前の WASAPI 排他バックエンド (NativeWasapiExclusive.cpp) はデバイスのネイティブ形式で
+//   render バッファへ直接書く (writeInterleavedPcm)。変換は 2^(D-1) スケールの最近接丸めなので
+//   k / 2^(b-1) は k·2^(D-b) にそのまま載り (D = 32 でも float × 2^31 は正確)、ゲイン補正は要らない。
+//==============================================================================
+
+namespace convo::output {
+
+// デバイスが整数フォーマットで、かつ float 経由で LSB を保てるビット数 (16 / 24) なら返す。それ以外は 0
+inline int deviceIntegerBitsFor(bool isAsioDevice, int currentBitDepth) noexcept
+{
+    if (!isAsioDevice)
+        return 0;
+    return (currentBitDepth == 16 || currentBitDepth == 24) ? currentBitDepth : 0;
+}
+
+// 融合出力段で掛けるゲイン。deviceIntegerBits == 0 (float / 不明) やディザ無効、
+// ディザ語長がデバイスより長い場合は 1.0 (補正なし)
+inline double deviceIntegerCodeGain(int deviceIntegerBits, int ditherBitDepth) noexcept
+{
+    if (deviceIntegerBits <= 0 || ditherBitDepth <= 0 || ditherBitDepth > deviceIntegerBits)
+        return 1.0;
+    const double fullScale = std::ldexp(1.0, deviceIntegerBits - 1);
+    return fullScale / (fullScale - 1.0);
+}
+
+// JUCE ASIO の float → 整数変換 (ASIOSampleFormat::convertFloatToInt16 / 24 と同じ式)。テスト・診断用
+inline std::int32_t asioIntegerCode(float v, int bits) noexcept
+{
+    const double maxVal = std::ldexp(1.0, bits - 1) - 1.0;
+    double scaled = maxVal * static_cast<double>(v);
+    scaled = (scaled < -maxVal) ? -maxVal : ((scaled > maxVal) ? maxVal : scaled);
+    return static_cast<std::int32_t>(std::nearbyint(scaled)); // roundToInt と同じ最近接偶数丸め
+}
+
+// ── ネイティブ PCM への直接書き込み (WASAPI 排他) ───────────────────────
+
+enum class PcmSampleFormat : std::uint8_t
+{
+    Float32,      // IEEE float 32 bit
+    Int16,
+    Int24Packed,  // 3 byte little endian
+    Int24In32,    // 4 byte コンテナの上位 24 bit (下位 8 bit は 0)
+    Int32
+};
+
+inline int pcmBytesPerSample(PcmSampleFormat format) noexcept
+{
+    switch (format)
+    {
+        case PcmSampleFormat::Int16:       return 2;
+        case PcmSampleFormat::Int24Packed: return 3;
+        default:                           return 4;
+    }
+}
+
+// 整数コードの有効ビット数 (Float32 は 32 を返す: getCurrentBitDepth 用)
+inline int pcmValidBits(PcmSampleFormat format) noexcept
+{
+    switch (format)
+    {
+        case PcmSampleFormat::Int16:       return 16;
+        case PcmSampleFormat::Int24Packed:
+        case PcmSampleFormat::Int24In32:   return 24;
+        default:                           return 32;
+    }
+}
+
+// v × 2^(bits-1) を最近接偶数へ丸め [-2^(bits-1), 2^(bits-1) - 1] に飽和。NaN は 0
+inline std::int32_t pcmIntegerCode(float v, int bits) noexcept
+{
+    const double fullScale = std::ldexp(1.0, bits - 1);
+    const double scaled = static_cast<double>(v) * fullScale;
+    if (!(scaled == scaled))
+        return 0;
+    if (scaled >= fullScale - 1.0)
+        return static_cast<std::int32_t>(fullScale - 1.0);
+    if (scaled <= -fullScale)
+        return static_cast<std::int32_t>(-fullScale);
+    return static_cast<std::int32_t>(std::nearbyint(scaled));
+}
+
+// 平面 float をインターリーブしながら dst (デバイスのバッファ) へ直接書く。
+// sourceForDeviceChannel[c] はデバイスチャンネル c に書く sources の添字、負なら無音
+inline void writeInterleavedPcm(const float* const* sources, const int* sourceForDeviceChannel,
+                                int numDeviceChannels, int numFrames,
+                                PcmSampleFormat format, void* dst) noexcept
+{
+    auto* out = static_cast<unsigned char*>(dst);
+    const int bytes = pcmBytesPerSample(format);
+    const int bits = pcmValidBits(format);
+    for (int c = 0; c < numDeviceChannels; ++c)
+    {
+        const int src = sourceForDeviceChannel[c];
+        const float* in = (src >= 0) ? sources[src] : nullptr;
+        unsigned char* p = out + static_cast<std::size_t>(c) * static_cast<std::size_t>(bytes);
+        const std::size_t stride = static_cast<std::size_t>(numDeviceChannels) * static_cast<std::size_t>(bytes);
+        for (int i = 0; i < numFrames; ++i, p += stride)
+        {
+            const float v = (in != nullptr) ? in[i] : 0.0f;
+            switch (format)
+            {
+                case PcmSampleFormat::Float32:
+                    std::memcpy(p, &v, sizeof(float));
+                    break;
+                case PcmSampleFormat::Int16:
+                {
+                    const auto code = static_cast<std::int16_t>(pcmIntegerCode(v, bits));
+                    std::memcpy(p, &code, sizeof(code));
+                    break;
+                }
+                case PcmSampleFormat::Int24Packed:
+                {
+                    const auto code = static_cast<std::uint32_t>(pcmIntegerCode(v, bits));
+                    p[0] = static_cast<unsigned char>(code);
+                    p[1] = static_cast<unsigned char>(code >> 8);
+                    p[2] = static_cast<unsigned char>(code >> 16);
+                    break;
+                }
+                case PcmSampleFormat::Int24In32:
+                {
+                    const auto code = static_cast<std::uint32_t>(pcmIntegerCode(v, bits)) << 8;
+                    std::memcpy(p, &code, sizeof(code));
+                    break;
+                }
+                case PcmSampleFormat::Int32:
+                {
+                    const std::int32_t code = pcmIntegerCode(v, bits);
+                    std::memcpy(p, &code, sizeof(code));
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// デバイスのインターリーブ PCM を平面 float (± 1.0 フルスケール = 2^(D-1)) へ読む。
+// deviceChannelForDest[d] は dests[d] に読むデバイスチャンネル、負なら 0 で埋める
+inline void readInterleavedPcm(const void* src, PcmSampleFormat format,
+                               int numDeviceChannels, int numFrames,
+                               float* const* dests, const int* deviceChannelForDest, int numDests) noexcept
+{
+    const auto* in = static_cast<const unsigned char*>(src);
+    const int bytes = pcmBytesPerSample(format);
+    const double scale = std::ldexp(1.0, -(pcmValidBits(format) - 1));
+    const std::size_t stride = static_cast<std::size_t>(numDeviceChannels) * static_cast<std::size_t>(bytes);
+    for (int d = 0; d < numDests; ++d)
+    {
+        float* out = dests[d];
+        const int c = deviceChannelForDest[d];
+        if (c < 0 || c >= numDeviceChannels)
+        {
+            std::memset(out, 0, sizeof(float) * static_cast<std::size_t>(numFrames));
+            continue;
+        }
+        const unsigned char* p = in + static_cast<std::size_t>(c) * static_cast<std::size_t>(bytes);
+        for (int i = 0; i < numFrames; ++i, p += stride)
+        {
+            switch (format)
+            {
+                case PcmSampleFormat::Float32:
+                    std::memcpy(&out[i], p, sizeof(float));
+                    break;
+                case PcmSampleFormat::Int16:
+                {
+                    std::int16_t code = 0;
+                    std::memcpy(&code, p, sizeof(code));
+                    out[i] = static_cast<float>(code * scale);
+                    break;
+                }
+                case PcmSampleFormat::Int24Packed:
+                {
+                    const std::uint32_t raw = static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8)
+                                            | (static_cast<std::uint32_t>(p[2]) << 16);
+                    const auto code = static_cast<std::int32_t>(raw << 8) >> 8;   // 符号拡張
+                    out[i] = static_cast<float>(code * scale);
+                    break;
+                }
+                case PcmSampleFormat::Int24In32:
+                {
+                    std::int32_t code = 0;
+                    std::memcpy(&code, p, sizeof(code));
+                    out[i] = static_cast<float>((code >> 8) * scale);
+                    break;
+                }
+                case PcmSampleFormat::Int32:
+                {
+                    std::int32_t code = 0;
+                    std::memcpy(&code, p, sizeof(code));
+                    out[i] = static_cast<float>(code * scale);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} // namespace convo::output
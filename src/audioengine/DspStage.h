@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//==============================================================================
+// DspStage — DSPCore::process の段の区分
+//
+//   StageLatencyHistogram (段別の処理時間)・XrunIncidentCorrelator (超過時の内訳)・
+//   RtSafetyGuard (違反が起きた段) が共有する。
+//==============================================================================
+
+namespace convo {
+
+enum class DspStage : uint8_t
+{
+    Input,            // 入力変換・ヘッドルーム・DC ブロッカー・dry 保存
+    OversampleUp,     // processUp + オーバーサンプル域 DC ブロッカー
+    Eq,
+    Convolver,
+    OversampleDown,   // processDown
+    Output,           // 出力フィルタ・ソフトクリップ・bypass blend・ディザ・リミッタ・書き出し
+    Count
+};
+
+[[nodiscard]] constexpr const char* dspStageName(DspStage stage) noexcept
+{
+    switch (stage)
+    {
+        case DspStage::Input:          return "input";
+        case DspStage::OversampleUp:   return "osUp";
+        case DspStage::Eq:             return "eq";
+        case DspStage::Convolver:      return "conv";
+        case DspStage::OversampleDown: return "osDown";
+        case DspStage::Output:         return "output";
+        case DspStage::Count:          break;
+    }
+    return "?";
+}
+
+inline constexpr size_t kNumDspStages = static_cast<size_t>(DspStage::Count);
+
+} // namespace convo
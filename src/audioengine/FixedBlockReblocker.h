@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+//==============================================================================
+// FixedBlockReblocker — デバイスのコールバック長に依らず、固定長ブロックで DSP を回す
+//
+//   WASAPI 共有モードや一部 ASIO ドライバはコールバック長が揺れる (441 / 448 / 480 …)。
+//   そのまま DSPCore へ渡すと、オーバーサンプラと NUC の L0 パーティション (partSize) への
+//   入力が毎回不揃いに分割され、コールバックごとの負荷が読めなくなる。
+//   本クラスは入力 FIFO に貯めて blockSize (2 の冪・L0 partSize と一致) ずつ処理し、
+//   出力 FIFO からデバイス長ぶん取り出す。
+//
+//   遅延: 出力 FIFO へ先に blockSize - 1 サンプルの無音を積む。
+//     コールバック前の FIFO 量は常に (入力 + 出力) = blockSize - 1 で、処理後の入力残りは
+//     blockSize - 1 以下なので、どのコールバック長でも出力 FIFO が枯れない最小値になる。
+//
+//   FIFO は Audio Thread だけが触るためロック・atomic を持たない (確保なし)。
+//   SampleType は float (getNextAudioBlock) / double (processBlockDouble)。
+//   prepare() は Message Thread 用 (Audio Thread 停止中)。JUCE 非依存。
+//==============================================================================
+
+namespace convo {
+
+template <typename SampleType>
+class FixedBlockReblocker
+{
+public:
+    static constexpr int kMaxChannels = 2;
+
+    // 確保して FIFO を初期化する。blockSize は 2 の冪、maxCallbackSamples は受け付けるコールバック長の上限
+    bool prepare(int newNumChannels, int newBlockSize, int newMaxCallbackSamples)
+    {
+        if (newNumChannels < 1 || newNumChannels > kMaxChannels
+            || newBlockSize <= 0 || (newBlockSize & (newBlockSize - 1)) != 0
+            || newMaxCallbackSamples <= 0)
+        {
+            blockSize = 0;
+            return false;
+        }
+
+        numChannels = newNumChannels;
+        blockSize = newBlockSize;
+        maxCallbackSamples = newMaxCallbackSamples;
+        // 入力: 残り (blockSize - 1) + 1 コールバック / 出力: 先積み (blockSize - 1) + 1 コールバック
+        const size_t capacity = static_cast<size_t>(blockSize) + static_cast<size_t>(maxCallbackSamples);
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            inputFifo[ch].assign(ch < numChannels ? capacity : 0, SampleType {});
+            outputFifo[ch].assign(ch < numChannels ? capacity : 0, SampleType {});
+        }
+        reset();
+        return true;
+    }
+
+    // FIFO を空にして出力側へ遅延ぶんの無音を積み直す (確保なし)
+    void reset() noexcept
+    {
+        if (blockSize <= 0)
+            return;
+        inputFill = 0;
+        outputFill = getLatencySamples();
+        for (int ch = 0; ch < numChannels; ++ch)
+            std::memset(outputFifo[ch].data(), 0, sizeof(SampleType) * static_cast<size_t>(outputFill));
+    }
+
+    bool isPrepared() const noexcept { return blockSize > 0; }
+    int getBlockSize() const noexcept { return blockSize; }
+    int getNumChannels() const noexcept { return numChannels; }
+    int getMaxCallbackSamples() const noexcept { return maxCallbackSamples; }
+    int getLatencySamples() const noexcept { return blockSize > 0 ? blockSize - 1 : 0; }
+
+    // channels[0..numChannelsIn) の numSamples を in-place で置き換える。
+    // processBlock(SampleType* const* blockChannels, int blockSize) を満ちたブロックの数だけ呼ぶ
+    // (blockChannels は getNumChannels() 本。デバイス側に無いチャンネルは無音を入れ、出力は捨てる)。
+    // 戻り値: processBlock へ渡したサンプル数。未準備・上限超過なら -1 (channels は変更しない)
+    template <typename BlockFn>
+    int process(SampleType* const* channels, int numChannelsIn, int numSamples, BlockFn&& processBlock) noexcept
+    {
+        if (blockSize <= 0 || numSamples < 0 || numSamples > maxCallbackSamples)
+            return -1;
+
+        const int usedChannels = std::min(numChannelsIn, numChannels);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            SampleType* dst = inputFifo[ch].data() + inputFill;
+            if (ch < usedChannels && channels[ch] != nullptr)
+                std::memcpy(dst, channels[ch], sizeof(SampleType) * static_cast<size_t>(numSamples));
+            else
+                std::memset(dst, 0, sizeof(SampleType) * static_cast<size_t>(numSamples));
+        }
+        inputFill += numSamples;
+
+        // 満ちたブロックを出力 FIFO の末尾へ移し、その場で処理する
+        int consumed = 0;
+        SampleType* blockChannels[kMaxChannels] = {};
+        while (inputFill - consumed >= blockSize)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                blockChannels[ch] = outputFifo[ch].data() + outputFill;
+                std::memcpy(blockChannels[ch], inputFifo[ch].data() + consumed, sizeof(SampleType) * static_cast<size_t>(blockSize));
+            }
+            processBlock(static_cast<SampleType* const*>(blockChannels), blockSize);
+            outputFill += blockSize;
+            consumed += blockSize;
+        }
+        inputFill -= consumed;
+        if (consumed > 0 && inputFill > 0)
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::memmove(inputFifo[ch].data(), inputFifo[ch].data() + consumed, sizeof(SampleType) * static_cast<size_t>(inputFill));
+
+        // 先積みの無音により outputFill >= numSamples が常に成り立つ
+        for (int ch = 0; ch < usedChannels; ++ch)
+            if (channels[ch] != nullptr)
+                std::memcpy(channels[ch], outputFifo[ch].data(), sizeof(SampleType) * static_cast<size_t>(numSamples));
+        outputFill -= numSamples;
+        if (outputFill > 0)
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::memmove(outputFifo[ch].data(), outputFifo[ch].data() + numSamples, sizeof(SampleType) * static_cast<size_t>(outputFill));
+
+        return consumed;
+    }
+
+private:
+    int numChannels = 0;
+    int blockSize = 0;
+    int maxCallbackSamples = 0;
+    int inputFill = 0;
+    int outputFill = 0;
+    std::vector<SampleType> inputFifo[kMaxChannels];
+    std::vector<SampleType> outputFifo[kMaxChannels];
+};
+
+} // namespace convo
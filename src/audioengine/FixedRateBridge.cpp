@@ -0,0 +1,63 @@
+#include "FixedRateBridge.h"
+#include "CDSPResampler.h"
+
+namespace convo {
+
+namespace {
+
+// 実時間の経路なので IR 読み込み (transBand 2.0 / 206.91 dB) より短いフィルタにする。
+// 遅延はほぼ遷移帯の幅で決まる (48k↔96k で 3 % なら約 34 ms、10 % なら約 8 ms)。
+// 10 % でも通過帯域は低い側のナイキストの 90 % (44.1 kHz で約 19.8 kHz) まで平坦、
+// 150 dB は 24 bit の量子化雑音より十分低い
+constexpr double kTransitionBandPercent = 10.0;
+constexpr double kStopBandAttenuationDb = 150.0;
+
+} // namespace
+
+FixedRateResamplerBank::FixedRateResamplerBank() = default;
+FixedRateResamplerBank::~FixedRateResamplerBank() = default;
+
+bool FixedRateResamplerBank::prepare(int newNumChannels, double sourceRate, double destinationRate,
+                                     int maxInputSamples, bool minimumPhase)
+{
+    release();
+    if (newNumChannels <= 0 || maxInputSamples <= 0)
+        return false;
+
+    resamplers.reserve(static_cast<size_t>(newNumChannels));
+    for (int ch = 0; ch < newNumChannels; ++ch)
+        resamplers.push_back(std::make_unique<r8b::CDSPResampler>(
+            sourceRate, destinationRate, maxInputSamples,
+            kTransitionBandPercent, kStopBandAttenuationDb,
+            minimumPhase ? r8b::fprMinPhase : r8b::fprLinearPhase));
+
+    maxOutputSamples = resamplers.front()->getMaxOutLen(maxInputSamples);
+    numChannels = newNumChannels;
+    return true;
+}
+
+void FixedRateResamplerBank::release()
+{
+    resamplers.clear();
+    numChannels = 0;
+    maxOutputSamples = 0;
+}
+
+void FixedRateResamplerBank::clear() noexcept
+{
+    for (auto& resampler : resamplers)
+        resampler->clear();
+}
+
+int FixedRateResamplerBank::process(int channel, double* input, int numSamples, double*& output) noexcept
+{
+    if (channel < 0 || channel >= numChannels || numSamples <= 0)
+    {
+        output = input;
+        return 0;
+    }
+    // r8brain は input を作業領域として書き換え得る (呼び出し側の一時バッファを渡す)
+    return resamplers[static_cast<size_t>(channel)]->process(input, numSamples, output);
+}
+
+} // namespace convo
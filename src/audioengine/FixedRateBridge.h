@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace r8b { class CDSPResampler; }
+
+//==============================================================================
+// FixedRateBridge — デバイスのレートに依らず、DSPCore を固定の内部レートで回す
+//
+//   デバイスのレートが変わるたびに IR のリサンプル・分割、EQ 係数、オーバーサンプラ、学習バンクの
+//   切替がすべて走る。内部レートを固定すると、それらは常に 1 つのレートだけを持てばよく、
+//   デバイス側のレート変更は本クラスの SRC (r8brain CDSPResampler) の作り直しだけになる。
+//
+//   コールバックごとに: 入力 → 上り SRC → 入力 FIFO → 内部ブロック 1 回 → 下り SRC → 出力 FIFO → 出力。
+//   内部ブロック長は numSamples × 内部/外部 の累積を整数に切ったもので、コールバックごとの差は 1 以内
+//   (DSPCore は毎コールバック 1 回、ほぼ同じ長さで呼ばれる)。r8brain の出力は内部のブロック単位で
+//   まとまって出てくるため、両 FIFO の先積み (無音) を prepare() で無音の空運転から求める。
+//   想定より短いコールバックが続いて FIFO が枯れたときは不足ぶんを無音で埋め、その分だけ遅延が増える
+//   (getUnderruns() / getLatencySamples() に出る)。
+//
+//   遅延 (外部レートのサンプル) = 入力 FIFO の先積み / 比 + 出力 FIFO の先積み (+ 枯れた分)。
+//   r8brain は自身のフィルタ遅延を出力の先頭から落とすので、それ以外は足さない。
+//
+//   FIFO は Audio Thread だけが触るためロック・atomic を持たない (確保なし)。
+//   SampleType は float (getNextAudioBlock) / double (processBlockDouble)。FIFO と SRC は double。
+//   prepare() / release() は Message Thread 用 (Audio Thread 停止中)。JUCE 非依存。
+//==============================================================================
+
+namespace convo {
+
+// 1 方向ぶんの SRC (チャンネルごとの CDSPResampler)。r8brain のヘッダはこの .cpp だけが読む
+class FixedRateResamplerBank
+{
+public:
+    FixedRateResamplerBank();
+    ~FixedRateResamplerBank();
+    FixedRateResamplerBank(const FixedRateResamplerBank&) = delete;
+    FixedRateResamplerBank& operator=(const FixedRateResamplerBank&) = delete;
+
+    // Message Thread 専用。maxInputSamples は 1 回の process() に渡す上限
+    bool prepare(int numChannels, double sourceRate, double destinationRate, int maxInputSamples, bool minimumPhase);
+    void release();
+    // 確保なし
+    void clear() noexcept;
+
+    [[nodiscard]] bool isPrepared() const noexcept { return numChannels > 0; }
+    // 1 回の process() が返しうる最大のサンプル数
+    [[nodiscard]] int getMaxOutputSamples() const noexcept { return maxOutputSamples; }
+
+    // 確保なし。戻り値は output (SRC 内部のバッファ) に入ったサンプル数
+    int process(int channel, double* input, int numSamples, double*& output) noexcept;
+
+private:
+    std::vector<std::unique_ptr<r8b::CDSPResampler>> resamplers;
+    int numChannels = 0;
+    int maxOutputSamples = 0;
+};
+
+template <typename SampleType>
+class FixedRateBridge
+{
+public:
+    static constexpr int kMaxChannels = 2;
+    static constexpr double kPrimingSimulationSeconds = 2.0;   // 先積みを決める空運転の長さ
+
+    // 確保して両 FIFO を先積みした状態にする。外部・内部のレートが等しい・不正なら false (未準備)。
+    // expectedCallbackSamples は通常のコールバック長 (空運転に使う)、maxCallbackSamples は受け付ける上限
+    bool prepare(int newNumChannels,
+                 double newOuterRate,
+                 double newInnerRate,
+                 int expectedCallbackSamples,
+                 int newMaxCallbackSamples,
+                 bool minimumPhase)
+    {
+        release();
+        if (newNumChannels < 1 || newNumChannels > kMaxChannels
+            || !(newOuterRate > 0.0) || !(newInnerRate > 0.0) || std::abs(newOuterRate - newInnerRate) < 1.0e-6
+            || expectedCallbackSamples <= 0 || newMaxCallbackSamples < expectedCallbackSamples)
+            return false;
+
+        numChannels = newNumChannels;
+        outerRate = newOuterRate;
+        innerRate = newInnerRate;
+        ratio = innerRate / outerRate;
+        maxCallbackSamples = newMaxCallbackSamples;
+        maxInnerBlockSamples = static_cast<int>(std::ceil(static_cast<double>(maxCallbackSamples) * ratio)) + 1;
+
+        if (!upsampler.prepare(numChannels, outerRate, innerRate, maxCallbackSamples, minimumPhase)
+            || !downsampler.prepare(numChannels, innerRate, outerRate, maxInnerBlockSamples, minimumPhase))
+        {
+            release();
+            return false;
+        }
+
+        computePriming(expectedCallbackSamples);
+
+        // 入力 FIFO: 先積み + 上り SRC の 1 回分 / 出力 FIFO: 先積み + 下り SRC の 1 回分 (+ 枯れたときの埋め分)
+        const size_t inputCapacity = static_cast<size_t>(inputPriming + upsampler.getMaxOutputSamples() + maxInnerBlockSamples);
+        const size_t outputCapacity = static_cast<size_t>(outputPriming + downsampler.getMaxOutputSamples() + maxCallbackSamples);
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            inputFifo[ch].assign(ch < numChannels ? inputCapacity : 0, 0.0);
+            outputFifo[ch].assign(ch < numChannels ? outputCapacity : 0, 0.0);
+            block[ch].assign(ch < numChannels ? static_cast<size_t>(maxInnerBlockSamples) : 0, SampleType {});
+        }
+        conversion.assign(static_cast<size_t>(std::max(maxCallbackSamples, maxInnerBlockSamples)), 0.0);
+        reset();
+        return true;
+    }
+
+    void release()
+    {
+        upsampler.release();
+        downsampler.release();
+        numChannels = 0;
+        for (int ch = 0; ch < kMaxChannels; ++ch)
+        {
+            inputFifo[ch] = {};
+            outputFifo[ch] = {};
+            block[ch] = {};
+        }
+        conversion = {};
+    }
+
+    // SRC の状態を消し、両 FIFO を先積みの無音へ戻す (確保なし)
+    void reset() noexcept
+    {
+        if (numChannels <= 0)
+            return;
+        upsampler.clear();
+        downsampler.clear();
+        inputFill = inputPriming;
+        outputFill = outputPriming;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            std::fill_n(inputFifo[ch].data(), inputFill, 0.0);
+            std::fill_n(outputFifo[ch].data(), outputFill, 0.0);
+        }
+        takeAccumulator = 0.0;
+        inputPadding = 0;
+        outputPadding = 0;
+        underruns = 0;
+    }
+
+    [[nodiscard]] bool isPrepared() const noexcept { return numChannels > 0; }
+    [[nodiscard]] int getNumChannels() const noexcept { return numChannels; }
+    [[nodiscard]] double getOuterRate() const noexcept { return outerRate; }
+    [[nodiscard]] double getInnerRate() const noexcept { return innerRate; }
+    [[nodiscard]] int getMaxCallbackSamples() const noexcept { return maxCallbackSamples; }
+    // processBlock へ渡す長さの上限 (DSPCore はこれで準備する)
+    [[nodiscard]] int getMaxInnerBlockSamples() const noexcept { return maxInnerBlockSamples; }
+    [[nodiscard]] uint64_t getUnderruns() const noexcept { return underruns; }
+
+    // 外部レートのサンプル。FIFO が枯れて無音を埋めるたびに増える
+    [[nodiscard]] int getLatencySamples() const noexcept
+    {
+        if (numChannels <= 0)
+            return 0;
+        return static_cast<int>(std::lround(static_cast<double>(inputPriming + inputPadding) / ratio))
+             + outputPriming + outputPadding;
+    }
+
+    // channels[0..numChannelsIn) の numSamples (外部レート) を in-place で置き換える。
+    // processBlock(SampleType* const* blockChannels, int blockSamples) を内部レートで 1 回呼ぶ
+    // (blockChannels は getNumChannels() 本。デバイス側に無いチャンネルは無音を入れ、出力は捨てる)。
+    // 戻り値: processBlock へ渡したサンプル数。未準備・上限超過なら -1 (channels は変更しない)
+    template <typename BlockFn>
+    int process(SampleType* const* channels, int numChannelsIn, int numSamples, BlockFn&& processBlock) noexcept
+    {
+        if (numChannels <= 0 || numSamples < 0 || numSamples > maxCallbackSamples)
+            return -1;
+
+        const int usedChannels = std::min(numChannelsIn, numChannels);
+
+        // 上り: デバイス入力 → 内部レート → 入力 FIFO
+        int produced = 0;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (ch < usedChannels && channels[ch] != nullptr)
+                for (int i = 0; i < numSamples; ++i)
+                    conversion[static_cast<size_t>(i)] = static_cast<double>(channels[ch][i]);
+            else
+                std::fill_n(conversion.data(), numSamples, 0.0);
+
+            double* resampled = nullptr;
+            produced = upsampler.process(ch, conversion.data(), numSamples, resampled);
+            std::memcpy(inputFifo[ch].data() + inputFill, resampled, sizeof(double) * static_cast<size_t>(produced));
+        }
+        inputFill += produced;
+
+        // 内部ブロック: 累積の比から今回の長さを決め、足りなければ先頭を無音で埋める
+        takeAccumulator += static_cast<double>(numSamples) * ratio;
+        const int blockSamples = std::min(static_cast<int>(takeAccumulator), maxInnerBlockSamples);
+        takeAccumulator -= static_cast<double>(blockSamples);
+        const int shortfall = std::max(0, blockSamples - inputFill);
+        const int taken = blockSamples - shortfall;
+        if (shortfall > 0)
+        {
+            inputPadding += shortfall;
+            ++underruns;
+        }
+
+        SampleType* blockChannels[kMaxChannels] = {};
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            SampleType* dst = block[ch].data();
+            std::fill_n(dst, shortfall, SampleType {});
+            const double* src = inputFifo[ch].data();
+            for (int i = 0; i < taken; ++i)
+                dst[shortfall + i] = static_cast<SampleType>(src[i]);
+            blockChannels[ch] = dst;
+        }
+        inputFill -= taken;
+        if (taken > 0 && inputFill > 0)
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::memmove(inputFifo[ch].data(), inputFifo[ch].data() + taken, sizeof(double) * static_cast<size_t>(inputFill));
+
+        if (blockSamples > 0)
+            processBlock(static_cast<SampleType* const*>(blockChannels), blockSamples);
+
+        // 下り: 内部ブロックの出力 → 外部レート → 出力 FIFO
+        produced = 0;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < blockSamples; ++i)
+                conversion[static_cast<size_t>(i)] = static_cast<double>(block[ch][static_cast<size_t>(i)]);
+            double* resampled = nullptr;
+            produced = downsampler.process(ch, conversion.data(), blockSamples, resampled);
+            std::memcpy(outputFifo[ch].data() + outputFill, resampled, sizeof(double) * static_cast<size_t>(produced));
+        }
+        outputFill += produced;
+
+        // 出力: 足りなければ先頭を無音で埋める
+        const int outputShortfall = std::max(0, numSamples - outputFill);
+        const int delivered = numSamples - outputShortfall;
+        if (outputShortfall > 0)
+        {
+            outputPadding += outputShortfall;
+            ++underruns;
+        }
+        for (int ch = 0; ch < usedChannels; ++ch)
+        {
+            if (channels[ch] == nullptr)
+                continue;
+            std::fill_n(channels[ch], outputShortfall, SampleType {});
+            const double* src = outputFifo[ch].data();
+            for (int i = 0; i < delivered; ++i)
+                channels[ch][outputShortfall + i] = static_cast<SampleType>(src[i]);
+        }
+        outputFill -= delivered;
+        if (delivered > 0 && outputFill > 0)
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::memmove(outputFifo[ch].data(), outputFifo[ch].data() + delivered, sizeof(double) * static_cast<size_t>(outputFill));
+
+        return blockSamples;
+    }
+
+private:
+    // 無音で expectedCallbackSamples ずつ空運転し、両 FIFO が枯れない最小の先積みを求める
+    // (r8brain の出力のまとまり方は入力の値に依らない)。終わったら SRC の状態は clear する
+    void computePriming(int expectedCallbackSamples)
+    {
+        std::vector<double> silence(static_cast<size_t>(std::max(maxCallbackSamples, maxInnerBlockSamples)), 0.0);
+        const int callbacks = std::max(64, static_cast<int>(kPrimingSimulationSeconds * outerRate / expectedCallbackSamples));
+
+        // 上り: 入力 FIFO の最小量
+        int64_t level = 0;
+        int64_t lowest = 0;
+        double accumulator = 0.0;
+        upsampler.clear();
+        for (int c = 0; c < callbacks; ++c)
+        {
+            double* out = nullptr;
+            level += upsampler.process(0, silence.data(), expectedCallbackSamples, out);
+            accumulator += static_cast<double>(expectedCallbackSamples) * ratio;
+            const int take = std::min(static_cast<int>(accumulator), maxInnerBlockSamples);
+            accumulator -= static_cast<double>(take);
+            level -= take;
+            lowest = std::min(lowest, level);
+        }
+        inputPriming = static_cast<int>(-lowest);
+
+        // 下り: 上りの先積みを含めた内部ブロック列を流したときの出力 FIFO の最小量
+        level = 0;
+        lowest = 0;
+        accumulator = 0.0;
+        downsampler.clear();
+        for (int c = 0; c < callbacks; ++c)
+        {
+            accumulator += static_cast<double>(expectedCallbackSamples) * ratio;
+            const int take = std::min(static_cast<int>(accumulator), maxInnerBlockSamples);
+            accumulator -= static_cast<double>(take);
+            double* out = nullptr;
+            level += downsampler.process(0, silence.data(), take, out);
+            level -= expectedCallbackSamples;
+            lowest = std::min(lowest, level);
+        }
+        outputPriming = static_cast<int>(-lowest);
+
+        upsampler.clear();
+        downsampler.clear();
+    }
+
+    FixedRateResamplerBank upsampler;     // 外部 → 内部
+    FixedRateResamplerBank downsampler;   // 内部 → 外部
+    int numChannels = 0;
+    double outerRate = 0.0;
+    double innerRate = 0.0;
+    double ratio = 1.0;                   // 内部 / 外部
+    int maxCallbackSamples = 0;
+    int maxInnerBlockSamples = 0;
+    int inputPriming = 0;                 // 内部レート
+    int outputPriming = 0;                // 外部レート
+
+    // 以下は Audio Thread 専用 (prepare / reset の後)
+    int inputFill = 0;
+    int outputFill = 0;
+    double takeAccumulator = 0.0;
+    int inputPadding = 0;
+    int outputPadding = 0;
+    uint64_t underruns = 0;
+    std::vector<double> inputFifo[kMaxChannels];
+    std::vector<double> outputFifo[kMaxChannels];
+    std::vector<SampleType> block[kMaxChannels];
+    std::vector<double> conversion;
+};
+
+} // namespace convo
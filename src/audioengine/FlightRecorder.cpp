@@ -0,0 +1,285 @@
+//============================================================================
+// FlightRecorder.cpp — メモリマップしたフライトレコーダーの作成・破棄・読み出し
+//============================================================================
+
+#include "FlightRecorder.h"
+#include "core/TimeUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <functional>
+#include <thread>
+#endif
+
+namespace convo {
+
+namespace {
+
+constexpr const char* kChannelNames[FlightRecorder::kNumChannels] = {
+    "failure", "progress", "retire", "xrun", "diag", "lifecycle"
+};
+
+size_t channelOffset(size_t channel) noexcept
+{
+    size_t offset = FlightRecorder::kHeaderBytes;
+    for (size_t c = 0; c < channel; ++c)
+        offset += static_cast<size_t>(FlightRecorder::kChannelCapacity[c]) * FlightRecorder::kRecordBytes;
+    return offset;
+}
+
+constexpr bool isPowerOfTwo(uint32_t v) noexcept { return v != 0 && (v & (v - 1)) == 0; }
+
+uint64_t currentProcessId() noexcept
+{
+#ifdef _WIN32
+    return static_cast<uint64_t>(::GetCurrentProcessId());
+#else
+    return static_cast<uint64_t>(::getpid());
+#endif
+}
+
+template <typename T>
+T readPlain(const uint8_t* at) noexcept
+{
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+static_assert(offsetof(FlightRecorder::FileHeader, channels) == 128, "file header layout changed; update kVersion and the decoder");
+
+size_t FlightRecorder::fileBytes() noexcept
+{
+    return channelOffset(kNumChannels);
+}
+
+uint32_t FlightRecorder::currentThreadId() noexcept
+{
+    // OS の問い合わせはスレッドごとに 1 回だけ (Audio Thread でも以後は読むだけ)
+    thread_local uint32_t cached = 0;
+    if (cached == 0)
+    {
+#ifdef _WIN32
+        cached = static_cast<uint32_t>(::GetCurrentThreadId());
+#else
+        cached = static_cast<uint32_t>(std::hash<std::thread::id> {}(std::this_thread::get_id())) | 1u;
+#endif
+    }
+    return cached;
+}
+
+//============================================================================
+// create / ~FlightRecorder ─ Message Thread (AudioEngine の構築・破棄)
+//============================================================================
+std::unique_ptr<FlightRecorder> FlightRecorder::create(const std::filesystem::path& file,
+                                                       const std::filesystem::path& previousFile)
+{
+    for (size_t c = 0; c < kNumChannels; ++c)
+        if (!isPowerOfTwo(kChannelCapacity[c]))
+            return nullptr;
+
+    // 前回のセッションを残す (クラッシュ後に decode できるように)。失敗しても新しいファイルは作る
+    std::error_code ec;
+    if (std::filesystem::exists(file, ec))
+    {
+        if (!previousFile.empty())
+            std::filesystem::rename(file, previousFile, ec);
+        else
+            std::filesystem::remove(file, ec);
+    }
+
+    std::unique_ptr<FlightRecorder> recorder(new (std::nothrow) FlightRecorder());
+    if (recorder == nullptr)
+        return nullptr;
+    recorder->path_ = file;
+    const size_t bytes = fileBytes();
+
+#ifdef _WIN32
+    // FILE_SHARE_READ: 生きている (ハングした) プロセスのファイルもデコーダから読める
+    HANDLE fileHandle = ::CreateFileW(file.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                      FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return nullptr;
+    recorder->fileHandle_ = fileHandle;
+
+    const auto size64 = static_cast<uint64_t>(bytes);
+    HANDLE mapping = ::CreateFileMappingW(fileHandle, nullptr, PAGE_READWRITE,
+                                          static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu),
+                                          nullptr);
+    if (mapping == nullptr)
+        return nullptr;
+    recorder->mappingHandle_ = mapping;
+
+    void* view = ::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (view == nullptr)
+        return nullptr;
+#else
+    const int fd = ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return nullptr;
+    recorder->fd_ = fd;
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+        return nullptr;
+    void* view = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED)
+        return nullptr;
+#endif
+    recorder->view_ = view;
+    recorder->viewBytes_ = bytes;
+
+    // 全ページを先に触れておく (Audio Thread の最初の書き込みでページフォルトさせない)。
+    // 新しいファイルは 0 埋めなので sequence == 0 (空) から始まる
+    auto* base = static_cast<uint8_t*>(view);
+    for (size_t offset = 0; offset < bytes; offset += 4096)
+        base[offset] = 0;
+#ifdef _WIN32
+    ::VirtualLock(view, static_cast<SIZE_T>(bytes));   // 失敗しても続行 (ワーキングセット上限)
+#else
+    ::mlock(view, bytes);
+#endif
+
+    // マップ上の atomic は 0 埋め = 値 0 のまま使う (構築はここで一度だけ)
+    auto* header = new (view) FileHeader();
+    std::memcpy(header->magic, kMagic, sizeof(kMagic));
+    header->version = kVersion;
+    header->recordBytes = kRecordBytes;
+    header->channelCount = static_cast<uint32_t>(kNumChannels);
+    header->headerBytes = kHeaderBytes;
+    header->processId = currentProcessId();
+    header->sessionStartSteadyUs = convo::getCurrentTimeUs();
+    header->sessionStartUnixUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    for (size_t c = 0; c < kNumChannels; ++c)
+    {
+        ChannelHeader& channel = header->channels[c];
+        channel.offset = channelOffset(c);
+        channel.capacity = kChannelCapacity[c];
+        channel.channelId = static_cast<uint32_t>(c);
+        copyFlightText(channel.name, kChannelNames[c]);
+        auto* records = reinterpret_cast<Record*>(base + channel.offset);
+        for (uint32_t i = 0; i < kChannelCapacity[c]; ++i)
+            new (records + i) Record;
+        recorder->channelRecords_[c] = records;
+    }
+    recorder->header_ = header;
+    // release: ヘッダを書き終えてから Running を公開する (外から読むデコーダ向け)
+    convo::publishAtomic(header->state, static_cast<uint32_t>(SessionState::Running), std::memory_order_release);
+    return recorder;
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    if (header_ != nullptr)
+        convo::publishAtomic(header_->state, static_cast<uint32_t>(SessionState::Closed), std::memory_order_release); // release: 最後の書き込みの後に正常終了の印
+#ifdef _WIN32
+    if (view_ != nullptr)
+    {
+        ::FlushViewOfFile(view_, 0);
+        ::UnmapViewOfFile(view_);
+    }
+    if (mappingHandle_ != nullptr)
+        ::CloseHandle(static_cast<HANDLE>(mappingHandle_));
+    if (fileHandle_ != nullptr)
+        ::CloseHandle(static_cast<HANDLE>(fileHandle_));
+#else
+    if (view_ != nullptr)
+    {
+        ::msync(view_, viewBytes_, MS_ASYNC);
+        ::munmap(view_, viewBytes_);
+    }
+    if (fd_ >= 0)
+        ::close(fd_);
+#endif
+}
+
+void FlightRecorder::writeLifecycle(uint32_t code, const char* name, const char* origin, uint64_t timestampUs) noexcept
+{
+    FlightLifecyclePayload payload {};
+    payload.code = code;
+    char text[sizeof(payload.text)] {};
+    size_t length = 0;
+    for (const char* part : { name, " @ ", origin })
+        for (const char* p = (part != nullptr ? part : ""); *p != '\0' && length + 1 < sizeof(text); ++p)
+            text[length++] = *p;
+    std::memcpy(payload.text, text, sizeof(text));
+    convo::publishAtomic(header_->lifecycleCode, code, std::memory_order_relaxed); // relaxed: 外から読むだけの値
+    writePod(FlightChannel::Lifecycle, FlightRecordKind::Lifecycle, payload, timestampUs);
+}
+
+//============================================================================
+// decode ─ 任意のスレッド (ファイルの写しを読むだけ)
+//============================================================================
+FlightRecorder::DecodedFile FlightRecorder::decode(const uint8_t* image, size_t bytes)
+{
+    DecodedFile out;
+    if (image == nullptr || bytes < kHeaderBytes || std::memcmp(image, kMagic, sizeof(kMagic)) != 0)
+        return out;
+    if (readPlain<uint32_t>(image + offsetof(FileHeader, version)) != kVersion
+        || readPlain<uint32_t>(image + offsetof(FileHeader, recordBytes)) != kRecordBytes)
+        return out;
+
+    const uint32_t channelCount = std::min<uint32_t>(readPlain<uint32_t>(image + offsetof(FileHeader, channelCount)),
+                                                     static_cast<uint32_t>(kNumChannels));
+    out.state = static_cast<SessionState>(readPlain<uint32_t>(image + offsetof(FileHeader, state)));
+    out.processId = readPlain<uint64_t>(image + offsetof(FileHeader, processId));
+    out.sessionStartSteadyUs = readPlain<uint64_t>(image + offsetof(FileHeader, sessionStartSteadyUs));
+    out.sessionStartUnixUs = readPlain<uint64_t>(image + offsetof(FileHeader, sessionStartUnixUs));
+    out.heartbeatUs = readPlain<uint64_t>(image + offsetof(FileHeader, heartbeatUs));
+    out.heartbeatCallbackIndex = readPlain<uint64_t>(image + offsetof(FileHeader, heartbeatCallbackIndex));
+    out.lifecycleCode = readPlain<uint32_t>(image + offsetof(FileHeader, lifecycleCode));
+
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+        const uint8_t* channel = image + offsetof(FileHeader, channels) + sizeof(ChannelHeader) * c;
+        const uint64_t offset = readPlain<uint64_t>(channel + offsetof(ChannelHeader, offset));
+        const uint32_t capacity = readPlain<uint32_t>(channel + offsetof(ChannelHeader, capacity));
+        out.written[c] = readPlain<uint64_t>(channel + offsetof(ChannelHeader, writeIndex));
+        if (!isPowerOfTwo(capacity) || offset + static_cast<uint64_t>(capacity) * kRecordBytes > bytes)
+            return out;
+
+        for (uint32_t slot = 0; slot < capacity; ++slot)
+        {
+            const uint8_t* record = image + offset + static_cast<uint64_t>(slot) * kRecordBytes;
+            const uint64_t sequence = readPlain<uint64_t>(record + offsetof(Record, sequence));
+            // 空・書きかけ・別の周回の途中で上書きされたスロットは捨てる
+            if (sequence == 0 || ((sequence - 1) & (capacity - 1)) != slot)
+                continue;
+            DecodedRecord decoded;
+            decoded.channel = static_cast<FlightChannel>(c);
+            decoded.kind = static_cast<FlightRecordKind>(readPlain<uint16_t>(record + offsetof(Record, kind)));
+            decoded.sequence = sequence;
+            decoded.timestampUs = readPlain<uint64_t>(record + offsetof(Record, timestampUs));
+            decoded.threadId = readPlain<uint32_t>(record + offsetof(Record, threadId));
+            const uint16_t payloadBytes = std::min<uint16_t>(readPlain<uint16_t>(record + offsetof(Record, payloadBytes)),
+                                                             static_cast<uint16_t>(kPayloadBytes));
+            const uint8_t* payload = record + offsetof(Record, payload);
+            decoded.payload.assign(payload, payload + payloadBytes);
+            out.records.push_back(std::move(decoded));
+        }
+    }
+
+    std::stable_sort(out.records.begin(), out.records.end(), [](const DecodedRecord& a, const DecodedRecord& b)
+    {
+        if (a.timestampUs != b.timestampUs)
+            return a.timestampUs < b.timestampUs;
+        if (a.channel != b.channel)
+            return a.channel < b.channel;
+        return a.sequence < b.sequence;
+    });
+    out.valid = true;
+    return out;
+}
+
+} // namespace convo
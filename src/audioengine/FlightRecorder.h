@@ -0,0 +1,328 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "AtomicAccess.h"
+
+//==============================================================================
+// FlightRecorder — クラッシュ・強制終了後も残る常時記録 (メモリマップしたファイル上の固定長リング)
+//
+//   TelemetryRecorder の各リング・FailureSnapshot・XrunIncident・shutdown フェーズ (診断ビルドでは
+//   DiagEvent も) を 128 byte の固定長レコードとしてチャネル別のリングへ書く。
+//   リングはファイルを共有マップしたメモリそのものなので、書いた内容はプロセスが落ちても
+//   OS のページキャッシュ経由でファイルに残る (OS ごと落ちた場合は保証しない)。
+//   tools/decode_flight_recorder.py が全チャネルを時刻順に並べたタイムラインへ戻す。
+//
+//   書き込み: 任意のスレッド (Audio Thread を含む)。チャネルの書き込み位置への fetch_add 1 回 +
+//             128 byte のコピーで、待たない・確保しない。ページは create() で事前に触れておく
+//   ファイル: 前回のセッションのファイルは create() が previousFile へ移してから作り直す。
+//             ヘッダの state が Running のまま残っていれば前回は正常終了していない
+//
+//   ★ レイアウト (リトルエンディアン、version 1。変えたら kVersion とデコーダを合わせて更新する)
+//     [0, 4096)            FileHeader (チャネル表を含む)
+//     [4096, ...)          チャネル 0, 1, ... のレコード配列 (各 capacity × 128 byte、capacity は 2 のべき)
+//     レコード: sequence (0 = 空 / 書き込み中、それ以外 = 書き込み番号 + 1) を最後に書く。
+//     デコーダは sequence − 1 の下位ビットがスロット番号と一致するものだけを採る
+//==============================================================================
+
+namespace convo {
+
+enum class FlightChannel : uint8_t
+{
+    Failure = 0,    // FailureRecord / FailureSnapshot
+    Progress,       // PublicationProgressRecord
+    Retire,         // RetireTimelineRecord
+    Xrun,           // XrunIncident
+    Diag,           // DiagEvent (診断ビルドのみ)
+    Lifecycle,      // shutdown フェーズなどの節目
+    Count
+};
+
+enum class FlightRecordKind : uint16_t
+{
+    None = 0,
+    Failure = 1,
+    FailureSnapshot = 2,
+    Progress = 3,
+    RetireTimeline = 4,
+    XrunIncident = 5,
+    DiagEvent = 6,
+    Lifecycle = 7
+};
+
+// ── レコードの中身 (POD、ポインタを持たない) ──
+
+struct FlightFailurePayload
+{
+    uint64_t correlationIdShort;
+    uint8_t stage;
+    uint8_t reason;
+    uint8_t reserved[6];
+    char origin[48];                 // 発生箇所 (NUL 終端、切り詰め)
+};
+
+struct FlightFailureSnapshotPayload
+{
+    uint64_t correlationIdShort;
+    uint64_t publicationSequenceId;
+    uint64_t generation;
+    uint64_t worldId;
+    uint64_t threadId;
+    uint64_t coordinatorState;
+    uint64_t shutdownPhase;
+    uint64_t publicationClass;
+    uint64_t activeReaderCount;
+    uint64_t minReaderEpoch;
+    uint64_t currentEpoch;
+    uint8_t stage;
+    uint8_t reason;
+    uint8_t reserved[6];
+};
+
+struct FlightProgressPayload
+{
+    uint64_t correlationIdShort;
+    uint64_t generation;
+    uint64_t worldId;
+    uint8_t stage;
+    uint8_t reserved[7];
+};
+
+struct FlightRetireTimelinePayload
+{
+    uint64_t publicationSequenceId;
+    uint64_t generation;
+    uint64_t worldId;
+    uint64_t retireEpoch;
+    uint64_t reclaimEpoch;
+};
+
+struct FlightXrunPayload
+{
+    uint64_t callbackIndex;
+    uint64_t startUs;
+    uint32_t callbackUs;
+    uint32_t intervalUs;
+    uint32_t expectedUs;
+    uint32_t cpu;
+    uint32_t prevCpu;
+    uint32_t flags;
+    uint64_t stageCycles[6];         // DspStage 順
+};
+
+struct FlightLifecyclePayload
+{
+    uint32_t code;                   // ShutdownPhase など (呼び出し側の列挙値)
+    uint32_t reserved;
+    char text[96];                   // "名前 @ 発生箇所" (NUL 終端、切り詰め)
+};
+
+#pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+
+class FlightRecorder
+{
+public:
+    static constexpr char kMagic[8] = { 'C', 'P', 'F', 'L', 'T', 'R', 'E', 'C' };
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kHeaderBytes = 4096;
+    static constexpr uint32_t kRecordBytes = 128;
+    static constexpr uint32_t kPayloadBytes = 104;
+    static constexpr uint32_t kMaxChannels = 8;
+    static constexpr size_t kNumChannels = static_cast<size_t>(FlightChannel::Count);
+
+    // チャネルごとの容量。頻度の高いチャネルが稀なチャネルを押し流さないよう分けている
+    static constexpr std::array<uint32_t, kNumChannels> kChannelCapacity {
+        1024,   // Failure
+        4096,   // Progress
+        4096,   // Retire
+        1024,   // Xrun
+        8192,   // Diag
+        256     // Lifecycle
+    };
+
+    enum class SessionState : uint32_t
+    {
+        Empty = 0,
+        Running = 1,
+        Closed = 2     // デストラクタまで到達した (正常終了)
+    };
+
+    struct alignas(64) ChannelHeader
+    {
+        uint64_t offset;                     // ファイル先頭からのバイト位置
+        uint32_t capacity;
+        uint32_t channelId;
+        char name[16];
+        std::atomic<uint64_t> writeIndex;    // 次に書く番号 (単調増加)
+        uint8_t reserved[24];
+    };
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t recordBytes;
+        uint32_t channelCount;
+        uint32_t headerBytes;
+        uint64_t processId;
+        uint64_t sessionStartSteadyUs;           // getCurrentTimeUs() の基準
+        uint64_t sessionStartUnixUs;             // 同時刻の UNIX 時刻 (デコーダが壁時計へ換算する)
+        std::atomic<uint32_t> state;             // SessionState
+        uint32_t reserved0;
+        std::atomic<uint64_t> heartbeatUs;       // Timer が更新 (止まっていれば Message Thread のハング)
+        std::atomic<uint64_t> heartbeatCallbackIndex;   // 同時刻の Audio コールバック番号 (止まっていれば Audio 側の停止)
+        std::atomic<uint32_t> lifecycleCode;     // 最後に通った shutdown フェーズ
+        uint32_t reserved1;
+        uint8_t reserved2[48];
+        ChannelHeader channels[kMaxChannels];
+    };
+
+    struct alignas(64) Record
+    {
+        std::atomic<uint64_t> sequence;
+        uint64_t timestampUs;
+        uint16_t kind;                       // FlightRecordKind
+        uint16_t payloadBytes;
+        uint32_t threadId;
+        uint8_t payload[kPayloadBytes];
+    };
+
+    // file を作り直してマップする。既存の file は previousFile (空なら削除) へ移す。失敗したら nullptr
+    static std::unique_ptr<FlightRecorder> create(const std::filesystem::path& file,
+                                                  const std::filesystem::path& previousFile = {});
+    ~FlightRecorder();   // state を Closed にしてマップを閉じる
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // 任意のスレッド。wait-free。payload は kPayloadBytes を超えた分を切り捨てる
+    void write(FlightChannel channel, FlightRecordKind kind, const void* payload, size_t bytes,
+               uint64_t timestampUs) noexcept
+    {
+        ChannelHeader& header = header_->channels[static_cast<size_t>(channel)];
+        // relaxed: スロットの払い出しのみ (中身の公開は sequence の release が担う)
+        const uint64_t index = convo::fetchAddAtomic(header.writeIndex, uint64_t{1}, std::memory_order_relaxed);
+        Record& record = channelRecords_[static_cast<size_t>(channel)][index & (header.capacity - 1)];
+
+        // relaxed: 書き込み中の印。プロセス内の順序は下の release が保ち、クラッシュ後の読み出しは
+        //          sequence とスロット番号の照合で書きかけを捨てる
+        convo::publishAtomic(record.sequence, uint64_t{0}, std::memory_order_relaxed);
+        const size_t copied = bytes < kPayloadBytes ? bytes : kPayloadBytes;
+        record.timestampUs = timestampUs;
+        record.kind = static_cast<uint16_t>(kind);
+        record.payloadBytes = static_cast<uint16_t>(copied);
+        record.threadId = currentThreadId();
+        std::memcpy(record.payload, payload, copied);
+        if (copied < kPayloadBytes)
+            std::memset(record.payload + copied, 0, kPayloadBytes - copied);
+        convo::publishAtomic(record.sequence, index + 1, std::memory_order_release); // release: 中身を書いてから有効にする (生きているプロセスを外から読む場合)
+    }
+
+    template <typename Payload>
+    void writePod(FlightChannel channel, FlightRecordKind kind, const Payload& payload, uint64_t timestampUs) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<Payload>, "flight records are copied as raw bytes");
+        static_assert(sizeof(Payload) <= kPayloadBytes, "flight record payload too large");
+        write(channel, kind, &payload, sizeof(Payload), timestampUs);
+    }
+
+    // Message Thread (Timer)。ハング判定用の生存印
+    void heartbeat(uint64_t nowUs, uint64_t callbackIndex) noexcept
+    {
+        convo::publishAtomic(header_->heartbeatCallbackIndex, callbackIndex, std::memory_order_relaxed); // relaxed: 外から読むだけの値
+        convo::publishAtomic(header_->heartbeatUs, nowUs, std::memory_order_relaxed); // relaxed: 同上
+    }
+
+    // 任意のスレッド (NonRT)。節目を Lifecycle チャネルへ書き、ヘッダにも最後の code を残す
+    void writeLifecycle(uint32_t code, const char* name, const char* origin, uint64_t timestampUs) noexcept;
+
+    [[nodiscard]] uint64_t writtenCount(FlightChannel channel) const noexcept
+    {
+        return convo::consumeAtomic(header_->channels[static_cast<size_t>(channel)].writeIndex,
+                                    std::memory_order_relaxed); // relaxed: 統計
+    }
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return path_; }
+    [[nodiscard]] static size_t fileBytes() noexcept;
+
+    // ── 読み出し (ファイルの中身 → レコード列)。テストと C++ 側の確認用。形式の正本はデコーダと同じ ──
+    struct DecodedRecord
+    {
+        FlightChannel channel = FlightChannel::Count;
+        FlightRecordKind kind = FlightRecordKind::None;
+        uint64_t sequence = 0;               // 書き込み番号 + 1
+        uint64_t timestampUs = 0;
+        uint32_t threadId = 0;
+        std::vector<uint8_t> payload;
+    };
+
+    struct DecodedFile
+    {
+        bool valid = false;
+        SessionState state = SessionState::Empty;
+        uint64_t processId = 0;
+        uint64_t sessionStartSteadyUs = 0;
+        uint64_t sessionStartUnixUs = 0;
+        uint64_t heartbeatUs = 0;
+        uint64_t heartbeatCallbackIndex = 0;
+        uint32_t lifecycleCode = 0;
+        std::array<uint64_t, kNumChannels> written {};   // チャネルごとの総書き込み数 (上書き分を含む)
+        std::vector<DecodedRecord> records;              // 時刻順 (同時刻はチャネル・書き込み順)
+    };
+
+    [[nodiscard]] static DecodedFile decode(const uint8_t* image, size_t bytes);
+
+private:
+    FlightRecorder() = default;
+
+    static uint32_t currentThreadId() noexcept;
+
+    std::filesystem::path path_;
+    void* view_ = nullptr;
+    size_t viewBytes_ = 0;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    FileHeader* header_ = nullptr;
+    std::array<Record*, kNumChannels> channelRecords_ {};
+};
+
+#pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+
+static_assert(sizeof(FlightRecorder::Record) == FlightRecorder::kRecordBytes, "flight record layout changed; update kVersion and the decoder");
+static_assert(sizeof(FlightRecorder::ChannelHeader) == 64, "channel header layout changed; update kVersion and the decoder");
+static_assert(sizeof(FlightRecorder::FileHeader) <= FlightRecorder::kHeaderBytes, "file header must fit in the first page");
+static_assert(FlightRecorder::kNumChannels <= FlightRecorder::kMaxChannels);
+static_assert(std::atomic<uint64_t>::is_always_lock_free && sizeof(std::atomic<uint64_t>) == 8,
+              "mapped atomics must be plain 64-bit words");
+static_assert(sizeof(FlightFailurePayload) == 64);
+static_assert(sizeof(FlightFailureSnapshotPayload) == 96);
+static_assert(sizeof(FlightProgressPayload) == 32);
+static_assert(sizeof(FlightRetireTimelinePayload) == 40);
+static_assert(sizeof(FlightXrunPayload) == 88);
+static_assert(sizeof(FlightLifecyclePayload) == 104);
+
+// 固定長の文字列欄へ NUL 終端で写す (nullptr は空文字)
+template <size_t N>
+inline void copyFlightText(char (&out)[N], const char* text) noexcept
+{
+    size_t i = 0;
+    if (text != nullptr)
+        for (; i + 1 < N && text[i] != '\0'; ++i)
+            out[i] = text[i];
+    std::memset(out + i, 0, N - i);
+}
+
+} // namespace convo
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+//==============================================================================
+// FusedInputStage — 入力段の DC ブロッカーより前を 1 パスで回す融合カーネル
+//
+//   DSPCore::processInput / processInputDouble は
+//     float→double 変換 (コピー) → NaN/デノーマル除去 + [-1, 1] クランプ → NaN/Inf 除去 → ピーク計測
+//     → ヘッドルームゲイン
+//   をそれぞれ全サンプル走査していた。これらはすべてメモリレスなので、4 サンプル単位の AVX2 で
+//   レジスタ上に通し、aligned 作業バッファへ 1 回だけ書く。モノラル入力は同じ値を両チャンネルへ書く。
+//
+//   ピークはゲイン前の値で測る (入力メーターは従来どおりヘッドルーム前の入力レベルを示す)。
+//   Analyzer の入力タップもゲイン前の波形を見るため、タップ有効かつゲイン ≠ 1 のときは
+//   呼び出し側が ApplyGain = false で回し、タップへ渡した後にゲインを掛ける。
+//
+//   非有限値は常に 0 にする。旧経路はベクトル部で ±Inf を ±1 にクランプし、端数のスカラー部だけ 0 にしていた。
+//   DC ブロッカー (IIR) は状態を持つのでこのカーネルに含めない。
+//==============================================================================
+
+namespace convo::input {
+
+struct FusedInputParams
+{
+    double gain = 1.0;              // ApplyGain = true のとき
+    double denormThreshold = 0.0;   // |x| < threshold は 0 (InputBitDepthTransform の kDenormThreshold)
+    double limit = 1.0;             // クランプ上限
+};
+
+namespace detail {
+
+inline bool isFinite(double x) noexcept
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return ((bits >> 52) & 0x7FFu) != 0x7FFu;
+}
+
+inline __m256d loadVector(const float* src) noexcept
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(src));
+}
+
+inline __m256d loadVector(const double* src) noexcept
+{
+    return _mm256_loadu_pd(src);
+}
+
+// 非有限・デノーマル閾値未満を 0 にし、±limit へクランプする
+inline __m256d sanitize(__m256d v, __m256d vThreshold, __m256d vLimit, __m256d vNegLimit) noexcept
+{
+    const __m256d vAbs = _mm256_andnot_pd(_mm256_set1_pd(-0.0), v);
+    // |x| <= DBL_MAX で NaN と ±Inf を同時に落とす (NaN は比較が false)
+    const __m256d finite = _mm256_cmp_pd(vAbs, _mm256_set1_pd(1.7976931348623157e308), _CMP_LE_OQ);
+    const __m256d aboveThreshold = _mm256_cmp_pd(vAbs, vThreshold, _CMP_GE_OQ);
+    v = _mm256_and_pd(v, _mm256_and_pd(finite, aboveThreshold));
+    return _mm256_min_pd(_mm256_max_pd(v, vNegLimit), vLimit);
+}
+
+inline double sanitize(double v, const FusedInputParams& params) noexcept
+{
+    if (!isFinite(v) || (v < 0.0 ? -v : v) < params.denormThreshold)
+        v = 0.0;
+    return std::clamp(v, -params.limit, params.limit);
+}
+
+// 1 チャンネルを処理してゲイン前のピーク (|x| の最大) を返す。dstMirror != nullptr なら同じ値も書く
+template <bool ApplyGain, typename Src>
+inline double runChannel(const Src* src, double* dst, double* dstMirror, int numSamples,
+                         const FusedInputParams& params) noexcept
+{
+    const __m256d vThreshold = _mm256_set1_pd(params.denormThreshold);
+    const __m256d vLimit = _mm256_set1_pd(params.limit);
+    const __m256d vNegLimit = _mm256_set1_pd(-params.limit);
+    const __m256d vGain = _mm256_set1_pd(params.gain);
+    const __m256d vSignMask = _mm256_set1_pd(-0.0);
+    __m256d vPeak = _mm256_setzero_pd();
+
+    int i = 0;
+    const int vEnd = numSamples / 4 * 4;
+    for (; i < vEnd; i += 4)
+    {
+        __m256d v = sanitize(loadVector(src + i), vThreshold, vLimit, vNegLimit);
+        vPeak = _mm256_max_pd(vPeak, _mm256_andnot_pd(vSignMask, v));
+        if constexpr (ApplyGain)
+            v = _mm256_mul_pd(v, vGain);
+        _mm256_storeu_pd(dst + i, v);
+        if (dstMirror != nullptr)
+            _mm256_storeu_pd(dstMirror + i, v);
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, vPeak);
+    double peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+
+    for (; i < numSamples; ++i)
+    {
+        double v = sanitize(static_cast<double>(src[i]), params);
+        peak = std::max(peak, v < 0.0 ? -v : v);
+        if constexpr (ApplyGain)
+            v *= params.gain;
+        dst[i] = v;
+        if (dstMirror != nullptr)
+            dstMirror[i] = v;
+    }
+    return peak;
+}
+
+} // namespace detail
+
+// srcL / srcR (srcR == nullptr でモノラル: dstR へ L を複製) を dstL / dstR へ書き、
+// 両チャンネルのゲイン前ピークを返す。srcL == nullptr なら両チャンネルを 0 にして 0 を返す
+template <bool ApplyGain, typename Src>
+double runFusedInputStage(const Src* srcL, const Src* srcR, double* dstL, double* dstR, int numSamples,
+                          const FusedInputParams& params) noexcept
+{
+    if (dstL == nullptr || dstR == nullptr || numSamples <= 0)
+        return 0.0;
+
+    if (srcL == nullptr)
+    {
+        std::fill(dstL, dstL + numSamples, 0.0);
+        std::fill(dstR, dstR + numSamples, 0.0);
+        return 0.0;
+    }
+
+    if (srcR == nullptr)
+        return detail::runChannel<ApplyGain>(srcL, dstL, dstR, numSamples, params);
+
+    const double peakL = detail::runChannel<ApplyGain>(srcL, dstL, nullptr, numSamples, params);
+    const double peakR = detail::runChannel<ApplyGain>(srcR, dstR, nullptr, numSamples, params);
+    return std::max(peakL, peakR);
+}
+
+} // namespace convo::input
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+//==============================================================================
+// FusedOutputStage — 出力段のノイズシェーパー以降を 1 パスで回す融合カーネル
+//
+//   DSPCore::processOutput / processOutputDouble はノイズシェーパーの後に
+//     (ヘッドルーム) → NaN/Inf 除去 → ±limit クランプ → 固定レイテンシ遅延 → デバイスへ書き込み
+//   をそれぞれ全サンプル走査していた。32 サンプル程度の小ブロックでは計算よりメモリ往復が支配的なので、
+//   これらを 4 サンプル単位の AVX2 でレジスタ上に通し、出力先へ直接書く。
+//
+//   段の有無はテンプレート引数でコンパイル時に決める (呼び出し側が実行時フラグから分岐する)。
+//   ゲイン・除去・クランプはメモリレスなので遅延の前後どちらで掛けても結果は同じ。
+//   そこで遅延線には「クランプ前」の値を入れ、読み出した値をクランプして書き込む。
+//
+//   ノイズシェーパー本体 (誤差フィードバック) とその前段 (DC ブロッカー / 適応キャプチャ)、計測 (TruePeak / LUFS)、
+//   ピークリミッタ (LookAheadPeakLimiter: 先読み遅延を持つので呼び出し側がこの直前に回す) はこのカーネルに含めない。
+//==============================================================================
+
+namespace convo::output {
+
+// 固定レイテンシ遅延線 (HistoryRuntimeState の fixedLatency* と同じ意味)。
+// delaySamples <= 0 または buffer == nullptr なら遅延なし。writePos は処理後に進む
+struct FusedOutputDelay
+{
+    double* bufferL = nullptr;
+    double* bufferR = nullptr;
+    int bufferSize = 0;
+    int delaySamples = 0;
+    int writePos = 0;
+};
+
+struct FusedOutputParams
+{
+    double gain = 1.0;              // ApplyGain = true のとき
+    double limit = 1.0;             // 出力の絶対値上限 (ハードクランプ)
+};
+
+namespace detail {
+
+inline bool isFiniteAndBelow(double x, double threshold) noexcept
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    if (((bits >> 52) & 0x7FFu) == 0x7FFu)
+        return false;
+    bits &= 0x7FFFFFFFFFFFFFFFull;
+    double absValue = 0.0;
+    std::memcpy(&absValue, &bits, sizeof(absValue));
+    return absValue < threshold;
+}
+
+template <bool ApplyGain, bool Scrub>
+inline double preDelay(double v, double gain) noexcept
+{
+    if constexpr (ApplyGain)
+        v *= gain;
+    if constexpr (Scrub)
+        if (!isFiniteAndBelow(v, 1.0e300))
+            v = 0.0;
+    return v;
+}
+
+template <bool ApplyGain, bool Scrub>
+inline __m256d preDelay(__m256d v, __m256d vGain) noexcept
+{
+    if constexpr (ApplyGain)
+        v = _mm256_mul_pd(v, vGain);
+    if constexpr (Scrub)
+    {
+        const __m256d ordered = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+        const __m256d below = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), v),
+                                            _mm256_set1_pd(1.0e300), _CMP_LT_OQ);
+        v = _mm256_and_pd(v, _mm256_and_pd(ordered, below));
+    }
+    return v;
+}
+
+template <typename Dst>
+inline void storeSample(Dst* dst, double v) noexcept
+{
+    *dst = static_cast<Dst>(v);
+}
+
+template <typename Dst>
+inline void storeVector(Dst* dst, __m256d v) noexcept
+{
+    if constexpr (sizeof(Dst) == sizeof(float))
+        _mm_storeu_ps(dst, _mm256_cvtpd_ps(v));
+    else
+        _mm256_storeu_pd(dst, v);
+}
+
+// 1 チャンネル・遅延線上で連続する区間。limit は min/max、Dst へ変換して書く
+template <bool ApplyGain, bool Scrub, typename Dst>
+inline void runVectorSegment(const double* src, Dst* dst, double* delayWrite, const double* delayRead,
+                             int count, bool vectorSafe, const FusedOutputParams& params) noexcept
+{
+    const __m256d vGain = _mm256_set1_pd(params.gain);
+    const __m256d vLimit = _mm256_set1_pd(params.limit);
+    const __m256d vNegLimit = _mm256_set1_pd(-params.limit);
+
+    int i = 0;
+    if (vectorSafe)
+    {
+        const int vEnd = count / 4 * 4;
+        for (; i < vEnd; i += 4)
+        {
+            __m256d v = preDelay<ApplyGain, Scrub>(_mm256_loadu_pd(src + i), vGain);
+            if (delayWrite != nullptr)
+            {
+                _mm256_storeu_pd(delayWrite + i, v);
+                v = _mm256_loadu_pd(delayRead + i);
+            }
+            storeVector(dst + i, _mm256_min_pd(_mm256_max_pd(v, vNegLimit), vLimit));
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        double v = preDelay<ApplyGain, Scrub>(src[i], params.gain);
+        if (delayWrite != nullptr)
+        {
+            delayWrite[i] = v;
+            v = delayRead[i];
+        }
+        storeSample(dst + i, std::clamp(v, -params.limit, params.limit));
+    }
+}
+
+} // namespace detail
+
+// srcL / srcR (srcR == nullptr でモノラル) を処理して dstL / dstR へ書く。src と dst は同じ配列でもよい。
+template <bool ApplyGain, bool Scrub, typename Dst>
+void runFusedOutputStage(const double* srcL, const double* srcR, Dst* dstL, Dst* dstR, int numSamples,
+                         const FusedOutputParams& params, FusedOutputDelay& delay) noexcept
+{
+    if (srcL == nullptr || dstL == nullptr || numSamples <= 0)
+        return;
+
+    const bool hasR = (srcR != nullptr && dstR != nullptr);
+    const bool hasDelay = delay.delaySamples > 0 && delay.bufferSize > 0
+        && delay.bufferL != nullptr && (!hasR || delay.bufferR != nullptr);
+    const int delaySamples = hasDelay ? std::min(delay.delaySamples, delay.bufferSize - 1) : 0;
+    // 読み位置が「同じ 4 サンプル内で後から書く位置」に重ならない (bufferSize - delay >= 4) ときだけベクトル化
+    const bool vectorSafe = !hasDelay || (delay.bufferSize - delaySamples) >= 4;
+
+    int writePos = hasDelay ? delay.writePos : 0;
+    int i = 0;
+    while (i < numSamples)
+    {
+        // 書き込み位置と読み出し位置のどちらも折り返さない区間に分ける
+        int count = numSamples - i;
+        int readPos = 0;
+        if (hasDelay)
+        {
+            readPos = writePos - delaySamples;
+            if (readPos < 0)
+                readPos += delay.bufferSize;
+            count = std::min({ count, delay.bufferSize - writePos, delay.bufferSize - readPos });
+        }
+
+        detail::runVectorSegment<ApplyGain, Scrub>(srcL + i, dstL + i,
+                                                    hasDelay ? delay.bufferL + writePos : nullptr,
+                                                    hasDelay ? delay.bufferL + readPos : nullptr,
+                                                    count, vectorSafe, params);
+        if (hasR)
+            detail::runVectorSegment<ApplyGain, Scrub>(srcR + i, dstR + i,
+                                                        hasDelay ? delay.bufferR + writePos : nullptr,
+                                                        hasDelay ? delay.bufferR + readPos : nullptr,
+                                                        count, vectorSafe, params);
+
+        i += count;
+        if (hasDelay)
+        {
+            writePos += count;
+            if (writePos >= delay.bufferSize)
+                writePos = 0;
+        }
+    }
+
+    if (hasDelay)
+        delay.writePos = writePos;
+}
+
+} // namespace convo::output
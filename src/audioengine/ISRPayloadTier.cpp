@@ -52,27 +52,7 @@ void PayloadTierValidator::registerTierDependency(PayloadTier from, PayloadTier
 
 TierRejectReason PayloadTierValidator::explainPublishReject(const TieredPayloadDescriptor& descriptor) const noexcept
 {
-    if (!isValidTier(static_cast<uint32_t>(descriptor.tier))) {
-        return TierRejectReason::InvalidTier;
-    }
-
-    if (descriptor.tier == PayloadTier::Forbidden) {
-        return TierRejectReason::ForbiddenTier;
-    }
-
-    if (descriptor.tier == PayloadTier::RTLocalOnly) {
-        return TierRejectReason::RTLocalLeak;
-    }
-
-    if (descriptor.requiresRT && descriptor.tier == PayloadTier::ExternalPinned && !descriptor.pinnedLifetime) {
-        return TierRejectReason::ExternalPinnedWithoutLifetime;
-    }
-
-    if (descriptor.hasExternalResource && descriptor.tier == PayloadTier::InlineImmutable) {
-        return TierRejectReason::InlineImmutableWithExternalResource;
-    }
-
-    return TierRejectReason::None;
+    return explainTierPublishReject(descriptor);
 }
 
 bool PayloadTierValidator::isPublishAllowed(const TieredPayloadDescriptor& descriptor) const noexcept
@@ -43,6 +43,36 @@ enum class TierRejectReason : uint8_t
     InlineImmutableWithExternalResource
 };
 
+/**
+ * publish 可否の判定本体（constexpr）
+ * PayloadTierValidator::explainPublishReject と静的スキーマ検証
+ * (ISRStaticPublicationSchema.h) の両方がこの 1 箇所を使う。
+ */
+[[nodiscard]] constexpr TierRejectReason explainTierPublishReject(const TieredPayloadDescriptor& descriptor) noexcept
+{
+    if (static_cast<uint32_t>(descriptor.tier) > static_cast<uint32_t>(PayloadTier::Forbidden)) {
+        return TierRejectReason::InvalidTier;
+    }
+
+    if (descriptor.tier == PayloadTier::Forbidden) {
+        return TierRejectReason::ForbiddenTier;
+    }
+
+    if (descriptor.tier == PayloadTier::RTLocalOnly) {
+        return TierRejectReason::RTLocalLeak;
+    }
+
+    if (descriptor.requiresRT && descriptor.tier == PayloadTier::ExternalPinned && !descriptor.pinnedLifetime) {
+        return TierRejectReason::ExternalPinnedWithoutLifetime;
+    }
+
+    if (descriptor.hasExternalResource && descriptor.tier == PayloadTier::InlineImmutable) {
+        return TierRejectReason::InlineImmutableWithExternalResource;
+    }
+
+    return TierRejectReason::None;
+}
+
 /**
  * Payload tier validator
  * publication order を enforce
@@ -0,0 +1,302 @@
+// ISRRetireBatchLane.h
+// 退役のバッチ化: 生産者 (サブシステム × スレッド) ごとの単一生産者レーンと、
+// 封印したバッチを Reclaimer へ渡す MPSC ハンドオフ
+//
+// ★ 目的: 共有 DeferredDeletionQueue (MPMC, 4096 固定) は退役 1 件ごとに enqueuePos の CAS を取り合い、
+//   自動化で EQState / BandNode が大量に退役すると満杯 → tryReclaim → 再試行の overflow 経路に落ちる。
+//   レーンは退役を手元のバッチへ書くだけ (atomic なし) で、バッチ単位で 1 回の CAS で Reclaimer へ渡す。
+//   退役 1 件あたりのコストはバッチ数に比例し、容量はレーンが増設するため共有キューの上限に当たらない。
+//
+// ★ スレッド規約:
+//   RetireBatchLane  — append / seal / grow は所有スレッド (1 本) のみ。recycle は Reclaimer のみ
+//   RetireBatchHandoff — publish は任意の生産者。reclaim / drainAllUnsafe は同時に 1 スレッド
+//                        (内部の try-lock で保証し、取れなければ何もしない)
+//
+// ★ 回収条件は DeferredDeletionQueue と同じ「バッチの epoch < minReaderEpoch」。
+//   バッチには同じ epoch の退役だけを入れる (epoch が変われば封印する) ので、
+//   新しい退役が古い退役の回収を遅らせることはない。バッチ間の FIFO は要求しない
+//   (先頭が回収不可でも後続のバッチは回収できる)。
+//
+// ★ 増設 (grow) は確保を伴うため NonRT 専用。RT の退役は従来どおり ISRRetireRouter::retireRT。
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "AtomicAccess.h"
+
+namespace convo {
+namespace isr {
+
+// 退役を出すサブシステム。レーンは (RetireProducer, スレッド) ごとに 1 本
+enum class RetireProducer : uint8_t
+{
+    EQ = 0,
+    Convolver,
+    Snapshot,
+    Crossfade,
+    Lifetime
+};
+
+class RetireBatchLane;
+
+struct RetireBatch
+{
+    static constexpr uint32_t kCapacity = 32;
+
+    struct Entry
+    {
+        void* ptr = nullptr;
+        void (*deleter)(void*) = nullptr;
+    };
+
+    std::array<Entry, kCapacity> entries {};
+    uint32_t count = 0;
+    uint64_t epoch = 0;
+    RetireBatch* next = nullptr;          // 空きリスト / ハンドオフ / 返却リストの連結 (どれか 1 つにだけ属する)
+    RetireBatchLane* owner = nullptr;
+};
+
+#pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+
+/**
+ * RetireBatchHandoff — 封印済みバッチの MPSC スタック + Reclaimer 側の保留リスト
+ *
+ * publish はバッチ 1 つにつき sealedHead_ への CAS 1 回。Reclaimer は exchange で丸ごと取り出すため
+ * pop 側の ABA は起きない。
+ */
+class RetireBatchHandoff
+{
+public:
+    RetireBatchHandoff() = default;
+    RetireBatchHandoff(const RetireBatchHandoff&) = delete;
+    RetireBatchHandoff& operator=(const RetireBatchHandoff&) = delete;
+
+    // 任意の生産者。batch->entries / count / epoch は呼び出し前に書き終えていること
+    void publish(RetireBatch* batch) noexcept
+    {
+        // relaxed: 診断用の概数 (回収判断には使わない)。CAS より先に足し、回収側の減算で一時的に負へ回らないようにする
+        convo::fetchAddAtomic(sealedEntries_, batch->count, std::memory_order_relaxed);
+        RetireBatch* head = convo::consumeAtomic(sealedHead_, std::memory_order_relaxed); // relaxed: 直後の CAS が失敗時に最新値を読み直す
+        do
+        {
+            batch->next = head;
+        } while (!convo::compareExchangeAtomic(sealedHead_, head, batch,
+                                               std::memory_order_release,   // release: バッチの中身を reclaim の exchange acquire へ公開
+                                               std::memory_order_relaxed)); // relaxed: 失敗時は next を張り直すだけ
+    }
+
+    // epoch < minReaderEpoch のバッチを破棄してレーンへ返す。戻り値は破棄した退役の件数。
+    // 他スレッドが回収中なら何もせず 0
+    uint32_t reclaim(uint64_t minReaderEpoch) noexcept
+    {
+        return reclaimImpl(minReaderEpoch, false);
+    }
+
+    // Shutdown 専用: epoch を見ずに全バッチを破棄する
+    uint32_t drainAllUnsafe() noexcept
+    {
+        return reclaimImpl(0, true);
+    }
+
+    // 未回収の退役件数 (封印済み + 保留中、概数)
+    [[nodiscard]] uint32_t pendingEntryCount() const noexcept
+    {
+        return convo::consumeAtomic(sealedEntries_, std::memory_order_relaxed); // relaxed: 診断・ドレイン待ちのポーリング用
+    }
+
+    [[nodiscard]] uint64_t reclaimedBatchCount() const noexcept
+    {
+        return convo::consumeAtomic(reclaimedBatches_, std::memory_order_relaxed); // relaxed: 統計
+    }
+
+private:
+    static bool isOlder(uint64_t a, uint64_t b) noexcept
+    {
+        return static_cast<int64_t>(a - b) < 0;
+    }
+
+    inline uint32_t reclaimImpl(uint64_t minReaderEpoch, bool ignoreEpoch) noexcept;
+
+    alignas(64) std::atomic<RetireBatch*> sealedHead_ { nullptr };
+    alignas(64) std::atomic<bool> reclaiming_ { false };
+    RetireBatch* pending_ = nullptr;       // reclaiming_ を取ったスレッドのみ
+    std::atomic<uint32_t> sealedEntries_ { 0 };
+    std::atomic<uint64_t> reclaimedBatches_ { 0 };
+};
+
+/**
+ * RetireBatchLane — 1 生産者スレッド専用のバッチ列
+ *
+ * 空きバッチは所有スレッド専用の free_ と、Reclaimer が返却する recycled_ (MPSC スタック、
+ * 所有スレッドが exchange で丸ごと引き取る) の 2 段。どちらも空なら grow() で増設する
+ * (kMaxBatches まで。超えたら呼び出し側が共有キューへフォールバックする)。
+ */
+class RetireBatchLane
+{
+public:
+    static constexpr uint32_t kInitialBatches = 4;
+    static constexpr uint32_t kMaxBatches = 256;   // 退役 8192 件ぶん
+
+    RetireBatchLane(RetireProducer producer, std::uintptr_t threadKey)
+        : producer_(producer), threadKey_(threadKey)
+    {
+        storage_.reserve(kMaxBatches);   // grow() で再配置させない
+        for (uint32_t i = 0; i < kInitialBatches; ++i)
+            (void)grow();
+    }
+
+    RetireBatchLane(const RetireBatchLane&) = delete;
+    RetireBatchLane& operator=(const RetireBatchLane&) = delete;
+
+    // ── 所有スレッドのみ ──
+
+    // 開いているバッチへ追加する。満杯または epoch が変わる場合は先に封印して handoff へ渡す。
+    // 空きバッチが無ければ false (呼び出し側は回収・増設してから再試行する)
+    [[nodiscard]] bool tryAppend(void* ptr, void (*deleter)(void*), uint64_t epoch,
+                                 RetireBatchHandoff& handoff) noexcept
+    {
+        if (open_ != nullptr && (open_->count == RetireBatch::kCapacity || open_->epoch != epoch))
+            seal(handoff);
+        if (open_ == nullptr)
+        {
+            open_ = takeFreeBatch();
+            if (open_ == nullptr)
+                return false;
+            open_->epoch = epoch;
+        }
+        open_->entries[open_->count++] = RetireBatch::Entry { ptr, deleter };
+        return true;
+    }
+
+    // 開いているバッチを handoff へ渡す (空なら何もしない)
+    void seal(RetireBatchHandoff& handoff) noexcept
+    {
+        if (open_ == nullptr)
+            return;
+        RetireBatch* batch = open_;
+        open_ = nullptr;
+        handoff.publish(batch);
+        ++handedOffBatches_;
+    }
+
+    // バッチを 1 つ確保して空きに加える。上限到達・確保失敗なら false
+    bool grow() noexcept
+    {
+        if (storage_.size() >= kMaxBatches)
+            return false;
+        auto* batch = new (std::nothrow) RetireBatch();
+        if (batch == nullptr)
+            return false;
+        batch->owner = this;
+        storage_.emplace_back(batch);   // reserve 済み (確保なし)
+        batch->next = free_;
+        free_ = batch;
+        return true;
+    }
+
+    [[nodiscard]] bool hasOpenBatch() const noexcept { return open_ != nullptr; }
+    [[nodiscard]] uint64_t handedOffBatches() const noexcept { return handedOffBatches_; }
+    [[nodiscard]] uint32_t allocatedBatches() const noexcept { return static_cast<uint32_t>(storage_.size()); }
+
+    // ── Reclaimer のみ ──
+
+    // 破棄済み (count == 0) のバッチを返す
+    void recycle(RetireBatch* batch) noexcept
+    {
+        RetireBatch* head = convo::consumeAtomic(recycled_, std::memory_order_relaxed); // relaxed: CAS 失敗時に読み直す
+        do
+        {
+            batch->next = head;
+        } while (!convo::compareExchangeAtomic(recycled_, head, batch,
+                                               std::memory_order_release,   // release: count = 0 を takeFreeBatch の exchange acquire へ公開
+                                               std::memory_order_relaxed)); // relaxed: 失敗時は next を張り直すだけ
+    }
+
+    // ── 任意のスレッド (不変) ──
+    [[nodiscard]] RetireProducer producer() const noexcept { return producer_; }
+    [[nodiscard]] std::uintptr_t threadKey() const noexcept { return threadKey_; }
+
+private:
+    RetireBatch* takeFreeBatch() noexcept
+    {
+        if (free_ == nullptr)
+            free_ = convo::exchangeAtomic(recycled_, static_cast<RetireBatch*>(nullptr),
+                                          std::memory_order_acquire); // acquire: recycle の release と HB (破棄済みの中身を観測)
+        RetireBatch* batch = free_;
+        if (batch != nullptr)
+        {
+            free_ = batch->next;
+            batch->next = nullptr;
+        }
+        return batch;
+    }
+
+    const RetireProducer producer_;
+    const std::uintptr_t threadKey_;
+    std::vector<std::unique_ptr<RetireBatch>> storage_;   // 所有スレッドのみ (grow)
+    RetireBatch* free_ = nullptr;                         // 所有スレッドのみ
+    RetireBatch* open_ = nullptr;                         // 所有スレッドのみ
+    uint64_t handedOffBatches_ = 0;                       // 所有スレッドのみ
+    alignas(64) std::atomic<RetireBatch*> recycled_ { nullptr };
+};
+
+#pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+
+inline uint32_t RetireBatchHandoff::reclaimImpl(uint64_t minReaderEpoch, bool ignoreEpoch) noexcept
+{
+    if (convo::exchangeAtomic(reclaiming_, true, std::memory_order_acquire)) // acquire: 前の回収者の release と HB (pending_ の引き継ぎ)
+        return 0;
+
+    // 封印済みを丸ごと引き取り、保留リストの先頭へつなぐ
+    RetireBatch* sealed = convo::exchangeAtomic(sealedHead_, static_cast<RetireBatch*>(nullptr),
+                                                std::memory_order_acquire); // acquire: publish の release と HB (バッチの中身を観測)
+    while (sealed != nullptr)
+    {
+        RetireBatch* next = sealed->next;
+        sealed->next = pending_;
+        pending_ = sealed;
+        sealed = next;
+    }
+
+    uint32_t reclaimed = 0;
+    uint64_t batches = 0;
+    RetireBatch** link = &pending_;
+    while (*link != nullptr)
+    {
+        RetireBatch* batch = *link;
+        if (!ignoreEpoch && !isOlder(batch->epoch, minReaderEpoch))
+        {
+            link = &batch->next;
+            continue;
+        }
+        *link = batch->next;
+        for (uint32_t i = 0; i < batch->count; ++i)
+        {
+            const auto& entry = batch->entries[i];
+            if (entry.ptr != nullptr && entry.deleter != nullptr)
+                entry.deleter(entry.ptr);
+        }
+        reclaimed += batch->count;
+        ++batches;
+        batch->count = 0;
+        batch->next = nullptr;
+        batch->owner->recycle(batch);
+    }
+
+    if (reclaimed > 0)
+        convo::fetchSubAtomic(sealedEntries_, reclaimed, std::memory_order_relaxed); // relaxed: 概数 (publish 側と同じ)
+    if (batches > 0)
+        convo::fetchAddAtomic(reclaimedBatches_, batches, std::memory_order_relaxed); // relaxed: 統計
+    convo::publishAtomic(reclaiming_, false, std::memory_order_release); // release: pending_ を次の回収者へ引き継ぐ
+    return reclaimed;
+}
+
+} // namespace isr
+} // namespace convo
@@ -8,14 +8,108 @@
 #include "ISRRetireRouter.h"
 #include "core/TimeUtils.h"     // ★ Practical-4: getCurrentTimeUs
 
+#include <algorithm>
+#include <new>
+
 namespace convo {
 namespace isr {
 
+namespace {
+
+// このスレッドで開いている RetireBatchScope (Router ごとに 1 つ、入れ子は外側が持つ)
+struct ActiveRetireBatch
+{
+    const ISRRetireRouter* router = nullptr;
+    RetireBatchLane* lane = nullptr;
+};
+thread_local ActiveRetireBatch t_activeRetireBatch;
+
+// アドレスをスレッド識別子に使う。終了したスレッドのアドレスを新しいスレッドが再利用しても、
+// 旧スレッドはもう退役しないのでレーンの単一生産者は崩れない
+thread_local char t_retireLaneThreadKey = 0;
+
+} // namespace
+
 ISRRetireRouter::ISRRetireRouter(IEpochProvider& provider) noexcept
     : provider_(&provider)
 {
 }
 
+ISRRetireRouter::~ISRRetireRouter()
+{
+    for (auto& slot : lanes_)
+        delete convo::exchangeAtomicPtr(slot, static_cast<RetireBatchLane*>(nullptr),
+                                        std::memory_order_acquire); // acquire: acquireLaneForCurrentThread の公開 release と HB
+}
+
+ISRRetireRouter::RetireBatchScope::RetireBatchScope(ISRRetireRouter& router, RetireProducer producer) noexcept
+    : router_(router)
+{
+    if (t_activeRetireBatch.router == &router)
+        return;
+    lane_ = router.acquireLaneForCurrentThread(producer);
+    if (lane_ == nullptr)
+        return;
+    previousRouter_ = t_activeRetireBatch.router;
+    previousLane_ = t_activeRetireBatch.lane;
+    t_activeRetireBatch = ActiveRetireBatch { &router, lane_ };
+}
+
+ISRRetireRouter::RetireBatchScope::~RetireBatchScope()
+{
+    if (lane_ == nullptr)
+        return;
+    lane_->seal(router_.batchHandoff_);
+    t_activeRetireBatch = ActiveRetireBatch { previousRouter_, previousLane_ };
+}
+
+RetireBatchLane* ISRRetireRouter::acquireLaneForCurrentThread(RetireProducer producer) noexcept
+{
+    const auto threadKey = reinterpret_cast<std::uintptr_t>(&t_retireLaneThreadKey);
+    const uint32_t claimed = std::min(convo::consumeAtomic(laneClaimCount_, std::memory_order_acquire), // acquire: 他スレッドの確保済み件数を観測 (スロット自体は下で acquire)
+                                      kMaxRetireLanes);
+    for (uint32_t i = 0; i < claimed; ++i)
+    {
+        // acquire: 下の公開 release と HB (レーンの構築結果を観測)。確保中のスロットは nullptr で飛ばす
+        auto* lane = convo::consumeAtomicPtr(lanes_[i], std::memory_order_acquire);
+        if (lane != nullptr && lane->threadKey() == threadKey && lane->producer() == producer)
+            return lane;
+    }
+
+    // relaxed: スロット番号の払い出しのみ (中身の公開は publishAtomicPtr が担う)
+    const uint32_t index = convo::fetchAddAtomic(laneClaimCount_, 1u, std::memory_order_relaxed);
+    if (index >= kMaxRetireLanes)
+        return nullptr;
+
+    RetireBatchLane* lane = nullptr;
+    try
+    {
+        lane = new RetireBatchLane(producer, threadKey);
+    }
+    catch (...)
+    {
+        return nullptr;   // スロットは空のまま (共有キュー経路)
+    }
+    convo::publishAtomicPtr(lanes_[index], lane, std::memory_order_release); // release: 構築済みレーンを他スレッドの走査 acquire へ公開
+    return lane;
+}
+
+bool ISRRetireRouter::appendBatched(RetireBatchLane& lane, void* ptr, void (*deleter)(void*), uint64_t epoch) noexcept
+{
+    if (lane.tryAppend(ptr, deleter, epoch, batchHandoff_))
+        return true;
+
+    // 空きバッチが無い: 回収できるものを先に返してもらい、それでも無ければ増設する
+    (void)batchHandoff_.reclaim(provider_->getMinReaderEpoch());
+    if (lane.tryAppend(ptr, deleter, epoch, batchHandoff_))
+        return true;
+    if (lane.grow() && lane.tryAppend(ptr, deleter, epoch, batchHandoff_))
+        return true;
+
+    convo::fetchAddAtomic(m_batchFallbackCount_, uint64_t{1}, std::memory_order_relaxed); // relaxed: 統計
+    return false;
+}
+
 uint64_t ISRRetireRouter::snapshotEpoch() const noexcept
 {
     assert(provider_ != nullptr);
@@ -103,6 +197,10 @@ RetireEnqueueResult ISRRetireRouter::enqueueRetire(void* ptr,
     if (ptr == nullptr || deleter == nullptr)
         return RetireEnqueueResult::Success;
 
+    // RetireBatchScope 内ならこのスレッドのレーンへ (レーン上限時のみ共有キューへ落ちる)
+    if (t_activeRetireBatch.router == this && appendBatched(*t_activeRetireBatch.lane, ptr, deleter, epoch))
+        return RetireEnqueueResult::Success;
+
     // Route through IEpochProvider interface.
     if (provider_->enqueueRetire(ptr, deleter, epoch))
     {
@@ -185,6 +283,7 @@ RetireEnqueueResult ISRRetireRouter::enqueueWithRetry(void* ptr,
 void ISRRetireRouter::tryReclaim() noexcept
 {
     assert(provider_ != nullptr);
+    (void)batchHandoff_.reclaim(provider_->getMinReaderEpoch());
     provider_->tryReclaim();
 }
 
@@ -192,13 +291,15 @@ uint32_t ISRRetireRouter::pendingRetireCount() const noexcept
 {
     // ★ P0-A: IRetireProvider 経由で委譲（dynamic_cast 不要）
     assert(provider_ != nullptr);
-    return provider_->pendingRetireCount();
+    return provider_->pendingRetireCount() + batchHandoff_.pendingEntryCount();
 }
 
 void ISRRetireRouter::drainAll() noexcept
 {
     // ★ P0-A: IRetireProvider 経由で委譲（dynamic_cast 不要）
+    //   開いたバッチは RetireBatchScope の外には残らないので、封印済みだけを落とせばよい
     assert(provider_ != nullptr);
+    (void)batchHandoff_.drainAllUnsafe();
     provider_->drainAll();
 }
 
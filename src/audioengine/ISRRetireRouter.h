@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <cassert>
@@ -11,6 +12,7 @@
 #include "core/IEpochProvider.h"
 #include "core/IRetireRouter.h"
 #include "ISRAuthorityClass.h"
+#include "ISRRetireBatchLane.h"
 
 namespace convo {
 namespace isr {
@@ -46,12 +48,49 @@ class DeferredRetirePolicy;
  *
  * ISR P1-19 conformance: EpochDomain 完全型は .cpp のみでインクルード。
  *   .h では前方宣言のみで十分（コンストラクタの参照パラメータとポインタメンバ）。
+ *
+ * ★ 退役バッチレーン: RetireBatchScope を開いている NonRT スレッドの enqueueRetire / enqueueWithRetry は
+ *   共有キュー (provider) ではなく (RetireProducer, スレッド) ごとの RetireBatchLane へ入り、
+ *   スコープを閉じた時点 (または満杯・epoch 変化時) にバッチ単位で Reclaimer へ渡る。
+ *   回収は tryReclaim / drainAll が共有キューと合わせて行う。retireRT はバッチ化しない。
  */
+#pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 class ISRRetireRouter : public convo::IEpochProvider,
                         public convo::IRetireRouter
 {
 public:
+    // 同時に存在できるレーン数 ((RetireProducer, スレッド) の組)。超えた組は共有キュー経路のまま
+    static constexpr uint32_t kMaxRetireLanes = 16;
+
+    /**
+     * RetireBatchScope — このスレッドの退役をスコープの間バッチ化する (NonRT 専用)
+     *
+     * 初回は (producer, スレッド) のレーンを確保する。同じ Router のスコープが既に開いていれば
+     * 何もしない (外側のスコープが閉じる時にまとめて渡す)。デストラクタで開いているバッチを封印する。
+     */
+    class RetireBatchScope
+    {
+    public:
+        RetireBatchScope(ISRRetireRouter& router, RetireProducer producer) noexcept;
+        ~RetireBatchScope();
+
+        RetireBatchScope(const RetireBatchScope&) = delete;
+        RetireBatchScope& operator=(const RetireBatchScope&) = delete;
+
+        // false: 入れ子、またはレーン上限・確保失敗で共有キュー経路のまま
+        [[nodiscard]] bool isBatching() const noexcept { return lane_ != nullptr; }
+
+    private:
+        ISRRetireRouter& router_;
+        RetireBatchLane* lane_ = nullptr;
+        const ISRRetireRouter* previousRouter_ = nullptr;
+        RetireBatchLane* previousLane_ = nullptr;
+    };
+
     explicit ISRRetireRouter(convo::IEpochProvider& provider) noexcept;
+    // 未回収のバッチは解放しない (共有キューと同じく drainAll は所有者が明示的に呼ぶ)
+    ~ISRRetireRouter() override;
 
     ISRRetireRouter(const ISRRetireRouter&) = delete;
     ISRRetireRouter& operator=(const ISRRetireRouter&) = delete;
@@ -168,14 +207,34 @@ public:
         return convo::consumeAtomic(m_trackedPendingEntries_, std::memory_order_acquire);
     }
 
+    // バッチレーンが上限 (RetireBatchLane::kMaxBatches) に達して共有キューへ回した退役の件数
+    [[nodiscard]] uint64_t batchedRetireFallbackCount() const noexcept
+    {
+        return convo::consumeAtomic(m_batchFallbackCount_, std::memory_order_relaxed); // relaxed: 統計
+    }
+
+    [[nodiscard]] uint64_t reclaimedRetireBatchCount() const noexcept
+    {
+        return batchHandoff_.reclaimedBatchCount();
+    }
+
 private:
+    RetireBatchLane* acquireLaneForCurrentThread(RetireProducer producer) noexcept;
+    bool appendBatched(RetireBatchLane& lane, void* ptr, void (*deleter)(void*), uint64_t epoch) noexcept;
+
     convo::IEpochProvider* provider_ = nullptr;
     std::atomic<uint64_t> m_overflowCount_{0};
     std::atomic<uint64_t> m_lastForcedReclaimTimeUs_{0};
     // ★ work70: 診断用カウンタ
     std::atomic<uint64_t> m_pendingRetireBytes_{0};
     std::atomic<uint32_t> m_trackedPendingEntries_{0};
+    // 退役バッチレーン (lanes_ は確保順に公開、破棄はデストラクタのみ)
+    RetireBatchHandoff batchHandoff_;
+    std::array<std::atomic<RetireBatchLane*>, kMaxRetireLanes> lanes_{};
+    std::atomic<uint32_t> laneClaimCount_{0};
+    std::atomic<uint64_t> m_batchFallbackCount_{0};
 };
+#pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
 
 } // namespace isr
 } // namespace convo
@@ -193,6 +193,40 @@ template <std::size_t InventoryN, std::size_t DescriptorN>
     return true;
 }
 
+// ★ 増分 World 検証 (incremental world validation)
+//   RuntimeFieldMask は RuntimeState::kFieldDescriptors の添字をビット位置とする
+//   「前回 publish された World から値が変わったフィールド」の集合。
+//   RuntimeBuilder が算出して RuntimeMetadata::dirtyFieldMask に載せ、
+//   RuntimePublicationValidator / precheck は依存フィールドが dirty な検査だけを実行する。
+//   既定値は全ビット (= 全検証)。Debug 構成 (CONVOPEQ_FULL_WORLD_VALIDATION=1) と
+//   kFullWorldValidationInterval 回に 1 回は Builder が全ビットを立てて全検証へ戻す。
+//   差分判定のため、値だけで構成される Semantic 構造体は defaulted operator== を持つ。
+#ifndef CONVOPEQ_FULL_WORLD_VALIDATION
+#if defined(NDEBUG)
+#define CONVOPEQ_FULL_WORLD_VALIDATION 0
+#else
+#define CONVOPEQ_FULL_WORLD_VALIDATION 1
+#endif
+#endif
+
+using RuntimeFieldMask = std::uint32_t;
+inline constexpr RuntimeFieldMask kAllRuntimeFieldsDirty = ~RuntimeFieldMask{0};
+inline constexpr bool kAlwaysFullWorldValidation = (CONVOPEQ_FULL_WORLD_VALIDATION != 0);
+inline constexpr std::uint64_t kFullWorldValidationInterval = 64;
+
+template <std::size_t N>
+[[nodiscard]] inline constexpr RuntimeFieldMask runtimeFieldBit(const std::array<RuntimeFieldDescriptor, N>& descriptors,
+                                                                std::string_view fieldName) noexcept
+{
+    static_assert(N <= sizeof(RuntimeFieldMask) * 8, "RuntimeFieldMask cannot cover every field descriptor");
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (descriptors[i].fieldName == fieldName)
+            return RuntimeFieldMask{1} << i;
+    }
+    return 0;
+}
+
 using PublicationSequenceId = std::uint64_t;
 using PublicationEpoch = std::uint64_t;
 
@@ -207,6 +241,8 @@ struct TopologySemantic
     std::uint64_t runtimeUuid = 0;
     std::uint64_t fadingRuntimeUuid = 0;
     // ★ v8.3: hasFadingRuntime 削除 — graph.fadingNode != nullptr から導出
+
+    [[nodiscard]] bool operator==(const TopologySemantic&) const noexcept = default;
 };
 
 struct RoutingSemantic
@@ -214,6 +250,8 @@ struct RoutingSemantic
     int processingOrder = 0;
     bool eqBypassed = false;
     bool convBypassed = false;
+
+    [[nodiscard]] bool operator==(const RoutingSemantic&) const noexcept = default;
 };
 
 struct ExecutionSemantic
@@ -223,6 +261,8 @@ struct ExecutionSemantic
     int latencyCompensationSamples = 0;
     int crossfadeStartDelayBlocks = 0;
     int crossfadeDryHoldSamples = 0;
+
+    [[nodiscard]] bool operator==(const ExecutionSemantic&) const noexcept = default;
 };
 
 [[nodiscard]] inline constexpr bool isValidRoutingSemantic(const RoutingSemantic& routing) noexcept
@@ -272,6 +312,8 @@ struct RuntimeMetadata
 {
     std::uint32_t schemaVersion = kRuntimeSemanticSchemaVersion;
     PublicationSequenceId publicationSequence = 0;
+    // 前回 publish された World から変わったフィールド (RuntimeState::kFieldDescriptors 添字のビット集合)
+    RuntimeFieldMask dirtyFieldMask = kAllRuntimeFieldsDirty;
 };
 
 struct OverlapSemantic
@@ -280,6 +322,8 @@ struct OverlapSemantic
     bool firstIrDryCrossfadePending = false;
     double dryScaleTarget = 1.0;
     double fadeTimeSec = 0.0;
+
+    [[nodiscard]] bool operator==(const OverlapSemantic&) const noexcept = default;
 };
 
 struct RetireSemantic
@@ -287,6 +331,8 @@ struct RetireSemantic
     std::uint64_t retireEpoch = 0;
     std::uint64_t retireBacklog = 0;
     std::uint64_t deferredResidency = 0;
+
+    [[nodiscard]] bool operator==(const RetireSemantic&) const noexcept = default;
 };
 
 struct TimingSemantic
@@ -295,6 +341,8 @@ struct TimingSemantic
     double queuedFadeTimeSec = 0.0;
     // activationEpoch is a derived field referencing GenerationSemantic.activationEpoch
     // Do not define activationEpoch here to avoid duplication (#17 Sprint-1)
+
+    [[nodiscard]] bool operator==(const TimingSemantic&) const noexcept = default;
 };
 
 struct LatencySemantic
@@ -302,6 +350,8 @@ struct LatencySemantic
     int latencyDelayOld = 0;
     int latencyDelayNew = 0;
     int latencyDeltaSamples = 0;
+
+    [[nodiscard]] bool operator==(const LatencySemantic&) const noexcept = default;
 };
 
 struct SchedulingSemantic
@@ -316,11 +366,15 @@ struct ResourceSemantic
     int oversamplingFactor = 1;
     int ditherBitDepth = 0;
     int noiseShaperType = 0;
+
+    [[nodiscard]] bool operator==(const ResourceSemantic&) const noexcept = default;
 };
 
 struct AffinitySemantic
 {
     bool rebuildWorkerRunning = false;
+
+    [[nodiscard]] bool operator==(const AffinitySemantic&) const noexcept = default;
 };
 
 struct AutomationSemantic
@@ -332,6 +386,8 @@ struct AutomationSemantic
     double inputHeadroomGain = 1.0;
     double outputMakeupGain = 1.0;
     double convolverInputTrimGain = 1.0;
+
+    [[nodiscard]] bool operator==(const AutomationSemantic&) const noexcept = default;
 };
 
 struct CoefficientSemantic
@@ -339,6 +395,8 @@ struct CoefficientSemantic
     int adaptiveCoeffBankIndex = -1;
     std::uint32_t adaptiveCoeffGeneration = 0;
     std::uint64_t eqCoeffHash = 0;
+
+    [[nodiscard]] bool operator==(const CoefficientSemantic&) const noexcept = default;
 };
 
 struct RuntimeSemanticSchema
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ISRClosure.h"
+#include "ISRPayloadTier.h"
+
+// ★ 静的スキーマ構成 (CONVOPEQ_STATIC_PUBLICATION_SCHEMA=1)
+//   publication precheck のうち「World の値に依存しない」部分
+//   (descriptor / authority inventory 表の整合、closure graph の形、payload tier)
+//   はビルド時に決まる契約である。この構成ではそれらを static_assert でコンパイル時に
+//   確定させ、publication ごとの表走査・closure graph の構築と走査・closure_graph.json の
+//   書き出しを省く。World の値に依存する検証 (Validator の semantic / topology / resource /
+//   transition、precheck の世代・sequence 単調性など) は構成に関わらず毎回実行する。
+//   CMake: option CONVOPEQ_STATIC_PUBLICATION_SCHEMA (Release 構成のみで有効)
+#ifndef CONVOPEQ_STATIC_PUBLICATION_SCHEMA
+#define CONVOPEQ_STATIC_PUBLICATION_SCHEMA 0
+#endif
+
+namespace convo {
+namespace isr {
+
+inline constexpr bool kStaticPublicationSchema = (CONVOPEQ_STATIC_PUBLICATION_SCHEMA != 0);
+
+/**
+ * publication closure の形
+ * runPublicationPrecheckNonRt が組み立てる closure は、この 3 フラグだけで決まる。
+ */
+struct PublicationClosureShape
+{
+    bool hasActive = false;
+    bool hasFading = false;          // fading ノードが active と別 Runtime であること
+    bool hasTransitionNext = false;
+};
+
+inline constexpr std::size_t kPublicationClosureShapeCount = 8;
+
+[[nodiscard]] constexpr std::size_t publicationClosureShapeIndex(const PublicationClosureShape& shape) noexcept
+{
+    return (shape.hasActive ? 1u : 0u)
+        | (shape.hasFading ? 2u : 0u)
+        | (shape.hasTransitionNext ? 4u : 0u);
+}
+
+[[nodiscard]] constexpr PublicationClosureShape publicationClosureShapeFromIndex(std::size_t index) noexcept
+{
+    return PublicationClosureShape { (index & 1u) != 0, (index & 2u) != 0, (index & 4u) != 0 };
+}
+
+/**
+ * 固定容量の closure (ノード最大 3、辺最大 2)
+ * PayloadClosureDescriptor と同じ内容を constexpr で扱うための表現。
+ */
+struct StaticPublicationClosure
+{
+    std::array<ClosureNodeRef, 3> nodes {};
+    std::size_t nodeCount = 0;
+    std::array<uint32_t, 4> edges {};   // (from, to) pairs
+    std::size_t edgeWordCount = 0;
+    uint32_t externalMutableDependencies = 0;
+};
+
+[[nodiscard]] constexpr ClosureNodeRef makePublicationClosureNode(uint32_t nodeId, PayloadTier tier) noexcept
+{
+    ClosureNodeRef ref { nodeId, static_cast<uint32_t>(tier) };
+    ref.kind = 1u;        // DSP node
+    ref.ownership = 2u;   // Engine-owned shared runtime object
+    ref.mutability = 1u;  // immutable payload
+    ref.lifetime = 2u;    // runtime publication lifetime
+    ref.hbDomain = 1u;    // publication HB domain
+    ref.authority = 1u;   // NonRT publication authority
+    ref.allocator = 1u;   // engine allocator domain
+    return ref;
+}
+
+[[nodiscard]] constexpr StaticPublicationClosure buildPublicationClosure(const PublicationClosureShape& shape) noexcept
+{
+    StaticPublicationClosure closure {};
+    uint32_t nextNodeId = 1;
+    uint32_t activeNodeId = 0;
+    uint32_t fadingNodeId = 0;
+    uint32_t transitionNodeId = 0;
+
+    if (shape.hasActive) {
+        activeNodeId = nextNodeId++;
+        closure.nodes[closure.nodeCount++] = makePublicationClosureNode(activeNodeId, PayloadTier::InlineImmutable);
+    }
+
+    if (shape.hasFading) {
+        fadingNodeId = nextNodeId++;
+        closure.nodes[closure.nodeCount++] = makePublicationClosureNode(fadingNodeId, PayloadTier::ImmutableShared);
+    }
+
+    if (shape.hasTransitionNext) {
+        transitionNodeId = nextNodeId++;
+        closure.nodes[closure.nodeCount++] = makePublicationClosureNode(transitionNodeId, PayloadTier::ImmutableShared);
+    }
+
+    if (activeNodeId != 0 && transitionNodeId != 0) {
+        closure.edges[closure.edgeWordCount++] = activeNodeId;
+        closure.edges[closure.edgeWordCount++] = transitionNodeId;
+    }
+
+    if (activeNodeId != 0 && fadingNodeId != 0) {
+        closure.edges[closure.edgeWordCount++] = activeNodeId;
+        closure.edges[closure.edgeWordCount++] = fadingNodeId;
+    }
+
+    return closure;
+}
+
+[[nodiscard]] constexpr TieredPayloadDescriptor makePublicationPayloadDescriptor(const PublicationClosureShape& shape) noexcept
+{
+    TieredPayloadDescriptor descriptor {};
+    descriptor.tier = shape.hasTransitionNext
+        ? PayloadTier::ImmutableShared
+        : PayloadTier::InlineImmutable;
+    descriptor.requiresRT = false;
+    descriptor.hasExternalResource = false;
+    descriptor.pinnedLifetime = true;
+    return descriptor;
+}
+
+// 動的経路 (ClosureValidator) へ渡すため可変長 descriptor へ写す
+inline void copyPublicationClosure(const StaticPublicationClosure& source,
+                                   uint32_t closureId,
+                                   PayloadClosureDescriptor& destination)
+{
+    destination.closureId = closureId;
+    destination.nodes.assign(source.nodes.begin(), source.nodes.begin() + static_cast<std::ptrdiff_t>(source.nodeCount));
+    destination.edges.assign(source.edges.begin(), source.edges.begin() + static_cast<std::ptrdiff_t>(source.edgeWordCount));
+    destination.externalMutableDependencies = source.externalMutableDependencies;
+}
+
+/**
+ * ClosureValidator::validateClosureGraph と同じ規則の constexpr 版
+ * (ノード ID 非 0・重複なし、属性の網羅、外部可変依存なし、辺の参照先が存在、非巡回)。
+ * ノード数が高々 3 のため、巡回検出は入次数 0 のノードを剥がす方式で行う。
+ */
+[[nodiscard]] constexpr bool validateStaticClosureGraph(const StaticPublicationClosure& closure) noexcept
+{
+    if (closure.nodeCount == 0 || (closure.edgeWordCount % 2u) != 0u)
+        return false;
+
+    if (closure.externalMutableDependencies != 0u)
+        return false;
+
+    const auto indexOf = [&closure](uint32_t nodeId) -> std::size_t {
+        for (std::size_t i = 0; i < closure.nodeCount; ++i)
+            if (closure.nodes[i].nodeId == nodeId)
+                return i;
+        return closure.nodes.size();
+    };
+
+    for (std::size_t i = 0; i < closure.nodeCount; ++i) {
+        const auto& node = closure.nodes[i];
+        if (node.nodeId == 0u)
+            return false;
+
+        if (node.kind == 0u
+            || node.ownership == 0u
+            || node.mutability == 0u
+            || node.lifetime == 0u
+            || node.hbDomain == 0u
+            || node.authority == 0u
+            || node.allocator == 0u)
+            return false;
+
+        if (indexOf(node.nodeId) != i)
+            return false;
+    }
+
+    for (std::size_t e = 0; e < closure.edgeWordCount; ++e)
+        if (indexOf(closure.edges[e]) == closure.nodes.size())
+            return false;
+
+    std::array<bool, 3> removed {};
+    std::size_t removedCount = 0;
+    while (removedCount < closure.nodeCount) {
+        bool progressed = false;
+        for (std::size_t i = 0; i < closure.nodeCount; ++i) {
+            if (removed[i])
+                continue;
+            bool hasIncoming = false;
+            for (std::size_t e = 0; e < closure.edgeWordCount; e += 2u)
+                if (!removed[indexOf(closure.edges[e])] && indexOf(closure.edges[e + 1u]) == i)
+                    hasIncoming = true;
+            if (!hasIncoming) {
+                removed[i] = true;
+                ++removedCount;
+                progressed = true;
+            }
+        }
+        if (!progressed)
+            return false;   // 残ったノードはすべて入辺を持つ = 巡回
+    }
+
+    return true;
+}
+
+// 空の形 (active / fading / transition いずれも無し) は precheck が closure を作らずに通す
+[[nodiscard]] constexpr bool isPublicationClosureShapePublishable(const PublicationClosureShape& shape) noexcept
+{
+    if (!shape.hasActive && !shape.hasFading && !shape.hasTransitionNext)
+        return true;
+
+    return validateStaticClosureGraph(buildPublicationClosure(shape))
+        && explainTierPublishReject(makePublicationPayloadDescriptor(shape)) == TierRejectReason::None;
+}
+
+[[nodiscard]] constexpr bool validateAllPublicationClosureShapes() noexcept
+{
+    for (std::size_t i = 0; i < kPublicationClosureShapeCount; ++i)
+        if (!isPublicationClosureShapePublishable(publicationClosureShapeFromIndex(i)))
+            return false;
+    return true;
+}
+
+static_assert(validateAllPublicationClosureShapes(),
+              "every publication closure shape built by the precheck must be a valid, publishable closure");
+
+}  // namespace isr
+}  // namespace convo
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "AtomicAccess.h"
+
+namespace convo {
+
+//==============================================================================
+// LearnerThrottleGovernor — Audio callback の締切余裕に応じた学習評価の絞り込み
+//
+//   RuntimeHealthMonitor::tick() (Message Thread) が callback 負荷 (budget 比 permille,
+//   peak-hold) を update() に渡し、NoiseShaperLearner が世代の先頭で current() を読む。
+//   段階 0 は無制限 (空きサイクルはすべて学習に回す)。段階が上がるほど
+//   評価ワーカー数を減らし、最後の 2 段は世代間に休止を挟む。
+//     - 余裕が kBackoffSlack 未満: 1 段上げる。kPanicSlack 未満: 最上段へ
+//     - 余裕が kRecoverSlack 以上の tick が kRecoverTicks 回続く: 1 段下げる
+//   上げは即時・下げは緩やかにして、締切に近い状態で学習が戻ってくるのを避ける。
+//==============================================================================
+
+struct LearnerThrottle
+{
+    int workerLimit = 0;      // 0 = 制限なし。それ以外は評価に参加するワーカー数 (主スレッドを含む)
+    uint32_t pauseMs = 0;     // 世代間に挟む休止
+    int level = 0;
+};
+
+class LearnerThrottleGovernor
+{
+public:
+    static constexpr uint16_t kBackoffSlack = 300;   // 負荷 70% 超
+    static constexpr uint16_t kPanicSlack = 100;     // 負荷 90% 超
+    static constexpr uint16_t kRecoverSlack = 550;   // 負荷 45% 未満
+    static constexpr int kRecoverTicks = 20;         // 100 ms tick で 2 s
+
+    struct Level { int workerLimit; uint32_t pauseMs; };
+    static constexpr std::array<Level, 6> kLevels {{
+        { 0, 0 }, { 4, 0 }, { 2, 0 }, { 1, 0 }, { 1, 20 }, { 1, 100 }
+    }};
+    static constexpr int kMaxLevel = static_cast<int>(kLevels.size()) - 1;
+
+    // 段階が変わったら true (呼び出し側がテレメトリへ記録する)
+    bool update(uint16_t callbackLoadPermille) noexcept
+    {
+        const uint16_t slack = (callbackLoadPermille >= 1000) ? 0 : static_cast<uint16_t>(1000 - callbackLoadPermille);
+        int next = level;
+        if (slack < kPanicSlack)
+        {
+            next = kMaxLevel;
+            recoverTicks = 0;
+        }
+        else if (slack < kBackoffSlack)
+        {
+            next = (level < kMaxLevel) ? level + 1 : kMaxLevel;
+            recoverTicks = 0;
+        }
+        else if (slack >= kRecoverSlack && level > 0)
+        {
+            if (++recoverTicks >= kRecoverTicks)
+            {
+                next = level - 1;
+                recoverTicks = 0;
+            }
+        }
+        else
+        {
+            recoverTicks = 0;
+        }
+
+        if (next == level)
+            return false;
+        level = next;
+        ++levelChangeCount;
+        publishAtomic(publishedLevel, level, std::memory_order_relaxed); // relaxed: 付随データのない単独の観測値
+        return true;
+    }
+
+    void reset() noexcept
+    {
+        level = 0;
+        recoverTicks = 0;
+        publishAtomic(publishedLevel, 0, std::memory_order_relaxed); // relaxed: 同上
+    }
+
+    // 任意スレッド
+    [[nodiscard]] LearnerThrottle current() const noexcept
+    {
+        const int l = consumeAtomic(publishedLevel, std::memory_order_relaxed); // relaxed: 段階の値だけを読む
+        const auto& entry = kLevels[static_cast<size_t>(l)];
+        return { entry.workerLimit, entry.pauseMs, l };
+    }
+
+    // Message Thread (update() と同じスレッド)
+    [[nodiscard]] int getLevel() const noexcept { return level; }
+    [[nodiscard]] uint64_t getLevelChangeCount() const noexcept { return levelChangeCount; }
+
+private:
+    int level = 0;
+    int recoverTicks = 0;
+    uint64_t levelChangeCount = 0;
+    std::atomic<int> publishedLevel{ 0 };
+};
+
+} // namespace convo
@@ -0,0 +1,284 @@
+//==============================================================================
+// LookAheadPeakLimiter.h
+// ★ Look-ahead ピークリミッタ (SimplePeakLimiter の後継)
+//
+// 設計:
+//   kSubBlock (16) サンプルを 1 制御周期として、ゲインは制御レートで求め、サンプルには
+//   線形補間したゲインを AVX2 の乗算で掛ける。1 サンプルごとの abs / max / knee / 追従は行わない。
+//
+//   制御周期 b ごとに
+//     1. req[b]    = soft knee ゲイン (区間ピーク max(|L|, |R|) から。SimplePeakLimiter と同じ曲線)
+//     2. minReq[b] = min(req[b - P .. b])              … 単調デックによるスライディング最小 (P = 先読み周期数)
+//     3. env[b]    = min(minReq[b], 1 + (env[b-1] - 1) * releaseCoeff)   … Attack 即時 / Release 指数
+//     4. ctrl[b-P] = mean(env[b - P + 1 .. b])         … 箱型平滑 (Attack が P 周期の直線ランプになる)
+//   出力区間 c には ctrl[c-1] → ctrl[c] の直線ランプを掛ける。両端とも env[c .. c+P] の平均なので
+//   req[c] 以下であり (minReq の窓が c を含む)、ランプ上のどのサンプルも threshold を超えない。
+//
+//   ctrl[c] は入力区間 c + P が揃った時点で決まるため、出力は (P + 1) * kSubBlock サンプル遅れる。
+//   この遅延は getLatencySamples() / latencySamplesFor() で AudioEngine の LatencyBreakdown に載せる。
+//
+// 位置付け: 出力段 Hard Clamp (Safety Net) の前段。入力の NaN/Inf 除去と入力ゲインは遅延線への書き込み時に行う。
+// ISR: 状態は遅延線・制御点・デック・envelope のみ。prepare() でのみ確保する。JUCE 非依存 (ヘッダオンリー)。
+//==============================================================================
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include <vector>
+
+class LookAheadPeakLimiter
+{
+public:
+    static constexpr int kSubBlock = 16;            // 制御周期 (サンプル)
+    static constexpr int kMaxLookAheadBlocks = 96;  // 768 kHz で 2 ms 相当まで
+    static constexpr double kDefaultLookAheadMs = 1.0;
+
+    // 先読み lookAheadMs に対する遅延サンプル数 (DSPCore を持たない見積もり経路用)
+    static int latencySamplesFor(double sampleRate, double lookAheadMs) noexcept
+    {
+        return (lookAheadBlocksFor(sampleRate, lookAheadMs) + 1) * kSubBlock;
+    }
+
+    // NON_RT: 遅延線を確保し、状態をリセットする
+    void prepare(double sampleRate, double lookAheadMs, double releaseMs)
+    {
+        lookAheadBlocks = lookAheadBlocksFor(sampleRate, lookAheadMs);
+        latencySamples = (lookAheadBlocks + 1) * kSubBlock;
+
+        const double releaseSec = releaseMs * 0.001;
+        releaseCoeff = (releaseSec > 0.0 && sampleRate > 0.0)
+            ? std::exp(-static_cast<double>(kSubBlock) / (sampleRate * releaseSec))
+            : 0.0;
+
+        int size = 1;
+        while (size < latencySamples + kSubBlock)
+            size <<= 1;
+        delayMask = size - 1;
+        delayL.assign(static_cast<size_t>(size), 0.0);
+        delayR.assign(static_cast<size_t>(size), 0.0);
+
+        reset();
+    }
+
+    // reset: 遅延線をクリアし、ゲインを 1.0 (no gain reduction) に戻す
+    void reset() noexcept
+    {
+        std::fill(delayL.begin(), delayL.end(), 0.0);
+        std::fill(delayR.begin(), delayR.end(), 0.0);
+        writePos = 0;
+        phase = 0;
+        blockIndex = 0;
+        blockPeak = 0.0;
+        envelope = 1.0;
+        dequeHead = 0;
+        dequeTail = 0;
+        for (auto& e : envHistory) e = 1.0;
+        for (auto& c : ctrl) c = 1.0;
+    }
+
+    int getLatencySamples() const noexcept { return latencySamples; }
+    // 直近に出力した制御周期の終端ゲイン (診断用)
+    double getCurrentGain() const noexcept { return ctrl[static_cast<size_t>((blockIndex - lookAheadBlocks - 1) & kCtrlMask)]; }
+
+    // processBlock: in-place。dataR == nullptr でモノラル (L のピークだけでゲインを決める)。
+    // inputGain: 遅延線へ書く前に掛けるゲイン (ヘッドルーム未適用の経路用)。非有限・|x| >= 1e300 は 0 にする
+    // thresholdLinear / kneeLinear: SimplePeakLimiter と同じ意味 (e.g. 0.841 = -1.5 dBFS, 0.109 ≈ 1 dB)
+    void processBlock(double* dataL, double* dataR, int numSamples, double inputGain,
+                      double thresholdLinear, double kneeLinear) noexcept
+    {
+        if (dataL == nullptr || numSamples <= 0 || delayL.empty())
+            return;
+
+        const bool hasR = (dataR != nullptr);
+        int i = 0;
+        while (i < numSamples)
+        {
+            // 制御周期の境界を跨がない区間。遅延は kSubBlock の倍数なので出力側も同じ位相・同じ区間に収まる
+            const int count = std::min(numSamples - i, kSubBlock - phase);
+            writeAndDetect(dataL + i, hasR ? dataR + i : nullptr, count, inputGain);
+            applyRamp(dataL + i, hasR ? dataR + i : nullptr, count);
+
+            writePos = (writePos + count) & delayMask;
+            phase += count;
+            i += count;
+
+            if (phase == kSubBlock)
+            {
+                advanceControl(thresholdLinear, kneeLinear);
+                phase = 0;
+            }
+        }
+    }
+
+private:
+    static constexpr int kCtrlSize = 256;   // > kMaxLookAheadBlocks + 2 の 2 冪
+    static constexpr int kCtrlMask = kCtrlSize - 1;
+
+    static int lookAheadBlocksFor(double sampleRate, double lookAheadMs) noexcept
+    {
+        if (sampleRate <= 0.0 || lookAheadMs <= 0.0)
+            return 1;
+        const double samples = sampleRate * lookAheadMs * 0.001;
+        const int blocks = static_cast<int>(std::ceil(samples / static_cast<double>(kSubBlock)));
+        return std::clamp(blocks, 1, kMaxLookAheadBlocks);
+    }
+
+    // SimplePeakLimiter::advanceEnvelope と同じ soft knee 曲線
+    static double kneeGain(double peak, double thresholdLinear, double kneeLinear) noexcept
+    {
+        const double clipStart = thresholdLinear - kneeLinear * 0.5;
+        if (peak <= clipStart)
+            return 1.0;
+        if (peak <= thresholdLinear)
+        {
+            const double t = (peak - clipStart) / kneeLinear;
+            const double kneeShape = t * t * (3.0 - 2.0 * t);
+            return 1.0 - (1.0 - thresholdLinear / peak) * kneeShape;
+        }
+        return thresholdLinear / peak;
+    }
+
+    static inline __m256d scrub(__m256d v) noexcept
+    {
+        const __m256d ordered = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+        const __m256d below = _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), v),
+                                            _mm256_set1_pd(1.0e300), _CMP_LT_OQ);
+        return _mm256_and_pd(v, _mm256_and_pd(ordered, below));
+    }
+
+    static inline double scrub(double v) noexcept
+    {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &v, sizeof(bits));
+        if (((bits >> 52) & 0x7FFu) == 0x7FFu)
+            return 0.0;
+        return (std::abs(v) < 1.0e300) ? v : 0.0;
+    }
+
+    // 入力 (ゲイン・除去後) を遅延線へ書き、区間ピークを更新する。count <= kSubBlock、遅延線上で連続
+    void writeAndDetect(const double* srcL, const double* srcR, int count, double inputGain) noexcept
+    {
+        double* dstL = delayL.data() + writePos;
+        double* dstR = delayR.data() + writePos;
+        const __m256d vGain = _mm256_set1_pd(inputGain);
+        const __m256d vSign = _mm256_set1_pd(-0.0);
+        __m256d vPeak = _mm256_setzero_pd();
+
+        int k = 0;
+        for (; k + 4 <= count; k += 4)
+        {
+            const __m256d l = scrub(_mm256_mul_pd(_mm256_loadu_pd(srcL + k), vGain));
+            _mm256_storeu_pd(dstL + k, l);
+            vPeak = _mm256_max_pd(vPeak, _mm256_andnot_pd(vSign, l));
+            if (srcR != nullptr)
+            {
+                const __m256d r = scrub(_mm256_mul_pd(_mm256_loadu_pd(srcR + k), vGain));
+                _mm256_storeu_pd(dstR + k, r);
+                vPeak = _mm256_max_pd(vPeak, _mm256_andnot_pd(vSign, r));
+            }
+        }
+
+        __m128d vPeak2 = _mm_max_pd(_mm256_castpd256_pd128(vPeak), _mm256_extractf128_pd(vPeak, 1));
+        vPeak2 = _mm_max_sd(vPeak2, _mm_unpackhi_pd(vPeak2, vPeak2));
+        double peak = std::max(blockPeak, _mm_cvtsd_f64(vPeak2));
+
+        for (; k < count; ++k)
+        {
+            const double l = scrub(srcL[k] * inputGain);
+            dstL[k] = l;
+            peak = std::max(peak, std::abs(l));
+            if (srcR != nullptr)
+            {
+                const double r = scrub(srcR[k] * inputGain);
+                dstR[k] = r;
+                peak = std::max(peak, std::abs(r));
+            }
+        }
+        blockPeak = peak;
+    }
+
+    // latencySamples 前の入力に ctrl[c-1] → ctrl[c] のランプを掛けて書き戻す
+    void applyRamp(double* dstL, double* dstR, int count) noexcept
+    {
+        const int readPos = (writePos - latencySamples) & delayMask;
+        const double* srcL = delayL.data() + readPos;
+        const double* srcR = delayR.data() + readPos;
+
+        // 出力区間 c = 入力区間 blockIndex - (P + 1)
+        const std::int64_t outBlock = blockIndex - lookAheadBlocks - 1;
+        const double g0 = ctrl[static_cast<size_t>((outBlock - 1) & kCtrlMask)];
+        const double g1 = ctrl[static_cast<size_t>(outBlock & kCtrlMask)];
+        const double step = (g1 - g0) * (1.0 / static_cast<double>(kSubBlock));
+
+        // ランプ上の位置から直接求める (累積加算しない)。ブロック分割が変わっても同じゲインになる
+        const __m256d vG0 = _mm256_set1_pd(g0);
+        const __m256d vStep = _mm256_set1_pd(step);
+        const __m256d vLane = _mm256_set_pd(4.0, 3.0, 2.0, 1.0);
+        int k = 0;
+        for (; k + 4 <= count; k += 4)
+        {
+            const __m256d vPos = _mm256_add_pd(_mm256_set1_pd(static_cast<double>(phase + k)), vLane);
+            const __m256d vGain = _mm256_add_pd(vG0, _mm256_mul_pd(vStep, vPos));
+            _mm256_storeu_pd(dstL + k, _mm256_mul_pd(_mm256_loadu_pd(srcL + k), vGain));
+            if (dstR != nullptr)
+                _mm256_storeu_pd(dstR + k, _mm256_mul_pd(_mm256_loadu_pd(srcR + k), vGain));
+        }
+        for (; k < count; ++k)
+        {
+            const double gain = g0 + step * static_cast<double>(phase + k + 1);
+            dstL[k] = srcL[k] * gain;
+            if (dstR != nullptr)
+                dstR[k] = srcR[k] * gain;
+        }
+    }
+
+    // 入力区間 blockIndex が揃った: req → スライディング最小 → release → 箱型平滑 → ctrl[blockIndex - P]
+    void advanceControl(double thresholdLinear, double kneeLinear) noexcept
+    {
+        const double req = kneeGain(blockPeak, thresholdLinear, kneeLinear);
+        blockPeak = 0.0;
+
+        // 単調デック (値が単調増加): 新しい値以上の末尾は二度と最小にならない
+        while (dequeTail != dequeHead && dequeValue[static_cast<size_t>((dequeTail - 1) & kCtrlMask)] >= req)
+            --dequeTail;
+        dequeValue[static_cast<size_t>(dequeTail & kCtrlMask)] = req;
+        dequeIndex[static_cast<size_t>(dequeTail & kCtrlMask)] = blockIndex;
+        ++dequeTail;
+        while (dequeIndex[static_cast<size_t>(dequeHead & kCtrlMask)] < blockIndex - lookAheadBlocks)
+            ++dequeHead;
+        const double minReq = dequeValue[static_cast<size_t>(dequeHead & kCtrlMask)];
+
+        const double released = 1.0 + (envelope - 1.0) * releaseCoeff;
+        envelope = std::min(minReq, released);
+        envHistory[static_cast<size_t>(blockIndex & kCtrlMask)] = envelope;
+
+        double sum = 0.0;
+        for (int k = 0; k < lookAheadBlocks; ++k)
+            sum += envHistory[static_cast<size_t>((blockIndex - k) & kCtrlMask)];
+        ctrl[static_cast<size_t>((blockIndex - lookAheadBlocks) & kCtrlMask)] = sum / static_cast<double>(lookAheadBlocks);
+
+        ++blockIndex;
+    }
+
+    std::vector<double> delayL;
+    std::vector<double> delayR;
+    int delayMask = 0;
+    int writePos = 0;
+    int phase = 0;              // 現在の制御周期内の位置 (0..kSubBlock-1)
+    std::int64_t blockIndex = 0; // 入力側の制御周期番号
+    int lookAheadBlocks = 1;    // P
+    int latencySamples = 2 * kSubBlock;
+    double releaseCoeff = 0.0;
+    double blockPeak = 0.0;
+    double envelope = 1.0;
+
+    double envHistory[kCtrlSize] {};
+    double ctrl[kCtrlSize] {};
+    double dequeValue[kCtrlSize] {};
+    std::int64_t dequeIndex[kCtrlSize] {};
+    std::int64_t dequeHead = 0;
+    std::int64_t dequeTail = 0;
+};
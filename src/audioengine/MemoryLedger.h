@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "AtomicAccess.h"
+
+//==============================================================================
+// MemoryLedger — サブシステム別の常駐メモリ台帳 (リリースビルドでも常時有効)
+//
+//   各サブシステムは確保の結果を MemoryCharge メンバの set() で申告するだけで、確保・解放の
+//   経路には手を入れない。set() は前回値との差分を分類ごとの relaxed atomic に足すだけなので、
+//   prepare / SetImpulse / キャッシュ更新のたびに呼んでもコストは無視できる。
+//   MemoryCharge の破棄で申告は自動的に取り消される。
+//
+//   RetirePending は退役キュー (DeletionQueue) で回収待ちの DSPCore の概算で、その中身は
+//   ConvolverLayers などの各分類にも残っている (内訳であって合計には足さない)。
+//   長時間稼働でこの値が減らなければ retire の取りこぼしを疑う。
+//
+//   [MEM_SNAP] (診断ビルドのみ) が MKL の実確保量を追うのに対し、こちらは「誰が持っているか」を示す。
+//==============================================================================
+
+namespace convo {
+
+enum class MemoryCategory : uint8_t
+{
+    ConvolverLayers,    // NUC のレイヤー作業領域・FDL・出力リング・直接畳み込み
+    ConvolverSpectra,   // NUC の IR スペクトル (SharedSpectra。L/R・世代間の共有分は 1 回だけ)
+    Oversampler,        // CustomInputOversampler のステージ履歴・作業領域
+    EqScratch,          // EQProcessor のスクラッチ・dry・並列・構造フェード用バッファ
+    AnalyzerFifo,
+    Learner,            // NoiseShaperLearner 本体 (評価コンテキスト・セグメント) とキャプチャキュー
+    StandbyIrPool,
+    PrefetchedIrFiles,  // CacheManager が mmap で保持しているキャッシュファイル
+    RetirePending,      // 退役済み・未回収の DSPCore (上の分類と重複)
+    Count
+};
+
+[[nodiscard]] constexpr const char* memoryCategoryName(MemoryCategory category) noexcept
+{
+    switch (category)
+    {
+        case MemoryCategory::ConvolverLayers:   return "convolverLayers";
+        case MemoryCategory::ConvolverSpectra:  return "convolverSpectra";
+        case MemoryCategory::Oversampler:       return "oversampler";
+        case MemoryCategory::EqScratch:         return "eqScratch";
+        case MemoryCategory::AnalyzerFifo:      return "analyzerFifo";
+        case MemoryCategory::Learner:           return "learner";
+        case MemoryCategory::StandbyIrPool:     return "standbyIrPool";
+        case MemoryCategory::PrefetchedIrFiles: return "prefetchedIrFiles";
+        case MemoryCategory::RetirePending:     return "retirePending";
+        case MemoryCategory::Count:             break;
+    }
+    return "?";
+}
+
+inline constexpr size_t kNumMemoryCategories = static_cast<size_t>(MemoryCategory::Count);
+
+namespace detail {
+
+struct MemoryLedgerSlot
+{
+    std::atomic<uint64_t> bytes { 0 };
+    std::atomic<uint64_t> peakBytes { 0 };
+    std::atomic<uint32_t> instances { 0 };
+};
+
+} // namespace detail
+
+class MemoryLedger
+{
+public:
+    struct Category
+    {
+        uint64_t bytes = 0;
+        uint64_t peakBytes = 0;     // 起動以降の最大
+        uint32_t instances = 0;     // 0 でない申告を持つ MemoryCharge の数
+    };
+
+    struct Snapshot
+    {
+        std::array<Category, kNumMemoryCategories> categories {};
+
+        [[nodiscard]] const Category& operator[](MemoryCategory c) const noexcept
+        {
+            return categories[static_cast<size_t>(c)];
+        }
+
+        // RetirePending を除いた合計
+        [[nodiscard]] uint64_t totalBytes() const noexcept
+        {
+            uint64_t total = 0;
+            for (size_t i = 0; i < kNumMemoryCategories; ++i)
+                if (static_cast<MemoryCategory>(i) != MemoryCategory::RetirePending)
+                    total += categories[i].bytes;
+            return total;
+        }
+    };
+
+    // MemoryCharge から: 差分の反映 (任意スレッド、lock-free)
+    static void apply(MemoryCategory category, uint64_t oldBytes, uint64_t newBytes) noexcept
+    {
+        Slot& s = slots_[static_cast<size_t>(category)];
+        // relaxed: 表示用の集計値。他のデータの公開には使わない
+        if (newBytes >= oldBytes)
+        {
+            const uint64_t now = convo::fetchAddAtomic(s.bytes, newBytes - oldBytes, std::memory_order_relaxed)
+                               + (newBytes - oldBytes);
+            uint64_t peak = convo::consumeAtomic(s.peakBytes, std::memory_order_relaxed);
+            while (now > peak
+                   && !convo::compareExchangeAtomic(s.peakBytes, peak, now,
+                                                    std::memory_order_relaxed, std::memory_order_relaxed))
+            {
+            }
+        }
+        else
+        {
+            convo::fetchSubAtomic(s.bytes, oldBytes - newBytes, std::memory_order_relaxed);
+        }
+
+        if (oldBytes == 0 && newBytes != 0)
+            convo::fetchAddAtomic(s.instances, 1u, std::memory_order_relaxed);
+        else if (oldBytes != 0 && newBytes == 0)
+            convo::fetchSubAtomic(s.instances, 1u, std::memory_order_relaxed);
+    }
+
+    // 任意スレッド。分類ごとには一貫するが、分類間は同一時点とは限らない
+    [[nodiscard]] static Snapshot snapshot() noexcept
+    {
+        Snapshot out;
+        for (size_t i = 0; i < kNumMemoryCategories; ++i)
+        {
+            // relaxed: 統計値のみ
+            out.categories[i].bytes = convo::consumeAtomic(slots_[i].bytes, std::memory_order_relaxed);
+            out.categories[i].peakBytes = convo::consumeAtomic(slots_[i].peakBytes, std::memory_order_relaxed);
+            out.categories[i].instances = convo::consumeAtomic(slots_[i].instances, std::memory_order_relaxed);
+        }
+        return out;
+    }
+
+private:
+    using Slot = detail::MemoryLedgerSlot;
+
+    static inline std::array<Slot, kNumMemoryCategories> slots_ {};
+};
+
+//------------------------------------------------------------------------------
+// MemoryCharge — 持ち主 1 つ分の申告。持ち主のメンバとして置き、確保の後で set() する。
+//   set() は持ち主の確保・解放と同じスレッドから (持ち主自身の直列化に従う)。ムーブで申告ごと移る。
+//------------------------------------------------------------------------------
+class MemoryCharge
+{
+public:
+    explicit MemoryCharge(MemoryCategory category) noexcept : category_(category) {}
+    // 持ち主と寿命が同じ固定サイズの領域 (インラインのキューなど) はここで申告しておく
+    MemoryCharge(MemoryCategory category, uint64_t bytes) noexcept : category_(category) { set(bytes); }
+    ~MemoryCharge() { set(0); }
+
+    MemoryCharge(MemoryCharge&& other) noexcept
+        : category_(other.category_), bytes_(other.bytes_)
+    {
+        other.bytes_ = 0;
+    }
+
+    MemoryCharge& operator=(MemoryCharge&& other) noexcept
+    {
+        if (this != &other)
+        {
+            set(0);
+            category_ = other.category_;
+            bytes_ = other.bytes_;
+            other.bytes_ = 0;
+        }
+        return *this;
+    }
+
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+    void set(uint64_t bytes) noexcept
+    {
+        if (bytes == bytes_)
+            return;
+        MemoryLedger::apply(category_, bytes_, bytes);
+        bytes_ = bytes;
+    }
+
+    [[nodiscard]] uint64_t bytes() const noexcept { return bytes_; }
+    [[nodiscard]] MemoryCategory category() const noexcept { return category_; }
+
+private:
+    MemoryCategory category_;
+    uint64_t bytes_ = 0;
+};
+
+} // namespace convo
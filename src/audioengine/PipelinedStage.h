@@ -0,0 +1,344 @@
+#pragma once
+
+#include <immintrin.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+
+#include "AtomicAccess.h"
+
+//==============================================================================
+// PipelinedStage — DSP 段を専用ワーカースレッドで 1 ブロック遅れて処理するパイプライン
+//
+//   DSPCore::processDouble は全段をデバイスコールバック内で直列に回すため、チェーン全体の
+//   処理時間が 1 バッファ周期に収まる必要がある。長い IR の Convolver をこのクラスで
+//   ワーカーへ移すと、コールバック n でブロック n を投入し、ワーカーが周期 n の間に処理した
+//   ブロック n−1 の結果を コールバック n+1 で受け取る。Audio Thread と Convolver が別コアで
+//   並行に動くぶん、短いバッファでも周期に収まる。代償は blockSamples サンプルの遅延。
+//
+//   受け渡し (lock-free・ダブルバッファ):
+//     - slot は kNumSlots (= 2) 個。入力を slot へコピーして jobSubmitted を進め (release)、
+//       ワーカーは slot を in-place で処理して jobCompleted を進める (release)。
+//       MKLNonUniformConvolver の Tail Worker と同じ発行 / 完了カウンタ + atomic::wait/notify。
+//     - 受け取った出力は遅延リング (blockSamples) へ書き、同じ長さを読み出す。ブロック長が
+//       毎回変わっても、出力は段の出力列をちょうど blockSamples サンプル遅らせたものになる。
+//
+//   期限切れ:
+//     - 前ブロックの完了はブロック周期の kCollectWaitFraction まで spin (+ yield) で待つ。
+//       間に合わなければ無音で代替し (missedBlocks)、遅れて完了した結果は捨てる。
+//       段は全ジョブを発行順に処理する (状態の連続性を保つため)。
+//       空き slot が無いときは入力ブロックを捨てる (droppedBlocks)。
+//     - numSamples > blockSamples のブロックは受け付けない (process が false を返す)。
+//       呼び出し側は blockSamples 以下に分けて渡す。
+//
+//   start() / stop() / drain() は Message Thread (rebuild thread) 用。
+//   process() / restart() は Audio Thread 用 (確保なし・ロックなし。待つのは spin / yield のみ)。JUCE 非依存。
+//==============================================================================
+
+namespace convo {
+
+class PipelinedStage
+{
+public:
+    static constexpr int kMaxChannels = 2;
+    static constexpr int kNumSlots = 2;
+    // 前ブロックの完了を待つ上限 (今回のブロック周期に対する割合)
+    static constexpr double kCollectWaitFraction = 0.5;
+
+    // 段の処理 (ワーカースレッドで in-place)。channels は numChannels 本・各 numSamples
+    using ProcessFn = void (*)(void* context, double* const* channels, int numChannels, int numSamples) noexcept;
+    using ThreadHookFn = void (*)(void* context) noexcept;
+
+    struct Callbacks
+    {
+        ProcessFn process = nullptr;
+        ThreadHookFn onThreadStart = nullptr; // ワーカー先頭で 1 回 (MMCSS 登録など)。nullptr 可
+        ThreadHookFn onThreadExit = nullptr;  // ワーカー終了直前に 1 回 (MMCSS 解除など)。nullptr 可
+        void* context = nullptr;
+    };
+
+    PipelinedStage() = default;
+    ~PipelinedStage() { stop(); }
+
+    PipelinedStage(const PipelinedStage&) = delete;
+    PipelinedStage& operator=(const PipelinedStage&) = delete;
+
+    // バッファを確保してワーカーを起動する。blockSamples = 1 回の上限 = 追加遅延
+    bool start(const Callbacks& newCallbacks, int newNumChannels, int newBlockSamples, double sampleRate) noexcept
+    {
+        stop();
+        if (newCallbacks.process == nullptr || newNumChannels < 1 || newNumChannels > kMaxChannels
+            || newBlockSamples <= 0 || !(sampleRate > 0.0))
+            return false;
+
+        const size_t channelSamples = static_cast<size_t>(newBlockSamples);
+        std::unique_ptr<double[]> newSlots(new (std::nothrow) double[channelSamples * kMaxChannels * kNumSlots]);
+        std::unique_ptr<double[]> newDelay(new (std::nothrow) double[channelSamples * kMaxChannels]);
+        if (newSlots == nullptr || newDelay == nullptr)
+            return false;
+
+        slotStorage = std::move(newSlots);
+        delayStorage = std::move(newDelay);
+        callbacks = newCallbacks;
+        numChannels = newNumChannels;
+        blockSamples = newBlockSamples;
+        waitNsPerSample = kCollectWaitFraction * 1.0e9 / sampleRate;
+        std::memset(slotStorage.get(), 0, channelSamples * kMaxChannels * kNumSlots * sizeof(double));
+        clearPipeline();
+        convo::publishAtomic(jobSubmitted, std::uint64_t { 0 }, std::memory_order_relaxed); // relaxed: スレッド生成が HB を提供
+        convo::publishAtomic(jobCompleted, std::uint64_t { 0 }, std::memory_order_relaxed);
+        convo::publishAtomic(stopRequested, false, std::memory_order_relaxed);
+
+        try
+        {
+            worker = std::thread([this]() { workerLoop(); });
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        convo::publishAtomic(running, true, std::memory_order_release); // release: isRunning の acquire と HB
+        return true;
+    }
+
+    void stop() noexcept
+    {
+        if (!worker.joinable())
+            return;
+
+        convo::publishAtomic(running, false, std::memory_order_release);       // release: isRunning の acquire と HB
+        convo::publishAtomic(stopRequested, true, std::memory_order_release);  // release: workerLoop の acquire と HB
+        convo::fetchAddAtomic(workSignal, 1u, std::memory_order_release);       // release: wait 解除
+        workSignal.notify_one();
+        worker.join();
+    }
+
+    // 投入済みジョブが全て完了するまで待つ (段の状態を外から触る前に呼ぶ)
+    void drain() const noexcept
+    {
+        if (!isRunning())
+            return;
+        while (convo::consumeAtomic(jobCompleted, std::memory_order_acquire)     // acquire: ワーカーの段処理と HB
+               < convo::consumeAtomic(jobSubmitted, std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    bool isRunning() const noexcept { return convo::consumeAtomic(running, std::memory_order_acquire); }
+    // 追加遅延 (段のサンプルレートでのサンプル数)。停止中は 0
+    int getLatencySamples() const noexcept { return isRunning() ? blockSamples : 0; }
+    int getBlockSamples() const noexcept { return blockSamples; }
+
+    // 診断用 (Audio Thread 専用カウンタ)
+    std::uint64_t getMissedBlocks() const noexcept { return missedBlocks; }
+    std::uint64_t getDroppedBlocks() const noexcept { return droppedBlocks; }
+
+    // channels を段へ投入し、blockSamples 遅れた段の出力で上書きする。
+    // 受け付けられない (停止中・チャンネル数不一致・numSamples > blockSamples) ときは何もせず false
+    bool process(double* const* channels, int channelCount, int numSamples) noexcept
+    {
+        if (!isRunning() || channelCount != numChannels || numSamples > blockSamples)
+            return false;
+        if (numSamples <= 0)
+            return true;
+
+        dirty = true;
+
+        // 1. 今回のブロックを空き slot へ投入
+        const std::uint64_t submitted = convo::consumeAtomic(jobSubmitted, std::memory_order_relaxed); // relaxed: 書き手は Audio Thread のみ
+        const std::uint64_t completed = convo::consumeAtomic(jobCompleted, std::memory_order_acquire); // acquire: ワーカーの slot 使用完了と HB
+        const bool slotFree = submitted - completed < static_cast<std::uint64_t>(kNumSlots);
+        if (slotFree)
+        {
+            const int slot = static_cast<int>(submitted % static_cast<std::uint64_t>(kNumSlots));
+            for (int ch = 0; ch < numChannels; ++ch)
+                std::memcpy(slotChannel(slot, ch), channels[ch], static_cast<size_t>(numSamples) * sizeof(double));
+            slotSamples[slot] = numSamples;
+            convo::publishAtomic(jobSubmitted, submitted + 1, std::memory_order_release); // release: slot 書き込みをワーカーの acquire と HB
+            convo::fetchAddAtomic(workSignal, 1u, std::memory_order_release);              // release: workerLoop の wait 解除と HB
+            // notify_one は待機スレッドの起床のみ (Windows: WakeByAddressSingle) でブロックしない
+            workSignal.notify_one();
+        }
+        else
+        {
+            ++droppedBlocks;
+        }
+
+        // 2. 前回のブロックの出力を遅延リングへ (期限切れ・投入できなかったブロックは無音)
+        if (owedSamples > 0)
+        {
+            if (owedJobValid && waitForJob(owedJob, numSamples))
+            {
+                const int slot = static_cast<int>(owedJob % static_cast<std::uint64_t>(kNumSlots));
+                for (int ch = 0; ch < numChannels; ++ch)
+                    delayWrite(ch, slotChannel(slot, ch), owedSamples);
+            }
+            else
+            {
+                if (owedJobValid)
+                    ++missedBlocks;
+                for (int ch = 0; ch < numChannels; ++ch)
+                    delayWrite(ch, nullptr, owedSamples);
+            }
+            delayWritePos = wrap(delayWritePos + owedSamples);
+        }
+
+        // 3. blockSamples 前の出力を読み出す (書き込み後のリングは常に満杯 = 読み位置と書き位置が一致)
+        for (int ch = 0; ch < numChannels; ++ch)
+            delayRead(ch, channels[ch], numSamples);
+        delayReadPos = wrap(delayReadPos + numSamples);
+
+        owedSamples = numSamples;
+        owedJobValid = slotFree;
+        owedJob = submitted;
+        return true;
+    }
+
+    // 遅延リングを無音で満たし直し、投入中のジョブの結果を捨てる (段のバイパス復帰・同期処理への切替時)
+    void restart() noexcept
+    {
+        if (dirty)
+            clearPipeline();
+    }
+
+private:
+    double* slotChannel(int slot, int ch) const noexcept
+    {
+        return slotStorage.get() + (static_cast<size_t>(slot) * kMaxChannels + static_cast<size_t>(ch)) * static_cast<size_t>(blockSamples);
+    }
+
+    double* delayChannel(int ch) const noexcept
+    {
+        return delayStorage.get() + static_cast<size_t>(ch) * static_cast<size_t>(blockSamples);
+    }
+
+    int wrap(int pos) const noexcept { return (pos >= blockSamples) ? pos - blockSamples : pos; }
+
+    // src == nullptr で無音
+    void delayWrite(int ch, const double* src, int n) noexcept
+    {
+        double* ring = delayChannel(ch);
+        const int first = std::min(n, blockSamples - delayWritePos);
+        if (src != nullptr)
+        {
+            std::memcpy(ring + delayWritePos, src, static_cast<size_t>(first) * sizeof(double));
+            std::memcpy(ring, src + first, static_cast<size_t>(n - first) * sizeof(double));
+        }
+        else
+        {
+            std::memset(ring + delayWritePos, 0, static_cast<size_t>(first) * sizeof(double));
+            std::memset(ring, 0, static_cast<size_t>(n - first) * sizeof(double));
+        }
+    }
+
+    void delayRead(int ch, double* dst, int n) const noexcept
+    {
+        const double* ring = delayChannel(ch);
+        const int first = std::min(n, blockSamples - delayReadPos);
+        std::memcpy(dst, ring + delayReadPos, static_cast<size_t>(first) * sizeof(double));
+        std::memcpy(dst + first, ring, static_cast<size_t>(n - first) * sizeof(double));
+    }
+
+    void clearPipeline() noexcept
+    {
+        std::memset(delayStorage.get(), 0, static_cast<size_t>(blockSamples) * kMaxChannels * sizeof(double));
+        delayWritePos = 0;
+        delayReadPos = 0;
+        owedSamples = 0;
+        owedJobValid = false;
+        owedJob = 0;
+        dirty = false;
+    }
+
+    // job の完了を今回のブロック周期 × kCollectWaitFraction まで待つ
+    bool waitForJob(std::uint64_t job, int numSamples) const noexcept
+    {
+        if (convo::consumeAtomic(jobCompleted, std::memory_order_acquire) > job) // acquire: ワーカーの出力 slot 書き込みと HB
+            return true;
+
+        const auto deadline = std::chrono::steady_clock::now()
+                            + std::chrono::nanoseconds(static_cast<std::int64_t>(waitNsPerSample * numSamples));
+        for (;;)
+        {
+            for (int spin = 0; spin < 64; ++spin)
+            {
+                _mm_pause();
+                if (convo::consumeAtomic(jobCompleted, std::memory_order_acquire) > job) // acquire: 同上
+                    return true;
+            }
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+            // ワーカーと同じコアに載っている場合に備えて CPU を譲る (待ちの間は Audio Thread に仕事が無い)
+            std::this_thread::yield();
+        }
+    }
+
+    // ジョブは必ず発行順に全件処理する (期限切れでも段の状態の連続性を保つため)
+    void workerLoop() noexcept
+    {
+        if (callbacks.onThreadStart != nullptr)
+            callbacks.onThreadStart(callbacks.context);
+
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+
+        for (;;)
+        {
+            const std::uint32_t seenSignal = convo::consumeAtomic(workSignal, std::memory_order_acquire); // acquire: process の release と HB
+            if (convo::consumeAtomic(stopRequested, std::memory_order_acquire)) // acquire: stop の release と HB
+                break;
+
+            std::uint64_t completed = convo::consumeAtomic(jobCompleted, std::memory_order_relaxed); // relaxed: 書き手はワーカーのみ
+            const std::uint64_t submitted = convo::consumeAtomic(jobSubmitted, std::memory_order_acquire); // acquire: 入力 slot 書き込みと HB
+            const bool hadWork = completed < submitted;
+
+            while (completed < submitted)
+            {
+                const int slot = static_cast<int>(completed % static_cast<std::uint64_t>(kNumSlots));
+                double* channels[kMaxChannels] = { slotChannel(slot, 0), slotChannel(slot, 1) };
+                callbacks.process(callbacks.context, channels, numChannels, slotSamples[slot]);
+                ++completed;
+                convo::publishAtomic(jobCompleted, completed, std::memory_order_release); // release: 出力 slot を Audio Thread の acquire と HB
+            }
+
+            if (!hadWork)
+                workSignal.wait(seenSignal, std::memory_order_acquire);
+        }
+
+        if (callbacks.onThreadExit != nullptr)
+            callbacks.onThreadExit(callbacks.context);
+    }
+
+    Callbacks callbacks;
+    int numChannels = 0;
+    int blockSamples = 0;
+    double waitNsPerSample = 0.0;
+
+    std::unique_ptr<double[]> slotStorage;  // [slot][channel][blockSamples]。ジョブ中はワーカーが専有
+    int slotSamples[kNumSlots] {};          // jobSubmitted の release で公開
+    std::unique_ptr<double[]> delayStorage; // [channel][blockSamples]。Audio Thread 専用
+
+    // Audio Thread 専用
+    int delayWritePos = 0;
+    int delayReadPos = 0;
+    int owedSamples = 0;        // 前回投入したブロック長 (今回リングへ書く量)
+    bool owedJobValid = false;  // 前回のブロックを slot へ投入できたか
+    std::uint64_t owedJob = 0;
+    bool dirty = false;
+    std::uint64_t missedBlocks = 0;
+    std::uint64_t droppedBlocks = 0;
+
+    std::thread worker;
+    std::atomic<bool> running { false };
+    std::atomic<bool> stopRequested { false };
+    alignas(64) std::atomic<std::uint64_t> jobSubmitted { 0 };
+    alignas(64) std::atomic<std::uint64_t> jobCompleted { 0 };
+    alignas(64) std::atomic<std::uint32_t> workSignal { 0 }; // atomic::wait/notify 用の起床カウンタ
+};
+
+} // namespace convo
@@ -12,9 +12,8 @@ PublicationAdmission::Decision PublicationAdmission::evaluate(
         return Decision::RejectedShutdown;
 
     // 2. Generation staleness check
-    const int currentGen = convo::consumeAtomic(
-        engine.rebuildRequestGeneration, std::memory_order_acquire);
-    if (req.generation != currentGen)
+    //    最新世代に加え、Light レーンに追い越されただけの最新 Heavy も (より新しい世代が未出版なら) 受理する
+    if (!engine.isRebuildGenerationPublishable(req.generation))
         return Decision::RejectedStaleGeneration;
 
     // 3. DSP finalized check (from sealedSnapshot, not DSPCore*)
@@ -2,6 +2,7 @@
 #include "AudioEngine.h"
 #include "RuntimeBuilder.h"
 #include "core/TimeUtils.h"
+#include "EtwTrace.h"
 
 namespace convo::isr {
 
@@ -32,13 +33,20 @@ PublishResult PublicationExecutor::publish(
 
     // ★ work70 P1-a: publishWorld 直接呼び出し → commitRuntimePublication トランザクション
     auto coordinator = engine.makeRuntimePublicationCoordinator();
-    const auto result = engine.commitRuntimePublication(
-        coordinator, std::move(stateOwner),
-        AudioEngine::RegistrationContext::alreadyRegistered(existingHandle));
+    const auto result = [&]() noexcept
+    {
+        // ★ xrun 原因相関: commit と重なった callback に publish フラグを立てる
+        convo::ActivityWindow::Scope publishActivity(engine.m_healthMonitor.getXrunCorrelator().publicationActivity());
+        return engine.commitRuntimePublication(
+            coordinator, std::move(stateOwner),
+            AudioEngine::RegistrationContext::alreadyRegistered(existingHandle));
+    }();
 
     const uint64_t publishEndUs = convo::getCurrentTimeUs();
 
     if (!AudioEngine::PublishStageResultTraits::isCommitted(result.stage)) {
+        if (convo::EtwTrace::isEnabled(convo::EtwTrace::kPublication))
+            convo::EtwTrace::publicationCommit(0, worldGen, worldId, publishEndUs - publishStartUs, false);
         juce::Logger::writeToLog("[PUBLISH] commitRuntimePublication FAILED gen="
             + juce::String(static_cast<juce::int64>(worldGen))
             + " ownership=" + juce::String(static_cast<int>(result.ownership)));
@@ -50,6 +58,9 @@ PublishResult PublicationExecutor::publish(
     }
 
     const auto seq = engine.getLastCommittedPublicationSequence();
+    if (convo::EtwTrace::isEnabled(convo::EtwTrace::kPublication))
+        convo::EtwTrace::publicationCommit(static_cast<uint64_t>(seq), worldGen, worldId,
+                                           publishEndUs - publishStartUs, true);
     // ★ PublishTimingHistory に書き込み（NonRT writer → RT reader lookup）
     const uint64_t wc = convo::fetchAddAtomic(
         engine.rtLocalState_.publishTimingWriteCount,
@@ -0,0 +1,203 @@
+// RtSafetyGuard.cpp — RtSafetyGuard のフック (アプリ本体のみ)
+//
+//   operator new       : このファイルで置き換え (無効時は thread_local 読み 1 回を足すだけ)
+//   aligned_malloc     : AlignedAllocation.h が直接 noteViolation する
+//   mkl_malloc / MKL   : MKL の i_malloc / i_calloc / i_realloc を差し替え (最初の MKL 呼び出しより前に install)
+//   std::mutex         : 実行ファイルの IAT の AcquireSRWLockExclusive / Shared を差し替え
+//   JUCE のロック      : 同じく EnterCriticalSection を差し替え
+//
+//   静的 CRT (/MT) と JUCE は実行ファイルに入っているので、ロック API は実行ファイル自身の IAT を
+//   通る。ASIO ドライバなど別 DLL の内部のロックは対象外 (こちらのコードの違反ではない)。
+
+#include "RtSafetyGuard.h"
+
+#include <JuceHeader.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <malloc.h>
+
+#include <mkl.h>
+#include <i_malloc.h>
+
+#include <windows.h>
+
+namespace {
+
+uint32_t captureStackHash() noexcept
+{
+    // record / noteViolation / フック自身の 3 フレームを飛ばし、呼び出し元からの 24 フレームで同一視する
+    void* frames[24];
+    ULONG hash = 0;
+    if (::RtlCaptureStackBackTrace(3, 24, frames, &hash) == 0)
+        return 0;
+    return static_cast<uint32_t>(hash);
+}
+
+void logViolationAndAbort(const convo::RtViolation& v) noexcept
+{
+    char line[256];
+    std::snprintf(line, sizeof(line), "[RT_GUARD] abort on first violation: kind=%s stage=%s bytes=%llu stack=0x%08x cb=%llu",
+                  convo::rtViolationKindName(v.kind),
+                  v.stage != convo::DspStage::Count ? convo::dspStageName(v.stage) : "outside",
+                  static_cast<unsigned long long>(v.bytes), static_cast<unsigned>(v.stackHash),
+                  static_cast<unsigned long long>(v.callbackIndex));
+    std::fprintf(stderr, "%s\n", line);
+    std::fflush(stderr);
+    juce::Logger::writeToLog(line);
+}
+
+//------------------------------------------------------------------------------
+// MKL
+//------------------------------------------------------------------------------
+void* (*g_mklMalloc)(size_t) = nullptr;
+void* (*g_mklCalloc)(size_t, size_t) = nullptr;
+void* (*g_mklRealloc)(void*, size_t) = nullptr;
+
+void* guardedMklMalloc(size_t size)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::MklMalloc, size);
+    return g_mklMalloc(size);
+}
+
+void* guardedMklCalloc(size_t count, size_t size)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::MklMalloc, count * size);
+    return g_mklCalloc(count, size);
+}
+
+void* guardedMklRealloc(void* ptr, size_t size)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::MklMalloc, size);
+    return g_mklRealloc(ptr, size);
+}
+
+//------------------------------------------------------------------------------
+// ロック API (IAT)
+//------------------------------------------------------------------------------
+using SrwLockFn = void (WINAPI*)(PSRWLOCK);
+using CriticalSectionFn = void (WINAPI*)(LPCRITICAL_SECTION);
+
+SrwLockFn g_acquireSrwExclusive = nullptr;
+SrwLockFn g_acquireSrwShared = nullptr;
+CriticalSectionFn g_enterCriticalSection = nullptr;
+
+void WINAPI guardedAcquireSrwExclusive(PSRWLOCK lock)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::StdMutexLock);
+    g_acquireSrwExclusive(lock);
+}
+
+void WINAPI guardedAcquireSrwShared(PSRWLOCK lock)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::StdMutexLock);
+    g_acquireSrwShared(lock);
+}
+
+void WINAPI guardedEnterCriticalSection(LPCRITICAL_SECTION section)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::JuceLock);
+    g_enterCriticalSection(section);
+}
+
+// 実行ファイルの import テーブルから名前で探し、最初に見つかったスロットを hook に差し替える
+// (kernel32.dll / api-ms-win-core-synch-* のどちらから import されていてもよい)
+template <typename Fn>
+bool patchImport(const char* functionName, Fn hook, Fn& original) noexcept
+{
+    auto* base = reinterpret_cast<uint8_t*>(::GetModuleHandleW(nullptr));
+    const auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+    const auto* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+    const auto& directory = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
+    if (directory.VirtualAddress == 0)
+        return false;
+
+    for (auto* desc = reinterpret_cast<IMAGE_IMPORT_DESCRIPTOR*>(base + directory.VirtualAddress); desc->Name != 0; ++desc)
+    {
+        if (desc->OriginalFirstThunk == 0)
+            continue;
+        auto* names = reinterpret_cast<IMAGE_THUNK_DATA*>(base + desc->OriginalFirstThunk);
+        auto* slots = reinterpret_cast<IMAGE_THUNK_DATA*>(base + desc->FirstThunk);
+        for (; names->u1.AddressOfData != 0; ++names, ++slots)
+        {
+            if (IMAGE_SNAP_BY_ORDINAL(names->u1.Ordinal))
+                continue;
+            const auto* byName = reinterpret_cast<const IMAGE_IMPORT_BY_NAME*>(base + names->u1.AddressOfData);
+            if (std::strcmp(reinterpret_cast<const char*>(byName->Name), functionName) != 0)
+                continue;
+
+            DWORD oldProtect = 0;
+            if (!::VirtualProtect(&slots->u1.Function, sizeof(slots->u1.Function), PAGE_READWRITE, &oldProtect))
+                return false;
+            original = reinterpret_cast<Fn>(slots->u1.Function);
+            slots->u1.Function = reinterpret_cast<ULONG_PTR>(hook);
+            ::VirtualProtect(&slots->u1.Function, sizeof(slots->u1.Function), oldProtect, &oldProtect);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+namespace convo {
+
+int RtSafetyGuard::install(bool abortOnViolation)
+{
+#if CONVOPEQ_RT_GUARD
+    static bool installed = false;
+    int hooks = 1;   // operator new は常に置き換え済み
+    if (!installed)
+    {
+        installed = true;
+        g_mklMalloc = i_malloc;
+        g_mklCalloc = i_calloc;
+        g_mklRealloc = i_realloc;
+        i_malloc = guardedMklMalloc;
+        i_calloc = guardedMklCalloc;
+        i_realloc = guardedMklRealloc;
+        hooks += 1;
+
+        hooks += patchImport("AcquireSRWLockExclusive", &guardedAcquireSrwExclusive, g_acquireSrwExclusive) ? 1 : 0;
+        hooks += patchImport("AcquireSRWLockShared", &guardedAcquireSrwShared, g_acquireSrwShared) ? 1 : 0;
+        hooks += patchImport("EnterCriticalSection", &guardedEnterCriticalSection, g_enterCriticalSection) ? 1 : 0;
+    }
+
+    configure(true, abortOnViolation, &captureStackHash, &logViolationAndAbort);
+    juce::Logger::writeToLog("[RT_GUARD] enabled hooks=" + juce::String(hooks)
+                             + (abortOnViolation ? " abortOnViolation=1" : ""));
+    return hooks;
+#else
+    juce::ignoreUnused(abortOnViolation);
+    juce::Logger::writeToLog("[RT_GUARD] not available (built with CONVOPEQ_ENABLE_RT_GUARD=OFF)");
+    return 0;
+#endif
+}
+
+} // namespace convo
+
+#if CONVOPEQ_RT_GUARD
+//==============================================================================
+// operator new の置き換え
+//   配列版・nothrow 版は CRT の既定実装がこの 2 つへ転送するので置き換えない。
+//   delete も既定 (free / _aligned_free) のままで確保側と対になる。
+//==============================================================================
+void* operator new(std::size_t size)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::OperatorNew, size);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    convo::RtSafetyGuard::noteViolation(convo::RtViolationKind::OperatorNew, size);
+    if (void* p = ::_aligned_malloc(size == 0 ? 1 : size, static_cast<std::size_t>(alignment)))
+        return p;
+    throw std::bad_alloc();
+}
+#endif
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "AtomicAccess.h"
+#include "DspStage.h"
+#include "../LockFreeRingBuffer.h"
+
+// CMake の CONVOPEQ_ENABLE_RT_GUARD=OFF で 0 (フックも記録もコンパイルされない)
+#ifndef CONVOPEQ_RT_GUARD
+#define CONVOPEQ_RT_GUARD 1
+#endif
+
+//==============================================================================
+// RtSafetyGuard — Audio Thread の「確保なし・ロックなし」を実行時に検査する (--rt-guard で有効)
+//
+//   getNextAudioBlock / processBlockDouble の間だけ thread_local のフラグを立て、その間に
+//   operator new・convo::aligned_malloc・mkl_malloc (MKL 内部確保を含む)・std::mutex・JUCE のロックが
+//   呼ばれたら違反として 1 件記録する。違反はまずコールバック内のバッファに貯め、次の
+//   StageLatencyProbe::lap() で「その段で起きた」と段を付け、コールバックの終わりに SPSC リングへ移す。
+//   Message Thread (MainWindow) がリングを読んで [RT_GUARD] としてログに出す。
+//   --rt-guard-abort では段を付けた時点で最初の違反をログに残して abort する (ソークテスト用)。
+//
+//   フック本体 (operator new の置き換え・MKL の i_malloc・ロック API の IAT 差し替え) と
+//   スタックハッシュの取得は RtSafetyGuard.cpp (アプリ本体のみ) が install() で差し込む。
+//   このヘッダだけならフックは無く、noteViolation() を直接呼んだ分だけが記録される (テスト用)。
+//
+//   無効時のコストは確保・ロックごとの thread_local 読み 1 回。isr::RTAllocatorFirewall は
+//   プロセス共有のフラグで RT 文脈を示すだけで、違反の検出と記録はこちらが行う。
+//==============================================================================
+
+namespace convo {
+
+enum class RtViolationKind : uint8_t
+{
+    OperatorNew,
+    AlignedMalloc,    // convo::aligned_malloc (内部の mkl_malloc は二重に数えない)
+    MklMalloc,        // mkl_malloc の直接呼び出しと MKL の内部確保
+    StdMutexLock,     // SRW ロック (std::mutex / std::shared_mutex)
+    JuceLock,         // CRITICAL_SECTION (juce::CriticalSection / ScopedLock)
+    Count
+};
+
+[[nodiscard]] constexpr const char* rtViolationKindName(RtViolationKind kind) noexcept
+{
+    switch (kind)
+    {
+        case RtViolationKind::OperatorNew:   return "new";
+        case RtViolationKind::AlignedMalloc: return "aligned_malloc";
+        case RtViolationKind::MklMalloc:     return "mkl_malloc";
+        case RtViolationKind::StdMutexLock:  return "std_mutex";
+        case RtViolationKind::JuceLock:      return "juce_lock";
+        case RtViolationKind::Count:         break;
+    }
+    return "?";
+}
+
+inline constexpr size_t kNumRtViolationKinds = static_cast<size_t>(RtViolationKind::Count);
+
+struct RtViolation
+{
+    uint64_t callbackIndex = 0;
+    uint64_t bytes = 0;                    // 確保サイズ (ロックは 0)
+    uint32_t stackHash = 0;                // 0 = 取得できない
+    RtViolationKind kind = RtViolationKind::Count;
+    DspStage stage = DspStage::Count;      // Count = 段の外 (コールバックの入口・出口の処理)
+};
+
+namespace detail {
+
+// Audio Thread ごとの 1 コールバック分の状態 (RtSafetyGuard 専用)
+struct RtGuardThreadState
+{
+    static constexpr size_t kCapacity = 8;
+
+    bool armed = false;
+    uint64_t callbackIndex = 0;
+    size_t count = 0;          // entries の使用数
+    size_t attributed = 0;     // [0, attributed) は段が付いている
+    uint64_t overflow = 0;
+    std::array<RtViolation, kCapacity> entries {};
+};
+
+} // namespace detail
+
+class RtSafetyGuard
+{
+public:
+    static constexpr size_t kCallbackCapacity = detail::RtGuardThreadState::kCapacity;   // 1 コールバック内で保持する件数 (超過分は dropped)
+    static constexpr size_t kPendingCapacity = 64;
+
+    using StackHashFn = uint32_t (*)() noexcept;
+    using AbortFn = void (*)(const RtViolation& violation) noexcept;   // 戻らないこと
+
+    struct Counters
+    {
+        uint64_t total = 0;
+        uint64_t dropped = 0;      // コールバック内バッファかリングが溢れて捨てた件数
+        std::array<uint64_t, kNumRtViolationKinds> byKind {};
+    };
+
+    // Audio Thread: コールバックの間だけ違反を数える。無効なら何もしない
+    class CallbackScope
+    {
+    public:
+        explicit CallbackScope(uint64_t callbackIndex) noexcept
+        {
+#if CONVOPEQ_RT_GUARD
+            // acquire: configure() がフック関数を書いてから enabled_ を release するのと対
+            if (!convo::consumeAtomic(enabled_, std::memory_order_acquire))
+                return;
+            ThreadState& t = threadState_;
+            t = ThreadState {};
+            t.callbackIndex = callbackIndex;
+            t.armed = true;
+            active_ = true;
+#else
+            (void)callbackIndex;
+#endif
+        }
+
+        ~CallbackScope() { if (active_) finishCallback(); }
+
+        CallbackScope(const CallbackScope&) = delete;
+        CallbackScope& operator=(const CallbackScope&) = delete;
+
+    private:
+        bool active_ = false;
+    };
+
+    // 内側の確保を数えない区間 (aligned_malloc → mkl_malloc の二重計上を避ける)
+    class UncheckedScope
+    {
+    public:
+        UncheckedScope() noexcept : wasArmed_(threadState_.armed) { threadState_.armed = false; }
+        ~UncheckedScope() { threadState_.armed = wasArmed_; }
+
+        UncheckedScope(const UncheckedScope&) = delete;
+        UncheckedScope& operator=(const UncheckedScope&) = delete;
+
+    private:
+        bool wasArmed_;
+    };
+
+    // Message Thread (起動時、Audio Thread の開始前)
+    static void configure(bool enabled, bool abortOnViolation,
+                          StackHashFn stackHash = nullptr, AbortFn onAbort = nullptr) noexcept
+    {
+        // relaxed: 下の enabled_ の release で CallbackScope に見せる
+        convo::publishAtomic(stackHash_, stackHash, std::memory_order_relaxed);
+        convo::publishAtomic(onAbort_, onAbort, std::memory_order_relaxed);
+        convo::publishAtomic(abortOnViolation_, abortOnViolation, std::memory_order_relaxed);
+        convo::publishAtomic(enabled_, enabled, std::memory_order_release);
+    }
+
+    // RtSafetyGuard.cpp: フックを差し込んで configure(true, ...) する。差し込めたフックの数を返す
+    static int install(bool abortOnViolation);
+
+    [[nodiscard]] static bool isEnabled() noexcept
+    {
+        return convo::consumeAtomic(enabled_, std::memory_order_relaxed); // relaxed: 表示用
+    }
+
+    // フックから呼ばれる (任意スレッド)。CallbackScope の内側でなければ何もしない
+    static void noteViolation(RtViolationKind kind, size_t bytes = 0) noexcept
+    {
+#if CONVOPEQ_RT_GUARD
+        if (threadState_.armed) [[unlikely]]
+            record(kind, bytes);
+#else
+        (void)kind;
+        (void)bytes;
+#endif
+    }
+
+    // StageLatencyProbe::lap から: 前回の lap 以降に記録した違反をこの段のものとする
+    static void onStageLap(DspStage stage) noexcept
+    {
+#if CONVOPEQ_RT_GUARD
+        if (threadState_.attributed != threadState_.count) [[unlikely]]
+            attribute(stage);
+#else
+        (void)stage;
+#endif
+    }
+
+    // Message Thread: 1 件取り出す
+    static bool pop(RtViolation& out) noexcept
+    {
+        return pending_.pop(out);
+    }
+
+    [[nodiscard]] static Counters counters() noexcept
+    {
+        // relaxed: 統計値のみ
+        Counters out;
+        out.total = convo::consumeAtomic(total_, std::memory_order_relaxed);
+        out.dropped = convo::consumeAtomic(dropped_, std::memory_order_relaxed);
+        for (size_t k = 0; k < kNumRtViolationKinds; ++k)
+            out.byKind[k] = convo::consumeAtomic(byKind_[k], std::memory_order_relaxed);
+        return out;
+    }
+
+private:
+    using ThreadState = detail::RtGuardThreadState;
+
+    static void record(RtViolationKind kind, size_t bytes) noexcept
+    {
+        ThreadState& t = threadState_;
+        UncheckedScope unchecked;   // スタック取得や中断処理の中の確保・ロックは数えない
+        if (t.count == kCallbackCapacity)
+        {
+            ++t.overflow;
+            return;
+        }
+        RtViolation& v = t.entries[t.count++];
+        v.callbackIndex = t.callbackIndex;
+        v.bytes = bytes;
+        v.kind = kind;
+        v.stage = DspStage::Count;
+        const StackHashFn hash = convo::consumeAtomic(stackHash_, std::memory_order_relaxed); // relaxed: 起動時に固定
+        v.stackHash = hash != nullptr ? hash() : 0;
+    }
+
+    static void attribute(DspStage stage) noexcept
+    {
+        ThreadState& t = threadState_;
+        const size_t first = t.attributed;
+        for (size_t i = first; i < t.count; ++i)
+            t.entries[i].stage = stage;
+        t.attributed = t.count;
+
+        // relaxed: 起動時に固定される設定値
+        if (first == 0 && convo::consumeAtomic(abortOnViolation_, std::memory_order_relaxed))
+        {
+            UncheckedScope unchecked;
+            if (const AbortFn onAbort = convo::consumeAtomic(onAbort_, std::memory_order_relaxed))
+                onAbort(t.entries[0]);
+            std::abort();
+        }
+    }
+
+    static void finishCallback() noexcept
+    {
+        ThreadState& t = threadState_;
+        t.armed = false;
+        if (t.count == 0 && t.overflow == 0)
+            return;
+        attribute(DspStage::Count);
+
+        // relaxed: 以下は件数のみ。違反本体はリングの release / acquire で渡る
+        uint64_t dropped = t.overflow;
+        for (size_t i = 0; i < t.count; ++i)
+        {
+            convo::fetchAddAtomic(byKind_[static_cast<size_t>(t.entries[i].kind)], uint64_t{1}, std::memory_order_relaxed);
+            if (!pending_.push(t.entries[i]))
+                ++dropped;
+        }
+        convo::fetchAddAtomic(total_, static_cast<uint64_t>(t.count) + t.overflow, std::memory_order_relaxed);
+        if (dropped != 0)
+            convo::fetchAddAtomic(dropped_, dropped, std::memory_order_relaxed);
+        t.count = 0;
+        t.attributed = 0;
+        t.overflow = 0;
+    }
+
+    static inline thread_local ThreadState threadState_ {};
+
+    static inline std::atomic<bool> enabled_ { false };
+    static inline std::atomic<bool> abortOnViolation_ { false };
+    static inline std::atomic<StackHashFn> stackHash_ { nullptr };
+    static inline std::atomic<AbortFn> onAbort_ { nullptr };
+
+    // 書き手は Audio Thread (同時に 1 本)、読み手は Message Thread の SPSC
+    static inline LockFreeRingBuffer<RtViolation, kPendingCapacity> pending_ {};
+    static inline std::atomic<uint64_t> total_ { 0 };
+    static inline std::atomic<uint64_t> dropped_ { 0 };
+    static inline std::array<std::atomic<uint64_t>, kNumRtViolationKinds> byKind_ {};
+};
+
+} // namespace convo
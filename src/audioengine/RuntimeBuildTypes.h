@@ -23,6 +23,7 @@ struct BuildInput final {
     int ditherBitDepth = 0;
     int oversamplingFactor = 0;
     int oversamplingType = 0;
+    bool oversamplingSinglePrecision = false;  // ★ OS 段 2 以降を float32 で処理
     int noiseShaperType = 0;
     int processingOrder = 0;
     bool eqBypassed = false;
@@ -320,6 +321,7 @@ static_assert(std::is_trivially_copyable_v<BuildDiagnostics>,
         && snapshot.buildInput.ditherBitDepth == other.buildInput.ditherBitDepth
         && snapshot.buildInput.oversamplingFactor == other.buildInput.oversamplingFactor
         && snapshot.buildInput.oversamplingType == other.buildInput.oversamplingType
+        && snapshot.buildInput.oversamplingSinglePrecision == other.buildInput.oversamplingSinglePrecision
         && snapshot.buildInput.noiseShaperType == other.buildInput.noiseShaperType
         && snapshot.buildInput.processingOrder == other.buildInput.processingOrder
         && snapshot.buildInput.eqBypassed == other.buildInput.eqBypassed
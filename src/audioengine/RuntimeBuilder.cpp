@@ -35,6 +35,7 @@ namespace {
     mix(static_cast<std::uint64_t>(buildInput.ditherBitDepth));
     mix(static_cast<std::uint64_t>(buildInput.oversamplingFactor));
     mix(static_cast<std::uint64_t>(buildInput.oversamplingType));
+    mix(static_cast<std::uint64_t>(buildInput.oversamplingSinglePrecision));
     mix(static_cast<std::uint64_t>(buildInput.noiseShaperType));
     mix(static_cast<std::uint64_t>(buildInput.processingOrder));
     mix(static_cast<std::uint64_t>(buildInput.eqBypassed));
@@ -48,6 +49,40 @@ namespace {
     return hash;
 }
 
+// ★ 増分検証: 前回 publish された World から値が変わったフィールドの集合を返す。
+//   値比較できるのは operator== を持つ Semantic 構造体のみ。それ以外 (engine / graph /
+//   dspProjection など) と publication ごとに打ち直す識別フィールド (generation /
+//   publication / metadata など) は常に dirty とする (取りこぼしより再検証を選ぶ)。
+//   前回 World が無いとき、kFullWorldValidationInterval 回に 1 回、および
+//   CONVOPEQ_FULL_WORLD_VALIDATION 構成では全フィールドを dirty にして全検証へ戻す。
+[[nodiscard]] convo::isr::RuntimeFieldMask computeDirtyFieldMask(const RuntimePublishWorld& next,
+                                                                const RuntimePublishWorld* previous,
+                                                                convo::isr::PublicationSequenceId sequence) noexcept
+{
+    if (convo::isr::kAlwaysFullWorldValidation
+        || previous == nullptr
+        || (sequence % convo::isr::kFullWorldValidationInterval) == 0)
+        return convo::isr::kAllRuntimeFieldsDirty;
+
+    convo::isr::RuntimeFieldMask unchanged = 0;
+    const auto markUnchanged = [&unchanged](bool equal, convo::isr::RuntimeFieldMask bit) noexcept {
+        if (equal)
+            unchanged |= bit;
+    };
+    markUnchanged(next.topology == previous->topology, RuntimeState::fieldBit("topology"));
+    markUnchanged(next.routing == previous->routing, RuntimeState::fieldBit("routing"));
+    markUnchanged(next.execution == previous->execution, RuntimeState::fieldBit("execution"));
+    markUnchanged(next.overlap == previous->overlap, RuntimeState::fieldBit("overlap"));
+    markUnchanged(next.retire == previous->retire, RuntimeState::fieldBit("retire"));
+    markUnchanged(next.timing == previous->timing, RuntimeState::fieldBit("timing"));
+    markUnchanged(next.latency == previous->latency, RuntimeState::fieldBit("latency"));
+    markUnchanged(next.resource == previous->resource, RuntimeState::fieldBit("resource"));
+    markUnchanged(next.affinity == previous->affinity, RuntimeState::fieldBit("affinity"));
+    markUnchanged(next.automation == previous->automation, RuntimeState::fieldBit("automation"));
+    markUnchanged(next.coefficient == previous->coefficient, RuntimeState::fieldBit("coefficient"));
+    return convo::isr::kAllRuntimeFieldsDirty & ~unchanged;
+}
+
 } // namespace
 
 const char* toString(BuildError error) noexcept
@@ -413,6 +448,11 @@ RuntimeBuilder::buildRuntimePublishWorld(
         ^ (worldOwner->routing.eqBypassed ? 0x27D4EB2Full : 0ull)
         ^ (worldOwner->routing.convBypassed ? 0x165667B1ull : 0ull);
 
+    // ★ 増分検証: 全フィールドを書き終えた後に前回 World との差分を載せる
+    worldOwner->metadata.dirtyFieldMask = computeDirtyFieldMask(*worldOwner,
+                                                                spec.currentRuntimeWorld,
+                                                                nextPublicationSequence);
+
     // freeze は caller (coordinator.publishWorld) が行う
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
@@ -450,6 +490,7 @@ BuildResult RuntimeBuilder::build(const BuildInput& in,
                          in.ditherBitDepth,
                          in.oversamplingFactor,
                          static_cast<AudioEngine::OversamplingType>(in.oversamplingType),
+                         in.oversamplingSinglePrecision,
                          static_cast<AudioEngine::NoiseShaperType>(in.noiseShaperType),
                          &engine);
         result.runtime = runtime.release();
@@ -17,6 +17,7 @@ uint64_t RuntimeHealthMonitor::getRetireStallDurationUs() const noexcept {
 }
 
 void RuntimeHealthMonitor::tick() noexcept {
+    m_xrunCorrelator_.drain();
     checkRetireStall();
     checkPublicationStall();
     diagnoseRetireStall();
@@ -46,6 +47,7 @@ void RuntimeHealthMonitor::tick() noexcept {
 
     // [work39 Phase 5] Learner FIFO 監視
     checkLearnerBackpressure();
+    updateLearnerThrottle();
 
     // [work37 Phase 9.10 P2] Configuration Drift 監視
     checkConfigurationDrift();
@@ -599,6 +601,19 @@ void RuntimeHealthMonitor::checkLearnerBackpressure() noexcept
     }
 }
 
+// 学習スロットリング: 段階が変わったときだけ Info イベントとして記録する
+void RuntimeHealthMonitor::updateLearnerThrottle() noexcept
+{
+    if (m_callbackLoadRef_ == nullptr) return;
+    // relaxed: Audio Thread が単独で更新するスカラー観測値
+    const uint16_t load = convo::consumeAtomic(*m_callbackLoadRef_, std::memory_order_relaxed);
+    if (!m_learnerThrottle_.update(load) || !m_callback) return;
+
+    HealthEvent ev{getCurrentTimeUs(), HealthEvent::Severity::Info, EVENT_LEARNER_THROTTLE_LEVEL,
+                   static_cast<uint64_t>(m_learnerThrottle_.getLevel()), load};
+    m_callback(ev);
+}
+
 // [work39 Phase 3] TrendSnapshot 取得
 TrendSnapshot RuntimeHealthMonitor::takeSnapshot() const noexcept
 {
@@ -1183,6 +1198,7 @@ void RuntimeHealthMonitor::reset() noexcept
     // [work37 Phase 4.1] PolicyEngine もリセット
     m_policyEngine_.reset();
     m_backpressureInjected_ = false;
+    m_learnerThrottle_.reset();   // 新しいデバイス設定の budget で測り直す
     convo::publishAtomic(m_maxFallbackSize_, uint64_t{0}, std::memory_order_release);
     convo::publishAtomic(m_maxOverflowRate_, 0.0, std::memory_order_release);
     // [work37] 新規監視状態のリセット
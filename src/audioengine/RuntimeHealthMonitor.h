@@ -5,6 +5,8 @@
 #include <functional>
 #include "AtomicAccess.h"
 #include "RuntimePolicyEngine.h"  // ★ work37 Phase 4: PolicyEngine 連携
+#include "XrunIncidentCorrelator.h"
+#include "LearnerThrottleGovernor.h"
 
 class AudioSegmentBuffer;  // ★ Work39: Learner FIFO 監視用（global scope）
 
@@ -53,6 +55,7 @@ static constexpr uint32_t EVENT_CROSSFADE_ABORTED_EMERGENCY = 4003;  // ★ Phas
 // ★ Work39: Learner FIFO Backpressure
 static constexpr uint32_t EVENT_LEARNER_BACKPRESSURE_WARNING = 5001;  // FIFO 85%+
 static constexpr uint32_t EVENT_LEARNER_BACKPRESSURE_ERROR   = 5002;  // FIFO 95%+
+static constexpr uint32_t EVENT_LEARNER_THROTTLE_LEVEL       = 5003;  // 学習絞り込み段階の変化 (value=段階, slot=負荷 permille)
 // ★ Work38: Retire Age 正常復帰イベント（emitOnTransition 3状態遷移完全カバー）
 static constexpr uint32_t EVENT_RETIRE_AGE_NORMAL     = 1009;  // ★ Work38
 static constexpr uint32_t EVENT_RETIRE_AGE_WARNING   = 1010;  // ★ Practical-5
@@ -166,6 +169,11 @@ public:
     void setEpochAdvanceCountRef(const std::atomic<uint64_t>* ref) noexcept { m_epochAdvanceCountRef_ = ref; }
     void setLastCompletedEpochRef(const std::atomic<uint64_t>* ref) noexcept { m_lastCompletedEpochRef_ = ref; }
 
+    // ★ 学習スロットリング: callback 負荷 (permille) の参照。tick() ごとに LearnerThrottleGovernor へ渡す
+    void setCallbackLoadRef(const std::atomic<uint16_t>* ref) noexcept { m_callbackLoadRef_ = ref; }
+    [[nodiscard]] LearnerThrottle getLearnerThrottle() const noexcept { return m_learnerThrottle_.current(); }
+    [[nodiscard]] const LearnerThrottleGovernor& getLearnerThrottleGovernor() const noexcept { return m_learnerThrottle_; }
+
     // [work37 Phase 9.2] Configuration Divergence 監視用参照設定
     void setCommittedGenRef(const std::atomic<uint64_t>* ref) noexcept { m_lastCommittedGenRef_ = ref; }
     void setRequestedGenRef(const std::atomic<uint64_t>* ref) noexcept { m_requestedGenRef_ = ref; }
@@ -249,6 +257,13 @@ public:
         return &m_healthState_;
     }
 
+    // ★ xrun 原因相関: Audio Thread が超過コールバックを積み、tick() が履歴へ移す。
+    //   publish / reclaim 側は publicationActivity() / retireActivity() を Scope で囲む
+    [[nodiscard]] XrunIncidentCorrelator& getXrunCorrelator() noexcept { return m_xrunCorrelator_; }
+    [[nodiscard]] XrunIncidentCorrelator::Report getXrunIncidentReport() const noexcept {
+        return m_xrunCorrelator_.report();
+    }
+
 private:
     void checkRetireStall() noexcept;
     void checkPublicationStall() noexcept;
@@ -276,6 +291,7 @@ private:
                                                 const TrendSnapshot& now) const noexcept;
     // [work39 Phase 5] Learner FIFO 監視
     void checkLearnerBackpressure() noexcept;
+    void updateLearnerThrottle() noexcept;
     // ★ P1-C/Practical-2/4/5/6: 追加監視
     void checkCrossfadeTimeout() noexcept;
     void checkCrossfadeEventDrop() noexcept;
@@ -350,6 +366,10 @@ private:
     const std::atomic<uint64_t>* m_epochAdvanceCountRef_{nullptr};
     const std::atomic<uint64_t>* m_lastCompletedEpochRef_{nullptr};
 
+    // 学習スロットリング (締切余裕 → 評価ワーカー数 / 世代間休止)
+    LearnerThrottleGovernor m_learnerThrottle_;
+    const std::atomic<uint16_t>* m_callbackLoadRef_{nullptr};
+
     // [work39 Phase 7] Critical 出口 安定60秒継続追跡
     uint64_t m_criticalExitStableStartUs_{0};
 
@@ -432,6 +452,9 @@ private:
 
     // [work37 Phase 8.2] EmergencyDrain 実行時制御
     std::atomic<bool> m_emergencyDrainRequested_{false};
+
+    // ★ xrun 原因相関（直近 XrunIncidentCorrelator::kHistory 件）
+    XrunIncidentCorrelator m_xrunCorrelator_;
 };
 
 } // namespace convo
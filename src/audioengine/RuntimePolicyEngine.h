@@ -301,6 +301,105 @@ struct RuntimeRecoveryScore {
     [[nodiscard]] bool isHealthy() const noexcept { return total() >= kHealthyThreshold; }
 };
 
+// ★ CrossfadeLoadMode — callback 負荷に応じた DSP 遷移方式
+//   DSP→DSP クロスフェード中は旧 DSP と新 DSP を同じ callback 内で両方処理するため、
+//   フェード期間の DSP 負荷はおよそ 2 倍になる。
+enum class CrossfadeLoadMode : uint8_t {
+    Full,         // 要求どおりのフェード長
+    Shortened,    // 負荷に応じて短縮（2 倍負荷を払う callback 数を減らす）
+    FadeInOnly,   // 二重処理なし: 旧 DSP は即時 retire、新 DSP の fade-in (FADE_IN_SAMPLES) のみ
+    _Count
+};
+
+struct CrossfadeLoadDecision {
+    CrossfadeLoadMode mode{CrossfadeLoadMode::Full};
+    double fadeTimeSec{0.0};
+    uint16_t loadPermille{0};       // 判断に用いた callback 負荷（budget 比 permille）
+};
+
+// 450‰ 以下: 2 倍化しても budget の 90% に収まる → 要求どおり
+// 650‰ 以上: 2 倍化で 130% を超え、短縮しても xrun を避けられない → FadeInOnly
+// その間: 要求値から kMinAdaptiveCrossfadeSec まで線形に短縮
+inline constexpr uint16_t kCrossfadeLoadShortenPermille = 450;
+inline constexpr uint16_t kCrossfadeLoadFadeInOnlyPermille = 650;
+inline constexpr double kMinAdaptiveCrossfadeSec = 0.005;
+
+// ★ selectCrossfadeForLoad() — CrossfadeAuthority が決めたフェード長を負荷で調整
+//   CrossfadeAuthority は「要否と長さ」を World 投影値だけで決める。負荷は World に含まれない
+//   実行時観測値のため、Orchestrator が Authority 判定の後にこの方針を適用する。
+[[nodiscard]] constexpr CrossfadeLoadDecision selectCrossfadeForLoad(double requestedFadeSec,
+                                                                    uint16_t loadPermille) noexcept
+{
+    CrossfadeLoadDecision decision;
+    decision.loadPermille = loadPermille;
+    decision.fadeTimeSec = requestedFadeSec;
+
+    if (loadPermille >= kCrossfadeLoadFadeInOnlyPermille) {
+        decision.mode = CrossfadeLoadMode::FadeInOnly;
+        decision.fadeTimeSec = 0.0;
+        return decision;
+    }
+    if (loadPermille <= kCrossfadeLoadShortenPermille || requestedFadeSec <= kMinAdaptiveCrossfadeSec)
+        return decision;
+
+    const double t = static_cast<double>(loadPermille - kCrossfadeLoadShortenPermille)
+        / static_cast<double>(kCrossfadeLoadFadeInOnlyPermille - kCrossfadeLoadShortenPermille);
+    decision.mode = CrossfadeLoadMode::Shortened;
+    decision.fadeTimeSec = requestedFadeSec + (kMinAdaptiveCrossfadeSec - requestedFadeSec) * t;
+    return decision;
+}
+
+[[nodiscard]] constexpr const char* crossfadeLoadModeName(CrossfadeLoadMode mode) noexcept {
+    switch (mode) {
+        case CrossfadeLoadMode::Full:       return "Full";
+        case CrossfadeLoadMode::Shortened:  return "Shortened";
+        case CrossfadeLoadMode::FadeInOnly: return "FadeInOnly";
+        default:                            return "Unknown";
+    }
+}
+
+// ★ CrossfadeScope — DSP 遷移で新旧を並走させる範囲
+//   IR だけが変わる遷移では EQ / OS / 出力段の設定は新旧で同じなので、
+//   Convolver 段だけを並走させて上流 (入力段・EQ・アップサンプル) の出力を共有できる。
+enum class CrossfadeScope : uint8_t {
+    WholeDsp,         // 新旧 DSPCore の全段を処理し、出力でミックス
+    ConvolverStage,   // 新 DSPCore の Convolver 段で旧 Convolver を並走させ、段出力でミックス
+};
+
+// Convolver 段共有の前提条件（新旧 DSPCore の構築済み値から Orchestrator が組み立てる）
+struct ConvolverStageShareInputs {
+    bool sameProcessingLayout{false};   // サンプルレート・OS 倍率/方式・内部ブロック上限・EQ 配置が一致
+    int oldConvolverLatencySamples{0};  // 処理レート。アルゴリズム遅延 + パイプライン遅延
+    int newConvolverLatencySamples{0};
+    int fadeSamples{0};                 // ベースレートのフェード長
+    int warmupSamples{0};               // 新 DSPCore の fade-in 長（この間は WholeDsp で処理する）
+};
+
+// ★ selectCrossfadeScope() — Authority が ConvolverStage を要求しても、前提が崩れていれば WholeDsp に戻す
+//   段内には遅延整列バッファを持たないため、新旧 Convolver の遅延が一致するときだけ共有する
+//   (一致していれば同じ位置のサンプル同士を混ぜるだけで整列が厳密に保たれる)。
+//   新 DSPCore の EQ / OS / 出力段は構築直後は冷えているので、fade-in の間は全段を並走させ、
+//   その後に段スコープへ移る。フェードが fade-in の 2 倍に満たなければ移っても得がない。
+[[nodiscard]] constexpr CrossfadeScope selectCrossfadeScope(CrossfadeScope requested,
+                                                            const ConvolverStageShareInputs& in) noexcept
+{
+    if (requested != CrossfadeScope::ConvolverStage || !in.sameProcessingLayout)
+        return CrossfadeScope::WholeDsp;
+    if (in.oldConvolverLatencySamples != in.newConvolverLatencySamples)
+        return CrossfadeScope::WholeDsp;
+    if (in.fadeSamples < in.warmupSamples * 2)
+        return CrossfadeScope::WholeDsp;
+    return CrossfadeScope::ConvolverStage;
+}
+
+[[nodiscard]] constexpr const char* crossfadeScopeName(CrossfadeScope scope) noexcept {
+    switch (scope) {
+        case CrossfadeScope::WholeDsp:       return "WholeDsp";
+        case CrossfadeScope::ConvolverStage: return "ConvolverStage";
+        default:                             return "Unknown";
+    }
+}
+
 // [work37 Phase 0] RuntimePolicyEngine — MonitorState → 最優先RecoveryAction の選択器
 //   複数Actionを同時発行せず、最高優先度のActionのみ返す。
 //   Action優先順位（高い順）:
@@ -211,6 +211,49 @@ PublicationAdmission::Decision RuntimePublicationOrchestrator::trySubmit(
         }
     }
 
+    // 負荷適応: 直近の callback 負荷でフェード長・遷移方式を調整（Authority 判定後に適用）
+    if (cfDecision.needsCrossfade && oldDSP != nullptr)
+    {
+        const auto loadDecision = convo::selectCrossfadeForLoad(cfDecision.fadeTimeSec,
+                                                                engine_.getCallbackLoadPermille());
+        engine_.crossfadeRuntime_.recordLoadDecision(loadDecision);
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+        if (loadDecision.mode != convo::CrossfadeLoadMode::Full)
+        {
+            diagLog("[DIAG] trySubmit: load-adaptive crossfade mode="
+                + juce::String(convo::crossfadeLoadModeName(loadDecision.mode))
+                + " load=" + juce::String(static_cast<int>(loadDecision.loadPermille)) + "permille"
+                + " fade=" + juce::String(loadDecision.fadeTimeSec * 1000.0, 1) + "ms"
+                + " requested=" + juce::String(cfDecision.fadeTimeSec * 1000.0, 1) + "ms"
+                + " gen=" + juce::String(static_cast<juce::int64>(req.generation)));
+        }
+#endif
+        if (loadDecision.mode == convo::CrossfadeLoadMode::FadeInOnly)
+            cfDecision.needsCrossfade = false;   // 旧 DSP は DSPTransition で即時 retire、新 DSP は fade-in のみ
+        cfDecision.fadeTimeSec = loadDecision.fadeTimeSec;
+    }
+
+    // Convolver 段スコープ: Authority の要求を新旧 DSPCore の実構成で確定（遅延不一致などは WholeDsp へ戻す）
+    if (cfDecision.needsCrossfade && cfDecision.scope == convo::CrossfadeScope::ConvolverStage)
+    {
+        convo::ConvolverStageShareInputs shareInputs;
+        if (oldDSP != nullptr && newDSPResolved != nullptr)
+        {
+            shareInputs.sameProcessingLayout = newDSPResolved->hasSameConvolverStageLayout(*oldDSP);
+            shareInputs.oldConvolverLatencySamples = oldDSP->getConvolverStageLatencySamples();
+            shareInputs.newConvolverLatencySamples = newDSPResolved->getConvolverStageLatencySamples();
+            shareInputs.fadeSamples = static_cast<int>(cfDecision.fadeTimeSec * newDSPResolved->sampleRate);
+            shareInputs.warmupSamples = AudioEngine::DSPCore::FADE_IN_SAMPLES;
+        }
+        cfDecision.scope = convo::selectCrossfadeScope(cfDecision.scope, shareInputs);
+#if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
+        diagLog("[DIAG] trySubmit: crossfade scope=" + juce::String(convo::crossfadeScopeName(cfDecision.scope))
+            + " convLatencyOld=" + juce::String(shareInputs.oldConvolverLatencySamples)
+            + " convLatencyNew=" + juce::String(shareInputs.newConvolverLatencySamples)
+            + " gen=" + juce::String(static_cast<juce::int64>(req.generation)));
+#endif
+    }
+
     // Step 2c: Update Specification with crossfade decision (NOT the world! — Post-build Mutation 排除)
     if (cfDecision.needsCrossfade && oldDSP != nullptr)
     {
@@ -243,6 +286,10 @@ PublicationAdmission::Decision RuntimePublicationOrchestrator::trySubmit(
         static_cast<uint64_t>(req.generation), 0,
         PublishStage::Validated, nowUs);
 
+    // 負荷予測: 公開は止めず、予測を UI 向けに記録し budget 超えが見込まれるなら提案をログへ出す
+    if (newDSPResolved != nullptr)
+        engine_.evaluateCpuCostBeforePublish(*newDSPResolved, req.generation);
+
     // ★ Phase4: worldOwner → FrozenRuntimeWorld wrap → publish
     // ★ v8.3: Builder は const World を返すが、FrozenRuntimeWorld の releaseState() が
     //   非 const を要求するため const_cast を使用。seal 後は Coordinator 内で immutable。
@@ -5,44 +5,74 @@
 
 namespace iso::audio_engine {
 
+namespace {
+
+// ★ 増分検証: 各検査が読む RuntimeState フィールド
+constexpr convo::isr::RuntimeFieldMask kExecutionFields = RuntimeState::fieldBit("execution");
+constexpr convo::isr::RuntimeFieldMask kTopologyFields = RuntimeState::fieldBit("topology")
+    | RuntimeState::fieldBit("execution")
+    | RuntimeState::fieldBit("routing");
+constexpr convo::isr::RuntimeFieldMask kResourceFields = RuntimeState::fieldBit("resource");
+constexpr convo::isr::RuntimeFieldMask kTransitionFields = RuntimeState::fieldBit("execution")
+    | RuntimeState::fieldBit("overlap");
+
+static_assert(RuntimeState::fieldBit("execution") != 0
+                  && RuntimeState::fieldBit("topology") != 0
+                  && RuntimeState::fieldBit("routing") != 0
+                  && RuntimeState::fieldBit("resource") != 0
+                  && RuntimeState::fieldBit("overlap") != 0,
+              "validator field dependencies must name RuntimeState field descriptors");
+
+RuntimeValidationResult makeFailure(ValidationFailureReason reason, const char* message)
+{
+    RuntimeValidationResult result;
+    result.isValid = false;
+    result.errorMessage = message;
+    result.failureReason = reason;
+    return result;
+}
+
+} // namespace
+
 RuntimeValidationResult RuntimePublicationValidator::validatePublication(
     const RuntimePublishWorld& world) const
 {
-    RuntimeValidationResult result;
+    return validatePublication(world, convo::isr::kAllRuntimeFieldsDirty);
+}
+
+RuntimeValidationResult RuntimePublicationValidator::validatePublication(
+    const RuntimePublishWorld& world,
+    convo::isr::RuntimeFieldMask dirtyFields) const
+{
+    const auto isDirty = [dirtyFields](convo::isr::RuntimeFieldMask fields) noexcept {
+        return (dirtyFields & fields) != 0;
+    };
 
     // 1. Semantic consistency check
-    if (!validateSemanticConsistency(world)) {
-        result.isValid = false;
-        result.errorMessage = "Semantic consistency check failed";
-        result.failureReason = ValidationFailureReason::SemanticInconsistency;
-        return result;
+    //    sequence / generation は publication ごとに打ち直すため常に検査する
+    if (!checkActivationEpochConsistency(world.generationSemantic, world.timing)
+        || !checkPublicationIdentity(world)
+        || (isDirty(kExecutionFields) && !checkExecutionSemanticValidity(world.execution))) {
+        return makeFailure(ValidationFailureReason::SemanticInconsistency, "Semantic consistency check failed");
     }
 
     // 2. Topology validation
-    if (!validateTopology(world)) {
-        result.isValid = false;
-        result.errorMessage = "Topology validation failed";
-        result.failureReason = ValidationFailureReason::InvalidTopology;
-        return result;
+    if (!checkGenerationIdentity(world)
+        || (isDirty(kTopologyFields) && !checkTopologyInvariants(world))) {
+        return makeFailure(ValidationFailureReason::InvalidTopology, "Topology validation failed");
     }
 
     // 3. Resource availability check
-    if (!validateResources(world)) {
-        result.isValid = false;
-        result.errorMessage = "Resource availability check failed";
-        result.failureReason = ValidationFailureReason::InvalidResources;
-        return result;
+    if (isDirty(kResourceFields) && !validateResources(world)) {
+        return makeFailure(ValidationFailureReason::InvalidResources, "Resource availability check failed");
     }
 
     // 4. Check for conflicting transitions
-    if (!checkNoConflictingTransitions(world)) {
-        result.isValid = false;
-        result.errorMessage = "Conflicting transitions detected";
-        result.failureReason = ValidationFailureReason::InvalidTransition;
-        return result;
+    if (isDirty(kTransitionFields) && !checkNoConflictingTransitions(world)) {
+        return makeFailure(ValidationFailureReason::InvalidTransition, "Conflicting transitions detected");
     }
 
-    return result;
+    return RuntimeValidationResult{};
 }
 
 bool RuntimePublicationValidator::validateSemanticConsistency(
@@ -62,6 +92,18 @@ bool RuntimePublicationValidator::validateSemanticConsistency(
         return false;
     }
 
+    return checkPublicationIdentity(world);
+}
+
+bool RuntimePublicationValidator::validateTopology(
+    const RuntimePublishWorld& world) const
+{
+    return checkTopologyInvariants(world) && checkGenerationIdentity(world);
+}
+
+bool RuntimePublicationValidator::checkPublicationIdentity(
+    const RuntimePublishWorld& world) const
+{
     // ★ P4-1: Publication sequence — generation > 0 なら sequenceId が 0 でないこと
     //   Bootstrap world (generation=0) でも sequenceId は通常 1 以上だが、
     //   generation を Bootstrap 判別の唯一の基準とする
@@ -71,7 +113,17 @@ bool RuntimePublicationValidator::validateSemanticConsistency(
     return true;
 }
 
-bool RuntimePublicationValidator::validateTopology(
+bool RuntimePublicationValidator::checkGenerationIdentity(
+    const RuntimePublishWorld& world) const
+{
+    // ★ P4-1: GenerationSemantic — generation > 0 なら runtimeGeneration > 0
+    if (world.generation > 0 && world.generationSemantic.runtimeGeneration == 0)
+        return false;
+
+    return true;
+}
+
+bool RuntimePublicationValidator::checkTopologyInvariants(
     const RuntimePublishWorld& world) const
 {
     const auto& topology = world.topology;
@@ -103,10 +155,6 @@ bool RuntimePublicationValidator::validateTopology(
     if (topology.fadingRuntimeUuid != 0 && topology.fadingRuntimeUuid == topology.runtimeUuid)
         return false;
 
-    // ★ P4-1: GenerationSemantic — generation > 0 なら runtimeGeneration > 0
-    if (world.generation > 0 && world.generationSemantic.runtimeGeneration == 0)
-        return false;
-
     return true;
 }
 
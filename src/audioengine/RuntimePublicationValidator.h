@@ -64,6 +64,21 @@ public:
     RuntimeValidationResult validatePublication(
         const RuntimePublishWorld& world) const;
 
+    /**
+     * Validate only the checks whose fields intersect dirtyFields.
+     *
+     * ★ 増分検証: publication ごとに打ち直す識別フィールド (generation / sequence) の検査は
+     *   常に実行し、それ以外は依存フィールドが dirty な検査だけを実行する。
+     *   convo::isr::kAllRuntimeFieldsDirty を渡すと validatePublication(world) の全検証と同じ。
+     *
+     * @param world The RuntimePublishWorld to validate
+     * @param dirtyFields Fields changed since the last published world (RuntimeState::fieldBit)
+     * @return RuntimeValidationResult with success/failure and error message
+     */
+    RuntimeValidationResult validatePublication(
+        const RuntimePublishWorld& world,
+        convo::isr::RuntimeFieldMask dirtyFields) const;
+
     /**
      * Validate semantic consistency.
      *
@@ -91,6 +106,12 @@ public:
 
 private:
     // Helper methods
+    bool checkPublicationIdentity(const RuntimePublishWorld& world) const;
+
+    bool checkGenerationIdentity(const RuntimePublishWorld& world) const;
+
+    bool checkTopologyInvariants(const RuntimePublishWorld& world) const;
+
     bool checkExecutionSemanticValidity(
         const convo::isr::ExecutionSemantic& exec) const;
 
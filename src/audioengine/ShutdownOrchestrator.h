@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+//==============================================================================
+// ShutdownOrchestrator — 終了時のバックグラウンド停止を「全部に知らせてから待つ」順に並べる
+//
+//   各スレッドの stop は「終了を知らせる → join する」を 1 本ずつ直列に行うため、
+//   rebuild / EQ プリビルド / Convolver のアップグレード・プリフェッチ・索引 / 学習器 /
+//   スケジューラの終了待ちが足し算になっていた。ここではステージごとに
+//     signal : 終了・キャンセルを要求するだけ (ブロックしない、何度呼んでもよい)
+//     join   : 止まるのを待つ (signal 済みの前提で呼ばれる)
+//   を登録し、signalAll() で全ステージに一斉に知らせてから joinAll() で登録順に待つ。
+//   各スレッドは signal の時点から並行に後片付けを進めるので、待ち時間の合計は
+//   最も遅いステージ 1 本分に近くなる。
+//
+//   期限:
+//     - 構築時の budget で全 join 共通の期限 (deadline) を決める。期限を過ぎても join は
+//       打ち切らない (止まっていないスレッドの資源を解放できないため)。超過したステージを
+//       StageReport に残し、呼び出し側が診断ログへ出す。
+//     - juce::Thread::stopThread のようにタイムアウトを取る join には remainingMs() で
+//       残り時間を渡す (floorMs 未満には詰めない)。
+//
+//   スレッド: 構築から joinAll まで終了処理を行う 1 スレッド (Message Thread) だけが触る。
+//   JUCE 非依存 (tests/ShutdownOrchestratorTests.cpp から単体で検証する)。
+//==============================================================================
+
+namespace convo {
+
+class ShutdownOrchestrator
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using SignalFn = std::function<void()>;
+    using JoinFn = std::function<void(const ShutdownOrchestrator&)>;
+
+    struct StageReport
+    {
+        std::string name;
+        double waitedMs = 0.0;      // join に掛かった時間
+        bool overran = false;       // join 完了時に共通期限を過ぎていた
+    };
+
+    explicit ShutdownOrchestrator(std::chrono::milliseconds budget) noexcept
+        : budget_(budget)
+    {
+    }
+
+    ShutdownOrchestrator(const ShutdownOrchestrator&) = delete;
+    ShutdownOrchestrator& operator=(const ShutdownOrchestrator&) = delete;
+
+    // signal / join のどちらかは空でよい (signal だけのステージは後で別の経路が join する)
+    void addStage(std::string name, SignalFn signal, JoinFn join)
+    {
+        stages_.push_back(Stage{ std::move(name), std::move(signal), std::move(join) });
+    }
+
+    // 全ステージへ登録順に終了を知らせる。2 回目以降は何もしない。期限はここから数える
+    void signalAll()
+    {
+        if (signalled_)
+            return;
+        signalled_ = true;
+        deadline_ = Clock::now() + budget_;
+        for (auto& stage : stages_)
+            if (stage.signal)
+                stage.signal();
+    }
+
+    // 未 signal なら先に signalAll してから、登録順に join する。戻り値は全ステージが期限内に終わったか
+    bool joinAll()
+    {
+        signalAll();
+        bool withinBudget = true;
+        for (auto& stage : stages_)
+        {
+            if (!stage.join)
+                continue;
+            const auto start = Clock::now();
+            stage.join(*this);
+            const auto end = Clock::now();
+            StageReport report;
+            report.name = stage.name;
+            report.waitedMs = std::chrono::duration<double, std::milli>(end - start).count();
+            report.overran = end > deadline_;
+            withinBudget = withinBudget && !report.overran;
+            reports_.push_back(std::move(report));
+        }
+        return withinBudget;
+    }
+
+    // 共通期限までの残り (ms)。floorMs 未満にはしない (期限切れでも最低限は待つ)
+    [[nodiscard]] int remainingMs(int floorMs = 0) const noexcept
+    {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - Clock::now()).count();
+        return static_cast<int>(std::max<long long>(static_cast<long long>(floorMs), static_cast<long long>(left)));
+    }
+
+    [[nodiscard]] bool isSignalled() const noexcept { return signalled_; }
+    [[nodiscard]] Clock::time_point deadline() const noexcept { return deadline_; }
+    [[nodiscard]] const std::vector<StageReport>& reports() const noexcept { return reports_; }
+
+private:
+    struct Stage
+    {
+        std::string name;
+        SignalFn signal;
+        JoinFn join;
+    };
+
+    std::chrono::milliseconds budget_;
+    Clock::time_point deadline_ {};
+    bool signalled_ = false;
+    std::vector<Stage> stages_;
+    std::vector<StageReport> reports_;
+};
+
+} // namespace convo
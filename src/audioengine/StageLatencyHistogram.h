@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "AtomicAccess.h"
+#include "DspStage.h"
+#include "RtSafetyGuard.h"
+
+//==============================================================================
+// StageLatencyHistogram — DSP 段ごとの処理時間ヒストグラム (リリースビルドでも常時有効)
+//
+//   Audio Thread は段の境目で TSC を読み、段ごとのサイクル数を固定バケットの対数ヒストグラムへ数える。
+//   バケットは 2 の累乗ごとに 4 分割 (相対誤差 25% 以下)。書き込みは Audio Thread だけが行い
+//   (単一ライタ: カウンタは RMW なしの load + store)、段ごとのカウンタは別キャッシュラインに置く。
+//   集計 (差分・パーセンタイル・TSC → μs 換算) は Message Thread の StageLatencyWindow が行う。
+//
+//   CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS の DiagEvent (CallbackStage / EqTime / ConvTime) は
+//   1 イベントずつの詳細記録で、こちらは分布だけを持つ常時計測。
+//==============================================================================
+
+namespace convo {
+
+[[nodiscard]] inline uint64_t readStageClock() noexcept
+{
+    return __rdtsc();
+}
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4324) // alignas(64) による意図的なパディング
+#endif
+
+class StageLatencyHistograms
+{
+public:
+    static constexpr int kSubBucketBits = 2;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxOctave = 40;                       // 2^40 サイクル (数分) 以上は最後のバケット
+    static constexpr int kNumBuckets = (kMaxOctave - 1) * kSubBuckets + 1;
+
+    // [0, 4) はそのまま、以降は (オクターブ, 上位 2 ビット) で 4 分割
+    [[nodiscard]] static constexpr int bucketFor(uint64_t cycles) noexcept
+    {
+        if (cycles < static_cast<uint64_t>(kSubBuckets))
+            return static_cast<int>(cycles);
+        const int octave = static_cast<int>(std::bit_width(cycles)) - 1;
+        if (octave >= kMaxOctave)
+            return kNumBuckets - 1;
+        const int sub = static_cast<int>((cycles >> (octave - kSubBucketBits)) & (kSubBuckets - 1));
+        return (octave - 1) * kSubBuckets + sub;
+    }
+
+    // バケットに入る値の上限 (この値を含まない)
+    [[nodiscard]] static constexpr uint64_t bucketUpperBound(int bucket) noexcept
+    {
+        if (bucket < kSubBuckets)
+            return static_cast<uint64_t>(bucket) + 1;
+        if (bucket >= kNumBuckets - 1)
+            return UINT64_MAX;
+        const int octave = bucket / kSubBuckets + 1;
+        const uint64_t sub = static_cast<uint64_t>(bucket % kSubBuckets);
+        return (static_cast<uint64_t>(kSubBuckets) + sub + 1) << (octave - kSubBucketBits);
+    }
+
+    // Audio Thread 専用 (単一ライタ)
+    void record(DspStage stage, uint64_t cycles) noexcept
+    {
+        auto& counters = stages_[static_cast<size_t>(stage)];
+        callbackCycles_[static_cast<size_t>(stage)] += cycles;
+        auto& slot = counters.counts[static_cast<size_t>(bucketFor(cycles))];
+        // relaxed: 書き込みはこのスレッドだけ。読み手は単調増加するカウンタの近似値を見ればよい
+        convo::publishAtomic(slot, convo::consumeAtomic(slot, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        uint64_t currentMax = convo::consumeAtomic(counters.windowMax, std::memory_order_relaxed); // relaxed: 下の CAS で確定する
+        // relaxed: 最大値の単独更新。読み手の exchange と競合したときだけ再試行する
+        while (cycles > currentMax
+               && !convo::compareExchangeAtomic(counters.windowMax, currentMax, cycles,
+                                                std::memory_order_relaxed, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // Audio Thread 専用: 前回の take 以降 (= 現在のコールバック) に record した段別サイクル。
+    // XrunIncidentCorrelator が超過したコールバックの内訳に使う
+    [[nodiscard]] std::array<uint64_t, kNumDspStages> takeCallbackCycles() noexcept
+    {
+        const auto cycles = callbackCycles_;
+        callbackCycles_ = {};
+        return cycles;
+    }
+
+    // Message Thread: 累積カウントを読み、前回の collect 以降の最大値を取り出す
+    template <typename Snapshot>
+    void collect(Snapshot& out) noexcept
+    {
+        for (size_t s = 0; s < kNumDspStages; ++s)
+        {
+            auto& counters = stages_[s];
+            for (size_t b = 0; b < static_cast<size_t>(kNumBuckets); ++b)
+                out.counts[s][b] = convo::consumeAtomic(counters.counts[b], std::memory_order_relaxed); // relaxed: 統計値のみ
+            out.maxCycles[s] = convo::exchangeAtomic(counters.windowMax, static_cast<uint64_t>(0),
+                                                     std::memory_order_relaxed); // relaxed: 統計値のみ
+        }
+    }
+
+private:
+    struct alignas(64) StageCounters
+    {
+        std::array<std::atomic<uint64_t>, kNumBuckets> counts {};
+        std::atomic<uint64_t> windowMax { 0 };
+    };
+
+    std::array<StageCounters, kNumDspStages> stages_ {};
+    std::array<uint64_t, kNumDspStages> callbackCycles_ {};
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+// DSPCore::process 内で段の境目ごとに lap() し、最後に flush() で 1 コールバック分を記録する。
+// 同じ段が複数回に分かれても (Output は processDown の前後など) 合算して 1 サンプルにする
+// 段の lap ごとに呼ばれる外部通知 (ETW など)。nullptr なら呼ばない
+using StageLapSink = void (*)(DspStage stage, uint64_t cycles) noexcept;
+
+class StageLatencyProbe
+{
+public:
+    explicit StageLatencyProbe(StageLatencyHistograms* histograms, StageLapSink sink = nullptr) noexcept
+        : histograms_(histograms)
+        , sink_(histograms != nullptr ? sink : nullptr)
+        , last_(histograms != nullptr ? readStageClock() : 0)
+    {
+    }
+
+    StageLatencyProbe(const StageLatencyProbe&) = delete;
+    StageLatencyProbe& operator=(const StageLatencyProbe&) = delete;
+
+    ~StageLatencyProbe()
+    {
+        flush();
+    }
+
+    // 前回の lap から今までを stage に加算する
+    void lap(DspStage stage) noexcept
+    {
+        // 計測の有無 (フェード側の DSPCore は nullptr) に関わらず、この段で起きた RT 違反に段を付ける
+        RtSafetyGuard::onStageLap(stage);
+        if (histograms_ == nullptr)
+            return;
+        const uint64_t now = readStageClock();
+        const auto index = static_cast<size_t>(stage);
+        cycles_[index] += now - last_;
+        touched_ |= static_cast<uint32_t>(1u << index);
+        if (sink_ != nullptr)
+            sink_(stage, now - last_);
+        last_ = now;
+    }
+
+    void flush() noexcept
+    {
+        if (histograms_ == nullptr)
+            return;
+        for (size_t s = 0; s < kNumDspStages; ++s)
+            if ((touched_ & (1u << s)) != 0)
+                histograms_->record(static_cast<DspStage>(s), cycles_[s]);
+        histograms_ = nullptr;
+    }
+
+private:
+    StageLatencyHistograms* histograms_ = nullptr;
+    StageLapSink sink_ = nullptr;
+    uint64_t last_ = 0;
+    uint32_t touched_ = 0;
+    std::array<uint64_t, kNumDspStages> cycles_ {};
+};
+
+struct StageLatencySummary
+{
+    uint64_t samples = 0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double p999Us = 0.0;
+    double maxUs = 0.0;
+};
+
+struct StageLatencyReport
+{
+    bool clockCalibrated = false;   // false の間は μs 値が 0 (TSC 周波数の推定待ち)
+    double windowSeconds = 0.0;
+    double cyclesPerUs = 0.0;       // 推定 TSC 周波数 (clockCalibrated の間のみ > 0)
+    std::array<StageLatencySummary, kNumDspStages> stages {};
+};
+
+// Message Thread 側の集計。直近 kWindowUs〜2×kWindowUs の分布を返す (kWindowUs ごとに古い半分を捨てる)。
+// TSC 周波数は最初の update からの TSC 増分と壁時計の比で推定する
+class StageLatencyWindow
+{
+public:
+    static constexpr uint64_t kWindowUs = 5'000'000;
+    static constexpr uint64_t kMinCalibrationUs = 200'000;
+
+    struct Snapshot
+    {
+        std::array<std::array<uint64_t, StageLatencyHistograms::kNumBuckets>, kNumDspStages> counts {};
+        std::array<uint64_t, kNumDspStages> maxCycles {};
+    };
+
+    StageLatencyReport update(StageLatencyHistograms& histograms, uint64_t nowUs, uint64_t nowTsc) noexcept
+    {
+        histograms.collect(latest_);
+
+        if (!started_)
+        {
+            started_ = true;
+            calibrationUs_ = nowUs;
+            calibrationTsc_ = nowTsc;
+            rolloverUs_ = nowUs;
+            baseline_ = latest_;
+            baseline_.maxCycles = {};
+            half_ = latest_;
+            currentHalfMax_ = {};
+            previousHalfMax_ = {};
+            baselineUs_ = nowUs;
+        }
+
+        for (size_t s = 0; s < kNumDspStages; ++s)
+            currentHalfMax_[s] = std::max(currentHalfMax_[s], latest_.maxCycles[s]);
+
+        if (nowUs - rolloverUs_ >= kWindowUs)
+        {
+            baseline_ = half_;
+            baselineUs_ = rolloverUs_;
+            half_ = latest_;
+            rolloverUs_ = nowUs;
+            previousHalfMax_ = currentHalfMax_;
+            currentHalfMax_ = {};
+        }
+
+        StageLatencyReport report;
+        const uint64_t calibrationSpanUs = nowUs - calibrationUs_;
+        double cyclesPerUs = 0.0;
+        if (calibrationSpanUs >= kMinCalibrationUs && nowTsc > calibrationTsc_)
+        {
+            cyclesPerUs = static_cast<double>(nowTsc - calibrationTsc_) / static_cast<double>(calibrationSpanUs);
+            report.clockCalibrated = true;
+            report.cyclesPerUs = cyclesPerUs;
+        }
+        report.windowSeconds = static_cast<double>(nowUs - baselineUs_) * 1.0e-6;
+
+        for (size_t s = 0; s < kNumDspStages; ++s)
+        {
+            std::array<uint64_t, StageLatencyHistograms::kNumBuckets> window {};
+            for (size_t b = 0; b < window.size(); ++b)
+                window[b] = latest_.counts[s][b] - baseline_.counts[s][b];
+            const uint64_t maxCycles = std::max(previousHalfMax_[s], currentHalfMax_[s]);
+            report.stages[s] = summarize(window, maxCycles, cyclesPerUs);
+        }
+        return report;
+    }
+
+    // パーセンタイルはバケット上限 (最大値でクランプ) を返す。cyclesPerUs <= 0 なら件数のみ
+    [[nodiscard]] static StageLatencySummary summarize(
+        const std::array<uint64_t, StageLatencyHistograms::kNumBuckets>& counts,
+        uint64_t maxCycles, double cyclesPerUs) noexcept
+    {
+        StageLatencySummary summary;
+        for (uint64_t c : counts)
+            summary.samples += c;
+        if (summary.samples == 0 || cyclesPerUs <= 0.0)
+            return summary;
+
+        const auto percentileCycles = [&](uint64_t permyriad) noexcept
+        {
+            // rank = ceil(samples * q)
+            const uint64_t rank = std::max<uint64_t>(1, (summary.samples * permyriad + 9999) / 10000);
+            uint64_t seen = 0;
+            for (int b = 0; b < StageLatencyHistograms::kNumBuckets; ++b)
+            {
+                seen += counts[static_cast<size_t>(b)];
+                if (seen >= rank)
+                    return std::min(StageLatencyHistograms::bucketUpperBound(b), std::max<uint64_t>(maxCycles, 1));
+            }
+            return maxCycles;
+        };
+
+        const double usPerCycle = 1.0 / cyclesPerUs;
+        summary.p50Us = static_cast<double>(percentileCycles(5000)) * usPerCycle;
+        summary.p99Us = static_cast<double>(percentileCycles(9900)) * usPerCycle;
+        summary.p999Us = static_cast<double>(percentileCycles(9990)) * usPerCycle;
+        summary.maxUs = static_cast<double>(maxCycles) * usPerCycle;
+        return summary;
+    }
+
+private:
+    bool started_ = false;
+    uint64_t calibrationUs_ = 0;
+    uint64_t calibrationTsc_ = 0;
+    uint64_t rolloverUs_ = 0;
+    uint64_t baselineUs_ = 0;
+    Snapshot latest_ {};
+    Snapshot baseline_ {};
+    Snapshot half_ {};
+    std::array<uint64_t, kNumDspStages> currentHalfMax_ {};
+    std::array<uint64_t, kNumDspStages> previousHalfMax_ {};
+};
+
+} // namespace convo
@@ -1,5 +1,6 @@
 #include "TelemetryRecorder.h"
 #include "RuntimePublicationState.h"
+#include "FlightRecorder.h"
 #include <chrono>
 
 namespace convo::isr {
@@ -10,6 +11,27 @@ namespace {
             std::chrono::duration_cast<std::chrono::microseconds>(
                 std::chrono::steady_clock::now().time_since_epoch()).count());
     }
+
+    void writeFlightSnapshot(convo::FlightRecorder* recorder, const FailureSnapshot& snap) noexcept {
+        if (recorder == nullptr)
+            return;
+        convo::FlightFailureSnapshotPayload payload{};
+        payload.correlationIdShort = snap.correlationIdShort;
+        payload.publicationSequenceId = snap.publicationSequenceId;
+        payload.generation = snap.generation;
+        payload.worldId = snap.worldId;
+        payload.threadId = snap.threadId;
+        payload.coordinatorState = snap.coordinatorState;
+        payload.shutdownPhase = snap.shutdownPhase;
+        payload.publicationClass = snap.publicationClass;
+        payload.activeReaderCount = snap.activeReaderCount;
+        payload.minReaderEpoch = snap.minReaderEpoch;
+        payload.currentEpoch = snap.currentEpoch;
+        payload.stage = static_cast<uint8_t>(snap.stage);
+        payload.reason = static_cast<uint8_t>(snap.reason);
+        recorder->writePod(convo::FlightChannel::Failure, convo::FlightRecordKind::FailureSnapshot,
+                           payload, snap.timestampUs != 0 ? snap.timestampUs : nowUs());
+    }
 }
 
 void TelemetryRecorder::recordProgress(
@@ -28,6 +50,16 @@ void TelemetryRecorder::recordProgress(
     };
 
     const auto pushResult = progressRecords_.tryPush(record);
+    if (flightRecorder_ != nullptr) {
+        const convo::FlightProgressPayload payload{
+            .correlationIdShort = record.correlationIdShort,
+            .generation = generation,
+            .worldId = worldId,
+            .stage = static_cast<uint8_t>(stage)
+        };
+        flightRecorder_->writePod(convo::FlightChannel::Progress, convo::FlightRecordKind::Progress,
+                                  payload, record.timestampUs);
+    }
     if (pushResult.overwritten) {
         // リングオーバーライト → ドロップ通知
         if (stateOwner_ != nullptr) {
@@ -53,6 +85,14 @@ void TelemetryRecorder::recordFailure(
         .timestampUs = ts
     };
     const auto pushResult = failureRecords_.tryPush(record);
+    if (flightRecorder_ != nullptr) {
+        convo::FlightFailurePayload payload{};
+        payload.correlationIdShort = correlationIdShort;
+        payload.stage = static_cast<uint8_t>(stage);
+        payload.reason = static_cast<uint8_t>(reason);
+        convo::copyFlightText(payload.origin, origin);   // origin はポインタなのでクラッシュ後に読めるよう文字列で残す
+        flightRecorder_->writePod(convo::FlightChannel::Failure, convo::FlightRecordKind::Failure, payload, ts);
+    }
 
     // ★ Snapshot 自動生成判定: FailureRecord リングバッファの現在件数を failureCount として渡す
     const uint64_t currentFailureCount = failureRecords_.size();
@@ -65,6 +105,7 @@ void TelemetryRecorder::recordFailure(
             .timestampUs = ts
         };
         failureSnapshots_.tryPush(snap);
+        writeFlightSnapshot(flightRecorder_, snap);
         snapshotController_.recordSnapshotTaken(ts);
     }
 }
@@ -78,6 +119,7 @@ bool TelemetryRecorder::recordFailureSnapshot(
         return false;
 
     failureSnapshots_.tryPush(snapshot);
+    writeFlightSnapshot(flightRecorder_, snapshot);
     snapshotController_.recordSnapshotTaken(nowUs);
     return true;
 }
@@ -92,6 +134,17 @@ void TelemetryRecorder::recordDeferredHealth(const DeferredHealth& health) noexc
 
 void TelemetryRecorder::recordRetireTimeline(const RetireTimelineRecord& record) noexcept {
     retireTimelines_.tryPush(record);
+    if (flightRecorder_ != nullptr) {
+        const convo::FlightRetireTimelinePayload payload{
+            .publicationSequenceId = record.publicationSequenceId,
+            .generation = record.generation,
+            .worldId = record.worldId,
+            .retireEpoch = record.retireEpoch,
+            .reclaimEpoch = record.reclaimEpoch
+        };
+        flightRecorder_->writePod(convo::FlightChannel::Retire, convo::FlightRecordKind::RetireTimeline,
+                                  payload, nowUs());
+    }
 }
 
 void TelemetryRecorder::recordRetireStall(const RetireStallSnapshot& stall) noexcept {
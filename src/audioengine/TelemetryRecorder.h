@@ -6,6 +6,8 @@
 #include "AtomicAccess.h"
 #include "RuntimePublicationState.h"
 
+namespace convo { class FlightRecorder; }
+
 namespace convo::isr {
 
 // ★ PublishStage: 出版進捗段階
@@ -287,6 +289,12 @@ public:
         stateOwner_ = owner;
     }
 
+    // ── クラッシュ後も残す写し: failure / snapshot / progress / retire timeline を FlightRecorder へも書く ──
+    //   記録スレッドが動く前に設定し、止めてから nullptr に戻す (AudioEngine の構築・破棄)
+    void setFlightRecorder(convo::FlightRecorder* recorder) noexcept {
+        flightRecorder_ = recorder;
+    }
+
 private:
     FixedRingBuffer<FailureRecord, 512> failureRecords_;
     FixedRingBuffer<FailureSnapshot, 64> failureSnapshots_;
@@ -298,6 +306,7 @@ private:
     std::atomic<uint64_t> localCounter_{1};  // 0は無効値
     FailureSnapshotController snapshotController_;
     RuntimePublicationStateOwner* stateOwner_{nullptr};
+    convo::FlightRecorder* flightRecorder_{nullptr};
 };
 
 } // namespace convo::isr
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "AtomicAccess.h"
+#include "FlightRecorder.h"
+#include "StageLatencyHistogram.h"
+#include "../LockFreeRingBuffer.h"
+
+//==============================================================================
+// XrunIncidentCorrelator — デッドライン超過 (xrun) の原因相関 (リリースビルドでも常時有効)
+//
+//   Audio Thread はコールバックの終わりで所要時間と到着間隔を期待周期と比べ、超過したときだけ
+//   その 1 コールバック分の状況 (段別サイクル・クロスフェード・同時に走った publish / reclaim・
+//   CPU 移動・学習中か・rebuild 待ちがあるか) を XrunIncident にまとめて SPSC リングへ積む。
+//   Message Thread (RuntimeHealthMonitor::tick) がそれを直近 kHistory 件の履歴へ移し、
+//   UI / CLI は report() で履歴とフラグ別の件数を読む。
+//
+//   CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS の XRunEvent は診断ビルド専用の生イベントで、
+//   こちらは「その時に何が重なっていたか」だけを持つ軽量な記録。
+//   FlightRecorder が設定されていれば、同じ incident をその場でファイルへも書く
+//   (Message Thread が drain する前にプロセスが落ちても残る)。
+//==============================================================================
+
+namespace convo {
+
+struct XrunIncident
+{
+    // flags のビット
+    static constexpr uint32_t kOverran        = 1u << 0;   // 処理時間が期待周期を超えた
+    static constexpr uint32_t kLateArrival    = 1u << 1;   // 前回からの到着間隔が閾値を超えた
+    static constexpr uint32_t kCrossfade      = 1u << 2;
+    static constexpr uint32_t kPublication    = 1u << 3;   // コールバック中に publish の commit が重なった
+    static constexpr uint32_t kRetire         = 1u << 4;   // コールバック中に reclaim バッチが重なった
+    static constexpr uint32_t kCpuMigrated    = 1u << 5;
+    static constexpr uint32_t kLearnerRunning = 1u << 6;
+    static constexpr uint32_t kRebuildActive  = 1u << 7;
+    static constexpr size_t kNumFlags = 8;
+
+    uint64_t callbackIndex = 0;
+    uint64_t startUs = 0;
+    uint32_t callbackUs = 0;
+    uint32_t intervalUs = 0;          // 0 = 前回のコールバックが無い
+    uint32_t expectedUs = 0;
+    uint32_t cpu = UINT32_MAX;
+    uint32_t prevCpu = UINT32_MAX;    // 前回のコールバック終了時の CPU
+    uint32_t flags = 0;
+    std::array<uint64_t, kNumDspStages> stageCycles {};   // 0 = その段を通らなかった
+
+    [[nodiscard]] bool has(uint32_t flag) const noexcept { return (flags & flag) != 0; }
+
+    // 最もサイクルを使った段。DSP を通らなかった (early return など) ときは DspStage::Count
+    [[nodiscard]] DspStage dominantStage() const noexcept
+    {
+        const auto it = std::max_element(stageCycles.begin(), stageCycles.end());
+        if (*it == 0)
+            return DspStage::Count;
+        return static_cast<DspStage>(it - stageCycles.begin());
+    }
+};
+
+[[nodiscard]] constexpr const char* xrunIncidentFlagName(size_t bit) noexcept
+{
+    switch (bit)
+    {
+        case 0: return "overran";
+        case 1: return "late";
+        case 2: return "crossfade";
+        case 3: return "publish";
+        case 4: return "retire";
+        case 5: return "cpuMigrated";
+        case 6: return "learner";
+        case 7: return "rebuild";
+        default: break;
+    }
+    return "?";
+}
+
+// 別スレッドの処理 (publish / reclaim) がコールバックと時間的に重なったかを判定するための区間カウンタ。
+// 開始時の mark() と終了時の比較で「途中で 1 回以上完了した」「開始時点または終了時点で実行中」を見る
+class ActivityWindow
+{
+public:
+    struct Mark
+    {
+        uint64_t completed = 0;
+        bool active = false;
+    };
+
+    class Scope
+    {
+    public:
+        explicit Scope(ActivityWindow& window) noexcept : window_(window) { window_.begin(); }
+        ~Scope() { window_.end(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ActivityWindow& window_;
+    };
+
+    // 以下のカウンタは相関の目安にしか使わず、これを介して公開するデータは無いので relaxed で足りる
+    void begin() noexcept
+    {
+        convo::fetchAddAtomic(active_, uint32_t{1}, std::memory_order_relaxed);
+    }
+
+    void end() noexcept
+    {
+        convo::fetchAddAtomic(completed_, uint64_t{1}, std::memory_order_relaxed);
+        convo::fetchSubAtomic(active_, uint32_t{1}, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Mark mark() const noexcept
+    {
+        return { convo::consumeAtomic(completed_, std::memory_order_relaxed),
+                 convo::consumeAtomic(active_, std::memory_order_relaxed) != 0 };
+    }
+
+    [[nodiscard]] bool overlapped(const Mark& atStart) const noexcept
+    {
+        const Mark now = mark();
+        return atStart.active || now.active || now.completed != atStart.completed;
+    }
+
+private:
+    std::atomic<uint32_t> active_ { 0 };
+    std::atomic<uint64_t> completed_ { 0 };
+};
+
+// コールバックの終わりに Audio Thread が集める、スレッドをまたがない状況
+struct XrunCallbackContext
+{
+    uint32_t cpu = UINT32_MAX;
+    bool crossfadeActive = false;
+    bool learnerRunning = false;
+    bool rebuildActive = false;
+};
+
+static_assert(sizeof(FlightXrunPayload::stageCycles) / sizeof(uint64_t) == kNumDspStages,
+              "FlightXrunPayload::stageCycles must hold every DspStage");
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4324) // LockFreeRingBuffer の alignas(64) による意図的なパディング
+#endif
+
+class XrunIncidentCorrelator
+{
+public:
+    static constexpr size_t kHistory = 32;
+    static constexpr size_t kPendingCapacity = 16;
+    // 到着間隔の閾値は診断ビルドの XRUN 判定と同じ (期待周期 × 1.5 と 3 ms の大きい方)
+    static constexpr uint64_t kLateRatioNum = 3;
+    static constexpr uint64_t kLateRatioDen = 2;
+    static constexpr uint64_t kLateMinimumUs = 3'000;
+
+    struct CallbackMark
+    {
+        uint64_t startUs = 0;
+        uint32_t cpu = UINT32_MAX;
+        ActivityWindow::Mark publication;
+        ActivityWindow::Mark retire;
+    };
+
+    struct Report
+    {
+        uint64_t totalIncidents = 0;
+        uint64_t droppedIncidents = 0;   // Message Thread が drain する前にリングが溢れた件数
+        size_t count = 0;
+        std::array<XrunIncident, kHistory> incidents {};            // 古い順
+        std::array<uint32_t, XrunIncident::kNumFlags> flagCounts {};
+        std::array<uint32_t, kNumDspStages> dominantStageCounts {};
+    };
+
+    // publish / reclaim 側が ActivityWindow::Scope で囲む (任意スレッド)
+    [[nodiscard]] ActivityWindow& publicationActivity() noexcept { return publication_; }
+    [[nodiscard]] ActivityWindow& retireActivity() noexcept { return retire_; }
+
+    // Audio Thread: コールバック先頭
+    [[nodiscard]] CallbackMark beginCallback(uint64_t startUs, uint32_t cpu) const noexcept
+    {
+        return { startUs, cpu, publication_.mark(), retire_.mark() };
+    }
+
+    // Audio Thread: コールバック末尾。超過していれば incident を積み true を返す
+    bool endCallback(const CallbackMark& mark, uint64_t callbackIndex, uint64_t endUs, uint64_t expectedUs,
+                     const XrunCallbackContext& context,
+                     const std::array<uint64_t, kNumDspStages>& stageCycles) noexcept
+    {
+        const uint64_t intervalUs = (lastStartUs_ != 0 && mark.startUs > lastStartUs_) ? mark.startUs - lastStartUs_ : 0;
+        const uint32_t prevCpu = lastCpu_;
+        lastStartUs_ = mark.startUs;
+        lastCpu_ = context.cpu;
+
+        if (expectedUs == 0)
+            return false;
+
+        const uint64_t callbackUs = endUs > mark.startUs ? endUs - mark.startUs : 0;
+        const uint64_t lateThresholdUs = std::max(expectedUs * kLateRatioNum / kLateRatioDen, kLateMinimumUs);
+        uint32_t flags = 0;
+        if (callbackUs > expectedUs)
+            flags |= XrunIncident::kOverran;
+        if (intervalUs > lateThresholdUs)
+            flags |= XrunIncident::kLateArrival;
+        if (flags == 0)
+            return false;
+
+        if (context.crossfadeActive)
+            flags |= XrunIncident::kCrossfade;
+        if (publication_.overlapped(mark.publication))
+            flags |= XrunIncident::kPublication;
+        if (retire_.overlapped(mark.retire))
+            flags |= XrunIncident::kRetire;
+        if (mark.cpu != context.cpu || (prevCpu != UINT32_MAX && prevCpu != mark.cpu))
+            flags |= XrunIncident::kCpuMigrated;
+        if (context.learnerRunning)
+            flags |= XrunIncident::kLearnerRunning;
+        if (context.rebuildActive)
+            flags |= XrunIncident::kRebuildActive;
+
+        const bool pushed = pending_.pushWithWriter([&](XrunIncident& incident) noexcept
+        {
+            incident.callbackIndex = callbackIndex;
+            incident.startUs = mark.startUs;
+            incident.callbackUs = static_cast<uint32_t>(std::min<uint64_t>(callbackUs, UINT32_MAX));
+            incident.intervalUs = static_cast<uint32_t>(std::min<uint64_t>(intervalUs, UINT32_MAX));
+            incident.expectedUs = static_cast<uint32_t>(std::min<uint64_t>(expectedUs, UINT32_MAX));
+            incident.cpu = context.cpu;
+            incident.prevCpu = prevCpu;
+            incident.flags = flags;
+            incident.stageCycles = stageCycles;
+        });
+        if (!pushed)
+            convo::fetchAddAtomic(droppedIncidents_, uint64_t{1}, std::memory_order_relaxed); // relaxed: 件数のみ
+
+        // acquire: setFlightRecorder の release と HB (マップ済みのレコーダーを観測)
+        if (FlightRecorder* recorder = convo::consumeAtomicPtr(flightRecorder_, std::memory_order_acquire))
+        {
+            FlightXrunPayload payload {};
+            payload.callbackIndex = callbackIndex;
+            payload.startUs = mark.startUs;
+            payload.callbackUs = static_cast<uint32_t>(std::min<uint64_t>(callbackUs, UINT32_MAX));
+            payload.intervalUs = static_cast<uint32_t>(std::min<uint64_t>(intervalUs, UINT32_MAX));
+            payload.expectedUs = static_cast<uint32_t>(std::min<uint64_t>(expectedUs, UINT32_MAX));
+            payload.cpu = context.cpu;
+            payload.prevCpu = prevCpu;
+            payload.flags = flags;
+            std::copy(stageCycles.begin(), stageCycles.end(), payload.stageCycles);
+            recorder->writePod(FlightChannel::Xrun, FlightRecordKind::XrunIncident, payload, endUs);
+        }
+        return true;
+    }
+
+    // Message Thread。Audio Thread が動いている間に付け替えてよいが、外したレコーダーの破棄は
+    // コールバックが止まってから (AudioEngine の破棄時)
+    void setFlightRecorder(FlightRecorder* recorder) noexcept
+    {
+        convo::publishAtomicPtr(flightRecorder_, recorder, std::memory_order_release); // release: レコーダーの構築結果を endCallback の acquire へ公開
+    }
+
+    // 到着間隔・直前 CPU の基準を捨てる。Audio Thread が止まっている間 (prepareToPlay) のみ呼ぶ
+    void resetCallbackTiming() noexcept
+    {
+        lastStartUs_ = 0;
+        lastCpu_ = UINT32_MAX;
+    }
+
+    // Message Thread: リングを履歴へ移す。移した件数を返す
+    size_t drain() noexcept
+    {
+        size_t drained = 0;
+        XrunIncident incident;
+        while (pending_.pop(incident))
+        {
+            history_[historyNext_] = incident;
+            historyNext_ = (historyNext_ + 1) % kHistory;
+            historyCount_ = std::min(historyCount_ + 1, kHistory);
+            ++totalIncidents_;
+            ++drained;
+        }
+        return drained;
+    }
+
+    // Message Thread: 履歴を捨てる (デバイス再起動時など)。リング内の未 drain 分も読み捨てる
+    void clearHistory() noexcept
+    {
+        drain();
+        historyCount_ = 0;
+        historyNext_ = 0;
+        totalIncidents_ = 0;
+        convo::publishAtomic(droppedIncidents_, uint64_t{0}, std::memory_order_relaxed); // relaxed: 件数のみ
+    }
+
+    // Message Thread
+    [[nodiscard]] Report report() const noexcept
+    {
+        Report out;
+        out.totalIncidents = totalIncidents_;
+        out.droppedIncidents = convo::consumeAtomic(droppedIncidents_, std::memory_order_relaxed); // relaxed: 件数のみ
+        out.count = historyCount_;
+        const size_t oldest = (historyNext_ + kHistory - historyCount_) % kHistory;
+        for (size_t i = 0; i < historyCount_; ++i)
+        {
+            const XrunIncident& incident = history_[(oldest + i) % kHistory];
+            out.incidents[i] = incident;
+            for (size_t bit = 0; bit < XrunIncident::kNumFlags; ++bit)
+                if (incident.has(1u << bit))
+                    ++out.flagCounts[bit];
+            const DspStage dominant = incident.dominantStage();
+            if (dominant != DspStage::Count)
+                ++out.dominantStageCounts[static_cast<size_t>(dominant)];
+        }
+        return out;
+    }
+
+private:
+    ActivityWindow publication_;
+    ActivityWindow retire_;
+
+    // Audio Thread 専用
+    uint64_t lastStartUs_ = 0;
+    uint32_t lastCpu_ = UINT32_MAX;
+    LockFreeRingBuffer<XrunIncident, kPendingCapacity> pending_;
+    std::atomic<uint64_t> droppedIncidents_ { 0 };
+    std::atomic<FlightRecorder*> flightRecorder_ { nullptr };
+
+    // Message Thread 専用
+    std::array<XrunIncident, kHistory> history_ {};
+    size_t historyNext_ = 0;
+    size_t historyCount_ = 0;
+    uint64_t totalIncidents_ = 0;
+};
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+} // namespace convo
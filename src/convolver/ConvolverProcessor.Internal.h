@@ -10,6 +10,15 @@
 #include <mkl.h>
 #include <mkl_vml.h>
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "audioengine/AtomicAccess.h"
+#include "core/ScopedMXCSR.h"
+
 namespace ConvolverProcessorInternal
 {
 
@@ -90,6 +99,57 @@ namespace ConvolverProcessorInternal
                                                     const std::function<bool()>& shouldExit,
                                                     bool* wasCancelled);
 
+    // ────────────────────────────────────────────────────────────────
+    // 位相変換のチャンネル並列実行 (Loader 側のみ)
+    //   MKL は sequential リンクのため DFTI 内部のスレッド化は使えない。代わりにチャンネルを
+    //   std::async ワーカーへ配る。fn(ch) は自前の DFTI ディスクリプタと作業領域で 1 チャンネルを
+    //   変換し、失敗・キャンセルで false を返す (以後のチャンネルは始めない)。
+    //   同時実行数はハードウェアスレッド数と、作業領域の合計が kPhaseScratchBudgetBytes に
+    //   収まる数で抑える。1 本に収まる場合は呼び出しスレッドで順に実行する。
+    // ────────────────────────────────────────────────────────────────
+    inline constexpr size_t kPhaseScratchBudgetBytes = size_t { 1 } << 30;
+
+    template <typename Fn>
+    bool runChannelsParallel(int numChannels, size_t scratchBytesPerChannel, Fn&& fn)
+    {
+        const size_t byMemory = std::max<size_t>(1, kPhaseScratchBudgetBytes / std::max<size_t>(1, scratchBytesPerChannel));
+        const size_t byCores = std::max(1u, std::thread::hardware_concurrency());
+        const int numWorkers = static_cast<int>(std::min({ static_cast<size_t>(std::max(0, numChannels)), byCores, byMemory }));
+
+        if (numWorkers <= 1)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                if (!fn(ch))
+                    return false;
+            return true;
+        }
+
+        std::atomic<int> nextChannel { 0 };
+        std::atomic<bool> failed { false };
+        const auto worker = [&]()
+        {
+            // ★ Bug#4: std::async ワーカー — ThreadPool 実装依存のため RAII で保存＋復元
+            const convo::cpu::ScopedMXCSR mxcsr;
+            for (int ch = convo::fetchAddAtomic(nextChannel, 1, std::memory_order_relaxed); ch < numChannels; // relaxed: チャンネル番号の払い出しのみ
+                 ch = convo::fetchAddAtomic(nextChannel, 1, std::memory_order_relaxed))                       // relaxed: 同上
+            {
+                if (convo::consumeAtomic(failed, std::memory_order_relaxed) || !fn(ch)) // relaxed: 打ち切りのヒント
+                {
+                    convo::publishAtomic(failed, true, std::memory_order_relaxed);      // relaxed: 結果は join 後に読む
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(static_cast<size_t>(numWorkers - 1));
+        for (int w = 1; w < numWorkers; ++w)
+            futures.emplace_back(std::async(std::launch::async, worker));
+        worker();
+        for (auto& f : futures) f.get();  // get(): 例外を確実に伝播 (全ワーカー join 後に判定)
+        return !convo::consumeAtomic(failed, std::memory_order_relaxed); // relaxed: join が HB を与える
+    }
+
     // ────────────────────────────────────────────────────────────────
     // 2 の累乗へ切り上げ
     // ────────────────────────────────────────────────────────────────
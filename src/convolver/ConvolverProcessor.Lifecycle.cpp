@@ -3,9 +3,13 @@
 #include "audioengine/AudioEngine.h"
 #include "CacheManager.h"
 #include "ProgressiveUpgradeThread.h"
+#include "StandbyPrebuildThread.h"
+#include "CachePrefetchThread.h"
+#include "IRLibraryIndexer.h"
 #include "convolver/ConvolverProcessor.Internal.h"
 #include "core/ThreadAffinityManager.h"
 #include "AlignedAllocation.h"
+#include "NucLayoutWisdom.h"
 #include <mkl.h>
 
 #include "audioengine/AtomicAccess.h"
@@ -17,6 +21,74 @@ std::atomic<uint32_t> ConvolverProcessor::StereoConvolver::liveCount { 0 };
 
 #if defined(CONVOPEQ_ENABLE_CONVOLVER_SPLIT_LIFECYCLE)
 
+void ConvolverProcessor::applyTailLayerPolicy(convo::FilterSpec& spec, const BuildSnapshot& snapshot) const noexcept
+{
+    // ★ Tail Worker: affinity manager が無い場合もオフロード自体は有効 (OS 既定スケジューリング)
+    spec.tailWorkerOffload = snapshot.tailWorkerOffloadEnabled;
+    const AudioEngine* engine = getRcuProvider();
+    spec.tailWorkerAffinity = (engine != nullptr) ? &engine->getAffinityManager() : nullptr;
+    spec.compactTailSpectra = snapshot.compactTailSpectraEnabled;
+    spec.tailDecimation = snapshot.multirateTailEnabled ? 0 : 1;  // 0 = レートから自動決定
+    spec.partitionCullFloorDb = static_cast<double>(snapshot.partitionCullFloorDb);
+    spec.farTailHorizonSeconds = static_cast<double>(snapshot.farTailHorizonSec);
+}
+
+void ConvolverProcessor::applyLayoutWisdom(convo::FilterSpec& spec, const BuildSnapshot& snapshot,
+                                           int irLength, int blockSize, bool allowCalibration) const
+{
+    if (!snapshot.layoutAutoTuneEnabled || !spec.tailEnabled || irLength <= 0 || blockSize <= 0)
+        return;
+
+    auto& wisdom = convo::NucLayoutWisdom::getInstance();
+    const auto key = convo::NucLayoutWisdom::makeKey(blockSize, irLength, spec);
+    const auto entry = allowCalibration ? wisdom.calibrate(key, spec) : wisdom.lookup(key);
+    if (!entry.has_value())
+        return;
+    spec.tailL1L2Multiplier = entry->multiplier;
+    if (spec.spectrumLayout == convo::FilterSpec::SpectrumLayout::Auto)
+        spec.spectrumLayout = entry->spectrumLayout;
+}
+
+void ConvolverProcessor::extractTrueStereoCross(const juce::AudioBuffer<double>& ir, int length, const BuildSnapshot& snapshot,
+                                                convo::ScopedAlignedPtr<double>& crossRL,
+                                                convo::ScopedAlignedPtr<double>& crossLR)
+{
+    crossRL.reset();
+    crossLR.reset();
+
+    // 4ch 配列規約: ch0=LL, ch1=LR (入力L→出力R), ch2=RL (入力R→出力L), ch3=RR
+    if (!snapshot.trueStereoEnabled || ir.getNumChannels() != 4 || length <= 0 || ir.getNumSamples() < length)
+        return;
+
+    auto rl = convo::makeAlignedArray<double>(static_cast<size_t>(length));
+    auto lr = convo::makeAlignedArray<double>(static_cast<size_t>(length));
+    std::memcpy(rl.get(), ir.getReadPointer(2), static_cast<size_t>(length) * sizeof(double));
+    std::memcpy(lr.get(), ir.getReadPointer(1), static_cast<size_t>(length) * sizeof(double));
+    crossRL = std::move(rl);
+    crossLR = std::move(lr);
+}
+
+void ConvolverProcessor::applyIrBusCullLength(convo::FilterSpec& spec, const double* irL, const double* irR, int length,
+                                              int knownBlockSize, const IrBusSources& irBus)
+{
+    if ((irBus.count <= 0 && !irBus.hasMorph()) || spec.partitionCullFloorDb <= convo::FilterSpec::kPartitionCullDisabledDb || spec.partitionCullLength > 0)
+        return;
+
+    int cullLength = juce::jmax(
+        convo::MKLNonUniformConvolver::computeCulledIRLength(irL, length, knownBlockSize, spec.partitionCullFloorDb),
+        convo::MKLNonUniformConvolver::computeCulledIRLength(irR, length, knownBlockSize, spec.partitionCullFloorDb));
+    for (int i = 0; i < irBus.count; ++i)
+        for (const auto& bus : irBus.data[i])
+            if (bus)
+                cullLength = juce::jmax(cullLength,
+                    convo::MKLNonUniformConvolver::computeCulledIRLength(bus.get(), length, knownBlockSize, spec.partitionCullFloorDb));
+    for (const auto& morph : irBus.morph)
+        if (morph)
+            cullLength = juce::jmax(cullLength,
+                convo::MKLNonUniformConvolver::computeCulledIRLength(morph.get(), length, knownBlockSize, spec.partitionCullFloorDb));
+    spec.partitionCullLength = cullLength;
+}
+
 const ConvolverProcessor::IRState* ConvolverProcessor::acquireIRState() const noexcept
 {
     return convo::consumeAtomic(currentIRState, std::memory_order_acquire); // acquire: updateIRState/releaseResources の exchangeAtomic acq_rel と HB
@@ -27,7 +99,8 @@ void ConvolverProcessor::releaseIRState(const IRState* /*state*/) const noexcept
     // IRState lifetime is managed by deferred retirement.
 }
 
-void ConvolverProcessor::updateIRState(const juce::AudioBuffer<double>& newIR, double newSR, float additionalAttenuationDb, float irFreqPeakGainDb)
+void ConvolverProcessor::updateIRState(const juce::AudioBuffer<double>& newIR, double newSR, float additionalAttenuationDb, float irFreqPeakGainDb,
+                                       double headEnergyRatio)
 {
     auto uniqueIR = std::make_unique<juce::AudioBuffer<double>>(newIR);
 
@@ -37,6 +110,7 @@ void ConvolverProcessor::updateIRState(const juce::AudioBuffer<double>& newIR, d
     newState->sampleRate = newSR;
     newState->additionalAttenuationDb = additionalAttenuationDb;
     newState->irFreqPeakGainDb = irFreqPeakGainDb;
+    newState->headEnergyRatio = headEnergyRatio;
     if (auto* provider = getRcuProvider(); provider != nullptr)
         newState->generation = provider->snapshotRcuEpoch();
     else
@@ -54,7 +128,7 @@ void ConvolverProcessor::updateIRState(const juce::AudioBuffer<double>& newIR, d
         };
 
         if (auto* provider = getRcuProvider(); provider != nullptr)
-            provider->enqueueDeferredDeleteNonRt(oldState, deleter);
+            provider->enqueueDeferredDeleteNonRt(oldState, deleter, convo::isr::RetireProducer::Convolver);
         else
             deleter(oldState);
     }
@@ -67,7 +141,7 @@ void ConvolverProcessor::StereoConvolver::retireStereoConvolver(StereoConvolver*
 
     if (provider != nullptr)
     {
-        provider->enqueueDeferredDeleteNonRt(sc, destroyStereoConvolver);
+        provider->enqueueDeferredDeleteNonRt(sc, destroyStereoConvolver, convo::isr::RetireProducer::Convolver);
         return;
     }
 
@@ -102,7 +176,9 @@ ConvolverProcessor::ConvolverProcessor()
 // ────────────────────────────────────────────────────────────────
 ConvolverProcessor::~ConvolverProcessor()
 {
-    stopUpgradeThread();
+    // 先に全スレッドへ知らせておき、以下の stop / reset で 1 本ずつ待つ時間を重ねる
+    requestBackgroundStop();
+    stopBackgroundThreads();
     stopTimer();
     forceCleanup();
     // スレッドを停止
@@ -134,6 +210,26 @@ ConvolverProcessor::~ConvolverProcessor()
     // Note: final deferred reclaim is owned by AudioEngine shutdown sequence.
 }
 
+void ConvolverProcessor::requestBackgroundStop()
+{
+    if (upgradeThread)   upgradeThread->cancel();
+    if (standbyThread)   standbyThread->cancel();
+    if (prefetchThread)  prefetchThread->cancel();
+    if (libraryIndexer)  libraryIndexer->cancel();
+    if (activeLoader)    activeLoader->signalThreadShouldExit();
+    for (auto& loader : loaderTrashBin)
+        if (loader)
+            loader->signalThreadShouldExit();
+}
+
+void ConvolverProcessor::stopBackgroundThreads()
+{
+    stopUpgradeThread();
+    stopStandbyPrebuild();
+    stopCachePrefetch();
+    stopIRLibraryIndexer();
+}
+
 // ────────────────────────────────────────────────────────────────
 // Timer Callback
 // ────────────────────────────────────────────────────────────────
@@ -261,12 +357,40 @@ void ConvolverProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
                     tailSpec.tailStrength = static_cast<double>(buildSnapshot.tailStrength);
                     tailSpec.tailL1L2Multiplier = buildSnapshot.tailL1L2Multiplier;
                 }
+                applyTailLayerPolicy(tailSpec, buildSnapshot);
+                const bool trueStereo = conv->isTrueStereo();
+                if (trueStereo)
+                {
+                    tailSpec.tailWorkerOffload = false;   // ★ True-stereo: Tail Worker と排他
+                    tailSpec.compactTailSpectra = false;  // ★ True-stereo: Compact tail と排他
+                    tailSpec.tailDecimation = 1;          // ★ True-stereo: クロスパスは全レイヤー同一レート
+                    tailSpec.partitionCullFloorDb = convo::FilterSpec::kPartitionCullDisabledDb;  // ★ True-stereo: クロス IR と構成を揃えるため間引き無効
+                    tailSpec.farTailHorizonSeconds = 0.0;  // ★ True-stereo: 4 項融合カーネルは常駐判定を持たない
+                    tailSpec.spectrumLayout = convo::FilterSpec::SpectrumLayout::PartitionMajor;  // ★ True-stereo: 4 項融合カーネルはパーティション優先配置のみ
+                }
+                applyLayoutWisdom(tailSpec, buildSnapshot, conv->irDataLength, internalBlockSize, false);
 
                 if (newConv->init(irL.release(), irR.release(),
                                   conv->irDataLength, sampleRate, conv->irLatency, internalBlockSize, samplesPerBlock, conv->storedScale,
-                                  getExperimentalDirectHeadEnabled(),
-                                  &tailSpec, this))
+                                  trueStereo ? false : getZeroLatencyHeadEnabled(),
+                                  &tailSpec, this, conv))
                 {
+                    if (trueStereo)
+                    {
+                        auto crossRL = convo::makeAlignedArray<double>(static_cast<size_t>(conv->irDataLength));
+                        auto crossLR = convo::makeAlignedArray<double>(static_cast<size_t>(conv->irDataLength));
+                        std::memcpy(crossRL.get(), conv->crossIrData[0], conv->irDataLength * sizeof(double));
+                        std::memcpy(crossLR.get(), conv->crossIrData[1], conv->irDataLength * sizeof(double));
+                        newConv->attachTrueStereoCross(crossRL.release(), crossLR.release());
+                    }
+                    // ★ IR bus / Spectral morph: 追加 IR・モーフ先も同じ長さで再利用して付け直す (焼き込み済みなら irData に含まれている)
+                    newConv->irBusBaked = conv->irBusBaked;
+                    if (conv->irBusCount > 0 || conv->hasSpectralMorphSource())
+                    {
+                        IrBusSources bus;
+                        if (conv->copyIrBusSources(bus))
+                            newConv->attachOrBakeIrBus(bus);
+                    }
                     newConv = newConvHolder.release();
                     const uint64_t retireEpoch = (getRcuProvider() != nullptr) ? getRcuProvider()->snapshotRcuEpoch() : 1;
                     auto* oldConv = exchangeActiveEngine(newConv, std::memory_order_acq_rel); // acq_rel: acquire で旧 engine 取得; release で新 engine 公開
@@ -286,18 +410,15 @@ void ConvolverProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
         }
     }
 
-    // DelayLine準備
-    if (delayBufferCapacity < DELAY_BUFFER_SIZE)
+    // DelayLine準備: 現エンジンの遅延 (未ロードなら L0 パーティション長 = nextPow2(max(block, 64))) 分だけ確保。
+    // IR ロード後の遅延は refreshLatency が reserve で伸ばす
     {
-        auto newL = convo::makeAlignedArray<double>(static_cast<size_t>(DELAY_BUFFER_SIZE));
-        auto newR = convo::makeAlignedArray<double>(static_cast<size_t>(DELAY_BUFFER_SIZE));
-        delayBuffer[0] = std::move(newL);
-        delayBuffer[1] = std::move(newR);
-        delayBufferCapacity = DELAY_BUFFER_SIZE;
+        const int l0Latency = juce::nextPowerOfTwo(juce::jmax(samplesPerBlock, 64));
+        const int engineLatency = (conv != nullptr) ? juce::jmax(0, conv->latency) + juce::jmax(0, conv->irLatency) : 0;
+        const int initialDelay = juce::jmin(juce::jmax(l0Latency, engineLatency), MAX_TOTAL_DELAY);
+        if (!latencyDelay.prepare(initialDelay, samplesPerBlock))
+            throw std::bad_alloc();
     }
-    juce::FloatVectorOperations::clear(delayBuffer[0].get(), DELAY_BUFFER_SIZE);
-    juce::FloatVectorOperations::clear(delayBuffer[1].get(), DELAY_BUFFER_SIZE);
-    delayWritePos = 0;
 
     // Dry/Wet/Smoothing/Oldバッファ確保 (まとめて処理)
     auto allocateIfNeeded = [](convo::ScopedAlignedPtr<double>* storage, int& capacity, const char* name) {
@@ -329,17 +450,6 @@ void ConvolverProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     oldDryBuffer.setDataToReferTo(oldDryChs, 2, MAX_BLOCK_SIZE);
     oldDryBuffer.clear();
 
-    // Wet buffers (simple array, not referable buffer)
-    if (wetBufferCapacity < MAX_BLOCK_SIZE)
-    {
-        auto newL = convo::makeAlignedArray<double>(static_cast<size_t>(MAX_BLOCK_SIZE));
-        auto newR = convo::makeAlignedArray<double>(static_cast<size_t>(MAX_BLOCK_SIZE));
-        wetBufferStorage[0] = std::move(newL);
-        wetBufferStorage[1] = std::move(newR);
-        wetBufferCapacity = MAX_BLOCK_SIZE;
-    }
-    juce::FloatVectorOperations::clear(wetBufferStorage[0].get(), MAX_BLOCK_SIZE);
-
     // ★ M-05: delayFadeRamp バッファ確保 (prepareToPlayで事前確保)
     {
         const int neededFadeSamples = MAX_BLOCK_SIZE;
@@ -351,7 +461,6 @@ void ConvolverProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
             delayFadeRampCapacity = (delayFadeRampBuffer.get() != nullptr) ? neededFadeSamples : 0;
         }
     }
-    juce::FloatVectorOperations::clear(wetBufferStorage[1].get(), MAX_BLOCK_SIZE);
 
     // スムージング時間の設定 (H3: pendingOverride が唯一の Source of Truth)
     {
@@ -400,13 +509,13 @@ void ConvolverProcessor::releaseResources()
 {
     // Clean up thread-based loaders
     stopUpgradeThread();
+    stopStandbyPrebuild();
+    stopCachePrefetch();
     forceCleanup();
     activeLoader.reset();
 
     // バッファの解放
-    delayBuffer[0].reset();
-    delayBuffer[1].reset();
-    delayBufferCapacity = 0;
+    latencyDelay.release();
 
     dryBufferStorage[0].reset();
     dryBufferStorage[1].reset();
@@ -469,9 +578,7 @@ void ConvolverProcessor::reset()
     if (conv)
         conv->reset();
 
-    if (delayBuffer[0]) juce::FloatVectorOperations::clear(delayBuffer[0].get(), DELAY_BUFFER_SIZE);
-    if (delayBuffer[1]) juce::FloatVectorOperations::clear(delayBuffer[1].get(), DELAY_BUFFER_SIZE);
-    delayWritePos = 0;
+    latencyDelay.clear();
 
     dryBuffer.clear();
     smoothingBuffer.clear();
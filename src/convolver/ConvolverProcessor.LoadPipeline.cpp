@@ -2,9 +2,16 @@
 #include "ConvolverProcessor.h"
 #include "audioengine/AudioEngine.h"
 #include "CacheManager.h"
+#include "ResampledIRCache.h"
 #include "convolver/ConvolverProcessor.Internal.h"
 #include "AlignedAllocation.h"
 #include "ProgressiveUpgradeThread.h"
+#include "StandbyIRPool.h"
+#include "StandbyPrebuildThread.h"
+#include "CachePrefetchThread.h"
+#include "IRLibraryIndex.h"
+#include "IRLibraryIndexer.h"
+#include "IrBusShaping.h"
 
 #include "audioengine/AtomicAccess.h"
 
@@ -79,6 +86,7 @@ bool ConvolverProcessor::loadImpulseResponse(const juce::File& irFile, bool opti
                                                       buildSnapshot.mixedTransitionStartHz, buildSnapshot.mixedTransitionEndHz,
                                                       convo::consumeAtomic(currentIRScale, std::memory_order_acquire), // acquire: applyNewState/snapshot restore 側 publishAtomic release と HB
                                                       buildSnapshot);
+        activeLoader->headEnergyRatio = state->headEnergyRatio;
         releaseIRState(state);
     }
     else
@@ -108,13 +116,15 @@ void ConvolverProcessor::startProgressiveUpgrade(const juce::File& file,
                                                  double sampleRate,
                                                  int currentFFTSize,
                                                  uint64_t generation,
-                                                 uint64_t baseKey)
+                                                 uint64_t baseKey,
+                                                 bool completeStreamingHead)
 {
-    if (!isProgressiveUpgradeEnabled())
+    const bool upgradeEnabled = isProgressiveUpgradeEnabled();
+    if (!upgradeEnabled && !completeStreamingHead)
         return;
 
-    const int targetFFT = getTargetUpgradeFFTSize();
-    if (currentFFTSize >= targetFFT)
+    const int targetFFT = upgradeEnabled ? getTargetUpgradeFFTSize() : currentFFTSize;
+    if (currentFFTSize >= targetFFT && !completeStreamingHead)
         return;
 
     stopUpgradeThread();
@@ -131,7 +141,11 @@ void ConvolverProcessor::startProgressiveUpgrade(const juce::File& file,
                                                                 *cacheManager,
                                                                 getRcuProvider() != nullptr
                                                                     ? &getRcuProvider()->getAffinityManager()
-                                                                    : nullptr);
+                                                                    : nullptr,
+                                                                getRcuProvider() != nullptr
+                                                                    ? &getRcuProvider()->getBackgroundScheduler()
+                                                                    : nullptr,
+                                                                completeStreamingHead);
     upgradeThread->startThread();
 }
 
@@ -165,7 +179,8 @@ void ConvolverProcessor::setEnableProgressiveUpgrade(bool enable)
         const juce::ScopedLock lock(pendingOverrideLock);
         pendingOverride.enableProgressiveUpgrade = enable;
     }
-    if (!enable)
+    // 先頭だけの IR を全長へ置き換える途中なら止めない (止めると先頭だけが鳴り続ける)
+    if (!enable && !(upgradeThread && upgradeThread->isCompletingStreamingHead()))
         stopUpgradeThread();
 }
 
@@ -175,6 +190,18 @@ void ConvolverProcessor::setEnableProgressiveUpgrade(bool enable)
     return pendingOverride.enableProgressiveUpgrade;
 }
 
+void ConvolverProcessor::setStreamingIRActivationEnabled(bool enable)
+{
+    const juce::ScopedLock lock(pendingOverrideLock);
+    pendingOverride.streamingIRActivationEnabled = enable;
+}
+
+[[nodiscard]] bool ConvolverProcessor::isStreamingIRActivationEnabled() const
+{
+    const juce::ScopedLock lock(pendingOverrideLock);
+    return pendingOverride.streamingIRActivationEnabled;
+}
+
 void ConvolverProcessor::setMaxCacheEntries(size_t maxEntries)
 {
     const size_t clamped = juce::jlimit<size_t>(1, 64, maxEntries);
@@ -192,11 +219,343 @@ void ConvolverProcessor::setMaxCacheEntries(size_t maxEntries)
     return static_cast<size_t>(pendingOverride.maxCacheEntries);
 }
 
+void ConvolverProcessor::setResampledIRCacheBudgetBytes(size_t bytes)
+{
+    ResampledIRCache::getInstance().setByteBudget(bytes);
+}
+
+[[nodiscard]] size_t ConvolverProcessor::getResampledIRCacheBudgetBytes() const
+{
+    return ResampledIRCache::getInstance().getByteBudget();
+}
+
+void ConvolverProcessor::setStandbySampleRates(std::vector<double> rates)
+{
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    rates.erase(std::remove_if(rates.begin(), rates.end(),
+                               [](double r) { return !std::isfinite(r) || r < 8000.0 || r > 768000.0; }),
+                rates.end());
+    std::sort(rates.begin(), rates.end());
+    rates.erase(std::unique(rates.begin(), rates.end()), rates.end());
+
+    standbySampleRates = std::move(rates);
+    if (standbySampleRates.empty())
+    {
+        stopStandbyPrebuild();
+        StandbyIRPool::getInstance().clear();
+        return;
+    }
+    scheduleStandbyPrebuild();
+}
+
+[[nodiscard]] std::vector<double> ConvolverProcessor::getStandbySampleRates() const
+{
+    return standbySampleRates;
+}
+
+void ConvolverProcessor::setStandbyBudgetBytes(size_t bytes)
+{
+    StandbyIRPool::getInstance().setByteBudget(bytes);
+}
+
+[[nodiscard]] size_t ConvolverProcessor::getStandbyBudgetBytes() const
+{
+    return StandbyIRPool::getInstance().getByteBudget();
+}
+
+void ConvolverProcessor::stopStandbyPrebuild()
+{
+    if (standbyThread)
+    {
+        standbyThread->cancel();
+        standbyThread->stopThread(2000);
+        standbyThread.reset();
+    }
+}
+
+void ConvolverProcessor::scheduleStandbyPrebuild()
+{
+    if (!juce::MessageManager::getInstance()->isThisTheMessageThread())
+    {
+        // prepareToPlay が Message Thread 外から呼ばれた場合 (スレッド所有は Message Thread に揃える)
+        juce::WeakReference<ConvolverProcessor> weakThis(this);
+        juce::MessageManager::callAsync([weakThis]()
+        {
+            if (auto* self = weakThis.get())
+                self->scheduleStandbyPrebuild();
+        });
+        return;
+    }
+
+    stopStandbyPrebuild();
+    if (standbySampleRates.empty())
+        return;
+
+    juce::File irFile;
+    {
+        const juce::ScopedLock sl(irFileLock);
+        irFile = currentIrFile;
+    }
+    if (!irFile.existsAsFile())
+        return;
+
+    const double currentRate = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay の publishAtomic release と HB
+    std::vector<double> rates;
+    for (const double rate : standbySampleRates)
+    {
+        if (std::abs(rate - currentRate) > 1e-6)
+            rates.push_back(rate);
+    }
+    if (rates.empty())
+        return;
+
+    standbyThread = std::make_unique<StandbyPrebuildThread>(*this,
+                                                            irFile,
+                                                            std::move(rates),
+                                                            convolverStateGeneration.getCurrentGeneration(),
+                                                            getRcuProvider() != nullptr
+                                                                ? &getRcuProvider()->getAffinityManager()
+                                                                : nullptr);
+    standbyThread->startThread();
+}
+
+bool ConvolverProcessor::prebuildStandbyIR(const juce::File& file, double standbyRate, const std::function<bool()>& shouldCancel)
+{
+    // rebuildAllIRsSynchronous と同じクランプ (消費側の StandbyIRPool キーと一致させる)
+    const BuildSnapshot buildSnapshot = captureBuildSnapshot();
+    const int clampedPhaseMode = juce::jlimit(static_cast<int>(PhaseMode::AsIs),
+                                              static_cast<int>(PhaseMode::Minimum),
+                                              buildSnapshot.phaseMode);
+    const float clampedMixedF1 = juce::jlimit(MIXED_F1_MIN_HZ,
+                                              MIXED_F1_MAX_HZ,
+                                              buildSnapshot.mixedTransitionStartHz);
+    const float clampedMixedF2 = juce::jlimit((std::max)(MIXED_F2_MIN_HZ, clampedMixedF1 + 10.0f),
+                                              MIXED_F2_MAX_HZ,
+                                              buildSnapshot.mixedTransitionEndHz);
+    const int blockSize = juce::jlimit(1, MAX_BLOCK_SIZE,
+                                       [&]{ const int bs = convo::consumeAtomic(currentBufferSize, std::memory_order_acquire); return bs > 0 ? bs : 512; }()); // acquire: prepareToPlay の publishAtomic release と HB
+
+    LoaderThread loader(*this, file, standbyRate, blockSize, static_cast<PhaseMode>(clampedPhaseMode),
+                        clampedMixedF1, clampedMixedF2, buildSnapshot);
+    loader.externalCancellationCheck = shouldCancel;
+    loader.reportLoadingProgress = false;
+    return loader.prebuildStandby();
+}
+
+void ConvolverProcessor::setCachePrefetchCount(int count)
+{
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    cachePrefetchCount = juce::jlimit(0, kMaxRecentIRFiles, count);
+    if (cachePrefetchCount == 0)
+    {
+        stopCachePrefetch();
+        if (cacheManager)
+            cacheManager->clearPrefetched();
+        return;
+    }
+    scheduleCachePrefetch();
+}
+
+[[nodiscard]] int ConvolverProcessor::getCachePrefetchCount() const
+{
+    return cachePrefetchCount;
+}
+
+void ConvolverProcessor::setCachePrefetchBudgetBytes(size_t bytes)
+{
+    if (cacheManager)
+        cacheManager->setPrefetchBudgetBytes(bytes);
+}
+
+[[nodiscard]] size_t ConvolverProcessor::getCachePrefetchBudgetBytes() const
+{
+    return cacheManager ? cacheManager->getPrefetchBudgetBytes() : CacheManager::kDefaultPrefetchBudgetBytes;
+}
+
+void ConvolverProcessor::setCacheCompressionEnabled(bool enabled)
+{
+    if (cacheManager)
+        cacheManager->setPayloadCompressionEnabled(enabled);
+}
+
+[[nodiscard]] bool ConvolverProcessor::isCacheCompressionEnabled() const
+{
+    return cacheManager && cacheManager->isPayloadCompressionEnabled();
+}
+
+void ConvolverProcessor::setCacheDiskBudgetBytes(uint64_t bytes)
+{
+    if (!cacheManager)
+        return;
+    cacheManager->setDiskBudgetBytes(bytes);
+    cacheManager->evictLRU(getMaxCacheEntries());
+}
+
+[[nodiscard]] uint64_t ConvolverProcessor::getCacheDiskBudgetBytes() const
+{
+    return cacheManager ? cacheManager->getDiskBudgetBytes() : CacheManager::kDefaultDiskBudgetBytes;
+}
+
+void ConvolverProcessor::setCacheCostWeightedEviction(bool enabled)
+{
+    if (cacheManager)
+        cacheManager->setCostWeightedEviction(enabled);
+}
+
+[[nodiscard]] bool ConvolverProcessor::isCacheCostWeightedEviction() const
+{
+    return cacheManager && cacheManager->isCostWeightedEviction();
+}
+
+[[nodiscard]] CacheManager::Stats ConvolverProcessor::getCacheStats() const
+{
+    return cacheManager ? cacheManager->getStats() : CacheManager::Stats{};
+}
+
+[[nodiscard]] std::vector<juce::File> ConvolverProcessor::getRecentIRFiles() const
+{
+    return recentIrFiles;
+}
+
+void ConvolverProcessor::setRecentIRFiles(std::vector<juce::File> files)
+{
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    recentIrFiles.clear();
+    for (auto& file : files)
+    {
+        if (file == juce::File() || std::find(recentIrFiles.begin(), recentIrFiles.end(), file) != recentIrFiles.end())
+            continue;
+        recentIrFiles.push_back(std::move(file));
+        if (static_cast<int>(recentIrFiles.size()) >= kMaxRecentIRFiles)
+            break;
+    }
+}
+
+void ConvolverProcessor::noteRecentIRFile(const juce::File& file)
+{
+    recentIrFiles.erase(std::remove(recentIrFiles.begin(), recentIrFiles.end(), file), recentIrFiles.end());
+    recentIrFiles.insert(recentIrFiles.begin(), file);
+    if (static_cast<int>(recentIrFiles.size()) > kMaxRecentIRFiles)
+        recentIrFiles.resize(static_cast<size_t>(kMaxRecentIRFiles));
+}
+
+void ConvolverProcessor::stopCachePrefetch()
+{
+    if (prefetchThread)
+    {
+        prefetchThread->cancel();
+        prefetchThread->stopThread(2000);
+        prefetchThread.reset();
+    }
+}
+
+void ConvolverProcessor::scheduleCachePrefetch()
+{
+    if (!juce::MessageManager::getInstance()->isThisTheMessageThread())
+    {
+        // prepareToPlay が Message Thread 外から呼ばれた場合 (スレッド所有は Message Thread に揃える)
+        juce::WeakReference<ConvolverProcessor> weakThis(this);
+        juce::MessageManager::callAsync([weakThis]()
+        {
+            if (auto* self = weakThis.get())
+                self->scheduleCachePrefetch();
+        });
+        return;
+    }
+
+    stopCachePrefetch();
+    if (cachePrefetchCount <= 0 || !cacheManager)
+        return;
+
+    const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay の publishAtomic release と HB
+    if (sr <= 0.0)
+        return;
+
+    juce::File irFile;
+    {
+        const juce::ScopedLock sl(irFileLock);
+        irFile = currentIrFile;
+    }
+
+    std::vector<juce::File> files;
+    for (const auto& file : recentIrFiles)
+    {
+        if (static_cast<int>(files.size()) >= cachePrefetchCount)
+            break;
+        if (file != irFile)
+            files.push_back(file);
+    }
+    if (files.empty())
+        return;
+
+    prefetchThread = std::make_unique<CachePrefetchThread>(*this,
+                                                            *cacheManager,
+                                                            std::move(files),
+                                                            sr,
+                                                            getTargetUpgradeFFTSize(),
+                                                            static_cast<int>(getPhaseMode()),
+                                                            convolverStateGeneration.getCurrentGeneration(),
+                                                            getRcuProvider() != nullptr
+                                                                ? &getRcuProvider()->getAffinityManager()
+                                                                : nullptr);
+    prefetchThread->startThread();
+}
+
+void ConvolverProcessor::setIRLibraryDirectories(std::vector<juce::File> directories)
+{
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    stopIRLibraryIndexer();
+    irLibraryDirectories.clear();
+    for (auto& dir : directories)
+    {
+        if (dir == juce::File() || std::find(irLibraryDirectories.begin(), irLibraryDirectories.end(), dir) != irLibraryDirectories.end())
+            continue;
+        irLibraryDirectories.push_back(std::move(dir));
+    }
+    if (irLibraryDirectories.empty())
+        return;
+
+    libraryIndexer = std::make_unique<IRLibraryIndexer>(*this,
+                                                        irLibraryDirectories,
+                                                        getRcuProvider() != nullptr
+                                                            ? &getRcuProvider()->getAffinityManager()
+                                                            : nullptr);
+    libraryIndexer->startThread();
+}
+
+[[nodiscard]] std::vector<juce::File> ConvolverProcessor::getIRLibraryDirectories() const
+{
+    return irLibraryDirectories;
+}
+
+void ConvolverProcessor::stopIRLibraryIndexer()
+{
+    if (libraryIndexer)
+    {
+        libraryIndexer->cancel();
+        libraryIndexer->stopThread(5000);
+        libraryIndexer.reset();
+    }
+}
+
+[[nodiscard]] bool ConvolverProcessor::lookupIRLibraryEntry(const juce::File& file, IRLibraryEntry& out)
+{
+    return IRLibraryIndex::getInstance().lookup(file, out);
+}
+
 void ConvolverProcessor::clearCache()
 {
     stopUpgradeThread();
+    stopStandbyPrebuild();
+    stopCachePrefetch();
     if (cacheManager)
         cacheManager->clear();
+    ResampledIRCache::getInstance().clear();
+    StandbyIRPool::getInstance().clear();
 }
 
 [[nodiscard]] bool ConvolverProcessor::isCacheEntrySafeToDelete(uint64_t cacheKey, int fftSize) const
@@ -234,12 +593,16 @@ void ConvolverProcessor::loadIR(const juce::File& irFile)
     if (!irFile.existsAsFile())
         return;
 
+    irPreviewActive = false;
+
     {
         const juce::ScopedLock sl(irFileLock);
         currentIrFile = irFile;
     }
+    noteRecentIRFile(irFile);
 
     stopUpgradeThread();
+    stopCachePrefetch();
 
     const uint64_t generation = convolverStateGeneration.bumpGeneration();
     const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay/applyNewState の publishAtomic release と HB
@@ -249,6 +612,7 @@ void ConvolverProcessor::loadIR(const juce::File& irFile)
     const size_t cacheLimit = getMaxCacheEntries();
 
     int appliedFft = 0;
+    bool streamingTailPending = false;
     const uint64_t targetKey = CacheManager::computeKey(irFile, targetFFT, sr, phase, targetFFT);
 
     if (cacheManager)
@@ -282,11 +646,19 @@ void ConvolverProcessor::loadIR(const juce::File& irFile)
             cfg.partitionSize = lowResFFT;
             cfg.generationId = generation;
             cfg.cacheKey = lowResKey;
+            // ★ Streaming activation: 先頭だけを変換して先に鳴らす。最小/混合位相は全長から求めるため対象外
+            if (isStreamingIRActivationEnabled() && getPhaseMode() == PhaseMode::AsIs)
+            {
+                cfg.streamingHeadSeconds = STREAMING_HEAD_SEC;
+                cfg.streamingReferenceSeconds = getTargetIRLength();
+            }
 
+            const double convertStartMs = juce::Time::getMillisecondCounterHiRes();
             auto prepared = irConverter->convertFile(irFile, cfg, [this, generation]()
             {
                 return !convolverStateGeneration.isCurrentGeneration(generation);
             });
+            const double convertMs = juce::Time::getMillisecondCounterHiRes() - convertStartMs;
 
             if (prepared == nullptr)
             {
@@ -297,8 +669,19 @@ void ConvolverProcessor::loadIR(const juce::File& irFile)
             if (prepared)
             {
                 prepared->originalFileName = irFile.getFileNameWithoutExtension();
-                cacheManager->save(lowResKey, lowResFFT, *prepared);
-                cacheManager->evictLRU(cacheLimit);
+                if (prepared->streamingHead)
+                {
+                    // 先頭だけのペイロードはキャッシュしない (全長は startProgressiveUpgrade が変換・保存する)
+                    streamingTailPending = true;
+                    juce::Logger::writeToLog("[DIAG_IR] loadIR: streaming head applied ("
+                        + juce::String(convertMs, 1) + " ms, headEnergyRatio="
+                        + juce::String(prepared->headEnergyRatio, 4) + ")");
+                }
+                else
+                {
+                    cacheManager->save(lowResKey, lowResFFT, *prepared, convertMs);
+                    cacheManager->evictLRU(cacheLimit);
+                }
                 appliedFft = lowResFFT;
                 applyComputedIR(std::move(prepared));
             }
@@ -307,7 +690,9 @@ void ConvolverProcessor::loadIR(const juce::File& irFile)
 
     if (appliedFft > 0)
     {
-        startProgressiveUpgrade(irFile, sr, appliedFft, generation, targetKey);
+        startProgressiveUpgrade(irFile, sr, appliedFft, generation, targetKey, streamingTailPending);
+        scheduleStandbyPrebuild();
+        scheduleCachePrefetch();
     }
     else
     {
@@ -318,6 +703,71 @@ void ConvolverProcessor::loadIR(const juce::File& irFile)
     }
 }
 
+[[nodiscard]] ConvolverProcessor::IRPreviewTicket ConvolverProcessor::beginIRPreview()
+{
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    stopUpgradeThread();
+    stopCachePrefetch();
+
+    IRPreviewTicket ticket;
+    ticket.generation = convolverStateGeneration.bumpGeneration();
+    ticket.sampleRate = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay/applyNewState の publishAtomic release と HB
+    return ticket;
+}
+
+[[nodiscard]] std::unique_ptr<ConvolverIRPayload> ConvolverProcessor::convertIRPreview(const juce::File& irFile,
+                                                                                     const IRPreviewTicket& ticket,
+                                                                                     const std::function<bool()>& shouldCancel)
+{
+    if (ticket.sampleRate <= 0.0 || !irFile.existsAsFile())
+        return nullptr;
+
+    // 最小/混合位相は全長から求めるため、プレビューは常に先頭のそのままの位相で鳴らす
+    IRConverter::ConvertConfig cfg;
+    cfg.fftSize = 512;
+    cfg.partitionSize = 512;
+    cfg.targetSampleRate = ticket.sampleRate;
+    cfg.phaseMode = static_cast<int>(PhaseMode::AsIs);
+    cfg.generationId = ticket.generation;
+    cfg.previewHeadSeconds = IR_PREVIEW_HEAD_SEC;
+    cfg.previewFadeSeconds = IR_PREVIEW_FADE_SEC;
+
+    auto prepared = IRConverter().convertFile(irFile, cfg, shouldCancel);
+    if (prepared)
+        prepared->originalFileName = irFile.getFileNameWithoutExtension();
+    return prepared;
+}
+
+void ConvolverProcessor::applyIRPreview(std::unique_ptr<ConvolverIRPayload> prepared)
+{
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    if (!prepared || !convolverStateGeneration.isCurrentGeneration(prepared->generationId))
+        return;
+
+    irPreviewActive = true;
+    applyComputedIR(std::move(prepared));
+}
+
+void ConvolverProcessor::cancelIRPreview()
+{
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    if (!irPreviewActive)
+        return;
+    irPreviewActive = false;
+
+    juce::File irFile;
+    {
+        const juce::ScopedLock sl(irFileLock);
+        irFile = currentIrFile;
+    }
+    // 現在 IR は直前に変換済みのためキャッシュから戻る
+    if (irFile.existsAsFile())
+        loadIR(irFile);
+}
+
 void ConvolverProcessor::applyComputedIR(std::unique_ptr<ConvolverIRPayload> prepared)
 {
     if (!prepared)
@@ -366,6 +816,10 @@ void ConvolverProcessor::applyComputedIR(std::unique_ptr<ConvolverIRPayload> pre
             prepared->timeDomainIR = std::move(scaledTimeIR);
         }
 
+        // ★ v3 キャッシュの mmap ビューは読み取り専用のため、スケール前に複製する
+        if (prepared->isMappedView() && !prepared->materializePartitionData())
+            juce::Logger::writeToLog("applyComputedIR: failed to materialize mapped partitionData; scale skipped for partition payload");
+
         if (prepared->partitionData && prepared->partitionSizeBytes > 0)
         {
             const size_t numDoubles = prepared->partitionSizeBytes / sizeof(double);
@@ -462,7 +916,7 @@ void ConvolverProcessor::applyComputedIR(std::unique_ptr<ConvolverIRPayload> pre
 
     // RCU経路では convolution を経由しないため、UI表示用のレイテンシー推定値を更新する。
     {
-        const bool directHeadActive = getExperimentalDirectHeadEnabled();
+        const bool directHeadActive = getZeroLatencyHeadEnabled();
         const int algorithmLatency = directHeadActive ? 0 : juce::jmax(0, prepared->fftSize);
 
         int irPeakLatency = 0;
@@ -509,13 +963,16 @@ void ConvolverProcessor::applyComputedIR(std::unique_ptr<ConvolverIRPayload> pre
     // loadIR() (RCU経路) では applyNewState() が呼ばれないため、
     // DSP側 rebuildAllIRsSynchronous() が参照する originalIR をここで保持する。
     if (prepared->timeDomainIR && prepared->timeDomainIR->getNumSamples() > 0)
-        updateIRState(*(prepared->timeDomainIR), prepared->sampleRate, prepared->additionalAttenuationDb, prepared->irFreqPeakGainDb);
+        updateIRState(*(prepared->timeDomainIR), prepared->sampleRate, prepared->additionalAttenuationDb, prepared->irFreqPeakGainDb,
+                      prepared->headEnergyRatio);
 
     // 3. RCU 状態の更新（★ 軽量化: partitionData/numPartitions/partitionSizeBytes はデッドコードのため除去）
 
     auto newState = std::make_unique<convo::ConvolverState>(prepared->fftSize,
                                                           prepared->generationId,
                                                           prepared->sampleRate);
+    // ★ v3 キャッシュ: mmap の寿命を RCU state に委ね、旧 state の deferred retire で解放する
+    newState->mappedStorage = prepared->mappedStorage;
 
     convo::publishAtomic(activeCacheKey, prepared->cacheKey, std::memory_order_release); // release: cache 判定側 acquire と HB
     convo::publishAtomic(activeCacheFFTSize, newState->fftSize, std::memory_order_release); // release: cache 判定側 acquire と HB
@@ -546,6 +1003,13 @@ void ConvolverProcessor::handleLoadError(const juce::String& error)
 
 void ConvolverProcessor::cleanup()
 {
+    // ★ Spectral crossfade: 完了したフェードの確定 / 期限切れフォールバック
+    pollSpectralCrossfade();
+    pollIrBusFade();
+    // ★ Spectral morph: 解除済みモーフの NUC 資源を返す (Audio Thread が解除を観測するまでは何もしない)
+    if (auto* liveEngine = loadActiveEngine(std::memory_order_acquire)) // acquire: exchangeActiveEngine acq_rel/release と HB
+        liveEngine->finishSpectralMorph();
+
     // LoaderThread のクリーンアップ (Message Thread Only)
     // 終了したスレッドのみを削除する (waitForThreadToExit(0) はブロックしない)
     for (auto it = loaderTrashBin.begin(); it != loaderTrashBin.end(); )
@@ -592,7 +1056,12 @@ void ConvolverProcessor::finalizeNUCEngineOnMessageThread(convo::ScopedAlignedPt
                                                           const BuildSnapshot& buildSnapshot,
                                                           double scaleFactor,
                                                           std::unique_ptr<juce::AudioBuffer<double>> loadedIR,
-                                                          std::unique_ptr<juce::AudioBuffer<double>> displayIR)
+                                                          std::unique_ptr<juce::AudioBuffer<double>> displayIR,
+                                                          convo::ScopedAlignedPtr<double> crossRL,
+                                                          convo::ScopedAlignedPtr<double> crossLR,
+                                                          bool eqFoldedIntoIR,
+                                                          std::shared_ptr<IrBusSources> irBus,
+                                                          bool irBusBaked)
 {
     // ここはMessage Thread上で実行されるためMKL規約を完全に遵守する
     // メモリ確保失敗に備えて try-catch を使用する
@@ -613,12 +1082,38 @@ void ConvolverProcessor::finalizeNUCEngineOnMessageThread(convo::ScopedAlignedPt
             spec.tailStrength = static_cast<double>(buildSnapshot.tailStrength);
             spec.tailL1L2Multiplier = buildSnapshot.tailL1L2Multiplier;
         }
+        applyTailLayerPolicy(spec, buildSnapshot);
+        const bool trueStereo = static_cast<bool>(crossRL) && static_cast<bool>(crossLR);
+        if (trueStereo)
+        {
+            spec.tailWorkerOffload = false;   // ★ True-stereo: クロスパスは相手 FDL を参照するため Tail Worker と排他
+            spec.compactTailSpectra = false;  // ★ True-stereo: クロスパスカーネルは double のみ
+            spec.tailDecimation = 1;          // ★ True-stereo: Multirate tail と排他
+            spec.partitionCullFloorDb = convo::FilterSpec::kPartitionCullDisabledDb;  // ★ True-stereo: クロス IR と構成を揃えるため間引き無効
+            spec.farTailHorizonSeconds = 0.0;  // ★ True-stereo: 4 項融合カーネルは常駐判定を持たない
+            spec.spectrumLayout = convo::FilterSpec::SpectrumLayout::PartitionMajor;  // ★ True-stereo: 4 項融合カーネルはパーティション優先配置のみ
+        }
+        applyLayoutWisdom(spec, buildSnapshot, length, knownBlockSize, false);  // 計測は Loader Thread で済んでいる
+
+        // ★ Shared spectra: 現行エンジンと IR・パラメータが一致すれば IR スペクトルを共有する
+        //   (Message Thread 上のため現行エンジンはこの間 retire されない)
+        const StereoConvolver* spectraDonor = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel/release と HB
+        if (irBus != nullptr)
+            applyIrBusCullLength(spec, irL.get(), irR.get(), length, knownBlockSize, *irBus);
 
         if (newConv->init(irL.release(), irR.release(), length, sr, peakDelay,
                   knownBlockSize, preferredCallSize, scaleFactor,
-                  getExperimentalDirectHeadEnabled(),
-                  &spec, this))
+                  trueStereo ? false : getZeroLatencyHeadEnabled(),
+                  &spec, this, spectraDonor))
         {
+            if (trueStereo)
+                newConv->attachTrueStereoCross(crossRL.release(), crossLR.release());
+            newConv->eqFoldedIntoIR = eqFoldedIntoIR;
+            newConv->irBusBaked = irBusBaked;
+            // ★ IR bus: 追加 IR のスペクトルを両チャンネルの NUC へ接続する (不可なら主 IR へ焼き込んで再初期化)。
+            //   モーフ先も同じ入れ物で受け取り、接続できる構成なら spectral morph を開始する
+            if (irBus != nullptr && !newConv->attachOrBakeIrBus(*irBus))
+                juce::Logger::writeToLog("ConvolverProcessor: IR bus could not be attached; continuing with the main IR only.");
             jassert(newConv->areNUCDescriptorsCommitted());
             // ★ [P0-3] Release 安全ガード: descriptor 未コミットでも処理継続
             if (!newConv->areNUCDescriptorsCommitted()) [[unlikely]]
@@ -724,6 +1219,16 @@ void ConvolverProcessor::switchEngineOnMessageThread(StereoConvolver* newEngine)
     if (newEngine == nullptr)
         return;
 
+    // ★ Spectral crossfade: 稼働中エンジンと構成が一致すればエンジンを交換せず IR スペクトルのみをフェードする
+    if (tryBeginSpectralCrossfade(newEngine))
+        return;
+
+    swapActiveEngineOnMessageThread(newEngine);
+}
+
+void ConvolverProcessor::swapActiveEngineOnMessageThread(StereoConvolver* newEngine) noexcept
+{
+    // 旧エンジンがフェード中ならフェード先 (未公開) は旧エンジンの retire と同時に破棄される
     auto* oldEngine = exchangeActiveEngine(newEngine, std::memory_order_acq_rel);
     // [work21 P1-15/Phase-D] Router経由でepoch進捗. provider必須 (fallback削除).
     if (auto* provider = getRcuProvider())
@@ -734,6 +1239,163 @@ void ConvolverProcessor::switchEngineOnMessageThread(StereoConvolver* newEngine)
         retireStereoConvolver(oldEngine, 0);
 }
 
+// ────────────────────────────────────────────────────────────────
+// Spectral crossfade (Message Thread のみ)
+//   IR 切替時、稼働中エンジンの NUC に新エンジンの IR スペクトルを渡し、入力 FDL を共有したまま
+//   Audio Thread 上でフェードさせる。新エンジンは公開せず稼働中エンジンが所有し、完了後に
+//   IR メタデータのみ入れ替えて破棄する。Audio Thread が本プロセッサを処理していない場合
+//   (期限切れ) は通常のエンジン交換へ切り替える。
+// ────────────────────────────────────────────────────────────────
+bool ConvolverProcessor::tryBeginSpectralCrossfade(StereoConvolver* newEngine) noexcept
+{
+    if (!getSpectralCrossfadeEnabled()
+        || !convo::consumeAtomic(isPrepared, std::memory_order_acquire)) // acquire: prepareToPlay の publishAtomic release と HB
+        return false;
+
+    auto* liveEngine = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel/release と HB
+    if (liveEngine == nullptr || !liveEngine->canSpectralCrossfadeTo(*newEngine))
+        return false;
+
+    const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay / commit の release と HB
+    if (sr <= 0.0)
+        return false;
+
+    const int fadeSamples = juce::roundToInt(sr * SPECTRAL_CROSSFADE_SEC);
+    if (!liveEngine->beginSpectralCrossfadeTo(newEngine, fadeSamples))
+        return false;  // 片チャンネルのみ開始済みでも、呼び出し元の通常交換で liveEngine ごと retire される
+
+    const double fadeMs = 1000.0 * static_cast<double>(liveEngine->getSpectralCrossfadeLengthSamples()) / sr;
+    liveEngine->spectralFadeDeadlineMs = juce::Time::getMillisecondCounter()
+                                       + static_cast<uint32_t>(fadeMs) + SPECTRAL_CROSSFADE_TIMEOUT_MARGIN_MS;
+    return true;
+}
+
+void ConvolverProcessor::pollSpectralCrossfade() noexcept
+{
+    auto* liveEngine = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel/release と HB
+    if (liveEngine == nullptr || liveEngine->spectralFadeTarget == nullptr)
+        return;
+
+    if (liveEngine->isSpectralCrossfadeComplete())
+    {
+        liveEngine->commitSpectralCrossfade();
+        return;
+    }
+
+    // 期限切れ: Audio Thread が本エンジンを処理していない (UI 用インスタンス等)。フェード先を通常交換で公開する
+    if (static_cast<int32_t>(juce::Time::getMillisecondCounter() - liveEngine->spectralFadeDeadlineMs) >= 0)
+        swapActiveEngineOnMessageThread(liveEngine->detachSpectralFadeTarget());
+}
+
+// ────────────────────────────────────────────────────────────────
+// IR bus ゲイン (Message Thread のみ)
+//   稼働中エンジンが spectral bus を保持していれば、合成し直したスペクトルへ IR_BUS_GAIN_FADE_SEC で
+//   フェードする (再構築なし)。フェード中の変更は完了後にまとめて再適用する。フェードを開始できない場合と
+//   期限切れの場合は、最新ゲインで作った複製と通常交換する。
+// ────────────────────────────────────────────────────────────────
+bool ConvolverProcessor::setIrBusGainDb(int index, float gainDb)
+{
+    jassert (juce::MessageManager::getInstance()->isThisTheMessageThread());
+
+    const float clamped = juce::jlimit(IR_BUS_GAIN_MIN_DB, IR_BUS_GAIN_MAX_DB, gainDb);
+    bool changed = false;
+    {
+        pendingOverrideLock.enter();
+        if (index >= 0 && index < pendingOverride.irBusCount)
+        {
+            auto& entry = pendingOverride.irBus[static_cast<size_t>(index)];
+            changed = (entry.gainDb != clamped);
+            entry.gainDb = clamped;
+        }
+        pendingOverrideLock.exit();
+    }
+    if (!changed)
+        return true;
+
+    // 焼き込み済み / 未構築のエンジンでは構造ハッシュにゲインが含まれ、通知経由の rebuild で反映される
+    const bool live = applyIrBusGains();
+    postCoalescedChangeNotification();
+    return live;
+}
+
+void ConvolverProcessor::readIrBusGains(const StereoConvolver& engine, double* gains) const
+{
+    const juce::ScopedLock lock(pendingOverrideLock);
+    for (int i = 0; i < engine.irBusCount; ++i)
+    {
+        const int entry = engine.irBusEntryIndex[i];
+        gains[i] = (entry >= 0 && entry < pendingOverride.irBusCount)
+                 ? convo::irBusGainFromDb(pendingOverride.irBus[static_cast<size_t>(entry)].gainDb)
+                 : 0.0;
+    }
+}
+
+bool ConvolverProcessor::replaceEngineForIrBusGains(StereoConvolver* liveEngine)
+{
+    readIrBusGains(*liveEngine, liveEngine->irBusGains);   // clone は irBusGains で bus を付け直す
+    auto* replacement = liveEngine->clone();
+    if (replacement == nullptr)
+        return false;
+    swapActiveEngineOnMessageThread(replacement);
+    return true;
+}
+
+bool ConvolverProcessor::applyIrBusGains()
+{
+    auto* liveEngine = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel/release と HB
+    if (liveEngine == nullptr || !liveEngine->isIrBusLive())
+        return false;
+
+    if (liveEngine->irBusFadeDeadlineMs != 0)
+    {
+        irBusGainsPending = true;
+        return true;
+    }
+    irBusGainsPending = false;
+
+    double gains[kMaxIrBusEntries] {};
+    readIrBusGains(*liveEngine, gains);
+    if (std::equal(gains, gains + liveEngine->irBusCount, liveEngine->irBusGains))
+        return true;
+
+    const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay / commit の release と HB
+    if (sr <= 0.0 || !convo::consumeAtomic(isPrepared, std::memory_order_acquire))    // acquire: prepareToPlay の publishAtomic release と HB
+        return replaceEngineForIrBusGains(liveEngine);   // Audio Thread が回っていないためフェードは進まない
+
+    if (!liveEngine->beginIrBusGains(gains, juce::roundToInt(sr * IR_BUS_GAIN_FADE_SEC)))
+        return replaceEngineForIrBusGains(liveEngine);   // 片チャンネルのみ開始済みでも liveEngine ごと retire される
+
+    const double fadeMs = 1000.0 * static_cast<double>(liveEngine->getSpectralCrossfadeLengthSamples()) / sr;
+    const uint32_t deadline = juce::Time::getMillisecondCounter()
+                            + static_cast<uint32_t>(fadeMs) + SPECTRAL_CROSSFADE_TIMEOUT_MARGIN_MS;
+    liveEngine->irBusFadeDeadlineMs = juce::jmax<uint32_t>(1, deadline);   // 0 は「フェードなし」
+    return true;
+}
+
+void ConvolverProcessor::pollIrBusFade()
+{
+    auto* liveEngine = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel/release と HB
+    if (liveEngine == nullptr || liveEngine->irBusFadeDeadlineMs == 0)
+    {
+        irBusGainsPending = false;   // 新しいエンジンは構築時のゲインを使っている
+        return;
+    }
+
+    if (liveEngine->isIrBusFadeComplete())
+    {
+        liveEngine->commitIrBusFade();
+        if (std::exchange(irBusGainsPending, false))
+            applyIrBusGains();
+        return;
+    }
+
+    if (static_cast<int32_t>(juce::Time::getMillisecondCounter() - liveEngine->irBusFadeDeadlineMs) >= 0)
+    {
+        irBusGainsPending = false;
+        replaceEngineForIrBusGains(liveEngine);
+    }
+}
+
 // PendingCommit のコミット実行（Message Thread のみで呼び出し）
 void ConvolverProcessor::executePendingCommit(std::unique_ptr<PendingCommit> commit)
 {
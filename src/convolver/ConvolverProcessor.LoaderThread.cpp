@@ -3,9 +3,15 @@
 #include "audioengine/AudioEngine.h"
 #include "convolver/ConvolverProcessor.Internal.h"
 #include "AlignedAllocation.h"
+#include "ResampledIRCache.h"
+#include "StandbyIRPool.h"
+#include "MappedIRReader.h"
+#include "IrBusShaping.h"
 #include <mkl.h>
 
 #include "audioengine/AtomicAccess.h"
+#include "core/TimeUtils.h"
+#include "EtwTrace.h"
 
 #if defined(CONVOPEQ_ENABLE_CONVOLVER_SPLIT_LOADER_THREAD)
 
@@ -45,6 +51,12 @@ void ConvolverProcessor::LoaderThread::run()
 
     vmlSetMode(VML_FTZDAZ_ON | VML_ERRMODE_IGNORE);
 
+    // 読み込みの間は共有スケジューラに申告し、アップグレード変換・学習より先にコアを使う
+    auto* schedulerProvider = owner.getRcuProvider();
+    const convo::BackgroundScheduler::ActivityScope loadActivity(
+        schedulerProvider != nullptr ? &schedulerProvider->getBackgroundScheduler() : nullptr,
+        convo::BackgroundPriority::IRLoad);
+
     struct FlagResetter {
         ConvolverProcessor& p;
         juce::WeakReference<ConvolverProcessor> weakP;
@@ -104,17 +116,20 @@ ConvolverProcessor::LoaderThread::LoadResult ConvolverProcessor::LoaderThread::p
         };
     }
 
-    stepCurrentThread = thread;
-    stepState = StepState::LoadIR;
-    stepResult = LoadResult{};
-    stepTrimmed.setSize(0, 0);
-    stepFileHash = 0;
+    resetSteps(thread);
 
     try
     {
         while (true)
         {
+            // ★ ETW: ステップごとに所要時間と成否を出す (WPA で IR ロードのどこが長いかを見る)
+            const bool etwIrLoad = convo::EtwTrace::isEnabled(convo::EtwTrace::kIrLoad);
+            const StepState stepBefore = stepState;
+            const uint64_t stepStartUs = etwIrLoad ? convo::getCurrentTimeUs() : 0;
             const bool terminal = stepOnce();
+            if (etwIrLoad)
+                convo::EtwTrace::irLoadPhase(stepStateName(stepBefore), stepState != StepState::Error,
+                                             convo::getCurrentTimeUs() - stepStartUs);
             if (terminal) break;
         }
     }
@@ -139,6 +154,103 @@ ConvolverProcessor::LoaderThread::LoadResult ConvolverProcessor::LoaderThread::p
     return std::move(stepResult);
 }
 
+void ConvolverProcessor::LoaderThread::resetSteps(juce::Thread* thread)
+{
+    stepCurrentThread = thread;
+    stepState = StepState::LoadIR;
+    stepResult = LoadResult{};
+    stepTrimmed.setSize(0, 0);
+    stepFileHash = 0;
+    stepSourceCRC = 0;
+    stepFromStandby = false;
+}
+
+bool ConvolverProcessor::LoaderThread::prebuildStandby()
+{
+    juce::ScopedNoDenormals noDenormals;
+    resetSteps(nullptr);
+
+    try
+    {
+        if (stepOnce() || stepSourceCRC == 0)
+            return false;
+
+        const uint64_t key = StandbyIRPool::makeKey(stepSourceCRC, sampleRate, computeStandbySettingsHash());
+        auto& pool = StandbyIRPool::getInstance();
+        if (pool.contains(key))
+            return true;
+
+        while (stepState != StepState::Build)
+        {
+            if (stepOnce())
+                return false;
+        }
+
+        auto entry = std::make_unique<StandbyIR>();
+        entry->key = key;
+        entry->sampleRate = stepResult.loadedSR;
+        entry->targetLength = stepResult.targetLength;
+        entry->loadedIR = std::move(stepResult.loadedIR);
+        entry->trimmed = std::move(stepTrimmed);
+        pool.store(std::move(entry));
+    }
+    catch (const std::exception& e)
+    {
+        juce::Logger::writeToLog("LoaderThread: standby prebuild failed: " + juce::String(e.what()));
+        return false;
+    }
+
+    juce::Logger::writeToLog("LoaderThread: standby IR prebuilt for " + juce::String(sampleRate, 1) + " Hz");
+    return true;
+}
+
+uint64_t ConvolverProcessor::LoaderThread::computeStandbySettingsHash() const
+{
+    // Trim / Transform の結果を左右する設定のみ (NUC / Tail 設定は Build 側で反映される)
+    auto combine = [](uint64_t seed, uint64_t value) noexcept
+    {
+        return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+    };
+    auto floatBits = [](float value) noexcept
+    {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(float));
+        return static_cast<uint64_t>(bits);
+    };
+
+    uint64_t seed = static_cast<uint64_t>(phaseMode) + 1;
+    seed = combine(seed, static_cast<uint64_t>(owner.getResamplingPhaseMode()));
+    seed = combine(seed, floatBits(buildSnapshot.targetIRLengthSec));
+    if (phaseMode == ConvolverProcessor::PhaseMode::Mixed)
+    {
+        seed = combine(seed, floatBits(mixedTransitionStartHz));
+        seed = combine(seed, floatBits(mixedTransitionEndHz));
+    }
+    return seed;
+}
+
+bool ConvolverProcessor::LoaderThread::tryConsumeStandby()
+{
+    if (stepSourceCRC == 0)
+        return false;
+
+    const auto standby = StandbyIRPool::getInstance().find(
+        StandbyIRPool::makeKey(stepSourceCRC, sampleRate, computeStandbySettingsHash()));
+    if (standby == nullptr
+        || standby->targetLength != owner.computeTargetIRLength(standby->sampleRate, standby->loadedIR.getNumSamples()))
+        return false;
+
+    stepResult.loadedIR = standby->loadedIR;
+    stepResult.loadedSR = standby->sampleRate;
+    stepResult.targetLength = standby->targetLength;
+    stepResult.scaleFactor = this->scaleFactor;
+    stepTrimmed = standby->trimmed;
+    stepFromStandby = true;
+
+    juce::Logger::writeToLog("LoaderThread: rebuild uses standby IR for " + juce::String(sampleRate, 1) + " Hz");
+    return true;
+}
+
 int ConvolverProcessor::LoaderThread::estimatePeakLatencySamples(const juce::AudioBuffer<double>& trimmed, int targetLength) const
 {
     int irPeakLatency = 0;
@@ -208,13 +320,74 @@ bool ConvolverProcessor::LoaderThread::buildConvolverFromTrimmed(LoadResult& res
 
     const int irPeakLatency = estimatePeakLatencySamples(trimmed, result.targetLength);
 
+    // ★ True-stereo: 4ch IR は ch0=LL / ch3=RR を直接パス、ch2=RL / ch1=LR をクロスパスとする
+    convo::ScopedAlignedPtr<double> crossRL;
+    convo::ScopedAlignedPtr<double> crossLR;
+    ConvolverProcessor::extractTrueStereoCross(trimmed, result.targetLength, buildSnapshot, crossRL, crossLR);
+    const bool trueStereo = static_cast<bool>(crossRL);
+
+    // ★ IR bus: 追加 IR を整形する。主 IR より長ければ IR 長を延ばす (True-stereo はクロスパスと長さを揃えるため延ばさない)
+    const int primaryLength = result.targetLength;
+    auto irBus = prepareIrBus(sr, result.targetLength, !trueStereo, thread);
+    if ((buildSnapshot.irBusCount > 0 || buildSnapshot.spectralMorphFile != juce::File())
+        && thread != nullptr && thread->threadShouldExit())
+        return false;
+
     auto irL = convo::makeAlignedArray<double>(static_cast<size_t>(result.targetLength));
     auto irR = convo::makeAlignedArray<double>(static_cast<size_t>(result.targetLength));
 
     const double* srcL = trimmed.getReadPointer(0);
-    const double* srcR = (trimmed.getNumChannels() > 1) ? trimmed.getReadPointer(1) : srcL;
-    std::memcpy(irL.get(), srcL, result.targetLength * sizeof(double));
-    std::memcpy(irR.get(), srcR, result.targetLength * sizeof(double));
+    const double* srcR = trueStereo ? trimmed.getReadPointer(3)
+                       : (trimmed.getNumChannels() > 1) ? trimmed.getReadPointer(1) : srcL;
+    std::memcpy(irL.get(), srcL, primaryLength * sizeof(double));
+    std::memcpy(irR.get(), srcR, primaryLength * sizeof(double));
+    if (result.targetLength > primaryLength)
+    {
+        std::memset(irL.get() + primaryLength, 0, static_cast<size_t>(result.targetLength - primaryLength) * sizeof(double));
+        std::memset(irR.get() + primaryLength, 0, static_cast<size_t>(result.targetLength - primaryLength) * sizeof(double));
+    }
+
+    // ★ IR bus: spectral bus を持てない構成 (True-stereo / Direct Head) は主 IR の直接パスへ加算して焼き込む。
+    //   モーフ先も接続できない構成のため捨てる (主 IR のみ)
+    if (irBus != nullptr && (trueStereo || owner.getZeroLatencyHeadEnabled()))
+    {
+        for (int i = 0; i < irBus->count; ++i)
+        {
+            juce::FloatVectorOperations::addWithMultiply(irL.get(), irBus->data[i][0].get(), irBus->gains[i], result.targetLength);
+            juce::FloatVectorOperations::addWithMultiply(irR.get(), irBus->data[i][1].get(), irBus->gains[i], result.targetLength);
+        }
+        result.irBusBaked = (irBus->count > 0);
+        irBus.reset();
+    }
+
+    // ★ EQ fold: 静的・線形な EQ を直接パス/クロスパスの IR へ焼き込む (DSPCore 側は EQ 段をスキップする)。
+    //   IR 長は targetLength のまま (EQ の IIR 応答は IR 末尾で打ち切られる)。
+    result.eqFolded = buildSnapshot.eqFoldEnabled
+                   && EQProcessor::isFoldableIntoIR(buildSnapshot.eqFoldParams, trueStereo);
+    if (result.eqFolded)
+    {
+        const auto& eqParams = buildSnapshot.eqFoldParams;
+        EQProcessor::applyStaticResponse(eqParams, sr, 0, irL.get(), result.targetLength);
+        EQProcessor::applyStaticResponse(eqParams, sr, 1, irR.get(), result.targetLength);
+        if (trueStereo)
+        {
+            // True-stereo は Stereo バンドのみ許可しているため channel 指定は結果に影響しない
+            EQProcessor::applyStaticResponse(eqParams, sr, 0, crossRL.get(), result.targetLength);
+            EQProcessor::applyStaticResponse(eqParams, sr, 1, crossLR.get(), result.targetLength);
+        }
+        // 合成スペクトルが Σ g·(EQ·H) になるよう、接続する追加 IR・モーフ先にも同じ応答を掛ける
+        for (int i = 0; irBus != nullptr && i < irBus->count; ++i)
+        {
+            EQProcessor::applyStaticResponse(eqParams, sr, 0, irBus->data[i][0].get(), result.targetLength);
+            EQProcessor::applyStaticResponse(eqParams, sr, 1, irBus->data[i][1].get(), result.targetLength);
+        }
+        if (irBus != nullptr && irBus->hasMorph())
+        {
+            EQProcessor::applyStaticResponse(eqParams, sr, 0, irBus->morph[0].get(), result.targetLength);
+            EQProcessor::applyStaticResponse(eqParams, sr, 1, irBus->morph[1].get(), result.targetLength);
+        }
+    }
+    result.irBus = std::move(irBus);
 
     const int internalBlockSize = juce::nextPowerOfTwo(bs);
 
@@ -224,6 +397,14 @@ bool ConvolverProcessor::LoaderThread::buildConvolverFromTrimmed(LoadResult& res
         result.displayIR.applyGain(result.scaleFactor);
     }
 
+    // ★ Layout wisdom: 未計測の構成はここ (Loader Thread) で一度だけ計測して永続化する。
+    //   以降の構築 (Message Thread の finalize を含む) は計測結果を参照するだけ。
+    if (thread == nullptr || !thread->threadShouldExit())
+    {
+        convo::FilterSpec calibrationSpec = makeFilterSpec(sr, trueStereo);
+        owner.applyLayoutWisdom(calibrationSpec, buildSnapshot, result.targetLength, internalBlockSize, true);
+    }
+
     if (thread == nullptr)
         return initializeConvolverSynchronously(result,
                                                 std::move(irL),
@@ -231,7 +412,9 @@ bool ConvolverProcessor::LoaderThread::buildConvolverFromTrimmed(LoadResult& res
                                                 sr,
                                                 irPeakLatency,
                                                 internalBlockSize,
-                                                bs);
+                                                bs,
+                                                std::move(crossRL),
+                                                std::move(crossLR));
 
     return queueFinalizeOnMessageThread(result,
                                         std::move(irL),
@@ -239,19 +422,13 @@ bool ConvolverProcessor::LoaderThread::buildConvolverFromTrimmed(LoadResult& res
                                         sr,
                                         irPeakLatency,
                                         internalBlockSize,
-                                        bs);
+                                        bs,
+                                        std::move(crossRL),
+                                        std::move(crossLR));
 }
 
-bool ConvolverProcessor::LoaderThread::initializeConvolverSynchronously(LoadResult& result,
-                                                                         convo::ScopedAlignedPtr<double> irL,
-                                                                         convo::ScopedAlignedPtr<double> irR,
-                                                                         double sr,
-                                                                         int irPeakLatency,
-                                                                         int internalBlockSize,
-                                                                         int callBlockSize)
+convo::FilterSpec ConvolverProcessor::LoaderThread::makeFilterSpec(double sr, bool trueStereo) const
 {
-    auto newConv = convo::aligned_make_unique<StereoConvolver>();
-
     convo::FilterSpec spec;
     spec.sampleRate = sr;
     {
@@ -265,12 +442,182 @@ bool ConvolverProcessor::LoaderThread::initializeConvolverSynchronously(LoadResu
         spec.tailStrength = static_cast<double>(buildSnapshot.tailStrength);
         spec.tailL1L2Multiplier = buildSnapshot.tailL1L2Multiplier;
     }
+    owner.applyTailLayerPolicy(spec, buildSnapshot);
+    if (trueStereo)
+    {
+        spec.tailWorkerOffload = false;   // ★ True-stereo: クロスパスは相手 FDL を参照するため Tail Worker と排他
+        spec.compactTailSpectra = false;  // ★ True-stereo: クロスパスカーネルは double のみ
+        spec.tailDecimation = 1;          // ★ True-stereo: Multirate tail と排他
+        spec.partitionCullFloorDb = convo::FilterSpec::kPartitionCullDisabledDb;  // ★ True-stereo: クロス IR と構成を揃えるため間引き無効
+        spec.farTailHorizonSeconds = 0.0;  // ★ True-stereo: 4 項融合カーネルは常駐判定を持たない
+        spec.spectrumLayout = convo::FilterSpec::SpectrumLayout::PartitionMajor;  // ★ True-stereo: 4 項融合カーネルはパーティション優先配置のみ
+    }
+    return spec;
+}
+
+std::shared_ptr<ConvolverProcessor::IrBusSources> ConvolverProcessor::LoaderThread::prepareIrBus(double sr, int& length, bool canExtend,
+                                                                                                  juce::Thread* thread)
+{
+    const bool wantsMorph = (buildSnapshot.spectralMorphFile != juce::File());
+    if ((buildSnapshot.irBusCount <= 0 && !wantsMorph) || sr <= 0.0 || length <= 0)
+        return nullptr;
+
+    const auto shouldStop = [this, thread]() -> bool {
+        return (thread != nullptr && thread->threadShouldExit())
+            || (externalCancellationCheck && externalCancellationCheck());
+    };
+    const r8b::EDSPFilterPhaseResponse r8bPhase =
+        (owner.getResamplingPhaseMode() == ResamplingPhaseMode::Linear)
+            ? r8b::fprLinearPhase : r8b::fprMinPhase;
+
+    // 追加 IR・モーフ先は録音どおりに使う (位相モード変換・自動トリム・正規化は主 IR のみ。レベルは主 IR の scale に従う)
+    // @return false=読み込めない (キャンセル時も false。呼び出し側が shouldStop で区別する)
+    const auto loadFile = [&](const juce::File& file, juce::AudioBuffer<double>& ir) -> bool {
+        double fileSampleRate = 0.0;
+        juce::String error;
+        if (!readIRFileInto(file, ir, fileSampleRate, error) || ir.getNumSamples() == 0)
+        {
+            juce::Logger::writeToLog("LoaderThread: IR bus entry skipped: " + (error.isNotEmpty() ? error : file.getFileName()));
+            return false;
+        }
+
+        if (fileSampleRate > 0.0 && std::abs(fileSampleRate - sr) > 1e-6)
+        {
+            auto resampled = ConvolverProcessorInternal::resampleIR(ir, fileSampleRate, sr, r8bPhase, shouldStop);
+            if (resampled.result == ConvolverProcessorInternal::ResampleResult::Cancelled)
+                return false;
+            if (resampled.result != ConvolverProcessorInternal::ResampleResult::Success)
+            {
+                juce::Logger::writeToLog("LoaderThread: IR bus entry skipped (resampling failed): " + file.getFileName());
+                return false;
+            }
+            ir = std::move(resampled.buffer);
+        }
+
+        for (int ch = 0; ch < ir.getNumChannels(); ++ch)
+        {
+            convo::UltraHighRateDCBlocker dcBlocker;
+            dcBlocker.init(sr, 1.0);
+            dcBlocker.process(ir.getWritePointer(ch), ir.getNumSamples());
+        }
+        return true;
+    };
+
+    struct LoadedEntry
+    {
+        juce::AudioBuffer<double> ir;
+        convo::IrBusShape shape;
+        int entryIndex = 0;
+    };
+    std::vector<LoadedEntry> loaded;
+    int shapedLength = 0;
+    const int count = juce::jmin(buildSnapshot.irBusCount, kMaxIrBusEntries);
+    for (int i = 0; i < count; ++i)
+    {
+        if (shouldStop())
+            return nullptr;
+
+        const auto& entry = buildSnapshot.irBus[static_cast<size_t>(i)];
+        LoadedEntry item;
+        if (!loadFile(entry.file, item.ir))
+        {
+            if (shouldStop())
+                return nullptr;
+            continue;
+        }
+
+        item.shape = convo::makeIrBusShape(entry.preDelayMs, entry.tailSec, entry.tailFadeMs, sr);
+        item.entryIndex = i;
+        shapedLength = juce::jmax(shapedLength, convo::irBusShapedLength(item.shape, item.ir.getNumSamples()));
+        loaded.push_back(std::move(item));
+    }
+
+    // ★ Spectral morph: モーフ先は整形なし (pre-delay 0・全長) で同じ長さに揃える
+    juce::AudioBuffer<double> morphIR;
+    bool hasMorph = false;
+    if (wantsMorph)
+    {
+        if (shouldStop())
+            return nullptr;
+        hasMorph = loadFile(buildSnapshot.spectralMorphFile, morphIR);
+        if (!hasMorph && shouldStop())
+            return nullptr;
+        if (hasMorph)
+            shapedLength = juce::jmax(shapedLength, morphIR.getNumSamples());
+    }
+    if (loaded.empty() && !hasMorph)
+        return nullptr;
+
+    if (canExtend && shapedLength > length)
+    {
+        const int maxLength = static_cast<int>(static_cast<double>(owner.getMaximumAllowedIRLengthSec(sr)) * sr);
+        length = juce::jmax(length, juce::jmin(shapedLength, maxLength));
+    }
+
+    // 4ch (True-stereo 配列) は直接パス ch0 / ch3、モノラルは両チャンネルへ同じ IR
+    const auto shapeInto = [length](const juce::AudioBuffer<double>& ir, const convo::IrBusShape& shape,
+                                    convo::ScopedAlignedArray<double> (&dst)[2]) {
+        const int numChannels = ir.getNumChannels();
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto data = convo::makeAlignedArray<double>(static_cast<size_t>(length));
+            std::memset(data.get(), 0, static_cast<size_t>(length) * sizeof(double));
+            const int srcCh = (ch == 0) ? 0 : (numChannels >= 4) ? 3 : (numChannels > 1) ? 1 : 0;
+            convo::accumulateIrBus(data.get(), length, ir.getReadPointer(srcCh), ir.getNumSamples(), shape, 1.0);
+            dst[ch] = std::move(data);
+        }
+    };
+
+    auto irBus = std::make_shared<IrBusSources>();
+    for (const auto& item : loaded)
+    {
+        const int slot = irBus->count;
+        shapeInto(item.ir, item.shape, irBus->data[slot]);
+        irBus->gains[slot] = convo::irBusGainFromDb(buildSnapshot.irBus[static_cast<size_t>(item.entryIndex)].gainDb);
+        irBus->entryIndex[slot] = item.entryIndex;
+        irBus->count = slot + 1;
+    }
+    if (hasMorph)
+        shapeInto(morphIR, convo::IrBusShape {}, irBus->morph);
+    return irBus;
+}
+
+bool ConvolverProcessor::LoaderThread::initializeConvolverSynchronously(LoadResult& result,
+                                                                         convo::ScopedAlignedPtr<double> irL,
+                                                                         convo::ScopedAlignedPtr<double> irR,
+                                                                         double sr,
+                                                                         int irPeakLatency,
+                                                                         int internalBlockSize,
+                                                                         int callBlockSize,
+                                                                         convo::ScopedAlignedPtr<double> crossRL,
+                                                                         convo::ScopedAlignedPtr<double> crossLR)
+{
+    auto newConv = convo::aligned_make_unique<StereoConvolver>();
+    const bool trueStereo = static_cast<bool>(crossRL) && static_cast<bool>(crossLR);
+
+    convo::FilterSpec spec = makeFilterSpec(sr, trueStereo);
+    owner.applyLayoutWisdom(spec, buildSnapshot, result.targetLength, internalBlockSize, false);
+
+    // ★ Shared spectra: 外部の共有元 (setExternalSpectraDonor) と IR・パラメータが一致すれば IR スペクトルを共有する
+    const StereoConvolver* spectraDonor = (owner.externalSpectraDonor != nullptr)
+        ? owner.externalSpectraDonor->loadActiveEngine(std::memory_order_acquire) // acquire: exchangeActiveEngine acq_rel/release と HB
+        : nullptr;
+    // ★ NUMA replicas: 外部の共有元はオフラインワーカーの構築でのみ使う。ワーカーは自ノードの複製を読む
+    spec.replicateSpectraPerNode = (spectraDonor != nullptr);
+    if (result.irBus != nullptr)
+        ConvolverProcessor::applyIrBusCullLength(spec, irL.get(), irR.get(), result.targetLength, internalBlockSize, *result.irBus);
 
     if (newConv->init(irL.release(), irR.release(), result.targetLength, sr, irPeakLatency,
                              internalBlockSize, callBlockSize, result.scaleFactor,
-                             owner.getExperimentalDirectHeadEnabled(),
-                             &spec, &owner))
+                             trueStereo ? false : owner.getZeroLatencyHeadEnabled(),
+                             &spec, &owner, spectraDonor))
     {
+        if (trueStereo)
+            newConv->attachTrueStereoCross(crossRL.release(), crossLR.release());
+        newConv->eqFoldedIntoIR = result.eqFolded;
+        newConv->irBusBaked = result.irBusBaked;
+        if (auto irBus = std::exchange(result.irBus, nullptr); irBus != nullptr && !newConv->attachOrBakeIrBus(*irBus))
+            juce::Logger::writeToLog("LoaderThread: IR bus could not be attached; continuing with the main IR only.");
         result.newConv = newConv.release();
         result.success = true;
         return true;
@@ -287,12 +634,16 @@ bool ConvolverProcessor::LoaderThread::queueFinalizeOnMessageThread(LoadResult&
                                                                      double sr,
                                                                      int irPeakLatency,
                                                                      int internalBlockSize,
-                                                                     int callBlockSize)
+                                                                     int callBlockSize,
+                                                                     convo::ScopedAlignedPtr<double> crossRL,
+                                                                     convo::ScopedAlignedPtr<double> crossLR)
 {
     auto loadedIRRaw = new juce::AudioBuffer<double>(std::move(result.loadedIR));
     auto displayIRRaw = new juce::AudioBuffer<double>(std::move(result.displayIR));
     auto irLRaw = irL.release();
     auto irRRaw = irR.release();
+    auto crossRLRaw = crossRL.release();
+    auto crossLRRaw = crossLR.release();
 
     // ★ H-02: ラムダ内で unique_ptr / ScopedAlignedPtr にラップしているため、
     // weakOwner.get() が nullptr を返してもリソースは解放される。
@@ -301,6 +652,8 @@ bool ConvolverProcessor::LoaderThread::queueFinalizeOnMessageThread(LoadResult&
     const bool queued = juce::MessageManager::callAsync([weakOwner = this->weakOwner,
                                      irLRaw,
                                      irRRaw,
+                                     crossRLRaw,
+                                     crossLRRaw,
                                      loadedIRRaw,
                                      displayIRRaw,
                                      length = result.targetLength,
@@ -311,10 +664,15 @@ bool ConvolverProcessor::LoaderThread::queueFinalizeOnMessageThread(LoadResult&
                                      isReb = isRebuild,
                                      file = file,
                                      buildSnapshot = this->buildSnapshot,
-                                     scale = result.scaleFactor]()
+                                     scale = result.scaleFactor,
+                                     eqFolded = result.eqFolded,
+                                     irBus = std::exchange(result.irBus, nullptr),
+                                     irBusBaked = result.irBusBaked]()
     {
         convo::ScopedAlignedPtr<double> irLHolder(irLRaw);
         convo::ScopedAlignedPtr<double> irRHolder(irRRaw);
+        convo::ScopedAlignedPtr<double> crossRLHolder(crossRLRaw);
+        convo::ScopedAlignedPtr<double> crossLRHolder(crossLRRaw);
         std::unique_ptr<juce::AudioBuffer<double>> loadedIRHolder(loadedIRRaw);
         std::unique_ptr<juce::AudioBuffer<double>> displayIRHolder(displayIRRaw);
 
@@ -324,7 +682,9 @@ bool ConvolverProcessor::LoaderThread::queueFinalizeOnMessageThread(LoadResult&
                                                        std::move(irRHolder),
                                                        length, sr, peak, known, callQ, isReb, file,
                                                        buildSnapshot,
-                                                       scale, std::move(loadedIRHolder), std::move(displayIRHolder));
+                                                       scale, std::move(loadedIRHolder), std::move(displayIRHolder),
+                                                       std::move(crossRLHolder), std::move(crossLRHolder),
+                                                       eqFolded, irBus, irBusBaked);
         }
     });
 
@@ -332,6 +692,8 @@ bool ConvolverProcessor::LoaderThread::queueFinalizeOnMessageThread(LoadResult&
     {
         convo::aligned_free(irLRaw);
         convo::aligned_free(irRRaw);
+        if (crossRLRaw) convo::aligned_free(crossRLRaw);
+        if (crossLRRaw) convo::aligned_free(crossLRRaw);
         std::unique_ptr<juce::AudioBuffer<double>>{loadedIRRaw};  // RAII delete
         std::unique_ptr<juce::AudioBuffer<double>>{displayIRRaw}; // RAII delete
 
@@ -405,73 +767,143 @@ bool ConvolverProcessor::LoaderThread::stepOnce()
     return true;
 }
 
-bool ConvolverProcessor::LoaderThread::doLoadIRStep()
+bool ConvolverProcessor::LoaderThread::readIRFile(const juce::File& irFile)
 {
-    stepFileHash = 0;
-    if (!isRebuild && file.existsAsFile())
-        stepFileHash = convo::AllpassDesigner::computeIRHash(file);
+    return readIRFileInto(irFile, stepResult.loadedIR, stepResult.loadedSR, stepResult.errorMessage);
+}
 
-    if (isRebuild)
+bool ConvolverProcessor::LoaderThread::readIRFileInto(const juce::File& irFile, juce::AudioBuffer<double>& out,
+                                                      double& outSampleRate, juce::String& error)
+{
+    if (!irFile.existsAsFile())
     {
-        stepResult.loadedIR = std::move(sourceIR);
-        stepResult.loadedSR = sourceSampleRate;
-        stepResult.scaleFactor = this->scaleFactor;
+        error = "IR file not found: " + irFile.getFullPathName();
+        return false;
     }
-    else
+
+    // ★ 非圧縮 WAV / AIFF: マップから直接 double へ展開し、従来経路と同じ正規化 (NaN/デノーマル除去・±1 制限) を掛ける
+    double mappedSampleRate = 0.0;
+    if (convo::readMappedIR(irFile, out, mappedSampleRate))
     {
-        if (!file.existsAsFile())
-        {
-            stepResult.errorMessage = "IR file not found: " + file.getFullPathName();
-            return false;
-        }
+        for (int ch = 0; ch < out.getNumChannels(); ++ch)
+            convo::input_transform::applyHighQuality64BitTransform(out.getWritePointer(ch), out.getNumSamples());
+        outSampleRate = mappedSampleRate;
+        return true;
+    }
 
-        juce::AudioFormatManager formatManager;
-        formatManager.registerBasicFormats();
-        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
-        if (!reader)
-        {
-            stepResult.errorMessage = "Unsupported audio format or corrupted file: " + file.getFileName();
-            return false;
-        }
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(irFile));
+    if (!reader)
+    {
+        error = "Unsupported audio format or corrupted file: " + irFile.getFileName();
+        return false;
+    }
 
-        const int64 fileLength = reader->lengthInSamples;
-        const int numChannels = static_cast<int>(reader->numChannels);
-        static constexpr int64 MAX_FILE_LENGTH = 2147483647;
+    const int64 fileLength = reader->lengthInSamples;
+    const int numChannels = static_cast<int>(reader->numChannels);
+    static constexpr int64 MAX_FILE_LENGTH = 2147483647;
 
-        if (fileLength > MAX_FILE_LENGTH)
-        {
-            stepResult.errorMessage = "IR file is too large (exceeds 2GB samples limit).";
-            return false;
-        }
-        if (numChannels <= 0)
-        {
-            stepResult.errorMessage = "Invalid channel count in IR file.";
-            return false;
-        }
+    if (fileLength > MAX_FILE_LENGTH)
+    {
+        error = "IR file is too large (exceeds 2GB samples limit).";
+        return false;
+    }
+    if (numChannels <= 0)
+    {
+        error = "Invalid channel count in IR file.";
+        return false;
+    }
 
-        juce::AudioBuffer<float> tempFloatBuffer(numChannels, static_cast<int>(fileLength));
-        if (!reader->read(&tempFloatBuffer, 0, static_cast<int>(fileLength), 0, true, true))
-        {
-            stepResult.errorMessage = "Failed to read audio data from file.";
+    // ★ 圧縮形式などのデコードはブロック単位で読み、ブロックごとに double へ変換して打ち切りを確認する
+    //   (ファイル全体の float 一時バッファを持たず、新しいロードが来たら読み終わるのを待たずに抜ける)
+    constexpr int kDecodeBlockSamples = 1 << 16;
+    const int totalSamples = static_cast<int>(fileLength);
+    const int blockSamples = std::max(1, std::min(totalSamples, kDecodeBlockSamples));
+    juce::AudioBuffer<float> tempFloatBuffer(numChannels, blockSamples);
+    auto tempAligned = convo::makeAlignedArray<double>(static_cast<size_t>(blockSamples));
+    if (!tempAligned)
+    {
+        error = "Failed to allocate temporary buffer for IR loading.";
+        return false;
+    }
+
+    out.setSize(numChannels, totalSamples);
+    for (int offset = 0; offset < totalSamples; offset += blockSamples)
+    {
+        if (externalCancellationCheck && externalCancellationCheck())
             return false;
-        }
 
-        auto tempAligned = convo::makeAlignedArray<double>(static_cast<size_t>(fileLength));
-        if (!tempAligned)
+        const int count = std::min(blockSamples, totalSamples - offset);
+        if (!reader->read(&tempFloatBuffer, 0, count, offset, true, true))
         {
-            stepResult.errorMessage = "Failed to allocate temporary buffer for IR loading.";
+            error = "Failed to read audio data from file.";
             return false;
         }
-
-        stepResult.loadedIR.setSize(numChannels, static_cast<int>(fileLength));
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            const float* src = tempFloatBuffer.getReadPointer(ch);
             convo::input_transform::convertFloatToDoubleHighQuality(
-                src, tempAligned.get(), static_cast<int>(fileLength));
-            stepResult.loadedIR.copyFrom(ch, 0, tempAligned.get(), static_cast<int>(fileLength));
+                tempFloatBuffer.getReadPointer(ch), tempAligned.get(), count);
+            out.copyFrom(ch, offset, tempAligned.get(), count);
         }
-        stepResult.loadedSR = reader->sampleRate;
+    }
+    outSampleRate = reader->sampleRate;
+    return true;
+}
+
+bool ConvolverProcessor::LoaderThread::doLoadIRStep()
+{
+    stepFileHash = 0;
+    stepSourceCRC = 0;
+    if (!isRebuild && file.existsAsFile())
+        stepFileHash = convo::AllpassDesigner::computeIRHash(file);
+
+    if (isRebuild)
+    {
+        // ★ Resampled cache: サンプルレート変更を伴うリビルドは IRState (前レートで処理済み) を
+        //   再リサンプリングせず、元ファイルから読み直す。ファイル内容 CRC をキーに
+        //   ResampledIRCache が当たれば r8brain を経由せずに分割へ進める (多段リサンプリングも回避)。
+        if (std::abs(sourceSampleRate - sampleRate) > 1e-6)
+        {
+            juce::File sourceFile;
+            {
+                const juce::ScopedLock sl(owner.irFileLock);
+                sourceFile = owner.currentIrFile;
+            }
+            if (sourceFile.existsAsFile())
+            {
+                stepSourceCRC = ResampledIRCache::computeFileSourceCRC(sourceFile);
+
+                // ★ Hot standby: 事前計算済みなら Trim / Transform を省略して Build へ進む
+                if (tryConsumeStandby())
+                {
+                    sourceIR.setSize(0, 0);
+                    return true;
+                }
+
+                if (readIRFile(sourceFile)
+                    && stepResult.loadedIR.getNumSamples() > 0 && stepResult.loadedIR.getNumChannels() > 0)
+                {
+                    stepResult.scaleFactor = this->scaleFactor;
+                    sourceIR.setSize(0, 0);
+                    return true;
+                }
+                stepSourceCRC = 0;
+            }
+            stepResult.errorMessage.clear();  // 読み直し失敗時は従来どおり IRState から再構築
+        }
+
+        stepResult.loadedIR = std::move(sourceIR);
+        stepResult.loadedSR = sourceSampleRate;
+        stepResult.scaleFactor = this->scaleFactor;
+        if (std::abs(stepResult.loadedSR - sampleRate) > 1e-6)
+            stepSourceCRC = ResampledIRCache::computeBufferSourceCRC(stepResult.loadedIR, stepResult.loadedSR);
+    }
+    else
+    {
+        if (!readIRFile(file))
+            return false;
+        stepSourceCRC = ResampledIRCache::computeFileSourceCRC(file);
     }
 
     return (stepResult.loadedIR.getNumSamples() > 0 && stepResult.loadedIR.getNumChannels() > 0);
@@ -485,6 +917,9 @@ bool ConvolverProcessor::LoaderThread::doTrimStep()
 
     if (ConvolverProcessorInternal::checkCancellation(shouldStop, nullptr)) return false;
 
+    if (stepFromStandby)
+        return true;  // StandbyIRPool の loadedIR / stepTrimmed は Trim 済み
+
     if (stepResult.loadedIR.getNumSamples() > 0)
     {
         const int numSamples = stepResult.loadedIR.getNumSamples();
@@ -531,6 +966,17 @@ bool ConvolverProcessor::LoaderThread::doTrimStep()
                     { newLength = j + 1; break; }
                 }
             }
+
+            // ★ True-stereo (4ch): ch2/ch3 (RL/RR) の末尾を ch0/ch1 基準で切り落とさない
+            for (int ch = 2; ch < numChannels; ++ch)
+            {
+                const double* extra = stepResult.loadedIR.getReadPointer(ch);
+                for (int j = numSamples - 1; j >= newLength; --j)
+                {
+                    if (std::abs(extra[j]) > threshold)
+                    { newLength = j + 1; break; }
+                }
+            }
         }
         if (newLength < numSamples)
         {
@@ -547,12 +993,31 @@ bool ConvolverProcessor::LoaderThread::doTrimStep()
             (owner.getResamplingPhaseMode() == ResamplingPhaseMode::Linear)
                 ? r8b::fprLinearPhase : r8b::fprMinPhase;
 
-        auto resampleOut = ConvolverProcessorInternal::resampleIR(
-            stepResult.loadedIR, stepResult.loadedSR, sampleRate, r8bPhase,
-            [&]() -> bool {
-                return shouldStop() ||
-                       !owner.convolverStateGeneration.isCurrentGeneration(myGen);
-            });
+        // ★ Resampled cache: (ソース CRC, 目標レート, ResampleConfig) が一致すれば r8brain を省略
+        ResampleConfig resampleCfg;
+        resampleCfg.phase = r8bPhase;
+        auto& resampledCache = ResampledIRCache::getInstance();
+        const uint64_t resampledKey = (stepSourceCRC != 0)
+            ? ResampledIRCache::computeKey(stepSourceCRC, sampleRate, resampleCfg)
+            : 0;
+
+        juce::AudioBuffer<double> cachedIR;
+        ConvolverProcessorInternal::ResampleOutput resampleOut { {}, ConvolverProcessorInternal::ResampleResult::Error };
+        bool fromCache = false;
+        if (resampledKey != 0 && resampledCache.load(resampledKey, sampleRate, cachedIR))
+        {
+            resampleOut = { std::move(cachedIR), ConvolverProcessorInternal::ResampleResult::Success };
+            fromCache = true;
+        }
+        else
+        {
+            resampleOut = ConvolverProcessorInternal::resampleIR(
+                stepResult.loadedIR, stepResult.loadedSR, sampleRate, r8bPhase,
+                [&]() -> bool {
+                    return shouldStop() ||
+                           !owner.convolverStateGeneration.isCurrentGeneration(myGen);
+                });
+        }
 
         if (!owner.convolverStateGeneration.isCurrentGeneration(myGen))
             return false;
@@ -560,6 +1025,8 @@ bool ConvolverProcessor::LoaderThread::doTrimStep()
         switch (resampleOut.result)
         {
             case ConvolverProcessorInternal::ResampleResult::Success:
+                if (resampledKey != 0 && !fromCache)
+                    resampledCache.save(resampledKey, sampleRate, resampleOut.buffer);
                 stepResult.loadedIR = std::move(resampleOut.buffer);
                 stepResult.loadedSR = sampleRate;
                 break;
@@ -651,8 +1118,9 @@ bool ConvolverProcessor::LoaderThread::doTransformStep()
         return maxAbs > 1.0e-12;
     };
 
-    if (phaseMode == ConvolverProcessor::PhaseMode::Minimum ||
-        phaseMode == ConvolverProcessor::PhaseMode::Mixed)
+    if (!stepFromStandby &&
+        (phaseMode == ConvolverProcessor::PhaseMode::Minimum ||
+         phaseMode == ConvolverProcessor::PhaseMode::Mixed))
     {
         bool wasCancelled = false;
         auto minPhaseIR = ConvolverProcessorInternal::convertToMinimumPhase(stepTrimmed, shouldStop, &wasCancelled);
@@ -667,7 +1135,7 @@ bool ConvolverProcessor::LoaderThread::doTransformStep()
             else
             {
                 bool mixedCancelled = false;
-                auto progressCb = [this](float p) { owner.setLoadingProgress(p); };
+                auto progressCb = [this](float p) { if (reportLoadingProgress) owner.setLoadingProgress(p); };
                 auto mixedIR = convertToMixedPhase(&owner, stepFileHash, stepTrimmed, minPhaseIR,
                                                    sampleRate,
                                                    static_cast<double>(mixedTransitionStartHz),
@@ -687,7 +1155,7 @@ bool ConvolverProcessor::LoaderThread::doTransformStep()
         const IRState* currentState = owner.acquireIRState();
         auto currentIr = (currentState != nullptr) ? currentState->ir : nullptr;
         const double currentScale = convo::consumeAtomic(owner.currentIRScale, std::memory_order_acquire); // acquire: applyNewState の publishAtomic release と HB
-        const auto scaleInfo = IRConverter::computeScaleFactor(stepTrimmed, currentIr, currentScale);
+        const auto scaleInfo = IRConverter::computeScaleFactor(stepTrimmed, currentIr, currentScale, headEnergyRatio);
         owner.releaseIRState(currentState);
 
         stepResult.scaleFactor = scaleInfo.hasScaleFactor ? scaleInfo.scaleFactor : 1.0;
@@ -12,6 +12,8 @@ public:
     ~LoaderThread() override;
 
     std::function<bool()> externalCancellationCheck;
+    bool reportLoadingProgress = true;  // false: Standby 事前計算 (UI の進捗表示を動かさない)
+    double headEnergyRatio = 1.0;       // IRState::headEnergyRatio (先頭だけの IR でも全長基準の scale にする)
 
     struct LoadResult
     {
@@ -23,6 +25,9 @@ public:
         bool success = false;
         bool finalizeQueued = false;
         double scaleFactor = 1.0;
+        bool eqFolded = false;  // ★ EQ fold: IR へ静的 EQ を焼き込んだか
+        std::shared_ptr<IrBusSources> irBus;  // ★ IR bus: spectral bus で接続する追加 IR (nullptr=なし / 焼き込み済み)
+        bool irBusBaked = false;              // ★ IR bus: 追加 IR を主 IR へ時間領域で加算済み
         juce::String errorMessage;
     };
 
@@ -42,7 +47,9 @@ public:
                                           double sr,
                                           int irPeakLatency,
                                           int internalBlockSize,
-                                          int callBlockSize);
+                                          int callBlockSize,
+                                          convo::ScopedAlignedPtr<double> crossRL,
+                                          convo::ScopedAlignedPtr<double> crossLR);
 
     bool queueFinalizeOnMessageThread(LoadResult& result,
                                       convo::ScopedAlignedPtr<double> irL,
@@ -50,17 +57,47 @@ public:
                                       double sr,
                                       int irPeakLatency,
                                       int internalBlockSize,
-                                      int callBlockSize);
+                                      int callBlockSize,
+                                      convo::ScopedAlignedPtr<double> crossRL,
+                                      convo::ScopedAlignedPtr<double> crossLR);
+
+    // FilterSpec 構築 (initializeConvolverSynchronously / Layout wisdom 計測で共有)
+    convo::FilterSpec makeFilterSpec(double sr, bool trueStereo) const;
+
+    // ★ IR bus: buildSnapshot.irBus を読み込み、sr へリサンプリングして整形する。
+    //   length は主 IR の長さで渡し、canExtend なら追加 IR の整形後の長さまで (IR 長の上限内で) 延ばして返す。
+    //   buildSnapshot.spectralMorphFile (モーフ先) も同じ手順で morph へ整形する。
+    //   読めなかったエントリは飛ばす (主 IR の読み込みは失敗させない)。1 本も残らなければ nullptr
+    std::shared_ptr<IrBusSources> prepareIrBus(double sr, int& length, bool canExtend, juce::Thread* thread);
 
     void runSynchronously();
 
+    // ★ Hot standby: Build 手前 (Transform 完了) まで実行し、結果を StandbyIRPool に格納する
+    bool prebuildStandby();
+
     enum class StepState { LoadIR, Trim, Transform, Build, Done, Error };
 
+    static constexpr const char* stepStateName(StepState state) noexcept
+    {
+        switch (state)
+        {
+            case StepState::LoadIR:    return "LoadIR";
+            case StepState::Trim:      return "Trim";
+            case StepState::Transform: return "Transform";
+            case StepState::Build:     return "Build";
+            case StepState::Done:      return "Done";
+            case StepState::Error:     return "Error";
+        }
+        return "?";
+    }
+
     StepState stepState { StepState::LoadIR };
     LoadResult stepResult;
     juce::AudioBuffer<double> stepTrimmed;
     uint64_t stepFileHash { 0 };
+    uint64_t stepSourceCRC { 0 };  // ResampledIRCache のソース内容 CRC (0 = キャッシュ不使用)
     juce::Thread* stepCurrentThread = nullptr;
+    bool stepFromStandby { false };  // StandbyIRPool から復元済み (Trim / 位相変換を省略)
 
     bool isDone() const noexcept { return stepState == StepState::Done; }
     bool hasError() const noexcept { return stepState == StepState::Error; }
@@ -68,6 +105,11 @@ public:
     bool stepOnce();
 
 private:
+    void resetSteps(juce::Thread* thread);
+    uint64_t computeStandbySettingsHash() const;
+    bool tryConsumeStandby();
+    bool readIRFile(const juce::File& irFile);
+    bool readIRFileInto(const juce::File& irFile, juce::AudioBuffer<double>& out, double& outSampleRate, juce::String& error);
     bool doLoadIRStep();
     bool doTrimStep();
     bool doTransformStep();
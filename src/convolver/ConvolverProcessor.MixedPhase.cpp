@@ -65,6 +65,54 @@ juce::AudioBuffer<double> ConvolverProcessor::convertToMixedPhase(ConvolverProce
     return result;
 }
 
+bool ConvolverProcessor::findMixedPhaseWarmStart(ConvolverProcessor* owner,
+                                                 uint64_t fileHash,
+                                                 double sampleRate,
+                                                 float f1, float f2,
+                                                 std::vector<convo::SecondOrderAllpass>& outSections,
+                                                 double& outSourceRate)
+{
+    if (owner == nullptr || fileHash == 0 || sampleRate <= 0.0)
+        return false;
+
+    // メモリキャッシュ: 同じ系列 (targetLength はレートで変わるので見ない) のうちレート比が最も近いもの
+    std::vector<convo::SecondOrderAllpass> source;
+    double sourceRate = 0.0;
+    {
+        const juce::ScopedLock sl(owner->cacheMutex);
+        double bestDistance = std::numeric_limits<double>::max();
+        for (const auto& [key, entry] : owner->irCache)
+        {
+            if (key.fileHash != fileHash || key.phaseMode != PhaseMode::Mixed
+                || key.f1 != f1 || key.f2 != f2
+                || key.sampleRate <= 0.0 || key.sampleRate == sampleRate
+                || entry.allpassSections.empty())
+                continue;
+            const double distance = std::abs(std::log(key.sampleRate / sampleRate));
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                sourceRate = key.sampleRate;
+                source = entry.allpassSections;
+            }
+        }
+    }
+
+    if (source.empty())
+    {
+        std::vector<double> rho, theta;
+        if (!convo::MixedPhasePersistentCache::loadDesignForOtherRate(
+                fileHash, sampleRate, static_cast<int>(PhaseMode::Mixed), f1, f2, sourceRate, rho, theta))
+            return false;
+        for (size_t i = 0; i < rho.size() && i < theta.size(); ++i)
+            source.push_back({ rho[i], theta[i] });
+    }
+
+    outSections = convo::AllpassDesigner::rescaleToSampleRate(source, sourceRate, sampleRate);
+    outSourceRate = sourceRate;
+    return !outSections.empty();
+}
+
 juce::AudioBuffer<double> ConvolverProcessor::convertToMixedPhaseAllpass(ConvolverProcessor* owner,
                                                                uint64_t fileHash,
                                                                const juce::AudioBuffer<double>& linearIR,
@@ -232,6 +280,14 @@ juce::AudioBuffer<double> ConvolverProcessor::convertToMixedPhaseAllpass(Convolv
             juce::Logger::writeToLog("MixedPhase: channel optimization enabled (reuse ch0 result for identical channels)");
     }
 
+    // ★ 別レートの設計があれば極をこのレートへ写し、CMA-ES はその近傍を短く詰め直すだけにする
+    //   (レート変更後の再設計を数十秒 → 数秒に)。ライブ再構成は元から短い設定なので対象外
+    std::vector<convo::SecondOrderAllpass> warmStartSections;
+    double warmStartSourceRate = 0.0;
+    findMixedPhaseWarmStart(owner, fileHash, sampleRate,
+                            static_cast<float>(transitionLoHz), static_cast<float>(transitionHiHz),
+                            warmStartSections, warmStartSourceRate);
+
     try
     {
         std::vector<convo::SecondOrderAllpass> lastAllpassSections;
@@ -486,6 +542,20 @@ juce::AudioBuffer<double> ConvolverProcessor::convertToMixedPhaseAllpass(Convolv
             designer_config.cmaesParams.sigmaMax = 2.0;
             designer_config.progressCallback = progressCallback;
 
+            if (!liveReconfigure && !warmStartSections.empty())
+            {
+                // 写した極はすでに目標の近くにあるので、σ を絞って世代・個体数とも減らす
+                designer_config.numSections = static_cast<int>(warmStartSections.size());
+                designer_config.initialSections = warmStartSections;
+                designer_config.cmaesMaxGenerations = 24;
+                designer_config.cmaesPopulationSize = 32;
+                designer_config.cmaesInitialSigma = 0.15;
+                if (ch == 0)
+                    juce::Logger::writeToLog("MixedPhase: warm start from "
+                                             + juce::String(warmStartSourceRate, 0) + " Hz design ("
+                                             + juce::String(designer_config.numSections) + " sections)");
+            }
+
             const bool preferGreedyForLive = liveReconfigure && highRateLive;
             if (preferGreedyForLive)
             {
@@ -756,33 +826,42 @@ juce::AudioBuffer<double> ConvolverProcessor::convertToMixedPhaseFallback(const
 
     juce::AudioBuffer<double> mixedIR(numChannels, numSamples);
 
-    convo::ScopedDftiDescriptor dfti;
-    const MKL_LONG len = static_cast<MKL_LONG>(fftSize);
-    if (DftiCreateDescriptor(dfti.put(), DFTI_DOUBLE, DFTI_COMPLEX, 1, len) != DFTI_NO_ERROR)
-        return {};
-    if (DftiSetValue(dfti.handle, DFTI_PLACEMENT, DFTI_INPLACE) != DFTI_NO_ERROR)
-        return {};
-    if (DftiSetValue(dfti.handle, DFTI_BACKWARD_SCALE, 1.0 / static_cast<double>(fftSize)) != DFTI_NO_ERROR)
-        return {};
-    if (DftiCommitDescriptor(dfti.handle) != DFTI_NO_ERROR)
-        return {};
-
     const int half = fftSize / 2;
     const int complexSize = half + 1;
-
-    auto linearSpec = convo::makeAlignedArray<MKL_Complex16>(static_cast<size_t>(fftSize));
-    auto minimumSpec = convo::makeAlignedArray<MKL_Complex16>(static_cast<size_t>(fftSize));
-    auto deltaPhi = convo::makeAlignedArray<double>(static_cast<size_t>(complexSize));
-
-    if (!linearSpec || !minimumSpec || !deltaPhi)
-        return {};
-
     const double invSpan = 1.0 / (transitionHiHz - transitionLoHz);
+    std::atomic<bool> cancelled { false };
 
+    // getWritePointer は AudioBuffer の状態を書き換えるため、ワーカーへ渡す前に呼び出しスレッドで取る
+    std::vector<double*> mixedChannels(static_cast<size_t>(numChannels));
     for (int ch = 0; ch < numChannels; ++ch)
+        mixedChannels[static_cast<size_t>(ch)] = mixedIR.getWritePointer(ch);
+
+    // ★ 1 チャンネル分の変換。ワーカーごとに DFTI ディスクリプタと作業領域を持つ (並列実行時も共有しない)
+    const auto convertChannel = [&](int ch) -> bool
     {
-        if (checkCancellation(shouldExit, wasCancelled))
-            return {};
+        if (checkCancellation(shouldExit))
+        {
+            convo::publishAtomic(cancelled, true, std::memory_order_relaxed); // relaxed: 読むのは全ワーカー join 後
+            return false;
+        }
+
+        convo::ScopedDftiDescriptor dfti;
+        const MKL_LONG len = static_cast<MKL_LONG>(fftSize);
+        if (DftiCreateDescriptor(dfti.put(), DFTI_DOUBLE, DFTI_COMPLEX, 1, len) != DFTI_NO_ERROR)
+            return false;
+        if (DftiSetValue(dfti.handle, DFTI_PLACEMENT, DFTI_INPLACE) != DFTI_NO_ERROR)
+            return false;
+        if (DftiSetValue(dfti.handle, DFTI_BACKWARD_SCALE, 1.0 / static_cast<double>(fftSize)) != DFTI_NO_ERROR)
+            return false;
+        if (DftiCommitDescriptor(dfti.handle) != DFTI_NO_ERROR)
+            return false;
+
+        auto linearSpec = convo::makeAlignedArray<MKL_Complex16>(static_cast<size_t>(fftSize));
+        auto minimumSpec = convo::makeAlignedArray<MKL_Complex16>(static_cast<size_t>(fftSize));
+        auto deltaPhi = convo::makeAlignedArray<double>(static_cast<size_t>(complexSize));
+
+        if (!linearSpec || !minimumSpec || !deltaPhi)
+            return false;
 
         const double* srcLinear = linearIR.getReadPointer(ch);
         const double* srcMinimum = minimumIR.getReadPointer(ch);
@@ -808,8 +887,8 @@ juce::AudioBuffer<double> ConvolverProcessor::convertToMixedPhaseFallback(const
             minimumSpec.get()[i].real = srcMinimum[i];
         }
 
-        if (DftiComputeForward(dfti.handle, linearSpec.get()) != DFTI_NO_ERROR) return {};
-        if (DftiComputeForward(dfti.handle, minimumSpec.get()) != DFTI_NO_ERROR) return {};
+        if (DftiComputeForward(dfti.handle, linearSpec.get()) != DFTI_NO_ERROR) return false;
+        if (DftiComputeForward(dfti.handle, minimumSpec.get()) != DFTI_NO_ERROR) return false;
 
         for (int k = 0; k < complexSize; ++k)
         {
@@ -852,15 +931,28 @@ juce::AudioBuffer<double> ConvolverProcessor::convertToMixedPhaseFallback(const
         }
 
         if (DftiComputeBackward(dfti.handle, linearSpec.get()) != DFTI_NO_ERROR)
-            return {};
+            return false;
 
-        double* mixedTime = mixedIR.getWritePointer(ch);
+        double* mixedTime = mixedChannels[static_cast<size_t>(ch)];
         for (int i = 0; i < numSamples; ++i)
         {
             const double value = linearSpec.get()[i].real;
             mixedTime[i] = (std::abs(value) < 1.0e-18) ? 0.0 : value;
         }
+        return true;
+    };
+
+    // 作業領域: 複素スペクトル 2 本 + 位相差
+    const size_t scratchBytes = static_cast<size_t>(fftSize) * 2 * sizeof(MKL_Complex16)
+                              + static_cast<size_t>(complexSize) * sizeof(double);
+    const bool ok = runChannelsParallel(numChannels, scratchBytes, convertChannel);
+    if (convo::consumeAtomic(cancelled, std::memory_order_relaxed)) // relaxed: join が HB を与える
+    {
+        if (wasCancelled) *wasCancelled = true;
+        return {};
     }
+    if (!ok)
+        return {};
 
     return mixedIR;
 }
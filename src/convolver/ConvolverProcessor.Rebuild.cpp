@@ -3,6 +3,10 @@
 #include "convolver/ConvolverProcessor.Internal.h"
 
 #include "audioengine/AtomicAccess.h"
+#include "core/TimeUtils.h"
+
+#include <chrono>
+#include <thread>
 
 #if defined(CONVOPEQ_ENABLE_CONVOLVER_SPLIT_REBUILD)
 
@@ -18,6 +22,147 @@ void ConvolverProcessor::rebuildAllIRs()
     }
 }
 
+namespace
+{
+// 優先度 → 1 スライスの時間予算 (µs)
+uint64_t sliceBudgetUsFor(ConvolverProcessor::IncrementalRebuildPriority priority) noexcept
+{
+    switch (priority)
+    {
+        case ConvolverProcessor::IncrementalRebuildPriority::Background:  return 2000;
+        case ConvolverProcessor::IncrementalRebuildPriority::Interactive: return 12000;
+        case ConvolverProcessor::IncrementalRebuildPriority::Normal:
+        default:                                                          return 6000;
+    }
+}
+} // namespace
+
+bool ConvolverProcessor::beginIncrementalRebuild(std::function<bool()> shouldCancel)
+{
+    const IRState* state = acquireIRState();
+    if (state == nullptr || !state->ir || state->ir->getNumSamples() <= 0 || state->sampleRate <= 0.0)
+    {
+        releaseIRState(state);
+        return false;
+    }
+
+    if (!rebuildJob)
+        rebuildJob = std::make_unique<IncrementalRebuildJob>();
+    rebuildJob->reset();
+
+    // IRState は RCU で差し替わるため、ジョブの寿命中に参照し続けずコピーを持つ
+    rebuildJob->preparedIR = std::make_unique<juce::AudioBuffer<double>>(*(state->ir));
+    rebuildJob->preparedSampleRate = state->sampleRate;
+    rebuildJob->preparedHeadEnergyRatio = state->headEnergyRatio;
+    rebuildJob->shouldCancel = std::move(shouldCancel);
+    rebuildJob->stage = IncrementalRebuildJob::Stage::Prepared;
+    releaseIRState(state);
+    return true;
+}
+
+//============================================================================
+// advanceIncrementalRebuild  ─ rebuild worker
+//   1 回の呼び出しが 1 スライス。各ステップを計測して種類ごとの見積りを更新し、
+//   次のステップが優先度の時間予算に収まる間だけ同じスライスで続ける。
+//============================================================================
+ConvolverProcessor::IncrementalRebuildSliceResult ConvolverProcessor::advanceIncrementalRebuild() noexcept
+{
+    if (!rebuildJob || rebuildJob->stage == IncrementalRebuildJob::Stage::Idle)
+        return IncrementalRebuildSliceResult::Failed;
+
+    auto& job = *rebuildJob;
+    rebuildSliceBudget.setBudgetUs(sliceBudgetUsFor(getIncrementalRebuildPriority()));
+
+    IncrementalRebuildSliceResult result = IncrementalRebuildSliceResult::Failed;
+    try
+    {
+        result = convo::runBudgetedSlice(
+            rebuildSliceBudget,
+            [] { return convo::getCurrentTimeUs(); },
+            [&job] { return job.stage == IncrementalRebuildJob::Stage::Done; },
+            [&job] { return job.nextStepKind; },
+            [this, &job]
+            {
+                return (job.stage == IncrementalRebuildJob::Stage::FinalizingApply)
+                           ? runIncrementalFinalizeStep(job)
+                           : runIncrementalBuildStep(job);
+            });
+    }
+    catch (...)
+    {
+        job.lastError = "incremental rebuild: exception in step";
+        result = IncrementalRebuildSliceResult::Failed;
+    }
+
+    if (result == IncrementalRebuildSliceResult::InProgress)
+        return result;
+
+    if (result == IncrementalRebuildSliceResult::Failed)
+        juce::Logger::writeToLog("[CONV_REBUILD] incremental rebuild failed: " + job.lastError);
+    job.reset();
+    return result;
+}
+
+//============================================================================
+// runIncrementalRebuild  ─ rebuild worker (rebuildAllIRsSynchronous から)
+//   スライスごとに予算超過分に比例して休み、実行時間の比率を優先度の予算 / 周期に保つ。
+//   休止中も shouldCancel を確認し、古い世代のリビルドは次のスライスを待たずに止める。
+//============================================================================
+ConvolverProcessor::IncrementalRebuildSliceResult ConvolverProcessor::runIncrementalRebuild(std::function<bool()> shouldCancel)
+{
+    if (!beginIncrementalRebuild(shouldCancel))
+        return IncrementalRebuildSliceResult::Failed;
+
+    {
+        const std::lock_guard<std::mutex> lock(sharedRebuildSliceEstimatesMutex());
+        rebuildSliceBudget = sharedRebuildSliceEstimates();
+    }
+
+    const auto result = convo::runPacedSlices(
+        rebuildSliceBudget, kIncrementalSlicePeriodUs, kIncrementalMaxRestUs, kIncrementalRestPollUs,
+        [] { return convo::getCurrentTimeUs(); },
+        [this] { return advanceIncrementalRebuild(); },
+        [&shouldCancel] { return shouldCancel && shouldCancel(); },
+        [](uint64_t us) { std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(us))); });
+
+    if (result == IncrementalRebuildSliceResult::Canceled)
+        resetIncrementalRebuild();
+
+    {
+        const std::lock_guard<std::mutex> lock(sharedRebuildSliceEstimatesMutex());
+        sharedRebuildSliceEstimates() = rebuildSliceBudget;
+    }
+    return result;
+}
+
+convo::AdaptiveSliceBudget<ConvolverProcessor::kIncrementalStepKinds>& ConvolverProcessor::sharedRebuildSliceEstimates() noexcept
+{
+    static convo::AdaptiveSliceBudget<kIncrementalStepKinds> estimates;
+    return estimates;
+}
+
+std::mutex& ConvolverProcessor::sharedRebuildSliceEstimatesMutex() noexcept
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+void ConvolverProcessor::resetIncrementalRebuild() noexcept
+{
+    if (rebuildJob)
+        rebuildJob->reset();
+}
+
+void ConvolverProcessor::setIncrementalRebuildPriority(IncrementalRebuildPriority priority) noexcept
+{
+    convo::publishAtomic(incrementalRebuildPriority, static_cast<int>(priority), std::memory_order_relaxed); // relaxed: 次スライスの予算を選ぶだけの単独値
+}
+
+ConvolverProcessor::IncrementalRebuildPriority ConvolverProcessor::getIncrementalRebuildPriority() const noexcept
+{
+    return static_cast<IncrementalRebuildPriority>(convo::consumeAtomic(incrementalRebuildPriority, std::memory_order_relaxed)); // relaxed: 同上
+}
+
 void ConvolverProcessor::postCoalescedChangeNotification()
 {
     if (convo::exchangeAtomic(changeNotificationPending, true, std::memory_order_acq_rel)) // acq_rel: acquire で先行状態観測; release で pending=true 公開
@@ -90,10 +235,24 @@ void ConvolverProcessor::rebuildAllIRsSynchronous(std::function<bool()> shouldCa
                         convo::consumeAtomic(currentIRScale, std::memory_order_acquire), // acquire: applyNewState の publishAtomic release と HB
                         buildSnapshot);
             loader.externalCancellationCheck = shouldCancel;
+            loader.headEnergyRatio = state->headEnergyRatio;
             loader.runSynchronously();
         };
 
-        runRebuildPath();
+        // ★ Incremental 有効時は同じ LoaderThread のステップを時間予算つきスライスで進め、スライス間は休む
+        if (isIncrementalRebuildEnabled())
+        {
+            const auto result = runIncrementalRebuild(shouldCancel);
+            if (result != IncrementalRebuildSliceResult::Completed)
+            {
+                releaseIRState(state);
+                return;
+            }
+        }
+        else
+        {
+            runRebuildPath();
+        }
 
         juce::Logger::writeToLog("[CONV_REBUILD] rebuildAllIRsSynchronous: engine rebuilt"
             " len=" + juce::String(state->ir->getNumSamples())
@@ -119,9 +278,11 @@ void ConvolverProcessor::IncrementalRebuildJob::reset() noexcept
     stage = Stage::Idle;
     preparedIR.reset();
     preparedSampleRate = 0.0;
+    preparedHeadEnergyRatio = 1.0;
     shouldCancel = nullptr;
     incrementalLoader.reset();
     loaderInitialized = false;
+    nextStepKind = 0;
     pendingLoadedIR.setSize(0, 0);
     pendingLoadedSR = 0.0;
     pendingTargetLength = 0;
@@ -186,6 +347,7 @@ bool ConvolverProcessor::runIncrementalBuildStep(IncrementalRebuildJob& job)
             convo::consumeAtomic(currentIRScale, std::memory_order_acquire), // acquire: applyNewState の publishAtomic release と HB
             buildSnapshot);
         job.incrementalLoader->externalCancellationCheck = job.shouldCancel;
+        job.incrementalLoader->headEnergyRatio = job.preparedHeadEnergyRatio;
         job.loaderInitialized = true;
     }
 
@@ -207,6 +369,7 @@ bool ConvolverProcessor::runIncrementalBuildStep(IncrementalRebuildJob& job)
 
     if (!terminal)
     {
+        ++job.nextStepKind;
         job.stage = IncrementalRebuildJob::Stage::Building;
         job.lastError.clear();
         return true;
@@ -228,6 +391,7 @@ bool ConvolverProcessor::runIncrementalBuildStep(IncrementalRebuildJob& job)
     job.pendingFile        = juce::File();
     job.pendingIsRebuild   = true;
     job.stage              = IncrementalRebuildJob::Stage::FinalizingApply;
+    job.nextStepKind       = kIncrementalFinalizeStepKind;
     job.finalizeApplied    = false;
     job.lastError.clear();
 
@@ -266,8 +430,9 @@ bool ConvolverProcessor::runIncrementalFinalizeStep(IncrementalRebuildJob& job)
     auto displayIR = std::make_unique<juce::AudioBuffer<double>>(std::move(job.pendingDisplayIR));
     StereoConvolver *conv = std::exchange(job.pendingConv, nullptr);
 
+    // rebuildAllIRsSynchronous と同じく呼び出しスレッドでコミットする (rebuild worker は完了を待って公開する)
     applyNewState(conv, std::move(loadedIR), job.pendingLoadedSR, job.pendingTargetLength,
-                  job.pendingIsRebuild, job.pendingFile, job.pendingScaleFactor, std::move(displayIR));
+                  job.pendingIsRebuild, job.pendingFile, job.pendingScaleFactor, std::move(displayIR), /*async=*/false);
 
     job.finalizeApplied = true;
     job.lastError.clear();
@@ -6,6 +6,8 @@
 #include <mkl.h>
 #include <mkl_vml.h>
 
+#include "audioengine/AtomicAccess.h"
+
 #if defined(CONVOPEQ_ENABLE_CONVOLVER_SPLIT_RESAMPLE)
 
 // ────────────────────────────────────────────────────────────────
@@ -15,6 +17,50 @@
 namespace ConvolverProcessorInternal
 {
 
+namespace {
+// 1 回の process() に与える入力の上限。チャンクの合間で打ち切りを確認する (r8brain はストリーム処理なので
+// 区切り方で出力は変わらない)
+constexpr int kResampleChunkSamples = 1 << 15;
+
+// CDSPResampler::oneshot と同じ出力を作る。入力を chunk ずつ与え、出力が oplen に達するまで 0 で押し出す。
+// shouldExit が true を返したら途中で false
+bool resampleChannelChunked(r8b::CDSPResampler& resampler, const double* ip, int iplen,
+                            double* op, int oplen, int chunk, const std::function<bool()>& shouldExit)
+{
+    std::vector<double> zeros;
+    while (oplen > 0)
+    {
+        if (shouldExit && shouldExit())
+            return false;
+
+        int rc = 0;
+        double* p = nullptr;
+        if (iplen == 0)
+        {
+            if (zeros.empty())
+                zeros.assign(static_cast<size_t>(chunk), 0.0);
+            rc = chunk;
+            p = zeros.data();
+        }
+        else
+        {
+            rc = std::min(iplen, chunk);
+            p = const_cast<double*>(ip);   // oneshot と同じく入力は書き換えられない
+            ip += rc;
+            iplen -= rc;
+        }
+
+        double* op0 = nullptr;
+        const int wc = std::min(oplen, resampler.process(p, rc, op0));
+        std::memcpy(op, op0, static_cast<size_t>(wc) * sizeof(double));
+        op += wc;
+        oplen -= wc;
+    }
+    resampler.clear();
+    return true;
+}
+}
+
 ResampleOutput resampleIR(const juce::AudioBuffer<double>& inputIR,
                           double inputSR,
                           double targetSR,
@@ -44,24 +90,33 @@ ResampleOutput resampleIR(const juce::AudioBuffer<double>& inputIR,
 
     std::vector<int> lengths(static_cast<size_t>(numCh));
     std::vector<std::vector<double>> chData(static_cast<size_t>(numCh));
-    int maxLen = 0;
+    std::atomic<bool> failedWithError { false };
 
-    for (int ch = 0; ch < numCh; ++ch)
+    // ★ チャンネルは独立なので並列に変換し、各チャンネルもチャンク単位で打ち切りを確認する。
+    //   新しい IR の読み込みが始まったとき、古いロードが 1 チャンネル分の oneshot を終えるまで居座らない
+    const double ratio = targetSR / inputSR;
+    const size_t scratchPerChannel = static_cast<size_t>((static_cast<double>(inLen) * (1.0 + ratio) + 65536.0) * sizeof(double));
+    const bool completed = runChannelsParallel(numCh, scratchPerChannel, [&](int ch) -> bool
     {
         if (shouldExit && shouldExit())
-            return {{}, ResampleResult::Cancelled};
+            return false;
 
         r8b::CDSPResampler resampler(inputSR, targetSR, inLen,
                                      transBand, stopBandAtten, phaseMode);
 
         const int maxOut = resampler.getMaxOutLen(inLen);
         if (maxOut <= 0)
-            return {{}, ResampleResult::Error};
+        {
+            convo::publishAtomic(failedWithError, true, std::memory_order_relaxed); // relaxed: 結果は runChannelsParallel の join 後に読む
+            return false;
+        }
 
         auto& buf = chData[static_cast<size_t>(ch)];
         buf.resize(static_cast<size_t>(maxOut), 0.0);
 
-        resampler.oneshot(inputIR.getReadPointer(ch), inLen, buf.data(), maxOut);
+        if (!resampleChannelChunked(resampler, inputIR.getReadPointer(ch), inLen, buf.data(), maxOut,
+                                    std::min(inLen, kResampleChunkSamples), shouldExit))
+            return false;
 
         const int effectiveLen = [&buf, maxOut]() {
             constexpr double TAIL_DB = -160.0;
@@ -87,9 +142,18 @@ ResampleOutput resampleIR(const juce::AudioBuffer<double>& inputIR,
         }();
 
         lengths[static_cast<size_t>(ch)] = effectiveLen;
-        maxLen = std::max(maxLen, effectiveLen);
+        return true;
+    });
+
+    if (!completed)
+    {
+        return {{}, convo::consumeAtomic(failedWithError, std::memory_order_relaxed) // relaxed: join 済み
+                        ? ResampleResult::Error
+                        : ResampleResult::Cancelled};
     }
 
+    const int maxLen = *std::max_element(lengths.begin(), lengths.end());
+
     juce::AudioBuffer<double> result(numCh, maxLen);
     result.clear();
 
@@ -348,42 +412,52 @@ juce::AudioBuffer<double> convertToMinimumPhase(const juce::AudioBuffer<double>&
     }
 
     juce::AudioBuffer<double> minPhaseIR(linearIR.getNumChannels(), numSamples);
+    std::atomic<bool> cancelled { false };
 
-    convo::ScopedDftiDescriptor dfti;
+    // getWritePointer は AudioBuffer の状態を書き換えるため、ワーカーへ渡す前に呼び出しスレッドで取る
+    std::vector<double*> minPhaseChannels(static_cast<size_t>(minPhaseIR.getNumChannels()));
+    for (int ch = 0; ch < minPhaseIR.getNumChannels(); ++ch)
+        minPhaseChannels[static_cast<size_t>(ch)] = minPhaseIR.getWritePointer(ch);
 
-    const MKL_LONG len = static_cast<MKL_LONG>(fftSize);
-    if (DftiCreateDescriptor(dfti.put(), DFTI_DOUBLE, DFTI_COMPLEX, 1, len) != DFTI_NO_ERROR)
+    // ★ 1 チャンネル分の変換。ワーカーごとに DFTI ディスクリプタと作業領域を持つ (並列実行時も共有しない)
+    const auto convertChannel = [&](int ch) -> bool
     {
-        juce::Logger::writeToLog("convertToMinimumPhase: DftiCreateDescriptor failed.");
-        return {};
-    }
+        if (checkCancellation(shouldExit))
+        {
+            convo::publishAtomic(cancelled, true, std::memory_order_relaxed); // relaxed: 読むのは全ワーカー join 後
+            return false;
+        }
 
-    if (DftiSetValue(dfti.handle, DFTI_PLACEMENT, DFTI_INPLACE) != DFTI_NO_ERROR)
-    {
-        juce::Logger::writeToLog("convertToMinimumPhase: DftiSetValue(DFTI_PLACEMENT) failed.");
-        return {};
-    }
+        convo::ScopedDftiDescriptor dfti;
 
-    if (DftiSetValue(dfti.handle, DFTI_BACKWARD_SCALE, 1.0 / static_cast<double>(fftSize)) != DFTI_NO_ERROR)
-    {
-        juce::Logger::writeToLog("convertToMinimumPhase: DftiSetValue(DFTI_BACKWARD_SCALE) failed.");
-        return {};
-    }
+        const MKL_LONG len = static_cast<MKL_LONG>(fftSize);
+        if (DftiCreateDescriptor(dfti.put(), DFTI_DOUBLE, DFTI_COMPLEX, 1, len) != DFTI_NO_ERROR)
+        {
+            juce::Logger::writeToLog("convertToMinimumPhase: DftiCreateDescriptor failed.");
+            return false;
+        }
 
-    if (DftiCommitDescriptor(dfti.handle) != DFTI_NO_ERROR)
-    {
-        juce::Logger::writeToLog("convertToMinimumPhase: DftiCommitDescriptor failed.");
-        return {};
-    }
+        if (DftiSetValue(dfti.handle, DFTI_PLACEMENT, DFTI_INPLACE) != DFTI_NO_ERROR)
+        {
+            juce::Logger::writeToLog("convertToMinimumPhase: DftiSetValue(DFTI_PLACEMENT) failed.");
+            return false;
+        }
 
-    auto spectrum = convo::makeAlignedArray<MKL_Complex16>(static_cast<size_t>(fftSize));
-    if (!spectrum)
-        return {};
+        if (DftiSetValue(dfti.handle, DFTI_BACKWARD_SCALE, 1.0 / static_cast<double>(fftSize)) != DFTI_NO_ERROR)
+        {
+            juce::Logger::writeToLog("convertToMinimumPhase: DftiSetValue(DFTI_BACKWARD_SCALE) failed.");
+            return false;
+        }
 
-    for (int ch = 0; ch < linearIR.getNumChannels(); ++ch)
-    {
-        if (checkCancellation(shouldExit, wasCancelled))
-            return {};
+        if (DftiCommitDescriptor(dfti.handle) != DFTI_NO_ERROR)
+        {
+            juce::Logger::writeToLog("convertToMinimumPhase: DftiCommitDescriptor failed.");
+            return false;
+        }
+
+        auto spectrum = convo::makeAlignedArray<MKL_Complex16>(static_cast<size_t>(fftSize));
+        if (!spectrum)
+            return false;
 
         const double* src = linearIR.getReadPointer(ch);
         for (int i = 0; i < fftSize; ++i)
@@ -394,11 +468,13 @@ juce::AudioBuffer<double> convertToMinimumPhase(const juce::AudioBuffer<double>&
 
         if (DftiComputeForward(dfti.handle, spectrum.get()) != DFTI_NO_ERROR) {
             juce::Logger::writeToLog("convertToMinimumPhase: DftiComputeForward (1) failed.");
-            return {};
+            return false;
         }
 
         {
             auto mag = convo::makeAlignedArray<double>(static_cast<size_t>(fftSize));
+            if (!mag)
+                return false;
 
             vzAbs(fftSize, spectrum.get(), mag.get());
 
@@ -413,7 +489,7 @@ juce::AudioBuffer<double> convertToMinimumPhase(const juce::AudioBuffer<double>&
 
         if (DftiComputeBackward(dfti.handle, spectrum.get()) != DFTI_NO_ERROR) {
             juce::Logger::writeToLog("convertToMinimumPhase: DftiComputeBackward (1) failed.");
-            return {};
+            return false;
         }
 
         const int half = fftSize / 2;
@@ -432,7 +508,7 @@ juce::AudioBuffer<double> convertToMinimumPhase(const juce::AudioBuffer<double>&
 
         if (DftiComputeForward(dfti.handle, spectrum.get()) != DFTI_NO_ERROR) {
             juce::Logger::writeToLog("convertToMinimumPhase: DftiComputeForward (2) failed.");
-            return {};
+            return false;
         }
 
         {
@@ -445,27 +521,36 @@ juce::AudioBuffer<double> convertToMinimumPhase(const juce::AudioBuffer<double>&
             vzExp(fftSize, spectrum.get(), spectrum.get());
 
             for (int i = 0; i < fftSize; ++i)
-                if (!std::isfinite(spectrum.get()[i].real) || !std::isfinite(spectrum.get()[i].imag)) return {};
+                if (!std::isfinite(spectrum.get()[i].real) || !std::isfinite(spectrum.get()[i].imag)) return false;
         }
 
         if (DftiComputeBackward(dfti.handle, spectrum.get()) != DFTI_NO_ERROR) {
             juce::Logger::writeToLog("convertToMinimumPhase: DftiComputeBackward (2) failed.");
-            return {};
+            return false;
         }
 
-        double* dst = minPhaseIR.getWritePointer(ch);
+        double* dst = minPhaseChannels[static_cast<size_t>(ch)];
         for (int i = 0; i < numSamples; ++i)
         {
             double v = spectrum.get()[i].real;
             if (!std::isfinite(v))
-                return {};
+                return false;
             if (std::abs(v) < 1.0e-18)
                 v = 0.0;
             dst[i] = v;
         }
-    }
+        return true;
+    };
 
-    return minPhaseIR;
+    // 作業領域: 複素スペクトル + 振幅
+    const size_t scratchBytes = static_cast<size_t>(fftSize) * (sizeof(MKL_Complex16) + sizeof(double));
+    const bool ok = runChannelsParallel(linearIR.getNumChannels(), scratchBytes, convertChannel);
+    if (convo::consumeAtomic(cancelled, std::memory_order_relaxed)) // relaxed: join が HB を与える
+    {
+        if (wasCancelled) *wasCancelled = true;
+        return {};
+    }
+    return ok ? minPhaseIR : juce::AudioBuffer<double> {};
 }
 
 } // namespace ConvolverProcessorInternal
@@ -12,6 +12,7 @@
 #include "core/TimeUtils.h"
 
 #include "audioengine/AtomicAccess.h"
+#include "audioengine/ChannelForkJoin.h"
 
 std::atomic<int> ConvolverProcessor::latencyClampCounterStorage_ { 0 };
 
@@ -39,23 +40,19 @@ namespace
             : truncatedAsDouble;
     }
 
-    inline bool isFiniteAndAbsBelowNoLibm(double x, double threshold) noexcept
+    // wet が無い (未ロード・不正チャンネル) ときの出力: GetMix の wet=0 と同じ dry * dryGain
+    inline void writeDryOnly(double* out, const double* dry, int count,
+                             const convo::MKLNonUniformConvolver::MixGains& gains) noexcept
     {
-        // ISR: std::bit_cast の中間変数形式（union UB 排除）
-        const auto bits = std::bit_cast<uint64_t>(x);
-        const bool finite = (((bits >> 52) & 0x7FFu) != 0x7FFu);
-        return finite && (absNoLibm(x) < threshold);
-    }
-
-    inline void sanitizeFiniteChunk(double* data, int count) noexcept
-    {
-        if (data == nullptr || count <= 0)
-            return;
-
-        for (int i = 0; i < count; ++i)
+        if (gains.dry != nullptr)
         {
-            if (!isFiniteAndAbsBelowNoLibm(data[i], 1.0e300))
-                data[i] = 0.0;
+            for (int i = 0; i < count; ++i)
+                out[i] = dry[i] * gains.dry[i];
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i)
+                out[i] = dry[i] * gains.dryConst;
         }
     }
 }
@@ -110,6 +107,12 @@ void ConvolverProcessor::refreshLatency()
         totalLatency = static_cast<double>(juce::jmin(juce::jmax(0, algorithmLatency + irPeakLatency), MAX_TOTAL_DELAY));
     }
 
+    // 補正リングを新しい遅延まで伸ばす (Audio Thread は次ブロック先頭で取り込む)。
+    // 確保できなければ Audio Thread が現容量でクランプし latencyClampCounter に残る
+    if (!latencyDelay.reserve(static_cast<int>(totalLatency)))
+        juce::Logger::writeToLog("ConvolverProcessor::refreshLatency: latency delay reserve failed (latency="
+                                 + juce::String(static_cast<int>(totalLatency)) + ")");
+
     updateLatencyCache();
     requestHostDisplayUpdate();
 
@@ -128,12 +131,9 @@ void ConvolverProcessor::processBypassWithLatencyCompensation(juce::dsp::AudioBl
     if (procChannels == 0 || numSamples <= 0)
         return;
 
-    double* delayBuf[2] = { delayBuffer[0].get(), delayBuffer[1].get() };
-    int activeDelayCapacity = delayBufferCapacity;
-
-    if (delayBuf[0] == nullptr || delayBuf[1] == nullptr || activeDelayCapacity < DELAY_BUFFER_SIZE)
+    if (!latencyDelay.canProcess(numSamples))
     {
-        // ★ Bug 2: delayBuffer が未確保の場合は無音を出力（stale data 防止）
+        // ★ Bug 2: 補正リングが未確保の場合は無音を出力（stale data 防止）
         for (int ch = 0; ch < procChannels; ++ch)
             juce::FloatVectorOperations::clear(block.getChannelPointer(static_cast<size_t>(ch)), numSamples);
         return;
@@ -141,48 +141,17 @@ void ConvolverProcessor::processBypassWithLatencyCompensation(juce::dsp::AudioBl
 
     const int algorithmLatency = conv.storedDirectHeadEnabled ? 0 : juce::jmax(0, conv.latency);
     const int irPeakLatency = juce::jmax(0, conv.irLatency);
-    int delaySamples = juce::jmax(0, algorithmLatency + irPeakLatency);
-    delaySamples = juce::jmin(delaySamples, MAX_TOTAL_DELAY);
-    delaySamples = juce::jlimit(0, DELAY_BUFFER_SIZE - 1, delaySamples);
-
-    const int writePos = delayWritePos;
+    const int delaySamples = juce::jlimit(0, latencyDelay.maxDelayFor(numSamples), algorithmLatency + irPeakLatency);
 
-    // 1) 入力をリングバッファへ保存
+    // 入力をリングへ保存してから、遅延した信号を出力へ戻す (同一ブロック内の遅延 < numSamples も読める)
     for (int ch = 0; ch < procChannels; ++ch)
     {
-        const double* src = block.getChannelPointer(static_cast<size_t>(ch));
-        double* buf = delayBuf[ch];
-
-        const int samplesFirst = std::min(numSamples, DELAY_BUFFER_SIZE - writePos);
-        const int samplesSecond = numSamples - samplesFirst;
-
-        std::memcpy(buf + writePos, src, static_cast<size_t>(samplesFirst) * sizeof(double));
-        if (samplesSecond > 0)
-            std::memcpy(buf, src + samplesFirst, static_cast<size_t>(samplesSecond) * sizeof(double));
+        double* io = block.getChannelPointer(static_cast<size_t>(ch));
+        latencyDelay.write(ch, io, numSamples);
+        latencyDelay.read(ch, io, numSamples, delaySamples);
     }
 
-    // 2) 遅延した信号を出力へ戻す
-    // DELAY_BUFFER_MASK = 2^n - 1 であるため、`& DELAY_BUFFER_MASK` の結果は常に非負。
-    // したがって `if (readPos < 0)` は死コード。
-    int readPos = (writePos - delaySamples) & DELAY_BUFFER_MASK;
-    // if (readPos < 0)
-    //     readPos += DELAY_BUFFER_SIZE;
-
-    for (int ch = 0; ch < procChannels; ++ch)
-    {
-        const double* srcBuf = delayBuf[ch];
-        double* dstBuf = block.getChannelPointer(static_cast<size_t>(ch));
-
-        const int samplesFirst = std::min(numSamples, DELAY_BUFFER_SIZE - readPos);
-        const int samplesSecond = numSamples - samplesFirst;
-
-        juce::FloatVectorOperations::copy(dstBuf, srcBuf + readPos, samplesFirst);
-        if (samplesSecond > 0)
-            juce::FloatVectorOperations::copy(dstBuf + samplesFirst, srcBuf, samplesSecond);
-    }
-
-    const int nextWritePos = (writePos + numSamples) & DELAY_BUFFER_MASK;
-    delayWritePos = nextWritePos;
+    latencyDelay.advance(numSamples);
 }
 
 void ConvolverProcessor::enterGlobalReader(int readerIndex) const noexcept
@@ -206,23 +175,19 @@ void ConvolverProcessor::exitGlobalReader(int readerIndex) const noexcept
 //    - 待機なし (No Wait)
 //    - RCU (Read-Copy-Update) パターンを使用
 //--------------------------------------------------------------
-void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
+void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block, convo::ChannelForkJoin* split)
 {
-    convo::RCUReaderGuard guard(runtimeRcuReader);
+    convo::RCUReaderGuard guard(runtimeRcuReader, m_rtReaderPinned);
 
     auto& activeCrossfadeGain = crossfadeGain;
     auto& activeMixSmoother = mixSmoother;
     auto& activeLatencySmoother = latencySmoother;
-    auto& activeDelayWritePos = delayWritePos;
     auto& activeOldDelay = oldDelay;
 
-    double* delayBuf[2] = { delayBuffer[0].get(), delayBuffer[1].get() };
     double* dryBuf[2] = { dryBufferStorage[0].get(), dryBufferStorage[1].get() };
     double* oldDryBuf[2] = { oldDryBufferStorage[0].get(), oldDryBufferStorage[1].get() };
-    double* wetBuf[2] = { wetBufferStorage[0].get(), wetBufferStorage[1].get() };
     double* smoothingBuf[2] = { smoothingBufferStorage[0].get(), smoothingBufferStorage[1].get() };
     int activeDryCapacity = dryBufferCapacity;
-    int activeWetCapacity = wetBufferCapacity;
     int activeSmoothingCapacity = smoothingBufferCapacity;
 
     if (!convo::consumeAtomic(isPrepared, std::memory_order_acquire)) // acquire: prepareToPlay/releaseResources の publishAtomic release と HB
@@ -243,6 +208,9 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
 
     juce::ScopedNoDenormals noDenormals;
 
+    // refreshLatency が伸ばした補正リングへ切り替える (読み書きより先)
+    latencyDelay.adoptPendingGrowth();
+
     auto* conv = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel/release と HB
 
     if (!conv)
@@ -254,6 +222,8 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
 #endif
 
     const auto runtimeSnapshot = captureRuntimeProcessSnapshot();
+    // ★ Spectral morph: 目標 m を渡すだけ (NUC がパーティション毎にランプで追従。未接続なら参照されない)
+    conv->setSpectralMorphAmount(static_cast<double>(runtimeSnapshot.spectralMorphAmount));
 
     if (runtimeSnapshot.bypassed)
     {
@@ -271,9 +241,13 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
 
         const int64_t calculatedLatency64 = static_cast<int64_t>(algorithmLatency)
                                           + static_cast<int64_t>(irPeakLatency);
-        int totalLatency = static_cast<int>(std::min<int64_t>(calculatedLatency64, MAX_TOTAL_DELAY));
+        // 補正リングの容量 (reserve 失敗・取り込み待ちの間は伸びる前の容量) を超える分もクランプする
+        const int maxCompensatedDelay = latencyDelay.maxDelayFor(static_cast<int>(block.getNumSamples()));
+        const int64_t latencyLimit64 = std::min<int64_t>(MAX_TOTAL_DELAY, maxCompensatedDelay);
+        int totalLatency = static_cast<int>(std::min<int64_t>(calculatedLatency64, latencyLimit64));
 
-        if (rawAlgorithmLatency != algorithmLatency || rawIrPeakLatency != irPeakLatency)
+        if (rawAlgorithmLatency != algorithmLatency || rawIrPeakLatency != irPeakLatency
+            || calculatedLatency64 > latencyLimit64)
             convo::fetchAddAtomic(latencyClampCounter(), 1, std::memory_order_acq_rel); // acq_rel: clamp count 観測側 acquire と HB
 
         if (absNoLibm(activeLatencySmoother.getTargetValue() - static_cast<double>(totalLatency)) >= kLatencyRetargetThresholdSamples)
@@ -294,14 +268,7 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
     if (numSamples <= 0 || procChannels == 0)
         return;
 
-    if (numSamples > activeDryCapacity)
-    {
-        block.clear();
-        return;
-    }
-
-    jassert(activeWetCapacity >= numSamples);
-    if (numSamples > activeWetCapacity)
+    if (numSamples > activeDryCapacity || !latencyDelay.canProcess(numSamples))
     {
         block.clear();
         return;
@@ -376,19 +343,12 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
 
     // Dry信号生成
     {
-        int wPos = activeDelayWritePos;
         for (int ch = 0; ch < procChannels; ++ch)
-        {
-            const double* src = block.getChannelPointer(ch);
-            double* buf = delayBuf[ch];
+            latencyDelay.write(ch, block.getChannelPointer(ch), numSamples);
 
-            int samplesFirst = std::min(numSamples, DELAY_BUFFER_SIZE - wPos);
-            int samplesSecond = numSamples - samplesFirst;
-
-            std::memcpy(buf + wPos, src, samplesFirst * sizeof(double));
-            if (samplesSecond > 0)
-                std::memcpy(buf, src + samplesFirst, samplesSecond * sizeof(double));
-        }
+        const int delayRingSize = latencyDelay.capacity();
+        const int delayRingMask = latencyDelay.mask();
+        const double maxCompensatedDelay = static_cast<double>(latencyDelay.maxDelayFor(numSamples));
 
         if (activeCrossfadeGain.isSmoothing())
         {
@@ -423,9 +383,9 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
             {
                 if (samplesToRead <= 0) return;
 
-                const double* srcBuf = delayBuf[ch];
-                double rPos = static_cast<double>(activeDelayWritePos) - delay;
-                rPos -= floorNoLibm(rPos / DELAY_BUFFER_SIZE) * DELAY_BUFFER_SIZE;
+                const double* srcBuf = latencyDelay.channel(ch);
+                double rPos = static_cast<double>(latencyDelay.writePosition()) - juce::jmin(delay, maxCompensatedDelay);
+                rPos -= floorNoLibm(rPos / delayRingSize) * delayRingSize;
 
                 const int iRead = static_cast<int>(rPos);
                 const double frac = rPos - iRead;
@@ -433,7 +393,7 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
                 if (absNoLibm(frac) < 1.0e-6)
                 {
                     int rPosInt = iRead;
-                    int samplesFirst = std::min(samplesToRead, DELAY_BUFFER_SIZE - rPosInt);
+                    int samplesFirst = std::min(samplesToRead, delayRingSize - rPosInt);
                     juce::FloatVectorOperations::copy(dst, srcBuf + rPosInt, samplesFirst);
                     if (samplesToRead > samplesFirst)
                         juce::FloatVectorOperations::copy(dst + samplesFirst, srcBuf, samplesToRead - samplesFirst);
@@ -441,8 +401,8 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
                 }
                 else if (absNoLibm(frac - 1.0) < 1.0e-6)
                 {
-                    int rPosInt = (iRead + 1) & DELAY_BUFFER_MASK;
-                    int samplesFirst = std::min(samplesToRead, DELAY_BUFFER_SIZE - rPosInt);
+                    int rPosInt = (iRead + 1) & delayRingMask;
+                    int samplesFirst = std::min(samplesToRead, delayRingSize - rPosInt);
                     juce::FloatVectorOperations::copy(dst, srcBuf + rPosInt, samplesFirst);
                     if (samplesToRead > samplesFirst)
                         juce::FloatVectorOperations::copy(dst + samplesFirst, srcBuf, samplesToRead - samplesFirst);
@@ -458,7 +418,7 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
                 const double w3 =  0.5 * t3 - 0.5 * t2;
 
                 int i = 0;
-                if (iRead >= 1 && iRead + samplesToRead + 2 < DELAY_BUFFER_SIZE)
+                if (iRead >= 1 && iRead + samplesToRead + 2 < delayRingSize)
                 {
                     const double* s = srcBuf + iRead;
 #if defined(__AVX2__)
@@ -491,10 +451,10 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
                         // Shift before mask to keep subtraction in non-negative range
                         // (fully portable across C++11/14/17, not relying on two's complement
                         // guarantee that is only mandatory from C++20 onward)
-                        double p0 = srcBuf[(idx - 1 + DELAY_BUFFER_SIZE) & DELAY_BUFFER_MASK];
-                        double p1 = srcBuf[(idx)                       & DELAY_BUFFER_MASK];
-                        double p2 = srcBuf[(idx + 1)                    & DELAY_BUFFER_MASK];
-                        double p3 = srcBuf[(idx + 2)                    & DELAY_BUFFER_MASK];
+                        double p0 = srcBuf[(idx - 1 + delayRingSize) & delayRingMask];
+                        double p1 = srcBuf[(idx)                     & delayRingMask];
+                        double p2 = srcBuf[(idx + 1)                 & delayRingMask];
+                        double p3 = srcBuf[(idx + 2)                 & delayRingMask];
                         dst[i] = w0 * p0 + w1 * p1 + w2 * p2 + w3 * p3;
                     }
                 }
@@ -546,25 +506,12 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
         }
         else
         {
-            int delayInt = static_cast<int>(activeLatencySmoother.getCurrentValue() + 0.5);
-            int rPos = (activeDelayWritePos - delayInt) & DELAY_BUFFER_MASK;
-            if (rPos < 0) rPos += DELAY_BUFFER_SIZE;
-
+            const int delayInt = static_cast<int>(juce::jmin(activeLatencySmoother.getCurrentValue(), maxCompensatedDelay) + 0.5);
             for (int ch = 0; ch < procChannels; ++ch)
-            {
-                double* srcBuf = delayBuf[ch];
-                double* dstBuf = dryBuf[ch];
-
-                int samplesFirst = std::min(numSamples, DELAY_BUFFER_SIZE - rPos);
-                int samplesSecond = numSamples - samplesFirst;
-
-                juce::FloatVectorOperations::copy(dstBuf, srcBuf + rPos, samplesFirst);
-                if (samplesSecond > 0)
-                    juce::FloatVectorOperations::copy(dstBuf + samplesFirst, srcBuf, samplesSecond);
-            }
+                latencyDelay.read(ch, dryBuf[ch], numSamples, delayInt);
         }
 
-        activeDelayWritePos = (activeDelayWritePos + numSamples) & DELAY_BUFFER_MASK;
+        latencyDelay.advance(numSamples);
     }
 
     if (!needsConvolution)
@@ -581,10 +528,11 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
     }
 
     // Wet信号生成 & Mix
+    // ★ Fused mix: 畳み込み結果は GetMix がレイヤー出力とリングから直接 dry とミックスして block へ書く。
+    //   中間 wet バッファ・不足分のゼロ埋め・sanitize・ミックスの各全バッファパスは持たない
     const double headroom = CONVOLUTION_HEADROOM_GAIN;
 
-    const double* wetGains = nullptr;
-    const double* dryGains = nullptr;
+    StereoConvolver::MixGains gains;
 
     if (isSmoothing)
     {
@@ -600,160 +548,106 @@ void ConvolverProcessor::process(juce::dsp::AudioBlock<double>& block)
             wg[i] = equalPowerSin(mix)         * headroom;
             dg[i] = equalPowerSin(1.0 - mix);
         }
-        wetGains = wg;
-        dryGains = dg;
+        gains.wet = wg;
+        gains.dry = dg;
+    }
+    else
+    {
+        gains.wetConst = equalPowerSin(targetMixValue) * headroom;
+        gains.dryConst = needsDrySignal ? equalPowerSin(1.0 - targetMixValue) : 0.0;
     }
 
     const int callLen = juce::jmax(1, conv->callQuantumSamples);
 
-    auto mixSmoothingSmall = [](double* dst, const double* wet, const double* dry,
-                                const double* wetGain, const double* dryGain, int n) noexcept
+    // ★ Stereo: 2ch は L/R を同一パーティション境界で一括畳み込みする。
+    //   in-place (dst == input) でも各 chunk は Add が入力を読み終えてから同じ範囲へ書くため安全。
+    const bool stereoBatch = (procChannels == 2);
+    if (stereoBatch && split != nullptr && !conv->isTrueStereo())
     {
-#if defined(__AVX2__)
-        int i = 0;
-        const int vEnd = n / 4 * 4;
-        for (; i < vEnd; i += 4)
-        {
-            const __m256d vWet = _mm256_loadu_pd(wet + i);
-            const __m256d vDry = _mm256_loadu_pd(dry + i);
-            const __m256d vWG = _mm256_loadu_pd(wetGain + i);
-            const __m256d vDG = _mm256_loadu_pd(dryGain + i);
-            const __m256d vOut = _mm256_add_pd(_mm256_mul_pd(vWet, vWG), _mm256_mul_pd(vDry, vDG));
-            _mm256_storeu_pd(dst + i, vOut);
-        }
-        for (; i < n; ++i)
-            dst[i] = wet[i] * wetGain[i] + dry[i] * dryGain[i];
-#else
-        for (int i = 0; i < n; ++i)
-            dst[i] = wet[i] * wetGain[i] + dry[i] * dryGain[i];
-#endif
-    };
-
-    auto mixSteadySmall = [](double* dst, const double* wet, const double* dry,
-                             double wetG, double dryG, int n) noexcept
-    {
-#if defined(__AVX2__)
-        int i = 0;
-        const int vEnd = n / 4 * 4;
-        const __m256d vWG = _mm256_set1_pd(wetG);
-        const __m256d vDG = _mm256_set1_pd(dryG);
-        for (; i < vEnd; i += 4)
-        {
-            const __m256d vWet = _mm256_loadu_pd(wet + i);
-            const __m256d vDry = _mm256_loadu_pd(dry + i);
-            const __m256d vOut = _mm256_add_pd(_mm256_mul_pd(vWet, vWG), _mm256_mul_pd(vDry, vDG));
-            _mm256_storeu_pd(dst + i, vOut);
-        }
-        for (; i < n; ++i)
-            dst[i] = wet[i] * wetG + dry[i] * dryG;
-#else
-        for (int i = 0; i < n; ++i)
-            dst[i] = wet[i] * wetG + dry[i] * dryG;
-#endif
-    };
-
-    for (int ch = 0; ch < procChannels; ++ch)
+        conv->processStereoSplit(block.getChannelPointer(0), block.getChannelPointer(1),
+                                 dryBuf[0], dryBuf[1],
+                                 block.getChannelPointer(0), block.getChannelPointer(1),
+                                 numSamples, callLen, gains, *split);
+    }
+    else if (stereoBatch)
     {
-        const double* inputBase = block.getChannelPointer(ch);
-        double* wetBase = wetBuf[ch];
-        const double* dryBase = dryBuf[ch];
-        double* dstBase = block.getChannelPointer(ch);
-
         int processed = 0;
         while (processed < numSamples)
         {
             const int chunkSamples = juce::jmin(callLen, numSamples - processed);
+            conv->processStereo(block.getChannelPointer(0) + processed,
+                                block.getChannelPointer(1) + processed,
+                                dryBuf[0] + processed,
+                                dryBuf[1] + processed,
+                                block.getChannelPointer(0) + processed,
+                                block.getChannelPointer(1) + processed,
+                                chunkSamples, gains.advanced(processed));
+            processed += chunkSamples;
+        }
+    }
+    else
+    {
+        for (int ch = 0; ch < procChannels; ++ch)
+        {
+            const double* inputBase = block.getChannelPointer(ch);
+            const double* dryBase = dryBuf[ch];
+            double* dstBase = block.getChannelPointer(ch);
 
-            const double* input = inputBase + processed;
-            double* dst = dstBase + processed;
-            const double* dry = dryBase + processed;
+            int processed = 0;
+            while (processed < numSamples)
+            {
+                const int chunkSamples = juce::jmin(callLen, numSamples - processed);
 
-            const double wetG = equalPowerSin(targetMixValue) * headroom;
-            const double dryG = needsDrySignal ? equalPowerSin(1.0 - targetMixValue) : 0.0;
-            double* wetOut = wetBase + processed;
+                const double* input = inputBase + processed;
+                const double* dry = dryBase + processed;
+                double* dst = dstBase + processed;
 
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-            const uint64_t scStartUs = convo::getCurrentTimeUs();
+                const uint64_t scStartUs = convo::getCurrentTimeUs();
 #endif
-            conv->process(ch, input, wetOut, chunkSamples);
+                conv->process(ch, input, dry, dst, chunkSamples, gains.advanced(processed));
 #if CONVOPEQ_ENABLE_RUNTIME_DIAGNOSTICS
-            const uint64_t scElapsedUs = convo::getCurrentTimeUs() - scStartUs;
-            // work60: thr撤廃、callbackSeqベースのサンプリング
-            if (chunkSamples > 0 && srForConv > 0.0)
-            {
-                const uint64_t cbSeq = convo::consumeAtomic(currentCallbackSeq, std::memory_order_relaxed);
-                if ((cbSeq & CONVOPEQ_DIAG_SAMPLE_MASK) != 0)
-                    ; // skip print
-                else
+                const uint64_t scElapsedUs = convo::getCurrentTimeUs() - scStartUs;
+                // work60: thr撤廃、callbackSeqベースのサンプリング
+                if (chunkSamples > 0 && srForConv > 0.0)
                 {
-                    const double expectedUs = static_cast<double>(chunkSamples) / srForConv * 1e6;
-                    const uint32_t cpu = convo::consumeAtomic(currentCpu, std::memory_order_relaxed);
-                    const uint32_t budgetPermille = (expectedUs > 0.0)
-                        ? static_cast<uint32_t>((static_cast<double>(scElapsedUs) / expectedUs) * 1000.0)
-                        : 0;
-                    // work60: Numeric-Only DiagEvent
-                    if (convDiagBuffer != nullptr)
+                    const uint64_t cbSeq = convo::consumeAtomic(currentCallbackSeq, std::memory_order_relaxed);
+                    if ((cbSeq & CONVOPEQ_DIAG_SAMPLE_MASK) != 0)
+                        ; // skip print
+                    else
                     {
-                        DiagEvent event{};
-                        event.category = DiagCategory::StereoConvTime;
-                        event.eventIndex = cbSeq;
-                        event.data.stereoConvTime.cpu = cpu;
-                        event.data.stereoConvTime.us = scElapsedUs;
-                        event.data.stereoConvTime.chunkSamples = static_cast<uint32_t>(chunkSamples);
-                        event.data.stereoConvTime.channels = static_cast<uint8_t>(ch);
-                        event.data.stereoConvTime.budgetPercent = static_cast<uint16_t>(budgetPermille);
-                        if (convDiagBuffer->push(event))
-                        {
-                            convTickPushed->value.fetch_add(1, std::memory_order_relaxed);
-                            convTotalPushed->fetch_add(1, std::memory_order_relaxed);
-                        }
-                        else
+                        const double expectedUs = static_cast<double>(chunkSamples) / srForConv * 1e6;
+                        const uint32_t cpu = convo::consumeAtomic(currentCpu, std::memory_order_relaxed);
+                        const uint32_t budgetPermille = (expectedUs > 0.0)
+                            ? static_cast<uint32_t>((static_cast<double>(scElapsedUs) / expectedUs) * 1000.0)
+                            : 0;
+                        // work60: Numeric-Only DiagEvent
+                        if (convDiagBuffer != nullptr)
                         {
-                            convTickDropped->value.fetch_add(1, std::memory_order_relaxed);
+                            DiagEvent event{};
+                            event.category = DiagCategory::StereoConvTime;
+                            event.eventIndex = cbSeq;
+                            event.data.stereoConvTime.cpu = cpu;
+                            event.data.stereoConvTime.us = scElapsedUs;
+                            event.data.stereoConvTime.chunkSamples = static_cast<uint32_t>(chunkSamples);
+                            event.data.stereoConvTime.channels = static_cast<uint8_t>(ch);
+                            event.data.stereoConvTime.budgetPercent = static_cast<uint16_t>(budgetPermille);
+                            if (convDiagBuffer->push(event))
+                            {
+                                convTickPushed->value.fetch_add(1, std::memory_order_relaxed);
+                                convTotalPushed->fetch_add(1, std::memory_order_relaxed);
+                            }
+                            else
+                            {
+                                convTickDropped->value.fetch_add(1, std::memory_order_relaxed);
+                            }
                         }
                     }
                 }
-            }
 #endif
-            sanitizeFiniteChunk(wetOut, chunkSamples);
-
-            const double* wetSignal = wetOut;
-            int validWetSamples = chunkSamples;
 
-            if (isSmoothing)
-            {
-                if (validWetSamples > 0)
-                {
-                    const double* wetGainPtr = wetGains + processed;
-                    const double* dryGainPtr = dryGains + processed;
-                    mixSmoothingSmall(dst, wetSignal, dry, wetGainPtr, dryGainPtr, validWetSamples);
-                }
-
-                if (chunkSamples > validWetSamples)
-                {
-                    const int remainder = chunkSamples - validWetSamples;
-                    const double* remDry = dry + validWetSamples;
-                    double* remDst = dst + validWetSamples;
-                    juce::FloatVectorOperations::copy(remDst, remDry, remainder);
-                }
+                processed += chunkSamples;
             }
-            else
-            {
-                if (validWetSamples > 0)
-                {
-                    mixSteadySmall(dst, wetSignal, dry, wetG, dryG, validWetSamples);
-                }
-
-                if (chunkSamples > validWetSamples)
-                {
-                    const int remainder = chunkSamples - validWetSamples;
-                    const double* remDry = dry + validWetSamples;
-                    double* remDst = dst + validWetSamples;
-                    juce::FloatVectorOperations::copy(remDst, remDry, remainder);
-                }
-            }
-
-            processed += chunkSamples;
         }
     }
 
@@ -1029,13 +923,119 @@ void ConvolverProcessor::setMixedTransitionEndHz(float hz)
     return snapshot.mixedTransitionEndHz;
 }
 
-void ConvolverProcessor::setExperimentalDirectHeadEnabled(bool enabled)
+void ConvolverProcessor::setZeroLatencyHeadEnabled(bool enabled)
+{
+    bool prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.zeroLatencyHeadEnabled;
+        pendingOverride.zeroLatencyHeadEnabled = enabled;
+        pendingOverrideLock.exit();
+    }
+    if (prev != enabled)
+    {
+        // H4 fix: UI notification のみ。rebuild トリガーは UI layer から snapshot publication 経由で行うこと。
+        postCoalescedChangeNotification();
+    }
+}
+
+void ConvolverProcessor::setTrueStereoEnabled(bool enabled)
+{
+    bool prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.trueStereoEnabled;
+        pendingOverride.trueStereoEnabled = enabled;
+        pendingOverrideLock.exit();
+    }
+    if (prev != enabled)
+    {
+        // H4 fix: UI notification のみ。rebuild トリガーは UI layer から snapshot publication 経由で行うこと。
+        postCoalescedChangeNotification();
+    }
+}
+
+void ConvolverProcessor::setCompactTailSpectraEnabled(bool enabled)
 {
     bool prev;
     {
         pendingOverrideLock.enter();
-        prev = pendingOverride.experimentalDirectHeadEnabled;
-        pendingOverride.experimentalDirectHeadEnabled = enabled;
+        prev = pendingOverride.compactTailSpectraEnabled;
+        pendingOverride.compactTailSpectraEnabled = enabled;
+        pendingOverrideLock.exit();
+    }
+    if (prev != enabled)
+    {
+        // H4 fix: UI notification のみ。rebuild トリガーは UI layer から snapshot publication 経由で行うこと。
+        postCoalescedChangeNotification();
+    }
+}
+
+void ConvolverProcessor::setMultirateTailEnabled(bool enabled)
+{
+    bool prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.multirateTailEnabled;
+        pendingOverride.multirateTailEnabled = enabled;
+        pendingOverrideLock.exit();
+    }
+    if (prev != enabled)
+    {
+        // H4 fix: UI notification のみ。rebuild トリガーは UI layer から snapshot publication 経由で行うこと。
+        postCoalescedChangeNotification();
+    }
+}
+
+void ConvolverProcessor::setLayoutAutoTuneEnabled(bool enabled)
+{
+    bool prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.layoutAutoTuneEnabled;
+        pendingOverride.layoutAutoTuneEnabled = enabled;
+        pendingOverrideLock.exit();
+    }
+    if (prev != enabled)
+    {
+        // H4 fix: UI notification のみ。rebuild トリガーは UI layer から snapshot publication 経由で行うこと。
+        postCoalescedChangeNotification();
+    }
+}
+
+void ConvolverProcessor::setSpectralCrossfadeEnabled(bool enabled)
+{
+    bool prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.spectralCrossfadeEnabled;
+        pendingOverride.spectralCrossfadeEnabled = enabled;
+        pendingOverrideLock.exit();
+    }
+    if (prev != enabled)
+    {
+        // H4 fix: UI notification のみ。rebuild トリガーは UI layer から snapshot publication 経由で行うこと。
+        postCoalescedChangeNotification();
+    }
+}
+
+void ConvolverProcessor::setFoldedEQ(const convo::EQParameters* params)
+{
+    // 通知しない: 焼き込みの適用/解除は AudioEngine が直後に要求する rebuild でのみ反映される。
+    // (通知すると convolverParamsChanged 経由の rebuild と二重に走るため)
+    pendingOverrideLock.enter();
+    pendingOverride.eqFoldEnabled = (params != nullptr);
+    pendingOverride.eqFoldParams = (params != nullptr) ? *params : convo::EQParameters {};
+    pendingOverrideLock.exit();
+}
+
+void ConvolverProcessor::setTailWorkerOffloadEnabled(bool enabled)
+{
+    bool prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.tailWorkerOffloadEnabled;
+        pendingOverride.tailWorkerOffloadEnabled = enabled;
         pendingOverrideLock.exit();
     }
     if (prev != enabled)
@@ -1126,6 +1126,46 @@ void ConvolverProcessor::setTailStrength(float strength)
     return snapshot.tailStrength;
 }
 
+void ConvolverProcessor::setPartitionCullFloorDb(float floorDb)
+{
+    const float clamped = juce::jlimit(PARTITION_CULL_FLOOR_MIN_DB, PARTITION_CULL_FLOOR_MAX_DB, floorDb);
+    float prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.partitionCullFloorDb;
+        pendingOverride.partitionCullFloorDb = clamped;
+        pendingOverrideLock.exit();
+    }
+    if (std::abs(prev - clamped) > 1.0e-3f)
+        postCoalescedChangeNotification();
+}
+
+[[nodiscard]] float ConvolverProcessor::getPartitionCullFloorDb() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.partitionCullFloorDb;
+}
+
+void ConvolverProcessor::setFarTailHorizonSec(float horizonSec)
+{
+    const float clamped = juce::jlimit(FAR_TAIL_HORIZON_MIN_SEC, FAR_TAIL_HORIZON_MAX_SEC, horizonSec);
+    float prev;
+    {
+        pendingOverrideLock.enter();
+        prev = pendingOverride.farTailHorizonSec;
+        pendingOverride.farTailHorizonSec = clamped;
+        pendingOverrideLock.exit();
+    }
+    if (std::abs(prev - clamped) > 1.0e-3f)
+        postCoalescedChangeNotification();
+}
+
+[[nodiscard]] float ConvolverProcessor::getFarTailHorizonSec() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.farTailHorizonSec;
+}
+
 void ConvolverProcessor::setTailL1L2Multiplier(int multiplier)
 {
     const int clamped = juce::jlimit(TAIL_L1L2_MULT_MIN, TAIL_L1L2_MULT_MAX, multiplier);
@@ -1146,13 +1186,109 @@ void ConvolverProcessor::setTailL1L2Multiplier(int multiplier)
     return snapshot.tailL1L2Multiplier;
 }
 
+void ConvolverProcessor::setIrBusEntries(const IrBusEntry* entries, int count)
+{
+    std::array<IrBusEntry, kMaxIrBusEntries> clamped {};
+    const int n = (entries != nullptr) ? juce::jlimit(0, kMaxIrBusEntries, count) : 0;
+    for (int i = 0; i < n; ++i)
+    {
+        auto& e = clamped[static_cast<size_t>(i)];
+        e.file = entries[i].file;
+        e.gainDb = juce::jlimit(IR_BUS_GAIN_MIN_DB, IR_BUS_GAIN_MAX_DB, entries[i].gainDb);
+        e.preDelayMs = juce::jlimit(0.0f, IR_BUS_PRE_DELAY_MAX_MS, entries[i].preDelayMs);
+        e.tailSec = juce::jlimit(0.0f, IR_LENGTH_MAX_SEC, entries[i].tailSec);
+        e.tailFadeMs = juce::jlimit(0.0f, IR_BUS_TAIL_FADE_MAX_MS, entries[i].tailFadeMs);
+    }
+
+    bool changed;
+    {
+        pendingOverrideLock.enter();
+        changed = (pendingOverride.irBusCount != n);
+        for (int i = 0; i < n && !changed; ++i)
+        {
+            const auto& a = pendingOverride.irBus[static_cast<size_t>(i)];
+            const auto& b = clamped[static_cast<size_t>(i)];
+            changed = a.file != b.file || a.gainDb != b.gainDb || a.preDelayMs != b.preDelayMs
+                   || a.tailSec != b.tailSec || a.tailFadeMs != b.tailFadeMs;
+        }
+        pendingOverride.irBus = clamped;
+        pendingOverride.irBusCount = n;
+        pendingOverrideLock.exit();
+    }
+    if (changed)
+        postCoalescedChangeNotification();
+}
+
+[[nodiscard]] int ConvolverProcessor::getIrBusEntryCount() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.irBusCount;
+}
+
+[[nodiscard]] ConvolverProcessor::IrBusEntry ConvolverProcessor::getIrBusEntry(int index) const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    if (index < 0 || index >= snapshot.irBusCount)
+        return {};
+    return snapshot.irBus[static_cast<size_t>(index)];
+}
+
+void ConvolverProcessor::setSpectralMorphTarget(const juce::File& file)
+{
+    bool changed;
+    {
+        pendingOverrideLock.enter();
+        changed = (pendingOverride.spectralMorphFile != file);
+        pendingOverride.spectralMorphFile = file;
+        pendingOverrideLock.exit();
+    }
+    if (!changed)
+        return;
+
+    // 解除は再構築を待たずに切り離す (m は即座に 0。NUC の資源は cleanup の finishSpectralMorph が返す)
+    if (file == juce::File())
+        if (auto* liveEngine = loadActiveEngine(std::memory_order_acquire)) // acquire: exchangeActiveEngine acq_rel/release と HB
+            liveEngine->endSpectralMorph();
+    postCoalescedChangeNotification();
+}
+
+[[nodiscard]] juce::File ConvolverProcessor::getSpectralMorphTarget() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.spectralMorphFile;
+}
+
+void ConvolverProcessor::setSpectralMorphAmount(float amount)
+{
+    const float newVal = juce::jlimit(0.0f, 1.0f, amount);
+    bool changed;
+    {
+        pendingOverrideLock.enter();
+        changed = (pendingOverride.spectralMorphAmount != newVal);
+        pendingOverride.spectralMorphAmount = newVal;
+        pendingOverrideLock.exit();
+    }
+    if (changed)
+    {
+        publishRuntimeProcessSnapshot();
+        postCoalescedChangeNotification();
+    }
+}
+
+[[nodiscard]] float ConvolverProcessor::getSpectralMorphAmount() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.spectralMorphAmount;
+}
+
 void ConvolverProcessor::StereoConvolver::reset()
 {
     if (nucConvolvers[0]) nucConvolvers[0]->Reset();
     if (nucConvolvers[1]) nucConvolvers[1]->Reset();
 }
 
-void ConvolverProcessor::StereoConvolver::process(int channel, const double* in, double* out, int numSamples)
+void ConvolverProcessor::StereoConvolver::process(int channel, const double* in, const double* dry, double* out,
+                                                  int numSamples, const MixGains& gains)
 {
 #ifdef NUC_DEBUG_GUARDS
     if (nucConvolvers[channel])
@@ -1162,16 +1298,66 @@ void ConvolverProcessor::StereoConvolver::process(int channel, const double* in,
     if (channel < 0 || channel >= 2 || !nucConvolvers[channel] || numSamples <= 0)
     {
         if (numSamples > 0)
-            std::memset(out, 0, numSamples * sizeof(double));
+            writeDryOnly(out, dry, numSamples, gains);
         return;
     }
 
     nucConvolvers[channel]->Add(in, numSamples);
-    const int got = nucConvolvers[channel]->Get(out, numSamples);
+    // GetMix はリング不足分を wet=0 として dry のみで埋める (旧 Get + memset + mix と同じ結果)
+    const int got = nucConvolvers[channel]->GetMix(dry, out, numSamples, gains);
     // ★ bug3-8: got >= 0 && got <= numSamples の防御チェック
     jassert(got >= 0 && got <= numSamples);
-    if (got < numSamples)
-        std::memset(out + got, 0, (numSamples - got) * sizeof(double));
+    juce::ignoreUnused(got);
+}
+
+void ConvolverProcessor::StereoConvolver::processStereo(const double* inL, const double* inR,
+                                                        const double* dryL, const double* dryR,
+                                                        double* outL, double* outR, int numSamples,
+                                                        const MixGains& gains)
+{
+    if (!nucConvolvers[0] || !nucConvolvers[1] || numSamples <= 0)
+    {
+        process(0, inL, dryL, outL, numSamples, gains);
+        process(1, inR, dryR, outR, numSamples, gains);
+        return;
+    }
+
+    convo::MKLNonUniformConvolver::AddStereo(*nucConvolvers[0], *nucConvolvers[1], inL, inR, numSamples);
+
+    const double* drys[2] = { dryL, dryR };
+    double* outs[2] = { outL, outR };
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const int got = nucConvolvers[ch]->GetMix(drys[ch], outs[ch], numSamples, gains);
+        // ★ bug3-8: got >= 0 && got <= numSamples の防御チェック
+        jassert(got >= 0 && got <= numSamples);
+        juce::ignoreUnused(got);
+    }
+}
+
+void ConvolverProcessor::StereoConvolver::processStereoSplit(const double* inL, const double* inR,
+                                                             const double* dryL, const double* dryR,
+                                                             double* outL, double* outR,
+                                                             int numSamples, int callLen,
+                                                             const MixGains& gains,
+                                                             convo::ChannelForkJoin& split)
+{
+    // 各チャンネルの MKLNonUniformConvolver (FDL・Tail Worker・direct head) は独立。共有 IR スペクトルは読み取りのみ
+    auto runChannel = [this, numSamples, callLen, &gains](int channel, const double* in, const double* dry, double* out) noexcept
+    {
+        int processed = 0;
+        while (processed < numSamples)
+        {
+            const int chunkSamples = std::min(callLen, numSamples - processed);
+            process(channel, in + processed, dry + processed, out + processed, chunkSamples, gains.advanced(processed));
+            processed += chunkSamples;
+        }
+    };
+    auto runRight = [&runChannel, inR, dryR, outR]() noexcept { runChannel(1, inR, dryR, outR); };
+
+    split.fork([](void* context) noexcept { (*static_cast<decltype(runRight)*>(context))(); }, &runRight);
+    runChannel(0, inL, dryL, outL);
+    split.join();
 }
 
 #endif // CONVOPEQ_ENABLE_CONVOLVER_SPLIT_RUNTIME
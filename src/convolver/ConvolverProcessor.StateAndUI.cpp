@@ -42,7 +42,15 @@ std::uint64_t computeBuildSnapshotFingerprint(const ConvolverProcessor::BuildSna
     hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(snapshot.mixedTransitionStartHz)));
     hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(snapshot.mixedTransitionEndHz)));
     hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.rebuildDebounceMs));
-    hashCombineUInt64(hash, snapshot.experimentalDirectHeadEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, snapshot.zeroLatencyHeadEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, snapshot.tailWorkerOffloadEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, snapshot.trueStereoEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, snapshot.compactTailSpectraEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, snapshot.multirateTailEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, snapshot.layoutAutoTuneEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, snapshot.spectralCrossfadeEnabled ? 1ULL : 0ULL);
+    hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(snapshot.partitionCullFloorDb)));
+    hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(snapshot.farTailHorizonSec)));
     hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.tailMode));
     hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(snapshot.tailStartSec)));
     hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(snapshot.tailStrength)));
@@ -50,11 +58,32 @@ std::uint64_t computeBuildSnapshotFingerprint(const ConvolverProcessor::BuildSna
     hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.targetUpgradeFFTSize));
     hashCombineUInt64(hash, snapshot.enableProgressiveUpgrade ? 1ULL : 0ULL);
     hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.maxCacheEntries));
+    hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(snapshot.spectralMorphAmount)));
 
     // ---- NUC フィルターモード ----
     hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.nucHCMode));
     hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.nucLCMode));
 
+    // ---- EQ fold ----
+    hashCombineUInt64(hash, snapshot.eqFoldEnabled ? 1ULL : 0ULL);
+    if (snapshot.eqFoldEnabled)
+        hashCombineUInt64(hash, EQProcessor::computeParamsHash(snapshot.eqFoldParams));
+
+    // ---- IR bus ----
+    hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.irBusCount));
+    for (int i = 0; i < snapshot.irBusCount; ++i)
+    {
+        const auto& entry = snapshot.irBus[static_cast<size_t>(i)];
+        hashCombineUInt64(hash, static_cast<std::uint64_t>(entry.file.getFullPathName().hashCode64()));
+        hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(entry.gainDb)));
+        hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(entry.preDelayMs)));
+        hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(entry.tailSec)));
+        hashCombineUInt64(hash, static_cast<std::uint64_t>(floatBits(entry.tailFadeMs)));
+    }
+
+    // ---- Spectral morph ----
+    hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.spectralMorphFile.getFullPathName().hashCode64()));
+
     // ---- メタデータ（snapshot 同一性確認用）----
     hashCombineUInt64(hash, static_cast<std::uint64_t>(snapshot.irLength));
 
@@ -131,7 +160,17 @@ void ConvolverProcessor::copyPendingToSnapshotUnlocked(BuildSnapshot& snapshot)
     snapshot.mixedTransitionStartHz = pendingOverride.mixedTransitionStartHz;
     snapshot.mixedTransitionEndHz = pendingOverride.mixedTransitionEndHz;
     snapshot.rebuildDebounceMs = pendingOverride.rebuildDebounceMs;
-    snapshot.experimentalDirectHeadEnabled = pendingOverride.experimentalDirectHeadEnabled;
+    snapshot.zeroLatencyHeadEnabled = pendingOverride.zeroLatencyHeadEnabled;
+    snapshot.tailWorkerOffloadEnabled = pendingOverride.tailWorkerOffloadEnabled;
+    snapshot.trueStereoEnabled = pendingOverride.trueStereoEnabled;
+    snapshot.compactTailSpectraEnabled = pendingOverride.compactTailSpectraEnabled;
+    snapshot.multirateTailEnabled = pendingOverride.multirateTailEnabled;
+    snapshot.layoutAutoTuneEnabled = pendingOverride.layoutAutoTuneEnabled;
+    snapshot.spectralCrossfadeEnabled = pendingOverride.spectralCrossfadeEnabled;
+    snapshot.streamingIRActivationEnabled = pendingOverride.streamingIRActivationEnabled;
+    snapshot.spectralMorphAmount = pendingOverride.spectralMorphAmount;
+    snapshot.partitionCullFloorDb = pendingOverride.partitionCullFloorDb;
+    snapshot.farTailHorizonSec = pendingOverride.farTailHorizonSec;
     snapshot.tailMode = pendingOverride.tailMode;
     snapshot.tailStartSec = pendingOverride.tailStartSec;
     snapshot.tailStrength = pendingOverride.tailStrength;
@@ -141,6 +180,11 @@ void ConvolverProcessor::copyPendingToSnapshotUnlocked(BuildSnapshot& snapshot)
     snapshot.maxCacheEntries = pendingOverride.maxCacheEntries;
     snapshot.nucHCMode = pendingOverride.nucHCMode;
     snapshot.nucLCMode = pendingOverride.nucLCMode;
+    snapshot.eqFoldEnabled = pendingOverride.eqFoldEnabled;
+    snapshot.eqFoldParams = pendingOverride.eqFoldParams;
+    snapshot.irBus = pendingOverride.irBus;
+    snapshot.irBusCount = pendingOverride.irBusCount;
+    snapshot.spectralMorphFile = pendingOverride.spectralMorphFile;
 }
 
 void ConvolverProcessor::copySnapshotToPendingUnlocked(const BuildSnapshot& snapshot) noexcept
@@ -175,7 +219,20 @@ void ConvolverProcessor::copySnapshotToPendingUnlocked(const BuildSnapshot& snap
     pendingOverride.rebuildDebounceMs = juce::jlimit(REBUILD_DEBOUNCE_MIN_MS,
                                                      REBUILD_DEBOUNCE_MAX_MS,
                                                      snapshot.rebuildDebounceMs);
-    pendingOverride.experimentalDirectHeadEnabled = snapshot.experimentalDirectHeadEnabled;
+    pendingOverride.zeroLatencyHeadEnabled = snapshot.zeroLatencyHeadEnabled;
+    pendingOverride.tailWorkerOffloadEnabled = snapshot.tailWorkerOffloadEnabled;
+    pendingOverride.trueStereoEnabled = snapshot.trueStereoEnabled;
+    pendingOverride.compactTailSpectraEnabled = snapshot.compactTailSpectraEnabled;
+    pendingOverride.multirateTailEnabled = snapshot.multirateTailEnabled;
+    pendingOverride.layoutAutoTuneEnabled = snapshot.layoutAutoTuneEnabled;
+    pendingOverride.spectralCrossfadeEnabled = snapshot.spectralCrossfadeEnabled;
+    pendingOverride.streamingIRActivationEnabled = snapshot.streamingIRActivationEnabled;
+    pendingOverride.partitionCullFloorDb = juce::jlimit(PARTITION_CULL_FLOOR_MIN_DB,
+                                                        PARTITION_CULL_FLOOR_MAX_DB,
+                                                        snapshot.partitionCullFloorDb);
+    pendingOverride.farTailHorizonSec = juce::jlimit(FAR_TAIL_HORIZON_MIN_SEC,
+                                                     FAR_TAIL_HORIZON_MAX_SEC,
+                                                     snapshot.farTailHorizonSec);
     pendingOverride.tailMode = juce::jlimit(static_cast<int>(TailMode::AirAbsorption),
                                             static_cast<int>(TailMode::Bypass),
                                             snapshot.tailMode);
@@ -197,6 +254,12 @@ void ConvolverProcessor::copySnapshotToPendingUnlocked(const BuildSnapshot& snap
     pendingOverride.nucLCMode = juce::jlimit(static_cast<int>(convo::LCMode::Natural),
                                              static_cast<int>(convo::LCMode::Soft),
                                              snapshot.nucLCMode);
+    pendingOverride.eqFoldEnabled = snapshot.eqFoldEnabled;
+    pendingOverride.eqFoldParams = snapshot.eqFoldParams;
+    pendingOverride.irBus = snapshot.irBus;
+    pendingOverride.irBusCount = juce::jlimit(0, kMaxIrBusEntries, snapshot.irBusCount);
+    pendingOverride.spectralMorphAmount = juce::jlimit(0.0f, 1.0f, snapshot.spectralMorphAmount);
+    pendingOverride.spectralMorphFile = snapshot.spectralMorphFile;
 }
 
 [[nodiscard]] juce::ValueTree ConvolverProcessor::getState() const
@@ -232,14 +295,66 @@ void ConvolverProcessor::copySnapshotToPendingUnlocked(const BuildSnapshot& snap
     v.setProperty ("mixedF1Hz", mixF1, nullptr);
     v.setProperty ("mixedF2Hz", mixF2, nullptr);
     v.setProperty ("rebuildDebounceMs", getRebuildDebounceMs(), nullptr);
-    v.setProperty ("experimentalDirectHeadEnabled", getExperimentalDirectHeadEnabled(), nullptr);
+    v.setProperty ("zeroLatencyHeadEnabled", getZeroLatencyHeadEnabled(), nullptr);
+    v.setProperty ("tailWorkerOffloadEnabled", getTailWorkerOffloadEnabled(), nullptr);
+    v.setProperty ("trueStereoEnabled", getTrueStereoEnabled(), nullptr);
+    v.setProperty ("compactTailSpectraEnabled", getCompactTailSpectraEnabled(), nullptr);
+    v.setProperty ("multirateTailEnabled", getMultirateTailEnabled(), nullptr);
+    v.setProperty ("layoutAutoTuneEnabled", getLayoutAutoTuneEnabled(), nullptr);
+    v.setProperty ("spectralCrossfadeEnabled", getSpectralCrossfadeEnabled(), nullptr);
+    v.setProperty ("partitionCullFloorDb", getPartitionCullFloorDb(), nullptr);
+    v.setProperty ("farTailHorizonSec", getFarTailHorizonSec(), nullptr);
     v.setProperty ("tailMode", tailMode, nullptr);
     v.setProperty ("tailStartSec", tailStart, nullptr);
     v.setProperty ("tailStrength", tailStrength, nullptr);
     v.setProperty ("tailL1L2Multiplier", tailMult, nullptr);
     v.setProperty ("targetUpgradeFFTSize", getTargetUpgradeFFTSize(), nullptr);
     v.setProperty ("enableProgressiveUpgrade", isProgressiveUpgradeEnabled(), nullptr);
+    v.setProperty ("streamingIRActivation", isStreamingIRActivationEnabled(), nullptr);
+    v.setProperty ("incrementalRebuild", isIncrementalRebuildEnabled(), nullptr);
     v.setProperty ("maxCacheEntries", static_cast<int>(getMaxCacheEntries()), nullptr);
+    v.setProperty ("resampledIRCacheBudgetBytes", static_cast<juce::int64>(getResampledIRCacheBudgetBytes()), nullptr);
+    {
+        juce::StringArray rates;
+        for (const double rate : getStandbySampleRates())
+            rates.add(juce::String(rate, 1));
+        v.setProperty ("standbySampleRates", rates.joinIntoString(","), nullptr);
+    }
+    v.setProperty ("standbyBudgetBytes", static_cast<juce::int64>(getStandbyBudgetBytes()), nullptr);
+    {
+        juce::StringArray paths;
+        for (const auto& file : getRecentIRFiles())
+            paths.add(file.getFullPathName());
+        v.setProperty ("recentIRPaths", paths.joinIntoString("\n"), nullptr);
+    }
+    {
+        juce::StringArray dirs;
+        for (const auto& dir : getIRLibraryDirectories())
+            dirs.add(dir.getFullPathName());
+        v.setProperty ("irLibraryDirectories", dirs.joinIntoString("\n"), nullptr);
+    }
+    v.setProperty ("cachePrefetchCount", getCachePrefetchCount(), nullptr);
+    v.setProperty ("cachePrefetchBudgetBytes", static_cast<juce::int64>(getCachePrefetchBudgetBytes()), nullptr);
+    v.setProperty ("cacheCompressionEnabled", isCacheCompressionEnabled(), nullptr);
+    v.setProperty ("cacheDiskBudgetBytes", static_cast<juce::int64>(getCacheDiskBudgetBytes()), nullptr);
+    v.setProperty ("cacheCostWeightedEviction", isCacheCostWeightedEviction(), nullptr);
+    {
+        juce::ValueTree bus ("IrBus");
+        for (int i = 0; i < getIrBusEntryCount(); ++i)
+        {
+            const IrBusEntry entry = getIrBusEntry(i);
+            juce::ValueTree e ("Entry");
+            e.setProperty ("path", entry.file.getFullPathName(), nullptr);
+            e.setProperty ("gainDb", entry.gainDb, nullptr);
+            e.setProperty ("preDelayMs", entry.preDelayMs, nullptr);
+            e.setProperty ("tailSec", entry.tailSec, nullptr);
+            e.setProperty ("tailFadeMs", entry.tailFadeMs, nullptr);
+            bus.appendChild (e, nullptr);
+        }
+        v.appendChild (bus, nullptr);
+    }
+    v.setProperty ("spectralMorphPath", getSpectralMorphTarget().getFullPathName(), nullptr);
+    v.setProperty ("spectralMorphAmount", getSpectralMorphAmount(), nullptr);
     {
         const juce::ScopedLock sl(irFileLock);
         v.setProperty ("irPath", currentIrFile.getFullPathName(), nullptr);
@@ -259,6 +374,7 @@ void ConvolverProcessor::copySnapshotToPendingUnlocked(const BuildSnapshot& snap
 
     snapshot.irLength = convo::consumeAtomic(irLength, std::memory_order_acquire); // acquire: applyBuildSnapshot の publishAtomic release と HB
     snapshot.currentIRScale = convo::consumeAtomic(currentIRScale, std::memory_order_acquire); // acquire: applyBuildSnapshot の publishAtomic release と HB
+    snapshot.incrementalRebuildEnabled = isIncrementalRebuildEnabled();
     {
         const juce::ScopedLock sl(irFileLock);
         snapshot.irFile = currentIrFile;
@@ -282,6 +398,7 @@ void ConvolverProcessor::applyBuildSnapshot(const BuildSnapshot& snapshot)
     }
     convo::publishAtomic(irLength, snapshot.irLength, std::memory_order_release); // release: captureBuildSnapshot の acquire と HB
     convo::publishAtomic(currentIRScale, snapshot.currentIRScale, std::memory_order_release); // release: captureBuildSnapshot の acquire と HB
+    convo::publishAtomic(useIncrementalRebuild, snapshot.incrementalRebuildEnabled, std::memory_order_release); // release: isIncrementalRebuildEnabled の acquire と HB
 
     publishRuntimeProcessSnapshot();
 }
@@ -346,7 +463,16 @@ void ConvolverProcessor::setState(const juce::ValueTree& v)
     if (v.hasProperty ("mixedF1Hz")) setMixedTransitionStartHz (v.getProperty ("mixedF1Hz"));
     if (v.hasProperty ("mixedF2Hz")) setMixedTransitionEndHz (v.getProperty ("mixedF2Hz"));
     if (v.hasProperty ("rebuildDebounceMs")) setRebuildDebounceMs (static_cast<int>(v.getProperty("rebuildDebounceMs")));
-    if (v.hasProperty ("experimentalDirectHeadEnabled")) setExperimentalDirectHeadEnabled (v.getProperty ("experimentalDirectHeadEnabled"));
+    if (v.hasProperty ("zeroLatencyHeadEnabled")) setZeroLatencyHeadEnabled (v.getProperty ("zeroLatencyHeadEnabled"));
+    else if (v.hasProperty ("experimentalDirectHeadEnabled")) setZeroLatencyHeadEnabled (v.getProperty ("experimentalDirectHeadEnabled")); // 旧名の保存状態
+    if (v.hasProperty ("tailWorkerOffloadEnabled")) setTailWorkerOffloadEnabled (v.getProperty ("tailWorkerOffloadEnabled"));
+    if (v.hasProperty ("trueStereoEnabled")) setTrueStereoEnabled (v.getProperty ("trueStereoEnabled"));
+    if (v.hasProperty ("compactTailSpectraEnabled")) setCompactTailSpectraEnabled (v.getProperty ("compactTailSpectraEnabled"));
+    if (v.hasProperty ("multirateTailEnabled")) setMultirateTailEnabled (v.getProperty ("multirateTailEnabled"));
+    if (v.hasProperty ("layoutAutoTuneEnabled")) setLayoutAutoTuneEnabled (v.getProperty ("layoutAutoTuneEnabled"));
+    if (v.hasProperty ("spectralCrossfadeEnabled")) setSpectralCrossfadeEnabled (v.getProperty ("spectralCrossfadeEnabled"));
+    if (v.hasProperty ("partitionCullFloorDb")) setPartitionCullFloorDb (static_cast<float>(v.getProperty ("partitionCullFloorDb")));
+    if (v.hasProperty ("farTailHorizonSec")) setFarTailHorizonSec (static_cast<float>(v.getProperty ("farTailHorizonSec")));
 
     if (v.hasProperty ("tailMode"))
         setTailMode(static_cast<TailMode>(juce::jlimit(static_cast<int>(TailMode::AirAbsorption),
@@ -359,7 +485,81 @@ void ConvolverProcessor::setState(const juce::ValueTree& v)
 
     if (v.hasProperty ("targetUpgradeFFTSize")) setTargetUpgradeFFTSize (static_cast<int>(v.getProperty("targetUpgradeFFTSize")));
     if (v.hasProperty ("enableProgressiveUpgrade")) setEnableProgressiveUpgrade (static_cast<bool>(v.getProperty("enableProgressiveUpgrade")));
+    if (v.hasProperty ("streamingIRActivation")) setStreamingIRActivationEnabled (static_cast<bool>(v.getProperty("streamingIRActivation")));
+    if (v.hasProperty ("incrementalRebuild")) setUseIncrementalRebuild (static_cast<bool>(v.getProperty("incrementalRebuild")));
     if (v.hasProperty ("maxCacheEntries")) setMaxCacheEntries (static_cast<size_t>(static_cast<int>(v.getProperty("maxCacheEntries"))));
+    if (v.hasProperty ("resampledIRCacheBudgetBytes"))
+        setResampledIRCacheBudgetBytes (static_cast<size_t>(juce::jmax<juce::int64>(0, static_cast<juce::int64>(v.getProperty("resampledIRCacheBudgetBytes")))));
+    if (v.hasProperty ("standbyBudgetBytes"))
+        setStandbyBudgetBytes (static_cast<size_t>(juce::jmax<juce::int64>(0, static_cast<juce::int64>(v.getProperty("standbyBudgetBytes")))));
+    if (v.hasProperty ("standbySampleRates"))
+    {
+        std::vector<double> rates;
+        for (const auto& token : juce::StringArray::fromTokens(v.getProperty("standbySampleRates").toString(), ",", ""))
+        {
+            if (token.trim().isNotEmpty())
+                rates.push_back(token.trim().getDoubleValue());
+        }
+        setStandbySampleRates (std::move(rates));
+    }
+    if (v.hasProperty ("recentIRPaths"))
+    {
+        std::vector<juce::File> files;
+        for (const auto& path : juce::StringArray::fromLines(v.getProperty("recentIRPaths").toString()))
+        {
+            if (juce::File::isAbsolutePath(path.trim()))
+                files.emplace_back(path.trim());
+        }
+        setRecentIRFiles (std::move(files));
+    }
+    if (v.hasProperty ("irLibraryDirectories"))
+    {
+        std::vector<juce::File> dirs;
+        for (const auto& path : juce::StringArray::fromLines(v.getProperty("irLibraryDirectories").toString()))
+        {
+            if (juce::File::isAbsolutePath(path.trim()))
+                dirs.emplace_back(path.trim());
+        }
+        setIRLibraryDirectories (std::move(dirs));
+    }
+    if (v.hasProperty ("cachePrefetchBudgetBytes"))
+        setCachePrefetchBudgetBytes (static_cast<size_t>(juce::jmax<juce::int64>(0, static_cast<juce::int64>(v.getProperty("cachePrefetchBudgetBytes")))));
+    if (v.hasProperty ("cacheCostWeightedEviction"))
+        setCacheCostWeightedEviction (static_cast<bool>(v.getProperty("cacheCostWeightedEviction")));
+    if (v.hasProperty ("cacheDiskBudgetBytes"))
+        setCacheDiskBudgetBytes (static_cast<uint64_t>(juce::jmax<juce::int64>(0, static_cast<juce::int64>(v.getProperty("cacheDiskBudgetBytes")))));
+    if (v.hasProperty ("cacheCompressionEnabled"))
+        setCacheCompressionEnabled (static_cast<bool>(v.getProperty("cacheCompressionEnabled")));
+    if (v.hasProperty ("cachePrefetchCount"))
+        setCachePrefetchCount (static_cast<int>(v.getProperty("cachePrefetchCount")));
+
+    // IR bus は irPath の読み込み (ビルド) より前に反映する。子ノードがない旧状態は変更しない
+    if (const auto bus = v.getChildWithName ("IrBus"); bus.isValid())
+    {
+        std::array<IrBusEntry, kMaxIrBusEntries> entries {};
+        int count = 0;
+        for (const auto& e : bus)
+        {
+            const juce::String path = e.getProperty ("path").toString();
+            if (count >= kMaxIrBusEntries || !juce::File::isAbsolutePath(path))
+                continue;
+            auto& entry = entries[static_cast<size_t>(count++)];
+            entry.file = juce::File(path);
+            entry.gainDb = static_cast<float>(e.getProperty ("gainDb", 0.0f));
+            entry.preDelayMs = static_cast<float>(e.getProperty ("preDelayMs", 0.0f));
+            entry.tailSec = static_cast<float>(e.getProperty ("tailSec", 0.0f));
+            entry.tailFadeMs = static_cast<float>(e.getProperty ("tailFadeMs", 0.0f));
+        }
+        setIrBusEntries(entries.data(), count);
+    }
+    // モーフ先も irPath より前に反映する (空文字列 = なし)
+    if (v.hasProperty ("spectralMorphPath"))
+    {
+        const juce::String path = v.getProperty ("spectralMorphPath").toString();
+        setSpectralMorphTarget(juce::File::isAbsolutePath(path) ? juce::File(path) : juce::File());
+    }
+    if (v.hasProperty ("spectralMorphAmount"))
+        setSpectralMorphAmount (static_cast<float>(v.getProperty ("spectralMorphAmount")));
 
     if (v.hasProperty ("irPath"))
     {
@@ -396,7 +596,8 @@ void ConvolverProcessor::syncStateFrom(const ConvolverProcessor& other)
     if (const IRState* otherState = other.acquireIRState())
     {
         if (otherState->irOwner)
-            updateIRState(otherState->irOwner, otherState->sampleRate, otherState->additionalAttenuationDb, otherState->irFreqPeakGainDb);
+            updateIRState(otherState->irOwner, otherState->sampleRate, otherState->additionalAttenuationDb, otherState->irFreqPeakGainDb,
+                          otherState->headEnergyRatio);
         releaseIRState(otherState);
     }
     // ★ currentIrFile / irName は captureBuildSnapshot → applyBuildSnapshot で
@@ -445,11 +646,12 @@ void ConvolverProcessor::shareConvolutionEngineFrom(const ConvolverProcessor& ot
     requestHostDisplayUpdate();
 }
 
-[[nodiscard]] ConvolverProcessor::IRLoadPreview ConvolverProcessor::analyzeImpulseResponseFile(const juce::File& irFile, double processingSampleRate)
+[[nodiscard]] ConvolverProcessor::IRLoadPreview ConvolverProcessor::analyzeImpulseResponseFile(const juce::File& irFile, double processingSampleRate,
+                                                                                               bool farTailPaging)
 {
     IRLoadPreview preview;
     preview.recommendedMaxSec = IR_LENGTH_MAX_SEC;
-    preview.hardMaxSec = getMaximumAllowedIRLengthSecForSampleRate(processingSampleRate);
+    preview.hardMaxSec = getMaximumAllowedIRLengthSecForSampleRate(processingSampleRate, farTailPaging);
 
     juce::AudioBuffer<double> loadedIR;
     double loadedSampleRate = 0.0;
@@ -857,13 +1059,42 @@ void ConvolverProcessor::setNUCFilterModes(convo::HCMode hcMode, convo::LCMode l
     hashCombine(floatBits(snapshot.mixedTransitionStartHz));
     hashCombine(floatBits(snapshot.mixedTransitionEndHz));
 
-    hashCombine(snapshot.experimentalDirectHeadEnabled ? 1ULL : 0ULL);
+    hashCombine(snapshot.zeroLatencyHeadEnabled ? 1ULL : 0ULL);
+    hashCombine(snapshot.tailWorkerOffloadEnabled ? 1ULL : 0ULL);
+    hashCombine(snapshot.trueStereoEnabled ? 1ULL : 0ULL);
+    hashCombine(snapshot.compactTailSpectraEnabled ? 1ULL : 0ULL);
+    hashCombine(snapshot.multirateTailEnabled ? 1ULL : 0ULL);
+    hashCombine(snapshot.layoutAutoTuneEnabled ? 1ULL : 0ULL);
+    hashCombine(floatBits(snapshot.partitionCullFloorDb));
+    hashCombine(floatBits(snapshot.farTailHorizonSec));
     hashCombine(static_cast<uint64_t>(snapshot.nucHCMode));
     hashCombine(static_cast<uint64_t>(snapshot.nucLCMode));
     hashCombine(static_cast<uint64_t>(snapshot.tailMode));
     hashCombine(floatBits(snapshot.tailStartSec));
     hashCombine(floatBits(snapshot.tailStrength));
     hashCombine(static_cast<uint64_t>(snapshot.tailL1L2Multiplier));
+    hashCombine(snapshot.eqFoldEnabled ? EQProcessor::computeParamsHash(snapshot.eqFoldParams) : 0ULL);
+
+    // ★ IR bus: ゲインは spectral bus で再構築なしに反映するため対象外。焼き込みになり得る構成
+    //   (True-stereo / Direct Head / Far-tail paging) では再構築が必要なので含める。
+    //   稼働中エンジンではなく設定で決める (構築のたびにハッシュが変わり rebuild が連鎖しないように)
+    const bool irBusGainsLive = !snapshot.trueStereoEnabled && !snapshot.zeroLatencyHeadEnabled
+                             && !(snapshot.farTailHorizonSec > 0.0f)
+                             && snapshot.spectralMorphFile == juce::File();   // モーフ先がある間は焼き込み
+    hashCombine(static_cast<uint64_t>(snapshot.irBusCount));
+    for (int i = 0; i < snapshot.irBusCount; ++i)
+    {
+        const auto& entry = snapshot.irBus[static_cast<size_t>(i)];
+        hashCombine(static_cast<uint64_t>(entry.file.getFullPathName().hashCode64()));
+        hashCombine(floatBits(entry.preDelayMs));
+        hashCombine(floatBits(entry.tailSec));
+        hashCombine(floatBits(entry.tailFadeMs));
+        if (!irBusGainsLive)
+            hashCombine(floatBits(entry.gainDb));
+    }
+
+    // ★ Spectral morph: モーフ先は構築対象。モーフ量 (spectralMorphAmount) は再構築なしに反映するため対象外
+    hashCombine(static_cast<uint64_t>(snapshot.spectralMorphFile.getFullPathName().hashCode64()));
 
     return hash;
 }
@@ -912,18 +1143,97 @@ void ConvolverProcessor::setResamplingPhaseMode(ResamplingPhaseMode mode)
     return static_cast<ResamplingPhaseMode>(mode);
 }
 
-[[nodiscard]] bool ConvolverProcessor::getExperimentalDirectHeadEnabled() const
+[[nodiscard]] bool ConvolverProcessor::getZeroLatencyHeadEnabled() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.zeroLatencyHeadEnabled;
+}
+
+[[nodiscard]] bool ConvolverProcessor::getTailWorkerOffloadEnabled() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.tailWorkerOffloadEnabled;
+}
+
+[[nodiscard]] bool ConvolverProcessor::getTrueStereoEnabled() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.trueStereoEnabled;
+}
+
+[[nodiscard]] bool ConvolverProcessor::getCompactTailSpectraEnabled() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.compactTailSpectraEnabled;
+}
+
+[[nodiscard]] bool ConvolverProcessor::getMultirateTailEnabled() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.multirateTailEnabled;
+}
+
+[[nodiscard]] bool ConvolverProcessor::getLayoutAutoTuneEnabled() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.layoutAutoTuneEnabled;
+}
+
+[[nodiscard]] bool ConvolverProcessor::getSpectralCrossfadeEnabled() const
+{
+    const BuildSnapshot snapshot = captureBuildSnapshot();
+    return snapshot.spectralCrossfadeEnabled;
+}
+
+[[nodiscard]] bool ConvolverProcessor::hasFoldedEQ() const
 {
     const BuildSnapshot snapshot = captureBuildSnapshot();
-    return snapshot.experimentalDirectHeadEnabled;
+    return snapshot.eqFoldEnabled;
 }
 
-[[nodiscard]] float ConvolverProcessor::getMaximumAllowedIRLengthSecForSampleRate(double sampleRate)
+[[nodiscard]] bool ConvolverProcessor::isEQFoldedIntoIR() const noexcept
+{
+    struct GlobalGuard {
+        const ConvolverProcessor& cp;
+        GlobalGuard(const ConvolverProcessor& cp_) : cp(cp_) { cp.enterGlobalReader(2); }
+        ~GlobalGuard() { cp.exitGlobalReader(2); }
+    } guard(*this);
+
+    const auto* conv = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel と HB
+    return conv != nullptr && conv->eqFoldedIntoIR;
+}
+
+[[nodiscard]] bool ConvolverProcessor::isIrBusLive() const noexcept
+{
+    struct GlobalGuard {
+        const ConvolverProcessor& cp;
+        GlobalGuard(const ConvolverProcessor& cp_) : cp(cp_) { cp.enterGlobalReader(2); }
+        ~GlobalGuard() { cp.exitGlobalReader(2); }
+    } guard(*this);
+
+    const auto* conv = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel と HB
+    return conv != nullptr && conv->isIrBusLive();
+}
+
+[[nodiscard]] bool ConvolverProcessor::isSpectralMorphLive() const noexcept
+{
+    struct GlobalGuard {
+        const ConvolverProcessor& cp;
+        GlobalGuard(const ConvolverProcessor& cp_) : cp(cp_) { cp.enterGlobalReader(2); }
+        ~GlobalGuard() { cp.exitGlobalReader(2); }
+    } guard(*this);
+
+    const auto* conv = loadActiveEngine(std::memory_order_acquire); // acquire: exchangeActiveEngine acq_rel と HB
+    return conv != nullptr && conv->hasSpectralMorphSource();
+}
+
+[[nodiscard]] float ConvolverProcessor::getMaximumAllowedIRLengthSecForSampleRate(double sampleRate, bool farTailPaging)
 {
     if (sampleRate <= 0.0)
         return IR_LENGTH_MAX_SEC;
 
-    return static_cast<float>(static_cast<double>(MAX_IR_LATENCY) / sampleRate);
+    const int cap = farTailPaging ? MAX_PAGED_IR_LENGTH : MAX_IR_LATENCY;
+    return static_cast<float>(static_cast<double>(cap) / sampleRate);
 }
 
 [[nodiscard]] float ConvolverProcessor::getMaximumAllowedIRLengthSec(double sampleRate) const
@@ -932,21 +1242,25 @@ void ConvolverProcessor::setResamplingPhaseMode(ResamplingPhaseMode mode)
                     ? sampleRate
                     : convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay/applyNewState の publishAtomic release と HB
 
-    return getMaximumAllowedIRLengthSecForSampleRate(sr);
+    return getMaximumAllowedIRLengthSecForSampleRate(sr, isFarTailPagingEnabled());
 }
 
 int ConvolverProcessor::computeTargetIRLength(double sampleRate, int originalLength) const
 {
     juce::ignoreUnused(originalLength);
-    const double targetIRTimeSec = [this]() -> double {
+    double targetIRTimeSec = 0.0;
+    bool farTailPaging = false;
+    {
         const juce::ScopedLock lock(pendingOverrideLock);
-        return static_cast<double>(pendingOverride.targetIRLengthSec);
-    }();
-    static constexpr int kMaxIRCap = MAX_IR_LATENCY;
+        targetIRTimeSec = static_cast<double>(pendingOverride.targetIRLengthSec);
+        farTailPaging = pendingOverride.farTailHorizonSec > 0.0f;
+    }
+    // ★ Far-tail paging: 遠い末尾はディスク上に置くため長い IR を許す
+    const int maxIRCap = farTailPaging ? MAX_PAGED_IR_LENGTH : MAX_IR_LATENCY;
 
     int target = static_cast<int>(sampleRate * targetIRTimeSec);
 
-    target = (std::min)(target, kMaxIRCap);
+    target = (std::min)(target, maxIRCap);
     target = (std::max)(target, 1);
 
     return target;
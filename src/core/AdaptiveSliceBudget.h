@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace convo {
+
+//==============================================================================
+// AdaptiveSliceBudget — 時間予算つきスライス実行の見積り
+//
+//   1 スライスで実行するステップ数を、各ステップの実測時間から決める。
+//   ステップは種類 (kind) ごとに所要時間の指数移動平均を持ち、
+//   「経過時間 + 次ステップの見積り」が予算に収まる間だけ同じスライスで続ける。
+//   スライスは最低 1 ステップ進める (見積りが予算を超えるステップでも停滞させない)。
+//   未計測の kind は予算いっぱいと見なし、単独のスライスで実測させる。
+//   予算超過はスライス後の休止 (restUs) で埋め合わせ、実行時間の比率を budget / period に保つ。
+//   JUCE 非依存。
+//==============================================================================
+
+enum class SliceResult
+{
+    InProgress,
+    Completed,
+    Failed,
+    Canceled
+};
+
+template <int NumKinds>
+class AdaptiveSliceBudget
+{
+public:
+    static_assert(NumKinds > 0, "AdaptiveSliceBudget needs at least one step kind");
+
+    // 新しい実測の重み (ビルド内容が変わっても数回で追従し、1 回の外れ値には引きずられない)
+    static constexpr double kSmoothing = 0.25;
+
+    void setBudgetUs(uint64_t budget) noexcept { budgetUs = std::max<uint64_t>(budget, 1); }
+    [[nodiscard]] uint64_t getBudgetUs() const noexcept { return budgetUs; }
+
+    void beginSlice() noexcept { stepsInSlice = 0; }
+
+    [[nodiscard]] uint64_t estimateUs(int kind) const noexcept
+    {
+        if (kind < 0 || kind >= NumKinds || !measured[kind])
+            return budgetUs;
+        return static_cast<uint64_t>(emaUs[kind] + 0.5);
+    }
+
+    // elapsedUs: このスライスで既に使った時間
+    [[nodiscard]] bool admit(int kind, uint64_t elapsedUs) const noexcept
+    {
+        if (stepsInSlice == 0)
+            return true;
+        return elapsedUs + estimateUs(kind) <= budgetUs;
+    }
+
+    void record(int kind, uint64_t durationUs) noexcept
+    {
+        ++stepsInSlice;
+        if (kind < 0 || kind >= NumKinds)
+            return;
+        const double sample = static_cast<double>(durationUs);
+        emaUs[kind] = measured[kind] ? emaUs[kind] + kSmoothing * (sample - emaUs[kind]) : sample;
+        measured[kind] = true;
+    }
+
+    [[nodiscard]] int getStepsInSlice() const noexcept { return stepsInSlice; }
+
+    // スライスに sliceElapsedUs かかった後の休止時間。実行 : 周期 = budget : period を保つ
+    //   (予算内なら period の残り、超過したステップは超過分に比例して長く休む)。maxRestUs で頭打ち
+    [[nodiscard]] uint64_t restUs(uint64_t sliceElapsedUs, uint64_t periodUs, uint64_t maxRestUs) const noexcept
+    {
+        const double scaled = static_cast<double>(sliceElapsedUs) * static_cast<double>(periodUs) / static_cast<double>(budgetUs);
+        const double cycle = std::max(static_cast<double>(periodUs), scaled);
+        const double rest = cycle - static_cast<double>(sliceElapsedUs);
+        if (rest <= 0.0)
+            return 0;
+        return std::min<uint64_t>(static_cast<uint64_t>(rest + 0.5), maxRestUs);
+    }
+
+private:
+    uint64_t budgetUs = 1;
+    int stepsInSlice = 0;
+    double emaUs[NumKinds] {};
+    bool measured[NumKinds] {};
+};
+
+//==============================================================================
+// runBudgetedSlice — 1 スライス分のステップを進める
+//   nowUs()     : 単調増加の現在時刻 (µs)
+//   isDone()    : 全ステップ完了なら true
+//   nextKind()  : 次に走るステップの kind
+//   runStep()   : 1 ステップ実行。失敗なら false
+//==============================================================================
+template <int NumKinds, typename NowUs, typename IsDone, typename NextKind, typename RunStep>
+SliceResult runBudgetedSlice(AdaptiveSliceBudget<NumKinds>& budget, NowUs nowUs,
+                             IsDone isDone, NextKind nextKind, RunStep runStep)
+{
+    budget.beginSlice();
+    const uint64_t sliceStartUs = nowUs();
+    while (!isDone())
+    {
+        const int kind = nextKind();
+        if (!budget.admit(kind, nowUs() - sliceStartUs))
+            return SliceResult::InProgress;
+
+        const uint64_t stepStartUs = nowUs();
+        const bool ok = runStep();
+        budget.record(kind, nowUs() - stepStartUs);
+        if (!ok)
+            return SliceResult::Failed;
+    }
+    return SliceResult::Completed;
+}
+
+//==============================================================================
+// runPacedSlices — 呼び出しスレッド (ワーカー) で完了までスライスを回す
+//   advanceSlice() は 1 スライス進めて SliceResult を返す。スライス間は budget.restUs だけ休み、
+//   休止は pollUs ごとに区切って shouldCancel() を確認する (取り消しは最大 pollUs で効く)
+//==============================================================================
+template <int NumKinds, typename NowUs, typename AdvanceSlice, typename ShouldCancel, typename SleepUs>
+SliceResult runPacedSlices(const AdaptiveSliceBudget<NumKinds>& budget, uint64_t periodUs, uint64_t maxRestUs,
+                           uint64_t pollUs, NowUs nowUs, AdvanceSlice advanceSlice,
+                           ShouldCancel shouldCancel, SleepUs sleepUs)
+{
+    pollUs = std::max<uint64_t>(pollUs, 1);
+    while (true)
+    {
+        if (shouldCancel())
+            return SliceResult::Canceled;
+
+        const uint64_t sliceStartUs = nowUs();
+        const SliceResult result = advanceSlice();
+        if (result != SliceResult::InProgress)
+            return result;
+
+        uint64_t remainingUs = budget.restUs(nowUs() - sliceStartUs, periodUs, maxRestUs);
+        while (remainingUs > 0)
+        {
+            if (shouldCancel())
+                return SliceResult::Canceled;
+            const uint64_t chunkUs = std::min(remainingUs, pollUs);
+            sleepUs(chunkUs);
+            remainingUs -= chunkUs;
+        }
+    }
+}
+
+} // namespace convo
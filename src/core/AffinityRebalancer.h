@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+namespace convo {
+
+//==============================================================================
+// AffinityRebalancer — 学習評価ワーカーを Audio コアの L2 クラスタから退避させるかの判定
+//
+//   Message Thread の timer から一定周期で update() を呼ぶ。入力は
+//     - callbackLoadPermille : Audio callback の負荷 (budget 比 permille, peak-hold)
+//     - evalCpuPermille      : 前回 update() 以降に評価ワーカー群が消費した CPU 時間 / 経過時間 (1 コア = 1000)
+//   高負荷かつ評価ワーカーが実際に CPU を使っている状態が restrictTicks 回続いたら Restrict、
+//   低負荷が releaseTicks 回続いたら Release を返す。間の帯域では状態を保つ (ヒステリシス)。
+//   退避先が無い環境 (L2 クラスタ = Audio コアのみ等) では呼び出し側が update() を呼ばない。
+//   スレッド非安全。JUCE 非依存。
+//==============================================================================
+
+enum class AffinityRebalanceDecision : uint8_t
+{
+    Hold,       // 現状維持
+    Restrict,   // 評価ワーカーを Audio クラスタ外へ
+    Release     // 評価ワーカーへ全コアを返す
+};
+
+struct AffinityRebalanceConfig
+{
+    uint16_t restrictLoadPermille = 650;   // これ以上で退避を検討
+    uint16_t releaseLoadPermille = 400;    // これ以下で返却を検討
+    uint32_t evalBusyPermille = 250;       // 評価ワーカーが 1/4 コア以上使っていれば「飽和させうる」とみなす
+    int restrictTicks = 3;                 // 退避までの連続回数 (100 ms 周期で 0.3 s)
+    int releaseTicks = 30;                 // 返却までの連続回数 (同 3 s。退避と返却の往復を防ぐ)
+};
+
+class AffinityRebalancer
+{
+public:
+    explicit AffinityRebalancer(const AffinityRebalanceConfig& cfg = {}) noexcept : config(cfg) {}
+
+    AffinityRebalanceDecision update(uint16_t callbackLoadPermille, uint32_t evalCpuPermille) noexcept
+    {
+        if (!restricted)
+        {
+            const bool pressure = callbackLoadPermille >= config.restrictLoadPermille
+                               && evalCpuPermille >= config.evalBusyPermille;
+            highTicks = pressure ? highTicks + 1 : 0;
+            if (highTicks < config.restrictTicks)
+                return AffinityRebalanceDecision::Hold;
+
+            restricted = true;
+            highTicks = 0;
+            ++restrictCount;
+            return AffinityRebalanceDecision::Restrict;
+        }
+
+        lowTicks = (callbackLoadPermille <= config.releaseLoadPermille) ? lowTicks + 1 : 0;
+        if (lowTicks < config.releaseTicks)
+            return AffinityRebalanceDecision::Hold;
+
+        restricted = false;
+        lowTicks = 0;
+        ++releaseCount;
+        return AffinityRebalanceDecision::Release;
+    }
+
+    void reset() noexcept
+    {
+        restricted = false;
+        highTicks = 0;
+        lowTicks = 0;
+    }
+
+    [[nodiscard]] bool isRestricted() const noexcept { return restricted; }
+    [[nodiscard]] uint64_t getRestrictCount() const noexcept { return restrictCount; }
+    [[nodiscard]] uint64_t getReleaseCount() const noexcept { return releaseCount; }
+
+private:
+    AffinityRebalanceConfig config;
+    bool restricted = false;
+    int highTicks = 0;
+    int lowTicks = 0;
+    uint64_t restrictCount = 0;
+    uint64_t releaseCount = 0;
+};
+
+} // namespace convo
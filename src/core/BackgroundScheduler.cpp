@@ -0,0 +1,346 @@
+//==============================================================================
+// BackgroundScheduler.cpp
+//==============================================================================
+
+#include "BackgroundScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace convo {
+
+//==============================================================================
+// TaskState: submit 1 回分。TaskHandle とキューが共有する
+//==============================================================================
+class BackgroundScheduler::TaskState {
+public:
+    enum Phase : uint8_t { Pending, Running, Finished };
+
+    explicit TaskState(Task t) : task(std::move(t)) {}
+
+    Task task;
+    std::atomic<bool> cancelRequested { false };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    Phase phase = Pending;   // mutex 保護
+    bool ran = false;        // mutex 保護
+};
+
+//==============================================================================
+// CancelToken / TaskHandle / ActivityScope
+//==============================================================================
+bool BackgroundScheduler::CancelToken::isCancelled() const noexcept
+{
+    return convo::consumeAtomic(task.cancelRequested, std::memory_order_acquire) // acquire: cancel() / stop() の release と HB
+        || convo::consumeAtomic(scheduler.stopRequested_, std::memory_order_acquire); // acquire: stop() の release と HB
+}
+
+bool BackgroundScheduler::CancelToken::shouldYield() const noexcept
+{
+    return scheduler.hasWorkAbove(priority);
+}
+
+void BackgroundScheduler::TaskHandle::cancel() noexcept
+{
+    if (state == nullptr)
+        return;
+
+    convo::publishAtomic(state->cancelRequested, true, std::memory_order_release); // release: CancelToken の acquire と HB
+    // 未開始ならここで終わらせ、wait() している側を起こす (ワーカーは取り出したときに Finished を見て捨てる)
+    bool finishedNow = false;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->phase == TaskState::Pending)
+        {
+            state->phase = TaskState::Finished;
+            finishedNow = true;
+        }
+    }
+    if (finishedNow)
+        state->cv.notify_all();
+}
+
+bool BackgroundScheduler::TaskHandle::isFinished() const noexcept
+{
+    if (state == nullptr)
+        return true;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->phase == TaskState::Finished;
+}
+
+bool BackgroundScheduler::TaskHandle::wait(std::chrono::milliseconds timeout) const
+{
+    if (state == nullptr)
+        return true;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    return state->cv.wait_for(lock, timeout, [this] { return state->phase == TaskState::Finished; });
+}
+
+bool BackgroundScheduler::TaskHandle::wasRun() const noexcept
+{
+    if (state == nullptr)
+        return false;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->ran;
+}
+
+BackgroundScheduler::ActivityScope::ActivityScope(BackgroundScheduler* s, BackgroundPriority p) noexcept
+    : scheduler(s), priority(p)
+{
+    if (scheduler == nullptr)
+        return;
+    std::lock_guard<std::mutex> lock(scheduler->mutex);
+    ++scheduler->activityCount[indexOf(priority)];
+    scheduler->updateBusyMaskLocked();
+}
+
+BackgroundScheduler::ActivityScope::~ActivityScope()
+{
+    if (scheduler == nullptr)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(scheduler->mutex);
+        --scheduler->activityCount[indexOf(priority)];
+        scheduler->updateBusyMaskLocked();
+    }
+    // 申告の間せき止めていた下位クラスのタスクを取り出させる
+    scheduler->cv.notify_all();
+}
+
+//==============================================================================
+// BackgroundScheduler
+//==============================================================================
+BackgroundScheduler::~BackgroundScheduler()
+{
+    stop();
+}
+
+int BackgroundScheduler::concurrencyLimit(BackgroundPriority priority, int workerCount) noexcept
+{
+    const int count = std::max(1, workerCount);
+    switch (priority)
+    {
+        case BackgroundPriority::InteractiveRebuild:
+        case BackgroundPriority::IRLoad:
+            return count;
+        case BackgroundPriority::Upgrade:
+            return std::max(1, count - 1);
+        case BackgroundPriority::Learning:
+        case BackgroundPriority::Housekeeping:
+            return std::max(1, count / 2);
+    }
+    return 1;
+}
+
+void BackgroundScheduler::start(int workerCount, WorkerStart onWorkerStartCallback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running || !workers.empty())
+        return;
+
+    running = true;
+    convo::publishAtomic(stopRequested_, false, std::memory_order_release); // release: CancelToken の acquire と HB
+    onWorkerStart = std::move(onWorkerStartCallback);
+    const int count = std::max(1, workerCount);
+    convo::publishAtomic(workerCount_, count, std::memory_order_release); // release: getWorkerCount の acquire と HB
+    workers.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+        workers.emplace_back(&BackgroundScheduler::run, this, i);
+}
+
+void BackgroundScheduler::requestStop()
+{
+    std::vector<std::shared_ptr<TaskState>> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+        convo::publishAtomic(stopRequested_, true, std::memory_order_release); // release: 実行中タスクの CancelToken (acquire) へ
+        for (size_t p = 0; p < queues.size(); ++p)
+        {
+            for (auto& state : queues[p])
+                abandoned.push_back(std::move(state));
+            queues[p].clear();
+        }
+        updateBusyMaskLocked();
+    }
+    cv.notify_all();
+
+    // 未開始のタスクは実行せずに終わらせる (wait() している側を起こす)
+    for (auto& state : abandoned)
+    {
+        convo::publishAtomic(state->cancelRequested, true, std::memory_order_release); // release: CancelToken の acquire と HB
+        finishTask(*state, false);
+    }
+}
+
+void BackgroundScheduler::stop()
+{
+    requestStop();
+
+    std::vector<std::thread> joining;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        joining.swap(workers);
+    }
+
+    for (auto& t : joining)
+        if (t.joinable())
+            t.join();
+    convo::publishAtomic(workerCount_, 0, std::memory_order_release); // release: getWorkerCount の acquire と HB
+}
+
+bool BackgroundScheduler::isRunning() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+BackgroundScheduler::TaskHandle BackgroundScheduler::submit(BackgroundPriority priority, Task task)
+{
+    auto state = std::make_shared<TaskState>(std::move(task));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running)
+            return {};
+        queues[indexOf(priority)].push_back(state);
+        updateBusyMaskLocked();
+    }
+    cv.notify_one();
+    return TaskHandle(std::move(state));
+}
+
+bool BackgroundScheduler::hasWorkAbove(BackgroundPriority priority) const noexcept
+{
+    const uint32_t higherBits = (1u << indexOf(priority)) - 1u;
+    return (convo::consumeAtomic(busyClassMask_, std::memory_order_acquire) & higherBits) != 0; // acquire: updateBusyMaskLocked の release と HB
+}
+
+BackgroundScheduler::Stats BackgroundScheduler::getStats() const
+{
+    Stats stats;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t p = 0; p < static_cast<size_t>(kPriorityCount); ++p)
+    {
+        stats.completed[p] = completedCount[p];
+        stats.cancelled[p] = cancelledCount[p];
+        stats.pending[p] = static_cast<int>(queues[p].size());
+        stats.running[p] = runningCount[p];
+        stats.activities[p] = activityCount[p];
+    }
+    stats.workerCount = static_cast<int>(workers.size());
+    return stats;
+}
+
+void BackgroundScheduler::updateBusyMaskLocked() noexcept
+{
+    uint32_t mask = 0;
+    for (size_t p = 0; p < static_cast<size_t>(kPriorityCount); ++p)
+        if (!queues[p].empty() || runningCount[p] > 0 || activityCount[p] > 0)
+            mask |= 1u << p;
+    convo::publishAtomic(busyClassMask_, mask, std::memory_order_release); // release: hasWorkAbove の acquire と HB
+}
+
+std::shared_ptr<BackgroundScheduler::TaskState> BackgroundScheduler::takeNextLocked(BackgroundPriority& outPriority)
+{
+    const int count = static_cast<int>(workers.size());
+    for (size_t p = 0; p < static_cast<size_t>(kPriorityCount); ++p)
+    {
+        if (queues[p].empty())
+        {
+            // 上位クラスが申告中なら、それより下は取り出さない
+            if (activityCount[p] > 0)
+                return nullptr;
+            continue;
+        }
+
+        const auto priority = static_cast<BackgroundPriority>(p);
+        if (runningCount[p] >= concurrencyLimit(priority, count))
+        {
+            if (activityCount[p] > 0)
+                return nullptr;
+            continue;
+        }
+
+        auto state = std::move(queues[p].front());
+        queues[p].pop_front();
+        outPriority = priority;
+        return state;
+    }
+    return nullptr;
+}
+
+void BackgroundScheduler::finishTask(TaskState& state, bool ran)
+{
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.phase = TaskState::Finished;
+        state.ran = ran;
+    }
+    state.cv.notify_all();
+}
+
+void BackgroundScheduler::run(int workerIndex)
+{
+    if (onWorkerStart)
+        onWorkerStart(workerIndex);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        BackgroundPriority priority = BackgroundPriority::Housekeeping;
+        std::shared_ptr<TaskState> state;
+        cv.wait(lock, [&] {
+            if (!running)
+                return true;
+            state = takeNextLocked(priority);
+            return state != nullptr;
+        });
+        if (!running)
+            break;
+
+        // cancel() 済み (Finished) のものは実行せずに捨てる
+        bool cancelledBeforeStart = false;
+        {
+            std::lock_guard<std::mutex> taskLock(state->mutex);
+            if (state->phase == TaskState::Pending)
+                state->phase = TaskState::Running;
+            else
+                cancelledBeforeStart = true;
+        }
+        const size_t p = indexOf(priority);
+        if (cancelledBeforeStart)
+        {
+            ++cancelledCount[p];
+            updateBusyMaskLocked();
+            continue;
+        }
+
+        ++runningCount[p];
+        updateBusyMaskLocked();
+        lock.unlock();
+
+        {
+            const CancelToken token(*this, *state, priority);
+            try
+            {
+                state->task(token);
+            }
+            catch (...)
+            {
+                // タスクの例外はワーカーを止めない (呼び出し側は結果の有無で判断する)
+            }
+        }
+        state->task = nullptr;   // キャプチャをワーカー上で解放する
+        finishTask(*state, true);
+
+        lock.lock();
+        --runningCount[p];
+        ++completedCount[p];
+        updateBusyMaskLocked();
+        // 占有上限で止まっていた同クラスのタスクを別のワーカーが取り出せるようにする
+        cv.notify_all();
+    }
+}
+
+} // namespace convo
@@ -0,0 +1,175 @@
+//==============================================================================
+// BackgroundScheduler.h
+// Prioritized background task pool shared by the non-RT subsystems
+//
+// ★ 優先度付きの共有ワーカープール
+//   IR 読み込み・段階アップグレード・学習・後片付けがそれぞれ自前のスレッドで動くと、
+//   IR 読み込み中にアップグレード用プールや学習の評価ワーカーが同じコアを奪い合う。
+//   このプールは優先度クラス (InteractiveRebuild > IRLoad > Upgrade > Learning > Housekeeping) ごとの
+//   FIFO を持ち、空いたワーカーは常に最も優先度の高いクラスから取り出す。
+//
+//   - 協調キャンセル: submit の戻り値 TaskHandle::cancel()、または stop()。未開始のタスクは実行されず、
+//     実行中のタスクは CancelToken::isCancelled() を見て自分で戻る (強制中断はしない)。
+//   - 活動の申告: 専用スレッドのまま動く処理 (rebuild レーン・IR ローダー) は ActivityScope で
+//     「そのクラスの仕事が進行中」と申告する。申告中は、それより低いクラスのタスクは取り出されず、
+//     CancelToken::shouldYield() / hasWorkAbove() が true になる (学習などが自分で手を緩める)。
+//   - 占有上限: Upgrade はワーカー数 - 1、Learning / Housekeeping は半分までしか同時に走らせない。
+//     非プリエンプティブなので、低優先度で全ワーカーが埋まって上位の投入が待たされるのを防ぐ。
+//
+//   ワーカーのアフィニティと優先度は start() の onWorkerStart で 1 回だけ設定する
+//   (AudioEngine は ThreadAffinityManager の HeavyBackground を使う)。タスクごとの付け替えはしない。
+//
+//   スレッド:
+//     submit / cancel / ActivityScope / hasWorkAbove : 任意の Non-RT スレッド (内部 mutex を短時間保持)
+//     start / stop                                   : 所有者 (AudioEngine は Message Thread)
+//     タスク本体 / onWorkerStart                      : ワーカースレッド上で呼ばれる
+//==============================================================================
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audioengine/AtomicAccess.h"
+
+namespace convo {
+
+// 値が小さいほど優先 (取り出し順)
+enum class BackgroundPriority : uint8_t
+{
+    InteractiveRebuild = 0,   // ユーザー操作に伴う DSPCore 再構築
+    IRLoad,                   // IR ファイルの読み込み・変換
+    Upgrade,                  // 段階アップグレード (より大きい FFT サイズへの変換)
+    Learning,                 // ノイズシェーパー学習
+    Housekeeping              // キャッシュ整理などの後片付け
+};
+
+class BackgroundScheduler {
+public:
+    static constexpr int kPriorityCount = 5;
+
+    class TaskState;
+
+    // タスク本体に渡す。ワーカー上でだけ有効
+    class CancelToken {
+    public:
+        // cancel() または stop() が要求された
+        [[nodiscard]] bool isCancelled() const noexcept;
+        // より優先度の高い仕事が待っている / 申告されている。長いタスクは区切りで早めに戻るとよい
+        [[nodiscard]] bool shouldYield() const noexcept;
+
+    private:
+        friend class BackgroundScheduler;
+        CancelToken(const BackgroundScheduler& s, const TaskState& t, BackgroundPriority p) noexcept
+            : scheduler(s), task(t), priority(p) {}
+        const BackgroundScheduler& scheduler;
+        const TaskState& task;
+        BackgroundPriority priority;
+    };
+
+    using Task = std::function<void(const CancelToken&)>;
+    using WorkerStart = std::function<void(int workerIndex)>;
+
+    // submit の戻り値。空 (!handle) なら投入されていない (スケジューラ停止中): 呼び出し側がその場で実行する
+    class TaskHandle {
+    public:
+        TaskHandle() = default;
+        explicit operator bool() const noexcept { return state != nullptr; }
+
+        // 未開始なら実行せずに終わらせ、実行中ならトークン経由で中断を求める
+        void cancel() noexcept;
+        // 実行を終えた (または実行されずに終わった)
+        [[nodiscard]] bool isFinished() const noexcept;
+        // 終わるまで待つ。timeout で打ち切ったら false
+        bool wait(std::chrono::milliseconds timeout) const;
+        // 本体が実行された (未開始のままキャンセルされた場合は false)
+        [[nodiscard]] bool wasRun() const noexcept;
+
+    private:
+        friend class BackgroundScheduler;
+        explicit TaskHandle(std::shared_ptr<TaskState> s) noexcept : state(std::move(s)) {}
+        std::shared_ptr<TaskState> state;
+    };
+
+    // 専用スレッドの仕事を申告する RAII。scheduler が nullptr なら何もしない
+    class ActivityScope {
+    public:
+        ActivityScope(BackgroundScheduler* s, BackgroundPriority p) noexcept;
+        ~ActivityScope();
+        ActivityScope(const ActivityScope&) = delete;
+        ActivityScope& operator=(const ActivityScope&) = delete;
+
+    private:
+        BackgroundScheduler* scheduler;
+        BackgroundPriority priority;
+    };
+
+    struct Stats {
+        std::array<uint64_t, kPriorityCount> completed {};
+        std::array<uint64_t, kPriorityCount> cancelled {};   // 実行されずに終わった数
+        std::array<int, kPriorityCount> pending {};
+        std::array<int, kPriorityCount> running {};
+        std::array<int, kPriorityCount> activities {};
+        int workerCount = 0;
+    };
+
+    BackgroundScheduler() = default;
+    ~BackgroundScheduler();
+
+    BackgroundScheduler(const BackgroundScheduler&) = delete;
+    BackgroundScheduler& operator=(const BackgroundScheduler&) = delete;
+
+    void start(int workerCount, WorkerStart onWorkerStart = {});
+    // 未開始のタスクをすべてキャンセル扱いで終わらせ、実行中のタスクの終了を待ってワーカーを止める
+    void stop();
+    // stop の前半だけ: 受付を止めて未開始タスクを終わらせ、実行中タスクに打ち切りを求める (join しない)。
+    // 終了時に他のスレッドの停止待ちと重ねるために使い、最後に stop() で join する
+    void requestStop();
+    [[nodiscard]] bool isRunning() const;
+    [[nodiscard]] int getWorkerCount() const noexcept { return convo::consumeAtomic(workerCount_, std::memory_order_acquire); } // acquire: start の release と HB
+
+    TaskHandle submit(BackgroundPriority priority, Task task);
+
+    // priority より高いクラスに、待ち・実行中のタスクか申告中の活動がある
+    [[nodiscard]] bool hasWorkAbove(BackgroundPriority priority) const noexcept;
+
+    [[nodiscard]] Stats getStats() const;
+
+    // 同時実行の上限 (workerCount から決まる)。テスト・診断用
+    [[nodiscard]] static int concurrencyLimit(BackgroundPriority priority, int workerCount) noexcept;
+
+private:
+    void run(int workerIndex);
+    // mutex 保持中に呼ぶ。取り出せるタスクが無ければ nullptr
+    std::shared_ptr<TaskState> takeNextLocked(BackgroundPriority& outPriority);
+    void updateBusyMaskLocked() noexcept;
+    void finishTask(TaskState& state, bool ran);
+
+    static size_t indexOf(BackgroundPriority p) noexcept { return static_cast<size_t>(p); }
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    bool running = false;                                                   // mutex 保護
+    std::array<std::deque<std::shared_ptr<TaskState>>, kPriorityCount> queues; // mutex 保護
+    std::array<int, kPriorityCount> runningCount {};                        // mutex 保護
+    std::array<int, kPriorityCount> activityCount {};                       // mutex 保護
+    std::array<uint64_t, kPriorityCount> completedCount {};                 // mutex 保護
+    std::array<uint64_t, kPriorityCount> cancelledCount {};                 // mutex 保護
+    std::vector<std::thread> workers;
+    WorkerStart onWorkerStart;
+
+    std::atomic<bool> stopRequested_ { false };   // requestStop() / stop() 以降: 実行中のタスクの CancelToken も cancelled を返す
+    // bit p = クラス p に待ち・実行中・申告中の仕事がある。hasWorkAbove をロックなしで答えるための写し
+    std::atomic<uint32_t> busyClassMask_ { 0 };
+    std::atomic<int> workerCount_ { 0 };
+};
+
+} // namespace convo
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace convo {
+
+//==============================================================================
+// BinTileLayout — NUC のビン優先 (bin-major) スペクトル配置のインデックス計算
+//
+//   通常 (パーティション優先) は slot s の complexSize 本が連続し、要素 (s, k) は s * cs + k にある。
+//   ビン優先では kTileBins 本ずつのビンタイルごとに全 slot 分を連続させる:
+//     タイル t はビン [t * kTileBins, min(cs, (t + 1) * kTileBins)) を覆い、幅 w は末尾タイルのみ短い。
+//     要素 (s, k) は slots * tileBegin + s * w + (k - tileBegin)。総要素数は slots * cs のまま。
+//   1 タイルの MAC は連続 slot を前から順に読むだけになり、アキュムレータ (w 本) をレジスタに
+//   置いたまま全パーティションを積算できる。FDL の巡回位置はタイル内のポインタオフセットになる。
+//   JUCE 非依存。
+//==============================================================================
+
+struct BinTileLayout
+{
+    // AVX2 で Re/Im アキュムレータ各 4 本 (= 16 double) をレジスタに保持できる幅
+    static constexpr int kTileBins = 16;
+
+    // ★ 自動選択の目安: これ未満のパーティション数ではタイル化の利得よりタイル外周の分岐が勝る
+    static constexpr int kAutoMinParts = 8;
+    // ★ 自動選択の目安: 1 パーティションの配列がこれより長いと、パーティション優先でも
+    //   アキュムレータの往復はキャッシュ内で済むため利得が小さい
+    static constexpr int kAutoMaxComplexSize = 1025;
+
+    [[nodiscard]] static int numTiles(int complexSize) noexcept
+    {
+        return (complexSize + kTileBins - 1) / kTileBins;
+    }
+
+    [[nodiscard]] static int tileBegin(int tile) noexcept { return tile * kTileBins; }
+
+    [[nodiscard]] static int tileWidth(int tile, int complexSize) noexcept
+    {
+        return std::min(kTileBins, complexSize - tileBegin(tile));
+    }
+
+    // タイル t の slot 0 の先頭 (slot s はここから s * tileWidth)
+    [[nodiscard]] static size_t tileOffset(int slots, int tile) noexcept
+    {
+        return static_cast<size_t>(slots) * static_cast<size_t>(tileBegin(tile));
+    }
+
+    [[nodiscard]] static size_t index(int slots, int slot, int bin, int complexSize) noexcept
+    {
+        const int tile = bin / kTileBins;
+        return tileOffset(slots, tile)
+             + static_cast<size_t>(slot) * static_cast<size_t>(tileWidth(tile, complexSize))
+             + static_cast<size_t>(bin - tileBegin(tile));
+    }
+
+    // パーティション優先 (slots × complexSize) → ビン優先 (同サイズ、src と dst は別領域)
+    template <typename T>
+    static void toBinMajor(const T* src, T* dst, int slots, int complexSize) noexcept
+    {
+        for (int s = 0; s < slots; ++s)
+            for (int k = 0; k < complexSize; ++k)
+                dst[index(slots, s, k, complexSize)] = src[static_cast<size_t>(s) * complexSize + k];
+    }
+
+    // パーティション優先の 1 slot 分 (連続 complexSize 本) をビン優先配列の slot へ散らす
+    template <typename T>
+    static void scatterSlot(const T* src, T* dst, int slots, int slot, int complexSize) noexcept
+    {
+        for (int t = 0, n = numTiles(complexSize); t < n; ++t)
+        {
+            const int w = tileWidth(t, complexSize);
+            std::copy(src + tileBegin(t), src + tileBegin(t) + w,
+                      dst + tileOffset(slots, t) + static_cast<size_t>(slot) * w);
+        }
+    }
+
+    // ★ 自動選択: パーティション数が多く 1 パーティションの配列が短いレイヤー (典型は L0)
+    [[nodiscard]] static bool preferBinMajor(int numPartsIR, int complexSize) noexcept
+    {
+        return numPartsIR >= kAutoMinParts && complexSize <= kAutoMaxComplexSize;
+    }
+};
+
+} // namespace convo
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+
+#include "RCUReader.h"
+#include "RuntimeReaderContext.h"
+
+namespace convo {
+
+// CallbackReaderScope: Audio Thread の 1 コールバック分の RCU 読み取り区間。
+//
+// EQProcessor / ConvolverProcessor はそれぞれ自分の EpochDomain と RCUReader を持ち、
+// process() のたびに RCUReaderGuard で enter/exit していた (リブロック中は内部ブロックごと、
+// クロスフェード中は旧 DSPCore の分も)。このスコープはコールバック入口で各 reader を 1 回だけ固定し、
+// 固定中のコンポーネントは process() で自分の reader に触れない (RT-local の pinned フラグを見るだけ)。
+// ドメインはコンポーネントごとに別なので、固定は「ドメインごとに 1 回」までしか減らせない。
+//
+// 運用:
+// - Audio Thread のコールバック関数スコープに 1 つだけ置き、RuntimeReadHandle より後に構築する
+//   (先に破棄され、DSPCore の寿命を守る engine 側の読み取り区間より内側で exit する)
+// - pinnedFlag はそのコンポーネントの Audio Thread 専用フラグ。別スレッド (パイプラインワーカー等) が
+//   同じ reader で process() するコンポーネントは固定しない
+// - 固定できなかった (容量超過・スロット取得失敗) コンポーネントは従来どおり自分で enter/exit する
+class CallbackReaderScope
+{
+public:
+    static constexpr int kMaxPins = 8;
+
+    explicit CallbackReaderScope(const RuntimeReaderContext& ctx) noexcept
+        : context(ctx)
+    {
+    }
+
+    ~CallbackReaderScope() noexcept
+    {
+        // 固定と逆順に外す。フラグを先に落とし、以後の process() は自前の guard に戻る
+        for (int i = pinCount - 1; i >= 0; --i)
+        {
+            auto& pin = pins[static_cast<size_t>(i)];
+            *pin.pinnedFlag = false;
+            pin.reader->exit();
+        }
+    }
+
+    CallbackReaderScope(const CallbackReaderScope&) = delete;
+    CallbackReaderScope& operator=(const CallbackReaderScope&) = delete;
+    CallbackReaderScope(CallbackReaderScope&&) = delete;
+    CallbackReaderScope& operator=(CallbackReaderScope&&) = delete;
+
+    // reader をこのスコープの終わりまで読み取り区間に入れ、pinnedFlag を立てる。既に固定済みなら何もしない
+    bool pin(RCUReader& reader, bool& pinnedFlag) noexcept
+    {
+        if (pinnedFlag)
+            return true;
+        if (pinCount >= kMaxPins)
+            return false;
+
+        reader.enter();
+        // 失敗経路 (所有者不一致・スロット枯渇) は enter 内で nestingDepth を戻しているので exit しない
+        if (!reader.rootEnterSucceeded())
+            return false;
+
+        pins[static_cast<size_t>(pinCount++)] = { &reader, &pinnedFlag };
+        pinnedFlag = true;
+        return true;
+    }
+
+    [[nodiscard]] const RuntimeReaderContext& readerContext() const noexcept { return context; }
+    [[nodiscard]] int pinnedCount() const noexcept { return pinCount; }
+
+private:
+    struct Pin
+    {
+        RCUReader* reader = nullptr;
+        bool* pinnedFlag = nullptr;
+    };
+
+    RuntimeReaderContext context;
+    std::array<Pin, kMaxPins> pins {};
+    int pinCount = 0;
+};
+
+} // namespace convo
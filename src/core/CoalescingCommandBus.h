@@ -0,0 +1,173 @@
+//==============================================================================
+// CoalescingCommandBus.h
+// パラメータ変更の合流バス（パラメータごとの固定スロット + dirty ビットマップ）
+//
+// ★ last-value-wins
+//   パラメータごとに 1 スロットを持ち、post は「値を上書き → dirty ビットを立てる」だけ。
+//   同じパラメータへの連続 post（オートメーションのバースト）はスロット上で上書きされ、
+//   drain 1 回で 1 件に畳まれる。キュー長は存在しないため溢れも無い。
+//
+//   drain は dirty ワードを exchange(0) で取り出し、前回 drain 時の値と異なるスロットだけを
+//   「変化あり」として返す。A→B→A のように 1 tick 内で元に戻ったバーストは変化なしとして落ちる。
+//   値を持たないイベント（「何か変わった」だけを伝える通知）は postEvent でスロットの
+//   カウンタを進め、必ず変化ありとして扱われるようにする。
+//
+//   スレッド:
+//     post / postEvent : 任意の Non-RT スレッド（複数 Producer、ロック無し）
+//     drain            : 単一 Consumer（通常は Message Thread）
+//   値そのもの（パラメータの実体）は呼び出し側の atomic に先に書いておくこと。
+//   バスは「どのパラメータが正味で変わったか」だけを Consumer へ運ぶ。
+//==============================================================================
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "audioengine/AtomicAccess.h"
+
+namespace convo {
+
+#ifdef _MSC_VER
+#pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#endif
+template <size_t SlotCount>
+class CoalescingCommandBus {
+    static_assert(SlotCount > 0, "SlotCount must be positive");
+
+public:
+    static constexpr size_t kSlotCount = SlotCount;
+    static constexpr size_t kMaskWords = (SlotCount + 63) / 64;
+
+    // drain で「正味で変化した」スロットのビット集合
+    struct ChangedMask {
+        std::array<uint64_t, kMaskWords> words{};
+
+        [[nodiscard]] bool any() const noexcept
+        {
+            for (const uint64_t word : words)
+                if (word != 0)
+                    return true;
+            return false;
+        }
+
+        [[nodiscard]] bool test(size_t slot) const noexcept
+        {
+            return (words[slot / 64] >> (slot % 64)) & 1u;
+        }
+
+        [[nodiscard]] size_t count() const noexcept
+        {
+            size_t n = 0;
+            for (const uint64_t word : words)
+                n += static_cast<size_t>(std::popcount(word));
+            return n;
+        }
+    };
+
+    CoalescingCommandBus() noexcept
+    {
+        // 初回 drain では値に関わらず変化ありとして扱う (post された値が 0 でも取りこぼさない)
+        lastDrained.fill(kNeverDrained);
+    }
+    CoalescingCommandBus(const CoalescingCommandBus&) = delete;
+    CoalescingCommandBus& operator=(const CoalescingCommandBus&) = delete;
+
+    // スロットの値を上書きして dirty にする。
+    // 戻り値: このワードの dirty がこの post で空から非空になった（＝ Consumer を起こすべき）なら true
+    bool post(size_t slot, uint64_t value) noexcept
+    {
+        if (slot >= SlotCount)
+            return false;
+        // relaxed: 下の fetchOr (release) が値の公開を担う
+        convo::publishAtomic(values[slot], value, std::memory_order_relaxed);
+        return markDirty(slot);
+    }
+
+    // 値を持たない通知。スロットのカウンタを進めるため drain では必ず変化ありになる
+    bool postEvent(size_t slot) noexcept
+    {
+        if (slot >= SlotCount)
+            return false;
+        // relaxed: 下の fetchOr (release) が値の公開を担う
+        convo::fetchAddAtomic(values[slot], uint64_t{1}, std::memory_order_relaxed);
+        return markDirty(slot);
+    }
+
+    // dirty スロットを取り出し、前回 drain から値が変わったスロットを返す（単一 Consumer）。
+    // drain 中に来た post は dirty を立て直すため、取りこぼさず次回の drain で拾われる。
+    ChangedMask drain() noexcept
+    {
+        ChangedMask changed;
+        for (size_t w = 0; w < kMaskWords; ++w)
+        {
+            // relaxed: 空判定のみ。中身は下の exchange (acq_rel) で観測する
+            if (convo::consumeAtomic(dirty[w], std::memory_order_relaxed) == 0)
+                continue;
+            // acq_rel: acquire で post の fetchOr (release) と HB し、スロット値を観測する
+            uint64_t bits = convo::exchangeAtomic(dirty[w], uint64_t{0}, std::memory_order_acq_rel);
+            while (bits != 0)
+            {
+                const size_t slot = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                // relaxed: exchange の acquire で可視（以降に上書きされた値なら dirty が立ち直っている）
+                const uint64_t value = convo::consumeAtomic(values[slot], std::memory_order_relaxed);
+                ++drainedPosts;
+                if (value != lastDrained[slot])
+                {
+                    lastDrained[slot] = value;
+                    changed.words[w] |= uint64_t{1} << (slot % 64);
+                }
+            }
+        }
+        if (changed.any())
+            ++publishedDrains;
+        return changed;
+    }
+
+    [[nodiscard]] bool hasPending() const noexcept
+    {
+        for (const auto& word : dirty)
+            if (convo::consumeAtomic(word, std::memory_order_relaxed) != 0) // relaxed: 判定のヒントのみ
+                return true;
+        return false;
+    }
+
+    // 統計: post 総数 / drain で取り出した dirty スロット数 / 変化ありで返した drain 回数
+    //   postCount - publishedDrainCount が合流で省いた publication 数の目安になる
+    [[nodiscard]] uint64_t getPostCount() const noexcept
+    {
+        return convo::consumeAtomic(posts, std::memory_order_relaxed); // relaxed: 統計カウンタのみ
+    }
+    [[nodiscard]] uint64_t getDrainedSlotCount() const noexcept { return drainedPosts; }          // Consumer スレッドのみ
+    [[nodiscard]] uint64_t getPublishedDrainCount() const noexcept { return publishedDrains; }    // Consumer スレッドのみ
+
+private:
+    bool markDirty(size_t slot) noexcept
+    {
+        convo::fetchAddAtomic(posts, uint64_t{1}, std::memory_order_relaxed); // relaxed: 統計カウンタのみ
+        const uint64_t bit = uint64_t{1} << (slot % 64);
+        // release: 直前のスロット値書き込みを drain の exchange (acquire) へ公開
+        const uint64_t before = convo::fetchOrAtomic(dirty[slot / 64], bit, std::memory_order_release);
+        return before == 0;
+    }
+
+    std::array<std::atomic<uint64_t>, SlotCount> values{};
+    alignas(64) std::array<std::atomic<uint64_t>, kMaskWords> dirty{};
+    alignas(64) std::atomic<uint64_t> posts { 0 };
+
+    static constexpr uint64_t kNeverDrained = ~uint64_t{0};
+
+    // Consumer 専用（drain を呼ぶスレッドのみが触る）
+    std::array<uint64_t, SlotCount> lastDrained{};
+    uint64_t drainedPosts = 0;
+    uint64_t publishedDrains = 0;
+};
+#ifdef _MSC_VER
+#pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#endif
+
+} // namespace convo
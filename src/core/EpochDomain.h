@@ -3,6 +3,7 @@
 #include <array>
 #include <cassert>
 #include <atomic>
+#include <bit>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
@@ -19,7 +20,11 @@ namespace convo {
 class EpochDomain : public IEpochProvider
 {
 public:
-    static constexpr int kMaxReaders = 64;
+    // ★ オフライン一括レンダ (インスタンス多数) を見込んで 256。
+    //   Reader 追跡は 2 段構成: スロットごとの epoch (キャッシュライン分離) + 有効スロットのビットマップ。
+    //   getMinReaderEpoch は有効ビットの立ったスロットだけを読み、登録は占有ヒントのビットマップから空きを引く。
+    static constexpr int kMaxReaders = 256;
+    static constexpr int kMaskWords = kMaxReaders / 64;
     static constexpr uint64_t kInactiveEpoch = std::numeric_limits<uint64_t>::max();
     static constexpr uint64_t kReservedEpoch = std::numeric_limits<uint64_t>::max() - 1;
 
@@ -42,37 +47,29 @@ public:
     }
 
     // ★ C-3: タグ名付き Reader 登録
+    //   占有ヒントのビットマップから空きスロット候補を引き、epoch の CAS で確定する (通常 O(1))。
+    //   ヒントは exit 直後などで一時的に古くなりうるため、候補が尽きたら全走査で確認する。
     int registerReaderThread(const char* tag) noexcept
     {
-        for (int i = 0; i < kMaxReaders; ++i)
+        for (int w = 0; w < kMaskWords; ++w)
         {
-            uint64_t expected = kInactiveEpoch;
-            // acq_rel/acquire: 成功側 release で slot 取得を他スレッドに公開し、
-            //                  failure 側 acquire で競合の write を観測してループを継続。
-            if (convo::compareExchangeAtomic(readers[static_cast<size_t>(i)].epoch,
-                                             expected,
-                                             kReservedEpoch,
-                                             std::memory_order_acq_rel,
-                                             std::memory_order_acquire))
+            // relaxed: 候補探しのヒントのみ (スロットの確定は tryClaimSlot の CAS)
+            uint64_t occupied = convo::consumeAtomic(occupiedSlotHint[static_cast<size_t>(w)], std::memory_order_relaxed);
+            while (occupied != ~uint64_t{0})
             {
-                // release: depth ゼロ化を slot 取得後に他スレッドが観測できるよう publish。
-                convo::publishAtomic(readers[static_cast<size_t>(i)].depth,
-                                     static_cast<uint32_t>(0),
-                                     std::memory_order_release);
-                // ★ C-3: 所有者タグ設定（CAS 成功後は単一スレッドのみがアクセス可能）
-                if (tag != nullptr) {
-                    std::strncpy(readers[static_cast<size_t>(i)].ownerTag, tag,
-                                 sizeof(readers[static_cast<size_t>(i)].ownerTag) - 1);
-                    readers[static_cast<size_t>(i)].ownerTag[
-                        sizeof(readers[static_cast<size_t>(i)].ownerTag) - 1] = '\0';
-                }
-                convo::publishAtomic(readers[static_cast<size_t>(i)].ownerThreadId,
-                                     convo::cachedThreadHash(),
-                                     std::memory_order_release);
-                return i;
+                const int bit = std::countr_one(occupied);
+                if (tryClaimSlot(w * 64 + bit, tag))
+                    return w * 64 + bit;
+                occupied |= uint64_t{1} << bit;
             }
         }
 
+        for (int i = 0; i < kMaxReaders; ++i)
+        {
+            if (tryClaimSlot(i, tag))
+                return i;
+        }
+
         return -1;
     }
 
@@ -97,6 +94,7 @@ public:
             convo::publishAtomic(readers[static_cast<size_t>(readerIndex)].depth,
                                  static_cast<uint32_t>(0),
                                  std::memory_order_release);
+            setMaskBit(occupiedSlotHint, readerIndex, std::memory_order_relaxed); // relaxed: 登録候補のヒントのみ
         }
 
         return reserved;
@@ -123,6 +121,9 @@ public:
                 std::chrono::steady_clock::now().time_since_epoch()).count());
         convo::publishAtomic(slot.residencyStartTimestampUs, nowUs, std::memory_order_release);
 
+        // acq_rel: 有効ビットを epoch の publish より先に立てる (getMinReaderEpoch はビットの立ったスロットだけを読む)
+        setMaskBit(activeReaderMask, readerIndex, std::memory_order_acq_rel);
+
         const uint64_t epoch = currentEpoch();
         // release: epoch を publish することで reclaimers が slot.epoch の safe-below 判定に使用可能となる。
         convo::publishAtomic(slot.epoch, epoch, std::memory_order_release);
@@ -152,6 +153,12 @@ public:
         // ★ Practical-8: 最終 exit 時に滞留時刻をクリア
         convo::publishAtomic(slot.residencyStartTimestampUs, uint64_t{0}, std::memory_order_release);
 
+        // ビットは epoch を kInactiveEpoch に戻す (= 他の登録に再利用されうる) より前に落とす。
+        //   後で落とすと、同じスロットを取り直した別 Reader のビットを消してしまう。
+        // release: この Reader の読み取り完了を有効ビットの消去より先に公開する
+        clearMaskBit(activeReaderMask, readerIndex, std::memory_order_release);
+        clearMaskBit(occupiedSlotHint, readerIndex, std::memory_order_relaxed); // relaxed: 登録候補のヒントのみ
+
         // release: epoch を kInactiveEpoch に戻し、reclaimers がこのスロットを safe-below 判定から除外可能にする。
         convo::publishAtomic(slot.epoch, kInactiveEpoch, std::memory_order_release);
 
@@ -196,33 +203,42 @@ public:
     {
         uint64_t minEpoch = currentEpoch();
 
-        for (const auto& slot : readers)
+        // 有効ビットの立ったスロットだけを読む (コストは登録数ではなく読み取り中の Reader 数に比例)
+        for (int w = 0; w < kMaskWords; ++w)
         {
-            // ★ Phase 3: quarantined Reader は safe-epoch 計算から除外
-            //   kQuarantinedFlag 設定時は depth==0 が不変条件:
-            //     - 即座 quarantine: depth==0 でのみ設定
-            //     - 遅延 quarantine: exitReader で depth:1→0 後に昇格
-            //   したがって depth の再チェックは不要だが、防衛的アサートで担保する。
-            const uint8_t flags = convo::consumeAtomic(slot.quarantineFlags, std::memory_order_acquire);
-            if ((flags & ReaderSlot::kQuarantinedFlag) != 0)
+            // acquire: enterReader の有効ビット設定 (acq_rel) と HB し、続く depth / epoch の読み取りを順序付ける
+            uint64_t active = convo::consumeAtomic(activeReaderMask[static_cast<size_t>(w)], std::memory_order_acquire);
+            while (active != 0)
             {
-                assert(convo::consumeAtomic(slot.depth, std::memory_order_acquire) == 0
-                    && "quarantined reader must have depth==0");
-                continue;
-            }
+                const auto& slot = readers[static_cast<size_t>(w * 64 + std::countr_zero(active))];
+                active &= active - 1;
+
+                // ★ Phase 3: quarantined Reader は safe-epoch 計算から除外
+                //   kQuarantinedFlag 設定時は depth==0 が不変条件:
+                //     - 即座 quarantine: depth==0 でのみ設定
+                //     - 遅延 quarantine: exitReader で depth:1→0 後に昇格
+                //   したがって depth の再チェックは不要だが、防衛的アサートで担保する。
+                const uint8_t flags = convo::consumeAtomic(slot.quarantineFlags, std::memory_order_acquire);
+                if ((flags & ReaderSlot::kQuarantinedFlag) != 0)
+                {
+                    assert(convo::consumeAtomic(slot.depth, std::memory_order_acquire) == 0
+                        && "quarantined reader must have depth==0");
+                    continue;
+                }
 
-            // acquire: enterReader release の depth 書き込みと HB し、depth 読み取り後に epoch を読む。
-            const uint32_t depth = convo::consumeAtomic(slot.depth, std::memory_order_acquire);
-            if (depth == 0)
-                continue;
+                // acquire: enterReader release の depth 書き込みと HB し、depth 読み取り後に epoch を読む。
+                const uint32_t depth = convo::consumeAtomic(slot.depth, std::memory_order_acquire);
+                if (depth == 0)
+                    continue;
 
-            // acquire: enterReader の epoch publish release と HB し、安全に epoch 値を取得。
-            const uint64_t epoch = convo::consumeAtomic(slot.epoch, std::memory_order_acquire);
-            if (epoch == kInactiveEpoch || epoch == kReservedEpoch)
-                continue;
+                // acquire: enterReader の epoch publish release と HB し、安全に epoch 値を取得。
+                const uint64_t epoch = convo::consumeAtomic(slot.epoch, std::memory_order_acquire);
+                if (epoch == kInactiveEpoch || epoch == kReservedEpoch)
+                    continue;
 
-            if (isOlder(epoch, minEpoch))
-                minEpoch = epoch;
+                if (isOlder(epoch, minEpoch))
+                    minEpoch = epoch;
+            }
         }
 
         return minEpoch;
@@ -232,12 +248,8 @@ public:
     {
         uint32_t count = 0;
 
-        for (const auto& slot : readers)
-        {
-            const uint32_t depth = convo::consumeAtomic(slot.depth, std::memory_order_acquire);
-            if (depth != 0)
-                ++count;
-        }
+        for (const auto& word : activeReaderMask)
+            count += static_cast<uint32_t>(std::popcount(convo::consumeAtomic(word, std::memory_order_acquire)));
 
         return count;
     }
@@ -495,7 +507,10 @@ private:
         return deferredDeletionQueue.enqueue(ptr, deleter, epoch, type);
     }
 
-    struct ReaderSlot
+#pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+    // ★ 1 スロット = 独立したキャッシュライン (Reader 同士の enter/exit が false sharing しない)
+    struct alignas(64) ReaderSlot
     {
         std::atomic<uint64_t> epoch { kInactiveEpoch };
         std::atomic<uint32_t> depth { 0 };
@@ -513,8 +528,49 @@ private:
         std::atomic<uint8_t> quarantineFlags{0};
     };
 
+    using SlotMask = std::array<std::atomic<uint64_t>, kMaskWords>;
+
+    static void setMaskBit(SlotMask& mask, int index, std::memory_order order) noexcept
+    {
+        convo::fetchOrAtomic(mask[static_cast<size_t>(index / 64)], uint64_t{1} << (index % 64), order);
+    }
+
+    static void clearMaskBit(SlotMask& mask, int index, std::memory_order order) noexcept
+    {
+        convo::fetchAndAtomic(mask[static_cast<size_t>(index / 64)], ~(uint64_t{1} << (index % 64)), order);
+    }
+
+    bool tryClaimSlot(int index, const char* tag) noexcept
+    {
+        auto& slot = readers[static_cast<size_t>(index)];
+        uint64_t expected = kInactiveEpoch;
+        // acq_rel/acquire: 成功側 release で slot 取得を他スレッドに公開し、
+        //                  failure 側 acquire で競合の write を観測してループを継続。
+        if (!convo::compareExchangeAtomic(slot.epoch,
+                                          expected,
+                                          kReservedEpoch,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire))
+            return false;
+
+        // release: depth ゼロ化を slot 取得後に他スレッドが観測できるよう publish。
+        convo::publishAtomic(slot.depth, static_cast<uint32_t>(0), std::memory_order_release);
+        // ★ C-3: 所有者タグ設定（CAS 成功後は単一スレッドのみがアクセス可能）
+        if (tag != nullptr)
+        {
+            std::strncpy(slot.ownerTag, tag, sizeof(slot.ownerTag) - 1);
+            slot.ownerTag[sizeof(slot.ownerTag) - 1] = '\0';
+        }
+        convo::publishAtomic(slot.ownerThreadId, convo::cachedThreadHash(), std::memory_order_release);
+        setMaskBit(occupiedSlotHint, index, std::memory_order_relaxed); // relaxed: 登録候補のヒントのみ
+        return true;
+    }
+
     std::atomic<uint64_t> globalEpoch;
     std::array<ReaderSlot, kMaxReaders> readers;
+    alignas(64) SlotMask activeReaderMask {};    // depth > 0 のスロット (getMinReaderEpoch が読む)
+    alignas(64) SlotMask occupiedSlotHint {};    // 予約・使用中のスロット (登録候補のヒント。正は slot.epoch)
+#pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
     DeferredDeletionQueue deferredDeletionQueue;
 
     // ★ A-2: EBR Queue Visibility 統計カウンタ
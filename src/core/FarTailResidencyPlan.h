@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace convo {
+
+//==============================================================================
+// FarTailResidencyPlan — ディスク退避した遠い末尾パーティションのうち、常駐させておくべき範囲の計算
+//
+//   MKLNonUniformConvolver の L2 層は p = 0 (最も遠い末尾) から numPartsIR へ向かって MAC を進める。
+//   ページ化されるのは [0, pagedParts)。各消費者 (Audio/Tail Worker の MAC) のカーソルは
+//   次に読むパーティション番号で、その先 windowParts 個を先読み窓とする。
+//     - カーソル >= pagedParts (ページ化範囲を抜けた) → 次のサイクル先頭 [0, windowParts) を窓とする
+//     - カーソル < 0 は未使用スロット
+//     - 消費者がいなければ次のサイクル先頭を保つ (束縛直後の最初のサイクルに間に合わせる)
+//   窓の外にあるパーティションはページアウトしてよい。JUCE 非依存。
+//==============================================================================
+
+struct FarTailResidencyPlan
+{
+    // カーソル位置から始まる窓の先頭
+    [[nodiscard]] static int windowStart(int cursor, int pagedParts) noexcept
+    {
+        return (cursor >= pagedParts) ? 0 : std::max(0, cursor);
+    }
+
+    // wanted[p] = 1 なら常駐させる (wanted は pagedParts 要素に揃えられる)。常駐させる数を返す
+    static int compute(const int* cursors, int numCursors, int pagedParts, int windowParts,
+                       std::vector<uint8_t>& wanted)
+    {
+        wanted.assign(static_cast<size_t>(std::max(0, pagedParts)), 0);
+        if (pagedParts <= 0 || windowParts <= 0)
+            return 0;
+
+        int count = 0;
+        auto mark = [&](int start)
+        {
+            const int end = std::min(pagedParts, start + windowParts);
+            for (int p = start; p < end; ++p)
+            {
+                count += (wanted[static_cast<size_t>(p)] == 0) ? 1 : 0;
+                wanted[static_cast<size_t>(p)] = 1;
+            }
+        };
+
+        bool anyConsumer = false;
+        for (int i = 0; i < numCursors; ++i)
+        {
+            if (cursors[i] < 0)
+                continue;
+            anyConsumer = true;
+            mark(windowStart(cursors[i], pagedParts));
+        }
+        if (!anyConsumer)
+            mark(0);
+        return count;
+    }
+};
+
+} // namespace convo
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "audioengine/AtomicAccess.h"
+
+//==============================================================================
+// FixedSlabPool — 型ごとの固定容量スラブ (ロックフリー、静的領域)
+//
+//   公開オブジェクト (GlobalSnapshot / EQState / BandNode / EQCoeffCache) のように
+//   「同じサイズのブロックを作っては epoch 回収で捨てる」型のための確保器。
+//   各クラスの operator new / delete から allocate / deallocate を呼ぶだけで、
+//   生成・retire・回収の経路 (deleter) は一切変えずに steady state の new/delete を無くす。
+//
+//     - 空きは 64bit ビットマップ。確保は fetchOr、解放は fetchAnd でビットを落とすだけ
+//     - 満杯または BlockSize を超える要求はヒープ (align_val_t 付き) へフォールバックし、
+//       解放時はアドレス範囲で自領域かどうかを判定する
+//     - 領域は静的メンバ配列で、コンストラクタは constexpr / デストラクタは trivial。
+//       静的初期化順にも終了時の破棄順にも依存しない
+//
+//   スレッド: allocate / deallocate は任意スレッドから呼べる (待ち無し・ロック無し)。
+//   ただしフォールバック時はヒープを使うので、Audio Thread からの確保は想定しない。
+//==============================================================================
+
+namespace convo {
+
+template <std::size_t BlockSize, std::size_t BlockAlign, std::size_t Capacity>
+class FixedSlabPool
+{
+public:
+    static_assert(Capacity > 0 && Capacity % 64 == 0, "Capacity must be a positive multiple of 64");
+    static_assert(std::has_single_bit(BlockAlign), "BlockAlign must be a power of two");
+
+    static constexpr std::size_t kStride = (BlockSize + BlockAlign - 1) / BlockAlign * BlockAlign;
+    static constexpr std::size_t kWords = Capacity / 64;
+
+    constexpr FixedSlabPool() noexcept = default;
+    FixedSlabPool(const FixedSlabPool&) = delete;
+    FixedSlabPool& operator=(const FixedSlabPool&) = delete;
+
+    // スラブから 1 ブロック取る。満杯なら nullptr
+    [[nodiscard]] void* tryAllocate() noexcept
+    {
+        // relaxed: 探索開始位置のヒントのみ (ビットの所有は下の fetchOr が確定する)
+        const std::size_t start = consumeAtomic(nextWordHint, std::memory_order_relaxed);
+        for (std::size_t n = 0; n < kWords; ++n)
+        {
+            const std::size_t w = (start + n) % kWords;
+            // relaxed: 空きビットの候補探し。確定と HB は fetchOr の acq_rel が担う
+            uint64_t observed = consumeAtomic(usedBits[w], std::memory_order_relaxed);
+            while (observed != ~uint64_t{0})
+            {
+                const uint64_t bit = uint64_t{1} << std::countr_one(observed);
+                // acq_rel: acquire で前回の所有者の deallocate (release) と HB し、破棄済みブロックを再利用する
+                const uint64_t previous = fetchOrAtomic(usedBits[w], bit, std::memory_order_acq_rel);
+                if ((previous & bit) == 0)
+                {
+                    publishAtomic(nextWordHint, w, std::memory_order_relaxed); // relaxed: ヒントのみ
+                    return storage + (w * 64 + static_cast<std::size_t>(std::countr_zero(bit))) * kStride;
+                }
+                observed = previous | bit;
+            }
+        }
+        return nullptr;
+    }
+
+    // 自領域のブロックなら空きへ戻して true。他 (ヒープ由来) なら何もせず false
+    bool tryDeallocate(void* ptr) noexcept
+    {
+        if (!owns(ptr))
+            return false;
+
+        const auto index = static_cast<std::size_t>(static_cast<std::byte*>(ptr) - storage) / kStride;
+        // release: デストラクタによる書き込みを次の tryAllocate (acq_rel) へ公開してから空きに戻す
+        fetchAndAtomic(usedBits[index / 64], ~(uint64_t{1} << (index % 64)), std::memory_order_release);
+        return true;
+    }
+
+    // operator new 用: スラブ優先、満杯またはサイズ超過ならヒープ
+    [[nodiscard]] void* allocate(std::size_t size)
+    {
+        if (size <= BlockSize)
+            if (void* block = tryAllocate())
+                return block;
+        // relaxed: 統計カウンタのみ
+        fetchAddAtomic(heapFallbacks, uint64_t{1}, std::memory_order_relaxed);
+        return ::operator new(size, std::align_val_t{BlockAlign});
+    }
+
+    [[nodiscard]] void* allocate(std::size_t size, const std::nothrow_t&) noexcept
+    {
+        if (size <= BlockSize)
+            if (void* block = tryAllocate())
+                return block;
+        fetchAddAtomic(heapFallbacks, uint64_t{1}, std::memory_order_relaxed); // relaxed: 統計カウンタのみ
+        return ::operator new(size, std::align_val_t{BlockAlign}, std::nothrow);
+    }
+
+    // operator delete 用: 自領域ならビットを戻し、そうでなければ allocate と対のヒープ解放
+    void deallocate(void* ptr) noexcept
+    {
+        if (ptr != nullptr && !tryDeallocate(ptr))
+            ::operator delete(ptr, std::align_val_t{BlockAlign});
+    }
+
+    [[nodiscard]] bool owns(const void* ptr) const noexcept
+    {
+        const auto* p = static_cast<const std::byte*>(ptr);
+        return p >= storage && p < storage + sizeof(storage);
+    }
+
+    // 使用中ブロック数 (診断用。並行更新中は近似値)
+    [[nodiscard]] std::size_t getInUseCount() const noexcept
+    {
+        std::size_t count = 0;
+        for (const auto& word : usedBits)
+            count += static_cast<std::size_t>(std::popcount(consumeAtomic(word, std::memory_order_relaxed))); // relaxed: 診断用
+        return count;
+    }
+
+    // スラブが満杯でヒープへ回った回数 (容量見直しの目安)
+    [[nodiscard]] uint64_t getHeapFallbackCount() const noexcept
+    {
+        return consumeAtomic(heapFallbacks, std::memory_order_relaxed); // relaxed: 統計カウンタのみ
+    }
+
+private:
+    alignas(BlockAlign) std::byte storage[kStride * Capacity];
+    std::array<std::atomic<uint64_t>, kWords> usedBits {};
+    std::atomic<std::size_t> nextWordHint { 0 };
+    std::atomic<uint64_t> heapFallbacks { 0 };
+};
+
+} // namespace convo
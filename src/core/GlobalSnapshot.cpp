@@ -2,9 +2,25 @@
 // GlobalSnapshot.cpp
 //==============================================================================
 #include "GlobalSnapshot.h"
+#include "FixedSlabPool.h"
 
 namespace convo {
 
+namespace {
+    // 公開中 1 + フェード元 1 + epoch 回収待ち。DeletionQueue の滞留を見込んで 64
+    FixedSlabPool<sizeof(GlobalSnapshot), alignof(GlobalSnapshot), 64> g_snapshotPool;
+}
+
+void* GlobalSnapshot::operator new(std::size_t size)
+{
+    return g_snapshotPool.allocate(size);
+}
+
+void GlobalSnapshot::operator delete(void* ptr) noexcept
+{
+    g_snapshotPool.deallocate(ptr);
+}
+
 GlobalSnapshot::GlobalSnapshot(const SnapshotParams& params) noexcept
     : convStateId(params.convStateId)
     , eqParams(params.eqParams)
@@ -7,6 +7,7 @@
 
 #include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include "EQParameters.h"
 #include "SnapshotParams.h"
@@ -65,6 +66,12 @@ struct GlobalSnapshot {
 
     // デストラクタは public（Factory::destroy で呼ばれるため）
     ~GlobalSnapshot();
+
+    // ★ 確保は型専用の FixedSlabPool（GlobalSnapshot.cpp）。
+    //   Factory::create / destroy の new / delete と epoch 回収の deleter はそのままスラブを使い、
+    //   定常的なパラメータ変更ではヒープ確保が発生しない（満杯時のみヒープへフォールバック）
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr) noexcept;
 };
 
 } // namespace convo
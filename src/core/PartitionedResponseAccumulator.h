@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace convo {
+
+//==============================================================================
+// PartitionedResponseAccumulator — パーティション スペクトルから IR 全長の周波数応答を組み立てる
+//
+//   IR を先頭 offset のパーティションに分け、各パーティションを gridSize 点 (ゼロ詰め) で
+//   変換したスペクトル H_p(k) を受け取り、周波数領域の overlap-add で全長の応答を得る:
+//     H(k) = Σ_p H_p(k) · exp(-j 2π k offset_p / gridSize)
+//   これは IR 全長の DTFT を gridSize 点の格子 (k · fs / gridSize) で標本化した値に厳密に一致する
+//   (格子より細かい区間の値は含まない)。offset が gridSize / 2 の倍数 (NUC の B 刻み・2B 点変換)
+//   なら位相項は ±1 で、三角関数を使わずに加算できる。
+//   入力は SoA (re / im 各 gridSize / 2 + 1 本)。JUCE 非依存。
+//==============================================================================
+
+class PartitionedResponseAccumulator
+{
+public:
+    explicit PartitionedResponseAccumulator(int gridSize)
+        : gridSize(gridSize),
+          complexSize(gridSize / 2 + 1),
+          accRe(static_cast<size_t>(gridSize / 2 + 1), 0.0),
+          accIm(static_cast<size_t>(gridSize / 2 + 1), 0.0)
+    {
+    }
+
+    [[nodiscard]] int getGridSize() const noexcept { return gridSize; }
+    [[nodiscard]] int getComplexSize() const noexcept { return complexSize; }
+
+    void addPartition(const double* re, const double* im, int64_t offsetSamples) noexcept
+    {
+        const int64_t half = gridSize / 2;
+        if (half > 0 && offsetSamples % half == 0)
+        {
+            // exp(-jπ k m): m が偶数なら全ビン +1、奇数なら奇数ビンだけ -1
+            const bool odd = ((offsetSamples / half) & 1) != 0;
+            for (int k = 0; k < complexSize; ++k)
+            {
+                const double sign = (odd && (k & 1) != 0) ? -1.0 : 1.0;
+                accRe[static_cast<size_t>(k)] += sign * re[k];
+                accIm[static_cast<size_t>(k)] += sign * im[k];
+            }
+            return;
+        }
+
+        // 一般の offset: 1 ビンごとの回転子を漸化式で進め、一定間隔で直接計算し直して誤差をリセットする
+        const double step = -2.0 * 3.14159265358979323846 * static_cast<double>(offsetSamples % gridSize)
+                          / static_cast<double>(gridSize);
+        const double stepRe = std::cos(step), stepIm = std::sin(step);
+        double rotRe = 1.0, rotIm = 0.0;
+        for (int k = 0; k < complexSize; ++k)
+        {
+            if ((k & 255) == 0)
+            {
+                rotRe = std::cos(step * k);
+                rotIm = std::sin(step * k);
+            }
+            const double xr = re[k], xi = im[k];
+            accRe[static_cast<size_t>(k)] += xr * rotRe - xi * rotIm;
+            accIm[static_cast<size_t>(k)] += xr * rotIm + xi * rotRe;
+            const double nextRe = rotRe * stepRe - rotIm * stepIm;
+            rotIm = rotRe * stepIm + rotIm * stepRe;
+            rotRe = nextRe;
+        }
+    }
+
+    [[nodiscard]] const double* real() const noexcept { return accRe.data(); }
+    [[nodiscard]] const double* imag() const noexcept { return accIm.data(); }
+
+    void magnitudes(double* dst) const noexcept
+    {
+        for (int k = 0; k < complexSize; ++k)
+            dst[k] = std::sqrt(accRe[static_cast<size_t>(k)] * accRe[static_cast<size_t>(k)]
+                             + accIm[static_cast<size_t>(k)] * accIm[static_cast<size_t>(k)]);
+    }
+
+    void reset() noexcept
+    {
+        std::fill(accRe.begin(), accRe.end(), 0.0);
+        std::fill(accIm.begin(), accIm.end(), 0.0);
+    }
+
+private:
+    int gridSize;
+    int complexSize;
+    std::vector<double> accRe;
+    std::vector<double> accIm;
+};
+
+} // namespace convo
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace convo {
+
+//==============================================================================
+// PcmDecode — メモリ上の非圧縮 WAV / AIFF を直接 double へ展開する
+//
+//   parse は RIFF/WAVE (PCM 16/24/32, IEEE float 32/64, EXTENSIBLE) と
+//   FORM/AIFF・AIFC (NONE/twos/sowt/fl32/fl64) のヘッダだけを読み、データ位置と形式を返す。
+//   対象外 (8bit・圧縮・RF64 など) は false を返し、呼び出し側は汎用リーダーへ落とす。
+//
+//   decodeChannel は 1 チャンネルの連続フレーム区間を変換する。整数 PCM は各サンプルの
+//   末尾 4 バイト (16/24bit ではサンプル直前のバイトを含む) を 32bit として読み、算術シフトで
+//   符号拡張する。このため data の直前 3 バイトが読めることを前提にする (ヘッダがあるので
+//   parse が返す dataOffset では常に満たす)。リトルエンディアンの 32bit 窓は AVX2 の gather で 8 本ずつ処理する。
+//   JUCE 非依存。
+//==============================================================================
+
+struct PcmLayout
+{
+    int numChannels = 0;
+    int bitsPerSample = 0;   // 16 / 24 / 32 / 64
+    bool isFloat = false;    // 32 / 64
+    bool bigEndian = false;
+    double sampleRate = 0.0;
+    uint64_t dataOffset = 0; // ファイル先頭からのバイト位置
+    uint64_t numFrames = 0;
+
+    [[nodiscard]] int bytesPerSample() const noexcept { return bitsPerSample / 8; }
+    [[nodiscard]] int bytesPerFrame() const noexcept { return bytesPerSample() * numChannels; }
+};
+
+struct PcmDecode
+{
+    [[nodiscard]] static bool parse(const uint8_t* file, uint64_t size, PcmLayout& out) noexcept
+    {
+        return parseWav(file, size, out) || parseAiff(file, size, out);
+    }
+
+    [[nodiscard]] static bool parseWav(const uint8_t* file, uint64_t size, PcmLayout& out) noexcept
+    {
+        if (size < 12 || std::memcmp(file, "RIFF", 4) != 0 || std::memcmp(file + 8, "WAVE", 4) != 0)
+            return false;
+
+        PcmLayout layout;
+        bool haveFormat = false;
+        for (uint64_t pos = 12; pos + 8 <= size;)
+        {
+            const uint8_t* chunk = file + pos;
+            const uint64_t chunkSize = readLE32(chunk + 4);
+            const uint64_t body = pos + 8;
+
+            if (std::memcmp(chunk, "fmt ", 4) == 0)
+            {
+                if (chunkSize < 16 || body + 16 > size)
+                    return false;
+                unsigned tag = readLE16(chunk + 8);
+                layout.numChannels = static_cast<int>(readLE16(chunk + 10));
+                layout.sampleRate = static_cast<double>(readLE32(chunk + 12));
+                const unsigned blockAlign = readLE16(chunk + 20);
+                layout.bitsPerSample = static_cast<int>(readLE16(chunk + 22));
+                if (tag == 0xFFFE)
+                {
+                    // WAVE_FORMAT_EXTENSIBLE: サブフォーマット GUID の先頭 2 バイトが実際の形式
+                    if (chunkSize < 40 || body + 40 > size)
+                        return false;
+                    tag = readLE16(chunk + 8 + 24);
+                }
+                if (tag == 1)
+                    layout.isFloat = false;
+                else if (tag == 3)
+                    layout.isFloat = true;
+                else
+                    return false;
+                if (!isSupported(layout) || blockAlign != static_cast<unsigned>(layout.bytesPerFrame()))
+                    return false;
+                haveFormat = true;
+            }
+            else if (std::memcmp(chunk, "data", 4) == 0)
+            {
+                if (!haveFormat)
+                    return false;
+                // ストリーミング書き出し途中のファイルはサイズ欄が 0 / 0xFFFFFFFF のことがある
+                const uint64_t available = size - body;
+                const uint64_t bytes = (chunkSize == 0 || chunkSize == 0xFFFFFFFFu || chunkSize > available) ? available : chunkSize;
+                layout.dataOffset = body;
+                layout.numFrames = bytes / static_cast<uint64_t>(layout.bytesPerFrame());
+                out = layout;
+                return layout.numFrames > 0;
+            }
+            pos = body + chunkSize + (chunkSize & 1);
+        }
+        return false;
+    }
+
+    [[nodiscard]] static bool parseAiff(const uint8_t* file, uint64_t size, PcmLayout& out) noexcept
+    {
+        if (size < 12 || std::memcmp(file, "FORM", 4) != 0)
+            return false;
+        const bool isAifc = std::memcmp(file + 8, "AIFC", 4) == 0;
+        if (!isAifc && std::memcmp(file + 8, "AIFF", 4) != 0)
+            return false;
+
+        PcmLayout layout;
+        layout.bigEndian = true;
+        uint64_t commFrames = 0;
+        bool haveFormat = false;
+        for (uint64_t pos = 12; pos + 8 <= size;)
+        {
+            const uint8_t* chunk = file + pos;
+            const uint64_t chunkSize = readBE32(chunk + 4);
+            const uint64_t body = pos + 8;
+
+            if (std::memcmp(chunk, "COMM", 4) == 0)
+            {
+                if (chunkSize < 18 || body + 18 > size)
+                    return false;
+                layout.numChannels = static_cast<int>(readBE16(chunk + 8));
+                commFrames = readBE32(chunk + 10);
+                layout.bitsPerSample = static_cast<int>(readBE16(chunk + 14));
+                layout.sampleRate = readExtended80(chunk + 16);
+                if (isAifc)
+                {
+                    if (chunkSize < 22 || body + 22 > size)
+                        return false;
+                    const uint8_t* type = chunk + 26;
+                    if (std::memcmp(type, "sowt", 4) == 0)
+                        layout.bigEndian = false;
+                    else if (std::memcmp(type, "fl32", 4) == 0 || std::memcmp(type, "FL32", 4) == 0
+                             || std::memcmp(type, "fl64", 4) == 0 || std::memcmp(type, "FL64", 4) == 0)
+                        layout.isFloat = true;
+                    else if (std::memcmp(type, "NONE", 4) != 0 && std::memcmp(type, "twos", 4) != 0)
+                        return false;
+                }
+                if (!isSupported(layout))
+                    return false;
+                haveFormat = true;
+            }
+            else if (std::memcmp(chunk, "SSND", 4) == 0)
+            {
+                if (!haveFormat || chunkSize < 8 || body + 8 > size)
+                    return false;
+                const uint64_t dataStart = body + 8 + readBE32(chunk + 8);
+                if (dataStart >= size)
+                    return false;
+                const uint64_t available = size - dataStart;
+                const uint64_t framesInChunk = (chunkSize - 8 < available ? chunkSize - 8 : available)
+                                             / static_cast<uint64_t>(layout.bytesPerFrame());
+                layout.dataOffset = dataStart;
+                layout.numFrames = (commFrames < framesInChunk) ? commFrames : framesInChunk;
+                out = layout;
+                return layout.numFrames > 0;
+            }
+            pos = body + chunkSize + (chunkSize & 1);
+        }
+        return false;
+    }
+
+    // data: ファイル先頭 + dataOffset。チャンネル ch のフレーム [begin, begin + count) を dst へ
+    static void decodeChannel(const uint8_t* data, const PcmLayout& layout, int ch,
+                              uint64_t begin, uint64_t count, double* dst) noexcept
+    {
+        const int sampleBytes = layout.bytesPerSample();
+        const int frameBytes = layout.bytesPerFrame();
+        // 各サンプルの末尾 4 バイト窓の先頭
+        const uint8_t* src = data + begin * static_cast<uint64_t>(frameBytes)
+                           + static_cast<uint64_t>(ch) * static_cast<uint64_t>(sampleBytes) + sampleBytes - 4;
+        uint64_t i = 0;
+
+        if (layout.bitsPerSample == 64)
+        {
+            for (; i < count; ++i)
+            {
+                const uint8_t* p = src + i * static_cast<uint64_t>(frameBytes) - 4;
+                uint64_t bits = 0;
+                std::memcpy(&bits, p, 8);
+                if (layout.bigEndian)
+                    bits = byteSwap64(bits);
+                std::memcpy(dst + i, &bits, 8);
+            }
+            return;
+        }
+
+        const int shift = 32 - layout.bitsPerSample;
+        const double scale = 1.0 / static_cast<double>(1u << (layout.bitsPerSample - 1));
+
+        if (layout.bigEndian)
+        {
+            // ビッグエンディアンでは窓ではなくサンプル自体を上位から組み立てる
+            const uint8_t* p = src + 4 - sampleBytes;
+            for (; i < count; ++i, p += frameBytes)
+            {
+                uint32_t word = 0;
+                for (int b = 0; b < sampleBytes; ++b)
+                    word = (word << 8) | p[b];
+                word <<= shift;
+                dst[i] = toDouble(word, layout.isFloat, shift, scale);
+            }
+            return;
+        }
+
+#if defined(__AVX2__)
+        const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(frameBytes));
+        const __m256d vScale = _mm256_set1_pd(scale);
+        const __m128i vShift = _mm_cvtsi32_si128(shift);
+        for (; i + 8 <= count; i += 8)
+        {
+            const int* base = reinterpret_cast<const int*>(src + i * static_cast<uint64_t>(frameBytes));
+            if (layout.isFloat)
+            {
+                const __m256 v = _mm256_i32gather_ps(reinterpret_cast<const float*>(base), offsets, 1);
+                _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+                _mm256_storeu_pd(dst + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+            }
+            else
+            {
+                const __m256i v = _mm256_sra_epi32(_mm256_i32gather_epi32(base, offsets, 1), vShift);
+                _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(v)), vScale));
+                _mm256_storeu_pd(dst + i + 4, _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)), vScale));
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            uint32_t word = 0;
+            std::memcpy(&word, src + i * static_cast<uint64_t>(frameBytes), 4);
+            dst[i] = toDouble(word, layout.isFloat, shift, scale);
+        }
+    }
+
+private:
+    [[nodiscard]] static bool isSupported(const PcmLayout& layout) noexcept
+    {
+        if (layout.numChannels <= 0 || !(layout.sampleRate > 0.0))
+            return false;
+        if (layout.isFloat)
+            return layout.bitsPerSample == 32 || layout.bitsPerSample == 64;
+        return layout.bitsPerSample == 16 || layout.bitsPerSample == 24 || layout.bitsPerSample == 32;
+    }
+
+    // word: サンプルを上位ビットに詰めた 32bit (整数は算術シフトで符号拡張する)
+    [[nodiscard]] static double toDouble(uint32_t word, bool isFloat, int shift, double scale) noexcept
+    {
+        if (isFloat)
+        {
+            float f = 0.0f;
+            std::memcpy(&f, &word, 4);
+            return static_cast<double>(f);
+        }
+        return static_cast<double>(static_cast<int32_t>(word) >> shift) * scale;
+    }
+
+    [[nodiscard]] static uint32_t readLE16(const uint8_t* p) noexcept { return p[0] | (uint32_t(p[1]) << 8); }
+    [[nodiscard]] static uint32_t readLE32(const uint8_t* p) noexcept { return readLE16(p) | (readLE16(p + 2) << 16); }
+    [[nodiscard]] static uint32_t readBE16(const uint8_t* p) noexcept { return (uint32_t(p[0]) << 8) | p[1]; }
+    [[nodiscard]] static uint32_t readBE32(const uint8_t* p) noexcept { return (readBE16(p) << 16) | readBE16(p + 2); }
+
+    [[nodiscard]] static uint64_t byteSwap64(uint64_t v) noexcept
+    {
+        uint64_t r = 0;
+        for (int b = 0; b < 8; ++b, v >>= 8)
+            r = (r << 8) | (v & 0xFF);
+        return r;
+    }
+
+    // AIFF のサンプルレート (IEEE 754 拡張精度 80bit, ビッグエンディアン)
+    [[nodiscard]] static double readExtended80(const uint8_t* p) noexcept
+    {
+        const int exponent = static_cast<int>(((p[0] & 0x7F) << 8) | p[1]);
+        uint64_t mantissa = 0;
+        for (int b = 0; b < 8; ++b)
+            mantissa = (mantissa << 8) | p[2 + b];
+        if (exponent == 0 && mantissa == 0)
+            return 0.0;
+        const double value = std::ldexp(static_cast<double>(mantissa), exponent - 16383 - 63);
+        return (p[0] & 0x80) ? -value : value;
+    }
+};
+
+} // namespace convo
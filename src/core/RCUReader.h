@@ -190,6 +190,11 @@ class RCUReaderGuard
 {
 public:
     explicit RCUReaderGuard(RCUReader& r) noexcept : reader(&r) { reader->enter(); }
+    // alreadyPinned: 呼び出し元 (CallbackReaderScope) が r を固定済みなら enter/exit しない
+    RCUReaderGuard(RCUReader& r, bool alreadyPinned) noexcept : reader(alreadyPinned ? nullptr : &r)
+    {
+        if (reader) reader->enter();
+    }
     ~RCUReaderGuard() noexcept { if (reader) reader->exit(); }
 
     RCUReaderGuard(const RCUReaderGuard&) = delete;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "audioengine/AtomicAccess.h"
+
+namespace convo {
+
+//==============================================================================
+// SeqlockSnapshot — 観測用スナップショット (ライタは待たない・リーダは複数)
+//
+//   ライタは publish(value) で T 全体を書き、リーダは read() で一貫した 1 枚をコピーする。
+//   書き込み中 (sequence が奇数) か読み取り中に sequence が変わったらリーダが読み直すだけで、
+//   ライタ側はリーダの有無を見ない (Audio Thread から呼べる)。
+//   個別の atomic を何十個も読む代わりに、リーダは 1 回の read() で全フィールドを同じ時点で得る。
+//
+//   中身は 8 byte の atomic 語に分けて relaxed で読み書きする (データ競合にしない)。
+//   ライタ同士は sequence の CAS で書き込み権を取り合い、負けた側は書かずに false を返す
+//   (次の publish で最新値が出るため観測用途では取りこぼしてよい)。
+//==============================================================================
+#ifdef _MSC_VER
+#pragma warning(push) // C4324 suppression scope begin: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#pragma warning(disable : 4324) // Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#endif
+template <typename T>
+class alignas(64) SeqlockSnapshot
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqlockSnapshot requires a trivially copyable payload");
+
+public:
+    SeqlockSnapshot() noexcept { publish(T {}); }
+    SeqlockSnapshot(const SeqlockSnapshot&) = delete;
+    SeqlockSnapshot& operator=(const SeqlockSnapshot&) = delete;
+
+    // 任意のスレッド。別のライタが書き込み中なら何もせず false
+    bool publish(const T& value) noexcept
+    {
+        std::array<std::uint64_t, kWords> words {};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        std::uint64_t seq = convo::consumeAtomic(sequence_, std::memory_order_relaxed); // relaxed: 奇偶の判定だけ。書き込み権は下の CAS で取る
+        if ((seq & 1u) != 0)
+            return false;
+        // CAS acquire: 前のライタの最後の release と HB し、その中身の後ろに書く (奇数化をリーダへ見せる順序は
+        //             直後の release fence が担う)。失敗 = 他ライタが先に奇数化した
+        if (!convo::compareExchangeAtomic(sequence_, seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return false;
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i)
+            convo::publishAtomic(payload_[i], words[i], std::memory_order_relaxed); // relaxed: 順序は sequence と fence が担う
+        convo::publishAtomic(sequence_, seq + 2, std::memory_order_release); // release: read() の acquire と HB し中身を渡す
+        return true;
+    }
+
+    // 任意のスレッド。ライタが書き込み中なら書き終わるまで読み直す
+    [[nodiscard]] T read() const noexcept
+    {
+        std::array<std::uint64_t, kWords> words {};
+        for (;;)
+        {
+            const std::uint64_t before = convo::consumeAtomic(sequence_, std::memory_order_acquire); // acquire: publish の最後の release と HB
+            if ((before & 1u) == 0)
+            {
+                for (size_t i = 0; i < kWords; ++i)
+                    words[i] = convo::consumeAtomic(payload_[i], std::memory_order_relaxed); // relaxed: 下の acquire fence で sequence の再読より前に確定
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (convo::consumeAtomic(sequence_, std::memory_order_relaxed) == before) // relaxed: fence 済み
+                    break;
+            }
+        }
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+    // 公開回数 (変化検知用)
+    [[nodiscard]] std::uint64_t version() const noexcept
+    {
+        return convo::consumeAtomic(sequence_, std::memory_order_acquire) >> 1; // acquire: publish の release と HB
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> sequence_ { 0 };
+    std::array<std::atomic<std::uint64_t>, kWords> payload_ {};
+};
+#ifdef _MSC_VER
+#pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
+#endif
+
+} // namespace convo
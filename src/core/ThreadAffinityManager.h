@@ -24,14 +24,20 @@ enum class ThreadType
     LearnerMain,
     LearnerEval,
     HeavyBackground,
+    ConvolverTail,  // ★ NUC Tail Worker: heavyBackground マスク上で L1/L2 畳み込みを実行。
+                    //   パーティション境界のデッドラインがあるため HeavyBackground より高優先度。
     LightBackground,
     UI,
+    OfflineRender,  // ★ オフライン一括レンダーのワーカー: evalWorkerIndex 番目の物理コア (SMT 兄弟を含む) へ固定。
+                    //   Audio デバイスを外して走るため Audio 専用コアも使う。
     AudioRealtime  // ★ [work64] 将来の拡張性のため。現在 AudioThread の affinity は
                    //   applyMmcssPriority() 内で直接 SetThreadAffinityMask しているため、
                    //   本 enum を applyCurrentThreadPolicy() で使うと二重適用になる。
                    //   二重適用自体は無害（同一マスクの再設定）だが、責務は
                    //   tryApplyMmcssForSelfManagedThread() → applyMmcssPriority() (Timer.cpp)
                    //   側にあり、applyCurrentThreadPolicy は将来のリファクタリング用に用意。
+                   //   DSPCore の Channel split helper は本 enum で Audio Thread と同じ物理コア
+                   //   (SMT 兄弟の論理プロセッサ) へ固定する (DSPCore::configureChannelSplit)。
                    // ★ v19: convo::numeric_policy::ThreadRole::AudioRealtime (DspNumericPolicy.h)
                    //   とは別概念。そちらはランタイムスレッド検出（assertion用）であり、
                    //   CPUアフィニティ管理とは無関係。名前空間が異なるため衝突なし。
@@ -45,16 +51,22 @@ struct ThreadAffinityMasks
     DWORD_PTR learnerEvalBase = 0;
     DWORD_PTR heavyBackground = 0;
     DWORD_PTR audioRealtime = 0;  // ★ [work64] Audioスレッド専用コアマスク
+    DWORD_PTR audioCluster = 0;   // Audio コアと L2 を共有する論理プロセッサ (audioRealtime を含む)
     DWORD_PTR lightBackground = 0;
     DWORD_PTR ui = 0;
+    std::array<DWORD_PTR, 64> physicalCores{};  // 物理コアごとのマスク (OfflineRender 用)
+    int physicalCoreCount = 0;
 #else
     std::uint64_t worker = 0;
     std::uint64_t learnerMain = 0;
     std::uint64_t learnerEvalBase = 0;
     std::uint64_t heavyBackground = 0;
     std::uint64_t audioRealtime = 0;
+    std::uint64_t audioCluster = 0;
     std::uint64_t lightBackground = 0;
     std::uint64_t ui = 0;
+    std::array<std::uint64_t, 64> physicalCores{};
+    int physicalCoreCount = 0;
 #endif
 };
 
@@ -69,6 +81,8 @@ struct CoreTopology {
     int physicalCoreCount = 0;
     bool hasHeterogeneousArchitecture = false;
     std::vector<PhysicalCoreInfo> cores;  // mask 最下位ビット順にソート済み
+    std::vector<DWORD_PTR> l2Caches;      // L2 キャッシュごとの共有論理プロセッサ集合
+    std::vector<DWORD_PTR> numaNodes;     // NUMA ノードごとの論理プロセッサ集合 (プロセッサグループ 0 のみ)
 };
 
 class ThreadAffinityManager
@@ -129,6 +143,10 @@ public:
                 mask = masks_.heavyBackground;
                 priority = THREAD_PRIORITY_BELOW_NORMAL;
                 break;
+            case ThreadType::ConvolverTail:
+                mask = masks_.heavyBackground;
+                priority = THREAD_PRIORITY_HIGHEST;
+                break;
             case ThreadType::LightBackground:
                 mask = masks_.lightBackground;
                 priority = THREAD_PRIORITY_LOWEST;
@@ -137,6 +155,10 @@ public:
                 mask = masks_.ui;
                 priority = THREAD_PRIORITY_NORMAL;
                 break;
+            case ThreadType::OfflineRender:
+                mask = getOfflineRenderMask(evalWorkerIndex);
+                priority = THREAD_PRIORITY_NORMAL;
+                break;
             case ThreadType::AudioRealtime:
                 // ★ [work64] MMCSS が優先度管理済みのため SetThreadPriority を呼ばず return
                 mask = masks_.audioRealtime;
@@ -157,11 +179,90 @@ public:
 #endif
     }
 
+    // OfflineRender で 1 ワーカー 1 物理コアに固定できる数 (0 = アフィニティ無効。P/E 混在を含む)
+    [[nodiscard]] int getOfflineRenderCoreCount() const noexcept {
+        return masks_.physicalCoreCount;
+    }
+
     // ★ [work64] AudioRealtime マスクアクセサ
     [[nodiscard]] DWORD_PTR getAudioRealtimeMask() const noexcept {
         return masks_.audioRealtime;
     }
 
+    // ★ 評価ワーカーの Audio クラスタ退避 (AffinityRebalancer の判定を Message Thread から反映する)
+    //   退避中は learnerEvalBase から Audio コアと L2 を共有する論理プロセッサを除く。
+    //   評価ワーカーは次のディスパッチ起床時に世代の変化を見て自分でマスクを掛け直す。
+    [[nodiscard]] bool canRestrictLearnerEval() const noexcept
+    {
+        const DWORD_PTR restrictedBase = masks_.learnerEvalBase & ~masks_.audioCluster;
+        return restrictedBase != 0 && restrictedBase != masks_.learnerEvalBase;
+    }
+
+    bool setLearnerEvalRestricted(bool restricted) noexcept
+    {
+        if (restricted && !canRestrictLearnerEval())
+            return false;
+        // acq_rel: 直前の状態を読みつつ、世代の公開より先に新しい状態を見せる
+        if (convo::exchangeAtomic(learnerEvalRestricted_, restricted, std::memory_order_acq_rel) == restricted)
+            return false;
+        // release: 世代を観測したワーカーが learnerEvalRestricted_ の新しい値を読む
+        convo::fetchAddAtomic(learnerEvalPolicyGeneration_, uint32_t{1}, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool isLearnerEvalRestricted() const noexcept
+    {
+        return convo::consumeAtomic(learnerEvalRestricted_, std::memory_order_acquire);
+    }
+
+    [[nodiscard]] uint32_t getLearnerEvalPolicyGeneration() const noexcept
+    {
+        return convo::consumeAtomic(learnerEvalPolicyGeneration_, std::memory_order_acquire);
+    }
+
+    // ★ 評価ワーカーの CPU 時間 (100 ns 単位の累積)。ワーカーがジョブごとに加算し、timer が差分を取る
+    void addLearnerEvalCpuTime(uint64_t cpuTime100ns) noexcept
+    {
+        convo::fetchAddAtomic(learnerEvalCpuTime100ns_, cpuTime100ns, std::memory_order_relaxed); // relaxed: 単調な統計カウンタ
+    }
+
+    [[nodiscard]] uint64_t getLearnerEvalCpuTime() const noexcept
+    {
+        return convo::consumeAtomic(learnerEvalCpuTime100ns_, std::memory_order_relaxed); // relaxed: 単調な統計カウンタ
+    }
+
+    // 呼び出しスレッドの累積 CPU 時間 (kernel + user, 100 ns 単位。取得できない環境では 0)
+    static uint64_t currentThreadCpuTime() noexcept
+    {
+#ifdef _WIN32
+        FILETIME creation{}, exit{}, kernel{}, user{};
+        if (!::GetThreadTimes(::GetCurrentThread(), &creation, &exit, &kernel, &user))
+            return 0;
+        auto toUint64 = [](const FILETIME& t) noexcept {
+            return (static_cast<uint64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+        };
+        return toUint64(kernel) + toUint64(user);
+#else
+        return 0;
+#endif
+    }
+
+    // 呼び出しスレッドが今走っている NUMA ノード (取得できない環境では -1)。
+    // 固定済みのスレッドではその間の確保先 (first touch) のノードと一致する
+    static int currentThreadNumaNode() noexcept
+    {
+#ifdef _WIN32
+        PROCESSOR_NUMBER processor{};
+        ::GetCurrentProcessorNumberEx(&processor);
+        USHORT node = 0;
+        if (!::GetNumaProcessorNodeEx(&processor, &node) || node == 0xFFFF)
+            return -1;
+        return static_cast<int>(node);
+#else
+        return -1;
+#endif
+    }
+
     // ★ [work64] コアトポロジ検出（static メソッド / 起動時に1度だけ呼ばれる）
     static CoreTopology detectCoreTopology() noexcept
     {
@@ -225,6 +326,54 @@ public:
                 }
             }
         }
+
+        // 6. L2 キャッシュの共有範囲 (Audio クラスタの算出用。取れなければ空のまま)
+        DWORD cacheLen = 0;
+        if (!::GetLogicalProcessorInformationEx(RelationCache, nullptr, &cacheLen)
+            && ::GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+            std::vector<BYTE> cacheBuf(cacheLen);
+            if (::GetLogicalProcessorInformationEx(RelationCache,
+                    reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(cacheBuf.data()),
+                    &cacheLen)) {
+                DWORD cacheOffset = 0;
+                while (cacheOffset + sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX) <= cacheLen) {
+                    auto* info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(
+                        cacheBuf.data() + cacheOffset);
+                    if (info->Size == 0 || cacheOffset + info->Size > cacheLen) break;
+
+                    if (info->Relationship == RelationCache
+                        && info->Cache.Level == 2
+                        && info->Cache.GroupMask.Mask != 0) {
+                        topo.l2Caches.push_back(info->Cache.GroupMask.Mask);
+                    }
+                    cacheOffset += info->Size;
+                }
+            }
+        }
+
+        // 7. NUMA ノード (マルチソケット時の確保先の算出用。取れなければ空のまま)
+        DWORD numaLen = 0;
+        if (!::GetLogicalProcessorInformationEx(RelationNumaNode, nullptr, &numaLen)
+            && ::GetLastError() == ERROR_INSUFFICIENT_BUFFER) {
+            std::vector<BYTE> numaBuf(numaLen);
+            if (::GetLogicalProcessorInformationEx(RelationNumaNode,
+                    reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(numaBuf.data()),
+                    &numaLen)) {
+                DWORD numaOffset = 0;
+                while (numaOffset + sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX) <= numaLen) {
+                    auto* info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(
+                        numaBuf.data() + numaOffset);
+                    if (info->Size == 0 || numaOffset + info->Size > numaLen) break;
+
+                    if (info->Relationship == RelationNumaNode
+                        && info->NumaNode.GroupMask.Group == 0
+                        && info->NumaNode.GroupMask.Mask != 0) {
+                        topo.numaNodes.push_back(info->NumaNode.GroupMask.Mask);
+                    }
+                    numaOffset += info->Size;
+                }
+            }
+        }
 #endif
         return topo;
     }
@@ -247,12 +396,30 @@ public:
             nonAudioMask |= topo.cores[i].mask;
 
         m.audioRealtime   = topo.cores[N - 1].mask;
+        m.audioCluster    = m.audioRealtime;
+        for (const DWORD_PTR l2 : topo.l2Caches) {
+            if ((l2 & m.audioRealtime) != 0)
+                m.audioCluster |= l2;
+        }
         m.worker          = topo.cores[0].mask;
         m.learnerMain     = topo.cores[std::min(size_t{1}, N - 2)].mask;
         m.learnerEvalBase = nonAudioMask;
         m.heavyBackground = nonAudioMask;
+        // ★ NUMA: マルチソケットでは IR の読み込み・DSP 再構築・Tail Worker を Audio コアと同じノードに寄せる。
+        //   これらが確保して最初に書いた PreparedIRState / NUC のレイヤー・スペクトルは first touch で
+        //   そのノードに載り、Audio Thread と Tail Worker がリモートメモリを読まずに済む
+        if (topo.numaNodes.size() > 1) {
+            for (const DWORD_PTR node : topo.numaNodes) {
+                if ((node & m.audioRealtime) != 0 && (node & nonAudioMask) != 0)
+                    m.heavyBackground = node & nonAudioMask;
+            }
+        }
         m.lightBackground = nonAudioMask;
         m.ui              = nonAudioMask;
+
+        m.physicalCoreCount = static_cast<int>(std::min(N, m.physicalCores.size()));
+        for (size_t i = 0; i < static_cast<size_t>(m.physicalCoreCount); ++i)
+            m.physicalCores[i] = topo.cores[i].mask;
         return m;
     }
 
@@ -262,7 +429,9 @@ private:
 #ifdef _WIN32
     DWORD_PTR getEvalWorkerMask(int workerIndex) const noexcept
     {
-        const DWORD_PTR base = masks_.learnerEvalBase;
+        const DWORD_PTR base = isLearnerEvalRestricted()
+            ? (masks_.learnerEvalBase & ~masks_.audioCluster)
+            : masks_.learnerEvalBase;
         if (base == 0)
             return 0;
 
@@ -285,8 +454,20 @@ private:
         const int normalized = workerIndex < 0 ? 0 : workerIndex;
         return bits[static_cast<size_t>(normalized) % count];
     }
+
+    DWORD_PTR getOfflineRenderMask(int workerIndex) const noexcept
+    {
+        if (masks_.physicalCoreCount <= 0)
+            return 0;
+
+        const int normalized = workerIndex < 0 ? 0 : workerIndex;
+        return masks_.physicalCores[static_cast<size_t>(normalized % masks_.physicalCoreCount)];
+    }
 #endif
 
     ThreadAffinityMasks masks_;
     std::atomic<bool> initialized_{false};
+    std::atomic<bool> learnerEvalRestricted_{false};
+    std::atomic<uint32_t> learnerEvalPolicyGeneration_{0};
+    std::atomic<uint64_t> learnerEvalCpuTime100ns_{0};
 };
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "audioengine/AtomicAccess.h"
+
+namespace convo {
+
+//==============================================================================
+// TripleBuffer — 1 ライタ・1 リーダの最新値受け渡し (待ちなし)
+//
+//   ライタは writeBuffer() を埋めて publish()、リーダは consume() で最新のフレームに切り替えて
+//   readBuffer() を読む。3 枚のうち 1 枚をライタ、1 枚をリーダが占有し、残り 1 枚 (middle) を
+//   exchange で受け渡すので、どちらも相手を待たない。リーダが読む前に 2 回 publish されたフレームは
+//   上書きされる (最新だけが必要な表示用)。
+//==============================================================================
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // ライタ専用
+    [[nodiscard]] T& writeBuffer() noexcept { return buffers_[writeIndex_]; }
+
+    void publish() noexcept
+    {
+        // acq_rel: release で書いた中身をリーダへ渡し、acquire でリーダが手放したスロットの読み終わりを見る
+        const uint8_t previous = convo::exchangeAtomic(middle_, static_cast<uint8_t>(writeIndex_ | kFreshBit),
+                                                       std::memory_order_acq_rel);
+        writeIndex_ = previous & kIndexMask;
+    }
+
+    // リーダ専用。新しいフレームがあれば readBuffer() をそれに切り替えて true
+    bool consume() noexcept
+    {
+        // relaxed: 新しいフレームの有無の判定のみ。中身の可視性は下の exchange が保証する
+        if ((convo::consumeAtomic(middle_, std::memory_order_relaxed) & kFreshBit) == 0)
+            return false;
+        // acq_rel: acquire でライタの中身を見て、release で読み終えたスロットを返す
+        const uint8_t previous = convo::exchangeAtomic(middle_, readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previous & kIndexMask;
+        return true;
+    }
+
+    [[nodiscard]] const T& readBuffer() const noexcept { return buffers_[readIndex_]; }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFreshBit = 0x4;
+
+    std::array<T, 3> buffers_ {};
+    uint8_t writeIndex_ = 0;                 // ライタ専用
+    std::atomic<uint8_t> middle_ { 1 };      // 受け渡し中のスロット + 未読フラグ
+    uint8_t readIndex_ = 2;                  // リーダ専用
+};
+
+} // namespace convo
@@ -16,7 +16,8 @@ enum class ProcessingOrder {
 // オーバーサンプリングフィルタタイプ
 enum class OversamplingType {
     IIR = 0,
-    LinearPhase = 1
+    LinearPhase = 1,
+    MinimumPhase = 2   // ポリフェーズ全域通過 IIR ハーフバンド (低遅延モニタリング用)
 };
 
 // ノイズシェーパータイプ
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "audioengine/AtomicAccess.h"
+
+//==============================================================================
+// WorkStealingRanges — 固定タスク集合 [0, taskCount) のロックフリー work-stealing 分配
+//
+//   各ワーカーは自分の連続範囲 [begin, end) を 64bit atomic 1 個に持ち、
+//     - 所有者は先頭から 1 個ずつ取る (連続タスク = キャッシュ局所性を保つ)
+//     - 自分の範囲が空になったら他ワーカーの範囲の後半 (ceil(n/2)) を奪う
+//   すべて CAS で行う。範囲値は「未処理タスクの集合」そのものを表すため、
+//   同じ値が再出現しても意味は同じで ABA は問題にならない。
+//   空の範囲は CAS 対象にならないので、奪った残りを自スロットへ置くのは store でよい。
+//
+//   reset() は全ワーカーが停止中に呼ぶこと (ディスパッチ側のミューテックスで公開する)。
+//   タスクは追加されないため、全スロットが空になった時点で全タスクが誰かに渡っている。
+//==============================================================================
+
+namespace convo {
+
+template <int MaxWorkers>
+class WorkStealingRanges
+{
+public:
+    static_assert(MaxWorkers > 0, "MaxWorkers must be positive");
+
+    // taskCount 個のタスクを workerCount 個のスロットへ均等に連続分割する
+    void reset(int taskCount, int workerCount) noexcept
+    {
+        activeWorkers = std::clamp(workerCount, 1, MaxWorkers);
+        const auto total = static_cast<uint32_t>(std::max(0, taskCount));
+        for (int w = 0; w < MaxWorkers; ++w)
+        {
+            const auto begin = static_cast<uint32_t>((static_cast<uint64_t>(total) * static_cast<uint64_t>(std::min(w, activeWorkers))) / static_cast<uint64_t>(activeWorkers));
+            const auto end = static_cast<uint32_t>((static_cast<uint64_t>(total) * static_cast<uint64_t>(std::min(w + 1, activeWorkers))) / static_cast<uint64_t>(activeWorkers));
+            publishAtomic(slots[static_cast<size_t>(w)].range, pack(begin, end), std::memory_order_relaxed);
+        }
+    }
+
+    // 次のタスクを task に書いて true。自分の範囲も奪える範囲もなければ false
+    bool pop(int worker, int& task) noexcept
+    {
+        auto& own = slots[static_cast<size_t>(worker)].range;
+
+        uint64_t current = consumeAtomic(own, std::memory_order_acquire);
+        while (beginOf(current) < endOf(current))
+        {
+            if (compareExchangeAtomic(own, current, pack(beginOf(current) + 1, endOf(current))))
+            {
+                task = static_cast<int>(beginOf(current));
+                return true;
+            }
+        }
+
+        // 自分の範囲は空 → 隣から順に後半を奪う。奪った先頭は即実行し、残りを自スロットへ
+        for (int offset = 1; offset < activeWorkers; ++offset)
+        {
+            auto& victim = slots[static_cast<size_t>((worker + offset) % activeWorkers)].range;
+            uint64_t observed = consumeAtomic(victim, std::memory_order_acquire);
+            while (beginOf(observed) < endOf(observed))
+            {
+                const uint32_t begin = beginOf(observed);
+                const uint32_t end = endOf(observed);
+                const uint32_t stolenBegin = end - ((end - begin + 1) / 2);
+                if (compareExchangeAtomic(victim, observed, pack(begin, stolenBegin)))
+                {
+                    publishAtomic(own, pack(stolenBegin + 1, end), std::memory_order_release);
+                    task = static_cast<int>(stolenBegin);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] int workerCount() const noexcept { return activeWorkers; }
+
+private:
+    static constexpr uint64_t pack(uint32_t begin, uint32_t end) noexcept
+    {
+        return (static_cast<uint64_t>(end) << 32) | begin;
+    }
+    static constexpr uint32_t beginOf(uint64_t range) noexcept { return static_cast<uint32_t>(range); }
+    static constexpr uint32_t endOf(uint64_t range) noexcept { return static_cast<uint32_t>(range >> 32); }
+
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> range { 0 };
+    };
+
+    std::array<Slot, MaxWorkers> slots {};
+    int activeWorkers = 1;
+};
+
+} // namespace convo
@@ -3,29 +3,16 @@
 //==============================================================================
 
 #include "WorkerThread.h"
-#include "ThreadAffinityManager.h"
-#include "../GenerationManager.h"
 
-#include <chrono>
-#include <thread>
+#include <utility>
 
 #include "audioengine/AtomicAccess.h"
 
-#if defined(__x86_64__) || defined(_M_X64) || defined(_M_IX86)
- #include <xmmintrin.h>
- #include <pmmintrin.h>
-#endif
-
 namespace convo {
 
-WorkerThread::WorkerThread(CommandBuffer& cmdBuf,
-                           GenerationManager& genMgr,
-                   const ThreadAffinityManager* affinityMgr,
-                           const WorkerThreadConfig& cfg)
-    : commandBuffer(cmdBuf),
-      generationManager(genMgr),
-    affinityManager(affinityMgr),
-      config(cfg)
+WorkerThread::WorkerThread(Callback onDueCallback, Callback onThreadStartCallback)
+    : onDue(std::move(onDueCallback)),
+      onThreadStart(std::move(onThreadStartCallback))
 {
 }
 
@@ -39,80 +26,88 @@ void WorkerThread::start()
     if (thread.joinable())
         return;
 
-    convo::publishAtomic(running, true, std::memory_order_release);    // release: run() の running acquire と HB しスレッド起動を公知
-    convo::publishAtomic(pendingFlush, false, std::memory_order_release); // release: run() の exchangeAtomic acq_rel と HB し初期状態を公知
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = true;
+    }
     thread = std::thread(&WorkerThread::run, this);
 }
 
+void WorkerThread::requestStop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+        deadline = kNoDeadline;
+    }
+    cv.notify_all();
+}
+
 void WorkerThread::stop()
 {
-    convo::publishAtomic(running, false, std::memory_order_release);    // release: run() の running acquire と HB しスレッド停止を通知
-    convo::publishAtomic(pendingFlush, true, std::memory_order_release); // release: run() の exchangeAtomic acq_rel と HB し flush 要求を公知
+    requestStop();
 
     if (thread.joinable())
         thread.join();
 }
 
-void WorkerThread::run()
+void WorkerThread::scheduleAt(Clock::time_point newDeadline)
 {
-    if (affinityManager != nullptr)
-        affinityManager->applyCurrentThreadPolicy(ThreadType::Worker);
-
-#if defined(__x86_64__) || defined(_M_X64) || defined(_M_IX86)
-    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
-    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
-#endif
-
-    bool hasPending = false;
-    uint64_t latestCommandGeneration = 0;
-    auto lastCommandTime = std::chrono::steady_clock::now();
-
-    while (convo::consumeAtomic(running, std::memory_order_acquire)) {  // acquire: start()/stop() の publishAtomic release と HB
-        ParameterCommand cmd;
-        bool poppedAny = false;
-        bool flushRequested = convo::exchangeAtomic(pendingFlush, false, std::memory_order_acq_rel); // acq_rel: acquire で stop() の release と HB; release で次回観測と HB
-
-        while (commandBuffer.pop(cmd)) {
-            poppedAny = true;
-#ifdef _DEBUG
-            convo::fetchAddAtomic(commandsReceived, 1, std::memory_order_acq_rel); // acq_rel: getCommandsReceived acquire と HB — カウント単調増加を保証
-#endif
-            latestCommandGeneration = cmd.generation; // 最新の世代のみ保持
-            lastCommandTime = std::chrono::steady_clock::now();
-        }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running || newDeadline >= deadline)
+            return;
+        deadline = newDeadline;
+    }
+    // 期限が前倒しになったときだけ起こし、待ち時間を計算し直させる
+    cv.notify_one();
+}
 
-        if (poppedAny)
-            hasPending = true;
+void WorkerThread::scheduleAfter(std::chrono::milliseconds delay)
+{
+    scheduleAt(Clock::now() + delay);
+}
 
-        // flush 要求または pending のデバウンス満了時にスナップショットを生成する。
-        if (flushRequested || hasPending) {
-            const auto now = std::chrono::steady_clock::now();
-            const auto elapsedMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - lastCommandTime).count());
+void WorkerThread::wake()
+{
+    scheduleAt(Clock::now());
+}
 
-            if (flushRequested || elapsedMs >= config.debounceDelayMs) {
-                hasPending = false;
+bool WorkerThread::hasDeadline() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return deadline != kNoDeadline;
+}
 
-                // SnapshotCreatorCallback removed (#3.2.8): snapshot creation is now
-                // handled via submitRebuildIntent() directly from the intent source.
-                // The worker thread no longer needs to create snapshots on demand.
-                (void)generationManager;
-                (void)latestCommandGeneration;
-            }
+void WorkerThread::run()
+{
+    if (onThreadStart)
+        onThreadStart();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running)
+    {
+        if (deadline == kNoDeadline)
+        {
+            // 期限なし: 次の scheduleAt / stop まで眠る (アイドル時は CPU を使わない)
+            cv.wait(lock, [this] { return !running || deadline != kNoDeadline; });
+            continue;
         }
 
-        if (!poppedAny) {
-            const int sleepChunks = (config.idleSleepMs > 0)
-                ? ((config.idleSleepMs + 1) / 2)
-                : 0;
-
-            for (int i = 0; i < sleepChunks; ++i) {
-                if (!convo::consumeAtomic(running, std::memory_order_acquire))  // acquire: stop() の publishAtomic release と HB — 早期終了判定
-                    break;
-
-                std::this_thread::sleep_for(std::chrono::milliseconds(2));
-            }
+        if (Clock::now() < deadline)
+        {
+            // 期限まで眠る。前倒し登録・stop で起こされたら待ち直す
+            const auto waitUntil = deadline;
+            cv.wait_until(lock, waitUntil);
+            continue;
         }
+
+        deadline = kNoDeadline;
+        lock.unlock();
+        fetchAddAtomic(wakeCount, uint64_t{1}, std::memory_order_relaxed); // relaxed: 統計カウンタのみ
+        if (onDue)
+            onDue();
+        lock.lock();
     }
 }
 
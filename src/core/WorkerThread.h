@@ -1,62 +1,75 @@
 //==============================================================================
 // WorkerThread.h
-// Debounced snapshot update worker
+// Deadline-driven wake worker (event-driven rebuild dispatch)
+//
+// ★ ポーリングしない起床スレッド
+//   期限 (deadline) が 1 つも無い間は condition_variable で無期限に待ち、CPU を使わない。
+//   scheduleAt / scheduleAfter で期限を登録すると、最も早い期限で起きて onDue を 1 回呼ぶ。
+//   期限は 1 本に畳まれる（既存より早い期限だけが前倒しで反映される）ため、
+//   同じ期限へのバースト登録は 1 回の起床になる。
+//
+//   スレッド:
+//     scheduleAt / scheduleAfter / wake : 任意の Non-RT スレッド（内部 mutex を短時間保持）
+//     onDue / onThreadStart             : ワーカースレッド上で呼ばれる
+//   AudioEngine は onDue で triggerAsyncUpdate し、遅延 rebuild の判定と発行を
+//   Message Thread の handleAsyncUpdate で行う。
 //==============================================================================
 #pragma once
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
 #include <thread>
-#include "CommandBuffer.h"
 
 #include "audioengine/AtomicAccess.h"
 
-class GenerationManager;
-class ThreadAffinityManager;
-
 namespace convo {
 
-struct WorkerThreadConfig {
-    int debounceDelayMs = 50;
-    int idleSleepMs = 10;
-};
-
 class WorkerThread {
 public:
-    WorkerThread(CommandBuffer& cmdBuf,
-                 GenerationManager& genManager,
-                 const ThreadAffinityManager* affinityMgr,
-                 const WorkerThreadConfig& config = WorkerThreadConfig());
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    // onDue: 期限到来時に呼ぶ処理 / onThreadStart: スレッド起動直後に 1 回（affinity 設定など）
+    explicit WorkerThread(Callback onDue, Callback onThreadStart = {});
     ~WorkerThread();
 
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+
     void start();
     void stop();
+    // 以後の期限登録を拒み、待機中のスレッドを起こして終了させる (join は stop() で行う)
+    void requestStop();
+
+    // 期限を登録する。既存の期限より遅いものは無視される（早い方が勝つ）
+    void scheduleAt(Clock::time_point deadline);
+    void scheduleAfter(std::chrono::milliseconds delay);
+    // 直ちに onDue を呼ぶよう起こす
+    void wake();
 
-#ifdef _DEBUG
-    uint64_t getCommandsReceived() const noexcept { return convo::consumeAtomic(commandsReceived, std::memory_order_acquire); }   // acquire: run() の fetchAdd acq_rel と HB し最新カウントを観測
-    uint64_t getSnapshotsCreated() const noexcept { return convo::consumeAtomic(snapshotsCreated, std::memory_order_acquire); }   // acquire: run() の fetchAdd acq_rel と HB
-    uint64_t getCommandsDropped() const noexcept { return convo::consumeAtomic(commandsDropped, std::memory_order_acquire); }    // acquire: run() の fetchAdd acq_rel と HB
-#endif
+    [[nodiscard]] bool hasDeadline() const;
+    // onDue を呼んだ回数（診断用）
+    [[nodiscard]] uint64_t getWakeCount() const noexcept { return convo::consumeAtomic(wakeCount, std::memory_order_relaxed); } // relaxed: 統計カウンタのみ
 
 private:
     void run();
 
-    CommandBuffer& commandBuffer;
-    GenerationManager& generationManager;
-    const ThreadAffinityManager* affinityManager = nullptr;
-    WorkerThreadConfig config;
-
+    static constexpr Clock::time_point kNoDeadline = Clock::time_point::max();
 
+    Callback onDue;
+    Callback onThreadStart;
 
-    std::atomic<bool> running{false};
-    std::atomic<bool> pendingFlush{false};
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    Clock::time_point deadline = kNoDeadline; // mutex 保護
+    bool running = false;                     // mutex 保護
     std::thread thread;
 
-#ifdef _DEBUG
-    std::atomic<uint64_t> commandsReceived{0};
-    std::atomic<uint64_t> snapshotsCreated{0};
-    std::atomic<uint64_t> commandsDropped{0};
-#endif
+    std::atomic<uint64_t> wakeCount { 0 };
 };
 
 } // namespace convo
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <immintrin.h>
+
+//==============================================================================
+// BiquadCascade — 3 段 TDF-II Biquad カスケードのステレオ SIMD エンジン (SoA 状態)
+//
+//   OutputFilter の 2 系統 (LC → HC0 → HC1 / HPF → LP0 → LP1) はどちらも 3 段の直列カスケード。
+//   L/R を __m128d の 2 レーンに載せ、状態はブロック中レジスタに置く。
+//
+//   各段の w1 再帰 (y = b0·x + w1 → w1 = b1·x − a1·y + w2) は FMA 3 段の依存で、
+//   旧実装はここに |w| < threshold → 0 の比較と andnot を毎サンプル足していた。
+//   FTZ/DAZ が Audio Thread で有効な前提 (numeric_policy::killDenormal と同じ) なので、
+//   フラッシュはブロック末尾の状態に対して 1 回だけ行う。段間は独立な再帰なので
+//   アウトオブオーダー実行がサンプル方向に重ねて進め、ループ伝搬の依存は 1 段分になる。
+//   演算は旧 biquadStep128_FMA と同じ FMA 順序で、ブロック途中で状態が閾値 (1e-20) を
+//   下回らない限り出力は旧実装とビット一致する (tests/BiquadCascadeTests.cpp)。
+//
+//   状態と係数は [stage][channel] の SoA 配列。係数は prepare 時に L/R 分を複製しておき
+//   (StereoBiquadCascade3Coeffs::setStage)、process ではアラインロードするだけにする。
+//
+//   前提: /arch:AVX2 ビルド (FMA3)。積和は組み込み関数で明示しているため /fp:fast の縮約の
+//   影響を受けない。Audio Thread から呼ぶ。JUCE 非依存。
+//==============================================================================
+
+namespace convo::dsp {
+
+inline constexpr int kBiquadCascadeStages = 3;
+
+// 正規化済み係数 (a0 = 1)。各段 L/R に同じ値を複製して持つ
+struct StereoBiquadCascade3Coeffs
+{
+    alignas(16) double b0[kBiquadCascadeStages][2] {};
+    alignas(16) double b1[kBiquadCascadeStages][2] {};
+    alignas(16) double b2[kBiquadCascadeStages][2] {};
+    alignas(16) double a1[kBiquadCascadeStages][2] {};
+    alignas(16) double a2[kBiquadCascadeStages][2] {};
+
+    void setStage(int stage, double nb0, double nb1, double nb2, double na1, double na2) noexcept
+    {
+        b0[stage][0] = b0[stage][1] = nb0;
+        b1[stage][0] = b1[stage][1] = nb1;
+        b2[stage][0] = b2[stage][1] = nb2;
+        a1[stage][0] = a1[stage][1] = na1;
+        a2[stage][0] = a2[stage][1] = na2;
+    }
+};
+
+// TDF-II 状態 [stage][channel] (channel 0 = L, 1 = R)。モノラルは channel 0 だけを使う
+struct StereoBiquadCascade3State
+{
+    alignas(16) double w1[kBiquadCascadeStages][2] {};
+    alignas(16) double w2[kBiquadCascadeStages][2] {};
+
+    void reset() noexcept { *this = StereoBiquadCascade3State {}; }
+};
+
+namespace biquad_cascade_detail {
+
+// 1 段分の TDF-II (lower = L, upper = R):
+//   y  = b0·x + w1
+//   w1 = b1·x − a1·y + w2  = fmadd(b1, x, fnmadd(a1, y, w2))
+//   w2 = b2·x − a2·y       = fnmadd(a2, y, b2·x)
+inline __m128d biquadStep(__m128d x, __m128d b0, __m128d b1, __m128d b2, __m128d a1, __m128d a2,
+                          __m128d& w1, __m128d& w2) noexcept
+{
+    const __m128d y = _mm_fmadd_pd(b0, x, w1);
+    w1 = _mm_fmadd_pd(b1, x, _mm_fnmadd_pd(a1, y, w2));
+    w2 = _mm_fnmadd_pd(a2, y, _mm_mul_pd(b2, x));
+    return y;
+}
+
+// |w| < denormThreshold を 0 に (旧 biquadStep128_FMA のフラッシュと同じ比較)
+inline __m128d flushBelow(__m128d w, __m128d denormThreshold) noexcept
+{
+    return _mm_andnot_pd(_mm_cmplt_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), w), denormThreshold), w);
+}
+
+// 1 段分の係数と状態を __m128d で持つ
+struct Stage128
+{
+    __m128d b0, b1, b2, a1, a2, w1, w2;
+
+    Stage128(const StereoBiquadCascade3Coeffs& c, const StereoBiquadCascade3State& s, int stage) noexcept
+        : b0(_mm_load_pd(c.b0[stage])), b1(_mm_load_pd(c.b1[stage])), b2(_mm_load_pd(c.b2[stage])),
+          a1(_mm_load_pd(c.a1[stage])), a2(_mm_load_pd(c.a2[stage])),
+          w1(_mm_load_pd(s.w1[stage])), w2(_mm_load_pd(s.w2[stage]))
+    {
+    }
+
+    __m128d step(__m128d x) noexcept
+    {
+        return biquadStep(x, b0, b1, b2, a1, a2, w1, w2);
+    }
+
+    // ブロック末尾: フラッシュして書き戻す
+    void store(StereoBiquadCascade3State& s, int stage, __m128d denormThreshold) const noexcept
+    {
+        _mm_store_pd(s.w1[stage], flushBelow(w1, denormThreshold));
+        _mm_store_pd(s.w2[stage], flushBelow(w2, denormThreshold));
+    }
+};
+
+inline __m128d loadPair(const double* left, const double* right, int index) noexcept
+{
+    return _mm_set_pd(right[index], left[index]);
+}
+
+inline void storePair(double* left, double* right, int index, __m128d value) noexcept
+{
+    _mm_storel_pd(left + index, value);
+    _mm_storeh_pd(right + index, value);
+}
+
+} // namespace biquad_cascade_detail
+
+//------------------------------------------------------------------------------
+// サンプルごとに stage0 → 1 → 2。状態はブロック末尾でフラッシュして書き戻す
+//------------------------------------------------------------------------------
+inline void processStereoCascade3(double* dataL, double* dataR, int numSamples,
+                                  const StereoBiquadCascade3Coeffs& coeffs,
+                                  StereoBiquadCascade3State& state, double denormThreshold) noexcept
+{
+    using namespace biquad_cascade_detail;
+    Stage128 s0(coeffs, state, 0), s1(coeffs, state, 1), s2(coeffs, state, 2);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        __m128d x = loadPair(dataL, dataR, i);
+        x = s0.step(x);
+        x = s1.step(x);
+        x = s2.step(x);
+        storePair(dataL, dataR, i, x);
+    }
+
+    const __m128d vDenorm = _mm_set1_pd(denormThreshold);
+    s0.store(state, 0, vDenorm);
+    s1.store(state, 1, vDenorm);
+    s2.store(state, 2, vDenorm);
+}
+
+} // namespace convo::dsp
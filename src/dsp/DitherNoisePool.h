@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <mkl_vsl.h>
+
+#include "AlignedAllocation.h"
+#include "audioengine/AtomicAccess.h"
+
+//==============================================================================
+// DitherNoisePool — 全ノイズシェーパー共用の TPDF ディザ供給プール
+//
+//   各シェーパーは従来 1 サンプルごとに乱数を引いていた
+//   (PsychoacousticDither: SPSC リングから一様乱数を 2 回 pop = atomic 4 回、
+//    Lattice / Fixed4Tap / Fixed15Tap: xoshiro256++ を 2 回)。
+//   ここではチャンネルごとの SPSC リングに「単位 TPDF 値 (u1 - 0.5) + (u2 - 0.5) ∈ (-1, 1)」を
+//   MKL VSL (SFMT19937) で一括生成して溜めておき、Audio Thread は最大 kReadChunk サンプル分を
+//   atomic 1 組でまとめて取り出す。呼び出し側は LSB (scale) を掛けるだけでよい。
+//
+//   スレッドモデル (チャンネルごとに SPSC):
+//     - prepare() / refillNonRt(): Message Thread (prepare は DSPCore 公開前、refill は AudioEngine の timerCallback)
+//     - read(): Audio Thread のみ。同時に読むシェーパーは DSPCore あたり 1 つ (noiseShaperType で排他)
+//   Audio Thread はリングを先頭から順に読むだけで、1 回に触れるのは kReadChunk * 8 バイトの連続領域。
+//   補充が追いつかない場合 (Message Thread の停滞など) は不足分だけ xorshift のフォールバックで埋め、
+//   underrun 回数を数える (無音・既知パターンにはしない)。
+//
+//   容量 kPoolSize は 768 kHz でタイマー周期 (100 ms) の約 1.7 倍。JUCE 非依存。
+//==============================================================================
+
+namespace convo::dsp {
+
+class DitherNoisePool
+{
+public:
+    static constexpr int kNumChannels = 2;
+    static constexpr uint32_t kPoolSize = 1u << 17;      // チャンネルあたり 1 MiB
+    static constexpr uint32_t kPoolMask = kPoolSize - 1u;
+    static constexpr int kReadChunk = 256;                // Audio Thread 側の取り出し単位 (スタック配列長)
+    static constexpr uint32_t kGenerateChunk = 4096u;     // VSL 1 回あたりの生成数 (TPDF 値)
+    static_assert((kPoolSize & kPoolMask) == 0u, "kPoolSize must be power of two");
+
+    DitherNoisePool()
+    {
+        for (auto& ring : rings)
+            ring = convo::makeAlignedArray<double>(kPoolSize);
+        scratch = convo::makeAlignedArray<double>(static_cast<size_t>(kGenerateChunk) * 2u);
+    }
+
+    ~DitherNoisePool()
+    {
+        releaseStreams();
+    }
+
+    DitherNoisePool(const DitherNoisePool&) = delete;
+    DitherNoisePool& operator=(const DitherNoisePool&) = delete;
+
+    // NON_RT: ストリームを作り直してリングを満杯まで埋める。Audio Thread が読んでいない時にだけ呼ぶ
+    void prepare(std::optional<uint64_t> seed = std::nullopt) noexcept
+    {
+        uint64_t state = seed.has_value()
+            ? seed.value()
+            : static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count())
+                ^ reinterpret_cast<uintptr_t>(this);
+
+        releaseStreams();
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            const uint64_t channelSeed = splitMix64(state);
+            if (vslNewStream(&streams[ch], VSL_BRNG_SFMT19937, static_cast<unsigned int>(channelSeed)) != VSL_STATUS_OK)
+                streams[ch] = nullptr;
+            fallbackState[ch] = (channelSeed ^ 0xd1b54a32d192ed03ULL) | 1ULL;
+            producerFallbackState[ch] = (channelSeed ^ 0x94d049bb133111ebULL) | 1ULL;
+
+            convo::publishAtomic(readPos[ch], 0u, std::memory_order_release);
+            convo::publishAtomic(writePos[ch], 0u, std::memory_order_release);
+        }
+        convo::publishAtomic(underruns, 0u, std::memory_order_release);
+
+        refillNonRt();
+    }
+
+    // WORKER_ONLY: 空き領域をすべて補充する (Message Thread の timerCallback から呼ぶ)
+    void refillNonRt() noexcept
+    {
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            const uint32_t consumed = convo::consumeAtomic(readPos[ch], std::memory_order_acquire);
+            uint32_t produced = convo::consumeAtomic(writePos[ch], std::memory_order_acquire);
+            uint32_t freeSpace = kPoolSize - (produced - consumed);
+
+            while (freeSpace > 0u)
+            {
+                const uint32_t start = produced & kPoolMask;
+                const uint32_t count = std::min({ freeSpace, kGenerateChunk, kPoolSize - start });
+                generate(ch, rings[ch].get() + start, count);
+                produced += count;
+                freeSpace -= count;
+                convo::publishAtomic(writePos[ch], produced, std::memory_order_release);
+            }
+        }
+    }
+
+    // AUDIO_THREAD: 単位 TPDF 値を count 個 dest へ取り出す。不足分はフォールバックで埋める。
+    // 戻り値はプールから取れた個数
+    inline int read(int channel, double* dest, int count) noexcept
+    {
+        if (channel < 0 || channel >= kNumChannels || dest == nullptr || count <= 0)
+            return 0;
+
+        // consumer 側 readPos は Audio Thread のみが更新する。writePos の acquire で中身の可視性を得る
+        const uint32_t consumed = convo::consumeAtomic(readPos[channel], std::memory_order_relaxed);
+        const uint32_t produced = convo::consumeAtomic(writePos[channel], std::memory_order_acquire);
+        const uint32_t available = produced - consumed;
+        const int fromPool = static_cast<int>(std::min<uint32_t>(available, static_cast<uint32_t>(count)));
+
+        if (fromPool > 0)
+        {
+            const double* ring = rings[channel].get();
+            const uint32_t start = consumed & kPoolMask;
+            const int firstCount = static_cast<int>(std::min<uint32_t>(static_cast<uint32_t>(fromPool), kPoolSize - start));
+            std::copy_n(ring + start, firstCount, dest);
+            std::copy_n(ring, fromPool - firstCount, dest + firstCount);
+            convo::publishAtomic(readPos[channel], consumed + static_cast<uint32_t>(fromPool), std::memory_order_release);
+        }
+
+        if (fromPool < count)
+        {
+            for (int i = fromPool; i < count; ++i)
+                dest[i] = fallbackTpdf(fallbackState[channel]);
+            convo::fetchAddAtomic(underruns, 1u, std::memory_order_relaxed);
+        }
+        return fromPool;
+    }
+
+    uint32_t getAvailable(int channel) const noexcept
+    {
+        if (channel < 0 || channel >= kNumChannels)
+            return 0u;
+        return convo::consumeAtomic(writePos[channel], std::memory_order_acquire)
+             - convo::consumeAtomic(readPos[channel], std::memory_order_acquire);
+    }
+
+    uint32_t getUnderrunCount() const noexcept
+    {
+        return convo::consumeAtomic(underruns, std::memory_order_relaxed);
+    }
+
+private:
+    static uint64_t splitMix64(uint64_t& state) noexcept
+    {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    void releaseStreams() noexcept
+    {
+        for (auto& stream : streams)
+            if (stream != nullptr)
+            {
+                vslDeleteStream(&stream);
+                stream = nullptr;
+            }
+    }
+
+    // 一様乱数を 2 個ずつ組にして単位 TPDF へ畳む。VSL が使えなければフォールバックで埋める
+    void generate(int channel, double* dest, uint32_t count) noexcept
+    {
+        double* uniforms = scratch.get();
+        const bool ok = streams[channel] != nullptr
+            && vdRngUniform(VSL_RNG_METHOD_UNIFORM_STD, streams[channel],
+                            static_cast<MKL_INT>(count * 2u), uniforms, 0.0, 1.0) == VSL_STATUS_OK;
+        if (!ok)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                dest[i] = fallbackTpdf(producerFallbackState[channel]);
+            return;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+            dest[i] = (uniforms[2u * i] - 0.5) + (uniforms[2u * i + 1u] - 0.5);
+    }
+
+    static inline double fallbackUniform(uint64_t& state) noexcept
+    {
+        uint64_t x = state;
+        x ^= x >> 12;
+        x ^= x << 25;
+        x ^= x >> 27;
+        state = x;
+        return static_cast<double>((x * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    static inline double fallbackTpdf(uint64_t& state) noexcept
+    {
+        const double u1 = fallbackUniform(state);
+        const double u2 = fallbackUniform(state);
+        return (u1 - 0.5) + (u2 - 0.5);
+    }
+
+    convo::ScopedAlignedArray<double> rings[kNumChannels];
+    convo::ScopedAlignedArray<double> scratch;   // Message Thread 専用
+    VSLStreamStatePtr streams[kNumChannels] {};
+    uint64_t fallbackState[kNumChannels] { 0x9e3779b97f4a7c15ULL, 0xd1b54a32d192ed03ULL };         // Audio Thread 専用
+    uint64_t producerFallbackState[kNumChannels] { 0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL }; // Message Thread 専用
+
+    alignas(64) std::atomic<uint32_t> readPos[kNumChannels] {};
+    alignas(64) std::atomic<uint32_t> writePos[kNumChannels] {};
+    alignas(64) std::atomic<uint32_t> underruns { 0u };
+};
+
+// シェーパー共通: 単位 TPDF を count 個 dest へ用意する。
+// pool があればそこから取り出し、無ければ (学習器のオフライン評価・単体テスト) ownTpdf() を count 回呼ぶ。
+// 自前の乱数はチャンネルごとに従来と同じ順序で消費されるため、pool なしの出力は従来と変わらない
+template <typename OwnSource>
+inline void fillUnitTpdf(DitherNoisePool* pool, int channel, double* dest, int count, OwnSource&& ownTpdf) noexcept
+{
+    if (pool != nullptr)
+    {
+        pool->read(channel, dest, count);
+        return;
+    }
+    for (int i = 0; i < count; ++i)
+        dest[i] = ownTpdf();
+}
+
+} // namespace convo::dsp
@@ -0,0 +1,173 @@
+//==============================================================================
+// HalfBandCascade.cpp
+// HalfBandFir 多段のストリーミング間引き / 補間
+//==============================================================================
+
+#include "dsp/HalfBandCascade.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace convo::dsp {
+
+int HalfBandCascade::estimateTaps(double highRate, double passbandHz, double attenuationDb) noexcept
+{
+    // 遷移帯: passbandHz 〜 highRate/2 − passbandHz (高レート側で正規化)
+    const double transition = 0.5 - 2.0 * passbandHz / highRate;
+    if (!(transition > 0.0))
+        return 0;
+    const double order = (attenuationDb - 7.95) / (14.36 * transition);
+    const int taps = static_cast<int>(std::ceil(order)) + 1;
+    return std::max(kMinTaps, taps | 1);
+}
+
+bool HalfBandCascade::prepare(Mode newMode, int ratio, double sampleRate, double passbandHz, double attenuationDb,
+                              int maxInputSamples) noexcept
+{
+    release();
+
+    const int stageCount = halfBandStagesForRatio(ratio);
+    if (stageCount < 1 || stageCount > kMaxStages || (1 << stageCount) != ratio
+        || !(sampleRate > 0.0) || !(passbandHz > 0.0) || maxInputSamples <= 0)
+        return false;
+
+    int latency = 0;
+    for (int r = 0; r < stageCount; ++r)
+    {
+        const int taps = estimateTaps(sampleRate / static_cast<double>(1 << r), passbandHz, attenuationDb);
+        if (taps <= 0 || taps > kMaxTaps || !stages[r].design(taps, attenuationDb))
+        {
+            release();
+            return false;
+        }
+        latency += stages[r].centerTap << r;
+    }
+
+    int maxScratch = 0;
+    for (int r = 0; r < stageCount; ++r)
+    {
+        if (newMode == Mode::Decimate)
+        {
+            // 段 r の入力 = 前段出力 (最大) + 持ち越し 1
+            capacity[r] = ((r == 0) ? maxInputSamples : capacity[r - 1] / 2) + 1;
+            keep[r] = stages[r].decimateHistoryKeep();
+            maxScratch = std::max(maxScratch, stages[r].decimateScratchSize(capacity[r] / 2));
+        }
+        else
+        {
+            // 段 r の入力は低レート入力の 2^(stageCount-1-r) 倍
+            capacity[r] = maxInputSamples << (stageCount - 1 - r);
+            keep[r] = stages[r].interpolateHistoryKeep();
+        }
+
+        history[r] = makeAlignedArray_nothrow<double>(static_cast<size_t>(keep[r] + capacity[r]));
+        if (!history[r])
+        {
+            release();
+            return false;
+        }
+    }
+
+    if (maxScratch > 0)
+    {
+        phaseScratch = makeAlignedArray_nothrow<double>(static_cast<size_t>(maxScratch));
+        if (!phaseScratch)
+        {
+            release();
+            return false;
+        }
+    }
+
+    mode = newMode;
+    numStages = stageCount;
+    maxInput = maxInputSamples;
+    latencySamples = latency;
+    reset();
+    return true;
+}
+
+void HalfBandCascade::release() noexcept
+{
+    for (int r = 0; r < kMaxStages; ++r)
+    {
+        stages[r].release();
+        history[r].reset();
+        keep[r] = 0;
+        pending[r] = 0;
+        capacity[r] = 0;
+    }
+    phaseScratch.reset();
+    numStages = 0;
+    maxInput = 0;
+    latencySamples = 0;
+}
+
+void HalfBandCascade::reset() noexcept
+{
+    for (int r = 0; r < numStages; ++r)
+    {
+        std::fill_n(history[r].get(), keep[r] + capacity[r], 0.0);
+        pending[r] = 0;
+    }
+}
+
+int HalfBandCascade::decimate(const double* input, int numSamples, double* out) noexcept
+{
+    if (mode != Mode::Decimate || numStages == 0 || numSamples <= 0)
+        return 0;
+    numSamples = std::min(numSamples, maxInput);
+
+    double* first = history[0].get() + keep[0] + pending[0];
+    if (input != nullptr)
+        std::memcpy(first, input, static_cast<size_t>(numSamples) * sizeof(double));
+    else
+        std::memset(first, 0, static_cast<size_t>(numSamples) * sizeof(double));
+
+    int available = pending[0] + numSamples;
+    for (int r = 0; r < numStages; ++r)
+    {
+        const int numOut = available / 2;
+        const bool last = (r + 1 == numStages);
+        double* dst = last ? out : history[r + 1].get() + keep[r + 1] + pending[r + 1];
+        double* hist = history[r].get();
+        stages[r].decimate(hist, keep[r], numOut, phaseScratch.get(), dst);
+
+        // 消費した 2·numOut を捨て、過去 keep と持ち越し (奇数時 1) を先頭へ
+        const int consumed = numOut * 2;
+        pending[r] = available - consumed;
+        std::memmove(hist, hist + consumed, static_cast<size_t>(keep[r] + pending[r]) * sizeof(double));
+
+        if (last)
+            return numOut;
+        available = pending[r + 1] + numOut;
+    }
+    return 0;
+}
+
+int HalfBandCascade::interpolate(const double* input, int numIn, double* out) noexcept
+{
+    if (mode != Mode::Interpolate || numStages == 0 || numIn <= 0)
+        return 0;
+    numIn = std::min(numIn, maxInput);
+
+    const int top = numStages - 1;
+    double* first = history[top].get() + keep[top];
+    if (input != nullptr)
+        std::memcpy(first, input, static_cast<size_t>(numIn) * sizeof(double));
+    else
+        std::memset(first, 0, static_cast<size_t>(numIn) * sizeof(double));
+
+    int count = numIn;
+    for (int r = top; r >= 0; --r)
+    {
+        double* hist = history[r].get();
+        double* dst = (r == 0) ? out : history[r - 1].get() + keep[r - 1];
+        stages[r].interpolate(hist, keep[r], count, dst);
+        std::memmove(hist, hist + count, static_cast<size_t>(keep[r]) * sizeof(double));
+        count *= 2;
+    }
+    return count;
+}
+
+} // namespace convo::dsp
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "dsp/HalfBandFir.h"
+
+//==============================================================================
+// HalfBandCascade — HalfBandFir を 1〜3 段つないだ 2^k 倍のストリーミング間引き / 補間
+//
+//   MKLNonUniformConvolver の Multirate tail (L2 を 1/2〜1/8 のレートで畳み込む) が、
+//   レイヤー入力の間引きと出力の補間に 1 つずつ使う。MultiResolutionSpectrum (アナライザー) は
+//   2 倍の間引きを帯域の数だけ直列につなぐ。
+//
+//   段ごとのタップ数は「passbandHz までを残し、折り返し先が passbandHz 以下に落ちる成分を
+//   attenuationDb 除去する」条件から Kaiser の見積もりで決める。高いレートの段ほど遷移帯が広いので
+//   短くて済み (192 kHz → 48 kHz, 20 kHz 保持で 21 / 71 タップ程度)、コストは最終段が支配する。
+//
+//   遅延: 全段が線形位相のため、間引き出力 m はフルレート時刻 ratio·m − getLatencySamples()、
+//   補間出力 i は低レート時刻 (i − getLatencySamples()) / ratio の帯域制限値になる。
+//   間引き側の端数 (ratio の倍数に満たない入力) は各段 1 サンプルまで持ち越すため、
+//   コールバック長が ratio の倍数でなくても出力の時刻は入力ストリーム先頭基準で一定。
+//
+//   Audio Thread で呼ぶのは decimate() / interpolate() / reset() のみ (確保なし)。
+//==============================================================================
+
+namespace convo::dsp {
+
+class HalfBandCascade
+{
+public:
+    enum class Mode { Decimate, Interpolate };
+
+    static constexpr int kMaxStages = 3;
+    static constexpr int kMinTaps = 7;
+    static constexpr int kMaxTaps = 127;
+
+    HalfBandCascade() = default;
+    HalfBandCascade(const HalfBandCascade&) = delete;
+    HalfBandCascade& operator=(const HalfBandCascade&) = delete;
+
+    // Message Thread 専用。ratio は 2 / 4 / 8。maxInputSamples は 1 回の呼び出しの入力上限
+    // (Decimate はフルレート、Interpolate は低レートのサンプル数)。
+    // 最終段の必要タップ数が kMaxTaps を超える (passbandHz が低レート側 Nyquist に近すぎる) 場合や
+    // 確保失敗時は false
+    bool prepare(Mode mode, int ratio, double sampleRate, double passbandHz, double attenuationDb,
+                 int maxInputSamples) noexcept;
+    void release() noexcept;
+    void reset() noexcept;
+
+    [[nodiscard]] bool isReady() const noexcept { return numStages > 0; }
+    [[nodiscard]] int getRatio() const noexcept { return 1 << numStages; }
+    [[nodiscard]] int getLatencySamples() const noexcept { return latencySamples; }
+    [[nodiscard]] int getStageTaps(int stage) const noexcept
+    {
+        return (stage >= 0 && stage < numStages) ? stages[stage].taps : 0;
+    }
+
+    // 必要タップ数 (Kaiser 見積もり、奇数)。highRate は段の高レート側
+    [[nodiscard]] static int estimateTaps(double highRate, double passbandHz, double attenuationDb) noexcept;
+
+    // input == nullptr は無音。戻り値は out へ書いた低レートサンプル数 (<= (持ち越し + numSamples) / ratio)。
+    // numSamples が maxInputSamples を超えた分は捨てる (呼び出し規約違反)
+    int decimate(const double* input, int numSamples, double* out) noexcept;
+
+    // numIn 個の低レート入力から numIn·ratio 個を out へ書く。numIn は maxInputSamples 以下
+    int interpolate(const double* input, int numIn, double* out) noexcept;
+
+private:
+    // 段 r の高レート側はフルレートの 1/2^r。Decimate は r = 0 から、Interpolate は r = numStages-1 から適用する
+    HalfBandFir stages[kMaxStages];
+    ScopedAlignedPtr<double> history[kMaxStages];  // [keep][新入力] (Decimate は段入力、Interpolate は段入力 = 低レート側)
+    int keep[kMaxStages] {};
+    int pending[kMaxStages] {};                    // Decimate: 次回へ持ち越した段入力 (0 / 1)
+    int capacity[kMaxStages] {};                   // history の新入力部の容量
+    ScopedAlignedPtr<double> phaseScratch;
+    Mode mode = Mode::Decimate;
+    int numStages = 0;
+    int maxInput = 0;
+    int latencySamples = 0;
+};
+
+} // namespace convo::dsp
@@ -0,0 +1,337 @@
+//==============================================================================
+// HalfBandFir.cpp
+// Kaiser 窓 FIR ハーフバンド共通エンジン (設計 + タップ数特殊化カーネル)
+//==============================================================================
+
+#include "dsp/HalfBandFir.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+#include <numbers>
+
+#include "dsp/IsaTarget.h"
+
+namespace convo::dsp {
+
+namespace {
+
+double besselI0(double x) noexcept
+{
+    double sum = 1.0;
+    double term = 1.0;
+    const double xx = x * x;
+    for (int n = 1; n < 100; ++n)
+    {
+        term *= xx / (4.0 * static_cast<double>(n) * static_cast<double>(n));
+        sum += term;
+        if (term < sum * 1.0e-18)
+            break;
+    }
+    return sum;
+}
+
+//==============================================================================
+// タップ数固定の縦方向 FIR。ConvCount が constexpr のため内側ループは完全展開される。
+// 計算順序は KernelDispatch の汎用版と同じ (2 係数ずつ 2 アキュムレータ)。
+//==============================================================================
+template <int ConvCount>
+void firVerticalFixedAvx2(const double* __restrict x, const double* __restrict coeffsReversed, int /*convCount*/,
+                          double* __restrict out, int numOut) noexcept
+{
+    static_assert(ConvCount >= 2 && (ConvCount % 2) == 0);
+    int k = 0;
+    for (; k <= numOut - 8; k += 8)
+    {
+        const double* xk = x + k;
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        __m256d acc2 = _mm256_setzero_pd();
+        __m256d acc3 = _mm256_setzero_pd();
+        for (int r = 0; r < ConvCount; r += 2)
+        {
+            const __m256d c0 = _mm256_broadcast_sd(coeffsReversed + r);
+            const __m256d c1 = _mm256_broadcast_sd(coeffsReversed + r + 1);
+            acc0 = _mm256_fmadd_pd(c0, _mm256_loadu_pd(xk + r),         acc0);
+            acc1 = _mm256_fmadd_pd(c0, _mm256_loadu_pd(xk + r + 4),     acc1);
+            acc2 = _mm256_fmadd_pd(c1, _mm256_loadu_pd(xk + r + 1),     acc2);
+            acc3 = _mm256_fmadd_pd(c1, _mm256_loadu_pd(xk + r + 1 + 4), acc3);
+        }
+        _mm256_storeu_pd(out + k,     _mm256_add_pd(acc0, acc2));
+        _mm256_storeu_pd(out + k + 4, _mm256_add_pd(acc1, acc3));
+    }
+
+    for (; k <= numOut - 4; k += 4)
+    {
+        const double* xk = x + k;
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        for (int r = 0; r < ConvCount; r += 2)
+        {
+            acc0 = _mm256_fmadd_pd(_mm256_broadcast_sd(coeffsReversed + r),     _mm256_loadu_pd(xk + r),     acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_broadcast_sd(coeffsReversed + r + 1), _mm256_loadu_pd(xk + r + 1), acc1);
+        }
+        _mm256_storeu_pd(out + k, _mm256_add_pd(acc0, acc1));
+    }
+
+    for (; k < numOut; ++k)
+    {
+        double sum = 0.0;
+        for (int r = 0; r < ConvCount; ++r)
+            sum += coeffsReversed[r] * x[k + r];
+        out[k] = sum;
+    }
+}
+
+template <int ConvCount>
+CONVO_TARGET_AVX512 void firVerticalFixedAvx512(const double* __restrict x, const double* __restrict coeffsReversed,
+                                                int /*convCount*/, double* __restrict out, int numOut) noexcept
+{
+    static_assert(ConvCount >= 2 && (ConvCount % 2) == 0);
+    int k = 0;
+    for (; k <= numOut - 16; k += 16)
+    {
+        const double* xk = x + k;
+        __m512d acc0 = _mm512_setzero_pd();
+        __m512d acc1 = _mm512_setzero_pd();
+        __m512d acc2 = _mm512_setzero_pd();
+        __m512d acc3 = _mm512_setzero_pd();
+        for (int r = 0; r < ConvCount; r += 2)
+        {
+            const __m512d c0 = _mm512_set1_pd(coeffsReversed[r]);
+            const __m512d c1 = _mm512_set1_pd(coeffsReversed[r + 1]);
+            acc0 = _mm512_fmadd_pd(c0, _mm512_loadu_pd(xk + r),         acc0);
+            acc1 = _mm512_fmadd_pd(c0, _mm512_loadu_pd(xk + r + 8),     acc1);
+            acc2 = _mm512_fmadd_pd(c1, _mm512_loadu_pd(xk + r + 1),     acc2);
+            acc3 = _mm512_fmadd_pd(c1, _mm512_loadu_pd(xk + r + 1 + 8), acc3);
+        }
+        _mm512_storeu_pd(out + k,     _mm512_add_pd(acc0, acc2));
+        _mm512_storeu_pd(out + k + 8, _mm512_add_pd(acc1, acc3));
+    }
+
+    for (; k < numOut; k += 8)
+    {
+        const int remaining = numOut - k;
+        const __mmask8 m = (remaining >= 8) ? static_cast<__mmask8>(0xFF)
+                                            : static_cast<__mmask8>((1u << remaining) - 1u);
+        const double* xk = x + k;
+        __m512d acc0 = _mm512_setzero_pd();
+        __m512d acc1 = _mm512_setzero_pd();
+        for (int r = 0; r < ConvCount; r += 2)
+        {
+            acc0 = _mm512_fmadd_pd(_mm512_set1_pd(coeffsReversed[r]),     _mm512_maskz_loadu_pd(m, xk + r),     acc0);
+            acc1 = _mm512_fmadd_pd(_mm512_set1_pd(coeffsReversed[r + 1]), _mm512_maskz_loadu_pd(m, xk + r + 1), acc1);
+        }
+        _mm512_mask_storeu_pd(out + k, m, _mm512_add_pd(acc0, acc1));
+    }
+}
+
+FirVerticalKernel resolveConvKernel(KernelIsa isa, int convCount) noexcept
+{
+    const KernelTable& generic = kernelsFor(isa);
+    switch (generic.isa)
+    {
+        case KernelIsa::Avx512:
+            switch (convCount)
+            {
+                case 16: return &firVerticalFixedAvx512<16>;
+                case 32: return &firVerticalFixedAvx512<32>;
+                case 64: return &firVerticalFixedAvx512<64>;
+                default: break;
+            }
+            break;
+        case KernelIsa::Avx2:
+            switch (convCount)
+            {
+                case 16: return &firVerticalFixedAvx2<16>;
+                case 32: return &firVerticalFixedAvx2<32>;
+                case 64: return &firVerticalFixedAvx2<64>;
+                default: break;
+            }
+            break;
+        case KernelIsa::Scalar:
+        default:
+            break;
+    }
+    return generic.firVertical;
+}
+
+// 補間 / 間引きの本体 (double / float 共通)
+template <typename T, typename Kernel>
+void interpolateImpl(const HalfBandFir& fir, Kernel kernel, const T* coeffsReversed, T centerCoeff,
+                     const T* history, int keep, int numIn, T* out) noexcept
+{
+    if (numIn <= 0)
+        return;
+
+    // conv 位相を out の後半へ書き、前から 2 出力ずつ展開する。
+    // 出力 n は out[2n], out[2n+1] を書き、読むのは out[numIn + n] (>= 2n+1) なので上書き前に読める。
+    T* conv = out + numIn;
+    kernel(history + keep - (fir.convCount - 1), coeffsReversed, fir.convCount, conv, numIn);
+
+    const T* center = history + keep - fir.centerDelayInput;
+    const T centerGain = static_cast<T>(2) * centerCoeff;
+    for (int n = 0; n < numIn; ++n)
+    {
+        const T convValue = conv[n];
+        const int outBase = n << 1;
+        out[outBase + fir.convParity] = static_cast<T>(2) * convValue;
+        out[outBase + fir.centerParity] = centerGain * center[n];
+    }
+}
+
+template <typename T, typename Kernel>
+void decimateImpl(const HalfBandFir& fir, Kernel kernel, const T* coeffsReversed, T centerCoeff,
+                  const T* history, int keep, int numOut, T* phaseScratch, T* out) noexcept
+{
+    if (numOut <= 0)
+        return;
+
+    // conv タップは history[keep − convParity + 2(n − r)] のみを参照する。
+    // 該当位相を phaseScratch へ deinterleave すれば補間と同じ連続 FIR になる。
+    const int firstIdx = keep - fir.convParity - ((fir.convCount - 1) << 1);
+    const int phaseCount = fir.convCount - 1 + numOut;
+    for (int i = 0; i < phaseCount; ++i)
+        phaseScratch[i] = history[firstIdx + (i << 1)];
+
+    kernel(phaseScratch, coeffsReversed, fir.convCount, out, numOut);
+
+    const T* center = history + keep - fir.centerTap;
+    for (int n = 0; n < numOut; ++n)
+        out[n] += centerCoeff * center[n << 1];
+}
+
+} // namespace
+
+bool HalfBandFir::design(int newTaps, double attenuationDb, KernelIsa isa) noexcept
+{
+    release();
+
+    taps = std::max(3, newTaps | 1);
+    centerTap = (taps - 1) / 2;
+    centerParity = centerTap & 1;
+    convParity = 1 - centerParity;
+
+    auto rawCoeffs = makeAlignedArray_nothrow<double>(static_cast<size_t>(taps));
+    if (!rawCoeffs)
+    {
+        release();
+        return false;
+    }
+
+    const double beta = (attenuationDb > 50.0)
+                      ? (0.1102 * (attenuationDb - 8.7))
+                      : ((attenuationDb >= 21.0) ? (0.5842 * std::pow(attenuationDb - 21.0, 0.4) + 0.07886 * (attenuationDb - 21.0))
+                                                  : 0.0);
+    const double i0Beta = besselI0(beta);
+    const int M = centerTap;
+
+    for (int n = 0; n < taps; ++n)
+    {
+        const double t = static_cast<double>(n - M);
+        const double sinc = (n == M)
+                          ? 0.5
+                          : (std::sin(std::numbers::pi * 0.5 * t) / (std::numbers::pi * t));
+        const double frac = static_cast<double>(n - M) / static_cast<double>(M);
+        const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - frac * frac))) / i0Beta;
+        rawCoeffs[n] = sinc * window;
+    }
+
+    // 中心以外の同位相タップは理論上 0 (窓の数値誤差を除去)
+    for (int n = 0; n < taps; ++n)
+    {
+        if (n != centerTap && ((n & 1) == centerParity))
+            rawCoeffs[n] = 0.0;
+    }
+
+    // 中心 0.5 / conv 位相の和 0.5 に正規化 (各位相の DC ゲインを厳密に 0.5 にそろえる)
+    rawCoeffs[centerTap] = 0.5;
+    double nonCenterSum = 0.0;
+    for (int i = 0; i < taps; ++i)
+        if (i != centerTap) nonCenterSum += rawCoeffs[i];
+    if (std::abs(nonCenterSum) > 1.0e-20)
+    {
+        const double scale = 0.5 / nonCenterSum;
+        for (int i = 0; i < taps; ++i)
+        {
+            if (i != centerTap)
+                rawCoeffs[i] *= scale;
+        }
+    }
+
+    convCount = (taps - convParity + 1) / 2;
+    convCoeffsReversed = makeAlignedArray_nothrow<double>(static_cast<size_t>(convCount));
+    if (!convCoeffsReversed)
+    {
+        release();
+        return false;
+    }
+
+    for (int r = 0; r < convCount; ++r)
+    {
+        const int k = convParity + (r << 1);
+        convCoeffsReversed[convCount - 1 - r] = (k < taps) ? rawCoeffs[k] : 0.0;
+    }
+
+    centerCoeff = rawCoeffs[centerTap];
+    centerDelayInput = (centerTap - centerParity) / 2;
+    convKernel = resolveConvKernel(isa, convCount);
+    return true;
+}
+
+void HalfBandFir::release() noexcept
+{
+    convCoeffsReversed.reset();
+    convKernel = nullptr;
+    convCoeffsReversedF32.reset();
+    convKernelF32 = nullptr;
+    centerCoeffF32 = 0.5f;
+    taps = 0;
+    centerTap = 0;
+    centerParity = 0;
+    convParity = 0;
+    convCount = 0;
+    centerDelayInput = 0;
+    centerCoeff = 0.5;
+}
+
+bool HalfBandFir::enableSinglePrecision(KernelIsa isa) noexcept
+{
+    convCoeffsReversedF32.reset();
+    convKernelF32 = nullptr;
+    if (!isReady())
+        return false;
+
+    convCoeffsReversedF32 = makeAlignedArray_nothrow<float>(static_cast<size_t>(convCount));
+    if (!convCoeffsReversedF32)
+        return false;
+
+    for (int r = 0; r < convCount; ++r)
+        convCoeffsReversedF32[r] = static_cast<float>(convCoeffsReversed[r]);
+    centerCoeffF32 = static_cast<float>(centerCoeff);
+    convKernelF32 = kernelsFor(isa).firVerticalF32;
+    return true;
+}
+
+void HalfBandFir::interpolate(const double* history, int keep, int numIn, double* out) const noexcept
+{
+    interpolateImpl(*this, convKernel, convCoeffsReversed.get(), centerCoeff, history, keep, numIn, out);
+}
+
+void HalfBandFir::decimate(const double* history, int keep, int numOut, double* phaseScratch, double* out) const noexcept
+{
+    decimateImpl(*this, convKernel, convCoeffsReversed.get(), centerCoeff, history, keep, numOut, phaseScratch, out);
+}
+
+void HalfBandFir::interpolate(const float* history, int keep, int numIn, float* out) const noexcept
+{
+    interpolateImpl(*this, convKernelF32, convCoeffsReversedF32.get(), centerCoeffF32, history, keep, numIn, out);
+}
+
+void HalfBandFir::decimate(const float* history, int keep, int numOut, float* phaseScratch, float* out) const noexcept
+{
+    decimateImpl(*this, convKernelF32, convCoeffsReversedF32.get(), centerCoeffF32, history, keep, numOut, phaseScratch, out);
+}
+
+} // namespace convo::dsp
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "AlignedAllocation.h"
+#include "dsp/KernelDispatch.h"
+
+//==============================================================================
+// HalfBandFir — Kaiser 窓 FIR ハーフバンド (2 倍補間 / 2 倍間引き) 共通エンジン
+//
+//   CustomInputOversampler (FIR プリセット) と TruePeakDetector が共有する。
+//   係数設計・ポリフェーズ分解・縦方向 FIR 実行をここに一本化し、履歴バッファ
+//   (チャンネル数・保持長) と bad sample / denormal の扱いは呼び出し側が持つ。
+//
+//   ハーフバンドは中心タップ以外の同位相タップが 0 のため、2 位相に分解すると
+//     center 位相: centerCoeff × x[n − centerDelayInput] (1 タップ)
+//     conv   位相: convCount タップの連続 FIR
+//   となる。conv 位相は KernelDispatch の縦方向 FIR で計算する。
+//
+//   特殊化:
+//     - ISA:       design() の isa 引数 (既定はアクティブテーブル) で解決
+//     - タップ数:  convCount が 16 / 32 / 64 の場合、タップ数を constexpr にした
+//                  AVX2 / AVX-512F 版を選ぶ (内側ループが完全展開される)
+//     - 比率:      halfBandStagesForRatio() で段数をコンパイル時に求められる
+//     - 位相分解:  HalfBandGeometry<Taps> と interpolateFixed / decimateFixed で履歴長・位相の
+//                  並びを constexpr にできる (CustomInputOversampler の比率 × プリセット別パイプライン)
+//
+//   単精度: enableSinglePrecision() で float32 係数と float32 縦方向 FIR を用意すると
+//   float 版 interpolate() / decimate() が使える (SIMD 幅 2 倍・メモリ帯域半分)。
+//   double ↔ float の変換 (ディザ) は呼び出し側の責務。
+//
+//   Audio Thread で呼ぶのは interpolate() / decimate() のみ (確保なし)。
+//==============================================================================
+
+namespace convo::dsp {
+
+// 2^k 倍オーバーサンプリングに必要なハーフバンド段数 (1 → 0, 2 → 1, 4 → 2, 8 → 3)
+[[nodiscard]] constexpr int halfBandStagesForRatio(int ratio) noexcept
+{
+    int stages = 0;
+    while (ratio > 1)
+    {
+        ratio >>= 1;
+        ++stages;
+    }
+    return stages;
+}
+
+// タップ数から決まる位相分解の定数 (design() と同じ式)。呼び出し側がタップ数を constexpr で
+// 持っていれば、履歴長・位相の並びがコンパイル時定数になる (interpolateFixed / decimateFixed)
+template <int Taps>
+struct HalfBandGeometry
+{
+    static_assert(Taps >= 3 && (Taps & 1) == 1, "half-band taps must be odd and >= 3");
+
+    static constexpr int centerTap = (Taps - 1) / 2;
+    static constexpr int centerParity = centerTap & 1;
+    static constexpr int convParity = 1 - centerParity;
+    static constexpr int convCount = (Taps - convParity + 1) / 2;
+    static constexpr int centerDelayInput = (centerTap - centerParity) / 2;
+    static constexpr int interpolateHistoryKeep = (convCount - 1 > centerDelayInput) ? (convCount - 1) : centerDelayInput;
+    static constexpr int decimateHistoryKeep = (centerTap > convParity + ((convCount - 1) << 1))
+                                             ? centerTap
+                                             : (convParity + ((convCount - 1) << 1));
+};
+
+struct HalfBandFir
+{
+    int taps = 0;
+    int centerTap = 0;
+    int centerParity = 0;
+    int convParity = 0;
+    int convCount = 0;
+    int centerDelayInput = 0;
+    double centerCoeff = 0.5;
+    ScopedAlignedPtr<double> convCoeffsReversed;  // conv 位相 (時間逆順、64 バイト整列)
+    FirVerticalKernel convKernel = nullptr;       // design() で ISA / convCount 特殊化を解決済み
+    float centerCoeffF32 = 0.5f;
+    ScopedAlignedPtr<float> convCoeffsReversedF32;  // enableSinglePrecision() 後のみ有効
+    FirVerticalF32Kernel convKernelF32 = nullptr;
+
+    HalfBandFir() = default;
+    HalfBandFir(const HalfBandFir&) = delete;
+    HalfBandFir& operator=(const HalfBandFir&) = delete;
+
+    // Message Thread 専用。taps は奇数へ丸める (最小 3)。確保失敗時は false
+    bool design(int taps, double attenuationDb, KernelIsa isa = activeKernels().isa) noexcept;
+    void release() noexcept;
+    [[nodiscard]] bool isReady() const noexcept { return convKernel != nullptr && convCoeffsReversed; }
+
+    // Message Thread 専用。design() 済みの係数から float32 版を用意する。確保失敗時は false
+    bool enableSinglePrecision(KernelIsa isa = activeKernels().isa) noexcept;
+    [[nodiscard]] bool isSinglePrecisionReady() const noexcept
+    {
+        return isReady() && convKernelF32 != nullptr && convCoeffsReversedF32;
+    }
+
+    // 補間: history[keep, keep + numIn) に新入力を置いた状態で呼ぶのに必要な過去サンプル数
+    [[nodiscard]] int interpolateHistoryKeep() const noexcept
+    {
+        return (convCount - 1 > centerDelayInput) ? (convCount - 1) : centerDelayInput;
+    }
+
+    // 間引き: history[keep, keep + 2·numOut) に新入力を置いた状態で必要な過去サンプル数
+    [[nodiscard]] int decimateHistoryKeep() const noexcept
+    {
+        const int convSpan = convParity + ((convCount - 1) << 1);
+        return (centerTap > convSpan) ? centerTap : convSpan;
+    }
+
+    // 間引きの位相作業領域に必要な要素数
+    [[nodiscard]] int decimateScratchSize(int maxOutputSamples) const noexcept
+    {
+        return convCount - 1 + maxOutputSamples;
+    }
+
+    // 2 倍補間 (補間ゲイン 2 を含む)。out は 2·numIn 要素、インターリーブ出力。
+    // keep = interpolateHistoryKeep()。履歴シフトは呼び出し側。out を conv 作業領域に兼用する。
+    void interpolate(const double* history, int keep, int numIn, double* out) const noexcept;
+
+    // 2 倍間引き。history は 2·numOut 個の新入力を含む。phaseScratch は decimateScratchSize 以上。
+    // keep = decimateHistoryKeep()。履歴シフトは呼び出し側。
+    void decimate(const double* history, int keep, int numOut, double* phaseScratch, double* out) const noexcept;
+
+    // float32 版 (isSinglePrecisionReady() のときのみ)。履歴・作業領域の契約は double 版と同じ
+    void interpolate(const float* history, int keep, int numIn, float* out) const noexcept;
+    void decimate(const float* history, int keep, int numOut, float* phaseScratch, float* out) const noexcept;
+
+    // design(Taps, ...) 済みのとき true (interpolateFixed / decimateFixed の前提)
+    template <int Taps>
+    [[nodiscard]] bool matchesGeometry() const noexcept
+    {
+        using G = HalfBandGeometry<Taps>;
+        return isReady() && taps == Taps && convCount == G::convCount && convParity == G::convParity
+            && centerDelayInput == G::centerDelayInput;
+    }
+
+    // タップ数固定版 (double)。keep は HalfBandGeometry<Taps> の値で、位相の並びも定数になる。
+    // 結果は interpolate() / decimate() と同一 (同じ conv カーネル・同じ計算順序)
+    template <int Taps>
+    void interpolateFixed(const double* history, int numIn, double* out) const noexcept;
+    template <int Taps>
+    void decimateFixed(const double* history, int numOut, double* phaseScratch, double* out) const noexcept;
+};
+
+template <int Taps>
+inline void HalfBandFir::interpolateFixed(const double* history, int numIn, double* out) const noexcept
+{
+    using G = HalfBandGeometry<Taps>;
+    constexpr int keep = G::interpolateHistoryKeep;
+    if (numIn <= 0)
+        return;
+
+    // interpolate() と同じく conv 位相を out の後半へ書いてから前へ展開する
+    double* conv = out + numIn;
+    convKernel(history + keep - (G::convCount - 1), convCoeffsReversed.get(), G::convCount, conv, numIn);
+
+    const double* center = history + keep - G::centerDelayInput;
+    const double centerGain = 2.0 * centerCoeff;
+    for (int n = 0; n < numIn; ++n)
+    {
+        const double convValue = conv[n];
+        out[(n << 1) + G::convParity] = 2.0 * convValue;
+        out[(n << 1) + G::centerParity] = centerGain * center[n];
+    }
+}
+
+template <int Taps>
+inline void HalfBandFir::decimateFixed(const double* history, int numOut, double* phaseScratch, double* out) const noexcept
+{
+    using G = HalfBandGeometry<Taps>;
+    constexpr int keep = G::decimateHistoryKeep;
+    constexpr int firstIdx = keep - G::convParity - ((G::convCount - 1) << 1);
+    if (numOut <= 0)
+        return;
+
+    const int phaseCount = G::convCount - 1 + numOut;
+    const double* phase = history + firstIdx;
+    for (int i = 0; i < phaseCount; ++i)
+        phaseScratch[i] = phase[i << 1];
+
+    convKernel(phaseScratch, convCoeffsReversed.get(), G::convCount, out, numOut);
+
+    const double* center = history + keep - G::centerTap;
+    for (int n = 0; n < numOut; ++n)
+        out[n] += centerCoeff * center[n << 1];
+}
+
+} // namespace convo::dsp
@@ -0,0 +1,19 @@
+#pragma once
+
+//==============================================================================
+// IsaTarget — 関数単位の ISA 有効化属性
+//
+//   ビルド全体は /arch:AVX2 (icx は /QxCORE-AVX2) のため、AVX-512 カーネルは
+//   関数単位で命令セットを有効化する。MSVC は /arch 指定なしでも AVX-512
+//   intrinsic を生成できるので属性不要。GCC/Clang は target 属性が必要で、
+//   AVX-512 関数から呼ぶ inline ヘルパーにも同じ属性を付けること
+//   (属性が一致しないとインライン展開できずコンパイルエラーになる)。
+//
+//   実行可否は CpuFeatureCheck (hasAVX512Support) で判定してから呼ぶこと。
+//==============================================================================
+
+#if defined(_MSC_VER) && !defined(__clang__)
+ #define CONVO_TARGET_AVX512
+#else
+ #define CONVO_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
@@ -0,0 +1,486 @@
+//==============================================================================
+// KernelDispatch.cpp
+// 手書き DSP カーネルの Scalar / AVX2 / AVX-512F 実装とディスパッチテーブル
+//==============================================================================
+
+#include "dsp/KernelDispatch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <immintrin.h>
+
+#include "CpuFeatureCheck.h"
+#include "dsp/IsaTarget.h"
+#include "dsp/math/SoftClipBlock.h"
+#include "audioengine/AtomicAccess.h"
+
+namespace convo::dsp {
+
+namespace {
+
+//==============================================================================
+// Scalar
+//==============================================================================
+double dotProductScalar(const double* x, const double* coeffs, int n) noexcept
+{
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i)
+        sum += x[i] * coeffs[i];
+    return sum;
+}
+
+void firVerticalScalar(const double* x, const double* coeffsReversed, int convCount,
+                       double* out, int numOut) noexcept
+{
+    for (int k = 0; k < numOut; ++k)
+    {
+        double sum = 0.0;
+        for (int r = 0; r < convCount; ++r)
+            sum += coeffsReversed[r] * x[k + r];
+        out[k] = sum;
+    }
+}
+
+void firVerticalF32Scalar(const float* x, const float* coeffsReversed, int convCount,
+                          float* out, int numOut) noexcept
+{
+    for (int k = 0; k < numOut; ++k)
+    {
+        float sum = 0.0f;
+        for (int r = 0; r < convCount; ++r)
+            sum += coeffsReversed[r] * x[k + r];
+        out[k] = sum;
+    }
+}
+
+double peakAbsScalar(const double* x, int n) noexcept
+{
+    double peak = 0.0;
+    for (int i = 0; i < n; ++i)
+        peak = std::max(peak, std::abs(x[i]));
+    return peak;
+}
+
+// SoftClip は 3 幅とも SoftClipBlock.h の同じ評価順 (ビット一致)
+void softClipScalar(double* data, int n, double threshold, double knee, double asymmetry) noexcept
+{
+    softClipBlockScalar<SoftClipPadéPolicy>(data, n, threshold, knee, asymmetry);
+}
+
+//==============================================================================
+// AVX2 + FMA3
+//==============================================================================
+double dotProductAvx2(const double* __restrict x, const double* __restrict coeffs, int n) noexcept
+{
+    // x: 履歴バッファのオフセット位置 (非整列) → loadu / coeffs: 64 バイト整列 → load
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+
+    int i = 0;
+    // 4 アキュムレータで FMA レイテンシを隠す (16 要素/反復)
+    for (; i <= n - 16; i += 16)
+    {
+        // バッファ境界内のみ prefetch
+        if (i + 64 < n)
+        {
+            _mm_prefetch(reinterpret_cast<const char*>(x + i + 64), _MM_HINT_T0);
+            _mm_prefetch(reinterpret_cast<const char*>(coeffs + i + 64), _MM_HINT_T0);
+        }
+
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i),      _mm256_load_pd(coeffs + i),      acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4),  _mm256_load_pd(coeffs + i + 4),  acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8),  _mm256_load_pd(coeffs + i + 8),  acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_load_pd(coeffs + i + 12), acc3);
+    }
+    for (; i <= n - 4; i += 4)
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_load_pd(coeffs + i), acc0);
+
+    acc0 = _mm256_add_pd(acc0, acc1);
+    acc2 = _mm256_add_pd(acc2, acc3);
+    acc0 = _mm256_add_pd(acc0, acc2);
+
+    // vextractf128 + hadd (スタック経由のスカラー加算を避ける)
+    const __m128d vLo = _mm256_castpd256_pd128(acc0);
+    const __m128d vHi = _mm256_extractf128_pd(acc0, 1);
+    __m128d vSum = _mm_add_pd(vLo, vHi);
+    vSum = _mm_hadd_pd(vSum, vSum);
+    double sum = _mm_cvtsd_f64(vSum);
+
+    for (; i < n; ++i)
+        sum += x[i] * coeffs[i];
+    return sum;
+}
+
+void firVerticalAvx2(const double* __restrict x, const double* __restrict coeffsReversed, int convCount,
+                     double* __restrict out, int numOut) noexcept
+{
+    // 出力 4 サンプルを 1 レーン束として持ち、係数をブロードキャストして縦に積和する。
+    // 水平リダクションが不要で、x は連続 loadu のみ (ストライドアクセスなし)。
+    int k = 0;
+    for (; k <= numOut - 8; k += 8)
+    {
+        const double* xk = x + k;
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        __m256d acc2 = _mm256_setzero_pd();
+        __m256d acc3 = _mm256_setzero_pd();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            const __m256d c0 = _mm256_broadcast_sd(coeffsReversed + r);
+            const __m256d c1 = _mm256_broadcast_sd(coeffsReversed + r + 1);
+            acc0 = _mm256_fmadd_pd(c0, _mm256_loadu_pd(xk + r),         acc0);
+            acc1 = _mm256_fmadd_pd(c0, _mm256_loadu_pd(xk + r + 4),     acc1);
+            acc2 = _mm256_fmadd_pd(c1, _mm256_loadu_pd(xk + r + 1),     acc2);
+            acc3 = _mm256_fmadd_pd(c1, _mm256_loadu_pd(xk + r + 1 + 4), acc3);
+        }
+        for (; r < convCount; ++r)
+        {
+            const __m256d c0 = _mm256_broadcast_sd(coeffsReversed + r);
+            acc0 = _mm256_fmadd_pd(c0, _mm256_loadu_pd(xk + r),     acc0);
+            acc1 = _mm256_fmadd_pd(c0, _mm256_loadu_pd(xk + r + 4), acc1);
+        }
+        _mm256_storeu_pd(out + k,     _mm256_add_pd(acc0, acc2));
+        _mm256_storeu_pd(out + k + 4, _mm256_add_pd(acc1, acc3));
+    }
+
+    for (; k <= numOut - 4; k += 4)
+    {
+        const double* xk = x + k;
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            acc0 = _mm256_fmadd_pd(_mm256_broadcast_sd(coeffsReversed + r),     _mm256_loadu_pd(xk + r),     acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_broadcast_sd(coeffsReversed + r + 1), _mm256_loadu_pd(xk + r + 1), acc1);
+        }
+        for (; r < convCount; ++r)
+            acc0 = _mm256_fmadd_pd(_mm256_broadcast_sd(coeffsReversed + r), _mm256_loadu_pd(xk + r), acc0);
+        _mm256_storeu_pd(out + k, _mm256_add_pd(acc0, acc1));
+    }
+
+    for (; k < numOut; ++k)
+    {
+        double sum = 0.0;
+        for (int r = 0; r < convCount; ++r)
+            sum += coeffsReversed[r] * x[k + r];
+        out[k] = sum;
+    }
+}
+
+void firVerticalF32Avx2(const float* __restrict x, const float* __restrict coeffsReversed, int convCount,
+                        float* __restrict out, int numOut) noexcept
+{
+    // double 版と同じ縦方向積和を 8 出力/レーン束で行う (16 出力/反復)
+    int k = 0;
+    for (; k <= numOut - 16; k += 16)
+    {
+        const float* xk = x + k;
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            const __m256 c0 = _mm256_broadcast_ss(coeffsReversed + r);
+            const __m256 c1 = _mm256_broadcast_ss(coeffsReversed + r + 1);
+            acc0 = _mm256_fmadd_ps(c0, _mm256_loadu_ps(xk + r),         acc0);
+            acc1 = _mm256_fmadd_ps(c0, _mm256_loadu_ps(xk + r + 8),     acc1);
+            acc2 = _mm256_fmadd_ps(c1, _mm256_loadu_ps(xk + r + 1),     acc2);
+            acc3 = _mm256_fmadd_ps(c1, _mm256_loadu_ps(xk + r + 1 + 8), acc3);
+        }
+        for (; r < convCount; ++r)
+        {
+            const __m256 c0 = _mm256_broadcast_ss(coeffsReversed + r);
+            acc0 = _mm256_fmadd_ps(c0, _mm256_loadu_ps(xk + r),     acc0);
+            acc1 = _mm256_fmadd_ps(c0, _mm256_loadu_ps(xk + r + 8), acc1);
+        }
+        _mm256_storeu_ps(out + k,     _mm256_add_ps(acc0, acc2));
+        _mm256_storeu_ps(out + k + 8, _mm256_add_ps(acc1, acc3));
+    }
+
+    for (; k <= numOut - 8; k += 8)
+    {
+        const float* xk = x + k;
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(coeffsReversed + r),     _mm256_loadu_ps(xk + r),     acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(coeffsReversed + r + 1), _mm256_loadu_ps(xk + r + 1), acc1);
+        }
+        for (; r < convCount; ++r)
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(coeffsReversed + r), _mm256_loadu_ps(xk + r), acc0);
+        _mm256_storeu_ps(out + k, _mm256_add_ps(acc0, acc1));
+    }
+
+    for (; k < numOut; ++k)
+    {
+        float sum = 0.0f;
+        for (int r = 0; r < convCount; ++r)
+            sum += coeffsReversed[r] * x[k + r];
+        out[k] = sum;
+    }
+}
+
+double peakAbsAvx2(const double* x, int n) noexcept
+{
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    __m256d vPeak = _mm256_setzero_pd();
+    int i = 0;
+    for (; i <= n - 4; i += 4)
+        vPeak = _mm256_max_pd(vPeak, _mm256_andnot_pd(signMask, _mm256_loadu_pd(x + i)));
+
+    __m128d vMax = _mm_max_pd(_mm256_castpd256_pd128(vPeak), _mm256_extractf128_pd(vPeak, 1));
+    vMax = _mm_max_sd(vMax, _mm_unpackhi_pd(vMax, vMax));
+    double peak = _mm_cvtsd_f64(vMax);
+    for (; i < n; ++i)
+        peak = std::max(peak, std::abs(x[i]));
+    return peak;
+}
+
+void softClipAvx2(double* __restrict data, int n, double threshold, double knee, double asymmetry) noexcept
+{
+    softClipBlockV256<SoftClipPadéPolicy>(data, n, threshold, knee, asymmetry);
+}
+
+//==============================================================================
+// AVX-512F (関数単位で有効化、端数は opmask で処理しスカラー tail なし)
+//==============================================================================
+CONVO_TARGET_AVX512 inline __mmask8 tailMask(int remaining) noexcept
+{
+    return static_cast<__mmask8>((1u << remaining) - 1u);
+}
+
+CONVO_TARGET_AVX512 double dotProductAvx512(const double* __restrict x, const double* __restrict coeffs, int n) noexcept
+{
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    __m512d acc2 = _mm512_setzero_pd();
+    __m512d acc3 = _mm512_setzero_pd();
+
+    int i = 0;
+    for (; i <= n - 32; i += 32)
+    {
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i),      _mm512_loadu_pd(coeffs + i),      acc0);
+        acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8),  _mm512_loadu_pd(coeffs + i + 8),  acc1);
+        acc2 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(coeffs + i + 16), acc2);
+        acc3 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(coeffs + i + 24), acc3);
+    }
+    for (; i <= n - 8; i += 8)
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(coeffs + i), acc0);
+    if (i < n)
+    {
+        const __mmask8 m = tailMask(n - i);
+        acc1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, coeffs + i), acc1);
+    }
+
+    acc0 = _mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3));
+    return _mm512_reduce_add_pd(acc0);
+}
+
+CONVO_TARGET_AVX512 void firVerticalAvx512(const double* __restrict x, const double* __restrict coeffsReversed,
+                                           int convCount, double* __restrict out, int numOut) noexcept
+{
+    // AVX2 版と同じ縦方向積和を 8 出力/レーン束で行う (16 出力/反復)
+    int k = 0;
+    for (; k <= numOut - 16; k += 16)
+    {
+        const double* xk = x + k;
+        __m512d acc0 = _mm512_setzero_pd();
+        __m512d acc1 = _mm512_setzero_pd();
+        __m512d acc2 = _mm512_setzero_pd();
+        __m512d acc3 = _mm512_setzero_pd();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            const __m512d c0 = _mm512_set1_pd(coeffsReversed[r]);
+            const __m512d c1 = _mm512_set1_pd(coeffsReversed[r + 1]);
+            acc0 = _mm512_fmadd_pd(c0, _mm512_loadu_pd(xk + r),         acc0);
+            acc1 = _mm512_fmadd_pd(c0, _mm512_loadu_pd(xk + r + 8),     acc1);
+            acc2 = _mm512_fmadd_pd(c1, _mm512_loadu_pd(xk + r + 1),     acc2);
+            acc3 = _mm512_fmadd_pd(c1, _mm512_loadu_pd(xk + r + 1 + 8), acc3);
+        }
+        for (; r < convCount; ++r)
+        {
+            const __m512d c0 = _mm512_set1_pd(coeffsReversed[r]);
+            acc0 = _mm512_fmadd_pd(c0, _mm512_loadu_pd(xk + r),     acc0);
+            acc1 = _mm512_fmadd_pd(c0, _mm512_loadu_pd(xk + r + 8), acc1);
+        }
+        _mm512_storeu_pd(out + k,     _mm512_add_pd(acc0, acc2));
+        _mm512_storeu_pd(out + k + 8, _mm512_add_pd(acc1, acc3));
+    }
+
+    // 残り 8 未満は opmask で同じ縦方向積和 (マスク外レーンは読まない)
+    for (; k < numOut; k += 8)
+    {
+        const __mmask8 m = (numOut - k >= 8) ? static_cast<__mmask8>(0xFF) : tailMask(numOut - k);
+        const double* xk = x + k;
+        __m512d acc0 = _mm512_setzero_pd();
+        __m512d acc1 = _mm512_setzero_pd();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            acc0 = _mm512_fmadd_pd(_mm512_set1_pd(coeffsReversed[r]),     _mm512_maskz_loadu_pd(m, xk + r),     acc0);
+            acc1 = _mm512_fmadd_pd(_mm512_set1_pd(coeffsReversed[r + 1]), _mm512_maskz_loadu_pd(m, xk + r + 1), acc1);
+        }
+        for (; r < convCount; ++r)
+            acc0 = _mm512_fmadd_pd(_mm512_set1_pd(coeffsReversed[r]), _mm512_maskz_loadu_pd(m, xk + r), acc0);
+        _mm512_mask_storeu_pd(out + k, m, _mm512_add_pd(acc0, acc1));
+    }
+}
+
+CONVO_TARGET_AVX512 void firVerticalF32Avx512(const float* __restrict x, const float* __restrict coeffsReversed,
+                                              int convCount, float* __restrict out, int numOut) noexcept
+{
+    // 16 出力/レーン束 (32 出力/反復)。端数は 16 ビット opmask
+    int k = 0;
+    for (; k <= numOut - 32; k += 32)
+    {
+        const float* xk = x + k;
+        __m512 acc0 = _mm512_setzero_ps();
+        __m512 acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps();
+        __m512 acc3 = _mm512_setzero_ps();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            const __m512 c0 = _mm512_set1_ps(coeffsReversed[r]);
+            const __m512 c1 = _mm512_set1_ps(coeffsReversed[r + 1]);
+            acc0 = _mm512_fmadd_ps(c0, _mm512_loadu_ps(xk + r),          acc0);
+            acc1 = _mm512_fmadd_ps(c0, _mm512_loadu_ps(xk + r + 16),     acc1);
+            acc2 = _mm512_fmadd_ps(c1, _mm512_loadu_ps(xk + r + 1),      acc2);
+            acc3 = _mm512_fmadd_ps(c1, _mm512_loadu_ps(xk + r + 1 + 16), acc3);
+        }
+        for (; r < convCount; ++r)
+        {
+            const __m512 c0 = _mm512_set1_ps(coeffsReversed[r]);
+            acc0 = _mm512_fmadd_ps(c0, _mm512_loadu_ps(xk + r),      acc0);
+            acc1 = _mm512_fmadd_ps(c0, _mm512_loadu_ps(xk + r + 16), acc1);
+        }
+        _mm512_storeu_ps(out + k,      _mm512_add_ps(acc0, acc2));
+        _mm512_storeu_ps(out + k + 16, _mm512_add_ps(acc1, acc3));
+    }
+
+    for (; k < numOut; k += 16)
+    {
+        const int remaining = numOut - k;
+        const __mmask16 m = (remaining >= 16) ? static_cast<__mmask16>(0xFFFF)
+                                              : static_cast<__mmask16>((1u << remaining) - 1u);
+        const float* xk = x + k;
+        __m512 acc0 = _mm512_setzero_ps();
+        __m512 acc1 = _mm512_setzero_ps();
+        int r = 0;
+        for (; r <= convCount - 2; r += 2)
+        {
+            acc0 = _mm512_fmadd_ps(_mm512_set1_ps(coeffsReversed[r]),     _mm512_maskz_loadu_ps(m, xk + r),     acc0);
+            acc1 = _mm512_fmadd_ps(_mm512_set1_ps(coeffsReversed[r + 1]), _mm512_maskz_loadu_ps(m, xk + r + 1), acc1);
+        }
+        for (; r < convCount; ++r)
+            acc0 = _mm512_fmadd_ps(_mm512_set1_ps(coeffsReversed[r]), _mm512_maskz_loadu_ps(m, xk + r), acc0);
+        _mm512_mask_storeu_ps(out + k, m, _mm512_add_ps(acc0, acc1));
+    }
+}
+
+CONVO_TARGET_AVX512 double peakAbsAvx512(const double* x, int n) noexcept
+{
+    __m512d vPeak = _mm512_setzero_pd();
+    int i = 0;
+    for (; i <= n - 8; i += 8)
+        vPeak = _mm512_max_pd(vPeak, _mm512_abs_pd(_mm512_loadu_pd(x + i)));
+    if (i < n)
+        vPeak = _mm512_max_pd(vPeak, _mm512_abs_pd(_mm512_maskz_loadu_pd(tailMask(n - i), x + i)));
+    return _mm512_reduce_max_pd(vPeak);
+}
+
+CONVO_TARGET_AVX512 void softClipAvx512(double* __restrict data, int n, double threshold, double knee, double asymmetry) noexcept
+{
+    softClipBlockV512<SoftClipPadéPolicy>(data, n, threshold, knee, asymmetry);
+}
+
+//==============================================================================
+// テーブル
+//==============================================================================
+constexpr KernelTable kScalarKernels {
+    KernelIsa::Scalar, &dotProductScalar, &firVerticalScalar, &firVerticalF32Scalar, &peakAbsScalar, &softClipScalar
+};
+
+constexpr KernelTable kAvx2Kernels {
+    KernelIsa::Avx2, &dotProductAvx2, &firVerticalAvx2, &firVerticalF32Avx2, &peakAbsAvx2, &softClipAvx2
+};
+
+constexpr KernelTable kAvx512Kernels {
+    KernelIsa::Avx512, &dotProductAvx512, &firVerticalAvx512, &firVerticalF32Avx512, &peakAbsAvx512, &softClipAvx512
+};
+
+// 起動ゲート (AVX2 必須) の前提により、初期化前の既定値は Avx2
+std::atomic<const KernelTable*> gActiveKernels { &kAvx2Kernels };
+
+const KernelTable& tableFor(KernelIsa isa) noexcept
+{
+    switch (isa)
+    {
+        case KernelIsa::Avx512: return kAvx512Kernels;
+        case KernelIsa::Avx2:   return kAvx2Kernels;
+        case KernelIsa::Scalar:
+        default:                return kScalarKernels;
+    }
+}
+
+KernelIsa bestSupportedIsa(KernelIsa maxIsa) noexcept
+{
+    if (maxIsa >= KernelIsa::Avx512 && isKernelIsaSupported(KernelIsa::Avx512))
+        return KernelIsa::Avx512;
+    if (maxIsa >= KernelIsa::Avx2 && isKernelIsaSupported(KernelIsa::Avx2))
+        return KernelIsa::Avx2;
+    return KernelIsa::Scalar;
+}
+
+} // namespace
+
+bool isKernelIsaSupported(KernelIsa isa) noexcept
+{
+    switch (isa)
+    {
+        case KernelIsa::Avx512: return hasAVX512Support();
+        case KernelIsa::Avx2:   return hasAVX2Support();
+        case KernelIsa::Scalar: return true;
+        default:                return false;
+    }
+}
+
+KernelIsa initialiseKernelDispatch(KernelIsa maxIsa) noexcept
+{
+    const KernelIsa isa = bestSupportedIsa(maxIsa);
+    convo::publishAtomic(gActiveKernels, &tableFor(isa), std::memory_order_release);
+    return isa;
+}
+
+const KernelTable& activeKernels() noexcept
+{
+    return *convo::consumeAtomic(gActiveKernels, std::memory_order_acquire);
+}
+
+const KernelTable& kernelsFor(KernelIsa isa) noexcept
+{
+    return tableFor(bestSupportedIsa(isa));
+}
+
+const char* kernelIsaName(KernelIsa isa) noexcept
+{
+    switch (isa)
+    {
+        case KernelIsa::Avx512: return "avx512";
+        case KernelIsa::Avx2:   return "avx2";
+        case KernelIsa::Scalar: return "scalar";
+        default:                return "unknown";
+    }
+}
+
+} // namespace convo::dsp
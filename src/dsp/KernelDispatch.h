@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+//==============================================================================
+// KernelDispatch — 手書き DSP カーネルの ISA ディスパッチテーブル
+//
+//   起動時 (MainApplication::initialise) に initialiseKernelDispatch() が
+//   CpuFeatureCheck の検出結果から 1 回だけテーブルを確定する。
+//   各 DSP クラスは prepare() (Message Thread) で必要な関数ポインタを自身の
+//   メンバへ写し、Audio Thread は解決済みポインタを間接呼び出しするだけ。
+//   Audio Thread からテーブル本体を参照しない (切替途中の混在を避ける)。
+//
+//   ISA 階層:
+//     Scalar — 可搬 C++ 参照実装 (検証・強制切替用)。
+//              ビルドは /arch:AVX2 のため、AVX2 非対応 CPU の救済にはならない。
+//     Avx2   — AVX2 + FMA3。起動ゲート (checkAVX2SupportAndWarn) と同じ前提。
+//     Avx512 — AVX-512F。関数単位の target 属性で生成し、CPU/OS 対応時のみ選択。
+//
+//   カーネルはすべて「生の」演算のみを行う。bad sample / denormal の扱いは
+//   呼び出し側 (CustomInputOversampler 等) の責務。
+//==============================================================================
+
+namespace convo::dsp {
+
+enum class KernelIsa : uint8_t { Scalar = 0, Avx2 = 1, Avx512 = 2 };
+
+// Σ x[i] * coeffs[i] (i < n)。coeffs は 64 バイト整列、x は非整列可
+using DotProductKernel = double (*)(const double* x, const double* coeffs, int n) noexcept;
+// 縦方向 FIR: out[k] = Σ_r coeffsReversed[r] * x[k + r] (k < numOut, r < convCount)
+using FirVerticalKernel = void (*)(const double* x, const double* coeffsReversed, int convCount,
+                                   double* out, int numOut) noexcept;
+// 縦方向 FIR の float32 版 (CustomInputOversampler の単精度ステージ用)。累算も float32
+using FirVerticalF32Kernel = void (*)(const float* x, const float* coeffsReversed, int convCount,
+                                      float* out, int numOut) noexcept;
+// max |x[i]| (i < n)。n <= 0 は 0
+using PeakAbsKernel = double (*)(const double* x, int n) noexcept;
+// SoftClip (Padé tanh ニー)。data をインプレースで処理する
+using SoftClipKernel = void (*)(double* data, int n, double threshold, double knee, double asymmetry) noexcept;
+
+struct KernelTable
+{
+    KernelIsa isa;
+    DotProductKernel dotProduct;
+    FirVerticalKernel firVertical;
+    FirVerticalF32Kernel firVerticalF32;
+    PeakAbsKernel peakAbs;
+    SoftClipKernel softClip;
+};
+
+// CPU が対応する最上位 ISA (maxIsa 以下) でアクティブテーブルを確定する。
+// Message Thread 専用。Audio 開始前 (prepareToPlay より前) に呼ぶこと。
+KernelIsa initialiseKernelDispatch(KernelIsa maxIsa = KernelIsa::Avx512) noexcept;
+
+// アクティブテーブル。initialiseKernelDispatch 前は Avx2 テーブル (起動ゲートの前提)
+[[nodiscard]] const KernelTable& activeKernels() noexcept;
+
+// 指定 ISA のテーブル (テスト/ベンチマーク用)。非対応 ISA は対応する最上位へ落とす
+[[nodiscard]] const KernelTable& kernelsFor(KernelIsa isa) noexcept;
+
+[[nodiscard]] bool isKernelIsaSupported(KernelIsa isa) noexcept;
+[[nodiscard]] const char* kernelIsaName(KernelIsa isa) noexcept;
+
+} // namespace convo::dsp
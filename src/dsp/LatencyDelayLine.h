@@ -0,0 +1,292 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "audioengine/AtomicAccess.h"
+
+//==============================================================================
+// LatencyDelayLine — レイテンシ補正用のステレオ遅延リング (容量は実際の遅延に合わせて伸ばす)
+//
+//   ConvolverProcessor の Dry 経路とバイパス経路は、どちらも「入力をリングへ書き、
+//   Convolver の遅延 (アルゴリズム遅延 + IR ピーク位置) だけ前を読み出す」同じ処理を持ち、
+//   リングは最大遅延 (MAX_TOTAL_DELAY ≈ 2.6M サンプル) 向けの固定 2^22 × 2ch = 64 MB だった。
+//   DSPCore ごと (公開中・フェード中・A/B 常駐・構築中) に 1 本ずつあり、ほぼ全域が未使用になる。
+//
+//   ここでは容量を「遅延 + 1 ブロック + 補間ガード」以上の最小の 2 の累乗にする。
+//   遅延が伸びたら (refreshLatency: 非 RT) 大きいリングを確保して予約し、Audio Thread が
+//   次のブロック先頭で取り込む (adoptPendingGrowth)。取り込みでは旧リングの履歴を
+//   同じ「何サンプル前か」の位置へ写すので、遅延の読み出し位置は連続したまま変わらない
+//   (旧容量より古い位置は無音。遅延が伸びるのは通常 DSPCore 公開前の refreshLatency なので実害はない)。
+//   旧リングは retired スロットに置き、非 RT が次の reserve / collectRetired で解放する。
+//   retired が未回収のあいだは取り込みを見送る (Audio Thread は解放も確保もしない)。
+//
+//   読み書きは memcpy 2 区間 (ラップ境界) 単位。容量を伸ばすだけで縮めないため、
+//   クロスフェード中の旧遅延 (以前の容量で有効だった値) も常に読める。
+//
+//   スレッドモデル:
+//     - prepare() / release() / clear(): Audio Thread 停止中 (prepareToPlay / releaseResources / reset)
+//     - reserve() / collectRetired(): 非 RT (mutex で直列化)
+//     - adoptPendingGrowth() / write() / read() / advance(): Audio Thread (単一コンシューマ)
+//
+//   Allocator は static double* allocate(size_t) noexcept (失敗時 nullptr) と
+//   static void deallocate(double*) noexcept を持つ型。JUCE 非依存。
+//==============================================================================
+
+namespace convo::dsp {
+
+template <typename Allocator>
+class LatencyDelayLine
+{
+public:
+    static constexpr int kNumChannels = 2;
+    // 3 次エルミート補間が読む前後 (idx-1 .. idx+2) と丸めの余裕
+    static constexpr int kInterpolationGuard = 4;
+    static constexpr int kMinCapacity = 64;
+    static constexpr int kMaxCapacity = 1 << 30;
+
+    // delaySamples の遅延を maxBlockSamples のブロックで読み書きできる最小容量 (2 の累乗)
+    [[nodiscard]] static constexpr int capacityFor(int delaySamples, int maxBlockSamples) noexcept
+    {
+        const long long required = static_cast<long long>(std::max(0, delaySamples))
+                                 + std::max(1, maxBlockSamples) + kInterpolationGuard;
+        long long capacity = kMinCapacity;
+        while (capacity < required && capacity < kMaxCapacity)
+            capacity <<= 1;
+        return static_cast<int>(capacity);
+    }
+
+    LatencyDelayLine() = default;
+    ~LatencyDelayLine() { release(); }
+
+    LatencyDelayLine(const LatencyDelayLine&) = delete;
+    LatencyDelayLine& operator=(const LatencyDelayLine&) = delete;
+
+    // 初期容量で確保し直してゼロクリアする。予約中・回収待ちのリングも破棄する
+    bool prepare(int initialDelaySamples, int maxBlockSamples) noexcept
+    {
+        std::lock_guard<std::mutex> lock(reserveMutex_);
+        releaseLocked();
+        maxBlockSamples_ = std::max(1, maxBlockSamples);
+        current_ = createStorage(capacityFor(initialDelaySamples, maxBlockSamples_));
+        reservedCapacity_ = (current_ != nullptr) ? current_->capacity : 0;
+        writePos_ = 0;
+        return current_ != nullptr;
+    }
+
+    void release() noexcept
+    {
+        std::lock_guard<std::mutex> lock(reserveMutex_);
+        releaseLocked();
+    }
+
+    void clear() noexcept
+    {
+        if (current_ != nullptr)
+            std::memset(current_->data, 0, sizeof(double) * static_cast<std::size_t>(current_->capacity) * kNumChannels);
+        writePos_ = 0;
+    }
+
+    // delaySamples を読めるだけの容量を予約する。既に足りていれば何もしない。
+    // 確保に失敗した場合は false (Audio Thread は現在の容量で遅延をクランプし続ける)
+    bool reserve(int delaySamples) noexcept
+    {
+        std::lock_guard<std::mutex> lock(reserveMutex_);
+        collectRetiredLocked();
+        if (reservedCapacity_ == 0)
+            return false;   // prepare 前
+
+        const int capacity = capacityFor(delaySamples, maxBlockSamples_);
+        if (capacity <= reservedCapacity_)
+            return true;
+
+        Storage* grown = createStorage(capacity);
+        if (grown == nullptr)
+            return false;
+
+        // acq_rel: release で zero-fill 済みの grown を adoptPendingGrowth (exchange acquire) へ公開し、
+        //          acquire で取り込まれなかった旧予約を回収する
+        destroyStorage(convo::exchangeAtomic(pending_, grown, std::memory_order_acq_rel));
+        reservedCapacity_ = capacity;
+        return true;
+    }
+
+    // Audio Thread が取り込み済みの旧リングを解放する
+    void collectRetired() noexcept
+    {
+        std::lock_guard<std::mutex> lock(reserveMutex_);
+        collectRetiredLocked();
+    }
+
+    // Audio Thread: ブロック先頭で予約済みのリングへ切り替える
+    void adoptPendingGrowth() noexcept
+    {
+        // relaxed: 予約の有無を見るだけ。中身は下の exchange (acquire) で受け取る
+        if (convo::consumeAtomic(pending_, std::memory_order_relaxed) == nullptr)
+            return;
+        // acquire: collectRetiredLocked の exchange と HB。未回収なら置き場がないので見送る
+        if (convo::consumeAtomic(retired_, std::memory_order_acquire) != nullptr)
+            return;
+
+        // acq_rel: acquire で reserve の zero-fill と HB、release で nullptr の書き戻しを reserve へ公開
+        Storage* grown = convo::exchangeAtomic(pending_, static_cast<Storage*>(nullptr), std::memory_order_acq_rel);
+        if (grown == nullptr)
+            return;
+
+        Storage* old = current_;
+        if (old != nullptr)
+            copyHistory(*old, *grown);
+        current_ = grown;
+
+        // release: 旧リングへの最後の読み書きを collectRetiredLocked (exchange acquire) と HB
+        convo::publishAtomic(retired_, old, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool isReady() const noexcept { return current_ != nullptr; }
+    [[nodiscard]] int capacity() const noexcept { return current_ != nullptr ? current_->capacity : 0; }
+    [[nodiscard]] int mask() const noexcept { return capacity() - 1; }
+    [[nodiscard]] int writePosition() const noexcept { return writePos_; }
+
+    // numSamples のブロックで読める最大の遅延。ブロックが準備時より長い場合も書き込みが
+    // 読み出し区間を潰さない範囲に抑える
+    [[nodiscard]] int maxDelayFor(int numSamples) const noexcept
+    {
+        return std::max(0, capacity() - std::max(numSamples, 1) - kInterpolationGuard);
+    }
+
+    // 書き込みが 1 周を超えるブロックは扱えない (呼び出し側で無音にする)
+    [[nodiscard]] bool canProcess(int numSamples) const noexcept
+    {
+        return current_ != nullptr && numSamples <= current_->capacity - kInterpolationGuard;
+    }
+
+    [[nodiscard]] double* channel(int ch) noexcept
+    {
+        return current_->data + static_cast<std::size_t>(ch) * static_cast<std::size_t>(current_->capacity);
+    }
+
+    [[nodiscard]] const double* channel(int ch) const noexcept
+    {
+        return current_->data + static_cast<std::size_t>(ch) * static_cast<std::size_t>(current_->capacity);
+    }
+
+    // 書き込み位置から numSamples を書く (位置は advance で進める)
+    void write(int ch, const double* src, int numSamples) noexcept
+    {
+        double* ring = channel(ch);
+        const int first = std::min(numSamples, capacity() - writePos_);
+        std::memcpy(ring + writePos_, src, static_cast<std::size_t>(first) * sizeof(double));
+        if (numSamples > first)
+            std::memcpy(ring, src + first, static_cast<std::size_t>(numSamples - first) * sizeof(double));
+    }
+
+    // 書き込み位置の delaySamples 前から numSamples を読む。同じブロックで write 済みの分も読める
+    void read(int ch, double* dst, int numSamples, int delaySamples) const noexcept
+    {
+        const double* ring = channel(ch);
+        const int readPos = (writePos_ - delaySamples) & mask();
+        const int first = std::min(numSamples, capacity() - readPos);
+        std::memcpy(dst, ring + readPos, static_cast<std::size_t>(first) * sizeof(double));
+        if (numSamples > first)
+            std::memcpy(dst + first, ring, static_cast<std::size_t>(numSamples - first) * sizeof(double));
+    }
+
+    void advance(int numSamples) noexcept
+    {
+        writePos_ = (writePos_ + numSamples) & mask();
+    }
+
+    // 予約済み容量 (取り込み前なら予約側) と回収待ちリングのバイト数。非 RT の統計用。
+    // current_ は Audio Thread が差し替えるので読まない
+    [[nodiscard]] std::size_t residentBytes() const noexcept
+    {
+        std::lock_guard<std::mutex> lock(reserveMutex_);
+        // acquire: adoptPendingGrowth の publishAtomic (release) と HB。解放は同じ mutex 下でしか起きない
+        return static_cast<std::size_t>(reservedCapacity_) * kNumChannels * sizeof(double)
+             + storageBytes(convo::consumeAtomic(retired_, std::memory_order_acquire));
+    }
+
+private:
+    struct Storage
+    {
+        double* data = nullptr;
+        int capacity = 0;
+    };
+
+    static Storage* createStorage(int capacity) noexcept
+    {
+        const std::size_t count = static_cast<std::size_t>(capacity) * kNumChannels;
+        double* data = Allocator::allocate(count);
+        if (data == nullptr)
+            return nullptr;
+        auto* storage = new (std::nothrow) Storage { data, capacity };
+        if (storage == nullptr)
+        {
+            Allocator::deallocate(data);
+            return nullptr;
+        }
+        std::memset(data, 0, count * sizeof(double));
+        return storage;
+    }
+
+    static void destroyStorage(Storage* storage) noexcept
+    {
+        if (storage == nullptr)
+            return;
+        Allocator::deallocate(storage->data);
+        delete storage;
+    }
+
+    static std::size_t storageBytes(const Storage* storage) noexcept
+    {
+        return storage != nullptr
+            ? static_cast<std::size_t>(storage->capacity) * kNumChannels * sizeof(double)
+            : 0;
+    }
+
+    // old の直近 old.capacity サンプルを、書き込み位置から同じ距離の grown の位置へ写す。
+    // 書き込み位置は据え置き (writePos_ < old.capacity <= grown.capacity)
+    void copyHistory(const Storage& old, Storage& grown) const noexcept
+    {
+        const int recent = writePos_;                   // old[0, wp) → grown[0, wp)
+        const int older = old.capacity - writePos_;     // old[wp, cap) → grown の末尾側
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            const double* src = old.data + static_cast<std::size_t>(ch) * static_cast<std::size_t>(old.capacity);
+            double* dst = grown.data + static_cast<std::size_t>(ch) * static_cast<std::size_t>(grown.capacity);
+            std::memcpy(dst, src, static_cast<std::size_t>(recent) * sizeof(double));
+            std::memcpy(dst + (grown.capacity - older), src + writePos_, static_cast<std::size_t>(older) * sizeof(double));
+        }
+    }
+
+    void collectRetiredLocked() noexcept
+    {
+        // acquire: adoptPendingGrowth の publishAtomic (release) と HB。以後 Audio Thread は旧リングに触れない
+        destroyStorage(convo::exchangeAtomic(retired_, static_cast<Storage*>(nullptr), std::memory_order_acquire));
+    }
+
+    void releaseLocked() noexcept
+    {
+        destroyStorage(current_);
+        current_ = nullptr;
+        // relaxed: Audio Thread 停止中 (prepare / release の契約)
+        destroyStorage(convo::exchangeAtomic(pending_, static_cast<Storage*>(nullptr), std::memory_order_relaxed));
+        destroyStorage(convo::exchangeAtomic(retired_, static_cast<Storage*>(nullptr), std::memory_order_relaxed));
+        reservedCapacity_ = 0;
+        writePos_ = 0;
+    }
+
+    Storage* current_ = nullptr;                // Audio Thread 所有 (停止中は prepare / release が触る)
+    std::atomic<Storage*> pending_ { nullptr }; // 非 RT → Audio Thread
+    std::atomic<Storage*> retired_ { nullptr }; // Audio Thread → 非 RT
+    int writePos_ = 0;
+    int maxBlockSamples_ = 1;
+    int reservedCapacity_ = 0;                  // 非 RT 側から見た最大容量 (current または pending)。mutex 下
+    mutable std::mutex reserveMutex_;
+};
+
+} // namespace convo::dsp
@@ -0,0 +1,381 @@
+//==============================================================================
+// LatticeNoiseShaperBatch.cpp
+// 候補並列 9 次格子ノイズシェーパー (Scalar / AVX2 / AVX-512F カーネル)
+//==============================================================================
+
+// LatticeNoiseShaper.h と同様、/fp:fast の再結合を避けて ISA 間のビット一致を保つ
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "dsp/LatticeNoiseShaperBatch.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+#include "dsp/IsaTarget.h"
+
+namespace convo::dsp {
+
+namespace {
+
+constexpr int kOrder = LatticeNoiseShaperBatch::kOrder;
+constexpr int kStride = LatticeNoiseShaperBatch::kMaxLanes;
+constexpr int kScalarLanes = 4;
+constexpr double kLatticeStateLimit = 2.0;   // LatticeNoiseShaper::advanceState と同じ
+constexpr double kBlockStateLimit = 1.0e12;  // LatticeNoiseShaper::clampStateSIMD と同じ
+
+// /fp:fast でも畳まれないビットパターン判定 (numeric_policy::isFinite と同じ方式)
+inline bool isFiniteBits(double x) noexcept
+{
+    return (std::bit_cast<std::uint64_t>(x) & 0x7FF0000000000000ULL) != 0x7FF0000000000000ULL;
+}
+
+inline std::uint64_t rotl(std::uint64_t x, int k) noexcept
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// Xoshiro256++ 1.0 (LatticeNoiseShaper と同じ生成器・同じ初期状態)
+inline std::uint64_t xoshiro256plusplus(std::uint64_t (&s)[4]) noexcept
+{
+    const std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+    const std::uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+inline double uniform(std::uint64_t (&s)[4]) noexcept
+{
+    return static_cast<double>(xoshiro256plusplus(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//==============================================================================
+// Scalar: 1 レーンずつ LatticeNoiseShaper::processSample と同じ式で計算する。
+// 積和はすべて明示的な FMA (ISA 間・コンパイラの縮約設定間で結果を一致させる)
+//==============================================================================
+void latticeBatchScalar(const double* coeffs, double* state, const double* input, const double* dither,
+                        int numSamples, double headroom, const LatticeBatchQuantizer& q, double* shaped) noexcept
+{
+    for (int n = 0; n < numSamples; ++n)
+    {
+        for (int lane = 0; lane < kScalarLanes; ++lane)
+        {
+            // 帰還: 4 タップ × 2 + 1 の加算順は computeFeedback と同じ
+            double t[4];
+            for (int j = 0; j < 4; ++j)
+            {
+                const double p = state[j * kStride + lane] * coeffs[j * kStride + lane];
+                t[j] = std::fma(state[(j + 4) * kStride + lane], coeffs[(j + 4) * kStride + lane], p);
+            }
+            const double feedback = std::fma(state[8 * kStride + lane], coeffs[8 * kStride + lane],
+                                             (t[0] + t[2]) + (t[1] + t[3]));
+
+            const double shapedInput = std::fma(input[n], headroom, feedback);
+            const double dithered = std::clamp(shapedInput, q.minValue, q.maxValue) + dither[n];
+            const double quantized = std::clamp(std::nearbyint(dithered * q.invScale), q.minQ, q.maxQ) * q.scale;
+
+            double error = quantized - shapedInput;
+            if (!isFiniteBits(error))
+                error = 0.0;
+            error = std::clamp(error, -q.errorLimit, q.errorLimit);
+
+            double forward = error;
+            for (int i = 0; i < kOrder; ++i)
+            {
+                const double c = coeffs[i * kStride + lane];
+                const double backward = state[i * kStride + lane];
+                const double nextForward = std::fma(c, backward, forward);
+                const double nextBackward = std::fma(c, forward, backward);
+                state[i * kStride + lane] = std::clamp(nextBackward, -kLatticeStateLimit, kLatticeStateLimit);
+                forward = nextForward;
+            }
+
+            shaped[static_cast<size_t>(n) * kStride + static_cast<size_t>(lane)] = quantized;
+        }
+    }
+
+    for (int i = 0; i < kOrder * kStride; ++i)
+        state[i] = std::clamp(state[i], -kBlockStateLimit, kBlockStateLimit);
+}
+
+//==============================================================================
+// AVX2: 4 レーン。状態 9 本はループ中レジスタに保持する
+//==============================================================================
+void latticeBatchAvx2(const double* coeffs, double* state, const double* input, const double* dither,
+                      int numSamples, double headroom, const LatticeBatchQuantizer& q, double* shaped) noexcept
+{
+    __m256d c[kOrder];
+    __m256d s[kOrder];
+    for (int i = 0; i < kOrder; ++i)
+    {
+        c[i] = _mm256_load_pd(coeffs + i * kStride);
+        s[i] = _mm256_load_pd(state + i * kStride);
+    }
+
+    const __m256d vHeadroom = _mm256_set1_pd(headroom);
+    const __m256d minValue = _mm256_set1_pd(q.minValue);
+    const __m256d maxValue = _mm256_set1_pd(q.maxValue);
+    const __m256d minQ = _mm256_set1_pd(q.minQ);
+    const __m256d maxQ = _mm256_set1_pd(q.maxQ);
+    const __m256d invScale = _mm256_set1_pd(q.invScale);
+    const __m256d scale = _mm256_set1_pd(q.scale);
+    const __m256d errLimit = _mm256_set1_pd(q.errorLimit);
+    const __m256d negErrLimit = _mm256_set1_pd(-q.errorLimit);
+    const __m256d stateLimit = _mm256_set1_pd(kLatticeStateLimit);
+    const __m256d negStateLimit = _mm256_set1_pd(-kLatticeStateLimit);
+    const __m256d infinity = _mm256_set1_pd(HUGE_VAL);
+    const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const __m256d t0 = _mm256_fmadd_pd(s[4], c[4], _mm256_mul_pd(s[0], c[0]));
+        const __m256d t1 = _mm256_fmadd_pd(s[5], c[5], _mm256_mul_pd(s[1], c[1]));
+        const __m256d t2 = _mm256_fmadd_pd(s[6], c[6], _mm256_mul_pd(s[2], c[2]));
+        const __m256d t3 = _mm256_fmadd_pd(s[7], c[7], _mm256_mul_pd(s[3], c[3]));
+        const __m256d feedback = _mm256_fmadd_pd(s[8], c[8], _mm256_add_pd(_mm256_add_pd(t0, t2), _mm256_add_pd(t1, t3)));
+
+        const __m256d shapedInput = _mm256_fmadd_pd(_mm256_set1_pd(input[n]), vHeadroom, feedback);
+        const __m256d dithered = _mm256_add_pd(_mm256_min_pd(_mm256_max_pd(shapedInput, minValue), maxValue),
+                                               _mm256_set1_pd(dither[n]));
+        const __m256d rounded = _mm256_round_pd(_mm256_mul_pd(dithered, invScale),
+                                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const __m256d quantized = _mm256_mul_pd(_mm256_min_pd(_mm256_max_pd(rounded, minQ), maxQ), scale);
+
+        __m256d error = _mm256_sub_pd(quantized, shapedInput);
+        const __m256d finite = _mm256_cmp_pd(_mm256_and_pd(error, absMask), infinity, _CMP_LT_OQ);
+        error = _mm256_and_pd(error, finite);
+        error = _mm256_min_pd(_mm256_max_pd(error, negErrLimit), errLimit);
+
+        __m256d forward = error;
+        for (int i = 0; i < kOrder; ++i)
+        {
+            const __m256d nextForward = _mm256_fmadd_pd(c[i], s[i], forward);
+            const __m256d nextBackward = _mm256_fmadd_pd(c[i], forward, s[i]);
+            s[i] = _mm256_min_pd(_mm256_max_pd(nextBackward, negStateLimit), stateLimit);
+            forward = nextForward;
+        }
+
+        _mm256_store_pd(shaped + static_cast<size_t>(n) * kStride, quantized);
+    }
+
+    const __m256d blockLimit = _mm256_set1_pd(kBlockStateLimit);
+    const __m256d negBlockLimit = _mm256_set1_pd(-kBlockStateLimit);
+    for (int i = 0; i < kOrder; ++i)
+        _mm256_store_pd(state + i * kStride, _mm256_min_pd(_mm256_max_pd(s[i], negBlockLimit), blockLimit));
+}
+
+//==============================================================================
+// AVX-512F: 8 レーン
+//==============================================================================
+CONVO_TARGET_AVX512 void latticeBatchAvx512(const double* coeffs, double* state, const double* input, const double* dither,
+                                            int numSamples, double headroom, const LatticeBatchQuantizer& q,
+                                            double* shaped) noexcept
+{
+    __m512d c[kOrder];
+    __m512d s[kOrder];
+    for (int i = 0; i < kOrder; ++i)
+    {
+        c[i] = _mm512_load_pd(coeffs + i * kStride);
+        s[i] = _mm512_load_pd(state + i * kStride);
+    }
+
+    const __m512d vHeadroom = _mm512_set1_pd(headroom);
+    const __m512d minValue = _mm512_set1_pd(q.minValue);
+    const __m512d maxValue = _mm512_set1_pd(q.maxValue);
+    const __m512d minQ = _mm512_set1_pd(q.minQ);
+    const __m512d maxQ = _mm512_set1_pd(q.maxQ);
+    const __m512d invScale = _mm512_set1_pd(q.invScale);
+    const __m512d scale = _mm512_set1_pd(q.scale);
+    const __m512d errLimit = _mm512_set1_pd(q.errorLimit);
+    const __m512d negErrLimit = _mm512_set1_pd(-q.errorLimit);
+    const __m512d stateLimit = _mm512_set1_pd(kLatticeStateLimit);
+    const __m512d negStateLimit = _mm512_set1_pd(-kLatticeStateLimit);
+    const __m512d infinity = _mm512_set1_pd(HUGE_VAL);
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const __m512d t0 = _mm512_fmadd_pd(s[4], c[4], _mm512_mul_pd(s[0], c[0]));
+        const __m512d t1 = _mm512_fmadd_pd(s[5], c[5], _mm512_mul_pd(s[1], c[1]));
+        const __m512d t2 = _mm512_fmadd_pd(s[6], c[6], _mm512_mul_pd(s[2], c[2]));
+        const __m512d t3 = _mm512_fmadd_pd(s[7], c[7], _mm512_mul_pd(s[3], c[3]));
+        const __m512d feedback = _mm512_fmadd_pd(s[8], c[8], _mm512_add_pd(_mm512_add_pd(t0, t2), _mm512_add_pd(t1, t3)));
+
+        const __m512d shapedInput = _mm512_fmadd_pd(_mm512_set1_pd(input[n]), vHeadroom, feedback);
+        const __m512d dithered = _mm512_add_pd(_mm512_min_pd(_mm512_max_pd(shapedInput, minValue), maxValue),
+                                               _mm512_set1_pd(dither[n]));
+        const __m512d rounded = _mm512_roundscale_pd(_mm512_mul_pd(dithered, invScale),
+                                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const __m512d quantized = _mm512_mul_pd(_mm512_min_pd(_mm512_max_pd(rounded, minQ), maxQ), scale);
+
+        __m512d error = _mm512_sub_pd(quantized, shapedInput);
+        const __mmask8 finite = _mm512_cmp_pd_mask(_mm512_abs_pd(error), infinity, _CMP_LT_OQ);
+        error = _mm512_maskz_mov_pd(finite, error);
+        error = _mm512_min_pd(_mm512_max_pd(error, negErrLimit), errLimit);
+
+        __m512d forward = error;
+        for (int i = 0; i < kOrder; ++i)
+        {
+            const __m512d nextForward = _mm512_fmadd_pd(c[i], s[i], forward);
+            const __m512d nextBackward = _mm512_fmadd_pd(c[i], forward, s[i]);
+            s[i] = _mm512_min_pd(_mm512_max_pd(nextBackward, negStateLimit), stateLimit);
+            forward = nextForward;
+        }
+
+        _mm512_store_pd(shaped + static_cast<size_t>(n) * kStride, quantized);
+    }
+
+    const __m512d blockLimit = _mm512_set1_pd(kBlockStateLimit);
+    const __m512d negBlockLimit = _mm512_set1_pd(-kBlockStateLimit);
+    for (int i = 0; i < kOrder; ++i)
+        _mm512_store_pd(state + i * kStride, _mm512_min_pd(_mm512_max_pd(s[i], negBlockLimit), blockLimit));
+}
+
+KernelIsa resolveIsa(KernelIsa isa) noexcept
+{
+    // kernelsFor と同じ規則で非対応 ISA を落とす
+    return kernelsFor(isa).isa;
+}
+
+} // namespace
+
+LatticeBatchKernel LatticeNoiseShaperBatch::kernelFor(KernelIsa isa) noexcept
+{
+    switch (resolveIsa(isa))
+    {
+        case KernelIsa::Avx512: return latticeBatchAvx512;
+        case KernelIsa::Avx2:   return latticeBatchAvx2;
+        case KernelIsa::Scalar:
+        default:                return latticeBatchScalar;
+    }
+}
+
+int LatticeNoiseShaperBatch::lanesFor(KernelIsa isa) noexcept
+{
+    return (resolveIsa(isa) == KernelIsa::Avx512) ? 8 : 4;
+}
+
+bool LatticeNoiseShaperBatch::prepare(int bitDepth, int maxSamples, KernelIsa isa) noexcept
+{
+    if (maxSamples <= 0)
+        return false;
+
+    if (maxSamples > capacity || !shapedScratch)
+    {
+        const size_t cap = static_cast<size_t>(maxSamples);
+        ditherScratch = makeAlignedArray_nothrow<double>(cap);
+        shapedScratch = makeAlignedArray_nothrow<double>(cap * kMaxLanes);
+        errorScratch = makeAlignedArray_nothrow<double>(cap * kMaxLanes * kNumChannels);
+        if (!ditherScratch || !shapedScratch || !errorScratch)
+        {
+            release();
+            return false;
+        }
+        capacity = maxSamples;
+    }
+
+    kernel = kernelFor(isa);
+    lanes = lanesFor(isa);
+
+    // LatticeNoiseShaper::prepare / quantize と同じ量子化パラメータ
+    currentBitDepth = (bitDepth <= 0) ? 0 : std::clamp(bitDepth, 1, 32);
+    quantizer = {};
+    if (currentBitDepth > 0)
+    {
+        quantizer.invScale = std::ldexp(1.0, currentBitDepth - 1);
+        quantizer.scale = 1.0 / quantizer.invScale;
+        quantizer.maxValue = 1.0 - quantizer.scale;
+        quantizer.minQ = -quantizer.invScale;
+        quantizer.maxQ = quantizer.invScale - 1.0;
+        quantizer.errorLimit = 2.0 * quantizer.scale;
+    }
+
+    std::memset(coeffs, 0, sizeof(coeffs));
+    reset();
+    return true;
+}
+
+void LatticeNoiseShaperBatch::release() noexcept
+{
+    ditherScratch.reset();
+    shapedScratch.reset();
+    errorScratch.reset();
+    capacity = 0;
+    kernel = nullptr;
+    lanes = 0;
+}
+
+void LatticeNoiseShaperBatch::setLaneCoefficients(int lane, const double* newCoeffs) noexcept
+{
+    if (lane < 0 || lane >= kMaxLanes || newCoeffs == nullptr)
+        return;
+    for (int i = 0; i < kOrder; ++i)
+        coeffs[i * kMaxLanes + lane] = newCoeffs[i];
+}
+
+void LatticeNoiseShaperBatch::clearLaneCoefficients(int lane) noexcept
+{
+    if (lane < 0 || lane >= kMaxLanes)
+        return;
+    for (int i = 0; i < kOrder; ++i)
+        coeffs[i * kMaxLanes + lane] = 0.0;
+}
+
+void LatticeNoiseShaperBatch::reset() noexcept
+{
+    std::memset(states, 0, sizeof(states));
+}
+
+void LatticeNoiseShaperBatch::fillDither(int channel, int numSamples) noexcept
+{
+    // quantize() の (u1 + u2 − 1)·scale と同じ TPDF
+    double* dst = ditherScratch.get();
+    auto& rng = rngState[channel];
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const double u1 = uniform(rng);
+        const double u2 = uniform(rng);
+        dst[n] = (u1 + u2 - 1.0) * quantizer.scale;
+    }
+}
+
+void LatticeNoiseShaperBatch::processChannel(int channel, const double* input, int numSamples, double headroom) noexcept
+{
+    if (!isReady() || input == nullptr || channel < 0 || channel >= kNumChannels)
+        return;
+    numSamples = std::min(numSamples, capacity);
+    if (numSamples <= 0)
+        return;
+
+    const size_t cap = static_cast<size_t>(capacity);
+    double* errorBase = errorScratch.get() + static_cast<size_t>(channel) * kMaxLanes * cap;
+
+    if (currentBitDepth <= 0)
+    {
+        // 量子化なし: 出力は input·headroom そのもので誤差 0
+        std::memset(errorBase, 0, sizeof(double) * kMaxLanes * cap);
+        return;
+    }
+
+    fillDither(channel, numSamples);
+    kernel(coeffs, states[channel], input, ditherScratch.get(), numSamples, headroom, quantizer, shapedScratch.get());
+
+    // [n][lane] → レーン別の誤差信号
+    const double* shaped = shapedScratch.get();
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        double* __restrict dst = errorBase + static_cast<size_t>(lane) * cap;
+        for (int n = 0; n < numSamples; ++n)
+            dst[n] = shaped[static_cast<size_t>(n) * kMaxLanes + static_cast<size_t>(lane)] - (input[n] * headroom);
+    }
+}
+
+} // namespace convo::dsp
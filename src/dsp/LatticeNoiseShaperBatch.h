@@ -0,0 +1,103 @@
+#pragma once
+
+#include "AlignedAllocation.h"
+#include "dsp/KernelDispatch.h"
+
+#include <cstdint>
+
+//==============================================================================
+// LatticeNoiseShaperBatch — 候補並列 (SIMD レーン) の 9 次格子ノイズシェーパー
+//
+//   NoiseShaperLearner の候補評価専用。格子再帰は時間方向に直列だが候補間は
+//   独立なので、候補係数を SIMD レーンに並べて 1 本の再帰で同時に回す。
+//     Scalar — 参照実装 (レーン数 4)
+//     Avx2   — 4 レーン (__m256d)
+//     Avx512 — 8 レーン (__m512d、CONVO_TARGET_AVX512)
+//   再帰式・量子化・クランプは LatticeNoiseShaper::processSample と同じ順序で計算する。
+//   積和は全 ISA で明示的な FMA とし、ISA 間でビット一致させる (LatticeNoiseShaper との
+//   差は丸め 1 回分の違いのみ)。
+//
+//   TPDF ディザは全レーン共通 (同一サンプルに同じ乱数)。候補間の比較から
+//   ディザ実現値の差が消えるため、同一バッチ内の順位付けの分散が下がる。
+//
+//   レイアウト: 係数・状態は [kOrder][kMaxLanes] (tap-major、レーン連続)。
+//   ワーカースレッド専用 (Audio Thread からは使わない)。
+//==============================================================================
+
+namespace convo::dsp {
+
+struct LatticeBatchQuantizer
+{
+    double scale = 1.0;       // 1 LSB
+    double invScale = 1.0;
+    double minValue = -1.0;   // ディザ前クランプ
+    double maxValue = 1.0;
+    double minQ = -1.0;       // 量子化後クランプ (LSB 単位)
+    double maxQ = 1.0;
+    double errorLimit = 2.0;  // 誤差フィードバックのクランプ (±2 LSB)
+};
+
+// 1 チャンネル分の格子再帰を numLanes (カーネル固有) レーン同時に実行する。
+// coeffs / state: [kOrder][kMaxLanes]、dither: スケール済み TPDF (numSamples 要素)、
+// shaped: [numSamples][kMaxLanes] (量子化後の出力)。bitDepth > 0 前提
+using LatticeBatchKernel = void (*)(const double* coeffs, double* state, const double* input, const double* dither,
+                                    int numSamples, double headroom, const LatticeBatchQuantizer& quantizer,
+                                    double* shaped) noexcept;
+
+class LatticeNoiseShaperBatch
+{
+public:
+    static constexpr int kOrder = 9;
+    static constexpr int kNumChannels = 2;
+    static constexpr int kMaxLanes = 8;
+
+    // 指定 ISA のカーネルとレーン数 (非対応 ISA は対応する最上位へ落とす)
+    [[nodiscard]] static LatticeBatchKernel kernelFor(KernelIsa isa) noexcept;
+    [[nodiscard]] static int lanesFor(KernelIsa isa) noexcept;
+
+    LatticeNoiseShaperBatch() = default;
+    LatticeNoiseShaperBatch(const LatticeNoiseShaperBatch&) = delete;
+    LatticeNoiseShaperBatch& operator=(const LatticeNoiseShaperBatch&) = delete;
+
+    // ワーカースレッドで呼ぶ。作業領域は maxSamples が増えたときだけ再確保する。
+    // 係数は全レーン 0、状態もクリアされる。確保失敗時は false
+    bool prepare(int bitDepth, int maxSamples, KernelIsa isa = activeKernels().isa) noexcept;
+    void release() noexcept;
+    [[nodiscard]] bool isReady() const noexcept { return kernel != nullptr && shapedScratch; }
+    [[nodiscard]] int laneCount() const noexcept { return lanes; }
+
+    // 係数は呼び出し側で LatticeNoiseShaper::clampCoeff 済みであること
+    void setLaneCoefficients(int lane, const double* newCoeffs) noexcept;
+    void clearLaneCoefficients(int lane) noexcept;
+
+    // 格子状態のみクリア (ディザ乱数列は継続)
+    void reset() noexcept;
+
+    // input を全レーンで整形し、誤差 shaped − input·headroom をレーン別バッファへ書く
+    void processChannel(int channel, const double* input, int numSamples, double headroom) noexcept;
+    [[nodiscard]] const double* laneError(int channel, int lane) const noexcept
+    {
+        return errorScratch.get() + (static_cast<size_t>(channel) * kMaxLanes + static_cast<size_t>(lane))
+                                        * static_cast<size_t>(capacity);
+    }
+
+private:
+    void fillDither(int channel, int numSamples) noexcept;
+
+    alignas(64) double coeffs[kOrder * kMaxLanes] = {};
+    alignas(64) double states[kNumChannels][kOrder * kMaxLanes] = {};
+    std::uint64_t rngState[kNumChannels][4] = {
+        { 0x123456789ABCDEF0ULL, 0xFEDCBA9876543210ULL, 0x0123456789ABCDEFULL, 0xEFCDAB8967452301ULL },
+        { 0x89ABCDEF01234567ULL, 0x76543210FEDCBA98ULL, 0xABCDEF0123456789ULL, 0x67452301EFCDAB89ULL }
+    };
+    LatticeBatchQuantizer quantizer;
+    LatticeBatchKernel kernel = nullptr;
+    int lanes = 0;
+    int currentBitDepth = 0;
+    int capacity = 0;
+    ScopedAlignedPtr<double> ditherScratch;   // capacity
+    ScopedAlignedPtr<double> shapedScratch;   // capacity × kMaxLanes
+    ScopedAlignedPtr<double> errorScratch;    // kNumChannels × kMaxLanes × capacity
+};
+
+} // namespace convo::dsp
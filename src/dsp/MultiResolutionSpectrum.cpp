@@ -0,0 +1,233 @@
+//==============================================================================
+// MultiResolutionSpectrum.cpp
+// オクターブ間引き + 帯域ごとの小さな FFT による多重解像度スペクトル
+//==============================================================================
+
+#include "dsp/MultiResolutionSpectrum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace convo::dsp {
+
+bool MultiResolutionSpectrum::prepare(double sampleRate, const float* barFrequencies, int numBars) noexcept
+{
+    release();
+    if (!(sampleRate > 0.0) || barFrequencies == nullptr || numBars <= 0 || numBars > kMaxBars)
+        return false;
+
+    int bands = 1;
+    while (bands < kMaxBands && sampleRate / static_cast<double>(1 << bands) >= kMinBandRate)
+        ++bands;
+
+    ScopedDftiDescriptor localDfti;
+    if (DftiCreateDescriptor(localDfti.put(), DFTI_DOUBLE, DFTI_REAL, 1, kFftPoints) != DFTI_NO_ERROR
+        || DftiSetValue(localDfti.get(), DFTI_PLACEMENT, DFTI_NOT_INPLACE) != DFTI_NO_ERROR
+        || DftiSetValue(localDfti.get(), DFTI_CONJUGATE_EVEN_STORAGE, DFTI_COMPLEX_COMPLEX) != DFTI_NO_ERROR
+        || DftiCommitDescriptor(localDfti.get()) != DFTI_NO_ERROR)
+        return false;
+
+    window = makeAlignedArray_nothrow<double>(kFftPoints);
+    windowed = makeAlignedArray_nothrow<double>(kFftPoints);
+    spectrum = makeAlignedArray_nothrow<double>(2 * kNumBins);
+    inputScratch = makeAlignedArray_nothrow<double>(kMaxInputSamples);
+    bool ok = window && windowed && spectrum && inputScratch;
+    for (int k = 0; ok && k < bands; ++k)
+    {
+        timeDomain[k] = makeAlignedArray_nothrow<double>(kFftPoints);
+        bandDb[k] = makeAlignedArray_nothrow<float>(kNumBins);
+        ok = timeDomain[k] && bandDb[k];
+        // 帯域 k への入力は多くても kMaxInputSamples / 2^(k-1) (持ち越しを含めても超えない)
+        if (ok && k > 0)
+            ok = decimators[k].prepare(HalfBandCascade::Mode::Decimate, 2, sampleRate / static_cast<double>(1 << (k - 1)),
+                                       kPassbandRatio * sampleRate / static_cast<double>(1 << k), kAttenuationDb,
+                                       (kMaxInputSamples >> (k - 1)) + 1);
+    }
+    if (!ok)
+    {
+        release();
+        return false;
+    }
+
+    // JUCE の WindowingFunction (hann, normalise) と同じ対称 Hann を平均 1 に正規化
+    double sum = 0.0;
+    for (int i = 0; i < kFftPoints; ++i)
+    {
+        window[i] = 0.5 - 0.5 * std::cos(2.0 * std::numbers::pi * i / (kFftPoints - 1));
+        sum += window[i];
+    }
+    const double normalise = kFftPoints / sum;
+    for (int i = 0; i < kFftPoints; ++i)
+        window[i] *= normalise;
+
+    // 各バーは通過帯域に収まる最も低い帯域 (= 最も細かいビン間隔) から読む。バーの受け持ち範囲は
+    // 隣のバーとの幾何平均までで、上端は帯域の通過帯域で切る (その先は間引きの遷移帯)
+    const double nyquist = 0.5 * sampleRate;
+    auto barFreq = [&](int bar) {
+        return std::clamp(static_cast<double>(barFrequencies[bar]), 0.0, nyquist);
+    };
+    for (int bar = 0; bar < numBars; ++bar)
+    {
+        const double freq = barFreq(bar);
+        int band = 0;
+        for (int k = bands - 1; k > 0; --k)
+        {
+            if (freq <= kPassbandRatio * sampleRate / static_cast<double>(1 << k))
+            {
+                band = k;
+                break;
+            }
+        }
+        const double bandRate = sampleRate / static_cast<double>(1 << band);
+        const double limit = (band == 0) ? nyquist : kPassbandRatio * bandRate;
+        const double lower = (bar > 0) ? std::sqrt(barFreq(bar - 1) * freq) : freq;
+        const double upper = std::min(limit, (bar + 1 < numBars) ? std::sqrt(freq * barFreq(bar + 1)) : freq);
+        const double binsPerHz = kFftPoints / bandRate;
+
+        auto& map = barMap[static_cast<size_t>(bar)];
+        map.band = static_cast<std::uint8_t>(band);
+        map.bin = static_cast<float>(std::clamp(freq * binsPerHz, 0.0, static_cast<double>(kNumBins - 1)));
+        map.firstBin = static_cast<std::int16_t>(std::clamp(std::ceil(lower * binsPerHz), 0.0, static_cast<double>(kNumBins - 1)));
+        map.lastBin = static_cast<std::int16_t>(std::clamp(std::floor(upper * binsPerHz), -1.0, static_cast<double>(kNumBins - 1)));
+        bandUsed[band] = true;
+    }
+
+    fft.reset(localDfti.release());
+    rate = sampleRate;
+    numBands = bands;
+    numBarsUsed = numBars;
+    reset();
+    return true;
+}
+
+void MultiResolutionSpectrum::release() noexcept
+{
+    for (int k = 0; k < kMaxBands; ++k)
+    {
+        decimators[k].release();
+        timeDomain[k].reset();
+        bandDb[k].reset();
+        freshSamples[k] = 0;
+        bandUsed[k] = false;
+    }
+    fft.reset();
+    window.reset();
+    windowed.reset();
+    spectrum.reset();
+    inputScratch.reset();
+    rate = 0.0;
+    numBands = 0;
+    numBarsUsed = 0;
+}
+
+void MultiResolutionSpectrum::reset() noexcept
+{
+    for (int k = 0; k < numBands; ++k)
+    {
+        decimators[k].reset();
+        std::fill_n(timeDomain[k].get(), kFftPoints, 0.0);
+        std::fill_n(bandDb[k].get(), kNumBins, kFloorDb);
+        freshSamples[k] = 0;
+    }
+}
+
+void MultiResolutionSpectrum::push(const float* input, int numSamples) noexcept
+{
+    if (numBands == 0 || input == nullptr)
+        return;
+
+    double* scratch = inputScratch.get();
+    while (numSamples > 0)
+    {
+        const int n = std::min(numSamples, kMaxInputSamples);
+        for (int i = 0; i < n; ++i)
+            scratch[i] = std::isfinite(input[i]) ? static_cast<double>(input[i]) : 0.0;
+        input += n;
+        numSamples -= n;
+
+        // decimate() は入力を自分の履歴へ写してから書くので、同じ領域へ順に下ろしていける
+        int count = n;
+        appendToBand(0, scratch, count);
+        for (int k = 1; k < numBands && count > 0; ++k)
+        {
+            count = decimators[k].decimate(scratch, count, scratch);
+            appendToBand(k, scratch, count);
+        }
+    }
+}
+
+void MultiResolutionSpectrum::appendToBand(int band, const double* samples, int count) noexcept
+{
+    if (count <= 0)
+        return;
+    double* line = timeDomain[band].get();
+    if (count >= kFftPoints)
+    {
+        std::memcpy(line, samples + (count - kFftPoints), kFftPoints * sizeof(double));
+    }
+    else
+    {
+        std::memmove(line, line + count, static_cast<size_t>(kFftPoints - count) * sizeof(double));
+        std::memcpy(line + (kFftPoints - count), samples, static_cast<size_t>(count) * sizeof(double));
+    }
+    freshSamples[band] = std::min(freshSamples[band] + count, kFftPoints);
+}
+
+bool MultiResolutionSpectrum::transformBand(int band) noexcept
+{
+    const double* line = timeDomain[band].get();
+    double* in = windowed.get();
+    double* out = spectrum.get();
+    for (int i = 0; i < kFftPoints; ++i)
+        in[i] = line[i] * window[i];
+    if (DftiComputeForward(fft.get(), in, out) != DFTI_NO_ERROR)
+        return false;
+
+    constexpr double scale = 4.0 / kFftPoints;
+    float* db = bandDb[band].get();
+    for (int b = 0; b < kNumBins; ++b)
+    {
+        const double re = out[2 * b];
+        const double im = out[2 * b + 1];
+        const float magnitude = static_cast<float>(std::sqrt(re * re + im * im) * scale);
+        db[b] = (magnitude > kFloorMagnitude) ? 20.0f * std::log10(magnitude) : kFloorDb;
+    }
+    return true;
+}
+
+bool MultiResolutionSpectrum::analyze(float* barDb) noexcept
+{
+    if (numBands == 0 || barDb == nullptr)
+        return false;
+
+    for (int k = 0; k < numBands; ++k)
+    {
+        if (!bandUsed[k] || freshSamples[k] < kHopSamples)
+            continue;
+        if (!transformBand(k))
+            return false;
+        freshSamples[k] = 0;
+    }
+
+    // 受け持ち範囲にビンがあればその最大 (細い正弦波がバーの間に落ちても見える)、
+    // なければ (ビン間隔がバー間隔より粗い高域) バー周波数で隣接ビンを補間する
+    for (int bar = 0; bar < numBarsUsed; ++bar)
+    {
+        const auto& map = barMap[static_cast<size_t>(bar)];
+        const float* db = bandDb[map.band].get();
+        if (map.firstBin <= map.lastBin)
+        {
+            barDb[bar] = *std::max_element(db + map.firstBin, db + map.lastBin + 1);
+            continue;
+        }
+        const int idx0 = static_cast<int>(map.bin);
+        const int idx1 = std::min(idx0 + 1, kNumBins - 1);
+        const float frac = map.bin - static_cast<float>(idx0);
+        barDb[bar] = db[idx0] * (1.0f - frac) + db[idx1] * frac;
+    }
+    return true;
+}
+
+} // namespace convo::dsp
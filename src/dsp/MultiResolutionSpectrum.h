@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "AlignedAllocation.h"
+#include "DftiHandle.h"
+#include "dsp/HalfBandCascade.h"
+
+//==============================================================================
+// MultiResolutionSpectrum — オクターブ間引きによる多重解像度 (定 Q 風) スペクトル
+//
+//   SpectrumAnalyzerWorker が使う。入力を 2 倍ハーフバンド間引きで 1 オクターブずつ下げた帯域
+//   k = 0..K-1 (レート r_k = fs / 2^k) を作り、各帯域で同じ kFftPoints 点の FFT を回す。
+//   帯域 k のビン間隔は r_k / kFftPoints なので、最下帯域は kFftPoints·2^(K-1) 点の FFT と同じ
+//   分解能になる。K は r_{K-1} が kMinBandRate を下回らない最大値 (48 kHz で 6 帯域 = 32768 点相当、
+//   192 kHz で 8 帯域)。
+//
+//   各表示バーは、その周波数を通過帯域 (kPassbandRatio·r_k、帯域 0 は Nyquist) に含む最も低い帯域、
+//   つまり最も細かいビン間隔の帯域から、隣のバーとの境界までに入るビンの最大値を読む。帯域 k への間引き段は passband = kPassbandRatio·r_k、
+//   除去量 kAttenuationDb で設計するので、折り返しは通過帯域の外 (kPassbandRatio·r_k 〜 r_k / 2) にしか
+//   落ちない。低い帯域ほど窓が長く、間引きの遅延も積み重なるため、低域の表示は時間方向に遅れて滑らかになる。
+//
+//   FFT は帯域ごとに「前回から kHopSamples 以上の新しいサンプルが溜まった」ときだけやり直すので、
+//   1 フレームの FFT は高々 K 回で、低い帯域ほど稀になる (48 kHz / 60 fps なら帯域 3 以下は数フレームに 1 回)。
+//   どのバーも読まない帯域は FFT を省く (間引きは次の帯域のために続ける)。
+//
+//   レベルの較正は旧実装 (平均 1 に正規化した Hann 窓、|X|·4/N) と同じ。
+//   prepare() だけが確保する。push() / analyze() / reset() は確保しない。呼び出しは 1 スレッドから。JUCE 非依存。
+//==============================================================================
+
+namespace convo::dsp {
+
+class MultiResolutionSpectrum
+{
+public:
+    static constexpr int kFftPoints = 1024;
+    static constexpr int kNumBins = kFftPoints / 2 + 1;
+    static constexpr int kHopSamples = kFftPoints / 4;      // 帯域ごとの FFT のやり直し間隔 (帯域レートのサンプル)
+    static constexpr int kMaxBands = 10;                    // 768 kHz でも kMinBandRate まで下ろせる
+    static constexpr int kMaxBars = 256;
+    static constexpr int kMaxInputSamples = 4096;           // push() は内部でこの長さに区切る
+    static constexpr double kMinBandRate = 1000.0;          // 最下帯域の窓が 1 秒を超えない範囲
+    static constexpr double kPassbandRatio = 0.4;           // 帯域 k (k >= 1) が読める上限 / r_k
+    static constexpr double kAttenuationDb = 100.0;         // 表示範囲 (-80〜+20 dB) 全体で折り返しが見えない
+    static constexpr float kFloorDb = -100.0f;              // 振幅 kFloorMagnitude 以下のビン
+
+    MultiResolutionSpectrum() = default;
+    MultiResolutionSpectrum(const MultiResolutionSpectrum&) = delete;
+    MultiResolutionSpectrum& operator=(const MultiResolutionSpectrum&) = delete;
+
+    // 確保あり。barFrequencies: 各表示バーの周波数 (Hz)。範囲外・FFT 準備や確保の失敗時は false
+    bool prepare(double sampleRate, const float* barFrequencies, int numBars) noexcept;
+    void release() noexcept;
+    // 全帯域の履歴・間引き状態を捨てて無音から数え直す
+    void reset() noexcept;
+
+    [[nodiscard]] bool isReady() const noexcept { return numBands > 0; }
+    [[nodiscard]] double getSampleRate() const noexcept { return rate; }
+    [[nodiscard]] int getNumBands() const noexcept { return numBands; }
+    [[nodiscard]] double getBandRate(int band) const noexcept { return rate / static_cast<double>(1 << band); }
+    [[nodiscard]] int getBandForBar(int bar) const noexcept
+    {
+        return (bar >= 0 && bar < numBarsUsed) ? barMap[static_cast<size_t>(bar)].band : -1;
+    }
+    // 最下帯域の窓が覆うフルレートのサンプル数 (全帯域が入れ替わるまでの長さ)
+    [[nodiscard]] int getLongestWindowSamples() const noexcept
+    {
+        return (numBands > 0) ? (kFftPoints << (numBands - 1)) : 0;
+    }
+
+    // フルレートの入力を積む。非有限値は 0 として扱う
+    void push(const float* input, int numSamples) noexcept;
+
+    // 新しいサンプルが kHopSamples 溜まった帯域だけ FFT をやり直し、各バーの dB (kFloorDb 以上) を
+    // barDb[numBars] へ書く。FFT が失敗したら false (barDb は書きかけ)
+    bool analyze(float* barDb) noexcept;
+
+private:
+    static constexpr float kFloorMagnitude = 1.0e-5f;   // = kFloorDb
+
+    void appendToBand(int band, const double* samples, int count) noexcept;
+    bool transformBand(int band) noexcept;
+
+    ScopedDftiDescriptor fft;                        // 実数 FFT (double, CCE)。全帯域で共有
+    HalfBandCascade decimators[kMaxBands];           // decimators[k]: 帯域 k-1 → k (k >= 1)
+    ScopedAlignedPtr<double> timeDomain[kMaxBands];  // 帯域ごとの直近 kFftPoints サンプル
+    ScopedAlignedPtr<float> bandDb[kMaxBands];       // 帯域ごとの直近の FFT 結果 (dB × kNumBins)
+    ScopedAlignedPtr<double> window;                 // 平均 1 の Hann 窓
+    ScopedAlignedPtr<double> windowed;
+    ScopedAlignedPtr<double> spectrum;               // CCE (re, im) × kNumBins
+    ScopedAlignedPtr<double> inputScratch;           // kMaxInputSamples。間引きは in-place
+    int freshSamples[kMaxBands] {};                  // 前回の FFT 以降に積んだサンプル数 (kFftPoints で頭打ち)
+    bool bandUsed[kMaxBands] {};
+    struct BarMap
+    {
+        float bin = 0.0f;            // バー周波数の帯域内ビン位置 (補間用の小数)
+        std::int16_t firstBin = 0;   // 受け持ち範囲のビン [firstBin, lastBin] (空なら補間)
+        std::int16_t lastBin = -1;
+        std::uint8_t band = 0;
+    };
+    std::array<BarMap, kMaxBars> barMap {};
+    double rate = 0.0;
+    int numBands = 0;
+    int numBarsUsed = 0;
+};
+
+} // namespace convo::dsp
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <immintrin.h>
+#include <limits>
+
+//==============================================================================
+// StereoLaneNoiseShaper — L/R を 1 本の誤差フィードバック再帰の SIMD レーンに載せるカーネル
+//
+//   LatticeNoiseShaper (9 次格子) と PsychoacousticDither (12 次 FIR 誤差フィードバック) は
+//   1 サンプルごとに「フィードバック和 → 量子化 → 誤差 → 状態更新」が直列に依存する。
+//   チャンネル間は独立なので、__m128d の lane 0 = L / lane 1 = R に並べて 1 本の再帰で回し、
+//   命令数と状態のロード/ストアを半分にする。状態はブロック中レジスタに置き、
+//   ブロック末尾で各クラスのチャンネル別配列へ書き戻す。
+//
+//   演算順序は各クラスの旧ステレオループ (チャンネルごとのスカラー再帰) と同じにしてあり、
+//   同じ乱数列に対してビット一致する (tests/StereoLaneNoiseShaperTests.cpp)。
+//   ディザはチャンネルごとの乱数源から呼び出し側が供給する (nextDither(channel) → スケール済み値)。
+//
+//   前提: /arch:AVX2 ビルド (SSE4.1 の丸めと FMA3 を使う)。積和は組み込み関数で明示しているため
+//   /fp:fast の縮約の影響を受けない。Audio Thread から呼ぶ。JUCE 非依存。
+//==============================================================================
+
+namespace convo::dsp {
+
+namespace stereo_lanes_detail {
+
+inline __m128d loadPair(const double* left, const double* right, int index) noexcept
+{
+    return _mm_set_pd(right[index], left[index]);
+}
+
+inline void storePair(double* left, double* right, int index, __m128d value) noexcept
+{
+    _mm_storel_pd(left + index, value);
+    _mm_storeh_pd(right + index, value);
+}
+
+// std::clamp(v, lo, hi) と同じ比較順 (NaN はそのまま通す)
+inline __m128d clampPair(__m128d v, __m128d lo, __m128d hi) noexcept
+{
+    return _mm_min_pd(hi, _mm_max_pd(lo, v));
+}
+
+} // namespace stereo_lanes_detail
+
+//------------------------------------------------------------------------------
+// 9 次格子ノイズシェーパー (LatticeNoiseShaper::processSample と同じ式)
+//------------------------------------------------------------------------------
+struct LatticeLaneQuantizer
+{
+    double scale = 1.0;       // 1 LSB
+    double invScale = 1.0;
+    double minValue = -1.0;   // ディザ前クランプ
+    double maxValue = 1.0;
+    double minQ = -1.0;       // 量子化後クランプ (LSB 単位)
+    double maxQ = 1.0;
+    double errorLimit = 2.0;  // 誤差フィードバックのクランプ (±2 LSB)
+    double stateLimit = 2.0;  // 格子後方状態のクランプ
+};
+
+// coeffs: [9]、stateL / stateR: [9] (各チャンネルの後方状態、処理後に書き戻す)。
+// nextDither(channel) は (u1 + u2 - 1) * scale を返すこと
+template <typename DitherSource>
+inline void processLatticeStereoLanes(const double* coeffs, double* stateL, double* stateR,
+                                      double* dataL, double* dataR, int numSamples, double headroom,
+                                      const LatticeLaneQuantizer& quantizer, DitherSource&& nextDither) noexcept
+{
+    using namespace stereo_lanes_detail;
+    constexpr int kOrder = 9;
+
+    __m128d state[kOrder];
+    __m128d c[kOrder];
+    for (int t = 0; t < kOrder; ++t)
+    {
+        state[t] = loadPair(stateL, stateR, t);
+        c[t] = _mm_set1_pd(coeffs[t]);
+    }
+
+    const __m128d vHeadroom = _mm_set1_pd(headroom);
+    const __m128d vScale = _mm_set1_pd(quantizer.scale);
+    const __m128d vInvScale = _mm_set1_pd(quantizer.invScale);
+    const __m128d vMinValue = _mm_set1_pd(quantizer.minValue);
+    const __m128d vMaxValue = _mm_set1_pd(quantizer.maxValue);
+    const __m128d vMinQ = _mm_set1_pd(quantizer.minQ);
+    const __m128d vMaxQ = _mm_set1_pd(quantizer.maxQ);
+    const __m128d vErrorLimit = _mm_set1_pd(quantizer.errorLimit);
+    const __m128d vNegErrorLimit = _mm_set1_pd(-quantizer.errorLimit);
+    const __m128d vStateLimit = _mm_set1_pd(quantizer.stateLimit);
+    const __m128d vNegStateLimit = _mm_set1_pd(-quantizer.stateLimit);
+    const __m128d vSignMask = _mm_set1_pd(-0.0);
+    const __m128d vInf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // フィードバック和: 旧 computeFeedback の 4 レーン積和 + 水平加算と同じ結合順
+        const __m128d q0 = _mm_fmadd_pd(state[4], c[4], _mm_mul_pd(state[0], c[0]));
+        const __m128d q1 = _mm_fmadd_pd(state[5], c[5], _mm_mul_pd(state[1], c[1]));
+        const __m128d q2 = _mm_fmadd_pd(state[6], c[6], _mm_mul_pd(state[2], c[2]));
+        const __m128d q3 = _mm_fmadd_pd(state[7], c[7], _mm_mul_pd(state[3], c[3]));
+        __m128d feedback = _mm_add_pd(_mm_add_pd(q0, q2), _mm_add_pd(q1, q3));
+        feedback = _mm_add_pd(feedback, _mm_mul_pd(state[8], c[8]));
+
+        const __m128d shaped = _mm_add_pd(_mm_mul_pd(loadPair(dataL, dataR, i), vHeadroom), feedback);
+
+        // quantize: クランプ → TPDF → 丸め → LSB 単位クランプ
+        __m128d value = _mm_min_pd(vMaxValue, _mm_max_pd(vMinValue, shaped));
+        const double ditherL = nextDither(0);
+        const double ditherR = nextDither(1);
+        value = _mm_add_pd(value, _mm_set_pd(ditherR, ditherL));
+        __m128d rounded = _mm_round_pd(_mm_mul_pd(value, vInvScale), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        rounded = clampPair(rounded, vMinQ, vMaxQ);
+        const __m128d quantized = _mm_mul_pd(rounded, vScale);
+
+        // 誤差: 非有限は 0 (replaceNonFiniteWithZero)、±errorLimit でクランプ
+        __m128d error = _mm_sub_pd(quantized, shaped);
+        error = _mm_and_pd(error, _mm_cmp_pd(_mm_andnot_pd(vSignMask, error), vInf, _CMP_LT_OQ));
+        error = clampPair(error, vNegErrorLimit, vErrorLimit);
+
+        // 格子の後方状態を更新 (旧 advanceState と同じ式・順序)
+        __m128d forward = error;
+        for (int t = 0; t < kOrder; ++t)
+        {
+            const __m128d backward = state[t];
+            const __m128d nextForward = _mm_add_pd(forward, _mm_mul_pd(c[t], backward));
+            const __m128d nextBackward = _mm_add_pd(_mm_mul_pd(c[t], forward), backward);
+            state[t] = clampPair(nextBackward, vNegStateLimit, vStateLimit);
+            forward = nextForward;
+        }
+
+        storePair(dataL, dataR, i, quantized);
+    }
+
+    for (int t = 0; t < kOrder; ++t)
+        storePair(stateL, stateR, t, state[t]);
+}
+
+//------------------------------------------------------------------------------
+// Order 次 FIR 誤差フィードバック + シフトレジスタ (PsychoacousticDither と同じ式)
+//------------------------------------------------------------------------------
+// coeffs: [Order]、zL / zR: [Order] (z[0] が最新の誤差)。nextDither(channel) はスケール済み TPDF。
+// 誤差は |e| < denormThreshold で 0 に落とす (killDenormal)
+template <int Order, typename DitherSource>
+inline void processErrorFeedbackStereoLanes(const double* coeffs, double* zL, double* zR,
+                                            double* dataL, double* dataR, int numSamples, double headroom,
+                                            double scale, double invScale, double denormThreshold,
+                                            DitherSource&& nextDither) noexcept
+{
+    using namespace stereo_lanes_detail;
+
+    __m128d z[Order];
+    __m128d c[Order];
+    for (int t = 0; t < Order; ++t)
+    {
+        z[t] = loadPair(zL, zR, t);
+        c[t] = _mm_set1_pd(coeffs[t]);
+    }
+
+    const __m128d vHeadroom = _mm_set1_pd(headroom);
+    const __m128d vScale = _mm_set1_pd(scale);
+    const __m128d vInvScale = _mm_set1_pd(invScale);
+    const __m128d vDenorm = _mm_set1_pd(denormThreshold);
+    const __m128d vSignMask = _mm_set1_pd(-0.0);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // 旧実装の c0*z0 + c1*z1 + ... (左から順に加算) と同じ結合順
+        __m128d shapedError = _mm_mul_pd(c[0], z[0]);
+        for (int t = 1; t < Order; ++t)
+            shapedError = _mm_add_pd(shapedError, _mm_mul_pd(c[t], z[t]));
+
+        const double ditherL = nextDither(0);
+        const double ditherR = nextDither(1);
+        const __m128d tmp = _mm_add_pd(_mm_add_pd(_mm_mul_pd(loadPair(dataL, dataR, i), vHeadroom),
+                                                  _mm_set_pd(ditherR, ditherL)),
+                                       shapedError);
+
+        const __m128d rounded = _mm_round_pd(_mm_mul_pd(tmp, vInvScale), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        const __m128d quantized = _mm_mul_pd(rounded, vScale);
+
+        // シフトレジスタ: レジスタのリネームだけで済む (展開後は mov のみ)
+        const __m128d error = _mm_sub_pd(tmp, quantized);
+        const __m128d isDenormal = _mm_cmp_pd(_mm_andnot_pd(vSignMask, error), vDenorm, _CMP_LT_OQ);
+        for (int t = Order - 1; t > 0; --t)
+            z[t] = z[t - 1];
+        z[0] = _mm_andnot_pd(isDenormal, error);
+
+        storePair(dataL, dataR, i, quantized);
+    }
+
+    for (int t = 0; t < Order; ++t)
+        storePair(zL, zR, t, z[t]);
+}
+
+} // namespace convo::dsp
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <immintrin.h>
+#include <cmath>
 #include <cstdint>
 #include <type_traits>
 
+#include "dsp/IsaTarget.h"
+
 //==============================================================================
 // FastTanhApprox — Tanh 近似の共通ユーティリティ
 //
@@ -15,6 +18,7 @@
 // 使用方法:
 //   double y = convo::dsp::fastTanh<SoftClipPolicy>(x);
 //   __m128d yv = convo::dsp::fastTanhV128<EQSaturationPolicy>(xv);
+//   __m512d zv = convo::dsp::fastTanhV512<SoftClipPadéPolicy>(xv);  // CONVO_TARGET_AVX512 関数内のみ
 //
 //==============================================================================
 
@@ -53,6 +57,17 @@ struct DefaultFastTanhPolicy {
         const auto den = _mm_add_pd(vTwentySeven, _mm_mul_pd(vNine, x2));
         return _mm_div_pd(num, den);
     }
+
+#if defined(__AVX2__) || defined(__FMA__)
+    // AVX2 版: SSE2 版と同じ演算順 (EQ Parallel バンクの 4 レーン飽和がステレオ経路とビット一致する)
+    [[nodiscard]] static __m256d compute(__m256d x, __m256d x2) noexcept {
+        const auto vNine = _mm256_set1_pd(9.0);
+        const auto vTwentySeven = _mm256_set1_pd(27.0);
+        const auto num = _mm256_mul_pd(x, _mm256_add_pd(vTwentySeven, x2));
+        const auto den = _mm256_add_pd(vTwentySeven, _mm256_mul_pd(vNine, x2));
+        return _mm256_div_pd(num, den);
+    }
+#endif
 };
 
 //==============================================================================
@@ -166,4 +181,64 @@ template<class Policy = DefaultFastTanhPolicy>
 }
 #endif
 
+//==============================================================================
+// fastTanhV512 — Policy ベース AVX-512F 版
+//   呼び出し側も CONVO_TARGET_AVX512 関数であること (KernelDispatch の Avx512 カーネル)。
+//   FMA で Horner 評価するため fastTanhV256 とは最下位ビットで差が出る。
+//==============================================================================
+template<class Policy = DefaultFastTanhPolicy>
+    requires detail::has_fast_tanh_policy_constants<Policy>::value
+[[nodiscard]] CONVO_TARGET_AVX512 inline __m512d fastTanhV512(__m512d x) noexcept
+{
+    const auto vClipHigh = _mm512_set1_pd(Policy::ClipThreshold);
+    const auto vClipLow  = _mm512_set1_pd(-Policy::ClipThreshold);
+    const auto xClamped = _mm512_min_pd(_mm512_max_pd(x, vClipLow), vClipHigh);
+    const auto x2 = _mm512_mul_pd(xClamped, xClamped);
+
+    const auto numPoly = _mm512_fmadd_pd(x2,
+        _mm512_fmadd_pd(x2, _mm512_set1_pd(Policy::NumC), _mm512_set1_pd(Policy::NumB)),
+        _mm512_set1_pd(Policy::NumA));
+    const auto den = _mm512_fmadd_pd(x2,
+        _mm512_fmadd_pd(x2, _mm512_add_pd(_mm512_set1_pd(Policy::DenC), x2), _mm512_set1_pd(Policy::DenB)),
+        _mm512_set1_pd(Policy::DenA));
+    return _mm512_div_pd(_mm512_mul_pd(xClamped, numPoly), den);
+}
+
+//==============================================================================
+// fastTanhFma / fastTanhV256Fma — fastTanhV512 と同じ FMA Horner 評価のスカラー / AVX2 版
+//   SoftClipBlock (dsp/math/SoftClipBlock.h) が幅に依らずビット一致するための共通評価順。
+//   std::fma は常に単一丸めなので、/fp:fast の TU からでも結果は変わらない。
+//==============================================================================
+template<class Policy = DefaultFastTanhPolicy>
+    requires detail::has_fast_tanh_policy_constants<Policy>::value
+[[nodiscard]] inline double fastTanhFma(double x) noexcept
+{
+    const double c = (x < -Policy::ClipThreshold) ? -Policy::ClipThreshold
+                   : ((x > Policy::ClipThreshold) ? Policy::ClipThreshold : x);
+    const double x2 = c * c;
+    const double numPoly = std::fma(x2, std::fma(x2, Policy::NumC, Policy::NumB), Policy::NumA);
+    const double den = std::fma(x2, std::fma(x2, Policy::DenC + x2, Policy::DenB), Policy::DenA);
+    return (c * numPoly) / den;
+}
+
+#if defined(__AVX2__) || defined(__FMA__)
+template<class Policy = DefaultFastTanhPolicy>
+    requires detail::has_fast_tanh_policy_constants<Policy>::value
+[[nodiscard]] inline __m256d fastTanhV256Fma(__m256d x) noexcept
+{
+    const auto vClipHigh = _mm256_set1_pd(Policy::ClipThreshold);
+    const auto vClipLow  = _mm256_set1_pd(-Policy::ClipThreshold);
+    const auto xClamped = _mm256_min_pd(_mm256_max_pd(x, vClipLow), vClipHigh);
+    const auto x2 = _mm256_mul_pd(xClamped, xClamped);
+
+    const auto numPoly = _mm256_fmadd_pd(x2,
+        _mm256_fmadd_pd(x2, _mm256_set1_pd(Policy::NumC), _mm256_set1_pd(Policy::NumB)),
+        _mm256_set1_pd(Policy::NumA));
+    const auto den = _mm256_fmadd_pd(x2,
+        _mm256_fmadd_pd(x2, _mm256_add_pd(_mm256_set1_pd(Policy::DenC), x2), _mm256_set1_pd(Policy::DenB)),
+        _mm256_set1_pd(Policy::DenA));
+    return _mm256_div_pd(_mm256_mul_pd(xClamped, numPoly), den);
+}
+#endif
+
 } // namespace convo::dsp
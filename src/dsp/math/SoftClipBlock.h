@@ -0,0 +1,195 @@
+#pragma once
+
+#include <immintrin.h>
+
+#include "dsp/IsaTarget.h"
+#include "dsp/math/FastTanhApprox.h"
+
+// LatticeNoiseShaperBatch.cpp と同様、/fp:fast の再結合を避けてスカラー参照と SIMD のビット一致を保つ
+#if defined(_MSC_VER)
+#pragma float_control(precise, on, push)
+#endif
+
+//==============================================================================
+// SoftClipBlock — Padé tanh ニー付きソフトクリップのブロック API (Policy テンプレート)
+//
+//   DSPCore の SoftClip (musicalSoftClip と同じ曲線: threshold ± knee の smoothstep ニー、
+//   負側だけ asymmetry で縮める) を連続バッファに対してまとめて評価する。
+//     softClipSample<Policy>      — 1 サンプルのスカラー参照 (テストの基準)
+//     softClipBlockScalar<Policy> — 参照のループ
+//     softClipBlockV256<Policy>   — AVX2 + FMA 4 幅。端数はスカラー参照
+//     softClipBlockV512<Policy>   — AVX-512F 8 幅。端数は opmask (CONVO_TARGET_AVX512、CPU 対応時のみ呼ぶ)
+//   どの幅も同じ演算順 (FMA の位置・逆数の掛け方を含む) で評価するため、出力はビット一致する。
+//   tanh は fastTanhFma / fastTanhV256Fma / fastTanhV512 (閾値へクランプしてから Padé を評価)。
+//
+//   線形域 (|x| <= threshold - knee) と NaN は入力をそのまま返す。knee <= 1e-9 は ±threshold の
+//   ハードクリップ。bad sample の除去は呼び出し側の責務 (KernelDispatch の softClip と同じ契約)。
+//==============================================================================
+
+namespace convo::dsp {
+
+// ブロック内で共通のパラメータ (逆数はここで 1 回だけ求める)
+struct SoftClipParams
+{
+    double threshold;
+    double knee;
+    double clipStart;    // threshold - knee
+    double recipKnee;    // 1 / knee
+    double recipKnee2;   // 1 / (2 * knee)
+    double asymHalf;     // asymmetry * 0.5
+
+    static SoftClipParams make(double threshold, double knee, double asymmetry) noexcept
+    {
+        return { threshold, knee, threshold - knee, 1.0 / knee, 1.0 / (2.0 * knee), asymmetry * 0.5 };
+    }
+};
+
+namespace detail {
+
+// knee が実質ゼロの場合は hard clip と等価 (全幅共通のフォールバック)
+inline bool softClipHardFallback(double* data, int n, double threshold, double knee) noexcept
+{
+    if (knee > 1.0e-9)
+        return false;
+    for (int i = 0; i < n; ++i)
+    {
+        const double v = data[i];
+        data[i] = (v < -threshold) ? -threshold : ((v > threshold) ? threshold : v);
+    }
+    return true;
+}
+
+} // namespace detail
+
+template<class Policy = SoftClipPadéPolicy>
+[[nodiscard]] inline double softClipSample(double x, const SoftClipParams& p) noexcept
+{
+    const double absX = (x < 0.0) ? -x : x;
+    if (!(absX > p.clipStart))
+        return x;
+
+    const double sign = (x > 0.0) ? 1.0 : -1.0;
+
+    double t = (absX - p.clipStart) * p.recipKnee2;
+    t = (t < 0.0) ? 0.0 : ((t > 1.0) ? 1.0 : t);
+    const double kneeShape = (t * t) * std::fma(-2.0, t, 3.0);
+
+    const double clipped = std::fma(p.knee, fastTanhFma<Policy>((absX - p.threshold) * p.recipKnee), p.threshold);
+    const double mixed = std::fma(clipped - absX, kneeShape, absX);
+    const double factor = (p.asymHalf * (1.0 - sign)) * kneeShape;
+    return sign * (mixed * (1.0 - factor));
+}
+
+template<class Policy = SoftClipPadéPolicy>
+inline void softClipBlockScalar(double* data, int n, double threshold, double knee, double asymmetry) noexcept
+{
+    if (n <= 0 || detail::softClipHardFallback(data, n, threshold, knee))
+        return;
+    const SoftClipParams p = SoftClipParams::make(threshold, knee, asymmetry);
+    for (int i = 0; i < n; ++i)
+        data[i] = softClipSample<Policy>(data[i], p);
+}
+
+#if defined(__AVX2__) || defined(__FMA__)
+template<class Policy = SoftClipPadéPolicy>
+inline void softClipBlockV256(double* __restrict data, int n, double threshold, double knee, double asymmetry) noexcept
+{
+    if (n <= 0 || detail::softClipHardFallback(data, n, threshold, knee))
+        return;
+    const SoftClipParams p = SoftClipParams::make(threshold, knee, asymmetry);
+
+    const __m256d vClipStart  = _mm256_set1_pd(p.clipStart);
+    const __m256d vThreshold  = _mm256_set1_pd(p.threshold);
+    const __m256d vKnee       = _mm256_set1_pd(p.knee);
+    const __m256d vAsymHalf   = _mm256_set1_pd(p.asymHalf);
+    const __m256d vRecipKnee  = _mm256_set1_pd(p.recipKnee);
+    const __m256d vRecipKnee2 = _mm256_set1_pd(p.recipKnee2);
+    const __m256d vOne        = _mm256_set1_pd(1.0);
+    const __m256d vMinusOne   = _mm256_set1_pd(-1.0);
+    const __m256d vTwo        = _mm256_set1_pd(2.0);
+    const __m256d vThree      = _mm256_set1_pd(3.0);
+    const __m256d vZero       = _mm256_setzero_pd();
+    const __m256d vSignMask   = _mm256_set1_pd(-0.0);
+
+    int i = 0;
+    const int vEnd = n / 4 * 4;
+    for (; i < vEnd; i += 4)
+    {
+        const __m256d x = _mm256_loadu_pd(data + i);
+        const __m256d absX = _mm256_andnot_pd(vSignMask, x);
+        const __m256d needClip = _mm256_cmp_pd(absX, vClipStart, _CMP_GT_OQ);
+        if (_mm256_movemask_pd(needClip) == 0)
+            continue; // 全レーンが線形域: 書き戻し不要
+
+        const __m256d sign = _mm256_blendv_pd(vMinusOne, vOne, _mm256_cmp_pd(x, vZero, _CMP_GT_OQ));
+
+        __m256d t = _mm256_mul_pd(_mm256_sub_pd(absX, vClipStart), vRecipKnee2);
+        t = _mm256_min_pd(_mm256_max_pd(t, vZero), vOne);
+        const __m256d ks = _mm256_mul_pd(_mm256_mul_pd(t, t), _mm256_fnmadd_pd(vTwo, t, vThree));
+
+        const __m256d arg = _mm256_mul_pd(_mm256_sub_pd(absX, vThreshold), vRecipKnee);
+        const __m256d clipped = _mm256_fmadd_pd(vKnee, fastTanhV256Fma<Policy>(arg), vThreshold);
+        const __m256d mixed = _mm256_fmadd_pd(_mm256_sub_pd(clipped, absX), ks, absX);
+
+        const __m256d factor = _mm256_mul_pd(_mm256_mul_pd(vAsymHalf, _mm256_sub_pd(vOne, sign)), ks);
+        const __m256d result = _mm256_mul_pd(sign, _mm256_mul_pd(mixed, _mm256_sub_pd(vOne, factor)));
+
+        _mm256_storeu_pd(data + i, _mm256_blendv_pd(x, result, needClip));
+    }
+
+    for (; i < n; ++i)
+        data[i] = softClipSample<Policy>(data[i], p);
+}
+#endif
+
+template<class Policy = SoftClipPadéPolicy>
+CONVO_TARGET_AVX512 inline void softClipBlockV512(double* __restrict data, int n, double threshold, double knee, double asymmetry) noexcept
+{
+    if (n <= 0 || detail::softClipHardFallback(data, n, threshold, knee))
+        return;
+    const SoftClipParams p = SoftClipParams::make(threshold, knee, asymmetry);
+
+    const __m512d vClipStart  = _mm512_set1_pd(p.clipStart);
+    const __m512d vThreshold  = _mm512_set1_pd(p.threshold);
+    const __m512d vKnee       = _mm512_set1_pd(p.knee);
+    const __m512d vAsymHalf   = _mm512_set1_pd(p.asymHalf);
+    const __m512d vRecipKnee  = _mm512_set1_pd(p.recipKnee);
+    const __m512d vRecipKnee2 = _mm512_set1_pd(p.recipKnee2);
+    const __m512d vOne        = _mm512_set1_pd(1.0);
+    const __m512d vMinusOne   = _mm512_set1_pd(-1.0);
+    const __m512d vTwo        = _mm512_set1_pd(2.0);
+    const __m512d vThree      = _mm512_set1_pd(3.0);
+    const __m512d vZero       = _mm512_setzero_pd();
+
+    for (int i = 0; i < n; i += 8)
+    {
+        const __mmask8 m = (n - i >= 8) ? static_cast<__mmask8>(0xFF)
+                                        : static_cast<__mmask8>((1u << (n - i)) - 1u);
+        const __m512d x = _mm512_maskz_loadu_pd(m, data + i);
+        const __m512d absX = _mm512_abs_pd(x);
+        const __mmask8 needClip = _mm512_cmp_pd_mask(absX, vClipStart, _CMP_GT_OQ);
+        if ((needClip & m) == 0)
+            continue;
+
+        const __m512d sign = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, vZero, _CMP_GT_OQ), vMinusOne, vOne);
+
+        __m512d t = _mm512_mul_pd(_mm512_sub_pd(absX, vClipStart), vRecipKnee2);
+        t = _mm512_min_pd(_mm512_max_pd(t, vZero), vOne);
+        const __m512d ks = _mm512_mul_pd(_mm512_mul_pd(t, t), _mm512_fnmadd_pd(vTwo, t, vThree));
+
+        const __m512d arg = _mm512_mul_pd(_mm512_sub_pd(absX, vThreshold), vRecipKnee);
+        const __m512d clipped = _mm512_fmadd_pd(vKnee, fastTanhV512<Policy>(arg), vThreshold);
+        const __m512d mixed = _mm512_fmadd_pd(_mm512_sub_pd(clipped, absX), ks, absX);
+
+        const __m512d factor = _mm512_mul_pd(_mm512_mul_pd(vAsymHalf, _mm512_sub_pd(vOne, sign)), ks);
+        const __m512d result = _mm512_mul_pd(sign, _mm512_mul_pd(mixed, _mm512_sub_pd(vOne, factor)));
+
+        _mm512_mask_storeu_pd(data + i, static_cast<__mmask8>(needClip & m), result);
+    }
+}
+
+} // namespace convo::dsp
+
+#if defined(_MSC_VER)
+#pragma float_control(pop)
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+//==============================================================================
+// EQCoeffBandReuse — EQCoeffCache 構築時のバンド単位の係数流用判定
+//
+// 設計方針:
+// - JUCE に依存しない inline 自由関数 (EQProcessor::createCoeffCache とテストで共有)
+// - 直前に構築したキャッシュ (base) と係数を決める要素 (freq/gain/Q/type/有効) が
+//   一致するバンドは base の係数をそのまま写し、変わったバンドだけを計算する。
+//   UI の 1 バンド編集では計算は 1 バンド分になる
+// - channelMode は係数に影響しないため比較しない (キャッシュ側で個別に保持する)
+// - sampleRate が base と異なる場合は全バンドを計算し直す
+//==============================================================================
+
+#include "core/EQParameters.h"
+
+namespace EQCoeffBandReuse {
+
+inline bool sameResponse(const convo::EQBandParams& a, const convo::EQBandParams& b) noexcept
+{
+    return a.enabled == b.enabled
+        && a.type == b.type
+        && a.frequency == b.frequency
+        && a.gain == b.gain
+        && a.q == b.q;
+}
+
+//==============================================================================
+// reuse[i] に「base の係数を流用できるか」を書き、流用できるバンド数を返す。
+//   baseBands == nullptr (base なし) またはサンプルレート不一致なら全て false。
+//   無効バンドは係数を持たないため流用対象にしない
+//==============================================================================
+inline int planReuse(const convo::EQBandParams* bands,
+                     const convo::EQBandParams* baseBands,
+                     double sampleRate,
+                     double baseSampleRate,
+                     int count,
+                     bool* reuse) noexcept
+{
+    const bool baseUsable = baseBands != nullptr && sampleRate > 0.0 && baseSampleRate == sampleRate;
+    int numReused = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        reuse[i] = baseUsable && bands[i].enabled && sameResponse(bands[i], baseBands[i]);
+        if (reuse[i])
+            ++numReused;
+    }
+    return numReused;
+}
+
+} // namespace EQCoeffBandReuse
@@ -0,0 +1,104 @@
+#pragma once
+
+//==============================================================================
+// EQMidSideRouting — Mid/Side バンドのエンコード / デコードと経路
+//
+// 設計方針:
+// - JUCE に依存しない inline 自由関数 (EQProcessor::process とテストで共有)
+// - バンド処理は呼び出し側のファンクタ (係数・状態・飽和は呼び出し側が束ねる)
+// - エンコード M=(L+R)·0.5, S=(L-R)·0.5 / デコード L=M+S, R=M-S は要素ごとの
+//   加減算と 0.5 倍のみ。ベクトル化の有無で丸めは変わらない
+//
+// Serial  : 連続する Mid/Side バンドを 1 グループとしてエンコード / デコードを 1 回に集約する。
+//           1 本だけのグループは従来のバンドごとのエンコードとビット一致する。
+//           2 本以上では途中のデコード→再エンコードの丸め (1 ulp 程度) だけ従来と異なる。
+// Parallel: 全バンドが同じ src を入力とするためエンコードはブロック内で 1 回。
+//           各バンドは自成分のコピーを処理し、デコードと差分加算は従来と同じ式 (ビット一致)。
+//==============================================================================
+
+namespace EQMidSideRouting {
+
+inline void encode(const double* l, const double* r, double* m, double* s, int length) noexcept
+{
+    for (int n = 0; n < length; ++n)
+    {
+        m[n] = (l[n] + r[n]) * 0.5;
+        s[n] = (l[n] - r[n]) * 0.5;
+    }
+}
+
+inline void decode(const double* m, const double* s, double* l, double* r, int length) noexcept
+{
+    for (int n = 0; n < length; ++n)
+    {
+        l[n] = m[n] + s[n];
+        r[n] = m[n] - s[n];
+    }
+}
+
+//==============================================================================
+// [begin, count) から始まる Mid/Side バンドの連続区間の終端 (isMidSide(i) が偽になる位置)
+//==============================================================================
+template <typename IsMidSide>
+inline int groupEnd(int begin, int count, IsMidSide isMidSide) noexcept
+{
+    int end = begin + 1;
+    while (end < count && isMidSide(end))
+        ++end;
+    return end;
+}
+
+//==============================================================================
+// Serial: バンド [begin, end) を 1 回のエンコード / デコードで処理する
+//   msWork は 2·length。process(g, buffer) はバンド g を buffer (M または S) に適用する。
+//==============================================================================
+template <typename IsMid, typename ProcessBand>
+inline void processSerialGroup(double* dataL, double* dataR, double* msWork, int length,
+                               int begin, int end, IsMid isMid, ProcessBand process) noexcept
+{
+    double* m = msWork;
+    double* s = msWork + length;
+    encode(dataL, dataR, m, s, length);
+    for (int g = begin; g < end; ++g)
+        process(g, isMid(g) ? m : s);
+    decode(m, s, dataL, dataR, length);
+}
+
+//==============================================================================
+// Parallel: エンコード済み srcM/srcS から 1 バンド分の差分 (H·x - x) を accum へ加算する
+//   work は length。process(buffer) はバンドを buffer に適用する。
+//==============================================================================
+template <typename ProcessBand>
+inline void accumulateParallelBand(const double* srcL, const double* srcR,
+                                   const double* srcM, const double* srcS,
+                                   double* work, double* accumL, double* accumR, int length,
+                                   bool isMid, ProcessBand process) noexcept
+{
+    const double* component = isMid ? srcM : srcS;
+    for (int n = 0; n < length; ++n)
+        work[n] = component[n];
+    process(work);
+
+    if (isMid)
+    {
+        for (int n = 0; n < length; ++n)
+        {
+            const double l = work[n] + srcS[n];
+            const double r = work[n] - srcS[n];
+            accumL[n] += l - srcL[n];
+            accumR[n] += r - srcR[n];
+        }
+    }
+    else
+    {
+        for (int n = 0; n < length; ++n)
+        {
+            const double l = srcM[n] + work[n];
+            const double r = srcM[n] - work[n];
+            accumL[n] += l - srcL[n];
+            accumR[n] += r - srcR[n];
+        }
+    }
+}
+
+} // namespace EQMidSideRouting
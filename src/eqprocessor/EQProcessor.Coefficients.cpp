@@ -10,6 +10,7 @@
 #include "EQAnalysisTypes.h"
 #include "BandHelper.h"
 #include "EQResponseSampler.h"
+#include "EQResponseCache.h"
 #include "PeakEstimator.h"
 #include "UpperBoundEstimator.h"
 #include "AnalysisMerge.h"
@@ -21,6 +22,8 @@
 
 #include "audioengine/AtomicAccess.h"
 
+#include <mkl_vml.h>
+
 //============================================================================
 // BandNode生成 (Message Thread)
 //============================================================================
@@ -62,6 +65,7 @@ EQProcessor::BandNode* EQProcessor::createBandNode(int band, const EQState& stat
 void EQProcessor::updateBandNode(int band)
 {
     if (band < 0 || band >= NUM_BANDS) return;
+    if (bandNodeUpdatesDeferred) return;  // 呼出し元が最後に updateAllBandNodes() する
 
     auto state = loadCurrentState(std::memory_order_acquire); // acquire: exchangeCurrentState/publishCurrentState の release/acq_rel と HB
     if (state == nullptr) return;
@@ -77,6 +81,65 @@ void EQProcessor::updateBandNode(int band)
     convo::publishAtomic(m_epochAdvancePending, true, std::memory_order_release); // [P1-14] deferred
 }
 
+//--------------------------------------------------------------
+// 全バンドの BandNode 一括生成 (Message Thread)
+// createBandNode と同じ判定で、係数のみ calcSVFCoeffsBatch でまとめて計算する
+//--------------------------------------------------------------
+void EQProcessor::createAllBandNodes(const EQState& state, std::array<BandNode*, NUM_BANDS>& out) const
+{
+    const double sr = convo::consumeAtomic(currentSampleRate, std::memory_order_acquire); // acquire: prepareToPlay/setSampleRate の publishAtomic release と HB
+
+    std::array<SVFCoeffRequest, NUM_BANDS> requests;
+    std::array<EQCoeffsSVF, NUM_BANDS> coeffs;
+    if (sr > 0.0)
+    {
+        for (int band = 0; band < NUM_BANDS; ++band)
+        {
+            const auto& params = state.bands[band];
+            requests[band] = { state.bandTypes[band], params.frequency, params.gain, params.q, sr };
+        }
+        calcSVFCoeffsBatch(requests.data(), NUM_BANDS, coeffs.data());
+    }
+
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        auto node = new BandNode();
+        const auto& params = state.bands[band];
+        const EQBandType type = state.bandTypes[band];
+
+        node->mode = state.bandChannelModes[band];
+        // prepareToPlay 前は sampleRate が未確定のため、係数計算を保留して
+        node->active = params.enabled && sr > 0.0;
+        node->coeffs = (sr > 0.0) ? coeffs[band] : EQCoeffsSVF();
+
+        // 最適化: ゲインが0dB付近ならスキップ
+        if (node->active && (type != EQBandType::LowPass && type != EQBandType::HighPass) && std::abs(params.gain) < 0.01f)
+            node->active = false;
+
+        out[band] = node;
+    }
+}
+
+void EQProcessor::updateAllBandNodes()
+{
+    auto state = loadCurrentState(std::memory_order_acquire); // acquire: exchangeCurrentState/publishCurrentState の release/acq_rel と HB
+    if (state == nullptr) return;
+
+    std::array<BandNode*, NUM_BANDS> newNodes {};
+    createAllBandNodes(*state, newNodes);
+
+    convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(m_localRetireRouter, convo::isr::RetireProducer::EQ);
+    for (int band = 0; band < NUM_BANDS; ++band)
+    {
+        BandNode* oldNode = exchangeBandNode(band, newNodes[band], std::memory_order_acq_rel); // acq_rel: acquire で先行 loadBandNode と HB; release で後続 loadBandNode acquire と HB
+        activeBandNodes[band] = newNodes[band];
+        // L5 fix と同じく advanceEpoch 前に retire する
+        if (oldNode)
+            (void)retireBandNodeDeferred(oldNode);
+    }
+    convo::publishAtomic(m_epochAdvancePending, true, std::memory_order_release); // [P1-14] deferred
+}
+
 //============================================================================
 // パラメータ検証とクランプ (Helper)
 //============================================================================
@@ -128,6 +191,63 @@ EQCoeffsSVF EQProcessor::calcSVFCoeffs(EQBandType type, float freq, float gainDb
     return {}; // unreachable
 }
 
+//============================================================================
+// SVF係数一括計算 (Message Thread / Non-RT 専用)
+// ★ プリセット・状態ロードやレート変更では 20 バンド × (倍率ごとの) サンプルレートを作り直すため、
+//    pow / sqrt / tan をバンドごとに呼ばず VML でまとめて評価する。クランプと係数式は単発版と共有。
+//============================================================================
+void EQProcessor::calcSVFCoeffsBatch(const SVFCoeffRequest* requests, int count, EQCoeffsSVF* out) noexcept
+{
+    if (requests == nullptr || out == nullptr || count <= 0)
+        return;
+
+    // スタック上の固定チャンクで処理する (20 バンド × 4 倍率程度なら 2 チャンク以内)
+    constexpr int kChunk = 64;
+    double base[kChunk], exponent[kChunk], A[kChunk], sqrtA[kChunk], arg[kChunk], tanW[kChunk], q[kChunk];
+    bool valid[kChunk];
+
+    for (int start = 0; start < count; start += kChunk)
+    {
+        const int n = std::min(kChunk, count - start);
+        for (int i = 0; i < n; ++i)
+        {
+            const auto& r = requests[start + i];
+            float freq = r.freq, gainDb = r.gainDb, qf = r.q;
+            valid[i] = r.sampleRate > 0.0;
+            if (valid[i])
+                validateAndClampParameters(freq, gainDb, qf, r.sampleRate);
+            else
+                jassertfalse;  // 不正なサンプルレート → バイパス係数 (calcSVFCoeffs と同じ扱い)
+
+            base[i] = 10.0;
+            exponent[i] = valid[i] ? static_cast<double>(gainDb) / 40.0 : 0.0;
+            arg[i] = valid[i] ? juce::MathConstants<double>::pi * static_cast<double>(freq) / r.sampleRate : 0.0;
+            q[i] = static_cast<double>(qf);
+        }
+
+        vdPow(n, base, exponent, A);
+        vdSqrt(n, A, sqrtA);
+        vdTan(n, arg, tanW);
+
+        for (int i = 0; i < n; ++i)
+        {
+            EQCoeffsSVF& c = out[start + i];
+            if (!valid[i])
+            {
+                c = EQCoeffsSVF();
+                c.a1 = 1.0; c.a2 = 0.0; c.a3 = 0.0;
+                c.m0 = 1.0; c.m1 = 0.0; c.m2 = 0.0;
+                continue;
+            }
+
+            // LP/HP は A を使わないため単発版と同じく 1.0 で渡す
+            const EQBandType type = requests[start + i].type;
+            const bool usesGain = (type != EQBandType::LowPass && type != EQBandType::HighPass);
+            c = svfFromPrewarp(type, usesGain ? A[i] : 1.0, usesGain ? sqrtA[i] : 1.0, tanW[i], q[i]);
+        }
+    }
+}
+
 //============================================================================
 // Biquad係数計算 (UI Thread用)
 //============================================================================
@@ -353,7 +473,7 @@ float EQProcessor::getMagnitudeSquared(const EQCoeffsBiquad& c, const std::compl
 //   processingRate = sr * resolvedOsFactor（呼出し側の責務）
 //==============================================================================
 EQProcessor::EQAnalysisResult EQProcessor::computeEstimatedMaxGainComplex(
-    const EQState& state, double processingRate) const
+    const EQState& state, double processingRate, EQResponseCache* cache) const
 {
     EQAnalysisResult result{};
 
@@ -368,10 +488,19 @@ EQProcessor::EQAnalysisResult EQProcessor::computeEstimatedMaxGainComplex(
         return result;
 
     const EQResponseSampler sampler(processingRate, isParallel);
-    const auto coarseResult = sampler.runCoarse(bands);
-    const auto measCands = sampler.findMeasuredCandidates(bands);
-    const auto ubCands = sampler.findUpperBoundCandidates(bands, coarseResult.bandMaxDelta);
-    const auto adaptiveResult = sampler.runAdaptive(bands, measCands, ubCands, coarseResult);
+    CoarseScanResult coarseResult;
+    AdaptiveScanResult adaptiveResult;
+    if (cache != nullptr)
+    {
+        cache->scan(sampler, bands, coarseResult, adaptiveResult);
+    }
+    else
+    {
+        coarseResult = sampler.runCoarse(bands);
+        const auto measCands = sampler.findMeasuredCandidates(bands);
+        const auto ubCands = sampler.findUpperBoundCandidates(bands, coarseResult.bandMaxDelta);
+        adaptiveResult = sampler.runAdaptive(bands, measCands, ubCands, coarseResult);
+    }
 
     auto merged = mergeAndSort(coarseResult, adaptiveResult);
     merged = deduplicate(merged);
@@ -429,163 +558,54 @@ EQCoeffsBiquad EQProcessor::svfToDisplayBiquad(const EQCoeffsSVF& svf) noexcept
 //============================================================================
 EQCoeffsSVF EQProcessor::calcLowShelfSVF(double freq, double gainDb, double q, double sr) noexcept
 {
-    EQCoeffsSVF c;
     const double A = std::pow(10.0, gainDb / 40.0);
-    const double g = std::tan(juce::MathConstants<double>::pi * freq / sr) / std::sqrt(A);
-    const double k = 1.0 / q;
-
-    // NaN/Infチェック: tan()が発散した場合など
-    if (!std::isfinite(g) || !std::isfinite(k))
-    {
-        // デフォルト係数（バイパス状態）を返す
-        c.a1 = 1.0; c.a2 = 0.0; c.a3 = 0.0;
-        c.m0 = 1.0; c.m1 = 0.0; c.m2 = 0.0;
-        return c;
-    }
-
-    // 除算ゼロ保護 (Division by Zero Protection)
-    const double denominator = 1.0 + g * (g + k);
-    if (std::abs(denominator) < 1.0e-15)
-    {
-        // デフォルト係数（バイパス状態）を返す
-        c.a1 = 1.0;
-        c.a2 = 0.0;
-        c.a3 = 0.0;
-        c.m0 = 1.0;
-        c.m1 = 0.0;
-        c.m2 = 0.0;
-        return c;
-    }
-
-    c.a1 = 1.0 / denominator;
-    c.a2 = g * c.a1;
-    c.a3 = g * c.a2;
-    c.m0 = 1.0;
-    c.m1 = k * (A - 1.0);
-    c.m2 = A * A - 1.0;
-    return c;
+    return svfFromPrewarp(EQBandType::LowShelf, A, std::sqrt(A),
+                          std::tan(juce::MathConstants<double>::pi * freq / sr), q);
 }
 
 EQCoeffsSVF EQProcessor::calcPeakingSVF(double freq, double gainDb, double q, double sr) noexcept
 {
-    EQCoeffsSVF c;
     const double A = std::pow(10.0, gainDb / 40.0);
-    const double g = std::tan(juce::MathConstants<double>::pi * freq / sr);
-    const double k = 1.0 / (q * A);
-
-    // NaN/Infチェック
-    if (!std::isfinite(g) || !std::isfinite(k))
-    {
-        // デフォルト係数（バイパス状態）を返す
-        c.a1 = 1.0; c.a2 = 0.0; c.a3 = 0.0;
-        c.m0 = 1.0; c.m1 = 0.0; c.m2 = 0.0;
-        return c;
-    }
-
-    // 除算ゼロ保護
-    const double denominator = 1.0 + g * (g + k);
-    if (std::abs(denominator) < 1.0e-15)
-    {
-        c.a1 = 1.0;
-        c.a2 = 0.0;
-        c.a3 = 0.0;
-        c.m0 = 1.0;
-        c.m1 = 0.0;
-        c.m2 = 0.0;
-        return c;
-    }
-
-    c.a1 = 1.0 / denominator;
-    c.a2 = g * c.a1;
-    c.a3 = g * c.a2;
-    c.m0 = 1.0;
-    c.m1 = (A - 1.0 / A) / q;
-    c.m2 = 0.0;
-    return c;
+    return svfFromPrewarp(EQBandType::Peaking, A, std::sqrt(A),
+                          std::tan(juce::MathConstants<double>::pi * freq / sr), q);
 }
 
 EQCoeffsSVF EQProcessor::calcHighShelfSVF(double freq, double gainDb, double q, double sr) noexcept
 {
-    EQCoeffsSVF c;
     const double A = std::pow(10.0, gainDb / 40.0);
-    const double g = std::tan(juce::MathConstants<double>::pi * freq / sr) * std::sqrt(A);
-    const double k = 1.0 / q;
-
-    // NaN/Infチェック
-    if (!std::isfinite(g) || !std::isfinite(k))
-    {
-        // デフォルト係数（バイパス状態）を返す
-        c.a1 = 1.0; c.a2 = 0.0; c.a3 = 0.0;
-        c.m0 = 1.0; c.m1 = 0.0; c.m2 = 0.0;
-        return c;
-    }
-
-    // 除算ゼロ保護
-    const double denominator = 1.0 + g * (g + k);
-    if (std::abs(denominator) < 1.0e-15)
-    {
-        c.a1 = 1.0;
-        c.a2 = 0.0;
-        c.a3 = 0.0;
-        c.m0 = 1.0;
-        c.m1 = 0.0;
-        c.m2 = 0.0;
-        return c;
-    }
-
-    c.a1 = 1.0 / denominator;
-    c.a2 = g * c.a1;
-    c.a3 = g * c.a2;
-    c.m0 = A * A;
-    c.m1 = k * (1.0 - A) * A;
-    c.m2 = 1.0 - A * A;
-    return c;
+    return svfFromPrewarp(EQBandType::HighShelf, A, std::sqrt(A),
+                          std::tan(juce::MathConstants<double>::pi * freq / sr), q);
 }
 
 EQCoeffsSVF EQProcessor::calcLowPassSVF(double freq, double q, double sr) noexcept
 {
-    EQCoeffsSVF c;
-    const double g = std::tan(juce::MathConstants<double>::pi * freq / sr);
-    const double k = 1.0 / q;
-
-    // NaN/Infチェック
-    if (!std::isfinite(g) || !std::isfinite(k))
-    {
-        // デフォルト係数（バイパス状態）を返す
-        c.a1 = 1.0; c.a2 = 0.0; c.a3 = 0.0;
-        c.m0 = 1.0; c.m1 = 0.0; c.m2 = 0.0;
-        return c;
-    }
-
-    // 除算ゼロ保護
-    const double denominator = 1.0 + g * (g + k);
-    if (std::abs(denominator) < 1.0e-15)
-    {
-        c.a1 = 1.0;
-        c.a2 = 0.0;
-        c.a3 = 0.0;
-        c.m0 = 1.0; // バイパス
-        c.m1 = 0.0;
-        c.m2 = 0.0;
-        return c;
-    }
-
-    c.a1 = 1.0 / denominator;
-    c.a2 = g * c.a1;
-    c.a3 = g * c.a2;
-    c.m0 = 0.0;
-    c.m1 = 0.0;
-    c.m2 = 1.0;
-    return c;
+    return svfFromPrewarp(EQBandType::LowPass, 1.0, 1.0,
+                          std::tan(juce::MathConstants<double>::pi * freq / sr), q);
 }
 
 EQCoeffsSVF EQProcessor::calcHighPassSVF(double freq, double q, double sr) noexcept
+{
+    return svfFromPrewarp(EQBandType::HighPass, 1.0, 1.0,
+                          std::tan(juce::MathConstants<double>::pi * freq / sr), q);
+}
+
+EQCoeffsSVF EQProcessor::svfFromPrewarp(EQBandType type, double A, double sqrtA, double tanW, double q) noexcept
 {
     EQCoeffsSVF c;
-    const double g = std::tan(juce::MathConstants<double>::pi * freq / sr);
-    const double k = 1.0 / q;
 
-    // NaN/Infチェック
+    // シェルフはプリワープ周波数を √A でずらし、ピーキングは減衰量を A で割る
+    double g = tanW;
+    double k = 1.0 / q;
+    switch (type)
+    {
+        case EQBandType::LowShelf:  g = tanW / sqrtA; break;
+        case EQBandType::HighShelf: g = tanW * sqrtA; break;
+        case EQBandType::Peaking:   k = 1.0 / (q * A); break;
+        case EQBandType::LowPass:
+        case EQBandType::HighPass:  break;
+    }
+
+    // NaN/Infチェック: tan()が発散した場合など
     if (!std::isfinite(g) || !std::isfinite(k))
     {
         // デフォルト係数（バイパス状態）を返す
@@ -594,24 +614,50 @@ EQCoeffsSVF EQProcessor::calcHighPassSVF(double freq, double q, double sr) noexc
         return c;
     }
 
-    // 除算ゼロ保護
+    // 除算ゼロ保護 (Division by Zero Protection)
     const double denominator = 1.0 + g * (g + k);
     if (std::abs(denominator) < 1.0e-15)
     {
-        c.a1 = 1.0;
-        c.a2 = 0.0;
-        c.a3 = 0.0;
-        c.m0 = 1.0;
-        c.m1 = 0.0;
-        c.m2 = 0.0;
+        // デフォルト係数（バイパス状態）を返す
+        c.a1 = 1.0; c.a2 = 0.0; c.a3 = 0.0;
+        c.m0 = 1.0; c.m1 = 0.0; c.m2 = 0.0;
         return c;
     }
 
+    // g/k も保持する (processBandRamped は g/k/m を補間して a1..a3 を再計算する)
+    c.g = g;
+    c.k = k;
     c.a1 = 1.0 / denominator;
     c.a2 = g * c.a1;
     c.a3 = g * c.a2;
-    c.m0 = 1.0;
-    c.m1 = -k;
-    c.m2 = -1.0;
+
+    switch (type)
+    {
+        case EQBandType::LowShelf:
+            c.m0 = 1.0;
+            c.m1 = k * (A - 1.0);
+            c.m2 = A * A - 1.0;
+            break;
+        case EQBandType::Peaking:
+            c.m0 = 1.0;
+            c.m1 = (A - 1.0 / A) / q;
+            c.m2 = 0.0;
+            break;
+        case EQBandType::HighShelf:
+            c.m0 = A * A;
+            c.m1 = k * (1.0 - A) * A;
+            c.m2 = 1.0 - A * A;
+            break;
+        case EQBandType::LowPass:
+            c.m0 = 0.0;
+            c.m1 = 0.0;
+            c.m2 = 1.0;
+            break;
+        case EQBandType::HighPass:
+            c.m0 = 1.0;
+            c.m1 = -k;
+            c.m2 = -1.0;
+            break;
+    }
     return c;
 }
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <regex>
 #include "core/EpochDomain.h"
+#include "core/FixedSlabPool.h"
 #include "core/RCUReader.h"
 #include "audioengine/ISRRuntimePublicationCoordinator.h"
 
@@ -21,6 +22,31 @@ namespace
 {
 void deleteEQStatePtr(void* p) noexcept { delete static_cast<EQProcessor::EQState*>(p); }
 void deleteBandNodePtr(void* p) noexcept { delete static_cast<EQProcessor::BandNode*>(p); }
+
+// 型専用スラブ。EQState はパラメータ変更ごと (UI ドラッグ中は毎フレーム)、BandNode は 20 バンド分 +
+// epoch 回収待ちが滞留するため多めに取る。満杯時はヒープへフォールバック
+convo::FixedSlabPool<sizeof(EQProcessor::EQState), alignof(EQProcessor::EQState), 128> g_eqStatePool;
+convo::FixedSlabPool<sizeof(EQProcessor::BandNode), alignof(EQProcessor::BandNode), 256> g_bandNodePool;
+}
+
+void* EQProcessor::EQState::operator new(std::size_t size)
+{
+    return g_eqStatePool.allocate(size);
+}
+
+void EQProcessor::EQState::operator delete(void* ptr) noexcept
+{
+    g_eqStatePool.deallocate(ptr);
+}
+
+void* EQProcessor::BandNode::operator new(std::size_t size)
+{
+    return g_bandNodePool.allocate(size);
+}
+
+void EQProcessor::BandNode::operator delete(void* ptr) noexcept
+{
+    g_bandNodePool.deallocate(ptr);
 }
 
 bool EQProcessor::enqueueDeferredDeleteWithFallback(void* ptr,
@@ -45,20 +71,23 @@ bool EQProcessor::enqueueDeferredDeleteWithFallback(void* ptr,
     //   ISRRetireRouter と EpochDomain は共通基底 (IEpochProvider) を持つが
     //   直接の継承関係になく、メモリレイアウトが異なるため、
     //   enqueueRetire() 内の epochDomain_ メンバがガベージになる。
-    //   正しい対策: スタック上に ISRRetireRouter を構築する。
-    convo::isr::ISRRetireRouter stackRouter(m_epochDomain);
+    //   正しい対策: m_epochDomain を包む ISRRetireRouter をメンバに持つ (m_localRetireRouter)。
+    //
+    // 自動化中は 1 回の変更ごとに EQState が退役する。EQ レーンへ入れて共有キューの
+    // 満杯 → tryReclaim → 再試行に落ちないようにする (呼び出し元がスコープを開いていればそちらでまとめる)
+    convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(m_localRetireRouter, convo::isr::RetireProducer::EQ);
 
     // [Bug2 Phase1] 初回試行: Coordinator 経由で Authority チェック + 初回 enqueue
     auto result = m_retireCoordinator->enqueueRetire(
         convo::isr::RetireAuthority::Granted,
-        stackRouter,
+        m_localRetireRouter,
         ptr, deleter, retireEpoch);
     if (result == convo::isr::RetireEnqueueResult::Success)
         return true;
 
     // 初回失敗 → enqueueWithRetry で tryReclaim + 再試行を Router 内部で完結
     //   Coordinator の Authority チェックは初回で済んでいるため、直接 Router に委譲
-    result = stackRouter.enqueueWithRetry(ptr, deleter, retireEpoch, DeletionEntryType::Generic);
+    result = m_localRetireRouter.enqueueWithRetry(ptr, deleter, retireEpoch, DeletionEntryType::Generic);
     return result == convo::isr::RetireEnqueueResult::Success;
 }
 // [P1-14] 保留中の advanceEpoch を一括実行.
@@ -114,23 +143,26 @@ EQProcessor::EQProcessor()
 EQProcessor::~EQProcessor()
 {
     juce::Logger::writeToLog("[DIAG EQProcessor] ~EQProcessor: enter");
-    if (auto* oldState = exchangeCurrentState(nullptr, std::memory_order_acq_rel)) // acq_rel: acquire で先行 exchangeCurrentState/publishCurrentState と HB; release で後続観測者と HB
-        (void)retireEQStateDeferred(oldState);
-
-    for (auto& nodeBits : bandNodeBits) {
-        const auto bits = convo::exchangeAtomic(nodeBits, static_cast<std::uintptr_t>(0), std::memory_order_release); // release: デストラクタ後の観測者に対して null 書き込みを公知。acquire 不要 — デストラクタは排他的所有権を持つ
-        if (auto* n = fromBandNodeBits(bits))
-            (void)retireBandNodeDeferred(n);
-    }
+    {  // State + 全 BandNode を 1 バッチで渡す
+        convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(m_localRetireRouter, convo::isr::RetireProducer::EQ);
+        if (auto* oldState = exchangeCurrentState(nullptr, std::memory_order_acq_rel)) // acq_rel: acquire で先行 exchangeCurrentState/publishCurrentState と HB; release で後続観測者と HB
+            (void)retireEQStateDeferred(oldState);
+
+        for (auto& nodeBits : bandNodeBits) {
+            const auto bits = convo::exchangeAtomic(nodeBits, static_cast<std::uintptr_t>(0), std::memory_order_release); // release: デストラクタ後の観測者に対して null 書き込みを公知。acquire 不要 — デストラクタは排他的所有権を持つ
+            if (auto* n = fromBandNodeBits(bits))
+                (void)retireBandNodeDeferred(n);
+        }
 
-    for (auto& node : activeBandNodes) {
-        node = nullptr;
+        for (auto& node : activeBandNodes) {
+            node = nullptr;
+        }
     }
 
-    // 退役キューを強制 drain して可能な限り回収する。
-    m_epochDomain.tryReclaim();
-    m_epochDomain.drainAll();
-    m_epochDomain.tryReclaim();
+    // 退役キュー (バッチレーン分を含む) を強制 drain して可能な限り回収する。
+    m_localRetireRouter.tryReclaim();
+    m_localRetireRouter.drainAll();
+    m_localRetireRouter.tryReclaim();
 
     releaseResources();
     juce::Logger::writeToLog("[DIAG EQProcessor] ~EQProcessor: exit");
@@ -167,17 +199,27 @@ void EQProcessor::releaseResources()
     structureOldOutBuffer.reset();
     juce::Logger::writeToLog("[DIAG EQProcessor] releaseResources: after structureOldOutBuffer.reset");
 
-    juce::Logger::writeToLog("[DIAG EQProcessor] releaseResources: before structureNewOutBuffer.reset");
-    structureNewOutBuffer.reset();
-    juce::Logger::writeToLog("[DIAG EQProcessor] releaseResources: after structureNewOutBuffer.reset");
-
     parallelBufferCapacity = 0;
     structureXfadeBufferCapacity = 0;
+    updateMemoryCharge();
     // [P1-14] 保留中の advanceEpoch を一括実行
     flushPendingEpochAdvance();
     juce::Logger::writeToLog("[DIAG EQProcessor] releaseResources: end");
 }
 
+void EQProcessor::updateMemoryCharge() noexcept
+{
+    // releaseResources は M/S・AGC テーブルを残すので、確保済みのものだけを数える
+    size_t doubles = static_cast<size_t>(scratchCapacity) + static_cast<size_t>(dryBypassCapacity)
+                   + static_cast<size_t>(parallelBufferCapacity) * 3
+                   + static_cast<size_t>(structureXfadeBufferCapacity);
+    if (msWorkBuffer)
+        doubles += static_cast<size_t>(msWorkCapacity);
+    if (agcAttackCoeffTable)
+        doubles += static_cast<size_t>(agcCoeffTableCapacity) * 3;
+    memoryCharge.set(doubles * sizeof(double));
+}
+
 //============================================================================
 // デフォルト値リセット
 //============================================================================
@@ -221,8 +263,7 @@ void EQProcessor::resetToDefaults()
     convo::publishAtomic(agcEnvOutput, 0.0, std::memory_order_release);   // release: 同上
 
     // 全バンドの係数を更新
-    for (int i = 0; i < NUM_BANDS; ++i)
-        updateBandNode(i);
+    updateAllBandNodes();
 
     // 全状態のリセットを予約
     requestAllBandReset();
@@ -270,11 +311,29 @@ void EQProcessor::loadPreset(int /*index*/)
     sendChangeMessage();
 }
 
+bool EQProcessor::parseTextPresetFile(const juce::File& file, convo::EQParameters& out)
+{
+    EQProcessor scratch;
+    scratch.textLoadWarningsEnabled = false;
+    if (!scratch.loadFromTextFile(file))
+        return false;
+
+    const auto* state = scratch.getEQStateSnapshot();
+    if (state == nullptr)
+        return false;
+
+    out = state->toEQParameters();
+    return true;
+}
+
 bool EQProcessor::loadFromTextFile(const juce::File& file)
 {
     if (!file.existsAsFile())
         return false;
 
+    // バンドごとの係数再計算を止め、解析後に一括で作り直す
+    bandNodeUpdatesDeferred = true;
+
     for (int i = 0; i < NUM_BANDS; ++i)
     {
         setBandEnabled(i, false);
@@ -349,7 +408,7 @@ bool EQProcessor::loadFromTextFile(const juce::File& file)
         {
             if (currentFilterIndex >= NUM_BANDS)
             {
-                if (!maxBandsWarningShown)
+                if (!maxBandsWarningShown && textLoadWarningsEnabled)
                 {
                     maxBandsWarningShown = true;
                     const auto showMaxBandsWarning = [] {
@@ -458,6 +517,9 @@ bool EQProcessor::loadFromTextFile(const juce::File& file)
         }
     }
 
+    bandNodeUpdatesDeferred = false;
+    updateAllBandNodes();
+
     requestAllBandReset();
     sendChangeMessage();
     return true;
@@ -506,6 +568,9 @@ void EQProcessor::setState (const juce::ValueTree& v)
     if (v.hasProperty("filterStructure"))
         setFilterStructure(static_cast<FilterStructure>(static_cast<int>(v.getProperty("filterStructure"))));
 
+    // バンドごと・プロパティごとの係数再計算を止め、最後に一括で作り直す
+    bandNodeUpdatesDeferred = true;
+
     for (const auto& band : v)
     {
         if (band.hasType ("Band") && band.hasProperty ("index"))
@@ -523,6 +588,9 @@ void EQProcessor::setState (const juce::ValueTree& v)
         }
     }
 
+    bandNodeUpdatesDeferred = false;
+    updateAllBandNodes();
+
     // 状態ロード時は全リセット
     requestAllBandReset();
     requestAgcReset();
@@ -543,6 +611,9 @@ void EQProcessor::syncStateFrom(const EQProcessor& other)
     if (otherState == nullptr)
         return;
 
+    // State と全 BandNode の退役をまとめて 1 バッチにする
+    convo::isr::ISRRetireRouter::RetireBatchScope retireBatch(m_localRetireRouter, convo::isr::RetireProducer::EQ);
+
     auto* clonedState = new EQState(*otherState);
     auto oldState = exchangeCurrentState(clonedState, std::memory_order_acq_rel); // acq_rel: acquire で先行 load と HB; release で後続 loadCurrentState acquire と HB
 
@@ -552,8 +623,7 @@ void EQProcessor::syncStateFrom(const EQProcessor& other)
     }
     convo::publishAtomic(m_epochAdvancePending, true, std::memory_order_release); // [P1-14] deferred
 
-    for (int i = 0; i < NUM_BANDS; ++i)
-        updateBandNode(i);
+    updateAllBandNodes();
 
     const double syncedAgcCurrentGain = convo::consumeAtomic(other.agcCurrentGain, std::memory_order_acquire); // acquire: other の publishAtomic release と HB
     const double syncedAgcEnvInput = convo::consumeAtomic(other.agcEnvInput, std::memory_order_acquire);       // acquire: 同上
@@ -579,6 +649,7 @@ void EQProcessor::syncStateFrom(const EQProcessor& other)
     rtDeferredBandResetMask = syncedBandResetMask;
     rtSeenBandResetSerial = syncedBandResetSerial;
     rtSeenAgcResetSerial = syncedAgcResetSerial;
+    resetBandCoeffRamps();
 
 }
 
@@ -642,6 +713,7 @@ void EQProcessor::syncGlobalStateFrom(const EQProcessor& other)
     rtDeferredBandResetMask = syncedBandResetMask;
     rtSeenBandResetSerial = syncedBandResetSerial;
     rtSeenAgcResetSerial = syncedAgcResetSerial;
+    resetBandCoeffRamps();
 
 }
 
@@ -695,12 +767,12 @@ void EQProcessor::prepareToPlay(double sampleRate, int newMaxInternalBlockSize)
     if (structureXfadeBufferCapacity < channelRequired)
     {
         structureOldOutBuffer = convo::makeAlignedArray<double>(static_cast<size_t>(channelRequired));
-        structureNewOutBuffer = convo::makeAlignedArray<double>(static_cast<size_t>(channelRequired));
         structureXfadeBufferCapacity = channelRequired;
         juce::FloatVectorOperations::clear(structureOldOutBuffer.get(), channelRequired);
-        juce::FloatVectorOperations::clear(structureNewOutBuffer.get(), channelRequired);
         juce::Logger::writeToLog("[EQ_PREPARE] xfade buffers allocated");
     }
+    structureXfadeSamples = std::max(kStructureXfadeMinSamples,
+                                     static_cast<int>(sampleRate * kStructureXfadeSeconds));
 
     // M/S処理用スクラッチバッファ
     const int requiredMS = newMaxInternalBlockSize * 4;
@@ -725,6 +797,7 @@ void EQProcessor::prepareToPlay(double sampleRate, int newMaxInternalBlockSize)
         else
             agcCoeffTableCapacity = 0;
     }
+    updateMemoryCharge();
 
     auto state = loadCurrentState(std::memory_order_acquire); // acquire: exchangeCurrentState/publishCurrentState の release/acq_rel と HB
 
@@ -739,6 +812,8 @@ void EQProcessor::prepareToPlay(double sampleRate, int newMaxInternalBlockSize)
     }
 
     std::memset(filterState.data(), 0, sizeof(filterState));
+    bandRampSamples = static_cast<int>(std::lround(sampleRate * SMOOTHING_TIME_SEC));
+    resetBandCoeffRamps();
 
     const double sr = sampleRate;
     convo::publishAtomic(agcAttackCoeff,  std::exp(-1.0 / (sr * AGC_ATTACK_TIME_SEC)),  std::memory_order_release); // release: Processing.cpp の agcAttackCoeff acquire と HB
@@ -774,20 +849,7 @@ void EQProcessor::prepareToPlay(double sampleRate, int newMaxInternalBlockSize)
     bypassFadeGain.setCurrentAndTargetValue(requestedBypass ? 0.0 : 1.0);
 
     if (rateChanged)
-    {
-        for (int i = 0; i < NUM_BANDS; ++i)
-        {
-            auto loopState = loadCurrentState(std::memory_order_acquire); // acquire: 直前の exchangeCurrentState acq_rel と HB
-            if (loopState)
-            {
-                auto newNode = createBandNode(i, *loopState);
-                auto oldNode = exchangeBandNode(i, newNode, std::memory_order_acq_rel); // acq_rel: acquire で先行 load と HB; release で後続 loadBandNode acquire と HB
-                if (oldNode)
-                    (void)retireBandNodeDeferred(oldNode);
-                activeBandNodes[i] = newNode;
-            }
-        }
-    }
+        updateAllBandNodes();
 
     // [P1-14] 保留中の advanceEpoch を一括実行
     flushPendingEpochAdvance();
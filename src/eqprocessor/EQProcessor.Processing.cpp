@@ -3,7 +3,9 @@
 //============================================================================
 #include "EQProcessor.h"
 #include "DspNumericPolicy.h"
+#include "EQMidSideRouting.h"
 #include <algorithm>
+#include <bit>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
@@ -113,6 +115,26 @@ namespace
         return convo::dsp::fastTanhV128<>(x);
     }
 
+    // Parallel バンク用の 4 レーン版。fastTanhV256<> は分母に x⁶ 項を持つ一般形なので使わず、
+    // fastTanhV128Output と同じ 27/9 式 (クランプ ±4.5 → Policy::compute) をそのまま 4 レーンで評価する
+    inline __m256d fastTanhV256Output(__m256d x) noexcept
+    {
+        using Policy = convo::dsp::DefaultFastTanhPolicy;
+        const __m256d xClamped = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-Policy::clipThreshold)),
+                                               _mm256_set1_pd(Policy::clipThreshold));
+        return Policy::compute(xClamped, _mm256_mul_pd(xClamped, xClamped));
+    }
+
+    // 飽和ミックス y = (1 - s)·x + s·tanh(x) のブロック定数。
+    // カーネルは飽和の有無をテンプレート引数 (Saturate) で受け、サンプルループ内の分岐と定数生成を持たない。
+    struct SaturationMix
+    {
+        double sat = 0.0;
+        double dry = 1.0;
+
+        explicit SaturationMix(double saturation) noexcept : sat(saturation), dry(1.0 - saturation) {}
+    };
+
     inline double equalPowerSin(double x) noexcept
     {
         const double t = x * (juce::MathConstants<double>::pi * 0.5);
@@ -125,10 +147,11 @@ namespace
 // Topology-Preserving Transform State Variable Filter
 // 参照: Vadim Zavalishin "The Art of VA Filter Design"
 //--------------------------------------------------------------
-    inline void processBand (double* data, int numSamples,
+    template <bool Saturate>
+    inline void processBandT(double* data, int numSamples,
                              const EQCoeffsSVF& c,
                              double* state,
-                             double saturation)
+                             const SaturationMix& mix)
     {
         double ic1eq = state[0];
         double ic2eq = state[1];
@@ -154,11 +177,8 @@ namespace
 
             double output = m0 * v0 + m1 * v1 + m2 * v2;
 
-            if (saturation > 0.0)
-            {
-                const double oneMinusSat = 1.0 - saturation;
-                output = output * oneMinusSat + fastTanhScalarOutput(output) * saturation;
-            }
+            if constexpr (Saturate)
+                output = output * mix.dry + fastTanhScalarOutput(output) * mix.sat;
 
             // NaN/Infチェックとクランプを追加 (processBandStereoと一貫性を保つ)
             if (!isFiniteAndAbsInRangeMask(output, 0.0, 1.0e15))
@@ -185,30 +205,100 @@ namespace
         state[1] = ic2eq;
     }
 
+    inline void processBand(double* data, int numSamples,
+                            const EQCoeffsSVF& c,
+                            double* state,
+                            double saturation)
+    {
+        const SaturationMix mix(saturation);
+        if (saturation > 0.0)
+            processBandT<true>(data, numSamples, c, state, mix);
+        else
+            processBandT<false>(data, numSamples, c, state, mix);
+    }
+
+    // ── Stereo SVF 1 サンプル分の演算 (processBandStereo / processStereoCascadeFused 共通) ──
+    // [L, R] を __m128d の lower/upper にパックした 1 ステップ。両カーネルで演算順序を共有し、
+    // fused 経路でもバンド単位処理とビット一致させる。
+    struct SVFStereoCoeffsV
+    {
+        __m128d a1, a2, a3, m0, m1, m2;
+
+        SVFStereoCoeffsV() noexcept = default;
+        explicit SVFStereoCoeffsV(const EQCoeffsSVF& c) noexcept
+            : a1(_mm_set1_pd(c.a1)), a2(_mm_set1_pd(c.a2)), a3(_mm_set1_pd(c.a3)),
+              m0(_mm_set1_pd(c.m0)), m1(_mm_set1_pd(c.m1)), m2(_mm_set1_pd(c.m2)) {}
+    };
+
+    struct SaturationMixV
+    {
+        __m128d sat, dry;
+
+        explicit SaturationMixV(const SaturationMix& mix) noexcept
+            : sat(_mm_set1_pd(mix.sat)), dry(_mm_set1_pd(mix.dry)) {}
+    };
+
+    template <bool Saturate>
+    inline __m128d svfStereoTick(__m128d v0,
+                                 __m128d& ic1eq,
+                                 __m128d& ic2eq,
+                                 const SVFStereoCoeffsV& k,
+                                 const SaturationMixV& mix) noexcept
+    {
+        const __m128d two = _mm_set1_pd(2.0);
+        const __m128d cHigh = _mm_set1_pd(100.0);
+        const __m128d cLow  = _mm_set1_pd(-100.0);
+
+        const __m128d v3 = _mm_sub_pd(v0, ic2eq);
+        // FMA: a1*ic1eq + a2*v3
+        const __m128d v1 = _mm_fmadd_pd(k.a1, ic1eq, _mm_mul_pd(k.a2, v3));
+        // FMA: ic2eq + a2*ic1eq + a3*v3
+        const __m128d v2 = _mm_fmadd_pd(k.a2, ic1eq,
+                            _mm_fmadd_pd(k.a3, v3, ic2eq));
+
+        ic1eq = _mm_fmsub_pd(two, v1, ic1eq);  // 2*v1 - ic1eq
+        ic2eq = _mm_fmsub_pd(two, v2, ic2eq);  // 2*v2 - ic2eq
+
+        // FMA: m0*v0 + m1*v1 + m2*v2
+        __m128d output = _mm_fmadd_pd(k.m0, v0,
+                          _mm_fmadd_pd(k.m1, v1,
+                           _mm_mul_pd(k.m2, v2)));
+
+        if constexpr (Saturate)
+            output = _mm_add_pd(_mm_mul_pd(output, mix.dry),
+                                _mm_mul_pd(fastTanhV128Output(output), mix.sat));
+
+        // NaN/Infチェック + 範囲クランプ (processBand と一貫性を保つ)
+        {
+            const __m128d vMinZero = _mm_setzero_pd();
+            const __m128d vMaxRange = _mm_set1_pd(1.0e15);
+            output = sanitizeFiniteInRangeV(output, vMinZero, vMaxRange);
+            // ★ state 変数 NaN/Inf ガード (processBand と同等)
+            ic1eq = sanitizeFiniteInRangeV(ic1eq, vMinZero, vMaxRange);
+            ic2eq = sanitizeFiniteInRangeV(ic2eq, vMinZero, vMaxRange);
+        }
+
+        // クランプ (-100, +100) で発散防止
+        return _mm_min_pd(_mm_max_pd(output, cLow), cHigh);
+    }
+
     // ── 追加: Stereo 2ch 同時処理 (SSE2 / AVX2 FMA) ──
     // L, R が完全に独立した IIR 状態を持つため、128-bit レジスタに
     // [L_value, R_value] をパックして同時演算し、メモリ帯域を節約する。
-    inline void processBandStereo(double* __restrict dataL,
+    template <bool Saturate>
+    inline void processBandStereoT(double* __restrict dataL,
                                    double* __restrict dataR,
                                    int numSamples,
                                    const EQCoeffsSVF& c,
                                    double* __restrict stateL,
                                    double* __restrict stateR,
-                                   double saturation) noexcept
+                                   const SaturationMixV& mix) noexcept
     {
         // フィルタ状態を __m128d にパック: lower=L, upper=R
         __m128d ic1eq = _mm_set_pd(stateR[0], stateL[0]);
         __m128d ic2eq = _mm_set_pd(stateR[1], stateL[1]);
 
-        const __m128d a1  = _mm_set1_pd(c.a1);
-        const __m128d a2  = _mm_set1_pd(c.a2);
-        const __m128d a3  = _mm_set1_pd(c.a3);
-        const __m128d m0  = _mm_set1_pd(c.m0);
-        const __m128d m1  = _mm_set1_pd(c.m1);
-        const __m128d m2  = _mm_set1_pd(c.m2);
-        const __m128d two = _mm_set1_pd(2.0);
-        const __m128d cHigh = _mm_set1_pd(100.0);
-        const __m128d cLow  = _mm_set1_pd(-100.0);
+        const SVFStereoCoeffsV k(c);
 
         [[maybe_unused]] constexpr double DENORMAL_THRESHOLD = convo::numeric_policy::kDenormThresholdAudioState;
 
@@ -224,55 +314,256 @@ namespace
 
             // L[n] と R[n] を同時ロード
             const __m128d v0 = _mm_set_pd(dataR[n], dataL[n]);
+            const __m128d output = svfStereoTick<Saturate>(v0, ic1eq, ic2eq, k, mix);
 
-            const __m128d v3 = _mm_sub_pd(v0, ic2eq);
-            // FMA: a1*ic1eq + a2*v3
-            const __m128d v1 = _mm_fmadd_pd(a1, ic1eq, _mm_mul_pd(a2, v3));
-            // FMA: ic2eq + a2*ic1eq + a3*v3
-            const __m128d v2 = _mm_fmadd_pd(a2, ic1eq,
-                                _mm_fmadd_pd(a3, v3, ic2eq));
+            // L: lower element, R: upper element
+            _mm_store_sd(&dataL[n], output);
+            _mm_storeh_pd(&dataR[n], output);
+        }
 
-            ic1eq = _mm_fmsub_pd(two, v1, ic1eq);  // 2*v1 - ic1eq
-            ic2eq = _mm_fmsub_pd(two, v2, ic2eq);  // 2*v2 - ic2eq
+        // Denormal フラッシュ & NaN チェック (状態変数のみ) - SIMD最適化
+        ic1eq = killDenormalV(ic1eq);
+        ic2eq = killDenormalV(ic2eq);
 
-            // FMA: m0*v0 + m1*v1 + m2*v2
-            __m128d output = _mm_fmadd_pd(m0, v0,
-                              _mm_fmadd_pd(m1, v1,
-                               _mm_mul_pd(m2, v2)));
+        // 状態を書き戻す (L/Rチャンネルに分離)
+        _mm_storeu_pd(stateL, _mm_unpacklo_pd(ic1eq, ic2eq)); // [ic1eq_L, ic2eq_L]
+        _mm_storeu_pd(stateR, _mm_unpackhi_pd(ic1eq, ic2eq)); // [ic1eq_R, ic2eq_R]
+    }
 
-            if (saturation > 0.0)
+    inline void processBandStereo(double* __restrict dataL,
+                                  double* __restrict dataR,
+                                  int numSamples,
+                                  const EQCoeffsSVF& c,
+                                  double* __restrict stateL,
+                                  double* __restrict stateR,
+                                  double saturation) noexcept
+    {
+        const SaturationMixV mix(SaturationMix { saturation });
+        if (saturation > 0.0)
+            processBandStereoT<true>(dataL, dataR, numSamples, c, stateL, stateR, mix);
+        else
+            processBandStereoT<false>(dataL, dataR, numSamples, c, stateL, stateR, mix);
+    }
+
+    //--------------------------------------------------------------
+    // ★ Serial 用 fused cascade カーネル
+    //
+    // 連続する Stereo バンド列を「タイル (kFusedTileSamples) × バンドグループ (最大 kFusedGroupBands)」
+    // 単位で処理する。グループ内はサンプルごとに全バンドを通し、状態はレジスタに保持する
+    // (グループ幅はテンプレート引数でコンパイル時に固定)。タイルは L1 に収まるため、
+    // バンド数 N に対するブロック全体の走査は N 回 → 1 回 (L1 内の再走査のみ) となる。
+    // Denormal フラッシュはブロック末尾で 1 回だけ行い、processBandStereo の逐次処理とビット一致させる。
+    // 飽和ありも同じタイル構造のまま Saturate=true のインスタンスで処理する (飽和は各バンド出力に掛かり
+    // 状態の帰還路には入らないため、tanh の除算はサンプル間で重なり合い、直列依存を伸ばさない)。
+    //--------------------------------------------------------------
+    struct FusedStereoBand
+    {
+        const EQCoeffsSVF* coeffs;
+        double* stateL;
+        double* stateR;
+    };
+
+    constexpr int kFusedTileSamples = 256; // 256 * 2ch * 8B = 4KB
+    constexpr int kFusedGroupBands = 4;    // 状態 8 + 入出力でレジスタに収まる幅
+
+    template <int GroupBands, bool Saturate>
+    inline void processStereoGroupTile(double* __restrict dataL,
+                                       double* __restrict dataR,
+                                       int numSamples,
+                                       const FusedStereoBand* bands,
+                                       const SaturationMixV& mix,
+                                       bool flushDenormals) noexcept
+    {
+        SVFStereoCoeffsV k[GroupBands];
+        __m128d ic1eq[GroupBands];
+        __m128d ic2eq[GroupBands];
+        for (int b = 0; b < GroupBands; ++b)
+        {
+            k[b] = SVFStereoCoeffsV(*bands[b].coeffs);
+            ic1eq[b] = _mm_set_pd(bands[b].stateR[0], bands[b].stateL[0]);
+            ic2eq[b] = _mm_set_pd(bands[b].stateR[1], bands[b].stateL[1]);
+        }
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            __m128d v = _mm_set_pd(dataR[n], dataL[n]);
+            for (int b = 0; b < GroupBands; ++b)
+                v = svfStereoTick<Saturate>(v, ic1eq[b], ic2eq[b], k[b], mix);
+
+            _mm_store_sd(&dataL[n], v);
+            _mm_storeh_pd(&dataR[n], v);
+        }
+
+        for (int b = 0; b < GroupBands; ++b)
+        {
+            if (flushDenormals)
             {
-                const __m128d vSat = _mm_set1_pd(saturation);
-                const __m128d vOneMinusSat = _mm_set1_pd(1.0 - saturation);
-                output = _mm_add_pd(_mm_mul_pd(output, vOneMinusSat),
-                                    _mm_mul_pd(fastTanhV128Output(output), vSat));
+                ic1eq[b] = killDenormalV(ic1eq[b]);
+                ic2eq[b] = killDenormalV(ic2eq[b]);
             }
+            _mm_storeu_pd(bands[b].stateL, _mm_unpacklo_pd(ic1eq[b], ic2eq[b]));
+            _mm_storeu_pd(bands[b].stateR, _mm_unpackhi_pd(ic1eq[b], ic2eq[b]));
+        }
+    }
+
+    template <bool Saturate>
+    inline void processStereoCascadeFusedT(double* __restrict dataL,
+                                           double* __restrict dataR,
+                                           int numSamples,
+                                           const FusedStereoBand* bands,
+                                           int numBands,
+                                           const SaturationMixV& mix) noexcept
+    {
+        for (int offset = 0; offset < numSamples; offset += kFusedTileSamples)
+        {
+            const int tileLen = std::min(kFusedTileSamples, numSamples - offset);
+            const bool lastTile = (offset + tileLen >= numSamples);
+            double* tileL = dataL + offset;
+            double* tileR = dataR + offset;
+
+            int b = 0;
+            for (; b + kFusedGroupBands <= numBands; b += kFusedGroupBands)
+                processStereoGroupTile<kFusedGroupBands, Saturate>(tileL, tileR, tileLen, bands + b, mix, lastTile);
 
-            // NaN/Infチェック + 範囲クランプ (processBand と一貫性を保つ)
+            switch (numBands - b)
             {
-                const __m128d vMinZero = _mm_setzero_pd();
-                const __m128d vMaxRange = _mm_set1_pd(1.0e15);
-                output = sanitizeFiniteInRangeV(output, vMinZero, vMaxRange);
-                // ★ state 変数 NaN/Inf ガード (processBand と同等)
-                ic1eq = sanitizeFiniteInRangeV(ic1eq, vMinZero, vMaxRange);
-                ic2eq = sanitizeFiniteInRangeV(ic2eq, vMinZero, vMaxRange);
+                case 3: processStereoGroupTile<3, Saturate>(tileL, tileR, tileLen, bands + b, mix, lastTile); break;
+                case 2: processStereoGroupTile<2, Saturate>(tileL, tileR, tileLen, bands + b, mix, lastTile); break;
+                case 1: processStereoGroupTile<1, Saturate>(tileL, tileR, tileLen, bands + b, mix, lastTile); break;
+                default: break;
             }
+        }
+    }
 
-            // クランプ (-100, +100) で発散防止
-            output = _mm_min_pd(_mm_max_pd(output, cLow), cHigh);
+    inline void processStereoCascadeFused(double* __restrict dataL,
+                                          double* __restrict dataR,
+                                          int numSamples,
+                                          const FusedStereoBand* bands,
+                                          int numBands,
+                                          double saturation) noexcept
+    {
+        const SaturationMixV mix(SaturationMix { saturation });
+        if (saturation > 0.0)
+            processStereoCascadeFusedT<true>(dataL, dataR, numSamples, bands, numBands, mix);
+        else
+            processStereoCascadeFusedT<false>(dataL, dataR, numSamples, bands, numBands, mix);
+    }
 
-            // L: lower element, R: upper element
-            _mm_store_sd(&dataL[n], output);
-            _mm_storeh_pd(&dataR[n], output);
+    //--------------------------------------------------------------
+    // ★ Parallel 用 SoA SVF バンク (AVX2)
+    //
+    // Parallel 構造の各バンドは同一の src を入力とし互いに独立なため、4 バンドを __m256d の
+    // 各レーンに割り当てて同時に処理し、差分 (y - x) をレーン間で合算して accum へ加算する。
+    // バンドごとの work へのコピー / add / subtract のパスが不要になる。
+    // 1 バンド分の演算は processBand と同じ (飽和ミックス、出力/状態の NaN/Inf サニタイズ、±100 クランプ、
+    // ブロック末尾の Denormal フラッシュ)。飽和は processBandStereo と同じ 27/9 fastTanh を 4 レーンで評価する
+    // (L/R 単独バンドの従来スカラー経路とは |x| > 4.5 の飽和端でのみ値が異なる)。
+    //--------------------------------------------------------------
+    struct ParallelBankBand
+    {
+        const EQCoeffsSVF* coeffs;
+        double* state; // [ic1eq, ic2eq]
+    };
+
+    constexpr int kParallelBankLanes = 4;
+
+    inline __m256d sanitizeFiniteInRangeV256(__m256d value, __m256d maxAbsExclusive) noexcept
+    {
+        const __m256d diff = _mm256_sub_pd(value, value);
+        const __m256d finiteMask = _mm256_cmp_pd(diff, _mm256_setzero_pd(), _CMP_EQ_OQ);
+        const __m256d absV = _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+        const __m256d ltMaxMask = _mm256_cmp_pd(absV, maxAbsExclusive, _CMP_LT_OQ);
+        return _mm256_and_pd(value, _mm256_and_pd(finiteMask, ltMaxMask));
+    }
+
+    template <bool Saturate>
+    inline void accumulateParallelBankGroup(const double* __restrict src,
+                                            double* __restrict accum,
+                                            int numSamples,
+                                            const ParallelBankBand* bands,
+                                            int numLanes,
+                                            const SaturationMix& mix) noexcept
+    {
+        // 未使用レーンは m0=1 の恒等フィルタ (状態 0 のまま) とし、差分はレーンマスクで 0 にする
+        alignas(32) double a1[kParallelBankLanes] = {}, a2[kParallelBankLanes] = {}, a3[kParallelBankLanes] = {};
+        alignas(32) double m0[kParallelBankLanes] = { 1.0, 1.0, 1.0, 1.0 }, m1[kParallelBankLanes] = {}, m2[kParallelBankLanes] = {};
+        alignas(32) double s1[kParallelBankLanes] = {}, s2[kParallelBankLanes] = {};
+        alignas(32) double lane[kParallelBankLanes] = {};
+        for (int l = 0; l < numLanes; ++l)
+        {
+            const EQCoeffsSVF& c = *bands[l].coeffs;
+            a1[l] = c.a1; a2[l] = c.a2; a3[l] = c.a3;
+            m0[l] = c.m0; m1[l] = c.m1; m2[l] = c.m2;
+            s1[l] = bands[l].state[0];
+            s2[l] = bands[l].state[1];
+            lane[l] = std::bit_cast<double>(~uint64_t{0});
+        }
+
+        const __m256d vA1 = _mm256_load_pd(a1), vA2 = _mm256_load_pd(a2), vA3 = _mm256_load_pd(a3);
+        const __m256d vM0 = _mm256_load_pd(m0), vM1 = _mm256_load_pd(m1), vM2 = _mm256_load_pd(m2);
+        const __m256d laneMask = _mm256_load_pd(lane);
+        const __m256d two = _mm256_set1_pd(2.0);
+        const __m256d cHigh = _mm256_set1_pd(100.0);
+        const __m256d cLow = _mm256_set1_pd(-100.0);
+        const __m256d vMaxRange = _mm256_set1_pd(1.0e15);
+        const __m256d vSat = _mm256_set1_pd(mix.sat);
+        const __m256d vDry = _mm256_set1_pd(mix.dry);
+        __m256d ic1eq = _mm256_load_pd(s1);
+        __m256d ic2eq = _mm256_load_pd(s2);
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const __m256d v0 = _mm256_broadcast_sd(src + n);
+            const __m256d v3 = _mm256_sub_pd(v0, ic2eq);
+            const __m256d v1 = _mm256_fmadd_pd(vA1, ic1eq, _mm256_mul_pd(vA2, v3));
+            const __m256d v2 = _mm256_fmadd_pd(vA2, ic1eq, _mm256_fmadd_pd(vA3, v3, ic2eq));
+
+            ic1eq = _mm256_fmsub_pd(two, v1, ic1eq);
+            ic2eq = _mm256_fmsub_pd(two, v2, ic2eq);
+
+            __m256d output = _mm256_fmadd_pd(vM0, v0, _mm256_fmadd_pd(vM1, v1, _mm256_mul_pd(vM2, v2)));
+            if constexpr (Saturate)
+                output = _mm256_add_pd(_mm256_mul_pd(output, vDry),
+                                       _mm256_mul_pd(fastTanhV256Output(output), vSat));
+            output = sanitizeFiniteInRangeV256(output, vMaxRange);
+            output = _mm256_min_pd(_mm256_max_pd(output, cLow), cHigh);
+            ic1eq = sanitizeFiniteInRangeV256(ic1eq, vMaxRange);
+            ic2eq = sanitizeFiniteInRangeV256(ic2eq, vMaxRange);
+
+            // レーン合算: Σ (y_b - x)
+            const __m256d d = _mm256_and_pd(_mm256_sub_pd(output, v0), laneMask);
+            const __m128d d2 = _mm_add_pd(_mm256_castpd256_pd128(d), _mm256_extractf128_pd(d, 1));
+            const __m128d d1 = _mm_add_sd(d2, _mm_unpackhi_pd(d2, d2));
+            accum[n] += _mm_cvtsd_f64(d1);
         }
 
-        // Denormal フラッシュ & NaN チェック (状態変数のみ) - SIMD最適化
         ic1eq = killDenormalV(ic1eq);
         ic2eq = killDenormalV(ic2eq);
+        _mm256_store_pd(s1, ic1eq);
+        _mm256_store_pd(s2, ic2eq);
+        for (int l = 0; l < numLanes; ++l)
+        {
+            bands[l].state[0] = s1[l];
+            bands[l].state[1] = s2[l];
+        }
+    }
 
-        // 状態を書き戻す (L/Rチャンネルに分離)
-        _mm_storeu_pd(stateL, _mm_unpacklo_pd(ic1eq, ic2eq)); // [ic1eq_L, ic2eq_L]
-        _mm_storeu_pd(stateR, _mm_unpackhi_pd(ic1eq, ic2eq)); // [ic1eq_R, ic2eq_R]
+    inline void accumulateParallelBank(const double* __restrict src,
+                                       double* __restrict accum,
+                                       int numSamples,
+                                       const ParallelBankBand* bands,
+                                       int numBands,
+                                       double saturation) noexcept
+    {
+        const SaturationMix mix(saturation);
+        for (int b = 0; b < numBands; b += kParallelBankLanes)
+        {
+            const int lanes = std::min(kParallelBankLanes, numBands - b);
+            if (saturation > 0.0)
+                accumulateParallelBankGroup<true>(src, accum, numSamples, bands + b, lanes, mix);
+            else
+                accumulateParallelBankGroup<false>(src, accum, numSamples, bands + b, lanes, mix);
+        }
     }
 
     // ── 追加: AVX2 Gain Ramp ──
@@ -353,64 +644,182 @@ double EQProcessor::calculateAGCGain(double inputEnv, double outputEnv) const no
     return juce::jlimit(static_cast<double>(AGC_MIN_GAIN), static_cast<double>(AGC_MAX_GAIN), ratio);
 }
 
+//--------------------------------------------------------------
+// バンド係数ランプ更新 (Private / Audio Thread)
+// 係数キャッシュのハッシュが前回と同じなら何もしない (定常状態ゼロオーバーヘッド)。
+// 変化したバンドのみ現在係数から新係数へ bandRampSamples かけて補間する。
+// 新たに有効化されたバンドは従来通り即時適用する。
+//--------------------------------------------------------------
+void EQProcessor::updateBandCoeffRamps(const EQCoeffCache& cache) noexcept
+{
+    if (rtBandCoeffSourceValid && cache.paramsHash == rtBandCoeffSourceHash)
+        return;
+
+    rtBandCoeffSourceHash = cache.paramsHash;
+    rtBandCoeffSourceValid = true;
+
+    const bool rampEnabled = bandRampSamples > kBandCoeffControlSamples;
+    for (int i = 0; i < NUM_BANDS; ++i)
+    {
+        const std::uint32_t bit = 1u << i;
+        if (!cache.bandActive[i])
+        {
+            rtBandCoeffValidMask &= ~bit;
+            rtBandRampMask &= ~bit;
+            continue;
+        }
+
+        const EQCoeffsSVF& target = cache.coeffs[i];
+        if (rampEnabled && (rtBandCoeffValidMask & bit) != 0)
+        {
+            if (std::memcmp(&target, &rtBandCoeffTarget[i], sizeof(EQCoeffsSVF)) != 0)
+            {
+                rtBandCoeffTarget[i] = target;
+                rtBandRampRemaining[i] = bandRampSamples;
+                rtBandRampMask |= bit;
+            }
+        }
+        else
+        {
+            rtBandCoeffCurrent[i] = target;
+            rtBandCoeffTarget[i] = target;
+            rtBandRampRemaining[i] = 0;
+            rtBandCoeffValidMask |= bit;
+            rtBandRampMask &= ~bit;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+// ランプ中バンドの処理 (Private / Audio Thread)
+// kBandCoeffControlSamples ごとに係数を目標へ線形に近づけ、その区間を固定係数で処理する。
+// g/k/m0..m2 を補間し、a1..a3 は TPT SVF の定義 (a1 = 1/(1+g(g+k)), a2 = g·a1, a3 = g·a2) から再計算する。
+//--------------------------------------------------------------
+void EQProcessor::processBandRamped(int band, double* dataL, double* dataR, int numSamples,
+                                    EQChannelMode mode, double saturation) noexcept
+{
+    EQCoeffsSVF& cur = rtBandCoeffCurrent[band];
+    const EQCoeffsSVF& tgt = rtBandCoeffTarget[band];
+    int remaining = rtBandRampRemaining[band];
+
+    double* stateL = filterState[0][band].data();
+    double* stateR = filterState[1][band].data();
+    const bool hasL = (dataL != nullptr) && mode != EQChannelMode::Right;
+    const bool hasR = (dataR != nullptr) && mode != EQChannelMode::Left;
+
+    for (int start = 0; start < numSamples; start += kBandCoeffControlSamples)
+    {
+        const int n = std::min(kBandCoeffControlSamples, numSamples - start);
+
+        if (remaining > n)
+        {
+            const double t = static_cast<double>(n) / static_cast<double>(remaining);
+            cur.g  += (tgt.g  - cur.g)  * t;
+            cur.k  += (tgt.k  - cur.k)  * t;
+            cur.m0 += (tgt.m0 - cur.m0) * t;
+            cur.m1 += (tgt.m1 - cur.m1) * t;
+            cur.m2 += (tgt.m2 - cur.m2) * t;
+            const double denominator = 1.0 + cur.g * (cur.g + cur.k);
+            if (denominator > 1.0e-15)
+            {
+                cur.a1 = 1.0 / denominator;
+                cur.a2 = cur.g * cur.a1;
+                cur.a3 = cur.g * cur.a2;
+            }
+            else
+            {
+                cur = tgt;
+                remaining = n;
+            }
+            remaining -= n;
+        }
+        else
+        {
+            cur = tgt;
+            remaining = 0;
+        }
+
+        if (hasL && hasR)
+        {
+            processBandStereo(dataL + start, dataR + start, n, cur, stateL, stateR, saturation);
+        }
+        else
+        {
+            if (hasL)
+                processBand(dataL + start, n, cur, stateL, saturation);
+            if (hasR)
+                processBand(dataR + start, n, cur, stateR, saturation);
+        }
+    }
+
+    rtBandRampRemaining[band] = remaining;
+    if (remaining <= 0)
+    {
+        cur = tgt;
+        rtBandRampMask &= ~(1u << band);
+    }
+}
+
+//--------------------------------------------------------------
+// AGC入力レベルキャッシュ (Private)
+// フィルタ処理前のブロックをサブブロックに分割し、各サブブロックの RMS
+// (全チャンネルの最大値) を cachedInputSubRMS へ格納する。
+//--------------------------------------------------------------
+void EQProcessor::cacheAGCInputLevels(const juce::dsp::AudioBlock<double>& block) noexcept
+{
+    const int numChannels = std::min((int)block.getNumChannels(), MAX_CHANNELS);
+    const int numSamples = (int)block.getNumSamples();
+    const int subLen = agcSubBlockLength(numSamples);
+
+    int count = 0;
+    for (int start = 0; start < numSamples && count < kAgcMaxSubBlocks; start += subLen)
+    {
+        const int n = std::min(subLen, numSamples - start);
+        double rmsMax = 0.0;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const double rms = calculateRMS(block.getChannelPointer(ch) + start, n);
+            if (rms > rmsMax)
+                rmsMax = rms;
+        }
+        cachedInputSubRMS[static_cast<size_t>(count++)] = rmsMax;
+    }
+    cachedInputSubCount = count;
+}
+
 //--------------------------------------------------------------
 // AGC処理 (Private)
-// ★ [P2-3] 注意: AGC はブロックレート（コールバック単位）で RMS エンベロープを更新する。
-//   アタック/リリースの実効時間分解能はブロックサイズに依存する。
-//   ブロックサイズが大きい（1024 等）場合 + 速いアタック設定では、
-//   意図通りの追従速度にならない可能性がある。
+// ★ エンベロープ追従はサブブロックレート (agcSubBlockLength) で行う。
+//   1 ホップ n サンプルの係数は 1 - exp(-n / (sr·τ)) (agc*CoeffTable[n]) であり、
+//   サブブロック内で入力レベル一定とみなした 1 次追従器を n サンプル進めた値と厳密に一致する。
+//   以前のブロックレート更新と異なり、追従速度はコールバックのブロックサイズに依存しない。
+//   ゲインはサブブロックごとに線形ランプ (AVX2) で適用する。
 //--------------------------------------------------------------
 void EQProcessor::processAGC(juce::dsp::AudioBlock<double>& block)
 {
     const int numChannels = std::min((int)block.getNumChannels(), MAX_CHANNELS);
     const int numSamples = (int)block.getNumSamples();
+    if (numSamples <= 0)
+        return;
 
     const double attackCoeff = convo::consumeAtomic(agcAttackCoeff, std::memory_order_acquire);   // acquire: prepareToPlay の publishAtomic release と HB
     const double releaseCoeff = convo::consumeAtomic(agcReleaseCoeff, std::memory_order_acquire); // acquire: prepareToPlay の publishAtomic release と HB
     const double smoothCoeff = convo::consumeAtomic(agcSmoothCoeff, std::memory_order_acquire);   // acquire: prepareToPlay の publishAtomic release と HB
 
-    double blockAttackCoeff;
-    double blockReleaseCoeff;
-    double blockSmoothCoeff;
-
     const double* activeAttackCoeffTable = agcAttackCoeffTable.get();
     const double* activeReleaseCoeffTable = agcReleaseCoeffTable.get();
     const double* activeSmoothCoeffTable = agcSmoothCoeffTable.get();
     const int activeCoeffTableCapacity = agcCoeffTableCapacity;
+    const bool useCoeffTable = activeAttackCoeffTable
+                            && activeReleaseCoeffTable
+                            && activeSmoothCoeffTable;
 
-    if (numSamples >= 0
-        && numSamples < activeCoeffTableCapacity
-        && activeAttackCoeffTable
-        && activeReleaseCoeffTable
-        && activeSmoothCoeffTable)
-    {
-        blockAttackCoeff = activeAttackCoeffTable[numSamples];
-        blockReleaseCoeff = activeReleaseCoeffTable[numSamples];
-        blockSmoothCoeff = activeSmoothCoeffTable[numSamples];
-    }
-    else
-    {
-        const double attackEpsilon = 1.0 - attackCoeff;
-        const double releaseEpsilon = 1.0 - releaseCoeff;
-        const double smoothEpsilon = 1.0 - smoothCoeff;
-        blockAttackCoeff = std::min(1.0, static_cast<double>(numSamples) * attackEpsilon);
-        blockReleaseCoeff = std::min(1.0, static_cast<double>(numSamples) * releaseEpsilon);
-        blockSmoothCoeff = std::min(1.0, static_cast<double>(numSamples) * smoothEpsilon);
-    }
-
-    double inputRMS = cachedInputRMS;
-    double outputRMS = 0.0;
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        const double* data = block.getChannelPointer(ch);
-        const double rms = calculateRMS(data, numSamples);
-        if (rms > outputRMS)
-            outputRMS = rms;
-    }
+    const double attackEpsilon = 1.0 - attackCoeff;
+    const double releaseEpsilon = 1.0 - releaseCoeff;
+    const double smoothEpsilon = 1.0 - smoothCoeff;
 
     static constexpr double MAX_ENV_VALUE = 1000.0;
-    if (!isFiniteNoLibm(inputRMS) || inputRMS > MAX_ENV_VALUE)   inputRMS = MAX_ENV_VALUE;
-    if (!isFiniteNoLibm(outputRMS) || outputRMS > MAX_ENV_VALUE) outputRMS = MAX_ENV_VALUE;
+    constexpr double DENORM_THRESH = convo::numeric_policy::kDenormThresholdAudioState;
 
     double envIn = rtAgcEnvInputShadow;
     double envOut = rtAgcEnvOutputShadow;
@@ -419,25 +828,63 @@ void EQProcessor::processAGC(juce::dsp::AudioBlock<double>& block)
     if (!isFiniteNoLibm(envOut)) envOut = 0.0;
     if (!isFiniteNoLibm(currentGain)) currentGain = 1.0;
 
-    const double inAlpha = (inputRMS > envIn) ? blockAttackCoeff : blockReleaseCoeff;
-    const double outAlpha = (outputRMS > envOut) ? blockAttackCoeff : blockReleaseCoeff;
-    envIn = envIn * (1.0 - inAlpha) + inputRMS * inAlpha;
-    envOut = envOut * (1.0 - outAlpha) + outputRMS * outAlpha;
+    const int subLen = agcSubBlockLength(numSamples);
+    int subIndex = 0;
+    for (int start = 0; start < numSamples; start += subLen, ++subIndex)
+    {
+        const int n = std::min(subLen, numSamples - start);
 
-    constexpr double DENORM_THRESH = convo::numeric_policy::kDenormThresholdAudioState;
-    if (envIn < DENORM_THRESH) envIn = 0.0;
-    if (envOut < DENORM_THRESH) envOut = 0.0;
+        double hopAttackCoeff;
+        double hopReleaseCoeff;
+        double hopSmoothCoeff;
+        if (useCoeffTable && n < activeCoeffTableCapacity)
+        {
+            hopAttackCoeff = activeAttackCoeffTable[n];
+            hopReleaseCoeff = activeReleaseCoeffTable[n];
+            hopSmoothCoeff = activeSmoothCoeffTable[n];
+        }
+        else
+        {
+            hopAttackCoeff = std::min(1.0, static_cast<double>(n) * attackEpsilon);
+            hopReleaseCoeff = std::min(1.0, static_cast<double>(n) * releaseEpsilon);
+            hopSmoothCoeff = std::min(1.0, static_cast<double>(n) * smoothEpsilon);
+        }
 
-    const double targetGain = calculateAGCGain(envIn, envOut);
-    const double nextGain = currentGain * (1.0 - blockSmoothCoeff) + targetGain * blockSmoothCoeff;
+        double inputRMS = (subIndex < cachedInputSubCount)
+            ? cachedInputSubRMS[static_cast<size_t>(subIndex)]
+            : 0.0;
+        double outputRMS = 0.0;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const double rms = calculateRMS(block.getChannelPointer(ch) + start, n);
+            if (rms > outputRMS)
+                outputRMS = rms;
+        }
+
+        if (!isFiniteNoLibm(inputRMS) || inputRMS > MAX_ENV_VALUE)   inputRMS = MAX_ENV_VALUE;
+        if (!isFiniteNoLibm(outputRMS) || outputRMS > MAX_ENV_VALUE) outputRMS = MAX_ENV_VALUE;
+
+        const double inAlpha = (inputRMS > envIn) ? hopAttackCoeff : hopReleaseCoeff;
+        const double outAlpha = (outputRMS > envOut) ? hopAttackCoeff : hopReleaseCoeff;
+        envIn = envIn * (1.0 - inAlpha) + inputRMS * inAlpha;
+        envOut = envOut * (1.0 - outAlpha) + outputRMS * outAlpha;
+
+        if (envIn < DENORM_THRESH) envIn = 0.0;
+        if (envOut < DENORM_THRESH) envOut = 0.0;
+
+        const double targetGain = calculateAGCGain(envIn, envOut);
+        const double nextGain = currentGain * (1.0 - hopSmoothCoeff) + targetGain * hopSmoothCoeff;
+
+        const double gainIncrement = (nextGain - currentGain) / static_cast<double>(n);
+        for (int ch = 0; ch < numChannels; ++ch)
+            applyGainRamp_AVX2(block.getChannelPointer(ch) + start, n, currentGain, gainIncrement);
+
+        currentGain = nextGain;
+    }
 
     rtAgcEnvInputShadow = envIn;
     rtAgcEnvOutputShadow = envOut;
-    rtAgcCurrentGainShadow = nextGain;
-
-    const double gainIncrement = (nextGain - currentGain) / static_cast<double>(numSamples);
-    for (int ch = 0; ch < numChannels; ++ch)
-        applyGainRamp_AVX2(block.getChannelPointer(ch), numSamples, currentGain, gainIncrement);
+    rtAgcCurrentGainShadow = currentGain;
 }
 
 //--------------------------------------------------------------
@@ -481,7 +928,7 @@ bool EQProcessor::isAudioBlockSilent(const juce::dsp::AudioBlock<double>& block,
 //--------------------------------------------------------------
 void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
 {
-    convo::RCUReaderGuard guard(rcuReader);
+    convo::RCUReaderGuard guard(rcuReader, m_rtReaderPinned);
     const auto* stateSnapshot = loadCurrentState(std::memory_order_acquire); // acquire: exchangeCurrentState/publishCurrentState の release/acq_rel と HB
     // Audio Thread 入口で MXCSR の FTZ/DAZ を関数スコープで保証する。
     // 呼び出し元設定に依存せず、EQ 単体でもデノーマル起因の負荷増大を防ぐ。
@@ -532,7 +979,6 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
     const int activeParallelBufferCapacity = parallelBufferCapacity;
 
     double* activeStructureOldOutBuffer = structureOldOutBuffer.get();
-    double* activeStructureNewOutBuffer = structureNewOutBuffer.get();
     const int activeStructureXfadeBufferCapacity = structureXfadeBufferCapacity;
 
     const int numSamples = (int)block.getNumSamples();
@@ -625,18 +1071,7 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
         : false;
     // ✅ フィルタ処理前に入力レベルをキャッシュ (AGCが有効な場合のみ)
     if (isAgcEnabled)
-    {
-        double& cachedInputRMSRef = cachedInputRMS;
-        cachedInputRMSRef = 0.0;
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            const double* data = block.getChannelPointer(ch);
-            const double rms = calculateRMS(data, numSamples);
-
-            if (rms > cachedInputRMSRef)
-                cachedInputRMSRef = rms;
-        }
-    }
+        cacheAGCInputLevels(block);
 
     // ── 最適化: アクティブなバンドノードを事前にスタックへロード ──
     // チャンネルごとのループ内で atomic load を繰り返すと負荷が高いため、
@@ -666,8 +1101,10 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
 
     double* msWork = msWorkBuffer.get();
 
+    // length: 先頭から処理するサンプル数 (構造切替では旧構造をフェード区間だけ処理する)
     const auto processSerial = [&](double* dataL,
                                    double* dataR,
+                                   int length,
                                    FilterStateStorage& states)
     {
         const bool canProcessMonoMidSide = (msWork != nullptr);
@@ -678,69 +1115,76 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
 
             if (mode == EQChannelMode::Stereo && numChannels >= 2)
             {
-                processBandStereo(dataL, dataR, numSamples,
-                                  band.node->coeffs,
-                                  states[0][band.index].data(),
-                                  states[1][band.index].data(),
-                                  saturation);
+                // ★ 連続する Stereo バンドは fused cascade でまとめて処理する
+                std::array<FusedStereoBand, NUM_BANDS> fused;
+                int numFused = 0;
+                int runEnd = i;
+                while (runEnd < numActiveBands && activeBands[runEnd].node->mode == EQChannelMode::Stereo)
+                {
+                    const auto& b = activeBands[runEnd];
+                    fused[numFused++] = { &b.node->coeffs, states[0][b.index].data(), states[1][b.index].data() };
+                    ++runEnd;
+                }
+
+                if (numFused > 1)
+                    processStereoCascadeFused(dataL, dataR, length, fused.data(), numFused, saturation);
+                else
+                    processBandStereo(dataL, dataR, length,
+                                      band.node->coeffs,
+                                      states[0][band.index].data(),
+                                      states[1][band.index].data(),
+                                      saturation);
+                i = runEnd - 1;
             }
-            else if (mode == EQChannelMode::Mid)
+            else if ((mode == EQChannelMode::Mid || mode == EQChannelMode::Side) && numChannels < 2)
             {
-                if (!canProcessMonoMidSide) continue;
-                if (numChannels < 2)
+                if (mode == EQChannelMode::Mid)
                 {
+                    if (!canProcessMonoMidSide) continue;
                     // Mono→Mid: dataLそのまま処理、R=M
-                    processBand(dataL, numSamples, band.node->coeffs,
+                    processBand(dataL, length, band.node->coeffs,
                                 states[2][band.index].data(), saturation);
-                    juce::FloatVectorOperations::copy(dataR, dataL, numSamples);
-                    continue;
+                    juce::FloatVectorOperations::copy(dataR, dataL, length);
                 }
-                // MとSをエンコード
-                juce::FloatVectorOperations::copy(msWork, dataL, numSamples);
-                juce::FloatVectorOperations::add(msWork, dataR, numSamples);
-                juce::FloatVectorOperations::multiply(msWork, 0.5, numSamples);
-                juce::FloatVectorOperations::copy(msWork + numSamples, dataL, numSamples);
-                juce::FloatVectorOperations::subtract(msWork + numSamples, dataR, numSamples);
-                juce::FloatVectorOperations::multiply(msWork + numSamples, 0.5, numSamples);
-                // Mid成分のみ処理
-                processBand(msWork, numSamples, band.node->coeffs,
-                            states[2][band.index].data(), saturation);
-                // デコード: L=M+S, R=M-S
-                for (int n = 0; n < numSamples; ++n) {
-                    dataL[n] = msWork[n] + msWork[numSamples + n];
-                    dataR[n] = msWork[n] - msWork[numSamples + n];
+                else
+                {
+                    // Mono→Side: Side=0出力
+                    juce::FloatVectorOperations::clear(dataL, length);
                 }
             }
-            else if (mode == EQChannelMode::Side)
+            else if (mode == EQChannelMode::Mid || mode == EQChannelMode::Side)
             {
-                if (numChannels < 2)
+                // ★ 連続する Mid/Side バンドを 1 グループとして扱い、エンコード/デコードを 1 回に集約する。
+                //    L/R/Stereo バンドが挟まる位置でグループを切るため、バンド順序の意味は従来どおり。
+                const int groupEnd = EQMidSideRouting::groupEnd(i, numActiveBands, [&](int g) {
+                    const EQChannelMode m = activeBands[g].node->mode;
+                    return m == EQChannelMode::Mid || m == EQChannelMode::Side;
+                });
+
+                if (!canProcessMonoMidSide)
                 {
-                    // Mono→Side: Side=0出力
-                    juce::FloatVectorOperations::clear(dataL, numSamples);
+                    i = groupEnd - 1;
                     continue;
                 }
-                // MとSをエンコード
-                juce::FloatVectorOperations::copy(msWork, dataL, numSamples);
-                juce::FloatVectorOperations::add(msWork, dataR, numSamples);
-                juce::FloatVectorOperations::multiply(msWork, 0.5, numSamples);
-                juce::FloatVectorOperations::copy(msWork + numSamples, dataL, numSamples);
-                juce::FloatVectorOperations::subtract(msWork + numSamples, dataR, numSamples);
-                juce::FloatVectorOperations::multiply(msWork + numSamples, 0.5, numSamples);
-                // Side成分のみ処理
-                processBand(msWork + numSamples, numSamples, band.node->coeffs,
-                            states[3][band.index].data(), saturation);
-                // デコード: L=M+S, R=M-S
-                for (int n = 0; n < numSamples; ++n) {
-                    dataL[n] = msWork[n] + msWork[numSamples + n];
-                    dataR[n] = msWork[n] - msWork[numSamples + n];
-                }
+
+                // Mid→msWork[0..n], Side→msWork[n..2n] をグループ内の順序どおり処理
+                EQMidSideRouting::processSerialGroup(
+                    dataL, dataR, msWork, length, i, groupEnd,
+                    [&](int g) { return activeBands[g].node->mode == EQChannelMode::Mid; },
+                    [&](int g, double* component) {
+                        const auto& msBand = activeBands[g];
+                        const int stateSet = (msBand.node->mode == EQChannelMode::Mid) ? 2 : 3;
+                        processBand(component, length, msBand.node->coeffs,
+                                    states[stateSet][msBand.index].data(), saturation);
+                    });
+                i = groupEnd - 1;
             }
             else
             {
                 if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Left) && numChannels > 0)
-                    processBand(dataL, numSamples, band.node->coeffs, states[0][band.index].data(), saturation);
+                    processBand(dataL, length, band.node->coeffs, states[0][band.index].data(), saturation);
                 if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Right) && numChannels > 1)
-                    processBand(dataR, numSamples, band.node->coeffs, states[1][band.index].data(), saturation);
+                    processBand(dataR, length, band.node->coeffs, states[1][band.index].data(), saturation);
             }
         }
     };
@@ -749,115 +1193,96 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
                                      const double* srcR,
                                      double* dstL,
                                      double* dstR,
+                                     int length,
                                      FilterStateStorage& states)
     {
         if (!(activeParallelWorkBuffer && activeParallelAccumBuffer))
         {
-            std::memcpy(dstL, srcL, sizeof(double) * static_cast<size_t>(numSamples));
+            std::memcpy(dstL, srcL, sizeof(double) * static_cast<size_t>(length));
             if (numChannels > 1)
-                std::memcpy(dstR, srcR, sizeof(double) * static_cast<size_t>(numSamples));
+                std::memcpy(dstR, srcR, sizeof(double) * static_cast<size_t>(length));
             return;
         }
 
         double* workL = activeParallelWorkBuffer;
-        double* workR = activeParallelWorkBuffer + numSamples;
+        double* workR = activeParallelWorkBuffer + length;
         double* accumL = activeParallelAccumBuffer;
-        double* accumR = activeParallelAccumBuffer + numSamples;
-        juce::FloatVectorOperations::clear(accumL, numSamples);
+        double* accumR = activeParallelAccumBuffer + length;
+        juce::FloatVectorOperations::clear(accumL, length);
         if (numChannels > 1)
-            juce::FloatVectorOperations::clear(accumR, numSamples);
+            juce::FloatVectorOperations::clear(accumR, length);
+
+        // ★ L/R/Stereo バンドは飽和の有無にかかわらず SoA バンクで一括処理する (M/S バンドは従来経路)
+        {
+            std::array<ParallelBankBand, NUM_BANDS> bankL;
+            std::array<ParallelBankBand, NUM_BANDS> bankR;
+            int numBankL = 0;
+            int numBankR = 0;
+            for (int i = 0; i < numActiveBands; ++i)
+            {
+                const auto& band = activeBands[i];
+                const EQChannelMode mode = band.node->mode;
+                if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Left) && numChannels > 0)
+                    bankL[numBankL++] = { &band.node->coeffs, states[0][band.index].data() };
+                if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Right) && numChannels > 1)
+                    bankR[numBankR++] = { &band.node->coeffs, states[1][band.index].data() };
+            }
+            accumulateParallelBank(srcL, accumL, length, bankL.data(), numBankL, saturation);
+            if (numBankR > 0)
+                accumulateParallelBank(srcR, accumR, length, bankR.data(), numBankR, saturation);
+        }
 
+        bool msEncoded = false;
         for (int i = 0; i < numActiveBands; ++i)
         {
             const auto& band = activeBands[i];
             const EQChannelMode mode = band.node->mode;
 
-            if (mode == EQChannelMode::Stereo && numChannels >= 2)
-            {
-                juce::FloatVectorOperations::copy(workL, srcL, numSamples);
-                juce::FloatVectorOperations::copy(workR, srcR, numSamples);
-                processBandStereo(workL, workR, numSamples,
-                                  band.node->coeffs,
-                                  states[0][band.index].data(),
-                                  states[1][band.index].data(),
-                                  saturation);
-                juce::FloatVectorOperations::add(accumL, workL, numSamples);
-                juce::FloatVectorOperations::subtract(accumL, srcL, numSamples);
-                juce::FloatVectorOperations::add(accumR, workR, numSamples);
-                juce::FloatVectorOperations::subtract(accumR, srcR, numSamples);
-            }
-            else if (mode == EQChannelMode::Mid || mode == EQChannelMode::Side)
+            if (mode != EQChannelMode::Mid && mode != EQChannelMode::Side)
+                continue;
+
+            if (numChannels < 2)
             {
-                if (numChannels < 2)
-                {
-                    if (mode == EQChannelMode::Mid)
-                    {
-                        // Mono→Mid: srcLそのまま、accum加算
-                        juce::FloatVectorOperations::copy(workL, srcL, numSamples);
-                        processBand(workL, numSamples, band.node->coeffs,
-                                    states[2][band.index].data(), saturation);
-                        juce::FloatVectorOperations::add(accumL, workL, numSamples);
-                        juce::FloatVectorOperations::subtract(accumL, srcL, numSamples);
-                    }
-                    // Mono→Side: 何もしない（Side=0）
-                    continue;
-                }
-                // ① MとSをエンコード → workM, workS (msWork[0..n]=M, [n..2n]=S)
-                juce::FloatVectorOperations::copy(msWork, srcL, numSamples);
-                juce::FloatVectorOperations::add(msWork, srcR, numSamples);
-                juce::FloatVectorOperations::multiply(msWork, 0.5, numSamples);
-                juce::FloatVectorOperations::copy(msWork + numSamples, srcL, numSamples);
-                juce::FloatVectorOperations::subtract(msWork + numSamples, srcR, numSamples);
-                juce::FloatVectorOperations::multiply(msWork + numSamples, 0.5, numSamples);
-
-                // ② 処理: Mid→msWork[0..n], Side→msWork[n..2n]
-                auto* targetState = (mode == EQChannelMode::Mid)
-                    ? states[2][band.index].data()
-                    : states[3][band.index].data();
-                auto* targetBuf = (mode == EQChannelMode::Mid)
-                    ? msWork
-                    : (msWork + numSamples);
-                processBand(targetBuf, numSamples, band.node->coeffs, targetState, saturation);
-
-                // ③ デコード → workL, workRへ
-                for (int n = 0; n < numSamples; ++n)
+                if (mode == EQChannelMode::Mid)
                 {
-                    workL[n] = msWork[n] + msWork[numSamples + n];
-                    workR[n] = msWork[n] - msWork[numSamples + n];
-                }
-                // ④ 差分加算
-                for (int n = 0; n < numSamples; ++n)
-                {
-                    accumL[n] += workL[n] - srcL[n];
-                    accumR[n] += workR[n] - srcR[n];
+                    // Mono→Mid: srcLそのまま、accum加算
+                    juce::FloatVectorOperations::copy(workL, srcL, length);
+                    processBand(workL, length, band.node->coeffs,
+                                states[2][band.index].data(), saturation);
+                    juce::FloatVectorOperations::add(accumL, workL, length);
+                    juce::FloatVectorOperations::subtract(accumL, srcL, length);
                 }
+                // Mono→Side: 何もしない（Side=0）
+                continue;
             }
-            else
-            {
-                if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Left) && numChannels > 0)
-                {
-                    juce::FloatVectorOperations::copy(workL, srcL, numSamples);
-                    processBand(workL, numSamples, band.node->coeffs, states[0][band.index].data(), saturation);
-                    juce::FloatVectorOperations::add(accumL, workL, numSamples);
-                    juce::FloatVectorOperations::subtract(accumL, srcL, numSamples);
-                }
+            if (msWork == nullptr) continue;
 
-                if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Right) && numChannels > 1)
-                {
-                    juce::FloatVectorOperations::copy(workR, srcR, numSamples);
-                    processBand(workR, numSamples, band.node->coeffs, states[1][band.index].data(), saturation);
-                    juce::FloatVectorOperations::add(accumR, workR, numSamples);
-                    juce::FloatVectorOperations::subtract(accumR, srcR, numSamples);
-                }
+            // ① MとSをエンコード → msWork[0..n]=M, [n..2n]=S
+            //    Parallel では全バンドが同一の src を入力とするため、ブロック内で 1 回だけ行う。
+            if (!msEncoded)
+            {
+                EQMidSideRouting::encode(srcL, srcR, msWork, msWork + length, length);
+                msEncoded = true;
             }
+
+            // ② 対象成分のみ workL にコピーして処理 (エンコード結果は保持) → ③ デコード → ④ 差分加算
+            const bool isMid = (mode == EQChannelMode::Mid);
+            auto* targetState = isMid
+                ? states[2][band.index].data()
+                : states[3][band.index].data();
+            EQMidSideRouting::accumulateParallelBand(
+                srcL, srcR, msWork, msWork + length, workL, accumL, accumR, length, isMid,
+                [&](double* component) {
+                    processBand(component, length, band.node->coeffs, targetState, saturation);
+                });
         }
 
-        juce::FloatVectorOperations::copy(dstL, srcL, numSamples);
-        juce::FloatVectorOperations::add(dstL, accumL, numSamples);
+        juce::FloatVectorOperations::copy(dstL, srcL, length);
+        juce::FloatVectorOperations::add(dstL, accumL, length);
         if (numChannels > 1)
         {
-            juce::FloatVectorOperations::copy(dstR, srcR, numSamples);
-            juce::FloatVectorOperations::add(dstR, accumR, numSamples);
+            juce::FloatVectorOperations::copy(dstR, srcR, length);
+            juce::FloatVectorOperations::add(dstR, accumR, length);
         }
     };
 
@@ -869,52 +1294,87 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
                                        && activeParallelBufferCapacity >= (numSamples * numChannels);
     const bool canUseStructureXfade = canUseParallelBuffers
                                       && activeStructureOldOutBuffer != nullptr
-                                      && activeStructureNewOutBuffer != nullptr
                                       && activeStructureXfadeBufferCapacity >= (numSamples * numChannels);
 
     auto* blockL = block.getChannelPointer(0);
     double* blockR = (numChannels > 1) ? block.getChannelPointer(1) : nullptr;
 
-    if (requestedMode != activeMode && canUseStructureXfade)
+    // ★ 各チャンネルに掛かる L/R/Stereo バンドが高々 1 本で M/S バンドが無ければ、
+    //    Serial (y = H·x) と Parallel (y = x + (H·x - x)) は同じ出力になるためフェード不要
+    bool structuresEquivalent = true;
     {
-        double* srcL = activeParallelInputBuffer;
-        double* srcR = (numChannels > 1) ? (activeParallelInputBuffer + numSamples) : nullptr;
-        std::memcpy(srcL, blockL, sizeof(double) * static_cast<size_t>(numSamples));
-        if (numChannels > 1)
-            std::memcpy(srcR, blockR, sizeof(double) * static_cast<size_t>(numSamples));
+        int bandsOnL = 0;
+        int bandsOnR = 0;
+        for (int i = 0; i < numActiveBands && structuresEquivalent; ++i)
+        {
+            const EQChannelMode mode = activeBands[i].node->mode;
+            if (mode == EQChannelMode::Mid || mode == EQChannelMode::Side)
+                structuresEquivalent = false;
+            if (mode == EQChannelMode::Stereo || mode == EQChannelMode::Left)
+                ++bandsOnL;
+            if (mode == EQChannelMode::Stereo || mode == EQChannelMode::Right)
+                ++bandsOnR;
+            if (bandsOnL > 1 || bandsOnR > 1)
+                structuresEquivalent = false;
+        }
+    }
 
-        double* oldL = activeStructureOldOutBuffer;
-        double* oldR = (numChannels > 1) ? (activeStructureOldOutBuffer + numSamples) : nullptr;
-        double* newL = activeStructureNewOutBuffer;
-        double* newR = (numChannels > 1) ? (activeStructureNewOutBuffer + numSamples) : nullptr;
-        std::memcpy(oldL, srcL, sizeof(double) * static_cast<size_t>(numSamples));
-        std::memcpy(newL, srcL, sizeof(double) * static_cast<size_t>(numSamples));
-        if (numChannels > 1)
+    const auto processActiveStructure = [&](FilterStructure mode)
+    {
+        if (mode == FilterStructure::Serial || !canUseParallelBuffers)
         {
-            std::memcpy(oldR, srcR, sizeof(double) * static_cast<size_t>(numSamples));
-            std::memcpy(newR, srcR, sizeof(double) * static_cast<size_t>(numSamples));
+            processSerial(blockL, blockR, numSamples, activeFilterState);
         }
+        else
+        {
+            double* srcL = activeParallelInputBuffer;
+            double* srcR = (numChannels > 1) ? (activeParallelInputBuffer + numSamples) : nullptr;
+            std::memcpy(srcL, blockL, sizeof(double) * static_cast<size_t>(numSamples));
+            if (numChannels > 1)
+                std::memcpy(srcR, blockR, sizeof(double) * static_cast<size_t>(numSamples));
+            processParallel(srcL, srcR, blockL, blockR, numSamples, activeFilterState);
+        }
+    };
+
+    if (requestedMode != activeMode && canUseStructureXfade && !structuresEquivalent)
+    {
+        // ★ 旧構造は先頭のフェード区間だけ状態のコピーで処理し、新構造はブロック全体を block 上で処理する。
+        //    二重処理はフェード区間 (約 5 ms) に限られ、切替ブロックの負荷はほぼ 1 ブロック分 + フェード区間で済む。
+        const int xfadeLen = std::min(numSamples, structureXfadeSamples);
+
+        double* oldL = activeStructureOldOutBuffer;
+        double* oldR = (numChannels > 1) ? (activeStructureOldOutBuffer + xfadeLen) : nullptr;
+        std::memcpy(oldL, blockL, sizeof(double) * static_cast<size_t>(xfadeLen));
+        if (numChannels > 1)
+            std::memcpy(oldR, blockR, sizeof(double) * static_cast<size_t>(xfadeLen));
 
         auto oldStateSnapshot = activeFilterState;
         if (activeMode == FilterStructure::Serial)
-            processSerial(oldL, oldR, oldStateSnapshot);
+        {
+            processSerial(oldL, oldR, xfadeLen, oldStateSnapshot);
+        }
         else
-            processParallel(srcL, srcR, oldL, oldR, oldStateSnapshot);
+        {
+            // Parallel の入力は src へ退避してから (oldL/R は出力先として上書きされる)
+            double* srcL = activeParallelInputBuffer;
+            double* srcR = (numChannels > 1) ? (activeParallelInputBuffer + xfadeLen) : nullptr;
+            std::memcpy(srcL, oldL, sizeof(double) * static_cast<size_t>(xfadeLen));
+            if (numChannels > 1)
+                std::memcpy(srcR, oldR, sizeof(double) * static_cast<size_t>(xfadeLen));
+            processParallel(srcL, srcR, oldL, oldR, xfadeLen, oldStateSnapshot);
+        }
 
-        if (requestedMode == FilterStructure::Serial)
-            processSerial(newL, newR, activeFilterState);
-        else
-            processParallel(srcL, srcR, newL, newR, activeFilterState);
+        processActiveStructure(requestedMode);
 
-        const double step = 1.0 / static_cast<double>(numSamples);
-        for (int n = 0; n < numSamples; ++n)
+        const double step = 1.0 / static_cast<double>(xfadeLen);
+        for (int n = 0; n < xfadeLen; ++n)
         {
             const double t = (n + 1.0) * step;
             const double wNew = equalPowerSin(t);
             const double wOld = equalPowerSin(1.0 - t);
-            blockL[n] = oldL[n] * wOld + newL[n] * wNew;
+            blockL[n] = oldL[n] * wOld + blockL[n] * wNew;
             if (numChannels > 1)
-                blockR[n] = oldR[n] * wOld + newR[n] * wNew;
+                blockR[n] = oldR[n] * wOld + blockR[n] * wNew;
         }
 
         rtActiveStructureShadow = requestedMode;
@@ -927,19 +1387,7 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block)
             rtActiveStructureShadow = activeMode;
         }
 
-        if (activeMode == FilterStructure::Serial || !canUseParallelBuffers)
-        {
-            processSerial(blockL, blockR, activeFilterState);
-        }
-        else
-        {
-            double* srcL = activeParallelInputBuffer;
-            double* srcR = (numChannels > 1) ? (activeParallelInputBuffer + numSamples) : nullptr;
-            std::memcpy(srcL, blockL, sizeof(double) * static_cast<size_t>(numSamples));
-            if (numChannels > 1)
-                std::memcpy(srcR, blockR, sizeof(double) * static_cast<size_t>(numSamples));
-            processParallel(srcL, srcR, blockL, blockR, activeFilterState);
-        }
+        processActiveStructure(activeMode);
     }
 
     // トータルゲイン / AGC 適用
@@ -1026,6 +1474,8 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block,
         || effectiveBypassed
         || bypassSmoothing)
     {
+        // 係数ランプは coeffCache パス専用。基本パスを経由した後は次回ランプなしで再同期する
+        resetBandCoeffRamps();
         process(block);
         return;
     }
@@ -1035,6 +1485,7 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block,
     {
         if (coeffCache->bandActive[i] && coeffCache->channelModes[i] >= 3)
         {
+            resetBandCoeffRamps();
             process(block);
             return;
         }
@@ -1112,17 +1563,11 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block,
     const double saturation = static_cast<double>(eqParams.nonlinearSaturation);
 
     if (eqParams.agcEnabled)
-    {
-        double& cachedInputRMSRef = cachedInputRMS;
-        cachedInputRMSRef = 0.0;
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            const double* data = block.getChannelPointer(ch);
-            const double rms = calculateRMS(data, numSamples);
-            if (rms > cachedInputRMSRef)
-                cachedInputRMSRef = rms;
-        }
-    }
+        cacheAGCInputLevels(block);
+
+    updateBandCoeffRamps(*coeffCache);
+    const std::uint32_t rampMask = rtBandRampMask;
+    const auto isRamping = [rampMask](int band) noexcept { return ((rampMask >> band) & 1u) != 0; };
 
     double* blockL = block.getChannelPointer(0);
     double* blockR = (numChannels > 1) ? block.getChannelPointer(1) : nullptr;
@@ -1141,7 +1586,11 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block,
                 const EQCoeffsSVF& c = coeffCache->coeffs[i];
                 const EQChannelMode mode = static_cast<EQChannelMode>(coeffCache->channelModes[i]);
 
-                if (mode == EQChannelMode::Stereo && numChannels >= 2)
+                if (isRamping(i))
+                {
+                    processBandRamped(i, blockL, blockR, numSamples, mode, saturation);
+                }
+                else if (mode == EQChannelMode::Stereo && numChannels >= 2)
                 {
                     processBandStereo(blockL, blockR, numSamples, c,
                                       activeFilterState[0][i].data(),
@@ -1174,44 +1623,50 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block,
             if (numChannels > 1)
                 juce::FloatVectorOperations::clear(accumR, numSamples);
 
-            for (int i = 0; i < NUM_BANDS; ++i)
+            // ★ 飽和の有無にかかわらず SoA バンクで一括処理する
             {
-                if (!coeffCache->bandActive[i])
+                std::array<ParallelBankBand, NUM_BANDS> bankL;
+                std::array<ParallelBankBand, NUM_BANDS> bankR;
+                int numBankL = 0;
+                int numBankR = 0;
+                for (int i = 0; i < NUM_BANDS; ++i)
+                {
+                    if (!coeffCache->bandActive[i] || isRamping(i))
+                        continue;
+                    const EQChannelMode mode = static_cast<EQChannelMode>(coeffCache->channelModes[i]);
+                    if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Left) && numChannels > 0)
+                        bankL[numBankL++] = { &coeffCache->coeffs[i], activeFilterState[0][i].data() };
+                    if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Right) && numChannels > 1)
+                        bankR[numBankR++] = { &coeffCache->coeffs[i], activeFilterState[1][i].data() };
+                }
+                accumulateParallelBank(srcL, accumL, numSamples, bankL.data(), numBankL, saturation);
+                if (numBankR > 0)
+                    accumulateParallelBank(srcR, accumR, numSamples, bankR.data(), numBankR, saturation);
+            }
+
+            // ランプ中のバンドのみ個別処理 (バンクからは除外済み)
+            for (int i = 0; rampMask != 0 && i < NUM_BANDS; ++i)
+            {
+                if (!coeffCache->bandActive[i] || !isRamping(i))
                     continue;
 
-                const EQCoeffsSVF& c = coeffCache->coeffs[i];
                 const EQChannelMode mode = static_cast<EQChannelMode>(coeffCache->channelModes[i]);
-
-                if (mode == EQChannelMode::Stereo && numChannels >= 2)
-                {
+                const bool hasL = (mode != EQChannelMode::Right) && numChannels > 0;
+                const bool hasR = (mode != EQChannelMode::Left) && numChannels > 1;
+                if (hasL)
                     juce::FloatVectorOperations::copy(workL, srcL, numSamples);
+                if (hasR)
                     juce::FloatVectorOperations::copy(workR, srcR, numSamples);
-                    processBandStereo(workL, workR, numSamples, c,
-                                      activeFilterState[0][i].data(),
-                                      activeFilterState[1][i].data(),
-                                      saturation);
+                processBandRamped(i, workL, workR, numSamples, mode, saturation);
+                if (hasL)
+                {
                     juce::FloatVectorOperations::add(accumL, workL, numSamples);
                     juce::FloatVectorOperations::subtract(accumL, srcL, numSamples);
-                    juce::FloatVectorOperations::add(accumR, workR, numSamples);
-                    juce::FloatVectorOperations::subtract(accumR, srcR, numSamples);
                 }
-                else
+                if (hasR)
                 {
-                    if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Left) && numChannels > 0)
-                    {
-                        juce::FloatVectorOperations::copy(workL, srcL, numSamples);
-                        processBand(workL, numSamples, c, activeFilterState[0][i].data(), saturation);
-                        juce::FloatVectorOperations::add(accumL, workL, numSamples);
-                        juce::FloatVectorOperations::subtract(accumL, srcL, numSamples);
-                    }
-
-                    if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Right) && numChannels > 1)
-                    {
-                        juce::FloatVectorOperations::copy(workR, srcR, numSamples);
-                        processBand(workR, numSamples, c, activeFilterState[1][i].data(), saturation);
-                        juce::FloatVectorOperations::add(accumR, workR, numSamples);
-                        juce::FloatVectorOperations::subtract(accumR, srcR, numSamples);
-                    }
+                    juce::FloatVectorOperations::add(accumR, workR, numSamples);
+                    juce::FloatVectorOperations::subtract(accumR, srcR, numSamples);
                 }
             }
 
@@ -1226,6 +1681,16 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block,
     }
     else
     {
+        // ★ 連続する Stereo バンドは fused cascade へ溜めて一括処理する (非 Stereo バンドで flush)
+        std::array<FusedStereoBand, NUM_BANDS> fused;
+        int numFused = 0;
+        const auto flushFused = [&]()
+        {
+            if (numFused > 0)
+                processStereoCascadeFused(blockL, blockR, numSamples, fused.data(), numFused, saturation);
+            numFused = 0;
+        };
+
         for (int i = 0; i < NUM_BANDS; ++i)
         {
             if (!coeffCache->bandActive[i])
@@ -1234,21 +1699,25 @@ void EQProcessor::process(juce::dsp::AudioBlock<double>& block,
             const EQCoeffsSVF& c = coeffCache->coeffs[i];
             const EQChannelMode mode = static_cast<EQChannelMode>(coeffCache->channelModes[i]);
 
-            if (mode == EQChannelMode::Stereo && numChannels >= 2)
+            if (isRamping(i))
+            {
+                flushFused();
+                processBandRamped(i, blockL, blockR, numSamples, mode, saturation);
+            }
+            else if (mode == EQChannelMode::Stereo && numChannels >= 2)
             {
-                processBandStereo(blockL, blockR, numSamples, c,
-                                  activeFilterState[0][i].data(),
-                                  activeFilterState[1][i].data(),
-                                  saturation);
+                fused[numFused++] = { &c, activeFilterState[0][i].data(), activeFilterState[1][i].data() };
             }
             else
             {
+                flushFused();
                 if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Left) && numChannels > 0)
                     processBand(blockL, numSamples, c, activeFilterState[0][i].data(), saturation);
                 if ((mode == EQChannelMode::Stereo || mode == EQChannelMode::Right) && numChannels > 1)
                     processBand(blockR, numSamples, c, activeFilterState[1][i].data(), saturation);
             }
         }
+        flushFused();
     }
 
     if (eqParams.agcEnabled)
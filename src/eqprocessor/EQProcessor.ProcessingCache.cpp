@@ -2,6 +2,9 @@
 // EQProcessor.ProcessingCache.cpp
 //============================================================================
 #include "EQProcessor.h"
+#include "EQCoeffBandReuse.h"
+#include "core/FixedSlabPool.h"
+#include <cmath>
 #include <cstring>
 #include <new>
 
@@ -9,9 +12,13 @@ namespace {
 
 inline uint32_t floatToCanonicalBits(float f) noexcept
 {
+    // ★ ±0 のみを同一視する。符号ビットを丸ごと落とすと +6 dB / -6 dB が同一ハッシュになり、
+    //    ゲイン符号反転時に古い係数キャッシュが再利用されてしまう。
+    if (f == 0.0f)
+        f = 0.0f;
     uint32_t bits;
     std::memcpy(&bits, &f, sizeof(float));
-    return bits & 0x7FFFFFFF;
+    return bits;
 }
 
 inline uint64_t hashCombine(uint64_t seed, uint64_t value) noexcept
@@ -44,11 +51,30 @@ uint64_t EQProcessor::computeParamsHash(const convo::EQParameters& params) noexc
     return hash;
 }
 
+uint64_t EQProcessor::computeBandResponseHash(const EQBandParams& band,
+                                              EQBandType type,
+                                              double sampleRate) noexcept
+{
+    uint64_t hash = 0;
+    hash = hashCombine(hash, floatToCanonicalBits(band.frequency));
+    hash = hashCombine(hash, floatToCanonicalBits(band.gain));
+    hash = hashCombine(hash, floatToCanonicalBits(band.q));
+    hash = hashCombine(hash, static_cast<uint64_t>(type));
+
+    uint64_t srBits;
+    std::memcpy(&srBits, &sampleRate, sizeof(double));
+    hash = hashCombine(hash, srBits);
+
+    // 0 は「キャッシュ未構築」の番兵として予約
+    return hash != 0 ? hash : 1;
+}
+
 EQCoeffCache* EQProcessor::createCoeffCache(
     const convo::EQParameters& eqParams,
     double sampleRate,
     int maxBlockSize,
-    uint64_t generation) noexcept
+    uint64_t generation,
+    const EQCoeffCache* base) noexcept
 {
     auto* cache = new (std::nothrow) EQCoeffCache();
     if (cache == nullptr) return nullptr;
@@ -59,30 +85,141 @@ EQCoeffCache* EQProcessor::createCoeffCache(
     cache->generation = generation;
     cache->filterStructure = eqParams.filterStructure;
 
+    // base と係数が変わらないバンドは写すだけ。残りの有効バンドを詰めて 1 回の calcSVFCoeffsBatch で計算する
+    bool reuse[NUM_BANDS];
+    (void)EQCoeffBandReuse::planReuse(eqParams.bands.data(),
+                                      base != nullptr ? base->bandParams : nullptr,
+                                      sampleRate,
+                                      base != nullptr ? base->sampleRate : 0.0,
+                                      NUM_BANDS, reuse);
+
+    SVFCoeffRequest requests[NUM_BANDS];
+    int bandOfRequest[NUM_BANDS];
+    int numRequests = 0;
+
     for (int i = 0; i < NUM_BANDS; ++i)
     {
         const auto& band = eqParams.bands[i];
+        cache->bandParams[i] = band;
         cache->bandActive[i] = band.enabled && sampleRate > 0.0;
         cache->channelModes[i] = band.channelMode;
+        cache->coeffs[i] = reuse[i] ? base->coeffs[i] : EQCoeffsSVF();
 
-        if (band.enabled && sampleRate > 0.0)
-        {
-            cache->coeffs[i] = calcSVFCoeffs(
-                static_cast<EQBandType>(band.type),
-                band.frequency,
-                band.gain,
-                band.q,
-                sampleRate);
-        }
-        else
+        if (cache->bandActive[i] && !reuse[i])
         {
-            cache->coeffs[i] = EQCoeffsSVF();
+            requests[numRequests] = { static_cast<EQBandType>(band.type), band.frequency, band.gain, band.q, sampleRate };
+            bandOfRequest[numRequests++] = i;
         }
     }
 
+    EQCoeffsSVF coeffs[NUM_BANDS];
+    calcSVFCoeffsBatch(requests, numRequests, coeffs);
+    for (int r = 0; r < numRequests; ++r)
+        cache->coeffs[bandOfRequest[r]] = coeffs[r];
+
     return cache;
 }
 
 EQCoeffCache::~EQCoeffCache()
 {
 }
+
+namespace
+{
+// 公開中 + EQCacheManager の保持分 + プリビルド分 + epoch 回収待ち
+convo::FixedSlabPool<sizeof(EQCoeffCache), alignof(EQCoeffCache), 64> g_coeffCachePool;
+}
+
+void* EQCoeffCache::operator new(std::size_t size)
+{
+    return g_coeffCachePool.allocate(size);
+}
+
+void* EQCoeffCache::operator new(std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return g_coeffCachePool.allocate(size, tag);
+}
+
+void EQCoeffCache::operator delete(void* ptr) noexcept
+{
+    g_coeffCachePool.deallocate(ptr);
+}
+
+void EQCoeffCache::operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    g_coeffCachePool.deallocate(ptr);
+}
+
+bool EQProcessor::isFoldableIntoIR(const convo::EQParameters& params, bool requireStereoBands) noexcept
+{
+    // 非線形 (飽和/AGC) や Parallel 構造は IR との畳み込みで表現できない
+    if (params.agcEnabled || params.nonlinearSaturation > 0.0f || params.filterStructure != 0)
+        return false;
+
+    for (const auto& band : params.bands)
+    {
+        if (!band.enabled)
+            continue;
+
+        const auto mode = static_cast<EQChannelMode>(band.channelMode);
+        if (mode == EQChannelMode::Mid || mode == EQChannelMode::Side)
+            return false;
+        if (requireStereoBands && mode != EQChannelMode::Stereo)
+            return false;
+    }
+    return true;
+}
+
+void EQProcessor::applyStaticResponse(const convo::EQParameters& params,
+                                      double sampleRate,
+                                      int channel,
+                                      double* data,
+                                      int numSamples) noexcept
+{
+    if (data == nullptr || numSamples <= 0 || sampleRate <= 0.0)
+        return;
+
+    const EQChannelMode ownMode = (channel == 0) ? EQChannelMode::Left : EQChannelMode::Right;
+
+    SVFCoeffRequest requests[NUM_BANDS];
+    int numRequests = 0;
+    for (const auto& band : params.bands)
+    {
+        if (!band.enabled)
+            continue;
+
+        const auto mode = static_cast<EQChannelMode>(band.channelMode);
+        if (mode != EQChannelMode::Stereo && mode != ownMode)
+            continue;
+
+        requests[numRequests++] = { static_cast<EQBandType>(band.type), band.frequency, band.gain, band.q, sampleRate };
+    }
+
+    // createCoeffCache と同一の係数 (同じ一括計算) → processBand と同一の TPT SVF 更新式 (飽和なし)
+    EQCoeffsSVF coeffs[NUM_BANDS];
+    calcSVFCoeffsBatch(requests, numRequests, coeffs);
+
+    for (int r = 0; r < numRequests; ++r)
+    {
+        const EQCoeffsSVF& c = coeffs[r];
+        double ic1eq = 0.0;
+        double ic2eq = 0.0;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const double v0 = data[n];
+            const double v3 = v0 - ic2eq;
+            const double v1 = c.a1 * ic1eq + c.a2 * v3;
+            const double v2 = ic2eq + c.a2 * ic1eq + c.a3 * v3;
+            ic1eq = 2.0 * v1 - ic1eq;
+            ic2eq = 2.0 * v2 - ic2eq;
+            data[n] = c.m0 * v0 + c.m1 * v1 + c.m2 * v2;
+        }
+    }
+
+    const double totalGain = std::pow(10.0, static_cast<double>(params.totalGainDb) / 20.0);
+    if (std::abs(totalGain - 1.0) > 1.0e-12)
+    {
+        for (int n = 0; n < numSamples; ++n)
+            data[n] *= totalGain;
+    }
+}
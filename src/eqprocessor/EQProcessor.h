@@ -28,14 +28,18 @@
 #include <array>
 #include <vector>
 #include <mutex>
+#include <new>
 #include "core/EQParameters.h"
 #include "core/EpochDomain.h"
 #include "core/RCUReader.h"
+#include "core/CallbackReaderScope.h"
+#include "audioengine/ISRRetireRouter.h"
 #include "AlignedAllocation.h"
 #include "DspNumericPolicy.h"
 
 namespace convo::isr { class RuntimePublicationCoordinator; }
 namespace convo::isr { class ISRRetireRouter; }
+class EQResponseCache;
 
 //--------------------------------------------------------------
 // バンドタイプ列挙型
@@ -108,6 +112,7 @@ struct EQCoeffsBiquad
 #include "RefCountedDeferred.h"
 
 #include "audioengine/AtomicAccess.h"
+#include "audioengine/MemoryLedger.h"
 #include "audioengine/RuntimeBuildTypes.h"
 
 //--------------------------------------------------------------
@@ -126,6 +131,7 @@ struct alignas(64) EQCoeffCache : public RefCountedDeferred<EQCoeffCache>
     bool bandActive[20] = {};            // バンド有効フラグ
     int channelModes[20] = {};           // チャンネルモード (0:Stereo, 1:Left, 2:Right)
     int filterStructure = 0;             // 0:Serial, 1:Parallel
+    convo::EQBandParams bandParams[20];  // 係数の元になったバンドパラメータ (次のキャッシュ構築でのバンド単位流用判定用)
 
     // メタデータ
     uint64_t paramsHash = 0;             // パラメータハッシュ値
@@ -137,6 +143,12 @@ struct alignas(64) EQCoeffCache : public RefCountedDeferred<EQCoeffCache>
     ~EQCoeffCache();
     EQCoeffCache(const EQCoeffCache&) = delete;
     EQCoeffCache& operator=(const EQCoeffCache&) = delete;
+
+    // ★ 確保は型専用の FixedSlabPool（EQProcessor.ProcessingCache.cpp）。RefCountedDeferred の deleter もそのまま戻す
+    static void* operator new(std::size_t size);
+    static void* operator new(std::size_t size, const std::nothrow_t&) noexcept;
+    static void operator delete(void* ptr) noexcept;
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept;
 };
 
 #pragma warning(pop) // C4324 suppression scope end: Intentional alignas padding for cache-line isolation / alignas による意図的なパディングを許容
@@ -206,6 +218,10 @@ public:
     bool isBypassed() const { return convo::consumeAtomic(bypassRequested, std::memory_order_acquire); }               // acquire: setBypass の release と HB し最新バイパス状態を観測
     // RT スレッド専用バイパスセッター（atomic write 禁止のため shadow に直書き）
     void setBypassFromRT(bool b) noexcept { m_rtBypassShadow = b; }
+    // RT スレッド専用: バイパス要求が出ていて、バイパスへのフェードも完了している (process() が素通り)
+    bool isBypassSettledFromRT() const noexcept { return m_rtBypassShadow && rtBypassedShadow && !bypassFadeGain.isSmoothing(); }
+    // RT スレッド専用: コールバック入口で rcuReader を固定し、以後の process() の enter/exit を省く
+    void pinReaderForCallback(convo::CallbackReaderScope& scope) noexcept { (void)scope.pin(rcuReader, m_rtReaderPinned); }
 
     //----------------------------------------------------------
     // パラメータ変更 (UIスレッドから呼ぶ)
@@ -243,11 +259,34 @@ public:
     // v2.3 EQCoeffCache 生成インターフェース
     //----------------------------------------------------------
     static uint64_t computeParamsHash(const convo::EQParameters& params) noexcept;
+    // ★ 応答曲線表示用: 1 バンド分の係数を決める要素 (freq/gain/Q/type/sampleRate) のハッシュ。
+    //    チャンネルモード・有効フラグは係数に影響しないため含めない。
+    static uint64_t computeBandResponseHash(const EQBandParams& band,
+                                            EQBandType type,
+                                            double sampleRate) noexcept;
+    // ★ base を渡すと係数を決める要素が base と一致するバンドは base の係数を写し、
+    //    変わったバンドだけを計算する (EQCoeffBandReuse.h)。base は呼び出し側が参照を保持すること
     static EQCoeffCache* createCoeffCache(
         const convo::EQParameters& eqParams,
         double sampleRate,
         int maxBlockSize,
-        uint64_t generation) noexcept;
+        uint64_t generation,
+        const EQCoeffCache* base = nullptr) noexcept;
+
+    //----------------------------------------------------------
+    // ★ EQ fold: 静的かつ線形な EQ を IR へ焼き込むためのヘルパー (非 RT / Loader Thread 用)
+    // isFoldableIntoIR    : AGC 無効・非線形飽和 0・Serial 構造・Mid/Side バンドなしなら true。
+    //                       requireStereoBands=true (True-stereo IR) では L/R 個別バンドも不可
+    //                       (クロスパスでは EQ/Convolver の処理順で L/R の掛かる側が変わるため)。
+    // applyStaticResponse : channel (0=L, 1=R) に掛かる有効バンドの線形 TPT SVF と totalGainDb を
+    //                       data へインプレース適用する (状態ゼロ開始 = インパルス応答との畳み込み)。
+    //----------------------------------------------------------
+    static bool isFoldableIntoIR(const convo::EQParameters& params, bool requireStereoBands) noexcept;
+    static void applyStaticResponse(const convo::EQParameters& params,
+                                    double sampleRate,
+                                    int channel,
+                                    double* data,
+                                    int numSamples) noexcept;
 
     //----------------------------------------------------------
     // パラメータ読み取り (UIスレッドで表示に使用)
@@ -267,11 +306,16 @@ public:
     //----------------------------------------------------------
     // 状態構造体
     //----------------------------------------------------------
+    // ★ BandNode / EQState は setBandXxx() ごとに作り直して epoch 回収で捨てるため、
+    //   型専用の FixedSlabPool から確保する（EQProcessor.Core.cpp）。満杯時のみヒープ
     struct BandNode
     {
         EQCoeffsSVF coeffs;
         bool active;
         EQChannelMode mode;
+
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr) noexcept;
     };
 
     struct EQState
@@ -286,6 +330,9 @@ public:
 
         convo::EQParameters toEQParameters() const;
 
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr) noexcept;
+
         // Explicitly define the copy constructor
         EQState() = default;
 
@@ -363,6 +410,9 @@ public:
     // プリセット読み込み (AudioEngine::prepareToPlayから呼ばれる)
     //----------------------------------------------------------
     void loadPreset(int index);
+    // ★ テキストプリセットを現在状態に触れずに解析する (任意スレッド可: 一時インスタンスを使用)。
+    //    警告ダイアログは出さない。
+    static bool parseTextPresetFile(const juce::File& file, convo::EQParameters& out);
 
     //----------------------------------------------------------
     // テキストファイルからプリセット読み込み
@@ -384,6 +434,19 @@ public:
     static EQCoeffsSVF    calcSVFCoeffs   (EQBandType type, float freq, float gainDb, float q, double sr) noexcept;
     static EQCoeffsBiquad calcBiquadCoeffs(EQBandType type, float freq, float gainDb, float q, double sr) noexcept;
 
+    // ★ 一括版: count 組の SVF 係数を MKL VML (vdPow / vdSqrt / vdTan) でまとめて計算する。
+    //    全バンド × 複数サンプルレート (オーバーサンプリング倍率ごと) を 1 回で埋める用途。
+    //    クランプと係数式は calcSVFCoeffs と同一 (超越関数の実装差による ulp 程度の差のみ)。非 RT 専用
+    struct SVFCoeffRequest
+    {
+        EQBandType type = EQBandType::Peaking;
+        float freq = 1000.0f;
+        float gainDb = 0.0f;
+        float q = DEFAULT_Q;
+        double sampleRate = 0.0;
+    };
+    static void calcSVFCoeffsBatch(const SVFCoeffRequest* requests, int count, EQCoeffsSVF* out) noexcept;
+
     static void validateAndClampParameters(float& freq, float& gainDb, float& q, double sr) noexcept;
     static float getMagnitudeSquared(const EQCoeffsBiquad& coeffs, float freq, float sampleRate) noexcept;
     static float getMagnitudeSquared(const EQCoeffsBiquad& coeffs, const std::complex<double>& z) noexcept;
@@ -423,8 +486,9 @@ public:
 
     // ★ v14.30: 複素応答を使用した推定最大ゲイン計算（旧 computeEstimatedMaxGainDb を置換）
     //   processingRate = sr * resolvedOsFactor（呼出し側（Builder）の責務）
+    //   cache を渡すと Band 別応答を使い回し、前回から係数が変わった Band だけ再評価する（結果は同一）
     [[nodiscard]] EQAnalysisResult computeEstimatedMaxGainComplex(
-        const EQState& state, double processingRate) const;
+        const EQState& state, double processingRate, EQResponseCache* cache = nullptr) const;
 
     // Retire authority: set coordinator for unified retire path
     void setRetireCoordinator(convo::isr::RuntimePublicationCoordinator* coordinator) noexcept
@@ -458,12 +522,20 @@ private:
     // 係数計算
     BandNode* createBandNode(int bandIndex, const EQState& state) const;
     void updateBandNode(int bandIndex);
+    // 全バンド分を calcSVFCoeffsBatch で作り直して差し替える (プリセット/状態ロード・レート変更)
+    void createAllBandNodes(const EQState& state, std::array<BandNode*, NUM_BANDS>& out) const;
+    void updateAllBandNodes();
+    // setState / loadFromTextFile 中は setBandXxx() ごとの再計算を止め、最後に updateAllBandNodes() で一括反映する
+    bool bandNodeUpdatesDeferred = false; // Message Thread only
 
     // スムージング処理
     convo::EpochDomain m_epochDomain;
+    // m_epochDomain への退役窓口 (RetireProducer::EQ のバッチレーンもここに持つ)
+    convo::isr::ISRRetireRouter m_localRetireRouter { m_epochDomain };
     // [P1-14] 遅延epoch進捗フラグ: パラメータ変更毎に advanceEpoch を呼ばず,
     //         フラグを立てて flushPendingEpochAdvance() で一括進捗する.
     std::atomic<bool> m_epochAdvancePending { false };
+    bool textLoadWarningsEnabled = true; // parseTextPresetFile の一時インスタンスでは false
     convo::isr::RuntimePublicationCoordinator* m_retireCoordinator{nullptr};
     // [work21] ISRRetireRouter: unified retire API (Phase-C)
     convo::isr::ISRRetireRouter* m_retireRouter{nullptr};
@@ -544,7 +616,13 @@ private:
     std::atomic<double> agcAttackCoeff { 0.0 };
     std::atomic<double> agcReleaseCoeff { 0.0 };
     std::atomic<double> agcSmoothCoeff { 0.0 };
-    double cachedInputRMS = 0.0; // AGC用の入力レベルキャッシュ
+    // AGC用の入力レベルキャッシュ (サブブロック単位)。
+    // エンベロープ追従をブロック長に依存させないため、kAgcMinSubBlockSamples 以上の
+    // サブブロックごとに RMS を取り、追従器もサブブロックレートで更新する。
+    static constexpr int kAgcMinSubBlockSamples = 64;
+    static constexpr int kAgcMaxSubBlocks = 64;
+    std::array<double, kAgcMaxSubBlocks> cachedInputSubRMS {};
+    int cachedInputSubCount = 0;
     convo::ScopedAlignedPtr<double> agcAttackCoeffTable;
     convo::ScopedAlignedPtr<double> agcReleaseCoeffTable;
     convo::ScopedAlignedPtr<double> agcSmoothCoeffTable;
@@ -634,6 +712,7 @@ private:
     std::atomic<bool> bypassRequested { false };
     std::atomic<bool> bypassed { false }; // 実効バイパス状態（フェード完了後に更新）
     bool m_rtBypassShadow = false;       // RT-local bypass shadow（非atomic、RT スレッドのみ書き込み）
+    bool m_rtReaderPinned = false;       // RT-local: CallbackReaderScope が rcuReader を固定中
     convo::LinearRamp bypassFadeGain { 1.0 };
 
     // ── 現在のサンプルレート ──
@@ -653,6 +732,13 @@ private:
     // ── AGC適用 (Audio Thread 内で呼ばれる) ──
     void processAGC(juce::dsp::AudioBlock <double > & block);
     double calculateAGCGain(double inputEnv, double outputEnv) const noexcept;
+    // ★ フィルタ処理前の入力 RMS をサブブロック単位でキャッシュする (AGC 有効時のみ)
+    void cacheAGCInputLevels(const juce::dsp::AudioBlock<double>& block) noexcept;
+    static int agcSubBlockLength(int numSamples) noexcept
+    {
+        // サブブロック数が kAgcMaxSubBlocks を超えないよう長さを伸ばす
+        return std::max(kAgcMinSubBlockSamples, (numSamples + kAgcMaxSubBlocks - 1) / kAgcMaxSubBlocks);
+    }
 
     // ── SVF係数計算 (Private Helpers) ──
     static EQCoeffsSVF calcLowShelfSVF (double freq, double gainDb, double q, double sr) noexcept;
@@ -660,6 +746,8 @@ private:
     static EQCoeffsSVF calcHighShelfSVF(double freq, double gainDb, double q, double sr) noexcept;
     static EQCoeffsSVF calcLowPassSVF  (double freq, double q, double sr) noexcept;
     static EQCoeffsSVF calcHighPassSVF (double freq, double q, double sr) noexcept;
+    // A = 10^(gainDb/40), tanW = tan(π f / sr) を受け取り、タイプ別の TPT 係数を組み立てる (単発版・一括版で共有)
+    static EQCoeffsSVF svfFromPrewarp(EQBandType type, double A, double sqrtA, double tanW, double q) noexcept;
 
     // ── Biquad係数計算 (Private Helpers) ──
     static EQCoeffsBiquad calcLowShelfBiquad (double freq, double gainDb, double q, double sr) noexcept;
@@ -676,10 +764,18 @@ private:
     convo::ScopedAlignedPtr<double> parallelInputBuffer;
     convo::ScopedAlignedPtr<double> parallelWorkBuffer;
     convo::ScopedAlignedPtr<double> parallelAccumBuffer;
-    convo::ScopedAlignedPtr<double> structureOldOutBuffer;
-    convo::ScopedAlignedPtr<double> structureNewOutBuffer;
+    convo::ScopedAlignedPtr<double> structureOldOutBuffer; // 構造切替フェード区間の旧構造出力
     int parallelBufferCapacity = 0;
     int structureXfadeBufferCapacity = 0;
+    // ★ Serial/Parallel 切替のフェード長 (prepareToPlay で処理レートから決める)。
+    //    旧構造はこの区間だけ処理し、以降は新構造のみ (切替ブロック全体の二重処理をしない)
+    static constexpr double kStructureXfadeSeconds = 0.005;
+    static constexpr int kStructureXfadeMinSamples = 32;
+    int structureXfadeSamples = kStructureXfadeMinSamples;
+
+    // 上のバッファと M/S・AGC テーブルの確保量を MemoryLedger へ申告する (prepareToPlay / releaseResources)
+    convo::MemoryCharge memoryCharge { convo::MemoryCategory::EqScratch };
+    void updateMemoryCharge() noexcept;
 
     std::atomic<float> nonlinearSaturation { 0.2f };
     std::atomic<FilterStructure> requestedStructure { FilterStructure::Serial };
@@ -696,4 +792,26 @@ private:
     std::uint64_t rtSeenBandResetSerial = 0;
     std::uint64_t rtSeenAgcResetSerial = 0;
 
+    // ── バンド係数スムージング (Audio Thread専用 / coeffCache パス) ──
+    // ランプ中のバンドを rtBandRampMask で追跡し、収束済みバンドは追加コストゼロ。
+    // ランプ中は kBandCoeffControlSamples ごとに g/k/m0..m2 を線形補間し a1..a3 を再計算する。
+    static constexpr int kBandCoeffControlSamples = 16;
+    std::array<EQCoeffsSVF, NUM_BANDS> rtBandCoeffCurrent {};
+    std::array<EQCoeffsSVF, NUM_BANDS> rtBandCoeffTarget {};
+    std::array<int, NUM_BANDS> rtBandRampRemaining {};
+    std::uint32_t rtBandRampMask = 0;
+    std::uint32_t rtBandCoeffValidMask = 0;
+    std::uint64_t rtBandCoeffSourceHash = 0;
+    bool rtBandCoeffSourceValid = false;
+    int bandRampSamples = 0; // prepareToPlay で SMOOTHING_TIME_SEC から算出
+
+    void resetBandCoeffRamps() noexcept
+    {
+        rtBandRampMask = 0;
+        rtBandCoeffValidMask = 0;
+        rtBandCoeffSourceValid = false;
+    }
+    void updateBandCoeffRamps(const EQCoeffCache& cache) noexcept;
+    void processBandRamped(int band, double* dataL, double* dataR, int numSamples,
+                           EQChannelMode mode, double saturation) noexcept;
 };
@@ -0,0 +1,92 @@
+#include "EQResponseCache.h"
+#include <utility>
+
+namespace
+{
+    bool sameCoeffs(const EQCoeffsBiquad& a, const EQCoeffsBiquad& b) noexcept
+    {
+        // 完全一致のみ再利用する（近似一致を許すと結果が runCoarse と一致しなくなる）
+        return a.b0 == b.b0 && a.b1 == b.b1 && a.b2 == b.b2
+            && a.a0 == b.a0 && a.a1 == b.a1 && a.a2 == b.a2;
+    }
+}
+
+void EQResponseCache::clear() noexcept
+{
+    processingRate_ = 0.0;
+    coarseGridValid_ = false;
+    invalidateRows(coarse_);
+    invalidateRows(adaptive_);
+    adaptive_.grid = {};
+}
+
+void EQResponseCache::invalidateRows(GridCache& cache) noexcept
+{
+    for (auto& row : cache.rows)
+        row.valid = false;
+}
+
+void EQResponseCache::refreshRows(GridCache& cache,
+                                  const BandCollection& bands,
+                                  EQResponseSampler::ResponseRows& outRows)
+{
+    const size_t n = cache.grid.freqsHz.size();
+    outRows.re.clear();
+    outRows.im.clear();
+    outRows.re.reserve(bands.bands.size());
+    outRows.im.reserve(bands.bands.size());
+
+    for (const auto& band : bands.bands)
+    {
+        auto& row = cache.rows[static_cast<size_t>(band.index)];
+        if (!row.valid || !sameCoeffs(row.key, band.biquad))
+        {
+            row.re.resize(n);
+            row.im.resize(n);
+            EQResponseSampler::evaluateBandResponse(band.biquad, cache.grid, row.re.data(), row.im.data());
+            row.key = band.biquad;
+            row.valid = true;
+            ++lastEvaluatedRows_;
+        }
+        outRows.re.push_back(row.re.data());
+        outRows.im.push_back(row.im.data());
+    }
+}
+
+void EQResponseCache::scan(const EQResponseSampler& sampler,
+                           const BandCollection& bands,
+                           CoarseScanResult& outCoarse,
+                           AdaptiveScanResult& outAdaptive)
+{
+    lastEvaluatedRows_ = 0;
+
+    // 評価グリッドと全行は processingRate に依存する
+    if (sampler.processingRate() != processingRate_)
+    {
+        clear();
+        processingRate_ = sampler.processingRate();
+    }
+
+    if (!coarseGridValid_)
+    {
+        coarse_.grid = sampler.makeGrid(sampler.coarseFrequencies());
+        coarseGridValid_ = true;
+    }
+
+    EQResponseSampler::ResponseRows rows;
+    refreshRows(coarse_, bands, rows);
+    outCoarse = sampler.aggregateCoarse(coarse_.grid, rows);
+
+    // 候補範囲の union が前回と同じなら評価周波数も同一になり、未変更 Band の行を使い回せる
+    const auto measCands = sampler.findMeasuredCandidates(bands);
+    const auto ubCands = sampler.findUpperBoundCandidates(bands, outCoarse.bandMaxDelta);
+    auto freqsHz = sampler.adaptiveFrequencies(measCands, ubCands);
+    if (freqsHz != adaptive_.grid.freqsHz)
+    {
+        adaptive_.grid = sampler.makeGrid(std::move(freqsHz));
+        invalidateRows(adaptive_);
+    }
+
+    refreshRows(adaptive_, bands, rows);
+    outAdaptive = sampler.aggregateAdaptive(adaptive_.grid, rows);
+}
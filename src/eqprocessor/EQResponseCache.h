@@ -0,0 +1,58 @@
+#pragma once
+
+#include "EQResponseSampler.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+// EQResponseCache — EQResponseSampler の Band 別応答のメモ化（増分再解析）
+//
+// 責務:
+// - 粗探索グリッド（processingRate のみで決まる）の z/z² を 1 度だけ計算
+// - Band ごとの H 行を Biquad 係数をキーに保持し、係数が変わった Band だけ再評価
+// - 適応サンプリングの評価周波数（union 区間の比例配分）が前回と同一なら、
+//   グリッドと未変更 Band の行をそのまま再利用
+//
+// 集約（粗探索・適応サンプリングとも全点）は毎回行うため、結果は
+// runCoarse → find*Candidates → runAdaptive と同一で、upperBound の安全側保証は変わらない。
+//
+// スレッド: 非スレッドセーフ。所有者が直列化する（AudioEngine では rebuildMutex）
+//==============================================================================
+
+class EQResponseCache {
+public:
+    /// runCoarse + 候補判定 + runAdaptive と同じ結果を、前回から変わった Band だけ評価して返す
+    void scan(const EQResponseSampler& sampler,
+              const BandCollection& bands,
+              CoarseScanResult& outCoarse,
+              AdaptiveScanResult& outAdaptive);
+
+    void clear() noexcept;
+
+    /// 直近の scan で再評価した Band 行数（粗探索 + 適応の合計。診断用）
+    int lastEvaluatedRows() const noexcept { return lastEvaluatedRows_; }
+
+private:
+    struct BandRow {
+        bool valid = false;
+        EQCoeffsBiquad key {};
+        std::vector<double> re, im;
+    };
+
+    struct GridCache {
+        EQResponseSampler::Grid grid;
+        std::array<BandRow, 20> rows;   // BandInfo::index で引く
+    };
+
+    void refreshRows(GridCache& cache,
+                     const BandCollection& bands,
+                     EQResponseSampler::ResponseRows& outRows);
+
+    static void invalidateRows(GridCache& cache) noexcept;
+
+    double processingRate_ = 0.0;
+    bool coarseGridValid_ = false;
+    GridCache coarse_;
+    GridCache adaptive_;
+    int lastEvaluatedRows_ = 0;
+};
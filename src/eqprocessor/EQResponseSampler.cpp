@@ -5,6 +5,86 @@
 #include <limits>
 #include <vector>
 
+#if defined(__AVX2__)
+ #include <immintrin.h>
+#endif
+
+//==============================================================================
+// ★ 一括評価用カーネル
+// z = e^{jω}, z² は周波数ごとに 1 回だけ計算し (makeGrid)、全 Band で共有する。
+// 各 Band の H = (b0 z² + b1 z + b2) / (a0 z² + a1 z + a2) を 4 周波数ずつ AVX2 で評価する。
+// 演算順序は biquadResponse と揃え (FMA 不使用)、|den|² < 1e-18 の場合は同様に H = 1 とする。
+//==============================================================================
+EQResponseSampler::Grid EQResponseSampler::makeGrid(std::vector<double> freqsHz) const
+{
+    Grid g;
+    g.freqsHz = std::move(freqsHz);
+    const size_t n = g.freqsHz.size();
+    g.zr.resize(n); g.zi.resize(n); g.z2r.resize(n); g.z2i.resize(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+        const double w = 2.0 * juce::MathConstants<double>::pi * g.freqsHz[k] / processingRate_;
+        const std::complex<double> z(std::cos(w), std::sin(w));
+        const std::complex<double> z2 = z * z;
+        g.zr[k] = z.real();  g.zi[k] = z.imag();
+        g.z2r[k] = z2.real(); g.z2i[k] = z2.imag();
+    }
+    return g;
+}
+
+void EQResponseSampler::evaluateBandResponse(const EQCoeffsBiquad& c, const Grid& grid,
+                                             double* outRe, double* outIm) noexcept
+{
+    const size_t n = grid.freqsHz.size();
+    size_t k = 0;
+#if defined(__AVX2__)
+    const __m256d b0 = _mm256_set1_pd(c.b0), b1 = _mm256_set1_pd(c.b1), b2 = _mm256_set1_pd(c.b2);
+    const __m256d a0 = _mm256_set1_pd(c.a0), a1 = _mm256_set1_pd(c.a1), a2 = _mm256_set1_pd(c.a2);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d minNorm = _mm256_set1_pd(1e-18);
+    for (; k + 4 <= n; k += 4)
+    {
+        const __m256d zr = _mm256_loadu_pd(grid.zr.data() + k);
+        const __m256d zi = _mm256_loadu_pd(grid.zi.data() + k);
+        const __m256d z2r = _mm256_loadu_pd(grid.z2r.data() + k);
+        const __m256d z2i = _mm256_loadu_pd(grid.z2i.data() + k);
+
+        const __m256d nr = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(b0, z2r), _mm256_mul_pd(b1, zr)), b2);
+        const __m256d ni = _mm256_add_pd(_mm256_mul_pd(b0, z2i), _mm256_mul_pd(b1, zi));
+        const __m256d dr = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a0, z2r), _mm256_mul_pd(a1, zr)), a2);
+        const __m256d di = _mm256_add_pd(_mm256_mul_pd(a0, z2i), _mm256_mul_pd(a1, zi));
+
+        const __m256d norm = _mm256_add_pd(_mm256_mul_pd(dr, dr), _mm256_mul_pd(di, di));
+        const __m256d valid = _mm256_cmp_pd(norm, minNorm, _CMP_GE_OQ);
+
+        // num / den = num * conj(den) / |den|²
+        const __m256d hr = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(nr, dr), _mm256_mul_pd(ni, di)), norm);
+        const __m256d hi = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(ni, dr), _mm256_mul_pd(nr, di)), norm);
+
+        _mm256_storeu_pd(outRe + k, _mm256_blendv_pd(one, hr, valid));
+        _mm256_storeu_pd(outIm + k, _mm256_blendv_pd(zero, hi, valid));
+    }
+#endif
+    for (; k < n; ++k)
+    {
+        const std::complex<double> z(grid.zr[k], grid.zi[k]);
+        const std::complex<double> z2(grid.z2r[k], grid.z2i[k]);
+        const std::complex<double> num = c.b0 * z2 + c.b1 * z + c.b2;
+        const std::complex<double> den = c.a0 * z2 + c.a1 * z + c.a2;
+        const double denNorm = std::norm(den);
+        if (denNorm < 1e-18)
+        {
+            outRe[k] = 1.0;
+            outIm[k] = 0.0;
+            continue;
+        }
+        const std::complex<double> H = num / den;
+        outRe[k] = H.real();
+        outIm[k] = H.imag();
+    }
+}
+
 //==============================================================================
 // 1点評価
 //==============================================================================
@@ -27,39 +107,132 @@ MergedSample EQResponseSampler::evaluate(double freqHz, const BandCollection& ba
     return s;
 }
 
+//==============================================================================
+// 一括評価
+//==============================================================================
+void EQResponseSampler::computeResponseTable(const Grid& grid,
+                                             const BandCollection& bands,
+                                             std::vector<double>& outRe,
+                                             std::vector<double>& outIm,
+                                             ResponseRows& rows) const
+{
+    const size_t n = grid.freqsHz.size();
+    const size_t numBands = bands.bands.size();
+    outRe.resize(numBands * n);
+    outIm.resize(numBands * n);
+    rows.re.resize(numBands);
+    rows.im.resize(numBands);
+    for (size_t j = 0; j < numBands; ++j)
+    {
+        evaluateBandResponse(bands.bands[j].biquad, grid, outRe.data() + j * n, outIm.data() + j * n);
+        rows.re[j] = outRe.data() + j * n;
+        rows.im[j] = outIm.data() + j * n;
+    }
+}
+
+std::vector<MergedSample> EQResponseSampler::evaluateBatch(const std::vector<double>& freqsHz,
+                                                           const BandCollection& bands) const
+{
+    const Grid grid = makeGrid(freqsHz);
+    std::vector<double> tableRe, tableIm;
+    ResponseRows rows;
+    computeResponseTable(grid, bands, tableRe, tableIm, rows);
+    return aggregateSamples(grid, rows);
+}
+
+std::vector<MergedSample> EQResponseSampler::aggregateSamples(const Grid& grid, const ResponseRows& rows) const
+{
+    constexpr double kTwentyOverLog10 = 8.685889638065036; // 20.0 / ln(10)
+    constexpr double kEpsilon = 1e-6;
+    const std::complex<double> kOne(1.0, 0.0);
+
+    const size_t n = grid.freqsHz.size();
+    const size_t numBands = rows.re.size();
+    std::vector<MergedSample> samples(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+        // 集約は computeSampleResponse と同一 (Band 昇順、log1p の上界和はスカラーで評価)
+        double logBound = 0.0;
+        std::complex<double> parallelSum(1.0, 0.0);
+        double productMag = 1.0;
+        for (size_t j = 0; j < numBands; ++j)
+        {
+            const std::complex<double> H(rows.re[j][k], rows.im[j][k]);
+            if (isParallel_)
+                parallelSum += H - kOne;
+            else
+                productMag *= std::abs(H);
+            const double delta = std::abs(H - kOne);
+            if (std::isfinite(delta) && delta > kEpsilon)
+                logBound += std::log1p(delta);
+        }
+
+        MergedSample& s = samples[k];
+        s.freqHz = grid.freqsHz[k];
+        s.linearMagnitude = isParallel_ ? std::abs(parallelSum) : productMag;
+        s.upperBoundDb = kTwentyOverLog10 * logBound;
+        s.origin.type = EQProcessor::SampleOrigin::Unknown;
+        s.origin.bandIndex = -1;
+        s.origin.sampleIndex = -1;
+    }
+    return samples;
+}
+
 //==============================================================================
 // 粗探索600点
 //==============================================================================
+std::vector<double> EQResponseSampler::coarseFrequencies() const
+{
+    std::vector<double> freqsHz(static_cast<size_t>(kCoarsePoints));
+    for (int i = 0; i < kCoarsePoints; ++i)
+    {
+        const double t = static_cast<double>(i) / static_cast<double>(kCoarsePoints - 1);
+        freqsHz[static_cast<size_t>(i)] = 10.0 * std::pow(maxFreq_ / 10.0, t);
+    }
+    return freqsHz;
+}
+
 CoarseScanResult EQResponseSampler::runCoarse(const BandCollection& bands) const
+{
+    // ★ 全Band×全周波数の H を一括評価してから、点ごとに従来と同一順序で集約する
+    const Grid grid = makeGrid(coarseFrequencies());
+    std::vector<double> tableRe, tableIm;
+    ResponseRows rows;
+    computeResponseTable(grid, bands, tableRe, tableIm, rows);
+    return aggregateCoarse(grid, rows);
+}
+
+CoarseScanResult EQResponseSampler::aggregateCoarse(const Grid& grid, const ResponseRows& rows) const
 {
     CoarseScanResult result;
-    result.samples.reserve(static_cast<size_t>(kCoarsePoints));
+    result.samples.reserve(grid.freqsHz.size());
 
     constexpr double kTwentyOverLog10 = 8.685889638065036; // 20.0 / ln(10)
     constexpr double kEpsilon = 1e-6;
     const std::complex<double> kOne(1.0, 0.0);
 
-    for (int i = 0; i < kCoarsePoints; ++i)
+    const size_t numBands = rows.re.size();
+    for (size_t i = 0; i < grid.freqsHz.size(); ++i)
     {
-        const double t = static_cast<double>(i) / static_cast<double>(kCoarsePoints - 1);
-        const double freqHz = 10.0 * std::pow(maxFreq_ / 10.0, t);
-        const double w = 2.0 * juce::MathConstants<double>::pi * freqHz / processingRate_;
+        const auto responseAt = [&](size_t j)
+        {
+            return std::complex<double>(rows.re[j][i], rows.im[j][i]);
+        };
 
         MergedSample sample;
-        sample.freqHz = freqHz;
+        sample.freqHz = grid.freqsHz[i];
         sample.origin.type = EQProcessor::SampleOrigin::Coarse;
         sample.origin.bandIndex = -1;
-        sample.origin.sampleIndex = i;
+        sample.origin.sampleIndex = static_cast<int>(i);
 
         if (isParallel_)
         {
             std::complex<double> parallelSum(1.0, 0.0);
             double logBound = 0.0;
 
-            for (size_t j = 0; j < bands.bands.size(); ++j)
+            for (size_t j = 0; j < numBands; ++j)
             {
-                const auto& band = bands.bands[j];
-                const auto H = EQAnalysisMath::biquadResponse(band.biquad, w);
+                const auto H = responseAt(j);
                 parallelSum += H - kOne;
 
                 const double delta = std::abs(H - kOne);
@@ -83,10 +256,9 @@ CoarseScanResult EQResponseSampler::runCoarse(const BandCollection& bands) const
             double productMag = 1.0;
             double logBound = 0.0;
 
-            for (size_t j = 0; j < bands.bands.size(); ++j)
+            for (size_t j = 0; j < numBands; ++j)
             {
-                const auto& band = bands.bands[j];
-                const auto H = EQAnalysisMath::biquadResponse(band.biquad, w);
+                const auto H = responseAt(j);
                 const double mag = std::abs(H);
                 productMag *= mag;
 
@@ -146,13 +318,11 @@ std::vector<const BandInfo*> EQResponseSampler::findUpperBoundCandidates(
 //==============================================================================
 // 適応サンプリング（union統合+比例配分）
 //==============================================================================
-AdaptiveScanResult EQResponseSampler::runAdaptive(
-    const BandCollection& bands,
+std::vector<double> EQResponseSampler::adaptiveFrequencies(
     const std::vector<const BandInfo*>& measuredCands,
-    const std::vector<const BandInfo*>& upperBoundCands,
-    const CoarseScanResult& coarseResult) const
+    const std::vector<const BandInfo*>& upperBoundCands) const
 {
-    AdaptiveScanResult result;
+    std::vector<double> freqsHz;
 
     // 候補Bandの範囲を収集（measured + upperBound 両方）
     struct RangeEntry {
@@ -171,7 +341,7 @@ AdaptiveScanResult EQResponseSampler::runAdaptive(
     for (auto* b : upperBoundCands) addRange(b);
 
     if (ranges.empty())
-        return result;
+        return freqsHz;
 
     // ソート
     std::sort(ranges.begin(), ranges.end(),
@@ -203,9 +373,9 @@ AdaptiveScanResult EQResponseSampler::runAdaptive(
     }
 
     if (totalLogLength <= 0.0)
-        return result;
+        return freqsHz;
 
-    // 各区間に比例配分
+    // 各区間に比例配分（評価点を先に確定し、一括評価する）
     for (const auto& mr : merged)
     {
         const int numPoints = std::max(4, static_cast<int>(
@@ -214,14 +384,36 @@ AdaptiveScanResult EQResponseSampler::runAdaptive(
         for (int j = 0; j < numPoints; ++j)
         {
             const double t = static_cast<double>(j) / static_cast<double>(numPoints - 1);
-            const double freqHz = mr.start * std::pow(mr.end / mr.start, t);
-            auto s = evaluate(freqHz, bands);
-            s.origin.type = EQProcessor::SampleOrigin::Adaptive;
-            s.origin.bandIndex = -1;
-            s.origin.sampleIndex = static_cast<int>(result.samples.size());
-            result.samples.push_back(s);
+            freqsHz.push_back(mr.start * std::pow(mr.end / mr.start, t));
         }
     }
+    return freqsHz;
+}
+
+AdaptiveScanResult EQResponseSampler::runAdaptive(
+    const BandCollection& bands,
+    const std::vector<const BandInfo*>& measuredCands,
+    const std::vector<const BandInfo*>& upperBoundCands,
+    const CoarseScanResult& coarseResult) const
+{
+    const Grid grid = makeGrid(adaptiveFrequencies(measuredCands, upperBoundCands));
+    std::vector<double> tableRe, tableIm;
+    ResponseRows rows;
+    computeResponseTable(grid, bands, tableRe, tableIm, rows);
+    return aggregateAdaptive(grid, rows);
+}
+
+AdaptiveScanResult EQResponseSampler::aggregateAdaptive(const Grid& grid, const ResponseRows& rows) const
+{
+    AdaptiveScanResult result;
+    result.samples = aggregateSamples(grid, rows);
+    for (size_t k = 0; k < result.samples.size(); ++k)
+    {
+        auto& s = result.samples[k];
+        s.origin.type = EQProcessor::SampleOrigin::Adaptive;
+        s.origin.bandIndex = -1;
+        s.origin.sampleIndex = static_cast<int>(k);
+    }
 
     return result;
 }
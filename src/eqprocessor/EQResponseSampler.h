@@ -13,6 +13,7 @@
 // - Shelf/LPF/HPF 追加評価
 // - union区間統合 + 比例配分
 // - 適応サンプリング
+// - 全Band×全周波数の一括評価（z^-1/z^-2 phasor 事前計算 + AVX2）
 //==============================================================================
 
 class EQResponseSampler {
@@ -45,12 +46,62 @@ public:
     /// 1点評価
     MergedSample evaluate(double freqHz, const BandCollection& bands) const;
 
+    /// 複数点の一括評価（結果は evaluate() を各点に適用したものと同一の定義）
+    std::vector<MergedSample> evaluateBatch(const std::vector<double>& freqsHz,
+                                            const BandCollection& bands) const;
+
+    //--------------------------------------------------------------
+    // 段階別 API（EQResponseCache が Band ごとの応答行を使い回すために使う）
+    // runCoarse / runAdaptive はこれらを順に呼んだものと同一の結果を返す
+    //--------------------------------------------------------------
+
+    /// 評価グリッド: 周波数と z = e^{jω}, z² の事前計算値
+    struct Grid {
+        std::vector<double> freqsHz, zr, zi, z2r, z2i;
+    };
+
+    /// Band ごとの H 行（bands.bands と同じ順、各行は Grid と同じ長さ）
+    struct ResponseRows {
+        std::vector<const double*> re, im;
+    };
+
+    double processingRate() const noexcept { return processingRate_; }
+
+    Grid makeGrid(std::vector<double> freqsHz) const;
+
+    /// 粗探索の評価周波数（processingRate のみで決まる）
+    std::vector<double> coarseFrequencies() const;
+
+    /// 適応サンプリングの評価周波数（候補Band範囲の union に比例配分）。候補が無ければ空
+    std::vector<double> adaptiveFrequencies(
+        const std::vector<const BandInfo*>& measuredCands,
+        const std::vector<const BandInfo*>& upperBoundCands) const;
+
+    /// 1 Band の H をグリッド全点で評価する
+    static void evaluateBandResponse(const EQCoeffsBiquad& c, const Grid& grid,
+                                     double* outRe, double* outIm) noexcept;
+
+    /// 応答行から粗探索結果（MergedSample + bandMaxDelta/bandMaxMagnitude）を集約する
+    CoarseScanResult aggregateCoarse(const Grid& grid, const ResponseRows& rows) const;
+
+    /// 応答行から適応サンプリング結果を集約する
+    AdaptiveScanResult aggregateAdaptive(const Grid& grid, const ResponseRows& rows) const;
+
     // 定数
     static constexpr int kCoarsePoints = 600;
     static constexpr int kAdaptivePoints = 128;
     static constexpr double kDeltaThreshold = 0.1;
 
 private:
+    /// H_j(e^{jω_k}) の表を計算する（レイアウト: [band * numFreqs + k]）
+    void computeResponseTable(const Grid& grid,
+                              const BandCollection& bands,
+                              std::vector<double>& outRe,
+                              std::vector<double>& outIm,
+                              ResponseRows& rows) const;
+
+    std::vector<MergedSample> aggregateSamples(const Grid& grid, const ResponseRows& rows) const;
+
     double processingRate_;
     bool isParallel_;
     double nyquist_;
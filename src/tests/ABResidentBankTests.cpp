@@ -0,0 +1,136 @@
+//==============================================================================
+// ABResidentBankTests.cpp
+//
+// convo::ABResidentBank / isSameResidentBuild (audioengine/ABResidentBank.h) のテスト。
+//   1. 常駐登録した DSP だけが retire 経路で park されること
+//   2. park 時の epoch を全 reader が越えるまで再公開用に取り出せないこと
+//   3. スロットの上書き・解除で、park 済みかつ未参照の DSP だけが破棄対象として返ること
+//   4. A/B 両方が同じ DSP を参照する場合に二重破棄しないこと
+//   5. 構築入力・Convolver fingerprint の一致判定
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "audioengine/ABResidentBank.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+struct FakeCore
+{
+    int id = 0;
+};
+
+using Bank = convo::ABResidentBank<FakeCore>;
+
+void testParkOnlyResident()
+{
+    Bank bank;
+    FakeCore a { 1 };
+    FakeCore other { 2 };
+    check(bank.capture(convo::ABSlot::A, &a).core == nullptr, "capture into empty slot releases nothing");
+    check(!bank.parkIfResident(&other, 10), "non-resident core is not parked");
+    check(bank.parkIfResident(&a, 10), "resident core is parked");
+    check(bank.isParked(convo::ABSlot::A), "slot reports parked");
+    check(!bank.parkIfResident(nullptr, 10), "nullptr is never parked");
+}
+
+void testAcquireWaitsForReaders()
+{
+    Bank bank;
+    FakeCore a { 1 };
+    (void)bank.capture(convo::ABSlot::A, &a);
+    check(bank.acquireForPublish(convo::ABSlot::A, 100) == nullptr, "live (not parked) core cannot be acquired");
+
+    (void)bank.parkIfResident(&a, 10);
+    check(bank.acquireForPublish(convo::ABSlot::A, 10) == nullptr, "reader still at park epoch");
+    check(bank.acquireForPublish(convo::ABSlot::A, 11) == &a, "readers past park epoch");
+    check(!bank.isParked(convo::ABSlot::A), "acquired core is live again");
+    check(bank.acquireForPublish(convo::ABSlot::A, 11) == nullptr, "cannot acquire twice");
+}
+
+void testReleaseReturnsOnlyParkedUnreferenced()
+{
+    Bank bank;
+    FakeCore a { 1 };
+    FakeCore b { 2 };
+    (void)bank.capture(convo::ABSlot::A, &a);
+    check(bank.release(convo::ABSlot::A).core == nullptr, "live core is left to the normal retire");
+
+    (void)bank.capture(convo::ABSlot::A, &a);
+    (void)bank.parkIfResident(&a, 5);
+    check(bank.capture(convo::ABSlot::A, &b).core == &a, "overwritten parked core is returned for destruction");
+    check(bank.residentCore(convo::ABSlot::A) == &b, "slot now holds the new core");
+    check(bank.capture(convo::ABSlot::A, &b).core == nullptr, "re-capturing the same core is a no-op");
+}
+
+void testSharedCoreNotDoubleReleased()
+{
+    Bank bank;
+    FakeCore shared { 1 };
+    (void)bank.capture(convo::ABSlot::A, &shared);
+    (void)bank.capture(convo::ABSlot::B, &shared);
+    check(bank.parkIfResident(&shared, 3), "shared core parked");
+    check(bank.isParked(convo::ABSlot::A) && bank.isParked(convo::ABSlot::B), "park state mirrored on both slots");
+
+    int visited = 0;
+    bank.forEachParkedCore([&visited](const FakeCore&) { ++visited; });
+    check(visited == 1, "shared parked core enumerated once");
+
+    check(bank.release(convo::ABSlot::A).core == nullptr, "still referenced by B");
+    check(bank.release(convo::ABSlot::B).core == &shared, "last reference releases the core");
+}
+
+void testSameResidentBuild()
+{
+    convo::BuildInput resident;
+    resident.sampleRate = 48000.0;
+    resident.blockSize = 512;
+    resident.oversamplingFactor = 2;
+    constexpr std::uint64_t kFingerprint = 0x1234u;
+
+    check(convo::isSameResidentBuild(resident, kFingerprint, resident, kFingerprint), "identical build");
+    check(!convo::isSameResidentBuild(resident, kFingerprint, resident, kFingerprint + 1), "convolver fingerprint differs");
+
+    auto requested = resident;
+    requested.oversamplingFactor = 4;
+    check(!convo::isSameResidentBuild(resident, kFingerprint, requested, kFingerprint), "oversampling differs");
+
+    requested = resident;
+    requested.outputMakeupGain = 0.5;
+    check(!convo::isSameResidentBuild(resident, kFingerprint, requested, kFingerprint), "gain differs");
+
+    check(convo::isResidentBuildRateCompatible(resident, 48000.0, 512), "same device");
+    check(!convo::isResidentBuildRateCompatible(resident, 44100.0, 512), "sample rate changed");
+    check(!convo::isResidentBuildRateCompatible(resident, 48000.0, 256), "block size changed");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[ABResidentBankTests] Start\n";
+    testParkOnlyResident();
+    testAcquireWaitsForReaders();
+    testReleaseReturnsOnlyParkedUnreferenced();
+    testSharedCoreNotDoubleReleased();
+    testSameResidentBuild();
+    std::cout << "[ABResidentBankTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+//==============================================================================
+// AdaptiveSliceBudgetTests.cpp
+//
+// AdaptiveSliceBudget (incremental rebuild のスライス見積り) のテスト。
+//   1. スライスは見積りに関係なく最低 1 ステップ進むこと
+//   2. 未計測の種類は予算いっぱいと見なし、2 ステップ目以降には入れないこと
+//   3. 実測済みの短いステップは予算に収まる数だけ同じスライスに詰めること
+//   4. 見積りが指数移動平均で実測に追従すること
+//   5. 予算を縮めるとスライスあたりのステップ数が減ること
+//   6. restUs が実行 : 周期 = 予算 : 周期 を保ち、予算超過のステップの後は比例して長く休むこと
+//   7. ConvolverProcessor の incremental rebuild (runIncrementalRebuild → advanceIncrementalRebuild) と
+//      同じ形のジョブ (LoadIR/Trim/Transform/Build + 適用の 5 ステップ) を runPacedSlices で完了まで回し、
+//      全ステップが順に 1 回ずつ走り、実行時間の比率が予算 / 周期に収まること
+//   8. 見積りを引き継いだ 2 回目のジョブでは短いステップが同じスライスに詰められること
+//   9. 休止中の取り消しが次のスライスを待たずに効き、失敗したステップでジョブが止まること
+// を検証する。時刻は仮想時計で進める。JUCE 非依存。
+//==============================================================================
+#include "core/AdaptiveSliceBudget.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Budget = convo::AdaptiveSliceBudget<3>;
+
+// 所要時間 stepUs の kind 0 を、予算内で何ステップ詰めるか (実時間の代わりに経過を積算する)
+int stepsPerSlice(Budget& budget, uint64_t stepUs)
+{
+    budget.beginSlice();
+    uint64_t elapsed = 0;
+    while (budget.admit(0, elapsed) && budget.getStepsInSlice() < 1000)
+    {
+        budget.record(0, stepUs);
+        elapsed += stepUs;
+    }
+    return budget.getStepsInSlice();
+}
+
+void testFirstStepAlwaysRuns()
+{
+    Budget budget;
+    budget.setBudgetUs(1000);
+    budget.record(1, 50000);
+    budget.beginSlice();
+    check(budget.admit(1, 0), "step estimated over budget still runs as the first step");
+    check(budget.getBudgetUs() == 1000, "budget is stored");
+}
+
+void testUnmeasuredKindRunsAlone()
+{
+    Budget budget;
+    budget.setBudgetUs(1000);
+    budget.beginSlice();
+    check(budget.estimateUs(2) == 1000, "unmeasured kind is estimated at the full budget");
+    budget.record(0, 10);
+    check(!budget.admit(2, 10), "unmeasured kind does not join a slice that already ran a step");
+    check(budget.estimateUs(-1) == 1000 && budget.estimateUs(3) == 1000, "out-of-range kind is treated as unmeasured");
+}
+
+void testShortStepsArePacked()
+{
+    Budget budget;
+    budget.setBudgetUs(1000);
+    budget.record(0, 100);
+    check(stepsPerSlice(budget, 100) == 10, "100 us steps fill a 1000 us slice with 10 steps");
+}
+
+void testEstimateTracksMeasurements()
+{
+    Budget budget;
+    budget.setBudgetUs(10000);
+    budget.record(0, 400);
+    check(budget.estimateUs(0) == 400, "first sample seeds the estimate");
+    budget.record(0, 800);
+    check(budget.estimateUs(0) == 500, "second sample moves by the smoothing weight");
+    for (int i = 0; i < 40; ++i)
+        budget.record(0, 800);
+    check(budget.estimateUs(0) == 800, "estimate converges to a steady duration");
+}
+
+void testSmallerBudgetMeansSmallerSlices()
+{
+    Budget budget;
+    budget.setBudgetUs(8000);
+    budget.record(0, 1000);
+    const int large = stepsPerSlice(budget, 1000);
+    budget.setBudgetUs(2000);
+    const int small = stepsPerSlice(budget, 1000);
+    check(large == 8 && small == 2, "slice size follows the budget");
+    budget.setBudgetUs(0);
+    check(budget.getBudgetUs() == 1 && stepsPerSlice(budget, 1000) == 1, "zero budget degrades to one step per slice");
+}
+
+void testRestKeepsDutyCycle()
+{
+    Budget budget;
+    budget.setBudgetUs(2000);
+    check(budget.restUs(1000, 16000, 250000) == 15000, "short slice rests for the rest of the period");
+    check(budget.restUs(2000, 16000, 250000) == 14000, "slice at the budget rests period minus budget");
+    check(budget.restUs(10000, 16000, 250000) == 70000, "overrun slice rests in proportion (2 ms of every 16 ms)");
+    check(budget.restUs(100000, 16000, 250000) == 250000, "rest is capped");
+    budget.setBudgetUs(32000);
+    check(budget.restUs(40000, 16000, 250000) == 0, "budget above the period never rests");
+}
+
+//==============================================================================
+// 仮想時計の上で動く incremental rebuild ジョブ
+//   ConvolverProcessor::advanceIncrementalRebuild と同じく、スライス 1 回を runBudgetedSlice で進め、
+//   runIncrementalRebuild と同じく runPacedSlices でスライス間を休む
+//==============================================================================
+using RebuildBudget = convo::AdaptiveSliceBudget<5>;
+
+struct FakeRebuildJob
+{
+    uint64_t now = 0;
+    uint64_t busyUs = 0;
+    uint64_t sleptUs = 0;
+    std::vector<uint64_t> stepUs;   // kind ごとの所要時間 (LoadIR, Trim, Transform, Build, 適用)
+    std::vector<int> ran;
+    int failAtKind = -1;
+    uint64_t cancelAtUs = UINT64_MAX;
+    int slices = 0;
+    int maxStepsInSlice = 0;
+
+    convo::SliceResult run(RebuildBudget& budget, uint64_t periodUs)
+    {
+        auto nowUs = [this] { return now; };
+        return convo::runPacedSlices(
+            budget, periodUs, 250000, 2000, nowUs,
+            [&]
+            {
+                ++slices;
+                const auto result = convo::runBudgetedSlice(
+                    budget, nowUs,
+                    [this] { return ran.size() == stepUs.size(); },
+                    [this] { return static_cast<int>(ran.size()); },
+                    [this]
+                    {
+                        const int kind = static_cast<int>(ran.size());
+                        now += stepUs[static_cast<size_t>(kind)];
+                        busyUs += stepUs[static_cast<size_t>(kind)];
+                        ran.push_back(kind);
+                        return kind != failAtKind;
+                    });
+                maxStepsInSlice = std::max(maxStepsInSlice, budget.getStepsInSlice());
+                return result;
+            },
+            [this] { return now >= cancelAtUs; },
+            [this](uint64_t us) { now += us; sleptUs += us; });
+    }
+};
+
+void testPacedRebuildRunsEveryStepOnce()
+{
+    RebuildBudget budget;
+    budget.setBudgetUs(6000);
+    FakeRebuildJob job;
+    job.stepUs = { 3000, 1000, 40000, 20000, 500 };
+
+    const auto result = job.run(budget, 16000);
+    check(result == convo::SliceResult::Completed, "paced rebuild completes");
+    check(job.ran == std::vector<int>({ 0, 1, 2, 3, 4 }), "every step runs once in order");
+    check(job.slices == 5 && job.maxStepsInSlice == 1, "unmeasured steps each get their own slice");
+    // 最後のスライスの後は休まないので除いて比べる。予算未満のスライスは周期の残りを休むため比率は予算 / 周期以下
+    const double lastUs = static_cast<double>(job.stepUs.back());
+    const double duty = (static_cast<double>(job.busyUs) - lastUs) / (static_cast<double>(job.now) - lastUs);
+    check(duty <= 6.0 / 16.0 + 1e-9 && duty > 0.3, "busy share stays at budget / period despite long steps");
+    check(budget.estimateUs(2) == 40000 && budget.estimateUs(4) == 500, "step durations are recorded per kind");
+}
+
+void testLearnedEstimatesPackShortSteps()
+{
+    RebuildBudget budget;
+    budget.setBudgetUs(6000);
+    FakeRebuildJob first;
+    first.stepUs = { 1000, 1000, 1000, 1000, 500 };
+    (void)first.run(budget, 16000);
+
+    // runIncrementalRebuild は共有見積りを写してから始める
+    RebuildBudget next = budget;
+    FakeRebuildJob second;
+    second.stepUs = first.stepUs;
+    const auto result = second.run(next, 16000);
+    check(result == convo::SliceResult::Completed, "second rebuild completes");
+    check(second.slices == 1 && second.maxStepsInSlice == 5, "measured short steps share one slice");
+    check(second.sleptUs == 0, "a rebuild finished in one slice does not rest");
+}
+
+void testCancelDuringRestAndFailure()
+{
+    RebuildBudget budget;
+    budget.setBudgetUs(2000);
+    FakeRebuildJob canceled;
+    canceled.stepUs = { 4000, 4000, 4000, 4000, 500 };
+    canceled.cancelAtUs = 10000;
+    check(canceled.run(budget, 16000) == convo::SliceResult::Canceled, "cancel during rest stops the rebuild");
+    check(canceled.ran.size() == 1, "no further step runs after the cancel");
+    check(canceled.now <= 10000 + 2000, "cancel takes effect within one poll interval");
+
+    RebuildBudget budget2;
+    budget2.setBudgetUs(2000);
+    FakeRebuildJob failing;
+    failing.stepUs = { 100, 100, 100, 100, 100 };
+    failing.failAtKind = 2;
+    check(failing.run(budget2, 16000) == convo::SliceResult::Failed, "failed step fails the rebuild");
+    check(failing.ran.size() == 3, "steps after the failure do not run");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[AdaptiveSliceBudgetTests] Start\n";
+    testFirstStepAlwaysRuns();
+    testUnmeasuredKindRunsAlone();
+    testShortStepsArePacked();
+    testEstimateTracksMeasurements();
+    testSmallerBudgetMeansSmallerSlices();
+    testRestKeepsDutyCycle();
+    testPacedRebuildRunsEveryStepOnce();
+    testLearnedEstimatesPackShortSteps();
+    testCancelDuringRestAndFailure();
+    std::cout << "[AdaptiveSliceBudgetTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+//==============================================================================
+// AffinityRebalancerTests.cpp
+//
+// AffinityRebalancer (評価ワーカー退避のヒステリシス判定) のテスト。
+//   1. 高負荷かつ評価ワーカーが CPU を使う状態が restrictTicks 回続いたときだけ Restrict になること
+//   2. 評価ワーカーが遊んでいれば高負荷でも退避しないこと
+//   3. 返却は低負荷が releaseTicks 回続いたときだけで、中間帯域・一時的な高負荷では状態を保つこと
+//   4. reset() で退避状態が解除され、回数カウンタは残ること
+// を検証する。JUCE 非依存。
+//==============================================================================
+#include "core/AffinityRebalancer.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::AffinityRebalanceDecision;
+
+constexpr convo::AffinityRebalanceConfig kConfig{ 650, 400, 250, 3, 5 };
+
+void testRestrictNeedsSustainedPressure()
+{
+    convo::AffinityRebalancer rebalancer(kConfig);
+    check(rebalancer.update(800, 900) == AffinityRebalanceDecision::Hold, "first high tick holds");
+    check(rebalancer.update(800, 900) == AffinityRebalanceDecision::Hold, "second high tick holds");
+    check(rebalancer.update(300, 900) == AffinityRebalanceDecision::Hold, "a low tick resets the streak");
+    check(rebalancer.update(800, 900) == AffinityRebalanceDecision::Hold, "streak restarts");
+    rebalancer.update(800, 900);
+    check(rebalancer.update(800, 900) == AffinityRebalanceDecision::Restrict, "third consecutive high tick restricts");
+    check(rebalancer.isRestricted() && rebalancer.getRestrictCount() == 1, "restricted state and count");
+    check(rebalancer.update(900, 900) == AffinityRebalanceDecision::Hold, "already restricted holds");
+}
+
+void testIdleLearnerIsNotMoved()
+{
+    convo::AffinityRebalancer rebalancer(kConfig);
+    bool moved = false;
+    for (int i = 0; i < 20; ++i)
+        moved = moved || rebalancer.update(950, 100) != AffinityRebalanceDecision::Hold;
+    check(!moved, "high load with an idle learner does not restrict");
+}
+
+void testReleaseHysteresis()
+{
+    convo::AffinityRebalancer rebalancer(kConfig);
+    for (int i = 0; i < 3; ++i)
+        rebalancer.update(800, 900);
+    check(rebalancer.isRestricted(), "restricted before the release checks");
+
+    bool released = false;
+    for (int i = 0; i < 20; ++i)
+        released = released || rebalancer.update(500, 0) != AffinityRebalanceDecision::Hold;
+    check(!released, "load between the thresholds keeps the restriction");
+
+    for (int i = 0; i < 4; ++i)
+        rebalancer.update(200, 0);
+    check(rebalancer.update(700, 0) == AffinityRebalanceDecision::Hold, "a high tick interrupts the low streak");
+    for (int i = 0; i < 4; ++i)
+        check(rebalancer.update(200, 0) == AffinityRebalanceDecision::Hold, "low streak below releaseTicks holds");
+    check(rebalancer.update(200, 0) == AffinityRebalanceDecision::Release, "releaseTicks consecutive low ticks release");
+    check(!rebalancer.isRestricted() && rebalancer.getReleaseCount() == 1, "released state and count");
+}
+
+void testReset()
+{
+    convo::AffinityRebalancer rebalancer(kConfig);
+    for (int i = 0; i < 3; ++i)
+        rebalancer.update(800, 900);
+    rebalancer.reset();
+    check(!rebalancer.isRestricted(), "reset clears the restriction");
+    check(rebalancer.getRestrictCount() == 1, "reset keeps the decision counters");
+    check(rebalancer.update(800, 900) == AffinityRebalanceDecision::Hold, "reset clears the streak");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[AffinityRebalancerTests] Start\n";
+    testRestrictNeedsSustainedPressure();
+    testIdleLearnerIsNotMoved();
+    testReleaseHysteresis();
+    testReset();
+    std::cout << "[AffinityRebalancerTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
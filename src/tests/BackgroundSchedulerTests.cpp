@@ -0,0 +1,275 @@
+//==============================================================================
+// BackgroundSchedulerTests.cpp
+//
+// convo::BackgroundScheduler (core/BackgroundScheduler.h) のテスト。
+//   1. 空いたワーカーが優先度の高いクラスから取り出し、同じクラスは投入順に実行すること
+//   2. 未開始のタスクを cancel すると実行されず、実行中のタスクはトークンで中断を知ること
+//   3. ActivityScope の申告中は下位クラスが取り出されず、hasWorkAbove / shouldYield が true になること
+//   4. Learning の同時実行がワーカー数の半分に抑えられること
+//   5. stop が未開始のタスクを実行せずに終わらせ、実行中のタスクにはトークンで中断を知らせ、
+//      停止後の submit は空のハンドルを返すこと
+//   6. onWorkerStart がワーカーごとに 1 回呼ばれること
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "core/BackgroundScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::BackgroundPriority;
+using convo::BackgroundScheduler;
+using std::chrono::milliseconds;
+
+// open() されるまでタスクを止めておくゲート
+struct Gate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool opened = false;
+    std::atomic<int> entered { 0 };
+
+    void pass()
+    {
+        entered.fetch_add(1, std::memory_order_acq_rel);
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return opened; });
+    }
+    void open()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            opened = true;
+        }
+        cv.notify_all();
+    }
+};
+
+bool waitUntil(const std::atomic<int>& value, int expected, milliseconds timeout)
+{
+    const auto until = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < until)
+    {
+        if (value.load(std::memory_order_acquire) >= expected)
+            return true;
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return value.load(std::memory_order_acquire) >= expected;
+}
+
+void testPriorityOrder()
+{
+    BackgroundScheduler scheduler;
+    scheduler.start(1);
+
+    Gate gate;
+    auto blocker = scheduler.submit(BackgroundPriority::Housekeeping, [&](const auto&) { gate.pass(); });
+    check(waitUntil(gate.entered, 1, milliseconds(2000)), "priority: blocker occupies the only worker");
+
+    std::mutex orderMutex;
+    std::vector<int> order;
+    const auto record = [&](int id) {
+        return [&, id](const BackgroundScheduler::CancelToken&) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(id);
+        };
+    };
+    std::vector<BackgroundScheduler::TaskHandle> handles;
+    handles.push_back(scheduler.submit(BackgroundPriority::Learning, record(30)));
+    handles.push_back(scheduler.submit(BackgroundPriority::Upgrade, record(20)));
+    handles.push_back(scheduler.submit(BackgroundPriority::InteractiveRebuild, record(0)));
+    handles.push_back(scheduler.submit(BackgroundPriority::Upgrade, record(21)));
+    handles.push_back(scheduler.submit(BackgroundPriority::IRLoad, record(10)));
+
+    check(scheduler.hasWorkAbove(BackgroundPriority::Learning), "priority: queued upgrade work is above learning");
+    gate.open();
+    for (auto& h : handles)
+        check(h.wait(milliseconds(2000)) && h.wasRun(), "priority: task finished");
+
+    const std::vector<int> expected { 0, 10, 20, 21, 30 };
+    check(order == expected, "priority: highest class first, FIFO within a class");
+    check(blocker.wait(milliseconds(2000)), "priority: blocker finished");
+    // wait() はタスク本体の完了で戻り、実行数の集計はその直後にワーカーが戻す
+    const auto until = std::chrono::steady_clock::now() + milliseconds(2000);
+    while (scheduler.hasWorkAbove(BackgroundPriority::Housekeeping) && std::chrono::steady_clock::now() < until)
+        std::this_thread::sleep_for(milliseconds(1));
+    check(!scheduler.hasWorkAbove(BackgroundPriority::Housekeeping), "priority: nothing busy after drain");
+}
+
+void testCancellation()
+{
+    BackgroundScheduler scheduler;
+    scheduler.start(1);
+
+    Gate gate;
+    std::atomic<bool> sawCancel { false };
+    std::atomic<int> started { 0 };
+    auto running = scheduler.submit(BackgroundPriority::Upgrade, [&](const BackgroundScheduler::CancelToken& token) {
+        started.fetch_add(1);
+        while (!token.isCancelled())
+            std::this_thread::sleep_for(milliseconds(1));
+        sawCancel.store(true);
+    });
+    check(waitUntil(started, 1, milliseconds(2000)), "cancel: long task started");
+
+    std::atomic<bool> pendingRan { false };
+    auto pending = scheduler.submit(BackgroundPriority::Upgrade, [&](const auto&) { pendingRan.store(true); });
+    pending.cancel();
+    check(pending.isFinished() && !pending.wasRun(), "cancel: pending task finishes without running");
+
+    running.cancel();
+    check(running.wait(milliseconds(2000)) && running.wasRun(), "cancel: running task returns");
+    check(sawCancel.load(), "cancel: running task observed the token");
+
+    // 後続が流れることを確かめてから、キャンセル済みタスクが実行されていないことを見る
+    auto after = scheduler.submit(BackgroundPriority::Upgrade, [](const auto&) {});
+    check(after.wait(milliseconds(2000)), "cancel: worker continues");
+    check(!pendingRan.load(), "cancel: cancelled task never ran");
+    check(scheduler.getStats().cancelled[static_cast<size_t>(BackgroundPriority::Upgrade)] == 1,
+          "cancel: counted as cancelled");
+}
+
+void testActivityScope()
+{
+    BackgroundScheduler scheduler;
+    scheduler.start(2);
+
+    std::atomic<int> learningRuns { 0 };
+    BackgroundScheduler::TaskHandle learning;
+    std::atomic<bool> yieldSeen { false };
+    {
+        BackgroundScheduler::ActivityScope irLoad(&scheduler, BackgroundPriority::IRLoad);
+        check(scheduler.hasWorkAbove(BackgroundPriority::Upgrade), "activity: IR load is above upgrade");
+        check(!scheduler.hasWorkAbove(BackgroundPriority::IRLoad), "activity: not above itself");
+
+        learning = scheduler.submit(BackgroundPriority::Learning, [&](const BackgroundScheduler::CancelToken& token) {
+            yieldSeen.store(token.shouldYield());
+            learningRuns.fetch_add(1);
+        });
+        std::this_thread::sleep_for(milliseconds(50));
+        check(learningRuns.load() == 0, "activity: lower class held back while declared");
+
+        std::atomic<int> higher { 0 };
+        auto rebuild = scheduler.submit(BackgroundPriority::InteractiveRebuild, [&](const auto&) { higher.fetch_add(1); });
+        check(rebuild.wait(milliseconds(2000)) && higher.load() == 1, "activity: higher class still runs");
+    }
+    check(learning.wait(milliseconds(2000)) && learningRuns.load() == 1, "activity: lower class runs after scope ends");
+    check(!yieldSeen.load(), "activity: no yield request once the scope ended");
+
+    BackgroundScheduler::ActivityScope none(nullptr, BackgroundPriority::IRLoad);   // nullptr は何もしない
+    check(!scheduler.hasWorkAbove(BackgroundPriority::Housekeeping), "activity: null scope is inert");
+}
+
+void testConcurrencyLimit()
+{
+    constexpr int kWorkers = 4;
+    check(BackgroundScheduler::concurrencyLimit(BackgroundPriority::Learning, kWorkers) == 2, "limit: learning gets half");
+    check(BackgroundScheduler::concurrencyLimit(BackgroundPriority::Upgrade, kWorkers) == 3, "limit: upgrade leaves one worker");
+    check(BackgroundScheduler::concurrencyLimit(BackgroundPriority::IRLoad, kWorkers) == kWorkers, "limit: IR load uses all");
+    check(BackgroundScheduler::concurrencyLimit(BackgroundPriority::Housekeeping, 1) == 1, "limit: at least one");
+
+    BackgroundScheduler scheduler;
+    scheduler.start(kWorkers);
+
+    Gate gate;
+    std::atomic<int> concurrent { 0 };
+    std::atomic<int> peak { 0 };
+    std::vector<BackgroundScheduler::TaskHandle> handles;
+    for (int i = 0; i < 6; ++i)
+    {
+        handles.push_back(scheduler.submit(BackgroundPriority::Learning, [&](const auto&) {
+            const int now = concurrent.fetch_add(1) + 1;
+            int prev = peak.load();
+            while (now > prev && !peak.compare_exchange_weak(prev, now)) {}
+            gate.pass();
+            concurrent.fetch_sub(1);
+        }));
+    }
+    check(waitUntil(gate.entered, 2, milliseconds(2000)), "limit: two learning tasks started");
+    std::this_thread::sleep_for(milliseconds(50));
+    check(gate.entered.load() == 2, "limit: third learning task waits");
+
+    // 空いているワーカーは上位クラスを即座に受け付ける
+    auto load = scheduler.submit(BackgroundPriority::IRLoad, [](const auto&) {});
+    check(load.wait(milliseconds(2000)), "limit: IR load runs on a spare worker");
+
+    gate.open();
+    for (auto& h : handles)
+        check(h.wait(milliseconds(2000)), "limit: learning task finished");
+    check(peak.load() == 2, "limit: peak learning concurrency is two");
+}
+
+void testStopAndWorkerStart()
+{
+    BackgroundScheduler scheduler;
+    std::atomic<int> workerStarts { 0 };
+    scheduler.start(3, [&](int) { workerStarts.fetch_add(1); });
+    check(waitUntil(workerStarts, 3, milliseconds(2000)), "stop: onWorkerStart called per worker");
+    check(scheduler.getWorkerCount() == 3, "stop: worker count");
+
+    Gate gate;
+    std::atomic<int> sawStop { 0 };
+    std::vector<BackgroundScheduler::TaskHandle> blockers;
+    for (int i = 0; i < 3; ++i)
+    {
+        blockers.push_back(scheduler.submit(BackgroundPriority::IRLoad, [&](const BackgroundScheduler::CancelToken& token) {
+            gate.pass();
+            if (token.isCancelled())
+                sawStop.fetch_add(1);
+        }));
+    }
+    check(waitUntil(gate.entered, 3, milliseconds(2000)), "stop: all workers busy");
+
+    std::atomic<bool> pendingRan { false };
+    auto pending = scheduler.submit(BackgroundPriority::Housekeeping, [&](const auto&) { pendingRan.store(true); });
+
+    std::thread opener([&] {
+        std::this_thread::sleep_for(milliseconds(20));
+        gate.open();
+    });
+    scheduler.stop();
+    opener.join();
+
+    check(pending.isFinished() && !pending.wasRun() && !pendingRan.load(), "stop: pending task dropped");
+    for (auto& b : blockers)
+        check(b.isFinished() && b.wasRun(), "stop: running tasks completed before stop returned");
+    check(sawStop.load() == 3, "stop: running tasks observed the stop request");
+    check(!scheduler.isRunning() && scheduler.getWorkerCount() == 0, "stop: scheduler stopped");
+    check(!scheduler.submit(BackgroundPriority::IRLoad, [](const auto&) {}), "stop: submit after stop returns empty handle");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[BackgroundSchedulerTests] Start\n";
+    testPriorityOrder();
+    testCancellation();
+    testActivityScope();
+    testConcurrencyLimit();
+    testStopAndWorkerStart();
+    std::cout << "[BackgroundSchedulerTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+//==============================================================================
+// BinTileLayoutTests.cpp
+//
+// BinTileLayout (NUC のビン優先スペクトル配置) のテスト。
+//   1. index が slots × complexSize の全単射であること
+//   2. タイル内で連続する slot が連続したメモリを占めること (巡回位置がポインタオフセットになる)
+//   3. toBinMajor / scatterSlot が index どおりに並べること
+//   4. タイル単位の MAC がパーティション優先の MAC と一致すること
+//   5. 自動選択の境界
+// を検証する。JUCE 非依存。
+//==============================================================================
+#include "core/BinTileLayout.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::BinTileLayout;
+
+void testIndexIsBijection()
+{
+    for (const int cs : { 129, 65, 16, 17, 1 })
+    {
+        const int slots = 8;
+        std::vector<int> hits(static_cast<size_t>(slots * cs), 0);
+        bool inRange = true;
+        for (int s = 0; s < slots; ++s)
+            for (int k = 0; k < cs; ++k)
+            {
+                const size_t i = BinTileLayout::index(slots, s, k, cs);
+                if (i >= hits.size())
+                    inRange = false;
+                else
+                    ++hits[i];
+            }
+        bool once = inRange;
+        for (const int h : hits)
+            once = once && (h == 1);
+        check(once, "index covers every element once (cs=" + std::to_string(cs) + ")");
+    }
+    check(BinTileLayout::numTiles(129) == 9 && BinTileLayout::tileWidth(8, 129) == 1, "129 bins end with a 1-bin tile");
+}
+
+void testSlotsAreContiguousWithinTile()
+{
+    const int slots = 64, cs = 129;
+    // 同じビンの slot s と s+1 はタイル幅だけ離れる
+    check(BinTileLayout::index(slots, 11, 5, cs) - BinTileLayout::index(slots, 10, 5, cs) == 16, "full tile stride");
+    check(BinTileLayout::index(slots, 11, 128, cs) - BinTileLayout::index(slots, 10, 128, cs) == 1, "last tile stride");
+    // タイル先頭は slots の倍数 × 16 で 64 byte 境界に乗る
+    check((BinTileLayout::tileOffset(slots, 3) * sizeof(double)) % 64 == 0, "tile base is cache-line aligned");
+    check(BinTileLayout::index(slots, 0, 16, cs) == BinTileLayout::tileOffset(slots, 1), "tile 1 starts after all slots of tile 0");
+}
+
+void testTransposeAndScatter()
+{
+    const int slots = 4, cs = 33;
+    std::vector<double> src(static_cast<size_t>(slots * cs));
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = static_cast<double>(i);
+
+    std::vector<double> tiled(src.size(), -1.0);
+    BinTileLayout::toBinMajor(src.data(), tiled.data(), slots, cs);
+    bool ok = true;
+    for (int s = 0; s < slots; ++s)
+        for (int k = 0; k < cs; ++k)
+            ok = ok && tiled[BinTileLayout::index(slots, s, k, cs)] == src[static_cast<size_t>(s * cs + k)];
+    check(ok, "toBinMajor places (slot, bin) at index");
+
+    std::vector<double> scattered(src.size(), 0.0);
+    for (int s = 0; s < slots; ++s)
+        BinTileLayout::scatterSlot(src.data() + s * cs, scattered.data(), slots, s, cs);
+    check(scattered == tiled, "scatterSlot per slot equals whole transpose");
+}
+
+void testTiledMacMatchesPartitionMajor()
+{
+    // FDL: mirror 付き 2*numParts slot、IR: numParts slot (逆順格納)。NUC と同じ linStart で読む
+    const int numParts = 8, numPartsIR = 6, cs = 65;
+    const int fdlSlots = numParts * 2;
+    std::vector<double> fdlRe(static_cast<size_t>(fdlSlots * cs)), fdlIm(fdlRe.size());
+    std::vector<double> irRe(static_cast<size_t>(numParts * cs)), irIm(irRe.size());
+    for (size_t i = 0; i < fdlRe.size(); ++i)
+    {
+        fdlRe[i] = std::sin(0.37 * static_cast<double>(i));
+        fdlIm[i] = std::cos(0.11 * static_cast<double>(i));
+    }
+    for (size_t i = 0; i < irRe.size(); ++i)
+    {
+        irRe[i] = std::cos(0.23 * static_cast<double>(i));
+        irIm[i] = std::sin(0.05 * static_cast<double>(i));
+    }
+    const int linStart = 3 - numPartsIR + 1 + numParts;
+
+    std::vector<double> refRe(static_cast<size_t>(cs), 0.0), refIm(refRe.size(), 0.0);
+    for (int p = 0; p < numPartsIR; ++p)
+        for (int k = 0; k < cs; ++k)
+        {
+            const size_t f = static_cast<size_t>((linStart + p) * cs + k);
+            const size_t h = static_cast<size_t>(p * cs + k);
+            refRe[static_cast<size_t>(k)] += fdlRe[f] * irRe[h] - fdlIm[f] * irIm[h];
+            refIm[static_cast<size_t>(k)] += fdlRe[f] * irIm[h] + fdlIm[f] * irRe[h];
+        }
+
+    std::vector<double> tFdlRe(fdlRe.size()), tFdlIm(fdlRe.size()), tIrRe(irRe.size()), tIrIm(irRe.size());
+    BinTileLayout::toBinMajor(fdlRe.data(), tFdlRe.data(), fdlSlots, cs);
+    BinTileLayout::toBinMajor(fdlIm.data(), tFdlIm.data(), fdlSlots, cs);
+    BinTileLayout::toBinMajor(irRe.data(), tIrRe.data(), numParts, cs);
+    BinTileLayout::toBinMajor(irIm.data(), tIrIm.data(), numParts, cs);
+
+    std::vector<double> accRe(static_cast<size_t>(cs), 0.0), accIm(accRe.size(), 0.0);
+    for (int t = 0; t < BinTileLayout::numTiles(cs); ++t)
+    {
+        const int k0 = BinTileLayout::tileBegin(t);
+        const int w = BinTileLayout::tileWidth(t, cs);
+        const double* fRe = tFdlRe.data() + BinTileLayout::tileOffset(fdlSlots, t) + static_cast<size_t>(linStart) * w;
+        const double* fIm = tFdlIm.data() + BinTileLayout::tileOffset(fdlSlots, t) + static_cast<size_t>(linStart) * w;
+        const double* hRe = tIrRe.data() + BinTileLayout::tileOffset(numParts, t);
+        const double* hIm = tIrIm.data() + BinTileLayout::tileOffset(numParts, t);
+        for (int p = 0; p < numPartsIR; ++p)
+            for (int k = 0; k < w; ++k)
+            {
+                const size_t o = static_cast<size_t>(p * w + k);
+                accRe[static_cast<size_t>(k0 + k)] += fRe[o] * hRe[o] - fIm[o] * hIm[o];
+                accIm[static_cast<size_t>(k0 + k)] += fRe[o] * hIm[o] + fIm[o] * hRe[o];
+            }
+    }
+    check(accRe == refRe && accIm == refIm, "tiled MAC is bit-identical to partition-major MAC");
+}
+
+void testAutoSelection()
+{
+    check(BinTileLayout::preferBinMajor(32, 129), "L0 with 32 partitions of 128 bins is tiled");
+    check(!BinTileLayout::preferBinMajor(4, 129), "few partitions stay partition-major");
+    check(!BinTileLayout::preferBinMajor(64, 4097), "long partitions stay partition-major");
+    check(BinTileLayout::preferBinMajor(BinTileLayout::kAutoMinParts, BinTileLayout::kAutoMaxComplexSize), "bounds are inclusive");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[BinTileLayoutTests] Start\n";
+    testIndexIsBijection();
+    testSlotsAreContiguousWithinTile();
+    testTransposeAndScatter();
+    testTiledMacMatchesPartitionMajor();
+    testAutoSelection();
+    std::cout << "[BinTileLayoutTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+//==============================================================================
+// BiquadCascadeTests.cpp
+//
+// convo::dsp::processStereoCascade3 (dsp/BiquadCascade.h) の一致テスト。
+//   1. ブロック分割 (長さ 1〜、不規則な分割) に依らず出力・状態がビット一致すること
+//      (OutputFilter の全モードの係数)
+//   2. std::fma で書いた 1 チャンネルずつの TDF-II 参照 (旧 biquadStep128_FMA) とビット一致すること
+//   3. 非 FMA の素朴な double 参照 (OutputFilter v1.0 / モノラルの式) と 1e-11 以内で一致すること
+//   4. 微小入力で状態がデノーマル閾値未満になったらブロック末尾で 0 に落ちること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "dsp/BiquadCascade.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::dsp::StereoBiquadCascade3Coeffs;
+using convo::dsp::StereoBiquadCascade3State;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDenormThreshold = 1.0e-20; // numeric_policy::kDenormThresholdAudioState と同値
+
+struct Coeff { double b0, b1, b2, a1, a2; };
+
+// OutputFilter::makeLPF / makeHPF と同じ RBJ 式
+Coeff makeFilter(bool highPass, double fc, double q, double fs)
+{
+    if (fc >= fs * 0.4999)
+        return { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    const double w0 = 2.0 * kPi * fc / fs;
+    const double sn = std::sin(w0);
+    const double cs = std::cos(w0);
+    const double alpha = sn / (2.0 * q);
+    const double a0inv = 1.0 / (1.0 + alpha);
+    const double k = highPass ? (1.0 + cs) : (1.0 - cs);
+    const double sign = highPass ? -1.0 : 1.0;
+    return { k * 0.5 * a0inv, sign * k * a0inv, k * 0.5 * a0inv, (-2.0 * cs) * a0inv, (1.0 - alpha) * a0inv };
+}
+
+struct Cascade
+{
+    std::string name;
+    Coeff stages[3];
+};
+
+// OutputFilter の ① LC → HC0 → HC1 / ② HPF → LP0 → LP1 と同じ組
+std::vector<Cascade> makeCascades(double fs)
+{
+    const double fcHc = (fs <= 48000.0) ? 19000.0 : 22000.0;
+    const double fcLp = (fs <= 48000.0) ? 19000.0 : 24000.0;
+    const Coeff identity { 1.0, 0.0, 0.0, 0.0, 0.0 };
+    const std::string rate = "@" + std::to_string(static_cast<int>(fs));
+    return {
+        { "conv sharp/natural" + rate, { makeFilter(true, 18.0, 0.70711, fs), makeFilter(false, fcHc, 0.54120, fs), makeFilter(false, fcHc, 1.30656, fs) } },
+        { "conv natural/soft" + rate,  { makeFilter(true, 15.0, 0.5, fs), makeFilter(false, fcHc, 0.70711, fs), makeFilter(false, fcHc, 0.70711, fs) } },
+        { "conv soft" + rate,          { makeFilter(true, 18.0, 0.70711, fs), makeFilter(false, fcHc, 0.5, fs), identity } },
+        { "eq sharp" + rate,           { makeFilter(true, 20.0, 0.70711, fs), makeFilter(false, fcLp, 1.0, fs), makeFilter(false, fcLp, 1.0, fs) } },
+        { "eq soft" + rate,            { makeFilter(true, 20.0, 0.70711, fs), makeFilter(false, fcLp, 0.5, fs), makeFilter(false, fcLp, 0.5, fs) } },
+    };
+}
+
+StereoBiquadCascade3Coeffs pack(const Cascade& cascade)
+{
+    StereoBiquadCascade3Coeffs c;
+    for (int s = 0; s < 3; ++s)
+    {
+        const Coeff& k = cascade.stages[s];
+        c.setStage(s, k.b0, k.b1, k.b2, k.a1, k.a2);
+    }
+    return c;
+}
+
+bool bitEqual(const std::vector<double>& a, const std::vector<double>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+bool stateEqual(const StereoBiquadCascade3State& a, const StereoBiquadCascade3State& b)
+{
+    return std::memcmp(a.w1, b.w1, sizeof(a.w1)) == 0 && std::memcmp(a.w2, b.w2, sizeof(a.w2)) == 0;
+}
+
+std::vector<double> makeSignal(int n, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> signal(static_cast<size_t>(n));
+    for (auto& v : signal) v = dist(rng);
+    return signal;
+}
+
+template<class Process>
+void runBlocks(Process&& process, std::vector<double>& l, std::vector<double>& r, const std::vector<int>& blockSizes)
+{
+    const int total = static_cast<int>(l.size());
+    int offset = 0;
+    size_t index = 0;
+    while (offset < total)
+    {
+        const int n = std::min(blockSizes[index++ % blockSizes.size()], total - offset);
+        process(l.data() + offset, r.data() + offset, n);
+        offset += n;
+    }
+}
+
+void testBlockSplitInvariance()
+{
+    const std::vector<std::vector<int>> splits { { 1 }, { 2 }, { 3 }, { 5000 }, { 1, 2, 3, 64, 7, 480, 2 }, { 17 } };
+    for (const double fs : { 44100.0, 96000.0, 705600.0 })
+    {
+        for (const Cascade& cascade : makeCascades(fs))
+        {
+            const StereoBiquadCascade3Coeffs coeffs = pack(cascade);
+            const auto inL = makeSignal(5000, 1);
+            const auto inR = makeSignal(5000, 2);
+
+            for (const auto& split : splits)
+            {
+                auto wholeL = inL, wholeR = inR, splitL = inL, splitR = inR;
+                StereoBiquadCascade3State wholeState, splitState;
+                runBlocks([&](double* l, double* r, int n)
+                          { convo::dsp::processStereoCascade3(l, r, n, coeffs, wholeState, kDenormThreshold); },
+                          wholeL, wholeR, { 5000 });
+                runBlocks([&](double* l, double* r, int n)
+                          { convo::dsp::processStereoCascade3(l, r, n, coeffs, splitState, kDenormThreshold); },
+                          splitL, splitR, split);
+
+                const std::string label = cascade.name + " split[0]=" + std::to_string(split[0])
+                                        + " size=" + std::to_string(split.size());
+                check(bitEqual(wholeL, splitL) && bitEqual(wholeR, splitR), "output is identical across block splits: " + label);
+                check(stateEqual(wholeState, splitState), "state is identical across block splits: " + label);
+            }
+        }
+    }
+}
+
+// std::fma で 1 チャンネルずつ書いた TDF-II (旧 biquadStep128_FMA と同じ演算順)
+void referenceFma(std::vector<double>& data, const Cascade& cascade)
+{
+    double w1[3] {}, w2[3] {};
+    for (auto& v : data)
+    {
+        double x = v;
+        for (int s = 0; s < 3; ++s)
+        {
+            const Coeff& c = cascade.stages[s];
+            const double y = std::fma(c.b0, x, w1[s]);
+            const double newW1 = std::fma(c.b1, x, std::fma(-c.a1, y, w2[s]));
+            const double newW2 = std::fma(-c.a2, y, c.b2 * x);
+            w1[s] = (std::abs(newW1) < kDenormThreshold) ? 0.0 : newW1;
+            w2[s] = (std::abs(newW2) < kDenormThreshold) ? 0.0 : newW2;
+            x = y;
+        }
+        v = x;
+    }
+}
+
+// OutputFilter v1.0 の BiquadState::process (FMA なし)
+void referencePlain(std::vector<double>& data, const Cascade& cascade)
+{
+    double w1[3] {}, w2[3] {};
+    for (auto& v : data)
+    {
+        double x = v;
+        for (int s = 0; s < 3; ++s)
+        {
+            const Coeff& c = cascade.stages[s];
+            const double y = c.b0 * x + w1[s];
+            w1[s] = c.b1 * x - c.a1 * y + w2[s];
+            w2[s] = c.b2 * x - c.a2 * y;
+            x = y;
+        }
+        v = x;
+    }
+}
+
+void testMatchesScalarReferences()
+{
+    for (const double fs : { 48000.0, 192000.0 })
+    {
+        for (const Cascade& cascade : makeCascades(fs))
+        {
+            const StereoBiquadCascade3Coeffs coeffs = pack(cascade);
+            auto l = makeSignal(8192, 3);
+            auto r = makeSignal(8192, 4);
+            auto fmaL = l, fmaR = r, plainL = l, plainR = r;
+
+            StereoBiquadCascade3State state;
+            convo::dsp::processStereoCascade3(l.data(), r.data(), 8192, coeffs, state, kDenormThreshold);
+            referenceFma(fmaL, cascade);
+            referenceFma(fmaR, cascade);
+            referencePlain(plainL, cascade);
+            referencePlain(plainR, cascade);
+
+            check(bitEqual(l, fmaL) && bitEqual(r, fmaR), "matches the per-channel fma reference: " + cascade.name);
+
+            double maxDiff = 0.0;
+            for (size_t i = 0; i < l.size(); ++i)
+                maxDiff = std::max({ maxDiff, std::abs(l[i] - plainL[i]), std::abs(r[i] - plainR[i]) });
+            // 低域 HPF (15〜20Hz) は極が単位円に近く、FMA の丸め差が 1e-12 オーダーまで増幅される
+            check(maxDiff <= 1.0e-11, "within 1e-11 of the non-fused scalar cascade: " + cascade.name);
+        }
+    }
+}
+
+void testDenormalFlush()
+{
+    const Cascade cascade = makeCascades(48000.0)[0];
+    const StereoBiquadCascade3Coeffs coeffs = pack(cascade);
+    StereoBiquadCascade3State state;
+
+    // 単発インパルスの後は無音: 状態は減衰し、ブロック末尾で閾値未満なら 0 に落ちる
+    std::vector<double> l(200000, 0.0), r(200000, 0.0);
+    l[0] = 1.0e-12;
+    r[0] = -1.0e-12;
+    runBlocks([&](double* bl, double* br, int n)
+              { convo::dsp::processStereoCascade3(bl, br, n, coeffs, state, kDenormThreshold); },
+              l, r, { 512 });
+
+    bool zeroState = true;
+    for (int s = 0; s < 3; ++s)
+        for (int ch = 0; ch < 2; ++ch)
+            zeroState = zeroState && state.w1[s][ch] == 0.0 && state.w2[s][ch] == 0.0;
+    check(zeroState, "state decays to exact zero below the denormal threshold");
+    check(l.back() == 0.0 && r.back() == 0.0, "output settles to exact zero");
+
+    state.w1[1][0] = 0.5;
+    state.reset();
+    check(state.w1[1][0] == 0.0, "reset clears the state");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[BiquadCascadeTests] Start\n";
+    testBlockSplitInvariance();
+    testMatchesScalarReferences();
+    testDenormalFlush();
+    std::cout << "[BiquadCascadeTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+//==============================================================================
+// BlockHealthScanTests.cpp
+//
+// convo::health::scanAndScrubStereo (audioengine/BlockHealthScan.h) のテスト。
+// 融合前の DSPCore 出力段 (measureLevel の |x| 最大 → ヘッドルーム → NaN/Inf 除去を 1 段ずつ全サンプル走査) を
+// 下の referenceScan で再現し、
+//   1. 健全なブロックでは値 (ゲイン適用後) とピークが参照とビット一致し、不正サンプル数が 0 であること
+//   2. NaN / ±Inf / 上限以上の値が 0 に置き換わり、その個数が数えられ、ピークに入らないこと
+//   3. 4 サンプル未満の端数・長さ 0・モノラル (right == nullptr) でも参照と一致すること
+//   4. 不正サンプルがベクトル部・端数部・L/R のどこにあっても数え漏れがないこと
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "audioengine/BlockHealthScan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+struct Reference
+{
+    std::vector<double> left;
+    std::vector<double> right;
+    double peak = 0.0;
+    int badSamples = 0;
+};
+
+Reference referenceScan(std::vector<double> left, std::vector<double> right, bool applyGain, double gain)
+{
+    Reference ref;
+    for (auto* channel : { &left, &right })
+    {
+        for (double& v : *channel)
+        {
+            if (applyGain)
+                v *= gain;
+            if (!std::isfinite(v) || std::abs(v) >= convo::health::kSampleBound)
+            {
+                v = 0.0;
+                ++ref.badSamples;
+            }
+            ref.peak = std::max(ref.peak, std::abs(v));
+        }
+    }
+    ref.left = std::move(left);
+    ref.right = std::move(right);
+    return ref;
+}
+
+bool bitEqual(const std::vector<double>& a, const std::vector<double>& b)
+{
+    return a.size() == b.size()
+        && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+std::vector<double> noise(int n, std::mt19937& rng)
+{
+    std::uniform_real_distribution<double> dist(-1.5, 1.5);
+    std::vector<double> v(static_cast<size_t>(n));
+    for (auto& x : v)
+        x = dist(rng);
+    return v;
+}
+
+void compareWithReference(std::vector<double> left, std::vector<double> right, bool stereo,
+                          bool applyGain, double gain, const std::string& name)
+{
+    if (!stereo)
+        right.clear();
+    const Reference ref = referenceScan(left, right, applyGain, gain);
+    const int n = static_cast<int>(left.size());
+    const auto health = applyGain
+        ? convo::health::scanAndScrubStereo<true>(left.data(), stereo ? right.data() : nullptr, n, gain)
+        : convo::health::scanAndScrubStereo<false>(left.data(), stereo ? right.data() : nullptr, n);
+
+    check(bitEqual(left, ref.left) && bitEqual(right, ref.right), name + ": samples match the reference");
+    check(health.peak == ref.peak, name + ": peak matches the reference");
+    check(health.badSamples == ref.badSamples && health.isCorrupted() == (ref.badSamples > 0),
+          name + ": bad sample count matches the reference");
+}
+
+void testHealthyBlocks()
+{
+    std::mt19937 rng(7);
+    for (const int n : { 64, 480, 4096 })
+    {
+        const std::string size = std::to_string(n);
+        compareWithReference(noise(n, rng), noise(n, rng), true, false, 1.0, "healthy " + size);
+        compareWithReference(noise(n, rng), noise(n, rng), true, true, 0.8912509381337456, "healthy gain " + size);
+    }
+}
+
+void testCorruptedSamples()
+{
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> left(32, 0.25);
+    std::vector<double> right(32, -0.5);
+    left[1] = kNaN;
+    left[6] = kInf;
+    right[9] = -kInf;
+    right[20] = 2.0e300;
+    left[31] = -0.75;
+
+    const auto health = convo::health::scanAndScrubStereo<false>(left.data(), right.data(), 32);
+    check(health.badSamples == 4 && health.isCorrupted(), "corrupted: NaN, +Inf, -Inf and over-bound values are counted");
+    check(left[1] == 0.0 && left[6] == 0.0 && right[9] == 0.0 && right[20] == 0.0, "corrupted: bad samples are zeroed");
+    check(left[0] == 0.25 && right[0] == -0.5 && left[31] == -0.75, "corrupted: healthy samples are kept");
+    check(health.peak == 0.75, "corrupted: bad samples do not enter the peak");
+
+    // ゲインを掛けた後の値で判定する: 上限を超える値もゲインで上限未満に入れば残る
+    std::vector<double> overBound { 1.5e300, -1.5e300, 0.5, 0.5, 0.5 };
+    const auto scaled = convo::health::scanAndScrubStereo<true>(overBound.data(), nullptr, 5, 0.5);
+    check(!scaled.isCorrupted() && overBound[0] == 0.75e300 && scaled.peak == 0.75e300,
+          "gain: judged after the gain is applied");
+}
+
+void testTailsAndMono()
+{
+    std::mt19937 rng(11);
+    for (int n = 0; n <= 9; ++n)
+    {
+        const std::string size = std::to_string(n);
+        compareWithReference(noise(n, rng), noise(n, rng), true, false, 1.0, "tail " + size);
+        compareWithReference(noise(n, rng), noise(n, rng), false, true, 0.5, "mono tail " + size);
+    }
+
+    std::vector<double> empty;
+    const auto health = convo::health::scanAndScrubStereo<false>(empty.data(), nullptr, 0);
+    check(health.peak == 0.0 && !health.isCorrupted(), "empty: nothing reported");
+}
+
+void testBadSamplePositions()
+{
+    std::mt19937 rng(23);
+    constexpr int n = 37; // ベクトル 9 回 + 端数 1
+    bool allCounted = true;
+    for (int pos = 0; pos < n * 2; ++pos)
+    {
+        auto left = noise(n, rng);
+        auto right = noise(n, rng);
+        auto& target = pos < n ? left : right;
+        target[static_cast<size_t>(pos % n)] = std::numeric_limits<double>::quiet_NaN();
+        const auto health = convo::health::scanAndScrubStereo<false>(left.data(), right.data(), n);
+        allCounted = allCounted && health.badSamples == 1 && target[static_cast<size_t>(pos % n)] == 0.0;
+    }
+    check(allCounted, "positions: a single NaN is found in every vector lane, the tail and both channels");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[BlockHealthScanTests] Start\n";
+    testHealthyBlocks();
+    testCorruptedSamples();
+    testTailsAndMono();
+    testBadSamplePositions();
+    std::cout << "[BlockHealthScanTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+//==============================================================================
+// BufferSizeGovernorTests.cpp
+//
+// BufferSizeGovernor (締め切り超過に応じたデバイスのバッファ長の上げ下げ) のテスト。
+//   1. 窓内の超過が kMissesToStepUp 回に達したときだけ、受け付けられる次の長さへ上げること
+//   2. 変更直後 kSettleMs の超過は数えないこと
+//   3. 余裕が holdoff 続き、換算負荷が下限以下なら 1 段下げ、基準長より下へは行かないこと
+//   4. 負荷が高い間は下げないこと、下げた先で再び上げると holdoff が倍になること
+// を検証する。JUCE 非依存。
+//==============================================================================
+#include "audioengine/BufferSizeGovernor.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Governor = convo::BufferSizeGovernor;
+const std::vector<int> kSizes { 64, 128, 256, 512, 1024 };
+constexpr double kTickMs = 500.0;
+
+// nowMs から quietMs のあいだ超過なしで回し、最初に返った長さ (無ければ 0) を返す
+int runQuiet(Governor& g, double& nowMs, int size, double quietMs, uint32_t load)
+{
+    const double end = nowMs + quietMs;
+    for (; nowMs < end; nowMs += kTickMs)
+        if (const int next = g.update(nowMs, size, kSizes, 0, load); next != 0)
+            return next;
+    return 0;
+}
+
+void testStepUp()
+{
+    Governor g;
+    double now = 0.0;
+    g.setBaseSize(128, now);
+    now += Governor::kSettleMs;
+
+    check(g.update(now, 128, kSizes, 2, 900) == 0, "two misses stay below the threshold");
+    now += kTickMs;
+    check(g.update(now, 128, kSizes, 1, 900) == 256, "the third miss in the window steps up to the next size");
+
+    // 窓を過ぎた超過は数え直し
+    Governor spread;
+    now = 0.0;
+    spread.setBaseSize(128, now);
+    now += Governor::kSettleMs;
+    int result = 0;
+    for (int i = 0; i < 6; ++i, now += Governor::kMissWindowMs + kTickMs)
+        result = result != 0 ? result : spread.update(now, 128, kSizes, 1, 900);
+    check(result == 0, "isolated misses far apart do not step up");
+
+    Governor top;
+    top.setBaseSize(1024, 0.0);
+    check(top.update(Governor::kSettleMs, 1024, kSizes, 10, 900) == 0, "no larger size keeps the current one");
+}
+
+void testSettle()
+{
+    Governor g;
+    g.setBaseSize(128, 0.0);
+    check(g.update(100.0, 128, kSizes, 10, 900) == 0, "misses right after a change are ignored");
+    g.notifyApplied(5'000.0);
+    check(g.update(5'000.0 + Governor::kSettleMs - 1.0, 128, kSizes, 10, 900) == 0, "notifyApplied restarts the settle time");
+}
+
+void testStepDown()
+{
+    Governor g;
+    double now = 0.0;
+    g.setBaseSize(128, now);
+    now += Governor::kSettleMs;
+    check(g.update(now, 128, kSizes, 3, 900) == 256, "setup step up");
+    g.notifyApplied(now);
+    now += Governor::kSettleMs;
+
+    // 256 → 128 で予算が半分になるので、負荷 300 は 600 に換算され下げない
+    check(runQuiet(g, now, 256, Governor::kHeadroomMs * 2, 300) == 0, "high load keeps the larger buffer");
+
+    g.notifyApplied(now);
+    now += Governor::kSettleMs;
+    check(runQuiet(g, now, 256, Governor::kHeadroomMs - kTickMs, 150) == 0, "no step down before the holdoff");
+    check(runQuiet(g, now, 256, kTickMs * 2, 150) == 128, "quiet and light load step back down");
+
+    g.notifyApplied(now);
+    now += Governor::kSettleMs;
+    check(runQuiet(g, now, 128, Governor::kHeadroomMs * 3, 50) == 0, "never goes below the base size");
+}
+
+void testBackoff()
+{
+    Governor g;
+    double now = 0.0;
+    g.setBaseSize(128, now);
+    now += Governor::kSettleMs;
+    check(g.update(now, 128, kSizes, 3, 900) == 256, "setup step up");
+    g.notifyApplied(now);
+    now += Governor::kSettleMs;
+    check(runQuiet(g, now, 256, Governor::kHeadroomMs + kTickMs * 2, 100) == 128, "first step down");
+    g.notifyApplied(now);
+    now += Governor::kSettleMs;
+
+    // 下げた先でまた超過 → 上げて holdoff を倍に
+    check(g.update(now, 128, kSizes, 3, 900) == 256, "misses at the lowered size step up again");
+    check(g.getBackoffShift() == 1, "returning to a failed size doubles the holdoff");
+    g.notifyApplied(now);
+    now += Governor::kSettleMs;
+    check(runQuiet(g, now, 256, Governor::kHeadroomMs * 1.5, 100) == 0, "doubled holdoff delays the next step down");
+    check(runQuiet(g, now, 256, Governor::kHeadroomMs, 100) == 128, "step down after the doubled holdoff");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[BufferSizeGovernorTests] Start\n";
+    testStepUp();
+    testSettle();
+    testStepDown();
+    testBackoff();
+    std::cout << "[BufferSizeGovernorTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
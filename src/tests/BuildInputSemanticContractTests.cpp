@@ -92,22 +92,38 @@ namespace {
         }
     }
 
+    // ★ BuildInput の組み立ては makeBuildInput に集約 (requestRebuild / オフライン経路で共有)
+    const auto makeBuildInputBegin = rebuildDispatch.find("convo::BuildInput makeBuildInput(");
+    const auto makeBuildInputEnd = rebuildDispatch.find("\n}\n", makeBuildInputBegin);
+    if (makeBuildInputBegin == std::string::npos || makeBuildInputEnd == std::string::npos) {
+        std::cerr << "[FAIL] Phase3 missing: makeBuildInput definition\n";
+        return false;
+    }
+    const std::string makeBuildInputBody = rebuildDispatch.substr(makeBuildInputBegin, makeBuildInputEnd - makeBuildInputBegin);
+
     for (const auto& requiredAssignment : {
-             std::string("task.buildInput.processingOrder = static_cast<int>(paramSnapshot.processingOrder);"),
-             std::string("task.buildInput.eqBypassed = paramSnapshot.eqBypassed;"),
-             std::string("task.buildInput.convBypassed = paramSnapshot.convBypassed;"),
-             std::string("task.buildInput.softClipEnabled = paramSnapshot.softClipEnabled;"),
-             std::string("task.buildInput.saturationAmount = paramSnapshot.saturationAmount;"),
-             std::string("task.buildInput.inputHeadroomGain = paramSnapshot.inputHeadroomGain;"),
-             std::string("task.buildInput.outputMakeupGain = paramSnapshot.outputMakeupGain;"),
-             std::string("task.buildInput.convolverInputTrimGain = paramSnapshot.convolverInputTrimGain;") })
+             std::string("input.processingOrder = static_cast<int>(snapshot.processingOrder);"),
+             std::string("input.eqBypassed = snapshot.eqBypassed;"),
+             std::string("input.convBypassed = snapshot.convBypassed;"),
+             std::string("input.softClipEnabled = snapshot.softClipEnabled;"),
+             std::string("input.saturationAmount = snapshot.saturationAmount;"),
+             std::string("input.inputHeadroomGain = snapshot.inputHeadroomGain;"),
+             std::string("input.outputMakeupGain = snapshot.outputMakeupGain;"),
+             std::string("input.convolverInputTrimGain = snapshot.convolverInputTrimGain;") })
     {
-        if (!contains(rebuildDispatch, requiredAssignment)) {
+        if (!contains(makeBuildInputBody, requiredAssignment)) {
             std::cerr << "[FAIL] Phase3 missing: " << requiredAssignment << '\n';
             return false;
         }
     }
 
+    const auto requestRebuildBegin = rebuildDispatch.find("void AudioEngine::requestRebuild(double sampleRate, int samplesPerBlock, bool forceMustExecute)");
+    if (requestRebuildBegin == std::string::npos
+        || rebuildDispatch.find("task.buildInput = makeBuildInput(sampleRate, samplesPerBlock, paramSnapshot);", requestRebuildBegin) == std::string::npos) {
+        std::cerr << "[FAIL] Phase3 missing: task.buildInput = makeBuildInput(sampleRate, samplesPerBlock, paramSnapshot);\n";
+        return false;
+    }
+
     for (const auto& requiredSnapshotPlumbing : {
              std::string("enqueuePublicationIntentForRuntimeCommit(dspToCommit, task.generation, task.runtimeBuildSnapshot, task.buildAnalysis, task.oversamplingResult, task.buildDiagnostics);") })
     {
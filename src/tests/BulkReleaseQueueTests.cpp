@@ -0,0 +1,231 @@
+//==============================================================================
+// BulkReleaseQueueTests.cpp
+//
+// convo::BulkReleaseQueue (BulkReleaseQueue.h) のテスト。
+//   1. 閾値未満・受け手なしでは tryDefer が false を返し (呼び出し側がその場で解放)、受け手なしの分だけ fallback に数えること
+//   2. releaseBatch が積んだ順に解放し、予算に達した時点で止まり、予算より大きな 1 件でも必ず解放すること
+//   3. 満杯 (kCapacity) では tryDefer が false を返すこと
+//   4. 最後の受け手の detachDrainer が残りを解放し、以後の tryDefer を断ること。途中の受け手の detach は何もしないこと
+//   5. 複数スレッドからの tryDefer と受け手スレッドの releaseBatch を並行させて、全件がちょうど 1 回解放されること
+// JUCE / MKL 非依存 (ヘッダのみ)。
+//==============================================================================
+
+#include "BulkReleaseQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::BulkReleaseQueue;
+
+constexpr std::uint64_t kMiB = 1ull << 20;
+
+// 解放された id を順に記録する疑似オブジェクト
+struct Tracked {
+    int id = 0;
+    std::vector<int>* log = nullptr;
+};
+
+void releaseTracked(void* p)
+{
+    auto* t = static_cast<Tracked*>(p);
+    t->log->push_back(t->id);
+}
+
+//------------------------------------------------------------------------------
+// 1. その場解放に回る条件
+//------------------------------------------------------------------------------
+void testDeferConditions()
+{
+    BulkReleaseQueue queue { 16 * kMiB };
+    std::vector<int> log;
+    Tracked small { 1, &log };
+    Tracked large { 2, &log };
+
+    check(!queue.tryDefer(&large, releaseTracked, 64 * kMiB), "no drainer: tryDefer refuses");
+    queue.attachDrainer();
+    check(!queue.tryDefer(&small, releaseTracked, 1 * kMiB), "below threshold: tryDefer refuses");
+    check(!queue.tryDefer(nullptr, releaseTracked, 64 * kMiB), "null pointer is refused");
+    check(queue.tryDefer(&large, releaseTracked, 64 * kMiB), "large block with a drainer is deferred");
+    check(log.empty(), "deferred block is not released by tryDefer");
+
+    const auto stats = queue.snapshotStats();
+    check(stats.fallbackCount == 1, "only the drainer-less large block counts as a fallback");
+    check(stats.deferredCount == 1 && stats.pendingCount == 1 && stats.pendingBytes == 64 * kMiB, "pending block is accounted");
+
+    queue.releaseAll();
+    check(log == std::vector<int>({ 2 }), "releaseAll releases the pending block");
+    queue.detachDrainer();
+}
+
+//------------------------------------------------------------------------------
+// 2. releaseBatch の予算と順序
+//------------------------------------------------------------------------------
+void testBatchBudget()
+{
+    BulkReleaseQueue queue { 1 };
+    queue.attachDrainer();
+    std::vector<int> log;
+    std::vector<Tracked> blocks;
+    for (int i = 0; i < 5; ++i)
+        blocks.push_back(Tracked { i, &log });
+    const std::uint64_t sizes[] = { 30 * kMiB, 30 * kMiB, 30 * kMiB, 200 * kMiB, 10 * kMiB };
+    for (int i = 0; i < 5; ++i)
+        (void)queue.tryDefer(&blocks[static_cast<size_t>(i)], releaseTracked, sizes[i]);
+
+    check(queue.releaseBatch(64 * kMiB) == 90 * kMiB, "batch stops once the budget is reached");
+    check(log == std::vector<int>({ 0, 1, 2 }), "batch releases in FIFO order");
+
+    check(queue.releaseBatch(64 * kMiB) == 200 * kMiB, "a block above the budget is still released alone");
+    check(queue.releaseBatch(64 * kMiB) == 10 * kMiB && log.size() == 5, "last batch drains the rest");
+    check(queue.releaseBatch(64 * kMiB) == 0, "empty queue releases nothing");
+
+    const auto stats = queue.snapshotStats();
+    check(stats.batchCount == 3 && stats.releasedCount == 5 && stats.releasedBytes == 300 * kMiB, "batch statistics");
+    check(stats.pendingCount == 0 && stats.pendingBytes == 0, "nothing left pending");
+    queue.detachDrainer();
+}
+
+//------------------------------------------------------------------------------
+// 3. 満杯
+//------------------------------------------------------------------------------
+void testCapacity()
+{
+    BulkReleaseQueue queue { 1 };
+    queue.attachDrainer();
+    std::vector<int> log;
+    std::vector<Tracked> blocks(BulkReleaseQueue::kCapacity + 1);
+    bool allAccepted = true;
+    for (size_t i = 0; i < BulkReleaseQueue::kCapacity; ++i)
+    {
+        blocks[i] = Tracked { static_cast<int>(i), &log };
+        allAccepted = queue.tryDefer(&blocks[i], releaseTracked, kMiB) && allAccepted;
+    }
+    check(allAccepted, "queue accepts up to kCapacity blocks");
+    blocks.back() = Tracked { -1, &log };
+    check(!queue.tryDefer(&blocks.back(), releaseTracked, kMiB), "full queue refuses");
+    check(queue.snapshotStats().fallbackCount == 1, "full queue counts a fallback");
+
+    queue.detachDrainer();
+    check(log.size() == BulkReleaseQueue::kCapacity, "detach of the only drainer releases everything");
+}
+
+//------------------------------------------------------------------------------
+// 4. 受け手の付け外し
+//------------------------------------------------------------------------------
+void testDetach()
+{
+    BulkReleaseQueue queue { 1 };
+    std::vector<int> log;
+    Tracked a { 1, &log };
+    Tracked b { 2, &log };
+
+    queue.attachDrainer();
+    queue.attachDrainer();
+    (void)queue.tryDefer(&a, releaseTracked, kMiB);
+
+    queue.detachDrainer();
+    check(log.empty(), "detach of one of two drainers keeps the queue");
+    check(queue.snapshotStats().drainers == 1, "one drainer remains");
+
+    queue.detachDrainer();
+    check(log == std::vector<int>({ 1 }), "last detach releases the rest");
+    check(!queue.tryDefer(&b, releaseTracked, kMiB), "tryDefer after the last detach refuses");
+}
+
+//------------------------------------------------------------------------------
+// 5. 並行
+//------------------------------------------------------------------------------
+std::atomic<int> g_releasedMask[4 * 500];
+
+void releaseCounted(void* p)
+{
+    g_releasedMask[*static_cast<int*>(p)].fetch_add(1);
+}
+
+void testConcurrent()
+{
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 500;
+    BulkReleaseQueue queue { 1 };
+    queue.attachDrainer();
+
+    std::vector<int> ids(kProducers * kPerProducer);
+    for (int i = 0; i < kProducers * kPerProducer; ++i)
+        ids[static_cast<size_t>(i)] = i;
+
+    std::atomic<bool> done { false };
+    std::thread drainer([&] {
+        while (!done.load())
+        {
+            if (queue.releaseBatch(8 * kMiB) == 0)
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    std::atomic<int> inlineCount { 0 };
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i)
+            {
+                int* id = &ids[static_cast<size_t>(p * kPerProducer + i)];
+                if (!queue.tryDefer(id, releaseCounted, kMiB))
+                {
+                    releaseCounted(id);   // 満杯ならその場で解放
+                    inlineCount.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& t : producers)
+        t.join();
+    done.store(true);
+    drainer.join();
+    queue.detachDrainer();
+
+    bool exactlyOnce = true;
+    for (int i = 0; i < kProducers * kPerProducer; ++i)
+        exactlyOnce = exactlyOnce && g_releasedMask[i].load() == 1;
+    check(exactlyOnce, "every block is released exactly once");
+    const auto stats = queue.snapshotStats();
+    check(stats.releasedCount + static_cast<std::uint64_t>(inlineCount.load()) == kProducers * kPerProducer,
+          "deferred and inline releases add up");
+    check(stats.pendingCount == 0, "queue is empty after the last detach");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[BulkReleaseQueueTests] Start\n";
+    testDeferConditions();
+    testBatchBudget();
+    testCapacity();
+    testDetach();
+    testConcurrent();
+    std::cout << "[BulkReleaseQueueTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+//==============================================================================
+// CallbackTimingProfileTests.cpp
+//
+// convo::CallbackTimingHistograms / CallbackTimingStats / recommendBufferSize
+// (audioengine/CallbackTimingProfile.h) のテスト。
+//   1. 到着ジッター・負荷・超過・遅着が数えられ、最初のコールバックと resetArrival 後はジッターに入らないこと
+//   2. collect の差分を積むと分布とパーセンタイルが元の記録と一致すること
+//   3. 観測時間が足りなければ判定しない・インシデントや余裕不足は不安定と判定すること
+//   4. 推奨値が安定した最小のバッファ長を返し、提案は 1 段下だけで不安定だった長さ以下へ下げないこと
+// を検証する。JUCE / MKL 非依存。
+//==============================================================================
+#include "audioengine/CallbackTimingProfile.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::CallbackTimingHistograms;
+using convo::CallbackTimingStats;
+
+constexpr double kSampleRate = 48000.0;
+
+// 一定周期・一定負荷のコールバックを count 回流し、その差分を stats に積む
+void feed(CallbackTimingStats& stats, int bufferSize, uint64_t count, uint32_t loadPermille,
+          uint64_t jitterUs = 0, uint64_t overrunEvery = 0)
+{
+    CallbackTimingHistograms h;
+    CallbackTimingHistograms::Snapshot before;
+    h.collect(before);
+
+    const uint64_t periodUs = static_cast<uint64_t>(bufferSize * 1.0e6 / kSampleRate);
+    uint64_t startUs = 1'000'000;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        const uint64_t callbackUs = (overrunEvery != 0 && i % overrunEvery == overrunEvery - 1)
+                                        ? periodUs + 100
+                                        : periodUs * loadPermille / 1000;
+        h.record(startUs, startUs + callbackUs, periodUs);
+        startUs += periodUs + ((i % 2 == 0) ? jitterUs : 0);
+    }
+
+    CallbackTimingHistograms::Snapshot now;
+    h.collect(now);
+    stats.accumulate(now, before);
+}
+
+void testRecording()
+{
+    CallbackTimingHistograms h;
+    h.record(1'000, 1'500, 0);                  // 未 prepare: 数えない
+    h.record(11'000, 12'000, 10'000);           // 負荷 100 permille。前回の開始から 10 ms = ジッター 0
+    h.record(22'000, 33'000, 10'000);           // ジッター 1 ms・超過
+    h.record(50'000, 51'000, 10'000);           // 到着間隔 28 ms > 15 ms: 遅着
+    h.resetArrival();
+    h.record(200'000, 200'100, 10'000);         // 到着間隔を数えない
+
+    CallbackTimingHistograms::Snapshot s;
+    h.collect(s);
+    check(s.callbacks == 4, "callbacks counted after prepare");
+    check(s.overruns == 1, "one overrun");
+    check(s.lateArrivals == 1, "one late arrival");
+
+    uint64_t jitterSamples = 0;
+    for (uint64_t c : s.jitter)
+        jitterSamples += c;
+    check(jitterSamples == 3, "first interval after reset is not a jitter sample");
+    check(s.jitter[static_cast<size_t>(convo::StageLatencyHistograms::bucketFor(0))] == 1, "zero jitter bucket");
+    check(s.load[static_cast<size_t>(CallbackTimingHistograms::loadBucketFor(100))] == 2, "load buckets");
+    check(s.load[static_cast<size_t>(CallbackTimingHistograms::loadBucketFor(1100))] == 1, "overrun load bucket");
+    check(CallbackTimingHistograms::loadBucketFor(100'000) == CallbackTimingHistograms::kLoadBuckets - 1,
+          "load above 2000 permille is clamped");
+}
+
+void testAccumulate()
+{
+    CallbackTimingStats stats;
+    feed(stats, 256, 1000, 300, 40);
+    feed(stats, 256, 1000, 300, 40);
+    check(stats.totals.callbacks == 2000, "accumulated callbacks");
+    check(stats.loadPercentilePermille(5000) == 300, "load median rounds up to the bucket");
+    check(stats.jitterPercentileUs(9990) >= 40 && stats.jitterPercentileUs(9990) < 56, "jitter p99.9 bucket bound");
+    check(stats.slackPercentileUs(10, 256, kSampleRate) > 0.6 * 256 * 1.0e6 / kSampleRate,
+          "slack from the load distribution");
+
+    CallbackTimingStats empty;
+    check(empty.jitterPercentileUs(9900) == 0 && empty.loadPercentilePermille(9900) == 0, "empty percentiles");
+}
+
+void testVerdict()
+{
+    // 256 samples @ 48 kHz = 5.33 ms。60 秒 = 11250 コールバック
+    CallbackTimingStats shortRun;
+    feed(shortRun, 256, 5000, 300);
+    check(shortRun.verdict(256, kSampleRate) == CallbackTimingStats::Verdict::Insufficient, "too short to judge");
+
+    CallbackTimingStats stable;
+    feed(stable, 256, 12000, 300, 50);
+    check(stable.verdict(256, kSampleRate) == CallbackTimingStats::Verdict::Stable, "stable");
+
+    CallbackTimingStats overruns;
+    feed(overruns, 256, 12000, 300, 0, 1000);
+    check(overruns.verdict(256, kSampleRate) == CallbackTimingStats::Verdict::Unstable, "incidents make it unstable");
+
+    CallbackTimingStats heavy;
+    feed(heavy, 256, 12000, 900);
+    check(heavy.verdict(256, kSampleRate) == CallbackTimingStats::Verdict::Unstable, "no slack is unstable");
+}
+
+void testRecommendation()
+{
+    const std::vector<int> sizes { 32, 64, 128, 256, 512, 1024 };
+
+    CallbackTimingStats at512;
+    feed(at512, 512, 6000, 200, 30);
+    CallbackTimingStats at256;
+    feed(at256, 256, 12000, 300, 30);
+
+    auto r = convo::recommendBufferSize({ { 512, &at512 }, { 256, &at256 } }, kSampleRate, sizes);
+    check(r.verifiedSamples == 256, "lowest stable size is verified");
+    check(r.suggestedSamples == 128, "predicts one step below");
+
+    CallbackTimingStats at128Unstable;
+    feed(at128Unstable, 128, 24000, 300, 0, 500);
+    r = convo::recommendBufferSize({ { 512, &at512 }, { 256, &at256 }, { 128, &at128Unstable } }, kSampleRate, sizes);
+    check(r.verifiedSamples == 256, "unstable size is not verified");
+    check(r.suggestedSamples == 0, "never suggests at or below an unstable size");
+
+    CallbackTimingStats at128Short;
+    feed(at128Short, 128, 100, 300);
+    r = convo::recommendBufferSize({ { 256, &at256 }, { 128, &at128Short } }, kSampleRate, sizes);
+    check(r.suggestedSamples == 128, "size with too little data is still suggested");
+
+    r = convo::recommendBufferSize({ { 128, &at128Short } }, kSampleRate, sizes);
+    check(r.verifiedSamples == 0 && r.suggestedSamples == 0, "nothing verified, nothing suggested");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[CallbackTimingProfileTests] Start\n";
+    testRecording();
+    testAccumulate();
+    testVerdict();
+    testRecommendation();
+    std::cout << "[CallbackTimingProfileTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+//==============================================================================
+// ChainSilenceTrackerTests.cpp
+//
+// convo::ChainSilenceTracker (audioengine/ChainSilenceTracker.h) の単体テスト。
+//   1. 無音が ring-out 以上続いた後の無音ブロックだけがスキップされ、最初の 1 回が EnterSkip になること
+//      (音が来たら即座に Process へ戻り、カウントがやり直しになること / 段ごとに独立していること)
+//   2. isSilentBlock が閾値 (1e-20) ちょうど・端数サンプル・NaN を正しく判定すること
+//   3. ringOutSamplesForPoleRadius の値で、OutputFilter と同じ低域 HPF 縦続・DC ブロッカ相当の
+//      1 次 IIR の状態が実際に閾値未満まで減衰していること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#include "audioengine/ChainSilenceTracker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::ChainSilenceTracker;
+using Stage = ChainSilenceTracker::Stage;
+using Action = ChainSilenceTracker::GateAction;
+
+constexpr double kPi = 3.14159265358979323846;
+
+void testGateSemantics()
+{
+    ChainSilenceTracker tracker;
+    tracker.configure(Stage::OutputFilter, 1000);
+
+    // ring-out 1000 / ブロック 256: 前に 1024 サンプルの無音が溜まった 5 ブロック目からスキップ
+    bool processedUntilRingOut = true;
+    for (int block = 0; block < 4; ++block)
+        processedUntilRingOut = processedUntilRingOut && tracker.advance(Stage::OutputFilter, true, 256) == Action::Process;
+    check(processedUntilRingOut, "silent blocks are processed until the ring-out has elapsed");
+    check(tracker.advance(Stage::OutputFilter, true, 256) == Action::EnterSkip, "first skipped block asks for a state clear");
+    check(tracker.advance(Stage::OutputFilter, true, 256) == Action::Skip, "later silent blocks keep skipping");
+    check(tracker.isSkipping(Stage::OutputFilter), "stage reports skipping");
+    check(tracker.getSkippedBlocks(Stage::OutputFilter) == 2, "skipped blocks are counted");
+
+    check(tracker.advance(Stage::OutputFilter, false, 256) == Action::Process, "signal resumes processing immediately");
+    check(!tracker.isSkipping(Stage::OutputFilter), "signal leaves the skipping state");
+    check(tracker.advance(Stage::OutputFilter, true, 999) == Action::Process, "silence count restarts after signal");
+    check(tracker.advance(Stage::OutputFilter, true, 1) == Action::Process, "ring-out not yet reached (999 < 1000)");
+    check(tracker.advance(Stage::OutputFilter, true, 1) == Action::EnterSkip, "ring-out reached exactly");
+
+    // 他の段は独立。未設定 (kSilenceRingOutNever) の段はスキップしない
+    bool neverSkips = true;
+    for (int block = 0; block < 100; ++block)
+        neverSkips = neverSkips && tracker.advance(Stage::OversampleUp, true, 1 << 20) == Action::Process;
+    check(neverSkips, "unconfigured stages never skip");
+
+    // ring-out 0 (無状態の段) は最初の無音ブロックからスキップ
+    tracker.configure(Stage::SoftClip, 0);
+    check(tracker.advance(Stage::SoftClip, true, 64) == Action::EnterSkip, "stateless stage skips the first silent block");
+
+    // 長さ 0 のブロックはカウントも状態も動かさない
+    tracker.configure(Stage::OversampleDown, 10);
+    check(tracker.advance(Stage::OversampleDown, true, 0) == Action::Process
+          && tracker.advance(Stage::OversampleDown, true, 10) == Action::Process,
+          "empty blocks do not count as silence");
+
+    tracker.reset();
+    check(!tracker.isSkipping(Stage::SoftClip) && tracker.advance(Stage::OutputFilter, true, 256) == Action::Process,
+          "reset clears silence runs");
+    check(tracker.getRingOutSamples(Stage::OutputFilter) == 1000, "reset keeps the configured ring-out");
+}
+
+void testIsSilentBlock()
+{
+    for (const int n : { 1, 3, 4, 7, 64, 1023 })
+    {
+        std::vector<double> l(static_cast<size_t>(n), 0.0), r(static_cast<size_t>(n), 0.0);
+        l[0] = convo::kSilenceFloor;
+        r[static_cast<size_t>(n - 1)] = -convo::kSilenceFloor;
+        const std::string size = " n=" + std::to_string(n);
+        check(convo::isSilentBlock(l.data(), r.data(), n), "values at the floor are silent" + size);
+
+        r[static_cast<size_t>(n - 1)] = -2.0e-20;
+        check(!convo::isSilentBlock(l.data(), r.data(), n), "a value above the floor in the tail is detected" + size);
+        check(convo::isSilentBlock(l.data(), nullptr, n), "mono checks only the left channel" + size);
+
+        r[static_cast<size_t>(n - 1)] = 0.0;
+        l[static_cast<size_t>(n / 2)] = std::numeric_limits<double>::quiet_NaN();
+        check(!convo::isSilentBlock(l.data(), r.data(), n), "NaN is never silent" + size);
+    }
+    check(convo::isSilentBlock(nullptr, nullptr, 16), "no channels is silent");
+}
+
+struct Biquad { double b0, b1, b2, a1, a2; };
+
+// OutputFilter::makeHPF と同じ RBJ 式
+Biquad makeHpf(double fc, double q, double fs)
+{
+    const double w0 = 2.0 * kPi * fc / fs;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0inv = 1.0 / (1.0 + alpha);
+    const double cs = std::cos(w0);
+    return { (1.0 + cs) * 0.5 * a0inv, -(1.0 + cs) * a0inv, (1.0 + cs) * 0.5 * a0inv, -2.0 * cs * a0inv, (1.0 - alpha) * a0inv };
+}
+
+void testRingOutBoundsDecay()
+{
+    check(convo::ringOutSamplesForPoleRadius(1.0) == convo::kSilenceRingOutNever, "unit-circle pole never rings out");
+    check(convo::ringOutSamplesForPoleRadius(0.0, 6) == 6, "pure FIR rings out after its length");
+    check(std::abs(convo::biquadPoleRadius(0.0, 0.25) - 0.5) < 1.0e-15, "complex pole radius is sqrt(a2)");
+    check(std::abs(convo::biquadPoleRadius(-1.5, 0.56) - 0.8) < 1.0e-12, "real pole radius is the larger root");
+
+    // OutputFilter の 15Hz Q0.5 / 18Hz Q0.707 / 20Hz Q0.707 HPF を縦続し、フルスケール雑音の直後から
+    // ring-out 分の無音を流す。状態と出力が閾値未満になっていること
+    for (const double fs : { 44100.0, 384000.0 })
+    {
+        const Biquad stages[] { makeHpf(15.0, 0.5, fs), makeHpf(18.0, 0.70711, fs), makeHpf(20.0, 0.70711, fs) };
+        double maxPole = 0.0;
+        for (const Biquad& b : stages)
+            maxPole = std::max(maxPole, convo::biquadPoleRadius(b.a1, b.a2));
+        const int ringOut = convo::ringOutSamplesForPoleRadius(maxPole, 6);
+
+        double w1[3] {}, w2[3] {};
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        double lastOut = 0.0;
+        const auto step = [&](double x)
+        {
+            for (int s = 0; s < 3; ++s)
+            {
+                const Biquad& c = stages[s];
+                const double y = c.b0 * x + w1[s];
+                w1[s] = c.b1 * x - c.a1 * y + w2[s];
+                w2[s] = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+            lastOut = x;
+        };
+        for (int i = 0; i < 65536; ++i)
+            step(dist(rng));
+        for (int i = 0; i < ringOut; ++i)
+            step(0.0);
+
+        double maxState = std::abs(lastOut);
+        for (int s = 0; s < 3; ++s)
+            maxState = std::max({ maxState, std::abs(w1[s]), std::abs(w2[s]) });
+        check(maxState <= convo::kSilenceFloor,
+              "low-cut cascade decays below the floor within its ring-out @" + std::to_string(static_cast<int>(fs)));
+    }
+
+    // UltraHighRateDCBlocker 相当 (1 次 LPF 状態 2 段、α = 1 − exp(−2π·1Hz / fs))
+    {
+        const double fs = 768000.0;
+        const double alpha = -std::expm1(-2.0 * kPi * 1.0 / fs);
+        const int ringOut = convo::ringOutSamplesForPoleRadius(1.0 - alpha);
+        double state0 = 1.0, state1 = 1.0;
+        for (int i = 0; i < ringOut; ++i)
+        {
+            double x = 0.0;
+            state0 += alpha * (x - state0);
+            x -= state0;
+            state1 += alpha * (x - state1);
+        }
+        check(std::abs(state0) <= convo::kSilenceFloor && std::abs(state1) <= convo::kSilenceFloor,
+              "two-section DC blocker decays below the floor within its ring-out");
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[ChainSilenceTrackerTests] Start\n";
+    testGateSemantics();
+    testIsSilentBlock();
+    testRingOutBoundsDecay();
+    std::cout << "[ChainSilenceTrackerTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+//==============================================================================
+// ChannelForkJoinTests.cpp
+//
+// convo::ChannelForkJoin (audioengine/ChannelForkJoin.h) の単体テスト。
+//   1. fork したジョブが join 後に必ず完了しており、L/R を並行に回した出力が
+//      直列に回した出力とビット一致すること (状態を持つ段をチャンネル別に)
+//   2. helper が眠った後 (spinWindow 経過後) の fork も取りこぼさないこと
+//   3. 停止中・起動直後の fork は join が呼び出し側で実行すること
+//   4. helper 先頭 / 終了時のフックが 1 回ずつ呼ばれ、helper スレッドで実行されること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#include "audioengine/ChannelForkJoin.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::ChannelForkJoin;
+
+// 状態を持つ段: 1 次 IIR (y = x + 0.5·y[-1])。どのスレッドで回ったかも記録する
+struct OnePoleChannel
+{
+    double state = 0.0;
+    const double* input = nullptr;
+    double* output = nullptr;
+    int numSamples = 0;
+    std::thread::id ranOn;
+
+    void run() noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = state = input[i] + 0.5 * state;
+        ranOn = std::this_thread::get_id();
+    }
+
+    static void job(void* context) noexcept { static_cast<OnePoleChannel*>(context)->run(); }
+};
+
+struct HookCounter
+{
+    std::atomic<int> starts { 0 };
+    std::atomic<int> exits { 0 };
+    std::thread::id helperId;
+
+    static ChannelForkJoin::ThreadHooks hooksFor(HookCounter& counter)
+    {
+        ChannelForkJoin::ThreadHooks hooks;
+        hooks.onThreadStart = [](void* context) noexcept
+        {
+            auto* self = static_cast<HookCounter*>(context);
+            self->helperId = std::this_thread::get_id();
+            ++self->starts;
+        };
+        hooks.onThreadExit = [](void* context) noexcept { ++static_cast<HookCounter*>(context)->exits; };
+        hooks.context = &counter;
+        return hooks;
+    }
+};
+
+void testForkJoinMatchesSerial()
+{
+    constexpr int kBlock = 256;
+    constexpr int kBlocks = 400;
+    HookCounter hooks;
+    ChannelForkJoin split;
+    check(split.start(HookCounter::hooksFor(hooks), 0.05), "helper starts");
+    check(split.isRunning(), "a started helper reports running");
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> inL(kBlock * kBlocks), inR(kBlock * kBlocks);
+    for (size_t i = 0; i < inL.size(); ++i)
+    {
+        inL[i] = dist(rng);
+        inR[i] = dist(rng);
+    }
+
+    std::vector<double> outL(inL.size()), outR(inR.size());
+    OnePoleChannel left, right;
+    for (int b = 0; b < kBlocks; ++b)
+    {
+        const size_t offset = static_cast<size_t>(b) * kBlock;
+        left.input = inL.data() + offset;
+        left.output = outL.data() + offset;
+        right.input = inR.data() + offset;
+        right.output = outR.data() + offset;
+        left.numSamples = right.numSamples = kBlock;
+
+        split.fork(&OnePoleChannel::job, &right);
+        left.run();
+        split.join();
+    }
+
+    std::vector<double> refL(inL.size()), refR(inR.size());
+    OnePoleChannel serialL { 0.0, inL.data(), refL.data(), kBlock * kBlocks, {} };
+    OnePoleChannel serialR { 0.0, inR.data(), refR.data(), kBlock * kBlocks, {} };
+    serialL.run();
+    serialR.run();
+    check(outL == refL && outR == refR, "fork / join output equals serial processing");
+    check(split.getHelperJobs() + split.getInlineJobs() == static_cast<std::uint64_t>(kBlocks),
+          "every forked job runs exactly once");
+
+    split.stop();
+    check(!split.isRunning(), "stop leaves the helper idle");
+    check(hooks.starts.load() == 1 && hooks.exits.load() == 1, "thread hooks run once per helper");
+}
+
+void testForkAfterHelperSleeps()
+{
+    constexpr int kBlock = 64;
+    HookCounter hooks;
+    ChannelForkJoin split;
+    split.start(HookCounter::hooksFor(hooks), 0.0); // 毎回すぐ眠る
+
+    std::vector<double> in(kBlock, 1.0), out(kBlock, 0.0);
+    bool allDone = true;
+    for (int b = 0; b < 20; ++b)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        std::fill(out.begin(), out.end(), 0.0);
+        OnePoleChannel right { 0.0, in.data(), out.data(), kBlock, {} };
+        split.fork(&OnePoleChannel::job, &right);
+        split.join();
+        allDone = allDone && out[kBlock - 1] != 0.0;
+    }
+    check(allDone, "jobs forked while the helper sleeps still complete before join returns");
+
+    // helper に取らせる: join 前に helper がジョブを終えるまで待つ
+    struct FlagJob
+    {
+        std::atomic<bool> ran { false };
+        std::thread::id ranOn;
+        static void job(void* context) noexcept
+        {
+            auto* self = static_cast<FlagJob*>(context);
+            self->ranOn = std::this_thread::get_id();
+            self->ran.store(true, std::memory_order_release);
+        }
+    };
+    const std::uint64_t helperJobsBefore = split.getHelperJobs();
+    FlagJob flagJob;
+    split.fork(&FlagJob::job, &flagJob);
+    for (int i = 0; i < 2000 && !flagJob.ran.load(std::memory_order_acquire); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    split.join();
+    check(split.getHelperJobs() == helperJobsBefore + 1 && flagJob.ranOn == hooks.helperId,
+          "a sleeping helper is woken and runs the job on its own thread");
+    split.stop();
+}
+
+void testStoppedForkRunsInline()
+{
+    constexpr int kBlock = 32;
+    std::vector<double> in(kBlock, 1.0), out(kBlock, 0.0);
+    ChannelForkJoin split;
+    check(!split.isRunning(), "a new helper is stopped");
+
+    OnePoleChannel right { 0.0, in.data(), out.data(), kBlock, {} };
+    split.fork(&OnePoleChannel::job, &right);
+    split.join();
+    check(right.ranOn == std::this_thread::get_id() && out[0] == 1.0, "a stopped helper runs the job inline at join");
+    check(split.getInlineJobs() == 1 && split.getHelperJobs() == 0, "the inline run is counted");
+
+    check(!split.start({}, -1.0), "a negative spin window is rejected");
+
+    // 起動直後: helper が取る前なら join が取り戻す。どちらで回っても 1 回だけ
+    split.start({}, 0.01);
+    int runs = 0;
+    for (int b = 0; b < 200; ++b)
+    {
+        OnePoleChannel job { 0.0, in.data(), out.data(), kBlock, {} };
+        split.fork(&OnePoleChannel::job, &job);
+        split.join();
+        runs += (job.ranOn != std::thread::id()) ? 1 : 0;
+        if (b % 50 == 0)
+        {
+            split.stop();
+            split.start({}, 0.01);
+        }
+    }
+    check(runs == 200, "restarting the helper never loses a job");
+    split.stop();
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[ChannelForkJoinTests] Start\n";
+    testForkJoinMatchesSerial();
+    testForkAfterHelperSleeps();
+    testStoppedForkRunsInline();
+    std::cout << "[ChannelForkJoinTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
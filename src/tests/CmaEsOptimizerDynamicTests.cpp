@@ -0,0 +1,409 @@
+//==============================================================================
+// CmaEsOptimizerDynamicTests.cpp
+//
+// CmaEsOptimizerDynamic の連続配列 + BLAS 経路のテスト。
+//   1. 連続配列版 sample と vector<vector> 版が同じシードで同じ集団を返すこと
+//   2. update (dgemv + dsyrk) が旧スカラー実装 (下の referenceUpdate) と一致すること
+//   3. 適合度が非有限ばかりの世代では共分散を単位行列へ戻すこと
+//   4. 球面関数で実際に改善が進むこと
+//   5. mirrored サンプリングで行 2k / 2k+1 が平均について対称になること
+//   6. inverseNormalCdf の精度と、準乱数 (R_d) 正規ベクトルの平均・分散
+//   7. mirrored の update が組の勝ち側だけを使う参照更新と一致し、
+//      評価を打ち切った世代 (update の lambda < sample の lambda) は先頭行だけを使うこと
+//   8. mirrored + 準乱数でも球面関数で改善が進むこと
+// JUCE 非依存 (AlignedAllocation と cblas のため MKL をリンク)。
+//==============================================================================
+#include "CmaEsOptimizerDynamic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+struct State
+{
+    std::vector<double> mean;
+    std::vector<double> covariance;  // dim * dim
+    double sigma = 0.0;
+};
+
+State captureState(const CmaEsOptimizerDynamic& optimizer)
+{
+    const int dim = optimizer.getDimension();
+    State state;
+    state.mean.resize(static_cast<size_t>(dim));
+    std::vector<double> upper(static_cast<size_t>(dim * (dim + 1) / 2));
+    optimizer.serializeTo(state.mean.data(), upper.data(), state.sigma);
+    state.covariance.resize(static_cast<size_t>(dim * dim));
+    int idx = 0;
+    for (int r = 0; r < dim; ++r)
+        for (int c = r; c < dim; ++c, ++idx)
+        {
+            state.covariance[static_cast<size_t>(r * dim + c)] = upper[static_cast<size_t>(idx)];
+            state.covariance[static_cast<size_t>(c * dim + r)] = upper[static_cast<size_t>(idx)];
+        }
+    return state;
+}
+
+// 連続配列化する前の CmaEsOptimizerDynamic::update と同じ式 (covRetentionStep = 0 前提)
+State referenceUpdate(const State& before, int dim, const std::vector<double>& population,
+                      const std::vector<double>& fitness, double retention,
+                      const CmaEsOptimizerDynamic::Params& params)
+{
+    const int lambda = static_cast<int>(fitness.size());
+    const int mu = lambda / 2;
+    std::vector<int> indices(static_cast<size_t>(lambda));
+    for (int i = 0; i < lambda; ++i) indices[static_cast<size_t>(i)] = i;
+    std::sort(indices.begin(), indices.end(), [&](int a, int b) { return fitness[a] < fitness[b]; });
+
+    std::vector<double> weights(static_cast<size_t>(mu));
+    double sumWeights = 0.0;
+    for (int i = 0; i < mu; ++i)
+    {
+        weights[i] = std::log(double(mu) + 0.5) - std::log(double(i) + 1.0);
+        sumWeights += weights[i];
+    }
+    for (auto& w : weights) w /= sumWeights;
+
+    auto x = [&](int candidate, int d) { return population[static_cast<size_t>(candidate * dim + d)]; };
+
+    State after = before;
+    std::fill(after.mean.begin(), after.mean.end(), 0.0);
+    for (int i = 0; i < mu; ++i)
+        for (int d = 0; d < dim; ++d)
+            after.mean[d] += weights[i] * x(indices[i], d);
+
+    for (int row = 0; row < dim; ++row)
+        for (int col = 0; col < dim; ++col)
+        {
+            double eliteCov = 0.0;
+            for (int i = 0; i < mu; ++i)
+                eliteCov += weights[i] * (x(indices[i], row) - before.mean[row]) / before.sigma
+                                       * (x(indices[i], col) - before.mean[col]) / before.sigma;
+            after.covariance[row * dim + col] = retention * before.covariance[row * dim + col]
+                                              + (1.0 - retention) * eliteCov;
+        }
+    for (int i = 0; i < dim; ++i)
+        after.covariance[i * dim + i] += 1e-9;
+
+    double stepNorm = 0.0;
+    for (int d = 0; d < dim; ++d)
+        stepNorm += (after.mean[d] - before.mean[d]) * (after.mean[d] - before.mean[d]);
+    stepNorm = std::sqrt(stepNorm / dim);
+    const double ratio = stepNorm / (before.sigma * std::sqrt(double(dim)) + 1e-12);
+    const double cs = std::min(1.0, (2.0 + std::log(double(dim) + 1.0)) / (std::sqrt(double(dim)) + 10.0));
+    after.sigma = std::clamp(before.sigma * std::exp((cs / (1.0 - cs + 1e-12)) * (ratio - 1.0)),
+                             params.sigmaMin, params.sigmaMax);
+    return after;
+}
+
+double maxAbsDiff(const std::vector<double>& a, const std::vector<double>& b)
+{
+    double diff = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+        diff = std::max(diff, std::abs(a[i] - b[i]));
+    return diff;
+}
+
+double sphere(const double* x, int dim, double offset)
+{
+    double sum = 0.0;
+    for (int d = 0; d < dim; ++d)
+        sum += (x[d] - offset) * (x[d] - offset);
+    return sum;
+}
+
+void testSampleLayouts()
+{
+    constexpr int kDim = 12;
+    constexpr int kLambda = 24;
+    std::vector<double> initialMean(kDim, 0.25);
+
+    CmaEsOptimizerDynamic flat(kDim);
+    CmaEsOptimizerDynamic nested(kDim);
+    flat.setSeed(1234);
+    nested.setSeed(1234);
+    flat.initFromParcor(initialMean.data());
+    nested.initFromParcor(initialMean.data());
+
+    std::vector<double> population(static_cast<size_t>(kLambda * kDim));
+    std::vector<std::vector<double>> candidates(kLambda, std::vector<double>(kDim));
+    flat.sample(population.data(), kLambda);
+    nested.sample(candidates);
+
+    double diff = 0.0;
+    for (int k = 0; k < kLambda; ++k)
+        for (int d = 0; d < kDim; ++d)
+            diff = std::max(diff, std::abs(population[static_cast<size_t>(k * kDim + d)] - candidates[k][d]));
+    check(diff == 0.0, "flat and nested sample() produce the same population");
+
+    double spread = 0.0;
+    for (double v : population)
+        spread = std::max(spread, std::abs(v - 0.25));
+    check(spread > 0.0 && spread < 1.0, "samples are spread around the mean with sigma 0.12");
+}
+
+void testUpdateMatchesReference()
+{
+    constexpr int kDim = 16;
+    constexpr int kLambda = 32;
+    CmaEsOptimizerDynamic::Params params;
+    std::vector<double> initialMean(kDim, 0.0);
+
+    CmaEsOptimizerDynamic optimizer(kDim);
+    optimizer.setParams(params);
+    optimizer.setSeed(42);
+    optimizer.initFromParcor(initialMean.data());
+    optimizer.reserve(kLambda);
+
+    std::vector<double> population(static_cast<size_t>(kLambda * kDim));
+    std::vector<double> fitness(kLambda);
+    double worstMean = 0.0, worstCov = 0.0, worstSigma = 0.0;
+    for (int gen = 0; gen < 10; ++gen)
+    {
+        optimizer.sample(population.data(), kLambda);
+        for (int k = 0; k < kLambda; ++k)
+            fitness[k] = sphere(population.data() + k * kDim, kDim, 0.5);
+
+        const State before = captureState(optimizer);
+        const State expected = referenceUpdate(before, kDim, population, fitness, params.covRetentionTarget, params);
+        optimizer.update(population.data(), kLambda, fitness.data());
+        const State actual = captureState(optimizer);
+
+        worstMean = std::max(worstMean, maxAbsDiff(actual.mean, expected.mean));
+        worstCov = std::max(worstCov, maxAbsDiff(actual.covariance, expected.covariance));
+        worstSigma = std::max(worstSigma, std::abs(actual.sigma - expected.sigma));
+    }
+    check(worstMean < 1e-12, "weighted mean (dgemv) matches the scalar reference");
+    check(worstCov < 1e-12, "rank-mu covariance (dsyrk) matches the scalar reference");
+    check(worstSigma < 1e-12, "step-size adaptation matches the scalar reference");
+}
+
+void testNonFiniteReset()
+{
+    constexpr int kDim = 6;
+    constexpr int kLambda = 12;
+    std::vector<double> initialMean(kDim, 0.0);
+    CmaEsOptimizerDynamic optimizer(kDim);
+    optimizer.setSeed(7);
+    optimizer.initFromParcor(initialMean.data());
+
+    std::vector<double> population(static_cast<size_t>(kLambda * kDim));
+    std::vector<double> fitness(kLambda);
+    optimizer.sample(population.data(), kLambda);
+    for (int k = 0; k < kLambda; ++k)
+        fitness[k] = sphere(population.data() + k * kDim, kDim, 2.0);
+    optimizer.update(population.data(), kLambda, fitness.data());
+
+    optimizer.sample(population.data(), kLambda);
+    std::fill(fitness.begin(), fitness.end(), std::numeric_limits<double>::quiet_NaN());
+    optimizer.update(population.data(), kLambda, fitness.data());
+
+    const State state = captureState(optimizer);
+    bool identity = true;
+    for (int r = 0; r < kDim; ++r)
+        for (int c = 0; c < kDim; ++c)
+            identity = identity && state.covariance[r * kDim + c] == (r == c ? 1.0 : 0.0);
+    check(identity, "all-NaN generation resets covariance to identity");
+    check(state.sigma == 0.12, "all-NaN generation resets sigma");
+}
+
+void testConverges()
+{
+    constexpr int kDim = 20;
+    constexpr int kLambda = 40;
+    CmaEsOptimizerDynamic::Params params;
+    params.sigmaMin = 1e-4;
+    std::vector<double> initialMean(kDim, 0.0);
+    CmaEsOptimizerDynamic optimizer(kDim);
+    optimizer.setParams(params);
+    optimizer.setSeed(99);
+    optimizer.initFromParcor(initialMean.data());
+
+    std::vector<double> population(static_cast<size_t>(kLambda * kDim));
+    std::vector<double> fitness(kLambda);
+    double best = std::numeric_limits<double>::max();
+    for (int gen = 0; gen < 400; ++gen)
+    {
+        optimizer.sample(population.data(), kLambda);
+        for (int k = 0; k < kLambda; ++k)
+        {
+            fitness[k] = sphere(population.data() + k * kDim, kDim, 0.3);
+            best = std::min(best, fitness[k]);
+        }
+        optimizer.update(population.data(), kLambda, fitness.data());
+    }
+    check(best < 0.1 * sphere(initialMean.data(), kDim, 0.3), "20-dim sphere improves by 10x");
+}
+
+void testMirroredPairs()
+{
+    constexpr int kDim = 10;
+    constexpr int kLambda = 21;   // 奇数: 最後の行は組を持たない
+    CmaEsOptimizerDynamic::Params params;
+    params.mirroredSampling = true;
+    std::vector<double> initialMean(kDim, 0.4);
+    CmaEsOptimizerDynamic optimizer(kDim);
+    optimizer.setParams(params);
+    optimizer.setSeed(5);
+    optimizer.initFromParcor(initialMean.data());
+
+    std::vector<double> population(static_cast<size_t>(kLambda * kDim));
+    optimizer.sample(population.data(), kLambda);
+    double asymmetry = 0.0;
+    for (int k = 0; k + 1 < kLambda; k += 2)
+        for (int d = 0; d < kDim; ++d)
+            asymmetry = std::max(asymmetry, std::abs(population[static_cast<size_t>(k * kDim + d)]
+                                                     + population[static_cast<size_t>((k + 1) * kDim + d)] - 0.8));
+    check(asymmetry < 1e-12, "mirrored: rows 2k and 2k+1 are symmetric about the mean");
+
+    double lastSpread = 0.0;
+    for (int d = 0; d < kDim; ++d)
+        lastSpread = std::max(lastSpread, std::abs(population[static_cast<size_t>((kLambda - 1) * kDim + d)] - 0.4));
+    check(lastSpread > 0.0, "mirrored: the unpaired last row is still a fresh draw");
+}
+
+void testQuasiNormals()
+{
+    using convo::cmaes::inverseNormalCdf;
+    check(std::abs(inverseNormalCdf(0.5)) < 1e-12, "inverseNormalCdf(0.5) = 0");
+    check(std::abs(inverseNormalCdf(0.975) - 1.959963984540054) < 1e-10, "inverseNormalCdf(0.975)");
+    check(std::abs(inverseNormalCdf(1e-6) + 4.753424308822899) < 1e-8, "inverseNormalCdf in the lower tail");
+    check(std::abs(inverseNormalCdf(0.999) - 3.090232306167813) < 1e-9, "inverseNormalCdf in the upper tail");
+
+    constexpr int kDim = 24;
+    constexpr int kRows = 4096;
+    convo::cmaes::QuasiNormalGenerator quasi(kDim);
+    std::mt19937 rng(3);
+    std::vector<double> z(static_cast<size_t>(kRows * kDim));
+    quasi.generate(z.data(), kRows, kDim, rng);
+
+    double worstMean = 0.0, worstVariance = 0.0;
+    for (int d = 0; d < kDim; ++d)
+    {
+        double sum = 0.0, sumSq = 0.0;
+        for (int k = 0; k < kRows; ++k)
+        {
+            const double v = z[static_cast<size_t>(k * kDim + d)];
+            sum += v;
+            sumSq += v * v;
+        }
+        worstMean = std::max(worstMean, std::abs(sum / kRows));
+        worstVariance = std::max(worstVariance, std::abs(sumSq / kRows - 1.0));
+    }
+    // 擬似乱数なら平均の標準誤差は 1/√4096 ≈ 0.016 (24 次元の最悪値は 0.04 前後)。低食い違い列はそれより小さい
+    check(worstMean < 0.015, "quasi-random normals have mean close to 0 in every dimension");
+    check(worstVariance < 0.05, "quasi-random normals have unit variance in every dimension");
+}
+
+void testMirroredUpdateAndTruncation()
+{
+    constexpr int kDim = 8;
+    constexpr int kLambda = 24;
+    CmaEsOptimizerDynamic::Params params;
+    params.mirroredSampling = true;
+    std::vector<double> initialMean(kDim, 0.0);
+
+    CmaEsOptimizerDynamic optimizer(kDim);
+    optimizer.setParams(params);
+    optimizer.setSeed(11);
+    optimizer.initFromParcor(initialMean.data());
+    optimizer.reserve(kLambda);
+
+    std::vector<double> population(static_cast<size_t>(kLambda * kDim));
+    std::vector<double> fitness(kLambda);
+    double worst = 0.0;
+    for (int gen = 0; gen < 6; ++gen)
+    {
+        optimizer.sample(population.data(), kLambda);
+        // 奇数世代は評価を 16 個で打ち切ったものとして update する
+        const int evaluated = (gen & 1) ? 16 : kLambda;
+        for (int k = 0; k < evaluated; ++k)
+            fitness[k] = sphere(population.data() + k * kDim, kDim, 0.7);
+
+        std::vector<double> winnerPopulation;
+        std::vector<double> winnerFitness;
+        for (int k = 0; k < evaluated; ++k)
+        {
+            if (convo::cmaes::isMirroredPairLoser(fitness.data(), k, evaluated))
+                continue;
+            winnerPopulation.insert(winnerPopulation.end(), population.begin() + k * kDim, population.begin() + (k + 1) * kDim);
+            winnerFitness.push_back(fitness[k]);
+        }
+        check(static_cast<int>(winnerFitness.size()) == evaluated / 2, "mirrored: exactly one winner per pair");
+
+        const State before = captureState(optimizer);
+        const State expected = referenceUpdate(before, kDim, winnerPopulation, winnerFitness, params.covRetentionTarget, params);
+        optimizer.update(population.data(), evaluated, fitness.data());
+        const State actual = captureState(optimizer);
+        worst = std::max({ worst, maxAbsDiff(actual.mean, expected.mean),
+                           maxAbsDiff(actual.covariance, expected.covariance), std::abs(actual.sigma - expected.sigma) });
+    }
+    check(worst < 1e-12, "mirrored update selects among pair winners, truncated generations use the leading rows");
+}
+
+void testMirroredQuasiConverges()
+{
+    constexpr int kDim = 20;
+    constexpr int kLambda = 40;
+    CmaEsOptimizerDynamic::Params params;
+    params.sigmaMin = 1e-4;
+    params.mirroredSampling = true;
+    params.quasiRandomSampling = true;
+    std::vector<double> initialMean(kDim, 0.0);
+    CmaEsOptimizerDynamic optimizer(kDim);
+    optimizer.setParams(params);
+    optimizer.setSeed(99);
+    optimizer.initFromParcor(initialMean.data());
+
+    std::vector<double> population(static_cast<size_t>(kLambda * kDim));
+    std::vector<double> fitness(kLambda);
+    double best = std::numeric_limits<double>::max();
+    for (int gen = 0; gen < 400; ++gen)
+    {
+        optimizer.sample(population.data(), kLambda);
+        for (int k = 0; k < kLambda; ++k)
+        {
+            fitness[k] = sphere(population.data() + k * kDim, kDim, 0.3);
+            best = std::min(best, fitness[k]);
+        }
+        optimizer.update(population.data(), kLambda, fitness.data());
+    }
+    check(best < 0.1 * sphere(initialMean.data(), kDim, 0.3), "mirrored + quasi-random: 20-dim sphere improves by 10x");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[CmaEsOptimizerDynamicTests] Start\n";
+    testSampleLayouts();
+    testUpdateMatchesReference();
+    testNonFiniteReset();
+    testConverges();
+    testMirroredPairs();
+    testQuasiNormals();
+    testMirroredUpdateAndTruncation();
+    testMirroredQuasiConverges();
+    std::cout << "[CmaEsOptimizerDynamicTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
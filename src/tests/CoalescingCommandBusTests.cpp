@@ -0,0 +1,176 @@
+//==============================================================================
+// CoalescingCommandBusTests.cpp
+//
+// convo::CoalescingCommandBus (core/CoalescingCommandBus.h) のテスト。
+//   1. 同じスロットへの連続 post が drain 1 回で 1 件に畳まれ、最後の値が残ること
+//   2. 1 drain 内で元の値へ戻ったバーストは変化なしとして落ちること (postEvent は必ず変化あり)
+//   3. 起床通知 (post の戻り値) が dirty の空→非空でだけ立つこと / 複数ワードのスロット
+//   4. 複数 Producer の post と並行 drain で、最終値が取りこぼされないこと
+//   5. オートメーションのバースト (1 tick あたり多数の post) で publication が tick 数に収まること
+// JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+#include "core/CoalescingCommandBus.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Bus = convo::CoalescingCommandBus<8>;
+
+void testLastValueWins()
+{
+    Bus bus;
+    check(!bus.drain().any(), "empty bus drains nothing");
+
+    for (uint64_t v = 1; v <= 100; ++v)
+        bus.post(3, v);
+    bus.post(5, 0);   // 初回は値 0 でも変化あり
+    check(bus.hasPending(), "posts leave the bus pending");
+
+    const auto changed = bus.drain();
+    check(changed.count() == 2 && changed.test(3) && changed.test(5), "burst folds into one entry per slot");
+    check(bus.getDrainedSlotCount() == 2, "drain visits each dirty slot once");
+    check(bus.getPublishedDrainCount() == 1, "one publication for the burst");
+    check(bus.getPostCount() == 101, "every post is counted");
+    check(!bus.hasPending() && !bus.drain().any(), "nothing left after drain");
+
+    bus.post(3, 100);   // 最後に drain した値と同じ
+    check(!bus.drain().any(), "re-posting the drained value is not a change");
+}
+
+void testNetZeroBurst()
+{
+    Bus bus;
+    bus.post(1, 10);
+    (void)bus.drain();
+
+    bus.post(1, 11);
+    bus.post(1, 12);
+    bus.post(1, 10);
+    check(!bus.drain().any(), "burst that returns to the drained value drops out");
+    check(bus.getPublishedDrainCount() == 1, "net-zero burst costs no publication");
+
+    bus.postEvent(2);
+    bus.postEvent(2);
+    const auto changed = bus.drain();
+    check(changed.count() == 1 && changed.test(2), "events always count as a change");
+    bus.postEvent(2);
+    check(bus.drain().test(2), "every event drain is a change");
+}
+
+void testWakeupAndWords()
+{
+    auto bus = std::make_unique<convo::CoalescingCommandBus<130>>();
+    check(convo::CoalescingCommandBus<130>::kMaskWords == 3, "mask words cover all slots");
+
+    check(bus->post(0, 1), "first post wakes the consumer");
+    check(!bus->post(0, 2), "second post in the same word does not");
+    check(!bus->post(63, 2), "same word, other slot does not");
+    check(bus->post(129, 7), "first post in another word wakes the consumer");
+    check(!bus->post(130, 1), "out-of-range slot is rejected");
+
+    const auto changed = bus->drain();
+    check(changed.count() == 3 && changed.test(0) && changed.test(63) && changed.test(129), "slots across words drained");
+    check(bus->post(0, 3), "post after drain wakes the consumer again");
+    (void)bus->drain();
+}
+
+void testConcurrentProducers()
+{
+    auto bus = std::make_unique<Bus>();
+    constexpr int kProducers = 4;
+    constexpr uint64_t kPerProducer = 50000;
+    std::atomic<int> producersDone { 0 };
+
+    std::thread consumer([&]
+    {
+        while (producersDone.load(std::memory_order_acquire) < kProducers)
+            (void)bus->drain();
+        (void)bus->drain();
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&, p]
+        {
+            // 各 Producer は自分専用の 2 スロットへ単調増加の値を書く
+            for (uint64_t i = 1; i <= kPerProducer; ++i)
+                bus->post(static_cast<size_t>(p * 2 + (i & 1)), i);
+            producersDone.fetch_add(1, std::memory_order_acq_rel);
+        });
+    }
+    for (auto& t : producers)
+        t.join();
+    consumer.join();
+
+    // 最終値はすでに drain 済みのはず: 同じ値を再 post しても変化なし
+    for (int p = 0; p < kProducers; ++p)
+    {
+        bus->post(static_cast<size_t>(p * 2 + 0), kPerProducer);
+        bus->post(static_cast<size_t>(p * 2 + 1), kPerProducer - 1);
+    }
+    check(!bus->drain().any(), "concurrent: final value of every slot reached the consumer");
+    check(bus->getPostCount() == kProducers * kPerProducer + kProducers * 2, "concurrent: post count matches");
+    check(bus->getPublishedDrainCount() < kProducers * kPerProducer, "concurrent: bursts were coalesced");
+}
+
+void testAutomationBurstPerTick()
+{
+    Bus bus;
+    constexpr int kTicks = 50;
+    constexpr int kEventsPerTick = 200;
+    int publications = 0;
+    for (int tick = 0; tick < kTicks; ++tick)
+    {
+        // 3 パラメータが 1 tick 内でそれぞれ多数回動く
+        for (int e = 0; e < kEventsPerTick; ++e)
+        {
+            const uint64_t v = static_cast<uint64_t>(tick * kEventsPerTick + e + 1);
+            bus.post(0, v);
+            bus.post(1, v * 3);
+            bus.post(6, v * 7);
+        }
+        if (bus.drain().any())
+            ++publications;
+    }
+    check(publications == kTicks, "automation: one publication per tick");
+    check(bus.getPostCount() == static_cast<uint64_t>(kTicks * kEventsPerTick * 3), "automation: all events posted");
+    std::cout << "  automation burst: " << bus.getPostCount() << " posts -> " << publications << " publications\n";
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[CoalescingCommandBusTests] Start\n";
+    testLastValueWins();
+    testNetZeroBurst();
+    testWakeupAndWords();
+    testConcurrentProducers();
+    testAutomationBurstPerTick();
+    std::cout << "[CoalescingCommandBusTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
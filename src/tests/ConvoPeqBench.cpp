@@ -0,0 +1,905 @@
+//==============================================================================
+// ConvoPeqBench.cpp — DSP カーネル統合ベンチマーク
+//
+// 目的:
+//   Audio Thread で回る DSP カーネルを同じ計測器・同じ条件で並べ、ビルド間で差分を取れる
+//   JSON ベースラインを残す。個別ベンチ (NucBenchmark / NucCmacBenchmark) は詳細調査用に残す。
+//
+// 対象 (name は "<group>/<構成>"。ベースライン比較のキーになるので変えないこと):
+//   nuc/...        MKLNonUniformConvolver ステレオペア (AddStereo + Get)、IR 長 × ブロック長
+//   eq/...         EQProcessor::process、Serial / Parallel × 有効バンド 1〜20 × Stereo / M/S
+//   os/...         CustomInputOversampler processUp + processDown、プリセット × 2/4/8x
+//   truepeak       TruePeakDetector::processBlock
+//   loudness       LoudnessMeter::processBlock
+//   shaper/...     全ノイズシェーパー (Psychoacoustic / Fixed4Tap / Fixed15Tap / Adaptive9thOrder)、24bit
+//   chain/...      DSPCore::processDouble と同じ順に同じ段を直列に回した 1 callback
+//
+// 測定項目 (構成ごと、--repeat 回の計測の中央値):
+//   - nsPerSample      : デバイスレート 1 ステレオフレームあたりの平均処理時間 (ns)
+//   - cyclesPerSample  : 同じく TSC サイクル (__rdtsc、定格周波数で刻む参照クロック)
+//   - noisePct         : 回ごとの nsPerSample のばらつき (1.4826 × MAD / 中央値、%)
+//   - callback p99 / worst (us、全回通し)
+//   - allocations      : prepare 後の処理呼び出し中の operator new 回数 + MKL 確保量の増分 (0 以外は FAIL)
+//
+// 使い方:
+//   ConvoPeqBench [--quick] [--repeat=<n>] [--out=<path>] [--core=<n>] [--filter=<substr>]
+//                 [--compare=<baseline.json> | --baseline-dir=<dir>] [--tolerance=<pct>]
+//                 [--update-baseline]
+//   JSON を stdout (または --out のファイル) へ、進捗と判定を stderr へ出力する。
+//
+// 回帰ゲート (CTest の ConvoPeqBenchRegressionGate):
+//   --baseline-dir は <dir>/<マシンクラス>.json をベースラインにする。マシンクラスは CPU モデル名と
+//   解決済み ISA から作るので、同じ型番の機械どうしでだけ比べる。name ごとに中央値の nsPerSample を比べ、
+//   max(--tolerance (既定 10%), 3 × 両者の noisePct の大きい方) を超えて遅くなった構成があれば終了コード 1。
+//   ベースラインが無ければ kExitSkipped (CTest の SKIP_RETURN_CODE) で抜ける。
+//   --update-baseline は今回の結果をそのベースラインとして書き出す (比較はしない)。
+//
+// 設計:
+//   計測スレッドは --core の論理コアへ固定し (既定 2、-1 で固定しない)、Audio Thread と同じく
+//   FTZ/DAZ・MKL 1 スレッドで回す。入力は固定シードの白色雑音を事前生成し、計測区間の外で
+//   作業バッファへ写す。処理は実時間ペースではなく連続実行する。
+//   DSPCore は AudioEngine の内部型で、Rebuild Thread・RCU・ConvolverProcessor を含むエンジン全体が
+//   無いと組めない。chain はその代わりに processDouble の段順 (OS up → DC → EQ → Convolver →
+//   出力フィルタ → OS down → DC → ノイズシェーパー → TruePeak → LUFS → リミッタ) を同じクラスで
+//   組んだもので、無音スキップ・クロスフェード・メータ公開は含まない。
+//   エンジンを通した実時間比は --cli-render (OfflineRenderer) で測る。
+//==============================================================================
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include <JuceHeader.h>
+#include <mkl.h>
+
+#include "CustomInputOversampler.h"
+#include "EQProcessor.h"
+#include "Fixed15TapNoiseShaper.h"
+#include "FixedNoiseShaper.h"
+#include "LatticeNoiseShaper.h"
+#include "LoudnessMeter.h"
+#include "MKLNonUniformConvolver.h"
+#include "OutputFilter.h"
+#include "PsychoacousticDither.h"
+#include "TruePeakDetector.h"
+#include "UltraHighRateDCBlocker.h"
+#include "audioengine/LookAheadPeakLimiter.h"
+#include "dsp/DitherNoisePool.h"
+#include "dsp/KernelDispatch.h"
+
+namespace {
+
+using Nuc = convo::MKLNonUniformConvolver;
+
+constexpr double kBaseRate = 48000.0;
+constexpr int kDitherBitDepth = 24;
+constexpr double kOutputHeadroom = 0.8912509381337456;  // -1 dBFS (DSPCore の出力段と同じ)
+constexpr int kExitSkipped = 77;
+
+struct RunOptions {
+    bool quick = false;
+    int repeats = 1;
+    double minSeconds = 2.0;
+    std::string filter;
+};
+
+struct BenchResult {
+    std::string name;
+    std::string group;
+    double sampleRate = kBaseRate;
+    int blockSize = 0;
+    int callbacks = 0;
+    bool built = true;
+    bool finite = true;
+    double nsPerSample = 0.0;
+    double cyclesPerSample = 0.0;
+    double noisePct = 0.0;
+    double p99Us = 0.0;
+    double worstUs = 0.0;
+    int64_t allocations = 0;
+};
+
+//------------------------------------------------------------------------------
+// 確保カウンタ
+//   計測スレッドが処理呼び出し中だけ armed にし、その間の operator new を数える。
+//   MKL の確保 (mkl_malloc) は operator new を通らないので mkl_mem_stat の増分で別に見る
+//------------------------------------------------------------------------------
+
+thread_local bool t_countAllocations = false;
+thread_local int64_t t_allocationCount = 0;
+
+void noteAllocation() noexcept
+{
+    if (t_countAllocations)
+        ++t_allocationCount;
+}
+
+int64_t mklAllocatedBytes() noexcept
+{
+    int buffers = 0;
+    return static_cast<int64_t>(mkl_mem_stat(&buffers));
+}
+
+class ScopedAllocationCount {
+public:
+    explicit ScopedAllocationCount(int64_t& total) noexcept
+        : total(total), countBefore(t_allocationCount), mklBefore(mklAllocatedBytes())
+    {
+        t_countAllocations = true;
+    }
+
+    ~ScopedAllocationCount()
+    {
+        t_countAllocations = false;
+        total += (t_allocationCount - countBefore) + (mklAllocatedBytes() > mklBefore ? 1 : 0);
+    }
+
+    ScopedAllocationCount(const ScopedAllocationCount&) = delete;
+    ScopedAllocationCount& operator=(const ScopedAllocationCount&) = delete;
+
+private:
+    int64_t& total;
+    int64_t countBefore;
+    int64_t mklBefore;
+};
+
+//------------------------------------------------------------------------------
+// 入力 / 計測器
+//------------------------------------------------------------------------------
+
+// 事前生成したステレオ白色雑音。callback ごとに次のブロックを作業バッファへ写す
+class NoiseSource {
+public:
+    NoiseSource(int blockSize, uint32_t seed)
+        : blockSize(blockSize)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-0.25, 0.25);
+        for (auto& channel : data) {
+            channel.resize(static_cast<size_t>(blockSize) * kNumBlocks);
+            for (auto& s : channel)
+                s = dist(rng);
+        }
+    }
+
+    void fill(juce::AudioBuffer<double>& buffer) noexcept
+    {
+        const size_t offset = static_cast<size_t>(next) * static_cast<size_t>(blockSize);
+        for (int ch = 0; ch < 2; ++ch)
+            std::copy_n(data[static_cast<size_t>(ch)].data() + offset, blockSize, buffer.getWritePointer(ch));
+        next = (next + 1) % kNumBlocks;
+    }
+
+private:
+    static constexpr int kNumBlocks = 64;
+    int blockSize;
+    int next = 0;
+    std::array<std::vector<double>, 2> data;
+};
+
+bool blockIsFinite(const juce::AudioBuffer<double>& buffer) noexcept
+{
+    const int last = buffer.getNumSamples() - 1;
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        if (!std::isfinite(buffer.getSample(ch, 0)) || !std::isfinite(buffer.getSample(ch, last)))
+            return false;
+    return true;
+}
+
+double percentileUs(const std::vector<double>& sortedNs, double q)
+{
+    if (sortedNs.empty())
+        return 0.0;
+    const size_t idx = std::min(sortedNs.size() - 1,
+                                static_cast<size_t>(std::ceil(q * static_cast<double>(sortedNs.size()))) - 1);
+    return sortedNs[idx] * 1.0e-3;
+}
+
+double median(std::vector<double> values)
+{
+    if (values.empty())
+        return 0.0;
+    const size_t mid = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(mid), values.end());
+    const double upper = values[mid];
+    if ((values.size() % 2) != 0)
+        return upper;
+    return (*std::max_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(mid)) + upper) * 0.5;
+}
+
+// 中央値からの絶対偏差の中央値を正規分布の標準偏差へ換算し、中央値に対する % で返す
+double relativeNoisePct(const std::vector<double>& values, double center)
+{
+    if (values.size() < 2 || center <= 0.0)
+        return 0.0;
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (const double v : values)
+        deviations.push_back(std::abs(v - center));
+    return 1.4826 * median(std::move(deviations)) / center * 100.0;
+}
+
+// process を callbacks 回 × opt.repeats 回計測する。untimed は各 callback の後に計測区間の外で呼ぶ
+// (ディザプール補充など)。確保はウォームアップを含む prepare 後のすべての process 呼び出しで数える
+BenchResult measure(BenchResult r, int minCallbacks, const RunOptions& opt,
+                    const std::function<void(juce::AudioBuffer<double>&)>& process,
+                    const std::function<void()>& untimed = {})
+{
+    using Clock = std::chrono::steady_clock;
+
+    r.callbacks = std::max(minCallbacks,
+                           static_cast<int>(opt.minSeconds * r.sampleRate / static_cast<double>(r.blockSize)));
+
+    juce::AudioBuffer<double> buffer(2, r.blockSize);
+    NoiseSource source(r.blockSize, static_cast<uint32_t>(std::hash<std::string>{}(r.name)));
+    std::vector<double> callbackNs;
+    callbackNs.reserve(static_cast<size_t>(r.callbacks) * static_cast<size_t>(opt.repeats));
+    std::vector<double> roundNsPerSample;
+    std::vector<double> roundCyclesPerSample;
+
+    // ウォームアップ (キャッシュ/周波数安定化、遅延初期化)
+    for (int i = 0; i < 16; ++i) {
+        source.fill(buffer);
+        {
+            ScopedAllocationCount count(r.allocations);
+            process(buffer);
+        }
+        if (untimed)
+            untimed();
+    }
+
+    const double roundSamples = static_cast<double>(r.callbacks) * static_cast<double>(r.blockSize);
+    for (int round = 0; round < opt.repeats; ++round) {
+        double totalNs = 0.0;
+        uint64_t totalCycles = 0;
+        for (int cb = 0; cb < r.callbacks; ++cb) {
+            source.fill(buffer);
+
+            double ns = 0.0;
+            uint64_t cycles = 0;
+            {
+                ScopedAllocationCount count(r.allocations);
+                const auto start = Clock::now();
+                const uint64_t startCycles = __rdtsc();
+                process(buffer);
+                cycles = __rdtsc() - startCycles;
+                ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            }
+
+            callbackNs.push_back(ns);
+            totalNs += ns;
+            totalCycles += cycles;
+            r.finite = r.finite && blockIsFinite(buffer);
+            if (untimed)
+                untimed();
+        }
+        roundNsPerSample.push_back(totalNs / roundSamples);
+        roundCyclesPerSample.push_back(static_cast<double>(totalCycles) / roundSamples);
+    }
+
+    std::sort(callbackNs.begin(), callbackNs.end());
+    r.nsPerSample = median(roundNsPerSample);
+    r.cyclesPerSample = median(roundCyclesPerSample);
+    r.noisePct = relativeNoisePct(roundNsPerSample, r.nsPerSample);
+    r.p99Us = percentileUs(callbackNs, 0.99);
+    r.worstUs = callbackNs.back() * 1.0e-3;
+    return r;
+}
+
+//------------------------------------------------------------------------------
+// 構成
+//------------------------------------------------------------------------------
+
+std::vector<double> makeDecayingNoiseIR(int irLength, uint32_t seed)
+{
+    std::vector<double> ir(static_cast<size_t>(irLength));
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    // RT60 = IR 長: 末尾で -60 dB (partition culling が末尾を間引かない包絡)
+    const double decayPerSample = std::log(1.0e-3) / std::max(1.0, static_cast<double>(irLength));
+    for (int i = 0; i < irLength; ++i)
+        ir[static_cast<size_t>(i)] = dist(rng) * std::exp(decayPerSample * i) * 0.05;
+    ir[0] = 1.0;
+    return ir;
+}
+
+// ステレオ NUC ペア。chain からも使う
+struct StereoConvolver {
+    Nuc left;
+    Nuc right;
+
+    bool build(double irSeconds, double processingRate, int blockSize)
+    {
+        const int irLength = std::max(1, static_cast<int>(std::lround(irSeconds * processingRate)));
+        const auto irL = makeDecayingNoiseIR(irLength, 11);
+        const auto irR = makeDecayingNoiseIR(irLength, 12);
+        convo::FilterSpec spec;
+        spec.sampleRate = processingRate;
+        return left.SetImpulse(irL.data(), irLength, blockSize, 1.0, false, &spec)
+            && right.SetImpulse(irR.data(), irLength, blockSize, 1.0, false, &spec);
+    }
+
+    void process(double* dataL, double* dataR, int numSamples) noexcept
+    {
+        Nuc::AddStereo(left, right, dataL, dataR, numSamples);
+        left.Get(dataL, numSamples);
+        right.Get(dataR, numSamples);
+    }
+
+    // 全レイヤーが少なくとも 1 周する callback 数
+    static int minCallbacksFor(double irSeconds, double processingRate, int blockSize) noexcept
+    {
+        return static_cast<int>(std::ceil(2.0 * irSeconds * processingRate / static_cast<double>(blockSize)));
+    }
+};
+
+// 有効バンドは Peaking ±3 dB を交互に、M/S では Mid / Side を交互に割り当てる
+void configureEq(EQProcessor& eq, int activeBands, bool midSide, EQProcessor::FilterStructure structure)
+{
+    for (int band = 0; band < EQProcessor::NUM_BANDS; ++band) {
+        eq.setBandType(band, EQBandType::Peaking);
+        eq.setBandGain(band, (band % 2 == 0) ? 3.0f : -3.0f);
+        eq.setBandQ(band, 1.0f);
+        eq.setBandChannelMode(band, !midSide ? EQChannelMode::Stereo
+                                             : ((band % 2 == 0) ? EQChannelMode::Mid : EQChannelMode::Side));
+        eq.setBandEnabled(band, band < activeBands);
+    }
+    eq.setFilterStructure(structure);
+}
+
+const char* presetName(CustomInputOversampler::Preset preset) noexcept
+{
+    switch (preset) {
+        case CustomInputOversampler::Preset::IIRLike:      return "iir";
+        case CustomInputOversampler::Preset::LinearPhase:  return "linear";
+        case CustomInputOversampler::Preset::MinimumPhase: return "minimum";
+    }
+    return "unknown";
+}
+
+constexpr CustomInputOversampler::Preset kPresets[] = {
+    CustomInputOversampler::Preset::IIRLike,
+    CustomInputOversampler::Preset::LinearPhase,
+    CustomInputOversampler::Preset::MinimumPhase
+};
+
+//------------------------------------------------------------------------------
+// グループ別
+//------------------------------------------------------------------------------
+
+bool resultPassed(const BenchResult& r) noexcept
+{
+    return r.built && r.finite && r.allocations == 0;
+}
+
+class Bench {
+public:
+    explicit Bench(const RunOptions& options) : opt(options) {}
+
+    std::vector<BenchResult> results;
+
+    void runAll()
+    {
+        runNuc();
+        runEq();
+        runOversampler();
+        runMeters();
+        runNoiseShapers();
+        runChain();
+    }
+
+private:
+    const RunOptions& opt;
+
+    bool selected(const std::string& name) const
+    {
+        return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+    }
+
+    void record(const BenchResult& r)
+    {
+        std::fprintf(stderr, "  [%s] %-34s ns/sample=%8.2f (+-%4.1f%%) cycles/sample=%8.2f p99=%8.1fus worst=%8.1fus alloc=%lld\n",
+                     resultPassed(r) ? "OK" : "FAIL", r.name.c_str(),
+                     r.nsPerSample, r.noisePct, r.cyclesPerSample, r.p99Us, r.worstUs,
+                     static_cast<long long>(r.allocations));
+        results.push_back(r);
+    }
+
+    static BenchResult makeResult(std::string name, const char* group, int blockSize, double sampleRate = kBaseRate)
+    {
+        BenchResult r;
+        r.name = std::move(name);
+        r.group = group;
+        r.blockSize = blockSize;
+        r.sampleRate = sampleRate;
+        return r;
+    }
+
+    void runNuc()
+    {
+        const std::vector<double> irSecondsList = opt.quick ? std::vector<double> { 1.0 } : std::vector<double> { 0.5, 2.0, 6.0 };
+        const std::vector<int> blockSizes = opt.quick ? std::vector<int> { 256 } : std::vector<int> { 64, 256, 1024 };
+
+        for (const double irSeconds : irSecondsList)
+            for (const int blockSize : blockSizes) {
+                char name[64];
+                std::snprintf(name, sizeof(name), "nuc/ir%.1fs/bs%d", irSeconds, blockSize);
+                if (!selected(name))
+                    continue;
+
+                auto r = makeResult(name, "nuc", blockSize);
+                auto conv = std::make_unique<StereoConvolver>();
+                if (!conv->build(irSeconds, kBaseRate, blockSize)) {
+                    r.built = false;
+                    record(r);
+                    continue;
+                }
+                record(measure(r, StereoConvolver::minCallbacksFor(irSeconds, kBaseRate, blockSize), opt,
+                               [&](juce::AudioBuffer<double>& buffer) {
+                                   conv->process(buffer.getWritePointer(0), buffer.getWritePointer(1), blockSize);
+                               }));
+            }
+    }
+
+    void runEq()
+    {
+        constexpr int kBlock = 512;
+        const std::vector<int> bandCounts = opt.quick ? std::vector<int> { 1, 20 } : std::vector<int> { 1, 5, 10, 20 };
+
+        for (const auto structure : { EQProcessor::FilterStructure::Serial, EQProcessor::FilterStructure::Parallel })
+            for (const int bands : bandCounts)
+                for (const bool midSide : { false, true }) {
+                    const std::string name = std::string("eq/")
+                        + (structure == EQProcessor::FilterStructure::Serial ? "serial" : "parallel")
+                        + "/b" + std::to_string(bands) + (midSide ? "/ms" : "/stereo");
+                    if (!selected(name))
+                        continue;
+
+                    auto eq = std::make_unique<EQProcessor>();
+                    configureEq(*eq, bands, midSide, structure);
+                    eq->prepareToPlay(kBaseRate, kBlock);
+                    record(measure(makeResult(name, "eq", kBlock), 0, opt, [&](juce::AudioBuffer<double>& buffer) {
+                        juce::dsp::AudioBlock<double> block(buffer);
+                        eq->process(block);
+                    }));
+                    eq->releaseResources();
+                }
+    }
+
+    void runOversampler()
+    {
+        constexpr int kBlock = 512;
+        for (const auto preset : kPresets)
+            for (const int ratio : { 2, 4, 8 }) {
+                const std::string name = std::string("os/") + presetName(preset) + "/x" + std::to_string(ratio);
+                if (!selected(name))
+                    continue;
+
+                CustomInputOversampler os;
+                os.prepare(kBlock, ratio, preset);
+                record(measure(makeResult(name, "os", kBlock), 0, opt, [&](juce::AudioBuffer<double>& buffer) {
+                    juce::dsp::AudioBlock<double> block(buffer);
+                    auto up = os.processUp(block, 2);
+                    os.processDown(up, block, 2);
+                }));
+                os.release();
+            }
+    }
+
+    void runMeters()
+    {
+        constexpr int kBlock = 512;
+        if (selected("truepeak")) {
+            TruePeakDetector detector;
+            detector.prepare(kBaseRate, kBlock);
+            record(measure(makeResult("truepeak", "meter", kBlock), 0, opt, [&](juce::AudioBuffer<double>& buffer) {
+                detector.processBlock(buffer.getReadPointer(0), buffer.getReadPointer(1), kBlock);
+            }));
+        }
+        if (selected("loudness")) {
+            LoudnessMeter meter;
+            meter.prepare(kBaseRate, kBlock);
+            record(measure(makeResult("loudness", "meter", kBlock), 0, opt, [&](juce::AudioBuffer<double>& buffer) {
+                meter.processBlock(buffer.getReadPointer(0), buffer.getReadPointer(1), kBlock);
+            }));
+        }
+    }
+
+    // DSPCore と同じく全シェーパーへ共用ディザプールを渡し、補充は計測区間の外で行う
+    void runNoiseShapers()
+    {
+        constexpr int kBlock = 512;
+        auto pool = std::make_unique<convo::dsp::DitherNoisePool>();
+        pool->prepare(0xD17Eu);
+        const auto refill = [&] { pool->refillNonRt(); };
+
+        const auto run = [&](const char* name, auto& shaper) {
+            if (!selected(name))
+                return;
+            shaper.setNoisePool(pool.get());
+            record(measure(makeResult(name, "shaper", kBlock), 0, opt, [&](juce::AudioBuffer<double>& buffer) {
+                shaper.processStereoBlock(buffer.getWritePointer(0), buffer.getWritePointer(1), kBlock, kOutputHeadroom);
+            }, refill));
+        };
+
+        {
+            auto dither = std::make_unique<convo::PsychoacousticDither>();
+            dither->prepare(kBaseRate, kDitherBitDepth);
+            run("shaper/psychoacoustic", *dither);
+        }
+        {
+            auto fixed = std::make_unique<convo::FixedNoiseShaper>();
+            fixed->prepare(kBaseRate, kDitherBitDepth);
+            run("shaper/fixed4", *fixed);
+        }
+        {
+            auto fixed15 = std::make_unique<convo::Fixed15TapNoiseShaper>();
+            fixed15->prepare(kBaseRate, kDitherBitDepth);
+            run("shaper/fixed15", *fixed15);
+        }
+        {
+            // 格子係数の値は費用に影響しない (反射係数の範囲内で全段が有効になる値を置く)
+            constexpr std::array<double, LatticeNoiseShaper::kOrder> kCoeffs { 0.02, -0.02, 0.015, -0.015, 0.01, -0.01, 0.005, -0.005, 0.002 };
+            auto lattice = std::make_unique<LatticeNoiseShaper>();
+            lattice->prepare(kDitherBitDepth);
+            lattice->setCoefficients(kCoeffs.data(), LatticeNoiseShaper::kOrder);
+            run("shaper/adaptive9", *lattice);
+        }
+    }
+
+    void runChain()
+    {
+        constexpr double kIrSeconds = 2.0;
+        constexpr int kEqBands = 10;
+        const std::vector<int> osFactors = opt.quick ? std::vector<int> { 4 } : std::vector<int> { 1, 2, 4, 8 };
+        const std::vector<int> blockSizes = opt.quick ? std::vector<int> { 256 } : std::vector<int> { 128, 512 };
+
+        for (const int osFactor : osFactors)
+            for (const int blockSize : blockSizes) {
+                const std::string name = "chain/x" + std::to_string(osFactor) + "/bs" + std::to_string(blockSize);
+                if (!selected(name))
+                    continue;
+                record(runChainConfig(name, osFactor, blockSize, kIrSeconds, kEqBands));
+            }
+    }
+
+    // processDouble の EQ→Convolver 順、IIR 系 OS、Psychoacoustic ディザ、SoftClip なし
+    BenchResult runChainConfig(const std::string& name, int osFactor, int blockSize, double irSeconds, int eqBands)
+    {
+        const double processingRate = kBaseRate * osFactor;
+        const int processingBlock = blockSize * osFactor;
+        auto r = makeResult(name, "chain", blockSize);
+
+        CustomInputOversampler os;
+        if (osFactor > 1)
+            os.prepare(blockSize, osFactor, CustomInputOversampler::Preset::IIRLike);
+
+        auto conv = std::make_unique<StereoConvolver>();
+        if (!conv->build(irSeconds, processingRate, processingBlock)) {
+            r.built = false;
+            return r;
+        }
+
+        auto eq = std::make_unique<EQProcessor>();
+        configureEq(*eq, eqBands, false, EQProcessor::FilterStructure::Serial);
+        eq->prepareToPlay(processingRate, processingBlock);
+
+        convo::UltraHighRateDCBlocker osDcL, osDcR, outDcL, outDcR;
+        osDcL.init(processingRate, 1.0);
+        osDcR.init(processingRate, 1.0);
+        outDcL.init(kBaseRate, 3.0);
+        outDcR.init(kBaseRate, 3.0);
+
+        convo::OutputFilter outputFilter;
+        outputFilter.prepare(processingRate);
+
+        auto pool = std::make_unique<convo::dsp::DitherNoisePool>();
+        pool->prepare(0xC4A1u);
+        auto dither = std::make_unique<convo::PsychoacousticDither>();
+        dither->setNoisePool(pool.get());
+        dither->prepare(kBaseRate, kDitherBitDepth);
+
+        TruePeakDetector truePeak;
+        truePeak.prepare(kBaseRate, blockSize);
+        LoudnessMeter loudness;
+        loudness.prepare(kBaseRate, blockSize);
+        LookAheadPeakLimiter limiter;
+        limiter.prepare(kBaseRate, LookAheadPeakLimiter::kDefaultLookAheadMs, 100.0);
+        // DSPCore の出力段と同じ: threshold = -1 dBFS から 0.5 dB 下、knee 1 dB
+        constexpr double kLimiterThreshold = 0.8413951287507587;
+        constexpr double kLimiterKnee = 0.108748;
+
+        r = measure(r, StereoConvolver::minCallbacksFor(irSeconds, processingRate, processingBlock), opt,
+                    [&](juce::AudioBuffer<double>& buffer) {
+                        juce::dsp::AudioBlock<double> originalBlock(buffer);
+                        juce::dsp::AudioBlock<double> processBlock = originalBlock;
+                        if (osFactor > 1) {
+                            processBlock = os.processUp(originalBlock, 2);
+                            osDcL.processStereo(processBlock.getChannelPointer(0), processBlock.getChannelPointer(1),
+                                                static_cast<int>(processBlock.getNumSamples()), osDcR);
+                        }
+
+                        eq->process(processBlock);
+                        conv->process(processBlock.getChannelPointer(0), processBlock.getChannelPointer(1),
+                                      static_cast<int>(processBlock.getNumSamples()));
+                        // EQ→Convolver 順で Convolver が最終段 (convIsLast = true)
+                        outputFilter.process(processBlock, true, convo::HCMode::Natural, convo::LCMode::Natural,
+                                             convo::HCMode::Natural);
+
+                        if (osFactor > 1)
+                            os.processDown(processBlock, originalBlock, 2);
+
+                        double* dataL = buffer.getWritePointer(0);
+                        double* dataR = buffer.getWritePointer(1);
+                        outDcL.processStereo(dataL, dataR, blockSize, outDcR);
+                        dither->processStereoBlock(dataL, dataR, blockSize, kOutputHeadroom);
+                        truePeak.processBlock(dataL, dataR, blockSize);
+                        loudness.processBlock(dataL, dataR, blockSize);
+                        limiter.processBlock(dataL, dataR, blockSize, 1.0, kLimiterThreshold, kLimiterKnee);
+                    },
+                    [&] { pool->refillNonRt(); });
+
+        eq->releaseResources();
+        if (osFactor > 1)
+            os.release();
+        return r;
+    }
+};
+
+//------------------------------------------------------------------------------
+// 出力 / 比較
+//------------------------------------------------------------------------------
+
+// ベースラインのファイル名にする: CPU モデル名を英数字と '-' に畳み、解決済み ISA を付ける
+std::string machineClass(const char* isa)
+{
+    std::string cls;
+    for (const char c : juce::SystemStats::getCpuModel().toLowerCase().toStdString()) {
+        const bool alnum = (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+        if (alnum)
+            cls += c;
+        else if (!cls.empty() && cls.back() != '-')
+            cls += '-';
+    }
+    while (!cls.empty() && cls.back() == '-')
+        cls.pop_back();
+    return (cls.empty() ? std::string("unknown-cpu") : cls) + "-" + isa;
+}
+
+void writeJson(std::FILE* out, const std::vector<BenchResult>& results, const RunOptions& opt,
+               const char* isa, const std::string& machine, int pinnedCore, bool allPassed)
+{
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"benchmark\": \"ConvoPeqBench\",\n");
+    std::fprintf(out, "  \"version\": 2,\n");
+    std::fprintf(out, "  \"mode\": \"%s\",\n", opt.quick ? "quick" : "full");
+    std::fprintf(out, "  \"repeats\": %d,\n", opt.repeats);
+    std::fprintf(out, "  \"machineClass\": \"%s\",\n", machine.c_str());
+    std::fprintf(out, "  \"cpu\": \"%s\",\n", juce::SystemStats::getCpuModel().toRawUTF8());
+    std::fprintf(out, "  \"kernelIsa\": \"%s\",\n", isa);
+    std::fprintf(out, "  \"cmacKernel\": \"%s\",\n",
+                 Nuc::getCmacKernel() == Nuc::CmacKernel::Avx512 ? "avx512" : "avx2");
+    std::fprintf(out, "  \"pinnedCore\": %d,\n", pinnedCore);
+    std::fprintf(out, "  \"passed\": %s,\n", allPassed ? "true" : "false");
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        std::fprintf(out,
+                     "    {\"name\": \"%s\", \"group\": \"%s\", \"sampleRate\": %.0f, \"blockSize\": %d, "
+                     "\"callbacks\": %d, \"built\": %s, \"finite\": %s, \"nsPerSample\": %.3f, "
+                     "\"cyclesPerSample\": %.3f, \"noisePct\": %.2f, \"callbackP99Us\": %.3f, "
+                     "\"callbackWorstUs\": %.3f, \"allocations\": %lld}%s\n",
+                     r.name.c_str(), r.group.c_str(), r.sampleRate, r.blockSize, r.callbacks,
+                     r.built ? "true" : "false", r.finite ? "true" : "false",
+                     r.nsPerSample, r.cyclesPerSample, r.noisePct, r.p99Us, r.worstUs,
+                     static_cast<long long>(r.allocations), (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(out, "  ]\n");
+    std::fprintf(out, "}\n");
+}
+
+bool writeJsonFile(const std::string& path, const std::vector<BenchResult>& results, const RunOptions& opt,
+                   const char* isa, const std::string& machine, int pinnedCore, bool allPassed)
+{
+    std::FILE* out = std::fopen(path.c_str(), "w");
+    if (out == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        return false;
+    }
+    writeJson(out, results, opt, isa, machine, pinnedCore, allPassed);
+    std::fclose(out);
+    return true;
+}
+
+// 戻り値: 許容幅を超えて遅くなった構成の数。ベースラインが読めなければ -1。
+// 許容幅は max(tolerancePct, 3 × noisePct) (noisePct は今回とベースラインの大きい方)。
+// 揺れの大きい構成で偶然の遅さを回帰と見なさないため
+int compareWithBaseline(const juce::File& baselineFile, const std::vector<BenchResult>& results, double tolerancePct)
+{
+    const juce::var baseline = juce::JSON::parse(baselineFile);
+    const auto* entries = baseline["results"].getArray();
+    if (entries == nullptr) {
+        std::fprintf(stderr, "cannot read baseline %s\n", baselineFile.getFullPathName().toRawUTF8());
+        return -1;
+    }
+
+    struct Previous {
+        double nsPerSample = 0.0;
+        double noisePct = 0.0;
+    };
+    std::map<std::string, Previous> previous;
+    for (const auto& e : *entries)
+        previous[e["name"].toString().toStdString()] = { static_cast<double>(e["nsPerSample"]),
+                                                         static_cast<double>(e.getProperty("noisePct", 0.0)) };
+
+    std::fprintf(stderr, "=== compare with %s (tolerance %.1f%%) ===\n",
+                 baselineFile.getFileName().toRawUTF8(), tolerancePct);
+    int regressions = 0;
+    for (const auto& r : results) {
+        const auto it = previous.find(r.name);
+        if (it == previous.end() || it->second.nsPerSample <= 0.0) {
+            std::fprintf(stderr, "  %-34s %8s -> %8.2f  (new)\n", r.name.c_str(), "-", r.nsPerSample);
+            continue;
+        }
+        const double allowedPct = std::max(tolerancePct, 3.0 * std::max(r.noisePct, it->second.noisePct));
+        const double deltaPct = (r.nsPerSample - it->second.nsPerSample) / it->second.nsPerSample * 100.0;
+        const bool regressed = deltaPct > allowedPct;
+        regressions += regressed ? 1 : 0;
+        std::fprintf(stderr, "  %-34s %8.2f -> %8.2f  %+6.1f%% (allowed %.1f%%)%s\n", r.name.c_str(),
+                     it->second.nsPerSample, r.nsPerSample, deltaPct, allowedPct, regressed ? "  REGRESSED" : "");
+    }
+    return regressions;
+}
+
+} // namespace
+
+//==============================================================================
+// 確保カウンタ用の operator new / delete 置き換え (このベンチ実行ファイル内だけ)
+//==============================================================================
+void* operator new(std::size_t size)
+{
+    noteAllocation();
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    noteAllocation();
+    const auto align = static_cast<std::size_t>(alignment);
+#if defined(_MSC_VER)
+    if (void* p = _aligned_malloc(size == 0 ? 1 : size, align))
+        return p;
+#else
+    if (void* p = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align))
+        return p;
+#endif
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return ::operator new(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#if defined(_MSC_VER)
+void operator delete(void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { _aligned_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { _aligned_free(p); }
+#else
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
+
+int main(int argc, char** argv)
+{
+    RunOptions opt;
+    std::string outPath;
+    std::string comparePath;
+    std::string baselineDir;
+    bool updateBaseline = false;
+    double tolerancePct = 10.0;
+    int core = 2;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg == "--quick") opt.quick = true;
+        else if (arg == "--update-baseline") updateBaseline = true;
+        else if (arg.rfind("--repeat=", 0) == 0) opt.repeats = std::max(1, std::atoi(arg.c_str() + 9));
+        else if (arg.rfind("--out=", 0) == 0) outPath = arg.substr(6);
+        else if (arg.rfind("--core=", 0) == 0) core = std::atoi(arg.c_str() + 7);
+        else if (arg.rfind("--filter=", 0) == 0) opt.filter = arg.substr(9);
+        else if (arg.rfind("--compare=", 0) == 0) comparePath = arg.substr(10);
+        else if (arg.rfind("--baseline-dir=", 0) == 0) baselineDir = arg.substr(15);
+        else if (arg.rfind("--tolerance=", 0) == 0) tolerancePct = std::atof(arg.c_str() + 12);
+    }
+    opt.minSeconds = opt.quick ? 0.25 : 2.0;
+
+    // ★ JUCE メッセージスレッド初期化 (MKLNonUniformConvolver::releaseAllLayers 必要)
+    juce::initialiseJuce_GUI();
+
+    // ★ アプリ起動時と同じ ISA 解決 (NUC の CMAC 選択も揃える)
+    const auto isa = convo::dsp::initialiseKernelDispatch();
+    Nuc::setCmacKernel(isa == convo::dsp::KernelIsa::Avx512 ? Nuc::CmacKernel::Avx512 : Nuc::CmacKernel::Avx2);
+    const char* isaName = convo::dsp::kernelIsaName(isa);
+    const std::string machine = machineClass(isaName);
+
+    // ★ マシンクラス別ベースライン: 無ければ計測せずにスキップ (比較相手の無い回帰ゲートは通さない)
+    if (!baselineDir.empty()) {
+        comparePath = (std::filesystem::path(baselineDir) / (machine + ".json")).string();
+        if (!updateBaseline && !std::filesystem::exists(comparePath)) {
+            std::fprintf(stderr, "no baseline for machine class '%s' (%s); run with --update-baseline to create it\n",
+                         machine.c_str(), comparePath.c_str());
+            juce::shutdownJuce_GUI();
+            return kExitSkipped;
+        }
+    }
+
+    // ★ コア固定: 別コアへの移動とキャッシュの入れ替わりを計測に混ぜない
+    if (core >= juce::SystemStats::getNumCpus() || core >= 32)
+        core = juce::SystemStats::getNumCpus() > 1 ? 1 : 0;
+    if (core >= 0)
+        juce::Thread::setCurrentThreadAffinityMask(static_cast<juce::uint32>(1u) << core);
+
+    // Audio Thread と同条件 (FTZ/DAZ, MKL 1 スレッド)
+    juce::ScopedNoDenormals noDenormals;
+    mkl_set_num_threads_local(1);
+
+    Bench bench(opt);
+    bench.runAll();
+
+    bool allPassed = !bench.results.empty();
+    for (const auto& r : bench.results)
+        allPassed = allPassed && resultPassed(r);
+
+    if (outPath.empty())
+        writeJson(stdout, bench.results, opt, isaName, machine, core, allPassed);
+    else if (!writeJsonFile(outPath, bench.results, opt, isaName, machine, core, allPassed))
+        writeJson(stdout, bench.results, opt, isaName, machine, core, allPassed);
+
+    bool compareOk = true;
+    if (updateBaseline && !comparePath.empty()) {
+        // 失敗した構成を含む結果はベースラインにしない
+        compareOk = allPassed && writeJsonFile(comparePath, bench.results, opt, isaName, machine, core, allPassed);
+        if (compareOk)
+            std::fprintf(stderr, "baseline written: %s\n", comparePath.c_str());
+    } else if (!comparePath.empty()) {
+        const int regressions = compareWithBaseline(juce::File::getCurrentWorkingDirectory().getChildFile(comparePath),
+                                                    bench.results, tolerancePct);
+        compareOk = (regressions == 0);
+    }
+
+    std::fprintf(stderr, "=== %s ===\n", (allPassed && compareOk) ? "ALL PASSED" : "SOME FAILED");
+
+    juce::shutdownJuce_GUI();
+    return (allPassed && compareOk) ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+//==============================================================================
+// CpuCostModelTests.cpp
+//
+// convo::predictCallbackCost / suggestCpuCostDowngrade (audioengine/CpuCostModel.h) のテスト。
+//   1. 未計測 (valid == false) の係数では Unknown を返し、周期だけは埋まること
+//   2. IR 長・ブロック長の log2 補間と上側外挿、True Stereo / Split-rate EQ / 1x OS の扱い
+//   3. 負荷の閾値で Ok / Warning / Overload が切り替わること
+//   4. 提案が OS 倍率 → バッファ長 → IR 長の順に下げ、収まらなければ achievable = false になること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#include "audioengine/CpuCostModel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+bool near(double a, double b, double tolerance = 1.0e-9)
+{
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+}
+
+// NUC は IR 長 4 倍ごとに +10 ns/sample、ブロック長補正は 64 で 2 倍・4096 で 0.5 倍
+convo::CpuCostCoefficients makeCoefficients()
+{
+    convo::CpuCostCoefficients c;
+    c.nucNsPerSample = { 10.0, 20.0, 30.0, 40.0, 50.0 };
+    c.nucBlockScale = { 2.0, 1.0, 0.75, 0.5 };
+    c.eqBaseNsPerSample = 1.0;
+    c.eqBandNsPerSample = 0.5;
+    for (auto& preset : c.oversamplingNsPerSample)
+        preset = { 20.0, 40.0, 80.0 };
+    c.outputNsPerSample = 5.0;
+    c.valid = true;
+    return c;
+}
+
+convo::CpuCostConfig makeConfig()
+{
+    convo::CpuCostConfig config;
+    config.sampleRate = 48000.0;
+    config.blockSize = 256;
+    config.oversamplingFactor = 1;
+    config.irLength = 1 << 16;
+    config.eqActive = false;
+    return config;
+}
+
+void testUncalibrated()
+{
+    convo::CpuCostCoefficients c = makeCoefficients();
+    c.valid = false;
+    const auto p = convo::predictCallbackCost(c, makeConfig());
+    check(p.verdict == convo::CpuCostPrediction::Verdict::Unknown, "uncalibrated is unknown");
+    check(near(p.periodUs, 1.0e6 * 256.0 / 48000.0), "period filled without coefficients");
+    check(p.totalUs == 0.0, "no cost without coefficients");
+
+    const auto s = convo::suggestCpuCostDowngrade(c, makeConfig());
+    check(!s.needed && !s.achievable, "no suggestion without coefficients");
+}
+
+void testComponents()
+{
+    const auto c = makeCoefficients();
+    auto config = makeConfig();
+
+    // 2^16, ブロック 256: 30 ns × 256 × 2 本
+    auto p = convo::predictCallbackCost(c, config);
+    check(near(p.convolverUs, 30.0 * 256.0 * 2.0 * 1.0e-3), "convolver at grid point");
+    check(p.eqUs == 0.0 && p.oversamplingUs == 0.0, "inactive EQ and 1x OS cost nothing");
+    check(near(p.outputUs, 5.0 * 256.0 * 1.0e-3), "output stage");
+    check(near(p.totalUs, (p.convolverUs + p.outputUs) * convo::kCallbackOverheadFactor), "overhead applied");
+
+    // 2^15 は 2^14 と 2^16 の中間 (log2 軸で線形)
+    config.irLength = 1 << 15;
+    p = convo::predictCallbackCost(c, config);
+    check(near(p.convolverUs, 25.0 * 256.0 * 2.0 * 1.0e-3), "IR interpolated on log2 axis");
+
+    // 2^22 は最後の区間の傾きで外挿
+    config.irLength = 1 << 22;
+    p = convo::predictCallbackCost(c, config);
+    check(near(p.convolverUs, 60.0 * 256.0 * 2.0 * 1.0e-3), "IR extrapolated above the last point");
+
+    // True Stereo は NUC 4 本
+    config.irLength = 1 << 16;
+    config.trueStereo = true;
+    p = convo::predictCallbackCost(c, config);
+    check(near(p.convolverUs, 30.0 * 256.0 * 4.0 * 1.0e-3), "true stereo doubles the convolvers");
+    config.trueStereo = false;
+
+    // 4x: 処理ブロック 1024 → 補正 0.75、サンプル数 4 倍
+    config.oversamplingFactor = 4;
+    p = convo::predictCallbackCost(c, config);
+    check(near(p.convolverUs, 30.0 * 0.75 * 1024.0 * 2.0 * 1.0e-3), "block scale at processing block");
+    check(near(p.oversamplingUs, 40.0 * 256.0 * 1.0e-3), "oversampling per base sample");
+
+    // ブロック補正は範囲外で端に留める (8x × 1024 = 8192 → 0.5)
+    config.blockSize = 1024;
+    config.oversamplingFactor = 8;
+    p = convo::predictCallbackCost(c, config);
+    check(near(p.convolverUs, 30.0 * 0.5 * 8192.0 * 2.0 * 1.0e-3), "block scale clamped");
+
+    // EQ: 処理レート、Split-rate ならベースレート
+    config = makeConfig();
+    config.convolverActive = false;
+    config.oversamplingFactor = 4;
+    config.eqActive = true;
+    config.eqActiveBands = 10;
+    p = convo::predictCallbackCost(c, config);
+    check(p.convolverUs == 0.0, "bypassed convolver costs nothing");
+    check(near(p.eqUs, (1.0 + 0.5 * 10.0) * 1024.0 * 1.0e-3), "EQ at processing rate");
+    config.eqAtBaseRate = true;
+    p = convo::predictCallbackCost(c, config);
+    check(near(p.eqUs, (1.0 + 0.5 * 10.0) * 256.0 * 1.0e-3), "split-rate EQ at base rate");
+}
+
+void testVerdicts()
+{
+    convo::CpuCostCoefficients c {};
+    c.valid = true;
+    auto config = makeConfig();
+    config.convolverActive = false;
+    const double periodUs = 1.0e6 * 256.0 / 48000.0;
+
+    // 出力段だけで負荷を合わせる
+    const auto withLoad = [&](double load)
+    {
+        c.outputNsPerSample = load * periodUs * 1.0e3 / (256.0 * convo::kCallbackOverheadFactor);
+        return convo::predictCallbackCost(c, config);
+    };
+    check(withLoad(0.5).verdict == convo::CpuCostPrediction::Verdict::Ok, "50% is ok");
+    check(withLoad(0.75).verdict == convo::CpuCostPrediction::Verdict::Warning, "75% warns");
+    const auto overload = withLoad(0.95);
+    check(overload.verdict == convo::CpuCostPrediction::Verdict::Overload, "95% overloads");
+    check(overload.loadPermille() == 950, "load permille");
+}
+
+void testSuggestion()
+{
+    const auto c = makeCoefficients();
+
+    // 既に収まる構成は提案不要
+    auto s = convo::suggestCpuCostDowngrade(c, makeConfig());
+    check(!s.needed && s.achievable && s.config.oversamplingFactor == 1, "light config needs nothing");
+
+    // NUC が基準の 40 倍重い CPU で 8x / 2^20 / 64: OS を 2x へ下げれば収まる
+    auto slow = c;
+    for (auto& v : slow.nucNsPerSample)
+        v *= 40.0;
+    auto config = makeConfig();
+    config.blockSize = 64;
+    config.oversamplingFactor = 8;
+    config.irLength = 1 << 20;
+    const auto heavy = convo::predictCallbackCost(slow, config);
+    check(heavy.verdict == convo::CpuCostPrediction::Verdict::Overload, "heavy config overloads");
+    s = convo::suggestCpuCostDowngrade(slow, config);
+    check(s.needed && s.achievable, "heavy config has a suggestion");
+    check(s.prediction.verdict == convo::CpuCostPrediction::Verdict::Ok, "suggestion fits");
+    check(s.config.oversamplingFactor == 2 && s.config.blockSize == 64, "oversampling lowered before buffer");
+    check(s.config.irLength == (1 << 18), "IR follows the processing rate");
+
+    // さらに 5 倍重いと OS 1x でも溢れる → バッファを伸ばす
+    for (auto& v : slow.nucNsPerSample)
+        v *= 5.0;
+    config = makeConfig();
+    config.blockSize = 64;
+    s = convo::suggestCpuCostDowngrade(slow, config);
+    check(s.needed && s.achievable, "slower config has a suggestion");
+    check(s.config.oversamplingFactor == 1 && s.config.blockSize == 256 && s.config.irLength == (1 << 16),
+          "buffer grown when OS is already 1x");
+
+    // どこまで下げても収まらない
+    auto hopeless = c;
+    hopeless.outputNsPerSample = 1.0e6;
+    s = convo::suggestCpuCostDowngrade(hopeless, makeConfig());
+    check(s.needed && !s.achievable, "hopeless config is not achievable");
+    check(s.config.blockSize == convo::kMaxSuggestedBlockSize && s.config.irLength == convo::kMinSuggestedIrLength,
+          "every step exhausted");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[CpuCostModelTests] Start\n";
+    testUncalibrated();
+    testComponents();
+    testVerdicts();
+    testSuggestion();
+    std::cout << "[CpuCostModelTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
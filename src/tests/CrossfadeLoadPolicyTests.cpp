@@ -0,0 +1,122 @@
+//==============================================================================
+// CrossfadeLoadPolicyTests.cpp
+//
+// convo::selectCrossfadeForLoad (audioengine/RuntimePolicyEngine.h) のテスト。
+//   1. 余裕がある負荷では要求どおりのフェード長を返すこと
+//   2. 閾値間では負荷に対して単調に短縮され、下限を割らないこと
+//   3. 高負荷では二重処理を伴わない FadeInOnly に切り替わること
+//   4. 下限以下の要求は短縮しないこと / 判断に用いた負荷が記録されること
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "audioengine/RuntimePolicyEngine.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+bool nearlyEqual(double a, double b)
+{
+    return std::abs(a - b) < 1e-9;
+}
+
+constexpr double kRequestedSec = 0.030;
+
+// constexpr で評価できること（Orchestrator 以外からも定数として使えるように）
+static_assert(convo::selectCrossfadeForLoad(kRequestedSec, 0).mode == convo::CrossfadeLoadMode::Full);
+static_assert(convo::selectCrossfadeForLoad(kRequestedSec, 1000).mode == convo::CrossfadeLoadMode::FadeInOnly);
+
+void testHeadroomKeepsRequestedFade()
+{
+    for (const uint16_t load : { uint16_t{0}, uint16_t{200}, convo::kCrossfadeLoadShortenPermille })
+    {
+        const auto d = convo::selectCrossfadeForLoad(kRequestedSec, load);
+        check(d.mode == convo::CrossfadeLoadMode::Full, "headroom: mode Full at " + std::to_string(load));
+        check(nearlyEqual(d.fadeTimeSec, kRequestedSec), "headroom: fade unchanged at " + std::to_string(load));
+    }
+}
+
+void testPressureShortensMonotonically()
+{
+    double previous = kRequestedSec;
+    for (uint16_t load = convo::kCrossfadeLoadShortenPermille + 1;
+         load < convo::kCrossfadeLoadFadeInOnlyPermille; ++load)
+    {
+        const auto d = convo::selectCrossfadeForLoad(kRequestedSec, load);
+        if (d.mode != convo::CrossfadeLoadMode::Shortened)
+        {
+            check(false, "pressure: mode Shortened at " + std::to_string(load));
+            return;
+        }
+        if (d.fadeTimeSec > previous || d.fadeTimeSec < convo::kMinAdaptiveCrossfadeSec || d.fadeTimeSec >= kRequestedSec)
+        {
+            check(false, "pressure: monotonic and bounded at " + std::to_string(load));
+            return;
+        }
+        previous = d.fadeTimeSec;
+    }
+    check(true, "pressure: shortened, monotonic and bounded across the band");
+
+    const uint16_t mid = (convo::kCrossfadeLoadShortenPermille + convo::kCrossfadeLoadFadeInOnlyPermille) / 2;
+    const auto d = convo::selectCrossfadeForLoad(kRequestedSec, mid);
+    check(nearlyEqual(d.fadeTimeSec, (kRequestedSec + convo::kMinAdaptiveCrossfadeSec) / 2.0),
+          "pressure: linear interpolation at midpoint");
+}
+
+void testOverloadSwitchesToFadeInOnly()
+{
+    for (const uint16_t load : { convo::kCrossfadeLoadFadeInOnlyPermille, uint16_t{900}, uint16_t{2000} })
+    {
+        const auto d = convo::selectCrossfadeForLoad(kRequestedSec, load);
+        check(d.mode == convo::CrossfadeLoadMode::FadeInOnly, "overload: FadeInOnly at " + std::to_string(load));
+        check(d.fadeTimeSec == 0.0, "overload: no crossfade length at " + std::to_string(load));
+    }
+
+    // 下限以下の短いフェードでも、二重処理に耐えない負荷なら FadeInOnly
+    const auto shortFade = convo::selectCrossfadeForLoad(0.002, 800);
+    check(shortFade.mode == convo::CrossfadeLoadMode::FadeInOnly, "overload: short fade still avoided");
+}
+
+void testShortRequestAndLoadRecord()
+{
+    const auto d = convo::selectCrossfadeForLoad(0.003, 550);
+    check(d.mode == convo::CrossfadeLoadMode::Full, "short request: not shortened below the floor");
+    check(nearlyEqual(d.fadeTimeSec, 0.003), "short request: fade unchanged");
+    check(d.loadPermille == 550, "record: decision carries the load it was based on");
+
+    check(std::string(convo::crossfadeLoadModeName(convo::CrossfadeLoadMode::Shortened)) == "Shortened",
+          "name: Shortened");
+    check(std::string(convo::crossfadeLoadModeName(convo::CrossfadeLoadMode::FadeInOnly)) == "FadeInOnly",
+          "name: FadeInOnly");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[CrossfadeLoadPolicyTests] Start\n";
+    testHeadroomKeepsRequestedFade();
+    testPressureShortensMonotonically();
+    testOverloadSwitchesToFadeInOnly();
+    testShortRequestAndLoadRecord();
+    std::cout << "[CrossfadeLoadPolicyTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+//==============================================================================
+// CrossfadeScopePolicyTests.cpp
+//
+// convo::selectCrossfadeScope (audioengine/RuntimePolicyEngine.h) のテスト。
+//   1. 前提がそろえば Convolver 段スコープを採用すること
+//   2. WholeDsp の要求は常に WholeDsp のままであること
+//   3. 処理構成の不一致・Convolver 遅延の不一致では WholeDsp へ戻すこと
+//   4. fade-in (warm-up) の 2 倍に満たないフェードでは WholeDsp へ戻すこと
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "audioengine/RuntimePolicyEngine.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr int kWarmupSamples = 2048;   // DSPCore::FADE_IN_SAMPLES
+
+constexpr convo::ConvolverStageShareInputs makeShareableInputs() noexcept
+{
+    convo::ConvolverStageShareInputs in;
+    in.sameProcessingLayout = true;
+    in.oldConvolverLatencySamples = 512;
+    in.newConvolverLatencySamples = 512;
+    in.fadeSamples = 4800;             // 100 ms @ 48 kHz
+    in.warmupSamples = kWarmupSamples;
+    return in;
+}
+
+static_assert(convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, makeShareableInputs())
+              == convo::CrossfadeScope::ConvolverStage);
+
+void testShareableTransitionUsesStageScope()
+{
+    const auto scope = convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, makeShareableInputs());
+    check(scope == convo::CrossfadeScope::ConvolverStage, "shareable: ConvolverStage");
+    check(std::string(convo::crossfadeScopeName(scope)) == "ConvolverStage", "name: ConvolverStage");
+}
+
+void testWholeDspRequestIsKept()
+{
+    const auto scope = convo::selectCrossfadeScope(convo::CrossfadeScope::WholeDsp, makeShareableInputs());
+    check(scope == convo::CrossfadeScope::WholeDsp, "whole request: stays WholeDsp");
+    check(std::string(convo::crossfadeScopeName(scope)) == "WholeDsp", "name: WholeDsp");
+}
+
+void testMismatchFallsBackToWholeDsp()
+{
+    auto layout = makeShareableInputs();
+    layout.sameProcessingLayout = false;
+    check(convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, layout) == convo::CrossfadeScope::WholeDsp,
+          "mismatch: processing layout");
+
+    auto latency = makeShareableInputs();
+    latency.newConvolverLatencySamples = latency.oldConvolverLatencySamples + 1;
+    check(convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, latency) == convo::CrossfadeScope::WholeDsp,
+          "mismatch: convolver latency (new longer)");
+
+    latency.newConvolverLatencySamples = latency.oldConvolverLatencySamples - 1;
+    check(convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, latency) == convo::CrossfadeScope::WholeDsp,
+          "mismatch: convolver latency (new shorter)");
+
+    // 既定値 (DSPCore を解決できなかった場合) は共有しない
+    check(convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, convo::ConvolverStageShareInputs {})
+              == convo::CrossfadeScope::WholeDsp,
+          "mismatch: unresolved DSPCore");
+}
+
+void testShortFadeFallsBackToWholeDsp()
+{
+    auto in = makeShareableInputs();
+    in.fadeSamples = kWarmupSamples * 2 - 1;
+    check(convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, in) == convo::CrossfadeScope::WholeDsp,
+          "short fade: below twice the warm-up");
+
+    in.fadeSamples = kWarmupSamples * 2;
+    check(convo::selectCrossfadeScope(convo::CrossfadeScope::ConvolverStage, in) == convo::CrossfadeScope::ConvolverStage,
+          "short fade: exactly twice the warm-up");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[CrossfadeScopePolicyTests] Start\n";
+    testShareableTransitionUsesStageScope();
+    testWholeDspRequestIsKept();
+    testMismatchFallsBackToWholeDsp();
+    testShortFadeFallsBackToWholeDsp();
+    std::cout << "[CrossfadeScopePolicyTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,279 @@
+//==============================================================================
+// DeviceOutputCodecTests.cpp
+//
+// convo::output::deviceIntegerCodeGain (audioengine/DeviceOutputCodec.h) の単体テスト。
+//   1. 補正なしでは JUCE ASIO の変換 (× (2^(D-1) - 1)) で -6 dBFS 以上のコードが 1 LSB ずれること
+//   2. 補正ゲインを掛けると 16 / 24 bit デバイスで全コード (24 bit は端と乱数標本) が
+//      ディザの格子 k / 2^(b-1) から k·2^(D-b) へ正確に戻ること (float 直書き・double → float の両経路)
+//   3. 融合出力段 (runFusedOutputStage<true, ...>) を通しても同じであること
+//   4. float / 32 bit / ASIO 以外 / ディザ無効 / ディザ語長 > デバイスでは補正しないこと
+//   5. writeInterleavedPcm (WASAPI 排他の直接書き込み) がディザの格子を補正なしで各ネイティブ形式の
+//      コードへ正確に載せ、飽和・無音チャンネル・インターリーブ配置を守り、readInterleavedPcm で戻ること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "audioengine/DeviceOutputCodec.h"
+#include "audioengine/FusedOutputStage.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::output::asioIntegerCode;
+using convo::output::deviceIntegerCodeGain;
+
+// ディザ後の値 (b bit の格子) → 期待するデバイスコード
+double ditheredValue(std::int32_t k, int ditherBits)
+{
+    return std::ldexp(static_cast<double>(k), -(ditherBits - 1));
+}
+
+// code の集合: |k| <= 2^(b-1) - 1 (JUCE が負の最小値をクランプするため -2^(b-1) は除く)
+std::vector<std::int32_t> codesFor(int ditherBits)
+{
+    const std::int32_t maxCode = (1 << (ditherBits - 1)) - 1;
+    std::vector<std::int32_t> codes;
+    if (ditherBits <= 16)
+    {
+        for (std::int32_t k = -maxCode; k <= maxCode; ++k)
+            codes.push_back(k);
+        return codes;
+    }
+
+    for (std::int32_t k = -maxCode; k <= -maxCode + 4096; ++k) codes.push_back(k);
+    for (std::int32_t k = maxCode - 4096; k <= maxCode; ++k) codes.push_back(k);
+    for (std::int32_t k = -4096; k <= 4096; ++k) codes.push_back(k);
+    std::mt19937 rng(24);
+    std::uniform_int_distribution<std::int32_t> dist(-maxCode, maxCode);
+    for (int i = 0; i < 200000; ++i)
+        codes.push_back(dist(rng));
+    return codes;
+}
+
+std::string pairLabel(const char* what, int deviceBits, int ditherBits)
+{
+    return std::string(what) + " device=" + std::to_string(deviceBits) + " dither=" + std::to_string(ditherBits);
+}
+
+void testUncorrectedDriftsByOneLsb()
+{
+    for (const int bits : { 16, 24 })
+    {
+        int mismatches = 0;
+        int mismatchesBelowHalfScale = 0;
+        for (const std::int32_t k : codesFor(bits))
+        {
+            const float v = static_cast<float>(ditheredValue(k, bits));
+            if (asioIntegerCode(v, bits) != k)
+            {
+                ++mismatches;
+                if (std::abs(k) < (1 << (bits - 2)))
+                    ++mismatchesBelowHalfScale;
+            }
+        }
+        check(mismatches > 0, pairLabel("uncorrected output misses codes above -6 dBFS", bits, bits));
+        check(mismatchesBelowHalfScale == 0, pairLabel("uncorrected output is exact below -6 dBFS", bits, bits));
+    }
+}
+
+void testCorrectedCodesAreExact()
+{
+    const int pairs[][2] { { 16, 16 }, { 24, 24 }, { 24, 16 } };
+    for (const auto& pair : pairs)
+    {
+        const int deviceBits = pair[0];
+        const int ditherBits = pair[1];
+        const double gain = deviceIntegerCodeGain(deviceBits, ditherBits);
+        const std::int32_t shift = 1 << (deviceBits - ditherBits);
+
+        bool floatExact = true;
+        bool doubleExact = true;
+        for (const std::int32_t k : codesFor(ditherBits))
+        {
+            const double corrected = ditheredValue(k, ditherBits) * gain;
+            // float 経路: 融合段が float へ直接書く / double 経路: AudioProcessorPlayer が double → float
+            const float direct = static_cast<float>(corrected);
+            const double viaDouble = corrected;
+            floatExact = floatExact && asioIntegerCode(direct, deviceBits) == k * shift;
+            doubleExact = doubleExact && asioIntegerCode(static_cast<float>(viaDouble), deviceBits) == k * shift;
+        }
+        check(floatExact, pairLabel("corrected float output maps to the exact device code", deviceBits, ditherBits));
+        check(doubleExact, pairLabel("corrected double output maps to the exact device code", deviceBits, ditherBits));
+    }
+}
+
+void testThroughFusedStage()
+{
+    constexpr int kBits = 24;
+    constexpr double kHeadroom = 0.8912509381337456;
+    const double gain = deviceIntegerCodeGain(kBits, kBits);
+
+    std::mt19937 rng(7);
+    const std::int32_t maxCode = static_cast<std::int32_t>(kHeadroom * 8388608.0);
+    std::uniform_int_distribution<std::int32_t> dist(-maxCode, maxCode);
+    std::vector<std::int32_t> codesL(1027), codesR(1027);
+    std::vector<double> srcL(1027), srcR(1027);
+    for (size_t i = 0; i < srcL.size(); ++i)
+    {
+        codesL[i] = dist(rng);
+        codesR[i] = dist(rng);
+        srcL[i] = ditheredValue(codesL[i], kBits);
+        srcR[i] = ditheredValue(codesR[i], kBits);
+    }
+
+    convo::output::FusedOutputParams params;
+    params.gain = gain;
+    params.limit = kHeadroom * gain;
+    convo::output::FusedOutputDelay noDelay;
+    std::vector<float> dstL(srcL.size()), dstR(srcR.size());
+    convo::output::runFusedOutputStage<true, false>(srcL.data(), srcR.data(), dstL.data(), dstR.data(),
+                                                    static_cast<int>(srcL.size()), params, noDelay);
+
+    bool exact = true;
+    for (size_t i = 0; i < srcL.size(); ++i)
+        exact = exact && asioIntegerCode(dstL[i], kBits) == codesL[i] && asioIntegerCode(dstR[i], kBits) == codesR[i];
+    check(exact, "fused output stage with the code gain keeps every 24-bit code");
+
+    // ヘッドルームちょうどの値は広げた上限でクランプされない
+    const double atLimit = ditheredValue(maxCode, kBits);
+    float out = 0.0f;
+    convo::output::runFusedOutputStage<true, false, float>(&atLimit, nullptr, &out, nullptr, 1, params, noDelay);
+    check(asioIntegerCode(out, kBits) == maxCode, "widened limit does not clip codes at the headroom");
+}
+
+void testNoCorrectionCases()
+{
+    check(deviceIntegerCodeGain(0, 24) == 1.0, "float or unknown device: no correction");
+    check(deviceIntegerCodeGain(24, 0) == 1.0, "dither off: no correction");
+    check(deviceIntegerCodeGain(16, 24) == 1.0, "dither longer than the device word: no correction");
+    check(convo::output::deviceIntegerBitsFor(true, 32) == 0, "32-bit ASIO (int32 or float32) is not corrected");
+    check(convo::output::deviceIntegerBitsFor(false, 24) == 0, "non-ASIO devices are not corrected");
+    check(convo::output::deviceIntegerBitsFor(true, 24) == 24 && convo::output::deviceIntegerBitsFor(true, 16) == 16,
+          "16 / 24-bit ASIO devices are corrected");
+    check(deviceIntegerCodeGain(24, 24) == 8388608.0 / 8388607.0, "24-bit gain is 2^23 / (2^23 - 1)");
+}
+
+void testNativePcmPacking()
+{
+    using convo::output::PcmSampleFormat;
+    using convo::output::pcmIntegerCode;
+    using convo::output::readInterleavedPcm;
+    using convo::output::writeInterleavedPcm;
+
+    // ディザ後の値はデバイス語長のコードへそのまま載る (ASIO の × (2^(D-1) - 1) と違い補正不要)
+    bool exact16 = true;
+    for (std::int32_t k : codesFor(16))
+        exact16 = exact16 && pcmIntegerCode(static_cast<float>(ditheredValue(k, 16)), 16) == k;
+    check(exact16, "16-bit dithered codes land exactly on a 16-bit device");
+    bool exact24 = true;
+    for (std::int32_t k : codesFor(24))
+        exact24 = exact24 && pcmIntegerCode(static_cast<float>(ditheredValue(k, 24)), 24) == k;
+    check(exact24, "24-bit dithered codes land exactly on a 24-bit device");
+    bool exact32 = true;
+    for (std::int32_t k : codesFor(24))
+        exact32 = exact32 && pcmIntegerCode(static_cast<float>(ditheredValue(k, 24)), 32) == k * 256;
+    check(exact32, "24-bit dithered codes land on k * 2^8 on a 32-bit device");
+    bool exact16On24 = true;
+    for (std::int32_t k : codesFor(16))
+        exact16On24 = exact16On24 && pcmIntegerCode(static_cast<float>(ditheredValue(k, 16)), 24) == k * 256;
+    check(exact16On24, "16-bit dither on a 24-bit device lands on k * 2^8");
+
+    check(pcmIntegerCode(1.0f, 16) == 32767 && pcmIntegerCode(2.0f, 24) == 8388607, "positive full scale saturates");
+    check(pcmIntegerCode(-1.0f, 16) == -32768 && pcmIntegerCode(-4.0f, 32) == INT32_MIN, "negative full scale reaches the minimum code");
+    check(pcmIntegerCode(std::nanf(""), 24) == 0, "NaN writes silence");
+
+    // 2 ソース → 3 デバイスチャンネル (中央は無音)、各形式で書いて読み戻す
+    constexpr int kFrames = 5;
+    const float left[kFrames]  = { 0.5f, -0.25f, 0.0f, 1.0f, -1.0f };
+    const float right[kFrames] = { -0.5f, 0.125f, 0.75f, -0.0625f, 0.25f };
+    const float* sources[] = { left, right };
+    const int sourceMap[] = { 0, -1, 1 };
+
+    const PcmSampleFormat formats[] = { PcmSampleFormat::Float32, PcmSampleFormat::Int16, PcmSampleFormat::Int24Packed,
+                                        PcmSampleFormat::Int24In32, PcmSampleFormat::Int32 };
+    for (PcmSampleFormat format : formats)
+    {
+        const int bytes = convo::output::pcmBytesPerSample(format);
+        std::vector<unsigned char> device(static_cast<size_t>(3 * kFrames * bytes), 0xAB);
+        writeInterleavedPcm(sources, sourceMap, 3, kFrames, format, device.data());
+
+        std::vector<float> backL(kFrames), backMid(kFrames), backR(kFrames);
+        float* dests[] = { backL.data(), backMid.data(), backR.data() };
+        const int deviceMap[] = { 0, 1, 2 };
+        readInterleavedPcm(device.data(), format, 3, kFrames, dests, deviceMap, 3);
+
+        const float tolerance = (format == PcmSampleFormat::Float32) ? 0.0f
+                              : static_cast<float>(std::ldexp(1.0, -(convo::output::pcmValidBits(format) - 1)));
+        bool roundTrip = true;
+        bool silentMid = true;
+        for (int i = 0; i < kFrames; ++i)
+        {
+            roundTrip = roundTrip && std::fabs(backL[static_cast<size_t>(i)] - left[i]) <= tolerance
+                                  && std::fabs(backR[static_cast<size_t>(i)] - right[i]) <= tolerance;
+            silentMid = silentMid && backMid[static_cast<size_t>(i)] == 0.0f;
+        }
+        const std::string tag = "format " + std::to_string(static_cast<int>(format));
+        check(roundTrip, tag + ": interleaved write reads back within one LSB");
+        check(silentMid, tag + ": unmapped device channel is silent");
+    }
+
+    // Int24In32 は下位 8 bit が 0、Int24Packed は 3 byte 詰め
+    {
+        const float one[] = { 0.5f };
+        const float* src[] = { one };
+        const int map[] = { 0 };
+        unsigned char in32[4] = {};
+        writeInterleavedPcm(src, map, 1, 1, PcmSampleFormat::Int24In32, in32);
+        check(in32[0] == 0 && in32[1] == 0 && in32[2] == 0 && in32[3] == 0x40, "Int24In32 puts the code in the upper 24 bits");
+        unsigned char packed[3] = {};
+        writeInterleavedPcm(src, map, 1, 1, PcmSampleFormat::Int24Packed, packed);
+        check(packed[0] == 0 && packed[1] == 0 && packed[2] == 0x40, "Int24Packed writes 3 little-endian bytes");
+    }
+
+    // 読み側: マップ外のチャンネルは 0 で埋める
+    {
+        const std::int16_t frames[] = { 16384, -16384 };
+        std::vector<float> a(1, 9.0f), b(1, 9.0f);
+        float* dests[] = { a.data(), b.data() };
+        const int map[] = { 1, -1 };
+        readInterleavedPcm(frames, PcmSampleFormat::Int16, 2, 1, dests, map, 2);
+        check(a[0] == -0.5f && b[0] == 0.0f, "readInterleavedPcm picks the mapped channel and zero-fills the rest");
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[DeviceOutputCodecTests] Start\n";
+    testUncorrectedDriftsByOneLsb();
+    testCorrectedCodesAreExact();
+    testThroughFusedStage();
+    testNoCorrectionCases();
+    testNativePcmPacking();
+    std::cout << "[DeviceOutputCodecTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
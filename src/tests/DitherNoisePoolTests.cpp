@@ -0,0 +1,171 @@
+//==============================================================================
+// DitherNoisePoolTests.cpp
+//
+// convo::dsp::DitherNoisePool (dsp/DitherNoisePool.h) の単体テスト。
+//   1. prepare 直後はチャンネルごとに満杯で、値は単位 TPDF の範囲 (-1, 1) に収まること
+//   2. 同じシードなら、読み出しの分割・補充のタイミング・リングの折り返しに関係なく同じ列になること
+//   3. 枯渇時は不足分をフォールバックで埋めて underrun を数え、補充後はプールから読めること
+//   4. 分布が TPDF (平均 0、分散 1/6) であること
+//   5. fillUnitTpdf は pool が無ければ自前の乱数を順に呼ぶこと
+// を検証する。MKL (VSL) をリンクする。
+//==============================================================================
+#include "dsp/DitherNoisePool.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using convo::dsp::DitherNoisePool;
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+bool inUnitRange(const std::vector<double>& values)
+{
+    for (const double v : values)
+        if (!(v > -1.0 && v < 1.0))
+            return false;
+    return true;
+}
+
+// chunkSizes を巡回しながら total 個読む。refillEvery チャンクごとに補充する (0 なら補充しない)
+std::vector<double> drain(DitherNoisePool& pool, int channel, int total, const std::vector<int>& chunkSizes, int refillEvery)
+{
+    std::vector<double> out(static_cast<size_t>(total));
+    int offset = 0;
+    int chunkIndex = 0;
+    while (offset < total)
+    {
+        const int n = std::min(chunkSizes[static_cast<size_t>(chunkIndex) % chunkSizes.size()], total - offset);
+        pool.read(channel, out.data() + offset, n);
+        offset += n;
+        ++chunkIndex;
+        if (refillEvery > 0 && (chunkIndex % refillEvery) == 0)
+            pool.refillNonRt();
+    }
+    return out;
+}
+
+void testPrepareFillsPool()
+{
+    auto pool = std::make_unique<DitherNoisePool>();
+    pool->prepare(1234u);
+    check(pool->getAvailable(0) == DitherNoisePool::kPoolSize, "channel 0 is full after prepare");
+    check(pool->getAvailable(1) == DitherNoisePool::kPoolSize, "channel 1 is full after prepare");
+
+    std::vector<double> values(4096);
+    check(pool->read(0, values.data(), 4096) == 4096, "read is served entirely from the pool");
+    check(inUnitRange(values), "values lie in (-1, 1)");
+    check(pool->getAvailable(0) == DitherNoisePool::kPoolSize - 4096u, "read advances the consumer position");
+    check(pool->getUnderrunCount() == 0u, "no underrun while the pool has data");
+
+    std::vector<double> right(4096);
+    pool->read(1, right.data(), 4096);
+    check(values != right, "channels use independent streams");
+}
+
+void testSequenceIsIndependentOfChunking()
+{
+    // 2.5 周分を読む。補充を挟むので枯渇しない
+    const int total = static_cast<int>(DitherNoisePool::kPoolSize) * 5 / 2;
+    auto a = std::make_unique<DitherNoisePool>();
+    auto b = std::make_unique<DitherNoisePool>();
+    a->prepare(42u);
+    b->prepare(42u);
+
+    const auto seqA = drain(*a, 0, total, { 256 }, 64);
+    const auto seqB = drain(*b, 0, total, { 1, 7, 255, 33, 1024, 3 }, 97);
+    check(seqA == seqB, "same seed yields the same sequence across chunking, refills and wrap-around");
+    check(a->getUnderrunCount() == 0u && b->getUnderrunCount() == 0u, "interleaved refills prevent underruns");
+}
+
+void testUnderrunFallsBackAndRecovers()
+{
+    auto pool = std::make_unique<DitherNoisePool>();
+    pool->prepare(7u);
+
+    const int total = static_cast<int>(DitherNoisePool::kPoolSize) + 100;
+    std::vector<double> values(static_cast<size_t>(total));
+    const int fromPool = pool->read(0, values.data(), total);
+    check(fromPool == static_cast<int>(DitherNoisePool::kPoolSize), "read returns only what the pool holds");
+    check(pool->getUnderrunCount() == 1u, "shortfall is counted as one underrun");
+    check(inUnitRange(values), "fallback fills the shortfall with TPDF values");
+
+    bool fallbackVaries = false;
+    for (int i = fromPool + 1; i < total; ++i)
+        fallbackVaries = fallbackVaries || (values[static_cast<size_t>(i)] != values[static_cast<size_t>(fromPool)]);
+    check(fallbackVaries, "fallback is not a constant");
+
+    pool->refillNonRt();
+    check(pool->getAvailable(0) == DitherNoisePool::kPoolSize, "refill restores a drained channel");
+    check(pool->getAvailable(1) == DitherNoisePool::kPoolSize, "refill leaves a full channel full");
+    std::vector<double> after(256);
+    check(pool->read(0, after.data(), 256) == 256, "pool serves reads again after refill");
+}
+
+void testDistribution()
+{
+    auto pool = std::make_unique<DitherNoisePool>();
+    pool->prepare(99u);
+
+    const int n = static_cast<int>(DitherNoisePool::kPoolSize);
+    std::vector<double> values(static_cast<size_t>(n));
+    pool->read(1, values.data(), n);
+
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (const double v : values)
+    {
+        sum += v;
+        sumSq += v * v;
+    }
+    const double mean = sum / n;
+    const double variance = sumSq / n - mean * mean;
+    check(std::abs(mean) < 0.01, "TPDF mean is close to 0");
+    check(std::abs(variance - 1.0 / 6.0) < 0.005, "TPDF variance is close to 1/6");
+}
+
+void testFillWithoutPool()
+{
+    int calls = 0;
+    double dest[5] {};
+    convo::dsp::fillUnitTpdf(nullptr, 0, dest, 5, [&calls]() noexcept { return 0.1 * ++calls; });
+    check(calls == 5 && dest[0] == 0.1 && dest[4] == 0.5, "fillUnitTpdf without a pool consumes the own source in order");
+
+    auto pool = std::make_unique<DitherNoisePool>();
+    pool->prepare(5u);
+    calls = 0;
+    convo::dsp::fillUnitTpdf(pool.get(), 1, dest, 5, [&calls]() noexcept { return 0.1 * ++calls; });
+    check(calls == 0 && pool->getAvailable(1) == DitherNoisePool::kPoolSize - 5u, "fillUnitTpdf with a pool reads from it");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[DitherNoisePoolTests] Start\n";
+    testPrepareFillsPool();
+    testSequenceIsIndependentOfChunking();
+    testUnderrunFallsBackAndRecovers();
+    testDistribution();
+    testFillWithoutPool();
+    std::cout << "[DitherNoisePoolTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
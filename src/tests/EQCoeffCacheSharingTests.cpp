@@ -0,0 +1,175 @@
+//==============================================================================
+// EQCoeffCacheSharingTests.cpp
+//
+// EQCoeffCache のバンド単位流用 (EQCoeffBandReuse) と、流用元キャッシュの参照順序のテスト。
+//   1. 1 バンドだけ変えた場合は残り 19 バンドが流用され、変えたバンドだけが計算対象になること
+//   2. channelMode だけの変更は係数に影響しないため全バンドが流用されること
+//   3. base なし / サンプルレート不一致では流用しないこと、無効バンドは流用しないこと
+//   4. 2 世代の CacheMap が共有するキャッシュを構築中に pin した場合、map が両方手放しても
+//      pin の release まで retire されず、retire 後も回収 (epoch 進行) まで解放されないこと
+//   5. pin より先に map が手放しきったキャッシュは tryAddRef できず、流用元にならないこと
+// を検証する。map / pin の操作は AudioEngine::EQCacheManager::getOrCreate と同じ順序で行う。JUCE 非依存。
+//==============================================================================
+#include "eqprocessor/EQCoeffBandReuse.h"
+#include "RefCountedDeferred.h"
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr int kBands = 20;
+constexpr double kSampleRate = 48000.0;
+
+//==============================================================================
+// retire を即時実行せず保留し、reclaim() で初めて deleter を呼ぶ Router (epoch 回収の代役)
+//==============================================================================
+class DeferredRouter final : public convo::IRetireRouter
+{
+public:
+    bool retireRT(void* ptr, void (*deleter)(void*)) noexcept override
+    {
+        pending.emplace_back(ptr, deleter);
+        return true;
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) noexcept override
+    {
+        pending.emplace_back(ptr, deleter);
+    }
+
+    void reclaim() noexcept
+    {
+        for (auto& entry : pending)
+            entry.second(entry.first);
+        pending.clear();
+    }
+
+    std::vector<std::pair<void*, void (*)(void*)>> pending;
+};
+
+int g_liveCaches = 0;
+
+struct FakeCache : public RefCountedDeferred<FakeCache>
+{
+    FakeCache() { ++g_liveCaches; }
+    ~FakeCache() { --g_liveCaches; }
+};
+
+void testSingleBandEdit()
+{
+    convo::EQParameters base;
+    convo::EQParameters edited = base;
+    edited.bands[7].gain = 3.0f;
+
+    bool reuse[kBands];
+    const int numReused = EQCoeffBandReuse::planReuse(edited.bands.data(), base.bands.data(),
+                                                      kSampleRate, kSampleRate, kBands, reuse);
+    check(numReused == kBands - 1, "single band edit reuses the other 19 bands");
+    check(!reuse[7], "edited band is recomputed");
+    check(reuse[0] && reuse[19], "untouched bands are reused");
+}
+
+void testChannelModeOnly()
+{
+    convo::EQParameters base;
+    convo::EQParameters edited = base;
+    edited.bands[3].channelMode = 2;
+
+    bool reuse[kBands];
+    const int numReused = EQCoeffBandReuse::planReuse(edited.bands.data(), base.bands.data(),
+                                                      kSampleRate, kSampleRate, kBands, reuse);
+    check(numReused == kBands, "channel mode change keeps every band's coefficients");
+}
+
+void testNoReuse()
+{
+    convo::EQParameters base;
+    convo::EQParameters edited = base;
+    edited.bands[5].enabled = false;
+
+    bool reuse[kBands];
+    check(EQCoeffBandReuse::planReuse(edited.bands.data(), nullptr, kSampleRate, 0.0, kBands, reuse) == 0,
+          "no base reuses nothing");
+    check(EQCoeffBandReuse::planReuse(edited.bands.data(), base.bands.data(), kSampleRate, 44100.0, kBands, reuse) == 0,
+          "sample rate mismatch reuses nothing");
+
+    const int numReused = EQCoeffBandReuse::planReuse(edited.bands.data(), base.bands.data(),
+                                                      kSampleRate, kSampleRate, kBands, reuse);
+    check(!reuse[5], "disabled band is not reused");
+    check(numReused == kBands - 1, "disabling one band leaves the others reused");
+}
+
+void testPinnedBaseOutlivesMaps()
+{
+    DeferredRouter router;
+    g_liveCaches = 0;
+
+    // 旧 map が作成時の参照を持ち、新 map はコピー時に addRef する (CacheMap のコピーと同じ)
+    auto* cache = new FakeCache();
+    cache->addRef();
+
+    // getOrCreate: 流用元を構築中だけ pin する
+    const bool pinned = cache->tryAddRef();
+    check(pinned, "live cache can be pinned as a reuse base");
+
+    // map の世代交代で両方の map が手放す
+    cache->release(router);
+    cache->release(router);
+    check(router.pending.empty(), "maps releasing a pinned base does not retire it");
+
+    // 構築が終わり pin を返すと、最後の参照としてここで retire される
+    cache->release(router);
+    check(router.pending.size() == 1, "releasing the pin retires the base exactly once");
+    check(g_liveCaches == 1, "retired base stays alive until reclaim");
+
+    router.reclaim();
+    check(g_liveCaches == 0, "reclaim frees the retired base");
+}
+
+void testReleasedBaseCannotBePinned()
+{
+    DeferredRouter router;
+    g_liveCaches = 0;
+
+    auto* cache = new FakeCache();
+    cache->release(router);
+    check(router.pending.size() == 1, "last map release retires the cache");
+
+    // 回収前に古い map から見つけても、参照 0 のキャッシュは流用元にしない
+    check(!cache->tryAddRef(), "retired cache cannot be pinned");
+
+    router.reclaim();
+    check(g_liveCaches == 0, "reclaim frees the unpinned cache");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[EQCoeffCacheSharingTests] Start\n";
+    testSingleBandEdit();
+    testChannelModeOnly();
+    testNoReuse();
+    testPinnedBaseOutlivesMaps();
+    testReleasedBaseCannotBePinned();
+    std::cout << "[EQCoeffCacheSharingTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,388 @@
+//==============================================================================
+// EQMidSideRoutingTests.cpp
+//
+// EQMidSideRouting (EQ の Mid/Side バンド経路) のテスト。
+//   1. L/R バンドに挟まれた単独の M/S バンドは従来のバンドごとのエンコードとビット一致すること
+//   2. 連続する M/S バンドのグループ処理は従来との差が 1e-12 (振幅 1 の入力に対する絶対誤差) 以内であること
+//   3. Parallel の M/S 経路は従来のバンドごとのエンコードとビット一致すること
+//   4. グループ境界が L/R/Stereo バンドで切れること
+// を検証する。バンドは飽和付き TPT SVF (EQProcessor::processBand と同じ形) を参照実装する。
+// 従来経路はバンドごとに エンコード → 1 成分処理 → デコード する。JUCE 非依存。
+//==============================================================================
+#include "eqprocessor/EQMidSideRouting.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr int kBlock = 256;
+constexpr int kBlocks = 8;
+constexpr double kGroupTolerance = 1.0e-12;
+
+enum class Mode { Stereo, Left, Right, Mid, Side };
+
+//==============================================================================
+// 飽和付き TPT SVF ベル (状態は L/R/M/S の 4 組)
+//==============================================================================
+struct Band {
+    Mode mode;
+    double g, k, a1, a2, a3, m0, m1, m2;
+    double state[4][2] {};
+};
+
+Band makeBell(Mode mode, double freqHz, double q, double gainDb, double sampleRate)
+{
+    Band b {};
+    b.mode = mode;
+    const double A = std::pow(10.0, gainDb / 40.0);
+    b.g = std::tan(kPi * freqHz / sampleRate);
+    b.k = 1.0 / (q * A);
+    b.a1 = 1.0 / (1.0 + b.g * (b.g + b.k));
+    b.a2 = b.g * b.a1;
+    b.a3 = b.g * b.a2;
+    b.m0 = 1.0;
+    b.m1 = b.k * (A * A - 1.0);
+    b.m2 = 0.0;
+    return b;
+}
+
+void processBand(Band& b, int stateSet, double* data, int length)
+{
+    double ic1 = b.state[stateSet][0];
+    double ic2 = b.state[stateSet][1];
+    for (int n = 0; n < length; ++n)
+    {
+        const double v0 = data[n];
+        const double v3 = v0 - ic2;
+        const double v1 = b.a1 * ic1 + b.a2 * v3;
+        const double v2 = ic2 + b.a2 * ic1 + b.a3 * v3;
+        ic1 = 2.0 * v1 - ic1;
+        ic2 = 2.0 * v2 - ic2;
+        const double y = b.m0 * v0 + b.m1 * v1 + b.m2 * v2;
+        data[n] = y / (1.0 + 0.05 * std::fabs(y)); // 飽和 (非線形にしてグループ化の影響を見えるようにする)
+    }
+    b.state[stateSet][0] = ic1;
+    b.state[stateSet][1] = ic2;
+}
+
+bool isMidSide(Mode m) { return m == Mode::Mid || m == Mode::Side; }
+
+void processLeftRight(Band& b, double* l, double* r, int length)
+{
+    if (b.mode == Mode::Stereo || b.mode == Mode::Left)
+        processBand(b, 0, l, length);
+    if (b.mode == Mode::Stereo || b.mode == Mode::Right)
+        processBand(b, 1, r, length);
+}
+
+//==============================================================================
+// Serial: 従来経路 (M/S バンドごとにエンコード / デコード)
+//==============================================================================
+void serialPerBand(std::vector<Band>& bands, double* l, double* r, double* msWork, int length)
+{
+    for (auto& b : bands)
+    {
+        if (!isMidSide(b.mode))
+        {
+            processLeftRight(b, l, r, length);
+            continue;
+        }
+        for (int n = 0; n < length; ++n)
+        {
+            msWork[n] = l[n];
+            msWork[n] += r[n];
+            msWork[n] *= 0.5;
+            msWork[length + n] = l[n];
+            msWork[length + n] -= r[n];
+            msWork[length + n] *= 0.5;
+        }
+        if (b.mode == Mode::Mid)
+            processBand(b, 2, msWork, length);
+        else
+            processBand(b, 3, msWork + length, length);
+        for (int n = 0; n < length; ++n)
+        {
+            l[n] = msWork[n] + msWork[length + n];
+            r[n] = msWork[n] - msWork[length + n];
+        }
+    }
+}
+
+// Serial: EQProcessor::process と同じグループ経路
+void serialGrouped(std::vector<Band>& bands, double* l, double* r, double* msWork, int length)
+{
+    const int count = static_cast<int>(bands.size());
+    for (int i = 0; i < count; ++i)
+    {
+        if (!isMidSide(bands[static_cast<size_t>(i)].mode))
+        {
+            processLeftRight(bands[static_cast<size_t>(i)], l, r, length);
+            continue;
+        }
+        const int end = EQMidSideRouting::groupEnd(i, count, [&](int g) { return isMidSide(bands[static_cast<size_t>(g)].mode); });
+        EQMidSideRouting::processSerialGroup(
+            l, r, msWork, length, i, end,
+            [&](int g) { return bands[static_cast<size_t>(g)].mode == Mode::Mid; },
+            [&](int g, double* component) {
+                auto& b = bands[static_cast<size_t>(g)];
+                processBand(b, b.mode == Mode::Mid ? 2 : 3, component, length);
+            });
+        i = end - 1;
+    }
+}
+
+//==============================================================================
+// Parallel: y = x + Σ (H_b·x - x)。M/S 以外は両経路で共通。
+//==============================================================================
+void accumulateLeftRight(std::vector<Band>& bands, const double* srcL, const double* srcR,
+                         double* work, double* accumL, double* accumR, int length)
+{
+    for (auto& b : bands)
+    {
+        if (isMidSide(b.mode))
+            continue;
+        if (b.mode == Mode::Stereo || b.mode == Mode::Left)
+        {
+            std::memcpy(work, srcL, sizeof(double) * static_cast<size_t>(length));
+            processBand(b, 0, work, length);
+            for (int n = 0; n < length; ++n)
+                accumL[n] += work[n] - srcL[n];
+        }
+        if (b.mode == Mode::Stereo || b.mode == Mode::Right)
+        {
+            std::memcpy(work, srcR, sizeof(double) * static_cast<size_t>(length));
+            processBand(b, 1, work, length);
+            for (int n = 0; n < length; ++n)
+                accumR[n] += work[n] - srcR[n];
+        }
+    }
+}
+
+void parallelPerBand(std::vector<Band>& bands, double* l, double* r, double* msWork, int length)
+{
+    const std::vector<double> srcL(l, l + length);
+    const std::vector<double> srcR(r, r + length);
+    std::vector<double> workL(static_cast<size_t>(length)), workR(static_cast<size_t>(length));
+    std::vector<double> accumL(static_cast<size_t>(length), 0.0), accumR(static_cast<size_t>(length), 0.0);
+    accumulateLeftRight(bands, srcL.data(), srcR.data(), workL.data(), accumL.data(), accumR.data(), length);
+
+    for (auto& b : bands)
+    {
+        if (!isMidSide(b.mode))
+            continue;
+        for (int n = 0; n < length; ++n)
+        {
+            msWork[n] = (srcL[static_cast<size_t>(n)] + srcR[static_cast<size_t>(n)]) * 0.5;
+            msWork[length + n] = (srcL[static_cast<size_t>(n)] - srcR[static_cast<size_t>(n)]) * 0.5;
+        }
+        if (b.mode == Mode::Mid)
+            processBand(b, 2, msWork, length);
+        else
+            processBand(b, 3, msWork + length, length);
+        for (int n = 0; n < length; ++n)
+        {
+            workL[static_cast<size_t>(n)] = msWork[n] + msWork[length + n];
+            workR[static_cast<size_t>(n)] = msWork[n] - msWork[length + n];
+        }
+        for (int n = 0; n < length; ++n)
+        {
+            accumL[static_cast<size_t>(n)] += workL[static_cast<size_t>(n)] - srcL[static_cast<size_t>(n)];
+            accumR[static_cast<size_t>(n)] += workR[static_cast<size_t>(n)] - srcR[static_cast<size_t>(n)];
+        }
+    }
+
+    for (int n = 0; n < length; ++n)
+    {
+        l[n] = srcL[static_cast<size_t>(n)] + accumL[static_cast<size_t>(n)];
+        r[n] = srcR[static_cast<size_t>(n)] + accumR[static_cast<size_t>(n)];
+    }
+}
+
+// Parallel: EQProcessor::process と同じ経路 (エンコードはブロック内で 1 回)
+void parallelShared(std::vector<Band>& bands, double* l, double* r, double* msWork, int length)
+{
+    const std::vector<double> srcL(l, l + length);
+    const std::vector<double> srcR(r, r + length);
+    std::vector<double> work(static_cast<size_t>(length));
+    std::vector<double> accumL(static_cast<size_t>(length), 0.0), accumR(static_cast<size_t>(length), 0.0);
+    accumulateLeftRight(bands, srcL.data(), srcR.data(), work.data(), accumL.data(), accumR.data(), length);
+
+    bool encoded = false;
+    for (auto& b : bands)
+    {
+        if (!isMidSide(b.mode))
+            continue;
+        if (!encoded)
+        {
+            EQMidSideRouting::encode(srcL.data(), srcR.data(), msWork, msWork + length, length);
+            encoded = true;
+        }
+        const bool isMid = (b.mode == Mode::Mid);
+        EQMidSideRouting::accumulateParallelBand(
+            srcL.data(), srcR.data(), msWork, msWork + length, work.data(),
+            accumL.data(), accumR.data(), length, isMid,
+            [&](double* component) { processBand(b, isMid ? 2 : 3, component, length); });
+    }
+
+    for (int n = 0; n < length; ++n)
+    {
+        l[n] = srcL[static_cast<size_t>(n)] + accumL[static_cast<size_t>(n)];
+        r[n] = srcR[static_cast<size_t>(n)] + accumR[static_cast<size_t>(n)];
+    }
+}
+
+//==============================================================================
+// 共通ドライバ: 同じバンド構成を 2 経路で kBlocks ブロック処理し、出力を返す
+//==============================================================================
+using Chain = void (*)(std::vector<Band>&, double*, double*, double*, int);
+
+void makeInput(std::vector<double>& l, std::vector<double>& r)
+{
+    const size_t total = static_cast<size_t>(kBlock) * kBlocks;
+    l.resize(total);
+    r.resize(total);
+    uint32_t seed = 0x1234567u;
+    for (size_t n = 0; n < total; ++n)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const double noise = (static_cast<double>(seed >> 8) / 16777216.0 - 0.5) * 0.2;
+        l[n] = 0.6 * std::sin(2.0 * kPi * 220.0 * static_cast<double>(n) / 48000.0) + noise;
+        r[n] = 0.4 * std::sin(2.0 * kPi * 1330.0 * static_cast<double>(n) / 48000.0) - noise;
+    }
+}
+
+void run(std::vector<Band> bands, Chain chain, std::vector<double>& l, std::vector<double>& r)
+{
+    makeInput(l, r);
+    std::vector<double> msWork(2 * static_cast<size_t>(kBlock));
+    for (int blk = 0; blk < kBlocks; ++blk)
+        chain(bands, l.data() + blk * kBlock, r.data() + blk * kBlock, msWork.data(), kBlock);
+}
+
+bool bitIdentical(const std::vector<double>& a, const std::vector<double>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), sizeof(double) * a.size()) == 0;
+}
+
+double maxAbsDiff(const std::vector<double>& a, const std::vector<double>& b)
+{
+    double m = 0.0;
+    for (size_t n = 0; n < a.size(); ++n)
+        m = std::max(m, std::fabs(a[n] - b[n]));
+    return m;
+}
+
+std::vector<Band> singleMidSideBetweenLeftRight(Mode midSide)
+{
+    return { makeBell(Mode::Left, 300.0, 0.9, 4.0, 48000.0),
+             makeBell(midSide, 1500.0, 1.4, -6.0, 48000.0),
+             makeBell(Mode::Right, 5000.0, 0.7, 3.0, 48000.0),
+             makeBell(Mode::Stereo, 9000.0, 1.0, -2.0, 48000.0) };
+}
+
+std::vector<Band> groupedMidSide()
+{
+    return { makeBell(Mode::Stereo, 120.0, 0.8, 2.0, 48000.0),
+             makeBell(Mode::Mid, 800.0, 1.2, 9.0, 48000.0),
+             makeBell(Mode::Side, 2500.0, 0.9, -8.0, 48000.0),
+             makeBell(Mode::Mid, 6000.0, 2.0, 6.0, 48000.0),
+             makeBell(Mode::Left, 11000.0, 0.7, -3.0, 48000.0),
+             makeBell(Mode::Side, 400.0, 1.0, 12.0, 48000.0),
+             makeBell(Mode::Mid, 3300.0, 3.0, -10.0, 48000.0) };
+}
+
+//==============================================================================
+// 1. 単独 M/S バンドはビット一致
+//==============================================================================
+void testSingleBandBitIdentical()
+{
+    for (const Mode midSide : { Mode::Mid, Mode::Side })
+    {
+        std::vector<double> refL, refR, outL, outR;
+        run(singleMidSideBetweenLeftRight(midSide), serialPerBand, refL, refR);
+        run(singleMidSideBetweenLeftRight(midSide), serialGrouped, outL, outR);
+        const std::string name = (midSide == Mode::Mid) ? "Mid" : "Side";
+        check(bitIdentical(refL, outL) && bitIdentical(refR, outR),
+              "serial: single " + name + " band between L/R bands is bit-identical to per-band encode");
+    }
+}
+
+//==============================================================================
+// 2. グループ化した M/S は許容誤差内
+//==============================================================================
+void testGroupedWithinTolerance()
+{
+    std::vector<double> refL, refR, outL, outR;
+    run(groupedMidSide(), serialPerBand, refL, refR);
+    run(groupedMidSide(), serialGrouped, outL, outR);
+    const double diff = std::max(maxAbsDiff(refL, outL), maxAbsDiff(refR, outR));
+    check(diff <= kGroupTolerance, "serial: grouped M/S stays within 1e-12 of per-band encode (diff=" + std::to_string(diff) + ")");
+
+    double peak = 0.0;
+    for (size_t n = 0; n < outL.size(); ++n)
+        peak = std::max({ peak, std::fabs(outL[n]), std::fabs(outR[n]) });
+    check(peak > 0.1 && std::isfinite(peak), "serial: grouped output is non-trivial");
+}
+
+//==============================================================================
+// 3. Parallel はビット一致
+//==============================================================================
+void testParallelBitIdentical()
+{
+    for (const auto& makeBands : { +[]() { return groupedMidSide(); },
+                                   +[]() { return singleMidSideBetweenLeftRight(Mode::Side); } })
+    {
+        std::vector<double> refL, refR, outL, outR;
+        run(makeBands(), parallelPerBand, refL, refR);
+        run(makeBands(), parallelShared, outL, outR);
+        check(bitIdentical(refL, outL) && bitIdentical(refR, outR),
+              "parallel: shared encode is bit-identical to per-band encode");
+    }
+}
+
+//==============================================================================
+// 4. グループ境界
+//==============================================================================
+void testGroupEnd()
+{
+    const Mode modes[] = { Mode::Mid, Mode::Side, Mode::Left, Mode::Side, Mode::Stereo, Mode::Mid };
+    const auto ms = [&](int i) { return isMidSide(modes[i]); };
+    check(EQMidSideRouting::groupEnd(0, 6, ms) == 2, "group [Mid, Side] ends at the Left band");
+    check(EQMidSideRouting::groupEnd(3, 6, ms) == 4, "single Side group ends at the Stereo band");
+    check(EQMidSideRouting::groupEnd(5, 6, ms) == 6, "last group ends at the band count");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[EQMidSideRoutingTests] Start\n";
+    testSingleBandBitIdentical();
+    testGroupedWithinTolerance();
+    testParallelBitIdentical();
+    testGroupEnd();
+    std::cout << "[EQMidSideRoutingTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
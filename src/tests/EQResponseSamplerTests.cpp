@@ -0,0 +1,174 @@
+//==============================================================================
+// EQResponseSamplerTests.cpp
+//
+// EQResponseSampler::evaluateBatch (z / z² の事前計算 + evaluateBandResponse の AVX2 カーネル) のテスト。
+//   1. 20 バンド・603 点 (4 の倍数でない点数) の一括評価が、点ごとの
+//      EQAnalysisMath::computeSampleResponse と直列 / 並列の両方で許容誤差内に一致すること
+//   2. AVX2 の 4 点ブロックに満たない点数 (1〜3 点) でもスカラー末尾だけで同じ結果になること
+//   3. |den|² < 1e-18 の縮退バンドは SIMD 部・末尾とも H = 1 (寄与なし) として扱われること
+// を検証する。evaluateBatch の結果は evaluate() を各点に適用したものと同一の定義 (EQResponseSampler.h)。
+//==============================================================================
+#include "eqprocessor/EQResponseSampler.h"
+#include "eqprocessor/EQAnalysisMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr double kSampleRate = 384000.0;
+
+EQCoeffsBiquad makePeakingBiquad(double f0, double q, double gainDb, double fs)
+{
+    const double A = std::pow(10.0, gainDb / 40.0);
+    const double w0 = 2.0 * std::numbers::pi * f0 / fs;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double cw = std::cos(w0);
+    EQCoeffsBiquad c;
+    c.b0 = 1.0 + alpha * A; c.b1 = -2.0 * cw; c.b2 = 1.0 - alpha * A;
+    c.a0 = 1.0 + alpha / A; c.a1 = -2.0 * cw; c.a2 = 1.0 - alpha / A;
+    return c;
+}
+
+BandCollection makeBands()
+{
+    BandCollection collection;
+    for (int j = 0; j < 20; ++j)
+    {
+        const double f0 = 30.0 * std::pow(2.0, j * 0.45);
+        const double q = 0.7 + 0.3 * j;
+        const double g = (j % 3 == 0) ? 9.0 : (j % 3 == 1 ? -6.0 : 3.0);
+        collection.bands.push_back({ j, f0, q, EQBandType::Peaking, static_cast<float>(g),
+                                     makePeakingBiquad(f0, q, g, kSampleRate), g > 0.0 });
+    }
+    return collection;
+}
+
+std::vector<double> makeFrequencies(int count)
+{
+    std::vector<double> freqsHz(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        const double t = (count > 1) ? static_cast<double>(i) / static_cast<double>(count - 1) : 0.0;
+        freqsHz[static_cast<size_t>(i)] = 10.0 * std::pow(2000.0, t);
+    }
+    return freqsHz;
+}
+
+//==============================================================================
+// evaluateBatch と computeSampleResponse の最大誤差 (振幅は相対、上界は dB の絶対)
+//==============================================================================
+struct BatchError
+{
+    double magRelErr = 0.0;
+    double upperBoundErrDb = 0.0;
+    bool freqsMatch = true;
+    bool sizeMatches = true;
+};
+
+BatchError compareBatch(const BandCollection& bands, const std::vector<double>& freqsHz, bool isParallel)
+{
+    const EQResponseSampler sampler(kSampleRate, isParallel);
+    const std::vector<MergedSample> batch = sampler.evaluateBatch(freqsHz, bands);
+
+    BatchError err;
+    err.sizeMatches = batch.size() == freqsHz.size();
+    if (!err.sizeMatches)
+        return err;
+
+    for (size_t k = 0; k < freqsHz.size(); ++k)
+    {
+        const double w = 2.0 * std::numbers::pi * freqsHz[k] / kSampleRate;
+        double refMag = 0.0, refUb = 0.0;
+        EQAnalysisMath::computeSampleResponse(bands.bands.data(), bands.bands.size(),
+                                              w, isParallel, refMag, refUb);
+
+        err.freqsMatch = err.freqsMatch && batch[k].freqHz == freqsHz[k];
+        err.magRelErr = std::max(err.magRelErr,
+                                 std::abs(batch[k].linearMagnitude - refMag) / std::max(refMag, 1e-12));
+        err.upperBoundErrDb = std::max(err.upperBoundErrDb, std::abs(batch[k].upperBoundDb - refUb));
+    }
+    return err;
+}
+
+void checkBatch(const BandCollection& bands, int numFreqs, bool isParallel, const std::string& label)
+{
+    const std::string tag = label + (isParallel ? " parallel" : " serial") + " n=" + std::to_string(numFreqs);
+    const BatchError err = compareBatch(bands, makeFrequencies(numFreqs), isParallel);
+    check(err.sizeMatches, tag + ": one sample per frequency");
+    check(err.freqsMatch, tag + ": sample frequencies preserved");
+    check(err.magRelErr < 1e-12, tag + ": magnitude matches scalar, relErr=" + std::to_string(err.magRelErr));
+    check(err.upperBoundErrDb < 1e-9, tag + ": upper bound matches scalar, errDb=" + std::to_string(err.upperBoundErrDb));
+}
+
+void testBatchMatchesScalar()
+{
+    // 603 = 4·150 + 3: SIMD 150 ブロック + スカラー末尾 3 点
+    const BandCollection bands = makeBands();
+    checkBatch(bands, 603, false, "20 bands");
+    checkBatch(bands, 603, true, "20 bands");
+}
+
+void testTailOnly()
+{
+    const BandCollection bands = makeBands();
+    for (int n = 1; n <= 3; ++n)
+    {
+        checkBatch(bands, n, false, "tail only");
+        checkBatch(bands, n, true, "tail only");
+    }
+}
+
+void testDegenerateBand()
+{
+    // 分母係数が全て 0 の縮退バンドは H = 1 (Δ = 0) で、結果は縮退バンドなしと一致する
+    BandCollection bands = makeBands();
+    BandCollection withDegenerate = bands;
+    BandInfo degenerate = bands.bands.front();
+    degenerate.index = 20;
+    degenerate.biquad.a0 = degenerate.biquad.a1 = degenerate.biquad.a2 = 0.0;
+    withDegenerate.bands.push_back(degenerate);
+
+    checkBatch(withDegenerate, 7, false, "degenerate band");
+
+    const std::vector<double> freqsHz = makeFrequencies(7);
+    const EQResponseSampler sampler(kSampleRate, false);
+    const auto expected = sampler.evaluateBatch(freqsHz, bands);
+    const auto actual = sampler.evaluateBatch(freqsHz, withDegenerate);
+    bool same = expected.size() == actual.size();
+    for (size_t k = 0; same && k < expected.size(); ++k)
+        same = expected[k].linearMagnitude == actual[k].linearMagnitude
+            && expected[k].upperBoundDb == actual[k].upperBoundDb;
+    check(same, "degenerate band contributes H = 1 in both SIMD blocks and tail");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[EQResponseSamplerTests] Start\n";
+    testBatchMatchesScalar();
+    testTailOnly();
+    testDegenerateBand();
+    std::cout << "[EQResponseSamplerTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+//==============================================================================
+// EpochDomainReaderTests.cpp
+//
+// convo::EpochDomain の Reader 追跡 (スロット epoch + 有効ビットマップ + 占有ヒント) のテスト。
+//   1. kMaxReaders 個すべてを登録でき、重複せず、満杯で -1 を返すこと
+//   2. exit で解放したスロットが登録で再利用されること (ヒント経由)
+//   3. getMinReaderEpoch が複数ワードにまたがる有効 Reader の最小 epoch を返し、
+//      exit / quarantine した Reader を除外すること
+//   4. 複数スレッドの enter/exit と並行した getMinReaderEpoch が、読み取り中 Reader の epoch を超えないこと
+//   5. CallbackReaderScope: コールバック入口で固定した reader は区間中 1 回だけ enter され、
+//      固定中の RCUReaderGuard(reader, pinned) はスロットに触れず、スコープ終了で全て exit すること
+//   6. ベンチマーク: 有効 Reader 1 / 8 / 64 本での getMinReaderEpoch と tryReclaim の所要時間
+// JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+#include "core/EpochDomain.h"
+#include "core/CallbackReaderScope.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr int kMaxReaders = convo::EpochDomain::kMaxReaders;
+
+void testRegistration()
+{
+    auto domain = std::make_unique<convo::EpochDomain>();
+    convo::IReaderEpochProvider& provider = *domain;
+
+    std::set<int> slots;
+    for (int i = 0; i < kMaxReaders; ++i)
+        slots.insert(domain->registerReaderThread("test"));
+    check(static_cast<int>(slots.size()) == kMaxReaders && *slots.begin() == 0 && *slots.rbegin() == kMaxReaders - 1,
+          "all slots register exactly once");
+    check(domain->registerReaderThread("overflow") == -1, "registration fails when full");
+
+    // 1 スロットだけ enter/exit で解放 → 次の登録はそのスロットを返す
+    provider.enterReader(130);
+    provider.exitReader(130);
+    check(domain->registerReaderThread("reuse") == 130, "exited slot is reused by registration");
+    check(domain->registerReaderThread("overflow") == -1, "full again after reuse");
+}
+
+void testMinReaderEpoch()
+{
+    auto domain = std::make_unique<convo::EpochDomain>();
+    convo::IReaderEpochProvider& provider = *domain;
+
+    const int a = domain->registerReaderThread("a");
+    for (int i = 0; i < 69; ++i)
+        (void)domain->registerReaderThread("filler");
+    const int b = domain->registerReaderThread("b");   // 2 ワード目
+    check(b >= 64, "second reader lives in the second mask word");
+
+    check(domain->getMinReaderEpoch() == domain->currentEpoch(), "no active reader: min is the current epoch");
+
+    provider.enterReader(a);
+    const uint64_t epochA = domain->currentEpoch();
+    domain->publishEpoch();
+    domain->publishEpoch();
+    provider.enterReader(b);
+    const uint64_t epochB = domain->currentEpoch();
+
+    check(domain->activeReaderCount() == 2, "two active readers");
+    check(domain->getMinReaderEpoch() == epochA, "min epoch is the oldest reader");
+
+    provider.exitReader(a);
+    check(domain->getMinReaderEpoch() == epochB, "exited reader no longer holds back the minimum");
+
+    domain->publishEpoch();
+    (void)domain->quarantineReader(b);   // depth > 0 → 遅延 quarantine
+    provider.exitReader(b);
+    check(domain->activeReaderCount() == 0, "no active readers after exits");
+    check(domain->getMinReaderEpoch() == domain->currentEpoch(), "min returns to current epoch");
+}
+
+void testConcurrentReaders()
+{
+    auto domain = std::make_unique<convo::EpochDomain>();
+    convo::IReaderEpochProvider& provider = *domain;
+    constexpr int kThreads = 6;
+    std::atomic<bool> stop { false };
+    std::atomic<bool> violated { false };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&]
+        {
+            while (!stop.load(std::memory_order_acquire))
+            {
+                const int slot = domain->registerReaderThread("worker");
+                if (slot < 0)
+                    continue;
+                provider.enterReader(slot);
+                // 読み取り中は、自分の epoch より新しい min が計算されてはならない
+                const uint64_t own = domain->getReaderSlotDetail(slot).epoch;
+                if (domain->getMinReaderEpoch() > own)
+                    violated.store(true, std::memory_order_relaxed);
+                provider.exitReader(slot);
+            }
+        });
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        domain->publishEpoch();
+        (void)domain->getMinReaderEpoch();
+    }
+    stop.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+        thread.join();
+
+    check(!violated.load(), "concurrent: an active reader is never above the computed minimum");
+    check(domain->activeReaderCount() == 0, "concurrent: every reader exited");
+}
+
+void testCallbackReaderScope()
+{
+    // EQ / Convolver と同じく、コンポーネントごとに別ドメイン + 別 reader
+    auto eqDomain = std::make_unique<convo::EpochDomain>();
+    auto convDomain = std::make_unique<convo::EpochDomain>();
+    auto engineDomain = std::make_unique<convo::EpochDomain>();
+    convo::RCUReader eqReader(*eqDomain);
+    convo::RCUReader convReader(*convDomain);
+    convo::RCUReader audioReader(*engineDomain);
+    bool eqPinned = false;
+    bool convPinned = false;
+
+    {
+        convo::CallbackReaderScope scope(convo::makeAudioReaderContext(audioReader));
+        check(scope.pin(eqReader, eqPinned) && scope.pin(convReader, convPinned), "scope: both readers pinned");
+        check(scope.pin(eqReader, eqPinned) && scope.pinnedCount() == 2, "scope: pinning again is a no-op");
+        check(eqPinned && convPinned, "scope: pinned flags raised");
+
+        const uint64_t pinnedEpoch = eqDomain->currentEpoch();
+        eqDomain->publishEpoch();
+        eqDomain->publishEpoch();
+        check(eqDomain->getMinReaderEpoch() == pinnedEpoch, "scope: pinned reader holds its entry epoch");
+
+        // 内部ブロックごとの process() 相当。固定中はスロットの epoch もアクティブ数も変わらない
+        for (int block = 0; block < 4; ++block)
+        {
+            convo::RCUReaderGuard guard(eqReader, eqPinned);
+            check(eqDomain->activeReaderCount() == 1 && eqDomain->getMinReaderEpoch() == pinnedEpoch,
+                  "scope: guard inside pinned scope does not re-enter");
+        }
+        check(eqDomain->activeReaderCount() == 1, "scope: reader still active after inner guards");
+    }
+
+    check(!eqPinned && !convPinned, "scope: flags cleared on exit");
+    check(eqDomain->activeReaderCount() == 0 && convDomain->activeReaderCount() == 0, "scope: every pinned reader exited");
+
+    // 固定していなければガードは従来どおり enter / exit する
+    {
+        convo::RCUReaderGuard guard(eqReader, eqPinned);
+        check(eqDomain->activeReaderCount() == 1, "unpinned guard enters");
+    }
+    check(eqDomain->activeReaderCount() == 0, "unpinned guard exits");
+
+    // 容量を超えた分は固定されず、呼び出し側が自前の guard を使う
+    std::vector<std::unique_ptr<convo::EpochDomain>> domains;
+    std::vector<std::unique_ptr<convo::RCUReader>> readers;
+    bool flags[convo::CallbackReaderScope::kMaxPins + 1] = {};
+    {
+        convo::CallbackReaderScope scope(convo::makeAudioReaderContext(audioReader));
+        bool allFit = true;
+        for (int i = 0; i <= convo::CallbackReaderScope::kMaxPins; ++i)
+        {
+            domains.push_back(std::make_unique<convo::EpochDomain>());
+            readers.push_back(std::make_unique<convo::RCUReader>(*domains.back()));
+            const bool pinned = scope.pin(*readers.back(), flags[i]);
+            if (i < convo::CallbackReaderScope::kMaxPins)
+                allFit = allFit && pinned;
+            else
+                check(!pinned && !flags[i], "scope: pin beyond capacity is refused");
+        }
+        check(allFit, "scope: pins up to capacity succeed");
+    }
+    bool anyActive = false;
+    for (const auto& d : domains)
+        anyActive = anyActive || d->activeReaderCount() != 0;
+    check(!anyActive, "scope: capacity test readers all exited");
+}
+
+void benchmarkReclaim()
+{
+    std::cout << "  reclaim latency (ns/call, " << kMaxReaders << " slots):\n";
+    for (const int activeReaders : { 1, 8, 64 })
+    {
+        auto domain = std::make_unique<convo::EpochDomain>();
+        convo::IReaderEpochProvider& provider = *domain;
+        // 登録済み (非アクティブ) スロットも並べ、有効ビットだけが走査対象になることを見る
+        for (int i = 0; i < kMaxReaders; ++i)
+            (void)domain->registerReaderThread("bench");
+        for (int i = 0; i < activeReaders; ++i)
+            provider.enterReader(i * (kMaxReaders / activeReaders));
+
+        constexpr int kIterations = 200000;
+        uint64_t sink = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+            sink += domain->getMinReaderEpoch();
+        const double minNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i)
+            domain->tryReclaim();
+        const double reclaimNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kIterations;
+
+        std::cout << "    active=" << std::setw(2) << activeReaders
+                  << "  getMinReaderEpoch=" << std::fixed << std::setprecision(1) << minNs
+                  << "  tryReclaim=" << reclaimNs << (sink == 0 ? " " : "") << "\n";
+        check(domain->activeReaderCount() == static_cast<uint32_t>(activeReaders), "benchmark: active reader count");
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[EpochDomainReaderTests] Start\n";
+    testRegistration();
+    testMinReaderEpoch();
+    testConcurrentReaders();
+    testCallbackReaderScope();
+    benchmarkReclaim();
+    std::cout << "[EpochDomainReaderTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+//==============================================================================
+// FarTailResidencyPlanTests.cpp
+//
+// FarTailResidencyPlan (ディスク退避した L2 末尾パーティションの常駐範囲) のテスト。
+//   1. カーソルから windowParts 個だけが常駐対象になること
+//   2. MAC が通り過ぎたパーティションは対象から外れること
+//   3. 複数の消費者の窓の和集合になること
+//   4. 消費者がいないとき・ページ化範囲を抜けたカーソルは次サイクル先頭を保つこと
+//   5. 窓がページ化範囲の端で切り詰められること
+// を検証する。JUCE 非依存。
+//==============================================================================
+#include "core/FarTailResidencyPlan.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::FarTailResidencyPlan;
+
+bool onlyRange(const std::vector<uint8_t>& wanted, int begin, int end)
+{
+    for (int p = 0; p < static_cast<int>(wanted.size()); ++p)
+    {
+        const bool inside = p >= begin && p < end;
+        if ((wanted[static_cast<size_t>(p)] != 0) != inside)
+            return false;
+    }
+    return true;
+}
+
+void testWindowFromCursor()
+{
+    std::vector<uint8_t> wanted;
+    const int cursors[] = { 10 };
+    const int count = FarTailResidencyPlan::compute(cursors, 1, 100, 4, wanted);
+    check(wanted.size() == 100, "wanted is sized to the paged parts");
+    check(count == 4, "window size is the resident count");
+    check(onlyRange(wanted, 10, 14), "window starts at the cursor");
+}
+
+void testPassedPartsAreEvicted()
+{
+    std::vector<uint8_t> wanted;
+    int cursors[] = { 10 };
+    FarTailResidencyPlan::compute(cursors, 1, 100, 4, wanted);
+    cursors[0] = 13;
+    FarTailResidencyPlan::compute(cursors, 1, 100, 4, wanted);
+    check(wanted[10] == 0 && wanted[12] == 0, "parts behind the cursor are not wanted");
+    check(onlyRange(wanted, 13, 17), "window advances with the cursor");
+}
+
+void testUnionOfConsumers()
+{
+    std::vector<uint8_t> wanted;
+    const int cursors[] = { 20, -1, 22, 60 };
+    const int count = FarTailResidencyPlan::compute(cursors, 4, 100, 4, wanted);
+    check(count == 10, "overlapping windows are counted once");
+    check(wanted[20] && wanted[25] && !wanted[26], "first two windows merge");
+    check(wanted[60] && wanted[63] && !wanted[64], "distant consumer gets its own window");
+    check(!wanted[0], "unused slot adds nothing");
+}
+
+void testNextCycleHead()
+{
+    std::vector<uint8_t> wanted;
+    const int none[] = { -1, -1 };
+    FarTailResidencyPlan::compute(none, 2, 100, 4, wanted);
+    check(onlyRange(wanted, 0, 4), "no consumers keep the cycle head");
+
+    const int past[] = { 100 };
+    FarTailResidencyPlan::compute(past, 1, 100, 4, wanted);
+    check(onlyRange(wanted, 0, 4), "cursor past the paged range prefetches the next cycle head");
+    check(FarTailResidencyPlan::windowStart(250, 100) == 0, "windowStart wraps past the paged range");
+    check(FarTailResidencyPlan::windowStart(42, 100) == 42, "windowStart follows the cursor");
+}
+
+void testClamping()
+{
+    std::vector<uint8_t> wanted;
+    const int cursors[] = { 98 };
+    const int count = FarTailResidencyPlan::compute(cursors, 1, 100, 4, wanted);
+    check(count == 2 && onlyRange(wanted, 98, 100), "window is clipped at the paged range end");
+
+    check(FarTailResidencyPlan::compute(cursors, 1, 0, 4, wanted) == 0 && wanted.empty(), "no paged parts");
+    check(FarTailResidencyPlan::compute(cursors, 1, 100, 0, wanted) == 0, "empty window");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[FarTailResidencyPlanTests] Start\n";
+    testWindowFromCursor();
+    testPassedPartsAreEvicted();
+    testUnionOfConsumers();
+    testNextCycleHead();
+    testClamping();
+    std::cout << "[FarTailResidencyPlanTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
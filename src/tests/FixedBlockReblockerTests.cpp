@@ -0,0 +1,200 @@
+//==============================================================================
+// FixedBlockReblockerTests.cpp
+//
+// convo::FixedBlockReblocker (audioengine/FixedBlockReblocker.h) の単体テスト。
+//   1. コールバック長が揺れても processBlock には常に blockSize ちょうどが渡ること
+//   2. 出力が入力をちょうど getLatencySamples() (= blockSize - 1) 遅らせたものと一致し、
+//      FIFO が枯れないこと (コールバック長 1 / blockSize 超 / 不揃いの混在)
+//   3. モノラルデバイスでは欠けたチャンネルに無音が入ること
+//   4. reset / 上限超過 / 不正な prepare の扱い
+//   5. double 版 (processBlockDouble 用) も同じ遅延でビット一致すること
+// を検証する。JUCE 非依存 (ヘッダオンリー)。
+//==============================================================================
+#include "audioengine/FixedBlockReblocker.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using FixedBlockReblocker = convo::FixedBlockReblocker<float>;
+
+// 入力を 2 倍する段。渡されたブロック長を記録する
+struct GainStage
+{
+    std::vector<int> blockSizes;
+    int channelsSeen = 0;
+
+    void operator()(float* const* channels, int numSamples)
+    {
+        blockSizes.push_back(numSamples);
+        channelsSeen = 0;
+        for (int ch = 0; ch < FixedBlockReblocker::kMaxChannels && channels[ch] != nullptr; ++ch, ++channelsSeen)
+            for (int i = 0; i < numSamples; ++i)
+                channels[ch][i] *= 2.0f;
+    }
+};
+
+void testDriftingCallbacksAreDelayedExactly()
+{
+    constexpr int kBlock = 512;
+    FixedBlockReblocker reblocker;
+    check(reblocker.prepare(2, kBlock, 4096), "prepare accepts a power-of-two block");
+    check(reblocker.getLatencySamples() == kBlock - 1, "latency is one block minus one sample");
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> sizeDist(1, 2000);
+    const int callbackSizes[] = { 441, 448, 480, 1, 512, 2000, 7, 1024, 4096 };
+
+    std::vector<float> inL, inR, outL, outR;
+    GainStage stage;
+    long long processedTotal = 0;
+    bool sizesWithinLimit = true;
+    int counter = 0;
+    for (int cb = 0; cb < 300; ++cb)
+    {
+        const int n = (cb < static_cast<int>(std::size(callbackSizes))) ? callbackSizes[cb] : sizeDist(rng);
+        std::vector<float> l(static_cast<size_t>(n)), r(static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i, ++counter)
+        {
+            l[static_cast<size_t>(i)] = static_cast<float>(counter % 1000) + 1.0f;
+            r[static_cast<size_t>(i)] = -static_cast<float>(counter % 777) - 1.0f;
+        }
+        inL.insert(inL.end(), l.begin(), l.end());
+        inR.insert(inR.end(), r.begin(), r.end());
+
+        float* channels[] = { l.data(), r.data() };
+        const int processed = reblocker.process(channels, 2, n, stage);
+        sizesWithinLimit = sizesWithinLimit && processed >= 0 && processed % kBlock == 0;
+        processedTotal += processed;
+        outL.insert(outL.end(), l.begin(), l.end());
+        outR.insert(outR.end(), r.begin(), r.end());
+    }
+
+    bool allFull = !stage.blockSizes.empty();
+    for (int size : stage.blockSizes)
+        allFull = allFull && size == kBlock;
+    check(allFull && stage.channelsSeen == 2, "every processed block is exactly blockSize on both channels");
+    check(sizesWithinLimit && processedTotal == static_cast<long long>(stage.blockSizes.size()) * kBlock,
+          "process reports the samples handed to the block stage");
+
+    const int latency = reblocker.getLatencySamples();
+    bool delayed = true;
+    for (size_t i = 0; i < outL.size(); ++i)
+    {
+        const float expectL = (i < static_cast<size_t>(latency)) ? 0.0f : 2.0f * inL[i - static_cast<size_t>(latency)];
+        const float expectR = (i < static_cast<size_t>(latency)) ? 0.0f : 2.0f * inR[i - static_cast<size_t>(latency)];
+        delayed = delayed && outL[i] == expectL && outR[i] == expectR;
+    }
+    check(delayed, "output equals the processed input delayed by exactly getLatencySamples()");
+}
+
+void testMonoDeviceFeedsSilence()
+{
+    constexpr int kBlock = 64;
+    FixedBlockReblocker reblocker;
+    reblocker.prepare(2, kBlock, 256);
+
+    float rightSeen = 0.0f;
+    std::vector<float> out;
+    for (int cb = 0; cb < 10; ++cb)
+    {
+        std::vector<float> buffer(100, 1.0f);
+        float* channels[] = { buffer.data() };
+        reblocker.process(channels, 1, 100, [&](float* const* blockChannels, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                rightSeen += blockChannels[1][i] * blockChannels[1][i];
+        });
+        out.insert(out.end(), buffer.begin(), buffer.end());
+    }
+    check(rightSeen == 0.0f, "a missing device channel is fed silence");
+    check(out[kBlock - 2] == 0.0f && out[kBlock - 1] == 1.0f && out.back() == 1.0f, "the mono channel passes through after the latency");
+}
+
+void testResetAndLimits()
+{
+    constexpr int kBlock = 128;
+    FixedBlockReblocker reblocker;
+    check(!reblocker.prepare(2, 100, 256), "a non power-of-two block is rejected");
+    check(!reblocker.isPrepared(), "a rejected prepare leaves the reblocker unprepared");
+
+    std::vector<float> buffer(300, 1.0f);
+    float* channels[] = { buffer.data(), buffer.data() };
+    check(reblocker.process(channels, 1, 10, [](float* const*, int) {}) == -1, "an unprepared reblocker refuses to process");
+
+    reblocker.prepare(2, kBlock, 256);
+    check(reblocker.process(channels, 1, 300, [](float* const*, int) {}) == -1 && buffer[0] == 1.0f,
+          "a callback above the limit is refused and left untouched");
+
+    std::vector<float> left(200, 1.0f), right(200, 1.0f);
+    float* stereo[] = { left.data(), right.data() };
+    reblocker.process(stereo, 2, 200, [](float* const*, int) {});
+    reblocker.reset();
+    std::fill(left.begin(), left.end(), 3.0f);
+    std::fill(right.begin(), right.end(), 3.0f);
+    reblocker.process(stereo, 2, 200, [](float* const*, int) {});
+    check(left[kBlock - 2] == 0.0f && left[kBlock - 1] == 3.0f && right[kBlock - 1] == 3.0f,
+          "reset drops queued audio and re-primes the latency with silence");
+}
+
+void testDoubleMatchesDelayedInput()
+{
+    constexpr int kBlock = 256;
+    convo::FixedBlockReblocker<double> reblocker;
+    reblocker.prepare(2, kBlock, 1024);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> sizeDist(1, 1024);
+    std::uniform_real_distribution<double> sampleDist(-1.0, 1.0);
+    std::vector<double> in, out;
+    for (int cb = 0; cb < 100; ++cb)
+    {
+        const int n = sizeDist(rng);
+        std::vector<double> l(static_cast<size_t>(n)), r(static_cast<size_t>(n));
+        for (auto& sample : l)
+            sample = sampleDist(rng);
+        r = l;
+        in.insert(in.end(), l.begin(), l.end());
+        double* channels[] = { l.data(), r.data() };
+        reblocker.process(channels, 2, n, [](double* const*, int) {});
+        out.insert(out.end(), l.begin(), l.end());
+    }
+
+    bool delayed = true;
+    for (size_t i = static_cast<size_t>(kBlock - 1); i < out.size(); ++i)
+        delayed = delayed && out[i] == in[i - static_cast<size_t>(kBlock - 1)];
+    check(delayed, "the double reblocker delays by blockSize - 1 bit-exactly");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[FixedBlockReblockerTests] Start\n";
+    testDriftingCallbacksAreDelayedExactly();
+    testMonoDeviceFeedsSilence();
+    testResetAndLimits();
+    testDoubleMatchesDelayedInput();
+    std::cout << "[FixedBlockReblockerTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
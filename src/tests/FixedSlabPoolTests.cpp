@@ -0,0 +1,185 @@
+//==============================================================================
+// FixedSlabPoolTests.cpp
+//
+// convo::FixedSlabPool (core/FixedSlabPool.h) のテスト。
+//   1. 確保したブロックが互いに重ならず、アラインされ、解放後に再利用されること
+//   2. 満杯・サイズ超過でヒープへフォールバックし、解放がヒープへ戻ること
+//   3. クラス専用 operator new / delete (nothrow 含む) 経由で over-aligned 型が使えること
+//   4. 複数スレッドの確保/解放で同じブロックが同時に 2 か所へ渡らないこと
+// JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+#include "core/FixedSlabPool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using SmallPool = convo::FixedSlabPool<24, 16, 64>;
+
+void testAllocateAndReuse()
+{
+    static SmallPool pool;
+    check(SmallPool::kStride == 32, "stride rounds block size up to alignment");
+
+    std::set<std::uintptr_t> addresses;
+    std::vector<void*> blocks;
+    bool aligned = true;
+    for (int i = 0; i < 64; ++i)
+    {
+        void* block = pool.tryAllocate();
+        if (block == nullptr)
+            break;
+        blocks.push_back(block);
+        addresses.insert(reinterpret_cast<std::uintptr_t>(block));
+        aligned = aligned && (reinterpret_cast<std::uintptr_t>(block) % 16) == 0;
+    }
+    check(blocks.size() == 64, "all 64 blocks allocatable");
+    check(addresses.size() == 64, "blocks are distinct");
+    check(aligned, "blocks honour BlockAlign");
+    check(pool.getInUseCount() == 64, "in-use count after filling");
+    check(pool.tryAllocate() == nullptr, "full pool returns nullptr");
+
+    void* released = blocks[37];
+    check(pool.tryDeallocate(released), "owned block is returned");
+    check(pool.getInUseCount() == 63, "in-use count after one release");
+    check(pool.tryAllocate() == released, "freed block is handed out again");
+
+    for (void* block : blocks)
+        pool.deallocate(block);
+    check(pool.getInUseCount() == 0, "all blocks released");
+    check(pool.getHeapFallbackCount() == 0, "no heap fallback while within capacity");
+}
+
+void testHeapFallback()
+{
+    static SmallPool pool;
+    std::vector<void*> blocks;
+    for (int i = 0; i < 64; ++i)
+        blocks.push_back(pool.allocate(24));
+
+    void* overflow = pool.allocate(24);
+    check(overflow != nullptr && !pool.owns(overflow), "overflow goes to the heap");
+    check(reinterpret_cast<std::uintptr_t>(overflow) % 16 == 0, "heap fallback honours BlockAlign");
+
+    void* oversized = pool.allocate(100);
+    check(oversized != nullptr && !pool.owns(oversized), "oversized request goes to the heap");
+    check(pool.getHeapFallbackCount() == 2, "heap fallbacks are counted");
+
+    check(!pool.tryDeallocate(overflow), "heap block is not claimed by the pool");
+    pool.deallocate(overflow);
+    pool.deallocate(oversized);
+    pool.deallocate(nullptr);
+    for (void* block : blocks)
+        pool.deallocate(block);
+    check(pool.getInUseCount() == 0, "pool empty after mixed release");
+}
+
+struct alignas(64) PooledObject
+{
+    static convo::FixedSlabPool<256, 64, 64>& pool()
+    {
+        static convo::FixedSlabPool<256, 64, 64> instance;
+        return instance;
+    }
+
+    static void* operator new(std::size_t size) { return pool().allocate(size); }
+    static void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept { return pool().allocate(size, tag); }
+    static void operator delete(void* ptr) noexcept { pool().deallocate(ptr); }
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept { pool().deallocate(ptr); }
+
+    double values[24] = {};
+    int id = 0;
+};
+
+void testClassOperators()
+{
+    auto* first = new PooledObject();
+    first->id = 1;
+    check(PooledObject::pool().owns(first), "class operator new draws from the pool");
+    check(reinterpret_cast<std::uintptr_t>(first) % 64 == 0, "over-aligned type stays aligned");
+
+    auto* second = new (std::nothrow) PooledObject();
+    check(second != nullptr && PooledObject::pool().owns(second) && second != first, "nothrow new draws from the pool");
+
+    delete first;
+    { std::unique_ptr<PooledObject> owned(second); }
+    check(PooledObject::pool().getInUseCount() == 0, "delete / default_delete return blocks to the pool");
+}
+
+void testConcurrentChurn()
+{
+    static convo::FixedSlabPool<sizeof(std::uint64_t), alignof(std::uint64_t), 128> pool;
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 20000;
+    std::atomic<bool> corrupted { false };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            std::vector<std::uint64_t*> held;
+            for (int i = 0; i < kIterations; ++i)
+            {
+                auto* slot = static_cast<std::uint64_t*>(pool.allocate(sizeof(std::uint64_t)));
+                const std::uint64_t tag = (static_cast<std::uint64_t>(t) << 32) | static_cast<std::uint64_t>(i);
+                *slot = tag;
+                held.push_back(slot);
+                // 数個保持してから解放し、スレッド間でブロックが入れ替わるようにする
+                if (held.size() >= 8)
+                {
+                    for (auto* p : held)
+                        if ((*p >> 32) != static_cast<std::uint64_t>(t))
+                            corrupted.store(true, std::memory_order_relaxed);
+                    for (auto* p : held)
+                        pool.deallocate(p);
+                    held.clear();
+                }
+            }
+            for (auto* p : held)
+                pool.deallocate(p);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    check(!corrupted.load(), "concurrent: no block is shared between live owners");
+    check(pool.getInUseCount() == 0, "concurrent: every block returned");
+    check(pool.getHeapFallbackCount() == 0, "concurrent: capacity covers the working set");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[FixedSlabPoolTests] Start\n";
+    testAllocateAndReuse();
+    testHeapFallback();
+    testClassOperators();
+    testConcurrentChurn();
+    std::cout << "[FixedSlabPoolTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
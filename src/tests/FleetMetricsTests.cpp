@@ -0,0 +1,194 @@
+//==============================================================================
+// FleetMetricsTests.cpp
+//
+// convo::appendFleetMetricsPrometheus / appendFleetMetricsJson (FleetMetrics.h) のテスト。
+//   1. Prometheus テキストの各行が「# TYPE 行」か「名前{ラベル} 値」で、値が入ったとおりに出ること
+//   2. TSC 周波数の推定前は段別時間を出さず、推定後は p50 / p99 / p99.9 / max を段ごとに出すこと
+//   3. callback 負荷のパーセンタイルが callbackWindow (前回の送信以降の差分) から出ること
+//   4. JSON が 1 行で括弧が釣り合い、非有限値が 0 になること
+// を検証する。JUCE / MKL 非依存。
+//==============================================================================
+#include "FleetMetrics.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::FleetMetricsSample;
+
+bool contains(const std::string& text, const std::string& needle)
+{
+    return text.find(needle) != std::string::npos;
+}
+
+std::vector<std::string> splitLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    for (std::string line; std::getline(in, line);)
+        lines.push_back(line);
+    return lines;
+}
+
+FleetMetricsSample makeSample()
+{
+    FleetMetricsSample s;
+    s.timestampMs = 1'700'000'000'000ull;
+    s.callbackLoadPermille = 420;
+    s.callbackTotals.callbacks = 1000;
+    s.callbackTotals.overruns = 3;
+    s.callbackTotals.lateArrivals = 2;
+    s.xrunIncidents = 5;
+    s.xrunDropped = 1;
+    s.xrunRecentFlagCounts[0] = 4;
+    s.memory.categories[static_cast<size_t>(convo::MemoryCategory::ConvolverLayers)].bytes = 1 << 20;
+    s.memory.categories[static_cast<size_t>(convo::MemoryCategory::RetirePending)].bytes = 4096;
+    s.irCache.hits = 7;
+    s.irCache.misses = 3;
+    s.learnerActive = true;
+    s.learner.status = convo::NoiseShaperLearnerStatus::Running;
+    s.learner.iteration = 12;
+    s.learner.bestScore = 0.5;
+    return s;
+}
+
+void testPrometheusShape()
+{
+    const auto sample = makeSample();
+    std::string text;
+    convo::appendFleetMetricsPrometheus(sample, text);
+
+    bool wellFormed = !text.empty() && text.back() == '\n';
+    for (const auto& line : splitLines(text))
+    {
+        if (line.rfind("# TYPE convopeq_", 0) == 0)
+            continue;
+        const auto space = line.rfind(' ');
+        wellFormed = wellFormed && line.rfind("convopeq_", 0) == 0 && space != std::string::npos && space + 1 < line.size();
+    }
+    check(wellFormed, "prometheus: every line is a TYPE comment or a sample");
+
+    check(contains(text, "convopeq_callback_load_permille 420\n"), "prometheus: current load");
+    check(contains(text, "# TYPE convopeq_callbacks_total counter\nconvopeq_callbacks_total 1000\n"), "prometheus: callbacks counter");
+    check(contains(text, "convopeq_callback_overruns_total 3\n"), "prometheus: overruns");
+    check(contains(text, "convopeq_xrun_incidents_total 5\n"), "prometheus: xrun incidents");
+    check(contains(text, "convopeq_xrun_recent_incidents{cause=\"overran\"} 4\n"), "prometheus: xrun by cause");
+    check(contains(text, "convopeq_memory_bytes{category=\"convolverLayers\"} 1048576\n"), "prometheus: memory by category");
+    check(contains(text, "convopeq_memory_total_bytes 1048576\n"), "prometheus: total excludes retire pending");
+    check(contains(text, "convopeq_ir_cache_hits_total 7\n") && contains(text, "convopeq_ir_cache_misses_total 3\n"),
+          "prometheus: IR cache counters");
+    check(contains(text, "convopeq_learner_active 1\n") && contains(text, "convopeq_learner_status{status=\"running\"} 1\n"),
+          "prometheus: learner state");
+    check(contains(text, "convopeq_learner_iteration 12\n") && contains(text, "convopeq_learner_best_score 0.5\n"),
+          "prometheus: learner progress");
+}
+
+void testStageCalibration()
+{
+    auto sample = makeSample();
+    std::string uncalibrated;
+    convo::appendFleetMetricsPrometheus(sample, uncalibrated);
+    check(!contains(uncalibrated, "stage_time_us"), "stages: omitted before clock calibration");
+
+    sample.stages.clockCalibrated = true;
+    auto& eq = sample.stages.stages[static_cast<size_t>(convo::DspStage::Eq)];
+    eq.samples = 100;
+    eq.p50Us = 10.0;
+    eq.p99Us = 20.0;
+    eq.p999Us = 30.0;
+    eq.maxUs = 40.0;
+    std::string calibrated;
+    convo::appendFleetMetricsPrometheus(sample, calibrated);
+    check(contains(calibrated, "convopeq_stage_time_us{stage=\"eq\",quantile=\"0.5\"} 10\n"), "stages: p50");
+    check(contains(calibrated, "convopeq_stage_time_us{stage=\"eq\",quantile=\"0.999\"} 30\n"), "stages: p99.9");
+    check(contains(calibrated, "convopeq_stage_time_us{stage=\"eq\",quantile=\"1\"} 40\n"), "stages: max");
+    check(contains(calibrated, "convopeq_stage_window_samples{stage=\"eq\"} 100\n"), "stages: sample count");
+    check(!contains(calibrated, "stage=\"conv\""), "stages: stages without samples are skipped");
+}
+
+void testCallbackWindow()
+{
+    convo::CallbackTimingHistograms h;
+    convo::CallbackTimingHistograms::Snapshot before;
+    h.collect(before);
+    // 期待周期 1000 us に対して 300 us を 99 回、900 us を 1 回
+    for (uint64_t i = 1; i <= 99; ++i)
+        h.record(1000 * i, 1000 * i + 300, 1000);
+    h.record(100'000, 100'900, 1000);
+    convo::CallbackTimingHistograms::Snapshot after;
+    h.collect(after);
+
+    auto sample = makeSample();
+    sample.callbackWindow.accumulate(after, before);
+    std::string text;
+    convo::appendFleetMetricsPrometheus(sample, text);
+    check(contains(text, "convopeq_callback_load_window_permille{quantile=\"0.5\"} 310\n"), "window: p50 load from the window");
+    check(contains(text, "convopeq_callback_load_window_permille{quantile=\"0.999\"} 910\n"), "window: p99.9 load from the window");
+
+    std::string json;
+    convo::appendFleetMetricsJson(sample, json);
+    check(contains(json, "\"loadP50Permille\":310"), "window: JSON carries the same percentile");
+}
+
+void testJson()
+{
+    auto sample = makeSample();
+    sample.learner.latestScore = std::numeric_limits<double>::quiet_NaN();
+    sample.stages.clockCalibrated = true;
+    sample.stages.windowSeconds = std::numeric_limits<double>::infinity();
+    std::string json;
+    convo::appendFleetMetricsJson(sample, json);
+
+    check(!json.empty() && json.back() == '\n' && json.find('\n') == json.size() - 1, "json: one line");
+    int depth = 0;
+    bool balanced = true;
+    for (char c : json)
+    {
+        depth += (c == '{') ? 1 : (c == '}') ? -1 : 0;
+        balanced = balanced && depth >= 0;
+    }
+    check(balanced && depth == 0, "json: braces balance");
+    check(!contains(json, ",}") && !contains(json, "{,") && !contains(json, ",,"), "json: no stray commas");
+    check(contains(json, "\"timestampMs\":1700000000000"), "json: timestamp");
+    check(contains(json, "\"xrun\":{\"incidents\":5,\"dropped\":1,\"recentByCause\":{\"overran\":4,"), "json: xrun object");
+    check(contains(json, "\"learner\":{\"active\":true,\"status\":\"running\""), "json: learner object");
+    check(contains(json, "\"latestScore\":0,") && contains(json, "\"windowSeconds\":0"), "json: non-finite values become 0");
+    check(!contains(json, "nan") && !contains(json, "inf"), "json: no NaN / Inf literals");
+
+    std::string viaFormat;
+    convo::appendFleetMetrics(sample, convo::FleetMetricsFormat::Json, viaFormat);
+    check(viaFormat == json, "json: appendFleetMetrics dispatches on the format");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[FleetMetricsTests] Start\n";
+    testPrometheusShape();
+    testStageCalibration();
+    testCallbackWindow();
+    testJson();
+    std::cout << "[FleetMetricsTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
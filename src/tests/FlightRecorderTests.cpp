@@ -0,0 +1,333 @@
+//==============================================================================
+// FlightRecorderTests.cpp
+//
+// convo::FlightRecorder (audioengine/FlightRecorder.h) のテスト。
+//   1. create がヘッダ (magic / version / チャネル表) を書いて Running で始まり、decode が読めること
+//   2. 書いたレコードが種類・中身・スレッド ID ごと戻り、全チャネルが時刻順に並ぶこと
+//   3. リングが一周したら最新 capacity 件だけが残り、総書き込み数は上書き分も数えること
+//   4. 書きかけ (sequence == 0) と別周回の sequence を持つスロットは捨てられること
+//   5. 破棄すると Closed になり、作り直すと前回のファイルが previousFile へ移ること。
+//      破棄前のファイルの写し (クラッシュ相当) は Running のまま読めること
+//   6. XrunIncidentCorrelator の incident がその場で Xrun チャネルへ書かれること
+//   7. 複数スレッドの同時書き込みで番号が重複せず、書いた件数がすべて残ること
+// JUCE / MKL 非依存 (FlightRecorder.cpp をリンクする)。
+//==============================================================================
+
+#include "audioengine/FlightRecorder.h"
+#include "audioengine/XrunIncidentCorrelator.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using convo::FlightChannel;
+using convo::FlightRecorder;
+using convo::FlightRecordKind;
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+std::filesystem::path tempPath(const char* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+std::vector<uint8_t> readFileBytes(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+FlightRecorder::DecodedFile decodeFile(const std::filesystem::path& path)
+{
+    const auto bytes = readFileBytes(path);
+    return FlightRecorder::decode(bytes.data(), bytes.size());
+}
+
+size_t countChannel(const FlightRecorder::DecodedFile& file, FlightChannel channel)
+{
+    size_t n = 0;
+    for (const auto& record : file.records)
+        n += record.channel == channel ? 1 : 0;
+    return n;
+}
+
+void testCreateHeader()
+{
+    const auto path = tempPath("convopeq_flight_header.bin");
+    auto recorder = FlightRecorder::create(path);
+    check(recorder != nullptr, "create maps the file");
+    if (recorder == nullptr)
+        return;
+    check(std::filesystem::file_size(path) == FlightRecorder::fileBytes(), "file is sized for every channel");
+
+    const auto decoded = decodeFile(path);
+    check(decoded.valid, "fresh file decodes");
+    check(decoded.state == FlightRecorder::SessionState::Running, "fresh session is Running");
+    check(decoded.records.empty(), "fresh file has no records");
+    check(decoded.sessionStartSteadyUs != 0 && decoded.sessionStartUnixUs != 0, "session clock anchors recorded");
+
+    const std::vector<uint8_t> garbage(8192, 0x5A);
+    check(!FlightRecorder::decode(garbage.data(), garbage.size()).valid, "foreign bytes are rejected");
+    recorder.reset();
+    std::filesystem::remove(path);
+}
+
+void testRoundTrip()
+{
+    const auto path = tempPath("convopeq_flight_roundtrip.bin");
+    auto recorder = FlightRecorder::create(path);
+    if (recorder == nullptr)
+    {
+        check(false, "create for round trip");
+        return;
+    }
+
+    convo::FlightFailurePayload failure {};
+    failure.correlationIdShort = 0xABCD;
+    failure.stage = 2;
+    failure.reason = 3;
+    convo::copyFlightText(failure.origin, "PublicationExecutor::commit");
+    recorder->writePod(FlightChannel::Failure, FlightRecordKind::Failure, failure, 300);
+
+    const convo::FlightProgressPayload progress { 7, 42, 9, 3, {} };
+    recorder->writePod(FlightChannel::Progress, FlightRecordKind::Progress, progress, 100);
+    recorder->writeLifecycle(5, "DRAIN_RETIRE", "~AudioEngine", 200);
+
+    const auto decoded = decodeFile(path);
+    check(decoded.valid && decoded.records.size() == 3, "three records decoded");
+    if (decoded.records.size() != 3)
+        return;
+    check(decoded.records[0].timestampUs == 100 && decoded.records[1].timestampUs == 200
+              && decoded.records[2].timestampUs == 300, "records merged in time order across channels");
+
+    const auto& p = decoded.records[0];
+    convo::FlightProgressPayload progressBack {};
+    std::memcpy(&progressBack, p.payload.data(), sizeof(progressBack));
+    check(p.channel == FlightChannel::Progress && p.kind == FlightRecordKind::Progress
+              && p.payload.size() == sizeof(convo::FlightProgressPayload), "progress kind and size");
+    check(progressBack.generation == 42 && progressBack.worldId == 9 && progressBack.stage == 3, "progress payload intact");
+    check(p.threadId != 0, "writer thread id recorded");
+
+    const auto& l = decoded.records[1];
+    convo::FlightLifecyclePayload lifecycle {};
+    std::memcpy(&lifecycle, l.payload.data(), sizeof(lifecycle));
+    check(l.kind == FlightRecordKind::Lifecycle && lifecycle.code == 5
+              && std::string(lifecycle.text) == "DRAIN_RETIRE @ ~AudioEngine", "lifecycle text joins name and origin");
+    check(decoded.lifecycleCode == 5, "header keeps the last lifecycle code");
+
+    convo::FlightFailurePayload failureBack {};
+    std::memcpy(&failureBack, decoded.records[2].payload.data(), sizeof(failureBack));
+    check(failureBack.correlationIdShort == 0xABCD && std::string(failureBack.origin) == "PublicationExecutor::commit",
+          "failure origin stored as text");
+
+    recorder->heartbeat(12345, 678);
+    const auto withHeartbeat = decodeFile(path);
+    check(withHeartbeat.heartbeatUs == 12345 && withHeartbeat.heartbeatCallbackIndex == 678, "heartbeat visible in header");
+    recorder.reset();
+    std::filesystem::remove(path);
+}
+
+void testWrapAround()
+{
+    const auto path = tempPath("convopeq_flight_wrap.bin");
+    auto recorder = FlightRecorder::create(path);
+    if (recorder == nullptr)
+    {
+        check(false, "create for wrap");
+        return;
+    }
+    const uint32_t capacity = FlightRecorder::kChannelCapacity[static_cast<size_t>(FlightChannel::Lifecycle)];
+    const uint32_t total = capacity + 37;
+    for (uint32_t i = 0; i < total; ++i)
+        recorder->writeLifecycle(i, "phase", "test", 1000 + i);
+
+    const auto decoded = decodeFile(path);
+    check(countChannel(decoded, FlightChannel::Lifecycle) == capacity, "only the newest capacity records remain");
+    check(decoded.written[static_cast<size_t>(FlightChannel::Lifecycle)] == total, "written count includes overwritten records");
+    check(!decoded.records.empty() && decoded.records.front().timestampUs == 1000 + 37
+              && decoded.records.back().timestampUs == 1000 + total - 1, "oldest surviving record follows the overwritten ones");
+    recorder.reset();
+    std::filesystem::remove(path);
+}
+
+void testTornSlots()
+{
+    const auto path = tempPath("convopeq_flight_torn.bin");
+    auto recorder = FlightRecorder::create(path);
+    if (recorder == nullptr)
+    {
+        check(false, "create for torn slots");
+        return;
+    }
+    for (int i = 0; i < 4; ++i)
+        recorder->writeLifecycle(static_cast<uint32_t>(i), "phase", "test", 10 + static_cast<uint64_t>(i));
+    recorder.reset();
+
+    auto bytes = readFileBytes(path);
+    const size_t lifecycleOffset = [] {
+        size_t offset = FlightRecorder::kHeaderBytes;
+        for (size_t c = 0; c < static_cast<size_t>(FlightChannel::Lifecycle); ++c)
+            offset += static_cast<size_t>(FlightRecorder::kChannelCapacity[c]) * FlightRecorder::kRecordBytes;
+        return offset;
+    }();
+    // スロット 1 は書きかけ、スロット 2 は次の周回でスロット 3 に入るはずの番号 (= 位置が一致しない) にする
+    const uint64_t writing = 0;
+    const uint64_t otherLap = 4 + FlightRecorder::kChannelCapacity[static_cast<size_t>(FlightChannel::Lifecycle)];
+    std::memcpy(bytes.data() + lifecycleOffset + 1 * FlightRecorder::kRecordBytes, &writing, sizeof(writing));
+    std::memcpy(bytes.data() + lifecycleOffset + 2 * FlightRecorder::kRecordBytes, &otherLap, sizeof(otherLap));
+    const auto decoded = FlightRecorder::decode(bytes.data(), bytes.size());
+    check(countChannel(decoded, FlightChannel::Lifecycle) == 2, "torn and mismatched slots are skipped");
+    std::filesystem::remove(path);
+}
+
+void testSessionRotation()
+{
+    const auto path = tempPath("convopeq_flight_session.bin");
+    const auto previous = tempPath("convopeq_flight_session.prev.bin");
+    std::filesystem::remove(previous);
+
+    auto first = FlightRecorder::create(path, previous);
+    if (first == nullptr)
+    {
+        check(false, "create first session");
+        return;
+    }
+    first->writeLifecycle(1, "first", "session", 1);
+    const auto crashCopy = readFileBytes(path);   // プロセスが落ちた時点のファイルに相当
+    const auto crashed = FlightRecorder::decode(crashCopy.data(), crashCopy.size());
+    check(crashed.valid && crashed.state == FlightRecorder::SessionState::Running && crashed.records.size() == 1,
+          "unclosed session reads as Running with its records");
+    first.reset();
+    check(decodeFile(path).state == FlightRecorder::SessionState::Closed, "destructor marks the session Closed");
+
+    auto second = FlightRecorder::create(path, previous);
+    check(second != nullptr, "second session created");
+    const auto prior = decodeFile(previous);
+    check(prior.valid && prior.state == FlightRecorder::SessionState::Closed && prior.records.size() == 1,
+          "previous session moved aside intact");
+    check(decodeFile(path).records.empty(), "new session starts empty");
+    second.reset();
+    std::filesystem::remove(path);
+    std::filesystem::remove(previous);
+}
+
+void testXrunMirror()
+{
+    const auto path = tempPath("convopeq_flight_xrun.bin");
+    auto recorder = FlightRecorder::create(path);
+    if (recorder == nullptr)
+    {
+        check(false, "create for xrun");
+        return;
+    }
+    auto correlator = std::make_unique<convo::XrunIncidentCorrelator>();
+    correlator->setFlightRecorder(recorder.get());
+
+    convo::XrunCallbackContext context {};
+    context.cpu = 3;
+    std::array<uint64_t, convo::kNumDspStages> cycles {};
+    cycles[static_cast<size_t>(convo::DspStage::Convolver)] = 9000;
+
+    // 1 回目は期待内、2 回目は処理超過
+    (void)correlator->endCallback(correlator->beginCallback(1000, 3), 1, 1500, 1000, context, cycles);
+    (void)correlator->endCallback(correlator->beginCallback(2000, 3), 2, 4000, 1000, context, cycles);
+    correlator->setFlightRecorder(nullptr);
+    (void)correlator->endCallback(correlator->beginCallback(5000, 3), 3, 9000, 1000, context, cycles);
+
+    const auto decoded = decodeFile(path);
+    check(countChannel(decoded, FlightChannel::Xrun) == 1, "only the attached overrun is mirrored");
+    if (!decoded.records.empty())
+    {
+        convo::FlightXrunPayload xrun {};
+        std::memcpy(&xrun, decoded.records[0].payload.data(), sizeof(xrun));
+        check(xrun.callbackIndex == 2 && xrun.callbackUs == 2000 && xrun.cpu == 3
+                  && (xrun.flags & convo::XrunIncident::kOverran) != 0
+                  && xrun.stageCycles[static_cast<size_t>(convo::DspStage::Convolver)] == 9000,
+              "xrun payload matches the incident");
+        check(decoded.records[0].timestampUs == 4000, "xrun stamped at callback end");
+    }
+    recorder.reset();
+    std::filesystem::remove(path);
+}
+
+void testConcurrentWriters()
+{
+    const auto path = tempPath("convopeq_flight_concurrent.bin");
+    auto recorder = FlightRecorder::create(path);
+    if (recorder == nullptr)
+    {
+        check(false, "create for concurrent");
+        return;
+    }
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;   // 合計 2000 < Progress の容量 (上書きなし)
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (int i = 0; i < kPerThread; ++i)
+            {
+                const convo::FlightProgressPayload payload { static_cast<uint64_t>(t), static_cast<uint64_t>(i), 0, 0, {} };
+                recorder->writePod(FlightChannel::Progress, FlightRecordKind::Progress, payload,
+                                   static_cast<uint64_t>(i));
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto decoded = decodeFile(path);
+    std::set<uint64_t> sequences;
+    std::set<std::pair<uint64_t, uint64_t>> payloads;
+    for (const auto& record : decoded.records)
+    {
+        sequences.insert(record.sequence);
+        convo::FlightProgressPayload payload {};
+        std::memcpy(&payload, record.payload.data(), sizeof(payload));
+        payloads.insert({ payload.correlationIdShort, payload.generation });
+    }
+    check(decoded.records.size() == kThreads * kPerThread, "every concurrent write survives");
+    check(sequences.size() == decoded.records.size(), "sequence numbers are unique");
+    check(payloads.size() == decoded.records.size(), "no payload lost or duplicated");
+    recorder.reset();
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[FlightRecorderTests] Start\n";
+    testCreateHeader();
+    testRoundTrip();
+    testWrapAround();
+    testTornSlots();
+    testSessionRotation();
+    testXrunMirror();
+    testConcurrentWriters();
+    std::cout << "[FlightRecorderTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+//==============================================================================
+// FusedInputStageTests.cpp
+//
+// convo::input::runFusedInputStage (audioengine/FusedInputStage.h) の一致テスト。
+// 融合前の DSPCore 入力段 (変換 → 除去 + クランプ → ピーク計測 → ヘッドルーム を 1 段ずつ全サンプル走査) を
+// 下の referenceInputStage で再現し、
+//   1. float 入力 (processInput 相当) と double 入力 (processInputDouble 相当) がビット一致すること
+//   2. 4 の倍数でない長さ・NaN / ±Inf / デノーマル / 範囲外の値でも一致すること (非有限値は常に 0)
+//   3. モノラル (srcR == nullptr) で両チャンネルへ同じ値が書かれること、入力なしで無音になること
+//   4. 返すピークがゲイン前の値であること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "audioengine/FusedInputStage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr double kHeadroom = 0.8912509381337456;
+constexpr double kDenormThreshold = 2.2250738585072014e-308;
+
+convo::input::FusedInputParams makeParams(double gain)
+{
+    convo::input::FusedInputParams params;
+    params.gain = gain;
+    params.denormThreshold = kDenormThreshold;
+    return params;
+}
+
+template <typename Src>
+double referenceInputStage(const std::vector<Src>& src, std::vector<double>& dst, double gain)
+{
+    dst.assign(src.size(), 0.0);
+    for (size_t i = 0; i < src.size(); ++i)
+        dst[i] = static_cast<double>(src[i]);
+
+    for (double& v : dst)
+    {
+        if (!std::isfinite(v) || std::abs(v) < kDenormThreshold)
+            v = 0.0;
+        v = std::clamp(v, -1.0, 1.0);
+    }
+
+    double peak = 0.0;
+    for (double v : dst)
+        peak = std::max(peak, std::abs(v));
+
+    for (double& v : dst)
+        v *= gain;
+    return peak;
+}
+
+bool bitEqual(const std::vector<double>& a, const double* b)
+{
+    return std::memcmp(a.data(), b, a.size() * sizeof(double)) == 0;
+}
+
+template <typename Src>
+std::vector<Src> makeSignal(int numSamples, std::uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.5, 1.5);
+    std::vector<Src> signal(static_cast<size_t>(numSamples));
+    for (auto& v : signal)
+        v = static_cast<Src>(dist(rng));
+
+    // 特殊値をベクトル部と端数部の両方に置く
+    const Src specials[] = { std::numeric_limits<Src>::quiet_NaN(), std::numeric_limits<Src>::infinity(),
+                             -std::numeric_limits<Src>::infinity(), std::numeric_limits<Src>::denorm_min(),
+                             static_cast<Src>(-0.0), static_cast<Src>(4.0) };
+    for (size_t k = 0; k < std::size(specials) && k * 7 < signal.size(); ++k)
+        signal[k * 7] = specials[k];
+    if (!signal.empty())
+        signal.back() = std::numeric_limits<Src>::quiet_NaN();
+    return signal;
+}
+
+template <typename Src, bool ApplyGain>
+void testStereoMatchesReference(const char* label)
+{
+    const double gain = ApplyGain ? kHeadroom : 1.0;
+    for (int numSamples : { 1, 3, 4, 31, 32, 257 })
+    {
+        const auto left = makeSignal<Src>(numSamples, 11u + static_cast<std::uint32_t>(numSamples));
+        const auto right = makeSignal<Src>(numSamples, 97u + static_cast<std::uint32_t>(numSamples));
+
+        std::vector<double> refL;
+        std::vector<double> refR;
+        const double refPeak = std::max(referenceInputStage(left, refL, gain), referenceInputStage(right, refR, gain));
+
+        std::vector<double> outL(static_cast<size_t>(numSamples), -7.0);
+        std::vector<double> outR(static_cast<size_t>(numSamples), -7.0);
+        const double peak = convo::input::runFusedInputStage<ApplyGain>(left.data(), right.data(), outL.data(),
+                                                                         outR.data(), numSamples, makeParams(gain));
+
+        const std::string suffix = std::string(label) + " n=" + std::to_string(numSamples);
+        check(bitEqual(refL, outL.data()) && bitEqual(refR, outR.data()), "stereo output bit-exact " + suffix);
+        check(peak == refPeak, "peak matches " + suffix);
+    }
+}
+
+void testMonoDuplicates()
+{
+    const auto mono = makeSignal<float>(45, 5u);
+    std::vector<double> ref;
+    const double refPeak = referenceInputStage(mono, ref, kHeadroom);
+
+    std::vector<double> outL(mono.size(), -7.0);
+    std::vector<double> outR(mono.size(), -7.0);
+    const double peak = convo::input::runFusedInputStage<true>(mono.data(), static_cast<const float*>(nullptr),
+                                                               outL.data(), outR.data(), 45, makeParams(kHeadroom));
+    check(bitEqual(ref, outL.data()) && bitEqual(ref, outR.data()), "mono written to both channels");
+    check(peak == refPeak, "mono peak");
+}
+
+void testNoInputIsSilent()
+{
+    std::vector<double> outL(13, -7.0);
+    std::vector<double> outR(13, -7.0);
+    const double peak = convo::input::runFusedInputStage<true>(static_cast<const float*>(nullptr),
+                                                               static_cast<const float*>(nullptr),
+                                                               outL.data(), outR.data(), 13, makeParams(kHeadroom));
+    const bool silent = std::all_of(outL.begin(), outL.end(), [](double v) { return v == 0.0; })
+        && std::all_of(outR.begin(), outR.end(), [](double v) { return v == 0.0; });
+    check(silent && peak == 0.0, "no input channels clears both");
+}
+
+void testPeakIsPreGain()
+{
+    const std::vector<float> left = { 0.5f, -0.25f, 0.125f, 0.0f, -0.75f };
+    const std::vector<float> right = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    std::vector<double> outL(left.size());
+    std::vector<double> outR(right.size());
+    const double peak = convo::input::runFusedInputStage<true>(left.data(), right.data(), outL.data(), outR.data(),
+                                                               5, makeParams(0.5));
+    check(peak == 0.75, "peak measured before headroom");
+    check(outL[4] == -0.375, "headroom applied to output");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[FusedInputStageTests] Start\n";
+    testStereoMatchesReference<float, true>("float+gain");
+    testStereoMatchesReference<float, false>("float");
+    testStereoMatchesReference<double, true>("double+gain");
+    testStereoMatchesReference<double, false>("double");
+    testMonoDuplicates();
+    testNoInputIsSilent();
+    testPeakIsPreGain();
+    std::cout << "[FusedInputStageTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+//==============================================================================
+// FusedOutputStageTests.cpp
+//
+// convo::output::runFusedOutputStage (audioengine/FusedOutputStage.h) の一致テスト。
+// 融合前の DSPCore 出力段 (ヘッドルーム → NaN/Inf 除去 → クランプ →
+// 固定レイテンシ遅延 → 書き込み を 1 段ずつ全サンプル走査) を下の referenceOutputStage で再現し、
+//   1. float 出力 (processOutput 相当) と double 出力 (processOutputDouble 相当) がビット一致すること
+//   2. 遅延線の折り返し・ブロック分割・遅延 0 / bufferSize - 1 / 4 サンプル未満の余裕でも一致すること
+//   3. モノラル (srcR == nullptr) でも一致すること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "audioengine/FusedOutputStage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr double kHeadroom = 0.8912509381337456;
+
+struct DelayLine
+{
+    std::vector<double> left;
+    std::vector<double> right;
+    int delaySamples = 0;
+    int writePos = 0;
+
+    DelayLine(int size, int delay) : left(static_cast<size_t>(size), 0.0), right(static_cast<size_t>(size), 0.0), delaySamples(delay) {}
+
+    convo::output::FusedOutputDelay view()
+    {
+        return { left.data(), right.data(), static_cast<int>(left.size()), delaySamples, writePos };
+    }
+};
+
+bool isFiniteBelow(double x)
+{
+    return std::isfinite(x) && std::abs(x) < 1.0e300;
+}
+
+// 融合前の出力段 (AudioEngine.Processing.DSPCoreIO.cpp / DSPCoreDouble.cpp の旧実装と同じ順序)
+template <typename Dst>
+void referenceOutputStage(std::vector<double> l, std::vector<double>* rIn, Dst* dstL, Dst* dstR,
+                          bool applyGain, bool scrub, DelayLine& delay)
+{
+    std::vector<double> r = rIn != nullptr ? *rIn : std::vector<double>();
+    const bool hasR = rIn != nullptr;
+    const int n = static_cast<int>(l.size());
+
+    if (applyGain)
+    {
+        for (auto& v : l) v *= kHeadroom;
+        for (auto& v : r) v *= kHeadroom;
+    }
+    if (scrub)
+    {
+        for (auto& v : l) if (!isFiniteBelow(v)) v = 0.0;
+        for (auto& v : r) if (!isFiniteBelow(v)) v = 0.0;
+    }
+    for (auto& v : l) v = std::clamp(v, -kHeadroom, kHeadroom);
+    for (auto& v : r) v = std::clamp(v, -kHeadroom, kHeadroom);
+
+    // applyFixedLatencyDelay
+    const int size = static_cast<int>(delay.left.size());
+    if (delay.delaySamples > 0)
+    {
+        const int d = std::min(delay.delaySamples, size - 1);
+        for (int i = 0; i < n; ++i)
+        {
+            delay.left[delay.writePos] = l[i];
+            if (hasR) delay.right[delay.writePos] = r[i];
+            int readPos = delay.writePos - d;
+            while (readPos < 0) readPos += size;
+            l[i] = delay.left[readPos];
+            if (hasR) r[i] = delay.right[readPos];
+            if (++delay.writePos >= size) delay.writePos = 0;
+        }
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        dstL[i] = static_cast<Dst>(l[i]);
+        if (hasR) dstR[i] = static_cast<Dst>(r[i]);
+    }
+}
+
+std::vector<double> makeSignal(std::mt19937& rng, int n, bool withNonFinite)
+{
+    std::uniform_real_distribution<double> dist(-1.4, 1.4);
+    std::vector<double> signal(static_cast<size_t>(n));
+    for (auto& v : signal) v = dist(rng);
+    if (withNonFinite && n > 7)
+    {
+        signal[3] = std::numeric_limits<double>::quiet_NaN();
+        signal[5] = std::numeric_limits<double>::infinity();
+        signal[7] = -2.0e301;
+    }
+    return signal;
+}
+
+// 遅延線の状態を持ち越しながら blockSizes の順にブロックを処理し、参照と比べる
+template <bool ApplyGain, bool Scrub, typename Dst>
+bool runCase(int bufferSize, int delaySamples, const std::vector<int>& blockSizes, bool stereo, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    DelayLine fusedDelay(bufferSize, delaySamples);
+    DelayLine referenceDelay(bufferSize, delaySamples);
+
+    bool identical = true;
+    for (const int n : blockSizes)
+    {
+        auto l = makeSignal(rng, n, Scrub);
+        auto r = makeSignal(rng, n, Scrub);
+        std::vector<Dst> expectedL(static_cast<size_t>(n)), expectedR(static_cast<size_t>(n));
+        std::vector<Dst> actualL(static_cast<size_t>(n)), actualR(static_cast<size_t>(n));
+
+        referenceOutputStage(l, stereo ? &r : nullptr, expectedL.data(), expectedR.data(),
+                             ApplyGain, Scrub, referenceDelay);
+
+        convo::output::FusedOutputParams params;
+        params.gain = kHeadroom;
+        params.limit = kHeadroom;
+        auto view = fusedDelay.view();
+        convo::output::runFusedOutputStage<ApplyGain, Scrub>(l.data(), stereo ? r.data() : nullptr,
+                                                              actualL.data(), stereo ? actualR.data() : nullptr,
+                                                              n, params, view);
+        fusedDelay.writePos = view.writePos;
+
+        identical = identical && expectedL == actualL && (!stereo || expectedR == actualR)
+                    && fusedDelay.writePos == referenceDelay.writePos;
+    }
+    return identical;
+}
+
+void testFloatPath()
+{
+    const std::vector<int> blocks { 32, 32, 17, 64, 3, 32, 128 };
+    check((runCase<false, true, float>(32 + 256 + 2, 32, blocks, true, 1)), "float dither path matches (delay 32)");
+    check((runCase<true, true, float>(32 + 256 + 2, 32, blocks, true, 2)), "float no-dither path matches (delay 32)");
+    check((runCase<false, true, float>(64, 0, blocks, true, 3)), "float path matches without delay");
+    check((runCase<true, true, float>(32 + 256 + 2, 32, blocks, false, 4)), "float mono path matches");
+    check((runCase<false, false, float>(32 + 256 + 2, 32, blocks, true, 12)), "float path after the limiter matches (delay 32)");
+}
+
+void testDoublePath()
+{
+    const std::vector<int> blocks { 32, 32, 17, 64, 3, 32, 128 };
+    check((runCase<false, false, double>(40 + 256 + 2, 40, blocks, true, 5)), "double path matches (delay 40)");
+    check((runCase<false, false, double>(64, 0, blocks, true, 6)), "double path matches without delay");
+    check((runCase<false, false, double>(40 + 256 + 2, 40, blocks, false, 7)), "double mono path matches");
+}
+
+void testDelayEdges()
+{
+    const std::vector<int> blocks { 5, 1, 7, 9, 2, 13, 4 };
+    // bufferSize - delay < 4 (maxInternalBlockSize = 1 相当) はスカラーへ落ちる
+    check((runCase<false, true, float>(12, 10, blocks, true, 8)), "headroom below one vector falls back to scalar");
+    check((runCase<false, true, float>(12, 11, blocks, true, 9)), "delay bufferSize - 1");
+    check((runCase<false, true, float>(12, 40, blocks, true, 10)), "delay longer than buffer is clamped");
+    check((runCase<false, true, double>(9, 1, blocks, true, 11)), "delay 1 with frequent wrap");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[FusedOutputStageTests] Start\n";
+    testFloatPath();
+    testDoublePath();
+    testDelayEdges();
+    std::cout << "[FusedOutputStageTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+//==============================================================================
+// HalfBandCascadeTests.cpp
+//
+// convo::dsp::HalfBandCascade (dsp/HalfBandCascade.h) のテスト。
+//   1. 不正な比率・低レート側 Nyquist に近すぎる通過帯域では準備せず、
+//      申告遅延が各段の中心タップ × 2^段 の和であること
+//   2. 間引き: 通過帯域内の正弦波が申告遅延どおり (出力 m = フルレート時刻 ratio·m − 遅延) に残ること
+//   3. 間引き: ratio の倍数でないコールバック長の列でも、1 回でまとめて流した場合と一致すること
+//   4. 補間: 低レートの正弦波が申告遅延どおりにフルレートへ戻ること
+//   5. 往復: 通過帯域の正弦波は振幅を保ち、低レート側 Nyquist を超える正弦波は減衰量どおり除去されること
+//   6. reset() で新規準備と同じ出力に戻ること
+// を検証する。JUCE 非依存 (AlignedAllocation のため MKL をリンク)。
+//==============================================================================
+#include "dsp/HalfBandCascade.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::dsp::HalfBandCascade;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kPassbandHz = 20000.0;
+constexpr double kAttenuationDb = 100.0;
+
+std::vector<double> sine(int n, double freq, double rate, double offset = 0.0)
+{
+    std::vector<double> v(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i)
+        v[static_cast<size_t>(i)] = 0.5 * std::sin(2.0 * kPi * freq * (static_cast<double>(i) - offset) / rate);
+    return v;
+}
+
+// chunks の長さを巡回しながら流し、連結した出力を返す
+std::vector<double> runDecimate(HalfBandCascade& cascade, const std::vector<double>& input, const std::vector<int>& chunks)
+{
+    std::vector<double> output;
+    std::vector<double> block(input.size() / static_cast<size_t>(cascade.getRatio()) + 4);
+    size_t pos = 0;
+    for (size_t c = 0; pos < input.size(); ++c)
+    {
+        const int n = static_cast<int>(std::min<size_t>(static_cast<size_t>(chunks[c % chunks.size()]), input.size() - pos));
+        const int got = cascade.decimate(input.data() + pos, n, block.data());
+        output.insert(output.end(), block.begin(), block.begin() + got);
+        pos += static_cast<size_t>(n);
+    }
+    return output;
+}
+
+std::vector<double> runInterpolate(HalfBandCascade& cascade, const std::vector<double>& input, int chunk)
+{
+    std::vector<double> output;
+    std::vector<double> block(static_cast<size_t>(chunk * cascade.getRatio()));
+    for (size_t pos = 0; pos < input.size(); pos += static_cast<size_t>(chunk))
+    {
+        const int n = static_cast<int>(std::min<size_t>(static_cast<size_t>(chunk), input.size() - pos));
+        const int got = cascade.interpolate(input.data() + pos, n, block.data());
+        output.insert(output.end(), block.begin(), block.begin() + got);
+    }
+    return output;
+}
+
+void testPrepare()
+{
+    HalfBandCascade cascade;
+    check(!cascade.prepare(HalfBandCascade::Mode::Decimate, 3, 192000.0, kPassbandHz, kAttenuationDb, 512),
+          "prepare: ratio 3 rejected");
+    check(!cascade.prepare(HalfBandCascade::Mode::Decimate, 16, 768000.0, kPassbandHz, kAttenuationDb, 512),
+          "prepare: ratio 16 rejected");
+    check(!cascade.prepare(HalfBandCascade::Mode::Decimate, 2, 48000.0, kPassbandHz, kAttenuationDb, 512),
+          "prepare: 48k / 2 cannot keep 20 kHz");
+    check(!cascade.isReady() && cascade.decimate(nullptr, 64, nullptr) == 0, "prepare: unprepared cascade outputs nothing");
+
+    for (const int ratio : { 2, 4, 8 })
+    {
+        const double rate = 48000.0 * ratio;
+        check(cascade.prepare(HalfBandCascade::Mode::Decimate, ratio, rate, kPassbandHz, kAttenuationDb, 512),
+              "prepare: ratio " + std::to_string(ratio) + " at " + std::to_string(static_cast<int>(rate)));
+        int latency = 0;
+        bool shorterAtHigherRate = true;
+        for (int r = 0; r < convo::dsp::halfBandStagesForRatio(ratio); ++r)
+        {
+            latency += ((cascade.getStageTaps(r) - 1) / 2) << r;
+            if (r > 0)
+                shorterAtHigherRate = shorterAtHigherRate && cascade.getStageTaps(r - 1) < cascade.getStageTaps(r);
+        }
+        check(cascade.getRatio() == ratio && cascade.getLatencySamples() == latency,
+              "prepare: latency is the sum of the stage centre taps for ratio " + std::to_string(ratio));
+        check(shorterAtHigherRate, "prepare: stages at higher rates are shorter for ratio " + std::to_string(ratio));
+    }
+}
+
+void testDecimateSine(int ratio)
+{
+    const double rate = 48000.0 * ratio;
+    HalfBandCascade cascade;
+    check(cascade.prepare(HalfBandCascade::Mode::Decimate, ratio, rate, kPassbandHz, kAttenuationDb, 512),
+          "decimate: prepared");
+    const int latency = cascade.getLatencySamples();
+
+    for (const double freq : { 1000.0, 15000.0 })
+    {
+        cascade.reset();
+        const auto input = sine(static_cast<int>(rate / 4), freq, rate);
+        const auto output = runDecimate(cascade, input, { 512 });
+
+        double maxError = 0.0;
+        for (size_t m = static_cast<size_t>(latency); m < output.size(); ++m)
+        {
+            const double t = static_cast<double>(ratio) * static_cast<double>(m) - latency;
+            maxError = std::max(maxError, std::abs(output[m] - 0.5 * std::sin(2.0 * kPi * freq * t / rate)));
+        }
+        check(output.size() == input.size() / static_cast<size_t>(ratio) && maxError < 1.0e-4,
+              "decimate x" + std::to_string(ratio) + " " + std::to_string(static_cast<int>(freq))
+                  + " Hz: kept at the reported latency");
+    }
+}
+
+void testDecimateChunking()
+{
+    constexpr int ratio = 8;
+    constexpr double rate = 384000.0;
+    const auto input = sine(20000, 3000.0, rate);
+
+    HalfBandCascade whole;
+    HalfBandCascade chunked;
+    check(whole.prepare(HalfBandCascade::Mode::Decimate, ratio, rate, kPassbandHz, kAttenuationDb, 20000)
+              && chunked.prepare(HalfBandCascade::Mode::Decimate, ratio, rate, kPassbandHz, kAttenuationDb, 20000),
+          "chunking: prepared");
+    const auto reference = runDecimate(whole, input, { 20000 });
+    const auto odd = runDecimate(chunked, input, { 37, 5, 1, 480, 13, 250 });
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < std::min(reference.size(), odd.size()); ++i)
+        maxError = std::max(maxError, std::abs(reference[i] - odd[i]));
+    check(reference.size() == odd.size() && maxError < 1.0e-12,
+          "chunking: odd callback lengths match a single call");
+}
+
+void testInterpolateSine(int ratio)
+{
+    const double rate = 48000.0 * ratio;
+    const double lowRate = 48000.0;
+    HalfBandCascade cascade;
+    check(cascade.prepare(HalfBandCascade::Mode::Interpolate, ratio, rate, kPassbandHz, kAttenuationDb, 256),
+          "interpolate: prepared");
+    const int latency = cascade.getLatencySamples();
+
+    const auto input = sine(12000, 2000.0, lowRate);
+    const auto output = runInterpolate(cascade, input, 256);
+
+    double maxError = 0.0;
+    for (size_t i = static_cast<size_t>(latency) * 2; i < output.size(); ++i)
+    {
+        const double t = static_cast<double>(i) - latency;
+        maxError = std::max(maxError, std::abs(output[i] - 0.5 * std::sin(2.0 * kPi * 2000.0 * t / rate)));
+    }
+    check(output.size() == input.size() * static_cast<size_t>(ratio) && maxError < 1.0e-4,
+          "interpolate x" + std::to_string(ratio) + ": back at full rate with the reported latency");
+}
+
+void testRoundTrip()
+{
+    constexpr int ratio = 4;
+    constexpr double rate = 192000.0;
+    for (const double freq : { 5000.0, 40000.0 })
+    {
+        HalfBandCascade down;
+        HalfBandCascade up;
+        check(down.prepare(HalfBandCascade::Mode::Decimate, ratio, rate, kPassbandHz, kAttenuationDb, 512)
+                  && up.prepare(HalfBandCascade::Mode::Interpolate, ratio, rate, kPassbandHz, kAttenuationDb, 128),
+              "round trip: prepared");
+        const int delay = down.getLatencySamples() + up.getLatencySamples();
+
+        const auto input = sine(96000, freq, rate);
+        const auto low = runDecimate(down, input, { 512 });
+        const auto output = runInterpolate(up, low, 128);
+
+        double maxError = 0.0;
+        double maxLevel = 0.0;
+        for (size_t i = static_cast<size_t>(delay) * 2; i < output.size(); ++i)
+        {
+            maxError = std::max(maxError, std::abs(output[i] - input[i - static_cast<size_t>(delay)]));
+            maxLevel = std::max(maxLevel, std::abs(output[i]));
+        }
+        if (freq < kPassbandHz)
+            check(maxError < 1.0e-4, "round trip: 5 kHz returns unchanged after both latencies");
+        else
+            check(maxLevel < 0.5 * std::pow(10.0, -(kAttenuationDb - 6.0) / 20.0),
+                  "round trip: 40 kHz above the low-rate Nyquist is removed");
+    }
+}
+
+void testReset()
+{
+    HalfBandCascade cascade;
+    check(cascade.prepare(HalfBandCascade::Mode::Decimate, 4, 192000.0, kPassbandHz, kAttenuationDb, 512), "reset: prepared");
+    const auto input = sine(4096, 7000.0, 192000.0, 0.3);
+    const auto first = runDecimate(cascade, input, { 129 });
+    static_cast<void>(runDecimate(cascade, sine(333, 2000.0, 192000.0), { 111 }));
+    cascade.reset();
+    const auto second = runDecimate(cascade, input, { 129 });
+    check(first == second, "reset: same output as a freshly prepared cascade");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[HalfBandCascadeTests] Start\n";
+    testPrepare();
+    for (const int ratio : { 2, 4, 8 })
+    {
+        testDecimateSine(ratio);
+        testInterpolateSine(ratio);
+    }
+    testDecimateChunking();
+    testRoundTrip();
+    testReset();
+    std::cout << "[HalfBandCascadeTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,324 @@
+//==============================================================================
+// HalfBandFirTests.cpp
+//
+// convo::dsp::HalfBandFir の一致テスト。
+// タップ数特殊化カーネル (convCount 16/32/64) が Scalar 設計と許容誤差内で
+// 一致すること、補間の両位相・間引きの DC ゲインが 1 であること、
+// 補間 → 間引き往復がインパルスの総和を保つこと、CustomInputOversampler の段別タップ数
+// (31/63/127/255/511/1023) で HalfBandGeometry が design() と一致し、interpolateFixed /
+// decimateFixed が可変版とビット一致することを検証する。
+// JUCE 非依存 (AlignedAllocation のため MKL をリンク)。
+//==============================================================================
+#include "dsp/HalfBandFir.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::dsp::HalfBandFir;
+using convo::dsp::KernelIsa;
+
+constexpr double kTolerance = 1.0e-12;
+constexpr double kAttenuationDb = 140.0;
+// convCount: 31 → 16, 33 → 16, 63 → 32, 127 → 64 (特殊化)、41 → 21 / 45 → 22 (汎用)
+constexpr int kTapsList[] = { 31, 33, 41, 45, 63, 127 };
+
+static_assert(convo::dsp::halfBandStagesForRatio(1) == 0);
+static_assert(convo::dsp::halfBandStagesForRatio(2) == 1);
+static_assert(convo::dsp::halfBandStagesForRatio(4) == 2);
+static_assert(convo::dsp::halfBandStagesForRatio(8) == 3);
+
+std::vector<KernelIsa> supportedIsas()
+{
+    std::vector<KernelIsa> isas;
+    for (KernelIsa isa : { KernelIsa::Scalar, KernelIsa::Avx2, KernelIsa::Avx512 })
+        if (convo::dsp::isKernelIsaSupported(isa))
+            isas.push_back(isa);
+    return isas;
+}
+
+std::string label(KernelIsa isa, int taps, const char* what)
+{
+    return std::string("[") + convo::dsp::kernelIsaName(isa) + "] taps=" + std::to_string(taps) + " " + what;
+}
+
+std::vector<double> randomSignal(int n, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> v(static_cast<size_t>(n));
+    for (double& x : v)
+        x = dist(rng);
+    return v;
+}
+
+// 履歴付きブロック補間 (CustomInputOversampler / TruePeakDetector と同じ呼び方)
+template <typename T>
+std::vector<T> runInterpolate(const HalfBandFir& fir, const std::vector<T>& input, int blockSize)
+{
+    const int keep = fir.interpolateHistoryKeep();
+    std::vector<T> history(static_cast<size_t>(keep + blockSize), T(0));
+    std::vector<T> out(static_cast<size_t>(blockSize) * 2);
+    std::vector<T> result;
+
+    const int total = static_cast<int>(input.size());
+    for (int pos = 0; pos < total; pos += blockSize)
+    {
+        const int n = std::min(blockSize, total - pos);
+        std::copy_n(input.begin() + pos, n, history.begin() + keep);
+        fir.interpolate(history.data(), keep, n, out.data());
+        result.insert(result.end(), out.begin(), out.begin() + 2 * n);
+        std::copy_n(history.begin() + n, keep, history.begin());
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<T> runDecimate(const HalfBandFir& fir, const std::vector<T>& input, int blockSize)
+{
+    const int keep = fir.decimateHistoryKeep();
+    std::vector<T> history(static_cast<size_t>(keep + 2 * blockSize), T(0));
+    std::vector<T> scratch(static_cast<size_t>(fir.decimateScratchSize(blockSize)));
+    std::vector<T> out(static_cast<size_t>(blockSize));
+    std::vector<T> result;
+
+    const int total = static_cast<int>(input.size()) / 2;
+    for (int pos = 0; pos < total; pos += blockSize)
+    {
+        const int n = std::min(blockSize, total - pos);
+        std::copy_n(input.begin() + 2 * pos, 2 * n, history.begin() + keep);
+        fir.decimate(history.data(), keep, n, scratch.data(), out.data());
+        result.insert(result.end(), out.begin(), out.begin() + n);
+        std::copy_n(history.begin() + 2 * n, keep, history.begin());
+    }
+    return result;
+}
+
+template <typename T>
+double maxAbsDiff(const std::vector<T>& a, const std::vector<double>& b)
+{
+    double d = 0.0;
+    for (size_t i = 0; i < std::min(a.size(), b.size()); ++i)
+        d = std::max(d, std::abs(static_cast<double>(a[i]) - b[i]));
+    return d;
+}
+
+void testMatchesScalar(KernelIsa isa)
+{
+    const std::vector<double> signal = randomSignal(1000, 7);
+
+    for (int taps : kTapsList)
+    {
+        HalfBandFir ref;
+        HalfBandFir fir;
+        check(ref.design(taps, kAttenuationDb, KernelIsa::Scalar), label(isa, taps, "scalar design"));
+        check(fir.design(taps, kAttenuationDb, isa), label(isa, taps, "design"));
+        if (!ref.isReady() || !fir.isReady())
+            continue;
+
+        // 端数ブロック長 (SIMD 幅の非倍数) を含める
+        for (int block : { 1, 7, 64, 129 })
+        {
+            const auto upRef = runInterpolate(ref, signal, block);
+            const auto up = runInterpolate(fir, signal, block);
+            check(maxAbsDiff(up, upRef) <= kTolerance,
+                  label(isa, taps, "interpolate block=") + std::to_string(block));
+
+            const auto downRef = runDecimate(ref, upRef, block);
+            const auto down = runDecimate(fir, upRef, block);
+            check(maxAbsDiff(down, downRef) <= kTolerance,
+                  label(isa, taps, "decimate block=") + std::to_string(block));
+        }
+    }
+}
+
+void testDcGain(KernelIsa isa)
+{
+    for (int taps : kTapsList)
+    {
+        HalfBandFir fir;
+        if (!fir.design(taps, kAttenuationDb, isa))
+            continue;
+
+        // 定常状態の DC: 補間は偶数・奇数位相とも 1、間引きも 1
+        const std::vector<double> dc(512, 1.0);
+        const auto up = runInterpolate(fir, dc, 64);
+        const double even = up[up.size() - 2];
+        const double odd = up[up.size() - 1];
+        check(std::abs(even - 1.0) <= 1.0e-9 && std::abs(odd - 1.0) <= 1.0e-9,
+              label(isa, taps, "interpolate DC gain even=") + std::to_string(even) + " odd=" + std::to_string(odd));
+
+        const std::vector<double> dcUp(1024, 1.0);
+        const auto down = runDecimate(fir, dcUp, 64);
+        check(std::abs(down.back() - 1.0) <= 1.0e-9,
+              label(isa, taps, "decimate DC gain ") + std::to_string(down.back()));
+
+        // インパルス往復: 総和 (= DC ゲイン) が 1
+        std::vector<double> impulse(512, 0.0);
+        impulse[0] = 1.0;
+        const auto round = runDecimate(fir, runInterpolate(fir, impulse, 64), 64);
+        double sum = 0.0;
+        for (double v : round)
+            sum += v;
+        check(std::abs(sum - 1.0) <= 1.0e-9, label(isa, taps, "round trip impulse sum ") + std::to_string(sum));
+    }
+}
+
+void testSinglePrecision(KernelIsa isa)
+{
+    const std::vector<double> signal = randomSignal(1000, 11);
+    const std::vector<float> signalF32(signal.begin(), signal.end());
+
+    for (int taps : kTapsList)
+    {
+        HalfBandFir fir;
+        check(!fir.enableSinglePrecision(isa), label(isa, taps, "enableSinglePrecision before design fails"));
+        if (!fir.design(taps, kAttenuationDb, isa))
+            continue;
+        check(fir.enableSinglePrecision(isa) && fir.isSinglePrecisionReady(), label(isa, taps, "enableSinglePrecision"));
+
+        // float32 の量子化 + 累算誤差: 係数和 ~1 に対し 1e-5 で十分な余裕
+        constexpr double kF32Tolerance = 1.0e-5;
+        for (int block : { 1, 7, 64, 129 })
+        {
+            const auto upRef = runInterpolate(fir, signal, block);
+            const auto up = runInterpolate(fir, signalF32, block);
+            check(maxAbsDiff(up, upRef) <= kF32Tolerance,
+                  label(isa, taps, "float32 interpolate block=") + std::to_string(block));
+
+            const std::vector<float> upRefF32(upRef.begin(), upRef.end());
+            const auto downRef = runDecimate(fir, upRef, block);
+            const auto down = runDecimate(fir, upRefF32, block);
+            check(maxAbsDiff(down, downRef) <= kF32Tolerance,
+                  label(isa, taps, "float32 decimate block=") + std::to_string(block));
+        }
+    }
+}
+
+// タップ数固定版を可変版と同じ呼び方で回す
+template <int Taps>
+std::vector<double> runInterpolateFixed(const HalfBandFir& fir, const std::vector<double>& input, int blockSize)
+{
+    constexpr int keep = convo::dsp::HalfBandGeometry<Taps>::interpolateHistoryKeep;
+    std::vector<double> history(static_cast<size_t>(keep + blockSize), 0.0);
+    std::vector<double> out(static_cast<size_t>(blockSize) * 2);
+    std::vector<double> result;
+
+    const int total = static_cast<int>(input.size());
+    for (int pos = 0; pos < total; pos += blockSize)
+    {
+        const int n = std::min(blockSize, total - pos);
+        std::copy_n(input.begin() + pos, n, history.begin() + keep);
+        fir.interpolateFixed<Taps>(history.data(), n, out.data());
+        result.insert(result.end(), out.begin(), out.begin() + 2 * n);
+        std::copy_n(history.begin() + n, keep, history.begin());
+    }
+    return result;
+}
+
+template <int Taps>
+std::vector<double> runDecimateFixed(const HalfBandFir& fir, const std::vector<double>& input, int blockSize)
+{
+    constexpr int keep = convo::dsp::HalfBandGeometry<Taps>::decimateHistoryKeep;
+    std::vector<double> history(static_cast<size_t>(keep + 2 * blockSize), 0.0);
+    std::vector<double> scratch(static_cast<size_t>(fir.decimateScratchSize(blockSize)));
+    std::vector<double> out(static_cast<size_t>(blockSize));
+    std::vector<double> result;
+
+    const int total = static_cast<int>(input.size()) / 2;
+    for (int pos = 0; pos < total; pos += blockSize)
+    {
+        const int n = std::min(blockSize, total - pos);
+        std::copy_n(input.begin() + 2 * pos, 2 * n, history.begin() + keep);
+        fir.decimateFixed<Taps>(history.data(), n, scratch.data(), out.data());
+        result.insert(result.end(), out.begin(), out.begin() + n);
+        std::copy_n(history.begin() + 2 * n, keep, history.begin());
+    }
+    return result;
+}
+
+template <int Taps>
+void checkFixedGeometry(KernelIsa isa, const std::vector<double>& signal)
+{
+    using G = convo::dsp::HalfBandGeometry<Taps>;
+    HalfBandFir fir;
+    check(fir.design(Taps, kAttenuationDb, isa), label(isa, Taps, "fixed design"));
+    check(fir.matchesGeometry<Taps>(), label(isa, Taps, "matchesGeometry"));
+    check(!fir.matchesGeometry<Taps + 2>(), label(isa, Taps, "other geometry does not match"));
+    check(fir.centerTap == G::centerTap && fir.centerParity == G::centerParity && fir.convCount == G::convCount
+              && fir.interpolateHistoryKeep() == G::interpolateHistoryKeep
+              && fir.decimateHistoryKeep() == G::decimateHistoryKeep,
+          label(isa, Taps, "constexpr geometry equals design()"));
+
+    for (int block : { 1, 7, 64, 129 })
+    {
+        const auto up = runInterpolate(fir, signal, block);
+        check(runInterpolateFixed<Taps>(fir, signal, block) == up,
+              label(isa, Taps, "interpolateFixed bit-exact block=") + std::to_string(block));
+        check(runDecimateFixed<Taps>(fir, up, block) == runDecimate(fir, up, block),
+              label(isa, Taps, "decimateFixed bit-exact block=") + std::to_string(block));
+    }
+}
+
+void testFixedGeometry(KernelIsa isa)
+{
+    const std::vector<double> signal = randomSignal(1200, 13);
+    checkFixedGeometry<31>(isa, signal);
+    checkFixedGeometry<63>(isa, signal);
+    checkFixedGeometry<127>(isa, signal);
+    checkFixedGeometry<255>(isa, signal);
+    checkFixedGeometry<511>(isa, signal);
+    checkFixedGeometry<1023>(isa, signal);
+}
+
+void testRelease()
+{
+    HalfBandFir fir;
+    check(!fir.isReady(), "default constructed is not ready");
+    check(fir.design(63, kAttenuationDb), "design(63)");
+    check(fir.isReady() && fir.convCount == 32, "design(63) convCount == 32");
+    check(fir.design(62, kAttenuationDb) && fir.taps == 63, "even taps rounded up to odd");
+    check(fir.enableSinglePrecision() && fir.isSinglePrecisionReady(), "enableSinglePrecision after design");
+    fir.release();
+    check(!fir.isReady(), "release clears state");
+    check(!fir.isSinglePrecisionReady(), "release clears float32 state");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[HalfBandFirTests] Start\n";
+    for (KernelIsa isa : supportedIsas())
+    {
+        std::cout << "  ISA: " << convo::dsp::kernelIsaName(isa) << "\n";
+        testMatchesScalar(isa);
+        testDcGain(isa);
+        testSinglePrecision(isa);
+        testFixedGeometry(isa);
+    }
+    testRelease();
+    std::cout << "[HalfBandFirTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+//==============================================================================
+// IrBusShapingTests.cpp
+//
+// convo::IrBusShape / makeIrBusShape / accumulateIrBus (IrBusShaping.h) のテスト。
+//   1. makeIrBusShape が ms / 秒をサンプル数へ丸め、負値を 0 に、fade を keep で頭打ちにすること
+//   2. irBusKeptLength / irBusShapedLength が keep=0 を全長として扱い、pre-delay を加えること
+//   3. accumulateIrBus が pre-delay 位置へゲイン付きで加算し、dst の既存内容を保ち、dst 長で打ち切ること
+//   4. フェード区間が (0, 1) を単調に下り (1/2 について点対称)、フェード前のサンプルは変えないこと
+//   5. irBusGainFromDb が 0 dB で 1、-20 dB で 0.1、kIrBusMuteDb 以下で 0 を返し、ゲイン 0 は何もしないこと
+// JUCE / MKL 非依存 (ヘッダのみ)。
+//==============================================================================
+
+#include "IrBusShaping.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+bool near(double a, double b, double tolerance = 1e-12)
+{
+    return std::abs(a - b) <= tolerance;
+}
+
+//------------------------------------------------------------------------------
+// 1. 設定値の換算
+//------------------------------------------------------------------------------
+void testMakeShape()
+{
+    const auto shape = convo::makeIrBusShape(10.0, 0.5, 20.0, 48000.0);
+    check(shape.preDelaySamples == 480, "10 ms pre-delay at 48 kHz is 480 samples");
+    check(shape.keepSamples == 24000, "0.5 s tail at 48 kHz is 24000 samples");
+    check(shape.fadeSamples == 960, "20 ms fade at 48 kHz is 960 samples");
+
+    const auto negative = convo::makeIrBusShape(-5.0, -1.0, -3.0, 48000.0);
+    check(negative.preDelaySamples == 0 && negative.keepSamples == 0 && negative.fadeSamples == 0, "negative settings become 0");
+
+    const auto longFade = convo::makeIrBusShape(0.0, 0.01, 50.0, 48000.0);
+    check(longFade.fadeSamples == longFade.keepSamples, "fade is clamped to the kept length");
+
+    const auto invalidRate = convo::makeIrBusShape(10.0, 1.0, 10.0, 0.0);
+    check(invalidRate.preDelaySamples == 0 && invalidRate.keepSamples == 0, "invalid sample rate gives an empty shape");
+}
+
+//------------------------------------------------------------------------------
+// 2. 長さ
+//------------------------------------------------------------------------------
+void testLengths()
+{
+    convo::IrBusShape full { 100, 0, 0 };
+    check(convo::irBusKeptLength(full, 1000) == 1000, "keep 0 uses the whole source");
+    check(convo::irBusShapedLength(full, 1000) == 1100, "shaped length adds the pre-delay");
+
+    convo::IrBusShape trimmed { 10, 300, 50 };
+    check(convo::irBusKeptLength(trimmed, 1000) == 300, "keep trims the source");
+    check(convo::irBusKeptLength(trimmed, 200) == 200, "keep longer than the source uses the source");
+    check(convo::irBusShapedLength(trimmed, 0) == 0, "empty source has no shaped length");
+}
+
+//------------------------------------------------------------------------------
+// 3. 加算
+//------------------------------------------------------------------------------
+void testAccumulate()
+{
+    const std::vector<double> src { 1.0, 2.0, 3.0, 4.0 };
+    std::vector<double> dst(8, 0.5);
+    convo::accumulateIrBus(dst.data(), static_cast<int>(dst.size()), src.data(), static_cast<int>(src.size()),
+                           convo::IrBusShape { 3, 0, 0 }, 2.0);
+
+    const std::vector<double> expected { 0.5, 0.5, 0.5, 2.5, 4.5, 6.5, 8.5, 0.5 };
+    check(dst == expected, "source is added at the pre-delay with gain on top of existing content");
+
+    std::vector<double> shortDst(5, 0.0);
+    convo::accumulateIrBus(shortDst.data(), static_cast<int>(shortDst.size()), src.data(), static_cast<int>(src.size()),
+                           convo::IrBusShape { 3, 0, 0 }, 1.0);
+    check(shortDst == std::vector<double>({ 0.0, 0.0, 0.0, 1.0, 2.0 }), "output is truncated at the destination length");
+
+    std::vector<double> beyond(3, 0.0);
+    convo::accumulateIrBus(beyond.data(), static_cast<int>(beyond.size()), src.data(), static_cast<int>(src.size()),
+                           convo::IrBusShape { 5, 0, 0 }, 1.0);
+    check(beyond == std::vector<double>(3, 0.0), "pre-delay beyond the destination adds nothing");
+
+    std::vector<double> kept(8, 0.0);
+    convo::accumulateIrBus(kept.data(), static_cast<int>(kept.size()), src.data(), static_cast<int>(src.size()),
+                           convo::IrBusShape { 0, 2, 0 }, 1.0);
+    check(kept == std::vector<double>({ 1.0, 2.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }), "keep drops the rest of the source");
+}
+
+//------------------------------------------------------------------------------
+// 4. フェード
+//------------------------------------------------------------------------------
+void testFade()
+{
+    constexpr int kLength = 64;
+    constexpr int kFade = 16;
+    const std::vector<double> ones(kLength, 1.0);
+    std::vector<double> dst(kLength, 0.0);
+    convo::accumulateIrBus(dst.data(), kLength, ones.data(), kLength, convo::IrBusShape { 0, 0, kFade }, 1.0);
+
+    bool untouched = true;
+    for (int n = 0; n < kLength - kFade; ++n)
+        untouched = untouched && dst[static_cast<size_t>(n)] == 1.0;
+    check(untouched, "samples before the fade keep unit gain");
+
+    bool monotonic = true;
+    bool inside = true;
+    for (int n = kLength - kFade; n < kLength; ++n)
+    {
+        const double w = dst[static_cast<size_t>(n)];
+        inside = inside && w > 0.0 && w < 1.0;
+        if (n > kLength - kFade)
+            monotonic = monotonic && w < dst[static_cast<size_t>(n - 1)];
+    }
+    check(inside, "fade weights stay inside (0, 1)");
+    check(monotonic, "fade weights decrease monotonically");
+    bool symmetric = true;
+    for (int k = 0; k < kFade; ++k)
+        symmetric = symmetric && near(dst[static_cast<size_t>(kLength - kFade + k)] + dst[static_cast<size_t>(kLength - 1 - k)], 1.0);
+    check(symmetric, "fade weights are point-symmetric around one half");
+
+    std::vector<double> single(4, 0.0);
+    convo::accumulateIrBus(single.data(), 4, ones.data(), 4, convo::IrBusShape { 0, 0, 1 }, 1.0);
+    check(near(single[3], 0.5), "a one-sample fade halves the last sample");
+}
+
+//------------------------------------------------------------------------------
+// 5. ゲイン
+//------------------------------------------------------------------------------
+void testGain()
+{
+    check(convo::irBusGainFromDb(0.0) == 1.0, "0 dB is unity");
+    check(near(convo::irBusGainFromDb(-20.0), 0.1), "-20 dB is 0.1");
+    check(near(convo::irBusGainFromDb(6.0), std::pow(10.0, 0.3)), "+6 dB");
+    check(convo::irBusGainFromDb(convo::kIrBusMuteDb) == 0.0, "kIrBusMuteDb mutes");
+    check(convo::irBusGainFromDb(-200.0) == 0.0, "below kIrBusMuteDb mutes");
+
+    const std::vector<double> src { 1.0, 1.0 };
+    std::vector<double> dst { 0.25, 0.25 };
+    convo::accumulateIrBus(dst.data(), 2, src.data(), 2, convo::IrBusShape {}, 0.0);
+    check(dst == std::vector<double>({ 0.25, 0.25 }), "zero gain leaves the destination unchanged");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[IrBusShapingTests] Start\n";
+    testMakeShape();
+    testLengths();
+    testAccumulate();
+    testFade();
+    testGain();
+    std::cout << "[IrBusShapingTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+//==============================================================================
+// KernelDispatchTests.cpp
+//
+// convo::dsp::KernelDispatch の一致テスト。
+// Scalar / AVX2 / AVX-512F (CPU 対応時のみ) の各カーネルが参照実装と
+// 許容誤差内で一致すること、端数長 (SIMD 幅の非倍数) を正しく処理すること、
+// initialiseKernelDispatch の ISA 解決規則を検証する。
+// JUCE/MKL 非依存。
+//==============================================================================
+#include "dsp/KernelDispatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::dsp::KernelIsa;
+using convo::dsp::KernelTable;
+
+constexpr double kTolerance = 1.0e-12;
+constexpr int kMaxLen = 512;
+
+// dotProduct の coeffs は 64 バイト整列が契約
+alignas(64) double g_coeffs[kMaxLen];
+alignas(64) double g_x[kMaxLen + 64];
+
+void fillRandom(double* dst, int n, uint32_t seed, double range)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-range, range);
+    for (int i = 0; i < n; ++i)
+        dst[i] = dist(rng);
+}
+
+std::vector<KernelIsa> supportedIsas()
+{
+    std::vector<KernelIsa> isas;
+    for (KernelIsa isa : { KernelIsa::Scalar, KernelIsa::Avx2, KernelIsa::Avx512 })
+        if (convo::dsp::isKernelIsaSupported(isa))
+            isas.push_back(isa);
+    return isas;
+}
+
+std::string isaLabel(KernelIsa isa)
+{
+    return std::string("[") + convo::dsp::kernelIsaName(isa) + "] ";
+}
+
+void testDotProduct(KernelIsa isa)
+{
+    const KernelTable& k = convo::dsp::kernelsFor(isa);
+    fillRandom(g_coeffs, kMaxLen, 1, 1.0);
+    fillRandom(g_x, kMaxLen + 64, 2, 1.0);
+
+    for (int n : { 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 127, 200, kMaxLen })
+    {
+        for (int offset : { 0, 1, 3 }) // x は非整列可
+        {
+            long double ref = 0.0L;
+            for (int i = 0; i < n; ++i)
+                ref += static_cast<long double>(g_x[offset + i]) * g_coeffs[i];
+            const double got = k.dotProduct(g_x + offset, g_coeffs, n);
+            check(std::abs(got - static_cast<double>(ref)) <= kTolerance * std::max(1.0, std::sqrt(static_cast<double>(n))),
+                  isaLabel(isa) + "dotProduct n=" + std::to_string(n) + " offset=" + std::to_string(offset));
+        }
+    }
+}
+
+void testFirVertical(KernelIsa isa)
+{
+    const KernelTable& k = convo::dsp::kernelsFor(isa);
+    fillRandom(g_coeffs, kMaxLen, 3, 0.5);
+    fillRandom(g_x, kMaxLen + 64, 4, 1.0);
+
+    for (int convCount : { 1, 2, 4, 5, 15, 31 })
+    {
+        for (int numOut : { 1, 3, 4, 7, 8, 13, 16, 17, 40 })
+        {
+            // 出力末尾の書き越しを検出する番兵
+            std::vector<double> out(static_cast<size_t>(numOut) + 8, 1234.5);
+            k.firVertical(g_x, g_coeffs, convCount, out.data(), numOut);
+
+            double maxDiff = 0.0;
+            for (int o = 0; o < numOut; ++o)
+            {
+                long double ref = 0.0L;
+                for (int r = 0; r < convCount; ++r)
+                    ref += static_cast<long double>(g_coeffs[r]) * g_x[o + r];
+                maxDiff = std::max(maxDiff, std::abs(out[static_cast<size_t>(o)] - static_cast<double>(ref)));
+            }
+            const bool guardIntact = std::all_of(out.begin() + numOut, out.end(),
+                                                 [](double v) { return v == 1234.5; });
+            const std::string label = isaLabel(isa) + "firVertical conv=" + std::to_string(convCount)
+                                    + " out=" + std::to_string(numOut);
+            check(maxDiff <= kTolerance, label + " max abs diff " + std::to_string(maxDiff));
+            check(guardIntact, label + " no write past numOut");
+        }
+    }
+}
+
+void testFirVerticalF32(KernelIsa isa)
+{
+    const KernelTable& k = convo::dsp::kernelsFor(isa);
+    fillRandom(g_coeffs, kMaxLen, 3, 0.5);
+    fillRandom(g_x, kMaxLen + 64, 4, 1.0);
+    std::vector<float> coeffs(g_coeffs, g_coeffs + kMaxLen);
+    std::vector<float> x(g_x, g_x + kMaxLen + 64);
+
+    for (int convCount : { 1, 2, 5, 16, 31, 32 })
+    {
+        for (int numOut : { 1, 7, 8, 15, 16, 17, 33, 40 })
+        {
+            std::vector<float> out(static_cast<size_t>(numOut) + 16, 1234.5f);
+            k.firVerticalF32(x.data(), coeffs.data(), convCount, out.data(), numOut);
+
+            // float32 累算: 許容誤差は項数 × float ε 程度
+            const double tolerance = 1.0e-6 * static_cast<double>(convCount);
+            double maxDiff = 0.0;
+            for (int o = 0; o < numOut; ++o)
+            {
+                long double ref = 0.0L;
+                for (int r = 0; r < convCount; ++r)
+                    ref += static_cast<long double>(coeffs[static_cast<size_t>(r)]) * x[static_cast<size_t>(o + r)];
+                maxDiff = std::max(maxDiff, std::abs(static_cast<double>(out[static_cast<size_t>(o)]) - static_cast<double>(ref)));
+            }
+            const bool guardIntact = std::all_of(out.begin() + numOut, out.end(),
+                                                 [](float v) { return v == 1234.5f; });
+            const std::string label = isaLabel(isa) + "firVerticalF32 conv=" + std::to_string(convCount)
+                                    + " out=" + std::to_string(numOut);
+            check(maxDiff <= tolerance, label + " max abs diff " + std::to_string(maxDiff));
+            check(guardIntact, label + " no write past numOut");
+        }
+    }
+}
+
+void testPeakAbs(KernelIsa isa)
+{
+    const KernelTable& k = convo::dsp::kernelsFor(isa);
+    fillRandom(g_x, kMaxLen, 5, 0.5);
+
+    check(k.peakAbs(g_x, 0) == 0.0, isaLabel(isa) + "peakAbs n=0");
+    for (int n : { 1, 2, 5, 8, 13, 100, kMaxLen })
+    {
+        // 最大値は負値で末尾付近に置く (tail 処理の検証)
+        std::vector<double> buf(g_x, g_x + n);
+        buf[static_cast<size_t>(n - 1)] = -0.875;
+        double ref = 0.0;
+        for (double v : buf)
+            ref = std::max(ref, std::abs(v));
+        check(k.peakAbs(buf.data(), n) == ref, isaLabel(isa) + "peakAbs n=" + std::to_string(n));
+    }
+}
+
+void testSoftClip(KernelIsa isa)
+{
+    const KernelTable& ref = convo::dsp::kernelsFor(KernelIsa::Scalar);
+    const KernelTable& k = convo::dsp::kernelsFor(isa);
+
+    struct Params { double threshold, knee, asymmetry; };
+    for (const Params p : { Params { 0.95, 0.05, 0.0 }, Params { 0.725, 0.225, 0.05 }, Params { 0.5, 0.4, 0.1 },
+                            Params { 0.8, 0.0, 0.0 } /* hard clip fallback */ })
+    {
+        for (int n : { 1, 3, 4, 7, 8, 13, 64, 129 })
+        {
+            std::vector<double> a(static_cast<size_t>(n));
+            fillRandom(a.data(), n, 6, 2.0);
+            std::vector<double> b = a;
+            ref.softClip(a.data(), n, p.threshold, p.knee, p.asymmetry);
+            k.softClip(b.data(), n, p.threshold, p.knee, p.asymmetry);
+
+            double maxDiff = 0.0;
+            for (int i = 0; i < n; ++i)
+                maxDiff = std::max(maxDiff, std::abs(a[static_cast<size_t>(i)] - b[static_cast<size_t>(i)]));
+            check(maxDiff <= kTolerance,
+                  isaLabel(isa) + "softClip th=" + std::to_string(p.threshold) + " knee=" + std::to_string(p.knee)
+                      + " n=" + std::to_string(n) + " max abs diff " + std::to_string(maxDiff));
+        }
+    }
+
+    // 線形域のサンプルはビット一致で素通し
+    std::vector<double> linear { 0.1, -0.2, 0.3, -0.4, 0.0, 0.05, -0.05, 0.25, 0.15 };
+    const std::vector<double> original = linear;
+    k.softClip(linear.data(), static_cast<int>(linear.size()), 0.95, 0.05, 0.0);
+    check(linear == original, isaLabel(isa) + "softClip linear region passthrough");
+}
+
+void testInitialise()
+{
+    check(convo::dsp::activeKernels().isa == KernelIsa::Avx2, "default active table is Avx2");
+
+    check(convo::dsp::initialiseKernelDispatch(KernelIsa::Scalar) == KernelIsa::Scalar, "initialise(Scalar) -> Scalar");
+    check(convo::dsp::activeKernels().isa == KernelIsa::Scalar, "active table follows initialise(Scalar)");
+
+    const KernelIsa best = convo::dsp::initialiseKernelDispatch();
+    const KernelIsa expected = convo::dsp::isKernelIsaSupported(KernelIsa::Avx512) ? KernelIsa::Avx512 : KernelIsa::Avx2;
+    check(best == expected, std::string("initialise() -> ") + convo::dsp::kernelIsaName(best));
+    check(convo::dsp::activeKernels().isa == best, "active table follows initialise()");
+
+    check(convo::dsp::kernelsFor(KernelIsa::Avx512).isa == expected, "kernelsFor(Avx512) falls back when unsupported");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[KernelDispatchTests] Start\n";
+    for (KernelIsa isa : supportedIsas())
+    {
+        std::cout << "  ISA: " << convo::dsp::kernelIsaName(isa) << "\n";
+        testDotProduct(isa);
+        testFirVertical(isa);
+        testFirVerticalF32(isa);
+        testPeakAbs(isa);
+        testSoftClip(isa);
+    }
+    testInitialise();
+    std::cout << "[KernelDispatchTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
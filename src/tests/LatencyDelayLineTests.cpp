@@ -0,0 +1,201 @@
+//==============================================================================
+// LatencyDelayLineTests.cpp
+//
+// convo::dsp::LatencyDelayLine (dsp/LatencyDelayLine.h) のテスト。
+//   1. 容量が「遅延 + ブロック + 補間ガード」以上の最小の 2 の累乗になること
+//   2. ラップ境界をまたいでも整数遅延の読み出しが入力をそのまま遅らせること
+//   3. 予約した大きいリングへの取り込みで、旧容量内の履歴と遅延位置が連続すること
+//   4. 取り込み後の旧リングは Audio Thread では解放せず、非 RT の回収で解放されること
+//   5. 予約・解放でリークしないこと (アロケータの確保数)
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "dsp/LatencyDelayLine.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+int g_liveAllocations = 0;
+
+struct CountingAllocator
+{
+    static double* allocate(std::size_t count) noexcept
+    {
+        auto* ptr = static_cast<double*>(std::malloc(count * sizeof(double)));
+        if (ptr != nullptr)
+            ++g_liveAllocations;
+        return ptr;
+    }
+
+    static void deallocate(double* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+        --g_liveAllocations;
+        std::free(ptr);
+    }
+};
+
+using DelayLine = convo::dsp::LatencyDelayLine<CountingAllocator>;
+
+// 通し番号 (1 始まり) を書き、delay 遅れた値が読めるかを 1 ブロック分確かめる
+bool runBlock(DelayLine& line, long long& counter, int numSamples, int delay)
+{
+    std::vector<double> in(static_cast<std::size_t>(numSamples));
+    for (int i = 0; i < numSamples; ++i)
+        in[static_cast<std::size_t>(i)] = static_cast<double>(++counter);
+
+    bool ok = true;
+    for (int ch = 0; ch < DelayLine::kNumChannels; ++ch)
+    {
+        std::vector<double> out(static_cast<std::size_t>(numSamples));
+        line.write(ch, in.data(), numSamples);
+        line.read(ch, out.data(), numSamples, delay);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double expected = std::max(0.0, in[static_cast<std::size_t>(i)] - delay);
+            ok = ok && out[static_cast<std::size_t>(i)] == expected;
+        }
+    }
+    line.advance(numSamples);
+    return ok;
+}
+
+void testCapacity()
+{
+    static_assert(DelayLine::capacityFor(0, 1) == DelayLine::kMinCapacity);
+    check(DelayLine::capacityFor(1000, 512) == 2048, "1000 + 512 + guard -> 2048");
+    check(DelayLine::capacityFor(2048 - 512 - DelayLine::kInterpolationGuard, 512) == 2048, "exact fit stays 2048");
+    check(DelayLine::capacityFor(2048 - 512 - DelayLine::kInterpolationGuard + 1, 512) == 4096, "one over -> 4096");
+    // 旧実装の固定リング (2^22) に対し、48 kHz・1 s 先頭ピークの IR なら 2^16
+    check(DelayLine::capacityFor(48000 + 512, 512) == 65536, "typical IR latency fits 2^16");
+}
+
+void testDelayAcrossWrap()
+{
+    DelayLine line;
+    check(line.prepare(100, 64), "prepare");
+    check(line.capacity() == 256, "capacity 100 + 64 + guard -> 256");
+    check(line.maxDelayFor(64) == 256 - 64 - DelayLine::kInterpolationGuard, "max delay for a full block");
+    check(line.canProcess(252) && !line.canProcess(253), "block must not wrap onto itself");
+
+    long long counter = 0;
+    bool ok = true;
+    for (int block = 0; block < 40; ++block)
+        ok = runBlock(line, counter, 64, 100) && ok;
+    check(ok, "delay 100 across many wraps");
+
+    ok = true;
+    for (int block = 0; block < 8; ++block)
+        ok = runBlock(line, counter, 37, 0) && ok;
+    check(ok, "delay 0 returns the block just written");
+
+    line.clear();
+    std::vector<double> out(16, 1.0);
+    line.read(0, out.data(), 16, 50);
+    bool silent = true;
+    for (double v : out)
+        silent = silent && v == 0.0;
+    check(silent && line.writePosition() == 0, "clear zeroes history and rewinds");
+}
+
+void testGrowthKeepsHistory()
+{
+    DelayLine line;
+    (void)line.prepare(100, 64);
+    long long counter = 0;
+    for (int block = 0; block < 10; ++block)
+        (void)runBlock(line, counter, 64, 100);
+
+    check(line.reserve(50), "smaller reservation is a no-op");
+    check(line.capacity() == 256, "no-op keeps capacity");
+
+    check(line.reserve(3000), "grow reservation");
+    check(line.capacity() == 256, "Audio Thread has not adopted yet");
+    line.adoptPendingGrowth();
+    check(line.capacity() == 4096, "adopted the grown ring");
+
+    // 旧リングにあった直近 256 サンプルは同じ遅延位置で読める
+    bool ok = true;
+    for (int block = 0; block < 3; ++block)
+        ok = runBlock(line, counter, 64, 200) && ok;
+    check(ok, "old delay reads continue across adoption");
+
+    // 大きい遅延は、伸びた分の履歴が溜まった後は正しく読める
+    for (int block = 0; block < 60; ++block)
+        (void)runBlock(line, counter, 64, 3000);
+    check(runBlock(line, counter, 64, 3000), "grown delay after history fills");
+}
+
+void testRetiredRingIsCollectedOffRt()
+{
+    DelayLine line;
+    (void)line.prepare(10, 16);
+    const std::size_t initialBytes = line.residentBytes();
+    check(initialBytes == static_cast<std::size_t>(64) * 2 * sizeof(double), "initial ring bytes");
+
+    check(line.reserve(200), "growth reserved");
+    line.adoptPendingGrowth();
+    check(line.capacity() == 256, "growth adopted");
+
+    // Audio Thread は旧リングを解放しない。回収までは旧リングも確保量に数える
+    check(g_liveAllocations == 2, "old ring parked in the retired slot");
+    check(line.residentBytes() == static_cast<std::size_t>(256 + 64) * 2 * sizeof(double), "retired ring counted");
+
+    line.adoptPendingGrowth();
+    check(line.capacity() == 256, "nothing pending: unchanged");
+
+    line.collectRetired();
+    check(g_liveAllocations == 1, "collectRetired frees the old ring");
+    check(line.residentBytes() == static_cast<std::size_t>(256) * 2 * sizeof(double), "only the live ring remains");
+}
+
+void testNoLeaks()
+{
+    {
+        DelayLine line;
+        check(!line.reserve(100), "reserve before prepare fails");
+        (void)line.prepare(10, 16);
+        (void)line.reserve(1000);
+        (void)line.reserve(5000);       // 取り込まれなかった予約は差し替えで解放
+        line.adoptPendingGrowth();
+        (void)line.reserve(90000);      // retired を回収 + 新しい予約
+        check(g_liveAllocations == 2, "current + pending live");
+        (void)line.prepare(10, 16);     // 予約も含めて作り直す
+        check(g_liveAllocations == 1, "prepare drops pending and retired rings");
+    }
+    check(g_liveAllocations == 0, "destructor releases everything");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[LatencyDelayLineTests] Start\n";
+    testCapacity();
+    testDelayAcrossWrap();
+    testGrowthKeepsHistory();
+    testRetiredRingIsCollectedOffRt();
+    testNoLeaks();
+    std::cout << "[LatencyDelayLineTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,247 @@
+//==============================================================================
+// LatticeNoiseShaperBatchTests.cpp
+//
+// convo::dsp::LatticeNoiseShaperBatch の一致テスト。
+// 各 ISA カーネルの全レーンが 1 候補ずつの参照格子再帰
+// (LatticeNoiseShaper::processSample と同じ式) と一致すること、
+// レーンが互いに独立であること、ブロック分割しても状態が正しく引き継がれること、
+// bitDepth 0 (量子化なし) で誤差 0 になることを検証する。
+// JUCE 非依存 (AlignedAllocation のため MKL をリンク)。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "dsp/LatticeNoiseShaperBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::dsp::KernelIsa;
+using convo::dsp::LatticeBatchQuantizer;
+using convo::dsp::LatticeNoiseShaperBatch;
+
+constexpr int kOrder = LatticeNoiseShaperBatch::kOrder;
+constexpr int kStride = LatticeNoiseShaperBatch::kMaxLanes;
+constexpr int kNumSamples = 2048;
+constexpr double kHeadroom = 0.8912509381337456;
+
+std::vector<KernelIsa> supportedIsas()
+{
+    std::vector<KernelIsa> isas;
+    for (KernelIsa isa : { KernelIsa::Scalar, KernelIsa::Avx2, KernelIsa::Avx512 })
+        if (convo::dsp::isKernelIsaSupported(isa))
+            isas.push_back(isa);
+    return isas;
+}
+
+std::string isaLabel(KernelIsa isa)
+{
+    return std::string("[") + convo::dsp::kernelIsaName(isa) + "] ";
+}
+
+LatticeBatchQuantizer makeQuantizer(int bitDepth)
+{
+    LatticeBatchQuantizer q;
+    q.invScale = std::ldexp(1.0, bitDepth - 1);
+    q.scale = 1.0 / q.invScale;
+    q.maxValue = 1.0 - q.scale;
+    q.minQ = -q.invScale;
+    q.maxQ = q.invScale - 1.0;
+    q.errorLimit = 2.0 * q.scale;
+    return q;
+}
+
+// 候補ごとの係数 (|k| <= 0.85、clampCoeff 済み相当)
+std::vector<double> candidateCoeffs(int candidate)
+{
+    std::mt19937 rng(static_cast<uint32_t>(100 + candidate));
+    std::uniform_real_distribution<double> dist(-0.85, 0.85);
+    std::vector<double> c(kOrder);
+    for (double& v : c)
+        v = dist(rng);
+    return c;
+}
+
+std::vector<double> randomVector(int n, uint32_t seed, double range)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-range, range);
+    std::vector<double> v(static_cast<size_t>(n));
+    for (double& x : v)
+        x = dist(rng);
+    return v;
+}
+
+// 1 候補の参照再帰 (LatticeNoiseShaper::processSample の式、積和は FMA)
+std::vector<double> referenceLattice(const std::vector<double>& coeffs, const std::vector<double>& input,
+                                     const std::vector<double>& dither, const LatticeBatchQuantizer& q)
+{
+    double state[kOrder] = {};
+    std::vector<double> out(input.size());
+    for (size_t n = 0; n < input.size(); ++n)
+    {
+        double t[4];
+        for (int j = 0; j < 4; ++j)
+            t[j] = std::fma(state[j + 4], coeffs[static_cast<size_t>(j + 4)], state[j] * coeffs[static_cast<size_t>(j)]);
+        const double feedback = std::fma(state[8], coeffs[8], (t[0] + t[2]) + (t[1] + t[3]));
+
+        const double shapedInput = std::fma(input[n], kHeadroom, feedback);
+        const double dithered = std::clamp(shapedInput, q.minValue, q.maxValue) + dither[n];
+        const double quantized = std::clamp(std::nearbyint(dithered * q.invScale), q.minQ, q.maxQ) * q.scale;
+        const double error = std::clamp(quantized - shapedInput, -q.errorLimit, q.errorLimit);
+
+        double forward = error;
+        for (int i = 0; i < kOrder; ++i)
+        {
+            const double c = coeffs[static_cast<size_t>(i)];
+            const double nextForward = std::fma(c, state[i], forward);
+            const double nextBackward = std::fma(c, forward, state[i]);
+            state[i] = std::clamp(nextBackward, -2.0, 2.0);
+            forward = nextForward;
+        }
+        out[n] = quantized;
+    }
+    return out;
+}
+
+struct alignas(64) LaneStorage
+{
+    double coeffs[kOrder * kStride] = {};
+    double state[kOrder * kStride] = {};
+};
+
+void testKernelMatchesReference(KernelIsa isa, int bitDepth)
+{
+    const auto kernel = LatticeNoiseShaperBatch::kernelFor(isa);
+    const int lanes = LatticeNoiseShaperBatch::lanesFor(isa);
+    const auto q = makeQuantizer(bitDepth);
+    const auto input = randomVector(kNumSamples, 1, 0.3);
+    std::vector<double> dither = randomVector(kNumSamples, 2, 1.0);
+    for (double& d : dither)
+        d *= q.scale;
+
+    LaneStorage storage;
+    std::vector<std::vector<double>> refs;
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        const auto c = candidateCoeffs(lane);
+        for (int i = 0; i < kOrder; ++i)
+            storage.coeffs[i * kStride + lane] = c[static_cast<size_t>(i)];
+        refs.push_back(referenceLattice(c, input, dither, q));
+    }
+
+    // 2 ブロックに分けて実行 (状態の引き継ぎを含めて検証)
+    std::vector<double> shaped(static_cast<size_t>(kNumSamples) * kStride + 64);
+    const double* shapedAligned = nullptr;
+    {
+        auto* p = shaped.data();
+        while ((reinterpret_cast<uintptr_t>(p) & 63u) != 0)
+            ++p;
+        const int first = 777;
+        kernel(storage.coeffs, storage.state, input.data(), dither.data(), first, kHeadroom, q, p);
+        kernel(storage.coeffs, storage.state, input.data() + first, dither.data() + first, kNumSamples - first,
+               kHeadroom, q, p + static_cast<size_t>(first) * kStride);
+        shapedAligned = p;
+    }
+
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        double maxDiff = 0.0;
+        for (int n = 0; n < kNumSamples; ++n)
+            maxDiff = std::max(maxDiff, std::abs(shapedAligned[static_cast<size_t>(n) * kStride + static_cast<size_t>(lane)]
+                                                 - refs[static_cast<size_t>(lane)][static_cast<size_t>(n)]));
+        check(maxDiff == 0.0,
+              isaLabel(isa) + "bits=" + std::to_string(bitDepth) + " lane=" + std::to_string(lane)
+                  + " max abs diff " + std::to_string(maxDiff));
+    }
+}
+
+void testBatchClass(KernelIsa isa)
+{
+    LatticeNoiseShaperBatch batch;
+    check(!batch.isReady(), isaLabel(isa) + "default constructed is not ready");
+    check(batch.prepare(24, kNumSamples, isa), isaLabel(isa) + "prepare");
+    check(batch.laneCount() == LatticeNoiseShaperBatch::lanesFor(isa), isaLabel(isa) + "laneCount");
+
+    // レーン 0 と最終レーンに同じ係数、中間は別係数 → 両端は一致する (レーン独立)
+    const int last = batch.laneCount() - 1;
+    const auto same = candidateCoeffs(7);
+    batch.setLaneCoefficients(0, same.data());
+    batch.setLaneCoefficients(last, same.data());
+    for (int lane = 1; lane < last; ++lane)
+        batch.setLaneCoefficients(lane, candidateCoeffs(20 + lane).data());
+
+    const auto left = randomVector(kNumSamples, 3, 0.25);
+    const auto right = randomVector(kNumSamples, 4, 0.25);
+    batch.reset();
+    batch.processChannel(0, left.data(), kNumSamples, kHeadroom);
+    batch.processChannel(1, right.data(), kNumSamples, kHeadroom);
+
+    for (int ch = 0; ch < LatticeNoiseShaperBatch::kNumChannels; ++ch)
+    {
+        const double* a = batch.laneError(ch, 0);
+        const double* b = batch.laneError(ch, last);
+        const double* mid = batch.laneError(ch, 1);
+        bool identical = true;
+        bool midDiffers = false;
+        for (int n = 0; n < kNumSamples; ++n)
+        {
+            identical = identical && (a[n] == b[n]);
+            midDiffers = midDiffers || (a[n] != mid[n]);
+        }
+        check(identical, isaLabel(isa) + "equal coefficients give equal lanes ch=" + std::to_string(ch));
+        check(midDiffers, isaLabel(isa) + "different coefficients give different lanes ch=" + std::to_string(ch));
+    }
+
+    // 量子化なし: 誤差 0
+    check(batch.prepare(0, kNumSamples, isa), isaLabel(isa) + "prepare(bitDepth=0)");
+    batch.setLaneCoefficients(0, same.data());
+    batch.processChannel(0, left.data(), kNumSamples, kHeadroom);
+    bool allZero = true;
+    for (int lane = 0; lane < batch.laneCount(); ++lane)
+        for (int n = 0; n < kNumSamples; ++n)
+            allZero = allZero && batch.laneError(0, lane)[n] == 0.0;
+    check(allZero, isaLabel(isa) + "bitDepth 0 gives zero error");
+
+    batch.release();
+    check(!batch.isReady(), isaLabel(isa) + "release clears state");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[LatticeNoiseShaperBatchTests] Start\n";
+    for (KernelIsa isa : supportedIsas())
+    {
+        std::cout << "  ISA: " << convo::dsp::kernelIsaName(isa) << " lanes=" << LatticeNoiseShaperBatch::lanesFor(isa) << "\n";
+        for (int bits : { 16, 24 })
+            testKernelMatchesReference(isa, bits);
+        testBatchClass(isa);
+    }
+    std::cout << "[LatticeNoiseShaperBatchTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+//==============================================================================
+// LearnerThrottleGovernorTests.cpp
+//
+// LearnerThrottleGovernor (締切余裕 → 学習評価の絞り込み段階) のテスト。
+//   1. 余裕が十分なら段階 0 (制限なし・休止なし) のままであること
+//   2. 余裕が kBackoffSlack 未満の tick ごとに 1 段上がり、kPanicSlack 未満で最上段へ飛ぶこと
+//   3. 下げは kRecoverSlack 以上の tick が kRecoverTicks 回続いたときに 1 段ずつで、
+//      中間帯域の tick で数え直しになること
+//   4. current() が段階表どおりのワーカー数と休止を返し、reset() で段階 0 に戻ること
+// を検証する。JUCE 非依存。
+//==============================================================================
+#include "audioengine/LearnerThrottleGovernor.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Governor = convo::LearnerThrottleGovernor;
+
+void testIdleStaysUnlimited()
+{
+    Governor governor;
+    bool changed = false;
+    for (int i = 0; i < 100; ++i)
+        changed = governor.update(200) || changed;
+    const auto throttle = governor.current();
+    check(!changed && throttle.level == 0, "plenty of slack keeps level 0");
+    check(throttle.workerLimit == 0 && throttle.pauseMs == 0, "level 0 is unlimited without pauses");
+}
+
+void testBackoff()
+{
+    Governor governor;
+    check(governor.update(750), "slack below the backoff threshold steps up");
+    check(governor.current().level == 1 && governor.current().workerLimit == 4, "level 1 limits the workers to four");
+    governor.update(750);
+    check(governor.current().workerLimit == 2, "second backoff tick halves again");
+
+    // 中間帯域 (負荷 50%) は段階を保つ
+    check(!governor.update(500), "mid-band load holds the level");
+    check(governor.update(950), "slack below the panic threshold changes the level");
+    check(governor.current().level == Governor::kMaxLevel, "panic jumps to the top level");
+    check(governor.current().workerLimit == 1 && governor.current().pauseMs > 0, "top level runs one worker with pauses");
+    check(!governor.update(980), "top level cannot go higher");
+}
+
+void testRecovery()
+{
+    Governor governor;
+    governor.update(990);
+    const int top = governor.getLevel();
+
+    for (int i = 0; i < Governor::kRecoverTicks - 1; ++i)
+        governor.update(100);
+    check(governor.getLevel() == top, "recovery waits for kRecoverTicks low-load ticks");
+    governor.update(500);   // 中間帯域の tick で数え直し
+    for (int i = 0; i < Governor::kRecoverTicks - 1; ++i)
+        governor.update(100);
+    check(governor.getLevel() == top, "a mid-band tick restarts the recovery count");
+    governor.update(100);
+    check(governor.getLevel() == top - 1, "recovery steps down one level");
+
+    for (int i = 0; i < Governor::kRecoverTicks * Governor::kMaxLevel; ++i)
+        governor.update(100);
+    check(governor.getLevel() == 0, "sustained slack returns to unlimited");
+    check(governor.getLevelChangeCount() == static_cast<uint64_t>(1 + Governor::kMaxLevel), "every level change is counted");
+}
+
+void testReset()
+{
+    Governor governor;
+    governor.update(990);
+    governor.reset();
+    check(governor.current().level == 0 && governor.getLevel() == 0, "reset returns to level 0");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[LearnerThrottleGovernorTests] Start\n";
+    testIdleStaysUnlimited();
+    testBackoff();
+    testRecovery();
+    testReset();
+    std::cout << "[LearnerThrottleGovernorTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
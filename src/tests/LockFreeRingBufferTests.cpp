@@ -0,0 +1,226 @@
+//==============================================================================
+// LockFreeRingBufferTests.cpp
+//
+// LockFreeRingBuffer (LockFreeRingBuffer.h) の一括 API のテスト。
+//   1. reserveWrite が空き数と折り返し位置で打ち切られ、commitWrite するまで Consumer から見えないこと
+//   2. peekRead がスロット上の要素をそのまま返し、commitRead した分だけ Producer の空きが戻ること
+//   3. pushBulk が折り返しをまたいで書き、満杯手前では書けた数だけを返すこと
+//   4. drain が折り返しで 2 区間に分けて渡し、maxCount を守り、呼び出し中に届いた要素は次回に回すこと
+//   5. reserveWrite / commitWrite の Producer と drain の Consumer を別スレッドで回して順序が保たれること
+// JUCE / MKL 非依存 (ヘッダのみ)。
+//==============================================================================
+
+#include "LockFreeRingBuffer.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Ring = LockFreeRingBuffer<uint32_t, 8>;
+
+// 読み書き位置を offset だけ進めた空のリングにする (折り返しの試験用)
+void advanceEmpty(Ring& ring, uint32_t offset)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < offset; ++i)
+    {
+        ring.push(i);
+        ring.pop(value);
+    }
+}
+
+//------------------------------------------------------------------------------
+// 1. reserveWrite / commitWrite
+//------------------------------------------------------------------------------
+void testReserveWrite()
+{
+    Ring ring;
+    advanceEmpty(ring, 5);
+
+    size_t count = 0;
+    uint32_t* slots = ring.reserveWrite(16, count);
+    check(slots != nullptr && count == 3, "reserve stops at the wrap point");
+    for (size_t i = 0; i < count; ++i)
+        slots[i] = 100u + static_cast<uint32_t>(i);
+    check(ring.size() == 0, "reserved slots are invisible before commit");
+
+    ring.commitWrite(count);
+    check(ring.size() == 3, "commit publishes the filled slots at once");
+
+    slots = ring.reserveWrite(16, count);
+    check(slots != nullptr && count == 5, "after the wrap the reservation is bounded by free space");
+    for (size_t i = 0; i < count; ++i)
+        slots[i] = 200u + static_cast<uint32_t>(i);
+    ring.commitWrite(2);
+    check(ring.size() == 5, "committing fewer than reserved publishes only those");
+
+    uint32_t value = 0;
+    bool ordered = true;
+    const uint32_t expected[] = { 100, 101, 102, 200, 201 };
+    for (uint32_t e : expected)
+        ordered = ordered && ring.pop(value) && value == e;
+    check(ordered, "pop sees committed elements in order");
+
+    for (uint32_t i = 0; i < 8; ++i)
+        ring.push(i);
+    check(ring.reserveWrite(4, count) == nullptr && count == 0, "full ring reserves nothing");
+}
+
+//------------------------------------------------------------------------------
+// 2. peekRead / commitRead
+//------------------------------------------------------------------------------
+void testPeekRead()
+{
+    Ring ring;
+    advanceEmpty(ring, 6);
+    for (uint32_t i = 0; i < 5; ++i)
+        ring.push(10u + i);
+
+    size_t count = 0;
+    const uint32_t* items = ring.peekRead(16, count);
+    check(items != nullptr && count == 2 && items[0] == 10 && items[1] == 11, "peek returns the span up to the wrap");
+    check(ring.size() == 5, "peek does not consume");
+
+    ring.commitRead(count);
+    check(ring.size() == 3, "commitRead releases the span");
+
+    items = ring.peekRead(2, count);
+    check(items != nullptr && count == 2 && items[0] == 12 && items[1] == 13, "peek honours maxCount");
+    ring.commitRead(1);
+
+    check(ring.size() == 2, "commitRead releases only the committed count");
+
+    ring.commitRead(ring.size());
+    check(ring.peekRead(4, count) == nullptr && count == 0, "empty ring peeks nothing");
+}
+
+//------------------------------------------------------------------------------
+// 3. pushBulk
+//------------------------------------------------------------------------------
+void testPushBulk()
+{
+    Ring ring;
+    advanceEmpty(ring, 6);
+
+    const uint32_t items[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    check(ring.pushBulk(items, 5) == 5, "pushBulk writes across the wrap");
+    check(ring.pushBulk(items + 5, 5) == 3, "pushBulk returns only what fits");
+    check(ring.pushBulk(items, 1) == 0, "pushBulk on a full ring writes nothing");
+
+    uint32_t value = 0;
+    bool ordered = true;
+    for (uint32_t i = 0; i < 8; ++i)
+        ordered = ordered && ring.pop(value) && value == items[i];
+    check(ordered, "pushBulk keeps element order");
+}
+
+//------------------------------------------------------------------------------
+// 4. drain
+//------------------------------------------------------------------------------
+void testDrain()
+{
+    Ring ring;
+    advanceEmpty(ring, 5);
+    for (uint32_t i = 0; i < 6; ++i)
+        ring.push(i);
+
+    std::vector<size_t> spans;
+    std::vector<uint32_t> seen;
+    size_t drained = ring.drain([&](const uint32_t* items, size_t count)
+    {
+        spans.push_back(count);
+        seen.insert(seen.end(), items, items + count);
+    }, 4);
+    check(drained == 4 && spans.size() == 2 && spans[0] == 3 && spans[1] == 1, "drain splits at the wrap and honours maxCount");
+    check(seen == std::vector<uint32_t>({ 0, 1, 2, 3 }), "drain passes elements in order");
+    check(ring.size() == 2, "drain releases exactly what it passed");
+
+    seen.clear();
+    drained = ring.drain([&](const uint32_t* items, size_t count)
+    {
+        seen.insert(seen.end(), items, items + count);
+        ring.push(99);   // 呼び出し中に届いた要素
+    });
+    check(drained == 2 && seen == std::vector<uint32_t>({ 4, 5 }), "drain only passes the snapshot");
+    check(ring.size() == 1, "elements pushed during drain stay for the next drain");
+
+    check(ring.drain([](const uint32_t*, size_t) {}) == 1, "next drain picks up the late element");
+    check(ring.drain([](const uint32_t*, size_t) {}) == 0, "empty drain passes nothing");
+}
+
+//------------------------------------------------------------------------------
+// 5. SPSC 並行
+//------------------------------------------------------------------------------
+void testConcurrentBulk()
+{
+    static LockFreeRingBuffer<uint64_t, 64> ring;
+    constexpr uint64_t kTotal = 200000;
+
+    std::thread producer([]
+    {
+        uint64_t next = 0;
+        while (next < kTotal)
+        {
+            size_t count = 0;
+            uint64_t* slots = ring.reserveWrite(static_cast<size_t>(kTotal - next), count);
+            if (slots == nullptr)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < count; ++i)
+                slots[i] = next++;
+            ring.commitWrite(count);
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < kTotal)
+    {
+        const size_t drained = ring.drain([&](const uint64_t* items, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i, ++expected)
+                ordered = (items[i] == expected) && ordered;
+        });
+        if (drained == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+
+    check(ordered, "concurrent reserve/commit and drain keep every element in order");
+    check(ring.size() == 0, "concurrent run leaves the ring empty");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[LockFreeRingBufferTests] Start\n";
+    testReserveWrite();
+    testPeekRead();
+    testPushBulk();
+    testDrain();
+    testConcurrentBulk();
+    std::cout << "[LockFreeRingBufferTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+//==============================================================================
+// LookAheadPeakLimiterTests.cpp
+//
+// LookAheadPeakLimiter (audioengine/LookAheadPeakLimiter.h) の単体テスト。
+//   1. 閾値以下の信号は getLatencySamples() だけ遅れてそのまま出てくること (latencySamplesFor と一致)
+//   2. 過大入力でも出力が threshold を超えないこと (先読みでゲインが間に合う)
+//   3. ブロック分割に依らず出力がビット一致すること
+//   4. NaN/Inf を 0 に置換し、入力ゲインを遅延線書き込み時に掛けること
+//   5. 定常の過大正弦波で過剰に絞らず (ピークが threshold 近傍)、バースト後は release で戻ること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#include "audioengine/LookAheadPeakLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr double kThreshold = 0.8413951287507587;
+constexpr double kKnee = 0.108748;
+constexpr double kPi = 3.14159265358979323846;
+
+// blockSizes を巡回しながら全体を処理する
+void runBlocks(LookAheadPeakLimiter& limiter, std::vector<double>& l, std::vector<double>* r,
+               const std::vector<int>& blockSizes, double inputGain = 1.0)
+{
+    const int total = static_cast<int>(l.size());
+    int offset = 0;
+    size_t index = 0;
+    while (offset < total)
+    {
+        const int n = std::min(blockSizes[index++ % blockSizes.size()], total - offset);
+        limiter.processBlock(l.data() + offset, r != nullptr ? r->data() + offset : nullptr, n,
+                             inputGain, kThreshold, kKnee);
+        offset += n;
+    }
+}
+
+void testTransparentDelay()
+{
+    for (const double sampleRate : { 44100.0, 48000.0, 192000.0, 768000.0 })
+    {
+        LookAheadPeakLimiter limiter;
+        limiter.prepare(sampleRate, LookAheadPeakLimiter::kDefaultLookAheadMs, 100.0);
+        const int latency = limiter.getLatencySamples();
+
+        std::vector<double> in(4096);
+        for (size_t i = 0; i < in.size(); ++i)
+            in[i] = 0.5 * std::sin(2.0 * kPi * 1000.0 * static_cast<double>(i) / sampleRate);
+        auto l = in;
+        auto r = in;
+        runBlocks(limiter, l, &r, { 480 });
+
+        bool delayed = true;
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            const double expected = (static_cast<int>(i) < latency) ? 0.0 : in[i - static_cast<size_t>(latency)];
+            delayed = delayed && l[i] == expected && r[i] == expected;
+        }
+        const std::string rate = std::to_string(static_cast<int>(sampleRate));
+        check(delayed, "signal below threshold passes unchanged after the look-ahead delay @" + rate);
+        check(latency == LookAheadPeakLimiter::latencySamplesFor(sampleRate, LookAheadPeakLimiter::kDefaultLookAheadMs),
+              "latencySamplesFor matches the prepared instance @" + rate);
+        check(latency >= static_cast<int>(sampleRate * 0.001), "look-ahead covers at least 1 ms @" + rate);
+    }
+}
+
+void testCeiling()
+{
+    LookAheadPeakLimiter limiter;
+    limiter.prepare(48000.0, LookAheadPeakLimiter::kDefaultLookAheadMs, 100.0);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<double> l(48000), r(48000);
+    for (size_t i = 0; i < l.size(); ++i)
+    {
+        // 無音 → 単発スパイク → 大振幅ノイズ → 過大正弦波
+        const double t = static_cast<double>(i) / 48000.0;
+        if (i < 4000)
+            l[i] = r[i] = 0.0;
+        else if (i < 12000)
+            l[i] = r[i] = (i % 3001 == 0) ? 3.0 : 0.1 * noise(rng);
+        else if (i < 30000)
+        {
+            l[i] = 2.5 * noise(rng);
+            r[i] = 0.3 * noise(rng);
+        }
+        else
+        {
+            l[i] = 1.6 * std::sin(2.0 * kPi * 997.0 * t);
+            r[i] = -1.9 * std::sin(2.0 * kPi * 61.0 * t);
+        }
+    }
+
+    runBlocks(limiter, l, &r, { 1, 7, 64, 3, 480, 33 });
+    double peak = 0.0;
+    for (size_t i = 0; i < l.size(); ++i)
+        peak = std::max({ peak, std::abs(l[i]), std::abs(r[i]) });
+    check(peak <= kThreshold * (1.0 + 1.0e-12), "output never exceeds the threshold");
+    check(peak > kThreshold * 0.97, "loud input is limited close to the threshold, not far below");
+}
+
+void testBlockSplitInvariance()
+{
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> noise(-2.0, 2.0);
+    std::vector<double> l(20000), r(20000);
+    for (size_t i = 0; i < l.size(); ++i)
+    {
+        l[i] = noise(rng) * ((i / 2000) % 2 == 0 ? 1.0 : 0.2);
+        r[i] = noise(rng) * 0.5;
+    }
+
+    auto l1 = l, r1 = r, l2 = l, r2 = r, l3 = l;
+    LookAheadPeakLimiter a, b, c;
+    a.prepare(96000.0, LookAheadPeakLimiter::kDefaultLookAheadMs, 50.0);
+    b.prepare(96000.0, LookAheadPeakLimiter::kDefaultLookAheadMs, 50.0);
+    c.prepare(96000.0, LookAheadPeakLimiter::kDefaultLookAheadMs, 50.0);
+    runBlocks(a, l1, &r1, { 20000 });
+    runBlocks(b, l2, &r2, { 1, 15, 16, 17, 5, 250, 2 });
+    check(l1 == l2 && r1 == r2, "output is identical across block splits");
+
+    runBlocks(c, l3, nullptr, { 128 });
+    double peak = 0.0;
+    for (const double v : l3)
+        peak = std::max(peak, std::abs(v));
+    check(peak <= kThreshold * (1.0 + 1.0e-12), "mono path respects the threshold");
+}
+
+void testScrubAndInputGain()
+{
+    LookAheadPeakLimiter limiter;
+    limiter.prepare(48000.0, LookAheadPeakLimiter::kDefaultLookAheadMs, 100.0);
+    const int latency = limiter.getLatencySamples();
+
+    std::vector<double> l(1024, 0.25), r(1024, 0.25);
+    l[100] = std::numeric_limits<double>::quiet_NaN();
+    r[101] = std::numeric_limits<double>::infinity();
+    l[102] = -2.0e301;
+    runBlocks(limiter, l, &r, { 32 });
+
+    bool finite = true;
+    for (size_t i = 0; i < l.size(); ++i)
+        finite = finite && std::isfinite(l[i]) && std::isfinite(r[i]);
+    check(finite, "non-finite input is scrubbed");
+    check(l[static_cast<size_t>(100 + latency)] == 0.0 && r[static_cast<size_t>(101 + latency)] == 0.0
+          && l[static_cast<size_t>(102 + latency)] == 0.0, "scrubbed samples come out as zero");
+    check(l[static_cast<size_t>(latency + 10)] == 0.25, "finite neighbours are untouched");
+
+    LookAheadPeakLimiter gained;
+    gained.prepare(48000.0, LookAheadPeakLimiter::kDefaultLookAheadMs, 100.0);
+    std::vector<double> g(512, 0.5);
+    runBlocks(gained, g, nullptr, { 512 }, 0.5);
+    check(g[static_cast<size_t>(latency + 1)] == 0.25, "input gain is applied before the delay line");
+}
+
+void testRelease()
+{
+    LookAheadPeakLimiter limiter;
+    limiter.prepare(48000.0, LookAheadPeakLimiter::kDefaultLookAheadMs, 50.0);
+
+    // 0.2 秒のバースト (過大) の後、0.5 の正弦波が 1 秒続く
+    std::vector<double> l(72000);
+    for (size_t i = 0; i < l.size(); ++i)
+    {
+        const double s = std::sin(2.0 * kPi * 440.0 * static_cast<double>(i) / 48000.0);
+        l[i] = (i < 9600) ? 2.0 * s : 0.5 * s;
+    }
+    runBlocks(limiter, l, nullptr, { 256 });
+
+    const double gainDuringBurst = [&]
+    {
+        double peak = 0.0;
+        for (size_t i = 4800; i < 9600; ++i) peak = std::max(peak, std::abs(l[i]));
+        return peak / 2.0;
+    }();
+    double tailPeak = 0.0;
+    for (size_t i = 62000; i < l.size(); ++i)
+        tailPeak = std::max(tailPeak, std::abs(l[i]));
+
+    check(gainDuringBurst < 0.45, "burst is reduced");
+    check(tailPeak > 0.5 * 0.999, "gain recovers to unity after the release time");
+    check(limiter.getCurrentGain() > 0.999, "reported gain returns to unity");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[LookAheadPeakLimiterTests] Start\n";
+    testTransparentDelay();
+    testCeiling();
+    testBlockSplitInvariance();
+    testScrubAndInputGain();
+    testRelease();
+    std::cout << "[LookAheadPeakLimiterTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
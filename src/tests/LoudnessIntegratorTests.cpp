@@ -0,0 +1,144 @@
+//==============================================================================
+// LoudnessIntegratorTests.cpp
+//
+// LoudnessIntegrator (ヒストグラム法の EBU R128 集計) のテスト。
+//   1. 一定ラウドネスの信号で Momentary / Short-term / Integrated が入力値になること
+//   2. 相対ゲート (EBU Tech 3341 の -36/-23/-36 LUFS 構成) と絶対ゲート (-70 LUFS)
+//   3. LRA (EBU Tech 3342 の -20/-30 と -20/-15 LUFS 構成)
+//   4. ブロック長が 100ms の約数でなくても結果が変わらないこと、reset で空に戻ること
+// を検証する。ブロック電力 (平均二乗) を直接与えるので JUCE / MKL 非依存。
+//==============================================================================
+#include "LoudnessIntegrator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+void checkNear(double actual, double expected, double tolerance, const std::string& label)
+{
+    check(std::abs(actual - expected) <= tolerance,
+          label + " (got " + std::to_string(actual) + ", expected " + std::to_string(expected) + ")");
+}
+
+constexpr double kSampleRate = 48000.0;
+
+double lufsToMeanSquare(double lufs)
+{
+    return std::pow(10.0, (lufs + 0.691) / 10.0);
+}
+
+// lufs の一定信号を seconds 秒ぶん blockSize ごとに流す
+void feed(LoudnessIntegrator& integrator, double lufs, double seconds, int blockSize = 512)
+{
+    const double meanSquare = std::isfinite(lufs) ? lufsToMeanSquare(lufs) : 0.0;
+    auto remaining = static_cast<long long>(std::llround(seconds * kSampleRate));
+    while (remaining > 0)
+    {
+        const int n = static_cast<int>(std::min<long long>(remaining, blockSize));
+        integrator.addBlock(meanSquare, n);
+        remaining -= n;
+    }
+}
+
+void testStationary()
+{
+    LoudnessIntegrator integrator;
+    integrator.prepare(kSampleRate);
+    check(!std::isfinite(integrator.integratedLufs()), "nothing measured yet");
+
+    feed(integrator, -23.0, 20.0);
+    checkNear(integrator.momentaryLufs(), -23.0, 1.0e-9, "momentary of a constant signal");
+    checkNear(integrator.shortTermLufs(), -23.0, 1.0e-9, "short-term of a constant signal");
+    checkNear(integrator.integratedLufs(), -23.0, 1.0e-9, "integrated of a constant signal");
+    check(integrator.gatingBlockCount() == 197, "one gating block per 100ms after the first 400ms");
+    checkNear(integrator.loudnessRangeLu(), 0.0, 1.0e-9, "no range for a constant signal");
+}
+
+void testGating()
+{
+    // EBU Tech 3341 case 3: -36 / -23 / -36 LUFS → -23.0 ±0.1
+    LoudnessIntegrator integrator;
+    integrator.prepare(kSampleRate);
+    feed(integrator, -36.0, 10.0);
+    feed(integrator, -23.0, 60.0);
+    feed(integrator, -36.0, 10.0);
+    checkNear(integrator.integratedLufs(), -23.0, 0.1, "relative gate drops the quiet sections");
+
+    // 絶対ゲート: -80 LUFS と無音は数えない
+    LoudnessIntegrator gated;
+    gated.prepare(kSampleRate);
+    feed(gated, -23.0, 10.0);
+    const uint64_t blocksBefore = gated.gatingBlockCount();
+    feed(gated, -80.0, 30.0);
+    feed(gated, -std::numeric_limits<double>::infinity(), 30.0);
+    checkNear(gated.integratedLufs(), -23.0, 0.1, "absolute gate ignores -80 LUFS and silence");
+    check(gated.gatingBlockCount() <= blocksBefore + 4, "only transition blocks pass the absolute gate");
+}
+
+void testLoudnessRange()
+{
+    // EBU Tech 3342 case 1 / 2: 20s ずつの 2 レベル → LRA 10 ±1 / 5 ±1
+    LoudnessIntegrator wide;
+    wide.prepare(kSampleRate);
+    feed(wide, -20.0, 20.0);
+    feed(wide, -30.0, 20.0);
+    checkNear(wide.loudnessRangeLu(), 10.0, 1.0, "LRA of -20/-30 LUFS");
+
+    LoudnessIntegrator narrow;
+    narrow.prepare(kSampleRate);
+    feed(narrow, -20.0, 20.0);
+    feed(narrow, -15.0, 20.0);
+    checkNear(narrow.loudnessRangeLu(), 5.0, 1.0, "LRA of -20/-15 LUFS");
+}
+
+void testBlockSplittingAndReset()
+{
+    LoudnessIntegrator a, b;
+    a.prepare(kSampleRate);
+    b.prepare(kSampleRate);
+    for (double lufs : { -30.0, -18.0, -25.0, -40.0 })
+    {
+        feed(a, lufs, 7.3, 480);    // 100ms をちょうど割り切る
+        feed(b, lufs, 7.3, 333);    // 100ms の境界をまたぐ
+    }
+    checkNear(b.integratedLufs(), a.integratedLufs(), 1.0e-9, "integrated independent of block size");
+    checkNear(b.shortTermLufs(), a.shortTermLufs(), 1.0e-9, "short-term independent of block size");
+    checkNear(b.loudnessRangeLu(), a.loudnessRangeLu(), 1.0e-9, "LRA independent of block size");
+    check(a.gatingBlockCount() == b.gatingBlockCount(), "same number of gating blocks");
+
+    a.reset();
+    check(a.gatingBlockCount() == 0 && !std::isfinite(a.integratedLufs()) && !std::isfinite(a.momentaryLufs()),
+          "reset empties the histograms and windows");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[LoudnessIntegratorTests] Start\n";
+    testStationary();
+    testGating();
+    testLoudnessRange();
+    testBlockSplittingAndReset();
+    std::cout << "[LoudnessIntegratorTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -5,6 +5,14 @@
 //   MT-NUPC-01: 各レイヤーの outputDelaySamples 理論値検証
 //   MT-NUPC-02: Dirac 応答による遅延実測
 //   MT-NUPC-03: Partition Boundary テスト (2047/2048/2049)
+//   MT-NUPC-04: Zero-latency head の厳密アライメント (getLatency() = 0、L0 内の IR で
+//               任意長の呼び出し列・Reset 後とも時間領域畳み込みと 1e-9 以内で一致)
+//   MT-NUPC-05: GetMix と 旧経路 (Get + 不足分 memset + sanitize + dry/wet ミックス) の完全一致
+//               (リング折り返し・リング不足・direct head・L1/L2 遅延ライン折り返し・非有限 wet・
+//                サンプル毎 / 定数ゲイン)
+//   MT-NUPC-06: Spectral morph の m=0 / 0.5 / 1 が IR A / 0.5·A+0.5·B / IR B の畳み込みと一致し、
+//               途中で m を切り替えても整定後は切替先と一致すること。end → finish で接続資源
+//               (モーフ先スペクトル・アキュムレータ) が返り estimateReleaseBytes が接続前に戻ること
 //
 // ビルド: カスタム main() + bool testXxx() パターン
 // 依存: MKL, IPP, JUCE
@@ -16,6 +24,12 @@
 #include <cstring>
 #include <vector>
 #include <algorithm>
+#include <limits>
+#include <random>
+
+#if defined(__AVX2__)
+ #include <immintrin.h>
+#endif
 
 #include "MKLNonUniformConvolver.h"
 #include "audioengine/AtomicAccess.h"
@@ -216,6 +230,363 @@ bool testMT_NUPC_03_PartitionBoundary()
     return true;
 }
 
+// ── テスト 4: MT-NUPC-04 Zero-latency head ──
+// 時間領域の直接畳み込み (参照) の先頭 numOut サンプル
+std::vector<double> directConvolution(const std::vector<double>& x, const std::vector<double>& h, int numOut)
+{
+    std::vector<double> y(static_cast<size_t>(numOut), 0.0);
+    for (int n = 0; n < numOut; ++n) {
+        double sum = 0.0;
+        for (int k = 0; k < static_cast<int>(h.size()) && k <= n; ++k)
+            sum += h[static_cast<size_t>(k)] * x[static_cast<size_t>(n - k)];
+        y[static_cast<size_t>(n)] = sum;
+    }
+    return y;
+}
+
+// callSizes を巡回しながら Add → Get し、連結した出力を返す
+std::vector<double> runCalls(convo::MKLNonUniformConvolver& conv, const std::vector<double>& x,
+                             const std::vector<int>& callSizes)
+{
+    std::vector<double> y(x.size(), 0.0);
+    size_t pos = 0;
+    for (size_t c = 0; pos < x.size(); ++c) {
+        const int n = static_cast<int>(std::min<size_t>(static_cast<size_t>(callSizes[c % callSizes.size()]), x.size() - pos));
+        conv.Add(x.data() + pos, n);
+        conv.Get(y.data() + pos, n);
+        pos += static_cast<size_t>(n);
+    }
+    return y;
+}
+
+bool testMT_NUPC_04_ZeroLatencyHead()
+{
+    // IR は L0 に収まる長さ (既定 tailStart 85 ms@48kHz、blockSize 64 は L0 最大 2048)
+    struct Config { int irLen; int blockSize; std::vector<int> callSizes; };
+    const Config configs[] = {
+        { 1500, 480, { 480 } },
+        { 1500, 480, { 37, 480, 1, 256, 479, 13 } },
+        { 100,  480, { 480, 7 } },        // IR 全体が時間領域 FIR に収まる
+        { 2000, 64,  { 64, 17, 63 } },
+        { 4000, 2048, { 2048, 1000, 333 } },
+    };
+
+    std::mt19937 rng(132);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    bool ok = true;
+
+    for (const auto& cfg : configs) {
+        std::vector<double> ir(static_cast<size_t>(cfg.irLen));
+        for (int i = 0; i < cfg.irLen; ++i)
+            ir[static_cast<size_t>(i)] = dist(rng) * std::exp(-static_cast<double>(i) / 800.0);
+
+        convo::MKLNonUniformConvolver conv;
+        if (!conv.SetImpulse(ir.data(), cfg.irLen, cfg.blockSize, 1.0, true, nullptr)) {
+            std::fprintf(stderr, "FAIL: SetImpulse failed (irLen=%d, blockSize=%d)\n", cfg.irLen, cfg.blockSize);
+            ok = false;
+            continue;
+        }
+        if (conv.getLatency() != 0) {
+            std::fprintf(stderr, "FAIL: latency=%d with the zero-latency head\n", conv.getLatency());
+            ok = false;
+        }
+
+        // Dirac は IR そのもの、白色雑音は直接畳み込みと比較する
+        std::vector<double> dirac(static_cast<size_t>(cfg.irLen + 4096), 0.0);
+        dirac[0] = 1.0;
+        std::vector<double> noise(static_cast<size_t>(cfg.irLen * 3 + 5000));
+        for (auto& v : noise)
+            v = dist(rng);
+
+        double maxError = 0.0;
+        for (const auto* input : { &dirac, &noise }) {
+            conv.Reset();
+            const auto y = runCalls(conv, *input, cfg.callSizes);
+            const auto ref = directConvolution(*input, ir, static_cast<int>(input->size()));
+            for (size_t i = 0; i < y.size(); ++i)
+                maxError = std::max(maxError, std::abs(y[i] - ref[i]));
+        }
+
+        const bool exact = maxError < 1.0e-9;
+        ok = ok && exact;
+        std::printf("MT-NUPC-04: irLen=%d blockSize=%d head=%d calls=%zu maxError=%.3e %s\n",
+                    cfg.irLen, cfg.blockSize, convo::MKLNonUniformConvolver::resolveDirectHeadTaps(cfg.blockSize),
+                    cfg.callSizes.size(), maxError, exact ? "OK" : "FAIL");
+    }
+
+    return ok;
+}
+
+
+// ── テスト 5: MT-NUPC-05 GetMix と旧経路の一致 ──
+// 旧 ConvolverProcessor::process の sanitizeFiniteChunk と同じ判定
+void sanitizeWet(double* wet, int n, int& zeroed)
+{
+    for (int i = 0; i < n; ++i) {
+        if (!(std::isfinite(wet[i]) && std::abs(wet[i]) < 1.0e300)) {
+            wet[i] = 0.0;
+            ++zeroed;
+        }
+    }
+}
+
+// 旧 mixSmoothingSmall / mixSteadySmall と同じ式の並び (wet * wg + dry * dg)
+void mixReference(double* dst, const double* wet, const double* dry,
+                  const convo::MKLNonUniformConvolver::MixGains& g, int n)
+{
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256d vWGc = _mm256_set1_pd(g.wetConst);
+    const __m256d vDGc = _mm256_set1_pd(g.dryConst);
+    for (; i + 4 <= n; i += 4) {
+        const __m256d vWet = _mm256_loadu_pd(wet + i);
+        const __m256d vDry = _mm256_loadu_pd(dry + i);
+        const __m256d vWG = (g.wet != nullptr) ? _mm256_loadu_pd(g.wet + i) : vWGc;
+        const __m256d vDG = (g.dry != nullptr) ? _mm256_loadu_pd(g.dry + i) : vDGc;
+        _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_mul_pd(vWet, vWG), _mm256_mul_pd(vDry, vDG)));
+    }
+#endif
+    for (; i < n; ++i) {
+        const double wg = (g.wet != nullptr) ? g.wet[i] : g.wetConst;
+        const double dg = (g.dry != nullptr) ? g.dry[i] : g.dryConst;
+        dst[i] = wet[i] * wg + dry[i] * dg;
+    }
+}
+
+bool testMT_NUPC_05_GetMixMatchesLegacyPath()
+{
+    // 呼び出しは (Add サンプル数, 取り出しサンプル数) の巡回。starved は Add より多く取り出す呼び出しで
+    // リングを周期的に枯らす (L1/L2 が鳴っている区間の不足分も含む)。direct head は契約どおり同数ずつ
+    struct Config { const char* name; int irLen; int blockSize; bool directHead; bool expectShortfall;
+                    std::vector<std::pair<int, int>> calls; };
+    const Config configs[] = {
+        { "steady",      96000, 256, false, false, { {256, 256}, {37, 37}, {200, 200}, {1, 1}, {255, 255} } },
+        { "starved",     96000, 256, false, true,  { {128, 256}, {256, 128}, {64, 200}, {200, 64} } },
+        { "direct-head", 96000, 256, true,  false, { {100, 100}, {256, 256}, {13, 13}, {200, 200}, {77, 77} } },
+    };
+
+    std::mt19937 rng(143);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    bool ok = true;
+
+    for (const auto& cfg : configs) {
+        std::vector<double> ir(static_cast<size_t>(cfg.irLen));
+        for (int i = 0; i < cfg.irLen; ++i)
+            ir[static_cast<size_t>(i)] = dist(rng) * std::exp(-static_cast<double>(i) / 24000.0);
+
+        // 同じ入力列を与える 2 インスタンス: a は GetMix、b は旧経路
+        convo::MKLNonUniformConvolver a, b;
+        if (!a.SetImpulse(ir.data(), cfg.irLen, cfg.blockSize, 1.0, cfg.directHead, nullptr)
+            || !b.SetImpulse(ir.data(), cfg.irLen, cfg.blockSize, 1.0, cfg.directHead, nullptr)) {
+            std::fprintf(stderr, "FAIL: SetImpulse failed (%s)\n", cfg.name);
+            ok = false;
+            continue;
+        }
+
+        // L1/L2 遅延ラインとリングを何周もさせる長さ。途中に過大値と NaN のブロックを挟む
+        const size_t totalIn = static_cast<size_t>(cfg.irLen) * 4;
+        std::vector<double> x(totalIn);
+        for (auto& v : x)
+            v = dist(rng) * 0.5;
+        for (size_t i = totalIn / 4; i < totalIn / 4 + 64; ++i)
+            x[i] = 1.0e305;
+        x[totalIn / 2] = std::numeric_limits<double>::quiet_NaN();
+
+        std::vector<double> dry(512), wetGain(512), dryGain(512), outA(512), wetB(512), outB(512);
+        size_t pos = 0;
+        int mismatches = 0;
+        int shortfalls = 0;
+        int sanitized = 0;
+        uint64_t callIndex = 0;
+        for (size_t c = 0; pos < totalIn; ++c, ++callIndex) {
+            const auto [addSize, getSize] = cfg.calls[c % cfg.calls.size()];
+            const int toAdd = static_cast<int>(std::min<size_t>(static_cast<size_t>(addSize), totalIn - pos));
+            a.Add(x.data() + pos, toAdd);
+            b.Add(x.data() + pos, toAdd);
+            pos += static_cast<size_t>(toAdd);
+
+            for (int i = 0; i < getSize; ++i) {
+                dry[static_cast<size_t>(i)] = dist(rng);
+                wetGain[static_cast<size_t>(i)] = 0.7 + 0.3 * std::sin(0.01 * static_cast<double>(i));
+                dryGain[static_cast<size_t>(i)] = 0.4 + 0.2 * std::cos(0.013 * static_cast<double>(i));
+            }
+
+            // サンプル毎 / 定数ゲインの 4 通りを巡回する
+            convo::MKLNonUniformConvolver::MixGains gains;
+            gains.wetConst = 0.8;
+            gains.dryConst = 0.35;
+            if ((callIndex & 1) != 0) gains.wet = wetGain.data();
+            if ((callIndex & 2) != 0) gains.dry = dryGain.data();
+
+            const int gotA = a.GetMix(dry.data(), outA.data(), getSize, gains);
+
+            const int gotB = b.Get(wetB.data(), getSize);
+            if (gotB < getSize)
+                std::memset(wetB.data() + gotB, 0, static_cast<size_t>(getSize - gotB) * sizeof(double));
+            sanitizeWet(wetB.data(), getSize, sanitized);
+            mixReference(outB.data(), wetB.data(), dry.data(), gains, getSize);
+
+            if (gotA != gotB)
+                ++mismatches;
+            if (gotB < getSize)
+                ++shortfalls;
+            for (int i = 0; i < getSize; ++i)
+                if (!(outA[static_cast<size_t>(i)] == outB[static_cast<size_t>(i)]))
+                    ++mismatches;
+        }
+
+        // starved はリング不足を、全構成は非有限 wet の置換を通っていること
+        const bool coveredShortfall = !cfg.expectShortfall || shortfalls > 0;
+        const bool pass = mismatches == 0 && coveredShortfall && sanitized > 0;
+        ok = ok && pass;
+        std::printf("MT-NUPC-05: %s irLen=%d blockSize=%d head=%d shortfalls=%d sanitized=%d mismatches=%d %s\n",
+                    cfg.name, cfg.irLen, cfg.blockSize, cfg.directHead ? 1 : 0,
+                    shortfalls, sanitized, mismatches, pass ? "OK" : "FAIL");
+    }
+
+    return ok;
+}
+
+// ── テスト 6: MT-NUPC-06 Spectral morph ──
+// 同じ入力列をブロック単位で与えた出力 (Get のリング不足分はゼロのまま)。switchAt で morph の m を switchTo へ
+std::vector<double> runBlocks(convo::MKLNonUniformConvolver& conv, const std::vector<double>& x, int blockSize,
+                              size_t switchAt = 0, double switchTo = -1.0)
+{
+    std::vector<double> y(x.size(), 0.0);
+    for (size_t pos = 0; pos < x.size(); pos += static_cast<size_t>(blockSize)) {
+        if (switchTo >= 0.0 && pos == switchAt)
+            conv.setSpectralMorphAmount(switchTo);
+        const int n = static_cast<int>(std::min<size_t>(static_cast<size_t>(blockSize), x.size() - pos));
+        conv.Add(x.data() + pos, n);
+        conv.Get(y.data() + pos, n);
+    }
+    return y;
+}
+
+double maxAbsDiff(const std::vector<double>& a, const std::vector<double>& b, size_t from, size_t to)
+{
+    double err = 0.0;
+    for (size_t i = from; i < to; ++i)
+        err = std::max(err, std::abs(a[i] - b[i]));
+    return err;
+}
+
+bool testMT_NUPC_06_SpectralMorph()
+{
+    constexpr int irLen = 24000;
+    constexpr int blockSize = 256;
+    constexpr size_t totalIn = static_cast<size_t>(irLen) * 8;
+
+    std::mt19937 rng(112);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> irA(irLen), irB(irLen), irMid(irLen);
+    for (size_t i = 0; i < irA.size(); ++i) {
+        const double env = std::exp(-static_cast<double>(i) / 6000.0);
+        irA[i] = dist(rng) * env;
+        irB[i] = dist(rng) * env * 0.8;
+        irMid[i] = 0.5 * irA[i] + 0.5 * irB[i];
+    }
+    std::vector<double> x(totalIn);
+    for (auto& v : x)
+        v = dist(rng) * 0.5;
+
+    // 参照: A / B / 0.5·A+0.5·B を単独の IR として畳み込んだ出力
+    convo::MKLNonUniformConvolver refA, refB, refMid;
+    if (!refA.SetImpulse(irA.data(), irLen, blockSize, 1.0, false, nullptr)
+        || !refB.SetImpulse(irB.data(), irLen, blockSize, 1.0, false, nullptr)
+        || !refMid.SetImpulse(irMid.data(), irLen, blockSize, 1.0, false, nullptr)) {
+        std::fprintf(stderr, "FAIL: SetImpulse failed (reference)\n");
+        return false;
+    }
+    const auto yA = runBlocks(refA, x, blockSize);
+    const auto yB = runBlocks(refB, x, blockSize);
+    const auto yMid = runBlocks(refMid, x, blockSize);
+    double peak = 0.0;
+    for (double v : yA)
+        peak = std::max(peak, std::abs(v));
+    const double tol = 1.0e-9 * std::max(peak, 1.0);
+
+    // 自 IR = A、モーフ先 = B。target は begin 後に破棄する (スペクトルは conv が retain する)
+    const auto attachMorph = [&](convo::MKLNonUniformConvolver& conv) -> bool {
+        convo::MKLNonUniformConvolver target;
+        return conv.SetImpulse(irA.data(), irLen, blockSize, 1.0, false, nullptr)
+            && target.SetImpulse(irB.data(), irLen, blockSize, 1.0, false, nullptr)
+            && conv.beginSpectralMorph(target, 1);   // ramp 1 サンプル: 各レイヤーの初回パーティションで目標に達する
+    };
+
+    bool ok = true;
+
+    // 1) m 固定: 0 → A、0.5 → 0.5·A+0.5·B、1 → B
+    struct Fixed { double amount; const std::vector<double>* ref; };
+    const Fixed fixedCases[] = { { 0.0, &yA }, { 0.5, &yMid }, { 1.0, &yB } };
+    for (const auto& fc : fixedCases) {
+        convo::MKLNonUniformConvolver morph;
+        if (!attachMorph(morph)) {
+            std::fprintf(stderr, "FAIL: beginSpectralMorph failed (m=%.1f)\n", fc.amount);
+            ok = false;
+            continue;
+        }
+        morph.setSpectralMorphAmount(fc.amount);
+        const auto y = runBlocks(morph, x, blockSize);
+        const double err = maxAbsDiff(y, *fc.ref, 0, totalIn);
+        const bool pass = morph.isSpectralMorphActive() && err <= tol;
+        ok = ok && pass;
+        std::printf("MT-NUPC-06: fixed m=%.1f maxError=%.3e %s\n", fc.amount, err, pass ? "OK" : "FAIL");
+    }
+
+    // 2) m=0 で開始し中間で 1 へ: 切替前は A、全レイヤーが切替後のパーティションを出し終えた後半 1/4 は B と一致
+    {
+        convo::MKLNonUniformConvolver morph;
+        if (!attachMorph(morph)) {
+            std::fprintf(stderr, "FAIL: beginSpectralMorph failed (switch)\n");
+            ok = false;
+        } else {
+            const auto y = runBlocks(morph, x, blockSize, totalIn / 2, 1.0);
+            const double errBefore = maxAbsDiff(y, yA, 0, totalIn / 2);
+            const double errSettled = maxAbsDiff(y, yB, totalIn * 3 / 4, totalIn);
+            const bool pass = errBefore <= tol && errSettled <= tol;
+            ok = ok && pass;
+            std::printf("MT-NUPC-06: switch 0->1 maxErrorBefore=%.3e maxErrorSettled=%.3e %s\n",
+                        errBefore, errSettled, pass ? "OK" : "FAIL");
+        }
+    }
+
+    // 3) 接続・解除の資源: finish は全レイヤーが解除を観測するまで false、観測後は接続前のバイト数へ戻る
+    {
+        convo::MKLNonUniformConvolver morph;
+        bool attached = false;
+        uint64_t bytesBase = 0;
+        {
+            convo::MKLNonUniformConvolver target;
+            if (morph.SetImpulse(irA.data(), irLen, blockSize, 1.0, false, nullptr)
+                && target.SetImpulse(irB.data(), irLen, blockSize, 1.0, false, nullptr)) {
+                bytesBase = morph.estimateReleaseBytes();
+                attached = morph.beginSpectralMorph(target, 1);
+            }
+        }   // 以降はモーフ先スペクトルの最後の参照を morph が持つ
+        morph.setSpectralMorphAmount(0.5);
+        const uint64_t bytesAttached = morph.estimateReleaseBytes();
+
+        const std::vector<double> warm(x.begin(), x.begin() + irLen);
+        runBlocks(morph, warm, blockSize);
+        morph.endSpectralMorph();
+        const bool finishedEarly = morph.finishSpectralMorph();
+        runBlocks(morph, warm, blockSize);   // 最長レイヤーのパーティション境界を 1 回以上通す
+        const bool finished = morph.finishSpectralMorph();
+        const uint64_t bytesAfter = morph.estimateReleaseBytes();
+
+        const bool pass = attached && bytesAttached > bytesBase && !finishedEarly && finished
+                       && !morph.isSpectralMorphActive() && bytesAfter == bytesBase;
+        ok = ok && pass;
+        std::printf("MT-NUPC-06: attach/detach bytes base=%llu attached=%llu after=%llu finishEarly=%d finish=%d %s\n",
+                    static_cast<unsigned long long>(bytesBase), static_cast<unsigned long long>(bytesAttached),
+                    static_cast<unsigned long long>(bytesAfter), finishedEarly ? 1 : 0, finished ? 1 : 0,
+                    pass ? "OK" : "FAIL");
+    }
+
+    return ok;
+}
+
 }  // anonymous namespace
 
 // ── main ──
@@ -240,6 +611,18 @@ int main()
     allPassed &= testMT_NUPC_03_PartitionBoundary();
     std::printf("\n");
 
+    std::printf("--- MT-NUPC-04: Zero-Latency Head Alignment ---\n");
+    allPassed &= testMT_NUPC_04_ZeroLatencyHead();
+    std::printf("\n");
+
+    std::printf("--- MT-NUPC-05: GetMix vs Get + Sanitize + Mix ---\n");
+    allPassed &= testMT_NUPC_05_GetMixMatchesLegacyPath();
+    std::printf("\n");
+
+    std::printf("--- MT-NUPC-06: Spectral Morph ---\n");
+    allPassed &= testMT_NUPC_06_SpectralMorph();
+    std::printf("\n");
+
     std::printf("=== %s ===\n", allPassed ? "ALL PASSED" : "SOME FAILED");
 
     juce::shutdownJuce_GUI();
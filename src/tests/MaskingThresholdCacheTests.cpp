@@ -0,0 +1,117 @@
+//==============================================================================
+// MaskingThresholdCacheTests.cpp
+//
+// convo::MaskingThresholdCache (MaskingThresholdCache.h) のテスト。
+//   1. 内容ハッシュが同じ音声で一致し、1 サンプル・ゲイン・チャンネル入れ替えで変わること
+//   2. (ハッシュ, サンプルレート) の両方が一致したときだけヒットすること
+//   3. 容量を超えたら最も古く使ったエントリから捨てること
+// JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+#include "MaskingThresholdCache.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr int kLength = 4096;
+constexpr int kBins = 8;
+using Cache = convo::MaskingThresholdCache<kBins, 3>;
+
+Cache::Thresholds makeThresholds(double value)
+{
+    Cache::Thresholds thresholds {};
+    thresholds.fill(value);
+    return thresholds;
+}
+
+void testHash()
+{
+    std::vector<double> left(kLength), right(kLength);
+    for (int i = 0; i < kLength; ++i)
+    {
+        left[i] = 0.25 * static_cast<double>((i * 37) % 101 - 50) / 50.0;
+        right[i] = 0.5 * static_cast<double>((i * 53) % 97 - 48) / 48.0;
+    }
+
+    const auto base = convo::hashSegmentContent(left.data(), right.data(), kLength);
+    check(base == convo::hashSegmentContent(left.data(), right.data(), kLength), "hash is deterministic");
+    check(base != convo::hashSegmentContent(right.data(), left.data(), kLength), "swapping channels changes the hash");
+
+    auto changed = left;
+    changed[kLength - 1] = std::nextafter(changed[kLength - 1], 1.0);
+    check(base != convo::hashSegmentContent(changed.data(), right.data(), kLength), "one ulp in one sample changes the hash");
+
+    auto scaled = left;
+    auto scaledRight = right;
+    for (int i = 0; i < kLength; ++i)
+    {
+        scaled[i] *= 2.0;
+        scaledRight[i] *= 2.0;
+    }
+    check(base != convo::hashSegmentContent(scaled.data(), scaledRight.data(), kLength), "gain changes the hash");
+}
+
+void testLookup()
+{
+    Cache cache;
+    check(cache.find(1, 48000.0) == nullptr, "empty cache misses");
+
+    cache.store(1, 48000.0, makeThresholds(1.0));
+    const auto* hit = cache.find(1, 48000.0);
+    check(hit != nullptr && (*hit)[0] == 1.0, "stored thresholds are found");
+    check(cache.find(1, 96000.0) == nullptr, "a different sample rate misses");
+    check(cache.find(2, 48000.0) == nullptr, "a different hash misses");
+    check(cache.getHitCount() == 1 && cache.getMissCount() == 3, "hit and miss counters");
+
+    cache.clear();
+    check(cache.find(1, 48000.0) == nullptr, "clear drops all entries");
+}
+
+void testEviction()
+{
+    Cache cache;
+    cache.store(1, 48000.0, makeThresholds(1.0));
+    cache.store(2, 48000.0, makeThresholds(2.0));
+    cache.store(3, 48000.0, makeThresholds(3.0));
+
+    // 1 を使ったので最も古いのは 2
+    check(cache.find(1, 48000.0) != nullptr, "entry 1 present before eviction");
+    cache.store(4, 48000.0, makeThresholds(4.0));
+
+    check(cache.find(2, 48000.0) == nullptr, "least recently used entry is evicted");
+    check(cache.find(1, 48000.0) != nullptr, "recently used entry survives");
+    check(cache.find(3, 48000.0) != nullptr, "entry 3 survives");
+    const auto* newest = cache.find(4, 48000.0);
+    check(newest != nullptr && (*newest)[kBins - 1] == 4.0, "new entry is stored");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[MaskingThresholdCacheTests] Start\n";
+    testHash();
+    testLookup();
+    testEviction();
+    std::cout << "[MaskingThresholdCacheTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+//==============================================================================
+// MemoryLedgerTests.cpp
+//
+// convo::MemoryLedger / MemoryCharge (audioengine/MemoryLedger.h) のテスト。
+//   1. set() が差分だけを分類に反映し、同じ値の再設定では何もしないこと
+//   2. peakBytes が最大値を保ち、instances が 0 でない申告の数になること
+//   3. 破棄で申告が取り消され、ムーブで申告ごと移ること
+//   4. totalBytes() が RetirePending を含めないこと
+//   5. 複数スレッドからの申告で合計が崩れないこと
+// を検証する。台帳はプロセス共有なので、すべて開始時点からの差分で比べる。JUCE / MKL 非依存。
+//==============================================================================
+#include "audioengine/MemoryLedger.h"
+
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::MemoryCategory;
+using convo::MemoryCharge;
+using convo::MemoryLedger;
+
+uint64_t bytesOf(MemoryCategory c)
+{
+    return MemoryLedger::snapshot()[c].bytes;
+}
+
+uint32_t instancesOf(MemoryCategory c)
+{
+    return MemoryLedger::snapshot()[c].instances;
+}
+
+void testSetDelta()
+{
+    const uint64_t base = bytesOf(MemoryCategory::EqScratch);
+    MemoryCharge charge(MemoryCategory::EqScratch);
+    check(bytesOf(MemoryCategory::EqScratch) == base, "empty charge adds nothing");
+
+    charge.set(1000);
+    check(bytesOf(MemoryCategory::EqScratch) == base + 1000, "set adds bytes");
+    charge.set(1500);
+    check(bytesOf(MemoryCategory::EqScratch) == base + 1500, "grow applies the delta");
+    charge.set(400);
+    check(bytesOf(MemoryCategory::EqScratch) == base + 400, "shrink applies the delta");
+    charge.set(400);
+    check(bytesOf(MemoryCategory::EqScratch) == base + 400, "same value is a no-op");
+    check(charge.bytes() == 400 && charge.category() == MemoryCategory::EqScratch, "accessors");
+
+    charge.set(0);
+    check(bytesOf(MemoryCategory::EqScratch) == base, "set(0) clears");
+}
+
+void testPeakAndInstances()
+{
+    const auto c = MemoryCategory::AnalyzerFifo;
+    const uint32_t baseInstances = instancesOf(c);
+    const uint64_t baseBytes = bytesOf(c);
+    {
+        MemoryCharge a(c);
+        MemoryCharge b(c);
+        check(instancesOf(c) == baseInstances, "zero charges are not instances");
+
+        a.set(1u << 20);
+        b.set(1u << 20);
+        check(instancesOf(c) == baseInstances + 2, "two live instances");
+        check(MemoryLedger::snapshot()[c].peakBytes >= baseBytes + (2u << 20), "peak reached");
+
+        a.set(0);
+        check(instancesOf(c) == baseInstances + 1, "cleared charge drops its instance");
+        check(MemoryLedger::snapshot()[c].peakBytes >= baseBytes + (2u << 20), "peak survives a shrink");
+    }
+    check(instancesOf(c) == baseInstances, "destroyed charges drop their instances");
+}
+
+void testLifetimeAndMove()
+{
+    const auto c = MemoryCategory::StandbyIrPool;
+    const uint64_t base = bytesOf(c);
+    {
+        MemoryCharge fixed(c, 256);
+        check(bytesOf(c) == base + 256, "fixed-size constructor charges");
+    }
+    check(bytesOf(c) == base, "destructor releases");
+
+    std::optional<MemoryCharge> source;
+    source.emplace(c, 4096);
+    MemoryCharge moved(std::move(*source));
+    check(moved.bytes() == 4096 && source->bytes() == 0, "move transfers the charge");
+    source.reset();
+    check(bytesOf(c) == base + 4096, "moved-from destruction releases nothing");
+
+    MemoryCharge target(c, 100);
+    target = std::move(moved);
+    check(bytesOf(c) == base + 4096, "move assignment releases the old charge");
+    target.set(0);
+    check(bytesOf(c) == base, "all released");
+}
+
+void testTotalExcludesRetirePending()
+{
+    const uint64_t baseTotal = MemoryLedger::snapshot().totalBytes();
+    MemoryCharge layers(MemoryCategory::ConvolverLayers, 10000);
+    MemoryCharge retire(MemoryCategory::RetirePending, 7000);
+    const auto snap = MemoryLedger::snapshot();
+    check(snap.totalBytes() == baseTotal + 10000, "retire pending is not added to the total");
+    check(snap[MemoryCategory::RetirePending].bytes >= 7000, "retire pending is still reported");
+}
+
+void testConcurrentCharges()
+{
+    const auto c = MemoryCategory::Oversampler;
+    const uint64_t base = bytesOf(c);
+    const uint32_t baseInstances = instancesOf(c);
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 20000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        workers.emplace_back([c, t]
+        {
+            MemoryCharge charge(c);
+            for (int i = 0; i < kRounds; ++i)
+                charge.set(static_cast<uint64_t>((i * 7 + t) % 1000 + 1));
+            charge.set(100);
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    check(bytesOf(c) == base, "concurrent charges net to zero");
+    check(instancesOf(c) == baseInstances, "concurrent instances net to zero");
+    check(MemoryLedger::snapshot()[c].peakBytes >= base + 1, "peak updated under contention");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[MemoryLedgerTests] Start\n";
+    testSetDelta();
+    testPeakAndInstances();
+    testLifetimeAndMove();
+    testTotalExcludesRetirePending();
+    testConcurrentCharges();
+    std::cout << "[MemoryLedgerTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+//==============================================================================
+// MultiResolutionSpectrumTests.cpp
+//
+// convo::dsp::MultiResolutionSpectrum (dsp/MultiResolutionSpectrum.h) のテスト。
+//   1. 不正な引数では準備せず、帯域数が最下帯域レート kMinBandRate の条件どおりで、
+//      各バーが自分の周波数を通過帯域に含む最も低い帯域へ割り当てられること
+//   2. 較正: 振幅 0.5 の正弦波が 0 dB 近傍 (Hann のスカロップ以内) に出ること
+//   3. 低域の分解能: 6 Hz 離れた 40 / 46 Hz の 2 波が最下帯域で分離されること
+//   4. 折り返し: Nyquist 近傍の正弦波が間引き後の帯域 (低域のバー) に現れないこと
+//   5. push() の区切り方によらず同じ結果になること
+//   6. kHopSamples に満たない新入力では帯域の FFT をやり直さず、reset() で床値へ戻ること
+// を検証する。JUCE 非依存 (DFTI と AlignedAllocation のため MKL をリンク)。
+//==============================================================================
+#include "dsp/MultiResolutionSpectrum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::dsp::MultiResolutionSpectrum;
+
+constexpr double kPi = 3.14159265358979323846;
+
+// 20 Hz〜20 kHz の対数配置 (SpectrumAnalyzerComponent と同じ形)
+std::vector<float> logBars(int count)
+{
+    std::vector<float> bars(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+        bars[static_cast<size_t>(i)] = static_cast<float>(20.0 * std::pow(1000.0, static_cast<double>(i) / (count - 1)));
+    return bars;
+}
+
+std::vector<float> tones(int n, double rate, std::initializer_list<double> freqs)
+{
+    std::vector<float> v(static_cast<size_t>(n), 0.0f);
+    for (const double f : freqs)
+        for (int i = 0; i < n; ++i)
+            v[static_cast<size_t>(i)] += static_cast<float>(0.5 * std::sin(2.0 * kPi * f * i / rate));
+    return v;
+}
+
+std::vector<float> analyzeAll(MultiResolutionSpectrum& spectrum, const std::vector<float>& input, int numBars)
+{
+    spectrum.push(input.data(), static_cast<int>(input.size()));
+    std::vector<float> db(static_cast<size_t>(numBars));
+    check(spectrum.analyze(db.data()), "analyze succeeded");
+    return db;
+}
+
+void testPrepare()
+{
+    const auto bars = logBars(128);
+    MultiResolutionSpectrum spectrum;
+    check(!spectrum.prepare(0.0, bars.data(), 128), "prepare: zero rate rejected");
+    check(!spectrum.prepare(48000.0, bars.data(), MultiResolutionSpectrum::kMaxBars + 1), "prepare: too many bars rejected");
+    check(!spectrum.isReady(), "prepare: not ready after a rejection");
+
+    for (const double rate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        const std::string tag = std::to_string(static_cast<int>(rate));
+        check(spectrum.prepare(rate, bars.data(), 128), "prepare: " + tag);
+        const int bands = spectrum.getNumBands();
+        check(spectrum.getBandRate(bands - 1) >= MultiResolutionSpectrum::kMinBandRate
+                  && spectrum.getBandRate(bands) < MultiResolutionSpectrum::kMinBandRate,
+              "prepare: band count follows the lowest band rate at " + tag);
+
+        bool assigned = true;
+        for (int bar = 0; bar < 128; ++bar)
+        {
+            const int band = spectrum.getBandForBar(bar);
+            const double freq = bars[static_cast<size_t>(bar)];
+            const bool inside = band == 0 || freq <= MultiResolutionSpectrum::kPassbandRatio * spectrum.getBandRate(band);
+            const bool lowest = band + 1 >= bands
+                                || freq > MultiResolutionSpectrum::kPassbandRatio * spectrum.getBandRate(band + 1);
+            assigned = assigned && inside && lowest;
+        }
+        check(assigned, "prepare: each bar reads the lowest band that passes it at " + tag);
+    }
+    check(spectrum.getLongestWindowSamples() == MultiResolutionSpectrum::kFftPoints << (spectrum.getNumBands() - 1),
+          "prepare: longest window spans the lowest band");
+}
+
+void testCalibration()
+{
+    constexpr double rate = 48000.0;
+    const auto bars = logBars(128);
+    for (const double freq : { 100.0, 1000.0, 12000.0 })
+    {
+        MultiResolutionSpectrum spectrum;
+        check(spectrum.prepare(rate, bars.data(), 128), "calibration: prepared");
+        const auto db = analyzeAll(spectrum, tones(spectrum.getLongestWindowSamples() * 2, rate, { freq }), 128);
+        const float peak = *std::max_element(db.begin(), db.end());
+        check(peak > -2.0f && peak < 0.5f,
+              "calibration: " + std::to_string(static_cast<int>(freq)) + " Hz at amplitude 0.5 reads about 0 dB");
+    }
+}
+
+void testLowFrequencyResolution()
+{
+    constexpr double rate = 48000.0;
+    std::vector<float> bars;
+    for (double f = 30.0; f <= 60.0; f += 0.5)
+        bars.push_back(static_cast<float>(f));
+    const int numBars = static_cast<int>(bars.size());
+
+    MultiResolutionSpectrum spectrum;
+    check(spectrum.prepare(rate, bars.data(), numBars), "resolution: prepared");
+    const auto db = analyzeAll(spectrum, tones(spectrum.getLongestWindowSamples() * 2, rate, { 40.0, 46.0 }), numBars);
+    auto at = [&](double f) { return db[static_cast<size_t>((f - 30.0) * 2.0)]; };
+
+    // 4096 点 FFT のビン間隔 (11.7 Hz) では 1 つの山になる間隔
+    check(at(40.0) > -3.0f && at(46.0) > -3.0f, "resolution: both tones are at full level");
+    check(at(43.0) < std::min(at(40.0), at(46.0)) - 12.0f, "resolution: the gap between 40 and 46 Hz is resolved");
+}
+
+void testAliasRejection()
+{
+    constexpr double rate = 48000.0;
+    const auto bars = logBars(128);
+    MultiResolutionSpectrum spectrum;
+    check(spectrum.prepare(rate, bars.data(), 128), "alias: prepared");
+    const auto db = analyzeAll(spectrum, tones(spectrum.getLongestWindowSamples() * 2, rate, { 23000.0 }), 128);
+
+    float worst = MultiResolutionSpectrum::kFloorDb;
+    for (int bar = 0; bar < 128; ++bar)
+        if (spectrum.getBandForBar(bar) > 0)
+            worst = std::max(worst, db[static_cast<size_t>(bar)]);
+    check(worst < -80.0f, "alias: a 23 kHz tone does not fold into the decimated bands");
+}
+
+void testChunking()
+{
+    constexpr double rate = 96000.0;
+    const auto bars = logBars(128);
+    const auto input = tones(150000, rate, { 55.0, 700.0, 9000.0 });
+
+    MultiResolutionSpectrum whole;
+    MultiResolutionSpectrum chunked;
+    check(whole.prepare(rate, bars.data(), 128) && chunked.prepare(rate, bars.data(), 128), "chunking: prepared");
+    const auto reference = analyzeAll(whole, input, 128);
+
+    const int chunks[] = { 1, 37, 4096, 513, 9000, 7 };
+    size_t pos = 0;
+    for (int c = 0; pos < input.size(); ++c)
+    {
+        const int n = static_cast<int>(std::min<size_t>(static_cast<size_t>(chunks[c % 6]), input.size() - pos));
+        chunked.push(input.data() + pos, n);
+        pos += static_cast<size_t>(n);
+    }
+    std::vector<float> odd(128);
+    check(chunked.analyze(odd.data()), "chunking: analyzed");
+
+    float maxError = 0.0f;
+    for (size_t i = 0; i < odd.size(); ++i)
+        maxError = std::max(maxError, std::abs(odd[i] - reference[i]));
+    check(maxError < 1.0e-3f, "chunking: odd push lengths match a single push");
+}
+
+void testHopAndReset()
+{
+    constexpr double rate = 48000.0;
+    const auto bars = logBars(128);
+    MultiResolutionSpectrum spectrum;
+    check(spectrum.prepare(rate, bars.data(), 128), "hop: prepared");
+    const auto first = analyzeAll(spectrum, tones(spectrum.getLongestWindowSamples() * 2, rate, { 300.0 }), 128);
+
+    // 全帯域とも kHopSamples 未満の新入力: どの帯域も FFT をやり直さない
+    const auto burst = tones(MultiResolutionSpectrum::kHopSamples - 1, rate, { 5000.0 });
+    const auto second = analyzeAll(spectrum, burst, 128);
+    check(first == second, "hop: less than a hop of new input keeps every band");
+
+    spectrum.reset();
+    std::vector<float> cleared(128);
+    check(spectrum.analyze(cleared.data()), "reset: analyzed");
+    check(std::all_of(cleared.begin(), cleared.end(), [](float v) { return v == MultiResolutionSpectrum::kFloorDb; }),
+          "reset: every bar returns to the floor");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[MultiResolutionSpectrumTests] Start\n";
+    testPrepare();
+    testCalibration();
+    testLowFrequencyResolution();
+    testAliasRejection();
+    testChunking();
+    testHopAndReset();
+    std::cout << "[MultiResolutionSpectrumTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
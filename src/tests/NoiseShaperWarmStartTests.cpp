@@ -0,0 +1,127 @@
+//==============================================================================
+// NoiseShaperWarmStartTests.cpp
+//
+// convo::warmstart (NoiseShaperWarmStart.h) のテスト。
+//   1. バンク番号の分解が AudioEngine::getAdaptiveCoeffBankIndex の並びと逆写像になること
+//   2. 学習済みバンクがなければ -1、遠すぎるバンクは使わないこと
+//   3. 同レート・別モード > 隣接レート > 別ビット深度 の順に近いこと
+//   4. sigma が距離とともに広がり、既定値を超えないこと
+// JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+#include "NoiseShaperWarmStart.h"
+
+#include <iostream>
+#include <set>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using namespace convo::warmstart;
+
+// AudioEngine.Learning.cpp の kAdaptiveSupportedSampleRatesHz と同じ並び
+constexpr double kRates[kSampleRateBanks] = {
+    44100.0, 48000.0, 88200.0, 96000.0, 176400.0,
+    192000.0, 352800.0, 384000.0, 705600.0, 768000.0
+};
+
+constexpr int bankIndex(int sampleRateBank, int bitDepthIndex, int mode)
+{
+    return (sampleRateBank * kBitDepths + bitDepthIndex) * kModes + mode;
+}
+
+void testDecompose()
+{
+    bool roundTrip = true;
+    for (int sr = 0; sr < kSampleRateBanks; ++sr)
+        for (int bd = 0; bd < kBitDepths; ++bd)
+            for (int mode = 0; mode < kModes; ++mode)
+            {
+                const BankKey key = decomposeBankIndex(bankIndex(sr, bd, mode));
+                roundTrip = roundTrip && key.sampleRateBank == sr && key.bitDepthIndex == bd && key.mode == mode;
+            }
+    check(roundTrip, "decomposeBankIndex inverts the bank layout");
+}
+
+void testNoSource()
+{
+    const int target = bankIndex(2, 1, 3);
+    const Choice none = selectSourceBank(target, kRates, [](int) { return false; });
+    check(none.bankIndex < 0, "no converged bank: no warm start");
+
+    // 44.1 kHz から 768 kHz は 4 オクターブ以上離れている
+    const int far = bankIndex(9, 1, 3);
+    const Choice tooFar = selectSourceBank(bankIndex(0, 1, 3), kRates, [far](int bank) { return bank == far; });
+    check(tooFar.bankIndex < 0, "banks beyond kMaxDistance are ignored");
+
+    const Choice self = selectSourceBank(target, kRates, [target](int bank) { return bank == target; });
+    check(self.bankIndex < 0, "the target bank is never its own source");
+}
+
+void testNearestOrder()
+{
+    // 88.2 kHz / 24bit / mode 2 を学習したい
+    const int target = bankIndex(2, 1, 2);
+    const int sameRateOtherMode = bankIndex(2, 1, 4);
+    const int neighbourRate = bankIndex(3, 1, 2);       // 96 kHz
+    const int otherBitDepth = bankIndex(2, 0, 2);       // 16bit
+
+    std::set<int> converged { sameRateOtherMode, neighbourRate, otherBitDepth };
+    auto isConverged = [&converged](int bank) { return converged.count(bank) != 0; };
+
+    Choice choice = selectSourceBank(target, kRates, isConverged);
+    check(choice.bankIndex == neighbourRate, "88.2 kHz picks the trained 96 kHz bank of the same mode");
+    check(!choice.sameSampleRate, "neighbour rate does not keep covariance");
+
+    // 同レート別モード (0.25) は 96 kHz (log2(96/88.2) ~= 0.122) より遠い
+    converged.erase(neighbourRate);
+    choice = selectSourceBank(target, kRates, isConverged);
+    check(choice.bankIndex == sameRateOtherMode, "same rate, other mode is next");
+    check(choice.sameSampleRate, "same rate keeps covariance");
+
+    converged.erase(sameRateOtherMode);
+    choice = selectSourceBank(target, kRates, isConverged);
+    check(choice.bankIndex == otherBitDepth, "other bit depth is last");
+
+    // 同距離 (mode 1 と mode 3) ならバンク番号が小さい方
+    const Choice tie = selectSourceBank(target, kRates, [&](int bank)
+    {
+        return bank == bankIndex(2, 1, 1) || bank == bankIndex(2, 1, 3);
+    });
+    check(tie.bankIndex == bankIndex(2, 1, 1), "ties resolve to the lower bank index");
+}
+
+void testSigma()
+{
+    check(warmStartSigma(0.01, 0.0) == 0.03, "sigma is floored at sigmaMin");
+    check(warmStartSigma(0.04, 0.5) > warmStartSigma(0.04, 0.1), "sigma grows with distance");
+    check(warmStartSigma(0.10, kMaxDistance) <= kDefaultSigma, "sigma never exceeds the default");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[NoiseShaperWarmStartTests] Start\n";
+    testDecompose();
+    testNoSource();
+    testNearestOrder();
+    testSigma();
+    std::cout << "[NoiseShaperWarmStartTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,302 @@
+//==============================================================================
+// NucBenchmark.cpp — MKLNonUniformConvolver スループット / レイテンシーベンチマーク
+//
+// 目的:
+//   NUC (ステレオペア, AddStereo + Get) を IR 長・ブロックサイズ・サンプルレート・
+//   テール設定の組み合わせで実行し、カーネル単体 (NucCmacBenchmark) では見えない
+//   コールバック単位のコストを回帰検出できる形で記録する。
+//
+// 測定項目 (構成ごと):
+//   - nsPerSample       : 1 ステレオフレームあたりの平均処理時間 (ns)
+//   - callback mean / p99 / p99.9 / worst (us)
+//   - realtimeFactor    : ブロック周期 / 平均コールバック時間
+//   - residentBytes     : SetImpulse で MKL が確保したバイト数 (mkl_mem_stat 差分, 2ch 合計)
+//   - processAllocBytes : 処理ループ中の MKL 確保量 (0 以外は FAIL: Audio Thread 確保ゼロ保証)
+//   - tailDeadlineMisses: Tail Worker がパーティション境界に間に合わなかった回数
+//
+// 使い方:
+//   NucBenchmark [--quick] [--out=<path>]
+//   JSON を stdout (または --out のファイル) へ、進捗と判定を stderr へ出力する。
+//
+// 設計:
+//   入力は固定シードの白色雑音。IR は指数減衰雑音 (RT60 ≈ IR 長) で、
+//   partition culling が末尾を間引かない実用的な包絡にしている。
+//   処理ループは実時間ペースではなく連続実行するため、Tail Worker 構成の
+//   deadline miss は参考値 (失敗扱いにしない)。IPP FFT スペック (ippsMalloc) は
+//   residentBytes に含まれない。
+//==============================================================================
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mkl.h>
+
+#include "MKLNonUniformConvolver.h"
+
+namespace {
+
+using Nuc = convo::MKLNonUniformConvolver;
+
+enum class TailSetting { Inline, Worker, Compact, Bypass };
+
+const char* tailSettingName(TailSetting t) noexcept
+{
+    switch (t) {
+        case TailSetting::Inline:  return "inline";
+        case TailSetting::Worker:  return "worker";
+        case TailSetting::Compact: return "compact";
+        case TailSetting::Bypass:  return "bypass";
+    }
+    return "unknown";
+}
+
+struct BenchConfig {
+    double irSeconds;
+    int blockSize;
+    double sampleRate;
+    TailSetting tail;
+};
+
+struct BenchResult {
+    BenchConfig cfg;
+    bool built = false;
+    bool finite = true;
+    int irLength = 0;
+    int latency = 0;
+    int numCallbacks = 0;
+    double nsPerSample = 0.0;
+    double meanUs = 0.0;
+    double p99Us = 0.0;
+    double p999Us = 0.0;
+    double worstUs = 0.0;
+    double realtimeFactor = 0.0;
+    int64_t residentBytes = 0;
+    int64_t processAllocBytes = 0;
+    int tailDeadlineMisses = 0;
+};
+
+int64_t mklAllocatedBytes()
+{
+    int buffers = 0;
+    return static_cast<int64_t>(mkl_mem_stat(&buffers));
+}
+
+std::vector<double> makeDecayingNoiseIR(int irLength, uint32_t seed)
+{
+    std::vector<double> ir(static_cast<size_t>(irLength));
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    // RT60 = IR 長: 末尾で -60 dB
+    const double decayPerSample = std::log(1.0e-3) / std::max(1.0, static_cast<double>(irLength));
+    for (int i = 0; i < irLength; ++i)
+        ir[static_cast<size_t>(i)] = dist(rng) * std::exp(decayPerSample * i) * 0.05;
+    ir[0] = 1.0;  // 直接音
+    return ir;
+}
+
+convo::FilterSpec makeFilterSpec(const BenchConfig& cfg)
+{
+    convo::FilterSpec spec;
+    spec.sampleRate = cfg.sampleRate;
+    spec.tailWorkerOffload = (cfg.tail == TailSetting::Worker);
+    spec.compactTailSpectra = (cfg.tail == TailSetting::Compact);
+    spec.tailEnabled = (cfg.tail != TailSetting::Bypass);
+    return spec;
+}
+
+double percentileUs(const std::vector<double>& sortedNs, double q)
+{
+    if (sortedNs.empty())
+        return 0.0;
+    const size_t idx = std::min(sortedNs.size() - 1,
+                                static_cast<size_t>(std::ceil(q * static_cast<double>(sortedNs.size()))) - 1);
+    return sortedNs[idx] * 1.0e-3;
+}
+
+BenchResult runConfig(const BenchConfig& cfg, double minSeconds, uint32_t seed)
+{
+    using Clock = std::chrono::steady_clock;
+
+    BenchResult r;
+    r.cfg = cfg;
+    r.irLength = std::max(1, static_cast<int>(std::lround(cfg.irSeconds * cfg.sampleRate)));
+
+    const std::vector<double> irL = makeDecayingNoiseIR(r.irLength, seed);
+    const std::vector<double> irR = makeDecayingNoiseIR(r.irLength, seed + 1);
+    const convo::FilterSpec spec = makeFilterSpec(cfg);
+
+    Nuc left;
+    Nuc right;
+
+    const int64_t bytesBeforeBuild = mklAllocatedBytes();
+    if (!left.SetImpulse(irL.data(), r.irLength, cfg.blockSize, 1.0, false, &spec)
+        || !right.SetImpulse(irR.data(), r.irLength, cfg.blockSize, 1.0, false, &spec))
+        return r;
+    r.built = true;
+    r.residentBytes = mklAllocatedBytes() - bytesBeforeBuild;
+    r.latency = left.getLatency();
+
+    // 全レイヤーが少なくとも 1 周するよう IR 長の 2 倍以上は回す
+    const int64_t minSamples = std::max<int64_t>(static_cast<int64_t>(r.irLength) * 2,
+                                                  static_cast<int64_t>(minSeconds * cfg.sampleRate));
+    r.numCallbacks = static_cast<int>((minSamples + cfg.blockSize - 1) / cfg.blockSize);
+
+    // ループ外で事前確保 (ループ内の確保を計測に混ぜない)
+    std::vector<double> inL(static_cast<size_t>(cfg.blockSize));
+    std::vector<double> inR(static_cast<size_t>(cfg.blockSize));
+    std::vector<double> outL(static_cast<size_t>(cfg.blockSize));
+    std::vector<double> outR(static_cast<size_t>(cfg.blockSize));
+    std::vector<double> callbackNs(static_cast<size_t>(r.numCallbacks));
+    std::mt19937 rng(seed + 2);
+    std::uniform_real_distribution<double> dist(-0.5, 0.5);
+
+    auto processBlock = [&]() {
+        Nuc::AddStereo(left, right, inL.data(), inR.data(), cfg.blockSize);
+        left.Get(outL.data(), cfg.blockSize);
+        right.Get(outR.data(), cfg.blockSize);
+    };
+
+    // ウォームアップ (キャッシュ/周波数安定化, Tail Worker 起動)
+    for (int i = 0; i < 8; ++i) {
+        for (int n = 0; n < cfg.blockSize; ++n) {
+            inL[static_cast<size_t>(n)] = dist(rng);
+            inR[static_cast<size_t>(n)] = dist(rng);
+        }
+        processBlock();
+    }
+
+    const int missesBefore = left.getTailDeadlineMissCount() + right.getTailDeadlineMissCount();
+    const int64_t bytesBeforeProcess = mklAllocatedBytes();
+    double totalNs = 0.0;
+    for (int cb = 0; cb < r.numCallbacks; ++cb) {
+        for (int n = 0; n < cfg.blockSize; ++n) {
+            inL[static_cast<size_t>(n)] = dist(rng);
+            inR[static_cast<size_t>(n)] = dist(rng);
+        }
+
+        const auto start = Clock::now();
+        processBlock();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        callbackNs[static_cast<size_t>(cb)] = ns;
+        totalNs += ns;
+
+        if (!std::isfinite(outL[0]) || !std::isfinite(outR[static_cast<size_t>(cfg.blockSize - 1)]))
+            r.finite = false;
+    }
+    r.processAllocBytes = mklAllocatedBytes() - bytesBeforeProcess;
+    r.tailDeadlineMisses = left.getTailDeadlineMissCount() + right.getTailDeadlineMissCount() - missesBefore;
+
+    std::sort(callbackNs.begin(), callbackNs.end());
+    const double totalSamples = static_cast<double>(r.numCallbacks) * static_cast<double>(cfg.blockSize);
+    r.nsPerSample = totalNs / totalSamples;
+    r.meanUs = totalNs / static_cast<double>(r.numCallbacks) * 1.0e-3;
+    r.p99Us = percentileUs(callbackNs, 0.99);
+    r.p999Us = percentileUs(callbackNs, 0.999);
+    r.worstUs = callbackNs.back() * 1.0e-3;
+    const double blockPeriodUs = static_cast<double>(cfg.blockSize) / cfg.sampleRate * 1.0e6;
+    r.realtimeFactor = (r.meanUs > 0.0) ? blockPeriodUs / r.meanUs : 0.0;
+    return r;
+}
+
+bool resultPassed(const BenchResult& r) noexcept
+{
+    return r.built && r.finite && r.processAllocBytes == 0;
+}
+
+void writeJson(std::FILE* out, const std::vector<BenchResult>& results, bool quickMode, bool allPassed)
+{
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"benchmark\": \"NucBenchmark\",\n");
+    std::fprintf(out, "  \"mode\": \"%s\",\n", quickMode ? "quick" : "full");
+    std::fprintf(out, "  \"cmacKernel\": \"%s\",\n",
+                 Nuc::getCmacKernel() == Nuc::CmacKernel::Avx512 ? "avx512" : "avx2");
+    std::fprintf(out, "  \"passed\": %s,\n", allPassed ? "true" : "false");
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        std::fprintf(out,
+                     "    {\"irSeconds\": %.3f, \"irLength\": %d, \"blockSize\": %d, \"sampleRate\": %.0f, "
+                     "\"tail\": \"%s\", \"built\": %s, \"finite\": %s, \"latency\": %d, \"callbacks\": %d, "
+                     "\"nsPerSample\": %.3f, \"callbackMeanUs\": %.3f, \"callbackP99Us\": %.3f, "
+                     "\"callbackP999Us\": %.3f, \"callbackWorstUs\": %.3f, \"realtimeFactor\": %.2f, "
+                     "\"residentBytes\": %lld, \"processAllocBytes\": %lld, \"tailDeadlineMisses\": %d}%s\n",
+                     r.cfg.irSeconds, r.irLength, r.cfg.blockSize, r.cfg.sampleRate,
+                     tailSettingName(r.cfg.tail), r.built ? "true" : "false", r.finite ? "true" : "false",
+                     r.latency, r.numCallbacks,
+                     r.nsPerSample, r.meanUs, r.p99Us, r.p999Us, r.worstUs, r.realtimeFactor,
+                     static_cast<long long>(r.residentBytes), static_cast<long long>(r.processAllocBytes),
+                     r.tailDeadlineMisses, (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(out, "  ]\n");
+    std::fprintf(out, "}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bool quickMode = false;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg == "--quick") quickMode = true;
+        else if (arg.rfind("--out=", 0) == 0) outPath = arg.substr(6);
+    }
+
+    // ★ JUCE メッセージスレッド初期化 (MKLNonUniformConvolver::releaseAllLayers 必要)
+    juce::initialiseJuce_GUI();
+
+    std::vector<double> irSecondsList = { 0.5, 2.0, 6.0 };
+    std::vector<int> blockSizes = { 64, 256, 1024 };
+    std::vector<double> sampleRates = { 48000.0, 96000.0, 192000.0 };
+    std::vector<TailSetting> tails = { TailSetting::Inline, TailSetting::Worker, TailSetting::Compact, TailSetting::Bypass };
+    if (quickMode) {
+        irSecondsList = { 1.0 };
+        blockSizes = { 64, 512 };
+        sampleRates = { 48000.0 };
+    }
+    const double minSeconds = quickMode ? 0.5 : 4.0;
+
+    std::vector<BenchResult> results;
+    bool allPassed = true;
+    uint32_t seed = 1;
+    for (const double irSeconds : irSecondsList)
+        for (const double sampleRate : sampleRates)
+            for (const int blockSize : blockSizes)
+                for (const TailSetting tail : tails) {
+                    const BenchConfig cfg { irSeconds, blockSize, sampleRate, tail };
+                    BenchResult r = runConfig(cfg, minSeconds, seed);
+                    seed += 3;
+
+                    const bool ok = resultPassed(r);
+                    allPassed &= ok;
+                    std::fprintf(stderr, "  [%s] ir=%.1fs sr=%.0f bs=%d tail=%s ns/sample=%.2f p99=%.1fus worst=%.1fus\n",
+                                 ok ? "OK" : "FAIL", irSeconds, sampleRate, blockSize, tailSettingName(tail),
+                                 r.nsPerSample, r.p99Us, r.worstUs);
+                    results.push_back(r);
+                }
+
+    std::FILE* out = stdout;
+    if (!outPath.empty()) {
+        out = std::fopen(outPath.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "cannot open %s\n", outPath.c_str());
+            out = stdout;
+        }
+    }
+    writeJson(out, results, quickMode, allPassed);
+    if (out != stdout)
+        std::fclose(out);
+
+    std::fprintf(stderr, "=== %s ===\n", allPassed ? "ALL PASSED" : "SOME FAILED");
+
+    juce::shutdownJuce_GUI();
+    return allPassed ? 0 : 1;
+}
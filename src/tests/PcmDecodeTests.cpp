@@ -0,0 +1,260 @@
+//==============================================================================
+// PcmDecodeTests.cpp
+//
+// PcmDecode (メモリマップした WAV / AIFF の直接展開) のテスト。
+//   1. WAV PCM 16/24/32 と float 32/64 のヘッダ解析と展開値
+//   2. WAVE_FORMAT_EXTENSIBLE と、data より前の余分なチャンク
+//   3. AIFF (ビッグエンディアン) / AIFC sowt (リトルエンディアン) と 80bit サンプルレート
+//   4. 区間展開 (begin / count) が全体展開の部分列に一致すること (SIMD 本体と端数の境界)
+//   5. 対象外の形式を拒否すること
+// を検証する。JUCE 非依存。
+//==============================================================================
+#include "core/PcmDecode.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::PcmDecode;
+using convo::PcmLayout;
+
+void putLE(std::vector<uint8_t>& b, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        b.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putBE(std::vector<uint8_t>& b, uint64_t v, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; --i)
+        b.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putTag(std::vector<uint8_t>& b, const char* tag)
+{
+    for (int i = 0; i < 4; ++i)
+        b.push_back(static_cast<uint8_t>(tag[i]));
+}
+
+// チャンネル ch・フレーム i の期待値 (各形式で正確に表せる値)
+double expectedSample(int ch, int i, int bits, bool isFloat)
+{
+    const double v = std::sin(0.05 * i + ch) * 0.9;
+    if (isFloat)
+        return bits == 32 ? static_cast<double>(static_cast<float>(v)) : v;
+    const double full = static_cast<double>(1u << (bits - 1));
+    return std::floor(v * full) / full;
+}
+
+uint64_t encodeSample(double v, int bits, bool isFloat)
+{
+    if (isFloat && bits == 32)
+    {
+        const float f = static_cast<float>(v);
+        uint32_t u = 0;
+        std::memcpy(&u, &f, 4);
+        return u;
+    }
+    if (isFloat)
+    {
+        uint64_t u = 0;
+        std::memcpy(&u, &v, 8);
+        return u;
+    }
+    const int64_t q = static_cast<int64_t>(std::llround(v * static_cast<double>(1u << (bits - 1))));
+    return static_cast<uint64_t>(q) & ((bits == 64) ? ~0ull : ((1ull << bits) - 1));
+}
+
+std::vector<uint8_t> makeWav(int channels, int frames, int bits, bool isFloat, bool extensible, bool extraChunk)
+{
+    std::vector<uint8_t> b;
+    putTag(b, "RIFF");
+    putLE(b, 0, 4);
+    putTag(b, "WAVE");
+    if (extraChunk)
+    {
+        putTag(b, "LIST");
+        putLE(b, 3, 4);
+        b.insert(b.end(), { 'a', 'b', 'c', 0 });  // 奇数長 + パディング
+    }
+    const int blockAlign = channels * bits / 8;
+    putTag(b, "fmt ");
+    putLE(b, extensible ? 40 : 16, 4);
+    putLE(b, extensible ? 0xFFFE : (isFloat ? 3 : 1), 2);
+    putLE(b, static_cast<uint64_t>(channels), 2);
+    putLE(b, 48000, 4);
+    putLE(b, static_cast<uint64_t>(48000 * blockAlign), 4);
+    putLE(b, static_cast<uint64_t>(blockAlign), 2);
+    putLE(b, static_cast<uint64_t>(bits), 2);
+    if (extensible)
+    {
+        putLE(b, 22, 2);
+        putLE(b, static_cast<uint64_t>(bits), 2);
+        putLE(b, 0, 4);
+        putLE(b, isFloat ? 3 : 1, 2);
+        b.insert(b.end(), 14, 0);
+    }
+    putTag(b, "data");
+    putLE(b, static_cast<uint64_t>(frames * blockAlign), 4);
+    for (int i = 0; i < frames; ++i)
+        for (int ch = 0; ch < channels; ++ch)
+            putLE(b, encodeSample(expectedSample(ch, i, bits, isFloat), bits, isFloat), bits / 8);
+    return b;
+}
+
+std::vector<uint8_t> makeAiff(int channels, int frames, int bits, bool sowt)
+{
+    std::vector<uint8_t> b;
+    putTag(b, "FORM");
+    putBE(b, 0, 4);
+    putTag(b, sowt ? "AIFC" : "AIFF");
+    putTag(b, "COMM");
+    putBE(b, sowt ? 24 : 18, 4);
+    putBE(b, static_cast<uint64_t>(channels), 2);
+    putBE(b, static_cast<uint64_t>(frames), 4);
+    putBE(b, static_cast<uint64_t>(bits), 2);
+    // 44100 = 0xAC44 → 指数 16383 + 15, 仮数 0xAC44 << 48
+    putBE(b, 0x400E, 2);
+    putBE(b, 0xAC44ull << 48, 8);
+    if (sowt)
+    {
+        putTag(b, "sowt");
+        b.insert(b.end(), { 0, 0 });  // 空の pstring
+    }
+    putTag(b, "SSND");
+    putBE(b, static_cast<uint64_t>(8 + frames * channels * bits / 8), 4);
+    putBE(b, 0, 4);
+    putBE(b, 0, 4);
+    for (int i = 0; i < frames; ++i)
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            const uint64_t s = encodeSample(expectedSample(ch, i, bits, false), bits, false);
+            if (sowt)
+                putLE(b, s, bits / 8);
+            else
+                putBE(b, s, bits / 8);
+        }
+    return b;
+}
+
+bool decodesExactly(const std::vector<uint8_t>& file, int channels, int frames, int bits, bool isFloat)
+{
+    PcmLayout layout;
+    if (!PcmDecode::parse(file.data(), file.size(), layout))
+        return false;
+    if (layout.numChannels != channels || layout.numFrames != static_cast<uint64_t>(frames) || layout.bitsPerSample != bits)
+        return false;
+    std::vector<double> dst(static_cast<size_t>(frames));
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        PcmDecode::decodeChannel(file.data() + layout.dataOffset, layout, ch, 0, layout.numFrames, dst.data());
+        for (int i = 0; i < frames; ++i)
+            if (dst[static_cast<size_t>(i)] != expectedSample(ch, i, bits, isFloat))
+                return false;
+    }
+    return true;
+}
+
+void testWavFormats()
+{
+    for (const int bits : { 16, 24, 32 })
+        check(decodesExactly(makeWav(2, 37, bits, false, false, false), 2, 37, bits, false),
+              "WAV PCM " + std::to_string(bits) + " decodes exactly");
+    check(decodesExactly(makeWav(3, 29, 32, true, false, false), 3, 29, 32, true), "WAV float32 decodes exactly");
+    check(decodesExactly(makeWav(2, 11, 64, true, false, false), 2, 11, 64, true), "WAV float64 decodes exactly");
+
+    PcmLayout layout;
+    const auto wav = makeWav(1, 8, 24, false, false, false);
+    check(PcmDecode::parse(wav.data(), wav.size(), layout) && layout.sampleRate == 48000.0 && layout.dataOffset == 44,
+          "WAV sample rate and data offset");
+}
+
+void testWavExtensibleAndChunks()
+{
+    check(decodesExactly(makeWav(4, 41, 24, false, true, false), 4, 41, 24, false), "WAV extensible PCM 24");
+    check(decodesExactly(makeWav(2, 19, 32, true, true, true), 2, 19, 32, true), "WAV extensible float after odd LIST chunk");
+}
+
+void testAiff()
+{
+    for (const int bits : { 16, 24, 32 })
+    {
+        check(decodesExactly(makeAiff(2, 23, bits, false), 2, 23, bits, false), "AIFF big-endian " + std::to_string(bits));
+        check(decodesExactly(makeAiff(2, 23, bits, true), 2, 23, bits, false), "AIFC sowt " + std::to_string(bits));
+    }
+    PcmLayout layout;
+    const auto aiff = makeAiff(1, 4, 16, false);
+    check(PcmDecode::parse(aiff.data(), aiff.size(), layout) && layout.sampleRate == 44100.0 && layout.bigEndian,
+          "AIFF 80-bit sample rate");
+}
+
+void testRangeDecodeMatchesWhole()
+{
+    const int frames = 100;
+    const auto wav = makeWav(3, frames, 24, false, false, false);
+    PcmLayout layout;
+    check(PcmDecode::parse(wav.data(), wav.size(), layout), "range test parses");
+    std::vector<double> whole(frames), part(frames, 0.0);
+    PcmDecode::decodeChannel(wav.data() + layout.dataOffset, layout, 1, 0, frames, whole.data());
+    // SIMD 本体 (8 本単位) と端数が混ざる区間分割
+    const int cuts[] = { 0, 3, 19, 20, 57, 100 };
+    for (int c = 0; c + 1 < 6; ++c)
+        PcmDecode::decodeChannel(wav.data() + layout.dataOffset, layout, 1,
+                                 static_cast<uint64_t>(cuts[c]), static_cast<uint64_t>(cuts[c + 1] - cuts[c]),
+                                 part.data() + cuts[c]);
+    check(part == whole, "ranged decode equals whole decode");
+}
+
+void testRejectsUnsupported()
+{
+    PcmLayout layout;
+    auto wav8 = makeWav(1, 16, 16, false, false, false);
+    wav8[34] = 8;       // bitsPerSample
+    wav8[32] = 1;       // blockAlign
+    check(!PcmDecode::parse(wav8.data(), wav8.size(), layout), "8-bit WAV is rejected");
+
+    auto adpcm = makeWav(1, 16, 16, false, false, false);
+    adpcm[20] = 2;      // formatTag = ADPCM
+    check(!PcmDecode::parse(adpcm.data(), adpcm.size(), layout), "compressed WAV is rejected");
+
+    const std::vector<uint8_t> junk(64, 0x5A);
+    check(!PcmDecode::parse(junk.data(), junk.size(), layout), "non-audio data is rejected");
+
+    auto truncated = makeWav(2, 16, 24, false, false, false);
+    truncated.resize(40);
+    check(!PcmDecode::parse(truncated.data(), truncated.size(), layout), "file without data chunk is rejected");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[PcmDecodeTests] Start\n";
+    testWavFormats();
+    testWavExtensibleAndChunks();
+    testAiff();
+    testRangeDecodeMatchesWhole();
+    testRejectsUnsupported();
+    std::cout << "[PcmDecodeTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+//==============================================================================
+// PipelinedStageTests.cpp
+//
+// convo::PipelinedStage (audioengine/PipelinedStage.h) の単体テスト。
+//   1. 可変長ブロックを流しても、出力が「段を直列に回した出力列」をちょうど blockSamples
+//      サンプル遅らせたものとビット一致すること (段の状態はジョブの発行順に進む)
+//   2. 段が期限に間に合わないブロックは無音で代替され、以降は遅延どおりに復帰すること
+//      (空き slot が無いときは入力ブロックを捨てて数えること)
+//   3. 上限超えのブロック・停止中は受け付けず、restart() で遅延リングが無音に戻ること
+//   4. ワーカー先頭 / 終了時のフックが 1 回ずつ呼ばれること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#include "audioengine/PipelinedStage.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::PipelinedStage;
+
+// 状態を持つ段: 1 次 IIR (y = x + 0.5·y[-1]) をチャンネルごとに。stallJob 番目のジョブでは stall が下りるまで止まる
+struct OnePoleStage
+{
+    double state[2] {};
+    int jobsProcessed = 0;
+    int stallJob = -1;
+    std::atomic<bool> stall { false };
+    std::atomic<int> threadStarts { 0 };
+    std::atomic<int> threadExits { 0 };
+
+    void run(double* const* channels, int numChannels, int numSamples) noexcept
+    {
+        if (jobsProcessed++ == stallJob)
+            while (stall.load(std::memory_order_acquire))
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                channels[ch][i] = state[ch] = channels[ch][i] + 0.5 * state[ch];
+    }
+
+    static PipelinedStage::Callbacks callbacksFor(OnePoleStage& stage)
+    {
+        PipelinedStage::Callbacks callbacks;
+        callbacks.process = [](void* context, double* const* channels, int numChannels, int numSamples) noexcept
+        {
+            static_cast<OnePoleStage*>(context)->run(channels, numChannels, numSamples);
+        };
+        callbacks.onThreadStart = [](void* context) noexcept { ++static_cast<OnePoleStage*>(context)->threadStarts; };
+        callbacks.onThreadExit = [](void* context) noexcept { ++static_cast<OnePoleStage*>(context)->threadExits; };
+        callbacks.context = &stage;
+        return callbacks;
+    }
+};
+
+// 段を直列に回した出力列を latency サンプル遅らせたもの
+std::vector<double> delayedReference(const std::vector<double>& input, int latency)
+{
+    std::vector<double> out(input.size(), 0.0);
+    double state = 0.0;
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        state = input[i] + 0.5 * state;
+        if (i + static_cast<size_t>(latency) < out.size())
+            out[i + static_cast<size_t>(latency)] = state;
+    }
+    return out;
+}
+
+struct Stream
+{
+    std::vector<double> inL, inR, outL, outR;
+    std::vector<int> blockStarts;
+};
+
+// 入力を blockSizes の長さで順に process へ渡す。afterBlock(index) はブロックごとに呼ぶ
+template <typename AfterBlock>
+Stream runStream(PipelinedStage& pipeline, const std::vector<int>& blockSizes, unsigned seed, AfterBlock afterBlock)
+{
+    Stream s;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    int pos = 0;
+    for (size_t b = 0; b < blockSizes.size(); ++b)
+    {
+        const int n = blockSizes[b];
+        std::vector<double> l(static_cast<size_t>(n)), r(static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i)
+        {
+            l[static_cast<size_t>(i)] = dist(rng);
+            r[static_cast<size_t>(i)] = dist(rng);
+        }
+        s.inL.insert(s.inL.end(), l.begin(), l.end());
+        s.inR.insert(s.inR.end(), r.begin(), r.end());
+        double* channels[2] = { l.data(), r.data() };
+        pipeline.process(channels, 2, n);
+        s.outL.insert(s.outL.end(), l.begin(), l.end());
+        s.outR.insert(s.outR.end(), r.begin(), r.end());
+        s.blockStarts.push_back(pos);
+        pos += n;
+        afterBlock(b);
+    }
+    return s;
+}
+
+void testDelayIsExact()
+{
+    constexpr int kBlock = 96;
+    OnePoleStage stage;
+    PipelinedStage pipeline;
+    // 低いサンプルレート = 長い待ち上限 (96 サンプルで 48 ms)。期限切れを起こさない
+    check(pipeline.start(OnePoleStage::callbacksFor(stage), 2, kBlock, 1000.0), "pipeline starts");
+    check(pipeline.getLatencySamples() == kBlock, "latency is one block");
+
+    std::vector<int> sizes;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> sizeDist(1, kBlock);
+    for (int b = 0; b < 300; ++b)
+        sizes.push_back((b % 5 == 0) ? kBlock : sizeDist(rng));
+
+    const Stream s = runStream(pipeline, sizes, 11, [](size_t) {});
+    check(s.outL == delayedReference(s.inL, kBlock) && s.outR == delayedReference(s.inR, kBlock),
+          "variable-size blocks come out exactly one block late");
+    check(pipeline.getMissedBlocks() == 0 && pipeline.getDroppedBlocks() == 0, "no deadline misses on an idle stage");
+}
+
+void testMissedBlockIsSilenced()
+{
+    constexpr int kBlock = 64;
+    constexpr int kStallBlock = 10;
+    OnePoleStage stage;
+    stage.stallJob = kStallBlock;
+    stage.stall.store(true);
+    PipelinedStage pipeline;
+    // 高いサンプルレート = 待ち上限はほぼ 0
+    pipeline.start(OnePoleStage::callbacksFor(stage), 2, kBlock, 1.0e9);
+
+    const std::vector<int> sizes(40, kBlock);
+    const Stream s = runStream(pipeline, sizes, 5, [&](size_t b)
+    {
+        if (b == kStallBlock + 1)
+            stage.stall.store(false, std::memory_order_release); // ブロック 10 の回収は期限切れ済み
+        // それ以外のブロックはワーカーに 1 周期ぶん余裕を与える
+        std::this_thread::sleep_for(std::chrono::milliseconds(b == kStallBlock + 1 ? 50 : 2));
+    });
+
+    check(pipeline.getMissedBlocks() == 1, "the stalled block is counted as missed");
+    check(pipeline.getDroppedBlocks() == 0, "no input blocks dropped");
+
+    // 期限切れブロックの出力位置 (kStallBlock の 1 ブロック後) だけが無音、他は遅延どおり
+    const std::vector<double> ref = delayedReference(s.inL, kBlock);
+    const size_t silentBegin = static_cast<size_t>((kStallBlock + 1) * kBlock);
+    const size_t silentEnd = silentBegin + kBlock;
+    bool silent = true;
+    bool others = true;
+    for (size_t i = 0; i < ref.size(); ++i)
+    {
+        if (i >= silentBegin && i < silentEnd)
+            silent = silent && s.outL[i] == 0.0;
+        else
+            others = others && s.outL[i] == ref[i];
+    }
+    check(silent, "a missed block is replaced by silence");
+    check(others, "the stream stays one block late around the missed block");
+}
+
+void testSlotOverflowDropsInput()
+{
+    constexpr int kBlock = 32;
+    OnePoleStage stage;
+    stage.stallJob = 0;
+    stage.stall.store(true);
+    PipelinedStage pipeline;
+    pipeline.start(OnePoleStage::callbacksFor(stage), 2, kBlock, 1.0e9);
+
+    // ジョブ 0 で止まっている間: 2 本目までは slot に入り、3 本目は捨てられる
+    const std::vector<int> sizes(3, kBlock);
+    const Stream s = runStream(pipeline, sizes, 9, [](size_t) {});
+    check(pipeline.getDroppedBlocks() == 1, "input is dropped when both slots are busy");
+    check(pipeline.getMissedBlocks() == 2, "both pending blocks miss their deadline");
+
+    stage.stall.store(false, std::memory_order_release);
+    pipeline.drain();
+    bool allSilent = true;
+    for (const double v : s.outL)
+        allSilent = allSilent && v == 0.0;
+    check(allSilent, "stalled and dropped blocks are silent");
+    check(stage.jobsProcessed == 2, "drain waits for every submitted job");
+}
+
+void testRejectAndRestart()
+{
+    constexpr int kBlock = 16;
+    OnePoleStage stage;
+    PipelinedStage pipeline;
+
+    std::vector<double> l(kBlock * 2, 1.0), r(kBlock * 2, 1.0);
+    double* channels[2] = { l.data(), r.data() };
+    check(!pipeline.process(channels, 2, kBlock), "a stopped pipeline rejects blocks");
+    check(pipeline.getLatencySamples() == 0, "a stopped pipeline reports no latency");
+
+    check(!pipeline.start(OnePoleStage::callbacksFor(stage), 3, kBlock, 48000.0), "more than two channels is rejected");
+    pipeline.start(OnePoleStage::callbacksFor(stage), 2, kBlock, 1000.0);
+    check(!pipeline.process(channels, 2, kBlock + 1), "blocks longer than the latency are rejected");
+    check(!pipeline.process(channels, 1, kBlock), "channel count must match");
+    check(l[0] == 1.0, "a rejected block is left untouched");
+
+    pipeline.process(channels, 2, kBlock);
+    pipeline.process(channels, 2, kBlock);
+    check(l[0] != 0.0, "second block carries the first block's output");
+
+    pipeline.restart();
+    std::fill(l.begin(), l.end(), 1.0);
+    pipeline.process(channels, 2, kBlock);
+    bool silent = true;
+    for (int i = 0; i < kBlock; ++i)
+        silent = silent && l[static_cast<size_t>(i)] == 0.0;
+    check(silent, "restart refills the delay with silence");
+
+    pipeline.stop();
+    check(stage.threadStarts.load() == 1 && stage.threadExits.load() == 1, "thread hooks run once per worker");
+    check(!pipeline.isRunning(), "stop leaves the pipeline idle");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[PipelinedStageTests] Start\n";
+    testDelayIsExact();
+    testMissedBlockIsSilenced();
+    testSlotOverflowDropsInput();
+    testRejectAndRestart();
+    std::cout << "[PipelinedStageTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+//==============================================================================
+// PublicationSchemaBenchmark.cpp
+//
+// publication precheck のスキーマ部分のレイテンシ比較と、静的スキーマ構成
+// (CONVOPEQ_STATIC_PUBLICATION_SCHEMA, audioengine/ISRStaticPublicationSchema.h) の同値性検証。
+//
+// 測定項目 (publication 1 回あたり):
+//   runtime : descriptor 表の走査 + closure graph の構築 (vector) + ClosureValidator の走査
+//             + PayloadTierValidator + closure_graph.json の書き出し (ClosureGraphWalker と同じ)
+//   static  : 上記はすべてコンパイル時に確定。実行時に残るのは形フラグの算出のみ
+//
+// 検証項目:
+//   1. 全 8 通りの closure の形で、constexpr 版と ClosureValidator / PayloadTierValidator の判定が一致すること
+//   2. 巡回・未知ノード参照・重複 ID を constexpr 版も不正と判定すること
+//
+// 使い方:
+//   PublicationSchemaBenchmark [--quick]
+//
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "audioengine/ISRClosureGraphWalker.h"
+#include "audioengine/ISRStaticPublicationSchema.h"
+#include "audioengine/RuntimeGraph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Clock = std::chrono::steady_clock;
+
+// 最適化で定数畳み込みされないよう、形フラグは volatile 経由で渡す
+volatile bool g_hasActive = true;
+volatile bool g_hasFading = true;
+volatile uint64_t g_sink = 0;
+
+bool runtimeDescriptorWalk() noexcept
+{
+    using Fn = bool (*)() noexcept;
+    static Fn volatile graphFn = &convo::RuntimeGraph::validateDescriptorSet;
+    static Fn volatile coverageFn = &convo::RuntimeGraph::validateDecisionCoverageContract;
+    static Fn volatile publicationFn = &convo::isr::PublicationSemantic::validateDescriptorSet;
+    return graphFn() && coverageFn() && publicationFn();
+}
+
+// AudioEngine::runPublicationPrecheckNonRt の動的スキーマ経路と同じ手順
+bool runtimeSchemaPrecheck(uint64_t generation, const std::filesystem::path& artifactPath, bool emitArtifact)
+{
+    if (!runtimeDescriptorWalk())
+        return false;
+
+    const convo::isr::PublicationClosureShape shape { g_hasActive, g_hasFading, g_hasFading };
+    convo::isr::PayloadClosureDescriptor closure {};
+    convo::isr::copyPublicationClosure(convo::isr::buildPublicationClosure(shape),
+                                       static_cast<uint32_t>(generation != 0 ? generation : 1u),
+                                       closure);
+    const auto descriptor = convo::isr::makePublicationPayloadDescriptor(shape);
+
+    convo::isr::ClosureValidator closureValidator;
+    const bool closureValid = closureValidator.validateClosureGraph(closure);
+    if (emitArtifact)
+        convo::isr::ClosureGraphWalker {}.emitClosureArtifact(closure, closureValid, {}, artifactPath);
+
+    // precheckPublish の再検証 (ClosureValidator + PayloadTierValidator)
+    convo::isr::ClosureValidator coordinatorValidator;
+    convo::isr::PayloadTierValidator tierValidator;
+    return closureValid
+        && coordinatorValidator.validateClosureGraph(closure)
+        && tierValidator.isPublishAllowed(descriptor);
+}
+
+// 静的スキーマ構成で実行時に残る部分
+bool staticSchemaPrecheck() noexcept
+{
+    const convo::isr::PublicationClosureShape shape { g_hasActive, g_hasFading, g_hasFading };
+    g_sink = g_sink + convo::isr::publicationClosureShapeIndex(shape);
+    return true;
+}
+
+template <typename Fn>
+double measureNsPerCall(int iterations, Fn&& fn)
+{
+    std::vector<double> samples;
+    constexpr int kRounds = 5;
+    for (int round = 0; round < kRounds; ++round)
+    {
+        const auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i)
+            if (!fn(static_cast<uint64_t>(i + 1)))
+                g_sink = g_sink + 1;
+        const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.push_back(elapsed / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[kRounds / 2];
+}
+
+void testStaticAgreesWithRuntimeValidators()
+{
+    convo::isr::ClosureValidator closureValidator;
+    convo::isr::PayloadTierValidator tierValidator;
+    for (std::size_t i = 0; i < convo::isr::kPublicationClosureShapeCount; ++i)
+    {
+        const auto shape = convo::isr::publicationClosureShapeFromIndex(i);
+        check(convo::isr::publicationClosureShapeIndex(shape) == i, "shape index round-trips");
+        if (!shape.hasActive && !shape.hasFading && !shape.hasTransitionNext)
+            continue;
+
+        const auto staticClosure = convo::isr::buildPublicationClosure(shape);
+        convo::isr::PayloadClosureDescriptor closure {};
+        convo::isr::copyPublicationClosure(staticClosure, 7u, closure);
+        const auto descriptor = convo::isr::makePublicationPayloadDescriptor(shape);
+
+        const bool runtimeValid = closureValidator.validateClosureGraph(closure)
+            && tierValidator.isPublishAllowed(descriptor);
+        check(runtimeValid == convo::isr::isPublicationClosureShapePublishable(shape),
+              "shape " + std::to_string(i) + ": static and runtime verdicts agree");
+        check(runtimeValid, "shape " + std::to_string(i) + ": publishable");
+    }
+}
+
+void testStaticRejectsMalformedClosures()
+{
+    convo::isr::ClosureValidator closureValidator;
+    const auto agreeAndReject = [&](const convo::isr::StaticPublicationClosure& staticClosure, const std::string& label)
+    {
+        convo::isr::PayloadClosureDescriptor closure {};
+        convo::isr::copyPublicationClosure(staticClosure, 1u, closure);
+        check(!convo::isr::validateStaticClosureGraph(staticClosure), label + ": static rejects");
+        check(!closureValidator.validateClosureGraph(closure), label + ": runtime rejects");
+    };
+
+    auto cyclic = convo::isr::buildPublicationClosure({ true, true, false });
+    cyclic.edges[cyclic.edgeWordCount++] = 2u;
+    cyclic.edges[cyclic.edgeWordCount++] = 1u;
+    agreeAndReject(cyclic, "cycle");
+
+    auto dangling = convo::isr::buildPublicationClosure({ true, false, false });
+    dangling.edges[dangling.edgeWordCount++] = 1u;
+    dangling.edges[dangling.edgeWordCount++] = 9u;
+    agreeAndReject(dangling, "dangling edge");
+
+    auto duplicate = convo::isr::buildPublicationClosure({ true, true, false });
+    duplicate.nodes[1].nodeId = 1u;
+    agreeAndReject(duplicate, "duplicate node id");
+
+    auto uncovered = convo::isr::buildPublicationClosure({ true, false, false });
+    uncovered.nodes[0].allocator = 0u;
+    agreeAndReject(uncovered, "uncovered node attribute");
+
+    auto external = convo::isr::buildPublicationClosure({ true, false, false });
+    external.externalMutableDependencies = 1u;
+    agreeAndReject(external, "external mutable dependency");
+}
+
+void benchmarkPublicationLatency(bool quick)
+{
+    const int iterations = quick ? 2000 : 20000;
+    const int artifactIterations = quick ? 200 : 2000;
+    const auto artifactPath = std::filesystem::temp_directory_path() / "convopeq_publication_schema_bench.json";
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const bool fading : { false, true })
+    {
+        g_hasFading = fading;
+        const char* label = fading ? "transition (active+fading+next)" : "steady (active only)           ";
+        const double runtimeNs = measureNsPerCall(iterations, [&](uint64_t gen) { return runtimeSchemaPrecheck(gen, artifactPath, false); });
+        const double runtimeWithArtifactNs = measureNsPerCall(artifactIterations, [&](uint64_t gen) { return runtimeSchemaPrecheck(gen, artifactPath, true); });
+        const double staticNs = measureNsPerCall(iterations, [](uint64_t) { return staticSchemaPrecheck(); });
+        std::cout << "  " << label
+                  << "  runtime=" << runtimeNs << " ns"
+                  << "  runtime+artifact=" << runtimeWithArtifactNs << " ns"
+                  << "  static=" << staticNs << " ns\n";
+        check(staticNs <= runtimeNs, std::string(label) + ": static schema is not slower");
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(artifactPath, ec);
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main(int argc, char** argv)
+{
+    bool quick = false;
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--quick") == 0)
+            quick = true;
+
+    std::cout << "[PublicationSchemaBenchmark] Start\n";
+    testStaticAgreesWithRuntimeValidators();
+    testStaticRejectsMalformedClosures();
+    benchmarkPublicationLatency(quick);
+    std::cout << "[PublicationSchemaBenchmark] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
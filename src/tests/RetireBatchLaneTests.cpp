@@ -0,0 +1,276 @@
+//==============================================================================
+// RetireBatchLaneTests.cpp
+//
+// 退役バッチレーン (RetireBatchLane / RetireBatchHandoff) と ISRRetireRouter::RetireBatchScope のテスト。
+//   1. 同じ epoch の退役は 1 バッチにまとまり、封印まで Reclaimer に見えないこと。
+//      epoch < minReaderEpoch になるまで破棄されず、破棄後のバッチは増設なしで再利用されること
+//   2. 満杯・epoch 変化で自動的に封印されること
+//   3. バッチ間は FIFO でないこと (新しい epoch のバッチが古いバッチの回収を妨げない)
+//   4. Router: スコープ内の退役はレーンへ、スコープ外は共有キューへ入り、入れ子は外側のレーンに合流し、
+//      tryReclaim / drainAll がレーン分も回収すること
+//   5. Reader が止まっている間にレーン上限 (kMaxBatches) を超えた分だけ共有キューへ回ること
+//   6. 複数スレッド (生産者 4 本 + Reclaimer 1 本) で全退役がちょうど 1 回ずつ破棄されること
+// EpochDomain と ISRRetireRouter.cpp を直接使う (JUCE / MKL 非依存)。
+//==============================================================================
+
+#include "audioengine/ISRRetireBatchLane.h"
+#include "audioengine/ISRRetireRouter.h"
+#include "core/EpochDomain.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using convo::isr::ISRRetireRouter;
+using convo::isr::RetireBatch;
+using convo::isr::RetireBatchHandoff;
+using convo::isr::RetireBatchLane;
+using convo::isr::RetireProducer;
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+// 破棄回数を数える退役対象
+struct Tracked
+{
+    std::atomic<int>* deletions = nullptr;
+};
+
+void deleteTracked(void* p)
+{
+    auto* t = static_cast<Tracked*>(p);
+    t->deletions->fetch_add(1, std::memory_order_relaxed);
+    delete t;
+}
+
+Tracked* makeTracked(std::atomic<int>& deletions)
+{
+    return new Tracked { &deletions };
+}
+
+void testSingleBatch()
+{
+    std::atomic<int> deletions { 0 };
+    RetireBatchHandoff handoff;
+    RetireBatchLane lane(RetireProducer::EQ, 1);
+
+    for (int i = 0; i < 10; ++i)
+        check(lane.tryAppend(makeTracked(deletions), deleteTracked, 5, handoff), "append into open batch");
+    check(lane.hasOpenBatch() && handoff.pendingEntryCount() == 0, "open batch is invisible before seal");
+    check(handoff.reclaim(100) == 0 && deletions.load() == 0, "unsealed entries are not reclaimed");
+
+    lane.seal(handoff);
+    check(lane.handedOffBatches() == 1 && handoff.pendingEntryCount() == 10, "seal hands off one batch");
+    check(handoff.reclaim(5) == 0 && deletions.load() == 0, "batch at epoch == minReaderEpoch is kept");
+    check(handoff.pendingEntryCount() == 10, "kept batch stays pending");
+    check(handoff.reclaim(6) == 10 && deletions.load() == 10, "batch reclaimed once epoch < minReaderEpoch");
+    check(handoff.pendingEntryCount() == 0 && handoff.reclaimedBatchCount() == 1, "pending count drops after reclaim");
+
+    // 返却されたバッチを使い回す (増設しない)
+    const uint32_t allocated = lane.allocatedBatches();
+    for (int round = 0; round < 20; ++round)
+    {
+        check(lane.tryAppend(makeTracked(deletions), deleteTracked, 7 + static_cast<uint64_t>(round), handoff),
+              "append after recycle");
+        lane.seal(handoff);
+        (void)handoff.reclaim(8 + static_cast<uint64_t>(round));
+    }
+    check(lane.allocatedBatches() == allocated, "recycled batches are reused without growth");
+    check(deletions.load() == 30, "every recycled round reclaimed");
+}
+
+void testAutoSeal()
+{
+    std::atomic<int> deletions { 0 };
+    RetireBatchHandoff handoff;
+    RetireBatchLane lane(RetireProducer::Convolver, 2);
+    while (lane.grow()) {}
+
+    const int total = static_cast<int>(RetireBatch::kCapacity) * 2 + 6;
+    for (int i = 0; i < total; ++i)
+        (void)lane.tryAppend(makeTracked(deletions), deleteTracked, 3, handoff);
+    check(lane.handedOffBatches() == 2, "full batches are sealed automatically");
+    check(handoff.pendingEntryCount() == RetireBatch::kCapacity * 2, "sealed entries counted");
+
+    (void)lane.tryAppend(makeTracked(deletions), deleteTracked, 4, handoff);
+    check(lane.handedOffBatches() == 3, "epoch change seals the open batch");
+    lane.seal(handoff);
+
+    check(handoff.reclaim(4) == static_cast<uint32_t>(total), "epoch-3 batches reclaimed, epoch-4 kept");
+    check(handoff.drainAllUnsafe() == 1 && deletions.load() == total + 1, "drainAllUnsafe ignores epoch");
+}
+
+void testNoHeadOfLineBlocking()
+{
+    std::atomic<int> deletions { 0 };
+    RetireBatchHandoff handoff;
+    RetireBatchLane laneA(RetireProducer::EQ, 3);
+    RetireBatchLane laneB(RetireProducer::Snapshot, 4);
+
+    (void)laneA.tryAppend(makeTracked(deletions), deleteTracked, 50, handoff);
+    laneA.seal(handoff);
+    (void)laneB.tryAppend(makeTracked(deletions), deleteTracked, 10, handoff);
+    laneB.seal(handoff);
+    (void)laneA.tryAppend(makeTracked(deletions), deleteTracked, 11, handoff);
+    laneA.seal(handoff);
+
+    check(handoff.reclaim(20) == 2 && deletions.load() == 2, "older batches reclaimed past a newer one");
+    check(handoff.reclaim(51) == 1 && deletions.load() == 3, "newer batch reclaimed later");
+}
+
+void testRouterScope()
+{
+    std::atomic<int> deletions { 0 };
+    auto domain = std::make_unique<convo::EpochDomain>();
+    ISRRetireRouter router(*domain);
+
+    // スコープ外: 共有キュー
+    router.retire(makeTracked(deletions), deleteTracked);
+    check(domain->pendingRetireCount() == 1, "unscoped retire goes to the shared queue");
+
+    {
+        ISRRetireRouter::RetireBatchScope scope(router, RetireProducer::EQ);
+        check(scope.isBatching(), "scope acquires a lane");
+        for (int i = 0; i < 5; ++i)
+            router.retire(makeTracked(deletions), deleteTracked);
+        {
+            ISRRetireRouter::RetireBatchScope nested(router, RetireProducer::Lifetime);
+            check(!nested.isBatching(), "nested scope joins the outer lane");
+            router.retire(makeTracked(deletions), deleteTracked);
+        }
+        check(domain->pendingRetireCount() == 1, "scoped retires bypass the shared queue");
+        check(router.pendingRetireCount() == 1, "open batch not yet visible");
+    }
+    check(router.pendingRetireCount() == 7, "closing the scope hands off the batch");
+
+    router.tryReclaim();
+    check(deletions.load() == 0, "nothing reclaimed before the epoch advances");
+    router.publishEpoch();
+    router.tryReclaim();
+    check(deletions.load() == 7 && router.pendingRetireCount() == 0, "tryReclaim reclaims lane batches and shared queue");
+    check(router.reclaimedRetireBatchCount() == 1, "lane retires reclaimed as one batch");
+
+    // 同じスレッド・同じ producer はレーンを使い回す。drainAll は封印済みを落とす
+    {
+        ISRRetireRouter::RetireBatchScope scope(router, RetireProducer::EQ);
+        router.retire(makeTracked(deletions), deleteTracked);
+    }
+    router.drainAll();
+    check(deletions.load() == 8 && router.pendingRetireCount() == 0, "drainAll drains sealed lane batches");
+}
+
+void testLaneCapFallback()
+{
+    std::atomic<int> deletions { 0 };
+    auto domain = std::make_unique<convo::EpochDomain>();
+    ISRRetireRouter router(*domain);
+
+    const int reader = router.registerReaderThread();
+    router.enterReader(reader);   // Reader が止まったまま → レーンのバッチは回収できない
+
+    const int laneCapacity = static_cast<int>(RetireBatchLane::kMaxBatches * RetireBatch::kCapacity);
+    const int extra = 40;
+    {
+        ISRRetireRouter::RetireBatchScope scope(router, RetireProducer::Crossfade);
+        for (int i = 0; i < laneCapacity + extra; ++i)
+        {
+            // epoch を変えずに詰める (Reader が epoch を固定している間の自動化に相当)
+            (void)router.enqueueRetire(makeTracked(deletions), deleteTracked, router.currentEpoch());
+        }
+    }
+    check(router.batchedRetireFallbackCount() == static_cast<uint64_t>(extra), "only the overflow beyond the lane cap falls back");
+    check(domain->pendingRetireCount() == static_cast<uint32_t>(extra), "fallback entries land in the shared queue");
+    check(deletions.load() == 0, "nothing reclaimed while the reader is stuck");
+
+    router.exitReader(reader);
+    router.publishEpoch();
+    router.tryReclaim();
+    check(deletions.load() == laneCapacity + extra, "everything reclaimed after the reader exits");
+}
+
+void testConcurrentProducers()
+{
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+
+    std::atomic<int> deletions { 0 };
+    auto domain = std::make_unique<convo::EpochDomain>();
+    ISRRetireRouter router(*domain);
+    std::atomic<bool> producing { true };
+
+    // Timer 相当: 読み取り区間を回しつつ epoch を進めて回収する
+    std::thread reclaimer([&]
+    {
+        const int reader = router.registerReaderThread();
+        while (producing.load(std::memory_order_acquire))
+        {
+            router.enterReader(reader);
+            router.exitReader(reader);
+            router.publishEpoch();
+            router.tryReclaim();
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&, p]
+        {
+            const auto producer = static_cast<RetireProducer>(p);
+            for (int done = 0; done < kPerProducer;)
+            {
+                ISRRetireRouter::RetireBatchScope scope(router, producer);
+                const int burst = 1 + (done % 50);
+                for (int i = 0; i < burst && done < kPerProducer; ++i, ++done)
+                    router.retire(makeTracked(deletions), deleteTracked);
+                // 破棄は Reclaimer 1 本なので、生産が上回る分は待つ (実機の UI / Timer 間隔に相当する背圧)
+                while (router.pendingRetireCount() > 2048)
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : producers)
+        t.join();
+    producing.store(false, std::memory_order_release);
+    reclaimer.join();
+
+    router.publishEpoch();
+    router.tryReclaim();
+    router.drainAll();
+    check(deletions.load() == kProducers * kPerProducer, "concurrent: every retire deleted exactly once");
+    check(router.pendingRetireCount() == 0, "concurrent: nothing left pending");
+    check(router.batchedRetireFallbackCount() == 0, "concurrent: no fallback to the shared queue");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[RetireBatchLaneTests] Start\n";
+    testSingleBatch();
+    testAutoSeal();
+    testNoHeadOfLineBlocking();
+    testRouterScope();
+    testLaneCapFallback();
+    testConcurrentProducers();
+    std::cout << "[RetireBatchLaneTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+//==============================================================================
+// RtSafetyGuardTests.cpp
+//
+// convo::RtSafetyGuard (audioengine/RtSafetyGuard.h) のテスト。
+//   1. 無効時と CallbackScope の外では何も記録しないこと
+//   2. 違反が次の lap の段に付き、lap の無いまま終わった分は段外 (Count) になること
+//   3. UncheckedScope の内側は数えず、抜けたら元に戻ること
+//   4. コールバック内バッファとリングが溢れた分を dropped に数えること
+//   5. 別スレッドは CallbackScope の影響を受けないこと
+// を検証する。フック (RtSafetyGuard.cpp) は含めず noteViolation() を直接呼ぶ。JUCE / MKL 非依存。
+//==============================================================================
+#include "audioengine/RtSafetyGuard.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::DspStage;
+using convo::RtSafetyGuard;
+using convo::RtViolation;
+using convo::RtViolationKind;
+
+uint32_t fixedStackHash() noexcept
+{
+    return 0x1234u;
+}
+
+std::vector<RtViolation> drainAll()
+{
+    std::vector<RtViolation> out;
+    RtViolation v;
+    while (RtSafetyGuard::pop(v))
+        out.push_back(v);
+    return out;
+}
+
+void testDisabled()
+{
+    RtSafetyGuard::configure(false, false);
+    {
+        RtSafetyGuard::CallbackScope scope(1);
+        RtSafetyGuard::noteViolation(RtViolationKind::OperatorNew, 16);
+    }
+    check(drainAll().empty(), "disabled guard records nothing");
+
+    RtSafetyGuard::configure(true, false, &fixedStackHash);
+    RtSafetyGuard::noteViolation(RtViolationKind::OperatorNew, 16);
+    check(drainAll().empty(), "nothing recorded outside a callback");
+}
+
+void testStageAttribution()
+{
+    RtSafetyGuard::configure(true, false, &fixedStackHash);
+    const auto before = RtSafetyGuard::counters();
+    {
+        RtSafetyGuard::CallbackScope scope(42);
+        RtSafetyGuard::onStageLap(DspStage::Input);   // 違反なしの lap は何もしない
+        RtSafetyGuard::noteViolation(RtViolationKind::AlignedMalloc, 256);
+        RtSafetyGuard::onStageLap(DspStage::Eq);
+        RtSafetyGuard::noteViolation(RtViolationKind::StdMutexLock);
+        RtSafetyGuard::noteViolation(RtViolationKind::JuceLock);
+        RtSafetyGuard::onStageLap(DspStage::Convolver);
+        RtSafetyGuard::noteViolation(RtViolationKind::MklMalloc, 64);
+    }
+    const auto v = drainAll();
+    check(v.size() == 4, "four violations");
+    if (v.size() == 4)
+    {
+        check(v[0].kind == RtViolationKind::AlignedMalloc && v[0].stage == DspStage::Eq && v[0].bytes == 256,
+              "allocation attributed to the next lap");
+        check(v[1].stage == DspStage::Convolver && v[2].stage == DspStage::Convolver, "locks attributed together");
+        check(v[1].bytes == 0, "locks carry no size");
+        check(v[3].stage == DspStage::Count, "trailing violation is outside a stage");
+        check(v[0].callbackIndex == 42 && v[3].callbackIndex == 42, "callback index");
+        check(v[0].stackHash == 0x1234u, "stack hash from the installed hasher");
+    }
+    const auto after = RtSafetyGuard::counters();
+    check(after.total - before.total == 4, "total counted");
+    check(after.byKind[static_cast<size_t>(RtViolationKind::StdMutexLock)]
+              - before.byKind[static_cast<size_t>(RtViolationKind::StdMutexLock)] == 1, "counted by kind");
+
+    // 次のコールバックへ持ち越さない
+    {
+        RtSafetyGuard::CallbackScope scope(43);
+        RtSafetyGuard::onStageLap(DspStage::Output);
+    }
+    check(drainAll().empty(), "clean callback records nothing");
+}
+
+void testUncheckedScope()
+{
+    RtSafetyGuard::configure(true, false);
+    {
+        RtSafetyGuard::CallbackScope scope(7);
+        {
+            const RtSafetyGuard::UncheckedScope unchecked;
+            RtSafetyGuard::noteViolation(RtViolationKind::MklMalloc, 64);
+        }
+        RtSafetyGuard::noteViolation(RtViolationKind::OperatorNew, 8);
+    }
+    const auto v = drainAll();
+    check(v.size() == 1 && v[0].kind == RtViolationKind::OperatorNew, "unchecked scope excluded and restored");
+    check(v.size() == 1 && v[0].stackHash == 0, "no hasher gives zero hash");
+
+    // スコープを抜けたら外側の unchecked も戻る
+    RtSafetyGuard::noteViolation(RtViolationKind::OperatorNew, 8);
+    check(drainAll().empty(), "disarmed after the callback");
+}
+
+void testOverflow()
+{
+    RtSafetyGuard::configure(true, false);
+    auto before = RtSafetyGuard::counters();
+    {
+        RtSafetyGuard::CallbackScope scope(100);
+        for (size_t i = 0; i < RtSafetyGuard::kCallbackCapacity + 3; ++i)
+            RtSafetyGuard::noteViolation(RtViolationKind::OperatorNew, i);
+    }
+    auto after = RtSafetyGuard::counters();
+    check(drainAll().size() == RtSafetyGuard::kCallbackCapacity, "callback buffer keeps its capacity");
+    check(after.dropped - before.dropped == 3, "callback overflow dropped");
+    check(after.total - before.total == RtSafetyGuard::kCallbackCapacity + 3, "overflow still counted in total");
+
+    // リングを読まずに埋める
+    before = RtSafetyGuard::counters();
+    const size_t callbacks = RtSafetyGuard::kPendingCapacity / RtSafetyGuard::kCallbackCapacity + 1;
+    for (size_t cb = 0; cb < callbacks; ++cb)
+    {
+        RtSafetyGuard::CallbackScope scope(200 + cb);
+        for (size_t i = 0; i < RtSafetyGuard::kCallbackCapacity; ++i)
+            RtSafetyGuard::noteViolation(RtViolationKind::JuceLock);
+    }
+    after = RtSafetyGuard::counters();
+    check(drainAll().size() == RtSafetyGuard::kPendingCapacity, "ring keeps its capacity");
+    check(after.dropped - before.dropped == RtSafetyGuard::kCallbackCapacity, "ring overflow dropped");
+}
+
+void testOtherThread()
+{
+    RtSafetyGuard::configure(true, false);
+    {
+        RtSafetyGuard::CallbackScope scope(9);
+        std::thread worker([] { RtSafetyGuard::noteViolation(RtViolationKind::OperatorNew, 32); });
+        worker.join();
+    }
+    check(drainAll().empty(), "other threads are not armed");
+    RtSafetyGuard::configure(false, false);
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[RtSafetyGuardTests] Start\n";
+    testDisabled();
+    testStageAttribution();
+    testUncheckedScope();
+    testOverflow();
+    testOtherThread();
+    std::cout << "[RtSafetyGuardTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -715,6 +715,40 @@ namespace {
     return true;
 }
 
+[[nodiscard]] bool testIncrementalValidationFieldMaskContract()
+{
+    // 既定の World は全検証 (全ビット dirty)
+    convo::isr::RuntimeSemanticSchema schema {};
+    if (schema.metadata.dirtyFieldMask != convo::isr::kAllRuntimeFieldsDirty)
+        return false;
+
+    // ビット位置は descriptor 表の添字、未知の名前は 0
+    static constexpr std::array<convo::isr::RuntimeFieldDescriptor, 3> kDescriptors {{
+        {"topology"}, {"routing"}, {"resource"}
+    }};
+    static_assert(convo::isr::runtimeFieldBit(kDescriptors, "topology") == 0x1u);
+    static_assert(convo::isr::runtimeFieldBit(kDescriptors, "resource") == 0x4u);
+    static_assert(convo::isr::runtimeFieldBit(kDescriptors, "unknown") == 0u);
+    static_assert(convo::isr::runtimeFieldBit(convo::isr::PublicationSemantic::kFieldDescriptors, "previousSequenceId") == 0x8u);
+
+    // 差分判定: 値が同じなら等価、1 フィールドでも違えば非等価
+    convo::isr::AutomationSemantic a {};
+    convo::isr::AutomationSemantic b {};
+    if (!(a == b))
+        return false;
+    b.outputMakeupGain = 0.5;
+    if (a == b)
+        return false;
+
+    convo::isr::TopologySemantic topologyA {};
+    convo::isr::TopologySemantic topologyB {};
+    topologyB.fadingRuntimeUuid = 7;
+    if (topologyA == topologyB)
+        return false;
+
+    return convo::isr::kFullWorldValidationInterval > 0;
+}
+
 } // namespace
 
 int main()
@@ -791,5 +825,8 @@ int main()
     if (!testNewWork11VerifierRegistrations())
         throw std::runtime_error("work11 verifier table registration contract validation failed");
 
+    if (!testIncrementalValidationFieldMaskContract())
+        throw std::runtime_error("incremental validation field mask contract validation failed");
+
     return 0;
 }
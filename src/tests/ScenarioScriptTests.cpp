@@ -0,0 +1,124 @@
+//==============================================================================
+// ScenarioScriptTests.cpp
+//
+// convo::ScenarioScript (ScenarioScript.h) のテスト。
+//   1. 全種類のイベントが書式化 → 解析で元に戻ること
+//   2. タブ・改行・\ を含む値がエスケープされて往復すること
+//   3. コメント・空行・CRLF を読み飛ばし、読めない行は行番号付きのエラーにして続けること
+//   4. イベントが時刻順 (同時刻はファイル順) に並ぶこと
+// を検証する。JUCE / MKL 非依存。
+//==============================================================================
+#include "ScenarioScript.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::ScenarioEvent;
+using convo::ScenarioEventKind;
+
+ScenarioEvent makeEvent(int64_t timeMs, ScenarioEventKind kind, std::string value,
+                        int band = -1, std::string section = {}, std::string property = {})
+{
+    ScenarioEvent e;
+    e.timeMs = timeMs;
+    e.kind = kind;
+    e.band = band;
+    e.section = std::move(section);
+    e.property = std::move(property);
+    e.value = std::move(value);
+    return e;
+}
+
+bool roundTrips(const ScenarioEvent& e)
+{
+    std::string error;
+    const auto parsed = convo::parseScenarioLine(convo::formatScenarioEvent(e), error);
+    return parsed.has_value() && error.empty() && *parsed == e;
+}
+
+void testRoundTrip()
+{
+    check(roundTrips(makeEvent(0, ScenarioEventKind::Preset, "take.initial.xml")), "preset");
+    check(roundTrips(makeEvent(1250, ScenarioEventKind::EqBand, "-2.5", 3, {}, "gain")), "eq band");
+    check(roundTrips(makeEvent(1300, ScenarioEventKind::Set, "1", -1, "Convolver", "phaseMode")), "set");
+    check(roundTrips(makeEvent(4000, ScenarioEventKind::Ir, "C:\\IR\\hall 2.wav")), "ir with spaces and backslashes");
+    check(roundTrips(makeEvent(9000, ScenarioEventKind::End, {})), "end");
+    check(roundTrips(makeEvent(10, ScenarioEventKind::Set, "a\tb\nc\\d", -1, "Preset", "note")), "escaped value");
+
+    const auto line = convo::formatScenarioEvent(makeEvent(10, ScenarioEventKind::Set, "a\tb", -1, "EQ", "x"));
+    check(line == "10\tset\tEQ\tx\ta\\tb", "escaped tab is not a separator");
+}
+
+void testParseErrors()
+{
+    const std::string text =
+        "# ConvoPeq scenario v1\r\n"
+        "\r\n"
+        "100\teq\t2\tfreq\t1000\r\n"
+        "abc\teq\t2\tfreq\t1000\n"
+        "200\tjump\n"
+        "300\tir\n"
+        "400\teq\t-1\tgain\t0\n"
+        "500\tset\tEQ\n"
+        "600\tend\n";
+    const auto result = convo::parseScenario(text);
+    check(result.events.size() == 2, "two valid events");
+    check(result.errors.size() == 5, "five errors");
+    if (!result.errors.empty())
+        check(result.errors.front().rfind("line 4:", 0) == 0, "error carries the line number");
+    if (result.events.size() == 2)
+    {
+        check(result.events[0].value == "1000" && result.events[0].band == 2, "CRLF stripped");
+        check(result.events[1].kind == ScenarioEventKind::End, "end parsed");
+    }
+    check(result.durationMs() == 600, "duration from the last event");
+}
+
+void testOrdering()
+{
+    const std::string text =
+        "500\tset\tPreset\tditherBitDepth\t24\n"
+        "100\teq\t0\tgain\t1\n"
+        "500\tset\tPreset\tditherBitDepth\t16\n"
+        "0\tpreset\tinit.xml\n";
+    const auto result = convo::parseScenario(text);
+    check(result.errors.empty(), "no errors");
+    check(result.events.size() == 4, "four events");
+    if (result.events.size() == 4)
+    {
+        check(result.events[0].kind == ScenarioEventKind::Preset, "earliest first");
+        check(result.events[1].timeMs == 100, "sorted by time");
+        check(result.events[2].value == "24" && result.events[3].value == "16", "same time keeps file order");
+    }
+    check(convo::parseScenario("").events.empty(), "empty scenario");
+    check(convo::parseScenario("").durationMs() == 0, "empty duration");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[ScenarioScriptTests] Start\n";
+    testRoundTrip();
+    testParseErrors();
+    testOrdering();
+    std::cout << "[ScenarioScriptTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+//==============================================================================
+// ScreeningFidelityGateTests.cpp
+//
+// convo::ScreeningFidelityGate / spearmanRankCorrelation (ScreeningFidelityGate.h) のテスト。
+//   1. spearmanRankCorrelation が一致で 1、逆順で -1、同値を平均順位で扱い、n < 3 や定数列で 0 を返すこと
+//   2. 最初の世代が照合世代で、信頼されるまでは照合世代以外で予備選別を使わないこと
+//   3. 信頼後は kCheckInterval 世代ごとに照合世代が挟まること
+//   4. promoteCount が割合の切り上げと minimum の大きい方を取り、候補数で頭打ちになること
+//   5. recordCheck がエリートの取りこぼしで通過枠を広げ (上限 1)、高相関で狭め (下限 kMinPromoteFraction)、
+//      低相関で信頼を外すこと
+// JUCE / MKL 非依存 (ヘッダのみ)。
+//==============================================================================
+
+#include "ScreeningFidelityGate.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr int kCandidates = 18;
+constexpr int kElite = 6;
+using Gate = convo::ScreeningFidelityGate<kCandidates>;
+
+bool near(double a, double b, double tolerance = 1e-12)
+{
+    return std::abs(a - b) <= tolerance;
+}
+
+//------------------------------------------------------------------------------
+// 1. 順位相関
+//------------------------------------------------------------------------------
+void testSpearman()
+{
+    const double a[] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    const double scaled[] = { 10.0, 40.0, 90.0, 160.0, 250.0 };
+    const double reversed[] = { 5.0, 4.0, 3.0, 2.0, 1.0 };
+    const double ties[] = { 1.0, 1.0, 2.0, 3.0 };
+    const double tiesOther[] = { 1.0, 2.0, 3.0, 4.0 };
+    const double constant[] = { 7.0, 7.0, 7.0, 7.0, 7.0 };
+
+    check(near(convo::spearmanRankCorrelation<kCandidates>(a, scaled, 5), 1.0), "monotonic transform has correlation 1");
+    check(near(convo::spearmanRankCorrelation<kCandidates>(a, reversed, 5), -1.0), "reversed order has correlation -1");
+
+    // ties の順位は (0.5, 0.5, 2, 3)、tiesOther は (0, 1, 2, 3)
+    const double expected = 4.5 / std::sqrt(4.5 * 5.0);
+    check(near(convo::spearmanRankCorrelation<kCandidates>(ties, tiesOther, 4), expected), "ties use average ranks");
+
+    check(convo::spearmanRankCorrelation<kCandidates>(a, scaled, 2) == 0.0, "fewer than 3 samples give 0");
+    check(convo::spearmanRankCorrelation<kCandidates>(a, constant, 5) == 0.0, "constant series gives 0");
+    check(convo::spearmanRankCorrelation<kCandidates>(a, scaled, kCandidates + 1) == 0.0, "count above MaxCount gives 0");
+}
+
+//------------------------------------------------------------------------------
+// 2. 信頼前の計画
+//------------------------------------------------------------------------------
+void testUntrustedPlan()
+{
+    Gate gate;
+    gate.reset();
+
+    const auto first = gate.beginGeneration();
+    check(first.check && first.screen, "first generation is a check generation");
+
+    double screening[kCandidates];
+    double reversed[kCandidates];
+    for (int i = 0; i < kCandidates; ++i)
+    {
+        screening[i] = static_cast<double>(i);
+        reversed[i] = static_cast<double>(kCandidates - i);
+    }
+    gate.recordCheck(screening, reversed, kCandidates, kElite, kElite);
+
+    bool anyScreen = false;
+    for (int g = 1; g < Gate::kCheckInterval; ++g)
+    {
+        const auto plan = gate.beginGeneration();
+        anyScreen = anyScreen || plan.screen || plan.check;
+    }
+    check(!anyScreen, "untrusted gate does not screen between checks");
+
+    const auto next = gate.beginGeneration();
+    check(next.check && next.screen, "check generation returns after kCheckInterval");
+}
+
+//------------------------------------------------------------------------------
+// 3. 信頼後の計画
+//------------------------------------------------------------------------------
+void testTrustedPlan()
+{
+    Gate gate;
+    gate.reset();
+    (void)gate.beginGeneration();
+
+    double screening[kCandidates];
+    double full[kCandidates];
+    for (int i = 0; i < kCandidates; ++i)
+    {
+        screening[i] = static_cast<double>(i);
+        full[i] = static_cast<double>(i) * 2.0 + 1.0;
+    }
+    gate.recordCheck(screening, full, kCandidates, kElite, kElite);
+    check(gate.snapshotStats().trusted, "perfect correlation makes the gate trusted");
+
+    int checks = 0;
+    bool allScreen = true;
+    for (int g = 0; g < 2 * Gate::kCheckInterval; ++g)
+    {
+        const auto plan = gate.beginGeneration();
+        allScreen = allScreen && plan.screen;
+        if (plan.check)
+        {
+            ++checks;
+            check((g + 1) % Gate::kCheckInterval == 0, "check generation falls every kCheckInterval generations");
+            gate.recordCheck(screening, full, kCandidates, kElite, kElite);
+        }
+    }
+    check(allScreen, "trusted gate screens every generation");
+    check(checks == 2, "two check generations in 2 * kCheckInterval generations");
+
+    const auto stats = gate.snapshotStats();
+    check(stats.checkGenerations == 3 && stats.screenedGenerations == 1 + 2 * Gate::kCheckInterval, "plan statistics");
+}
+
+//------------------------------------------------------------------------------
+// 4. 通過枠
+//------------------------------------------------------------------------------
+void testPromoteCount()
+{
+    Gate gate;
+    gate.reset();
+    check(gate.promoteCount(kCandidates, kElite) == 9, "initial fraction promotes half");
+    check(gate.promoteCount(kCandidates, 12) == 12, "minimum wins over the fraction");
+    check(gate.promoteCount(5, 8) == 5, "promote count is clamped to the candidate count");
+    check(gate.promoteCount(7, 0) == 4, "fraction is rounded up");
+}
+
+//------------------------------------------------------------------------------
+// 5. 照合結果による調整
+//------------------------------------------------------------------------------
+void testRecordCheck()
+{
+    double screening[kCandidates];
+    double ascending[kCandidates];
+    for (int i = 0; i < kCandidates; ++i)
+    {
+        screening[i] = static_cast<double>(i);
+        ascending[i] = static_cast<double>(i);
+    }
+
+    // 高相関・取りこぼしなし → 狭める。繰り返しても下限で止まる
+    Gate gate;
+    gate.reset();
+    gate.recordCheck(screening, ascending, kCandidates, kElite, kElite);
+    check(near(gate.snapshotStats().promoteFraction, Gate::kInitialPromoteFraction * Gate::kNarrowFactor), "high correlation narrows the fraction");
+    for (int i = 0; i < 20; ++i)
+        gate.recordCheck(screening, ascending, kCandidates, kElite, kElite);
+    check(near(gate.snapshotStats().promoteFraction, Gate::kMinPromoteFraction), "fraction stops at kMinPromoteFraction");
+    check(gate.promoteCount(kCandidates, kElite) == 7, "narrowed gate promotes ceil(0.34 * 18)");
+
+    // 本評価の最良候補が予備選別では最下位 → 取りこぼし、広げる。繰り返すと上限 1
+    double missedBest[kCandidates];
+    for (int i = 0; i < kCandidates; ++i)
+        missedBest[i] = static_cast<double>(i + 1);
+    missedBest[kCandidates - 1] = -1.0;
+    gate.reset();
+    gate.recordCheck(screening, missedBest, kCandidates, kElite, kElite);
+    auto stats = gate.snapshotStats();
+    check(near(stats.promoteFraction, Gate::kInitialPromoteFraction * Gate::kWidenFactor), "missed elite widens the fraction");
+    check(stats.missedElites == 1, "missed elite is counted");
+    check(stats.trusted, "one displaced candidate keeps the correlation above the minimum");
+    for (int i = 0; i < 5; ++i)
+        gate.recordCheck(screening, missedBest, kCandidates, kElite, kElite);
+    check(gate.snapshotStats().promoteFraction == 1.0, "fraction stops at 1");
+    check(gate.promoteCount(kCandidates, kElite) == kCandidates, "widened gate promotes every candidate");
+
+    // 逆順 → 信頼を外し、取りこぼしで広げる
+    double reversed[kCandidates];
+    for (int i = 0; i < kCandidates; ++i)
+        reversed[i] = static_cast<double>(kCandidates - i);
+    gate.reset();
+    gate.recordCheck(screening, reversed, kCandidates, kElite, kElite);
+    stats = gate.snapshotStats();
+    check(!stats.trusted, "low correlation removes trust");
+    check(near(stats.lastRankCorrelation, -1.0), "last correlation is reported");
+    check(stats.missedElites == static_cast<std::uint64_t>(kElite), "every elite is missed for a reversed ranking");
+
+    // 中程度の相関 (信頼はするが狭めない)
+    double moderate[kCandidates];
+    for (int i = 0; i < kCandidates; ++i)
+        moderate[i] = static_cast<double>(i);
+    for (int i = kElite; i + 1 < kCandidates; i += 2)
+        std::swap(moderate[i], moderate[i + 1]);
+    std::swap(moderate[kElite], moderate[kCandidates - 1]);
+    gate.reset();
+    gate.recordCheck(screening, moderate, kCandidates, kElite, kElite);
+    stats = gate.snapshotStats();
+    check(stats.trusted && stats.lastRankCorrelation < Gate::kNarrowRankCorrelation, "moderate correlation stays trusted");
+    check(near(stats.promoteFraction, Gate::kInitialPromoteFraction), "moderate correlation keeps the fraction");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[ScreeningFidelityGateTests] Start\n";
+    testSpearman();
+    testUntrustedPlan();
+    testTrustedPlan();
+    testPromoteCount();
+    testRecordCheck();
+    std::cout << "[ScreeningFidelityGateTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+//==============================================================================
+// ShutdownOrchestratorTests.cpp
+//
+// convo::ShutdownOrchestrator (audioengine/ShutdownOrchestrator.h) と、終了時に使う
+// 「知らせるだけ」の停止要求のテスト。
+//   1. signalAll が全ステージへ登録順に 1 回だけ知らせ、joinAll はその後に登録順で待つこと
+//   2. 知らせた時点から各スレッドが並行に終わるため、joinAll の合計が直列の和より短いこと
+//   3. 共通期限を過ぎたステージが StageReport に残り、joinAll が false を返すこと。remainingMs は floor で下支えされること
+//   4. BackgroundScheduler::requestStop が実行中タスクを待たずに戻り、未開始タスクを終わらせ、
+//      以後の submit を拒むこと (join は stop)
+//   5. WorkerThread::requestStop が期限を破棄し、stop で join できること
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "audioengine/ShutdownOrchestrator.h"
+#include "core/BackgroundScheduler.h"
+#include "core/WorkerThread.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::ShutdownOrchestrator;
+using std::chrono::milliseconds;
+
+// 停止要求を受けてから cleanup だけ掛けて終わる疑似ワーカー
+struct SlowExitWorker {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stopRequested = false;
+    std::thread thread;
+
+    explicit SlowExitWorker(milliseconds cleanup)
+    {
+        thread = std::thread([this, cleanup] {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stopRequested; });
+            }
+            std::this_thread::sleep_for(cleanup);
+        });
+    }
+    ~SlowExitWorker()
+    {
+        requestStop();
+        if (thread.joinable())
+            thread.join();
+    }
+    void requestStop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopRequested = true;
+        }
+        cv.notify_all();
+    }
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+//------------------------------------------------------------------------------
+// 1. 通知と join の順序
+//------------------------------------------------------------------------------
+void testSignalThenJoinOrder()
+{
+    ShutdownOrchestrator orchestrator { milliseconds(1000) };
+    std::vector<std::string> events;
+    for (const char* name : { "a", "b", "c" })
+    {
+        const std::string stage = name;
+        orchestrator.addStage(stage,
+                              [&events, stage] { events.push_back("signal:" + stage); },
+                              [&events, stage](const ShutdownOrchestrator&) { events.push_back("join:" + stage); });
+    }
+    orchestrator.addStage("signalOnly", [&events] { events.push_back("signal:signalOnly"); }, {});
+
+    orchestrator.signalAll();
+    orchestrator.signalAll();
+    check(orchestrator.isSignalled(), "signalAll marks the orchestrator signalled");
+    check(events.size() == 4, "signalAll signals each stage exactly once");
+
+    const bool withinBudget = orchestrator.joinAll();
+    const std::vector<std::string> expected = {
+        "signal:a", "signal:b", "signal:c", "signal:signalOnly",
+        "join:a", "join:b", "join:c"
+    };
+    check(events == expected, "every stage is signalled before the first join, joins follow registration order");
+    check(withinBudget, "fast stages finish within the budget");
+    check(orchestrator.reports().size() == 3, "stages without a join leave no report");
+    check(orchestrator.reports()[0].name == "a" && orchestrator.reports()[2].name == "c", "reports follow join order");
+}
+
+//------------------------------------------------------------------------------
+// 2. 待ち時間が重なる
+//------------------------------------------------------------------------------
+void testJoinsOverlap()
+{
+    constexpr int kCleanupMs = 100;
+    SlowExitWorker w0 { milliseconds(kCleanupMs) };
+    SlowExitWorker w1 { milliseconds(kCleanupMs) };
+    SlowExitWorker w2 { milliseconds(kCleanupMs) };
+
+    ShutdownOrchestrator orchestrator { milliseconds(2000) };
+    for (SlowExitWorker* w : { &w0, &w1, &w2 })
+    {
+        orchestrator.addStage("worker",
+                              [w] { w->requestStop(); },
+                              [w](const ShutdownOrchestrator&) { w->thread.join(); });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool withinBudget = orchestrator.joinAll();
+    const double total = elapsedMs(start);
+
+    check(withinBudget, "overlapping joins stay within the budget");
+    check(total < 2.5 * kCleanupMs, "joinAll waits about one cleanup, not the serial sum");
+    check(orchestrator.reports()[1].waitedMs < 0.5 * kCleanupMs
+          && orchestrator.reports()[2].waitedMs < 0.5 * kCleanupMs,
+          "later stages were already finished by the time they are joined");
+}
+
+//------------------------------------------------------------------------------
+// 3. 共通期限
+//------------------------------------------------------------------------------
+void testDeadline()
+{
+    ShutdownOrchestrator orchestrator { milliseconds(20) };
+    check(orchestrator.remainingMs(5) == 5, "remainingMs before signalAll falls back to the floor");
+
+    int remainingAtFirstJoin = -1;
+    orchestrator.addStage("quick", {}, [&](const ShutdownOrchestrator& o) { remainingAtFirstJoin = o.remainingMs(); });
+    orchestrator.addStage("slow", {}, [](const ShutdownOrchestrator&) { std::this_thread::sleep_for(milliseconds(60)); });
+    orchestrator.addStage("late", {}, [](const ShutdownOrchestrator&) {});
+
+    const bool withinBudget = orchestrator.joinAll();
+    check(!withinBudget, "joinAll reports an overrun");
+    check(remainingAtFirstJoin > 0 && remainingAtFirstJoin <= 20, "remainingMs counts down from the budget");
+
+    const auto& reports = orchestrator.reports();
+    check(reports.size() == 3 && !reports[0].overran, "stage finished in time is not flagged");
+    check(reports[1].overran && reports[1].waitedMs >= 50.0, "slow stage is flagged with its wait");
+    check(reports[2].overran, "stages joined after the deadline are flagged too");
+    check(orchestrator.remainingMs(7) == 7, "remainingMs after the deadline returns the floor");
+}
+
+//------------------------------------------------------------------------------
+// 4. BackgroundScheduler::requestStop
+//------------------------------------------------------------------------------
+void testSchedulerRequestStop()
+{
+    using convo::BackgroundPriority;
+    using convo::BackgroundScheduler;
+
+    BackgroundScheduler scheduler;
+    scheduler.start(1);
+
+    std::atomic<bool> entered { false };
+    std::atomic<bool> release { false };
+    std::atomic<bool> sawCancel { false };
+    auto running = scheduler.submit(BackgroundPriority::IRLoad, [&](const BackgroundScheduler::CancelToken& token) {
+        entered.store(true);
+        while (!release.load())
+            std::this_thread::sleep_for(milliseconds(1));
+        sawCancel.store(token.isCancelled());
+    });
+    const auto until = std::chrono::steady_clock::now() + milliseconds(2000);
+    while (!entered.load() && std::chrono::steady_clock::now() < until)
+        std::this_thread::sleep_for(milliseconds(1));
+    auto pending = scheduler.submit(BackgroundPriority::Housekeeping, [](const auto&) {});
+
+    scheduler.requestStop();
+    check(!running.isFinished(), "requestStop returns without waiting for the running task");
+    check(pending.isFinished() && !pending.wasRun(), "requestStop drops the pending task");
+    check(!scheduler.isRunning(), "requestStop stops accepting work");
+    check(!scheduler.submit(BackgroundPriority::IRLoad, [](const auto&) {}), "submit after requestStop returns an empty handle");
+
+    release.store(true);
+    scheduler.stop();
+    check(running.isFinished() && running.wasRun() && sawCancel.load(), "stop joins the task, which saw the stop request");
+    check(scheduler.getWorkerCount() == 0, "stop after requestStop retires the workers");
+}
+
+//------------------------------------------------------------------------------
+// 5. WorkerThread::requestStop
+//------------------------------------------------------------------------------
+void testWorkerThreadRequestStop()
+{
+    std::atomic<int> fired { 0 };
+    convo::WorkerThread worker([&] { fired.fetch_add(1); });
+    worker.start();
+    worker.scheduleAfter(milliseconds(10000));
+    check(worker.hasDeadline(), "deadline registered before requestStop");
+
+    worker.requestStop();
+    check(!worker.hasDeadline(), "requestStop discards the pending deadline");
+    worker.scheduleAfter(milliseconds(0));
+    check(!worker.hasDeadline(), "deadlines after requestStop are refused");
+
+    const auto start = std::chrono::steady_clock::now();
+    worker.stop();
+    check(elapsedMs(start) < 1000.0, "stop after requestStop joins promptly");
+    check(fired.load() == 0, "onDue is never called after requestStop");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[ShutdownOrchestratorTests] Start\n";
+    testSignalThenJoinOrder();
+    testJoinsOverlap();
+    testDeadline();
+    testSchedulerRequestStop();
+    testWorkerThreadRequestStop();
+    std::cout << "[ShutdownOrchestratorTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
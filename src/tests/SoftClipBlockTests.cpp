@@ -0,0 +1,195 @@
+//==============================================================================
+// SoftClipBlockTests.cpp
+//
+// convo::dsp::softClipBlock* (dsp/math/SoftClipBlock.h) の一致テスト。
+//   1. 4 幅 (AVX2) / 8 幅 (AVX-512F、CPU 対応時のみ) がスカラー参照 softClipSample とビット一致すること
+//      (SoftClipPadéPolicy / DefaultFastTanhPolicy、端数長、tanh の閾値クランプ域を含む)
+//   2. 線形域と NaN はそのまま返し、knee = 0 は ±threshold のハードクリップになること
+//   3. 旧 per-sample 式 (DSPCoreFloat の musicalSoftClipScalar) と tanh クランプ域以外で一致すること
+// を検証する。ISA 判定のため KernelDispatch / CpuFeatureCheck をリンクする。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "dsp/math/SoftClipBlock.h"
+#include "dsp/KernelDispatch.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using convo::dsp::KernelIsa;
+
+bool bitEqual(const std::vector<double>& a, const std::vector<double>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (std::bit_cast<std::uint64_t>(a[i]) != std::bit_cast<std::uint64_t>(b[i]))
+            return false;
+    return true;
+}
+
+std::vector<double> makeSignal(int n, unsigned seed, double range)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-range, range);
+    std::vector<double> signal(static_cast<size_t>(n));
+    for (auto& v : signal) v = dist(rng);
+    return signal;
+}
+
+struct Params { double threshold, knee, asymmetry; };
+
+// DSPCore の saturationAmount 0 / 0.5 / 1 に対応する組と、細いニー
+const Params kParams[] {
+    { 0.95, 0.05, 0.0 }, { 0.725, 0.225, 0.05 }, { 0.5, 0.4, 0.1 }, { 0.9, 0.01, 0.1 }
+};
+const int kLengths[] { 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 64, 129, 1000 };
+
+std::string label(const char* what, const Params& p, int n)
+{
+    return std::string(what) + " th=" + std::to_string(p.threshold) + " knee=" + std::to_string(p.knee)
+         + " asym=" + std::to_string(p.asymmetry) + " n=" + std::to_string(n);
+}
+
+template<class Policy>
+std::vector<double> runReference(std::vector<double> data, const Params& p)
+{
+    const auto params = convo::dsp::SoftClipParams::make(p.threshold, p.knee, p.asymmetry);
+    for (auto& v : data) v = convo::dsp::softClipSample<Policy>(v, params);
+    return data;
+}
+
+template<class Policy>
+void testWidthsMatchReference(const char* policyName)
+{
+    const bool hasAvx512 = convo::dsp::isKernelIsaSupported(KernelIsa::Avx512);
+    for (const Params& p : kParams)
+    {
+        for (const int n : kLengths)
+        {
+            const auto input = makeSignal(n, static_cast<unsigned>(n * 7 + 1), 3.0);
+            const auto expected = runReference<Policy>(input, p);
+
+            auto scalar = input;
+            convo::dsp::softClipBlockScalar<Policy>(scalar.data(), n, p.threshold, p.knee, p.asymmetry);
+            auto v256 = input;
+            convo::dsp::softClipBlockV256<Policy>(v256.data(), n, p.threshold, p.knee, p.asymmetry);
+
+            bool ok = bitEqual(scalar, expected) && bitEqual(v256, expected);
+            if (hasAvx512)
+            {
+                auto v512 = input;
+                convo::dsp::softClipBlockV512<Policy>(v512.data(), n, p.threshold, p.knee, p.asymmetry);
+                ok = ok && bitEqual(v512, expected);
+            }
+            check(ok, label(policyName, p, n));
+        }
+    }
+}
+
+void testPassthroughAndFallback()
+{
+    std::vector<double> linear { 0.1, -0.2, 0.3, -0.4, 0.0, -0.0, 0.05, -0.05, 0.25, 0.8999 };
+    linear[3] = std::numeric_limits<double>::quiet_NaN();
+    auto v256 = linear;
+    convo::dsp::softClipBlockV256(v256.data(), static_cast<int>(v256.size()), 0.95, 0.05, 0.1);
+    check(bitEqual(v256, linear), "linear region and NaN pass through unchanged");
+
+    std::vector<double> hard { 1.5, -1.5, 0.3, -0.79, 0.81, 2.0, -0.8, 0.0, 0.7 };
+    convo::dsp::softClipBlockV256(hard.data(), static_cast<int>(hard.size()), 0.8, 0.0, 0.0);
+    const std::vector<double> expectedHard { 0.8, -0.8, 0.3, -0.79, 0.8, 0.8, -0.8, 0.0, 0.7 };
+    check(hard == expectedHard, "knee 0 falls back to a hard clip");
+
+    // 出力は threshold + knee を超えない (負側は asymmetry でさらに小さい)
+    const auto loud = makeSignal(4096, 3, 50.0);
+    for (const Params& p : kParams)
+    {
+        auto y = loud;
+        convo::dsp::softClipBlockV256(y.data(), static_cast<int>(y.size()), p.threshold, p.knee, p.asymmetry);
+        double peak = 0.0;
+        for (const double v : y) peak = std::max(peak, std::abs(v));
+        check(peak <= p.threshold + p.knee, label("output bounded by threshold + knee", p, 4096));
+    }
+}
+
+// 旧 DSPCoreFloat::musicalSoftClipScalar (tanh は閾値外で ±1 を返す非クランプ版)
+double legacySoftClip(double x, double threshold, double knee, double asymmetry)
+{
+    const double absX = std::abs(x);
+    const double clipStart = threshold - knee;
+    if (absX < clipStart)
+        return x;
+    const double sign = (x > 0.0) ? 1.0 : -1.0;
+    double kneeShape = 1.0;
+    if (absX < threshold + knee)
+    {
+        const double t = (absX - clipStart) / (2.0 * knee);
+        kneeShape = t * t * (3.0 - 2.0 * t);
+    }
+    const double arg = (absX - threshold) / knee;
+    const double tanhValue = (arg >= 4.5) ? 1.0 : ((arg <= -4.5) ? -1.0
+        : convo::dsp::SoftClipPadéPolicy::compute(arg, arg * arg));
+    const double clipped = threshold + knee * tanhValue;
+    const double asymmetricGain = 1.0 - asymmetry * (1.0 - sign) * 0.5 * kneeShape;
+    return sign * (absX * (1.0 - kneeShape) + clipped * kneeShape) * asymmetricGain;
+}
+
+void testMatchesLegacyCurve()
+{
+    for (const Params& p : kParams)
+    {
+        const auto params = convo::dsp::SoftClipParams::make(p.threshold, p.knee, p.asymmetry);
+        double maxDiffInRange = 0.0;
+        double maxDiffClamped = 0.0;
+        for (int i = 0; i <= 20000; ++i)
+        {
+            const double x = -3.0 + 6.0 * static_cast<double>(i) / 20000.0;
+            const double diff = std::abs(convo::dsp::softClipSample(x, params) - legacySoftClip(x, p.threshold, p.knee, p.asymmetry));
+            const bool clampedArg = std::abs((std::abs(x) - p.threshold) / p.knee) >= 4.5;
+            double& maxDiff = clampedArg ? maxDiffClamped : maxDiffInRange;
+            maxDiff = std::max(maxDiff, diff);
+        }
+        check(maxDiffInRange <= 1.0e-12, label("matches the legacy curve inside the tanh range", p, 20001));
+        check(maxDiffClamped <= p.knee * 7.4e-4, label("clamped tanh stays within knee * 7.4e-4 of the legacy curve", p, 20001));
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[SoftClipBlockTests] Start\n";
+    std::cout << "  AVX-512F: " << (convo::dsp::isKernelIsaSupported(KernelIsa::Avx512) ? "yes" : "no (8-wide skipped)") << "\n";
+    testWidthsMatchReference<convo::dsp::SoftClipPadéPolicy>("pade");
+    testWidthsMatchReference<convo::dsp::DefaultFastTanhPolicy>("default");
+    testPassthroughAndFallback();
+    testMatchesLegacyCurve();
+    std::cout << "[SoftClipBlockTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
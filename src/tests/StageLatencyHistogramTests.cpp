@@ -0,0 +1,191 @@
+//==============================================================================
+// StageLatencyHistogramTests.cpp
+//
+// convo::StageLatencyHistograms / StageLatencyProbe / StageLatencyWindow
+// (audioengine/StageLatencyHistogram.h) のテスト。
+//   1. バケット境界: 値は必ず自分のバケットの上限未満、1 つ前のバケットの上限以上に入ること
+//   2. パーセンタイルがバケット上限 (最大値でクランプ) で、真値の 25% 以内に収まること
+//   3. Probe が同じ段の分割区間を合算し、触れた段だけを 1 件ずつ記録すること
+//   4. Window が差分だけを数え、ウィンドウの入れ替えで古い区間を捨てること・TSC 換算
+//   5. lap ごとに StageLapSink (ETW 通知) が呼ばれ、無効な Probe では呼ばれないこと
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "audioengine/StageLatencyHistogram.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Histograms = convo::StageLatencyHistograms;
+using Window = convo::StageLatencyWindow;
+
+void testBucketBoundaries()
+{
+    bool ok = true;
+    for (uint64_t v : { 0ull, 1ull, 3ull, 4ull, 5ull, 7ull, 8ull, 1000ull, 1023ull, 1024ull, 123456789ull, (1ull << 39) - 1 })
+    {
+        const int b = Histograms::bucketFor(v);
+        ok = ok && v < Histograms::bucketUpperBound(b);
+        if (b > 0)
+            ok = ok && v >= Histograms::bucketUpperBound(b - 1);
+    }
+    check(ok, "values land between the previous and own upper bound");
+    check(Histograms::bucketFor(1ull << 45) == Histograms::kNumBuckets - 1, "overflow bucket");
+    check(Histograms::bucketFor(UINT64_MAX) == Histograms::kNumBuckets - 1, "max value in overflow bucket");
+
+    bool monotonic = true;
+    for (int b = 1; b < Histograms::kNumBuckets; ++b)
+        monotonic = monotonic && Histograms::bucketUpperBound(b) > Histograms::bucketUpperBound(b - 1);
+    check(monotonic, "upper bounds strictly increase");
+}
+
+void testPercentiles()
+{
+    std::array<uint64_t, Histograms::kNumBuckets> counts {};
+    // 1000 件: 990 件は 1000 サイクル、9 件は 5000、1 件は 100000
+    counts[static_cast<size_t>(Histograms::bucketFor(1000))] += 990;
+    counts[static_cast<size_t>(Histograms::bucketFor(5000))] += 9;
+    counts[static_cast<size_t>(Histograms::bucketFor(100000))] += 1;
+
+    const auto summary = Window::summarize(counts, 100000, 1.0);
+    check(summary.samples == 1000, "sample count");
+    check(summary.p50Us >= 1000.0 && summary.p50Us <= 1250.0, "p50 within one bucket above");
+    check(summary.p99Us >= 1000.0 && summary.p99Us <= 1250.0, "p99 still in the bulk");
+    check(summary.p999Us >= 5000.0 && summary.p999Us <= 6250.0, "p99.9 hits the tail");
+    check(summary.maxUs == 100000.0, "max exact");
+
+    const auto uncalibrated = Window::summarize(counts, 100000, 0.0);
+    check(uncalibrated.samples == 1000 && uncalibrated.p50Us == 0.0, "no clock rate: counts only");
+
+    std::array<uint64_t, Histograms::kNumBuckets> single {};
+    single[static_cast<size_t>(Histograms::bucketFor(1000))] = 1;
+    check(Window::summarize(single, 1000, 2.0).p999Us == 500.0, "percentile clamped to max, cycles -> us");
+}
+
+void testProbeMergesSplitStages()
+{
+    auto histograms = std::make_unique<Histograms>();
+    {
+        convo::StageLatencyProbe probe(histograms.get());
+        probe.lap(convo::DspStage::Input);
+        probe.lap(convo::DspStage::Output);
+        probe.lap(convo::DspStage::OversampleDown);
+        probe.lap(convo::DspStage::Output);
+    }
+    auto snapshot = std::make_unique<Window::Snapshot>();
+    histograms->collect(*snapshot);
+
+    const auto total = [&](convo::DspStage stage)
+    {
+        uint64_t n = 0;
+        for (uint64_t c : snapshot->counts[static_cast<size_t>(stage)])
+            n += c;
+        return n;
+    };
+    check(total(convo::DspStage::Input) == 1, "input recorded once");
+    check(total(convo::DspStage::Output) == 1, "split output merged into one sample");
+    check(total(convo::DspStage::OversampleDown) == 1, "osDown recorded");
+    check(total(convo::DspStage::Eq) == 0 && total(convo::DspStage::Convolver) == 0, "untouched stages not recorded");
+
+    {
+        convo::StageLatencyProbe disabled(nullptr);
+        disabled.lap(convo::DspStage::Eq);
+    }
+    histograms->collect(*snapshot);
+    check(total(convo::DspStage::Eq) == 0, "null probe records nothing");
+}
+
+int g_sinkCalls = 0;
+uint32_t g_sinkStages = 0;
+
+void countingSink(convo::DspStage stage, uint64_t) noexcept
+{
+    ++g_sinkCalls;
+    g_sinkStages |= 1u << static_cast<uint32_t>(stage);
+}
+
+void testLapSink()
+{
+    auto histograms = std::make_unique<Histograms>();
+    {
+        convo::StageLatencyProbe probe(histograms.get(), &countingSink);
+        probe.lap(convo::DspStage::Input);
+        probe.lap(convo::DspStage::Convolver);
+        probe.lap(convo::DspStage::Output);
+    }
+    check(g_sinkCalls == 3, "sink called once per lap");
+    check(g_sinkStages == ((1u << 0) | (1u << 3) | (1u << 5)), "sink sees each lapped stage");
+
+    {
+        convo::StageLatencyProbe disabled(nullptr, &countingSink);
+        disabled.lap(convo::DspStage::Eq);
+    }
+    check(g_sinkCalls == 3, "disabled probe does not call the sink");
+}
+
+void testWindowDeltaAndRollover()
+{
+    auto histograms = std::make_unique<Histograms>();
+    auto window = std::make_unique<Window>();
+    constexpr double kCyclesPerUs = 3000.0;
+    const auto tscAt = [](uint64_t us) { return static_cast<uint64_t>(static_cast<double>(us) * kCyclesPerUs); };
+
+    for (int i = 0; i < 50; ++i)
+        histograms->record(convo::DspStage::Convolver, 30000);   // 10 us
+    auto report = window->update(*histograms, 0, tscAt(0));
+    check(report.stages[static_cast<size_t>(convo::DspStage::Convolver)].samples == 0, "records before the first update are baseline");
+    check(!report.clockCalibrated, "clock not calibrated yet");
+
+    for (int i = 0; i < 100; ++i)
+        histograms->record(convo::DspStage::Convolver, 300000);  // 100 us
+    report = window->update(*histograms, 1'000'000, tscAt(1'000'000));
+    const auto& conv = report.stages[static_cast<size_t>(convo::DspStage::Convolver)];
+    check(report.clockCalibrated, "clock calibrated after 1 s");
+    check(conv.samples == 100, "window counts only new records");
+    check(conv.p50Us >= 100.0 && conv.p50Us <= 125.0, "p50 converted to us");
+    check(conv.maxUs == 100.0, "max converted to us");
+
+    // 1 回目の入れ替え: 直前の半分 (0..5 s) は残る
+    report = window->update(*histograms, 5'000'000, tscAt(5'000'000));
+    check(report.stages[static_cast<size_t>(convo::DspStage::Convolver)].samples == 100, "first rollover keeps the previous half");
+
+    // 2 回目の入れ替え: 0..5 s の記録は捨てられる
+    histograms->record(convo::DspStage::Convolver, 30000);
+    report = window->update(*histograms, 10'000'000, tscAt(10'000'000));
+    const auto& later = report.stages[static_cast<size_t>(convo::DspStage::Convolver)];
+    check(later.samples == 1, "second rollover drops the oldest half");
+    check(later.maxUs == 10.0, "max from the retained halves only");
+    check(report.windowSeconds == 5.0, "window length reported");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[StageLatencyHistogramTests] Start\n";
+    testBucketBoundaries();
+    testPercentiles();
+    testProbeMergesSplitStages();
+    testWindowDeltaAndRollover();
+    testLapSink();
+    std::cout << "[StageLatencyHistogramTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+//==============================================================================
+// StereoLaneNoiseShaperTests.cpp
+//
+// convo::dsp::processLatticeStereoLanes / processErrorFeedbackStereoLanes
+// (dsp/StereoLaneNoiseShaper.h) の一致テスト。
+// L/R を SIMD レーンに載せた再帰が、チャンネルごとのスカラー再帰
+// (LatticeNoiseShaper::processSample / PsychoacousticDither の旧ステレオループと同じ式) と
+//   1. 同じディザ列に対して出力・状態ともビット一致すること
+//   2. ブロック分割しても状態が正しく引き継がれること
+//   3. 過大入力 (量子化クランプ・誤差クランプ・状態クランプが効く領域) でも一致すること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#if defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "dsp/StereoLaneNoiseShaper.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+bool bitEqual(const std::vector<double>& a, const std::vector<double>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (std::bit_cast<std::uint64_t>(a[i]) != std::bit_cast<std::uint64_t>(b[i]))
+            return false;
+    return true;
+}
+
+// チャンネル別の決定的な一様乱数 [0, 1)
+struct UniformSource
+{
+    std::array<std::uint64_t, 2> state { 0x9E3779B97F4A7C15ull, 0xD1B54A32D192ED03ull };
+
+    double next(int channel)
+    {
+        std::uint64_t& x = state[static_cast<size_t>(channel)];
+        x ^= x >> 12;
+        x ^= x << 25;
+        x ^= x >> 27;
+        return static_cast<double>((x * 2685821657736338717ull) >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+std::vector<double> makeSignal(std::mt19937& rng, int n, double amplitude)
+{
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::vector<double> signal(static_cast<size_t>(n));
+    for (auto& v : signal) v = dist(rng);
+    return signal;
+}
+
+//------------------------------------------------------------------------------
+// 格子: LatticeNoiseShaper::processSample と同じ式のスカラー参照
+//------------------------------------------------------------------------------
+constexpr int kLatticeOrder = 9;
+
+double referenceLatticeSample(double input, std::array<double, kLatticeOrder>& state, const double* coeffs,
+                              double headroom, const convo::dsp::LatticeLaneQuantizer& q, double dither)
+{
+    __m256d vSum = _mm256_mul_pd(_mm256_loadu_pd(state.data()), _mm256_loadu_pd(coeffs));
+    vSum = _mm256_fmadd_pd(_mm256_loadu_pd(state.data() + 4), _mm256_loadu_pd(coeffs + 4), vSum);
+    __m128d vSum128 = _mm_add_pd(_mm256_castpd256_pd128(vSum), _mm256_extractf128_pd(vSum, 1));
+    vSum128 = _mm_hadd_pd(vSum128, vSum128);
+    double feedback = _mm_cvtsd_f64(vSum128);
+    feedback += state[8] * coeffs[8];
+
+    const double shaped = (input * headroom) + feedback;
+    double value = shaped;
+    if (value < q.minValue)
+        value = q.minValue;
+    else if (value > q.maxValue)
+        value = q.maxValue;
+    value += dither;
+    __m128d rounded = _mm_set_sd(value * q.invScale);
+    rounded = _mm_round_sd(rounded, rounded, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const double quantized = std::clamp(_mm_cvtsd_f64(rounded), q.minQ, q.maxQ) * q.scale;
+
+    double error = quantized - shaped;
+    if (!std::isfinite(error))
+        error = 0.0;
+    error = std::clamp(error, -q.errorLimit, q.errorLimit);
+
+    double forward = error;
+    for (int i = 0; i < kLatticeOrder; ++i)
+    {
+        const double backward = state[static_cast<size_t>(i)];
+        const double nextForward = forward + coeffs[i] * backward;
+        const double nextBackward = coeffs[i] * forward + backward;
+        state[static_cast<size_t>(i)] = std::clamp(nextBackward, -q.stateLimit, q.stateLimit);
+        forward = nextForward;
+    }
+    return quantized;
+}
+
+bool runLatticeCase(int bitDepth, double amplitude, const std::vector<int>& blocks, unsigned seed)
+{
+    const double coeffs[kLatticeOrder] { -0.31, 0.22, -0.17, 0.12, -0.085, 0.06, -0.04, 0.025, -0.012 };
+    convo::dsp::LatticeLaneQuantizer q;
+    q.invScale = std::ldexp(1.0, bitDepth - 1);
+    q.scale = 1.0 / q.invScale;
+    q.maxValue = 1.0 - q.scale;
+    q.minQ = -q.invScale;
+    q.maxQ = q.invScale - 1.0;
+    q.errorLimit = 2.0 * q.scale;
+    constexpr double kHeadroom = 0.8912509381337456;
+
+    std::array<double, kLatticeOrder> refStateL {}, refStateR {};
+    std::array<double, kLatticeOrder> laneStateL {}, laneStateR {};
+    UniformSource refUniform, laneUniform;
+    std::mt19937 rng(seed);
+
+    bool outputsMatch = true;
+    for (const int n : blocks)
+    {
+        auto left = makeSignal(rng, n, amplitude);
+        auto right = makeSignal(rng, n, amplitude);
+        std::vector<double> expectedL(left.size()), expectedR(right.size());
+        for (int i = 0; i < n; ++i)
+        {
+            const double dL = (refUniform.next(0) + refUniform.next(0) - 1.0) * q.scale;
+            expectedL[static_cast<size_t>(i)] = referenceLatticeSample(left[static_cast<size_t>(i)], refStateL, coeffs, kHeadroom, q, dL);
+            const double dR = (refUniform.next(1) + refUniform.next(1) - 1.0) * q.scale;
+            expectedR[static_cast<size_t>(i)] = referenceLatticeSample(right[static_cast<size_t>(i)], refStateR, coeffs, kHeadroom, q, dR);
+        }
+
+        convo::dsp::processLatticeStereoLanes(coeffs, laneStateL.data(), laneStateR.data(), left.data(), right.data(),
+                                              n, kHeadroom, q,
+                                              [&laneUniform, &q](int channel)
+                                              {
+                                                  const double u1 = laneUniform.next(channel);
+                                                  const double u2 = laneUniform.next(channel);
+                                                  return (u1 + u2 - 1.0) * q.scale;
+                                              });
+        outputsMatch = outputsMatch && bitEqual(left, expectedL) && bitEqual(right, expectedR);
+    }
+
+    const bool statesMatch = bitEqual({ laneStateL.begin(), laneStateL.end() }, { refStateL.begin(), refStateL.end() })
+                          && bitEqual({ laneStateR.begin(), laneStateR.end() }, { refStateR.begin(), refStateR.end() });
+    return outputsMatch && statesMatch;
+}
+
+//------------------------------------------------------------------------------
+// FIR 誤差フィードバック: PsychoacousticDither の旧ステレオループと同じ式のスカラー参照
+//------------------------------------------------------------------------------
+constexpr int kFirOrder = 12;
+constexpr double kDenormThreshold = 1.0e-30;
+
+double referenceFirSample(double input, double* z, const double* c, double headroom,
+                          double scale, double invScale, double dither)
+{
+    const double shapedError = c[0]*z[0] + c[1]*z[1] + c[2]*z[2]
+                             + c[3]*z[3] + c[4]*z[4] + c[5]*z[5]
+                             + c[6]*z[6] + c[7]*z[7] + c[8]*z[8]
+                             + c[9]*z[9] + c[10]*z[10] + c[11]*z[11];
+    const double tmp = (input * headroom) + dither + shapedError;
+
+    __m128d v = _mm_set_sd(tmp * invScale);
+    v = _mm_round_sd(v, v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const double quantized = _mm_cvtsd_f64(v) * scale;
+
+    const double error = tmp - quantized;
+    for (int t = kFirOrder - 1; t > 0; --t)
+        z[t] = z[t - 1];
+    const double absError = (error < 0.0) ? -error : error;
+    z[0] = (absError < kDenormThreshold) ? 0.0 : error;
+    return quantized;
+}
+
+bool runFirCase(int bitDepth, double amplitude, const std::vector<int>& blocks, unsigned seed)
+{
+    // PsychoacousticDither::kCoeffTable[1][1] (48 kHz / 24bit 標準)
+    const double coeffs[kFirOrder] { 2.42, -4.18, 5.75, -6.32, 5.87, -4.65, 3.27, -1.80, 0.66, -0.20, 0.08, -0.03 };
+    const double invScale = std::pow(2.0, bitDepth - 1);
+    const double scale = 1.0 / invScale;
+    constexpr double kHeadroom = 0.8912509381337456;
+
+    std::vector<double> refZL(kFirOrder, 0.0), refZR(kFirOrder, 0.0);
+    std::vector<double> laneZL(kFirOrder, 0.0), laneZR(kFirOrder, 0.0);
+    UniformSource refUniform, laneUniform;
+    std::mt19937 rng(seed);
+
+    const auto tpdf = [scale](UniformSource& source, int channel)
+    {
+        const double u1 = source.next(channel);
+        const double u2 = source.next(channel);
+        return ((u1 - 0.5) + (u2 - 0.5)) * scale;
+    };
+
+    bool outputsMatch = true;
+    for (const int n : blocks)
+    {
+        auto left = makeSignal(rng, n, amplitude);
+        auto right = makeSignal(rng, n, amplitude);
+        std::vector<double> expectedL(left.size()), expectedR(right.size());
+        for (int i = 0; i < n; ++i)
+        {
+            const double dL = tpdf(refUniform, 0);
+            const double dR = tpdf(refUniform, 1);
+            expectedL[static_cast<size_t>(i)] = referenceFirSample(left[static_cast<size_t>(i)], refZL.data(), coeffs, kHeadroom, scale, invScale, dL);
+            expectedR[static_cast<size_t>(i)] = referenceFirSample(right[static_cast<size_t>(i)], refZR.data(), coeffs, kHeadroom, scale, invScale, dR);
+        }
+
+        convo::dsp::processErrorFeedbackStereoLanes<kFirOrder>(coeffs, laneZL.data(), laneZR.data(),
+                                                               left.data(), right.data(), n, kHeadroom,
+                                                               scale, invScale, kDenormThreshold,
+                                                               [&](int channel) { return tpdf(laneUniform, channel); });
+        outputsMatch = outputsMatch && bitEqual(left, expectedL) && bitEqual(right, expectedR);
+    }
+
+    return outputsMatch && bitEqual(laneZL, refZL) && bitEqual(laneZR, refZR);
+}
+
+void testLattice()
+{
+    check(runLatticeCase(24, 0.5, { 32, 32, 32, 32 }, 1), "lattice lanes match scalar (24bit, 32-sample blocks)");
+    check(runLatticeCase(16, 0.5, { 1, 7, 64, 3, 480 }, 2), "lattice lanes match scalar across odd block splits (16bit)");
+    check(runLatticeCase(16, 1.6, { 256, 256 }, 3), "lattice lanes match scalar with clipping input");
+}
+
+void testErrorFeedback()
+{
+    check(runFirCase(24, 0.5, { 32, 32, 32, 32 }, 4), "error feedback lanes match scalar (24bit, 32-sample blocks)");
+    check(runFirCase(16, 0.5, { 1, 7, 64, 3, 480 }, 5), "error feedback lanes match scalar across odd block splits (16bit)");
+    check(runFirCase(32, 0.25, { 128 }, 6), "error feedback lanes match scalar (32bit, denormal-scale errors)");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[StereoLaneNoiseShaperTests] Start\n";
+    testLattice();
+    testErrorFeedback();
+    std::cout << "[StereoLaneNoiseShaperTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+//==============================================================================
+// TruePeakDetectorTests.cpp
+//
+// TruePeakDetector (ポリフェーズ 4x + 区間単位の早期打ち切り) のテスト。
+//   1. 2x ハーフバンド 2 段のカスケード (従来の全補間 → 最大値) とピークホールド列が一致すること
+//   2. fs/4 の 45° 位相サイン波でインターサンプルピーク (≈ +3 dB) を検出すること
+//   3. ホールド値を超えない区間と無音区間で FIR を省くこと (省いてもホールド値は同じ)
+//   4. ブロック長を変えても、モノラル入力でも結果が変わらないこと
+// を検証する。JUCE 非依存 (AlignedAllocation のため MKL をリンク)。
+//==============================================================================
+#include "TruePeakDetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr double kSampleRate = 48000.0;
+constexpr int kBlock = 512;
+
+// 従来実装: 2 段のカスケードで 4x 信号を作り、全サンプルを走査する
+class CascadeReference
+{
+public:
+    explicit CascadeReference(int taps)
+    {
+        const int stageTaps[2] = { taps, std::max(15, taps / 2) };
+        for (int i = 0; i < 2; ++i)
+        {
+            stages[i].design(stageTaps[i], TruePeakDetector::kDefaultAttenuationDb);
+            for (auto& h : histories[i])
+                h.assign(static_cast<size_t>(stages[i].interpolateHistoryKeep()), 0.0);
+        }
+    }
+
+    double process(const double* left, const double* right, int numSamples)
+    {
+        double peak = 0.0;
+        const double* inputs[2] = { left, right };
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            std::vector<double> signal(inputs[ch], inputs[ch] + numSamples);
+            for (int s = 0; s < 2; ++s)
+                signal = interpolate(s, ch, signal);
+            for (double v : signal)
+                peak = std::max(peak, std::abs(v));
+        }
+        if (peak > hold)
+            hold = peak;
+        else
+            hold *= 0.999;
+        return hold;
+    }
+
+private:
+    std::vector<double> interpolate(int s, int ch, const std::vector<double>& input)
+    {
+        auto& h = histories[s][ch];
+        const int keep = stages[s].interpolateHistoryKeep();
+        const int n = static_cast<int>(input.size());
+        std::vector<double> buffer(h);
+        buffer.insert(buffer.end(), input.begin(), input.end());
+        std::vector<double> output(static_cast<size_t>(n) * 2);
+        stages[s].interpolate(buffer.data(), keep, n, output.data());
+        h.assign(buffer.end() - keep, buffer.end());
+        return output;
+    }
+
+    convo::dsp::HalfBandFir stages[2];
+    std::vector<double> histories[2][2];
+    double hold = 0.0;
+};
+
+std::vector<double> makeNoise(int numSamples, double amplitude, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::vector<double> v(static_cast<size_t>(numSamples));
+    for (auto& x : v)
+        x = dist(rng);
+    return v;
+}
+
+void testMatchesCascade()
+{
+    for (int taps : { 31, 63 })
+    {
+        TruePeakDetector detector;
+        detector.prepare(kSampleRate, kBlock, taps);
+        CascadeReference reference(taps);
+
+        // 大小の入り混じるブロック列 (ホールド減衰中の区間を含む)
+        const int numBlocks = 40;
+        const auto left = makeNoise(kBlock * numBlocks, 1.0, 1u);
+        const auto right = makeNoise(kBlock * numBlocks, 1.0, 2u);
+        double maxError = 0.0;
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            const double scale = (b % 7 == 3) ? 1.0 : 0.05 * (1 + b % 5);
+            std::vector<double> l(left.begin() + b * kBlock, left.begin() + (b + 1) * kBlock);
+            std::vector<double> r(right.begin() + b * kBlock, right.begin() + (b + 1) * kBlock);
+            for (auto& x : l) x *= scale;
+            for (auto& x : r) x *= scale;
+            const double expected = reference.process(l.data(), r.data(), kBlock);
+            const double actual = detector.processBlock(l.data(), r.data(), kBlock);
+            maxError = std::max(maxError, std::abs(actual - expected));
+        }
+        check(maxError < 1.0e-12, "peak hold matches the two-stage cascade (taps " + std::to_string(taps)
+                                      + ", max error " + std::to_string(maxError) + ")");
+    }
+}
+
+void testIntersamplePeak()
+{
+    TruePeakDetector detector;
+    detector.prepare(kSampleRate, kBlock);
+    std::vector<double> signal(static_cast<size_t>(kBlock));
+    for (int i = 0; i < kBlock; ++i)
+        signal[static_cast<size_t>(i)] = std::sin(std::numbers::pi * 0.5 * i + std::numbers::pi * 0.25);
+
+    double peak = 0.0;
+    for (int b = 0; b < 8; ++b)
+        peak = detector.processBlock(signal.data(), signal.data(), kBlock);
+    const double samplePeak = std::sqrt(0.5);
+    check(peak > samplePeak * 1.38 && peak < samplePeak * 1.43, "fs/4 sine at 45 degrees reaches about +3 dB over the sample peak");
+}
+
+void testEarlyExit()
+{
+    TruePeakDetector detector;
+    detector.prepare(kSampleRate, kBlock);
+
+    const auto loud = makeNoise(kBlock, 1.0, 3u);
+    const double held = detector.processBlock(loud.data(), loud.data(), kBlock);
+    check(detector.lastSkippedChunks() < detector.lastTotalChunks(), "a loud first block runs the FIR");
+
+    // 十分小さいブロックは上界がホールド値を超えないので FIR を省き、ホールドは通常どおり減衰する
+    // (各チャンネル先頭の区間は前ブロックの大きな履歴を窓に含むため走ることがある)
+    const auto quiet = makeNoise(kBlock, 0.01, 4u);
+    const double decayed = detector.processBlock(quiet.data(), quiet.data(), kBlock);
+    check(detector.lastSkippedChunks() >= detector.lastTotalChunks() - 2, "quiet block below the hold skips the FIR");
+    check(decayed == held * 0.999, "skipped block still decays the hold");
+
+    // 無音は表示下限未満なので、ホールドが減衰しきった後も FIR を通さない
+    TruePeakDetector silent;
+    silent.prepare(kSampleRate, kBlock);
+    const std::vector<double> zeros(static_cast<size_t>(kBlock), 0.0);
+    check(silent.processBlock(zeros.data(), zeros.data(), kBlock) == 0.0, "silence measures zero");
+    check(silent.lastSkippedChunks() == silent.lastTotalChunks(), "silence skips every chunk");
+}
+
+void testBlockSizeAndMono()
+{
+    const int total = kBlock * 6;
+    const auto signal = makeNoise(total, 0.8, 5u);
+
+    TruePeakDetector whole, split, mono;
+    whole.prepare(kSampleRate, kBlock);
+    split.prepare(kSampleRate, 100);   // maxBlockSize より長いブロックは内部で分割する
+    mono.prepare(kSampleRate, kBlock);
+
+    double a = 0.0, b = 0.0, c = 0.0;
+    for (int offset = 0; offset < total; offset += kBlock)
+    {
+        a = whole.processBlock(signal.data() + offset, signal.data() + offset, kBlock);
+        b = split.processBlock(signal.data() + offset, signal.data() + offset, kBlock);
+        c = mono.processBlock(signal.data() + offset, nullptr, kBlock);
+    }
+    check(std::abs(a - b) < 1.0e-12, "internal splitting does not change the peak");
+    check(a == c, "mono input measures the same as identical L/R");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[TruePeakDetectorTests] Start\n";
+    testMatchesCascade();
+    testIntersamplePeak();
+    testEarlyExit();
+    testBlockSizeAndMono();
+    std::cout << "[TruePeakDetectorTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+//==============================================================================
+// WorkStealingRangesTests.cpp
+//
+// convo::WorkStealingRanges (core/WorkStealingRanges.h) のテスト。
+//   1. 単一ワーカーで全タスクを昇順に取り出せること
+//   2. 均等分割と、空になったワーカーが他の範囲の後半を奪うこと
+//   3. 複数スレッド (1 本だけ低速) で全タスクがちょうど 1 回ずつ処理され、
+//      低速ワーカーの担当分が他ワーカーに奪われること
+// JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+
+#include "core/WorkStealingRanges.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr int kMaxWorkers = 6;
+using Ranges = convo::WorkStealingRanges<kMaxWorkers>;
+
+void testSingleWorker()
+{
+    Ranges ranges;
+    ranges.reset(10, 1);
+    int task = -1;
+    bool ordered = true;
+    for (int expected = 0; expected < 10; ++expected)
+        ordered = ordered && ranges.pop(0, task) && task == expected;
+    check(ordered, "single worker pops tasks in order");
+    check(!ranges.pop(0, task), "single worker: empty after all tasks");
+
+    ranges.reset(0, 3);
+    check(!ranges.pop(0, task) && !ranges.pop(2, task), "zero tasks: nothing to pop");
+}
+
+void testStealHalf()
+{
+    Ranges ranges;
+    ranges.reset(12, 3);  // [0,4) [4,8) [8,12)
+
+    int task = -1;
+    bool ownFirst = true;
+    for (int expected = 0; expected < 4; ++expected)
+        ownFirst = ownFirst && ranges.pop(0, task) && task == expected;
+    check(ownFirst, "worker 0 drains its own range first");
+
+    // 空になったワーカー 0 は隣 (ワーカー 1: [4,8)) の後半 [6,8) を奪う
+    check(ranges.pop(0, task) && task == 6, "steals the first task of the victim's upper half");
+    check(ranges.pop(0, task) && task == 7, "continues with the stolen remainder");
+    check(ranges.pop(1, task) && task == 4, "victim keeps its lower half");
+    check(ranges.pop(1, task) && task == 5, "victim lower half continues");
+
+    // ワーカー 1 も空 → ワーカー 2 [8,12) の後半 [10,12) を奪う
+    check(ranges.pop(1, task) && task == 10, "second steal from the next worker");
+
+    std::vector<int> seen;
+    while (ranges.pop(2, task))
+        seen.push_back(task);
+    while (ranges.pop(1, task))
+        seen.push_back(task);
+    std::vector<int> expectedRest = { 8, 9, 11 };
+    std::sort(seen.begin(), seen.end());
+    check(seen == expectedRest, "remaining tasks are handed out exactly once");
+}
+
+void testConcurrentSlowWorker()
+{
+    constexpr int kTasks = 4000;
+    constexpr int kWorkers = kMaxWorkers;
+    constexpr int kRounds = 20;
+
+    Ranges ranges;
+    bool allOnce = true;
+    bool slowWorkerStolenFrom = true;
+
+    for (int round = 0; round < kRounds; ++round)
+    {
+        std::vector<std::atomic<int>> hits(kTasks);
+        for (auto& h : hits)
+            h.store(0);
+        std::atomic<int> processedBySlow { 0 };
+
+        ranges.reset(kTasks, kWorkers);
+        std::vector<std::thread> threads;
+        for (int w = 0; w < kWorkers; ++w)
+        {
+            threads.emplace_back([&, w]
+            {
+                int task = -1;
+                while (ranges.pop(w, task))
+                {
+                    hits[static_cast<size_t>(task)].fetch_add(1, std::memory_order_relaxed);
+                    if (w == 0)
+                    {
+                        // E コア / プリエンプトされたワーカーを模擬
+                        processedBySlow.fetch_add(1, std::memory_order_relaxed);
+                        std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    }
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        for (const auto& h : hits)
+            allOnce = allOnce && h.load() == 1;
+        slowWorkerStolenFrom = slowWorkerStolenFrom && processedBySlow.load() < kTasks / kWorkers;
+    }
+
+    check(allOnce, "concurrent: every task processed exactly once");
+    check(slowWorkerStolenFrom, "concurrent: slow worker's share is stolen by the others");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[WorkStealingRangesTests] Start\n";
+    testSingleWorker();
+    testStealHalf();
+    testConcurrentSlowWorker();
+    std::cout << "[WorkStealingRangesTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
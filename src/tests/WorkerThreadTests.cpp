@@ -0,0 +1,184 @@
+//==============================================================================
+// WorkerThreadTests.cpp
+//
+// convo::WorkerThread (core/WorkerThread.h) の期限駆動起床のテスト。
+//   1. 期限が無い間は一度も起きないこと (アイドル時に CPU を使わない)
+//   2. scheduleAfter が期限より前に発火せず、1 回だけ onDue を呼ぶこと
+//   3. 後から登録した早い期限が前倒しで勝ち、遅い期限は無視されること
+//   4. 同じ期限へのバースト登録が 1 回の起床に畳まれること / wake が直ちに起こすこと
+//   5. onThreadStart がワーカースレッド上で 1 回呼ばれ、stop で予約が破棄されること
+// JUCE / MKL 非依存。
+//==============================================================================
+
+#include "core/WorkerThread.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+using Clock = convo::WorkerThread::Clock;
+using std::chrono::milliseconds;
+
+// onDue の呼び出し回数と最初の呼び出し時刻を記録する
+struct DueRecorder {
+    std::atomic<int> calls { 0 };
+    std::mutex mutex;
+    Clock::time_point firstCall {};
+
+    void onDue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (calls.load(std::memory_order_relaxed) == 0)
+                firstCall = Clock::now();
+        }
+        calls.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    Clock::time_point first()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return firstCall;
+    }
+};
+
+bool waitForCalls(const DueRecorder& recorder, int expected, milliseconds timeout)
+{
+    const auto until = Clock::now() + timeout;
+    while (Clock::now() < until)
+    {
+        if (recorder.calls.load(std::memory_order_acquire) >= expected)
+            return true;
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return recorder.calls.load(std::memory_order_acquire) >= expected;
+}
+
+void testIdleNeverWakes()
+{
+    DueRecorder recorder;
+    convo::WorkerThread worker([&] { recorder.onDue(); });
+    worker.scheduleAfter(milliseconds(1));   // start 前の予約は無視される
+    worker.start();
+    std::this_thread::sleep_for(milliseconds(150));
+    check(recorder.calls.load() == 0, "idle: no deadline, no wake-ups");
+    check(!worker.hasDeadline(), "idle: schedule before start is dropped");
+    worker.stop();
+}
+
+void testDeadlineFiresOnce()
+{
+    DueRecorder recorder;
+    convo::WorkerThread worker([&] { recorder.onDue(); });
+    worker.start();
+
+    const auto armedAt = Clock::now();
+    worker.scheduleAfter(milliseconds(40));
+    check(worker.hasDeadline(), "deadline: armed");
+    check(waitForCalls(recorder, 1, milliseconds(2000)), "deadline: fires");
+    check(recorder.first() - armedAt >= milliseconds(40), "deadline: never fires early");
+    std::this_thread::sleep_for(milliseconds(60));
+    check(recorder.calls.load() == 1, "deadline: fires exactly once");
+    check(!worker.hasDeadline(), "deadline: disarmed after firing");
+    worker.stop();
+}
+
+void testEarlierDeadlineWins()
+{
+    DueRecorder recorder;
+    convo::WorkerThread worker([&] { recorder.onDue(); });
+    worker.start();
+
+    const auto armedAt = Clock::now();
+    worker.scheduleAfter(milliseconds(5000));
+    worker.scheduleAfter(milliseconds(20));     // 前倒し
+    worker.scheduleAfter(milliseconds(3000));   // 遅い期限は無視
+    check(waitForCalls(recorder, 1, milliseconds(2000)), "earlier: pulled-in deadline fires");
+    check(recorder.first() - armedAt < milliseconds(2000), "earlier: late deadlines did not hold it back");
+    check(!worker.hasDeadline(), "earlier: later deadlines were folded away");
+    worker.stop();
+}
+
+void testBurstCoalescesAndWake()
+{
+    DueRecorder recorder;
+    convo::WorkerThread worker([&] { recorder.onDue(); });
+    worker.start();
+
+    const auto due = Clock::now() + milliseconds(30);
+    for (int i = 0; i < 1000; ++i)
+        worker.scheduleAt(due);
+    check(waitForCalls(recorder, 1, milliseconds(2000)), "burst: fires");
+    std::this_thread::sleep_for(milliseconds(50));
+    check(recorder.calls.load() == 1, "burst: 1000 schedules -> one wake-up");
+    check(worker.getWakeCount() == 1, "burst: wake count matches");
+
+    const auto wokenAt = Clock::now();
+    worker.wake();
+    check(waitForCalls(recorder, 2, milliseconds(2000)), "wake: fires");
+    check(Clock::now() - wokenAt < milliseconds(1000), "wake: fires promptly");
+    worker.stop();
+}
+
+void testThreadStartAndStop()
+{
+    DueRecorder recorder;
+    std::atomic<int> starts { 0 };
+    std::thread::id startThread;
+    std::mutex startMutex;
+    {
+        convo::WorkerThread worker([&] { recorder.onDue(); },
+                                   [&]
+                                   {
+                                       std::lock_guard<std::mutex> lock(startMutex);
+                                       startThread = std::this_thread::get_id();
+                                       starts.fetch_add(1);
+                                   });
+        worker.start();
+        worker.start();   // 二重 start は無視
+        worker.scheduleAfter(milliseconds(200));
+        std::this_thread::sleep_for(milliseconds(20));
+        worker.stop();    // 期限前の stop で予約は破棄される
+        std::this_thread::sleep_for(milliseconds(250));
+        check(recorder.calls.load() == 0, "stop: pending deadline is discarded");
+        check(!worker.hasDeadline(), "stop: no deadline after stop");
+    }
+    std::lock_guard<std::mutex> lock(startMutex);
+    check(starts.load() == 1, "start: onThreadStart runs once");
+    check(startThread != std::this_thread::get_id(), "start: onThreadStart runs on the worker thread");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[WorkerThreadTests] Start\n";
+    testIdleNeverWakes();
+    testDeadlineFiresOnce();
+    testEarlierDeadlineWins();
+    testBurstCoalescesAndWake();
+    testThreadStartAndStop();
+    std::cout << "[WorkerThreadTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+//==============================================================================
+// XrunIncidentCorrelatorTests.cpp
+//
+// convo::XrunIncidentCorrelator (audioengine/XrunIncidentCorrelator.h) のテスト。
+//   1. 期待周期内の callback は incident にならず、処理超過 / 到着遅れだけが積まれること
+//   2. publish / reclaim の ActivityWindow が callback と重なったとき (途中で完了・開始時に実行中・
+//      終了時に実行中) だけフラグが立つこと
+//   3. CPU 移動 (callback 内・前回からの) とコンテキスト由来のフラグ、段別サイクルと支配段
+//   4. 履歴が直近 kHistory 件を古い順に保ち、フラグ別件数と支配段の件数が合うこと
+//   5. drain 前にリングが溢れた分が dropped に数えられること
+//   6. StageLatencyHistograms::takeCallbackCycles が 1 callback 分を返して空になること
+// を検証する。JUCE / MKL 非依存 (ヘッダオンリー)。
+//==============================================================================
+#include "audioengine/XrunIncidentCorrelator.h"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+int g_testsPassed = 0;
+int g_testsFailed = 0;
+
+void check(bool condition, const std::string& label)
+{
+    if (condition)
+        ++g_testsPassed;
+    else
+        ++g_testsFailed, std::cerr << "[FAIL] " << label << "\n";
+}
+
+constexpr uint64_t kExpectedUs = 1'000;
+constexpr std::array<uint64_t, convo::kNumDspStages> kNoStages {};
+
+// startUs から durationUs 走る callback を 1 回流す
+bool runCallback(convo::XrunIncidentCorrelator& correlator, uint64_t index, uint64_t startUs, uint64_t durationUs,
+                 const convo::XrunCallbackContext& context = { 0, false, false, false },
+                 const std::array<uint64_t, convo::kNumDspStages>& stageCycles = kNoStages)
+{
+    const auto mark = correlator.beginCallback(startUs, context.cpu);
+    return correlator.endCallback(mark, index, startUs + durationUs, kExpectedUs, context, stageCycles);
+}
+
+void testOnlyMissesAreRecorded()
+{
+    auto correlator = std::make_unique<convo::XrunIncidentCorrelator>();
+    check(!runCallback(*correlator, 0, 10'000, 400), "first callback within budget");
+    check(!runCallback(*correlator, 1, 11'000, 999), "callback at budget edge");
+    check(runCallback(*correlator, 2, 12'000, 1'500), "overran callback recorded");
+    // 閾値は max(1.5 ms, 3 ms) = 3 ms
+    check(!runCallback(*correlator, 3, 14'900, 100), "2.9 ms interval is not late");
+    check(runCallback(*correlator, 4, 18'000, 100), "3.1 ms interval is late");
+    check(correlator->drain() == 2, "two incidents drained");
+
+    const auto report = correlator->report();
+    check(report.count == 2 && report.totalIncidents == 2, "report count");
+    check(report.incidents[0].callbackIndex == 2 && report.incidents[0].has(convo::XrunIncident::kOverran)
+              && !report.incidents[0].has(convo::XrunIncident::kLateArrival),
+          "overran incident flags");
+    check(report.incidents[0].callbackUs == 1'500 && report.incidents[0].expectedUs == kExpectedUs,
+          "overran incident timing");
+    check(report.incidents[1].callbackIndex == 4 && report.incidents[1].has(convo::XrunIncident::kLateArrival)
+              && report.incidents[1].intervalUs == 3'100,
+          "late incident interval");
+}
+
+void testZeroExpectedDisables()
+{
+    auto correlator = std::make_unique<convo::XrunIncidentCorrelator>();
+    const auto mark = correlator->beginCallback(1'000, 0);
+    check(!correlator->endCallback(mark, 0, 90'000, 0, {}, kNoStages), "expected 0 never records");
+    check(correlator->drain() == 0, "nothing pending");
+}
+
+void testActivityOverlap()
+{
+    auto correlator = std::make_unique<convo::XrunIncidentCorrelator>();
+    auto& publication = correlator->publicationActivity();
+    auto& retire = correlator->retireActivity();
+
+    // 途中で完了した publish
+    {
+        const auto mark = correlator->beginCallback(1'000, 0);
+        publication.begin();
+        publication.end();
+        correlator->endCallback(mark, 0, 3'000, kExpectedUs, { 0, false, false, false }, kNoStages);
+    }
+    // 開始時から走り続けている reclaim
+    retire.begin();
+    {
+        const auto mark = correlator->beginCallback(3'500, 0);
+        correlator->endCallback(mark, 1, 5'000, kExpectedUs, { 0, false, false, false }, kNoStages);
+    }
+    retire.end();
+    // 前の callback の後に完了したものは重なりに数えない
+    {
+        const auto mark = correlator->beginCallback(6'000, 0);
+        correlator->endCallback(mark, 2, 8'000, kExpectedUs, { 0, false, false, false }, kNoStages);
+    }
+    // 終了時点で始まっている publish (Scope の中で終わる)
+    {
+        const auto mark = correlator->beginCallback(8'500, 0);
+        convo::ActivityWindow::Scope scope(publication);
+        correlator->endCallback(mark, 3, 10'000, kExpectedUs, { 0, false, false, false }, kNoStages);
+    }
+
+    correlator->drain();
+    const auto report = correlator->report();
+    check(report.count == 4, "four overran callbacks");
+    check(report.incidents[0].has(convo::XrunIncident::kPublication)
+              && !report.incidents[0].has(convo::XrunIncident::kRetire),
+          "publish completed inside callback");
+    check(report.incidents[1].has(convo::XrunIncident::kRetire)
+              && !report.incidents[1].has(convo::XrunIncident::kPublication),
+          "reclaim active across callback");
+    check(!report.incidents[2].has(convo::XrunIncident::kPublication)
+              && !report.incidents[2].has(convo::XrunIncident::kRetire),
+          "earlier activity does not leak");
+    check(report.incidents[3].has(convo::XrunIncident::kPublication), "publish running at callback end");
+    check(report.flagCounts[3] == 2 && report.flagCounts[4] == 1, "publish / retire counts");
+}
+
+void testContextFlagsAndStages()
+{
+    auto correlator = std::make_unique<convo::XrunIncidentCorrelator>();
+    runCallback(*correlator, 0, 1'000, 100, { 2, false, false, false });
+
+    // 前回は CPU 2、今回は CPU 5 で開始
+    std::array<uint64_t, convo::kNumDspStages> stages {};
+    stages[static_cast<size_t>(convo::DspStage::Input)] = 100;
+    stages[static_cast<size_t>(convo::DspStage::Convolver)] = 5'000;
+    stages[static_cast<size_t>(convo::DspStage::Output)] = 300;
+    runCallback(*correlator, 1, 2'000, 2'000, { 5, true, true, true }, stages);
+
+    // callback 内の移動 (開始 CPU 5 → 終了 CPU 6)
+    {
+        const auto mark = correlator->beginCallback(5'000, 5);
+        correlator->endCallback(mark, 2, 7'000, kExpectedUs, { 6, false, false, false }, kNoStages);
+    }
+    // 移動なし
+    runCallback(*correlator, 3, 8'000, 2'000, { 6, false, false, false });
+
+    correlator->drain();
+    const auto report = correlator->report();
+    check(report.count == 3, "three incidents");
+    const auto& first = report.incidents[0];
+    check(first.has(convo::XrunIncident::kCpuMigrated) && first.prevCpu == 2 && first.cpu == 5,
+          "migration since previous callback");
+    check(first.has(convo::XrunIncident::kCrossfade) && first.has(convo::XrunIncident::kLearnerRunning)
+              && first.has(convo::XrunIncident::kRebuildActive),
+          "context flags copied");
+    check(first.stageCycles == stages && first.dominantStage() == convo::DspStage::Convolver, "stage breakdown");
+    check(report.incidents[1].has(convo::XrunIncident::kCpuMigrated), "migration inside callback");
+    check(!report.incidents[2].has(convo::XrunIncident::kCpuMigrated)
+              && !report.incidents[2].has(convo::XrunIncident::kCrossfade),
+          "no spurious flags");
+    check(report.incidents[2].dominantStage() == convo::DspStage::Count, "no stages means no dominant");
+    check(report.dominantStageCounts[static_cast<size_t>(convo::DspStage::Convolver)] == 1, "dominant stage count");
+}
+
+void testHistoryWrapsAndDrops()
+{
+    auto correlator = std::make_unique<convo::XrunIncidentCorrelator>();
+    constexpr size_t kTotal = convo::XrunIncidentCorrelator::kHistory + 5;
+    uint64_t startUs = 1'000;
+    for (size_t i = 0; i < kTotal; ++i)
+    {
+        runCallback(*correlator, i, startUs, 2'000);
+        startUs += 2'500;
+        if ((i + 1) % 8 == 0)
+            correlator->drain();
+    }
+    correlator->drain();
+    auto report = correlator->report();
+    check(report.totalIncidents == kTotal, "total counts every incident");
+    check(report.count == convo::XrunIncidentCorrelator::kHistory, "history capped");
+    check(report.incidents[0].callbackIndex == kTotal - convo::XrunIncidentCorrelator::kHistory
+              && report.incidents[report.count - 1].callbackIndex == kTotal - 1,
+          "history is oldest-first");
+    check(report.droppedIncidents == 0, "no drops when drained in time");
+
+    for (size_t i = 0; i < convo::XrunIncidentCorrelator::kPendingCapacity + 3; ++i)
+    {
+        runCallback(*correlator, 1'000 + i, startUs, 2'000);
+        startUs += 2'500;
+    }
+    report = correlator->report();
+    check(report.droppedIncidents == 3, "overflow counted as dropped");
+
+    correlator->clearHistory();
+    report = correlator->report();
+    check(report.count == 0 && report.totalIncidents == 0 && report.droppedIncidents == 0, "clearHistory empties");
+}
+
+void testResetCallbackTiming()
+{
+    auto correlator = std::make_unique<convo::XrunIncidentCorrelator>();
+    runCallback(*correlator, 0, 1'000, 100, { 1, false, false, false });
+    correlator->resetCallbackTiming();
+    // デバイス再起動後の最初の callback は間隔も CPU 移動も見ない
+    check(!runCallback(*correlator, 1, 900'000, 100, { 3, false, false, false }), "no late arrival after reset");
+    runCallback(*correlator, 2, 901'000, 2'000, { 3, false, false, false });
+    correlator->drain();
+    const auto report = correlator->report();
+    check(report.count == 1 && !report.incidents[0].has(convo::XrunIncident::kCpuMigrated), "cpu baseline restarted");
+}
+
+void testTakeCallbackCycles()
+{
+    auto histograms = std::make_unique<convo::StageLatencyHistograms>();
+    histograms->record(convo::DspStage::Eq, 40);
+    histograms->record(convo::DspStage::Eq, 2);
+    histograms->record(convo::DspStage::Output, 7);
+    const auto cycles = histograms->takeCallbackCycles();
+    check(cycles[static_cast<size_t>(convo::DspStage::Eq)] == 42
+              && cycles[static_cast<size_t>(convo::DspStage::Output)] == 7
+              && cycles[static_cast<size_t>(convo::DspStage::Input)] == 0,
+          "callback cycles accumulated per stage");
+    const auto empty = histograms->takeCallbackCycles();
+    check(empty == kNoStages, "take clears the accumulator");
+}
+
+} // namespace
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main()
+{
+    std::cout << "[XrunIncidentCorrelatorTests] Start\n";
+    testOnlyMissesAreRecorded();
+    testZeroExpectedDisables();
+    testActivityOverlap();
+    testContextFlagsAndStages();
+    testHistoryWrapsAndDrops();
+    testResetCallbackTiming();
+    testTakeCallbackCycles();
+    std::cout << "[XrunIncidentCorrelatorTests] Passed: " << g_testsPassed
+              << ", Failed: " << g_testsFailed << "\n";
+    return (g_testsFailed == 0) ? 0 : 1;
+}
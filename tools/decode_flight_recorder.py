@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Flight recorder decoder - turns flight_recorder.bin into a timeline.
+
+The file is written by convo::FlightRecorder (src/audioengine/FlightRecorder.h, layout version 1).
+It lives in %APPDATA%/ConvoPeq/. flight_recorder.bin is the current (or crashed) session and
+flight_recorder.prev.bin is the one before it. A live process can be decoded too (the file is shared for read).
+
+usage: decode_flight_recorder.py [file] [--channel NAME ...] [--last N] [--csv]
+"""
+import argparse
+import csv
+import datetime
+import os
+import struct
+import sys
+
+MAGIC = b"CPFLTREC"
+VERSION = 1
+HEADER_BYTES = 4096
+RECORD_BYTES = 128
+CHANNEL_HEADER_OFFSET = 128
+CHANNEL_HEADER_BYTES = 64
+
+STATES = {0: "empty", 1: "running (not closed: crashed, killed or still alive)", 2: "closed cleanly"}
+CHANNELS = ["failure", "progress", "retire", "xrun", "diag", "lifecycle"]
+KINDS = {1: "failure", 2: "failureSnapshot", 3: "progress", 4: "retireTimeline",
+         5: "xrun", 6: "diagEvent", 7: "lifecycle"}
+
+FAILURE_STAGES = ["None", "Admission", "Validation", "Execution", "Bridge", "Shutdown"]
+FAILURE_REASONS = ["None", "AdmissionRejected", "ValidationFailed", "PublishFailed", "BridgeFailed",
+                   "ShutdownRejected", "StaleGeneration", "QueuePressure"]
+PUBLISH_STAGES = ["Submitted", "Built", "Validated", "Published", "Retired", "Reclaimed"]
+XRUN_FLAGS = ["overran", "late", "crossfade", "publish", "retire", "cpuMigrated", "learner", "rebuild"]
+DSP_STAGES = ["input", "osUp", "eq", "conv", "osDown", "output"]
+DIAG_CATEGORIES = ["None", "CPU_MIG", "CB_SEQ", "DSP_TIMING", "CALLBACK_STAGE", "EQ_TIME", "CONV_TIME",
+                   "STCONV_TIME", "CB_ARRIVAL", "ANS_SWITCH", "AUTO_GAIN_CLAMPED"]
+
+
+def name_of(table, index):
+    return table[index] if 0 <= index < len(table) else f"?{index}"
+
+
+def cstr(raw):
+    return raw.split(b"\0", 1)[0].decode("utf-8", "replace")
+
+
+def describe(kind, payload):
+    if kind == 1:
+        corr, stage, reason = struct.unpack_from("<QBB", payload)
+        origin = cstr(payload[16:64])
+        return (f"stage={name_of(FAILURE_STAGES, stage)} reason={name_of(FAILURE_REASONS, reason)} "
+                f"corr={corr:#x} origin={origin}")
+    if kind == 2:
+        values = struct.unpack_from("<11QBB", payload)
+        (corr, pubSeq, gen, world, tid, coord, shutdown, pubClass, readers, minEpoch, curEpoch, stage, reason) = values
+        return (f"stage={name_of(FAILURE_STAGES, stage)} reason={name_of(FAILURE_REASONS, reason)} corr={corr:#x} "
+                f"pubSeq={pubSeq} gen={gen} world={world} thread={tid} coordState={coord} shutdown={shutdown} "
+                f"class={pubClass} readers={readers} minEpoch={minEpoch} epoch={curEpoch}")
+    if kind == 3:
+        corr, gen, world, stage = struct.unpack_from("<3QB", payload)
+        return f"stage={name_of(PUBLISH_STAGES, stage)} corr={corr:#x} gen={gen} world={world}"
+    if kind == 4:
+        pubSeq, gen, world, retireEpoch, reclaimEpoch = struct.unpack_from("<5Q", payload)
+        return (f"pubSeq={pubSeq} gen={gen} world={world} retireEpoch={retireEpoch} "
+                f"reclaimEpoch={reclaimEpoch if reclaimEpoch else 'pending'}")
+    if kind == 5:
+        values = struct.unpack_from("<2Q6I6Q", payload)
+        index, startUs, cbUs, intervalUs, expectedUs, cpu, prevCpu, flags = values[:8]
+        cycles = values[8:]
+        flagNames = ",".join(XRUN_FLAGS[b] for b in range(len(XRUN_FLAGS)) if flags & (1 << b)) or "-"
+        dominant = max(range(len(cycles)), key=lambda i: cycles[i]) if any(cycles) else None
+        cpuText = "?" if cpu == 0xFFFFFFFF else str(cpu)
+        prevText = "?" if prevCpu == 0xFFFFFFFF else str(prevCpu)
+        return (f"cb={index} took={cbUs}us interval={intervalUs}us expected={expectedUs}us cpu={prevText}->{cpuText} "
+                f"[{flagNames}] dominant={DSP_STAGES[dominant] if dominant is not None else '-'}")
+    if kind == 6:
+        category = payload[0]
+        eventIndex = struct.unpack_from("<Q", payload, 8)[0]
+        return f"{name_of(DIAG_CATEGORIES, category)} cb={eventIndex} data={payload[16:88].hex()}"
+    if kind == 7:
+        code = struct.unpack_from("<I", payload)[0]
+        return f"{cstr(payload[8:104])} (code={code})"
+    return payload.hex()
+
+
+def decode(data):
+    if len(data) < HEADER_BYTES or data[:8] != MAGIC:
+        raise ValueError("not a flight recorder file")
+    version, recordBytes, channelCount, _headerBytes, pid, startSteady, startUnix = struct.unpack_from("<4I3Q", data, 8)
+    if version != VERSION or recordBytes != RECORD_BYTES:
+        raise ValueError(f"unsupported layout version={version} recordBytes={recordBytes}")
+    state = struct.unpack_from("<I", data, 48)[0]
+    heartbeatUs, heartbeatCb = struct.unpack_from("<2Q", data, 56)
+    lifecycleCode = struct.unpack_from("<I", data, 72)[0]
+    header = dict(pid=pid, startSteady=startSteady, startUnix=startUnix, state=state,
+                  heartbeatUs=heartbeatUs, heartbeatCb=heartbeatCb, lifecycleCode=lifecycleCode, written={})
+
+    records = []
+    for c in range(channelCount):
+        base = CHANNEL_HEADER_OFFSET + CHANNEL_HEADER_BYTES * c
+        offset, capacity, channelId = struct.unpack_from("<QII", data, base)
+        name = cstr(data[base + 16:base + 32])
+        header["written"][name] = struct.unpack_from("<Q", data, base + 32)[0]
+        for slot in range(capacity):
+            at = offset + slot * RECORD_BYTES
+            sequence, ts, kind, payloadBytes, tid = struct.unpack_from("<QQHHI", data, at)
+            # 空・書きかけ・別周回で上書き途中のスロットは捨てる
+            if sequence == 0 or ((sequence - 1) & (capacity - 1)) != slot:
+                continue
+            payload = data[at + 24:at + 24 + min(payloadBytes, RECORD_BYTES - 24)]
+            records.append((ts, channelId, sequence, name, kind, tid, payload))
+    records.sort(key=lambda r: (r[0], r[1], r[2]))
+    return header, records
+
+
+def wall_clock(header, steadyUs):
+    unixUs = header["startUnix"] + (steadyUs - header["startSteady"])
+    return datetime.datetime.fromtimestamp(unixUs / 1e6).strftime("%Y-%m-%d %H:%M:%S.%f")
+
+
+def main():
+    default = os.path.join(os.environ.get("APPDATA", "."), "ConvoPeq", "flight_recorder.bin")
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", nargs="?", default=default)
+    parser.add_argument("--channel", action="append", choices=CHANNELS, help="only these channels")
+    parser.add_argument("--last", type=int, default=0, help="only the newest N records")
+    parser.add_argument("--csv", action="store_true", help="CSV instead of a text timeline")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+    header, records = decode(data)
+    if args.channel:
+        records = [r for r in records if r[3] in args.channel]
+    if args.last > 0:
+        records = records[-args.last:]
+
+    if args.csv:
+        writer = csv.writer(sys.stdout)
+        writer.writerow(["wallClock", "steadyUs", "channel", "kind", "thread", "detail"])
+        for ts, _cid, _seq, name, kind, tid, payload in records:
+            writer.writerow([wall_clock(header, ts), ts, name, KINDS.get(kind, kind), tid, describe(kind, payload)])
+        return
+
+    print(f"File:        {args.file}")
+    print(f"Process:     {header['pid']}")
+    print(f"Session:     started {wall_clock(header, header['startSteady'])}, {STATES.get(header['state'], header['state'])}")
+    if header["heartbeatUs"]:
+        print(f"Heartbeat:   {wall_clock(header, header['heartbeatUs'])} (audio callback #{header['heartbeatCb']})")
+    print(f"Lifecycle:   last code {header['lifecycleCode']}")
+    print("Written:     " + ", ".join(f"{k}={v}" for k, v in header["written"].items()))
+    print()
+    for ts, _cid, _seq, name, kind, tid, payload in records:
+        print(f"{wall_clock(header, ts)}  {name:<9} {KINDS.get(kind, kind):<15} tid={tid:<6} {describe(kind, payload)}")
+
+
+if __name__ == "__main__":
+    main()
@@ -17,13 +17,20 @@ Counter invariants (all must be 0 during steady state):
 - RuntimeWorld null publication
 - double retire
 
+RT guard soak (--exe): runs ConvoPeq with --rt-guard-abort so the first
+allocation or lock on the audio thread aborts the process, and fails when the
+process does not exit cleanly or the log contains an [RT_GUARD] line.
+
 Usage:
     python tools/soak_test_fault_injection.py [--duration 30]
+    python tools/soak_test_fault_injection.py --exe build/ConvoPeq.exe [--duration 600]
 """
 
 import json
 import os
+import subprocess
 import sys
+import tempfile
 import time
 import argparse
 
@@ -73,10 +80,41 @@ def run_simulation(scenario, duration_sec):
     return True
 
 
+def run_rt_guard_soak(exe, duration_sec):
+    """Run ConvoPeq with --rt-guard-abort for duration_sec and check the RT guard log."""
+    log_path = os.path.join(tempfile.gettempdir(), "convopeq_rt_guard_soak.log")
+    if os.path.exists(log_path):
+        os.remove(log_path)
+    cmd = [exe, "--cli-run", "--rt-guard-abort",
+           "--cli-exit-ms", str(duration_sec * 1000),
+           "--cli-log-file", log_path]
+    print(f"\n  RT guard soak: {' '.join(cmd)}")
+    try:
+        result = subprocess.run(cmd, timeout=duration_sec + 60)
+        exit_code = result.returncode
+    except subprocess.TimeoutExpired:
+        print("  Status: FAILED (did not exit)")
+        return False
+
+    violations = []
+    if os.path.exists(log_path):
+        with open(log_path, encoding="utf-8", errors="replace") as f:
+            violations = [line.strip() for line in f
+                          if "[RT_GUARD]" in line and "[RT_GUARD] enabled" not in line]
+    for line in violations:
+        print(f"  {line}")
+    passed = exit_code == 0 and not violations
+    print(f"  Exit code: {exit_code}")
+    print(f"  Status: {'PASSED' if passed else 'FAILED'}")
+    return passed
+
+
 def main():
     parser = argparse.ArgumentParser(description="Soak Test Fault Injection")
     parser.add_argument("--duration", type=int, default=30,
                         help="Duration in seconds for each scenario")
+    parser.add_argument("--exe",
+                        help="ConvoPeq executable: run the RT guard soak (--rt-guard-abort)")
     parser.add_argument("--list", action="store_true",
                         help="List available scenarios")
     args = parser.parse_args()
@@ -102,6 +140,9 @@ def main():
             print(f"  - {name}: {scenario['description']}")
         return 0
 
+    if args.exe:
+        return 0 if run_rt_guard_soak(args.exe, args.duration) else 1
+
     print(f"\nRunning {len(FAULT_SCENARIOS)} fault injection scenarios...")
     all_passed = True
 